@@ -1163,7 +1163,7 @@ AC_DEFUN([LALSUITE_CHECK_SIMD],[
   # list of recognised SIMD instruction sets
   m4_define([simd_isets],[m4_normalize([
     [SSE],[SSE2],[SSE3],[SSSE3],[SSE4.1],[SSE4.2],
-    [AVX],[AVX2]
+    [AVX],[AVX2],[AVX512F]
   ])])
 
   # push compiler environment
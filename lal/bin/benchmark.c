@@ -0,0 +1,361 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+/*
+ * Utility for benchmarking the VectorMath kernels and FFT plans
+ *
+ * Every implementation of each VectorMath kernel which is compiled in and supported by this
+ * machine, as well as the implementation selected at runtime ("dispatch"), is timed over a
+ * range of vector lengths, with both aligned and misaligned vectors; a warning is printed
+ * if the selected implementation is noticeably slower than another available one. Each FFT
+ * plan type is timed over the same range of lengths, and over non-power-of-2 lengths.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <config.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/LALSIMD.h>
+#include <lal/LALVCSInfo.h>
+#include <lal/LogPrintf.h>
+#include <lal/UserInput.h>
+#include <lal/VectorMath.h>
+#include <lal/RealFFT.h>
+#include <lal/ComplexFFT.h>
+
+/* for access to internal prototypes of the implementations of each kernel */
+#include <vectorops/VectorMath_internal.h>
+
+/* alignment of aligned vectors, in bytes */
+#define BENCH_ALIGN 64
+
+/* number of vector buffers */
+#define BENCH_NBUF 5
+
+/* relative slowdown of the selected implementation which triggers a warning */
+#define BENCH_WARN_SLOWDOWN 0.1
+
+/* shortest vector length; longer lengths are successive multiplications by 4 */
+#define BENCH_MIN_LENGTH 16
+
+typedef struct {
+  INT4 maxLength;
+  REAL8 minTime;
+  BOOLEAN vectorMath;
+  BOOLEAN FFT;
+} UserInput_t;
+
+/* vector buffers shared by all benchmarks; each holds maxLength + 1 elements of any type */
+static COMPLEX16VectorAligned *bench_buf[BENCH_NBUF];
+static UINT4 bench_maxLength;
+static REAL8 bench_minTime;
+static UINT4 bench_nwarnings = 0;
+
+/* pointer in buffer 'k' to elements of type 'T', misaligned by 'off' elements */
+#define IN(T,k)  ((const T *)bench_buf[k]->data + off)
+#define OUT(T,k) ((T *)bench_buf[k]->data + off)
+
+/* fill all buffers with floating-point values in [0.5, 1.5), viewed as 'T' */
+#define DEFINE_FILL(T) \
+  static void fill_##T(void) { \
+    for (int k = 0; k < BENCH_NBUF; ++k) { \
+      T *x = (T *)bench_buf[k]->data; \
+      const size_t n = bench_buf[k]->length * sizeof(COMPLEX16) / sizeof(T); \
+      for (size_t i = 0; i < n; ++i) { \
+        x[i] = 0.5 + (REAL8)rand() / RAND_MAX; \
+      } \
+    } \
+  }
+DEFINE_FILL(REAL4)
+DEFINE_FILL(REAL8)
+
+/* print one result; 'gflops' is ignored if negative */
+static void print_result(const char *name, const char *impl, UINT4 len, UINT4 off, REAL8 elemps, REAL8 gflops)
+{
+  printf("%-40s %-10s %8u %-9s %10.1f", name, impl, len, off ? "misalign" : "align", elemps / 1e6);
+  if (gflops >= 0) {
+    printf(" %8.2f", gflops);
+  }
+  printf("\n");
+  fflush(stdout);
+}
+
+/* time CALL, repeated until at least bench_minTime has elapsed, and set 'elemps' to the elements processed per second */
+#define TIME_CALL(elemps, len, CALL) do { \
+    UINT8 nrep = 0; \
+    REAL8 elapsed = 0; \
+    for (UINT8 batch = 1; elapsed < bench_minTime; batch *= 2) { \
+      const REAL8 t0 = XLALGetTimeOfDay(); \
+      for (UINT8 r = 0; r < batch; ++r) { \
+        XLAL_CHECK((CALL) == XLAL_SUCCESS, XLAL_EFUNC); \
+      } \
+      elapsed += XLALGetTimeOfDay() - t0; \
+      nrep += batch; \
+    } \
+    elemps = (REAL8)nrep * (len) / elapsed; \
+  } while (0)
+
+/*
+ * Define a function bench_CLASS() which times a VectorMath kernel with arguments ARG_DEF over all lengths and
+ * alignments, and returns the throughput at the longest aligned length; CALL calls the kernel 'func'
+ */
+#define DEFINE_BENCH(CLASS, FILL_TYPE, ARG_DEF, CALL) \
+  typedef int (*CLASS##_func) ARG_DEF; \
+  static int bench_##CLASS(const char *name, const char *impl, CLASS##_func func, REAL8 *rate) \
+  { \
+    UINT4 UNUSED count = 0; \
+    COMPLEX16 UNUSED zscalar = 0; \
+    REAL8 UNUSED dscalar = 0; \
+    fill_##FILL_TYPE(); \
+    for (UINT4 len = bench_maxLength; len >= BENCH_MIN_LENGTH; len /= 4) { \
+      for (UINT4 off = 0; off < 2; ++off) { \
+        REAL8 elemps = 0; \
+        TIME_CALL(elemps, len, CALL); \
+        print_result(name, impl, len, off, elemps, -1); \
+        if (len == bench_maxLength && off == 0) { \
+          *rate = elemps; \
+        } \
+      } \
+    } \
+    return XLAL_SUCCESS; \
+  }
+
+DEFINE_BENCH(S2I, REAL4, (INT4 *out, const REAL4 *in, const UINT4 len), func(OUT(INT4, 3), IN(REAL4, 0), len))
+DEFINE_BENCH(S2S, REAL4, (REAL4 *out, const REAL4 *in, const UINT4 len), func(OUT(REAL4, 3), IN(REAL4, 0), len))
+DEFINE_BENCH(S2SS, REAL4, (REAL4 *out1, REAL4 *out2, const REAL4 *in, const UINT4 len), func(OUT(REAL4, 3), OUT(REAL4, 4), IN(REAL4, 0), len))
+DEFINE_BENCH(SS2S, REAL4, (REAL4 *out, const REAL4 *in1, const REAL4 *in2, const UINT4 len), func(OUT(REAL4, 3), IN(REAL4, 0), IN(REAL4, 1), len))
+DEFINE_BENCH(SSS2SS, REAL4, (REAL4 *out1, REAL4 *out2, const REAL4 *in1, const REAL4 *in2, const REAL4 *in3, const UINT4 len), func(OUT(REAL4, 3), OUT(REAL4, 4), IN(REAL4, 0), IN(REAL4, 1), IN(REAL4, 2), len))
+DEFINE_BENCH(sS2S, REAL4, (REAL4 *out, REAL4 scalar, const REAL4 *in, const UINT4 len), func(OUT(REAL4, 3), 1.5f, IN(REAL4, 0), len))
+DEFINE_BENCH(SS2uU, REAL4, (UINT4 *count, UINT4 *out, const REAL4 *in1, const REAL4 *in2, const UINT4 len), func(&count, OUT(UINT4, 3), IN(REAL4, 0), IN(REAL4, 1), len))
+DEFINE_BENCH(sS2uU, REAL4, (UINT4 *count, UINT4 *out, REAL4 scalar, const REAL4 *in, const UINT4 len), func(&count, OUT(UINT4, 3), 1.0f, IN(REAL4, 0), len))
+DEFINE_BENCH(dD2D, REAL8, (REAL8 *out, REAL8 scalar, const REAL8 *in, const UINT4 len), func(OUT(REAL8, 3), 1.5, IN(REAL8, 0), len))
+DEFINE_BENCH(DD2D, REAL8, (REAL8 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len), func(OUT(REAL8, 3), IN(REAL8, 0), IN(REAL8, 1), len))
+DEFINE_BENCH(CC2C, REAL4, (COMPLEX8 *out, const COMPLEX8 *in1, const COMPLEX8 *in2, const UINT4 len), func(OUT(COMPLEX8, 3), IN(COMPLEX8, 0), IN(COMPLEX8, 1), len))
+DEFINE_BENCH(cC2C, REAL4, (COMPLEX8 *out, COMPLEX8 scalar, const COMPLEX8 *in, const UINT4 len), func(OUT(COMPLEX8, 3), crectf(1.5f, -0.5f), IN(COMPLEX8, 0), len))
+DEFINE_BENCH(D2D, REAL8, (REAL8 *out, const REAL8 *in, const UINT4 len), func(OUT(REAL8, 3), IN(REAL8, 0), len))
+DEFINE_BENCH(D2DD, REAL8, (REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len), func(OUT(REAL8, 3), OUT(REAL8, 4), IN(REAL8, 0), len))
+DEFINE_BENCH(ZZ2Z, REAL8, (COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len), func(OUT(COMPLEX16, 3), IN(COMPLEX16, 0), IN(COMPLEX16, 1), len))
+DEFINE_BENCH(Z2D, REAL8, (REAL8 *out, const COMPLEX16 *in, const UINT4 len), func(OUT(REAL8, 3), IN(COMPLEX16, 0), len))
+DEFINE_BENCH(ZZ2z, REAL8, (COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len), func(&zscalar, IN(COMPLEX16, 0), IN(COMPLEX16, 1), len))
+DEFINE_BENCH(ZZD2zd, REAL8, (COMPLEX16 *hd, REAL8 *hh, const COMPLEX16 *h, const COMPLEX16 *d, const REAL8 *w, const UINT4 len, const VectorMathSumMethod method), func(&zscalar, &dscalar, IN(COMPLEX16, 0), IN(COMPLEX16, 1), IN(REAL8, 2), len, VECTORMATH_SUM_DIRECT))
+DEFINE_BENCH(CCS2zd, REAL4, (COMPLEX16 *hd, REAL8 *hh, const COMPLEX8 *h, const COMPLEX8 *d, const REAL4 *w, const UINT4 len, const VectorMathSumMethod method), func(&zscalar, &dscalar, IN(COMPLEX8, 0), IN(COMPLEX8, 1), IN(REAL4, 2), len, VECTORMATH_SUM_DIRECT))
+
+/* warn if the implementation selected at runtime is noticeably slower than the fastest available */
+static void check_dispatch(const char *name, const char *dispatch_name, const char *best_impl, REAL8 best_rate, REAL8 dispatch_rate)
+{
+  const char *dispatch_impl = strrchr(dispatch_name, '_');
+  dispatch_impl = (dispatch_impl == NULL) ? dispatch_name : dispatch_impl + 1;
+  if (strcmp(dispatch_impl, best_impl) != 0 && dispatch_rate < (1 - BENCH_WARN_SLOWDOWN) * best_rate) {
+    printf("# WARNING: %s: selected %s implementation is %.0f%% slower than %s implementation\n",
+           name, dispatch_impl, 100 * (1 - dispatch_rate / best_rate), best_impl);
+    ++bench_nwarnings;
+  }
+}
+
+/* run only if the instruction set is compiled in and supported by this machine */
+#define BENCH_ISET_NONE(...)		do { } while(0)
+#if defined(HAVE_SSE2_COMPILER)
+#define BENCH_ISET_SSE2(...)		if (XLALHaveSIMDInstructionSet(LAL_SIMD_ISET_SSE2)) { __VA_ARGS__; } do { } while(0)
+#else
+#define BENCH_ISET_SSE2(...)		BENCH_ISET_NONE()
+#endif
+#if defined(HAVE_SSSE3_COMPILER)
+#define BENCH_ISET_SSSE3(...)		if (XLALHaveSIMDInstructionSet(LAL_SIMD_ISET_SSSE3)) { __VA_ARGS__; } do { } while(0)
+#else
+#define BENCH_ISET_SSSE3(...)		BENCH_ISET_NONE()
+#endif
+#if defined(HAVE_AVX_COMPILER)
+#define BENCH_ISET_AVX(...)		if (XLALHaveSIMDInstructionSet(LAL_SIMD_ISET_AVX)) { __VA_ARGS__; } do { } while(0)
+#else
+#define BENCH_ISET_AVX(...)		BENCH_ISET_NONE()
+#endif
+#if defined(HAVE_AVX2_COMPILER)
+#define BENCH_ISET_AVX2(...)		if (XLALHaveSIMDInstructionSet(LAL_SIMD_ISET_AVX2)) { __VA_ARGS__; } do { } while(0)
+#else
+#define BENCH_ISET_AVX2(...)		BENCH_ISET_NONE()
+#endif
+#if defined(HAVE_AVX512F_COMPILER)
+#define BENCH_ISET_AVX512F(...)		if (XLALHaveSIMDInstructionSet(LAL_SIMD_ISET_AVX512F)) { __VA_ARGS__; } do { } while(0)
+#else
+#define BENCH_ISET_AVX512F(...)		BENCH_ISET_NONE()
+#endif
+
+#define BENCH_IMPL(CLASS, NAME, ISET) \
+  XLAL_CHECK(bench_##CLASS("XLALVector" #NAME, #ISET, XLALVector##NAME##_##ISET, &rate) == XLAL_SUCCESS, XLAL_EFUNC); \
+  if (rate > best_rate) { best_rate = rate; best_impl = #ISET; }
+
+/* benchmark all implementations of a kernel; instruction sets are as in VectorMath.c */
+#define BENCH_KERNEL(CLASS, NAME, ISET1, ISET2, ISET3, ISET4) do { \
+    REAL8 rate = 0, best_rate = 0, dispatch_rate = 0; \
+    const char *best_impl = "GEN"; \
+    XLAL_CHECK(bench_##CLASS("XLALVector" #NAME, "GEN", XLALVector##NAME##_GEN, &best_rate) == XLAL_SUCCESS, XLAL_EFUNC); \
+    BENCH_ISET_##ISET4(BENCH_IMPL(CLASS, NAME, ISET4)); \
+    BENCH_ISET_##ISET3(BENCH_IMPL(CLASS, NAME, ISET3)); \
+    BENCH_ISET_##ISET2(BENCH_IMPL(CLASS, NAME, ISET2)); \
+    BENCH_ISET_##ISET1(BENCH_IMPL(CLASS, NAME, ISET1)); \
+    XLAL_CHECK(bench_##CLASS("XLALVector" #NAME, "dispatch", XLALVector##NAME, &dispatch_rate) == XLAL_SUCCESS, XLAL_EFUNC); \
+    check_dispatch("XLALVector" #NAME, XLALVector##NAME##_name, best_impl, best_rate, dispatch_rate); \
+  } while (0)
+
+static int bench_vectormath(void)
+{
+  printf("# %-38s %-10s %8s %-9s %10s\n", "VectorMath kernel", "impl", "length", "memory", "Melem/s");
+  BENCH_KERNEL(S2I, INT4FromREAL4, SSE2, NONE, NONE, NONE);
+  BENCH_KERNEL(S2S, SinREAL4, AVX2, AVX, SSE2, NONE);
+  BENCH_KERNEL(S2S, CosREAL4, AVX2, AVX, SSE2, NONE);
+  BENCH_KERNEL(S2S, ExpREAL4, AVX2, AVX, SSE2, NONE);
+  BENCH_KERNEL(S2S, LogREAL4, AVX2, AVX, SSE2, NONE);
+  BENCH_KERNEL(S2S, RoundREAL4, AVX2, AVX, NONE, NONE);
+  BENCH_KERNEL(S2SS, SinCosREAL4, AVX2, AVX, SSE2, NONE);
+  BENCH_KERNEL(S2SS, SinCos2PiREAL4, AVX2, AVX, SSE2, NONE);
+  BENCH_KERNEL(SS2S, AddREAL4, AVX2, AVX, SSE2, NONE);
+  BENCH_KERNEL(SS2S, SubREAL4, AVX2, AVX, SSE2, NONE);
+  BENCH_KERNEL(SS2S, MultiplyREAL4, AVX2, AVX, SSE2, NONE);
+  BENCH_KERNEL(SS2S, MaxREAL4, AVX2, AVX, SSE2, NONE);
+  BENCH_KERNEL(SSS2SS, AddMaxREAL4, AVX2, AVX, NONE, NONE);
+  BENCH_KERNEL(sS2S, ScaleREAL4, AVX2, AVX, SSE2, NONE);
+  BENCH_KERNEL(sS2S, ShiftREAL4, AVX2, AVX, SSE2, NONE);
+  BENCH_KERNEL(SS2uU, FindVectorLessEqualREAL4, AVX2, SSSE3, NONE, NONE);
+  BENCH_KERNEL(sS2uU, FindScalarLessEqualREAL4, AVX2, SSSE3, NONE, NONE);
+  BENCH_KERNEL(dD2D, ScaleREAL8, AVX2, AVX, SSE2, NONE);
+  BENCH_KERNEL(dD2D, ShiftREAL8, AVX2, AVX, SSE2, NONE);
+  BENCH_KERNEL(DD2D, AddREAL8, AVX2, AVX, SSE2, NONE);
+  BENCH_KERNEL(DD2D, SubREAL8, AVX2, AVX, SSE2, NONE);
+  BENCH_KERNEL(DD2D, MultiplyREAL8, AVX2, AVX, SSE2, NONE);
+  BENCH_KERNEL(DD2D, MaxREAL8, AVX2, AVX, NONE, NONE);
+  BENCH_KERNEL(CC2C, MultiplyCOMPLEX8, AVX2, AVX, SSE2, NONE);
+  BENCH_KERNEL(CC2C, AddCOMPLEX8, AVX2, AVX, SSE2, NONE);
+  BENCH_KERNEL(cC2C, ScaleCOMPLEX8, AVX2, AVX, SSE2, NONE);
+  BENCH_KERNEL(cC2C, ShiftCOMPLEX8, AVX2, AVX, SSE2, NONE);
+  BENCH_KERNEL(D2D, SinREAL8, AVX512F, AVX2, SSE2, NONE);
+  BENCH_KERNEL(D2D, CosREAL8, AVX512F, AVX2, SSE2, NONE);
+  BENCH_KERNEL(D2D, ExpREAL8, AVX512F, AVX2, SSE2, NONE);
+  BENCH_KERNEL(D2D, LogREAL8, AVX512F, AVX2, SSE2, NONE);
+  BENCH_KERNEL(D2D, RoundREAL8, AVX2, AVX, NONE, NONE);
+  BENCH_KERNEL(D2DD, SinCosREAL8, AVX512F, AVX2, SSE2, NONE);
+  BENCH_KERNEL(D2DD, SinCos2PiREAL8, AVX512F, AVX2, SSE2, NONE);
+  BENCH_KERNEL(ZZ2Z, MultiplyCOMPLEX16, AVX512F, AVX2, AVX, SSE2);
+  BENCH_KERNEL(ZZ2Z, MultiplyConjCOMPLEX16, AVX512F, AVX2, AVX, SSE2);
+  BENCH_KERNEL(Z2D, Abs2COMPLEX16, AVX512F, AVX2, AVX, SSE2);
+  BENCH_KERNEL(ZZ2z, DotConjCOMPLEX16, AVX512F, AVX2, AVX, SSE2);
+  BENCH_KERNEL(ZZD2zd, WeightedInnerProductCOMPLEX16, AVX512F, AVX2, SSE2, NONE);
+  BENCH_KERNEL(CCS2zd, WeightedInnerProductCOMPLEX8, AVX512F, AVX2, SSE2, NONE);
+  return XLAL_SUCCESS;
+}
+
+/*
+ * Define a function which times forward and reverse FFTs of a given type over all lengths and alignments;
+ * a complex FFT of length N is counted as 5 N log2(N) floating-point operations, and a real FFT as half that
+ */
+#define DEFINE_BENCH_FFT(TYPE, FILL_TYPE, PLAN, IN_TYPE, OUT_TYPE, FLOPS, CREATE_PLAN, DESTROY_PLAN, FFT) \
+  static int bench_fft_##TYPE(int forward, const char *name) \
+  { \
+    fill_##FILL_TYPE(); \
+    for (UINT4 len0 = bench_maxLength; len0 >= BENCH_MIN_LENGTH; len0 /= 4) { \
+      for (UINT4 pass = 0; pass < 2; ++pass) { \
+        const UINT4 len = pass == 0 ? len0 : 3 * len0 / 4; \
+        PLAN *plan = CREATE_PLAN(len, forward, 0); \
+        XLAL_CHECK(plan != NULL, XLAL_EFUNC); \
+        for (UINT4 off = 0; off < 2; ++off) { \
+          IN_TYPE##Vector in = { .length = len, .data = OUT(IN_TYPE, 0) }; \
+          OUT_TYPE##Vector out = { .length = len, .data = OUT(OUT_TYPE, 3) }; \
+          REAL8 elemps = 0; \
+          TIME_CALL(elemps, len, FFT); \
+          print_result(name, forward ? "forward" : "reverse", len, off, elemps, elemps * (FLOPS) * log2(len) / 1e9); \
+        } \
+        DESTROY_PLAN(plan); \
+      } \
+    } \
+    return XLAL_SUCCESS; \
+  }
+
+DEFINE_BENCH_FFT(REAL4, REAL4, REAL4FFTPlan, REAL4, REAL4, 2.5, XLALCreateREAL4FFTPlan, XLALDestroyREAL4FFTPlan, XLALREAL4VectorFFT(&out, &in, plan))
+DEFINE_BENCH_FFT(REAL8, REAL8, REAL8FFTPlan, REAL8, REAL8, 2.5, XLALCreateREAL8FFTPlan, XLALDestroyREAL8FFTPlan, XLALREAL8VectorFFT(&out, &in, plan))
+DEFINE_BENCH_FFT(COMPLEX8, REAL4, COMPLEX8FFTPlan, COMPLEX8, COMPLEX8, 5, XLALCreateCOMPLEX8FFTPlan, XLALDestroyCOMPLEX8FFTPlan, XLALCOMPLEX8VectorFFT(&out, &in, plan))
+DEFINE_BENCH_FFT(COMPLEX16, REAL8, COMPLEX16FFTPlan, COMPLEX16, COMPLEX16, 5, XLALCreateCOMPLEX16FFTPlan, XLALDestroyCOMPLEX16FFTPlan, XLALCOMPLEX16VectorFFT(&out, &in, plan))
+
+static int bench_fft(void)
+{
+  printf("# %-38s %-10s %8s %-9s %10s %8s\n", "FFT plan", "direction", "length", "memory", "Melem/s", "GFLOP/s");
+  for (int forward = 1; forward >= 0; --forward) {
+    XLAL_CHECK(bench_fft_REAL4(forward, "REAL4FFTPlan") == XLAL_SUCCESS, XLAL_EFUNC);
+    XLAL_CHECK(bench_fft_REAL8(forward, "REAL8FFTPlan") == XLAL_SUCCESS, XLAL_EFUNC);
+    XLAL_CHECK(bench_fft_COMPLEX8(forward, "COMPLEX8FFTPlan") == XLAL_SUCCESS, XLAL_EFUNC);
+    XLAL_CHECK(bench_fft_COMPLEX16(forward, "COMPLEX16FFTPlan") == XLAL_SUCCESS, XLAL_EFUNC);
+  }
+  return XLAL_SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+  UserInput_t XLAL_INIT_DECL(uvar_s);
+  UserInput_t *uvar = &uvar_s;
+
+  uvar->maxLength = 1 << 18;
+  uvar->minTime = 0.1;
+  uvar->vectorMath = 1;
+  uvar->FFT = 1;
+
+  XLALRegisterUvarMember(maxLength, INT4, 'n', OPTIONAL, "Longest vector length; shorter lengths are successive divisions by 4, down to 16");
+  XLALRegisterUvarMember(minTime, REAL8, 't', OPTIONAL, "Minimum time (seconds) to spend timing each kernel/plan at each length");
+  XLALRegisterUvarMember(vectorMath, BOOLEAN, 'v', OPTIONAL, "Benchmark the VectorMath kernels");
+  XLALRegisterUvarMember(FFT, BOOLEAN, 'f', OPTIONAL, "Benchmark the FFT plans");
+
+  BOOLEAN should_exit = 0;
+  XLAL_CHECK_MAIN(XLALUserVarReadAllInput(&should_exit, argc, argv, lalVCSInfoList) == XLAL_SUCCESS, XLAL_EFUNC);
+  if (should_exit) {
+    return EXIT_FAILURE;
+  }
+  XLAL_CHECK_MAIN(uvar->maxLength >= BENCH_MIN_LENGTH, XLAL_EDOM, "maxLength must be at least %i", BENCH_MIN_LENGTH);
+  XLAL_CHECK_MAIN(uvar->minTime > 0, XLAL_EDOM, "minTime must be positive");
+  bench_maxLength = uvar->maxLength;
+  bench_minTime = uvar->minTime;
+
+  printf("# %s was compiled with support for the following instruction sets:\n#    %s %s\n",
+         PACKAGE_STRING, XLALSIMDInstructionSetName(0), HAVE_SIMD_COMPILER);
+  printf("# This machine supports executing the following instruction sets:\n#   ");
+  for (LAL_SIMD_ISET iset = 0; XLALHaveSIMDInstructionSet(iset); ++iset) {
+    printf(" %s", XLALSIMDInstructionSetName(iset));
+  }
+  printf("\n");
+
+  /* allocate buffers, with room for misalignment by one element */
+  srand(1);
+  for (int k = 0; k < BENCH_NBUF; ++k) {
+    XLAL_CHECK_MAIN((bench_buf[k] = XLALCreateCOMPLEX16VectorAligned(bench_maxLength + 1, BENCH_ALIGN)) != NULL, XLAL_EFUNC);
+  }
+
+  if (uvar->vectorMath) {
+    XLAL_CHECK_MAIN(bench_vectormath() == XLAL_SUCCESS, XLAL_EFUNC);
+  }
+  if (uvar->FFT) {
+    XLAL_CHECK_MAIN(bench_fft() == XLAL_SUCCESS, XLAL_EFUNC);
+  }
+  if (bench_nwarnings > 0) {
+    printf("# WARNING: %u kernel(s) selected a slower implementation than available\n", bench_nwarnings);
+  }
+
+  for (int k = 0; k < BENCH_NBUF; ++k) {
+    XLALDestroyCOMPLEX16VectorAligned(bench_buf[k]);
+  }
+  XLALDestroyUserVars();
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+}
@@ -240,6 +240,25 @@ REAL8 XLALGreenwichMeanSiderealTime(
         const LIGOTimeGPS *gpstime
 );
 
+#ifndef SWIG /* exclude from SWIG interface */
+
+/* Returns the Greenwich Mean Sidereal Times in RADIANS for an array of GPS times. */
+int XLALGreenwichMeanSiderealTimes(
+        REAL8 *gmst,
+        const LIGOTimeGPS *gpstimes,
+        UINT4 n
+);
+
+/* Returns the Greenwich Mean Sidereal Times in RADIANS for a regular grid of GPS times. */
+int XLALGreenwichMeanSiderealTimeGrid(
+        REAL8 *gmst,
+        const LIGOTimeGPS *start,
+        REAL8 deltaT,
+        UINT4 n
+);
+
+#endif /* SWIG */
+
 /* Returns the GPS time for the given Greenwich mean sidereal time (in radians). */
 LIGOTimeGPS *XLALGreenwichMeanSiderealTimeToGPS(
         REAL8 gmst,
@@ -98,6 +98,69 @@ double XLALTimeDelayFromEarthCenter(
 }
 
 
+/* number of sky positions whose unit vectors are held at once */
+#define TIMEDELAY_BLOCK 256
+
+/**
+ * Computes the time delays from the Earth's centre to each of \c
+ * numDetectors detectors for each of \c numPoints sky positions, all at
+ * the same time \c gpstime.  This gives the same results as
+ * XLALTimeDelayFromEarthCenter(), but computes the sidereal time only once
+ * and evaluates the delays detector by detector over blocks of sky
+ * positions.
+ *
+ * The delay of sky position \c i at detector \c j is stored in
+ * <tt>delays[j * numPoints + i]</tt>.
+ */
+int XLALTimeDelaysFromEarthCenter(
+	double *delays,					/**< Returned time delays, numDetectors * numPoints (seconds) */
+	const LALDetector *detectors,			/**< Array of numDetectors detectors */
+	UINT4 numDetectors,				/**< Number of detectors */
+	const double *source_right_ascension_radians,	/**< Array of numPoints right ascensions */
+	const double *source_declination_radians,	/**< Array of numPoints declinations */
+	UINT4 numPoints,				/**< Number of sky positions */
+	const LIGOTimeGPS *gpstime			/**< Time of arrival at the Earth's centre */
+)
+{
+	double ehat[3][TIMEDELAY_BLOCK];
+	double gmst;
+	UINT4 start, i, j;
+
+	XLAL_CHECK(delays && gpstime, XLAL_EFAULT);
+	XLAL_CHECK((detectors || !numDetectors) && ((source_right_ascension_radians && source_declination_radians) || !numPoints), XLAL_EFAULT);
+
+	gmst = XLALGreenwichMeanSiderealTime(gpstime);
+	if(XLAL_IS_REAL8_FAIL_NAN(gmst))
+		XLAL_ERROR(XLAL_EFUNC);
+
+	for(start = 0; start < numPoints; start += TIMEDELAY_BLOCK) {
+		const UINT4 n = numPoints - start < TIMEDELAY_BLOCK ? numPoints - start : TIMEDELAY_BLOCK;
+
+		/* unit vectors pointing from the geocenter to the sources */
+		for(i = 0; i < n; i++) {
+			const double greenwich_hour_angle = gmst - source_right_ascension_radians[start + i];
+			const double cosdec = cos(source_declination_radians[start + i]);
+			ehat[0][i] = cosdec * cos(greenwich_hour_angle);
+			ehat[1][i] = cosdec * -sin(greenwich_hour_angle);
+			ehat[2][i] = sin(source_declination_radians[start + i]);
+		}
+
+		/* positive when the wavefront arrives at the detector after
+		 * arriving at the geocentre */
+		for(j = 0; j < numDetectors; j++) {
+			const double x = detectors[j].location[0];
+			const double y = detectors[j].location[1];
+			const double z = detectors[j].location[2];
+			double *out = delays + (size_t) j * numPoints + start;
+			for(i = 0; i < n; i++)
+				out[i] = -(ehat[0][i] * x + ehat[1][i] * y + ehat[2][i] * z) / LAL_C_SI;
+		}
+	}
+
+	return 0;
+}
+
+
 /**
  * Compute the light travel time between two detectors and returns the answer in \c INT8 nanoseconds.
  */
@@ -46,6 +46,8 @@ extern "C"
  *
  * The function XLALTimeDelayFromEarthCenter() Computes difference in arrival
  * time of the same signal at detector and at center of Earth-fixed frame.
+ * XLALTimeDelaysFromEarthCenter() computes the same delays for arrays of
+ * detectors and sky positions at one time.
  *
  * The function XLALLightTravelTime() computes the light travel time between two detectors and returns the answer in \c INT8 nanoseconds.
  *
@@ -99,6 +101,19 @@ XLALTimeDelayFromEarthCenter(
 	const LIGOTimeGPS *gpstime
 );
 
+#ifndef SWIG /* exclude from SWIG interface */
+int
+XLALTimeDelaysFromEarthCenter(
+	double *delays,
+	const LALDetector *detectors,
+	UINT4 numDetectors,
+	const double *source_right_ascension_radians,
+	const double *source_declination_radians,
+	UINT4 numPoints,
+	const LIGOTimeGPS *gpstime
+);
+#endif /* SWIG */
+
 /** @} */
 
 #ifdef __cplusplus
@@ -98,6 +98,33 @@
  *       In this case, UTC will add a second going from 23:59:59 at
  *       gpssec-1 to 23:59:60 (of the same day) at gpssec.
  */
+/*
+ * Index of the last entry of the leap second table at or before gpssec,
+ * for gpssec >= leaps[0].gpssec.  Times after the most recent leap second
+ * are by far the most common, so they are checked first; otherwise the
+ * table is bisected.
+ */
+static int leap_index( INT4 gpssec )
+{
+  int lo = 0;
+  int hi = numleaps - 1;
+
+  if ( gpssec >= leaps[hi].gpssec )
+    return hi;
+
+  /* invariant: leaps[lo].gpssec <= gpssec < leaps[hi].gpssec */
+  while ( hi - lo > 1 )
+  {
+    int mid = ( lo + hi ) / 2;
+    if ( gpssec < leaps[mid].gpssec )
+      hi = mid;
+    else
+      lo = mid;
+  }
+
+  return lo;
+}
+
 static int delta_tai_utc( INT4 gpssec )
 {
   int leap;
@@ -112,9 +139,9 @@ static int delta_tai_utc( INT4 gpssec )
   }
   */
 
-  for ( leap = 1; leap < numleaps; ++leap )
-    if ( gpssec == leaps[leap].gpssec )
-      return leaps[leap].taiutc - leaps[leap-1].taiutc;
+  leap = leap_index( gpssec );
+  if ( leap > 0 && gpssec == leaps[leap].gpssec )
+    return leaps[leap].taiutc - leaps[leap-1].taiutc;
 
   return 0;
 }
@@ -122,8 +149,6 @@ static int delta_tai_utc( INT4 gpssec )
 /** Returns the leap seconds TAI-UTC at a given GPS second. */
 int XLALLeapSeconds( INT4 gpssec /**< [In] Seconds relative to GPS epoch.*/ )
 {
-  int leap;
-
   if ( gpssec < leaps[0].gpssec )
   {
     XLALPrintError( "XLAL Error - Don't know leap seconds before GPS time %d\n",
@@ -131,12 +156,7 @@ int XLALLeapSeconds( INT4 gpssec /**< [In] Seconds relative to GPS epoch.*/ )
     XLAL_ERROR( XLAL_EDOM );
   }
 
-  /* scan leap second table and locate the appropriate interval */
-  for ( leap = 1; leap < numleaps; ++leap )
-    if ( gpssec < leaps[leap].gpssec )
-      break;
-
-  return leaps[leap-1].taiutc;
+  return leaps[leap_index( gpssec )].taiutc;
 }
 
 
@@ -160,7 +180,7 @@ int XLALGPSLeapSeconds( INT4 gpssec /**< [In] Seconds relative to GPS epoch.*/ )
 int XLALLeapSecondsUTC( const struct tm *utc /**< [In] UTC as a broken down time.*/ )
 {
   REAL8 jd;
-  int leap;
+  int lo, hi;
 
   jd = XLALConvertCivilTimeToJD( utc );
   if ( XLAL_IS_REAL8_FAIL_NAN( jd ) )
@@ -172,12 +192,21 @@ int XLALLeapSecondsUTC( const struct tm *utc /**< [In] UTC as a broken down time
     XLAL_ERROR( XLAL_EDOM );
   }
 
-  /* scan leap second table and locate the appropriate interval */
-  for ( leap = 1; leap < numleaps; ++leap )
-    if ( jd < leaps[leap].jd )
-      break;
+  /* check the current interval first, then bisect the table */
+  if ( jd >= leaps[numleaps-1].jd )
+    return leaps[numleaps-1].taiutc;
+  lo = 0;
+  hi = numleaps - 1;
+  while ( hi - lo > 1 )
+  {
+    int mid = ( lo + hi ) / 2;
+    if ( jd < leaps[mid].jd )
+      hi = mid;
+    else
+      lo = mid;
+  }
 
-  return leaps[leap-1].taiutc;
+  return leaps[lo].taiutc;
 }
 
 
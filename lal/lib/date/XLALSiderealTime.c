@@ -19,6 +19,7 @@
 #include <math.h>
 #include <lal/Date.h>
 #include <lal/XLALError.h>
+#include "XLALLeapSeconds.h" /* contains the leap second table */
 
 /**
  * \defgroup XLALSideralTime_c SideralTime
@@ -35,59 +36,71 @@
 
 /** @{ */
 
-/**
- * Returns the Greenwich Sidereal Time IN RADIANS corresponding to a
- * specified GPS time.  Aparent sidereal time is computed by providing the
- * equation of equinoxes in units of seconds.  For mean sidereal time, set
- * this parameter to 0.
- *
- * This function returns the sidereal time in radians measured from the
- * Julian epoch (current J2000).  The result is NOT modulo 2 pi.
- *
- * Inspired by the function sidereal_time() in the NOVAS-C library, version
- * 2.0.1, which is dated December 10th, 1999, and carries the following
- * references:
- *
- * Aoki, et al. (1982) Astronomy and Astrophysics 105, 359-361.
- * Kaplan, G. H. "NOVAS: Naval Observatory Vector Astrometry
- * Subroutines"; USNO internal document dated 20 Oct 1988;
- * revised 15 Mar 1990.
- *
- * See http://aa.usno.navy.mil/software/novas for more information.
- *
- * Note:  rather than maintaining this code separately, it would be a good
- * idea for LAL to simply link to the NOVAS-C library directly.  Something
- * to do when we have some spare time.
+/*
+ * Whether an integer GPS second is an inserted leap second (23:59:60),
+ * i.e. the GPS time at which TAI-UTC increased.  The first entry of the
+ * table is where it starts, not a leap second.  Recent times are the most
+ * common, so the table is scanned from the end.
  */
-REAL8 XLALGreenwichSiderealTime(
-	const LIGOTimeGPS *gpstime,
-	REAL8 equation_of_equinoxes
-)
+static int is_leap_second(INT4 gpssec)
+{
+	int leap = numleaps - 1;
+
+	while(leap > 0 && gpssec < leaps[leap].gpssec)
+		--leap;
+
+	return leap > 0 && gpssec == leaps[leap].gpssec && leaps[leap].taiutc > leaps[leap-1].taiutc;
+}
+
+
+/*
+ * Julian day (UTC) of an integer GPS second, equal to
+ * XLALConvertCivilTimeToJD() of XLALGPSToUTC().  Away from a leap second
+ * UTC is a fixed offset from GPS time, so the broken-down time is not
+ * needed.  Returns XLAL_REAL8_FAIL_NAN on error.
+ */
+static double gps_julian_day(INT4 gpssec)
 {
+	const int sec_per_day = 60 * 60 * 24;
 	struct tm utc;
+	INT8 unixsec, day, sec;
 	double julian_day;
-	double t_hi, t_lo;
-	double t;
-	double sidereal_time;
+	int leapsec = XLALLeapSeconds(gpssec);
 
-	/*
-	 * Convert GPS seconds to UTC.  This is where we pick up knowledge
-	 * of leap seconds which are required for the mapping of atomic
-	 * time scales to celestial time scales.  We deal only with integer
-	 * seconds.
-	 */
-
-	if(!XLALGPSToUTC(&utc, gpstime->gpsSeconds))
+	if(leapsec < 0)
 		XLAL_ERROR_REAL8(XLAL_EFUNC);
 
-	/*
-	 * And now to Julian day number.  Again, only accurate to integer
-	 * seconds.
-	 */
+	/* during an inserted leap second use the broken-down time */
 
-	julian_day = XLALConvertCivilTimeToJD(&utc);
-	if(XLAL_IS_REAL8_FAIL_NAN(julian_day))
-		XLAL_ERROR_REAL8(XLAL_EFUNC);
+	if(is_leap_second(gpssec)) {
+		if(!XLALGPSToUTC(&utc, gpssec))
+			XLAL_ERROR_REAL8(XLAL_EFUNC);
+		julian_day = XLALConvertCivilTimeToJD(&utc);
+		if(XLAL_IS_REAL8_FAIL_NAN(julian_day))
+			XLAL_ERROR_REAL8(XLAL_EFUNC);
+		return julian_day;
+	}
+
+	/* same arithmetic as XLALGPSToUTC() and XLALConvertCivilTimeToJD() */
+	unixsec = (INT8) gpssec - leapsec + XLAL_EPOCH_GPS_TAI_UTC + XLAL_EPOCH_UNIX_GPS;
+	day = unixsec / sec_per_day - (unixsec % sec_per_day < 0);
+	sec = unixsec - day * sec_per_day;
+	julian_day = day + 2440588;
+	julian_day += (REAL8)sec/(REAL8)sec_per_day - 0.5;
+
+	return julian_day;
+}
+
+
+/*
+ * Sidereal time in radians from the Julian day of the integer seconds,
+ * the nanoseconds, and the equation of equinoxes.
+ */
+static double sidereal_time_from_julian_day(double julian_day, INT4 gpsNanoSeconds, REAL8 equation_of_equinoxes)
+{
+	double t_hi, t_lo;
+	double t;
+	double sidereal_time;
 
 	/*
 	 * Convert Julian day number to the number of centuries since the
@@ -104,7 +117,7 @@ REAL8 XLALGreenwichSiderealTime(
 	 */
 
 	t_hi = (julian_day - XLAL_EPOCH_J2000_0_JD) / 36525.0;
-	t_lo = gpstime->gpsNanoSeconds / (1e9 * 36525.0 * 86400.0);
+	t_lo = gpsNanoSeconds / (1e9 * 36525.0 * 86400.0);
 
 	/*
 	 * Compute sidereal time in sidereal seconds.  (magic)
@@ -127,6 +140,50 @@ REAL8 XLALGreenwichSiderealTime(
 }
 
 
+/**
+ * Returns the Greenwich Sidereal Time IN RADIANS corresponding to a
+ * specified GPS time.  Aparent sidereal time is computed by providing the
+ * equation of equinoxes in units of seconds.  For mean sidereal time, set
+ * this parameter to 0.
+ *
+ * This function returns the sidereal time in radians measured from the
+ * Julian epoch (current J2000).  The result is NOT modulo 2 pi.
+ *
+ * Inspired by the function sidereal_time() in the NOVAS-C library, version
+ * 2.0.1, which is dated December 10th, 1999, and carries the following
+ * references:
+ *
+ * Aoki, et al. (1982) Astronomy and Astrophysics 105, 359-361.
+ * Kaplan, G. H. "NOVAS: Naval Observatory Vector Astrometry
+ * Subroutines"; USNO internal document dated 20 Oct 1988;
+ * revised 15 Mar 1990.
+ *
+ * See http://aa.usno.navy.mil/software/novas for more information.
+ *
+ * Note:  rather than maintaining this code separately, it would be a good
+ * idea for LAL to simply link to the NOVAS-C library directly.  Something
+ * to do when we have some spare time.
+ */
+REAL8 XLALGreenwichSiderealTime(
+	const LIGOTimeGPS *gpstime,
+	REAL8 equation_of_equinoxes
+)
+{
+	/*
+	 * Convert GPS seconds to a Julian day number in UTC.  This is
+	 * where we pick up knowledge of leap seconds which are required
+	 * for the mapping of atomic time scales to celestial time scales.
+	 * We deal only with integer seconds.
+	 */
+
+	double julian_day = gps_julian_day(gpstime->gpsSeconds);
+	if(XLAL_IS_REAL8_FAIL_NAN(julian_day))
+		XLAL_ERROR_REAL8(XLAL_EFUNC);
+
+	return sidereal_time_from_julian_day(julian_day, gpstime->gpsNanoSeconds, equation_of_equinoxes);
+}
+
+
 /**
  * Convenience wrapper, calling XLALGreenwichSiderealTime() with the
  * equation of equinoxes set to 0.
@@ -139,6 +196,74 @@ REAL8 XLALGreenwichMeanSiderealTime(
 }
 
 
+/**
+ * Computes XLALGreenwichMeanSiderealTime() for each of the \c n times in
+ * \c gpstimes, storing the results in \c gmst.  The Julian day of each
+ * integer second is computed only when it differs from that of the
+ * previous time, so runs of times within the same second, as well as
+ * sorted times, are cheap.
+ */
+int XLALGreenwichMeanSiderealTimes(
+	REAL8 *gmst,
+	const LIGOTimeGPS *gpstimes,
+	UINT4 n
+)
+{
+	double julian_day = 0.0;
+	INT4 gpssec = 0;
+	UINT4 i;
+
+	XLAL_CHECK((gmst && gpstimes) || !n, XLAL_EFAULT);
+
+	for(i = 0; i < n; i++) {
+		if(i == 0 || gpstimes[i].gpsSeconds != gpssec) {
+			gpssec = gpstimes[i].gpsSeconds;
+			julian_day = gps_julian_day(gpssec);
+			if(XLAL_IS_REAL8_FAIL_NAN(julian_day))
+				XLAL_ERROR(XLAL_EFUNC);
+		}
+		gmst[i] = sidereal_time_from_julian_day(julian_day, gpstimes[i].gpsNanoSeconds, 0.0);
+	}
+
+	return 0;
+}
+
+
+/**
+ * Computes XLALGreenwichMeanSiderealTime() on the regular grid of \c n
+ * times \c start + \c i \c deltaT, storing the results in \c gmst.
+ * The Julian day is only recomputed when the grid crosses into a new
+ * integer second.
+ */
+int XLALGreenwichMeanSiderealTimeGrid(
+	REAL8 *gmst,
+	const LIGOTimeGPS *start,
+	REAL8 deltaT,
+	UINT4 n
+)
+{
+	double julian_day = 0.0;
+	INT4 gpssec = 0;
+	UINT4 i;
+
+	XLAL_CHECK(start && (gmst || !n), XLAL_EFAULT);
+
+	for(i = 0; i < n; i++) {
+		LIGOTimeGPS t = *start;
+		XLALGPSAdd(&t, i * deltaT);
+		if(i == 0 || t.gpsSeconds != gpssec) {
+			gpssec = t.gpsSeconds;
+			julian_day = gps_julian_day(gpssec);
+			if(XLAL_IS_REAL8_FAIL_NAN(julian_day))
+				XLAL_ERROR(XLAL_EFUNC);
+		}
+		gmst[i] = sidereal_time_from_julian_day(julian_day, t.gpsNanoSeconds, 0.0);
+	}
+
+	return 0;
+}
+
+
 /**
  * Inverse of XLALGreenwichMeanSiderealTime().  The input is sidereal time
  * in radians since the Julian epoch (currently J2000 for LAL), and the
@@ -418,18 +418,103 @@ static void median_cleanup_REAL8( REAL8FrequencySeries *work, UINT4 n )
   return;
 }
 
-/* comparison for floating point numbers */
-static int compare_REAL4( const void *p1, const void *p2 )
+/* select the k-th smallest of n floating point numbers; the array is
+ * partially reordered so that x[i] <= x[k] for i < k and x[i] >= x[k] for
+ * i > k; this is O(n) on average compared with O(n log n) for sorting */
+static REAL4 select_REAL4( REAL4 *x, UINT4 n, UINT4 k )
 {
-  REAL4 x1 = *(const REAL4 *)p1;
-  REAL4 x2 = *(const REAL4 *)p2;
-  return (x1 > x2) - (x1 < x2);
+  INT8 lo = 0;
+  INT8 hi = (INT8) n - 1;
+  while ( lo < hi )
+  {
+    const REAL4 pivot = x[lo + (hi - lo)/2];
+    INT8 i = lo;
+    INT8 j = hi;
+    while ( i <= j )
+    {
+      while ( x[i] < pivot )
+        ++i;
+      while ( x[j] > pivot )
+        --j;
+      if ( i <= j )
+      {
+        const REAL4 tmp = x[i];
+        x[i++] = x[j];
+        x[j--] = tmp;
+      }
+    }
+    if ( (INT8) k <= j )
+      hi = j;
+    else if ( (INT8) k >= i )
+      lo = i;
+    else
+      break;
+  }
+  return x[k];
+}
+
+static REAL8 select_REAL8( REAL8 *x, UINT4 n, UINT4 k )
+{
+  INT8 lo = 0;
+  INT8 hi = (INT8) n - 1;
+  while ( lo < hi )
+  {
+    const REAL8 pivot = x[lo + (hi - lo)/2];
+    INT8 i = lo;
+    INT8 j = hi;
+    while ( i <= j )
+    {
+      while ( x[i] < pivot )
+        ++i;
+      while ( x[j] > pivot )
+        --j;
+      if ( i <= j )
+      {
+        const REAL8 tmp = x[i];
+        x[i++] = x[j];
+        x[j--] = tmp;
+      }
+    }
+    if ( (INT8) k <= j )
+      hi = j;
+    else if ( (INT8) k >= i )
+      lo = i;
+    else
+      break;
+  }
+  return x[k];
+}
+
+/* median of n floating point numbers; the array is partially reordered */
+static REAL4 median_REAL4( REAL4 *x, UINT4 n )
+{
+  REAL4 median = select_REAL4( x, n, n/2 );
+  if ( n % 2 == 0 ) /* even number... take average */
+  {
+    /* after selection x[0..n/2-1] are all <= x[n/2] */
+    REAL4 lower = x[0];
+    UINT4 i;
+    for ( i = 1; i < n/2; ++i )
+      if ( x[i] > lower )
+        lower = x[i];
+    median = 0.5*(lower + median);
+  }
+  return median;
 }
-static int compare_REAL8( const void *p1, const void *p2 )
+static REAL8 median_REAL8( REAL8 *x, UINT4 n )
 {
-  REAL8 x1 = *(const REAL8 *)p1;
-  REAL8 x2 = *(const REAL8 *)p2;
-  return (x1 > x2) - (x1 < x2);
+  REAL8 median = select_REAL8( x, n, n/2 );
+  if ( n % 2 == 0 ) /* even number... take average */
+  {
+    /* after selection x[0..n/2-1] are all <= x[n/2] */
+    REAL8 lower = x[0];
+    UINT4 i;
+    for ( i = 1; i < n/2; ++i )
+      if ( x[i] > lower )
+        lower = x[i];
+    median = 0.5*(lower + median);
+  }
+  return median;
 }
 
 
@@ -451,8 +536,8 @@ int XLALREAL4AverageSpectrumMedian(
     )
 {
   REAL4FrequencySeries *work; /* array of frequency series */
-  REAL4 *bin; /* array of bin values */
   REAL4 biasfac; /* median bias factor */
+  int nomem; /* set if a thread fails to allocate memory */
   REAL4 normfac; /* normalization factor */
   UINT4 reclen; /* length of entire data record */
   UINT4 numseg;
@@ -516,36 +601,48 @@ int XLALREAL4AverageSpectrumMedian(
     }
   }
 
-  /* create array to hold a particular frequency bin data */
-  bin = XLALMalloc( numseg * sizeof( *bin ) );
-  if ( ! bin )
-  {
-    median_cleanup_REAL4( work, numseg ); /* cleanup */
-    XLAL_ERROR( XLAL_ENOMEM );
-  }
-
   /* compute median bias factor */
   biasfac = XLALMedianBias( numseg );
 
   /* normaliztion takes into account bias */
   normfac = 1.0 / biasfac;
 
-  /* now loop over frequency bins and compute the median-mean */
-  for ( k = 0; k < spectrum->data->length; ++k )
+  /* now loop over frequency bins and compute the median; the frequency
+   * bins are independent so blocks of them are handled in parallel, each
+   * thread with its own array to hold a particular frequency bin data */
+  nomem = 0;
+#pragma omp parallel
   {
-    /* assign array of even segment values to bin array for this freq bin */
-    for ( seg = 0; seg < numseg; ++seg )
-      bin[seg] = work[seg].data->data[k];
-
-    /* sort them and find median */
-    qsort( bin, numseg, sizeof( *bin ), compare_REAL4 );
-    if ( numseg % 2 ) /* odd number of evens */
-      spectrum->data->data[k] = bin[numseg/2];
-    else /* even number... take average */
-      spectrum->data->data[k] = 0.5*(bin[numseg/2-1] + bin[numseg/2]);
-
-    /* remove median bias */
-    spectrum->data->data[k] *= normfac;
+    REAL4 *bin = XLALMalloc( numseg * sizeof( *bin ) );
+    if ( ! bin )
+    {
+#pragma omp atomic write
+      nomem = 1;
+    }
+
+    /* every thread must reach the work-sharing loop; a thread without
+     * a buffer skips its bins, and the failure is reported below */
+#pragma omp for schedule(static)
+    for ( k = 0; k < spectrum->data->length; ++k )
+    {
+      UINT4 iseg;
+
+      if ( ! bin )
+        continue;
+
+      /* assign array of segment values to bin array for this freq bin */
+      for ( iseg = 0; iseg < numseg; ++iseg )
+        bin[iseg] = work[iseg].data->data[k];
+
+      /* find median by selection and remove median bias */
+      spectrum->data->data[k] = normfac * median_REAL4( bin, numseg );
+    }
+    XLALFree( bin );
+  }
+  if ( nomem )
+  {
+    median_cleanup_REAL4( work, numseg ); /* cleanup */
+    XLAL_ERROR( XLAL_ENOMEM );
   }
 
   /* set metadata */
@@ -555,7 +652,6 @@ int XLALREAL4AverageSpectrumMedian(
   spectrum->sampleUnits = work->sampleUnits;
 
   /* free the workspace data */
-  XLALFree( bin );
   median_cleanup_REAL4( work, numseg );
 
   return 0;
@@ -579,8 +675,8 @@ int XLALREAL8AverageSpectrumMedian(
     )
 {
   REAL8FrequencySeries *work; /* array of frequency series */
-  REAL8 *bin; /* array of bin values */
   REAL8 biasfac; /* median bias factor */
+  int nomem; /* set if a thread fails to allocate memory */
   REAL8 normfac; /* normalization factor */
   UINT4 reclen; /* length of entire data record */
   UINT4 numseg;
@@ -644,36 +740,48 @@ int XLALREAL8AverageSpectrumMedian(
     }
   }
 
-  /* create array to hold a particular frequency bin data */
-  bin = XLALMalloc( numseg * sizeof( *bin ) );
-  if ( ! bin )
-  {
-    median_cleanup_REAL8( work, numseg ); /* cleanup */
-    XLAL_ERROR( XLAL_ENOMEM );
-  }
-
   /* compute median bias factor */
   biasfac = XLALMedianBias( numseg );
 
   /* normaliztion takes into account bias */
   normfac = 1.0 / biasfac;
 
-  /* now loop over frequency bins and compute the median-mean */
-  for ( k = 0; k < spectrum->data->length; ++k )
+  /* now loop over frequency bins and compute the median; the frequency
+   * bins are independent so blocks of them are handled in parallel, each
+   * thread with its own array to hold a particular frequency bin data */
+  nomem = 0;
+#pragma omp parallel
   {
-    /* assign array of even segment values to bin array for this freq bin */
-    for ( seg = 0; seg < numseg; ++seg )
-      bin[seg] = work[seg].data->data[k];
-
-    /* sort them and find median */
-    qsort( bin, numseg, sizeof( *bin ), compare_REAL8 );
-    if ( numseg % 2 ) /* odd number of evens */
-      spectrum->data->data[k] = bin[numseg/2];
-    else /* even number... take average */
-      spectrum->data->data[k] = 0.5*(bin[numseg/2-1] + bin[numseg/2]);
-
-    /* remove median bias */
-    spectrum->data->data[k] *= normfac;
+    REAL8 *bin = XLALMalloc( numseg * sizeof( *bin ) );
+    if ( ! bin )
+    {
+#pragma omp atomic write
+      nomem = 1;
+    }
+
+    /* every thread must reach the work-sharing loop; a thread without
+     * a buffer skips its bins, and the failure is reported below */
+#pragma omp for schedule(static)
+    for ( k = 0; k < spectrum->data->length; ++k )
+    {
+      UINT4 iseg;
+
+      if ( ! bin )
+        continue;
+
+      /* assign array of segment values to bin array for this freq bin */
+      for ( iseg = 0; iseg < numseg; ++iseg )
+        bin[iseg] = work[iseg].data->data[k];
+
+      /* find median by selection and remove median bias */
+      spectrum->data->data[k] = normfac * median_REAL8( bin, numseg );
+    }
+    XLALFree( bin );
+  }
+  if ( nomem )
+  {
+    median_cleanup_REAL8( work, numseg ); /* cleanup */
+    XLAL_ERROR( XLAL_ENOMEM );
   }
 
   /* set metadata */
@@ -683,7 +791,6 @@ int XLALREAL8AverageSpectrumMedian(
   spectrum->sampleUnits = work->sampleUnits;
 
   /* free the workspace data */
-  XLALFree( bin );
   median_cleanup_REAL8( work, numseg );
 
   return 0;
@@ -749,8 +856,8 @@ int XLALREAL4AverageSpectrumMedianMean(
 {
   REAL4FrequencySeries *even; /* array of even frequency series */
   REAL4FrequencySeries *odd;  /* array of odd frequency series */
-  REAL4 *bin; /* array of bin values */
   REAL4 biasfac; /* median bias factor */
+  int nomem; /* set if a thread fails to allocate memory */
   REAL4 normfac; /* normalization factor */
   UINT4 reclen; /* length of entire data record */
   UINT4 numseg;
@@ -840,14 +947,6 @@ int XLALREAL4AverageSpectrumMedianMean(
     *tseries->data = savevec;
   }
 
-  /* create array to hold a particular frequency bin data */
-  bin = XLALMalloc( halfnumseg * sizeof( *bin ) );
-  if ( ! bin )
-  {
-    median_mean_cleanup_REAL4( even, odd, halfnumseg ); /* cleanup */
-    XLAL_ERROR( XLAL_ENOMEM );
-  }
-
   /* compute median bias factor */
   biasfac = XLALMedianBias( halfnumseg );
 
@@ -855,36 +954,55 @@ int XLALREAL4AverageSpectrumMedianMean(
    * the even and the odd */
   normfac = 1.0 / ( 2.0 * biasfac );
 
-  /* now loop over frequency bins and compute the median-mean */
-  for ( k = 0; k < spectrum->data->length; ++k )
+  /* now loop over frequency bins and compute the median-mean; the
+   * frequency bins are independent so blocks of them are handled in
+   * parallel, each thread with its own array to hold a particular
+   * frequency bin data */
+  nomem = 0;
+#pragma omp parallel
   {
-    REAL4 evenmedian;
-    REAL4 oddmedian;
-
-    /* assign array of even segment values to bin array for this freq bin */
-    for ( seg = 0; seg < halfnumseg; ++seg )
-      bin[seg] = even[seg].data->data[k];
-
-    /* sort them and find median */
-    qsort( bin, halfnumseg, sizeof( *bin ), compare_REAL4 );
-    if ( halfnumseg % 2 ) /* odd number of evens */
-      evenmedian = bin[halfnumseg/2];
-    else /* even number... take average */
-      evenmedian = 0.5*(bin[halfnumseg/2-1] + bin[halfnumseg/2]);
-
-    /* assign array of odd segment values to bin array for this freq bin */
-    for ( seg = 0; seg < halfnumseg; ++seg )
-      bin[seg] = odd[seg].data->data[k];
-
-    /* sort them and find median */
-    qsort( bin, halfnumseg, sizeof( *bin ), compare_REAL4 );
-    if ( halfnumseg % 2 ) /* odd number of odds */
-      oddmedian = bin[halfnumseg/2];
-    else /* even number... take average */
-      oddmedian = 0.5*(bin[halfnumseg/2-1] + bin[halfnumseg/2]);
-
-    /* spectrum for this bin is the mean of the medians */
-    spectrum->data->data[k] = normfac * (evenmedian + oddmedian);
+    REAL4 *bin = XLALMalloc( halfnumseg * sizeof( *bin ) );
+    if ( ! bin )
+    {
+#pragma omp atomic write
+      nomem = 1;
+    }
+
+    /* every thread must reach the work-sharing loop; a thread without
+     * a buffer skips its bins, and the failure is reported below */
+#pragma omp for schedule(static)
+    for ( k = 0; k < spectrum->data->length; ++k )
+    {
+      REAL4 evenmedian;
+      REAL4 oddmedian;
+      UINT4 iseg;
+
+      if ( ! bin )
+        continue;
+
+      /* assign array of even segment values to bin array for this freq bin */
+      for ( iseg = 0; iseg < halfnumseg; ++iseg )
+        bin[iseg] = even[iseg].data->data[k];
+
+      /* find median by selection */
+      evenmedian = median_REAL4( bin, halfnumseg );
+
+      /* assign array of odd segment values to bin array for this freq bin */
+      for ( iseg = 0; iseg < halfnumseg; ++iseg )
+        bin[iseg] = odd[iseg].data->data[k];
+
+      /* find median by selection */
+      oddmedian = median_REAL4( bin, halfnumseg );
+
+      /* spectrum for this bin is the mean of the medians */
+      spectrum->data->data[k] = normfac * (evenmedian + oddmedian);
+    }
+    XLALFree( bin );
+  }
+  if ( nomem )
+  {
+    median_mean_cleanup_REAL4( even, odd, halfnumseg ); /* cleanup */
+    XLAL_ERROR( XLAL_ENOMEM );
   }
 
   /* set metadata */
@@ -894,7 +1012,6 @@ int XLALREAL4AverageSpectrumMedianMean(
   spectrum->sampleUnits = even->sampleUnits;
 
   /* free the workspace data */
-  XLALFree( bin );
   median_mean_cleanup_REAL4( even, odd, halfnumseg );
 
   return 0;
@@ -918,8 +1035,8 @@ int XLALREAL8AverageSpectrumMedianMean(
 {
   REAL8FrequencySeries *even; /* array of even frequency series */
   REAL8FrequencySeries *odd;  /* array of odd frequency series */
-  REAL8 *bin; /* array of bin values */
   REAL8 biasfac; /* median bias factor */
+  int nomem; /* set if a thread fails to allocate memory */
   REAL8 normfac; /* normalization factor */
   UINT4 reclen; /* length of entire data record */
   UINT4 numseg;
@@ -1009,14 +1126,6 @@ int XLALREAL8AverageSpectrumMedianMean(
     *tseries->data = savevec;
   }
 
-  /* create array to hold a particular frequency bin data */
-  bin = XLALMalloc( halfnumseg * sizeof( *bin ) );
-  if ( ! bin )
-  {
-    median_mean_cleanup_REAL8( even, odd, halfnumseg ); /* cleanup */
-    XLAL_ERROR( XLAL_ENOMEM );
-  }
-
   /* compute median bias factor */
   biasfac = XLALMedianBias( halfnumseg );
 
@@ -1024,36 +1133,55 @@ int XLALREAL8AverageSpectrumMedianMean(
    * the even and the odd */
   normfac = 1.0 / ( 2.0 * biasfac );
 
-  /* now loop over frequency bins and compute the median-mean */
-  for ( k = 0; k < spectrum->data->length; ++k )
+  /* now loop over frequency bins and compute the median-mean; the
+   * frequency bins are independent so blocks of them are handled in
+   * parallel, each thread with its own array to hold a particular
+   * frequency bin data */
+  nomem = 0;
+#pragma omp parallel
   {
-    REAL8 evenmedian;
-    REAL8 oddmedian;
-
-    /* assign array of even segment values to bin array for this freq bin */
-    for ( seg = 0; seg < halfnumseg; ++seg )
-      bin[seg] = even[seg].data->data[k];
-
-    /* sort them and find median */
-    qsort( bin, halfnumseg, sizeof( *bin ), compare_REAL8 );
-    if ( halfnumseg % 2 ) /* odd number of evens */
-      evenmedian = bin[halfnumseg/2];
-    else /* even number... take average */
-      evenmedian = 0.5*(bin[halfnumseg/2-1] + bin[halfnumseg/2]);
-
-    /* assign array of odd segment values to bin array for this freq bin */
-    for ( seg = 0; seg < halfnumseg; ++seg )
-      bin[seg] = odd[seg].data->data[k];
-
-    /* sort them and find median */
-    qsort( bin, halfnumseg, sizeof( *bin ), compare_REAL8 );
-    if ( halfnumseg % 2 ) /* odd number of odds */
-      oddmedian = bin[halfnumseg/2];
-    else /* even number... take average */
-      oddmedian = 0.5*(bin[halfnumseg/2-1] + bin[halfnumseg/2]);
-
-    /* spectrum for this bin is the mean of the medians */
-    spectrum->data->data[k] = normfac * (evenmedian + oddmedian);
+    REAL8 *bin = XLALMalloc( halfnumseg * sizeof( *bin ) );
+    if ( ! bin )
+    {
+#pragma omp atomic write
+      nomem = 1;
+    }
+
+    /* every thread must reach the work-sharing loop; a thread without
+     * a buffer skips its bins, and the failure is reported below */
+#pragma omp for schedule(static)
+    for ( k = 0; k < spectrum->data->length; ++k )
+    {
+      REAL8 evenmedian;
+      REAL8 oddmedian;
+      UINT4 iseg;
+
+      if ( ! bin )
+        continue;
+
+      /* assign array of even segment values to bin array for this freq bin */
+      for ( iseg = 0; iseg < halfnumseg; ++iseg )
+        bin[iseg] = even[iseg].data->data[k];
+
+      /* find median by selection */
+      evenmedian = median_REAL8( bin, halfnumseg );
+
+      /* assign array of odd segment values to bin array for this freq bin */
+      for ( iseg = 0; iseg < halfnumseg; ++iseg )
+        bin[iseg] = odd[iseg].data->data[k];
+
+      /* find median by selection */
+      oddmedian = median_REAL8( bin, halfnumseg );
+
+      /* spectrum for this bin is the mean of the medians */
+      spectrum->data->data[k] = normfac * (evenmedian + oddmedian);
+    }
+    XLALFree( bin );
+  }
+  if ( nomem )
+  {
+    median_mean_cleanup_REAL8( even, odd, halfnumseg ); /* cleanup */
+    XLAL_ERROR( XLAL_ENOMEM );
   }
 
   /* set metadata */
@@ -1063,7 +1191,6 @@ int XLALREAL8AverageSpectrumMedianMean(
   spectrum->sampleUnits = even->sampleUnits;
 
   /* free the workspace data */
-  XLALFree( bin );
   median_mean_cleanup_REAL8( even, odd, halfnumseg );
 
   return 0;
@@ -1489,6 +1616,8 @@ LALPSDRegressor *XLALPSDRegressorNew(unsigned average_samples, unsigned median_s
   new->n_samples = 0;
   new->history = history;
   new->mean_square = NULL;
+  new->sorted_history = NULL;
+  new->sorted_length = 0;
 
   return new;
 }
@@ -1511,6 +1640,9 @@ void XLALPSDRegressorReset(LALPSDRegressor *r)
   }
   XLALDestroyREAL8FrequencySeries(r->mean_square);
   r->mean_square = NULL;
+  XLALDestroyREAL8Sequence(r->sorted_history);
+  r->sorted_history = NULL;
+  r->sorted_length = 0;
   r->n_samples = 0;
 }
 
@@ -1603,6 +1735,9 @@ int XLALPSDRegressorSetMedianSamples(LALPSDRegressor *r, unsigned median_samples
 
   r->median_samples = median_samples;
 
+  /* the sorted copy of the history is rebuilt on the next update */
+  r->sorted_length = 0;
+
   return 0;
 }
 
@@ -1614,6 +1749,78 @@ unsigned XLALPSDRegressorGetMedianSamples(const LALPSDRegressor *r)
   return r->median_samples;
 }
 
+/*
+ * The sorted_history of a LALPSDRegressor holds, for each frequency bin in
+ * turn, the square magnitudes of that bin's sorted_length most recent
+ * history samples in ascending order, so that the median of each bin can
+ * be updated by removing the sample leaving the median window and
+ * inserting the new one instead of re-sorting the whole window.
+ */
+
+/* insert x into the ascending array w of length n, which has room for n + 1
+ * elements */
+static void sorted_window_insert(double *w, unsigned n, double x)
+{
+  unsigned lo = 0, hi = n;
+  while(lo < hi)
+  {
+    unsigned mid = lo + (hi - lo) / 2;
+    if(w[mid] < x)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  memmove(w + lo + 1, w + lo, (n - lo) * sizeof(*w));
+  w[lo] = x;
+}
+
+/* remove one element equal to x from the ascending array w of length n */
+static void sorted_window_remove(double *w, unsigned n, double x)
+{
+  unsigned lo = 0, hi = n;
+  while(lo < hi)
+  {
+    unsigned mid = lo + (hi - lo) / 2;
+    if(w[mid] < x)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  /* can only happen if x is not in w, e.g. if it is a NaN */
+  if(lo >= n)
+    lo = n - 1;
+  memmove(w + lo, w + lo + 1, (n - lo - 1) * sizeof(*w));
+}
+
+/* rebuild the sorted copy of the most recent history_length samples of the
+ * median history */
+static int psd_regressor_sort_history(LALPSDRegressor *r, unsigned history_length)
+{
+  const unsigned length = r->mean_square->data->length;
+  unsigned i, j;
+
+  if(!r->sorted_history || r->sorted_history->length != length * r->median_samples)
+  {
+    XLALDestroyREAL8Sequence(r->sorted_history);
+    r->sorted_history = XLALCreateREAL8Sequence(length * r->median_samples);
+    if(!r->sorted_history)
+    {
+      r->sorted_length = 0;
+      XLAL_ERROR(XLAL_EFUNC);
+    }
+  }
+
+  for(i = 0; i < length; i++)
+  {
+    double *w = r->sorted_history->data + i * r->median_samples;
+    for(j = 0; j < history_length; j++)
+      sorted_window_insert(w, j, r->history[j]->data[i]);
+  }
+  r->sorted_length = history_length;
+
+  return 0;
+}
+
 /**
  * Update a LALPSDRegressor object from a frequency series object.  The
  * frequency series is assumed to have been computed from real-valued data
@@ -1628,10 +1835,16 @@ unsigned XLALPSDRegressorGetMedianSamples(const LALPSDRegressor *r)
  * the only mechanism by which they can be changed is to call
  * XLALPSDRegressorReset() and reset the regressor to the newly-allocated
  * state.
+ *
+ * The median of each frequency bin is maintained incrementally:  the
+ * regressor keeps a sorted copy of each bin's median history, from which
+ * the oldest sample is removed and into which the new sample is inserted
+ * by binary search, so the history is not copied and re-sorted on every
+ * update.
  */
 int XLALPSDRegressorAdd(LALPSDRegressor *r, const COMPLEX16FrequencySeries *sample)
 {
-  double *bin_history;
+  const REAL8Sequence *leaving;
   unsigned history_length;
   double median_bias;
   unsigned i;
@@ -1673,9 +1886,10 @@ int XLALPSDRegressorAdd(LALPSDRegressor *r, const COMPLEX16FrequencySeries *samp
     for(i = 0; i < sample->data->length; i++)
       r->mean_square->data->data[i] = log(r->history[0]->data[i] = cabs2(sample->data->data[i]));
 
-    /* set n_samples to 1 */
+    /* set n_samples to 1; the sorted history is built on the next update */
 
     r->n_samples = 1;
+    r->sorted_length = 0;
 
     /* done */
 
@@ -1701,11 +1915,6 @@ int XLALPSDRegressorAdd(LALPSDRegressor *r, const COMPLEX16FrequencySeries *samp
   r->history[0] = oldest;
   }
 
-  /* copy data from current sample into history buffer */
-
-  for(i = 0; i < sample->data->length; i++)
-    r->history[0]->data[i] = cabs2(sample->data->data[i]);
-
   /* bump the number of samples that have been recorded */
 
   if(r->n_samples < r->average_samples)
@@ -1714,12 +1923,35 @@ int XLALPSDRegressorAdd(LALPSDRegressor *r, const COMPLEX16FrequencySeries *samp
     /* just in case */
     r->n_samples = r->average_samples;
 
-  /* create array to hold one frequency bin's history */
-
   history_length = r->n_samples < r->median_samples ? r->n_samples : r->median_samples;
-  bin_history = XLALMalloc(history_length * sizeof(*bin_history));
-  if(!bin_history)
-    XLAL_ERROR(XLAL_ENOMEM);
+
+  /* copy data from current sample into history buffer, and update the
+   * sorted history.  if the median window has kept its length, the sample
+   * leaving it was previously the last in the window, and has now moved up
+   * one place or, if the buffer is full, been recycled as the first.  if
+   * the sorted history is not in step with the history it is rebuilt */
+
+  if(r->sorted_history && r->sorted_length && (history_length == r->sorted_length || history_length == r->sorted_length + 1))
+  {
+    leaving = history_length == r->sorted_length ? r->history[r->sorted_length % r->median_samples] : NULL;
+    for(i = 0; i < sample->data->length; i++)
+    {
+      double *w = r->sorted_history->data + i * r->median_samples;
+      unsigned n = r->sorted_length;
+      if(leaving)
+        /* read the leaving sample before it is overwritten */
+        sorted_window_remove(w, n--, leaving->data[i]);
+      sorted_window_insert(w, n, r->history[0]->data[i] = cabs2(sample->data->data[i]));
+    }
+    r->sorted_length = history_length;
+  }
+  else
+  {
+    for(i = 0; i < sample->data->length; i++)
+      r->history[0]->data[i] = cabs2(sample->data->data[i]);
+    if(psd_regressor_sort_history(r, history_length) < 0)
+      XLAL_ERROR(XLAL_EFUNC);
+  }
 
   /* compute the logarithm of the median bias factor */
 
@@ -1730,18 +1962,11 @@ int XLALPSDRegressorAdd(LALPSDRegressor *r, const COMPLEX16FrequencySeries *samp
 
   for(i = 0; i < r->mean_square->data->length; i++)
   {
-    unsigned j;
     double log_bin_median;
 
-    /* retrieve the history for this bin */
+    /* read the median from the sorted history for this bin */
 
-    for(j = 0; j < history_length; j++)
-      bin_history[j] = r->history[j]->data[i];
-
-    /* sort (to find the median) */
-
-    qsort(bin_history, history_length, sizeof(*bin_history), compare_REAL8);
-    log_bin_median = log(bin_history[history_length / 2]);
+    log_bin_median = log(r->sorted_history->data[i * r->median_samples + history_length / 2]);
 
     /* use logarithm of median to update geometric mean.
      *
@@ -1761,7 +1986,6 @@ int XLALPSDRegressorAdd(LALPSDRegressor *r, const COMPLEX16FrequencySeries *samp
       r->mean_square->data->data[i] = (r->mean_square->data->data[i] * (r->n_samples - 1) + log_bin_median - median_bias) / r->n_samples;
   }
 
-  XLALFree(bin_history);
   return 0;
 }
 
@@ -1894,6 +2118,9 @@ int XLALPSDRegressorSetPSD(LALPSDRegressor *r, const REAL8FrequencySeries *psd,
   /* set the n_samples paramter */
   r->n_samples = weight <= r->average_samples ? weight : r->average_samples;
 
+  /* the sorted copy of the history is rebuilt on the next update */
+  r->sorted_length = 0;
+
   return 0;
 }
 
@@ -85,6 +85,7 @@ typedef struct tagCOMPLEX16FFTPlan COMPLEX16FFTPlan;
 #ifdef SWIG /* SWIG interface directives */
 SWIGLAL(VIEWIN_ARRAYS(COMPLEX8Vector, output));
 SWIGLAL(VIEWIN_ARRAYS(COMPLEX16Vector, output));
+SWIGLAL(RELEASE_GIL(XLALCOMPLEX8VectorFFT, XLALCOMPLEX16VectorFFT));
 #endif /* SWIG */
 
 /*
@@ -2,7 +2,8 @@
 #define CONCAT2(a,b) CONCAT2x(a,b)
 #define CONCAT3x(a,b,c) a##b##c
 #define CONCAT3(a,b,c) CONCAT3x(a,b,c)
-#define STRING(a) #a
+#define STRINGx(a) #a
+#define STRING(a) STRINGx(a)
 
 #ifdef SINGLE_PRECISION
 #define COMPLEX_TYPE COMPLEX8
@@ -192,7 +193,9 @@ int VECTOR_FFT_FUNCTION(COMPLEX_VECTOR_TYPE * _LAL_RESTRICT_ output, const COMPL
 
     /* perform the fft */
 
+    XLAL_PROFILE_BEGIN(fft, STRING(VECTOR_FFT_FUNCTION));
     FFTWX_EXECUTE_DFT(plan->plan, (FFTWX_COMPLEX *)input_data, (FFTWX_COMPLEX *)output_data);
+    XLAL_PROFILE_END(fft);
 
     /* cleanup aligned memory space if memory alignment is required;
      * copy data from temporary space to output vector */
@@ -213,6 +216,7 @@ int VECTOR_FFT_FUNCTION(COMPLEX_VECTOR_TYPE * _LAL_RESTRICT_ output, const COMPL
 #undef CONCAT2
 #undef CONCAT3x
 #undef CONCAT3
+#undef STRINGx
 #undef STRING
 
 #undef COMPLEX_TYPE
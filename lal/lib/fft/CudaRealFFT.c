@@ -40,6 +40,7 @@ tagREAL4FFTPlan
 {
   INT4       sign;
   UINT4      size;
+  UINT4      howmany;
   cufftHandle plan;
   REAL4	    *d_real;
   COMPLEX8  *d_complex;
@@ -50,6 +51,7 @@ tagREAL8FFTPlan
 {
   INT4       sign;
   UINT4      size;
+  UINT4      howmany;
   fftw_plan  plan;
 };
 
@@ -61,6 +63,15 @@ tagREAL8FFTPlan
  */
 
 
+int XLALSetFFTPlanThreads( int nthreads )
+{
+  if ( nthreads < 1 )
+    XLAL_ERROR( XLAL_EDOM, "Number of threads must be positive" );
+  /* the CUDA backend does not use host threads */
+  return 0;
+}
+
+
 REAL4FFTPlan * XLALCreateREAL4FFTPlan( UINT4 size, int fwdflg, UNUSED int measurelvl )
 {
   UINT4 createSize;
@@ -111,6 +122,7 @@ REAL4FFTPlan * XLALCreateREAL4FFTPlan( UINT4 size, int fwdflg, UNUSED int measur
 
   /* now set remaining plan fields */
   plan->size = size;
+  plan->howmany = 1;
   plan->sign = ( fwdflg ? -1 : 1 );
 
   return plan;
@@ -425,6 +437,7 @@ REAL8FFTPlan * XLALCreateREAL8FFTPlan( UINT4 size, int fwdflg, int measurelvl )
 
   /* now set remaining plan fields */
   plan->size = size;
+  plan->howmany = 1;
   plan->sign = ( fwdflg ? -1 : 1 );
 
   return plan;
@@ -634,3 +647,137 @@ int XLALREAL8PowerSpectrum( REAL8Vector *spec, const REAL8Vector *data,
   XLALFree( tmp );
   return 0;
 }
+
+
+/*
+ *
+ * REAL4 batched transforms: the CUDA backend performs the transforms of a
+ * batch one vector at a time using a single-vector plan
+ *
+ */
+
+
+REAL4FFTPlan * XLALCreateREAL4FFTPlanMany( UINT4 size, UINT4 howmany, int fwdflg, int measurelvl )
+{
+  REAL4FFTPlan *plan;
+  if ( ! howmany )
+    XLAL_ERROR_NULL( XLAL_EBADLEN );
+  plan = XLALCreateREAL4FFTPlan( size, fwdflg, measurelvl );
+  if ( ! plan )
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  plan->howmany = howmany;
+  return plan;
+}
+
+
+int XLALREAL4ForwardFFTMany( COMPLEX8VectorSequence *output, const REAL4VectorSequence *input, const REAL4FFTPlan *plan )
+{
+  UINT4 j;
+
+  if ( ! output || ! input || ! plan )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! output->data || ! input->data )
+    XLAL_ERROR( XLAL_EINVAL );
+  if ( input->length != plan->howmany || output->length != plan->howmany )
+    XLAL_ERROR( XLAL_EBADLEN );
+
+  for ( j = 0; j < plan->howmany; ++j )
+  {
+    REAL4Vector in = { input->vectorLength, input->data + j * input->vectorLength };
+    COMPLEX8Vector out = { output->vectorLength, output->data + j * output->vectorLength };
+    if ( XLALREAL4ForwardFFT( &out, &in, plan ) < 0 )
+      XLAL_ERROR( XLAL_EFUNC );
+  }
+
+  return 0;
+}
+
+
+int XLALREAL4ReverseFFTMany( REAL4VectorSequence *output, const COMPLEX8VectorSequence *input, const REAL4FFTPlan *plan )
+{
+  UINT4 j;
+
+  if ( ! output || ! input || ! plan )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! output->data || ! input->data )
+    XLAL_ERROR( XLAL_EINVAL );
+  if ( output->length != plan->howmany || input->length != plan->howmany )
+    XLAL_ERROR( XLAL_EBADLEN );
+
+  for ( j = 0; j < plan->howmany; ++j )
+  {
+    COMPLEX8Vector in = { input->vectorLength, input->data + j * input->vectorLength };
+    REAL4Vector out = { output->vectorLength, output->data + j * output->vectorLength };
+    if ( XLALREAL4ReverseFFT( &out, &in, plan ) < 0 )
+      XLAL_ERROR( XLAL_EFUNC );
+  }
+
+  return 0;
+}
+
+
+/*
+ *
+ * REAL8 batched transforms: the CUDA backend performs the transforms of a
+ * batch one vector at a time using a single-vector plan
+ *
+ */
+
+
+REAL8FFTPlan * XLALCreateREAL8FFTPlanMany( UINT4 size, UINT4 howmany, int fwdflg, int measurelvl )
+{
+  REAL8FFTPlan *plan;
+  if ( ! howmany )
+    XLAL_ERROR_NULL( XLAL_EBADLEN );
+  plan = XLALCreateREAL8FFTPlan( size, fwdflg, measurelvl );
+  if ( ! plan )
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  plan->howmany = howmany;
+  return plan;
+}
+
+
+int XLALREAL8ForwardFFTMany( COMPLEX16VectorSequence *output, const REAL8VectorSequence *input, const REAL8FFTPlan *plan )
+{
+  UINT4 j;
+
+  if ( ! output || ! input || ! plan )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! output->data || ! input->data )
+    XLAL_ERROR( XLAL_EINVAL );
+  if ( input->length != plan->howmany || output->length != plan->howmany )
+    XLAL_ERROR( XLAL_EBADLEN );
+
+  for ( j = 0; j < plan->howmany; ++j )
+  {
+    REAL8Vector in = { input->vectorLength, input->data + j * input->vectorLength };
+    COMPLEX16Vector out = { output->vectorLength, output->data + j * output->vectorLength };
+    if ( XLALREAL8ForwardFFT( &out, &in, plan ) < 0 )
+      XLAL_ERROR( XLAL_EFUNC );
+  }
+
+  return 0;
+}
+
+
+int XLALREAL8ReverseFFTMany( REAL8VectorSequence *output, const COMPLEX16VectorSequence *input, const REAL8FFTPlan *plan )
+{
+  UINT4 j;
+
+  if ( ! output || ! input || ! plan )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! output->data || ! input->data )
+    XLAL_ERROR( XLAL_EINVAL );
+  if ( output->length != plan->howmany || input->length != plan->howmany )
+    XLAL_ERROR( XLAL_EBADLEN );
+
+  for ( j = 0; j < plan->howmany; ++j )
+  {
+    COMPLEX16Vector in = { input->vectorLength, input->data + j * input->vectorLength };
+    REAL8Vector out = { output->vectorLength, output->data + j * output->vectorLength };
+    if ( XLALREAL8ReverseFFT( &out, &in, plan ) < 0 )
+      XLAL_ERROR( XLAL_EFUNC );
+  }
+
+  return 0;
+}
@@ -63,6 +63,7 @@ tagREAL4FFTPlan
 {
   INT4       sign; /* sign in transform exponential, -1 for forward, +1 for reverse */
   UINT4      size; /* length of the real data vector for this plan */
+  UINT4      howmany; /* number of vectors transformed by this plan */
   DFTI_DESCRIPTOR *plan; /* the MKL plan */
   REAL4     *tmp;
 };
@@ -75,12 +76,24 @@ tagREAL8FFTPlan
 {
   INT4       sign; /* sign in transform exponential, -1 for forward, +1 for reverse */
   UINT4      size; /* length of the real data vector for this plan */
+  UINT4      howmany; /* number of vectors transformed by this plan */
   DFTI_DESCRIPTOR *plan; /* the MKL plan */
   REAL8     *tmp;
 };
 
 
 
+/* number of threads used by new plans */
+static int lalFFTPlanThreads = 1;
+
+int XLALSetFFTPlanThreads(int nthreads)
+{
+    if (nthreads < 1)
+        XLAL_ERROR(XLAL_EDOM, "Number of threads must be positive");
+    lalFFTPlanThreads = nthreads;
+    return 0;
+}
+
 /* single- and double-precision routines */
 
 #define SINGLE_PRECISION
@@ -19,8 +19,11 @@
 #define PLAN_TYPE			CONCAT2(REAL_TYPE,FFTPlan)
 #define REAL_VECTOR_TYPE		CONCAT2(REAL_TYPE,Vector)
 #define COMPLEX_VECTOR_TYPE		CONCAT2(COMPLEX_TYPE,Vector)
+#define REAL_SEQUENCE_TYPE		CONCAT2(REAL_TYPE,VectorSequence)
+#define COMPLEX_SEQUENCE_TYPE		CONCAT2(COMPLEX_TYPE,VectorSequence)
 
 #define CREATE_PLAN_FUNCTION		CONCAT2(XLALCreate,PLAN_TYPE)
+#define CREATE_PLAN_MANY_FUNCTION	CONCAT3(XLALCreate,PLAN_TYPE,Many)
 #define CREATE_FORWARD_PLAN_FUNCTION	CONCAT2(XLALCreateForward,PLAN_TYPE)
 #define CREATE_REVERSE_PLAN_FUNCTION	CONCAT2(XLALCreateReverse,PLAN_TYPE)
 #define DESTROY_PLAN_FUNCTION		CONCAT2(XLALDestroy,PLAN_TYPE)
@@ -28,6 +31,8 @@
 #define REVERSE_FFT_FUNCTION		CONCAT3(XLAL,REAL_TYPE,ReverseFFT)
 #define VECTOR_FFT_FUNCTION		CONCAT3(XLAL,REAL_VECTOR_TYPE,FFT)
 #define POWER_SPECTRUM_FUNCTION		CONCAT3(XLAL,REAL_TYPE,PowerSpectrum)
+#define FORWARD_FFT_MANY_FUNCTION	CONCAT3(XLAL,REAL_TYPE,ForwardFFTMany)
+#define REVERSE_FFT_MANY_FUNCTION	CONCAT3(XLAL,REAL_TYPE,ReverseFFTMany)
 
 #define CREALX				CONCAT2(creal,TYPESUFFIX)
 #define CIMAGX				CONCAT2(cimag,TYPESUFFIX)
@@ -36,12 +41,12 @@
 #define FFTWX_DESTROY_PLAN		CONCAT2(FFTWX,_destroy_plan)
 #define FFTWX_EXECUTE_R2R		CONCAT2(FFTWX,_execute_r2r)
 
-PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, __attribute__ ((unused)) int measurelvl)
+PLAN_TYPE *CREATE_PLAN_MANY_FUNCTION(UINT4 size, UINT4 howmany, int fwdflg, __attribute__ ((unused)) int measurelvl)
 {
     PLAN_TYPE *plan;
     INT8  fftStat;
 
-    if (!size)
+    if (!size || !howmany)
         XLAL_ERROR_NULL(XLAL_EBADLEN);
 
     /* allocate memory for the plan */
@@ -62,13 +67,32 @@ PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, __attribute__ ((unused))
     fftStat = DftiSetValue(plan->plan, DFTI_PACKED_FORMAT,
         DFTI_PACK_FORMAT);
     CHECKINTELFFTSTATUS_NULL(fftStat);
+    if (howmany > 1)
+    {
+        /* batch of contiguous vectors, each of length size */
+        fftStat = DftiSetValue(plan->plan, DFTI_NUMBER_OF_TRANSFORMS,
+            (MKL_LONG) howmany);
+        CHECKINTELFFTSTATUS_NULL(fftStat);
+        fftStat = DftiSetValue(plan->plan, DFTI_INPUT_DISTANCE,
+            (MKL_LONG) size);
+        CHECKINTELFFTSTATUS_NULL(fftStat);
+        fftStat = DftiSetValue(plan->plan, DFTI_OUTPUT_DISTANCE,
+            (MKL_LONG) size);
+        CHECKINTELFFTSTATUS_NULL(fftStat);
+    }
+    if (lalFFTPlanThreads > 1)
+    {
+        fftStat = DftiSetValue(plan->plan, DFTI_THREAD_LIMIT,
+            (MKL_LONG) lalFFTPlanThreads);
+        CHECKINTELFFTSTATUS_NULL(fftStat);
+    }
 
     /* commit the intel fft descriptor */
     fftStat = DftiCommitDescriptor(plan->plan);
     CHECKINTELFFTSTATUS_NULL(fftStat);
 
     /* create workspace to do the fft into */
-    plan->tmp = XLALMalloc(size * sizeof(REAL_TYPE));
+    plan->tmp = XLALMalloc((size_t) howmany * size * sizeof(REAL_TYPE));
     if (!plan->tmp)
     {
       XLALFree(plan);
@@ -78,11 +102,21 @@ PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, __attribute__ ((unused))
     /* set remaining plan fields */
 
     plan->size = size;
+    plan->howmany = howmany;
     plan->sign = (fwdflg ? -1 : 1);
 
     return plan;
 }
 
+PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
+{
+    PLAN_TYPE *plan;
+    plan = CREATE_PLAN_MANY_FUNCTION(size, 1, fwdflg, measurelvl);
+    if (!plan)
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    return plan;
+}
+
 PLAN_TYPE *CREATE_FORWARD_PLAN_FUNCTION(UINT4 size, int measurelvl)
 {
     PLAN_TYPE *plan;
@@ -126,7 +160,7 @@ int FORWARD_FFT_FUNCTION(COMPLEX_VECTOR_TYPE * output, const REAL_VECTOR_TYPE *
 
     if (!output || !input || !plan)
         XLAL_ERROR(XLAL_EFAULT);
-    if (!plan->plan || !plan->size || plan->sign != -1)
+    if (!plan->plan || !plan->size || plan->howmany != 1 || plan->sign != -1)
         XLAL_ERROR(XLAL_EINVAL);
     if (!output->data || !input->data)
         XLAL_ERROR(XLAL_EINVAL);
@@ -169,7 +203,7 @@ int REVERSE_FFT_FUNCTION(REAL_VECTOR_TYPE * output, const COMPLEX_VECTOR_TYPE *
 
     if (!output || !input || !plan)
         XLAL_ERROR(XLAL_EFAULT);
-    if (!plan->plan || !plan->size || plan->sign != 1)
+    if (!plan->plan || !plan->size || plan->howmany != 1 || plan->sign != 1)
         XLAL_ERROR(XLAL_EINVAL);
     if (!output->data || !input->data)
         XLAL_ERROR(XLAL_EINVAL);
@@ -215,7 +249,7 @@ int VECTOR_FFT_FUNCTION(REAL_VECTOR_TYPE * _LAL_RESTRICT_ output, const REAL_VEC
     /* sanity check on arguments */
     if (!output || !input || !plan)
         XLAL_ERROR(XLAL_EFAULT);
-    if (!plan->plan || !plan->size)
+    if (!plan->plan || !plan->size || plan->howmany != 1)
         XLAL_ERROR(XLAL_EINVAL);
     if (!output->data || !input->data || output->data == input->data)
         XLAL_ERROR(XLAL_EINVAL);        /* note: must be out-of-place */
@@ -273,7 +307,7 @@ int POWER_SPECTRUM_FUNCTION(REAL_VECTOR_TYPE * spec, const REAL_VECTOR_TYPE * da
     /* sanity check on arguments */
     if (!spec || !data || !plan)
         XLAL_ERROR(XLAL_EFAULT);
-    if (!plan->plan || !plan->size)
+    if (!plan->plan || !plan->size || plan->howmany != 1)
         XLAL_ERROR(XLAL_EINVAL);
     if (!spec->data || !data->data)
         XLAL_ERROR(XLAL_EINVAL);
@@ -305,6 +339,108 @@ int POWER_SPECTRUM_FUNCTION(REAL_VECTOR_TYPE * spec, const REAL_VECTOR_TYPE * da
     return 0;
 }
 
+int FORWARD_FFT_MANY_FUNCTION(COMPLEX_SEQUENCE_TYPE * output, const REAL_SEQUENCE_TYPE * input, const PLAN_TYPE * plan)
+{
+    INT8  fftStat;
+    UINT4 n,j,k;
+
+    if (!output || !input || !plan)
+        XLAL_ERROR(XLAL_EFAULT);
+    if (!plan->plan || !plan->size || plan->sign != -1)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (!output->data || !input->data)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (input->length != plan->howmany || output->length != plan->howmany)
+        XLAL_ERROR(XLAL_EBADLEN);
+    if (input->vectorLength != plan->size || output->vectorLength != plan->size/2 + 1)
+        XLAL_ERROR(XLAL_EBADLEN);
+
+    n = plan->size;
+
+    /* execute intel fft */
+    fftStat = DftiComputeForward(plan->plan, input->data, plan->tmp);
+    CHECKINTELFFTSTATUS(fftStat);
+
+    /* now unpack the results into the output vectors */
+    for (j = 0; j < plan->howmany; ++j)
+    {
+        const REAL_TYPE *tmpj = plan->tmp + j * n;
+        COMPLEX_TYPE *outj = output->data + j * output->vectorLength;
+
+        /* dc component */
+        outj[0] = tmpj[0] + 0.0 * _Complex_I;
+
+        /* other components */
+        for (k = 1; k < (n + 1) / 2; ++k) /* k < n/2 rounded up */
+        {
+            outj[k] = tmpj[2 * k - 1] + (tmpj[2 * k] * _Complex_I);
+        }
+
+        /* Nyquist frequency */
+        if (n % 2 == 0) /* n is even */
+        {
+            outj[n / 2] = tmpj[n - 1] + 0.0 * _Complex_I;
+        }
+    }
+
+    return 0;
+}
+
+
+int REVERSE_FFT_MANY_FUNCTION(REAL_SEQUENCE_TYPE * output, const COMPLEX_SEQUENCE_TYPE * input, const PLAN_TYPE * plan)
+{
+    INT8  fftStat;
+    UINT4 n,j,k;
+
+    /* sanity checks on arguments */
+
+    if (!output || !input || !plan)
+        XLAL_ERROR(XLAL_EFAULT);
+    if (!plan->plan || !plan->size || plan->sign != 1)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (!output->data || !input->data)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (output->length != plan->howmany || input->length != plan->howmany)
+        XLAL_ERROR(XLAL_EBADLEN);
+    if (output->vectorLength != plan->size || input->vectorLength != plan->size / 2 + 1)
+        XLAL_ERROR(XLAL_EBADLEN);
+
+    n = plan->size;
+
+    for (j = 0; j < plan->howmany; ++j)
+    {
+        const COMPLEX_TYPE *inj = input->data + j * input->vectorLength;
+        REAL_TYPE *tmpj = plan->tmp + j * n;
+
+        if (CIMAGX(inj[0]) != 0.0)
+            XLAL_ERROR(XLAL_EDOM);  /* imaginary part of DC must be zero */
+        if (n % 2 == 0 && CIMAGX(inj[n / 2]) != 0.0)
+            XLAL_ERROR(XLAL_EDOM);  /* imaginary part of Nyquist must be zero */
+
+        /* dc component */
+        tmpj[0] = CREALX(inj[0]);
+
+        /* other components */
+        for ( k = 1; k < ( n + 1 ) / 2; ++k ) /* k < n / 2 rounded up */
+        {
+            tmpj[2 * k - 1] = CREALX(inj[k]);
+            tmpj[2 * k]     = CIMAGX(inj[k]);
+        }
+
+        /* Nyquist component */
+        if ( n % 2 == 0 ) /* n is even */
+        {
+            tmpj[n - 1] = CREALX(inj[n / 2]);
+        }
+    }
+
+    /* execute intel fft */
+    fftStat = DftiComputeBackward( plan->plan, plan->tmp, output->data );
+    CHECKINTELFFTSTATUS( fftStat );
+
+    return 0;
+}
+
 #undef CONCAT2x
 #undef CONCAT2
 #undef CONCAT3x
@@ -319,8 +455,11 @@ int POWER_SPECTRUM_FUNCTION(REAL_VECTOR_TYPE * spec, const REAL_VECTOR_TYPE * da
 #undef PLAN_TYPE
 #undef REAL_VECTOR_TYPE
 #undef COMPLEX_VECTOR_TYPE
+#undef REAL_SEQUENCE_TYPE
+#undef COMPLEX_SEQUENCE_TYPE
 
 #undef CREATE_PLAN_FUNCTION
+#undef CREATE_PLAN_MANY_FUNCTION
 #undef CREATE_FORWARD_PLAN_FUNCTION
 #undef CREATE_REVERSE_PLAN_FUNCTION
 #undef DESTROY_PLAN_FUNCTION
@@ -328,6 +467,8 @@ int POWER_SPECTRUM_FUNCTION(REAL_VECTOR_TYPE * spec, const REAL_VECTOR_TYPE * da
 #undef REVERSE_FFT_FUNCTION
 #undef VECTOR_FFT_FUNCTION
 #undef POWER_SPECTRUM_FUNCTION
+#undef FORWARD_FFT_MANY_FUNCTION
+#undef REVERSE_FFT_MANY_FUNCTION
 
 #undef CREALX
 #undef CIMAGX
@@ -21,12 +21,15 @@
 
 #include <complex.h>
 #include <fftw3.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <lal/LALDatatypes.h>
 #include <lal/FFTWMutex.h>
 #include <lal/LALConfig.h> /* Needed to know whether aligning memory */
 #include <lal/LALMalloc.h>
+#include <lal/LALProfile.h>
 #include <lal/RealFFT.h>
 #include <lal/SeqFactories.h>
 #include <lal/XLALError.h>
@@ -154,7 +157,12 @@ tagREAL4FFTPlan
 {
   INT4       sign; /**< sign in transform exponential, -1 for forward, +1 for reverse */
   UINT4      size; /**< length of the real data vector for this plan */
+  UINT4      howmany; /**< number of vectors transformed by this plan */
   fftwf_plan plan; /**< the FFTW plan */
+  int        measurelvl; /**< measurement level used to create the FFTW plan */
+  int        nthreads; /**< number of threads used by the FFTW plan */
+  UINT4      refcount; /**< number of users of this shared plan */
+  struct tagREAL4FFTPlan *next; /**< next shared plan */
 };
 
 /**
@@ -165,11 +173,47 @@ tagREAL8FFTPlan
 {
   INT4       sign; /**< sign in transform exponential, -1 for forward, +1 for reverse */
   UINT4      size; /**< length of the real data vector for this plan */
+  UINT4      howmany; /**< number of vectors transformed by this plan */
   fftw_plan  plan; /**< the FFTW plan */
+  int        measurelvl; /**< measurement level used to create the FFTW plan */
+  int        nthreads; /**< number of threads used by the FFTW plan */
+  UINT4      refcount; /**< number of users of this shared plan */
+  struct tagREAL8FFTPlan *next; /**< next shared plan */
 };
 
 
 
+/* FFTW threads are used only if both the single- and double-precision libraries are available */
+#if defined(HAVE_LIBFFTW3_THREADS) && defined(HAVE_LIBFFTW3F_THREADS)
+#define HAVE_FFTW3_THREADS
+#endif
+
+/* number of threads used by new plans; protected by the FFTW wisdom lock */
+static int lalFFTPlanThreads = 1;
+
+int XLALSetFFTPlanThreads(int nthreads)
+{
+    if (nthreads < 1)
+        XLAL_ERROR(XLAL_EDOM, "Number of threads must be positive");
+#   ifdef HAVE_FFTW3_THREADS
+    static int init_threads = 0;
+    LAL_FFTW_WISDOM_LOCK;
+    if (!init_threads) {
+        if (!fftw_init_threads() || !fftwf_init_threads()) {
+            LAL_FFTW_WISDOM_UNLOCK;
+            XLAL_ERROR(XLAL_EFAILED, "Could not initialise FFTW threads");
+        }
+        init_threads = 1;
+    }
+    lalFFTPlanThreads = nthreads;
+    LAL_FFTW_WISDOM_UNLOCK;
+#   else
+    if (nthreads > 1)
+        XLALPrintWarning("WARNING: %s: LAL was not built with FFTW threads; plans will use one thread\n", __func__);
+#   endif
+    return 0;
+}
+
 /* single- and double-precision routines */
 
 #define SINGLE_PRECISION
@@ -53,22 +53,30 @@ extern "C" {
  * REAL4FFTPlan * XLALCreateREAL4FFTPlan( UINT4 size, int fwdflg, int measurelvl );
  * REAL4FFTPlan * XLALCreateForwardREAL4FFTPlan( UINT4 size, int measurelvl );
  * REAL4FFTPlan * XLALCreateReverseREAL4FFTPlan( UINT4 size, int measurelvl );
+ * REAL4FFTPlan * XLALCreateREAL4FFTPlanMany( UINT4 size, UINT4 howmany, int fwdflg, int measurelvl );
  * void XLALDestroyREAL4FFTPlan( REAL4FFTPlan *plan );
  *
  * int XLALREAL4ForwardFFT( COMPLEX8Vector *output, REAL4Vector *input, REAL4FFTPlan *plan );
  * int XLALREAL4ReverseFFT( REAL4Vector *output, COMPLEX8Vector *input, REAL4FFTPlan *plan );
  * int XLALREAL4VectorFFT( REAL4Vector *output, REAL4Vector *input, REAL4FFTPlan *plan );
  * int XLALREAL4PowerSpectrum( REAL4Vector *spec, REAL4Vector *data, REAL4FFTPlan *plan );
+ * int XLALREAL4ForwardFFTMany( COMPLEX8VectorSequence *output, REAL4VectorSequence *input, REAL4FFTPlan *plan );
+ * int XLALREAL4ReverseFFTMany( REAL4VectorSequence *output, COMPLEX8VectorSequence *input, REAL4FFTPlan *plan );
  *
  * REAL8FFTPlan * XLALCreateREAL8FFTPlan( UINT4 size, int fwdflg, int measurelvl );
  * REAL8FFTPlan * XLALCreateForwardREAL8FFTPlan( UINT4 size, int measurelvl );
  * REAL8FFTPlan * XLALCreateReverseREAL8FFTPlan( UINT4 size, int measurelvl );
+ * REAL8FFTPlan * XLALCreateREAL8FFTPlanMany( UINT4 size, UINT4 howmany, int fwdflg, int measurelvl );
  * void XLALDestroyREAL8FFTPlan( REAL8FFTPlan *plan );
  *
  * int XLALREAL8ForwardFFT( COMPLEX16Vector *output, REAL8Vector *input, REAL8FFTPlan *plan );
  * int XLALREAL8ReverseFFT( REAL8Vector *output, COMPLEX16Vector *input, REAL8FFTPlan *plan );
  * int XLALREAL8VectorFFT( REAL8Vector *output, REAL8Vector *input, REAL8FFTPlan *plan );
  * int XLALREAL8PowerSpectrum( REAL8Vector *spec, REAL8Vector *data, REAL8FFTPlan *plan );
+ * int XLALREAL8ForwardFFTMany( COMPLEX16VectorSequence *output, REAL8VectorSequence *input, REAL8FFTPlan *plan );
+ * int XLALREAL8ReverseFFTMany( REAL8VectorSequence *output, COMPLEX16VectorSequence *input, REAL8FFTPlan *plan );
+ *
+ * int XLALSetFFTPlanThreads( int nthreads );
  * \endcode
  *
  * ### Description ###
@@ -100,6 +108,16 @@ extern "C" {
  * memory that was allocated in the structure as well as the structure
  * itself.  It can be used on either forward or reverse plans.
  *
+ * With FFTW, plans are shared: XLALCreateREAL4FFTPlan() returns an existing
+ * plan of the same size, direction, and \c measurelvl if there is one, and
+ * XLALDestroyREAL4FFTPlan() only destroys a plan once all its users have
+ * destroyed it.  Plans may be used concurrently by several threads.
+ * If the environment variable \c FFTWF_WISDOM_FILENAME (\c FFTW_WISDOM_FILENAME
+ * for \c REAL8 plans) is set, FFTW wisdom is imported from the named file
+ * when the first plan is created, so that repeated runs need not measure
+ * plans again; as for the resampling F-statistic, the wisdom file is not
+ * written by LAL, but can be generated with the \c fftw-wisdom tool.
+ *
  * XLALREAL4ForwardFFT() and
  * XLALREAL4ReverseFFT() perform forward (real to complex) and
  * reverse (complex to real) transforms respectively.  The plan supplied
@@ -199,6 +217,10 @@ SWIGLAL(VIEWIN_ARRAYS(REAL4Vector, output, spec));
 SWIGLAL(VIEWIN_ARRAYS(REAL8Vector, output, spec));
 SWIGLAL(VIEWIN_ARRAYS(COMPLEX8Vector, output));
 SWIGLAL(VIEWIN_ARRAYS(COMPLEX16Vector, output));
+SWIGLAL(RELEASE_GIL(XLALREAL4ForwardFFT, XLALREAL4ReverseFFT, XLALREAL4VectorFFT, XLALREAL4PowerSpectrum,
+                    XLALREAL4ForwardFFTMany, XLALREAL4ReverseFFTMany,
+                    XLALREAL8ForwardFFT, XLALREAL8ReverseFFT, XLALREAL8VectorFFT, XLALREAL8PowerSpectrum,
+                    XLALREAL8ForwardFFTMany, XLALREAL8ReverseFFTMany));
 #endif /* SWIG */
 
 /*
@@ -428,6 +450,77 @@ int XLALREAL4VectorFFT( REAL4Vector * _LAL_RESTRICT_ output, const REAL4Vector *
  */
 int XLALREAL4PowerSpectrum( REAL4Vector * _LAL_RESTRICT_ spec, const REAL4Vector * _LAL_RESTRICT_ data, const REAL4FFTPlan *plan );
 
+/**
+ * Returns a new REAL4FFTPlan for a batch of \c howmany transforms
+ *
+ * The plan transforms \c howmany contiguous real data vectors of length
+ * \c size at once, which is faster than transforming them one at a time
+ * for short transforms.  It can only be used with XLALREAL4ForwardFFTMany()
+ * or XLALREAL4ReverseFFTMany(), and is destroyed with XLALDestroyREAL4FFTPlan().
+ *
+ * @param[in] size The number of points in each real data vector.
+ * @param[in] howmany The number of vectors in each batch.
+ * @param[in] fwdflg Set non-zero for a forward FFT plan;
+ * otherwise create a reverse plan
+ * @param[in] measurelvl Measurement level for plan creation,
+ * as for XLALCreateREAL4FFTPlan().
+ * @return A pointer to an allocated \c REAL4FFTPlan structure is returned
+ * upon successful completion.  Otherwise, a \c NULL pointer is returned
+ * and \c xlalErrno is set to indicate the error.
+ * @par Errors:
+ * The \c XLALCreateREAL4FFTPlanMany() function shall fail if:
+ * - [\c XLAL_EBADLEN] The size of the requested plan or \c howmany is 0.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * - [\c XLAL_EFAILED] The call to the underlying FFT routine failed.
+ * .
+ */
+REAL4FFTPlan * XLALCreateREAL4FFTPlanMany( UINT4 size, UINT4 howmany, int fwdflg, int measurelvl );
+
+/**
+ * Performs a batch of forward FFTs of REAL4 data
+ *
+ * Each of the \c howmany vectors of the input sequence is transformed
+ * as by XLALREAL4ForwardFFT() into the corresponding vector of the output sequence.
+ *
+ * @param[out] output The complex output data sequence, with \c howmany
+ * vectors of length \c size/2+1.
+ * @param[in] input The real input data sequence, with \c howmany vectors of length \c size.
+ * @param[in] plan The batched forward FFT plan to use.
+ * @retval 0 Success.
+ * @retval #XLAL_FAILURE Failure.
+ * @par Errors:
+ * The \c XLALREAL4ForwardFFTMany() function shall fail if:
+ * - [\c XLAL_EFAULT] A \c NULL pointer is provided as one of the arguments.
+ * - [\c XLAL_EINVAL] A argument is invalid or the plan is for a reverse transform.
+ * - [\c XLAL_EBADLEN] The sequence dimensions are incompatible with the plan.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * .
+ */
+int XLALREAL4ForwardFFTMany( COMPLEX8VectorSequence *output, const REAL4VectorSequence *input, const REAL4FFTPlan *plan );
+
+/**
+ * Performs a batch of reverse FFTs of COMPLEX8 data
+ *
+ * Each of the \c howmany vectors of the input sequence is transformed
+ * as by XLALREAL4ReverseFFT() into the corresponding vector of the output sequence.
+ *
+ * @param[out] output The real output data sequence, with \c howmany vectors of length \c size.
+ * @param[in] input The complex input data sequence, with \c howmany
+ * vectors of length \c size/2+1.
+ * @param[in] plan The batched reverse FFT plan to use.
+ * @retval 0 Success.
+ * @retval #XLAL_FAILURE Failure.
+ * @par Errors:
+ * The \c XLALREAL4ReverseFFTMany() function shall fail if:
+ * - [\c XLAL_EFAULT] A \c NULL pointer is provided as one of the arguments.
+ * - [\c XLAL_EINVAL] A argument is invalid or the plan is for a forward transform.
+ * - [\c XLAL_EBADLEN] The sequence dimensions are incompatible with the plan.
+ * - [\c XLAL_EDOM] Some of the DC and Nyquist components of the input are not real.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * .
+ */
+int XLALREAL4ReverseFFTMany( REAL4VectorSequence *output, const COMPLEX8VectorSequence *input, const REAL4FFTPlan *plan );
+
 /*
  *
  * XLAL REAL8 functions
@@ -660,6 +753,96 @@ int XLALREAL8VectorFFT( REAL8Vector *output, const REAL8Vector *input,
 int XLALREAL8PowerSpectrum( REAL8Vector *spec, const REAL8Vector *data,
     const REAL8FFTPlan *plan );
 
+/**
+ * Returns a new REAL8FFTPlan for a batch of \c howmany transforms
+ *
+ * The plan transforms \c howmany contiguous real data vectors of length
+ * \c size at once, which is faster than transforming them one at a time
+ * for short transforms.  It can only be used with XLALREAL8ForwardFFTMany()
+ * or XLALREAL8ReverseFFTMany(), and is destroyed with XLALDestroyREAL8FFTPlan().
+ *
+ * @param[in] size The number of points in each real data vector.
+ * @param[in] howmany The number of vectors in each batch.
+ * @param[in] fwdflg Set non-zero for a forward FFT plan;
+ * otherwise create a reverse plan
+ * @param[in] measurelvl Measurement level for plan creation,
+ * as for XLALCreateREAL8FFTPlan().
+ * @return A pointer to an allocated \c REAL8FFTPlan structure is returned
+ * upon successful completion.  Otherwise, a \c NULL pointer is returned
+ * and \c xlalErrno is set to indicate the error.
+ * @par Errors:
+ * The \c XLALCreateREAL8FFTPlanMany() function shall fail if:
+ * - [\c XLAL_EBADLEN] The size of the requested plan or \c howmany is 0.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * - [\c XLAL_EFAILED] The call to the underlying FFT routine failed.
+ * .
+ */
+REAL8FFTPlan * XLALCreateREAL8FFTPlanMany( UINT4 size, UINT4 howmany, int fwdflg, int measurelvl );
+
+/**
+ * Performs a batch of forward FFTs of REAL8 data
+ *
+ * Each of the \c howmany vectors of the input sequence is transformed
+ * as by XLALREAL8ForwardFFT() into the corresponding vector of the output sequence.
+ *
+ * @param[out] output The complex output data sequence, with \c howmany
+ * vectors of length \c size/2+1.
+ * @param[in] input The real input data sequence, with \c howmany vectors of length \c size.
+ * @param[in] plan The batched forward FFT plan to use.
+ * @retval 0 Success.
+ * @retval #XLAL_FAILURE Failure.
+ * @par Errors:
+ * The \c XLALREAL8ForwardFFTMany() function shall fail if:
+ * - [\c XLAL_EFAULT] A \c NULL pointer is provided as one of the arguments.
+ * - [\c XLAL_EINVAL] A argument is invalid or the plan is for a reverse transform.
+ * - [\c XLAL_EBADLEN] The sequence dimensions are incompatible with the plan.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * .
+ */
+int XLALREAL8ForwardFFTMany( COMPLEX16VectorSequence *output, const REAL8VectorSequence *input, const REAL8FFTPlan *plan );
+
+/**
+ * Performs a batch of reverse FFTs of COMPLEX16 data
+ *
+ * Each of the \c howmany vectors of the input sequence is transformed
+ * as by XLALREAL8ReverseFFT() into the corresponding vector of the output sequence.
+ *
+ * @param[out] output The real output data sequence, with \c howmany vectors of length \c size.
+ * @param[in] input The complex input data sequence, with \c howmany
+ * vectors of length \c size/2+1.
+ * @param[in] plan The batched reverse FFT plan to use.
+ * @retval 0 Success.
+ * @retval #XLAL_FAILURE Failure.
+ * @par Errors:
+ * The \c XLALREAL8ReverseFFTMany() function shall fail if:
+ * - [\c XLAL_EFAULT] A \c NULL pointer is provided as one of the arguments.
+ * - [\c XLAL_EINVAL] A argument is invalid or the plan is for a forward transform.
+ * - [\c XLAL_EBADLEN] The sequence dimensions are incompatible with the plan.
+ * - [\c XLAL_EDOM] Some of the DC and Nyquist components of the input are not real.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * .
+ */
+int XLALREAL8ReverseFFTMany( REAL8VectorSequence *output, const COMPLEX16VectorSequence *input, const REAL8FFTPlan *plan );
+
+/*
+ *
+ * XLAL functions for both precisions
+ *
+ */
+
+/**
+ * Sets the number of threads used by subsequently created FFT plans
+ *
+ * Multi-threaded plans are worthwhile only for large transforms.  With FFTW,
+ * this requires LAL to be built with the FFTW threads libraries; otherwise
+ * a warning is printed and plans continue to use one thread.
+ *
+ * @param[in] nthreads The number of threads; must be positive.
+ * @retval 0 Success.
+ * @retval #XLAL_FAILURE Failure.
+ */
+int XLALSetFFTPlanThreads( int nthreads );
+
 /** @} */
 
 #if 0
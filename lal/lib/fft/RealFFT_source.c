@@ -2,23 +2,29 @@
 #define CONCAT2(a,b) CONCAT2x(a,b)
 #define CONCAT3x(a,b,c) a##b##c
 #define CONCAT3(a,b,c) CONCAT3x(a,b,c)
-#define STRING(a) #a
+#define STRINGx(a) #a
+#define STRING(a) STRINGx(a)
 
 #ifdef SINGLE_PRECISION
 #define REAL_TYPE REAL4
 #define COMPLEX_TYPE COMPLEX8
 #define TYPESUFFIX f
+#define WISDOM_ENV_VAR "FFTWF_WISDOM_FILENAME"
 #else
 #define REAL_TYPE REAL8
 #define COMPLEX_TYPE COMPLEX16
 #define TYPESUFFIX
+#define WISDOM_ENV_VAR "FFTW_WISDOM_FILENAME"
 #endif
 
 #define PLAN_TYPE			CONCAT2(REAL_TYPE,FFTPlan)
 #define REAL_VECTOR_TYPE		CONCAT2(REAL_TYPE,Vector)
 #define COMPLEX_VECTOR_TYPE		CONCAT2(COMPLEX_TYPE,Vector)
+#define REAL_SEQUENCE_TYPE		CONCAT2(REAL_TYPE,VectorSequence)
+#define COMPLEX_SEQUENCE_TYPE		CONCAT2(COMPLEX_TYPE,VectorSequence)
 
 #define CREATE_PLAN_FUNCTION		CONCAT2(XLALCreate,PLAN_TYPE)
+#define CREATE_PLAN_MANY_FUNCTION	CONCAT3(XLALCreate,PLAN_TYPE,Many)
 #define CREATE_FORWARD_PLAN_FUNCTION	CONCAT2(XLALCreateForward,PLAN_TYPE)
 #define CREATE_REVERSE_PLAN_FUNCTION	CONCAT2(XLALCreateReverse,PLAN_TYPE)
 #define DESTROY_PLAN_FUNCTION		CONCAT2(XLALDestroy,PLAN_TYPE)
@@ -26,6 +32,11 @@
 #define REVERSE_FFT_FUNCTION		CONCAT3(XLAL,REAL_TYPE,ReverseFFT)
 #define VECTOR_FFT_FUNCTION		CONCAT3(XLAL,REAL_VECTOR_TYPE,FFT)
 #define POWER_SPECTRUM_FUNCTION		CONCAT3(XLAL,REAL_TYPE,PowerSpectrum)
+#define FORWARD_FFT_MANY_FUNCTION	CONCAT3(XLAL,REAL_TYPE,ForwardFFTMany)
+#define REVERSE_FFT_MANY_FUNCTION	CONCAT3(XLAL,REAL_TYPE,ReverseFFTMany)
+#define IMPORT_WISDOM_FUNCTION		CONCAT2(PLAN_TYPE,_import_wisdom)
+#define PLAN_CACHE			CONCAT2(PLAN_TYPE,_cache)
+#define WISDOM_IMPORTED			CONCAT2(PLAN_TYPE,_wisdom_imported)
 
 #define CREALX				CONCAT2(creal,TYPESUFFIX)
 #define CIMAGX				CONCAT2(cimag,TYPESUFFIX)
@@ -33,19 +44,68 @@
 #define FFTWX_PLAN_R2R_1D		CONCAT2(FFTWX,_plan_r2r_1d)
 #define FFTWX_DESTROY_PLAN		CONCAT2(FFTWX,_destroy_plan)
 #define FFTWX_EXECUTE_R2R		CONCAT2(FFTWX,_execute_r2r)
+#define FFTWX_PLAN_MANY_R2R		CONCAT2(FFTWX,_plan_many_r2r)
+#define FFTWX_R2R_KIND			CONCAT2(FFTWX,_r2r_kind)
+#define FFTWX_PLAN_WITH_NTHREADS	CONCAT2(FFTWX,_plan_with_nthreads)
+#define FFTWX_IMPORT_WISDOM_FROM_FILE	CONCAT2(FFTWX,_import_wisdom_from_file)
 
-PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
+/* shared plans, and state of FFTW wisdom; protected by the FFTW wisdom lock */
+static PLAN_TYPE *PLAN_CACHE = NULL;
+static int WISDOM_IMPORTED = 0;
+
+/* read FFTW wisdom from the file named by WISDOM_ENV_VAR, once; must hold the FFTW wisdom lock */
+static void IMPORT_WISDOM_FUNCTION(void)
+{
+    const char *fname = getenv(WISDOM_ENV_VAR);
+    FILE *fp;
+
+    if (WISDOM_IMPORTED)
+        return;
+    WISDOM_IMPORTED = 1;
+
+    if (!fname || !*fname)
+        return;
+
+    if ((fp = fopen(fname, "r")) == NULL) {
+        XLALPrintInfo("INFO: FFTW wisdom file '%s' does not exist yet\n", fname);
+    } else {
+        if (FFTWX_IMPORT_WISDOM_FROM_FILE(fp))
+            XLALPrintInfo("INFO: imported FFTW wisdom from file '%s'\n", fname);
+        else
+            XLALPrintWarning("WARNING: Couldn't import FFTW wisdom from file '%s'\n", fname);
+        fclose(fp);
+    }
+}
+
+PLAN_TYPE *CREATE_PLAN_MANY_FUNCTION(UINT4 size, UINT4 howmany, int fwdflg, int measurelvl)
 {
     PLAN_TYPE *plan;
     REAL_TYPE *tmp1;
     REAL_TYPE *tmp2;
     size_t nbytes;
     int flags;
+    int nthreads;
 
-    if (!size)
+    if (!size || !howmany)
         XLAL_ERROR_NULL(XLAL_EBADLEN);
 
-    nbytes = size * sizeof(REAL_TYPE);
+    nthreads = lalFFTPlanThreads;
+
+    /* return a shared plan with the same parameters, if one exists */
+
+    LAL_FFTW_WISDOM_LOCK;
+    IMPORT_WISDOM_FUNCTION();
+    for (plan = PLAN_CACHE; plan; plan = plan->next)
+        if (plan->size == size && plan->howmany == howmany && plan->sign == (fwdflg ? -1 : 1)
+            && plan->measurelvl == measurelvl && plan->nthreads == nthreads) {
+            ++plan->refcount;
+            break;
+        }
+    LAL_FFTW_WISDOM_UNLOCK;
+    if (plan)
+        return plan;
+
+    nbytes = (size_t) howmany * size * sizeof(REAL_TYPE);
 
     /* set fftw3 flags to perform requested degree of measurement */
 
@@ -94,13 +154,39 @@ PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
     }
 #   endif
 
-    /* establish fftw mutex lock and create plan */
+    /* set remaining plan fields */
+
+    plan->size = size;
+    plan->howmany = howmany;
+    plan->sign = (fwdflg ? -1 : 1);
+    plan->measurelvl = measurelvl;
+    plan->nthreads = nthreads;
+    plan->refcount = 1;
+
+    /* establish fftw mutex lock, create plan, and add it to the shared plans */
 
     LAL_FFTW_WISDOM_LOCK;
-    if (fwdflg) /* forward */
-        plan->plan = FFTWX_PLAN_R2R_1D(size, tmp1, tmp2, FFTW_R2HC, flags);
-    else        /* reverse */
-        plan->plan = FFTWX_PLAN_R2R_1D(size, tmp1, tmp2, FFTW_HC2R, flags);
+#   ifdef HAVE_FFTW3_THREADS
+    FFTWX_PLAN_WITH_NTHREADS(nthreads);
+#   endif
+    if (howmany == 1) {
+        if (fwdflg) /* forward */
+            plan->plan = FFTWX_PLAN_R2R_1D(size, tmp1, tmp2, FFTW_R2HC, flags);
+        else        /* reverse */
+            plan->plan = FFTWX_PLAN_R2R_1D(size, tmp1, tmp2, FFTW_HC2R, flags);
+    } else {
+        /* batch of contiguous vectors, each of length size */
+        int n = size;
+        FFTWX_R2R_KIND kind = (fwdflg ? FFTW_R2HC : FFTW_HC2R);
+        plan->plan = FFTWX_PLAN_MANY_R2R(1, &n, howmany, tmp1, NULL, 1, size, tmp2, NULL, 1, size, &kind, flags);
+    }
+#   ifdef HAVE_FFTW3_THREADS
+    FFTWX_PLAN_WITH_NTHREADS(1);
+#   endif
+    if (plan->plan) {
+        plan->next = PLAN_CACHE;
+        PLAN_CACHE = plan;
+    }
     LAL_FFTW_WISDOM_UNLOCK;
 
     /* free the temporary arrays */
@@ -120,11 +206,15 @@ PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
         XLAL_ERROR_NULL(XLAL_EFAILED);
     }
 
-    /* set remaining plan fields */
-
-    plan->size = size;
-    plan->sign = (fwdflg ? -1 : 1);
+    return plan;
+}
 
+PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
+{
+    PLAN_TYPE *plan;
+    plan = CREATE_PLAN_MANY_FUNCTION(size, 1, fwdflg, measurelvl);
+    if (!plan)
+        XLAL_ERROR_NULL(XLAL_EFUNC);
     return plan;
 }
 
@@ -149,13 +239,27 @@ PLAN_TYPE *CREATE_REVERSE_PLAN_FUNCTION(UINT4 size, int measurelvl)
 void DESTROY_PLAN_FUNCTION(PLAN_TYPE * plan)
 {
     if (plan) {
-        if (plan->plan) {
-            LAL_FFTW_WISDOM_LOCK;
-            FFTWX_DESTROY_PLAN(plan->plan);
-            LAL_FFTW_WISDOM_UNLOCK;
+        int destroy;
+
+        /* destroy plan once it is no longer shared */
+
+        LAL_FFTW_WISDOM_LOCK;
+        destroy = (--plan->refcount == 0);
+        if (destroy) {
+            PLAN_TYPE **p;
+            for (p = &PLAN_CACHE; *p; p = &(*p)->next)
+                if (*p == plan) {
+                    *p = plan->next;
+                    break;
+                }
+            if (plan->plan)
+                FFTWX_DESTROY_PLAN(plan->plan);
+        }
+        LAL_FFTW_WISDOM_UNLOCK;
+        if (destroy) {
+            memset(plan, 0, sizeof(*plan));
+            XLALFree(plan);
         }
-        memset(plan, 0, sizeof(*plan));
-        XLALFree(plan);
     }
 }
 
@@ -170,7 +274,7 @@ int FORWARD_FFT_FUNCTION(COMPLEX_VECTOR_TYPE * output, const REAL_VECTOR_TYPE *
 
     if (!output || !input || !plan)
         XLAL_ERROR(XLAL_EFAULT);
-    if (!plan->plan || !plan->size || plan->sign != -1)
+    if (!plan->plan || !plan->size || plan->howmany != 1 || plan->sign != -1)
         XLAL_ERROR(XLAL_EINVAL);
     if (!output->data || !input->data)
         XLAL_ERROR(XLAL_EINVAL);
@@ -204,7 +308,9 @@ int FORWARD_FFT_FUNCTION(COMPLEX_VECTOR_TYPE * output, const REAL_VECTOR_TYPE *
 
     /* perform the fft */
 
+    XLAL_PROFILE_BEGIN(fft, STRING(FORWARD_FFT_FUNCTION));
     FFTWX_EXECUTE_R2R(plan->plan, input_data, tmp);
+    XLAL_PROFILE_END(fft);
 
     /* unpack the results into the output vector */
 
@@ -243,7 +349,7 @@ int REVERSE_FFT_FUNCTION(REAL_VECTOR_TYPE * output, const COMPLEX_VECTOR_TYPE *
 
     if (!output || !input || !plan)
         XLAL_ERROR(XLAL_EFAULT);
-    if (!plan->plan || !plan->size || plan->sign != 1)
+    if (!plan->plan || !plan->size || plan->howmany != 1 || plan->sign != 1)
         XLAL_ERROR(XLAL_EINVAL);
     if (!output->data || !input->data)
         XLAL_ERROR(XLAL_EINVAL);
@@ -294,7 +400,9 @@ int REVERSE_FFT_FUNCTION(REAL_VECTOR_TYPE * output, const COMPLEX_VECTOR_TYPE *
 
     /* perform the fft */
 
+    XLAL_PROFILE_BEGIN(fft, STRING(REVERSE_FFT_FUNCTION));
     FFTWX_EXECUTE_R2R(plan->plan, tmp, output_data);
+    XLAL_PROFILE_END(fft);
 
     /* if temporary space for output data was created, copy data into
      * the output vector and free the temporary space */
@@ -327,7 +435,7 @@ int VECTOR_FFT_FUNCTION(REAL_VECTOR_TYPE * _LAL_RESTRICT_ output, const REAL_VEC
 
     if (!output || !input || !plan)
         XLAL_ERROR(XLAL_EFAULT);
-    if (!plan->plan || !plan->size)
+    if (!plan->plan || !plan->size || plan->howmany != 1)
         XLAL_ERROR(XLAL_EINVAL);
     if (!output->data || !input->data || output->data == input->data)
         XLAL_ERROR(XLAL_EINVAL);        /* note: must be out-of-place */
@@ -359,7 +467,9 @@ int VECTOR_FFT_FUNCTION(REAL_VECTOR_TYPE * _LAL_RESTRICT_ output, const REAL_VEC
 
     /* perform the fft */
 
+    XLAL_PROFILE_BEGIN(fft, STRING(VECTOR_FFT_FUNCTION));
     FFTWX_EXECUTE_R2R(plan->plan, input_data, output_data);
+    XLAL_PROFILE_END(fft);
 
     /* cleanup aligned memory space if memory alignment is required;
      * copy data from temporary space to output vector */
@@ -387,7 +497,7 @@ int POWER_SPECTRUM_FUNCTION(REAL_VECTOR_TYPE * spec, const REAL_VECTOR_TYPE * da
 
     if (!spec || !data || !plan)
         XLAL_ERROR(XLAL_EFAULT);
-    if (!plan->plan || !plan->size)
+    if (!plan->plan || !plan->size || plan->howmany != 1)
         XLAL_ERROR(XLAL_EINVAL);
     if (!spec->data || !data->data)
         XLAL_ERROR(XLAL_EINVAL);
@@ -421,7 +531,9 @@ int POWER_SPECTRUM_FUNCTION(REAL_VECTOR_TYPE * spec, const REAL_VECTOR_TYPE * da
 
     /* perform the fft */
 
+    XLAL_PROFILE_BEGIN(fft, STRING(POWER_SPECTRUM_FUNCTION));
     FFTWX_EXECUTE_R2R(plan->plan, input_data, tmp);
+    XLAL_PROFILE_END(fft);
 
     /* compute spectrum from the fft of the data */
 
@@ -453,21 +565,205 @@ int POWER_SPECTRUM_FUNCTION(REAL_VECTOR_TYPE * spec, const REAL_VECTOR_TYPE * da
     return 0;
 }
 
+int FORWARD_FFT_MANY_FUNCTION(COMPLEX_SEQUENCE_TYPE * output, const REAL_SEQUENCE_TYPE * input, const PLAN_TYPE * plan)
+{
+    REAL_TYPE *input_data;
+    REAL_TYPE *tmp;
+    UINT4 j, k;
+    size_t nbytes;
+
+    /* sanity checks on arguments */
+
+    if (!output || !input || !plan)
+        XLAL_ERROR(XLAL_EFAULT);
+    if (!plan->plan || !plan->size || plan->sign != -1)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (!output->data || !input->data)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (input->length != plan->howmany || output->length != plan->howmany)
+        XLAL_ERROR(XLAL_EBADLEN);
+    if (input->vectorLength != plan->size || output->vectorLength != plan->size / 2 + 1)
+        XLAL_ERROR(XLAL_EBADLEN);
+
+    nbytes = (size_t) plan->howmany * plan->size * sizeof(REAL_TYPE);
+    input_data = input->data;
+
+    /* create temporary storage space; make sure that input data is
+     * aligned, if memory alignment is required */
+
+#   ifdef LAL_FFTW3_MEMALIGN_ENABLED
+    tmp = XLALMallocAligned(nbytes);
+    if (!tmp)
+        XLAL_ERROR(XLAL_ENOMEM);
+    if (!LAL_IS_MEMORY_ALIGNED(input_data)) {
+        /* need to create temporary aligned space for input data */
+        input_data = XLALMallocAligned(nbytes);
+        if (!input_data) {
+            XLALFreeAligned(tmp);
+            XLAL_ERROR(XLAL_ENOMEM);
+        }
+        memcpy(input_data, input->data, nbytes);
+    }
+#   else
+    tmp = XLALMalloc(nbytes);
+    if (!tmp)
+        XLAL_ERROR(XLAL_ENOMEM);
+#   endif
+
+    /* perform the batch of ffts */
+
+    XLAL_PROFILE_BEGIN(fft, STRING(FORWARD_FFT_MANY_FUNCTION));
+    FFTWX_EXECUTE_R2R(plan->plan, input_data, tmp);
+    XLAL_PROFILE_END(fft);
+
+    /* unpack the results into the output vectors */
+
+    for (j = 0; j < plan->howmany; ++j) {
+        const REAL_TYPE *tmpj = tmp + j * plan->size;
+        COMPLEX_TYPE *outj = output->data + j * output->vectorLength;
+
+        /* dc component */
+        outj[0] = tmpj[0];
+
+        /* other components */
+        for (k = 1; k < (plan->size + 1) / 2; ++k)  /* k < size/2 rounded up */
+            outj[k] = tmpj[k] + I * tmpj[plan->size - k];
+
+        /* Nyquist frequency */
+        if (plan->size % 2 == 0)    /* n is even */
+            outj[plan->size / 2] = tmpj[plan->size / 2];
+    }
+
+    /* cleanup and return */
+
+#   ifdef LAL_FFTW3_MEMALIGN_ENABLED
+    if (input_data != input->data)
+        XLALFreeAligned(input_data);
+    XLALFreeAligned(tmp);
+#   else
+    XLALFree(tmp);
+#   endif
+
+    return 0;
+}
+
+int REVERSE_FFT_MANY_FUNCTION(REAL_SEQUENCE_TYPE * output, const COMPLEX_SEQUENCE_TYPE * input, const PLAN_TYPE * plan)
+{
+    REAL_TYPE *output_data;
+    REAL_TYPE *tmp;
+    UINT4 j, k;
+    size_t nbytes;
+
+    /* sanity checks on arguments */
+
+    if (!output || !input || !plan)
+        XLAL_ERROR(XLAL_EFAULT);
+    if (!plan->plan || !plan->size || plan->sign != 1)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (!output->data || !input->data)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (output->length != plan->howmany || input->length != plan->howmany)
+        XLAL_ERROR(XLAL_EBADLEN);
+    if (output->vectorLength != plan->size || input->vectorLength != plan->size / 2 + 1)
+        XLAL_ERROR(XLAL_EBADLEN);
+    for (j = 0; j < plan->howmany; ++j) {
+        const COMPLEX_TYPE *inj = input->data + j * input->vectorLength;
+        if (CIMAGX(inj[0]) != 0.0)
+            XLAL_ERROR(XLAL_EDOM);  /* imaginary part of DC must be zero */
+        if (plan->size % 2 == 0 && CIMAGX(inj[plan->size / 2]) != 0.0)
+            XLAL_ERROR(XLAL_EDOM);  /* imaginary part of Nyquist must be zero */
+    }
+
+    output_data = output->data;
+    nbytes = (size_t) plan->howmany * plan->size * sizeof(REAL_TYPE);
+
+    /* create temporary storage space; make sure that output data is
+     * aligned, if memory alignment is required */
+
+#   ifdef LAL_FFTW3_MEMALIGN_ENABLED
+    tmp = XLALMallocAligned(nbytes);
+    if (!tmp)
+        XLAL_ERROR(XLAL_ENOMEM);
+    if (!LAL_IS_MEMORY_ALIGNED(output_data)) {
+        output_data = XLALMallocAligned(nbytes);
+        if (!output_data) {
+            XLALFreeAligned(tmp);
+            XLAL_ERROR(XLAL_ENOMEM);
+        }
+    }
+#   else
+    tmp = XLALMalloc(nbytes);
+    if (!tmp)
+        XLAL_ERROR(XLAL_ENOMEM);
+#   endif
+
+    /* unpack input into temporary array */
+
+    for (j = 0; j < plan->howmany; ++j) {
+        const COMPLEX_TYPE *inj = input->data + j * input->vectorLength;
+        REAL_TYPE *tmpj = tmp + j * plan->size;
+
+        /* dc component */
+        tmpj[0] = CREALX(inj[0]);
+
+        /* other components */
+        for (k = 1; k < (plan->size + 1) / 2; ++k) {        /* k < size/2 rounded up */
+            tmpj[k] = CREALX(inj[k]);
+            tmpj[plan->size - k] = CIMAGX(inj[k]);
+        }
+
+        /* Nyquist component */
+        if (plan->size % 2 == 0)    /* n is even */
+            tmpj[plan->size / 2] = CREALX(inj[plan->size / 2]);
+    }
+
+    /* perform the batch of ffts */
+
+    XLAL_PROFILE_BEGIN(fft, STRING(REVERSE_FFT_MANY_FUNCTION));
+    FFTWX_EXECUTE_R2R(plan->plan, tmp, output_data);
+    XLAL_PROFILE_END(fft);
+
+    /* if temporary space for output data was created, copy data into
+     * the output vectors and free the temporary space */
+
+#   ifdef LAL_FFTW3_MEMALIGN_ENABLED
+    if (output_data != output->data) {
+        memcpy(output->data, output_data, nbytes);
+        XLALFreeAligned(output_data);
+    }
+#   endif
+
+    /* cleanup and return */
+
+#   ifdef LAL_FFTW3_MEMALIGN_ENABLED
+    XLALFreeAligned(tmp);
+#   else
+    XLALFree(tmp);
+#   endif
+
+    return 0;
+}
+
 #undef CONCAT2x
 #undef CONCAT2
 #undef CONCAT3x
 #undef CONCAT3
+#undef STRINGx
 #undef STRING
 
 #undef REAL_TYPE
 #undef COMPLEX_TYPE
 #undef TYPESUFFIX
+#undef WISDOM_ENV_VAR
 
 #undef PLAN_TYPE
 #undef REAL_VECTOR_TYPE
 #undef COMPLEX_VECTOR_TYPE
+#undef REAL_SEQUENCE_TYPE
+#undef COMPLEX_SEQUENCE_TYPE
 
 #undef CREATE_PLAN_FUNCTION
+#undef CREATE_PLAN_MANY_FUNCTION
 #undef CREATE_FORWARD_PLAN_FUNCTION
 #undef CREATE_REVERSE_PLAN_FUNCTION
 #undef DESTROY_PLAN_FUNCTION
@@ -475,6 +771,11 @@ int POWER_SPECTRUM_FUNCTION(REAL_VECTOR_TYPE * spec, const REAL_VECTOR_TYPE * da
 #undef REVERSE_FFT_FUNCTION
 #undef VECTOR_FFT_FUNCTION
 #undef POWER_SPECTRUM_FUNCTION
+#undef FORWARD_FFT_MANY_FUNCTION
+#undef REVERSE_FFT_MANY_FUNCTION
+#undef IMPORT_WISDOM_FUNCTION
+#undef PLAN_CACHE
+#undef WISDOM_IMPORTED
 
 #undef CREALX
 #undef CIMAGX
@@ -482,3 +783,7 @@ int POWER_SPECTRUM_FUNCTION(REAL_VECTOR_TYPE * spec, const REAL_VECTOR_TYPE * da
 #undef FFTWX_PLAN_R2R_1D
 #undef FFTWX_DESTROY_PLAN
 #undef FFTWX_EXECUTE_R2R
+#undef FFTWX_PLAN_MANY_R2R
+#undef FFTWX_R2R_KIND
+#undef FFTWX_PLAN_WITH_NTHREADS
+#undef FFTWX_IMPORT_WISDOM_FROM_FILE
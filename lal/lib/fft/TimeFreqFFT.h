@@ -183,6 +183,8 @@ tagLALPSDRegressor
   unsigned n_samples;
   REAL8Sequence **history;
   REAL8FrequencySeries *mean_square;
+  REAL8Sequence *sorted_history;	/**< sorted median history of each bin */
+  unsigned sorted_length;	/**< number of samples in each bin's sorted history */
 }
 LALPSDRegressor;
 
@@ -21,6 +21,9 @@
 #define _LALCHISQ_H_
 
 
+#include <lal/LALDatatypes.h>
+
+
 #ifdef  __cplusplus   /* C++ protection. */
 extern "C" {
 #endif
@@ -41,6 +44,26 @@ double XLALLogChisqCCDF(
 );
 
 
+int XLALLogChisqCCDFVector(
+	REAL8Vector *ln_prob,
+	const REAL8Vector *chi2,
+	double dof
+);
+
+
+double XLALLogChisqCCDFInverse(
+	double ln_prob,
+	double dof
+);
+
+
+int XLALLogChisqCCDFInverseVector(
+	REAL8Vector *chi2,
+	const REAL8Vector *ln_prob,
+	double dof
+);
+
+
   /** @} */
 
 #ifdef  __cplusplus
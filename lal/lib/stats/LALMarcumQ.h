@@ -17,6 +17,9 @@
  */
 
 
+#include <lal/LALDatatypes.h>
+
+
 /*
  * ============================================================================
  *
@@ -28,3 +31,8 @@
 
 double XLALMarcumQmodified(double M, double x, double y);
 double XLALMarcumQ(double M, double a, double b);
+int XLALMarcumQVector(REAL8Vector *Q, double M, double a, const REAL8Vector *b);
+double XLALMarcumQInverse(double M, double a, double Q);
+int XLALMarcumQInverseVector(REAL8Vector *b, double M, double a, const REAL8Vector *Q);
+double XLALNoncentralChisqCCDF(double x, double dof, double lambda);
+double XLALNoncentralChisqCCDFInverse(double prob, double dof, double lambda);
@@ -30,30 +30,16 @@
 #include <lal/XLALError.h>
 
 
-/**
- * Compute the natural logarithm of the complementary cumulative
- * probability function of the \f$\chi^{2}\f$ distribution.
- *
- * Returns the natural logarithm of the probability that \f$x_{1}^{2} +
- * \cdots + x_{\mathrm{dof}}^{2} \geq \chi^{2}\f$, where \f$x_{1}, \ldots,
- * x_{\mathrm{dof}}\f$ are independent zero mean unit variance Gaussian
- * random variables.  The integral expression is \f$\ln Q = \ln
- * \int_{\chi^{2}/2}^{\infty} x^{\frac{n}{2}-1} \mathrm{e}^{-x} /
- * \Gamma(n/2) \, \mathrm{d}x\f$, where \f$n = \mathrm{dof} =\f$ number of
- * degrees of freedom.
- *
- * Results agree with Mathematica to 15 digits or more where the two have
- * been compared and where Mathematica is able to compute a result.  For
- * example, it does not seem to be possible to obtain a numerical result
- * from Mathematica for the equivalent of XLALLogChisqCCDF(10000.0, 8.5)
- * using any number of digits in the intermediate calculations, though the
- * two implementations agree to better than 15 digits at
- * XLALLogChisqCCDF(10000.0, 8.0)
+/*
+ * Implementation of XLALLogChisqCCDF(), for valid input.  *lngamma_a caches
+ * the value of ln Gamma(dof/2), and should be initialized to NaN; this
+ * allows it to be computed once for many values of chi2.
  */
 
-double XLALLogChisqCCDF(
+static double log_chisq_ccdf(
 	double chi2,
-	double dof
+	double dof,
+	double *lngamma_a
 )
 {
 	/*
@@ -78,9 +64,6 @@ double XLALLogChisqCCDF(
 
 	double ln_prob;
 
-	if((chi2 < 0.0) || (dof <= 0.0))
-		XLAL_ERROR_REAL8(XLAL_EDOM);
-
 	/* start with a technique for intermediate probabilities */
 	XLAL_CALLGSL(ln_prob = log(gsl_cdf_chisq_Q(chi2, dof)));
 
@@ -127,8 +110,11 @@ double XLALLogChisqCCDF(
 		}
 		ln_prob = (a - 1.) * log(x) - x + log1p(sum);
 
-		/* subtract the log of the denominator */
-		XLAL_CALLGSL(ln_prob -= gsl_sf_lngamma(a));
+		/* subtract the log of the denominator, computing it on
+		 * first use */
+		if(isnan(*lngamma_a))
+			XLAL_CALLGSL(*lngamma_a = gsl_sf_lngamma(a));
+		ln_prob -= *lngamma_a;
 	}
 
 	/* check that the final answer is the log of a legal probability */
@@ -138,3 +124,199 @@ done:
 
 	return ln_prob;
 }
+
+
+/**
+ * Compute the natural logarithm of the complementary cumulative
+ * probability function of the \f$\chi^{2}\f$ distribution.
+ *
+ * Returns the natural logarithm of the probability that \f$x_{1}^{2} +
+ * \cdots + x_{\mathrm{dof}}^{2} \geq \chi^{2}\f$, where \f$x_{1}, \ldots,
+ * x_{\mathrm{dof}}\f$ are independent zero mean unit variance Gaussian
+ * random variables.  The integral expression is \f$\ln Q = \ln
+ * \int_{\chi^{2}/2}^{\infty} x^{\frac{n}{2}-1} \mathrm{e}^{-x} /
+ * \Gamma(n/2) \, \mathrm{d}x\f$, where \f$n = \mathrm{dof} =\f$ number of
+ * degrees of freedom.
+ *
+ * Results agree with Mathematica to 15 digits or more where the two have
+ * been compared and where Mathematica is able to compute a result.  For
+ * example, it does not seem to be possible to obtain a numerical result
+ * from Mathematica for the equivalent of XLALLogChisqCCDF(10000.0, 8.5)
+ * using any number of digits in the intermediate calculations, though the
+ * two implementations agree to better than 15 digits at
+ * XLALLogChisqCCDF(10000.0, 8.0)
+ */
+
+double XLALLogChisqCCDF(
+	double chi2,
+	double dof
+)
+{
+	double lngamma_a = NAN;
+
+	if((chi2 < 0.0) || (dof <= 0.0))
+		XLAL_ERROR_REAL8(XLAL_EDOM);
+
+	return log_chisq_ccdf(chi2, dof, &lngamma_a);
+}
+
+
+/**
+ * Compute XLALLogChisqCCDF() for each of the values in \c chi2, storing the
+ * results in \c ln_prob, which must have the same length.  Quantities which
+ * depend only on the number of degrees of freedom are computed once for the
+ * whole vector.
+ */
+
+int XLALLogChisqCCDFVector(
+	REAL8Vector *ln_prob,
+	const REAL8Vector *chi2,
+	double dof
+)
+{
+	double lngamma_a = NAN;
+	UINT4 i;
+
+	XLAL_CHECK(ln_prob != NULL && ln_prob->data != NULL, XLAL_EFAULT);
+	XLAL_CHECK(chi2 != NULL && chi2->data != NULL, XLAL_EFAULT);
+	XLAL_CHECK(ln_prob->length == chi2->length, XLAL_EBADLEN);
+	XLAL_CHECK(dof > 0.0, XLAL_EDOM, "require 0 < dof: dof=%.16g", dof);
+
+	for(i = 0; i < chi2->length; i++) {
+		XLAL_CHECK(chi2->data[i] >= 0.0, XLAL_EDOM, "require 0 <= chi2: chi2[%u]=%.16g", i, chi2->data[i]);
+		ln_prob->data[i] = log_chisq_ccdf(chi2->data[i], dof, &lngamma_a);
+		XLAL_CHECK(!XLAL_IS_REAL8_FAIL_NAN(ln_prob->data[i]), XLAL_EFUNC);
+	}
+
+	return XLAL_SUCCESS;
+}
+
+
+/*
+ * Implementation of XLALLogChisqCCDFInverse(), for valid input.  *lngamma_a
+ * is as for log_chisq_ccdf().
+ */
+
+static double log_chisq_ccdf_inverse(
+	double ln_prob,
+	double dof,
+	double *lngamma_a
+)
+{
+	const double a = dof / 2.;
+	double chi2;
+	int i;
+
+	if(ln_prob == 0.0)
+		return 0.0;
+	if(isinf(ln_prob))
+		return INFINITY;
+
+	if(isnan(*lngamma_a))
+		XLAL_CALLGSL(*lngamma_a = gsl_sf_lngamma(a));
+
+	/* initial guess, using the inverse of the CDF or CCDF provided by
+	 * GSL for intermediate probabilities, or the leading term of the
+	 * asymptotic expansion used by XLALLogChisqCCDF() for very small
+	 * probabilities */
+	if(ln_prob > -LAL_LN2) {
+		XLAL_CALLGSL(chi2 = gsl_cdf_chisq_Pinv(-expm1(ln_prob), dof));
+	} else if(ln_prob > -600.) {
+		XLAL_CALLGSL(chi2 = gsl_cdf_chisq_Qinv(exp(ln_prob), dof));
+	} else {
+		/* solve ln Q = (a - 1) ln(x) - x - ln Gamma(a) for x =
+		 * chi2 / 2 by fixed-point iteration, which is valid for x >
+		 * a; otherwise use the Wilson-Hilferty approximation, with
+		 * the asymptotic form of the Gaussian tail */
+		double x = -ln_prob;
+		for(i = 0; i < 10 && x > a; i++)
+			x = -ln_prob + (a - 1.) * log(x) - *lngamma_a;
+		if(x > a)
+			chi2 = 2. * x;
+		else {
+			const double z = sqrt(-2. * ln_prob - log(-4. * LAL_PI * ln_prob));
+			const double h = 2. / (9. * dof);
+			chi2 = dof * pow(1. - h + z * sqrt(h), 3.);
+		}
+	}
+	if(!(chi2 > 0.0) || isinf(chi2))
+		chi2 = dof;
+
+	/* refine by Newton-Raphson iteration on ln Q, whose derivative is
+	 * d(ln Q)/d(chi2) = -p(chi2) / Q(chi2), where p is the PDF */
+	for(i = 0; i < 100; i++) {
+		const double ln_Q = log_chisq_ccdf(chi2, dof, lngamma_a);
+		const double ln_p = (a - 1.) * log(chi2 / 2.) - chi2 / 2. - *lngamma_a - LAL_LN2;
+		double step;
+		if(XLAL_IS_REAL8_FAIL_NAN(ln_Q))
+			XLAL_ERROR_REAL8(XLAL_EFUNC);
+		if(fabs(ln_Q - ln_prob) <= 1e-13 * fabs(ln_prob))
+			return chi2;
+		step = (ln_Q - ln_prob) * exp(ln_Q - ln_p);
+		/* do not step past zero */
+		if(chi2 + step <= 0.0)
+			step = -chi2 / 2.;
+		chi2 += step;
+		if(fabs(step) <= 1e-13 * chi2)
+			return chi2;
+	}
+
+	XLAL_ERROR_REAL8(XLAL_EMAXITER, "ln_prob=%.16g, dof=%.16g", ln_prob, dof);
+}
+
+
+/**
+ * Compute the inverse of XLALLogChisqCCDF(): returns the value of
+ * \f$\chi^{2}\f$ for which the natural logarithm of the complementary
+ * cumulative probability of the \f$\chi^{2}\f$ distribution with \c dof
+ * degrees of freedom is \c ln_prob.  This is the threshold on \f$\chi^{2}\f$
+ * which gives a false alarm probability of \f$\exp(\mathrm{ln\_prob})\f$.
+ *
+ * Working with the logarithm of the probability allows thresholds to be set
+ * for false alarm probabilities well below the smallest representable
+ * double.
+ */
+
+double XLALLogChisqCCDFInverse(
+	double ln_prob,
+	double dof
+)
+{
+	double lngamma_a = NAN;
+
+	if(!(ln_prob <= 0.0) || (dof <= 0.0))
+		XLAL_ERROR_REAL8(XLAL_EDOM, "require ln_prob <= 0 and 0 < dof: ln_prob=%.16g, dof=%.16g", ln_prob, dof);
+
+	return log_chisq_ccdf_inverse(ln_prob, dof, &lngamma_a);
+}
+
+
+/**
+ * Compute XLALLogChisqCCDFInverse() for each of the values in \c ln_prob,
+ * storing the results in \c chi2, which must have the same length.
+ * Quantities which depend only on the number of degrees of freedom are
+ * computed once for the whole vector.
+ */
+
+int XLALLogChisqCCDFInverseVector(
+	REAL8Vector *chi2,
+	const REAL8Vector *ln_prob,
+	double dof
+)
+{
+	double lngamma_a = NAN;
+	UINT4 i;
+
+	XLAL_CHECK(chi2 != NULL && chi2->data != NULL, XLAL_EFAULT);
+	XLAL_CHECK(ln_prob != NULL && ln_prob->data != NULL, XLAL_EFAULT);
+	XLAL_CHECK(chi2->length == ln_prob->length, XLAL_EBADLEN);
+	XLAL_CHECK(dof > 0.0, XLAL_EDOM, "require 0 < dof: dof=%.16g", dof);
+
+	for(i = 0; i < ln_prob->length; i++) {
+		XLAL_CHECK(ln_prob->data[i] <= 0.0, XLAL_EDOM, "require ln_prob <= 0: ln_prob[%u]=%.16g", i, ln_prob->data[i]);
+		chi2->data[i] = log_chisq_ccdf_inverse(ln_prob->data[i], dof, &lngamma_a);
+		XLAL_CHECK(!XLAL_IS_REAL8_FAIL_NAN(chi2->data[i]), XLAL_EFUNC);
+	}
+
+	return XLAL_SUCCESS;
+}
@@ -748,3 +748,197 @@ double XLALMarcumQ(double M, double a, double b)
 
 	return XLALMarcumQmodified(M, a * a / 2., b * b / 2.);
 }
+
+
+/**
+ * Compute XLALMarcumQ() for each of the values in \c b, storing the results
+ * in \c Q, which must have the same length.
+ */
+
+
+int XLALMarcumQVector(REAL8Vector *Q, double M, double a, const REAL8Vector *b)
+{
+	UINT4 i;
+
+	XLAL_CHECK(Q != NULL && Q->data != NULL, XLAL_EFAULT);
+	XLAL_CHECK(b != NULL && b->data != NULL, XLAL_EFAULT);
+	XLAL_CHECK(Q->length == b->length, XLAL_EBADLEN);
+
+	for(i = 0; i < b->length; i++) {
+		Q->data[i] = XLALMarcumQ(M, a, b->data[i]);
+		XLAL_CHECK(!XLAL_IS_REAL8_FAIL_NAN(Q->data[i]), XLAL_EFUNC, "b[%u]=%.16g", i, b->data[i]);
+	}
+
+	return XLAL_SUCCESS;
+}
+
+
+/*
+ * Solve Q_M(a, b) = Q for b.  The root is bracketed, and then refined with
+ * the Illinois variant of the method of false position applied to ln Q_M(a,
+ * b) - ln Q, falling back to bisection where ln Q_M(a, b) underflows.  If
+ * b_hint is positive, it is used as the initial upper end of the bracket,
+ * e.g. the solution for a neighbouring value of Q.
+ */
+
+
+static double MarcumQ_inverse(double M, double a, double Q, double b_hint)
+{
+	/* largest b for which XLALMarcumQ() is accurate */
+	const double b_max = sqrt(2. * 10000.);
+	const double ln_Q = log(Q);
+	double lo, hi, f_lo, f_hi;
+	int side = 0;
+	int i;
+
+	if(Q == 1.)
+		return 0.;
+
+	/* Q_M(a, 0) = 1, and Q_M(a, b) decreases with b.  start the upper
+	 * end of the bracket at the root-mean-square value of b */
+	lo = 0.;
+	f_lo = -ln_Q;
+	hi = b_hint > 0. ? b_hint : sqrt(a * a + 2. * M);
+	if(hi > b_max)
+		hi = b_max;
+	f_hi = log(XLALMarcumQ(M, a, hi)) - ln_Q;
+	if(isnan(f_hi))
+		XLAL_ERROR_REAL8(XLAL_EFUNC);
+	while(f_hi > 0.) {
+		if(hi >= b_max)
+			XLAL_ERROR_REAL8(XLAL_ELOSS, "solution exceeds b=%.16g: M=%.16g, a=%.16g, Q=%.16g", b_max, M, a, Q);
+		lo = hi;
+		f_lo = f_hi;
+		hi = 2. * hi < b_max ? 2. * hi : b_max;
+		f_hi = log(XLALMarcumQ(M, a, hi)) - ln_Q;
+		if(isnan(f_hi))
+			XLAL_ERROR_REAL8(XLAL_EFUNC);
+	}
+
+	for(i = 0; i < 200; i++) {
+		const double b = isinf(f_hi) ? (lo + hi) / 2. : (lo * f_hi - hi * f_lo) / (f_hi - f_lo);
+		const double f = log(XLALMarcumQ(M, a, b)) - ln_Q;
+		if(isnan(f))
+			XLAL_ERROR_REAL8(XLAL_EFUNC);
+
+		/* XLALMarcumQ() is generally correct to 12 digits.  if the
+		 * bracket has collapsed without finding the root, Q_M(a, b)
+		 * has lost precision near the solution */
+		if(fabs(f) < 1e-13)
+			return b;
+		if(hi - lo <= 1e-13 * hi) {
+			if(fabs(f) > 1e-6)
+				XLAL_ERROR_REAL8(XLAL_ELOSS, "M=%.16g, a=%.16g, Q=%.16g", M, a, Q);
+			return b;
+		}
+
+		if(f > 0.) {
+			lo = b;
+			f_lo = f;
+			if(side < 0)
+				f_hi /= 2.;
+			side = -1;
+		} else {
+			hi = b;
+			f_hi = f;
+			if(side > 0)
+				f_lo /= 2.;
+			side = +1;
+		}
+	}
+
+	XLAL_ERROR_REAL8(XLAL_EMAXITER, "M=%.16g, a=%.16g, Q=%.16g", M, a, Q);
+}
+
+
+/**
+ * The inverse of XLALMarcumQ() with respect to \f$b\f$: returns the value
+ * of \f$b\f$ for which \f$Q_{M}(a, b) = Q\f$.  For example, this is the
+ * threshold on |SNR| for which a signal with |SNR| \f$a\f$ in a two-phase
+ * matched filter is detected with probability \f$Q\f$, using \f$M = 1\f$.
+ *
+ * Requires \f$0 < Q \leq 1\f$, in addition to the requirements of
+ * XLALMarcumQ(); the solution must lie in the range \f$b \leq
+ * \sqrt{20000}\f$ over which XLALMarcumQ() is accurate.
+ */
+
+
+double XLALMarcumQInverse(double M, double a, double Q)
+{
+	if(!(0. < Q && Q <= 1.))
+		XLAL_ERROR_REAL8(XLAL_EDOM, "require 0 < Q <= 1: Q=%.16g", Q);
+
+	return MarcumQ_inverse(M, a, Q, 0.);
+}
+
+
+/**
+ * Compute XLALMarcumQInverse() for each of the values in \c Q, storing the
+ * results in \c b, which must have the same length.  The solution for each
+ * value of \c Q is used as the starting point for the next, so this is most
+ * efficient if the values of \c Q are ordered.
+ */
+
+
+int XLALMarcumQInverseVector(REAL8Vector *b, double M, double a, const REAL8Vector *Q)
+{
+	double b_hint = 0.;
+	UINT4 i;
+
+	XLAL_CHECK(b != NULL && b->data != NULL, XLAL_EFAULT);
+	XLAL_CHECK(Q != NULL && Q->data != NULL, XLAL_EFAULT);
+	XLAL_CHECK(b->length == Q->length, XLAL_EBADLEN);
+
+	for(i = 0; i < Q->length; i++) {
+		XLAL_CHECK(0. < Q->data[i] && Q->data[i] <= 1., XLAL_EDOM, "require 0 < Q <= 1: Q[%u]=%.16g", i, Q->data[i]);
+		b->data[i] = MarcumQ_inverse(M, a, Q->data[i], b_hint);
+		XLAL_CHECK(!XLAL_IS_REAL8_FAIL_NAN(b->data[i]), XLAL_EFUNC, "Q[%u]=%.16g", i, Q->data[i]);
+		b_hint = b->data[i];
+	}
+
+	return XLAL_SUCCESS;
+}
+
+
+/**
+ * The CCDF of the noncentral \f$\chi^{2}\f$ distribution with \c dof
+ * degrees-of-freedom and noncentrality parameter \c lambda, evaluated at
+ * \c x.  This is \f$Q_{\mathrm{dof}/2}(\sqrt{\lambda}, \sqrt{x})\f$; see
+ * XLALMarcumQ().  Requires \f$2 \leq \mathrm{dof}\f$.
+ */
+
+
+double XLALNoncentralChisqCCDF(double x, double dof, double lambda)
+{
+	if(x < 0.)
+		XLAL_ERROR_REAL8(XLAL_EDOM, "require 0 <= x: x=%.16g", x);
+	if(lambda < 0.)
+		XLAL_ERROR_REAL8(XLAL_EDOM, "require 0 <= lambda: lambda=%.16g", lambda);
+
+	return XLALMarcumQ(dof / 2., sqrt(lambda), sqrt(x));
+}
+
+
+/**
+ * The inverse of XLALNoncentralChisqCCDF() with respect to \c x: returns
+ * the value of \f$x\f$ at which the CCDF of the noncentral \f$\chi^{2}\f$
+ * distribution with \c dof degrees-of-freedom and noncentrality parameter
+ * \c lambda is \c prob.  For example, this is the threshold on \f$x\f$ at
+ * which a signal with noncentrality \c lambda is detected with probability
+ * \c prob.
+ */
+
+
+double XLALNoncentralChisqCCDFInverse(double prob, double dof, double lambda)
+{
+	double b;
+
+	if(lambda < 0.)
+		XLAL_ERROR_REAL8(XLAL_EDOM, "require 0 <= lambda: lambda=%.16g", lambda);
+
+	b = XLALMarcumQInverse(dof / 2., sqrt(lambda), prob);
+	if(XLAL_IS_REAL8_FAIL_NAN(b))
+		XLAL_ERROR_REAL8(XLAL_EFUNC);
+
+	return b * b;
+}
@@ -0,0 +1,161 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <config.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALArena.h>
+#include <lal/XLALError.h>
+
+/* maximum number of objects parked in one arena; further objects are destroyed as usual */
+#define LAL_ARENA_MAX_OBJECTS 64
+
+typedef struct tagLALArenaObject {
+    void *obj;
+    LALArenaDestroyFunc destroy;
+    size_t size;
+} LALArenaObject;
+
+typedef struct tagLALArena {
+    struct tagLALArena *outer;  /* enclosing arena, or NULL */
+    int depth;                  /* number of arenas up to and including this one */
+    size_t nobj;
+    LALArenaObject objs[LAL_ARENA_MAX_OBJECTS];
+} LALArena;
+
+/*
+ *
+ * The innermost arena of the calling thread.
+ * If code must be POSIX thread safe then this is kept in thread-specific data.
+ *
+ */
+
+#ifndef LAL_PTHREAD_LOCK        /* non-pthread-safe code */
+
+static LALArena *lalArenaGlobal = NULL;
+
+static LALArena *XLALArenaGetTop(void)
+{
+    return lalArenaGlobal;
+}
+
+static void XLALArenaSetTop(LALArena *arena)
+{
+    lalArenaGlobal = arena;
+}
+
+#else /* pthread safe code */
+
+#include <pthread.h>
+
+static pthread_key_t lalArenaKey;
+static pthread_once_t lalArenaKeyOnce = PTHREAD_ONCE_INIT;
+
+/* routine to create the arena key */
+static void XLALCreateArenaKey(void)
+{
+    pthread_key_create(&lalArenaKey, NULL);
+    return;
+}
+
+static LALArena *XLALArenaGetTop(void)
+{
+    pthread_once(&lalArenaKeyOnce, XLALCreateArenaKey);
+    return pthread_getspecific(lalArenaKey);
+}
+
+static void XLALArenaSetTop(LALArena *arena)
+{
+    pthread_once(&lalArenaKeyOnce, XLALCreateArenaKey);
+    if (pthread_setspecific(lalArenaKey, arena))
+        lalAbortHook("could not set arena: pthread_setspecific failed\n");
+}
+
+#endif /* end of pthread-safe code */
+
+/** Begin a new arena in the calling thread, nested inside any active arena. */
+int XLALArenaPush(void)
+{
+    LALArena *outer = XLALArenaGetTop();
+    LALArena *arena = XLALMalloc(sizeof(*arena));
+    if (!arena)
+        XLAL_ERROR(XLAL_ENOMEM);
+    arena->outer = outer;
+    arena->depth = outer ? outer->depth + 1 : 1;
+    arena->nobj = 0;
+    XLALArenaSetTop(arena);
+    return XLAL_SUCCESS;
+}
+
+/**
+ * End the innermost arena of the calling thread. Objects parked in the arena are
+ * destroyed; if there is an enclosing arena, they are parked there instead.
+ */
+int XLALArenaPop(void)
+{
+    LALArena *arena = XLALArenaGetTop();
+    if (!arena)
+        XLAL_ERROR(XLAL_EFAILED, "No active arena to pop");
+    XLALArenaSetTop(arena->outer);
+    for (size_t i = 0; i < arena->nobj; ++i)
+        arena->objs[i].destroy(arena->objs[i].obj);
+    XLALFree(arena);
+    return XLAL_SUCCESS;
+}
+
+/** Return the number of active arenas in the calling thread. */
+int XLALArenaDepth(void)
+{
+    LALArena *arena = XLALArenaGetTop();
+    return arena ? arena->depth : 0;
+}
+
+/**
+ * Take an object with destructor \c destroy and size \c size out of the innermost arena.
+ * Returns NULL, without setting an error, if there is no active arena or no such object.
+ */
+void *XLALArenaTake(LALArenaDestroyFunc destroy, size_t size)
+{
+    LALArena *arena = XLALArenaGetTop();
+    if (!arena)
+        return NULL;
+    /* search the most recently parked objects first */
+    for (size_t i = arena->nobj; i-- > 0;) {
+        if (arena->objs[i].destroy == destroy && arena->objs[i].size == size) {
+            void *obj = arena->objs[i].obj;
+            arena->objs[i] = arena->objs[--arena->nobj];
+            return obj;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Park an object with destructor \c destroy and size \c size in the innermost arena,
+ * to be reused by XLALArenaTake(). Returns 1 if the object was parked, and 0 if there
+ * is no active arena or it is full, in which case the caller should destroy the object.
+ */
+int XLALArenaPark(void *obj, LALArenaDestroyFunc destroy, size_t size)
+{
+    LALArena *arena = XLALArenaGetTop();
+    if (!arena || !obj || arena->nobj == LAL_ARENA_MAX_OBJECTS)
+        return 0;
+    arena->objs[arena->nobj].obj = obj;
+    arena->objs[arena->nobj].destroy = destroy;
+    arena->objs[arena->nobj].size = size;
+    ++arena->nobj;
+    return 1;
+}
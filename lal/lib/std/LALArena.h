@@ -0,0 +1,84 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#ifndef _LALARENA_H
+#define _LALARENA_H
+
+#include <stddef.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#elif 0
+}       /* so that editors will match preceding brace */
+#endif
+
+/**
+ * \defgroup LALArena_h Header LALArena.h
+ * \ingroup lal_std
+ * \brief Scoped pools for recycling short-lived LAL objects.
+ *
+ * Code which repeatedly creates and destroys objects of the same type and size,
+ * e.g. the time and frequency series created by each evaluation of a waveform
+ * or likelihood, may bracket that work between XLALArenaPush() and XLALArenaPop():
+ *
+ * \code
+ * XLALArenaPush();
+ * for ( i = 0; i < n; ++i ) {
+ *   REAL8TimeSeries *h = XLALCreateREAL8TimeSeries( ... );
+ *   ...
+ *   XLALDestroyREAL8TimeSeries( h );
+ * }
+ * XLALArenaPop();
+ * \endcode
+ *
+ * While an arena is active, the destructors of supported objects do not free them,
+ * but park them in the arena; the next creation of an object of the same type and
+ * size is then satisfied from the arena, and does not touch the memory allocator.
+ * XLALArenaPop() frees all objects still parked in the arena, or hands them to the
+ * enclosing arena if arenas are nested. Objects which are not destroyed remain valid
+ * after XLALArenaPop(), exactly as if they had been allocated without an arena.
+ * Note that recycled objects have undefined contents, as with XLALMalloc().
+ *
+ * Arenas are local to the calling thread.
+ *
+ * The time and frequency series factories in \ref TimeSeries_h and \ref FrequencySeries_h
+ * support arenas.
+ *//** @{ */
+
+int XLALArenaPush(void);
+int XLALArenaPop(void);
+int XLALArenaDepth(void);
+
+#ifndef SWIG    /* exclude from SWIG interface */
+
+/** Type of destructor of an object which may be parked in an arena */
+typedef void (*LALArenaDestroyFunc)(void *obj);
+
+void *XLALArenaTake(LALArenaDestroyFunc destroy, size_t size);
+int XLALArenaPark(void *obj, LALArenaDestroyFunc destroy, size_t size);
+
+#endif /* SWIG */
+
+/** @} */
+
+#if 0
+{       /* so that editors will match succeeding brace */
+#elif defined(__cplusplus)
+}
+#endif
+
+#endif /* _LALARENA_H */
@@ -22,8 +22,18 @@
 #include <stdlib.h>
 #include <string.h>
 #include <signal.h>
+#include <stdint.h>
 
 #include <config.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#ifdef HAVE_SYS_SYSCALL_H
+#include <sys/syscall.h>
+#endif
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
 #include <lal/LALMalloc.h>
 #include <lal/LALStdio.h>
 #include <lal/LALError.h>
@@ -31,6 +41,230 @@
 /* global variables */
 size_t lalMallocTotal = 0;	/**< current amount of memory allocated by process */
 size_t lalMallocTotalPeak = 0;	/**< peak amount of memory allocated so far */
+size_t lalMallocCount = 0;	/**< number of memory allocations made so far */
+size_t lalMallocHugePageCount = 0;	/**< current number of allocations backed by huge pages */
+size_t lalMallocHugePageTotal = 0;	/**< current amount of memory in allocations backed by huge pages */
+
+/*
+ *
+ * Huge page routines.
+ *
+ */
+
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+static pthread_mutex_t lalHugePageMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t lalHugePageOnce = PTHREAD_ONCE_INIT;
+#define HUGE_PAGE_LOCK   pthread_mutex_lock(&lalHugePageMutex)
+#define HUGE_PAGE_UNLOCK pthread_mutex_unlock(&lalHugePageMutex)
+#define HUGE_PAGE_ONCE(init) pthread_once(&lalHugePageOnce, (init))
+#else
+static int lalHugePageOnce = 1;
+#define HUGE_PAGE_LOCK
+#define HUGE_PAGE_UNLOCK
+#define HUGE_PAGE_ONCE(init) (lalHugePageOnce ? (init)(), lalHugePageOnce = 0 : 0)
+#endif
+
+/*
+ * The huge page settings and the number of records are read without the lock
+ * on every allocation, i.e. atomically where the compiler supports it; they
+ * are only written with the lock held. Otherwise they are read with the lock.
+ */
+#if defined(__GNUC__)
+#define HUGE_PAGE_LOAD(p)     __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define HUGE_PAGE_STORE(p, x) __atomic_store_n(p, x, __ATOMIC_RELEASE)
+#define HUGE_PAGE_LOAD_LOCK
+#define HUGE_PAGE_LOAD_UNLOCK
+#else
+#define HUGE_PAGE_LOAD(p)     (*(p))
+#define HUGE_PAGE_STORE(p, x) (*(p) = (x))
+#define HUGE_PAGE_LOAD_LOCK   HUGE_PAGE_LOCK
+#define HUGE_PAGE_LOAD_UNLOCK HUGE_PAGE_UNLOCK
+#endif
+
+static size_t XLALPageSize(void)
+{
+#if defined(HAVE_UNISTD_H) && defined(_SC_PAGESIZE)
+    const long n = sysconf(_SC_PAGESIZE);
+    if (n > 0)
+        return (size_t) n;
+#endif
+    return 4096;
+}
+
+/* size of huge pages, assumed for explicit huge page mappings */
+#define LAL_HUGE_PAGE_SIZE ((size_t) 2 << 20)
+
+/* default for the smallest memory block backed by huge pages */
+#define LAL_HUGE_PAGE_THRESHOLD ((size_t) 16 << 20)
+
+static LALHugePageMode lalHugePageMode = LAL_HUGE_PAGES_OFF;
+static size_t lalHugePageThreshold = LAL_HUGE_PAGE_THRESHOLD;
+
+/* hash table of allocations backed by huge pages, chained by address */
+typedef struct tagHugePageEntry {
+    void *ptr;
+    size_t size;
+    LALHugePageMode mode;
+    struct tagHugePageEntry *next;
+} HugePageEntry;
+enum { nhugepagebuckets = 256 };
+static HugePageEntry *lalHugePageTable[nhugepagebuckets];
+
+/* return the hash table bucket of an address, mixing all bits of the address into the bucket index */
+static HugePageEntry **XLALHugePageBucket(const void *ptr)
+{
+    return &lalHugePageTable[(((uint64_t)(uintptr_t) ptr) * UINT64_C(0x9E3779B97F4A7C15)) >> 56];
+}
+
+/* return whether any allocation is currently backed by huge pages */
+static int XLALHugePageAny(void)
+{
+    HUGE_PAGE_LOAD_LOCK;
+    const size_t count = HUGE_PAGE_LOAD(&lalMallocHugePageCount);
+    HUGE_PAGE_LOAD_UNLOCK;
+    return count > 0;
+}
+
+static void XLALHugePageInit(void)
+{
+    const char *env = getenv("LAL_HUGE_PAGES");
+    if (env != NULL) {
+        if (strcmp(env, "transparent") == 0)
+            lalHugePageMode = LAL_HUGE_PAGES_TRANSPARENT;
+        else if (strcmp(env, "explicit") == 0)
+            lalHugePageMode = LAL_HUGE_PAGES_EXPLICIT;
+    }
+    env = getenv("LAL_HUGE_PAGE_THRESHOLD");
+    if (env != NULL) {
+        char *end = NULL;
+        const unsigned long long n = strtoull(env, &end, 10);
+        if (end != env && *end == '\0')
+            lalHugePageThreshold = (size_t) n;
+    }
+}
+
+/* return the huge page mode to use for a memory block of the given size */
+static LALHugePageMode XLALHugePageModeForSize(size_t size)
+{
+    HUGE_PAGE_ONCE(XLALHugePageInit);
+    HUGE_PAGE_LOAD_LOCK;
+    const LALHugePageMode mode = HUGE_PAGE_LOAD(&lalHugePageMode);
+    const size_t threshold = HUGE_PAGE_LOAD(&lalHugePageThreshold);
+    HUGE_PAGE_LOAD_UNLOCK;
+    return (size > 0 && size >= threshold) ? mode : LAL_HUGE_PAGES_OFF;
+}
+
+static void XLALHugePageRecord(void *ptr, size_t size, LALHugePageMode mode)
+{
+    HugePageEntry *entry = malloc(sizeof(*entry));
+    if (entry == NULL)
+        return;
+    entry->ptr = ptr;
+    entry->size = size;
+    entry->mode = mode;
+    HUGE_PAGE_LOCK;
+    HugePageEntry **bucket = XLALHugePageBucket(ptr);
+    entry->next = *bucket;
+    *bucket = entry;
+    lalMallocHugePageTotal += size;
+    HUGE_PAGE_STORE(&lalMallocHugePageCount, lalMallocHugePageCount + 1);
+    HUGE_PAGE_UNLOCK;
+}
+
+/* remove the record of an allocation, if any; return its mode and size */
+static LALHugePageMode XLALHugePageForget(void *ptr, size_t *size)
+{
+    LALHugePageMode mode = LAL_HUGE_PAGES_OFF;
+    if (ptr == NULL || !XLALHugePageAny())
+        return mode;
+    HUGE_PAGE_LOCK;
+    for (HugePageEntry **pentry = XLALHugePageBucket(ptr); *pentry != NULL; pentry = &(*pentry)->next) {
+        HugePageEntry *entry = *pentry;
+        if (entry->ptr == ptr) {
+            *pentry = entry->next;
+            lalMallocHugePageTotal -= entry->size;
+            HUGE_PAGE_STORE(&lalMallocHugePageCount, lalMallocHugePageCount - 1);
+            mode = entry->mode;
+            if (size != NULL)
+                *size = entry->size;
+            free(entry);
+            break;
+        }
+    }
+    HUGE_PAGE_UNLOCK;
+    return mode;
+}
+
+/* advise that a large memory block be backed by transparent huge pages, and record it if successful */
+static void XLALHugePageAdvise(void *ptr, size_t size)
+{
+    if (ptr == NULL || XLALHugePageModeForSize(size) == LAL_HUGE_PAGES_OFF)
+        return;
+    XLALHugePageForget(ptr, NULL);	/* in case a stale record was left at this address */
+#if defined(HAVE_SYS_MMAN_H) && defined(MADV_HUGEPAGE)
+    {
+        const size_t page = XLALPageSize();
+        const uintptr_t start = ((uintptr_t) ptr + page - 1) / page * page;
+        const uintptr_t end = ((uintptr_t) ptr + size) / page * page;
+        if (start < end && madvise((void *) start, end - start, MADV_HUGEPAGE) == 0)
+            XLALHugePageRecord(ptr, size, LAL_HUGE_PAGES_TRANSPARENT);
+    }
+#endif
+}
+
+/**
+ * Set the mode in which, and threshold in bytes above which, memory blocks
+ * allocated by the XLAL memory routines are backed by huge pages. This
+ * affects subsequent allocations only.
+ */
+int XLALSetHugePages(LALHugePageMode mode, size_t threshold)
+{
+    XLAL_CHECK(0 <= (int) mode && mode < LAL_HUGE_PAGES_MAX, XLAL_EINVAL, "Invalid huge page mode %i", (int) mode);
+    HUGE_PAGE_ONCE(XLALHugePageInit);
+    HUGE_PAGE_LOCK;
+    HUGE_PAGE_STORE(&lalHugePageMode, mode);
+    HUGE_PAGE_STORE(&lalHugePageThreshold, threshold);
+    HUGE_PAGE_UNLOCK;
+    return XLAL_SUCCESS;
+}
+
+/**
+ * Return the current huge page mode, and optionally the threshold in bytes
+ * above which memory blocks are backed by huge pages.
+ */
+LALHugePageMode XLALGetHugePages(size_t *threshold)
+{
+    HUGE_PAGE_ONCE(XLALHugePageInit);
+    HUGE_PAGE_LOCK;
+    const LALHugePageMode mode = lalHugePageMode;
+    if (threshold != NULL)
+        *threshold = lalHugePageThreshold;
+    HUGE_PAGE_UNLOCK;
+    return mode;
+}
+
+/**
+ * Return how a memory block allocated by the XLAL memory routines is backed
+ * by huge pages: ::LAL_HUGE_PAGES_TRANSPARENT if transparent huge pages were
+ * successfully requested, ::LAL_HUGE_PAGES_EXPLICIT if reserved huge pages were
+ * mapped, or ::LAL_HUGE_PAGES_OFF otherwise.
+ */
+LALHugePageMode XLALHugePageAllocation(const void *ptr)
+{
+    LALHugePageMode mode = LAL_HUGE_PAGES_OFF;
+    if (ptr == NULL || !XLALHugePageAny())
+        return mode;
+    HUGE_PAGE_LOCK;
+    for (const HugePageEntry *entry = *XLALHugePageBucket(ptr); entry != NULL; entry = entry->next) {
+        if (entry->ptr == ptr) {
+            mode = entry->mode;
+            break;
+        }
+    }
+    HUGE_PAGE_UNLOCK;
+    return mode;
+}
 
 /*
  *
@@ -65,6 +299,7 @@ void *(XLALMalloc) (size_t n) {
     void *p;
     p = LALMallocShort(n);
     XLAL_TEST_POINTER(p, n);
+    XLALHugePageAdvise(p, n);
     return p;
 }
 
@@ -73,6 +308,7 @@ void *XLALMallocLong(size_t n, const char *file, int line)
     void *p;
     p = LALMallocLong(n, file, line);
     XLAL_TEST_POINTER_LONG(p, n, file, line);
+    XLALHugePageAdvise(p, n);
     return p;
 }
 
@@ -80,6 +316,7 @@ void *(XLALCalloc) (size_t m, size_t n) {
     void *p;
     p = LALCallocShort(m, n);
     XLAL_TEST_POINTER(p, m && n);
+    XLALHugePageAdvise(p, m * n);
     return p;
 }
 
@@ -88,26 +325,33 @@ void *XLALCallocLong(size_t m, size_t n, const char *file, int line)
     void *p;
     p = LALCallocLong(m, n, file, line);
     XLAL_TEST_POINTER_LONG(p, m && n, file, line);
+    XLALHugePageAdvise(p, m * n);
     return p;
 }
 
 void *(XLALRealloc) (void *p, size_t n) {
+    XLALHugePageForget(p, NULL);
     p = LALReallocShort(p, n);
     XLAL_TEST_POINTER(p, n);
+    XLALHugePageAdvise(p, n);
     return p;
 }
 
 void *XLALReallocLong(void *p, size_t n, const char *file, int line)
 {
+    XLALHugePageForget(p, NULL);
     p = LALReallocLong(p, n, file, line);
     XLAL_TEST_POINTER_LONG(p, n, file, line);
+    XLALHugePageAdvise(p, n);
     return p;
 }
 
 void XLALFree(void *p)
 {
-    if (p)
+    if (p) {
+        XLALHugePageForget(p, NULL);
         LALFree(p);
+    }
     return;
 }
 
@@ -132,6 +376,7 @@ void *XLALMallocAlignedLong(size_t size, const char *file, int line)
 	int retval;
 	retval = posix_memalign(&p, LAL_MEM_ALIGNMENT, size);
 	XLAL_TEST_POINTER_ALIGNED_LONG(p, size, retval, file, line);
+	XLALHugePageAdvise(p, size);
 	return p;
 }
 
@@ -141,6 +386,7 @@ void *(XLALMallocAligned)(size_t size)
 	int retval;
 	retval = posix_memalign(&p, LAL_MEM_ALIGNMENT, size);
 	XLAL_TEST_POINTER_ALIGNED(p, size, retval);
+	XLALHugePageAdvise(p, size);
 	return p;
 }
 
@@ -171,9 +417,12 @@ void *XLALReallocAlignedLong(void *ptr, size_t size, const char *file, int line)
 		XLALFreeAligned(ptr);
 		return NULL;
 	}
+	XLALHugePageForget(ptr, NULL);
 	p = realloc(ptr, size); /* use ordinary realloc */
-	if (XLALIsMemoryAligned(p))
+	if (XLALIsMemoryAligned(p)) {
+		XLALHugePageAdvise(p, size);
 		return p;
+	}
 	/* need to do a new allocation and a memcpy, inefficient... */
 	ptr = XLALMallocAlignedLong(size, file, line);
 	memcpy(ptr, p, size);
@@ -190,9 +439,12 @@ void *(XLALReallocAligned)(void *ptr, size_t size)
 		XLALFreeAligned(ptr);
 		return NULL;
 	}
+	XLALHugePageForget(ptr, NULL);
 	p = realloc(ptr, size); /* use ordinary realloc */
-	if (XLALIsMemoryAligned(p))
+	if (XLALIsMemoryAligned(p)) {
+		XLALHugePageAdvise(p, size);
 		return p;
+	}
 	/* need to do a new allocation and a memcpy, inefficient... */
 	ptr = XLALMallocAligned(size);
 	memcpy(ptr, p, size);
@@ -202,11 +454,127 @@ void *(XLALReallocAligned)(void *ptr, size_t size)
 
 void XLALFreeAligned(void *ptr)
 {
+	XLALHugePageForget(ptr, NULL);
 	free(ptr); /* use ordinary free */
 }
 
 #endif /* LAL_FFTW3_MEMALIGN_ENABLED */
 
+/*
+ * NUMA memory placement routines.
+ */
+
+#if defined(__linux__) && defined(SYS_mbind)
+/* memory policy modes and flags, from <linux/mempolicy.h> */
+#define LAL_MPOL_INTERLEAVE 3
+#define LAL_MPOL_LOCAL 4
+#define LAL_MPOL_MF_MOVE (1 << 1)
+#endif
+
+/**
+ * Apply a NUMA placement policy to the whole pages within a memory block.
+ * Pages which have already been touched are moved, if possible: to the
+ * interleaved nodes for ::LAL_MEMORY_PLACEMENT_INTERLEAVE, or to the node of
+ * the calling thread for ::LAL_MEMORY_PLACEMENT_LOCAL. The policy is only a
+ * hint; failure to apply it, e.g. on a system without NUMA support, is not
+ * an error.
+ */
+int XLALSetMemoryPlacement(void *ptr, size_t size, LALMemoryPlacement placement)
+{
+	XLAL_CHECK(ptr != NULL || size == 0, XLAL_EFAULT);
+	XLAL_CHECK(0 <= (int) placement && placement < LAL_MEMORY_PLACEMENT_MAX, XLAL_EINVAL, "Invalid memory placement %i", (int) placement);
+	if (placement == LAL_MEMORY_PLACEMENT_DEFAULT || size == 0)
+		return XLAL_SUCCESS;
+#if defined(__linux__) && defined(SYS_mbind)
+	{
+		const size_t page = XLALPageSize();
+		const uintptr_t start = ((uintptr_t) ptr + page - 1) / page * page;
+		const uintptr_t end = ((uintptr_t) ptr + size) / page * page;
+		if (start < end) {
+			/* all nodes; the kernel restricts this to the nodes with memory that the process may use */
+			unsigned long nodes = ~0UL;
+			if (placement == LAL_MEMORY_PLACEMENT_INTERLEAVE)
+				(void) syscall(SYS_mbind, start, end - start, LAL_MPOL_INTERLEAVE, &nodes, 8 * sizeof(nodes) + 1, LAL_MPOL_MF_MOVE);
+			else
+				(void) syscall(SYS_mbind, start, end - start, LAL_MPOL_LOCAL, NULL, 0, LAL_MPOL_MF_MOVE);
+		}
+	}
+#endif
+	return XLAL_SUCCESS;
+}
+
+/* allocate a page-aligned memory block, backed by huge pages if it is large enough */
+static void *XLALMallocPlacedPages(size_t size)
+{
+	void *p = NULL;
+	const LALHugePageMode mode = XLALHugePageModeForSize(size);
+#if defined(HAVE_SYS_MMAN_H) && defined(MAP_HUGETLB)
+	if (mode == LAL_HUGE_PAGES_EXPLICIT) {
+		/* map reserved huge pages, if there are enough of them */
+		const size_t length = (size + LAL_HUGE_PAGE_SIZE - 1) / LAL_HUGE_PAGE_SIZE * LAL_HUGE_PAGE_SIZE;
+		p = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (p != MAP_FAILED) {
+			XLALHugePageRecord(p, length, LAL_HUGE_PAGES_EXPLICIT);
+			return p;
+		}
+		p = NULL;
+	}
+#endif
+#ifdef HAVE_POSIX_MEMALIGN
+	/* align large blocks to huge pages, so that they may be backed entirely by transparent huge pages */
+	if (posix_memalign(&p, (mode == LAL_HUGE_PAGES_OFF) ? XLALPageSize() : LAL_HUGE_PAGE_SIZE, size) != 0)
+		return NULL;
+#else
+	(void) mode;
+	p = malloc(size);
+#endif
+	XLALHugePageAdvise(p, size);
+	return p;
+}
+
+/**
+ * Allocate a page-aligned memory block, with a NUMA placement policy.
+ * The memory is not initialised, i.e. not touched, so that its pages are
+ * only placed when first used; with ::LAL_MEMORY_PLACEMENT_LOCAL, the caller
+ * should therefore first write to each part of the block from the thread
+ * which will use it. Large blocks are backed by huge pages, as set by
+ * XLALSetHugePages(). The block is not tracked by the LAL memory debugging
+ * routines, and must be freed with XLALFreePlaced().
+ */
+void *XLALMallocPlacedLong(size_t size, LALMemoryPlacement placement, const char *file, int line)
+{
+	void *p = XLALMallocPlacedPages(size);
+	XLAL_TEST_POINTER_LONG(p, size, file, line);
+	if (XLALSetMemoryPlacement(p, size, placement) != XLAL_SUCCESS) {
+		XLALFreePlaced(p);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
+	return p;
+}
+
+void *(XLALMallocPlaced)(size_t size, LALMemoryPlacement placement)
+{
+	void *p = XLALMallocPlacedPages(size);
+	XLAL_TEST_POINTER(p, size);
+	if (XLALSetMemoryPlacement(p, size, placement) != XLAL_SUCCESS) {
+		XLALFreePlaced(p);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
+	return p;
+}
+
+void XLALFreePlaced(void *ptr)
+{
+	size_t length = 0;
+	if (XLALHugePageForget(ptr, &length) == LAL_HUGE_PAGES_EXPLICIT) {
+#ifdef HAVE_SYS_MMAN_H
+		munmap(ptr, length);
+#endif
+		return;
+	}
+	free(ptr); /* use ordinary free */
+}
+
 /*
  *
  * LAL Routines... only if compiled with debugging enabled.
@@ -219,12 +587,14 @@ void XLALFreeAligned(void *ptr)
 
 #ifdef LAL_PTHREAD_LOCK
 #include <pthread.h>
-static pthread_mutex_t mut = PTHREAD_MUTEX_INITIALIZER;
+#define LAL_LOCK(pmut)   pthread_mutex_lock(pmut)
+#define LAL_UNLOCK(pmut) pthread_mutex_unlock(pmut)
 #else
-#define pthread_mutex_lock( pmut )
-#define pthread_mutex_unlock( pmut )
+#define LAL_LOCK(pmut)
+#define LAL_UNLOCK(pmut)
 #endif
 
+#include <stdint.h>
 #include <lal/LALStdlib.h>
 
 /* global variables to assist in memory debugging */
@@ -248,6 +618,129 @@ static const size_t magic = 0xABadCafe;
 
 #define allocsz(n) ((lalDebugLevel & LALMEMPADBIT) ? (padFactor * (n) + prefix) : (n))
 
+/* need this to turn off gcc warnings about unused functions */
+#ifdef __GNUC__
+#define UNUSED __attribute__ ((unused))
+#else
+#define UNUSED
+#endif
+
+/*
+ * Counters shared between threads are updated atomically where the compiler
+ * supports it, so that the allocation functions do not serialise threaded code;
+ * otherwise they are updated under a single mutex.
+ */
+
+#if defined(__GNUC__)
+
+static inline size_t AtomicLoad(size_t *p) { return __atomic_load_n(p, __ATOMIC_RELAXED); }
+static inline size_t AtomicAdd(size_t *p, size_t n) { return __atomic_add_fetch(p, n, __ATOMIC_RELAXED); }
+static inline size_t AtomicSub(size_t *p, size_t n) { return __atomic_sub_fetch(p, n, __ATOMIC_RELAXED); }
+static inline void AtomicMax(size_t *p, size_t n)
+{
+    size_t old = __atomic_load_n(p, __ATOMIC_RELAXED);
+    while (old < n && !__atomic_compare_exchange_n(p, &old, n, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+#else
+
+#ifdef LAL_PTHREAD_LOCK
+static pthread_mutex_t atomic_mut = PTHREAD_MUTEX_INITIALIZER;
+#endif
+static inline size_t AtomicLoad(size_t *p) { LAL_LOCK(&atomic_mut); size_t r = *p; LAL_UNLOCK(&atomic_mut); return r; }
+static inline size_t AtomicAdd(size_t *p, size_t n) { LAL_LOCK(&atomic_mut); size_t r = (*p += n); LAL_UNLOCK(&atomic_mut); return r; }
+static inline size_t AtomicSub(size_t *p, size_t n) { LAL_LOCK(&atomic_mut); size_t r = (*p -= n); LAL_UNLOCK(&atomic_mut); return r; }
+static inline void AtomicMax(size_t *p, size_t n) { LAL_LOCK(&atomic_mut); if (*p < n) { *p = n; } LAL_UNLOCK(&atomic_mut); }
+
+#endif
+
+/* Hash an address or call site, mixing all bits of the key into the high bits */
+static inline uint64_t AllocHash(uint64_t x)
+{
+    return x * UINT64_C(0x9E3779B97F4A7C15);
+}
+
+/*
+ *
+ * Allocation call site statistics.
+ * Sites are kept in a fixed-size table with open addressing and linear probing;
+ * new sites are inserted with an atomic compare-and-swap where supported, and
+ * their statistics are updated atomically, so no lock is needed.
+ *
+ */
+
+struct allocSite {
+    const char *file;
+    int line;
+    size_t count;     /* number of allocations made at this site */
+    size_t total;     /* total bytes allocated at this site */
+    size_t current;   /* bytes currently allocated from this site */
+    size_t peak;      /* peak bytes allocated from this site at any time */
+};
+
+enum { nsites = 8192 };
+static struct allocSite *site_data[nsites];
+static struct allocSite site_overflow = { .file = "(other sites)", .line = -1 };
+
+#if defined(__GNUC__)
+#define SITE_LOAD(p)         __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define SITE_INSERT(p, x)    ({ struct allocSite *old_ = NULL; __atomic_compare_exchange_n(p, &old_, x, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE); })
+#else
+#define SITE_LOAD(p)         (*(p))
+static inline int SITE_INSERT(struct allocSite **p, struct allocSite *x) { int r = 0; LAL_LOCK(&atomic_mut); if (*p == NULL) { *p = x; r = 1; } LAL_UNLOCK(&atomic_mut); return r; }
+#endif
+
+/* Find or add the statistics of the call site file:line */
+static struct allocSite *AllocSiteGet(const char *file, int line)
+{
+    int i = (int)(AllocHash(((uint64_t)(intptr_t) file) ^ (uint64_t) line) >> 51) % nsites;
+    for (int k = 0; k < nsites; ++k) {
+        struct allocSite *site = SITE_LOAD(&site_data[i]);
+        if (site == NULL) {
+            struct allocSite *newsite = calloc(1, sizeof(*newsite));
+            if (newsite == NULL) {
+                return &site_overflow;
+            }
+            newsite->file = file;
+            newsite->line = line;
+            if (SITE_INSERT(&site_data[i], newsite)) {
+                return newsite;
+            }
+            /* another thread claimed this slot first */
+            free(newsite);
+            site = SITE_LOAD(&site_data[i]);
+        }
+        if (site->file == file && site->line == line) {
+            return site;
+        }
+        if (++i == nsites) {
+            i = 0;
+        }
+    }
+    return &site_overflow;
+}
+
+static void AllocSiteAdd(struct allocSite *site, size_t n)
+{
+    AtomicAdd(&site->count, 1);
+    AtomicAdd(&site->total, n);
+    AtomicMax(&site->peak, AtomicAdd(&site->current, n));
+}
+
+static void AllocSiteRemove(struct allocSite *site, size_t n)
+{
+    AtomicSub(&site->current, n);
+}
+
+/*
+ *
+ * Allocation hash tables.
+ * Allocations are distributed by address over a number of shards, each with its
+ * own hash table and lock, so that threads allocating and freeing memory rarely
+ * contend for the same lock. Shards are only combined when reporting leaks.
+ *
+ */
+
 /* Hash table implementation taken from src/utilities/LALHashTbl.c */
 
 static struct allocNode {
@@ -255,121 +748,157 @@ static struct allocNode {
     size_t size;
     const char *file;
     int line;
-} **alloc_data = NULL;		/* Allocation hash table with open addressing and linear probing */
-static int alloc_data_len = 0;	/* Size of the memory block 'alloc_data', in number of elements */
-static int alloc_n = 0;		/* Number of valid elements in the hash */
-static int alloc_q = 0;		/* Number of non-NULL elements in the hash */
+    struct allocSite *site;
+} DEL_NODE;
 
 /* Special allocation hash table element value to indicate elements that have been deleted */
-static const void *hash_del = 0;
-#define DEL   ((struct allocNode*) &hash_del)
+#define DEL   (&DEL_NODE)
+
+enum { nshards = 64 };
+static struct allocShard {
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_t mut;
+#endif
+    struct allocNode **data;	/* Allocation hash table with open addressing and linear probing */
+    int data_len;		/* Size of the memory block 'data', in number of elements */
+    int n;			/* Number of valid elements in the hash */
+    int q;			/* Number of non-NULL elements in the hash */
+} alloc_shards[nshards];
+
+#ifdef LAL_PTHREAD_LOCK
+static pthread_once_t alloc_shards_once = PTHREAD_ONCE_INIT;
+static void AllocShardsInit(void)
+{
+    for (int k = 0; k < nshards; ++k) {
+        pthread_mutex_init(&alloc_shards[k].mut, NULL);
+    }
+}
+#endif
+
+/* Return the locked shard with index s; the shard locks are initialised on first use */
+static struct allocShard *AllocShardLockIndex(int s)
+{
+#ifdef LAL_PTHREAD_LOCK
+    pthread_once(&alloc_shards_once, AllocShardsInit);
+#endif
+    struct allocShard *sh = &alloc_shards[s];
+    LAL_LOCK(&sh->mut);
+    return sh;
+}
+
+/* Return the locked shard responsible for address p */
+static struct allocShard *AllocShardLock(void *p)
+{
+    return AllocShardLockIndex((int)(AllocHash((uint64_t)(intptr_t) p) >> 58));
+}
+
+static void AllocShardUnlock(struct allocShard *sh)
+{
+    (void) sh;
+    LAL_UNLOCK(&sh->mut);
+}
 
-/* Evaluates to the hash value of x, restricted to the length of the allocation hash table */
-#define HASHIDX(x)   ((int)( ((intptr_t)( (x)->addr )) % alloc_data_len ))
+/* Evaluates to the hash value of x, restricted to the length of the shard hash table */
+#define HASHIDX(sh, x)   ((int)( (AllocHash((uint64_t)(intptr_t)( (x)->addr )) >> 16) % (sh)->data_len ))
 
-/* Increment the next hash index, restricted to the length of the allocation hash table */
-#define INCRIDX(i)   do { if (++(i) == alloc_data_len) { (i) = 0; } } while(0)
+/* Increment the next hash index, restricted to the length of the shard hash table */
+#define INCRIDX(sh, i)   do { if (++(i) == (sh)->data_len) { (i) = 0; } } while(0)
 
 /* Evaluates true if the elements x and y are equal */
 #define EQUAL(x, y)   ((x)->addr == (y)->addr)
 
-/* need this to turn off gcc warnings about unused functions */
-#ifdef __GNUC__
-#define UNUSED __attribute__ ((unused))
-#else
-#define UNUSED
-#endif
-
-/* Resize and rebuild the allocation allocation hash table */
-UNUSED static int AllocHashTblResize(void)
+/* Resize and rebuild a shard hash table */
+UNUSED static int AllocHashTblResize(struct allocShard *sh)
 {
-    struct allocNode **old_data = alloc_data;
-    int old_data_len = alloc_data_len;
-    alloc_data_len = 2;
-    while (alloc_data_len < 3*alloc_n) {
-        alloc_data_len *= 2;
+    struct allocNode **old_data = sh->data;
+    int old_data_len = sh->data_len;
+    int new_data_len = 2;
+    while (new_data_len < 3*sh->n) {
+        new_data_len *= 2;
     }
-    alloc_data = calloc(alloc_data_len, sizeof(alloc_data[0]));
-    if (alloc_data == NULL) {
+    struct allocNode **new_data = calloc(new_data_len, sizeof(new_data[0]));
+    if (new_data == NULL) {
         return 0;
     }
-    alloc_q = alloc_n;
+    sh->data = new_data;
+    sh->data_len = new_data_len;
+    sh->q = sh->n;
     for (int k = 0; k < old_data_len; ++k) {
         if (old_data[k] != NULL && old_data[k] != DEL) {
-            int i = HASHIDX(old_data[k]);
-            while (alloc_data[i] != NULL) {
-                INCRIDX(i);
+            int i = HASHIDX(sh, old_data[k]);
+            while (sh->data[i] != NULL) {
+                INCRIDX(sh, i);
             }
-            alloc_data[i] = old_data[k];
+            sh->data[i] = old_data[k];
         }
     }
     free(old_data);
     return 1;
 }
 
-/* Find node in allocation hash table */
-UNUSED static struct allocNode *AllocHashTblFind(struct allocNode *x)
+/* Find node in a shard hash table */
+UNUSED static struct allocNode *AllocHashTblFind(struct allocShard *sh, struct allocNode *x)
 {
     struct allocNode *y = NULL;
-    if (alloc_data_len > 0) {
-        int i = HASHIDX(x);
-        while (alloc_data[i] != NULL) {
-            y = alloc_data[i];
+    if (sh->data_len > 0) {
+        int i = HASHIDX(sh, x);
+        while (sh->data[i] != NULL) {
+            y = sh->data[i];
             if (y != DEL && EQUAL(x, y)) {
                 return y;
             }
-            INCRIDX(i);
+            INCRIDX(sh, i);
         }
     }
     return NULL;
 }
 
-/* Add node to allocation hash table */
-UNUSED static int AllocHashTblAdd(struct allocNode *x)
+/* Add node to a shard hash table */
+UNUSED static int AllocHashTblAdd(struct allocShard *sh, struct allocNode *x)
 {
-    if (2*(alloc_q + 1) > alloc_data_len) {
-        /* Resize allocation hash table to preserve maximum 50% occupancy */
-        if (!AllocHashTblResize()) {
+    if (2*(sh->q + 1) > sh->data_len) {
+        /* Resize shard hash table to preserve maximum 50% occupancy */
+        if (!AllocHashTblResize(sh)) {
             return 0;
         }
     }
-    int i = HASHIDX(x);
-    while (alloc_data[i] != NULL && alloc_data[i] != DEL) {
-        INCRIDX(i);
+    int i = HASHIDX(sh, x);
+    while (sh->data[i] != NULL && sh->data[i] != DEL) {
+        INCRIDX(sh, i);
     }
-    if (alloc_data[i] == NULL) {
-        ++alloc_q;
+    if (sh->data[i] == NULL) {
+        ++sh->q;
     }
-    ++alloc_n;
-    alloc_data[i] = x;
+    ++sh->n;
+    sh->data[i] = x;
     return 1;
 }
 
-/* Extract node from allocation hash table */
-UNUSED static struct allocNode *AllocHashTblExtract(struct allocNode *x)
+/* Extract node from a shard hash table */
+UNUSED static struct allocNode *AllocHashTblExtract(struct allocShard *sh, struct allocNode *x)
 {
-    if (alloc_data_len > 0) {
-        int i = HASHIDX(x);
-        while (alloc_data[i] != NULL) {
-            struct allocNode *y = alloc_data[i];
+    if (sh->data_len > 0) {
+        int i = HASHIDX(sh, x);
+        while (sh->data[i] != NULL) {
+            struct allocNode *y = sh->data[i];
             if (y != DEL && EQUAL(x, y)) {
-                alloc_data[i] = DEL;
-                --alloc_n;
-                if (alloc_n == 0) {
+                sh->data[i] = DEL;
+                --sh->n;
+                if (sh->n == 0) {
                     /* Free all hash table memory */
-                    free(alloc_data);
-                    alloc_data = NULL;
-                    alloc_data_len = 0;
-                    alloc_q = 0;
-                } else if (8*alloc_n < alloc_data_len) {
+                    free(sh->data);
+                    sh->data = NULL;
+                    sh->data_len = 0;
+                    sh->q = 0;
+                } else if (8*sh->n < sh->data_len) {
                     /* Resize hash table to preserve minimum 50% occupancy */
-                    if (!AllocHashTblResize()) {
+                    if (!AllocHashTblResize(sh)) {
                         return NULL;
                     }
                 }
                 return y;
             }
-            INCRIDX(i);
+            INCRIDX(sh, i);
         }
     }
     return NULL;
@@ -381,15 +910,20 @@ UNUSED static struct allocNode *AllocHashTblExtract(struct allocNode *x)
 /* Returns 0 if list is corrupted; 1 if list is OK */
 UNUSED static int CheckAllocList(void)
 {
-    int count = 0;
+    int count = 0, n = 0;
     size_t total = 0;
-    for (int k = 0; k < alloc_data_len; ++k) {
-        if (alloc_data[k] != NULL && alloc_data[k] != DEL) {
-            ++count;
-            total += alloc_data[k]->size;
+    for (int s = 0; s < nshards; ++s) {
+        struct allocShard *sh = AllocShardLockIndex(s);
+        for (int k = 0; k < sh->data_len; ++k) {
+            if (sh->data[k] != NULL && sh->data[k] != DEL) {
+                ++count;
+                total += sh->data[k]->size;
+            }
         }
+        n += sh->n;
+        AllocShardUnlock(sh);
     }
-    return count == alloc_n && total == lalMallocTotal;
+    return count == n && total == AtomicLoad(&lalMallocTotal);
 }
 
 /* Useful function for debugging */
@@ -398,7 +932,10 @@ UNUSED static int CheckAllocList(void)
 UNUSED static struct allocNode *FindAlloc(void *p)
 {
     struct allocNode key = { .addr = p };
-    return AllocHashTblFind(&key);
+    struct allocShard *sh = AllocShardLock(p);
+    struct allocNode *node = AllocHashTblFind(sh, &key);
+    AllocShardUnlock(sh);
+    return node;
 }
 
 
@@ -428,10 +965,8 @@ static void *PadAlloc(size_t * p, size_t n, int keep, const char *func)
         ((char *) p)[i + prefix] = (char) (i ^ padding);
     }
 
-    pthread_mutex_lock(&mut);
-    lalMallocTotal += n;
-    lalMallocTotalPeak = (lalMallocTotalPeak > lalMallocTotal) ? lalMallocTotalPeak : lalMallocTotal;
-    pthread_mutex_unlock(&mut);
+    AtomicMax(&lalMallocTotalPeak, AtomicAdd(&lalMallocTotal, n));
+    AtomicAdd(&lalMallocCount, 1);
 
     return (void *) (((char *) p) + prefix);
 }
@@ -495,7 +1030,7 @@ static void *UnPadAlloc(void *p, int keep, const char *func)
     }
 
     /* see if there is enough allocated memory to be freed */
-    if (lalMallocTotal < n) {
+    if (AtomicLoad(&lalMallocTotal) < n) {
         lalRaiseHook(SIGSEGV, "%s error: lalMallocTotal too small\n",
                      func);
         return NULL;
@@ -509,9 +1044,7 @@ static void *UnPadAlloc(void *p, int keep, const char *func)
     q[0] = -1;  /* set negative to detect duplicate frees */
     q[1] = ~magic;
 
-    pthread_mutex_lock(&mut);
-    lalMallocTotal -= n;
-    pthread_mutex_unlock(&mut);
+    AtomicSub(&lalMallocTotal, n);
 
     return q;
 }
@@ -529,16 +1062,19 @@ static void *PushAlloc(void *p, size_t n, const char *file, int line)
     if (!(newnode = malloc(sizeof(*newnode)))) {
         return NULL;
     }
-    pthread_mutex_lock(&mut);
     newnode->addr = p;
     newnode->size = n;
     newnode->file = file;
     newnode->line = line;
-    if (!AllocHashTblAdd(newnode)) {
+    newnode->site = AllocSiteGet(file, line);
+    struct allocShard *sh = AllocShardLock(p);
+    if (!AllocHashTblAdd(sh, newnode)) {
+        AllocShardUnlock(sh);
         free(newnode);
         return NULL;
     }
-    pthread_mutex_unlock(&mut);
+    AllocShardUnlock(sh);
+    AllocSiteAdd(newnode->site, n);
     return p;
 }
 
@@ -551,16 +1087,16 @@ static void *PopAlloc(void *p, const char *func)
     if (!p) {
         return NULL;
     }
-    pthread_mutex_lock(&mut);
     struct allocNode key = { .addr = p };
-    struct allocNode *node = AllocHashTblExtract(&key);
+    struct allocShard *sh = AllocShardLock(p);
+    struct allocNode *node = AllocHashTblExtract(sh, &key);
+    AllocShardUnlock(sh);
     if (node == NULL) {
-        pthread_mutex_unlock(&mut);
         lalRaiseHook(SIGSEGV, "%s error: alloc %p not found\n", func, p);
         return NULL;
     }
+    AllocSiteRemove(node->site, node->size);
     free(node);
-    pthread_mutex_unlock(&mut);
     return p;
 }
 
@@ -574,23 +1110,28 @@ static void *ModAlloc(void *p, void *q, size_t n, const char *func,
     if (!p || !q) {
         return NULL;
     }
-    pthread_mutex_lock(&mut);
     struct allocNode key = { .addr = p };
-    struct allocNode *node = AllocHashTblExtract(&key);
+    struct allocShard *sh = AllocShardLock(p);
+    struct allocNode *node = AllocHashTblExtract(sh, &key);
+    AllocShardUnlock(sh);
     if (node == NULL) {
-        pthread_mutex_unlock(&mut);
         lalRaiseHook(SIGSEGV, "%s error: alloc %p not found\n", func, p);
         return NULL;
     }
+    AllocSiteRemove(node->site, node->size);
     node->addr = q;
     node->size = n;
     node->file = file;
     node->line = line;
-    if (!AllocHashTblAdd(node)) {
+    node->site = AllocSiteGet(file, line);
+    sh = AllocShardLock(q);
+    if (!AllocHashTblAdd(sh, node)) {
+        AllocShardUnlock(sh);
         free(node);
         return NULL;
     }
-    pthread_mutex_unlock(&mut);
+    AllocShardUnlock(sh);
+    AllocSiteAdd(node->site, n);
     return q;
 }
 
@@ -746,26 +1287,35 @@ void LALFree(void *q)
 void LALCheckMemoryLeaks(void)
 {
     int leak = 0;
+    int alloc_n = 0;
     if (!(lalDebugLevel & LALMEMDBGBIT)) {
         return;
     }
 
-    /* alloc_data_len should be zero */
-    if ((lalDebugLevel & LALMEMTRKBIT) && alloc_data_len > 0) {
-        XLALPrintError("LALCheckMemoryLeaks: allocation list\n");
-        for (int k = 0; k < alloc_data_len; ++k) {
-            if (alloc_data[k] != NULL && alloc_data[k] != DEL) {
-                XLALPrintError("%p: %zu bytes (%s:%d)\n", alloc_data[k]->addr,
-                               alloc_data[k]->size, alloc_data[k]->file,
-                               alloc_data[k]->line);
+    /* all shard hash tables should be empty */
+    for (int s = 0; s < nshards; ++s) {
+        struct allocShard *sh = AllocShardLockIndex(s);
+        if ((lalDebugLevel & LALMEMTRKBIT) && sh->data_len > 0) {
+            if (!leak) {
+                XLALPrintError("LALCheckMemoryLeaks: allocation list\n");
+            }
+            for (int k = 0; k < sh->data_len; ++k) {
+                if (sh->data[k] != NULL && sh->data[k] != DEL) {
+                    XLALPrintError("%p: %zu bytes (%s:%d)\n", sh->data[k]->addr,
+                                   sh->data[k]->size, sh->data[k]->file,
+                                   sh->data[k]->line);
+                }
             }
+            leak = 1;
         }
-        leak = 1;
+        alloc_n += sh->n;
+        AllocShardUnlock(sh);
     }
 
     /* lalMallocTotal and alloc_n should be zero */
-    if ((lalDebugLevel & LALMEMPADBIT) && (lalMallocTotal || alloc_n)) {
-        XLALPrintError("LALCheckMemoryLeaks: %d allocs, %zd bytes\n", alloc_n, lalMallocTotal);
+    const size_t total = AtomicLoad(&lalMallocTotal);
+    if ((lalDebugLevel & LALMEMPADBIT) && (total || alloc_n)) {
+        XLALPrintError("LALCheckMemoryLeaks: %d allocs, %zd bytes\n", alloc_n, total);
         leak = 1;
     }
 
@@ -779,8 +1329,69 @@ void LALCheckMemoryLeaks(void)
     return;
 }
 
+
+/* sort call sites by decreasing peak, then total, allocated bytes */
+static int AllocSiteCompare(const void *x, const void *y)
+{
+    const struct allocSite *a = *(const struct allocSite * const *) x;
+    const struct allocSite *b = *(const struct allocSite * const *) y;
+    if (a->peak != b->peak) {
+        return (a->peak < b->peak) ? 1 : -1;
+    }
+    if (a->total != b->total) {
+        return (a->total < b->total) ? 1 : -1;
+    }
+    return (a->count < b->count) ? 1 : (a->count > b->count) ? -1 : 0;
+}
+
+void LALPrintMemoryStatistics(int max_sites)
+{
+    if (!(lalDebugLevel & LALMEMDBGBIT)) {
+        return;
+    }
+
+    XLALPrintError("LALPrintMemoryStatistics: %zu bytes allocated, peak %zu bytes\n",
+                   AtomicLoad(&lalMallocTotal), AtomicLoad(&lalMallocTotalPeak));
+    if (!(lalDebugLevel & LALMEMTRKBIT)) {
+        return;
+    }
+
+    /* collect call sites */
+    struct allocSite **sites = malloc((nsites + 1) * sizeof(*sites));
+    if (sites == NULL) {
+        return;
+    }
+    int n = 0;
+    for (int i = 0; i < nsites; ++i) {
+        struct allocSite *site = SITE_LOAD(&site_data[i]);
+        if (site != NULL) {
+            sites[n++] = site;
+        }
+    }
+    if (AtomicLoad(&site_overflow.count) > 0) {
+        sites[n++] = &site_overflow;
+    }
+    qsort(sites, n, sizeof(sites[0]), AllocSiteCompare);
+
+    /* print call sites with the highest peak allocations */
+    if (max_sites <= 0 || max_sites > n) {
+        max_sites = n;
+    }
+    XLALPrintError("%12s %12s %14s %12s  %s\n", "peak bytes", "current", "total bytes", "allocs", "call site");
+    for (int i = 0; i < max_sites; ++i) {
+        XLALPrintError("%12zu %12zu %14zu %12zu  %s:%d\n",
+                       AtomicLoad(&sites[i]->peak), AtomicLoad(&sites[i]->current),
+                       AtomicLoad(&sites[i]->total), AtomicLoad(&sites[i]->count),
+                       sites[i]->file, sites[i]->line);
+    }
+
+    free(sites);
+    return;
+}
+
 #else
 
 void (LALCheckMemoryLeaks)(void) { return; }
+void (LALPrintMemoryStatistics)(int max_sites) { (void) max_sites; return; }
 
 #endif /* ! defined NDEBUG */
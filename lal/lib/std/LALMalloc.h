@@ -32,6 +32,7 @@ extern "C" {
 /** \addtogroup LALMalloc_h */ /** @{ */
 extern size_t lalMallocTotal;
 extern size_t lalMallocTotalPeak;
+extern size_t lalMallocCount;
 void *XLALMalloc(size_t n);
 void *XLALMallocLong(size_t n, const char *file, int line);
 void *XLALCalloc(size_t m, size_t n);
@@ -67,6 +68,49 @@ void XLALFreeAligned(void *ptr);
 #endif /* LAL_FFTW3_MEMALIGN_ENABLED */
 /** @} */
 
+/** \addtogroup LALMalloc_h */ /** @{ */
+/**
+ * Policies for placing the pages of a memory block on the nodes of a
+ * non-uniform memory access (NUMA) system; these are hints, which are
+ * silently ignored where the operating system does not support them.
+ */
+typedef enum tagLALMemoryPlacement {
+  LAL_MEMORY_PLACEMENT_DEFAULT = 0,	/**< Use the memory policy of the calling thread */
+  LAL_MEMORY_PLACEMENT_INTERLEAVE,	/**< Interleave pages round-robin over all nodes */
+  LAL_MEMORY_PLACEMENT_LOCAL,		/**< Place each page on the node of the thread which first touches it */
+  LAL_MEMORY_PLACEMENT_MAX
+} LALMemoryPlacement;
+int XLALSetMemoryPlacement(void *ptr, size_t size, LALMemoryPlacement placement);
+void *XLALMallocPlacedLong(size_t size, LALMemoryPlacement placement, const char *file, int line);
+void *XLALMallocPlaced(size_t size, LALMemoryPlacement placement);
+void XLALFreePlaced(void *ptr);
+#ifndef SWIG    /* exclude from SWIG interface */
+#define XLALMallocPlaced(size, placement) XLALMallocPlacedLong(size, placement, __FILE__, __LINE__)
+#endif /* SWIG */
+/** @} */
+
+/** \addtogroup LALMalloc_h */ /** @{ */
+/**
+ * Modes for backing large memory blocks, allocated by the XLAL memory
+ * routines, with huge pages. The initial mode and size threshold are read
+ * from the environment variables \c LAL_HUGE_PAGES ('off', 'transparent' or
+ * 'explicit') and \c LAL_HUGE_PAGE_THRESHOLD (in bytes), and may be changed
+ * with XLALSetHugePages(). Where huge pages are not available, allocations
+ * silently fall back to normal pages.
+ */
+typedef enum tagLALHugePageMode {
+  LAL_HUGE_PAGES_OFF = 0,		/**< Use normal pages */
+  LAL_HUGE_PAGES_TRANSPARENT,		/**< Advise the operating system to back blocks with transparent huge pages */
+  LAL_HUGE_PAGES_EXPLICIT,		/**< Map reserved huge pages for blocks allocated with XLALMallocPlaced(), otherwise as ::LAL_HUGE_PAGES_TRANSPARENT */
+  LAL_HUGE_PAGES_MAX
+} LALHugePageMode;
+extern size_t lalMallocHugePageCount;
+extern size_t lalMallocHugePageTotal;
+int XLALSetHugePages(LALHugePageMode mode, size_t threshold);
+LALHugePageMode XLALGetHugePages(size_t *threshold);
+LALHugePageMode XLALHugePageAllocation(const void *ptr);
+/** @} */
+
 #if defined NDEBUG
 
 #ifndef SWIG    /* exclude from SWIG interface */
@@ -81,6 +125,7 @@ void XLALFreeAligned(void *ptr);
 #define LALReallocLong( p, n, file, line ) realloc( p, n )
 #define LALFree                            free
 #define LALCheckMemoryLeaks()
+#define LALPrintMemoryStatistics(max_sites)
 #endif /* SWIG */
 
 #else
@@ -118,6 +163,7 @@ void *LALReallocLong(void *p, size_t n, const char *file, int line);
 #endif /* NDEBUG  */
 
 void (LALCheckMemoryLeaks) (void);
+void (LALPrintMemoryStatistics) (int max_sites);
 
 #if 0
 {       /* so that editors will match succeeding brace */
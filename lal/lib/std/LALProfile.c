@@ -0,0 +1,233 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALStdio.h>
+#include <lal/LALProfile.h>
+#include <lal/XLALError.h>
+
+#ifndef HAVE_CLOCK_GETTIME
+#include <sys/time.h>
+#endif
+
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+static pthread_once_t lalProfileOnce = PTHREAD_ONCE_INIT;
+static pthread_mutex_t lalProfileMutex = PTHREAD_MUTEX_INITIALIZER;
+#define LAL_ONCE(init) pthread_once(&lalProfileOnce, (init))
+#define LAL_LOCK() pthread_mutex_lock(&lalProfileMutex)
+#define LAL_UNLOCK() pthread_mutex_unlock(&lalProfileMutex)
+#else
+static int lalProfileOnce = 1;
+#define LAL_ONCE(init) (lalProfileOnce ? (init)(), lalProfileOnce = 0 : 0)
+#define LAL_LOCK() ((void)0)
+#define LAL_UNLOCK() ((void)0)
+#endif
+
+struct tagLALProfileRegion {
+    struct tagLALProfileRegion *next;
+    char *name;
+    UINT8 ncalls;
+    UINT8 count;
+    REAL8 seconds;
+    REAL8 maxseconds;
+};
+
+/* whether profiling is enabled */
+static int lalProfileEnabled = 0;
+
+/* file, given by LAL_PROFILE, to which timers and counters are written at exit */
+static char *lalProfileFile = NULL;
+
+/* list of timers and counters, in order of creation */
+static LALProfileRegion *lalProfileHead = NULL;
+static LALProfileRegion **lalProfileTail = &lalProfileHead;
+
+static void XLALProfileAtExit(void)
+{
+    XLALProfileDump(strcmp(lalProfileFile, "-") == 0 ? NULL : lalProfileFile);
+}
+
+static void XLALProfileInit(void)
+{
+    const char *env = getenv("LAL_PROFILE");
+    if (env == NULL || *env == '\0')
+        return;
+    /* plain malloc(), since this lives until the program exits */
+    lalProfileFile = malloc(strlen(env) + 1);
+    if (lalProfileFile == NULL) {
+        lalAbortHook("%s: could not allocate memory for LAL_PROFILE='%s'\n", __func__, env);
+        return;
+    }
+    strcpy(lalProfileFile, env);
+    if (atexit(XLALProfileAtExit) != 0) {
+        lalAbortHook("%s: could not register exit handler for LAL_PROFILE='%s'\n", __func__, env);
+        return;
+    }
+    lalProfileEnabled = 1;
+}
+
+/* return a monotonic wall-clock time in seconds */
+static REAL8 XLALProfileTime(void)
+{
+#if defined(HAVE_CLOCK_GETTIME) && defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + 1e-6 * tv.tv_usec;
+#endif
+}
+
+/* find or create the timer or counter 'name'; must be called with the lock held */
+static LALProfileRegion *XLALProfileLookup(LALProfileRegion **region, const char *name)
+{
+    if (*region == NULL) {
+        LALProfileRegion *r;
+        for (r = lalProfileHead; r != NULL && strcmp(r->name, name) != 0; r = r->next);
+        if (r == NULL) {
+            /* plain malloc(), since timers and counters live until the program exits,
+             * and are referred to by static variables at each annotation */
+            r = calloc(1, sizeof(*r));
+            if (r == NULL || (r->name = malloc(strlen(name) + 1)) == NULL) {
+                free(r);
+                return NULL;
+            }
+            strcpy(r->name, name);
+            *lalProfileTail = r;
+            lalProfileTail = &r->next;
+        }
+        *region = r;
+    }
+    return *region;
+}
+
+/** Return whether profiling is enabled. */
+int XLALProfileEnabled(void)
+{
+    LAL_ONCE(XLALProfileInit);
+    return lalProfileEnabled;
+}
+
+/**
+ * Enable or disable profiling. Timers which are running when profiling is
+ * disabled are not accumulated.
+ */
+int XLALProfileSetEnabled(int enabled)
+{
+    LAL_ONCE(XLALProfileInit);
+    lalProfileEnabled = enabled ? 1 : 0;
+    return XLAL_SUCCESS;
+}
+
+/** Start a timer; use XLAL_PROFILE_BEGIN() instead of calling this function directly. */
+REAL8 XLALProfileBegin(LALProfileRegion **region, const char *name)
+{
+    LAL_LOCK();
+    LALProfileRegion *r = XLALProfileLookup(region, name);
+    LAL_UNLOCK();
+    return r == NULL ? -1.0 : XLALProfileTime();
+}
+
+/** Stop a timer; use XLAL_PROFILE_END() instead of calling this function directly. */
+void XLALProfileEnd(LALProfileRegion **region, REAL8 start)
+{
+    const REAL8 seconds = XLALProfileTime() - start;
+    LAL_LOCK();
+    LALProfileRegion *r = *region;
+    if (lalProfileEnabled && r != NULL) {
+        ++r->ncalls;
+        r->seconds += seconds;
+        if (seconds > r->maxseconds)
+            r->maxseconds = seconds;
+    }
+    LAL_UNLOCK();
+}
+
+/** Add to a counter; use XLAL_PROFILE_COUNT() instead of calling this function directly. */
+void XLALProfileCount(LALProfileRegion **region, const char *name, UINT8 count)
+{
+    LAL_LOCK();
+    LALProfileRegion *r = XLALProfileLookup(region, name);
+    if (r != NULL) {
+        ++r->ncalls;
+        r->count += count;
+    }
+    LAL_UNLOCK();
+}
+
+/** Clear the values accumulated by all timers and counters. */
+void XLALProfileReset(void)
+{
+    LAL_LOCK();
+    for (LALProfileRegion *r = lalProfileHead; r != NULL; r = r->next) {
+        r->ncalls = r->count = 0;
+        r->seconds = r->maxseconds = 0;
+    }
+    LAL_UNLOCK();
+}
+
+/**
+ * Write the values accumulated by all timers and counters to the file \c fname: in JSON
+ * format if \c fname ends in <tt>.json</tt>, and in CSV format otherwise. If \c fname is
+ * \c NULL, they are written in CSV format to standard error.
+ */
+int XLALProfileDump(const char *fname)
+{
+    const size_t len = fname == NULL ? 0 : strlen(fname);
+    const int json = len >= 5 && strcmp(fname + len - 5, ".json") == 0;
+    FILE *fp = fname == NULL ? stderr : fopen(fname, "w");
+    XLAL_CHECK(fp != NULL, XLAL_EIO, "Could not open profile file '%s'", fname);
+    LAL_LOCK();
+    if (json)
+        fprintf(fp, "[");
+    else
+        fprintf(fp, "name,calls,count,seconds,max_seconds\n");
+    for (LALProfileRegion *r = lalProfileHead; r != NULL; r = r->next) {
+        if (json)
+            fprintf(fp, "%s\n  {\"name\": \"", r == lalProfileHead ? "" : ",");
+        else
+            fprintf(fp, "\"");
+        for (const char *c = r->name; *c != '\0'; ++c) {
+            if (*c == '"')
+                fputs(json ? "\\\"" : "\"\"", fp);
+            else if (*c == '\\' && json)
+                fputs("\\\\", fp);
+            else
+                fputc(*c, fp);
+        }
+        if (json)
+            fprintf(fp, "\", \"calls\": %" LAL_UINT8_FORMAT ", \"count\": %" LAL_UINT8_FORMAT ", \"seconds\": %.9g, \"max_seconds\": %.9g}",
+                    r->ncalls, r->count, r->seconds, r->maxseconds);
+        else
+            fprintf(fp, "\",%" LAL_UINT8_FORMAT ",%" LAL_UINT8_FORMAT ",%.9g,%.9g\n", r->ncalls, r->count, r->seconds, r->maxseconds);
+    }
+    if (json)
+        fprintf(fp, "\n]\n");
+    LAL_UNLOCK();
+    if (fp != stderr) {
+        XLAL_CHECK(fclose(fp) == 0, XLAL_EIO, "Could not write profile file '%s'", fname);
+    }
+    return XLAL_SUCCESS;
+}
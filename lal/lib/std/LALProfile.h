@@ -0,0 +1,104 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#ifndef _LALPROFILE_H
+#define _LALPROFILE_H
+
+#include <lal/LALAtomicDatatypes.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#elif 0
+}       /* so that editors will match preceding brace */
+#endif
+
+/**
+ * \defgroup LALProfile_h Header LALProfile.h
+ * \ingroup lal_std
+ * \brief Lightweight scoped timers and counters for finding where time goes inside LALSuite.
+ *
+ * Functions may be annotated with a named timer, which accumulates the number of calls
+ * and the wall-clock time spent between XLAL_PROFILE_BEGIN() and XLAL_PROFILE_END(),
+ * and with named counters, which accumulate a count with XLAL_PROFILE_COUNT():
+ *
+ * \code
+ * int XLALDoSomething( REAL8Vector *v ) {
+ *   XLAL_PROFILE_BEGIN( timer, "XLALDoSomething" );
+ *   XLAL_PROFILE_COUNT( "XLALDoSomething:samples", v->length );
+ *   ...
+ *   XLAL_PROFILE_END( timer );
+ *   return XLAL_SUCCESS;
+ * }
+ * \endcode
+ *
+ * Profiling is disabled by default, in which case each annotation costs one
+ * predictable branch. It is enabled by setting the environment variable
+ * <tt>LAL_PROFILE</tt> to the name of a file, to which the accumulated timers and
+ * counters are written when the program exits: in JSON format if the file name ends in
+ * <tt>.json</tt>, and in CSV format otherwise. If <tt>LAL_PROFILE</tt> is <tt>-</tt>,
+ * they are written in CSV format to standard error. Profiling may also be controlled
+ * with XLALProfileSetEnabled(), and the accumulated timers and counters written with
+ * XLALProfileDump() or cleared with XLALProfileReset().
+ *
+ * Annotations with the same name, e.g. in different functions or called from
+ * different threads, are accumulated together; the time of a timer is therefore summed
+ * over threads, and may exceed the elapsed wall-clock time. A timer whose function
+ * returns between XLAL_PROFILE_BEGIN() and XLAL_PROFILE_END(), e.g. on error, is not
+ * accumulated.
+ *//** @{ */
+
+int XLALProfileEnabled(void);
+int XLALProfileSetEnabled(int enabled);
+int XLALProfileDump(const char *fname);
+void XLALProfileReset(void);
+
+#ifndef SWIG    /* exclude from SWIG interface */
+
+/** A named timer or counter; accumulated values are written by XLALProfileDump() */
+typedef struct tagLALProfileRegion LALProfileRegion;
+
+REAL8 XLALProfileBegin(LALProfileRegion **region, const char *name);
+void XLALProfileEnd(LALProfileRegion **region, REAL8 start);
+void XLALProfileCount(LALProfileRegion **region, const char *name, UINT8 count);
+
+/**
+ * Start the timer <tt>name</tt>; <tt>var</tt> is a name, unique within the
+ * enclosing function, which is passed to XLAL_PROFILE_END() to stop the timer.
+ */
+#define XLAL_PROFILE_BEGIN(var, name) \
+    static LALProfileRegion *var##_lal_profile_region = NULL; \
+    const REAL8 var##_lal_profile_start = XLALProfileEnabled() ? XLALProfileBegin(&var##_lal_profile_region, (name)) : -1.0
+
+/** Stop the timer started by XLAL_PROFILE_BEGIN() with the same <tt>var</tt>. */
+#define XLAL_PROFILE_END(var) \
+    do { if (var##_lal_profile_start >= 0) XLALProfileEnd(&var##_lal_profile_region, var##_lal_profile_start); } while (0)
+
+/** Add <tt>count</tt> to the counter <tt>name</tt>. */
+#define XLAL_PROFILE_COUNT(name, count) \
+    do { static LALProfileRegion *lal_profile_region_ = NULL; if (XLALProfileEnabled()) XLALProfileCount(&lal_profile_region_, (name), (count)); } while (0)
+
+#endif /* SWIG */
+
+/** @} */
+
+#if 0
+{       /* so that editors will match succeeding brace */
+#elif defined(__cplusplus)
+}
+#endif
+
+#endif /* _LALPROFILE_H */
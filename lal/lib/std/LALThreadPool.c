@@ -0,0 +1,379 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <config.h>
+#include <stdlib.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALThreadPool.h>
+#include <lal/XLALError.h>
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#ifdef __GNUC__
+#define UNUSED __attribute__ ((unused))
+#else
+#define UNUSED
+#endif
+
+/* concurrency budget, i.e. maximum number of threads busy with tasks; 0 until initialised */
+static int lalThreadPoolMaxThreads = 0;
+
+/* return the default concurrency budget, from LAL_NUM_THREADS or the number of processors */
+static int XLALThreadPoolDefaultMaxThreads(void)
+{
+    const char *env = getenv("LAL_NUM_THREADS");
+    if (env != NULL && *env != '\0') {
+        char *end;
+        long n = strtol(env, &end, 10);
+        if (*end != '\0' || n < 1 || n > 65536) {
+            lalAbortHook("%s: could not parse LAL_NUM_THREADS='%s'\n", __func__, env);
+            return 1;
+        }
+        return (int) n;
+    }
+#if defined(HAVE_UNISTD_H) && defined(_SC_NPROCESSORS_ONLN)
+    {
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+        if (n > 0)
+            return (int) n;
+    }
+#endif
+    return 1;
+}
+
+#ifndef LAL_PTHREAD_LOCK        /* non-pthread-safe code */
+
+/* nesting depth of the (only) thread inside tasks */
+static int lalThreadPoolDepthGlobal = 0;
+
+/** Return the concurrency budget shared by all calls to XLALThreadPoolRun(). */
+int XLALThreadPoolGetMaxThreads(void)
+{
+    if (lalThreadPoolMaxThreads == 0)
+        lalThreadPoolMaxThreads = XLALThreadPoolDefaultMaxThreads();
+    return lalThreadPoolMaxThreads;
+}
+
+/** Set the concurrency budget shared by all calls to XLALThreadPoolRun(). */
+int XLALThreadPoolSetMaxThreads(int nthreads)
+{
+    XLAL_CHECK(nthreads >= 1, XLAL_EDOM, "Number of threads must be at least 1");
+    lalThreadPoolMaxThreads = nthreads;
+    return XLAL_SUCCESS;
+}
+
+/** Return the number of tasks the calling thread is nested inside. */
+int XLALThreadPoolDepth(void)
+{
+    return lalThreadPoolDepthGlobal;
+}
+
+/**
+ * Run the tasks <tt>func(arg, i)</tt> for \f$0 \le i <\f$ \c ntasks.
+ * Without POSIX thread support, the tasks are run in order in the calling thread.
+ */
+int XLALThreadPoolRun(LALThreadPoolTaskFunc func, void *arg, size_t ntasks)
+{
+    XLAL_CHECK(func != NULL, XLAL_EFAULT);
+    ++lalThreadPoolDepthGlobal;
+    for (size_t i = 0; i < ntasks; ++i) {
+        if (func(arg, i) != XLAL_SUCCESS) {
+            --lalThreadPoolDepthGlobal;
+            XLAL_ERROR(XLAL_EFUNC, "Task %zu failed", i);
+        }
+    }
+    --lalThreadPoolDepthGlobal;
+    return XLAL_SUCCESS;
+}
+
+#else /* pthread safe code */
+
+#include <pthread.h>
+
+/* range of indexes [begin, end) of tasks which remain to be run by one participating thread */
+typedef struct tagLALThreadPoolRange {
+    size_t begin;
+    size_t end;
+} LALThreadPoolRange;
+
+/* a call to XLALThreadPoolRun() */
+typedef struct tagLALThreadPoolJob {
+    struct tagLALThreadPoolJob *next;   /* next job in the queue of jobs wanting helpers */
+    LALThreadPoolTaskFunc func;
+    void *arg;
+    int depth;                  /* nesting depth of the tasks */
+    size_t nranges;             /* number of ranges of tasks, i.e. maximum number of participating threads */
+    /* protected by lalThreadPoolLock */
+    size_t wanted;              /* number of pool threads which may still join the job */
+    size_t nslots;              /* number of participating threads so far, including the caller */
+    size_t nhelpers;            /* number of pool threads currently working on the job */
+    pthread_cond_t done;        /* signalled when nhelpers drops to zero */
+    /* protected by lock */
+    pthread_mutex_t lock;
+    LALThreadPoolRange *ranges;
+    int errnum;                 /* XLAL error number of the first failed task, or 0 */
+    size_t failed;              /* index of the first failed task */
+} LALThreadPoolJob;
+
+/* protects the state of the pool below, and the job fields marked above */
+static pthread_mutex_t lalThreadPoolLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t lalThreadPoolWake = PTHREAD_COND_INITIALIZER;
+static int lalThreadPoolNumThreads = 0;     /* number of pool threads started */
+static int lalThreadPoolNumIdle = 0;        /* number of pool threads waiting for a job */
+static LALThreadPoolJob *lalThreadPoolQueue = NULL;
+
+/*
+ *
+ * The nesting depth of the calling thread inside tasks.
+ * This is kept in thread-specific data.
+ *
+ */
+
+static pthread_key_t lalThreadPoolDepthKey;
+static pthread_once_t lalThreadPoolDepthKeyOnce = PTHREAD_ONCE_INIT;
+
+/* routine to create the nesting depth key */
+static void XLALCreateThreadPoolDepthKey(void)
+{
+    pthread_key_create(&lalThreadPoolDepthKey, NULL);
+    return;
+}
+
+static int XLALThreadPoolGetDepth(void)
+{
+    pthread_once(&lalThreadPoolDepthKeyOnce, XLALCreateThreadPoolDepthKey);
+    return (int) (size_t) pthread_getspecific(lalThreadPoolDepthKey);
+}
+
+static void XLALThreadPoolSetDepth(int depth)
+{
+    pthread_once(&lalThreadPoolDepthKeyOnce, XLALCreateThreadPoolDepthKey);
+    if (pthread_setspecific(lalThreadPoolDepthKey, (void *) (size_t) depth))
+        lalAbortHook("could not set thread pool depth: pthread_setspecific failed\n");
+}
+
+/* run tasks of a job as participating thread 'slot', stealing tasks from other threads when out of tasks */
+static void XLALThreadPoolWork(LALThreadPoolJob *job, size_t slot)
+{
+    LALThreadPoolRange *mine = &job->ranges[slot];
+    const int depth = XLALThreadPoolGetDepth();
+    XLALThreadPoolSetDepth(job->depth);
+    for (;;) {
+        size_t i;
+        pthread_mutex_lock(&job->lock);
+        if (mine->begin == mine->end) {
+            /* steal the upper half of the largest remaining range of tasks */
+            LALThreadPoolRange *victim = NULL;
+            for (size_t s = 0; s < job->nranges; ++s) {
+                LALThreadPoolRange *r = &job->ranges[s];
+                if (r->end - r->begin > (victim ? victim->end - victim->begin : 0))
+                    victim = r;
+            }
+            if (victim == NULL) {
+                pthread_mutex_unlock(&job->lock);
+                break;
+            }
+            const size_t take = (victim->end - victim->begin + 1) / 2;
+            mine->end = victim->end;
+            mine->begin = victim->end = victim->end - take;
+        }
+        i = mine->begin++;
+        pthread_mutex_unlock(&job->lock);
+        if (job->func(job->arg, i) != XLAL_SUCCESS) {
+            /* record the error, and skip all tasks which have not yet started */
+            const int errnum = XLALGetBaseErrno();
+            pthread_mutex_lock(&job->lock);
+            if (job->errnum == 0) {
+                job->errnum = errnum ? errnum : XLAL_EFAILED;
+                job->failed = i;
+            }
+            for (size_t s = 0; s < job->nranges; ++s)
+                job->ranges[s].begin = job->ranges[s].end;
+            pthread_mutex_unlock(&job->lock);
+        }
+    }
+    XLALThreadPoolSetDepth(depth);
+}
+
+/* main loop of a pool thread: wait for a job wanting helpers, join it, repeat */
+static void *XLALThreadPoolMain(void UNUSED *unused)
+{
+    pthread_mutex_lock(&lalThreadPoolLock);
+    for (;;) {
+        LALThreadPoolJob *job = lalThreadPoolQueue;
+        if (job == NULL) {
+            pthread_cond_wait(&lalThreadPoolWake, &lalThreadPoolLock);
+            continue;
+        }
+        const size_t slot = job->nslots++;
+        ++job->nhelpers;
+        if (--job->wanted == 0)
+            lalThreadPoolQueue = job->next;
+        --lalThreadPoolNumIdle;
+        pthread_mutex_unlock(&lalThreadPoolLock);
+        XLALClearErrno();
+        XLALThreadPoolWork(job, slot);
+        pthread_mutex_lock(&lalThreadPoolLock);
+        ++lalThreadPoolNumIdle;
+        if (--job->nhelpers == 0)
+            pthread_cond_signal(&job->done);
+    }
+    return NULL;
+}
+
+/** Return the concurrency budget shared by all calls to XLALThreadPoolRun(). */
+int XLALThreadPoolGetMaxThreads(void)
+{
+    pthread_mutex_lock(&lalThreadPoolLock);
+    if (lalThreadPoolMaxThreads == 0)
+        lalThreadPoolMaxThreads = XLALThreadPoolDefaultMaxThreads();
+    const int nthreads = lalThreadPoolMaxThreads;
+    pthread_mutex_unlock(&lalThreadPoolLock);
+    return nthreads;
+}
+
+/**
+ * Set the concurrency budget shared by all calls to XLALThreadPoolRun().
+ * Lowering the budget does not stop pool threads which are already busy,
+ * but no further tasks are handed to them until the budget allows.
+ */
+int XLALThreadPoolSetMaxThreads(int nthreads)
+{
+    XLAL_CHECK(nthreads >= 1, XLAL_EDOM, "Number of threads must be at least 1");
+    pthread_mutex_lock(&lalThreadPoolLock);
+    lalThreadPoolMaxThreads = nthreads;
+    pthread_mutex_unlock(&lalThreadPoolLock);
+    return XLAL_SUCCESS;
+}
+
+/** Return the number of tasks the calling thread is nested inside. */
+int XLALThreadPoolDepth(void)
+{
+    return XLALThreadPoolGetDepth();
+}
+
+/**
+ * Run the tasks <tt>func(arg, i)</tt> for \f$0 \le i <\f$ \c ntasks, in the calling thread
+ * and in any pool threads which are idle and allowed by the concurrency budget. Returns
+ * when all tasks have finished. Tasks may run concurrently and in any order, and are
+ * skipped once a task has failed.
+ */
+int XLALThreadPoolRun(LALThreadPoolTaskFunc func, void *arg, size_t ntasks)
+{
+    XLAL_CHECK(func != NULL, XLAL_EFAULT);
+    if (ntasks == 0)
+        return XLAL_SUCCESS;
+
+    /* decide how many pool threads to ask for help, starting further threads if the budget allows */
+    size_t nhelp = 0;
+    pthread_mutex_lock(&lalThreadPoolLock);
+    if (lalThreadPoolMaxThreads == 0)
+        lalThreadPoolMaxThreads = XLALThreadPoolDefaultMaxThreads();
+    if (ntasks > 1) {
+        const int busy = lalThreadPoolNumThreads - lalThreadPoolNumIdle;
+        const int allowed = lalThreadPoolMaxThreads - 1 - busy;
+        while (lalThreadPoolNumIdle < allowed && (size_t) lalThreadPoolNumIdle < ntasks - 1) {
+            pthread_t thread;
+            if (pthread_create(&thread, NULL, XLALThreadPoolMain, NULL) != 0)
+                break;
+            pthread_detach(thread);
+            ++lalThreadPoolNumThreads;
+            ++lalThreadPoolNumIdle;
+        }
+        if (allowed > 0) {
+            nhelp = (size_t) (lalThreadPoolNumIdle < allowed ? lalThreadPoolNumIdle : allowed);
+            if (nhelp > ntasks - 1)
+                nhelp = ntasks - 1;
+        }
+    }
+    pthread_mutex_unlock(&lalThreadPoolLock);
+
+    /* run the tasks in the calling thread only */
+    const int depth = XLALThreadPoolGetDepth();
+    if (nhelp == 0) {
+        XLALThreadPoolSetDepth(depth + 1);
+        for (size_t i = 0; i < ntasks; ++i) {
+            if (func(arg, i) != XLAL_SUCCESS) {
+                XLALThreadPoolSetDepth(depth);
+                XLAL_ERROR(XLAL_EFUNC, "Task %zu failed", i);
+            }
+        }
+        XLALThreadPoolSetDepth(depth);
+        return XLAL_SUCCESS;
+    }
+
+    /* divide the tasks evenly between the calling thread and its prospective helpers */
+    LALThreadPoolJob job;
+    job.next = NULL;
+    job.func = func;
+    job.arg = arg;
+    job.depth = depth + 1;
+    job.nranges = nhelp + 1;
+    job.wanted = nhelp;
+    job.nslots = 1;
+    job.nhelpers = 0;
+    job.errnum = 0;
+    job.failed = 0;
+    job.ranges = XLALMalloc((nhelp + 1) * sizeof(*job.ranges));
+    XLAL_CHECK(job.ranges != NULL, XLAL_ENOMEM);
+    for (size_t s = 0; s <= nhelp; ++s) {
+        job.ranges[s].begin = (s * ntasks) / (nhelp + 1);
+        job.ranges[s].end = ((s + 1) * ntasks) / (nhelp + 1);
+    }
+    pthread_mutex_init(&job.lock, NULL);
+    pthread_cond_init(&job.done, NULL);
+
+    /* ask for help, and start working */
+    pthread_mutex_lock(&lalThreadPoolLock);
+    LALThreadPoolJob **tail = &lalThreadPoolQueue;
+    while (*tail)
+        tail = &(*tail)->next;
+    *tail = &job;
+    if (nhelp == 1)
+        pthread_cond_signal(&lalThreadPoolWake);
+    else
+        pthread_cond_broadcast(&lalThreadPoolWake);
+    pthread_mutex_unlock(&lalThreadPoolLock);
+    XLALThreadPoolWork(&job, 0);
+
+    /* withdraw the request for help, and wait for helpers which joined to finish */
+    pthread_mutex_lock(&lalThreadPoolLock);
+    if (job.wanted > 0) {
+        for (tail = &lalThreadPoolQueue; *tail != &job; tail = &(*tail)->next);
+        *tail = job.next;
+        job.wanted = 0;
+    }
+    while (job.nhelpers > 0)
+        pthread_cond_wait(&job.done, &lalThreadPoolLock);
+    pthread_mutex_unlock(&lalThreadPoolLock);
+
+    pthread_cond_destroy(&job.done);
+    pthread_mutex_destroy(&job.lock);
+    XLALFree(job.ranges);
+
+    /* if the failed task ran in the calling thread, its error is already set here */
+    if (job.errnum != 0) {
+        if (xlalErrno)
+            XLAL_ERROR(XLAL_EFUNC, "Task %zu failed", job.failed);
+        XLAL_ERROR(job.errnum, "Task %zu failed", job.failed);
+    }
+    return XLAL_SUCCESS;
+}
+
+#endif /* end of pthread-safe code */
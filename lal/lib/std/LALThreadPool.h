@@ -0,0 +1,91 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#ifndef _LALTHREADPOOL_H
+#define _LALTHREADPOOL_H
+
+#include <stddef.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#elif 0
+}       /* so that editors will match preceding brace */
+#endif
+
+/**
+ * \defgroup LALThreadPool_h Header LALThreadPool.h
+ * \ingroup lal_std
+ * \brief A thread pool, shared by all LALSuite libraries, for running independent tasks in parallel.
+ *
+ * Library code with a loop over independent pieces of work, e.g. detectors, SFTs or
+ * templates, may hand the loop body to XLALThreadPoolRun():
+ *
+ * \code
+ * static int task( void *arg, size_t i ) {
+ *   MyWork *work = arg;
+ *   ...
+ *   return XLAL_SUCCESS;
+ * }
+ * ...
+ * XLAL_CHECK( XLALThreadPoolRun( task, &work, n ) == XLAL_SUCCESS, XLAL_EFUNC );
+ * \endcode
+ *
+ * The calling thread works on the tasks itself, helped by any idle threads of the pool.
+ * The tasks are initially divided evenly between the participating threads; a thread
+ * which runs out of tasks steals half of the remaining tasks of the busiest thread.
+ *
+ * All calls, from all threads, share a single concurrency budget: at most
+ * XLALThreadPoolGetMaxThreads() minus one pool threads are ever busy. Calls to
+ * XLALThreadPoolRun() made from within tasks, or from threads of a caller which is
+ * itself parallel, therefore only use pool threads which would otherwise be idle, and
+ * otherwise run their tasks in the calling thread; cores are never oversubscribed.
+ * XLALThreadPoolDepth() returns how deeply the calling thread is nested inside tasks.
+ *
+ * The concurrency budget defaults to the number of online processors, and may be set
+ * with the environment variable <tt>LAL_NUM_THREADS</tt>, or with XLALThreadPoolSetMaxThreads().
+ * A budget of one runs all tasks serially in the calling thread.
+ *
+ * If LAL is not built with POSIX thread support, all tasks are run serially in the
+ * calling thread.
+ *
+ * If a task fails, i.e. does not return #XLAL_SUCCESS, tasks which have not yet started
+ * are skipped, and XLALThreadPoolRun() fails with the XLAL error number of the failed task.
+ * Tasks must therefore not depend on being run in any particular order, or at all.
+ *//** @{ */
+
+int XLALThreadPoolGetMaxThreads(void);
+int XLALThreadPoolSetMaxThreads(int nthreads);
+int XLALThreadPoolDepth(void);
+
+#ifndef SWIG    /* exclude from SWIG interface */
+
+/** Type of a task run by XLALThreadPoolRun(); <tt>i</tt> is the index of the task */
+typedef int (*LALThreadPoolTaskFunc)(void *arg, size_t i);
+
+int XLALThreadPoolRun(LALThreadPoolTaskFunc func, void *arg, size_t ntasks);
+
+#endif /* SWIG */
+
+/** @} */
+
+#if 0
+{       /* so that editors will match succeeding brace */
+#elif defined(__cplusplus)
+}
+#endif
+
+#endif /* _LALTHREADPOOL_H */
@@ -31,6 +31,8 @@
 #include <lal/StreamInput.h>
 #include <lal/AVFactories.h>
 #include <lal/StringVector.h>
+#include <lal/LALHashTbl.h>
+#include <lal/LALHashFunc.h>
 
 #include <lal/UserInputParse.h>
 
@@ -42,9 +44,31 @@
 #define TRUE   (1==1)
 #define FALSE  (1==0)
 
+// ---------- local types ----------
+// entry in the index of config-file variables
+typedef struct {
+  UINT4 section;                // section index: 0 for the default section, >0 for named sections
+  const CHAR *name;             // start of variable name
+  size_t len;                   // length of variable name
+  UINT4 line;                   // line on which the variable is defined
+} ConfigIndexEntry;
+
+// index of config-file variables, built in a single pass through the config-file lines
+struct tagLALConfigFileIndex {
+  LALHashTbl *vars;             // hash table of ConfigIndexEntry, keyed by section and variable name
+  ConfigIndexEntry *entries;    // storage for hash table entries, one per line
+  LALStringVector *sections;    // names of named sections, in order of first appearance
+  INT4 *invalid;                // first line in each section without a variable name, or -1 if none
+  INT4 malformed;               // first line with a malformed section heading, or -1 if none
+};
+
 // ---------- local prototypes ----------
 static void cleanConfig ( char *text );
 static CHAR *XLALGetSectionName ( const CHAR *line );
+static UINT8 ConfigIndexHash ( const void *x );
+static int ConfigIndexCmp ( const void *x, const void *y );
+static int XLALBuildConfigFileIndex ( LALParsedDataFile *cfgdata );
+static void XLALDestroyConfigFileIndex ( struct tagLALConfigFileIndex *idx );
 
 // ==================== function definitions ==========
 /**
@@ -152,6 +176,7 @@ XLALDestroyParsedDataFile (LALParsedDataFile *cfgdata)  /**< [in] config-file da
 
   XLALDestroyTokenList ( cfgdata->lines );
   XLALFree ( cfgdata->wasRead );
+  XLALDestroyConfigFileIndex ( cfgdata->index );
   XLALFree ( cfgdata );
 
   return;
@@ -288,74 +313,61 @@ XLALReadConfigSTRINGVariable ( CHAR **varp,                     //!< [out] retur
   XLAL_CHECK ( cfgdata->lines->nTokens > 0, XLAL_EINVAL );
   XLAL_CHECK ( cfgdata->wasRead != NULL, XLAL_EINVAL );
 
-  BOOLEAN inRightSection = FALSE;
-
   (*wasRead) = FALSE;
 
-  // If we haven't been asked for a section then we want the
-  // "default" section, which starts at the top of the file without any section heading
-  CHAR *secName_cleaned = NULL;
-  if ( secName == NULL )
-    {
-      inRightSection = TRUE;
-    }
-  else
+  // index the config-file variables on first read, so that every read is a single lookup
+  if ( cfgdata->index == NULL )
     {
-      XLAL_CHECK ( (secName_cleaned = XLALDeblankString ( secName, strlen(secName) )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( XLALBuildConfigFileIndex ( cfgdata ) == XLAL_SUCCESS, XLAL_EFUNC );
     }
+  const struct tagLALConfigFileIndex *idx = cfgdata->index;
 
-  /* find the variable-name in the token-list (and in the right section, if given) */
-  size_t searchlen = strlen ( varName );
-
-  for ( UINT4 i = 0; i < cfgdata->lines->nTokens; i++ )
+  // If we haven't been asked for a section then we want the
+  // "default" section, which starts at the top of the file without any section heading
+  UINT4 section = 0;
+  if ( secName != NULL )
     {
-      if (cfgdata->lines->tokens[i][0] == '[')       /* Is this the start of a new section? */
+      CHAR *secName_cleaned;
+      XLAL_CHECK ( (secName_cleaned = XLALDeblankString ( secName, strlen(secName) )) != NULL, XLAL_EFUNC );
+      for ( UINT4 k = 0; k < idx->sections->length; k ++ )
         {
-          if ( inRightSection ) {
-            // if we previously were in the right section, it means we've now left it
-            // and therefore didn't find the variable we were looking for, so we return,
-            // but this is not an error!
-            return XLAL_SUCCESS;
-          }
-
-          CHAR *thisSec = XLALGetSectionName ( cfgdata->lines->tokens[i] );
-          XLAL_CHECK ( thisSec != NULL, XLAL_EFUNC );
-          if ( (secName_cleaned != NULL) && ( strcmp ( secName_cleaned, thisSec ) == 0 ) )
+          if ( strcmp ( secName_cleaned, idx->sections->data[k] ) == 0 )
             {
-              inRightSection = TRUE;
+              section = k + 1;
+              break;
             }
-          XLALFree ( thisSec );
-        } // end: if start of new section found
-      else
+        }
+      XLALFree ( secName_cleaned );
+      if ( section == 0 )
         {
-          if ( !inRightSection ) {
-            continue;
-          }
-
-          UINT4 varlen = strcspn ( cfgdata->lines->tokens[i], WHITESPACE "=:" );        /* get length of variable-name */
-          XLAL_CHECK ( varlen > 0, XLAL_EDOM, "Parsing error: nonexistent variable name in '%s'\n", cfgdata->lines->tokens[i] );
-
-          // pre-select based on length of variable-name
-          if ( varlen != searchlen ) {
-            continue;
-          }
-
-          // same len, but are they identical ?
-          if ( strncmp ( varName, cfgdata->lines->tokens[i], varlen ) == 0 )
+          // section not found: this is not an error, unless a malformed
+          // section heading stopped the search before it could be found
+          if ( idx->malformed >= 0 )
             {
-              char *strVal = cfgdata->lines->tokens[i] + varlen;
-              strVal += strspn ( strVal, WHITESPACE "=:" );     // skip all whitespace and define-chars
-              XLAL_CHECK ( XLALParseStringValueAsSTRING ( varp, strVal ) == XLAL_SUCCESS, XLAL_EFUNC ); // copy and remove quotes (if any)
-              cfgdata->wasRead[i] = 1;
-              (*wasRead) = TRUE;
-              break; // exit loop, we've found it
-            } // end: if found variable
+              XLALGetSectionName ( cfgdata->lines->tokens[idx->malformed] );
+              XLAL_ERROR ( XLAL_EFUNC );
+            }
+          return XLAL_SUCCESS;
+        }
+    }
 
-        } // end: if in right section
+  /* find the variable-name in the index (in the right section) */
+  const ConfigIndexEntry key = { .section = section, .name = varName, .len = strlen ( varName ) };
+  const ConfigIndexEntry *found = NULL;
+  XLAL_CHECK ( XLALHashTblFind ( idx->vars, &key, (const void **)&found ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-    } // end: for i < num_lines
+  // a line without a variable name is an error if it precedes the variable in its section
+  const INT4 invalid = idx->invalid[section];
+  XLAL_CHECK ( invalid < 0 || ( found != NULL && (INT4)found->line < invalid ), XLAL_EDOM, "Parsing error: nonexistent variable name in '%s'\n", cfgdata->lines->tokens[invalid] );
 
-  XLALFree ( secName_cleaned );
+  if ( found != NULL )
+    {
+      char *strVal = cfgdata->lines->tokens[found->line] + found->len;
+      strVal += strspn ( strVal, WHITESPACE "=:" );     // skip all whitespace and define-chars
+      XLAL_CHECK ( XLALParseStringValueAsSTRING ( varp, strVal ) == XLAL_SUCCESS, XLAL_EFUNC ); // copy and remove quotes (if any)
+      cfgdata->wasRead[found->line] = 1;
+      (*wasRead) = TRUE;
+    }
 
   return XLAL_SUCCESS;
 
@@ -435,6 +447,121 @@ XLALConfigFileGetUnreadEntries ( const LALParsedDataFile *cfgdata	///< [in] conf
 
 /*----------------------------------------------------------------------*/
 
+// local helper functions: hash and compare index entries by section and variable name
+static UINT8
+ConfigIndexHash ( const void *x )
+{
+  const ConfigIndexEntry *ex = (const ConfigIndexEntry *) x;
+  return XLALCityHash64WithSeed ( ex->name, ex->len, ex->section );
+}
+
+static int
+ConfigIndexCmp ( const void *x, const void *y )
+{
+  const ConfigIndexEntry *ex = (const ConfigIndexEntry *) x;
+  const ConfigIndexEntry *ey = (const ConfigIndexEntry *) y;
+  if ( ex->section != ey->section ) {
+    return ( ex->section < ey->section ) ? -1 : 1;
+  }
+  if ( ex->len != ey->len ) {
+    return ( ex->len < ey->len ) ? -1 : 1;
+  }
+  return strncmp ( ex->name, ey->name, ex->len );
+}
+
+// local helper function: index the variables in each section of the config-file.
+// Reads resolve exactly as a search through the lines would: only the first section
+// of a given name and the first definition of a variable are used, and the index
+// stops at a malformed section heading, past which no section can be found
+static int
+XLALBuildConfigFileIndex ( LALParsedDataFile *cfgdata )
+{
+  XLAL_CHECK ( cfgdata != NULL && cfgdata->lines != NULL, XLAL_EINVAL );
+  const TokenList *lines = cfgdata->lines;
+
+  struct tagLALConfigFileIndex *idx;
+  XLAL_CHECK ( (idx = XLALCalloc ( 1, sizeof(*idx) )) != NULL, XLAL_ENOMEM );
+  cfgdata->index = idx;
+  idx->malformed = -1;
+  XLAL_CHECK ( (idx->vars = XLALHashTblCreate ( NULL, ConfigIndexHash, ConfigIndexCmp )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( (idx->entries = XLALCalloc ( lines->nTokens, sizeof(idx->entries[0]) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( (idx->sections = XLALCalloc ( 1, sizeof(*idx->sections) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( (idx->invalid = XLALMalloc ( (lines->nTokens + 1) * sizeof(idx->invalid[0]) )) != NULL, XLAL_ENOMEM );
+  idx->invalid[0] = -1;
+
+  INT4 section = 0;     // current section index, or -1 if the lines of a repeated section are being skipped
+  for ( UINT4 i = 0; i < lines->nTokens; i++ )
+    {
+      const CHAR *thisLine = lines->tokens[i];
+      if ( thisLine[0] == '[' )       /* Is this the start of a new section? */
+        {
+          // lines have no trailing whitespace, so this is the syntax check of XLALGetSectionName()
+          if ( thisLine[strlen(thisLine)-1] != ']' )
+            {
+              idx->malformed = i;
+              break;
+            }
+          CHAR *secName;
+          XLAL_CHECK ( (secName = XLALGetSectionName ( thisLine )) != NULL, XLAL_EFUNC );
+          section = idx->sections->length + 1;
+          for ( UINT4 k = 0; k < idx->sections->length; k ++ )
+            {
+              if ( strcmp ( secName, idx->sections->data[k] ) == 0 )
+                {
+                  section = -1;
+                  break;
+                }
+            }
+          if ( section > 0 )
+            {
+              XLAL_CHECK ( (idx->sections = XLALAppendString2Vector ( idx->sections, secName )) != NULL, XLAL_EFUNC );
+              idx->invalid[section] = -1;
+            }
+          XLALFree ( secName );
+        } // end: if start of new section found
+      else if ( section >= 0 )
+        {
+          size_t varlen = strcspn ( thisLine, WHITESPACE "=:" );        /* get length of variable-name */
+          if ( varlen == 0 )
+            {
+              if ( idx->invalid[section] < 0 ) {
+                idx->invalid[section] = i;
+              }
+              continue;
+            }
+          ConfigIndexEntry *entry = &idx->entries[i];
+          entry->section = section;
+          entry->name = thisLine;
+          entry->len = varlen;
+          entry->line = i;
+          const void *prev = NULL;
+          XLAL_CHECK ( XLALHashTblFind ( idx->vars, entry, &prev ) == XLAL_SUCCESS, XLAL_EFUNC );
+          if ( prev == NULL )
+            {
+              XLAL_CHECK ( XLALHashTblAdd ( idx->vars, entry ) == XLAL_SUCCESS, XLAL_EFUNC );
+            }
+        } // end: if in a section to be read
+
+    } // for i < numLines
+
+  return XLAL_SUCCESS;
+
+} // XLALBuildConfigFileIndex()
+
+// local helper function: free memory associated with a config-file index
+static void
+XLALDestroyConfigFileIndex ( struct tagLALConfigFileIndex *idx )
+{
+  if ( idx == NULL ) {
+    return;
+  }
+  XLALHashTblDestroy ( idx->vars );
+  XLALFree ( idx->entries );
+  XLALDestroyStringVector ( idx->sections );
+  XLALFree ( idx->invalid );
+  XLALFree ( idx );
+} // XLALDestroyConfigFileIndex()
+
 
 /* ----------------------------------------------------------------------
  * cleanConfig(): do some preprocessing on the config-file, namely 'erase'
@@ -489,33 +616,23 @@ cleanConfig ( char *text )
     } /* while *ptr */
 
   /*----------------------------------------------------------------------
-   * RUN 2: do line-gluing when '\' is found at end-of-line
+   * RUN 2: do line-gluing when '\' is found at end-of-line, and turn all tabs
+   * into single spaces. To avoid getting spurious spaces from the line-continuation,
+   * the text is compacted in a single pass, so that each continued line nicely fits
+   * to the previous line...
    */
-  ptr = text;
-  while ( (ptr = strchr(ptr, '\\')) != NULL )
+  ptr = ptr2 = text;
+  while ( *ptr )
     {
-      if ( ptr[1] == '\n' )
+      if ( ptr[0] == '\\' && ptr[1] == '\n' )
         {
-          /* ok, now it gets a bit tricky: to avoid getting spurious spaces from
-           * the line-continuation, we shift the rest of the file forward by 2 positions
-           * to nicely fit to the previous line...
-           */
-          len = strlen (ptr+2);
-          memmove(ptr, ptr+2, len+1);   /* move the whole rest (add +1 for '\0') */
+          ptr += 2;
+          continue;
         }
-      else
-        {
-          ptr ++;
-        }
-    } /* while '\' found in text */
-
-  /*----------------------------------------------------------------------
-   * RUN 3: turn all tabs into single spaces..
-   */
-  ptr = text;
-  while ( (ptr = strchr(ptr, '\t')) != NULL ) {
-    *ptr = ' ';
-  }
+      *ptr2++ = ( (*ptr) == '\t' ) ? ' ' : (*ptr);
+      ptr ++;
+    } /* while *ptr */
+  *ptr2 = '\0';
 
   /*----------------------------------------------------------------------
    * RUN 4: get rid of initial and trailing whitespace (replace it by '\n')
@@ -107,6 +107,9 @@ extern "C" {
 typedef struct tagLALParsedDataFile {
   TokenList *lines;     /**< list of pre-parsed data-file lines */
   BOOLEAN *wasRead;     /**< keep track of successfully read lines */
+#ifndef SWIG /* exclude from SWIG interface */
+  struct tagLALConfigFileIndex *index;  /**< index of variable names, built on first read */
+#endif /* SWIG */
 } LALParsedDataFile;
 
 
@@ -22,6 +22,7 @@
 #include <stdarg.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 #include <errno.h>
 
 #ifdef HAVE_SYS_STAT_H
@@ -30,6 +31,12 @@
 #ifdef HAVE_SYS_TYPES_H
 #include <sys/types.h>
 #endif
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_UNISTD_H)
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define MMAP_ENABLED
+#endif
 
 #include <zlib.h>
 #define ZLIB_ENABLED
@@ -38,11 +45,25 @@
 #include <lal/LALStdio.h>
 #include <lal/LALString.h>
 #include <lal/StringInput.h>
+#include <lal/AVFactories.h>
 #include <lal/FileIO.h>
 
+/* values of the memory field of a LALFILE */
+#define LALFILE_STREAM 0  /* read and written through fp */
+#define LALFILE_HEAP 1    /* read from a buffer allocated with XLALMalloc() */
+#define LALFILE_MAPPED 2  /* read from a buffer mapped with mmap() */
+
+/* size of the blocks in which compressed files are read into memory */
+#define LALFILE_BLOCK_SIZE (1 << 17)
+
 struct tagLALFILE {
   int compression;
   void *fp;
+  int memory;   /* one of LALFILE_STREAM, LALFILE_HEAP, LALFILE_MAPPED */
+  char *buf;    /* in-memory file contents, if memory != LALFILE_STREAM */
+  size_t len;   /* length of buf */
+  size_t pos;   /* current read position in buf */
+  int eof;      /* set when a read reaches the end of buf */
 };
 
 LALFILE *lalstdin( void )
@@ -221,6 +242,120 @@ XLALFileLoad ( const char *path		//!< [in] input filepath
 
 } // XLALFileLoad()
 
+/** Read a table of numbers from a (possibly compressed) data-file into a REAL8Array
+ *
+ * The file is read with XLALFileOpenReadMapped() and parsed in a single pass.  Rows of the
+ * table are separated by newlines, and columns by whitespace.  Blank lines, and anything
+ * from a \c # or \c % character to the end of a line, are ignored.  Every row must have the
+ * same number of columns.  The returned array has dimensions (rows, columns), with the data
+ * stored row by row.
+ */
+REAL8Array *
+XLALFileLoadREAL8Table ( const char *path	//!< [in] input filepath
+                         )
+{
+  XLAL_CHECK_NULL ( path != NULL, XLAL_EINVAL );
+
+  LALFILE *fp;
+  XLAL_CHECK_NULL ( (fp = XLALFileOpenReadMapped (path)) != NULL, XLAL_EFUNC );
+  const char *s = fp->buf;
+  const size_t len = fp->len;
+
+  REAL8 *data = NULL;
+  size_t numData = 0, maxData = 0;
+  UINT4 numRows = 0, numCols = 0, col = 0;
+  size_t line = 1;
+
+  // the end of the data is treated as a final newline
+  for ( size_t i = 0; i <= len; )
+    {
+      const char c = i < len ? s[i] : '\n';
+      if ( c == '#' || c == '%' ) {
+        while ( i < len && s[i] != '\n' ) {
+          ++i;
+        }
+        continue;
+      }
+      if ( c == '\n' ) {
+        if ( col > 0 ) {
+          if ( numRows == 0 ) {
+            numCols = col;
+          } else if ( col != numCols ) {
+            XLALFree ( data );
+            XLALFileClose ( fp );
+            XLAL_ERROR_NULL ( XLAL_EINVAL, "Line %zu of '%s' has %u columns instead of %u\n", line, path, col, numCols );
+          }
+          ++numRows;
+          col = 0;
+        }
+        ++line;
+        ++i;
+        continue;
+      }
+      if ( isspace ( (unsigned char) c ) ) {
+        ++i;
+        continue;
+      }
+
+      // find the end of the number, and parse it in place unless it runs to the end of the data
+      size_t j = i;
+      while ( j < len && ! isspace ( (unsigned char) s[j] ) && s[j] != '#' && s[j] != '%' ) {
+        ++j;
+      }
+      char tmp[64];
+      const char *token = s + i;
+      if ( j == len ) {
+        if ( j - i >= sizeof(tmp) ) {
+          XLALFree ( data );
+          XLALFileClose ( fp );
+          XLAL_ERROR_NULL ( XLAL_EINVAL, "Invalid number on line %zu of '%s'\n", line, path );
+        }
+        memcpy ( tmp, token, j - i );
+        tmp[j - i] = 0;
+        token = tmp;
+      }
+      char *endp;
+      const REAL8 x = strtod ( token, &endp );
+      if ( endp != token + (j - i) ) {
+        XLALFree ( data );
+        XLALFileClose ( fp );
+        XLAL_ERROR_NULL ( XLAL_EINVAL, "Invalid number '%.*s' on line %zu of '%s'\n", (int)(j - i), s + i, line, path );
+      }
+
+      if ( numData == maxData ) {
+        REAL8 *newData;
+        maxData = maxData ? 2 * maxData : 1024;
+        if ( (newData = XLALRealloc ( data, maxData * sizeof(*data) )) == NULL ) {
+          XLALFree ( data );
+          XLALFileClose ( fp );
+          XLAL_ERROR_NULL ( XLAL_ENOMEM, "Failed to XLALRealloc(%zu)\n", maxData * sizeof(*data) );
+        }
+        data = newData;
+      }
+      data[numData++] = x;
+      ++col;
+      i = j;
+
+    } // for i <= len
+
+  XLALFileClose ( fp );
+  if ( numRows == 0 ) {
+    XLALFree ( data );
+    XLAL_ERROR_NULL ( XLAL_EINVAL, "'%s' contains no data\n", path );
+  }
+
+  REAL8Array *table = XLALCreateREAL8ArrayL ( 2, numRows, numCols );
+  if ( table == NULL ) {
+    XLALFree ( data );
+    XLAL_ERROR_NULL ( XLAL_EFUNC );
+  }
+  memcpy ( table->data, data, numData * sizeof(*data) );
+  XLALFree ( data );
+
+  return table;
+
+} // XLALFileLoadREAL8Table()
+
 int XLALFileIsCompressed( const char *path )
 {
   FILE *fp;
@@ -247,7 +382,7 @@ LALFILE *XLALFileOpenRead( const char *path )
     XLAL_ERROR_NULL( XLAL_EIO );
   }
 #endif
-  if ( ! ( file = XLALMalloc( sizeof(*file ) ) ) )
+  if ( ! ( file = XLALCalloc( 1, sizeof(*file ) ) ) )
     XLAL_ERROR_NULL( XLAL_ENOMEM );
   file->compression = compression;
 #ifdef ZLIB_ENABLED
@@ -262,10 +397,114 @@ LALFILE *XLALFileOpenRead( const char *path )
   return file;
 }
 
+/**
+ * \brief Open a file for reading from memory
+ *
+ * The whole of the file at \c path is made available in memory, and the returned ::LALFILE
+ * is read from there without any further system calls.  An uncompressed file is mapped
+ * into memory with \c mmap, where available, so that its pages are read in by the operating
+ * system as they are needed; a compressed file is decompressed in advance, in large blocks.
+ * This is faster than XLALFileOpenRead() for files that are read sequentially in small pieces,
+ * e.g. line-by-line with XLALFileGets().
+ *
+ * All reading routines, and XLALFileSeek() and XLALFileTell(), may be used with the returned
+ * ::LALFILE; writing to it is an error.
+ */
+LALFILE *XLALFileOpenReadMapped( const char *path )
+{
+  LALFILE *file;
+  size_t size;
+  int compression = 0;
+  XLAL_CHECK_NULL( path != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL( XLALFileIsRegularAndGetSize( path, &size ) == 1, XLAL_EINVAL, "Path '%s' does not point to a regular file", path );
+  if ( size > 0 && 0 > (compression = XLALFileIsCompressed( path ) ) )
+    XLAL_ERROR_NULL( XLAL_EIO );
+  if ( ! ( file = XLALCalloc( 1, sizeof(*file) ) ) )
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  file->memory = LALFILE_HEAP;
+  if ( size == 0 )
+    return file;
+
+  if ( compression ) {
+#ifdef ZLIB_ENABLED
+    size_t maxlen = 0;
+    gzFile gz = gzopen( path, "rb" );
+    int c;
+    if ( ! gz ) {
+      XLALFree( file );
+      XLAL_ERROR_NULL( XLAL_EIO, "Could not open '%s'", path );
+    }
+#if defined ZLIB_VER_MAJOR && ZLIB_VER_MAJOR >= 1 && ZLIB_VER_MINOR >= 2 && ZLIB_VER_REVISION >= 4
+    gzbuffer( gz, LALFILE_BLOCK_SIZE );
+#endif
+    do {
+      /* grow the buffer geometrically, starting from a guess at the decompressed size */
+      if ( file->len + LALFILE_BLOCK_SIZE > maxlen ) {
+        char *buf;
+        maxlen = maxlen ? 2 * maxlen : 4 * size + LALFILE_BLOCK_SIZE;
+        if ( ! ( buf = XLALRealloc( file->buf, maxlen ) ) ) {
+          gzclose( gz );
+          XLALFree( file->buf );
+          XLALFree( file );
+          XLAL_ERROR_NULL( XLAL_ENOMEM );
+        }
+        file->buf = buf;
+      }
+      c = gzread( gz, file->buf + file->len, maxlen - file->len < (1U << 30) ? maxlen - file->len : (1U << 30) );
+      if ( c > 0 )
+        file->len += c;
+    } while ( c > 0 );
+    gzclose( gz );
+    if ( c < 0 ) {
+      XLALFree( file->buf );
+      XLALFree( file );
+      XLAL_ERROR_NULL( XLAL_EIO, "Could not decompress '%s'", path );
+    }
+    return file;
+#else
+    XLALFree( file );
+    XLAL_ERROR_NULL( XLAL_EIO, "Cannot read compressed file" );
+#endif
+  }
+
+#ifdef MMAP_ENABLED
+  {
+    int fd = open( path, O_RDONLY );
+    if ( fd >= 0 ) {
+      void *map = mmap( NULL, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+      close( fd );
+      if ( map != MAP_FAILED ) {
+#ifdef MADV_SEQUENTIAL
+        madvise( map, size, MADV_SEQUENTIAL );
+#endif
+        file->memory = LALFILE_MAPPED;
+        file->buf = map;
+        file->len = size;
+        return file;
+      }
+    }
+  }
+#endif
+
+  /* fall back to reading the file into memory */
+  {
+    FILE *fp = LALFopen( path, "rb" );
+    if ( ! fp || ! ( file->buf = XLALMalloc( size ) ) ) {
+      if ( fp )
+        fclose( fp );
+      XLALFree( file );
+      XLAL_ERROR_NULL( fp ? XLAL_ENOMEM : XLAL_EIO );
+    }
+    file->len = fread( file->buf, 1, size, fp );
+    fclose( fp );
+  }
+  return file;
+}
+
 LALFILE *XLALFileOpenAppend( const char *path, int compression )
 {
   LALFILE *file;
-  if ( ! ( file = XLALMalloc( sizeof(*file ) ) ) )
+  if ( ! ( file = XLALCalloc( 1, sizeof(*file ) ) ) )
     XLAL_ERROR_NULL( XLAL_ENOMEM );
 #ifdef ZLIB_ENABLED
   file->fp = compression ? (void*)gzopen( path, "a+" ) : (void*)LALFopen( path, "a+" );
@@ -287,7 +526,7 @@ LALFILE *XLALFileOpenAppend( const char *path, int compression )
 LALFILE *XLALFileOpenWrite( const char *path, int compression )
 {
   LALFILE *file;
-  if ( ! ( file = XLALMalloc( sizeof(*file ) ) ) )
+  if ( ! ( file = XLALCalloc( 1, sizeof(*file ) ) ) )
     XLAL_ERROR_NULL( XLAL_ENOMEM );
 #ifdef ZLIB_ENABLED
   file->fp = compression ? (void*)gzopen( path, "wb" ) : (void*)LALFopen( path, "wb" );
@@ -331,6 +570,16 @@ int XLALFileClose( LALFILE *file )
   /* this behavior is different from BSD fclose */
   if ( file ) {
     int c;
+    if ( file->memory != LALFILE_STREAM ) {
+#ifdef MMAP_ENABLED
+      if ( file->memory == LALFILE_MAPPED )
+        munmap( file->buf, file->len );
+      else
+#endif
+        XLALFree( file->buf );
+      XLALFree( file );
+      return 0;
+    }
     if ( ! file->fp )
       XLAL_ERROR( XLAL_EINVAL );
 #ifdef ZLIB_ENABLED
@@ -350,6 +599,16 @@ size_t XLALFileRead( void *ptr, size_t size, size_t nobj, LALFILE *file )
   size_t c;
   if ( ! file )
     XLAL_ERROR( XLAL_EFAULT );
+  if ( file->memory != LALFILE_STREAM ) {
+    c = size ? (file->len - file->pos) / size : 0;
+    if ( c < nobj )
+      file->eof = 1;
+    else
+      c = nobj;
+    memcpy( ptr, file->buf + file->pos, c * size );
+    file->pos += c * size;
+    return c;
+  }
 #ifdef ZLIB_ENABLED
   c = file->compression ? (size_t)gzread( ((gzFile)file->fp), ptr, size * nobj ) : fread( ptr, size, nobj, ((FILE*)file->fp) );
 #else
@@ -365,6 +624,8 @@ size_t XLALFileWrite( const void *ptr, size_t size, size_t nobj, LALFILE *file )
   size_t c;
   if ( ! file )
     XLAL_ERROR( XLAL_EFAULT );
+  if ( file->memory != LALFILE_STREAM )
+    XLAL_ERROR( XLAL_EINVAL, "Cannot write to a file opened with XLALFileOpenReadMapped()" );
 #ifdef ZLIB_ENABLED
   c = file->compression ? (size_t)gzwrite( ((gzFile)file->fp), ptr, size * nobj ) : fwrite( ptr, size, nobj, ((FILE*)file->fp) );
 #else
@@ -380,6 +641,12 @@ int XLALFileGetc( LALFILE *file )
   int c;
   if ( ! file )
     XLAL_ERROR( XLAL_EFAULT );
+  if ( file->memory != LALFILE_STREAM ) {
+    if ( file->pos < file->len )
+      return (unsigned char) file->buf[file->pos++];
+    file->eof = 1;
+    return EOF;
+  }
 #ifdef ZLIB_ENABLED
   c = file->compression ? gzgetc(((gzFile)file->fp)) : fgetc(((FILE*)file->fp));
 #else
@@ -393,6 +660,8 @@ int XLALFilePutc( int c, LALFILE *file )
   int result;
   if ( ! file )
     XLAL_ERROR( XLAL_EFAULT );
+  if ( file->memory != LALFILE_STREAM )
+    XLAL_ERROR( XLAL_EINVAL, "Cannot write to a file opened with XLALFileOpenReadMapped()" );
 #ifdef ZLIB_ENABLED
   result = file->compression ? gzputc(((gzFile)file->fp), c) : fputc(c, ((FILE*)file->fp));
 #else
@@ -408,6 +677,25 @@ char * XLALFileGets( char * s, int size, LALFILE *file )
   char *c;
   if ( ! file )
     XLAL_ERROR_NULL( XLAL_EFAULT );
+  if ( file->memory != LALFILE_STREAM ) {
+    /* copy up to and including the next newline, as fgets() does */
+    size_t n = file->len - file->pos;
+    const char *nl;
+    if ( size <= 0 )
+      return NULL;
+    if ( n == 0 ) {
+      file->eof = 1;
+      return NULL;
+    }
+    if ( n > (size_t)size - 1 )
+      n = size - 1;
+    if ( ( nl = memchr( file->buf + file->pos, '\n', n ) ) )
+      n = nl - ( file->buf + file->pos ) + 1;
+    memcpy( s, file->buf + file->pos, n );
+    s[n] = 0;
+    file->pos += n;
+    return s;
+  }
 #ifdef ZLIB_ENABLED
   c = file->compression ? gzgets( ((gzFile)file->fp), s, size ) : fgets( s, size, ((FILE*)file->fp) );
 #else
@@ -469,6 +757,8 @@ int XLALFileFlush( LALFILE *file )
   int c;
   if ( ! file )
     XLAL_ERROR( XLAL_EFAULT );
+  if ( file->memory != LALFILE_STREAM )
+    return 0;
 #ifdef ZLIB_ENABLED
   c = file->compression ? gzflush(((gzFile)file->fp), Z_FULL_FLUSH) : fflush(((FILE*)file->fp));
 #else
@@ -484,6 +774,17 @@ int XLALFileSeek( LALFILE *file, long offset, int whence )
   int c;
   if ( ! file )
     XLAL_ERROR( XLAL_EFAULT );
+  if ( file->memory != LALFILE_STREAM ) {
+    long base = whence == SEEK_SET ? 0 : whence == SEEK_CUR ? (long)file->pos : (long)file->len;
+    if ( whence != SEEK_SET && whence != SEEK_CUR && whence != SEEK_END )
+      XLAL_ERROR( XLAL_EINVAL );
+    if ( base + offset < 0 )
+      XLAL_ERROR( XLAL_EIO );
+    /* as with fseek(), seeking beyond the end is allowed, and reads there hit end-of-file */
+    file->pos = (size_t)(base + offset) < file->len ? (size_t)(base + offset) : file->len;
+    file->eof = 0;
+    return 0;
+  }
 #ifdef ZLIB_ENABLED
   if ( file->compression && whence == SEEK_END ) {
     XLALPrintError( "XLAL Error - %s: SEEK_END not supported with compressed files\n", __func__ );
@@ -503,6 +804,8 @@ long XLALFileTell( LALFILE *file )
   long c;
   if ( ! file )
     XLAL_ERROR( XLAL_EFAULT );
+  if ( file->memory != LALFILE_STREAM )
+    return (long)file->pos;
 #ifdef ZLIB_ENABLED
   c = file->compression ? (long)gztell(((gzFile)file->fp)) : ftell(((FILE*)file->fp));
 #else
@@ -517,6 +820,11 @@ void XLALFileRewind( LALFILE *file )
 {
   if ( ! file )
     XLAL_ERROR_VOID( XLAL_EFAULT );
+  if ( file->memory != LALFILE_STREAM ) {
+    file->pos = 0;
+    file->eof = 0;
+    return;
+  }
 #ifdef ZLIB_ENABLED
   file->compression ? (void)gzrewind(((gzFile)file->fp)) : rewind(((FILE*)file->fp));
 #else
@@ -533,12 +841,16 @@ void XLALFileRewind( LALFILE *file )
  *
  * For a compressed file the buffering will be set with \c gzbuffer. The \c buf and \c mode inputs are ignored and a
  * buffer of \c size is set.
+ *
+ * For a file opened with XLALFileOpenReadMapped() this routine does nothing.
  */
 int XLALFileSetBuffer( LALFILE *file, char *buf, int mode, size_t size )
 {
   int c = 0;
   if ( ! file )
     XLAL_ERROR( XLAL_EFAULT );
+  if ( file->memory != LALFILE_STREAM )
+    return 0;
 #ifdef ZLIB_ENABLED
   if ( !file->compression ){
     c = setvbuf(((FILE*)file->fp), buf, mode, size);
@@ -564,6 +876,8 @@ int XLALFileEOF( LALFILE *file )
   int c;
   if ( ! file )
     XLAL_ERROR( XLAL_EFAULT );
+  if ( file->memory != LALFILE_STREAM )
+    return file->eof;
 #ifdef ZLIB_ENABLED
   c = file->compression ? gzeof(((gzFile)file->fp)) : feof((FILE*)(file->fp));
 #else
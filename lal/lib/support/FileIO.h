@@ -27,6 +27,7 @@ extern "C" {
 #include <stdio.h>
 #include <stdarg.h>
 #include <lal/LALStdio.h>
+#include <lal/LALDatatypes.h>
 
 /**
  * \defgroup FileIO_h Header FileIO.h
@@ -56,6 +57,7 @@ LALFILE *lalstderr(void);
 
 int XLALFileIsCompressed( const char *path );
 LALFILE *XLALFileOpenRead( const char *path );
+LALFILE *XLALFileOpenReadMapped( const char *path );
 LALFILE *XLALFileOpenWrite( const char *path, int compression );
 LALFILE *XLALFileOpenAppend( const char *path, int compression );
 LALFILE *XLALFileOpen( const char *path, const char *mode );
@@ -85,6 +87,7 @@ char *XLALFileResolvePathLong ( const char *fname, const char *fallbackdir );
 char *XLALFileResolvePath( const char *fname );
 
 char *XLALFileLoad ( const char *path );
+REAL8Array *XLALFileLoadREAL8Table ( const char *path );
 
 int XLALGzipTextFile( const char *path );
 int XLALGunzipTextFile( const char *filename );
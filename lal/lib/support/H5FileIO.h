@@ -133,7 +133,9 @@ void XLALH5DatasetFree(LALH5Dataset *dset);
 
 LALH5Dataset * XLALH5DatasetAlloc(LALH5File *file, const char *name, LALTYPECODE dtype, UINT4Vector *dimLength);
 LALH5Dataset * XLALH5DatasetAlloc1D(LALH5File *file, const char *name, LALTYPECODE dtype, size_t length);
+LALH5Dataset * XLALH5DatasetAllocChunked(LALH5File *file, const char *name, LALTYPECODE dtype, UINT4Vector *dimLength, UINT4Vector *chunkLength, int compression);
 int XLALH5DatasetWrite(LALH5Dataset *dset, void *data);
+int XLALH5DatasetWriteSlice(LALH5Dataset *dset, void *data, UINT4Vector *start, UINT4Vector *count);
 
 /* these routines are deprecated */
 int XLALH5FileGetDatasetNames(LALH5File *file, char *** names, UINT4 *N);
@@ -155,6 +157,7 @@ LALTYPECODE XLALH5DatasetQueryType(LALH5Dataset *dset);
 int XLALH5DatasetQueryNDim(LALH5Dataset *dset);
 UINT4Vector * XLALH5DatasetQueryDims(LALH5Dataset *dset);
 int XLALH5DatasetQueryData(void *data, LALH5Dataset *dset);
+int XLALH5DatasetQueryDataSlice(void *data, LALH5Dataset *dset, UINT4Vector *start, UINT4Vector *count);
 
 /* these routines are deprecated */
 int XLALH5DatasetAddScalarAttribute(LALH5Dataset *dset, const char *key, const void *value, LALTYPECODE dtype);
@@ -8,6 +8,9 @@
 #include <stdio.h>
 #include <string.h>
 #include <limits.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
 #include <lal/LALStdio.h>
 #include <lal/LALStdlib.h>
 #include <lal/LALString.h>
@@ -31,6 +34,7 @@
 
 #define LAL_H5_FILE_MODE_READ  H5F_ACC_RDONLY
 #define LAL_H5_FILE_MODE_WRITE H5F_ACC_TRUNC
+#define LAL_H5_FILE_MODE_APPEND H5F_ACC_RDWR
 
 struct tagLALH5Object {
 	hid_t object_id; /* this object's id must be first */
@@ -299,6 +303,128 @@ static LALTYPECODE XLALTypeFromH5Type(hid_t dtype_id)
 	return dtype;
 }
 
+/* target size in bytes of automatically-chosen dataset chunks */
+#define LAL_H5_DEFAULT_CHUNK_BYTES (1 << 20)
+
+/*
+ * creates a dataset creation property list for a chunked dataset with
+ * given dimensions, using chunk dimensions chunkLength if non-NULL, or
+ * else chunks of about LAL_H5_DEFAULT_CHUNK_BYTES made by halving the
+ * slowest-varying dimensions; compression is a deflate level 0-9, with 0
+ * meaning no compression; use H5Pclose() to free
+ */
+static hid_t XLALH5DatasetCreationPlist(hid_t dtype_id, int rank, const hsize_t *dims, const UINT4Vector *chunkLength, int compression)
+{
+	hsize_t *chunk;
+	hid_t dcpl_id;
+	size_t nbytes;
+	int dim;
+
+	if (chunkLength && (int)chunkLength->length != rank)
+		XLAL_ERROR(XLAL_EBADLEN, "Chunk has rank %u but dataset has rank %d", chunkLength->length, rank);
+	if (compression < 0 || compression > 9)
+		XLAL_ERROR(XLAL_EINVAL, "Compression level %d must be between 0 and 9", compression);
+
+	chunk = LALCalloc(rank, sizeof(*chunk));
+	if (!chunk)
+		XLAL_ERROR(XLAL_ENOMEM);
+	nbytes = threadsafe_H5Tget_size(dtype_id);
+	for (dim = 0; dim < rank; ++dim) {
+		if (chunkLength) {
+			if (chunkLength->data[dim] == 0 || chunkLength->data[dim] > dims[dim]) {
+				LALFree(chunk);
+				XLAL_ERROR(XLAL_EINVAL, "Chunk dimension %d must be between 1 and %llu", dim, (unsigned long long)dims[dim]);
+			}
+			chunk[dim] = chunkLength->data[dim];
+		} else
+			chunk[dim] = dims[dim] ? dims[dim] : 1;
+		nbytes *= chunk[dim];
+	}
+	for (dim = 0; !chunkLength && dim < rank; ++dim)
+		while (nbytes > LAL_H5_DEFAULT_CHUNK_BYTES && chunk[dim] > 1) {
+			nbytes /= chunk[dim];
+			chunk[dim] = (chunk[dim] + 1) / 2;
+			nbytes *= chunk[dim];
+		}
+
+	dcpl_id = threadsafe_H5Pcreate(H5P_DATASET_CREATE);
+	if (dcpl_id < 0 || threadsafe_H5Pset_chunk(dcpl_id, rank, chunk) < 0) {
+		if (dcpl_id >= 0)
+			threadsafe_H5Pclose(dcpl_id);
+		LALFree(chunk);
+		XLAL_ERROR(XLAL_EIO, "Could not set dataset chunks");
+	}
+	LALFree(chunk);
+
+	if (compression > 0) {
+		if (threadsafe_H5Zfilter_avail(H5Z_FILTER_DEFLATE) <= 0)
+			XLAL_PRINT_WARNING("Deflate filter unavailable: dataset will not be compressed");
+		else if (threadsafe_H5Pset_shuffle(dcpl_id) < 0 || threadsafe_H5Pset_deflate(dcpl_id, compression) < 0) {
+			threadsafe_H5Pclose(dcpl_id);
+			XLAL_ERROR(XLAL_EIO, "Could not set dataset compression");
+		}
+	}
+
+	return dcpl_id;
+}
+
+/*
+ * selects the hyperslab of dset with offset start and dimensions count;
+ * returns a copy of the dataset's dataspace with the hyperslab selected,
+ * and a dataspace for the contiguous memory buffer in *mem_space_id;
+ * use H5Sclose() to free both
+ */
+static hid_t XLALH5DatasetSelectSlice(hid_t *mem_space_id, const LALH5Dataset *dset, const UINT4Vector *start, const UINT4Vector *count)
+{
+	hsize_t *dims;
+	hsize_t *offset;
+	hsize_t *extent;
+	hid_t space_id;
+	int rank;
+	int dim;
+
+	rank = threadsafe_H5Sget_simple_extent_ndims(dset->space_id);
+	if (rank < 0)
+		XLAL_ERROR(XLAL_EIO, "Could not read rank of dataset");
+	if ((int)start->length != rank || (int)count->length != rank)
+		XLAL_ERROR(XLAL_EBADLEN, "Slice must have the rank %d of the dataset", rank);
+
+	dims = LALCalloc(3 * (rank ? rank : 1), sizeof(*dims));
+	if (!dims)
+		XLAL_ERROR(XLAL_ENOMEM);
+	offset = dims + rank;
+	extent = offset + rank;
+	if (threadsafe_H5Sget_simple_extent_dims(dset->space_id, dims, NULL) < 0) {
+		LALFree(dims);
+		XLAL_ERROR(XLAL_EIO, "Could not read dimensions of dataspace");
+	}
+	for (dim = 0; dim < rank; ++dim) {
+		offset[dim] = start->data[dim];
+		extent[dim] = count->data[dim];
+		if (offset[dim] + extent[dim] > dims[dim]) {
+			LALFree(dims);
+			XLAL_ERROR(XLAL_EINVAL, "Slice exceeds dimension %d of dataset", dim);
+		}
+	}
+
+	/* work on a copy so concurrent slices of a dataset do not interfere */
+	space_id = threadsafe_H5Scopy(dset->space_id);
+	if (space_id < 0 || threadsafe_H5Sselect_hyperslab(space_id, H5S_SELECT_SET, offset, NULL, extent, NULL) < 0) {
+		if (space_id >= 0)
+			threadsafe_H5Sclose(space_id);
+		LALFree(dims);
+		XLAL_ERROR(XLAL_EIO, "Could not select slice of dataset");
+	}
+	*mem_space_id = threadsafe_H5Screate_simple(rank, extent, NULL);
+	LALFree(dims);
+	if (*mem_space_id < 0) {
+		threadsafe_H5Sclose(space_id);
+		XLAL_ERROR(XLAL_EIO, "Could not create dataspace for slice");
+	}
+
+	return space_id;
+}
+
 /* creates a HDF5 file for writing */
 static LALH5File * XLALH5FileCreate(const char *path)
 {
@@ -335,6 +461,26 @@ static LALH5File * XLALH5FileOpenRead(const char *path)
 	return file;
 }
 
+/* opens a HDF5 file for appending in place, creating it if necessary */
+static LALH5File * XLALH5FileOpenAppend(const char *path)
+{
+	LALH5File *file;
+	file = LALCalloc(1, sizeof(*file));
+	if (!file)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	XLALStringCopy(file->fname, path, sizeof(file->fname));
+	if (access(path, F_OK) == 0)
+		file->file_id = threadsafe_H5Fopen(path, H5F_ACC_RDWR, H5P_DEFAULT);
+	else
+		file->file_id = threadsafe_H5Fcreate(path, H5F_ACC_EXCL, H5P_DEFAULT, H5P_DEFAULT);
+	if (file->file_id < 0) {
+		LALFree(file);
+		XLAL_ERROR_NULL(XLAL_EIO, "Could not open HDF5 file `%s' for appending", path);
+	}
+	file->mode = LAL_H5_FILE_MODE_APPEND;
+	return file;
+}
+
 #if 0
 static hid_t XLALGetObjectIdentifier(const void *ptr)
 {
@@ -424,14 +570,18 @@ void XLALH5FileClose(LALH5File UNUSED *file)
  * <dl>
  * <dt>r</dt><dd>Open file for reading.</dd>
  * <dt>w</dt><dd>Truncate to zero length or create file for writing.</dd>
+ * <dt>a</dt><dd>Open file for reading and writing in place, creating it if
+ * it does not exist.</dd>
  * </dl>
  *
  * If a file is opened for writing then data is initially written to a
  * temporary file, and this file is renamed once the ::LALH5File structure
- * is closed with XLALH5FileClose().
+ * is closed with XLALH5FileClose().  A file opened for appending is
+ * modified directly, so that data can be added to existing groups and
+ * tables without rewriting the file.
  *
  * @param path Pointer to a string containing the path of the file to open.
- * @param mode Mode to open the file, either "r" or "w".
+ * @param mode Mode to open the file, either "r", "w" or "a".
  * @returns A pointer to a ::LALH5File structure associated with the
  * specified HDF5 file.
  * @retval NULL An error occurred opening the file.
@@ -447,7 +597,9 @@ LALH5File * XLALH5FileOpen(const char UNUSED *path, const char UNUSED *mode)
 		return XLALH5FileOpenRead(path);
 	else if (strcmp(mode, "w") == 0)
 		return XLALH5FileCreate(path);
-	XLAL_ERROR_NULL(XLAL_EINVAL, "Invalid mode \"%s\": must be either \"r\" or \"w\"", mode);
+	else if (strcmp(mode, "a") == 0)
+		return XLALH5FileOpenAppend(path);
+	XLAL_ERROR_NULL(XLAL_EINVAL, "Invalid mode \"%s\": must be either \"r\", \"w\" or \"a\"", mode);
 #endif
 }
 
@@ -458,7 +610,8 @@ LALH5File * XLALH5FileOpen(const char UNUSED *path, const char UNUSED *mode)
  * associated with the ::LALH5File @p file.  If the HDF5 file is
  * being read, the specified group must exist in that file.  If
  * the HDF5 file is being written, the specified group is created
- * within the file.
+ * within the file.  If the HDF5 file is being appended to, the
+ * specified group is opened if it exists and created otherwise.
  *
  * @param file Pointer to a ::LALH5File structure in which to open the group.
  * @param name Pointer to a string with the name of the group to open.
@@ -481,9 +634,10 @@ LALH5File * XLALH5GroupOpen(LALH5File UNUSED *file, const char UNUSED *name)
 	group->mode = file->mode;
 	if (!name) /* this is the same as the file */
 		group->file_id = file->file_id;
-	else if (group->mode == LAL_H5_FILE_MODE_READ)
+	else if (group->mode == LAL_H5_FILE_MODE_READ
+	         || (group->mode == LAL_H5_FILE_MODE_APPEND && XLALH5FileCheckGroupExists(file, name)))
 		group->file_id = threadsafe_H5Gopen2(file->file_id, name, H5P_DEFAULT);
-	else if (group->mode == LAL_H5_FILE_MODE_WRITE) {
+	else if (group->mode == LAL_H5_FILE_MODE_WRITE || group->mode == LAL_H5_FILE_MODE_APPEND) {
 		hid_t gcpl; /* property list to allow intermediate groups to be created */
 		gcpl = threadsafe_H5Pcreate(H5P_LINK_CREATE);
 		if (gcpl < 0 || threadsafe_H5Pset_create_intermediate_group(gcpl, 1) < 0) {
@@ -524,7 +678,12 @@ int XLALH5FileCheckGroupExists(const LALH5File UNUSED *file, const char UNUSED *
     if (file == NULL || name == NULL)
         XLAL_ERROR_VAL(0, XLAL_EFAULT);
     H5G_info_t info;
-    if (threadsafe_H5Gget_info_by_name(file->file_id, name, &info, H5P_DEFAULT) < 0)
+    herr_t status;
+    /* a missing group is not an error, so do not print the HDF5 error stack */
+    H5E_BEGIN_TRY {
+        status = threadsafe_H5Gget_info_by_name(file->file_id, name, &info, H5P_DEFAULT);
+    } H5E_END_TRY;
+    if (status < 0)
         return 0;
     return 1;
 #endif
@@ -959,7 +1118,7 @@ LALH5Dataset * XLALH5DatasetAlloc(LALH5File UNUSED *file, const char UNUSED *nam
 
 	if (name == NULL || file == NULL || dimLength == NULL)
 		XLAL_ERROR_NULL(XLAL_EFAULT);
-	if (file->mode != LAL_H5_FILE_MODE_WRITE)
+	if (file->mode == LAL_H5_FILE_MODE_READ)
 		XLAL_ERROR_NULL(XLAL_EINVAL, "Attempting to write to a read-only HDF5 file");
 
 	namelen = strlen(name);
@@ -1042,7 +1201,7 @@ LALH5Dataset * XLALH5DatasetAlloc1D(LALH5File UNUSED *file, const char UNUSED *n
 
 	if (name == NULL || file == NULL)
 		XLAL_ERROR_NULL(XLAL_EFAULT);
-	if (file->mode != LAL_H5_FILE_MODE_WRITE)
+	if (file->mode == LAL_H5_FILE_MODE_READ)
 		XLAL_ERROR_NULL(XLAL_EINVAL, "Attempting to write to a read-only HDF5 file");
 
 	namelen = strlen(name);
@@ -1082,6 +1241,110 @@ LALH5Dataset * XLALH5DatasetAlloc1D(LALH5File UNUSED *file, const char UNUSED *n
 #endif
 }
 
+/**
+ * @brief Allocates a chunked and optionally compressed ::LALH5Dataset
+ * @details
+ * Creates a new HDF5 dataset as XLALH5DatasetAlloc() does, but with the
+ * data stored in chunks, which allows compression and efficient
+ * reads and writes of slices of the dataset (see XLALH5DatasetWriteSlice()
+ * and XLALH5DatasetQueryDataSlice()).
+ *
+ * The chunk dimensions are given by the UINT4Vector @p chunkLength, of
+ * the same rank as @p dimLength.  If @p chunkLength is NULL, chunks of
+ * about 1 MiB are chosen by dividing the slowest-varying dimensions.
+ * The data is compressed with the deflate filter (after byte shuffling) at
+ * level @p compression, from 1 (fastest) to 9 (smallest); a level of 0
+ * means no compression.
+ *
+ * @param file Pointer to a ::LALH5File structure in which to create the dataset.
+ * @param name Pointer to a string with the name of the dataset to create.
+ * @param dtype \c LALTYPECODE value specifying the data type.
+ * @param dimLength Pointer to a UINT4Vector specifying the dataspace
+ * dimensions.
+ * @param chunkLength Pointer to a UINT4Vector specifying the chunk
+ * dimensions, or NULL.
+ * @param compression Deflate compression level, from 0 to 9.
+ * @returns A pointer to a ::LALH5Dataset structure associated with the
+ * specified dataset within a HDF5 file.
+ * @retval NULL An error occurred creating the dataset.
+ */
+LALH5Dataset * XLALH5DatasetAllocChunked(LALH5File UNUSED *file, const char UNUSED *name, LALTYPECODE UNUSED dtype, UINT4Vector UNUSED *dimLength, UINT4Vector UNUSED *chunkLength, int UNUSED compression)
+{
+#ifndef HAVE_HDF5
+	XLAL_ERROR_NULL(XLAL_EFAILED, "HDF5 support not implemented");
+#else
+	LALH5Dataset *dset;
+	hsize_t *dims;
+	hid_t dcpl_id;
+	UINT4 dim;
+	size_t namelen;
+
+	if (name == NULL || file == NULL || dimLength == NULL)
+		XLAL_ERROR_NULL(XLAL_EFAULT);
+	if (file->mode == LAL_H5_FILE_MODE_READ)
+		XLAL_ERROR_NULL(XLAL_EINVAL, "Attempting to write to a read-only HDF5 file");
+	if (dimLength->length == 0)
+		XLAL_ERROR_NULL(XLAL_EINVAL, "Chunked dataset `%s' must have at least one dimension", name);
+
+	namelen = strlen(name);
+	dset = LALCalloc(1, sizeof(*dset) + namelen + 1);  /* use flexible array member to record name */
+	if (!dset)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+
+	/* create datatype */
+	dset->dtype_id = XLALH5TypeFromLALType(dtype);
+	if (dset->dtype_id < 0) {
+		LALFree(dset);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
+
+	/* copy dimensions to HDF5 type */
+	dims = LALCalloc(dimLength->length, sizeof(*dims));
+	if (!dims) {
+		threadsafe_H5Tclose(dset->dtype_id);
+		LALFree(dset);
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	}
+	for (dim = 0; dim < dimLength->length; ++dim)
+		dims[dim] = dimLength->data[dim];
+
+	/* create chunking and compression properties */
+	dcpl_id = XLALH5DatasetCreationPlist(dset->dtype_id, dimLength->length, dims, chunkLength, compression);
+	if (dcpl_id < 0) {
+		LALFree(dims);
+		threadsafe_H5Tclose(dset->dtype_id);
+		LALFree(dset);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
+
+	/* create dataspace */
+	dset->space_id = threadsafe_H5Screate_simple(dimLength->length, dims, NULL);
+	LALFree(dims);
+	if (dset->space_id < 0) {
+		threadsafe_H5Pclose(dcpl_id);
+		threadsafe_H5Tclose(dset->dtype_id);
+		LALFree(dset);
+		XLAL_ERROR_NULL(XLAL_EIO, "Could not create dataspace for dataset `%s'", name);
+	}
+
+	/* create dataset */
+	dset->dataset_id = threadsafe_H5Dcreate2(file->file_id, name, dset->dtype_id, dset->space_id, H5P_DEFAULT, dcpl_id, H5P_DEFAULT);
+	threadsafe_H5Pclose(dcpl_id);
+	if (dset->dataset_id < 0) {
+		threadsafe_H5Tclose(dset->dtype_id);
+		threadsafe_H5Sclose(dset->space_id);
+		LALFree(dset);
+		XLAL_ERROR_NULL(XLAL_EIO, "Could not create dataset `%s'", name);
+	}
+
+	/* record name of dataset and parent id */
+	snprintf(dset->name, namelen + 1, "%s", name);
+	dset->parent_id = file->file_id;
+
+	return dset;
+#endif
+}
+
 /**
  * @brief Writes data to a ::LALH5Dataset
  * @details
@@ -1105,6 +1368,45 @@ int XLALH5DatasetWrite(LALH5Dataset UNUSED *dset, void UNUSED *data)
 #endif
 }
 
+/**
+ * @brief Writes data to a slice of a ::LALH5Dataset
+ * @details
+ * Writes the data contained in @p data to the hyperslab of the HDF5
+ * dataset associated with the ::LALH5Dataset @p dset that starts at
+ * the indices @p start and has the dimensions @p count.  The buffer
+ * @p data holds the slice contiguously, in row-major order.  Different
+ * slices of a dataset can be written in any order, e.g. by different
+ * workers each producing part of the data.
+ * @param dset Pointer to a ::LALH5Dataset structure to which to write the data.
+ * @param data Pointer to the data buffer to be written.
+ * @param start Pointer to a UINT4Vector with the starting index of the
+ * slice in each dimension.
+ * @param count Pointer to a UINT4Vector with the dimensions of the slice.
+ * @retval 0 Success.
+ * @retval -1 Failure.
+ */
+int XLALH5DatasetWriteSlice(LALH5Dataset UNUSED *dset, void UNUSED *data, UINT4Vector UNUSED *start, UINT4Vector UNUSED *count)
+{
+#ifndef HAVE_HDF5
+	XLAL_ERROR(XLAL_EFAILED, "HDF5 support not implemented");
+#else
+	hid_t mem_space_id;
+	hid_t space_id;
+	herr_t status;
+	if (dset == NULL || data == NULL || start == NULL || count == NULL)
+		XLAL_ERROR(XLAL_EFAULT);
+	space_id = XLALH5DatasetSelectSlice(&mem_space_id, dset, start, count);
+	if (space_id < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	status = threadsafe_H5Dwrite(dset->dataset_id, dset->dtype_id, mem_space_id, space_id, H5P_DEFAULT, data);
+	threadsafe_H5Sclose(mem_space_id);
+	threadsafe_H5Sclose(space_id);
+	if (status < 0)
+		XLAL_ERROR(XLAL_EIO, "Could not write data to slice of dataset");
+	return 0;
+#endif
+}
+
 /**
  * @brief Reads a ::LALH5Dataset
  * @details
@@ -1132,7 +1434,7 @@ LALH5Dataset * XLALH5DatasetRead(LALH5File UNUSED *file, const char UNUSED *name
 	size_t namelen;
 	if (name == NULL || file == NULL)
 		XLAL_ERROR_NULL(XLAL_EFAULT);
-	if (file->mode != LAL_H5_FILE_MODE_READ)
+	if (file->mode == LAL_H5_FILE_MODE_WRITE)
 		XLAL_ERROR_NULL(XLAL_EINVAL, "Attempting to read a write-only HDF5 file");
 
 	namelen = strlen(name);
@@ -1341,6 +1643,45 @@ int XLALH5DatasetQueryData(void UNUSED *data, LALH5Dataset UNUSED *dset)
 #endif
 }
 
+/**
+ * @brief Gets the data contained in a slice of a ::LALH5Dataset
+ * @details
+ * This routine reads the hyperslab of the HDF5 dataset associated with
+ * the ::LALH5Dataset @p dset that starts at the indices @p start and has
+ * the dimensions @p count, and stores it contiguously, in row-major
+ * order, in the buffer @p data.  This buffer should be large enough to
+ * hold the product of the elements of @p count data points.  Only the
+ * chunks of the dataset that overlap the slice are read.
+ * @param data Pointer to a memory in which to store the data.
+ * @param dset Pointer to a ::LALH5Dataset from which to extract the data.
+ * @param start Pointer to a UINT4Vector with the starting index of the
+ * slice in each dimension.
+ * @param count Pointer to a UINT4Vector with the dimensions of the slice.
+ * @retval 0 Success.
+ * @retval -1 Failure.
+ */
+int XLALH5DatasetQueryDataSlice(void UNUSED *data, LALH5Dataset UNUSED *dset, UINT4Vector UNUSED *start, UINT4Vector UNUSED *count)
+{
+#ifndef HAVE_HDF5
+	XLAL_ERROR(XLAL_EFAILED, "HDF5 support not implemented");
+#else
+	hid_t mem_space_id;
+	hid_t space_id;
+	herr_t status;
+	if (data == NULL || dset == NULL || start == NULL || count == NULL)
+		XLAL_ERROR(XLAL_EFAULT);
+	space_id = XLALH5DatasetSelectSlice(&mem_space_id, dset, start, count);
+	if (space_id < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	status = threadsafe_H5Dread(dset->dataset_id, dset->dtype_id, mem_space_id, space_id, H5P_DEFAULT, data);
+	threadsafe_H5Sclose(mem_space_id);
+	threadsafe_H5Sclose(space_id);
+	if (status < 0)
+		XLAL_ERROR(XLAL_EIO, "Could not read slice of dataset");
+	return 0;
+#endif
+}
+
 /** @} */
 
 /**
@@ -3103,7 +3444,7 @@ LALH5Dataset * XLALH5TableAlloc(LALH5File UNUSED *file, const char UNUSED *name,
 	if (file == NULL || cols == NULL || types == NULL || offsets == NULL)
 		XLAL_ERROR_NULL(XLAL_EFAULT);
 
-	if (file->mode != LAL_H5_FILE_MODE_WRITE)
+	if (file->mode == LAL_H5_FILE_MODE_READ)
 		XLAL_ERROR_NULL(XLAL_EINVAL, "Attempting to write to a read-only HDF5 file");
 
 	/* map the LAL types to HDF5 types */
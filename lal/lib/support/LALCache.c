@@ -72,21 +72,6 @@ static int XLALCacheFileReadRow(char *s, size_t len, LALFILE * fp,
     return 1;   /* continue code */
 }
 
-/* counts the rows of the file */
-static int XLALCacheFileCountRows(LALFILE * fp)
-{
-    char s[PATH_MAX + 4 * (NAME_MAX + 1)];
-    int line = 0;
-    int n = 0;
-    int c;
-    while ((c = XLALCacheFileReadRow(s, sizeof(s), fp, &line)))
-        if (c < 0)
-            return -1;
-        else
-            ++n;
-    return n;
-}
-
 /* kind of like strtok -- modifies buffer */
 static char *XLALCacheFileNextField(char **ps)
 {
@@ -226,25 +211,47 @@ LALCache *XLALCacheFileRead(LALFILE * fp)
 {
     LALCache *cache;
     char s[PATH_MAX + 4*(NAME_MAX + 1)];
+    UINT4 size = 0;
     int line = 0;
-    int n;
-    int i;
+    int c;
     if (!fp)
         XLAL_ERROR_NULL(XLAL_EFAULT);
-    n = XLALCacheFileCountRows(fp);
-    if (n < 0)
-        XLAL_ERROR_NULL(XLAL_EFUNC);
-    XLALFileRewind(fp);
-    cache = XLALCreateCache(n);
+    cache = XLALCalloc(1, sizeof(*cache));
     if (!cache)
-        XLAL_ERROR_NULL(XLAL_EFUNC);
-    for (i = 0; i < n; ++i)
-        if (XLALCacheFileReadRow(s, sizeof(s), fp, &line) != 1
-            || XLALCacheFileParseEntry(&cache->list[i], s) < 0) {
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    /* read the file in a single pass, growing the entry list
+     * geometrically, rather than counting the rows first and rewinding:
+     * compressed caches would otherwise be decompressed twice */
+    while ((c = XLALCacheFileReadRow(s, sizeof(s), fp, &line))) {
+        if (c < 0) {
             XLALDestroyCache(cache);
-            XLAL_ERROR_NULL(XLAL_EFUNC, "Error reading row %i on line %i",
-                            i + 1, line);
+            XLAL_ERROR_NULL(XLAL_EFUNC);
         }
+        if (cache->length == size) {
+            LALCacheEntry *list;
+            size = size ? 2 * size : 1024;
+            list = XLALRealloc(cache->list, size * sizeof(*list));
+            if (!list) {
+                XLALDestroyCache(cache);
+                XLAL_ERROR_NULL(XLAL_ENOMEM);
+            }
+            cache->list = list;
+        }
+        memset(&cache->list[cache->length], 0, sizeof(*cache->list));
+        if (XLALCacheFileParseEntry(&cache->list[cache->length++], s) < 0) {
+            UINT4 row = cache->length;
+            XLALDestroyCache(cache);
+            XLAL_ERROR_NULL(XLAL_EFUNC, "Error reading row %u on line %i",
+                            row, line);
+        }
+    }
+    if (!cache->length) {
+        XLALFree(cache->list);
+        cache->list = NULL;
+        XLAL_PRINT_WARNING("Creating a zero-length cache");
+    } else if (cache->length < size)
+        cache->list = XLALRealloc(cache->list,
+                                  cache->length * sizeof(*cache->list));
     XLALCacheSort(cache);
     return cache;
 }
@@ -467,11 +474,12 @@ int XLALCacheSort(LALCache * cache)
 {
     if (!cache)
         XLAL_ERROR(XLAL_EFAULT);
-    /* insertion sort preserves original order in the event of a tie,
+    /* merge sort preserves original order in the event of a tie,
      * allowing fail-over copies in the cache to be listed in order of
-     * preference */
-    return XLALInsertionSort(cache->list, cache->length, sizeof(*cache->list),
-                             NULL, XLALCacheCompareEntryMetadata);
+     * preference, and remains fast for caches of many thousands of
+     * entries */
+    return XLALMergeSort(cache->list, cache->length, sizeof(*cache->list),
+                         NULL, XLALCacheCompareEntryMetadata);
 }
 
 int XLALCacheUniq(LALCache * cache)
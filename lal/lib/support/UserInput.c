@@ -39,6 +39,8 @@
 #include <lal/Date.h>
 #include <lal/StringVector.h>
 #include <lal/AVFactories.h>
+#include <lal/LALHashTbl.h>
+#include <lal/LALHashFunc.h>
 
 #include <lal/UserInputParse.h>
 #include <lal/UserInputPrint.h>
@@ -121,6 +123,11 @@ int XLALUserVarPrintUsage ( FILE *file );
 int XLALUserVarPrintHelp ( FILE *file );
 static void format_user_var_names( char *s );
 static void fprint_wrapped( FILE *f, int line_width, const char *prefix, char *text );
+static UINT8 UserVarNameHash( const void *x );
+static int UserVarNameCmp( const void *x, const void *y );
+static UINT8 UserVarCVarHash( const void *x );
+static int UserVarCVarCmp( const void *x, const void *y );
+static const LALUserVariable *UserVarFindName( const char *name );
 
 // ----- define templated registration functions for all supported UVAR_TYPE_ 'UTYPES'
 DEFN_REGISTER_UVAR(BOOLEAN,BOOLEAN);
@@ -238,6 +245,12 @@ static const struct
 
 // ---------- The module-local linked list to hold the user-variables
 static LALUserVariable UVAR_vars;	// empty head
+static LALUserVariable *UVAR_last = &UVAR_vars;	// last entry, to which new user-variables are appended
+
+// ---------- Module-local registry of user-variables, to look them up by long-option name, short-option character, and C-variable
+static LALHashTbl *UVAR_by_name = NULL;	// hash table of user-variables, keyed by long-option name
+static LALHashTbl *UVAR_by_cvar = NULL;	// hash table of user-variables, keyed by C-variable pointer
+static LALUserVariable *UVAR_by_optchar[UCHAR_MAX + 1];	// user-variables indexed by short-option character
 static CHAR *program_path = NULL;	// keep a pointer to the program path
 static CHAR *program_name = NULL;	// keep a pointer to the program name
 
@@ -260,6 +273,49 @@ const char *lalUserVarHelpOptionSubsection = NULL;
 
 // ==================== Function definitions ====================
 
+// ----- local helper functions: hash and compare user-variables by long-option name and by C-variable pointer
+static UINT8
+UserVarNameHash ( const void *x )
+{
+  const char *name = ((const LALUserVariable *) x)->name;
+  return XLALCityHash64 ( name, strlen ( name ) );
+}
+
+static int
+UserVarNameCmp ( const void *x, const void *y )
+{
+  return strcmp ( ((const LALUserVariable *) x)->name, ((const LALUserVariable *) y)->name );
+}
+
+static UINT8
+UserVarCVarHash ( const void *x )
+{
+  const void *cvar = ((const LALUserVariable *) x)->cvar;
+  return XLALCityHash64 ( (const char *) &cvar, sizeof ( cvar ) );
+}
+
+static int
+UserVarCVarCmp ( const void *x, const void *y )
+{
+  const void *cvarx = ((const LALUserVariable *) x)->cvar;
+  const void *cvary = ((const LALUserVariable *) y)->cvar;
+  return ( cvarx == cvary ) ? 0 : ( ( cvarx < cvary ) ? -1 : 1 );
+}
+
+// ----- local helper function: find a registered user-variable by long-option name, or return NULL
+static const LALUserVariable *
+UserVarFindName ( const char *name )
+{
+  LALUserVariable key;
+  const void *found = NULL;
+  if ( UVAR_by_name != NULL && strlen ( name ) < sizeof ( key.name ) )
+    {
+      strcpy ( key.name, name );
+      XLAL_CHECK_NULL ( XLALHashTblFind ( UVAR_by_name, &key, &found ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+  return (const LALUserVariable *) found;
+}
+
 /**
  * \ingroup UserInput_h
  * Internal function: Register a user-variable with the module.
@@ -301,29 +357,36 @@ XLALRegisterUserVar ( void *cvar,		/**< pointer to the actual C-variable to link
   XLAL_CHECK ( strcmp ( name, "version" ) != 0, XLAL_EINVAL, "Long-option name '--%s' is reserved for version!\n", name );
   XLAL_CHECK ( optchar != 'v', XLAL_EINVAL, "Short-option '-%c' is reserved for version!\n", optchar );
 
-  // find end of uvar-list && check that neither short- nor long-option are taken already
-  LALUserVariable *ptr = &UVAR_vars;
-  while ( ptr->next != NULL )
+  // create the registry of user-variables, if needed
+  if ( UVAR_by_name == NULL )
     {
-      ptr = ptr->next;
-
-      // long-option name taken already?
-      XLAL_CHECK ( strcmp ( name, ptr->name ) != 0, XLAL_EINVAL, "Long-option name '--%s' already taken!\n", name );
-      // short-option character taken already?
-      XLAL_CHECK ( (optchar == 0) || (ptr->optchar == 0) || (optchar != ptr->optchar), XLAL_EINVAL, "Short-option '-%c' already taken (by '--%s')!\n", optchar, ptr->name );
-
-    } // while ptr->next
-
-  // append new entry at the end
-  XLAL_CHECK ( (ptr->next = XLALCalloc (1, sizeof(LALUserVariable))) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK ( (UVAR_by_name = XLALHashTblCreate ( NULL, UserVarNameHash, UserVarNameCmp )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( (UVAR_by_cvar = XLALHashTblCreate ( NULL, UserVarCVarHash, UserVarCVarCmp )) != NULL, XLAL_EFUNC );
+    }
 
-  // set pointer to newly created entry
-  ptr = ptr->next;
+  // create new entry
+  LALUserVariable *ptr;
+  XLAL_CHECK ( (ptr = XLALCalloc (1, sizeof(LALUserVariable))) != NULL, XLAL_ENOMEM );
 
   // copy entry name, replacing '_' with '-' so that
   // e.g. uvar->a_long_option maps to --a-long-option
   XLALStringReplaceChar( strncpy( ptr->name, name, sizeof(ptr->name) - 1 ), '_', '-' );
 
+  // check that neither short- nor long-option are taken already
+  const LALUserVariable *taken;
+  // long-option name taken already?
+  if ( (taken = UserVarFindName ( ptr->name )) != NULL )
+    {
+      XLALFree ( ptr );
+      XLAL_ERROR ( XLAL_EINVAL, "Long-option name '--%s' already taken!\n", name );
+    }
+  // short-option character taken already?
+  if ( (optchar != 0) && (taken = UVAR_by_optchar[ (unsigned char) optchar ]) != NULL )
+    {
+      XLALFree ( ptr );
+      XLAL_ERROR ( XLAL_EINVAL, "Short-option '-%c' already taken (by '--%s')!\n", optchar, taken->name );
+    }
+
   // copy current subsection heading
   ptr->subsection = lalUserVarHelpOptionSubsection;
 
@@ -338,6 +401,19 @@ XLALRegisterUserVar ( void *cvar,		/**< pointer to the actual C-variable to link
   ptr->cdata 	= cdata;
   ptr->category = category;
 
+  // append new entry at the end, and add it to the registry
+  XLAL_CHECK ( XLALHashTblAdd ( UVAR_by_name, ptr ) == XLAL_SUCCESS, XLAL_EFUNC );
+  const void *cvar_taken = NULL;
+  XLAL_CHECK ( XLALHashTblFind ( UVAR_by_cvar, ptr, &cvar_taken ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( cvar_taken == NULL ) {	// XLALUserVarWasSet() refers to the first user-variable linked to a C-variable
+    XLAL_CHECK ( XLALHashTblAdd ( UVAR_by_cvar, ptr ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  if ( optchar != 0 ) {
+    UVAR_by_optchar[ (unsigned char) optchar ] = ptr;
+  }
+  UVAR_last->next = ptr;
+  UVAR_last = ptr;
+
   return XLAL_SUCCESS;
 
 } // XLALRegisterUserVar()
@@ -378,6 +454,13 @@ XLALDestroyUserVars ( void )
 
   // clean head
   memset (&UVAR_vars, 0, sizeof(UVAR_vars));
+  UVAR_last = &UVAR_vars;
+
+  // clean registry
+  XLALHashTblDestroy ( UVAR_by_name );
+  XLALHashTblDestroy ( UVAR_by_cvar );
+  UVAR_by_name = UVAR_by_cvar = NULL;
+  memset (UVAR_by_optchar, 0, sizeof(UVAR_by_optchar));
 
   return;
 
@@ -432,6 +515,7 @@ XLALUserVarReadCmdline ( BOOLEAN *should_exit, int argc, char *argv[], const LAL
 
   // ---------- fill option-struct for long-options
   struct LALoption *long_options = LALCalloc (1, (numvars+2) * sizeof(struct LALoption));
+  LALUserVariable **long_option_vars = LALCalloc (1, (numvars+2) * sizeof(long_option_vars[0]));	// user-variable of each long-option, indexed by longindex
   pos = 0;
 
   // add special version option
@@ -449,6 +533,7 @@ XLALUserVarReadCmdline ( BOOLEAN *should_exit, int argc, char *argv[], const LAL
       long_options[pos].has_arg = (ptr->type == UVAR_TYPE_BOOLEAN) ? optional_argument : required_argument;
       long_options[pos].flag = NULL;	// get val returned from LALgetopt_long()
       long_options[pos].val 	= 0;	// we use longindex to find long-options
+      long_option_vars[pos] = ptr;
       pos ++;
     } // while ptr->next
 
@@ -514,21 +599,11 @@ XLALUserVarReadCmdline ( BOOLEAN *should_exit, int argc, char *argv[], const LAL
 
       if (c != 0) 	// find short-option character
 	{
-	  ptr = &UVAR_vars;
-	  do {
-	    if (c == ptr->optchar) {
-	      break;
-            }
-	  } while ( (ptr=ptr->next) != NULL);
+	  ptr = ( 0 < c && c <= UCHAR_MAX ) ? UVAR_by_optchar[c] : NULL;
 	} // end: if short-option given
       else	// find long-option: returned in longindex
 	{
-	  ptr = &UVAR_vars;
-	  while ( (ptr=ptr->next) != NULL) {
-	    if ( !strcmp (long_options[longindex].name, ptr->name) ) {
-	      break;
-            }
-          }
+	  ptr = long_option_vars[longindex];
 	} // end: if long-option
 
       XLAL_CHECK ( ptr != NULL, XLAL_EFAILED, "ERROR: failed to find matching option ... this points to a coding-error!\n" );
@@ -621,6 +696,7 @@ XLALUserVarReadCmdline ( BOOLEAN *should_exit, int argc, char *argv[], const LAL
 
   XLALFree (long_options);
   long_options=NULL;
+  XLALFree (long_option_vars);
 
   return XLAL_SUCCESS;
 
@@ -1166,14 +1242,11 @@ XLALUserVarWasSet ( const void *cvar )
   XLAL_CHECK ( cvar != NULL, XLAL_EINVAL );
   XLAL_CHECK ( UVAR_vars.next != NULL, XLAL_EINVAL, "No UVAR memory allocated. Did you register any user-variables?" );
 
-  // find this variable name in the list of registered user-variables
-  LALUserVariable *ptr = &UVAR_vars;
-  while ( (ptr = ptr->next) != NULL )
-    {
-      if ( ptr->cvar == cvar) {
-        break;
-      }
-    } // while ptr = ptr->next
+  // find this variable in the registry of user-variables
+  LALUserVariable key;
+  key.cvar = (void *)(uintptr_t) cvar;	// only used for lookup, not written through
+  const LALUserVariable *ptr = NULL;
+  XLAL_CHECK ( XLALHashTblFind ( UVAR_by_cvar, &key, (const void **) &ptr ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   XLAL_CHECK ( ptr != NULL, XLAL_EINVAL, "Variable pointer passed UVARwasSet is not a registered User-variable\n" );
 
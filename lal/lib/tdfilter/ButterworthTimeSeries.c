@@ -232,6 +232,74 @@ XLALParsePassBandParamStruc( PassBandParamStruc *params,
 #undef SINGLE_PRECISION
 #include "ButterworthTimeSeries_source.c"
 
+/**
+ * Create the cascade of second-order sections of the Butterworth filter generated
+ * from parameters <tt>*params</tt> for data sampled at intervals \c deltaT, as
+ * applied (once in each sense) by XLALButterworthREAL8TimeSeries(); the cascade
+ * may be applied to several data streams at once with the routines in \ref SOSFilter_c.
+ */
+REAL8SOSFilter *XLALCreateButterworthREAL8SOSFilter( PassBandParamStruc *params, REAL8 deltaT )
+{
+  INT4 n;    /* The filter order. */
+  INT4 type; /* The pass-band type: high, low, or undeterminable. */
+  INT4 i;    /* An index. */
+  INT4 j;    /* Another index. */
+  INT4 k;    /* A third index. */
+  REAL8 wc;  /* The filter's transformed frequency. */
+  REAL8SOSFilter *sos;
+
+  if ( ! params )
+    XLAL_ERROR_NULL( XLAL_EFAULT );
+  type=XLALParsePassBandParamStruc(params,&n,&wc,deltaT);
+  if(type<0)
+    XLAL_ERROR_NULL( XLAL_EINVAL );
+  sos=XLALCreateREAL8SOSFilter((n+1)/2);
+  if(!sos)
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+
+  /* Pair up poles as in XLALButterworthREAL8TimeSeries(); section i
+     is of order 2, except for the possible unpaired pole when i==j. */
+  for(i=0,j=n-1;i<=j;i++,j--){
+    INT4 order=(i<j)?2:1;
+    REAL8IIRFilter *iirFilter=NULL;
+    COMPLEX16ZPGFilter *zpgFilter=XLALCreateCOMPLEX16ZPGFilter(type==2?order:0,order);
+    if(!zpgFilter)
+    {
+      XLALDestroyREAL8SOSFilter(sos);
+      XLAL_ERROR_NULL( XLAL_EFUNC );
+    }
+
+    /* Generate the filter in the w-plane. */
+    if(order==2){
+      REAL8 theta=LAL_PI*(i+0.5)/n;
+      zpgFilter->poles->data[0]=crect(wc*cos(theta),wc*sin(theta));
+      zpgFilter->poles->data[1]=crect(-wc*cos(theta),wc*sin(theta));
+      zpgFilter->gain=(type==2)?1.0:-wc*wc;
+    }else{
+      zpgFilter->poles->data[0]=wc*I;
+      zpgFilter->gain=(type==2)?1.0:-wc*I;
+    }
+    if(type==2)
+      for(k=0;k<order;k++)
+        zpgFilter->zeros->data[k]=0.0;
+
+    /* Transform to the z-plane and store the IIR filter as section i. */
+    if(XLALWToZCOMPLEX16ZPGFilter(zpgFilter)<0
+       || !(iirFilter=XLALCreateREAL8IIRFilter(zpgFilter))
+       || XLALREAL8SOSFilterSetSection(sos,i,iirFilter)<0)
+    {
+      XLALDestroyREAL8IIRFilter(iirFilter);
+      XLALDestroyCOMPLEX16ZPGFilter(zpgFilter);
+      XLALDestroyREAL8SOSFilter(sos);
+      XLAL_ERROR_NULL( XLAL_EFUNC );
+    }
+    XLALDestroyREAL8IIRFilter(iirFilter);
+    XLALDestroyCOMPLEX16ZPGFilter(zpgFilter);
+  }
+
+  return sos;
+}
+
 /**
  * Deprecated.
  * \deprecated Use XLALButterworthREAL4TimeSeries() instead.
@@ -123,6 +123,7 @@ extern "C" {
  * \defgroup IIRFilter_c 		Module IIRFilter.c
  * \defgroup IIRFilterVector_c 	Module IIRFilterVector.c
  * \defgroup IIRFilterVectorR_c 	Module IIRFilterVectorR.c
+ * \defgroup SOSFilter_c 		Module SOSFilter.c
  * @}
  */
 
@@ -189,6 +190,16 @@ typedef struct tagCOMPLEX16IIRFilter{
   COMPLEX16Vector *history;    /**< The previous values of w. */
 } COMPLEX16IIRFilter;
 
+/**
+ * This structure stores a cascade of second-order sections.
+ * Section \f$k\f$ has the direct coefficients \f$c_0,c_1,c_2\f$ and the recursive
+ * coefficients \f$d_1,d_2\f$, stored in elements \f$5k,\ldots,5k+4\f$ of \c coef.
+ */
+typedef struct tagREAL8SOSFilter{
+  UINT4 numSections;       /**< The number of second-order sections. */
+  REAL8Vector *coef;       /**< The filter coefficients of all sections. */
+} REAL8SOSFilter;
+
 /** @} */
 
 /* Function prototypes. */
@@ -215,6 +226,14 @@ REAL4 LALSIIRFilter( REAL4 x, REAL4IIRFilter *filter );
 /* REAL8 LALDIIRFilter( REAL8 x, REAL8IIRFilter *filter ); */
 #define LALDIIRFilter(x,f) XLALIIRFilterREAL8(x,f)
 
+/* ----- SOSFilter.c ---------- */
+REAL8SOSFilter *XLALCreateREAL8SOSFilter( UINT4 numSections );
+void XLALDestroyREAL8SOSFilter( REAL8SOSFilter *sos );
+int XLALREAL8SOSFilterSetSection( REAL8SOSFilter *sos, UINT4 k, const REAL8IIRFilter *filter );
+UINT4 XLALSOSFilterWarmupLength( const REAL8SOSFilter *sos, REAL8 tolerance );
+int XLALSOSFilterREAL8Vectors( REAL8Vector **vectors, UINT4 numVectors, const REAL8SOSFilter *sos, int reverse );
+int XLALSOSFilterForwardBackwardREAL8Vectors( REAL8Vector **vectors, UINT4 numVectors, const REAL8SOSFilter *sos, UINT4 blockLength, UINT4 warmup );
+
 
 
 /* ----- CreateIIRFilter.c ---------- */
@@ -0,0 +1,364 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <math.h>
+#include <complex.h>
+#include <string.h>
+#include <lal/LALStdlib.h>
+#include <lal/AVFactories.h>
+#include <lal/IIRFilter.h>
+
+/**
+ * \addtogroup SOSFilter_c
+ *
+ * \brief Applies cascades of second-order sections to several data streams at once.
+ *
+ * ### Description ###
+ *
+ * A \c REAL8SOSFilter is a cascade of second-order sections, each a \c REAL8IIRFilter
+ * of order at most 2 in the conventions of \ref IIRFilter_h, e.g. the sections of a
+ * Butterworth filter created by XLALCreateButterworthREAL8SOSFilter(). The routines
+ * in this module apply such a cascade, starting from zero filter history, to each of
+ * an array of vectors of data (e.g. the channels of a multi-channel data set):
+ * XLALSOSFilterREAL8Vectors() filters in the normal or the time-reversed sense, and
+ * XLALSOSFilterForwardBackwardREAL8Vectors() filters in both senses, so that the
+ * output has no phase shift.
+ *
+ * In XLALSOSFilterForwardBackwardREAL8Vectors(), long vectors may also be split into
+ * blocks of \c blockLength samples, which are filtered independently: each block is
+ * filtered starting \c warmup samples before it, from zero history, so that the
+ * transient of the filter has decayed before the block starts. The result agrees with
+ * filtering the whole vector to the precision with which the transient has decayed;
+ * XLALSOSFilterWarmupLength() gives the number of samples after which the impulse
+ * response of the filter has decayed by a given factor.
+ *
+ * ### Algorithm ###
+ *
+ * The vectors, or blocks of them, are filtered \c LAL_SOS_LANES at a time: samples of
+ * each are interleaved into a short buffer, and each section is applied to the buffer
+ * with the vectors in independent lanes, so that the inner loop over lanes has no
+ * dependencies and is vectorised by the compiler. Groups of lanes are distributed
+ * across OpenMP threads, if enabled.
+ *
+ */
+/** @{ */
+
+/* number of data streams filtered together in independent lanes */
+#define LAL_SOS_LANES 4
+
+/* number of samples of each lane interleaved into the buffer at a time */
+#define LAL_SOS_BUFFER 256
+
+/* one data stream to filter: nwarm + nkeep samples are read from in, in steps of stride;
+ * the outputs of the first nwarm samples are discarded, and the rest written to out */
+typedef struct tagSOSJob {
+  const REAL8 *in;
+  REAL8 *out;
+  ptrdiff_t stride;
+  size_t nwarm;
+  size_t nkeep;
+} SOSJob;
+
+/** Create a cascade of \c numSections second-order sections, each initially the identity. */
+REAL8SOSFilter *XLALCreateREAL8SOSFilter( UINT4 numSections )
+{
+  REAL8SOSFilter *sos;
+  UINT4 k;
+  XLAL_CHECK_NULL( numSections > 0, XLAL_EINVAL );
+  sos = XLALCalloc( 1, sizeof( *sos ) );
+  XLAL_CHECK_NULL( sos, XLAL_ENOMEM );
+  sos->numSections = numSections;
+  sos->coef = XLALCreateREAL8Vector( 5 * numSections );
+  if ( ! sos->coef )
+  {
+    XLALFree( sos );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+  memset( sos->coef->data, 0, sos->coef->length * sizeof( *sos->coef->data ) );
+  for ( k = 0; k < numSections; ++k )
+    sos->coef->data[5*k] = 1.0;
+  return sos;
+}
+
+/** Destroy a cascade of second-order sections. */
+void XLALDestroyREAL8SOSFilter( REAL8SOSFilter *sos )
+{
+  if ( sos )
+  {
+    XLALDestroyREAL8Vector( sos->coef );
+    XLALFree( sos );
+  }
+}
+
+/** Set section \c k of a cascade to the IIR filter \c filter, which must have order at most 2. */
+int XLALREAL8SOSFilterSetSection( REAL8SOSFilter *sos, UINT4 k, const REAL8IIRFilter *filter )
+{
+  REAL8 *c;
+  UINT4 j;
+  XLAL_CHECK( sos && filter && filter->directCoef && filter->recursCoef, XLAL_EFAULT );
+  XLAL_CHECK( k < sos->numSections, XLAL_EINVAL, "Section %u out of range [0,%u)", k, sos->numSections );
+  XLAL_CHECK( filter->directCoef->length <= 3 && filter->recursCoef->length <= 3, XLAL_EINVAL, "Filter has order greater than 2" );
+  c = sos->coef->data + 5 * k;
+  memset( c, 0, 5 * sizeof( *c ) );
+  for ( j = 0; j < filter->directCoef->length; ++j )
+    c[j] = filter->directCoef->data[j];
+  for ( j = 1; j < filter->recursCoef->length; ++j )
+    c[2 + j] = filter->recursCoef->data[j];
+  return 0;
+}
+
+/**
+ * Return the number of samples after which the impulse response of the cascade has
+ * decayed by the factor \c tolerance, as determined by the pole of largest modulus.
+ */
+UINT4 XLALSOSFilterWarmupLength( const REAL8SOSFilter *sos, REAL8 tolerance )
+{
+  REAL8 rmax = 0, n;
+  UINT4 k;
+  XLAL_CHECK_VAL( 0, sos, XLAL_EFAULT );
+  XLAL_CHECK_VAL( 0, tolerance > 0 && tolerance < 1, XLAL_EINVAL );
+  for ( k = 0; k < sos->numSections; ++k )
+  {
+    /* poles are the roots of z^2 - d1 z - d2 */
+    const REAL8 d1 = sos->coef->data[5*k+3], d2 = sos->coef->data[5*k+4];
+    const COMPLEX16 s = csqrt( d1 * d1 + 4 * d2 );
+    const REAL8 r = fmax( cabs( 0.5 * ( d1 + s ) ), cabs( 0.5 * ( d1 - s ) ) );
+    rmax = fmax( rmax, r );
+  }
+  XLAL_CHECK_VAL( 0, rmax < 1, XLAL_EDOM, "Filter is not stable (pole of modulus %g)", rmax );
+  if ( rmax == 0 )
+    return 2 * sos->numSections;
+  n = ceil( log( tolerance ) / log( rmax ) );
+  XLAL_CHECK_VAL( 0, n < 4294967295.0, XLAL_EDOM, "Filter transient is too long" );
+  return (UINT4) n + 2 * sos->numSections;
+}
+
+/* size of the workspace of XLALSOSFilterJobs() */
+#define LAL_SOS_WORKSPACE(sos) ( LAL_SOS_LANES * ( LAL_SOS_BUFFER + 2 * (sos)->numSections ) )
+
+/* filter up to LAL_SOS_LANES data streams, one in each lane, using the workspace buf */
+static void XLALSOSFilterJobs( const REAL8SOSFilter *sos, const SOSJob *jobs, UINT4 njobs, REAL8 *buf )
+{
+  const UINT4 nsec = sos->numSections;
+  const REAL8 *coef = sos->coef->data;
+  REAL8 *w1 = buf + LAL_SOS_LANES * LAL_SOS_BUFFER;     /* history of each section in each lane */
+  REAL8 *w2 = w1 + LAL_SOS_LANES * nsec;
+  size_t len = 0, t0;
+  UINT4 l;
+
+  for ( l = 0; l < njobs; ++l )
+    if ( jobs[l].nwarm + jobs[l].nkeep > len )
+      len = jobs[l].nwarm + jobs[l].nkeep;
+  memset( w1, 0, 2 * LAL_SOS_LANES * nsec * sizeof( *w1 ) );
+
+  for ( t0 = 0; t0 < len; t0 += LAL_SOS_BUFFER )
+  {
+    const size_t nt = ( len - t0 < LAL_SOS_BUFFER ) ? len - t0 : LAL_SOS_BUFFER;
+    size_t t;
+    UINT4 k;
+
+    /* interleave the input; lanes past the end of their data stream, or unused, are zero */
+    for ( l = 0; l < LAL_SOS_LANES; ++l )
+    {
+      const size_t n = ( l < njobs ) ? jobs[l].nwarm + jobs[l].nkeep : 0;
+      for ( t = 0; t < nt; ++t )
+        buf[t * LAL_SOS_LANES + l] = ( t0 + t < n ) ? jobs[l].in[(ptrdiff_t) ( t0 + t ) * jobs[l].stride] : 0.0;
+    }
+
+    /* apply each section to all lanes */
+    for ( k = 0; k < nsec; ++k )
+    {
+      const REAL8 c0 = coef[5*k], c1 = coef[5*k+1], c2 = coef[5*k+2];
+      const REAL8 d1 = coef[5*k+3], d2 = coef[5*k+4];
+      REAL8 *restrict s1 = w1 + k * LAL_SOS_LANES;
+      REAL8 *restrict s2 = w2 + k * LAL_SOS_LANES;
+      for ( t = 0; t < nt; ++t )
+      {
+        REAL8 *restrict x = buf + t * LAL_SOS_LANES;
+        for ( l = 0; l < LAL_SOS_LANES; ++l )
+        {
+          const REAL8 w = x[l] + d1 * s1[l] + d2 * s2[l];
+          x[l] = c0 * w + c1 * s1[l] + c2 * s2[l];
+          s2[l] = s1[l];
+          s1[l] = w;
+        }
+      }
+    }
+
+    /* de-interleave the output, discarding the warm-up */
+    for ( l = 0; l < njobs; ++l )
+    {
+      const size_t n = jobs[l].nwarm + jobs[l].nkeep;
+      for ( t = 0; t < nt; ++t )
+        if ( t0 + t >= jobs[l].nwarm && t0 + t < n )
+          jobs[l].out[(ptrdiff_t) ( t0 + t - jobs[l].nwarm ) * jobs[l].stride] = buf[t * LAL_SOS_LANES + l];
+    }
+  }
+}
+
+/* filter a list of data streams, LAL_SOS_LANES at a time, in parallel if OpenMP is enabled */
+static int XLALSOSFilterJobList( const REAL8SOSFilter *sos, const SOSJob *jobs, size_t njobs )
+{
+  const size_t ngroups = ( njobs + LAL_SOS_LANES - 1 ) / LAL_SOS_LANES;
+  long g;
+  int nomem = 0;
+#pragma omp parallel
+  {
+    REAL8 *buf = XLALMalloc( LAL_SOS_WORKSPACE( sos ) * sizeof( *buf ) );
+    if ( ! buf )
+    {
+#pragma omp atomic write
+      nomem = 1;
+    }
+    /* every thread must reach the work-sharing loop; a thread without a buffer skips its groups */
+#pragma omp for schedule(dynamic)
+    for ( g = 0; g < (long) ngroups; ++g )
+    {
+      const size_t first = g * LAL_SOS_LANES;
+      const UINT4 n = ( njobs - first < LAL_SOS_LANES ) ? njobs - first : LAL_SOS_LANES;
+      if ( buf )
+        XLALSOSFilterJobs( sos, jobs + first, n, buf );
+    }
+    XLALFree( buf );
+  }
+  XLAL_CHECK( ! nomem, XLAL_ENOMEM );
+  return 0;
+}
+
+/**
+ * Filter each of the \c numVectors vectors in place with the cascade \c sos, starting
+ * from zero filter history, in the normal sense if \c reverse is zero, and otherwise in
+ * the time-reversed sense.
+ */
+int XLALSOSFilterREAL8Vectors( REAL8Vector **vectors, UINT4 numVectors, const REAL8SOSFilter *sos, int reverse )
+{
+  SOSJob *jobs;
+  UINT4 i;
+  XLAL_CHECK( vectors && sos && sos->coef, XLAL_EFAULT );
+  jobs = XLALMalloc( ( numVectors ? numVectors : 1 ) * sizeof( *jobs ) );
+  XLAL_CHECK( jobs, XLAL_ENOMEM );
+  for ( i = 0; i < numVectors; ++i )
+  {
+    REAL8Vector *v = vectors[i];
+    if ( ! v || ( v->length && ! v->data ) )
+    {
+      XLALFree( jobs );
+      XLAL_ERROR( XLAL_EFAULT, "Vector %u is NULL", i );
+    }
+    jobs[i].in = jobs[i].out = ( reverse && v->length ) ? v->data + v->length - 1 : v->data;
+    jobs[i].stride = reverse ? -1 : 1;
+    jobs[i].nwarm = 0;
+    jobs[i].nkeep = v->length;
+  }
+  if ( XLALSOSFilterJobList( sos, jobs, numVectors ) < 0 )
+  {
+    XLALFree( jobs );
+    XLAL_ERROR( XLAL_EFUNC );
+  }
+  XLALFree( jobs );
+  return 0;
+}
+
+/**
+ * Filter each of the \c numVectors vectors in place with the cascade \c sos, once in the
+ * normal sense and once in the time-reversed sense, starting from zero filter history.
+ * If \c blockLength is zero, each vector is filtered as a whole; otherwise vectors are split
+ * into blocks of \c blockLength samples, each filtered independently after \c warmup samples
+ * of the adjacent data.
+ */
+int XLALSOSFilterForwardBackwardREAL8Vectors( REAL8Vector **vectors, UINT4 numVectors, const REAL8SOSFilter *sos, UINT4 blockLength, UINT4 warmup )
+{
+  SOSJob *jobs = NULL;
+  REAL8 **fwd = NULL;
+  size_t njobs = 0, maxjobs = 0;
+  int errnum;
+  UINT4 i;
+
+  XLAL_CHECK( vectors && sos && sos->coef, XLAL_EFAULT );
+  for ( i = 0; i < numVectors; ++i )
+    XLAL_CHECK( vectors[i] && ( ! vectors[i]->length || vectors[i]->data ), XLAL_EFAULT, "Vector %u is NULL", i );
+
+  /* filter whole vectors in place */
+  if ( blockLength == 0 )
+  {
+    XLAL_CHECK( XLALSOSFilterREAL8Vectors( vectors, numVectors, sos, 0 ) == 0, XLAL_EFUNC );
+    XLAL_CHECK( XLALSOSFilterREAL8Vectors( vectors, numVectors, sos, 1 ) == 0, XLAL_EFUNC );
+    return 0;
+  }
+
+  /* the forward pass needs the unfiltered data before each block, so its output goes to separate storage */
+  for ( i = 0; i < numVectors; ++i )
+    maxjobs += ( vectors[i]->length + blockLength - 1 ) / blockLength;
+  jobs = XLALMalloc( ( maxjobs ? maxjobs : 1 ) * sizeof( *jobs ) );
+  fwd = XLALCalloc( numVectors ? numVectors : 1, sizeof( *fwd ) );
+  errnum = ( jobs && fwd ) ? 0 : XLAL_ENOMEM;
+  for ( i = 0; ! errnum && i < numVectors; ++i )
+    if ( vectors[i]->length && ! ( fwd[i] = XLALMalloc( vectors[i]->length * sizeof( *fwd[i] ) ) ) )
+      errnum = XLAL_ENOMEM;
+
+  /* forward pass: block [s, e) is filtered from s - warmup */
+  njobs = 0;
+  for ( i = 0; ! errnum && i < numVectors; ++i )
+  {
+    const size_t n = vectors[i]->length;
+    size_t s;
+    for ( s = 0; s < n; s += blockLength )
+    {
+      const size_t ws = ( s > warmup ) ? s - warmup : 0;
+      jobs[njobs].in = vectors[i]->data + ws;
+      jobs[njobs].out = fwd[i] + s;
+      jobs[njobs].stride = 1;
+      jobs[njobs].nwarm = s - ws;
+      jobs[njobs].nkeep = ( n - s < blockLength ) ? n - s : blockLength;
+      ++njobs;
+    }
+  }
+  if ( ! errnum && XLALSOSFilterJobList( sos, jobs, njobs ) < 0 )
+    errnum = XLAL_EFUNC;
+
+  /* backward pass: block [s, e) is filtered from e + warmup in the time-reversed sense */
+  njobs = 0;
+  for ( i = 0; ! errnum && i < numVectors; ++i )
+  {
+    const size_t n = vectors[i]->length;
+    size_t s;
+    for ( s = 0; s < n; s += blockLength )
+    {
+      const size_t e = ( n - s < blockLength ) ? n : s + blockLength;
+      const size_t we = ( n - e > warmup ) ? e + warmup : n;
+      jobs[njobs].in = fwd[i] + we - 1;
+      jobs[njobs].out = vectors[i]->data + e - 1;
+      jobs[njobs].stride = -1;
+      jobs[njobs].nwarm = we - e;
+      jobs[njobs].nkeep = e - s;
+      ++njobs;
+    }
+  }
+  if ( ! errnum && XLALSOSFilterJobList( sos, jobs, njobs ) < 0 )
+    errnum = XLAL_EFUNC;
+
+  if ( fwd )
+    for ( i = 0; i < numVectors; ++i )
+      XLALFree( fwd[i] );
+  XLALFree( fwd );
+  XLALFree( jobs );
+  if ( errnum )
+    XLAL_ERROR( errnum );
+  return 0;
+}
+
+/** @} */
@@ -220,6 +220,18 @@ struct tagStrainIn {
   INT4 NAY;/**< UNDOCUMENTED */
 } StrainIn;
 
+/** Opaque state of an incremental lock-in demodulation of a calibration line */
+typedef struct tagCalibrationLineDemodulator CalibrationLineDemodulator;
+
+/** Opaque state of a continuous tracking of the calibration factors, see XLALCreateCalibrationFactorTracker() */
+typedef struct tagCalibrationFactorTracker CalibrationFactorTracker;
+
+/** Opaque state of a FIR filter applied to a stream of data in consecutive strides */
+typedef struct tagREAL8FIRFilterStream REAL8FIRFilterStream;
+
+/** Opaque state of a streaming reconstruction of strain, see XLALCreateStrainReconstruction() */
+typedef struct tagStrainReconstruction StrainReconstruction;
+
 /** UNDOCUMENTED */
 typedef
 struct tagMyIIRFilter {
@@ -265,6 +277,16 @@ void LALComputeCalibrationFactors(
     UpdateFactorsParams    *input
     );
 
+CalibrationLineDemodulator *XLALCreateCalibrationLineDemodulator(REAL8 lineFrequency, REAL8 deltaT, UINT4 length);
+void XLALDestroyCalibrationLineDemodulator(CalibrationLineDemodulator *demod);
+int XLALUpdateCalibrationLineDemodulator(CalibrationLineDemodulator *demod, const REAL4Vector *data);
+int XLALGetCalibrationLinePhasor(COMPLEX16 *phasor, const CalibrationLineDemodulator *demod);
+
+CalibrationFactorTracker *XLALCreateCalibrationFactorTracker(const UpdateFactorsParams *params, REAL8 To);
+void XLALDestroyCalibrationFactorTracker(CalibrationFactorTracker *tracker);
+int XLALUpdateCalibrationFactorTracker(CalibrationFactorTracker *tracker, const REAL4Vector *darmCtrl, const REAL4Vector *asQ, const REAL4Vector *exc);
+int XLALGetCalibrationFactors(CalFactors *output, const CalibrationFactorTracker *tracker);
+
 void LALComputeStrain(
     LALStatus              *status,
     StrainOut              *output,
@@ -307,6 +329,15 @@ int XLALDivideTimeSeries(REAL8TimeSeries *hR, REAL8TimeSeries *ALPHAS);
 int XLALUpsample(REAL8TimeSeries *uphR, REAL8TimeSeries *hR, int up_factor);
 int XLALUpsampleLinear(REAL8TimeSeries *uphR, REAL8TimeSeries *hR, int up_factor);
 
+REAL8FIRFilterStream *XLALCreateREAL8FIRFilterStream(const REAL8Vector *directCoef);
+void XLALDestroyREAL8FIRFilterStream(REAL8FIRFilterStream *stream);
+int XLALREAL8FIRFilterStream(REAL8Vector *data, REAL8FIRFilterStream *stream);
+
+StrainReconstruction *XLALCreateStrainReconstruction(const StrainIn *input);
+void XLALDestroyStrainReconstruction(StrainReconstruction *recon);
+int XLALStrainReconstructionLatency(const StrainReconstruction *recon);
+int XLALComputeStrainStride(StrainOut *output, StrainReconstruction *recon, const StrainIn *input, REAL8 alphabeta);
+
 #if 0
 { /* so that editors will match succeeding brace */
 #elif defined(__cplusplus)
@@ -21,11 +21,18 @@
 #include <lal/DetResponse.h>
 #include <lal/TimeDelay.h>
 #include <lal/AVFactories.h>
+#include <lal/Date.h>
+#include <lal/VectorMath.h>
+#include <lal/LALThreadPool.h>
 #include <strings.h>
+#include <string.h>
 #include <math.h>
 
 #define EPS 1.0e-7
 
+/* detectors supported by LALDoCoherentEstimation() and XLALCoherentEstimationSkyGrid() */
+#define MAX_DETECTORS 9
+
 #define Cosh(x) cosh(x)
 #define ACosh(x) acosh(x)
 
@@ -34,340 +41,361 @@ double acosh(double);
 
 static INT4 jacobi(float **a, int n, float d[], float **v, int *nrot);
 
-void
-LALDoCoherentEstimation ( LALStatus          *stat,
-			REAL4TimeSeries *output,
-			CoherentEstimation *params,
-			DetectorsData      *in) {
-  /*
-     NOTES:
-     o destroys input (in)
-     o order of in must be same as order of params->filters
-     o output time wrt center of Earth
-  */
+/* pre-process the data of one detector by applying its IIR filter nPreProcessed times */
+typedef struct {
+  const CoherentEstimation *params;
+  DetectorsData *in;
+} CoherentPreProcess;
 
-  INT4 /* Sret, */
-    i, j, k, /* counters */
-    iPad, ePad, /* used for padding */
-    del;  /* integer time delay */
-  REAL4 y; /* dummy */
-  REAL8 p1,p2; /* weights in interpolation */
-  REAL8 *tDelays; /* time delays wrt Earth center */
-  REAL8 mDelay; /* max of time delays */
-  REAL8 tmid; /* mid time point */
-  LALDetAMResponse *F; /* response functions */
-  LALPlaceAndGPS pGPS; /* for time delays */
-  LALDetAndSource dAs; /* for responses */
-  LALSource source; /* for responses */
-  LIGOTimeGPS t0; /* start time of data */
+static int coherent_preprocess_detector(void *arg, size_t i)
+{
+  const CoherentPreProcess *pp = arg;
+  REAL4TimeSeries *series = &pp->in->data[i];
+  REAL4Vector *data = series->data;
+  REAL8Vector *tmpR8;
+  UINT4 j, nzero;
+
+  tmpR8 = XLALCreateREAL8Vector(data->length);
+  XLAL_CHECK(tmpR8 != NULL, XLAL_EFUNC);
+
+  for (j = 0; j < data->length; j++)
+    tmpR8->data[j] = (REAL8)(data->data[j]);
+
+  for (j = 0; j < pp->params->nPreProcessed; j++) {
+    if (XLALIIRFilterREAL8Vector(tmpR8, pp->params->filters[i]) != XLAL_SUCCESS) {
+      XLALDestroyREAL8Vector(tmpR8);
+      XLAL_ERROR(XLAL_EFUNC);
+    }
+  }
 
-  REAL8 *alpha; /* scale factor */
-  INT4 nrot;
-  REAL8 maxLambda, tmpLambda;
-  REAL4 *lambda;
-  REAL4 **Hmat;
-  REAL4 **v;
-  REAL8 **Cmat;
+  for (j = 0; j < data->length; j++)
+    data->data[j] = (REAL4)(tmpR8->data[j]);
 
-  /*
-    {REAL8 tmp = Cosh(ACosh((double)3.02993)/3.0);
-    printf("%g\n",tmp);}
-  */
+  XLALDestroyREAL8Vector(tmpR8);
 
-  /***********************************************************************/
-  /* initialize status & validate input                                  */
-  /***********************************************************************/
-  INITSTATUS(stat);
-  ATTATCHSTATUSPTR( stat );
+  /* set first 1/16 s to zero to avoid transient */
+  nzero = (UINT4)ceil(0.0635 / series->deltaT);
+  memset(data->data, 0, sizeof(REAL4) * (nzero < data->length ? nzero : data->length));
 
+  return XLAL_SUCCESS;
+}
 
-  ASSERT ( in, stat, COHERENTESTIMATIONH_ENULL, COHERENTESTIMATIONH_MSGENULL );
-  ASSERT ( in->data, stat, COHERENTESTIMATIONH_ENULL, COHERENTESTIMATIONH_MSGENULL );
-  ASSERT ( in->Ndetectors > 0 && in->Ndetectors < 10, stat, COHERENTESTIMATIONH_E0DEC, COHERENTESTIMATIONH_MSGE0DEC );
-
-  ASSERT ( in->Ndetectors == 3, stat, COHERENTESTIMATIONH_EUIMP, COHERENTESTIMATIONH_MSGEUIMP );
+/* combine the detector data with the weights of one sky position */
+typedef struct {
+  REAL4TimeSeries *output;
+  const CoherentEstimation *params;
+  const DetectorsData *in;
+  UINT4 numPoints;
+  const REAL8 *tDelays; /* delay of sky position k at detector i is tDelays[i * numPoints + k] */
+  const REAL8 *fplus;   /* same layout as tDelays */
+  const REAL8 *fcross;  /* same layout as tDelays */
+} CoherentSkyGrid;
+
+static int coherent_sky_position(void *arg, size_t k)
+{
+  const CoherentSkyGrid *grid = arg;
+  const CoherentEstimation *params = grid->params;
+  const UINT4 Nd = params->Ndetectors;
+  const UINT4 np = grid->numPoints;
+  REAL4TimeSeries *output = grid->output + k;
+  const INT4 length = (INT4)output->data->length;
+  REAL4 Hbuf[MAX_DETECTORS][MAX_DETECTORS], vbuf[MAX_DETECTORS][MAX_DETECTORS];
+  REAL4 *Hmat[MAX_DETECTORS], *v[MAX_DETECTORS];
+  REAL4 lambda[MAX_DETECTORS];
+  REAL8 Fp[MAX_DETECTORS], Fc[MAX_DETECTORS], tDelays[MAX_DETECTORS];
+  REAL8 alpha[MAX_DETECTORS];
+  REAL8 maxLambda, tmpLambda;
+  REAL4 *tmp;
+  UINT4 i, j, l;
+  INT4 nrot;
 
-  for(i=0;i<(INT4)in->Ndetectors;i++) {
-    ASSERT ( in->data[i].data, stat, COHERENTESTIMATIONH_E0DEC, COHERENTESTIMATIONH_MSGE0DEC );
+  for (i = 0; i < Nd; i++) {
+    Fp[i] = grid->fplus[i * np + k];
+    Fc[i] = grid->fcross[i * np + k];
+    /* set time origin on first detector */
+    tDelays[i] = grid->tDelays[i * np + k] - grid->tDelays[k];
+    Hmat[i] = Hbuf[i];
+    v[i] = vbuf[i];
   }
 
-  t0 = in->data[0].epoch;
+  /* weights are the eigenvector of the network response with largest eigenvalue */
+  for (i = 0; i < Nd; i++)
+    for (j = 0; j < Nd; j++)
+      Hmat[i][j] = (Fp[i]*Fp[j]*params->plus2cross + (Fp[i]*Fc[j] + Fp[j]*Fc[i])*params->plusDotcross + Fc[i]*Fc[j]/params->plus2cross) / params->CMat[i][i];
 
-  for(i=1;i<(INT4)in->Ndetectors;i++) {
-    ASSERT ( in->data[i].epoch.gpsSeconds == t0.gpsSeconds &&
-	     in->data[i].epoch.gpsNanoSeconds == t0.gpsNanoSeconds, stat, COHERENTESTIMATIONH_EDST, COHERENTESTIMATIONH_MSGEDST );
-  }
+  XLAL_CHECK(jacobi(Hmat, Nd, lambda, v, &nrot) == 0, XLAL_EFAILED, "Jacobi eigenvalue iteration failed at sky position %zu", k);
 
-  ASSERT ( params, stat, COHERENTESTIMATIONH_ENULL, COHERENTESTIMATIONH_MSGENULL );
-  ASSERT ( params->detectors, stat, COHERENTESTIMATIONH_ENULL, COHERENTESTIMATIONH_MSGENULL );
-  ASSERT ( params->filters, stat, COHERENTESTIMATIONH_ENULL, COHERENTESTIMATIONH_MSGENULL );
-  ASSERT ( params->position, stat, COHERENTESTIMATIONH_ENULL, COHERENTESTIMATIONH_MSGENULL );
-  ASSERT ( params->Ndetectors == in->Ndetectors, stat, COHERENTESTIMATIONH_EICE, COHERENTESTIMATIONH_MSGEICE );
-
-  /***********************************************************************/
-  /* if params->preProcessed is 0, need to pre-processed by applying the */
-  /* IIR filters twice                                                   */
-  /***********************************************************************/
-  if(!(params->preProcessed) && params->nPreProcessed) {
-
-    REAL8Vector *tmpR8 = NULL;
-    UINT4 jind;
-
-    for(i=0;i<(INT4)in->Ndetectors;i++) {
-      ASSERT ( params->filters[i], stat, COHERENTESTIMATIONH_EICE, COHERENTESTIMATIONH_MSGEICE );
+  maxLambda = -1e30;
+  for (l = 0; l < Nd; l++) {
+    tmpLambda = 0.0;
+    for (i = 0; i < Nd; i++)
+      for (j = 0; j < Nd; j++)
+        tmpLambda += v[i][l]*v[j][l]*(Fp[i]*Fp[j]*params->plus2cross + (Fp[i]*Fc[j] + Fp[j]*Fc[i])*params->plusDotcross + Fc[i]*Fc[j]/params->plus2cross);
+    if (tmpLambda > maxLambda) {
+      for (i = 0; i < Nd; i++)
+        alpha[i] = v[i][l];
+      maxLambda = tmpLambda;
     }
+  }
 
-    /* loop over all detectors, and filter twice */
-    for(i=0; i<(INT4)params->Ndetectors; i++) {
-
-      TRY ( LALDCreateVector( stat->statusPtr,
-			      &tmpR8,
-			      in->data[i].data->length ), stat );
-
-      for(jind = 0; jind<in->data[i].data->length; jind++) {
-	tmpR8->data[jind] = (REAL8)(in->data[i].data->data[jind]);
-      }
-
-      for(j=0; j<params->nPreProcessed; j++) {
-        TRY ( LALIIRFilterREAL8Vector( stat->statusPtr,
-	       			       tmpR8,
-				       params->filters[i]), stat );
-      }
-
-      for(jind = 0; jind<in->data[i].data->length; jind++) {
-	in->data[i].data->data[jind] = (REAL4)(tmpR8->data[jind]);
-      }
+  /* update output parameters; output time wrt center of Earth */
+  output->epoch = grid->in->data[0].epoch;
+  output->deltaT = grid->in->data[0].deltaT;
+  output->f0 = grid->in->data[0].f0;
+  output->sampleUnits = grid->in->data[0].sampleUnits;
+  memset(output->data->data, 0, length * sizeof(REAL4));
 
-      TRY ( LALDDestroyVector (  stat->statusPtr,
-				 &tmpR8 ) , stat );
+  tmp = XLALMalloc(length * sizeof(*tmp));
+  XLAL_CHECK(tmp != NULL, XLAL_ENOMEM);
 
-      /* set first 1/16 s to zero to avoid transient */
-      memset(in->data[i].data->data, 0, sizeof(REAL4) * (UINT4)ceil(0.0635 / in->data[i].deltaT));
+  for (i = 0; i < Nd; i++) {
+    INT4 iPad, ePad, del, n;
+    REAL8 p1, p2;
+    const REAL4 *x;
+    REAL4 *y;
 
+    /* setup padding and weights */
+    if (tDelays[i] < 0.0) {
+      /* need padding at beginning */
+      iPad = (INT4)floor(-tDelays[i]/output->deltaT);
+      ePad = 0;
+      del = -iPad;
+    } else {
+      /* need padding at end */
+      iPad = 0;
+      ePad = (INT4)ceil(tDelays[i]/output->deltaT);
+      del = ePad;
+    }
+    p1 = ceil(tDelays[i] / output->deltaT) - tDelays[i] / output->deltaT;
+    p2 = 1.0 - p1;
+
+    /* interpolate using time delays: output[j] += alpha * (p1 * data[del+j-1] + p2 * data[del+j]) for iPad < j < length - ePad */
+    n = length - ePad - iPad - 1;
+    if (n <= 0)
+      continue;
+    x = grid->in->data[i].data->data + del + iPad;
+    y = output->data->data + iPad + 1;
+    if (XLALVectorScaleREAL4(tmp, (REAL4)(p1 * alpha[i]), x, n) != XLAL_SUCCESS
+        || XLALVectorAddREAL4(y, y, tmp, n) != XLAL_SUCCESS
+        || XLALVectorScaleREAL4(tmp, (REAL4)(p2 * alpha[i]), x + 1, n) != XLAL_SUCCESS
+        || XLALVectorAddREAL4(y, y, tmp, n) != XLAL_SUCCESS) {
+      XLALFree(tmp);
+      XLAL_ERROR(XLAL_EFUNC);
     }
-
-    params->preProcessed = 1;
-
   }
 
+  XLALFree(tmp);
 
-  /* update output parameters */
-  output->epoch = in->data[0].epoch;
-  output->deltaT = in->data[0].deltaT;
-  output->f0 = in->data[0].f0;
-  memcpy(&(output->sampleUnits), &(in->data[0].sampleUnits), sizeof(LALUnit));
-
-  /* make sure output is zero */
-  memset(output->data->data, 0, output->data->length * sizeof(REAL4));
-
-
+  return XLAL_SUCCESS;
+}
 
-  /***********************************************************************/
-  /* Compute time delays and response functions                          */
-  /***********************************************************************/
-  if(!(tDelays = (REAL8 *)LALMalloc(params->Ndetectors * sizeof(REAL8)))) {
-    ABORT ( stat, COHERENTESTIMATIONH_EMEM, COHERENTESTIMATIONH_MSGEMEM );
+/**
+ * Coherently combine the data of a detector network for each of the
+ * \c numPoints sky positions \c positions, using the detectors, filters,
+ * polarization and correlation matrix of \c params.
+ *
+ * \c output is an array of \c numPoints time series, each with a data
+ * vector of the same length as the input data; the estimate for sky position
+ * \c k is written to <tt>output[k]</tt>, with time wrt the center of the Earth.
+ *
+ * If \c params->preProcessed is 0, the data in \c in are first pre-processed
+ * in place by applying the filters \c params->nPreProcessed times, once for
+ * all sky positions, and \c params->preProcessed is set. Time delays and
+ * responses are computed for the whole sky grid at the center of the data
+ * stretch, and the sky positions are then combined concurrently using the
+ * LALThreadPool_h thread pool.
+ *
+ * LALDoCoherentEstimation() is the same computation for the single sky
+ * position \c params->position.
+ */
+int XLALCoherentEstimationSkyGrid(
+  REAL4TimeSeries *output,
+  CoherentEstimation *params,
+  DetectorsData *in,
+  const SkyPosition *positions,
+  UINT4 numPoints
+  )
+{
+  CoherentSkyGrid grid;
+  LIGOTimeGPS tmid;
+  REAL8 *tDelays, *fplus, *fcross, *ra, *dec;
+  REAL8 psi, gmst;
+  UINT4 Nd, length, i, k;
+  int retn = XLAL_SUCCESS;
+
+  XLAL_CHECK(in != NULL && in->data != NULL, XLAL_EFAULT);
+  XLAL_CHECK(params != NULL && params->detectors != NULL && params->CMat != NULL, XLAL_EFAULT);
+  XLAL_CHECK(numPoints == 0 || (output != NULL && positions != NULL), XLAL_EFAULT);
+  Nd = in->Ndetectors;
+  XLAL_CHECK(Nd > 0 && Nd <= MAX_DETECTORS, XLAL_EINVAL, "Number of detectors %u must be between 1 and %u", Nd, MAX_DETECTORS);
+  XLAL_CHECK(params->Ndetectors == Nd, XLAL_EINVAL, "CoherentEstimation has %u detectors, data has %u", params->Ndetectors, Nd);
+  XLAL_CHECK(params->plus2cross != 0, XLAL_EDOM);
+  for (i = 0; i < Nd; i++) {
+    XLAL_CHECK(in->data[i].data != NULL, XLAL_EFAULT);
+    XLAL_CHECK(XLALGPSCmp(&in->data[i].epoch, &in->data[0].epoch) == 0, XLAL_EINVAL, "Input time series don't all have same start time");
+    XLAL_CHECK(params->CMat[i] != NULL, XLAL_EFAULT);
   }
-
-  /* delays are computed wrt to center of data stretch */
-  pGPS.p_gps = &t0;
-  tmid = 0.5 * (REAL8)(in->data[0].data->length) * in->data[0].deltaT;
-  pGPS.p_gps->gpsSeconds += (INT4)floor(tmid);
-  pGPS.p_gps->gpsNanoSeconds += (INT4)floor(1E9*(tmid-floor(tmid)));
-  if(pGPS.p_gps->gpsNanoSeconds >= 1000000000) {
-    pGPS.p_gps->gpsSeconds += (INT4)floor((REAL8)(pGPS.p_gps->gpsNanoSeconds) / 1E9);
-    pGPS.p_gps->gpsNanoSeconds -= 1000000000 * (INT4)floor((REAL8)(pGPS.p_gps->gpsNanoSeconds) / 1E9);
+  length = in->data[0].data->length;
+  for (i = 0; i < Nd; i++)
+    XLAL_CHECK(in->data[i].data->length == length, XLAL_EBADLEN);
+  for (k = 0; k < numPoints; k++) {
+    XLAL_CHECK(positions[k].system == COORDINATESYSTEM_EQUATORIAL, XLAL_EINVAL, "Sky position %u is not in equatorial coordinates", k);
+    XLAL_CHECK(output[k].data != NULL, XLAL_EFAULT);
+    XLAL_CHECK(output[k].data->length == length, XLAL_EBADLEN);
   }
 
-
-  if(!(F = (LALDetAMResponse *)LALMalloc(params->Ndetectors * sizeof(LALDetAMResponse)))) {
-    ABORT ( stat, COHERENTESTIMATIONH_EMEM, COHERENTESTIMATIONH_MSGEMEM );
+  /* if params->preProcessed is 0, pre-process each detector once, for all sky positions */
+  if (!(params->preProcessed) && params->nPreProcessed) {
+    CoherentPreProcess pp;
+    XLAL_CHECK(params->filters != NULL, XLAL_EFAULT);
+    for (i = 0; i < Nd; i++)
+      XLAL_CHECK(params->filters[i] != NULL, XLAL_EFAULT);
+    pp.params = params;
+    pp.in = in;
+    XLAL_CHECK(XLALThreadPoolRun(coherent_preprocess_detector, &pp, Nd) == XLAL_SUCCESS, XLAL_EFUNC);
+    params->preProcessed = 1;
   }
 
-  dAs.pSource = &source;
-  source.equatorialCoords = *(params->position);
-  source.orientation = params->polAngle;
-
-  for(i=0; i<(INT4)params->Ndetectors; i++) {
-
-    pGPS.p_detector = dAs.pDetector = params->detectors + i;
-
-    /* tDelays = arrival time at detector - arrival time a center of Earth */
-    tDelays[i] = XLALTimeDelayFromEarthCenter(params->detectors[i].location, params->position->longitude, params->position->latitude, &t0);
-
-    /* JC: isnan is not allowed
-    if(isnan(tDelays[i])) {
-      ABORT ( stat, COHERENTESTIMATIONH_ENUM, COHERENTESTIMATIONH_MSGENUM );
-    }
-    */
-
-    TRY ( LALComputeDetAMResponse ( stat->statusPtr,
-				    F + i,
-				    &dAs,
-				    pGPS.p_gps ), stat );
+  if (numPoints == 0)
+    return XLAL_SUCCESS;
 
-    /* JC: isnan is not allowed
-    if(isnan(F[i].cross) || isnan(F[i].plus)) {
-      ABORT ( stat, COHERENTESTIMATIONH_ENUM, COHERENTESTIMATIONH_MSGENUM );
+  /* delays and responses are computed wrt to center of data stretch */
+  {
+    const REAL8 dt = 0.5 * (REAL8)length * in->data[0].deltaT;
+    tmid = in->data[0].epoch;
+    tmid.gpsSeconds += (INT4)floor(dt);
+    tmid.gpsNanoSeconds += (INT4)floor(1E9*(dt-floor(dt)));
+    if (tmid.gpsNanoSeconds >= 1000000000) {
+      tmid.gpsSeconds += tmid.gpsNanoSeconds / 1000000000;
+      tmid.gpsNanoSeconds %= 1000000000;
     }
-    */
-  }
-
-  /***********************************************************************/
-  /* Compute and store estimated data                                    */
-  /***********************************************************************/
-  /* set time origine on detector with largest delay */
-  /*
-  mDelay = tDelays[0];
-  for(i=1; i<params->Ndetectors; i++) {
-	if(tDelays[i] > mDelay) {
-		mDelay = tDelays[i];
-	}
-  }
-  */
-  mDelay = tDelays[0];
-
-  for(i=0; i<(INT4)params->Ndetectors; i++) {
-    tDelays[i] -= mDelay;
   }
 
-
-  alpha = (REAL8 *)LALMalloc(params->Ndetectors * sizeof(REAL8));
-  if(!alpha) {
-    ABORT ( stat, COHERENTESTIMATIONH_EMEM, COHERENTESTIMATIONH_MSGEMEM );
+  tDelays = XLALMalloc(Nd * numPoints * sizeof(*tDelays));
+  fplus = XLALMalloc(Nd * numPoints * sizeof(*fplus));
+  fcross = XLALMalloc(Nd * numPoints * sizeof(*fcross));
+  ra = XLALMalloc(numPoints * sizeof(*ra));
+  dec = XLALMalloc(numPoints * sizeof(*dec));
+  if (!tDelays || !fplus || !fcross || !ra || !dec) {
+    retn = XLAL_ENOMEM;
+    goto done;
   }
 
-  lambda = (REAL4 *)LALMalloc(params->Ndetectors * sizeof(REAL4));
-  if(!lambda) {
-    ABORT ( stat, COHERENTESTIMATIONH_EMEM, COHERENTESTIMATIONH_MSGEMEM );
+  for (k = 0; k < numPoints; k++) {
+    ra[k] = positions[k].longitude;
+    dec[k] = positions[k].latitude;
   }
 
-  Hmat = (REAL4 **)LALMalloc(params->Ndetectors * sizeof(REAL4 *));
-  if(!Hmat) {
-    ABORT ( stat, COHERENTESTIMATIONH_EMEM, COHERENTESTIMATIONH_MSGEMEM );
-  }
-  for(i=0; i<(INT4)params->Ndetectors; i++) {
-    Hmat[i] = (REAL4 *)LALMalloc(params->Ndetectors * sizeof(REAL4));
-    if(!(Hmat[i])) {
-      ABORT ( stat, COHERENTESTIMATIONH_EMEM, COHERENTESTIMATIONH_MSGEMEM );
-    }
+  /* tDelays = arrival time at detector - arrival time a center of Earth */
+  if (XLALTimeDelaysFromEarthCenter(tDelays, params->detectors, Nd, ra, dec, numPoints, &tmid) != XLAL_SUCCESS) {
+    retn = XLAL_EFUNC;
+    goto done;
   }
 
-  v = (REAL4 **)LALMalloc(params->Ndetectors * sizeof(REAL4 *));
-  if(!v) {
-    ABORT ( stat, COHERENTESTIMATIONH_EMEM, COHERENTESTIMATIONH_MSGEMEM );
+  /* responses of each detector over the sky grid */
+  psi = params->polAngle;
+  gmst = XLALGreenwichMeanSiderealTime(&tmid);
+  if (XLAL_IS_REAL8_FAIL_NAN(gmst)) {
+    retn = XLAL_EFUNC;
+    goto done;
   }
-  for(i=0; i<(INT4)params->Ndetectors; i++) {
-    v[i] = (REAL4 *)LALMalloc(params->Ndetectors * sizeof(REAL4));
-    if(!(v[i])) {
-      ABORT ( stat, COHERENTESTIMATIONH_EMEM, COHERENTESTIMATIONH_MSGEMEM );
+  for (i = 0; i < Nd; i++) {
+    REAL8Vector fp = { numPoints, fplus + i * numPoints };
+    REAL8Vector fc = { numPoints, fcross + i * numPoints };
+    REAL8Vector ravec = { numPoints, ra };
+    REAL8Vector decvec = { numPoints, dec };
+    REAL8Vector psivec = { 1, &psi };
+    REAL8Vector gmstvec = { 1, &gmst };
+    if (XLALComputeDetAMResponseVectors(&fp, &fc, params->detectors[i].response, &ravec, &decvec, &psivec, &gmstvec) != XLAL_SUCCESS) {
+      retn = XLAL_EFUNC;
+      goto done;
     }
   }
 
-  Cmat = params->CMat;
-
-  for(i=0; i<(INT4)params->Ndetectors; i++) {
-    for(j=0; j<(INT4)params->Ndetectors; j++) {
-
-	Hmat[i][j] = (F[i].plus*F[j].plus*params->plus2cross + (F[i].plus*F[j].cross + F[j].plus*F[i].cross)*params->plusDotcross + F[i].cross*F[j].cross/params->plus2cross) / Cmat[i][i];
-
-    }
-  }
+  /* compute and store estimated data */
+  grid.output = output;
+  grid.params = params;
+  grid.in = in;
+  grid.numPoints = numPoints;
+  grid.tDelays = tDelays;
+  grid.fplus = fplus;
+  grid.fcross = fcross;
+  if (XLALThreadPoolRun(coherent_sky_position, &grid, numPoints) != XLAL_SUCCESS)
+    retn = XLAL_EFUNC;
+
+done:
+  XLALFree(tDelays);
+  XLALFree(fplus);
+  XLALFree(fcross);
+  XLALFree(ra);
+  XLALFree(dec);
+  if (retn != XLAL_SUCCESS)
+    XLAL_ERROR(retn);
+  return XLAL_SUCCESS;
+}
 
-  if(jacobi(Hmat, params->Ndetectors, lambda, v, &nrot)) {
-    ABORT ( stat, COHERENTESTIMATIONH_ENUM, COHERENTESTIMATIONH_MSGENUM );
-  }
+void
+LALDoCoherentEstimation ( LALStatus          *stat,
+			REAL4TimeSeries *output,
+			CoherentEstimation *params,
+			DetectorsData      *in) {
   /*
- printf("%g\t%g\t%g\n",lambda[0],lambda[1],lambda[2]);
- */
-  maxLambda = -1e30;
-  for(k=0;k<(INT4)params->Ndetectors;k++) {
-
-    tmpLambda = 0.0;
-
-    for(i=0; i<(INT4)params->Ndetectors; i++) {
-      for(j=0; j<(INT4)params->Ndetectors; j++) {
-	tmpLambda += v[i][k]*v[j][k]*(F[i].plus*F[j].plus*params->plus2cross + (F[i].plus*F[j].cross + F[j].plus*F[i].cross)*params->plusDotcross + F[i].cross*F[j].cross/params->plus2cross);
-      }
-    }
-
-    if(tmpLambda > maxLambda) {
-      for(i=0; i<(INT4)params->Ndetectors; i++) {
-	alpha[i] = v[i][k];
-      }
-      maxLambda = tmpLambda;
-    }
-/*
-    printf("%u\t%g\t%g\t%g\t%g\n",k,lambda[k],alpha[0],alpha[1],alpha[2]);
-    */
-  }
-
-  /* loop */
-  for(i=0; i<(INT4)params->Ndetectors; i++) {
+     NOTES:
+     o destroys input (in)
+     o order of in must be same as order of params->filters
+     o output time wrt center of Earth
+  */
 
-    /* setup padding and weights */
-    if(tDelays[i] < 0.0) {
-      /* need padding at beginning */
-      iPad = (INT4)floor(-tDelays[i]/output->deltaT);
-      ePad = 0;
+  INT4 i;
+  LIGOTimeGPS t0; /* start time of data */
 
-      /* set integer delay (for p1 weight) */
-      del = -iPad;
+  /*
+    {REAL8 tmp = Cosh(ACosh((double)3.02993)/3.0);
+    printf("%g\n",tmp);}
+  */
 
-      /* set weights */
-      p1 = ceil(tDelays[i] / output->deltaT) - tDelays[i] / output->deltaT;
-      p2 = 1.0 - p1;
-    } else {
-      /* need padding at end */
-      iPad = 0;
-      ePad = (INT4)ceil(tDelays[i]/output->deltaT);
+  /***********************************************************************/
+  /* initialize status & validate input                                  */
+  /***********************************************************************/
+  INITSTATUS(stat);
+  ATTATCHSTATUSPTR( stat );
 
-      /* integer delay */
-      del = ePad;
 
-      /* weights */
-      p1 = ceil(tDelays[i] / output->deltaT) - tDelays[i] / output->deltaT;
-      p2 = 1.0 - p1;
-    }
+  ASSERT ( in, stat, COHERENTESTIMATIONH_ENULL, COHERENTESTIMATIONH_MSGENULL );
+  ASSERT ( in->data, stat, COHERENTESTIMATIONH_ENULL, COHERENTESTIMATIONH_MSGENULL );
+  ASSERT ( in->Ndetectors > 0 && in->Ndetectors < 10, stat, COHERENTESTIMATIONH_E0DEC, COHERENTESTIMATIONH_MSGE0DEC );
 
+  ASSERT ( in->Ndetectors == 3, stat, COHERENTESTIMATIONH_EUIMP, COHERENTESTIMATIONH_MSGEUIMP );
 
-    /* interpolate using time delays */
-    for(j=iPad+1; j<(INT4)output->data->length - (INT4)ePad; j++) {
+  for(i=0;i<(INT4)in->Ndetectors;i++) {
+    ASSERT ( in->data[i].data, stat, COHERENTESTIMATIONH_E0DEC, COHERENTESTIMATIONH_MSGE0DEC );
+  }
 
-      y = p1 * in->data[i].data->data[del+j-1] + p2 * in->data[i].data->data[del+j];
+  t0 = in->data[0].epoch;
 
-      output->data->data[j] += y * alpha[i];
-    }
+  for(i=1;i<(INT4)in->Ndetectors;i++) {
+    ASSERT ( in->data[i].epoch.gpsSeconds == t0.gpsSeconds &&
+	     in->data[i].epoch.gpsNanoSeconds == t0.gpsNanoSeconds, stat, COHERENTESTIMATIONH_EDST, COHERENTESTIMATIONH_MSGEDST );
   }
 
-  /*
-  {
-    FILE *out;
-    out = fopen("test.dat","w");
-    for(j=0;j<output->data->length;j++) {
-      fprintf(out,"%g\t%g\n",output->data->data[j].re,output->data->data[j].im);
-    }
-    fclose(out);
+  ASSERT ( params, stat, COHERENTESTIMATIONH_ENULL, COHERENTESTIMATIONH_MSGENULL );
+  ASSERT ( params->detectors, stat, COHERENTESTIMATIONH_ENULL, COHERENTESTIMATIONH_MSGENULL );
+  ASSERT ( params->filters, stat, COHERENTESTIMATIONH_ENULL, COHERENTESTIMATIONH_MSGENULL );
+  ASSERT ( params->position, stat, COHERENTESTIMATIONH_ENULL, COHERENTESTIMATIONH_MSGENULL );
+  ASSERT ( params->Ndetectors == in->Ndetectors, stat, COHERENTESTIMATIONH_EICE, COHERENTESTIMATIONH_MSGEICE );
 
-    exit(0);
+  if(!(params->preProcessed) && params->nPreProcessed) {
+    for(i=0;i<(INT4)in->Ndetectors;i++) {
+      ASSERT ( params->filters[i], stat, COHERENTESTIMATIONH_EICE, COHERENTESTIMATIONH_MSGEICE );
+    }
   }
-  */
 
   /***********************************************************************/
-  /* clean up and normal return                                          */
+  /* pre-process, and combine the data for the single sky position       */
   /***********************************************************************/
-  LALFree(tDelays);
-  LALFree(F);
-
-  LALFree(alpha);
-  LALFree(lambda);
-
-  for(i=0; i<(INT4)params->Ndetectors; i++) {
-    LALFree(Hmat[i]);
-    LALFree(v[i]);
+  if ( XLALCoherentEstimationSkyGrid( output, params, in, params->position, 1 ) != XLAL_SUCCESS ) {
+    ABORTXLAL( stat );
   }
-  LALFree(Hmat);
-  LALFree(v);
 
   DETATCHSTATUSPTR( stat );
   RETURN( stat );
@@ -375,6 +403,7 @@ LALDoCoherentEstimation ( LALStatus          *stat,
 }
 
 
+
 void
 LALClearCoherentData (
 		      LALStatus     *stat,
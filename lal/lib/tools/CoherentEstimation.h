@@ -85,6 +85,17 @@ LALDoCoherentEstimation (
 		       DetectorsData      *in
 	              );
 
+#ifndef SWIG /* exclude from SWIG interface */
+int
+XLALCoherentEstimationSkyGrid (
+		       REAL4TimeSeries *output,
+		       CoherentEstimation *params,
+		       DetectorsData      *in,
+		       const SkyPosition  *positions,
+		       UINT4              numPoints
+	              );
+#endif /* SWIG */
+
 void
 LALClearCoherentData (
 		      LALStatus     *status,
@@ -19,6 +19,7 @@
 
 #include <complex.h>
 #include <math.h>
+#include <string.h>
 #include <lal/LALStdlib.h>
 #include <lal/LALStdio.h>
 #include <lal/LALConstants.h>
@@ -26,6 +27,8 @@
 
 /* Independently computes the calibration factors \alpha(t)*\beta(t) and \alpha (t) from */
 
+static int compute_factors(CalFactors *output, COMPLEX16 DARM_CTRL, COMPLEX16 AS_Q, COMPLEX16 EXC, COMPLEX16 G0, COMPLEX16 D0);
+
 
 void LALComputeCalibrationFactors(
     LALStatus               *status,
@@ -33,10 +36,6 @@ void LALComputeCalibrationFactors(
     UpdateFactorsParams    *params
     )
 {
-  const REAL8 tiny = LAL_REAL8_MIN;
-  COMPLEX16 alpha;
-  COMPLEX16 alphabeta;
-  COMPLEX16 beta;
   COMPLEX16 DARM_CTRL;
   COMPLEX16 AS_Q;
   COMPLEX16 EXC;
@@ -148,11 +147,24 @@ void LALComputeCalibrationFactors(
 
   output->exc=EXC;
 
+  compute_factors(output, DARM_CTRL, AS_Q, EXC, G0, D0);
+
+  RETURN( status );
+}
+
+/* compute the calibration factors from the demodulated calibration line in each channel */
+static int compute_factors(CalFactors *output, COMPLEX16 DARM_CTRL, COMPLEX16 AS_Q, COMPLEX16 EXC, COMPLEX16 G0, COMPLEX16 D0)
+{
+  const REAL8 tiny = LAL_REAL8_MIN;
+  COMPLEX16 alpha;
+  COMPLEX16 alphabeta;
+  COMPLEX16 beta;
+
   if (( fabs( creal(EXC) ) < tiny && fabs( cimag(EXC) ) < tiny )) /* check on DARM_CTRL too?? */
   {
     output->alphabeta=0.0;
     output->alpha=0.0;
-    RETURN(status);
+    return XLAL_SUCCESS;
   }
 
 
@@ -186,5 +198,246 @@ void LALComputeCalibrationFactors(
   output->alpha=alpha;
   output->beta=beta;
 
-  RETURN( status );
+  return XLAL_SUCCESS;
+}
+
+/*******************************************************************************/
+
+struct tagCalibrationLineDemodulator {
+  REAL8 deltaT;                 /* sampling interval */
+  UINT4 length;                 /* number of samples in the window */
+  UINT8 nfed;                   /* number of samples fed so far */
+  REAL4 *ring;                  /* last length samples; sample m is at m % length */
+  COMPLEX16 *phase[3];          /* exp(i w_q r deltaT), r < length, for w_0 = w and w_{1,2} = w +/- 2 pi / ((length-1) deltaT) */
+  COMPLEX16 shift[3];           /* exp(-i w_q length deltaT) */
+  COMPLEX16 sum[3];             /* sum over the window of x_m exp(i w_q (m - B) deltaT), where B = nfed - nfed % length */
+};
+
+/**
+ * Create the state of an incremental lock-in demodulation of a calibration
+ * line at frequency \c lineFrequency, in data sampled at intervals \c deltaT.
+ *
+ * The line is demodulated over a sliding window of the last \c length samples,
+ * with the Hann window (multiplied by two) which LALGetFactors() applies to
+ * its stretches of data. The Hann window is the sum of three complex
+ * exponentials, so the windowed demodulation is a combination of three
+ * sliding sums, at the line frequency and at the line frequency plus and minus
+ * the fundamental frequency of the window. Each new sample updates the sums in
+ * constant time; after every \c length samples the sums are recomputed from
+ * the samples in the window, which stops rounding errors from accumulating.
+ */
+CalibrationLineDemodulator *XLALCreateCalibrationLineDemodulator(REAL8 lineFrequency, REAL8 deltaT, UINT4 length)
+{
+  CalibrationLineDemodulator *demod;
+
+  XLAL_CHECK_NULL(deltaT > 0, XLAL_EINVAL, "Invalid sampling interval %g", deltaT);
+  XLAL_CHECK_NULL(length > 1, XLAL_EINVAL, "Window must contain at least two samples");
+
+  demod = XLALCalloc(1, sizeof(*demod));
+  XLAL_CHECK_NULL(demod != NULL, XLAL_ENOMEM);
+  demod->deltaT = deltaT;
+  demod->length = length;
+  demod->ring = XLALCalloc(length, sizeof(*demod->ring));
+  for (int q = 0; q < 3; ++q)
+    demod->phase[q] = XLALMalloc(length * sizeof(*demod->phase[q]));
+  if (!demod->ring || !demod->phase[0] || !demod->phase[1] || !demod->phase[2]) {
+    XLALDestroyCalibrationLineDemodulator(demod);
+    XLAL_ERROR_NULL(XLAL_ENOMEM);
+  }
+
+  for (UINT4 r = 0; r < length; ++r) {
+    /* reduce phases to cycles in [0, 1) before multiplying by 2 pi */
+    const REAL8 cycles = fmod(lineFrequency * deltaT * r, 1.0);
+    const REAL8 wcycles = fmod((REAL8)r / (length - 1), 1.0);
+    demod->phase[0][r] = cexp(I * LAL_TWOPI * cycles);
+    demod->phase[1][r] = cexp(I * LAL_TWOPI * (cycles + wcycles));
+    demod->phase[2][r] = cexp(I * LAL_TWOPI * (cycles - wcycles));
+  }
+  {
+    const REAL8 cycles = fmod(lineFrequency * deltaT * length, 1.0);
+    const REAL8 wcycles = (REAL8)length / (length - 1);
+    demod->shift[0] = cexp(-I * LAL_TWOPI * cycles);
+    demod->shift[1] = cexp(-I * LAL_TWOPI * (cycles + wcycles));
+    demod->shift[2] = cexp(-I * LAL_TWOPI * (cycles - wcycles));
+  }
+
+  return demod;
+}
+
+/** Destroy the state of an incremental lock-in demodulation of a calibration line */
+void XLALDestroyCalibrationLineDemodulator(CalibrationLineDemodulator *demod)
+{
+  if (!demod)
+    return;
+  if (demod->ring)
+    XLALFree(demod->ring);
+  for (int q = 0; q < 3; ++q)
+    if (demod->phase[q])
+      XLALFree(demod->phase[q]);
+  XLALFree(demod);
+}
+
+/** Feed the next samples \c data of a channel to the demodulation of a calibration line */
+int XLALUpdateCalibrationLineDemodulator(CalibrationLineDemodulator *demod, const REAL4Vector *data)
+{
+  XLAL_CHECK(demod != NULL && data != NULL, XLAL_EFAULT);
+  XLAL_CHECK(data->length == 0 || data->data != NULL, XLAL_EFAULT);
+
+  const UINT4 N = demod->length;
+  const COMPLEX16 *phase0 = demod->phase[0], *phase1 = demod->phase[1], *phase2 = demod->phase[2];
+  const COMPLEX16 shift0 = demod->shift[0], shift1 = demod->shift[1], shift2 = demod->shift[2];
+  UINT4 r = demod->nfed % N;
+  UINT4 i = 0;
+
+  while (i < data->length) {
+
+    /* heterodyne samples up to the end of the window of the current base,
+     * replacing the samples which leave the window */
+    const UINT4 n = (data->length - i < N - r) ? data->length - i : N - r;
+    COMPLEX16 sum0 = 0, sum1 = 0, sum2 = 0;
+    for (UINT4 k = 0; k < n; ++k, ++r) {
+      const REAL8 xin = data->data[i + k], xout = demod->ring[r];
+      sum0 += phase0[r] * (xin - shift0 * xout);
+      sum1 += phase1[r] * (xin - shift1 * xout);
+      sum2 += phase2[r] * (xin - shift2 * xout);
+      demod->ring[r] = data->data[i + k];
+    }
+    demod->sum[0] += sum0;
+    demod->sum[1] += sum1;
+    demod->sum[2] += sum2;
+    demod->nfed += n;
+    i += n;
+
+    /* when the window is complete, move the base forward by one window,
+     * recomputing the sums from the samples in the window */
+    if (r == N) {
+      sum0 = sum1 = sum2 = 0;
+      for (r = 0; r < N; ++r) {
+        const REAL8 x = demod->ring[r];
+        sum0 += phase0[r] * x;
+        sum1 += phase1[r] * x;
+        sum2 += phase2[r] * x;
+      }
+      demod->sum[0] = shift0 * sum0;
+      demod->sum[1] = shift1 * sum1;
+      demod->sum[2] = shift2 * sum2;
+      r = 0;
+    }
+
+  }
+
+  return XLAL_SUCCESS;
+}
+
+/**
+ * Return in \c phasor the calibration line demodulated over the last \c length
+ * samples fed to \c demod, with the conventions of LALComputeCalibrationFactors()
+ * applied to the Hann-windowed data of LALGetFactors(): the phase is referred to
+ * the first sample of the window, and the phasor is normalised by \c deltaT.
+ * Fails if fewer than \c length samples have been fed.
+ */
+int XLALGetCalibrationLinePhasor(COMPLEX16 *phasor, const CalibrationLineDemodulator *demod)
+{
+  XLAL_CHECK(phasor != NULL && demod != NULL, XLAL_EFAULT);
+  XLAL_CHECK(demod->nfed >= demod->length, XLAL_EFAILED, "Only %" LAL_UINT8_FORMAT " of %u samples have been fed", demod->nfed, demod->length);
+
+  /* refer the sums from their base B to the start j = nfed - length of the window:
+   * exp(i w_q (m - j) deltaT) = exp(i w_q (m - B) deltaT) * exp(i w_q (B - j) deltaT) */
+  const UINT4 d = demod->length - (UINT4)(demod->nfed % demod->length);
+  COMPLEX16 ref[3];
+  for (int q = 0; q < 3; ++q)
+    ref[q] = (d < demod->length) ? demod->phase[q][d] : conj(demod->shift[q]);
+
+  /* 2 * Hann window = 1 - cos(2 pi k / (length - 1)) */
+  const COMPLEX16 W = ref[0] * demod->sum[0] - 0.5 * ref[1] * demod->sum[1] - 0.5 * ref[2] * demod->sum[2];
+
+  *phasor = conj(W) * demod->deltaT;
+
+  return XLAL_SUCCESS;
+}
+
+/*******************************************************************************/
+
+struct tagCalibrationFactorTracker {
+  COMPLEX16 openloop;           /* open loop gain at the line frequency */
+  COMPLEX16 digital;            /* digital filter at the line frequency */
+  COMPLEX16 whitener;           /* whitening filter at the line frequency */
+  CalibrationLineDemodulator *darmCtrl, *asQ, *exc;
+};
+
+/**
+ * Create the state of a continuous tracking of the calibration factors, for the
+ * calibration line and filters in \c params, demodulated over the last \c To
+ * seconds of each channel, sampled at the intervals of the channels in \c params.
+ *
+ * The factors are those which LALGetFactors() would compute from the last
+ * \c To seconds of data, and are available at any time from
+ * XLALGetCalibrationFactors(), once a full \c To seconds have been fed with
+ * XLALUpdateCalibrationFactorTracker().
+ */
+CalibrationFactorTracker *XLALCreateCalibrationFactorTracker(const UpdateFactorsParams *params, REAL8 To)
+{
+  CalibrationFactorTracker *tracker;
+
+  XLAL_CHECK_NULL(params != NULL, XLAL_EFAULT);
+  XLAL_CHECK_NULL(params->darmCtrl != NULL && params->asQ != NULL && params->exc != NULL, XLAL_EFAULT);
+  XLAL_CHECK_NULL(To > 0, XLAL_EINVAL, "Invalid integration time %g", To);
+
+  tracker = XLALCalloc(1, sizeof(*tracker));
+  XLAL_CHECK_NULL(tracker != NULL, XLAL_ENOMEM);
+  tracker->openloop = params->openloop;
+  tracker->digital = params->digital;
+  tracker->whitener = params->whitener;
+  tracker->darmCtrl = XLALCreateCalibrationLineDemodulator(params->lineFrequency, params->darmCtrl->deltaT, (UINT4)(To/params->darmCtrl->deltaT + 0.5));
+  tracker->asQ = XLALCreateCalibrationLineDemodulator(params->lineFrequency, params->asQ->deltaT, (UINT4)(To/params->asQ->deltaT + 0.5));
+  tracker->exc = XLALCreateCalibrationLineDemodulator(params->lineFrequency, params->exc->deltaT, (UINT4)(To/params->exc->deltaT + 0.5));
+  if (!tracker->darmCtrl || !tracker->asQ || !tracker->exc) {
+    XLALDestroyCalibrationFactorTracker(tracker);
+    XLAL_ERROR_NULL(XLAL_EFUNC);
+  }
+
+  return tracker;
+}
+
+/** Destroy the state of a continuous tracking of the calibration factors */
+void XLALDestroyCalibrationFactorTracker(CalibrationFactorTracker *tracker)
+{
+  if (!tracker)
+    return;
+  XLALDestroyCalibrationLineDemodulator(tracker->darmCtrl);
+  XLALDestroyCalibrationLineDemodulator(tracker->asQ);
+  XLALDestroyCalibrationLineDemodulator(tracker->exc);
+  XLALFree(tracker);
+}
+
+/** Feed the next samples of the DARM_CTRL, AS_Q and excitation channels to the tracking of the calibration factors */
+int XLALUpdateCalibrationFactorTracker(CalibrationFactorTracker *tracker, const REAL4Vector *darmCtrl, const REAL4Vector *asQ, const REAL4Vector *exc)
+{
+  XLAL_CHECK(tracker != NULL, XLAL_EFAULT);
+  XLAL_CHECK(XLALUpdateCalibrationLineDemodulator(tracker->darmCtrl, darmCtrl) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK(XLALUpdateCalibrationLineDemodulator(tracker->asQ, asQ) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK(XLALUpdateCalibrationLineDemodulator(tracker->exc, exc) == XLAL_SUCCESS, XLAL_EFUNC);
+  return XLAL_SUCCESS;
+}
+
+/** Return in \c output the calibration factors over the last \c To seconds fed to \c tracker */
+int XLALGetCalibrationFactors(CalFactors *output, const CalibrationFactorTracker *tracker)
+{
+  COMPLEX16 DARM_CTRL, AS_Q, EXC;
+
+  XLAL_CHECK(output != NULL && tracker != NULL, XLAL_EFAULT);
+  XLAL_CHECK(XLALGetCalibrationLinePhasor(&DARM_CTRL, tracker->darmCtrl) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK(XLALGetCalibrationLinePhasor(&AS_Q, tracker->asQ) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK(XLALGetCalibrationLinePhasor(&EXC, tracker->exc) == XLAL_SUCCESS, XLAL_EFUNC);
+
+  /* as in LALComputeCalibrationFactors() */
+  DARM_CTRL = -DARM_CTRL;
+  if (tracker->whitener != 0.0)
+    DARM_CTRL *= tracker->whitener;
+
+  output->darm = DARM_CTRL;
+  output->asq = AS_Q;
+  output->exc = EXC;
+
+  return compute_factors(output, DARM_CTRL, AS_Q, EXC, tracker->openloop, tracker->digital);
 }
@@ -18,6 +18,7 @@
  */
 
 #include <complex.h>
+#include <lal/LALStdlib.h>
 #include <lal/ComputeDataQualityVector.h>
 
 #include <math.h>  /* to use isnan() and isinf() */
@@ -83,6 +84,7 @@ int XLALComputeDQ(REAL4* sv_data, int r_sv,
     int calibrated;
     int badgamma;
     int dq_value;
+    int *not_up;                 /* running count of not-up samples */
 
     /* Fill one by one the contents of the DQ vector */
     for (i = 0; i < n_dq; i++) {
@@ -144,24 +146,30 @@ int XLALComputeDQ(REAL4* sv_data, int r_sv,
         dq_data[i] = dq_value;
     }
 
-    /* Now look for the transients and fill the "calibrated" bit. */
+    /* Now look for the transients and fill the "calibrated" bit.
+     * A sample is calibrated if the DQ is up over +/- wings samples
+     * around it; the number of not-up samples in any window is read
+     * off a running count, so that this takes a single pass over the
+     * DQ vector whatever the length of the wings. */
+    not_up = XLALMalloc((n_dq + 1) * sizeof(*not_up));
+    XLAL_CHECK(not_up != NULL, XLAL_ENOMEM);
+    not_up[0] = 0;  /* not_up[k] = number of not-up samples before k */
+    for (i = 0; i < n_dq; i++)
+        not_up[i+1] = not_up[i] + ((dq_data[i] & (1 << 2)) == 0);
+
     for (i = 0; i < n_dq; i++) {
         calibrated = 1;
 
         if (i - wings < t_bad_left || i + wings > n_dq + t_bad_right)
             calibrated = 0;
 
-        for (j = 0; j < wings; j++) {
-            int pos = i - j;
-            if (pos > 0) {
-                if ((dq_data[pos] & (1 << 2)) == 0)  /* if not up */
-                    calibrated = 0;
-            }
-            pos = i + j;  /* note that this includes dq_data[i] having UP=1 */
-            if (pos < n_dq) {
-                if ((dq_data[pos] & (1 << 2)) == 0)  /* if not up */
-                    calibrated = 0;
-            }
+        if (wings > 0) {
+            /* samples lo..hi must all be up; note that the first
+             * sample is only checked for dq_data[0] itself */
+            int lo = (i == 0) ? 0 : (i - wings + 1 > 1 ? i - wings + 1 : 1);
+            int hi = (i + wings - 1 < n_dq - 1) ? i + wings - 1 : n_dq - 1;
+            if (not_up[hi+1] - not_up[lo] > 0)  /* if not up */
+                calibrated = 0;
         }
 
         if (calibrated) dq_data[i] += (1 << 3);
@@ -169,5 +177,7 @@ int XLALComputeDQ(REAL4* sv_data, int r_sv,
          * seconds, so that also includes sv_up && light */
     }
 
+    XLALFree(not_up);
+
     return 0;
 }
@@ -20,6 +20,7 @@
 #include <complex.h>
 #include <math.h>
 #include <stdio.h>
+#include <string.h>
 #include <lal/LALStdlib.h>
 #include <lal/LALConstants.h>
 #include <lal/Calibration.h>
@@ -34,6 +35,9 @@
 #include <lal/AVFactories.h>
 #include <lal/FrequencySeries.h>
 #include <lal/TimeSeries.h>
+#include <lal/Date.h>
+#include <lal/VectorMath.h>
+#include <lal/LALThreadPool.h>
 
 #include <gsl/gsl_interp.h>
 #include <gsl/gsl_spline.h>
@@ -50,11 +54,17 @@
 #define N_FIR_HP 2000
 #define fhigh_FIRHP 0.00244140625
 
+/* streamed FIR filters with at least this many coefficients are applied by FFT-based overlap-save */
+#define N_FIR_STREAM_MIN_FFT 64
+
 
 
 /* Local helper functions, defined static so they cannot be used outside. */
 static void set_output_to_zero(StrainOut *output);
 static void check_nans_infs(LALStatus *status, StrainIn *input);
+static void make_fir_hp_coef(REAL8 *b);
+static REAL8FIRFilterStream *create_delay_stream(UINT4 delay);
+static int strain_stride_branch(void *arg, size_t i);
 #if 0
 static void remove_transients(StrainIn *input);
 #endif
@@ -425,8 +435,6 @@ void LALMakeFIRLPALPHAS(LALStatus *status, REAL8IIRFilter *LPFIR)
 void LALMakeFIRHP(LALStatus *status, REAL8IIRFilter *HPFIR)
 {
   int N=2*N_FIR_HP+1,l;
-  int k[2*N_FIR_HP+1];
-  REAL8 fN=fhigh_FIRHP;
 
   INITSTATUS(status);
   ATTATCHSTATUSPTR( status );
@@ -445,17 +453,7 @@ void LALMakeFIRHP(LALStatus *status, REAL8IIRFilter *HPFIR)
   for(l=0;l<N;l++) HPFIR->recursCoef->data[l]=0.0;
   for(l=0;l<N-1;l++) HPFIR->history->data[l]=0.0;
 
-  for (l=0; l<N;l++)
-    {
-      k[l]=l-N_FIR_HP;
-      if(k[l] != 0)
-	{
-	  HPFIR->directCoef->data[l]=(sin(LAL_PI*k[l])-sin(LAL_PI*fN*k[l]))/(LAL_PI*k[l])*
-	    exp(-0.5*pow(3.0*(double)k[l]/(double)N_FIR_HP,2));
-	}else{
-	  HPFIR->directCoef->data[l]=1.0-fN;
-	}
-    }
+  make_fir_hp_coef(HPFIR->directCoef->data);
 
 
 /*   for(l=0;l<N;l++) fprintf(stdout,"%1.16e\n", HPFIR->directCoef->data[l]); */
@@ -465,6 +463,25 @@ void LALMakeFIRHP(LALStatus *status, REAL8IIRFilter *HPFIR)
 
 }
 
+/* coefficients of the 2*N_FIR_HP+1 point high-pass filter of LALMakeFIRHP() */
+static void make_fir_hp_coef(REAL8 *b)
+{
+  int N=2*N_FIR_HP+1,l,k;
+  REAL8 fN=fhigh_FIRHP;
+
+  for (l=0; l<N;l++)
+    {
+      k=l-N_FIR_HP;
+      if(k != 0)
+	{
+	  b[l]=(sin(LAL_PI*k)-sin(LAL_PI*fN*k))/(LAL_PI*k)*
+	    exp(-0.5*pow(3.0*(double)k/(double)N_FIR_HP,2));
+	}else{
+	  b[l]=1.0-fN;
+	}
+    }
+}
+
 /*******************************************************************************/
 
 int XLALUpsample(REAL8TimeSeries *uphR, REAL8TimeSeries *hR, int up_factor)
@@ -805,6 +822,377 @@ void LALFFTFIRFilter(LALStatus *status, REAL8TimeSeries *tseries, REAL8IIRFilter
 }
 
 
+/*******************************************************************************/
+
+struct tagREAL8FIRFilterStream {
+  UINT4 ntaps;                  /* number of filter coefficients */
+  REAL8 *coef;                  /* filter coefficients, or NULL for a pure delay of ntaps-1 samples */
+  REAL8 *ext;                   /* last ntaps-1 input samples, followed by the current stride */
+  UINT4 extLength;              /* allocated length of ext */
+  UINT4 fftLength;              /* length of overlap-save FFTs, or 0 for direct convolution */
+  REAL8FFTPlan *fplan;          /* forward FFT plan of length fftLength */
+  REAL8FFTPlan *rplan;          /* reverse FFT plan of length fftLength */
+  COMPLEX16Vector *coefTilde;   /* FFT of the zero-padded coefficients, divided by fftLength */
+  REAL8Vector *seg;             /* overlap-save segment */
+  COMPLEX16Vector *segTilde;    /* FFT of overlap-save segment */
+};
+
+/**
+ * Create the state of a FIR filter with coefficients \c directCoef, applied to
+ * a stream of data in consecutive strides by XLALREAL8FIRFilterStream().
+ *
+ * Filters with at least 64 coefficients are applied by FFT-based overlap-save,
+ * with FFTs whose length is the smallest power of two of at least four times
+ * the length of the filter; shorter filters are applied by direct convolution.
+ */
+REAL8FIRFilterStream *XLALCreateREAL8FIRFilterStream(const REAL8Vector *directCoef)
+{
+  REAL8FIRFilterStream *stream;
+  UINT4 L;
+
+  XLAL_CHECK_NULL(directCoef != NULL && directCoef->data != NULL, XLAL_EFAULT);
+  XLAL_CHECK_NULL(directCoef->length > 0, XLAL_EINVAL);
+
+  stream = create_delay_stream(directCoef->length - 1);
+  XLAL_CHECK_NULL(stream != NULL, XLAL_EFUNC);
+
+  stream->coef = XLALMalloc(stream->ntaps * sizeof(*stream->coef));
+  XLAL_CHECK_NULL(stream->coef != NULL, XLAL_ENOMEM);
+  memcpy(stream->coef, directCoef->data, stream->ntaps * sizeof(*stream->coef));
+
+  if (stream->ntaps < N_FIR_STREAM_MIN_FFT)
+    return stream;
+
+  for (L = 1; L < 4 * stream->ntaps; L <<= 1);
+  stream->fftLength = L;
+  stream->fplan = XLALCreateForwardREAL8FFTPlan(L, 0);
+  stream->rplan = XLALCreateReverseREAL8FFTPlan(L, 0);
+  stream->coefTilde = XLALCreateCOMPLEX16Vector(L / 2 + 1);
+  stream->seg = XLALCreateREAL8Vector(L);
+  stream->segTilde = XLALCreateCOMPLEX16Vector(L / 2 + 1);
+  if (!stream->fplan || !stream->rplan || !stream->coefTilde || !stream->seg || !stream->segTilde) {
+    XLALDestroyREAL8FIRFilterStream(stream);
+    XLAL_ERROR_NULL(XLAL_EFUNC);
+  }
+
+  memset(stream->seg->data, 0, L * sizeof(*stream->seg->data));
+  memcpy(stream->seg->data, stream->coef, stream->ntaps * sizeof(*stream->coef));
+  if (XLALREAL8ForwardFFT(stream->coefTilde, stream->seg, stream->fplan) < 0) {
+    XLALDestroyREAL8FIRFilterStream(stream);
+    XLAL_ERROR_NULL(XLAL_EFUNC);
+  }
+  for (UINT4 k = 0; k < stream->coefTilde->length; k++)
+    stream->coefTilde->data[k] /= L;
+
+  return stream;
+}
+
+/* state of a delay line of delay samples, i.e. a FIR filter with a single unit coefficient */
+static REAL8FIRFilterStream *create_delay_stream(UINT4 delay)
+{
+  REAL8FIRFilterStream *stream = XLALCalloc(1, sizeof(*stream));
+  XLAL_CHECK_NULL(stream != NULL, XLAL_ENOMEM);
+  stream->ntaps = delay + 1;
+  stream->extLength = delay;
+  if (delay > 0) {
+    stream->ext = XLALCalloc(delay, sizeof(*stream->ext));
+    if (!stream->ext) {
+      XLALFree(stream);
+      XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+  }
+  return stream;
+}
+
+/** Destroy the state of a streamed FIR filter */
+void XLALDestroyREAL8FIRFilterStream(REAL8FIRFilterStream *stream)
+{
+  if (!stream)
+    return;
+  if (stream->coef)
+    XLALFree(stream->coef);
+  if (stream->ext)
+    XLALFree(stream->ext);
+  XLALDestroyREAL8FFTPlan(stream->fplan);
+  XLALDestroyREAL8FFTPlan(stream->rplan);
+  XLALDestroyCOMPLEX16Vector(stream->coefTilde);
+  XLALDestroyREAL8Vector(stream->seg);
+  XLALDestroyCOMPLEX16Vector(stream->segTilde);
+  XLALFree(stream);
+}
+
+/**
+ * Filter, in place, the next stride \c data of a stream of data with the FIR
+ * filter whose state is \c stream.
+ *
+ * The output is \f$y_n = \sum_m b_m x_{n-m}\f$, as for XLALFIRFilter(), where
+ * the samples \f$x_{n-m}\f$ before the start of the stride are those of the
+ * previous strides, and zero before the first stride. Filtering a stream in
+ * strides of any lengths therefore gives the same output as filtering it in
+ * one go; unlike XLALFIRFilter(), the start of the output is not set to zero.
+ */
+int XLALREAL8FIRFilterStream(REAL8Vector *data, REAL8FIRFilterStream *stream)
+{
+  UINT4 nhist, N;
+  REAL8 *ext;
+
+  XLAL_CHECK(data != NULL && stream != NULL, XLAL_EFAULT);
+  XLAL_CHECK(data->length == 0 || data->data != NULL, XLAL_EFAULT);
+
+  nhist = stream->ntaps - 1;
+  N = data->length;
+  if (N == 0)
+    return XLAL_SUCCESS;
+
+  /* append the stride to the history of the stream */
+  if (nhist + N > stream->extLength) {
+    ext = XLALRealloc(stream->ext, (nhist + N) * sizeof(*ext));
+    XLAL_CHECK(ext != NULL, XLAL_ENOMEM);
+    stream->ext = ext;
+    stream->extLength = nhist + N;
+  }
+  ext = stream->ext;
+  memcpy(ext + nhist, data->data, N * sizeof(*ext));
+
+  if (stream->coef == NULL) {
+    /* pure delay */
+    memcpy(data->data, ext, N * sizeof(*ext));
+  } else if (stream->fftLength == 0) {
+    /* direct convolution */
+    const REAL8 *b = stream->coef;
+    for (UINT4 n = 0; n < N; n++) {
+      const REAL8 *x = ext + nhist + n;
+      REAL8 sum = 0;
+      for (UINT4 m = 0; m <= nhist; m++)
+        sum += b[m] * x[-(INT4)m];
+      data->data[n] = sum;
+    }
+  } else {
+    /* overlap-save: the last fftLength-nhist samples of each circular
+     * convolution of a segment with the filter are free of wrap-around */
+    const UINT4 L = stream->fftLength, step = L - nhist;
+    REAL8 *seg = stream->seg->data;
+    for (UINT4 s = 0; s < N; s += step) {
+      const UINT4 nseg = (nhist + N - s < L) ? nhist + N - s : L;
+      memcpy(seg, ext + s, nseg * sizeof(*seg));
+      memset(seg + nseg, 0, (L - nseg) * sizeof(*seg));
+      XLAL_CHECK(XLALREAL8ForwardFFT(stream->segTilde, stream->seg, stream->fplan) == 0, XLAL_EFUNC);
+      XLAL_CHECK(XLALVectorMultiplyCOMPLEX16(stream->segTilde->data, stream->segTilde->data, stream->coefTilde->data, stream->segTilde->length) == XLAL_SUCCESS, XLAL_EFUNC);
+      XLAL_CHECK(XLALREAL8ReverseFFT(stream->seg, stream->segTilde, stream->rplan) == 0, XLAL_EFUNC);
+      for (UINT4 k = 0; k < step && s + k < N; k++)
+        data->data[s + k] = seg[nhist + k];
+    }
+  }
+
+  /* keep the last nhist input samples as the history for the next stride */
+  memmove(ext, ext + N, nhist * sizeof(*ext));
+
+  return XLAL_SUCCESS;
+}
+
+/*******************************************************************************/
+
+struct tagStrainReconstruction {
+  INT4 darmctrl;                /* control signal is DARM_CTRL, filtered by anti-whitening */
+  INT4 usefactors;              /* divide residual signal by calibration factors */
+  UINT4 latency;                /* delay of output behind input, in samples */
+  REAL8FIRFilterStream *Cinv;   /* inverse sensing function */
+  REAL8FIRFilterStream *HP[2];  /* high pass filter, applied twice to control signal */
+  REAL8FIRFilterStream *servo;  /* anti-whitening (darmctrl) or digital servo */
+  REAL8FIRFilterStream *A;      /* actuation function */
+  REAL8FIRFilterStream *delayR; /* aligns residual signal with output */
+  REAL8FIRFilterStream *delayC; /* aligns control signal with output */
+  REAL8FIRFilterStream *delayEXC; /* aligns excitation with filtered control signal */
+  REAL8Vector *exc;             /* delayed excitation */
+};
+
+/**
+ * Create the state of a streaming reconstruction of strain, with the filters
+ * and options of \c input, for XLALComputeStrainStride().
+ *
+ * The reconstruction applies the FIR filters of LALComputeStrain(), keeping
+ * their state across strides. The advances which LALComputeStrain() applies to
+ * compensate for filter delays are causal here: the output lags the input by
+ * XLALStrainReconstructionLatency() samples instead. The options \c delta and
+ * \c outalphas are not supported.
+ */
+StrainReconstruction *XLALCreateStrainReconstruction(const StrainIn *input)
+{
+  StrainReconstruction *recon;
+  REAL8Vector *hpcoef;
+  INT4 advR, advC;
+
+  XLAL_CHECK_NULL(input != NULL, XLAL_EFAULT);
+  XLAL_CHECK_NULL(input->Cinv != NULL && input->A != NULL, XLAL_EFAULT);
+  XLAL_CHECK_NULL((input->darmctrl ? input->AW : input->D) != NULL, XLAL_EFAULT);
+  XLAL_CHECK_NULL(input->CinvUSF == 1, XLAL_EINVAL, "Upsampling factor != 1, this is not a good filters file.");
+  XLAL_CHECK_NULL(!input->delta && !input->outalphas, XLAL_EINVAL, "Options delta and outalphas are not supported");
+
+  /* advances of residual and control signals applied by LALComputeStrain() */
+  advR = -input->CinvDelay;
+  advC = 2 * N_FIR_HP;
+
+  recon = XLALCalloc(1, sizeof(*recon));
+  XLAL_CHECK_NULL(recon != NULL, XLAL_ENOMEM);
+  recon->darmctrl = input->darmctrl;
+  recon->usefactors = input->usefactors;
+  recon->latency = (advR > advC) ? advR : advC;
+
+  hpcoef = XLALCreateREAL8Vector(2 * N_FIR_HP + 1);
+  if (hpcoef)
+    make_fir_hp_coef(hpcoef->data);
+
+  recon->Cinv = XLALCreateREAL8FIRFilterStream(input->Cinv->directCoef);
+  recon->HP[0] = hpcoef ? XLALCreateREAL8FIRFilterStream(hpcoef) : NULL;
+  recon->HP[1] = hpcoef ? XLALCreateREAL8FIRFilterStream(hpcoef) : NULL;
+  recon->servo = XLALCreateREAL8FIRFilterStream((input->darmctrl ? input->AW : input->D)->directCoef);
+  recon->A = XLALCreateREAL8FIRFilterStream(input->A->directCoef);
+  recon->delayR = create_delay_stream(recon->latency - advR);
+  recon->delayC = create_delay_stream(recon->latency - advC);
+  recon->delayEXC = create_delay_stream(advC);
+  XLALDestroyREAL8Vector(hpcoef);
+
+  if (!recon->Cinv || !recon->HP[0] || !recon->HP[1] || !recon->servo || !recon->A || !recon->delayR || !recon->delayC || !recon->delayEXC) {
+    XLALDestroyStrainReconstruction(recon);
+    XLAL_ERROR_NULL(XLAL_EFUNC);
+  }
+
+  return recon;
+}
+
+/** Destroy the state of a streaming reconstruction of strain */
+void XLALDestroyStrainReconstruction(StrainReconstruction *recon)
+{
+  if (!recon)
+    return;
+  XLALDestroyREAL8FIRFilterStream(recon->Cinv);
+  XLALDestroyREAL8FIRFilterStream(recon->HP[0]);
+  XLALDestroyREAL8FIRFilterStream(recon->HP[1]);
+  XLALDestroyREAL8FIRFilterStream(recon->servo);
+  XLALDestroyREAL8FIRFilterStream(recon->A);
+  XLALDestroyREAL8FIRFilterStream(recon->delayR);
+  XLALDestroyREAL8FIRFilterStream(recon->delayC);
+  XLALDestroyREAL8FIRFilterStream(recon->delayEXC);
+  XLALDestroyREAL8Vector(recon->exc);
+  XLALFree(recon);
+}
+
+/** Return the number of samples by which the output of a streaming reconstruction of strain lags its input */
+int XLALStrainReconstructionLatency(const StrainReconstruction *recon)
+{
+  XLAL_CHECK(recon != NULL, XLAL_EFAULT);
+  return (int)recon->latency;
+}
+
+typedef struct {
+  StrainReconstruction *recon;
+  StrainOut *output;
+  const StrainIn *input;
+  REAL8 alphabeta;
+  INT4 addexc;
+} StrainStride;
+
+/* filter one stride through the sensing (i == 0) or actuation (i == 1) branch */
+static int strain_stride_branch(void *arg, size_t i)
+{
+  StrainStride *stride = arg;
+  StrainReconstruction *recon = stride->recon;
+  const StrainIn *input = stride->input;
+  StrainOut *output = stride->output;
+  UINT4 p;
+
+  if (i == 0) {
+
+    /* ---------- residual strain: inverse sensing ---------- */
+    REAL8Vector *hR = output->hR.data;
+    for (p = 0; p < hR->length; p++)
+      hR->data[p] = input->DARM_ERR.data->data[p];
+    XLAL_CHECK(XLALREAL8FIRFilterStream(hR, recon->Cinv) == XLAL_SUCCESS, XLAL_EFUNC);
+    XLAL_CHECK(XLALREAL8FIRFilterStream(hR, recon->delayR) == XLAL_SUCCESS, XLAL_EFUNC);
+    if (recon->usefactors)
+      XLAL_CHECK(XLALVectorScaleREAL8(hR->data, 1.0 / stride->alphabeta, hR->data, hR->length) == XLAL_SUCCESS, XLAL_EFUNC);
+
+  } else {
+
+    /* ---------- control strain: high pass, servo or anti-whitening, actuation ---------- */
+    REAL8Vector *hC = output->hC.data;
+    const REAL4Vector *ctrl = recon->darmctrl ? input->DARM.data : input->DARM_ERR.data;
+    for (p = 0; p < hC->length; p++)
+      hC->data[p] = ctrl->data[p];
+    XLAL_CHECK(XLALREAL8FIRFilterStream(hC, recon->HP[0]) == XLAL_SUCCESS, XLAL_EFUNC);
+    XLAL_CHECK(XLALREAL8FIRFilterStream(hC, recon->HP[1]) == XLAL_SUCCESS, XLAL_EFUNC);
+    XLAL_CHECK(XLALREAL8FIRFilterStream(hC, recon->servo) == XLAL_SUCCESS, XLAL_EFUNC);
+    if (stride->addexc) {
+      /* add the calibration lines, delayed by the advance of the control signal */
+      for (p = 0; p < hC->length; p++)
+        recon->exc->data[p] = input->EXC.data->data[p];
+      XLAL_CHECK(XLALREAL8FIRFilterStream(recon->exc, recon->delayEXC) == XLAL_SUCCESS, XLAL_EFUNC);
+      XLAL_CHECK(XLALVectorAddREAL8(hC->data, hC->data, recon->exc->data, hC->length) == XLAL_SUCCESS, XLAL_EFUNC);
+    }
+    XLAL_CHECK(XLALREAL8FIRFilterStream(hC, recon->A) == XLAL_SUCCESS, XLAL_EFUNC);
+    XLAL_CHECK(XLALREAL8FIRFilterStream(hC, recon->delayC) == XLAL_SUCCESS, XLAL_EFUNC);
+
+  }
+
+  return XLAL_SUCCESS;
+}
+
+/**
+ * Reconstruct the next stride of strain from the DARM channels of \c input,
+ * using the filter state \c recon created by XLALCreateStrainReconstruction().
+ *
+ * The time series \c h, \c hC and \c hR of \c output must have the same length
+ * as \c input->DARM_ERR; their epochs are set to that of the input, less the
+ * latency of the reconstruction. If the reconstruction uses calibration factors,
+ * the residual signal of the stride is divided by \c alphabeta.
+ *
+ * The sensing and actuation branches are filtered concurrently, using the
+ * LALThreadPool_h thread pool.
+ */
+int XLALComputeStrainStride(StrainOut *output, StrainReconstruction *recon, const StrainIn *input, REAL8 alphabeta)
+{
+  StrainStride stride;
+  LIGOTimeGPS epoch;
+  UINT4 N;
+
+  XLAL_CHECK(output != NULL && recon != NULL && input != NULL, XLAL_EFAULT);
+  XLAL_CHECK(input->DARM_ERR.data != NULL, XLAL_EFAULT);
+  XLAL_CHECK(output->h.data != NULL && output->hC.data != NULL && output->hR.data != NULL, XLAL_EFAULT);
+  N = input->DARM_ERR.data->length;
+  XLAL_CHECK(output->h.data->length == N && output->hC.data->length == N && output->hR.data->length == N, XLAL_EBADLEN);
+  if (recon->darmctrl) {
+    XLAL_CHECK(input->DARM.data != NULL, XLAL_EFAULT);
+    XLAL_CHECK(input->DARM.data->length == N, XLAL_EBADLEN);
+  }
+  XLAL_CHECK(!recon->usefactors || (isfinite(alphabeta) && alphabeta != 0), XLAL_EDOM);
+
+  stride.recon = recon;
+  stride.output = output;
+  stride.input = input;
+  stride.alphabeta = alphabeta;
+  stride.addexc = !recon->darmctrl && input->EXC.data != NULL && input->DARM_ERR.deltaT == input->EXC.deltaT;
+  if (stride.addexc) {
+    XLAL_CHECK(input->EXC.data->length == N, XLAL_EBADLEN);
+    if (!recon->exc || recon->exc->length != N) {
+      XLALDestroyREAL8Vector(recon->exc);
+      recon->exc = XLALCreateREAL8Vector(N);
+      XLAL_CHECK(recon->exc != NULL, XLAL_EFUNC);
+    }
+  }
+
+  XLAL_CHECK(XLALThreadPoolRun(strain_stride_branch, &stride, 2) == XLAL_SUCCESS, XLAL_EFUNC);
+
+  /* ---------- net strain ---------- */
+  XLAL_CHECK(XLALVectorAddREAL8(output->h.data->data, output->hC.data->data, output->hR.data->data, N) == XLAL_SUCCESS, XLAL_EFUNC);
+
+  epoch = input->DARM_ERR.epoch;
+  XLALGPSAdd(&epoch, -(REAL8)recon->latency * input->DARM_ERR.deltaT);
+  output->h.epoch = output->hC.epoch = output->hR.epoch = epoch;
+  output->h.deltaT = output->hC.deltaT = output->hR.deltaT = input->DARM_ERR.deltaT;
+
+  return XLAL_SUCCESS;
+}
+
 
 /*
  * Check if there are any nans or infs in the input data.
@@ -92,6 +92,227 @@ void XLALComputeDetAMResponse(
 }
 
 
+/*
+ * F+ and Fx at zero polarization angle, from the trig functions of the
+ * Greenwich hour angle and declination.  D must be symmetric, as all
+ * detector response tensors are.
+ */
+static void detresponse_psi0(double *fplus0, double *fcross0, const double d[6], double cosgha, double singha, double cosdec, double sindec)
+{
+	/* Eqs. (B4) and (B5) of [ABCF] with psi = 0 */
+	const double X0 = -singha, X1 = -cosgha;
+	const double Y0 = -cosgha * sindec, Y1 = singha * sindec, Y2 = cosdec;
+	/* d = { D00, D01, D02, D11, D12, D22 } */
+	const double DX0 = d[0] * X0 + d[1] * X1;
+	const double DX1 = d[1] * X0 + d[3] * X1;
+	const double DY0 = d[0] * Y0 + d[1] * Y1 + d[2] * Y2;
+	const double DY1 = d[1] * Y0 + d[3] * Y1 + d[4] * Y2;
+	const double DY2 = d[2] * Y0 + d[4] * Y1 + d[5] * Y2;
+	*fplus0 = X0 * DX0 + X1 * DX1 - (Y0 * DY0 + Y1 * DY1 + Y2 * DY2);
+	*fcross0 = 2.0 * (X0 * DY0 + X1 * DY1);
+}
+
+
+/**
+ * Computes F+ and Fx for many sky positions, polarization angles and
+ * sidereal times at once.
+ *
+ * Each of \c ra, \c dec, \c psi and \c gmst has either the length of the
+ * output vectors, or length 1, in which case that value is used for all
+ * outputs.  The response is computed at zero polarization angle and rotated
+ * to \f$\psi\f$ with \f$F_+(\psi) = F_+(0) \cos 2\psi + F_\times(0) \sin
+ * 2\psi\f$, \f$F_\times(\psi) = F_\times(0) \cos 2\psi - F_+(0) \sin 2\psi\f$,
+ * and trig functions of inputs that are held fixed are computed only once.
+ * The results agree with XLALComputeDetAMResponse() to rounding error.
+ * Output vectors of length 0 are not an error;  nothing is computed.
+ */
+int XLALComputeDetAMResponseVectors(
+	REAL8Vector *fplus,		/**< Returned values of F+ */
+	REAL8Vector *fcross,		/**< Returned values of Fx */
+	const REAL4 D[3][3],		/**< Detector response 3x3 matrix */
+	const REAL8Vector *ra,		/**< Right ascensions of source (radians) */
+	const REAL8Vector *dec,		/**< Declinations of source (radians) */
+	const REAL8Vector *psi,		/**< Polarization angles of source (radians) */
+	const REAL8Vector *gmst		/**< Greenwich mean sidereal times (radians) */
+)
+{
+	double d[6];
+	double cosdec = 0, sindec = 0, cos2psi = 0, sin2psi = 0;
+	size_t sra, sdec, spsi, sgmst;
+	UINT4 n, i;
+
+	XLAL_CHECK(fplus && fcross && D && ra && dec && psi && gmst, XLAL_EFAULT);
+	n = fplus->length;
+	XLAL_CHECK(fcross->length == n, XLAL_EBADLEN, "Output vectors have different lengths");
+	XLAL_CHECK(ra->length == n || ra->length == 1, XLAL_EBADLEN, "Right ascension vector has length %u, not 1 or %u", ra->length, n);
+	XLAL_CHECK(dec->length == n || dec->length == 1, XLAL_EBADLEN, "Declination vector has length %u, not 1 or %u", dec->length, n);
+	XLAL_CHECK(psi->length == n || psi->length == 1, XLAL_EBADLEN, "Polarization angle vector has length %u, not 1 or %u", psi->length, n);
+	XLAL_CHECK(gmst->length == n || gmst->length == 1, XLAL_EBADLEN, "Sidereal time vector has length %u, not 1 or %u", gmst->length, n);
+	/* zero-length vectors have no data, and there is nothing to compute */
+	if(n == 0)
+		return 0;
+	XLAL_CHECK(fplus->data && fcross->data && ra->data && dec->data && psi->data && gmst->data, XLAL_EFAULT);
+
+	d[0] = D[0][0];
+	d[1] = D[0][1];
+	d[2] = D[0][2];
+	d[3] = D[1][1];
+	d[4] = D[1][2];
+	d[5] = D[2][2];
+
+	/* strides of 0 broadcast a single input value */
+	sra = ra->length == 1 ? 0 : 1;
+	sdec = dec->length == 1 ? 0 : 1;
+	spsi = psi->length == 1 ? 0 : 1;
+	sgmst = gmst->length == 1 ? 0 : 1;
+	if(!sdec) {
+		cosdec = cos(dec->data[0]);
+		sindec = sin(dec->data[0]);
+	}
+	if(!spsi) {
+		cos2psi = cos(2.0 * psi->data[0]);
+		sin2psi = sin(2.0 * psi->data[0]);
+	}
+
+	for(i = 0; i < n; i++) {
+		const double gha = gmst->data[i * sgmst] - ra->data[i * sra];
+		const double cd = sdec ? cos(dec->data[i]) : cosdec;
+		const double sd = sdec ? sin(dec->data[i]) : sindec;
+		const double c2p = spsi ? cos(2.0 * psi->data[i]) : cos2psi;
+		const double s2p = spsi ? sin(2.0 * psi->data[i]) : sin2psi;
+		double p0, x0;
+		detresponse_psi0(&p0, &x0, d, cos(gha), sin(gha), cd, sd);
+		fplus->data[i] = p0 * c2p + x0 * s2p;
+		fcross->data[i] = x0 * c2p - p0 * s2p;
+	}
+
+	return 0;
+}
+
+
+/**
+ * Tabulates F+ and Fx at zero polarization angle for a fixed sky position
+ * over one sidereal day, sampled at \c length evenly-spaced values of the
+ * Greenwich mean sidereal time.  The response at any polarization angle
+ * and sidereal time is then obtained with XLALDetAMResponseTableEval().
+ * Since the response is a trigonometric polynomial of second order in the
+ * sidereal time, a table of 1440 entries (one per sidereal minute) gives
+ * interpolation errors of order \f$10^{-10}\f$.
+ */
+LALDetAMResponseTable *XLALCreateDetAMResponseTable(
+	const REAL4 D[3][3],	/**< Detector response 3x3 matrix */
+	double ra,		/**< Right ascension of source (radians) */
+	double dec,		/**< Declination of source (radians) */
+	UINT4 length		/**< Number of sidereal times in the table (at least 4) */
+)
+{
+	LALDetAMResponseTable *table;
+	REAL8Vector *gmst, *zero, *ravec, *decvec;
+	int status;
+	UINT4 i;
+
+	XLAL_CHECK_NULL(D, XLAL_EFAULT);
+	XLAL_CHECK_NULL(length >= 4, XLAL_EINVAL, "Table needs at least 4 entries, not %u", length);
+
+	table = XLALCalloc(1, sizeof(*table));
+	XLAL_CHECK_NULL(table, XLAL_ENOMEM);
+	table->ra = ra;
+	table->dec = dec;
+	table->fplus = XLALCreateREAL8Vector(length);
+	table->fcross = XLALCreateREAL8Vector(length);
+	gmst = XLALCreateREAL8Vector(length);
+	zero = XLALCreateREAL8Vector(1);
+	ravec = XLALCreateREAL8Vector(1);
+	decvec = XLALCreateREAL8Vector(1);
+	if(!table->fplus || !table->fcross || !gmst || !zero || !ravec || !decvec) {
+		status = XLAL_FAILURE;
+	} else {
+		for(i = 0; i < length; i++)
+			gmst->data[i] = LAL_TWOPI * i / length;
+		zero->data[0] = 0.0;
+		ravec->data[0] = ra;
+		decvec->data[0] = dec;
+		status = XLALComputeDetAMResponseVectors(table->fplus, table->fcross, D, ravec, decvec, zero, gmst);
+	}
+	XLALDestroyREAL8Vector(gmst);
+	XLALDestroyREAL8Vector(zero);
+	XLALDestroyREAL8Vector(ravec);
+	XLALDestroyREAL8Vector(decvec);
+	if(status < 0) {
+		XLALDestroyDetAMResponseTable(table);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
+
+	return table;
+}
+
+
+/**
+ * Destroys a table created with XLALCreateDetAMResponseTable().
+ */
+void XLALDestroyDetAMResponseTable(LALDetAMResponseTable *table)
+{
+	if(table) {
+		XLALDestroyREAL8Vector(table->fplus);
+		XLALDestroyREAL8Vector(table->fcross);
+		XLALFree(table);
+	}
+}
+
+
+/**
+ * Evaluates F+ and Fx from a table created with
+ * XLALCreateDetAMResponseTable(), at polarization angle \c psi and
+ * Greenwich mean sidereal time \c gmst (both in radians;  \c gmst need not
+ * be reduced to \f$[0, 2\pi)\f$).  The table is interpolated with a
+ * periodic four-point Lagrange polynomial.
+ */
+int XLALDetAMResponseTableEval(
+	double *fplus,				/**< Returned value of F+ */
+	double *fcross,				/**< Returned value of Fx */
+	const LALDetAMResponseTable *table,	/**< Response table */
+	double psi,				/**< Polarization angle of source (radians) */
+	double gmst				/**< Greenwich mean sidereal time (radians) */
+)
+{
+	const REAL8 *tp, *tx;
+	double x, u, w[4], p0 = 0.0, x0 = 0.0;
+	UINT4 n, k;
+	int j;
+
+	XLAL_CHECK(fplus && fcross && table && table->fplus && table->fcross, XLAL_EFAULT);
+	XLAL_CHECK(isfinite(gmst), XLAL_EDOM, "Sidereal time is not finite");
+	n = table->fplus->length;
+	tp = table->fplus->data;
+	tx = table->fcross->data;
+
+	/* position within the table, reduced to [0, n) */
+	x = fmod(gmst / LAL_TWOPI, 1.0) * n;
+	if(x < 0.0)
+		x += n;
+	k = (UINT4) x;
+	if(k >= n)
+		k = n - 1;
+	u = x - k;
+
+	/* Lagrange weights for nodes at -1, 0, 1, 2 */
+	w[0] = -u * (u - 1.0) * (u - 2.0) / 6.0;
+	w[1] = (u + 1.0) * (u - 1.0) * (u - 2.0) / 2.0;
+	w[2] = -(u + 1.0) * u * (u - 2.0) / 2.0;
+	w[3] = (u + 1.0) * u * (u - 1.0) / 6.0;
+	for(j = 0; j < 4; j++) {
+		const UINT4 m = (k + n + j - 1) % n;
+		p0 += w[j] * tp[m];
+		x0 += w[j] * tx[m];
+	}
+
+	*fplus = p0 * cos(2.0 * psi) + x0 * sin(2.0 * psi);
+	*fcross = x0 * cos(2.0 * psi) - p0 * sin(2.0 * psi);
+
+	return 0;
+}
+
+
 /**
  *
  * An implementation of the detector response for all six tensor, vector and
@@ -427,38 +648,55 @@ void LALComputeDetAMResponse(LALStatus * status, LALDetAMResponse * pResponse, c
 
 /**
  * Computes REAL4TimeSeries containing time series of response amplitudes.
+ * If \c n is 0, the time series are created with length 0 and no error is
+ * raised, as before the series were computed with
+ * XLALComputeDetAMResponseVectors().
  * \see XLALComputeDetAMResponse() for more details.
  */
 int XLALComputeDetAMResponseSeries(REAL4TimeSeries ** fplus, REAL4TimeSeries ** fcross, const REAL4 D[3][3], const double ra, const double dec, const double psi, const LIGOTimeGPS * start, const double deltaT, const int n)
 {
-	LIGOTimeGPS t;
-	double gmst;
-	int i;
-	double p, c;
+	REAL8Vector *gmst, *p, *c, *ravec, *decvec, *psivec;
+	int i, status = 0;
 
 	*fplus = XLALCreateREAL4TimeSeries("plus", start, 0.0, deltaT, &lalDimensionlessUnit, n);
 	*fcross = XLALCreateREAL4TimeSeries("cross", start, 0.0, deltaT, &lalDimensionlessUnit, n);
-	if(!*fplus || !*fcross) {
+	gmst = XLALCreateREAL8Vector(n);
+	p = XLALCreateREAL8Vector(n);
+	c = XLALCreateREAL8Vector(n);
+	ravec = XLALCreateREAL8Vector(1);
+	decvec = XLALCreateREAL8Vector(1);
+	psivec = XLALCreateREAL8Vector(1);
+	if(!*fplus || !*fcross || !gmst || !p || !c || !ravec || !decvec || !psivec)
+		status = XLAL_FAILURE;
+
+	if(!status)
+		status = XLALGreenwichMeanSiderealTimeGrid(gmst->data, start, deltaT, n);
+
+	/* evaluate the response for all sidereal times at once */
+	if(!status) {
+		ravec->data[0] = ra;
+		decvec->data[0] = dec;
+		psivec->data[0] = psi;
+		status = XLALComputeDetAMResponseVectors(p, c, D, ravec, decvec, psivec, gmst);
+	}
+	for(i = 0; i < n && !status; i++) {
+		(*fplus)->data->data[i] = p->data[i];
+		(*fcross)->data->data[i] = c->data[i];
+	}
+
+	XLALDestroyREAL8Vector(gmst);
+	XLALDestroyREAL8Vector(p);
+	XLALDestroyREAL8Vector(c);
+	XLALDestroyREAL8Vector(ravec);
+	XLALDestroyREAL8Vector(decvec);
+	XLALDestroyREAL8Vector(psivec);
+	if(status < 0) {
 		XLALDestroyREAL4TimeSeries(*fplus);
 		XLALDestroyREAL4TimeSeries(*fcross);
 		*fplus = *fcross = NULL;
 		XLAL_ERROR(XLAL_EFUNC);
 	}
 
-	for(i = 0; i < n; i++) {
-		t = *start;
-		gmst = XLALGreenwichMeanSiderealTime(XLALGPSAdd(&t, i * deltaT));
-		if(XLAL_IS_REAL8_FAIL_NAN(gmst)) {
-			XLALDestroyREAL4TimeSeries(*fplus);
-			XLALDestroyREAL4TimeSeries(*fcross);
-			*fplus = *fcross = NULL;
-			XLAL_ERROR(XLAL_EFUNC);
-		}
-		XLALComputeDetAMResponse(&p, &c, D, ra, dec, psi, gmst);
-		(*fplus)->data->data[i] = p;
-		(*fcross)->data->data[i] = c;
-	}
-
 	return 0;
 }
 
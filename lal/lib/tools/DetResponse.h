@@ -172,6 +172,24 @@ tagLALTimeIntervalAndNSample
 }
 LALTimeIntervalAndNSample;
 
+/**
+ * Tabulated detector response to a source at a fixed sky position, over
+ * one sidereal day.  Created by XLALCreateDetAMResponseTable() and
+ * evaluated with XLALDetAMResponseTableEval().
+ */
+#ifdef SWIG /* SWIG interface directives */
+SWIGLAL(IMMUTABLE_MEMBERS(tagLALDetAMResponseTable, fplus, fcross));
+#endif /* SWIG */
+typedef struct
+tagLALDetAMResponseTable
+{
+  REAL8        ra;	/**< Right ascension of source (radians) */
+  REAL8        dec;	/**< Declination of source (radians) */
+  REAL8Vector *fplus;	/**< F+ at zero polarization angle, at sidereal times \f$2\pi k/n\f$ */
+  REAL8Vector *fcross;	/**< Fx at zero polarization angle, at sidereal times \f$2\pi k/n\f$ */
+}
+LALDetAMResponseTable;
+
 /*
  * Function prototypes
  */
@@ -192,6 +210,35 @@ void XLALComputeDetAMResponse(
 	const double gmst
 );
 
+int XLALComputeDetAMResponseVectors(
+	REAL8Vector *fplus,
+	REAL8Vector *fcross,
+	const REAL4 D[3][3],
+	const REAL8Vector *ra,
+	const REAL8Vector *dec,
+	const REAL8Vector *psi,
+	const REAL8Vector *gmst
+);
+
+LALDetAMResponseTable *XLALCreateDetAMResponseTable(
+	const REAL4 D[3][3],
+	double ra,
+	double dec,
+	UINT4 length
+);
+
+void XLALDestroyDetAMResponseTable(
+	LALDetAMResponseTable *table
+);
+
+int XLALDetAMResponseTableEval(
+	double *fplus,
+	double *fcross,
+	const LALDetAMResponseTable *table,
+	double psi,
+	double gmst
+);
+
 
 void XLALComputeDetAMResponseExtraModes(
   double *fplus,
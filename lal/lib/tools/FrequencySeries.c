@@ -21,6 +21,7 @@
 #include <math.h>
 #include <string.h>
 #include <lal/Date.h>
+#include <lal/LALArena.h>
 #include <lal/LALDatatypes.h>
 #include <lal/LALStdlib.h>
 #include <lal/FrequencySeries.h>
@@ -1,10 +1,13 @@
 #define CONCAT2x(a,b) a##b
 #define CONCAT2(a,b) CONCAT2x(a,b)
+#define CONCAT3x(a,b,c) a##b##c
+#define CONCAT3(a,b,c) CONCAT3x(a,b,c)
 
 #define SERIESTYPE CONCAT2(DATATYPE,FrequencySeries)
 #define SEQUENCETYPE CONCAT2(DATATYPE,Sequence)
 
 #define DSERIES CONCAT2(XLALDestroy,SERIESTYPE)
+#define PSERIES CONCAT3(XLALDestroy,SERIESTYPE,Parked)
 #define CSERIES CONCAT2(XLALCreate,SERIESTYPE)
 #define XSERIES CONCAT2(XLALCut,SERIESTYPE)
 #define RSERIES CONCAT2(XLALResize,SERIESTYPE)
@@ -17,10 +20,22 @@
 #define XSEQUENCE CONCAT2(XLALCut,SEQUENCETYPE)
 #define RSEQUENCE CONCAT2(XLALResize,SEQUENCETYPE)
 
+/* destructor with which series are parked in arenas; see LALArena.h */
+static void PSERIES (
+	void *series
+)
+{
+	DSERIES (series);
+}
+
+
 void DSERIES (
 	SERIESTYPE *series
 )
 {
+	/* park series with allocated data in the active arena, if any */
+	if(series && series->data && series->data->data && XLALArenaPark(series, PSERIES, series->data->length))
+		return;
 	if(series)
 		DSEQUENCE (series->data);
 	XLALFree(series);
@@ -39,12 +54,18 @@ SERIESTYPE *CSERIES (
 	SERIESTYPE *new;
 	SEQUENCETYPE *sequence;
 
-	new = XLALMalloc(sizeof(*new));
-	sequence = CSEQUENCE (length);
-	if(!new || !sequence) {
-		XLALFree(new);
-		DSEQUENCE (sequence);
-		XLAL_ERROR_NULL(XLAL_EFUNC);
+	/* reuse a series of the same length parked in the active arena, if any */
+	new = XLALArenaTake(PSERIES, length);
+	if(new) {
+		sequence = new->data;
+	} else {
+		new = XLALMalloc(sizeof(*new));
+		sequence = CSEQUENCE (length);
+		if(!new || !sequence) {
+			XLALFree(new);
+			DSEQUENCE (sequence);
+			XLAL_ERROR_NULL(XLAL_EFUNC);
+		}
 	}
 
 	if(name) {
@@ -240,6 +261,7 @@ SERIESTYPE *MSERIES (
 #undef SEQUENCETYPE
 
 #undef DSERIES
+#undef PSERIES
 #undef CSERIES
 #undef XSERIES
 #undef RSERIES
@@ -18,9 +18,23 @@
 */
 
 /*
- * Dictionary is implemented as a hash search with algorithm adopted
- * from "The C Programming Language" by Kernighan and Ritchie, 2nd ed.
- * section 6.6.
+ * Dictionary is implemented as a hash table with open addressing and
+ * linear probing, following LALHashTbl, and keys hashed with LALCityHash.
+ * Each entry caches the hash of its key, so that the table can be grown
+ * and probed without rehashing keys; lookups through a LALDictKey handle
+ * reuse a hash computed once for that handle.
+ *
+ * Entries are also chained into LAL_DICT_HASHSIZE buckets, using the hash
+ * of the original implementation (adopted from "The C Programming Language"
+ * by Kernighan and Ritchie, 2nd ed., section 6.6); iteration follows these
+ * chains, and so visits entries in the same order as it always has.
+ *
+ * The table of entries is reference counted, so that XLALDictDuplicate()
+ * only needs to share it with the new dictionary. A dictionary takes its
+ * own copy of a shared table before the table is modified, or before
+ * entries are handed out which the caller could modify. Once entries have
+ * been handed out, the caller may still hold them, and so the table is
+ * never shared again; XLALDictDuplicate() then makes a deep copy.
  */
 
 #include <stdio.h>
@@ -31,29 +45,267 @@
 #include <lal/LALStdio.h>
 #include <lal/LALStdlib.h>
 #include <lal/LALDict.h>
+#include <lal/LALHashFunc.h>
 #include "LALValue_private.h"
 
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
+
+/* minimum size of a non-empty hash table; must be a power of 2 */
+#define LAL_DICT_MIN_DATA_LEN 16
+
+/* number of buckets which determine the iteration order */
 #define LAL_DICT_HASHSIZE 101
 
 struct tagLALDictEntry {
         struct tagLALDictEntry *next;
+	UINT8 hash;
         char key[LAL_KEYNAME_MAX + 1];
 	LALValue value;
 };
 
+/* Table of dictionary entries, which may be shared between duplicated dictionaries */
+typedef struct tagLALDictTable {
+	LALDictEntry *buckets[LAL_DICT_HASHSIZE];	/* entries chained in iteration order */
+	LALDictEntry **data;	/* hash table with open addressing and linear probing */
+	size_t data_len;	/* size of 'data', in number of elements; 0 or a power of 2 */
+	size_t n;		/* number of entries in the table */
+	size_t q;		/* number of non-NULL elements of 'data' */
+	int refcount;		/* number of dictionaries sharing the table */
+	int exposed;		/* whether modifiable entries have been handed out */
+} LALDictTable;
+
 struct tagLALDict {
-	size_t size;
-	struct tagLALDictEntry *hashes[];
+	LALDictTable *table;
 };
 
-static size_t hash(const char *s)
+/* Special hash table element value to indicate entries that have been removed */
+static const void *dict_del = 0;
+#define DEL ((LALDictEntry *) &dict_del)
+
+/*
+ * Reference counts and key handle hashes may be accessed from different
+ * threads, and are updated atomically where the compiler supports it;
+ * otherwise they are updated under a single mutex.
+ */
+
+#if defined(__GNUC__)
+
+static inline int RefCountGet(int *p) { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+static inline void RefCountInc(int *p) { __atomic_add_fetch(p, 1, __ATOMIC_RELAXED); }
+static inline int RefCountDec(int *p) { return __atomic_sub_fetch(p, 1, __ATOMIC_ACQ_REL); }
+static inline UINT8 KeyHashGet(UINT8 *p) { return __atomic_load_n(p, __ATOMIC_RELAXED); }
+static inline void KeyHashSet(UINT8 *p, UINT8 h) { __atomic_store_n(p, h, __ATOMIC_RELAXED); }
+
+#else
+
+#ifdef LAL_PTHREAD_LOCK
+static pthread_mutex_t dict_mut = PTHREAD_MUTEX_INITIALIZER;
+#define DICT_LOCK   pthread_mutex_lock(&dict_mut)
+#define DICT_UNLOCK pthread_mutex_unlock(&dict_mut)
+#else
+#define DICT_LOCK
+#define DICT_UNLOCK
+#endif
+
+static inline int RefCountGet(int *p) { DICT_LOCK; int r = *p; DICT_UNLOCK; return r; }
+static inline void RefCountInc(int *p) { DICT_LOCK; ++*p; DICT_UNLOCK; }
+static inline int RefCountDec(int *p) { DICT_LOCK; int r = --*p; DICT_UNLOCK; return r; }
+static inline UINT8 KeyHashGet(UINT8 *p) { DICT_LOCK; UINT8 r = *p; DICT_UNLOCK; return r; }
+static inline void KeyHashSet(UINT8 *p, UINT8 h) { DICT_LOCK; *p = h; DICT_UNLOCK; }
+
+#endif
+
+/* hash of a key; never 0, which marks a LALDictKey whose hash is yet to be computed */
+static UINT8 hash(const char *s)
+{
+	UINT8 hashval = XLALCityHash64(s, strlen(s));
+	return hashval ? hashval : 1;
+}
+
+/* bucket of a key, which determines its place in the iteration order */
+static size_t bucket(const char *s)
 {
 	size_t hashval;
 	for (hashval = 0; *s != '\0'; ++s)
 		hashval = *s + 31 * hashval;
+	return hashval % LAL_DICT_HASHSIZE;
+}
+
+static UINT8 keyhash(LALDictKey *key)
+{
+	UINT8 hashval = KeyHashGet(&key->hash);
+	if (hashval == 0) {
+		hashval = hash(key->name);
+		KeyHashSet(&key->hash, hashval);
+	}
 	return hashval;
 }
 
+/* TABLE ROUTINES */
+
+static LALDictTable * XLALDictTableCreate(void)
+{
+	LALDictTable *table = XLALCalloc(1, sizeof(*table));
+	if (!table)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	table->refcount = 1;
+	return table;
+}
+
+static void XLALDictTableRelease(LALDictTable *table)
+{
+	if (table && RefCountDec(&table->refcount) == 0) {
+		size_t i;
+		for (i = 0; i < LAL_DICT_HASHSIZE; ++i)
+			XLALDictEntryFree(table->buckets[i]);
+		LALFree(table->data);
+		LALFree(table);
+	}
+	return;
+}
+
+/* returns the element of the table holding the entry for key, or NULL if there is none */
+static LALDictEntry ** XLALDictTableFind(const LALDictTable *table, const char *key, UINT8 hashval)
+{
+	size_t i, mask;
+	if (table->data_len == 0)
+		return NULL;
+	mask = table->data_len - 1;
+	for (i = hashval & mask; table->data[i] != NULL; i = (i + 1) & mask) {
+		LALDictEntry *entry = table->data[i];
+		if (entry != DEL && entry->hash == hashval && strcmp(entry->key, key) == 0)
+			return &table->data[i];
+	}
+	return NULL;
+}
+
+/* returns the link in its bucket chain which points to an entry of the table */
+static LALDictEntry ** XLALDictTableLink(LALDictTable *table, const LALDictEntry *entry)
+{
+	LALDictEntry **link = &table->buckets[bucket(entry->key)];
+	while (*link != entry)
+		link = &(*link)->next;
+	return link;
+}
+
+/* resize and rebuild the table, if needed, so that one more entry can be added */
+static int XLALDictTableReserve(LALDictTable *table)
+{
+	LALDictEntry **old_data = table->data;
+	size_t old_data_len = table->data_len;
+	size_t data_len, i;
+
+	/* keep at most 2/3 of the table elements non-NULL */
+	if (3 * (table->q + 1) <= 2 * table->data_len)
+		return 0;
+
+	data_len = LAL_DICT_MIN_DATA_LEN;
+	while (data_len < 2 * (table->n + 1))
+		data_len *= 2;
+	table->data = XLALCalloc(data_len, sizeof(*table->data));
+	if (!table->data) {
+		table->data = old_data;
+		XLAL_ERROR(XLAL_ENOMEM);
+	}
+	table->data_len = data_len;
+	table->q = table->n;
+	for (i = 0; i < old_data_len; ++i) {
+		LALDictEntry *entry = old_data[i];
+		if (entry != NULL && entry != DEL) {
+			size_t j = entry->hash & (data_len - 1);
+			while (table->data[j] != NULL)
+				j = (j + 1) & (data_len - 1);
+			table->data[j] = entry;
+		}
+	}
+	LALFree(old_data);
+	return 0;
+}
+
+/* place an entry whose key is not in the table; XLALDictTableReserve() must have been called */
+static void XLALDictTablePlace(LALDictTable *table, LALDictEntry *entry)
+{
+	size_t mask = table->data_len - 1;
+	size_t i = entry->hash & mask;
+	while (table->data[i] != NULL && table->data[i] != DEL)
+		i = (i + 1) & mask;
+	if (table->data[i] == NULL)
+		++table->q;
+	table->data[i] = entry;
+	++table->n;
+	return;
+}
+
+/* add an entry whose key is not in the table, at the head of its bucket chain */
+static void XLALDictTableAdd(LALDictTable *table, LALDictEntry *entry)
+{
+	size_t b = bucket(entry->key);
+	XLALDictTablePlace(table, entry);
+	entry->next = table->buckets[b];
+	table->buckets[b] = entry;
+	return;
+}
+
+/* make a deep copy of a table, which keeps the iteration order of the original */
+static LALDictTable * XLALDictTableCopy(const LALDictTable *old)
+{
+	LALDictTable *table;
+	size_t i;
+	table = XLALDictTableCreate();
+	if (!table)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	if (old->data_len > 0) {
+		table->data = XLALCalloc(old->data_len, sizeof(*table->data));
+		if (!table->data) {
+			XLALDictTableRelease(table);
+			XLAL_ERROR_NULL(XLAL_ENOMEM);
+		}
+		table->data_len = old->data_len;
+	}
+	for (i = 0; i < LAL_DICT_HASHSIZE; ++i) {
+		LALDictEntry **tail = &table->buckets[i];
+		const LALDictEntry *entry;
+		for (entry = old->buckets[i]; entry != NULL; entry = entry->next) {
+			size_t size = sizeof(*entry) + entry->value.size;
+			LALDictEntry *copy = XLALMalloc(size);
+			if (!copy) {
+				XLALDictTableRelease(table);
+				XLAL_ERROR_NULL(XLAL_ENOMEM);
+			}
+			memcpy(copy, entry, size);
+			copy->next = NULL;
+			*tail = copy;
+			tail = &copy->next;
+			XLALDictTablePlace(table, copy);
+		}
+	}
+	return table;
+}
+
+/* give the dictionary its own copy of its table, if the table is shared */
+static int XLALDictUnshare(LALDict *dict)
+{
+	LALDictTable *table = dict->table;
+	if (RefCountGet(&table->refcount) == 1)
+		return 0;
+	dict->table = XLALDictTableCopy(table);
+	if (!dict->table) {
+		dict->table = table;
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+	XLALDictTableRelease(table);
+	return 0;
+}
+
+/* warning: shallow pointer; entries of a shared table must not be modified */
+static const LALValue * XLALDictTableLookupValue(const LALDictTable *table, const char *key, UINT8 hashval)
+{
+	LALDictEntry **slot = XLALDictTableFind(table, key, hashval);
+	return slot ? &(*slot)->value : NULL;
+}
+
 /* DICT ENTRY ROUTINES */
 
 void XLALDictEntryFree(LALDictEntry *list)
@@ -72,6 +324,8 @@ LALDictEntry * XLALDictEntryAlloc(size_t size)
 	entry = XLALMalloc(sizeof(*entry) + size);
 	if (!entry)
 		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	entry->next = NULL;
+	entry->hash = 0;
 	entry->value.size = size;
 	return entry;
 }
@@ -93,6 +347,7 @@ LALDictEntry * XLALDictEntrySetKey(LALDictEntry *entry, const char *key)
 {
 	if ((size_t)snprintf(entry->key, sizeof(entry->key), "%s", key) >= sizeof(entry->key))
 		XLAL_ERROR_NULL(XLAL_ENAME, "Key name `%s' too long (max %d characters)", key, LAL_KEYNAME_MAX);
+	entry->hash = hash(entry->key);
 	return entry;
 }
 
@@ -118,9 +373,7 @@ const LALValue * XLALDictEntryGetValue(const LALDictEntry *entry)
 void XLALDestroyDict(LALDict *dict)
 {
 	if (dict) {
-		size_t i;
-		for (i = 0; i < dict->size; ++i)
-			XLALDictEntryFree(dict->hashes[i]);
+		XLALDictTableRelease(dict->table);
 		LALFree(dict);
 	}
 	return;
@@ -131,19 +384,25 @@ void XLALDestroyDict(LALDict *dict)
 LALDict * XLALCreateDict(void)
 {
 	LALDict *dict;
-	dict = XLALCalloc(1, sizeof(dict) + LAL_DICT_HASHSIZE * sizeof(*dict->hashes));
+	dict = XLALMalloc(sizeof(*dict));
 	if (!dict)
 		XLAL_ERROR_NULL(XLAL_ENOMEM);
-	dict->size = LAL_DICT_HASHSIZE;
+	dict->table = XLALDictTableCreate();
+	if (!dict->table) {
+		LALFree(dict);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
 	return dict;
 }
 
 void XLALDictForeach(LALDict *dict, void (*func)(char *, LALValue *, void *), void *thunk)
 {
 	size_t i;
-	for (i = 0; i < dict->size; ++i) {
+	if (XLALDictUnshare(dict) < 0)
+		XLAL_ERROR_VOID(XLAL_EFUNC);
+	for (i = 0; i < LAL_DICT_HASHSIZE; ++i) {
 		LALDictEntry *entry;
-		for (entry = dict->hashes[i]; entry != NULL; entry = entry->next)
+		for (entry = dict->table->buckets[i]; entry != NULL; entry = entry->next)
 			func(entry->key, &entry->value, thunk);
 	}
 	return;
@@ -152,11 +411,15 @@ void XLALDictForeach(LALDict *dict, void (*func)(char *, LALValue *, void *), vo
 LALDictEntry * XLALDictFind(LALDict *dict, int (*func)(const char *, const LALValue *, void *), void *thunk)
 {
 	size_t i;
-	for (i = 0; i < dict->size; ++i) {
+	if (XLALDictUnshare(dict) < 0)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	for (i = 0; i < LAL_DICT_HASHSIZE; ++i) {
 		LALDictEntry *entry;
-		for (entry = dict->hashes[i]; entry != NULL; entry = entry->next)
-			if (func(entry->key, &entry->value, thunk))
+		for (entry = dict->table->buckets[i]; entry != NULL; entry = entry->next)
+			if (func(entry->key, &entry->value, thunk)) {
+				dict->table->exposed = 1;
 				return entry;
+			}
 	}
 	return NULL;
 }
@@ -166,6 +429,9 @@ void XLALDictIterInit(LALDictIter *iter, LALDict *dict)
 	iter->dict = dict;
 	iter->pos = 0;
 	iter->next = NULL;
+	if (XLALDictUnshare(dict) < 0)
+		XLAL_ERROR_VOID(XLAL_EFUNC);
+	dict->table->exposed = 1;
 	return;
 }
 
@@ -180,35 +446,34 @@ LALDictEntry * XLALDictIterNext(LALDictIter *iter)
 		}
 
 		/* check end of iteration */
-		if (iter->pos >= iter->dict->size)
+		if (iter->pos >= LAL_DICT_HASHSIZE)
 			return NULL;
 
-		iter->next = iter->dict->hashes[iter->pos++];
+		iter->next = iter->dict->table->buckets[iter->pos++];
 	}
 	return NULL;
 }
 
 LALDict * XLALDictDuplicate(LALDict *old)
 {
-    UINT4 i;
-    int retcode;
-    if(old==NULL) return NULL;
-    LALDict *new = XLALCreateDict();
-    if (!new)
-        XLAL_ERROR_NULL(XLAL_ENOMEM);
-    for (i = 0; i < old->size; ++i) {
-        const LALDictEntry *entry;
-        for (entry = old->hashes[i]; entry != NULL; entry = entry->next) {
-            const char *key = XLALDictEntryGetKey(entry);
-            XLAL_TRY(XLALDictInsertValue(new, key, XLALDictEntryGetValue(entry)), retcode);
-            if(retcode!=XLAL_SUCCESS)
-            {
-                XLALDestroyDict(new);
-                XLAL_ERROR_NULL(retcode & XLAL_EFUNC);
-            }
-        }
-    }
-    return(new);
+	LALDict *new;
+	if (old == NULL)
+		return NULL;
+	new = XLALMalloc(sizeof(*new));
+	if (!new)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	if (old->table->exposed) {
+		/* entries of the table may still be modified through handles */
+		new->table = XLALDictTableCopy(old->table);
+		if (!new->table) {
+			LALFree(new);
+			XLAL_ERROR_NULL(XLAL_EFUNC);
+		}
+	} else {
+		new->table = old->table;
+		RefCountInc(&new->table->refcount);
+	}
+	return new;
 }
 
 LALList * XLALDictKeys(const LALDict *dict)
@@ -218,9 +483,9 @@ LALList * XLALDictKeys(const LALDict *dict)
 	list = XLALCreateList();
 	if (!list)
 		XLAL_ERROR_NULL(XLAL_EFUNC);
-	for (i = 0; i < dict->size; ++i) {
+	for (i = 0; i < LAL_DICT_HASHSIZE; ++i) {
 		const LALDictEntry *entry;
-		for (entry = dict->hashes[i]; entry != NULL; entry = entry->next) {
+		for (entry = dict->table->buckets[i]; entry != NULL; entry = entry->next) {
 			const char *key = XLALDictEntryGetKey(entry);
 			if (XLALListAddStringValue(list, key) < 0) {
 				XLALDestroyList(list);
@@ -238,9 +503,9 @@ LALList * XLALDictValues(const LALDict *dict)
 	list = XLALCreateList();
 	if (!list)
 		XLAL_ERROR_NULL(XLAL_EFUNC);
-	for (i = 0; i < dict->size; ++i) {
+	for (i = 0; i < LAL_DICT_HASHSIZE; ++i) {
 		const LALDictEntry *entry;
-		for (entry = dict->hashes[i]; entry != NULL; entry = entry->next) {
+		for (entry = dict->table->buckets[i]; entry != NULL; entry = entry->next) {
 			const LALValue *value = XLALDictEntryGetValue(entry);
 			if (XLALListAddValue(list, value) < 0) {
 				XLALDestroyList(list);
@@ -253,82 +518,64 @@ LALList * XLALDictValues(const LALDict *dict)
 
 int XLALDictContains(const LALDict *dict, const char *key)
 {
-	const LALDictEntry *entry;
-	for (entry = dict->hashes[hash(key) % dict->size]; entry != NULL; entry = entry->next)
-		if (strcmp(key, entry->key) == 0)
-			return 1;
-	return 0;
+	return XLALDictTableFind(dict->table, key, hash(key)) != NULL;
 }
 
 size_t XLALDictSize(const LALDict *dict)
 {
-	size_t size = 0;
-	size_t i;
-	for (i = 0; i < dict->size; ++i) {
-		const LALDictEntry *entry;
-		for (entry = dict->hashes[i]; entry != NULL; entry = entry->next)
-			++size;
-	}
-	return size;
+	return dict->table->n;
 }
 
 LALDictEntry *XLALDictLookup(LALDict *dict, const char *key)
 {
-	LALDictEntry *entry;
-	for (entry = dict->hashes[hash(key) % dict->size]; entry != NULL; entry = entry->next)
-		if (strcmp(key, entry->key) == 0)
-			return entry;
-	return NULL;
+	LALDictEntry **slot;
+	UINT8 hashval = hash(key);
+	if (XLALDictTableFind(dict->table, key, hashval) == NULL)
+		return NULL;
+	if (XLALDictUnshare(dict) < 0)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	slot = XLALDictTableFind(dict->table, key, hashval);
+	dict->table->exposed = 1;
+	return *slot;
 }
 
 int XLALDictRemove(LALDict *dict, const char *key)
 {
-	size_t hashidx = hash(key) % dict->size;
-	LALDictEntry *this = dict->hashes[hashidx];
-	LALDictEntry *prev = this;
-	while (this) {
-		if (strcmp(this->key, key) == 0) { /* found it! */
-			if (prev == this) /* head is removed */
-				dict->hashes[hashidx] = this->next;
-			else
-				prev->next = this->next;
-			LALFree(this);
-			return 0;
-		}
-		prev = this;
-		this = this->next;
-	}
-	return -1; /* not found */
+	LALDictEntry **slot;
+	UINT8 hashval = hash(key);
+	if (XLALDictTableFind(dict->table, key, hashval) == NULL)
+		return -1; /* not found */
+	if (XLALDictUnshare(dict) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	slot = XLALDictTableFind(dict->table, key, hashval);
+	*XLALDictTableLink(dict->table, *slot) = (*slot)->next;
+	LALFree(*slot);
+	*slot = DEL;
+	--dict->table->n;
+	return 0;
 }
 
 int XLALDictInsert(LALDict *dict, const char *key, const void *data, size_t size, LALTYPECODE type)
 {
-	size_t hashidx = hash(key) % dict->size;
-	LALDictEntry *this = dict->hashes[hashidx];
-	LALDictEntry *prev = NULL;
+	UINT8 hashval = hash(key);
+	LALDictEntry **slot;
 	LALDictEntry *entry;
 
-	/* see if entry already exists */
-	while (this) {
-		if (strcmp(this->key, key) == 0) { /* found it! */
-			entry = XLALDictEntryRealloc(this, size);
-			if (entry == NULL)
-				XLAL_ERROR(XLAL_EFUNC);
-			if (entry != this) { /* relink */
-				if (prev == NULL) /* head is moved */
-					dict->hashes[hashidx] = entry;
-				else
-					prev->next = entry;
-			}
-			entry = XLALDictEntrySetValue(entry, data, size, type);
-
-			if (entry == NULL)
-				XLAL_ERROR(XLAL_EFUNC);
+	if (XLALDictUnshare(dict) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
 
-			return 0;
-		}
-		prev = this;
-		this = this->next;
+	/* see if entry already exists */
+	slot = XLALDictTableFind(dict->table, key, hashval);
+	if (slot) { /* found it! */
+		LALDictEntry **link = XLALDictTableLink(dict->table, *slot);
+		entry = XLALDictEntryRealloc(*slot, size);
+		if (entry == NULL)
+			XLAL_ERROR(XLAL_EFUNC);
+		*slot = *link = entry; /* relink */
+		entry = XLALDictEntrySetValue(entry, data, size, type);
+		if (entry == NULL)
+			XLAL_ERROR(XLAL_EFUNC);
+		return 0;
 	}
 
 	/* not found: create new entry */
@@ -336,20 +583,14 @@ int XLALDictInsert(LALDict *dict, const char *key, const void *data, size_t size
 	if (entry == NULL)
 		XLAL_ERROR(XLAL_EFUNC);
 
-	entry = XLALDictEntrySetKey(entry, key);
-	if (entry == NULL) {
+	if (XLALDictEntrySetKey(entry, key) == NULL
+	    || XLALDictEntrySetValue(entry, data, size, type) == NULL
+	    || XLALDictTableReserve(dict->table) < 0) {
 		LALFree(entry);
 		XLAL_ERROR(XLAL_EFUNC);
 	}
 
-	entry = XLALDictEntrySetValue(entry, data, size, type);
-	if (entry == NULL) {
-		LALFree(entry);
-		XLAL_ERROR(XLAL_EFUNC);
-	}
-
-	entry->next = dict->hashes[hashidx];
-	dict->hashes[hashidx] = entry;
+	XLALDictTableAdd(dict->table, entry);
 	return 0;
 }
 
@@ -395,27 +636,19 @@ DEFINE_INSERT_FUNC(COMPLEX16, LAL_Z_TYPE_CODE)
 /* warning: shallow pointer */
 const char * XLALDictLookupStringValue(LALDict *dict, const char *key)
 {
-	LALDictEntry *entry = XLALDictLookup(dict, key);
-	const LALValue *value;
-	if (entry == NULL)
-		XLAL_ERROR_NULL(XLAL_ENAME, "Key `%s' not found", key);
-	value = XLALDictEntryGetValue(entry);
+	const LALValue *value = XLALDictTableLookupValue(dict->table, key, hash(key));
 	if (value == NULL)
-		XLAL_ERROR_NULL(XLAL_EFUNC);
+		XLAL_ERROR_NULL(XLAL_ENAME, "Key `%s' not found", key);
 	return XLALValueGetString(value);
 }
 
 #define DEFINE_LOOKUP_FUNC(TYPE, FAILVAL) \
 	TYPE XLALDictLookup ## TYPE ## Value(LALDict *dict, const char *key) \
 	{ \
-		LALDictEntry *entry; \
 		const LALValue *value; \
-		entry = XLALDictLookup(dict, key); \
-		if (entry == NULL) \
-			XLAL_ERROR_VAL(FAILVAL, XLAL_ENAME, "Key `%s' not found", key); \
-		value = XLALDictEntryGetValue(entry); \
+		value = XLALDictTableLookupValue(dict->table, key, hash(key)); \
 		if (value == NULL) \
-			XLAL_ERROR_VAL(FAILVAL, XLAL_EFUNC); \
+			XLAL_ERROR_VAL(FAILVAL, XLAL_ENAME, "Key `%s' not found", key); \
 		return XLALValueGet ## TYPE (value); \
 	}
 
@@ -434,17 +667,26 @@ DEFINE_LOOKUP_FUNC(COMPLEX16, XLAL_REAL8_FAIL_NAN)
 
 REAL8 XLALDictLookupValueAsREAL8(LALDict *dict, const char *key)
 {
-	LALDictEntry *entry;
 	const LALValue *value;
-	entry = XLALDictLookup(dict, key);
-	if (entry == NULL)
-		XLAL_ERROR_REAL8(XLAL_ENAME, "Key `%s' not found", key);
-	value = XLALDictEntryGetValue(entry);
+	value = XLALDictTableLookupValue(dict->table, key, hash(key));
 	if (value == NULL)
-		XLAL_ERROR_REAL8(XLAL_EFUNC);
+		XLAL_ERROR_REAL8(XLAL_ENAME, "Key `%s' not found", key);
 	return XLALValueGetAsREAL8(value);
 }
 
+/* KEY HANDLE ROUTINES */
+
+int XLALDictContainsKey(const LALDict *dict, LALDictKey *key)
+{
+	return XLALDictTableFind(dict->table, key->name, keyhash(key)) != NULL;
+}
+
+/* warning: shallow pointer; returns NULL, without setting an error, if key is not found */
+const LALValue * XLALDictLookupKeyValue(const LALDict *dict, LALDictKey *key)
+{
+	return XLALDictTableLookupValue(dict->table, key->name, keyhash(key));
+}
+
 static void XLALDictEntryPrintFunc(char *key, LALValue *value, void *thunk)
 {
 	int fd = *(int *)(thunk);
@@ -47,6 +47,26 @@ struct tagLALDictIter {
 };
 typedef struct tagLALDictIter LALDictIter;
 
+#ifndef SWIG /* exclude from SWIG interface */
+
+/*
+ * Handle to a dictionary key, which caches the hash of the key name so that
+ * repeated lookups of the same key need not hash the name again, e.g.
+ *
+ *	static LALDictKey key = LAL_DICT_KEY_INIT("name");
+ *	const LALValue *value = XLALDictLookupKeyValue(dict, &key);
+ *
+ * The name must remain valid for the lifetime of the handle.
+ */
+struct tagLALDictKey {
+	const char *name;
+	UINT8 hash; /* private data: 0 until first use */
+};
+typedef struct tagLALDictKey LALDictKey;
+#define LAL_DICT_KEY_INIT(name) { (name), 0 }
+
+#endif /* SWIG */
+
 void XLALDictEntryFree(LALDictEntry *list);
 LALDictEntry * XLALDictEntryAlloc(size_t size);
 LALDictEntry * XLALDictEntryRealloc(LALDictEntry *entry, size_t size);
@@ -107,6 +127,12 @@ COMPLEX16 XLALDictLookupCOMPLEX16Value(LALDict *dict, const char *key);
 
 REAL8 XLALDictLookupValueAsREAL8(LALDict *dict, const char *key);
 
+#ifndef SWIG /* exclude from SWIG interface */
+int XLALDictContainsKey(const LALDict *dict, LALDictKey *key);
+/* warning: shallow pointer */
+const LALValue * XLALDictLookupKeyValue(const LALDict *dict, LALDictKey *key);
+#endif /* SWIG */
+
 void XLALDictPrint(LALDict *dict, int fd);
 
 #if 0
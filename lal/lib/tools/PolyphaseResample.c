@@ -0,0 +1,449 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <math.h>
+#include <string.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/Date.h>
+#include <lal/LALString.h>
+#include <lal/Sequence.h>
+#include <lal/TimeSeries.h>
+#include <lal/Window.h>
+#include <lal/ResampleTimeSeries.h>
+
+/**
+ * \defgroup PolyphaseResample_c Module PolyphaseResample.c
+ * \ingroup ResampleTimeSeries_h
+ *
+ * \brief Resamples a time series by a rational factor with a polyphase FIR filter.
+ *
+ * A resampler changes the sample interval of a time series from \f$\Delta t_{\mathrm{in}}\f$
+ * to \f$\Delta t_{\mathrm{out}} = \Delta t_{\mathrm{in}} D / L\f$, for coprime integers
+ * \f$L\f$ and \f$D\f$; this includes integer upsampling (\f$D = 1\f$) and downsampling
+ * (\f$L = 1\f$), and conversions between e.g. 16384 Hz and 22050 Hz. Conceptually the input
+ * is upsampled by \f$L\f$ by inserting zeros, low-pass filtered, and decimated by \f$D\f$.
+ * The filter is a Kaiser-windowed sinc with its cutoff at \c LAL_RESAMPLER_ROLLOFF times the
+ * lower of the input and output Nyquist frequencies, and extends over \c halfLength samples
+ * of the lower-rate series on either side of each output sample. The filter is split into
+ * its \f$L\f$ polyphase components, so that each output sample is the inner product of
+ * \f$2K + 1\f$ input samples with one of the components, and only the output samples which
+ * are retained are ever computed.
+ *
+ * The filter is symmetric, so <em>there is no time shift in the output time series</em>:
+ * output sample \f$m\f$ is at time \f$m \Delta t_{\mathrm{out}}\f$ after the epoch of the input.
+ * Input samples before the start and after the end of the data are taken to be zero, so
+ * the first and last \c halfLength samples (at the lower rate) of the output are corrupted.
+ *
+ * The one-shot routines XLALPolyphaseResampleREAL4TimeSeries() and
+ * XLALPolyphaseResampleREAL8TimeSeries() resample a time series in place, and return
+ * \f$\lfloor N L / D \rfloor\f$ samples for an input of \f$N\f$ samples. For data which
+ * arrives in contiguous chunks, e.g. when reading frame files or making SFTs, a resampler
+ * created by XLALCreateResampler() keeps the filter state between calls: each call to
+ * XLALResamplerProcessREAL8TimeSeries() returns the output samples which are fully
+ * determined by the data so far, and XLALResamplerFlushREAL8TimeSeries() returns the
+ * remaining output samples once the end of the data is reached. The concatenated output
+ * is identical to that of resampling the concatenated input in one go, and has the same
+ * \f$\lfloor N L / D \rfloor\f$ samples, so there are no edge effects at chunk boundaries.
+ *
+ * \code
+ * LALResampler *resampler = XLALCreateResampler( 1.0 / 16384, 1.0 / 4096, 0 );
+ * while ( ( chunk = ReadNextChunk() ) ) {
+ *   REAL8TimeSeries *out = XLALResamplerProcessREAL8TimeSeries( resampler, chunk );
+ *   ...
+ * }
+ * REAL8TimeSeries *last = XLALResamplerFlushREAL8TimeSeries( resampler );
+ * XLALDestroyResampler( resampler );
+ * \endcode
+ */
+/** @{ */
+
+/* largest interpolation factor L which is searched for a rational resampling ratio */
+#define LAL_RESAMPLER_MAX_UP 65536
+
+/* Kaiser window shape parameter of the resampling filter; about 100 dB stopband attenuation */
+#define LAL_RESAMPLER_BETA 10.0
+
+struct tagLALResampler {
+  UINT4 up;             /* interpolation factor L */
+  UINT4 down;           /* decimation factor D */
+  UINT4 half;           /* number K of input samples on either side of each output sample */
+  UINT4 ntaps;          /* number of filter taps per polyphase component, 2K + 1 */
+  REAL8 *coeffs;        /* L polyphase components of the filter, each of ntaps taps */
+  REAL8 deltaTIn;       /* sample interval of the input */
+  REAL8 deltaTOut;      /* sample interval of the output */
+  REAL8 *buf;           /* buffered input samples */
+  size_t buflen;        /* number of samples in buf */
+  size_t bufsize;       /* number of samples allocated for buf */
+  INT8 bufstart;        /* index of the input sample in buf[0]; negative for leading zeros */
+  INT8 nin;             /* number of input samples received */
+  INT8 nout;            /* number of output samples produced */
+  /* metadata of the first input chunk, copied to the output */
+  CHAR name[LALNameLength];
+  LIGOTimeGPS epoch;
+  REAL8 f0;
+  LALUnit sampleUnits;
+};
+
+/* inner product, with independent partial sums so that the loop pipelines and vectorises */
+static inline REAL8 resampler_dot( const REAL8 *a, const REAL8 *b, UINT4 n )
+{
+  REAL8 s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+  UINT4 i;
+  for ( i = 0; i + 4 <= n; i += 4 )
+  {
+    s0 += a[i] * b[i];
+    s1 += a[i+1] * b[i+1];
+    s2 += a[i+2] * b[i+2];
+    s3 += a[i+3] * b[i+3];
+  }
+  for ( ; i < n; ++i )
+    s0 += a[i] * b[i];
+  return ( s0 + s1 ) + ( s2 + s3 );
+}
+
+/* compute output samples [m0, m0 + count); x[0] is input sample 'base' */
+static void resampler_filter( REAL8 *out, const LALResampler *r, const REAL8 *x, INT8 base, INT8 m0, UINT4 count )
+{
+  UINT4 j;
+  for ( j = 0; j < count; ++j )
+  {
+    const INT8 t = ( m0 + j ) * r->down;
+    const INT8 q = t / r->up;
+    const UINT4 p = t % r->up;
+    out[j] = resampler_dot( r->coeffs + (size_t) p * r->ntaps, x + ( q - r->half - base ), r->ntaps );
+  }
+}
+
+/* index of the earliest input sample needed to compute output sample m */
+static INT8 resampler_first_input( const LALResampler *r, INT8 m )
+{
+  return ( m * r->down ) / r->up - r->half;
+}
+
+/* make room for n more samples in the input buffer */
+static int resampler_reserve( LALResampler *r, size_t n )
+{
+  if ( r->buflen + n > r->bufsize )
+  {
+    size_t bufsize = 2 * r->bufsize;
+    REAL8 *buf;
+    if ( bufsize < r->buflen + n )
+      bufsize = r->buflen + n;
+    buf = XLALRealloc( r->buf, bufsize * sizeof( *buf ) );
+    if ( ! buf )
+      XLAL_ERROR( XLAL_ENOMEM );
+    r->buf = buf;
+    r->bufsize = bufsize;
+  }
+  return 0;
+}
+
+/* discard buffered input samples which are not needed for output samples after those produced */
+static void resampler_discard( LALResampler *r )
+{
+  const INT8 first = resampler_first_input( r, r->nout );
+  if ( first > r->bufstart )
+  {
+    const size_t ndrop = ( first - r->bufstart < (INT8) r->buflen ) ? (size_t) ( first - r->bufstart ) : r->buflen;
+    memmove( r->buf, r->buf + ndrop, ( r->buflen - ndrop ) * sizeof( *r->buf ) );
+    r->buflen -= ndrop;
+    r->bufstart += ndrop;
+  }
+}
+
+/* number of output samples which may be computed from the input received so far */
+static INT8 resampler_available( const LALResampler *r, int flush )
+{
+  INT8 mend;
+  if ( flush ) /* output samples before the end of the input, as for the one-shot routines */
+    mend = ( r->nin * r->up ) / r->down;
+  else if ( r->nin > r->half ) /* output samples whose filter support is all received */
+    mend = ( ( r->nin - r->half ) * r->up + r->down - 1 ) / r->down;
+  else
+    mend = 0;
+  return mend > r->nout ? mend - r->nout : 0;
+}
+
+/** Return the resampler to its state on creation, discarding any buffered input. */
+int XLALResamplerReset( LALResampler *resampler )
+{
+  XLAL_CHECK( resampler, XLAL_EFAULT );
+  resampler->buflen = 0;
+  resampler->nin = 0;
+  resampler->nout = 0;
+  /* the input before the start of the data is taken to be zero */
+  resampler->bufstart = -(INT8) resampler->half;
+  XLAL_CHECK( resampler_reserve( resampler, resampler->half ) == 0, XLAL_EFUNC );
+  memset( resampler->buf, 0, resampler->half * sizeof( *resampler->buf ) );
+  resampler->buflen = resampler->half;
+  return 0;
+}
+
+/**
+ * Create a resampler from sample interval \c deltaTIn to sample interval \c deltaTOut.
+ * The ratio <tt>deltaTOut / deltaTIn</tt> must be a rational number \f$D/L\f$ with
+ * \f$L \le 65536\f$. The filter extends over \c halfLength samples of the lower-rate series
+ * on either side of each output sample; if zero, \c LAL_RESAMPLER_DEFAULT_HALF_LENGTH is used.
+ */
+LALResampler *XLALCreateResampler( REAL8 deltaTIn, REAL8 deltaTOut, UINT4 halfLength )
+{
+  LALResampler *r;
+  REAL8Window *window;
+  const REAL8 ratio = deltaTOut / deltaTIn;
+  UINT4 up, down = 0, width, p, k;
+  REAL8 fc;
+
+  XLAL_CHECK_NULL( deltaTIn > 0 && deltaTOut > 0, XLAL_EINVAL, "Invalid sample intervals %g, %g", deltaTIn, deltaTOut );
+  if ( halfLength == 0 )
+    halfLength = LAL_RESAMPLER_DEFAULT_HALF_LENGTH;
+
+  /* find the smallest L for which D = L * deltaTOut / deltaTIn is an integer */
+  for ( up = 1; up <= LAL_RESAMPLER_MAX_UP; ++up )
+  {
+    const REAL8 d = ratio * up;
+    if ( d >= 0.5 && fabs( d - floor( d + 0.5 ) ) <= 1e-9 * d )
+    {
+      down = floor( d + 0.5 );
+      break;
+    }
+  }
+  XLAL_CHECK_NULL( down > 0, XLAL_EINVAL, "Resampling ratio %.17g is not a ratio of integers D/L with L <= %d", ratio, LAL_RESAMPLER_MAX_UP );
+
+  r = XLALCalloc( 1, sizeof( *r ) );
+  XLAL_CHECK_NULL( r, XLAL_ENOMEM );
+  r->up = up;
+  r->down = down;
+  r->deltaTIn = deltaTIn;
+  r->deltaTOut = deltaTIn * down / up;
+
+  /* the filter extends over 'width' samples of the upsampled series on either side of zero */
+  width = halfLength * ( up > down ? up : down );
+  r->half = ( width + up - 1 ) / up;
+  r->ntaps = 2 * r->half + 1;
+  r->coeffs = XLALCalloc( (size_t) up * r->ntaps, sizeof( *r->coeffs ) );
+  window = XLALCreateKaiserREAL8Window( 2 * width + 1, LAL_RESAMPLER_BETA );
+  if ( ! r->coeffs || ! window )
+  {
+    XLALDestroyREAL8Window( window );
+    XLALDestroyResampler( r );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+
+  /* cutoff frequency in cycles per sample of the upsampled series */
+  fc = 0.5 * LAL_RESAMPLER_ROLLOFF / ( up > down ? up : down );
+
+  /* tap k of component p multiplies input sample q - K + k for output sample at upsampled index qL + p;
+   * its offset from the output sample is n = (K - k) L + p upsampled samples */
+  for ( p = 0; p < up; ++p )
+  {
+    REAL8 *c = r->coeffs + (size_t) p * r->ntaps;
+    REAL8 sum = 0;
+    for ( k = 0; k < r->ntaps; ++k )
+    {
+      const INT8 n = ( (INT8) r->half - k ) * up + p;
+      if ( ( n < 0 ? -n : n ) <= (INT8) width )
+      {
+        const REAL8 x = 2.0 * fc * n;
+        c[k] = window->data->data[n + width] * ( n == 0 ? 1.0 : sin( LAL_PI * x ) / ( LAL_PI * x ) );
+        sum += c[k];
+      }
+    }
+    /* normalise each component to unit gain at zero frequency */
+    for ( k = 0; k < r->ntaps; ++k )
+      c[k] /= sum;
+  }
+  XLALDestroyREAL8Window( window );
+
+  if ( XLALResamplerReset( r ) < 0 )
+  {
+    XLALDestroyResampler( r );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+
+  return r;
+}
+
+/** Destroy a resampler. */
+void XLALDestroyResampler( LALResampler *resampler )
+{
+  if ( resampler )
+  {
+    XLALFree( resampler->coeffs );
+    XLALFree( resampler->buf );
+    XLALFree( resampler );
+  }
+}
+
+/** Return the sample interval of the output of a resampler. */
+REAL8 XLALResamplerGetDeltaT( const LALResampler *resampler )
+{
+  XLAL_CHECK_REAL8( resampler, XLAL_EFAULT );
+  return resampler->deltaTOut;
+}
+
+/* check that a chunk continues the input, and record its metadata if it is the first */
+static int resampler_check_chunk( LALResampler *r, const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits )
+{
+  XLAL_CHECK( fabs( deltaT - r->deltaTIn ) <= 1e-9 * r->deltaTIn, XLAL_EINVAL, "Sample interval %g of input does not match resampler (%g)", deltaT, r->deltaTIn );
+  if ( r->nin == 0 )
+  {
+    XLALStringCopy( r->name, name, sizeof( r->name ) );
+    r->epoch = *epoch;
+    r->f0 = f0;
+    r->sampleUnits = *sampleUnits;
+  }
+  else
+  {
+    const REAL8 offset = XLALGPSDiff( epoch, &r->epoch ) - r->nin * r->deltaTIn;
+    XLAL_CHECK( fabs( offset ) <= 1e-3 * r->deltaTIn, XLAL_EDATA, "Input is not contiguous with previous input (offset by %g s)", offset );
+  }
+  return 0;
+}
+
+/* compute all available output samples into out, which must have room for them */
+static void resampler_run( LALResampler *r, REAL8 *out, UINT4 count )
+{
+  resampler_filter( out, r, r->buf, r->bufstart, r->nout, count );
+  r->nout += count;
+  resampler_discard( r );
+}
+
+/* the start time of the next output sample */
+static LIGOTimeGPS resampler_output_epoch( const LALResampler *r )
+{
+  LIGOTimeGPS epoch = r->epoch;
+  XLALGPSAdd( &epoch, r->nout * r->deltaTOut );
+  return epoch;
+}
+
+/* compute all available output samples into a series of the given type */
+static int resampler_run_REAL8( LALResampler *r, REAL8 *out, UINT4 count )
+{
+  resampler_run( r, out, count );
+  return 0;
+}
+
+static int resampler_run_REAL4( LALResampler *r, REAL4 *out, UINT4 count )
+{
+  REAL8 *tmp = XLALMalloc( ( count ? count : 1 ) * sizeof( *tmp ) );
+  UINT4 j;
+  XLAL_CHECK( tmp, XLAL_ENOMEM );
+  resampler_run( r, tmp, count );
+  for ( j = 0; j < count; ++j )
+    out[j] = tmp[j];
+  XLALFree( tmp );
+  return 0;
+}
+
+#define DEFINE_RESAMPLER_FUNCS(TYPE) \
+  /** Feed the next contiguous chunk of input to a resampler, returning a time series of the output samples which it determines; this may have zero length. */ \
+  TYPE ## TimeSeries *XLALResamplerProcess ## TYPE ## TimeSeries( LALResampler *resampler, const TYPE ## TimeSeries *series ) \
+  { \
+    TYPE ## TimeSeries *out; \
+    LIGOTimeGPS epoch; \
+    UINT4 count, j; \
+    XLAL_CHECK_NULL( resampler && series && series->data, XLAL_EFAULT ); \
+    XLAL_CHECK_NULL( resampler_check_chunk( resampler, series->name, &series->epoch, series->f0, series->deltaT, &series->sampleUnits ) == 0, XLAL_EFUNC ); \
+    XLAL_CHECK_NULL( resampler_reserve( resampler, series->data->length ) == 0, XLAL_EFUNC ); \
+    for ( j = 0; j < series->data->length; ++j ) \
+      resampler->buf[resampler->buflen + j] = series->data->data[j]; \
+    resampler->buflen += series->data->length; \
+    resampler->nin += series->data->length; \
+    count = resampler_available( resampler, 0 ); \
+    epoch = resampler_output_epoch( resampler ); \
+    out = XLALCreate ## TYPE ## TimeSeries( resampler->name, &epoch, resampler->f0, resampler->deltaTOut, &resampler->sampleUnits, count ); \
+    XLAL_CHECK_NULL( out, XLAL_EFUNC ); \
+    if ( resampler_run_ ## TYPE( resampler, out->data->data, count ) < 0 ) { \
+      XLALDestroy ## TYPE ## TimeSeries( out ); \
+      XLAL_ERROR_NULL( XLAL_EFUNC ); \
+    } \
+    return out; \
+  } \
+  \
+  /** Return the output samples of a resampler which remain at the end of the input, taking any further input to be zero, and reset the resampler. */ \
+  TYPE ## TimeSeries *XLALResamplerFlush ## TYPE ## TimeSeries( LALResampler *resampler ) \
+  { \
+    TYPE ## TimeSeries *out; \
+    LIGOTimeGPS epoch; \
+    UINT4 count; \
+    XLAL_CHECK_NULL( resampler, XLAL_EFAULT ); \
+    XLAL_CHECK_NULL( resampler_reserve( resampler, resampler->half ) == 0, XLAL_EFUNC ); \
+    memset( resampler->buf + resampler->buflen, 0, resampler->half * sizeof( *resampler->buf ) ); \
+    resampler->buflen += resampler->half; \
+    count = resampler_available( resampler, 1 ); \
+    epoch = resampler_output_epoch( resampler ); \
+    out = XLALCreate ## TYPE ## TimeSeries( resampler->name, &epoch, resampler->f0, resampler->deltaTOut, &resampler->sampleUnits, count ); \
+    XLAL_CHECK_NULL( out, XLAL_EFUNC ); \
+    if ( resampler_run_ ## TYPE( resampler, out->data->data, count ) < 0 ) { \
+      XLALDestroy ## TYPE ## TimeSeries( out ); \
+      XLAL_ERROR_NULL( XLAL_EFUNC ); \
+    } \
+    if ( XLALResamplerReset( resampler ) < 0 ) { \
+      XLALDestroy ## TYPE ## TimeSeries( out ); \
+      XLAL_ERROR_NULL( XLAL_EFUNC ); \
+    } \
+    return out; \
+  } \
+  \
+  /** Resample a time series in place to sample interval \c dt with a polyphase FIR filter. */ \
+  int XLALPolyphaseResample ## TYPE ## TimeSeries( TYPE ## TimeSeries *series, REAL8 dt ) \
+  { \
+    LALResampler *r; \
+    REAL8 *buf, *out; \
+    UINT4 length, count, j; \
+    XLAL_CHECK( series && series->data, XLAL_EFAULT ); \
+    r = XLALCreateResampler( series->deltaT, dt, 0 ); \
+    XLAL_CHECK( r, XLAL_EFUNC ); \
+    length = series->data->length; \
+    count = ( (UINT8) length * r->up ) / r->down; \
+    if ( count == 0 ) { \
+      XLALDestroyResampler( r ); \
+      XLAL_ERROR( XLAL_EBADLEN, "Time series of %u samples is too short to resample", length ); \
+    } \
+    /* pad the input with zeros on either side */ \
+    buf = XLALCalloc( length + 2 * r->half, sizeof( *buf ) ); \
+    out = XLALMalloc( count * sizeof( *out ) ); \
+    if ( ! buf || ! out ) { \
+      XLALFree( buf ); \
+      XLALFree( out ); \
+      XLALDestroyResampler( r ); \
+      XLAL_ERROR( XLAL_ENOMEM ); \
+    } \
+    for ( j = 0; j < length; ++j ) \
+      buf[r->half + j] = series->data->data[j]; \
+    resampler_filter( out, r, buf, -(INT8) r->half, 0, count ); \
+    XLALFree( buf ); \
+    if ( count != length && ! XLALResize ## TYPE ## Sequence( series->data, 0, count ) ) { \
+      XLALFree( out ); \
+      XLALDestroyResampler( r ); \
+      XLAL_ERROR( XLAL_EFUNC ); \
+    } \
+    for ( j = 0; j < count; ++j ) \
+      series->data->data[j] = out[j]; \
+    series->deltaT = r->deltaTOut; \
+    XLALFree( out ); \
+    XLALDestroyResampler( r ); \
+    return 0; \
+  }
+
+DEFINE_RESAMPLER_FUNCS(REAL4)
+DEFINE_RESAMPLER_FUNCS(REAL8)
+
+#undef DEFINE_RESAMPLER_FUNCS
+
+/** @} */
@@ -40,6 +40,11 @@
  *
  * \brief Downsamples a time series in place by an integer power of two.
  *
+ * XLALResampleREAL4TimeSeries() and XLALResampleREAL8TimeSeries() downsample by a
+ * power of two with the #defaultButterworth filter described below; resampling by any
+ * other rational factor, including upsampling, is done with the polyphase FIR filter
+ * of XLALPolyphaseResampleREAL4TimeSeries() and XLALPolyphaseResampleREAL8TimeSeries().
+ *
  * The routine LALResampleREAL4TimeSeries() provided functionality to
  * downsample a time series in place by an integer factor which is a power of
  * two. Upsampling, non-integer resampling and resampling by a factor which is
@@ -134,10 +139,15 @@ int XLALResampleREAL4TimeSeries( REAL4TimeSeries *series, REAL8 dt )
   resampleFactor = floor( dt / series->deltaT + 0.5 );
   newNyquistFrequency = 0.5 / dt;
 
-  /* check that the resampling factor is valid */
+  /* resample by other than a power of two with the polyphase resampler */
   if ( resampleFactor < 1 ||
-      fabs( dt - resampleFactor * series->deltaT ) > 1e-3 * series->deltaT )
-    XLAL_ERROR( XLAL_EINVAL );
+      fabs( dt - resampleFactor * series->deltaT ) > 1e-3 * series->deltaT ||
+      ( resampleFactor & (resampleFactor - 1) ) )
+  {
+    if ( XLALPolyphaseResampleREAL4TimeSeries( series, dt ) < 0 )
+      XLAL_ERROR( XLAL_EFUNC );
+    return 0;
+  }
 
   /* just return if no resampling is required */
   if ( resampleFactor == 1 )
@@ -146,10 +156,6 @@ int XLALResampleREAL4TimeSeries( REAL4TimeSeries *series, REAL8 dt )
     return 0;
   }
 
-  /* check that we are resampling by a power of two */
-  if ( resampleFactor & (resampleFactor - 1) )
-    XLAL_ERROR( XLAL_EINVAL );
-
   if ( XLALLowPassREAL4TimeSeries( series, newNyquistFrequency,
         newNyquistAmplitude, filterOrder ) < 0 )
     XLAL_ERROR( XLAL_EFUNC );
@@ -182,10 +188,15 @@ int XLALResampleREAL8TimeSeries( REAL8TimeSeries *series, REAL8 dt )
   resampleFactor = floor( dt / series->deltaT + 0.5 );
   newNyquistFrequency = 0.5 / dt;
 
-  /* check that the resampling factor is valid */
+  /* resample by other than a power of two with the polyphase resampler */
   if ( resampleFactor < 1 ||
-      fabs( dt - resampleFactor * series->deltaT ) > 1e-3 * series->deltaT )
-    XLAL_ERROR( XLAL_EINVAL );
+      fabs( dt - resampleFactor * series->deltaT ) > 1e-3 * series->deltaT ||
+      ( resampleFactor & (resampleFactor - 1) ) )
+  {
+    if ( XLALPolyphaseResampleREAL8TimeSeries( series, dt ) < 0 )
+      XLAL_ERROR( XLAL_EFUNC );
+    return 0;
+  }
 
   /* just return if no resampling is required */
   if ( resampleFactor == 1 )
@@ -194,10 +205,6 @@ int XLALResampleREAL8TimeSeries( REAL8TimeSeries *series, REAL8 dt )
     return 0;
   }
 
-  /* check that we are resampling by a power of two */
-  if ( resampleFactor & (resampleFactor - 1) )
-    XLAL_ERROR( XLAL_EINVAL );
-
   if ( XLALLowPassREAL8TimeSeries( series, newNyquistFrequency,
         newNyquistAmplitude, filterOrder ) < 0 )
     XLAL_ERROR( XLAL_EFUNC );
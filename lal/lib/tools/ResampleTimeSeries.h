@@ -36,7 +36,9 @@ extern "C" {
  *
  * \brief Provides routines to resample a time series.
  *
- * At present only integer downsampling of \c REAL4TimeSeries by a power of two is supported.
+ * Time series may be resampled by any rational factor: downsampling by a power of two
+ * uses a Butterworth low pass filter, and other factors a polyphase FIR filter (see
+ * \ref PolyphaseResample_c), which also supports resampling data chunk by chunk.
  *
  * ### Synopsis ###
  *
@@ -129,6 +131,21 @@ tagResampleTSParams
 }
 ResampleTSParams;
 
+/**
+ * Default number of samples of the lower-rate series on either side of each output
+ * sample over which the polyphase resampling filter extends.
+ */
+#define LAL_RESAMPLER_DEFAULT_HALF_LENGTH 32
+
+/**
+ * Cutoff frequency of the polyphase resampling filter, as a fraction of the lower of
+ * the input and output Nyquist frequencies.
+ */
+#define LAL_RESAMPLER_ROLLOFF 0.9
+
+/** Opaque state of a polyphase FIR resampler; see \ref PolyphaseResample_c */
+typedef struct tagLALResampler LALResampler;
+
 /** @} */
 
 /* ---------- Function prototypes ---------- */
@@ -136,6 +153,18 @@ ResampleTSParams;
 int XLALResampleREAL4TimeSeries( REAL4TimeSeries *series, REAL8 dt );
 int XLALResampleREAL8TimeSeries( REAL8TimeSeries *series, REAL8 dt );
 
+int XLALPolyphaseResampleREAL4TimeSeries( REAL4TimeSeries *series, REAL8 dt );
+int XLALPolyphaseResampleREAL8TimeSeries( REAL8TimeSeries *series, REAL8 dt );
+
+LALResampler *XLALCreateResampler( REAL8 deltaTIn, REAL8 deltaTOut, UINT4 halfLength );
+void XLALDestroyResampler( LALResampler *resampler );
+int XLALResamplerReset( LALResampler *resampler );
+REAL8 XLALResamplerGetDeltaT( const LALResampler *resampler );
+REAL4TimeSeries *XLALResamplerProcessREAL4TimeSeries( LALResampler *resampler, const REAL4TimeSeries *series );
+REAL8TimeSeries *XLALResamplerProcessREAL8TimeSeries( LALResampler *resampler, const REAL8TimeSeries *series );
+REAL4TimeSeries *XLALResamplerFlushREAL4TimeSeries( LALResampler *resampler );
+REAL8TimeSeries *XLALResamplerFlushREAL8TimeSeries( LALResampler *resampler );
+
 void
 LALResampleREAL4TimeSeries(
     LALStatus          *status,
@@ -18,6 +18,7 @@
 */
 
 #include <stdlib.h>
+#include <math.h>
 #include <lal/LALStdlib.h>
 #include <lal/Date.h>
 #include <lal/Segments.h>
@@ -39,6 +40,16 @@
  * XLALSegListInit(), XLALSegListClear(), XLALSegListAppend(), XLALSegListSort()
  * XLALSegListCoalesce(), XLALSegListSearch()
  *
+ * Sorted, disjoint segment lists (e.g. coalesced ones) can be combined as sets
+ * of times in linear time, and searched for the segments overlapping an
+ * interval in logarithmic time:
+ *
+ * XLALSegListUnion(), XLALSegListIntersection(), XLALSegListSubtract(),
+ * XLALSegListOverlaps()
+ *
+ * Segment lists can also be converted to and from a compact binary form with
+ * XLALSegListSerialize() and XLALSegListDeserialize().
+ *
  * ### Error codes and return values ###
  *
  * Each XLAL function listed above, if it fails invokes the current XLAL error
@@ -1150,3 +1161,519 @@ XLALSegListGet( LALSegList *seglist, UINT4 indx )
         return tmp;
 
 }  /* XLALSegListGet() */
+
+
+
+/*---------------------------------------------------------------------------*/
+/*
+ * Helpers for the set operations below.  setop_begin() checks the input
+ * lists, and returns their segments in sorted, disjoint form: a list's own
+ * array if it is already disjoint, otherwise a coalesced copy held in
+ * tmp1 or tmp2.  It also allocates an output array large enough for the
+ * result of any of the operations.  setop_end() frees the copies, and
+ * replaces the contents of the result list with the output array.
+ */
+typedef struct tagSegListSetOp {
+  LALSegList tmp1, tmp2;
+  const LALSeg *a, *b;
+  size_t na, nb;
+  LALSeg *out;
+  size_t n;
+  UINT4 dplaces;
+} SegListSetOp;
+
+static int
+setop_disjoint( const LALSegList *seglist, LALSegList *tmp, const LALSeg **segs, size_t *length )
+{
+  *segs = seglist->segs;
+  *length = seglist->length;
+  if ( seglist->disjoint ) {
+    return XLAL_SUCCESS;
+  }
+  tmp->segs = LALMalloc( seglist->length * sizeof(LALSeg) );
+  if ( ! tmp->segs ) {
+    XLAL_ERROR( XLAL_ENOMEM );
+  }
+  memcpy( tmp->segs, seglist->segs, seglist->length * sizeof(LALSeg) );
+  tmp->arraySize = tmp->length = seglist->length;
+  tmp->sorted = seglist->sorted;
+  tmp->disjoint = 0;
+  XLAL_CHECK( XLALSegListCoalesce( tmp ) == XLAL_SUCCESS, XLAL_EFUNC );
+  *segs = tmp->segs;
+  *length = tmp->length;
+  return XLAL_SUCCESS;
+}
+
+static int
+setop_begin( SegListSetOp *op, const LALSegList *result, const LALSegList *seglist1, const LALSegList *seglist2 )
+{
+  XLAL_CHECK( result && seglist1 && seglist2, XLAL_EFAULT );
+  XLAL_CHECK( result->initMagic == SEGMENTSH_INITMAGICVAL && seglist1->initMagic == SEGMENTSH_INITMAGICVAL && seglist2->initMagic == SEGMENTSH_INITMAGICVAL,
+              XLAL_EINVAL, "Passed unintialized LALSegList structure\n" );
+
+  XLALSegListInit( &op->tmp1 );
+  XLALSegListInit( &op->tmp2 );
+  op->n = 0;
+  op->dplaces = seglist1->dplaces > seglist2->dplaces ? seglist1->dplaces : seglist2->dplaces;
+  op->out = LALMalloc( ( seglist1->length + seglist2->length + 1 ) * sizeof(LALSeg) );
+  if ( ! op->out || setop_disjoint( seglist1, &op->tmp1, &op->a, &op->na ) != XLAL_SUCCESS
+       || setop_disjoint( seglist2, &op->tmp2, &op->b, &op->nb ) != XLAL_SUCCESS ) {
+    XLALSegListClear( &op->tmp1 );
+    XLALSegListClear( &op->tmp2 );
+    LALFree( op->out );
+    XLAL_ERROR( XLAL_ENOMEM );
+  }
+  return XLAL_SUCCESS;
+}
+
+static int
+setop_end( SegListSetOp *op, LALSegList *result )
+{
+  XLALSegListClear( &op->tmp1 );
+  XLALSegListClear( &op->tmp2 );
+  XLALSegListClear( result );
+  if ( op->n == 0 ) {
+    LALFree( op->out );
+    return XLAL_SUCCESS;
+  }
+
+  /* Contract the array to the size of the result */
+  LALSeg *segptr = (LALSeg *) LALRealloc( op->out, op->n*sizeof(LALSeg) );
+  if ( ! segptr ) {
+    LALFree( op->out );
+    XLAL_ERROR( XLAL_ENOMEM );
+  }
+  result->segs = segptr;
+  result->arraySize = op->n;
+  result->length = (UINT4) op->n;
+  result->dplaces = op->dplaces;
+  return XLAL_SUCCESS;
+}
+
+
+/*---------------------------------------------------------------------------*/
+/**
+ * The function XLALSegListUnion() sets \a result to the union of the time
+ * intervals covered by the segment lists \a seglist1 and \a seglist2, as a
+ * coalesced list (see XLALSegListCoalesce()).  Each segment of the result
+ * is given the \c id of the first of the input segments which were joined to
+ * make it.  If the input lists are ``disjoint'' (e.g. have been coalesced),
+ * the union is computed by a single merge, in time linear in the total
+ * number of segments; otherwise a coalesced copy of each input list is made
+ * first.  The input lists are not modified.  \a result must have been
+ * initialized, and may be one of the input lists.
+ */
+int
+XLALSegListUnion( LALSegList *result, const LALSegList *seglist1, const LALSegList *seglist2 )
+{
+  SegListSetOp op;
+  size_t i = 0, j = 0;
+
+  XLAL_CHECK( setop_begin( &op, result, seglist1, seglist2 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* Merge the two lists in time order, joining segments which touch or
+     overlap the last segment of the output */
+  while ( i < op.na || j < op.nb ) {
+    const LALSeg *next;
+    if ( j == op.nb || ( i < op.na && XLALSegCmp( op.a + i, op.b + j ) <= 0 ) ) {
+      next = op.a + i++;
+    } else {
+      next = op.b + j++;
+    }
+    if ( op.n > 0 && XLALGPSCmp( &op.out[op.n-1].end, &next->start ) >= 0 ) {
+      if ( XLALGPSCmp( &op.out[op.n-1].end, &next->end ) < 0 ) {
+        op.out[op.n-1].end = next->end;
+      }
+    } else {
+      op.out[op.n++] = *next;
+    }
+  }
+
+  XLAL_CHECK( setop_end( &op, result ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+
+/*---------------------------------------------------------------------------*/
+/**
+ * The function XLALSegListIntersection() sets \a result to the intersection
+ * of the time intervals covered by the segment lists \a seglist1 and
+ * \a seglist2, as a sorted, disjoint list.  Each segment of the result
+ * is given the \c id of the segment of \a seglist1 which contains it.
+ * Segments of zero duration are dropped.  The intersection is computed in
+ * time linear in the total number of segments, after the same preparation of
+ * the input lists as in XLALSegListUnion().  \a result must have been
+ * initialized, and may be one of the input lists.
+ */
+int
+XLALSegListIntersection( LALSegList *result, const LALSegList *seglist1, const LALSegList *seglist2 )
+{
+  SegListSetOp op;
+  size_t i = 0, j = 0;
+
+  XLAL_CHECK( setop_begin( &op, result, seglist1, seglist2 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* Step through both lists, advancing past whichever segment ends first */
+  while ( i < op.na && j < op.nb ) {
+    const LALSeg *a = op.a + i, *b = op.b + j;
+    const LIGOTimeGPS *start = XLALGPSCmp( &a->start, &b->start ) >= 0 ? &a->start : &b->start;
+    const int cmp = XLALGPSCmp( &a->end, &b->end );
+    const LIGOTimeGPS *end = cmp <= 0 ? &a->end : &b->end;
+    if ( XLALGPSCmp( start, end ) < 0 ) {
+      op.out[op.n].start = *start;
+      op.out[op.n].end = *end;
+      op.out[op.n].id = a->id;
+      op.n++;
+    }
+    if ( cmp <= 0 ) {
+      i++;
+    } else {
+      j++;
+    }
+  }
+
+  XLAL_CHECK( setop_end( &op, result ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+
+/*---------------------------------------------------------------------------*/
+/**
+ * The function XLALSegListSubtract() sets \a result to the time intervals
+ * covered by the segment list \a seglist1 but not by \a seglist2, as a
+ * sorted, disjoint list; e.g. to apply the vetoes in \a seglist2 to the
+ * analysed times in \a seglist1.  Each segment of the result is given the
+ * \c id of the segment of \a seglist1 which contains it.  Segments of zero
+ * duration are dropped.  The difference is computed in time linear in the
+ * total number of segments, after the same preparation of the input lists
+ * as in XLALSegListUnion().  \a result must have been initialized, and may
+ * be one of the input lists.
+ */
+int
+XLALSegListSubtract( LALSegList *result, const LALSegList *seglist1, const LALSegList *seglist2 )
+{
+  SegListSetOp op;
+  size_t i, j = 0;
+
+  XLAL_CHECK( setop_begin( &op, result, seglist1, seglist2 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  for ( i = 0; i < op.na; i++ ) {
+    const LALSeg *a = op.a + i;
+    LIGOTimeGPS start = a->start;
+
+    /* Skip the segments of seglist2 which end before this segment starts */
+    while ( j < op.nb && XLALGPSCmp( &op.b[j].end, &start ) <= 0 ) {
+      j++;
+    }
+
+    /* Cut out each segment of seglist2 which starts before this one ends.
+       The last of them may extend beyond this segment into the next one,
+       so is not skipped */
+    for ( ; j < op.nb && XLALGPSCmp( &op.b[j].start, &a->end ) < 0; j++ ) {
+      if ( XLALGPSCmp( &start, &op.b[j].start ) < 0 ) {
+        op.out[op.n].start = start;
+        op.out[op.n].end = op.b[j].start;
+        op.out[op.n].id = a->id;
+        op.n++;
+      }
+      if ( XLALGPSCmp( &op.b[j].end, &a->end ) >= 0 ) {
+        start = a->end;
+        break;
+      }
+      start = op.b[j].end;
+    }
+
+    /* Keep whatever remains of this segment */
+    if ( XLALGPSCmp( &start, &a->end ) < 0 ) {
+      op.out[op.n].start = start;
+      op.out[op.n].end = a->end;
+      op.out[op.n].id = a->id;
+      op.n++;
+    }
+  }
+
+  XLAL_CHECK( setop_end( &op, result ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+
+/*---------------------------------------------------------------------------*/
+/**
+ * The function XLALSegListOverlaps() finds the segments of the ``disjoint''
+ * segment list \a seglist (see XLALSegListCoalesce()) which overlap the
+ * interval [\a start, \a end), i.e. which start before \a end and end after
+ * \a start.  These form a contiguous range of the list; the index of the
+ * first of them is returned in \a first (if not NULL), and the number of
+ * them is the return value.  The range is found by two binary searches, in
+ * time logarithmic in the length of the list, so that e.g. checking a
+ * trigger or a data segment against a coalesced list of vetoes is cheap
+ * even for very long lists.  An error occurs if the list is not disjoint.
+ */
+INT4
+XLALSegListOverlaps( const LALSegList *seglist, const LIGOTimeGPS *start, const LIGOTimeGPS *end, UINT4 *first )
+{
+  size_t lo, hi, lo2;
+
+  XLAL_CHECK( seglist && start && end, XLAL_EFAULT );
+  XLAL_CHECK( seglist->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL, "Passed unintialized LALSegList structure to %s\n", __func__ );
+  XLAL_CHECK( seglist->disjoint, XLAL_EINVAL, "Segment list passed to %s is not disjoint\n", __func__ );
+
+  /* The end times of a disjoint list are in non-descending order, so find
+     the first segment which ends after 'start' ... */
+  lo = 0;
+  hi = seglist->length;
+  while ( lo < hi ) {
+    const size_t mid = lo + ( hi - lo ) / 2;
+    if ( XLALGPSCmp( &seglist->segs[mid].end, start ) > 0 ) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+
+  /* ... and the first segment after it which starts at or after 'end' */
+  lo2 = lo;
+  hi = seglist->length;
+  while ( lo2 < hi ) {
+    const size_t mid = lo2 + ( hi - lo2 ) / 2;
+    if ( XLALGPSCmp( &seglist->segs[mid].start, end ) >= 0 ) {
+      hi = mid;
+    } else {
+      lo2 = mid + 1;
+    }
+  }
+
+  if ( first ) {
+    *first = (UINT4) lo;
+  }
+  return (INT4) ( lo2 - lo );
+}
+
+
+/*---------------------------------------------------------------------------*/
+/**
+ * The function XLALSegListToBitset() sets the bits of the bitset \a bs
+ * which correspond to samples of a time series, starting at \a epoch and
+ * sampled every \a deltaT seconds, that lie within a segment of \a seglist;
+ * i.e. bit \f$i\f$ is set if the time \a epoch \f$+ i\f$ \a deltaT lies
+ * in some segment.  Only the first \a length samples are considered, and
+ * bits which are already set are left set, so the bitset should be cleared
+ * first if required.  Each segment sets its range of bits a whole 64-bit
+ * word at a time, so the mask is built in time linear in the number of
+ * segments plus the number of words covered.  The segment list need not be
+ * sorted or disjoint, and is not modified.
+ */
+int
+XLALSegListToBitset( LALBitset *bs, const LALSegList *seglist, const LIGOTimeGPS *epoch, REAL8 deltaT, UINT8 length )
+{
+  size_t i;
+
+  XLAL_CHECK( bs && seglist && epoch, XLAL_EFAULT );
+  XLAL_CHECK( seglist->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL, "Passed unintialized LALSegList structure to %s\n", __func__ );
+  XLAL_CHECK( deltaT > 0, XLAL_EDOM, "Invalid sampling interval %g passed to %s\n", deltaT, __func__ );
+
+  for ( i = 0; i < seglist->length; i++ ) {
+    const REAL8 d0 = XLALGPSDiff( &seglist->segs[i].start, epoch ) / deltaT;
+    const REAL8 d1 = XLALGPSDiff( &seglist->segs[i].end, epoch ) / deltaT;
+
+    /* Samples [i0, i1) lie within this segment */
+    const UINT8 i0 = d0 <= 0 ? 0 : d0 >= (REAL8) length ? length : (UINT8) ceil( d0 );
+    const UINT8 i1 = d1 <= 0 ? 0 : d1 >= (REAL8) length ? length : (UINT8) ceil( d1 );
+    if ( i0 < i1 ) {
+      XLAL_CHECK( XLALBitsetSetRange( bs, i0, i1 - i0, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+  }
+
+  return XLAL_SUCCESS;
+}
+
+
+/* Parameters for appending a run of set bits to a segment list */
+typedef struct {
+  LALSegList *seglist;
+  const LIGOTimeGPS *epoch;
+  REAL8 deltaT;
+} SegListFromBitsetParam;
+
+static int
+seglist_append_run( void *param, const UINT8 start, const UINT8 count )
+{
+  SegListFromBitsetParam *p = (SegListFromBitsetParam *) param;
+  LIGOTimeGPS t0 = *p->epoch, t1 = *p->epoch;
+  LALSeg seg;
+
+  XLALGPSAdd( &t0, start * p->deltaT );
+  XLALGPSAdd( &t1, ( start + count ) * p->deltaT );
+  XLAL_CHECK( XLALSegSet( &seg, &t0, &t1, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALSegListAppend( p->seglist, &seg ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+}
+
+
+/*---------------------------------------------------------------------------*/
+/**
+ * The function XLALSegListFromBitset() is the inverse of
+ * XLALSegListToBitset(): it appends to \a seglist a segment for each
+ * maximal run of consecutive set bits of the bitset \a bs, where the run of
+ * bits \f$[i, j)\f$ gives the segment [\a epoch \f$+ i\f$ \a deltaT,
+ * \a epoch \f$+ j\f$ \a deltaT).  Each segment is given an \c id of zero.
+ * The runs are found a 64-bit word at a time, in increasing order, so that
+ * the segments are appended in time order; if \a seglist was empty, the
+ * result is sorted and disjoint.  \a seglist must have been initialized.
+ */
+int
+XLALSegListFromBitset( LALSegList *seglist, const LALBitset *bs, const LIGOTimeGPS *epoch, REAL8 deltaT )
+{
+  SegListFromBitsetParam param;
+
+  XLAL_CHECK( seglist && bs && epoch, XLAL_EFAULT );
+  XLAL_CHECK( seglist->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL, "Passed unintialized LALSegList structure to %s\n", __func__ );
+  XLAL_CHECK( deltaT > 0, XLAL_EDOM, "Invalid sampling interval %g passed to %s\n", deltaT, __func__ );
+
+  param.seglist = seglist;
+  param.epoch = epoch;
+  param.deltaT = deltaT;
+  XLAL_CHECK( XLALBitsetVisitRuns( bs, seglist_append_run, &param ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+}
+
+
+/*---------------------------------------------------------------------------*/
+/*
+ * Compact binary form of a segment list.  After an 8-byte header
+ * ("LALSEGS" and a version number) and the number of segments, each
+ * segment is stored as the difference between its start time and the end
+ * time of the previous segment, its duration, and the difference between
+ * its id and that of the previous segment, all as variable-length integers:
+ * 7 bits per byte, little-endian, with the high bit set on all but the last
+ * byte, and signed values zig-zag encoded.  For a sorted list of segments of
+ * whole-second times, this usually takes 6 to 10 bytes per segment.
+ */
+static const char segs_magic[8] = { 'L', 'A', 'L', 'S', 'E', 'G', 'S', 1 };
+
+static unsigned char *
+segs_put_uint( unsigned char *p, UINT8 x )
+{
+  while ( x >= 0x80 ) {
+    *p++ = (unsigned char) ( x | 0x80 );
+    x >>= 7;
+  }
+  *p++ = (unsigned char) x;
+  return p;
+}
+
+static unsigned char *
+segs_put_int( unsigned char *p, INT8 x )
+{
+  return segs_put_uint( p, ( (UINT8) x << 1 ) ^ (UINT8) ( x < 0 ? -1 : 0 ) );
+}
+
+static const unsigned char *
+segs_get_uint( const unsigned char *p, const unsigned char *end, UINT8 *x )
+{
+  int shift;
+  *x = 0;
+  for ( shift = 0; p < end && shift < 64; shift += 7 ) {
+    *x |= (UINT8) ( *p & 0x7f ) << shift;
+    if ( ! ( *p++ & 0x80 ) ) {
+      return p;
+    }
+  }
+  return NULL;
+}
+
+static const unsigned char *
+segs_get_int( const unsigned char *p, const unsigned char *end, INT8 *x )
+{
+  UINT8 u;
+  p = segs_get_uint( p, end, &u );
+  *x = (INT8) ( u >> 1 ) ^ -(INT8) ( u & 1 );
+  return p;
+}
+
+
+/**
+ * The function XLALSegListSerialize() encodes the segments of \a seglist,
+ * in their current order, into a compact binary form which can be written
+ * to a file or sent elsewhere and converted back into a segment list by
+ * XLALSegListDeserialize(), without the cost of formatting and parsing
+ * GPS times as text.  It returns a buffer holding the encoded list, which
+ * must be freed with XLALFree(), and stores its size in bytes in \a size.
+ */
+void *
+XLALSegListSerialize( const LALSegList *seglist, size_t *size )
+{
+  unsigned char *buf, *p;
+  INT8 prevEnd = 0;
+  INT4 prevId = 0;
+  UINT4 i;
+
+  XLAL_CHECK_NULL( seglist && size, XLAL_EFAULT );
+  XLAL_CHECK_NULL( seglist->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL, "Passed unintialized LALSegList structure to %s\n", __func__ );
+
+  /* each variable-length integer takes at most 10 bytes */
+  buf = XLALMalloc( sizeof(segs_magic) + 10 + 30 * (size_t) seglist->length );
+  XLAL_CHECK_NULL( buf, XLAL_ENOMEM );
+  memcpy( buf, segs_magic, sizeof(segs_magic) );
+  p = segs_put_uint( buf + sizeof(segs_magic), seglist->length );
+  for ( i = 0; i < seglist->length; i++ ) {
+    const INT8 start = XLALGPSToINT8NS( &seglist->segs[i].start );
+    const INT8 end = XLALGPSToINT8NS( &seglist->segs[i].end );
+    p = segs_put_int( p, start - prevEnd );
+    p = segs_put_uint( p, (UINT8) ( end - start ) );
+    p = segs_put_int( p, (INT8) seglist->segs[i].id - prevId );
+    prevEnd = end;
+    prevId = seglist->segs[i].id;
+  }
+
+  *size = p - buf;
+  p = XLALRealloc( buf, *size );
+  return p ? p : buf;
+}
+
+
+/**
+ * The function XLALSegListDeserialize() replaces the contents of the
+ * initialized segment list \a seglist with the segments encoded in the
+ * \a size bytes at \a buf by XLALSegListSerialize().  An XLAL_EINVAL error
+ * occurs if the buffer does not hold a valid encoded segment list.
+ */
+int
+XLALSegListDeserialize( LALSegList *seglist, const void *buf, size_t size )
+{
+  const unsigned char *p = buf, *end = p + size;
+  UINT8 length, i;
+  INT8 prevEnd = 0;
+  INT8 prevId = 0;
+
+  XLAL_CHECK( seglist && buf, XLAL_EFAULT );
+  XLAL_CHECK( seglist->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL, "Passed unintialized LALSegList structure to %s\n", __func__ );
+  XLAL_CHECK( size >= sizeof(segs_magic) && memcmp( p, segs_magic, sizeof(segs_magic) ) == 0, XLAL_EINVAL, "Buffer does not hold an encoded segment list\n" );
+  p += sizeof(segs_magic);
+  p = segs_get_uint( p, end, &length );
+  /* each segment takes at least 3 bytes */
+  XLAL_CHECK( p && length <= (UINT8) ( end - p ) / 3, XLAL_EINVAL, "Corrupt encoded segment list\n" );
+
+  XLAL_CHECK( XLALSegListClear( seglist ) == XLAL_SUCCESS, XLAL_EFUNC );
+  for ( i = 0; i < length; i++ ) {
+    INT8 dstart, did;
+    UINT8 duration;
+    LALSeg seg;
+    if ( ! ( p = segs_get_int( p, end, &dstart ) ) || ! ( p = segs_get_uint( p, end, &duration ) ) || ! ( p = segs_get_int( p, end, &did ) ) ) {
+      XLALSegListClear( seglist );
+      XLAL_ERROR( XLAL_EINVAL, "Corrupt encoded segment list\n" );
+    }
+    XLALINT8NSToGPS( &seg.start, prevEnd + dstart );
+    XLALINT8NSToGPS( &seg.end, prevEnd + dstart + (INT8) duration );
+    seg.id = (INT4) ( prevId + did );
+    if ( XLALSegListAppend( seglist, &seg ) != XLAL_SUCCESS ) {
+      XLALSegListClear( seglist );
+      XLAL_ERROR( XLAL_EFUNC );
+    }
+    prevEnd = prevEnd + dstart + (INT8) duration;
+    prevId = seg.id;
+  }
+  return XLAL_SUCCESS;
+}
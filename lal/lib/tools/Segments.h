@@ -22,6 +22,7 @@
 
 #include <lal/LALDatatypes.h>
 #include <lal/XLALError.h>
+#include <lal/LALBitset.h>
 
 #if defined(__cplusplus)
 extern "C" {
@@ -243,6 +244,32 @@ int XLALSegListIsInitialized ( const LALSegList *seglist );
 int XLALSegListInitSimpleSegments ( LALSegList *seglist, LIGOTimeGPS startTime, UINT4 Nseg, REAL8 Tseg );
 char *XLALSegList2String ( const LALSegList *seglist );
 
+int
+XLALSegListUnion( LALSegList *result, const LALSegList *seglist1, const LALSegList *seglist2 );
+
+int
+XLALSegListIntersection( LALSegList *result, const LALSegList *seglist1, const LALSegList *seglist2 );
+
+int
+XLALSegListSubtract( LALSegList *result, const LALSegList *seglist1, const LALSegList *seglist2 );
+
+INT4
+XLALSegListOverlaps( const LALSegList *seglist, const LIGOTimeGPS *start, const LIGOTimeGPS *end, UINT4 *first );
+
+int
+XLALSegListToBitset( LALBitset *bs, const LALSegList *seglist, const LIGOTimeGPS *epoch, REAL8 deltaT, UINT8 length );
+
+int
+XLALSegListFromBitset( LALSegList *seglist, const LALBitset *bs, const LIGOTimeGPS *epoch, REAL8 deltaT );
+
+#ifndef SWIG /* exclude from SWIG interface */
+void *
+XLALSegListSerialize( const LALSegList *seglist, size_t *size );
+
+int
+XLALSegListDeserialize( LALSegList *seglist, const void *buf, size_t size );
+#endif /* SWIG */
+
 /** @} */
 
 #if 0
@@ -447,3 +447,213 @@ void XLALSkymapApply(
 }
 
 
+
+// Centre of pixel ipix of a HEALPix grid with resolution nside in the
+// RING ordering scheme, as a theta, phi tuple (Gorski et al. 2005, ApJ
+// 622, 759)
+
+void XLALSkymapHealpixRingDirection(double direction[2], long nside, long ipix)
+{
+    long npix = 12 * nside * nside;
+    long ncap = 2 * nside * (nside - 1);
+    double fact2 = 4.0 / npix;
+    double fact1 = 2 * nside * fact2;
+    double z, phi;
+    long iring, iphi;
+
+    if (ipix < ncap)
+    {
+        // north polar cap
+        iring = (1 + (long) sqrt(1 + 2 * ipix)) >> 1;
+        iphi = ipix + 1 - 2 * iring * (iring - 1);
+        z = 1.0 - iring * iring * fact2;
+        phi = (iphi - 0.5) * LAL_PI_2 / iring;
+    }
+    else if (ipix < npix - ncap)
+    {
+        // equatorial belt
+        long ip = ipix - ncap;
+        iring = ip / (4 * nside) + nside;
+        iphi = ip % (4 * nside) + 1;
+        z = (2 * nside - iring) * fact1;
+        phi = (iphi - (((iring + nside) & 1) ? 1.0 : 0.5)) * LAL_PI * 0.75 * fact1;
+    }
+    else
+    {
+        // south polar cap
+        long ip = npix - ipix;
+        iring = (1 + (long) sqrt(2 * ip - 1)) >> 1;
+        iphi = 4 * iring + 1 - (ip - 2 * iring * (iring - 1));
+        z = iring * iring * fact2 - 1.0;
+        phi = (iphi - 0.5) * LAL_PI_2 / iring;
+    }
+
+    direction[0] = acos(z);
+    direction[1] = phi;
+}
+
+// Number of directions evaluated together by XLALSkymapEngineApply
+
+#define XLALSKYMAP_BLOCK 64
+
+// Construct an XLALSkymapEngineType for every pixel of a HEALPix grid
+// with resolution nside, in RING order, from
+//     a plan
+//     the HEALPix resolution
+// The delays and antenna patterns of each direction are tabulated here;
+// the kernels are tabulated by XLALSkymapEngineSetKernel
+
+XLALSkymapEngineType* XLALSkymapEngineCreate(XLALSkymapPlanType* plan, int nside)
+{
+    XLALSkymapEngineType* engine;
+    long npix, p;
+    int j;
+
+    XLAL_CHECK_NULL(plan, XLAL_EFAULT);
+    XLAL_CHECK_NULL(plan->n > 0 && plan->n <= XLALSKYMAP_N, XLAL_EINVAL, "Invalid number of detectors %d", plan->n);
+    XLAL_CHECK_NULL(nside > 0 && nside <= (1 << 13), XLAL_EINVAL, "Invalid HEALPix resolution %d", nside);
+
+    npix = 12L * nside * nside;
+    engine = XLALCalloc(1, sizeof(*engine));
+    XLAL_CHECK_NULL(engine, XLAL_ENOMEM);
+    engine->plan = *plan;
+    engine->nside = nside;
+    engine->npix = npix;
+    engine->delay = XLALMalloc(sizeof(*engine->delay) * plan->n * npix);
+    engine->f = XLALMalloc(sizeof(*engine->f) * 2 * plan->n * npix);
+    engine->k = XLALMalloc(sizeof(*engine->k) * plan->n * plan->n * npix);
+    engine->logNormalization = XLALMalloc(sizeof(*engine->logNormalization) * npix);
+    if (!engine->delay || !engine->f || !engine->k || !engine->logNormalization)
+    {
+        XLALSkymapEngineDestroy(engine);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+
+    #pragma omp parallel for private(j)
+    for (p = 0; p < npix; ++p)
+    {
+        double direction[2];
+        XLALSkymapDirectionPropertiesType properties;
+        XLALSkymapHealpixRingDirection(direction, nside, p);
+        XLALSkymapDirectionPropertiesConstruct(&engine->plan, direction, &properties);
+        for (j = 0; j != plan->n; ++j)
+        {
+            engine->delay[j * npix + p] = properties.delay[j];
+            engine->f[(2 * j) * npix + p] = properties.f[j][0];
+            engine->f[(2 * j + 1) * npix + p] = properties.f[j][1];
+        }
+    }
+
+    return engine;
+}
+
+void XLALSkymapEngineDestroy(XLALSkymapEngineType* engine)
+{
+    if (engine)
+    {
+        XLALFree(engine->delay);
+        XLALFree(engine->f);
+        XLALFree(engine->k);
+        XLALFree(engine->logNormalization);
+        XLALFree(engine);
+    }
+}
+
+// Tabulate the kernel of every direction of an engine from
+//     the noise-weighted inner product of the template with itself
+//     the amplitude calibration error, or NULL for none
+// as XLALSkymapKernelConstruct (or XLALSkymapUncertainKernelConstruct)
+// would for each direction
+
+int XLALSkymapEngineSetKernel(XLALSkymapEngineType* engine, double* wSw, double* error)
+{
+    long npix, p;
+    int n, i, j;
+
+    XLAL_CHECK(engine && wSw, XLAL_EFAULT);
+    npix = engine->npix;
+    n = engine->plan.n;
+
+    #pragma omp parallel for private(i, j)
+    for (p = 0; p < npix; ++p)
+    {
+        XLALSkymapDirectionPropertiesType properties;
+        XLALSkymapKernelType kernel;
+        for (j = 0; j != n; ++j)
+        {
+            properties.delay[j] = engine->delay[j * npix + p];
+            properties.f[j][0] = engine->f[(2 * j) * npix + p];
+            properties.f[j][1] = engine->f[(2 * j + 1) * npix + p];
+        }
+        if (error)
+            XLALSkymapUncertainKernelConstruct(&engine->plan, &properties, wSw, error, &kernel);
+        else
+            XLALSkymapKernelConstruct(&engine->plan, &properties, wSw, &kernel);
+        for (i = 0; i != n; ++i)
+            for (j = 0; j != n; ++j)
+                engine->k[(i * n + j) * npix + p] = kernel.k[i][j];
+        engine->logNormalization[p] = kernel.logNormalization;
+    }
+
+    return 0;
+}
+
+// Compute the marginalization integral of XLALSkymapApply for every
+// direction of an engine, from
+//     a matched filter time series for each detector
+//     a signal arrival time
+// storing the results in HEALPix RING order.  Directions are processed in
+// blocks, and within a block each term of x^T.K.x is accumulated across
+// all directions at once
+
+int XLALSkymapEngineApply(XLALSkymapEngineType* engine, double** xSw, double tau, double* logPosterior)
+{
+    long npix, start;
+    int n;
+
+    XLAL_CHECK(engine && xSw && logPosterior, XLAL_EFAULT);
+    npix = engine->npix;
+    n = engine->plan.n;
+
+    #pragma omp parallel for schedule(static)
+    for (start = 0; start < npix; start += XLALSKYMAP_BLOCK)
+    {
+        const int m = (npix - start < XLALSKYMAP_BLOCK) ? npix - start : XLALSKYMAP_BLOCK;
+        double x[XLALSKYMAP_N][XLALSKYMAP_BLOCK];
+        double a[XLALSKYMAP_BLOCK];
+        int i, j, b;
+
+        // Interpolate the matched filter values
+
+        for (i = 0; i != n; ++i)
+        {
+            const double* delay = engine->delay + i * npix + start;
+            for (b = 0; b != m; ++b)
+                x[i][b] = XLALSkymapInterpolate((tau + delay[b]) * engine->plan.sampleFrequency, xSw[i]);
+        }
+
+        // Compute x^T.K.x using the symmetry of the kernel
+
+        for (b = 0; b != m; ++b)
+            a[b] = 0;
+        for (i = 0; i != n; ++i)
+        {
+            const double* kii = engine->k + (i * n + i) * npix + start;
+            for (b = 0; b != m; ++b)
+                a[b] += x[i][b] * kii[b] * x[i][b];
+            for (j = i + 1; j != n; ++j)
+            {
+                const double* kij = engine->k + (i * n + j) * npix + start;
+                for (b = 0; b != m; ++b)
+                    a[b] += 2 * x[i][b] * kij[b] * x[j][b];
+            }
+        }
+
+        // Scale and apply the normalization
+
+        for (b = 0; b != m; ++b)
+            logPosterior[start + b] = 0.5 * a[b] + engine->logNormalization[start + b];
+    }
+
+    return 0;
+}
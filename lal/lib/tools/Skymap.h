@@ -119,6 +119,49 @@ void XLALSkymapApply(
     double* logPosterior
     );
 
+/* Centre of a HEALPix pixel in the RING ordering, as theta, phi */
+
+void XLALSkymapHealpixRingDirection(double direction[2], long nside, long ipix);
+
+/* Struct to store the direction properties and kernels of every pixel of */
+/* a HEALPix grid, in RING order, with the same quantity for all pixels */
+/* held contiguously */
+
+typedef struct tagXLALSkymapEngineType
+{
+    XLALSkymapPlanType plan;
+    int nside;
+    long npix;
+    double* delay;              /* delay[j * npix + p] */
+    double* f;                  /* f[(2 * j + k) * npix + p] */
+    double* k;                  /* k[(i * n + j) * npix + p] */
+    double* logNormalization;   /* logNormalization[p] */
+} XLALSkymapEngineType;
+
+XLALSkymapEngineType* XLALSkymapEngineCreate(
+    XLALSkymapPlanType* plan,
+    int nside
+    );
+
+void XLALSkymapEngineDestroy(
+    XLALSkymapEngineType* engine
+    );
+
+int XLALSkymapEngineSetKernel(
+    XLALSkymapEngineType* engine,
+    double* wSw,
+    double* error
+    );
+
+/* Compute the marginalization integral for every direction of an engine */
+
+int XLALSkymapEngineApply(
+    XLALSkymapEngineType* engine,
+    double** xSw,
+    double tau,
+    double* logPosterior
+    );
+
 #ifdef __cplusplus
 }
 #endif
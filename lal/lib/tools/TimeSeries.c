@@ -22,6 +22,7 @@
 #include <math.h>
 #include <string.h>
 #include <lal/Date.h>
+#include <lal/LALArena.h>
 #include <lal/LALDatatypes.h>
 #include <lal/LALStdlib.h>
 #include <lal/Sequence.h>
@@ -249,6 +249,81 @@ void XLALREAL8SequenceInterpDestroy(LALREAL8SequenceInterp *interp)
 }
 
 
+/*
+ * inner product of n kernel samples and n data samples.  four partial sums
+ * are accumulated so that the loop can be vectorized without re-ordering
+ * the floating-point additions behind the compiler's back.
+ */
+
+
+static double inner_product(const double *restrict kernel, const REAL8 *restrict data, int n)
+{
+	double val0 = 0., val1 = 0., val2 = 0., val3 = 0.;
+	int i;
+
+	for(i = 0; i + 4 <= n; i += 4) {
+		val0 += kernel[i] * data[i];
+		val1 += kernel[i + 1] * data[i + 1];
+		val2 += kernel[i + 2] * data[i + 2];
+		val3 += kernel[i + 3] * data[i + 3];
+	}
+	for(; i < n; i++)
+		val0 += kernel[i] * data[i];
+
+	return (val0 + val1) + (val2 + val3);
+}
+
+
+/*
+ * evaluate the interpolator at the finite real-valued index x.  this is
+ * the work horse for XLALREAL8SequenceInterpEval() and
+ * XLALREAL8SequenceInterpEvalVector().
+ */
+
+
+static REAL8 sequence_interp_eval(LALREAL8SequenceInterp *interp, double x)
+{
+	const REAL8 *data = interp->s->data;
+	const int length = interp->s->length;
+	const int kernel_length = interp->kernel_length;
+	const double *cached_kernel = interp->cached_kernel;
+	/* split the real-valued sample index into integer and fractional
+	 * parts.  the fractional part (residual) is the offset in samples
+	 * from where we want to evaluate the function to where we know its
+	 * value.  the interpolating kernel depends only on this quantity.
+	 * when we compute a kernel, we record the value of this quantity,
+	 * and only recompute the kernel if this quantity differs from the
+	 * one for which the kernel was computed by more than the no-op
+	 * threshold */
+	int start = lround(x);
+	double residual = start - x;
+	int n = kernel_length;
+
+	/* special no-op case for default kernel */
+	if(fabs(residual) < interp->noop_threshold && interp->kernel == default_kernel)
+		return 0 <= start && start < length ? data[start] : 0.0;
+
+	/* need new kernel? */
+	if(fabs(residual - interp->residual) >= interp->noop_threshold) {
+		interp->kernel(interp->cached_kernel, kernel_length, residual, interp->kernel_data);
+		interp->residual = residual;
+	}
+
+	/* inner product of kernel and samples, clipped to the extent of
+	 * the data */
+	start -= (kernel_length - 1) / 2;
+	if(start + kernel_length > length)
+		n -= start + kernel_length - length;
+	if(start < 0) {
+		cached_kernel -= start;
+		n += start;
+	} else
+		data += start;
+
+	return n > 0 ? inner_product(cached_kernel, data, n) : 0.0;
+}
+
+
 /**
  * Evaluate a LALREAL8SequenceInterp at the real-valued index x.  The data
  * beyond the domain of the input sequence are assumed to be 0 when
@@ -273,46 +348,45 @@ void XLALREAL8SequenceInterpDestroy(LALREAL8SequenceInterp *interp)
 
 REAL8 XLALREAL8SequenceInterpEval(LALREAL8SequenceInterp *interp, double x, int bounds_check)
 {
-	const REAL8 *data = interp->s->data;
-	double *cached_kernel = interp->cached_kernel;
-	double *stop = cached_kernel + interp->kernel_length;
-	/* split the real-valued sample index into integer and fractional
-	 * parts.  the fractional part (residual) is the offset in samples
-	 * from where we want to evaluate the function to where we know its
-	 * value.  the interpolating kernel depends only on this quantity.
-	 * when we compute a kernel, we record the value of this quantity,
-	 * and only recompute the kernel if this quantity differs from the
-	 * one for which the kernel was computed by more than the no-op
-	 * threshold */
-	int start = lround(x);
-	double residual = start - x;
-	REAL8 val;
-
 	if(!isfinite(x) || (bounds_check && (x < 0 || x >= interp->s->length)))
 		XLAL_ERROR_REAL8(XLAL_EDOM);
 
-	/* special no-op case for default kernel */
-	if(fabs(residual) < interp->noop_threshold && interp->kernel == default_kernel)
-		return 0 <= start && start < (int) interp->s->length ? data[start] : 0.0;
+	return sequence_interp_eval(interp, x);
+}
 
-	/* need new kernel? */
-	if(fabs(residual - interp->residual) >= interp->noop_threshold) {
-		interp->kernel(cached_kernel, interp->kernel_length, residual, interp->kernel_data);
-		interp->residual = residual;
-	}
 
-	/* inner product of kernel and samples */
-	start -= (interp->kernel_length - 1) / 2;
-	if(start + interp->kernel_length > (signed) interp->s->length)
-		stop -= start + interp->kernel_length - interp->s->length;
-	if(start < 0)
-		cached_kernel -= start;
-	else
-		data += start;
-	for(val = 0.0; cached_kernel < stop;)
-		val += *cached_kernel++ * *data++;
+/**
+ * Evaluate a LALREAL8SequenceInterp at each of the n real-valued indexes
+ * x[0], ..., x[n - 1], storing the results in result[0], ..., result[n -
+ * 1].  The results are identical to those of n calls to
+ * XLALREAL8SequenceInterpEval() with the same indexes in the same order,
+ * but the per-sample overhead is lower.  Calling code that evaluates a
+ * sequence at many nearby locations, such as when applying a slowly-varying
+ * time delay to a time series, should order the indexes so that successive
+ * sub-sample residuals are similar:  the cached kernel is then re-used for
+ * runs of samples, and only the inner products of the kernel with the data
+ * are computed.
+ *
+ * Returns 0 on success.  An XLAL_EDOM domain error is raised if any x[i]
+ * is not finite, or, if bounds_check is non-zero, is not in [0, length);
+ * the content of result is then undefined.
+ */
+
+
+int XLALREAL8SequenceInterpEvalVector(LALREAL8SequenceInterp *interp, REAL8 *result, const double *x, size_t n, int bounds_check)
+{
+	size_t i;
+
+	if(!interp || (n && (!result || !x)))
+		XLAL_ERROR(XLAL_EFAULT);
 
-	return val;
+	for(i = 0; i < n; i++) {
+		if(!isfinite(x[i]) || (bounds_check && (x[i] < 0 || x[i] >= interp->s->length)))
+			XLAL_ERROR(XLAL_EDOM, "index %zu out of range", i);
+		result[i] = sequence_interp_eval(interp, x[i]);
+	}
+
+	return 0;
 }
 
 
@@ -397,3 +471,42 @@ REAL8 XLALREAL8TimeSeriesInterpEval(LALREAL8TimeSeriesInterp *interp, const LIGO
 {
 	return XLALREAL8SequenceInterpEval(interp->seqinterp, XLALGPSDiff(t, &interp->series->epoch) / interp->series->deltaT, bounds_check);
 }
+
+
+/**
+ * Evaluate a LALREAL8TimeSeriesInterp at the n times t0 + i * deltaT +
+ * offsets[i], for i = 0, ..., n - 1, storing the results in result[0],
+ * ..., result[n - 1].  offsets may be NULL, in which case all offsets are
+ * 0.  The times are converted to sample indexes with a single GPS time
+ * subtraction, after which the evaluation proceeds as in
+ * XLALREAL8SequenceInterpEvalVector().  This is the batched equivalent of
+ * calling XLALREAL8TimeSeriesInterpEval() once for each time, e.g. to
+ * apply a time delay to a whole time series (deltaT is then the sample
+ * period of the output and offsets the delay).  Because the times are not
+ * rounded to integer nanoseconds, the results can differ from those of
+ * XLALREAL8TimeSeriesInterpEval() by the corresponding tiny time shift.
+ *
+ * Returns 0 on success.  See XLALREAL8TimeSeriesInterpEval() for the
+ * meaning of bounds_check, and for the errors that can be raised.
+ */
+
+
+int XLALREAL8TimeSeriesInterpEvalVector(LALREAL8TimeSeriesInterp *interp, REAL8 *result, const LIGOTimeGPS *t0, double deltaT, const double *offsets, size_t n, int bounds_check)
+{
+	double x0;
+	size_t i;
+
+	if(!interp || !t0 || (n && !result))
+		XLAL_ERROR(XLAL_EFAULT);
+
+	x0 = XLALGPSDiff(t0, &interp->series->epoch) / interp->series->deltaT;
+
+	for(i = 0; i < n; i++) {
+		double x = x0 + (i * deltaT + (offsets ? offsets[i] : 0.0)) / interp->series->deltaT;
+		if(!isfinite(x) || (bounds_check && (x < 0 || x >= interp->seqinterp->s->length)))
+			XLAL_ERROR(XLAL_EDOM, "time %zu out of range", i);
+		result[i] = sequence_interp_eval(interp->seqinterp, x);
+	}
+
+	return 0;
+}
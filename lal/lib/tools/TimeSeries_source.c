@@ -8,6 +8,7 @@
 #define SEQUENCETYPE CONCAT2(DATATYPE,Sequence)
 
 #define DSERIES CONCAT2(XLALDestroy,SERIESTYPE)
+#define PSERIES CONCAT3(XLALDestroy,SERIESTYPE,Parked)
 #define CSERIES CONCAT2(XLALCreate,SERIESTYPE)
 #define XSERIES CONCAT2(XLALCut,SERIESTYPE)
 #define RSERIES CONCAT2(XLALResize,SERIESTYPE)
@@ -19,10 +20,22 @@
 #define XSEQUENCE CONCAT2(XLALCut,SEQUENCETYPE)
 #define RSEQUENCE CONCAT2(XLALResize,SEQUENCETYPE)
 
+/* destructor with which series are parked in arenas; see LALArena.h */
+static void PSERIES (
+	void *series
+)
+{
+	DSERIES (series);
+}
+
+
 void DSERIES (
 	SERIESTYPE *series
 )
 {
+	/* park series with allocated data in the active arena, if any */
+	if(series && series->data && series->data->data && XLALArenaPark(series, PSERIES, series->data->length))
+		return;
 	if(series)
 		DSEQUENCE (series->data);
 	XLALFree(series);
@@ -41,12 +54,18 @@ SERIESTYPE *CSERIES (
 	SERIESTYPE *new;
 	SEQUENCETYPE *sequence;
 
-	new = XLALMalloc(sizeof(*new));
-	sequence = CSEQUENCE (length);
-	if(!new || !sequence) {
-		XLALFree(new);
-		DSEQUENCE (sequence);
-		XLAL_ERROR_NULL(XLAL_EFUNC);
+	/* reuse a series of the same length parked in the active arena, if any */
+	new = XLALArenaTake(PSERIES, length);
+	if(new) {
+		sequence = new->data;
+	} else {
+		new = XLALMalloc(sizeof(*new));
+		sequence = CSEQUENCE (length);
+		if(!new || !sequence) {
+			XLALFree(new);
+			DSEQUENCE (sequence);
+			XLAL_ERROR_NULL(XLAL_EFUNC);
+		}
 	}
 
 	if(name) {
@@ -177,6 +196,7 @@ SERIESTYPE *ASERIES (
 #undef SEQUENCETYPE
 
 #undef DSERIES
+#undef PSERIES
 #undef CSERIES
 #undef XSERIES
 #undef RSERIES
@@ -18,6 +18,7 @@
  */
 
 #include <complex.h>
+#include <math.h>
 #include <string.h>
 
 #include <gsl/gsl_errno.h>
@@ -27,7 +28,10 @@
 #include <gsl/gsl_poly.h>
 #include <gsl/gsl_sf_trig.h>
 
+#include <lal/LALConstants.h>
 #include <lal/TriggerInterpolation.h>
+#include <lal/VectorMath.h>
+#include <lal/XLALError.h>
 
 
 /*
@@ -122,6 +126,89 @@ static int XLALREAL4ApplyTriggerInterpolant(
 }
 
 
+/*
+ * Helpers for declaring batch apply functions
+ */
+
+
+/* Number of triggers interpolated together by the batch functions. */
+#define BATCH_BLOCK 32
+
+
+/* Interpolate a block of at most BATCH_BLOCK triggers, with peak neighbourhoods
+ * packed in y, using the workspace work. */
+typedef int (*XLALCOMPLEX16BatchBlockFunc)(const void *, double *, COMPLEX16 *, const COMPLEX16 *, size_t, double *);
+
+
+/* Length of the workspace used to convert a block of COMPLEX8 data. */
+static size_t batch_convert_length(int window)
+{
+    return 2 * BATCH_BLOCK * (2 * window + 1);
+}
+
+
+static int XLALCOMPLEX16ApplyTriggerInterpolantBatch(
+    const void *interp,
+    XLALCOMPLEX16BatchBlockFunc blockfunc,
+    int window,
+    double *tmax,
+    COMPLEX16 *ymax,
+    const COMPLEX16 *y,
+    size_t ntriggers,
+    double *workspace)
+{
+    const size_t stride = 2 * window + 1;
+    size_t i;
+    int ret;
+
+    if (ntriggers > 0 && (!tmax || !ymax || !y || !workspace))
+        GSL_ERROR("null pointer", GSL_EFAULT);
+
+    for (i = 0; i < ntriggers; i += BATCH_BLOCK)
+    {
+        const size_t n = (ntriggers - i < BATCH_BLOCK) ? ntriggers - i : BATCH_BLOCK;
+        ret = blockfunc(interp, &tmax[i], &ymax[i], &y[i * stride], n, workspace);
+        if (ret != GSL_SUCCESS)
+            return ret;
+    }
+    return GSL_SUCCESS;
+}
+
+
+static int XLALCOMPLEX8ApplyTriggerInterpolantBatch(
+    const void *interp,
+    XLALCOMPLEX16BatchBlockFunc blockfunc,
+    int window,
+    double *tmax,
+    COMPLEX8 *ymax,
+    const COMPLEX8 *y,
+    size_t ntriggers,
+    double *workspace)
+{
+    const size_t stride = 2 * window + 1;
+    COMPLEX16 ymax_full[BATCH_BLOCK];
+    COMPLEX16 *y_full = (COMPLEX16 *) workspace;
+    size_t i, j;
+    int ret;
+
+    if (ntriggers > 0 && (!tmax || !ymax || !y || !workspace))
+        GSL_ERROR("null pointer", GSL_EFAULT);
+
+    for (i = 0; i < ntriggers; i += BATCH_BLOCK)
+    {
+        const size_t n = (ntriggers - i < BATCH_BLOCK) ? ntriggers - i : BATCH_BLOCK;
+        for (j = 0; j < n * stride; j ++)
+            y_full[j] = y[i * stride + j];
+        ret = blockfunc(interp, &tmax[i], ymax_full, y_full, n, workspace + batch_convert_length(window));
+        if (ret != GSL_SUCCESS)
+            return ret;
+        for (j = 0; j < n; j ++)
+            ymax[i + j] = ymax_full[j];
+    }
+    return GSL_SUCCESS;
+}
+
+
 /*
  * General functions
  */
@@ -141,7 +228,7 @@ static double cabs2(COMPLEX16 z)
 
 /* Provide declaration of opaque data structure to hold Lanzos interpolant state. */
 struct tagCubicSplineTriggerInterpolant {
-    gsl_poly_complex_workspace *workspace;
+    unsigned int window;
 };
 
 
@@ -193,14 +280,87 @@ static void poly_interp(double *a, const double y_0, const double y_1, const dou
 }
 
 
+/**
+ * Find the roots in (0, 1) at which the polynomial with the \c n real
+ * coefficients \c a changes sign, in increasing order, and return their number.
+ * The polynomial is monotonic between its extrema, which are found recursively
+ * from its derivative, so each interval between them brackets at most one root,
+ * which is refined by bisection.
+ */
+static size_t poly_roots_unit_interval(double *roots, const double *a, size_t n)
+{
+    size_t nx, i, iter, nroots = 0;
+
+    n = poly_strip(a, n);
+    if (n < 2)
+        return 0;
+
+    if (n == 2) {
+        const double r = -a[0] / a[1];
+        if (r > 0 && r < 1)
+            roots[nroots++] = r;
+        return nroots;
+    }
+
+    {
+        double d[n - 1], x[n + 1];
+
+        for (i = 1; i < n; i ++)
+            d[i - 1] = i * a[i];
+        x[0] = 0;
+        nx = 1 + poly_roots_unit_interval(&x[1], d, n - 1);
+        x[nx++] = 1;
+
+        for (i = 0; i + 1 < nx; i ++) {
+            double lo = x[i], hi = x[i + 1];
+            double flo = gsl_poly_eval(a, n, lo);
+            const double fhi = gsl_poly_eval(a, n, hi);
+
+            if (flo == 0) {
+                if (lo > 0 && (nroots == 0 || roots[nroots - 1] != lo))
+                    roots[nroots++] = lo;
+                continue;
+            }
+            if (fhi == 0) {
+                if (hi < 1)
+                    roots[nroots++] = hi;
+                continue;
+            }
+            if ((flo < 0) == (fhi < 0))
+                continue;
+
+            for (iter = 0; iter < 64; iter ++) {
+                const double mid = 0.5 * (lo + hi);
+                double fmid;
+                if (mid <= lo || mid >= hi)
+                    break;
+                fmid = gsl_poly_eval(a, n, mid);
+                if (fmid == 0) {
+                    lo = hi = mid;
+                    break;
+                }
+                if ((fmid < 0) == (flo < 0)) {
+                    lo = mid;
+                    flo = fmid;
+                } else {
+                    hi = mid;
+                }
+            }
+            roots[nroots++] = 0.5 * (lo + hi);
+        }
+    }
+
+    return nroots;
+}
+
+
 /**
  * Treat \c are and \c aim as the real and imaginary parts of a polynomial with
  * \n complex coefficients. Find all local extrema of the absolute value of the
- * polynomial.
+ * polynomial in (0, 1).
  */
-static int interp_find_roots(size_t *nroots, COMPLEX16 *roots, const double *are, const double *aim, size_t n, gsl_poly_complex_workspace *workspace)
+static void interp_find_roots(size_t *nroots, double *roots, const double *are, const double *aim, size_t n)
 {
-    int ret = GSL_EFAILED;
     double b[2 * n - 2];
 
     /* Compute the coefficients of the polynomial
@@ -218,58 +378,29 @@ static int interp_find_roots(size_t *nroots, COMPLEX16 *roots, const double *are
         poly_mac(b, &ad[1], n - 1, aim, n);
     }
 
-    n = poly_strip(b, 2 * n - 2);
-
-    if (n == 0) {
-        *nroots = 0;
-        return GSL_SUCCESS;
-    }
-
-    ret = gsl_poly_complex_solve(b, n, workspace, (double *) roots);
-    if (ret == GSL_SUCCESS)
-        *nroots = n - 1;
-
-    return ret;
+    *nroots = poly_roots_unit_interval(roots, b, 2 * n - 2);
 }
 
 
 /**
- * Perform cubic spline interpolation of a trigger. Since cubic splines
- * inherently take into account an even number of samples, we are going to
- * have to call this function twice: once for the first four of the five samples
- * surrounding the trigger and once for the last four of the five samples
- * surrounding the trigger.
+ * Find the maximum of the absolute value of the interpolating polynomials with
+ * coefficients \c are and \c aim over [0, 1], among the endpoints \c y_1 and
+ * \c y_2 and the \c nroots local extrema \c roots.
  */
-static int cubic_interp_1(gsl_poly_complex_workspace *workspace, double *t, COMPLEX16 *val, const COMPLEX16 *y)
+static void cubic_max_1(double *t, COMPLEX16 *val, const double *are, const double *aim, size_t n, COMPLEX16 y_1, COMPLEX16 y_2, const double *roots, size_t nroots)
 {
-    double argmax = NAN, new_argmax;
+    double argmax, new_argmax;
     COMPLEX16 maxval, new_maxval;
     double max_abs2, new_max_abs2;
-
-    size_t n = 4;
-    double are[n], aim[n];
-    COMPLEX16 roots[2 * n - 3];
-
-    size_t nroots, iroot;
-    int result;
-
-    /* Compute coefficients of interpolating polynomials for real and imaginary
-     * parts of data. */
-    poly_interp(are, creal(y[0]), creal(y[1]), creal(y[2]), creal(y[3]));
-    poly_interp(aim, cimag(y[0]), cimag(y[1]), cimag(y[2]), cimag(y[3]));
-
-    /* Find local maxima of (|a|^2 + |b|^2). */
-    result = interp_find_roots(&nroots, roots, are, aim, n, workspace);
-    if (result != GSL_SUCCESS)
-        return result;
+    size_t iroot;
 
     /* Determine which of the endpoints is greater. */
     argmax = 0;
-    maxval = y[1];
+    maxval = y_1;
     max_abs2 = cabs2(maxval);
 
     new_argmax = 1;
-    new_maxval = y[2];
+    new_maxval = y_2;
     new_max_abs2 = cabs2(new_maxval);
     if (new_max_abs2 > max_abs2) {
         argmax = new_argmax;
@@ -279,28 +410,58 @@ static int cubic_interp_1(gsl_poly_complex_workspace *workspace, double *t, COMP
 
     /* See if there is a local extremum that is greater than the endpoints. */
     for (iroot = 0; iroot < nroots; iroot++) {
-        /* Skip this root if it is complex. */
-        if (cimag(roots[iroot]) != 0)
-            continue;
-
-        new_argmax = creal(roots[iroot]);
-
-        /* Skip this root if it is outside of (0, 1) */
-        if (new_argmax <= 0 || new_argmax >= 1)
-            continue;
-
+        new_argmax = roots[iroot];
         new_maxval = gsl_poly_eval(are, n, new_argmax) + gsl_poly_eval(aim, n, new_argmax) * I;
         new_max_abs2 = cabs2(new_maxval);
 
         if (new_max_abs2 > max_abs2) {
             argmax = new_argmax;
             maxval = new_maxval;
+            max_abs2 = new_max_abs2;
         }
     }
 
     *t = argmax;
     *val = maxval;
-    return GSL_SUCCESS;
+}
+
+
+/**
+ * Perform cubic spline interpolation of a trigger. Since cubic splines
+ * inherently take into account an even number of samples, we are going to
+ * have to call this function twice: once for the first four of the five samples
+ * surrounding the trigger and once for the last four of the five samples
+ * surrounding the trigger.
+ */
+static void cubic_interp_1(double *t, COMPLEX16 *val, const COMPLEX16 *y)
+{
+    size_t n = 4;
+    double are[n], aim[n];
+    double roots[2 * n - 3];
+    size_t nroots;
+
+    /* Compute coefficients of interpolating polynomials for real and imaginary
+     * parts of data. */
+    poly_interp(are, creal(y[0]), creal(y[1]), creal(y[2]), creal(y[3]));
+    poly_interp(aim, cimag(y[0]), cimag(y[1]), cimag(y[2]), cimag(y[3]));
+
+    /* Find local maxima of (|a|^2 + |b|^2). */
+    interp_find_roots(&nroots, roots, are, aim, n);
+
+    cubic_max_1(t, val, are, aim, n, y[1], y[2], roots, nroots);
+}
+
+
+/* Choose between the maxima of the two cubic splines surrounding a trigger. */
+static void cubic_choose(double *t, COMPLEX16 *y, double argmax1, COMPLEX16 max1, double argmax2, COMPLEX16 max2)
+{
+    if (cabs2(max1) > cabs2(max2)) {
+        *t = argmax1 - 1;
+        *y = max1;
+    } else {
+        *t = argmax2;
+        *y = max2;
+    }
 }
 
 
@@ -314,9 +475,7 @@ CubicSplineTriggerInterpolant *XLALCreateCubicSplineTriggerInterpolant(unsigned
     if (!interp)
         goto fail;
 
-    interp->workspace = gsl_poly_complex_workspace_alloc(6);
-    if (!interp->workspace)
-        goto fail;
+    interp->window = window;
 
     return interp;
 fail:
@@ -327,42 +486,22 @@ fail:
 
 void XLALDestroyCubicSplineTriggerInterpolant(CubicSplineTriggerInterpolant *interp)
 {
-    if (interp)
-    {
-        gsl_poly_complex_workspace_free(interp->workspace);
-        interp->workspace = NULL;
-    }
     free(interp);
 }
 
 
 int XLALCOMPLEX16ApplyCubicSplineTriggerInterpolant(
-    CubicSplineTriggerInterpolant *interp,
+    __attribute__ ((unused)) CubicSplineTriggerInterpolant *interp,
     double *t,
     COMPLEX16 *y,
     const COMPLEX16 *data)
 {
     COMPLEX16 max1, max2;
-    double max1_abs1, max2_abs2;
     double argmax1, argmax2;
-    int result;
 
-    result = cubic_interp_1(interp->workspace, &argmax1, &max1, &data[-2]);
-    if (result != GSL_SUCCESS)
-        return result;
-    result = cubic_interp_1(interp->workspace, &argmax2, &max2, &data[-1]);
-    if (result != GSL_SUCCESS)
-        return result;
-    max1_abs1 = cabs2(max1);
-    max2_abs2 = cabs2(max2);
-
-    if (max1_abs1 > max2_abs2) {
-        *t = argmax1 - 1;
-        *y = max1;
-    } else {
-        *t = argmax2;
-        *y = max2;
-    }
+    cubic_interp_1(&argmax1, &max1, &data[-2]);
+    cubic_interp_1(&argmax2, &max2, &data[-1]);
+    cubic_choose(t, y, argmax1, max1, argmax2, max2);
 
     return GSL_SUCCESS;
 }
@@ -404,6 +543,124 @@ int XLALREAL4ApplyCubicSplineTriggerInterpolant(
 }
 
 
+/* Workspace: coefficients of the two splines (4 real, 4 imaginary) and of the
+ * derivatives of their squared absolute values (6), for each trigger of a block. */
+#define CUBIC_NCOEF (2 * (4 + 4 + 6))
+
+
+/* Interpolate a block of triggers. The spline coefficients of all triggers are
+ * computed together, one coefficient at a time, before the extrema of each
+ * trigger are found. */
+static int cubic_interp_block(
+    const void *interp_,
+    double *t,
+    COMPLEX16 *val,
+    const COMPLEX16 *y,
+    size_t n,
+    double *work)
+{
+    const CubicSplineTriggerInterpolant *interp = interp_;
+    const size_t stride = 2 * interp->window + 1;
+    double (*coef)[BATCH_BLOCK] = (double (*)[BATCH_BLOCK]) work;
+    size_t s, c, ia, ib, k;
+
+    for (s = 0; s < 2; s ++)
+    {
+        double (*are)[BATCH_BLOCK] = &coef[14 * s];
+        double (*aim)[BATCH_BLOCK] = &coef[14 * s + 4];
+        double (*b)[BATCH_BLOCK] = &coef[14 * s + 8];
+
+        /* Coefficients of interpolating polynomials for samples s - 2 to s + 1. */
+        for (k = 0; k < n; k ++)
+        {
+            const COMPLEX16 *yk = &y[k * stride + interp->window + s - 2];
+            double re[4], im[4];
+            for (c = 0; c < 4; c ++)
+            {
+                re[c] = creal(yk[c]);
+                im[c] = cimag(yk[c]);
+            }
+            are[3][k] = 0.5 * (re[3] - re[0]) + 1.5 * (re[1] - re[2]);
+            are[2][k] = re[0] - 2.5 * re[1] + 2 * re[2] - 0.5 * re[3];
+            are[1][k] = 0.5 * (re[2] - re[0]);
+            are[0][k] = re[1];
+            aim[3][k] = 0.5 * (im[3] - im[0]) + 1.5 * (im[1] - im[2]);
+            aim[2][k] = im[0] - 2.5 * im[1] + 2 * im[2] - 0.5 * im[3];
+            aim[1][k] = 0.5 * (im[2] - im[0]);
+            aim[0][k] = im[1];
+        }
+
+        /* Coefficients of D[|a|^2 + |b|^2, t]. */
+        for (c = 0; c < 6; c ++)
+            for (k = 0; k < n; k ++)
+                b[c][k] = 0;
+        for (ia = 1; ia < 4; ia ++)
+            for (ib = 0; ib < 4; ib ++)
+                for (k = 0; k < n; k ++)
+                    b[ia + ib - 1][k] += ia * (are[ia][k] * are[ib][k] + aim[ia][k] * aim[ib][k]);
+    }
+
+    for (k = 0; k < n; k ++)
+    {
+        const COMPLEX16 *yk = &y[k * stride + interp->window];
+        double argmax[2];
+        COMPLEX16 maxval[2];
+
+        for (s = 0; s < 2; s ++)
+        {
+            double are[4], aim[4], b[6], roots[5];
+            size_t nroots;
+            for (c = 0; c < 4; c ++)
+            {
+                are[c] = coef[14 * s + c][k];
+                aim[c] = coef[14 * s + 4 + c][k];
+            }
+            for (c = 0; c < 6; c ++)
+                b[c] = coef[14 * s + 8 + c][k];
+            nroots = poly_roots_unit_interval(roots, b, 6);
+            cubic_max_1(&argmax[s], &maxval[s], are, aim, 4, yk[s - 1], yk[s], roots, nroots);
+        }
+
+        cubic_choose(&t[k], &val[k], argmax[0], maxval[0], argmax[1], maxval[1]);
+    }
+
+    return GSL_SUCCESS;
+}
+
+
+size_t XLALCubicSplineTriggerInterpolantBatchWorkspaceLength(
+    const CubicSplineTriggerInterpolant *interp)
+{
+    return batch_convert_length(interp->window) + CUBIC_NCOEF * BATCH_BLOCK;
+}
+
+
+int XLALCOMPLEX16ApplyCubicSplineTriggerInterpolantBatch(
+    const CubicSplineTriggerInterpolant *interp,
+    double *tmax,
+    COMPLEX16 *ymax,
+    const COMPLEX16 *y,
+    size_t ntriggers,
+    double *workspace)
+{
+    return XLALCOMPLEX16ApplyTriggerInterpolantBatch(interp, cubic_interp_block,
+        interp->window, tmax, ymax, y, ntriggers, workspace);
+}
+
+
+int XLALCOMPLEX8ApplyCubicSplineTriggerInterpolantBatch(
+    const CubicSplineTriggerInterpolant *interp,
+    double *tmax,
+    COMPLEX8 *ymax,
+    const COMPLEX8 *y,
+    size_t ntriggers,
+    double *workspace)
+{
+    return XLALCOMPLEX8ApplyTriggerInterpolantBatch(interp, cubic_interp_block,
+        interp->window, tmax, ymax, y, ntriggers, workspace);
+}
+
+
 /*
  * Lanczos
  */
@@ -551,6 +808,208 @@ int XLALREAL4ApplyLanczosTriggerInterpolant(
 }
 
 
+/* Number of golden-section iterations performed by the batch functions, which
+ * narrow the initial bracket (-1, 1) to less than 1e-6. */
+#define LANCZOS_BATCH_ITERATIONS 31
+
+
+/* Workspace: kernel tables (2 * (2 * window + 1)), and lanes for the bracket
+ * (lo, hi), interior points (x1, x2), their costs (f1, f2), the next point and
+ * its cost, which side of the bracket was kept, the kernel phases, sines and
+ * cosines (2 each) and the interpolant (re, im). */
+#define LANCZOS_NLANES 17
+
+
+/**
+ * Evaluate the Lanczos interpolants of a block of triggers at the times \c t,
+ * and set \c cost to the corresponding cost function, and \c val to the
+ * interpolated values if it is not NULL.
+ *
+ * Since sin(pi (t - i)) = (-1)^i sin(pi t), and sin(pi (t - i) / a) follows from
+ * sin(pi t / a) and cos(pi t / a) with the tables <tt>tab[i] = (-1)^i cos(pi i / a)</tt>
+ * and <tt>tab[2 a + 1 + i] = (-1)^i sin(pi i / a)</tt>, the kernel at all 2 a + 1
+ * samples needs only one sine and cosine pair per argument, which are computed for
+ * the whole block at once.
+ */
+static int lanczos_interpolant_block(
+    double *cost,
+    COMPLEX16 *val,
+    const double *t,
+    const COMPLEX16 *y,
+    size_t n,
+    unsigned int window,
+    const double *tab,
+    double *work)
+{
+    const int w = window;
+    const double a = window;
+    const size_t stride = 2 * window + 1;
+    double *ph = &work[0];
+    double *sn = &work[2 * BATCH_BLOCK];
+    double *cs = &work[4 * BATCH_BLOCK];
+    double *re = &work[6 * BATCH_BLOCK];
+    double *im = &work[7 * BATCH_BLOCK];
+    size_t k;
+    int i;
+
+    for (k = 0; k < n; k ++)
+    {
+        ph[k] = LAL_PI * t[k];
+        ph[n + k] = LAL_PI * t[k] / a;
+        re[k] = im[k] = 0;
+    }
+    if (XLALVectorSinCosREAL8(sn, cs, ph, 2 * n) != XLAL_SUCCESS)
+        GSL_ERROR("failed to evaluate Lanczos kernel", GSL_EFAILED);
+
+    for (i = -w; i <= w; i ++)
+    {
+        const double ci = tab[w + i], si = tab[stride + w + i];
+        for (k = 0; k < n; k ++)
+        {
+            const double u = t[k] - i;
+            const double ker = (u == 0) ? 1 : a * sn[k] * (sn[n + k] * ci - cs[n + k] * si) / (LAL_PI * LAL_PI * u * u);
+            re[k] += ker * creal(y[k * stride + w + i]);
+            im[k] += ker * cimag(y[k * stride + w + i]);
+        }
+    }
+
+    for (k = 0; k < n; k ++)
+    {
+        cost[k] = -(gsl_pow_2(re[k]) + gsl_pow_2(im[k]));
+        if (val)
+            val[k] = re[k] + im[k] * I;
+    }
+
+    return GSL_SUCCESS;
+}
+
+
+/* Interpolate a block of triggers. The maxima are found by golden-section
+ * searches of the bracket (-1, 1), which are performed in lock step for all
+ * triggers of the block, so that the interpolants are evaluated together. */
+static int lanczos_interp_block(
+    const void *interp_,
+    double *t,
+    COMPLEX16 *val,
+    const COMPLEX16 *y,
+    size_t n,
+    double *work)
+{
+    static const double g = 0.61803398874989484820; /* (sqrt(5) - 1) / 2 */
+    const LanczosTriggerInterpolant *interp = interp_;
+    const int w = interp->window;
+    const size_t stride = 2 * interp->window + 1;
+    double *tab = work;
+    double *lane = &work[2 * stride];
+    double *lo = &lane[0 * BATCH_BLOCK];
+    double *hi = &lane[1 * BATCH_BLOCK];
+    double *x1 = &lane[2 * BATCH_BLOCK];
+    double *x2 = &lane[3 * BATCH_BLOCK];
+    double *f1 = &lane[4 * BATCH_BLOCK];
+    double *f2 = &lane[5 * BATCH_BLOCK];
+    double *xnew = &lane[6 * BATCH_BLOCK];
+    double *fnew = &lane[7 * BATCH_BLOCK];
+    double *left = &lane[8 * BATCH_BLOCK];
+    double *kernwork = &lane[9 * BATCH_BLOCK];
+    size_t k, iter;
+    int i, ret;
+
+    for (i = -w; i <= w; i ++)
+    {
+        const double sign = (i % 2 == 0) ? 1 : -1;
+        tab[w + i] = sign * cos(LAL_PI * i / w);
+        tab[stride + w + i] = sign * sin(LAL_PI * i / w);
+    }
+
+    for (k = 0; k < n; k ++)
+    {
+        lo[k] = -1;
+        hi[k] = 1;
+        x1[k] = hi[k] - g * (hi[k] - lo[k]);
+        x2[k] = lo[k] + g * (hi[k] - lo[k]);
+    }
+    ret = lanczos_interpolant_block(f1, NULL, x1, y, n, w, tab, kernwork);
+    if (ret != GSL_SUCCESS)
+        return ret;
+    ret = lanczos_interpolant_block(f2, NULL, x2, y, n, w, tab, kernwork);
+    if (ret != GSL_SUCCESS)
+        return ret;
+
+    for (iter = 0; iter < LANCZOS_BATCH_ITERATIONS; iter ++)
+    {
+        /* Keep the side of the bracket containing the lower cost. */
+        for (k = 0; k < n; k ++)
+        {
+            left[k] = f1[k] < f2[k];
+            if (left[k]) {
+                hi[k] = x2[k];
+                x2[k] = x1[k];
+                f2[k] = f1[k];
+                x1[k] = xnew[k] = hi[k] - g * (hi[k] - lo[k]);
+            } else {
+                lo[k] = x1[k];
+                x1[k] = x2[k];
+                f1[k] = f2[k];
+                x2[k] = xnew[k] = lo[k] + g * (hi[k] - lo[k]);
+            }
+        }
+        ret = lanczos_interpolant_block(fnew, NULL, xnew, y, n, w, tab, kernwork);
+        if (ret != GSL_SUCCESS)
+            return ret;
+        for (k = 0; k < n; k ++)
+        {
+            if (left[k])
+                f1[k] = fnew[k];
+            else
+                f2[k] = fnew[k];
+        }
+    }
+
+    /* Take the best point found, or the peak sample if it is better. */
+    for (k = 0; k < n; k ++)
+    {
+        t[k] = (f1[k] < f2[k]) ? x1[k] : x2[k];
+        if (-cabs2(y[k * stride + w]) <= fmin(f1[k], f2[k]))
+            t[k] = 0;
+    }
+
+    return lanczos_interpolant_block(fnew, val, t, y, n, w, tab, kernwork);
+}
+
+
+size_t XLALLanczosTriggerInterpolantBatchWorkspaceLength(
+    const LanczosTriggerInterpolant *interp)
+{
+    return batch_convert_length(interp->window) + 2 * (2 * interp->window + 1) + LANCZOS_NLANES * BATCH_BLOCK;
+}
+
+
+int XLALCOMPLEX16ApplyLanczosTriggerInterpolantBatch(
+    const LanczosTriggerInterpolant *interp,
+    double *tmax,
+    COMPLEX16 *ymax,
+    const COMPLEX16 *y,
+    size_t ntriggers,
+    double *workspace)
+{
+    return XLALCOMPLEX16ApplyTriggerInterpolantBatch(interp, lanczos_interp_block,
+        interp->window, tmax, ymax, y, ntriggers, workspace);
+}
+
+
+int XLALCOMPLEX8ApplyLanczosTriggerInterpolantBatch(
+    const LanczosTriggerInterpolant *interp,
+    double *tmax,
+    COMPLEX8 *ymax,
+    const COMPLEX8 *y,
+    size_t ntriggers,
+    double *workspace)
+{
+    return XLALCOMPLEX8ApplyTriggerInterpolantBatch(interp, lanczos_interp_block,
+        interp->window, tmax, ymax, y, ntriggers, workspace);
+}
+
+
 /*
  * Nearest neighbor
  */
@@ -672,7 +1131,7 @@ QuadraticFitTriggerInterpolant *XLALCreateQuadraticFitTriggerInterpolant(unsigne
 
     for (i = 0; i < 2 * (int)window + 1; i ++)
     {
-        double x = i - window;
+        double x = i - (int)window;
         gsl_matrix_set(interp->X, i, 0, 1);
         gsl_matrix_set(interp->X, i, 1, x);
         gsl_matrix_set(interp->X, i, 2, gsl_pow_2(x));
@@ -730,7 +1189,7 @@ int XLALCOMPLEX16ApplyQuadraticFitTriggerInterpolant(
     double a, b, tmax;
 
     for (i = -(int)interp->window; i <= (int)interp->window; i ++)
-        gsl_vector_set(interp->y, i + interp->window, cabs(y[i]));
+        gsl_vector_set(interp->y, i + interp->window, cabs(data[i]));
 
     result = gsl_multifit_linear(interp->X, interp->y, interp->c, interp->cov, &chisq, interp->workspace);
     if (result != GSL_SUCCESS)
@@ -785,3 +1244,103 @@ int XLALREAL4ApplyQuadraticFitTriggerInterpolant(
         (XLALCOMPLEX16ApplyFunc) XLALCOMPLEX16ApplyQuadraticFitTriggerInterpolant,
         interp->window, tmax, ymax, y);
 }
+
+
+/* Workspace: least-squares weights of the quadratic and linear coefficients
+ * (2 * (2 * window + 1)), and lanes for those coefficients. */
+#define QUADRATIC_NLANES 2
+
+
+/* Interpolate a block of triggers. With samples at -window, ..., window, the
+ * least-squares quadratic and linear coefficients are fixed linear combinations
+ * of the absolute values of the samples, which are accumulated one sample at a
+ * time for all triggers of the block. */
+static int quadratic_interp_block(
+    const void *interp_,
+    double *t,
+    COMPLEX16 *val,
+    const COMPLEX16 *y,
+    size_t n,
+    double *work)
+{
+    const QuadraticFitTriggerInterpolant *interp = interp_;
+    const int w = interp->window;
+    const size_t stride = 2 * interp->window + 1;
+    double *wa = &work[0];
+    double *wb = &work[stride];
+    double *a = &work[2 * stride];
+    double *b = &work[2 * stride + BATCH_BLOCK];
+    double s2 = 0, s4 = 0;
+    size_t k;
+    int i;
+
+    /* Solve the normal equations: the linear coefficient decouples from the
+     * constant and quadratic coefficients since the samples are symmetric. */
+    for (i = -w; i <= w; i ++)
+    {
+        s2 += gsl_pow_2(i);
+        s4 += gsl_pow_4(i);
+    }
+    for (i = -w; i <= w; i ++)
+    {
+        wa[w + i] = (stride * gsl_pow_2(i) - s2) / (stride * s4 - gsl_pow_2(s2));
+        wb[w + i] = i / s2;
+    }
+
+    for (k = 0; k < n; k ++)
+        a[k] = b[k] = 0;
+    for (i = -w; i <= w; i ++)
+        for (k = 0; k < n; k ++)
+        {
+            const double absy = cabs(y[k * stride + w + i]);
+            a[k] += wa[w + i] * absy;
+            b[k] += wb[w + i] * absy;
+        }
+
+    for (k = 0; k < n; k ++)
+    {
+        const double tmax = -0.5 * b[k] / a[k];
+
+        if ((a[k] > 0 || (a[k] == 0 && b[k] > 0)) && tmax > -1 && tmax < 1)
+            t[k] = tmax;
+        else
+            t[k] = 0;
+
+        val[k] = y[k * stride + w];
+    }
+
+    return GSL_SUCCESS;
+}
+
+
+size_t XLALQuadraticFitTriggerInterpolantBatchWorkspaceLength(
+    const QuadraticFitTriggerInterpolant *interp)
+{
+    return batch_convert_length(interp->window) + 2 * (2 * interp->window + 1) + QUADRATIC_NLANES * BATCH_BLOCK;
+}
+
+
+int XLALCOMPLEX16ApplyQuadraticFitTriggerInterpolantBatch(
+    const QuadraticFitTriggerInterpolant *interp,
+    double *tmax,
+    COMPLEX16 *ymax,
+    const COMPLEX16 *y,
+    size_t ntriggers,
+    double *workspace)
+{
+    return XLALCOMPLEX16ApplyTriggerInterpolantBatch(interp, quadratic_interp_block,
+        interp->window, tmax, ymax, y, ntriggers, workspace);
+}
+
+
+int XLALCOMPLEX8ApplyQuadraticFitTriggerInterpolantBatch(
+    const QuadraticFitTriggerInterpolant *interp,
+    double *tmax,
+    COMPLEX8 *ymax,
+    const COMPLEX8 *y,
+    size_t ntriggers,
+    double *workspace)
+{
+    return XLALCOMPLEX8ApplyTriggerInterpolantBatch(interp, quadratic_interp_block,
+        interp->window, tmax, ymax, y, ntriggers, workspace);
+}
@@ -19,6 +19,7 @@
  * Copyright (C) 2012 Leo Singer
  */
 
+#include <stddef.h>
 #include <lal/LALAtomicDatatypes.h>
 
 #ifndef _TRIGGERINTERPOLATION_H
@@ -83,6 +84,21 @@ extern "C" {
  * XLALDestroyLanczosTriggerInterpolant(interp);
  * \endcode
  *
+ * The cubic spline, Lanczos and quadratic fit interpolants can also be applied
+ * to many triggers at once. The neighbourhoods of the peaks are packed one
+ * after another, and the caller provides the workspace, whose length is given
+ * by \c XLALLanczosTriggerInterpolantBatchWorkspaceLength:
+ *
+ * \code{.c}
+ * double *work = malloc(XLALLanczosTriggerInterpolantBatchWorkspaceLength(interp) * sizeof(double));
+ * int result = XLALCOMPLEX16ApplyLanczosTriggerInterpolantBatch(interp, tmax, ymax, y, ntriggers, work);
+ * \endcode
+ *
+ * Here the peak of trigger \c k is <tt>y[k * (2 * 5 + 1) + 5]</tt>, and its
+ * interpolated index and value are stored in \c tmax[k] and \c ymax[k]. The
+ * batch functions do not modify the interpolant, so threads may share one
+ * interpolant, each with its own workspace.
+ *
  * \{
  */
 
@@ -157,6 +173,42 @@ int XLALREAL4ApplyCubicSplineTriggerInterpolant(
     REAL4 *ymax,
     const REAL4 *y);
 
+/**
+ * Return the length, in doubles, of the workspace required to apply the
+ * interpolant to a batch of triggers.
+ */
+size_t XLALCubicSplineTriggerInterpolantBatchWorkspaceLength(
+    const CubicSplineTriggerInterpolant *interp);
+
+/**
+ * Perform interpolation of a batch of triggers using a workspace provided by
+ * the caller.
+ *
+ * The \c ntriggers neighbourhoods of <tt>2 * window + 1</tt> samples are packed
+ * one after another in \c y, so that the peak of trigger \c k is
+ * <tt>y[k * (2 * window + 1) + window]</tt>. \c workspace must hold at least
+ * XLALCubicSplineTriggerInterpolantBatchWorkspaceLength() doubles.
+ *
+ * On success, set \c tmax[k] and \c ymax[k] to the interpolated time and
+ * complex signal of trigger \c k, and return 0. On failure, return a non-zero
+ * GSL error code.
+ */
+int XLALCOMPLEX16ApplyCubicSplineTriggerInterpolantBatch(
+    const CubicSplineTriggerInterpolant *interp,
+    double *tmax,
+    COMPLEX16 *ymax,
+    const COMPLEX16 *y,
+    size_t ntriggers,
+    double *workspace);
+
+int XLALCOMPLEX8ApplyCubicSplineTriggerInterpolantBatch(
+    const CubicSplineTriggerInterpolant *interp,
+    double *tmax,
+    COMPLEX8 *ymax,
+    const COMPLEX8 *y,
+    size_t ntriggers,
+    double *workspace);
+
 /** \} */
 
 
@@ -223,6 +275,42 @@ int XLALREAL4ApplyLanczosTriggerInterpolant(
     REAL4 *ymax,
     const REAL4 *y);
 
+/**
+ * Return the length, in doubles, of the workspace required to apply the
+ * interpolant to a batch of triggers.
+ */
+size_t XLALLanczosTriggerInterpolantBatchWorkspaceLength(
+    const LanczosTriggerInterpolant *interp);
+
+/**
+ * Perform interpolation of a batch of triggers using a workspace provided by
+ * the caller.
+ *
+ * The \c ntriggers neighbourhoods of <tt>2 * window + 1</tt> samples are packed
+ * one after another in \c y, so that the peak of trigger \c k is
+ * <tt>y[k * (2 * window + 1) + window]</tt>. \c workspace must hold at least
+ * XLALLanczosTriggerInterpolantBatchWorkspaceLength() doubles.
+ *
+ * On success, set \c tmax[k] and \c ymax[k] to the interpolated time and
+ * complex signal of trigger \c k, and return 0. On failure, return a non-zero
+ * GSL error code.
+ */
+int XLALCOMPLEX16ApplyLanczosTriggerInterpolantBatch(
+    const LanczosTriggerInterpolant *interp,
+    double *tmax,
+    COMPLEX16 *ymax,
+    const COMPLEX16 *y,
+    size_t ntriggers,
+    double *workspace);
+
+int XLALCOMPLEX8ApplyLanczosTriggerInterpolantBatch(
+    const LanczosTriggerInterpolant *interp,
+    double *tmax,
+    COMPLEX8 *ymax,
+    const COMPLEX8 *y,
+    size_t ntriggers,
+    double *workspace);
+
 /** \} */
 
 
@@ -363,6 +451,42 @@ int XLALREAL4ApplyQuadraticFitTriggerInterpolant(
     REAL4 *ymax,
     const REAL4 *y);
 
+/**
+ * Return the length, in doubles, of the workspace required to apply the
+ * interpolant to a batch of triggers.
+ */
+size_t XLALQuadraticFitTriggerInterpolantBatchWorkspaceLength(
+    const QuadraticFitTriggerInterpolant *interp);
+
+/**
+ * Perform interpolation of a batch of triggers using a workspace provided by
+ * the caller.
+ *
+ * The \c ntriggers neighbourhoods of <tt>2 * window + 1</tt> samples are packed
+ * one after another in \c y, so that the peak of trigger \c k is
+ * <tt>y[k * (2 * window + 1) + window]</tt>. \c workspace must hold at least
+ * XLALQuadraticFitTriggerInterpolantBatchWorkspaceLength() doubles.
+ *
+ * On success, set \c tmax[k] and \c ymax[k] to the interpolated time and
+ * complex signal of trigger \c k, and return 0. On failure, return a non-zero
+ * GSL error code.
+ */
+int XLALCOMPLEX16ApplyQuadraticFitTriggerInterpolantBatch(
+    const QuadraticFitTriggerInterpolant *interp,
+    double *tmax,
+    COMPLEX16 *ymax,
+    const COMPLEX16 *y,
+    size_t ntriggers,
+    double *workspace);
+
+int XLALCOMPLEX8ApplyQuadraticFitTriggerInterpolantBatch(
+    const QuadraticFitTriggerInterpolant *interp,
+    double *tmax,
+    COMPLEX8 *ymax,
+    const COMPLEX8 *y,
+    size_t ntriggers,
+    double *workspace);
+
 /** \} */
 
 
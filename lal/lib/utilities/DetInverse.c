@@ -17,10 +17,12 @@
 *  MA  02110-1301  USA
 */
 
+#include <config.h>
 #include <math.h>
 #include <lal/LALStdlib.h>
 #include <lal/AVFactories.h>
 #include <lal/MatrixUtils.h>
+#include "MatrixUtils_internal.h"
 
 
 /*
@@ -83,6 +85,8 @@
  */
 
 
+#ifndef HAVE_LAPACK
+
 static void
 LALSLUDecomp( LALStatus   *stat,
 	      INT2        *sgn,
@@ -451,6 +455,59 @@ LALDLUBackSub( LALStatus   *stat,
 }
 
 
+#else /* HAVE_LAPACK */
+
+int
+XLALMatrixInverseWorkLAPACK( int n )
+{
+  /* Optimal length for the blocked inversion in ?getri(), for the
+     usual block size of 32. */
+  return n > 1 ? 32*n : 1;
+}
+
+
+/* LAPACK sees the transpose of the row-major matrix, which has the
+   same determinant, and whose inverse is the transpose of the inverse:
+   so the row-major inverse is obtained directly. */
+#define MATRIXINVERSE( T, GETRF, GETRI )                             \
+do {                                                                 \
+  int i_, info_ = 0;                                                 \
+  GETRF( &n, &n, m, &n, ipiv, &info_ );                              \
+  if ( info_ < 0 )                                                   \
+    return info_;                                                    \
+  /* Compute the determinant from the diagonal of the decomposed     \
+     matrix and the sign of the row interchanges; it is zero if the  \
+     matrix is singular. */                                          \
+  if ( det ) {                                                       \
+    *det = 1.0;                                                      \
+    for ( i_ = 0; i_ < n; i_++ )                                     \
+      *det *= ( ipiv[i_] == i_ + 1 ? 1.0 : -1.0 )*m[i_*(n+1)];       \
+  }                                                                  \
+  if ( info_ > 0 || !inverse )                                       \
+    return info_;                                                    \
+  if ( inverse != m )                                                \
+    memcpy( inverse, m, n*n*sizeof(T) );                             \
+  GETRI( &n, inverse, &n, ipiv, work, &lwork, &info_ );              \
+  return info_;                                                      \
+} while ( 0 )
+
+
+int
+XLALSMatrixInverseLAPACK( REAL4 *det, REAL4 *m, REAL4 *inverse, int n, int *ipiv, REAL4 *work, int lwork )
+{
+  MATRIXINVERSE( REAL4, sgetrf_, sgetri_ );
+}
+
+
+int
+XLALDMatrixInverseLAPACK( REAL8 *det, REAL8 *m, REAL8 *inverse, int n, int *ipiv, REAL8 *work, int lwork )
+{
+  MATRIXINVERSE( REAL8, dgetrf_, dgetri_ );
+}
+
+#endif /* HAVE_LAPACK */
+
+
 /**
  * \defgroup DetInverse_c Module DetInverse.c
  * \ingroup MatrixUtils_h
@@ -551,6 +608,13 @@ LALDLUBackSub( LALStatus   *stat,
  * by the routines in \ref DetInverse_c, so the information in
  * <tt>*matrix</tt> will be irretrievably mangled.
  *
+ * If LAL was configured with the LAPACK library (see the
+ * <tt>--with-lapack</tt> option to \c configure), these routines instead
+ * call the LAPACK routines <tt>?getrf()</tt> to perform the LU
+ * decomposition, and <tt>?getri()</tt> to compute the inverse, which use
+ * blocked, BLAS-based algorithms.  In this case too, the input
+ * <tt>*matrix</tt> is left in a decomposed state.
+ *
  * Computing the determinant is dominated by the cost of doing the LU
  * decomposition, or of order \f$N^3/3\f$ operations.  Computing the inverse
  * requires an additional \f$N\f$ back-substitutions, but since most of the
@@ -614,6 +678,62 @@ LALDLUBackSub( LALStatus   *stat,
 /** \see See \ref DetInverse_c for documentation */
 void
 LALSMatrixInverse( LALStatus *stat, REAL4 *det, REAL4Array *matrix, REAL4Array *inverse )
+#ifdef HAVE_LAPACK
+{
+  int n, lwork, info;       /* matrix dimension, workspace length, and
+                               LAPACK return code */
+  int *ipiv;                /* permutation storage vector */
+  REAL4 *work;                /* LAPACK workspace */
+
+  INITSTATUS(stat);
+
+  /* Check input fields. */
+  ASSERT( matrix, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix->data, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix->dimLength, stat, MATRIXUTILSH_ENUL,
+	  MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix->dimLength->data, stat, MATRIXUTILSH_ENUL,
+	  MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix->dimLength->length == 2, stat, MATRIXUTILSH_EDIM,
+	  MATRIXUTILSH_MSGEDIM );
+  ASSERT( inverse, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( inverse->data, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( inverse->dimLength, stat, MATRIXUTILSH_ENUL,
+	  MATRIXUTILSH_MSGENUL );
+  ASSERT( inverse->dimLength->data, stat, MATRIXUTILSH_ENUL,
+	  MATRIXUTILSH_MSGENUL );
+  ASSERT( inverse->dimLength->length == 2, stat, MATRIXUTILSH_EDIM,
+	  MATRIXUTILSH_MSGEDIM );
+  n = (int)( inverse->dimLength->data[0] );
+  ASSERT( n, stat, MATRIXUTILSH_EDIM, MATRIXUTILSH_MSGEDIM );
+  ASSERT( n == (int)( inverse->dimLength->data[1] ), stat,
+	  MATRIXUTILSH_EDIM, MATRIXUTILSH_MSGEDIM );
+  ASSERT( n == (int)( matrix->dimLength->data[0] ), stat,
+	  MATRIXUTILSH_EDIM, MATRIXUTILSH_MSGEDIM );
+  ASSERT( n == (int)( matrix->dimLength->data[1] ), stat,
+	  MATRIXUTILSH_EDIM, MATRIXUTILSH_MSGEDIM );
+
+  /* Allocate permutation and workspace, and invert. */
+  lwork = XLALMatrixInverseWorkLAPACK( n );
+  ipiv = LALMalloc( n*sizeof(int) );
+  work = LALMalloc( lwork*sizeof(REAL4) );
+  if ( !ipiv || !work ) {
+    if ( ipiv )
+      LALFree( ipiv );
+    if ( work )
+      LALFree( work );
+    ABORT( stat, MATRIXUTILSH_EMEM, MATRIXUTILSH_MSGEMEM );
+  }
+  info = XLALSMatrixInverseLAPACK( det, matrix->data, inverse->data, n,
+				   ipiv, work, lwork );
+  LALFree( ipiv );
+  LALFree( work );
+  if ( info ) {
+    ABORT( stat, MATRIXUTILSH_ESING, MATRIXUTILSH_MSGESING );
+  }
+  RETURN( stat );
+}
+#else
 {
   INT2 sgn;                 /* sign of permutation. */
   UINT4 n, i, j, ij;        /* array dimension and indecies */
@@ -684,11 +804,44 @@ LALSMatrixInverse( LALStatus *stat, REAL4 *det, REAL4Array *matrix, REAL4Array *
   DETATCHSTATUSPTR( stat );
   RETURN( stat );
 }
+#endif /* HAVE_LAPACK */
 
 
 /** \see See \ref DetInverse_c for documentation */
 void
 LALDMatrixDeterminant( LALStatus *stat, REAL8 *det, REAL8Array *matrix )
+#ifdef HAVE_LAPACK
+{
+  int n;                    /* matrix dimension */
+  int *ipiv;                /* permutation storage vector */
+
+  INITSTATUS(stat);
+
+  /* Check input fields. */
+  ASSERT( det, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix->data, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix->dimLength, stat, MATRIXUTILSH_ENUL,
+	  MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix->dimLength->data, stat, MATRIXUTILSH_ENUL,
+	  MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix->dimLength->length == 2, stat, MATRIXUTILSH_EDIM,
+	  MATRIXUTILSH_MSGEDIM );
+  n = (int)( matrix->dimLength->data[0] );
+  ASSERT( n, stat, MATRIXUTILSH_EDIM, MATRIXUTILSH_MSGEDIM );
+  ASSERT( n == (int)( matrix->dimLength->data[1] ), stat,
+	  MATRIXUTILSH_EDIM, MATRIXUTILSH_MSGEDIM );
+
+  /* Allocate a vector to store the matrix permutation, and decompose
+     the matrix; a singular matrix has zero determinant. */
+  if ( !( ipiv = LALMalloc( n*sizeof(int) ) ) ) {
+    ABORT( stat, MATRIXUTILSH_EMEM, MATRIXUTILSH_MSGEMEM );
+  }
+  XLALDMatrixInverseLAPACK( det, matrix->data, NULL, n, ipiv, NULL, 0 );
+  LALFree( ipiv );
+  RETURN( stat );
+}
+#else
 {
   INT2 sgn;                 /* sign of permutation. */
   UINT4 n, i;               /* array dimension and index */
@@ -727,11 +880,68 @@ LALDMatrixDeterminant( LALStatus *stat, REAL8 *det, REAL8Array *matrix )
   DETATCHSTATUSPTR( stat );
   RETURN( stat );
 }
+#endif /* HAVE_LAPACK */
 
 
 /** \see See \ref DetInverse_c for documentation */
 void
 LALDMatrixInverse( LALStatus *stat, REAL8 *det, REAL8Array *matrix, REAL8Array *inverse )
+#ifdef HAVE_LAPACK
+{
+  int n, lwork, info;       /* matrix dimension, workspace length, and
+                               LAPACK return code */
+  int *ipiv;                /* permutation storage vector */
+  REAL8 *work;                /* LAPACK workspace */
+
+  INITSTATUS(stat);
+
+  /* Check input fields. */
+  ASSERT( matrix, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix->data, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix->dimLength, stat, MATRIXUTILSH_ENUL,
+	  MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix->dimLength->data, stat, MATRIXUTILSH_ENUL,
+	  MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix->dimLength->length == 2, stat, MATRIXUTILSH_EDIM,
+	  MATRIXUTILSH_MSGEDIM );
+  ASSERT( inverse, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( inverse->data, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( inverse->dimLength, stat, MATRIXUTILSH_ENUL,
+	  MATRIXUTILSH_MSGENUL );
+  ASSERT( inverse->dimLength->data, stat, MATRIXUTILSH_ENUL,
+	  MATRIXUTILSH_MSGENUL );
+  ASSERT( inverse->dimLength->length == 2, stat, MATRIXUTILSH_EDIM,
+	  MATRIXUTILSH_MSGEDIM );
+  n = (int)( inverse->dimLength->data[0] );
+  ASSERT( n, stat, MATRIXUTILSH_EDIM, MATRIXUTILSH_MSGEDIM );
+  ASSERT( n == (int)( inverse->dimLength->data[1] ), stat,
+	  MATRIXUTILSH_EDIM, MATRIXUTILSH_MSGEDIM );
+  ASSERT( n == (int)( matrix->dimLength->data[0] ), stat,
+	  MATRIXUTILSH_EDIM, MATRIXUTILSH_MSGEDIM );
+  ASSERT( n == (int)( matrix->dimLength->data[1] ), stat,
+	  MATRIXUTILSH_EDIM, MATRIXUTILSH_MSGEDIM );
+
+  /* Allocate permutation and workspace, and invert. */
+  lwork = XLALMatrixInverseWorkLAPACK( n );
+  ipiv = LALMalloc( n*sizeof(int) );
+  work = LALMalloc( lwork*sizeof(REAL8) );
+  if ( !ipiv || !work ) {
+    if ( ipiv )
+      LALFree( ipiv );
+    if ( work )
+      LALFree( work );
+    ABORT( stat, MATRIXUTILSH_EMEM, MATRIXUTILSH_MSGEMEM );
+  }
+  info = XLALDMatrixInverseLAPACK( det, matrix->data, inverse->data, n,
+				   ipiv, work, lwork );
+  LALFree( ipiv );
+  LALFree( work );
+  if ( info ) {
+    ABORT( stat, MATRIXUTILSH_ESING, MATRIXUTILSH_MSGESING );
+  }
+  RETURN( stat );
+}
+#else
 {
   INT2 sgn;                 /* sign of permutation. */
   UINT4 n, i, j, ij;        /* array dimension and indecies */
@@ -801,6 +1011,7 @@ LALDMatrixInverse( LALStatus *stat, REAL8 *det, REAL8Array *matrix, REAL8Array *
   DETATCHSTATUSPTR( stat );
   RETURN( stat );
 }
+#endif /* HAVE_LAPACK */
 
 
 /** \see See \ref DetInverse_c for documentation */
@@ -18,11 +18,13 @@
 */
 
 
+#include <config.h>
 #include <math.h>
 #include <lal/LALConstants.h>
 #include <lal/LALStdlib.h>
 #include <lal/AVFactories.h>
 #include <lal/MatrixUtils.h>
+#include "MatrixUtils_internal.h"
 
 #define EIGENINTERNALC_MAXITER 30 /* max. number of iterations in
 				     diagonalizing */
@@ -100,6 +102,8 @@ fabs( a )*sqrt( 1.0 + ((b)/(a))*((b)/(a)) ) :                        \
  *
  */
 
+#ifndef HAVE_LAPACK
+
 static void
 LALSSymmetricToTriDiagonal( LALStatus   *stat,
 			    REAL4Vector *diag,
@@ -628,6 +632,62 @@ LALDTriDiagonalToDiagonal( LALStatus   *stat,
 }
 
 
+#else /* HAVE_LAPACK */
+
+int
+XLALSymmetricEigenVectorsWorkLAPACK( int n )
+{
+  /* Optimal length for the blocked tri-diagonalization in ?syev(),
+     for the usual block size of 32. */
+  return n > 1 ? ( 32 + 2 )*n : 1;
+}
+
+
+/* Transpose a square matrix in place. */
+#define TRANSPOSE( T, m, n )                                         \
+do {                                                                 \
+  int i_, j_;                                                        \
+  for ( i_ = 1; i_ < (n); i_++ )                                     \
+    for ( j_ = 0; j_ < i_; j_++ ) {                                  \
+      T x_ = (m)[i_*(n) + j_];                                       \
+      (m)[i_*(n) + j_] = (m)[j_*(n) + i_];                           \
+      (m)[j_*(n) + i_] = x_;                                         \
+    }                                                                \
+} while ( 0 )
+
+
+int
+XLALSSymmetricEigenVectorsLAPACK( REAL4 *values, REAL4 *m, int n, REAL4 *work, int lwork )
+{
+  int info = 0;
+
+  /* The lower-left triangle of the row-major matrix is the upper-right
+     triangle of the column-major matrix seen by LAPACK. */
+  ssyev_( "V", "U", &n, m, &n, values, work, &lwork, &info );
+
+  /* The eigenvectors are returned as columns of the column-major
+     matrix, i.e. as rows of the row-major matrix. */
+  if ( info == 0 )
+    TRANSPOSE( REAL4, m, n );
+  return info;
+}
+
+
+int
+XLALDSymmetricEigenVectorsLAPACK( REAL8 *values, REAL8 *m, int n, REAL8 *work, int lwork )
+{
+  int info = 0;
+
+  /* See XLALSSymmetricEigenVectorsLAPACK(). */
+  dsyev_( "V", "U", &n, m, &n, values, work, &lwork, &info );
+  if ( info == 0 )
+    TRANSPOSE( REAL8, m, n );
+  return info;
+}
+
+#endif /* HAVE_LAPACK */
+
+
 /**
  * \defgroup Eigen_c Module Eigen.c
  * \ingroup MatrixUtils_h
@@ -726,6 +786,16 @@ LALDTriDiagonalToDiagonal( LALStatus   *stat,
  * then <tt>LALSTriDiagonalToDiagonal()</tt> and
  * <tt>LALDTriDiagonalToDiagonal()</tt> to diagonalize it.
  *
+ * If LAL was configured with the LAPACK library (see the
+ * <tt>--with-lapack</tt> option to \c configure), these routines instead
+ * call the LAPACK routines <tt>ssyev()</tt> and <tt>dsyev()</tt>, which
+ * follow the same approach but use blocked, BLAS-based tri-diagonalization.
+ * These also use only the lower-left triangle of <tt>*matrix</tt>, and
+ * return the eigenvalues in ascending order, whereas the routines above
+ * return them in the order left by the QL iteration.  Since some callers,
+ * such as the template-bank codes in LALInspiral, depend on the latter
+ * order, LAPACK is only used if explicitly requested.
+ *
  */
 
 /** @{ */
@@ -733,6 +803,45 @@ LALDTriDiagonalToDiagonal( LALStatus   *stat,
 /** \see See \ref Eigen_c for documentation */
 void
 LALSSymmetricEigenVectors( LALStatus *stat, REAL4Vector *values, REAL4Array *matrix )
+#ifdef HAVE_LAPACK
+{
+  int n, lwork, info;      /* matrix dimension, workspace length, and
+                              LAPACK return code */
+  REAL4 *work;               /* LAPACK workspace */
+
+  INITSTATUS(stat);
+
+  /* Check input fields. */
+  ASSERT( values, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( values->data, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( values->length, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix->data, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix->dimLength, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix->dimLength->data, stat, MATRIXUTILSH_ENUL,
+	  MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix->dimLength->length == 2, stat, MATRIXUTILSH_EDIM,
+	  MATRIXUTILSH_MSGEDIM );
+  n = (int)( values->length );
+  ASSERT( n == (int)( matrix->dimLength->data[0] ), stat,
+	  MATRIXUTILSH_EDIM, MATRIXUTILSH_MSGEDIM );
+  ASSERT( n == (int)( matrix->dimLength->data[1] ), stat,
+	  MATRIXUTILSH_EDIM, MATRIXUTILSH_MSGEDIM );
+
+  /* Allocate workspace and diagonalize. */
+  lwork = XLALSymmetricEigenVectorsWorkLAPACK( n );
+  if ( !( work = LALMalloc( lwork*sizeof(REAL4) ) ) ) {
+    ABORT( stat, MATRIXUTILSH_EMEM, MATRIXUTILSH_MSGEMEM );
+  }
+  info = XLALSSymmetricEigenVectorsLAPACK( values->data, matrix->data, n,
+					   work, lwork );
+  LALFree( work );
+  if ( info ) {
+    ABORT( stat, MATRIXUTILSH_EITER, MATRIXUTILSH_MSGEITER );
+  }
+  RETURN( stat );
+}
+#else
 {
   REAL4Vector *offDiag = NULL; /* off-diagonal line of
                                   tri-diagonalized matrix */
@@ -766,11 +875,51 @@ LALSSymmetricEigenVectors( LALStatus *stat, REAL4Vector *values, REAL4Array *mat
   DETATCHSTATUSPTR( stat );
   RETURN( stat );
 }
+#endif /* HAVE_LAPACK */
 
 
 /** \see See \ref Eigen_c for documentation */
 void
 LALDSymmetricEigenVectors( LALStatus *stat, REAL8Vector *values, REAL8Array *matrix )
+#ifdef HAVE_LAPACK
+{
+  int n, lwork, info;      /* matrix dimension, workspace length, and
+                              LAPACK return code */
+  REAL8 *work;               /* LAPACK workspace */
+
+  INITSTATUS(stat);
+
+  /* Check input fields. */
+  ASSERT( values, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( values->data, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( values->length, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix->data, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix->dimLength, stat, MATRIXUTILSH_ENUL, MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix->dimLength->data, stat, MATRIXUTILSH_ENUL,
+	  MATRIXUTILSH_MSGENUL );
+  ASSERT( matrix->dimLength->length == 2, stat, MATRIXUTILSH_EDIM,
+	  MATRIXUTILSH_MSGEDIM );
+  n = (int)( values->length );
+  ASSERT( n == (int)( matrix->dimLength->data[0] ), stat,
+	  MATRIXUTILSH_EDIM, MATRIXUTILSH_MSGEDIM );
+  ASSERT( n == (int)( matrix->dimLength->data[1] ), stat,
+	  MATRIXUTILSH_EDIM, MATRIXUTILSH_MSGEDIM );
+
+  /* Allocate workspace and diagonalize. */
+  lwork = XLALSymmetricEigenVectorsWorkLAPACK( n );
+  if ( !( work = LALMalloc( lwork*sizeof(REAL8) ) ) ) {
+    ABORT( stat, MATRIXUTILSH_EMEM, MATRIXUTILSH_MSGEMEM );
+  }
+  info = XLALDSymmetricEigenVectorsLAPACK( values->data, matrix->data, n,
+					   work, lwork );
+  LALFree( work );
+  if ( info ) {
+    ABORT( stat, MATRIXUTILSH_EITER, MATRIXUTILSH_MSGEITER );
+  }
+  RETURN( stat );
+}
+#else
 {
   REAL8Vector *offDiag = NULL; /* off-diagonal line of
                                   tri-diagonalized matrix */
@@ -804,5 +953,6 @@ LALDSymmetricEigenVectors( LALStatus *stat, REAL8Vector *values, REAL8Array *mat
   DETATCHSTATUSPTR( stat );
   RETURN( stat );
 }
+#endif /* HAVE_LAPACK */
 
 /** @} */
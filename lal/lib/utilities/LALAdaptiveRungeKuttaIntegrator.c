@@ -18,6 +18,7 @@
 */
 
 #include <lal/LALAdaptiveRungeKuttaIntegrator.h>
+#include <lal/LALConstants.h>
 
 #define XLAL_BEGINGSL \
         { \
@@ -64,6 +65,9 @@ LALAdaptiveRungeKuttaIntegrator *XLALAdaptiveRungeKutta4Init(int dim, int (*dydt
     integrator->retries = 6;
     integrator->stopontestonly = 0;
 
+    integrator->eps_abs = eps_abs;
+    integrator->eps_rel = eps_rel;
+
     return integrator;
 }
 
@@ -102,6 +106,9 @@ LALAdaptiveRungeKuttaIntegrator *XLALAdaptiveRungeKutta4InitEighthOrderInstead(i
     integrator->retries = 6;
     integrator->stopontestonly = 0;
 
+    integrator->eps_abs = eps_abs;
+    integrator->eps_rel = eps_rel;
+
     return integrator;
 }
 
@@ -1341,3 +1348,361 @@ int XLALAdaptiveRungeKutta4IrregularIntervals(LALAdaptiveRungeKuttaIntegrator *
     *yout = output;
     return outputlen;
 }
+
+/*
+ * Dormand-Prince 8(5,3) coefficients, as in E. Hairer's DOP853.  Stages 0 to
+ * 11 make the step, stage 12 is the derivative at the end of the step (first
+ * stage of the next one) and stages 13 to 15 are only needed for the dense
+ * output.
+ */
+#define DP853_STAGES 12
+#define DP853_STAGES_DENSE 16
+
+static const double dp853_c[DP853_STAGES_DENSE] = {
+    0.0,
+    0.526001519587677318785587544488e-01,
+    0.789002279381515978178381316732e-01,
+    0.118350341907227396726757197510,
+    0.281649658092772603273242802490,
+    0.333333333333333333333333333333,
+    0.25,
+    0.307692307692307692307692307692,
+    0.651282051282051282051282051282,
+    0.6,
+    0.857142857142857142857142857142,
+    1.0,
+    1.0,
+    0.1,
+    0.2,
+    0.777777777777777777777777777778
+};
+
+static const double dp853_a[DP853_STAGES_DENSE][DP853_STAGES_DENSE - 1] = {
+    {0.0},
+    {5.26001519587677318785587544488e-2},
+    {1.97250569845378994544595329183e-2, 5.91751709536136983633785987549e-2},
+    {2.95875854768068491816892993775e-2, 0.0, 8.87627564304205475450678981324e-2},
+    {2.41365134159266685502369798665e-1, 0.0, -8.84549479328286085344864962717e-1, 9.24834003261792003115737966543e-1},
+    {3.7037037037037037037037037037e-2, 0.0, 0.0, 1.70828608729473871279604482173e-1, 1.25467687566822425016691814123e-1},
+    {3.7109375e-2, 0.0, 0.0, 1.70252211019544039314978060272e-1, 6.02165389804559606850219397283e-2, -1.7578125e-2},
+    {3.70920001185047927108779319836e-2, 0.0, 0.0, 1.70383925712239993810214054705e-1, 1.07262030446373284651809199168e-1,
+     -1.53194377486244017527936158236e-2, 8.27378916381402288758473766002e-3},
+    {6.24110958716075717114429577812e-1, 0.0, 0.0, -3.36089262944694129406857109825, -8.68219346841726006818189891453e-1,
+     2.75920996994467083049415600797e1, 2.01540675504778934086186788979e1, -4.34898841810699588477366255144e1},
+    {4.77662536438264365890433908527e-1, 0.0, 0.0, -2.48811461997166764192642586468, -5.90290826836842996371446475743e-1,
+     2.12300514481811942347288949897e1, 1.52792336328824235832596922938e1, -3.32882109689848629194453265587e1, -2.03312017085086261358222928593e-2},
+    {-9.3714243008598732571704021658e-1, 0.0, 0.0, 5.18637242884406370830023853209, 1.09143734899672957818500254654,
+     -8.14978701074692612513997267357, -1.85200656599969598641566180701e1, 2.27394870993505042818970056734e1, 2.49360555267965238987089396762,
+     -3.0467644718982195003823669022},
+    {2.27331014751653820792359768449, 0.0, 0.0, -1.05344954667372501984066689879e1, -2.00087205822486249909675718444,
+     -1.79589318631187989172765950534e1, 2.79488845294199600508499808837e1, -2.85899827713502369474065508674, -8.87285693353062954433549289258,
+     1.23605671757943030647266201528e1, 6.43392746015763530355970484046e-1},
+    {5.42937341165687622380535766363e-2, 0.0, 0.0, 0.0, 0.0, 4.45031289275240888144113950566, 1.89151789931450038304281599044,
+     -5.8012039600105847814672114227, 3.1116436695781989440891606237e-1, -1.52160949662516078556178806805e-1, 2.01365400804030348374776537501e-1,
+     4.47106157277725905176885569043e-2},
+    {5.61675022830479523392909219681e-2, 0.0, 0.0, 0.0, 0.0, 0.0, 2.53500210216624811088794765333e-1, -2.46239037470802489917441475441e-1,
+     -1.24191423263816360469010140626e-1, 1.5329179827876569731206322685e-1, 8.20105229563468988491666602057e-3, 7.56789766054569976138603589584e-3,
+     -8.298e-3},
+    {3.18346481635021405060768473261e-2, 0.0, 0.0, 0.0, 0.0, 2.83009096723667755288322961402e-2, 5.35419883074385676223797384372e-2,
+     -5.49237485713909884646569340306e-2, 0.0, 0.0, -1.08347328697249322858509316994e-4, 3.82571090835658412954920192323e-4,
+     -3.40465008687404560802977114492e-4, 1.41312443674632500278074618366e-1},
+    {-4.28896301583791923408573538692e-1, 0.0, 0.0, 0.0, 0.0, -4.69762141536116384314449447206, 7.68342119606259904184240953878,
+     4.06898981839711007970213554331, 3.56727187455281109270669543021e-1, 0.0, 0.0, 0.0, -1.39902416515901462129418009734e-3,
+     2.9475147891527723389556272149, -9.15095847217987001081870187138}
+};
+
+/* eighth-order weights are row 12 of dp853_a;  the third-order error estimate
+ * subtracts these from them at stages 0, 8 and 11 */
+static const double dp853_bhh[3] = {
+    0.244094488188976377952755905512, 0.733846688281611857341361741547, 0.220588235294117647058823529412e-1
+};
+
+/* fifth-order error estimate */
+static const double dp853_er[DP853_STAGES] = {
+    0.1312004499419488073250102996e-1, 0.0, 0.0, 0.0, 0.0, -0.1225156446376204440720569753e+1,
+    -0.4957589496572501915214079952, 0.1664377182454986536961530415e+1, -0.3503288487499736816886487290,
+    0.3341791187130174790297318841, 0.8192320648511571246570742613e-1, -0.2235530786388629525884427845e-1
+};
+
+/* dense output */
+static const double dp853_d[4][DP853_STAGES_DENSE] = {
+    {-0.84289382761090128651353491142e+1, 0.0, 0.0, 0.0, 0.0, 0.56671495351937776962531783590, -0.30689499459498916912797304727e+1,
+     0.23846676565120698287728149680e+1, 0.21170345824450282767155149946e+1, -0.87139158377797299206789907490, 0.22404374302607882758541771650e+1,
+     0.63157877876946881815570249290, -0.88990336451333310820698117400e-1, 0.18148505520854727256656404962e+2, -0.91946323924783554000451984436e+1,
+     -0.44360363875948939664310572000e+1},
+    {0.10427508642579134603413151009e+2, 0.0, 0.0, 0.0, 0.0, 0.24228349177525818288430175319e+3, 0.16520045171727028198505394887e+3,
+     -0.37454675472269020279518312152e+3, -0.22113666853125306036270938578e+2, 0.77334326684722638389603898808e+1, -0.30674084731089398182061213626e+2,
+     -0.93321305264302278729567221706e+1, 0.15697238121770843886131091075e+2, -0.31139403219565177677282850411e+2, -0.93529243588444783865713862664e+1,
+     0.35816841486394083752465898540e+2},
+    {0.19985053242002433820987653617e+2, 0.0, 0.0, 0.0, 0.0, -0.38703730874935176555105901742e+3, -0.18917813819516756882830838328e+3,
+     0.52780815920542364900561016686e+3, -0.11573902539959630126141871134e+2, 0.68812326946963000169666922661e+1, -0.10006050966910838403183860980e+1,
+     0.77771377980534432092869265740, -0.27782057523535084065932004339e+1, -0.60196695231264120758267380846e+2, 0.84320405506677161018159903784e+2,
+     0.11992291136182789328035130030e+2},
+    {-0.25693933462703749003312586129e+2, 0.0, 0.0, 0.0, 0.0, -0.15418974869023643374053993627e+3, -0.23152937917604549567536039109e+3,
+     0.35763911791061412378285349910e+3, 0.93405324183624310003907691704e+2, -0.37458323136451633156875139351e+2, 0.10409964950896230045147246184e+3,
+     0.29840293426660503123344363579e+2, -0.43533456590011143754432175058e+2, 0.96324553959188282948394950600e+2, -0.39177261675615439165231486172e+2,
+     -0.14972683625798562581422125276e+3}
+};
+
+/* step size control:  the inspiral solutions are smooth, so a PI controller
+ * with a small beta keeps the step sequence from oscillating between
+ * acceptance and rejection */
+#define DP853_SAFE 0.9
+#define DP853_FACMIN 0.333
+#define DP853_FACMAX 6.0
+#define DP853_BETA 0.04
+
+/* y + h * sum_j a[j] k[j], over the first n stages */
+static void dp853_combine(REAL8 * ytmp, const REAL8 * y, REAL8 h, const double *a, REAL8 ** k, int n, size_t dim)
+{
+    size_t i;
+    int j;
+    for (i = 0; i < dim; i++) {
+        REAL8 sum = 0.0;
+        for (j = 0; j < n; j++)
+            sum += a[j] * k[j][i];
+        ytmp[i] = y[i] + h * sum;
+    }
+}
+
+/* initial step size guess, as in DOP853 */
+static REAL8 dp853_initial_step(LALAdaptiveRungeKuttaIntegrator * integrator, void *params, REAL8 t, const REAL8 * y, const REAL8 * f0,
+    REAL8 * ytmp, REAL8 * f1, REAL8 hmax, size_t dim)
+{
+    REAL8 dnf = 0.0, dny = 0.0, der2 = 0.0, der12, h, h1;
+    size_t i;
+
+    for (i = 0; i < dim; i++) {
+        REAL8 sk = integrator->eps_abs + integrator->eps_rel * fabs(y[i]);
+        dnf += (f0[i] / sk) * (f0[i] / sk);
+        dny += (y[i] / sk) * (y[i] / sk);
+    }
+    h = (dnf <= 1e-10 || dny <= 1e-10) ? 1e-6 : 0.01 * sqrt(dny / dnf);
+    h = fmin(h, hmax);
+
+    /* explicit Euler step to estimate the second derivative */
+    for (i = 0; i < dim; i++)
+        ytmp[i] = y[i] + h * f0[i];
+    if (integrator->dydt(t + h, ytmp, f1, params) != GSL_SUCCESS)
+        return h;
+    for (i = 0; i < dim; i++) {
+        REAL8 sk = integrator->eps_abs + integrator->eps_rel * fabs(y[i]);
+        der2 += ((f1[i] - f0[i]) / sk) * ((f1[i] - f0[i]) / sk);
+    }
+    der2 = sqrt(der2) / h;
+
+    der12 = fmax(der2, sqrt(dnf));
+    h1 = der12 <= 1e-15 ? fmax(1e-6, h * 1e-3) : pow(0.01 / der12, 1.0 / 8.0);
+    return fmin(fmin(100.0 * h, h1), hmax);
+}
+
+int XLALAdaptiveRungeKuttaDormandPrince853(LALAdaptiveRungeKuttaIntegrator * integrator,
+    void *params, REAL8 * yinit, REAL8 tinit, REAL8 tend_in, REAL8 deltat, REAL8Array ** yout)
+{
+    int errnum = 0;
+    int status;
+    int rejected = 0;
+    size_t dim, retries, i;
+    int s, count = 0, outputlen = 0;
+    REAL8 t, h, hnew, tend = tend_in, errold = 1e-4;
+    REAL8Array *output = NULL;
+    REAL8 *temp = NULL, *k[DP853_STAGES_DENSE], *F[7], *y, *ynew, *ytmp, *ysample; /* aliases */
+
+    XLAL_CHECK(integrator && integrator->dydt, XLAL_EFAULT);
+    XLAL_CHECK(yinit && yout, XLAL_EFAULT);
+    XLAL_CHECK(deltat >= 0 && tend > tinit, XLAL_EINVAL);
+    XLAL_CHECK(integrator->eps_abs > 0 || integrator->eps_rel > 0, XLAL_EINVAL, "Integrator has no error tolerances");
+
+    dim = integrator->sys->dimension;
+
+    /* preallocate the output for the expected length and the work space for the stages */
+    outputlen = deltat > 0 ? (int)((tend - tinit) / deltat) + 2 : 1024;
+    output = XLALCreateREAL8ArrayL(2, dim + 1, outputlen);
+    temp = LALMalloc((DP853_STAGES_DENSE + 7 + 4) * dim * sizeof(REAL8));
+    if (!output || !temp) {
+        errnum = XLAL_ENOMEM;
+        goto bail_out;
+    }
+    for (s = 0; s < DP853_STAGES_DENSE; s++)
+        k[s] = temp + s * dim;
+    for (s = 0; s < 7; s++)
+        F[s] = temp + (DP853_STAGES_DENSE + s) * dim;
+    y = temp + (DP853_STAGES_DENSE + 7) * dim;
+    ynew = y + dim;
+    ytmp = y + 2 * dim;
+    ysample = y + 3 * dim;      /* aliases */
+
+    /* set up to get started */
+    integrator->sys->params = params;
+    integrator->returncode = 0;
+    retries = integrator->retries;
+
+    t = tinit;
+    memcpy(y, yinit, dim * sizeof(REAL8));
+
+    /* store the first data point */
+    if ((errnum = storeStateInOutput(&output, t, y, dim, &outputlen, ++count)) != GSL_SUCCESS)
+        goto bail_out;
+
+    /* compute derivatives at the initial time, bail out if impossible */
+    if ((status = integrator->dydt(t, y, k[0], params)) != GSL_SUCCESS) {
+        integrator->returncode = status;
+        errnum = XLAL_EFAILED;
+        goto bail_out;
+    }
+
+    h = dp853_initial_step(integrator, params, t, y, k[0], ytmp, k[1], tend - tinit, dim);
+
+    while (1) {
+
+        if (!integrator->stopontestonly && t >= tend) {
+            break;
+        }
+
+        if (integrator->stop) {
+            if ((status = integrator->stop(t, y, k[0], params)) != GSL_SUCCESS) {
+                integrator->returncode = status;
+                break;
+            }
+        }
+
+        /* ready to try stepping! */
+      try_step:
+
+        /* if we would be stepping beyond the final time, stop there instead... */
+        if (!integrator->stopontestonly && t + h > tend)
+            h = tend - t;
+
+        if (h <= 10.0 * LAL_REAL8_EPS * fabs(t)) {
+            XLAL_PRINT_ERROR("Step size %g underflow at t = %g", h, t);
+            errnum = XLAL_EFAILED;
+            goto bail_out;
+        }
+
+        /* stages 1 to 11, then the eighth-order solution and its derivative */
+        status = GSL_SUCCESS;
+        for (s = 1; s < DP853_STAGES && status == GSL_SUCCESS; s++) {
+            dp853_combine(ytmp, y, h, dp853_a[s], k, s, dim);
+            status = integrator->dydt(t + dp853_c[s] * h, ytmp, k[s], params);
+        }
+        if (status == GSL_SUCCESS) {
+            dp853_combine(ynew, y, h, dp853_a[DP853_STAGES], k, DP853_STAGES, dim);
+            status = integrator->dydt(t + h, ynew, k[DP853_STAGES], params);
+        }
+
+        /* did a derivative evaluation fail? */
+        if (status != GSL_SUCCESS) {
+            if (retries--) {
+                h = h / 10.0;   /* if we have singularity retries left, reduce the timestep and try again */
+                goto try_step;
+            } else {
+                integrator->returncode = status;
+                break;  /* otherwise exit the loop */
+            }
+        } else {
+            retries = integrator->retries;      /* we stepped successfully, reset the singularity retries */
+        }
+
+        /* error estimate, combining the fifth- and third-order estimates */
+        REAL8 err, err3 = 0.0, err5 = 0.0, deno, fac11, fac;
+        for (i = 0; i < dim; i++) {
+            REAL8 sk = integrator->eps_abs + integrator->eps_rel * fmax(fabs(y[i]), fabs(ynew[i]));
+            REAL8 e3 = -(dp853_bhh[0] * k[0][i] + dp853_bhh[1] * k[8][i] + dp853_bhh[2] * k[11][i]);
+            REAL8 e5 = 0.0;
+            for (s = 0; s < DP853_STAGES; s++) {
+                e3 += dp853_a[DP853_STAGES][s] * k[s][i];
+                e5 += dp853_er[s] * k[s][i];
+            }
+            err3 += (e3 / sk) * (e3 / sk);
+            err5 += (e5 / sk) * (e5 / sk);
+        }
+        deno = err5 + 0.01 * err3;
+        if (deno <= 0.0)
+            deno = 1.0;
+        err = h * err5 / sqrt(dim * deno);
+
+        /* new step size */
+        fac11 = pow(err, 1.0 / 8.0 - DP853_BETA * 0.2);
+        fac = fac11 / pow(errold, DP853_BETA) / DP853_SAFE;
+        fac = fmax(1.0 / DP853_FACMAX, fmin(1.0 / DP853_FACMIN, fac));
+        hnew = h / fac;
+
+        if (err > 1.0) {
+            /* reject the step and try again with a smaller one */
+            h = h / fmin(1.0 / DP853_FACMIN, fac11 / DP853_SAFE);
+            rejected = 1;
+            goto try_step;
+        }
+
+        /* the step is accepted */
+        errold = fmax(err, 1e-4);
+        if (rejected)
+            hnew = fmin(hnew, h);
+        rejected = 0;
+
+        if (deltat > 0) {
+            /* evenly sampled output from the dense output of this step */
+            REAL8 tout = tinit + count * deltat;
+            if (tout <= t + h) {
+                for (s = DP853_STAGES + 1; s < DP853_STAGES_DENSE; s++) {
+                    dp853_combine(ytmp, y, h, dp853_a[s], k, s, dim);
+                    if ((status = integrator->dydt(t + dp853_c[s] * h, ytmp, k[s], params)) != GSL_SUCCESS) {
+                        integrator->returncode = status;
+                        errnum = XLAL_EFAILED;
+                        goto bail_out;
+                    }
+                }
+                for (i = 0; i < dim; i++) {
+                    REAL8 ydiff = ynew[i] - y[i];
+                    REAL8 bspl = h * k[0][i] - ydiff;
+                    F[0][i] = ydiff;
+                    F[1][i] = bspl;
+                    F[2][i] = ydiff - h * k[DP853_STAGES][i] - bspl;
+                    for (int r = 0; r < 4; r++) {
+                        REAL8 sum = 0.0;
+                        for (s = 0; s < DP853_STAGES_DENSE; s++)
+                            sum += dp853_d[r][s] * k[s][i];
+                        F[3 + r][i] = h * sum;
+                    }
+                }
+            }
+            for (; tout <= t + h; tout = tinit + count * deltat) {
+                REAL8 theta = (tout - t) / h, theta1 = 1.0 - theta;
+                for (i = 0; i < dim; i++)
+                    ysample[i] = y[i] + theta * (F[0][i] + theta1 * (F[1][i] + theta * (F[2][i] + theta1 * (F[3][i] + theta * (F[4][i] + theta1 * (F[5][i] + theta * F[6][i]))))));
+                if ((errnum = storeStateInOutput(&output, tout, ysample, dim, &outputlen, ++count)) != GSL_SUCCESS)
+                    goto bail_out;
+            }
+        } else {
+            if ((errnum = storeStateInOutput(&output, t + h, ynew, dim, &outputlen, ++count)) != GSL_SUCCESS)
+                goto bail_out;
+        }
+
+        /* update the current time, state and derivatives */
+        t += h;
+        memcpy(y, ynew, dim * sizeof(REAL8));
+        memcpy(k[0], k[DP853_STAGES], dim * sizeof(REAL8));
+        h = hnew;
+    }
+
+    /* copy the final state into yinit */
+    memcpy(yinit, y, dim * sizeof(REAL8));
+
+    /* shrink the output to the number of samples */
+    errnum = shrinkOutput(&output, &outputlen, count, dim);
+
+    /* deallocate stuff and return */
+  bail_out:
+
+    if (temp)
+        LALFree(temp);
+
+    if (errnum) {
+        if (output)
+            XLALDestroyREAL8Array(output);
+        XLAL_ERROR(errnum);
+    }
+
+    *yout = output;
+    return outputlen;
+}
@@ -63,6 +63,9 @@ typedef struct tagLALAdaptiveRungeKuttaIntegrator
   int stopontestonly;	/* stop only on test, use tend to size buffers only */
 
   int returncode;
+
+  double eps_abs;	/* absolute error tolerance, used by XLALAdaptiveRungeKuttaDormandPrince853() */
+  double eps_rel;	/* relative error tolerance, used by XLALAdaptiveRungeKuttaDormandPrince853() */
 } LALAdaptiveRungeKuttaIntegrator;
 
 LALAdaptiveRungeKuttaIntegrator *XLALAdaptiveRungeKutta4Init( int dim,
@@ -143,6 +146,33 @@ int XLALAdaptiveRungeKutta4IrregularIntervals( LALAdaptiveRungeKuttaIntegrator *
                                     REAL8Array **yout                   /**< array holding the unevenly sampled output */
                                     );
 
+/**
+ * Eighth-order Dormand-Prince 8(5,3) ODE integrator with adaptive step size
+ * control and seventh-order dense output.  Intended for use in time domain
+ * waveform generation routines based on EOB models.
+ *
+ * The integrator structure can be created with either of the
+ * XLALAdaptiveRungeKutta4Init functions;  only its derivative and stopping
+ * functions, tolerances, retries and stopontestonly fields are used, the
+ * stepping is done natively rather than through GSL.  If deltat > 0 the
+ * output is evenly sampled at tinit + j deltat, evaluated from the dense
+ * output of each step;  if deltat = 0 the output holds every accepted step.
+ * The output array grows by doubling and is returned at its final length.
+ *
+ * The method is described in
+ *
+ * E. Hairer, S. P. Norsett and G. Wanner, Solving Ordinary Differential
+ * Equations I, 2nd edition, Springer, 1993, section II.10
+ */
+int XLALAdaptiveRungeKuttaDormandPrince853( LALAdaptiveRungeKuttaIntegrator *integrator,  /**< struct holding dydt, stopping test, tolerances, etc. */
+                                    void *params,                       /**< params struct used to compute dydt and stopping test */
+                                    REAL8 *yinit,                       /**< pass in initial values of all variables - overwritten to final values */
+                                    REAL8 tinit,                        /**< integration start time */
+                                    REAL8 tend_in,                      /**< maximum integration time */
+                                    REAL8 deltat,                       /**< step size for evenly sampled output, or 0 to output every step */
+                                    REAL8Array **yout                   /**< array holding the output */
+                                    );
+
 /** @} */
 
 #if 0
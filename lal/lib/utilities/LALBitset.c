@@ -17,13 +17,18 @@
  *  MA  02110-1301  USA
  */
 
+#include <stdlib.h>
 #include <limits.h>
 
+#include <lal/LALStdio.h>
 #include <lal/LALBitset.h>
 #include <lal/LALHashTbl.h>
 
 #define BITS_PER_ELEM (sizeof(UINT8) * CHAR_BIT)
 
+/* Mask of 'n' consecutive bits starting at bit 'b', where 0 < n and b + n <= BITS_PER_ELEM */
+#define BITS_MASK(b, n) ( ( ( (UINT8) (n) ) < BITS_PER_ELEM ) ? ( ( ( ( (UINT8) 1 ) << (n) ) - 1 ) << (b) ) : ~( (UINT8) 0 ) )
+
 struct tagLALBitset {
   LALHashTbl *ht;               /* Hash table which stores bits in UINT8s */
 };
@@ -45,7 +50,87 @@ static int cmp_elem( const void *x, const void *y )
 {
   const elem *ex = ( const elem * ) x;
   const elem *ey = ( const elem * ) y;
-  return ex->key - ey->key;
+  return ( ex->key > ey->key ) - ( ex->key < ey->key );
+}
+
+/* Number of set bits in a non-zero element */
+static inline int popcount_bits( UINT8 bits )
+{
+#if defined(__GNUC__)
+  return __builtin_popcountll( bits );
+#else
+  bits = bits - ( ( bits >> 1 ) & 0x5555555555555555ULL );
+  bits = ( bits & 0x3333333333333333ULL ) + ( ( bits >> 2 ) & 0x3333333333333333ULL );
+  bits = ( bits + ( bits >> 4 ) ) & 0x0F0F0F0F0F0F0F0FULL;
+  return ( int )( ( bits * 0x0101010101010101ULL ) >> 56 );
+#endif
+}
+
+/* Index of the lowest set bit in a non-zero element */
+static inline int lowest_bit( UINT8 bits )
+{
+#if defined(__GNUC__)
+  return __builtin_ctzll( bits );
+#else
+  int n = 0;
+  while ( !( bits & 1 ) ) {
+    bits >>= 1;
+    ++n;
+  }
+  return n;
+#endif
+}
+
+/* Find element with given key; if not found and 'create' is true, add a new empty element */
+static int find_elem( LALBitset *bs, const UINT8 key, const BOOLEAN create, elem **y )
+{
+  const elem x = { .key = key };
+  XLAL_CHECK( XLALHashTblFind( bs->ht, &x, ( const void ** ) y ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( *y == NULL && create ) {
+    *y = XLALCalloc( 1, sizeof( **y ) );
+    XLAL_CHECK( *y != NULL, XLAL_ENOMEM );
+    ( *y )->key = key;
+    XLAL_CHECK( XLALHashTblAdd( bs->ht, *y ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  return XLAL_SUCCESS;
+}
+
+/* Remove an element from the bitset, if none of its bits are set */
+static int prune_elem( LALBitset *bs, const elem *y )
+{
+  if ( y->bits == 0 ) {
+    XLAL_CHECK( XLALHashTblRemove( bs->ht, y ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  return XLAL_SUCCESS;
+}
+
+/* Collect the elements of a bitset into an array */
+static int collect_elem( void *param, void *x )
+{
+  elem ***py = ( elem *** ) param;
+  *( ( *py )++ ) = ( elem * ) x;
+  return XLAL_SUCCESS;
+}
+
+/* Sort elements of a bitset by key */
+static int sort_elem( const void *x, const void *y )
+{
+  return cmp_elem( *( const elem *const * ) x, *( const elem *const * ) y );
+}
+
+/* Return an array of the elements of a bitset, optionally sorted by key */
+static elem **bitset_elems( const LALBitset *bs, const BOOLEAN sorted, int *n )
+{
+  *n = XLALHashTblSize( bs->ht );
+  XLAL_CHECK_NULL( *n >= 0, XLAL_EFUNC );
+  elem **ys = XLALMalloc( ( *n + 1 ) * sizeof( *ys ) );
+  XLAL_CHECK_NULL( ys != NULL, XLAL_ENOMEM );
+  elem **py = ys;
+  XLAL_CHECK_NULL( XLALHashTblModify( bs->ht, collect_elem, &py ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( sorted ) {
+    qsort( ys, *n, sizeof( *ys ), sort_elem );
+  }
+  return ys;
 }
 
 LALBitset *XLALBitsetCreate(
@@ -104,26 +189,18 @@ int XLALBitsetSet(
   const UINT8 key = idx / BITS_PER_ELEM;
   const UINT8 bitidx = idx % BITS_PER_ELEM;
 
-  /* Extract element corresponding to key, or else create new element */
-  const elem x = { .key = key };
+  /* Find element corresponding to key, creating a new element if setting a bit */
   elem *y = NULL;
-  XLAL_CHECK( XLALHashTblExtract( bs->ht, &x, ( void ** ) &y ) == XLAL_SUCCESS, XLAL_EFUNC );
-  if ( y == NULL ) {
-    y = XLALCalloc( 1, sizeof( *y ) );
-    XLAL_CHECK( y != NULL, XLAL_ENOMEM );
-    y->key = key;
-  }
+  XLAL_CHECK( find_elem( bs, key, is_set, &y ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   /* Set/unset bit in element */
   if ( is_set ) {
     y->bits |=  ( ( (UINT8) 1 ) << bitidx );
-  } else {
+  } else if ( y != NULL ) {
     y->bits &= ~( ( (UINT8) 1 ) << bitidx );
+    XLAL_CHECK( prune_elem( bs, y ) == XLAL_SUCCESS, XLAL_EFUNC );
   }
 
-  /* Add element back into hash */
-  XLAL_CHECK( XLALHashTblAdd( bs->ht, y ) == XLAL_SUCCESS, XLAL_EFUNC );
-
   return XLAL_SUCCESS;
 
 }
@@ -159,3 +236,242 @@ int XLALBitsetGet(
   return XLAL_SUCCESS;
 
 }
+
+int XLALBitsetSetRange(
+  LALBitset *bs,
+  const UINT8 start,
+  const UINT8 count,
+  const BOOLEAN is_set
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK( bs != NULL, XLAL_EFAULT );
+  XLAL_CHECK( start + count >= start, XLAL_EDOM, "Range of bits [%" LAL_UINT8_FORMAT " + %" LAL_UINT8_FORMAT ") overflows", start, count );
+
+  /* Set/unset bits one element at a time */
+  const UINT8 end = start + count;
+  for ( UINT8 idx = start; idx < end; ) {
+    const UINT8 key = idx / BITS_PER_ELEM;
+    const UINT8 bitidx = idx % BITS_PER_ELEM;
+    const UINT8 n = ( end - idx < BITS_PER_ELEM - bitidx ) ? end - idx : BITS_PER_ELEM - bitidx;
+    const UINT8 mask = BITS_MASK( bitidx, n );
+    elem *y = NULL;
+    XLAL_CHECK( find_elem( bs, key, is_set, &y ) == XLAL_SUCCESS, XLAL_EFUNC );
+    if ( is_set ) {
+      y->bits |= mask;
+    } else if ( y != NULL ) {
+      y->bits &= ~mask;
+      XLAL_CHECK( prune_elem( bs, y ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+    idx += n;
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+int XLALBitsetOr(
+  LALBitset *bs,
+  const LALBitset *other
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK( bs != NULL, XLAL_EFAULT );
+  XLAL_CHECK( other != NULL, XLAL_EFAULT );
+  if ( bs == other ) {
+    return XLAL_SUCCESS;
+  }
+
+  /* Combine each element of 'other' with the matching element of 'bs' */
+  int n = 0;
+  elem **xs = bitset_elems( other, 0, &n );
+  XLAL_CHECK( xs != NULL, XLAL_EFUNC );
+  for ( int i = 0; i < n; ++i ) {
+    elem *y = NULL;
+    XLAL_CHECK( find_elem( bs, xs[i]->key, 1, &y ) == XLAL_SUCCESS, XLAL_EFUNC );
+    y->bits |= xs[i]->bits;
+  }
+  XLALFree( xs );
+
+  return XLAL_SUCCESS;
+
+}
+
+/* Combine the bits of each element of 'bs' with the matching element of 'other' */
+static int bitset_and( LALBitset *bs, const LALBitset *other, const BOOLEAN invert )
+{
+
+  /* Check input */
+  XLAL_CHECK( bs != NULL, XLAL_EFAULT );
+  XLAL_CHECK( other != NULL, XLAL_EFAULT );
+  if ( bs == other ) {
+    if ( invert ) {
+      XLAL_CHECK( XLALBitsetClear( bs ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+    return XLAL_SUCCESS;
+  }
+
+  /* Elements of 'bs' are collected first, since they may be removed */
+  int n = 0;
+  elem **ys = bitset_elems( bs, 0, &n );
+  XLAL_CHECK( ys != NULL, XLAL_EFUNC );
+  for ( int i = 0; i < n; ++i ) {
+    const elem x = { .key = ys[i]->key };
+    const elem *z = NULL;
+    XLAL_CHECK( XLALHashTblFind( other->ht, &x, ( const void ** ) &z ) == XLAL_SUCCESS, XLAL_EFUNC );
+    const UINT8 bits = ( z != NULL ) ? z->bits : 0;
+    ys[i]->bits &= invert ? ~bits : bits;
+    XLAL_CHECK( prune_elem( bs, ys[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  XLALFree( ys );
+
+  return XLAL_SUCCESS;
+
+}
+
+int XLALBitsetAnd(
+  LALBitset *bs,
+  const LALBitset *other
+  )
+{
+  XLAL_CHECK( bitset_and( bs, other, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+int XLALBitsetAndNot(
+  LALBitset *bs,
+  const LALBitset *other
+  )
+{
+  XLAL_CHECK( bitset_and( bs, other, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+static int count_elem( void *param, const void *x )
+{
+  UINT8 *count = ( UINT8 * ) param;
+  *count += popcount_bits( ( ( const elem * ) x )->bits );
+  return XLAL_SUCCESS;
+}
+
+int XLALBitsetCount(
+  const LALBitset *bs,
+  UINT8 *count
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK( bs != NULL, XLAL_EFAULT );
+  XLAL_CHECK( count != NULL, XLAL_EFAULT );
+
+  /* Sum number of set bits in each element */
+  *count = 0;
+  XLAL_CHECK( XLALHashTblVisit( bs->ht, count_elem, count ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+}
+
+typedef struct {
+  UINT8 start;
+  UINT8 idx;
+  BOOLEAN found;
+} next_set_param;
+
+static int next_set_elem( void *param, const void *x )
+{
+  next_set_param *p = ( next_set_param * ) param;
+  const elem *ex = ( const elem * ) x;
+  const UINT8 key = p->start / BITS_PER_ELEM;
+  if ( ex->key >= key ) {
+    UINT8 bits = ex->bits;
+    if ( ex->key == key ) {
+      bits &= ~( ( ( ( UINT8 ) 1 ) << ( p->start % BITS_PER_ELEM ) ) - 1 );
+    }
+    if ( bits != 0 ) {
+      const UINT8 idx = ex->key * BITS_PER_ELEM + lowest_bit( bits );
+      if ( !p->found || idx < p->idx ) {
+        p->idx = idx;
+        p->found = 1;
+      }
+    }
+  }
+  return XLAL_SUCCESS;
+}
+
+int XLALBitsetNextSet(
+  const LALBitset *bs,
+  const UINT8 start,
+  UINT8 *idx,
+  BOOLEAN *found
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK( bs != NULL, XLAL_EFAULT );
+  XLAL_CHECK( idx != NULL, XLAL_EFAULT );
+  XLAL_CHECK( found != NULL, XLAL_EFAULT );
+
+  /* Find lowest set bit at or after 'start' over all elements */
+  next_set_param p = { .start = start };
+  XLAL_CHECK( XLALHashTblVisit( bs->ht, next_set_elem, &p ) == XLAL_SUCCESS, XLAL_EFUNC );
+  *found = p.found;
+  if ( p.found ) {
+    *idx = p.idx;
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+int XLALBitsetVisitRuns(
+  const LALBitset *bs,
+  LALBitsetRunFcn visit,
+  void *visit_param
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK( bs != NULL, XLAL_EFAULT );
+  XLAL_CHECK( visit != NULL, XLAL_EFAULT );
+
+  /* Get elements in order of increasing key */
+  int n = 0;
+  elem **ys = bitset_elems( bs, 1, &n );
+  XLAL_CHECK( ys != NULL, XLAL_EFUNC );
+
+  /* Find runs of set bits within each element, joining runs which continue across elements */
+  int errnum = 0;
+  BOOLEAN in_run = 0;
+  UINT8 run_start = 0, run_end = 0;
+  for ( int i = 0; i < n && errnum == 0; ++i ) {
+    UINT8 bits = ys[i]->bits;
+    while ( bits != 0 && errnum == 0 ) {
+      const int b = lowest_bit( bits );
+      const UINT8 rest = ~( bits >> b );
+      const int len = ( rest != 0 ) ? lowest_bit( rest ) : ( int )( BITS_PER_ELEM - b );
+      const UINT8 start = ys[i]->key * BITS_PER_ELEM + b;
+      if ( in_run && run_end == start ) {
+        run_end += len;
+      } else {
+        if ( in_run && visit( visit_param, run_start, run_end - run_start ) != XLAL_SUCCESS ) {
+          errnum = XLAL_EFUNC;
+        }
+        in_run = 1;
+        run_start = start;
+        run_end = start + len;
+      }
+      bits = ( b + len < ( int ) BITS_PER_ELEM ) ? bits & ~BITS_MASK( b, len ) : 0;
+    }
+  }
+  if ( errnum == 0 && in_run && visit( visit_param, run_start, run_end - run_start ) != XLAL_SUCCESS ) {
+    errnum = XLAL_EFUNC;
+  }
+  XLALFree( ys );
+  XLAL_CHECK( errnum == 0, errnum );
+
+  return XLAL_SUCCESS;
+
+}
@@ -39,6 +39,13 @@ extern "C" {
  */
 typedef struct tagLALBitset LALBitset;
 
+/**
+ * Function to call when visiting a run of <tt>count</tt> consecutive set bits, starting at bit
+ * index <tt>start</tt>, with a parameter \c param. Return XLAL_SUCCESS if successful, or
+ * XLAL_FAILURE otherwise.
+ */
+typedef int ( *LALBitsetRunFcn )( void *param, const UINT8 start, const UINT8 count );
+
 /**
  * Create a bitset
  */
@@ -78,6 +85,67 @@ int XLALBitsetGet(
   BOOLEAN *is_set                 /**< [out] Whether bit is set */
   );
 
+/**
+ * Set/unset a range of <tt>count</tt> consecutive bits in the bitset, starting at bit index <tt>start</tt>
+ */
+int XLALBitsetSetRange(
+  LALBitset *bs,                  /**< [in] Pointer to bitset */
+  const UINT8 start,              /**< [in] Index of first bit in range */
+  const UINT8 count,              /**< [in] Number of bits in range */
+  const BOOLEAN is_set            /**< [in] Whether bits are set */
+  );
+
+/**
+ * Set each bit in the bitset which is set in another bitset: <tt>bs |= other</tt>
+ */
+int XLALBitsetOr(
+  LALBitset *bs,                  /**< [in/out] Pointer to bitset */
+  const LALBitset *other          /**< [in] Pointer to other bitset */
+  );
+
+/**
+ * Unset each bit in the bitset which is not set in another bitset: <tt>bs &= other</tt>
+ */
+int XLALBitsetAnd(
+  LALBitset *bs,                  /**< [in/out] Pointer to bitset */
+  const LALBitset *other          /**< [in] Pointer to other bitset */
+  );
+
+/**
+ * Unset each bit in the bitset which is set in another bitset: <tt>bs &= ~other</tt>
+ */
+int XLALBitsetAndNot(
+  LALBitset *bs,                  /**< [in/out] Pointer to bitset */
+  const LALBitset *other          /**< [in] Pointer to other bitset */
+  );
+
+/**
+ * Count the number of set bits in the bitset
+ */
+int XLALBitsetCount(
+  const LALBitset *bs,            /**< [in] Pointer to bitset */
+  UINT8 *count                    /**< [out] Number of set bits */
+  );
+
+/**
+ * Find the first set bit in the bitset with index equal to or greater than <tt>start</tt>
+ */
+int XLALBitsetNextSet(
+  const LALBitset *bs,            /**< [in] Pointer to bitset */
+  const UINT8 start,              /**< [in] Index of bit to start search from */
+  UINT8 *idx,                     /**< [out] Index of first set bit, if found */
+  BOOLEAN *found                  /**< [out] Whether a set bit was found */
+  );
+
+/**
+ * Visit each maximal run of consecutive set bits in the bitset, in order of increasing bit index
+ */
+int XLALBitsetVisitRuns(
+  const LALBitset *bs,            /**< [in] Pointer to bitset */
+  LALBitsetRunFcn visit,          /**< [in] Visitor function to call for each run of set bits */
+  void *visit_param               /**< [in] Parameter to pass to visitor function */
+  );
+
 /** @} */
 
 #ifdef __cplusplus
@@ -17,8 +17,13 @@
  *  MA  02110-1301  USA
  */
 
+#include <config.h>
 #include <lal/LALHashTbl.h>
 
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
+
 /* Special hash table element value to indicate elements that have been deleted */
 static const void *hash_del = 0;
 #define DEL   ((void*) &hash_del)
@@ -306,3 +311,316 @@ int XLALHashTblRemove(
   return XLAL_SUCCESS;
 
 }
+
+int XLALHashTblVisit(
+  const LALHashTbl *ht,
+  LALHashTblVisitFcn visit,
+  void *visit_param
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK( ht != NULL, XLAL_EFAULT );
+  XLAL_CHECK( visit != NULL, XLAL_EFAULT );
+
+  /* Visit all valid elements in hash table */
+  for ( int i = 0; i < ht->data_len; ++i ) {
+    const void *x = ht->data[i];
+    if ( x != NULL && x != DEL ) {
+      XLAL_CHECK( visit( visit_param, x ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+int XLALHashTblModify(
+  LALHashTbl *ht,
+  LALHashTblModifyFcn modify,
+  void *modify_param
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK( ht != NULL, XLAL_EFAULT );
+  XLAL_CHECK( modify != NULL, XLAL_EFAULT );
+
+  /* Modify all valid elements in hash table */
+  for ( int i = 0; i < ht->data_len; ++i ) {
+    void *x = ht->data[i];
+    if ( x != NULL && x != DEL ) {
+      XLAL_CHECK( modify( modify_param, x ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+/* Default number of shards of a sharded hash table */
+#define DEFAULT_NSHARDS   64
+
+/* One shard of a sharded hash table, padded to avoid false sharing of locks between shards */
+typedef union {
+  struct {
+    LALHashTbl *ht;             /* Hash table holding the elements of this shard */
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_t lock;       /* Lock guarding this shard */
+#endif
+  } s;
+  char pad[128];
+} hashtbl_shard;
+
+struct tagLALShardedHashTbl {
+  hashtbl_shard *shards;        /* Shards of the hash table */
+  int nshards;                  /* Number of shards */
+  LALHashTblDtorFcn dtor;       /* Function to free memory of elements of hash, if required */
+  LALHashTblHashParamFcn hash;  /* Parameterised hash function for hash table elements */
+  void *hash_param;             /* Parameter to pass to hash function */
+};
+
+#ifdef LAL_PTHREAD_LOCK
+#define SHARD_LOCK(sh)     pthread_mutex_lock(&(sh)->s.lock)
+#define SHARD_UNLOCK(sh)   pthread_mutex_unlock(&(sh)->s.lock)
+#else
+#define SHARD_LOCK(sh)     do { } while (0)
+#define SHARD_UNLOCK(sh)   do { } while (0)
+#endif
+
+/* Return the shard holding elements matching x. The hash value is mixed by Fibonacci hashing
+   before selecting the shard, since the shards' own hash tables use its low-order bits */
+static hashtbl_shard *shardedhashtbl_shard( const LALShardedHashTbl *ht, const void *x )
+{
+  const UINT8 h = ht->hash( ht->hash_param, x ) * 0x9E3779B97F4A7C15ULL;
+  return &ht->shards[( h >> 32 ) % ( UINT8 ) ht->nshards];
+}
+
+LALShardedHashTbl *XLALShardedHashTblCreate(
+  LALHashTblDtorFcn dtor,
+  LALHashTblHashFcn hash,
+  LALHashTblCmpFcn cmp,
+  int nshards
+  )
+{
+
+  /* Create a sharded hash table using hashtbl_no_param_hash/cmp as the hash/comparison functions */
+  LALShardedHashTbl *ht = XLALShardedHashTblCreate2( dtor, hashtbl_no_param_hash, hash, hashtbl_no_param_cmp, cmp, nshards );
+  XLAL_CHECK_NULL( ht != NULL, XLAL_EFUNC );
+
+  return ht;
+
+}
+
+LALShardedHashTbl *XLALShardedHashTblCreate2(
+  LALHashTblDtorFcn dtor,
+  LALHashTblHashParamFcn hash,
+  void *hash_param,
+  LALHashTblCmpParamFcn cmp,
+  void *cmp_param,
+  int nshards
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK_NULL( hash != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL( cmp != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL( nshards >= 0, XLAL_EINVAL );
+
+  /* Allocate memory for sharded hash table struct */
+  LALShardedHashTbl *ht = XLALCalloc( 1, sizeof( *ht ) );
+  XLAL_CHECK_NULL( ht != NULL, XLAL_ENOMEM );
+
+  /* Set sharded hash table struct parameters */
+  ht->nshards = ( nshards > 0 ) ? nshards : DEFAULT_NSHARDS;
+  ht->dtor = dtor;
+  ht->hash = hash;
+  ht->hash_param = hash_param;
+
+  /* Create shards */
+  ht->shards = XLALCalloc( ht->nshards, sizeof( ht->shards[0] ) );
+  XLAL_CHECK_NULL( ht->shards != NULL, XLAL_ENOMEM );
+  for ( int k = 0; k < ht->nshards; ++k ) {
+    ht->shards[k].s.ht = XLALHashTblCreate2( dtor, hash, hash_param, cmp, cmp_param );
+    if ( ht->shards[k].s.ht == NULL ) {
+      XLALShardedHashTblDestroy( ht );
+      XLAL_ERROR_NULL( XLAL_EFUNC );
+    }
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_init( &ht->shards[k].s.lock, NULL );
+#endif
+  }
+
+  return ht;
+
+}
+
+void XLALShardedHashTblDestroy(
+  LALShardedHashTbl *ht
+  )
+{
+  if ( ht != NULL ) {
+    if ( ht->shards != NULL ) {
+      for ( int k = 0; k < ht->nshards; ++k ) {
+        if ( ht->shards[k].s.ht != NULL ) {
+          XLALHashTblDestroy( ht->shards[k].s.ht );
+#ifdef LAL_PTHREAD_LOCK
+          pthread_mutex_destroy( &ht->shards[k].s.lock );
+#endif
+        }
+      }
+      XLALFree( ht->shards );
+    }
+    XLALFree( ht );
+  }
+}
+
+int XLALShardedHashTblClear(
+  LALShardedHashTbl *ht
+  )
+{
+  XLAL_CHECK( ht != NULL, XLAL_EFAULT );
+  for ( int k = 0; k < ht->nshards; ++k ) {
+    hashtbl_shard *sh = &ht->shards[k];
+    SHARD_LOCK( sh );
+    const int retn = XLALHashTblClear( sh->s.ht );
+    SHARD_UNLOCK( sh );
+    XLAL_CHECK( retn == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  return XLAL_SUCCESS;
+}
+
+int XLALShardedHashTblSize(
+  LALShardedHashTbl *ht
+  )
+{
+  XLAL_CHECK( ht != NULL, XLAL_EFAULT );
+  int n = 0;
+  for ( int k = 0; k < ht->nshards; ++k ) {
+    hashtbl_shard *sh = &ht->shards[k];
+    SHARD_LOCK( sh );
+    n += XLALHashTblSize( sh->s.ht );
+    SHARD_UNLOCK( sh );
+  }
+  return n;
+}
+
+int XLALShardedHashTblFind(
+  LALShardedHashTbl *ht,
+  const void *x,
+  const void **y
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK( ht != NULL, XLAL_EFAULT );
+  XLAL_CHECK( x != NULL, XLAL_EINVAL );
+  XLAL_CHECK( y != NULL, XLAL_EFAULT );
+
+  /* Find element matching 'x' in its shard */
+  hashtbl_shard *sh = shardedhashtbl_shard( ht, x );
+  SHARD_LOCK( sh );
+  const int retn = XLALHashTblFind( sh->s.ht, x, y );
+  SHARD_UNLOCK( sh );
+  XLAL_CHECK( retn == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+}
+
+int XLALShardedHashTblAdd(
+  LALShardedHashTbl *ht,
+  void *x
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK( ht != NULL, XLAL_EFAULT );
+  XLAL_CHECK( x != NULL, XLAL_EINVAL );
+
+  /* Add 'x' to its shard */
+  hashtbl_shard *sh = shardedhashtbl_shard( ht, x );
+  SHARD_LOCK( sh );
+  const int retn = XLALHashTblAdd( sh->s.ht, x );
+  SHARD_UNLOCK( sh );
+  XLAL_CHECK( retn == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+}
+
+int XLALShardedHashTblFindOrAdd(
+  LALShardedHashTbl *ht,
+  void *x,
+  const void **y
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK( ht != NULL, XLAL_EFAULT );
+  XLAL_CHECK( x != NULL, XLAL_EINVAL );
+  XLAL_CHECK( y != NULL, XLAL_EFAULT );
+
+  /* Find element matching 'x' in its shard, or else add 'x' */
+  hashtbl_shard *sh = shardedhashtbl_shard( ht, x );
+  SHARD_LOCK( sh );
+  int retn = XLALHashTblFind( sh->s.ht, x, y );
+  if ( retn == XLAL_SUCCESS && *y == NULL ) {
+    retn = XLALHashTblAdd( sh->s.ht, x );
+  }
+  SHARD_UNLOCK( sh );
+  XLAL_CHECK( retn == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+}
+
+int XLALShardedHashTblExtract(
+  LALShardedHashTbl *ht,
+  const void *x,
+  void **y
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK( ht != NULL, XLAL_EFAULT );
+  XLAL_CHECK( x != NULL, XLAL_EINVAL );
+  XLAL_CHECK( y != NULL, XLAL_EFAULT );
+
+  /* Extract element matching 'x' from its shard */
+  hashtbl_shard *sh = shardedhashtbl_shard( ht, x );
+  SHARD_LOCK( sh );
+  const int retn = XLALHashTblExtract( sh->s.ht, x, y );
+  SHARD_UNLOCK( sh );
+  XLAL_CHECK( retn == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+}
+
+int XLALShardedHashTblRemove(
+  LALShardedHashTbl *ht,
+  const void *x
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK( ht != NULL, XLAL_EFAULT );
+  XLAL_CHECK( x != NULL, XLAL_EINVAL );
+
+  /* Extract element matching 'x' from its shard */
+  void *y = NULL;
+  hashtbl_shard *sh = shardedhashtbl_shard( ht, x );
+  SHARD_LOCK( sh );
+  const int retn = XLALHashTblExtract( sh->s.ht, x, &y );
+  SHARD_UNLOCK( sh );
+  XLAL_CHECK( retn == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* Free memory associated with element, if required; this is done without holding the lock */
+  if ( ht->dtor != NULL && y != NULL ) {
+    ht->dtor( y );
+  }
+
+  return XLAL_SUCCESS;
+
+}
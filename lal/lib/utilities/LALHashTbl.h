@@ -65,6 +65,18 @@ typedef int ( *LALHashTblCmpFcn )( const void *x, const void *y );
  */
 typedef int ( *LALHashTblCmpParamFcn )( void *param, const void *x, const void *y );
 
+/**
+ * Function to call when visiting hash element <tt>x</tt>, with a parameter \c param.
+ * Return XLAL_SUCCESS if successful, or XLAL_FAILURE otherwise.
+ */
+typedef int ( *LALHashTblVisitFcn )( void *param, const void *x );
+
+/**
+ * Function to call when visiting (and possibly modify) hash element <tt>x</tt>, with a parameter \c param.
+ * Return XLAL_SUCCESS if successful, or XLAL_FAILURE otherwise.
+ */
+typedef int ( *LALHashTblModifyFcn )( void *param, void *x );
+
 /**
  * Create a hash table
  */
@@ -141,6 +153,136 @@ int XLALHashTblRemove(
   const void *x                 /**< [in] Hash element to match */
   );
 
+/**
+ * Visit each element in a hash table, in no particular order
+ */
+int XLALHashTblVisit(
+  const LALHashTbl *ht,         /**< [in] Pointer to hash table */
+  LALHashTblVisitFcn visit,     /**< [in] Visitor function to call for each hash element */
+  void *visit_param             /**< [in] Parameter to pass to visitor function */
+  );
+
+/**
+ * Visit (and possibly modify) each element in a hash table, in no particular order. The modifier
+ * function must not change the hash value of an element, nor add or remove elements from the table.
+ */
+int XLALHashTblModify(
+  LALHashTbl *ht,               /**< [in] Pointer to hash table */
+  LALHashTblModifyFcn modify,   /**< [in] Modifier function to call for each hash element */
+  void *modify_param            /**< [in] Parameter to pass to modifier function */
+  );
+
+/**
+ * \name Sharded hash tables
+ *
+ * A sharded hash table may be used concurrently by several threads. Elements are
+ * distributed over a number of independent hash tables, the shards, by their hash
+ * value; each shard is guarded by its own lock, so that threads accessing elements
+ * in different shards do not contend with each other. If LAL is not built with
+ * POSIX thread support, no locking is performed.
+ *
+ * An element returned by XLALShardedHashTblFind() or XLALShardedHashTblFindOrAdd()
+ * remains owned by the hash table; callers must ensure that it is not removed by
+ * another thread while still in use.
+ */
+/** @{ */
+
+/**
+ * Generic sharded hash table with elements of type <tt>void *</tt>, which may be used concurrently
+ */
+typedef struct tagLALShardedHashTbl LALShardedHashTbl;
+
+/**
+ * Create a sharded hash table
+ */
+LALShardedHashTbl *XLALShardedHashTblCreate(
+  LALHashTblDtorFcn dtor,       /**< [in] Function to free memory of elements of hash, if required */
+  LALHashTblHashFcn hash,       /**< [in] Hash function for hash table elements */
+  LALHashTblCmpFcn cmp,         /**< [in] Hash table element comparison function */
+  int nshards                   /**< [in] Number of shards; if zero, a default number is used */
+  );
+
+/**
+ * Create a sharded hash table with parameterised hash and comparison functions
+ */
+LALShardedHashTbl *XLALShardedHashTblCreate2(
+  LALHashTblDtorFcn dtor,       /**< [in] Function to free memory of elements of hash, if required */
+  LALHashTblHashParamFcn hash,  /**< [in] Parameterised hash function for hash table elements */
+  void *hash_param,             /**< [in] Parameter to pass to hash function */
+  LALHashTblCmpParamFcn cmp,    /**< [in] Parameterised hash table element comparison function */
+  void *cmp_param,              /**< [in] Parameter to pass to comparison function */
+  int nshards                   /**< [in] Number of shards; if zero, a default number is used */
+  );
+
+/**
+ * Destroy a sharded hash table and its elements; must not be called concurrently with any other function
+ */
+void XLALShardedHashTblDestroy(
+  LALShardedHashTbl *ht         /**< [in] Pointer to sharded hash table */
+  );
+
+/**
+ * Clear a sharded hash table
+ */
+int XLALShardedHashTblClear(
+  LALShardedHashTbl *ht         /**< [in] Pointer to sharded hash table */
+  );
+
+/**
+ * Return the size of a sharded hash table; if other threads are modifying the table, this is only approximate
+ */
+int XLALShardedHashTblSize(
+  LALShardedHashTbl *ht         /**< [in] Pointer to sharded hash table */
+  );
+
+/**
+ * Find the element matching <tt>x</tt> in a sharded hash table; if found, return in <tt>*y</tt>
+ */
+int XLALShardedHashTblFind(
+  LALShardedHashTbl *ht,        /**< [in] Pointer to sharded hash table */
+  const void *x,                /**< [in] Hash element to match */
+  const void **y                /**< [out] Pointer to matched hash element, or NULL if not found */
+  );
+
+/**
+ * Add an element to a sharded hash table
+ */
+int XLALShardedHashTblAdd(
+  LALShardedHashTbl *ht,        /**< [in] Pointer to sharded hash table */
+  void *x                       /**< [in] Hash element to add */
+  );
+
+/**
+ * Find the element matching <tt>x</tt> in a sharded hash table, and return it in <tt>*y</tt>;
+ * if not found, add <tt>x</tt> to the hash table and set <tt>*y</tt> to \c NULL. Since this is
+ * done under a single lock, only one of several threads adding equal elements will succeed.
+ */
+int XLALShardedHashTblFindOrAdd(
+  LALShardedHashTbl *ht,        /**< [in] Pointer to sharded hash table */
+  void *x,                      /**< [in] Hash element to match, or add if not found */
+  const void **y                /**< [out] Pointer to matched hash element, or NULL if <tt>x</tt> was added */
+  );
+
+/**
+ * Find the element matching <tt>x</tt> in a sharded hash table; if found, remove it and return in <tt>*y</tt>
+ */
+int XLALShardedHashTblExtract(
+  LALShardedHashTbl *ht,        /**< [in] Pointer to sharded hash table */
+  const void *x,                /**< [in] Hash element to match */
+  void **y                      /**< [out] Pointer to matched hash element, which has been removed from
+                                   the hash table, or NULL if not found */
+  );
+
+/**
+ * Find the element matching <tt>x</tt> in a sharded hash table; if found, remove and destroy it
+ */
+int XLALShardedHashTblRemove(
+  LALShardedHashTbl *ht,        /**< [in] Pointer to sharded hash table */
+  const void *x                 /**< [in] Hash element to match */
+  );
+
+/** @} */
+
 /** @} */
 
 #ifdef __cplusplus
@@ -17,6 +17,7 @@
  *  MA  02110-1301  USA
  */
 
+#include <string.h>
 #include <lal/LALHeap.h>
 
 #define LEFT(i)     (2*(i) + 1)         /* Left child of binary heap element 'i' */
@@ -302,6 +303,82 @@ int XLALHeapAdd(
 
 }
 
+int XLALHeapMerge(
+  LALHeap *h,
+  LALHeap *src
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK( h != NULL, XLAL_EFAULT );
+  XLAL_CHECK( src != NULL, XLAL_EFAULT );
+  XLAL_CHECK( h != src, XLAL_EINVAL );
+  XLAL_CHECK( h->dtor == src->dtor && h->cmp == src->cmp && h->cmp_param == src->cmp_param && h->min_or_max_heap == src->min_or_max_heap, XLAL_EINVAL, "Heaps to merge are not compatible" );
+
+  if ( h->max_size == 0 || h->n + src->n <= h->max_size ) {
+
+    /* All elements fit: append elements of 'src' to binary heap, then restore heap property */
+    if ( h->n + src->n > h->data_len ) {
+      h->data = XLALRealloc( h->data, ( h->n + src->n ) * sizeof( h->data[0] ) );
+      XLAL_CHECK( h->data != NULL, XLAL_ENOMEM );
+      h->data_len = h->n + src->n;
+    }
+    if ( src->n > 0 ) {
+      memcpy( &h->data[h->n], src->data, src->n * sizeof( h->data[0] ) );
+    }
+    if ( src->n < h->n ) {
+
+      /* Bubble up each new element */
+      for ( int i = 0; i < src->n; ++i ) {
+        ++h->n;
+        heap_bubble_up( h, h->n - 1 );
+      }
+
+    } else {
+
+      /* Rebuild the whole binary heap, which costs linear time */
+      h->n += src->n;
+      for ( int i = PARENT( h->n - 1 ); i >= 0; --i ) {
+        heap_trickle_down( h, i );
+      }
+
+    }
+    if ( XLALHeapIsFull( h ) ) {
+      h->add = heap_add_full;
+    }
+
+  } else {
+
+    /* Add elements of 'src' one by one; once 'h' is full, most are rejected by a single comparison with its root */
+    for ( int i = 0; i < src->n; ++i ) {
+      void *x = src->data[i];
+      int retn = ( h->add )( h, &x );
+      if ( x != NULL && h->dtor != NULL ) {
+        h->dtor( x );
+      }
+      if ( retn != XLAL_SUCCESS ) {
+        /* Elements of 'src' not yet added are destroyed */
+        if ( h->dtor != NULL ) {
+          for ( int j = i + 1; j < src->n; ++j ) {
+            h->dtor( src->data[j] );
+          }
+        }
+        src->n = 0;
+        src->add = heap_add_not_full;
+        XLAL_ERROR( XLAL_EFUNC );
+      }
+    }
+
+  }
+
+  /* Empty 'src' */
+  src->n = 0;
+  src->add = heap_add_not_full;
+
+  return XLAL_SUCCESS;
+
+}
+
 void *XLALHeapExtractRoot(
   LALHeap *h
   )
@@ -146,6 +146,17 @@ int XLALHeapAdd(
                                    is returned in <tt>*x</tt>; otherwise <tt>*x</tt> is set to \c NULL */
   );
 
+/**
+ * Move all elements of the heap <tt>src</tt> into the heap <tt>h</tt>, leaving <tt>src</tt> empty.
+ * If <tt>h</tt> is of fixed size, only its maximum number of elements are kept, and the rest are
+ * destroyed. Both heaps must have the same destructor, comparison function and ordering. This allows
+ * e.g. each of several threads to fill its own heap of the best results, merging them at the end.
+ */
+int XLALHeapMerge(
+  LALHeap *h,                   /**< [in] Pointer to heap to merge into */
+  LALHeap *src                  /**< [in] Pointer to heap to merge from; emptied on return */
+  );
+
 /**
  * Remove the root element of a heap
  */
@@ -115,6 +115,138 @@ static int rngmed_qsortindex4(const void *elem1, const void *elem2){
 }
 
 
+/*----------------------------------
+  Two-heap running median, used by the RunningMedian2 functions for
+  large block sizes and by the RunningQuantile functions: the smallest
+  'nlo' samples are kept in a max-heap 'lo', the remaining samples in a
+  min-heap 'hi', so that the 'nlo'-th smallest sample is the root of 'lo';
+  for the median, nlo = (blocksize+1)/2. Samples are stored in a ring buffer of
+  length blocksize, and each heap records the ring buffer slots of its
+  samples; 'pos' maps each slot back to its position in a heap. Replacing
+  the oldest sample with a new one therefore costs O(log(blocksize)),
+  compared to O(sqrt(blocksize)) for the checkpoint algorithm.
+  -----------------------------------*/
+
+/* block size above which the two-heap running median is used */
+#define RNGMED_HEAP_MIN_BLOCKSIZE 256
+
+struct rngmed_heap {
+  UINT4 bsize;   /* block size */
+  UINT4 nlo;     /* number of samples in 'lo' */
+  UINT4 nhi;     /* number of samples in 'hi' = bsize - nlo */
+  REAL8 *value;  /* ring buffer of samples */
+  UINT4 *lo;     /* max-heap of slots of the lower half of samples */
+  UINT4 *hi;     /* min-heap of slots of the upper half of samples */
+  UINT4 *pos;    /* position of each slot in 'lo' (< nlo), or in 'hi' (offset by nlo) */
+};
+
+/* move the slot at position 'k' of heap 'h' of length 'n' up or down until
+   the heap is valid; 'sign' is +1 for a max-heap and -1 for a min-heap, and
+   'offset' is added to positions stored in 'pos' */
+static void rngmed_heap_sift(struct rngmed_heap *rh, UINT4 *h, UINT4 n, UINT4 offset, REAL8 sign, UINT4 k){
+  const UINT4 slot = h[k];
+  const REAL8 v = sign * rh->value[slot];
+
+  /* sift up */
+  while (k > 0) {
+    UINT4 parent = (k - 1) / 2;
+    if (sign * rh->value[h[parent]] >= v)
+      break;
+    h[k] = h[parent];
+    rh->pos[h[k]] = k + offset;
+    k = parent;
+  }
+
+  /* sift down */
+  while (2*k + 1 < n) {
+    UINT4 child = 2*k + 1;
+    if (child + 1 < n && sign * rh->value[h[child + 1]] > sign * rh->value[h[child]])
+      child++;
+    if (v >= sign * rh->value[h[child]])
+      break;
+    h[k] = h[child];
+    rh->pos[h[k]] = k + offset;
+    k = child;
+  }
+
+  h[k] = slot;
+  rh->pos[slot] = k + offset;
+}
+
+/* Used in qsort for initialising the two-heap running median */
+static int rngmed_heap_sortindex(const void *elem1, const void *elem2){
+  const struct rngmed_val_index8 *A = elem1;
+  const struct rngmed_val_index8 *B = elem2;
+  return (A->data > B->data) - (A->data < B->data);
+}
+
+/* create heaps from the ring buffer of 'bsize' samples in rh->value, with
+   the 'nlo' smallest samples in 'lo'; requires 0 < nlo <= bsize */
+static int rngmed_heap_init(struct rngmed_heap *rh, UINT4 bsize, UINT4 nlo){
+  UINT4 i;
+  struct rngmed_val_index8 *sorted;
+
+  rh->bsize = bsize;
+  rh->nlo = nlo;
+  rh->nhi = bsize - nlo;
+  rh->lo = (UINT4*)LALMalloc(rh->nlo * sizeof(UINT4));
+  rh->hi = (UINT4*)LALMalloc((rh->nhi > 0 ? rh->nhi : 1) * sizeof(UINT4));
+  rh->pos = (UINT4*)LALMalloc(bsize * sizeof(UINT4));
+  sorted = (struct rngmed_val_index8*)LALMalloc(bsize * sizeof(struct rngmed_val_index8));
+  if (!rh->lo || !rh->hi || !rh->pos || !sorted) {
+    LALFree(sorted);
+    return -1;
+  }
+
+  /* sort slots by value; a sorted array is a valid min-heap,
+     and a reverse-sorted array is a valid max-heap */
+  for (i = 0; i < bsize; i++) {
+    sorted[i].data = rh->value[i];
+    sorted[i].index = i;
+  }
+  qsort(sorted, bsize, sizeof(struct rngmed_val_index8), rngmed_heap_sortindex);
+  for (i = 0; i < rh->nlo; i++) {
+    rh->lo[i] = sorted[rh->nlo - 1 - i].index;
+    rh->pos[rh->lo[i]] = i;
+  }
+  for (i = 0; i < rh->nhi; i++) {
+    rh->hi[i] = sorted[rh->nlo + i].index;
+    rh->pos[rh->hi[i]] = rh->nlo + i;
+  }
+
+  LALFree(sorted);
+  return 0;
+}
+
+/* replace the sample in ring buffer slot 'slot' with 'newvalue' */
+static void rngmed_heap_replace(struct rngmed_heap *rh, UINT4 slot, REAL8 newvalue){
+  UINT4 k = rh->pos[slot];
+  UINT4 lo0, hi0;
+
+  rh->value[slot] = newvalue;
+  if (k < rh->nlo)
+    rngmed_heap_sift(rh, rh->lo, rh->nlo, 0, 1.0, k);
+  else
+    rngmed_heap_sift(rh, rh->hi, rh->nhi, rh->nlo, -1.0, k - rh->nlo);
+
+  /* if the heaps now overlap, exchange their roots */
+  if (rh->nhi > 0 && rh->value[rh->lo[0]] > rh->value[rh->hi[0]]) {
+    lo0 = rh->lo[0];
+    hi0 = rh->hi[0];
+    rh->lo[0] = hi0;
+    rh->hi[0] = lo0;
+    rngmed_heap_sift(rh, rh->lo, rh->nlo, 0, 1.0, 0);
+    rngmed_heap_sift(rh, rh->hi, rh->nhi, rh->nlo, -1.0, 0);
+  }
+}
+
+static void rngmed_heap_free(struct rngmed_heap *rh){
+  LALFree(rh->value);
+  LALFree(rh->lo);
+  LALFree(rh->hi);
+  LALFree(rh->pos);
+}
+
 void LALDRunningMedian( LALStatus *status,
 			REAL8Sequence *medians,
 			const REAL8Sequence *input,
@@ -995,6 +1127,34 @@ void LALDRunningMedian2( LALStatus *status,
 
   ATTATCHSTATUSPTR( status );
 
+  /* for large block sizes, use the two-heap running median */
+  if (bsize > RNGMED_HEAP_MIN_BLOCKSIZE) {
+    struct rngmed_heap rh;
+    rh.value = (REAL8*)LALMalloc(bsize * sizeof(REAL8));
+    if (rh.value == NULL) {
+      ABORT(status,LALRUNNINGMEDIANH_EMALOC6,LALRUNNINGMEDIANH_MSGEMALOC6);
+    }
+    for(i=0;i<bsize;i++)
+      rh.value[i] = input->data[i];
+    if (rngmed_heap_init(&rh, bsize, (bsize + 1) / 2) != 0) {
+      rngmed_heap_free(&rh);
+      ABORT(status,LALRUNNINGMEDIANH_EMALOC6,LALRUNNINGMEDIANH_MSGEMALOC6);
+    }
+    for(nmedian=0; nmedian < medians->length; nmedian++) {
+      /* replace the oldest sample with the next value from input */
+      if (nmedian > 0)
+        rngmed_heap_replace(&rh, (nmedian - 1) % bsize, input->data[nmedian+bsize-1]);
+      if(isodd)
+        medians->data[nmedian] = rh.value[rh.lo[0]];
+      else
+        medians->data[nmedian] = ((REAL8)rh.value[rh.lo[0]]
+                                  + (REAL8)rh.value[rh.hi[0]]) / 2.0;
+    }
+    rngmed_heap_free(&rh);
+    DETATCHSTATUSPTR( status );
+    RETURN( status );
+  }
+
   /* create nodes array */
   nodes = (struct node*)LALCalloc(bsize, sizeof(struct node));
 
@@ -1279,6 +1439,34 @@ void LALSRunningMedian2( LALStatus *status,
 
   ATTATCHSTATUSPTR( status );
 
+  /* for large block sizes, use the two-heap running median */
+  if (bsize > RNGMED_HEAP_MIN_BLOCKSIZE) {
+    struct rngmed_heap rh;
+    rh.value = (REAL8*)LALMalloc(bsize * sizeof(REAL8));
+    if (rh.value == NULL) {
+      ABORT(status,LALRUNNINGMEDIANH_EMALOC6,LALRUNNINGMEDIANH_MSGEMALOC6);
+    }
+    for(i=0;i<bsize;i++)
+      rh.value[i] = input->data[i];
+    if (rngmed_heap_init(&rh, bsize, (bsize + 1) / 2) != 0) {
+      rngmed_heap_free(&rh);
+      ABORT(status,LALRUNNINGMEDIANH_EMALOC6,LALRUNNINGMEDIANH_MSGEMALOC6);
+    }
+    for(nmedian=0; nmedian < medians->length; nmedian++) {
+      /* replace the oldest sample with the next value from input */
+      if (nmedian > 0)
+        rngmed_heap_replace(&rh, (nmedian - 1) % bsize, input->data[nmedian+bsize-1]);
+      if(isodd)
+        medians->data[nmedian] = rh.value[rh.lo[0]];
+      else
+        medians->data[nmedian] = ((REAL4)rh.value[rh.lo[0]]
+                                  + (REAL4)rh.value[rh.hi[0]]) / 2.0;
+    }
+    rngmed_heap_free(&rh);
+    DETATCHSTATUSPTR( status );
+    RETURN( status );
+  }
+
   /* create nodes array */
   nodes = (struct node*)LALCalloc(bsize, sizeof(struct node));
 
@@ -1499,3 +1687,97 @@ void LALSRunningMedian2( LALStatus *status,
   DETATCHSTATUSPTR( status );
   RETURN( status );
 }
+
+
+int XLALDRunningQuantile( REAL8Sequence *quantiles,
+                          const REAL8Sequence *input,
+                          UINT4 blocksize,
+                          REAL8 quantile )
+{
+  struct rngmed_heap rh;
+  UINT4 rank, i, n;
+  REAL8 pos, frac;
+
+  XLAL_CHECK( quantiles != NULL, XLAL_EFAULT );
+  XLAL_CHECK( input != NULL, XLAL_EFAULT );
+  XLAL_CHECK( blocksize > 0 && blocksize <= input->length, XLAL_EINVAL, "Block size %u must be in range [1, %u]", blocksize, input->length );
+  XLAL_CHECK( quantiles->length == input->length - blocksize + 1, XLAL_EBADLEN );
+  XLAL_CHECK( 0 <= quantile && quantile <= 1, XLAL_EDOM, "Quantile %g must be in range [0, 1]", quantile );
+
+  /* interpolate linearly between the samples of rank 'rank' and 'rank+1' (counting from 0) */
+  pos = quantile * (blocksize - 1);
+  rank = (UINT4) floor(pos);
+  if (rank > blocksize - 1)
+    rank = blocksize - 1;
+  frac = pos - rank;
+
+  /* create heaps with the 'rank+1' smallest samples in 'lo' */
+  rh.value = (REAL8*)LALMalloc(blocksize * sizeof(REAL8));
+  XLAL_CHECK( rh.value != NULL, XLAL_ENOMEM );
+  for (i = 0; i < blocksize; i++)
+    rh.value[i] = input->data[i];
+  if (rngmed_heap_init(&rh, blocksize, rank + 1) != 0) {
+    rngmed_heap_free(&rh);
+    XLAL_ERROR( XLAL_ENOMEM );
+  }
+
+  for (n = 0; n < quantiles->length; n++) {
+    /* replace the oldest sample with the next value from input */
+    if (n > 0)
+      rngmed_heap_replace(&rh, (n - 1) % blocksize, input->data[n + blocksize - 1]);
+    if (frac > 0 && rh.nhi > 0)
+      quantiles->data[n] = rh.value[rh.lo[0]] + frac * (rh.value[rh.hi[0]] - rh.value[rh.lo[0]]);
+    else
+      quantiles->data[n] = rh.value[rh.lo[0]];
+  }
+
+  rngmed_heap_free(&rh);
+  return XLAL_SUCCESS;
+}
+
+
+int XLALSRunningQuantile( REAL4Sequence *quantiles,
+                          const REAL4Sequence *input,
+                          UINT4 blocksize,
+                          REAL8 quantile )
+{
+  struct rngmed_heap rh;
+  UINT4 rank, i, n;
+  REAL8 pos, frac;
+
+  XLAL_CHECK( quantiles != NULL, XLAL_EFAULT );
+  XLAL_CHECK( input != NULL, XLAL_EFAULT );
+  XLAL_CHECK( blocksize > 0 && blocksize <= input->length, XLAL_EINVAL, "Block size %u must be in range [1, %u]", blocksize, input->length );
+  XLAL_CHECK( quantiles->length == input->length - blocksize + 1, XLAL_EBADLEN );
+  XLAL_CHECK( 0 <= quantile && quantile <= 1, XLAL_EDOM, "Quantile %g must be in range [0, 1]", quantile );
+
+  /* interpolate linearly between the samples of rank 'rank' and 'rank+1' (counting from 0) */
+  pos = quantile * (blocksize - 1);
+  rank = (UINT4) floor(pos);
+  if (rank > blocksize - 1)
+    rank = blocksize - 1;
+  frac = pos - rank;
+
+  /* create heaps with the 'rank+1' smallest samples in 'lo' */
+  rh.value = (REAL8*)LALMalloc(blocksize * sizeof(REAL8));
+  XLAL_CHECK( rh.value != NULL, XLAL_ENOMEM );
+  for (i = 0; i < blocksize; i++)
+    rh.value[i] = input->data[i];
+  if (rngmed_heap_init(&rh, blocksize, rank + 1) != 0) {
+    rngmed_heap_free(&rh);
+    XLAL_ERROR( XLAL_ENOMEM );
+  }
+
+  for (n = 0; n < quantiles->length; n++) {
+    /* replace the oldest sample with the next value from input */
+    if (n > 0)
+      rngmed_heap_replace(&rh, (n - 1) % blocksize, input->data[n + blocksize - 1]);
+    if (frac > 0 && rh.nhi > 0)
+      quantiles->data[n] = rh.value[rh.lo[0]] + frac * (rh.value[rh.hi[0]] - rh.value[rh.lo[0]]);
+    else
+      quantiles->data[n] = rh.value[rh.lo[0]];
+  }
+
+  rngmed_heap_free(&rh);
+  return XLAL_SUCCESS;
+}
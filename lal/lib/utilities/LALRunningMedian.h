@@ -53,6 +53,10 @@ extern "C" {
  * different implentation of the same algorithm. It should behave exactly like
  * <tt>LALDRunningMedian()</tt>, but has proven to be a
  * little faster and more stable. Check if it works for you.
+ * For block sizes larger than 256, <tt>LALDRunningMedian2()</tt> and
+ * <tt>LALSRunningMedian2()</tt> instead keep the lower and upper halves of
+ * the block in a max-heap and a min-heap respectively, which reduces the cost
+ * of each step from \f$O(\sqrt{b})\f$ to \f$O(\log b)\f$ with identical results.
  *
  * ### Algorithm ###
  *
@@ -137,6 +141,27 @@ LALSRunningMedian2( LALStatus *status,
 		    const REAL4Sequence *input,
 		    LALRunningMedianPar param);
 
+/**
+ * Compute the running quantile \c quantile (in the range [0,1]) of blocks of
+ * \c blocksize elements of \c input, using the same two-heap algorithm as
+ * <tt>LALDRunningMedian2()</tt> for large block sizes. The quantile is linearly
+ * interpolated between the elements of rank \f$\lfloor q(b-1) \rfloor\f$ and
+ * \f$\lfloor q(b-1) \rfloor + 1\f$ in each block. The \c quantiles sequence
+ * must be of length (n-b+1).
+ */
+int
+XLALDRunningQuantile( REAL8Sequence *quantiles,
+		      const REAL8Sequence *input,
+		      UINT4 blocksize,
+		      REAL8 quantile );
+
+/** See XLALDRunningQuantile() for documentation */
+int
+XLALSRunningQuantile( REAL4Sequence *quantiles,
+		      const REAL4Sequence *input,
+		      UINT4 blocksize,
+		      REAL8 quantile );
+
 /** @} */
 
 #ifdef  __cplusplus
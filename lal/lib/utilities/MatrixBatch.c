@@ -0,0 +1,291 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <config.h>
+#include <string.h>
+#include <lal/LALStdlib.h>
+#include <lal/XLALError.h>
+#include <lal/MatrixUtils.h>
+#include "MatrixUtils_internal.h"
+
+/**
+ * \defgroup MatrixBatch_c Module MatrixBatch.c
+ * \ingroup MatrixUtils_h
+ *
+ * \brief Routines to operate on batches of small matrices.
+ *
+ * ### Description ###
+ *
+ * Many codes need to diagonalize, invert, or multiply a large number of
+ * small matrices, e.g. \f$3\times3\f$ to \f$20\times20\f$ parameter-space
+ * metrics or Fisher matrices.  The routines in this module operate on a
+ * batch of \c count such matrices, all of the same dimensions, stored
+ * contiguously as the 3-dimensional array with dimensions
+ * \f$[\mathrm{count},M,N]\f$; each \f$[M,N]\f$ sub-array is a matrix in
+ * the same row-major layout used by the other routines in \ref MatrixUtils_h.
+ *
+ * <tt>XLALDSymmetricEigenVectorsBatch()</tt> computes the eigenvalues and
+ * eigenvectors of each symmetric matrix in <tt>*matrices</tt>, as
+ * <tt>LALDSymmetricEigenVectors()</tt>; the eigenvalues of matrix \c i are
+ * returned in row \c i of the \f$[\mathrm{count},N]\f$ array <tt>*values</tt>,
+ * and the eigenvectors replace each matrix.
+ *
+ * <tt>XLALDMatrixInverseBatch()</tt> computes the inverse of each matrix in
+ * <tt>*matrices</tt>, as <tt>LALDMatrixInverse()</tt>, storing them in
+ * <tt>*inverses</tt>; if \c det is non-\c NULL, the determinants are
+ * returned in <tt>det-\>data</tt>.  The contents of <tt>*matrices</tt> are
+ * corrupted.
+ *
+ * <tt>XLALDMatrixMultiplyBatch()</tt> computes the product of each pair of
+ * matrices in <tt>*in1</tt> and <tt>*in2</tt>, as
+ * <tt>LALDMatrixMultiply()</tt>, storing them in <tt>*out</tt>.
+ *
+ * ### Algorithm ###
+ *
+ * If LAL was configured with the LAPACK library (see the
+ * <tt>--with-lapack</tt> option to \c configure), these routines call the
+ * same LAPACK/BLAS kernels as the single-matrix routines, allocating a
+ * single workspace for the whole batch.  Otherwise, they call the
+ * single-matrix routines on each matrix of the batch in turn.
+ *
+ * These routines return \c XLAL_EMAXITER if the diagonalization of a matrix
+ * did not converge, and \c XLAL_EDOM if a matrix is singular; the contents
+ * of the output arrays are then undefined.
+ */
+/** @{ */
+
+/* Check that a batch array has dimensions [count,m,n] */
+#define CHECK_BATCH( a, count, m, n )                                    \
+  XLAL_CHECK( (a) != NULL && (a)->data != NULL && (a)->dimLength != NULL \
+              && (a)->dimLength->data != NULL, XLAL_EFAULT );            \
+  XLAL_CHECK( (a)->dimLength->length == 3                                \
+              && (a)->dimLength->data[0] == (count)                      \
+              && (a)->dimLength->data[1] == (m)                          \
+              && (a)->dimLength->data[2] == (n), XLAL_EBADLEN,           \
+              "'" #a "' must have dimensions [%u,%u,%u]",                \
+              (count), (m), (n) )
+
+#ifndef HAVE_LAPACK
+/*
+ * Convert the status returned by a single-matrix routine into an XLAL error,
+ * using the code of the innermost failed routine, and free the status chain
+ */
+static int
+XLALMatrixUtilsStatusError( LALStatus *status )
+{
+  const LALStatus *ptr = status;
+  while ( ptr->statusCode == -1 && ptr->statusPtr != NULL ) {
+    ptr = ptr->statusPtr;
+  }
+  const INT4 code = ptr->statusCode;
+  if ( status->statusPtr != NULL ) {
+    FREESTATUSPTR( status );
+  }
+  switch ( code ) {
+  case 0:
+    return 0;
+  case MATRIXUTILSH_EITER:
+    return XLAL_EMAXITER;
+  case MATRIXUTILSH_ESING:
+    return XLAL_EDOM;
+  case MATRIXUTILSH_EMEM:
+    return XLAL_ENOMEM;
+  default:
+    return XLAL_EFAILED;
+  }
+}
+#endif /* !HAVE_LAPACK */
+
+/** \see See \ref MatrixBatch_c for documentation */
+int
+XLALDSymmetricEigenVectorsBatch( REAL8Array *values, REAL8Array *matrices )
+{
+
+  /* Check input */
+  XLAL_CHECK( matrices != NULL && matrices->dimLength != NULL
+              && matrices->dimLength->data != NULL, XLAL_EFAULT );
+  XLAL_CHECK( matrices->dimLength->length == 3, XLAL_EBADLEN );
+  const UINT4 count = matrices->dimLength->data[0];
+  const UINT4 n = matrices->dimLength->data[1];
+  XLAL_CHECK( n > 0, XLAL_EBADLEN );
+  CHECK_BATCH( matrices, count, n, n );
+  XLAL_CHECK( values != NULL && values->data != NULL && values->dimLength != NULL
+              && values->dimLength->data != NULL, XLAL_EFAULT );
+  XLAL_CHECK( values->dimLength->length == 2 && values->dimLength->data[0] == count
+              && values->dimLength->data[1] == n, XLAL_EBADLEN,
+              "'values' must have dimensions [%u,%u]", count, n );
+
+#ifdef HAVE_LAPACK
+
+  /* Diagonalize each matrix, sharing the LAPACK workspace */
+  const int lwork = XLALSymmetricEigenVectorsWorkLAPACK( n );
+  REAL8 *work = XLALMalloc( lwork * sizeof( *work ) );
+  XLAL_CHECK( work != NULL, XLAL_ENOMEM );
+  for ( UINT4 i = 0; i < count; ++i ) {
+    const int info = XLALDSymmetricEigenVectorsLAPACK( values->data + i*n, matrices->data + i*n*n, n, work, lwork );
+    if ( info != 0 ) {
+      XLALFree( work );
+      XLAL_ERROR( info > 0 ? XLAL_EMAXITER : XLAL_EFAILED, "Diagonalization of matrix %u failed with LAPACK info=%i", i, info );
+    }
+  }
+  XLALFree( work );
+
+#else /* !HAVE_LAPACK */
+
+  /* Diagonalize each matrix, using views of the batch arrays */
+  UINT4 dims[2] = { n, n };
+  UINT4Vector dimLength = { 2, dims };
+  REAL8Array matrix = { &dimLength, NULL };
+  REAL8Vector value = { n, NULL };
+  for ( UINT4 i = 0; i < count; ++i ) {
+    LALStatus XLAL_INIT_DECL( status );
+    matrix.data = matrices->data + i*n*n;
+    value.data = values->data + i*n;
+    LALDSymmetricEigenVectors( &status, &value, &matrix );
+    if ( status.statusCode != 0 ) {
+      const INT4 code = status.statusCode;
+      XLAL_ERROR( XLALMatrixUtilsStatusError( &status ), "LALDSymmetricEigenVectors() failed for matrix %u with code=%d", i, code );
+    }
+  }
+
+#endif /* HAVE_LAPACK */
+
+  return XLAL_SUCCESS;
+
+}
+
+/** \see See \ref MatrixBatch_c for documentation */
+int
+XLALDMatrixInverseBatch( REAL8Vector *det, REAL8Array *inverses, REAL8Array *matrices )
+{
+
+  /* Check input */
+  XLAL_CHECK( matrices != NULL && matrices->dimLength != NULL
+              && matrices->dimLength->data != NULL, XLAL_EFAULT );
+  XLAL_CHECK( matrices->dimLength->length == 3, XLAL_EBADLEN );
+  const UINT4 count = matrices->dimLength->data[0];
+  const UINT4 n = matrices->dimLength->data[1];
+  XLAL_CHECK( n > 0, XLAL_EBADLEN );
+  CHECK_BATCH( matrices, count, n, n );
+  CHECK_BATCH( inverses, count, n, n );
+  if ( det != NULL ) {
+    XLAL_CHECK( det->data != NULL, XLAL_EFAULT );
+    XLAL_CHECK( det->length == count, XLAL_EBADLEN, "'det' must have length %u", count );
+  }
+
+#ifdef HAVE_LAPACK
+
+  /* Invert each matrix, sharing the permutation vector and LAPACK workspace */
+  const int lwork = XLALMatrixInverseWorkLAPACK( n );
+  int *ipiv = XLALMalloc( n * sizeof( *ipiv ) );
+  REAL8 *work = XLALMalloc( lwork * sizeof( *work ) );
+  if ( ipiv == NULL || work == NULL ) {
+    if ( ipiv != NULL ) {
+      XLALFree( ipiv );
+    }
+    if ( work != NULL ) {
+      XLALFree( work );
+    }
+    XLAL_ERROR( XLAL_ENOMEM );
+  }
+  for ( UINT4 i = 0; i < count; ++i ) {
+    const int info = XLALDMatrixInverseLAPACK( det != NULL ? det->data + i : NULL, matrices->data + i*n*n, inverses->data + i*n*n, n, ipiv, work, lwork );
+    if ( info != 0 ) {
+      XLALFree( ipiv );
+      XLALFree( work );
+      XLAL_ERROR( info > 0 ? XLAL_EDOM : XLAL_EFAILED, "Inversion of matrix %u failed with LAPACK info=%i", i, info );
+    }
+  }
+  XLALFree( ipiv );
+  XLALFree( work );
+
+#else /* !HAVE_LAPACK */
+
+  /* Invert each matrix, using views of the batch arrays */
+  UINT4 dims[2] = { n, n };
+  UINT4Vector dimLength = { 2, dims };
+  REAL8Array matrix = { &dimLength, NULL };
+  REAL8Array inverse = { &dimLength, NULL };
+  for ( UINT4 i = 0; i < count; ++i ) {
+    LALStatus XLAL_INIT_DECL( status );
+    matrix.data = matrices->data + i*n*n;
+    inverse.data = inverses->data + i*n*n;
+    LALDMatrixInverse( &status, det != NULL ? det->data + i : NULL, &matrix, &inverse );
+    if ( status.statusCode != 0 ) {
+      const INT4 code = status.statusCode;
+      XLAL_ERROR( XLALMatrixUtilsStatusError( &status ), "LALDMatrixInverse() failed for matrix %u with code=%d", i, code );
+    }
+  }
+
+#endif /* HAVE_LAPACK */
+
+  return XLAL_SUCCESS;
+
+}
+
+/** \see See \ref MatrixBatch_c for documentation */
+int
+XLALDMatrixMultiplyBatch( REAL8Array *out, const REAL8Array *in1, const REAL8Array *in2 )
+{
+
+  /* Check input */
+  XLAL_CHECK( out != NULL && out->dimLength != NULL && out->dimLength->data != NULL, XLAL_EFAULT );
+  XLAL_CHECK( in1 != NULL && in1->dimLength != NULL && in1->dimLength->data != NULL, XLAL_EFAULT );
+  XLAL_CHECK( out->dimLength->length == 3 && in1->dimLength->length == 3, XLAL_EBADLEN );
+  const UINT4 count = out->dimLength->data[0];
+  const UINT4 ni = out->dimLength->data[1];
+  const UINT4 nj = out->dimLength->data[2];
+  const UINT4 nk = in1->dimLength->data[2];
+  XLAL_CHECK( ni > 0 && nj > 0 && nk > 0, XLAL_EBADLEN );
+  CHECK_BATCH( out, count, ni, nj );
+  CHECK_BATCH( in1, count, ni, nk );
+  CHECK_BATCH( in2, count, nk, nj );
+
+#ifdef HAVE_LAPACK
+
+  /* Multiply each pair of matrices */
+  for ( UINT4 i = 0; i < count; ++i ) {
+    XLALDMatrixMultiplyLAPACK( out->data + i*ni*nj, in1->data + i*ni*nk, in2->data + i*nk*nj, ni, nj, nk );
+  }
+
+#else /* !HAVE_LAPACK */
+
+  /* Multiply each pair of matrices, using views of the batch arrays */
+  UINT4 outDims[2] = { ni, nj }, in1Dims[2] = { ni, nk }, in2Dims[2] = { nk, nj };
+  UINT4Vector outDimLength = { 2, outDims }, in1DimLength = { 2, in1Dims }, in2DimLength = { 2, in2Dims };
+  REAL8Array outMatrix = { &outDimLength, NULL };
+  REAL8Array in1Matrix = { &in1DimLength, NULL };
+  REAL8Array in2Matrix = { &in2DimLength, NULL };
+  for ( UINT4 i = 0; i < count; ++i ) {
+    LALStatus XLAL_INIT_DECL( status );
+    outMatrix.data = out->data + i*ni*nj;
+    in1Matrix.data = in1->data + i*ni*nk;
+    in2Matrix.data = in2->data + i*nk*nj;
+    LALDMatrixMultiply( &status, &outMatrix, &in1Matrix, &in2Matrix );
+    if ( status.statusCode != 0 ) {
+      const INT4 code = status.statusCode;
+      XLAL_ERROR( XLALMatrixUtilsStatusError( &status ), "LALDMatrixMultiply() failed for matrix %u with code=%d", i, code );
+    }
+  }
+
+#endif /* HAVE_LAPACK */
+
+  return XLAL_SUCCESS;
+
+}
+
+/** @} */
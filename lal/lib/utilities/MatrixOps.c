@@ -56,7 +56,9 @@
  * (single-column matrix) as the second operand.  To compute the vector
  * outer product, simply transpose the second argument rather than the
  * first.  These computations involve \f$N\f$ additions and multiplications
- * per element of the output matrix.
+ * per element of the output matrix.  If LAL was configured with the LAPACK
+ * library (see the <tt>--with-lapack</tt> option to \c configure),
+ * <tt>LALDMatrixMultiply()</tt> calls the blocked BLAS routine <tt>dgemm()</tt>.
  *
  * The transpose \f$(\mathsf{X}^T){}^a{}_b\f$ of a matrix
  * \f$\mathsf{X}^a{}_b\f$ is given by \f$(X^T){}^i{}_j=X^j{}_i\f$.
@@ -64,8 +66,22 @@
  * element of the output.
  */
 
+#include <config.h>
 #include <lal/LALStdlib.h>
 #include <lal/MatrixUtils.h>
+#include "MatrixUtils_internal.h"
+
+#ifdef HAVE_LAPACK
+void
+XLALDMatrixMultiplyLAPACK( REAL8 *out, const REAL8 *in1, const REAL8 *in2, int ni, int nj, int nk )
+{
+  const REAL8 one = 1.0, zero = 0.0;
+
+  /* BLAS sees the transposes of the row-major matrices, so compute
+     out^T = in2^T * in1^T. */
+  dgemm_( "N", "N", &nj, &ni, &nk, &one, in2, &nj, in1, &nk, &zero, out, &nj );
+}
+#endif /* HAVE_LAPACK */
 
 void
 LALDMatrixMultiply ( LALStatus *stat, REAL8Array *out, REAL8Array *in1, REAL8Array *in2 )
@@ -112,6 +128,12 @@ LALDMatrixMultiply ( LALStatus *stat, REAL8Array *out, REAL8Array *in1, REAL8Arr
   outData = out->data;
   in1Data = in1->data;
   in2Data = in2->data;
+#ifdef HAVE_LAPACK
+  if ( ni && nj && nk ) {
+    XLALDMatrixMultiplyLAPACK( outData, in1Data, in2Data, ni, nj, nk );
+    RETURN( stat );
+  }
+#endif
   for ( i = 0, in = 0, kn = 0; i < ni; i++, in += nj, kn += nk ) {
     for ( j = 0, ij = in; j < nj; j++, ij++ ) {
       outData[ij] = 0.0;
@@ -172,6 +172,19 @@ void
 LALDSymmetricEigenVectors( LALStatus *, REAL8Vector *values, REAL8Array *matrix );
 
 
+/** \addtogroup MatrixBatch_c */
+/** @{ */
+int
+XLALDSymmetricEigenVectorsBatch( REAL8Array *values, REAL8Array *matrices );
+
+int
+XLALDMatrixInverseBatch( REAL8Vector *det, REAL8Array *inverses, REAL8Array *matrices );
+
+int
+XLALDMatrixMultiplyBatch( REAL8Array *out, const REAL8Array *in1, const REAL8Array *in2 );
+/** @} */
+
+
 #ifdef  __cplusplus
 }
 #endif
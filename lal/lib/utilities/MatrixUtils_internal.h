@@ -0,0 +1,81 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#ifndef _MATRIXUTILS_INTERNAL_H
+#define _MATRIXUTILS_INTERNAL_H
+
+/*
+ * Internal header for the MatrixUtils modules: prototypes of the Fortran
+ * BLAS/LAPACK routines, and of the row-major kernels which wrap them.
+ */
+
+#include <lal/LALStdlib.h>
+
+#ifdef HAVE_LAPACK
+
+/* ---------- Fortran BLAS/LAPACK routines ---------- */
+
+void dgemm_( const char *transa, const char *transb, const int *m, const int *n, const int *k,
+             const double *alpha, const double *a, const int *lda, const double *b, const int *ldb,
+             const double *beta, double *c, const int *ldc );
+
+void ssyev_( const char *jobz, const char *uplo, const int *n, float *a, const int *lda,
+             float *w, float *work, const int *lwork, int *info );
+void dsyev_( const char *jobz, const char *uplo, const int *n, double *a, const int *lda,
+             double *w, double *work, const int *lwork, int *info );
+
+void sgetrf_( const int *m, const int *n, float *a, const int *lda, int *ipiv, int *info );
+void dgetrf_( const int *m, const int *n, double *a, const int *lda, int *ipiv, int *info );
+
+void sgetri_( const int *n, float *a, const int *lda, const int *ipiv,
+              float *work, const int *lwork, int *info );
+void dgetri_( const int *n, double *a, const int *lda, const int *ipiv,
+              double *work, const int *lwork, int *info );
+
+/* ---------- row-major kernels, defined in Eigen.c, DetInverse.c and MatrixOps.c ---------- */
+
+/*
+ * Workspace lengths, in elements, required by the kernels below for an n-by-n
+ * matrix; the workspace may be shared between successive calls.
+ */
+int XLALSymmetricEigenVectorsWorkLAPACK( int n );
+int XLALMatrixInverseWorkLAPACK( int n );
+
+/*
+ * Eigenvalues (in ascending order) and eigenvectors (as columns) of the
+ * symmetric row-major n-by-n matrix m, using the lower-left triangle only.
+ * Returns the LAPACK info code: zero on success, positive if not converged.
+ */
+int XLALSSymmetricEigenVectorsLAPACK( REAL4 *values, REAL4 *m, int n, REAL4 *work, int lwork );
+int XLALDSymmetricEigenVectorsLAPACK( REAL8 *values, REAL8 *m, int n, REAL8 *work, int lwork );
+
+/*
+ * Determinant (if det is non-NULL) and inverse (if inverse is non-NULL) of the
+ * row-major n-by-n matrix m; m is overwritten by its LU decomposition, and may
+ * equal inverse.  ipiv must have length n.  Returns the LAPACK info code: zero
+ * on success, positive if m is singular, in which case *det is zero and
+ * inverse is undefined.
+ */
+int XLALSMatrixInverseLAPACK( REAL4 *det, REAL4 *m, REAL4 *inverse, int n, int *ipiv, REAL4 *work, int lwork );
+int XLALDMatrixInverseLAPACK( REAL8 *det, REAL8 *m, REAL8 *inverse, int n, int *ipiv, REAL8 *work, int lwork );
+
+/* Product out = in1 * in2 of the row-major ni-by-nk and nk-by-nj matrices. */
+void XLALDMatrixMultiplyLAPACK( REAL8 *out, const REAL8 *in1, const REAL8 *in2, int ni, int nj, int nk );
+
+#endif /* HAVE_LAPACK */
+
+#endif /* _MATRIXUTILS_INTERNAL_H */
@@ -0,0 +1,87 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+/* ---------- see Sort.h for doxygen documentation ---------- */
+
+#include <string.h>
+#include <lal/LALStdlib.h>
+#include <lal/Sort.h>
+
+/* runs shorter than this are sorted by insertion before merging */
+#define MERGE_SORT_RUN 8
+
+
+int XLALMergeSort(void *base, size_t nobj, size_t size, void *params, int (*compar)(void *, const void *, const void *))
+{
+	char *a = base;
+	char *temp;
+	size_t run;
+	size_t i;
+
+	/* 0 or 1 objects are already sorted. */
+	if(nobj < 2)
+		return 0;
+
+	/* sort short runs in place */
+	for(i = 0; i < nobj; i += MERGE_SORT_RUN) {
+		size_t n = nobj - i < MERGE_SORT_RUN ? nobj - i : MERGE_SORT_RUN;
+		if(XLALInsertionSort(a + i * size, n, size, params, compar) < 0)
+			XLAL_ERROR(XLAL_EFUNC);
+	}
+	if(nobj <= MERGE_SORT_RUN)
+		return 0;
+
+	temp = XLALMalloc(nobj * size);
+	if(!temp)
+		XLAL_ERROR(XLAL_ENOMEM);
+
+	/* merge pairs of adjacent runs, doubling the run length each pass */
+	for(run = MERGE_SORT_RUN; run < nobj; run *= 2) {
+		for(i = 0; i + run < nobj; i += 2 * run) {
+			char *left = a + i * size;
+			char *mid = left + run * size;
+			char *right = mid;
+			char *end = a + (i + 2 * run < nobj ? i + 2 * run : nobj) * size;
+			char *out = temp;
+			size_t nleft;
+
+			/* nothing to do if the runs are already in order */
+			if(compar(params, mid - size, mid) <= 0)
+				continue;
+
+			/* copy out the left run and merge back into place;  taking
+			 * the left element on ties keeps the sort stable */
+			memcpy(temp, left, run * size);
+			nleft = run;
+			while(nleft && right < end) {
+				if(compar(params, out, right) <= 0) {
+					memcpy(left, out, size);
+					out += size;
+					--nleft;
+				} else {
+					memcpy(left, right, size);
+					right += size;
+				}
+				left += size;
+			}
+			memcpy(left, out, nleft * size);
+		}
+	}
+
+	XLALFree(temp);
+	return 0;
+}
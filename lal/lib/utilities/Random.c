@@ -20,6 +20,7 @@
 #include <time.h>
 #include <math.h>
 #include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
 #include <lal/Random.h>
 #include <lal/Sequence.h>
 #include <lal/XLALError.h>
@@ -43,6 +44,29 @@
  * The routine <tt>LALNormalDeviates()</tt> fills a vector with normal (Gaussian)
  * deviates with zero mean and unit variance, whereas the function\c XLALNormalDeviate just returns one normal distributed random number.
  *
+ * The routine <tt>XLALPhilox4x32()</tt> is the Philox4x32-10 counter-based
+ * generator of \cite Salmon2011 : it maps a 128 bit counter and a 64 bit key
+ * to 128 random bits, with no state carried from one call to the next.  The
+ * routine <tt>XLALPhiloxNormalDeviates()</tt> uses it to fill a vector with
+ * double precision normal deviates that depend only on a seed (the key) and a
+ * stream number (half of the counter).  Different streams are independent, so
+ * they can be generated in any order or concurrently, and reproduce the same
+ * numbers on any number of threads.
+ *
+ * A \c LALPhiloxStream, set up by <tt>XLALPhiloxStreamInit()</tt>, is a position
+ * within such a stream.  The <tt>i</tt>th 64 bit word of a stream is half of the
+ * output for the counter <tt>i / 2</tt>, so <tt>XLALPhiloxStreamSkip()</tt> moves
+ * a stream by any number of words in constant time, and copies of a stream
+ * skipped to different positions fill different parts of one sequence
+ * concurrently.  <tt>XLALPhiloxStreamSplit()</tt> derives an independent child
+ * stream from a parent, e.g. one for each thread or each injection.
+ * <tt>XLALPhiloxStreamUniformDeviates()</tt> fills a vector with uniform
+ * deviates in [0, 1), one word each, and <tt>XLALPhiloxStreamNormalDeviates()</tt>
+ * with normal deviates, where the pair of words of each counter gives a pair of
+ * normal deviates; both advance the stream by the length of the vector, and
+ * give the same numbers however the fill is divided into calls.  The counters
+ * are evaluated in batches, so that the compiler can vectorise the generator.
+ *
  * ### Operating Instructions ###
  *
  * \code
@@ -254,6 +278,201 @@ REAL4 XLALNormalDeviate( RandomParams *params )
   return deviate;
 }
 
+#define PHILOX_M4x32_0 0xD2511F53U
+#define PHILOX_M4x32_1 0xCD9E8D57U
+#define PHILOX_W32_0 0x9E3779B9U
+#define PHILOX_W32_1 0xBB67AE85U
+
+void XLALPhilox4x32( UINT4 ctr[4], const UINT4 key[2] )
+{
+  UINT4 k0 = key[0];
+  UINT4 k1 = key[1];
+  int round;
+
+  for ( round = 0; round < 10; ++round )
+  {
+    UINT8 p0 = (UINT8)PHILOX_M4x32_0 * ctr[0];
+    UINT8 p1 = (UINT8)PHILOX_M4x32_1 * ctr[2];
+    UINT4 c1 = ctr[1];
+    UINT4 c3 = ctr[3];
+    ctr[0] = (UINT4)(p1 >> 32) ^ c1 ^ k0;
+    ctr[1] = (UINT4)p1;
+    ctr[2] = (UINT4)(p0 >> 32) ^ c3 ^ k1;
+    ctr[3] = (UINT4)p0;
+    k0 += PHILOX_W32_0;
+    k1 += PHILOX_W32_1;
+  }
+}
+
+/* number of consecutive counters of a stream evaluated at once */
+#define PHILOX_BATCH 8
+
+/* evaluate Philox4x32-10 for the counters block, ..., block + PHILOX_BATCH - 1
+ * of a stream; the loops over the batch are independent, and may be vectorised */
+static void XLALPhiloxBatch( UINT4 x[4][PHILOX_BATCH], UINT8 seed, UINT8 stream, UINT8 block )
+{
+  UINT4 k0 = (UINT4)seed;
+  UINT4 k1 = (UINT4)(seed >> 32);
+  int b, round;
+
+  for ( b = 0; b < PHILOX_BATCH; ++b )
+  {
+    x[0][b] = (UINT4)stream;
+    x[1][b] = (UINT4)(stream >> 32);
+    x[2][b] = (UINT4)(block + b);
+    x[3][b] = (UINT4)((block + b) >> 32);
+  }
+
+  for ( round = 0; round < 10; ++round )
+  {
+    for ( b = 0; b < PHILOX_BATCH; ++b )
+    {
+      UINT8 p0 = (UINT8)PHILOX_M4x32_0 * x[0][b];
+      UINT8 p1 = (UINT8)PHILOX_M4x32_1 * x[2][b];
+      UINT4 c1 = x[1][b];
+      UINT4 c3 = x[3][b];
+      x[0][b] = (UINT4)(p1 >> 32) ^ c1 ^ k0;
+      x[1][b] = (UINT4)p1;
+      x[2][b] = (UINT4)(p0 >> 32) ^ c3 ^ k1;
+      x[3][b] = (UINT4)p0;
+    }
+    k0 += PHILOX_W32_0;
+    k1 += PHILOX_W32_1;
+  }
+}
+
+int XLALPhiloxNormalDeviates( REAL8Vector *deviates, UINT8 seed, UINT8 stream )
+{
+  LALPhiloxStream rng;
+
+  if ( ! deviates )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! deviates->data || ! deviates->length )
+    XLAL_ERROR( XLAL_EBADLEN );
+
+  XLALPhiloxStreamInit( &rng, seed, stream );
+  if ( XLALPhiloxStreamNormalDeviates( deviates, &rng ) != XLAL_SUCCESS )
+    XLAL_ERROR( XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+}
+
+int XLALPhiloxStreamInit( LALPhiloxStream *rng, UINT8 seed, UINT8 stream )
+{
+  if ( ! rng )
+    XLAL_ERROR( XLAL_EFAULT );
+  rng->seed = seed;
+  rng->stream = stream;
+  rng->position = 0;
+  return XLAL_SUCCESS;
+}
+
+int XLALPhiloxStreamSkip( LALPhiloxStream *rng, UINT8 n )
+{
+  if ( ! rng )
+    XLAL_ERROR( XLAL_EFAULT );
+  rng->position += n;
+  return XLAL_SUCCESS;
+}
+
+int XLALPhiloxStreamSplit( LALPhiloxStream *child, LALPhiloxStream *parent )
+{
+  UINT4 key[2];
+  UINT4 ctr[4];
+  UINT8 block;
+
+  if ( ! child || ! parent || child == parent )
+    XLAL_ERROR( XLAL_EFAULT );
+
+  /* the child stream number is the output for the next whole counter of the
+   * parent, whose words the parent then skips and so never hands out */
+  block = ( parent->position + 1 ) / 2;
+  key[0] = (UINT4)parent->seed;
+  key[1] = (UINT4)(parent->seed >> 32);
+  ctr[0] = (UINT4)parent->stream;
+  ctr[1] = (UINT4)(parent->stream >> 32);
+  ctr[2] = (UINT4)block;
+  ctr[3] = (UINT4)(block >> 32);
+  XLALPhilox4x32( ctr, key );
+  parent->position = 2 * ( block + 1 );
+
+  child->seed = parent->seed;
+  child->stream = ( (UINT8)ctr[0] << 32 ) | ctr[1];
+  child->position = 0;
+  return XLAL_SUCCESS;
+}
+
+int XLALPhiloxStreamUniformDeviates( REAL8Vector *deviates, LALPhiloxStream *rng )
+{
+  UINT4 x[4][PHILOX_BATCH];
+  UINT8 first, end, block;
+
+  if ( ! deviates || ! rng )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! deviates->data || ! deviates->length )
+    XLAL_ERROR( XLAL_EBADLEN );
+
+  /* word i of the stream is the upper (even i) or lower (odd i) half of the
+   * output for counter i / 2; its upper 53 bits give a deviate in [0, 1) */
+  first = rng->position;
+  end = first + deviates->length;
+  for ( block = first / 2; 2 * block < end; block += PHILOX_BATCH )
+  {
+    int b;
+    XLALPhiloxBatch( x, rng->seed, rng->stream, block );
+    for ( b = 0; b < PHILOX_BATCH; ++b )
+    {
+      const UINT8 i = 2 * ( block + b );
+      if ( i >= first && i < end )
+        deviates->data[i - first] = ( ( ( (UINT8)x[0][b] << 32 ) | x[1][b] ) >> 11 ) * 0x1p-53;
+      if ( i + 1 >= first && i + 1 < end )
+        deviates->data[i + 1 - first] = ( ( ( (UINT8)x[2][b] << 32 ) | x[3][b] ) >> 11 ) * 0x1p-53;
+    }
+  }
+  rng->position = end;
+
+  return XLAL_SUCCESS;
+}
+
+int XLALPhiloxStreamNormalDeviates( REAL8Vector *deviates, LALPhiloxStream *rng )
+{
+  UINT4 x[4][PHILOX_BATCH];
+  UINT8 first, end, block;
+
+  if ( ! deviates || ! rng )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! deviates->data || ! deviates->length )
+    XLAL_ERROR( XLAL_EBADLEN );
+
+  /* each counter value gives two 53 bit uniform deviates, which the
+   * Box-Muller transform turns into the normal deviates for words i and i + 1 */
+  first = rng->position;
+  end = first + deviates->length;
+  for ( block = first / 2; 2 * block < end; block += PHILOX_BATCH )
+  {
+    int b;
+    XLALPhiloxBatch( x, rng->seed, rng->stream, block );
+    for ( b = 0; b < PHILOX_BATCH; ++b )
+    {
+      const UINT8 i = 2 * ( block + b );
+      REAL8 u1, u2, rho;
+      if ( i >= end )
+        break;
+      /* u1 in (0, 1] so that its log is finite, u2 in [0, 1) */
+      u1 = ( ( ( ( (UINT8)x[0][b] << 32 ) | x[1][b] ) >> 11 ) + 1 ) * 0x1p-53;
+      u2 = ( ( ( (UINT8)x[2][b] << 32 ) | x[3][b] ) >> 11 ) * 0x1p-53;
+      rho = sqrt( -2.0 * log( u1 ) );
+      if ( i >= first )
+        deviates->data[i - first] = rho * cos( LAL_TWOPI * u2 );
+      if ( i + 1 >= first && i + 1 < end )
+        deviates->data[i + 1 - first] = rho * sin( LAL_TWOPI * u2 );
+    }
+  }
+  rng->position = end;
+
+  return XLAL_SUCCESS;
+}
+
 /*
  *
  * LAL Routines.
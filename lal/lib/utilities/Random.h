@@ -92,6 +92,21 @@ RandomParams;
 
 typedef struct tagMTRandomParams MTRandomParams;
 
+/**
+ * \ingroup Random_h
+ * \brief This structure describes a stream of random numbers from the Philox4x32-10
+ * generator; see XLALPhiloxStreamInit().
+ * \note The contents should not be manually adjusted.
+ */
+typedef struct
+tagLALPhiloxStream
+{
+  UINT8 seed;           /**< Key of the generator */
+  UINT8 stream;         /**< Stream number, i.e. upper half of the counter */
+  UINT8 position;       /**< Index of the next 64 bit word of the stream */
+}
+LALPhiloxStream;
+
 
 INT4 XLALBasicRandom( INT4 i );
 RandomParams * XLALCreateRandomParams( INT4 seed );
@@ -100,6 +115,15 @@ void XLALDestroyRandomParams( RandomParams *params );
 REAL4 XLALUniformDeviate( RandomParams *params );
 int XLALNormalDeviates( REAL4Vector *deviates, RandomParams *params );
 REAL4 XLALNormalDeviate( RandomParams *params );
+#ifndef SWIG   /* exclude from SWIG interface */
+void XLALPhilox4x32( UINT4 ctr[4], const UINT4 key[2] );
+#endif /* SWIG */
+int XLALPhiloxNormalDeviates( REAL8Vector *deviates, UINT8 seed, UINT8 stream );
+int XLALPhiloxStreamInit( LALPhiloxStream *rng, UINT8 seed, UINT8 stream );
+int XLALPhiloxStreamSkip( LALPhiloxStream *rng, UINT8 n );
+int XLALPhiloxStreamSplit( LALPhiloxStream *child, LALPhiloxStream *parent );
+int XLALPhiloxStreamUniformDeviates( REAL8Vector *deviates, LALPhiloxStream *rng );
+int XLALPhiloxStreamNormalDeviates( REAL8Vector *deviates, LALPhiloxStream *rng );
 
 void
 LALCreateRandomParams (
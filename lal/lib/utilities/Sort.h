@@ -106,6 +106,16 @@ extern "C" {
  * The C library's \c qsort() does not guarantee that order is preserved.
  * This function is not fast, it just is what it is.
  *
+ * ## Merge Sort ##
+ *
+ * \c XLALMergeSort() is also stable, with the same prototype as
+ * \c XLALInsertionSort(), but takes \f$O(n\log n)\f$ time rather than
+ * \f$O(n^2)\f$, so it should be used for arrays that can be large, such
+ * as the entry lists of big frame file caches.  Adjacent runs that are
+ * already in order are not merged, so sorting an array that is already
+ * sorted takes linear time.  It needs temporary storage for a copy of the
+ * array.
+ *
  * ### Algorithm ###
  *
  * ## Heap Sort ##
@@ -152,6 +162,12 @@ int XLALHeapRank( INT4 *rank, void *base, UINT4 nobj, UINT4 size, void *params,
 int XLALInsertionSort( void *base, size_t nobj, size_t size, void *params,
     int (*compar)(void *, const void *, const void *) );
 
+/* ----- MergeSort.c ----- */
+
+/** \see See \ref Sort_h for documentation */
+int XLALMergeSort( void *base, size_t nobj, size_t size, void *params,
+    int (*compar)(void *, const void *, const void *) );
+
 /** @} */
 
 #ifdef  __cplusplus
@@ -583,3 +583,175 @@ COMPLEX16 XLALWignerDMatrix(
 			XLALWignerdMatrix( l, mp, m, beta ) * 
 			cexp( -(1.0I)*m*gam );
 }
+
+
+/*
+ * Table of the coefficients of the explicit sum for the Wigner d matrix,
+ *
+ * d^l_{m'm}(beta) = \sum_s c_s cos(beta/2)^{2l+m-m'-2s} sin(beta/2)^{m'-m+2s},
+ *
+ * stored term by term for all (l, m', m) with l <= lmax, ordered as
+ * XLALWignerdTableIndex().
+ */
+struct tagLALWignerdTable {
+	int lmax;
+	UINT4 length;		/* number of (l, m', m) */
+	UINT4 *first;		/* first term of each (l, m', m); length + 1 entries */
+	REAL8 *coef;		/* coefficients c_s */
+	INT4 *cospow;		/* powers of cos(beta/2) */
+	INT4 *sinpow;		/* powers of sin(beta/2) */
+};
+
+/* number of angles evaluated together in XLALWignerdTableEvaluate() */
+#define WIGNERD_BLOCK 64
+
+/**
+ * Returns the position of the Wigner d matrix element
+ * \f$d^l_{m'm}\f$ in the output of XLALWignerdTableEvaluate().  The elements
+ * are ordered by l, then m', then m, so that the elements for
+ * \f$l \le l_{\mathrm{max}}\f$ occupy the first
+ * XLALWignerdTableIndex(lmax + 1, -(lmax + 1), -(lmax + 1)) positions.
+ */
+int XLALWignerdTableIndex(
+                                   int l,        /**< mode number l */
+                                   int mp,       /**< mode number m' */
+                                   int m         /**< mode number m */
+    )
+{
+	return l * (4 * l * l - 1) / 3 + (mp + l) * (2 * l + 1) + (m + l);
+}
+
+/**
+ * Creates a table for evaluating all the Wigner d matrix elements
+ * \f$d^l_{m'm}(\beta)\f$ with \f$l \le l_{\mathrm{max}}\f$ at once.
+ *
+ * The elements are evaluated from the explicit sum over powers of
+ * \f$\cos(\beta/2)\f$ and \f$\sin(\beta/2)\f$, whose coefficients are
+ * computed here once; evaluating the table at an angle then only needs the
+ * powers of the two half-angle functions, built up by repeated
+ * multiplication, and one dot product per element.  The elements agree with
+ * XLALWignerdMatrix().  A table may be shared between threads.
+ *
+ * See http://en.wikipedia.org/wiki/Wigner_D-matrix#Wigner_.28small.29_d-matrix
+ */
+LALWignerdTable *XLALCreateWignerdTable(
+                                   int lmax      /**< maximum mode number l */
+    )
+{
+	LALWignerdTable *table;
+	UINT4 nterms = 0;
+	UINT4 j, t;
+	int l, mp, m, k;
+
+	XLAL_CHECK_NULL(lmax >= 0, XLAL_EINVAL, "lmax = %d must be non-negative", lmax);
+
+	/* count the terms */
+	for(l = 0; l <= lmax; l++)
+		for(mp = -l; mp <= l; mp++)
+			for(m = -l; m <= l; m++)
+				nterms += MIN(l + m, l - mp) - (m > mp ? m - mp : 0) + 1;
+
+	table = XLALCalloc(1, sizeof(*table));
+	XLAL_CHECK_NULL(table, XLAL_ENOMEM);
+	table->lmax = lmax;
+	table->length = XLALWignerdTableIndex(lmax + 1, -(lmax + 1), -(lmax + 1));
+	table->first = XLALMalloc((table->length + 1) * sizeof(*table->first));
+	table->coef = XLALMalloc(nterms * sizeof(*table->coef));
+	table->cospow = XLALMalloc(nterms * sizeof(*table->cospow));
+	table->sinpow = XLALMalloc(nterms * sizeof(*table->sinpow));
+	if(!table->first || !table->coef || !table->cospow || !table->sinpow) {
+		XLALDestroyWignerdTable(table);
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	}
+
+	for(l = 0, j = 0, t = 0; l <= lmax; l++)
+		for(mp = -l; mp <= l; mp++)
+			for(m = -l; m <= l; m++, j++) {
+				const double lnorm = 0.5 * (lgamma(l + mp + 1) + lgamma(l - mp + 1) + lgamma(l + m + 1) + lgamma(l - m + 1));
+				table->first[j] = t;
+				for(k = m > mp ? m - mp : 0; k <= MIN(l + m, l - mp); k++, t++) {
+					const double sign = (mp - m + k) % 2 ? -1.0 : 1.0;
+					table->coef[t] = sign * exp(lnorm - lgamma(l + m - k + 1) - lgamma(k + 1) - lgamma(mp - m + k + 1) - lgamma(l - mp - k + 1));
+					table->cospow[t] = 2 * l + m - mp - 2 * k;
+					table->sinpow[t] = mp - m + 2 * k;
+				}
+			}
+	table->first[j] = t;
+
+	return table;
+}
+
+/**
+ * Destroys a table created by XLALCreateWignerdTable().
+ */
+void XLALDestroyWignerdTable(
+                                   LALWignerdTable *table /**< table to destroy */
+    )
+{
+	if(table) {
+		XLALFree(table->first);
+		XLALFree(table->coef);
+		XLALFree(table->cospow);
+		XLALFree(table->sinpow);
+		XLALFree(table);
+	}
+}
+
+/**
+ * Evaluates all the Wigner d matrix elements of a table at each of n angles.
+ * Element \f$d^l_{m'm}(\beta_i)\f$ is stored in
+ * d[XLALWignerdTableIndex(l, mp, m) * n + i], so d must have room for
+ * XLALWignerdTableIndex(lmax + 1, -(lmax + 1), -(lmax + 1)) * n values.
+ */
+int XLALWignerdTableEvaluate(
+                                   REAL8 *d,     /**< output elements */
+                                   const LALWignerdTable *table, /**< table from XLALCreateWignerdTable() */
+                                   const REAL8 *beta, /**< euler angles (rad) */
+                                   size_t n      /**< number of angles */
+    )
+{
+	const int npow = 2 * table->lmax + 1;
+	REAL8 *cospow, *sinpow;
+	size_t i0;
+	UINT4 j, t;
+	int p;
+
+	XLAL_CHECK(d && table && beta, XLAL_EFAULT);
+
+	/* powers of the half-angle functions for a block of angles,
+	 * indexed [power * WIGNERD_BLOCK + angle] */
+	cospow = XLALMalloc(2 * npow * WIGNERD_BLOCK * sizeof(*cospow));
+	XLAL_CHECK(cospow, XLAL_ENOMEM);
+	sinpow = cospow + npow * WIGNERD_BLOCK;
+
+	for(i0 = 0; i0 < n; i0 += WIGNERD_BLOCK) {
+		const size_t nb = n - i0 < WIGNERD_BLOCK ? n - i0 : WIGNERD_BLOCK;
+		size_t i;
+
+		for(i = 0; i < nb; i++) {
+			const double c = cos(beta[i0 + i] / 2.0);
+			const double s = sin(beta[i0 + i] / 2.0);
+			cospow[i] = sinpow[i] = 1.0;
+			for(p = 1; p < npow; p++) {
+				cospow[p * WIGNERD_BLOCK + i] = cospow[(p - 1) * WIGNERD_BLOCK + i] * c;
+				sinpow[p * WIGNERD_BLOCK + i] = sinpow[(p - 1) * WIGNERD_BLOCK + i] * s;
+			}
+		}
+
+		for(j = 0; j < table->length; j++) {
+			REAL8 *out = d + j * n + i0;
+			for(i = 0; i < nb; i++)
+				out[i] = 0.0;
+			for(t = table->first[j]; t < table->first[j + 1]; t++) {
+				const REAL8 c = table->coef[t];
+				const REAL8 *cp = cospow + table->cospow[t] * WIGNERD_BLOCK;
+				const REAL8 *sp = sinpow + table->sinpow[t] * WIGNERD_BLOCK;
+				for(i = 0; i < nb; i++)
+					out[i] += c * cp[i] * sp[i];
+			}
+		}
+	}
+
+	XLALFree(cospow);
+	return XLAL_SUCCESS;
+}
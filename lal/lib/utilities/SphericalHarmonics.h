@@ -50,6 +50,15 @@ INT4 XLALSphHarm ( COMPLEX16 *out, UINT4   L, INT4 M, REAL4 theta, REAL4   phi )
 double XLALJacobiPolynomial( int n, int alpha, int beta, double x );
 double XLALWignerdMatrix( int l, int mp, int m, double beta );
 COMPLEX16 XLALWignerDMatrix( int l, int mp, int m, double alpha, double beta, double gam );
+
+/** Table for evaluating Wigner d matrix elements of all (l, m', m) at once; see XLALCreateWignerdTable() */
+typedef struct tagLALWignerdTable LALWignerdTable;
+int XLALWignerdTableIndex( int l, int mp, int m );
+LALWignerdTable *XLALCreateWignerdTable( int lmax );
+void XLALDestroyWignerdTable( LALWignerdTable *table );
+#ifndef SWIG   /* exclude from SWIG interface */
+int XLALWignerdTableEvaluate( REAL8 *d, const LALWignerdTable *table, const REAL8 *beta, size_t n );
+#endif /* SWIG */
 /** @} */
 
 
@@ -153,6 +153,12 @@ EXPORT_VECTORMATH_SS2S(Sub, AVX2, AVX, SSE2, NONE)
 EXPORT_VECTORMATH_SS2S(Multiply, AVX2, AVX, SSE2, NONE)
 EXPORT_VECTORMATH_SS2S(Max, AVX2, AVX, SSE2, NONE)
 
+// ---------- define exported vector math functions with 3 REAL4 vector inputs to 2 REAL4 vector outputs (SSS2SS) ----------
+#define EXPORT_VECTORMATH_SSS2SS(NAME, ...)                                  \
+  EXPORT_VECTORMATH_ANY( NAME ## REAL4, (REAL4 *out1, REAL4 *out2, const REAL4 *in1, const REAL4 *in2, const REAL4 *in3, const UINT4 len), (out1, out2, in1, in2, in3, len), __VA_ARGS__ )
+
+EXPORT_VECTORMATH_SSS2SS(AddMax, AVX2, AVX, SSE2, NONE)
+
 // ---------- define exported vector math functions with 1 REAL4 scalar, 1 REAL4 vector inputs to 1 REAL4 vector output (sS2S) ----------
 #define EXPORT_VECTORMATH_sS2S(NAME, ...)                                    \
   EXPORT_VECTORMATH_ANY( NAME ## REAL4, (REAL4 *out, REAL4 scalar, const REAL4 *in, const UINT4 len), (out, scalar, in, len), __VA_ARGS__ )
@@ -202,9 +208,54 @@ EXPORT_VECTORMATH_CC2C(Add, AVX2, AVX, SSE2, NONE)
 EXPORT_VECTORMATH_cC2C(Scale, AVX2, AVX, SSE2, NONE)
 EXPORT_VECTORMATH_cC2C(Shift, AVX2, AVX, SSE2, NONE)
 
+// ---------- define exported vector math functions with 1 COMPLEX8 vector input to 1 REAL4 vector output (C2S) ----------
+#define EXPORT_VECTORMATH_C2S(NAME, ...)                                     \
+  EXPORT_VECTORMATH_ANY( NAME ## COMPLEX8, (REAL4 *out, const COMPLEX8 *in, const UINT4 len), (out, in, len), __VA_ARGS__ )
+
+EXPORT_VECTORMATH_C2S(Abs2, AVX2, AVX, SSE2, NONE)
+
 // ---------- define exported vector math functions with 1 REAL8 vector input to 1 REAL8 vector output (D2D) ----------
 #define EXPORT_VECTORMATH_D2D(NAME, ...)                                     \
   EXPORT_VECTORMATH_ANY( NAME ## REAL8, (REAL8 *out, const REAL8 *in, const UINT4 len), (out, in, len), __VA_ARGS__ )
 
+EXPORT_VECTORMATH_D2D(Sin, AVX512F, AVX2, SSE2, NONE)
+EXPORT_VECTORMATH_D2D(Cos, AVX512F, AVX2, SSE2, NONE)
+EXPORT_VECTORMATH_D2D(Exp, AVX512F, AVX2, SSE2, NONE)
+EXPORT_VECTORMATH_D2D(Log, AVX512F, AVX2, SSE2, NONE)
 EXPORT_VECTORMATH_D2D(Round, AVX2, AVX, NONE, NONE)
 
+// ---------- define exported vector math functions with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+#define EXPORT_VECTORMATH_D2DD(NAME, ...)                                    \
+  EXPORT_VECTORMATH_ANY( NAME ## REAL8, (REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len), (out1, out2, in, len), __VA_ARGS__ )
+
+EXPORT_VECTORMATH_D2DD(SinCos, AVX512F, AVX2, SSE2, NONE)
+EXPORT_VECTORMATH_D2DD(SinCos2Pi, AVX512F, AVX2, SSE2, NONE)
+
+// ---------- define exported vector math functions with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+#define EXPORT_VECTORMATH_ZZ2Z(NAME, ...)                                    \
+  EXPORT_VECTORMATH_ANY( NAME ## COMPLEX16, (COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len), (out, in1, in2, len), __VA_ARGS__ )
+
+EXPORT_VECTORMATH_ZZ2Z(Multiply, AVX512F, AVX2, AVX, SSE2)
+EXPORT_VECTORMATH_ZZ2Z(MultiplyConj, AVX512F, AVX2, AVX, SSE2)
+
+// ---------- define exported vector math functions with 1 COMPLEX16 vector input to 1 REAL8 vector output (Z2D) ----------
+#define EXPORT_VECTORMATH_Z2D(NAME, ...)                                     \
+  EXPORT_VECTORMATH_ANY( NAME ## COMPLEX16, (REAL8 *out, const COMPLEX16 *in, const UINT4 len), (out, in, len), __VA_ARGS__ )
+
+EXPORT_VECTORMATH_Z2D(Abs2, AVX512F, AVX2, AVX, SSE2)
+
+// ---------- define exported vector math functions with 2 COMPLEX16 vector inputs to 1 COMPLEX16 scalar output (ZZ2z) ----------
+#define EXPORT_VECTORMATH_ZZ2z(NAME, ...)                                    \
+  EXPORT_VECTORMATH_ANY( NAME ## COMPLEX16, (COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len), (out, in1, in2, len), __VA_ARGS__ )
+
+EXPORT_VECTORMATH_ZZ2z(DotConj, AVX512F, AVX2, AVX, SSE2)
+
+// ---------- define exported weighted inner products of 2 complex vector inputs and 1 real vector input to 1 COMPLEX16 and 1 REAL8 scalar output (ZZD2zd, CCS2zd) ----------
+#define EXPORT_VECTORMATH_ZZD2zd(NAME, ...)                                  \
+  EXPORT_VECTORMATH_ANY( NAME ## COMPLEX16, (COMPLEX16 *hd, REAL8 *hh, const COMPLEX16 *h, const COMPLEX16 *d, const REAL8 *w, const UINT4 len, const VectorMathSumMethod method), (hd, hh, h, d, w, len, method), __VA_ARGS__ )
+#define EXPORT_VECTORMATH_CCS2zd(NAME, ...)                                  \
+  EXPORT_VECTORMATH_ANY( NAME ## COMPLEX8, (COMPLEX16 *hd, REAL8 *hh, const COMPLEX8 *h, const COMPLEX8 *d, const REAL4 *w, const UINT4 len, const VectorMathSumMethod method), (hd, hh, h, d, w, len, method), __VA_ARGS__ )
+
+EXPORT_VECTORMATH_ZZD2zd(WeightedInnerProduct, AVX512F, AVX2, SSE2, NONE)
+EXPORT_VECTORMATH_CCS2zd(WeightedInnerProduct, AVX512F, AVX2, SSE2, NONE)
+
@@ -162,6 +162,30 @@ int XLALVectorSinCosREAL4 ( REAL4 *out1, REAL4 *out2, const REAL4 *in, const UIN
 /** Compute \f$\text{out1} = \sin(2\pi \text{in}), \text{out2} = \cos(2\pi \text{in})\f$ over REAL4 vectors \c out1, \c out2, \c in with \c len elements */
 int XLALVectorSinCos2PiREAL4 ( REAL4 *out1, REAL4 *out2, const REAL4 *in, const UINT4 len );
 
+/** Compute \f$\text{out} = \sin(\text{in})\f$ over REAL8 vectors \c out, \c in with \c len elements */
+int XLALVectorSinREAL8 ( REAL8 *out, const REAL8 *in, const UINT4 len );
+
+/** Compute \f$\text{out} = \cos(\text{in})\f$ over REAL8 vectors \c out, \c in with \c len elements */
+int XLALVectorCosREAL8 ( REAL8 *out, const REAL8 *in, const UINT4 len );
+
+/** Compute \f$\text{out} = \exp(\text{in})\f$ over REAL8 vectors \c out, \c in with \c len elements */
+int XLALVectorExpREAL8 ( REAL8 *out, const REAL8 *in, const UINT4 len );
+
+/** Compute \f$\text{out} = \log(\text{in})\f$ over REAL8 vectors \c out, \c in with \c len elements */
+int XLALVectorLogREAL8 ( REAL8 *out, const REAL8 *in, const UINT4 len );
+
+/** Compute \f$\text{out1} = \sin(\text{in}), \text{out2} = \cos(\text{in})\f$ over REAL8 vectors \c out1, \c out2, \c in with \c len elements */
+int XLALVectorSinCosREAL8 ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len );
+
+/** Compute \f$\text{out1} = \sin(2\pi \text{in}), \text{out2} = \cos(2\pi \text{in})\f$ over REAL8 vectors \c out1, \c out2, \c in with \c len elements */
+int XLALVectorSinCos2PiREAL8 ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len );
+
+/** Compute \f$\text{out} = |\text{in}|^2\f$ over COMPLEX16 vector \c in with \c len elements, into REAL8 vector \c out */
+int XLALVectorAbs2COMPLEX16 ( REAL8 *out, const COMPLEX16 *in, const UINT4 len );
+
+/** Compute \f$\text{out} = |\text{in}|^2\f$ over COMPLEX8 vector \c in with \c len elements, into REAL4 vector \c out */
+int XLALVectorAbs2COMPLEX8 ( REAL4 *out, const COMPLEX8 *in, const UINT4 len );
+
 /** @} */
 
 /** \name Vector by Vector Operations */
@@ -179,6 +203,9 @@ int XLALVectorMultiplyREAL4 ( REAL4 *out, const REAL4 *in1, const REAL4 *in2, co
 /** Compute \f$\text{out} = max ( \text{in1}, \text{in2} )\f$ over REAL4 vectors \c in1 and \c in2 with \c len elements */
 int XLALVectorMaxREAL4 ( REAL4 *out, const REAL4 *in1, const REAL4 *in2, const UINT4 len);
 
+/** Compute \f$\text{out1} = \text{in1} + \text{in3}, \text{out2} = max ( \text{in2}, \text{in3} )\f$ in a single pass over REAL4 vectors \c in1, \c in2 and \c in3 with \c len elements */
+int XLALVectorAddMaxREAL4 ( REAL4 *out1, REAL4 *out2, const REAL4 *in1, const REAL4 *in2, const REAL4 *in3, const UINT4 len);
+
 /** Compute \f$\text{out} = \text{in1} + \text{in2}\f$ over REAL8 vectors \c in1 and \c in2 with \c len elements */
 int XLALVectorAddREAL8 ( REAL8 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len);
 
@@ -197,6 +224,41 @@ int XLALVectorMultiplyCOMPLEX8 (  COMPLEX8 *out, const COMPLEX8 *in1, const COMP
 /** Compute \f$\text{out} = \text{in1} + \text{in2}\f$ over COMPLEX8 vectors \c in1 and \c in2 with \c len elements */
 int XLALVectorAddCOMPLEX8 ( COMPLEX8 *out, const COMPLEX8 *in1, const COMPLEX8 *in2, const UINT4 len);
 
+/** Compute \f$\text{out} = \text{in1} \times \text{in2}\f$ over COMPLEX16 vectors \c in1 and \c in2 with \c len elements */
+int XLALVectorMultiplyCOMPLEX16 ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len );
+
+/** Compute \f$\text{out} = \text{in1} \times \text{in2}^*\f$ over COMPLEX16 vectors \c in1 and \c in2 with \c len elements */
+int XLALVectorMultiplyConjCOMPLEX16 ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len );
+
+/** Compute the scalar \f$\text{out} = \sum_i \text{in1}_i \times \text{in2}_i^*\f$ over COMPLEX16 vectors \c in1 and \c in2 with \c len elements */
+int XLALVectorDotConjCOMPLEX16 ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len );
+
+/** @} */
+
+/** \name Weighted Inner Products */
+/** @{ */
+
+/** Summation methods for the weighted inner products */
+typedef enum tagVectorMathSumMethod {
+  VECTORMATH_SUM_DIRECT = 0,	/**< Direct summation (in each SIMD lane) */
+  VECTORMATH_SUM_KAHAN,		/**< Kahan compensated summation (in each SIMD lane) */
+  VECTORMATH_SUM_PAIRWISE,	/**< Pairwise summation of blocks of directly-summed elements */
+} VectorMathSumMethod;
+
+/**
+ * Compute in a single pass the weighted inner products \f$\text{hd} = \sum_i \text{w}_i \text{h}_i^* \text{d}_i\f$ and
+ * \f$\text{hh} = \sum_i \text{w}_i |\text{h}_i|^2\f$ over COMPLEX16 vectors \c h, \c d and REAL8 vector \c w with \c len elements,
+ * using summation method \c method; \c hh may be NULL if not required
+ */
+int XLALVectorWeightedInnerProductCOMPLEX16 ( COMPLEX16 *hd, REAL8 *hh, const COMPLEX16 *h, const COMPLEX16 *d, const REAL8 *w, const UINT4 len, const VectorMathSumMethod method );
+
+/**
+ * Compute in a single pass the weighted inner products \f$\text{hd} = \sum_i \text{w}_i \text{h}_i^* \text{d}_i\f$ and
+ * \f$\text{hh} = \sum_i \text{w}_i |\text{h}_i|^2\f$ over COMPLEX8 vectors \c h, \c d and REAL4 vector \c w with \c len elements,
+ * using summation method \c method; \c hh may be NULL if not required. Sums are accumulated in double precision.
+ */
+int XLALVectorWeightedInnerProductCOMPLEX8 ( COMPLEX16 *hd, REAL8 *hh, const COMPLEX8 *h, const COMPLEX8 *d, const REAL4 *w, const UINT4 len, const VectorMathSumMethod method );
+
 /** @} */
 
 /** \name Vector by Scalar Operations */
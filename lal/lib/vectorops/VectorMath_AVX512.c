@@ -0,0 +1,310 @@
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301  USA
+//
+
+// ---------- INCLUDES ----------
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <config.h>
+
+#include <immintrin.h>
+
+#include <lal/LALConstants.h>
+#include <lal/VectorMath.h>
+
+#include "VectorMath_internal.h"
+
+#ifndef __AVX512F__
+#error "VectorMath_AVX512.c requires SIMD instruction set AVX512F"
+#endif
+
+// ---------- double-precision operations used by VectorMath_pd_mathfun.h ----------
+#define PD_CASTI(a)             _mm512_castpd_si512 ( a )
+#define PD_CASTD(a)             _mm512_castsi512_pd ( a )
+
+#define V_PD                    __m512d
+#define V_PD_LEN                8
+#define V_MASK                  __mmask8
+#define PD_SET1(x)              _mm512_set1_pd ( x )
+#define PD_LOADU(p)             _mm512_loadu_pd ( p )
+#define PD_STOREU(p,a)          _mm512_storeu_pd ( p, a )
+#define PD_ADD(a,b)             _mm512_add_pd ( a, b )
+#define PD_SUB(a,b)             _mm512_sub_pd ( a, b )
+#define PD_MUL(a,b)             _mm512_mul_pd ( a, b )
+#define PD_DIV(a,b)             _mm512_div_pd ( a, b )
+#define PD_AND(a,b)             PD_CASTD ( _mm512_and_epi64 ( PD_CASTI ( a ), PD_CASTI ( b ) ) )
+#define PD_OR(a,b)              PD_CASTD ( _mm512_or_epi64 ( PD_CASTI ( a ), PD_CASTI ( b ) ) )
+#define PD_XOR(a,b)             PD_CASTD ( _mm512_xor_epi64 ( PD_CASTI ( a ), PD_CASTI ( b ) ) )
+#define PD_SRLI64(a,n)          PD_CASTD ( _mm512_srli_epi64 ( PD_CASTI ( a ), n ) )
+#define PD_SLLI64(a,n)          PD_CASTD ( _mm512_slli_epi64 ( PD_CASTI ( a ), n ) )
+#define PD_CMPLT(a,b)           _mm512_cmp_pd_mask ( a, b, _CMP_LT_OQ )
+#define PD_CMPLE(a,b)           _mm512_cmp_pd_mask ( a, b, _CMP_LE_OQ )
+#define PD_CMPEQ(a,b)           _mm512_cmp_pd_mask ( a, b, _CMP_EQ_OQ )
+#define PD_CMPUNORD(a,b)        _mm512_cmp_pd_mask ( a, b, _CMP_UNORD_Q )
+#define PD_SELECT(m,a,b)        _mm512_mask_blend_pd ( m, b, a )
+#define MASK_OR(m1,m2)          ( (__mmask8) ( (m1) | (m2) ) )
+#define MASK_ANY(m)             ( m )
+
+#include "VectorMath_pd_mathfun.h"
+
+// ---------- double-precision operations used by VectorMath_pd_innerprod.h ----------
+#define PD_SWAP_PAIRS(a)        _mm512_permute_pd ( a, 0x55 )
+#define PD_LOADDUP(p)           _mm512_permutexvar_pd ( _mm512_set_epi64 ( 3, 3, 2, 2, 1, 1, 0, 0 ), _mm512_castpd256_pd512 ( _mm256_loadu_pd ( p ) ) )
+#define PD_LOADU_PS(p)          _mm512_cvtps_pd ( _mm256_loadu_ps ( p ) )
+#define PD_LOADDUP_PS(p)        _mm512_cvtps_pd ( local_loaddup4_ps ( p ) )
+
+// load 4 floats (w0,w1,w2,w3) as (w0,w0,w1,w1,w2,w2,w3,w3)
+static inline __m256 local_loaddup4_ps ( const REAL4 *p )
+{
+  const __m128 x = _mm_loadu_ps ( p );
+  return _mm256_insertf128_ps ( _mm256_castps128_ps256 ( _mm_unpacklo_ps ( x, x ) ), _mm_unpackhi_ps ( x, x ), 1 );
+}
+
+#include "VectorMath_pd_innerprod.h"
+
+// mask selecting the first n (<=8) lanes
+#define LANES_MASK(n)           ( (__mmask8) ( ( 1u << (n) ) - 1u ) )
+
+// ---------- local operators and operator-wrappers ----------
+
+// in1: a0,b0,...,a3,b3, in2: c0,d0,...,c3,d3 (four COMPLEX16 each); returns a0c0-b0d0, b0c0+a0d0, ...
+UNUSED static inline __m512d
+local_cmul_pd ( __m512d in1, __m512d in2 )
+{
+  __m512d re2 = _mm512_movedup_pd ( in2 );              // c0,c0,...,c3,c3
+  __m512d im2 = _mm512_permute_pd ( in2, 0xFF );        // d0,d0,...,d3,d3
+  __m512d swp1 = _mm512_permute_pd ( in1, 0x55 );       // b0,a0,...,b3,a3
+  return _mm512_fmaddsub_pd ( in1, re2, _mm512_mul_pd ( swp1, im2 ) );
+}
+
+// in1: a0,b0,...,a3,b3, in2: c0,d0,...,c3,d3 (four COMPLEX16 each); returns a0c0+b0d0, b0c0-a0d0, ...
+UNUSED static inline __m512d
+local_cmulconj_pd ( __m512d in1, __m512d in2 )
+{
+  __m512d re2 = _mm512_movedup_pd ( in2 );              // c0,c0,...,c3,c3
+  __m512d im2 = _mm512_permute_pd ( in2, 0xFF );        // d0,d0,...,d3,d3
+  __m512d swp1 = _mm512_permute_pd ( in1, 0x55 );       // b0,a0,...,b3,a3
+  return _mm512_fmsubadd_pd ( in1, re2, _mm512_mul_pd ( swp1, im2 ) );
+}
+
+// in1: z0,...,z3, in2: z4,...,z7 (four COMPLEX16 each); returns |z0|^2, ..., |z7|^2
+UNUSED static inline __m512d
+local_cabs2_pd ( __m512d in1, __m512d in2 )
+{
+  const __m512i re_idx = _mm512_setr_epi64 ( 0, 2, 4, 6, 8, 10, 12, 14 );
+  const __m512i im_idx = _mm512_setr_epi64 ( 1, 3, 5, 7, 9, 11, 13, 15 );
+  __m512d re = _mm512_permutex2var_pd ( in1, re_idx, in2 );
+  __m512d im = _mm512_permutex2var_pd ( in1, im_idx, in2 );
+  return _mm512_fmadd_pd ( re, re, _mm512_mul_pd ( im, im ) );
+}
+
+// ========== internal generic AVX512 functions ==========
+
+// ---------- generic AVX512 operator with 1 REAL8 vector input to 1 REAL8 vector output (D2D) ----------
+static inline int
+XLALVectorMath_D2D_AVX512 ( REAL8 *out, const REAL8 *in, const UINT4 len, __m512d (*f)(__m512d) )
+{
+
+  // walk through vector in blocks of 8
+  UINT4 i8Max = len - ( len % 8 );
+  for ( UINT4 i8 = 0; i8 < i8Max; i8 += 8 )
+    {
+      __m512d in8p = _mm512_loadu_pd(&in[i8]);
+      __m512d out8p = (*f)( in8p );
+      _mm512_storeu_pd(&out[i8], out8p);
+    }
+
+  // deal with the remaining (<=7) terms using masked loads/stores
+  if ( i8Max < len )
+    {
+      const __mmask8 m = LANES_MASK ( len - i8Max );
+      __m512d in8p = _mm512_maskz_loadu_pd( m, &in[i8Max] );
+      __m512d out8p = (*f)( in8p );
+      _mm512_mask_storeu_pd( &out[i8Max], m, out8p );
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_D2D_AVX512()
+
+// ---------- generic AVX512 operator with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+static inline int
+XLALVectorMath_D2DD_AVX512 ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len, void (*f)(__m512d, __m512d*, __m512d*) )
+{
+
+  // walk through vector in blocks of 8
+  UINT4 i8Max = len - ( len % 8 );
+  for ( UINT4 i8 = 0; i8 < i8Max; i8 += 8 )
+    {
+      __m512d in8p = _mm512_loadu_pd(&in[i8]);
+      __m512d out8p_1, out8p_2;
+      (*f) ( in8p, &out8p_1, &out8p_2 );
+      _mm512_storeu_pd(&out1[i8], out8p_1);
+      _mm512_storeu_pd(&out2[i8], out8p_2);
+    }
+
+  // deal with the remaining (<=7) terms using masked loads/stores
+  if ( i8Max < len )
+    {
+      const __mmask8 m = LANES_MASK ( len - i8Max );
+      __m512d in8p = _mm512_maskz_loadu_pd( m, &in[i8Max] );
+      __m512d out8p_1, out8p_2;
+      (*f) ( in8p, &out8p_1, &out8p_2 );
+      _mm512_mask_storeu_pd( &out1[i8Max], m, out8p_1 );
+      _mm512_mask_storeu_pd( &out2[i8Max], m, out8p_2 );
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_D2DD_AVX512()
+
+// ---------- generic AVX512 operator with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+static inline int
+XLALVectorMath_ZZ2Z_AVX512 ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len, __m512d (*op)(__m512d, __m512d) )
+{
+
+  // walk through vector in blocks of 4
+  UINT4 i4Max = len - ( len % 4 );
+  for ( UINT4 i4 = 0; i4 < i4Max; i4 += 4 )
+    {
+      __m512d in8p_1 = _mm512_loadu_pd( (const REAL8*)&in1[i4] );
+      __m512d in8p_2 = _mm512_loadu_pd( (const REAL8*)&in2[i4] );
+      __m512d out8p = (*op) ( in8p_1, in8p_2 );
+      _mm512_storeu_pd( (REAL8*)&out[i4], out8p );
+    }
+
+  // deal with the remaining (<=3) terms using masked loads/stores
+  if ( i4Max < len )
+    {
+      const __mmask8 m = LANES_MASK ( 2 * ( len - i4Max ) );
+      __m512d in8p_1 = _mm512_maskz_loadu_pd( m, (const REAL8*)&in1[i4Max] );
+      __m512d in8p_2 = _mm512_maskz_loadu_pd( m, (const REAL8*)&in2[i4Max] );
+      __m512d out8p = (*op) ( in8p_1, in8p_2 );
+      _mm512_mask_storeu_pd( (REAL8*)&out[i4Max], m, out8p );
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_ZZ2Z_AVX512()
+
+// ---------- generic AVX512 operator with 1 COMPLEX16 vector input to 1 REAL8 vector output (Z2D) ----------
+static inline int
+XLALVectorMath_Z2D_AVX512 ( REAL8 *out, const COMPLEX16 *in, const UINT4 len, __m512d (*op)(__m512d, __m512d) )
+{
+
+  // walk through vector in blocks of 8
+  UINT4 i8Max = len - ( len % 8 );
+  for ( UINT4 i8 = 0; i8 < i8Max; i8 += 8 )
+    {
+      __m512d in8p_1 = _mm512_loadu_pd( (const REAL8*)&in[i8] );
+      __m512d in8p_2 = _mm512_loadu_pd( (const REAL8*)&in[i8+4] );
+      __m512d out8p = (*op) ( in8p_1, in8p_2 );
+      _mm512_storeu_pd( &out[i8], out8p );
+    }
+
+  // deal with the remaining (<=7) terms using masked loads/stores
+  if ( i8Max < len )
+    {
+      const UINT4 n = len - i8Max;
+      const __mmask8 m1 = ( n >= 4 ) ? LANES_MASK ( 8 ) : LANES_MASK ( 2 * n );
+      const __mmask8 m2 = ( n >= 4 ) ? LANES_MASK ( 2 * ( n - 4 ) ) : 0;
+      __m512d in8p_1 = _mm512_maskz_loadu_pd( m1, (const REAL8*)&in[i8Max] );
+      __m512d in8p_2 = _mm512_maskz_loadu_pd( m2, (const REAL8*)&in[i8Max+4] );
+      __m512d out8p = (*op) ( in8p_1, in8p_2 );
+      _mm512_mask_storeu_pd( &out[i8Max], LANES_MASK ( n ), out8p );
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_Z2D_AVX512()
+
+// ---------- generic AVX512 operator with 2 COMPLEX16 vector inputs summed to 1 COMPLEX16 scalar output (ZZ2z) ----------
+static inline int
+XLALVectorMath_ZZ2z_AVX512 ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len, __m512d (*op)(__m512d, __m512d) )
+{
+  __m512d sum8p = _mm512_setzero_pd();
+
+  // walk through vector in blocks of 4
+  UINT4 i4Max = len - ( len % 4 );
+  for ( UINT4 i4 = 0; i4 < i4Max; i4 += 4 )
+    {
+      __m512d in8p_1 = _mm512_loadu_pd( (const REAL8*)&in1[i4] );
+      __m512d in8p_2 = _mm512_loadu_pd( (const REAL8*)&in2[i4] );
+      sum8p = _mm512_add_pd ( sum8p, (*op) ( in8p_1, in8p_2 ) );
+    }
+
+  // deal with the remaining (<=3) terms using masked loads
+  if ( i4Max < len )
+    {
+      const __mmask8 m = LANES_MASK ( 2 * ( len - i4Max ) );
+      __m512d in8p_1 = _mm512_maskz_loadu_pd( m, (const REAL8*)&in1[i4Max] );
+      __m512d in8p_2 = _mm512_maskz_loadu_pd( m, (const REAL8*)&in2[i4Max] );
+      sum8p = _mm512_add_pd ( sum8p, (*op) ( in8p_1, in8p_2 ) );
+    }
+
+  // add the four COMPLEX16 partial sums
+  (*out) = crect( _mm512_mask_reduce_add_pd ( 0x55, sum8p ), _mm512_mask_reduce_add_pd ( 0xAA, sum8p ) );
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_ZZ2z_AVX512()
+
+// ========== internal AVX512 vector math functions ==========
+
+// ---------- define vector math functions with 1 REAL8 vector input to 1 REAL8 vector output (D2D) ----------
+#define DEFINE_VECTORMATH_D2D(NAME, AVX512_OP)                          \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_D2D_AVX512, NAME ## REAL8, ( REAL8 *out, const REAL8 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, AVX512_OP ) )
+
+DEFINE_VECTORMATH_D2D(Sin, pd_sin)
+DEFINE_VECTORMATH_D2D(Cos, pd_cos)
+DEFINE_VECTORMATH_D2D(Exp, pd_exp)
+DEFINE_VECTORMATH_D2D(Log, pd_log)
+
+// ---------- define vector math functions with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+#define DEFINE_VECTORMATH_D2DD(NAME, AVX512_OP)                         \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_D2DD_AVX512, NAME ## REAL8, ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len ), ( (out1 != NULL) && (out2 != NULL) && (in != NULL) ), ( out1, out2, in, len, AVX512_OP ) )
+
+DEFINE_VECTORMATH_D2DD(SinCos, pd_sincos)
+DEFINE_VECTORMATH_D2DD(SinCos2Pi, pd_sincos_2pi)
+
+// ---------- define vector math functions with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+#define DEFINE_VECTORMATH_ZZ2Z(NAME, AVX512_OP)                         \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_ZZ2Z_AVX512, NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, AVX512_OP ) )
+
+DEFINE_VECTORMATH_ZZ2Z(Multiply, local_cmul_pd)
+DEFINE_VECTORMATH_ZZ2Z(MultiplyConj, local_cmulconj_pd)
+
+// ---------- define vector math functions with 1 COMPLEX16 vector input to 1 REAL8 vector output (Z2D) ----------
+#define DEFINE_VECTORMATH_Z2D(NAME, AVX512_OP)                          \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_Z2D_AVX512, NAME ## COMPLEX16, ( REAL8 *out, const COMPLEX16 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, AVX512_OP ) )
+
+DEFINE_VECTORMATH_Z2D(Abs2, local_cabs2_pd)
+
+// ---------- define vector math functions with 2 COMPLEX16 vector inputs to 1 COMPLEX16 scalar output (ZZ2z) ----------
+#define DEFINE_VECTORMATH_ZZ2z(NAME, AVX512_OP)                         \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_ZZ2z_AVX512, NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, AVX512_OP ) )
+
+DEFINE_VECTORMATH_ZZ2z(DotConj, local_cmulconj_pd)
+
+// ---------- define weighted inner products of 2 complex vector inputs and 1 real vector input to 1 COMPLEX16 and 1 REAL8 scalar output (ZZD2zd, CCS2zd) ----------
+#define DEFINE_VECTORMATH_ZZD2zd(NAME)                                  \
+  DEFINE_VECTORMATH_ANY( pd_ip_compute, NAME ## COMPLEX16, ( COMPLEX16 *hd, REAL8 *hh, const COMPLEX16 *h, const COMPLEX16 *d, const REAL8 *w, const UINT4 len, const VectorMathSumMethod method ), ( (hd != NULL) && (h != NULL) && (d != NULL) && (w != NULL) ), ( hd, hh, h, d, w, len, method, pd_ip_load_COMPLEX16 ) )
+#define DEFINE_VECTORMATH_CCS2zd(NAME)                                  \
+  DEFINE_VECTORMATH_ANY( pd_ip_compute, NAME ## COMPLEX8, ( COMPLEX16 *hd, REAL8 *hh, const COMPLEX8 *h, const COMPLEX8 *d, const REAL4 *w, const UINT4 len, const VectorMathSumMethod method ), ( (hd != NULL) && (h != NULL) && (d != NULL) && (w != NULL) ), ( hd, hh, h, d, w, len, method, pd_ip_load_COMPLEX8 ) )
+
+DEFINE_VECTORMATH_ZZD2zd(WeightedInnerProduct)
+DEFINE_VECTORMATH_CCS2zd(WeightedInnerProduct)
@@ -35,6 +35,51 @@
 
 #include "VectorMath_avx_mathfun.h"
 
+#ifdef __AVX2__
+
+// ---------- double-precision operations used by VectorMath_pd_mathfun.h ----------
+#define V_PD                    __m256d
+#define V_PD_LEN                4
+#define V_MASK                  __m256d
+#define PD_SET1(x)              _mm256_set1_pd ( x )
+#define PD_LOADU(p)             _mm256_loadu_pd ( p )
+#define PD_STOREU(p,a)          _mm256_storeu_pd ( p, a )
+#define PD_ADD(a,b)             _mm256_add_pd ( a, b )
+#define PD_SUB(a,b)             _mm256_sub_pd ( a, b )
+#define PD_MUL(a,b)             _mm256_mul_pd ( a, b )
+#define PD_DIV(a,b)             _mm256_div_pd ( a, b )
+#define PD_AND(a,b)             _mm256_and_pd ( a, b )
+#define PD_OR(a,b)              _mm256_or_pd ( a, b )
+#define PD_XOR(a,b)             _mm256_xor_pd ( a, b )
+#define PD_SRLI64(a,n)          _mm256_castsi256_pd ( _mm256_srli_epi64 ( _mm256_castpd_si256 ( a ), n ) )
+#define PD_SLLI64(a,n)          _mm256_castsi256_pd ( _mm256_slli_epi64 ( _mm256_castpd_si256 ( a ), n ) )
+#define PD_CMPLT(a,b)           _mm256_cmp_pd ( a, b, _CMP_LT_OQ )
+#define PD_CMPLE(a,b)           _mm256_cmp_pd ( a, b, _CMP_LE_OQ )
+#define PD_CMPEQ(a,b)           _mm256_cmp_pd ( a, b, _CMP_EQ_OQ )
+#define PD_CMPUNORD(a,b)        _mm256_cmp_pd ( a, b, _CMP_UNORD_Q )
+#define PD_SELECT(m,a,b)        _mm256_blendv_pd ( b, a, m )
+#define MASK_OR(m1,m2)          _mm256_or_pd ( m1, m2 )
+#define MASK_ANY(m)             _mm256_movemask_pd ( m )
+
+#include "VectorMath_pd_mathfun.h"
+
+// ---------- double-precision operations used by VectorMath_pd_innerprod.h ----------
+#define PD_SWAP_PAIRS(a)        _mm256_permute_pd ( a, 0x5 )
+#define PD_LOADDUP(p)           _mm256_permute4x64_pd ( _mm256_castpd128_pd256 ( _mm_loadu_pd ( p ) ), 0x50 )
+#define PD_LOADU_PS(p)          _mm256_cvtps_pd ( _mm_loadu_ps ( p ) )
+#define PD_LOADDUP_PS(p)        _mm256_cvtps_pd ( local_loaddup2_ps ( p ) )
+
+// load 2 floats (w0,w1) as (w0,w0,w1,w1)
+static inline __m128 local_loaddup2_ps ( const REAL4 *p )
+{
+  const __m128 x = _mm_castsi128_ps ( _mm_loadl_epi64 ( (const __m128i *) p ) );
+  return _mm_unpacklo_ps ( x, x );
+}
+
+#include "VectorMath_pd_innerprod.h"
+
+#endif // __AVX2__
+
 // ---------- local operators and operator-wrappers ----------
 UNUSED static inline __m256
 local_add_ps ( __m256 in1, __m256 in2 )
@@ -60,6 +105,13 @@ local_max_ps ( __m256 in1, __m256 in2 )
   return _mm256_max_ps ( in1, in2 );
 }
 
+UNUSED static inline void
+local_addmax_ps ( __m256 in1, __m256 in2, __m256 in3, __m256 *out1, __m256 *out2 )
+{
+  (*out1) = _mm256_add_ps ( in1, in3 );
+  (*out2) = _mm256_max_ps ( in2, in3 );
+}
+
 UNUSED static inline __m256d
 local_add_pd ( __m256d in1, __m256d in2 )
 {
@@ -84,6 +136,56 @@ local_max_pd ( __m256d in1, __m256d in2 )
   return _mm256_max_pd ( in1, in2 );
 }
 
+// in1: a0,b0,a1,b1, in2: c0,d0,c1,d1 (two COMPLEX16 each); returns a0c0-b0d0, b0c0+a0d0, ...
+UNUSED static inline __m256d
+local_cmul_pd ( __m256d in1, __m256d in2 )
+{
+  __m256d re2 = _mm256_movedup_pd ( in2 );              // c0,c0,c1,c1
+  __m256d im2 = _mm256_permute_pd ( in2, 0xF );         // d0,d0,d1,d1
+  __m256d swp1 = _mm256_permute_pd ( in1, 0x5 );        // b0,a0,b1,a1
+  __m256d t1 = _mm256_mul_pd ( in1, re2 );
+  __m256d t2 = _mm256_mul_pd ( swp1, im2 );
+  return _mm256_addsub_pd ( t1, t2 );
+}
+
+// in1: a0,b0,a1,b1, in2: c0,d0,c1,d1 (two COMPLEX16 each); returns a0c0+b0d0, b0c0-a0d0, ...
+UNUSED static inline __m256d
+local_cmulconj_pd ( __m256d in1, __m256d in2 )
+{
+  const __m256d neg1 = _mm256_setr_pd ( 0.0, -0.0, 0.0, -0.0 );
+  __m256d re2 = _mm256_movedup_pd ( in2 );              // c0,c0,c1,c1
+  __m256d im2 = _mm256_permute_pd ( in2, 0xF );         // d0,d0,d1,d1
+  __m256d swp1 = _mm256_permute_pd ( in1, 0x5 );        // b0,a0,b1,a1
+  __m256d t1 = _mm256_mul_pd ( in1, re2 );
+  __m256d t2 = _mm256_mul_pd ( swp1, im2 );
+  return _mm256_add_pd ( t1, _mm256_xor_pd ( t2, neg1 ) );
+}
+
+// in1: z0..z3, in2: z4..z7 (four COMPLEX8 each); returns |z0|^2, ..., |z7|^2
+UNUSED static inline __m256
+local_cabs2_ps ( __m256 in1, __m256 in2 )
+{
+  __m256 sq1 = _mm256_mul_ps ( in1, in1 );
+  __m256 sq2 = _mm256_mul_ps ( in2, in2 );
+  __m256 lo = _mm256_permute2f128_ps ( sq1, sq2, 0x20 );      // z0,z1,z4,z5
+  __m256 hi = _mm256_permute2f128_ps ( sq1, sq2, 0x31 );      // z2,z3,z6,z7
+  __m256 re2 = _mm256_shuffle_ps ( lo, hi, _MM_SHUFFLE(2,0,2,0) );
+  __m256 im2 = _mm256_shuffle_ps ( lo, hi, _MM_SHUFFLE(3,1,3,1) );
+  return _mm256_add_ps ( re2, im2 );
+}
+
+// in1: z0,z1, in2: z2,z3 (two COMPLEX16 each); returns |z0|^2, |z1|^2, |z2|^2, |z3|^2
+UNUSED static inline __m256d
+local_cabs2_pd ( __m256d in1, __m256d in2 )
+{
+  __m256d sq1 = _mm256_mul_pd ( in1, in1 );
+  __m256d sq2 = _mm256_mul_pd ( in2, in2 );
+  __m256d h = _mm256_hadd_pd ( sq1, sq2 );              // |z0|^2, |z2|^2, |z1|^2, |z3|^2
+  __m128d lo = _mm256_castpd256_pd128 ( h );
+  __m128d hi = _mm256_extractf128_pd ( h, 1 );
+  return _mm256_insertf128_pd ( _mm256_castpd128_pd256 ( _mm_unpacklo_pd ( lo, hi ) ), _mm_unpackhi_pd ( lo, hi ), 1 );
+}
+
 UNUSED static inline __m256
 local_round_ps ( __m256 in )
 {
@@ -277,6 +379,44 @@ XLALVectorMath_SS2S_AVXx ( REAL4 *out, const REAL4 *in1, const REAL4 *in2, const
 
 } // XLALVectorMath_SS2S_AVXx()
 
+// ---------- generic AVXx operator with 3 REAL4 vector inputs to 2 REAL4 vector outputs (SSS2SS) ----------
+static inline int
+XLALVectorMath_SSS2SS_AVXx ( REAL4 *out1, REAL4 *out2, const REAL4 *in1, const REAL4 *in2, const REAL4 *in3, const UINT4 len, void (*op)(__m256, __m256, __m256, __m256*, __m256*) )
+{
+
+  // walk through vector in blocks of 8
+  UINT4 i8Max = len - ( len % 8 );
+  for ( UINT4 i8 = 0; i8 < i8Max; i8 += 8 )
+    {
+      __m256 in8p_1 = _mm256_loadu_ps(&in1[i8]);
+      __m256 in8p_2 = _mm256_loadu_ps(&in2[i8]);
+      __m256 in8p_3 = _mm256_loadu_ps(&in3[i8]);
+      __m256 out8p_1, out8p_2;
+      (*op) ( in8p_1, in8p_2, in8p_3, &out8p_1, &out8p_2 );
+      _mm256_storeu_ps(&out1[i8], out8p_1);
+      _mm256_storeu_ps(&out2[i8], out8p_2);
+    }
+
+  // deal with the remaining (<=7) terms separately
+  V8SF in8_1 = {.f={0,0,0,0,0,0,0,0}};
+  V8SF in8_2 = {.f={0,0,0,0,0,0,0,0}};
+  V8SF in8_3 = {.f={0,0,0,0,0,0,0,0}};
+  V8SF out8_1, out8_2;
+  for ( UINT4 i = i8Max,j=0; i < len; i ++, j++ ) {
+    in8_1.f[j] = in1[i];
+    in8_2.f[j] = in2[i];
+    in8_3.f[j] = in3[i];
+  }
+  (*op) ( in8_1.v, in8_2.v, in8_3.v, &out8_1.v, &out8_2.v );
+  for ( UINT4 i = i8Max,j=0; i < len; i ++, j++ ) {
+    out1[i] = out8_1.f[j];
+    out2[i] = out8_2.f[j];
+  }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_SSS2SS_AVXx()
+
 // ---------- generic SSEx operator with 1 REAL4 scalar and 1 REAL4 vector inputs to 1 REAL4 vector output (sS2S) ----------
 static inline int
 XLALVectorMath_sS2S_AVXx ( REAL4 *out, REAL4 scalar, const REAL4 *in, const UINT4 len, __m256 (*op)(__m256, __m256) )
@@ -406,6 +546,39 @@ XLALVectorMath_CC2C_AVXx ( COMPLEX8 *out, const COMPLEX8 *in1, const COMPLEX8 *i
 
 } // XLALVectorMath_CC2C_AVXx()
 
+// ---------- generic AVXx operator with 1 COMPLEX8 vector input to 1 REAL4 vector output (C2S) ----------
+static inline int
+XLALVectorMath_C2S_AVXx ( REAL4 *out, const COMPLEX8 *in, const UINT4 len, __m256 (*op)(__m256, __m256) )
+{
+
+  // walk through vector in blocks of 8
+  UINT4 i8Max = len - ( len % 8 );
+  for ( UINT4 i8 = 0; i8 < i8Max; i8 += 8 )
+    {
+      __m256 in8p_1 = _mm256_loadu_ps( (const REAL4*)&in[i8] );
+      __m256 in8p_2 = _mm256_loadu_ps( (const REAL4*)&in[i8+4] );
+      __m256 out8p = (*op) ( in8p_1, in8p_2 );
+      _mm256_storeu_ps( &out[i8], out8p );
+    }
+
+  // deal with the remaining (<=7) terms separately
+  REAL4 in16[16] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
+  V8SF out8;
+  for ( UINT4 i = i8Max,j=0; i < len; i++, j+=2 )
+    {
+      in16[j]   = crealf ( in[i] );
+      in16[j+1] = cimagf ( in[i] );
+    }
+  out8.v = (*op) ( _mm256_loadu_ps( &in16[0] ), _mm256_loadu_ps( &in16[8] ) );
+  for ( UINT4 i = i8Max,j=0; i < len; i++, j++ )
+    {
+      out[i] = out8.f[j];
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_C2S_AVXx()
+
 // ---------- generic AVXx operator with 1 COMPLEX8 scalar and 1 COMPLEX8 vector inputs to 1 COMPLEX8 vector output (cC2C) ----------
 static inline int
 XLALVectorMath_cC2C_AVXx ( COMPLEX8 *out, COMPLEX8 scalar, const COMPLEX8 *in, const UINT4 len, __m256 (*op)(__m256, __m256) )
@@ -468,6 +641,146 @@ XLALVectorMath_D2D_AVXx ( REAL8 *out, const REAL8 *in, const UINT4 len, __m256d
 
 } // XLALVectorMath_D2D_AVXx()
 
+#ifdef __AVX2__
+
+// ---------- generic AVXx operator with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+static inline int
+XLALVectorMath_D2DD_AVXx ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len, void (*f)(__m256d, __m256d*, __m256d*) )
+{
+
+  // walk through vector in blocks of 4
+  UINT4 i4Max = len - ( len % 4 );
+  for ( UINT4 i4 = 0; i4 < i4Max; i4 += 4 )
+    {
+      __m256d in4p = _mm256_loadu_pd(&in[i4]);
+      __m256d out4p_1, out4p_2;
+      (*f) ( in4p, &out4p_1, &out4p_2 );
+      _mm256_storeu_pd(&out1[i4], out4p_1);
+      _mm256_storeu_pd(&out2[i4], out4p_2);
+    }
+
+  // deal with the remaining (<=3) terms separately
+  V4SD in4 = {.f={0,0,0,0}}, out4_1, out4_2;
+  for ( UINT4 i = i4Max,j=0; i < len; i ++, j++ ) {
+    in4.f[j] = in[i];
+  }
+  (*f) ( in4.v, &out4_1.v, &out4_2.v );
+  for ( UINT4 i = i4Max,j=0; i < len; i ++, j++ ) {
+    out1[i] = out4_1.f[j];
+    out2[i] = out4_2.f[j];
+  }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_D2DD_AVXx()
+
+#endif // __AVX2__
+
+// ---------- generic AVXx operator with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+static inline int
+XLALVectorMath_ZZ2Z_AVXx ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len, __m256d (*op)(__m256d, __m256d) )
+{
+
+  // walk through vector in blocks of 2
+  UINT4 i2Max = len - ( len % 2 );
+  for ( UINT4 i2 = 0; i2 < i2Max; i2 += 2 )
+    {
+      __m256d in4p_1 = _mm256_loadu_pd( (const REAL8*)&in1[i2] );
+      __m256d in4p_2 = _mm256_loadu_pd( (const REAL8*)&in2[i2] );
+      __m256d out4p = (*op) ( in4p_1, in4p_2 );
+      _mm256_storeu_pd( (REAL8*)&out[i2], out4p );
+    }
+
+  // deal with the remaining (<=1) terms separately
+  V4SD in4_1 = {.f={0,0,0,0}};
+  V4SD in4_2 = {.f={0,0,0,0}};
+  V4SD out4;
+  for ( UINT4 i = i2Max,j=0; i < len; i++, j+=2 )
+    {
+      in4_1.f[j]   = creal ( in1[i] );
+      in4_1.f[j+1] = cimag ( in1[i] );
+      in4_2.f[j]   = creal ( in2[i] );
+      in4_2.f[j+1] = cimag ( in2[i] );
+    }
+  out4.v = (*op) ( in4_1.v, in4_2.v );
+  for ( UINT4 i = i2Max,j=0; i < len; i++, j+=2 )
+    {
+      out[i] = crect( out4.f[j], out4.f[j+1] );
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_ZZ2Z_AVXx()
+
+// ---------- generic AVXx operator with 1 COMPLEX16 vector input to 1 REAL8 vector output (Z2D) ----------
+static inline int
+XLALVectorMath_Z2D_AVXx ( REAL8 *out, const COMPLEX16 *in, const UINT4 len, __m256d (*op)(__m256d, __m256d) )
+{
+
+  // walk through vector in blocks of 4
+  UINT4 i4Max = len - ( len % 4 );
+  for ( UINT4 i4 = 0; i4 < i4Max; i4 += 4 )
+    {
+      __m256d in4p_1 = _mm256_loadu_pd( (const REAL8*)&in[i4] );
+      __m256d in4p_2 = _mm256_loadu_pd( (const REAL8*)&in[i4+2] );
+      __m256d out4p = (*op) ( in4p_1, in4p_2 );
+      _mm256_storeu_pd( &out[i4], out4p );
+    }
+
+  // deal with the remaining (<=3) terms separately
+  REAL8 in8[8] = {0,0,0,0,0,0,0,0};
+  V4SD out4;
+  for ( UINT4 i = i4Max,j=0; i < len; i++, j+=2 )
+    {
+      in8[j]   = creal ( in[i] );
+      in8[j+1] = cimag ( in[i] );
+    }
+  out4.v = (*op) ( _mm256_loadu_pd( &in8[0] ), _mm256_loadu_pd( &in8[4] ) );
+  for ( UINT4 i = i4Max,j=0; i < len; i++, j++ )
+    {
+      out[i] = out4.f[j];
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_Z2D_AVXx()
+
+// ---------- generic AVXx operator with 2 COMPLEX16 vector inputs summed to 1 COMPLEX16 scalar output (ZZ2z) ----------
+static inline int
+XLALVectorMath_ZZ2z_AVXx ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len, __m256d (*op)(__m256d, __m256d) )
+{
+  __m256d sum4p = _mm256_setzero_pd();
+
+  // walk through vector in blocks of 2
+  UINT4 i2Max = len - ( len % 2 );
+  for ( UINT4 i2 = 0; i2 < i2Max; i2 += 2 )
+    {
+      __m256d in4p_1 = _mm256_loadu_pd( (const REAL8*)&in1[i2] );
+      __m256d in4p_2 = _mm256_loadu_pd( (const REAL8*)&in2[i2] );
+      sum4p = _mm256_add_pd ( sum4p, (*op) ( in4p_1, in4p_2 ) );
+    }
+
+  // deal with the remaining (<=1) terms separately
+  V4SD in4_1 = {.f={0,0,0,0}};
+  V4SD in4_2 = {.f={0,0,0,0}};
+  for ( UINT4 i = i2Max,j=0; i < len; i++, j+=2 )
+    {
+      in4_1.f[j]   = creal ( in1[i] );
+      in4_1.f[j+1] = cimag ( in1[i] );
+      in4_2.f[j]   = creal ( in2[i] );
+      in4_2.f[j+1] = cimag ( in2[i] );
+    }
+  sum4p = _mm256_add_pd ( sum4p, (*op) ( in4_1.v, in4_2.v ) );
+
+  // add the two COMPLEX16 partial sums
+  REAL8 sum2[2];
+  _mm_storeu_pd ( sum2, _mm_add_pd ( _mm256_castpd256_pd128 ( sum4p ), _mm256_extractf128_pd ( sum4p, 1 ) ) );
+  (*out) = crect( sum2[0], sum2[1] );
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_ZZ2z_AVXx()
+
 // ========== internal AVXx vector math functions ==========
 
 // ---------- define vector math functions with 1 REAL4 vector input to 1 REAL4 vector output (S2S) ----------
@@ -496,6 +809,12 @@ DEFINE_VECTORMATH_SS2S(Sub, local_sub_ps)
 DEFINE_VECTORMATH_SS2S(Multiply, local_mul_ps)
 DEFINE_VECTORMATH_SS2S(Max, local_max_ps)
 
+// ---------- define vector math functions with 3 REAL4 vector inputs to 2 REAL4 vector outputs (SSS2SS) ----------
+#define DEFINE_VECTORMATH_SSS2SS(NAME, AVX_OP)                          \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_SSS2SS_AVXx, NAME ## REAL4, ( REAL4 *out1, REAL4 *out2, const REAL4 *in1, const REAL4 *in2, const REAL4 *in3, const UINT4 len ), ( (out1 != NULL) && (out2 != NULL) && (in1 != NULL) && (in2 != NULL) && (in3 != NULL) ), ( out1, out2, in1, in2, in3, len, AVX_OP ) )
+
+DEFINE_VECTORMATH_SSS2SS(AddMax, local_addmax_ps)
+
 // ---------- define vector math functions with 1 REAL4 scalar and 1 REAL4 vector inputs to 1 REAL4 vector output (sS2S) ----------
 #define DEFINE_VECTORMATH_sS2S(NAME, AVX_OP)                            \
   DEFINE_VECTORMATH_ANY( XLALVectorMath_sS2S_AVXx, NAME ## REAL4, ( REAL4 *out, REAL4 scalar, const REAL4 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, scalar, in, len, AVX_OP ) )
@@ -533,8 +852,62 @@ DEFINE_VECTORMATH_CC2C(Add, local_add_ps)
 DEFINE_VECTORMATH_cC2C(Scale, local_cmul_ps)
 DEFINE_VECTORMATH_cC2C(Shift, local_add_ps)
 
+// ---------- define vector math functions with 1 COMPLEX8 vector input to 1 REAL4 vector output (C2S) ----------
+#define DEFINE_VECTORMATH_C2S(NAME, AVX_OP)                             \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_C2S_AVXx, NAME ## COMPLEX8, ( REAL4 *out, const COMPLEX8 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, AVX_OP ) )
+
+DEFINE_VECTORMATH_C2S(Abs2, local_cabs2_ps)
+
 // ---------- define vector math functions with 1 REAL8 vector input to 1 REAL8 vector output (D2D) ----------
 #define DEFINE_VECTORMATH_D2D(NAME, AVX_OP)                             \
   DEFINE_VECTORMATH_ANY( XLALVectorMath_D2D_AVXx, NAME ## REAL8, ( REAL8 *out, const REAL8 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, AVX_OP ) )
 
 DEFINE_VECTORMATH_D2D(Round, local_round_pd)
+
+#ifdef __AVX2__
+
+DEFINE_VECTORMATH_D2D(Sin, pd_sin)
+DEFINE_VECTORMATH_D2D(Cos, pd_cos)
+DEFINE_VECTORMATH_D2D(Exp, pd_exp)
+DEFINE_VECTORMATH_D2D(Log, pd_log)
+
+// ---------- define vector math functions with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+#define DEFINE_VECTORMATH_D2DD(NAME, AVX_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_D2DD_AVXx, NAME ## REAL8, ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len ), ( (out1 != NULL) && (out2 != NULL) && (in != NULL) ), ( out1, out2, in, len, AVX_OP ) )
+
+DEFINE_VECTORMATH_D2DD(SinCos, pd_sincos)
+DEFINE_VECTORMATH_D2DD(SinCos2Pi, pd_sincos_2pi)
+
+#endif // __AVX2__
+
+// ---------- define vector math functions with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+#define DEFINE_VECTORMATH_ZZ2Z(NAME, AVX_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_ZZ2Z_AVXx, NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, AVX_OP ) )
+
+DEFINE_VECTORMATH_ZZ2Z(Multiply, local_cmul_pd)
+DEFINE_VECTORMATH_ZZ2Z(MultiplyConj, local_cmulconj_pd)
+
+// ---------- define vector math functions with 1 COMPLEX16 vector input to 1 REAL8 vector output (Z2D) ----------
+#define DEFINE_VECTORMATH_Z2D(NAME, AVX_OP)                             \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_Z2D_AVXx, NAME ## COMPLEX16, ( REAL8 *out, const COMPLEX16 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, AVX_OP ) )
+
+DEFINE_VECTORMATH_Z2D(Abs2, local_cabs2_pd)
+
+// ---------- define vector math functions with 2 COMPLEX16 vector inputs to 1 COMPLEX16 scalar output (ZZ2z) ----------
+#define DEFINE_VECTORMATH_ZZ2z(NAME, AVX_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_ZZ2z_AVXx, NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, AVX_OP ) )
+
+DEFINE_VECTORMATH_ZZ2z(DotConj, local_cmulconj_pd)
+
+#ifdef __AVX2__
+
+// ---------- define weighted inner products of 2 complex vector inputs and 1 real vector input to 1 COMPLEX16 and 1 REAL8 scalar output (ZZD2zd, CCS2zd) ----------
+#define DEFINE_VECTORMATH_ZZD2zd(NAME)                                  \
+  DEFINE_VECTORMATH_ANY( pd_ip_compute, NAME ## COMPLEX16, ( COMPLEX16 *hd, REAL8 *hh, const COMPLEX16 *h, const COMPLEX16 *d, const REAL8 *w, const UINT4 len, const VectorMathSumMethod method ), ( (hd != NULL) && (h != NULL) && (d != NULL) && (w != NULL) ), ( hd, hh, h, d, w, len, method, pd_ip_load_COMPLEX16 ) )
+#define DEFINE_VECTORMATH_CCS2zd(NAME)                                  \
+  DEFINE_VECTORMATH_ANY( pd_ip_compute, NAME ## COMPLEX8, ( COMPLEX16 *hd, REAL8 *hh, const COMPLEX8 *h, const COMPLEX8 *d, const REAL4 *w, const UINT4 len, const VectorMathSumMethod method ), ( (hd != NULL) && (h != NULL) && (d != NULL) && (w != NULL) ), ( hd, hh, h, d, w, len, method, pd_ip_load_COMPLEX8 ) )
+
+DEFINE_VECTORMATH_ZZD2zd(WeightedInnerProduct)
+DEFINE_VECTORMATH_CCS2zd(WeightedInnerProduct)
+
+#endif // __AVX2__
@@ -80,10 +80,68 @@ static inline COMPLEX8 local_caddf ( COMPLEX8 x, COMPLEX8 y )
   return x + y;
 }
 
+static inline void local_sincos(REAL8 in, REAL8 *out1, REAL8 *out2) {
+  *out1 = sin ( in );
+  *out2 = cos ( in );
+}
+
+static inline void local_sincos_2pi(REAL8 in, REAL8 *out1, REAL8 *out2) {
+  // reduce to [-1/2, 1/2] first, so that 2*pi*in does not lose precision for large arguments
+  const REAL8 x = in - round ( in );
+  *out1 = sin ( LAL_TWOPI * x );
+  *out2 = cos ( LAL_TWOPI * x );
+}
+
+static inline COMPLEX16 local_cmul ( COMPLEX16 x, COMPLEX16 y )
+{
+  return x * y;
+}
+
+static inline COMPLEX16 local_cmulconj ( COMPLEX16 x, COMPLEX16 y )
+{
+  return x * conj ( y );
+}
+
+static inline REAL8 local_cabs2 ( COMPLEX16 x )
+{
+  return creal ( x ) * creal ( x ) + cimag ( x ) * cimag ( x );
+}
+
+static inline REAL4 local_cabs2f ( COMPLEX8 x )
+{
+  return crealf ( x ) * crealf ( x ) + cimagf ( x ) * cimagf ( x );
+}
+
+// terms w_i conj(h_i) d_i (real and imaginary parts) and w_i |h_i|^2 of the weighted inner products
+static inline void local_innerprod_COMPLEX16 ( REAL8 t[3], const void *hp, const void *dp, const void *wp, const UINT4 i )
+{
+  const REAL8 hr = creal ( ( (const COMPLEX16 *) hp )[i] ), hi = cimag ( ( (const COMPLEX16 *) hp )[i] );
+  const REAL8 dr = creal ( ( (const COMPLEX16 *) dp )[i] ), di = cimag ( ( (const COMPLEX16 *) dp )[i] );
+  const REAL8 w = ( (const REAL8 *) wp )[i];
+  t[0] = w * ( hr * dr + hi * di );
+  t[1] = w * ( hr * di - hi * dr );
+  t[2] = w * ( hr * hr + hi * hi );
+}
+
+static inline void local_innerprod_COMPLEX8 ( REAL8 t[3], const void *hp, const void *dp, const void *wp, const UINT4 i )
+{
+  const REAL8 hr = crealf ( ( (const COMPLEX8 *) hp )[i] ), hi = cimagf ( ( (const COMPLEX8 *) hp )[i] );
+  const REAL8 dr = crealf ( ( (const COMPLEX8 *) dp )[i] ), di = cimagf ( ( (const COMPLEX8 *) dp )[i] );
+  const REAL8 w = ( (const REAL4 *) wp )[i];
+  t[0] = w * ( hr * dr + hi * di );
+  t[1] = w * ( hr * di - hi * dr );
+  t[2] = w * ( hr * hr + hi * hi );
+}
+
 static inline REAL4 local_fmaxf ( REAL4 x, REAL4 y ) {
   return (x > y) ? x : y;
 }
 
+static inline void local_addmaxf ( REAL4 x, REAL4 y, REAL4 z, REAL4 *out1, REAL4 *out2 ) {
+  *out1 = x + z;
+  *out2 = local_fmaxf ( y, z );
+}
+
 // ========== internal generic functions ==========
 
 // ---------- generic operator with 1 REAL4 vector input to 1 INT4 vector output (S2I) ----------
@@ -130,6 +188,17 @@ XLALVectorMath_SS2S_GEN ( REAL4 *out, const REAL4 *in1, const REAL4 *in2, const
   return XLAL_SUCCESS;
 }
 
+// ---------- generic operator with 3 REAL4 vector inputs to 2 REAL4 vector outputs (SSS2SS) ----------
+static inline int
+XLALVectorMath_SSS2SS_GEN ( REAL4 *out1, REAL4 *out2, const REAL4 *in1, const REAL4 *in2, const REAL4 *in3, const UINT4 len, void (*op)(REAL4, REAL4, REAL4, REAL4*, REAL4*) )
+{
+  for ( UINT4 i = 0; i < len; i ++ )
+    {
+      (*op) ( in1[i], in2[i], in3[i], &(out1[i]), &(out2[i]) );
+    }
+  return XLAL_SUCCESS;
+}
+
 // ---------- generic operator with 1 REAL4 scalar and 1 REAL4 vector inputs to 1 REAL4 vector output (sS2S) ----------
 static inline int
 XLALVectorMath_sS2S_GEN ( REAL4 *out, REAL4 scalar, const REAL4 *in, const UINT4 len, REAL4 (*op)(REAL4, REAL4) )
@@ -196,6 +265,142 @@ XLALVectorMath_D2D_GEN ( REAL8 *out, const REAL8 *in, const UINT4 len, REAL8 (*o
   return XLAL_SUCCESS;
 }
 
+// ---------- generic operator with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+static inline int
+XLALVectorMath_D2DD_GEN ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len, void (*op)(REAL8, REAL8*, REAL8*) )
+{
+  for ( UINT4 i = 0; i < len; i ++ )
+    {
+      (*op) ( in[i], &(out1[i]), &(out2[i]) );
+    }
+  return XLAL_SUCCESS;
+}
+
+// ---------- generic operator with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+static inline int
+XLALVectorMath_ZZ2Z_GEN ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len, COMPLEX16 (*op)(COMPLEX16, COMPLEX16) )
+{
+  for ( UINT4 i = 0; i < len; i ++ )
+    {
+      out[i] = (*op) ( in1[i], in2[i] );
+    }
+  return XLAL_SUCCESS;
+}
+
+// ---------- generic operator with 1 COMPLEX8 vector input to 1 REAL4 vector output (C2S) ----------
+static inline int
+XLALVectorMath_C2S_GEN ( REAL4 *out, const COMPLEX8 *in, const UINT4 len, REAL4 (*op)(COMPLEX8) )
+{
+  for ( UINT4 i = 0; i < len; i ++ )
+    {
+      out[i] = (*op) ( in[i] );
+    }
+  return XLAL_SUCCESS;
+}
+
+// ---------- generic operator with 1 COMPLEX16 vector input to 1 REAL8 vector output (Z2D) ----------
+static inline int
+XLALVectorMath_Z2D_GEN ( REAL8 *out, const COMPLEX16 *in, const UINT4 len, REAL8 (*op)(COMPLEX16) )
+{
+  for ( UINT4 i = 0; i < len; i ++ )
+    {
+      out[i] = (*op) ( in[i] );
+    }
+  return XLAL_SUCCESS;
+}
+
+// ---------- generic operator with 2 COMPLEX16 vector inputs summed to 1 COMPLEX16 scalar output (ZZ2z) ----------
+static inline int
+XLALVectorMath_ZZ2z_GEN ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len, COMPLEX16 (*op)(COMPLEX16, COMPLEX16) )
+{
+  COMPLEX16 sum = 0;
+  for ( UINT4 i = 0; i < len; i ++ )
+    {
+      sum += (*op) ( in1[i], in2[i] );
+    }
+  (*out) = sum;
+  return XLAL_SUCCESS;
+}
+
+// ---------- generic weighted inner products of 2 complex vector inputs and 1 real vector input to 1 COMPLEX16 and 1 REAL8 scalar output (ZZD2zd, CCS2zd) ----------
+#define GEN_IP_PAIRWISE_BLOCK 128
+
+static inline void
+XLALVectorMath_IP_direct_GEN ( REAL8 s[3], const void *h, const void *d, const void *w, const UINT4 i0, const UINT4 n, void (*op)(REAL8[3], const void*, const void*, const void*, const UINT4) )
+{
+  REAL8 t[3];
+  s[0] = s[1] = s[2] = 0;
+  for ( UINT4 i = i0; i < i0 + n; i ++ )
+    {
+      (*op) ( t, h, d, w, i );
+      for ( UINT4 k = 0; k < 3; k ++ ) {
+        s[k] += t[k];
+      }
+    }
+}
+
+static inline int
+XLALVectorMath_IP_GEN ( COMPLEX16 *hd, REAL8 *hh, const void *h, const void *d, const void *w, const UINT4 len, const VectorMathSumMethod method, void (*op)(REAL8[3], const void*, const void*, const void*, const UINT4) )
+{
+  REAL8 s[3] = { 0, 0, 0 };
+  switch ( method )
+    {
+    case VECTORMATH_SUM_DIRECT:
+      XLALVectorMath_IP_direct_GEN ( s, h, d, w, 0, len, op );
+      break;
+
+    case VECTORMATH_SUM_KAHAN:
+      {
+        REAL8 t[3], e[3] = { 0, 0, 0 };
+        for ( UINT4 i = 0; i < len; i ++ )
+          {
+            (*op) ( t, h, d, w, i );
+            for ( UINT4 k = 0; k < 3; k ++ ) {
+              const REAL8 y = t[k] - e[k];
+              const REAL8 u = s[k] + y;
+              e[k] = ( u - s[k] ) - y;
+              s[k] = u;
+            }
+          }
+      }
+      break;
+
+    case VECTORMATH_SUM_PAIRWISE:
+      {
+        // stack of partial sums of 2^m blocks, with m decreasing up the stack
+        REAL8 part[33][3];
+        UINT4 top = 0;
+        for ( UINT4 b = 0, i = 0; i < len; b ++, i += GEN_IP_PAIRWISE_BLOCK )
+          {
+            const UINT4 n = ( len - i < GEN_IP_PAIRWISE_BLOCK ) ? len - i : GEN_IP_PAIRWISE_BLOCK;
+            XLALVectorMath_IP_direct_GEN ( part[top++], h, d, w, i, n, op );
+            for ( UINT4 bb = b; bb & 1; bb >>= 1 ) {
+              top --;
+              for ( UINT4 k = 0; k < 3; k ++ ) {
+                part[top-1][k] += part[top][k];
+              }
+            }
+          }
+        while ( top > 0 )
+          {
+            top --;
+            for ( UINT4 k = 0; k < 3; k ++ ) {
+              s[k] += part[top][k];
+            }
+          }
+      }
+      break;
+
+    default:
+      XLAL_ERROR ( XLAL_EINVAL, "Invalid summation method %i", method );
+    }
+  (*hd) = crect ( s[0], s[1] );
+  if ( hh != NULL ) {
+    (*hh) = s[2];
+  }
+  return XLAL_SUCCESS;
+}
+
 // ========== internal vector math functions ==========
 
 // ---------- define vector math functions with 1 REAL4 vector input to 1 INT4 vector output (S2I) ----------
@@ -230,6 +435,12 @@ DEFINE_VECTORMATH_SS2S(Sub, local_subf)
 DEFINE_VECTORMATH_SS2S(Multiply, local_mulf)
 DEFINE_VECTORMATH_SS2S(Max, local_fmaxf)
 
+// ---------- define vector math functions with 3 REAL4 vector inputs to 2 REAL4 vector outputs (SSS2SS) ----------
+#define DEFINE_VECTORMATH_SSS2SS(NAME, GEN_OP)                          \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_SSS2SS_GEN, NAME ## REAL4, ( REAL4 *out1, REAL4 *out2, const REAL4 *in1, const REAL4 *in2, const REAL4 *in3, const UINT4 len ), ( (out1 != NULL) && (out2 != NULL) && (in1 != NULL) && (in2 != NULL) && (in3 != NULL) ), ( out1, out2, in1, in2, in3, len, GEN_OP ) )
+
+DEFINE_VECTORMATH_SSS2SS(AddMax, local_addmaxf)
+
 // ---------- define vector math functions with 1 REAL4 scalar and 1 REAL4 vector inputs to 1 REAL4 vector output (sS2S) ----------
 #define DEFINE_VECTORMATH_sS2S(NAME, GEN_OP)                            \
   DEFINE_VECTORMATH_ANY( XLALVectorMath_sS2S_GEN, NAME ## REAL4, ( REAL4 *out, REAL4 scalar, const REAL4 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, scalar, in, len, GEN_OP ) )
@@ -267,8 +478,53 @@ DEFINE_VECTORMATH_CC2C(Add, local_caddf)
 DEFINE_VECTORMATH_cC2C(Scale, local_cmulf)
 DEFINE_VECTORMATH_cC2C(Shift, local_caddf)
 
+// ---------- define vector math functions with 1 COMPLEX8 vector input to 1 REAL4 vector output (C2S) ----------
+#define DEFINE_VECTORMATH_C2S(NAME, GEN_OP)                             \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_C2S_GEN, NAME ## COMPLEX8, ( REAL4 *out, const COMPLEX8 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, GEN_OP ) )
+
+DEFINE_VECTORMATH_C2S(Abs2, local_cabs2f)
+
 // ---------- define vector math functions with 1 REAL8 vector input to 1 REAL8 vector output (D2D) ----------
 #define DEFINE_VECTORMATH_D2D(NAME, GEN_OP)                             \
   DEFINE_VECTORMATH_ANY( XLALVectorMath_D2D_GEN, NAME ## REAL8, ( REAL8 *out, const REAL8 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, GEN_OP ) )
 
+DEFINE_VECTORMATH_D2D(Sin, sin)
+DEFINE_VECTORMATH_D2D(Cos, cos)
+DEFINE_VECTORMATH_D2D(Exp, exp)
+DEFINE_VECTORMATH_D2D(Log, log)
 DEFINE_VECTORMATH_D2D(Round, round)
+
+// ---------- define vector math functions with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+#define DEFINE_VECTORMATH_D2DD(NAME, GEN_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_D2DD_GEN, NAME ## REAL8, ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len ), ( (out1 != NULL) && (out2 != NULL) && (in != NULL) ), ( out1, out2, in, len, GEN_OP ) )
+
+DEFINE_VECTORMATH_D2DD(SinCos, local_sincos)
+DEFINE_VECTORMATH_D2DD(SinCos2Pi, local_sincos_2pi)
+
+// ---------- define vector math functions with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+#define DEFINE_VECTORMATH_ZZ2Z(NAME, GEN_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_ZZ2Z_GEN, NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, GEN_OP ) )
+
+DEFINE_VECTORMATH_ZZ2Z(Multiply, local_cmul)
+DEFINE_VECTORMATH_ZZ2Z(MultiplyConj, local_cmulconj)
+
+// ---------- define vector math functions with 1 COMPLEX16 vector input to 1 REAL8 vector output (Z2D) ----------
+#define DEFINE_VECTORMATH_Z2D(NAME, GEN_OP)                             \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_Z2D_GEN, NAME ## COMPLEX16, ( REAL8 *out, const COMPLEX16 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, GEN_OP ) )
+
+DEFINE_VECTORMATH_Z2D(Abs2, local_cabs2)
+
+// ---------- define vector math functions with 2 COMPLEX16 vector inputs to 1 COMPLEX16 scalar output (ZZ2z) ----------
+#define DEFINE_VECTORMATH_ZZ2z(NAME, GEN_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_ZZ2z_GEN, NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, GEN_OP ) )
+
+DEFINE_VECTORMATH_ZZ2z(DotConj, local_cmulconj)
+
+// ---------- define weighted inner products of 2 complex vector inputs and 1 real vector input to 1 COMPLEX16 and 1 REAL8 scalar output (ZZD2zd, CCS2zd) ----------
+#define DEFINE_VECTORMATH_ZZD2zd(NAME)                                  \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_IP_GEN, NAME ## COMPLEX16, ( COMPLEX16 *hd, REAL8 *hh, const COMPLEX16 *h, const COMPLEX16 *d, const REAL8 *w, const UINT4 len, const VectorMathSumMethod method ), ( (hd != NULL) && (h != NULL) && (d != NULL) && (w != NULL) ), ( hd, hh, h, d, w, len, method, local_innerprod_COMPLEX16 ) )
+#define DEFINE_VECTORMATH_CCS2zd(NAME)                                  \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_IP_GEN, NAME ## COMPLEX8, ( COMPLEX16 *hd, REAL8 *hh, const COMPLEX8 *h, const COMPLEX8 *d, const REAL4 *w, const UINT4 len, const VectorMathSumMethod method ), ( (hd != NULL) && (h != NULL) && (d != NULL) && (w != NULL) ), ( hd, hh, h, d, w, len, method, local_innerprod_COMPLEX8 ) )
+
+DEFINE_VECTORMATH_ZZD2zd(WeightedInnerProduct)
+DEFINE_VECTORMATH_CCS2zd(WeightedInnerProduct)
@@ -36,6 +36,40 @@
 
 #include "VectorMath_sse_mathfun.h"
 
+// ---------- double-precision operations used by VectorMath_pd_mathfun.h ----------
+#define V_PD                    __m128d
+#define V_PD_LEN                2
+#define V_MASK                  __m128d
+#define PD_SET1(x)              _mm_set1_pd ( x )
+#define PD_LOADU(p)             _mm_loadu_pd ( p )
+#define PD_STOREU(p,a)          _mm_storeu_pd ( p, a )
+#define PD_ADD(a,b)             _mm_add_pd ( a, b )
+#define PD_SUB(a,b)             _mm_sub_pd ( a, b )
+#define PD_MUL(a,b)             _mm_mul_pd ( a, b )
+#define PD_DIV(a,b)             _mm_div_pd ( a, b )
+#define PD_AND(a,b)             _mm_and_pd ( a, b )
+#define PD_OR(a,b)              _mm_or_pd ( a, b )
+#define PD_XOR(a,b)             _mm_xor_pd ( a, b )
+#define PD_SRLI64(a,n)          _mm_castsi128_pd ( _mm_srli_epi64 ( _mm_castpd_si128 ( a ), n ) )
+#define PD_SLLI64(a,n)          _mm_castsi128_pd ( _mm_slli_epi64 ( _mm_castpd_si128 ( a ), n ) )
+#define PD_CMPLT(a,b)           _mm_cmplt_pd ( a, b )
+#define PD_CMPLE(a,b)           _mm_cmple_pd ( a, b )
+#define PD_CMPEQ(a,b)           _mm_cmpeq_pd ( a, b )
+#define PD_CMPUNORD(a,b)        _mm_cmpunord_pd ( a, b )
+#define PD_SELECT(m,a,b)        _mm_or_pd ( _mm_and_pd ( m, a ), _mm_andnot_pd ( m, b ) )
+#define MASK_OR(m1,m2)          _mm_or_pd ( m1, m2 )
+#define MASK_ANY(m)             _mm_movemask_pd ( m )
+
+#include "VectorMath_pd_mathfun.h"
+
+// ---------- double-precision operations used by VectorMath_pd_innerprod.h ----------
+#define PD_SWAP_PAIRS(a)        _mm_shuffle_pd ( a, a, 1 )
+#define PD_LOADDUP(p)           _mm_load1_pd ( p )
+#define PD_LOADU_PS(p)          _mm_cvtps_pd ( _mm_castsi128_ps ( _mm_loadl_epi64 ( (const __m128i *) (p) ) ) )
+#define PD_LOADDUP_PS(p)        _mm_cvtps_pd ( _mm_load1_ps ( p ) )
+
+#include "VectorMath_pd_innerprod.h"
+
 // ---------- local operators and operator-wrappers ----------
 UNUSED static inline __m128i
 local_cast_to_INT4 ( __m128 in1 )
@@ -67,6 +101,13 @@ local_max_ps ( __m128 in1, __m128 in2 )
   return _mm_max_ps ( in1, in2 );
 }
 
+UNUSED static inline void
+local_addmax_ps ( __m128 in1, __m128 in2, __m128 in3, __m128 *out1, __m128 *out2 )
+{
+  (*out1) = _mm_add_ps ( in1, in3 );
+  (*out2) = _mm_max_ps ( in2, in3 );
+}
+
 UNUSED static inline __m128d
 local_add_pd ( __m128d in1, __m128d in2 )
 {
@@ -118,6 +159,52 @@ local_cmul_ps ( __m128 in1, __m128 in2 )
   return _mm_shuffle_ps(result, result,0b11011000);
 }
 
+// in1: a,b, in2: c,d (one COMPLEX16 each); returns ac-bd, bc+ad
+UNUSED static inline __m128d
+local_cmul_pd ( __m128d in1, __m128d in2 )
+{
+  const __m128d neg0 = _mm_setr_pd ( -0.0, 0.0 );
+  __m128d re2 = _mm_unpacklo_pd ( in2, in2 );           // c,c
+  __m128d im2 = _mm_unpackhi_pd ( in2, in2 );           // d,d
+  __m128d swp1 = _mm_shuffle_pd ( in1, in1, 0x1 );      // b,a
+  __m128d t1 = _mm_mul_pd ( in1, re2 );                 // ac,bc
+  __m128d t2 = _mm_mul_pd ( swp1, im2 );                // bd,ad
+  return _mm_add_pd ( t1, _mm_xor_pd ( t2, neg0 ) );
+}
+
+// in1: a,b, in2: c,d (one COMPLEX16 each); returns ac+bd, bc-ad
+UNUSED static inline __m128d
+local_cmulconj_pd ( __m128d in1, __m128d in2 )
+{
+  const __m128d neg1 = _mm_setr_pd ( 0.0, -0.0 );
+  __m128d re2 = _mm_unpacklo_pd ( in2, in2 );           // c,c
+  __m128d im2 = _mm_unpackhi_pd ( in2, in2 );           // d,d
+  __m128d swp1 = _mm_shuffle_pd ( in1, in1, 0x1 );      // b,a
+  __m128d t1 = _mm_mul_pd ( in1, re2 );                 // ac,bc
+  __m128d t2 = _mm_mul_pd ( swp1, im2 );                // bd,ad
+  return _mm_add_pd ( t1, _mm_xor_pd ( t2, neg1 ) );
+}
+
+// in1: z0,z1, in2: z2,z3 (two COMPLEX8 each); returns |z0|^2, |z1|^2, |z2|^2, |z3|^2
+UNUSED static inline __m128
+local_cabs2_ps ( __m128 in1, __m128 in2 )
+{
+  __m128 sq1 = _mm_mul_ps ( in1, in1 );
+  __m128 sq2 = _mm_mul_ps ( in2, in2 );
+  __m128 re2 = _mm_shuffle_ps ( sq1, sq2, _MM_SHUFFLE(2,0,2,0) );
+  __m128 im2 = _mm_shuffle_ps ( sq1, sq2, _MM_SHUFFLE(3,1,3,1) );
+  return _mm_add_ps ( re2, im2 );
+}
+
+// in1: a0,b0, in2: a1,b1 (one COMPLEX16 each); returns a0^2+b0^2, a1^2+b1^2
+UNUSED static inline __m128d
+local_cabs2_pd ( __m128d in1, __m128d in2 )
+{
+  __m128d sq1 = _mm_mul_pd ( in1, in1 );
+  __m128d sq2 = _mm_mul_pd ( in2, in2 );
+  return _mm_add_pd ( _mm_unpacklo_pd ( sq1, sq2 ), _mm_unpackhi_pd ( sq1, sq2 ) );
+}
+
 // ========== internal generic SSEx functions ==========
 
 // ---------- generic SSEx operator with 1 REAL4 vector input to 1 INT4 vector output (S2I) ----------
@@ -239,6 +326,44 @@ XLALVectorMath_SS2S_SSEx ( REAL4 *out, const REAL4 *in1, const REAL4 *in2, const
 
 } // XLALVectorMath_SS2S_SSEx()
 
+// ---------- generic SSEx operator with 3 REAL4 vector inputs to 2 REAL4 vector outputs (SSS2SS) ----------
+static inline int
+XLALVectorMath_SSS2SS_SSEx ( REAL4 *out1, REAL4 *out2, const REAL4 *in1, const REAL4 *in2, const REAL4 *in3, const UINT4 len, void (*op)(__m128, __m128, __m128, __m128*, __m128*) )
+{
+
+  // walk through vector in blocks of 4
+  UINT4 i4Max = len - ( len % 4 );
+  for ( UINT4 i4 = 0; i4 < i4Max; i4 += 4 )
+    {
+      __m128 in4p_1 = _mm_loadu_ps(&in1[i4]);
+      __m128 in4p_2 = _mm_loadu_ps(&in2[i4]);
+      __m128 in4p_3 = _mm_loadu_ps(&in3[i4]);
+      __m128 out4p_1, out4p_2;
+      (*op) ( in4p_1, in4p_2, in4p_3, &out4p_1, &out4p_2 );
+      _mm_storeu_ps(&out1[i4], out4p_1);
+      _mm_storeu_ps(&out2[i4], out4p_2);
+    }
+
+  // deal with the remaining (<=3) terms separately
+  V4SF in4_1 = {.f={0,0,0,0}};
+  V4SF in4_2 = {.f={0,0,0,0}};
+  V4SF in4_3 = {.f={0,0,0,0}};
+  V4SF out4_1, out4_2;
+  for ( UINT4 i = i4Max,j=0; i < len; i ++, j++ ) {
+    in4_1.f[j] = in1[i];
+    in4_2.f[j] = in2[i];
+    in4_3.f[j] = in3[i];
+  }
+  (*op) ( in4_1.v, in4_2.v, in4_3.v, &out4_1.v, &out4_2.v );
+  for ( UINT4 i = i4Max,j=0; i < len; i ++, j++ ) {
+    out1[i] = out4_1.f[j];
+    out2[i] = out4_2.f[j];
+  }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_SSS2SS_SSEx()
+
 // ---------- generic SSEx operator with 1 REAL4 scalar and 1 REAL4 vector inputs to 1 REAL4 vector output (sS2S) ----------
 static inline int
 XLALVectorMath_sS2S_SSEx ( REAL4 *out, REAL4 scalar, const REAL4 *in, const UINT4 len, __m128 (*op)(__m128, __m128) )
@@ -368,6 +493,41 @@ XLALVectorMath_CC2C_SSEx ( COMPLEX8 *out, const COMPLEX8 *in1, const COMPLEX8 *i
 
 } // XLALVectorMath_CC2C_SSEx()
 
+// ---------- generic SSEx operator with 1 COMPLEX8 vector input to 1 REAL4 vector output (C2S) ----------
+static inline int
+XLALVectorMath_C2S_SSEx ( REAL4 *out, const COMPLEX8 *in, const UINT4 len, __m128 (*op)(__m128, __m128) )
+{
+
+  // walk through vector in blocks of 4
+  UINT4 i4Max = len - ( len % 4 );
+  for ( UINT4 i4 = 0; i4 < i4Max; i4 += 4 )
+    {
+      __m128 in4p_1 = _mm_loadu_ps( (const REAL4*)&in[i4] );
+      __m128 in4p_2 = _mm_loadu_ps( (const REAL4*)&in[i4+2] );
+      __m128 out4p = (*op) ( in4p_1, in4p_2 );
+      _mm_storeu_ps( &out[i4], out4p );
+    }
+
+  // deal with the remaining (<=3) terms separately
+  V4SF in4_1 = {.f={0,0,0,0}};
+  V4SF in4_2 = {.f={0,0,0,0}};
+  V4SF out4;
+  for ( UINT4 i = i4Max,j=0; i < len; i ++, j+=2 )
+    {
+      V4SF *in4 = ( j < 4 ) ? &in4_1 : &in4_2;
+      in4->f[j % 4] = crealf ( in[i] );
+      in4->f[j % 4 + 1] = cimagf ( in[i] );
+    }
+  out4.v = (*op) ( in4_1.v, in4_2.v );
+  for ( UINT4 i = i4Max,j=0; i < len; i ++, j++ )
+    {
+      out[i] = out4.f[j];
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_C2S_SSEx()
+
 // ---------- generic SSEx operator with 1 COMPLEX8 scalar and 1 COMPLEX8 vector inputs to 1 COMPLEX8 vector output (cC2C) ----------
 static inline int
 XLALVectorMath_cC2C_SSEx ( COMPLEX8 *out, COMPLEX8 scalar, const COMPLEX8 *in, const UINT4 len, __m128 (*op)(__m128, __m128) )
@@ -401,6 +561,132 @@ XLALVectorMath_cC2C_SSEx ( COMPLEX8 *out, COMPLEX8 scalar, const COMPLEX8 *in, c
 
 } // XLALVectorMath_cC2C_SSEx()
 
+// ---------- generic SSEx operator with 1 REAL8 vector input to 1 REAL8 vector output (D2D) ----------
+static inline int
+XLALVectorMath_D2D_SSEx ( REAL8 *out, const REAL8 *in, const UINT4 len, __m128d (*f)(__m128d) )
+{
+
+  // walk through vector in blocks of 2
+  UINT4 i2Max = len - ( len % 2 );
+  for ( UINT4 i2 = 0; i2 < i2Max; i2 += 2 )
+    {
+      __m128d in2p = _mm_loadu_pd(&in[i2]);
+      __m128d out2p = (*f)( in2p );
+      _mm_storeu_pd(&out[i2], out2p);
+    }
+
+  // deal with the remaining (<=1) terms separately
+  V2SF in2 = {.f={0,0}}, out2;
+  for ( UINT4 i = i2Max,j=0; i < len; i ++, j++ ) {
+    in2.f[j] = in[i];
+  }
+  out2.v = (*f)( in2.v );
+  for ( UINT4 i = i2Max,j=0; i < len; i ++, j++ ) {
+    out[i] = out2.f[j];
+  }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_D2D_SSEx()
+
+// ---------- generic SSEx operator with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+static inline int
+XLALVectorMath_D2DD_SSEx ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len, void (*f)(__m128d, __m128d*, __m128d*) )
+{
+
+  // walk through vector in blocks of 2
+  UINT4 i2Max = len - ( len % 2 );
+  for ( UINT4 i2 = 0; i2 < i2Max; i2 += 2 )
+    {
+      __m128d in2p = _mm_loadu_pd(&in[i2]);
+      __m128d out2p_1, out2p_2;
+      (*f) ( in2p, &out2p_1, &out2p_2 );
+      _mm_storeu_pd(&out1[i2], out2p_1);
+      _mm_storeu_pd(&out2[i2], out2p_2);
+    }
+
+  // deal with the remaining (<=1) terms separately
+  V2SF in2 = {.f={0,0}}, out2_1, out2_2;
+  for ( UINT4 i = i2Max,j=0; i < len; i ++, j++ ) {
+    in2.f[j] = in[i];
+  }
+  (*f) ( in2.v, &out2_1.v, &out2_2.v );
+  for ( UINT4 i = i2Max,j=0; i < len; i ++, j++ ) {
+    out1[i] = out2_1.f[j];
+    out2[i] = out2_2.f[j];
+  }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_D2DD_SSEx()
+
+// ---------- generic SSEx operator with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+static inline int
+XLALVectorMath_ZZ2Z_SSEx ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len, __m128d (*op)(__m128d, __m128d) )
+{
+
+  // one COMPLEX16 fills a register, so there are no remaining terms
+  for ( UINT4 i = 0; i < len; i ++ )
+    {
+      __m128d in2p_1 = _mm_loadu_pd( (const REAL8*)&in1[i] );
+      __m128d in2p_2 = _mm_loadu_pd( (const REAL8*)&in2[i] );
+      __m128d out2p = (*op) ( in2p_1, in2p_2 );
+      _mm_storeu_pd( (REAL8*)&out[i], out2p );
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_ZZ2Z_SSEx()
+
+// ---------- generic SSEx operator with 1 COMPLEX16 vector input to 1 REAL8 vector output (Z2D) ----------
+static inline int
+XLALVectorMath_Z2D_SSEx ( REAL8 *out, const COMPLEX16 *in, const UINT4 len, __m128d (*op)(__m128d, __m128d) )
+{
+
+  // walk through vector in blocks of 2
+  UINT4 i2Max = len - ( len % 2 );
+  for ( UINT4 i2 = 0; i2 < i2Max; i2 += 2 )
+    {
+      __m128d in2p_1 = _mm_loadu_pd( (const REAL8*)&in[i2] );
+      __m128d in2p_2 = _mm_loadu_pd( (const REAL8*)&in[i2+1] );
+      __m128d out2p = (*op) ( in2p_1, in2p_2 );
+      _mm_storeu_pd( &out[i2], out2p );
+    }
+
+  // deal with the remaining (<=1) terms separately
+  if ( i2Max < len )
+    {
+      __m128d in2p_1 = _mm_loadu_pd( (const REAL8*)&in[i2Max] );
+      V2SF out2;
+      out2.v = (*op) ( in2p_1, _mm_setzero_pd() );
+      out[i2Max] = out2.f[0];
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_Z2D_SSEx()
+
+// ---------- generic SSEx operator with 2 COMPLEX16 vector inputs summed to 1 COMPLEX16 scalar output (ZZ2z) ----------
+static inline int
+XLALVectorMath_ZZ2z_SSEx ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len, __m128d (*op)(__m128d, __m128d) )
+{
+  V2SF sum2;
+  sum2.v = _mm_setzero_pd();
+
+  // one COMPLEX16 fills a register, so there are no remaining terms
+  for ( UINT4 i = 0; i < len; i ++ )
+    {
+      __m128d in2p_1 = _mm_loadu_pd( (const REAL8*)&in1[i] );
+      __m128d in2p_2 = _mm_loadu_pd( (const REAL8*)&in2[i] );
+      sum2.v = _mm_add_pd ( sum2.v, (*op) ( in2p_1, in2p_2 ) );
+    }
+
+  (*out) = crect( sum2.f[0], sum2.f[1] );
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_ZZ2z_SSEx()
+
 // ========== internal SSEx vector math functions ==========
 
 // ---------- define vector math functions with 1 REAL4 vector input to 1 INT4 vector output (S2I) ----------
@@ -434,6 +720,12 @@ DEFINE_VECTORMATH_SS2S(Sub, local_sub_ps)
 DEFINE_VECTORMATH_SS2S(Multiply, local_mul_ps)
 DEFINE_VECTORMATH_SS2S(Max, local_max_ps)
 
+// ---------- define vector math functions with 3 REAL4 vector inputs to 2 REAL4 vector outputs (SSS2SS) ----------
+#define DEFINE_VECTORMATH_SSS2SS(NAME, SSE_OP)                          \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_SSS2SS_SSEx, NAME ## REAL4, ( REAL4 *out1, REAL4 *out2, const REAL4 *in1, const REAL4 *in2, const REAL4 *in3, const UINT4 len ), ( (out1 != NULL) && (out2 != NULL) && (in1 != NULL) && (in2 != NULL) && (in3 != NULL) ), ( out1, out2, in1, in2, in3, len, SSE_OP ) )
+
+DEFINE_VECTORMATH_SSS2SS(AddMax, local_addmax_ps)
+
 // ---------- define vector math functions with 1 REAL4 scalar and 1 REAL4 vector inputs to 1 REAL4 vector output (sS2S) ----------
 #define DEFINE_VECTORMATH_sS2S(NAME, SSE_OP)                            \
   DEFINE_VECTORMATH_ANY( XLALVectorMath_sS2S_SSEx, NAME ## REAL4, ( REAL4 *out, REAL4 scalar, const REAL4 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, scalar, in, len, SSE_OP ) )
@@ -469,3 +761,53 @@ DEFINE_VECTORMATH_CC2C(Add, local_add_ps)
 
 DEFINE_VECTORMATH_cC2C(Scale, local_cmul_ps)
 DEFINE_VECTORMATH_cC2C(Shift, local_add_ps)
+
+// ---------- define vector math functions with 1 COMPLEX8 vector input to 1 REAL4 vector output (C2S) ----------
+#define DEFINE_VECTORMATH_C2S(NAME, SSE_OP)                             \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_C2S_SSEx, NAME ## COMPLEX8, ( REAL4 *out, const COMPLEX8 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, SSE_OP ) )
+
+DEFINE_VECTORMATH_C2S(Abs2, local_cabs2_ps)
+
+// ---------- define vector math functions with 1 REAL8 vector input to 1 REAL8 vector output (D2D) ----------
+#define DEFINE_VECTORMATH_D2D(NAME, SSE_OP)                             \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_D2D_SSEx, NAME ## REAL8, ( REAL8 *out, const REAL8 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, SSE_OP ) )
+
+DEFINE_VECTORMATH_D2D(Sin, pd_sin)
+DEFINE_VECTORMATH_D2D(Cos, pd_cos)
+DEFINE_VECTORMATH_D2D(Exp, pd_exp)
+DEFINE_VECTORMATH_D2D(Log, pd_log)
+
+// ---------- define vector math functions with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+#define DEFINE_VECTORMATH_D2DD(NAME, SSE_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_D2DD_SSEx, NAME ## REAL8, ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len ), ( (out1 != NULL) && (out2 != NULL) && (in != NULL) ), ( out1, out2, in, len, SSE_OP ) )
+
+DEFINE_VECTORMATH_D2DD(SinCos, pd_sincos)
+DEFINE_VECTORMATH_D2DD(SinCos2Pi, pd_sincos_2pi)
+
+// ---------- define vector math functions with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+#define DEFINE_VECTORMATH_ZZ2Z(NAME, SSE_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_ZZ2Z_SSEx, NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, SSE_OP ) )
+
+DEFINE_VECTORMATH_ZZ2Z(Multiply, local_cmul_pd)
+DEFINE_VECTORMATH_ZZ2Z(MultiplyConj, local_cmulconj_pd)
+
+// ---------- define vector math functions with 1 COMPLEX16 vector input to 1 REAL8 vector output (Z2D) ----------
+#define DEFINE_VECTORMATH_Z2D(NAME, SSE_OP)                             \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_Z2D_SSEx, NAME ## COMPLEX16, ( REAL8 *out, const COMPLEX16 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, SSE_OP ) )
+
+DEFINE_VECTORMATH_Z2D(Abs2, local_cabs2_pd)
+
+// ---------- define vector math functions with 2 COMPLEX16 vector inputs to 1 COMPLEX16 scalar output (ZZ2z) ----------
+#define DEFINE_VECTORMATH_ZZ2z(NAME, SSE_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_ZZ2z_SSEx, NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, SSE_OP ) )
+
+DEFINE_VECTORMATH_ZZ2z(DotConj, local_cmulconj_pd)
+
+// ---------- define weighted inner products of 2 complex vector inputs and 1 real vector input to 1 COMPLEX16 and 1 REAL8 scalar output (ZZD2zd, CCS2zd) ----------
+#define DEFINE_VECTORMATH_ZZD2zd(NAME)                                  \
+  DEFINE_VECTORMATH_ANY( pd_ip_compute, NAME ## COMPLEX16, ( COMPLEX16 *hd, REAL8 *hh, const COMPLEX16 *h, const COMPLEX16 *d, const REAL8 *w, const UINT4 len, const VectorMathSumMethod method ), ( (hd != NULL) && (h != NULL) && (d != NULL) && (w != NULL) ), ( hd, hh, h, d, w, len, method, pd_ip_load_COMPLEX16 ) )
+#define DEFINE_VECTORMATH_CCS2zd(NAME)                                  \
+  DEFINE_VECTORMATH_ANY( pd_ip_compute, NAME ## COMPLEX8, ( COMPLEX16 *hd, REAL8 *hh, const COMPLEX8 *h, const COMPLEX8 *d, const REAL4 *w, const UINT4 len, const VectorMathSumMethod method ), ( (hd != NULL) && (h != NULL) && (d != NULL) && (w != NULL) ), ( hd, hh, h, d, w, len, method, pd_ip_load_COMPLEX8 ) )
+
+DEFINE_VECTORMATH_ZZD2zd(WeightedInnerProduct)
+DEFINE_VECTORMATH_CCS2zd(WeightedInnerProduct)
@@ -81,6 +81,12 @@ DECLARE_VECTORMATH_SS2S(Sub, AVX2, AVX, SSE2, NONE)
 DECLARE_VECTORMATH_SS2S(Multiply, AVX2, AVX, SSE2, NONE)
 DECLARE_VECTORMATH_SS2S(Max, AVX2, AVX, SSE2, NONE)
 
+/* declare internal prototypes of SIMD-specific vector math functions with 3 REAL4 vector inputs to 2 REAL4 vector outputs (SSS2SS) */
+#define DECLARE_VECTORMATH_SSS2SS(NAME, ...)                                 \
+  DECLARE_VECTORMATH_ANY( NAME ## REAL4, ( REAL4 *out1, REAL4 *out2, const REAL4 *in1, const REAL4 *in2, const REAL4 *in3, const UINT4 len ), __VA_ARGS__ )
+
+DECLARE_VECTORMATH_SSS2SS(AddMax, AVX2, AVX, SSE2, NONE)
+
 /* declare internal prototypes of SIMD-specific vector math functions with 1 REAL4 scalar and 1 REAL4 vector input to 1 REAL4 vector output (sS2S) */
 #define DECLARE_VECTORMATH_sS2S(NAME, ...) \
   DECLARE_VECTORMATH_ANY( NAME ## REAL4, ( REAL4 *out, REAL4 scalar, const REAL4 *in, const UINT4 len ), __VA_ARGS__ )
@@ -131,8 +137,53 @@ DECLARE_VECTORMATH_CC2C(Add, AVX2, AVX, SSE2, NONE)
 DECLARE_VECTORMATH_cC2C(Scale, AVX2, AVX, SSE2, NONE)
 DECLARE_VECTORMATH_cC2C(Shift, AVX2, AVX, SSE2, NONE)
 
+/* declare internal prototypes of SIMD-specific vector math functions with 1 COMPLEX8 vector input to 1 REAL4 vector output (C2S) */
+#define DECLARE_VECTORMATH_C2S(NAME, ...)                                    \
+  DECLARE_VECTORMATH_ANY( NAME ## COMPLEX8, ( REAL4 *out, const COMPLEX8 *in, const UINT4 len ), __VA_ARGS__ )
+
+DECLARE_VECTORMATH_C2S(Abs2, AVX2, AVX, SSE2, NONE)
+
 /* declare internal prototypes of SIMD-specific vector math functions with 1 REAL8 vector input to 1 REAL8 vector output (D2D) */
 #define DECLARE_VECTORMATH_D2D(NAME, ...)                                    \
   DECLARE_VECTORMATH_ANY( NAME ## REAL8, ( REAL8 *out, const REAL8 *in, const UINT4 len ), __VA_ARGS__ )
 
+DECLARE_VECTORMATH_D2D(Sin, AVX512F, AVX2, SSE2, NONE)
+DECLARE_VECTORMATH_D2D(Cos, AVX512F, AVX2, SSE2, NONE)
+DECLARE_VECTORMATH_D2D(Exp, AVX512F, AVX2, SSE2, NONE)
+DECLARE_VECTORMATH_D2D(Log, AVX512F, AVX2, SSE2, NONE)
 DECLARE_VECTORMATH_D2D(Round, AVX2, AVX, NONE, NONE)
+
+/* declare internal prototypes of SIMD-specific vector math functions with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) */
+#define DECLARE_VECTORMATH_D2DD(NAME, ...)                                   \
+  DECLARE_VECTORMATH_ANY( NAME ## REAL8, ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len ), __VA_ARGS__ )
+
+DECLARE_VECTORMATH_D2DD(SinCos, AVX512F, AVX2, SSE2, NONE)
+DECLARE_VECTORMATH_D2DD(SinCos2Pi, AVX512F, AVX2, SSE2, NONE)
+
+/* declare internal prototypes of SIMD-specific vector math functions with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) */
+#define DECLARE_VECTORMATH_ZZ2Z(NAME, ...)                                   \
+  DECLARE_VECTORMATH_ANY( NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), __VA_ARGS__ )
+
+DECLARE_VECTORMATH_ZZ2Z(Multiply, AVX512F, AVX2, AVX, SSE2)
+DECLARE_VECTORMATH_ZZ2Z(MultiplyConj, AVX512F, AVX2, AVX, SSE2)
+
+/* declare internal prototypes of SIMD-specific vector math functions with 1 COMPLEX16 vector input to 1 REAL8 vector output (Z2D) */
+#define DECLARE_VECTORMATH_Z2D(NAME, ...)                                    \
+  DECLARE_VECTORMATH_ANY( NAME ## COMPLEX16, ( REAL8 *out, const COMPLEX16 *in, const UINT4 len ), __VA_ARGS__ )
+
+DECLARE_VECTORMATH_Z2D(Abs2, AVX512F, AVX2, AVX, SSE2)
+
+/* declare internal prototypes of SIMD-specific vector math functions with 2 COMPLEX16 vector inputs to 1 COMPLEX16 scalar output (ZZ2z) */
+#define DECLARE_VECTORMATH_ZZ2z(NAME, ...)                                   \
+  DECLARE_VECTORMATH_ANY( NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), __VA_ARGS__ )
+
+DECLARE_VECTORMATH_ZZ2z(DotConj, AVX512F, AVX2, AVX, SSE2)
+
+/* declare internal prototypes of SIMD-specific weighted inner products of 2 complex vector inputs and 1 real vector input to 1 COMPLEX16 and 1 REAL8 scalar output (ZZD2zd, CCS2zd) */
+#define DECLARE_VECTORMATH_ZZD2zd(NAME, ...)                                 \
+  DECLARE_VECTORMATH_ANY( NAME ## COMPLEX16, ( COMPLEX16 *hd, REAL8 *hh, const COMPLEX16 *h, const COMPLEX16 *d, const REAL8 *w, const UINT4 len, const VectorMathSumMethod method ), __VA_ARGS__ )
+#define DECLARE_VECTORMATH_CCS2zd(NAME, ...)                                 \
+  DECLARE_VECTORMATH_ANY( NAME ## COMPLEX8, ( COMPLEX16 *hd, REAL8 *hh, const COMPLEX8 *h, const COMPLEX8 *d, const REAL4 *w, const UINT4 len, const VectorMathSumMethod method ), __VA_ARGS__ )
+
+DECLARE_VECTORMATH_ZZD2zd(WeightedInnerProduct, AVX512F, AVX2, SSE2, NONE)
+DECLARE_VECTORMATH_CCS2zd(WeightedInnerProduct, AVX512F, AVX2, SSE2, NONE)
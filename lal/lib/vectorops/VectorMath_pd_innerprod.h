@@ -0,0 +1,200 @@
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301  USA
+//
+
+//
+// Weighted complex inner products <h|d> = sum_k w_k conj(h_k) d_k and <h|h>, accumulated in REAL8.
+//
+// This file is included by the SIMD-specific VectorMath_xxx.c sources after VectorMath_pd_mathfun.h,
+// and uses its vector type and operations, plus the following:
+//
+//   PD_SWAP_PAIRS(a)        swap each pair of adjacent lanes (re,im) -> (im,re)
+//   PD_LOADDUP(p)           load V_PD_LEN/2 REAL8s, duplicating each into a pair of lanes
+//   PD_LOADU_PS(p)          load V_PD_LEN REAL4s, converted to REAL8
+//   PD_LOADDUP_PS(p)        load V_PD_LEN/2 REAL4s, converted to REAL8 and duplicated into pairs of lanes
+//
+// A vector holds PD_IP_NC = V_PD_LEN/2 complex numbers, stored as interleaved (re,im) pairs. For each
+// vector of h, d and w, the lane-wise sums A += w*h*d, B += w*h*swap(d) and C += w*h*h are accumulated;
+// then Re<h|d> = sum(A), Im<h|d> = sum(B over re lanes) - sum(B over im lanes), and <h|h> = sum(C).
+//
+
+#define PD_IP_NC        ( V_PD_LEN / 2 )
+
+// number of complex samples summed directly before pairwise summation takes over
+#define PD_IP_PAIRWISE_BLOCK    128
+
+// ---------- loaders of PD_IP_NC complex samples of h, d (and weights w) starting at index i ----------
+// if n < PD_IP_NC, only the first n samples are loaded, and the remaining lanes are zero
+
+static inline void pd_ip_load_COMPLEX16 ( V_PD *h, V_PD *d, V_PD *w, const void *hp, const void *dp, const void *wp, const UINT4 i, const UINT4 n )
+{
+  const COMPLEX16 *hz = ( (const COMPLEX16 *) hp ) + i;
+  const COMPLEX16 *dz = ( (const COMPLEX16 *) dp ) + i;
+  const REAL8 *wd = ( (const REAL8 *) wp ) + i;
+  if ( n == PD_IP_NC ) {
+    *h = PD_LOADU ( (const REAL8 *) hz );
+    *d = PD_LOADU ( (const REAL8 *) dz );
+    *w = PD_LOADDUP ( wd );
+  } else {
+    COMPLEX16 hbuf[PD_IP_NC], dbuf[PD_IP_NC];
+    REAL8 wbuf[PD_IP_NC];
+    for ( UINT4 j = 0; j < PD_IP_NC; ++j ) {
+      hbuf[j] = ( j < n ) ? hz[j] : 0;
+      dbuf[j] = ( j < n ) ? dz[j] : 0;
+      wbuf[j] = ( j < n ) ? wd[j] : 0;
+    }
+    *h = PD_LOADU ( (const REAL8 *) hbuf );
+    *d = PD_LOADU ( (const REAL8 *) dbuf );
+    *w = PD_LOADDUP ( wbuf );
+  }
+}
+
+static inline void pd_ip_load_COMPLEX8 ( V_PD *h, V_PD *d, V_PD *w, const void *hp, const void *dp, const void *wp, const UINT4 i, const UINT4 n )
+{
+  const COMPLEX8 *hc = ( (const COMPLEX8 *) hp ) + i;
+  const COMPLEX8 *dc = ( (const COMPLEX8 *) dp ) + i;
+  const REAL4 *ws = ( (const REAL4 *) wp ) + i;
+  if ( n == PD_IP_NC ) {
+    *h = PD_LOADU_PS ( (const REAL4 *) hc );
+    *d = PD_LOADU_PS ( (const REAL4 *) dc );
+    *w = PD_LOADDUP_PS ( ws );
+  } else {
+    COMPLEX8 hbuf[PD_IP_NC], dbuf[PD_IP_NC];
+    REAL4 wbuf[PD_IP_NC];
+    for ( UINT4 j = 0; j < PD_IP_NC; ++j ) {
+      hbuf[j] = ( j < n ) ? hc[j] : 0;
+      dbuf[j] = ( j < n ) ? dc[j] : 0;
+      wbuf[j] = ( j < n ) ? ws[j] : 0;
+    }
+    *h = PD_LOADU_PS ( (const REAL4 *) hbuf );
+    *d = PD_LOADU_PS ( (const REAL4 *) dbuf );
+    *w = PD_LOADDUP_PS ( wbuf );
+  }
+}
+
+typedef void ( *pd_ip_loader ) ( V_PD *, V_PD *, V_PD *, const void *, const void *, const void *, const UINT4, const UINT4 );
+
+// ---------- reduce the lane-wise sums A, B, C to Re<h|d>, Im<h|d>, <h|h> ----------
+static inline void pd_ip_reduce ( REAL8 s[3], const V_PD A, const V_PD B, const V_PD C )
+{
+  REAL8 a[V_PD_LEN], b[V_PD_LEN], c[V_PD_LEN];
+  PD_STOREU ( a, A );
+  PD_STOREU ( b, B );
+  PD_STOREU ( c, C );
+  s[0] = s[1] = s[2] = 0;
+  for ( UINT4 l = 0; l < V_PD_LEN; l += 2 ) {
+    s[0] += a[l] + a[l+1];
+    s[1] += b[l] - b[l+1];
+    s[2] += c[l] + c[l+1];
+  }
+}
+
+// ---------- direct summation of samples [i0, i0 + n) ----------
+static inline void pd_ip_direct ( REAL8 s[3], const void *hp, const void *dp, const void *wp, const UINT4 i0, const UINT4 n, pd_ip_loader load )
+{
+  V_PD A = PD_SET1 ( 0 ), B = PD_SET1 ( 0 ), C = PD_SET1 ( 0 );
+  V_PD h, d, w;
+  const UINT4 iend = i0 + n;
+  UINT4 i = i0;
+  for ( ; i + PD_IP_NC <= iend; i += PD_IP_NC ) {
+    (*load) ( &h, &d, &w, hp, dp, wp, i, PD_IP_NC );
+    const V_PD wh = PD_MUL ( w, h );
+    A = PD_ADD ( A, PD_MUL ( wh, d ) );
+    B = PD_ADD ( B, PD_MUL ( wh, PD_SWAP_PAIRS ( d ) ) );
+    C = PD_ADD ( C, PD_MUL ( wh, h ) );
+  }
+  if ( i < iend ) {
+    (*load) ( &h, &d, &w, hp, dp, wp, i, iend - i );
+    const V_PD wh = PD_MUL ( w, h );
+    A = PD_ADD ( A, PD_MUL ( wh, d ) );
+    B = PD_ADD ( B, PD_MUL ( wh, PD_SWAP_PAIRS ( d ) ) );
+    C = PD_ADD ( C, PD_MUL ( wh, h ) );
+  }
+  pd_ip_reduce ( s, A, B, C );
+}
+
+// ---------- Kahan compensated summation of samples [0, len), separately in each lane ----------
+#define PD_KAHAN_ADD(S, E, x) do {               \
+    const V_PD y_ = PD_SUB ( (x), (E) );         \
+    const V_PD t_ = PD_ADD ( (S), y_ );          \
+    (E) = PD_SUB ( PD_SUB ( t_, (S) ), y_ );     \
+    (S) = t_;                                    \
+  } while (0)
+
+static inline void pd_ip_kahan ( REAL8 s[3], const void *hp, const void *dp, const void *wp, const UINT4 len, pd_ip_loader load )
+{
+  V_PD A = PD_SET1 ( 0 ), B = PD_SET1 ( 0 ), C = PD_SET1 ( 0 );
+  V_PD EA = PD_SET1 ( 0 ), EB = PD_SET1 ( 0 ), EC = PD_SET1 ( 0 );
+  V_PD h, d, w;
+  for ( UINT4 i = 0; i < len; i += PD_IP_NC ) {
+    const UINT4 n = ( len - i < PD_IP_NC ) ? len - i : PD_IP_NC;
+    (*load) ( &h, &d, &w, hp, dp, wp, i, n );
+    const V_PD wh = PD_MUL ( w, h );
+    PD_KAHAN_ADD ( A, EA, PD_MUL ( wh, d ) );
+    PD_KAHAN_ADD ( B, EB, PD_MUL ( wh, PD_SWAP_PAIRS ( d ) ) );
+    PD_KAHAN_ADD ( C, EC, PD_MUL ( wh, h ) );
+  }
+  pd_ip_reduce ( s, PD_SUB ( A, EA ), PD_SUB ( B, EB ), PD_SUB ( C, EC ) );
+}
+
+// ---------- pairwise summation of samples [0, len): blocks are summed directly, then block sums are combined pairwise ----------
+static inline void pd_ip_pairwise ( REAL8 s[3], const void *hp, const void *dp, const void *wp, const UINT4 len, pd_ip_loader load )
+{
+  // stack of partial sums; entry k holds the sum of 2^m blocks, with m decreasing up the stack
+  REAL8 part[33][3];
+  UINT4 top = 0;
+  for ( UINT4 b = 0, i = 0; i < len; ++b, i += PD_IP_PAIRWISE_BLOCK ) {
+    const UINT4 n = ( len - i < PD_IP_PAIRWISE_BLOCK ) ? len - i : PD_IP_PAIRWISE_BLOCK;
+    pd_ip_direct ( part[top++], hp, dp, wp, i, n, load );
+    for ( UINT4 bb = b; bb & 1; bb >>= 1 ) {
+      --top;
+      for ( UINT4 k = 0; k < 3; ++k ) {
+        part[top-1][k] += part[top][k];
+      }
+    }
+  }
+  s[0] = s[1] = s[2] = 0;
+  while ( top > 0 ) {
+    --top;
+    for ( UINT4 k = 0; k < 3; ++k ) {
+      s[k] += part[top][k];
+    }
+  }
+}
+
+// ---------- compute <h|d> and optionally <h|h> with the given summation method ----------
+static inline int pd_ip_compute ( COMPLEX16 *hd, REAL8 *hh, const void *hp, const void *dp, const void *wp, const UINT4 len, const VectorMathSumMethod method, pd_ip_loader load )
+{
+  REAL8 s[3];
+  switch ( method ) {
+  case VECTORMATH_SUM_DIRECT:
+    pd_ip_direct ( s, hp, dp, wp, 0, len, load );
+    break;
+  case VECTORMATH_SUM_KAHAN:
+    pd_ip_kahan ( s, hp, dp, wp, len, load );
+    break;
+  case VECTORMATH_SUM_PAIRWISE:
+    pd_ip_pairwise ( s, hp, dp, wp, len, load );
+    break;
+  default:
+    XLAL_ERROR ( XLAL_EINVAL, "Invalid summation method %i", method );
+  }
+  *hd = crect ( s[0], s[1] );
+  if ( hh != NULL ) {
+    *hh = s[2];
+  }
+  return XLAL_SUCCESS;
+}
@@ -0,0 +1,263 @@
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301  USA
+//
+
+//
+// Double-precision SIMD versions of sin(), cos(), exp() and log(), using the
+// algorithms and polynomial coefficients of the Cephes Math Library by
+// Stephen L. Moshier, as the single-precision VectorMath_sse_mathfun.h and
+// VectorMath_avx_mathfun.h do.
+//
+// This file is included by the SIMD-specific VectorMath_xxx.c sources, which
+// must first define the following vector type and operations:
+//
+//   V_PD                    vector of V_PD_LEN doubles
+//   V_MASK                  lane mask, as returned by the comparisons
+//   PD_SET1(x)              vector with all lanes equal to x
+//   PD_LOADU(p), PD_STOREU(p,a)   unaligned load/store
+//   PD_ADD(a,b), PD_SUB(a,b), PD_MUL(a,b), PD_DIV(a,b)
+//   PD_AND(a,b), PD_OR(a,b), PD_XOR(a,b)   bitwise operations
+//   PD_SRLI64(a,n), PD_SLLI64(a,n)         logical shifts of the 64-bit lanes
+//   PD_CMPLT(a,b), PD_CMPLE(a,b), PD_CMPEQ(a,b), PD_CMPUNORD(a,b)
+//   PD_SELECT(m,a,b)        lane-wise (m ? a : b)
+//   MASK_OR(m1,m2)          lane-wise (m1 || m2)
+//   MASK_ANY(m)             non-zero if m is true in any lane
+//
+
+#include <stdint.h>
+
+// ---------- local helpers ----------
+
+// vector with all lanes set to the given bit pattern
+static inline V_PD pd_bits ( const uint64_t u )
+{
+  const union { uint64_t u; double d; } ud = { .u = u };
+  return PD_SET1 ( ud.d );
+}
+
+#define PD_SIGN_MASK      pd_bits ( 0x8000000000000000ULL )
+#define PD_ABS_MASK       pd_bits ( 0x7fffffffffffffffULL )
+#define PD_MANTISSA_MASK  pd_bits ( 0x000fffffffffffffULL )
+#define PD_INF            pd_bits ( 0x7ff0000000000000ULL )
+#define PD_NAN            pd_bits ( 0x7ff8000000000000ULL )
+#define PD_TWO52          PD_SET1 ( 4503599627370496.0 )
+
+// floor(x) for 0 <= x < 2^52
+static inline V_PD pd_floor_nonneg ( const V_PD x )
+{
+  const V_PD r = PD_SUB ( PD_ADD ( x, PD_TWO52 ), PD_TWO52 );
+  return PD_SUB ( r, PD_SELECT ( PD_CMPLT ( x, r ), PD_SET1 ( 1.0 ), PD_SET1 ( 0.0 ) ) );
+}
+
+// round x to the nearest integer, for |x| < 2^51
+static inline V_PD pd_round_small ( const V_PD x )
+{
+  const V_PD magic = PD_SET1 ( 6755399441055744.0 );   // 1.5 * 2^52
+  return PD_SUB ( PD_ADD ( x, magic ), magic );
+}
+
+// 2^n for integer-valued -1022 <= n <= 1023
+static inline V_PD pd_pow2i ( const V_PD n )
+{
+  // adding 2^52 places the integer (n + 1023) in the low mantissa bits, then
+  // shifting it into the exponent bits discards the exponent of 2^52
+  return PD_SLLI64 ( PD_ADD ( PD_ADD ( n, PD_SET1 ( 1023.0 ) ), PD_TWO52 ), 52 );
+}
+
+// ---------- exp() ----------
+
+static inline V_PD pd_exp ( V_PD x )
+{
+  const V_PD maxlog = PD_SET1 (  7.09782712893383996843E2 );
+  const V_PD minlog = PD_SET1 ( -7.451332191019412076235E2 );
+
+  const V_MASK over  = PD_CMPLT ( maxlog, x );
+  const V_MASK under = PD_CMPLT ( x, minlog );
+  x = PD_SELECT ( over, maxlog, x );
+  x = PD_SELECT ( under, minlog, x );
+
+  // express exp(x) as exp(g + n*log(2))
+  const V_PD n = pd_round_small ( PD_MUL ( x, PD_SET1 ( 1.4426950408889634073599 ) ) );
+  x = PD_SUB ( x, PD_MUL ( n, PD_SET1 ( 6.93145751953125E-1 ) ) );
+  x = PD_SUB ( x, PD_MUL ( n, PD_SET1 ( 1.42860682030941723212E-6 ) ) );
+
+  // rational approximation for exponential of the fractional part:
+  // e^x = 1 + 2x P(x^2) / ( Q(x^2) - P(x^2) )
+  const V_PD xx = PD_MUL ( x, x );
+  V_PD px = PD_SET1 ( 1.26177193074810590878E-4 );
+  px = PD_ADD ( PD_MUL ( px, xx ), PD_SET1 ( 3.02994407707441961300E-2 ) );
+  px = PD_ADD ( PD_MUL ( px, xx ), PD_SET1 ( 9.99999999999999999910E-1 ) );
+  px = PD_MUL ( px, x );
+  V_PD qx = PD_SET1 ( 3.00198505138664455042E-6 );
+  qx = PD_ADD ( PD_MUL ( qx, xx ), PD_SET1 ( 2.52448340349684104192E-3 ) );
+  qx = PD_ADD ( PD_MUL ( qx, xx ), PD_SET1 ( 2.27265548208155028766E-1 ) );
+  qx = PD_ADD ( PD_MUL ( qx, xx ), PD_SET1 ( 2.00000000000000000009E0 ) );
+  x = PD_DIV ( px, PD_SUB ( qx, px ) );
+  x = PD_ADD ( PD_SET1 ( 1.0 ), PD_ADD ( x, x ) );
+
+  // multiply by 2^n in two steps, so that neither factor over/underflows
+  const V_PD n1 = pd_round_small ( PD_MUL ( n, PD_SET1 ( 0.5 ) ) );
+  x = PD_MUL ( PD_MUL ( x, pd_pow2i ( n1 ) ), pd_pow2i ( PD_SUB ( n, n1 ) ) );
+
+  x = PD_SELECT ( over, PD_INF, x );
+  x = PD_SELECT ( under, PD_SET1 ( 0.0 ), x );
+  return x;
+}
+
+// ---------- log() ----------
+
+static inline V_PD pd_log ( V_PD x )
+{
+  const V_MASK invalid = MASK_OR ( PD_CMPLT ( x, PD_SET1 ( 0.0 ) ), PD_CMPUNORD ( x, x ) );
+  const V_MASK zero = PD_CMPEQ ( x, PD_SET1 ( 0.0 ) );
+  const V_MASK inf = PD_CMPEQ ( x, PD_INF );
+
+  // scale subnormal numbers into the normal range
+  const V_MASK subnormal = PD_CMPLT ( x, PD_SET1 ( 2.2250738585072014e-308 ) );
+  x = PD_SELECT ( subnormal, PD_MUL ( x, PD_SET1 ( 18014398509481984.0 ) ), x );   // 2^54
+
+  // split x into exponent e and mantissa m in [0.5, 1), like frexp()
+  V_PD e = PD_SUB ( PD_OR ( PD_SRLI64 ( x, 52 ), PD_TWO52 ), PD_TWO52 );
+  e = PD_SUB ( e, PD_SELECT ( subnormal, PD_SET1 ( 1022.0 + 54.0 ), PD_SET1 ( 1022.0 ) ) );
+  V_PD m = PD_OR ( PD_AND ( x, PD_MANTISSA_MASK ), pd_bits ( 0x3fe0000000000000ULL ) );
+
+  // if m < sqrt(1/2), use 2m - 1 and decrement e, otherwise use m - 1
+  const V_MASK small = PD_CMPLT ( m, PD_SET1 ( 7.07106781186547524401E-1 ) );
+  e = PD_SUB ( e, PD_SELECT ( small, PD_SET1 ( 1.0 ), PD_SET1 ( 0.0 ) ) );
+  m = PD_SUB ( PD_SELECT ( small, PD_ADD ( m, m ), m ), PD_SET1 ( 1.0 ) );
+
+  // rational approximation log(1+m) = m - m^2/2 + m^3 P(m) / Q(m)
+  const V_PD z = PD_MUL ( m, m );
+  V_PD p = PD_SET1 ( 1.01875663804580931796E-4 );
+  p = PD_ADD ( PD_MUL ( p, m ), PD_SET1 ( 4.97494994976747001425E-1 ) );
+  p = PD_ADD ( PD_MUL ( p, m ), PD_SET1 ( 4.70579119878881725854E0 ) );
+  p = PD_ADD ( PD_MUL ( p, m ), PD_SET1 ( 1.44989225341610930846E1 ) );
+  p = PD_ADD ( PD_MUL ( p, m ), PD_SET1 ( 1.79368678507819816313E1 ) );
+  p = PD_ADD ( PD_MUL ( p, m ), PD_SET1 ( 7.70838733755885391666E0 ) );
+  V_PD q = PD_ADD ( m, PD_SET1 ( 1.12873587189167450590E1 ) );
+  q = PD_ADD ( PD_MUL ( q, m ), PD_SET1 ( 4.52279145837532221105E1 ) );
+  q = PD_ADD ( PD_MUL ( q, m ), PD_SET1 ( 8.29875266912776603211E1 ) );
+  q = PD_ADD ( PD_MUL ( q, m ), PD_SET1 ( 7.11544750618563894466E1 ) );
+  q = PD_ADD ( PD_MUL ( q, m ), PD_SET1 ( 2.31251620126765340583E1 ) );
+  V_PD y = PD_MUL ( m, PD_DIV ( PD_MUL ( z, p ), q ) );
+
+  // add e*log(2), with log(2) split into an exact and a correction part
+  y = PD_SUB ( y, PD_MUL ( e, PD_SET1 ( 2.121944400546905827679E-4 ) ) );
+  y = PD_SUB ( y, PD_MUL ( z, PD_SET1 ( 0.5 ) ) );
+  y = PD_ADD ( m, y );
+  y = PD_ADD ( y, PD_MUL ( e, PD_SET1 ( 0.693359375 ) ) );
+
+  y = PD_SELECT ( inf, PD_INF, y );
+  y = PD_SELECT ( zero, PD_XOR ( PD_INF, PD_SIGN_MASK ), y );
+  y = PD_SELECT ( invalid, PD_NAN, y );
+  return y;
+}
+
+// ---------- sin() and cos() ----------
+
+// largest |x| for which the argument reduction below is accurate
+#define PD_SINCOS_LOSSTH 1.073741824e9
+
+static inline void pd_sincos ( const V_PD xx, V_PD *s, V_PD *c )
+{
+  const V_PD sign_x = PD_AND ( xx, PD_SIGN_MASK );
+  const V_PD x = PD_AND ( xx, PD_ABS_MASK );
+
+  // octant y = floor(x / (pi/4)), rounded up to an even number; j = y mod 8
+  V_PD y = pd_floor_nonneg ( PD_MUL ( x, PD_SET1 ( 1.27323954473516268615 ) ) );
+  y = PD_ADD ( y, PD_SUB ( y, PD_MUL ( PD_SET1 ( 2.0 ), pd_floor_nonneg ( PD_MUL ( y, PD_SET1 ( 0.5 ) ) ) ) ) );
+  V_PD j = PD_SUB ( y, PD_MUL ( PD_SET1 ( 8.0 ), pd_floor_nonneg ( PD_MUL ( y, PD_SET1 ( 0.125 ) ) ) ) );
+
+  // reflect octants 4 and 6 into 0 and 2, which flips the signs of sin and cos
+  const V_MASK refl = PD_CMPLE ( PD_SET1 ( 4.0 ), j );
+  j = PD_SELECT ( refl, PD_SUB ( j, PD_SET1 ( 4.0 ) ), j );
+  const V_MASK swap = PD_CMPEQ ( j, PD_SET1 ( 2.0 ) );
+
+  // extended precision modular arithmetic: z = x - y*pi/4
+  V_PD z = PD_SUB ( x, PD_MUL ( y, PD_SET1 ( 7.85398125648498535156E-1 ) ) );
+  z = PD_SUB ( z, PD_MUL ( y, PD_SET1 ( 3.77489470793079817668E-8 ) ) );
+  z = PD_SUB ( z, PD_MUL ( y, PD_SET1 ( 2.69515142907905952645E-15 ) ) );
+  const V_PD zz = PD_MUL ( z, z );
+
+  // polynomial approximations of sin and cos in [-pi/4, pi/4]
+  V_PD ps = PD_SET1 ( 1.58962301576546568060E-10 );
+  ps = PD_ADD ( PD_MUL ( ps, zz ), PD_SET1 ( -2.50507477628578072866E-8 ) );
+  ps = PD_ADD ( PD_MUL ( ps, zz ), PD_SET1 ( 2.75573136213857245213E-6 ) );
+  ps = PD_ADD ( PD_MUL ( ps, zz ), PD_SET1 ( -1.98412698295895385996E-4 ) );
+  ps = PD_ADD ( PD_MUL ( ps, zz ), PD_SET1 ( 8.33333333332211858878E-3 ) );
+  ps = PD_ADD ( PD_MUL ( ps, zz ), PD_SET1 ( -1.66666666666666307295E-1 ) );
+  ps = PD_ADD ( z, PD_MUL ( PD_MUL ( z, zz ), ps ) );
+  V_PD pc = PD_SET1 ( -1.13585365213876817300E-11 );
+  pc = PD_ADD ( PD_MUL ( pc, zz ), PD_SET1 ( 2.08757008419747316778E-9 ) );
+  pc = PD_ADD ( PD_MUL ( pc, zz ), PD_SET1 ( -2.75573141792967388112E-7 ) );
+  pc = PD_ADD ( PD_MUL ( pc, zz ), PD_SET1 ( 2.48015872888517045348E-5 ) );
+  pc = PD_ADD ( PD_MUL ( pc, zz ), PD_SET1 ( -1.38888888888730564116E-3 ) );
+  pc = PD_ADD ( PD_MUL ( pc, zz ), PD_SET1 ( 4.16666666666665929218E-2 ) );
+  pc = PD_ADD ( PD_SUB ( PD_SET1 ( 1.0 ), PD_MUL ( zz, PD_SET1 ( 0.5 ) ) ), PD_MUL ( PD_MUL ( zz, zz ), pc ) );
+
+  // select polynomials and apply signs
+  const V_PD refl_sign = PD_SELECT ( refl, PD_SIGN_MASK, PD_SET1 ( 0.0 ) );
+  const V_PD swap_sign = PD_SELECT ( swap, PD_SIGN_MASK, PD_SET1 ( 0.0 ) );
+  V_PD sv = PD_XOR ( PD_SELECT ( swap, pc, ps ), PD_XOR ( sign_x, refl_sign ) );
+  V_PD cv = PD_XOR ( PD_SELECT ( swap, ps, pc ), PD_XOR ( swap_sign, refl_sign ) );
+
+  // fall back to libm for arguments too large for the argument reduction
+  const V_MASK big = PD_CMPLT ( PD_SET1 ( PD_SINCOS_LOSSTH ), x );
+  if ( MASK_ANY ( big ) )
+    {
+      double xa[V_PD_LEN], sa[V_PD_LEN], ca[V_PD_LEN];
+      PD_STOREU ( xa, xx );
+      PD_STOREU ( sa, sv );
+      PD_STOREU ( ca, cv );
+      for ( int l = 0; l < V_PD_LEN; ++l )
+        {
+          if ( fabs ( xa[l] ) > PD_SINCOS_LOSSTH )
+            {
+              sa[l] = sin ( xa[l] );
+              ca[l] = cos ( xa[l] );
+            }
+        }
+      sv = PD_LOADU ( sa );
+      cv = PD_LOADU ( ca );
+    }
+
+  (*s) = sv;
+  (*c) = cv;
+}
+
+static inline V_PD pd_sin ( const V_PD x )
+{
+  V_PD s, c;
+  pd_sincos ( x, &s, &c );
+  return s;
+}
+
+static inline V_PD pd_cos ( const V_PD x )
+{
+  V_PD s, c;
+  pd_sincos ( x, &s, &c );
+  return c;
+}
+
+// sin(2*pi*x) and cos(2*pi*x): reduce x to [-1/2, 1/2] first, which is exact
+static inline void pd_sincos_2pi ( const V_PD x, V_PD *s, V_PD *c )
+{
+  const V_PD ax = PD_AND ( x, PD_ABS_MASK );
+  V_PD r = PD_SUB ( ax, PD_SUB ( PD_ADD ( ax, PD_TWO52 ), PD_TWO52 ) );
+  r = PD_SELECT ( PD_CMPLT ( ax, PD_TWO52 ), r, PD_MUL ( r, PD_SET1 ( 0.0 ) ) );   // keeps NaN for non-finite x
+  r = PD_XOR ( r, PD_AND ( x, PD_SIGN_MASK ) );
+  pd_sincos ( PD_MUL ( r, PD_SET1 ( 6.283185307179586476925286766559 ) ), s, c );
+}
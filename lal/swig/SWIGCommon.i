@@ -281,6 +281,11 @@ SWIGINTERNINLINE gsl_complex_float gsl_complex_float_rect(float x, float y) {
 ///    preprocessor symbol determines if the LAL error handling code is invoked; by default this
 ///    symbol should be undefined, i.e. functions are XLAL functions by default.</dd>
 /// </dl>
+/// If <tt>swiglal_release_gil_<i>NAME</i></tt> is defined for a function <tt>NAME</tt> (see
+/// <b>SWIGLAL(RELEASE_GIL(...))</b>), the action is performed between \b swiglal_begin_release_gil()
+/// and \b swiglal_end_release_gil(), which release and reacquire any global interpreter lock of the
+/// scripting language. This is only done if LAL was built with <tt>LAL_PTHREAD_LOCK</tt>, so that
+/// the XLAL error number checked after the action is private to the calling thread.
 ///
 %header %{
 static const LALStatus swiglal_empty_LALStatus = {0, NULL, NULL, NULL, NULL, 0, NULL, 0};
@@ -293,7 +298,13 @@ static const LALStatus swiglal_empty_LALStatus = {0, NULL, NULL, NULL, NULL, 0,
 }
 %exception %{
   XLALClearErrno();
+#if defined(swiglal_release_gil_$name) && defined(LAL_PTHREAD_LOCK)
+  swiglal_begin_release_gil();
   $action
+  swiglal_end_release_gil();
+#else
+  $action
+#endif
 #ifdef swiglal_check_LALStatus
   if (lalstatus.statusCode) {
     XLALSetErrno(XLAL_EFAILED);
@@ -2084,6 +2095,19 @@ if (strides[I-1] == 0) {
 %enddef
 #define %swiglal_public_clear_DISABLE_EXCEPTIONS(...)
 
+///
+/// The <b>SWIGLAL(RELEASE_GIL(...))</b> public macro marks functions which may be called
+/// concurrently from several scripting-language threads, i.e. which do not modify global state and
+/// do not call back into the scripting language. The scripting-language global interpreter lock is
+/// then released while the function runs. The macro itself does nothing here; the interface
+/// generator <tt>generate_swig_iface.py</tt> instead defines <tt>swiglal_release_gil_<i>NAME</i></tt>
+/// for each function <tt>NAME</tt>, which is checked by the <tt>%exception</tt> handler.
+/// Only functions known to be thread-safe, such as the FFT execution functions, should be marked;
+/// functions which modify their input structures, or use lazily-initialised global caches, should not.
+///
+#define %swiglal_public_RELEASE_GIL(...)
+#define %swiglal_public_clear_RELEASE_GIL(...)
+
 ///
 /// The <b>SWIGLAL(FUNCTION_POINTER(...))</b> macro can be used to create a function pointer
 /// constant, for functions which need to be used as callback functions.
@@ -65,6 +65,13 @@ extern "C++" {
 #define swiglal_append_output_if_empty(v) if (_outp->length() == 0) _outp = SWIG_Octave_AppendOutput(_outp, v)
 %}
 
+// Octave has no global interpreter lock, so functions marked with SWIGLAL(RELEASE_GIL(...)) are
+// called as usual.
+%header %{
+#define swiglal_begin_release_gil()
+#define swiglal_end_release_gil()
+%}
+
 // Evaluates true if an octave_value represents a null pointer, false otherwise.
 %header %{
 #define swiglal_null_ptr(v)  (!(v).is_string() && (v).is_matrix_type() && (v).rows() == 0 && (v).columns() == 0)
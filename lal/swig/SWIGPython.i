@@ -65,6 +65,13 @@ SWIGINTERNINLINE PyObject* swiglal_get_reference(PyObject* v) { Py_XINCREF(v); r
 #define swiglal_append_output_if_empty(v) if (resultobj == Py_None) resultobj = SWIG_Python_AppendOutput(resultobj, v)
 %}
 
+// Release and reacquire the Python global interpreter lock around the action of a function marked
+// with SWIGLAL(RELEASE_GIL(...)). No Python API functions may be called in between.
+%header %{
+#define swiglal_begin_release_gil() Py_BEGIN_ALLOW_THREADS
+#define swiglal_end_release_gil()   Py_END_ALLOW_THREADS
+%}
+
 // Evaluates true if a PyObject represents a null pointer, false otherwise.
 %header %{
 #define swiglal_null_ptr(v)  ((v) == Py_None)
@@ -447,6 +454,61 @@ SWIGINTERN bool swiglal_release_parent(void *ptr) {
     }
   }
 
+  // Return true if the C array elements are laid out contiguously in row-major order, i.e. the
+  // C array and a C-ordered NumPy array of the same dimensions share the same memory layout.
+  bool swiglal_py_array_is_contiguous(const size_t ndims,
+                                      const size_t dims[],
+                                      const size_t strides[])
+  {
+    size_t stride = 1;
+    for (int j = ((int)ndims) - 1; j >= 0; --j) {
+      if (dims[j] > 1 && strides[j] != stride) {
+        return false;
+      }
+      stride *= dims[j];
+    }
+    return true;
+  }
+
+  // Copy the elements of a NumPy array, which must already have the same element type and size as
+  // the C array, directly to/from the C array without converting each element to a Python object.
+  void swiglal_py_array_rawcopy(PyArrayObject* nparr,
+                                void* ptr,
+                                const bool copyin,
+                                const size_t esize,
+                                const size_t ndims,
+                                const size_t dims[],
+                                const size_t strides[])
+  {
+    npy_intp idx[ndims];
+    size_t nelem = 1;
+    for (size_t i = 0; i < ndims; ++i) {
+      nelem *= dims[i];
+    }
+    if (nelem == 0) {
+      return;
+    }
+    if (PyArray_ISCARRAY_RO(nparr) && swiglal_py_array_is_contiguous(ndims, dims, strides)) {
+      if (copyin) {
+        memcpy(ptr, PyArray_DATA(nparr), nelem*esize);
+      } else {
+        memcpy(PyArray_DATA(nparr), ptr, nelem*esize);
+      }
+      return;
+    }
+    memset(idx, 0, ndims*sizeof(npy_intp));
+    for (size_t i = 0; i < nelem; ++i) {
+      void* elemptr = swiglal_py_get_element_ptr(ptr, esize, ndims, strides, idx);
+      void* npelemptr = PyArray_GetPtr(nparr, idx);
+      if (copyin) {
+        memcpy(elemptr, npelemptr, esize);
+      } else {
+        memcpy(npelemptr, elemptr, esize);
+      }
+      swiglal_py_increment_idx(ndims, dims, idx);
+    }
+  }
+
  } // fragment swiglal_py_array_helpers
 
 // Fragment defining helper functions for the NumPy object-view array descriptors.
@@ -748,6 +810,15 @@ SWIGINTERN bool swiglal_release_parent(void *ptr) {
       nelem *= dims[i];
     }
 
+    // If the NumPy array already has the element type of the C array, in native byte order, copy
+    // the raw array memory instead of converting each element through a Python object.
+    if (NPYTYPE != NPY_OBJECT && !isptr && PyArray_TYPE(nparr) == NPYTYPE &&
+        ((size_t)PyArray_ITEMSIZE(nparr)) == esize && PyArray_ISNOTSWAPPED(nparr)) {
+      swiglal_py_array_rawcopy(nparr, ptr, true, esize, ndims, dims, strides);
+      res = SWIG_OK;
+      goto end;
+    }
+
     // Iterate over all elements in the C array.
     memset(idx, 0, ndims*sizeof(npy_intp));
     for (size_t i = 0; i < nelem; ++i) {
@@ -813,6 +884,13 @@ SWIGINTERN bool swiglal_release_parent(void *ptr) {
       goto fail;
     }
 
+    // If the NumPy array elements have the same size as the C array elements, copy the raw array
+    // memory instead of converting each element through a Python object.
+    if (NPYTYPE != NPY_OBJECT && !isptr && ((size_t)PyArray_ITEMSIZE(nparr)) == esize) {
+      swiglal_py_array_rawcopy(nparr, ptr, false, esize, ndims, dims, strides);
+      return (PyObject*)nparr;
+    }
+
     // Iterate over all elements in the C array.
     memset(idx, 0, ndims*sizeof(npy_intp));
     for (size_t i = 0; i < nelem; ++i) {
@@ -879,8 +957,16 @@ SWIGINTERN bool swiglal_release_parent(void *ptr) {
       dims[i] = PyArray_DIM(nparr, i);
     }
 
-    // Cannot view an object which is not a NumPy array.
-    if (!PyArray_Check(obj)) {
+    // Cannot view an object which is neither a NumPy array, nor an object exporting its memory
+    // through the buffer protocol (e.g. memoryview, array.array) which NumPy was able to wrap
+    // without making a copy.
+    if (!PyArray_Check(obj) && !(PyObject_CheckBuffer(obj) && PyArray_BASE(nparr) != NULL)) {
+      res = SWIG_TypeError;
+      goto end;
+    }
+
+    // Cannot view an array in non-native byte order.
+    if (!PyArray_ISNOTSWAPPED(nparr)) {
       res = SWIG_TypeError;
       goto end;
     }
@@ -2,8 +2,11 @@
 # Author: Karl Wette, 2011--2014
 
 import warnings
+import array
 import datetime
 import pickle
+import threading
+import time
 import numpy
 expected_exception = False
 
@@ -1284,5 +1287,76 @@ lal.swig_lal_test_pydict_to_laldict(laldict)
 lal.swig_lal_test_pydict_to_laldict(pydict)
 print("PASSED Python dict to LALDict typemap (Python specific)")
 
+# check zero-copy array conversions
+print("checking zero-copy array conversions (Python specific) ...")
+n = 1 << 20
+r8in = numpy.random.randn(n)
+r8v = lal.CreateREAL8Vector(n)
+r8v.data = r8in
+assert((r8v.data == r8in).all())
+r8v.data = r8in[::-1]
+assert((r8v.data == r8in[::-1]).all())
+r8v.data = r8in.astype(">f8")
+assert((r8v.data == r8in).all())
+r8out = r8v.data
+assert(not r8out.flags['OWNDATA'])
+r8out[0] = 1.5
+assert(r8v.data[0] == 1.5)
+del r8out
+c16outv = lal.CreateCOMPLEX16Vector(n//2 + 1)
+c16out = numpy.zeros(n//2 + 1, dtype=numpy.complex128)
+plan = lal.CreateForwardREAL8FFTPlan(n, 0)
+lal.REAL8ForwardFFT(c16outv, r8v, plan)
+lal.REAL8ForwardFFT(c16out, memoryview(r8v.data), plan)
+assert((c16out == c16outv.data).all())
+c16out[:] = 0
+lal.REAL8ForwardFFT(c16out, array.array("d", r8v.data), plan)
+assert((c16out == c16outv.data).all())
+def time_per_call(f, repeat=5):
+    t0 = time.time()
+    for i in range(repeat):
+        f()
+    return (time.time() - t0) / repeat
+def assign_data():
+    r8v.data = r8in
+def view_input():
+    lal.REAL8ForwardFFT(c16out, r8in, plan)
+def wrapped_input():
+    lal.REAL8ForwardFFT(c16outv, r8v, plan)
+print("benchmark: assigning %i REAL8s to REAL8Vector.data: %.3g s" % (n, time_per_call(assign_data)))
+print("benchmark: REAL8ForwardFFT() of %i REAL8s, NumPy array input: %.3g s" % (n, time_per_call(view_input)))
+print("benchmark: REAL8ForwardFFT() of %i REAL8s, REAL8Vector input: %.3g s" % (n, time_per_call(wrapped_input)))
+del r8v
+del c16outv
+del plan
+lal.CheckMemoryLeaks()
+print("PASSED zero-copy array conversions (Python specific)")
+
+# check functions which release the GIL
+print("checking functions which release the GIL (Python specific) ...")
+n = 1 << 16
+plan = lal.CreateForwardREAL8FFTPlan(n, 0)
+r8in = numpy.random.randn(n)
+c16exp = numpy.zeros(n//2 + 1, dtype=numpy.complex128)
+lal.REAL8ForwardFFT(c16exp, r8in, plan)
+results = [None] * 8
+def fft_thread(i):
+    c16out = numpy.zeros(n//2 + (1 if i % 2 == 0 else 2), dtype=numpy.complex128)
+    try:
+        for j in range(20):
+            lal.REAL8ForwardFFT(c16out, r8in, plan)
+        results[i] = (c16out == c16exp).all()
+    except RuntimeError:
+        results[i] = "error"
+threads = [threading.Thread(target=fft_thread, args=(i,)) for i in range(len(results))]
+for t in threads:
+    t.start()
+for t in threads:
+    t.join()
+assert(results == [True, "error"] * (len(results) // 2))
+del plan
+lal.CheckMemoryLeaks()
+print("PASSED functions which release the GIL (Python specific)")
+
 # passed all tests!
 print("PASSED all tests")
@@ -174,6 +174,43 @@ int main(void)
              (REAL8)LAL_C_SI);
     }
 
+  /*
+   * The batched delays agree with XLALTimeDelayFromEarthCenter() for
+   * both detectors over a set of sky positions spanning several blocks
+   */
+  {
+    enum { npoints = 1000 };
+    LALDetector detectors[2];
+    REAL8 ra[npoints], dec[npoints], delays[2 * npoints];
+    REAL8 maxdiff = 0.;
+    int i, j;
+
+    detectors[0] = detector1;
+    detectors[1] = detector2;
+    for (i = 0; i < npoints; ++i)
+      {
+        ra[i] = LAL_TWOPI * rand() / RAND_MAX;
+        dec[i] = asin(2. * rand() / RAND_MAX - 1.);
+      }
+    if (XLALTimeDelaysFromEarthCenter(delays, detectors, 2, ra, dec, npoints, &gps) < 0)
+      {
+        fprintf(stderr, "TestDelay: XLALTimeDelaysFromEarthCenter() failed, line %i\n", __LINE__);
+        return 1;
+      }
+    for (j = 0; j < 2; ++j)
+      for (i = 0; i < npoints; ++i)
+        {
+          REAL8 d = XLALTimeDelayFromEarthCenter(detectors[j].location, ra[i], dec[i], &gps);
+          if (fabs(d - delays[j * npoints + i]) > maxdiff)
+            maxdiff = fabs(d - delays[j * npoints + i]);
+        }
+    if (maxdiff > 1e-15)
+      {
+        fprintf(stderr, "ERROR: batched time delays differ by % 14.8e\n", maxdiff);
+        return 1;
+      }
+  }
+
   difference = fabs(delay) - (REAL8)LAL_REARTH_SI / (REAL8)LAL_C_SI;
 
   if (difference < DOUBLE_EPSILON)
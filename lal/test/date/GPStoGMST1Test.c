@@ -30,7 +30,11 @@
 int main(void)
 {
   LIGOTimeGPS      gps = {0., 0.};
+  LIGOTimeGPS      gpstimes[64];
   REAL8            gmst;
+  REAL8            gmsts[64];
+  REAL8            expected;
+  int              i;
 
   gps.gpsSeconds = 61094;
 
@@ -41,5 +45,87 @@ int main(void)
       printf("nSec = %d\tgmst = %g\n", gps.gpsNanoSeconds, gmst);
     }
 
+  /*
+   * Check against the Astronomical Almanac:
+   * For 1994-11-16 0h UT - Julian Date 2449672.5, GMST 03h 39m 21.2738s
+   */
+  gps.gpsSeconds = 468979210;
+  gps.gpsNanoSeconds = 0;
+  gmst = fmod(XLALGreenwichMeanSiderealTime(&gps), LAL_TWOPI);
+  if (gmst < 0.)
+    gmst += LAL_TWOPI;
+  expected = (3. + (39. + 21.2738 / 60.) / 60.) * LAL_PI / 12.;
+  /* the Almanac uses UT1, which is within 0.9 s of UTC */
+  if (fabs(gmst - expected) > LAL_PI / 43200.)
+    {
+      fprintf(stderr, "GMST at 1994-11-16 0h UT is %.12g, expected %.12g\n", gmst, expected);
+      return 1;
+    }
+
+  /*
+   * The batched and gridded sidereal times agree exactly with
+   * XLALGreenwichMeanSiderealTime(), including across the leap second
+   * at 2017-01-01
+   */
+  gps.gpsSeconds = 1167264017 - 8;
+  gps.gpsNanoSeconds = 0;
+  for (i = 0; i < 64; i++)
+    {
+      gpstimes[i] = gps;
+      XLALGPSAdd(&gpstimes[i], i * 0.25);
+    }
+  if (XLALGreenwichMeanSiderealTimes(gmsts, gpstimes, 64) < 0)
+    {
+      fprintf(stderr, "XLALGreenwichMeanSiderealTimes() failed\n");
+      return 1;
+    }
+  for (i = 0; i < 64; i++)
+    if (gmsts[i] != XLALGreenwichMeanSiderealTime(&gpstimes[i]))
+      {
+        fprintf(stderr, "XLALGreenwichMeanSiderealTimes() differs at GPS %d.%09d\n", gpstimes[i].gpsSeconds, gpstimes[i].gpsNanoSeconds);
+        return 1;
+      }
+  if (XLALGreenwichMeanSiderealTimeGrid(gmsts, &gps, 0.25, 64) < 0)
+    {
+      fprintf(stderr, "XLALGreenwichMeanSiderealTimeGrid() failed\n");
+      return 1;
+    }
+  for (i = 0; i < 64; i++)
+    if (gmsts[i] != XLALGreenwichMeanSiderealTime(&gpstimes[i]))
+      {
+        fprintf(stderr, "XLALGreenwichMeanSiderealTimeGrid() differs at GPS %d.%09d\n", gpstimes[i].gpsSeconds, gpstimes[i].gpsNanoSeconds);
+        return 1;
+      }
+
+  /*
+   * The first leap second, 1981-06-30 23:59:60, and the start of the leap
+   * second table are valid times.  During a leap second the Julian day is
+   * that of the following 00:00:00, so the sidereal time does not advance.
+   */
+  gps.gpsSeconds = 46828800;
+  gps.gpsNanoSeconds = 0;
+  gmsts[0] = XLALGreenwichMeanSiderealTime(&gps);
+  gps.gpsSeconds = 46828801;
+  gmsts[1] = XLALGreenwichMeanSiderealTime(&gps);
+  gps.gpsSeconds = 46828799;
+  gmsts[2] = XLALGreenwichMeanSiderealTime(&gps);
+  if (XLAL_IS_REAL8_FAIL_NAN(gmsts[0]) || gmsts[0] != gmsts[1] || !(gmsts[2] < gmsts[0]))
+    {
+      fprintf(stderr, "GMST at the leap second GPS 46828800 is %.17g, expected %.17g\n", gmsts[0], gmsts[1]);
+      return 1;
+    }
+  if (XLALGreenwichMeanSiderealTimeGrid(gmsts, &gps, 1.0, 3) < 0 || gmsts[1] != gmsts[2])
+    {
+      fprintf(stderr, "XLALGreenwichMeanSiderealTimeGrid() failed across the leap second GPS 46828800\n");
+      return 1;
+    }
+  gps.gpsSeconds = -43200;
+  if (XLAL_IS_REAL8_FAIL_NAN(XLALGreenwichMeanSiderealTime(&gps)) || XLALGreenwichMeanSiderealTimeGrid(gmsts, &gps, 1.0, 3) < 0)
+    {
+      fprintf(stderr, "GMST failed at GPS -43200, the start of the leap second table\n");
+      return 1;
+    }
+
+  LALCheckMemoryLeaks();
   return 0;
 }
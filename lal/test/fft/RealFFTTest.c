@@ -168,6 +168,58 @@ int main( int argc, char *argv[] )
     rev = XLALCreateReverseREAL4FFTPlan( n, 0 );
     TestStatus( &status, CODES( 0 ), 1 );
 
+#if defined(LAL_FFTW3_ENABLED) && !defined(LAL_CUDA_ENABLED)
+    /* check that plans with the same parameters are shared */
+    {
+      RealFFTPlan *fwd2 = XLALCreateForwardREAL4FFTPlan( n, 0 );
+      if ( fwd2 != fwd || rev == fwd )
+      {
+        fprintf( stderr, "FAIL: plans for size %d not shared correctly\n", n );
+        return 1;
+      }
+      XLALDestroyREAL4FFTPlan( fwd2 );
+    }
+#endif
+
+    /* check that a batched transform agrees with single transforms */
+    {
+      const UINT4 howmany = 3;
+      RealFFTPlan *fwdm = XLALCreateREAL4FFTPlanMany( n, howmany, 1, 0 );
+      REAL4VectorSequence *datm = XLALCreateREAL4VectorSequence( howmany, n );
+      COMPLEX8VectorSequence *fftm = XLALCreateCOMPLEX8VectorSequence( howmany, n / 2 + 1 );
+      if ( ! fwdm || ! datm || ! fftm )
+      {
+        fprintf( stderr, "FAIL: could not create batched plan for size %d\n", n );
+        return 1;
+      }
+      srand( n );
+      for ( j = 0; j < howmany * n; ++j )
+        datm->data[j] = 20.0 * rand() / (REAL4)( RAND_MAX + 1.0 ) - 10.0;
+      if ( XLALREAL4ForwardFFTMany( fftm, datm, fwdm ) != 0 )
+      {
+        fprintf( stderr, "FAIL: batched transform of size %d failed\n", n );
+        return 1;
+      }
+      for ( j = 0; j < howmany; ++j )
+      {
+        for ( k = 0; k < n; ++k )
+          dat->data[k] = datm->data[j * n + k];
+        XLALREAL4ForwardFFT( fft, dat, fwd );
+        for ( k = 0; k <= n / 2; ++k )
+        {
+          REAL8 err = cabs( fft->data[k] - fftm->data[j * ( n / 2 + 1 ) + k] );
+          if ( err > 100 * eps * ( cabs( fft->data[k] ) + 1 ) )
+          {
+            fprintf( stderr, "FAIL: batched transform of size %d differs\n", n );
+            return 1;
+          }
+        }
+      }
+      XLALDestroyCOMPLEX8VectorSequence( fftm );
+      XLALDestroyREAL4VectorSequence( datm );
+      XLALDestroyREAL4FFTPlan( fwdm );
+    }
+
     /*
      *
      * Do m trials of random data.
@@ -109,6 +109,33 @@ print(lal.MarcumQmodified(1., 31.9999999999, 32.0000000001), lal.MarcumQmodified
 print(lal.MarcumQmodified(1., 32., 32.), lal.MarcumQmodified(1., 32., 32.))
 
 
+#
+# inverse and vector functions
+#
+
+
+print()
+for M, a, Q in [(1., 3., 0.5), (1., 8., 1e-6), (4., 2., 0.9), (20., 5., 1e-12)]:
+	b = lal.MarcumQInverse(M, a, Q)
+	rel_err_q = abs(lal.MarcumQ(M, a, b) - Q) / Q
+	print("Q_%g(%g, %.16g) = %.16g\t%.16g" % (M, a, b, Q, rel_err_q))
+	assert rel_err_q < 1e-10
+
+b = lal.CreateREAL8Vector(5)
+b.data = [0., 1., 2., 4., 8.]
+Q = lal.CreateREAL8Vector(5)
+lal.MarcumQVector(Q, 2., 3., b)
+for i in range(5):
+	assert Q.data[i] == lal.MarcumQ(2., 3., b.data[i])
+b_inv = lal.CreateREAL8Vector(5)
+lal.MarcumQInverseVector(b_inv, 2., 3., Q)
+for i in range(5):
+	assert abs(b_inv.data[i] - b.data[i]) < 1e-8 * max(b.data[i], 1.)
+
+x = lal.NoncentralChisqCCDFInverse(0.1, 4., 10.)
+assert abs(lal.NoncentralChisqCCDF(x, 4., 10.) - 0.1) < 1e-11
+
+
 #
 # =============================================================================
 #
@@ -57,6 +57,7 @@
 #include <lal/LALStdlib.h>
 #include <lal/LALgetopt.h>
 #include <lal/LALChisq.h>
+#include <lal/AVFactories.h>
 
 int verbose = 1;
 
@@ -160,6 +161,49 @@ static void ParseOptions(int argc, char *argv[])
 } while(0)
 
 
+#define CHECKXLALLogChisqCCDFInverse(ln_prob, dof, acc) do { \
+	char msg[100]; \
+	sprintf(msg, "XLALLogChisqCCDF(XLALLogChisqCCDFInverse(%.17g, %.17g))", ln_prob, dof); \
+	CHECKOUTPUT(msg, XLALLogChisqCCDF(XLALLogChisqCCDFInverse(ln_prob, dof), dof), ln_prob, acc); \
+} while(0)
+
+
+/*
+ * Check the vector functions against the scalar functions
+ */
+
+static void CheckVectors(double dof)
+{
+	const double chi2[] = {0.5, 2.3, 8., 1.2e3, 2e4};
+	const UINT4 n = sizeof(chi2) / sizeof(*chi2);
+	REAL8Vector *in = XLALCreateREAL8Vector(n);
+	REAL8Vector *ln_prob = XLALCreateREAL8Vector(n);
+	REAL8Vector *out = XLALCreateREAL8Vector(n);
+	UINT4 i;
+
+	if(!in || !ln_prob || !out) {
+		fprintf(stderr, "could not allocate vectors\n");
+		exit(1);
+	}
+	memcpy(in->data, chi2, sizeof(chi2));
+	if(XLALLogChisqCCDFVector(ln_prob, in, dof) != XLAL_SUCCESS || XLALLogChisqCCDFInverseVector(out, ln_prob, dof) != XLAL_SUCCESS) {
+		fprintf(stderr, "vector functions returned error with dof=%g\n", dof);
+		exit(1);
+	}
+	for(i = 0; i < n; i++) {
+		char msg[100];
+		sprintf(msg, "XLALLogChisqCCDFVector(%.17g, %.17g)", chi2[i], dof);
+		CHECKOUTPUT(msg, ln_prob->data[i], XLALLogChisqCCDF(chi2[i], dof), 0.);
+		sprintf(msg, "XLALLogChisqCCDFInverseVector(%.17g, %.17g)", ln_prob->data[i], dof);
+		CHECKOUTPUT(msg, out->data[i], XLALLogChisqCCDFInverse(ln_prob->data[i], dof), 0.);
+	}
+
+	XLALDestroyREAL8Vector(in);
+	XLALDestroyREAL8Vector(ln_prob);
+	XLALDestroyREAL8Vector(out);
+}
+
+
 /*
  * Entry point
  */
@@ -188,6 +232,25 @@ int main(int argc, char *argv[])
 	CHECKXLALLogChisqCCDF(1.2e3, 8., -582.59596635081904, 1e-15);
 	CHECKXLALLogChisqCCDF(2e4, 1e4, -1539.4420486763690, 1e-15);
 
+	/*
+	 * Check the inverse by round trip, for intermediate, large, and
+	 * very small probabilities.
+	 */
+
+	CHECKXLALLogChisqCCDFInverse(-1e-10, 8., 1e-12);
+	CHECKXLALLogChisqCCDFInverse(-0.030040797756978235, 8., 1e-12);
+	CHECKXLALLogChisqCCDFInverse(-2.9095189371057191, 0.5, 1e-12);
+	CHECKXLALLogChisqCCDFInverse(-10., 64., 1e-12);
+	CHECKXLALLogChisqCCDFInverse(-582.59596635081904, 8., 1e-12);
+	CHECKXLALLogChisqCCDFInverse(-1539.4420486763690, 1e4, 1e-12);
+
+	/*
+	 * Check the vector functions.
+	 */
+
+	CheckVectors(8.);
+	CheckVectors(64.);
+
 	/*
 	 * Done.
 	 */
@@ -195,5 +258,6 @@ int main(int argc, char *argv[])
 	if(verbose)
 		printf("PASS: all tests\n");
 
+	LALCheckMemoryLeaks();
 	return 0;
 }
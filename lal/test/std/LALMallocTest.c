@@ -332,6 +332,143 @@ static int stressTestRealloc( void )
   XLALClobberDebugLevel(keep);
   return 0;
 }
+
+/* test the per-call-site allocation statistics */
+static int testStatistics( void )
+{
+  static const char site[] = "LALMallocTest-site";
+  const char *fname = "LALMallocTest-statistics.txt";
+  const int siteline = 7;
+  char buf[1024], name[256], expname[256];
+  size_t peak = 0, current = 0, total = 0, count = 0;
+  int found = 0;
+  int keep = lalDebugLevel;
+  FILE *fp;
+
+  XLALClobberDebugLevel(lalDebugLevel | LALERROR | LALMEMDBGBIT | LALMEMPADBIT | LALMEMTRKBIT);
+
+  /* allocate 100, 200, and 300 bytes, free 200 bytes, then allocate 50 bytes, all from the same site */
+  trial( p = LALMallocLong( 100, site, siteline ), 0, "" );
+  trial( q = LALMallocLong( 200, site, siteline ), 0, "" );
+  trial( r = LALMallocLong( 300, site, siteline ), 0, "" );
+  trial( LALFree( q ), 0, "" );
+  trial( s = LALMallocLong( 50, site, siteline ), 0, "" );
+
+  /* print statistics of all sites to a file, and find the test site */
+  if ( freopen( fname, "w", stderr ) == NULL ) die( unable to open statistics file );
+  trial( LALPrintMemoryStatistics( 0 ), 0, "" );
+  if ( freopen( "/dev/null", "w", stderr ) == NULL ) die( unable to open /dev/null );
+  if ( ( fp = fopen( fname, "r" ) ) == NULL ) die( unable to read statistics file );
+  snprintf( expname, sizeof( expname ), "%s:%d", site, siteline );
+  while ( fgets( buf, sizeof( buf ), fp ) != NULL )
+  {
+    if ( sscanf( buf, "%zu %zu %zu %zu %255s", &peak, &current, &total, &count, name ) == 5 && strcmp( name, expname ) == 0 )
+    {
+      found = 1;
+      break;
+    }
+  }
+  fclose( fp );
+  remove( fname );
+  if ( ! found ) die( statistics of call site not printed );
+  if ( peak != 600 ) die( wrong peak bytes of call site );
+  if ( current != 450 ) die( wrong current bytes of call site );
+  if ( total != 650 ) die( wrong total bytes of call site );
+  if ( count != 4 ) die( wrong number of allocations of call site );
+
+  trial( LALFree( p ), 0, "" );
+  trial( LALFree( r ), 0, "" );
+  trial( LALFree( s ), 0, "" );
+  trial( LALCheckMemoryLeaks(), 0, "" );
+  XLALClobberDebugLevel(keep);
+  return 0;
+}
+
+/* test the NUMA placed allocation routines */
+static int testPlaced( void )
+{
+  const size_t nmax = 1 << 20;
+  const LALMemoryPlacement placements[] = { LAL_MEMORY_PLACEMENT_DEFAULT, LAL_MEMORY_PLACEMENT_INTERLEAVE, LAL_MEMORY_PLACEMENT_LOCAL };
+  int keep = lalDebugLevel;
+
+  XLALClobberDebugLevel(lalDebugLevel | LALMEMDBGBIT | LALMEMPADBIT | LALMEMTRKBIT);
+
+  for ( i = 0; i < sizeof( placements ) / sizeof( placements[0] ); ++i )
+  {
+    for ( n = 1; n <= nmax; n *= 16 )
+    {
+      trial( p = XLALMallocPlaced( n * sizeof( *p ), placements[i] ), 0, "" );
+      if ( ! p ) die( placed allocation failed );
+      if ( ( (size_t) p ) % 4096 ) die( placed allocation not page aligned );
+      for ( j = 0; j < n; ++j ) p[j] = j;
+      if ( XLALSetMemoryPlacement( p, n * sizeof( *p ), placements[( i + 1 ) % 3] ) != XLAL_SUCCESS ) die( setting memory placement failed );
+      for ( j = 0; j < n; ++j )
+        if ( p[j] != j ) die( wrong contents );
+      XLALFreePlaced( p );
+    }
+  }
+
+  /* invalid arguments */
+  if ( XLALSetMemoryPlacement( NULL, 1, LAL_MEMORY_PLACEMENT_LOCAL ) != XLAL_FAILURE ) die( null pointer not detected );
+  XLALClearErrno();
+  if ( XLALSetMemoryPlacement( &n, sizeof( n ), LAL_MEMORY_PLACEMENT_MAX ) != XLAL_FAILURE ) die( invalid placement not detected );
+  XLALClearErrno();
+
+  /* placed allocations are not tracked */
+  trial( LALCheckMemoryLeaks(), 0, "" );
+  XLALClobberDebugLevel(keep);
+  return 0;
+}
+
+/* test the huge page allocation routines */
+static int testHugePages( void )
+{
+  const size_t big = 8 << 20;
+  const LALHugePageMode modes[] = { LAL_HUGE_PAGES_OFF, LAL_HUGE_PAGES_TRANSPARENT, LAL_HUGE_PAGES_EXPLICIT };
+  size_t threshold = 0;
+  int keep = lalDebugLevel;
+  const LALHugePageMode keepMode = XLALGetHugePages( &threshold );
+
+  XLALClobberDebugLevel(lalDebugLevel | LALMEMDBGBIT | LALMEMPADBIT | LALMEMTRKBIT);
+
+  for ( i = 0; i < sizeof( modes ) / sizeof( modes[0] ); ++i )
+  {
+    LALHugePageMode mode;
+    if ( XLALSetHugePages( modes[i], big / 2 ) != XLAL_SUCCESS ) die( setting huge page mode failed );
+    if ( XLALGetHugePages( &n ) != modes[i] || n != big / 2 ) die( wrong huge page mode );
+
+    /* small allocations never get huge pages */
+    trial( p = XLALMalloc( 16 * sizeof( *p ) ), 0, "" );
+    if ( XLALHugePageAllocation( p ) != LAL_HUGE_PAGES_OFF ) die( small allocation got huge pages );
+
+    /* large allocations may get huge pages, if the mode allows; explicit huge pages are only mapped by XLALMallocPlaced() */
+    trial( q = XLALMalloc( big ), 0, "" );
+    mode = XLALHugePageAllocation( q );
+    if ( modes[i] == LAL_HUGE_PAGES_OFF ? mode != LAL_HUGE_PAGES_OFF : mode == LAL_HUGE_PAGES_EXPLICIT ) die( wrong huge page mode for large allocation );
+    trial( q = XLALRealloc( q, 2 * big ), 0, "" );
+    trial( r = XLALMallocPlaced( big, LAL_MEMORY_PLACEMENT_DEFAULT ), 0, "" );
+    mode = XLALHugePageAllocation( r );
+    if ( modes[i] == LAL_HUGE_PAGES_OFF ? mode != LAL_HUGE_PAGES_OFF : mode > modes[i] ) die( wrong huge page mode for placed allocation );
+    if ( lalMallocHugePageCount != (size_t) ( ( XLALHugePageAllocation( q ) != LAL_HUGE_PAGES_OFF ) + ( mode != LAL_HUGE_PAGES_OFF ) ) ) die( wrong huge page count );
+    for ( j = 0; j < big / sizeof( *r ); ++j ) r[j] = j;
+    for ( j = 0; j < big / sizeof( *r ); ++j )
+      if ( r[j] != j ) die( wrong contents );
+
+    XLALFree( p );
+    XLALFree( q );
+    XLALFreePlaced( r );
+    if ( lalMallocHugePageCount != 0 || lalMallocHugePageTotal != 0 ) die( huge page allocations not forgotten );
+  }
+
+  /* invalid arguments */
+  if ( XLALSetHugePages( LAL_HUGE_PAGES_MAX, 0 ) != XLAL_FAILURE ) die( invalid huge page mode not detected );
+  XLALClearErrno();
+
+  if ( XLALSetHugePages( keepMode, threshold ) != XLAL_SUCCESS ) die( restoring huge page mode failed );
+  trial( LALCheckMemoryLeaks(), 0, "" );
+  XLALClobberDebugLevel(keep);
+  return 0;
+}
 #endif
 
 
@@ -357,7 +494,11 @@ int main( void )
   if ( testPadding() ) return 1;
   if ( testAllocList() ) return 1;
   if ( stressTestRealloc() ) return 1;
+  if ( testStatistics() ) return 1;
+  if ( testPlaced() ) return 1;
+  if ( testHugePages() ) return 1;
 
+  trial( LALPrintMemoryStatistics( 0 ), 0, "" );
   trial( LALCheckMemoryLeaks(), 0, "" );
 
   return 0;
@@ -0,0 +1,106 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALStdio.h>
+#include <lal/LALProfile.h>
+#include <lal/XLALError.h>
+
+#define CSVFILE "LALProfileTest.csv"
+#define JSONFILE "LALProfileTest.json"
+
+/* annotated function, called with and without profiling */
+static int annotated( UINT8 n )
+{
+  XLAL_PROFILE_BEGIN( timer, "annotated" );
+  XLAL_PROFILE_COUNT( "annotated:n", n );
+  volatile REAL8 x = 0;
+  for ( UINT8 i = 0; i < 1000; ++i ) {
+    x += i;
+  }
+  XLAL_PROFILE_END( timer );
+  return XLAL_SUCCESS;
+}
+
+/* find the line of a CSV file for a named timer or counter */
+static int read_csv( const char *name, UINT8 *ncalls, UINT8 *count )
+{
+  char line[256], fmt[64];
+  FILE *fp = fopen( CSVFILE, "r" );
+  XLAL_CHECK( fp != NULL, XLAL_EIO );
+  XLAL_CHECK( fgets( line, sizeof( line ), fp ) != NULL && strcmp( line, "name,calls,count,seconds,max_seconds\n" ) == 0, XLAL_EFAILED, "Bad CSV header" );
+  snprintf( fmt, sizeof( fmt ), "\"%s\",%%" LAL_UINT8_FORMAT ",%%" LAL_UINT8_FORMAT, name );
+  int found = 0;
+  while ( !found && fgets( line, sizeof( line ), fp ) != NULL ) {
+    found = sscanf( line, fmt, ncalls, count ) == 2;
+  }
+  fclose( fp );
+  XLAL_CHECK( found, XLAL_EFAILED, "'%s' not found in CSV file", name );
+  return XLAL_SUCCESS;
+}
+
+int main( void )
+{
+  UINT8 ncalls = 0, count = 0;
+  char buf[1024];
+  size_t len;
+  int errnum = 0;
+  FILE *fp;
+
+  /* nothing is accumulated while disabled */
+  XLAL_CHECK_MAIN( XLALProfileSetEnabled( 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( !XLALProfileEnabled(), XLAL_EFAILED );
+  XLAL_CHECK_MAIN( annotated( 5 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALProfileDump( CSVFILE ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_TRY_SILENT( read_csv( "annotated", &ncalls, &count ), errnum );
+  XLAL_CHECK_MAIN( errnum != 0, XLAL_EFAILED, "Timer accumulated while profiling was disabled" );
+
+  /* timers and counters are accumulated while enabled */
+  XLAL_CHECK_MAIN( XLALProfileSetEnabled( 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALProfileEnabled(), XLAL_EFAILED );
+  for ( UINT8 n = 1; n <= 10; ++n ) {
+    XLAL_CHECK_MAIN( annotated( n ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  XLAL_CHECK_MAIN( XLALProfileDump( CSVFILE ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( read_csv( "annotated", &ncalls, &count ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( ncalls == 10 && count == 0, XLAL_EFAILED, "Timer has calls=%" LAL_UINT8_FORMAT " count=%" LAL_UINT8_FORMAT, ncalls, count );
+  XLAL_CHECK_MAIN( read_csv( "annotated:n", &ncalls, &count ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( ncalls == 10 && count == 55, XLAL_EFAILED, "Counter has calls=%" LAL_UINT8_FORMAT " count=%" LAL_UINT8_FORMAT, ncalls, count );
+
+  /* JSON output */
+  XLAL_CHECK_MAIN( XLALProfileDump( JSONFILE ) == XLAL_SUCCESS, XLAL_EFUNC );
+  fp = fopen( JSONFILE, "r" );
+  XLAL_CHECK_MAIN( fp != NULL, XLAL_EIO );
+  len = fread( buf, 1, sizeof( buf ) - 1, fp );
+  buf[len] = '\0';
+  fclose( fp );
+  XLAL_CHECK_MAIN( buf[0] == '[' && strstr( buf, "{\"name\": \"annotated:n\", \"calls\": 10, \"count\": 55," ) != NULL, XLAL_EFAILED, "Bad JSON file:\n%s", buf );
+
+  /* reset clears accumulated values */
+  XLALProfileReset();
+  XLAL_CHECK_MAIN( XLALProfileDump( CSVFILE ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( read_csv( "annotated:n", &ncalls, &count ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( ncalls == 0 && count == 0, XLAL_EFAILED );
+
+  remove( CSVFILE );
+  remove( JSONFILE );
+  LALCheckMemoryLeaks();
+  return EXIT_SUCCESS;
+}
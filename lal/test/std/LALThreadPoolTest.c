@@ -0,0 +1,99 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALThreadPool.h>
+#include <lal/XLALError.h>
+
+#define NOUTER 37
+#define NINNER 101
+
+typedef struct {
+  int *counts;
+  size_t fail;
+} TestWork;
+
+/* count how often each task is run, and check nesting depth */
+static int inner_task( void *arg, size_t i )
+{
+  TestWork *work = arg;
+  if ( XLALThreadPoolDepth() != 2 ) {
+    XLAL_ERROR( XLAL_EFAILED, "Inner task %zu has depth %i", i, XLALThreadPoolDepth() );
+  }
+  if ( i == work->fail ) {
+    XLAL_ERROR( XLAL_EDOM, "Inner task %zu failed as requested", i );
+  }
+  ++work->counts[i];
+  return XLAL_SUCCESS;
+}
+
+static int outer_task( void *arg, size_t i )
+{
+  TestWork *work = arg;
+  TestWork inner = { work->counts + i * NINNER, (size_t)-1 };
+  if ( XLALThreadPoolDepth() != 1 ) {
+    XLAL_ERROR( XLAL_EFAILED, "Outer task %zu has depth %i", i, XLALThreadPoolDepth() );
+  }
+  if ( work->fail == i ) {
+    inner.fail = NINNER / 2;
+  }
+  XLAL_CHECK( XLALThreadPoolRun( inner_task, &inner, NINNER ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+static int run_nested( int nthreads )
+{
+  int counts[NOUTER * NINNER] = { 0 };
+  TestWork work = { counts, (size_t)-1 };
+
+  XLAL_CHECK( XLALThreadPoolSetMaxThreads( nthreads ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALThreadPoolGetMaxThreads() == nthreads, XLAL_EFAILED );
+
+  /* every task must be run exactly once */
+  XLAL_CHECK( XLALThreadPoolRun( outer_task, &work, NOUTER ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALThreadPoolDepth() == 0, XLAL_EFAILED );
+  for ( size_t i = 0; i < NOUTER * NINNER; ++i ) {
+    XLAL_CHECK( counts[i] == 1, XLAL_EFAILED, "Task %zu was run %i times with %i threads", i, counts[i], nthreads );
+  }
+
+  /* a failed task must fail the whole call with the error number of the task */
+  work.fail = NOUTER / 3;
+  int errnum = 0;
+  XLAL_TRY_SILENT( XLALThreadPoolRun( outer_task, &work, NOUTER ), errnum );
+  XLAL_CHECK( ( errnum & ~XLAL_EFUNC ) == XLAL_EDOM, XLAL_EFAILED, "Failed task gave error %i with %i threads", errnum, nthreads );
+  XLAL_CHECK( XLALThreadPoolDepth() == 0, XLAL_EFAILED );
+
+  fprintf( stderr, "PASSED nested tasks with %i threads\n", nthreads );
+  return XLAL_SUCCESS;
+}
+
+int main( void )
+{
+  const int nthreads = XLALThreadPoolGetMaxThreads();
+  XLAL_CHECK_MAIN( nthreads >= 1, XLAL_EFAILED );
+  XLAL_CHECK_MAIN( XLALThreadPoolRun( inner_task, NULL, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( run_nested( 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( run_nested( 2 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( run_nested( 8 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALThreadPoolSetMaxThreads( 0 ) != XLAL_SUCCESS, XLAL_EFAILED );
+  XLALClearErrno();
+  XLAL_CHECK_MAIN( XLALThreadPoolSetMaxThreads( nthreads ) == XLAL_SUCCESS, XLAL_EFUNC );
+  LALCheckMemoryLeaks();
+  return EXIT_SUCCESS;
+}
@@ -191,6 +191,25 @@ int main ( int argc, char *argv[])
   XLALFree (string1);
   XLALFree (string2);
   XLALFree (string3);
+  string1 = string2 = string3 = NULL;
+
+  // ---------- TEST 4: check which definitions are read from repeated sections and variables ----------
+  XLAL_CHECK ( XLALParseDataFileContent ( &cfgdata, "int1 = 1\n[ section1 ]\nint1 = 2; int1 = 3\nint2 = 4\n[ section2 ]\n"
+                                          "= 5\nint1 = 6\n[section1]\nint1 = 7\nint3 = 8" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  INT4 int1 = 0, int2 = 0, int3 = 0;
+  XLAL_CHECK ( XLALReadConfigINT4Variable ( &int1, cfgdata, NULL, "int1", &wasRead ) == XLAL_SUCCESS && wasRead && int1 == 1, XLAL_EFAILED );
+  XLAL_CHECK ( XLALReadConfigINT4Variable ( &int1, cfgdata, "section1", "int1", &wasRead ) == XLAL_SUCCESS && wasRead && int1 == 2, XLAL_EFAILED );
+  XLAL_CHECK ( XLALReadConfigINT4Variable ( &int2, cfgdata, "section1", "int2", &wasRead ) == XLAL_SUCCESS && wasRead && int2 == 4, XLAL_EFAILED );
+  XLAL_CHECK ( XLALReadConfigINT4Variable ( &int3, cfgdata, "section1", "int3", &wasRead ) == XLAL_SUCCESS && !wasRead, XLAL_EFAILED );
+  XLAL_CHECK ( XLALReadConfigINT4Variable ( &int2, cfgdata, "section3", "int2", &wasRead ) == XLAL_SUCCESS && !wasRead, XLAL_EFAILED );
+  int errnum;
+  XLAL_TRY_SILENT( XLALReadConfigINT4Variable ( &int1, cfgdata, "section2", "int1", &wasRead ), errnum );
+  XLAL_CHECK ( errnum != 0, XLAL_EFAILED, "Missing variable name in section2 was not detected\n" );
+  XLAL_CHECK ( (unread = XLALConfigFileGetUnreadEntries ( cfgdata )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( unread->length == 5, XLAL_EFAILED, "%u unread entries, expected 5\n", unread->length );
+  XLALDestroyUINT4Vector ( unread );
+  XLALDestroyParsedDataFile (cfgdata);
+  cfgdata = NULL;
 
   // -----
   LALCheckMemoryLeaks();
@@ -0,0 +1,119 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/AVFactories.h>
+#include <lal/FileIO.h>
+
+#define NROWS 1000
+#define NCOLS 3
+
+/* write a table with comments and irregular whitespace, without a final newline */
+static int write_table(const char *path, int compression, REAL8 *data)
+{
+	LALFILE *fp = XLALFileOpenWrite(path, compression);
+	UINT4 i, j;
+	if (!fp)
+		return -1;
+	XLALFilePrintf(fp, "%% table header\n\n");
+	for (i = 0; i < NROWS; i++) {
+		for (j = 0; j < NCOLS; j++) {
+			data[i * NCOLS + j] = (2. * rand() / RAND_MAX - 1.) * pow(10., rand() % 40 - 20);
+			XLALFilePrintf(fp, j ? (j % 2 ? "\t%.17g" : "  %.17g") : "%.17g", data[i * NCOLS + j]);
+		}
+		if (i % 7 == 0)
+			XLALFilePrintf(fp, " # comment");
+		if (i + 1 < NROWS)
+			XLALFilePrintf(fp, "\n");
+	}
+	return XLALFileClose(fp);
+}
+
+/* reading line-by-line from memory gives the same lines as reading from a stream */
+static int test_lines(const char *path)
+{
+	LALFILE *stream = XLALFileOpenRead(path);
+	LALFILE *mapped = XLALFileOpenReadMapped(path);
+	char line1[64], line2[64];
+	char *s1, *s2;
+	long numLines = 0;
+	if (!stream || !mapped) {
+		fprintf(stderr, "%s: could not open file\n", path);
+		return 1;
+	}
+	do {
+		s1 = XLALFileGets(line1, sizeof(line1), stream);
+		s2 = XLALFileGets(line2, sizeof(line2), mapped);
+		if ((s1 == NULL) != (s2 == NULL) || (s1 && strcmp(s1, s2))) {
+			fprintf(stderr, "%s: line %ld differs when read from memory\n", path, numLines);
+			return 1;
+		}
+		++numLines;
+	} while (s1);
+	if (!XLALFileEOF(mapped) || XLALFileTell(mapped) != (long) XLALFileTell(stream)) {
+		fprintf(stderr, "%s: wrong position at end of file read from memory\n", path);
+		return 1;
+	}
+	XLALFileRewind(mapped);
+	if (XLALFileGetc(mapped) != '%' || XLALFileWrite("x", 1, 1, mapped) != (size_t) XLAL_FAILURE) {
+		fprintf(stderr, "%s: wrong behaviour after rewinding file read from memory\n", path);
+		return 1;
+	}
+	XLALClearErrno();
+	XLALFileClose(mapped);
+	XLALFileClose(stream);
+	return 0;
+}
+
+static int test_table(const char *path, const REAL8 *data)
+{
+	REAL8Array *table = XLALFileLoadREAL8Table(path);
+	if (!table || table->dimLength->length != 2 || table->dimLength->data[0] != NROWS || table->dimLength->data[1] != NCOLS) {
+		fprintf(stderr, "%s: table has wrong dimensions\n", path);
+		return 1;
+	}
+	if (memcmp(table->data, data, NROWS * NCOLS * sizeof(*data))) {
+		fprintf(stderr, "%s: table has wrong contents\n", path);
+		return 1;
+	}
+	XLALDestroyREAL8Array(table);
+	return 0;
+}
+
+int main(void)
+{
+	static REAL8 data[NROWS * NCOLS];
+	int failed = 0;
+
+	if (write_table("FileIOTest.dat", 0, data) < 0)
+		return 1;
+	failed |= test_lines("FileIOTest.dat");
+	failed |= test_table("FileIOTest.dat", data);
+
+	if (write_table("FileIOTest.dat.gz", 1, data) < 0)
+		return 1;
+	failed |= test_lines("FileIOTest.dat.gz");
+	failed |= test_table("FileIOTest.dat.gz", data);
+
+	LALCheckMemoryLeaks();
+	return failed;
+}
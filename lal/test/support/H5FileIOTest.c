@@ -5,6 +5,7 @@ int main(void) { return 77; /* don't do any testing */ }
 #else
 
 #include <limits.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <lal/LALStdlib.h>
@@ -291,6 +292,137 @@ DEFINE_FREQUENCY_SERIES_FUNCTIONS(COMPLEX8FrequencySeries)
 DEFINE_FREQUENCY_SERIES_FUNCTIONS(COMPLEX16FrequencySeries)
 #undef GENERATE_DATA
 
+/* CHUNKED DATASET ROUTINES */
+
+/* writes a chunked, compressed dataset in two slices and reads it back */
+static void test_chunked_slices(void)
+{
+	REAL8 data[NPTS];
+	REAL8 copy[NPTS];
+	REAL8 slice[DIM1 * DIM2];
+	LALH5File *file;
+	LALH5Dataset *dset;
+	UINT4Vector *dims;
+	UINT4Vector *start;
+	UINT4Vector *cnt;
+	size_t i;
+
+	fprintf(stderr, "Testing Read/Write of chunked dataset slices...");
+	for (i = 0; i < NPTS; ++i)
+		data[i] = generate_float_data();
+
+	dims = XLALCreateUINT4Vector(NDIM);
+	start = XLALCreateUINT4Vector(NDIM);
+	cnt = XLALCreateUINT4Vector(NDIM);
+	dims->data[0] = DIM0;
+	dims->data[1] = DIM1;
+	dims->data[2] = DIM2;
+
+	/* write the dataset as two slices along the slowest dimension */
+	file = XLALH5FileOpen(FNAME, "w");
+	dset = XLALH5DatasetAllocChunked(file, DSET, LAL_D_TYPE_CODE, dims, NULL, 6);
+	start->data[1] = start->data[2] = 0;
+	cnt->data[0] = 1;
+	cnt->data[1] = DIM1;
+	cnt->data[2] = DIM2;
+	for (i = DIM0; i-- > 0;) {
+		start->data[0] = i;
+		XLALH5DatasetWriteSlice(dset, data + i * DIM1 * DIM2, start, cnt);
+	}
+	XLALH5DatasetFree(dset);
+	XLALH5FileClose(file);
+
+	file = XLALH5FileOpen(FNAME, "r");
+	dset = XLALH5DatasetRead(file, DSET);
+	XLALH5DatasetQueryData(copy, dset);
+	if (memcmp(data, copy, sizeof(data))) {
+		fprintf(stderr, " FAIL\n");
+		exit(1); /* fail */
+	}
+
+	/* read back a slice spanning both halves */
+	start->data[0] = 0;
+	start->data[1] = 1;
+	start->data[2] = 1;
+	cnt->data[0] = DIM0;
+	cnt->data[1] = DIM1 - 1;
+	cnt->data[2] = DIM2 - 1;
+	XLALH5DatasetQueryDataSlice(slice, dset, start, cnt);
+	for (i = 0; i < DIM0 * (DIM1 - 1) * (DIM2 - 1); ++i) {
+		size_t i0 = i / ((DIM1 - 1) * (DIM2 - 1));
+		size_t i1 = 1 + i / (DIM2 - 1) % (DIM1 - 1);
+		size_t i2 = 1 + i % (DIM2 - 1);
+		if (slice[i] != data[(i0 * DIM1 + i1) * DIM2 + i2]) {
+			fprintf(stderr, " FAIL\n");
+			exit(1); /* fail */
+		}
+	}
+	XLALH5DatasetFree(dset);
+	XLALH5FileClose(file);
+
+	XLALDestroyUINT4Vector(cnt);
+	XLALDestroyUINT4Vector(start);
+	XLALDestroyUINT4Vector(dims);
+	fprintf(stderr, " PASS\n");
+}
+
+/* TABLE ROUTINES */
+
+/* writes a table, reopens the file for appending and adds more rows */
+static void test_table_append(void)
+{
+	struct row { REAL8 x; INT4 k; } data[3], copy[3];
+	const char *cols[] = { "x", "k" };
+	const LALTYPECODE types[] = { LAL_D_TYPE_CODE, LAL_I4_TYPE_CODE };
+	const size_t offsets[] = { offsetof(struct row, x), offsetof(struct row, k) };
+	const size_t colsz[] = { sizeof(data->x), sizeof(data->k) };
+	LALH5File *file;
+	LALH5File *group;
+	LALH5Dataset *dset;
+	size_t i;
+
+	fprintf(stderr, "Testing appending to tables...");
+	for (i = 0; i < 3; ++i) {
+		data[i].x = generate_float_data();
+		data[i].k = generate_int_data();
+	}
+
+	file = XLALH5FileOpen(FNAME, "w");
+	group = XLALH5GroupOpen(file, GROUP);
+	dset = XLALH5TableAlloc(group, DSET, 2, cols, types, offsets, sizeof(*data));
+	XLALH5TableAppend(dset, offsets, colsz, 2, sizeof(*data), data);
+	XLALH5DatasetFree(dset);
+	XLALH5FileClose(group);
+	XLALH5FileClose(file);
+
+	/* the existing group and table are reused when appending */
+	file = XLALH5FileOpen(FNAME, "a");
+	group = XLALH5GroupOpen(file, GROUP);
+	dset = XLALH5DatasetRead(group, DSET);
+	XLALH5TableAppend(dset, offsets, colsz, 1, sizeof(*data), data + 2);
+	XLALH5DatasetFree(dset);
+	XLALH5FileClose(group);
+	XLALH5FileClose(file);
+
+	file = XLALH5FileOpen(FNAME, "r");
+	group = XLALH5GroupOpen(file, GROUP);
+	dset = XLALH5DatasetRead(group, DSET);
+	if (XLALH5TableQueryNRows(dset) != 3) {
+		fprintf(stderr, " FAIL\n");
+		exit(1); /* fail */
+	}
+	XLALH5TableRead(copy, dset, offsets, colsz, sizeof(*data));
+	for (i = 0; i < 3; ++i)
+		if (copy[i].x != data[i].x || copy[i].k != data[i].k) {
+			fprintf(stderr, " FAIL\n");
+			exit(1); /* fail */
+		}
+	XLALH5DatasetFree(dset);
+	XLALH5FileClose(group);
+	XLALH5FileClose(file);
+	fprintf(stderr, " PASS\n");
+}
+
 int main(void)
 {
 	XLALSetErrorHandler(XLALAbortErrorHandler);
@@ -334,6 +466,10 @@ int main(void)
 	test_COMPLEX8FrequencySeries();
 	test_COMPLEX16FrequencySeries();
 
+	test_chunked_slices();
+
+	test_table_append();
+
 	LALCheckMemoryLeaks();
 	return 0;
 }
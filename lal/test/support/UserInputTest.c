@@ -134,6 +134,14 @@ main(int argc, char *argv[])
                                        "This~option~is~here~to~test~the~help~page~wrapping~of~long~strings~without~spaces."
                  ) == XLAL_SUCCESS, XLAL_EFUNC );
 
+  /* ---------- check that long- and short-options must be unique ---------- */
+  int errnum;
+  INT4 dummy2 = 0;
+  XLAL_TRY_SILENT( XLALRegisterNamedUvar( &dummy2, "long_help", INT4, 0, OPTIONAL, "Duplicate long-option" ), errnum );
+  XLAL_CHECK ( errnum == XLAL_EINVAL, XLAL_EFAILED, "Duplicate long-option was registered\n" );
+  XLAL_TRY_SILENT( XLALRegisterNamedUvar( &dummy2, "dummy2", INT4, 'a', OPTIONAL, "Duplicate short-option" ), errnum );
+  XLAL_CHECK ( errnum == XLAL_EINVAL, XLAL_EFAILED, "Duplicate short-option was registered\n" );
+
   /* ---------- now read all input from commandline and config-file ---------- */
   BOOLEAN should_exit = 0;
   if ( argc > 1 ) {
@@ -190,6 +198,11 @@ main(int argc, char *argv[])
 
   XLAL_CHECK ( uvar->longInt == 4294967294, XLAL_EFAILED, "Failed to read an INT8: longInt = %" LAL_INT8_FORMAT " != 4294967294", uvar->longInt );
 
+  /* ---------- test which values were set ---------- */
+  XLAL_CHECK ( XLALUserVarWasSet ( &uvar->argInt ) == 1, XLAL_EFAILED, "argInt should have been set\n" );
+  XLAL_CHECK ( XLALUserVarWasSet ( &uvar->string2 ) == 1, XLAL_EFAILED, "string2 should have been set\n" );
+  XLAL_CHECK ( XLALUserVarWasSet ( &uvar->dummy ) == 0, XLAL_EFAILED, "dummy should not have been set\n" );
+
   /* ----- cleanup ---------- */
   XLALDestroyUserVars();
   for ( int i=0; i < my_argc; i ++ ) {
@@ -0,0 +1,215 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <complex.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <lal/AVFactories.h>
+#include <lal/BandPassTimeSeries.h>
+#include <lal/IIRFilter.h>
+#include <lal/LALStdlib.h>
+#include <lal/ZPGFilter.h>
+
+#define NUM_CHANNELS 7
+
+static const UINT4 lengths[NUM_CHANNELS] = { 0, 1, 1000, 4097, 2500, 300, 8192 };
+
+static REAL8Vector **random_channels(void)
+{
+	REAL8Vector **v = XLALCalloc(NUM_CHANNELS, sizeof(*v));
+	UINT4 i, j;
+	for(i = 0; i < NUM_CHANNELS; i++) {
+		v[i] = XLALCreateREAL8Vector(lengths[i]);
+		for(j = 0; j < lengths[i]; j++)
+			v[i]->data[j] = 2. * rand() / RAND_MAX - 1.;
+	}
+	return v;
+}
+
+static REAL8Vector **copy_channels(REAL8Vector **v)
+{
+	REAL8Vector **c = XLALCalloc(NUM_CHANNELS, sizeof(*c));
+	UINT4 i;
+	for(i = 0; i < NUM_CHANNELS; i++) {
+		c[i] = XLALCreateREAL8Vector(v[i]->length);
+		memcpy(c[i]->data, v[i]->data, v[i]->length * sizeof(*v[i]->data));
+	}
+	return c;
+}
+
+static void destroy_channels(REAL8Vector **v)
+{
+	UINT4 i;
+	for(i = 0; i < NUM_CHANNELS; i++)
+		XLALDestroyREAL8Vector(v[i]);
+	XLALFree(v);
+}
+
+static double max_difference(REAL8Vector **a, REAL8Vector **b)
+{
+	double maxdiff = 0.;
+	UINT4 i, j;
+	for(i = 0; i < NUM_CHANNELS; i++)
+		for(j = 0; j < a[i]->length; j++)
+			if(fabs(a[i]->data[j] - b[i]->data[j]) > maxdiff)
+				maxdiff = fabs(a[i]->data[j] - b[i]->data[j]);
+	return maxdiff;
+}
+
+/* filter each channel with each section in turn, as an individual IIR filter */
+static void reference_filter(REAL8Vector **v, REAL8IIRFilter **sections, UINT4 numSections, int backward)
+{
+	UINT4 i, k;
+	for(i = 0; i < NUM_CHANNELS; i++) {
+		if(!v[i]->length)
+			continue;
+		for(k = 0; k < numSections; k++) {
+			memset(sections[k]->history->data, 0, sections[k]->history->length * sizeof(*sections[k]->history->data));
+			XLALIIRFilterREAL8Vector(v[i], sections[k]);
+		}
+		if(backward)
+			for(k = numSections; k-- > 0;)
+				XLALIIRFilterReverseREAL8Vector(v[i], sections[k]);
+	}
+}
+
+/* a cascade of two second-order and one first-order sections, built from z-plane poles and zeros */
+static REAL8SOSFilter *test_sections(REAL8IIRFilter **sections)
+{
+	const COMPLEX16 poles[3] = { 0.95 * cexp(0.3 * I), 0.7 * cexp(1.1 * I), 0.5 };
+	REAL8SOSFilter *sos = XLALCreateREAL8SOSFilter(3);
+	UINT4 k;
+	for(k = 0; k < 3; k++) {
+		UINT4 order = cimag(poles[k]) ? 2 : 1;
+		COMPLEX16ZPGFilter *zpg = XLALCreateCOMPLEX16ZPGFilter(order, order);
+		zpg->poles->data[0] = poles[k];
+		zpg->zeros->data[0] = -1.;
+		if(order == 2) {
+			zpg->poles->data[1] = conj(poles[k]);
+			zpg->zeros->data[1] = -1.;
+		}
+		zpg->gain = 0.1;
+		sections[k] = XLALCreateREAL8IIRFilter(zpg);
+		XLALREAL8SOSFilterSetSection(sos, k, sections[k]);
+		XLALDestroyCOMPLEX16ZPGFilter(zpg);
+	}
+	return sos;
+}
+
+static int test_cascade(void)
+{
+	REAL8IIRFilter *sections[3];
+	REAL8SOSFilter *sos = test_sections(sections);
+	REAL8Vector **input = random_channels();
+	REAL8Vector **ref, **out;
+	UINT4 warmup = XLALSOSFilterWarmupLength(sos, 1e-13);
+	double diff;
+	int failed = 0;
+	UINT4 k;
+
+	/* forward filtering, channels in lanes */
+	ref = copy_channels(input);
+	out = copy_channels(input);
+	reference_filter(ref, sections, 3, 0);
+	XLALSOSFilterREAL8Vectors(out, NUM_CHANNELS, sos, 0);
+	if((diff = max_difference(ref, out)) > 1e-12) {
+		fprintf(stderr, "forward cascade differs from sequential IIR filters by %g\n", diff);
+		failed = 1;
+	}
+	destroy_channels(out);
+	destroy_channels(ref);
+
+	/* forward-backward filtering of whole vectors */
+	ref = copy_channels(input);
+	out = copy_channels(input);
+	reference_filter(ref, sections, 3, 1);
+	XLALSOSFilterForwardBackwardREAL8Vectors(out, NUM_CHANNELS, sos, 0, 0);
+	if((diff = max_difference(ref, out)) > 1e-12) {
+		fprintf(stderr, "forward-backward cascade differs from sequential IIR filters by %g\n", diff);
+		failed = 1;
+	}
+	destroy_channels(out);
+
+	/* forward-backward filtering in blocks */
+	out = copy_channels(input);
+	XLALSOSFilterForwardBackwardREAL8Vectors(out, NUM_CHANNELS, sos, 700, warmup);
+	if((diff = max_difference(ref, out)) > 1e-10) {
+		fprintf(stderr, "block-parallel forward-backward filtering (warm-up %u) differs by %g\n", warmup, diff);
+		failed = 1;
+	}
+	destroy_channels(out);
+	destroy_channels(ref);
+
+	for(k = 0; k < 3; k++)
+		XLALDestroyREAL8IIRFilter(sections[k]);
+	XLALDestroyREAL8SOSFilter(sos);
+	destroy_channels(input);
+	return failed;
+}
+
+/* the Butterworth cascade agrees with XLALButterworthREAL8TimeSeries() away from the ends */
+static int test_butterworth(INT4 order, REAL8 f1, REAL8 f2)
+{
+	const UINT4 length = 16384, skip = 2048;
+	PassBandParamStruc params = { NULL, order, f1, f2, f1 > 0 ? 0.5 : -1, f2 > 0 ? 0.5 : -1 };
+	REAL8TimeSeries series;
+	REAL8SOSFilter *sos;
+	REAL8Vector *ref = XLALCreateREAL8Vector(length);
+	REAL8Vector *out = XLALCreateREAL8Vector(length);
+	double maxdiff = 0.;
+	int failed = 0;
+	UINT4 j;
+
+	for(j = 0; j < length; j++)
+		ref->data[j] = out->data[j] = 2. * rand() / RAND_MAX - 1.;
+	memset(&series, 0, sizeof(series));
+	series.deltaT = 1. / 4096.;
+	series.data = ref;
+	sos = XLALCreateButterworthREAL8SOSFilter(&params, series.deltaT);
+	if(!sos || XLALButterworthREAL8TimeSeries(&series, &params) < 0) {
+		fprintf(stderr, "order %d Butterworth filter failed\n", order);
+		return 1;
+	}
+	XLALSOSFilterForwardBackwardREAL8Vectors(&out, 1, sos, 4096, XLALSOSFilterWarmupLength(sos, 1e-13));
+	for(j = skip; j + skip < length; j++)
+		if(fabs(ref->data[j] - out->data[j]) > maxdiff)
+			maxdiff = fabs(ref->data[j] - out->data[j]);
+	if(maxdiff > 1e-9) {
+		fprintf(stderr, "order %d Butterworth cascade differs by %g\n", order, maxdiff);
+		failed = 1;
+	}
+
+	XLALDestroyREAL8SOSFilter(sos);
+	XLALDestroyREAL8Vector(ref);
+	XLALDestroyREAL8Vector(out);
+	return failed;
+}
+
+int main(void)
+{
+	int failed = 0;
+
+	failed |= test_cascade();
+	failed |= test_butterworth(8, 100., -1.);
+	failed |= test_butterworth(5, -1., 40.);
+
+	LALCheckMemoryLeaks();
+	return failed;
+}
@@ -0,0 +1,158 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <complex.h>
+#include <math.h>
+#include <stdlib.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/AVFactories.h>
+#include <lal/Calibration.h>
+
+#define LINE_FREQ 393.1
+#define TO 1.0
+#define DURATION 64.0
+
+/* relative tolerance: the reference windows the data in single precision */
+#define REL_TOL 1e-5
+
+static double frand(void)
+{
+  return 2.0 * rand() / RAND_MAX - 1.0;
+}
+
+/* calibration line with slowly varying amplitude, plus noise */
+static REAL4Vector *line_data(REAL8 deltaT, REAL8 amp, REAL8 phase)
+{
+  const UINT4 n = (UINT4)(DURATION / deltaT + 0.5);
+  REAL4Vector *v = XLALCreateREAL4Vector(n);
+  for (UINT4 i = 0; i < n; i++) {
+    const REAL8 t = i * deltaT;
+    v->data[i] = amp * (1 + 0.1 * sin(LAL_TWOPI * t / 17.0)) * cos(LAL_TWOPI * LINE_FREQ * t + phase) + 0.1 * frand();
+  }
+  return v;
+}
+
+/* Hann-windowed copy of the length samples of data ending at end, as in LALGetFactors() */
+static void windowed(REAL4TimeSeries *out, const REAL4Vector *data, UINT4 end)
+{
+  const UINT4 N = out->data->length;
+  for (UINT4 k = 0; k < N; k++) {
+    const REAL8 w = pow(sin(LAL_PI * k / (N - 1)), 2);
+    out->data->data[k] = data->data[end - N + k] * 2.0 * w;
+  }
+}
+
+static REAL8 relerr(COMPLEX16 x, COMPLEX16 ref)
+{
+  return cabs(x - ref) / cabs(ref);
+}
+
+int main(void)
+{
+  const REAL8 deltaT = 1.0 / 2048, deltaTasq = 1.0 / 4096;
+  REAL4Vector *darm = NULL, *asq = NULL, *exc = NULL;
+  REAL4TimeSeries XLAL_INIT_DECL(darmwin);
+  REAL4TimeSeries XLAL_INIT_DECL(asqwin);
+  REAL4TimeSeries XLAL_INIT_DECL(excwin);
+  UpdateFactorsParams XLAL_INIT_DECL(params);
+  CalibrationFactorTracker *tracker;
+  LALStatus XLAL_INIT_DECL(status);
+  REAL8 maxerr = 0;
+  UINT4 nchecks = 0;
+
+  srand(4321);
+
+  darm = line_data(deltaT, 2.0, 0.3);
+  asq = line_data(deltaTasq, 0.5, -1.2);
+  exc = line_data(deltaT, 3.0, 2.1);
+
+  darmwin.deltaT = excwin.deltaT = deltaT;
+  asqwin.deltaT = deltaTasq;
+  darmwin.data = XLALCreateREAL4Vector((UINT4)(TO / deltaT + 0.5));
+  excwin.data = XLALCreateREAL4Vector((UINT4)(TO / deltaT + 0.5));
+  asqwin.data = XLALCreateREAL4Vector((UINT4)(TO / deltaTasq + 0.5));
+
+  params.lineFrequency = LINE_FREQ;
+  params.openloop = 1.3 - 0.4 * I;
+  params.digital = -0.7 + 2.2 * I;
+  params.whitener = 0.9 + 0.1 * I;
+  params.darmCtrl = &darmwin;
+  params.asQ = &asqwin;
+  params.exc = &excwin;
+
+  tracker = XLALCreateCalibrationFactorTracker(&params, TO);
+  XLAL_CHECK_MAIN(tracker != NULL, XLAL_EFUNC);
+
+  /* before a full integration time has been fed, no factors are available */
+  {
+    CalFactors factors;
+    int errnum;
+    XLAL_TRY_SILENT(XLALGetCalibrationFactors(&factors, tracker), errnum);
+    XLAL_CHECK_MAIN((errnum & ~XLAL_EFUNC) == XLAL_EFAILED, XLAL_EFAILED, "XLALGetCalibrationFactors() returned errnum=%i before a full integration time", errnum);
+  }
+
+  /* feed the channels in strides of random lengths, and compare the factors after
+   * each stride with those computed from the Hann-windowed last To seconds */
+  for (UINT4 i = 0, n = 0; i < darm->length; i += n) {
+    REAL4Vector darmStride, asqStride, excStride;
+    n = 1 + rand() % 3000;
+    if (n > darm->length - i)
+      n = darm->length - i;
+    darmStride.length = excStride.length = n;
+    asqStride.length = 2 * n;
+    darmStride.data = &darm->data[i];
+    excStride.data = &exc->data[i];
+    asqStride.data = &asq->data[2 * i];
+    XLAL_CHECK_MAIN(XLALUpdateCalibrationFactorTracker(tracker, &darmStride, &asqStride, &excStride) == XLAL_SUCCESS, XLAL_EFUNC);
+
+    if (i + n < darmwin.data->length)
+      continue;
+
+    CalFactors factors, ref;
+    XLAL_CHECK_MAIN(XLALGetCalibrationFactors(&factors, tracker) == XLAL_SUCCESS, XLAL_EFUNC);
+    windowed(&darmwin, darm, i + n);
+    windowed(&excwin, exc, i + n);
+    windowed(&asqwin, asq, 2 * (i + n));
+    LALComputeCalibrationFactors(&status, &ref, &params);
+    XLAL_CHECK_MAIN(status.statusCode == 0, XLAL_EFAILED, "LALComputeCalibrationFactors() failed");
+
+    const REAL8 errs[] = {
+      relerr(factors.darm, ref.darm), relerr(factors.asq, ref.asq), relerr(factors.exc, ref.exc),
+      relerr(factors.alpha, ref.alpha), relerr(factors.alphabeta, ref.alphabeta), relerr(factors.beta, ref.beta)
+    };
+    for (UINT4 k = 0; k < XLAL_NUM_ELEM(errs); k++) {
+      XLAL_CHECK_MAIN(errs[k] < REL_TOL, XLAL_ETOL, "sample %u: relative error %g of factor %u exceeds tolerance %g", i + n, errs[k], k, REL_TOL);
+      maxerr = fmax(maxerr, errs[k]);
+    }
+    nchecks++;
+  }
+  XLALPrintInfo("%u checks of calibration factors: max relative error %g\n", nchecks, maxerr);
+
+  XLALDestroyCalibrationFactorTracker(tracker);
+  XLALDestroyREAL4Vector(darm);
+  XLALDestroyREAL4Vector(asq);
+  XLALDestroyREAL4Vector(exc);
+  XLALDestroyREAL4Vector(darmwin.data);
+  XLALDestroyREAL4Vector(asqwin.data);
+  XLALDestroyREAL4Vector(excwin.data);
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,242 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <complex.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/AVFactories.h>
+#include <lal/Date.h>
+#include <lal/DetResponse.h>
+#include <lal/TimeDelay.h>
+#include <lal/ZPGFilter.h>
+#include <lal/CoherentEstimation.h>
+
+#define NDET 3
+#define NPOINTS 200
+#define DELTAT (1.0 / 2048)
+#define LENGTH 16384
+
+/* relative tolerance on estimates, wrt their root-mean-square */
+#define REL_TOL 1e-4
+
+static double frand(void)
+{
+  return 2.0 * rand() / RAND_MAX - 1.0;
+}
+
+static REAL8IIRFilter *create_filter(void)
+{
+  COMPLEX16ZPGFilter *zpg = XLALCreateCOMPLEX16ZPGFilter(3, 3);
+  REAL8IIRFilter *filter;
+  zpg->deltaT = DELTAT;
+  zpg->gain = 31.55634918610406103312016;
+  zpg->poles->data[0] = zpg->poles->data[1] = zpg->poles->data[2] = -0.8;
+  zpg->zeros->data[0] = 0.522407749927482845109239 + 0.4524183825710683670706658 * I;
+  zpg->zeros->data[1] = 0.522407749927482845109239 - 0.4524183825710683670706658 * I;
+  zpg->zeros->data[2] = 0.4142135623730950899634706;
+  filter = XLALCreateREAL8IIRFilter(zpg);
+  XLALDestroyCOMPLEX16ZPGFilter(zpg);
+  return filter;
+}
+
+/* estimate for one sky position, as the single-position computation before it was vectorised */
+static REAL8 reference_estimate(REAL8 *out, const LALDetector *detectors, const REAL4TimeSeries *data, const SkyPosition *position, REAL8 psi)
+{
+  LIGOTimeGPS tmid = data[0].epoch;
+  REAL8 tDelays[NDET], Fp[NDET], Fc[NDET], H[NDET][NDET], alpha[NDET], lambda = 0, trace = 0;
+  UINT4 i, j, n;
+
+  XLALGPSAdd(&tmid, 0.5 * LENGTH * DELTAT);
+  for (i = 0; i < NDET; i++) {
+    tDelays[i] = XLALTimeDelayFromEarthCenter(detectors[i].location, position->longitude, position->latitude, &tmid);
+    XLALComputeDetAMResponse(&Fp[i], &Fc[i], detectors[i].response, position->longitude, position->latitude, psi, XLALGreenwichMeanSiderealTime(&tmid));
+  }
+  for (i = NDET; i-- > 0;)
+    tDelays[i] -= tDelays[0];
+
+  /* dominant eigenvector of the network response, by power iteration */
+  for (i = 0; i < NDET; i++) {
+    for (j = 0; j < NDET; j++)
+      H[i][j] = Fp[i] * Fp[j] + Fc[i] * Fc[j];
+    trace += H[i][i];
+    alpha[i] = 1;
+  }
+  for (n = 0; n < 5000; n++) {
+    REAL8 w[NDET], norm = 0;
+    for (i = 0; i < NDET; i++) {
+      w[i] = 0;
+      for (j = 0; j < NDET; j++)
+        w[i] += H[i][j] * alpha[j];
+      norm += w[i] * w[i];
+    }
+    lambda = sqrt(norm);
+    for (i = 0; i < NDET; i++)
+      alpha[i] = w[i] / lambda;
+  }
+
+  memset(out, 0, LENGTH * sizeof(*out));
+  for (i = 0; i < NDET; i++) {
+    const REAL8 d = tDelays[i] / DELTAT;
+    const INT4 iPad = d < 0 ? (INT4)floor(-d) : 0;
+    const INT4 ePad = d < 0 ? 0 : (INT4)ceil(d);
+    const INT4 del = d < 0 ? -iPad : ePad;
+    const REAL8 p1 = ceil(d) - d, p2 = 1.0 - p1;
+    for (INT4 k = iPad + 1; k < LENGTH - ePad; k++)
+      out[k] += alpha[i] * (p1 * data[i].data->data[del + k - 1] + p2 * data[i].data->data[del + k]);
+  }
+
+  /* rank-2 response: the other non-zero eigenvalue is the rest of the trace */
+  return (trace - lambda) / lambda;
+}
+
+int main(void)
+{
+  LALDetector detectors[NDET] = {
+    lalCachedDetectors[LALDetectorIndexLHODIFF],
+    lalCachedDetectors[LALDetectorIndexLLODIFF],
+    lalCachedDetectors[LALDetectorIndexVIRGODIFF]
+  };
+  REAL8IIRFilter *filters[NDET], *refFilters[NDET];
+  REAL8 CRows[NDET][NDET], *CMat[NDET];
+  REAL4TimeSeries data[NDET], refData[NDET], output[NPOINTS], single;
+  SkyPosition positions[NPOINTS];
+  CoherentEstimation XLAL_INIT_DECL(params);
+  DetectorsData in;
+  LALStatus XLAL_INIT_DECL(status);
+  REAL8 *ref = XLALMalloc(LENGTH * sizeof(*ref));
+  REAL8 maxerr = 0;
+  UINT4 i, k, nchecks = 0;
+  int errnum;
+
+  srand(2468);
+
+  for (i = 0; i < NDET; i++) {
+    memset(&data[i], 0, sizeof(data[i]));
+    XLALGPSSetREAL8(&data[i].epoch, 900000000.25);
+    data[i].deltaT = DELTAT;
+    data[i].data = XLALCreateREAL4Vector(LENGTH);
+    for (UINT4 j = 0; j < LENGTH; j++)
+      data[i].data->data[j] = frand();
+    refData[i] = data[i];
+    refData[i].data = XLALCreateREAL4Vector(LENGTH);
+    memcpy(refData[i].data->data, data[i].data->data, LENGTH * sizeof(REAL4));
+    filters[i] = create_filter();
+    refFilters[i] = create_filter();
+    XLAL_CHECK_MAIN(filters[i] != NULL && refFilters[i] != NULL, XLAL_EFUNC);
+    memset(CRows[i], 0, sizeof(CRows[i]));
+    CRows[i][i] = 1;
+    CMat[i] = CRows[i];
+  }
+
+  params.Ndetectors = NDET;
+  params.detectors = detectors;
+  params.filters = filters;
+  params.preProcessed = 0;
+  params.nPreProcessed = 2;
+  params.polAngle = 0.2;
+  params.plus2cross = 1;
+  params.plusDotcross = 0;
+  params.CMat = CMat;
+  in.Ndetectors = NDET;
+  in.data = data;
+
+  for (k = 0; k < NPOINTS; k++) {
+    positions[k].system = COORDINATESYSTEM_EQUATORIAL;
+    positions[k].longitude = LAL_PI * (1 + frand());
+    positions[k].latitude = asin(frand());
+    memset(&output[k], 0, sizeof(output[k]));
+    output[k].data = XLALCreateREAL4Vector(LENGTH);
+  }
+
+  /* estimate over the sky grid, pre-processing the data once */
+  XLAL_CHECK_MAIN(XLALCoherentEstimationSkyGrid(output, &params, &in, positions, NPOINTS) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(params.preProcessed == 1, XLAL_EFAILED);
+
+  /* data are pre-processed exactly as by applying the filters in sequence */
+  for (i = 0; i < NDET; i++) {
+    REAL8Vector *tmp = XLALCreateREAL8Vector(LENGTH);
+    for (UINT4 j = 0; j < LENGTH; j++)
+      tmp->data[j] = refData[i].data->data[j];
+    for (UINT4 n = 0; n < params.nPreProcessed; n++)
+      XLAL_CHECK_MAIN(XLALIIRFilterREAL8Vector(tmp, refFilters[i]) == XLAL_SUCCESS, XLAL_EFUNC);
+    for (UINT4 j = 0; j < LENGTH; j++)
+      refData[i].data->data[j] = (j < (UINT4)ceil(0.0635 / DELTAT)) ? 0 : (REAL4)tmp->data[j];
+    XLALDestroyREAL8Vector(tmp);
+    XLAL_CHECK_MAIN(memcmp(refData[i].data->data, data[i].data->data, LENGTH * sizeof(REAL4)) == 0, XLAL_EFAILED, "detector %u: pre-processed data differ", i);
+  }
+
+  /* compare estimates with the single-position reference */
+  for (k = 0; k < NPOINTS; k++) {
+    REAL8 rms = 0, err = 0, sign = 0;
+    const REAL8 ratio = reference_estimate(ref, detectors, data, &positions[k], params.polAngle);
+    XLAL_CHECK_MAIN(XLALGPSCmp(&output[k].epoch, &data[0].epoch) == 0 && output[k].deltaT == DELTAT, XLAL_EFAILED);
+
+    /* skip nearly degenerate eigenvalues, where the weights are ill-conditioned */
+    if (ratio > 0.9)
+      continue;
+
+    for (UINT4 j = 0; j < LENGTH; j++) {
+      rms += ref[j] * ref[j];
+      sign += ref[j] * output[k].data->data[j];
+    }
+    rms = sqrt(rms / LENGTH);
+    sign = (sign < 0) ? -1 : 1;
+    for (UINT4 j = 0; j < LENGTH; j++)
+      err = fmax(err, fabs(sign * output[k].data->data[j] - ref[j]) / rms);
+    XLAL_CHECK_MAIN(err < REL_TOL, XLAL_ETOL, "sky position %u: relative error %g exceeds tolerance %g", k, err, REL_TOL);
+    maxerr = fmax(maxerr, err);
+    nchecks++;
+  }
+  XLALPrintInfo("%u sky positions checked: max relative error %g\n", nchecks, maxerr);
+  XLAL_CHECK_MAIN(nchecks > NPOINTS / 2, XLAL_EFAILED, "only %u sky positions checked", nchecks);
+
+  /* single-position estimate is the same computation, without further pre-processing */
+  memset(&single, 0, sizeof(single));
+  single.data = XLALCreateREAL4Vector(LENGTH);
+  for (k = 0; k < NPOINTS; k += NPOINTS / 4) {
+    params.position = &positions[k];
+    LALDoCoherentEstimation(&status, &single, &params, &in);
+    XLAL_CHECK_MAIN(status.statusCode == 0, XLAL_EFAILED, "LALDoCoherentEstimation() failed");
+    XLAL_CHECK_MAIN(memcmp(single.data->data, output[k].data->data, LENGTH * sizeof(REAL4)) == 0, XLAL_EFAILED, "sky position %u: single-position estimate differs", k);
+  }
+  for (i = 0; i < NDET; i++)
+    XLAL_CHECK_MAIN(memcmp(refData[i].data->data, data[i].data->data, LENGTH * sizeof(REAL4)) == 0, XLAL_EFAILED, "detector %u: data pre-processed twice", i);
+
+  /* sky positions must be equatorial */
+  positions[1].system = COORDINATESYSTEM_GEOGRAPHIC;
+  XLAL_TRY_SILENT(XLALCoherentEstimationSkyGrid(output, &params, &in, positions, NPOINTS), errnum);
+  XLAL_CHECK_MAIN((errnum & ~XLAL_EFUNC) == XLAL_EINVAL, XLAL_EFAILED, "non-equatorial sky position returned errnum=%i", errnum);
+
+  for (i = 0; i < NDET; i++) {
+    XLALDestroyREAL4Vector(data[i].data);
+    XLALDestroyREAL4Vector(refData[i].data);
+    XLALDestroyREAL8IIRFilter(filters[i]);
+    XLALDestroyREAL8IIRFilter(refFilters[i]);
+  }
+  for (k = 0; k < NPOINTS; k++)
+    XLALDestroyREAL4Vector(output[k].data);
+  XLALDestroyREAL4Vector(single.data);
+  XLALFree(ref);
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,237 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/AVFactories.h>
+#include <lal/Calibration.h>
+
+#define NDATA 20000
+
+/* high pass filter applied twice to the control signal by LALComputeStrain() */
+#define N_HP 4001
+
+static double frand(void)
+{
+  return 2.0 * rand() / RAND_MAX - 1.0;
+}
+
+static REAL8Vector *random_vector(UINT4 length)
+{
+  REAL8Vector *v = XLALCreateREAL8Vector(length);
+  for (UINT4 i = 0; i < length; i++)
+    v->data[i] = frand();
+  return v;
+}
+
+/* y = b * x, with x zero before its start */
+static void convolve(REAL8 *y, const REAL8 *x, UINT4 n, const REAL8Vector *b)
+{
+  for (UINT4 i = 0; i < n; i++) {
+    REAL8 sum = 0;
+    for (UINT4 m = 0; m < b->length && m <= i; m++)
+      sum += b->data[m] * x[i - m];
+    y[i] = sum;
+  }
+}
+
+static REAL8 max_abs_diff(const REAL8 *a, const REAL8 *b, UINT4 n)
+{
+  REAL8 maxerr = 0;
+  for (UINT4 i = 0; i < n; i++)
+    if (fabs(a[i] - b[i]) > maxerr)
+      maxerr = fabs(a[i] - b[i]);
+  return maxerr;
+}
+
+/* filter a stream in strides of random lengths, and compare with direct convolution */
+static int test_fir_stream(UINT4 ntaps)
+{
+  REAL8Vector *b = random_vector(ntaps);
+  REAL8Vector *x = random_vector(NDATA);
+  REAL8 *y = XLALMalloc(NDATA * sizeof(*y));
+  REAL8Vector stride;
+  REAL8FIRFilterStream *stream;
+  REAL8 err;
+
+  convolve(y, x->data, NDATA, b);
+
+  stream = XLALCreateREAL8FIRFilterStream(b);
+  XLAL_CHECK(stream != NULL, XLAL_EFUNC);
+  for (UINT4 i = 0; i < NDATA; i += stride.length) {
+    stride.data = &x->data[i];
+    stride.length = rand() % 3000;
+    if (stride.length > NDATA - i)
+      stride.length = NDATA - i;
+    XLAL_CHECK(XLALREAL8FIRFilterStream(&stride, stream) == XLAL_SUCCESS, XLAL_EFUNC);
+  }
+  XLALDestroyREAL8FIRFilterStream(stream);
+
+  err = max_abs_diff(x->data, y, NDATA);
+  XLALPrintInfo("FIR filter with %u taps: max error %g\n", ntaps, err);
+  XLAL_CHECK(err < 1e-10 * sqrt(ntaps), XLAL_ETOL, "FIR filter with %u taps: max error %g", ntaps, err);
+
+  XLALDestroyREAL8Vector(b);
+  XLALDestroyREAL8Vector(x);
+  XLALFree(y);
+
+  return XLAL_SUCCESS;
+}
+
+static REAL8IIRFilter *random_fir(UINT4 ntaps)
+{
+  REAL8IIRFilter *f = XLALCalloc(1, sizeof(*f));
+  f->directCoef = random_vector(ntaps);
+  return f;
+}
+
+static void destroy_fir(REAL8IIRFilter *f)
+{
+  XLALDestroyREAL8Vector(f->directCoef);
+  XLALFree(f);
+}
+
+/* reconstruct strain in strides, and compare with the direct filter chain */
+static int test_reconstruction(void)
+{
+  StrainIn XLAL_INIT_DECL(input);
+  StrainOut XLAL_INIT_DECL(output);
+  StrainReconstruction *recon;
+  REAL8Vector *e = random_vector(NDATA);
+  REAL8Vector *exc = random_vector(NDATA);
+  REAL8Vector *hp = XLALCreateREAL8Vector(N_HP);
+  REAL8 *r = XLALMalloc(NDATA * sizeof(*r));
+  REAL8 *c = XLALMalloc(NDATA * sizeof(*c));
+  REAL8 *tmp = XLALMalloc(NDATA * sizeof(*tmp));
+  REAL8 *h = XLALMalloc(NDATA * sizeof(*h));
+  REAL8 *hC = XLALMalloc(NDATA * sizeof(*hC));
+  REAL8 *hR = XLALMalloc(NDATA * sizeof(*hR));
+  const REAL8 alphabeta = 0.9;
+  INT4 latency, advR = 7, advC = (N_HP - 1);
+  REAL8 errR, errC, errh;
+
+  input.Cinv = random_fir(21);
+  input.D = random_fir(300);
+  input.A = random_fir(5);
+  input.CinvUSF = 1;
+  input.CinvDelay = -advR;
+  input.usefactors = 1;
+  input.DARM_ERR.deltaT = input.EXC.deltaT = 1.0 / 16384;
+  input.DARM_ERR.data = XLALCreateREAL4Vector(NDATA);
+  input.EXC.data = XLALCreateREAL4Vector(NDATA);
+  for (UINT4 i = 0; i < NDATA; i++) {
+    e->data[i] = input.DARM_ERR.data->data[i] = (REAL4)e->data[i];
+    exc->data[i] = input.EXC.data->data[i] = (REAL4)exc->data[i];
+  }
+
+  /* residual and control signals, without the advances of LALComputeStrain() */
+  LALStatus XLAL_INIT_DECL(status);
+  REAL8IIRFilter HPFIR;
+  LALMakeFIRHP(&status, &HPFIR);
+  XLAL_CHECK(status.statusCode == 0, XLAL_EFUNC);
+  memcpy(hp->data, HPFIR.directCoef->data, N_HP * sizeof(*hp->data));
+  LALDDestroyVector(&status, &HPFIR.directCoef);
+  LALDDestroyVector(&status, &HPFIR.recursCoef);
+  LALDDestroyVector(&status, &HPFIR.history);
+  convolve(r, e->data, NDATA, input.Cinv->directCoef);
+  convolve(c, e->data, NDATA, hp);
+  convolve(tmp, c, NDATA, hp);
+  convolve(c, tmp, NDATA, input.D->directCoef);
+  for (UINT4 i = 0; i < NDATA; i++)
+    c[i] += (i >= (UINT4)advC) ? exc->data[i - advC] : 0;
+  memcpy(tmp, c, NDATA * sizeof(*tmp));
+  convolve(c, tmp, NDATA, input.A->directCoef);
+
+  recon = XLALCreateStrainReconstruction(&input);
+  XLAL_CHECK(recon != NULL, XLAL_EFUNC);
+  latency = XLALStrainReconstructionLatency(recon);
+  XLAL_CHECK(latency == advC, XLAL_EFAILED, "latency %i != %i", latency, advC);
+
+  /* feed DARM_ERR and EXC in strides of random lengths */
+  REAL4Vector *darm_err = input.DARM_ERR.data, *darm_exc = input.EXC.data;
+  REAL4Vector inStride, excStride;
+  REAL8Vector hStride, hCStride, hRStride;
+  input.DARM_ERR.data = &inStride;
+  input.EXC.data = &excStride;
+  output.h.data = &hStride;
+  output.hC.data = &hCStride;
+  output.hR.data = &hRStride;
+  for (UINT4 i = 0, n = 0; i < NDATA; i += n) {
+    n = 1 + rand() % 5000;
+    if (n > NDATA - i)
+      n = NDATA - i;
+    inStride.length = excStride.length = hStride.length = hCStride.length = hRStride.length = n;
+    inStride.data = &darm_err->data[i];
+    excStride.data = &darm_exc->data[i];
+    hStride.data = &h[i];
+    hCStride.data = &hC[i];
+    hRStride.data = &hR[i];
+    XLAL_CHECK(XLALComputeStrainStride(&output, recon, &input, alphabeta) == XLAL_SUCCESS, XLAL_EFUNC);
+  }
+  input.DARM_ERR.data = darm_err;
+  input.EXC.data = darm_exc;
+
+  /* output lags the advanced residual and control signals by the latency */
+  errR = errC = errh = 0;
+  for (INT4 i = latency; i < NDATA; i++) {
+    const REAL8 hRref = r[i - latency + advR] / alphabeta;
+    const REAL8 hCref = c[i - latency + advC];
+    errR = fmax(errR, fabs(hR[i] - hRref));
+    errC = fmax(errC, fabs(hC[i] - hCref));
+    errh = fmax(errh, fabs(h[i] - hRref - hCref));
+  }
+  XLALPrintInfo("strain reconstruction: max errors hR %g, hC %g, h %g\n", errR, errC, errh);
+  XLAL_CHECK(errR < 1e-10 && errC < 1e-8 && errh < 1e-8, XLAL_ETOL, "strain reconstruction: max errors hR %g, hC %g, h %g", errR, errC, errh);
+
+  XLALDestroyStrainReconstruction(recon);
+  destroy_fir(input.Cinv);
+  destroy_fir(input.D);
+  destroy_fir(input.A);
+  XLALDestroyREAL4Vector(input.DARM_ERR.data);
+  XLALDestroyREAL4Vector(input.EXC.data);
+  XLALDestroyREAL8Vector(e);
+  XLALDestroyREAL8Vector(exc);
+  XLALDestroyREAL8Vector(hp);
+  XLALFree(r);
+  XLALFree(c);
+  XLALFree(tmp);
+  XLALFree(h);
+  XLALFree(hC);
+  XLALFree(hR);
+
+  return XLAL_SUCCESS;
+}
+
+int main(void)
+{
+  srand(1234);
+
+  XLAL_CHECK_MAIN(test_fir_stream(1) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(test_fir_stream(17) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(test_fir_stream(64) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(test_fir_stream(1000) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(test_fir_stream(N_HP) == XLAL_SUCCESS, XLAL_EFUNC);
+
+  XLAL_CHECK_MAIN(test_reconstruction() == XLAL_SUCCESS, XLAL_EFUNC);
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+}
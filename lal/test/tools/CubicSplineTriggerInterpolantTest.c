@@ -24,6 +24,25 @@
 
 #include <lal/TriggerInterpolation.h>
 
+
+/* Fill y with n neighbourhoods of 2 * window + 1 samples of random peaks,
+ * each with its maximum between samples -0.5 and 0.5 of its neighbourhood. */
+static void random_peaks(COMPLEX16 *y, int window, size_t n)
+{
+    size_t k;
+    int i;
+
+    for (k = 0; k < n; k ++)
+    {
+        const double t0 = (double) rand() / RAND_MAX - 0.5;
+        const double phi0 = 6.283185307179586 * rand() / RAND_MAX;
+        const double phi1 = 0.2 * rand() / RAND_MAX - 0.1;
+        const double sigma = 2 + 2.0 * rand() / RAND_MAX;
+        for (i = -window; i <= window; i ++)
+            y[k * (2 * window + 1) + window + i] = exp(-0.5 * (i - t0) * (i - t0) / (sigma * sigma)) * cexp(I * (phi0 + phi1 * i));
+    }
+}
+
 int main(__attribute__ ((unused)) int argc, __attribute__ ((unused)) char **argv)
 {
     int result;
@@ -131,6 +150,49 @@ int main(__attribute__ ((unused)) int argc, __attribute__ ((unused)) char **argv
             exit(EXIT_FAILURE);
     }
 
+    {
+        /* Interpolate a batch of random peaks, and compare with one at a time. */
+        const size_t n = 100;
+        const int window = 2;
+        COMPLEX16 y[n * (2 * window + 1)], ymax_batch[n], ymax;
+        COMPLEX8 yf[n * (2 * window + 1)], ymaxf_batch[n];
+        double tmax_batch[n], tmaxf_batch[n];
+        double *workspace = malloc(XLALCubicSplineTriggerInterpolantBatchWorkspaceLength(interp) * sizeof(double));
+        size_t k;
+
+        if (!workspace)
+            exit(EXIT_FAILURE);
+
+        random_peaks(y, window, n);
+        for (k = 0; k < n * (2 * window + 1); k ++)
+            yf[k] = y[k];
+
+        result = XLALCOMPLEX16ApplyCubicSplineTriggerInterpolantBatch(interp, tmax_batch, ymax_batch, y, n, workspace);
+        if (result)
+            exit(EXIT_FAILURE);
+        result = XLALCOMPLEX8ApplyCubicSplineTriggerInterpolantBatch(interp, tmaxf_batch, ymaxf_batch, yf, n, workspace);
+        if (result)
+            exit(EXIT_FAILURE);
+
+        for (k = 0; k < n; k ++)
+        {
+            result = XLALCOMPLEX16ApplyCubicSplineTriggerInterpolant(interp, &tmax, &ymax, &y[k * (2 * window + 1) + window]);
+            if (result)
+                exit(EXIT_FAILURE);
+
+            if (fabs(tmax_batch[k] - tmax) > 1e-8)
+                exit(EXIT_FAILURE);
+            if (cabs(ymax_batch[k] - ymax) > 1e-12)
+                exit(EXIT_FAILURE);
+            if (fabs(tmaxf_batch[k] - tmax_batch[k]) > 1e-4)
+                exit(EXIT_FAILURE);
+            if (cabs(ymaxf_batch[k] - ymax_batch[k]) > 1e-6)
+                exit(EXIT_FAILURE);
+        }
+
+        free(workspace);
+    }
+
     XLALDestroyCubicSplineTriggerInterpolant(interp);
     exit(EXIT_SUCCESS);
 }
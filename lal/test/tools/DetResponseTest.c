@@ -37,6 +37,7 @@
 #include <lal/TimeDelay.h>
 #include <lal/DetResponse.h>
 #include <lal/Units.h>
+#include <lal/TimeSeries.h>
 
 #include <lal/PrintFTSeries.h>
 #include <lal/StreamOutput.h>
@@ -52,6 +53,7 @@
 #define LALDR_MATRIXSIZE 3
 
 #define TESTDR_MIN(a, b) (((a) < (b)) ? (a) : (b))
+#define TESTDR_MAX(a, b) (((a) > (b)) ? (a) : (b))
 
 /* these two constants are for the sky grid */
 #define NUM_DEC 21
@@ -695,6 +697,7 @@ char *laldr_strlcpy(char *dst, const char *src, size_t len);
 void fudge_factor_test(LALStatus *status);
 BOOLEAN passed_special_locations_tests_p(LALStatus *status);
 BOOLEAN passed_almost_equal_tests_p(void);
+BOOLEAN passed_batched_response_tests_p(void);
 
 /* FIXME */
 BOOLEAN passed_matrix_test_p(void);
@@ -1753,6 +1756,12 @@ int main(int argc, char *argv[])
 
   fudge_factor_test(&status);
 
+  if (!passed_batched_response_tests_p())
+    {
+      fprintf(stderr, "Batched/tabulated response test failed\n");
+      exit(4);
+    }
+
   if (verbose_p)
     printf("\n\nGOODBYE.\n");
 
@@ -2798,6 +2807,104 @@ void fudge_factor_test(LALStatus *status)
 
 
 
+/*
+ * XLALComputeDetAMResponseVectors() and the sidereal-time table agree with
+ * XLALComputeDetAMResponse() at random sky positions and times
+ */
+BOOLEAN passed_batched_response_tests_p(void)
+{
+  const LALDetector *det = &lalCachedDetectors[LALDetectorIndexLHODIFF];
+  const UINT4 n = 1000;
+  REAL8Vector *ra = XLALCreateREAL8Vector(n);
+  REAL8Vector *dec = XLALCreateREAL8Vector(n);
+  REAL8Vector *psi = XLALCreateREAL8Vector(n);
+  REAL8Vector *gmst = XLALCreateREAL8Vector(n);
+  REAL8Vector *one = XLALCreateREAL8Vector(1);
+  REAL8Vector *fp = XLALCreateREAL8Vector(n);
+  REAL8Vector *fx = XLALCreateREAL8Vector(n);
+  LALDetAMResponseTable *table;
+  REAL8 maxdiff = 0., tmaxdiff = 0.;
+  BOOLEAN passed_p = 1;
+  UINT4 i;
+
+  for (i = 0; i < n; ++i)
+    {
+      ra->data[i] = LAL_TWOPI * rand() / RAND_MAX;
+      dec->data[i] = asin(2. * rand() / RAND_MAX - 1.);
+      psi->data[i] = LAL_PI * rand() / RAND_MAX;
+      gmst->data[i] = 1e3 * (2. * rand() / RAND_MAX - 1.);
+    }
+
+  /* every input varying */
+  XLALComputeDetAMResponseVectors(fp, fx, det->response, ra, dec, psi, gmst);
+  for (i = 0; i < n; ++i)
+    {
+      double p, x;
+      XLALComputeDetAMResponse(&p, &x, det->response, ra->data[i], dec->data[i], psi->data[i], gmst->data[i]);
+      maxdiff = TESTDR_MAX(maxdiff, TESTDR_MAX(fabs(p - fp->data[i]), fabs(x - fx->data[i])));
+    }
+
+  /* fixed sky position and polarization, as for a time series */
+  one->data[0] = ra->data[0];
+  dec->length = psi->length = 1;
+  table = XLALCreateDetAMResponseTable(det->response, ra->data[0], dec->data[0], 1440);
+  XLALComputeDetAMResponseVectors(fp, fx, det->response, one, dec, psi, gmst);
+  for (i = 0; i < n; ++i)
+    {
+      double p, x, tp, tx;
+      XLALComputeDetAMResponse(&p, &x, det->response, ra->data[0], dec->data[0], psi->data[0], gmst->data[i]);
+      maxdiff = TESTDR_MAX(maxdiff, TESTDR_MAX(fabs(p - fp->data[i]), fabs(x - fx->data[i])));
+      XLALDetAMResponseTableEval(&tp, &tx, table, psi->data[0], gmst->data[i]);
+      tmaxdiff = TESTDR_MAX(tmaxdiff, TESTDR_MAX(fabs(p - tp), fabs(x - tx)));
+    }
+  dec->length = psi->length = n;
+
+  if (maxdiff > 1e-12 || tmaxdiff > 1e-8)
+    {
+      fprintf(stderr, "batched response differs by %g, tabulated response by %g\n", maxdiff, tmaxdiff);
+      passed_p = 0;
+    }
+  else if (verbose_level & 4)
+    printf("batched response differs by %g, tabulated response by %g\n", maxdiff, tmaxdiff);
+
+  /* mismatched lengths are rejected */
+  one->length = 0;
+  if (XLALComputeDetAMResponseVectors(fp, fx, det->response, ra, dec, psi, one) != XLAL_FAILURE)
+    passed_p = 0;
+  XLALClearErrno();
+  one->length = 1;
+
+  /* zero-length outputs, and zero-length series, are not an error */
+  fp->length = fx->length = 0;
+  if (XLALComputeDetAMResponseVectors(fp, fx, det->response, one, one, one, one) != 0)
+    passed_p = 0;
+  fp->length = fx->length = n;
+  {
+    REAL4TimeSeries *sp = NULL, *sx = NULL;
+    LIGOTimeGPS start = {1000000000, 0};
+    if (XLALComputeDetAMResponseSeries(&sp, &sx, det->response, 0., 0., 0., &start, 1., 0) != 0 ||
+        !sp || !sx || sp->data->length != 0 || sx->data->length != 0)
+      {
+        fprintf(stderr, "zero-length response series failed\n");
+        passed_p = 0;
+      }
+    XLALDestroyREAL4TimeSeries(sp);
+    XLALDestroyREAL4TimeSeries(sx);
+  }
+
+  XLALDestroyDetAMResponseTable(table);
+  XLALDestroyREAL8Vector(ra);
+  XLALDestroyREAL8Vector(dec);
+  XLALDestroyREAL8Vector(psi);
+  XLALDestroyREAL8Vector(gmst);
+  XLALDestroyREAL8Vector(one);
+  XLALDestroyREAL8Vector(fp);
+  XLALDestroyREAL8Vector(fx);
+  return passed_p;
+}
+
+
+
 void set_source_params(LALSource * source, const char *name, REAL8 ra_rad,
                        REAL8 dec_rad, REAL8 orien_rad)
 {
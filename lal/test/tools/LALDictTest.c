@@ -0,0 +1,279 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALDict.h>
+#include <lal/LALList.h>
+
+/* keys, in order of insertion */
+static const char *const keys[] = {
+  "mass1", "mass2", "spin1x", "spin1y", "spin1z", "spin2x", "spin2y", "spin2z",
+  "distance", "inclination", "phiRef", "longAscNodes", "eccentricity", "meanPerAno",
+  "deltaT", "f_min", "f_ref", "ModeArray", "lambda1", "lambda2", "a", "b", "ab", "ba"
+};
+#define NKEYS (sizeof(keys) / sizeof(keys[0]))
+
+/* order in which the original dictionary implementation iterated over 'keys' */
+static const char *const keys_order[NKEYS] = {
+  "ba", "deltaT", "inclination", "mass1", "mass2", "spin1x", "spin1y", "lambda1",
+  "eccentricity", "spin1z", "lambda2", "f_min", "ModeArray", "distance", "spin2x", "spin2y",
+  "longAscNodes", "spin2z", "f_ref", "phiRef", "ab", "meanPerAno", "a", "b"
+};
+
+static LALDict *create_dict(void)
+{
+  LALDict *dict = XLALCreateDict();
+  XLAL_CHECK_NULL(dict != NULL, XLAL_EFUNC);
+  for (size_t i = 0; i < NKEYS; ++i) {
+    XLAL_CHECK_NULL(XLALDictInsertINT4Value(dict, keys[i], i) == XLAL_SUCCESS, XLAL_EFUNC);
+  }
+  return dict;
+}
+
+/* check that iteration and XLALDictKeys() visit keys in the given order */
+static int check_order(LALDict *dict, const char *const *order, size_t n)
+{
+  XLAL_CHECK(XLALDictSize(dict) == n, XLAL_EFAILED);
+  LALDictIter iter;
+  XLALDictIterInit(&iter, dict);
+  for (size_t i = 0; i < n; ++i) {
+    LALDictEntry *entry = XLALDictIterNext(&iter);
+    XLAL_CHECK(entry != NULL, XLAL_EFAILED);
+    XLAL_CHECK(strcmp(XLALDictEntryGetKey(entry), order[i]) == 0, XLAL_EFAILED, "Iteration: expected key `%s', got `%s'", order[i], XLALDictEntryGetKey(entry));
+  }
+  XLAL_CHECK(XLALDictIterNext(&iter) == NULL, XLAL_EFAILED);
+  LALList *list = XLALDictKeys(dict);
+  XLAL_CHECK(list != NULL, XLAL_EFUNC);
+  XLAL_CHECK(XLALListSize(list) == n, XLAL_EFAILED);
+  LALListIter list_iter;
+  XLALListIterInit(&list_iter, list);
+  for (size_t i = n; i-- > 0; ) { /* XLALDictKeys() prepends each key to the list */
+    const LALListItem *item = XLALListIterNext(&list_iter);
+    XLAL_CHECK(item != NULL, XLAL_EFAILED);
+    const char *key = XLALListItemGetStringValue(item);
+    XLAL_CHECK(strcmp(key, order[i]) == 0, XLAL_EFAILED, "Keys: expected key `%s', got `%s'", order[i], key);
+  }
+  XLALDestroyList(list);
+  return XLAL_SUCCESS;
+}
+
+static int find_last(const char *key, const LALValue *value, void *thunk)
+{
+  (void)value;
+  return strcmp(key, *(const char **)thunk) == 0;
+}
+
+static int test_order(void)
+{
+  LALDict *dict = create_dict();
+  XLAL_CHECK(dict != NULL, XLAL_EFUNC);
+  XLAL_CHECK(check_order(dict, keys_order, NKEYS) == XLAL_SUCCESS, XLAL_EFUNC);
+  const char *last = keys_order[NKEYS - 1];
+  LALDictEntry *entry = XLALDictFind(dict, find_last, &last);
+  XLAL_CHECK(entry != NULL && strcmp(XLALDictEntryGetKey(entry), last) == 0, XLAL_EFAILED);
+
+  /* replacing a value, even with one of a different size, keeps the key in place */
+  XLAL_CHECK(XLALDictInsertStringValue(dict, "spin1x", "a string longer than an INT4") == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK(check_order(dict, keys_order, NKEYS) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK(strcmp(XLALDictLookupStringValue(dict, "spin1x"), "a string longer than an INT4") == 0, XLAL_EFAILED);
+
+  /* a copy iterates in the same order */
+  XLAL_CHECK(XLALDictInsertINT4Value(dict, "spin1x", 2) == XLAL_SUCCESS, XLAL_EFUNC);
+  LALDict *copy = XLALDictDuplicate(dict);
+  XLAL_CHECK(copy != NULL, XLAL_EFUNC);
+  XLAL_CHECK(check_order(copy, keys_order, NKEYS) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLALDestroyDict(copy);
+
+  /* removing a key and inserting it again moves it to the head of its bucket, as before */
+  XLAL_CHECK(XLALDictRemove(dict, "b") == 0, XLAL_EFUNC);
+  XLAL_CHECK(XLALDictRemove(dict, "b") == -1, XLAL_EFAILED);
+  XLAL_CHECK(check_order(dict, keys_order, NKEYS - 1) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK(XLALDictRemove(dict, "spin1y") == 0, XLAL_EFUNC);
+  XLAL_CHECK(XLALDictInsertINT4Value(dict, "spin1y", 3) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK(check_order(dict, keys_order, NKEYS - 1) == XLAL_SUCCESS, XLAL_EFUNC);
+
+  XLALDestroyDict(dict);
+  return XLAL_SUCCESS;
+}
+
+static int test_copy_on_write(void)
+{
+  LALDict *dict = create_dict();
+  XLAL_CHECK(dict != NULL, XLAL_EFUNC);
+  LALDict *copy = XLALDictDuplicate(dict);
+  XLAL_CHECK(copy != NULL, XLAL_EFUNC);
+
+  /* changes to either dictionary are not seen by the other */
+  XLAL_CHECK(XLALDictInsertREAL8Value(copy, "mass1", 1.4) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK(XLALDictInsertREAL8Value(copy, "new", 2.5) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK(XLALDictRemove(dict, "mass2") == 0, XLAL_EFUNC);
+  XLAL_CHECK(XLALDictLookupINT4Value(dict, "mass1") == 0, XLAL_EFAILED);
+  XLAL_CHECK(!XLALDictContains(dict, "new"), XLAL_EFAILED);
+  XLAL_CHECK(!XLALDictContains(dict, "mass2"), XLAL_EFAILED);
+  XLAL_CHECK(XLALDictLookupREAL8Value(copy, "mass1") == 1.4, XLAL_EFAILED);
+  XLAL_CHECK(XLALDictLookupREAL8Value(copy, "new") == 2.5, XLAL_EFAILED);
+  XLAL_CHECK(XLALDictLookupINT4Value(copy, "mass2") == 1, XLAL_EFAILED);
+  XLAL_CHECK(XLALDictSize(dict) == NKEYS - 1, XLAL_EFAILED);
+  XLAL_CHECK(XLALDictSize(copy) == NKEYS + 1, XLAL_EFAILED);
+
+  /* a copy outlives the dictionary it was copied from */
+  LALDict *copy2 = XLALDictDuplicate(copy);
+  XLAL_CHECK(copy2 != NULL, XLAL_EFUNC);
+  XLALDestroyDict(copy);
+  XLAL_CHECK(XLALDictLookupREAL8Value(copy2, "new") == 2.5, XLAL_EFAILED);
+  XLAL_CHECK(XLALDictLookupINT4Value(copy2, "spin2z") == 7, XLAL_EFAILED);
+  XLALDestroyDict(copy2);
+
+  /* writing through an entry obtained before the dictionary was copied does not change the copy */
+  LALDictEntry *entry = XLALDictLookup(dict, "spin1z");
+  XLAL_CHECK(entry != NULL, XLAL_EFUNC);
+  copy = XLALDictDuplicate(dict);
+  XLAL_CHECK(copy != NULL, XLAL_EFUNC);
+  const INT4 value = 42;
+  XLAL_CHECK(XLALDictEntrySetValue(entry, &value, sizeof(value), LAL_I4_TYPE_CODE) != NULL, XLAL_EFUNC);
+  XLAL_CHECK(XLALDictLookupINT4Value(dict, "spin1z") == 42, XLAL_EFAILED);
+  XLAL_CHECK(XLALDictLookupINT4Value(copy, "spin1z") == 4, XLAL_EFAILED);
+  XLALDestroyDict(copy);
+
+  /* same for entries obtained by iteration */
+  LALDict *dict2 = create_dict();
+  XLAL_CHECK(dict2 != NULL, XLAL_EFUNC);
+  LALDictIter iter;
+  XLALDictIterInit(&iter, dict2);
+  entry = XLALDictIterNext(&iter);
+  XLAL_CHECK(entry != NULL, XLAL_EFUNC);
+  copy = XLALDictDuplicate(dict2);
+  XLAL_CHECK(copy != NULL, XLAL_EFUNC);
+  XLAL_CHECK(XLALDictEntrySetValue(entry, &value, sizeof(value), LAL_I4_TYPE_CODE) != NULL, XLAL_EFUNC);
+  XLAL_CHECK(XLALDictLookupINT4Value(dict2, XLALDictEntryGetKey(entry)) == 42, XLAL_EFAILED);
+  XLAL_CHECK(XLALDictLookupINT4Value(copy, XLALDictEntryGetKey(entry)) != 42, XLAL_EFAILED);
+  XLALDestroyDict(copy);
+  XLALDestroyDict(dict2);
+
+  /* entries obtained from a shared table belong to that dictionary only */
+  copy = XLALDictDuplicate(dict);
+  XLAL_CHECK(copy != NULL, XLAL_EFUNC);
+  LALDict *copy3 = XLALDictDuplicate(copy);
+  XLAL_CHECK(copy3 != NULL, XLAL_EFUNC);
+  entry = XLALDictLookup(copy, "spin2x");
+  XLAL_CHECK(entry != NULL, XLAL_EFUNC);
+  XLAL_CHECK(XLALDictEntrySetValue(entry, &value, sizeof(value), LAL_I4_TYPE_CODE) != NULL, XLAL_EFUNC);
+  XLAL_CHECK(XLALDictLookupINT4Value(copy, "spin2x") == 42, XLAL_EFAILED);
+  XLAL_CHECK(XLALDictLookupINT4Value(copy3, "spin2x") == 5, XLAL_EFAILED);
+  XLAL_CHECK(XLALDictLookupINT4Value(dict, "spin2x") == 5, XLAL_EFAILED);
+  XLALDestroyDict(copy3);
+  XLALDestroyDict(copy);
+
+  XLALDestroyDict(dict);
+  return XLAL_SUCCESS;
+}
+
+static int test_key_handles(void)
+{
+  static LALDictKey key_mass1 = LAL_DICT_KEY_INIT("mass1");
+  static LALDictKey key_absent = LAL_DICT_KEY_INIT("absent");
+  LALDict *dict = create_dict();
+  XLAL_CHECK(dict != NULL, XLAL_EFUNC);
+  LALDict *other = XLALCreateDict();
+  XLAL_CHECK(other != NULL, XLAL_EFUNC);
+
+  /* a handle may be used with any dictionary */
+  for (int k = 0; k < 2; ++k) {
+    XLAL_CHECK(XLALDictContainsKey(dict, &key_mass1), XLAL_EFAILED);
+    XLAL_CHECK(!XLALDictContainsKey(other, &key_mass1), XLAL_EFAILED);
+    XLAL_CHECK(!XLALDictContainsKey(dict, &key_absent), XLAL_EFAILED);
+    const LALValue *value = XLALDictLookupKeyValue(dict, &key_mass1);
+    XLAL_CHECK(value != NULL && XLALValueGetINT4(value) == 0, XLAL_EFAILED);
+    XLAL_CHECK(XLALDictLookupKeyValue(other, &key_mass1) == NULL, XLAL_EFAILED);
+    XLAL_CHECK(XLALDictLookupKeyValue(dict, &key_absent) == NULL, XLAL_EFAILED);
+  }
+
+  /* handles see later changes */
+  XLAL_CHECK(XLALDictInsertINT4Value(other, "mass1", 9) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK(XLALDictRemove(dict, "mass1") == 0, XLAL_EFUNC);
+  XLAL_CHECK(!XLALDictContainsKey(dict, &key_mass1), XLAL_EFAILED);
+  const LALValue *value = XLALDictLookupKeyValue(other, &key_mass1);
+  XLAL_CHECK(value != NULL && XLALValueGetINT4(value) == 9, XLAL_EFAILED);
+
+  XLALDestroyDict(other);
+  XLALDestroyDict(dict);
+  return XLAL_SUCCESS;
+}
+
+static int test_growth(void)
+{
+  const size_t n = 5000;
+  char key[32];
+  LALDict *dict = XLALCreateDict();
+  XLAL_CHECK(dict != NULL, XLAL_EFUNC);
+
+  /* insert enough keys to grow the table several times */
+  for (size_t i = 0; i < n; ++i) {
+    snprintf(key, sizeof(key), "key%zu", i);
+    XLAL_CHECK(XLALDictInsertUINT8Value(dict, key, i) == XLAL_SUCCESS, XLAL_EFUNC);
+  }
+  XLAL_CHECK(XLALDictSize(dict) == n, XLAL_EFAILED);
+  LALDict *copy = XLALDictDuplicate(dict);
+  XLAL_CHECK(copy != NULL, XLAL_EFUNC);
+
+  /* remove and reinsert keys repeatedly, leaving many removed table elements behind */
+  for (size_t k = 0; k < 4; ++k) {
+    for (size_t i = k % 2; i < n; i += 2) {
+      snprintf(key, sizeof(key), "key%zu", i);
+      XLAL_CHECK(XLALDictRemove(dict, key) == 0, XLAL_EFUNC);
+    }
+    XLAL_CHECK(XLALDictSize(dict) == n / 2, XLAL_EFAILED);
+    for (size_t i = k % 2; i < n; i += 2) {
+      snprintf(key, sizeof(key), "key%zu", i);
+      XLAL_CHECK(!XLALDictContains(dict, key), XLAL_EFAILED);
+      XLAL_CHECK(XLALDictInsertUINT8Value(dict, key, i + k) == XLAL_SUCCESS, XLAL_EFUNC);
+    }
+    XLAL_CHECK(XLALDictSize(dict) == n, XLAL_EFAILED);
+  }
+
+  /* check every value, including those of the copy made before the keys were reinserted, and that
+     iteration visits every key once */
+  for (size_t i = 0; i < n; ++i) {
+    snprintf(key, sizeof(key), "key%zu", i);
+    XLAL_CHECK(XLALDictLookupUINT8Value(dict, key) == i + 2 + i % 2, XLAL_EFAILED);
+    XLAL_CHECK(XLALDictLookupUINT8Value(copy, key) == i, XLAL_EFAILED);
+  }
+  size_t count = 0;
+  LALDictIter iter;
+  XLALDictIterInit(&iter, dict);
+  for (LALDictEntry *entry = XLALDictIterNext(&iter); entry != NULL; entry = XLALDictIterNext(&iter)) {
+    ++count;
+  }
+  XLAL_CHECK(count == n, XLAL_EFAILED);
+
+  XLALDestroyDict(copy);
+  XLALDestroyDict(dict);
+  return XLAL_SUCCESS;
+}
+
+int main(void)
+{
+  XLAL_CHECK_MAIN(test_order() == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(test_copy_on_write() == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(test_key_handles() == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(test_growth() == XLAL_SUCCESS, XLAL_EFUNC);
+  LALCheckMemoryLeaks();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,136 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <lal/Date.h>
+#include <lal/LALConstants.h>
+#include <lal/LALStdlib.h>
+#include <lal/ResampleTimeSeries.h>
+#include <lal/TimeSeries.h>
+#include <lal/Units.h>
+
+static LIGOTimeGPS gps_epoch = { 100, 0 };
+
+static REAL8TimeSeries *sine_series(double deltaT, unsigned length, double freq)
+{
+	REAL8TimeSeries *s = XLALCreateREAL8TimeSeries("sine", &gps_epoch, 0.0, deltaT, &lalDimensionlessUnit, length);
+	unsigned i;
+	for(i = 0; i < length; i++)
+		s->data->data[i] = sin(LAL_TWOPI * freq * i * deltaT);
+	return s;
+}
+
+/* maximum error of a resampled sine wave, away from the corrupted ends */
+static double sine_error(const REAL8TimeSeries *s, double freq, unsigned skip)
+{
+	double t0 = XLALGPSDiff(&s->epoch, &gps_epoch);
+	double maxerr = 0.;
+	unsigned i;
+	for(i = skip; i + skip < s->data->length; i++) {
+		double err = fabs(s->data->data[i] - sin(LAL_TWOPI * freq * (t0 + i * s->deltaT)));
+		if(err > maxerr)
+			maxerr = err;
+	}
+	return maxerr;
+}
+
+/* resample a sine wave in one go, then in chunks of random length, and compare */
+static int test_ratio(double inRate, double outRate, double freq, unsigned length)
+{
+	REAL8TimeSeries *oneshot = sine_series(1. / inRate, length, freq);
+	REAL8TimeSeries *input = sine_series(1. / inRate, length, freq);
+	LALResampler *resampler = XLALCreateResampler(1. / inRate, 1. / outRate, 0);
+	unsigned skip = 2 * LAL_RESAMPLER_DEFAULT_HALF_LENGTH * (outRate > inRate ? outRate / inRate : 1);
+	unsigned start = 0, nout = 0, i;
+	double err, maxdiff = 0.;
+	int failed = 0;
+
+	if(!resampler || XLALPolyphaseResampleREAL8TimeSeries(oneshot, 1. / outRate) < 0) {
+		fprintf(stderr, "%g Hz -> %g Hz: resampling failed\n", inRate, outRate);
+		return 1;
+	}
+	if(fabs(oneshot->deltaT * outRate - 1.) > 1e-12 || oneshot->data->length != (unsigned) floor(length * outRate / inRate + 1e-9)) {
+		fprintf(stderr, "%g Hz -> %g Hz: wrong output sample interval %g or length %u\n", inRate, outRate, oneshot->deltaT, oneshot->data->length);
+		failed = 1;
+	}
+
+	err = sine_error(oneshot, freq, skip);
+	if(err > 1e-4) {
+		fprintf(stderr, "%g Hz -> %g Hz: error %g of resampled %g Hz sine wave too large\n", inRate, outRate, err, freq);
+		failed = 1;
+	}
+
+	while(start <= length) {
+		unsigned n = start < length ? 1 + rand() % 1000 : 0;
+		REAL8TimeSeries *chunk, *out;
+		if(start + n > length)
+			n = length - start;
+		chunk = n ? XLALCutREAL8TimeSeries(input, start, n) : NULL;
+		out = chunk ? XLALResamplerProcessREAL8TimeSeries(resampler, chunk) : XLALResamplerFlushREAL8TimeSeries(resampler);
+		if(!out) {
+			fprintf(stderr, "%g Hz -> %g Hz: streaming resampling failed\n", inRate, outRate);
+			return 1;
+		}
+		if(fabs(XLALGPSDiff(&out->epoch, &gps_epoch) - nout * oneshot->deltaT) > 1e-9) {
+			fprintf(stderr, "%g Hz -> %g Hz: wrong epoch of output chunk\n", inRate, outRate);
+			failed = 1;
+		}
+		for(i = 0; i < out->data->length && nout + i < oneshot->data->length; i++)
+			if(fabs(out->data->data[i] - oneshot->data->data[nout + i]) > maxdiff)
+				maxdiff = fabs(out->data->data[i] - oneshot->data->data[nout + i]);
+		nout += out->data->length;
+		XLALDestroyREAL8TimeSeries(chunk);
+		XLALDestroyREAL8TimeSeries(out);
+		if(start == length)
+			break;
+		start += n;
+	}
+	/* the streaming output must be the very same samples as the one-shot output */
+	if(nout != oneshot->data->length || maxdiff != 0.) {
+		fprintf(stderr, "%g Hz -> %g Hz: streaming output (%u samples) differs from one-shot output (%u samples) by %g\n", inRate, outRate, nout, oneshot->data->length, maxdiff);
+		failed = 1;
+	}
+
+	XLALDestroyResampler(resampler);
+	XLALDestroyREAL8TimeSeries(input);
+	XLALDestroyREAL8TimeSeries(oneshot);
+	return failed;
+}
+
+int main(void)
+{
+	int failed = 0;
+
+	failed |= test_ratio(16384., 4096., 100., 8192);
+	failed |= test_ratio(16384., 2048., 700., 8192);
+	failed |= test_ratio(4096., 16384., 300., 8192);
+	failed |= test_ratio(16384., 22050., 1000., 8192);
+	failed |= test_ratio(22050., 16384., 1000., 8192);
+	failed |= test_ratio(16384., 6000., 2000., 8192);
+
+	/* lengths for which the number of output samples N L / D is not an integer */
+	failed |= test_ratio(16384., 4096., 100., 8191);
+	failed |= test_ratio(16384., 2048., 700., 8189);
+	failed |= test_ratio(22050., 16384., 1000., 8192);
+	failed |= test_ratio(16384., 6000., 2000., 8190);
+
+	LALCheckMemoryLeaks();
+	return failed;
+}
@@ -19,10 +19,30 @@
 
 
 #include <complex.h>
+#include <math.h>
 #include <stdlib.h>
 
 #include <lal/TriggerInterpolation.h>
 
+
+/* Fill y with n neighbourhoods of 2 * window + 1 samples of random peaks,
+ * each with its maximum between samples -0.5 and 0.5 of its neighbourhood. */
+static void random_peaks(COMPLEX16 *y, int window, size_t n)
+{
+    size_t k;
+    int i;
+
+    for (k = 0; k < n; k ++)
+    {
+        const double t0 = (double) rand() / RAND_MAX - 0.5;
+        const double phi0 = 6.283185307179586 * rand() / RAND_MAX;
+        const double phi1 = 0.2 * rand() / RAND_MAX - 0.1;
+        const double sigma = 2 + 2.0 * rand() / RAND_MAX;
+        for (i = -window; i <= window; i ++)
+            y[k * (2 * window + 1) + window + i] = exp(-0.5 * (i - t0) * (i - t0) / (sigma * sigma)) * cexp(I * (phi0 + phi1 * i));
+    }
+}
+
 int main(__attribute__ ((unused)) int argc, __attribute__ ((unused)) char **argv)
 {
     int result;
@@ -92,6 +112,56 @@ int main(__attribute__ ((unused)) int argc, __attribute__ ((unused)) char **argv
             exit(EXIT_FAILURE);
     }
 
+    {
+        /* Fit a batch of random neighbourhoods, and compare with one at a time. */
+        const size_t n = 100;
+        const int window = 2;
+        COMPLEX16 y[n * (2 * window + 1)], ymax_batch[n], ymax;
+        COMPLEX8 yf[n * (2 * window + 1)], ymaxf_batch[n];
+        double tmax_batch[n], tmaxf_batch[n];
+        double *workspace = malloc(XLALQuadraticFitTriggerInterpolantBatchWorkspaceLength(interp) * sizeof(double));
+        size_t k, nvertex = 0;
+
+        if (!workspace)
+            exit(EXIT_FAILURE);
+
+        random_peaks(y, window, n);
+        for (k = 0; k < n * (2 * window + 1); k ++)
+        {
+            /* Scatter the absolute values so that some vertices fall inside (-1, 1). */
+            y[k] *= 0.5 + (double) rand() / RAND_MAX;
+            yf[k] = y[k];
+        }
+
+        result = XLALCOMPLEX16ApplyQuadraticFitTriggerInterpolantBatch(interp, tmax_batch, ymax_batch, y, n, workspace);
+        if (result)
+            exit(EXIT_FAILURE);
+        result = XLALCOMPLEX8ApplyQuadraticFitTriggerInterpolantBatch(interp, tmaxf_batch, ymaxf_batch, yf, n, workspace);
+        if (result)
+            exit(EXIT_FAILURE);
+
+        for (k = 0; k < n; k ++)
+        {
+            result = XLALCOMPLEX16ApplyQuadraticFitTriggerInterpolant(interp, &tmax, &ymax, &y[k * (2 * window + 1) + window]);
+            if (result)
+                exit(EXIT_FAILURE);
+
+            if (fabs(tmax_batch[k] - tmax) > 1e-10)
+                exit(EXIT_FAILURE);
+            if (ymax_batch[k] != ymax)
+                exit(EXIT_FAILURE);
+            if (fabs(tmaxf_batch[k] - tmax_batch[k]) > 1e-4)
+                exit(EXIT_FAILURE);
+            if (ymaxf_batch[k] != yf[k * (2 * window + 1) + window])
+                exit(EXIT_FAILURE);
+            nvertex += (tmax != 0);
+        }
+        if (nvertex == 0)
+            exit(EXIT_FAILURE);
+
+        free(workspace);
+    }
+
     XLALDestroyQuadraticFitTriggerInterpolant(interp);
     exit(EXIT_SUCCESS);
 }
@@ -1230,6 +1230,174 @@ int main( int argc, char *argv[] )
   XLALPrintInfo("Passed XLALSegListRange tests\n");
 
 
+  /*-------------------------------------------------------------------------*/
+  XLALPrintInfo("\n========== Segment list set operation tests \n");
+  /*-------------------------------------------------------------------------*/
+
+  {
+    LALSegList lists[2], result, window, expected;
+    LALBitset *masks[2];
+    INT4 itrial, ilist, k, t;
+
+    XLALSegListInit( &lists[0] );
+    XLALSegListInit( &lists[1] );
+    XLALSegListInit( &result );
+    XLALSegListInit( &window );
+    XLALSegListInit( &expected );
+    masks[0] = XLALBitsetCreate();
+    masks[1] = XLALBitsetCreate();
+    XLAL_CHECK( masks[0] && masks[1], XLAL_EFUNC );
+
+    /* bitset masks sample [0,200) s four times a second */
+    time1.gpsSeconds = 800000000;
+    time1.gpsNanoSeconds = 0;
+    time2 = time1;
+    time2.gpsSeconds += 200;
+    XLALSegSet( &seg, &time1, &time2, 0 );
+    XLALSegListAppend( &window, &seg );
+    srand( 1234 );
+
+    for ( itrial = 0; itrial < 100; itrial++ ) {
+      void *buf;
+      size_t size;
+
+      /* random, possibly overlapping and unsorted, segments of whole
+         seconds within [0,200) s; the first list is sometimes coalesced */
+      for ( ilist = 0; ilist < 2; ilist++ ) {
+        XLALSegListClear( &lists[ilist] );
+        for ( k = rand() % 30; k > 0; k-- ) {
+          time1.gpsSeconds = 800000000 + rand() % 200;
+          time1.gpsNanoSeconds = 0;
+          time2 = time1;
+          time2.gpsSeconds += rand() % 10;
+          XLALSegSet( &seg, &time1, &time2, k );
+          XLALSegListAppend( &lists[ilist], &seg );
+        }
+      }
+      if ( itrial % 2 ) {
+        XLALSegListCoalesce( &lists[0] );
+      }
+
+      for ( k = 0; k < 3; k++ ) {
+        const char *opname[3] = { "XLALSegListUnion", "XLALSegListIntersection", "XLALSegListSubtract" };
+        if ( k == 0 ) {
+          status = XLALSegListUnion( &result, &lists[0], &lists[1] );
+        } else if ( k == 1 ) {
+          status = XLALSegListIntersection( &result, &lists[0], &lists[1] );
+        } else {
+          status = XLALSegListSubtract( &result, &lists[0], &lists[1] );
+        }
+        if ( status != XLAL_SUCCESS || ! result.disjoint ) {
+          XLALPrintInfo("*FAIL* return check for %s: return=%d, xlalErrno=%d\n", opname[k], status, xlalErrno);
+          nfailures++;
+          continue;
+        }
+
+        /* compare with brute-force membership at the middle of each second */
+        for ( t = 0; t < 210; t++ ) {
+          int in[2], inresult, inexpected;
+          time1.gpsSeconds = 800000000 + t;
+          time1.gpsNanoSeconds = 500000000;
+          for ( ilist = 0; ilist < 2; ilist++ ) {
+            in[ilist] = 0;
+            for ( iseg = 0; iseg < (INT4) lists[ilist].length; iseg++ ) {
+              in[ilist] |= XLALGPSInSeg( &time1, &lists[ilist].segs[iseg] ) == 0;
+            }
+          }
+          inexpected = k == 0 ? ( in[0] || in[1] ) : k == 1 ? ( in[0] && in[1] ) : ( in[0] && ! in[1] );
+          inresult = XLALSegListSearch( &result, &time1 ) != NULL;
+          if ( inresult != inexpected ) {
+            XLALPrintInfo("*FAIL* functional check for %s: wrong membership of GPS %d.5\n", opname[k], time1.gpsSeconds);
+            nfailures++;
+            break;
+          }
+        }
+      }
+
+      /* overlapping segments of a coalesced list, by brute force */
+      XLALSegListCoalesce( &lists[1] );
+      for ( t = 0; t < 210; t += 7 ) {
+        UINT4 first = 0;
+        INT4 noverlap, nexpected = 0, efirst = -1;
+        time1.gpsSeconds = 800000000 + t;
+        time1.gpsNanoSeconds = 0;
+        time2 = time1;
+        time2.gpsSeconds += 5;
+        for ( iseg = 0; iseg < (INT4) lists[1].length; iseg++ ) {
+          if ( XLALGPSCmp( &lists[1].segs[iseg].start, &time2 ) < 0 && XLALGPSCmp( &lists[1].segs[iseg].end, &time1 ) > 0 ) {
+            if ( nexpected++ == 0 ) {
+              efirst = iseg;
+            }
+          }
+        }
+        noverlap = XLALSegListOverlaps( &lists[1], &time1, &time2, &first );
+        if ( noverlap != nexpected || ( nexpected && (INT4) first != efirst ) ) {
+          XLALPrintInfo("*FAIL* functional check for XLALSegListOverlaps: found %d segments, expected %d\n", noverlap, nexpected);
+          nfailures++;
+        }
+      }
+
+      /* veto by bitset masks, compared with the difference clipped to the
+         masked times */
+      time1.gpsSeconds = 800000000;
+      time1.gpsNanoSeconds = 0;
+      status = XLAL_SUCCESS;
+      for ( ilist = 0; ilist < 2; ilist++ ) {
+        status |= XLALBitsetClear( masks[ilist] );
+        status |= XLALSegListToBitset( masks[ilist], &lists[ilist], &time1, 0.25, 800 );
+      }
+      status |= XLALBitsetAndNot( masks[0], masks[1] );
+      status |= XLALSegListClear( &result );
+      status |= XLALSegListFromBitset( &result, masks[0], &time1, 0.25 );
+      status |= XLALSegListSubtract( &expected, &lists[0], &lists[1] );
+      status |= XLALSegListIntersection( &expected, &expected, &window );
+      status |= XLALSegListCoalesce( &expected );
+      if ( status != XLAL_SUCCESS || ! result.disjoint ) {
+        XLALPrintInfo("*FAIL* return check for XLALSegListToBitset/FromBitset: return=%d, xlalErrno=%d\n", status, xlalErrno);
+        nfailures++;
+      } else if ( result.length != expected.length ) {
+        XLALPrintInfo("*FAIL* functional check for XLALSegListFromBitset: %d segments, expected %d\n", result.length, expected.length);
+        nfailures++;
+      } else {
+        for ( iseg = 0; iseg < (INT4) result.length; iseg++ ) {
+          if ( XLALSegCmp( &result.segs[iseg], &expected.segs[iseg] ) ) {
+            XLALPrintInfo("*FAIL* functional check for XLALSegListFromBitset: segment %d differs\n", iseg);
+            nfailures++;
+            break;
+          }
+        }
+      }
+
+      /* binary round trip */
+      buf = XLALSegListSerialize( &lists[0], &size );
+      status = buf ? XLALSegListDeserialize( &result, buf, size ) : XLAL_FAILURE;
+      XLALFree( buf );
+      if ( status != XLAL_SUCCESS || result.length != lists[0].length
+           || result.sorted != lists[0].sorted || result.disjoint != lists[0].disjoint ) {
+        XLALPrintInfo("*FAIL* return check for XLALSegListSerialize/Deserialize: return=%d, xlalErrno=%d\n", status, xlalErrno);
+        nfailures++;
+      } else {
+        for ( iseg = 0; iseg < (INT4) result.length; iseg++ ) {
+          if ( XLALSegCmp( &result.segs[iseg], &lists[0].segs[iseg] ) || result.segs[iseg].id != lists[0].segs[iseg].id ) {
+            XLALPrintInfo("*FAIL* functional check for XLALSegListDeserialize: segment %d differs\n", iseg);
+            nfailures++;
+            break;
+          }
+        }
+      }
+    }
+
+    XLALSegListClear( &lists[0] );
+    XLALSegListClear( &lists[1] );
+    XLALSegListClear( &result );
+    XLALSegListClear( &window );
+    XLALSegListClear( &expected );
+    XLALBitsetDestroy( masks[0] );
+    XLALBitsetDestroy( masks[1] );
+  }
+  XLALPrintInfo("Done with segment list set operation tests\n");
+
+
   /*-------------------------------------------------------------------------*/
   /* Clean up leftover seg lists */
   if ( seglist1.segs ) { XLALSegListClear( &seglist1 ); }
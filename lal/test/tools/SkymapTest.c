@@ -230,6 +230,84 @@ static void uncertain(void)
     }
 }
 
+static void tabulated(void)
+{
+
+    // Check that the HEALPix directions tile the sphere, and that the
+    // engine reproduces XLALSkymapApply for every direction
+
+    XLALSkymapPlanType plan;
+    XLALSkymapEngineType* engine;
+    double wSw[5] = { 100., 80., 120., 60., 100. };
+    double *xSw[5];
+    double *logPosterior;
+    int siteNumbers[] = { LAL_LHO_4K_DETECTOR, LAL_LLO_4K_DETECTOR, LAL_VIRGO_DETECTOR, LAL_GEO_600_DETECTOR, LAL_LHO_2K_DETECTOR };
+    RandomParams* rng;
+    double z = 0.0;
+    long p;
+    int i, j, nside = 8;
+
+    rng = XLALCreateRandomParams(0);
+
+    for (p = 0; p != 12 * nside * nside; ++p)
+    {
+        double direction[2];
+        XLALSkymapHealpixRingDirection(direction, nside, p);
+        if (direction[0] < 0 || direction[0] > LAL_PI || direction[1] < 0 || direction[1] > LAL_TWOPI)
+        {
+            fprintf(stderr, "HEALPix pixel %ld has invalid direction\n", p);
+            exit(1);
+        }
+        z += cos(direction[0]);
+    }
+    if (fabs(z) > 1e-9)
+    {
+        fprintf(stderr, "HEALPix pixels are not symmetric about the equator\n");
+        exit(1);
+    }
+
+    XLALSkymapPlanConstruct(8192, 3, siteNumbers, &plan);
+    engine = XLALSkymapEngineCreate(&plan, nside);
+    logPosterior = malloc(sizeof(*logPosterior) * engine->npix);
+    XLALSkymapEngineSetKernel(engine, wSw, NULL);
+
+    for (i = 0; i != plan.n; ++i)
+    {
+        xSw[i] = malloc(sizeof(*xSw[i]) * plan.sampleFrequency);
+        for (j = 0; j != plan.sampleFrequency; ++j)
+        {
+            xSw[i][j] = XLALNormalDeviate(rng) * sqrt(wSw[i]);
+        }
+    }
+
+    XLALSkymapEngineApply(engine, xSw, 0.5, logPosterior);
+
+    for (p = 0; p != engine->npix; ++p)
+    {
+        double direction[2];
+        XLALSkymapDirectionPropertiesType properties;
+        XLALSkymapKernelType kernel;
+        double expected;
+
+        XLALSkymapHealpixRingDirection(direction, nside, p);
+        XLALSkymapDirectionPropertiesConstruct(&plan, direction, &properties);
+        XLALSkymapKernelConstruct(&plan, &properties, wSw, &kernel);
+        XLALSkymapApply(&plan, &properties, &kernel, xSw, 0.5, &expected);
+
+        if (fabs(logPosterior[p] - expected) > 1e-9 * (1 + fabs(expected)))
+        {
+            fprintf(stderr, "Engine does not match direct evaluation for pixel %ld\n", p);
+            exit(1);
+        }
+    }
+
+    for (i = 0; i != plan.n; ++i)
+        free(xSw[i]);
+    free(logPosterior);
+    XLALSkymapEngineDestroy(engine);
+    XLALDestroyRandomParams(rng);
+}
+
 
 int main(void)
 {
@@ -247,6 +325,10 @@ int main(void)
 
     uncertain();
 
+    // check the sky-map engine against direction-by-direction evaluation
+
+    tabulated();
+
     return 0;
 }
 
@@ -281,6 +281,55 @@ int main(void)
 
 	XLALDestroyREAL8TimeSeries(src);
 
+	/*
+	 * batched evaluation.  must reproduce sample-by-sample evaluation
+	 * at the same indexes exactly, and at the same times to within the
+	 * effect of rounding the times to integer nanoseconds.
+	 */
+
+	f = 1000.;
+
+	src = new_series(1.0 / 16384, 4096, 0.0);
+	add_sine(src, src->epoch, 1.0, f);
+	mdl = new_series(1.0 / 16384, 2048, 0.0);
+	XLALGPSAdd(&mdl->epoch, 1000.3 * src->deltaT);
+	dst = copy_series(mdl);
+
+	fprintf(stderr, "checking batched evaluation ...\n");
+	interp = XLALREAL8TimeSeriesInterpCreate(src, 19, NULL, NULL);
+	evaluate(mdl, interp, 1);
+	if(XLALREAL8TimeSeriesInterpEvalVector(interp, dst->data->data, &dst->epoch, dst->deltaT, NULL, dst->data->length, 1) < 0) {
+		fprintf(stderr, "error:  batched evaluation failed\n");
+		exit(1);
+	}
+	check_result(mdl, dst, 1e-12, -1e-12, +1e-12);
+	XLALREAL8TimeSeriesInterpDestroy(interp);
+	{
+	LALREAL8SequenceInterp *seqinterp = XLALREAL8SequenceInterpCreate(src->data, 19, NULL, NULL);
+	double x[2048];
+	unsigned i;
+	for(i = 0; i < 2048; i++)
+		x[i] = 1000.3 + i * 1.0001 + 0.2 * sin(i / 100.);
+	for(i = 0; i < 2048; i++)
+		mdl->data->data[i] = XLALREAL8SequenceInterpEval(seqinterp, x[i], 1);
+	XLALREAL8SequenceInterpDestroy(seqinterp);
+	seqinterp = XLALREAL8SequenceInterpCreate(src->data, 19, NULL, NULL);
+	XLALREAL8SequenceInterpEvalVector(seqinterp, dst->data->data, x, 2048, 1);
+	check_result(mdl, dst, 0., 0., 0.);
+	x[1000] = -1.;
+	if(XLALREAL8SequenceInterpEvalVector(seqinterp, dst->data->data, x, 2048, 1) == 0) {
+		fprintf(stderr, "error:  batched evaluation failed to report error beyond start of array\n");
+		exit(1);
+	}
+	XLALClearErrno();
+	XLALREAL8SequenceInterpDestroy(seqinterp);
+	}
+	fprintf(stderr, "... passed\n");
+
+	XLALDestroyREAL8TimeSeries(src);
+	XLALDestroyREAL8TimeSeries(dst);
+	XLALDestroyREAL8TimeSeries(mdl);
+
 	/*
 	 * success
 	 */
@@ -25,8 +25,10 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <lal/Date.h>
+#include <lal/LALArena.h>
 #include <lal/LALDatatypes.h>
 #include <lal/Sequence.h>
 #include <lal/TimeSeries.h>
@@ -135,6 +137,53 @@ int main(void)
 	}
 	XLALDestroyINT4TimeSeries(a);
 
+	/*
+	 * Arena
+	 */
+
+	/* check that series destroyed in an arena are recycled for the same type and length only */
+	XLALArenaPush();
+	x = random_timeseries(1024);
+	y = x;
+	XLALDestroyREAL4TimeSeries(x);
+	a = sequential_timeseries(1024);
+	x = random_timeseries(512);
+	if(x == y) {
+		fprintf(stderr, "Arena test 1a failed\n");
+		exit(1);
+	}
+	XLALDestroyREAL4TimeSeries(x);
+	x = XLALCreateREAL4TimeSeries("arena", NULL, 1.0, 0.5, NULL, 1024);
+	if((x != y) || (x->data->length != 1024) || strcmp(x->name, "arena") || (x->f0 != 1.0) || (x->deltaT != 0.5) || (XLALGPSDiff(&x->epoch, &gps_zero) != 0)) {
+		fprintf(stderr, "Arena test 1b failed\n");
+		exit(1);
+	}
+
+	/* check that parked series move to the enclosing arena, and that live series survive */
+	XLALArenaPush();
+	XLALDestroyREAL4TimeSeries(x);
+	if(XLALArenaDepth() != 2 || XLALArenaPop() != XLAL_SUCCESS || XLALArenaDepth() != 1) {
+		fprintf(stderr, "Arena test 2a failed\n");
+		exit(1);
+	}
+	x = random_timeseries(1024);
+	if(x != y) {
+		fprintf(stderr, "Arena test 2b failed\n");
+		exit(1);
+	}
+	XLALDestroyREAL4TimeSeries(x);
+	XLALArenaPop();
+	for(i = 0; i < (int) a->data->length; i++)
+		if(a->data->data[i] != i) {
+			fprintf(stderr, "Arena test 2c failed\n");
+			exit(1);
+		}
+	XLALDestroyINT4TimeSeries(a);
+	if(XLALArenaDepth() != 0) {
+		fprintf(stderr, "Arena test 2d failed\n");
+		exit(1);
+	}
+
 	/*
 	 * Success
 	 */
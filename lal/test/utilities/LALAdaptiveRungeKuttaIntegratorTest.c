@@ -0,0 +1,154 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <math.h>
+#include <stdio.h>
+
+#include <lal/LALAdaptiveRungeKuttaIntegrator.h>
+#include <lal/LALConstants.h>
+#include <lal/LALStdlib.h>
+
+/* y' = y cos(t), with solution y = exp(sin(t)) */
+static int exp_sin_dydt(double t, const double y[], double dydt[], void *params)
+{
+	(void) params;
+	dydt[0] = y[0] * cos(t);
+	return GSL_SUCCESS;
+}
+
+/* Kepler problem in the plane, unit gravitational parameter */
+static int kepler_dydt(double t, const double y[], double dydt[], void *params)
+{
+	double r3 = pow(y[0] * y[0] + y[1] * y[1], 1.5);
+	(void) t;
+	(void) params;
+	dydt[0] = y[2];
+	dydt[1] = y[3];
+	dydt[2] = -y[0] / r3;
+	dydt[3] = -y[1] / r3;
+	return GSL_SUCCESS;
+}
+
+/* stop at the first crossing of the x axis from above */
+static int kepler_stop(double t, const double y[], double dydt[], void *params)
+{
+	(void) t;
+	(void) dydt;
+	(void) params;
+	return y[1] < 0 ? 1 : GSL_SUCCESS;
+}
+
+/* evenly sampled dense output agrees with the exact solution */
+static int test_dense_output(void)
+{
+	const double deltat = 0.01, tend = 20.;
+	LALAdaptiveRungeKuttaIntegrator *integrator = XLALAdaptiveRungeKutta4Init(1, exp_sin_dydt, NULL, 1e-13, 1e-13);
+	REAL8Array *yout = NULL;
+	double y[1] = { 1. }, maxerr = 0.;
+	int len, j, failed = 0;
+
+	len = XLALAdaptiveRungeKuttaDormandPrince853(integrator, NULL, y, 0., tend, deltat, &yout);
+	if(len != (int) round(tend / deltat) + 1) {
+		fprintf(stderr, "dense output has %d samples, expected %d\n", len, (int) round(tend / deltat) + 1);
+		failed = 1;
+	}
+	for(j = 0; j < len; j++) {
+		double t = yout->data[j];
+		if(fabs(t - j * deltat) > 1e-12) {
+			fprintf(stderr, "dense output sample %d at wrong time %g\n", j, t);
+			failed = 1;
+			break;
+		}
+		maxerr = fmax(maxerr, fabs(yout->data[len + j] - exp(sin(t))));
+	}
+	if(maxerr > 1e-10) {
+		fprintf(stderr, "dense output differs from the exact solution by %g\n", maxerr);
+		failed = 1;
+	}
+
+	XLALDestroyREAL8Array(yout);
+	XLALAdaptiveRungeKuttaFree(integrator);
+	return failed;
+}
+
+/* an eccentric orbit returns to its initial state after whole periods */
+static int test_kepler(double e)
+{
+	const double tend = 3. * LAL_TWOPI;
+	LALAdaptiveRungeKuttaIntegrator *integrator = XLALAdaptiveRungeKutta4Init(4, kepler_dydt, NULL, 1e-12, 1e-12);
+	REAL8Array *yout = NULL;
+	double yinit[4] = { 1. - e, 0., 0., sqrt((1. + e) / (1. - e)) };
+	double y[4], maxerr = 0.;
+	int len, i, failed = 0;
+
+	for(i = 0; i < 4; i++)
+		y[i] = yinit[i];
+	len = XLALAdaptiveRungeKuttaDormandPrince853(integrator, NULL, y, 0., tend, 0., &yout);
+	if(len < 2 || fabs(yout->data[len - 1] - tend) > 1e-12) {
+		fprintf(stderr, "e = %g: step output does not end at the final time\n", e);
+		failed = 1;
+	}
+	for(i = 0; i < 4; i++) {
+		maxerr = fmax(maxerr, fabs(y[i] - yinit[i]));
+		if(len > 0 && y[i] != yout->data[(i + 1) * len + len - 1]) {
+			fprintf(stderr, "e = %g: final state differs from last output step\n", e);
+			failed = 1;
+		}
+	}
+	if(maxerr > 1e-8) {
+		fprintf(stderr, "e = %g: orbit differs from initial state by %g after %d steps\n", e, maxerr, len - 1);
+		failed = 1;
+	}
+
+	XLALDestroyREAL8Array(yout);
+	XLALAdaptiveRungeKuttaFree(integrator);
+	return failed;
+}
+
+/* the stopping test ends the integration at apoapsis */
+static int test_stop(void)
+{
+	const double e = 0.5;
+	LALAdaptiveRungeKuttaIntegrator *integrator = XLALAdaptiveRungeKutta4Init(4, kepler_dydt, kepler_stop, 1e-12, 1e-12);
+	REAL8Array *yout = NULL;
+	double y[4] = { 1. - e, 0., 0., sqrt((1. + e) / (1. - e)) };
+	int len, failed = 0;
+
+	integrator->stopontestonly = 1;
+	len = XLALAdaptiveRungeKuttaDormandPrince853(integrator, NULL, y, 0., 1., 0.001, &yout);
+	if(integrator->returncode != 1 || len < 1 || yout->data[len - 1] < LAL_PI - 0.01 || yout->data[len - 1] > LAL_PI + 1.) {
+		fprintf(stderr, "integration stopped with code %d at t = %g, expected %g\n", integrator->returncode, len > 0 ? yout->data[len - 1] : 0., LAL_PI);
+		failed = 1;
+	}
+
+	XLALDestroyREAL8Array(yout);
+	XLALAdaptiveRungeKuttaFree(integrator);
+	return failed;
+}
+
+int main(void)
+{
+	int failed = 0;
+
+	failed |= test_dense_output();
+	failed |= test_kepler(0.);
+	failed |= test_kepler(0.6);
+	failed |= test_stop();
+
+	LALCheckMemoryLeaks();
+	return failed;
+}
@@ -18,10 +18,48 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include <gsl/gsl_rng.h>
 #include <lal/LALStdio.h>
 #include <lal/LALBitset.h>
 
+#define NBITS 4096
+
+typedef struct {
+  UINT8 n0;
+  BOOLEAN *runs;
+  UINT8 last_end;
+} run_param;
+
+/* Record a run of set bits, checking that runs are visited in order and are maximal */
+static int record_run( void *param, const UINT8 start, const UINT8 count )
+{
+  run_param *p = ( run_param * ) param;
+  XLAL_CHECK( count > 0, XLAL_EFAILED, "Empty run at index %"LAL_UINT8_FORMAT, start );
+  XLAL_CHECK( start >= p->n0 && start + count <= p->n0 + NBITS, XLAL_EFAILED, "Run [%"LAL_UINT8_FORMAT", %"LAL_UINT8_FORMAT") out of range", start, start + count );
+  XLAL_CHECK( p->last_end == 0 || start > p->last_end, XLAL_EFAILED, "Run at index %"LAL_UINT8_FORMAT" not in order, or not maximal", start );
+  for ( UINT8 n = start; n < start + count; ++n ) {
+    p->runs[n - p->n0] = 1;
+  }
+  p->last_end = start + count;
+  return XLAL_SUCCESS;
+}
+
+/* Check a bitset against reference bits */
+static int check_bits( const LALBitset *bs, const UINT8 n0, const BOOLEAN *bits, const char *name )
+{
+  UINT8 count = 0, nbits = 0;
+  for ( size_t n = 0; n < NBITS; ++n ) {
+    BOOLEAN is_set = 0;
+    XLAL_CHECK( XLALBitsetGet( bs, n0 + n, &is_set ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( !is_set == !bits[n], XLAL_EFAILED, "%s: inconsistent bit at index %"LAL_UINT8_FORMAT": LALBitset=%i, reference=%i", name, n0 + n, is_set, bits[n] );
+    nbits += bits[n] ? 1 : 0;
+  }
+  XLAL_CHECK( XLALBitsetCount( bs, &count ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( count == nbits, XLAL_EFAILED, "%s: inconsistent count: LALBitset=%"LAL_UINT8_FORMAT", reference=%"LAL_UINT8_FORMAT, name, count, nbits );
+  return XLAL_SUCCESS;
+}
+
 int main( void )
 {
 
@@ -30,7 +68,7 @@ int main( void )
   XLAL_CHECK_MAIN( bs != NULL, XLAL_EFUNC );
 
   /* Create some random bits */
-  BOOLEAN XLAL_INIT_DECL( bits, [4096] );
+  BOOLEAN XLAL_INIT_DECL( bits, [NBITS] );
   gsl_rng *r = gsl_rng_alloc( gsl_rng_mt19937 );
   XLAL_CHECK_MAIN( r != NULL, XLAL_ESYS );
   int nbits = 0;
@@ -57,6 +95,85 @@ int main( void )
     XLAL_CHECK_MAIN( !is_set == !bits[n], XLAL_EFAILED, "Inconsistent bit at index %"LAL_UINT8_FORMAT": LALBitset=%i, reference=%i", n0 + n, is_set, bits[n] );
   }
 
+  /* Count bits */
+  XLAL_CHECK_MAIN( check_bits( bs, n0, bits, "set" ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* Find set bits in order */
+  {
+    UINT8 idx = 0;
+    BOOLEAN found = 0;
+    size_t n = 0;
+    XLAL_CHECK_MAIN( XLALBitsetNextSet( bs, 0, &idx, &found ) == XLAL_SUCCESS, XLAL_EFUNC );
+    while ( found ) {
+      while ( n < XLAL_NUM_ELEM( bits ) && !bits[n] ) {
+        ++n;
+      }
+      XLAL_CHECK_MAIN( n < XLAL_NUM_ELEM( bits ) && idx == n0 + n, XLAL_EFAILED, "Inconsistent next set bit: LALBitset=%"LAL_UINT8_FORMAT", reference=%"LAL_UINT8_FORMAT, idx, n0 + n );
+      ++n;
+      XLAL_CHECK_MAIN( XLALBitsetNextSet( bs, idx + 1, &idx, &found ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+    while ( n < XLAL_NUM_ELEM( bits ) && !bits[n] ) {
+      ++n;
+    }
+    XLAL_CHECK_MAIN( n == XLAL_NUM_ELEM( bits ), XLAL_EFAILED, "Set bit at index %"LAL_UINT8_FORMAT" not found", n0 + n );
+  }
+
+  /* Visit runs of set bits */
+  {
+    BOOLEAN XLAL_INIT_DECL( runs, [NBITS] );
+    run_param p = { .n0 = n0, .runs = runs };
+    XLAL_CHECK_MAIN( XLALBitsetVisitRuns( bs, record_run, &p ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( memcmp( runs, bits, sizeof( bits ) ) == 0, XLAL_EFAILED, "Runs of set bits inconsistent with reference" );
+  }
+
+  /* Set and unset random ranges of bits in a second bitset */
+  LALBitset *bs2 = XLALBitsetCreate();
+  XLAL_CHECK_MAIN( bs2 != NULL, XLAL_EFUNC );
+  BOOLEAN XLAL_INIT_DECL( bits2, [NBITS] );
+  for ( int k = 0; k < 64; ++k ) {
+    const UINT8 start = gsl_rng_get( r ) % NBITS;
+    const UINT8 count = gsl_rng_get( r ) % ( NBITS - start + 1 );
+    const BOOLEAN is_set = ( k % 3 != 2 );
+    XLAL_CHECK_MAIN( XLALBitsetSetRange( bs2, n0 + start, count, is_set ) == XLAL_SUCCESS, XLAL_EFUNC );
+    for ( UINT8 n = start; n < start + count; ++n ) {
+      bits2[n] = is_set;
+    }
+  }
+  XLAL_CHECK_MAIN( check_bits( bs2, n0, bits2, "set range" ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* Combine bitsets word-wise */
+  {
+    BOOLEAN XLAL_INIT_DECL( ref_or, [NBITS] );
+    BOOLEAN XLAL_INIT_DECL( ref_and, [NBITS] );
+    BOOLEAN XLAL_INIT_DECL( ref_andnot, [NBITS] );
+    for ( size_t n = 0; n < XLAL_NUM_ELEM( bits ); ++n ) {
+      ref_or[n] = bits[n] || bits2[n];
+      ref_and[n] = bits[n] && bits2[n];
+      ref_andnot[n] = bits[n] && !bits2[n];
+    }
+    LALBitset *bs_or = XLALBitsetCreate();
+    LALBitset *bs_and = XLALBitsetCreate();
+    LALBitset *bs_andnot = XLALBitsetCreate();
+    XLAL_CHECK_MAIN( bs_or != NULL && bs_and != NULL && bs_andnot != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALBitsetOr( bs_or, bs ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALBitsetOr( bs_and, bs ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALBitsetOr( bs_andnot, bs ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( check_bits( bs_or, n0, bits, "copy" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALBitsetOr( bs_or, bs2 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALBitsetAnd( bs_and, bs2 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALBitsetAndNot( bs_andnot, bs2 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( check_bits( bs_or, n0, ref_or, "or" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( check_bits( bs_and, n0, ref_and, "and" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( check_bits( bs_andnot, n0, ref_andnot, "andnot" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALBitsetAndNot( bs_andnot, bs_andnot ) == XLAL_SUCCESS, XLAL_EFUNC );
+    UINT8 count = 1;
+    XLAL_CHECK_MAIN( XLALBitsetCount( bs_andnot, &count ) == XLAL_SUCCESS && count == 0, XLAL_EFAILED );
+    XLALBitsetDestroy( bs_or );
+    XLALBitsetDestroy( bs_and );
+    XLALBitsetDestroy( bs_andnot );
+  }
+  XLALBitsetDestroy( bs2 );
+
   /* Clear bitset */
   XLAL_CHECK_MAIN( XLALBitsetClear( bs ) == XLAL_SUCCESS, XLAL_EFUNC );
   for ( size_t n = 0; n < XLAL_NUM_ELEM( bits ); ++n ) {
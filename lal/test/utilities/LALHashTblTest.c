@@ -23,6 +23,7 @@
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_permutation.h>
 #include <lal/LALHashTbl.h>
+#include <lal/LALThreadPool.h>
 
 typedef struct {
   int key;
@@ -50,6 +51,36 @@ static int cmp_elem( const void *x, const void *y )
   return ex->key - ey->key;
 }
 
+/* Add elements with keys in [0, 499] to a sharded hash table, each twice, from concurrent tasks */
+static int add_sharded( void *arg, size_t i )
+{
+  LALShardedHashTbl *sht = ( LALShardedHashTbl * ) arg;
+  const int key = i % 500;
+  void *x = new_elem( key, 3*key );
+  XLAL_CHECK( x != NULL, XLAL_ENOMEM );
+  const elem *y;
+  XLAL_CHECK( XLALShardedHashTblFindOrAdd( sht, x, ( const void ** ) &y ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( y != NULL ) {
+    XLAL_CHECK( y->key == key && y->value == 3*key, XLAL_EFAILED );
+    XLALFree( x );
+  }
+  return XLAL_SUCCESS;
+}
+
+/* Find, then remove, elements of a sharded hash table with odd keys, from concurrent tasks */
+static int remove_sharded( void *arg, size_t i )
+{
+  LALShardedHashTbl *sht = ( LALShardedHashTbl * ) arg;
+  elem x = { .key = i };
+  const elem *y;
+  XLAL_CHECK( XLALShardedHashTblFind( sht, &x, ( const void ** ) &y ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( y != NULL && y->value == 3*x.key, XLAL_EFAILED );
+  if ( i % 2 == 1 ) {
+    XLAL_CHECK( XLALShardedHashTblRemove( sht, &x ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  return XLAL_SUCCESS;
+}
+
 int main( void )
 {
 
@@ -128,6 +159,29 @@ int main( void )
     XLAL_CHECK_MAIN( y->value == 3*y->key - ( i / 100 ), XLAL_EFAILED );
   }
 
+  /* Test a sharded hash table, filled and emptied by concurrent tasks */
+  {
+    LALShardedHashTbl *sht = XLALShardedHashTblCreate( XLALFree, hash_elem, cmp_elem, 0 );
+    XLAL_CHECK_MAIN( sht != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALThreadPoolRun( add_sharded, sht, 1000 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALShardedHashTblSize( sht ) == 500, XLAL_EFAILED );
+    XLAL_CHECK_MAIN( XLALThreadPoolRun( remove_sharded, sht, 500 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALShardedHashTblSize( sht ) == 250, XLAL_EFAILED );
+    for ( int i = 0; i < 500; ++i ) {
+      elem x = { .key = i };
+      elem *y;
+      XLAL_CHECK_MAIN( XLALShardedHashTblExtract( sht, &x, ( void ** ) &y ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( ( y != NULL ) == ( i % 2 == 0 ), XLAL_EFAILED );
+      if ( y != NULL ) {
+        XLAL_CHECK_MAIN( XLALShardedHashTblAdd( sht, y ) == XLAL_SUCCESS, XLAL_EFUNC );
+      }
+    }
+    XLAL_CHECK_MAIN( XLALShardedHashTblSize( sht ) == 250, XLAL_EFAILED );
+    XLAL_CHECK_MAIN( XLALShardedHashTblClear( sht ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALShardedHashTblSize( sht ) == 0, XLAL_EFAILED );
+    XLALShardedHashTblDestroy( sht );
+  }
+
   /* Cleanup */
   gsl_rng_free( r );
   XLALHashTblDestroy( ht );
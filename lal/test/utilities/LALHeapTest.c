@@ -317,6 +317,44 @@ int main( void )
     }
   }
 
+  /* Merge heaps filled with parts of the input, e.g. by several threads */
+  {
+    printf( "\n----- merge -----\n" );
+    LALHeap *parth[4], *part10h[4];
+    for ( int k = 0; k < 4; ++k ) {
+      parth[k] = XLALHeapCreate( XLALFree, 0, -1, cmp_ptr_int );
+      XLAL_CHECK_MAIN( parth[k] != NULL, XLAL_EFUNC );
+      part10h[k] = XLALHeapCreate( XLALFree, 10, -1, cmp_ptr_int );
+      XLAL_CHECK_MAIN( part10h[k] != NULL, XLAL_EFUNC );
+    }
+    for ( int i = 0; i < 100; ++i ) {
+      void *x = new_int( input[i] );
+      XLAL_CHECK_MAIN( XLALHeapAdd( parth[i % 4], &x ) == XLAL_SUCCESS && x == NULL, XLAL_EFUNC );
+      x = new_int( input[i] );
+      XLAL_CHECK_MAIN( XLALHeapAdd( part10h[( i / 7 ) % 4], &x ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLALFree( x );
+    }
+    for ( int k = 1; k < 4; ++k ) {
+      XLAL_CHECK_MAIN( XLALHeapMerge( parth[0], parth[k] ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( XLALHeapSize( parth[k] ) == 0, XLAL_EFAILED );
+      XLAL_CHECK_MAIN( XLALHeapMerge( part10h[0], part10h[k] ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( XLALHeapSize( part10h[k] ) == 0, XLAL_EFAILED );
+    }
+    XLAL_CHECK_MAIN( XLALHeapSize( parth[0] ) == 100, XLAL_EFAILED );
+    XLAL_CHECK_MAIN( XLALHeapSize( part10h[0] ) == 10 && XLALHeapIsFull( part10h[0] ), XLAL_EFAILED );
+    int **ref0 = &ref[0];
+    XLAL_CHECK_MAIN( XLALHeapVisit( parth[0], check_ptr_int, &ref0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    ref0 = &ref[90];
+    XLAL_CHECK_MAIN( XLALHeapVisit( part10h[0], check_ptr_int, &ref0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    int errnum;
+    XLAL_TRY_SILENT( XLALHeapMerge( parth[0], maxh ), errnum );
+    XLAL_CHECK_MAIN( errnum == XLAL_EINVAL, XLAL_EFAILED, "merged incompatible heaps" );
+    for ( int k = 0; k < 4; ++k ) {
+      XLALHeapDestroy( parth[k] );
+      XLALHeapDestroy( part10h[k] );
+    }
+  }
+
   /* Clear a heap */
   XLAL_CHECK_MAIN( XLALHeapClear( minh ) == XLAL_SUCCESS, XLAL_EFUNC );
   XLAL_CHECK_MAIN( XLALHeapSize( minh ) == 0, XLAL_EFAILED );
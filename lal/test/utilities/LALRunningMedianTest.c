@@ -22,6 +22,7 @@
 #include <lal/LALStdlib.h>
 #include <lal/LALConstants.h>
 #include <lal/LALMalloc.h>
+#include <lal/AVFactories.h>
 #include <lal/SeqFactories.h>
 #include <lal/PrintVector.h>
 #include <lal/LALRunningMedian.h>
@@ -113,6 +114,8 @@ int testDRunningMedian(LALStatus *stat, REAL8Sequence *input, UINT4 length,
 		       LALRunningMedianPar param, BOOLEAN verbose, BOOLEAN bmimpl);
 int testSRunningMedian(LALStatus *stat, REAL4Sequence *input, UINT4 length,
 		       LALRunningMedianPar param, BOOLEAN verbose, BOOLEAN bmimpl);
+int testRunningQuantile(REAL8Sequence *input8, REAL4Sequence *input4, UINT4 length,
+		        UINT4 blocksize, REAL8 quantile);
 
 
 struct rngmed_val_index {
@@ -351,6 +354,57 @@ int testSRunningMedian(LALStatus *stat, REAL4Sequence *input, UINT4 length,
  **************/
 
 
+int testRunningQuantile(REAL8Sequence *input8, REAL4Sequence *input4, UINT4 length,
+		        UINT4 blocksize, REAL8 quantile) {
+/* Test the XLALDRunningQuantile and XLALSRunningQuantile functions by
+   comparing the results to individually calculated quantiles */
+
+  REAL8 pos, frac, value;
+  REAL8Sequence *quantiles8;
+  REAL4Sequence *quantiles4;
+  struct rngmed_val_index *index_block;
+  UINT4 i,k,rank;
+
+  quantiles8 = XLALCreateREAL8Vector( length - blocksize + 1 );
+  quantiles4 = XLALCreateREAL4Vector( length - blocksize + 1 );
+  index_block = (struct rngmed_val_index *)LALCalloc(blocksize, sizeof(struct rngmed_val_index));
+  if ( !quantiles8 || !quantiles4 || !index_block ) {
+    EXIT( LALRUNNINGMEDIANTESTC_EALOC, argv0, LALRUNNINGMEDIANTESTC_MSGEALOC );
+  }
+  if ( XLALDRunningQuantile( quantiles8, input8, blocksize, quantile ) != XLAL_SUCCESS ||
+       XLALSRunningQuantile( quantiles4, input4, blocksize, quantile ) != XLAL_SUCCESS ) {
+    printf("ERROR: XLALRunningQuantile failed with xlalErrno %d\n", xlalErrno);
+    EXIT( LALRUNNINGMEDIANTESTC_ESUB, argv0, LALRUNNINGMEDIANTESTC_MSGESUB );
+  }
+
+  pos = quantile * (blocksize - 1);
+  rank = (UINT4) floor(pos);
+  frac = pos - rank;
+
+  /* compare all quantiles */
+  for(i=0;i<length-blocksize+1;i++) {
+    for(k=0;k<blocksize;k++){
+      index_block[k].data=input8->data[k+i];
+      index_block[k].index=k;
+    }
+    qsort(index_block, blocksize, sizeof(struct rngmed_val_index),rngmed_sortindex);
+    value = index_block[rank].data;
+    if (frac > 0)
+      value += frac * (index_block[rank+1].data - index_block[rank].data);
+    if(compare_double(value,quantiles8->data[i]) || compare_single(value,quantiles4->data[i])) {
+      printf("ERROR: index:%d quantile:% 22.15e running quantile:% 22.15e/% 22.15e\n",
+             i, value, quantiles8->data[i], quantiles4->data[i]);
+      EXIT( LALRUNNINGMEDIANTESTC_EFALSE, argv0, LALRUNNINGMEDIANTESTC_MSGEFALSE );
+    }
+  }
+
+  LALFree(index_block);
+  XLALDestroyREAL8Vector(quantiles8);
+  XLALDestroyREAL4Vector(quantiles4);
+  return(0);
+}
+
+
 int main( int argc, char **argv )
 {
   LALStatus stat;
@@ -680,6 +734,37 @@ int main( int argc, char **argv )
     printf("  PASS: LALSRunningMedian2(%d,%d)\n",length,param.blocksize);
   }
 
+  /* check small block sizes, for which LALRunningMedian2 does not use the two-heap algorithm */
+  for(param.blocksize = 101; param.blocksize >= 100; param.blocksize--) {
+    if (param.blocksize > length)
+      continue;
+
+    if(testDRunningMedian(&stat,input8,length,param,verbose,1)) {
+      EXIT( LALRUNNINGMEDIANTESTC_EFALSE, argv0, LALRUNNINGMEDIANTESTC_MSGEFALSE );
+    } else {
+      printf("  PASS: LALDRunningMedian2(%d,%d)\n",length,param.blocksize);
+    }
+
+    if(testSRunningMedian(&stat,input4,length,param,verbose,1)) {
+      EXIT( LALRUNNINGMEDIANTESTC_EFALSE, argv0, LALRUNNINGMEDIANTESTC_MSGEFALSE );
+    } else {
+      printf("  PASS: LALSRunningMedian2(%d,%d)\n",length,param.blocksize);
+    }
+  }
+
+
+  /* check running quantiles */
+  {
+    const REAL8 quantiles[] = {0.0, 0.1, 0.5, 0.75, 1.0};
+    for(i=0;i<sizeof(quantiles)/sizeof(quantiles[0]);i++) {
+      if(testRunningQuantile(input8,input4,length,blocksize,quantiles[i])) {
+        EXIT( LALRUNNINGMEDIANTESTC_EFALSE, argv0, LALRUNNINGMEDIANTESTC_MSGEFALSE );
+      } else {
+        printf("  PASS: XLALRunningQuantile(%d,%d,%g)\n",length,blocksize,quantiles[i]);
+      }
+    }
+  }
+
 
   /* free dummy input memory */
   LALDDestroyVector(&stat,&input8);
@@ -0,0 +1,213 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <config.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <lal/LALStdlib.h>
+#include <lal/AVFactories.h>
+#include <lal/MatrixUtils.h>
+#include <lal/XLALError.h>
+
+#define COUNT 10
+#define TOL 1e-9
+
+/* fill a batch with symmetric, diagonally-dominant matrices */
+static void fill_batch( REAL8Array *a, UINT4 count, UINT4 n )
+{
+  for ( UINT4 m = 0; m < count; ++m ) {
+    REAL8 *x = a->data + m*n*n;
+    for ( UINT4 i = 0; i < n; ++i ) {
+      for ( UINT4 j = 0; j <= i; ++j ) {
+        x[i*n + j] = x[j*n + i] = sin( 1.0 + m + 0.37*i + 0.91*j*j ) + ( i == j ? n : 0 );
+      }
+    }
+  }
+}
+
+/* form the product of two n-by-n matrices, naively */
+static void multiply( REAL8 *out, const REAL8 *x, const REAL8 *y, UINT4 n )
+{
+  for ( UINT4 i = 0; i < n; ++i ) {
+    for ( UINT4 j = 0; j < n; ++j ) {
+      out[i*n + j] = 0;
+      for ( UINT4 k = 0; k < n; ++k ) {
+        out[i*n + j] += x[i*n + k] * y[k*n + j];
+      }
+    }
+  }
+}
+
+static int test_batch( UINT4 n )
+{
+  UINT4Vector *dims = XLALCreateUINT4Vector( 3 );
+  XLAL_CHECK( dims != NULL, XLAL_EFUNC );
+  dims->data[0] = COUNT;
+  dims->data[1] = dims->data[2] = n;
+  REAL8Array *orig = XLALCreateREAL8Array( dims );
+  REAL8Array *work = XLALCreateREAL8Array( dims );
+  REAL8Array *result = XLALCreateREAL8Array( dims );
+  XLAL_CHECK( orig != NULL && work != NULL && result != NULL, XLAL_EFUNC );
+  dims->length = 2;
+  REAL8Array *values = XLALCreateREAL8Array( dims );
+  XLAL_CHECK( values != NULL, XLAL_EFUNC );
+  dims->length = 3;
+  REAL8Vector *det = XLALCreateREAL8Vector( COUNT );
+  XLAL_CHECK( det != NULL, XLAL_EFUNC );
+  REAL8 *prod = XLALMalloc( n * n * sizeof( *prod ) );
+  XLAL_CHECK( prod != NULL, XLAL_ENOMEM );
+  fill_batch( orig, COUNT, n );
+
+  /* batched product agrees with the naive product */
+  XLAL_CHECK( XLALDMatrixMultiplyBatch( result, orig, orig ) == XLAL_SUCCESS, XLAL_EFUNC );
+  for ( UINT4 m = 0; m < COUNT; ++m ) {
+    multiply( prod, orig->data + m*n*n, orig->data + m*n*n, n );
+    for ( UINT4 i = 0; i < n*n; ++i ) {
+      XLAL_CHECK( fabs( result->data[m*n*n + i] - prod[i] ) < TOL * n * n, XLAL_ETOL,
+                  "n=%u: product of matrix %u differs at %u: %g != %g", n, m, i, result->data[m*n*n + i], prod[i] );
+    }
+  }
+
+  /* eigenvectors satisfy M x = lambda x, and eigenvalues multiply to the determinant */
+  memcpy( work->data, orig->data, COUNT * n * n * sizeof( REAL8 ) );
+  XLAL_CHECK( XLALDSymmetricEigenVectorsBatch( values, work ) == XLAL_SUCCESS, XLAL_EFUNC );
+  for ( UINT4 m = 0; m < COUNT; ++m ) {
+    const REAL8 *x = orig->data + m*n*n, *v = work->data + m*n*n, *lambda = values->data + m*n;
+    REAL8 norm = 0;
+    for ( UINT4 j = 0; j < n; ++j ) {
+      for ( UINT4 i = 0; i < n; ++i ) {
+        REAL8 Mv = 0;
+        for ( UINT4 k = 0; k < n; ++k ) {
+          Mv += x[i*n + k] * v[k*n + j];
+        }
+        XLAL_CHECK( fabs( Mv - lambda[j] * v[i*n + j] ) < TOL * n, XLAL_ETOL,
+                    "n=%u: eigenvector %u of matrix %u is wrong", n, j, m );
+      }
+      norm += v[j*n] * v[j*n];
+    }
+    XLAL_CHECK( fabs( norm - 1 ) < TOL, XLAL_ETOL, "n=%u: eigenvectors of matrix %u are not orthonormal", n, m );
+  }
+
+  /* inverses satisfy M M^-1 = I, with determinants as computed by LALDMatrixDeterminant() */
+  memcpy( work->data, orig->data, COUNT * n * n * sizeof( REAL8 ) );
+  XLAL_CHECK( XLALDMatrixInverseBatch( det, result, work ) == XLAL_SUCCESS, XLAL_EFUNC );
+  for ( UINT4 m = 0; m < COUNT; ++m ) {
+    multiply( prod, orig->data + m*n*n, result->data + m*n*n, n );
+    for ( UINT4 i = 0; i < n; ++i ) {
+      for ( UINT4 j = 0; j < n; ++j ) {
+        XLAL_CHECK( fabs( prod[i*n + j] - ( i == j ? 1 : 0 ) ) < TOL, XLAL_ETOL,
+                    "n=%u: inverse of matrix %u is wrong", n, m );
+      }
+    }
+    REAL8 lambda = 1;
+    for ( UINT4 j = 0; j < n; ++j ) {
+      lambda *= values->data[m*n + j];
+    }
+    XLAL_CHECK( fabs( det->data[m] - lambda ) < TOL * fabs( lambda ), XLAL_ETOL,
+                "n=%u: determinant of matrix %u is %g, product of eigenvalues is %g", n, m, det->data[m], lambda );
+  }
+
+  /* a singular matrix is an error */
+  memcpy( work->data, orig->data, COUNT * n * n * sizeof( REAL8 ) );
+  for ( UINT4 i = 0; i < n; ++i ) {
+    work->data[( COUNT - 1 )*n*n + i*n] = 0;
+  }
+  int errnum = 0;
+  XLAL_TRY_SILENT( XLALDMatrixInverseBatch( NULL, result, work ), errnum );
+  XLAL_CHECK( errnum == XLAL_EDOM, XLAL_EFAILED, "n=%u: inverse of singular matrix returned errnum=%i", n, errnum );
+
+  XLALFree( prod );
+  XLALDestroyREAL8Vector( det );
+  XLALDestroyREAL8Array( values );
+  XLALDestroyREAL8Array( result );
+  XLALDestroyREAL8Array( work );
+  XLALDestroyREAL8Array( orig );
+  XLALDestroyUINT4Vector( dims );
+
+  return XLAL_SUCCESS;
+}
+
+#ifndef HAVE_LAPACK
+/* LAL{S,D}SymmetricEigenVectors() return eigenvalues in the order left by the
+ * implicit QL iteration, which callers such as the template-bank codes in
+ * LALInspiral rely on; check this order for a fixed matrix */
+static int test_eigen_order( void )
+{
+  static const REAL8 matrix[9] = { 4.0, 1.0, 0.5, 1.0, 3.0, 0.2, 0.5, 0.2, 2.0 };
+  static const REAL8 expectValues[3] = { 2.3983430193369975, 1.8800869029150531, 4.7215700777479483 };
+  static const REAL8 expectVectors[9] = {
+    0.48194966042618032, -0.25304236163525445, 0.83886476146822475,
+    -0.85879717467202898, 0.053438720828775689, 0.50952106520881402,
+    0.17375827344454681, 0.96597819143821084, 0.19155729188765641
+  };
+  static LALStatus status;
+  UINT4Vector *dims = XLALCreateUINT4Vector( 2 );
+  XLAL_CHECK( dims != NULL, XLAL_EFUNC );
+  dims->data[0] = dims->data[1] = 3;
+  REAL8Array *dMatrix = XLALCreateREAL8Array( dims );
+  REAL4Array *sMatrix = XLALCreateREAL4Array( dims );
+  REAL8Vector *dValues = XLALCreateREAL8Vector( 3 );
+  REAL4Vector *sValues = XLALCreateREAL4Vector( 3 );
+  XLAL_CHECK( dMatrix != NULL && sMatrix != NULL && dValues != NULL && sValues != NULL, XLAL_EFUNC );
+  for ( UINT4 i = 0; i < 9; ++i ) {
+    dMatrix->data[i] = matrix[i];
+    sMatrix->data[i] = matrix[i];
+  }
+
+  LALDSymmetricEigenVectors( &status, dValues, dMatrix );
+  XLAL_CHECK( status.statusCode == 0, XLAL_EFAILED, "LALDSymmetricEigenVectors() failed" );
+  LALSSymmetricEigenVectors( &status, sValues, sMatrix );
+  XLAL_CHECK( status.statusCode == 0, XLAL_EFAILED, "LALSSymmetricEigenVectors() failed" );
+
+  /* eigenvalues in the same order, with eigenvectors equal up to sign */
+  for ( UINT4 j = 0; j < 3; ++j ) {
+    XLAL_CHECK( fabs( dValues->data[j] - expectValues[j] ) < TOL, XLAL_ETOL,
+                "REAL8 eigenvalue %u is %.15g, expected %.15g", j, dValues->data[j], expectValues[j] );
+    XLAL_CHECK( fabs( sValues->data[j] - expectValues[j] ) < 1e-5, XLAL_ETOL,
+                "REAL4 eigenvalue %u is %.7g, expected %.7g", j, sValues->data[j], expectValues[j] );
+    const REAL8 dSign = ( dMatrix->data[j] * expectVectors[j] < 0 ) ? -1 : 1;
+    const REAL8 sSign = ( sMatrix->data[j] * expectVectors[j] < 0 ) ? -1 : 1;
+    for ( UINT4 i = 0; i < 3; ++i ) {
+      XLAL_CHECK( fabs( dSign * dMatrix->data[i*3 + j] - expectVectors[i*3 + j] ) < TOL, XLAL_ETOL,
+                  "REAL8 eigenvector %u differs at %u", j, i );
+      XLAL_CHECK( fabs( sSign * sMatrix->data[i*3 + j] - expectVectors[i*3 + j] ) < 1e-5, XLAL_ETOL,
+                  "REAL4 eigenvector %u differs at %u", j, i );
+    }
+  }
+
+  XLALDestroyREAL4Vector( sValues );
+  XLALDestroyREAL8Vector( dValues );
+  XLALDestroyREAL4Array( sMatrix );
+  XLALDestroyREAL8Array( dMatrix );
+  XLALDestroyUINT4Vector( dims );
+
+  return XLAL_SUCCESS;
+}
+#endif /* !HAVE_LAPACK */
+
+int main( void )
+{
+#ifndef HAVE_LAPACK
+  XLAL_CHECK_MAIN( test_eigen_order() == XLAL_SUCCESS, XLAL_EFUNC );
+#endif
+  for ( UINT4 n = 3; n <= 20; ++n ) {
+    XLAL_CHECK_MAIN( test_batch( n ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  LALCheckMemoryLeaks();
+  return EXIT_SUCCESS;
+}
@@ -18,6 +18,7 @@
 */
 #include <config.h>
 
+#include <math.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -173,6 +174,127 @@ main (int argc, char *argv[])
   }
 
 
+  /*
+   *
+   * Check the Philox generator against the Random123 known-answer tests,
+   * and that its normal deviates have unit variance.
+   *
+   */
+
+
+  {
+    UINT4 ctr0[4] = { 0, 0, 0, 0 };
+    const UINT4 key0[2] = { 0, 0 };
+    const UINT4 res0[4] = { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 };
+    UINT4 ctr1[4] = { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 };
+    const UINT4 key1[2] = { 0xa4093822, 0x299f31d0 };
+    const UINT4 res1[4] = { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 };
+    REAL8Vector *deviates;
+    REAL8 var = 0;
+
+    XLALPhilox4x32 (ctr0, key0);
+    XLALPhilox4x32 (ctr1, key1);
+    for (i = 0; i < 4; ++i)
+      if (ctr0[i] != res0[i] || ctr1[i] != res1[i])
+        exit (1);
+
+    deviates = XLALCreateREAL8Vector (100000);
+    if (!deviates || XLALPhiloxNormalDeviates (deviates, 12345, 1))
+      exit (1);
+    for (i = 0; i < deviates->length; ++i)
+      var += deviates->data[i] * deviates->data[i];
+    var /= deviates->length;
+    if (fabs (var - 1.0) > 0.02)
+      exit (1);
+    XLALDestroyREAL8Vector (deviates);
+  }
+
+
+  /*
+   *
+   * Check that Philox streams give the same deviates however a fill is
+   * divided up, that skipping ahead is consistent with filling, and that
+   * split streams differ from their parent.
+   *
+   */
+
+
+  {
+    const UINT4 n = 1001;
+    const UINT4 pieces[] = { 1, 2, 7, 16, 33, 1, 941 };
+    REAL8Vector *whole = XLALCreateREAL8Vector (n);
+    REAL8Vector *part = XLALCreateREAL8Vector (n);
+    LALPhiloxStream rng, child;
+    REAL8 mean = 0;
+    UINT4 kind, k;
+
+    if (!whole || !part)
+      exit (1);
+    for (kind = 0; kind < 2; ++kind)
+    {
+      int (*fill)(REAL8Vector *, LALPhiloxStream *) = kind ? XLALPhiloxStreamNormalDeviates : XLALPhiloxStreamUniformDeviates;
+      XLALPhiloxStreamInit (&rng, 12345, 1);
+      if (fill (whole, &rng) || rng.position != n)
+        exit (1);
+      XLALPhiloxStreamInit (&rng, 12345, 1);
+      for (i = 0, k = 0; k < sizeof(pieces) / sizeof(pieces[0]); i += pieces[k++])
+      {
+        REAL8Vector view = { pieces[k], part->data + i };
+        if (fill (&view, &rng))
+          exit (1);
+      }
+      for (i = 0; i < n; ++i)
+        if (part->data[i] != whole->data[i])
+          exit (1);
+      /* skip to the last third of the stream */
+      XLALPhiloxStreamInit (&rng, 12345, 1);
+      XLALPhiloxStreamSkip (&rng, 2 * n / 3);
+      {
+        REAL8Vector view = { n - 2 * n / 3, part->data };
+        if (fill (&view, &rng))
+          exit (1);
+        for (i = 0; i < view.length; ++i)
+          if (part->data[i] != whole->data[2 * n / 3 + i])
+            exit (1);
+      }
+    }
+
+    /* normal streams from the start reproduce XLALPhiloxNormalDeviates() */
+    if (XLALPhiloxNormalDeviates (part, 12345, 1))
+      exit (1);
+    for (i = 0; i < n; ++i)
+      if (part->data[i] != whole->data[i])
+        exit (1);
+
+    /* uniform deviates lie in [0, 1) with mean one half */
+    XLALPhiloxStreamInit (&rng, 12345, 1);
+    if (XLALPhiloxStreamUniformDeviates (whole, &rng))
+      exit (1);
+    for (i = 0; i < n; ++i)
+    {
+      if (whole->data[i] < 0 || whole->data[i] >= 1)
+        exit (1);
+      mean += whole->data[i] / n;
+    }
+    if (fabs (mean - 0.5) > 0.05)
+      exit (1);
+
+    /* a split stream is independent of its parent */
+    XLALPhiloxStreamInit (&rng, 12345, 1);
+    if (XLALPhiloxStreamSplit (&child, &rng) || child.stream == rng.stream)
+      exit (1);
+    if (XLALPhiloxStreamUniformDeviates (part, &child))
+      exit (1);
+    for (i = 0, k = 0; i < n; ++i)
+      k += part->data[i] == whole->data[i];
+    if (k > 1)
+      exit (1);
+
+    XLALDestroyREAL8Vector (whole);
+    XLALDestroyREAL8Vector (part);
+  }
+
+
   /*
    *
    * Check to make sure that correct error codes are generated.
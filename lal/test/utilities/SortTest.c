@@ -109,6 +109,15 @@ static int compar( void *p, const void *a, const void *b )
 }
 
 
+/* compares only the tens digit, so that there are many ties */
+static int compar_coarse( void *p, const void *a, const void *b )
+{
+  int x = *((const int *)a) / 10;
+  int y = *((const int *)b) / 10;
+  return compar( p, &x, &y );
+}
+
+
 static int check( int *data, int *sort, int nobj, int ascend )
 {
   int i, j;
@@ -199,6 +208,37 @@ int main(int argc, char **argv)
     freedata( data, sort, indx, rank );
   }
 
+  for ( testnum = 0; testnum < 200; testnum++ )
+  {
+    int nobj = rand() % 300;
+    int ascend = rand() & 1;
+    int *data;
+    int *sort;
+    int *indx;	/* unused for these tests */
+    int *rank;	/* used for the insertion sort result */
+    int i;
+
+    makedata( nobj, &data, &sort, &indx, &rank );
+
+    if ( XLALMergeSort( sort, nobj, sizeof(*data), &ascend, compar ) < 0 )
+      abort();
+
+    check( data, sort, nobj, ascend );
+
+    /* ties must be left in their original order, as by insertion sort */
+    memcpy( sort, data, nobj * sizeof(*data) );
+    memcpy( rank, data, nobj * sizeof(*data) );
+    if ( XLALMergeSort( sort, nobj, sizeof(*data), &ascend, compar_coarse ) < 0 )
+      abort();
+    if ( XLALInsertionSort( rank, nobj, sizeof(*data), &ascend, compar_coarse ) < 0 )
+      abort();
+    for ( i = 0; i < nobj; ++i )
+      if ( sort[i] != rank[i] )
+        abort();
+
+    freedata( data, sort, indx, rank );
+  }
+
 
   return 0;
 }
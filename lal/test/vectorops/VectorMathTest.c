@@ -38,6 +38,7 @@
 #define Relerr(dx,x) (fabsf(x)>0 ? fabsf((dx)/(x)) : fabsf(dx) )
 #define Relerrd(dx,x) (fabs(x)>0 ? fabs((dx)/(x)) : fabs(dx) )
 #define cRelerr(dx,x) (cabsf(x)>0 ? cabsf((dx)/(x)) : fabsf(dx) )
+#define zRelerr(dx,x) (cabs(x)>0 ? fabs((dx)/cabs(x)) : fabs(dx) )
 
 // ----- test and benchmark operators with 1 REAL4 vector input and 1 INT4 vector output (S2I) ----------
 #define TESTBENCH_VECTORMATH_S2I(name,in)                               \
@@ -127,6 +128,31 @@
   }
 
 
+#define TESTBENCH_VECTORMATH_SSS2SS(name,in1,in2,in3)                   \
+  {                                                                     \
+    XLAL_CHECK ( XLALVector##name##REAL4_GEN( xOutRef, xOutRef2, in1, in2, in3, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    tic = XLALGetCPUTime();                                             \
+    for (UINT4 l=0; l < Nruns; l ++ ) {                                 \
+      XLAL_CHECK ( XLALVector##name##REAL4( xOut, xOut2, in1, in2, in3, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    }                                                                   \
+    toc = XLALGetCPUTime();                                             \
+    maxErr = maxRelerr = 0;                                             \
+    for ( UINT4 i = 0; i < Ntrials; i ++ ) {                            \
+      REAL4 err1 = fabsf ( xOut[i] - xOutRef[i] );                      \
+      REAL4 err2 = fabsf ( xOut2[i] - xOutRef2[i] );                    \
+      REAL4 relerr1 = Relerr ( err1, xOutRef[i] );                      \
+      REAL4 relerr2 = Relerr ( err2, xOutRef2[i] );                     \
+      maxErr    = fmaxf ( err1, maxErr );                               \
+      maxErr    = fmaxf ( err2, maxErr );                               \
+      maxRelerr = fmaxf ( relerr1, maxRelerr );                         \
+      maxRelerr = fmaxf ( relerr2, maxRelerr );                         \
+    }                                                                   \
+    XLALPrintInfo ( "%-32s: %4.0f Mops/sec [maxErr = %7.2g (tol=%7.2g), maxRelerr = %7.2g (tol=%7.2g)]\n", \
+                    XLALVector##name##REAL4_name, (REAL8)Ntrials * Nruns / (toc - tic)/1e6, maxErr, (abstol), maxRelerr, (reltol) ); \
+    XLAL_CHECK ( (maxErr <= (abstol)), XLAL_ETOL, "%s: absolute error (%g) exceeds tolerance (%g)\n", #name "REAL4", maxErr, abstol ); \
+    XLAL_CHECK ( (maxRelerr <= (reltol)), XLAL_ETOL, "%s: relative error (%g) exceeds tolerance (%g)\n", #name "REAL4", maxRelerr, reltol ); \
+  }
+
 #define TESTBENCH_VECTORMATH_SS2uU(name,in1,in2)                        \
   {                                                                     \
     UINT4 xCount = 0, xCountRef = 0;                                    \
@@ -188,6 +214,29 @@
     XLAL_CHECK ( (maxRelerr <= (reltol)), XLAL_ETOL, "%s: relative error (%g) exceeds tolerance (%g)\n", #name "COMPLEX8", maxRelerr, reltol ); \
   }
 
+// ----- test and benchmark operators with 1 COMPLEX8 vector input and 1 REAL4 vector output (C2S) ----------
+#define TESTBENCH_VECTORMATH_C2S(name,in)                               \
+  {                                                                     \
+    XLAL_CHECK ( XLALVector##name##COMPLEX8_GEN( xOutRef, in, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    tic = XLALGetCPUTime();                                             \
+    for (UINT4 l=0; l < Nruns; l ++ ) {                                 \
+      XLAL_CHECK ( XLALVector##name##COMPLEX8( xOut, in, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    }                                                                   \
+    toc = XLALGetCPUTime();                                             \
+    maxErr = maxRelerr = 0;                                             \
+    for ( UINT4 i = 0; i < Ntrials; i ++ )                              \
+    {                                                                   \
+      REAL4 err = fabsf ( xOut[i] - xOutRef[i] );                       \
+      REAL4 relerr = Relerr ( err, xOutRef[i] );                        \
+      maxErr    = fmaxf ( err, maxErr );                                \
+      maxRelerr = fmaxf ( relerr, maxRelerr );                          \
+    }                                                                   \
+    XLALPrintInfo ( "%-32s: %4.0f Mops/sec [maxErr = %7.2g (tol=%7.2g), maxRelerr = %7.2g (tol=%7.2g)]\n", \
+                    XLALVector##name##COMPLEX8_name, (REAL8)Ntrials * Nruns / (toc - tic)/1e6, maxErr, (abstol), maxRelerr, (reltol) ); \
+    XLAL_CHECK ( (maxErr <= (abstol)), XLAL_ETOL, "%s: absolute error (%g) exceeds tolerance (%g)\n", #name "COMPLEX8", maxErr, abstol ); \
+    XLAL_CHECK ( (maxRelerr <= (reltol)), XLAL_ETOL, "%s: relative error (%g) exceeds tolerance (%g)\n", #name "COMPLEX8", maxRelerr, reltol ); \
+  }
+
 // ----- test and benchmark operators with 1 REAL8 vector input and 1 REAL8 vector output (D2D) ----------
 #define TESTBENCH_VECTORMATH_D2D(name,in)                               \
   {                                                                     \
@@ -200,8 +249,8 @@
     maxErr = maxRelerr = 0;                                             \
     for ( UINT4 i = 0; i < Ntrials; i ++ )                              \
     {                                                                   \
-      REAL8 err = fabs ( xOut[i] - xOutRef[i] );                      \
-      REAL8 relerr = Relerrd ( err, xOutRef[i] );                       \
+      REAL8 err = fabs ( xOutD[i] - xOutRefD[i] );                    \
+      REAL8 relerr = Relerrd ( err, xOutRefD[i] );                     \
       maxErr    = fmax ( err, maxErr );                                \
       maxRelerr = fmax ( relerr, maxRelerr );                          \
     }                                                                   \
@@ -211,6 +260,113 @@
     XLAL_CHECK ( (maxRelerr <= (reltol)), XLAL_ETOL, "%s: relative error (%g) exceeds tolerance (%g)\n", #name "REAL8", maxRelerr, reltol ); \
   }
 
+// ----- test and benchmark operators with 1 REAL8 vector input and 2 REAL8 vector outputs (D2DD) ----------
+#define TESTBENCH_VECTORMATH_D2DD(name,in)                              \
+  {                                                                     \
+    XLAL_CHECK ( XLALVector##name##REAL8_GEN( xOutRefD, xOutRef2D, in, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    tic = XLALGetCPUTime();                                             \
+    for (UINT4 l=0; l < Nruns; l ++ ) {                                 \
+      XLAL_CHECK ( XLALVector##name##REAL8( xOutD, xOut2D, in, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    }                                                                   \
+    toc = XLALGetCPUTime();                                             \
+    maxErr = maxRelerr = 0;                                             \
+    for ( UINT4 i = 0; i < Ntrials; i ++ ) {                            \
+      REAL8 err1 = fabs ( xOutD[i] - xOutRefD[i] );                     \
+      REAL8 err2 = fabs ( xOut2D[i] - xOutRef2D[i] );                   \
+      REAL8 relerr1 = Relerrd ( err1, xOutRefD[i] );                    \
+      REAL8 relerr2 = Relerrd ( err2, xOutRef2D[i] );                   \
+      maxErr    = fmax ( err1, maxErr );                                \
+      maxErr    = fmax ( err2, maxErr );                                \
+      maxRelerr = fmax ( relerr1, maxRelerr );                          \
+      maxRelerr = fmax ( relerr2, maxRelerr );                          \
+    }                                                                   \
+    XLALPrintInfo ( "%-32s: %4.0f Mops/sec [maxErr = %7.2g (tol=%7.2g), maxRelerr = %7.2g (tol=%7.2g)]\n", \
+                    XLALVector##name##REAL8_name, (REAL8)Ntrials * Nruns / (toc - tic)/1e6, maxErr, (abstol), maxRelerr, (reltol) ); \
+    XLAL_CHECK ( (maxErr <= (abstol)), XLAL_ETOL, "%s: absolute error (%g) exceeds tolerance (%g)\n", #name "REAL8", maxErr, abstol ); \
+    XLAL_CHECK ( (maxRelerr <= (reltol)), XLAL_ETOL, "%s: relative error (%g) exceeds tolerance (%g)\n", #name "REAL8", maxRelerr, reltol ); \
+  }
+
+// ----- test and benchmark operators with 2 COMPLEX16 vector inputs and 1 COMPLEX16 vector output (ZZ2Z) ----------
+#define TESTBENCH_VECTORMATH_ZZ2Z(name,in1,in2)                         \
+  {                                                                     \
+    XLAL_CHECK ( XLALVector##name##COMPLEX16_GEN( xOutRefZ, in1, in2, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    tic = XLALGetCPUTime();                                             \
+    for (UINT4 l=0; l < Nruns; l ++ ) {                                 \
+      XLAL_CHECK ( XLALVector##name##COMPLEX16( xOutZ, in1, in2, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    }                                                                   \
+    toc = XLALGetCPUTime();                                             \
+    maxErr = maxRelerr = 0;                                             \
+    for ( UINT4 i = 0; i < Ntrials; i ++ )                              \
+    {                                                                   \
+      REAL8 err = cabs ( xOutZ[i] - xOutRefZ[i] );                      \
+      REAL8 relerr = zRelerr ( err, xOutRefZ[i] );                      \
+      maxErr    = fmax ( err, maxErr );                                 \
+      maxRelerr = fmax ( relerr, maxRelerr );                           \
+    }                                                                   \
+    XLALPrintInfo ( "%-32s: %4.0f Mops/sec [maxErr = %7.2g (tol=%7.2g), maxRelerr = %7.2g (tol=%7.2g)]\n", \
+                    XLALVector##name##COMPLEX16_name, (REAL8)Ntrials * Nruns / (toc - tic)/1e6, maxErr, (abstol), maxRelerr, (reltol) ); \
+    XLAL_CHECK ( (maxErr <= (abstol)), XLAL_ETOL, "%s: absolute error (%g) exceeds tolerance (%g)\n", #name "COMPLEX16", maxErr, abstol ); \
+    XLAL_CHECK ( (maxRelerr <= (reltol)), XLAL_ETOL, "%s: relative error (%g) exceeds tolerance (%g)\n", #name "COMPLEX16", maxRelerr, reltol ); \
+  }
+
+// ----- test and benchmark operators with 1 COMPLEX16 vector input and 1 REAL8 vector output (Z2D) ----------
+#define TESTBENCH_VECTORMATH_Z2D(name,in)                               \
+  {                                                                     \
+    XLAL_CHECK ( XLALVector##name##COMPLEX16_GEN( xOutRefD, in, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    tic = XLALGetCPUTime();                                             \
+    for (UINT4 l=0; l < Nruns; l ++ ) {                                 \
+      XLAL_CHECK ( XLALVector##name##COMPLEX16( xOutD, in, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    }                                                                   \
+    toc = XLALGetCPUTime();                                             \
+    maxErr = maxRelerr = 0;                                             \
+    for ( UINT4 i = 0; i < Ntrials; i ++ )                              \
+    {                                                                   \
+      REAL8 err = fabs ( xOutD[i] - xOutRefD[i] );                      \
+      REAL8 relerr = Relerrd ( err, xOutRefD[i] );                      \
+      maxErr    = fmax ( err, maxErr );                                 \
+      maxRelerr = fmax ( relerr, maxRelerr );                           \
+    }                                                                   \
+    XLALPrintInfo ( "%-32s: %4.0f Mops/sec [maxErr = %7.2g (tol=%7.2g), maxRelerr = %7.2g (tol=%7.2g)]\n", \
+                    XLALVector##name##COMPLEX16_name, (REAL8)Ntrials * Nruns / (toc - tic)/1e6, maxErr, (abstol), maxRelerr, (reltol) ); \
+    XLAL_CHECK ( (maxErr <= (abstol)), XLAL_ETOL, "%s: absolute error (%g) exceeds tolerance (%g)\n", #name "COMPLEX16", maxErr, abstol ); \
+    XLAL_CHECK ( (maxRelerr <= (reltol)), XLAL_ETOL, "%s: relative error (%g) exceeds tolerance (%g)\n", #name "COMPLEX16", maxRelerr, reltol ); \
+  }
+
+// ----- test and benchmark operators with 2 COMPLEX16 vector inputs and 1 COMPLEX16 scalar output (ZZ2z) ----------
+#define TESTBENCH_VECTORMATH_ZZ2z(name,in1,in2)                         \
+  {                                                                     \
+    COMPLEX16 zOut = 0, zOutRef = 0;                                    \
+    XLAL_CHECK ( XLALVector##name##COMPLEX16_GEN( &zOutRef, in1, in2, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    tic = XLALGetCPUTime();                                             \
+    for (UINT4 l=0; l < Nruns; l ++ ) {                                 \
+      XLAL_CHECK ( XLALVector##name##COMPLEX16( &zOut, in1, in2, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    }                                                                   \
+    toc = XLALGetCPUTime();                                             \
+    maxErr = cabs ( zOut - zOutRef );                                   \
+    maxRelerr = zRelerr ( maxErr, zOutRef );                            \
+    XLALPrintInfo ( "%-32s: %4.0f Mops/sec [maxErr = %7.2g (tol=%7.2g), maxRelerr = %7.2g (tol=%7.2g)]\n", \
+                    XLALVector##name##COMPLEX16_name, (REAL8)Ntrials * Nruns / (toc - tic)/1e6, maxErr, (abstol), maxRelerr, (reltol) ); \
+    XLAL_CHECK ( (maxRelerr <= (reltol)), XLAL_ETOL, "%s: relative error (%g) exceeds tolerance (%g)\n", #name "COMPLEX16", maxRelerr, reltol ); \
+  }
+
+// ----- test and benchmark weighted inner products of 2 complex vector inputs and 1 real vector input to 1 COMPLEX16 and 1 REAL8 scalar output (ZZD2zd, CCS2zd) ----------
+#define TESTBENCH_VECTORMATH_ZZD2zd(name,type,h,d,w)                    \
+  for ( VectorMathSumMethod method = VECTORMATH_SUM_DIRECT; method <= VECTORMATH_SUM_PAIRWISE; method ++ ) \
+  {                                                                     \
+    COMPLEX16 zOut = 0, zOutRef = 0;                                    \
+    REAL8 dOut = 0, dOutRef = 0;                                        \
+    XLAL_CHECK ( XLALVector##name##type##_GEN( &zOutRef, &dOutRef, h, d, w, Ntrials, method ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    tic = XLALGetCPUTime();                                             \
+    for (UINT4 l=0; l < Nruns; l ++ ) {                                 \
+      XLAL_CHECK ( XLALVector##name##type( &zOut, &dOut, h, d, w, Ntrials, method ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    }                                                                   \
+    toc = XLALGetCPUTime();                                             \
+    maxRelerr = fmax ( zRelerr ( cabs ( zOut - zOutRef ), zOutRef ), Relerrd ( fabs ( dOut - dOutRef ), dOutRef ) ); \
+    XLALPrintInfo ( "%-32s: %4.0f Mops/sec [method = %d, maxRelerr = %7.2g (tol=%7.2g)]\n", \
+                    XLALVector##name##type##_name, (REAL8)Ntrials * Nruns / (toc - tic)/1e6, method, maxRelerr, (reltol) ); \
+    XLAL_CHECK ( (maxRelerr <= (reltol)), XLAL_ETOL, "%s: relative error (%g) exceeds tolerance (%g)\n", #name #type, maxRelerr, reltol ); \
+  }
+
 // local types
 typedef struct
 {
@@ -259,9 +415,10 @@ main ( int argc, char *argv[] )
   XLAL_CHECK ( ( xOutU4 = XLALCreateUINT4Vector ( Ntrials )) != NULL, XLAL_EFUNC );
   XLAL_CHECK ( ( xOutRefU4 = XLALCreateUINT4Vector ( Ntrials )) != NULL, XLAL_EFUNC );
 
-  REAL4VectorAligned *xIn_a, *xIn2_a, *xOut_a, *xOut2_a;
+  REAL4VectorAligned *xIn_a, *xIn2_a, *xIn3_a, *xOut_a, *xOut2_a;
   XLAL_CHECK ( ( xIn_a   = XLALCreateREAL4VectorAligned ( Ntrials, uvar->inAlign )) != NULL, XLAL_EFUNC );
   XLAL_CHECK ( ( xIn2_a  = XLALCreateREAL4VectorAligned ( Ntrials, uvar->inAlign )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( ( xIn3_a  = XLALCreateREAL4VectorAligned ( Ntrials, uvar->inAlign )) != NULL, XLAL_EFUNC );
   XLAL_CHECK ( ( xOut_a  = XLALCreateREAL4VectorAligned ( Ntrials, uvar->outAlign )) != NULL, XLAL_EFUNC );
   XLAL_CHECK ( ( xOut2_a = XLALCreateREAL4VectorAligned ( Ntrials, uvar->outAlign )) != NULL, XLAL_EFUNC );
   REAL4VectorAligned *xOutRef_a, *xOutRef2_a;
@@ -271,6 +428,7 @@ main ( int argc, char *argv[] )
   // extract aligned REAL4 vectors from these
   REAL4 *xIn      = xIn_a->data;
   REAL4 *xIn2     = xIn2_a->data;
+  REAL4 *xIn3     = xIn3_a->data;
   REAL4 *xOut     = xOut_a->data;
   REAL4 *xOut2    = xOut2_a->data;
   REAL4 *xOutRef  = xOutRef_a->data;
@@ -288,6 +446,12 @@ main ( int argc, char *argv[] )
   REAL8 *xOutD     = xOutD_a->data;
   REAL8 *xOutRefD  = xOutRefD_a->data;
 
+  REAL8VectorAligned *xOut2D_a, *xOutRef2D_a;
+  XLAL_CHECK ( ( xOut2D_a = XLALCreateREAL8VectorAligned ( Ntrials, uvar->outAlign )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( (xOutRef2D_a= XLALCreateREAL8VectorAligned ( Ntrials, uvar->outAlign )) != NULL, XLAL_EFUNC );
+  REAL8 *xOut2D    = xOut2D_a->data;
+  REAL8 *xOutRef2D = xOutRef2D_a->data;
+
   COMPLEX8VectorAligned *xInC_a, *xIn2C_a, *xOutC_a, *xOutRefC_a;
   XLAL_CHECK ( ( xInC_a   = XLALCreateCOMPLEX8VectorAligned ( Ntrials, uvar->inAlign )) != NULL, XLAL_EFUNC );
   XLAL_CHECK ( ( xIn2C_a  = XLALCreateCOMPLEX8VectorAligned ( Ntrials, uvar->inAlign )) != NULL, XLAL_EFUNC );
@@ -300,6 +464,18 @@ main ( int argc, char *argv[] )
   COMPLEX8 *xOutC     = xOutC_a->data;
   COMPLEX8 *xOutRefC  = xOutRefC_a->data;
 
+  COMPLEX16VectorAligned *xInZ_a, *xIn2Z_a, *xOutZ_a, *xOutRefZ_a;
+  XLAL_CHECK ( ( xInZ_a   = XLALCreateCOMPLEX16VectorAligned ( Ntrials, uvar->inAlign )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( ( xIn2Z_a  = XLALCreateCOMPLEX16VectorAligned ( Ntrials, uvar->inAlign )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( ( xOutZ_a  = XLALCreateCOMPLEX16VectorAligned ( Ntrials, uvar->outAlign )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( (xOutRefZ_a  = XLALCreateCOMPLEX16VectorAligned ( Ntrials, uvar->outAlign )) != NULL, XLAL_EFUNC );
+
+  // extract aligned COMPLEX16 vectors from these
+  COMPLEX16 *xInZ      = xInZ_a->data;
+  COMPLEX16 *xIn2Z     = xIn2Z_a->data;
+  COMPLEX16 *xOutZ     = xOutZ_a->data;
+  COMPLEX16 *xOutRefZ  = xOutRefZ_a->data;
+
   REAL8 tic, toc;
   REAL4 maxErr = 0, maxRelerr = 0;
   REAL4 abstol, reltol;
@@ -345,6 +521,31 @@ main ( int argc, char *argv[] )
 
   TESTBENCH_VECTORMATH_S2S(Log,xIn);
 
+  // ==================== REAL8 SIN(),COS(),EXP(),LOG() ====================
+  XLALPrintInfo ("\nTesting REAL8 sin(x), cos(x) for x in [-1000, 1000]\n");
+  for ( UINT4 i = 0; i < Ntrials; i ++ ) {
+    xInD[i] = 2000 * ( frand() - 0.5 );
+  }
+  abstol = 1e-15, reltol = 1e-14;
+  TESTBENCH_VECTORMATH_D2D(Sin,xInD);
+  TESTBENCH_VECTORMATH_D2D(Cos,xInD);
+  TESTBENCH_VECTORMATH_D2DD(SinCos,xInD);
+  TESTBENCH_VECTORMATH_D2DD(SinCos2Pi,xInD);
+
+  XLALPrintInfo ("\nTesting REAL8 exp(x) for x in [-10, 10]\n");
+  for ( UINT4 i = 0; i < Ntrials; i ++ ) {
+    xInD[i] = 20 * ( frand() - 0.5 );
+  }
+  abstol = 1e-11, reltol = 1e-15;
+  TESTBENCH_VECTORMATH_D2D(Exp,xInD);
+
+  XLALPrintInfo ("\nTesting REAL8 log(x) for x in (0, 10000]\n");
+  for ( UINT4 i = 0; i < Ntrials; i ++ ) {
+    xInD[i] = 10000.0 * frand() + 1e-6;
+  }
+  abstol = 1e-14, reltol = 1e-15;
+  TESTBENCH_VECTORMATH_D2D(Log,xInD);
+
   // ==================== ADD,MUL,ROUND ====================
   for ( UINT4 i = 0; i < Ntrials; i ++ ) {
     xIn[i]  = -10000.0f + 20000.0f * frand() + 1e-6;
@@ -353,6 +554,8 @@ main ( int argc, char *argv[] )
     xIn2D[i]= -100000.0 + 200000.0 * frand() + 1e-6;
     xInC[i] = -10000.0f + 20000.0f * frand() + 1e-6 + ( -10000.0f + 20000.0f * frand() + 1e-6 ) * _Complex_I;
     xIn2C[i]= -10000.0f + 20000.0f * frand() + 1e-6 + ( -10000.0f + 20000.0f * frand() + 1e-6 ) * _Complex_I;
+    xInZ[i] = -10000.0 + 20000.0 * frand() + 1e-6 + ( -10000.0 + 20000.0 * frand() + 1e-6 ) * _Complex_I;
+    xIn2Z[i]= -10000.0 + 20000.0 * frand() + 1e-6 + ( -10000.0 + 20000.0 * frand() + 1e-6 ) * _Complex_I;
   } // for i < Ntrials
   abstol = 2e-7, reltol = 2e-7;
 
@@ -365,6 +568,10 @@ main ( int argc, char *argv[] )
   TESTBENCH_VECTORMATH_SS2S(Sub,xIn,xIn2);
   TESTBENCH_VECTORMATH_SS2S(Multiply,xIn,xIn2);
   TESTBENCH_VECTORMATH_SS2S(Max,xIn,xIn2);
+  for ( UINT4 i = 0; i < Ntrials; i ++ ) {
+    xIn3[i] = -10000.0f + 20000.0f * frand() + 1e-6;
+  }
+  TESTBENCH_VECTORMATH_SSS2SS(AddMax,xIn,xIn2,xIn3);
 
   TESTBENCH_VECTORMATH_SS2S(Shift,xIn[0],xIn2);
   TESTBENCH_VECTORMATH_SS2S(Scale,xIn[0],xIn2);
@@ -383,6 +590,25 @@ main ( int argc, char *argv[] )
   TESTBENCH_VECTORMATH_CC2C(Scale,xInC[0],xIn2C);
   TESTBENCH_VECTORMATH_CC2C(Shift,xInC[0],xIn2C);
 
+  TESTBENCH_VECTORMATH_C2S(Abs2,xInC);
+
+  abstol = 1e-7, reltol = 1e-15;
+  TESTBENCH_VECTORMATH_ZZ2Z(Multiply,xInZ,xIn2Z);
+  TESTBENCH_VECTORMATH_ZZ2Z(MultiplyConj,xInZ,xIn2Z);
+  TESTBENCH_VECTORMATH_Z2D(Abs2,xInZ);
+
+  // summation order differs between implementations, so only test relative error of the sum
+  reltol = 1e-12;
+  TESTBENCH_VECTORMATH_ZZ2z(DotConj,xInZ,xIn2Z);
+
+  XLALPrintInfo ("\nTesting weighted inner products <x|y>, <x|x> for x,y in (-10000, 10000], weights in (0, 10000]\n");
+  for ( UINT4 i = 0; i < Ntrials; i ++ ) {
+    xIn2[i]  = 10000.0f * frand() + 1e-6;
+    xIn2D[i] = 10000.0 * frand() + 1e-6;
+  } // for i < Ntrials
+  TESTBENCH_VECTORMATH_ZZD2zd(WeightedInnerProduct,COMPLEX16,xInZ,xIn2Z,xIn2D);
+  TESTBENCH_VECTORMATH_ZZD2zd(WeightedInnerProduct,COMPLEX8,xInC,xIn2C,xIn2);
+
   // ==================== FIND ====================
   for ( UINT4 i = 0; i < Ntrials; i ++ ) {
     xIn[i]  = -10000.0f + 20000.0f * frand() + 1e-6;
@@ -405,6 +631,7 @@ main ( int argc, char *argv[] )
 
   XLALDestroyREAL4VectorAligned ( xIn_a );
   XLALDestroyREAL4VectorAligned ( xIn2_a );
+  XLALDestroyREAL4VectorAligned ( xIn3_a );
   XLALDestroyREAL4VectorAligned ( xOut_a );
   XLALDestroyREAL4VectorAligned ( xOut2_a );
 
@@ -415,12 +642,19 @@ main ( int argc, char *argv[] )
   XLALDestroyREAL8VectorAligned ( xIn2D_a );
   XLALDestroyREAL8VectorAligned ( xOutD_a );
   XLALDestroyREAL8VectorAligned ( xOutRefD_a );
+  XLALDestroyREAL8VectorAligned ( xOut2D_a );
+  XLALDestroyREAL8VectorAligned ( xOutRef2D_a );
 
   XLALDestroyCOMPLEX8VectorAligned ( xInC_a );
   XLALDestroyCOMPLEX8VectorAligned ( xIn2C_a );
   XLALDestroyCOMPLEX8VectorAligned ( xOutC_a );
   XLALDestroyCOMPLEX8VectorAligned ( xOutRefC_a );
 
+  XLALDestroyCOMPLEX16VectorAligned ( xInZ_a );
+  XLALDestroyCOMPLEX16VectorAligned ( xIn2Z_a );
+  XLALDestroyCOMPLEX16VectorAligned ( xOutZ_a );
+  XLALDestroyCOMPLEX16VectorAligned ( xOutRefZ_a );
+
   XLALDestroyUserVars();
 
   LALCheckMemoryLeaks();
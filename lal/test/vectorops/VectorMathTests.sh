@@ -22,14 +22,14 @@ echo "$0: compiler supports ${simd_compiler}"
 simd_machine=`${lal_simd_detect} | sed -n 4p`
 echo "$0: machine supports ${simd_machine}"
 
-# try to test these instruction sets
-simd_test="SSE AVX"
+# try to test every instruction set with a vector math implementation
+simd_test="GEN SSE2 SSSE3 AVX AVX2 AVX512F"
 
 for simd in ${simd_test}; do
 
     # test for compiler support
     case " ${simd_compiler} " in
-        *"${simd}"*)
+        *" ${simd} "*)
             ;;
         *)
             echo "$0: compiler does not support ${simd}"
@@ -38,7 +38,7 @@ for simd in ${simd_test}; do
 
     # test for machine support
     case " ${simd_machine} " in
-        *"${simd}"*)
+        *" ${simd} "*)
             ;;
         *)
             echo "$0: this machine does not support ${simd}"
@@ -387,6 +387,12 @@
 #include <lal/FrequencySeries.h>
 #include "inspiral.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp ignore
+#endif
+
 #define CVS_REVISION "$Revision$"
 #define CVS_ID_STRING "$Id$"
 #define CVS_SOURCE "$Source$"
@@ -453,10 +459,11 @@ REAL8 luminosity_distance(REAL8 rshift);
 REAL8 mean_time_step_sfr(REAL8 zmax, REAL8 rate_local);
 REAL8 drawRedshift(REAL8 zmin, REAL8 zmax, REAL8 pzmax);
 REAL8 redshift_mass(REAL8 mass, REAL8 z);
-static void scale_lalsim_distance(SimInspiralTable *inj,char ** IFOnames, REAL8FrequencySeries **psds,REAL8 *start_freqs,LoudnessDistribution dDistr);
-static REAL8 draw_uniform_snr(REAL8 snrmin,REAL8 snrmax);
-static REAL8 draw_log10_snr(REAL8 snrmin,REAL8 snrmax);
-static REAL8 draw_volume_snr(REAL8 snrmin,REAL8 snrmax);
+static void scale_lalsim_distance(SimInspiralTable *inj,char ** IFOnames, REAL8FrequencySeries **psds,REAL8 *start_freqs,LoudnessDistribution dDistr,UINT8 seed,UINT8 stream);
+static REAL8 philox_uniform_deviate(UINT8 seed,UINT8 stream,UINT8 draw);
+static REAL8 draw_uniform_snr(REAL8 snrmin,REAL8 snrmax,REAL8 u);
+static REAL8 draw_log10_snr(REAL8 snrmin,REAL8 snrmax,REAL8 u);
+static REAL8 draw_volume_snr(REAL8 snrmin,REAL8 snrmax,REAL8 u);
 /*
  *  *************************************
  *  Defining of the used global variables
@@ -1016,6 +1023,9 @@ static void print_usage(char *program)
       "                           uniform: uniform in SNR, log10: uniform in log10(SNR)\n"\
       "                           volume: uniform in 1/SNR^3\n"\
       "                           ( Setting max-snr == min-snr will allow you to choose a fixed SNR )\n"\
+      "                           With the LALSimulation SNR calculation the SNRs are drawn from a\n"\
+      "                           separate counter-based stream for each injection, and the\n"\
+      "                           injections are rescaled in parallel when built with OpenMP\n"\
       " [--ninja-snr]             use a NINJA waveform SNR calculation (if not set, use LALSimulation)\n"\
       " [--min-snr] SMIN          set the minimum network snr\n"\
       " [--max-snr] SMAX          set the maximum network snr\n"\
@@ -1889,6 +1899,10 @@ int main( int argc, char *argv[] )
   REAL8 pzmax=0; /* maximal value of the probability distribution of the redshift */
   INT4 ncount;
   size_t ninj;
+  SimInspiralTable **scaled = NULL; /* injections whose distance is to be rescaled to a proposed SNR */
+  size_t nscaled = 0, maxscaled = 0;
+  REAL8 *start_freqs = NULL;
+  REAL8FrequencySeries **psds = NULL;
   int rand_seed = 1;
 
   /* waveform */
@@ -4251,13 +4265,13 @@ int main( int argc, char *argv[] )
     if ( ifos != NULL && ninjaSNR )
     {
       if (dDistr==uniformSnr){
-        targetSNR=draw_uniform_snr(minSNR,maxSNR);
+        targetSNR=draw_uniform_snr(minSNR,maxSNR,XLALUniformDeviate(randParams));
       }
       else if(dDistr==uniformLogSnr){
-        targetSNR=draw_log10_snr(minSNR,maxSNR);
+        targetSNR=draw_log10_snr(minSNR,maxSNR,XLALUniformDeviate(randParams));
       }
       else if (dDistr==uniformVolumeSnr){
-        targetSNR=draw_volume_snr(minSNR,maxSNR);
+        targetSNR=draw_volume_snr(minSNR,maxSNR,XLALUniformDeviate(randParams));
       }
       else{
         fprintf(stderr,"Allowed values for --snr-distr are uniform, log10 and volume. Exiting...\n");
@@ -4270,9 +4284,9 @@ int main( int argc, char *argv[] )
       }
       else
       {
-        REAL8 *start_freqs;
+        REAL8 *ninja_start_freqs;
         const char  **ifo_list;
-        REAL8FrequencySeries **psds;
+        REAL8FrequencySeries **ninja_psds;
         int count, num_ifos = 0;
         char *tmp, *ifo;
 
@@ -4286,9 +4300,9 @@ int main( int argc, char *argv[] )
           ifo       = strtok (NULL, ",");
         }
 
-        start_freqs = (REAL8 *) LALCalloc(num_ifos, sizeof(REAL8));
+        ninja_start_freqs = (REAL8 *) LALCalloc(num_ifos, sizeof(REAL8));
         ifo_list    = (const char **) LALCalloc(num_ifos, sizeof(char *));
-        psds        = (REAL8FrequencySeries **) LALCalloc(num_ifos, sizeof(REAL8FrequencySeries *));
+        ninja_psds        = (REAL8FrequencySeries **) LALCalloc(num_ifos, sizeof(REAL8FrequencySeries *));
 
         strcpy(tmp, ifos);
         ifo   = strtok (tmp,",");
@@ -4300,23 +4314,23 @@ int main( int argc, char *argv[] )
 
           if (ifo_list[count][0] == 'V')
           {
-            start_freqs[count] = virgoStartFreq;
-            psds[count]        = virgoPsd;
+            ninja_start_freqs[count] = virgoStartFreq;
+            ninja_psds[count]        = virgoPsd;
           }
           else
           {
-            start_freqs[count] = ligoStartFreq;
-            psds[count]        = ligoPsd;
+            ninja_start_freqs[count] = ligoStartFreq;
+            ninja_psds[count]        = ligoPsd;
           }
           count++;
           ifo = strtok (NULL, ",");
         }
 
-        adjust_snr_with_psds_real8(simTable, targetSNR, num_ifos, ifo_list, psds, start_freqs);
+        adjust_snr_with_psds_real8(simTable, targetSNR, num_ifos, ifo_list, ninja_psds, ninja_start_freqs);
 
-        LALFree(start_freqs);
+        LALFree(ninja_start_freqs);
         LALFree(ifo_list);
-        LALFree(psds);
+        LALFree(ninja_psds);
         LALFree(tmp);
       }
     }
@@ -4325,16 +4339,16 @@ int main( int argc, char *argv[] )
     if (ifos!=NULL && !ninjaSNR)
     {
       char *ifo;
-      REAL8 *start_freqs;
-      REAL8FrequencySeries **psds;
       i=1;
 
       /*reset counter */
       ifo = ifonames[0];
       i = 0;
       /* Create variables for PSDs and starting frequencies */
-      start_freqs = (REAL8 *) LALCalloc(numifos+1, sizeof(REAL8));
-      psds        = (REAL8FrequencySeries **) LALCalloc(numifos+1, sizeof(REAL8FrequencySeries *));
+      if (!start_freqs)
+        start_freqs = (REAL8 *) LALCalloc(numifos+1, sizeof(REAL8));
+      if (!psds)
+        psds        = (REAL8FrequencySeries **) LALCalloc(numifos+1, sizeof(REAL8FrequencySeries *));
 
       /* Hardcoded values of srate and segment length. If changed here they must also be changed in inspiralutils.c/calculate_lalsim_snr */
       REAL8 srate = 4096.0;
@@ -4388,16 +4402,20 @@ int main( int argc, char *argv[] )
         single_IFO_SNR_threshold=0.0;
       }
 
-      /* This function draws a proposed SNR and rescales the distance accordingly */
-      scale_lalsim_distance(simTable, ifonames, psds, start_freqs, dDistr);
-
-      /* Clean  */
-      if (psds) LALFree(psds);
-      if (start_freqs) LALFree(start_freqs);
+      /* The distance is rescaled to a proposed SNR once all the
+       * injections have been drawn, see below */
+      if (nscaled == maxscaled)
+      {
+        maxscaled = maxscaled ? 2 * maxscaled : 1024;
+        scaled = (SimInspiralTable **) LALRealloc(scaled, maxscaled * sizeof(*scaled));
+      }
+      scaled[nscaled++] = simTable;
+    }
+    else
+    {
+      /* populate the site specific information: end times and effective distances */
+      LALPopulateSimInspiralSiteInfo( &status, simTable );
     }
-
-    /* populate the site specific information: end times and effective distances */
-    LALPopulateSimInspiralSiteInfo( &status, simTable );
 
     /* populate the taper options */
     {
@@ -4462,6 +4480,27 @@ int main( int argc, char *argv[] )
   /* destroy the structure containing the random params */
   LAL_CALL(  LALDestroyRandomParams( &status, &randParams ), &status);
 
+  /* Rescale the distances of the injections to proposed SNRs.  This
+   * generates waveforms in each IFO and dominates the run time, so the
+   * injections are done in parallel.  Injection k draws its proposed SNRs
+   * from its own counter-based stream, so the result does not depend on
+   * the number of threads. */
+  if ( nscaled )
+  {
+    long k;
+#pragma omp parallel for schedule(dynamic)
+    for ( k = 0; k < (long) nscaled; k++ )
+      scale_lalsim_distance(scaled[k], ifonames, psds, start_freqs, dDistr, (UINT8) rand_seed, (UINT8) k);
+
+    /* populate the site specific information: end times and effective distances */
+    for ( k = 0; k < (long) nscaled; k++ )
+      LALPopulateSimInspiralSiteInfo( &status, scaled[k] );
+
+    LALFree(scaled);
+  }
+  if (psds) LALFree(psds);
+  if (start_freqs) LALFree(start_freqs);
+
   /* If we read from an external trigger file, free our external trigger.
      exttrigHead is guaranteed to have no children to free. */
   if ( exttrigHead != NULL ) {
@@ -4501,11 +4540,11 @@ int main( int argc, char *argv[] )
   XLALSimInspiralAssignIDs ( injections.simInspiralTable, 0, 0 );
   if ( injections.simInspiralTable )
   {
-    LAL_CALL( LALBeginLIGOLwXMLTable( &status, &xmlfp, sim_inspiral_table ),
-        &status );
-    LAL_CALL( LALWriteLIGOLwXMLTable( &status, &xmlfp, injections,
-          sim_inspiral_table ), &status );
-    LAL_CALL( LALEndLIGOLwXMLTable ( &status, &xmlfp ), &status );
+    if ( XLALWriteLIGOLwXMLSimInspiralTable( &xmlfp, injections.simInspiralTable ) )
+    {
+      fprintf( stderr, "error writing sim_inspiral table\n" );
+      exit( 1 );
+    }
   }
 
   LAL_CALL( LALCloseLIGOLwXMLFile ( &status, &xmlfp ), &status );
@@ -4527,12 +4566,18 @@ int main( int argc, char *argv[] )
   return 0;
 }
 
+/* The proposed SNRs are drawn from the counter-based stream (seed, stream)
+ * rather than from randParams, so that injections can be scaled in any
+ * order, or concurrently, with the same result. */
 static void scale_lalsim_distance(SimInspiralTable *inj,
                                   char **IFOnames,
                                   REAL8FrequencySeries **psds,
                                   REAL8 *start_freqs,
-                                  LoudnessDistribution snrDistr)
+                                  LoudnessDistribution snrDistr,
+                                  UINT8 seed,
+                                  UINT8 stream)
 {
+  UINT8 draw=0;
   REAL8 proposedSNR=0.0;
   REAL8 local_min=0.0;
   REAL8 net_snr=0.0;
@@ -4577,15 +4622,15 @@ static void scale_lalsim_distance(SimInspiralTable *inj,
     /* Generate a new SNR from given distribution */
     if (snrDistr==uniformSnr)
     {
-      proposedSNR=draw_uniform_snr(local_min,maxSNR);
+      proposedSNR=draw_uniform_snr(local_min,maxSNR,philox_uniform_deviate(seed,stream,draw++));
     }
     else if(snrDistr==uniformLogSnr)
     {
-      proposedSNR=draw_log10_snr(local_min,maxSNR);
+      proposedSNR=draw_log10_snr(local_min,maxSNR,philox_uniform_deviate(seed,stream,draw++));
     }
     else if (snrDistr==uniformVolumeSnr)
     {
-      proposedSNR=draw_volume_snr(local_min,maxSNR);
+      proposedSNR=draw_volume_snr(local_min,maxSNR,philox_uniform_deviate(seed,stream,draw++));
     }
     else
     {
@@ -4643,27 +4688,38 @@ static void scale_lalsim_distance(SimInspiralTable *inj,
 
 }
 
-static REAL8 draw_volume_snr(REAL8 minsnr,REAL8 maxsnr)
+/* uniform deviate in [0, 1) number draw of the counter-based stream
+ * (seed, stream) */
+static REAL8 philox_uniform_deviate(UINT8 seed,UINT8 stream,UINT8 draw)
+{
+  const UINT4 key[2] = { (UINT4)seed, (UINT4)(seed >> 32) };
+  UINT4 ctr[4] = { (UINT4)stream, (UINT4)(stream >> 32), (UINT4)draw, (UINT4)(draw >> 32) };
+  XLALPhilox4x32( ctr, key );
+  return ( ( ( (UINT8)ctr[0] << 32 ) | ctr[1] ) >> 11 ) * 0x1p-53;
+}
+
+/* The SNR distributions, given a uniform deviate u in [0, 1) */
+static REAL8 draw_volume_snr(REAL8 minsnr,REAL8 maxsnr,REAL8 u)
 {
   REAL8 proposedSNR=0.0;
   proposedSNR=1.0/(maxsnr*maxsnr*maxsnr) +
-    (1.0/(minsnr*minsnr*minsnr)-1.0/(maxsnr*maxsnr*maxsnr))*XLALUniformDeviate(randParams);
+    (1.0/(minsnr*minsnr*minsnr)-1.0/(maxsnr*maxsnr*maxsnr))*u;
   proposedSNR=1.0/cbrt(proposedSNR);
   return proposedSNR;
 }
 
-static REAL8 draw_uniform_snr(REAL8 minsnr,REAL8 maxsnr)
+static REAL8 draw_uniform_snr(REAL8 minsnr,REAL8 maxsnr,REAL8 u)
 {
   REAL8 proposedSNR=0.0;
-  proposedSNR=minsnr+ (maxsnr-minsnr)*XLALUniformDeviate(randParams);
+  proposedSNR=minsnr+ (maxsnr-minsnr)*u;
   return proposedSNR;
 }
 
-static REAL8 draw_log10_snr(REAL8 minsnr,REAL8 maxsnr)
+static REAL8 draw_log10_snr(REAL8 minsnr,REAL8 maxsnr,REAL8 u)
 {
   REAL8 proposedlogSNR=0.0;
   REAL8 logminsnr=log10(minsnr);
   REAL8 logmaxsnr=log10(maxsnr);
-  proposedlogSNR=logminsnr+ (logmaxsnr-logminsnr)*XLALUniformDeviate(randParams);
+  proposedlogSNR=logminsnr+ (logmaxsnr-logminsnr)*u;
   return pow(10.0,proposedlogSNR);
 }
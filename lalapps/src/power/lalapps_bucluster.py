@@ -110,6 +110,9 @@ bailoutfunc = {
 clusterfunc = {
 	"excesspower": bucluster.ExcessPowerClusterFunc
 }[options.cluster_algorithm]
+groupfunc = {
+	"excesspower": bucluster.ExcessPowerGroupFunc
+}[options.cluster_algorithm]
 
 
 for filename in filenames:
@@ -143,6 +146,7 @@ for filename in filenames:
 		clusterfunc = clusterfunc,
 		sortkeyfunc = sortkeyfunc,
 		bailoutfunc = bailoutfunc,
+		groupfunc = groupfunc,
 		verbose = options.verbose
 	)
 
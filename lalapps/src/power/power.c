@@ -178,6 +178,14 @@ struct options {
 	/* don't read a time series longer than this (e.g., because of
 	 * available memory) */
 	int max_series_length;
+	/* read and analyze the data one PSD interval at a time, writing
+	 * clustered triggers as they become final */
+	int streaming;
+	/* number of analysis windows in the running PSD average
+	 * (streaming mode) */
+	int psd_average_windows;
+	/* peak time clustering window (seconds, streaming mode) */
+	double cluster_window;
 
 	/*
 	 * data conditioning
@@ -254,6 +262,9 @@ static struct options *options_new(void)
 	options->resample_rate = 0;	/* impossible */
 	options->seed = 0;	/* default == use system clock */
 	options->max_series_length = 0;	/* default == disable */
+	options->streaming = 0;	/* default == disable */
+	options->psd_average_windows = 32;	/* default */
+	options->cluster_window = -1;	/* default == max tile duration */
 	options->high_pass = -1;	/* impossible */
 	options->max_event_rate = 0;	/* default == disable */
 	options->output_filename = NULL;	/* impossible */
@@ -298,6 +309,7 @@ static void print_usage(const char *program)
 "	 --bandwidth <Hz>\n" \
 "	[--calibration-cache <cache file name>]\n" \
 "	 --channel-name <name>\n" \
+"	[--cluster-window <seconds>]\n" \
 "	 --confidence-threshold <confidence>\n" \
 "	[--dump-diagnostics <XML file name>]\n" \
 "	 --filter-corruption <samples>\n" \
@@ -317,9 +329,11 @@ static void print_usage(const char *program)
 "	[--mdc-channel <name>]\n" \
 "	[--output <filename>]\n" \
 "	 --psd-average-points <samples>\n" \
+"	[--psd-average-windows <count>]\n" \
 "	[--ram-limit <MebiBytes>]\n" \
 "	 --resample-rate <Hz>\n" \
-"	[--seed <seed>]\n");
+"	[--seed <seed>]\n" \
+"	[--streaming]\n");
 	fprintf(stderr,
 "	 --tile-stride-fraction <fraction>\n" \
 "	[--user-tag <comment>]\n" \
@@ -465,6 +479,7 @@ static struct options *parse_command_line(int argc, char *argv[], const ProcessT
 		{"injection-file", required_argument, NULL, 'P'},
 		{"calibration-cache", required_argument, NULL, 'B'},
 		{"channel-name", required_argument, NULL, 'C'},
+		{"cluster-window", required_argument, NULL, 'w'},
 		{"confidence-threshold", required_argument, NULL, 'g'},
 		{"dump-diagnostics", required_argument, NULL, 'X'},
 		{"filter-corruption", required_argument, NULL, 'j'},
@@ -482,9 +497,11 @@ static struct options *parse_command_line(int argc, char *argv[], const ProcessT
 		{"mdc-channel", required_argument, NULL, 'S'},
 		{"output", required_argument, NULL, 'b'},
 		{"psd-average-points", required_argument, NULL, 'Z'},
+		{"psd-average-windows", required_argument, NULL, 'N'},
 		{"ram-limit", required_argument, NULL, 'a'},
 		{"resample-rate", required_argument, NULL, 'e'},
 		{"seed", required_argument, NULL, 'c'},
+		{"streaming", no_argument, NULL, 'Y'},
 		{"tile-stride-fraction", required_argument, NULL, 'f'},
 		{"user-tag", required_argument, NULL, 'h'},
 		{"window-length", required_argument, NULL, 'W'},
@@ -560,6 +577,16 @@ static struct options *parse_command_line(int argc, char *argv[], const ProcessT
 		ADD_PROCESS_PARAM(process, "string");
 		break;
 
+	case 'N':
+		options->psd_average_windows = atoi(LALoptarg);
+		if(options->psd_average_windows < 1) {
+			sprintf(msg, "must be greater than 0 (%d specified)", options->psd_average_windows);
+			print_bad_argument(argv[0], long_options[option_index].name, msg);
+			args_are_bad = 1;
+		}
+		ADD_PROCESS_PARAM(process, "int");
+		break;
+
 	case 'O':
 		print_usage(argv[0]);
 		exit(0);
@@ -620,6 +647,11 @@ static struct options *parse_command_line(int argc, char *argv[], const ProcessT
 		}
 		break;
 
+	case 'Y':
+		options->streaming = 1;
+		ADD_PROCESS_PARAM(process, "string");
+		break;
+
 	case 'X':
 #if 0
 		options->diagnostics = XLALOpenLIGOLwXMLFile(LALoptarg);
@@ -724,6 +756,16 @@ static struct options *parse_command_line(int argc, char *argv[], const ProcessT
 		ADD_PROCESS_PARAM(process, "float");
 		break;
 
+	case 'w':
+		options->cluster_window = atof(LALoptarg);
+		if(options->cluster_window < 0) {
+			sprintf(msg, "must not be negative (%g s specified)", options->cluster_window);
+			print_bad_argument(argv[0], long_options[option_index].name, msg);
+			args_are_bad = 1;
+		}
+		ADD_PROCESS_PARAM(process, "float");
+		break;
+
 	case 'o':
 		options->high_pass = atof(LALoptarg);
 		if(options->high_pass < 0) {
@@ -813,6 +855,22 @@ static struct options *parse_command_line(int argc, char *argv[], const ProcessT
 	if(options->high_pass > options->flow - 10.0)
 		XLALPrintWarning("%s: warning: data conditioning high-pass frequency (%f Hz) greater than 10 Hz below TF plane low frequency (%f Hz)\n", argv[0], options->high_pass, options->flow);
 
+	/*
+	 * In streaming mode the output is a directory that receives one
+	 * document per flush of triggers, and the clustering window
+	 * defaults to the longest tile.
+	 */
+
+	if(options->streaming) {
+		static char default_directory[] = ".";
+		if(!options->output_filename)
+			options->output_filename = default_directory;
+		if(options->cluster_window < 0)
+			options->cluster_window = options->maxTileDuration;
+		if(options->max_series_length)
+			XLALPrintWarning("%s: warning: --ram-limit is ignored in streaming mode\n", argv[0]);
+	}
+
 	/*
 	 * Set output filename to default value if needed.
 	 */
@@ -859,20 +917,15 @@ static struct options *parse_command_line(int argc, char *argv[], const ProcessT
  */
 
 
-static REAL8TimeSeries *get_time_series(const char *cachefilename, const char *chname, LIGOTimeGPS start, LIGOTimeGPS end, size_t lengthlimit)
+/*
+ * Open a frame stream on the files listed in a cache.
+ */
+
+
+static LALFrStream *open_frame_stream(const char *cachefilename)
 {
-	double duration = XLALGPSDiff(&end, &start);
 	LALCache *cache;
 	LALFrStream *stream;
-	LALTYPECODE series_type;
-	REAL8TimeSeries *series;
-
-	if(duration < 0)
-		XLAL_ERROR_NULL(XLAL_EINVAL);
-
-	/*
-	 * Open frame stream.
-	 */
 
 	cache = XLALCacheImport(cachefilename);
 	if(!cache)
@@ -888,15 +941,33 @@ static REAL8TimeSeries *get_time_series(const char *cachefilename, const char *c
 
 	XLALFrStreamSetMode(stream, LAL_FR_STREAM_VERBOSE_MODE);
 
+	return stream;
+}
+
+
+/*
+ * Read the interval [start, end) of a channel from an open frame stream.
+ * The stream is left open, so that successive intervals can be read from
+ * it without re-opening the frame files.
+ */
+
+
+static REAL8TimeSeries *read_time_series(LALFrStream *stream, const char *chname, LIGOTimeGPS start, LIGOTimeGPS end, size_t lengthlimit)
+{
+	double duration = XLALGPSDiff(&end, &start);
+	LALTYPECODE series_type;
+	REAL8TimeSeries *series;
+
+	if(duration < 0)
+		XLAL_ERROR_NULL(XLAL_EINVAL);
+
 	/*
 	 * Get the data.
 	 */
 
 	series_type = XLALFrStreamGetTimeSeriesType(chname, stream);
-	if((int) series_type < 0) {
-		XLALFrStreamClose(stream);
+	if((int) series_type < 0)
 		XLAL_ERROR_NULL(XLAL_EFUNC);
-	}
 
 	switch(series_type) {
 	case LAL_S_TYPE_CODE: {
@@ -906,14 +977,11 @@ static REAL8TimeSeries *get_time_series(const char *cachefilename, const char *c
 
 		REAL4TimeSeries *tmp = XLALFrStreamReadREAL4TimeSeries(stream, chname, &start, duration, lengthlimit);
 		unsigned i;
-		if(!tmp) {
-			XLALFrStreamClose(stream);
+		if(!tmp)
 			XLAL_ERROR_NULL(XLAL_EFUNC);
-		}
 		series = XLALCreateREAL8TimeSeries(tmp->name, &tmp->epoch, tmp->f0, tmp->deltaT, &tmp->sampleUnits, tmp->data->length);
 		if(!series) {
 			XLALDestroyREAL4TimeSeries(tmp);
-			XLALFrStreamClose(stream);
 			XLAL_ERROR_NULL(XLAL_EFUNC);
 		}
 		for(i = 0; i < tmp->data->length; i++)
@@ -924,15 +992,12 @@ static REAL8TimeSeries *get_time_series(const char *cachefilename, const char *c
 
 	case LAL_D_TYPE_CODE:
 		series = XLALFrStreamReadREAL8TimeSeries(stream, chname, &start, duration, lengthlimit);
-		if(!series) {
-			XLALFrStreamClose(stream);
+		if(!series)
 			XLAL_ERROR_NULL(XLAL_EFUNC);
-		}
 		break;
 
 	default:
-		XLALPrintError("get_time_series(): error: invalid channel data type %d\n", series_type);
-		XLALFrStreamClose(stream);
+		XLALPrintError("read_time_series(): error: invalid channel data type %d\n", series_type);
 		XLAL_ERROR_NULL(XLAL_EINVAL);
 	}
 
@@ -941,22 +1006,37 @@ static REAL8TimeSeries *get_time_series(const char *cachefilename, const char *c
 	 */
 
 	if(stream->state & LAL_FR_STREAM_GAP) {
-		XLALPrintError("get_time_series(): error: gap in data detected between GPS times %d.%09u s and %d.%09u s\n", start.gpsSeconds, start.gpsNanoSeconds, end.gpsSeconds, end.gpsNanoSeconds);
+		XLALPrintError("read_time_series(): error: gap in data detected between GPS times %d.%09u s and %d.%09u s\n", start.gpsSeconds, start.gpsNanoSeconds, end.gpsSeconds, end.gpsNanoSeconds);
 		XLALDestroyREAL8TimeSeries(series);
 		XLAL_ERROR_NULL(XLAL_EDATA);
 	}
 
 	/*
-	 * Close stream.
+	 * Verbosity.
 	 */
 
-	XLALFrStreamClose(stream);
+	XLALPrintInfo("read_time_series(): read %u samples (%.9lf s) at GPS time %u.%09u s\n", series->data->length, series->data->length * series->deltaT, start.gpsSeconds, start.gpsNanoSeconds);
+
+	return series;
+}
+
+
+static REAL8TimeSeries *get_time_series(const char *cachefilename, const char *chname, LIGOTimeGPS start, LIGOTimeGPS end, size_t lengthlimit)
+{
+	LALFrStream *stream;
+	REAL8TimeSeries *series;
 
 	/*
-	 * Verbosity.
+	 * Open frame stream, get the data, and close the stream.
 	 */
 
-	XLALPrintInfo("get_time_series(): read %u samples (%.9lf s) at GPS time %u.%09u s\n", series->data->length, series->data->length * series->deltaT, start.gpsSeconds, start.gpsNanoSeconds);
+	stream = open_frame_stream(cachefilename);
+	if(!stream)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	series = read_time_series(stream, chname, start, end, lengthlimit);
+	XLALFrStreamClose(stream);
+	if(!series)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
 
 	return series;
 }
@@ -1195,11 +1275,13 @@ static REAL8TimeSeries *add_mdc_injections(const char *mdccachefile, const char
 
 /*
  * Analyze a time series in intervals corresponding to the length of time
- * for which the instrument's noise is stationary.
+ * for which the instrument's noise is stationary.  If psd_regressor is not
+ * NULL the intervals are whitened with its running PSD estimate, which is
+ * updated as the data are analyzed.
  */
 
 
-static SnglBurst **analyze_series(SnglBurst **addpoint, REAL8TimeSeries *series, int psd_length, int psd_shift, struct options *options)
+static SnglBurst **analyze_series(SnglBurst **addpoint, REAL8TimeSeries *series, int psd_length, int psd_shift, LALPSDRegressor *psd_regressor, struct options *options)
 {
 	unsigned i;
 
@@ -1221,10 +1303,11 @@ static SnglBurst **analyze_series(SnglBurst **addpoint, REAL8TimeSeries *series,
 		XLALPrintInfo(" complete\n");
 		XLALPrintInfo("%s(): analyzing samples %i -- %i (%.9lf s -- %.9lf s)\n", __func__, start, start + interval->data->length, start * interval->deltaT, (start + interval->data->length) * interval->deltaT);
 
-		XLAL_TRY(*addpoint = XLALEPSearch(
+		XLAL_TRY(*addpoint = XLALEPSearchWithPSDRegressor(
 			options->diagnostics,
 			interval,
 			options->window,
+			psd_regressor,
 			options->flow,
 			options->bandwidth,
 			options->confidence_threshold,
@@ -1307,6 +1390,94 @@ static void output_results(char *file, const ProcessTable *_process_table, const
 }
 
 
+/*
+ * Streaming mode:  cluster the pending events by peak time, and write the
+ * clusters whose peak times precede cut, and which therefore cannot be
+ * changed by events found later, to a document of their own in the output
+ * directory.  The document's search summary covers [*flushed, cut), and
+ * *flushed is advanced to cut.  The document is written under a temporary
+ * name and renamed into place, so that programs watching the directory
+ * never see a partial file.
+ */
+
+
+static int flush_events(SnglBurst **pending, LIGOTimeGPS *flushed, LIGOTimeGPS cut, long *next_event_id, const struct options *options, ProcessTable *_process_table, const ProcessParamsTable *_process_params_table, SearchSummaryTable *_search_summary_table)
+{
+	SnglBurst *ready = NULL;
+	SnglBurst **p;
+	char filename[FILENAME_MAX];
+	char tmpfilename[FILENAME_MAX];
+	int end_seconds;
+
+	if(XLALGPSCmp(&cut, flushed) <= 0)
+		return 0;
+
+	/*
+	 * cluster, and split off the events that are final
+	 */
+
+	if(*pending) {
+		SnglBurstColumns *cols = XLALCreateSnglBurstColumns(*pending);
+		if(!cols)
+			XLAL_ERROR(XLAL_EFUNC);
+		if(XLALSnglBurstColumnsSortByPeakTimeAndSNR(cols) < 0) {
+			XLALDestroySnglBurstColumns(cols);
+			XLAL_ERROR(XLAL_EFUNC);
+		}
+		XLALSnglBurstColumnsClusterByPeakTime(cols, options->cluster_window);
+		XLALSnglBurstColumnsToTable(pending, cols);
+		XLALDestroySnglBurstColumns(cols);
+	}
+	/* discard the events that repeat ones already written */
+	while(*pending && XLALGPSCmp(&(*pending)->peak_time, flushed) < 0) {
+		SnglBurst *next = (*pending)->next;
+		XLALDestroySnglBurst(*pending);
+		*pending = next;
+	}
+	for(p = pending; *p && XLALGPSCmp(&(*p)->peak_time, &cut) < 0; p = &(*p)->next);
+	if(p != pending) {
+		ready = *pending;
+		*pending = *p;
+		*p = NULL;
+	}
+	*next_event_id = XLALSnglBurstAssignIDs(ready, _process_table->process_id, *next_event_id);
+
+	/*
+	 * summarize the span and check the event rate limit
+	 */
+
+	_search_summary_table->out_start_time = *flushed;
+	_search_summary_table->out_end_time = cut;
+	_search_summary_table->nevents = XLALSnglBurstTableLength(ready);
+	if((options->max_event_rate > 0) && (_search_summary_table->nevents > XLALGPSDiff(&cut, flushed) * options->max_event_rate)) {
+		XLALPrintError("flush_events(): event rate limit exceeded!");
+		XLALDestroySnglBurstTable(ready);
+		XLAL_ERROR(XLAL_EDATA);
+	}
+
+	/*
+	 * write the document
+	 */
+
+	end_seconds = cut.gpsSeconds + (cut.gpsNanoSeconds ? 1 : 0);
+	if(snprintf(filename, sizeof(filename), "%s/%s-POWER_%s-%d-%d.xml", options->output_filename, options->ifo, options->comment, flushed->gpsSeconds, end_seconds - flushed->gpsSeconds) >= (int) sizeof(filename) || snprintf(tmpfilename, sizeof(tmpfilename), "%s.tmp", filename) >= (int) sizeof(tmpfilename)) {
+		XLALDestroySnglBurstTable(ready);
+		XLAL_ERROR(XLAL_ESIZE);
+	}
+	XLALGPSTimeNow(&_process_table->end_time);
+	output_results(tmpfilename, _process_table, _process_params_table, _search_summary_table, ready);
+	XLALDestroySnglBurstTable(ready);
+	if(rename(tmpfilename, filename)) {
+		XLALPrintError("flush_events(): error: cannot rename \"%s\" to \"%s\"\n", tmpfilename, filename);
+		XLAL_ERROR(XLAL_EIO);
+	}
+	XLALPrintInfo("flush_events(): wrote %d events for GPS times [%d.%09u s, %d.%09u s) to \"%s\"\n", _search_summary_table->nevents, flushed->gpsSeconds, flushed->gpsNanoSeconds, cut.gpsSeconds, cut.gpsNanoSeconds, filename);
+
+	*flushed = cut;
+	return 0;
+}
+
+
 /*
  * ============================================================================
  *
@@ -1333,6 +1504,12 @@ int main(int argc, char *argv[])
 	ProcessParamsTable *_process_params_table = NULL;
 	SearchSummaryTable *_search_summary_table;
 	gsl_rng *rng = NULL;
+	/* streaming mode */
+	LALFrStream *stream = NULL;
+	LALPSDRegressor *psd_regressor = NULL;
+	LIGOTimeGPS flushed = {0, 0};
+	LIGOTimeGPS analyzed_end = {0, 0};
+	long next_event_id = 0;
 
 	/*
 	 * Command line
@@ -1400,6 +1577,24 @@ int main(int argc, char *argv[])
 		}
 	}
 
+	/*
+	 * in streaming mode, keep the frame stream open for the whole run
+	 * and maintain a running PSD estimate across reads
+	 */
+
+	if(options->streaming) {
+		if(options->cache_filename) {
+			stream = open_frame_stream(options->cache_filename);
+			if(!stream) {
+				XLALPrintError("%s: error: failure opening frame stream\n", argv[0]);
+				exit(1);
+			}
+		}
+		psd_regressor = XLALPSDRegressorNew(options->psd_average_windows, 9);
+		if(!psd_regressor)
+			exit(1);
+	}
+
 	/*
 	 * ====================================================================
 	 *
@@ -1410,10 +1605,32 @@ int main(int argc, char *argv[])
 
 	/*
 	 * Split the total length of time to be analyzed into time series
-	 * small enough to fit in RAM.
+	 * small enough to fit in RAM.  In streaming mode each time series
+	 * is a single PSD interval plus the conditioning overlap, so that
+	 * triggers are produced with a latency of about one interval.
 	 */
 
 	for(epoch = options->gps_start; XLALGPSCmp(&epoch, &boundepoch) < 0;) {
+		LIGOTimeGPS end = options->gps_end;
+
+		if(options->streaming) {
+			/* the last stride is moved back to end at the end
+			 * of the data, as the last PSD interval is in batch
+			 * mode;  the events it repeats are discarded when
+			 * they are written out */
+			const double stride = (options->psd_length + 2 * options->filter_corruption) / (double) options->resample_rate;
+			LIGOTimeGPS stride_end = epoch;
+			XLALGPSAdd(&stride_end, stride);
+			if(XLALGPSCmp(&stride_end, &end) < 0)
+				end = stride_end;
+			else {
+				epoch = end;
+				XLALGPSAdd(&epoch, -stride);
+				if(XLALGPSCmp(&epoch, &options->gps_start) < 0)
+					epoch = options->gps_start;
+			}
+		}
+
 		/*
 		 * Progress bar.
 		 */
@@ -1426,12 +1643,41 @@ int main(int argc, char *argv[])
 		 * Get the data.
 		 */
 
-		if(options->cache_filename) {
+		if(stream) {
+			/*
+			 * Read the next stride from the open frame stream.
+			 * A gap ends the running PSD estimate:  the
+			 * triggers found so far are written out, and the
+			 * analysis resumes with the next stride.
+			 */
+
+			int errnum;
+			XLAL_TRY(series = read_time_series(stream, options->channel_name, epoch, end, 0), errnum);
+			if(!series && errnum == XLAL_EDATA) {
+				XLALPrintWarning("%s: warning: skipping GPS times [%d.%09u s, %d.%09u s) because of missing data\n", argv[0], epoch.gpsSeconds, epoch.gpsNanoSeconds, end.gpsSeconds, end.gpsNanoSeconds);
+				if(flush_events(&_sngl_burst_table, &flushed, analyzed_end, &next_event_id, options, _process_table, _process_params_table, _search_summary_table) < 0)
+					exit(1);
+				XLALDestroySnglBurstTable(_sngl_burst_table);
+				_sngl_burst_table = NULL;
+				EventAddPoint = &_sngl_burst_table;
+				XLALPSDRegressorReset(psd_regressor);
+				flushed.gpsSeconds = flushed.gpsNanoSeconds = 0;
+				XLALGPSAdd(&epoch, options->psd_shift / (double) options->resample_rate);
+				continue;
+			}
+			if(!series) {
+				XLALPrintError("%s: error: failure reading input data\n", argv[0]);
+				exit(1);
+			}
+			/* FIXME:  frame files cannot be trusted to
+			 * provide units, see below */
+			series->sampleUnits = options->cal_cache_filename ? lalADCCountUnit : lalStrainUnit;
+		} else if(options->cache_filename) {
 			/*
 			 * Read from frame files
 			 */
 
-			series = get_time_series(options->cache_filename, options->channel_name, epoch, options->gps_end, options->max_series_length);
+			series = get_time_series(options->cache_filename, options->channel_name, epoch, end, options->max_series_length);
 			if(!series) {
 				XLALPrintError("%s: error: failure reading input data\n", argv[0]);
 				exit(1);
@@ -1446,8 +1692,8 @@ int main(int argc, char *argv[])
 			 * Synthesize Gaussian white noise.
 			 */
 
-			unsigned length = XLALGPSDiff(&options->gps_end, &epoch) * options->resample_rate;
-			if(options->max_series_length)
+			unsigned length = XLALGPSDiff(&end, &epoch) * options->resample_rate;
+			if(options->max_series_length && !options->streaming)
 				length = min(options->max_series_length, length);
 			/* for units, assume ADC counts if a calibration
 			 * cache has been provided, otherwise assume
@@ -1521,15 +1767,37 @@ int main(int argc, char *argv[])
 		}
 		_search_summary_table->out_end_time = series->epoch;
 		XLALGPSAdd(&_search_summary_table->out_end_time, series->deltaT * (series->data->length - options->window_pad));
+		if(!flushed.gpsSeconds) {
+			flushed = series->epoch;
+			XLALGPSAdd(&flushed, series->deltaT * options->window_pad);
+		}
+		analyzed_end = _search_summary_table->out_end_time;
 
 		/*
 		 * Analyze the data
 		 */
 
-		EventAddPoint = analyze_series(EventAddPoint, series, options->psd_length, options->psd_shift, options);
+		EventAddPoint = analyze_series(EventAddPoint, series, options->psd_length, options->psd_shift, psd_regressor, options);
 		if(!EventAddPoint)
 			exit(1);
 
+		/*
+		 * In streaming mode, write out the clusters that events
+		 * from later strides can no longer join.  Later tiles do
+		 * not peak before the end of the data analyzed so far, so
+		 * clusters peaking more than a clustering window before it
+		 * are final;  a further tile duration allows for tiles
+		 * that straddle the boundary.
+		 */
+
+		if(options->streaming) {
+			LIGOTimeGPS cut = analyzed_end;
+			XLALGPSAdd(&cut, -(options->cluster_window + options->maxTileDuration));
+			if(flush_events(&_sngl_burst_table, &flushed, cut, &next_event_id, options, _process_table, _process_params_table, _search_summary_table) < 0)
+				exit(1);
+			for(EventAddPoint = &_sngl_burst_table; *EventAddPoint; EventAddPoint = &(*EventAddPoint)->next);
+		}
+
 		/*
 		 * Reset for next run
 		 *
@@ -1545,28 +1813,47 @@ int main(int argc, char *argv[])
 	}
 
 	/*
-	 * Sort the events, and assign IDs.
+	 * In streaming mode, write out the remaining clusters and finish.
 	 */
 
-	XLALSortSnglBurst(&_sngl_burst_table, XLALCompareSnglBurstByPeakTimeAndSNR);
-	XLALSnglBurstAssignIDs(_sngl_burst_table, _process_table->process_id, 0);
+	if(options->streaming) {
+		if(flush_events(&_sngl_burst_table, &flushed, analyzed_end, &next_event_id, options, _process_table, _process_params_table, _search_summary_table) < 0)
+			exit(1);
+		if(_sngl_burst_table) {
+			/* events peaking after the end of the analyzed
+			 * data;  they are not covered by any document */
+			XLALPrintWarning("%s: warning: discarding %d events peaking after GPS time %d.%09u s\n", argv[0], XLALSnglBurstTableLength(_sngl_burst_table), analyzed_end.gpsSeconds, analyzed_end.gpsNanoSeconds);
+			XLALDestroySnglBurstTable(_sngl_burst_table);
+			_sngl_burst_table = NULL;
+		}
+		if(stream)
+			XLALFrStreamClose(stream);
+		XLALPSDRegressorFree(psd_regressor);
+	} else {
+		/*
+		 * Sort the events, and assign IDs.
+		 */
 
-	/*
-	 * Check event rate limit.
-	 */
+		XLALSortSnglBurst(&_sngl_burst_table, XLALCompareSnglBurstByPeakTimeAndSNR);
+		XLALSnglBurstAssignIDs(_sngl_burst_table, _process_table->process_id, 0);
 
-	_search_summary_table->nevents = XLALSnglBurstTableLength(_sngl_burst_table);
-	if((options->max_event_rate > 0) && (_search_summary_table->nevents > XLALGPSDiff(&_search_summary_table->out_end_time, &_search_summary_table->out_start_time) * options->max_event_rate)) {
-		XLALPrintError("%s: event rate limit exceeded!", argv[0]);
-		exit(1);
-	}
+		/*
+		 * Check event rate limit.
+		 */
 
-	/*
-	 * Output the results.
-	 */
+		_search_summary_table->nevents = XLALSnglBurstTableLength(_sngl_burst_table);
+		if((options->max_event_rate > 0) && (_search_summary_table->nevents > XLALGPSDiff(&_search_summary_table->out_end_time, &_search_summary_table->out_start_time) * options->max_event_rate)) {
+			XLALPrintError("%s: event rate limit exceeded!", argv[0]);
+			exit(1);
+		}
 
-	XLALGPSTimeNow(&_process_table->end_time);
-	output_results(options->output_filename, _process_table, _process_params_table, _search_summary_table, _sngl_burst_table);
+		/*
+		 * Output the results.
+		 */
+
+		XLALGPSTimeNow(&_process_table->end_time);
+		output_results(options->output_filename, _process_table, _process_params_table, _search_summary_table, _sngl_burst_table);
+	}
 
 	/*
 	 * Final cleanup.
@@ -120,6 +120,7 @@ typedef struct tagConfigVariables{
 #define MYMAX(x,y) ( (x) > (y) ? (x) : (y) )
 #define MYMIN(x,y) ( (x) < (y) ? (x) : (y) )
 #define USE_ALIGNED_MEMORY_ROUTINES
+#define DEMOD_BATCH_SIZE 64 /* number of templates evaluated per pass over the SFT pairs */
 
 /* local function prototypes */
 int XLALInitUserVars ( UserInput_t *uvar );
@@ -1575,48 +1576,104 @@ int demodLoopCrossCorr(MultiSSBtimes *multiBinaryTimes, MultiSSBtimes *multiSSBT
     XLAL_ERROR( XLAL_EFUNC );
   } /*Need to apply additional doppler shifting before the loop, or the first point in parameter space will be lost and return a wrong SNR when fBand!=0*/
 
+  /* sorted pair table and per-template frequency info for a batch of templates; freed on every exit */
+  SFTPairTable *pairTable = NULL;
+  COMPLEX8Vector *XLAL_INIT_DECL( batchPhases, [DEMOD_BATCH_SIZE] );
+  UINT4Vector *XLAL_INIT_DECL( batchBins, [DEMOD_BATCH_SIZE] );
+  REAL8VectorSequence *XLAL_INIT_DECL( batchSinc, [DEMOD_BATCH_SIZE] );
+  int errnum = XLAL_SUCCESS;
+
+  /* sorted pair table is template-independent, so build it once */
+  if ( (XLALCreateSFTPairTable( &pairTable, sftPairs, sftIndices, GammaAve )  != XLAL_SUCCESS ) ) {
+    LogPrintf ( LOG_CRITICAL, "%s: XLALCreateSFTPairTable() failed with errno=%d\n", __func__, xlalErrno );
+    errnum = XLAL_EFUNC;
+    goto cleanup;
+  }
+
+  UINT4 numSFTs = sftIndices->length;
+  PulsarDopplerParams batchDopplerpos[DEMOD_BATCH_SIZE];
+  REAL8 batchCCStat[DEMOD_BATCH_SIZE], batchEvSquared[DEMOD_BATCH_SIZE];
+  for ( UINT4 b = 0; b < DEMOD_BATCH_SIZE; b++ ) {
+    if ( (batchPhases[b] = XLALCreateCOMPLEX8Vector( numSFTs )) == NULL
+         || (batchBins[b] = XLALCreateUINT4Vector( numSFTs )) == NULL
+         || (batchSinc[b] = XLALCreateREAL8VectorSequence( numSFTs, uvar.numBins )) == NULL ) {
+      LogPrintf ( LOG_CRITICAL, "%s: failed to allocate template batch with errno=%d\n", __func__, xlalErrno );
+      errnum = XLAL_EFUNC;
+      goto cleanup;
+    }
+  }
+  UINT4 numBatch = 0;
+
   //fprintf(stdout, "Resampling? %s \n", uvar.resamp ? "true" : "false");
 
-  while ( GetNextCrossCorrTemplate(&dopplerShiftFlag, &firstPoint, &dopplerpos, &binaryTemplateSpacings, &minBinaryTemplate, &maxBinaryTemplate, &fCount, &aCount, &tCount, &pCount, fSpacingNum, aSpacingNum, tSpacingNum, pSpacingNum) == 0)
+  BOOLEAN moreTemplates = TRUE;
+  while ( moreTemplates )
     {
-      /* do useful stuff here*/
+      moreTemplates = ( GetNextCrossCorrTemplate(&dopplerShiftFlag, &firstPoint, &dopplerpos, &binaryTemplateSpacings, &minBinaryTemplate, &maxBinaryTemplate, &fCount, &aCount, &tCount, &pCount, fSpacingNum, aSpacingNum, tSpacingNum, pSpacingNum) == 0 );
 
-      /* Apply additional Doppler shifting using current binary orbital parameters */
-      /* Might want to be clever about checking whether we've changed the orbital parameters or only the frequency */
-      if (dopplerShiftFlag == TRUE)
+      if ( moreTemplates )
 	{
-	  if ( (XLALAddMultiBinaryTimes( &multiBinaryTimes, multiSSBTimes, &dopplerpos )  != XLAL_SUCCESS ) ) {
-	    LogPrintf ( LOG_CRITICAL, "%s: XLALAddMultiBinaryTimes() failed with errno=%d\n", __func__, xlalErrno );
-	    XLAL_ERROR( XLAL_EFUNC );
+	  /* Apply additional Doppler shifting using current binary orbital parameters */
+	  /* Might want to be clever about checking whether we've changed the orbital parameters or only the frequency */
+	  if (dopplerShiftFlag == TRUE)
+	    {
+	      if ( (XLALAddMultiBinaryTimes( &multiBinaryTimes, multiSSBTimes, &dopplerpos )  != XLAL_SUCCESS ) ) {
+		LogPrintf ( LOG_CRITICAL, "%s: XLALAddMultiBinaryTimes() failed with errno=%d\n", __func__, xlalErrno );
+		errnum = XLAL_EFUNC;
+		goto cleanup;
+	      }
+	    }
+
+	  if ( (XLALGetDopplerShiftedFrequencyInfo( shiftedFreqs, batchBins[numBatch], batchPhases[numBatch], batchSinc[numBatch], uvar.numBins, &dopplerpos, sftIndices, inputSFTs, multiBinaryTimes, badBins, Tsft )  != XLAL_SUCCESS ) ) {
+	    LogPrintf ( LOG_CRITICAL, "%s: XLALGetDopplerShiftedFrequencyInfo() failed with errno=%d\n", __func__, xlalErrno );
+	    errnum = XLAL_EFUNC;
+	    goto cleanup;
 	  }
+	  batchDopplerpos[numBatch++] = dopplerpos;
 	}
 
-      if ( (XLALGetDopplerShiftedFrequencyInfo( shiftedFreqs, lowestBins, expSignalPhases, sincList, uvar.numBins, &dopplerpos, sftIndices, inputSFTs, multiBinaryTimes, badBins, Tsft )  != XLAL_SUCCESS ) ) {
-	LogPrintf ( LOG_CRITICAL, "%s: XLALGetDopplerShiftedFrequencyInfo() failed with errno=%d\n", __func__, xlalErrno );
-	XLAL_ERROR( XLAL_EFUNC );
-      }
+      /* evaluate the batch once it is full, or when the templates are exhausted */
+      if ( numBatch == DEMOD_BATCH_SIZE || ( !moreTemplates && numBatch > 0 ) )
+	{
+	  if ( (XLALCalculatePulsarCrossCorrStatisticBatch( batchCCStat, batchEvSquared, numBatch, batchPhases, batchBins, batchSinc, pairTable, sftIndices, inputSFTs, multiWeights, uvar.numBins)  != XLAL_SUCCESS ) ) {
+	    LogPrintf ( LOG_CRITICAL, "%s: XLALCalculatePulsarCrossCorrStatisticBatch() failed with errno=%d\n", __func__, xlalErrno );
+	    errnum = XLAL_EFUNC;
+	    goto cleanup;
+	  }
 
-      if ( (XLALCalculatePulsarCrossCorrStatistic( &ccStat, &evSquared, GammaAve, expSignalPhases, lowestBins, sincList, sftPairs, sftIndices, inputSFTs, multiWeights, uvar.numBins)  != XLAL_SUCCESS ) ) {
-	LogPrintf ( LOG_CRITICAL, "%s: XLALCalculatePulsarCrossCorrStatistic() failed with errno=%d\n", __func__, xlalErrno );
-	XLAL_ERROR( XLAL_EFUNC );
-      }
+	  for ( UINT4 b = 0; b < numBatch; b++ )
+	    {
+	      /* fill candidate struct and insert into toplist if necessary */
+	      thisCandidate.freq = batchDopplerpos[b].fkdot[0];
+	      thisCandidate.tp = XLALGPSGetREAL8( &batchDopplerpos[b].tp );
+	      thisCandidate.argp = batchDopplerpos[b].argp;
+	      thisCandidate.asini = batchDopplerpos[b].asini;
+	      thisCandidate.ecc = batchDopplerpos[b].ecc;
+	      thisCandidate.period = batchDopplerpos[b].period;
+	      thisCandidate.rho = batchCCStat[b];
+	      thisCandidate.evSquared = batchEvSquared[b];
+	      thisCandidate.estSens = estSens;
+
+	      insert_into_crossCorrBinary_toplist(ccToplist, thisCandidate);
+	    }
+	  numBatch = 0;
 
-      /* fill candidate struct and insert into toplist if necessary */
-      thisCandidate.freq = dopplerpos.fkdot[0];
-      thisCandidate.tp = XLALGPSGetREAL8( &dopplerpos.tp );
-      thisCandidate.argp = dopplerpos.argp;
-      thisCandidate.asini = dopplerpos.asini;
-      thisCandidate.ecc = dopplerpos.ecc;
-      thisCandidate.period = dopplerpos.period;
-      thisCandidate.rho = ccStat;
-      thisCandidate.evSquared = evSquared;
-      thisCandidate.estSens = estSens;
+	  //fprintf(stdout,"Inner loop: freq %f , tp %f , asini %f \n", thisCandidate.freq, thisCandidate.tp, thisCandidate.asini);
+	}
 
-      insert_into_crossCorrBinary_toplist(ccToplist, thisCandidate);
+    } /* end while loop over templates */
 
-      //fprintf(stdout,"Inner loop: freq %f , tp %f , asini %f \n", thisCandidate.freq, thisCandidate.tp, thisCandidate.asini);
+ cleanup:
+  for ( UINT4 b = 0; b < DEMOD_BATCH_SIZE; b++ ) {
+    XLALDestroyCOMPLEX8Vector( batchPhases[b] );
+    XLALDestroyUINT4Vector( batchBins[b] );
+    XLALDestroyREAL8VectorSequence( batchSinc[b] );
+  }
+  XLALDestroySFTPairTable( pairTable );
+  if ( errnum != XLAL_SUCCESS ) {
+    XLAL_ERROR( errnum );
+  }
 
-    } /* end while loop over templates */
     return 0;
 } /* end demodLoopCrossCorr */
 
@@ -41,6 +41,7 @@
 #include <lal/SFTfileIO.h>
 #include <lal/NormalizeSFTRngMed.h>
 #include <lal/LALMalloc.h>
+#include <lal/VectorMath.h>
 
 /*normal c header files*/
 #include <stdio.h>
@@ -70,6 +71,7 @@ int main(int argc, char **argv)
     LIGOTimeGPS startTime, endTime; 
     REAL8 avg =0;
     REAL4 *timeavg =NULL;
+    REAL4 *power =NULL;
     /*REAL4 PWR,SNR;*/ /* 06/15/2017 gam; No longer compute SNR in this code.  */ 
     REAL4 PWR;
     REAL8 f =0;
@@ -180,7 +182,11 @@ int main(int argc, char **argv)
     NumBinsAvg = freqres*numBins/(f_max-f_min);/*this calcs the number of bins over which to average the sft data, this is worked out so it produces the same freq resolution as specified in the arguments passed to fscanDriver.py. numBins is the total number of bins in the raw sft data*/
 
     l=0;/*l is used as a counter to count how many SFTs and fake zero SFTs (used for gaps) are output for specgram.*/
-    timestamps = XLALCreateREAL8Vector(l);/*test for getting rid of second loop*/
+    /* at most one entry per SFT plus one per timebaseline of gap, so allocate the timestamps once */
+    timestamps = XLALCreateREAL8Vector(nSFT + (UINT4)((sft_vect->data[nSFT-1].epoch.gpsSeconds - sft_vect->data[0].epoch.gpsSeconds)/timebaseline));
+    XLAL_CHECK_MAIN( timestamps != NULL, XLAL_EFUNC );
+    /* power of each bin of the current SFT, computed once per SFT with a vectorised kernel */
+    XLAL_CHECK_MAIN( ( power = XLALMalloc(numBins*sizeof(REAL4)) ) != NULL, XLAL_ENOMEM );
     LALCHARCreateVector(&status, &year_date, (UINT4)128); 
 
   /*create output files and check for missing sfts*/
@@ -189,18 +195,18 @@ int main(int argc, char **argv)
         cur_epoch = sft_vect->data[j].epoch.gpsSeconds;/*finds the gps time of the current sft in the sequence with index j*/
         fprintf(fp2, "%d.\t%d\n", l, cur_epoch);/*cg; this bit writes the second file, i.e. the timestamps*/
     
-        XLALResizeREAL8Vector(timestamps, l+1);/*resizes the vector timestamps, so cur_epoch can be added*/
-        timestamps->data[l]= cur_epoch;/*number of gaps is not know in advance, hence need for te resizing*/
+        timestamps->data[l]= cur_epoch;
         XLALGPSToUTC(&date, cur_epoch);/*cg; gets the UTC date in struct tm format from the GPS seconds.*/
         fprintf(fp4, "%d\t %i\t %i\t %i\t %i\t %i\t %i\n", l, (date.tm_year+1900), date.tm_mon+1, date.tm_mday, date.tm_hour, date.tm_min, date.tm_sec);
     
+        XLAL_CHECK_MAIN( XLALVectorAbs2COMPLEX8(power, sft_vect->data[j].data->data, numBins) == XLAL_SUCCESS, XLAL_EFUNC );
         for ( i=0; i < (numBins-2); i+=NumBinsAvg)/*cg; this loop works out the powers and writes the first file.*/
         {/*cg; each SFT is split up into a number of bins, the number of bins is read in from the SFT file*/
             avg = 0.0;/*cg; the vairable avg is reset each time.*/
             if (i+NumBinsAvg>numBins) {printf("Error\n");return(2);}/*cg; error is detected, to prevent referencing data past the end of sft_vect.*/
             for (k=0;k<NumBinsAvg;k++)/*cg; for each bin, k goes trhough each entry from 0 to 180.*/
-                avg += 2.0*(crealf(sft_vect->data[j].data->data[i+k])*crealf(sft_vect->data[j].data->data[i+k]) +
-                cimagf(sft_vect->data[j].data->data[i+k])*cimagf(sft_vect->data[j].data->data[i+k]))/timebaseline;/* 06/15/2017 gam; avg power */
+                avg += power[i+k];
+            avg *= 2.0/timebaseline;/* 06/15/2017 gam; avg power */
             fprintf(fp,"%e\t",sqrt(avg/NumBinsAvg)); /* 06/15/2017 gam; then take sqrt here. */
         }
         fprintf(fp,"\n");
@@ -223,7 +229,6 @@ int main(int argc, char **argv)
                 cur_epoch=cur_epoch+timebaseline;
                 fprintf(fp2, "%d.\t%d\n", l, cur_epoch );
                     
-                XLALResizeREAL8Vector(timestamps, l+1);
                 timestamps->data[l]= cur_epoch;
                 XLALGPSToUTC(&date, cur_epoch);/*cg; gets the UTC date in struct tm format from the GPS seconds.*/
                 fprintf(fp4, "%d\t %i\t %i\t %i\t %i\t %i\t %i\n", l, (date.tm_year+1900), date.tm_mon+1, date.tm_mday, date.tm_hour, date.tm_min, date.tm_sec);
@@ -239,24 +244,13 @@ int main(int argc, char **argv)
     /* Find time average of normalized SFTs */
     XLALNormalizeSFTVect(sft_vect, blocksRngMed, 0.0);
     XLALNormalizeSFTVect(sft_vect, blocksRngMed, 0.0);
-    timeavg = XLALMalloc(numBins*sizeof(REAL4));
+    timeavg = XLALCalloc(numBins, sizeof(REAL4));
     if (timeavg == NULL) fprintf(stderr,"Timeavg memory not allocated\n");
 
     for (j=0;j<nSFT;j++)
     { 
-        for ( i=0; i < numBins; i++)
-        {
-            if (j == 0) 
-            {
-                timeavg[i] = crealf(sft_vect->data[j].data->data[i])*crealf(sft_vect->data[j].data->data[i]) + 
-                            cimagf(sft_vect->data[j].data->data[i])*cimagf(sft_vect->data[j].data->data[i]);
-            } 
-            else 
-            {
-                timeavg[i] += crealf(sft_vect->data[j].data->data[i])*crealf(sft_vect->data[j].data->data[i]) + 
-                            cimagf(sft_vect->data[j].data->data[i])*cimagf(sft_vect->data[j].data->data[i]);
-            }
-        }
+        XLAL_CHECK_MAIN( XLALVectorAbs2COMPLEX8(power, sft_vect->data[j].data->data, numBins) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLAL_CHECK_MAIN( XLALVectorAddREAL4(timeavg, timeavg, power, numBins) == XLAL_SUCCESS, XLAL_EFUNC );
     }
     /*timeavg records the power of each bin*/
     for ( i=0; i < numBins; i++)
@@ -500,6 +494,8 @@ int main(int argc, char **argv)
     /*fprintf(stderr,"end of spec_avg 2\n");*/
 
     if (timeavg != NULL) XLALFree(timeavg);
+    XLALFree(power);
+    XLALDestroyREAL8Vector(timestamps);
 
     /*fprintf(stderr,"end of spec_avg 3\n");*/
 
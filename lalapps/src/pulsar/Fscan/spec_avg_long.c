@@ -33,6 +33,7 @@
 #include <lal/LALStdio.h>
 #include <lal/UserInput.h>
 #include <lal/SFTfileIO.h>
+#include <lal/VectorMath.h>
 
 
 /*---------- DEFINES ----------*/
@@ -61,7 +62,7 @@ int main(int argc, char **argv)
     CHAR outbase[256], outfile0[512], outfile1[512], outfile2[512];
 
     CHAR *SFTpatt = NULL, *IFO = NULL, *outputBname = NULL;
-    INT4 startGPS = 0, endGPS = 0, blocksRngMean = 21;
+    INT4 startGPS = 0, endGPS = 0, blocksRngMean = 21, SFTbatchSize = 64;
     REAL8 f_min = 0.0, f_max = 0.0, timebaseline = 0;
 
     LALStringVector *line_freq = NULL;
@@ -76,6 +77,7 @@ int main(int argc, char **argv)
     XLAL_CHECK_MAIN( XLALRegisterNamedUvar(&blocksRngMean, "blocksRngMean", INT4,   'w', OPTIONAL, "Running Median window size") == XLAL_SUCCESS, XLAL_EFUNC);
     XLAL_CHECK_MAIN( XLALRegisterNamedUvar(&outputBname,  "outputBname",  STRING, 'o', OPTIONAL, "Base name of output files" ) == XLAL_SUCCESS, XLAL_EFUNC);
     XLAL_CHECK_MAIN( XLALRegisterNamedUvar(&timebaseline, "timeBaseline", REAL8,  't', REQUIRED, "The time baseline of sfts") == XLAL_SUCCESS, XLAL_EFUNC);
+    XLAL_CHECK_MAIN( XLALRegisterNamedUvar(&SFTbatchSize, "SFTbatchSize", INT4,   0,   OPTIONAL, "Number of SFTs to load from the catalog at a time") == XLAL_SUCCESS, XLAL_EFUNC);
     XLAL_CHECK_MAIN( XLALRegisterNamedUvar(&line_freq,    "lineFreq", STRINGVector,  0, OPTIONAL, "CSV list of line frequencies. If set, then an output file with all GPS start times of SFTs with 0s and 1s is given for when line is above threshold (1 indicates above threshold)") == XLAL_SUCCESS, XLAL_EFUNC);
 
     BOOLEAN should_exit = 0;
@@ -89,6 +91,7 @@ int main(int argc, char **argv)
 
     XLAL_CHECK_MAIN( blocksRngMean % 2 == 1, XLAL_EINVAL, "Need to provide an odd value for blocksRngMean");
     INT4 nside = (blocksRngMean - 1) / 2;
+    XLAL_CHECK_MAIN( SFTbatchSize > 0, XLAL_EINVAL, "Need to provide a positive value for SFTbatchSize");
 
     INT4Vector *line_freq_bin_in_sft = NULL;
     if (XLALUserVarWasSet(&line_freq)) {
@@ -134,22 +137,19 @@ int main(int argc, char **argv)
     }
 
     printf("Looping over SFTs to compute average spectra\n");
-    for (UINT4 j = 0; j<catalog->length; j++)
+    REAL8Vector *power = NULL, *avepower = NULL, *weight = NULL;
+    for (UINT4 j0 = 0; j0 < catalog->length; j0 += SFTbatchSize)
     {
-        fprintf(stderr,"Extracting SFT %d...\n", j);
-
-	//Extract one SFT at a time from the catalog
-	//we do this by using a catalog timeslice to get just the current SFT
-	SFTCatalog XLAL_INIT_DECL(catalogSlice);
-	LIGOTimeGPS thisSFTstarttime = catalog->data[j].header.epoch;
-	LIGOTimeGPS thisSFTendtime = thisSFTstarttime;
-	XLAL_CHECK_MAIN( XLALGPSAdd(&thisSFTendtime, 0.01) != NULL, XLAL_EFUNC );
-	XLAL_CHECK_MAIN( XLALSFTCatalogTimeslice(&catalogSlice, catalog, &thisSFTstarttime, &thisSFTendtime) == XLAL_SUCCESS, XLAL_EFUNC );
-	XLAL_CHECK_MAIN( (sft_vect = XLALLoadSFTs(&catalogSlice, f_min, f_max)) != NULL, XLAL_EFUNC );
-	XLAL_CHECK_MAIN( sft_vect->length == 1, XLAL_EBADLEN, "Oops, got %d SFTs instead of one", sft_vect->length );
+	//Load a batch of consecutive SFTs at once, using a view of the catalog
+	SFTCatalog XLAL_INIT_DECL(catalogBatch);
+	catalogBatch.data = &catalog->data[j0];
+	catalogBatch.length = ( catalog->length - j0 < (UINT4)SFTbatchSize ) ? catalog->length - j0 : (UINT4)SFTbatchSize;
+	fprintf(stderr,"Extracting SFTs %d to %d...\n", j0, j0 + catalogBatch.length - 1);
+	XLAL_CHECK_MAIN( (sft_vect = XLALLoadSFTs(&catalogBatch, f_min, f_max)) != NULL, XLAL_EFUNC );
+	XLAL_CHECK_MAIN( sft_vect->length == catalogBatch.length, XLAL_EBADLEN, "Oops, got %d SFTs instead of %d", sft_vect->length, catalogBatch.length );
 
 	//For the first time through the loop, we allocate some vectors
-        if (j == 0)
+        if (j0 == 0)
 	{
 	    UINT4 numBins = sft_vect->data->data->length;
 	    f0 = sft_vect->data->f0;
@@ -160,6 +160,15 @@ int main(int argc, char **argv)
 	    XLAL_CHECK_MAIN( (timeavgwt = XLALCreateREAL8Vector(numBins)) != NULL, XLAL_EFUNC );
 	    XLAL_CHECK_MAIN( (sumweight = XLALCreateREAL8Vector(numBins)) != NULL, XLAL_EFUNC );
 	    XLAL_CHECK_MAIN( (persistency = XLALCreateREAL8Vector(numBins)) != NULL, XLAL_EFUNC );
+	    memset(timeavg->data, 0, sizeof(REAL8)*numBins);
+	    memset(timeavgwt->data, 0, sizeof(REAL8)*numBins);
+	    memset(sumweight->data, 0, sizeof(REAL8)*numBins);
+	    memset(persistency->data, 0, sizeof(REAL8)*numBins);
+
+	    //Work space for the power, running-mean power and weights of one SFT
+	    XLAL_CHECK_MAIN( (power = XLALCreateREAL8Vector(numBins)) != NULL, XLAL_EFUNC );
+	    XLAL_CHECK_MAIN( (avepower = XLALCreateREAL8Vector(numBins)) != NULL, XLAL_EFUNC );
+	    XLAL_CHECK_MAIN( (weight = XLALCreateREAL8Vector(numBins)) != NULL, XLAL_EFUNC );
 
 	    if (XLALUserVarWasSet(&line_freq)) {
 	       for (UINT4 n=0; n<line_freq_array->length; n++) {
@@ -168,52 +177,37 @@ int main(int argc, char **argv)
 	    }
 	}
 
-	//Loop over the SFT bins
-	for (UINT4 i = 0; i < sft_vect->data->data->length; i++)
+	for (UINT4 k = 0; k < sft_vect->length; k++)
 	{
-	    REAL8 thispower = ((REAL8)crealf(sft_vect->data[0].data->data[i]) *
-			       (REAL8)crealf(sft_vect->data[0].data->data[i])) +
-		              ((REAL8)cimagf(sft_vect->data[0].data->data[i]) *
-			       (REAL8)cimagf(sft_vect->data[0].data->data[i]));
-	    REAL8 thisavepower = 0.;
-	    UINT4 count = 0;
-	    for (INT4 ii = -nside; ii <= nside; ii++)
+	    const UINT4 j = j0 + k;
+	    const COMPLEX8 *data = sft_vect->data[k].data->data;
+	    const INT4 numBins = (INT4)power->length;
+	    XLAL_CHECK_MAIN( sft_vect->data[k].data->length == power->length, XLAL_EBADLEN, "SFT %d has %d bins instead of %d", j, sft_vect->data[k].data->length, power->length );
+
+	    //Power of each bin, computed once per SFT
+	    for (INT4 i = 0; i < numBins; i++)
 	    {
-	        //Only add to the cumulative average power if the variables are in range
-	       if ((INT4)i + ii >= 0 && (INT4)i + ii<(INT4)sft_vect->data->data->length)
-		{
-		    thisavepower += ((REAL8)crealf(sft_vect->data[0].data->data[i + ii]) *
-				     (REAL8)crealf(sft_vect->data[0].data->data[i + ii])) +
-				    ((REAL8)cimagf(sft_vect->data[0].data->data[i + ii]) *
-				     (REAL8)cimagf(sft_vect->data[0].data->data[i + ii]));
-		    count++;
-		}
+		power->data[i] = ((REAL8)crealf(data[i]) * (REAL8)crealf(data[i])) + ((REAL8)cimagf(data[i]) * (REAL8)cimagf(data[i]));
 	    }
-	    thisavepower /= count;
-	    REAL8 weight = 1. / thisavepower;
 
-	    //For the first SFT, just assign the values to the vector, otherwise accumulate
-	    if (j == 0)
+	    //Running mean of the power over blocksRngMean bins, truncated at the edges of the band,
+	    //updated by adding the bin entering and subtracting the bin leaving the window
+	    REAL8 windowsum = 0.;
+	    for (INT4 ii = 0; ii < nside && ii < numBins; ii++)
 	    {
-	        timeavg->data[i] = thispower;
-		timeavgwt->data[i] = thispower*weight;
-		sumweight->data[i] = weight;
-		// Always check if this bin is above the 3 sigma threshold
-		if (thispower >= 3.0*thisavepower) {
-		   persistency->data[i] = 1.0;
-		   // If user specified a list of line frequencies to monitor
-		   if (XLALUserVarWasSet(&line_freq)) {
-		      XLAL_CHECK_MAIN( check_and_mark_line(line_freq_bin_in_sft, i, j, line_exceeds_thresh_in_sfts) == XLAL_SUCCESS, XLAL_EFUNC );
-		   }
-		} else persistency->data[i] = 0.0;
+		windowsum += power->data[ii];
 	    }
-	    else
+	    for (INT4 i = 0; i < numBins; i++)
 	    {
-	        timeavg->data[i] += thispower;
-		timeavgwt->data[i] += thispower*weight;
-		sumweight->data[i] += weight;
+		if (i + nside < numBins) windowsum += power->data[i + nside];
+		if (i - nside - 1 >= 0) windowsum -= power->data[i - nside - 1];
+		const INT4 lo = (i - nside < 0) ? 0 : i - nside;
+		const INT4 hi = (i + nside >= numBins) ? numBins - 1 : i + nside;
+		avepower->data[i] = windowsum / (hi - lo + 1);
+		weight->data[i] = 1. / avepower->data[i];
+
 		// Always check if this bin is above the 3 sigma threshold
-		if (thispower >= 3.0*thisavepower) {
+		if (power->data[i] >= 3.0*avepower->data[i]) {
 		   persistency->data[i] += 1.0;
 		   // If user specified a list of line frequencies to monitor
 		   if (XLALUserVarWasSet(&line_freq)) {
@@ -221,11 +215,20 @@ int main(int argc, char **argv)
 		   }
 		}
 	    }
+
+	    //Accumulate the power, weighted power and weights
+	    XLAL_CHECK_MAIN( XLALVectorAddREAL8(timeavg->data, timeavg->data, power->data, numBins) == XLAL_SUCCESS, XLAL_EFUNC );
+	    XLAL_CHECK_MAIN( XLALVectorAddREAL8(sumweight->data, sumweight->data, weight->data, numBins) == XLAL_SUCCESS, XLAL_EFUNC );
+	    XLAL_CHECK_MAIN( XLALVectorMultiplyREAL8(power->data, power->data, weight->data, numBins) == XLAL_SUCCESS, XLAL_EFUNC );
+	    XLAL_CHECK_MAIN( XLALVectorAddREAL8(timeavgwt->data, timeavgwt->data, power->data, numBins) == XLAL_SUCCESS, XLAL_EFUNC );
 	}
 	// Destroys current SFT Vector
 	XLALDestroySFTVector(sft_vect);
 	sft_vect = NULL;
     }
+    XLALDestroyREAL8Vector(power);
+    XLALDestroyREAL8Vector(avepower);
+    XLALDestroyREAL8Vector(weight);
     printf("About to do calculation of averages...\n");
     printf("Sample: timeavg[0]=%g, timeavgwt[0]=%g, sumweight[0]=%g\n", timeavg->data[0], timeavgwt->data[0], sumweight->data[0]);
     /*timeavg records the power of each bin*/
@@ -57,6 +57,7 @@ typedef struct
   INT4 numSegments;
   LALStringVector *IFOs;
   CHAR *outputInfo;
+  CHAR *outputJSON;
   INT4 numTrials;
   LIGOTimeGPS startTime;
 
@@ -68,6 +69,8 @@ typedef struct
   BOOLEAN sharedWorkspace;   	// useful for checking workspace sharing for Resampling
   BOOLEAN perSegmentSFTs;     	// Weave vs GCT convention: GCT loads SFT frequency ranges globally, Weave loads them per segment (more efficient)
   BOOLEAN resampFFTPowerOf2;
+  INT4 resampNumThreads;
+  int resampMemPlacement;
   INT4 Dterms;
   INT4 randSeed;
 
@@ -120,6 +123,8 @@ main ( int argc, char *argv[] )
   uvar->Tsft = 1800;
   uvar->sharedWorkspace = 1;
   uvar->resampFFTPowerOf2 = FstatOptionalArgsDefaults.resampFFTPowerOf2;
+  uvar->resampNumThreads = FstatOptionalArgsDefaults.resampNumThreads;
+  uvar->resampMemPlacement = FstatOptionalArgsDefaults.resampMemPlacement;
   uvar->perSegmentSFTs = 1;
 
   uvar->Dterms = FstatOptionalArgsDefaults.Dterms;
@@ -130,6 +135,7 @@ main ( int argc, char *argv[] )
 
   XLAL_CHECK_MAIN ( (uvar->IFOs = XLALCreateStringVector ( "H1", NULL )) != NULL, XLAL_EFUNC );
   uvar->outputInfo = NULL;
+  uvar->outputJSON = NULL;
 
   XLAL_CHECK ( XLALRegisterUvarAuxDataMember ( FstatMethod, UserEnum, XLALFstatMethodChoices(), 0, OPTIONAL, "F-statistic method to use" ) == XLAL_SUCCESS, XLAL_EFUNC );
   XLAL_CHECK_MAIN ( XLALRegisterUvarMember ( Alpha,          RAJRange,       0, OPTIONAL,  "Skyposition [drawn isotropically]: Range in 'Alpha' = right ascension)" ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -155,10 +161,13 @@ main ( int argc, char *argv[] )
   XLAL_CHECK_MAIN ( XLALRegisterUvarMember ( sharedWorkspace,BOOLEAN,        0, OPTIONAL,  "Use workspace sharing across segments (only used in Resampling)" ) == XLAL_SUCCESS, XLAL_EFUNC );
   XLAL_CHECK_MAIN ( XLALRegisterUvarMember ( perSegmentSFTs, BOOLEAN,        0, OPTIONAL,  "Weave vs GCT: GCT determines and loads SFT frequency ranges globally, Weave does that per segment (more efficient)" ) == XLAL_SUCCESS, XLAL_EFUNC );
   XLAL_CHECK_MAIN ( XLALRegisterUvarMember ( resampFFTPowerOf2, BOOLEAN,     0, OPTIONAL,  "For Resampling methods: enforce FFT length to be a power of two (by rounding up)" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN ( XLALRegisterUvarMember ( resampNumThreads, INT4,       0, OPTIONAL,  "For Resampling methods: number of threads to spread the spindown+FFT loop over (requires OpenMP)" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN ( XLALRegisterUvarAuxDataMember ( resampMemPlacement, UserEnum, &FstatMemPlacementChoices, 0, OPTIONAL,  "For Resampling methods with resampNumThreads > 1: NUMA placement of the per-thread and shared buffers" ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   XLAL_CHECK_MAIN ( XLALRegisterUvarMember ( Dterms,         INT4,           0, OPTIONAL,  "Number of kernel terms (single-sided) in\na) Dirichlet kernel if FstatMethod=Demod*\nb) sinc-interpolation if FstatMethod=Resamp*" ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   XLAL_CHECK_MAIN ( XLALRegisterUvarMember ( outputInfo,     STRING,         0, OPTIONAL,  "Append Resampling internal info into this file") == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN ( XLALRegisterUvarMember ( outputJSON,     STRING,         0, OPTIONAL,  "Write per-trial F-stat timing (tauF per template and per-stage timing model) in JSON format to this file") == XLAL_SUCCESS, XLAL_EFUNC );
 
   XLAL_CHECK_MAIN ( XLALRegisterUvarMember ( Tsft,           REAL8,          0, DEVELOPER, "SFT length" ) == XLAL_SUCCESS, XLAL_EFUNC );
   XLAL_CHECK_MAIN ( XLALRegisterUvarMember ( ephemEarth,     STRING,         0, DEVELOPER, "Earth ephemeris file to use") == XLAL_SUCCESS, XLAL_EFUNC );
@@ -198,6 +207,7 @@ main ( int argc, char *argv[] )
   XLAL_CHECK_MAIN ( uvar->numSegments >= 1, XLAL_EINVAL );
   XLAL_CHECK_MAIN ( uvar->Tsft > 1, XLAL_EINVAL );
   XLAL_CHECK_MAIN ( uvar->numTrials >= 1, XLAL_EINVAL );
+  XLAL_CHECK_MAIN ( uvar->resampNumThreads >= 0, XLAL_EINVAL );
   // ---------- end: handle user input ----------
   srand( uvar->randSeed );	// set random seed
 
@@ -223,6 +233,8 @@ main ( int argc, char *argv[] )
   optionalArgs.FstatMethod = uvar->FstatMethod;
   optionalArgs.collectTiming = 1;
   optionalArgs.resampFFTPowerOf2 = uvar->resampFFTPowerOf2;
+  optionalArgs.resampNumThreads = uvar->resampNumThreads;
+  optionalArgs.resampMemPlacement = uvar->resampMemPlacement;
   optionalArgs.Dterms = uvar->Dterms;
 
   FILE *timingLogFILE = NULL;
@@ -241,6 +253,12 @@ main ( int argc, char *argv[] )
       fprintf ( timingParFILE, "%%%%%8s %20s %20s %20s %20s %20s %20s %20s %20s %12s %20s %20s %20s %20s %20s\n",
                 "Nseg", "Tseg", "Freq", "FreqBand", "dFreq", "f1dot", "f2dot", "Alpha", "Delta", "memUsageMB", "asini", "period", "ecc", "argp", "tp" );
     }
+  FILE *timingJSONFILE = NULL;
+  if ( uvar->outputJSON != NULL )
+    {
+      XLAL_CHECK_MAIN ( (timingJSONFILE = fopen (uvar->outputJSON, "wb")) != NULL, XLAL_ESYS, "Failed to open '%s' for writing\n", uvar->outputJSON );
+      fprintf ( timingJSONFILE, "{\"FstatMethod\": \"%s\", \"numDetectors\": %d, \"numSegments\": %d, \"trials\": [", XLALFstatMethodName ( uvar->FstatMethod ), numDetectors, uvar->numSegments );
+    }
   FstatInputVector *inputs;
   FstatQuantities whatToCompute = (FSTATQ_2F | FSTATQ_2F_PER_DET);
   FstatResults *results = NULL;
@@ -329,6 +347,7 @@ main ( int argc, char *argv[] )
       XLALFree ( catalogs );
 
       // ----- compute Fstatistics over segments
+      REAL8 tic = XLALGetTimeOfDay();
       for ( INT4 l = 0; l < uvar->numSegments; l ++ )
         {
           XLAL_CHECK_MAIN ( XLALComputeFstat ( &results, inputs->data[l], &Doppler_i, numFreqBins_i, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -338,6 +357,7 @@ main ( int argc, char *argv[] )
             XLAL_CHECK_MAIN ( XLALAppendFstatTiming2File ( inputs->data[l], timingLogFILE, (l == 0) && (i==0)) == XLAL_SUCCESS, XLAL_EFUNC );
           }
         } // for l < numSegments
+      REAL8 toc = XLALGetTimeOfDay();
 
       REAL8 memEnd = XLALGetCurrentHeapUsageMB();
       REAL8 memUsage = memEnd - memBase;
@@ -351,6 +371,36 @@ main ( int argc, char *argv[] )
                     );
         }
 
+      if ( timingJSONFILE != NULL )
+        {
+          // average generic and method-specific timing over segments
+          FstatTimingGeneric XLAL_INIT_DECL(tiGen);
+          FstatTimingModel XLAL_INIT_DECL(tiModel);
+          REAL8 tauF_eff = 0, tauF_core = 0, tauF_buffer = 0, b = 0;
+          REAL8 modelValues[TIMING_MODEL_MAX_VARS] = { 0 };
+          for ( INT4 l = 0; l < uvar->numSegments; l ++ )
+            {
+              XLAL_CHECK_MAIN ( XLALGetFstatTiming ( inputs->data[l], &tiGen, &tiModel ) == XLAL_SUCCESS, XLAL_EFUNC );
+              tauF_eff    += tiGen.tauF_eff / uvar->numSegments;
+              tauF_core   += tiGen.tauF_core / uvar->numSegments;
+              tauF_buffer += tiGen.tauF_buffer / uvar->numSegments;
+              b           += tiGen.NBufferMisses / tiGen.NCalls / uvar->numSegments;
+              for ( UINT4 k = 0; k < tiModel.numVariables; k ++ ) {
+                modelValues[k] += tiModel.values[k] / uvar->numSegments;
+              }
+            }
+          // wall-clock time per template, i.e. per segment, detector and frequency bin
+          REAL8 tauF_wall = ( toc - tic ) / ( uvar->numSegments * numDetectors * numFreqBins_i );
+          fprintf ( timingJSONFILE, "%s\n  {\"trial\": %d, \"method\": \"%s\", \"Tseg\": %d, \"Freq\": %.16g, \"FreqBand\": %.16g, \"dFreq\": %.16g, \"f1dot\": %.16g, \"f2dot\": %.16g, \"numFreqBins\": %d, \"memUsageMB\": %.1f, ",
+                    (i == 0) ? "" : ",", i+1, FmethodName, Tseg_i, Doppler_i.fkdot[0], FreqBand_i, dFreq_i, Doppler_i.fkdot[1], Doppler_i.fkdot[2], numFreqBins_i, memUsage );
+          fprintf ( timingJSONFILE, "\"tauF_wall\": %.6e, \"tauF_eff\": %.6e, \"tauF_core\": %.6e, \"tauF_buffer\": %.6e, \"b\": %.6e, \"model\": {",
+                    tauF_wall, tauF_eff, tauF_core, tauF_buffer, b );
+          for ( UINT4 k = 0; k < tiModel.numVariables; k ++ ) {
+            fprintf ( timingJSONFILE, "%s\"%s\": %.6e", (k == 0) ? "" : ", ", tiModel.names[k], modelValues[k] );
+          }
+          fprintf ( timingJSONFILE, "}}" );
+        }
+
       XLALDestroyFstatInputVector ( inputs );
     } // for i < numTrials
 
@@ -361,6 +411,10 @@ main ( int argc, char *argv[] )
   if ( timingParFILE != NULL ) {
     fclose ( timingParFILE );
   }
+  if ( timingJSONFILE != NULL ) {
+    fprintf ( timingJSONFILE, "\n]}\n" );
+    fclose ( timingJSONFILE );
+  }
 
   XLALDestroyFstatResults ( results );
   XLALDestroyUserVars();
@@ -51,6 +51,9 @@
 #include <unistd.h>
 #endif
 #include <gsl/gsl_math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /* LAL-includes */
 #include <lal/LALString.h>
@@ -65,6 +68,7 @@
 
 #include <lal/NormalizeSFTRngMed.h>
 #include <lal/ComputeFstat.h>
+#include <lal/SinCosLUT.h>
 #include <lal/LALHough.h>
 
 #include <lal/LogPrintf.h>
@@ -94,6 +98,9 @@
 
 // NOTE: LAL's nan is more portable than either of libc or gsl !
 #define LAL_NAN XLALREAL4FailNaN()
+
+/** number of consecutive templates computed by each thread of a threaded template loop */
+#define TEMPLATES_PER_THREAD 16
 /*---------- internal types ----------*/
 
 /** What info do we want to store in our toplist? */
@@ -170,6 +177,8 @@ typedef struct {
   UINT4Vector *numSFTsPerDet;		    /**< number of SFTs per detector, for log strings, etc. */
   LALStringVector *detectorIDs;		    /**< detector ID names, for column headings string */
   FstatInput *Fstat_in;		    /**< Fstat input data struct */
+  UINT4 numThreads;			    /**< number of threads used for the template loop (1 = serial) */
+  FstatInput **Fstat_in_thread;		    /**< per-thread views of 'Fstat_in' sharing its data, [0] = 'Fstat_in' itself */
   FstatQuantities Fstat_what;		    /**< Fstat quantities to compute */
   toplist_t* FstatToplist;		    /**< sorted 'toplist' of the NumCandidatesToKeep loudest candidates */
   scanlineWindow_t *scanlineWindow;         /**< moving window of candidates on scanline to find local maxima */
@@ -304,6 +313,9 @@ typedef struct {
   UINT4 transient_tauBand;	/**<  Range of transient-window timescales to search, in seconds */
   INT4  transient_dtau;		/**< Step-size for search/marginalization over transient-window timescale, in seconds */
   BOOLEAN transient_useFReg;  	/**< FALSE: use 'standard' e^F for marginalization, TRUE: use e^FReg = (1/D)*e^F */
+  INT4 transient_numThreads;	/**< number of threads used to compute the transient Fstat-map (requires OpenMP) */
+  INT4 numThreads;		/**< number of threads used for the template loop, or the Resamp spindown+FFT loop (requires OpenMP) */
+  BOOLEAN transient_useCUDA;	/**< compute the transient Fstat-map on a CUDA device */
 
   CHAR *outputTiming;		/**< output timing measurements and parameters into this file [append!]*/
   CHAR *outputFstatTiming;	/**< output F-statistic timing measurements and parameters into this file [append!]*/
@@ -348,6 +360,8 @@ int write_TimingInfo ( const CHAR *timingFile, const timingInfo_t *ti, const Con
 
 gsl_vector_int *resize_histogram(gsl_vector_int *old_hist, size_t size);
 
+int compute_Fstat_block ( FstatResults **Fstat_res, const ConfigVariables *cfg, const PulsarDopplerParams *dopplers, const UINT4 numDopplers );
+
 /* ---------- scanline window functions ---------- */
 scanlineWindow_t *XLALCreateScanlineWindow ( UINT4 windowWings );
 void XLALDestroyScanlineWindow ( scanlineWindow_t *scanlineWindow );
@@ -534,30 +548,63 @@ int main(int argc,char *argv[])
   REAL8 tic0, tic, toc, timeOfLastProgressUpdate = 0;	// high-precision timing counters
   timingInfo_t XLAL_INIT_DECL(timing);			// timings of Fstatistic computation, transient Fstat-map, transient Bayes factor
 
-  // pointer to Fstat results structure, will be allocated by XLALComputeFstat()
-  FstatResults* Fstat_res = NULL;
+  // templates are processed in blocks: the F-statistic is computed for a whole block (in parallel if
+  // GV.numThreads > 1), then the results are processed serially in template order, so that the scanline
+  // window, toplist and all output files are identical to those of a serial template loop
+  const UINT4 blockLength = ( GV.numThreads > 1 ) ? GV.numThreads * TEMPLATES_PER_THREAD : 1;
+  PulsarDopplerParams *blockDopplers = NULL;
+  XLAL_CHECK_MAIN ( (blockDopplers = XLALCalloc ( blockLength, sizeof(blockDopplers[0]) )) != NULL, XLAL_ENOMEM );
+
+  // pointers to Fstat results structures for each template in a block, will be allocated by XLALComputeFstat()
+  FstatResults **blockFstat_res = NULL;
+  XLAL_CHECK_MAIN ( (blockFstat_res = XLALCalloc ( blockLength, sizeof(blockFstat_res[0]) )) != NULL, XLAL_ENOMEM );
+
+  BOOLEAN moreDopplers = GV.runSearch;
+  UINT4 i_orbit = n_orbit;	// index of next binary orbit of the current Doppler position; n_orbit = get next Doppler position
+  while ( moreDopplers ) {
+
+    /* fill the next block of templates, looping over the binary orbits of each Doppler position */
+    UINT4 blockCount = 0;
+    while ( blockCount < blockLength ) {
+      if ( i_orbit == n_orbit ) {
+        if ( XLALNextDopplerPos( &dopplerpos, GV.scanState ) != 0 ) {
+          moreDopplers = FALSE;
+          break;
+        }
+        i_orbit = 0;
+      }
 
-  while ( GV.runSearch && ( XLALNextDopplerPos( &dopplerpos, GV.scanState ) == 0 ) ) {
+      UINT4 i = i_orbit++;	// eccentricity varies fastest, projected semi-major axis slowest
+      const UINT4 i_orbitEcc = i % n_orbitEcc; i /= n_orbitEcc;
+      const UINT4 i_orbitArgp = i % n_orbitArgp; i /= n_orbitArgp;
+      const UINT4 i_orbitTp = i % n_orbitTp; i /= n_orbitTp;
+      const UINT4 i_orbitPeriod = i % n_orbitPeriod; i /= n_orbitPeriod;
+      const UINT4 i_orbitasini = i;
 
-    for (UINT4 i_orbitasini = 0; i_orbitasini < n_orbitasini; ++i_orbitasini) {
-    for (UINT4 i_orbitPeriod = 0; i_orbitPeriod < n_orbitPeriod; ++i_orbitPeriod) {
-    for (UINT4 i_orbitTp = 0; i_orbitTp < n_orbitTp; ++i_orbitTp) {
-    for (UINT4 i_orbitArgp = 0; i_orbitArgp < n_orbitArgp; ++i_orbitArgp) {
-    for (UINT4 i_orbitEcc = 0; i_orbitEcc < n_orbitEcc; ++i_orbitEcc) {
-    
       dopplerpos.asini = uvar.orbitasini + i_orbitasini * uvar.dorbitasini;
       dopplerpos.period = uvar.orbitPeriod + i_orbitPeriod * uvar.dorbitPeriod;
       dopplerpos.tp = uvar.orbitTp; XLALGPSAdd( &dopplerpos.tp, i_orbitTp * uvar.dorbitTp );
       dopplerpos.argp = uvar.orbitArgp + i_orbitArgp * uvar.dorbitArgp;
       dopplerpos.ecc = uvar.orbitEcc + i_orbitEcc * uvar.dorbitEcc;
 
-      tic0 = tic = GETTIME();
+      blockDopplers[blockCount++] = dopplerpos;
+    }
+    if ( blockCount == 0 ) {
+      break;
+    }
+
+    tic0 = tic = GETTIME();
 
-      /* main function call: compute F-statistic for this template */
-      XLAL_CHECK_MAIN ( XLALComputeFstat ( &Fstat_res, GV.Fstat_in, &dopplerpos, GV.numFreqBins_FBand, GV.Fstat_what) == XLAL_SUCCESS, XLAL_EFUNC );
+    /* main function call: compute F-statistic for this block of templates */
+    XLAL_CHECK_MAIN ( compute_Fstat_block ( blockFstat_res, &GV, blockDopplers, blockCount ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-      toc = GETTIME();
-      timing.tauFstat += (toc - tic);   // pure Fstat-calculation time
+    toc = GETTIME();
+    timing.tauFstat += (toc - tic);   // pure Fstat-calculation time
+
+    for ( UINT4 iBlock = 0; iBlock < blockCount; ++iBlock ) {
+
+      dopplerpos = blockDopplers[iBlock];
+      const FstatResults *Fstat_res = blockFstat_res[iBlock];
 
       /* Progress meter */
       templateCounter += 1.0;
@@ -744,7 +791,11 @@ int main(int argc,char *argv[])
 
           /* compute Fstat map F_mn over {t0, tau} */
           tic = GETTIME();
-          XLAL_CHECK_MAIN ( (transientCand.FstatMap = XLALComputeTransientFstatMap ( thisFAtoms, GV.transientWindowRange, uvar.transient_useFReg)) != NULL, XLAL_EFUNC );
+          if ( uvar.transient_useCUDA ) {
+            XLAL_CHECK_MAIN ( (transientCand.FstatMap = XLALComputeTransientFstatMapCUDA ( thisFAtoms, GV.transientWindowRange, uvar.transient_useFReg)) != NULL, XLAL_EFUNC );
+          } else {
+            XLAL_CHECK_MAIN ( (transientCand.FstatMap = XLALComputeTransientFstatMapThreaded ( thisFAtoms, GV.transientWindowRange, uvar.transient_useFReg, uvar.transient_numThreads)) != NULL, XLAL_EFUNC );
+          }
           toc = GETTIME();
           timing.tauTransFstatMap += (toc - tic); // time to compute transient Fstat-map
 
@@ -802,15 +853,11 @@ int main(int argc,char *argv[])
 
       } // for ( iFreq < numFreqBins_FBand )
 
-      /* now measure total loop time per template */
-      toc = GETTIME();
-      timing.tauTemplate += (toc - tic0);
+    } // for ( iBlock < blockCount )
 
-    }
-    }
-    }
-    }
-    }
+    /* now measure total loop time per block of templates */
+    toc = GETTIME();
+    timing.tauTemplate += (toc - tic0);
 
   } /* while more Doppler positions to scan */
 
@@ -940,7 +987,11 @@ int main(int argc,char *argv[])
 
   /* Free memory */
   XLALDestroyDopplerFullScan ( GV.scanState);
-  XLALDestroyFstatResults ( Fstat_res );
+  for ( UINT4 iBlock = 0; iBlock < blockLength; ++iBlock ) {
+    XLALDestroyFstatResults ( blockFstat_res[iBlock] );
+  }
+  XLALFree ( blockFstat_res );
+  XLALFree ( blockDopplers );
 
   Freemem ( &GV );
 
@@ -1043,6 +1094,9 @@ initUserVars ( UserInput_t *uvar )
 
   uvar->transient_WindowType = XLALStringDuplicate ( "none" );
   uvar->transient_useFReg = 0;
+  uvar->transient_numThreads = 1;
+  uvar->numThreads = 1;
+  uvar->transient_useCUDA = 0;
   uvar->resampFFTPowerOf2 = FstatOptionalArgsDefaults.resampFFTPowerOf2;
   uvar->allowedMismatchFromSFTLength = 0;
   uvar->injectionSources = NULL;
@@ -1169,11 +1223,14 @@ initUserVars ( UserInput_t *uvar )
   XLALRegisterUvarMember(  maxBraking,      REAL8, 0,  DEVELOPER, "Maximum braking index for --gridType=9");
 
   XLALRegisterUvarMember(transient_useFReg,   	 BOOLEAN, 0,  DEVELOPER, "FALSE: use 'standard' e^F for marginalization, if TRUE: use e^FReg = (1/D)*e^F (BAD)");
+  XLALRegisterUvarMember(transient_numThreads,	 INT4, 0,  DEVELOPER, "TransientCW: Number of threads used to compute the transient F-statistic map (requires OpenMP)");
+  XLALRegisterUvarMember(transient_useCUDA,   	 BOOLEAN, 0,  DEVELOPER, "TransientCW: Compute the transient F-statistic map on a CUDA device");
 
   XLALRegisterUvarMember(outputTiming,         STRING, 0,  DEVELOPER, "Append timing measurements and parameters into this file");
   XLALRegisterUvarMember(outputFstatTiming,    STRING, 0,  DEVELOPER, "Append F-statistic timing measurements and parameters into this file");
 
   XLALRegisterUvarMember(resampFFTPowerOf2,  BOOLEAN, 0,  DEVELOPER, "For Resampling methods: enforce FFT length to be a power of two (by rounding up)" );
+  XLALRegisterUvarMember(numThreads,         INT4, 0,  DEVELOPER, "Number of threads to spread the template loop over for Demod methods, or the spindown+FFT loop over for Resampling methods (requires OpenMP). --outputFstatTiming only records the first thread");
 
   XLALRegisterUvarMember(allowedMismatchFromSFTLength, REAL8, 0, DEVELOPER, "Maximum allowed mismatch from SFTs being too long [Default: what's hardcoded in XLALFstatMaximumSFTLength]" );
 
@@ -1217,7 +1274,7 @@ InitFstat ( ConfigVariables *cfg, const UserInput_t *uvar )
   XLAL_CHECK ( chdir ( uvar->workingDir ) == 0, XLAL_EINVAL, "Unable to change directory to workinDir '%s'\n", uvar->workingDir );
 
   /* ----- set computational parameters for F-statistic from User-input ----- */
-  cfg->useResamp = ( uvar->FstatMethod >= FMETHOD_RESAMP_GENERIC ); // use resampling;
+  cfg->useResamp = XLALFstatMethodClassIsResamp ( uvar->FstatMethod ); // use resampling;
 
   /* check that resampling is compatible with gridType */
   if ( cfg->useResamp && uvar->gridType > GRID_SKY_LAST /* end-marker for factored grid types */ ) {
@@ -1501,10 +1558,38 @@ InitFstat ( ConfigVariables *cfg, const UserInput_t *uvar )
   optionalArgs.collectTiming = XLALUserVarWasSet ( &uvar->outputFstatTiming );
   optionalArgs.allowedMismatchFromSFTLength = uvar->allowedMismatchFromSFTLength;
 
+  /* Resamp computes a whole frequency band per template, so threads are best spent within each
+   * template (on the spindown+FFT loop); Demod templates are cheap, so threads share the template loop */
+  XLAL_CHECK ( uvar->numThreads >= 1, XLAL_EDOM, "ERROR: --numThreads must be >= 1" );
+  cfg->numThreads = 1;
+  if ( cfg->useResamp ) {
+    optionalArgs.resampNumThreads = uvar->numThreads;
+  } else {
+    cfg->numThreads = uvar->numThreads;
+  }
+#ifndef _OPENMP
+  if ( cfg->numThreads > 1 ) {
+    XLALPrintWarning ( "WARNING: Requested %d threads for the template loop, but lalapps was compiled without OpenMP; running serially\n", uvar->numThreads );
+    cfg->numThreads = 1;
+  }
+#endif
 
   XLAL_CHECK ( (cfg->Fstat_in = XLALCreateFstatInput( catalog, fCoverMin, fCoverMax, cfg->dFreq, cfg->ephemeris, &optionalArgs )) != NULL, XLAL_EFUNC );
   XLALDestroySFTCatalog(catalog);
 
+  /* each additional thread uses a 'timeslice' spanning all the data: it references the SFTs, detector states and
+   * noise weights of 'Fstat_in', but has its own sky-position buffers, so threads can compute F-statistics concurrently */
+  XLAL_CHECK ( (cfg->Fstat_in_thread = XLALCalloc ( cfg->numThreads, sizeof(cfg->Fstat_in_thread[0]) )) != NULL, XLAL_ENOMEM );
+  cfg->Fstat_in_thread[0] = cfg->Fstat_in;
+  if ( cfg->numThreads > 1 ) {
+    const LIGOTimeGPS minStartGPS = { 0, 0 };
+    const LIGOTimeGPS maxStartGPS = { LAL_INT4_MAX, 0 };
+    for ( UINT4 t = 1; t < cfg->numThreads; ++t ) {
+      XLAL_CHECK ( XLALFstatInputTimeslice ( &cfg->Fstat_in_thread[t], cfg->Fstat_in, &minStartGPS, &maxStartGPS ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+    XLALSinCosLUTInit();	// initialise the sin/cos lookup table of the Demod hotloops before threads race to do so
+  }
+
   cfg->Fstat_what = FSTATQ_2F;   // always calculate multi-detector 2F
   if ( XLALUserVarWasSet( &uvar->outputLoudest ) ) {
     cfg->Fstat_what |= FSTATQ_FAFB;   // also calculate Fa,b parts for parameter estimation
@@ -1572,6 +1657,8 @@ InitFstat ( ConfigVariables *cfg, const UserInput_t *uvar )
 
 
   /* ----- transient-window related parameters ----- */
+  XLAL_CHECK ( uvar->transient_numThreads >= 1, XLAL_EDOM, "ERROR: --transient-numThreads must be >= 1" );
+  XLAL_CHECK ( !uvar->transient_useCUDA || XLALTransientFstatMapCUDAIsAvailable(), XLAL_EINVAL, "ERROR: --transient-useCUDA requested, but CUDA is not available" );
   int twtype;
   XLAL_CHECK ( (twtype = XLALParseTransientWindowName ( uvar->transient_WindowType )) >= 0, XLAL_EFUNC );
   cfg->transientWindowRange.type = twtype;
@@ -1755,6 +1842,12 @@ Freemem( ConfigVariables *cfg )
   XLALDestroyUINT4Vector ( cfg->numSFTsPerDet );
   XLALDestroyStringVector ( cfg->detectorIDs );
 
+  if ( cfg->Fstat_in_thread ) {
+    for ( UINT4 t = 1; t < cfg->numThreads; ++t ) {
+      XLALDestroyFstatInput ( cfg->Fstat_in_thread[t] );
+    }
+    XLALFree ( cfg->Fstat_in_thread );
+  }
   XLALDestroyFstatInput ( cfg->Fstat_in );
 
   /* destroy FstatToplist if any */
@@ -2348,6 +2441,42 @@ write_TimingInfo ( const CHAR *fname, const timingInfo_t *ti, const ConfigVariab
 
 } /* write_TimingInfo() */
 
+/**
+ * Compute the F-statistic for a block of templates, spread over cfg->numThreads threads.
+ * Each thread computes a contiguous run of templates using its own view cfg->Fstat_in_thread[t] of the
+ * F-statistic input data, so that consecutive templates at the same sky position re-use its buffers;
+ * the results for template i are returned in Fstat_res[i], which is allocated if NULL.
+ */
+int
+compute_Fstat_block ( FstatResults **Fstat_res, const ConfigVariables *cfg, const PulsarDopplerParams *dopplers, const UINT4 numDopplers )
+{
+  XLAL_CHECK ( Fstat_res != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( cfg != NULL && cfg->Fstat_in_thread != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( dopplers != NULL, XLAL_EINVAL );
+
+  int errnum = XLAL_SUCCESS;
+#pragma omp parallel for schedule(static) num_threads(cfg->numThreads) if(cfg->numThreads > 1)
+  for ( UINT4 i = 0; i < numDopplers; ++i ) {
+#pragma omp flush(errnum)
+    if ( errnum != XLAL_SUCCESS ) {
+      continue;
+    }
+#ifdef _OPENMP
+    const int thread = omp_get_thread_num();
+#else
+    const int thread = 0;
+#endif
+    if ( XLALComputeFstat ( &Fstat_res[i], cfg->Fstat_in_thread[thread], &dopplers[i], cfg->numFreqBins_FBand, cfg->Fstat_what ) != XLAL_SUCCESS ) {
+#pragma omp critical(compute_Fstat_block_errnum)
+      errnum = XLAL_EFUNC;
+    }
+  }
+  XLAL_CHECK ( errnum == XLAL_SUCCESS, XLAL_EFUNC, "XLALComputeFstat() failed for a block of %u templates", numDopplers );
+
+  return XLAL_SUCCESS;
+
+} /* compute_Fstat_block() */
+
 /* Resize histogram */
 gsl_vector_int *resize_histogram(gsl_vector_int *old_hist, size_t size) {
   gsl_vector_int *new_hist = gsl_vector_int_alloc(size);
@@ -0,0 +1,42 @@
+## Benchmark suite of stable reference problems for the F-statistic methods
+## Run with 'make benchmark-Fstat'; writes the results of all problems in JSON format
+## to the file given as first argument (default: ComputeFstatBenchmark.json)
+
+set -e
+
+json="${1:-ComputeFstatBenchmark.json}"
+
+##---------- names of codes
+bench_code="lalapps_ComputeFstatBenchmark"
+
+## ---------- common parameters: fixed sky position, spindowns and random seed,
+## so that results are comparable between runs of the suite
+common_args="--Alpha=1.0 --Delta=0.5 --f1dot=-1e-10 --f2dot=0 --FreqResolution=0.5 --randSeed=1"
+
+## ---------- reference problems: name and arguments
+problems="Demod_narrowband Resamp_wideband Resamp_manyDetectors Resamp_manySegments"
+
+Demod_narrowband_args="--FstatMethod=DemodBest --IFOs=H1 --numSegments=1 --Tseg=86400 --Freq=100 --numFreqBins=200 --numTrials=3"
+Resamp_wideband_args="--FstatMethod=ResampBest --IFOs=H1 --numSegments=1 --Tseg=864000 --Freq=500 --numFreqBins=200000 --numTrials=3"
+Resamp_manyDetectors_args="--FstatMethod=ResampBest --IFOs=H1,L1,V1 --numSegments=1 --Tseg=259200 --Freq=200 --numFreqBins=20000 --numTrials=3"
+Resamp_manySegments_args="--FstatMethod=ResampBest --IFOs=H1,L1 --numSegments=30 --Tseg=86400 --Freq=200 --numFreqBins=5000 --numTrials=3"
+
+echo "[" > "${json}"
+sep=""
+for problem in ${problems}; do
+    eval "args=\"\${${problem}_args}\""
+    cmdline="${bench_code} ${common_args} ${args} --outputJSON=${problem}.json"
+    echo "$cmdline"
+    if ! eval "$cmdline"; then
+        echo "Error.. something failed when running '${bench_code}' for problem '${problem}' ..."
+        exit 1
+    fi
+    printf '%s{"problem": "%s", "results": ' "${sep}" "${problem}" >> "${json}"
+    cat "${problem}.json" >> "${json}"
+    printf '}\n' >> "${json}"
+    rm -f "${problem}.json"
+    sep=","
+done
+echo "]" >> "${json}"
+
+echo "Wrote F-statistic benchmark results to '${json}'"
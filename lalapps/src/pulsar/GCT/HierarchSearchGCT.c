@@ -48,8 +48,9 @@
 #ifdef GC_SSE2_OPT
 #include <gc_hotloop_sse2.h>
 #else
-#define ALRealloc LALRealloc
-#define ALFree LALFree
+#include "gc_hotloop.h"
+#define ALRealloc gc_hotloop_realloc
+#define ALFree gc_hotloop_free
 #endif
 
 /* ---------- Defines -------------------- */
@@ -370,6 +371,7 @@ int main( int argc, char *argv[]) {
 
   BOOLEAN uvar_recalcToplistStats = FALSE; 	/* Do additional analysis for all toplist candidates, output F, FXvector for postprocessing */
   BOOLEAN uvar_loudestSegOutput = FALSE; 	/* output extra info about loudest segment; requires recalcToplistStats */
+  INT4 uvar_numThreadsRecalc = 1;		/* number of threads used to recalculate the toplist statistics; requires recalcToplistStats */
 
   // ----- Line robust stats parameters ----------
   BOOLEAN uvar_computeBSGL = FALSE;          	/* In Fstat loop, compute line-robust statistic (BSGL=log10BSGL) using single-IFO F-stats */
@@ -532,6 +534,7 @@ int main( int argc, char *argv[]) {
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_Dterms,              "Dterms",              INT4,         0,   DEVELOPER,  "Number of kernel terms (single-sided) to use in\na) Dirichlet kernel if FstatMethod=Demod*\nb) sinc-interpolation kernel if FstatMethod=Resamp*" ) == XLAL_SUCCESS, XLAL_EFUNC);
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_DtermsRecalc,        "DtermsRecalc",        INT4,         0,   DEVELOPER,  "Same as 'Dterms', applies to 'Recalc' step" ) == XLAL_SUCCESS, XLAL_EFUNC);
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_skyPointIndex,       "skyPointIndex",       INT4,         0,   DEVELOPER,  "Only analyze this skypoint in grid" ) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_numThreadsRecalc,    "numThreadsRecalc",    INT4,         0,   DEVELOPER,  "Number of threads to spread the toplist candidates over when recalculating their statistics, for FstatMethodRecalc=Demod* (requires OpenMP; requires --recalcToplistStats)" ) == XLAL_SUCCESS, XLAL_EFUNC);
 
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_outputTiming,        "outputTiming",        STRING,       0,   DEVELOPER,  "Append timing information into this file") == XLAL_SUCCESS, XLAL_EFUNC);
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_outputTimingDetails, "outputTimingDetails", STRING,       0,   DEVELOPER,  "Append detailed averaged F-stat timing information to this file") == XLAL_SUCCESS, XLAL_EFUNC);
@@ -589,6 +592,11 @@ int main( int argc, char *argv[]) {
     return( HIERARCHICALSEARCH_EBAD );
   }
 
+  if ( uvar_numThreadsRecalc < 1 ) {
+    fprintf(stderr, "Invalid number of threads for recalculating the toplist statistics\n");
+    return( HIERARCHICALSEARCH_EBAD );
+  }
+
   if ( uvar_f3dotBand != 0 && ( !XLALUserVarWasSet(&uvar_gammaRefine) || !XLALUserVarWasSet(&uvar_gammaRefine) || uvar_gammaRefine != 1 || uvar_gamma2Refine != 1 )){
 	fprintf(stderr, "Search over 3rd spindown is available only with gammaRefine AND gamma2Refine manually set to 1!\n");
 	return( HIERARCHICALSEARCH_EVAL );
@@ -599,6 +607,13 @@ int main( int argc, char *argv[]) {
   REAL4 TwoFthreshold = 2.0 * uvar_ThrF;
 #endif
 
+#ifndef GC_SSE2_OPT
+  /* select the fine-grid summation hot loops for the fastest available instruction set */
+  GCHotloopFuncs hotloop;
+  gc_hotloop_select ( &hotloop );
+  LogPrintf ( LOG_DETAIL, "Using %s fine-grid summation hot loops\n", XLALSIMDInstructionSetName ( hotloop.iset ) );
+#endif
+
   if ( (uvar_SortToplist < 0) || (uvar_SortToplist >= SORTBY_LAST) ) {
     XLALPrintError ( "Invalid value %d specified for toplist sorting, must be within [0, %d]\n", uvar_SortToplist, SORTBY_LAST - 1 );
     return( HIERARCHICALSEARCH_EBAD );
@@ -1292,7 +1307,11 @@ int main( int argc, char *argv[]) {
           finegrid.freqmin_fg = freqmin_fg;
           finegrid.dfreq_fg = dfreq_fg;
           finegrid.freqlength = nfreqs_fg ;
+#ifdef GC_SSE2_OPT
 #define ALIGN_REAL4 4  /* 16 bytes / sizeof(REAL4) = 4 */
+#else
+#define ALIGN_REAL4 ( GC_HOTLOOP_ALIGNMENT / sizeof(REAL4) )  /* full-width aligned blocks for the runtime-selected hot loops */
+#endif
           finegrid.freqlengthAL = ALIGN_REAL4 * ((UINT4)ceil ( 1.0 * finegrid.freqlength / ALIGN_REAL4 ));
 
           /* fine-grid f1dot resolution */
@@ -1360,6 +1379,8 @@ int main( int argc, char *argv[]) {
              with malloc and realloc, but e.g. for 32 bit Linux this will NOT hold.
              Alternatives might be using (posix_)memalign under Linux.
              Windows ==>???
+             Without GC_SSE2_OPT, the arrays are allocated with gc_hotloop_realloc(), i.e. aligned to
+             GC_HOTLOOP_ALIGNMENT bytes, as required by the runtime-selected hot loops in gc_hotloop.h.
           */
 
           finegrid.nc = (FINEGRID_NC_T *)ALRealloc( finegrid.nc, finegrid.length * sizeof(FINEGRID_NC_T));
@@ -1646,54 +1667,28 @@ int main( int argc, char *argv[]) {
                   } /* for  X  */
                 }
 #else // GC_SSE2_OPT
-                for(UINT4 ifreq_fg=0; ifreq_fg < finegrid.freqlength; ifreq_fg++) {
-                  fgrid2F[0] += cgrid2F[0];
 #ifndef EXP_NO_NUM_COUNT
-                  fgridnc[0] += (TwoFthreshold < cgrid2F[0]);
-                  fgridnc++;
+                hotloop.sum_nc( fgrid2F, cgrid2F, fgridnc, TwoFthreshold, finegrid.freqlength );
+#else
+                hotloop.sum( fgrid2F, cgrid2F, finegrid.freqlength );
 #endif // EXP_NO_NUM_COUNT
-                  fgrid2F++;
-                  cgrid2F++;
-                }
                 if ( uvar_computeBSGL ) {
                   for (UINT4 X = 0; X < finegrid.numDetectors; X++) {
                     REAL4 * cgrid2FX = coarsegrid.TwoFX + CG_FX_INDEX(coarsegrid, X, k, U1idx);
                     REAL4 * fgrid2FX = finegrid.sumTwoFX + FG_FX_INDEX(finegrid, X, 0);
-                    for(UINT4 ifreq_fg=0; ifreq_fg < finegrid.freqlength; ifreq_fg++) {
-                      fgrid2FX[0] += cgrid2FX[0];
-                      fgrid2FX++;
-                      cgrid2FX++;
-                    }
+                    hotloop.sum( fgrid2FX, cgrid2FX, finegrid.freqlength );
                   }
                 }
 
-
                 if ( uvar_getMaxFperSeg ) {
-                  cgrid2F = coarsegrid.TwoF + CG_INDEX(coarsegrid, k, U1idx);
                   REAL4 * fgridMax2Fl = finegrid.maxTwoFl + FG_INDEX(finegrid, 0);
                   UINT4 * fgrid2FmaxIdx = finegrid.maxTwoFlIdx + FG_INDEX(finegrid, 0);
-                  int isLouder;
-                  for (UINT4 ifreq_fg=0; ifreq_fg < finegrid.freqlength; ifreq_fg++) {
-                    isLouder=(fgridMax2Fl[0] <= cgrid2F[0]);
-                    fgridMax2Fl[0] = fmaxf ( fgridMax2Fl[0], cgrid2F[0] );
-                    fgrid2FmaxIdx[0]= isLouder*k + (1-isLouder)*fgrid2FmaxIdx[0];
-                    fgridMax2Fl++;
-                    fgrid2FmaxIdx++;
-                    cgrid2F++;
-                  }
+                  hotloop.max( fgridMax2Fl, fgrid2FmaxIdx, cgrid2F, k, finegrid.freqlength );
                   for (UINT4 X = 0; X < finegrid.numDetectors; X++) {
                     REAL4 * cgrid2FX = coarsegrid.TwoFX + CG_FX_INDEX(coarsegrid, X, k, U1idx);
                     REAL4 * fgridMax2FXl = finegrid.maxTwoFXl + FG_FX_INDEX(finegrid, X, 0);
                     UINT4 * fgrid2FXmaxIdx = finegrid.maxTwoFXlIdx + FG_FX_INDEX(finegrid,X, 0);
-
-                    for(UINT4 ifreq_fg=0; ifreq_fg < finegrid.freqlength; ifreq_fg++) {
-                      isLouder=(fgridMax2FXl[0] <= cgrid2FX[0]);
-                      fgridMax2FXl[0] = fmaxf ( fgridMax2FXl[0], cgrid2FX[0] );
-                      fgrid2FXmaxIdx[0] = isLouder*k + (1-isLouder)*fgrid2FXmaxIdx[0];
-                      fgrid2FXmaxIdx++;
-                      fgridMax2FXl++;
-                      cgrid2FX++;
-                    }
+                    hotloop.max( fgridMax2FXl, fgrid2FXmaxIdx, cgrid2FX, k, finegrid.freqlength );
                   }
                 }
 #endif // GC_SSE2_OPT
@@ -1798,6 +1793,7 @@ int main( int argc, char *argv[]) {
     recalcParams.BSGLsetup		    = usefulParams.BSGLsetup;
     recalcParams.loudestSegOutput	= uvar_loudestSegOutput;
     recalcParams.computeBSGLtL		= uvar_getMaxFperSeg;
+    recalcParams.numThreads		= uvar_numThreadsRecalc;
     XLAL_CHECK ( XLAL_SUCCESS == XLALComputeExtraStatsForToplist ( semiCohToplist, &recalcParams ),
                  HIERARCHICALSEARCH_EXLAL, "XLALComputeExtraStatsForToplist() failed with xlalErrno = %d.\n\n", xlalErrno
                  );
@@ -180,8 +180,9 @@ extern "C" {
 
   /* macro to index FX array in the FineGrid structure
    * frequency/GCT U1 index MUST always be the innermost index
-   * NOTE!: this 2D array needs 16-byte aligned blocks of frequency-bins (one block per detector),
-   * therefore we need to use the special length field freqlengthAL (which is a multiple of 4xREAL4 bytes)
+   * NOTE!: this 2D array needs aligned blocks of frequency-bins (one block per detector; 16-byte aligned with
+   * GC_SSE2_OPT, GC_HOTLOOP_ALIGNMENT-byte aligned otherwise), therefore we need to use the special length field
+   * freqlengthAL (which is a multiple of 4xREAL4 bytes, or GC_HOTLOOP_ALIGNMENT bytes respectively)
    */
 #define FG_FX_INDEX(fg, iDet, iFreq)       \
   ( ( (iDet) * (fg).freqlengthAL ) + (iFreq) )
@@ -21,6 +21,7 @@
 /*---------- INCLUDES ----------*/
 #define __USE_ISOC99 1
 #include "RecalcToplistStats.h"
+#include <lal/SinCosLUT.h>
 
 /*---------- local DEFINES ----------*/
 #define TRUE (1==1)
@@ -32,9 +33,28 @@
 
 /*---------- internal types ----------*/
 
+/** Running sums over segments of the statistics of one candidate */
+typedef struct tagRecalcStatsSums {
+  REAL4 sumTwoF;				/**< multi-detector \f$ \mathcal{F} \f$-statistic, summed over segments */
+  REAL4 sumTwoFX[PULSAR_MAX_DETECTORS];		/**< single-detector \f$ \mathcal{F} \f$-statistics, summed over segments */
+  UINT4 numSegmentsX[PULSAR_MAX_DETECTORS];	/**< number of segments with data, per detector */
+  REAL4 maxTwoFXl[PULSAR_MAX_DETECTORS];	/**< single-detector \f$ \mathcal{F} \f$-statistics, maximized over segments */
+} RecalcStatsSums;
+
+/** A toplist candidate, as processed by XLALComputeExtraStatsForToplist() */
+typedef struct tagRecalcStatsCandidate {
+  PulsarDopplerParams doppler;			/**< sky position, frequency and fdot of the candidate */
+  UINT4 index;					/**< index of the candidate in the toplist */
+} RecalcStatsCandidate;
+
 /*---------- Global variables ----------*/
 
 /*---------- internal prototypes ----------*/
+static int RecalcStatsCompareCandidates ( const void *x, const void *y );
+static void RecalcStatsInit ( RecalcStatsComponents *recalcStats, RecalcStatsSums *sums, const UINT4 numDetectors );
+static int RecalcStatsAddSegment ( RecalcStatsComponents *recalcStats, RecalcStatsSums *sums, const FstatResults *Fstat_res, const UINT4 k, const RecalcStatsParams *recalcParams );
+static int RecalcStatsFinish ( RecalcStatsComponents *recalcStats, RecalcStatsSums *sums, const UINT4 numSegments, const RecalcStatsParams *recalcParams );
+static int RecalcStatsComputeSegment ( FstatResults **Fstat_res, FstatInput *Fstat_in, const PulsarDopplerParams *dopplers, const UINT4 numDopplers, const UINT4 numThreads );
 
 /*==================== FUNCTION DEFINITIONS ====================*/
 
@@ -60,82 +80,131 @@ int XLALComputeExtraStatsForToplist ( toplist_t *list,				/**< list of cancidate
   }
   XLAL_CHECK ( listEntryType != 0, XLAL_EBADLEN, "Unsupported entry type for input toplist! Supported types currently are: GCTtop, HoughFstat." );
 
-  /* set up temporary variables and structs */
-  PulsarDopplerParams XLAL_INIT_DECL(candidateDopplerParams); /* struct containing sky position, frequency and fdot for the current candidate */
   UINT4 X;
-
-  /* initialize doppler parameters */
-  candidateDopplerParams.refTime = recalcParams->refTimeGPS;  /* spin parameters in toplist refer to this refTime */
-
   UINT4 numDetectors = recalcParams->detectorIDs->length;
+  XLAL_CHECK ( numDetectors <= PULSAR_MAX_DETECTORS, XLAL_EINVAL, "Too many detectors: %d > %d.", numDetectors, PULSAR_MAX_DETECTORS );
+  UINT4 numSegments = recalcParams->Fstat_in_vec->length;
+  XLAL_CHECK ( recalcParams->startTstack && recalcParams->startTstack->length == numSegments, XLAL_EINVAL, "Need one segment start time per F-stat input." );
+
+  UINT4 numThreads = ( recalcParams->numThreads > 1 ) ? recalcParams->numThreads : 1;
+#ifndef _OPENMP
+  numThreads = 1;
+#endif
 
   UINT4 j;
   UINT4 numElements = list->elems;
-  /* loop over toplist: re-compute TwoF and TwoFX for all candidates (average over segments) */
+
+  RecalcStatsCandidate *candidates = NULL;
+  PulsarDopplerParams *segmentDopplers = NULL;
+  FstatResults **Fstat_res = NULL;
+  RecalcStatsComponents *recalcStats = NULL;
+  RecalcStatsSums *sums = NULL;
+  XLAL_CHECK ( (candidates = XLALCalloc ( numElements, sizeof(*candidates) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( (segmentDopplers = XLALCalloc ( numElements, sizeof(*segmentDopplers) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( (Fstat_res = XLALCalloc ( numElements, sizeof(*Fstat_res) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( (recalcStats = XLALCalloc ( numElements, sizeof(*recalcStats) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( (sums = XLALCalloc ( numElements, sizeof(*sums) )) != NULL, XLAL_ENOMEM );
+
+  /* get frequency, sky position, doppler parameters of all toplist candidates */
   for (j = 0; j < numElements; j++ )
     {
+      PulsarDopplerParams *candidateDopplerParams = &candidates[j].doppler;
+      candidates[j].index = j;
+      candidateDopplerParams->refTime = recalcParams->refTimeGPS;  /* spin parameters in toplist refer to this refTime */
 
-      void *elemV = NULL;
       if ( listEntryType == 1 ) {
         GCTtopOutputEntry *elem = toplist_elem ( list, j );
-        elemV = elem;
-
-        /* get frequency, sky position, doppler parameters from toplist candidate and save to dopplerParams */
-        candidateDopplerParams.Alpha = elem->Alpha;
-        candidateDopplerParams.Delta = elem->Delta;
-        candidateDopplerParams.fkdot[0] = elem->Freq;
-        candidateDopplerParams.fkdot[1] = elem->F1dot;
-        candidateDopplerParams.fkdot[2] = elem->F2dot;
+
+        candidateDopplerParams->Alpha = elem->Alpha;
+        candidateDopplerParams->Delta = elem->Delta;
+        candidateDopplerParams->fkdot[0] = elem->Freq;
+        candidateDopplerParams->fkdot[1] = elem->F1dot;
+        candidateDopplerParams->fkdot[2] = elem->F2dot;
       }
       else if ( listEntryType == 2 ) {
         HoughFstatOutputEntry *elem = toplist_elem ( list, j );
-        elemV = elem;
 
         XLAL_CHECK ( (elem->sumTwoFX = XLALCreateREAL4Vector ( numDetectors )) != NULL, XLAL_EFUNC, "Failed call to XLALCreateREAL4Vector( %d ).", numDetectors );
 
-        /* get frequency, sky position, doppler parameters from toplist candidate and save to dopplerParams */
-        candidateDopplerParams.Alpha = elem->AlphaBest;
-        candidateDopplerParams.Delta = elem->DeltaBest;
-        candidateDopplerParams.fkdot[0] = elem->Freq;
-        candidateDopplerParams.fkdot[1] = elem->f1dot;
+        candidateDopplerParams->Alpha = elem->AlphaBest;
+        candidateDopplerParams->Delta = elem->DeltaBest;
+        candidateDopplerParams->fkdot[0] = elem->Freq;
+        candidateDopplerParams->fkdot[1] = elem->f1dot;
         /* no 2nd spindown in HoughFstatOutputEntry */
       } /* if listEntryType 2 */
 
-      /*  recalculate multi- and single-IFO Fstats for all segments for this candidate */
-      RecalcStatsComponents XLAL_INIT_DECL(recalcStats); /* struct containing multi-detector F-stat, single-detector F-stats, BSGL */
-      recalcStats.log10BSGL = -LAL_REAL4_MAX; /* proper initialization here is not 0 */
-      recalcStats.log10BSGLtL = -LAL_REAL4_MAX;
-      XLAL_CHECK ( XLALComputeExtraStatsSemiCoherent( &recalcStats, &candidateDopplerParams, recalcParams ) == XLAL_SUCCESS, XLAL_EFUNC, "Failed call to XLALComputeExtraStatsSemiCoherent()." );
+      recalcStats[j].log10BSGL = -LAL_REAL4_MAX; /* proper initialization here is not 0 */
+      recalcStats[j].log10BSGLtL = -LAL_REAL4_MAX;
+      RecalcStatsInit ( &recalcStats[j], &sums[j], numDetectors );
+    } /* for j < numElements */
+
+  /* process candidates at the same sky position consecutively, so that they share the sky-position buffers of the F-stat methods */
+  qsort ( candidates, numElements, sizeof(*candidates), RecalcStatsCompareCandidates );
+
+  /* recalculate multi- and single-IFO Fstats of all candidates, one segment at a time */
+  for (UINT4 k = 0; k < numSegments; k++ )
+    {
+      for (j = 0; j < numElements; j++ )
+        {
+          /* extrapolate pulsar spins to the starttime of the segment */
+          const PulsarDopplerParams *candidateDopplerParams = &candidates[j].doppler;
+          segmentDopplers[j] = *candidateDopplerParams;
+          segmentDopplers[j].refTime = recalcParams->startTstack->data[k];
+          REAL8 deltaTau = XLALGPSDiff( &segmentDopplers[j].refTime, &candidateDopplerParams->refTime );
+          XLAL_CHECK ( XLALExtrapolatePulsarSpins( segmentDopplers[j].fkdot, candidateDopplerParams->fkdot, deltaTau ) == XLAL_SUCCESS, XLAL_EFUNC, "XLALExtrapolatePulsarSpins() failed." );
+        }
+
+      XLAL_CHECK ( RecalcStatsComputeSegment ( Fstat_res, recalcParams->Fstat_in_vec->data[k], segmentDopplers, numElements, numThreads ) == XLAL_SUCCESS, XLAL_EFUNC, "Failed to recompute F-stats for segment k=%d.", k );
+
+      for (j = 0; j < numElements; j++ )
+        {
+          XLAL_CHECK ( RecalcStatsAddSegment ( &recalcStats[j], &sums[j], Fstat_res[j], k, recalcParams ) == XLAL_SUCCESS, XLAL_EFUNC );
+        }
+    } /* for k < numSegments */
+
+  /* save values in toplist */
+  for (j = 0; j < numElements; j++ )
+    {
+      const RecalcStatsComponents *stats = &recalcStats[j];
+      XLAL_CHECK ( RecalcStatsFinish ( &recalcStats[j], &sums[j], numSegments, recalcParams ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-      /* save values in toplist */
       if ( listEntryType == 1 ) {
-          GCTtopOutputEntry *elem = elemV;
+          GCTtopOutputEntry *elem = toplist_elem ( list, candidates[j].index );
           elem->numDetectors = numDetectors;
-          elem->avTwoFrecalc = recalcStats.avTwoF; /* average over segments */
+          elem->avTwoFrecalc = stats->avTwoF; /* average over segments */
           for ( X = 0; X < numDetectors; X ++ ) {
-            elem->avTwoFXrecalc[X] = recalcStats.avTwoFX[X];
+            elem->avTwoFXrecalc[X] = stats->avTwoFX[X];
           }
-          elem->log10BSGLrecalc = recalcStats.log10BSGL;
-          elem->log10BSGLtLrecalc = recalcStats.log10BSGLtL;
+          elem->log10BSGLrecalc = stats->log10BSGL;
+          elem->log10BSGLtLrecalc = stats->log10BSGLtL;
           if ( recalcParams->loudestSegOutput ) {
-            elem->loudestSeg      = recalcStats.loudestSeg;
-            elem->twoFloudestSeg  = recalcStats.twoFloudestSeg;
+            elem->loudestSeg      = stats->loudestSeg;
+            elem->twoFloudestSeg  = stats->twoFloudestSeg;
             for ( X = 0; X < numDetectors; X ++ ) {
-              elem->twoFXloudestSeg[X] = recalcStats.twoFXloudestSeg[X];
+              elem->twoFXloudestSeg[X] = stats->twoFXloudestSeg[X];
             }
           }
       } /* if ( listEntryType == 1 ) */
       else if ( listEntryType == 2 ) {
-          HoughFstatOutputEntry *elem = elemV;
+          HoughFstatOutputEntry *elem = toplist_elem ( list, candidates[j].index );
 
-          elem->sumTwoF = recalcStats.avTwoF; /* this is also the average over segments, the field is only called "sumTwoF" due to Hough legacy */
+          elem->sumTwoF = stats->avTwoF; /* this is also the average over segments, the field is only called "sumTwoF" due to Hough legacy */
           for ( X = 0; X < numDetectors; X ++ ) {
-            elem->sumTwoFX->data[X]  = recalcStats.avTwoFX[X];
+            elem->sumTwoFX->data[X]  = stats->avTwoFX[X];
           }
       } /* if ( listEntryType == 2 ) */
 
     } /* for j < numElements */
 
+  for (j = 0; j < numElements; j++ ) {
+    XLALDestroyFstatResults ( Fstat_res[j] );
+  }
+  XLALFree ( Fstat_res );
+  XLALFree ( segmentDopplers );
+  XLALFree ( candidates );
+  XLALFree ( recalcStats );
+  XLALFree ( sums );
+
   return (XLAL_SUCCESS);
 
 } /* XLALComputeExtraStatsForToplist() */
@@ -156,15 +225,11 @@ int XLALComputeExtraStatsSemiCoherent ( RecalcStatsComponents *recalcStats,		/**
 
   UINT4 numSegments  = recalcParams->Fstat_in_vec->length;
   UINT4 numDetectors = recalcParams->detectorIDs->length;
+  XLAL_CHECK ( numDetectors <= PULSAR_MAX_DETECTORS, XLAL_EINVAL, "Too many detectors: %d > %d.", numDetectors, PULSAR_MAX_DETECTORS );
 
-  recalcStats->numDetectors = numDetectors;
-
-  /* variables necessary to catch segments where not all detectors have data */
-  INT4 detid = -1; /* count through detector IDs for matching with name strings */
-  UINT4 numSegmentsX[numDetectors];  /* number of segments with data might be different for each detector */
-  for (UINT4 X = 0; X < numDetectors; X++) {
-    numSegmentsX[X] = 0;
-  }
+  /* just in case the caller hasn't properly initialized recalcStats, make sure everything is 0 before the loop */
+  RecalcStatsSums sums;
+  RecalcStatsInit ( recalcStats, &sums, numDetectors );
 
   /* internal dopplerParams structure, for extrapolating to correct reftimes for each segment */
   PulsarDopplerParams XLAL_INIT_DECL(dopplerParams_temp); /* struct containing sky position, frequency and fdot for the current candidate */
@@ -172,17 +237,6 @@ int XLALComputeExtraStatsSemiCoherent ( RecalcStatsComponents *recalcStats,		/**
   dopplerParams_temp.Delta = dopplerParams->Delta;
   XLAL_INIT_MEM( dopplerParams_temp.fkdot );
 
-  /* just in case the caller hasn't properly initialized recalcStats, make sure everything is 0 before the loop */
-  REAL4 sumTwoF = 0.0;
-  REAL4 sumTwoFX[numDetectors];
-  for (UINT4 X = 0; X < numDetectors; X++) {
-    sumTwoFX[X] = 0.0;
-    recalcStats->twoFXloudestSeg[X] = 0.0;
-  }
-  recalcStats->twoFloudestSeg = 0.0;
-  REAL4 maxTwoFXl[PULSAR_MAX_DETECTORS]; // max single-IFO Fstat-value, maximized over all segments
-  XLAL_INIT_MEM ( maxTwoFXl );
-
   /* compute single- and multi-detector Fstats for each data segment and sum up */
   FstatResults* Fstat_res = NULL;
   for (UINT4 k = 0; k < numSegments; k++)
@@ -198,82 +252,203 @@ int XLALComputeExtraStatsSemiCoherent ( RecalcStatsComponents *recalcStats,		/**
       /* recompute multi-detector Fstat and atoms */
       XLAL_CHECK ( XLALComputeFstat(&Fstat_res, recalcParams->Fstat_in_vec->data[k], &dopplerParams_temp, 1, FSTATQ_2F | FSTATQ_2F_PER_DET) == XLAL_SUCCESS, XLAL_EFUNC, "XLALComputeFstat() failed with errno=%d", xlalErrno );
 
-      sumTwoF  += Fstat_res->twoF[0]; /* sum up multi-detector Fstat for this segment*/
+      XLAL_CHECK ( RecalcStatsAddSegment ( recalcStats, &sums, Fstat_res, k, recalcParams ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-      BOOLEAN update_loudest = FALSE;
-      BOOLEAN updated_twoFXloudestSeg[numDetectors];
-      if ( recalcParams->loudestSegOutput && ( Fstat_res->twoF[0] > recalcStats->twoFloudestSeg ) )
-        {
-          update_loudest = TRUE;
-          recalcStats->loudestSeg = k;
-          recalcStats->twoFloudestSeg = Fstat_res->twoF[0];
-          for (UINT4 Y = 0; Y < numDetectors; Y++) {
-            updated_twoFXloudestSeg[Y] = FALSE;
-          }
+    } /* for k < numSegments */
+
+  XLAL_CHECK ( RecalcStatsFinish ( recalcStats, &sums, numSegments, recalcParams ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  XLALDestroyFstatResults(Fstat_res);
+
+  return(XLAL_SUCCESS);
+
+} /* XLALComputeExtraStatsSemiCoherent() */
+
+
+/** Order toplist candidates by sky position, then by their index in the toplist */
+static int RecalcStatsCompareCandidates ( const void *x, const void *y )
+{
+  const RecalcStatsCandidate *cx = (const RecalcStatsCandidate *) x;
+  const RecalcStatsCandidate *cy = (const RecalcStatsCandidate *) y;
+  if ( cx->doppler.Alpha != cy->doppler.Alpha ) {
+    return ( cx->doppler.Alpha < cy->doppler.Alpha ) ? -1 : 1;
+  }
+  if ( cx->doppler.Delta != cy->doppler.Delta ) {
+    return ( cx->doppler.Delta < cy->doppler.Delta ) ? -1 : 1;
+  }
+  if ( cx->index != cy->index ) {
+    return ( cx->index < cy->index ) ? -1 : 1;
+  }
+  return 0;
+} /* RecalcStatsCompareCandidates() */
+
+
+/** Reset the loudest-segment statistics of a candidate and its running sums over segments */
+static void RecalcStatsInit ( RecalcStatsComponents *recalcStats,	/**< [out] structure containing multi TwoF, single TwoF, BSGL */
+			      RecalcStatsSums *sums,			/**< [out] running sums over segments */
+			      const UINT4 numDetectors			/**< number of detectors */
+			    )
+{
+  recalcStats->numDetectors = numDetectors;
+  recalcStats->twoFloudestSeg = 0.0;
+  XLAL_INIT_MEM ( recalcStats->twoFXloudestSeg );
+  XLAL_INIT_MEM ( (*sums) );
+} /* RecalcStatsInit() */
+
+
+/** Add the multi- and single-IFO F-stats of segment k of a candidate to its running sums over segments */
+static int RecalcStatsAddSegment ( RecalcStatsComponents *recalcStats,		/**< [in/out] structure containing multi TwoF, single TwoF, BSGL */
+				   RecalcStatsSums *sums,			/**< [in/out] running sums over segments */
+				   const FstatResults *Fstat_res,		/**< F-stats of the candidate in segment k */
+				   const UINT4 k,				/**< segment index */
+				   const RecalcStatsParams *recalcParams	/**< additional input values and parameters */
+				 )
+{
+  const UINT4 numDetectors = recalcStats->numDetectors;
+
+  sums->sumTwoF  += Fstat_res->twoF[0]; /* sum up multi-detector Fstat for this segment*/
+
+  BOOLEAN update_loudest = FALSE;
+  BOOLEAN updated_twoFXloudestSeg[numDetectors];
+  if ( recalcParams->loudestSegOutput && ( Fstat_res->twoF[0] > recalcStats->twoFloudestSeg ) )
+    {
+      update_loudest = TRUE;
+      recalcStats->loudestSeg = k;
+      recalcStats->twoFloudestSeg = Fstat_res->twoF[0];
+      for (UINT4 Y = 0; Y < numDetectors; Y++) {
+        updated_twoFXloudestSeg[Y] = FALSE;
+      }
+    }
+
+  /* for each segment, number of detectors with data might be smaller than overall number */
+  const UINT4 numDetectorsSeg = Fstat_res->numDetectors;
+
+  /* get single-detector Fstats, with correct detector matching in case of single-IFO segments */
+  for (UINT4 X = 0; X < numDetectorsSeg; X++)
+    {
+
+      /* match detector ID in this segment to one from detectorIDs list, sum up the corresponding twoFX */
+      INT4 detid = -1;
+      for (UINT4 Y = 0; Y < numDetectors; Y++) {
+        if ( strcmp( Fstat_res->detectorNames[X], recalcParams->detectorIDs->data[Y] ) == 0 ) {
+          detid = Y;
         }
+      }
 
-      /* for each segment, number of detectors with data might be smaller than overall number */
-      const UINT4 numDetectorsSeg = Fstat_res->numDetectors;
+      XLAL_CHECK ( detid != -1, XLAL_EFAILED, "For segment k=%d, detector X=%d, could not match detector ID %s.", k, X, Fstat_res->detectorNames[X] );
 
-      /* get single-detector Fstats, with correct detector matching in case of single-IFO segments */
-      for (UINT4 X = 0; X < numDetectorsSeg; X++)
-        {
+      sums->numSegmentsX[detid] += 1; /* have to keep this for correct averaging */
 
-          /* match detector ID in this segment to one from detectorIDs list, sum up the corresponding twoFX */
-          detid = -1;
-          for (UINT4 Y = 0; Y < numDetectors; Y++) {
-            if ( strcmp( Fstat_res->detectorNames[X], recalcParams->detectorIDs->data[Y] ) == 0 ) {
-              detid = Y;
-            }
-          }
+      sums->sumTwoFX[detid] += Fstat_res->twoFPerDet[X][0]; /* sum up single-detector Fstat for this segment*/
 
-          XLAL_CHECK ( detid != -1, XLAL_EFAILED, "For segment k=%d, detector X=%d, could not match detector ID %s.", k, X, Fstat_res->detectorNames[X] );
+      if ( update_loudest ) {
+        recalcStats->twoFXloudestSeg[detid] = Fstat_res->twoFPerDet[X][0];
+        updated_twoFXloudestSeg[detid] = TRUE;
+      }
 
-          numSegmentsX[detid] += 1; /* have to keep this for correct averaging */
+      sums->maxTwoFXl[detid] = fmaxf ( sums->maxTwoFXl[detid], Fstat_res->twoFPerDet[X][0] );
 
-          sumTwoFX[detid] += Fstat_res->twoFPerDet[X][0]; /* sum up single-detector Fstat for this segment*/
+    } /* for X < numDetectorsSeg */
 
-          if ( update_loudest ) {
-            recalcStats->twoFXloudestSeg[detid] = Fstat_res->twoFPerDet[X][0];
-            updated_twoFXloudestSeg[detid] = TRUE;
-          }
+  /* need to overwrite the twoFXloudestSeg when not all detectors have data in the loudest segment */
+  if ( update_loudest )
+    {
+      for (UINT4 Y = 0; Y < numDetectors; Y++) {
+        if ( !updated_twoFXloudestSeg[Y] ) {
+          recalcStats->twoFXloudestSeg[Y] = 0.0;
+        }
+      }
+    } /* if ( update_loudest ) */
 
-          maxTwoFXl[detid] = fmaxf ( maxTwoFXl[detid], Fstat_res->twoFPerDet[X][0] );
+  return XLAL_SUCCESS;
 
-        } /* for X < numDetectorsSeg */
+} /* RecalcStatsAddSegment() */
 
-      /* need to overwrite the twoFXloudestSeg when not all detectors have data in the loudest segment */
-      if ( update_loudest )
-        {
-          for (UINT4 Y = 0; Y < numDetectors; Y++) {
-            if ( !updated_twoFXloudestSeg[Y] ) {
-              recalcStats->twoFXloudestSeg[Y] = 0.0;
-            }
-          }
-        } /* if ( update_loudest ) */
 
-    } /* for k < numSegments */
+/** Compute the line-robust statistics and average F-stats of a candidate from its running sums over all segments */
+static int RecalcStatsFinish ( RecalcStatsComponents *recalcStats,	/**< [in/out] structure containing multi TwoF, single TwoF, BSGL */
+			       RecalcStatsSums *sums,			/**< [in] running sums over all segments */
+			       const UINT4 numSegments,			/**< number of segments */
+			       const RecalcStatsParams *recalcParams	/**< additional input values and parameters */
+			     )
+{
+  const UINT4 numDetectors = recalcStats->numDetectors;
 
   if ( recalcParams->BSGLsetup )
     {
-      recalcStats->log10BSGL = XLALComputeBSGL ( sumTwoF, sumTwoFX, recalcParams->BSGLsetup );
+      recalcStats->log10BSGL = XLALComputeBSGL ( sums->sumTwoF, sums->sumTwoFX, recalcParams->BSGLsetup );
       XLAL_CHECK ( xlalErrno == 0, XLAL_EFUNC, "XLALComputeBSGL() failed with xlalErrno = %d\n", xlalErrno );
 
       if ( recalcParams->computeBSGLtL )
         {
-          recalcStats->log10BSGLtL  = XLALComputeBSGLtL ( sumTwoF, sumTwoFX, maxTwoFXl, recalcParams->BSGLsetup );
+          recalcStats->log10BSGLtL  = XLALComputeBSGLtL ( sums->sumTwoF, sums->sumTwoFX, sums->maxTwoFXl, recalcParams->BSGLsetup );
           XLAL_CHECK ( xlalErrno == 0, XLAL_EFUNC, "XLALComputeBSGLtL() failed with xlalErrno = %d\n", xlalErrno );
         }
     } // if BSGLsetup != NULL
 
   /* get average stats over all segments */
-  recalcStats->avTwoF = sumTwoF/numSegments;
+  recalcStats->avTwoF = sums->sumTwoF/numSegments;
   for (UINT4 X = 0; X < numDetectors; X++) {
-    recalcStats->avTwoFX[X] = sumTwoFX[X]/numSegmentsX[X];
+    recalcStats->avTwoFX[X] = sums->sumTwoFX[X]/sums->numSegmentsX[X];
   }
 
-  XLALDestroyFstatResults(Fstat_res);
+  return XLAL_SUCCESS;
 
-  return(XLAL_SUCCESS);
+} /* RecalcStatsFinish() */
 
-} /* XLALComputeExtraStatsSemiCoherent() */
+
+/**
+ * Recompute multi- and single-IFO F-stats of a batch of candidates in one segment.
+ * For Demod methods, the batch is split into contiguous runs of candidates spread over numThreads threads,
+ * each with its own timeslice of the F-stat input spanning all its data: the timeslice references the SFTs,
+ * detector states and noise weights of Fstat_in, but has its own sky-position buffers. Resamp methods,
+ * whose buffers cannot be split this way, compute the batch serially.
+ */
+static int RecalcStatsComputeSegment ( FstatResults **Fstat_res,		/**< [in/out] F-stats of each candidate; any NULL are allocated here */
+				       FstatInput *Fstat_in,			/**< F-stat input data of the segment */
+				       const PulsarDopplerParams *dopplers,	/**< parameters of each candidate, at the starttime of the segment */
+				       const UINT4 numDopplers,			/**< number of candidates */
+				       const UINT4 numThreads			/**< maximum number of threads */
+				     )
+{
+  const FstatQuantities whatToCompute = FSTATQ_2F | FSTATQ_2F_PER_DET;
+
+  UINT4 numSlices = ( numThreads < numDopplers ) ? numThreads : numDopplers;
+  if ( numSlices > 1 && strncmp ( XLALGetFstatInputMethodName ( Fstat_in ), "Demod", 5 ) != 0 ) {
+    numSlices = 1;
+  }
+  if ( numSlices <= 1 ) {
+    XLAL_CHECK ( XLALComputeFstatBatch ( Fstat_res, Fstat_in, dopplers, numDopplers, 1, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC, "XLALComputeFstatBatch() failed with errno=%d", xlalErrno );
+    return XLAL_SUCCESS;
+  }
+
+  /* thread 0 uses Fstat_in itself */
+  FstatInput *slices[numSlices];
+  const LIGOTimeGPS minStartGPS = { 0, 0 };
+  const LIGOTimeGPS maxStartGPS = { LAL_INT4_MAX, 0 };
+  slices[0] = Fstat_in;
+  for ( UINT4 t = 1; t < numSlices; ++t ) {
+    slices[t] = NULL;
+    XLAL_CHECK ( XLALFstatInputTimeslice ( &slices[t], Fstat_in, &minStartGPS, &maxStartGPS ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  XLALSinCosLUTInit();	// initialise the sin/cos lookup table of the Demod hotloops before threads race to do so
+
+  int errnum = XLAL_SUCCESS;
+#pragma omp parallel for schedule(static,1) num_threads(numSlices)
+  for ( UINT4 t = 0; t < numSlices; ++t ) {
+    const UINT4 start = ( (UINT8) t * numDopplers ) / numSlices;
+    const UINT4 end = ( (UINT8) ( t + 1 ) * numDopplers ) / numSlices;
+    if ( XLALComputeFstatBatch ( &Fstat_res[start], slices[t], &dopplers[start], end - start, 1, whatToCompute ) != XLAL_SUCCESS ) {
+#pragma omp critical(RecalcStatsComputeSegment_errnum)
+      errnum = XLAL_EFUNC;
+    }
+  }
+
+  for ( UINT4 t = 1; t < numSlices; ++t ) {
+    XLALDestroyFstatInput ( slices[t] );
+  }
+  XLAL_CHECK ( errnum == XLAL_SUCCESS, XLAL_EFUNC, "XLALComputeFstatBatch() failed for a batch of %u candidates", numDopplers );
+
+  return XLAL_SUCCESS;
+
+} /* RecalcStatsComputeSegment() */
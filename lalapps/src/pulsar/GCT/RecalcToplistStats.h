@@ -72,6 +72,7 @@ typedef struct tagRecalcStatsParams {
   BSGLSetup *BSGLsetup;			/**< pre-computed setup for line-robust statistic BSGL */
   BOOLEAN computeBSGLtL;		/**< re-compute BSGLtL as well, or not */
   BOOLEAN loudestSegOutput;		/**< return extra info about loudest segment */
+  UINT4 numThreads;			/**< number of threads to spread the candidates of each segment over, for Demod methods (requires OpenMP); 0 or 1 runs serially */
 } RecalcStatsParams;
 
 /*---------- exported Global variables ----------*/
@@ -0,0 +1,97 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "gc_hotloop.h"
+
+/**
+ * \file
+ * \ingroup lalapps_pulsar_GCT
+ * \brief Generic hot loops, and runtime selection of the fastest available hot loops
+ */
+
+/** Select the hot loop functions for the fastest instruction set supported by both the compiler and the executing machine */
+void gc_hotloop_select ( GCHotloopFuncs *funcs ) {
+
+  funcs->iset = LAL_SIMD_ISET_GEN;
+  funcs->sum_nc = gc_hotloop_sum_nc_GEN;
+  funcs->sum = gc_hotloop_sum_GEN;
+  funcs->max = gc_hotloop_max_GEN;
+
+#ifdef HAVE_AVX512F_COMPILER
+  if ( LAL_HAVE_AVX512F_RUNTIME() ) {
+    funcs->iset = LAL_SIMD_ISET_AVX512F;
+    funcs->sum_nc = gc_hotloop_sum_nc_AVX512;
+    funcs->sum = gc_hotloop_sum_AVX512;
+    funcs->max = gc_hotloop_max_AVX512;
+    return;
+  }
+#endif
+
+#ifdef HAVE_AVX2_COMPILER
+  if ( LAL_HAVE_AVX2_RUNTIME() ) {
+    funcs->iset = LAL_SIMD_ISET_AVX2;
+    funcs->sum_nc = gc_hotloop_sum_nc_AVX2;
+    funcs->sum = gc_hotloop_sum_AVX2;
+    funcs->max = gc_hotloop_max_AVX2;
+    return;
+  }
+#endif
+
+}
+
+/**
+ * (Re)allocate a fine-grid array aligned to GC_HOTLOOP_ALIGNMENT bytes.
+ * The fine-grid arrays are always re-initialised after allocation, so there
+ * is no need to keep the data: simply free() and allocate a new aligned block.
+ */
+void *gc_hotloop_realloc ( void *ptr, size_t size ) {
+  free ( ptr );
+  if ( posix_memalign ( &ptr, GC_HOTLOOP_ALIGNMENT, size ) != 0 ) {
+    return NULL;
+  }
+  return ptr;
+}
+
+/** Free a fine-grid array allocated with gc_hotloop_realloc() */
+void gc_hotloop_free ( void *ptr ) {
+  free ( ptr );
+}
+
+void gc_hotloop_sum_nc_GEN ( REAL4 *fgrid2F, const REAL4 *cgrid2F, UINT4 *fgridnc, REAL4 TwoFthreshold, UINT4 length ) {
+  for ( UINT4 i = 0; i < length; i++ ) {
+    fgrid2F[i] += cgrid2F[i];
+    fgridnc[i] += ( TwoFthreshold < cgrid2F[i] );
+  }
+}
+
+void gc_hotloop_sum_GEN ( REAL4 *fgrid2F, const REAL4 *cgrid2F, UINT4 length ) {
+  for ( UINT4 i = 0; i < length; i++ ) {
+    fgrid2F[i] += cgrid2F[i];
+  }
+}
+
+void gc_hotloop_max_GEN ( REAL4 *fgrid2Fmax, UINT4 *fgrid2FmaxIdx, const REAL4 *cgrid2F, UINT4 k, UINT4 length ) {
+  for ( UINT4 i = 0; i < length; i++ ) {
+    int isLouder = ( fgrid2Fmax[i] <= cgrid2F[i] );
+    fgrid2Fmax[i] = fmaxf ( fgrid2Fmax[i], cgrid2F[i] );
+    fgrid2FmaxIdx[i] = isLouder*k + (1-isLouder)*fgrid2FmaxIdx[i];
+  }
+}
@@ -0,0 +1,83 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+#ifndef _GC_HOTLOOP_H  /* Double-include protection. */
+#define _GC_HOTLOOP_H
+
+/**
+ * \file
+ * \ingroup lalapps_pulsar_GCT
+ * \brief Runtime-selected hot loops for the fine-grid 2F accumulation of HierarchSearchGCT
+ *
+ * The fine-grid arrays passed to these functions must be aligned to \c GC_HOTLOOP_ALIGNMENT bytes
+ * (as allocated by gc_hotloop_realloc()); the coarse-grid arrays may have any alignment.
+ */
+
+#include <stddef.h>
+
+#include <lal/LALAtomicDatatypes.h>
+#include <lal/LALSIMD.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+  /** Alignment in bytes of the fine-grid arrays, sufficient for full-width AVX-512 loads and stores */
+#define GC_HOTLOOP_ALIGNMENT 64
+
+  /** Add coarse-grid 2F values to the fine-grid sums, and count those above threshold */
+  typedef void (*gc_hotloop_sum_nc_t) ( REAL4 *fgrid2F, const REAL4 *cgrid2F, UINT4 *fgridnc, REAL4 TwoFthreshold, UINT4 length );
+
+  /** Add coarse-grid 2F values to the fine-grid sums */
+  typedef void (*gc_hotloop_sum_t) ( REAL4 *fgrid2F, const REAL4 *cgrid2F, UINT4 length );
+
+  /** Track the maximum coarse-grid 2F value over segments, and the (zero-based) segment index 'k' where it occurred */
+  typedef void (*gc_hotloop_max_t) ( REAL4 *fgrid2Fmax, UINT4 *fgrid2FmaxIdx, const REAL4 *cgrid2F, UINT4 k, UINT4 length );
+
+  /** Set of hot loop functions for a given SIMD instruction set */
+  typedef struct tagGCHotloopFuncs {
+    LAL_SIMD_ISET iset;                 /**< SIMD instruction set used by these functions */
+    gc_hotloop_sum_nc_t sum_nc;         /**< Sum 2F values and count those above threshold */
+    gc_hotloop_sum_t sum;               /**< Sum 2F values */
+    gc_hotloop_max_t max;               /**< Track maximum 2F values over segments */
+  } GCHotloopFuncs;
+
+  void gc_hotloop_select ( GCHotloopFuncs *funcs );
+  void *gc_hotloop_realloc ( void *ptr, size_t size );
+  void gc_hotloop_free ( void *ptr );
+
+  void gc_hotloop_sum_nc_GEN ( REAL4 *fgrid2F, const REAL4 *cgrid2F, UINT4 *fgridnc, REAL4 TwoFthreshold, UINT4 length );
+  void gc_hotloop_sum_GEN ( REAL4 *fgrid2F, const REAL4 *cgrid2F, UINT4 length );
+  void gc_hotloop_max_GEN ( REAL4 *fgrid2Fmax, UINT4 *fgrid2FmaxIdx, const REAL4 *cgrid2F, UINT4 k, UINT4 length );
+
+#ifdef HAVE_AVX2_COMPILER
+  void gc_hotloop_sum_nc_AVX2 ( REAL4 *fgrid2F, const REAL4 *cgrid2F, UINT4 *fgridnc, REAL4 TwoFthreshold, UINT4 length );
+  void gc_hotloop_sum_AVX2 ( REAL4 *fgrid2F, const REAL4 *cgrid2F, UINT4 length );
+  void gc_hotloop_max_AVX2 ( REAL4 *fgrid2Fmax, UINT4 *fgrid2FmaxIdx, const REAL4 *cgrid2F, UINT4 k, UINT4 length );
+#endif
+
+#ifdef HAVE_AVX512F_COMPILER
+  void gc_hotloop_sum_nc_AVX512 ( REAL4 *fgrid2F, const REAL4 *cgrid2F, UINT4 *fgridnc, REAL4 TwoFthreshold, UINT4 length );
+  void gc_hotloop_sum_AVX512 ( REAL4 *fgrid2F, const REAL4 *cgrid2F, UINT4 length );
+  void gc_hotloop_max_AVX512 ( REAL4 *fgrid2Fmax, UINT4 *fgrid2FmaxIdx, const REAL4 *cgrid2F, UINT4 k, UINT4 length );
+#endif
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif  /* Double-include protection. */
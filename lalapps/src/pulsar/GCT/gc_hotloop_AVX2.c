@@ -0,0 +1,79 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+#include <config.h>
+#include <math.h>
+
+#include <immintrin.h>
+
+#include "gc_hotloop.h"
+
+/**
+ * \file
+ * \ingroup lalapps_pulsar_GCT
+ * \brief AVX2 hot loops, 8 fine-grid points per register
+ */
+
+#if !defined(__AVX2__)
+#error "gc_hotloop_AVX2.c must be compiled with AVX2 support"
+#endif
+
+void gc_hotloop_sum_nc_AVX2 ( REAL4 *fgrid2F, const REAL4 *cgrid2F, UINT4 *fgridnc, REAL4 TwoFthreshold, UINT4 length ) {
+  const __m256 thr = _mm256_set1_ps ( TwoFthreshold );
+  UINT4 i = 0;
+  for ( ; i + 8 <= length; i += 8 ) {
+    const __m256 cg = _mm256_loadu_ps ( cgrid2F + i );   /* coarse grid values, possibly unaligned */
+    _mm256_store_ps ( fgrid2F + i, _mm256_add_ps ( _mm256_load_ps ( fgrid2F + i ), cg ) );
+    /* comparison mask is -1 where threshold < coarse grid value, so subtracting it increments the number count */
+    const __m256i above = _mm256_castps_si256 ( _mm256_cmp_ps ( thr, cg, _CMP_LT_OQ ) );
+    __m256i *nc = (__m256i *) ( fgridnc + i );
+    _mm256_store_si256 ( nc, _mm256_sub_epi32 ( _mm256_load_si256 ( nc ), above ) );
+  }
+  for ( ; i < length; i++ ) {
+    fgrid2F[i] += cgrid2F[i];
+    fgridnc[i] += ( TwoFthreshold < cgrid2F[i] );
+  }
+}
+
+void gc_hotloop_sum_AVX2 ( REAL4 *fgrid2F, const REAL4 *cgrid2F, UINT4 length ) {
+  UINT4 i = 0;
+  for ( ; i + 8 <= length; i += 8 ) {
+    _mm256_store_ps ( fgrid2F + i, _mm256_add_ps ( _mm256_load_ps ( fgrid2F + i ), _mm256_loadu_ps ( cgrid2F + i ) ) );
+  }
+  for ( ; i < length; i++ ) {
+    fgrid2F[i] += cgrid2F[i];
+  }
+}
+
+void gc_hotloop_max_AVX2 ( REAL4 *fgrid2Fmax, UINT4 *fgrid2FmaxIdx, const REAL4 *cgrid2F, UINT4 k, UINT4 length ) {
+  const __m256 vk = _mm256_castsi256_ps ( _mm256_set1_epi32 ( (int) k ) );
+  UINT4 i = 0;
+  for ( ; i + 8 <= length; i += 8 ) {
+    const __m256 cg = _mm256_loadu_ps ( cgrid2F + i );
+    const __m256 max = _mm256_load_ps ( fgrid2Fmax + i );
+    /* mask is set where previous maximum 2F is <= coarse grid value */
+    const __m256 louder = _mm256_cmp_ps ( max, cg, _CMP_LE_OQ );
+    _mm256_store_ps ( fgrid2Fmax + i, _mm256_blendv_ps ( max, cg, louder ) );
+    float *idx = (float *) ( fgrid2FmaxIdx + i );   /* segment indices are blended bitwise */
+    _mm256_store_ps ( idx, _mm256_blendv_ps ( _mm256_load_ps ( idx ), vk, louder ) );
+  }
+  for ( ; i < length; i++ ) {
+    int isLouder = ( fgrid2Fmax[i] <= cgrid2F[i] );
+    fgrid2Fmax[i] = fmaxf ( fgrid2Fmax[i], cgrid2F[i] );
+    fgrid2FmaxIdx[i] = isLouder*k + (1-isLouder)*fgrid2FmaxIdx[i];
+  }
+}
@@ -0,0 +1,78 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+#include <config.h>
+#include <math.h>
+
+#include <immintrin.h>
+
+#include "gc_hotloop.h"
+
+/**
+ * \file
+ * \ingroup lalapps_pulsar_GCT
+ * \brief AVX-512F hot loops, 16 fine-grid points per register
+ */
+
+#if !defined(__AVX512F__)
+#error "gc_hotloop_AVX512.c must be compiled with AVX-512F support"
+#endif
+
+void gc_hotloop_sum_nc_AVX512 ( REAL4 *fgrid2F, const REAL4 *cgrid2F, UINT4 *fgridnc, REAL4 TwoFthreshold, UINT4 length ) {
+  const __m512 thr = _mm512_set1_ps ( TwoFthreshold );
+  const __m512i one = _mm512_set1_epi32 ( 1 );
+  UINT4 i = 0;
+  for ( ; i + 16 <= length; i += 16 ) {
+    const __m512 cg = _mm512_loadu_ps ( cgrid2F + i );   /* coarse grid values, possibly unaligned */
+    _mm512_store_ps ( fgrid2F + i, _mm512_add_ps ( _mm512_load_ps ( fgrid2F + i ), cg ) );
+    const __mmask16 above = _mm512_cmp_ps_mask ( thr, cg, _CMP_LT_OQ );
+    const __m512i nc = _mm512_load_si512 ( fgridnc + i );
+    _mm512_store_si512 ( fgridnc + i, _mm512_mask_add_epi32 ( nc, above, nc, one ) );
+  }
+  for ( ; i < length; i++ ) {
+    fgrid2F[i] += cgrid2F[i];
+    fgridnc[i] += ( TwoFthreshold < cgrid2F[i] );
+  }
+}
+
+void gc_hotloop_sum_AVX512 ( REAL4 *fgrid2F, const REAL4 *cgrid2F, UINT4 length ) {
+  UINT4 i = 0;
+  for ( ; i + 16 <= length; i += 16 ) {
+    _mm512_store_ps ( fgrid2F + i, _mm512_add_ps ( _mm512_load_ps ( fgrid2F + i ), _mm512_loadu_ps ( cgrid2F + i ) ) );
+  }
+  for ( ; i < length; i++ ) {
+    fgrid2F[i] += cgrid2F[i];
+  }
+}
+
+void gc_hotloop_max_AVX512 ( REAL4 *fgrid2Fmax, UINT4 *fgrid2FmaxIdx, const REAL4 *cgrid2F, UINT4 k, UINT4 length ) {
+  const __m512i vk = _mm512_set1_epi32 ( (int) k );
+  UINT4 i = 0;
+  for ( ; i + 16 <= length; i += 16 ) {
+    const __m512 cg = _mm512_loadu_ps ( cgrid2F + i );
+    const __m512 max = _mm512_load_ps ( fgrid2Fmax + i );
+    /* mask is set where previous maximum 2F is <= coarse grid value */
+    const __mmask16 louder = _mm512_cmp_ps_mask ( max, cg, _CMP_LE_OQ );
+    _mm512_store_ps ( fgrid2Fmax + i, _mm512_mask_mov_ps ( max, louder, cg ) );
+    _mm512_store_si512 ( fgrid2FmaxIdx + i, _mm512_mask_mov_epi32 ( _mm512_load_si512 ( fgrid2FmaxIdx + i ), louder, vk ) );
+  }
+  for ( ; i < length; i++ ) {
+    int isLouder = ( fgrid2Fmax[i] <= cgrid2F[i] );
+    fgrid2Fmax[i] = fmaxf ( fgrid2Fmax[i], cgrid2F[i] );
+    fgrid2FmaxIdx[i] = isLouder*k + (1-isLouder)*fgrid2FmaxIdx[i];
+  }
+}
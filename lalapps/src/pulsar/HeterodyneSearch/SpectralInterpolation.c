@@ -33,6 +33,8 @@
 static LIGOTimeGPS empty_LIGOTimeGPS;
 static SFTConstraints empty_SFTConstraints;
 
+static int interpolate_sft( void *arg, size_t sftnum );
+
 int main( int argc, char **argv ){
 
   InputParams inputParams;
@@ -91,7 +93,6 @@ int main( int argc, char **argv ){
   LIGOTimeGPS maxEndTimeGPS = empty_LIGOTimeGPS;
   UINT4 segcount=0;
   CHAR outputFilename[FILENAME_MAXLEN];
-  EmissionTime emit, emitS, emitE;
   CHAR timefileTDB[FILENAME_MAXLEN], timefileTE405[FILENAME_MAXLEN], sunfile200[FILENAME_MAXLEN],
        earthfile200[FILENAME_MAXLEN],sunfile405[FILENAME_MAXLEN], earthfile405[FILENAME_MAXLEN],
        sunfile414[FILENAME_MAXLEN], earthfile414[FILENAME_MAXLEN], earthfile421[FILENAME_MAXLEN], sunfile421[FILENAME_MAXLEN];
@@ -318,6 +319,50 @@ int main( int argc, char **argv ){
 
   FILE *fpout[numpulsars];
 
+  /* set which ephemeris and time corrections are used for each source; pulsars which use the same */
+  /* ones share the Earth states computed for each SFT, held for the first of them */
+  EphemerisData *psredat[numpulsars];
+  TimeCorrectionData *psrtdat[numpulsars];
+  TimeCorrectionType psrttype[numpulsars];
+  UINT4 psrEarthIdx[numpulsars];
+  for (h=0; h<numpulsars;h++){
+    /* check the time correction and ephemeris types*/
+    if (PulsarCheckParam(pulparams[h], "UNITS")){
+      if (!strcmp(PulsarGetStringParam(pulparams[h], "UNITS"), "TDB")) {
+        psrtdat[h]=tdatTDB;
+        psrttype[h]=TIMECORRECTION_TDB;
+      }
+      else {
+        psrtdat[h]=tdatTE405;
+        psrttype[h]=TIMECORRECTION_TCB;
+      }
+    }
+    else{
+      psrttype[h]=TIMECORRECTION_ORIGINAL;
+      psrtdat[h]=NULL;
+    }
+
+    /* set up which ephemeris type is being used for this source */
+    if( PulsarCheckParam(pulparams[h], "EPHEM" ) ) {
+      if (!strcmp(PulsarGetStringParam(pulparams[h], "EPHEM"), "DE405")) { psredat[h]=edat405; }
+      else if (!strcmp(PulsarGetStringParam(pulparams[h], "EPHEM"), "DE421")) { psredat[h]=edat421; }
+      else if (!strcmp(PulsarGetStringParam(pulparams[h], "EPHEM"), "DE414")) { psredat[h]=edat414; }
+      else if (!strcmp(PulsarGetStringParam(pulparams[h], "EPHEM"), "DE200")) { psredat[h]=edat200; }
+      else { psredat[h] = edat405; } // default to DE405
+    }
+    else{
+      psredat[h]=edat405; /* default is that DE405 is used*/
+    }
+
+    psrEarthIdx[h] = h;
+    for (UINT4 k=0; k<h; k++){
+      if ( psredat[k] == psredat[h] && psrtdat[k] == psrtdat[h] && psrttype[k] == psrttype[h] ){
+        psrEarthIdx[h] = k;
+        break;
+      }
+    }
+  }
+
   /* --------------------------------------- */
   /* --- BIT THAT DOES THE INTERPOLATION --- */
   /* --------------------------------------- */
@@ -541,499 +586,56 @@ int main( int argc, char **argv ){
       }
     }
 
-    /* Loop through each SFT */
-    for (sftnum=0; sftnum<(SFTdat->length); sftnum++){
+    /* Interpolate each SFT in a separate task, processing together all pulsars in the band; */
+    /* the B_k values are written out afterwards, in the order in which the SFTs were loaded */
+    SplInterBatch batch;
+    batch.inputParams = &inputParams;
+    batch.splParams = &splParams;
+    batch.SFTdat = SFTdat;
+    batch.numpulsars = numpulsars;
+    batch.pulparams = pulparams;
+    batch.baryAlpha = baryAlpha;
+    batch.baryDelta = baryDelta;
+    batch.barydInv = barydInv;
+    batch.edat = psredat;
+    batch.tdat = psrtdat;
+    batch.ttype = psrttype;
+    batch.earthIdx = psrEarthIdx;
+    batch.bk = NULL;
+    if( numpulsars > 0 && (batch.bk = XLALCalloc(SFTdat->length*numpulsars, sizeof(*batch.bk))) == NULL ){
+      XLALPrintError("Error, allocating B_k memory.\n");
+      exit(1);
+    }
+    if( numpulsars > 0 && XLALThreadPoolRun( interpolate_sft, &batch, SFTdat->length ) != XLAL_SUCCESS ){
+      XLALPrintError("Error... failed to interpolate SFTs\n");
+      exit(1);
+    }
 
-      /* deltaf is the frequency bin separation, this is used in a lot of the calculations as */
-      /* deltaf = 1/(SFT length)*/
-      deltaf=SFTdat->data->deltaF;
-      REAL8 timestamp=0;
-      timestamp=XLALGPSGetREAL8(&SFTdat->data[sftnum].epoch);
+    deltaf=SFTdat->data->deltaF;
+    for (sftnum=0; sftnum<(SFTdat->length); sftnum++){
+      REAL8 timestamp=XLALGPSGetREAL8(&SFTdat->data[sftnum].epoch);
 
       for (h=0; h<numpulsars;h++){
-        /* Initialise variables that change for each SFT */
-        REAL8 InterpolatedImagValue=0., InterpolatedRealValue=0.,
-              UnnormalisedInterpolatedImagValue=0., UnnormalisedInterpolatedRealValue=0.,
-              AbsSquaredWeightSum=0;
-        INT4 datapoint=0;
-        EarthState earth, earthS, earthE;
-        REAL8 phaseShift = 0., fnew = 0., f1new = 0., sqrtf1new = 0.;
-        REAL8 tdt = 0.;
-        REAL8 tdtS = 0.;
-        REAL8 tdtE = 0.;
-        EphemerisData *edat=NULL;
-        TimeCorrectionData *tdat=NULL;
-        TimeCorrectionType ttype;
-        BarycenterInput baryInput, baryInputS, baryInputE;
-
-        /* ------ Barycenter routine ------ */
-
-        /* Timestamp needed in GPS format*/
-        XLALGPSSetREAL8( &baryInput.tgps, timestamp +  1./(2.*deltaf) );
-
-        /* set up location of detector */
-        baryInput.site.location[0] = splParams.detector.location[0]/LAL_C_SI;
-        baryInput.site.location[1] = splParams.detector.location[1]/LAL_C_SI;
-        baryInput.site.location[2] = splParams.detector.location[2]/LAL_C_SI;
-
-        baryInputE.site.location[0] = splParams.detector.location[0]/LAL_C_SI;
-        baryInputE.site.location[1] = splParams.detector.location[1]/LAL_C_SI;
-        baryInputE.site.location[2] = splParams.detector.location[2]/LAL_C_SI;
-
-        baryInputS.site.location[0] = splParams.detector.location[0]/LAL_C_SI;
-        baryInputS.site.location[1] = splParams.detector.location[1]/LAL_C_SI;
-        baryInputS.site.location[2] = splParams.detector.location[2]/LAL_C_SI;
-
-        /* get sky position and inverse distance from previously calculated values */
-        baryInput.delta = baryDelta[h];
-        baryInput.alpha = baryAlpha[h];
-        baryInput.dInv = barydInv[h];
-
-        baryInputE.delta = baryDelta[h];
-        baryInputE.alpha = baryAlpha[h];
-        baryInputE.dInv = barydInv[h];
-
-        baryInputS.delta = baryDelta[h];
-        baryInputS.alpha = baryAlpha[h];
-        baryInputS.dInv = barydInv[h];
-
-        /* check the time correction and ephemeris types*/
-        if (PulsarCheckParam(pulparams[h], "UNITS")){
-          if (!strcmp(PulsarGetStringParam(pulparams[h], "UNITS"), "TDB")) {
-            tdat=tdatTDB;
-            ttype=TIMECORRECTION_TDB;
-          }
-          else {
-            tdat=tdatTE405;
-            ttype=TIMECORRECTION_TCB;
-          }
-        }
-        else{
-          ttype=TIMECORRECTION_ORIGINAL;
-          tdat=NULL;
-        }
-
-        /* set up which ephemeris type is being used for this source */
-        if( PulsarCheckParam(pulparams[h], "EPHEM" ) ) {
-          if (!strcmp(PulsarGetStringParam(pulparams[h], "EPHEM"), "DE405")) { edat=edat405; }
-          else if (!strcmp(PulsarGetStringParam(pulparams[h], "EPHEM"), "DE421")) { edat=edat421; }
-          else if (!strcmp(PulsarGetStringParam(pulparams[h], "EPHEM"), "DE414")) { edat=edat414; }
-          else if (!strcmp(PulsarGetStringParam(pulparams[h], "EPHEM"), "DE200")) { edat=edat200; }
-          else { edat = edat405; } // default to DE405
-        }
-        else{
-          edat=edat405; /* default is that DE405 is used*/
-        }
-
-        /* Perform Barycentering Routine at middle of SFT, for calculation of phase shift and frequency */
-        XLALBarycenterEarthNew(&earth, &baryInput.tgps, edat, tdat, ttype);
-        XLALBarycenter(&emit, &baryInput, &earth);
-
-        /* Also perform Barycentering Routine at start and end of SFT, for calculation of frequency derivatives */
-
-        XLALGPSSetREAL8( &baryInputE.tgps, timestamp +  1./(deltaf) );
-        XLALGPSSetREAL8( &baryInputS.tgps, timestamp );
-
-        XLALBarycenterEarthNew(&earthE, &baryInputE.tgps, edat, tdat, ttype);
-        XLALBarycenterEarthNew(&earthS, &baryInputS.tgps, edat, tdat, ttype);
-
-        XLALBarycenter(&emitE, &baryInputE, &earthE);
-        XLALBarycenter(&emitS, &baryInputS, &earthS);
-
-        /* If the 'detector at barycenter' flag is set, then reset emit to appropriate values */
-        if (inputParams.baryFlag){
-          emit.tDot=1.;
-          emit.deltaT=0.;
-          emitS.tDot=1.;
-          emitS.deltaT=0.;
-          emitE.tDot=1.;
-          emitE.deltaT=0.;
-        }
+        const SplInterBk *bk = &batch.bk[sftnum*numpulsars + h];
 
-        REAL8 totaltDot = 0., totaltDotstart = 0.,totaltDotend = 0.;
-        REAL8 totaldeltaT = 0., totaldeltaTstart = 0.,totaldeltaTend = 0.;
-
-        /* Get binary pulsar corrections if source is a binary pulsar */
-        /* because XLALBinaryPulsarDeltaTNew only returns delta t, not tdot, we need to */
-        /* calculate above and below the start and end frequencies to find gradient. */
-
-        /* These are denoted for start(S)/end(E) and plus(P)/minus(M) 1 second.  */
-
-        if( PulsarCheckParam(pulparams[h], "BINARY") ){
-          BinaryPulsarInput binInputS, binInputM, binInputE, binInputSP, binInputSM, binInputEP, binInputEM;
-          BinaryPulsarOutput binOutputS, binOutputM, binOutputE, binOutputSP, binOutputSM, binOutputEP, binOutputEM;
-
-          /* set up times used for binary input */
-          binInputS.tb = timestamp + emitS.deltaT;
-          binInputE.tb = timestamp + 1./deltaf + emitE.deltaT;
-          binInputM.tb = timestamp + 1./(2.*deltaf) + emit.deltaT;
-
-          /* Make assumption that emitS, emitE earthS and earthE are constant over two seconds */
-          binInputSM.tb = timestamp + emitS.deltaT-1;
-          binInputSP.tb = timestamp + emitS.deltaT+1;
-          binInputEM.tb = timestamp + 1./deltaf + emitE.deltaT-1;
-          binInputEP.tb = timestamp + 1./deltaf + emitE.deltaT+1;
-
-          binInputS.earth = earthS;
-          binInputE.earth = earthE;
-          binInputM.earth = earth;
-
-          binInputSP.earth = earthS;
-          binInputEP.earth = earthE;
-          binInputSM.earth = earthS;
-          binInputEM.earth = earthE;
-
-          XLALBinaryPulsarDeltaTNew( &binOutputS, &binInputS, pulparams[h] );
-          XLALBinaryPulsarDeltaTNew( &binOutputE, &binInputE, pulparams[h] );
-          XLALBinaryPulsarDeltaTNew( &binOutputM, &binInputM, pulparams[h] );
-
-          XLALBinaryPulsarDeltaTNew( &binOutputSM, &binInputSM, pulparams[h] );
-          XLALBinaryPulsarDeltaTNew( &binOutputEM, &binInputEM, pulparams[h] );
-          XLALBinaryPulsarDeltaTNew( &binOutputSP, &binInputSP, pulparams[h] );
-          XLALBinaryPulsarDeltaTNew( &binOutputEP, &binInputEP, pulparams[h] );
-
-          /* Add the barycentering and binary terms together to get total deltat */
-          totaldeltaT = emit.deltaT + binOutputM.deltaT;
-          totaldeltaTstart = emitS.deltaT + binOutputS.deltaT;
-          totaldeltaTend = emitE.deltaT + binOutputE.deltaT;
-
-          /* Add the barycentering and binary terms together to get total tdot */
-          totaltDot = emit.tDot + (binOutputE.deltaT-binOutputS.deltaT)*deltaf;
-          totaltDotend = emitE.tDot + (binOutputEP.deltaT-binOutputEM.deltaT)/2;
-          totaltDotstart = emitS.tDot + (binOutputSP.deltaT-binOutputSM.deltaT)/2;
-        }
-        else{
-          /* If not a binary, then relative motion effects are only due to detector motion */
-          totaldeltaT = emit.deltaT;
-          totaldeltaTend = emitE.deltaT;
-          totaldeltaTstart = emitS.deltaT;
-
-          totaltDot = emit.tDot;
-          totaltDotend = emitE.tDot;
-          totaltDotstart = emitS.tDot;
-        }
-
-        /* Calculate relevant time difference to epoch for use in calculations */
-        REAL8 pepoch = PulsarGetREAL8ParamOrZero( pulparams[h], "PEPOCH" );
-        tdt=timestamp - pepoch + 1./(2.*deltaf) + totaldeltaT;
-        tdtS=timestamp - pepoch + totaldeltaTstart;
-        tdtE=timestamp - pepoch + 1./(2.*deltaf) + totaldeltaTend;
-
-        /* SFT start time - parfile epoch + 1/2 SFT length + barycentre timeshift */
-
-        fnew = 0., phaseShift = 0.;
-        REAL8 fstart = 0., fend = 0.;
-        REAL8 dtpow = 1., dtspow = 1., dtepow = 1.;
-        const REAL8Vector *freqs = PulsarGetREAL8VectorParam(pulparams[h], "F");
-        for ( UINT4 k=0; k<freqs->length; k++ ){
-          /* calculate frequency at the centre of the SFT */
-          fnew += (freqs->data[k]*dtpow)/gsl_sf_fact(k);
-          dtpow *= tdt;
-
-          /* calculate frequency at start of SFT */
-          fstart += (freqs->data[k]*dtspow)/gsl_sf_fact(k);
-          dtspow *= tdtS;
-
-          /* calculate frequency at end of SFT */
-          fend += (freqs->data[k]*dtepow)/gsl_sf_fact(k);
-          dtepow *= tdtE;
-
-          /* Calculate difference in phase between beginning of SFT and the epoch.  */
-          phaseShift += (freqs->data[k]*dtpow)/gsl_sf_fact(k+1);
-        }
-        fnew *= (inputParams.freqfactor*totaltDot);
-        fstart *= (inputParams.freqfactor*totaltDotstart);
-        fend *= (inputParams.freqfactor*totaltDotend);
-        phaseShift = LAL_TWOPI*fmod(inputParams.freqfactor*phaseShift, 1.);
-
-        if((fnew < inputParams.startF) || (fnew > inputParams.endF)){
+        if( bk->status == SPLINTER_BK_OUT_OF_RANGE ){
           fprintf(stderr,"Pulsar %s has frequency %.4f outside of the frequency range %f-%f at time %.0f\n",
-              PulsarGetStringParam(pulparams[h], "NAME"), fnew, inputParams.startF, inputParams.endF, timestamp);
+              PulsarGetStringParam(pulparams[h], "NAME"), bk->fnew, inputParams.startF, inputParams.endF, timestamp);
           continue;
         }
-
-        /* calculate effective fdot including the frequency derivative obtained from the barycentering */
-        f1new= (fend - fstart)*deltaf;
-
-        sqrtf1new = sqrt(fabs(f1new)); /* square root of the absolute value of f1 for use in calculations */
-        REAL8 signf1new = f1new/fabs(f1new); /* sign of f1 for use in calculations */
-
-        UINT4 dataLength = 0, dpNum = 0;
-
-        /* Load data into RAM as will be reusing multiple times */
-        dataLength = (UINT4)(ROUND((fnew+inputParams.bandwidth/2.-SFTdat->data->f0)/deltaf
-                          -(fnew-inputParams.bandwidth/2.-SFTdat->data->f0)/deltaf));
-
-        /* check data load */
-        if(dataLength<1){
+        if( bk->status == SPLINTER_BK_NO_DATA ){
           XLALPrintError("Error setting length of data");
           continue;
         }
 
-        /* initialise and create various vectors for use in calculations */
-        REAL8Vector *dataFreqs = NULL, *ReDp = NULL, *ImDp = NULL, *ReMu = NULL, *ImMu = NULL, *MuMu = NULL;
-        UINT4Vector *dpUsed = NULL;
-
-        if( ((dataFreqs = XLALCreateREAL8Vector(dataLength)) == NULL ) || /* datapoint frequency value*/
-          ((ReDp = XLALCreateREAL8Vector(dataLength)) == NULL ) || /* Data Real Value*/
-          ((ImDp = XLALCreateREAL8Vector(dataLength)) == NULL ) || /* Data Imag Value*/
-          ((ReMu = XLALCreateREAL8Vector(dataLength)) == NULL ) || /* Real Value of model used to calculate least squares*/
-          ((ImMu = XLALCreateREAL8Vector(dataLength)) == NULL ) || /* Imag Value of model used to calculate least squares*/
-          ((MuMu = XLALCreateREAL8Vector(dataLength)) == NULL ) || /* Normalisation factor  - sum of squares of model , with some constants that can be cancelled*/
-          ((dpUsed = XLALCreateUINT4Vector(dataLength)) == NULL) ){ /* Whether the datapoint is used or not - residual removal etc */
-          XLALPrintError("Error, allocating data memory.\n");
-          exit(1);
-        }
-
-        REAL8 ReStdDev = 0., ImStdDev = 0., StdDev = 0., ReStdDevSum = 0., ImStdDevSum = 0.;
-
-        /* Load the data into the ReDp, ImDp vectors and set dataFreqs */
-        /* While doing this, add the square of each in order to obtain the std deviation of the data */
-        for(datapoint=ROUND((fnew-inputParams.bandwidth/2.-SFTdat->data->f0)/deltaf);
-                   datapoint<= ROUND((fnew+inputParams.bandwidth/2.-SFTdat->data->f0)/deltaf); datapoint++ ){
-          dpNum  = (UINT4)(datapoint-ROUND((fnew-inputParams.bandwidth/2.-SFTdat->data->f0)/deltaf));
-
-          ReDp->data[dpNum] = creal(SFTdat->data[sftnum].data->data[datapoint]);
-
-          ImDp->data[dpNum] = cimag(SFTdat->data[sftnum].data->data[datapoint]);
-
-          dataFreqs->data[dpNum] = SFTdat->data->f0+datapoint*deltaf;
-
-          ReStdDevSum += (ReDp->data[dpNum])*(ReDp->data[dpNum]);
-
-          ImStdDevSum += (ImDp->data[dpNum])*(ImDp->data[dpNum]);
-
-        } /* close datapoint loop*/
-
-        /* Obtain the std deviation combined from Real and Imaginary parts of SFT */
-
-        ReStdDev = sqrt(ReStdDevSum/(dataLength-1));
-        ImStdDev = sqrt(ImStdDevSum/(dataLength-1));
-
-        StdDev = sqrt(ReStdDev*ReStdDev + ImStdDev*ImStdDev)/2;
-
-        /* if removing outliers, remove any data point whihc is outside of closest 10 datapoints with real or */
-        /* imaginary parts above threshold number of standard deviations. */
-        for(dpNum = 0; dpNum< dataFreqs->length; dpNum++){
-          if( ((fabs(ReDp->data[dpNum]) < 2*inputParams.stddevthresh*StdDev &&
-              fabs(ImDp->data[dpNum]) < 2*inputParams.stddevthresh*StdDev) || /* Keep if datapoint is within 4 std devs */
-              inputParams.stddevthresh==0) || /* keep if threshold not set */
-              ( fabs(dataFreqs->data[dpNum]-fnew) < 5*deltaf)  ){ /* ensure keeping closest 10 points to fnew to keep signals */
-            dpUsed->data[dpNum] = 1;
-          }
-          else{
-            /* If not within these limits, set datapoint as not used. */
-            dpUsed->data[dpNum] = 0;
-          }
-        } /* close datapoint loop*/
-
-        /* Data has now been loaded into ReDp/ImDp and dpUsed set to remove initial outliers */
-
-        /* Set values of Model used for interpolation */
-        /* Check if there is a significant signal spread over frequencies over the course of the SFT */
-        if(fabs(f1new)/(deltaf*deltaf)>0.1){ /*i.e. if signal is spread more than 0.1 bins over the course of the SFT */
-          for(dpNum=0;dpNum<dataLength;dpNum++ ){
-
-            if(dpUsed->data[dpNum] == 1){
-              REAL8  FresPlusC = 0., FresMinC = 0.,FresPlusS = 0., FresMinS = 0. , delPhase = 0.;
-
-              delPhase = phaseShift-LAL_PI*(fnew-dataFreqs->data[dpNum])*(fnew-dataFreqs->data[dpNum])/f1new
-                                   -LAL_PI*(dataFreqs->data[dpNum])/deltaf;
-
-              /* calculate fresnel integrals for start and end of SFT */
-              XLALFresnel(&FresPlusC,&FresPlusS,((fnew-dataFreqs->data[dpNum])*LAL_SQRT2*sqrtf1new/f1new+sqrtf1new/LAL_SQRT2/deltaf));
-              XLALFresnel(&FresMinC,&FresMinS,((fnew-dataFreqs->data[dpNum])*LAL_SQRT2*sqrtf1new/f1new-sqrtf1new/LAL_SQRT2/deltaf));
-
-              ReMu->data[dpNum] = 1/(LAL_SQRT2*sqrtf1new)*(cos(delPhase)*(FresPlusC-FresMinC)
-                                       -signf1new*sin(delPhase)*(FresPlusS-FresMinS));
-
-              ImMu->data[dpNum] = 1/(LAL_SQRT2*sqrtf1new)*(sin(delPhase)*(FresPlusC-FresMinC)
-                                       +signf1new*cos(delPhase)*(FresPlusS-FresMinS));
-
-              MuMu->data[dpNum] = 1/(2*fabs(f1new))*((FresPlusC-FresMinC)*(FresPlusC-FresMinC)
-                                                        +(FresPlusS-FresMinS)*(FresPlusS-FresMinS));
-            } /* close if datapoint used statement */
-
-          } /* close datapoint loop */
-
-        }
-        else{/* signal is not spread */
-
-          /* Check if calculated pulsar frequency lies on an bin or within 0.1% (SFT bin value is 99.9998% of true value) */
-          /* of the SFT to a frequency bin.*/
-          /* If it does, just perform the phaseshift, including phase shift from change in frequency. */
-          /* (This is essentially to avoid any "divide by zero" problems) */
-
-          if(fmod((fnew-SFTdat->data->f0),deltaf)<(0.01*deltaf) ||
-                   fmod((fnew-SFTdat->data->f0),deltaf)>(0.99*deltaf)){
-            for(dpNum=0;dpNum<dataLength;dpNum++ ){
-
-              if( dpNum == (UINT4)( ROUND( inputParams.bandwidth/(2.*deltaf) ) ) ){
-                ReMu->data[dpNum] = cos(phaseShift-LAL_PI*dataFreqs->data[dpNum]/deltaf)/deltaf;
-                ImMu->data[dpNum] = sin(phaseShift-LAL_PI*dataFreqs->data[dpNum]/deltaf)/deltaf;
-                MuMu->data[dpNum] = 1/(deltaf*deltaf);
-              }/* close 'if on signal frequency bin' statement */
-              else{
-                ReMu->data[dpNum] = 0;
-                ImMu->data[dpNum] = 0;
-                MuMu->data[dpNum] = 0;
-              } /* close 'else a different bin' statement */
-
-            } /* close 'for each datapoint' loop*/
-
-          } /* close 'if on a bin' statement */
-          else{ /* signal is not on a bin - interpolate with a sinc*/
-
-            for(dpNum=0;dpNum<dataLength;dpNum++ ){
-
-              if(dpUsed->data[dpNum] == 1){ /* if the datapoint is not an outlier */
-
-                ReMu->data[dpNum] = 1/(deltaf)*SINC((dataFreqs->data[dpNum]-fnew)/deltaf)
-                                      *cos(phaseShift-LAL_PI*dataFreqs->data[dpNum]/deltaf);
-
-                ImMu->data[dpNum] = 1/(deltaf)*SINC((dataFreqs->data[dpNum]-fnew)/deltaf)
-                                      *sin(phaseShift-LAL_PI*dataFreqs->data[dpNum]/deltaf);
-
-                MuMu->data[dpNum] = 1./(deltaf*deltaf)*SINC((dataFreqs->data[dpNum]-fnew)/deltaf)
-                                                          *SINC((dataFreqs->data[dpNum]-fnew)/deltaf);
-
-              } /* close 'if the datapoint is not an outlier' statement */
-
-            } /* close datapoint loop */
-
-          } /* close 'else interpolate with a sinc' statement */
-
-        } /* close 'else is not spread' statement */
-
-        /* At this point we have now loaded the data, set the model and performed the first outlier removal */
-        /* now we calculate Bk and sigmak, and perform residual outlier removal */
-
-        /* initialise and create residual and signal best estimate vectors*/
-        REAL8Vector *ReResiduals = NULL, *ImResiduals = NULL, *ReHf = NULL, *ImHf = NULL;
-
-        if( ((ReResiduals = XLALCreateREAL8Vector(dataLength)) == NULL ) || /* Value of residuals in Real part of SFT */
-            ((ImResiduals = XLALCreateREAL8Vector(dataLength)) == NULL ) || /* Value of residuals in Imag part of SFT **/
-            ((ReHf = XLALCreateREAL8Vector(dataLength)) == NULL ) || /* Expected Value in Real part of SFT given interpolated Bk */
-            ((ImHf = XLALCreateREAL8Vector(dataLength)) == NULL ) ){ /* Expected Value in Imag part of SFT given interpolated Bk  */
-          XLALPrintError("Error, allocating residuals memory.\n");
-          exit(1);
-        }
-
-        /* Residual noise value needs to be initialised outside the while loop as it will be outputted */
-        REAL8 ResStdDev = 0.;
-
-        /* repeat the following section until all outliers have been removed */
-        UINT4 numReduced = 1; /* i.e. flag to say that the number of datapoints has been reduced */
-
-        /* Iterate through Bk and sigmak calculation, and residual outlier removal so that */
-        /* Bk and sigmak are recalculated if any of the datapoints have been removed. */
-        while(numReduced){
-          UINT4 dpCountStart = 0, dpCountEnd = 0;
-          /* count the number of datapoints being used to begin with */
-          for(dpNum=0; dpNum<dataLength; dpNum++ ){
-            dpCountStart += dpUsed->data[dpNum];
-          }
-
-          /* Perform least squares fit*/
-          for(dpNum=0;dpNum<dataLength;dpNum++ ){
-
-            if(dpUsed->data[dpNum] == 1){ /* use only datapoints which have not been removed */
-
-              REAL8  ReVal = 0., ImVal = 0;
-
-              ReVal=ReDp->data[dpNum]*ReMu->data[dpNum]+ImDp->data[dpNum]*ImMu->data[dpNum];
-              ImVal=ImDp->data[dpNum]*ReMu->data[dpNum]-ReDp->data[dpNum]*ImMu->data[dpNum];
-              AbsSquaredWeightSum += MuMu->data[dpNum];
-
-              UnnormalisedInterpolatedRealValue+=ReVal;
-              UnnormalisedInterpolatedImagValue+=ImVal;
-
-            } /* close if datapoint is used statement */
-
-          }/* close datapoint loop*/
-
-          /* Combine sums to find interpolated values*/
-          InterpolatedRealValue=UnnormalisedInterpolatedRealValue/AbsSquaredWeightSum;
-          InterpolatedImagValue=UnnormalisedInterpolatedImagValue/AbsSquaredWeightSum;
-
-          /* Reset the following to zero in case this is the (>1)th loop through the while statement */
-          REAL8 ResReStdDev = 0., ResImStdDev = 0., ResReStdDevSum = 0., ResImStdDevSum = 0.;
-
-          /* Residual cleaning */
-          for(dpNum=0;dpNum<dataLength;dpNum++ ){
-
-            if(dpUsed->data[dpNum] == 1){
-
-              /* calculate estimated signal in SFT from B_k and model */
-              ReHf->data[dpNum]=InterpolatedRealValue*ReMu->data[dpNum]-InterpolatedImagValue*ImMu->data[dpNum];
-              ImHf->data[dpNum]=InterpolatedImagValue*ReMu->data[dpNum]+InterpolatedRealValue*ImMu->data[dpNum];
-
-              /* take this from the atual SFT to obtain residuals */
-              ReResiduals->data[dpNum] = ReDp->data[dpNum] - ReHf->data[dpNum];
-              ImResiduals->data[dpNum] = ImDp->data[dpNum] - ImHf->data[dpNum];
-
-              ResReStdDevSum += ReResiduals->data[dpNum]*ReResiduals->data[dpNum];
-              ResImStdDevSum += ImResiduals->data[dpNum]*ImResiduals->data[dpNum];
-
-            } /* close if datapoint is used statement */
-
-          }/* close datapoint loop*/
-
-          /* calculate standard deviation of the residuals - average or real and imag parts */
-          ResReStdDev = sqrt(ResReStdDevSum/(dpCountStart-1));
-          ResImStdDev = sqrt(ResImStdDevSum/(dpCountStart-1));
-
-          /* calculate combined standard deviation */
-          ResStdDev = sqrt(ResReStdDev*ResReStdDev+ResImStdDev*ResImStdDev)/2;
-
-          /* Use residual standard deviation to remove datapoints - always keep closest 4 datapoints */
-          for(dpNum = 0; dpNum < dataFreqs->length; dpNum++){
-
-            if(dpUsed->data[dpNum] == 1){ /* dont change currently unused points */
-
-              if( (fabs(ReResiduals->data[dpNum]) < inputParams.stddevthresh*(ResStdDev) &&
-                  fabs(ImResiduals->data[dpNum]) < inputParams.stddevthresh*(ResStdDev)) || /* Keep if datapoint is within std devs */
-                   inputParams.stddevthresh==0 || /* keep if threshold not set */
-                  ( fabs(dataFreqs->data[dpNum]-fnew) < 2*deltaf)  ){ /* ensure keeping closest 4 points to fnew to keep signals */
-                dpUsed->data[dpNum] = 1;
-              }
-              else{
-                dpUsed->data[dpNum] = 0;
-              }
-            }/* close if datapoint is used loop*/
-
-          } /* close datapoint loop*/
-
-          /* count the number of datapoints being used after cleaning  */
-          for(dpNum=0; dpNum<dataLength; dpNum++ ){
-            dpCountEnd += dpUsed->data[dpNum];
-          }
-
-
-          if(dpCountStart == dpCountEnd) numReduced = 0; /* if no data points have been removed, exit the while loop */
-
-        } /* Close outlier removal while loop */
-
-        /* Destroy data and model structures to prevent memory leak */
-        XLALDestroyREAL8Vector(ReResiduals);
-        XLALDestroyREAL8Vector(ImResiduals);
-        XLALDestroyREAL8Vector(dataFreqs);
-        XLALDestroyREAL8Vector(ReDp);
-        XLALDestroyREAL8Vector(ImDp);
-        XLALDestroyREAL8Vector(ReMu);
-        XLALDestroyREAL8Vector(ImMu);
-        XLALDestroyREAL8Vector(MuMu);
-        XLALDestroyREAL8Vector(ReHf);
-        XLALDestroyREAL8Vector(ImHf);
-        XLALDestroyUINT4Vector(dpUsed);
-
         /* print time, ReBk, ImBk and noise estimate to output file*/
-        fprintf(fpout[h],"%.0f\t%.6e\t%.6e\t%.6e\n",timestamp+1./(2.*deltaf),InterpolatedRealValue
-           ,InterpolatedImagValue, ResStdDev*deltaf*LAL_SQRT2);
+        fprintf(fpout[h],"%.0f\t%.6e\t%.6e\t%.6e\n",timestamp+1./(2.*deltaf),bk->ReBk
+           ,bk->ImBk, bk->noise);
 
       } /* close pulsar loop */
 
     }/* close SFTnum loop */
+    XLALFree(batch.bk);
     if(inputParams.Timing){
       gettimeofday(&timeInterpolateEnd, NULL);
       tInterpolate  = (REAL8)timeInterpolateEnd.tv_usec*1.e-6 + (REAL8)timeInterpolateEnd.tv_sec - (REAL8)timeInterpolateStart.tv_usec*1.e-6 - (REAL8)timeInterpolateStart.tv_sec;
@@ -1228,6 +830,504 @@ int main( int argc, char **argv ){
 }
 
 
+/* Interpolate B_k for pulsar h in SFT sftnum, given the Earth states at the middle, start and end of the SFT */
+static int interpolate_pulsar_bk( const SplInterBatch *batch, UINT4 sftnum, UINT4 h, const EarthState *earth,
+                                  const EarthState *earthS, const EarthState *earthE, SplInterBk *bk ){
+  const InputParams *inputParams = batch->inputParams;
+  const SplInterParams *splParams = batch->splParams;
+  const SFTVector *SFTdat = batch->SFTdat;
+  PulsarParameters **pulparams = batch->pulparams;
+  const REAL8 *baryAlpha = batch->baryAlpha, *baryDelta = batch->baryDelta, *barydInv = batch->barydInv;
+
+  /* deltaf is the frequency bin separation, deltaf = 1/(SFT length) */
+  const REAL8 deltaf = SFTdat->data->deltaF;
+  const REAL8 timestamp = XLALGPSGetREAL8(&SFTdat->data[sftnum].epoch);
+
+  /* Initialise variables that change for each SFT */
+  REAL8 InterpolatedImagValue=0., InterpolatedRealValue=0.,
+        UnnormalisedInterpolatedImagValue=0., UnnormalisedInterpolatedRealValue=0.,
+        AbsSquaredWeightSum=0;
+  INT4 datapoint=0;
+  REAL8 phaseShift = 0., fnew = 0., f1new = 0., sqrtf1new = 0.;
+  REAL8 tdt = 0.;
+  REAL8 tdtS = 0.;
+  REAL8 tdtE = 0.;
+  BarycenterInput baryInput, baryInputS, baryInputE;
+  EmissionTime emit, emitS, emitE;
+
+  /* ------ Barycenter routine ------ */
+
+  /* Timestamp needed in GPS format*/
+  XLALGPSSetREAL8( &baryInput.tgps, timestamp +  1./(2.*deltaf) );
+
+  /* set up location of detector */
+  baryInput.site.location[0] = splParams->detector.location[0]/LAL_C_SI;
+  baryInput.site.location[1] = splParams->detector.location[1]/LAL_C_SI;
+  baryInput.site.location[2] = splParams->detector.location[2]/LAL_C_SI;
+
+  baryInputE.site.location[0] = splParams->detector.location[0]/LAL_C_SI;
+  baryInputE.site.location[1] = splParams->detector.location[1]/LAL_C_SI;
+  baryInputE.site.location[2] = splParams->detector.location[2]/LAL_C_SI;
+
+  baryInputS.site.location[0] = splParams->detector.location[0]/LAL_C_SI;
+  baryInputS.site.location[1] = splParams->detector.location[1]/LAL_C_SI;
+  baryInputS.site.location[2] = splParams->detector.location[2]/LAL_C_SI;
+
+  /* get sky position and inverse distance from previously calculated values */
+  baryInput.delta = baryDelta[h];
+  baryInput.alpha = baryAlpha[h];
+  baryInput.dInv = barydInv[h];
+
+  baryInputE.delta = baryDelta[h];
+  baryInputE.alpha = baryAlpha[h];
+  baryInputE.dInv = barydInv[h];
+
+  baryInputS.delta = baryDelta[h];
+  baryInputS.alpha = baryAlpha[h];
+  baryInputS.dInv = barydInv[h];
+
+  /* Perform Barycentering Routine at middle of SFT, for calculation of phase shift and frequency, */
+  /* using the Earth state shared by all pulsars with the same ephemeris and time corrections */
+  XLALBarycenter(&emit, &baryInput, earth);
+
+  /* Also perform Barycentering Routine at start and end of SFT, for calculation of frequency derivatives */
+
+  XLALGPSSetREAL8( &baryInputE.tgps, timestamp +  1./(deltaf) );
+  XLALGPSSetREAL8( &baryInputS.tgps, timestamp );
+
+  XLALBarycenter(&emitE, &baryInputE, earthE);
+  XLALBarycenter(&emitS, &baryInputS, earthS);
+
+  /* If the 'detector at barycenter' flag is set, then reset emit to appropriate values */
+  if (inputParams->baryFlag){
+    emit.tDot=1.;
+    emit.deltaT=0.;
+    emitS.tDot=1.;
+    emitS.deltaT=0.;
+    emitE.tDot=1.;
+    emitE.deltaT=0.;
+  }
+
+  REAL8 totaltDot = 0., totaltDotstart = 0.,totaltDotend = 0.;
+  REAL8 totaldeltaT = 0., totaldeltaTstart = 0.,totaldeltaTend = 0.;
+
+  /* Get binary pulsar corrections if source is a binary pulsar */
+  /* because XLALBinaryPulsarDeltaTNew only returns delta t, not tdot, we need to */
+  /* calculate above and below the start and end frequencies to find gradient. */
+
+  /* These are denoted for start(S)/end(E) and plus(P)/minus(M) 1 second.  */
+
+  if( PulsarCheckParam(pulparams[h], "BINARY") ){
+    BinaryPulsarInput binInputS, binInputM, binInputE, binInputSP, binInputSM, binInputEP, binInputEM;
+    BinaryPulsarOutput binOutputS, binOutputM, binOutputE, binOutputSP, binOutputSM, binOutputEP, binOutputEM;
+
+    /* set up times used for binary input */
+    binInputS.tb = timestamp + emitS.deltaT;
+    binInputE.tb = timestamp + 1./deltaf + emitE.deltaT;
+    binInputM.tb = timestamp + 1./(2.*deltaf) + emit.deltaT;
+
+    /* Make assumption that emitS, emitE earthS and earthE are constant over two seconds */
+    binInputSM.tb = timestamp + emitS.deltaT-1;
+    binInputSP.tb = timestamp + emitS.deltaT+1;
+    binInputEM.tb = timestamp + 1./deltaf + emitE.deltaT-1;
+    binInputEP.tb = timestamp + 1./deltaf + emitE.deltaT+1;
+
+    binInputS.earth = *earthS;
+    binInputE.earth = *earthE;
+    binInputM.earth = *earth;
+
+    binInputSP.earth = *earthS;
+    binInputEP.earth = *earthE;
+    binInputSM.earth = *earthS;
+    binInputEM.earth = *earthE;
+
+    XLALBinaryPulsarDeltaTNew( &binOutputS, &binInputS, pulparams[h] );
+    XLALBinaryPulsarDeltaTNew( &binOutputE, &binInputE, pulparams[h] );
+    XLALBinaryPulsarDeltaTNew( &binOutputM, &binInputM, pulparams[h] );
+
+    XLALBinaryPulsarDeltaTNew( &binOutputSM, &binInputSM, pulparams[h] );
+    XLALBinaryPulsarDeltaTNew( &binOutputEM, &binInputEM, pulparams[h] );
+    XLALBinaryPulsarDeltaTNew( &binOutputSP, &binInputSP, pulparams[h] );
+    XLALBinaryPulsarDeltaTNew( &binOutputEP, &binInputEP, pulparams[h] );
+
+    /* Add the barycentering and binary terms together to get total deltat */
+    totaldeltaT = emit.deltaT + binOutputM.deltaT;
+    totaldeltaTstart = emitS.deltaT + binOutputS.deltaT;
+    totaldeltaTend = emitE.deltaT + binOutputE.deltaT;
+
+    /* Add the barycentering and binary terms together to get total tdot */
+    totaltDot = emit.tDot + (binOutputE.deltaT-binOutputS.deltaT)*deltaf;
+    totaltDotend = emitE.tDot + (binOutputEP.deltaT-binOutputEM.deltaT)/2;
+    totaltDotstart = emitS.tDot + (binOutputSP.deltaT-binOutputSM.deltaT)/2;
+  }
+  else{
+    /* If not a binary, then relative motion effects are only due to detector motion */
+    totaldeltaT = emit.deltaT;
+    totaldeltaTend = emitE.deltaT;
+    totaldeltaTstart = emitS.deltaT;
+
+    totaltDot = emit.tDot;
+    totaltDotend = emitE.tDot;
+    totaltDotstart = emitS.tDot;
+  }
+
+  /* Calculate relevant time difference to epoch for use in calculations */
+  REAL8 pepoch = PulsarGetREAL8ParamOrZero( pulparams[h], "PEPOCH" );
+  tdt=timestamp - pepoch + 1./(2.*deltaf) + totaldeltaT;
+  tdtS=timestamp - pepoch + totaldeltaTstart;
+  tdtE=timestamp - pepoch + 1./(2.*deltaf) + totaldeltaTend;
+
+  /* SFT start time - parfile epoch + 1/2 SFT length + barycentre timeshift */
+
+  fnew = 0., phaseShift = 0.;
+  REAL8 fstart = 0., fend = 0.;
+  REAL8 dtpow = 1., dtspow = 1., dtepow = 1.;
+  const REAL8Vector *freqs = PulsarGetREAL8VectorParam(pulparams[h], "F");
+  for ( UINT4 k=0; k<freqs->length; k++ ){
+    /* calculate frequency at the centre of the SFT */
+    fnew += (freqs->data[k]*dtpow)/gsl_sf_fact(k);
+    dtpow *= tdt;
+
+    /* calculate frequency at start of SFT */
+    fstart += (freqs->data[k]*dtspow)/gsl_sf_fact(k);
+    dtspow *= tdtS;
+
+    /* calculate frequency at end of SFT */
+    fend += (freqs->data[k]*dtepow)/gsl_sf_fact(k);
+    dtepow *= tdtE;
+
+    /* Calculate difference in phase between beginning of SFT and the epoch.  */
+    phaseShift += (freqs->data[k]*dtpow)/gsl_sf_fact(k+1);
+  }
+  fnew *= (inputParams->freqfactor*totaltDot);
+  fstart *= (inputParams->freqfactor*totaltDotstart);
+  fend *= (inputParams->freqfactor*totaltDotend);
+  phaseShift = LAL_TWOPI*fmod(inputParams->freqfactor*phaseShift, 1.);
+
+  /* the out-of-range warning is printed by the caller, so that it appears in order */
+  if((fnew < inputParams->startF) || (fnew > inputParams->endF)){
+    bk->fnew = fnew;
+    bk->status = SPLINTER_BK_OUT_OF_RANGE;
+    return XLAL_SUCCESS;
+  }
+
+  /* calculate effective fdot including the frequency derivative obtained from the barycentering */
+  f1new= (fend - fstart)*deltaf;
+
+  sqrtf1new = sqrt(fabs(f1new)); /* square root of the absolute value of f1 for use in calculations */
+  REAL8 signf1new = f1new/fabs(f1new); /* sign of f1 for use in calculations */
+
+  UINT4 dataLength = 0, dpNum = 0;
+
+  /* Load data into RAM as will be reusing multiple times */
+  dataLength = (UINT4)(ROUND((fnew+inputParams->bandwidth/2.-SFTdat->data->f0)/deltaf
+                    -(fnew-inputParams->bandwidth/2.-SFTdat->data->f0)/deltaf));
+
+  /* check data load */
+  if(dataLength<1){
+    bk->status = SPLINTER_BK_NO_DATA;
+    return XLAL_SUCCESS;
+  }
+
+  /* initialise and create various vectors for use in calculations */
+  REAL8Vector *dataFreqs = NULL, *ReDp = NULL, *ImDp = NULL, *ReMu = NULL, *ImMu = NULL, *MuMu = NULL;
+  UINT4Vector *dpUsed = NULL;
+
+  if( ((dataFreqs = XLALCreateREAL8Vector(dataLength)) == NULL ) || /* datapoint frequency value*/
+    ((ReDp = XLALCreateREAL8Vector(dataLength)) == NULL ) || /* Data Real Value*/
+    ((ImDp = XLALCreateREAL8Vector(dataLength)) == NULL ) || /* Data Imag Value*/
+    ((ReMu = XLALCreateREAL8Vector(dataLength)) == NULL ) || /* Real Value of model used to calculate least squares*/
+    ((ImMu = XLALCreateREAL8Vector(dataLength)) == NULL ) || /* Imag Value of model used to calculate least squares*/
+    ((MuMu = XLALCreateREAL8Vector(dataLength)) == NULL ) || /* Normalisation factor  - sum of squares of model , with some constants that can be cancelled*/
+    ((dpUsed = XLALCreateUINT4Vector(dataLength)) == NULL) ){ /* Whether the datapoint is used or not - residual removal etc */
+    XLAL_ERROR(XLAL_ENOMEM, "Error, allocating data memory.\n");
+  }
+
+  REAL8 ReStdDev = 0., ImStdDev = 0., StdDev = 0., ReStdDevSum = 0., ImStdDevSum = 0.;
+
+  /* Load the data into the ReDp, ImDp vectors and set dataFreqs */
+  /* While doing this, add the square of each in order to obtain the std deviation of the data */
+  for(datapoint=ROUND((fnew-inputParams->bandwidth/2.-SFTdat->data->f0)/deltaf);
+             datapoint<= ROUND((fnew+inputParams->bandwidth/2.-SFTdat->data->f0)/deltaf); datapoint++ ){
+    dpNum  = (UINT4)(datapoint-ROUND((fnew-inputParams->bandwidth/2.-SFTdat->data->f0)/deltaf));
+
+    ReDp->data[dpNum] = creal(SFTdat->data[sftnum].data->data[datapoint]);
+
+    ImDp->data[dpNum] = cimag(SFTdat->data[sftnum].data->data[datapoint]);
+
+    dataFreqs->data[dpNum] = SFTdat->data->f0+datapoint*deltaf;
+
+    ReStdDevSum += (ReDp->data[dpNum])*(ReDp->data[dpNum]);
+
+    ImStdDevSum += (ImDp->data[dpNum])*(ImDp->data[dpNum]);
+
+  } /* close datapoint loop*/
+
+  /* Obtain the std deviation combined from Real and Imaginary parts of SFT */
+
+  ReStdDev = sqrt(ReStdDevSum/(dataLength-1));
+  ImStdDev = sqrt(ImStdDevSum/(dataLength-1));
+
+  StdDev = sqrt(ReStdDev*ReStdDev + ImStdDev*ImStdDev)/2;
+
+  /* if removing outliers, remove any data point whihc is outside of closest 10 datapoints with real or */
+  /* imaginary parts above threshold number of standard deviations. */
+  for(dpNum = 0; dpNum< dataFreqs->length; dpNum++){
+    if( ((fabs(ReDp->data[dpNum]) < 2*inputParams->stddevthresh*StdDev &&
+        fabs(ImDp->data[dpNum]) < 2*inputParams->stddevthresh*StdDev) || /* Keep if datapoint is within 4 std devs */
+        inputParams->stddevthresh==0) || /* keep if threshold not set */
+        ( fabs(dataFreqs->data[dpNum]-fnew) < 5*deltaf)  ){ /* ensure keeping closest 10 points to fnew to keep signals */
+      dpUsed->data[dpNum] = 1;
+    }
+    else{
+      /* If not within these limits, set datapoint as not used. */
+      dpUsed->data[dpNum] = 0;
+    }
+  } /* close datapoint loop*/
+
+  /* Data has now been loaded into ReDp/ImDp and dpUsed set to remove initial outliers */
+
+  /* Set values of Model used for interpolation */
+  /* Check if there is a significant signal spread over frequencies over the course of the SFT */
+  if(fabs(f1new)/(deltaf*deltaf)>0.1){ /*i.e. if signal is spread more than 0.1 bins over the course of the SFT */
+    for(dpNum=0;dpNum<dataLength;dpNum++ ){
+
+      if(dpUsed->data[dpNum] == 1){
+        REAL8  FresPlusC = 0., FresMinC = 0.,FresPlusS = 0., FresMinS = 0. , delPhase = 0.;
+
+        delPhase = phaseShift-LAL_PI*(fnew-dataFreqs->data[dpNum])*(fnew-dataFreqs->data[dpNum])/f1new
+                             -LAL_PI*(dataFreqs->data[dpNum])/deltaf;
+
+        /* calculate fresnel integrals for start and end of SFT */
+        XLALFresnel(&FresPlusC,&FresPlusS,((fnew-dataFreqs->data[dpNum])*LAL_SQRT2*sqrtf1new/f1new+sqrtf1new/LAL_SQRT2/deltaf));
+        XLALFresnel(&FresMinC,&FresMinS,((fnew-dataFreqs->data[dpNum])*LAL_SQRT2*sqrtf1new/f1new-sqrtf1new/LAL_SQRT2/deltaf));
+
+        ReMu->data[dpNum] = 1/(LAL_SQRT2*sqrtf1new)*(cos(delPhase)*(FresPlusC-FresMinC)
+                                 -signf1new*sin(delPhase)*(FresPlusS-FresMinS));
+
+        ImMu->data[dpNum] = 1/(LAL_SQRT2*sqrtf1new)*(sin(delPhase)*(FresPlusC-FresMinC)
+                                 +signf1new*cos(delPhase)*(FresPlusS-FresMinS));
+
+        MuMu->data[dpNum] = 1/(2*fabs(f1new))*((FresPlusC-FresMinC)*(FresPlusC-FresMinC)
+                                                  +(FresPlusS-FresMinS)*(FresPlusS-FresMinS));
+      } /* close if datapoint used statement */
+
+    } /* close datapoint loop */
+
+  }
+  else{/* signal is not spread */
+
+    /* Check if calculated pulsar frequency lies on an bin or within 0.1% (SFT bin value is 99.9998% of true value) */
+    /* of the SFT to a frequency bin.*/
+    /* If it does, just perform the phaseshift, including phase shift from change in frequency. */
+    /* (This is essentially to avoid any "divide by zero" problems) */
+
+    if(fmod((fnew-SFTdat->data->f0),deltaf)<(0.01*deltaf) ||
+             fmod((fnew-SFTdat->data->f0),deltaf)>(0.99*deltaf)){
+      for(dpNum=0;dpNum<dataLength;dpNum++ ){
+
+        if( dpNum == (UINT4)( ROUND( inputParams->bandwidth/(2.*deltaf) ) ) ){
+          ReMu->data[dpNum] = cos(phaseShift-LAL_PI*dataFreqs->data[dpNum]/deltaf)/deltaf;
+          ImMu->data[dpNum] = sin(phaseShift-LAL_PI*dataFreqs->data[dpNum]/deltaf)/deltaf;
+          MuMu->data[dpNum] = 1/(deltaf*deltaf);
+        }/* close 'if on signal frequency bin' statement */
+        else{
+          ReMu->data[dpNum] = 0;
+          ImMu->data[dpNum] = 0;
+          MuMu->data[dpNum] = 0;
+        } /* close 'else a different bin' statement */
+
+      } /* close 'for each datapoint' loop*/
+
+    } /* close 'if on a bin' statement */
+    else{ /* signal is not on a bin - interpolate with a sinc*/
+
+      /* The model is evaluated at every datapoint, outliers included (their values are */
+      /* never used), so that the loop has no branches and can be vectorised; the sinc */
+      /* kernel is evaluated once per datapoint */
+      const REAL8 invdeltaf = 1/(deltaf);
+      const REAL8 invdeltaf2 = 1./(deltaf*deltaf);
+      for(dpNum=0;dpNum<dataLength;dpNum++ ){
+        const REAL8 sincval = SINC((dataFreqs->data[dpNum]-fnew)/deltaf);
+        const REAL8 phase = phaseShift-LAL_PI*dataFreqs->data[dpNum]/deltaf;
+
+        ReMu->data[dpNum] = invdeltaf*sincval*cos(phase);
+
+        ImMu->data[dpNum] = invdeltaf*sincval*sin(phase);
+
+        MuMu->data[dpNum] = invdeltaf2*sincval*sincval;
+
+      } /* close datapoint loop */
+
+    } /* close 'else interpolate with a sinc' statement */
+
+  } /* close 'else is not spread' statement */
+
+  /* At this point we have now loaded the data, set the model and performed the first outlier removal */
+  /* now we calculate Bk and sigmak, and perform residual outlier removal */
+
+  /* initialise and create residual and signal best estimate vectors*/
+  REAL8Vector *ReResiduals = NULL, *ImResiduals = NULL, *ReHf = NULL, *ImHf = NULL;
+
+  if( ((ReResiduals = XLALCreateREAL8Vector(dataLength)) == NULL ) || /* Value of residuals in Real part of SFT */
+      ((ImResiduals = XLALCreateREAL8Vector(dataLength)) == NULL ) || /* Value of residuals in Imag part of SFT **/
+      ((ReHf = XLALCreateREAL8Vector(dataLength)) == NULL ) || /* Expected Value in Real part of SFT given interpolated Bk */
+      ((ImHf = XLALCreateREAL8Vector(dataLength)) == NULL ) ){ /* Expected Value in Imag part of SFT given interpolated Bk  */
+    XLAL_ERROR(XLAL_ENOMEM, "Error, allocating residuals memory.\n");
+  }
+
+  /* Residual noise value needs to be initialised outside the while loop as it will be outputted */
+  REAL8 ResStdDev = 0.;
+
+  /* repeat the following section until all outliers have been removed */
+  UINT4 numReduced = 1; /* i.e. flag to say that the number of datapoints has been reduced */
+
+  /* Iterate through Bk and sigmak calculation, and residual outlier removal so that */
+  /* Bk and sigmak are recalculated if any of the datapoints have been removed. */
+  while(numReduced){
+    UINT4 dpCountStart = 0, dpCountEnd = 0;
+    /* count the number of datapoints being used to begin with */
+    for(dpNum=0; dpNum<dataLength; dpNum++ ){
+      dpCountStart += dpUsed->data[dpNum];
+    }
+
+    /* Perform least squares fit*/
+    for(dpNum=0;dpNum<dataLength;dpNum++ ){
+
+      if(dpUsed->data[dpNum] == 1){ /* use only datapoints which have not been removed */
+
+        REAL8  ReVal = 0., ImVal = 0;
+
+        ReVal=ReDp->data[dpNum]*ReMu->data[dpNum]+ImDp->data[dpNum]*ImMu->data[dpNum];
+        ImVal=ImDp->data[dpNum]*ReMu->data[dpNum]-ReDp->data[dpNum]*ImMu->data[dpNum];
+        AbsSquaredWeightSum += MuMu->data[dpNum];
+
+        UnnormalisedInterpolatedRealValue+=ReVal;
+        UnnormalisedInterpolatedImagValue+=ImVal;
+
+      } /* close if datapoint is used statement */
+
+    }/* close datapoint loop*/
+
+    /* Combine sums to find interpolated values*/
+    InterpolatedRealValue=UnnormalisedInterpolatedRealValue/AbsSquaredWeightSum;
+    InterpolatedImagValue=UnnormalisedInterpolatedImagValue/AbsSquaredWeightSum;
+
+    /* Reset the following to zero in case this is the (>1)th loop through the while statement */
+    REAL8 ResReStdDev = 0., ResImStdDev = 0., ResReStdDevSum = 0., ResImStdDevSum = 0.;
+
+    /* Residual cleaning */
+    for(dpNum=0;dpNum<dataLength;dpNum++ ){
+
+      if(dpUsed->data[dpNum] == 1){
+
+        /* calculate estimated signal in SFT from B_k and model */
+        ReHf->data[dpNum]=InterpolatedRealValue*ReMu->data[dpNum]-InterpolatedImagValue*ImMu->data[dpNum];
+        ImHf->data[dpNum]=InterpolatedImagValue*ReMu->data[dpNum]+InterpolatedRealValue*ImMu->data[dpNum];
+
+        /* take this from the atual SFT to obtain residuals */
+        ReResiduals->data[dpNum] = ReDp->data[dpNum] - ReHf->data[dpNum];
+        ImResiduals->data[dpNum] = ImDp->data[dpNum] - ImHf->data[dpNum];
+
+        ResReStdDevSum += ReResiduals->data[dpNum]*ReResiduals->data[dpNum];
+        ResImStdDevSum += ImResiduals->data[dpNum]*ImResiduals->data[dpNum];
+
+      } /* close if datapoint is used statement */
+
+    }/* close datapoint loop*/
+
+    /* calculate standard deviation of the residuals - average or real and imag parts */
+    ResReStdDev = sqrt(ResReStdDevSum/(dpCountStart-1));
+    ResImStdDev = sqrt(ResImStdDevSum/(dpCountStart-1));
+
+    /* calculate combined standard deviation */
+    ResStdDev = sqrt(ResReStdDev*ResReStdDev+ResImStdDev*ResImStdDev)/2;
+
+    /* Use residual standard deviation to remove datapoints - always keep closest 4 datapoints */
+    for(dpNum = 0; dpNum < dataFreqs->length; dpNum++){
+
+      if(dpUsed->data[dpNum] == 1){ /* dont change currently unused points */
+
+        if( (fabs(ReResiduals->data[dpNum]) < inputParams->stddevthresh*(ResStdDev) &&
+            fabs(ImResiduals->data[dpNum]) < inputParams->stddevthresh*(ResStdDev)) || /* Keep if datapoint is within std devs */
+             inputParams->stddevthresh==0 || /* keep if threshold not set */
+            ( fabs(dataFreqs->data[dpNum]-fnew) < 2*deltaf)  ){ /* ensure keeping closest 4 points to fnew to keep signals */
+          dpUsed->data[dpNum] = 1;
+        }
+        else{
+          dpUsed->data[dpNum] = 0;
+        }
+      }/* close if datapoint is used loop*/
+
+    } /* close datapoint loop*/
+
+    /* count the number of datapoints being used after cleaning  */
+    for(dpNum=0; dpNum<dataLength; dpNum++ ){
+      dpCountEnd += dpUsed->data[dpNum];
+    }
+
+
+    if(dpCountStart == dpCountEnd) numReduced = 0; /* if no data points have been removed, exit the while loop */
+
+  } /* Close outlier removal while loop */
+
+  /* Destroy data and model structures to prevent memory leak */
+  XLALDestroyREAL8Vector(ReResiduals);
+  XLALDestroyREAL8Vector(ImResiduals);
+  XLALDestroyREAL8Vector(dataFreqs);
+  XLALDestroyREAL8Vector(ReDp);
+  XLALDestroyREAL8Vector(ImDp);
+  XLALDestroyREAL8Vector(ReMu);
+  XLALDestroyREAL8Vector(ImMu);
+  XLALDestroyREAL8Vector(MuMu);
+  XLALDestroyREAL8Vector(ReHf);
+  XLALDestroyREAL8Vector(ImHf);
+  XLALDestroyUINT4Vector(dpUsed);
+
+  bk->ReBk = InterpolatedRealValue;
+  bk->ImBk = InterpolatedImagValue;
+  bk->noise = ResStdDev*deltaf*LAL_SQRT2;
+  bk->status = SPLINTER_BK_OK;
+
+  return XLAL_SUCCESS;
+}
+
+/* Interpolate B_k for all pulsars in SFT sftnum; this is a LALThreadPool task */
+static int interpolate_sft( void *arg, size_t sftnum ){
+  const SplInterBatch *batch = (const SplInterBatch *)arg;
+  const REAL8 deltaf = batch->SFTdat->data->deltaF;
+  const REAL8 timestamp = XLALGPSGetREAL8(&batch->SFTdat->data[sftnum].epoch);
+  LIGOTimeGPS tgps, tgpsS, tgpsE;
+  UINT4 h = 0;
+
+  /* times at the middle, start and end of the SFT */
+  XLALGPSSetREAL8( &tgps, timestamp +  1./(2.*deltaf) );
+  XLALGPSSetREAL8( &tgpsE, timestamp +  1./(deltaf) );
+  XLALGPSSetREAL8( &tgpsS, timestamp );
+
+  /* Earth states at the middle, start and end of the SFT; these depend only on the */
+  /* ephemeris and time corrections, so are computed once for all pulsars sharing them */
+  EarthState *earth = XLALMalloc(3*batch->numpulsars*sizeof(*earth));
+  XLAL_CHECK( earth != NULL, XLAL_ENOMEM );
+
+  for (h=0; h<batch->numpulsars; h++){
+    EarthState *e = earth + 3*batch->earthIdx[h];
+    if ( batch->earthIdx[h] == h ){
+      XLALBarycenterEarthNew(&e[0], &tgps, batch->edat[h], batch->tdat[h], batch->ttype[h]);
+      XLALBarycenterEarthNew(&e[1], &tgpsS, batch->edat[h], batch->tdat[h], batch->ttype[h]);
+      XLALBarycenterEarthNew(&e[2], &tgpsE, batch->edat[h], batch->tdat[h], batch->ttype[h]);
+    }
+    if ( interpolate_pulsar_bk( batch, sftnum, h, &e[0], &e[1], &e[2], &batch->bk[sftnum*batch->numpulsars + h] ) != XLAL_SUCCESS ){
+      XLALFree(earth);
+      XLAL_ERROR( XLAL_EFUNC );
+    }
+  }
+
+  XLALFree(earth);
+
+  return XLAL_SUCCESS;
+}
+
 void get_input_args(InputParams *inputParams, int argc, char *argv[]){
   struct option long_options[] =
   {
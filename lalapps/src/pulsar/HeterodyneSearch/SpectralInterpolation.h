@@ -43,6 +43,7 @@
 #include <lal/XLALError.h>
 #include <lal/SFTfileIO.h>
 #include <lal/LALCache.h>
+#include <lal/LALThreadPool.h>
 /* lalapps header */
 #include <LALAppsVCSInfo.h>
 
@@ -109,6 +110,8 @@ for completeness (defaults for all are not to set the flag) \n"\
                         the solar system barycentre.\n"\
 " --output-timing (-t)  Flags whether to print timing information to\n\
                         stderr\n"\
+"\nThe SFTs of each segment are interpolated in parallel, using at most\n\
+LAL_NUM_THREADS threads (default: the number of processors).\n"\
 "\n"
 
 #define XLAL_FRESNEL_EPS 6.0e-8
@@ -169,6 +172,38 @@ typedef struct tagSplInterParams{
   CHAR sunfile[FILENAME_MAXLEN];
 }SplInterParams;
 
+/* status of the interpolation of B_k for one pulsar in one SFT */
+enum {
+  SPLINTER_BK_OK = 0,
+  SPLINTER_BK_OUT_OF_RANGE,     /* signal frequency outside of the SFT band */
+  SPLINTER_BK_NO_DATA           /* no datapoints around the signal frequency */
+};
+
+typedef struct tagSplInterBk{
+  REAL8 ReBk;
+  REAL8 ImBk;
+  REAL8 noise;
+  REAL8 fnew;                   /* signal frequency, if out of range */
+  INT4 status;
+}SplInterBk;
+
+/* the SFTs of a segment and the pulsars in their band, all interpolated together */
+typedef struct tagSplInterBatch{
+  const InputParams *inputParams;
+  const SplInterParams *splParams;
+  const SFTVector *SFTdat;
+  UINT4 numpulsars;
+  PulsarParameters **pulparams;
+  const REAL8 *baryAlpha;
+  const REAL8 *baryDelta;
+  const REAL8 *barydInv;
+  EphemerisData **edat;         /* ephemeris used for each pulsar */
+  TimeCorrectionData **tdat;    /* time corrections used for each pulsar */
+  const TimeCorrectionType *ttype;
+  const UINT4 *earthIdx;        /* first pulsar with the same ephemeris and time corrections */
+  SplInterBk *bk;               /* B_k for each SFT and pulsar, indexed by sftnum*numpulsars + h */
+}SplInterBatch;
+
 void get_input_args(InputParams *inputParam, int argc, char *argv[]);
 
 INT4 remove_outliers_using_running_median_data(REAL8Vector *redata, REAL8Vector *imdata,  REAL8Vector *rermdata,
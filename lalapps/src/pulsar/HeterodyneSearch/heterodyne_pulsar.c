@@ -109,6 +109,7 @@ int main(int argc, char *argv[]){
   hetParams.het = XLALReadTEMPOParFile( inputParams.paramfile );
   hetParams.hetUpdate = NULL;
   hetParams.outputPhase = inputParams.outputPhase;
+  hetParams.interpStep = inputParams.interpStep;
 
   /* set pulsar name - take from par file if available, or if not get from command line args */
   if( PulsarCheckParam( hetParams.het, "PSRJ" ) )
@@ -781,10 +782,11 @@ void get_input_args(InputParams *inputParams, int argc, char *argv[]){
     { "legacy-input",             no_argument,     NULL, 'L' },
     { "verbose",                  no_argument,     NULL, 'v' },
     { "output-phase",             no_argument,     NULL, 'P' },
+    { "interp-step",              required_argument,  0, 'I' },
     { 0, 0, 0, 0 }
   };
 
-  char args[] = "hi:p:z:f:g:k:s:r:d:D:c:o:e:S:t:l:R:C:F:O:T:m:G:H:M:ABbZLvP";
+  char args[] = "hi:p:z:f:g:k:s:r:d:D:c:o:e:S:t:l:R:C:F:O:T:m:G:H:M:ABbZLvPI:";
   char *program = argv[0];
 
   /* set defaults */
@@ -797,6 +799,7 @@ void get_input_args(InputParams *inputParams, int argc, char *argv[]){
   inputParams->binaryinput = 0; /* default to NOT read in data from a binary file */
   inputParams->legacyinput = 0; /* default is that input files are not legacy files without the header information */
   inputParams->outputPhase = 0; /* default to not output the phase evolution */
+  inputParams->interpStep = 0.; /* default to calculate time delays at every sample */
   inputParams->binaryoutput = 0; /* default is to output data as ASCII text */
   inputParams->gzipoutput = 0; /* default is to not gzip the output */
   inputParams->stddevthresh = 0.; /* default is not to threshold */
@@ -1008,6 +1011,9 @@ the pulsar parameter file */
       case 'P':
         inputParams->outputPhase = 1;
         break;
+      case 'I':
+        inputParams->interpStep = atof(LALoptarg);
+        break;
       case '?':
         fprintf(stderr, "unknown error while parsing options\n" );
 		break;
@@ -1048,6 +1054,11 @@ defined.\n");
     exit(1);
   }
 
+  if(inputParams->interpStep < 0.){
+    fprintf(stderr, "Error... interpolation step must be positive.\n");
+    exit(1);
+  }
+
   /* check that we're not trying to set a binary file input for a coarse
      heterodyne */
   if(inputParams->binaryinput){
@@ -1219,6 +1230,56 @@ void heterodyne_data(COMPLEX16TimeSeries *data, REAL8Vector *times,
     }
   }
 
+  /* set up grids of time delays to be interpolated, rather than calculating the delays at every sample */
+  TimeDelayGrid *gridHet = NULL, *gridUpdate = NULL;
+  REAL8Vector *phaseCycles = NULL;
+  if ( hetParams.interpStep > 0. && hetParams.length > 0 ){
+    REAL8 tstart = 0., tend = 0., tol = 0.;
+
+    if(hetParams.heterodyneflag == 0 || hetParams.heterodyneflag == 3){
+      tstart = hetParams.timestamp;
+      tend = hetParams.timestamp + (REAL8)(hetParams.length-1)/hetParams.samplerate;
+    }
+    else{
+      tstart = times->data[0];
+      tend = times->data[hetParams.length-1];
+    }
+
+    if(hetParams.heterodyneflag == 3 || hetParams.heterodyneflag == 4){
+      dtpos = hetParams.timestamp - posepoch;
+      baryinput.delta = dec + dtpos*pmdec;
+      baryinput.alpha = ra + dtpos*pmra/cos(baryinput.delta);
+
+      /* convert allowed phase error into an allowed time delay error (any error is allowed at zero frequency) */
+      tol = ( freqs->data[0] != 0. ) ? INTERPPHASETOL/fabs(freqfactor*freqs->data[0]) : HUGE_VAL;
+      XLAL_CHECK_VOID( (gridHet = create_time_delay_grid( tstart, tend, hetParams.interpStep, tol,
+        &baryinput, hetParams.het, edat, tdat, hetParams.ttype )) != NULL, XLAL_EFUNC );
+
+      if( verbose ){
+        fprintf(stderr, "Time delay grid spacing %.1lf s, maximum interpolation error %le s\n",
+          gridHet->step, gridHet->maxErr);
+      }
+    }
+
+    if(hetParams.heterodyneflag == 1 || hetParams.heterodyneflag == 2 || hetParams.heterodyneflag == 4){
+      dtpos = hetParams.timestamp - posepochu;
+      baryinput.delta = decu + dtpos*pmdecu;
+      baryinput.alpha = rau + dtpos*pmrau/cos(baryinput.delta);
+
+      tol = ( freqsu->data[0] != 0. ) ? INTERPPHASETOL/fabs(freqfactor*freqsu->data[0]) : HUGE_VAL;
+      XLAL_CHECK_VOID( (gridUpdate = create_time_delay_grid( tstart, tend, hetParams.interpStep, tol,
+        &baryinput, hetParams.hetUpdate, edat, tdat, hetParams.ttype )) != NULL, XLAL_EFUNC );
+
+      if( verbose ){
+        fprintf(stderr, "Time delay grid spacing %.1lf s, maximum interpolation error %le s\n",
+          gridUpdate->step, gridUpdate->maxErr);
+      }
+    }
+
+    /* phases (in cycles) to be applied to the data in one vectorised step */
+    XLAL_CHECK_VOID( (phaseCycles = XLALCreateREAL8Vector( hetParams.length )) != NULL, XLAL_EFUNC );
+  }
+
   if ( hetParams.outputPhase ){
     fpphase = fopen("phase.txt", "w");
   }
@@ -1250,27 +1311,38 @@ void heterodyne_data(COMPLEX16TimeSeries *data, REAL8Vector *times,
       else
         t = times->data[i];
 
-      XLALGPSSetREAL8(&baryinput.tgps, t);
+      if ( gridHet != NULL ){
+        /* interpolate the time delays */
+        REAL8 binDelay = 0.;
+        interpolate_time_delays( gridHet, t, &emit.deltaT, &binDelay, NULL, NULL );
+        XLALGPSSetREAL8(&emit.te, t + emit.deltaT);
+
+        tdt = (t - T0) + emit.deltaT + binDelay;
+        tdt_2 = (t - T0Update) + emit.deltaT + binDelay;
+      }
+      else{
+        XLALGPSSetREAL8(&baryinput.tgps, t);
 
-      XLAL_CHECK_VOID( XLALBarycenterEarthNew( &earth, &baryinput.tgps, edat, tdat, hetParams.ttype ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK_VOID( XLALBarycenter( &emit, &baryinput, &earth ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLAL_CHECK_VOID( XLALBarycenterEarthNew( &earth, &baryinput.tgps, edat, tdat, hetParams.ttype ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLAL_CHECK_VOID( XLALBarycenter( &emit, &baryinput, &earth ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-      /* if binary pulsar add extra time delay */
-      if ( PulsarCheckParam( hetParams.het, "BINARY" ) ){
-        /* input SSB time into binary timing function */
-        binInput.tb = t + emit.deltaT;
-        binInput.earth = earth;
+        /* if binary pulsar add extra time delay */
+        if ( PulsarCheckParam( hetParams.het, "BINARY" ) ){
+          /* input SSB time into binary timing function */
+          binInput.tb = t + emit.deltaT;
+          binInput.earth = earth;
 
-        /* calculate binary time delay */
-        XLALBinaryPulsarDeltaTNew( &binOutput, &binInput, hetParams.het );
+          /* calculate binary time delay */
+          XLALBinaryPulsarDeltaTNew( &binOutput, &binInput, hetParams.het );
 
-        /* add binary time delay */
-        tdt = (t - T0) + emit.deltaT +  binOutput.deltaT;
-        tdt_2 = (t - T0Update) + emit.deltaT +  binOutput.deltaT;
-      }
-      else{
-        tdt = t - T0 + emit.deltaT;
-        tdt_2 = t - T0Update + emit.deltaT;
+          /* add binary time delay */
+          tdt = (t - T0) + emit.deltaT +  binOutput.deltaT;
+          tdt_2 = (t - T0Update) + emit.deltaT +  binOutput.deltaT;
+        }
+        else{
+          tdt = t - T0 + emit.deltaT;
+          tdt_2 = t - T0Update + emit.deltaT;
+        }
       }
 
       /* add the effect of a variable gravitational wave speed */
@@ -1362,39 +1434,53 @@ void heterodyne_data(COMPLEX16TimeSeries *data, REAL8Vector *times,
       t = times->data[i]; /* get data time */
       t2 = times->data[i] + 1.; /* just add a second to get the gradient */
 
-      baryinput2 = baryinput;
-
-      XLALGPSSetREAL8(&baryinput.tgps, t);
-      XLALGPSSetREAL8(&baryinput2.tgps, t2);
-
-      XLAL_CHECK_VOID( XLALBarycenterEarthNew( &earth, &baryinput.tgps, edat,
-        tdat, hetParams.ttype ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK_VOID( XLALBarycenter( &emit, &baryinput, &earth ) ==
-                       XLAL_SUCCESS, XLAL_EFUNC );
+      if ( gridUpdate != NULL ){
+        /* interpolate the time delays and their gradients */
+        REAL8 dssbDelay = 0., dbinDelay = 0.;
+        interpolate_time_delays( gridUpdate, t, &emit.deltaT, &binOutput.deltaT, &dssbDelay, &dbinDelay );
+        XLALGPSSetREAL8(&emit.te, t + emit.deltaT);
 
-      XLAL_CHECK_VOID( XLALBarycenterEarthNew( &earth2, &baryinput2.tgps, edat,
-        tdat, hetParams.ttype ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK_VOID( XLALBarycenter( &emit2, &baryinput2, &earth2 ) ==
-                       XLAL_SUCCESS, XLAL_EFUNC );
+        /* delays one second later */
+        emit2.deltaT = emit.deltaT + dssbDelay;
+        binOutput2.deltaT = binOutput.deltaT + dbinDelay;
 
-      /* if binary pulsar add extra time delay */
-      if( PulsarCheckParam( hetParams.hetUpdate, "BINARY" ) ){
-        /* input SSB time into binary timing function */
-        binInput.tb = t + emit.deltaT;
-        binInput2.tb = t2 + emit2.deltaT;
-        binInput.earth = binInput2.earth = earth;
-
-        /* calculate binary time delay */
-        XLALBinaryPulsarDeltaTNew( &binOutput, &binInput, hetParams.hetUpdate );
-        XLALBinaryPulsarDeltaTNew( &binOutput2, &binInput2, hetParams.hetUpdate );
-
-        /* add binary time delay */
         tdt = (t - T0Update) + emit.deltaT + binOutput.deltaT;
       }
       else{
-        tdt = (t - T0Update) + emit.deltaT;
-        binOutput.deltaT = 0.;
-        binOutput2.deltaT = 0.;
+        baryinput2 = baryinput;
+
+        XLALGPSSetREAL8(&baryinput.tgps, t);
+        XLALGPSSetREAL8(&baryinput2.tgps, t2);
+
+        XLAL_CHECK_VOID( XLALBarycenterEarthNew( &earth, &baryinput.tgps, edat,
+          tdat, hetParams.ttype ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLAL_CHECK_VOID( XLALBarycenter( &emit, &baryinput, &earth ) ==
+                         XLAL_SUCCESS, XLAL_EFUNC );
+
+        XLAL_CHECK_VOID( XLALBarycenterEarthNew( &earth2, &baryinput2.tgps, edat,
+          tdat, hetParams.ttype ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLAL_CHECK_VOID( XLALBarycenter( &emit2, &baryinput2, &earth2 ) ==
+                         XLAL_SUCCESS, XLAL_EFUNC );
+
+        /* if binary pulsar add extra time delay */
+        if( PulsarCheckParam( hetParams.hetUpdate, "BINARY" ) ){
+          /* input SSB time into binary timing function */
+          binInput.tb = t + emit.deltaT;
+          binInput2.tb = t2 + emit2.deltaT;
+          binInput.earth = binInput2.earth = earth;
+
+          /* calculate binary time delay */
+          XLALBinaryPulsarDeltaTNew( &binOutput, &binInput, hetParams.hetUpdate );
+          XLALBinaryPulsarDeltaTNew( &binOutput2, &binInput2, hetParams.hetUpdate );
+
+          /* add binary time delay */
+          tdt = (t - T0Update) + emit.deltaT + binOutput.deltaT;
+        }
+        else{
+          tdt = (t - T0Update) + emit.deltaT;
+          binOutput.deltaT = 0.;
+          binOutput2.deltaT = 0.;
+        }
       }
 
       /* check if any timing noise whitening is used */
@@ -1495,10 +1581,37 @@ void heterodyne_data(COMPLEX16TimeSeries *data, REAL8Vector *times,
       fprintf(fpphase, "%.9lf\n", deltaphase);
     }
 
-    data->data->data[i] = (creal(dataTemp)*cos(-deltaphase) - cimag(dataTemp)*sin(-deltaphase)) +
-      I * (creal(dataTemp)*sin(-deltaphase) + cimag(dataTemp)*cos(-deltaphase));
+    if ( phaseCycles != NULL ){
+      /* store phase to be applied after the loop */
+      phaseCycles->data[i] = deltaphase/LAL_TWOPI;
+      data->data->data[i] = dataTemp;
+    }
+    else{
+      data->data->data[i] = (creal(dataTemp)*cos(-deltaphase) - cimag(dataTemp)*sin(-deltaphase)) +
+        I * (creal(dataTemp)*sin(-deltaphase) + cimag(dataTemp)*cos(-deltaphase));
+    }
+  }
+
+  /* perform the heterodyne rotation with vectorised sin and cos */
+  if ( phaseCycles != NULL ){
+    REAL8Vector *sinphi = NULL, *cosphi = NULL;
+    XLAL_CHECK_VOID( (sinphi = XLALCreateREAL8Vector( hetParams.length )) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_VOID( (cosphi = XLALCreateREAL8Vector( hetParams.length )) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_VOID( XLALVectorSinCos2PiREAL8( sinphi->data, cosphi->data, phaseCycles->data,
+      hetParams.length ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    for( i=0; i<hetParams.length; i++ ){
+      data->data->data[i] *= (cosphi->data[i] - I*sinphi->data[i]);
+    }
+
+    XLALDestroyREAL8Vector( sinphi );
+    XLALDestroyREAL8Vector( cosphi );
+    XLALDestroyREAL8Vector( phaseCycles );
   }
 
+  destroy_time_delay_grid( gridHet );
+  destroy_time_delay_grid( gridUpdate );
+
   if(hetParams.heterodyneflag > 0){
     XLALDestroyEphemerisData( edat );
 
@@ -1511,6 +1624,142 @@ void heterodyne_data(COMPLEX16TimeSeries *data, REAL8Vector *times,
   }
 }
 
+/* function to calculate the solar system barycentring time delay and, for binary pulsars, the
+   binary system time delay for data at detector time t */
+void get_time_delays( REAL8 t, BarycenterInput *baryinput, PulsarParameters *params,
+  EphemerisData *edat, TimeCorrectionData *tdat, TimeCorrectionType ttype, REAL8 *ssbDelay,
+  REAL8 *binDelay ){
+  EarthState earth;
+  EmissionTime emit;
+
+  XLALGPSSetREAL8(&baryinput->tgps, t);
+
+  XLAL_CHECK_VOID( XLALBarycenterEarthNew( &earth, &baryinput->tgps, edat, tdat, ttype ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_VOID( XLALBarycenter( &emit, baryinput, &earth ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  *ssbDelay = emit.deltaT;
+  *binDelay = 0.;
+
+  /* if binary pulsar add extra time delay */
+  if ( PulsarCheckParam( params, "BINARY" ) ){
+    BinaryPulsarInput binInput;
+    BinaryPulsarOutput binOutput;
+
+    /* input SSB time into binary timing function */
+    binInput.tb = t + emit.deltaT;
+    binInput.earth = earth;
+
+    XLALBinaryPulsarDeltaTNew( &binOutput, &binInput, params );
+    *binDelay = binOutput.deltaT;
+  }
+}
+
+
+/* function to create a grid of time delays, with spacing step, covering the times from tstart to
+   tend. The interpolation error is estimated at the mid-point of each grid interval and, if it is
+   larger than tol (in seconds), the grid spacing is halved (up to INTERPMAXREFINE times). Points
+   are added either side of the range so that interpolate_time_delays() can always use four grid
+   points. */
+TimeDelayGrid *create_time_delay_grid( REAL8 tstart, REAL8 tend, REAL8 step, REAL8 tol,
+  BarycenterInput *baryinput, PulsarParameters *params, EphemerisData *edat,
+  TimeCorrectionData *tdat, TimeCorrectionType ttype ){
+  TimeDelayGrid *grid = NULL;
+  UINT4 refine = 0;
+
+  XLAL_CHECK_NULL( step > 0., XLAL_EINVAL, "Grid spacing must be positive\n" );
+  XLAL_CHECK_NULL( tend >= tstart, XLAL_EINVAL, "Grid end time must not be before its start time\n" );
+
+  do{
+    destroy_time_delay_grid( grid );
+
+    UINT4 npoints = (UINT4)floor( (tend - tstart)/step ) + 4;
+
+    XLAL_CHECK_NULL( (grid = XLALCalloc( 1, sizeof(*grid) )) != NULL, XLAL_ENOMEM );
+    XLAL_CHECK_NULL( (grid->ssbDelay = XLALCreateREAL8Vector( npoints )) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_NULL( (grid->binDelay = XLALCreateREAL8Vector( npoints )) != NULL, XLAL_EFUNC );
+    grid->tstart = tstart - step;
+    grid->step = step;
+    grid->maxErr = 0.;
+
+    for ( UINT4 j = 0; j < npoints; j++ ){
+      get_time_delays( grid->tstart + (REAL8)j*step, baryinput, params, edat, tdat, ttype,
+        &grid->ssbDelay->data[j], &grid->binDelay->data[j] );
+      XLAL_CHECK_NULL( xlalErrno == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+
+    /* check the interpolation error at the mid-point of each interval in use */
+    for ( UINT4 j = 1; j < npoints - 2; j++ ){
+      REAL8 tmid = grid->tstart + ((REAL8)j + 0.5)*step;
+      REAL8 ssbDelay = 0., binDelay = 0., ssbInterp = 0., binInterp = 0.;
+
+      get_time_delays( tmid, baryinput, params, edat, tdat, ttype, &ssbDelay, &binDelay );
+      XLAL_CHECK_NULL( xlalErrno == XLAL_SUCCESS, XLAL_EFUNC );
+      interpolate_time_delays( grid, tmid, &ssbInterp, &binInterp, NULL, NULL );
+
+      REAL8 err = fabs( (ssbDelay + binDelay) - (ssbInterp + binInterp) );
+      if ( err > grid->maxErr ) { grid->maxErr = err; }
+    }
+
+    step /= 2.;
+  }while( grid->maxErr > tol && ++refine <= INTERPMAXREFINE );
+
+  if ( grid->maxErr > tol ){
+    XLALPrintWarning("%s: time delay interpolation error %le s is larger than the tolerance %le s\n",
+      __func__, grid->maxErr, tol );
+  }
+
+  return grid;
+}
+
+
+/* function to interpolate the time delays (and, if requested, their time derivatives) at time t
+   using cubic Lagrange interpolation between the four grid points surrounding t */
+void interpolate_time_delays( const TimeDelayGrid *grid, REAL8 t, REAL8 *ssbDelay,
+  REAL8 *binDelay, REAL8 *dssbDelay, REAL8 *dbinDelay ){
+  REAL8 x = (t - grid->tstart)/grid->step;
+  INT4 j = (INT4)floor(x);
+  INT4 jmax = (INT4)grid->ssbDelay->length - 3;
+
+  /* make sure four points are always available */
+  if ( j < 1 ) { j = 1; }
+  if ( j > jmax ) { j = jmax; }
+
+  REAL8 u = x - (REAL8)j, u2 = u*u;
+  REAL8 w[4], dw[4];
+
+  /* Lagrange weights for grid points j-1, j, j+1 and j+2, and their derivatives */
+  w[0] = -u*(u - 1.)*(u - 2.)/6.;
+  w[1] = (u + 1.)*(u - 1.)*(u - 2.)/2.;
+  w[2] = -(u + 1.)*u*(u - 2.)/2.;
+  w[3] = (u + 1.)*u*(u - 1.)/6.;
+
+  const REAL8 *ssb = &grid->ssbDelay->data[j-1], *bin = &grid->binDelay->data[j-1];
+
+  *ssbDelay = w[0]*ssb[0] + w[1]*ssb[1] + w[2]*ssb[2] + w[3]*ssb[3];
+  *binDelay = w[0]*bin[0] + w[1]*bin[1] + w[2]*bin[2] + w[3]*bin[3];
+
+  if ( dssbDelay != NULL && dbinDelay != NULL ){
+    dw[0] = -(3.*u2 - 6.*u + 2.)/(6.*grid->step);
+    dw[1] = (3.*u2 - 4.*u - 1.)/(2.*grid->step);
+    dw[2] = -(3.*u2 - 2.*u - 2.)/(2.*grid->step);
+    dw[3] = (3.*u2 - 1.)/(6.*grid->step);
+
+    *dssbDelay = dw[0]*ssb[0] + dw[1]*ssb[1] + dw[2]*ssb[2] + dw[3]*ssb[3];
+    *dbinDelay = dw[0]*bin[0] + dw[1]*bin[1] + dw[2]*bin[2] + dw[3]*bin[3];
+  }
+}
+
+
+/* function to free memory for the time delay grid */
+void destroy_time_delay_grid( TimeDelayGrid *grid ){
+  if ( grid == NULL ) { return; }
+
+  XLALDestroyREAL8Vector( grid->ssbDelay );
+  XLALDestroyREAL8Vector( grid->binDelay );
+  XLALFree( grid );
+}
+
+
 /* function to extract the frame time and duration from the file name */
 void get_frame_times(CHAR *framefile, REAL8 *gpstime, INT4 *duration){
   INT4 j=0;
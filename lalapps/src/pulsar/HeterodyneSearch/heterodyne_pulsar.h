@@ -69,6 +69,7 @@
 #include <lal/Units.h>
 #include <lal/TimeSeries.h>
 #include <lal/XLALError.h>
+#include <lal/VectorMath.h>
 
 /* lalapps header */
 #include <LALAppsVCSInfo.h>
@@ -134,6 +135,12 @@ extern "C" {
                           if not this suffix will be appended\n"\
 " --output-phase (-P)      if set, output the phase evolution to a text file\n\
                           (for debugging purposes)\n"\
+" --interp-step (-I)       if set, evaluate the solar system and binary time\n\
+                          delays on a grid with this spacing (in seconds) and\n\
+                          interpolate them to the data times rather than\n\
+                          calculating them at every sample. The spacing is\n\
+                          reduced if needed to keep the interpolation phase\n\
+                          error below INTERPPHASETOL cycles\n"\
 "\n"
 
 #define MAXDATALENGTH 256   /* maximum length of data to be read from frames */
@@ -145,6 +152,9 @@ extern "C" {
 
 #define FILTERFFTTIME 200
 
+#define INTERPPHASETOL 1e-4 /* maximum allowed phase error (cycles) from interpolating time delays */
+#define INTERPMAXREFINE 10  /* maximum number of times the time delay grid spacing will be halved */
+
 #define HEADERSIZE 2048 /* number of bytes in header for output files */
 
 /* define structures */
@@ -205,6 +215,7 @@ typedef struct tagInputParams{
   INT4 gzipoutput;
   INT4 legacyinput;
   INT4 outputPhase;
+  REAL8 interpStep;
 }InputParams;
 
 typedef struct tagHeterodyneParams{
@@ -224,8 +235,18 @@ typedef struct tagHeterodyneParams{
   CHAR *timeCorrFile;
   TimeCorrectionType ttype;
   INT4 outputPhase;
+  REAL8 interpStep; /* spacing of time delay interpolation grid (0 for no interpolation) */
 }HeterodyneParams;
 
+/* structure to hold time delays calculated on a regular grid of detector times */
+typedef struct tagTimeDelayGrid{
+  REAL8 tstart; /* time of first grid point */
+  REAL8 step; /* spacing between grid points (s) */
+  REAL8Vector *ssbDelay; /* solar system barycentring time delay at each grid point */
+  REAL8Vector *binDelay; /* binary system time delay at each grid point */
+  REAL8 maxErr; /* maximum interpolation error found at the interval mid-points (s) */
+}TimeDelayGrid;
+
 typedef struct tagFilters{
   REAL8IIRFilter *filter1Re; /* filters for real and imaginary parts of heterodyed data */
   REAL8IIRFilter *filter1Im;
@@ -287,6 +308,23 @@ FilterResponse *create_filter_response( REAL8 filterKnee );
 /* free memory for filter response structure */
 void destroy_filter_response( FilterResponse *filtresp );
 
+/* calculate the solar system and binary time delays at a given detector time */
+void get_time_delays( REAL8 t, BarycenterInput *baryinput, PulsarParameters *params,
+  EphemerisData *edat, TimeCorrectionData *tdat, TimeCorrectionType ttype, REAL8 *ssbDelay,
+  REAL8 *binDelay );
+
+/* create a grid of time delays covering the times [tstart, tend] */
+TimeDelayGrid *create_time_delay_grid( REAL8 tstart, REAL8 tend, REAL8 step, REAL8 tol,
+  BarycenterInput *baryinput, PulsarParameters *params, EphemerisData *edat,
+  TimeCorrectionData *tdat, TimeCorrectionType ttype );
+
+/* interpolate the time delays, and optionally their time derivatives, at a given time */
+void interpolate_time_delays( const TimeDelayGrid *grid, REAL8 t, REAL8 *ssbDelay,
+  REAL8 *binDelay, REAL8 *dssbDelay, REAL8 *dbinDelay );
+
+/* free memory for time delay grid */
+void destroy_time_delay_grid( TimeDelayGrid *grid );
+
 #ifdef  __cplusplus
 }
 #endif
@@ -32,6 +32,16 @@
 
 #define SQUARE(x) ( (x) * (x) )
 
+/* names of the parameters that only change the signal amplitude model, and not its phase evolution */
+static const CHAR *amplitudeParameters[] = {
+  "H0", "H0_F", "Q22", "I21", "I31", "LAMBDA", "COSTHETA", "PHI0", "COSIOTA", "IOTA", "PSI",
+  "C21", "C22", "PHI21", "PHI22",
+  "HPLUS", "HCROSS", "HSCALARB", "HSCALARL", "HVECTORX", "HVECTORY",
+  "PHI0SCALAR", "PSISCALAR", "PHI0VECTOR", "PSIVECTOR", "PHI0TENSOR", "PSITENSOR",
+  "HPLUS_F", "HCROSS_F", "HSCALARB_F", "HSCALARL_F", "HVECTORX_F", "HVECTORY_F",
+  "PHI0SCALAR_F", "PSISCALAR_F", "PHI0VECTOR_F", "PSIVECTOR_F", "PHI0TENSOR_F", "PSITENSOR_F",
+  NULL };
+
 /******************************************************************************/
 /*                            MODEL FUNCTIONS                                 */
 /******************************************************************************/
@@ -388,66 +398,30 @@ void add_variable_parameter( PulsarParameters *params, LALInferenceVariables *va
  * emission at the rotation frequency <i>and</i> twice the rotation frequency. Depending on the specified model the
  * function calls the appropriate model function.
  *
- * Firstly the time varying amplitude of the signal will be calculated based on the antenna pattern and amplitude
- * parameters. Then, if searching over phase parameters, the phase evolution of the signal will be calculated. The
- * difference between the new phase model, \f$\phi(t)_n\f$, and that used to heterodyne the data, \f$\phi(t)_h\f$,
- * will be calculated and the complex signal model, \f$M\f$, modified accordingly:
+ * The time varying amplitude of the signal is calculated based on the antenna pattern and amplitude parameters. If
+ * searching over phase parameters, the phase evolution of the signal will be also be included. The difference between
+ * the new phase model, \f$\phi(t)_n\f$, and that used to heterodyne the data, \f$\phi(t)_h\f$, will be calculated
+ * and the complex signal model, \f$M\f$, modified accordingly:
  * \f[
  * M'(t) = M(t)\exp{i((\phi(t)_n - \phi(t)_h))}.
  * \f]
  * This does not try to undo the signal modulation in the data, but instead replicates the modulation in the model,
  * hence the positive phase difference rather than a negative phase in the exponential function.
  *
+ * As \f$M(t)\f$ is a linear combination of the antenna patterns, the antenna patterns multiplied by the phase
+ * factor are cached (see \c get_model_basis) and only recalculated when a parameter affecting the phase changes.
+ *
  * \param params [in] A \c PulsarParameters structure containing the model parameters
  * \param ifo [in] The ifo model structure containing the detector paramters and buffers
  *
  * \sa get_amplitude_model
  * \sa get_phase_model
+ * \sa get_model_basis
  */
 void pulsar_model( PulsarParameters *params, LALInferenceIFOModel *ifo ){
-  INT4 i = 0, length = 0;
-  UINT4 j = 0;
-  LALInferenceIFOModel *ifomodel1 = ifo, *ifomodel2 = ifo;
-
-  /* get the amplitude model */
-  get_amplitude_model( params, ifomodel1 );
-
-  /* check whether to search over the phase parameters or not - this only needs to be set for the
-   * first ifo linked list in at set for a given detector (i.e. it doesn't need to be set for
-   * different frequency streams */
-  if ( LALInferenceCheckVariable( ifomodel2->params, "varyphase" ) ) {
-    /* get difference in phase for f component and perform extra heterodyne */
-    REAL8Vector *freqFactors = NULL;
-    freqFactors = *(REAL8Vector **)LALInferenceGetVariable( ifo->params, "freqfactors" );
-
-    while ( ifomodel2 ){
-      for( j = 0; j < freqFactors->length; j++ ){
-        REAL8Vector *dphi = NULL;
-        COMPLEX16 M = 0., expp = 0.;
-
-        length = ifomodel2->compTimeSignal->data->length;
-
-        /* reheterodyne with the phase */
-        if ( (dphi = get_phase_model( params, ifomodel2, freqFactors->data[j] )) != NULL ){
-          for( i=0; i<length; i++ ){
-            /* phase factor by which to multiply the (almost) DC signal model. NOTE: this does not try to undo
-             * the signal modulation in the data, but instead replicates it in the model, hence the positive
-             * phase rather than a negative phase in the cexp function. */
-            expp = cexp( LAL_TWOPI * I * dphi->data[i] );
-
-            M = ifomodel2->compTimeSignal->data->data[i];
-
-            /* heterodyne */
-            ifomodel2->compTimeSignal->data->data[i] = M * expp;
-          }
-
-          XLALDestroyREAL8Vector( dphi );
-        }
-
-        ifomodel2 = ifomodel2->next;
-      }
-    }
-  }
+  /* get the amplitude model (for a full time domain model this includes the phase evolution, which is held in the
+   * cached model basis time series - see get_model_basis) */
+  get_amplitude_model( params, ifo );
 }
 
 
@@ -883,9 +857,9 @@ REAL8Vector *get_glitch_phase( PulsarParameters *pars, LIGOTimeGPSVector *datati
  *
  */
 void get_amplitude_model( PulsarParameters *pars, LALInferenceIFOModel *ifo ){
-  UINT4 i = 0, j = 0, length;
+  UINT4 i = 0, j = 0, k = 0, length;
 
-  REAL8 T, twopsi;
+  REAL8 twopsi;
   REAL8 cosiota = PulsarGetREAL8ParamOrZero( pars, "COSIOTA" );
   REAL8 siniota = sin(acos(cosiota));
   REAL8 s2psi = 0., c2psi = 0., spsi = 0., cpsi = 0.;
@@ -979,125 +953,239 @@ void get_amplitude_model( PulsarParameters *pars, LALInferenceIFOModel *ifo ){
         XLAL_ERROR_VOID( XLAL_EINVAL, "Error... currently unknown frequency factor (%.2lf) for models.", freqFactors->data[j] );
       }
 
+      /* for tensor-only models (e.g. the default of GR) calculate the two components of the single model value -
+       * things multiplied by a(t) and things multiplied by b(t) (both these will have real and imaginary components),
+       * and for non-GR models also the vector and scalar components. NOTE: these are not supposed to be identical to
+       * the above relationships between the amplitudes and polarisation angles, as these are the multiplicative
+       * coefficients of the antenna pattern time series (or their summations). */
+      UINT4 nbasis = nonGR ? 6 : 2;
+      COMPLEX16 coeffs[6];
+
+      coeffs[0] = (Cplus*c2psi - Ccross*s2psi);
+      coeffs[1] = (Cplus*s2psi + Ccross*c2psi);
+      if ( nonGR ){
+        coeffs[2] = (Cx*cpsi - Cy*spsi);
+        coeffs[3] = (Cx*spsi + Cy*cpsi);
+        coeffs[4] = Cb;
+        coeffs[5] = Cl;
+      }
+
       if ( varyphase || roq ){ /* have to compute the full time domain signal */
-        REAL8Vector *sidDayFrac = NULL;
-        REAL8 tsv, tsteps;
+        /* get the (cached) antenna pattern time series multiplied by the phase factor */
+        const COMPLEX16Vector *basis = get_model_basis( pars, ifo, freqFactors->data[j], nbasis );
+        if ( basis == NULL ){
+          XLAL_ERROR_VOID( XLAL_EFUNC, "Error... could not calculate signal model basis." );
+        }
 
-        REAL8Vector *LUfplus = NULL, *LUfcross = NULL, *LUfx = NULL, *LUfy = NULL, *LUfb = NULL, *LUfl = NULL;
+        length = ifo->times->length;
+        COMPLEX16 *signal = ifo->compTimeSignal->data->data;
 
-        /* set lookup table parameters */
-        tsteps = (REAL8)(*(INT4*)LALInferenceGetVariable( ifo->params, "timeSteps" ));
-        tsv = LAL_DAYSID_SI / tsteps;
+        /* the model is a linear combination of the basis time series */
+        for( i=0; i<length; i++ ){ signal[i] = coeffs[0] * basis->data[i]; }
+        for( k=1; k<nbasis; k++ ){
+          const COMPLEX16 *bk = basis->data + k*length;
+          for( i=0; i<length; i++ ){ signal[i] += coeffs[k] * bk[i]; }
+        }
+      }
+      else{ /* just have to calculate the values to multiply the pre-summed data */
+        /* first check that compTimeSignal has been reduced in size to just hold these values */
+        if ( ifo->compTimeSignal->data->length != nbasis ){ /* otherwise resize it */
+          ifo->compTimeSignal = XLALResizeCOMPLEX16TimeSeries( ifo->compTimeSignal, 0, nbasis );
+        }
 
-        LUfplus = *(REAL8Vector **)LALInferenceGetVariable( ifo->params, "a_response_tensor" );
-        LUfcross = *(REAL8Vector **)LALInferenceGetVariable( ifo->params, "b_response_tensor" );
+        for( k=0; k<nbasis; k++ ){ ifo->compTimeSignal->data->data[k] = coeffs[k]; }
+      }
 
-        if ( nonGR ){
-          LUfx = *(REAL8Vector **)LALInferenceGetVariable( ifo->params, "a_response_vector" );
-          LUfy = *(REAL8Vector **)LALInferenceGetVariable( ifo->params, "b_response_vector" );
-          LUfb = *(REAL8Vector **)LALInferenceGetVariable( ifo->params, "a_response_scalar" );
-          LUfl = *(REAL8Vector **)LALInferenceGetVariable( ifo->params, "b_response_scalar" );
-        }
+      ifo = ifo->next;
+    }
+  }
+}
 
-        /* get the sidereal time since the initial data point % sidereal day */
-        sidDayFrac = *(REAL8Vector**)LALInferenceGetVariable( ifo->params, "siderealDay" );
 
-        length = ifo->times->length;
+/**
+ * \brief Check whether a parameter only affects the signal amplitude model
+ *
+ * \param name [in] The parameter name
+ *
+ * \return 1 if the parameter is in the list of amplitude-only parameters, 0 otherwise
+ */
+static INT4 is_amplitude_parameter( const CHAR *name ){
+  for ( UINT4 i = 0; amplitudeParameters[i] != NULL; i++ ){
+    if ( !strcmp( name, amplitudeParameters[i] ) ){ return 1; }
+  }
+  return 0;
+}
 
-        for( i=0; i<length; i++ ){
-          REAL8 plus00, plus01, cross00, cross01, plus = 0., cross = 0.;
-          REAL8 x00, x01, y00, y01, b00, b01, l00, l01;
-          REAL8 timeScaled, timeMin, timeMax;
-          REAL8 plusT = 0., crossT = 0., x = 0., y = 0., xT = 0., yT = 0., b = 0., l = 0.;
-          INT4 timebinMin, timebinMax;
-
-          /* set the time bin for the lookup table */
-          /* sidereal day in secs*/
-          T = sidDayFrac->data[i];
-          timebinMin = (INT4)fmod( floor(T / tsv), tsteps );
-          timeMin = timebinMin*tsv;
-          timebinMax = (INT4)fmod( timebinMin + 1, tsteps );
-          timeMax = timeMin + tsv;
-
-          /* get values of matrix for linear interpolation */
-          plus00 = LUfplus->data[timebinMin];
-          plus01 = LUfplus->data[timebinMax];
-
-          cross00 = LUfcross->data[timebinMin];
-          cross01 = LUfcross->data[timebinMax];
-
-          /* rescale time for linear interpolation on a unit square */
-          timeScaled = (T - timeMin)/(timeMax - timeMin);
-
-          plus = plus00 + (plus01-plus00)*timeScaled;
-          cross = cross00 + (cross01-cross00)*timeScaled;
-
-          plusT = plus*c2psi + cross*s2psi;
-          crossT = cross*c2psi - plus*s2psi;
-
-          if ( nonGR ){
-            x00 = LUfx->data[timebinMin];
-            x01 = LUfx->data[timebinMax];
-            y00 = LUfy->data[timebinMin];
-            y01 = LUfy->data[timebinMax];
-            b00 = LUfb->data[timebinMin];
-            b01 = LUfb->data[timebinMax];
-            l00 = LUfl->data[timebinMin];
-            l01 = LUfl->data[timebinMax];
-
-            x = x00 + (x01-x00)*timeScaled;
-            y = y00 + (y01-y00)*timeScaled;
-            b = b00 + (b01-b00)*timeScaled;
-            l = l00 + (l01-l00)*timeScaled;
-
-            xT = x*cpsi + y*spsi;
-            yT = y*cpsi - x*spsi;
-          }
 
-          /* create the complex signal amplitude model appropriate for the harmonic */
-          ifo->compTimeSignal->data->data[i] = ( Cplus * plusT ) + ( Ccross * crossT );
+/**
+ * \brief Create the key identifying the signal model basis time series
+ *
+ * The key holds the values of all the parameters that affect the signal phase (i.e. all \c REAL8 and \c REAL8Vector
+ * parameters that are not amplitude-only parameters) along with the settings of the given ifo model that change how
+ * the basis is calculated (the number of basis vectors, frequency factor, time stamps and whether the phase, sky
+ * position, binary or glitch parameters are being varied).
+ *
+ * \param params [in] A set of pulsar parameters
+ * \param ifo [in] The ifo model containing detector-specific parameters
+ * \param freqFactor [in] The multiple of the pulsar rotation frequency at which the emission is
+ * \param nbasis [in] The number of basis time series
+ *
+ * \return A vector of values defining the basis
+ */
+static REAL8Vector *get_model_basis_key( PulsarParameters *params, LALInferenceIFOModel *ifo, REAL8 freqFactor,
+                                         UINT4 nbasis ){
+  UINT4 nkey = 10;
+  PulsarParam *par = NULL;
+
+  /* count the parameter values */
+  for ( par = params->head; par != NULL; par = par->next ){
+    if ( is_amplitude_parameter( par->name ) ){ continue; }
+    if ( par->type == PULSARTYPE_REAL8_t ){ nkey++; }
+    else if ( par->type == PULSARTYPE_REAL8Vector_t ){ nkey += (*(REAL8Vector **)par->value)->length; }
+  }
+
+  REAL8Vector *key = XLALCreateREAL8Vector( nkey );
+  if ( key == NULL ){ XLAL_ERROR_NULL( XLAL_EFUNC ); }
+
+  UINT4 length = ifo->times->length;
+  key->data[0] = (REAL8)nbasis;
+  key->data[1] = freqFactor;
+  key->data[2] = (REAL8)length;
+  key->data[3] = length > 0 ? XLALGPSGetREAL8( &ifo->times->data[0] ) : 0.;
+  key->data[4] = length > 0 ? XLALGPSGetREAL8( &ifo->times->data[length-1] ) : 0.;
+  key->data[5] = (REAL8)LALInferenceCheckVariable( ifo->params, "varyphase" );
+  key->data[6] = (REAL8)LALInferenceCheckVariable( ifo->params, "varyskypos" );
+  key->data[7] = (REAL8)LALInferenceCheckVariable( ifo->params, "varybinary" );
+  key->data[8] = (REAL8)LALInferenceCheckVariable( ifo->params, "varyglitch" );
+  key->data[9] = (REAL8)( ifo->ephem != NULL );
+
+  UINT4 n = 10;
+  for ( par = params->head; par != NULL; par = par->next ){
+    if ( is_amplitude_parameter( par->name ) ){ continue; }
+    if ( par->type == PULSARTYPE_REAL8_t ){ key->data[n++] = *(REAL8 *)par->value; }
+    else if ( par->type == PULSARTYPE_REAL8Vector_t ){
+      const REAL8Vector *vals = *(REAL8Vector **)par->value;
+      for ( UINT4 i = 0; i < vals->length; i++ ){ key->data[n++] = vals->data[i]; }
+    }
+  }
 
-          /* add non-GR components if required */
-          if ( nonGR ){ ifo->compTimeSignal->data->data[i] += ( Cx*xT ) + ( Cy*yT ) + Cb*b + Cl*l; }
-        }
-      }
-      else{ /* just have to calculate the values to multiply the pre-summed data */
-        /* for tensor-only models (e.g. the default of GR) calculate the two components of
-         * the single model value - things multiplied by a(t) and things multiplied by b(t)
-         * (both these will have real and imaginary components). NOTE: the values input into
-         * ifo->compTimeSignal->data->data are not supposed to be identical to the above
-         * relationships between the amplitudes and polarisation angles, as these are the
-         * multiplicative coefficients of the a(t) and b(t) summations.
-         */
-
-        /* put multiples of a(t) in first value and b(t) in second */
-        if ( !nonGR ){
-          /* first check that compTimeSignal has been reduced in size to just hold these two values */
-          if ( ifo->compTimeSignal->data->length != 2 ){ /* otherwise resize it */
-            ifo->compTimeSignal = XLALResizeCOMPLEX16TimeSeries( ifo->compTimeSignal, 0, 2 );
-          }
+  return key;
+}
 
-          ifo->compTimeSignal->data->data[0] = (Cplus*c2psi - Ccross*s2psi);
-          ifo->compTimeSignal->data->data[1] = (Cplus*s2psi + Ccross*c2psi);
-        }
-        else{
-          /* first check that compTimeSignal has been reduced in size to just hold these size values */
-          if ( ifo->compTimeSignal->data->length != 6 ){ /* otherwise resize it */
-            ifo->compTimeSignal = XLALResizeCOMPLEX16TimeSeries( ifo->compTimeSignal, 0, 6 );
-          }
 
-          ifo->compTimeSignal->data->data[0] = (Cplus*c2psi - Ccross*s2psi);
-          ifo->compTimeSignal->data->data[1] = (Cplus*s2psi + Ccross*c2psi);
-          ifo->compTimeSignal->data->data[2] = (Cx*cpsi - Cy*spsi);
-          ifo->compTimeSignal->data->data[3] = (Cx*spsi + Cy*cpsi);
-          ifo->compTimeSignal->data->data[4] = Cb;
-          ifo->compTimeSignal->data->data[5] = Cl;
-        }
+/**
+ * \brief Get the basis time series for the full time domain signal model
+ *
+ * The complex heterodyned signal model is a linear combination, with coefficients depending only on the amplitude
+ * parameters, of the antenna pattern time series (\f$a(t)\f$ and \f$b(t)\f$ for the tensor modes, plus the vector and
+ * scalar mode antenna patterns for non-GR models) multiplied by the phase factor \f$\exp{(2\pi i \Delta\phi(t))}\f$
+ * (see \c pulsar_model). This function returns these basis time series, contiguously, one after the other, in a single
+ * vector. The basis is held in the \c ifo model parameters, along with a key of all the parameters that affect it
+ * (see \c get_model_basis_key), and is only recalculated if any of these parameters have changed since the previous
+ * call. This means that proposals only changing the amplitude parameters do not require the antenna patterns, time
+ * delays or phase evolution to be recalculated.
+ *
+ * \param params [in] A set of pulsar parameters
+ * \param ifo [in] The ifo model containing detector-specific parameters
+ * \param freqFactor [in] The multiple of the pulsar rotation frequency at which the emission is
+ * \param nbasis [in] The number of basis time series (2 for tensor-only models, or 6 for non-GR models)
+ *
+ * \return A vector containing the basis time series (owned by the \c ifo model parameters)
+ */
+const COMPLEX16Vector *get_model_basis( PulsarParameters *params, LALInferenceIFOModel *ifo, REAL8 freqFactor,
+                                        UINT4 nbasis ){
+  UINT4 i = 0, length = ifo->times->length;
+  COMPLEX16Vector *basis = NULL;
+  REAL8Vector *key = NULL;
+
+  if ( (key = get_model_basis_key( params, ifo, freqFactor, nbasis )) == NULL ){ XLAL_ERROR_NULL( XLAL_EFUNC ); }
+
+  /* check if the cached basis is still valid */
+  if ( LALInferenceCheckVariable( ifo->params, "model_basis" ) && LALInferenceCheckVariable( ifo->params, "model_basis_key" ) ){
+    const REAL8Vector *oldkey = *(REAL8Vector **)LALInferenceGetVariable( ifo->params, "model_basis_key" );
+    basis = *(COMPLEX16Vector **)LALInferenceGetVariable( ifo->params, "model_basis" );
+
+    if ( oldkey->length == key->length && basis->length == nbasis*length ){
+      for ( i = 0; i < key->length; i++ ){
+        if ( key->data[i] != oldkey->data[i] ){ break; }
+      }
+      if ( i == key->length ){
+        XLALDestroyREAL8Vector( key );
+        return basis;
       }
+    }
 
-      ifo = ifo->next;
+    LALInferenceRemoveVariable( ifo->params, "model_basis" );
+    LALInferenceRemoveVariable( ifo->params, "model_basis_key" );
+  }
+
+  /* calculate a new basis */
+  basis = XLALCreateCOMPLEX16Vector( nbasis*length );
+  if ( basis == NULL ){ XLAL_ERROR_NULL( XLAL_EFUNC ); }
+
+  REAL8Vector *LUfplus = NULL, *LUfcross = NULL, *LUfx = NULL, *LUfy = NULL, *LUfb = NULL, *LUfl = NULL;
+
+  /* set lookup table parameters */
+  REAL8 tsteps = (REAL8)(*(INT4*)LALInferenceGetVariable( ifo->params, "timeSteps" ));
+  REAL8 tsv = LAL_DAYSID_SI / tsteps;
+
+  LUfplus = *(REAL8Vector **)LALInferenceGetVariable( ifo->params, "a_response_tensor" );
+  LUfcross = *(REAL8Vector **)LALInferenceGetVariable( ifo->params, "b_response_tensor" );
+
+  if ( nbasis == 6 ){
+    LUfx = *(REAL8Vector **)LALInferenceGetVariable( ifo->params, "a_response_vector" );
+    LUfy = *(REAL8Vector **)LALInferenceGetVariable( ifo->params, "b_response_vector" );
+    LUfb = *(REAL8Vector **)LALInferenceGetVariable( ifo->params, "a_response_scalar" );
+    LUfl = *(REAL8Vector **)LALInferenceGetVariable( ifo->params, "b_response_scalar" );
+  }
+
+  /* get the sidereal time since the initial data point % sidereal day */
+  REAL8Vector *sidDayFrac = *(REAL8Vector**)LALInferenceGetVariable( ifo->params, "siderealDay" );
+
+  /* get the phase difference from the heterodyne phase if required */
+  REAL8Vector *dphi = NULL;
+  if ( LALInferenceCheckVariable( ifo->params, "varyphase" ) ){
+    dphi = get_phase_model( params, ifo, freqFactor );
+  }
+
+  for( i=0; i<length; i++ ){
+    REAL8 timeScaled, timeMin;
+    INT4 timebinMin, timebinMax;
+
+    /* set the time bin for the lookup table */
+    /* sidereal day in secs*/
+    REAL8 T = sidDayFrac->data[i];
+    timebinMin = (INT4)fmod( floor(T / tsv), tsteps );
+    timeMin = timebinMin*tsv;
+    timebinMax = (INT4)fmod( timebinMin + 1, tsteps );
+
+    /* rescale time for linear interpolation on a unit square */
+    timeScaled = (T - timeMin)/tsv;
+
+    /* phase factor by which to multiply the (almost) DC signal model. NOTE: this does not try to undo the signal
+     * modulation in the data, but instead replicates it in the model, hence the positive phase rather than a
+     * negative phase in the cexp function. */
+    COMPLEX16 expp = 1.;
+    if ( dphi != NULL ){ expp = cexp( LAL_TWOPI * I * dphi->data[i] ); }
+
+    basis->data[i] = expp * ( LUfplus->data[timebinMin] + (LUfplus->data[timebinMax]-LUfplus->data[timebinMin])*timeScaled );
+    basis->data[length + i] = expp * ( LUfcross->data[timebinMin] + (LUfcross->data[timebinMax]-LUfcross->data[timebinMin])*timeScaled );
+
+    if ( nbasis == 6 ){
+      basis->data[2*length + i] = expp * ( LUfx->data[timebinMin] + (LUfx->data[timebinMax]-LUfx->data[timebinMin])*timeScaled );
+      basis->data[3*length + i] = expp * ( LUfy->data[timebinMin] + (LUfy->data[timebinMax]-LUfy->data[timebinMin])*timeScaled );
+      basis->data[4*length + i] = expp * ( LUfb->data[timebinMin] + (LUfb->data[timebinMax]-LUfb->data[timebinMin])*timeScaled );
+      basis->data[5*length + i] = expp * ( LUfl->data[timebinMin] + (LUfl->data[timebinMax]-LUfl->data[timebinMin])*timeScaled );
     }
   }
+
+  if ( dphi != NULL ){ XLALDestroyREAL8Vector( dphi ); }
+
+  /* store the basis and its key (the ifo model parameters now own the memory) */
+  LALInferenceAddVariable( ifo->params, "model_basis", &basis, LALINFERENCE_COMPLEX16Vector_t, LALINFERENCE_PARAM_FIXED );
+  LALInferenceAddVariable( ifo->params, "model_basis_key", &key, LALINFERENCE_REAL8Vector_t, LALINFERENCE_PARAM_FIXED );
+
+  return basis;
 }
 
 
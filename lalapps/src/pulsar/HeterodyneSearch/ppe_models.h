@@ -57,6 +57,9 @@ REAL8Vector *get_glitch_phase( PulsarParameters *pars, LIGOTimeGPSVector *datati
 
 void get_amplitude_model( PulsarParameters *pars, LALInferenceIFOModel *ifo );
 
+const COMPLEX16Vector *get_model_basis( PulsarParameters *params, LALInferenceIFOModel *ifo, REAL8 freqFactor,
+                                        UINT4 nbasis );
+
 REAL8 get_phase_mismatch( REAL8Vector *phi1, REAL8Vector *phi2, LIGOTimeGPSVector *ts );
 
 void get_earth_pos_vel( EarthState *earth, EphemerisData *ephem, LIGOTimeGPS *t );
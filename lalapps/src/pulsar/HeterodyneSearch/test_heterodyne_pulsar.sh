@@ -679,6 +679,68 @@ if [ "$fail3" = "1" ]; then
     exit 2
 fi
 
+################### INTERPOLATED TIME DELAYS ##########
+# repeat the fine heterodynes with the time delays interpolated on a grid, and check that
+# the outputs agree with the exact per-sample heterodynes
+INTERPSTEP=60
+INTERPTOL=0.01
+
+# compare two heterodyne output files: times must match, and data must agree to within a
+# fraction INTERPTOL of the largest data value in the exact file
+compare_interp () {
+  LC_ALL=C awk -v tol=$INTERPTOL '
+    /^%%/ { next }
+    FNR == NR { t[n] = $1; re[n] = $2; im[n] = $3; a = sqrt($2*$2 + $3*$3); if (a > amax) amax = a; n++; next }
+    { if (m >= n || $1 != t[m]) { bad = 1 } else { d = sqrt(($2 - re[m])^2 + ($3 - im[m])^2); if (d > dmax) dmax = d }; m++ }
+    END { if (bad || m != n || n == 0) { print "times differ"; exit 1 }; print "maximum difference", dmax, "of maximum", amax; exit (dmax > tol*amax) }
+  ' $1 $2
+}
+
+echo Performing fine heterodyne - mode 1 - using binary file and interpolated time delays
+$CODENAME --ephem-earth-file $EEPHEM --ephem-sun-file $SEPHEM --ephem-time-file $TEPHEM --heterodyne-flag 1 --ifo $DETECTOR --pulsar $PSRNAME --param-file $PFILE --sample-rate $SRATE2 --resample-rate $SRATE3 --filter-knee $FKNEE --data-file $COARSEFILE.bin --binary-input --output-file $FINEFILE.interp1 --channel $CHANNEL --seg-file $LOCATION/segfile --freq-factor 2 --calibrate --response-file $RESPFILE --stddev-thresh 5 --interp-step $INTERPSTEP
+
+ret_code=$?
+if [ $ret_code != "0" ]; then
+  echo lalapps_heterodyne_pulsar exited with error $ret_code!
+  exit 2
+fi
+
+compare_interp $FINEFILE.bin $FINEFILE.interp1
+if [ $? != "0" ]; then
+  echo Error! Fine heterodyne with interpolated time delays differs from exact fine heterodyne
+  exit 2
+fi
+
+echo Performing entire heterodyne in one go - mode 3 - using interpolated time delays
+$CODENAME --ephem-earth-file $EEPHEM --ephem-sun-file $SEPHEM --ephem-time-file $TEPHEM --heterodyne-flag 3 --ifo $DETECTOR --pulsar $PSRNAME --param-file $PFILE --sample-rate $SRATE1 --resample-rate $SRATE3 --filter-knee $FKNEE --data-file $LOCATION/cachefile --output-file $FINEFILE.interp3 --channel $CHANNEL --seg-file $LOCATION/segfile --freq-factor 2 --calibrate --response-file $RESPFILE --stddev-thresh 5 --interp-step $INTERPSTEP
+
+ret_code=$?
+if [ $ret_code != "0" ]; then
+  echo lalapps_heterodyne_pulsar exited with error $ret_code!
+  exit 2
+fi
+
+compare_interp $FINEFILE.full $FINEFILE.interp3
+if [ $? != "0" ]; then
+  echo Error! Heterodyne in one go with interpolated time delays differs from exact heterodyne
+  exit 2
+fi
+
+echo Performing updating heterodyne of already fine heterodyned data using interpolated time delays
+$CODENAME --ephem-earth-file $EEPHEM --ephem-sun-file $SEPHEM --ephem-time-file $TEPHEM --heterodyne-flag 4 --ifo $DETECTOR --pulsar $PSRNAME --param-file $PFILEOFF --param-file-update $PFILE --sample-rate $SRATE3 --resample-rate $SRATE3 --filter-knee 0 --data-file $FINEFILE.off2 --output-file $FINEFILE.interp4 --channel $CHANNEL --seg-file $LOCATION/segfile --freq-factor 2 --stddev-thresh 5 --interp-step $INTERPSTEP
+
+ret_code=$?
+if [ $ret_code != "0" ]; then
+  echo lalapps_heterodyne_pulsar exited with error $ret_code!
+  exit 2
+fi
+
+compare_interp $FINEFILE $FINEFILE.interp4
+if [ $? != "0" ]; then
+  echo Error! Updating heterodyne with interpolated time delays differs from exact updating heterodyne
+  exit 2
+fi
+
 ################### CLEAN UP ##########################
 echo Cleaning up directory.
 
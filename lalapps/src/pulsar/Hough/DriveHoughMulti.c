@@ -278,13 +278,13 @@ int main(int argc, char *argv[]){
     static HOUGHPeakGramVector pgV;  /* vector of peakgrams */
     static UCHARPeakGramVector upgV;  /* vector of expanded peakgrams */
     static PHMDVectorSequence  phmdVS;  /* the partial Hough map derivatives */
-    static UINT8FrequencyIndexVector freqInd; /* for trajectory in time-freq plane */
+    UINT8FrequencyIndexVector *freqIndV = NULL; /* for trajectories in time-freq plane, one per thread */
     static HOUGHResolutionPar parRes;   /* patch grid information */
     static HOUGHPatchGrid  patch;   /* Patch description */
-    static HOUGHParamPLUT  parLut;  /* parameters needed to build lut  */
+    HOUGHParamPLUT  *parLutV = NULL;  /* parameters needed to build the luts, one per time stamp */
     static HOUGHDemodPar   parDem;  /* demodulation parameters or  */
     static HOUGHSizePar    parSize;
-    static HOUGHMapTotal   ht;   /* the total Hough map */
+    HOUGHMapTotal   *htV = NULL;   /* the total Hough maps, one per thread */
     static UINT8Vector     *hist; /* histogram of number counts for a single map */
     static UINT8Vector     *histTotal; /* number count histogram for all maps */
     static HoughStats      stats;  /* statistical information about a Hough map */
@@ -306,7 +306,7 @@ int main(int argc, char *argv[]){
     static HoughSignificantEventVector nStarEventVec;
     
     /* miscellaneous */
-    INT4   iHmap, nSpin1Max ;
+    INT4   iHmap, nSpin1Max, nSpinMax, nSpin, iSpin0, nMaps, nBatch, iMap ;
     UINT4  mObsCoh, mObsCohBest;
     INT8   f0Bin, fLastBin, fBin;
     REAL8  alpha, delta, timeBase, deltaF, f1jump;
@@ -345,6 +345,7 @@ int main(int argc, char *argv[]){
     INT4     uvar_chiSqBins;
     
     INT4     uvar_spindownJump;
+    INT4     uvar_numThreads;
     
     INT4 uvar_nfLUTvalidity = 0;
     INT4 uvar_numSkyPartitions = 0;
@@ -379,6 +380,7 @@ int main(int argc, char *argv[]){
     uvar_EnableChi2=FALSE;
     uvar_chiSqBins = NBLOCKSTEST;
     uvar_spindownJump = SPINDOWNJUMP;
+    uvar_numThreads = 1;
 
     uvar_EnableToplistPatch = FALSE;
 
@@ -430,6 +432,7 @@ int main(int argc, char *argv[]){
     XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_chiSqBins,          "chiSqBins",          INT4,         0,   OPTIONAL,  "Number of chi-square bins for veto tests") == XLAL_SUCCESS, XLAL_EFUNC);
     XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_EnableChi2,         "enableChi2",         BOOLEAN,      0,   OPTIONAL,  "Print Chi2 value for each element in the Toplist") == XLAL_SUCCESS, XLAL_EFUNC);
     XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_spindownJump,       "spindownJump",       INT4,         0,   OPTIONAL,  "Jump to the next spin-down being analyzed (to avoid doing them all)") == XLAL_SUCCESS, XLAL_EFUNC);
+    XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_numThreads,         "numThreads",         INT4,         0,   OPTIONAL,  "Number of threads used to construct the look-up tables and the Hough maps for different spin-downs concurrently") == XLAL_SUCCESS, XLAL_EFUNC);
     XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_numSkyPartitions,   "numSkyPartitions",  INT4,          0,   OPTIONAL,  "Number of (equi-)partitions to split skygrid into") == XLAL_SUCCESS, XLAL_EFUNC);
     XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_partitionIndex,     "partitionIndex",    INT4,          0,   OPTIONAL,  "Index [0,xnumSkyPartitions-1] of sky-partition to generate") == XLAL_SUCCESS, XLAL_EFUNC);
     XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_refTime,            "refTime",            REAL8,        0,   OPTIONAL,  "GPS reference time of observation") == XLAL_SUCCESS, XLAL_EFUNC);
@@ -465,6 +468,17 @@ int main(int argc, char *argv[]){
         exit(1);
     }
     
+    if ( uvar_numThreads < 1 ) {
+        LogPrintf(LOG_CRITICAL, "number of threads must be positive\n");
+        exit(1);
+    }
+#if !defined(_OPENMP)
+    if ( uvar_numThreads > 1 ) {
+        LogPrintf(LOG_CRITICAL, "number of threads > 1 requires lalapps to have been compiled with OpenMP\n");
+        exit(1);
+    }
+#endif
+    
     /* probability of peak selection */
     alphaPeak = exp( -uvar_peakThreshold);
     
@@ -834,8 +848,6 @@ int main(int argc, char *argv[]){
         LAL_CALL( LALHOUGHCreatePHMDVS( &status, &phmdVS, mObsCohBest, uvar_nfSizeCylinder), &status);
         phmdVS.deltaF  = deltaF;
         
-        LAL_CALL( LALHOUGHCreateFreqIndVector( &status, &freqInd, mObsCohBest, deltaF), &status);
-        
         /* allocating histogram of the number-counts in the Hough maps */
         if ( uvar_EnableExtraInfo ) {
             UINT4 k0;
@@ -879,6 +891,22 @@ int main(int argc, char *argv[]){
         nSpin1Max = uvar_nfSizeCylinder - 1 - uvar_nSpinUp;
         /* nSpin1Max = floor(uvar_nfSizeCylinder/2.0) ;*/
         
+        /* spin-downs n = nSpinMax, nSpinMax - 1, ..., nSpinMax - nSpin + 1 are analyzed at each frequency */
+        nSpinMax = floor(uvar_nSpinUp/uvar_spindownJump);
+        nSpin = nSpinMax + floor(nSpin1Max/uvar_spindownJump) + 1;
+        if ( nSpin < 0 ) {
+            nSpin = 0;
+        }
+        
+        /* spin-downs are analyzed in batches of up to one map per thread */
+        nMaps = ( nSpin < uvar_numThreads ) ? nSpin : uvar_numThreads;
+        
+        freqIndV = (UINT8FrequencyIndexVector *)LALCalloc(nMaps + 1, sizeof(UINT8FrequencyIndexVector));
+        htV = (HOUGHMapTotal *)LALCalloc(nMaps + 1, sizeof(HOUGHMapTotal));
+        for (iMap = 0; iMap < nMaps; ++iMap) {
+            LAL_CALL( LALHOUGHCreateFreqIndVector( &status, &freqIndV[iMap], mObsCohBest, deltaF), &status);
+        }
+        
         
         if ( XLALUserVarWasSet( &uvar_deltaF1dot ) )
         {
@@ -928,16 +956,18 @@ int main(int argc, char *argv[]){
             
             
             /* ************* create all the LUTs at fBin ********************  */
-            for (j = 0; j < mObsCohBest; ++j){  /* create all the LUTs */
+            parLutV = (HOUGHParamPLUT *)LALCalloc(mObsCohBest, sizeof(HOUGHParamPLUT));
+            for (j = 0; j < mObsCohBest; ++j){  /* calculate parameters needed for buiding the LUTs */
                 parDem.veloC.x = best.velV->data[j].x;
                 parDem.veloC.y = best.velV->data[j].y;
                 parDem.veloC.z = best.velV->data[j].z;
-                /* calculate parameters needed for buiding the LUT */
-                LAL_CALL( LALNDHOUGHParamPLUT( &status, &parLut, &parSize, &parDem),&status );
-                /* build the LUT */
-                LAL_CALL( LALHOUGHConstructPLUT( &status, &(lutV.lut[j]), &patch, &parLut ),
-                         &status );
+                LAL_CALL( LALNDHOUGHParamPLUT( &status, &parLutV[j], &parSize, &parDem),&status );
             }
+            /* build the LUTs */
+            LAL_CALL( LALHOUGHConstructMultiPLUT( &status, &lutV, &patch, parLutV, uvar_numThreads ),
+                     &status );
+            LALFree(parLutV);
+            parLutV = NULL;
             
             /************* build the set of  PHMD centered around fBin***********/
             phmdVS.fBinMin = fBin - uvar_nfSizeCylinder + 1 + uvar_nSpinUp;
@@ -950,9 +980,11 @@ int main(int argc, char *argv[]){
             
             /* ************ initializing the Total Hough map space *********** */
             
-            LAL_CALL( LALHOUGHCreateHT( &status, &ht, xSide, ySide), &status);
-            ht.mObsCoh = mObsCohBest;
-            ht.deltaF = deltaF;
+            for (iMap = 0; iMap < nMaps; ++iMap) {
+                LAL_CALL( LALHOUGHCreateHT( &status, &htV[iMap], xSide, ySide), &status);
+                htV[iMap].mObsCoh = mObsCohBest;
+                htV[iMap].deltaF = deltaF;
+            }
             
             
             /*  Search frequency interval possible using the same LUTs */
@@ -966,46 +998,49 @@ int main(int argc, char *argv[]){
             while ( (fBinSearch <= fLastBin) && (fBinSearch < fBinSearchMax) )
             {
                 
-                /**** study 1 spin-down. at  fBinSearch ****/
-                
-                INT4   n;
-                REAL8  f1dis;
+                /**** study all spin-downs at  fBinSearch ****/
                 
-                ht.f0Bin = fBinSearch;
-                ht.spinRes.length = 1;
-                ht.spinRes.data = NULL;
-                ht.spinRes.data = (REAL8 *)LALCalloc(ht.spinRes.length, sizeof(REAL8));
-                for ( n = floor(uvar_nSpinUp/uvar_spindownJump); n >= - floor(nSpin1Max/uvar_spindownJump); --n) {
-                    /*for ( n = 0; n <= floor(nSpin1Max/uvar_spindownJump); ++n) {*/
+                for ( iSpin0 = 0; iSpin0 < nSpin; iSpin0 += nBatch) {
+                  
+                  nBatch = ( nSpin - iSpin0 < nMaps ) ? nSpin - iSpin0 : nMaps;
+                  
+                  /* construct paths in time-freq plane */
+                  for ( iMap = 0; iMap < nBatch; ++iMap) {
                     /* f1dis = - n * f1jump; */
                     /*loop over all spindown values */
                     
-                    f1dis = + n * f1jump;
-                    ht.spinRes.data[0] =  f1dis * deltaF;
+                    INT4   n = nSpinMax - iSpin0 - iMap;
+                    REAL8  f1dis = + n * f1jump;
                     
-                    /* construct path in time-freq plane */
-                    for (j = 0 ; j < mObsCohBest; ++j){
-                        freqInd.data[j] = fBinSearch + floor(best.timeDiffV->data[j]*f1dis + 0.5);
-                    }
+                    htV[iMap].f0Bin = fBinSearch;
+                    htV[iMap].spinRes.length = 1;
+                    htV[iMap].spinRes.data = NULL;
+                    htV[iMap].spinRes.data = (REAL8 *)LALCalloc(htV[iMap].spinRes.length, sizeof(REAL8));
+                    htV[iMap].spinRes.data[0] =  f1dis * deltaF;
                     
-                    if (uvar_weighAM || uvar_weighNoise) {
-                        LAL_CALL( LALHOUGHConstructHMT_W( &status, &ht, &freqInd, &phmdVS ), &status );
-                    }
-                    else {
-                        LAL_CALL( LALHOUGHConstructHMT( &status, &ht, &freqInd, &phmdVS ), &status );
+                    for (j = 0 ; j < mObsCohBest; ++j){
+                        freqIndV[iMap].data[j] = fBinSearch + floor(best.timeDiffV->data[j]*f1dis + 0.5);
                     }
+                  }
+                  
+                  /* construct the Hough maps for this batch of spin-downs, concurrently if requested */
+                  LAL_CALL( LALHOUGHConstructMultiHMT( &status, htV, freqIndV, nBatch, &phmdVS,
+                                                       uvar_weighAM || uvar_weighNoise, uvar_numThreads ), &status );
+                  
+                  for ( iMap = 0; iMap < nBatch; ++iMap) {
                     
+                    HOUGHMapTotal *ht = &htV[iMap];
                     
                     /* ********************* perfom stat. analysis on the maps ****************** */
                     
                     if ( uvar_EnableExtraInfo ) {
                         
-                        LAL_CALL( LALHoughStatistics ( &status, &stats, &ht), &status );
+                        LAL_CALL( LALHoughStatistics ( &status, &stats, ht), &status );
                         LAL_CALL( LALStereo2SkyLocation (&status, &sourceLocation,
                                                          stats.maxIndex[0], stats.maxIndex[1], &patch, &parDem), &status);
                         
-                        /*LAL_CALL( LALHoughHistogram ( &status, &hist, &ht), &status);*/
-                        LAL_CALL( LALHoughHistogramSignificance ( &status, hist, &ht, meanN, sigmaN,
+                        /*LAL_CALL( LALHoughHistogram ( &status, &hist, ht), &status);*/
+                        LAL_CALL( LALHoughHistogramSignificance ( &status, hist, ht, meanN, sigmaN,
                                                                  minSignificance, maxSignificance), &status);
                         
                         for(j = 0; j < histTotal->length; j++){
@@ -1014,21 +1049,22 @@ int main(int argc, char *argv[]){
                     }
                     
                     /* select candidates from hough maps */
-                    LAL_CALL( GetToplistFromHoughmap( &status, toplist, &ht, &patch, &parDem, meanN, sigmaN), &status);
+                    LAL_CALL( GetToplistFromHoughmap( &status, toplist, ht, &patch, &parDem, meanN, sigmaN), &status);
                     
                     
                     /* ***** print results *********************** */
                     
                     if( uvar_EnableExtraInfo )
                     {
-                        if( PrintExtraInfo( fileMaps, &fp1, iHmap, &ht, &sourceLocation, &stats, fBinSearch, deltaF))
+                        if( PrintExtraInfo( fileMaps, &fp1, iHmap, ht, &sourceLocation, &stats, fBinSearch, deltaF))
                             return DRIVEHOUGHCOLOR_EFILE;
                     }
                     
                     ++iHmap;
-                } /* end loop over spindown values */
-                
-                LALFree(ht.spinRes.data);
+                    
+                    LALFree(ht->spinRes.data);
+                  } /* end loop over spindown values of this batch */
+                } /* end loop over batches of spindown values */
                 
                 
                 /***** shift the search freq. & PHMD structure 1 freq.bin ****** */
@@ -1047,7 +1083,9 @@ int main(int argc, char *argv[]){
             /* ********************  Free partial memory ******************* */
             LALFree(patch.xCoor);
             LALFree(patch.yCoor);
-            LALFree(ht.map);
+            for (iMap = 0; iMap < nMaps; ++iMap) {
+                LALFree(htV[iMap].map);
+            }
             
             LALHOUGHDestroyLUTs( &status, &lutV);
             
@@ -1084,8 +1122,13 @@ int main(int argc, char *argv[]){
         LALFree(phmdVS.phmd);
         phmdVS.phmd = NULL;
         
-        LALFree(freqInd.data);
-        freqInd.data = NULL;
+        for (iMap = 0; iMap < nMaps; ++iMap) {
+            LALFree(freqIndV[iMap].data);
+        }
+        LALFree(freqIndV);
+        freqIndV = NULL;
+        LALFree(htV);
+        htV = NULL;
         
         if ( uvar_EnableExtraInfo ) {
             XLALDestroyUINT8Vector (hist);
@@ -1500,7 +1500,7 @@ void ComputeFstatHoughMap(LALStatus *status,		/**< pointer to LALStatus structur
   UINT8FrequencyIndexVector freqInd; /* for trajectory in time-freq plane */
   HOUGHResolutionPar parRes;   /* patch grid information */
   HOUGHPatchGrid  patch;   /* Patch description */
-  HOUGHParamPLUT  parLut;  /* parameters needed to build lut  */
+  HOUGHParamPLUT  *parLutV = NULL;  /* parameters needed to build the luts, one per stack */
   HOUGHDemodPar   parDem;  /* demodulation parameters */
   HOUGHSizePar    parSize;
 
@@ -1837,7 +1837,12 @@ void ComputeFstatHoughMap(LALStatus *status,		/**< pointer to LALStatus structur
     }
 
     /*------------------- create all the LUTs at fBin ---------------------*/
-    for (j=0; j < (UINT4)nStacks; j++){  /* create all the LUTs */
+    parLutV = LALCalloc(nStacks, sizeof(HOUGHParamPLUT));
+    if ( parLutV == NULL ) {
+      XLALPrintError ("Failed to LALCalloc( %d, %zu)\n", nStacks, sizeof(HOUGHParamPLUT) );
+      ABORT ( status, HIERARCHICALSEARCH_EMEM, HIERARCHICALSEARCH_MSGEMEM );
+    }
+    for (j=0; j < (UINT4)nStacks; j++){  /* calculate parameters needed for buiding the LUTs */
       parDem.veloC.x = vel->data[3*j];
       parDem.veloC.y = vel->data[3*j + 1];
       parDem.veloC.z = vel->data[3*j + 2];
@@ -1846,13 +1851,15 @@ void ComputeFstatHoughMap(LALStatus *status,		/**< pointer to LALStatus structur
       parDem.positC.z = pos->data[3*j + 2];
       parDem.timeDiff = timeDiffV->data[j];
 
-      /* calculate parameters needed for buiding the LUT */
-      TRY( LALHOUGHCalcParamPLUT( status->statusPtr, &parLut, &parSize, &parDem), status);
-
-      /* build the LUT */
-      TRY( LALHOUGHConstructPLUT( status->statusPtr, &(lutV.lut[j]), &patch, &parLut ), status);
+      TRY( LALHOUGHCalcParamPLUT( status->statusPtr, &parLutV[j], &parSize, &parDem), status);
+    }
 
+    /* build the LUTs; stacks with identical parameters share one construction */
+    TRY( LALHOUGHConstructMultiPLUT( status->statusPtr, &lutV, &patch, parLutV, 1 ), status);
+    LALFree(parLutV);
+    parLutV = NULL;
 
+    for (j=0; j < (UINT4)nStacks; j++){
       /* for debugging
 	 fprintf(stdout,"%d\n", lutV.lut[j].nBin);
       */
@@ -142,6 +142,7 @@ struct CommandLineArgsTag {
   REAL8 overlapFraction;   /* 12/28/05 gam; overlap fraction (for use with windows; e.g., use -P 0.5 with -w 3 Hann windows; default is 1.0). */
   BOOLEAN useSingle;       /* 11/19/05 gam; use single rather than double precision */
   char *frameStructType;   /* 01/10/07 gam */
+  INT4 numThreads;         /* number of threads used to make SFTs in parallel */
 } CommandLineArgs;
 
 struct headertag {
@@ -186,6 +187,9 @@ COMPLEX8Vector *fftDataSingle = NULL;
 XLALPSSParamSet XLALPSSParams;
 #endif
 
+/* each thread making SFTs in parallel keeps its own copy of the per-SFT state */
+#pragma omp threadprivate(header, winFncRMS, status, dataDouble, dataSingle, dataINT2, dataINT4, dataINT8, gpsepoch, fftPlanDouble, fftDataDouble, fftPlanSingle, fftDataSingle)
+
 CHAR allargs[16384]; /* 06/26/07 gam; copy all command line args into commentField, based on /lalapps/src/calibration/ComputeStrainDriver.c */
 /***************************************************************************/
 
@@ -220,6 +224,9 @@ int CreateSFT(struct CommandLineArgsTag CLA);
 int WriteSFT(struct CommandLineArgsTag CLA);
 int WriteVersion2SFT(struct CommandLineArgsTag CLA);
 
+/* Frees the data time series and FFT plans allocated by AllocateData() */
+int FreeData(struct CommandLineArgsTag CLA);
+
 /* Frees the memory */
 int FreeMem(struct CommandLineArgsTag CLA);
 
@@ -476,6 +483,8 @@ int PrintREAL4ArrayToFile(const char*name, REAL4*array, UINT4 length) {
 int main(int argc,char *argv[])
 {
   /* int j; */ /* 12/28/05 gam */
+  INT4 sftStep, numSFTs;
+  INT4 errcode = 0;
 
   #if TRACKMEMUSE
     printf("Memory use at startup is:\n"); printmemuse();
@@ -501,59 +510,116 @@ int main(int argc,char *argv[])
       return 0;;
     }
 
+  /* number of SFTs between the start and end times; the start of each SFT is (1 - overlapFraction)*T after the previous one */
+  sftStep = (INT4)((1.0 - CommandLineArgs.overlapFraction)*((REAL8)CommandLineArgs.T));
+  if (sftStep < 1)
+    {
+      fprintf(stderr,"Overlap fraction %g is too large for SFTs of duration %d\n",
+	      CommandLineArgs.overlapFraction, CommandLineArgs.T );
+      return 1;
+    }
+  numSFTs = (CommandLineArgs.GPSEnd - CommandLineArgs.T - CommandLineArgs.GPSStart)/sftStep + 1;
+  if (CommandLineArgs.numThreads > numSFTs) CommandLineArgs.numThreads = numSFTs;
+
   gpsepoch.gpsSeconds = CommandLineArgs.GPSStart;
   gpsepoch.gpsNanoSeconds = 0;
 
-  /* Allocates space for data */
-  if (AllocateData(CommandLineArgs)) return 2;
+  /* Each thread allocates its own data and FFT plan, and then makes one SFT at a time: frames are read from
+     the shared frame stream by one thread at a time and in time order, while the high pass filtering,
+     windowing, FFT and output of the SFTs run in parallel. At most one SFT per thread is held in memory. */
+  #pragma omp parallel num_threads(CommandLineArgs.numThreads) if(CommandLineArgs.numThreads > 1) copyin(gpsepoch)
+  {
+    INT4 threadErr = 0;
+    INT4 j;
 
-  /* for(j=0; j < SegmentDuration/CommandLineArgs.T; j++) */ /* 12/28/05 gam */
-  while(gpsepoch.gpsSeconds + CommandLineArgs.T <= CommandLineArgs.GPSEnd)
+    /* Allocates space for data */
+    #pragma omp critical(MakeSFTs_framestream)
     {
+      if (AllocateData(CommandLineArgs)) threadErr = 2;
+    }
+    if (threadErr) {
+      #pragma omp critical(MakeSFTs_errcode)
+      {
+        if (errcode == 0) errcode = threadErr;
+      }
+    }
 
-      /* gpsepoch.gpsSeconds = CommandLineArgs.GPSStart + j*CommandLineArgs.T;
-      gpsepoch.gpsNanoSeconds = 0; */ /* 12/28/05 gam; now updated at the bottom of while loop */
+    #pragma omp for ordered schedule(dynamic,1)
+    for (j = 0; j < numSFTs; j++)
+      {
+        INT4 failed;
 
-      /* Reads T seconds of data */
-      if (ReadData(CommandLineArgs)) return 3;
+        /* stop making SFTs once any thread has failed */
+        #pragma omp critical(MakeSFTs_errcode)
+        {
+          failed = (errcode != 0);
+        }
+        if (failed || threadErr) continue;
 
-      /* High-pass data with Butterworth filter */
-      if(HighPass(CommandLineArgs)) return 4;
+        gpsepoch.gpsSeconds = CommandLineArgs.GPSStart + j*sftStep;
+        gpsepoch.gpsNanoSeconds = 0;
 
-      /* Window data; 12/28/05 gam; add options */
-      if (CommandLineArgs.windowOption==1) {
-         if(WindowData(CommandLineArgs)) return 5; /* CommandLineArgs.windowOption==1 is the default */
-      } else if (CommandLineArgs.windowOption==2) {
-         if(WindowDataTukey2(CommandLineArgs)) return 5;
-      } else if (CommandLineArgs.windowOption==3) {
-         if(WindowDataHann(CommandLineArgs)) return 5;
-      } else {
-        /* Continue with no windowing; parsing of command line args makes sure options are one of the above or 0 for now windowing. */
-      }
+        /* Reads T seconds of data */
+        #pragma omp ordered
+        {
+          #pragma omp critical(MakeSFTs_framestream)
+          {
+            if (ReadData(CommandLineArgs)) threadErr = 3;
+          }
+        }
+
+        /* High-pass data with Butterworth filter */
+        if (!threadErr && HighPass(CommandLineArgs)) threadErr = 4;
+
+        /* Window data; 12/28/05 gam; add options */
+        if (!threadErr) {
+          if (CommandLineArgs.windowOption==1) {
+             if(WindowData(CommandLineArgs)) threadErr = 5; /* CommandLineArgs.windowOption==1 is the default */
+          } else if (CommandLineArgs.windowOption==2) {
+             if(WindowDataTukey2(CommandLineArgs)) threadErr = 5;
+          } else if (CommandLineArgs.windowOption==3) {
+             if(WindowDataHann(CommandLineArgs)) threadErr = 5;
+          } else {
+            /* Continue with no windowing; parsing of command line args makes sure options are one of the above or 0 for now windowing. */
+          }
+        }
 
 #ifdef PSS_ENABLED
-      /* Time Domain cleaning procedure */
-      if (CommandLineArgs.PSSCleaning)
-	if(PSSTDCleaningDouble(CommandLineArgs))
-	  return 9;
+        /* Time Domain cleaning procedure */
+        if (!threadErr && CommandLineArgs.PSSCleaning)
+          if(PSSTDCleaningDouble(CommandLineArgs))
+            threadErr = 9;
 #endif
 
-      /* create an SFT */
-      if(CreateSFT(CommandLineArgs)) return 6;
+        /* create an SFT */
+        if (!threadErr && CreateSFT(CommandLineArgs)) threadErr = 6;
 
-      /* write out sft */
-      if (CommandLineArgs.sftVersion==1) {
-        if(WriteSFT(CommandLineArgs)) return 7;
-      } else if (CommandLineArgs.sftVersion==2) {
-        if(WriteVersion2SFT(CommandLineArgs)) return 7; /* default now is to output version 2 SFTs */
-      } else {
-        fprintf( stderr, "Invalid input for 'sft-version = %d', must be either '1' or '2'\n", CommandLineArgs.sftVersion );
-        return 0;;
+        /* write out sft; parsing of command line args makes sure the SFT version is either 1 or 2 */
+        if (!threadErr) {
+          if (CommandLineArgs.sftVersion==1) {
+            if(WriteSFT(CommandLineArgs)) threadErr = 7;
+          } else {
+            if(WriteVersion2SFT(CommandLineArgs)) threadErr = 7; /* default now is to output version 2 SFTs */
+          }
+        }
+
+        if (threadErr) {
+          #pragma omp critical(MakeSFTs_errcode)
+          {
+            if (errcode == 0) errcode = threadErr;
+          }
+        }
       }
 
-      gpsepoch.gpsSeconds = gpsepoch.gpsSeconds + (INT4)((1.0 - CommandLineArgs.overlapFraction)*((REAL8)CommandLineArgs.T));
-      gpsepoch.gpsNanoSeconds = 0;
+    /* Frees this thread's data */
+    if (!threadErr && FreeData(CommandLineArgs)) {
+      #pragma omp critical(MakeSFTs_errcode)
+      {
+        if (errcode == 0) errcode = 8;
+      }
     }
+  }
+  if (errcode) return errcode;
 
   if(FreeMem(CommandLineArgs)) return 8;
 
@@ -603,13 +669,14 @@ int ReadCommandLine(int argc,char *argv[],struct CommandLineArgsTag *CLA)
     {"pss-edge",             required_argument, NULL,          516},
     {"pss-ext",              required_argument, NULL,          517},
 #endif
+    {"threads",              required_argument, NULL,          'j'},
     {"ht-data",              no_argument,       NULL,          'H'},
     {"use-single",           no_argument,       NULL,          'S'},
     {"help",                 no_argument,       NULL,          'h'},
     {"version",              no_argument,       NULL,          'V'},
     {0, 0, 0, 0}
   };
-  char args[] = "hHZSf:t:C:N:i:s:e:v:c:F:B:D:X:u:w:r:P:p:ab:";
+  char args[] = "hHZSf:t:C:N:i:s:e:v:c:F:B:D:X:u:w:r:P:p:ab:j:";
 
   /* Initialize default values */
   CLA->HPf=-1.0;
@@ -635,6 +702,7 @@ int ReadCommandLine(int argc,char *argv[],struct CommandLineArgsTag *CLA)
   CLA->PSSCleaning = 0;	     /* 1=YES and 0=NO*/
   CLA->PSSCleanHPf = 100.0;  /* Cut frequency for the bilateral highpass filter. It has to be used only if PSSCleaning is YES. defaults to 100Hz */
   CLA->PSSCleanExt = 1;      /* by default, extend the timeseries */
+  CLA->numThreads = 1;       /* by default, make SFTs serially */
 
   strcat(allargs, "\nMakeSFTs ");
   strcat(allargs, lalVCSIdentInfo.vcsId);
@@ -796,6 +864,10 @@ int ReadCommandLine(int argc,char *argv[],struct CommandLineArgsTag *CLA)
       CLA->PSSCleanExt = atoi(LALoptarg);
       break;
 #endif
+    case 'j':
+      /* number of threads */
+      CLA->numThreads=atoi(LALoptarg);
+      break;
     case 'h':
       /* print usage/help message */
       fprintf(stdout,"Arguments are:\n");
@@ -821,6 +893,7 @@ int ReadCommandLine(int argc,char *argv[],struct CommandLineArgsTag *CLA)
       fprintf(stdout,"\tuse-single (-S)\t\tFLAG\t (optional) Use single precision for window, plan, and fft; double precision filtering is always done.\n");
       fprintf(stdout,"\tframe-struct-type (-u)\tSTRING\t (optional) String specifying the input frame structure and data type. Must begin with ADC_ or PROC_ followed by REAL4, REAL8, INT2, INT4, or INT8; default: ADC_REAL4; -H is the same as PROC_REAL8.\n");
       fprintf(stdout,"\ttd-cleaning (-a)\tFLAG\t Use time-domain cleaning with PSS routines\n");
+      fprintf(stdout,"\tthreads (-j)\t\tINT\t (optional) Number of threads used to make SFTs in parallel; frames are still read in time order by one thread at a time (default is 1).\n");
 #ifdef PSS_ENABLED
       fprintf(stdout,"\tpss-freq (-b)      \tFLOAT\t Cut frequency for the bilateral highpass filter for time-domain cleaning\n");
       fprintf(stdout,"\tpss-abs            \tFLOAT\t (optional) Set PSS parameter 'abs' for time-domain cleaning\n");
@@ -929,6 +1002,25 @@ int ReadCommandLine(int argc,char *argv[],struct CommandLineArgsTag *CLA)
       fprintf(stderr,"Try %s -h \n", argv[0]);
       return 1;
     }      
+  if(CLA->numThreads < 1)
+    {
+      fprintf(stderr,"Illegal threads option given.\n");
+      fprintf(stderr,"Try %s -h \n", argv[0]);
+      return 1;
+    }
+#if !defined(_OPENMP)
+  if(CLA->numThreads > 1)
+    {
+      fprintf(stderr,"Making SFTs with more than one thread requires OpenMP.\n");
+      fprintf(stderr,"Configure with --enable-openmp to enable it.\n");
+      return 1;
+    }
+#endif
+  if(CLA->PSSCleaning && CLA->numThreads > 1)
+    {
+      fprintf(stderr,"Time-domain cleaning is currently only implemented with one thread.\n");
+      return 1;
+    }
   if(CLA->PSSCleaning)
 #ifdef PSS_ENABLED
     {
@@ -2158,12 +2250,9 @@ int WriteVersion2SFT(struct CommandLineArgsTag CLA)
 /*******************************************************************************/
 
 /*******************************************************************************/
-int FreeMem(struct CommandLineArgsTag CLA)
+int FreeData(struct CommandLineArgsTag CLA)
 {
 
-  LALFrClose(&status,&framestream);
-  TESTSTATUS( &status );
-
   /* 11/19/05 gam */
   if(CLA.useSingle) {
     LALDestroyVector(&status,&dataSingle.data);
@@ -2175,6 +2264,19 @@ int FreeMem(struct CommandLineArgsTag CLA)
     XLALDestroyREAL8FFTPlan( fftPlanDouble );
   }
 
+  return 0;
+}
+/*******************************************************************************/
+
+/*******************************************************************************/
+int FreeMem(struct CommandLineArgsTag CLA)
+{
+
+  LALFrClose(&status,&framestream);
+  TESTSTATUS( &status );
+
+  /* data and FFT plans are freed by each thread in FreeData() */
+
   LALCheckMemoryLeaks();
  
   return 0;
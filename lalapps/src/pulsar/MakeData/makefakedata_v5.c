@@ -115,6 +115,7 @@ typedef struct
   REAL8 fmin;		/**< Lowest frequency in output SFT (= heterodyning frequency) */
   REAL8 Band;		/**< bandwidth of output SFT in Hz (= 1/2 sampling frequency) */
   REAL8 sourceDeltaT;   /**< source-frame sampling period. '0' implies previous internal defaults */
+  BOOLEAN fastInjection;	/**< synthesise isolated signals directly in the output band, batched by sky-position */
 
   /* SFT params */
   REAL8 Tsft;		        /**< SFT time baseline Tsft */
@@ -196,6 +197,7 @@ main(int argc, char *argv[])
   DataParams.SFTWindowType      = uvar.SFTWindowType;
   DataParams.SFTWindowBeta      = uvar.SFTWindowBeta;
   DataParams.sourceDeltaT       = uvar.sourceDeltaT;
+  DataParams.fastInjection      = uvar.fastInjection;
   DataParams.inputMultiTS       = GV.inputMultiTS;
   DataParams.fMin               = GV.fminOut;
   DataParams.Band               = GV.BandOut;
@@ -663,6 +665,7 @@ XLALInitUserVars ( UserVariables_t *uvar, int argc, char *argv[] )
   // ----- 'expert-user/developer' options ----- (only shown in help at lalDebugLevel >= warning)
   XLALRegisterUvarMember(   randSeed,             INT4, 0, DEVELOPER, "Specify random-number seed for reproducible noise (0 means use /dev/urandom for seeding).");
   XLALRegisterUvarMember(  sourceDeltaT,        REAL8,  0, DEVELOPER, "Source-frame sampling period. '0' implies previous internal defaults" );
+  XLALRegisterUvarMember(  fastInjection,     BOOLEAN,  0, DEVELOPER, "Synthesise isolated signals directly in the heterodyned output band, sharing SSB timing and antenna patterns between signals with the same sky-position (ignores --sourceDeltaT for those)" );
 
   /* read cmdline & cfgfile  */
   BOOLEAN should_exit = 0;
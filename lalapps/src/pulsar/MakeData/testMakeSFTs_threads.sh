@@ -0,0 +1,62 @@
+## common variables
+tstart=1257741529
+Tsft=1800
+Band=256
+Band2=`echo "${Band} + 0.0006" | bc`   ## add 0.0006 to bandwidth to get same number of SFT bins as MDFv5
+
+## run MFDv5 to create a fake frame, from which to make several SFTs
+Nsft=6
+duration=`echo "${Nsft} * ${Tsft}" | bc`
+cmdline="lalapps_Makefakedata_v5 --IFOs H1 --sqrtSX 1e-24 --startTime ${tstart} --duration ${duration} --fmin 0 --Band ${Band} --injectionSources '{Alpha=0.1; Delta=0.4; Freq=50; f1dot=1e-10; h0=1e-24; cosi=0.7; refTime=${tstart}}' --outLabel mfdv5multi --outFrameDir ."
+if ! eval "$cmdline"; then
+    echo "ERROR: something failed when running '$cmdline'"
+    exit 1
+fi
+MFDv5gwf="./H-H1_mfdv5multi-${tstart}-${duration}.gwf"
+if ! test -f $MFDv5gwf; then
+    echo "ERROR: could not find file '$MFDv5gwf'"
+    exit 1
+fi
+framecache="./framecache"
+echo "H H1_mfdv5multi ${tstart} ${duration} file://localhost$PWD/$MFDv5gwf" > $framecache
+
+## run MakeSFTs with one thread, and with several threads
+tend=`echo "${tstart} + ${duration}" | bc`
+for threads in 1 3; do
+    rm -rf ./MSFTthreads${threads}
+    mkdir ./MSFTthreads${threads}
+    cmdline="lalapps_MakeSFTs -f 0 -t ${Tsft} -p ./MSFTthreads${threads} -C $framecache -s ${tstart} -e ${tend} -N H1:mfdv5multi -v 2 -i H1 -u PROC_REAL8 -w 0 -F 0 -B ${Band2} -X MSFT -j ${threads}"
+    if ! eval "$cmdline"; then
+        echo "ERROR: something failed when running '$cmdline'"
+        exit 1
+    fi
+    nfiles=`ls ./MSFTthreads${threads}/*.sft | wc -l`
+    if test $nfiles -ne $Nsft; then
+        echo "ERROR: MakeSFTs with ${threads} thread(s) produced ${nfiles} SFTs, expected ${Nsft}"
+        exit 1
+    fi
+done
+
+## compare SFTs produced by MakeSFTs with one and several threads: the comments record the
+## different command lines (and so do the checksums), but the headers and data must be identical
+echo "Comparing SFTs produced by MakeSFTs with 1 thread and 3 threads, which should be identical:"
+for sft1 in ./MSFTthreads1/*.sft; do
+    sft3="./MSFTthreads3/`basename $sft1`"
+    if ! test -f $sft3; then
+        echo "ERROR: could not find file '$sft3'"
+        exit 1
+    fi
+    ## header fields version, gps_sec, gps_nsec, tbase, first_frequency_index, nsamples are the first 32 bytes
+    head -c 32 $sft1 > header1.bin
+    head -c 32 $sft3 > header3.bin
+    ## data are the last 8 * nsamples bytes
+    nsamples=`od -An -t d4 -j 28 -N 4 $sft1 | tr -d ' '`
+    nbytes=`expr 8 \* ${nsamples}`
+    tail -c ${nbytes} $sft1 > data1.bin
+    tail -c ${nbytes} $sft3 > data3.bin
+    if ! cmp header1.bin header3.bin || ! cmp data1.bin data3.bin; then
+        echo "ERROR: SFTs '$sft1' and '$sft3' differ"
+        exit 1
+    fi
+    echo "  `basename $sft1`: identical"
+done
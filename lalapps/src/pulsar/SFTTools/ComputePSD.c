@@ -50,6 +50,7 @@
 #include <lal/FrequencySeries.h>
 #include <lal/Units.h>
 #include <lal/SFTutils.h>
+#include <lal/H5FileIO.h>
 
 #include <lal/LogPrintf.h>
 
@@ -117,6 +118,9 @@ typedef struct
   BOOLEAN dumpMultiPSDVector; /**< output multi-PSD vector over IFOs, timestamps, and frequencies into file(s) */
   CHAR *outputQ;	/**< output the 'data-quality factor' Q(f) into this file */
 
+  REAL8 chunkBand;	/**< if >0: load SFTs and compute the PSD in successive frequency chunks of this width */
+  CHAR *outputPSDh5;	/**< output PSD (and normalised SFT power) as frequency series into this HDF5 file */
+
   REAL8 fStart;		/**< Start Frequency to load from SFT and compute PSD, including wings (it is RECOMMENDED to use --Freq instead) */
   REAL8 fBand;		/**< Frequency Band to load from SFT and compute PSD, including wings (it is RECOMMENDED to use --FreqBand instead) */
 
@@ -138,7 +142,11 @@ extern int vrbflg;
 /* ---------- local prototypes ---------- */
 int initUserVars (int argc, char *argv[], UserVariables_t *uvar);
 void LALfwriteSpectrograms ( LALStatus *status, const CHAR *bname, const MultiPSDVector *multiPSD );
+SFTCatalog *XLALFindSFTCatalog ( ConfigVariables_t *cfg, REAL8 *fMin, REAL8 *fMax, const UserVariables_t *uvar );
 MultiSFTVector *XLALReadSFTs ( ConfigVariables_t *cfg, const UserVariables_t *uvar );
+int XLALCleanLinesInMultiSFTs ( MultiSFTVector *sfts, const UserVariables_t *uvar );
+int XLALComputePSDinChunks ( REAL8Vector **finalPSD, REAL8Vector **normSFT, REAL8 *Freq0, REAL8 *dFreq, ConfigVariables_t *cfg, const UserVariables_t *uvar );
+int XLALWritePSDtoHDF5File ( const CHAR *fname, REAL8Vector *finalPSD, REAL8Vector *normSFT, const REAL8 Freq0, const REAL8 dFreq, const ConfigVariables_t *cfg );
 
 int XLALWriteREAL8FrequencySeries_to_file ( const REAL8FrequencySeries *series, const char *fname );
 
@@ -161,60 +169,52 @@ main(int argc, char *argv[])
   if (initUserVars(argc, argv, &uvar) != XLAL_SUCCESS)
     return EXIT_FAILURE;
 
+  REAL8Vector *finalPSD = NULL;
+  MultiPSDVector *multiPSDVector = NULL;
+  REAL8Vector *normSFT = NULL;
+  BOOLEAN returnMultiPSDVector = ( uvar.outputSpectBname || uvar.dumpMultiPSDVector || uvar.outputQ );
   MultiSFTVector *inputSFTs = NULL;
-  if ( ( inputSFTs = XLALReadSFTs ( &cfg, &uvar ) ) == NULL )
+  REAL8 Freq0, dFreq;	/* start frequency and frequency spacing of final PSD */
+
+  if ( uvar.chunkBand > 0 )
     {
-      XLALPrintError ("Call to XLALReadSFTs() failed with xlalErrno = %d\n", xlalErrno );
-      return EXIT_FAILURE;
+      /* streaming mode: only ever hold one frequency chunk of all SFTs in memory */
+      XLAL_CHECK_MAIN ( XLALComputePSDinChunks ( &finalPSD, &normSFT, &Freq0, &dFreq, &cfg, &uvar ) == XLAL_SUCCESS, XLAL_EFUNC );
     }
-
-  /* clean sfts if required */
-  if ( XLALUserVarWasSet( &uvar.linefiles ) )
+  else
     {
-      RandomParams *randPar=NULL;
-      FILE *fpRand=NULL;
-      INT4 seed, ranCount;
-
-      if ( (fpRand = fopen("/dev/urandom", "r")) == NULL ) {
-        fprintf(stderr,"Error in opening /dev/urandom" );
-        return EXIT_FAILURE;
-      }
-
-      if ( (ranCount = fread(&seed, sizeof(seed), 1, fpRand)) != 1 ) {
-        fprintf(stderr,"Error in getting random seed" );
-        return EXIT_FAILURE;
-      }
-
-      LAL_CALL ( LALCreateRandomParams (&status, &randPar, seed), &status );
-
-      LAL_CALL( LALRemoveKnownLinesInMultiSFTVector ( &status, inputSFTs, uvar.maxBinsClean, uvar.blocksRngMed, uvar.linefiles, randPar), &status);
-      LAL_CALL ( LALDestroyRandomParams (&status, &randPar), &status);
-      fclose(fpRand);
-    } /* end cleaning */
+      if ( ( inputSFTs = XLALReadSFTs ( &cfg, &uvar ) ) == NULL )
+        {
+          XLALPrintError ("Call to XLALReadSFTs() failed with xlalErrno = %d\n", xlalErrno );
+          return EXIT_FAILURE;
+        }
 
-  /* call the main loop function; output vectors will be allocated inside
-   * NOTE: inputSFTs will be normalized in place for efficiency reasons
-   */
-  REAL8Vector *finalPSD = NULL;
-  MultiPSDVector *multiPSDVector = NULL;
-  REAL8Vector *normSFT = NULL;
-  BOOLEAN returnMultiPSDVector = ( uvar.outputSpectBname || uvar.dumpMultiPSDVector || uvar.outputQ );
-  XLAL_CHECK_MAIN ( XLALComputePSDandNormSFTPower ( &finalPSD,
-                      &multiPSDVector,
-                      &normSFT,
-                      inputSFTs,
-                      returnMultiPSDVector,
-                      uvar.outputNormSFT,
-                      uvar.blocksRngMed,
-                      uvar.PSDmthopSFTs,
-                      uvar.PSDmthopIFOs,
-                      uvar.nSFTmthopSFTs,
-                      uvar.nSFTmthopIFOs,
-                      uvar.normalizeByTotalNumSFTs,
-                      cfg.FreqMin,
-                      cfg.FreqBand,
-                      TRUE // normalizeSFTsInPlace
-                  ) == XLAL_SUCCESS, XLAL_EFUNC );
+      /* clean sfts if required */
+      XLAL_CHECK_MAIN ( XLALCleanLinesInMultiSFTs ( inputSFTs, &uvar ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      /* call the main loop function; output vectors will be allocated inside
+       * NOTE: inputSFTs will be normalized in place for efficiency reasons
+       */
+      XLAL_CHECK_MAIN ( XLALComputePSDandNormSFTPower ( &finalPSD,
+                          &multiPSDVector,
+                          &normSFT,
+                          inputSFTs,
+                          returnMultiPSDVector,
+                          uvar.outputNormSFT,
+                          uvar.blocksRngMed,
+                          uvar.PSDmthopSFTs,
+                          uvar.PSDmthopIFOs,
+                          uvar.nSFTmthopSFTs,
+                          uvar.nSFTmthopIFOs,
+                          uvar.normalizeByTotalNumSFTs,
+                          cfg.FreqMin,
+                          cfg.FreqBand,
+                          TRUE // normalizeSFTsInPlace
+                      ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      Freq0 = inputSFTs->data[0]->data[0].f0;
+      dFreq = inputSFTs->data[0]->data[0].deltaF;
+    }
 
   /* output spectrograms */
   if ( uvar.outputSpectBname ) {
@@ -243,10 +243,12 @@ main(int argc, char *argv[])
       XLALDestroyREAL8FrequencySeries ( Q );
     } /* if outputQ */
 
+  /* write final (unbinned) PSD to HDF5 file */
+  if ( uvar.outputPSDh5 ) {
+    XLAL_CHECK_MAIN ( XLALWritePSDtoHDF5File ( uvar.outputPSDh5, finalPSD, normSFT, Freq0, dFreq, &cfg ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
   /* ---------- BINNING if requested ---------- */
-  /* start frequency and frequency spacing */
-  REAL8 Freq0 = inputSFTs->data[0]->data[0].f0;
-  REAL8 dFreq = inputSFTs->data[0]->data[0].deltaF;
   /* work out bin size */
   UINT4 finalBinSize;
   if (XLALUserVarWasSet(&uvar.binSize)) {
@@ -336,6 +338,9 @@ initUserVars (int argc, char *argv[], UserVariables_t *uvar)
 
   uvar->dumpMultiPSDVector = FALSE;
 
+  uvar->chunkBand = 0;
+  uvar->outputPSDh5 = NULL;
+
   uvar->binSizeHz = 0.0;
   uvar->binSize   = 1;
   uvar->PSDmthopBins  = MATH_OP_ARITHMETIC_MEDIAN;
@@ -392,6 +397,10 @@ initUserVars (int argc, char *argv[], UserVariables_t *uvar)
 
   XLALRegisterUvarMember(dumpMultiPSDVector,BOOLEAN, 'd',OPTIONAL, "Output multi-PSD vector over IFOs, timestamps, and frequencies into file(s) '<outputPSD>-IFO'");
 
+  XLALRegisterUvarMember(chunkBand,        REAL8, 0,  OPTIONAL, "If >0, load SFTs and compute PSD in successive frequency chunks of this width (in Hz), "
+                                                                "to bound memory usage over wide bands (requires --Freq and --FreqBand)");
+  XLALRegisterUvarMember(outputPSDh5,      STRING, 0,  OPTIONAL, "Output unbinned PSD (and normalised SFT power, if requested) as frequency series into this HDF5 file");
+
   /* ----- developer options ---------- */
   XLALRegisterUvarMember(fStart,           REAL8, 'f', DEVELOPER, "Start Frequency to load from SFT and compute PSD, including rngmed wings (BETTER: use --Freq instead)");
   XLALRegisterUvarMember(fBand,            REAL8, 'b', DEVELOPER, "Frequency Band to load from SFT and compute PSD, including rngmed wings (BETTER: use --FreqBand instead)");
@@ -460,6 +469,11 @@ initUserVars (int argc, char *argv[], UserVariables_t *uvar)
   XLAL_CHECK ( !(have_fStart && have_Freq), XLAL_EINVAL, "use only one of --fStart OR --Freq (see --help)" );
   XLAL_CHECK ( !(have_fBand && have_FreqBand), XLAL_EINVAL, "use only one of --fBand OR --FreqBand (see --help)" );
   XLAL_CHECK ( ! (( have_fStart && have_FreqBand ) || ( have_Freq && have_fBand )), XLAL_EINVAL, "don't mix {--fStart,--fBand} with {--Freq,--FreqBand} inputs (see --help)");
+  if ( uvar->chunkBand > 0 ) {
+    XLAL_CHECK ( have_Freq && have_FreqBand, XLAL_EINVAL, "--chunkBand requires --Freq and --FreqBand (see --help)" );
+    XLAL_CHECK ( !uvar->outputSpectBname && !uvar->dumpMultiPSDVector && !uvar->outputQ, XLAL_EINVAL,
+                 "--chunkBand cannot be combined with --outputSpectBname, --dumpMultiPSDVector or --outputQ, which need all frequency bins of all SFTs at once" );
+  }
 
   return XLAL_SUCCESS;
 
@@ -563,19 +577,21 @@ LALfwriteSpectrograms ( LALStatus *status, const CHAR* bname, const MultiPSDVect
 
 
 /**
- * Load all SFTs according to user-input, returns multi-SFT vector.
+ * Find all SFTs according to user-input, returns SFT catalog.
  * \return cfg:
  * Returns 'effective' range of SFT-bins [firstBin, lastBin], which which the PSD will be estimated:
  * - if the user input {fStart, fBand} then these are loaded from SFTs and directly translated into bins
  * - if user input {Freq, FreqBand}, we load a wider frequency-band ADDING running-median/2 on either side
  * from the SFTs, and firstBind, lastBin correspond to {Freq,FreqBand} (rounded to closest bins)
- * Also returns the 'data-segment' for which SFTs were loaded
+ * Also returns the 'data-segment' spanned by the SFTs, and the frequency band [fMin, fMax] to load from them
  *
  */
-MultiSFTVector *
-XLALReadSFTs ( ConfigVariables_t *cfg,		/**< [out] return derived configuration info (firstBin, lastBin, segment) */
-               const UserVariables_t *uvar	/**< [in] complete user-input */
-               )
+SFTCatalog *
+XLALFindSFTCatalog ( ConfigVariables_t *cfg,	/**< [out] return derived configuration info (firstBin, lastBin, segment) */
+                     REAL8 *fMin,		/**< [out] lowest frequency to load from SFTs */
+                     REAL8 *fMax,		/**< [out] highest frequency to load from SFTs */
+                     const UserVariables_t *uvar	/**< [in] complete user-input */
+                     )
 {
   SFTCatalog *catalog = NULL;
   SFTConstraints XLAL_INIT_DECL(constraints);
@@ -591,6 +607,7 @@ XLALReadSFTs ( ConfigVariables_t *cfg,		/**< [out] return derived configuration
     XLALPrintError ("%s: invalid NULL input 'cfg'", __func__ );
     XLAL_ERROR_NULL ( XLAL_EINVAL );
   }
+  XLAL_CHECK_NULL ( fMin && fMax, XLAL_EINVAL, "invalid NULL input 'fMin' or 'fMax'" );
 
   /* set detector constraint */
   if ( XLALUserVarWasSet ( &uvar->IFO ) )
@@ -632,15 +649,14 @@ XLALReadSFTs ( ConfigVariables_t *cfg,		/**< [out] return derived configuration
     XLALDestroyTimestampVector ( inputTimeStampsVector );
 
   /* ---------- figure out the right frequency-band to read from the SFTs, depending on user-input ----- */
-  REAL8 fMin, fMax;
   if ( XLALUserVarWasSet ( &uvar->Freq ) )
     {
       REAL8 dFreq = catalog->data[0].header.deltaF;
       /* rngmed bin offset from start and end */
       UINT4 rngmedSideBandBins = uvar->blocksRngMed / 2 + 1; /* truncates down plus add one bin extra safety! */
       REAL8 rngmedSideBand = rngmedSideBandBins * dFreq;
-      fMin = uvar->Freq - rngmedSideBand;
-      fMax = uvar->Freq + uvar->FreqBand + rngmedSideBand;
+      (*fMin) = uvar->Freq - rngmedSideBand;
+      (*fMax) = uvar->Freq + uvar->FreqBand + rngmedSideBand;
       cfg->FreqMin  = uvar->Freq;
       cfg->FreqBand = uvar->FreqBand;
     }
@@ -648,8 +664,8 @@ XLALReadSFTs ( ConfigVariables_t *cfg,		/**< [out] return derived configuration
     {
       /* if no user-input on freq-band, we fall back to defaults on {fStart, fBand} */
       /* (no truncation of rngmed sidebands) */
-      fMin = uvar->fStart;
-      fMax = uvar->fStart + uvar->fBand;
+      (*fMin) = uvar->fStart;
+      (*fMax) = uvar->fStart + uvar->fBand;
       cfg->FreqMin  = uvar->fStart;
       cfg->FreqBand = uvar->fBand;
     }
@@ -665,6 +681,29 @@ XLALReadSFTs ( ConfigVariables_t *cfg,		/**< [out] return derived configuration
   REAL8 Tsft = 1.0 / deltaF;
   XLALGPSAdd ( &endTimeGPS, Tsft );
 
+  /* return results */
+  cfg->dataSegment.start = startTimeGPS;
+  cfg->dataSegment.end   = endTimeGPS;
+
+  return catalog;
+
+} /* XLALFindSFTCatalog() */
+
+
+/**
+ * Load all SFTs according to user-input, returns multi-SFT vector.
+ * \return cfg: as returned by XLALFindSFTCatalog()
+ */
+MultiSFTVector *
+XLALReadSFTs ( ConfigVariables_t *cfg,		/**< [out] return derived configuration info (firstBin, lastBin, segment) */
+               const UserVariables_t *uvar	/**< [in] complete user-input */
+               )
+{
+  SFTCatalog *catalog = NULL;
+  REAL8 fMin, fMax;
+  XLAL_CHECK_NULL ( ( catalog = XLALFindSFTCatalog ( cfg, &fMin, &fMax, uvar ) ) != NULL, XLAL_EFUNC );
+  REAL8 deltaF = catalog->data[0].header.deltaF;
+
   /* ---------- read the sfts ---------- */
   LogPrintf (LOG_DEBUG, "Loading all SFTs over frequency band [%f,%f]...\n", fMin, fMax);
   MultiSFTVector *multi_sfts;
@@ -676,10 +715,6 @@ XLALReadSFTs ( ConfigVariables_t *cfg,		/**< [out] return derived configuration
   LogPrintfVerbatim ( LOG_DEBUG, "done.\n");
   /* ---------- end loading SFTs ---------- */
 
-  /* return results */
-  cfg->dataSegment.start = startTimeGPS;
-  cfg->dataSegment.end   = endTimeGPS;
-
   UINT4 numBins = multi_sfts->data[0]->data[0].data->length;
   REAL8 f0sfts = multi_sfts->data[0]->data[0].f0;
   LogPrintf (LOG_DEBUG, "Loaded SFTs have %d bins, sampled at %fHz, covering frequency band [%f, %f]\n", numBins, deltaF, f0sfts, f0sfts+numBins*deltaF );
@@ -689,6 +724,166 @@ XLALReadSFTs ( ConfigVariables_t *cfg,		/**< [out] return derived configuration
 } /* XLALReadSFTs() */
 
 
+/**
+ * Remove known lines given in user-input linefiles from SFTs, if requested
+ */
+int
+XLALCleanLinesInMultiSFTs ( MultiSFTVector *sfts,		/**< [in/out] SFTs to clean in place */
+                            const UserVariables_t *uvar		/**< [in] complete user-input */
+                            )
+{
+  XLAL_CHECK ( sfts && uvar, XLAL_EINVAL );
+
+  if ( !XLALUserVarWasSet( &uvar->linefiles ) ) {
+    return XLAL_SUCCESS;
+  }
+
+  static LALStatus status;
+  RandomParams *randPar=NULL;
+  FILE *fpRand=NULL;
+  INT4 seed, ranCount;
+
+  XLAL_CHECK ( (fpRand = fopen("/dev/urandom", "r")) != NULL, XLAL_EIO, "Error in opening /dev/urandom" );
+  ranCount = fread(&seed, sizeof(seed), 1, fpRand);
+  fclose(fpRand);
+  XLAL_CHECK ( ranCount == 1, XLAL_EIO, "Error in getting random seed" );
+
+  LAL_CALL ( LALCreateRandomParams (&status, &randPar, seed), &status );
+  LAL_CALL( LALRemoveKnownLinesInMultiSFTVector ( &status, sfts, uvar->maxBinsClean, uvar->blocksRngMed, uvar->linefiles, randPar), &status);
+  LAL_CALL ( LALDestroyRandomParams (&status, &randPar), &status);
+
+  return XLAL_SUCCESS;
+
+} /* XLALCleanLinesInMultiSFTs() */
+
+
+/**
+ * Compute the PSD and (optionally) the normalised SFT power over the band {Freq, FreqBand}
+ * in successive frequency chunks of width {chunkBand}: for each chunk, only the bins of that
+ * chunk plus running-median wings are read from the SFTs (which the SFT reader
+ * seeks to directly), so that memory usage is bounded by the chunk width rather than
+ * the full band. The results are identical to processing the full band at once.
+ */
+int
+XLALComputePSDinChunks ( REAL8Vector **finalPSD,	/**< [out] final PSD over all chunks */
+                         REAL8Vector **normSFT,		/**< [out] normalised SFT power over all chunks (if requested) */
+                         REAL8 *Freq0,			/**< [out] start frequency of final PSD */
+                         REAL8 *dFreq,			/**< [out] frequency spacing of final PSD */
+                         ConfigVariables_t *cfg,	/**< [out] return derived configuration info */
+                         const UserVariables_t *uvar	/**< [in] complete user-input */
+                         )
+{
+  XLAL_CHECK ( finalPSD && normSFT && Freq0 && dFreq && cfg && uvar, XLAL_EINVAL );
+  XLAL_CHECK ( uvar->chunkBand > 0, XLAL_EINVAL );
+
+  SFTCatalog *catalog = NULL;
+  REAL8 fMin, fMax;
+  XLAL_CHECK ( ( catalog = XLALFindSFTCatalog ( cfg, &fMin, &fMax, uvar ) ) != NULL, XLAL_EFUNC );
+  const REAL8 deltaF = catalog->data[0].header.deltaF;
+
+  /* work out the output bins, using the same rounding convention as XLALComputePSDandNormSFTPower() */
+  const UINT4 firstBin = XLALRoundFrequencyDownToSFTBin ( cfg->FreqMin, deltaF );
+  const UINT4 numBins = XLALRoundFrequencyUpToSFTBin ( cfg->FreqBand, deltaF ) + 1;
+  const UINT4 chunkBins = GSL_MAX ( 1, (UINT4)floor ( uvar->chunkBand / deltaF + 0.5 ) ); /* round to nearest bin */
+  const UINT4 rngmedSideBandBins = uvar->blocksRngMed / 2 + 1; /* truncates down plus add one bin extra safety! */
+
+  XLAL_CHECK ( (*finalPSD = XLALCreateREAL8Vector ( numBins )) != NULL, XLAL_EFUNC );
+  if ( uvar->outputNormSFT ) {
+    XLAL_CHECK ( (*normSFT = XLALCreateREAL8Vector ( numBins )) != NULL, XLAL_EFUNC );
+  }
+  *dFreq = deltaF;
+
+  for ( UINT4 b = 0; b < numBins; b += chunkBins )
+    {
+      const UINT4 numChunkBins = GSL_MIN ( chunkBins, numBins - b );
+      const REAL8 chunkFreq = ( firstBin + b ) * deltaF;
+      const REAL8 chunkBand = ( numChunkBins - 1 ) * deltaF;
+      const REAL8 fMinChunk = chunkFreq - rngmedSideBandBins * deltaF;
+      const REAL8 fMaxChunk = chunkFreq + chunkBand + rngmedSideBandBins * deltaF;
+
+      LogPrintf (LOG_DEBUG, "Loading all SFTs over frequency chunk [%f,%f]...\n", fMinChunk, fMaxChunk);
+      MultiSFTVector *sfts = NULL;
+      XLAL_CHECK ( ( sfts = XLALLoadMultiSFTs ( catalog, fMinChunk, fMaxChunk ) ) != NULL, XLAL_EFUNC,
+                   "XLALLoadMultiSFTs( %f, %f ) failed with xlalErrno = %d", fMinChunk, fMaxChunk, xlalErrno );
+      LogPrintfVerbatim ( LOG_DEBUG, "done.\n");
+
+      XLAL_CHECK ( XLALCleanLinesInMultiSFTs ( sfts, uvar ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      REAL8Vector *chunkPSD = NULL;
+      MultiPSDVector *chunkMultiPSD = NULL;
+      REAL8Vector *chunkNormSFT = NULL;
+      XLAL_CHECK ( XLALComputePSDandNormSFTPower ( &chunkPSD,
+                     &chunkMultiPSD,
+                     &chunkNormSFT,
+                     sfts,
+                     FALSE, // returnMultiPSDVector
+                     uvar->outputNormSFT,
+                     uvar->blocksRngMed,
+                     uvar->PSDmthopSFTs,
+                     uvar->PSDmthopIFOs,
+                     uvar->nSFTmthopSFTs,
+                     uvar->nSFTmthopIFOs,
+                     uvar->normalizeByTotalNumSFTs,
+                     chunkFreq,
+                     chunkBand,
+                     TRUE // normalizeSFTsInPlace
+                     ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK ( chunkPSD->length == numChunkBins, XLAL_EFAILED, "PSD over frequency chunk has %u bins, expected %u", chunkPSD->length, numChunkBins );
+
+      if ( b == 0 ) {
+        *Freq0 = sfts->data[0]->data[0].f0;
+      }
+      memcpy ( (*finalPSD)->data + b, chunkPSD->data, numChunkBins * sizeof ( (*finalPSD)->data[0] ) );
+      if ( uvar->outputNormSFT ) {
+        memcpy ( (*normSFT)->data + b, chunkNormSFT->data, numChunkBins * sizeof ( (*normSFT)->data[0] ) );
+      }
+
+      XLALDestroyREAL8Vector ( chunkPSD );
+      XLALDestroyREAL8Vector ( chunkNormSFT );
+      XLALDestroyMultiSFTVector ( sfts );
+
+    } /* for b < numBins */
+
+  XLALDestroySFTCatalog ( catalog );
+
+  return XLAL_SUCCESS;
+
+} /* XLALComputePSDinChunks() */
+
+
+/**
+ * Write the final PSD, and the normalised SFT power if non-NULL, as frequency series
+ * 'PSD' and 'normSFTpower' into an HDF5 file
+ */
+int
+XLALWritePSDtoHDF5File ( const CHAR *fname,		/**< [in] filename to write into */
+                         REAL8Vector *finalPSD,		/**< [in] final PSD */
+                         REAL8Vector *normSFT,		/**< [in] normalised SFT power (optional) */
+                         const REAL8 Freq0,		/**< [in] start frequency */
+                         const REAL8 dFreq,		/**< [in] frequency spacing */
+                         const ConfigVariables_t *cfg	/**< [in] derived configuration info */
+                         )
+{
+  XLAL_CHECK ( fname && finalPSD && cfg, XLAL_EINVAL );
+
+  LALH5File *file = NULL;
+  XLAL_CHECK ( ( file = XLALH5FileOpen ( fname, "w" ) ) != NULL, XLAL_EFUNC, "Unable to open output file %s for writing", fname );
+
+  REAL8FrequencySeries series = { .name = "PSD", .epoch = cfg->dataSegment.start, .f0 = Freq0, .deltaF = dFreq, .sampleUnits = lalDimensionlessUnit, .data = finalPSD };
+  XLAL_CHECK ( XLALH5FileWriteREAL8FrequencySeries ( file, "PSD", &series ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( normSFT ) {
+    strcpy ( series.name, "normSFTpower" );
+    series.data = normSFT;
+    XLAL_CHECK ( XLALH5FileWriteREAL8FrequencySeries ( file, "normSFTpower", &series ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  XLALH5FileClose ( file );
+
+  return XLAL_SUCCESS;
+
+} /* XLALWritePSDtoHDF5File() */
+
+
 /**
  * Write given REAL8FrequencySeries into file
  */
@@ -81,7 +81,7 @@ int main(int argc, char *argv[]){
   CHAR *uvar_sftDir;    /* directory for unclean sfts */
   CHAR *uvar_outDir;   /* directory for cleaned sfts */
   REAL8 uvar_fMin, uvar_fMax;
-  INT4  uvar_window, uvar_maxBins, uvar_addComment;
+  INT4  uvar_window, uvar_maxBins, uvar_addComment, uvar_blockSFTs;
   BOOLEAN uvar_outSingleSFT;
 
   /* set defaults */
@@ -93,6 +93,7 @@ int main(int argc, char *argv[]){
   uvar_maxBins = 20;
   uvar_addComment = CMT_FULL; /* add VCS ID and full command-line to every SFT file */
   uvar_outSingleSFT = FALSE;
+  uvar_blockSFTs = 1;
 
   /* register user input variables */
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_sftDir,    "sftDir",    STRING,       'i', REQUIRED,  "Input SFT file pattern") == XLAL_SUCCESS, XLAL_EFUNC);
@@ -105,11 +106,14 @@ int main(int argc, char *argv[]){
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_addComment, "addComment", INT4,       'c', OPTIONAL, "How to deal with comments - 0 means no comment is written at all, 1 means that the comment is taken unmodified from the input SFTs, 2 (default) means that the program appends its RCS id and command-line to the comment.") == XLAL_SUCCESS, XLAL_EFUNC);
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar ( &uvar_outSingleSFT, "outSingleSFT", BOOLEAN, 's', OPTIONAL, "Write a single concatenated SFT file per IFO, instead of individual files") == XLAL_SUCCESS, XLAL_EFUNC );
 
+  XLAL_CHECK_MAIN( XLALRegisterNamedUvar ( &uvar_blockSFTs, "blockSFTs", INT4, 0, OPTIONAL, "Number of SFTs per detector to load and clean at once; the SFTs in each block are cleaned in parallel if compiled with OpenMP support") == XLAL_SUCCESS, XLAL_EFUNC );
+
   /* read all command line variables */
   BOOLEAN should_exit = 0;
   XLAL_CHECK_MAIN( XLALUserVarReadAllInput(&should_exit, argc, argv, lalAppsVCSInfoList) == XLAL_SUCCESS, XLAL_EFUNC);
   if (should_exit)
     exit(1);
+  XLAL_CHECK_MAIN( uvar_blockSFTs > 0, XLAL_EINVAL, "--blockSFTs must be strictly positive" );
 
   /* record VCS ID and command-line for the comment */
   char *cmdline = NULL;
@@ -200,34 +204,16 @@ int main(int argc, char *argv[]){
       printf ( "Writing %d cleaned SFTs for %s to individual output files in %s ...\n", numSFTs, multiCatalogView->data[X].data[0].header.name, uvar_outDir );
     }
 
-    /* loop over SFTs for this IFO and clean them -- load one SFT at a time */
-    thisCatalog.length = 1;
-    for (UINT4 j=0; j<numSFTs; j++) {
+    /* loop over SFTs for this IFO and clean them -- load a block of blockSFTs SFTs at a time */
+    for (UINT4 j0=0; j0<numSFTs; j0+=uvar_blockSFTs) {
 
-      thisCatalog.data = multiCatalogView->data[X].data + j;
+      thisCatalog.data = multiCatalogView->data[X].data + j0;
+      thisCatalog.length = ( numSFTs - j0 < (UINT4)uvar_blockSFTs ) ? numSFTs - j0 : (UINT4)uvar_blockSFTs;
 
-      /* read a multi-SFT vector, but it will only cover a single IFO and a single SFT */
+      /* read a multi-SFT vector, but it will only cover a single IFO and a block of SFTs */
       XLAL_CHECK_MAIN( ( inputSFTs = XLALLoadMultiSFTs ( &thisCatalog, uvar_fMin, uvar_fMax) ) != NULL, XLAL_EFUNC);
       XLAL_CHECK_MAIN( inputSFTs->length == 1, XLAL_EIO, "We should have data from a single IFO here, but have inputSFTs->length==%d", inputSFTs->length );
-
-      /* construct comment for output SFTs */
-      char *comment = NULL;
-      char *oldcomment = thisCatalog.data[0].comment;
-      int comment_length = strlen(oldcomment) + 1;
-      if ( uvar_addComment > CMT_OLD ) {
-        /* allocate space for new comment */
-        XLAL_CHECK_MAIN( ( comment = ( char * )XLALMalloc( comment_length + strlen( cmdline ) + 1 ) ) != NULL, XLAL_ENOMEM, "out of memory allocating comment" );
-        /* append the commandline of this program to the old comment */
-        if ( oldcomment ) {
-            strcpy( comment, oldcomment );
-        } else {
-            *comment = '\0';
-        }
-        strcat( comment, cmdline );
-      } else if ( uvar_addComment == CMT_OLD ) {
-        /* only copied existing comment, no additional space needed */
-        comment = oldcomment;
-      } /* else (uvar_addComment == CMT_NONE) and (comment == NULL) i.e. no comment at all */
+      XLAL_CHECK_MAIN( inputSFTs->data[0]->length == thisCatalog.length, XLAL_EIO, "We should have %d SFTs here, but have %d", thisCatalog.length, inputSFTs->data[0]->length );
 
       /* clean lines
        * Here we still pass the full, possible multi-IFO linesfiles,
@@ -238,23 +224,44 @@ int main(int argc, char *argv[]){
         LAL_CALL( LALRemoveKnownLinesInMultiSFTVector ( &status, inputSFTs, uvar_maxBins,
                       uvar_window, uvar_linefiles, randPar), &status);
       }
-  
-      /* write output - technically looping over all SFTs for a single detector here,
-       * but actually the current implementation has it always be a single SFT too
-       */
-      if ( uvar_outSingleSFT ) {
-        for ( UINT4 k = 0; k < inputSFTs->data[0]->length; k++ ) {
-          SFTtype *this_sft = &( inputSFTs->data[0]->data[k] );
-          XLAL_CHECK ( XLALWriteSFT2fp ( this_sft, fpout, comment ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      /* write output, one SFT at a time since each SFT has its own comment */
+      for ( UINT4 k = 0; k < inputSFTs->data[0]->length; k++ ) {
+
+        /* construct comment for output SFT */
+        char *comment = NULL;
+        char *oldcomment = thisCatalog.data[k].comment;
+        if ( uvar_addComment > CMT_OLD ) {
+          /* allocate space for new comment */
+          int comment_length = ( oldcomment ? strlen(oldcomment) : 0 ) + 1;
+          XLAL_CHECK_MAIN( ( comment = ( char * )XLALMalloc( comment_length + strlen( cmdline ) + 1 ) ) != NULL, XLAL_ENOMEM, "out of memory allocating comment" );
+          /* append the commandline of this program to the old comment */
+          if ( oldcomment ) {
+              strcpy( comment, oldcomment );
+          } else {
+              *comment = '\0';
+          }
+          strcat( comment, cmdline );
+        } else if ( uvar_addComment == CMT_OLD ) {
+          /* only copied existing comment, no additional space needed */
+          comment = oldcomment;
+        } /* else (uvar_addComment == CMT_NONE) and (comment == NULL) i.e. no comment at all */
+
+        SFTtype *this_sft = &( inputSFTs->data[0]->data[k] );
+        if ( uvar_outSingleSFT ) {
+          XLAL_CHECK_MAIN ( XLALWriteSFT2fp ( this_sft, fpout, comment ) == XLAL_SUCCESS, XLAL_EFUNC );
+        } else {
+          SFTVector this_sftvect = { .length = 1, .data = this_sft };
+          XLAL_CHECK_MAIN( XLALWriteSFTVector2Dir ( &this_sftvect, uvar_outDir, comment, misc ) == XLAL_SUCCESS, XLAL_EFUNC);
+        }
+
+        if ( uvar_addComment > CMT_OLD ) {
+          XLALFree( comment );
         }
-      } else {
-        XLAL_CHECK_MAIN( XLALWriteSFTVector2Dir ( inputSFTs->data[0], uvar_outDir, comment, misc ) == XLAL_SUCCESS, XLAL_EFUNC);
+
       }
 
       XLALDestroyMultiSFTVector( inputSFTs);
-      if ( uvar_addComment > CMT_OLD ) {
-        XLALFree( comment );
-      }
 
     } /* end loop over sfts */
 
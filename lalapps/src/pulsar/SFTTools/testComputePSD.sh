@@ -300,4 +300,34 @@ for mthopidx in 0 1; do
     fi
 done # loop over mthops
 
+
+echo "----------------------------------------------------------------------"
+echo "STEP 4: testing streaming mode over frequency chunks..."
+echo "----------------------------------------------------------------------"
+echo
+
+## ----- the same band processed at once and in chunks of 7 bins must agree exactly
+outPSD_once="./psd_once.dat"
+outPSD_chunks="./psd_chunks.dat"
+for chunkBit in "" "--chunkBand=0.0038"; do
+    if [ -z "$chunkBit" ]; then
+        psdfile=$outPSD_once
+    else
+        psdfile=$outPSD_chunks
+    fi
+    cmdline="${psd_code} --inputData=${outSFTbname}* --outputPSD=$psdfile --blocksRngMed=$blocksRngMed --outputNormSFT=1 --Freq=50.03 --FreqBand=0.04 --PSDmthopSFTs=arithmedian --PSDmthopIFOs=arithmedian $chunkBit"
+    echo $cmdline;
+    if ! eval $cmdline; then
+        echo "Error.. something failed when running '$psd_code' ..."
+        exit 1
+    fi
+done
+if ! diff <(grep -v '^%' $outPSD_once) <(grep -v '^%' $outPSD_chunks); then
+    echo " ==> FAILED"
+    retstatus=1
+else
+    echo "========== OK. Results over frequency chunks consistent. =========="
+    echo
+fi
+
 exit $retstatus
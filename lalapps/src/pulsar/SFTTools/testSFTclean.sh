@@ -195,6 +195,9 @@ test_cleaning "50.005 0.0 1 0.0 0.0 /*line1*/\n50.01 0.0 1 0.0 0.0 /*line2*/" "2
 echo
 test_cleaning "50.005 0.0 1 1.0 1.0 /*very_wide_line*/" $nBins
 
+echo
+test_cleaning "50.005 0.0 1 0.000555556 0.000555556 /*line_with_wings_in_blocks*/" "3" "--blockSFTs=2"
+
 echo
 echo "----------------------------------------------------------------------"
 echo "STEP 4: test --outSingleSFT mode"
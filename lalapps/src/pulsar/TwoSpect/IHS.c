@@ -27,6 +27,10 @@
 #include "vectormath.h"
 #include "TwoSpect.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 /**
  * Create vectors for IHS maxima struct
@@ -122,20 +126,40 @@ INT4 runIHS(ihsMaximaStruct *output, const ffdataStruct *input, const ihsfarStru
    }
 
    //Loop through the rows, 1 frequency at a time
-   for (UINT4 ii=0; ii<ihss->length; ii++) {
-
-      //For each row, populate it with the data for that frequency bin, excluding harmonics of antenna pattern modulation
-      memcpy(row->data, &(input->ffdata->data[ii*numfprbins]), sizeof(REAL4)*numfprbins);
-      if (!params->noNotchHarmonics) for (UINT4 jj=0; jj<row->length; jj++) if (markedharmonics->data[jj]==1) row->data[jj] = 0.0;
-
-      //Run the IHS algorithm on the row
-      if (!params->weightedIHS) XLAL_CHECK( incHarmSumVector(ihsvector, row, params->ihsfactor) == XLAL_SUCCESS, XLAL_EFUNC );
-      else XLAL_CHECK( incHarmSumVectorWeighted(ihsvector, row, aveNoise, params->ihsfactor) == XLAL_SUCCESS, XLAL_EFUNC );
+   //Rows are independent, so they are shared out between threads, each with its own row buffer
+   INT4 errnum = XLAL_SUCCESS;
+#pragma omp parallel num_threads(params->numThreads) if(params->numThreads > 1)
+   {
+      INT4 threaderrnum = XLAL_SUCCESS;
+      REAL4VectorAligned *threadrow = row;
+#ifdef _OPENMP
+      if (omp_get_thread_num() > 0 && (threadrow = XLALCreateREAL4VectorAligned(numfprbins, 32)) == NULL) threaderrnum = XLAL_ENOMEM;
+#endif
+
+#pragma omp for schedule(static)
+      for (INT4 ii=0; ii<(INT4)ihss->length; ii++) {
+         if (threaderrnum != XLAL_SUCCESS) continue;
+
+         //For each row, populate it with the data for that frequency bin, excluding harmonics of antenna pattern modulation
+         memcpy(threadrow->data, &(input->ffdata->data[ii*numfprbins]), sizeof(REAL4)*numfprbins);
+         if (!params->noNotchHarmonics) for (UINT4 jj=0; jj<threadrow->length; jj++) if (markedharmonics->data[jj]==1) threadrow->data[jj] = 0.0;
+
+         //Run the IHS algorithm on the row, directly into the ihsvector array
+         if (!params->weightedIHS) {
+            if (incHarmSumVector(ihsvectorarray->data[ii], threadrow, params->ihsfactor) != XLAL_SUCCESS) threaderrnum = XLAL_EFUNC;
+         } else {
+            if (incHarmSumVectorWeighted(ihsvectorarray->data[ii], threadrow, aveNoise, params->ihsfactor) != XLAL_SUCCESS) threaderrnum = XLAL_EFUNC;
+         }
 
-      //Copy the result into the ihsvector array
-      memcpy(ihsvectorarray->data[ii]->data, ihsvector->data, sizeof(REAL4)*ihsvector->length);
+      } /* for ii < ihss->length */
 
-   } /* for ii < ihss->length */
+      if (threadrow != row) XLALDestroyREAL4VectorAligned(threadrow);
+      if (threaderrnum != XLAL_SUCCESS) {
+#pragma omp critical(runIHS_errnum)
+         errnum = threaderrnum;
+      }
+   }
+   XLAL_CHECK( errnum == XLAL_SUCCESS, errnum );
 
    //Now do the summing of the IHS values
    XLAL_CHECK( sumIHSarray(output, ihsfarinput, ihsvectorarray, rows, FbinMean, params) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -641,8 +665,9 @@ INT4 sumIHSarray(ihsMaximaStruct *output, const ihsfarStruct *inputfar, REAL4Vec
       } /* for jj=0 --> jj<harmonicNumToSearch */
    }
 
-   //Useful variables
-   INT4Vector *rowarraylocs = NULL;
+   //Running sums of the noise, used to scale the expected IHS background
+   REAL4VectorAligned *sumsofnoise = NULL;
+   XLAL_CHECK( (sumsofnoise = XLALCreateREAL4VectorAligned(ihsvectorarray->length, 32)) != NULL, XLAL_EFUNC );
 
    //Start with the single IHS vector and march up with nearest neighbor sums up to the total number of row sums
    for (UINT4 ii=1; ii<=rows; ii++) {
@@ -652,67 +677,98 @@ INT4 sumIHSarray(ihsMaximaStruct *output, const ihsfarStruct *inputfar, REAL4Vec
          memcpy(output->locationsForEachFbin->data, ihslocations->data, sizeof(INT4)*ihslocations->length);
       } else {
          //For everything 2 nearest neighbors and higher summed
-         XLAL_CHECK( (rowarraylocs = XLALCreateINT4Vector(ii)) != NULL, XLAL_EFUNC );
-
          //The maximum index to search in the IHS vector
          maxIndexForIHS = (INT4)ceil(fmin(params->Tobs/params->Pmin, fmin(params->Tobs/minPeriod(0.5*(ii-1)/params->Tsft, params->Tsft), params->Tobs/(4.0*params->Tsft)))) - 5;
 
-         REAL4 sumofnoise = 0.0;    //To scale the expected IHS background
          INT4 endloc = ((ii-1)*(ii-1)-(ii-1))/2;
+         INT4 numsums = (INT4)(ihsvectorarray->length-(ii-1));
 
-         //Sum up the IHS vectors using SSE functions
-         if (params->vectorMath!=0) {
-            if (ii>2) XLAL_CHECK( VectorArraySum(tworows, tworows, ihsvectorarray, 0, ii-1, 0, (INT4)(ihsvectorarray->length-(ii-1))) == XLAL_SUCCESS, XLAL_EFUNC );
-            else XLAL_CHECK( VectorArraySum(tworows, ihsvectorarray, ihsvectorarray, 0, ii-1, 0, (INT4)(ihsvectorarray->length-(ii-1))) == XLAL_SUCCESS, XLAL_EFUNC );
-         }
-
-         //Loop through the IHS vector neighbor sums
-         for (UINT4 jj=0; jj<ihsvectorarray->length-(ii-1); jj++) {
-            //If we didn't use SSE to sum the vector array (see lines above)
-            if (params->vectorMath==0) {
-               if (ii>2) for (UINT4 kk=0; kk<tworows->data[jj]->length; kk++) tworows->data[jj]->data[kk] += ihsvectorarray->data[ii-1+jj]->data[kk];
-               else for (UINT4 kk=0; kk<tworows->data[jj]->length; kk++) tworows->data[jj]->data[kk] = ihsvectorarray->data[jj]->data[kk] + ihsvectorarray->data[jj+1]->data[kk];
-            }
-
-            //To scale the background efficiently
+         //To scale the background efficiently, the running sums are computed before the neighbor sums are shared out between threads
+         REAL4 sumofnoise = 0.0;
+         for (INT4 jj=0; jj<numsums; jj++) {
             if (jj==0) for (UINT4 kk=0; kk<ii; kk++) sumofnoise += FbinMean->data[kk];
             else {
                sumofnoise -= FbinMean->data[jj-1];
                sumofnoise += FbinMean->data[jj+(ii-1)];
             }
+            sumsofnoise->data[jj] = sumofnoise;
+         }
+
+         //Loop through the IHS vector neighbor sums; each sum only touches its own row of tworows
+         INT4 errnum = XLAL_SUCCESS;
+#pragma omp parallel num_threads(params->numThreads) if(params->numThreads > 1)
+         {
+            INT4 threaderrnum = XLAL_SUCCESS;
+            REAL4VectorAligned *threadexcess = excessabovenoise, *threadscaled = scaledExpectedIHSVectorValues;
+            INT4Vector *rowarraylocs = NULL;
+#ifdef _OPENMP
+            if (omp_get_thread_num() > 0) {
+               threadexcess = XLALCreateREAL4VectorAligned(excessabovenoise->length, 32);
+               threadscaled = XLALCreateREAL4VectorAligned(scaledExpectedIHSVectorValues->length, 32);
+               if (threadexcess == NULL || threadscaled == NULL) threaderrnum = XLAL_ENOMEM;
+            }
+#endif
+            if ((rowarraylocs = XLALCreateINT4Vector(ii)) == NULL) threaderrnum = XLAL_ENOMEM;
 
-            //If using SSE, scale the expected IHS vector, subtract the noise from the data
-            XLAL_CHECK( XLALVectorScaleREAL4(scaledExpectedIHSVectorValues->data, sumofnoise, inputfar->expectedIHSVector->data, inputfar->expectedIHSVector->length) == XLAL_SUCCESS, XLAL_EFUNC );
-            XLAL_CHECK( VectorSubtractREAL4(excessabovenoise, tworows->data[jj], scaledExpectedIHSVectorValues, params->vectorMath) == XLAL_SUCCESS, XLAL_EFUNC );
+#pragma omp for schedule(static)
+            for (INT4 jj=0; jj<numsums; jj++) {
+               if (threaderrnum != XLAL_SUCCESS) continue;
 
-            //Compute the maximum IHS value in the second FFT frequency direction
-            //search over the range of Pmin-->Pmax and higher harmonics the user has specified
-            for (INT4 kk=0; kk<params->harmonicNumToSearch; kk++) {
-               if (kk==0) {
-                  output->locations->data[(ii-2)*ihsvalues->length-endloc+jj] = max_index_in_range(excessabovenoise, minIndexForIHS, maxIndexForIHS) + 5;
-                  output->maxima->data[(ii-2)*ihsvalues->length-endloc+jj] = tworows->data[jj]->data[(output->locations->data[(ii-2)*ihsvalues->length-endloc+jj]-5)];
+               //Sum up the IHS vectors
+               if (params->vectorMath!=0) {
+                  if (ii>2) {
+                     if (XLALVectorAddREAL4(tworows->data[jj]->data, tworows->data[jj]->data, ihsvectorarray->data[ii-1+jj]->data, tworows->data[jj]->length) != XLAL_SUCCESS) { threaderrnum = XLAL_EFUNC; continue; }
+                  } else {
+                     if (XLALVectorAddREAL4(tworows->data[jj]->data, ihsvectorarray->data[jj]->data, ihsvectorarray->data[jj+1]->data, tworows->data[jj]->length) != XLAL_SUCCESS) { threaderrnum = XLAL_EFUNC; continue; }
+                  }
                } else {
-                  INT4 newIHSlocation = max_index_in_range(excessabovenoise, (kk+1)*minIndexForIHS, (kk+1)*maxIndexForIHS) + 5;
-                  REAL4 newIHSvalue = tworows->data[ii]->data[newIHSlocation-5];
-                  if (newIHSvalue > output->maxima->data[(ii-2)*ihsvalues->length-endloc+jj]) {
-                     output->locations->data[(ii-2)*ihsvalues->length-endloc+jj] = newIHSlocation;
-                     output->maxima->data[(ii-2)*ihsvalues->length-endloc+jj] = newIHSvalue;
-                  } /* if the new value is better than the previous value */
+                  if (ii>2) for (UINT4 kk=0; kk<tworows->data[jj]->length; kk++) tworows->data[jj]->data[kk] += ihsvectorarray->data[ii-1+jj]->data[kk];
+                  else for (UINT4 kk=0; kk<tworows->data[jj]->length; kk++) tworows->data[jj]->data[kk] = ihsvectorarray->data[jj]->data[kk] + ihsvectorarray->data[jj+1]->data[kk];
                }
-            } /* for kk=0 --> kk<harmonicNumToSearch */
 
-            memcpy(rowarraylocs->data, &(ihslocations->data[jj]), sizeof(INT4)*ii);
-            output->foms->data[(ii-2)*ihsvalues->length-endloc+jj] = ihsFOM(rowarraylocs, (INT4)inputfar->expectedIHSVector->length);
-            XLAL_CHECK( xlalErrno == 0, XLAL_EFUNC );
-         } /* for jj< ihsvectorarray->length - (ii-1) */
+               //Scale the expected IHS vector, subtract the noise from the data
+               if (XLALVectorScaleREAL4(threadscaled->data, sumsofnoise->data[jj], inputfar->expectedIHSVector->data, inputfar->expectedIHSVector->length) != XLAL_SUCCESS || VectorSubtractREAL4(threadexcess, tworows->data[jj], threadscaled, params->vectorMath) != XLAL_SUCCESS) {
+                  threaderrnum = XLAL_EFUNC;
+                  continue;
+               }
 
-         XLALDestroyINT4Vector(rowarraylocs);
-         rowarraylocs = NULL;
+               //Compute the maximum IHS value in the second FFT frequency direction
+               //search over the range of Pmin-->Pmax and higher harmonics the user has specified
+               INT4 outloc = (ii-2)*ihsvalues->length-endloc+jj;
+               for (INT4 kk=0; kk<params->harmonicNumToSearch; kk++) {
+                  if (kk==0) {
+                     output->locations->data[outloc] = max_index_in_range(threadexcess, minIndexForIHS, maxIndexForIHS) + 5;
+                     output->maxima->data[outloc] = tworows->data[jj]->data[(output->locations->data[outloc]-5)];
+                  } else {
+                     INT4 newIHSlocation = max_index_in_range(threadexcess, (kk+1)*minIndexForIHS, (kk+1)*maxIndexForIHS) + 5;
+                     REAL4 newIHSvalue = tworows->data[jj]->data[newIHSlocation-5];
+                     if (newIHSvalue > output->maxima->data[outloc]) {
+                        output->locations->data[outloc] = newIHSlocation;
+                        output->maxima->data[outloc] = newIHSvalue;
+                     } /* if the new value is better than the previous value */
+                  }
+               } /* for kk=0 --> kk<harmonicNumToSearch */
+
+               memcpy(rowarraylocs->data, &(ihslocations->data[jj]), sizeof(INT4)*ii);
+               output->foms->data[outloc] = ihsFOM(rowarraylocs, (INT4)inputfar->expectedIHSVector->length);
+               if (xlalErrno != 0) threaderrnum = XLAL_EFUNC;
+            } /* for jj < numsums */
+
+            XLALDestroyINT4Vector(rowarraylocs);
+            if (threadexcess != excessabovenoise) XLALDestroyREAL4VectorAligned(threadexcess);
+            if (threadscaled != scaledExpectedIHSVectorValues) XLALDestroyREAL4VectorAligned(threadscaled);
+            if (threaderrnum != XLAL_SUCCESS) {
+#pragma omp critical(sumIHSarray_errnum)
+               errnum = threaderrnum;
+            }
+         }
+         XLAL_CHECK( errnum == XLAL_SUCCESS, errnum );
       }
 
    } /* for ii <= rows */
 
    destroyREAL4VectorAlignedArray(tworows);
+   XLALDestroyREAL4VectorAligned(sumsofnoise);
    XLALDestroyREAL4VectorAligned(scaledExpectedIHSVectorValues);
    XLALDestroyREAL4VectorAligned(excessabovenoise);
    XLALDestroyREAL4VectorAligned(ihsvalues);
@@ -1673,6 +1673,7 @@ INT4 readTwoSpectInputParams(UserInput_t *uvar, int argc, char *argv[])
    uvar->maxTemplateLength = 500;
    uvar->FFTplanFlag = 1;
    uvar->vectorMath = 0;
+   uvar->numThreads = 1;
    uvar->injRandSeed = 0;
    uvar->ULsolver = 0;
    uvar->dopplerMultiplier = 1.0;
@@ -1744,6 +1745,7 @@ INT4 readTwoSpectInputParams(UserInput_t *uvar, int argc, char *argv[])
    XLALRegisterUvarMember(FFTplanFlag,                    INT4, 0 , OPTIONAL,  "0=Estimate, 1=Measure, 2=Patient, 3=Exhaustive");
    XLALRegisterUvarMember(fastchisqinv,                  BOOLEAN, 0 , OPTIONAL,  "Use a faster central chi-sq inversion function (roughly float precision instead of double)");
    XLALRegisterUvarMember(vectorMath,                     INT4, 0 , OPTIONAL,  "Vector math functions: 0=None, 1=SSE, 2=AVX/SSE (Note that user needs to have compiled for SSE or AVX/SSE or program fails)");
+   XLALRegisterUvarMember(numThreads,                     INT4, 0 , OPTIONAL,  "Number of threads used for the IHS stage and the template bank evaluation (requires OpenMP if more than 1)");
    XLALRegisterUvarMember(followUpOutsideULrange,        BOOLEAN, 0 , OPTIONAL,  "Follow up outliers outside the range of the UL values");
    XLALRegisterUvarMember(timestampsFile,                STRINGVector, 0 , OPTIONAL,  "CSV list of files with timestamps, file-format: lines of <GPSsec> <GPSnsec>, conflicts with inputSFTs and segmentFile");
    XLALRegisterUvarMember(segmentFile,                   STRINGVector, 0 , OPTIONAL,  "CSV list of files with segments, file-format: lines with <GPSstart> <GPSend>, conflicts with inputSFTs and timestampsFile");
@@ -1874,6 +1876,12 @@ INT4 readTwoSpectInputParams(UserInput_t *uvar, int argc, char *argv[])
    //Check SSE/AVX settings
    if (uvar->vectorMath>2 || uvar->vectorMath<0) XLAL_ERROR(XLAL_FAILURE, "Must specify vectorMath to be 0, 1, or 2");
 
+   //Check thread settings
+   if (uvar->numThreads<1) XLAL_ERROR(XLAL_EINVAL, "numThreads must be at least 1\n");
+#if !defined(_OPENMP)
+   if (uvar->numThreads>1) XLAL_ERROR(XLAL_EINVAL, "numThreads > 1 requires TwoSpect to be compiled with OpenMP\n");
+#endif
+
    //Developer options
    if (uvar->templateTest && uvar->bruteForceTemplateTest) XLAL_ERROR(XLAL_FAILURE, "Specify one of templateTest or bruteForceTemplateTest\n");
    if ((uvar->templateTest || uvar->bruteForceTemplateTest) || XLALUserVarWasSet(&uvar->templateTestF) || XLALUserVarWasSet(&uvar->templateTestP) || XLALUserVarWasSet(&uvar->templateTestDf)) {
@@ -93,6 +93,7 @@ typedef struct {
    INT4 FFTplanFlag;
    BOOLEAN fastchisqinv;
    INT4 vectorMath;
+   INT4 numThreads;
    BOOLEAN followUpOutsideULrange;
    LALStringVector *timestampsFile;
    LALStringVector *segmentFile;
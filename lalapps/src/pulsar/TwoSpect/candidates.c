@@ -1104,11 +1104,25 @@ INT4 testTwoSpectTemplateVector(candidateVector *output, const TwoSpectTemplateV
    XLAL_CHECK( output!=NULL && templateVec!=NULL && ffdata!=NULL && aveNoise!=NULL && aveTFnoisePerFbinRatio!=NULL && params!=NULL && rng!=NULL, XLAL_EINVAL );
 
    fprintf(stderr, "Testing TwoSpectTemplateVector... ");
-   
-   TwoSpectTemplate *template = NULL;
-   XLAL_CHECK( (template = createTwoSpectTemplate(templateLen)) != NULL, XLAL_EFUNC );
 
-   INT4 proberrcode = 0;
+   //Number of templates in the vector (the list is terminated by an empty template)
+   UINT4 numtemplates = 0;
+   while (numtemplates<templateVec->length && templateVec->data[numtemplates]->templatedata->data[0] != 0.0) numtemplates++;
+
+   //R, h0 and probability of each template at the current frequency bin. The templates are evaluated in parallel
+   //and then tested against the candidate list in template order, so the candidates do not depend on how the work is shared
+   REAL8Vector *Rvals = NULL, *h0vals = NULL, *probvals = NULL;
+   INT4Vector *proberrcodes = NULL;
+   XLAL_CHECK( (Rvals = XLALCreateREAL8Vector(numtemplates)) != NULL, XLAL_EFUNC );
+   XLAL_CHECK( (h0vals = XLALCreateREAL8Vector(numtemplates)) != NULL, XLAL_EFUNC );
+   XLAL_CHECK( (probvals = XLALCreateREAL8Vector(numtemplates)) != NULL, XLAL_EFUNC );
+   XLAL_CHECK( (proberrcodes = XLALCreateINT4Vector(numtemplates)) != NULL, XLAL_EFUNC );
+
+   //With more than one thread, each template draws from its own random number generator, seeded from the input
+   //generator and the template index, because the input generator cannot be shared between threads
+   const BOOLEAN threaded = (params->numThreads > 1);
+   unsigned long seedbase = 0;
+   if (threaded) seedbase = gsl_rng_get(rng);
 
    FILE *RVALS = NULL;
    if (XLALUserVarWasSet(&params->saveRvalues)) XLAL_CHECK( (RVALS = fopen(params->saveRvalues, "w")) != NULL, XLAL_EIO, "Couldn't open %s for writing", params->saveRvalues );
@@ -1116,19 +1130,59 @@ INT4 testTwoSpectTemplateVector(candidateVector *output, const TwoSpectTemplateV
    UINT4 numfbins = (UINT4)round(params->fspan*params->Tsft);
    for (UINT4 ii=0; ii<numfbins; ii++) {
       REAL8 freq = params->fmin + ii/params->Tsft;
-      for (UINT4 jj=0; jj<templateVec->length; jj++) {
-         if (templateVec->data[jj]->templatedata->data[0] == 0.0) break;
-         
-         XLAL_CHECK( convertTemplateForSpecificFbin(template, templateVec->data[jj], freq, params) == XLAL_SUCCESS, XLAL_EFUNC );
-         
-         REAL8 R = calculateR(ffdata->ffdata, template, aveNoise, aveTFnoisePerFbinRatio);
-         XLAL_CHECK( xlalErrno == 0, XLAL_EFUNC );
-         REAL8 prob = 0.0, h0 = 0.0;
-         if ( R > 0.0 ) {
-            prob = probR(template, aveNoise, aveTFnoisePerFbinRatio, R, params, rng, &proberrcode);
-            XLAL_CHECK( xlalErrno == 0, XLAL_EFUNC );
-            h0 = 2.7426*pow(R/(params->Tsft*params->Tobs),0.25);
+
+      INT4 errnum = XLAL_SUCCESS;
+#pragma omp parallel num_threads(params->numThreads) if(threaded)
+      {
+         INT4 threaderrnum = XLAL_SUCCESS;
+         TwoSpectTemplate *template = NULL;
+         gsl_rng *threadrng = NULL;
+         if ((template = createTwoSpectTemplate(templateLen)) == NULL) threaderrnum = XLAL_EFUNC;
+         if (threaded && (threadrng = gsl_rng_alloc(rng->type)) == NULL) threaderrnum = XLAL_ENOMEM;
+
+#pragma omp for schedule(dynamic,16)
+         for (INT4 jj=0; jj<(INT4)numtemplates; jj++) {
+            if (threaderrnum != XLAL_SUCCESS) continue;
+
+            if (convertTemplateForSpecificFbin(template, templateVec->data[jj], freq, params) != XLAL_SUCCESS) {
+               threaderrnum = XLAL_EFUNC;
+               continue;
+            }
+
+            REAL8 R = calculateR(ffdata->ffdata, template, aveNoise, aveTFnoisePerFbinRatio);
+            if (xlalErrno != 0) {
+               threaderrnum = XLAL_EFUNC;
+               continue;
+            }
+            REAL8 prob = 0.0, h0 = 0.0;
+            INT4 proberrcode = 0;
+            if ( R > 0.0 ) {
+               if (threaded) gsl_rng_set(threadrng, seedbase + (unsigned long)ii*numtemplates + jj);
+               prob = probR(template, aveNoise, aveTFnoisePerFbinRatio, R, params, threaded ? threadrng : rng, &proberrcode);
+               if (xlalErrno != 0) {
+                  threaderrnum = XLAL_EFUNC;
+                  continue;
+               }
+               h0 = 2.7426*pow(R/(params->Tsft*params->Tobs),0.25);
+            }
+
+            Rvals->data[jj] = R;
+            h0vals->data[jj] = h0;
+            probvals->data[jj] = prob;
+            proberrcodes->data[jj] = proberrcode;
+         } /* for jj < numtemplates */
+
+         destroyTwoSpectTemplate(template);
+         if (threadrng != NULL) gsl_rng_free(threadrng);
+         if (threaderrnum != XLAL_SUCCESS) {
+#pragma omp critical(testTwoSpectTemplateVector_errnum)
+            errnum = threaderrnum;
          }
+      }
+      XLAL_CHECK( errnum == XLAL_SUCCESS, errnum );
+
+      for (UINT4 jj=0; jj<numtemplates; jj++) {
+         REAL8 R = Rvals->data[jj], prob = probvals->data[jj];
 
          if (XLALUserVarWasSet(&params->saveRvalues)) fprintf(RVALS, "%g\n", R);
 
@@ -1136,13 +1190,16 @@ INT4 testTwoSpectTemplateVector(candidateVector *output, const TwoSpectTemplateV
             UINT4 insertionPoint = output->length - 1;
             while(insertionPoint>0 && prob<output->data[insertionPoint - 1].prob) insertionPoint--;
             for (INT4 kk=(INT4)output->length-2; kk>=(INT4)insertionPoint; kk--) loadCandidateData(&(output->data[kk+1]), output->data[kk].fsig, output->data[kk].period, output->data[kk].moddepth, output->data[kk].ra, output->data[kk].dec, output->data[kk].stat, output->data[kk].h0, output->data[kk].prob, output->data[kk].proberrcode, output->data[kk].normalization, output->data[kk].templateVectorIndex, output->data[kk].lineContamination);
-            loadCandidateData(&(output->data[insertionPoint]), template->f0, template->period, template->moddepth, skypos.longitude, skypos.latitude, R, h0, prob, proberrcode, ffdata->tfnormalization, jj, 0);
+            loadCandidateData(&(output->data[insertionPoint]), freq + templateVec->data[jj]->f0/params->Tsft, templateVec->data[jj]->period, templateVec->data[jj]->moddepth, skypos.longitude, skypos.latitude, R, h0vals->data[jj], prob, proberrcodes->data[jj], ffdata->tfnormalization, jj, 0);
             if (output->numofcandidates<output->length) output->numofcandidates++;
          }
       }
    }
 
-   destroyTwoSpectTemplate(template);
+   XLALDestroyREAL8Vector(Rvals);
+   XLALDestroyREAL8Vector(h0vals);
+   XLALDestroyREAL8Vector(probvals);
+   XLALDestroyINT4Vector(proberrcodes);
 
    if (XLALUserVarWasSet(&params->saveRvalues)) fclose(RVALS);
 
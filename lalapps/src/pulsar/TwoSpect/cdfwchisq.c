@@ -24,6 +24,7 @@
 
 
 #include <math.h>
+#include <string.h>
 #include <lal/LALConstants.h>
 #include <lal/Sort.h>
 #include <gsl/gsl_sf_log.h>
@@ -31,6 +32,29 @@
 #include "cdfwchisq.h"
 #include "vectormath.h"
 
+//Small cache of cdfwchisq_twospect() results, keyed on the weight set and threshold value.
+//A copy of the weights is kept so that a hash match is always confirmed; weight sets with more than
+//CDFWCHISQ_CACHE_MAX_WEIGHTS elements are not cached. The cache is per-thread so that templates can be
+//evaluated concurrently.
+#define CDFWCHISQ_CACHE_LENGTH 16
+#define CDFWCHISQ_CACHE_MAX_WEIGHTS 500
+typedef struct {
+   UINT8 weightsHash;
+   UINT4 weightsLength;
+   REAL8 weights[CDFWCHISQ_CACHE_MAX_WEIGHTS];
+   INT4 lim;
+   REAL8 c;
+   REAL8 sigma;
+   REAL8 acc;
+   REAL8 qfval;
+   INT4 ifault;
+} cdfwchisqCacheEntry;
+static cdfwchisqCacheEntry cdfwchisqCache[CDFWCHISQ_CACHE_LENGTH];
+static UINT4 cdfwchisqCacheNumEntries = 0, cdfwchisqCacheNextEntry = 0;
+#ifdef _OPENMP
+#pragma omp threadprivate(cdfwchisqCache, cdfwchisqCacheNumEntries, cdfwchisqCacheNextEntry)
+#endif
+
 //Exp function to avoid underflows
 REAL8 exp1(REAL8 x)
 {
@@ -981,3 +1005,63 @@ REAL8 cdfwchisq_twospect(qfvars *vars, REAL8 sigma, REAL8 acc, INT4 *ifault)
 
    return qfval;
 } /* cdfwchisq_twospect() */
+
+
+//FNV-1a hash of the bit patterns of the weights
+static UINT8 hashWeights(const alignedREAL8Vector *weights)
+{
+   UINT8 hash = 14695981039346656037ULL;
+   const unsigned char *bytes = (const unsigned char *)weights->data;
+   for (size_t ii=0; ii<sizeof(REAL8)*weights->length; ii++) {
+      hash ^= bytes[ii];
+      hash *= 1099511628211ULL;
+   }
+   return hash;
+} /* hashWeights() */
+
+
+/**
+ * Compute cdfwchisq_twospect(), reusing the result of an earlier call with an identical set of weights and threshold.
+ * Templates with identical weight sets and threshold are then only integrated once. Only the return value and
+ * error code are cached, so the integration diagnostics in vars are not updated on a cache hit.
+ * \param [in,out] vars   Pointer to qfvars structure
+ * \param [in]     sigma  Coefficient of the normal variable in the sum
+ * \param [in]     acc    Requested accuracy
+ * \param [out]    ifault Pointer to the error code value from the Davies algorithm
+ * 
+eturn Value of the cumulative distribution function at vars->c
+ */
+REAL8 cdfwchisq_twospect_cached(qfvars *vars, REAL8 sigma, REAL8 acc, INT4 *ifault)
+{
+
+   if (vars->weights->length > CDFWCHISQ_CACHE_MAX_WEIGHTS) return cdfwchisq_twospect(vars, sigma, acc, ifault);
+
+   const UINT8 hash = hashWeights(vars->weights);
+   for (UINT4 ii=0; ii<cdfwchisqCacheNumEntries; ii++) {
+      const cdfwchisqCacheEntry *entry = &(cdfwchisqCache[ii]);
+      if (entry->weightsHash==hash && entry->weightsLength==vars->weights->length && entry->lim==vars->lim && entry->c==vars->c && entry->sigma==sigma && entry->acc==acc
+          && memcmp(entry->weights, vars->weights->data, sizeof(REAL8)*vars->weights->length)==0) {
+         *ifault = entry->ifault;
+         return entry->qfval;
+      }
+   }
+
+   REAL8 qfval = cdfwchisq_twospect(vars, sigma, acc, ifault);
+   if (xlalErrno != 0) return qfval;
+
+   cdfwchisqCacheEntry *entry = &(cdfwchisqCache[cdfwchisqCacheNextEntry]);
+   entry->weightsHash = hash;
+   entry->weightsLength = vars->weights->length;
+   memcpy(entry->weights, vars->weights->data, sizeof(REAL8)*vars->weights->length);
+   entry->lim = vars->lim;
+   entry->c = vars->c;
+   entry->sigma = sigma;
+   entry->acc = acc;
+   entry->qfval = qfval;
+   entry->ifault = *ifault;
+   cdfwchisqCacheNextEntry = (cdfwchisqCacheNextEntry + 1) % CDFWCHISQ_CACHE_LENGTH;
+   if (cdfwchisqCacheNumEntries < CDFWCHISQ_CACHE_LENGTH) cdfwchisqCacheNumEntries++;
+
+   return qfval;
+
+} /* cdfwchisq_twospect_cached() */
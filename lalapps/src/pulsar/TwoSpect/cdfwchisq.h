@@ -45,6 +45,7 @@ typedef struct
 
 REAL8 cdfwchisq(qfvars *vars, REAL8 sigma, REAL8 acc, INT4 *ifault);
 REAL8 cdfwchisq_twospect(qfvars *vars, REAL8 sigma, REAL8 acc, INT4 *ifault);
+REAL8 cdfwchisq_twospect_cached(qfvars *vars, REAL8 sigma, REAL8 acc, INT4 *ifault);
 
 void order(qfvars *vars);
 void findu(qfvars *vars, REAL8* utx, REAL8 accx);
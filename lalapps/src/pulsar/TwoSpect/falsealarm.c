@@ -379,7 +379,7 @@ REAL8 probR(const TwoSpectTemplate *template, const REAL4VectorAligned *ffplanen
    sort_double_ascend((REAL8Vector*)newweights);
 
    //cdfwchisq(algorithm variables, sigma, accuracy, error code)
-   prob = 1.0 - cdfwchisq_twospect(&vars, sigma, accuracy, errcode);
+   prob = 1.0 - cdfwchisq_twospect_cached(&vars, sigma, accuracy, errcode);
 
    //Large R values can cause a problem when computing the probability. We run out of accuracy quickly even using double precision
    //Potential fix: compute log10(prob) for smaller values of R, for when slope is linear between log10 probabilities
@@ -400,20 +400,20 @@ REAL8 probR(const TwoSpectTemplate *template, const REAL4VectorAligned *ffplanen
       for (UINT4 ii=0; ii<probvals->length; ii++) {
          c1 = gsl_rng_uniform_pos(rng)*(upperend-lowerend)+lowerend;
          vars.c = c1;
-         tempprob = 1.0-cdfwchisq_twospect(&vars, sigma, accuracy, &errcode1);
+         tempprob = 1.0-cdfwchisq_twospect_cached(&vars, sigma, accuracy, &errcode1);
          while (tempprob<=1.0e-8 || tempprob>=1.0e-6) {
             if (tempprob<=1.0e-8) upperend = c1;
             else if (tempprob>=1.0e-6) lowerend = c1;
             c1 = gsl_rng_uniform_pos(rng)*(upperend-lowerend)+lowerend;
             vars.c = c1;
-            tempprob = 1.0-cdfwchisq_twospect(&vars, sigma, accuracy, &errcode1);
+            tempprob = 1.0-cdfwchisq_twospect_cached(&vars, sigma, accuracy, &errcode1);
 
             INT4 tries = 1;
             while (tries<10 && errcode1 != 0) {
                tries++;
                c1 = gsl_rng_uniform_pos(rng)*(upperend-lowerend)+lowerend;
                vars.c = c1;
-               tempprob = 1.0-cdfwchisq_twospect(&vars, sigma, accuracy, &errcode1);
+               tempprob = 1.0-cdfwchisq_twospect_cached(&vars, sigma, accuracy, &errcode1);
             }
             if (tries>=10 && errcode1!=0) {
                fprintf(stderr,"%s: cdfwchisq_twospect() failed with code %d after making %d tries.\n", __func__, errcode1, tries);
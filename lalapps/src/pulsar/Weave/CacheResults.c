@@ -24,6 +24,10 @@
 
 #include "CacheResults.h"
 
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <lal/LALString.h>
 #include <lal/LALHeap.h>
 #include <lal/LALHashTbl.h>
 #include <lal/LALBitset.h>
@@ -41,10 +45,30 @@ typedef struct {
   REAL4 relevance;
   /// Coherent locator index, used to find items in cache
   UINT8 coh_index;
+  /// Partition and locator index, used to find items in spill file
+  UINT8 spill_index;
+  /// Physical point of the coherent frequency block, used to validate items in spill file
+  PulsarDopplerParams coh_phys;
+  /// Number of points in the coherent frequency block, used to validate items in spill file
+  UINT4 coh_nfreqs;
   /// Results of a coherent computation on a single segment
   WeaveCohResults *coh_res;
 } cache_item;
 
+///
+/// Entry in the index of cache items written to the spill file
+///
+typedef struct {
+  /// Partition and locator index, used to find items in spill file
+  UINT8 spill_index;
+  /// Offset of item in spill file
+  long offset;
+  /// Physical point of the coherent frequency block
+  PulsarDopplerParams coh_phys;
+  /// Number of points in the coherent frequency block
+  UINT4 coh_nfreqs;
+} spill_entry;
+
 ///
 /// Container for a series of cache queries
 ///
@@ -135,6 +159,18 @@ struct tagWeaveCache {
   BOOLEAN all_gc;
   /// Save an no-longer-used cache item for re-use
   cache_item *saved_item;
+  /// File to which items removed from the cache are spilled, if any
+  FILE *spill_file;
+  /// Hash table which looks up items in spill file by index
+  LALHashTbl *spill_index_hash;
+  /// Number of cache queries which found an item in memory
+  UINT8 nhits;
+  /// Number of cache queries which did not find an item in memory or in the spill file
+  UINT8 nmisses;
+  /// Number of items written to the spill file
+  UINT8 nspill_writes;
+  /// Number of cache queries which found an item in the spill file
+  UINT8 nspill_hits;
 };
 
 ///
@@ -148,6 +184,10 @@ static UINT8 cache_item_hash( const void *x );
 static int cache_item_compare_by_coh_index( const void *x, const void *y );
 static int cache_item_compare_by_relevance( const void *x, const void *y );
 static void cache_item_destroy( void *x );
+static UINT8 spill_entry_hash( const void *x );
+static int spill_entry_compare_by_index( const void *x, const void *y );
+static BOOLEAN spill_entry_matches( const spill_entry *entry, const PulsarDopplerParams *coh_phys, const UINT4 coh_nfreqs );
+static int cache_spill_item( WeaveCache *cache, const cache_item *item );
 
 /// @}
 
@@ -209,6 +249,100 @@ UINT8 cache_item_hash(
   return hval;
 }
 
+///
+/// Hash spill file entries by partition and locator index
+///
+UINT8 spill_entry_hash(
+  const void *x
+  )
+{
+  const spill_entry *ix = ( const spill_entry * ) x;
+  UINT4 hval = 0;
+  XLALPearsonHash( &hval, sizeof( hval ), &ix->spill_index, sizeof( ix->spill_index ) );
+  return hval;
+}
+
+///
+/// Compare spill file entries by partition and locator index
+///
+int spill_entry_compare_by_index(
+  const void *x,
+  const void *y
+  )
+{
+  const spill_entry *ix = ( const spill_entry * ) x;
+  const spill_entry *iy = ( const spill_entry * ) y;
+  COMPARE_BY( ix->spill_index, iy->spill_index );   // Compare in ascending order
+  return 0;
+}
+
+///
+/// Check whether a spill file entry stores results for the given coherent frequency block
+///
+BOOLEAN spill_entry_matches(
+  const spill_entry *entry,
+  const PulsarDopplerParams *coh_phys,
+  const UINT4 coh_nfreqs
+  )
+{
+  return entry->coh_nfreqs == coh_nfreqs
+    && XLALGPSCmp( &entry->coh_phys.refTime, &coh_phys->refTime ) == 0
+    && entry->coh_phys.Alpha == coh_phys->Alpha
+    && entry->coh_phys.Delta == coh_phys->Delta
+    && memcmp( entry->coh_phys.fkdot, coh_phys->fkdot, sizeof( coh_phys->fkdot ) ) == 0;
+}
+
+///
+/// Write a cache item which is about to be removed from the cache to the spill file,
+/// unless the spill file already contains the same results
+///
+int cache_spill_item(
+  WeaveCache *cache,
+  const cache_item *item
+  )
+{
+
+  // Return now if there is no spill file
+  if ( cache->spill_file == NULL ) {
+    return XLAL_SUCCESS;
+  }
+
+  // Return now if item results are already in the spill file
+  const spill_entry find_key = { .spill_index = item->spill_index };
+  const spill_entry *find_entry = NULL;
+  XLAL_CHECK( XLALHashTblFind( cache->spill_index_hash, &find_key, ( const void ** ) &find_entry ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( find_entry != NULL && spill_entry_matches( find_entry, &item->coh_phys, item->coh_nfreqs ) ) {
+    return XLAL_SUCCESS;
+  }
+
+  // Append item results to the end of the spill file
+  XLAL_CHECK( fseek( cache->spill_file, 0, SEEK_END ) == 0, XLAL_EIO );
+  const long offset = ftell( cache->spill_file );
+  XLAL_CHECK( offset >= 0, XLAL_EIO );
+  XLAL_CHECK( XLALWeaveCohResultsWrite( cache->spill_file, item->coh_res ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Add an entry to the spill index hash table, reusing any out-of-date entry
+  // - Out-of-date results are not removed from the spill file, but simply become unreachable
+  spill_entry *new_entry = NULL;
+  if ( find_entry != NULL ) {
+    XLAL_CHECK( XLALHashTblExtract( cache->spill_index_hash, &find_key, ( void ** ) &new_entry ) == XLAL_SUCCESS, XLAL_EFUNC );
+  } else {
+    new_entry = XLALCalloc( 1, sizeof( *new_entry ) );
+    XLAL_CHECK( new_entry != NULL, XLAL_ENOMEM );
+  }
+  new_entry->spill_index = item->spill_index;
+  new_entry->offset = offset;
+  new_entry->coh_phys = item->coh_phys;
+  new_entry->coh_nfreqs = item->coh_nfreqs;
+  XLAL_CHECK( XLALHashTblAdd( cache->spill_index_hash, new_entry ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Increment number of items written to the spill file
+  ++cache->nspill_writes;
+
+  return XLAL_SUCCESS;
+
+}
+
 ///
 /// Sample points on surface of coherent bounding box, convert to semicoherent supersky
 /// coordinates, and record maximum value of semicoherent coordinate in dimension 'dim0'
@@ -620,7 +754,8 @@ WeaveCache *XLALWeaveCacheCreate(
   const SuperskyTransformData *semi_rssky_transf,
   WeaveCohInput *coh_input,
   const UINT4 max_size,
-  const BOOLEAN all_gc
+  const BOOLEAN all_gc,
+  const char *spill_dir
   )
 {
 
@@ -756,6 +891,24 @@ WeaveCache *XLALWeaveCacheCreate(
   cache->coh_computed_bitset = XLALBitsetCreate();
   XLAL_CHECK_NULL( cache->coh_computed_bitset != NULL, XLAL_EFUNC );
 
+  // If a spill directory is given, create a file to which items removed from the cache are written,
+  // so that they may be read back instead of recomputed should they be required again
+  // - The file is unlinked immediately, so that it is removed by the operating system once closed
+  // - Items in the spill file are looked up by the same partition and locator index used by
+  //   'coh_computed_bitset'; spill file entries are destroyed when removed from the hash table
+  if ( spill_dir != NULL ) {
+    char *spill_path = XLALStringAppendFmt( NULL, "%s/WeaveCache.XXXXXX", spill_dir );
+    XLAL_CHECK_NULL( spill_path != NULL, XLAL_EFUNC );
+    const int spill_fd = mkstemp( spill_path );
+    XLAL_CHECK_NULL( spill_fd >= 0, XLAL_ESYS, "Could not create cache spill file '%s'", spill_path );
+    XLAL_CHECK_NULL( unlink( spill_path ) == 0, XLAL_ESYS, "Could not unlink cache spill file '%s'", spill_path );
+    cache->spill_file = fdopen( spill_fd, "w+b" );
+    XLAL_CHECK_NULL( cache->spill_file != NULL, XLAL_ESYS, "Could not open cache spill file '%s'", spill_path );
+    XLALFree( spill_path );
+    cache->spill_index_hash = XLALHashTblCreate( XLALFree, spill_entry_hash, spill_entry_compare_by_index );
+    XLAL_CHECK_NULL( cache->spill_index_hash != NULL, XLAL_EFUNC );
+  }
+
   return cache;
 
 }
@@ -773,6 +926,10 @@ void XLALWeaveCacheDestroy(
     XLALHashTblDestroy( cache->coh_index_hash );
     cache_item_destroy( cache->saved_item );
     XLALBitsetDestroy( cache->coh_computed_bitset );
+    if ( cache->spill_file != NULL ) {
+      fclose( cache->spill_file );
+    }
+    XLALHashTblDestroy( cache->spill_index_hash );
     XLALFree( cache );
   }
 }
@@ -801,6 +958,21 @@ int XLALWeaveCacheWriteInfo(
     XLAL_CHECK_MAIN( XLALFITSHeaderWriteUINT4( file, "cachemax", heap_max_size, "maximum size obtained by cache" ) == XLAL_SUCCESS, XLAL_EFUNC );
   }
 
+  // Write total number of cache hits, misses, and spill file writes and hits
+  {
+    UINT8 nhits = 0, nmisses = 0, nspill_writes = 0, nspill_hits = 0;
+    for ( size_t i = 0; i < ncache; ++i ) {
+      nhits += cache[i]->nhits;
+      nmisses += cache[i]->nmisses;
+      nspill_writes += cache[i]->nspill_writes;
+      nspill_hits += cache[i]->nspill_hits;
+    }
+    XLAL_CHECK_MAIN( XLALFITSHeaderWriteUINT8( file, "cachehit", nhits, "number of cache hits in memory" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALFITSHeaderWriteUINT8( file, "cachemis", nmisses, "number of cache misses" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALFITSHeaderWriteUINT8( file, "cachespw", nspill_writes, "number of cache items spilled to disk" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALFITSHeaderWriteUINT8( file, "cachesph", nspill_hits, "number of cache hits on disk" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
   return XLAL_SUCCESS;
 
 }
@@ -849,6 +1021,8 @@ int XLALWeaveCacheClear(
 ///
 /// Retrieve coherent results for a given query, or compute new coherent results if not found
 ///
+/// Different caches may be retrieved from concurrently, provided that 'tim' is NULL.
+///
 int XLALWeaveCacheRetrieve(
   WeaveCache *cache,
   const WeaveCacheQueries *queries,
@@ -866,13 +1040,17 @@ int XLALWeaveCacheRetrieve(
   XLAL_CHECK( query_index < queries->nqueries, XLAL_EINVAL );
   XLAL_CHECK( coh_res != NULL, XLAL_EFAULT );
   XLAL_CHECK( coh_offset != NULL, XLAL_EFAULT );
-  XLAL_CHECK( tim != NULL, XLAL_EFAULT );
 
   // See if coherent results are already cached
   const cache_item find_key = { .generation = cache->generation, .coh_index = queries->coh_index[query_index] };
   const cache_item *find_item = NULL;
   XLAL_CHECK( XLALHashTblFind( cache->coh_index_hash, &find_key, ( const void ** ) &find_item ) == XLAL_SUCCESS, XLAL_EFUNC );
-  if ( find_item == NULL ) {
+  if ( find_item != NULL ) {
+
+    // Increment number of cache hits in memory
+    ++cache->nhits;
+
+  } else {
 
     // Reuse 'saved_item' if possible, otherwise allocate memory for a new cache item
     if ( cache->saved_item == NULL ) {
@@ -886,14 +1064,49 @@ int XLALWeaveCacheRetrieve(
     new_item->generation = find_key.generation;
     new_item->coh_index = find_key.coh_index;
 
+    // Set the partition and locator index of the new cache item, used by the spill file and 'coh_computed_bitset'
+    new_item->spill_index = queries->freq_partition_index * cache->coh_max_index + find_key.coh_index;
+
     // Set the relevance of the coherent frequency block associated with the new cache item
     new_item->relevance = queries->coh_relevance[query_index];
 
     // Determine the number of points in the coherent frequency block
     const UINT4 coh_nfreqs = queries->coh_right[query_index] - queries->coh_left[query_index] + 1;
 
-    // Compute coherent results for the new cache item
-    XLAL_CHECK( XLALWeaveCohResultsCompute( &new_item->coh_res, cache->coh_input, &queries->coh_phys[query_index], coh_nfreqs, tim ) == XLAL_SUCCESS, XLAL_EFUNC );
+    // Record the coherent frequency block associated with the new cache item
+    new_item->coh_phys = queries->coh_phys[query_index];
+    new_item->coh_nfreqs = coh_nfreqs;
+
+    // See if coherent results for the new cache item can be read back from the spill file
+    const spill_entry *spill_find_entry = NULL;
+    if ( cache->spill_file != NULL ) {
+      const spill_entry spill_find_key = { .spill_index = new_item->spill_index };
+      XLAL_CHECK( XLALHashTblFind( cache->spill_index_hash, &spill_find_key, ( const void ** ) &spill_find_entry ) == XLAL_SUCCESS, XLAL_EFUNC );
+      if ( spill_find_entry != NULL && !spill_entry_matches( spill_find_entry, &queries->coh_phys[query_index], coh_nfreqs ) ) {
+        spill_find_entry = NULL;
+      }
+    }
+    if ( spill_find_entry != NULL ) {
+
+      // Read coherent results for the new cache item from the spill file
+      XLAL_CHECK( fseek( cache->spill_file, spill_find_entry->offset, SEEK_SET ) == 0, XLAL_EIO );
+      XLAL_CHECK( XLALWeaveCohResultsRead( cache->spill_file, &new_item->coh_res ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // Increment number of cache hits in the spill file
+      ++cache->nspill_hits;
+
+    } else {
+
+      // Compute coherent results for the new cache item
+      XLAL_CHECK( XLALWeaveCohResultsCompute( &new_item->coh_res, cache->coh_input, &queries->coh_phys[query_index], coh_nfreqs, tim ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // Increment number of computed coherent results
+      queries->coh_nres[query_index] += coh_nfreqs;
+
+      // Increment number of cache misses
+      ++cache->nmisses;
+
+    }
 
     // Add new cache item to the index hash table
     XLAL_CHECK( XLALHashTblAdd( cache->coh_index_hash, new_item ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -908,7 +1121,8 @@ int XLALWeaveCacheRetrieve(
     // If garbage collection is enabled, and item's relevance has fallen below the threshold relevance, it can be removed from the cache
     if ( cache->any_gc && least_relevant_item != NULL && least_relevant_item != new_item && cache_item_compare_by_relevance( least_relevant_item, &relevance_threshold ) < 0 ) {
 
-      // Remove least relevant item from index hash table
+      // Write least relevant item to the spill file, and remove it from index hash table
+      XLAL_CHECK( cache_spill_item( cache, least_relevant_item ) == XLAL_SUCCESS, XLAL_EFUNC );
       XLAL_CHECK( XLALHashTblRemove( cache->coh_index_hash, least_relevant_item ) == XLAL_SUCCESS, XLAL_EFUNC );
 
       // Exchange 'saved_item' with the least relevant item in the relevance heap
@@ -924,7 +1138,8 @@ int XLALWeaveCacheRetrieve(
         // If item's relevance has fallen below the threshold relevance, it can be removed from the cache
         if ( least_relevant_item != NULL && least_relevant_item != new_item && cache_item_compare_by_relevance( least_relevant_item, &relevance_threshold ) < 0 ) {
 
-          // Remove least relevant item from index hash table
+          // Write least relevant item to the spill file, and remove it from index hash table
+          XLAL_CHECK( cache_spill_item( cache, least_relevant_item ) == XLAL_SUCCESS, XLAL_EFUNC );
           XLAL_CHECK( XLALHashTblRemove( cache->coh_index_hash, least_relevant_item ) == XLAL_SUCCESS, XLAL_EFUNC );
 
           // Remove and destroy least relevant item from the relevance heap
@@ -944,8 +1159,9 @@ int XLALWeaveCacheRetrieve(
       // Add new cache item to the relevance heap; 'saved_item' many now contains an item removed from the heap
       XLAL_CHECK( XLALHeapAdd( cache->relevance_heap, ( void ** ) &cache->saved_item ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-      // If 'saved_item' contains an item removed from the heap, also remove it from the index hash table
+      // If 'saved_item' contains an item removed from the heap, write it to the spill file, and also remove it from the index hash table
       if ( cache->saved_item != NULL ) {
+        XLAL_CHECK( cache_spill_item( cache, cache->saved_item ) == XLAL_SUCCESS, XLAL_EFUNC );
         XLAL_CHECK( XLALHashTblRemove( cache->coh_index_hash, cache->saved_item ) == XLAL_SUCCESS, XLAL_EFUNC );
       }
 
@@ -957,11 +1173,8 @@ int XLALWeaveCacheRetrieve(
       cache->heap_max_size = heap_size;
     }
 
-    // Increment number of computed coherent results
-    queries->coh_nres[query_index] += coh_nfreqs;
-
     // Check if coherent results have been computed previously
-    const UINT8 coh_bitset_index = queries->freq_partition_index * cache->coh_max_index + find_key.coh_index;
+    const UINT8 coh_bitset_index = new_item->spill_index;
     BOOLEAN computed = 0;
     XLAL_CHECK( XLALBitsetGet( cache->coh_computed_bitset, coh_bitset_index, &computed ) == XLAL_SUCCESS, XLAL_EFUNC );
     if ( !computed ) {
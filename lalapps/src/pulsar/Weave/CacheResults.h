@@ -78,7 +78,8 @@ WeaveCache *XLALWeaveCacheCreate(
   const SuperskyTransformData *semi_rssky_transf,
   WeaveCohInput *coh_input,
   const UINT4 max_size,
-  const BOOLEAN all_gc
+  const BOOLEAN all_gc,
+  const char *spill_dir
   );
 void XLALWeaveCacheDestroy(
   WeaveCache *cache
@@ -74,6 +74,8 @@ struct tagWeaveCohInput {
   size_t Fstat_res_idx[PULSAR_MAX_DETECTORS];
   /// Whether F-statistic timing info is being collected
   BOOLEAN Fstat_collect_timing;
+  /// NUMA placement of coherent results arrays, as for F-statistic buffers
+  LALMemoryPlacement mem_placement;
 };
 
 ///
@@ -97,6 +99,7 @@ struct tagWeaveCohResults {
 
 static int semi_res_sum_2F( UINT4 *nsum, REAL4 *sum2F, const REAL4 *coh2F, const UINT4 nfreqs );
 static int semi_res_max_2F( UINT4 *nmax, REAL4 *max2F, const REAL4 *coh2F, const UINT4 nfreqs );
+static int semi_res_sum_max_2F( UINT4 *nsum, REAL4 *sum2F, UINT4 *nmax, REAL4 *max2F, const REAL4 *coh2F, const UINT4 nfreqs );
 
 /// @}
 
@@ -141,6 +144,7 @@ WeaveCohInput *XLALWeaveCohInputCreate(
   coh_input->simulation_level = simulation_level;
   coh_input->seg_info_have_sft_info = ( sft_catalog != NULL );
   coh_input->Fstat_collect_timing = Fstat_opt_args->collectTiming;
+  coh_input->mem_placement = Fstat_opt_args->resampMemPlacement;
 
   // Record information from segment
   coh_input->seg_info.segment_start = segment->start;
@@ -444,6 +448,7 @@ int XLALWeaveCohResultsCompute(
   if ( ( *coh_res )->coh2F == NULL || ( *coh_res )->coh2F->length < ( *coh_res )->nfreqs ) {
     ( *coh_res )->coh2F = XLALResizeREAL4Vector( ( *coh_res )->coh2F, ( *coh_res )->nfreqs );
     XLAL_CHECK( ( *coh_res )->coh2F != NULL, XLAL_ENOMEM );
+    XLAL_CHECK( XLALSetMemoryPlacement( ( *coh_res )->coh2F->data, ( *coh_res )->nfreqs * sizeof( ( *coh_res )->coh2F->data[0] ), coh_input->mem_placement ) == XLAL_SUCCESS, XLAL_EFUNC );
   }
   if ( coh_input->Fstat_what_to_compute & FSTATQ_2F_PER_DET ) {
     for ( size_t i = 0; i < coh_input->Fstat_ndetectors; ++i ) {
@@ -451,6 +456,7 @@ int XLALWeaveCohResultsCompute(
       if ( ( *coh_res )->coh2F_det[idx] == NULL || ( *coh_res )->coh2F_det[idx]->length < ( *coh_res )->nfreqs ) {
         ( *coh_res )->coh2F_det[idx] = XLALResizeREAL4Vector( ( *coh_res )->coh2F_det[idx], ( *coh_res )->nfreqs );
         XLAL_CHECK( ( *coh_res )->coh2F_det[idx] != NULL, XLAL_ENOMEM );
+        XLAL_CHECK( XLALSetMemoryPlacement( ( *coh_res )->coh2F_det[idx]->data, ( *coh_res )->nfreqs * sizeof( ( *coh_res )->coh2F_det[idx]->data[0] ), coh_input->mem_placement ) == XLAL_SUCCESS, XLAL_EFUNC );
       }
     }
   }
@@ -502,6 +508,98 @@ int XLALWeaveCohResultsCompute(
 
 }
 
+///
+/// Write coherent results to a binary file, e.g.\ for later retrieval by XLALWeaveCohResultsRead()
+///
+int XLALWeaveCohResultsWrite(
+  FILE *file,
+  const WeaveCohResults *coh_res
+  )
+{
+
+  // Check input
+  XLAL_CHECK( file != NULL, XLAL_EFAULT );
+  XLAL_CHECK( coh_res != NULL, XLAL_EFAULT );
+
+  // Record which vectors of F-statistics are present
+  // - Vectors are absent when simulating search with minimal memory allocation
+  UINT4 vec_mask = 0;
+  if ( coh_res->coh2F != NULL ) {
+    vec_mask |= 1;
+  }
+  for ( size_t i = 0; i < PULSAR_MAX_DETECTORS; ++i ) {
+    if ( coh_res->coh2F_det[i] != NULL ) {
+      vec_mask |= 2 << i;
+    }
+  }
+
+  // Write header
+  XLAL_CHECK( fwrite( &coh_res->coh_phys, sizeof( coh_res->coh_phys ), 1, file ) == 1, XLAL_EIO );
+  XLAL_CHECK( fwrite( &coh_res->nfreqs, sizeof( coh_res->nfreqs ), 1, file ) == 1, XLAL_EIO );
+  XLAL_CHECK( fwrite( &vec_mask, sizeof( vec_mask ), 1, file ) == 1, XLAL_EIO );
+
+  // Write 'nfreqs' elements of multi- and per-detector F-statistics
+  if ( coh_res->coh2F != NULL ) {
+    XLAL_CHECK( fwrite( coh_res->coh2F->data, sizeof( coh_res->coh2F->data[0] ), coh_res->nfreqs, file ) == coh_res->nfreqs, XLAL_EIO );
+  }
+  for ( size_t i = 0; i < PULSAR_MAX_DETECTORS; ++i ) {
+    if ( coh_res->coh2F_det[i] != NULL ) {
+      XLAL_CHECK( fwrite( coh_res->coh2F_det[i]->data, sizeof( coh_res->coh2F_det[i]->data[0] ), coh_res->nfreqs, file ) == coh_res->nfreqs, XLAL_EIO );
+    }
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+///
+/// Create and read coherent results from a binary file written by XLALWeaveCohResultsWrite()
+///
+int XLALWeaveCohResultsRead(
+  FILE *file,
+  WeaveCohResults **coh_res
+  )
+{
+
+  // Check input
+  XLAL_CHECK( file != NULL, XLAL_EFAULT );
+  XLAL_CHECK( coh_res != NULL, XLAL_EFAULT );
+
+  // Allocate results struct if required
+  if ( *coh_res == NULL ) {
+    *coh_res = XLALCalloc( 1, sizeof( **coh_res ) );
+    XLAL_CHECK( *coh_res != NULL, XLAL_ENOMEM );
+  }
+
+  // Read header
+  UINT4 vec_mask = 0;
+  XLAL_CHECK( fread( &( *coh_res )->coh_phys, sizeof( ( *coh_res )->coh_phys ), 1, file ) == 1, XLAL_EIO );
+  XLAL_CHECK( fread( &( *coh_res )->nfreqs, sizeof( ( *coh_res )->nfreqs ), 1, file ) == 1, XLAL_EIO );
+  XLAL_CHECK( fread( &vec_mask, sizeof( vec_mask ), 1, file ) == 1, XLAL_EIO );
+  XLAL_CHECK( ( *coh_res )->nfreqs > 0, XLAL_EIO );
+
+  // Reallocate and read vectors of multi- and per-detector F-statistics per frequency
+  if ( vec_mask & 1 ) {
+    if ( ( *coh_res )->coh2F == NULL || ( *coh_res )->coh2F->length < ( *coh_res )->nfreqs ) {
+      ( *coh_res )->coh2F = XLALResizeREAL4Vector( ( *coh_res )->coh2F, ( *coh_res )->nfreqs );
+      XLAL_CHECK( ( *coh_res )->coh2F != NULL, XLAL_ENOMEM );
+    }
+    XLAL_CHECK( fread( ( *coh_res )->coh2F->data, sizeof( ( *coh_res )->coh2F->data[0] ), ( *coh_res )->nfreqs, file ) == ( *coh_res )->nfreqs, XLAL_EIO );
+  }
+  for ( size_t i = 0; i < PULSAR_MAX_DETECTORS; ++i ) {
+    if ( vec_mask & ( 2 << i ) ) {
+      if ( ( *coh_res )->coh2F_det[i] == NULL || ( *coh_res )->coh2F_det[i]->length < ( *coh_res )->nfreqs ) {
+        ( *coh_res )->coh2F_det[i] = XLALResizeREAL4Vector( ( *coh_res )->coh2F_det[i], ( *coh_res )->nfreqs );
+        XLAL_CHECK( ( *coh_res )->coh2F_det[i] != NULL, XLAL_ENOMEM );
+      }
+      XLAL_CHECK( fread( ( *coh_res )->coh2F_det[i]->data, sizeof( ( *coh_res )->coh2F_det[i]->data[0] ), ( *coh_res )->nfreqs, file ) == ( *coh_res )->nfreqs, XLAL_EIO );
+    }
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
 ///
 /// Destroy coherent results
 ///
@@ -719,6 +817,30 @@ static int semi_res_max_2F(
   return XLALVectorMaxREAL4( max2F, max2F, coh2F, nfreqs );
 }
 
+///
+/// Add F-statistic array 'coh2F' to summed array 'sum2F' and track maximum with 'max2F' in a single pass,
+/// keeping track of the number of summations 'nsum' and maximum-comparisons 'nmax'
+///
+static int semi_res_sum_max_2F(
+  UINT4 *nsum,
+  REAL4 *sum2F,
+  UINT4 *nmax,
+  REAL4 *max2F,
+  const REAL4 *coh2F,
+  const UINT4 nfreqs
+  )
+{
+  if ( *nsum == 0 || *nmax == 0 ) {
+    // If this is the first summation or max-comparison, just use memcpy()
+    XLAL_CHECK( semi_res_sum_2F( nsum, sum2F, coh2F, nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( semi_res_max_2F( nmax, max2F, coh2F, nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
+    return XLAL_SUCCESS;
+  }
+  ++( *nsum );
+  ++( *nmax );
+  return XLALVectorAddMaxREAL4( sum2F, max2F, sum2F, max2F, coh2F, nfreqs );
+}
+
 ///
 /// Add a new set of coherent results to the semicoherent results
 ///
@@ -771,11 +893,18 @@ int XLALWeaveSemiResultsAdd(
     }
   }
 
+  // If both maximum and sum of F-statistics are needed, compute them in a single pass; the
+  // combined time is attributed to the maximum statistics
+  const BOOLEAN fuse_sum_max_2F = ( mainloop_stats & WEAVE_STATISTIC_MAX2F ) && ( mainloop_stats & WEAVE_STATISTIC_SUM2F );
+  const BOOLEAN fuse_sum_max_2F_det = ( mainloop_stats & WEAVE_STATISTIC_MAX2F_DET ) && ( mainloop_stats & WEAVE_STATISTIC_SUM2F_DET );
+
   // Start timing of semicoherent results
   XLAL_CHECK( XLALWeaveSearchTimingStatistic( tim, WEAVE_STATISTIC_NONE, WEAVE_STATISTIC_MAX2F ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   // Add to max-over-segments multi-detector F-statistics per frequency
-  if ( mainloop_stats & WEAVE_STATISTIC_MAX2F ) {
+  if ( fuse_sum_max_2F ) {
+    XLAL_CHECK( semi_res_sum_max_2F( &semi_res->nsum2F, semi_res->sum2F->data, &semi_res->nmax2F, semi_res->max2F->data, coh_res->coh2F->data + coh_offset, semi_res->nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
+  } else if ( mainloop_stats & WEAVE_STATISTIC_MAX2F ) {
     XLAL_CHECK( semi_res_max_2F( &semi_res->nmax2F, semi_res->max2F->data, coh_res->coh2F->data + coh_offset, semi_res->nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
   }
 
@@ -785,7 +914,12 @@ int XLALWeaveSemiResultsAdd(
   // Add to max-over-segments per-detector F-statistics per frequency
   if ( mainloop_stats & WEAVE_STATISTIC_MAX2F_DET ) {
     for ( size_t i = 0; i < semi_res->ndetectors; ++i ) {
-      if ( coh_res->coh2F_det[i] != NULL ) {
+      if ( coh_res->coh2F_det[i] == NULL ) {
+        continue;
+      }
+      if ( fuse_sum_max_2F_det ) {
+        XLAL_CHECK( semi_res_sum_max_2F( &semi_res->nsum2F_det[i], semi_res->sum2F_det[i]->data, &semi_res->nmax2F_det[i], semi_res->max2F_det[i]->data, coh_res->coh2F_det[i]->data + coh_offset, semi_res->nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
+      } else {
         XLAL_CHECK( semi_res_max_2F( &semi_res->nmax2F_det[i], semi_res->max2F_det[i]->data, coh_res->coh2F_det[i]->data + coh_offset, semi_res->nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
       }
     }
@@ -795,7 +929,9 @@ int XLALWeaveSemiResultsAdd(
   XLAL_CHECK( XLALWeaveSearchTimingStatistic( tim, WEAVE_STATISTIC_MAX2F_DET, WEAVE_STATISTIC_SUM2F ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   // Add to summed multi-detector F-statistics per frequency, and increment number of additions thus far
-  if ( mainloop_stats & WEAVE_STATISTIC_SUM2F ) {
+  if ( fuse_sum_max_2F ) {
+    // Already summed above
+  } else if ( mainloop_stats & WEAVE_STATISTIC_SUM2F ) {
     XLAL_CHECK( semi_res_sum_2F( &semi_res->nsum2F, semi_res->sum2F->data, coh_res->coh2F->data + coh_offset, semi_res->nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
   } else {
     semi_res->nsum2F ++;             // Even if not summing here: count number of 2F summands for (potential) completion-loop usage
@@ -807,7 +943,9 @@ int XLALWeaveSemiResultsAdd(
   // Add to summed per-detector F-statistics per frequency, and increment number of additions thus far
   for ( size_t i = 0; i < semi_res->ndetectors; ++i ) {
     if ( coh_res->coh2F_det[i] != NULL ) {
-      if ( mainloop_stats & WEAVE_STATISTIC_SUM2F_DET ) {
+      if ( fuse_sum_max_2F_det ) {
+        // Already summed above
+      } else if ( mainloop_stats & WEAVE_STATISTIC_SUM2F_DET ) {
         XLAL_CHECK( semi_res_sum_2F( &semi_res->nsum2F_det[i], semi_res->sum2F_det[i]->data, coh_res->coh2F_det[i]->data + coh_offset, semi_res->nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
       } else {
         semi_res->nsum2F_det[i] ++;  // Even if not summing here: count number of per-detector 2F summands for (potential) completion-loop usage
@@ -129,6 +129,14 @@ int XLALWeaveCohResultsCompute(
   const UINT4 coh_nfreqs,
   WeaveSearchTiming *tim
   );
+int XLALWeaveCohResultsWrite(
+  FILE *file,
+  const WeaveCohResults *coh_res
+  );
+int XLALWeaveCohResultsRead(
+  FILE *file,
+  WeaveCohResults **coh_res
+  );
 void XLALWeaveCohResultsDestroy(
   WeaveCohResults *coh_res
   );
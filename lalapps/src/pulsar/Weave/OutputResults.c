@@ -247,6 +247,29 @@ void XLALWeaveOutputResultsDestroy(
   }
 }
 
+///
+/// Keep at most 'run_limit' items of each toplist in memory, and write further items to runs in 'run_dir'
+///
+int XLALWeaveOutputResultsSetToplistRuns(
+  WeaveOutputResults *out,
+  const char *run_dir,
+  const UINT4 run_limit
+  )
+{
+
+  // Check input
+  XLAL_CHECK( out != NULL, XLAL_EFAULT );
+  XLAL_CHECK( run_dir != NULL, XLAL_EFAULT );
+
+  // Set runs of all toplists
+  for ( size_t i = 0; i < out->ntoplists; ++i ) {
+    XLAL_CHECK( XLALWeaveResultsToplistSetRuns( out->toplists[i], run_dir, run_limit ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
 ///
 /// Add semicoherent results to output
 ///
@@ -47,6 +47,11 @@ WeaveOutputResults *XLALWeaveOutputResultsCreate(
 void XLALWeaveOutputResultsDestroy(
   WeaveOutputResults *out
   );
+int XLALWeaveOutputResultsSetToplistRuns(
+  WeaveOutputResults *out,
+  const char *run_dir,
+  const UINT4 run_limit
+  );
 int XLALWeaveOutputResultsAdd(
   WeaveOutputResults *out,
   const WeaveSemiResults *semi_res,
@@ -25,12 +25,19 @@
 #include "ResultsToplist.h"
 #include "ComputeResults.h"
 
+#include <stdlib.h>
+#include <unistd.h>
+
 #include <lal/VectorMath.h>
 #include <lal/UserInputPrint.h>
+#include <lal/LALString.h>
 
 // Compare two quantities, and return a sort order value if they are unequal
 #define COMPARE_BY( x, y ) do { if ( (x) < (y) ) return -1; if ( (x) > (y) ) return +1; } while(0)
 
+// Maximum number of sorted runs of toplist items on disk before they are merged
+#define MAX_TOPLIST_RUNS 8
+
 ///
 /// Toplist of output results
 ///
@@ -58,6 +65,20 @@ struct tagWeaveResultsToplist {
   LALHeap *heap;
   /// Save a no-longer-used toplist item for re-use
   WeaveResultsToplistItem *saved_item;
+  /// Maximum number of items in the toplist
+  UINT4 toplist_limit;
+  /// Directory in which to write sorted runs of toplist items, if not all items are kept in memory
+  char *run_dir;
+  /// Files containing sorted runs of toplist items, each ranked in descending order
+  LALStringVector *run_files;
+  /// Files containing runs which have since been merged, but which may still be referenced by a checkpoint
+  LALStringVector *obsolete_run_files;
+  /// Files containing runs which are referenced by the last checkpoint written
+  LALStringVector *ckpt_run_files;
+  /// Ranking statistic below which results cannot enter the toplist, as determined by merging runs
+  REAL4 run_rank_threshold;
+  /// Whether the completion loop has been performed
+  BOOLEAN completed;
 };
 
 ///
@@ -68,12 +89,17 @@ struct tagWeaveResultsToplist {
 static WeaveResultsToplistItem *toplist_item_create( const WeaveResultsToplist *toplist );
 static int compare_templates( BOOLEAN *equal, const char *loc_str, const char *tmpl_str, const REAL8 param_tol_mism, const gsl_matrix *metric, const SuperskyTransformData *rssky_transf, const UINT8 index_1, const UINT8 index_2, const PulsarDopplerParams *phys_1, const PulsarDopplerParams *phys_2 );
 static int compare_vectors( BOOLEAN *equal, const VectorComparison *result_tol, const REAL4Vector *res_1, const REAL4Vector *res_2 );
-static int toplist_fits_table_init( FITSFile *file, const WeaveResultsToplist *toplist );
-static int toplist_fits_table_write_visitor( void *param, const void *x );
+static int toplist_fits_table_init( FITSFile *file, const WeaveResultsToplist *toplist, const BOOLEAN run );
 static int toplist_item_sort_by_semi_phys( const void *x, const void *y );
 static void toplist_item_destroy( WeaveResultsToplistItem *item );
 static int toplist_item_compare( void *param, const void *x, const void *y );
 static int toplist_fill_completionloop_stats( void *param, void *x );
+static FITSFile *toplist_run_file_open_write( const WeaveResultsToplist *toplist, char **run_file );
+static int toplist_runs_flush( WeaveResultsToplist *toplist );
+static int toplist_runs_merge( WeaveResultsToplist *toplist, FITSFile *file, const BOOLEAN fill_completionloop_stats, UINT8 *nrows, REAL4 *last_rank_stat );
+static int toplist_runs_compact( WeaveResultsToplist *toplist, const BOOLEAN fill_completionloop_stats );
+static int toplist_runs_obsolete( WeaveResultsToplist *toplist );
+static int toplist_runs_delete_unreferenced( WeaveResultsToplist *toplist );
 
 /// @}
 
@@ -174,11 +200,13 @@ int toplist_item_compare(
 }
 
 ///
-/// Initialise a FITS table for writing/reading a toplist
+/// Initialise a FITS table for writing/reading a toplist; if 'run' is true, the table also
+/// includes all main-loop statistics needed to compute the completion-loop statistics
 ///
 int toplist_fits_table_init(
   FITSFile *file,
-  const WeaveResultsToplist *toplist
+  const WeaveResultsToplist *toplist,
+  const BOOLEAN run
   )
 {
 
@@ -209,6 +237,9 @@ int toplist_fits_table_init(
   for ( UINT4 istage = 0; istage < 2; istage ++ ) {
     // Which statistics have been requested for output at this stage ('stage0' vs 'recalc')?
     WeaveStatisticType statistics_to_output = params->statistics_to_output[istage];
+    if ( run && istage == 0 ) {
+      statistics_to_output |= params->mainloop_statistics_to_keep;
+    }
 
     // Add column for mean multi-detector F-statistic
     if ( statistics_to_output & WEAVE_STATISTIC_MEAN2F ) {
@@ -290,7 +321,7 @@ int toplist_fits_table_init(
 
     if ( istage == 0 ) { // Only output these for 'stage 0'
       // We tie the output of per-segment coordinates to the output of any per-segment statistics
-      WeaveStatisticType per_segment_stats = ( statistics_to_output & ( WEAVE_STATISTIC_COH2F | WEAVE_STATISTIC_COH2F_DET ) );
+      WeaveStatisticType per_segment_stats = ( params->statistics_to_output[istage] & ( WEAVE_STATISTIC_COH2F | WEAVE_STATISTIC_COH2F_DET ) );
       // Add columns for coherent template parameters
       if ( per_segment_stats ) {
         if ( toplist->toplist_tmpl_idx ) {
@@ -457,19 +488,6 @@ int toplist_fill_completionloop_stats(
 
 }
 
-///
-/// Visitor function for writing a toplist to a FITS table
-///
-int toplist_fits_table_write_visitor(
-  void *param,
-  const void *x
-  )
-{
-  FITSFile *file = ( FITSFile * ) param;
-  XLAL_CHECK( XLALFITSTableWriteRow( file, x ) == XLAL_SUCCESS, XLAL_EFUNC );
-  return XLAL_SUCCESS;
-}
-
 ///
 /// Sort toplist items by physical coordinates of semicoherent template.
 ///
@@ -601,6 +619,296 @@ int compare_vectors(
   return XLAL_SUCCESS;
 }
 
+///
+/// Create a new file for a run of toplist items, and open a FITS table for writing to it
+///
+FITSFile *toplist_run_file_open_write(
+  const WeaveResultsToplist *toplist,
+  char **run_file
+  )
+{
+
+  // Check input
+  XLAL_CHECK_NULL( toplist != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL( toplist->run_dir != NULL, XLAL_EINVAL );
+  XLAL_CHECK_NULL( run_file != NULL && *run_file == NULL, XLAL_EFAULT );
+
+  // Create a uniquely-named file in the run directory
+  *run_file = XLALStringAppendFmt( NULL, "%s/Weave_%s_toplist.XXXXXX", toplist->run_dir, toplist->stat_name );
+  XLAL_CHECK_NULL( *run_file != NULL, XLAL_EFUNC );
+  const int run_fd = mkstemp( *run_file );
+  XLAL_CHECK_NULL( run_fd >= 0, XLAL_ESYS, "Could not create toplist run file '%s'", *run_file );
+  close( run_fd );
+
+  // Open FITS table for writing and initialise
+  FITSFile *file = XLALFITSFileOpenWrite( *run_file );
+  XLAL_CHECK_NULL( file != NULL, XLAL_EFUNC );
+  XLAL_CHECK_NULL( XLALFITSTableOpenWrite( file, "toplist_run", "sorted run of toplist items" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_NULL( toplist_fits_table_init( file, toplist, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return file;
+
+}
+
+///
+/// Write all toplist items held in memory to a new run, sorted in descending order of ranking
+/// statistic, and remove them from memory
+///
+int toplist_runs_flush(
+  WeaveResultsToplist *toplist
+  )
+{
+
+  // Check input
+  XLAL_CHECK( toplist != NULL, XLAL_EFAULT );
+  XLAL_CHECK( toplist->run_dir != NULL, XLAL_EINVAL );
+
+  // Return now if there are no toplist items in memory
+  const int n = XLALHeapSize( toplist->heap );
+  XLAL_CHECK( n >= 0, XLAL_EFUNC );
+  if ( n == 0 ) {
+    return XLAL_SUCCESS;
+  }
+
+  // Extract all toplist items from heap; since the root of the heap is
+  // the lowest-ranked item, items are extracted in ascending order, and
+  // are stored from the end of the array to sort them in descending order
+  WeaveResultsToplistItem **items = XLALCalloc( n, sizeof( *items ) );
+  XLAL_CHECK( items != NULL, XLAL_ENOMEM );
+  for ( int i = n - 1; i >= 0; --i ) {
+    items[i] = XLALHeapExtractRoot( toplist->heap );
+    XLAL_CHECK( items[i] != NULL, XLAL_EFUNC );
+  }
+
+  // Write toplist items to a new run in descending order
+  char *run_file = NULL;
+  FITSFile *file = toplist_run_file_open_write( toplist, &run_file );
+  XLAL_CHECK( file != NULL, XLAL_EFUNC );
+  XLAL_CHECK( XLALFITSTableWriteRows( file, ( const void *const * ) items, n ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLALFITSFileClose( file );
+
+  // Add new run to list of runs
+  toplist->run_files = XLALAppendString2Vector( toplist->run_files, run_file );
+  XLAL_CHECK( toplist->run_files != NULL, XLAL_EFUNC );
+  XLALFree( run_file );
+
+  // Save one toplist item for re-use, and destroy the rest
+  for ( int i = 0; i < n; ++i ) {
+    if ( toplist->saved_item == NULL ) {
+      toplist->saved_item = items[i];
+    } else {
+      toplist_item_destroy( items[i] );
+    }
+  }
+  XLALFree( items );
+
+  // Merge runs if too many have accumulated
+  if ( toplist->run_files->length >= MAX_TOPLIST_RUNS ) {
+    XLAL_CHECK( toplist_runs_compact( toplist, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+///
+/// Merge all runs of toplist items, and write the highest-ranked toplist items (up to the maximum size
+/// of the toplist) to an open FITS table, in descending order of ranking statistic
+///
+int toplist_runs_merge(
+  WeaveResultsToplist *toplist,
+  FITSFile *file,
+  const BOOLEAN fill_completionloop_stats,
+  UINT8 *nrows,
+  REAL4 *last_rank_stat
+  )
+{
+
+  // Check input
+  XLAL_CHECK( toplist != NULL, XLAL_EFAULT );
+  XLAL_CHECK( file != NULL, XLAL_EFAULT );
+  XLAL_CHECK( nrows != NULL, XLAL_EFAULT );
+  XLAL_CHECK( last_rank_stat != NULL, XLAL_EFAULT );
+
+  *nrows = 0;
+  *last_rank_stat = GSL_NEGINF;
+
+  // Return now if there are no runs
+  const size_t nruns = ( toplist->run_files != NULL ) ? toplist->run_files->length : 0;
+  if ( nruns == 0 ) {
+    return XLAL_SUCCESS;
+  }
+
+  // Open all runs for reading, and read the highest-ranked toplist item from each run
+  FITSFile *XLAL_INIT_DECL( run_file, [nruns] );
+  UINT8 XLAL_INIT_DECL( run_nrows, [nruns] );
+  WeaveResultsToplistItem *XLAL_INIT_DECL( run_item, [nruns] );
+  for ( size_t i = 0; i < nruns; ++i ) {
+    run_file[i] = XLALFITSFileOpenRead( toplist->run_files->data[i] );
+    XLAL_CHECK( run_file[i] != NULL, XLAL_EFUNC, "Could not open toplist run file '%s'", toplist->run_files->data[i] );
+    XLAL_CHECK( XLALFITSTableOpenRead( run_file[i], "toplist_run", &run_nrows[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( toplist_fits_table_init( run_file[i], toplist, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    if ( run_nrows[i] > 0 ) {
+      run_item[i] = toplist_item_create( toplist );
+      XLAL_CHECK( run_item[i] != NULL, XLAL_EFUNC );
+      XLAL_CHECK( XLALFITSTableReadRow( run_file[i], run_item[i], &run_nrows[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+  }
+
+  // Repeatedly write the highest-ranked toplist item across all runs, until either all
+  // runs are exhausted or the maximum size of the toplist (if any) has been reached
+  while ( toplist->toplist_limit == 0 || *nrows < toplist->toplist_limit ) {
+
+    // Find the run whose next toplist item is highest-ranked
+    size_t imax = nruns;
+    for ( size_t i = 0; i < nruns; ++i ) {
+      if ( run_item[i] != NULL && ( imax == nruns || toplist->item_get_rank_stat_fcn( run_item[i] ) > toplist->item_get_rank_stat_fcn( run_item[imax] ) ) ) {
+        imax = i;
+      }
+    }
+    if ( imax == nruns ) {
+      break;
+    }
+    WeaveResultsToplistItem *item = run_item[imax];
+
+    // Compute completion-loop statistics, if requested
+    if ( fill_completionloop_stats ) {
+      XLAL_CHECK( toplist_fill_completionloop_stats( toplist->statistics_params, item ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+
+    // Write toplist item
+    XLAL_CHECK( XLALFITSTableWriteRow( file, item ) == XLAL_SUCCESS, XLAL_EFUNC );
+    ++( *nrows );
+    *last_rank_stat = toplist->item_get_rank_stat_fcn( item );
+
+    // Read the next toplist item from the same run, if any
+    if ( run_nrows[imax] > 0 ) {
+      XLAL_CHECK( XLALFITSTableReadRow( run_file[imax], item, &run_nrows[imax] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    } else {
+      toplist_item_destroy( item );
+      run_item[imax] = NULL;
+    }
+
+  }
+
+  // Close all runs
+  for ( size_t i = 0; i < nruns; ++i ) {
+    toplist_item_destroy( run_item[i] );
+    XLALFITSFileClose( run_file[i] );
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+///
+/// Merge all runs of toplist items into a single run, which holds the highest-ranked toplist items
+/// (up to the maximum size of the toplist)
+///
+int toplist_runs_compact(
+  WeaveResultsToplist *toplist,
+  const BOOLEAN fill_completionloop_stats
+  )
+{
+
+  // Check input
+  XLAL_CHECK( toplist != NULL, XLAL_EFAULT );
+
+  // Return now if there are no runs
+  if ( toplist->run_files == NULL || toplist->run_files->length == 0 ) {
+    return XLAL_SUCCESS;
+  }
+
+  // Merge all runs into a new run
+  char *run_file = NULL;
+  FITSFile *file = toplist_run_file_open_write( toplist, &run_file );
+  XLAL_CHECK( file != NULL, XLAL_EFUNC );
+  UINT8 nrows = 0;
+  REAL4 last_rank_stat = 0;
+  XLAL_CHECK( toplist_runs_merge( toplist, file, fill_completionloop_stats, &nrows, &last_rank_stat ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLALFITSFileClose( file );
+
+  // Merged runs are now obsolete, and the new run replaces them
+  for ( size_t i = 0; i < toplist->run_files->length; ++i ) {
+    toplist->obsolete_run_files = XLALAppendString2Vector( toplist->obsolete_run_files, toplist->run_files->data[i] );
+    XLAL_CHECK( toplist->obsolete_run_files != NULL, XLAL_EFUNC );
+  }
+  XLALDestroyStringVector( toplist->run_files );
+  toplist->run_files = XLALCreateStringVector( run_file, NULL );
+  XLAL_CHECK( toplist->run_files != NULL, XLAL_EFUNC );
+  XLALFree( run_file );
+
+  // If the new run is full, no result ranked below its lowest-ranked toplist item will ever enter the toplist
+  if ( toplist->toplist_limit > 0 && nrows == toplist->toplist_limit ) {
+    toplist->run_rank_threshold = last_rank_stat;
+  }
+
+  // Delete obsolete runs, if possible
+  XLAL_CHECK( toplist_runs_delete_unreferenced( toplist ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+}
+
+///
+/// Mark all runs of toplist items as obsolete, to be deleted once no checkpoint refers to them
+///
+int toplist_runs_obsolete(
+  WeaveResultsToplist *toplist
+  )
+{
+
+  // Check input
+  XLAL_CHECK( toplist != NULL, XLAL_EFAULT );
+
+  // Move all runs to list of obsolete runs
+  if ( toplist->run_files != NULL ) {
+    for ( size_t i = 0; i < toplist->run_files->length; ++i ) {
+      toplist->obsolete_run_files = XLALAppendString2Vector( toplist->obsolete_run_files, toplist->run_files->data[i] );
+      XLAL_CHECK( toplist->obsolete_run_files != NULL, XLAL_EFUNC );
+    }
+    XLALDestroyStringVector( toplist->run_files );
+    toplist->run_files = NULL;
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+///
+/// Delete obsolete runs of toplist items which are not referenced by the last checkpoint written
+///
+int toplist_runs_delete_unreferenced(
+  WeaveResultsToplist *toplist
+  )
+{
+
+  // Check input
+  XLAL_CHECK( toplist != NULL, XLAL_EFAULT );
+
+  // Return now if there are no obsolete runs
+  if ( toplist->obsolete_run_files == NULL ) {
+    return XLAL_SUCCESS;
+  }
+
+  // Delete obsolete runs, unless they are needed to restore the last checkpoint written
+  LALStringVector *referenced = NULL;
+  for ( size_t i = 0; i < toplist->obsolete_run_files->length; ++i ) {
+    const char *run_file = toplist->obsolete_run_files->data[i];
+    if ( toplist->ckpt_run_files != NULL && XLALFindStringInVector( run_file, toplist->ckpt_run_files ) >= 0 ) {
+      referenced = XLALAppendString2Vector( referenced, run_file );
+      XLAL_CHECK( referenced != NULL, XLAL_EFUNC );
+    } else {
+      XLAL_CHECK( unlink( run_file ) == 0, XLAL_ESYS, "Could not delete toplist run file '%s'", run_file );
+    }
+  }
+  XLALDestroyStringVector( toplist->obsolete_run_files );
+  toplist->obsolete_run_files = referenced;
+
+  return XLAL_SUCCESS;
+
+}
+
 ///
 /// Create results toplist
 ///
@@ -635,6 +943,8 @@ WeaveResultsToplist *XLALWeaveResultsToplistCreate(
   toplist->item_get_rank_stat_fcn = toplist_item_get_rank_stat_fcn;
   toplist->item_set_rank_stat_fcn = toplist_item_set_rank_stat_fcn;
   toplist->statistics_params = statistics_params;
+  toplist->toplist_limit = toplist_limit;
+  toplist->run_rank_threshold = GSL_NEGINF;
 
   // Create heap which ranks toplist items
   toplist->heap = XLALHeapCreate2( ( LALHeapDtorFcn ) toplist_item_destroy, toplist_limit, +1, toplist_item_compare, toplist_item_get_rank_stat_fcn );
@@ -652,6 +962,13 @@ void XLALWeaveResultsToplistDestroy(
   )
 {
   if ( toplist != NULL ) {
+    // Delete all runs, unless they are needed to restore the last checkpoint written
+    toplist_runs_obsolete( toplist );
+    toplist_runs_delete_unreferenced( toplist );
+    XLALDestroyStringVector( toplist->run_files );
+    XLALDestroyStringVector( toplist->obsolete_run_files );
+    XLALDestroyStringVector( toplist->ckpt_run_files );
+    XLALFree( toplist->run_dir );
     XLALDestroyUINT4Vector( toplist->maybe_add_freq_idxs );
     XLALHeapDestroy( toplist->heap );
     toplist_item_destroy( toplist->saved_item );
@@ -659,6 +976,42 @@ void XLALWeaveResultsToplistDestroy(
   }
 }
 
+///
+/// Keep at most 'run_limit' toplist items in memory. When this limit is reached, toplist items are
+/// written to a new run (a file in 'run_dir', sorted by ranking statistic), and runs are merged when
+/// too many have accumulated, and when the toplist is completed. Checkpoints then only write the
+/// toplist items added since the previous checkpoint as a new run, and list the runs in the header.
+///
+int XLALWeaveResultsToplistSetRuns(
+  WeaveResultsToplist *toplist,
+  const char *run_dir,
+  const UINT4 run_limit
+  )
+{
+
+  // Check input
+  XLAL_CHECK( toplist != NULL, XLAL_EFAULT );
+  XLAL_CHECK( run_dir != NULL, XLAL_EFAULT );
+  XLAL_CHECK( run_limit > 0, XLAL_EINVAL );
+  XLAL_CHECK( toplist->run_dir == NULL, XLAL_EINVAL, "Toplist runs have already been set" );
+  XLAL_CHECK( XLALHeapSize( toplist->heap ) == 0, XLAL_EINVAL, "Toplist must be empty" );
+
+  // Return now if all toplist items will be kept in memory anyway
+  if ( 0 < toplist->toplist_limit && toplist->toplist_limit <= run_limit ) {
+    return XLAL_SUCCESS;
+  }
+
+  // Set run directory
+  toplist->run_dir = XLALStringDuplicate( run_dir );
+  XLAL_CHECK( toplist->run_dir != NULL, XLAL_EFUNC );
+
+  // Limit the number of toplist items in memory
+  XLAL_CHECK( XLALHeapResize( toplist->heap, run_limit ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+}
+
 ///
 /// Add semicoherent results to toplist
 ///
@@ -681,10 +1034,14 @@ int XLALWeaveResultsToplistAdd(
   // Get pointer to array of ranking statistics
   const REAL4 *toplist_rank_stats = toplist->rank_stats_fcn( semi_res );
 
-  // Get ranking statistic of heap root (or -infinity if heap is not yet full)
-  const int heap_full = XLALHeapIsFull( toplist->heap );
-  XLAL_CHECK( heap_full >= 0, XLAL_EFUNC );
-  const REAL4 heap_root_rank_stat = heap_full ? toplist->item_get_rank_stat_fcn( XLALHeapRoot( toplist->heap ) ) : GSL_NEGINF;
+  // Get ranking statistic of heap root (or -infinity if heap is not yet full); if writing runs,
+  // the heap is flushed before it overflows, so instead use the threshold determined by merging runs
+  REAL4 heap_root_rank_stat = toplist->run_rank_threshold;
+  if ( toplist->run_dir == NULL ) {
+    const int heap_full = XLALHeapIsFull( toplist->heap );
+    XLAL_CHECK( heap_full >= 0, XLAL_EFUNC );
+    heap_root_rank_stat = heap_full ? toplist->item_get_rank_stat_fcn( XLALHeapRoot( toplist->heap ) ) : GSL_NEGINF;
+  }
 
   // Find the indexes of the semicoherent results whose ranking statistic equals or exceeds
   // that of the heap root; only select these results for possible insertion into the toplist
@@ -699,6 +1056,11 @@ int XLALWeaveResultsToplistAdd(
   for ( UINT4 idx = 0; idx < n_maybe_add; ++idx ) {
     const UINT4 freq_idx = toplist->maybe_add_freq_idxs->data[idx];
 
+    // If writing runs, flush heap to a new run before it overflows
+    if ( toplist->run_dir != NULL && XLALHeapIsFull( toplist->heap ) ) {
+      XLAL_CHECK( toplist_runs_flush( toplist ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+
     // Create a new toplist item if needed
     if ( toplist->saved_item == NULL ) {
       toplist->saved_item = toplist_item_create( toplist );
@@ -818,8 +1180,20 @@ int XLALWeaveResultsToplistCompletionLoop(
   // Check input
   XLAL_CHECK( toplist != NULL, XLAL_EFAULT );
 
-  // Compute all completion-loop statistics on toplist items
-  XLAL_CHECK( XLALHeapModify( toplist->heap, toplist_fill_completionloop_stats, toplist->statistics_params ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( toplist->run_dir != NULL ) {
+
+    // Flush heap to a new run, then compute all completion-loop statistics while merging all runs into one
+    XLAL_CHECK( toplist_runs_flush( toplist ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( toplist_runs_compact( toplist, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  } else {
+
+    // Compute all completion-loop statistics on toplist items
+    XLAL_CHECK( XLALHeapModify( toplist->heap, toplist_fill_completionloop_stats, toplist->statistics_params ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  }
+
+  toplist->completed = 1;
 
   return XLAL_SUCCESS;
 
@@ -830,7 +1204,7 @@ int XLALWeaveResultsToplistCompletionLoop(
 ///
 int XLALWeaveResultsToplistWrite(
   FITSFile *file,
-  const WeaveResultsToplist *toplist
+  WeaveResultsToplist *toplist
   )
 {
 
@@ -844,12 +1218,63 @@ int XLALWeaveResultsToplistWrite(
   char desc[256];
   snprintf( desc, sizeof( desc ), "toplist ranked by %s", toplist->stat_desc );
 
+  // If writing runs before the toplist is completed, i.e. to a checkpoint: flush heap to a new run,
+  // so that only toplist items added since the previous checkpoint are written
+  if ( toplist->run_dir != NULL && !toplist->completed ) {
+    XLAL_CHECK( toplist_runs_flush( toplist ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
   // Open FITS table for writing and initialise
   XLAL_CHECK( XLALFITSTableOpenWrite( file, name, desc ) == XLAL_SUCCESS, XLAL_EFUNC );
-  XLAL_CHECK( toplist_fits_table_init( file, toplist ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( toplist_fits_table_init( file, toplist, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-  // Write all heap items to FITS table
-  XLAL_CHECK( XLALHeapVisit( toplist->heap, toplist_fits_table_write_visitor, file ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( toplist->run_dir != NULL && toplist->completed ) {
+
+    // Write all items in (merged) runs to FITS table
+    UINT8 nrows = 0;
+    REAL4 last_rank_stat = 0;
+    XLAL_CHECK( toplist_runs_merge( toplist, file, 0, &nrows, &last_rank_stat ) == XLAL_SUCCESS, XLAL_EFUNC );
+    if ( nrows == 0 ) {
+      XLAL_CHECK( XLALFITSTableWriteRows( file, NULL, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+
+    // The final toplist has been written, so runs are no longer needed, even by the last checkpoint written
+    XLALDestroyStringVector( toplist->ckpt_run_files );
+    toplist->ckpt_run_files = NULL;
+    XLAL_CHECK( toplist_runs_obsolete( toplist ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( toplist_runs_delete_unreferenced( toplist ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  } else {
+
+    // Write all heap items to FITS table; this also creates the table if there are no heap items
+    const int n = XLALHeapSize( toplist->heap );
+    XLAL_CHECK( n >= 0, XLAL_EFUNC );
+    const void **items = NULL;
+    if ( n > 0 ) {
+      items = XLALHeapElements( toplist->heap );
+      XLAL_CHECK( items != NULL, XLAL_EFUNC );
+    }
+    XLAL_CHECK( XLALFITSTableWriteRows( file, items, n ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALFree( items );
+
+  }
+
+  // If writing runs to a checkpoint, list all runs in the header of the toplist table, which now exists;
+  // runs referenced by the previous checkpoint, which have since been merged, are no longer needed
+  if ( toplist->run_dir != NULL && !toplist->completed ) {
+    if ( toplist->run_files != NULL ) {
+      char key[256];
+      snprintf( key, sizeof( key ), "%s runs", toplist->stat_name );
+      XLAL_CHECK( XLALFITSHeaderWriteStringVector( file, key, toplist->run_files, "files containing runs of toplist items" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+    XLALDestroyStringVector( toplist->ckpt_run_files );
+    toplist->ckpt_run_files = NULL;
+    if ( toplist->run_files != NULL ) {
+      toplist->ckpt_run_files = XLALCopyStringVector( toplist->run_files );
+      XLAL_CHECK( toplist->ckpt_run_files != NULL, XLAL_EFUNC );
+    }
+    XLAL_CHECK( toplist_runs_delete_unreferenced( toplist ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
 
   return XLAL_SUCCESS;
 
@@ -875,11 +1300,36 @@ int XLALWeaveResultsToplistReadAppend(
   // Open FITS table for reading and initialise
   UINT8 nrows = 0;
   XLAL_CHECK( XLALFITSTableOpenRead( file, name, &nrows ) == XLAL_SUCCESS, XLAL_EFUNC );
-  XLAL_CHECK( toplist_fits_table_init( file, toplist ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( toplist_fits_table_init( file, toplist, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Read list of runs from the header of the toplist table, if any
+  {
+    char key[256];
+    snprintf( key, sizeof( key ), "%s runs", toplist->stat_name );
+    BOOLEAN exists = 0;
+    XLAL_CHECK( XLALFITSHeaderQueryKeyExists( file, key, &exists ) == XLAL_SUCCESS, XLAL_EFUNC );
+    if ( exists ) {
+      XLAL_CHECK( toplist->run_dir != NULL, XLAL_EINVAL, "Toplist ranked by %s contains runs, but toplist runs have not been set", toplist->stat_desc );
+      LALStringVector *run_files = NULL;
+      XLAL_CHECK( XLALFITSHeaderReadStringVector( file, key, &run_files ) == XLAL_SUCCESS, XLAL_EFUNC );
+      for ( size_t i = 0; i < run_files->length; ++i ) {
+        toplist->run_files = XLALAppendString2Vector( toplist->run_files, run_files->data[i] );
+        XLAL_CHECK( toplist->run_files != NULL, XLAL_EFUNC );
+        toplist->ckpt_run_files = XLALAppendString2Vector( toplist->ckpt_run_files, run_files->data[i] );
+        XLAL_CHECK( toplist->ckpt_run_files != NULL, XLAL_EFUNC );
+      }
+      XLALDestroyStringVector( run_files );
+    }
+  }
 
   // Read all items from FITS table
   while ( nrows > 0 ) {
 
+    // If writing runs, flush heap to a new run before it overflows
+    if ( toplist->run_dir != NULL && XLALHeapIsFull( toplist->heap ) ) {
+      XLAL_CHECK( toplist_runs_flush( toplist ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+
     // Create a new toplist item if needed
     if ( toplist->saved_item == NULL ) {
       toplist->saved_item = toplist_item_create( toplist );
@@ -91,6 +91,11 @@ WeaveResultsToplist *XLALWeaveResultsToplistCreate(
 void XLALWeaveResultsToplistDestroy(
   WeaveResultsToplist *toplist
   );
+int XLALWeaveResultsToplistSetRuns(
+  WeaveResultsToplist *toplist,
+  const char *run_dir,
+  const UINT4 run_limit
+  );
 int XLALWeaveResultsToplistAdd(
   WeaveResultsToplist *toplist,
   const WeaveSemiResults *semi_res,
@@ -101,7 +106,7 @@ int XLALWeaveResultsToplistCompletionLoop(
   );
 int XLALWeaveResultsToplistWrite(
   FITSFile *file,
-  const WeaveResultsToplist *toplist
+  WeaveResultsToplist *toplist
   );
 int XLALWeaveResultsToplistReadAppend(
   FITSFile *file,
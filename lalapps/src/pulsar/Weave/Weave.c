@@ -33,6 +33,32 @@
 #include <lal/LogPrintf.h>
 #include <lal/UserInput.h>
 #include <lal/Random.h>
+#include <lal/SinCosLUT.h>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+///
+/// Return the name of the file for frequency band 'freq_band' of 'freq_bands', by replacing the
+/// first '%u' in 'file_pattern' by the band index, or a copy of 'file_pattern' if there is one band
+///
+static char *WeaveFreqBandFileName(
+  const char *file_pattern,
+  const UINT4 freq_bands,
+  const UINT4 freq_band
+  )
+{
+  XLAL_CHECK_NULL( file_pattern != NULL, XLAL_EFAULT );
+  if ( freq_bands == 1 ) {
+    return XLALStringDuplicate( file_pattern );
+  }
+  const char *p = strstr( file_pattern, "%u" );
+  XLAL_CHECK_NULL( p != NULL, XLAL_EINVAL, "File name '%s' does not contain '%%u'", file_pattern );
+  char *file_name = XLALStringAppendFmt( NULL, "%.*s%u%s", ( int )( p - file_pattern ), file_pattern, freq_band, p + 2 );
+  XLAL_CHECK_NULL( file_name != NULL, XLAL_EFUNC );
+  return file_name;
+}
 
 int main( int argc, char *argv[] )
 {
@@ -48,24 +74,28 @@ int main( int argc, char *argv[] )
   // Initialise user input variables
   struct uvar_type {
     BOOLEAN validate_sft_files, interpolation, lattice_rand_offset, toplist_tmpl_idx, segment_info, simulate_search, time_search, cache_all_gc, strict_spindown_bounds;
-    CHAR *setup_file, *sft_files, *output_file, *ckpt_output_file;
+    CHAR *setup_file, *sft_files, *output_file, *ckpt_output_file, *cache_spill_dir, *toplist_run_dir;
     LALStringVector *sft_timestamps_files, *sft_noise_sqrtSX, *injections, *Fstat_assume_sqrtSX, *lrs_oLGX;
     REAL8 sft_timebase, semi_max_mismatch, coh_max_mismatch, ckpt_output_period, ckpt_output_exit, lrs_Fstar0sc, nc_2Fth;
     REAL8Range alpha, delta, freq, f1dot, f2dot, f3dot, f4dot;
-    UINT4 sky_patch_count, sky_patch_index, freq_partitions, f1dot_partitions, Fstat_run_med_window, Fstat_Dterms, toplist_limit, rand_seed, cache_max_size;
-    int lattice, Fstat_method, Fstat_SSB_precision, toplists, extra_statistics, recalc_statistics;
+    UINT4 sky_patch_count, sky_patch_index, freq_bands, freq_partitions, f1dot_partitions, Fstat_run_med_window, Fstat_Dterms, Fstat_threads, toplist_limit, toplist_run_limit, rand_seed, cache_max_size;
+    int lattice, Fstat_method, Fstat_SSB_precision, Fstat_mem_placement, toplists, extra_statistics, recalc_statistics;
   } uvar_struct = {
     .Fstat_Dterms = Fstat_opt_args.Dterms,
     .Fstat_SSB_precision = Fstat_opt_args.SSBprec,
+    .Fstat_mem_placement = LAL_MEMORY_PLACEMENT_DEFAULT,
     .Fstat_method = FMETHOD_RESAMP_BEST,
     .Fstat_run_med_window = Fstat_opt_args.runningMedianWindow,
+    .Fstat_threads = 1,
     .alpha = {0, LAL_TWOPI},
     .delta = {-LAL_PI_2, LAL_PI_2},
+    .freq_bands = 1,
     .freq_partitions = 1,
     .f1dot_partitions = 1,
     .interpolation = 1,
     .lattice = TILING_LATTICE_ANSTAR,
     .toplist_limit = 1000,
+    .toplist_run_limit = 100000,
     .toplists = WEAVE_STATISTIC_MEAN2F,
     .extra_statistics = WEAVE_STATISTIC_NONE,
     .recalc_statistics = WEAVE_STATISTIC_NONE,
@@ -150,6 +180,13 @@ int main( int argc, char *argv[] )
     freq, REAL8Range, 'f', REQUIRED,
     "Search parameter space in frequency, in Hertz. "
     );
+  XLALRegisterUvarMember(
+    freq_bands, UINT4, 0, DEVELOPER,
+    "Divide the frequency parameter space into this number of equal-width bands, and search each band in turn as if by separate runs of lalapps_Weave. "
+    "The setup data, SFTs, and signal injections are loaded once and shared between bands. "
+    "If greater than 1, the file names given by " UVAR_STR( output_file ) " and " UVAR_STR( ckpt_output_file ) " must contain '%%u', "
+    "which is replaced by the band index (starting from 0); bands for which an output file already exists are skipped. "
+    );
   XLALRegisterUvarMember(
     freq_partitions, UINT4, 'F', DEVELOPER,
     "Internally divide the frequency parameter space into this number of ~equal-width partitions. "
@@ -237,6 +274,17 @@ int main( int argc, char *argv[] )
     Fstat_SSB_precision, UserEnum, &SSBprecisionChoices, 0, DEVELOPER,
     "Precision in calculating the barycentric transformation. "
     );
+  XLALRegisterUvarMember(
+    Fstat_threads, UINT4, 0, DEVELOPER,
+    "Number of threads used to compute coherent results for different segments concurrently. "
+    "Threads share the same SFT and ephemeris data; segments are assigned to threads in turn, and segments assigned to the same thread share F-statistic workspace memory. "
+    "Requires lalapps to have been compiled with OpenMP. "
+    );
+  XLALRegisterUvarAuxDataMember(
+    Fstat_mem_placement, UserEnum, &FstatMemPlacementChoices, 0, DEVELOPER,
+    "Placement of the coherent results arrays on the nodes of a NUMA system: 'interleave' spreads their pages over all nodes; "
+    "'local' keeps each array on the node of the thread which computes it (see " UVAR_STR( Fstat_threads ) "), which is most useful if threads are bound to nodes, e.g. by setting OMP_PROC_BIND. "
+    );
   //
   // Various statistics input arguments
   //
@@ -266,6 +314,15 @@ int main( int argc, char *argv[] )
     "Sets which combination of toplists to return in the output file given by " UVAR_STR( output_file ) ":\n"
     "%s", WeaveToplistHelpString
     );
+  XLALRegisterUvarMember(
+    toplist_run_dir, STRING, 0, DEVELOPER,
+    "Keep at most " UVAR_STR( toplist_run_limit ) " candidates of each toplist in memory, and write further candidates as sorted runs to files in this directory. "
+    "Runs are merged into the final toplists once the search is complete; checkpoints then only write candidates found since the previous checkpoint. "
+    );
+  XLALRegisterUvarMember(
+    toplist_run_limit, UINT4, 0, DEVELOPER,
+    "Maximum number of candidates of each toplist to keep in memory when " UVAR_STR( toplist_run_dir ) " is given. "
+    );
   XLALRegisterUvarMember(
     toplist_tmpl_idx, BOOLEAN, 0, DEVELOPER,
     "Output for each toplist item a unique (up to frequency) index identifying its semicoherent and coherent templates. "
@@ -333,6 +390,11 @@ int main( int argc, char *argv[] )
     "If FALSE, whenever an item is added to the internal caches, at most one item that may no longer be required is removed. "
     "Has no effect when performing a fully-coherent single-segment search, or a non-interpolating search. "
     );
+  XLALRegisterUvarMember(
+    cache_spill_dir, STRING, 0, DEVELOPER,
+    "Write items removed from the internal caches to temporary files in this directory, and read them back instead of recomputing them should they be required again. "
+    "Has no effect when performing a fully-coherent single-segment search, or a non-interpolating search. "
+    );
 
   // Parse user input
   XLAL_CHECK_MAIN( xlalErrno == 0, XLAL_EFUNC, "A call to XLALRegisterUvarMember() failed" );
@@ -374,6 +436,15 @@ int main( int argc, char *argv[] )
   XLALUserVarCheck( &should_exit,
                     !UVAR_SET( sky_patch_index ) || uvar->sky_patch_index < uvar->sky_patch_count,
                     UVAR_STR( sky_patch_index ) " must be positive and strictly less than " UVAR_STR( sky_patch_count ) );
+  XLALUserVarCheck( &should_exit,
+                    uvar->freq_bands > 0,
+                    UVAR_STR( freq_bands ) " must be strictly positive" );
+  XLALUserVarCheck( &should_exit,
+                    uvar->freq_bands == 1 || strstr( uvar->output_file, "%u" ) != NULL,
+                    UVAR_STR( output_file ) " must contain '%%u' if " UVAR_STR( freq_bands ) " is greater than 1" );
+  XLALUserVarCheck( &should_exit,
+                    uvar->freq_bands == 1 || !UVAR_SET( ckpt_output_file ) || strstr( uvar->ckpt_output_file, "%u" ) != NULL,
+                    UVAR_STR( ckpt_output_file ) " must contain '%%u' if " UVAR_STR( freq_bands ) " is greater than 1" );
   XLALUserVarCheck( &should_exit,
                     uvar->freq_partitions > 0,
                     UVAR_STR( freq_partitions ) " must be strictly positive" );
@@ -410,7 +481,12 @@ int main( int argc, char *argv[] )
   //
   // - Output control
   //
-
+  XLALUserVarCheck( &should_exit,
+                    uvar->toplist_run_limit > 0,
+                    UVAR_STR( toplist_run_limit ) " must be strictly positive" );
+  XLALUserVarCheck( &should_exit,
+                    !UVAR_SET( toplist_run_limit ) || UVAR_SET( toplist_run_dir ),
+                    UVAR_STR( toplist_run_dir ) " must be specified if " UVAR_STR( toplist_run_limit ) " is specified" );
   //
   // - Checkpointing
   //
@@ -424,8 +500,22 @@ int main( int argc, char *argv[] )
                     !UVAR_SET( ckpt_output_exit ) || ( 0 <= uvar->ckpt_output_exit && uvar->ckpt_output_exit <= 1 ),
                     UVAR_STR( ckpt_output_exit ) " must be in range [0,1]" );
   //
+  // - F-statistic computation
+  //
+  XLALUserVarCheck( &should_exit,
+                    uvar->Fstat_threads > 0,
+                    UVAR_STR( Fstat_threads ) " must be strictly positive" );
+#if !defined(_OPENMP)
+  XLALUserVarCheck( &should_exit,
+                    uvar->Fstat_threads == 1,
+                    UVAR_STR( Fstat_threads ) " > 1 requires lalapps to have been compiled with OpenMP" );
+#endif
+  //
   // - Esoterica
   //
+  XLALUserVarCheck( &should_exit,
+                    !( uvar->time_search && uvar->Fstat_threads > 1 ),
+                    UVAR_STR( time_search ) " cannot be used with " UVAR_STR( Fstat_threads ) " > 1" );
   XLALUserVarCheck( &should_exit,
                     !UVAR_ALLSET2( time_search, simulate_search ),
                     UVAR_STR2AND( time_search, simulate_search ) " are mutually exclusive" );
@@ -478,40 +568,6 @@ int main( int argc, char *argv[] )
   XLAL_CHECK_MAIN( XLALSegListRange( setup.segments, &segments_start, &segments_end ) == XLAL_SUCCESS, XLAL_EFUNC );
   LogPrintf( LOG_NORMAL, "Setup file segment list range = [%" LAL_GPS_FORMAT ", %" LAL_GPS_FORMAT "] GPS, segment count = %u\n", LAL_GPS_PRINT( segments_start ), LAL_GPS_PRINT( segments_end ), nsegments );
 
-  ////////// Set up calculation of various requested output statistics //////////
-
-  WeaveStatisticsParams *statistics_params = XLALCalloc( 1, sizeof( *statistics_params ) );
-  XLAL_CHECK_MAIN( statistics_params != NULL, XLAL_ENOMEM );
-  statistics_params->detectors = XLALCopyStringVector( setup.detectors );
-  XLAL_CHECK_MAIN( statistics_params->detectors != NULL, XLAL_EFUNC );
-  statistics_params->nsegments = nsegments;
-
-  //
-  // Figure out which statistics need to be computed, and when, in order to
-  // produce all the requested toplist-statistics in the "main loop" and all remaining
-  // extra-statistics in the "completion loop" after the toplist has been computed
-  // work out dependency-map for different statistics sets: toplist-ranking, output, total set of dependencies in main/completion loop ...
-  XLAL_CHECK_MAIN( XLALWeaveStatisticsParamsSetDependencyMap( statistics_params, uvar->toplists, uvar->extra_statistics, uvar->recalc_statistics ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-  // Prepare memory for coherent F-stat argument setups
-  statistics_params->coh_input = XLALCalloc( nsegments, sizeof( statistics_params->coh_input[0] ) );
-  XLAL_CHECK_MAIN( statistics_params->coh_input != NULL, XLAL_ENOMEM );
-
-  // ---------- prepare setup for line-robust statistics if requested ----------
-  if ( statistics_params->all_statistics_to_compute & ( WEAVE_STATISTIC_BSGL|WEAVE_STATISTIC_BSGLtL|WEAVE_STATISTIC_BtSGLtL ) ) {
-    REAL4 *oLGX_p = NULL;
-    REAL4 oLGX[PULSAR_MAX_DETECTORS];
-    if ( uvar->lrs_oLGX != NULL ) {
-      XLAL_CHECK_MAIN( uvar->lrs_oLGX->length == ndetectors, XLAL_EINVAL, "length(lrs-oLGX) = %d must equal number of detectors (%d)'\n", uvar->lrs_oLGX->length, ndetectors );
-      XLAL_CHECK_MAIN( XLALParseLinePriors( &oLGX[0], uvar->lrs_oLGX ) == XLAL_SUCCESS, XLAL_EFUNC );
-      oLGX_p = &oLGX[0];
-    }
-    const BOOLEAN useLogCorrection = 0;
-    statistics_params->BSGL_setup = XLALCreateBSGLSetup( ndetectors, uvar->lrs_Fstar0sc, oLGX_p, useLogCorrection, nsegments );
-    XLAL_CHECK_MAIN( statistics_params->BSGL_setup != NULL, XLAL_EFUNC );
-  }
-  // set number-count threshold
-  statistics_params->nc_2Fth = uvar->nc_2Fth;
 
   ////////// Set up lattice tilings //////////
 
@@ -548,13 +604,6 @@ int main( int argc, char *argv[] )
     LogPrintf( LOG_NORMAL, "Performing an interpolating search with maximum semicoherent mismatch = %.15g, maximum coherent mismatch = %.15g\n", semi_max_mismatch, coh_max_mismatch );
   }
 
-  // Scale metrics to fiducial frequency, given by maximum search frequency
-  XLAL_CHECK_MAIN( XLALScaleSuperskyMetricsFiducialFreq( setup.metrics, uvar->freq[1] ) == XLAL_SUCCESS, XLAL_EFUNC );
-  LogPrintf( LOG_NORMAL, "Metric fiducial frequency set to maximum search frequency = %.15g Hz\n", uvar->freq[1] );
-
-  // Equalise metric frequency spacing, given the specified maximum mismatches
-  XLAL_CHECK_MAIN( XLALEqualizeReducedSuperskyMetricsFreqSpacing( setup.metrics, coh_max_mismatch, semi_max_mismatch ) == XLAL_SUCCESS, XLAL_EFUNC );
-
   // Store user input spindown ranges in an array for ease of use
   const double uvarspins[][2] = {
     { uvar->f1dot[0], uvar->f1dot[1] },
@@ -585,121 +634,6 @@ int main( int argc, char *argv[] )
   // Index of semicoherent tiling in arrays; always the last element
   const size_t isemi = ntiles - 1;
 
-  // Create parameter-space tilings
-  LatticeTiling *XLAL_INIT_DECL( tiling, [ntiles] );
-  for ( size_t i = 0; i < ntiles; ++i ) {
-    tiling[i] = XLALCreateLatticeTiling( ndim );
-    XLAL_CHECK_MAIN( tiling[i] != NULL, XLAL_EFUNC );
-  }
-
-  // Create arrays to store the appropriate parameter-space metrics for each tiling
-  gsl_matrix *XLAL_INIT_DECL( rssky_metric, [ntiles] );
-  SuperskyTransformData *XLAL_INIT_DECL( rssky_transf, [ntiles] );
-  for ( size_t i = 0; i < nsegments; ++i ) {
-    rssky_metric[i] = setup.metrics->coh_rssky_metric[i];
-    rssky_transf[i] = setup.metrics->coh_rssky_transf[i];
-  }
-  rssky_metric[isemi] = setup.metrics->semi_rssky_metric;
-  rssky_transf[isemi] = setup.metrics->semi_rssky_transf;
-
-  // Create arrays to store the range of physical coordinates covered by each tiling
-  const PulsarDopplerParams *XLAL_INIT_DECL( min_phys, [ntiles] );
-  const PulsarDopplerParams *XLAL_INIT_DECL( max_phys, [ntiles] );
-
-  //
-  // Set up semicoherent lattice tiling
-  //
-
-  // Set sky semicoherent parameter-space bounds
-  // - Compute area of sky semicoherent parameter space for later output
-  double semi_sky_area = 0.0;
-  if ( UVAR_SET( sky_patch_count ) ) {
-    XLAL_CHECK_MAIN( XLALSetSuperskyEqualAreaSkyBounds( tiling[isemi], rssky_metric[isemi], semi_max_mismatch, uvar->sky_patch_count, uvar->sky_patch_index ) == XLAL_SUCCESS, XLAL_EFUNC );
-    LogPrintf( LOG_NORMAL, "Search sky parameter space sky patch = %u of %u\n", uvar->sky_patch_index, uvar->sky_patch_count );
-    semi_sky_area = 4.0 * LAL_PI / uvar->sky_patch_count;
-  } else {
-    XLAL_CHECK_MAIN( XLALSetSuperskyPhysicalSkyBounds( tiling[isemi], rssky_metric[isemi], rssky_transf[isemi], uvar->alpha[0], uvar->alpha[1], uvar->delta[0], uvar->delta[1] ) == XLAL_SUCCESS, XLAL_EFUNC );
-    LogPrintf( LOG_NORMAL, "Search sky parameter space right ascension = [%.15g, %.15g] rad\n", uvar->alpha[0], uvar->alpha[1] );
-    LogPrintf( LOG_NORMAL, "Search sky parameter space declination = [%.15g, %.15g] rad\n", uvar->delta[0], uvar->delta[1] );
-    semi_sky_area = ( uvar->alpha[1] - uvar->alpha[0] ) * ( sin( uvar->delta[1] ) - sin( uvar->delta[0] ) );
-  }
-
-  // Set frequency/spindown semicoherent parameter-space bounds
-  XLAL_CHECK_MAIN( XLALSetSuperskyPhysicalSpinBound( tiling[isemi], rssky_transf[isemi], 0, uvar->freq[0], uvar->freq[1] ) == XLAL_SUCCESS, XLAL_EFUNC );
-  LogPrintf( LOG_NORMAL, "Search frequency parameter space = [%.15g, %.15g] Hz\n", uvar->freq[0], uvar->freq[1] );
-  for ( size_t s = 1; s <= nmetricspins; ++s ) {
-    XLAL_CHECK_MAIN( XLALSetSuperskyPhysicalSpinBound( tiling[isemi], rssky_transf[isemi], s, uvarspins[s-1][0], uvarspins[s-1][1] ) == XLAL_SUCCESS, XLAL_EFUNC );
-    XLAL_CHECK_MAIN( XLALSetSuperskyPhysicalSpinBoundPadding( tiling[isemi], rssky_transf[isemi], s, !uvar->strict_spindown_bounds ) == XLAL_SUCCESS, XLAL_EFUNC );
-    LogPrintf( LOG_NORMAL, "Search %zu-order spindown parameter space = [%.15g, %.15g] Hz/s^%zu %s padding\n", s, uvarspins[s-1][0], uvarspins[s-1][1], s, uvar->strict_spindown_bounds ? "without" : "with" );
-  }
-
-  // Add random offsets to physical origin of semicoherent lattice tiling, if requested
-  if ( UVAR_SET( lattice_rand_offset ) ) {
-    XLAL_CHECK_MAIN( XLALSetLatticeTilingRandomOriginOffsets( tiling[isemi], rand_par ) == XLAL_SUCCESS, XLAL_EFUNC );
-  }
-
-  // Set semicoherent parameter-space lattice and metric
-  XLAL_CHECK_MAIN( XLALSetTilingLatticeAndMetric( tiling[isemi], uvar->lattice, rssky_metric[isemi], semi_max_mismatch ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-  // Print number of (tiled) parameter-space dimensions
-  LogPrintf( LOG_NORMAL, "Number of (tiled) parameter-space dimensions = %zu (%zu)\n", ndim, XLALTiledLatticeTilingDimensions( tiling[isemi] ) );
-
-  // Register callback to compute range of physical coordinates covered by semicoherent parameter space
-  XLAL_CHECK_MAIN( XLALRegisterSuperskyLatticePhysicalRangeCallback( tiling[isemi], rssky_transf[isemi], &min_phys[isemi], &max_phys[isemi] ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-  // Register callbacks to compute, for each coherent tiling, range of coherent reduced supersky coordinates which enclose semicoherent parameter space
-  // - Arrays are of length 'ntiles' since 'ncohtiles' will be zero for a fully-coherent search
-  const gsl_vector *XLAL_INIT_DECL( coh_min_rssky, [ntiles] );
-  const gsl_vector *XLAL_INIT_DECL( coh_max_rssky, [ntiles] );
-  for ( size_t i = 0; i < ncohtiles; ++i ) {
-    XLAL_CHECK_MAIN( XLALRegisterSuperskyLatticeSuperskyRangeCallback( tiling[isemi], rssky_transf[isemi], rssky_transf[i], &coh_min_rssky[i], &coh_max_rssky[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
-  }
-
-  // Iterate over semicoherent tiling and perform callback actions
-  LogPrintf( LOG_NORMAL, "Setting up semicoherent lattice tiling ...\n" );
-  XLAL_CHECK_MAIN( XLALPerformLatticeTilingCallbacks( tiling[isemi] ) == XLAL_SUCCESS, XLAL_EFUNC );
-  LogPrintf( LOG_NORMAL, "Finished setting up semicoherent lattice tiling\n" );
-
-  // Output number of points in semicoherent tiling
-  {
-    const LatticeTilingStats *stats = XLALLatticeTilingStatistics( tiling[isemi], ndim - 1 );
-    XLAL_CHECK_MAIN( stats != NULL, XLAL_EFUNC );
-    LogPrintf( LOG_NORMAL, "Number of semicoherent templates = %" LAL_UINT8_FORMAT "\n", stats->total_points );
-  }
-
-  // Get frequency spacing used by parameter-space tiling
-  // - XLALEqualizeReducedSuperskyMetricsFreqSpacing() ensures this is the same for all segments
-  const double dfreq = XLALLatticeTilingStepSize( tiling[isemi], ndim - 1 );
-
-  //
-  // Set up coherent lattice tilings
-  //
-  LogPrintf( LOG_NORMAL, "Setting up coherent lattice tilings ...\n" );
-  for ( size_t i = 0; i < ncohtiles; ++i ) {
-
-    // Set coherent parameter-space bounds which enclose semicoherent parameter space
-    XLAL_CHECK_MAIN( XLALSetSuperskyRangeBounds( tiling[i], coh_min_rssky[i], coh_max_rssky[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Add random offsets to physical origin of coherent lattice tiling, if requested
-    if ( UVAR_SET( lattice_rand_offset ) ) {
-      XLAL_CHECK_MAIN( XLALSetLatticeTilingRandomOriginOffsets( tiling[i], rand_par ) == XLAL_SUCCESS, XLAL_EFUNC );
-    }
-
-    // Ensure that coherent and semicoherent lattice tilings have the same tiled/non-tiled dimensions
-    XLAL_CHECK_MAIN( XLALSetTiledLatticeDimensionsFromTiling( tiling[i], tiling[isemi] ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Set coherent parameter-space lattice and metric
-    XLAL_CHECK_MAIN( XLALSetTilingLatticeAndMetric( tiling[i], uvar->lattice, rssky_metric[i], coh_max_mismatch ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Register callback to compute range of physical coordinates covered by coherent parameter space
-    XLAL_CHECK_MAIN( XLALRegisterSuperskyLatticePhysicalRangeCallback( tiling[i], rssky_transf[i], &min_phys[i], &max_phys[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Iterate over coherent tiling and perform callback actions
-    XLAL_CHECK_MAIN( XLALPerformLatticeTilingCallbacks( tiling[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-  }
-  LogPrintf( LOG_NORMAL, "Finished setting up coherent lattice tilings\n" );
-
   ////////// Load input data //////////
 
   // Load or generate SFTs, unless search is being simulated
@@ -810,430 +744,697 @@ int main( int argc, char *argv[] )
   Fstat_opt_args.injectSources = injections;
   Fstat_opt_args.prevInput = NULL;
   Fstat_opt_args.collectTiming = uvar->time_search;
+  Fstat_opt_args.resampMemPlacement = uvar->Fstat_mem_placement;
 
-  // Load input data required for computing coherent results
-  const LALStringVector *sft_noise_sqrtSX = UVAR_SET( sft_noise_sqrtSX ) ? uvar->sft_noise_sqrtSX : NULL;
-  const LALStringVector *Fstat_assume_sqrtSX = UVAR_SET( Fstat_assume_sqrtSX ) ? uvar->Fstat_assume_sqrtSX : NULL;
-  LogPrintf( LOG_NORMAL, "Loading input data for coherent results ...\n" );
-  for ( size_t i = 0; i < nsegments; ++i ) {
-    statistics_params->coh_input[i] = XLALWeaveCohInputCreate( setup.detectors, simulation_level, sft_catalog, i, &setup.segments->segs[i], min_phys[i], max_phys[i], dfreq, setup.ephemerides, sft_noise_sqrtSX, Fstat_assume_sqrtSX, &Fstat_opt_args, statistics_params, 0 );
-    XLAL_CHECK_MAIN( statistics_params->coh_input[i] != NULL, XLAL_EFUNC );
-  }
-  statistics_params->ref_time = setup.ref_time;
-
-  LogPrintf( LOG_NORMAL, "Finished loading input data for coherent results\n" );
-
-  // Create caches to store intermediate results from coherent parameter-space tilings
-  // - If no interpolation, caching is not required so reduce maximum cache size to 1
-  WeaveCache *XLAL_INIT_DECL( coh_cache, [nsegments] );
-  for ( size_t i = 0; i < nsegments; ++i ) {
-    const size_t cache_max_size = interpolation ? uvar->cache_max_size : 1;
-    const BOOLEAN cache_all_gc = interpolation ? uvar->cache_all_gc : 0;
-    coh_cache[i] = XLALWeaveCacheCreate( tiling[i], interpolation, rssky_transf[i], rssky_transf[isemi], statistics_params->coh_input[i], cache_max_size, cache_all_gc );
-    XLAL_CHECK_MAIN( coh_cache[i] != NULL, XLAL_EFUNC );
-  }
+  ////////// Search frequency bands //////////
+
+  // Search each frequency band in turn
+  // - The setup data, SFTs, and signal injections loaded above are shared between bands; the metrics
+  //   are rescaled, and the lattice tilings, F-statistic input data, caches, and results recreated, for each band
+  const UINT4 freq_bands = uvar->freq_bands;
+  const double freq_band_width = ( uvar->freq[1] - uvar->freq[0] ) / freq_bands;
+  BOOLEAN search_complete = 0;
+  for ( UINT4 freq_band = 0; freq_band < freq_bands; ++freq_band ) {
+
+    // Frequency range of this band; the last band ends exactly at the maximum search frequency
+    const double band_freq[2] = {
+      uvar->freq[0] + freq_band * freq_band_width,
+      ( freq_band + 1 < freq_bands ) ? uvar->freq[0] + ( freq_band + 1 ) * freq_band_width : uvar->freq[1]
+    };
+
+    // Output and checkpoint file names of this band
+    char *output_file = WeaveFreqBandFileName( uvar->output_file, freq_bands, freq_band );
+    XLAL_CHECK_MAIN( output_file != NULL, XLAL_EFUNC );
+    char *ckpt_output_file = NULL;
+    if ( UVAR_SET( ckpt_output_file ) ) {
+      ckpt_output_file = WeaveFreqBandFileName( uvar->ckpt_output_file, freq_bands, freq_band );
+      XLAL_CHECK_MAIN( ckpt_output_file != NULL, XLAL_EFUNC );
+    }
 
-  ////////// Perform search //////////
+    if ( freq_bands > 1 ) {
+      LogPrintf( LOG_NORMAL, "Searching frequency band %u of %u = [%.15g, %.15g] Hz\n", freq_band + 1, freq_bands, band_freq[0], band_freq[1] );
 
-  // Create iterator over the main loop search parameter space
-  WeaveSearchIterator *main_loop_itr = XLALWeaveMainLoopSearchIteratorCreate( tiling[isemi], uvar->freq_partitions, uvar->f1dot_partitions );
-  XLAL_CHECK_MAIN( main_loop_itr != NULL, XLAL_EFUNC );
+      // Skip bands whose output file was already written, e.g. by a previous run of this job
+      FITSFile *file = NULL;
+      int errnum = 0;
+      XLAL_TRY_SILENT( file = XLALFITSFileOpenRead( output_file ), errnum );
+      if ( errnum == 0 && file != NULL ) {
+        XLALFITSFileClose( file );
+        LogPrintf( LOG_NORMAL, "Output file '%s' exists; skipping frequency band %u\n", output_file, freq_band + 1 );
+        XLALFree( output_file );
+        XLALFree( ckpt_output_file );
+        search_complete = 1;
+        continue;
+      }
+    }
 
-  // Create storage for cache queries for coherent results in each segment
-  WeaveCacheQueries *queries = XLALWeaveCacheQueriesCreate( tiling[isemi], rssky_transf[isemi], dfreq, nsegments, uvar->freq_partitions );
-  XLAL_CHECK_MAIN( queries != NULL, XLAL_EFUNC );
+    ////////// Set up calculation of various requested output statistics //////////
+
+    WeaveStatisticsParams *statistics_params = XLALCalloc( 1, sizeof( *statistics_params ) );
+    XLAL_CHECK_MAIN( statistics_params != NULL, XLAL_ENOMEM );
+    statistics_params->detectors = XLALCopyStringVector( setup.detectors );
+    XLAL_CHECK_MAIN( statistics_params->detectors != NULL, XLAL_EFUNC );
+    statistics_params->nsegments = nsegments;
+
+    //
+    // Figure out which statistics need to be computed, and when, in order to
+    // produce all the requested toplist-statistics in the "main loop" and all remaining
+    // extra-statistics in the "completion loop" after the toplist has been computed
+    // work out dependency-map for different statistics sets: toplist-ranking, output, total set of dependencies in main/completion loop ...
+    XLAL_CHECK_MAIN( XLALWeaveStatisticsParamsSetDependencyMap( statistics_params, uvar->toplists, uvar->extra_statistics, uvar->recalc_statistics ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    // Prepare memory for coherent F-stat argument setups
+    statistics_params->coh_input = XLALCalloc( nsegments, sizeof( statistics_params->coh_input[0] ) );
+    XLAL_CHECK_MAIN( statistics_params->coh_input != NULL, XLAL_ENOMEM );
+
+    // ---------- prepare setup for line-robust statistics if requested ----------
+    if ( statistics_params->all_statistics_to_compute & ( WEAVE_STATISTIC_BSGL|WEAVE_STATISTIC_BSGLtL|WEAVE_STATISTIC_BtSGLtL ) ) {
+      REAL4 *oLGX_p = NULL;
+      REAL4 oLGX[PULSAR_MAX_DETECTORS];
+      if ( uvar->lrs_oLGX != NULL ) {
+        XLAL_CHECK_MAIN( uvar->lrs_oLGX->length == ndetectors, XLAL_EINVAL, "length(lrs-oLGX) = %d must equal number of detectors (%d)'\n", uvar->lrs_oLGX->length, ndetectors );
+        XLAL_CHECK_MAIN( XLALParseLinePriors( &oLGX[0], uvar->lrs_oLGX ) == XLAL_SUCCESS, XLAL_EFUNC );
+        oLGX_p = &oLGX[0];
+      }
+      const BOOLEAN useLogCorrection = 0;
+      statistics_params->BSGL_setup = XLALCreateBSGLSetup( ndetectors, uvar->lrs_Fstar0sc, oLGX_p, useLogCorrection, nsegments );
+      XLAL_CHECK_MAIN( statistics_params->BSGL_setup != NULL, XLAL_EFUNC );
+    }
+    // set number-count threshold
+    statistics_params->nc_2Fth = uvar->nc_2Fth;
 
-  // Pointer to final semicoherent results
-  WeaveSemiResults *semi_res = NULL;
+    ////////// Set up lattice tilings of this band //////////
 
-  // Create output results structure
-  WeaveOutputResults *out = XLALWeaveOutputResultsCreate( &setup.ref_time, ninputspins, statistics_params, uvar->toplist_limit, uvar->toplist_tmpl_idx );
-  XLAL_CHECK_MAIN( out != NULL, XLAL_EFUNC );
+    // Copy setup metrics, since they are modified to suit the frequency range of this band
+    SuperskyMetrics *metrics = XLALCopySuperskyMetrics( setup.metrics );
+    XLAL_CHECK_MAIN( metrics != NULL, XLAL_EFUNC );
 
-  // Create search timing structure
-  WeaveSearchTiming *tim = XLALWeaveSearchTimingCreate( uvar->time_search, statistics_params );
-  XLAL_CHECK_MAIN( tim != NULL, XLAL_EFUNC );
+    // Scale metrics to fiducial frequency, given by maximum frequency of this band
+    XLAL_CHECK_MAIN( XLALScaleSuperskyMetricsFiducialFreq( metrics, band_freq[1] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    LogPrintf( LOG_NORMAL, "Metric fiducial frequency set to maximum band frequency = %.15g Hz\n", band_freq[1] );
 
-  // Number of times output results have been restored from a checkpoint
-  UINT4 ckpt_output_count = 0;
+    // Equalise metric frequency spacing, given the specified maximum mismatches
+    XLAL_CHECK_MAIN( XLALEqualizeReducedSuperskyMetricsFreqSpacing( metrics, coh_max_mismatch, semi_max_mismatch ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-  // Try to restore output results from a checkpoint file, if given
-  if ( UVAR_SET( ckpt_output_file ) ) {
+    // Create parameter-space tilings
+    LatticeTiling *XLAL_INIT_DECL( tiling, [ntiles] );
+    for ( size_t i = 0; i < ntiles; ++i ) {
+      tiling[i] = XLALCreateLatticeTiling( ndim );
+      XLAL_CHECK_MAIN( tiling[i] != NULL, XLAL_EFUNC );
+    }
 
-    // Try to open output checkpoint file
-    LogPrintf( LOG_NORMAL, "Trying to open output checkpoint file '%s' for reading ...\n", uvar->ckpt_output_file );
-    int errnum = 0;
-    FITSFile *file = NULL;
-    XLAL_TRY( file = XLALFITSFileOpenRead( uvar->ckpt_output_file ), errnum );
-    if ( errnum == XLAL_ENOENT ) {
-      LogPrintf( LOG_NORMAL, "Output checkpoint file '%s' does not exist; no checkpoint will be loaded\n", uvar->ckpt_output_file );
+    // Create arrays to store the appropriate parameter-space metrics for each tiling
+    gsl_matrix *XLAL_INIT_DECL( rssky_metric, [ntiles] );
+    SuperskyTransformData *XLAL_INIT_DECL( rssky_transf, [ntiles] );
+    for ( size_t i = 0; i < nsegments; ++i ) {
+      rssky_metric[i] = metrics->coh_rssky_metric[i];
+      rssky_transf[i] = metrics->coh_rssky_transf[i];
+    }
+    rssky_metric[isemi] = metrics->semi_rssky_metric;
+    rssky_transf[isemi] = metrics->semi_rssky_transf;
+
+    // Create arrays to store the range of physical coordinates covered by each tiling
+    const PulsarDopplerParams *XLAL_INIT_DECL( min_phys, [ntiles] );
+    const PulsarDopplerParams *XLAL_INIT_DECL( max_phys, [ntiles] );
+
+    //
+    // Set up semicoherent lattice tiling
+    //
+
+    // Set sky semicoherent parameter-space bounds
+    // - Compute area of sky semicoherent parameter space for later output
+    double semi_sky_area = 0.0;
+    if ( UVAR_SET( sky_patch_count ) ) {
+      XLAL_CHECK_MAIN( XLALSetSuperskyEqualAreaSkyBounds( tiling[isemi], rssky_metric[isemi], semi_max_mismatch, uvar->sky_patch_count, uvar->sky_patch_index ) == XLAL_SUCCESS, XLAL_EFUNC );
+      LogPrintf( LOG_NORMAL, "Search sky parameter space sky patch = %u of %u\n", uvar->sky_patch_index, uvar->sky_patch_count );
+      semi_sky_area = 4.0 * LAL_PI / uvar->sky_patch_count;
     } else {
-      XLAL_CHECK_MAIN( errnum == 0 && file != NULL, XLAL_EFUNC );
-      LogPrintf( LOG_NORMAL, "Output checkpoint file '%s' exists; checkpoint will be loaded\n", uvar->ckpt_output_file );
+      XLAL_CHECK_MAIN( XLALSetSuperskyPhysicalSkyBounds( tiling[isemi], rssky_metric[isemi], rssky_transf[isemi], uvar->alpha[0], uvar->alpha[1], uvar->delta[0], uvar->delta[1] ) == XLAL_SUCCESS, XLAL_EFUNC );
+      LogPrintf( LOG_NORMAL, "Search sky parameter space right ascension = [%.15g, %.15g] rad\n", uvar->alpha[0], uvar->alpha[1] );
+      LogPrintf( LOG_NORMAL, "Search sky parameter space declination = [%.15g, %.15g] rad\n", uvar->delta[0], uvar->delta[1] );
+      semi_sky_area = ( uvar->alpha[1] - uvar->alpha[0] ) * ( sin( uvar->delta[1] ) - sin( uvar->delta[0] ) );
+    }
 
-      // Read number of times output results have been restored from a checkpoint
-      XLAL_CHECK_MAIN( XLALFITSHeaderReadUINT4( file, "ckptcnt", &ckpt_output_count ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK_MAIN( ckpt_output_count > 0, XLAL_EIO, "Invalid output checkpoint file '%s'", uvar->ckpt_output_file );
+    // Set frequency/spindown semicoherent parameter-space bounds
+    XLAL_CHECK_MAIN( XLALSetSuperskyPhysicalSpinBound( tiling[isemi], rssky_transf[isemi], 0, band_freq[0], band_freq[1] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    LogPrintf( LOG_NORMAL, "Search frequency parameter space = [%.15g, %.15g] Hz\n", band_freq[0], band_freq[1] );
+    for ( size_t s = 1; s <= nmetricspins; ++s ) {
+      XLAL_CHECK_MAIN( XLALSetSuperskyPhysicalSpinBound( tiling[isemi], rssky_transf[isemi], s, uvarspins[s-1][0], uvarspins[s-1][1] ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( XLALSetSuperskyPhysicalSpinBoundPadding( tiling[isemi], rssky_transf[isemi], s, !uvar->strict_spindown_bounds ) == XLAL_SUCCESS, XLAL_EFUNC );
+      LogPrintf( LOG_NORMAL, "Search %zu-order spindown parameter space = [%.15g, %.15g] Hz/s^%zu %s padding\n", s, uvarspins[s-1][0], uvarspins[s-1][1], s, uvar->strict_spindown_bounds ? "without" : "with" );
+    }
 
-      // Read output results
-      XLAL_CHECK_MAIN( XLALWeaveOutputResultsReadAppend( file, &out, 0 ) == XLAL_SUCCESS, XLAL_EFUNC, "Invalid output checkpoint file '%s'", uvar->ckpt_output_file );
+    // Add random offsets to physical origin of semicoherent lattice tiling, if requested
+    if ( UVAR_SET( lattice_rand_offset ) ) {
+      XLAL_CHECK_MAIN( XLALSetLatticeTilingRandomOriginOffsets( tiling[isemi], rand_par ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
 
-      // Restore state of main loop iterator
-      XLAL_CHECK_MAIN( XLALWeaveSearchIteratorRestore( main_loop_itr, file ) == XLAL_SUCCESS, XLAL_EFUNC, "Invalid output checkpoint file '%s'", uvar->ckpt_output_file );
+    // Set semicoherent parameter-space lattice and metric
+    XLAL_CHECK_MAIN( XLALSetTilingLatticeAndMetric( tiling[isemi], uvar->lattice, rssky_metric[isemi], semi_max_mismatch ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-      // Close output checkpoint file
-      XLALFITSFileClose( file );
-      LogPrintf( LOG_NORMAL, "Closed output checkpoint file '%s'\n", uvar->ckpt_output_file );
+    // Print number of (tiled) parameter-space dimensions
+    LogPrintf( LOG_NORMAL, "Number of (tiled) parameter-space dimensions = %zu (%zu)\n", ndim, XLALTiledLatticeTilingDimensions( tiling[isemi] ) );
+
+    // Register callback to compute range of physical coordinates covered by semicoherent parameter space
+    XLAL_CHECK_MAIN( XLALRegisterSuperskyLatticePhysicalRangeCallback( tiling[isemi], rssky_transf[isemi], &min_phys[isemi], &max_phys[isemi] ) == XLAL_SUCCESS, XLAL_EFUNC );
 
+    // Register callbacks to compute, for each coherent tiling, range of coherent reduced supersky coordinates which enclose semicoherent parameter space
+    // - Arrays are of length 'ntiles' since 'ncohtiles' will be zero for a fully-coherent search
+    const gsl_vector *XLAL_INIT_DECL( coh_min_rssky, [ntiles] );
+    const gsl_vector *XLAL_INIT_DECL( coh_max_rssky, [ntiles] );
+    for ( size_t i = 0; i < ncohtiles; ++i ) {
+      XLAL_CHECK_MAIN( XLALRegisterSuperskyLatticeSuperskyRangeCallback( tiling[isemi], rssky_transf[isemi], rssky_transf[i], &coh_min_rssky[i], &coh_max_rssky[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
     }
 
-  }
+    // Iterate over semicoherent tiling and perform callback actions
+    LogPrintf( LOG_NORMAL, "Setting up semicoherent lattice tiling ...\n" );
+    XLAL_CHECK_MAIN( XLALPerformLatticeTilingCallbacks( tiling[isemi] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    LogPrintf( LOG_NORMAL, "Finished setting up semicoherent lattice tiling\n" );
 
-  // Start timing main search loop
-  XLAL_CHECK_MAIN( XLALWeaveSearchTimingStart( tim ) == XLAL_SUCCESS, XLAL_EFUNC );
+    // Output number of points in semicoherent tiling
+    {
+      const LatticeTilingStats *stats = XLALLatticeTilingStatistics( tiling[isemi], ndim - 1 );
+      XLAL_CHECK_MAIN( stats != NULL, XLAL_EFUNC );
+      LogPrintf( LOG_NORMAL, "Number of semicoherent templates = %" LAL_UINT8_FORMAT "\n", stats->total_points );
+    }
 
-  // Elapsed wall time at which search was last checkpointed
-  double wall_ckpt_elapsed = 0;
+    // Get frequency spacing used by parameter-space tiling
+    // - XLALEqualizeReducedSuperskyMetricsFreqSpacing() ensures this is the same for all segments
+    const double dfreq = XLALLatticeTilingStepSize( tiling[isemi], ndim - 1 );
 
-  // Elapsed wall time at which progress was last printed, and interval at which to print progress
-  double wall_prog_elapsed = 0;
-  double wall_prog_period = 5.0;
+    //
+    // Set up coherent lattice tilings
+    //
+    LogPrintf( LOG_NORMAL, "Setting up coherent lattice tilings ...\n" );
+    for ( size_t i = 0; i < ncohtiles; ++i ) {
 
-  // Whether to print predicted remaining time, and previous prediction for total elapsed time
-  BOOLEAN wall_prog_remain_print = 0;
-  double wall_prog_total_prev = 0;
+      // Set coherent parameter-space bounds which enclose semicoherent parameter space
+      XLAL_CHECK_MAIN( XLALSetSuperskyRangeBounds( tiling[i], coh_min_rssky[i], coh_max_rssky[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-  // Print initial progress
-  LogPrintf( LOG_NORMAL, "Starting main loop at %.3g%% complete, peak memory %.1fMB\n", XLALWeaveSearchIteratorProgress( main_loop_itr ), XLALGetPeakHeapUsageMB() );
+      // Add random offsets to physical origin of coherent lattice tiling, if requested
+      if ( UVAR_SET( lattice_rand_offset ) ) {
+        XLAL_CHECK_MAIN( XLALSetLatticeTilingRandomOriginOffsets( tiling[i], rand_par ) == XLAL_SUCCESS, XLAL_EFUNC );
+      }
 
-  // Begin main loop
-  BOOLEAN search_complete = 0;
-  while ( !search_complete ) {
+      // Ensure that coherent and semicoherent lattice tilings have the same tiled/non-tiled dimensions
+      XLAL_CHECK_MAIN( XLALSetTiledLatticeDimensionsFromTiling( tiling[i], tiling[isemi] ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OTHER, WEAVE_SEARCH_TIMING_ITER ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Get next semicoherent frequency block
-    // - Exit main loop if iteration is complete
-    // - Expire cache items if requested by iterator
-    BOOLEAN expire_cache = 0;
-    UINT8 semi_index = 0;
-    const gsl_vector *semi_rssky = NULL;
-    INT4 semi_left = 0;
-    INT4 semi_right = 0;
-    UINT4 freq_partition_index = 0;
-    XLAL_CHECK( XLALWeaveSearchIteratorNext( main_loop_itr, &search_complete, &expire_cache, &semi_index, &semi_rssky, &semi_left, &semi_right, &freq_partition_index ) == XLAL_SUCCESS, XLAL_EFUNC );
-    if ( search_complete ) {
-      XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_ITER, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
-      break;
-    } else if ( expire_cache ) {
-      for ( size_t i = 0; i < nsegments; ++i ) {
-        XLAL_CHECK_MAIN( XLALWeaveCacheExpire( coh_cache[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
-      }
-    }
+      // Set coherent parameter-space lattice and metric
+      XLAL_CHECK_MAIN( XLALSetTilingLatticeAndMetric( tiling[i], uvar->lattice, rssky_metric[i], coh_max_mismatch ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_ITER, WEAVE_SEARCH_TIMING_QUERY ) == XLAL_SUCCESS, XLAL_EFUNC );
+      // Register callback to compute range of physical coordinates covered by coherent parameter space
+      XLAL_CHECK_MAIN( XLALRegisterSuperskyLatticePhysicalRangeCallback( tiling[i], rssky_transf[i], &min_phys[i], &max_phys[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-    // Initialise cache queries
-    XLAL_CHECK_MAIN( XLALWeaveCacheQueriesInit( queries, semi_index, semi_rssky, semi_left, semi_right, freq_partition_index ) == XLAL_SUCCESS, XLAL_EFUNC );
+      // Iterate over coherent tiling and perform callback actions
+      XLAL_CHECK_MAIN( XLALPerformLatticeTilingCallbacks( tiling[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-    // Query for coherent results for each segment
-    for ( size_t i = 0; i < nsegments; ++i ) {
-      XLAL_CHECK_MAIN( XLALWeaveCacheQuery( coh_cache[i], queries, i ) == XLAL_SUCCESS, XLAL_EFUNC );
     }
-
-    // Finalise cache queries
-    PulsarDopplerParams XLAL_INIT_DECL( semi_phys );
-    UINT4 semi_nfreqs = 0;
-    XLAL_CHECK_MAIN( XLALWeaveCacheQueriesFinal( queries, &semi_phys, &semi_nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
-    if ( semi_nfreqs == 0 ) {
-      XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_QUERY, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
-      continue;
+    LogPrintf( LOG_NORMAL, "Finished setting up coherent lattice tilings\n" );
+
+    // Load input data required for computing coherent results
+    const LALStringVector *sft_noise_sqrtSX = UVAR_SET( sft_noise_sqrtSX ) ? uvar->sft_noise_sqrtSX : NULL;
+    const LALStringVector *Fstat_assume_sqrtSX = UVAR_SET( Fstat_assume_sqrtSX ) ? uvar->Fstat_assume_sqrtSX : NULL;
+    // - Segments 'i' with the same 'i % Fstat_threads' are always handled by the same thread in
+    //   the main loop, and so share an F-statistic workspace (via 'prevInput'), since they will
+    //   never compute F-statistics concurrently
+    const UINT4 Fstat_threads = uvar->Fstat_threads;
+    FstatInput *XLAL_INIT_DECL( Fstat_prev_input, [Fstat_threads] );
+    LogPrintf( LOG_NORMAL, "Loading input data for coherent results ...\n" );
+    for ( size_t i = 0; i < nsegments; ++i ) {
+      Fstat_opt_args.prevInput = Fstat_prev_input[i % Fstat_threads];
+      statistics_params->coh_input[i] = XLALWeaveCohInputCreate( setup.detectors, simulation_level, sft_catalog, i, &setup.segments->segs[i], min_phys[i], max_phys[i], dfreq, setup.ephemerides, sft_noise_sqrtSX, Fstat_assume_sqrtSX, &Fstat_opt_args, statistics_params, 0 );
+      XLAL_CHECK_MAIN( statistics_params->coh_input[i] != NULL, XLAL_EFUNC );
+      Fstat_prev_input[i % Fstat_threads] = Fstat_opt_args.prevInput;
     }
+    statistics_params->ref_time = setup.ref_time;
 
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_QUERY, WEAVE_SEARCH_TIMING_COH ) == XLAL_SUCCESS, XLAL_EFUNC );
+    LogPrintf( LOG_NORMAL, "Finished loading input data for coherent results\n" );
 
-    // Retrieve coherent results from each segment
-    const WeaveCohResults *XLAL_INIT_DECL( coh_res, [nsegments] );
-    UINT8 XLAL_INIT_DECL( coh_index, [nsegments] );
-    UINT4 XLAL_INIT_DECL( coh_offset, [nsegments] );
+    // Create caches to store intermediate results from coherent parameter-space tilings
+    // - If no interpolation, caching is not required so reduce maximum cache size to 1
+    WeaveCache *XLAL_INIT_DECL( coh_cache, [nsegments] );
     for ( size_t i = 0; i < nsegments; ++i ) {
-      XLAL_CHECK_MAIN( XLALWeaveCacheRetrieve( coh_cache[i], queries, i, &coh_res[i], &coh_index[i], &coh_offset[i], tim ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK_MAIN( coh_res[i] != NULL, XLAL_EFUNC );
+      const size_t cache_max_size = interpolation ? uvar->cache_max_size : 1;
+      const BOOLEAN cache_all_gc = interpolation ? uvar->cache_all_gc : 0;
+      const char *cache_spill_dir = interpolation ? uvar->cache_spill_dir : NULL;
+      coh_cache[i] = XLALWeaveCacheCreate( tiling[i], interpolation, rssky_transf[i], rssky_transf[isemi], statistics_params->coh_input[i], cache_max_size, cache_all_gc, cache_spill_dir );
+      XLAL_CHECK_MAIN( coh_cache[i] != NULL, XLAL_EFUNC );
     }
 
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_COH, WEAVE_SEARCH_TIMING_SEMISEG ) == XLAL_SUCCESS, XLAL_EFUNC );
+    ////////// Perform search //////////
 
-    // Initialise semicoherent results
-    XLAL_CHECK_MAIN( XLALWeaveSemiResultsInit( &semi_res, simulation_level, ndetectors, nsegments, semi_index, &semi_phys, dfreq, semi_nfreqs, statistics_params ) == XLAL_SUCCESS, XLAL_EFUNC );
+    // Create iterator over the main loop search parameter space
+    WeaveSearchIterator *main_loop_itr = XLALWeaveMainLoopSearchIteratorCreate( tiling[isemi], uvar->freq_partitions, uvar->f1dot_partitions );
+    XLAL_CHECK_MAIN( main_loop_itr != NULL, XLAL_EFUNC );
 
-    // Add coherent results to semicoherent results
-    for ( size_t i = 0; i < nsegments; ++i ) {
-      XLAL_CHECK_MAIN( XLALWeaveSemiResultsAdd( semi_res, coh_res[i], coh_index[i], coh_offset[i], tim ) == XLAL_SUCCESS, XLAL_EFUNC );
-    }
+    // Create storage for cache queries for coherent results in each segment
+    WeaveCacheQueries *queries = XLALWeaveCacheQueriesCreate( tiling[isemi], rssky_transf[isemi], dfreq, nsegments, uvar->freq_partitions );
+    XLAL_CHECK_MAIN( queries != NULL, XLAL_EFUNC );
 
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_SEMISEG, WEAVE_SEARCH_TIMING_SEMI ) == XLAL_SUCCESS, XLAL_EFUNC );
+    // Pointer to final semicoherent results
+    WeaveSemiResults *semi_res = NULL;
 
-    // Compute all toplist-ranking semicoherent results
-    XLAL_CHECK_MAIN( XLALWeaveSemiResultsComputeMain( semi_res, tim ) == XLAL_SUCCESS, XLAL_EFUNC );
+    // Create output results structure
+    WeaveOutputResults *out = XLALWeaveOutputResultsCreate( &setup.ref_time, ninputspins, statistics_params, uvar->toplist_limit, uvar->toplist_tmpl_idx );
+    XLAL_CHECK_MAIN( out != NULL, XLAL_EFUNC );
 
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_SEMI, WEAVE_SEARCH_TIMING_OUTPUT ) == XLAL_SUCCESS, XLAL_EFUNC );
+    // Write toplist items to runs on disk, if requested
+    if ( UVAR_SET( toplist_run_dir ) ) {
+      XLAL_CHECK_MAIN( XLALWeaveOutputResultsSetToplistRuns( out, uvar->toplist_run_dir, uvar->toplist_run_limit ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
 
-    // Add semicoherent results to output
-    XLAL_CHECK_MAIN( XLALWeaveOutputResultsAdd( out, semi_res, semi_nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
+    // Create search timing structure
+    WeaveSearchTiming *tim = XLALWeaveSearchTimingCreate( uvar->time_search, statistics_params );
+    XLAL_CHECK_MAIN( tim != NULL, XLAL_EFUNC );
 
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OUTPUT, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
+    // Number of times output results have been restored from a checkpoint
+    UINT4 ckpt_output_count = 0;
 
-    // Main iterator percentage complete
-    const REAL4 prog_per_cent = XLALWeaveSearchIteratorProgress( main_loop_itr );
+    // Try to restore output results from a checkpoint file, if given
+    if ( ckpt_output_file != NULL ) {
 
-    // Current elapsed wall and CPU times
-    double wall_elapsed = 0, cpu_elapsed = 0;
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingElapsed( tim, &wall_elapsed, &cpu_elapsed ) == XLAL_SUCCESS, XLAL_EFUNC );
+      // Try to open output checkpoint file
+      LogPrintf( LOG_NORMAL, "Trying to open output checkpoint file '%s' for reading ...\n", ckpt_output_file );
+      int errnum = 0;
+      FITSFile *file = NULL;
+      XLAL_TRY( file = XLALFITSFileOpenRead( ckpt_output_file ), errnum );
+      if ( errnum == XLAL_ENOENT ) {
+        LogPrintf( LOG_NORMAL, "Output checkpoint file '%s' does not exist; no checkpoint will be loaded\n", ckpt_output_file );
+      } else {
+        XLAL_CHECK_MAIN( errnum == 0 && file != NULL, XLAL_EFUNC );
+        LogPrintf( LOG_NORMAL, "Output checkpoint file '%s' exists; checkpoint will be loaded\n", ckpt_output_file );
 
-    // Print iteration progress, if required
-    if ( wall_elapsed - wall_prog_elapsed >= wall_prog_period ) {
+        // Read number of times output results have been restored from a checkpoint
+        XLAL_CHECK_MAIN( XLALFITSHeaderReadUINT4( file, "ckptcnt", &ckpt_output_count ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLAL_CHECK_MAIN( ckpt_output_count > 0, XLAL_EIO, "Invalid output checkpoint file '%s'", ckpt_output_file );
 
-      // Print progress
-      LogPrintf( LOG_NORMAL, "%s at %.3g%% complete", simulation_level & WEAVE_SIMULATE ? "Simulation" : "Search", prog_per_cent );
+        // Read output results
+        XLAL_CHECK_MAIN( XLALWeaveOutputResultsReadAppend( file, &out, 0 ) == XLAL_SUCCESS, XLAL_EFUNC, "Invalid output checkpoint file '%s'", ckpt_output_file );
 
-      // Print elapsed time
-      LogPrintfVerbatim( LOG_NORMAL, ", elapsed %.1f sec", wall_elapsed );
+        // Restore state of main loop iterator
+        XLAL_CHECK_MAIN( XLALWeaveSearchIteratorRestore( main_loop_itr, file ) == XLAL_SUCCESS, XLAL_EFUNC, "Invalid output checkpoint file '%s'", ckpt_output_file );
+
+        // Close output checkpoint file
+        XLALFITSFileClose( file );
+        LogPrintf( LOG_NORMAL, "Closed output checkpoint file '%s'\n", ckpt_output_file );
 
-      // Print remaining time, if it can be reliably predicted
-      const double wall_prog_remain = XLALWeaveSearchIteratorRemainingTime( main_loop_itr, wall_elapsed );
-      const double wall_prog_total = wall_elapsed + wall_prog_remain;
-      if ( wall_prog_remain_print || fabs( wall_prog_total - wall_prog_total_prev ) <= 0.1 * wall_prog_total_prev ) {
-        LogPrintfVerbatim( LOG_NORMAL, ", remaining ~%.1f sec", wall_prog_remain );
-        wall_prog_remain_print = 1;   // Always print remaining time once it can be reliably predicted
-      } else {
-        wall_prog_total_prev = wall_prog_total;
       }
 
-      // Print CPU usage
-      LogPrintfVerbatim( LOG_NORMAL, ", CPU %.1f%%", 100.0 * cpu_elapsed / wall_elapsed );
+    }
+
+    // Start timing main search loop
+    XLAL_CHECK_MAIN( XLALWeaveSearchTimingStart( tim ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-      // Print memory usage
-      LogPrintfVerbatim( LOG_NORMAL, ", peak memory %.1fMB", XLALGetPeakHeapUsageMB() );
+    // Elapsed wall time at which search was last checkpointed
+    double wall_ckpt_elapsed = 0;
 
-      // Finish progress printing
-      LogPrintfVerbatim( LOG_NORMAL, "\n" );
+    // Elapsed wall time at which progress was last printed, and interval at which to print progress
+    double wall_prog_elapsed = 0;
+    double wall_prog_period = 5.0;
 
-      // Update elapsed wall time at which progress was last printed, and increase interval at which to print progress
-      wall_prog_elapsed = wall_elapsed;
-      wall_prog_period = GSL_MIN( 1200, wall_prog_period * 1.5 );
+    // Whether to print predicted remaining time, and previous prediction for total elapsed time
+    BOOLEAN wall_prog_remain_print = 0;
+    double wall_prog_total_prev = 0;
 
+    // Initialise lookup tables used by F-statistic computation before any threads are started
+    if ( Fstat_threads > 1 ) {
+      XLALSinCosLUTInit();
+      LogPrintf( LOG_NORMAL, "Computing coherent results for %u segments using %u threads\n", nsegments, Fstat_threads );
     }
 
-    // Checkpoint output results, if required
-    if ( UVAR_SET( ckpt_output_file ) ) {
+    // Print initial progress
+    LogPrintf( LOG_NORMAL, "Starting main loop at %.3g%% complete, peak memory %.1fMB\n", XLALWeaveSearchIteratorProgress( main_loop_itr ), XLALGetPeakHeapUsageMB() );
+
+    // Begin main loop
+    search_complete = 0;
+    while ( !search_complete ) {
 
       // Switch timing section
-      XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OTHER, WEAVE_SEARCH_TIMING_CKPT ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OTHER, WEAVE_SEARCH_TIMING_ITER ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // Get next semicoherent frequency block
+      // - Exit main loop if iteration is complete
+      // - Expire cache items if requested by iterator
+      BOOLEAN expire_cache = 0;
+      UINT8 semi_index = 0;
+      const gsl_vector *semi_rssky = NULL;
+      INT4 semi_left = 0;
+      INT4 semi_right = 0;
+      UINT4 freq_partition_index = 0;
+      XLAL_CHECK( XLALWeaveSearchIteratorNext( main_loop_itr, &search_complete, &expire_cache, &semi_index, &semi_rssky, &semi_left, &semi_right, &freq_partition_index ) == XLAL_SUCCESS, XLAL_EFUNC );
+      if ( search_complete ) {
+        XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_ITER, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
+        break;
+      } else if ( expire_cache ) {
+        for ( size_t i = 0; i < nsegments; ++i ) {
+          XLAL_CHECK_MAIN( XLALWeaveCacheExpire( coh_cache[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+        }
+      }
 
-      // Decide whether to checkpoint output results
-      const BOOLEAN do_ckpt_output_period = UVAR_SET( ckpt_output_period ) && wall_elapsed - wall_ckpt_elapsed >= uvar->ckpt_output_period;
-      const BOOLEAN do_ckpt_output_exit = UVAR_SET( ckpt_output_exit ) && prog_per_cent >= 100.0 * uvar->ckpt_output_exit;
-      if ( do_ckpt_output_period || do_ckpt_output_exit ) {
+      // Switch timing section
+      XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_ITER, WEAVE_SEARCH_TIMING_QUERY ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-        // Open output checkpoint file
-        FITSFile *file = XLALFITSFileOpenWrite( uvar->ckpt_output_file );
-        XLAL_CHECK_MAIN( file != NULL, XLAL_EFUNC );
-        XLAL_CHECK_MAIN( XLALFITSFileWriteVCSInfo( file, lalAppsVCSInfoList ) == XLAL_SUCCESS, XLAL_EFUNC );
-        XLAL_CHECK_MAIN( XLALFITSFileWriteUVarCmdLine( file ) == XLAL_SUCCESS, XLAL_EFUNC );
+      // Initialise cache queries
+      XLAL_CHECK_MAIN( XLALWeaveCacheQueriesInit( queries, semi_index, semi_rssky, semi_left, semi_right, freq_partition_index ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-        // Write number of times output results have been restored from a checkpoint
-        ++ckpt_output_count;
-        XLAL_CHECK_MAIN( XLALFITSHeaderWriteUINT4( file, "ckptcnt", ckpt_output_count, "number of checkpoints" ) == XLAL_SUCCESS, XLAL_EFUNC );
+      // Query for coherent results for each segment
+      for ( size_t i = 0; i < nsegments; ++i ) {
+        XLAL_CHECK_MAIN( XLALWeaveCacheQuery( coh_cache[i], queries, i ) == XLAL_SUCCESS, XLAL_EFUNC );
+      }
 
-        // Write output results
-        XLAL_CHECK_MAIN( XLALWeaveOutputResultsWrite( file, out ) == XLAL_SUCCESS, XLAL_EFUNC );
+      // Finalise cache queries
+      PulsarDopplerParams XLAL_INIT_DECL( semi_phys );
+      UINT4 semi_nfreqs = 0;
+      XLAL_CHECK_MAIN( XLALWeaveCacheQueriesFinal( queries, &semi_phys, &semi_nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
+      if ( semi_nfreqs == 0 ) {
+        XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_QUERY, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
+        continue;
+      }
 
-        // Save state of main loop iterator
-        XLAL_CHECK_MAIN( XLALWeaveSearchIteratorSave( main_loop_itr, file ) == XLAL_SUCCESS, XLAL_EFUNC );
+      // Switch timing section
+      XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_QUERY, WEAVE_SEARCH_TIMING_COH ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // Retrieve coherent results from each segment
+      // - Each segment has its own cache and F-statistic input data, so results for different
+      //   segments may be retrieved concurrently
+      // - Segments 'i' with the same 'i % Fstat_threads' share an F-statistic workspace, so each
+      //   such group of segments is handled by a single thread; this holds even if OpenMP
+      //   provides fewer than 'Fstat_threads' threads, in which case some threads take several groups
+      // - Search timing is not thread-safe, and is only collected when 'Fstat_threads' is 1
+      const WeaveCohResults *XLAL_INIT_DECL( coh_res, [nsegments] );
+      UINT8 XLAL_INIT_DECL( coh_index, [nsegments] );
+      UINT4 XLAL_INIT_DECL( coh_offset, [nsegments] );
+      int XLAL_INIT_DECL( coh_errnum, [nsegments] );
+      WeaveSearchTiming *coh_tim = ( Fstat_threads > 1 ) ? NULL : tim;
+#pragma omp parallel num_threads(Fstat_threads) if(Fstat_threads > 1)
+      {
+#if defined(_OPENMP)
+        const UINT4 thread_num = omp_get_thread_num();
+        const UINT4 num_threads = omp_get_num_threads();
+#else
+        const UINT4 thread_num = 0;
+        const UINT4 num_threads = 1;
+#endif
+        for ( size_t g = thread_num; g < Fstat_threads; g += num_threads ) {
+          for ( size_t i = g; i < nsegments; i += Fstat_threads ) {
+            if ( XLALWeaveCacheRetrieve( coh_cache[i], queries, i, &coh_res[i], &coh_index[i], &coh_offset[i], coh_tim ) != XLAL_SUCCESS ) {
+              coh_errnum[i] = xlalErrno;
+              XLALClearErrno();
+            }
+          }
+        }
+      }
+      for ( size_t i = 0; i < nsegments; ++i ) {
+        XLAL_CHECK_MAIN( coh_errnum[i] == 0, coh_errnum[i], "Failed to retrieve coherent results for segment %zu", i );
+        XLAL_CHECK_MAIN( coh_res[i] != NULL, XLAL_EFUNC );
+      }
 
-        // Close output checkpoint file
-        XLALFITSFileClose( file );
+      // Switch timing section
+      XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_COH, WEAVE_SEARCH_TIMING_SEMISEG ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-        // Print progress
-        LogPrintf( LOG_NORMAL, "Wrote output checkpoint to file '%s' at %.3g%% complete, elapsed %.1f sec\n", uvar->ckpt_output_file, prog_per_cent, wall_elapsed );
+      // Initialise semicoherent results
+      XLAL_CHECK_MAIN( XLALWeaveSemiResultsInit( &semi_res, simulation_level, ndetectors, nsegments, semi_index, &semi_phys, dfreq, semi_nfreqs, statistics_params ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // Add coherent results to semicoherent results
+      for ( size_t i = 0; i < nsegments; ++i ) {
+        XLAL_CHECK_MAIN( XLALWeaveSemiResultsAdd( semi_res, coh_res[i], coh_index[i], coh_offset[i], tim ) == XLAL_SUCCESS, XLAL_EFUNC );
+      }
+
+      // Switch timing section
+      XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_SEMISEG, WEAVE_SEARCH_TIMING_SEMI ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-        // Exit main loop, if checkpointing was triggered by 'do_ckpt_output_exit'
-        if ( do_ckpt_output_exit ) {
-          LogPrintf( LOG_NORMAL, "Exiting main seach loop after writing output checkpoint\n" );
-          XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_CKPT, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
-          break;
+      // Compute all toplist-ranking semicoherent results
+      XLAL_CHECK_MAIN( XLALWeaveSemiResultsComputeMain( semi_res, tim ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // Switch timing section
+      XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_SEMI, WEAVE_SEARCH_TIMING_OUTPUT ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // Add semicoherent results to output
+      XLAL_CHECK_MAIN( XLALWeaveOutputResultsAdd( out, semi_res, semi_nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // Switch timing section
+      XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OUTPUT, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // Main iterator percentage complete
+      const REAL4 prog_per_cent = XLALWeaveSearchIteratorProgress( main_loop_itr );
+
+      // Current elapsed wall and CPU times
+      double wall_elapsed = 0, cpu_elapsed = 0;
+      XLAL_CHECK_MAIN( XLALWeaveSearchTimingElapsed( tim, &wall_elapsed, &cpu_elapsed ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // Print iteration progress, if required
+      if ( wall_elapsed - wall_prog_elapsed >= wall_prog_period ) {
+
+        // Print progress
+        LogPrintf( LOG_NORMAL, "%s at %.3g%% complete", simulation_level & WEAVE_SIMULATE ? "Simulation" : "Search", prog_per_cent );
+
+        // Print elapsed time
+        LogPrintfVerbatim( LOG_NORMAL, ", elapsed %.1f sec", wall_elapsed );
+
+        // Print remaining time, if it can be reliably predicted
+        const double wall_prog_remain = XLALWeaveSearchIteratorRemainingTime( main_loop_itr, wall_elapsed );
+        const double wall_prog_total = wall_elapsed + wall_prog_remain;
+        if ( wall_prog_remain_print || fabs( wall_prog_total - wall_prog_total_prev ) <= 0.1 * wall_prog_total_prev ) {
+          LogPrintfVerbatim( LOG_NORMAL, ", remaining ~%.1f sec", wall_prog_remain );
+          wall_prog_remain_print = 1;   // Always print remaining time once it can be reliably predicted
+        } else {
+          wall_prog_total_prev = wall_prog_total;
         }
 
-        // Update elapsed wall time at which search was last checkpointed
-        wall_ckpt_elapsed = wall_elapsed;
+        // Print CPU usage
+        LogPrintfVerbatim( LOG_NORMAL, ", CPU %.1f%%", 100.0 * cpu_elapsed / wall_elapsed );
+
+        // Print memory usage
+        LogPrintfVerbatim( LOG_NORMAL, ", peak memory %.1fMB", XLALGetPeakHeapUsageMB() );
+
+        // Finish progress printing
+        LogPrintfVerbatim( LOG_NORMAL, "\n" );
+
+        // Update elapsed wall time at which progress was last printed, and increase interval at which to print progress
+        wall_prog_elapsed = wall_elapsed;
+        wall_prog_period = GSL_MIN( 1200, wall_prog_period * 1.5 );
 
       }
 
-      // Switch timing section
-      XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_CKPT, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
+      // Checkpoint output results, if required
+      if ( ckpt_output_file != NULL ) {
 
-    }
+        // Switch timing section
+        XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OTHER, WEAVE_SEARCH_TIMING_CKPT ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-  }   // End of main loop
+        // Decide whether to checkpoint output results
+        const BOOLEAN do_ckpt_output_period = UVAR_SET( ckpt_output_period ) && wall_elapsed - wall_ckpt_elapsed >= uvar->ckpt_output_period;
+        const BOOLEAN do_ckpt_output_exit = UVAR_SET( ckpt_output_exit ) && prog_per_cent >= 100.0 * uvar->ckpt_output_exit;
+        if ( do_ckpt_output_period || do_ckpt_output_exit ) {
 
-  // Clear all cache items from memory
-  for ( size_t i = 0; i < nsegments; ++i ) {
-    XLAL_CHECK_MAIN( XLALWeaveCacheClear( coh_cache[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
-  }
+          // Open output checkpoint file
+          FITSFile *file = XLALFITSFileOpenWrite( ckpt_output_file );
+          XLAL_CHECK_MAIN( file != NULL, XLAL_EFUNC );
+          XLAL_CHECK_MAIN( XLALFITSFileWriteVCSInfo( file, lalAppsVCSInfoList ) == XLAL_SUCCESS, XLAL_EFUNC );
+          XLAL_CHECK_MAIN( XLALFITSFileWriteUVarCmdLine( file ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-  // Print progress
-  double wall_main = 0, cpu_main = 0;
-  XLAL_CHECK_MAIN( XLALWeaveSearchTimingElapsed( tim, &wall_main, &cpu_main ) == XLAL_SUCCESS, XLAL_EFUNC );
-  LogPrintf( LOG_NORMAL, "Finished main loop at %.3g%% complete, main-loop time %.1f sec, CPU %.1f%%, peak memory %.1fMB\n", XLALWeaveSearchIteratorProgress( main_loop_itr ), wall_main, 100.0 * cpu_main / wall_main, XLALGetPeakHeapUsageMB() );
-
-  // Prepare completion-loop calculations:
-  // if any 'recalc' (= 'stage 1') statistics have been requested: we'll need 'Demod' Fstatistic setups
-  // so if the 'stage 0' calculation used Demod => nothing to do, if it used 'Resamp' then re-compute the setups
-  if ( ( uvar->recalc_statistics != WEAVE_STATISTIC_NONE ) ) {
-    statistics_params->coh_input_recalc = XLALCalloc( nsegments, sizeof( statistics_params->coh_input_recalc[0] ) );
-    XLAL_CHECK_MAIN( statistics_params->coh_input_recalc != NULL, XLAL_ENOMEM );
-    FstatOptionalArgs Fstat_opt_args_recalc = Fstat_opt_args;
-    Fstat_opt_args_recalc.FstatMethod = FMETHOD_DEMOD_BEST;
-    Fstat_opt_args_recalc.prevInput = NULL;
-    for ( size_t i = 0; i < nsegments; ++i ) {
-      statistics_params->coh_input_recalc[i] = XLALWeaveCohInputCreate( setup.detectors, simulation_level, sft_catalog, i, &setup.segments->segs[i], min_phys[i], max_phys[i], 0, setup.ephemerides, sft_noise_sqrtSX, Fstat_assume_sqrtSX, &Fstat_opt_args_recalc, statistics_params, 1 );
-      XLAL_CHECK_MAIN( statistics_params->coh_input_recalc[i] != NULL, XLAL_EFUNC );
-    }
-  }
+          // Write number of times output results have been restored from a checkpoint
+          ++ckpt_output_count;
+          XLAL_CHECK_MAIN( XLALFITSHeaderWriteUINT4( file, "ckptcnt", ckpt_output_count, "number of checkpoints" ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-  // Switch timing section
-  XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OTHER, WEAVE_SEARCH_TIMING_CMPL ) == XLAL_SUCCESS, XLAL_EFUNC );
+          // Write output results
+          XLAL_CHECK_MAIN( XLALWeaveOutputResultsWrite( file, out ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-  // Completion loop: compute all extra statistics that weren't required in the main loop
-  XLAL_CHECK_MAIN( XLALWeaveOutputResultsCompletionLoop( out ) == XLAL_SUCCESS, XLAL_EFUNC );
+          // Save state of main loop iterator
+          XLAL_CHECK_MAIN( XLALWeaveSearchIteratorSave( main_loop_itr, file ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-  // Switch timing section
-  XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_CMPL, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
+          // Close output checkpoint file
+          XLALFITSFileClose( file );
 
-  // Stop timing main search loop, and get total wall and CPU times
-  double wall_total = 0, cpu_total = 0;
-  XLAL_CHECK_MAIN( XLALWeaveSearchTimingStop( tim, &wall_total, &cpu_total ) == XLAL_SUCCESS, XLAL_EFUNC );
-  LogPrintf( LOG_NORMAL, "Finished completion-loop, total time %.1f sec, CPU %.1f%%, peak memory %.1fMB\n", wall_total, 100.0 * cpu_total / wall_total, XLALGetPeakHeapUsageMB() );
+          // Print progress
+          LogPrintf( LOG_NORMAL, "Wrote output checkpoint to file '%s' at %.3g%% complete, elapsed %.1f sec\n", ckpt_output_file, prog_per_cent, wall_elapsed );
 
-  ////////// Output search results //////////
+          // Exit main loop, if checkpointing was triggered by 'do_ckpt_output_exit'
+          if ( do_ckpt_output_exit ) {
+            LogPrintf( LOG_NORMAL, "Exiting main seach loop after writing output checkpoint\n" );
+            XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_CKPT, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
+            break;
+          }
 
-  if ( search_complete ) {
+          // Update elapsed wall time at which search was last checkpointed
+          wall_ckpt_elapsed = wall_elapsed;
 
-    // Open output file
-    LogPrintf( LOG_NORMAL, "Opening output file '%s' for writing ...\n", uvar->output_file );
-    FITSFile *file = XLALFITSFileOpenWrite( uvar->output_file );
-    XLAL_CHECK_MAIN( file != NULL, XLAL_EFUNC );
-    XLAL_CHECK_MAIN( XLALFITSFileWriteVCSInfo( file, lalAppsVCSInfoList ) == XLAL_SUCCESS, XLAL_EFUNC );
-    XLAL_CHECK_MAIN( XLALFITSFileWriteUVarCmdLine( file ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Write number of times output results were restored from a checkpoint
-    XLAL_CHECK_MAIN( XLALFITSHeaderWriteUINT4( file, "numckpt", ckpt_output_count, "number of checkpoints" ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Write list of detectors
-    XLAL_CHECK_MAIN( XLALFITSHeaderWriteStringVector( file, "detect", setup.detectors, "setup detectors" ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Write number of segments
-    XLAL_CHECK_MAIN( XLALFITSHeaderWriteUINT4( file, "nsegment", nsegments, "number of segments" ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Write frequency spacing
-    XLAL_CHECK_MAIN( XLALFITSHeaderWriteREAL8( file, "dfreq", dfreq, "frequency spacing" ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Write semicoherent parameter-space bounds
-    XLAL_CHECK_MAIN( XLALFITSHeaderWriteREAL8( file, "semiparam skyarea [sr]", semi_sky_area, "area of sky parameter space" ) == XLAL_SUCCESS, XLAL_EFUNC );
-    XLAL_CHECK_MAIN( XLALFITSHeaderWriteREAL8( file, "semiparam minfreq [Hz]", uvar->freq[0], "minimum frequency range" ) == XLAL_SUCCESS, XLAL_EFUNC );
-    XLAL_CHECK_MAIN( XLALFITSHeaderWriteREAL8( file, "semiparam maxfreq [Hz]", uvar->freq[1], "maximum frequency range" ) == XLAL_SUCCESS, XLAL_EFUNC );
-    for ( size_t s = 1; s <= ninputspins; ++s ) {
-      char keyword[64];
-      char comment[64];
-      snprintf( keyword, sizeof( keyword ), "semiparam minf%zudot [Hz/s^%zu]", s, s );
-      snprintf( comment, sizeof( comment ), "minimum %zu-order spindown range", s );
-      XLAL_CHECK_MAIN( XLALFITSHeaderWriteREAL8( file, keyword, uvarspins[s-1][0], comment ) == XLAL_SUCCESS, XLAL_EFUNC );
-      snprintf( keyword, sizeof( keyword ), "semiparam maxf%zudot [Hz/s^%zu]", s, s );
-      snprintf( comment, sizeof( comment ), "maximum %zu-order spindown range", s );
-      XLAL_CHECK_MAIN( XLALFITSHeaderWriteREAL8( file, keyword, uvarspins[s-1][1], comment ) == XLAL_SUCCESS, XLAL_EFUNC );
+        }
+
+        // Switch timing section
+        XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_CKPT, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      }
+
+    }   // End of main loop
+
+    // Clear all cache items from memory
+    for ( size_t i = 0; i < nsegments; ++i ) {
+      XLAL_CHECK_MAIN( XLALWeaveCacheClear( coh_cache[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
     }
 
-    // Write cumulative number of semicoherent templates in each dimension
-    for ( size_t i = 0; i < ndim; ++i ) {
-      char keyword[64];
-      const LatticeTilingStats *semi_stats = XLALLatticeTilingStatistics( tiling[isemi], i );
-      XLAL_CHECK_MAIN( semi_stats != NULL, XLAL_EFUNC );
-      XLAL_CHECK_MAIN( semi_stats->name != NULL, XLAL_EFUNC );
-      XLAL_CHECK_MAIN( semi_stats->total_points > 0, XLAL_EFUNC );
-      snprintf( keyword, sizeof( keyword ), "nsemitmpl %s", semi_stats->name );
-      XLAL_CHECK_MAIN( XLALFITSHeaderWriteUINT8( file, keyword, semi_stats->total_points, "cumulative number of semicoherent templates" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    // Print progress
+    double wall_main = 0, cpu_main = 0;
+    XLAL_CHECK_MAIN( XLALWeaveSearchTimingElapsed( tim, &wall_main, &cpu_main ) == XLAL_SUCCESS, XLAL_EFUNC );
+    LogPrintf( LOG_NORMAL, "Finished main loop at %.3g%% complete, main-loop time %.1f sec, CPU %.1f%%, peak memory %.1fMB\n", XLALWeaveSearchIteratorProgress( main_loop_itr ), wall_main, 100.0 * cpu_main / wall_main, XLALGetPeakHeapUsageMB() );
+
+    // Prepare completion-loop calculations:
+    // if any 'recalc' (= 'stage 1') statistics have been requested: we'll need 'Demod' Fstatistic setups
+    // so if the 'stage 0' calculation used Demod => nothing to do, if it used 'Resamp' then re-compute the setups
+    if ( ( uvar->recalc_statistics != WEAVE_STATISTIC_NONE ) ) {
+      statistics_params->coh_input_recalc = XLALCalloc( nsegments, sizeof( statistics_params->coh_input_recalc[0] ) );
+      XLAL_CHECK_MAIN( statistics_params->coh_input_recalc != NULL, XLAL_ENOMEM );
+      FstatOptionalArgs Fstat_opt_args_recalc = Fstat_opt_args;
+      Fstat_opt_args_recalc.FstatMethod = FMETHOD_DEMOD_BEST;
+      Fstat_opt_args_recalc.prevInput = NULL;
+      for ( size_t i = 0; i < nsegments; ++i ) {
+        statistics_params->coh_input_recalc[i] = XLALWeaveCohInputCreate( setup.detectors, simulation_level, sft_catalog, i, &setup.segments->segs[i], min_phys[i], max_phys[i], 0, setup.ephemerides, sft_noise_sqrtSX, Fstat_assume_sqrtSX, &Fstat_opt_args_recalc, statistics_params, 1 );
+        XLAL_CHECK_MAIN( statistics_params->coh_input_recalc[i] != NULL, XLAL_EFUNC );
+      }
     }
 
-    // Write number of computed coherent results, and number of coherent and semicoherent templates
-    UINT8 coh_nres = 0, coh_ntmpl = 0, semi_ntmpl = 0;
-    XLAL_CHECK_MAIN( XLALWeaveCacheQueriesGetCounts( queries, &coh_nres, &coh_ntmpl, &semi_ntmpl ) == XLAL_SUCCESS, XLAL_EFUNC );
-    XLAL_CHECK_MAIN( XLALFITSHeaderWriteUINT8( file, "ncohres", coh_nres, "number of computed coherent results" ) == XLAL_SUCCESS, XLAL_EFUNC );
-    XLAL_CHECK_MAIN( XLALFITSHeaderWriteUINT8( file, "ncohtpl", coh_ntmpl, "number of coherent templates" ) == XLAL_SUCCESS, XLAL_EFUNC );
-    XLAL_CHECK_MAIN( XLALFITSHeaderWriteUINT8( file, "nsemitpl", semi_ntmpl, "number of semicoherent templates" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    // Switch timing section
+    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OTHER, WEAVE_SEARCH_TIMING_CMPL ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-    // Write peak memory usage
-    XLAL_CHECK_MAIN( XLALFITSHeaderWriteREAL8( file, "peakmem [MB]", XLALGetPeakHeapUsageMB(), "peak memory usage" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    // Completion loop: compute all extra statistics that weren't required in the main loop
+    XLAL_CHECK_MAIN( XLALWeaveOutputResultsCompletionLoop( out ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-    // Write timing information
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingWriteInfo( file, tim, queries ) == XLAL_SUCCESS, XLAL_EFUNC );
+    // Switch timing section
+    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_CMPL, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-    // Write various information from coherent input data
-    XLAL_CHECK_MAIN( XLALWeaveCohInputWriteInfo( file, nsegments, statistics_params->coh_input ) == XLAL_SUCCESS, XLAL_EFUNC );
+    // Stop timing main search loop, and get total wall and CPU times
+    double wall_total = 0, cpu_total = 0;
+    XLAL_CHECK_MAIN( XLALWeaveSearchTimingStop( tim, &wall_total, &cpu_total ) == XLAL_SUCCESS, XLAL_EFUNC );
+    LogPrintf( LOG_NORMAL, "Finished completion-loop, total time %.1f sec, CPU %.1f%%, peak memory %.1fMB\n", wall_total, 100.0 * cpu_total / wall_total, XLALGetPeakHeapUsageMB() );
 
-    // Write various information from caches
-    XLAL_CHECK_MAIN( XLALWeaveCacheWriteInfo( file, nsegments, coh_cache ) == XLAL_SUCCESS, XLAL_EFUNC );
+    ////////// Output search results //////////
 
-    // Write search results, unless search is being simulated
-    if ( simulation_level == 0 ) {
-      XLAL_CHECK_MAIN( XLALWeaveOutputResultsWrite( file, out ) == XLAL_SUCCESS, XLAL_EFUNC );
-    }
+    if ( search_complete ) {
+
+      // Open output file
+      LogPrintf( LOG_NORMAL, "Opening output file '%s' for writing ...\n", output_file );
+      FITSFile *file = XLALFITSFileOpenWrite( output_file );
+      XLAL_CHECK_MAIN( file != NULL, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( XLALFITSFileWriteVCSInfo( file, lalAppsVCSInfoList ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( XLALFITSFileWriteUVarCmdLine( file ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // Write number of times output results were restored from a checkpoint
+      XLAL_CHECK_MAIN( XLALFITSHeaderWriteUINT4( file, "numckpt", ckpt_output_count, "number of checkpoints" ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // Write list of detectors
+      XLAL_CHECK_MAIN( XLALFITSHeaderWriteStringVector( file, "detect", setup.detectors, "setup detectors" ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // Write number of segments
+      XLAL_CHECK_MAIN( XLALFITSHeaderWriteUINT4( file, "nsegment", nsegments, "number of segments" ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // Write frequency spacing
+      XLAL_CHECK_MAIN( XLALFITSHeaderWriteREAL8( file, "dfreq", dfreq, "frequency spacing" ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // Write semicoherent parameter-space bounds
+      XLAL_CHECK_MAIN( XLALFITSHeaderWriteREAL8( file, "semiparam skyarea [sr]", semi_sky_area, "area of sky parameter space" ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( XLALFITSHeaderWriteREAL8( file, "semiparam minfreq [Hz]", band_freq[0], "minimum frequency range" ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( XLALFITSHeaderWriteREAL8( file, "semiparam maxfreq [Hz]", band_freq[1], "maximum frequency range" ) == XLAL_SUCCESS, XLAL_EFUNC );
+      for ( size_t s = 1; s <= ninputspins; ++s ) {
+        char keyword[64];
+        char comment[64];
+        snprintf( keyword, sizeof( keyword ), "semiparam minf%zudot [Hz/s^%zu]", s, s );
+        snprintf( comment, sizeof( comment ), "minimum %zu-order spindown range", s );
+        XLAL_CHECK_MAIN( XLALFITSHeaderWriteREAL8( file, keyword, uvarspins[s-1][0], comment ) == XLAL_SUCCESS, XLAL_EFUNC );
+        snprintf( keyword, sizeof( keyword ), "semiparam maxf%zudot [Hz/s^%zu]", s, s );
+        snprintf( comment, sizeof( comment ), "maximum %zu-order spindown range", s );
+        XLAL_CHECK_MAIN( XLALFITSHeaderWriteREAL8( file, keyword, uvarspins[s-1][1], comment ) == XLAL_SUCCESS, XLAL_EFUNC );
+      }
+
+      // Write cumulative number of semicoherent templates in each dimension
+      for ( size_t i = 0; i < ndim; ++i ) {
+        char keyword[64];
+        const LatticeTilingStats *semi_stats = XLALLatticeTilingStatistics( tiling[isemi], i );
+        XLAL_CHECK_MAIN( semi_stats != NULL, XLAL_EFUNC );
+        XLAL_CHECK_MAIN( semi_stats->name != NULL, XLAL_EFUNC );
+        XLAL_CHECK_MAIN( semi_stats->total_points > 0, XLAL_EFUNC );
+        snprintf( keyword, sizeof( keyword ), "nsemitmpl %s", semi_stats->name );
+        XLAL_CHECK_MAIN( XLALFITSHeaderWriteUINT8( file, keyword, semi_stats->total_points, "cumulative number of semicoherent templates" ) == XLAL_SUCCESS, XLAL_EFUNC );
+      }
+
+      // Write number of computed coherent results, and number of coherent and semicoherent templates
+      UINT8 coh_nres = 0, coh_ntmpl = 0, semi_ntmpl = 0;
+      XLAL_CHECK_MAIN( XLALWeaveCacheQueriesGetCounts( queries, &coh_nres, &coh_ntmpl, &semi_ntmpl ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( XLALFITSHeaderWriteUINT8( file, "ncohres", coh_nres, "number of computed coherent results" ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( XLALFITSHeaderWriteUINT8( file, "ncohtpl", coh_ntmpl, "number of coherent templates" ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( XLALFITSHeaderWriteUINT8( file, "nsemitpl", semi_ntmpl, "number of semicoherent templates" ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // Write peak memory usage
+      XLAL_CHECK_MAIN( XLALFITSHeaderWriteREAL8( file, "peakmem [MB]", XLALGetPeakHeapUsageMB(), "peak memory usage" ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // Write timing information
+      XLAL_CHECK_MAIN( XLALWeaveSearchTimingWriteInfo( file, tim, queries ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // Write various information from coherent input data
+      XLAL_CHECK_MAIN( XLALWeaveCohInputWriteInfo( file, nsegments, statistics_params->coh_input ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // Write various information from caches
+      XLAL_CHECK_MAIN( XLALWeaveCacheWriteInfo( file, nsegments, coh_cache ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // Write search results, unless search is being simulated
+      if ( simulation_level == 0 ) {
+        XLAL_CHECK_MAIN( XLALWeaveOutputResultsWrite( file, out ) == XLAL_SUCCESS, XLAL_EFUNC );
+      }
+
+      // Write various segment information from coherent input data
+      if ( uvar->segment_info ) {
+        XLAL_CHECK_MAIN( XLALWeaveCohInputWriteSegInfo( file, nsegments, statistics_params->coh_input ) == XLAL_SUCCESS, XLAL_EFUNC );
+      }
+
+      // Close output file
+      XLALFITSFileClose( file );
+      LogPrintf( LOG_NORMAL, "Closed output file '%s'\n", output_file );
 
-    // Write various segment information from coherent input data
-    if ( uvar->segment_info ) {
-      XLAL_CHECK_MAIN( XLALWeaveCohInputWriteSegInfo( file, nsegments, statistics_params->coh_input ) == XLAL_SUCCESS, XLAL_EFUNC );
     }
 
-    // Close output file
-    XLALFITSFileClose( file );
-    LogPrintf( LOG_NORMAL, "Closed output file '%s'\n", uvar->output_file );
+    ////////// Cleanup memory from this band //////////
 
-  }
+    // Cleanup memory from search timing
+    XLALWeaveSearchTimingDestroy( tim );
 
-  ////////// Cleanup memory and exit //////////
+    // Cleanup memory from output results
+    XLALWeaveOutputResultsDestroy( out );
 
-  // Cleanup memory from search timing
-  XLALWeaveSearchTimingDestroy( tim );
+    // Cleanup memory from semicoherent results
+    XLALWeaveSemiResultsDestroy( semi_res );
 
-  // Cleanup memory from output results
-  XLALWeaveOutputResultsDestroy( out );
+    // Cleanup memory from parameter-space iteration
+    XLALWeaveSearchIteratorDestroy( main_loop_itr );
 
-  // Cleanup memory from semicoherent results
-  XLALWeaveSemiResultsDestroy( semi_res );
+    // Cleanup memory from computing 'stage 0' coherent results
+    XLALWeaveCacheQueriesDestroy( queries );
+    for ( size_t i = 0; i < nsegments; ++i ) {
+      XLALWeaveCacheDestroy( coh_cache[i] );
+    }
 
-  // Cleanup memory from parameter-space iteration
-  XLALWeaveSearchIteratorDestroy( main_loop_itr );
+    // Cleanup memory from lattice tilings
+    for ( size_t i = 0; i < ntiles; ++i ) {
+      XLALDestroyLatticeTiling( tiling[i] );
+    }
+
+    // Cleanup memory from metrics of this band
+    XLALDestroySuperskyMetrics( metrics );
+
+    // Cleanup memory from output file names of this band
+    XLALFree( output_file );
+    XLALFree( ckpt_output_file );
+
+    // Stop searching bands if the search of this band was not completed, e.g. after checkpointing
+    if ( !search_complete ) {
+      break;
+    }
 
-  // Cleanup memory from computing 'stage 0' coherent results
-  XLALWeaveCacheQueriesDestroy( queries );
-  for ( size_t i = 0; i < nsegments; ++i ) {
-    XLALWeaveCacheDestroy( coh_cache[i] );
   }
 
+  ////////// Cleanup memory and exit //////////
+
   // Cleanup memory from loading input data
   XLALDestroySFTCatalog( sft_catalog );
 
-  // Cleanup memory from lattice tilings
-  for ( size_t i = 0; i < ntiles; ++i ) {
-    XLALDestroyLatticeTiling( tiling[i] );
-  }
-
   // Cleanup memory from setup data
   XLALWeaveSetupDataClear( &setup );
   XLALFree( setup_detectors_string );
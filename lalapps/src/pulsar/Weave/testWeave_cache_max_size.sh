@@ -1,4 +1,4 @@
-# Perform an interpolating search without/with a maximum cache size, and check for consistent results
+# Perform an interpolating search without/with a maximum cache size, and with a cache spill directory, and check for consistent results
 
 export LAL_FSTAT_FFT_PLAN_MODE=ESTIMATE
 
@@ -97,9 +97,35 @@ for setup in short long; do
     set +x
     echo
 
+    echo "=== Setup '${setup}': ${verb} interpolating search with a maximum cache size and a cache spill directory ==="
+    set -x
+    mkdir -p spill
+    lalapps_Weave ${weave_cache_options} --cache-spill-dir=spill --output-file=WeaveOutSpill.fits \
+        --toplists=all --toplist-limit=2321 --segment-info --setup-file=WeaveSetup.fits \
+        ${weave_sft_options} ${weave_search_options}
+    lalapps_fits_overview WeaveOutSpill.fits
+    set +x
+    echo
+
+    echo "=== Setup '${setup}': Check that with a cache spill directory number of coherent templates are equal, and number of recomputed results is reduced ==="
+    set -x
+    coh_ntmpl_spill=`lalapps_fits_header_getval "WeaveOutSpill.fits[0]" 'NCOHTPL' | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
+    expr ${coh_ntmpl_no_max} '=' ${coh_ntmpl_spill}
+    coh_nres_spill=`lalapps_fits_header_getval "WeaveOutSpill.fits[0]" 'NCOHRES' | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
+    expr ${coh_nres_spill} '<' ${coh_nres_max}
+    cache_spill_hits=`lalapps_fits_header_getval "WeaveOutSpill.fits[0]" 'CACHESPH' | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
+    expr ${cache_spill_hits} '>' 0
+    set +x
+    echo
+
     case ${setup} in
 
         short)
+            echo "=== Setup '${setup}': Compare F-statistics from lalapps_Weave with a maximum cache size without/with a cache spill directory ==="
+            set -x
+            env LAL_DEBUG_LEVEL="${LAL_DEBUG_LEVEL},info" lalapps_WeaveCompare --setup-file=WeaveSetup.fits --result-file-1=WeaveOutMax.fits --result-file-2=WeaveOutSpill.fits
+            set +x
+            echo
             echo "=== Setup '${setup}': Compare F-statistics from lalapps_Weave without/with a maximum cache size ==="
             set -x
             env LAL_DEBUG_LEVEL="${LAL_DEBUG_LEVEL},info" lalapps_WeaveCompare --setup-file=WeaveSetup.fits --result-file-1=WeaveOutNoMax.fits --result-file-2=WeaveOutMax.fits
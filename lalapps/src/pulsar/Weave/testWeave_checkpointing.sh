@@ -46,8 +46,9 @@ done
 set +x
 echo
 
-for opt in nopart freqpart f1dotpart allpart; do
+for opt in nopart freqpart f1dotpart allpart toplistruns; do
 
+    run_dir=""
     case ${opt} in
 
         nopart)
@@ -66,6 +67,11 @@ for opt in nopart freqpart f1dotpart allpart; do
             weave_part_options="--freq-partitions=2 --f1dot-partitions=2"
             ;;
 
+        toplistruns)
+            run_dir=WeaveToplistRuns
+            weave_part_options="--toplist-run-dir=${run_dir} --toplist-run-limit=50"
+            ;;
+
         *)
             echo "$0: unknown options '${opt}'"
             exit 1
@@ -76,6 +82,10 @@ for opt in nopart freqpart f1dotpart allpart; do
     echo "--- Start to first checkpoint ---"
     set -x
     rm -f WeaveCkpt.fits
+    if [ -n "${run_dir}" ]; then
+        rm -rf ${run_dir}
+        mkdir ${run_dir}
+    fi
     lalapps_Weave ${weave_part_options} --output-file=WeaveOutCkpt.fits --ckpt-output-file=WeaveCkpt.fits --ckpt-output-exit=0.22 \
         --toplists=all --toplist-limit=232 --extra-statistics="mean2F_det,sum2F_det,coh2F,coh2F_det" --setup-file=WeaveSetup.fits --sft-files='*.sft' \
         --sky-patch-count=4 --sky-patch-index=0 --freq=50/0.01 --f1dot=-1e-9,0 --semi-max-mismatch=5 --coh-max-mismatch=0.4 --recalc-statistics=all
@@ -97,6 +107,16 @@ for opt in nopart freqpart f1dotpart allpart; do
     set +x
     echo
 
+    if [ -n "${run_dir}" ]; then
+        echo "=== Options '${opt}': Check that all toplist runs were deleted once the output was written ==="
+        set -x
+        ls -l ${run_dir}
+        expr `ls ${run_dir} | wc -l` '=' 0
+        rmdir ${run_dir}
+        set +x
+        echo
+    fi
+
     echo "=== Options '${opt}': Check number of times output results have been restored from a checkpoint ==="
     set -x
     ckpt_count=`lalapps_fits_header_getval "WeaveCkpt.fits[0]" CKPTCNT | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
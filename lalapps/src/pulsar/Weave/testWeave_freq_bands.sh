@@ -0,0 +1,50 @@
+# Perform an interpolating search over two frequency bands in one process, and check for consistent
+# results with separate searches over each band
+
+export LAL_FSTAT_FFT_PLAN_MODE=ESTIMATE
+
+echo "=== Create search setup with 3 segments ==="
+set -x
+lalapps_WeaveSetup --first-segment=1122332211/90000 --segment-count=3 --detectors=H1,L1 --output-file=WeaveSetup.fits
+lalapps_fits_overview WeaveSetup.fits
+set +x
+echo
+
+echo "=== Create SFT timestamps spanning the segment list in WeaveSetup.fits ==="
+set -x
+lalapps_fits_table_list 'WeaveSetup.fits[segments][col c1=start_s; col2=end_s]' \
+    | awk '/^#/ { next } { for ( t = $1; t + 1800 <= $2 + 1; t += 2400 ) print t ".0" }' > timestamps-1.txt
+lalapps_fits_table_list 'WeaveSetup.fits[segments][col c1=start_s; col2=end_s]' \
+    | awk '/^#/ { next } { for ( t = $1 + 600; t + 1800 <= $2 + 1; t += 3000 ) print t ".0" }' > timestamps-2.txt
+set +x
+echo
+
+weave_search_options="--toplists=mean2F --toplist-limit=2321 --setup-file=WeaveSetup.fits \
+    --rand-seed=3456 --sft-timebase=1800 --sft-noise-sqrtSX=1,1 \
+    --sft-timestamps-files=timestamps-1.txt,timestamps-2.txt \
+    --alpha=1.9/1.4 --delta=-1.2/2.3 --f1dot=-1e-9,0 --semi-max-mismatch=6 --coh-max-mismatch=0.3"
+
+echo "=== Perform interpolating search over 2 frequency bands in one process ==="
+set -x
+lalapps_Weave --freq-bands=2 --output-file=WeaveOutBand%u.fits --freq=49.5/0.015625 ${weave_search_options}
+lalapps_fits_overview WeaveOutBand0.fits
+lalapps_fits_overview WeaveOutBand1.fits
+set +x
+echo
+
+echo "=== Perform interpolating searches over each frequency band separately ==="
+set -x
+lalapps_Weave --output-file=WeaveOutSingle0.fits --freq=49.5,49.5078125 ${weave_search_options}
+lalapps_fits_overview WeaveOutSingle0.fits
+lalapps_Weave --output-file=WeaveOutSingle1.fits --freq=49.5078125,49.515625 ${weave_search_options}
+lalapps_fits_overview WeaveOutSingle1.fits
+set +x
+echo
+
+for band in 0 1; do
+    echo "=== Compare F-statistics from lalapps_Weave for frequency band ${band} searched with/without --freq-bands ==="
+    set -x
+    env LAL_DEBUG_LEVEL="${LAL_DEBUG_LEVEL},info" lalapps_WeaveCompare --setup-file=WeaveSetup.fits --result-file-1=WeaveOutSingle${band}.fits --result-file-2=WeaveOutBand${band}.fits
+    set +x
+    echo
+done
@@ -53,6 +53,7 @@
 #include <lal/TimeDelay.h>
 #include <lal/DetResponse.h>
 #include <lal/TimeSeries.h>
+#include <lal/VectorMath.h>
 #include <lal/PrintFTSeries.h>
 #include <lal/FindChirpPTF.h>
 #include <lal/RingUtils.h>
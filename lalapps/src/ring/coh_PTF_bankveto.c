@@ -1,6 +1,12 @@
 #include "config.h"
 #include "coh_PTF.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp ignore
+#endif
+
 #ifdef __GNUC__
 #define UNUSED __attribute__ ((unused))
 #else
@@ -59,6 +65,7 @@ UINT4 coh_PTF_initialize_bank_veto(
     }
   }
   /* Calculate the overlap between templates for bank veto */
+  #pragma omp parallel for private(ifoNumber) schedule(dynamic)
   for (ui = 0 ; ui < subBankSize; ui++)
   {
     for(ifoNumber = 0; ifoNumber < LAL_NUM_IFO; ifoNumber++)
@@ -105,26 +112,40 @@ void coh_PTF_bank_veto_segment_setup(
   struct bankDataOverlaps *dataOverlaps,
   FindChirpTemplate       *bankFcTmplts,
   RingDataSegments        **segments,
-  COMPLEX8VectorSequence  **PTFqVec,
+  COMPLEX8VectorSequence  UNUSED **PTFqVec,
   COMPLEX8FFTPlan         *invplan,
   INT4                    segmentNum,
   struct timeval           startTime
 )
 {
   UINT4 ifoNumber,ui;
-  for (ui = 0 ; ui < params->BVsubBankSize ; ui++)
+
+  /* The bank templates are filtered independently, so spread them over */
+  /* threads. Each thread needs its own time series to transform into,  */
+  /* rather than PTFqVec, but they share the inverse plan.              */
+  #pragma omp parallel private(ifoNumber)
   {
-    for(ifoNumber = 0; ifoNumber < LAL_NUM_IFO; ifoNumber++)
+    COMPLEX8VectorSequence *qVec;
+    qVec = XLALCreateCOMPLEX8VectorSequence(1, params->numTimePoints);
+    sanity_check( qVec );
+
+    #pragma omp for schedule(dynamic)
+    for (ui = 0 ; ui < params->BVsubBankSize ; ui++)
     {
-      if (params->haveTrig[ifoNumber])
+      for(ifoNumber = 0; ifoNumber < LAL_NUM_IFO; ifoNumber++)
       {
-        /* This function calculates the overlap */
-        coh_PTF_bank_filters(params, &(bankFcTmplts[ui]), 0,
-                             &segments[ifoNumber]->sgmnt[segmentNum], invplan,
-                             PTFqVec[ifoNumber],
-                             dataOverlaps[ui].PTFqVec[ifoNumber], 0, 0);
+        if (params->haveTrig[ifoNumber])
+        {
+          /* This function calculates the overlap */
+          coh_PTF_bank_filters(params, &(bankFcTmplts[ui]), 0,
+                               &segments[ifoNumber]->sgmnt[segmentNum], invplan,
+                               qVec,
+                               dataOverlaps[ui].PTFqVec[ifoNumber], 0, 0);
+        }
       }
     }
+
+    XLALDestroyCOMPLEX8VectorSequence(qVec);
   }
   verbose("Generated bank veto filters for segment %d at %ld \n", segmentNum,
           timeval_subtract(&startTime));
@@ -143,6 +164,8 @@ void coh_PTF_calculate_bank_veto_template_filters(
   {
     if (params->haveTrig[ifoNumber])
     {
+      /* One row of the matrix product of the bank with the template */
+      #pragma omp parallel for schedule(static)
       for (ui = 0 ; ui < params->BVsubBankSize ; ui++)
       {
         memset(bankOverlaps[ui].PTFM[ifoNumber]->data,0,1*sizeof(COMPLEX8));
@@ -266,42 +266,26 @@ void coh_PTF_normalize(
    *
    */
 
-  /* Compute M_ij from Qtilde_i and Qtilde_j */
+  /* Compute M_ij and N_ij from Qtilde_i and Qtilde_j: the real and */
+  /* imaginary parts of the weighted inner product (Q_i | Q_j)      */
   for( i = 0; i < vecLength; ++i )
   {
     for ( j = 0; j < i + 1; ++j )
     {
-      for ( k = kmin; k < kmax ; ++k )
-      {
-        PTFM->data[5 * i + j] += (crealf(PTFQtilde[k + i * len]) *
-                            crealf(PTFQtilde[k + j * len]) +
-                            cimagf(PTFQtilde[k + i * len]) *
-                            cimagf(PTFQtilde[k + j * len]) )
-                            * invspec->data->data[k] ;
-      }
+      COMPLEX16 QiQj = 0;
+      sanity_check( XLALVectorWeightedInnerProductCOMPLEX8( &QiQj, NULL,
+            PTFQtilde + kmin + i * len, PTFQtilde + kmin + j * len,
+            invspec->data->data + kmin, kmax > kmin ? kmax - kmin : 0,
+            VECTORMATH_SUM_DIRECT ) == XLAL_SUCCESS );
+      PTFM->data[5 * i + j] += creal( QiQj );
       PTFM->data[5 * i + j] *= 4.0 * deltaF ;
       /* Use the symmetry of M */
       PTFM->data[5 * j + i] = PTFM->data[5 * i + j];
-    }
-  }
-  
-  if (PTFN)
-  {
-    /* Compute N_ij */
-    for( i = 0; i < vecLength; ++i )
-    {
-      for ( j = 0; j < i + 1; ++j )
+      if (PTFN)
       {
-        for ( k = kmin; k < kmax ; ++k )
-        {
-          PTFN->data[5 * i + j] += (crealf(PTFQtilde[k + i * len]) *
-                              cimagf(PTFQtilde[k + j * len]) -
-                              cimagf(PTFQtilde[k + i * len]) *
-                              crealf(PTFQtilde[k + j * len]) )
-                              * invspec->data->data[k] ;
-        }
+        PTFN->data[5 * i + j] += cimag( QiQj );
         PTFN->data[5 * i + j] *= 4.0 * deltaF ;
-        /* Use the anti-symmetry of M */
+        /* Use the anti-symmetry of N */
         PTFN->data[5 * j + i] = -PTFN->data[5 * i + j];
       }
     }
@@ -349,7 +333,7 @@ void coh_PTF_template_overlaps(
 {
   // This function calculates the real part of the overlap between two templates
 
-  UINT4         i, j, k, kmin, kmax, len,vecLen;
+  UINT4         i, j, kmin, kmax, len,vecLen;
   REAL8         f_min, deltaF, fFinal;
   COMPLEX8     *PTFQtilde1   = NULL;
   COMPLEX8     *PTFQtilde2   = NULL;
@@ -371,19 +355,18 @@ void coh_PTF_template_overlaps(
     vecLen = 1;
   }
 
+  /* The real part of sum_k Q1_i Q2_j^* / S_n is the real part of the */
+  /* weighted inner product (Q2_j | Q1_i)                               */
   for( i = 0; i < vecLen; ++i )
   {
     for ( j = 0; j < vecLen; ++j )
     {
-      for ( k = kmin; k < kmax ; ++k )
-      {
-        PTFM->data[vecLen * i + j] += (crealf(PTFQtilde1[k + i * len]) *
-                            crealf(PTFQtilde2[k + j * len]) +
-                            cimagf(PTFQtilde1[k + i * len]) *
-                            cimagf(PTFQtilde2[k + j * len]) )
-                            * invspec->data->data[k] ;
-      
-      }
+      COMPLEX16 Q2Q1 = 0;
+      sanity_check( XLALVectorWeightedInnerProductCOMPLEX8( &Q2Q1, NULL,
+            PTFQtilde2 + kmin + j * len, PTFQtilde1 + kmin + i * len,
+            invspec->data->data + kmin, kmax > kmin ? kmax - kmin : 0,
+            VECTORMATH_SUM_DIRECT ) == XLAL_SUCCESS );
+      PTFM->data[vecLen * i + j] += creal( Q2Q1 );
       PTFM->data[vecLen * i + j] *= 4.0 * deltaF ;
     }
   }
@@ -401,7 +384,7 @@ void coh_PTF_complex_template_overlaps(
 {
 
   // This function calculates the complex overlap between two templates
-  UINT4         i, j, k, kmin, kmax, len,vecLen;
+  UINT4         i, j, kmin, kmax, len,vecLen;
   REAL8         f_min, deltaF, fFinal;
   COMPLEX8     *PTFQtilde1   = NULL;
   COMPLEX8     *PTFQtilde2   = NULL;
@@ -423,24 +406,18 @@ void coh_PTF_complex_template_overlaps(
     vecLen = 1;
   }
 
+  /* sum_k Q1_i Q2_j^* / S_n is the weighted inner product (Q2_j | Q1_i), */
+  /* accumulated in double precision                                     */
   for( i = 0; i < vecLen; ++i )
   {
     for ( j = 0; j < vecLen; ++j )
     {
-      for ( k = kmin; k < kmax ; ++k )
-      {
-        PTFM->data[vecLen * i + j] += crectf(
-                          ( crealf(PTFQtilde1[k + i * len]) *
-                            crealf(PTFQtilde2[k + j * len]) +
-                            cimagf(PTFQtilde1[k + i * len]) *
-                            cimagf(PTFQtilde2[k + j * len]) )
-                            * invspec->data->data[k] ,
-                         ( -crealf(PTFQtilde1[k + i * len]) *
-                            cimagf(PTFQtilde2[k + j * len]) +
-                            cimagf(PTFQtilde1[k + i * len]) *
-                            crealf(PTFQtilde2[k + j * len]) )
-                            * invspec->data->data[k] );
-      }
+      COMPLEX16 Q2Q1 = 0;
+      sanity_check( XLALVectorWeightedInnerProductCOMPLEX8( &Q2Q1, NULL,
+            PTFQtilde2 + kmin + j * len, PTFQtilde1 + kmin + i * len,
+            invspec->data->data + kmin, kmax > kmin ? kmax - kmin : 0,
+            VECTORMATH_SUM_DIRECT ) == XLAL_SUCCESS );
+      PTFM->data[vecLen * i + j] += crectf( creal( Q2Q1 ), cimag( Q2Q1 ) );
       PTFM->data[vecLen * i + j] *= 4.0 * deltaF ;
     }
   }
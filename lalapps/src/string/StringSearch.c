@@ -59,6 +59,7 @@
 #include <lal/ResampleTimeSeries.h>
 #include <lal/TimeFreqFFT.h>
 #include <lal/RealFFT.h>
+#include <lal/SeqFactories.h>
 #include <lal/PrintFTSeries.h>
 #include <lal/Date.h>
 #include <lal/Units.h>
@@ -77,11 +78,21 @@
 
 #include <LALAppsVCSInfo.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp ignore
+#endif
+
 #define TESTSTATUS( pstat ) \
   if ( (pstat)->statusCode ) { REPORTSTATUS(pstat); return 100; } else ((void)0)
 
 #define MAXTEMPLATES 50
 
+/* number of templates filtered together by the batched reverse FFT in
+ * FindStringBurst() */
+#define TEMPLATE_BLOCK 8
+
 
 /* FIXME:  should be "lalapps_StringSearch" to match the executable */
 /* requires post-processing codes to be updated */
@@ -173,7 +184,7 @@ int CreateTemplateBank(struct CommandLineArgsTag CLA, unsigned seg_length, REAL8
 int CreateStringFilters(struct CommandLineArgsTag CLA, REAL8TimeSeries *ht, unsigned seg_length, REAL8FrequencySeries *Spec, StringTemplate *strtemplate, int NTemplates, REAL8FFTPlan *fplan, REAL8FFTPlan *rplan);
 
 /* Filters the data through the template banks  */
-int FindStringBurst(struct CommandLineArgsTag CLA, REAL8TimeSeries *ht, unsigned seg_length, const StringTemplate *strtemplate, int NTemplates, REAL8FFTPlan *fplan, REAL8FFTPlan *rplan, SnglBurst **head);
+int FindStringBurst(struct CommandLineArgsTag CLA, REAL8TimeSeries *ht, unsigned seg_length, const StringTemplate *strtemplate, int NTemplates, REAL8FFTPlan *fplan, SnglBurst **head);
 
 /* Finds events above SNR threshold specified  */
 int FindEvents(struct CommandLineArgsTag CLA, const StringTemplate *strtemplate,
@@ -289,7 +300,7 @@ int main(int argc,char *argv[])
 
   /****** FindStringBurst ******/
   XLALPrintInfo("FindStringBurst()\n");
-  if (FindStringBurst(CommandLineArgs, ht, seg_length, strtemplate, NTemplates, fplan, rplan, &events)) return 12;
+  if (FindStringBurst(CommandLineArgs, ht, seg_length, strtemplate, NTemplates, fplan, &events)) return 12;
   XLALDestroyREAL8TimeSeries(ht);
   XLALDestroyREAL8FFTPlan(fplan);
   XLALDestroyREAL8FFTPlan(rplan);
@@ -600,55 +611,110 @@ int FindEvents(struct CommandLineArgsTag CLA, const StringTemplate *strtemplate,
 
 /*******************************************************************************/
 
-int FindStringBurst(struct CommandLineArgsTag CLA, REAL8TimeSeries *ht, unsigned seg_length, const StringTemplate *strtemplate, int NTemplates, REAL8FFTPlan *fplan, REAL8FFTPlan *rplan, SnglBurst **head){
-  int i,m;
-  unsigned p;
-  COMPLEX16FrequencySeries *vtilde;
+int FindStringBurst(struct CommandLineArgsTag CLA, REAL8TimeSeries *ht, unsigned seg_length, const StringTemplate *strtemplate, int NTemplates, REAL8FFTPlan *fplan, SnglBurst **head){
+  const int nblocks = (NTemplates + TEMPLATE_BLOCK - 1) / TEMPLATE_BLOCK;
+  int nseg, item, i, errors = 0;
+  COMPLEX16VectorSequence *dtilde;
+  REAL8FFTPlan *rplan;
+  SnglBurst **events;
+
+  /* number of overlapping chunks */
+  for(nseg = 0; nseg < 2*(ht->data->length*ht->deltaT)/CLA.ShortSegDuration - 1; nseg++);
+  if(nseg <= 0) return 0;
+
+  /* the templates are filtered against a chunk TEMPLATE_BLOCK at a time
+   * by a single batched reverse FFT */
+  rplan = XLALCreateREAL8FFTPlanMany(seg_length, TEMPLATE_BLOCK, 0, 1);
+  dtilde = XLALCreateCOMPLEX16VectorSequence(nseg, seg_length / 2 + 1);
+  events = XLALCalloc((size_t) nseg * NTemplates, sizeof(*events));
+  if(!rplan || !dtilde || !events){
+    XLALDestroyREAL8FFTPlan(rplan);
+    XLALDestroyCOMPLEX16VectorSequence(dtilde);
+    XLALFree(events);
+    return 1;
+  }
 
-  /* create vector that will hold FFT of data;  metadata will be populated
-   * by FFT function */
-  vtilde = XLALCreateCOMPLEX16FrequencySeries( ht->name, &ht->epoch, ht->f0, 0.0, &lalDimensionlessUnit, seg_length / 2 + 1 );
+  /* FFT each overlapping chunk of data once, for use with all templates */
+#pragma omp parallel for schedule(dynamic) reduction(+:errors)
+  for(i = 0; i < nseg; i++){
+    REAL8Vector chunk = {seg_length, ht->data->data + i * seg_length / 2};
+    COMPLEX16Vector chunktilde = {dtilde->vectorLength, dtilde->data + (size_t) i * dtilde->vectorLength};
+    if(XLALREAL8ForwardFFT(&chunktilde, &chunk, fplan)) errors++;
+  }
 
-  /* loop over templates  */
-  for (m = 0; m < NTemplates; m++){
-    /* loop over overlapping chunks */
-    for(i=0; i < 2*(ht->data->length*ht->deltaT)/CLA.ShortSegDuration - 1 ;i++){
-      /* extract overlapping chunk of data */
-      REAL8TimeSeries *vector = XLALCutREAL8TimeSeries(ht, i * seg_length / 2, seg_length);
-
-      /* FFT it */
-      if(XLALREAL8TimeFreqFFT( vtilde, vector, fplan )) return 1;
-
-      /* multiply FT of data and String Filter */
-      for ( p = 0 ; p < vtilde->data->length; p++ )
-        vtilde->data->data[p] *= strtemplate[m].StringFilter->data->data[p];
-
-      /* reverse FFT it */
-      if(XLALREAL8FreqTimeFFT( vector, vtilde, rplan )) return 1;
-      vector->deltaT = ht->deltaT;	/* gets mucked up by round-off */
-
-      /* normalise the result by template normalisation
-	 factor of 2 is from match-filter definition */
-      for ( p = 0 ; p < vector->data->length; p++ )
-	vector->data->data[p] *= 2.0 / strtemplate[m].norm;
-
-      /* find triggers */
-      if(FindEvents(CLA, &strtemplate[m], vector, head)) return 1;
-
-      /*
-      if(m==10){
-      	for ( int ii = 0 ; ii < vector->data->length; ii++ )
-	  printf("%.3e\n",vector->data->data[ii]);
+  /* loop over blocks of templates and overlapping chunks.  each thread
+   * has its own work space, and collects the triggers of each template
+   * and chunk in their own list.  the SNR time series are printed in
+   * order if requested, so this is done by one thread */
+#pragma omp parallel reduction(+:errors) if(!CLA.printsnrflag)
+  {
+  COMPLEX16VectorSequence *fcorr = XLALCreateCOMPLEX16VectorSequence(TEMPLATE_BLOCK, seg_length / 2 + 1);
+  REAL8VectorSequence *tcorr = XLALCreateREAL8VectorSequence(TEMPLATE_BLOCK, seg_length);
+  if(!fcorr || !tcorr) errors++;
+
+#pragma omp for schedule(dynamic)
+  for(item = 0; item < nblocks * nseg; item++){
+    const int first = (item / nseg) * TEMPLATE_BLOCK;
+    const int seg = item % nseg;
+    const COMPLEX16 *chunktilde = dtilde->data + (size_t) seg * dtilde->vectorLength;
+    int j;
+    unsigned p;
+    if(errors || !fcorr || !tcorr) continue;
+
+    /* multiply FT of data and String Filters.  the normalisation folds
+       in the 1/N of the inverse transform, the template normalisation,
+       and the factor of 2 from the match-filter definition.  the rows of
+       a short final block are zeroed */
+    for(j = 0; j < TEMPLATE_BLOCK; j++){
+      COMPLEX16 *row = fcorr->data + (size_t) j * fcorr->vectorLength;
+      if(first + j < NTemplates){
+        const REAL8 *filter = strtemplate[first + j].StringFilter->data->data;
+        const REAL8 norm = 2.0 / (strtemplate[first + j].norm * seg_length);
+        for ( p = 0 ; p < fcorr->vectorLength; p++ )
+          row[p] = chunktilde[p] * (filter[p] * norm);
       }
-      */
-      /* free chunk */
-      XLALDestroyREAL8TimeSeries( vector );
+      else
+        memset(row, 0, fcorr->vectorLength * sizeof(*row));
+    }
+
+    /* reverse FFT it */
+    if(XLALREAL8ReverseFFTMany(tcorr, fcorr, rplan)){
+      errors++;
+      continue;
+    }
+
+    /* find triggers */
+    for(j = 0; j < TEMPLATE_BLOCK && first + j < NTemplates; j++){
+      REAL8Sequence snr = {tcorr->vectorLength, tcorr->data + (size_t) j * tcorr->vectorLength};
+      REAL8TimeSeries vector;
+      memset(&vector, 0, sizeof(vector));
+      vector.epoch = ht->epoch;
+      XLALGPSAdd(&vector.epoch, seg * (seg_length / 2) * ht->deltaT);
+      vector.deltaT = ht->deltaT;
+      vector.data = &snr;
+      if(FindEvents(CLA, &strtemplate[first + j], &vector, &events[(size_t) (first + j) * nseg + seg])) errors++;
     }
   }
 
-  XLALDestroyCOMPLEX16FrequencySeries( vtilde );
+  XLALDestroyCOMPLEX16VectorSequence(fcorr);
+  XLALDestroyREAL8VectorSequence(tcorr);
+  }
 
-  return 0;
+  /* prepend the triggers to the list in the order in which a template
+   * by template, chunk by chunk, search would have found them */
+  for(item = 0; item < nseg * NTemplates; item++)
+    if(events[item]){
+      SnglBurst *tail = events[item];
+      while(tail->next) tail = tail->next;
+      tail->next = *head;
+      *head = events[item];
+    }
+
+  XLALFree(events);
+  XLALDestroyCOMPLEX16VectorSequence(dtilde);
+  XLALDestroyREAL8FFTPlan(rplan);
+
+  return errors ? 1 : 0;
 }
 
 
@@ -99,13 +99,17 @@ double XLALExcessPowerFilterInnerProduct(
 	}
 
 	/*
-	 * compute and return inner product
+	 * compute and return inner product.  the two-point spectral
+	 * correlation vanishes for |delta_k| >= correlation->length, so
+	 * only the band of k2 around k10 + k1 - k20 contributes
 	 */
 
 	for(k1 = 0; k1 < (int) filter1->data->length; k1++) {
-		for(k2 = 0; k2 < (int) filter2->data->length; k2++) {
+		const int k2lo = max(0, k10 + k1 - k20 - (int) correlation->length + 1);
+		const int k2hi = min((int) filter2->data->length, k10 + k1 - k20 + (int) correlation->length);
+		for(k2 = k2lo; k2 < k2hi; k2++) {
 			const unsigned delta_k = abs(k10 + k1 - k20 - k2);
-			double sksk = (delta_k & 1 ? -1 : +1) * (delta_k < correlation->length ? correlation->data[delta_k] : 0);
+			double sksk = (delta_k & 1 ? -1 : +1) * correlation->data[delta_k];
 
 			if(pdata)
 				sksk *= sqrt(pdata[k10 + k1] * pdata[k20 + k2]);
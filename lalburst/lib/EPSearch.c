@@ -46,6 +46,7 @@
 #include <lal/LIGOLwXMLArray.h>
 #include <lal/LIGOMetadataTables.h>
 #include <lal/RealFFT.h>
+#include <lal/SeqFactories.h>
 #include <lal/SnglBurstUtils.h>
 #include <lal/TimeFreqFFT.h>
 #include <lal/TimeSeries.h>
@@ -53,6 +54,21 @@
 #include <lal/XLALError.h>
 #include <lal/Window.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp ignore
+#endif
+
+
+/*
+ * number of channels transformed together by the batched reverse FFT in
+ * XLALFreqSeriesToTFPlane()
+ */
+
+
+#define EP_CHANNEL_BLOCK 8
+
 
 static double min(double a, double b)
 {
@@ -638,8 +654,10 @@ static int XLALFreqSeriesToTFPlane(
 	const REAL8FFTPlan *reverseplan
 )
 {
-	COMPLEX16Sequence *fcorr;
-	unsigned i;
+	const unsigned channels = plane->channel_data->size2;
+	const unsigned blocks = (channels + EP_CHANNEL_BLOCK - 1) / EP_CHANNEL_BLOCK;
+	int errors = 0;
+	unsigned block;
 
 	/* check input parameters */
 	if((fmod(plane->deltaF, fseries->deltaF) != 0.0) ||
@@ -651,11 +669,6 @@ static int XLALFreqSeriesToTFPlane(
 	   (plane->flow + plane->channel_data->size2 * plane->deltaF > fseries->f0 + fseries->data->length * fseries->deltaF))
 		XLAL_ERROR(XLAL_EDATA);
 
-	/* create temporary vectors */
-	fcorr = XLALCreateCOMPLEX16Sequence(fseries->data->length);
-	if(!fcorr)
-		XLAL_ERROR(XLAL_EFUNC);
-
 #if 0
 	/* diagnostic code to dump data for the \hat{s}_{k} histogram */
 	{
@@ -691,27 +704,59 @@ static int XLALFreqSeriesToTFPlane(
 	}
 #endif
 
-	/* loop over the time-frequency plane's channels */
-	for(i = 0; i < plane->channel_data->size2; i++) {
-		unsigned j;
+	/* loop over the time-frequency plane's channels in blocks of
+	 * EP_CHANNEL_BLOCK, each block being transformed by a single
+	 * batched FFT.  blocks are independent, and each thread has its
+	 * own work space */
+#pragma omp parallel reduction(+:errors)
+	{
+	COMPLEX16VectorSequence *fcorr = XLALCreateCOMPLEX16VectorSequence(EP_CHANNEL_BLOCK, fseries->data->length);
+	REAL8VectorSequence *tcorr = XLALCreateREAL8VectorSequence(EP_CHANNEL_BLOCK, plane->channel_data->size1);
+	if(!fcorr || !tcorr)
+		errors++;
+
+#pragma omp for schedule(dynamic)
+	for(block = 0; block < blocks; block++) {
+		const unsigned first = block * EP_CHANNEL_BLOCK;
+		const unsigned n = min(EP_CHANNEL_BLOCK, channels - first);
+		unsigned i, j;
+		if(!fcorr || !tcorr)
+			continue;
 		/* cross correlate the input data against the channel
 		 * filter by taking their product in the frequency domain
 		 * and then inverse transforming to the time domain to
 		 * obtain an SNR time series.  Note that
-		 * XLALREAL8ReverseFFT() omits the factor of 1 / (N Delta
-		 * t) in the inverse transform. */
-		apply_filter(fcorr, fseries, filter_bank->basis_filters[i].fseries);
-		if(XLALREAL8ReverseFFT(plane->channel_buffer, fcorr, reverseplan)) {
-			XLALDestroyCOMPLEX16Sequence(fcorr);
-			XLAL_ERROR(XLAL_EFUNC);
+		 * XLALREAL8ReverseFFTMany() omits the factor of 1 / (N
+		 * Delta t) in the inverse transform.  The rows of a
+		 * short final block are zeroed. */
+		for(i = 0; i < EP_CHANNEL_BLOCK; i++) {
+			COMPLEX16Sequence row = {
+				.length = fcorr->vectorLength,
+				.data = fcorr->data + i * fcorr->vectorLength
+			};
+			if(i < n)
+				apply_filter(&row, fseries, filter_bank->basis_filters[first + i].fseries);
+			else
+				memset(row.data, 0, row.length * sizeof(*row.data));
+		}
+		if(XLALREAL8ReverseFFTMany(tcorr, fcorr, reverseplan)) {
+			errors++;
+			continue;
 		}
 		/* interleave the result into the channel_data array */
-		for(j = 0; j < plane->channel_buffer->length; j++)
-			gsl_matrix_set(plane->channel_data, j, i, plane->channel_buffer->data[j]);
+		for(j = 0; j < tcorr->vectorLength; j++) {
+			double *sample = gsl_matrix_ptr(plane->channel_data, j, first);
+			for(i = 0; i < n; i++)
+				sample[i] = tcorr->data[i * tcorr->vectorLength + j];
+		}
 	}
 
 	/* clean up */
-	XLALDestroyCOMPLEX16Sequence(fcorr);
+	XLALDestroyCOMPLEX16VectorSequence(fcorr);
+	XLALDestroyREAL8VectorSequence(tcorr);
+	}
+	if(errors)
+		XLAL_ERROR(XLAL_EFUNC);
 
 	/* set the name and epoch of the TF plane */
 	strncpy(plane->name, fseries->name, LALNameLength);
@@ -810,6 +855,8 @@ static SnglBurst *XLALComputeExcessPower(
 	gsl_vector_view filter_output_view;
 	gsl_vector *channel_buffer;
 	gsl_vector *unwhitened_channel_buffer;
+	double *sumsquares_cumulative;
+	double *uwsumsquares_cumulative;
 	unsigned channel;
 	unsigned channels;
 	unsigned channel_end;
@@ -826,11 +873,15 @@ static SnglBurst *XLALComputeExcessPower(
 
 	channel_buffer = gsl_vector_alloc(filter_output.size);
 	unwhitened_channel_buffer = gsl_vector_alloc(filter_output.size);
-	if(!channel_buffer || !unwhitened_channel_buffer) {
+	sumsquares_cumulative = XLALMalloc((filter_output.size + 1) * sizeof(*sumsquares_cumulative));
+	uwsumsquares_cumulative = XLALMalloc((filter_output.size + 1) * sizeof(*uwsumsquares_cumulative));
+	if(!channel_buffer || !unwhitened_channel_buffer || !sumsquares_cumulative || !uwsumsquares_cumulative) {
 		if(channel_buffer)
 			gsl_vector_free(channel_buffer);
 		if(unwhitened_channel_buffer)
 			gsl_vector_free(unwhitened_channel_buffer);
+		XLALFree(sumsquares_cumulative);
+		XLALFree(uwsumsquares_cumulative);
 		XLAL_ERROR_NULL(XLAL_ENOMEM);
 	}
 
@@ -890,10 +941,13 @@ static SnglBurst *XLALComputeExcessPower(
 #endif
 
 		/* square the samples in the channel time series because
-		 * from now on that's all we'll need */
+		 * from now on that's all we'll need, and accumulate them
+		 * so that the sum of squares over any run of samples is
+		 * the difference of two entries */
+		sumsquares_cumulative[0] = uwsumsquares_cumulative[0] = 0;
 		for(i = 0; i < channel_buffer->size; i++) {
-			gsl_vector_set(channel_buffer, i, pow(gsl_vector_get(channel_buffer, i), 2));
-			gsl_vector_set(unwhitened_channel_buffer, i, pow(gsl_vector_get(unwhitened_channel_buffer, i), 2));
+			sumsquares_cumulative[i + 1] = sumsquares_cumulative[i] + pow(gsl_vector_get(channel_buffer, i), 2);
+			uwsumsquares_cumulative[i + 1] = uwsumsquares_cumulative[i] + pow(gsl_vector_get(unwhitened_channel_buffer, i), 2);
 		}
 
 	/* start with at least 2 degrees of freedom */
@@ -901,13 +955,10 @@ static SnglBurst *XLALComputeExcessPower(
 		unsigned start;
 	for(start = 0; start + tile_dof <= channel_buffer->size; start += tile_dof / plane->tiles.inv_fractional_stride) {
 		/* compute sum of squares, and unwhitened sum of squares
-		 * (samples have already been squared) */
-		double sumsquares = 0;
-		double uwsumsquares = 0;
-		for(i = start; i < start + tile_dof; i++) {
-			sumsquares += gsl_vector_get(channel_buffer, i);
-			uwsumsquares += gsl_vector_get(unwhitened_channel_buffer, i);
-		}
+		 * (samples have already been squared and accumulated) */
+		const unsigned end = start + tile_dof;
+		const double sumsquares = sumsquares_cumulative[end] - sumsquares_cumulative[start];
+		const double uwsumsquares = uwsumsquares_cumulative[end] - uwsumsquares_cumulative[start];
 
 		/* compute statistical confidence */
 		/* FIXME:  the 0.62 is an empirically determined
@@ -921,6 +972,8 @@ static SnglBurst *XLALComputeExcessPower(
 		if(XLALIsREAL8FailNaN(confidence)) {
 			gsl_vector_free(channel_buffer);
 			gsl_vector_free(unwhitened_channel_buffer);
+			XLALFree(sumsquares_cumulative);
+			XLALFree(uwsumsquares_cumulative);
 			XLAL_ERROR_NULL(XLAL_EFUNC);
 		}
 
@@ -937,6 +990,8 @@ static SnglBurst *XLALComputeExcessPower(
 			if(!head) {
 				gsl_vector_free(channel_buffer);
 				gsl_vector_free(unwhitened_channel_buffer);
+				XLALFree(sumsquares_cumulative);
+				XLALFree(uwsumsquares_cumulative);
 				XLAL_ERROR_NULL(XLAL_EFUNC);
 			}
 			head->next = oldhead;
@@ -949,6 +1004,8 @@ static SnglBurst *XLALComputeExcessPower(
 	/* success */
 	gsl_vector_free(channel_buffer);
 	gsl_vector_free(unwhitened_channel_buffer);
+	XLALFree(sumsquares_cumulative);
+	XLALFree(uwsumsquares_cumulative);
 	return head;
 }
 
@@ -963,12 +1020,22 @@ static SnglBurst *XLALComputeExcessPower(
 
 
 /**
- * Generate a linked list of burst events from a time series.
+ * Generate a linked list of burst events from a time series, whitening
+ * the data with a running PSD estimate.
+ *
+ * If psd_regressor has not yet seen any data it is initialized to the
+ * median PSD of tseries, otherwise its current PSD is used to construct
+ * the channel filters and to whiten the data.  Each analysis window's
+ * Fourier transform is then added to the regressor, so that repeated
+ * calls on consecutive time series track the noise as it evolves.  If
+ * psd_regressor is NULL the median PSD of tseries is used, as by
+ * XLALEPSearch().
  */
-SnglBurst *XLALEPSearch(
+SnglBurst *XLALEPSearchWithPSDRegressor(
 	LIGOLwXMLStream *diagnostics,
 	const REAL8TimeSeries *tseries,
 	REAL8Window *window,
+	LALPSDRegressor *psd_regressor,
 	double flow,
 	double bandwidth,
 	double confidence_threshold,
@@ -998,7 +1065,7 @@ SnglBurst *XLALEPSearch(
 	 */
 
 	fplan = XLALCreateForwardREAL8FFTPlan(window->data->length, 1);
-	rplan = XLALCreateReverseREAL8FFTPlan(window->data->length, 1);
+	rplan = XLALCreateREAL8FFTPlanMany(window->data->length, EP_CHANNEL_BLOCK, 0, 1);
 	psd = XLALCreateREAL8FrequencySeries("PSD", &tseries->epoch, 0, 0, &lalDimensionlessUnit, window->data->length / 2 + 1);
 	fseries = XLALCreateCOMPLEX16FrequencySeries(tseries->name, &tseries->epoch, 0, 0, &lalDimensionlessUnit, window->data->length / 2 + 1);
 	if(fplan)
@@ -1033,15 +1100,30 @@ SnglBurst *XLALEPSearch(
 #endif
 
 	/*
-	 * Compute the average spectrum.
+	 * Compute the average spectrum, or retrieve the running estimate.
 	 *
 	 * FIXME: is using windowShift here correct?  we have to, otherwise
 	 * the time series' lengths are inconsistent
 	 */
 
-	if(XLALREAL8AverageSpectrumMedian(psd, tseries, plane->window->data->length, plane->window_shift, plane->window, fplan) < 0) {
-		errorcode = XLAL_EFUNC;
-		goto error;
+	if(psd_regressor && XLALPSDRegressorGetNSamples(psd_regressor)) {
+		XLALDestroyREAL8FrequencySeries(psd);
+		psd = XLALPSDRegressorGetPSD(psd_regressor);
+		if(!psd) {
+			errorcode = XLAL_EFUNC;
+			goto error;
+		}
+	} else {
+		if(XLALREAL8AverageSpectrumMedian(psd, tseries, plane->window->data->length, plane->window_shift, plane->window, fplan) < 0) {
+			errorcode = XLAL_EFUNC;
+			goto error;
+		}
+		/* seed the regressor, counting the median as one sample
+		 * per analysis window */
+		if(psd_regressor && XLALPSDRegressorSetPSD(psd_regressor, psd, (tseries->data->length - plane->window->data->length) / plane->window_shift + 1) < 0) {
+			errorcode = XLAL_EFUNC;
+			goto error;
+		}
 	}
 
 	if(diagnostics)
@@ -1100,6 +1182,15 @@ SnglBurst *XLALEPSearch(
 		XLALDestroyREAL8TimeSeries(cuttseries);
 		cuttseries = NULL;
 
+		/*
+		 * Update the running PSD estimate.
+		 */
+
+		if(psd_regressor && XLALPSDRegressorAdd(psd_regressor, fseries) < 0) {
+			errorcode = XLAL_EFUNC;
+			goto error;
+		}
+
 		/*
 		 * Normalize the frequency series to the average PSD.
 		 */
@@ -1163,3 +1254,22 @@ SnglBurst *XLALEPSearch(
 	}
 	return(head);
 }
+
+
+/**
+ * Generate a linked list of burst events from a time series.
+ */
+SnglBurst *XLALEPSearch(
+	LIGOLwXMLStream *diagnostics,
+	const REAL8TimeSeries *tseries,
+	REAL8Window *window,
+	double flow,
+	double bandwidth,
+	double confidence_threshold,
+	double fractional_stride,
+	double maxTileBandwidth,
+	double maxTileDuration
+)
+{
+	return XLALEPSearchWithPSDRegressor(diagnostics, tseries, window, NULL, flow, bandwidth, confidence_threshold, fractional_stride, maxTileBandwidth, maxTileDuration);
+}
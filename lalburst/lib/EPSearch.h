@@ -25,6 +25,7 @@
 #include <lal/LIGOLwXML.h>
 #include <lal/LIGOMetadataTables.h>
 #include <lal/Sequence.h>
+#include <lal/TimeFreqFFT.h>
 #include <lal/TimeSeries.h>
 #include <lal/Window.h>
 
@@ -170,6 +171,21 @@ SnglBurst *XLALEPSearch(
 	double maxTileDuration
 );
 
+
+SnglBurst *XLALEPSearchWithPSDRegressor(
+	LIGOLwXMLStream *diagnostics,
+	const REAL8TimeSeries  *tseries,
+	REAL8Window *window,
+	LALPSDRegressor *psd_regressor,
+	double flow,
+	double bandwidth,
+	double confidence_threshold,
+	/* t.f. plane tiling parameters */
+	double fractional_stride,
+	double maxTileBandwidth,
+	double maxTileDuration
+);
+
   /** @} */
 
 #ifdef  __cplusplus
@@ -18,8 +18,12 @@
 */
 
 
+#include <math.h>
+#include <stdlib.h>
 #include <string.h>
+#include <lal/AVFactories.h>
 #include <lal/Date.h>
+#include <lal/H5FileIO.h>
 #include <lal/LIGOMetadataTables.h>
 #include <lal/SnglBurstUtils.h>
 #include <lal/XLALError.h>
@@ -260,3 +264,689 @@ long XLALSimBurstAssignIDs(
 	}
 	return simulation_id;
 }
+
+
+/*
+ * ============================================================================
+ *
+ *                          Column-Oriented SnglBurst
+ *
+ * ============================================================================
+ */
+
+
+/**
+ * Gather the rows of a SnglBurst linked list into a SnglBurstColumns
+ * structure.  The numeric columns are copied into contiguous arrays;  the
+ * rows themselves remain owned by the linked list, and are referenced by
+ * the row array for their string columns and for converting back with
+ * XLALSnglBurstColumnsToTable().
+ */
+SnglBurstColumns *XLALCreateSnglBurstColumns(SnglBurst *head)
+{
+	SnglBurstColumns *cols = XLALCalloc(1, sizeof(*cols));
+	size_t n = XLALSnglBurstTableLength(head);
+	size_t i;
+
+	if(!cols)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	cols->length = n;
+	if(n) {
+		cols->row = XLALMalloc(n * sizeof(*cols->row));
+		cols->process_id = XLALMalloc(n * sizeof(*cols->process_id));
+		cols->event_id = XLALMalloc(n * sizeof(*cols->event_id));
+		cols->start_time = XLALMalloc(n * sizeof(*cols->start_time));
+		cols->peak_time = XLALMalloc(n * sizeof(*cols->peak_time));
+		cols->duration = XLALMalloc(n * sizeof(*cols->duration));
+		cols->central_freq = XLALMalloc(n * sizeof(*cols->central_freq));
+		cols->bandwidth = XLALMalloc(n * sizeof(*cols->bandwidth));
+		cols->amplitude = XLALMalloc(n * sizeof(*cols->amplitude));
+		cols->snr = XLALMalloc(n * sizeof(*cols->snr));
+		cols->confidence = XLALMalloc(n * sizeof(*cols->confidence));
+		cols->chisq = XLALMalloc(n * sizeof(*cols->chisq));
+		cols->chisq_dof = XLALMalloc(n * sizeof(*cols->chisq_dof));
+		if(!cols->row || !cols->process_id || !cols->event_id || !cols->start_time || !cols->peak_time || !cols->duration || !cols->central_freq || !cols->bandwidth || !cols->amplitude || !cols->snr || !cols->confidence || !cols->chisq || !cols->chisq_dof) {
+			XLALDestroySnglBurstColumns(cols);
+			XLAL_ERROR_NULL(XLAL_ENOMEM);
+		}
+	}
+
+	for(i = 0; head; head = head->next, i++) {
+		cols->row[i] = head;
+		cols->process_id[i] = head->process_id;
+		cols->event_id[i] = head->event_id;
+		cols->start_time[i] = XLALGPSToINT8NS(&head->start_time);
+		cols->peak_time[i] = XLALGPSToINT8NS(&head->peak_time);
+		cols->duration[i] = head->duration;
+		cols->central_freq[i] = head->central_freq;
+		cols->bandwidth[i] = head->bandwidth;
+		cols->amplitude[i] = head->amplitude;
+		cols->snr[i] = head->snr;
+		cols->confidence[i] = head->confidence;
+		cols->chisq[i] = head->chisq;
+		cols->chisq_dof[i] = head->chisq_dof;
+	}
+
+	return cols;
+}
+
+
+/**
+ * Free a SnglBurstColumns structure.  The rows it refers to are not freed.
+ */
+void XLALDestroySnglBurstColumns(SnglBurstColumns *cols)
+{
+	if(!cols)
+		return;
+	XLALFree(cols->row);
+	XLALFree(cols->process_id);
+	XLALFree(cols->event_id);
+	XLALFree(cols->start_time);
+	XLALFree(cols->peak_time);
+	XLALFree(cols->duration);
+	XLALFree(cols->central_freq);
+	XLALFree(cols->bandwidth);
+	XLALFree(cols->amplitude);
+	XLALFree(cols->snr);
+	XLALFree(cols->confidence);
+	XLALFree(cols->chisq);
+	XLALFree(cols->chisq_dof);
+	XLALFree(cols);
+}
+
+
+/**
+ * Write the numeric columns back into the rows, and re-link the rows into
+ * a list in column order, setting *head to its first row.  Rows removed
+ * from the columns by clustering have already been freed, so the original
+ * list must not be used after clustering except through the list built
+ * here.
+ */
+SnglBurst **XLALSnglBurstColumnsToTable(SnglBurst **head, const SnglBurstColumns *cols)
+{
+	SnglBurst **next = head;
+	size_t i;
+
+	for(i = 0; i < cols->length; i++, next = &(*next)->next) {
+		SnglBurst *row = cols->row[i];
+		row->process_id = cols->process_id[i];
+		row->event_id = cols->event_id[i];
+		XLALINT8NSToGPS(&row->start_time, cols->start_time[i]);
+		XLALINT8NSToGPS(&row->peak_time, cols->peak_time[i]);
+		row->duration = cols->duration[i];
+		row->central_freq = cols->central_freq[i];
+		row->bandwidth = cols->bandwidth[i];
+		row->amplitude = cols->amplitude[i];
+		row->snr = cols->snr[i];
+		row->confidence = cols->confidence[i];
+		row->chisq = cols->chisq[i];
+		row->chisq_dof = cols->chisq_dof[i];
+		*next = row;
+	}
+	*next = NULL;
+
+	return head;
+}
+
+
+/* sort key of one row, kept together so the sort touches one small array */
+struct SnglBurstColumnsKey {
+	INT8 time;
+	REAL4 snr;
+	size_t index;
+};
+
+
+static int compare_key_by_time_and_snr(const void *a, const void *b)
+{
+	const struct SnglBurstColumnsKey *ka = a;
+	const struct SnglBurstColumnsKey *kb = b;
+
+	if(ka->time != kb->time)
+		return ka->time > kb->time ? 1 : -1;
+	if(ka->snr != kb->snr)
+		return ka->snr > kb->snr ? 1 : -1;
+	/* keep the original order of ties */
+	return (ka->index > kb->index) - (ka->index < kb->index);
+}
+
+
+/* reorder one column according to the sorted keys */
+static void permute_column(void *column, void *temp, size_t size, const struct SnglBurstColumnsKey *keys, size_t n)
+{
+	size_t i;
+	for(i = 0; i < n; i++)
+		memcpy((char *) temp + i * size, (const char *) column + keys[i].index * size, size);
+	memcpy(column, temp, n * size);
+}
+
+
+/* reorder all columns according to the sorted keys */
+static int permute_columns(SnglBurstColumns *cols, const struct SnglBurstColumnsKey *keys)
+{
+	const size_t n = cols->length;
+	void *temp = XLALMalloc(n * sizeof(INT8) > n * sizeof(*cols->row) ? n * sizeof(INT8) : n * sizeof(*cols->row));
+
+	if(!temp)
+		XLAL_ERROR(XLAL_ENOMEM);
+
+	permute_column(cols->row, temp, sizeof(*cols->row), keys, n);
+	permute_column(cols->process_id, temp, sizeof(*cols->process_id), keys, n);
+	permute_column(cols->event_id, temp, sizeof(*cols->event_id), keys, n);
+	permute_column(cols->start_time, temp, sizeof(*cols->start_time), keys, n);
+	permute_column(cols->peak_time, temp, sizeof(*cols->peak_time), keys, n);
+	permute_column(cols->duration, temp, sizeof(*cols->duration), keys, n);
+	permute_column(cols->central_freq, temp, sizeof(*cols->central_freq), keys, n);
+	permute_column(cols->bandwidth, temp, sizeof(*cols->bandwidth), keys, n);
+	permute_column(cols->amplitude, temp, sizeof(*cols->amplitude), keys, n);
+	permute_column(cols->snr, temp, sizeof(*cols->snr), keys, n);
+	permute_column(cols->confidence, temp, sizeof(*cols->confidence), keys, n);
+	permute_column(cols->chisq, temp, sizeof(*cols->chisq), keys, n);
+	permute_column(cols->chisq_dof, temp, sizeof(*cols->chisq_dof), keys, n);
+
+	XLALFree(temp);
+	return 0;
+}
+
+
+/* sort the columns by the given time column and, if snr is not NULL, SNR */
+static int sort_columns(SnglBurstColumns *cols, const INT8 *time, const REAL4 *snr)
+{
+	const size_t n = cols->length;
+	struct SnglBurstColumnsKey *keys;
+	size_t i;
+
+	if(n < 2)
+		return 0;
+
+	keys = XLALMalloc(n * sizeof(*keys));
+	if(!keys)
+		XLAL_ERROR(XLAL_ENOMEM);
+
+	for(i = 0; i < n; i++) {
+		keys[i].time = time[i];
+		keys[i].snr = snr ? snr[i] : 0;
+		keys[i].index = i;
+	}
+	qsort(keys, n, sizeof(*keys), compare_key_by_time_and_snr);
+
+	if(permute_columns(cols, keys) < 0) {
+		XLALFree(keys);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+
+	XLALFree(keys);
+	return 0;
+}
+
+
+/**
+ * Sort a SnglBurstColumns structure into increasing order of peak time
+ * and SNR, the order of XLALCompareSnglBurstByPeakTimeAndSNR().  Only the
+ * peak time and SNR columns are read by the sort;  the other columns are
+ * then permuted in one pass each.
+ */
+int XLALSnglBurstColumnsSortByPeakTimeAndSNR(SnglBurstColumns *cols)
+{
+	if(sort_columns(cols, cols->peak_time, cols->snr) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
+
+/* copy row j of the columns over row i */
+static void copy_columns_row(SnglBurstColumns *cols, size_t i, size_t j)
+{
+	cols->row[i] = cols->row[j];
+	cols->process_id[i] = cols->process_id[j];
+	cols->event_id[i] = cols->event_id[j];
+	cols->start_time[i] = cols->start_time[j];
+	cols->peak_time[i] = cols->peak_time[j];
+	cols->duration[i] = cols->duration[j];
+	cols->central_freq[i] = cols->central_freq[j];
+	cols->bandwidth[i] = cols->bandwidth[j];
+	cols->amplitude[i] = cols->amplitude[j];
+	cols->snr[i] = cols->snr[j];
+	cols->confidence[i] = cols->confidence[j];
+	cols->chisq[i] = cols->chisq[j];
+	cols->chisq_dof[i] = cols->chisq_dof[j];
+}
+
+
+/**
+ * Cluster the events of a SnglBurstColumns structure sorted by peak time.
+ * Starting from the earliest event, each event whose peak time is within
+ * window seconds of the peak time of the current cluster is merged into
+ * it;  the cluster is represented by its event with the largest SNR, so
+ * the cluster's peak time moves to that event.  This is a single pass over
+ * the peak time and SNR columns.  The rows of the events that are merged
+ * away are freed.  Returns the number of clusters.
+ */
+size_t XLALSnglBurstColumnsClusterByPeakTime(SnglBurstColumns *cols, double window)
+{
+	const INT8 window_ns = (INT8) (window * XLAL_BILLION_REAL8);
+	size_t n = 0;
+	size_t i;
+
+	for(i = 0; i < cols->length; i++) {
+		if(n && llabs(cols->peak_time[i] - cols->peak_time[n - 1]) <= window_ns) {
+			/* merge into the current cluster, keeping the loudest */
+			if(cols->snr[i] > cols->snr[n - 1]) {
+				XLALDestroySnglBurst(cols->row[n - 1]);
+				copy_columns_row(cols, n - 1, i);
+			} else
+				XLALDestroySnglBurst(cols->row[i]);
+		} else
+			copy_columns_row(cols, n++, i);
+	}
+	cols->length = n;
+
+	return n;
+}
+
+
+/*
+ * Sweep-line clustering of time-frequency tiles.
+ */
+
+
+/* a cluster's time-frequency bounding box in the sweep's active list */
+struct tile_box {
+	double start;
+	double end;
+	double flow;
+	double fhigh;
+	size_t root;	/* index of the tile representing the cluster */
+};
+
+
+static int boxes_overlap(const struct tile_box *a, const struct tile_box *b, double time_window, double freq_window)
+{
+	return a->start < b->end + time_window && b->start < a->end + time_window && a->flow < b->fhigh + freq_window && b->flow < a->fhigh + freq_window;
+}
+
+
+static size_t find_root(size_t *parent, size_t i)
+{
+	while(parent[i] != i)
+		i = parent[i] = parent[parent[i]];
+	return i;
+}
+
+
+/*
+ * Partition tiles into clusters of tiles whose bounding boxes overlap,
+ * growing each cluster's box to enclose its tiles, until no two clusters'
+ * boxes overlap.  The tiles are visited once, in the order of increasing
+ * start time given by order[].  Each tile's box absorbs every active
+ * cluster box that it overlaps, repeatedly, because the merged box can
+ * reach boxes the tile alone did not.  A box is retired from the active
+ * list once neither a later tile nor the growth of another active box can
+ * reach it.  On return label[i] is the cluster of tile i, clusters being
+ * numbered in order of their earliest tiles.  Returns the number of
+ * clusters, or < 0 on failure.
+ */
+static long cluster_tiles(size_t n, const size_t *order, const double *start, const double *end, const double *flow, const double *fhigh, double time_window, double freq_window, UINT4 *label)
+{
+	size_t *parent = XLALMalloc(n * sizeof(*parent));
+	struct tile_box *active = XLALMalloc(n * sizeof(*active));
+	size_t nactive = 0;
+	long nclusters = 0;
+	size_t i, j, k;
+
+	if(!parent || !active) {
+		XLALFree(parent);
+		XLALFree(active);
+		XLAL_ERROR(XLAL_ENOMEM);
+	}
+
+	for(k = 0; k < n; k++) {
+		const size_t t = order[k];
+		struct tile_box box = {start[t], end[t], flow[t], fhigh[t], t};
+		double min_start = HUGE_VAL;
+
+		parent[t] = t;
+
+		/* absorb the active boxes, rescanning after each merge */
+		for(i = 0; i < nactive;) {
+			if(boxes_overlap(&box, &active[i], time_window, freq_window)) {
+				box.start = active[i].start < box.start ? active[i].start : box.start;
+				box.end = active[i].end > box.end ? active[i].end : box.end;
+				box.flow = active[i].flow < box.flow ? active[i].flow : box.flow;
+				box.fhigh = active[i].fhigh > box.fhigh ? active[i].fhigh : box.fhigh;
+				parent[active[i].root] = t;
+				active[i] = active[--nactive];
+				i = 0;
+			} else
+				i++;
+		}
+		active[nactive++] = box;
+
+		/* later tiles start no earlier than this one, so they can
+		 * only be absorbed by the boxes that reach past its start.
+		 * those boxes can then go on to absorb boxes reaching past
+		 * the earliest of their starts, and so on;  whatever is left
+		 * over is out of reach.  move the boxes to be kept to the
+		 * front of the list, tracking the earliest start among them */
+		for(i = j = 0; i < nactive; i++)
+			if(active[i].end + time_window > start[t]) {
+				struct tile_box tmp = active[j];
+				active[j++] = active[i];
+				active[i] = tmp;
+				if(active[j - 1].start < min_start)
+					min_start = active[j - 1].start;
+			}
+		for(i = j; i < nactive;)
+			if(active[i].end + time_window > min_start) {
+				struct tile_box tmp = active[j];
+				active[j++] = active[i];
+				active[i] = tmp;
+				if(active[j - 1].start < min_start) {
+					min_start = active[j - 1].start;
+					i = j;
+				} else
+					i++;
+			} else
+				i++;
+		nactive = j;
+	}
+
+	/* number the clusters in order of their earliest tiles */
+	for(i = 0; i < n; i++)
+		label[i] = (UINT4) -1;
+	for(k = 0; k < n; k++) {
+		const size_t t = order[k];
+		const size_t r = find_root(parent, t);
+		if(label[r] == (UINT4) -1)
+			label[r] = nclusters++;
+		label[t] = label[r];
+	}
+
+	XLALFree(parent);
+	XLALFree(active);
+	return nclusters;
+}
+
+
+/* start time and index of a tile, for ordering tiles by start time */
+struct tile_key {
+	double start;
+	size_t index;
+};
+
+
+static int compare_tile_key(const void *a, const void *b)
+{
+	const struct tile_key *ka = a;
+	const struct tile_key *kb = b;
+
+	if(ka->start != kb->start)
+		return ka->start > kb->start ? 1 : -1;
+	return (ka->index > kb->index) - (ka->index < kb->index);
+}
+
+
+/**
+ * Partition time-frequency tiles into clusters, as excess power triggers
+ * are clustered by lalapps_bucluster:  two tiles, or clusters of tiles,
+ * are merged if their time intervals overlap and their frequency bands
+ * overlap, each cluster being represented by the smallest box enclosing
+ * its tiles, until no two clusters' boxes overlap.  An overlap test
+ * tolerates gaps of up to time_window seconds and freq_window Hz;  with
+ * both zero, boxes that only touch do not overlap.
+ *
+ * Tile i spans [start[i], start[i] + duration[i]) in time (for example,
+ * seconds relative to an arbitrary epoch) and [flow[i], flow[i] +
+ * bandwidth[i]) in frequency;  the tiles need not be sorted.  The tiles
+ * are sorted once and then merged in a single sweep in order of start
+ * time.  The return value is a newly-allocated vector giving the cluster
+ * of each tile, clusters being numbered from 0 in order of their earliest
+ * tiles, or NULL on failure.
+ */
+UINT4Vector *XLALClusterTimeFrequencyTiles(
+	const REAL8Vector *start,
+	const REAL8Vector *duration,
+	const REAL8Vector *flow,
+	const REAL8Vector *bandwidth,
+	REAL8 time_window,
+	REAL8 freq_window
+)
+{
+	UINT4Vector *label;
+	struct tile_key *keys;
+	size_t *order;
+	double *end, *fhigh;
+	size_t n, i;
+
+	XLAL_CHECK_NULL(start && duration && flow && bandwidth, XLAL_EFAULT);
+	n = start->length;
+	XLAL_CHECK_NULL(duration->length == n && flow->length == n && bandwidth->length == n, XLAL_EBADLEN);
+	XLAL_CHECK_NULL(time_window >= 0 && freq_window >= 0, XLAL_EDOM);
+
+	label = XLALCreateUINT4Vector(n);
+	keys = XLALMalloc(n * sizeof(*keys));
+	order = XLALMalloc(n * sizeof(*order));
+	end = XLALMalloc(n * sizeof(*end));
+	fhigh = XLALMalloc(n * sizeof(*fhigh));
+	if(!label || !keys || !order || !end || !fhigh) {
+		XLALDestroyUINT4Vector(label);
+		XLALFree(keys);
+		XLALFree(order);
+		XLALFree(end);
+		XLALFree(fhigh);
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	}
+
+	for(i = 0; i < n; i++) {
+		keys[i].start = start->data[i];
+		keys[i].index = i;
+		end[i] = start->data[i] + duration->data[i];
+		fhigh[i] = flow->data[i] + bandwidth->data[i];
+	}
+	qsort(keys, n, sizeof(*keys), compare_tile_key);
+	for(i = 0; i < n; i++)
+		order[i] = keys[i].index;
+
+	if(n && cluster_tiles(n, order, start->data, end, flow->data, fhigh, time_window, freq_window, label->data) < 0) {
+		XLALDestroyUINT4Vector(label);
+		label = NULL;
+	}
+
+	XLALFree(keys);
+	XLALFree(order);
+	XLALFree(end);
+	XLALFree(fhigh);
+	if(!label)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return label;
+}
+
+
+/* running summary of one cluster of tiles */
+struct tile_cluster {
+	INT8 start;
+	double end;
+	double flow;
+	double fhigh;
+	double amplitude;
+	double snr2;
+	double snr2_peak_time;
+	size_t loudest;
+	int same_tile;
+};
+
+
+/**
+ * Cluster the events of a SnglBurstColumns structure as excess power
+ * triggers are clustered, with the overlap criteria of
+ * XLALClusterTimeFrequencyTiles(), in one sort and one sweep.  Each
+ * cluster is described by its most confident event, whose row is kept
+ * and whose confidence and \f$\chi^{2}\f$ are the cluster's, with the
+ * time interval and frequency band of the smallest box enclosing its
+ * events, their summed h_rss, their SNRs summed in quadrature, and the
+ * SNR\f$^{2}\f$-weighted mean of their peak times.  A cluster of
+ * identical tiles is just its most confident event.  The rows of the
+ * events that are merged away are freed.  On return the columns are in
+ * order of start time.  Returns the number of clusters, or < 0 on failure.
+ *
+ * All the events are assumed to come from one channel of one instrument.
+ */
+long XLALSnglBurstColumnsClusterByTile(SnglBurstColumns *cols, double time_window, double freq_window)
+{
+	const size_t n = cols->length;
+	struct tile_cluster *clusters;
+	size_t *order;
+	double *start, *end, *flow, *fhigh;
+	UINT4 *label;
+	INT8 epoch;
+	long nclusters;
+	size_t seen = 0;
+	size_t i;
+
+	XLAL_CHECK(time_window >= 0 && freq_window >= 0, XLAL_EDOM);
+	if(!n)
+		return 0;
+
+	if(sort_columns(cols, cols->start_time, NULL) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	epoch = cols->start_time[0];
+
+	clusters = XLALMalloc(n * sizeof(*clusters));
+	order = XLALMalloc(n * sizeof(*order));
+	start = XLALMalloc(n * sizeof(*start));
+	end = XLALMalloc(n * sizeof(*end));
+	flow = XLALMalloc(n * sizeof(*flow));
+	fhigh = XLALMalloc(n * sizeof(*fhigh));
+	label = XLALMalloc(n * sizeof(*label));
+	if(!clusters || !order || !start || !end || !flow || !fhigh || !label) {
+		nclusters = -1;
+		XLALSetErrno(XLAL_ENOMEM);
+		goto done;
+	}
+
+	/* times relative to the earliest start, to preserve precision */
+	for(i = 0; i < n; i++) {
+		order[i] = i;
+		start[i] = (cols->start_time[i] - epoch) * 1e-9;
+		end[i] = start[i] + cols->duration[i];
+		flow[i] = cols->central_freq[i] - cols->bandwidth[i] / 2.0;
+		fhigh[i] = cols->central_freq[i] + cols->bandwidth[i] / 2.0;
+	}
+
+	nclusters = cluster_tiles(n, order, start, end, flow, fhigh, time_window, freq_window, label);
+	if(nclusters < 0)
+		goto done;
+
+	/* summarize the clusters */
+	for(i = 0; i < n; i++) {
+		struct tile_cluster *c = &clusters[label[i]];
+		const double snr2 = (double) cols->snr[i] * cols->snr[i];
+		const double peak = (cols->peak_time[i] - epoch) * 1e-9;
+		if(label[i] == seen) {
+			/* first event of the next cluster */
+			seen++;
+			c->start = cols->start_time[i];
+			c->end = end[i];
+			c->flow = flow[i];
+			c->fhigh = fhigh[i];
+			c->amplitude = 0;
+			c->snr2 = 0;
+			c->snr2_peak_time = 0;
+			c->loudest = i;
+			c->same_tile = 1;
+		} else {
+			const size_t l = c->loudest;
+			c->same_tile &= cols->start_time[i] == cols->start_time[l] && cols->duration[i] == cols->duration[l] && cols->central_freq[i] == cols->central_freq[l] && cols->bandwidth[i] == cols->bandwidth[l];
+			if(end[i] > c->end)
+				c->end = end[i];
+			if(flow[i] < c->flow)
+				c->flow = flow[i];
+			if(fhigh[i] > c->fhigh)
+				c->fhigh = fhigh[i];
+			if(cols->confidence[i] > cols->confidence[l])
+				c->loudest = i;
+		}
+		c->amplitude += cols->amplitude[i];
+		c->snr2 += snr2;
+		c->snr2_peak_time += snr2 * peak;
+	}
+
+	/* free the rows merged away, and write each cluster into the slot
+	 * of its number.  a cluster's slot precedes its events, and holds
+	 * either its own first event or an event of an earlier cluster,
+	 * so no slot is overwritten before it has been read */
+	for(i = 0; i < n; i++)
+		if(i != clusters[label[i]].loudest)
+			XLALDestroySnglBurst(cols->row[i]);
+	for(i = 0; i < (size_t) nclusters; i++) {
+		const struct tile_cluster *c = &clusters[i];
+		copy_columns_row(cols, i, c->loudest);
+		if(c->same_tile)
+			continue;
+		cols->start_time[i] = c->start;
+		cols->duration[i] = c->end - (c->start - epoch) * 1e-9;
+		cols->central_freq[i] = (c->flow + c->fhigh) / 2.0;
+		cols->bandwidth[i] = c->fhigh - c->flow;
+		cols->amplitude[i] = c->amplitude;
+		cols->snr[i] = sqrt(c->snr2);
+		if(c->snr2 > 0)
+			cols->peak_time[i] = epoch + (INT8) llround(c->snr2_peak_time / c->snr2 * 1e9);
+	}
+	cols->length = nclusters;
+
+done:
+	XLALFree(clusters);
+	XLALFree(order);
+	XLALFree(start);
+	XLALFree(end);
+	XLALFree(flow);
+	XLALFree(fhigh);
+	XLALFree(label);
+	if(nclusters < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return nclusters;
+}
+
+
+/* writes one column as a 1-D dataset */
+static int write_h5_column(LALH5File *file, const char *name, LALTYPECODE type, size_t length, void *data)
+{
+	LALH5Dataset *dset = XLALH5DatasetAlloc1D(file, name, type, length);
+	if(!dset)
+		XLAL_ERROR(XLAL_EFUNC);
+	if(XLALH5DatasetWrite(dset, data) < 0) {
+		XLALH5DatasetFree(dset);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+	XLALH5DatasetFree(dset);
+	return 0;
+}
+
+
+/**
+ * Write the numeric columns of a SnglBurstColumns structure to an HDF5
+ * file or group, one 1-D dataset per column with the sngl_burst column
+ * names.  Each column is written with a single call, without formatting
+ * rows;  start_time and peak_time are written as integer GPS nanoseconds.
+ */
+int XLALH5FileWriteSnglBurstColumns(LALH5File *file, const SnglBurstColumns *cols)
+{
+	XLAL_CHECK(file && cols, XLAL_EFAULT);
+	XLAL_CHECK(cols->length > 0, XLAL_EINVAL, "no events to write");
+
+	if(write_h5_column(file, "process_id", LAL_I8_TYPE_CODE, cols->length, cols->process_id) < 0
+	|| write_h5_column(file, "event_id", LAL_I8_TYPE_CODE, cols->length, cols->event_id) < 0
+	|| write_h5_column(file, "start_time", LAL_I8_TYPE_CODE, cols->length, cols->start_time) < 0
+	|| write_h5_column(file, "peak_time", LAL_I8_TYPE_CODE, cols->length, cols->peak_time) < 0
+	|| write_h5_column(file, "duration", LAL_S_TYPE_CODE, cols->length, cols->duration) < 0
+	|| write_h5_column(file, "central_freq", LAL_S_TYPE_CODE, cols->length, cols->central_freq) < 0
+	|| write_h5_column(file, "bandwidth", LAL_S_TYPE_CODE, cols->length, cols->bandwidth) < 0
+	|| write_h5_column(file, "amplitude", LAL_S_TYPE_CODE, cols->length, cols->amplitude) < 0
+	|| write_h5_column(file, "snr", LAL_S_TYPE_CODE, cols->length, cols->snr) < 0
+	|| write_h5_column(file, "confidence", LAL_S_TYPE_CODE, cols->length, cols->confidence) < 0
+	|| write_h5_column(file, "chisq", LAL_D_TYPE_CODE, cols->length, cols->chisq) < 0
+	|| write_h5_column(file, "chisq_dof", LAL_D_TYPE_CODE, cols->length, cols->chisq_dof) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	return 0;
+}
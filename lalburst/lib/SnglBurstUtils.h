@@ -23,6 +23,7 @@ extern "C" {
 #endif
 
 #include <lal/LIGOMetadataTables.h>
+#include <lal/H5FileIO.h>
 
 /*
  *
@@ -93,6 +94,97 @@ XLALSimBurstAssignIDs(
 	long event_id
 );
 
+/*
+ *
+ * time-frequency tile clustering
+ *
+ */
+
+
+UINT4Vector *
+XLALClusterTimeFrequencyTiles(
+	const REAL8Vector *start,
+	const REAL8Vector *duration,
+	const REAL8Vector *flow,
+	const REAL8Vector *bandwidth,
+	REAL8 time_window,
+	REAL8 freq_window
+);
+
+/*
+ *
+ * column-oriented sngl_burst tables
+ *
+ */
+
+
+#ifndef SWIG /* exclude from SWIG interface */
+
+/**
+ * A sngl_burst table stored by column.  Each numeric column is a
+ * contiguous array of length entries;  row[i] points to the SnglBurst the
+ * i-th entry was gathered from, which holds its string columns.  Times are
+ * integer GPS nanoseconds.
+ */
+typedef struct tagSnglBurstColumns {
+	size_t length;
+	SnglBurst **row;
+	long *process_id;
+	long *event_id;
+	INT8 *start_time;
+	INT8 *peak_time;
+	REAL4 *duration;
+	REAL4 *central_freq;
+	REAL4 *bandwidth;
+	REAL4 *amplitude;
+	REAL4 *snr;
+	REAL4 *confidence;
+	REAL8 *chisq;
+	REAL8 *chisq_dof;
+} SnglBurstColumns;
+
+SnglBurstColumns *
+XLALCreateSnglBurstColumns(
+	SnglBurst *head
+);
+
+void
+XLALDestroySnglBurstColumns(
+	SnglBurstColumns *cols
+);
+
+SnglBurst **
+XLALSnglBurstColumnsToTable(
+	SnglBurst **head,
+	const SnglBurstColumns *cols
+);
+
+int
+XLALSnglBurstColumnsSortByPeakTimeAndSNR(
+	SnglBurstColumns *cols
+);
+
+size_t
+XLALSnglBurstColumnsClusterByPeakTime(
+	SnglBurstColumns *cols,
+	double window
+);
+
+long
+XLALSnglBurstColumnsClusterByTile(
+	SnglBurstColumns *cols,
+	double time_window,
+	double freq_window
+);
+
+int
+XLALH5FileWriteSnglBurstColumns(
+	LALH5File *file,
+	const SnglBurstColumns *cols
+);
+
+#endif /* SWIG */
+
 #ifdef  __cplusplus
 }
 #endif
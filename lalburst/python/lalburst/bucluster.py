@@ -27,15 +27,22 @@
 from __future__ import print_function
 
 
+import functools
 import math
 import sys
 
 
+import lal
 from ligo.lw import lsctables
 from ligo.lw.utils import process as ligolw_process
 from ligo.lw.utils import search_summary as ligolw_search_summary
 from ligo import segments
 from . import snglcluster
+try:
+	from .lalburst import ClusterTimeFrequencyTiles
+except ImportError:
+	# SWIG bindings not built
+	ClusterTimeFrequencyTiles = None
 
 
 __author__ = "Kipp Cannon <kipp.cannon@ligo.org>"
@@ -257,6 +264,44 @@ def ExcessPowerClusterFunc(a, b):
 	return a
 
 
+def ExcessPowerGroupFunc(sngl_burst_table):
+	"""
+	Partition the excess power triggers into the clusters that
+	snglcluster.cluster_events() would arrive at using
+	ExcessPowerTestFunc() and ExcessPowerClusterFunc(), using the
+	sweep-line tile clustering in the C library.  The return value is
+	a list of clusters, each a list of triggers in order of increasing
+	start time.  Returns None if the C library is not available.
+	"""
+	if ClusterTimeFrequencyTiles is None:
+		return None
+
+	groups = {}
+	for row in sngl_burst_table:
+		groups.setdefault((row.ifo, row.channel, row.search), []).append(row)
+
+	clusters = []
+	for rows in groups.values():
+		rows.sort(key = lambda row: row.start)
+		offset = rows[0].start
+		start = lal.CreateREAL8Vector(len(rows))
+		duration = lal.CreateREAL8Vector(len(rows))
+		flow = lal.CreateREAL8Vector(len(rows))
+		bandwidth = lal.CreateREAL8Vector(len(rows))
+		for i, row in enumerate(rows):
+			band = row.band
+			start.data[i] = float(row.start - offset)
+			duration.data[i] = row.duration
+			flow.data[i] = band[0]
+			bandwidth.data[i] = abs(band)
+		labels = ClusterTimeFrequencyTiles(start, duration, flow, bandwidth, 0., 0.)
+		group_clusters = [[] for i in range(max(labels.data) + 1)]
+		for label, row in zip(labels.data, rows):
+			group_clusters[label].append(row)
+		clusters.extend(group_clusters)
+	return clusters
+
+
 def OmegaClusterFunc(a, b):
 	"""
 	Modify a in place to be a cluster constructed from a and b.  The
@@ -348,6 +393,7 @@ def bucluster(
 	clusterfunc,
 	sortkeyfunc = None,
 	bailoutfunc = None,
+	groupfunc = None,
 	verbose = False
 ):
 	"""
@@ -360,6 +406,12 @@ def bucluster(
 	If the document does not contain a sngl_burst table, then the
 	document is not modified (including no modifications to the process
 	metadata tables).
+
+	If groupfunc is not None it is given the sngl_burst table and may
+	return the list of clusters, each a list of events, that the
+	clustering would produce.  Each cluster is then reduced to a single
+	event with clusterfunc in one pass.  If groupfunc returns None the
+	pair-wise clustering with testfunc is used instead.
 	"""
 
 	#
@@ -387,7 +439,14 @@ def bucluster(
 	# Cluster
 	#
 
-	table_changed = snglcluster.cluster_events(sngl_burst_table, testfunc, clusterfunc, sortkeyfunc = sortkeyfunc, bailoutfunc = bailoutfunc, verbose = verbose)
+	clusters = groupfunc(sngl_burst_table) if groupfunc is not None else None
+	if clusters is not None:
+		if verbose:
+			print("clustering %d events into %d clusters ..." % (len(sngl_burst_table), len(clusters)), file=sys.stderr)
+		table_changed = len(clusters) != len(sngl_burst_table)
+		sngl_burst_table[:] = [functools.reduce(clusterfunc, cluster) for cluster in clusters]
+	else:
+		table_changed = snglcluster.cluster_events(sngl_burst_table, testfunc, clusterfunc, sortkeyfunc = sortkeyfunc, bailoutfunc = bailoutfunc, verbose = verbose)
 
 	#
 	# Postprocess candidates
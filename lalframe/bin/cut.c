@@ -33,7 +33,9 @@
  * from each `file` and writes frames containing these channels only to the
  * standard output.  If no `file` argument is specified, or if a file argument
  * is a single dash (`-`), `lalfr-cut` reads from the standard input.  The
- * channels specified by list are comma-delimited channel names.
+ * channels specified by list are comma-delimited channel names.  The data of
+ * the selected channels are copied in their compressed form, without being
+ * decompressed and recompressed.
  *
  * ### Example
  *
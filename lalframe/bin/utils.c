@@ -127,7 +127,9 @@ int copychannels(LALFrameUFrameH * frame, LALFrameUFrFile * frfile,
 
     toc = XLALFrameUFrTOCRead(frfile);
 
-    /* loop over channels in input file */
+    /* loop over channels in input file; the channels are added to the
+     * frame as read, so their data vectors are carried over in their
+     * compressed form rather than being expanded and recompressed */
 
     nadc = XLALFrameUFrTOCQueryAdcN(toc);
     for (adc = 0; adc < nadc; ++adc) {
@@ -137,7 +139,7 @@ int copychannels(LALFrameUFrameH * frame, LALFrameUFrFile * frfile,
         if (match && strcmp(name, match))
             continue;   /*does not match */
         channel = XLALFrameUFrChanRead(frfile, name, pos);
-        copychannel(frame, channel, ADC_CHAN_TYPE);
+        XLALFrameUFrameHFrChanAdd(frame, channel);
         XLALFrameUFrChanFree(channel);
     }
 
@@ -149,7 +151,7 @@ int copychannels(LALFrameUFrameH * frame, LALFrameUFrFile * frfile,
         if (match && strcmp(name, match))
             continue;   /*does not match */
         channel = XLALFrameUFrChanRead(frfile, name, pos);
-        copychannel(frame, channel, PROC_CHAN_TYPE);
+        XLALFrameUFrameHFrChanAdd(frame, channel);
         XLALFrameUFrChanFree(channel);
     }
 
@@ -161,7 +163,7 @@ int copychannels(LALFrameUFrameH * frame, LALFrameUFrFile * frfile,
         if (match && strcmp(name, match))
             continue;   /*does not match */
         channel = XLALFrameUFrChanRead(frfile, name, pos);
-        copychannel(frame, channel, SIM_CHAN_TYPE);
+        XLALFrameUFrameHFrChanAdd(frame, channel);
         XLALFrameUFrChanFree(channel);
     }
 
@@ -169,6 +171,9 @@ int copychannels(LALFrameUFrameH * frame, LALFrameUFrFile * frfile,
     return 0;
 }
 
+/* copies a channel into a frame with its data vector expanded; only
+ * needed when the data are to be modified, as it costs a decompression of
+ * the input and a recompression of the output */
 int copychannel(LALFrameUFrameH * frame, LALFrameUFrChan * channel,
     int chantype)
 {
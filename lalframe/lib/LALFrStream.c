@@ -91,6 +91,14 @@
  * current frame stream position.  The frame stream can later be restored to
  * this position using XLALFrStreamSetpos().
  *
+ * Setting the ::LAL_FR_STREAM_READAHEAD_MODE bit of the mode starts a
+ * background thread that reads the next few local frame files of the stream
+ * ahead of time, so that opening them when the stream crosses a file
+ * boundary does not wait on the disk or network filesystem.  The number of
+ * files read ahead is set with XLALFrStreamSetReadAheadDepth().  The files
+ * themselves are still opened, checked, and decoded by the calling thread,
+ * so the behaviour of the stream is otherwise unchanged.
+ *
  * @{
  */
 
@@ -111,9 +119,158 @@ int gethostname(char *name, int len);
 #include <lal/LALFrameIO.h>
 #include <lal/LALFrStream.h>
 
+#ifdef LAL_PTHREAD_LOCK
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
 /* INTERNAL ROUTINES */
 /** @cond */
 
+/* size of the blocks in which frame files are read ahead */
+#define LAL_FR_STREAM_READAHEAD_BLOCK (1 << 20)
+
+/* state of the read-ahead thread of a stream */
+struct tagLALFrStreamReadAhead {
+#ifdef LAL_PTHREAD_LOCK
+    pthread_t thread;
+    pthread_mutex_t mutex;      /* protects the fields below */
+    pthread_cond_t cond;        /* signalled when the fields below change */
+#endif
+    const LALCache *cache;      /* cache of the stream; not modified while reading ahead */
+    UINT4 next;                 /* index of the next file to read ahead */
+    UINT4 limit;                /* files with index below limit may be read ahead */
+    UINT4 depth;                /* number of files to read ahead of the current file */
+    int quit;                   /* set to stop the thread */
+};
+
+#ifdef LAL_PTHREAD_LOCK
+
+/* local path of a frame file URL, or NULL if the file is not local */
+static const char *XLALFrStreamReadAheadPath(const char *url)
+{
+    if (strncmp(url, "file://", 7) == 0) {
+        url += 7;
+        if (strncmp(url, "localhost/", 10) == 0)
+            url += 9;
+        return *url == '/' ? url : NULL;
+    }
+    return strstr(url, "://") ? NULL : url;
+}
+
+/* reads upcoming files through once, so that they are in the page cache
+ * when the stream opens them; only plain file I/O is done here, as the
+ * frame libraries are not thread-safe */
+static void *XLALFrStreamReadAheadThread(void *arg)
+{
+    struct tagLALFrStreamReadAhead *ra = arg;
+    char *buf = LALMalloc(LAL_FR_STREAM_READAHEAD_BLOCK);
+    if (!buf)
+        return NULL;
+    pthread_mutex_lock(&ra->mutex);
+    while (!ra->quit) {
+        const char *path;
+        UINT4 fnum;
+        int fd;
+        if (ra->next >= ra->limit || ra->next >= ra->cache->length) {
+            pthread_cond_wait(&ra->cond, &ra->mutex);
+            continue;
+        }
+        fnum = ra->next++;
+        path = XLALFrStreamReadAheadPath(ra->cache->list[fnum].url);
+        pthread_mutex_unlock(&ra->mutex);
+        fd = path ? open(path, O_RDONLY) : -1;
+        pthread_mutex_lock(&ra->mutex);
+        if (fd < 0)
+            continue;
+        /* stop reading if the stream has moved on to other files */
+        while (!ra->quit && fnum < ra->limit && ra->next > fnum) {
+            ssize_t n;
+            pthread_mutex_unlock(&ra->mutex);
+            n = read(fd, buf, LAL_FR_STREAM_READAHEAD_BLOCK);
+            pthread_mutex_lock(&ra->mutex);
+            if (n <= 0)
+                break;
+        }
+        close(fd);
+    }
+    pthread_mutex_unlock(&ra->mutex);
+    LALFree(buf);
+    return NULL;
+}
+
+#endif /* LAL_PTHREAD_LOCK */
+
+/* tells the read-ahead thread which file the stream has opened */
+static void XLALFrStreamReadAheadUpdate(LALFrStream * stream)
+{
+    struct tagLALFrStreamReadAhead *ra = stream->readahead;
+    if (!ra)
+        return;
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_lock(&ra->mutex);
+#endif
+    ra->limit = stream->fnum + 1 + ra->depth;
+    if (ra->next <= stream->fnum || ra->next > ra->limit)
+        ra->next = stream->fnum + 1;
+#ifdef LAL_PTHREAD_LOCK
+    pthread_cond_signal(&ra->cond);
+    pthread_mutex_unlock(&ra->mutex);
+#endif
+}
+
+static void XLALFrStreamReadAheadStop(LALFrStream * stream)
+{
+    struct tagLALFrStreamReadAhead *ra = stream->readahead;
+    if (!ra)
+        return;
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_lock(&ra->mutex);
+    ra->quit = 1;
+    pthread_cond_signal(&ra->cond);
+    pthread_mutex_unlock(&ra->mutex);
+    pthread_join(ra->thread, NULL);
+    pthread_cond_destroy(&ra->cond);
+    pthread_mutex_destroy(&ra->mutex);
+#endif
+    LALFree(ra);
+    stream->readahead = NULL;
+}
+
+static int XLALFrStreamReadAheadStart(LALFrStream * stream, UINT4 depth)
+{
+#ifdef LAL_PTHREAD_LOCK
+    struct tagLALFrStreamReadAhead *ra;
+    if (stream->readahead) {
+        stream->readahead->depth = depth;
+        XLALFrStreamReadAheadUpdate(stream);
+        return 0;
+    }
+    ra = LALCalloc(1, sizeof(*ra));
+    if (!ra)
+        XLAL_ERROR(XLAL_ENOMEM);
+    ra->cache = stream->cache;
+    ra->depth = depth;
+    ra->next = stream->fnum + 1;
+    ra->limit = stream->fnum + 1 + depth;
+    pthread_mutex_init(&ra->mutex, NULL);
+    pthread_cond_init(&ra->cond, NULL);
+    if (pthread_create(&ra->thread, NULL, XLALFrStreamReadAheadThread, ra)) {
+        pthread_cond_destroy(&ra->cond);
+        pthread_mutex_destroy(&ra->mutex);
+        LALFree(ra);
+        XLAL_ERROR(XLAL_EFAILED, "Could not create read-ahead thread");
+    }
+    stream->readahead = ra;
+#else
+    (void)stream;
+    (void)depth;
+    XLAL_PRINT_WARNING("Frame stream read-ahead requires POSIX threads; ignoring");
+#endif
+    return 0;
+}
+
 static int XLALFrStreamFileClose(LALFrStream * stream)
 {
     XLALFrFileClose(stream->file);
@@ -146,6 +303,7 @@ static int XLALFrStreamFileOpen(LALFrStream * stream, UINT4 fnum)
         }
     }
     XLALFrFileQueryGTime(&stream->epoch, stream->file, 0);
+    XLALFrStreamReadAheadUpdate(stream);
     return 0;
 }
 
@@ -170,6 +328,7 @@ static int XLALFrStreamFileOpen(LALFrStream * stream, UINT4 fnum)
 int XLALFrStreamClose(LALFrStream * stream)
 {
     if (stream) {
+        XLALFrStreamReadAheadStop(stream);
         XLALDestroyCache(stream->cache);
         XLALFrStreamFileClose(stream);
         LALFree(stream);
@@ -313,7 +472,9 @@ int XLALFrStreamGetMode(LALFrStream * stream)
  * ::LAL_FR_STREAM_SILENT_MODE to suppress the warning and info messages but
  * still cause routines to fail when data is not available.
  * To enable frame file checksum checking, set the ::LAL_FR_STREAM_CHECKSUM_MODE
- * bit.
+ * bit.  To read upcoming frame files ahead of time in a background thread,
+ * set the ::LAL_FR_STREAM_READAHEAD_MODE bit (see
+ * XLALFrStreamSetReadAheadDepth()).
  *
  * @note The default value  ::LAL_FR_STREAM_DEFAULT_MODE is assumed initially,
  * but this is not necessarily the recommended mode --- it is adopted for
@@ -327,12 +488,50 @@ int XLALFrStreamGetMode(LALFrStream * stream)
 int XLALFrStreamSetMode(LALFrStream * stream, int mode)
 {
     stream->mode = mode;
+    /* start or stop reading ahead */
+    if (!(mode & LAL_FR_STREAM_READAHEAD_MODE))
+        XLALFrStreamReadAheadStop(stream);
+    else if (!stream->readahead
+        && XLALFrStreamReadAheadStart(stream, LAL_FR_STREAM_READAHEAD_DEFAULT_DEPTH) < 0)
+        XLAL_ERROR(XLAL_EFUNC);
     /* if checksum mode is turned on, do checksum on current file */
     if ((mode & LAL_FR_STREAM_CHECKSUM_MODE) && (stream->file))
         return XLALFrFileCksumValid(stream->file) ? 0 : -1;
     return 0;
 }
 
+/**
+ * @brief Sets the number of frame files a LALFrStream reads ahead
+ * @details
+ * In ::LAL_FR_STREAM_READAHEAD_MODE a background thread reads the
+ * @p depth frame files following the current file of the stream, so that
+ * they are already in the operating system's page cache when the stream
+ * opens them.  Only local files (plain paths or \c file:// URLs) are read
+ * ahead.  This routine sets the ::LAL_FR_STREAM_READAHEAD_MODE bit of the
+ * stream mode if @p depth is non-zero, and clears it otherwise.
+ *
+ * Reading ahead requires that LAL was built with POSIX thread support;
+ * otherwise a warning is printed and the stream reads files as usual.
+ * @param stream Pointer to a \c LALFrStream structure.
+ * @param depth Number of files to read ahead, or 0 to stop reading ahead.
+ * @retval 0 Success.
+ * @retval <0 Failure.
+ */
+int XLALFrStreamSetReadAheadDepth(LALFrStream * stream, UINT4 depth)
+{
+    if (!stream)
+        XLAL_ERROR(XLAL_EFAULT);
+    if (!depth) {
+        stream->mode &= ~LAL_FR_STREAM_READAHEAD_MODE;
+        XLALFrStreamReadAheadStop(stream);
+        return 0;
+    }
+    stream->mode |= LAL_FR_STREAM_READAHEAD_MODE;
+    if (XLALFrStreamReadAheadStart(stream, depth) < 0)
+        XLAL_ERROR(XLAL_EFUNC);
+    return 0;
+}
+
 /** @} */
 
 /**
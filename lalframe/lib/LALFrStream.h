@@ -85,9 +85,13 @@ typedef enum tagLALFrStreamMode {
     LAL_FR_STREAM_IGNOREGAP_MODE = 4,   /**< ignore gaps in data */
     LAL_FR_STREAM_IGNORETIME_MODE = 8,  /**< ignore invalid times requested */
     LAL_FR_STREAM_DEFAULT_MODE = 15,    /**< ignore time/gaps but report warnings & info */
-    LAL_FR_STREAM_CHECKSUM_MODE = 16    /**< ensure that file checksums are OK */
+    LAL_FR_STREAM_CHECKSUM_MODE = 16,   /**< ensure that file checksums are OK */
+    LAL_FR_STREAM_READAHEAD_MODE = 32   /**< read upcoming frame files ahead in a background thread */
 } LALFrStreamMode;
 
+/** Default number of frame files read ahead in ::LAL_FR_STREAM_READAHEAD_MODE */
+#define LAL_FR_STREAM_READAHEAD_DEFAULT_DEPTH 2
+
 /**
  * This structure details the state of the frame stream.  The contents are
  * private; you should not tamper with them!
@@ -100,6 +104,7 @@ typedef struct tagLALFrStream {
     UINT4 fnum;
     LALFrFile *file;
     INT4 pos;
+    struct tagLALFrStreamReadAhead *readahead;
 } LALFrStream;
 
 /**
@@ -120,6 +125,7 @@ LALFrStream *XLALFrStreamOpen(const char *dirname, const char *pattern);
 int XLALFrStreamClose(LALFrStream * stream);
 int XLALFrStreamGetMode(LALFrStream * stream);
 int XLALFrStreamSetMode(LALFrStream * stream, int mode);
+int XLALFrStreamSetReadAheadDepth(LALFrStream * stream, UINT4 depth);
 
 int XLALFrStreamState(LALFrStream * stream);
 int XLALFrStreamEnd(LALFrStream * stream);
@@ -234,6 +240,11 @@ REAL8TimeSeries *XLALFrStreamInputREAL8TimeSeries(LALFrStream * stream,
 COMPLEX16TimeSeries *XLALFrStreamInputCOMPLEX16TimeSeries(LALFrStream *
     stream, const char *channel, const LIGOTimeGPS * start, REAL8 duration,
     size_t lengthlimit);
+#ifndef SWIG /* exclude from SWIG interface */
+int XLALFrStreamInputREAL8TimeSeriesList(REAL8TimeSeries ** series,
+    LALFrStream * stream, const LALStringVector * chnames,
+    const LIGOTimeGPS * start, REAL8 duration, size_t lengthlimit);
+#endif /* SWIG */
 
 REAL8FrequencySeries *XLALFrStreamInputREAL8FrequencySeries(LALFrStream *
     stream, const char *chname, const LIGOTimeGPS * epoch);
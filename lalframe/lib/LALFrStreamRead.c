@@ -26,6 +26,7 @@
  */
 
 #include <math.h>
+#include <string.h>
 
 #include <lal/LALStdlib.h>
 #include <lal/Date.h>
@@ -556,6 +557,265 @@ COMPLEX16TimeSeries *XLALFrStreamInputCOMPLEX16TimeSeries(LALFrStream *
     return series;
 }
 
+/* reads a frame of a channel, converting it to REAL8 */
+static REAL8TimeSeries *XLALFrFileInputREAL8TimeSeries(LALFrFile * frfile,
+    const char *chname, size_t pos)
+{
+    REAL8TimeSeries *series = NULL;
+
+#define FRFILE_INPUTTS(origtype) \
+    do { \
+        origtype ## TimeSeries *origin; \
+        origin = XLALFrFileRead##origtype##TimeSeries(frfile, chname, pos); \
+        if (!origin) \
+            XLAL_ERROR_NULL(XLAL_EFUNC); \
+        series = XLALCreateREAL8TimeSeries(origin->name, &origin->epoch, origin->f0, origin->deltaT, &origin->sampleUnits, origin->data->length); \
+        if (series) \
+            COPY_S2S(series->data->data, origin->data->data, origin->data->length); \
+        XLALDestroy##origtype##TimeSeries(origin); \
+        if (!series) \
+            XLAL_ERROR_NULL(XLAL_EFUNC); \
+    } while (0)
+
+    switch (XLALFrFileQueryChanType(frfile, chname, pos)) {
+    case LAL_I2_TYPE_CODE:
+        FRFILE_INPUTTS(INT2);
+        break;
+    case LAL_I4_TYPE_CODE:
+        FRFILE_INPUTTS(INT4);
+        break;
+    case LAL_I8_TYPE_CODE:
+        FRFILE_INPUTTS(INT8);
+        break;
+    case LAL_U2_TYPE_CODE:
+        FRFILE_INPUTTS(UINT2);
+        break;
+    case LAL_U4_TYPE_CODE:
+        FRFILE_INPUTTS(UINT4);
+        break;
+    case LAL_U8_TYPE_CODE:
+        FRFILE_INPUTTS(UINT8);
+        break;
+    case LAL_S_TYPE_CODE:
+        FRFILE_INPUTTS(REAL4);
+        break;
+    case LAL_D_TYPE_CODE:
+        series = XLALFrFileReadREAL8TimeSeries(frfile, chname, pos);
+        if (!series)
+            XLAL_ERROR_NULL(XLAL_EFUNC);
+        break;
+    case LAL_C_TYPE_CODE:
+    case LAL_Z_TYPE_CODE:
+        XLAL_PRINT_ERROR("Cannot convert complex type to float type");
+#if __GNUC__ >= 7 && !defined __INTEL_COMPILER
+	__attribute__ ((fallthrough));
+#endif
+    default:
+        XLAL_ERROR_NULL(XLAL_ETYPE);
+    }
+
+#undef FRFILE_INPUTTS
+    return series;
+}
+
+/**
+ * @brief Reads several time series channels from a \c LALFrStream stream
+ * with a specified start time and duration in a single pass, and performs
+ * any needed type conversion.
+ * @details
+ * This routine is equivalent to calling XLALFrStreamInputREAL8TimeSeries()
+ * for each channel in turn, but each frame of the stream is visited only
+ * once: all the requested channels are read from a frame before moving on
+ * to the next, so that each frame file is opened and its table of contents
+ * read only once rather than once per channel.  The channels may have
+ * different sample rates and data types; each is converted to REAL8.
+ * If there is a gap in the data, all channels skip to the next contiguous
+ * set of data of the required duration.
+ * @param series Array of \c chnames->length pointers which on successful
+ * return point to new REAL8TimeSeries containing the data of each channel.
+ * @param stream Pointer to the \c LALFrStream stream.
+ * @param chnames Vector of the channel names to read.
+ * @param start Pointer to a LIGOTimeGPS structure specifying the start time.
+ * @param duration The duration of the data to read, in seconds.
+ * @param lengthlimit The maximum number of points to read per channel or 0
+ * for unlimited.
+ * @retval 0 Success.
+ * @retval <0 Failure; the contents of \c series are then set to NULL.
+ */
+int XLALFrStreamInputREAL8TimeSeriesList(REAL8TimeSeries ** series,
+    LALFrStream * stream, const LALStringVector * chnames,
+    const LIGOTimeGPS * start, double duration, size_t lengthlimit)
+{
+    const REAL8 fuzz = 0.1 / 16384.0;   /* smallest discernable time */
+    REAL8TimeSeries *buffer;
+    LIGOTimeGPS tend;
+    size_t *ncur = NULL;
+    size_t nleft;
+    INT8 tnow;
+    INT8 tbeg;
+    INT8 tmin = 0;
+    UINT4 nchan;
+    UINT4 c;
+    int gap = 0;
+    int errnum = XLAL_EFUNC;
+
+    XLAL_CHECK(series, XLAL_EFAULT);
+    XLAL_CHECK(stream, XLAL_EFAULT);
+    XLAL_CHECK(chnames && chnames->length, XLAL_EINVAL);
+    XLAL_CHECK(start, XLAL_EFAULT);
+    nchan = chnames->length;
+    for (c = 0; c < nchan; ++c)
+        series[c] = NULL;
+
+    if (XLALFrStreamSeek(stream, start))
+        XLAL_ERROR(XLAL_EFUNC);
+    XLAL_CHECK(!(stream->state & LAL_FR_STREAM_END), XLAL_EIO);
+    XLAL_CHECK(!(stream->state & LAL_FR_STREAM_ERR), XLAL_EIO);
+
+    /* number of points read so far into each series */
+    ncur = XLALCalloc(nchan, sizeof(*ncur));
+    if (!ncur)
+        XLAL_ERROR(XLAL_ENOMEM);
+
+    /* read the first frame of every channel, sizing each series from
+     * its sample interval as XLALFrStreamReadREAL8TimeSeries() does */
+    tnow = XLALGPSToINT8NS(&stream->epoch);
+    for (c = 0; c < nchan; ++c) {
+        size_t length;
+        size_t noff;
+        size_t ncpy;
+        INT8 tfirst;
+
+        buffer = XLALFrFileInputREAL8TimeSeries(stream->file,
+            chnames->data[c], stream->pos);
+        if (!buffer)
+            goto failure;
+        tbeg = XLALGPSToINT8NS(&buffer->epoch);
+
+        /* allow 1 millisecond padding for double precision */
+        if (tnow + 1000 < tbeg) {
+            XLALDestroyREAL8TimeSeries(buffer);
+            XLAL_PRINT_ERROR("Channel %s starts after the requested time",
+                chnames->data[c]);
+            errnum = XLAL_ETIME;
+            goto failure;
+        }
+        noff = ceil((1e-9 * (tnow - tbeg) - fuzz) / buffer->deltaT);
+        if (noff > buffer->data->length) {
+            XLALDestroyREAL8TimeSeries(buffer);
+            errnum = XLAL_ETIME;
+            goto failure;
+        }
+        tfirst = tbeg + floor(1e9 * noff * buffer->deltaT + 0.5);
+
+        length = duration / buffer->deltaT;
+        if (lengthlimit && (lengthlimit < length))
+            length = lengthlimit;
+        series[c] = XLALCreateREAL8TimeSeries(chnames->data[c], start,
+            buffer->f0, buffer->deltaT, &buffer->sampleUnits, length);
+        if (!series[c]) {
+            XLALDestroyREAL8TimeSeries(buffer);
+            goto failure;
+        }
+        XLALINT8NSToGPS(&series[c]->epoch, tfirst);
+
+        ncpy = buffer->data->length - noff < length ?
+            buffer->data->length - noff : length;
+        memcpy(series[c]->data->data, buffer->data->data + noff,
+            ncpy * sizeof(*buffer->data->data));
+        ncur[c] = ncpy;
+        XLALDestroyREAL8TimeSeries(buffer);
+    }
+
+    /* continue frame by frame while any channel requires data */
+    for (;;) {
+        nleft = 0;
+        for (c = 0; c < nchan; ++c)
+            nleft += series[c]->data->length - ncur[c];
+        if (!nleft)
+            break;
+
+        /* goto next frame */
+        if (XLALFrStreamNext(stream) < 0)
+            goto failure;
+        if (stream->state & LAL_FR_STREAM_END) {
+            XLAL_PRINT_ERROR
+                ("End of frame stream while %zd points remain to be read",
+                nleft);
+            errnum = XLAL_EIO;
+            goto failure;
+        }
+
+        /* a gap in the data restarts every channel, including those
+         * that were already complete, so that they stay aligned */
+        if (stream->state & LAL_FR_STREAM_GAP) {
+            gap = 1;
+            for (c = 0; c < nchan; ++c)
+                ncur[c] = 0;
+        }
+
+        for (c = 0; c < nchan; ++c) {
+            size_t need = series[c]->data->length - ncur[c];
+            size_t ncpy;
+            if (!need)
+                continue;
+            buffer = XLALFrFileInputREAL8TimeSeries(stream->file,
+                chnames->data[c], stream->pos);
+            if (!buffer)
+                goto failure;
+            if (ncur[c] == 0)
+                series[c]->epoch = buffer->epoch;
+            ncpy = buffer->data->length < need ? buffer->data->length : need;
+            memcpy(series[c]->data->data + ncur[c], buffer->data->data,
+                ncpy * sizeof(*buffer->data->data));
+            ncur[c] += ncpy;
+            XLALDestroyREAL8TimeSeries(buffer);
+        }
+    }
+    XLALFree(ncur);
+    ncur = NULL;
+
+    /* update stream start time so that it corresponds to the earliest
+     * sample not yet read from any of the channels */
+    for (c = 0; c < nchan; ++c) {
+        LIGOTimeGPS t = series[c]->epoch;
+        XLALGPSAdd(&t, series[c]->data->length * series[c]->deltaT);
+        if (c == 0 || XLALGPSToINT8NS(&t) < tmin)
+            tmin = XLALGPSToINT8NS(&t);
+    }
+    XLALINT8NSToGPS(&stream->epoch, tmin);
+
+    /* are we still within the current frame? */
+    XLALFrFileQueryGTime(&tend, stream->file, stream->pos);
+    XLALGPSAdd(&tend, XLALFrFileQueryDt(stream->file, stream->pos));
+    if (XLALGPSCmp(&tend, &stream->epoch) <= 0) {
+        /* advance a frame, suppressing gap warnings as
+         * XLALFrStreamGetREAL8TimeSeries() does */
+        int savemode = stream->mode;
+        LIGOTimeGPS saveepoch = stream->epoch;
+        stream->mode |= LAL_FR_STREAM_IGNOREGAP_MODE;
+        if (XLALFrStreamNext(stream) < 0) {
+            stream->mode = savemode;
+            goto failure;
+        }
+        if (!(stream->state & LAL_FR_STREAM_GAP))
+            stream->epoch = saveepoch;
+        stream->mode = savemode;
+    }
+
+    if (gap)
+        stream->state |= LAL_FR_STREAM_GAP;
+    return 0;
+
+  failure:
+    XLALFree(ncur);
+    for (c = 0; c < nchan; ++c) {
+        XLALDestroyREAL8TimeSeries(series[c]);
+        series[c] = NULL;
+    }
+    XLAL_ERROR(errnum);
+}
+
 /** @} */
 
 /**
@@ -24,9 +24,15 @@
 #include <unistd.h>
 #endif
 
+#ifdef HAVE_SYS_STAT_H
+#include <sys/types.h>
+#include <sys/stat.h>
+#endif
+
 #include <ctype.h>
 #include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <lal/LALDatatypes.h>
@@ -40,20 +46,236 @@
 #include <lal/LALFrameU.h>
 #include <lal/LALFrameIO.h>
 
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
+
 #ifndef HAVE_LOCALTIME_R
 #define localtime_r(timep, result) memcpy((result), localtime(timep), sizeof(struct tm))
 #endif
 
 /** @cond */
+/* start time and duration of one frame, as listed in the TOC */
+typedef struct tagLALFrFileFrameTime {
+    double gtimei;      /* integer part of the start time */
+    double gtimef;      /* fractional part of the start time */
+    double dt;
+} LALFrFileFrameTime;
+
+/* last channel queried, kept for the next read; queries on a const
+ * LALFrFile update it, so it is held outside of the LALFrFile itself */
+typedef struct tagLALFrFileChanCache {
+    LALFrameUFrChan *chan;
+    char *chname;
+    size_t chpos;
+} LALFrFileChanCache;
+
 struct tagLALFrFile {
     LALFrameUFrFile *file;
-    LALFrameUFrTOC *toc;
+    LALFrameUFrTOC *toc;        /* NULL if the frame times came from the TOC cache */
+    size_t nframe;
+    LALFrFileFrameTime *frames;
+    LALFrFileChanCache *chcache;
 };
 /** @endcond */
 
+/*
+ *
+ * Process-wide cache of the frame times listed in the TOC of each frame
+ * file, keyed by the file path and invalidated when the file is modified.
+ * Reopening a file that is in the cache does not read its TOC.
+ * The entries outlive any caller so are allocated with malloc() rather
+ * than LALMalloc(), and are released with XLALFrFileTOCCacheClear().
+ * If code must be POSIX thread safe then the cache is protected by a mutex.
+ *
+ */
+
+#ifdef HAVE_SYS_STAT_H
+
+/* maximum number of files in the cache; the oldest entries are replaced */
+#define LAL_FR_FILE_TOC_CACHE_SIZE 256
+
+typedef struct tagLALFrFileTOCCacheEntry {
+    char *path;
+    time_t mtime;
+    off_t size;
+    size_t nframe;
+    LALFrFileFrameTime *frames;
+} LALFrFileTOCCacheEntry;
+
+static LALFrFileTOCCacheEntry lalFrFileTOCCache[LAL_FR_FILE_TOC_CACHE_SIZE];
+static size_t lalFrFileTOCCacheNext = 0;
+
+#ifndef LAL_PTHREAD_LOCK        /* non-pthread-safe code */
+#define LAL_FR_FILE_TOC_CACHE_LOCK() ((void)0)
+#define LAL_FR_FILE_TOC_CACHE_UNLOCK() ((void)0)
+#else /* pthread safe code */
+static pthread_mutex_t lalFrFileTOCCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+#define LAL_FR_FILE_TOC_CACHE_LOCK() pthread_mutex_lock(&lalFrFileTOCCacheMutex)
+#define LAL_FR_FILE_TOC_CACHE_UNLOCK() pthread_mutex_unlock(&lalFrFileTOCCacheMutex)
+#endif /* end of pthread-safe code */
+
+/* copies the frame times of path into frfile if they are cached; returns 1 on a hit */
+static int XLALFrFileTOCCacheLookup(LALFrFile * frfile, const char *path,
+    const struct stat *buf)
+{
+    int hit = 0;
+    LAL_FR_FILE_TOC_CACHE_LOCK();
+    for (size_t i = 0; i < LAL_FR_FILE_TOC_CACHE_SIZE; ++i) {
+        LALFrFileTOCCacheEntry *entry = &lalFrFileTOCCache[i];
+        if (entry->path && strcmp(entry->path, path) == 0) {
+            if (entry->mtime == buf->st_mtime && entry->size == buf->st_size) {
+                frfile->frames = LALMalloc(entry->nframe * sizeof(*frfile->frames));
+                if (frfile->frames) {
+                    memcpy(frfile->frames, entry->frames, entry->nframe * sizeof(*frfile->frames));
+                    frfile->nframe = entry->nframe;
+                    hit = 1;
+                }
+            }
+            break;
+        }
+    }
+    LAL_FR_FILE_TOC_CACHE_UNLOCK();
+    return hit;
+}
+
+/* stores the frame times of frfile in the cache; failure is benign */
+static void XLALFrFileTOCCacheInsert(const LALFrFile * frfile,
+    const char *path, const struct stat *buf)
+{
+    LALFrFileTOCCacheEntry entry;
+    LALFrFileTOCCacheEntry *slot = NULL;
+
+    entry.path = malloc(strlen(path) + 1);
+    entry.frames = malloc(frfile->nframe * sizeof(*entry.frames));
+    if (!entry.path || !entry.frames) {
+        free(entry.path);
+        free(entry.frames);
+        return;
+    }
+    strcpy(entry.path, path);
+    memcpy(entry.frames, frfile->frames, frfile->nframe * sizeof(*entry.frames));
+    entry.nframe = frfile->nframe;
+    entry.mtime = buf->st_mtime;
+    entry.size = buf->st_size;
+
+    LAL_FR_FILE_TOC_CACHE_LOCK();
+    /* replace a stale entry for the same path, or else the oldest entry */
+    for (size_t i = 0; i < LAL_FR_FILE_TOC_CACHE_SIZE && !slot; ++i)
+        if (lalFrFileTOCCache[i].path && strcmp(lalFrFileTOCCache[i].path, path) == 0)
+            slot = &lalFrFileTOCCache[i];
+    if (!slot) {
+        slot = &lalFrFileTOCCache[lalFrFileTOCCacheNext];
+        lalFrFileTOCCacheNext = (lalFrFileTOCCacheNext + 1) % LAL_FR_FILE_TOC_CACHE_SIZE;
+    }
+    free(slot->path);
+    free(slot->frames);
+    *slot = entry;
+    LAL_FR_FILE_TOC_CACHE_UNLOCK();
+    return;
+}
+
+#endif /* HAVE_SYS_STAT_H */
+
+void XLALFrFileTOCCacheClear(void)
+{
+#ifdef HAVE_SYS_STAT_H
+    LAL_FR_FILE_TOC_CACHE_LOCK();
+    for (size_t i = 0; i < LAL_FR_FILE_TOC_CACHE_SIZE; ++i) {
+        free(lalFrFileTOCCache[i].path);
+        free(lalFrFileTOCCache[i].frames);
+        memset(&lalFrFileTOCCache[i], 0, sizeof(lalFrFileTOCCache[i]));
+    }
+    lalFrFileTOCCacheNext = 0;
+    LAL_FR_FILE_TOC_CACHE_UNLOCK();
+#endif
+    return;
+}
+
+/* reads the frame times from the TOC of frfile, which is kept open */
+static int XLALFrFileReadFrameTimes(LALFrFile * frfile)
+{
+    frfile->toc = XLALFrameUFrTOCRead(frfile->file);
+    if (!frfile->toc)
+        XLAL_ERROR(XLAL_EFUNC);
+    frfile->nframe = XLALFrameUFrTOCQueryNFrame(frfile->toc);
+    if (frfile->nframe == (size_t) (-1))
+        XLAL_ERROR(XLAL_EFUNC);
+    frfile->frames = LALMalloc(frfile->nframe * sizeof(*frfile->frames));
+    if (frfile->nframe && !frfile->frames)
+        XLAL_ERROR(XLAL_ENOMEM);
+    for (size_t pos = 0; pos < frfile->nframe; ++pos) {
+        LALFrFileFrameTime *frame = &frfile->frames[pos];
+        frame->gtimef = XLALFrameUFrTOCQueryGTimeModf(&frame->gtimei, frfile->toc, pos);
+        frame->dt = XLALFrameUFrTOCQueryDt(frfile->toc, pos);
+        if (XLAL_IS_REAL8_FAIL_NAN(frame->gtimef) || XLAL_IS_REAL8_FAIL_NAN(frame->dt))
+            XLAL_ERROR(XLAL_EFUNC);
+    }
+    return 0;
+}
+
+/* forgets the last channel queried */
+static void XLALFrFileChanClear(const LALFrFile * frfile)
+{
+    LALFrFileChanCache *chcache = frfile->chcache;
+    if (chcache->chan) {
+        XLALFrameUFrChanFree(chcache->chan);
+        chcache->chan = NULL;
+    }
+    LALFree(chcache->chname);
+    chcache->chname = NULL;
+    return;
+}
+
+/*
+ * Returns a channel owned by frfile: the type and length queries are
+ * typically followed by a read of the same channel, which then reuses
+ * the channel instead of reading it from the file a second time.
+ */
+static LALFrameUFrChan *XLALFrFileChanRead(const LALFrFile * frfile,
+    const char *chname, size_t pos)
+{
+    LALFrFileChanCache *chcache = frfile->chcache;
+    if (chcache->chan && chcache->chpos == pos && strcmp(chcache->chname, chname) == 0)
+        return chcache->chan;
+    XLALFrFileChanClear(frfile);
+    chcache->chan = XLALFrameUFrChanRead(frfile->file, chname, pos);
+    if (!chcache->chan)
+        return NULL;
+    chcache->chname = XLALStringDuplicate(chname);
+    if (!chcache->chname) {
+        XLALFrFileChanClear(frfile);
+        return NULL;
+    }
+    chcache->chpos = pos;
+    return chcache->chan;
+}
+
+/* as XLALFrFileChanRead() but the caller takes ownership of the channel */
+static LALFrameUFrChan *XLALFrFileChanTake(LALFrFile * frfile,
+    const char *chname, size_t pos)
+{
+    LALFrameUFrChan *channel = XLALFrFileChanRead(frfile, chname, pos);
+    frfile->chcache->chan = NULL;
+    XLALFrFileChanClear(frfile);
+    return channel;
+}
+
+/* frees a channel obtained from XLALFrFileChanTake(), but not one still owned by frfile */
+static void XLALFrFileChanRelease(LALFrFile * frfile, LALFrameUFrChan * channel)
+{
+    if (channel != frfile->chcache->chan)
+        XLALFrameUFrChanFree(channel);
+    return;
+}
+
 int XLALFrFileClose(LALFrFile * frfile)
 {
     if (frfile) {
+        if (frfile->chcache) {
+            XLALFrFileChanClear(frfile);
+            LALFree(frfile->chcache);
+        }
         if (frfile->file) {
             XLALFrameUFrFileClose(frfile->file);
             frfile->file = NULL;
@@ -62,6 +284,7 @@ int XLALFrFileClose(LALFrFile * frfile)
             XLALFrameUFrTOCFree(frfile->toc);
             frfile->toc = NULL;
         }
+        LALFree(frfile->frames);
         LALFree(frfile);
     }
     return 0;
@@ -108,41 +331,66 @@ LALFrFile *XLALFrFileOpenURL(const char *url)
      * if (!frfile)
      * XLAL_ERROR_NULL(XLAL_EIO, "Could not open frame file %s", path);
      */
-    frfile = LALMalloc(sizeof(*frfile));
+    frfile = LALCalloc(1, sizeof(*frfile));
     if (!frfile)
         XLAL_ERROR_NULL(XLAL_ENOMEM);
+    frfile->chcache = LALCalloc(1, sizeof(*frfile->chcache));
+    if (!frfile->chcache) {
+        LALFree(frfile);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
     frfile->file = XLALFrameUFrFileOpen(path, "r");
     if (!frfile->file) {
+        LALFree(frfile->chcache);
         LALFree(frfile);
         XLAL_ERROR_NULL(XLAL_EIO, "Could not open frame file %s", path);
     }
-    frfile->toc = XLALFrameUFrTOCRead(frfile->file);
-    if (!frfile->toc) {
-        XLALFrameUFrFileClose(frfile->file);
-        LALFree(frfile);
+
+    /* the TOC need only be read if the file is not in the cache */
+#ifdef HAVE_SYS_STAT_H
+    {
+        struct stat buf;
+        int cached = stat(path, &buf) == 0;
+        if (cached && XLALFrFileTOCCacheLookup(frfile, path, &buf))
+            return frfile;
+        if (XLALFrFileReadFrameTimes(frfile) < 0) {
+            XLALFrFileClose(frfile);
+            XLAL_ERROR_NULL(XLAL_EIO, "Could not open TOC for frame file %s",
+                path);
+        }
+        if (cached)
+            XLALFrFileTOCCacheInsert(frfile, path, &buf);
+    }
+#else
+    if (XLALFrFileReadFrameTimes(frfile) < 0) {
+        XLALFrFileClose(frfile);
         XLAL_ERROR_NULL(XLAL_EIO, "Could not open TOC for frame file %s",
             path);
     }
+#endif
 
     return frfile;
 }
 
 size_t XLALFrFileQueryNFrame(const LALFrFile * frfile)
 {
-    return XLALFrameUFrTOCQueryNFrame(frfile->toc);
+    return frfile->nframe;
 }
 
 LIGOTimeGPS *XLALFrFileQueryGTime(LIGOTimeGPS * start,
     const LALFrFile * frfile, size_t pos)
 {
-    double ip, fp;      /* integer part and fraction part */
-    fp = XLALFrameUFrTOCQueryGTimeModf(&ip, frfile->toc, pos);
-    return XLALGPSSet(start, ip, XLAL_BILLION_REAL8 * fp);
+    XLAL_CHECK_NULL(pos < frfile->nframe, XLAL_EINVAL,
+        "pos = %zu out of range", pos);
+    return XLALGPSSet(start, frfile->frames[pos].gtimei,
+        XLAL_BILLION_REAL8 * frfile->frames[pos].gtimef);
 }
 
 double XLALFrFileQueryDt(const LALFrFile * frfile, size_t pos)
 {
-    return XLALFrameUFrTOCQueryDt(frfile->toc, pos);
+    XLAL_CHECK_REAL8(pos < frfile->nframe, XLAL_EINVAL,
+        "pos = %zu out of range", pos);
+    return frfile->frames[pos].dt;
 }
 
 LALTYPECODE XLALFrFileQueryChanType(const LALFrFile * frfile,
@@ -150,11 +398,11 @@ LALTYPECODE XLALFrFileQueryChanType(const LALFrFile * frfile,
 {
     LALFrameUFrChan *channel;
     int type;
-    channel = XLALFrameUFrChanRead(frfile->file, chname, pos);
+    /* the channel is kept for the next read of it */
+    channel = XLALFrFileChanRead(frfile, chname, pos);
     if (!channel)
         XLAL_ERROR(XLAL_ENAME);
     type = XLALFrameUFrChanVectorQueryType(channel);
-    XLALFrameUFrChanFree(channel);
     switch (type) {
     case LAL_FRAMEU_FR_VECT_C:
         return LAL_CHAR_TYPE_CODE;
@@ -193,20 +441,19 @@ size_t XLALFrFileQueryChanVectorLength(const LALFrFile * frfile,
     const char *chname, size_t pos)
 {
     LALFrameUFrChan *channel;
-    size_t length;
-    channel = XLALFrameUFrChanRead(frfile->file, chname, pos);
+    /* the channel is kept for the next read of it */
+    channel = XLALFrFileChanRead(frfile, chname, pos);
     if (!channel)
         XLAL_ERROR(XLAL_ENAME);
-    length = XLALFrameUFrChanVectorQueryNData(channel);
-    XLALFrameUFrChanFree(channel);
-    return length;
+    return XLALFrameUFrChanVectorQueryNData(channel);
 }
 
 int XLALFrFileCksumValid(LALFrFile * frfile)
 {
     int result;
     /* this process might mess up the TOC so need to reread it afterwards */
-    XLALFrameUFrTOCFree(frfile->toc);
+    if (frfile->toc)
+        XLALFrameUFrTOCFree(frfile->toc);
     result = XLALFrameUFileCksumValid(frfile->file);
     frfile->toc = XLALFrameUFrTOCRead(frfile->file);
     return result;
@@ -621,7 +868,8 @@ int XLALFrameWrite(LALFrameH * frame, const char *fname)
         goto failure;
 
     /* write frame */
-    XLALFrameUFrameHWrite(frfile, frame);
+    if (XLALFrameUFrameHWrite(frfile, frame) < 0)
+        goto failure;
 
     /* close temporary file */
     XLALFrameUFrFileClose(frfile);
@@ -632,10 +880,159 @@ int XLALFrameWrite(LALFrameH * frame, const char *fname)
 
   failure:     /* unsuccessful exit */
     XLALFrameUFrFileClose(frfile);
-    /* TODO: remove tempfile */
+    remove(tmpfname);
     return -1;
 }
 
+/*
+ *
+ * Asynchronous frame writer: frames are queued by the caller and written
+ * to their files, and then freed, by a background thread.
+ *
+ */
+
+/** @cond */
+typedef struct tagLALFrameWriterJob {
+    struct tagLALFrameWriterJob *next;
+    LALFrameH *frame;
+    char *fname;
+} LALFrameWriterJob;
+
+struct tagLALFrameWriter {
+    LALFrameWriterJob *head;    /* next frame to be written */
+    LALFrameWriterJob *tail;    /* last frame queued */
+    size_t nqueued;
+    size_t maxqueue;
+    size_t nfailed;             /* number of frames that could not be written */
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;        /* signalled when the queue changes */
+    pthread_t thread;
+    int stop;
+#endif
+};
+/** @endcond */
+
+/* writes and frees the frame of a job, and frees the job; returns 1 if the frame could not be written */
+static int XLALFrameWriterRunJob(LALFrameWriterJob * job)
+{
+    int failed = XLALFrameWrite(job->frame, job->fname) < 0;
+    if (failed)
+        XLAL_PRINT_ERROR("Could not write frame file %s", job->fname);
+    XLALFrameFree(job->frame);
+    LALFree(job->fname);
+    LALFree(job);
+    return failed;
+}
+
+#ifdef LAL_PTHREAD_LOCK
+
+static void *XLALFrameWriterThread(void *arg)
+{
+    LALFrameWriter *writer = arg;
+    pthread_mutex_lock(&writer->mutex);
+    for (;;) {
+        LALFrameWriterJob *job;
+        int failed;
+        while (!writer->head && !writer->stop)
+            pthread_cond_wait(&writer->cond, &writer->mutex);
+        if (!writer->head)
+            break;  /* stopped with an empty queue */
+        job = writer->head;
+        writer->head = job->next;
+        if (!writer->head)
+            writer->tail = NULL;
+        pthread_mutex_unlock(&writer->mutex);
+        failed = XLALFrameWriterRunJob(job);
+        pthread_mutex_lock(&writer->mutex);
+        --writer->nqueued;
+        writer->nfailed += failed;
+        pthread_cond_broadcast(&writer->cond);
+    }
+    pthread_mutex_unlock(&writer->mutex);
+    return NULL;
+}
+
+#endif /* LAL_PTHREAD_LOCK */
+
+LALFrameWriter *XLALFrameWriterOpen(size_t maxqueue)
+{
+    LALFrameWriter *writer;
+    writer = LALCalloc(1, sizeof(*writer));
+    if (!writer)
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    writer->maxqueue = maxqueue ? maxqueue : 1;
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_init(&writer->mutex, NULL);
+    pthread_cond_init(&writer->cond, NULL);
+    if (pthread_create(&writer->thread, NULL, XLALFrameWriterThread, writer)) {
+        pthread_cond_destroy(&writer->cond);
+        pthread_mutex_destroy(&writer->mutex);
+        LALFree(writer);
+        XLAL_ERROR_NULL(XLAL_ESYS, "Could not create frame writer thread");
+    }
+#endif
+    return writer;
+}
+
+int XLALFrameWriterSubmit(LALFrameWriter * writer, LALFrameH * frame,
+    const char *fname)
+{
+    LALFrameWriterJob *job;
+    XLAL_CHECK(writer, XLAL_EFAULT);
+    XLAL_CHECK(frame, XLAL_EFAULT);
+    XLAL_CHECK(fname, XLAL_EFAULT);
+
+    job = LALCalloc(1, sizeof(*job));
+    if (!job)
+        XLAL_ERROR(XLAL_ENOMEM);
+    job->frame = frame;
+    job->fname = XLALStringDuplicate(fname);
+    if (!job->fname) {
+        LALFree(job);
+        XLAL_ERROR(XLAL_EFUNC);
+    }
+
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_lock(&writer->mutex);
+    /* wait for room in the queue, bounding the memory held by queued frames */
+    while (writer->nqueued >= writer->maxqueue)
+        pthread_cond_wait(&writer->cond, &writer->mutex);
+    if (writer->tail)
+        writer->tail->next = job;
+    else
+        writer->head = job;
+    writer->tail = job;
+    ++writer->nqueued;
+    pthread_cond_broadcast(&writer->cond);
+    pthread_mutex_unlock(&writer->mutex);
+#else /* no threads: write the frame now */
+    writer->nfailed += XLALFrameWriterRunJob(job);
+#endif
+    return 0;
+}
+
+int XLALFrameWriterClose(LALFrameWriter * writer)
+{
+    size_t nfailed;
+    if (!writer)
+        return 0;
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_lock(&writer->mutex);
+    writer->stop = 1;
+    pthread_cond_broadcast(&writer->cond);
+    pthread_mutex_unlock(&writer->mutex);
+    pthread_join(writer->thread, NULL);
+    pthread_cond_destroy(&writer->cond);
+    pthread_mutex_destroy(&writer->mutex);
+#endif
+    nfailed = writer->nfailed;
+    LALFree(writer);
+    if (nfailed)
+        XLAL_ERROR(XLAL_EIO, "%zu frame files could not be written", nfailed);
+    return 0;
+}
+
 static int charcmp(const void *c1, const void *c2)
 {
     char a = *(const char *)c1;
@@ -80,11 +80,21 @@ int XLALFrFileClose(LALFrFile * frfile);
  * @brief Open frame file for reading and return a LALFrFile structure.
  * @note Only "file:" protocol is supported in URLs.
  * @param url URL of the frame file to be opened.
+ * @note The frame times listed in the table of contents of the file are
+ * kept in a process-wide cache, so that reopening a file which has not been
+ * modified since does not read its table of contents again.
  * @return Pointer to a LALFrFile structure that can be used to read the frame
  * file, or NULL if the URL could not be opened.
  */
 LALFrFile *XLALFrFileOpenURL(const char *url);
 
+/**
+ * @brief Release the process-wide cache of frame file tables of contents.
+ * @details
+ * Files opened subsequently have their tables of contents read afresh.
+ */
+void XLALFrFileTOCCacheClear(void);
+
 /**
  * @brief Use checksum to determine if a frame file is valid.
  * @param frfile Pointer to a ::LALFrFile structure associated with a frame file.
@@ -1274,6 +1284,54 @@ int XLALFrameAddCOMPLEX16FrequencySeriesProcData(LALFrameH * frame, const COMPLE
  */
 int XLALFrameWrite(LALFrameH * frame, const char *fname);
 
+/**
+ * @brief Incomplete type for an asynchronous frame writer.
+ * @details
+ * A frame writer writes frames to frame files in a background thread, so
+ * that the caller can go on preparing the next frames while the previous
+ * ones are written.  Calls into the frame library are serialized, so the
+ * overlap is between the writing and the caller's own computation.
+ */
+typedef struct tagLALFrameWriter LALFrameWriter;
+
+#ifndef SWIG /* exclude from SWIG interface */
+
+/**
+ * @brief Create an asynchronous frame writer.
+ * @details
+ * If LAL is built without POSIX thread support, frames are written when
+ * they are submitted.
+ * @param maxqueue Maximum number of frames waiting to be written; a
+ * submission blocks while the queue is full.  Zero is taken to be one.
+ * @return Pointer to the new frame writer, or NULL on failure.
+ */
+LALFrameWriter *XLALFrameWriterOpen(size_t maxqueue);
+
+/**
+ * @brief Queue a ::LALFrameH frame structure to be written to a frame file.
+ * @details
+ * The writer takes ownership of the frame, which it frees with
+ * XLALFrameFree() once it is written; the caller must not use the frame
+ * after this call.  Failures to write are reported by XLALFrameWriterClose().
+ * @param writer Pointer to the frame writer.
+ * @param frame Pointer to the ::LALFrameH frame structure to be written.
+ * @param fname String with the path name of the frame file to create.
+ * @retval 0 Success.
+ * @retval -1 Failure.
+ */
+int XLALFrameWriterSubmit(LALFrameWriter * writer, LALFrameH * frame, const char *fname);
+
+/**
+ * @brief Wait for all queued frames to be written and destroy a frame writer.
+ * @note This routine is a no-op if passed a NULL pointer.
+ * @param writer Pointer to the frame writer.
+ * @retval 0 All submitted frames were written.
+ * @retval -1 Some frame files could not be written.
+ */
+int XLALFrameWriterClose(LALFrameWriter * writer);
+
+#endif /* SWIG */
+
 /** @} */
 
 /** @} */
@@ -56,19 +56,23 @@ static STYPE *FUNC_(LALFrFile * stream, const char *name, size_t pos,
     void *data;
     int errnum;
 
-    channel = XLALFrameUFrChanRead(stream->file, name, pos);
+    /* metadata queries leave the channel in the stream for a later read */
+    if (load)
+        channel = XLALFrFileChanTake(stream, name, pos);
+    else
+        channel = XLALFrFileChanRead(stream, name, pos);
     if (!channel)
         XLAL_ERROR_NULL(XLAL_ENAME);
 
     /* make sure it is 1d */
     if (XLALFrameUFrChanVectorQueryNDim(channel) != 1) {
-        XLALFrameUFrChanFree(channel);
+        XLALFrFileChanRelease(stream, channel);
         XLAL_ERROR_NULL(XLAL_EDIMS);
     }
 
     /* check type */
     if (XLALFrameUFrChanVectorQueryType(channel) != VTYPE) {
-        XLALFrameUFrChanFree(channel);
+        XLALFrFileChanRelease(stream, channel);
         XLAL_ERROR_NULL(XLAL_ETYPE);
     }
 
@@ -81,13 +85,13 @@ static STYPE *FUNC_(LALFrFile * stream, const char *name, size_t pos,
 #   if DOM == TDOM
     if (strcmp(unitX, "s") && strcmp(unitX, "time")) {
         /* doesn't seem to be a tseries */
-        XLALFrameUFrChanFree(channel);
+        XLALFrFileChanRelease(stream, channel);
         XLAL_ERROR_NULL(XLAL_EUNIT);
     }
 #   elif DOM == FDOM
     if (strcmp(unitX, "s^-1") && strcmp(unitX, "Hz")) {
         /* doesn't seem to be a fseries */
-        XLALFrameUFrChanFree(channel);
+        XLALFrFileChanRelease(stream, channel);
         XLAL_ERROR_NULL(XLAL_EUNIT);
     }
 #   endif
@@ -109,7 +113,7 @@ static STYPE *FUNC_(LALFrFile * stream, const char *name, size_t pos,
     if (!load) {
         /* not expected to load the data vector
          * so exit now with a zero-length vector */
-        XLALFrameUFrChanFree(channel);
+        XLALFrFileChanRelease(stream, channel);
         series = CFUNC(name, &epoch, 0.0, deltaX, &sampleUnits, 0);
         if (!series)
             XLAL_ERROR_NULL(XLAL_EFUNC);
@@ -119,24 +123,24 @@ static STYPE *FUNC_(LALFrFile * stream, const char *name, size_t pos,
     XLALFrameUFrChanVectorExpand(channel);
     data = XLALFrameUFrChanVectorQueryData(channel);
     if (!data) {
-        XLALFrameUFrChanFree(channel);
+        XLALFrFileChanRelease(stream, channel);
         XLAL_ERROR_NULL(XLAL_EDATA);
     }
     bytes = XLALFrameUFrChanVectorQueryNBytes(channel);
     /* make sure bytes, type, and length are sane */
     if (bytes != length * sizeof(TYPE)) {
-        XLALFrameUFrChanFree(channel);
+        XLALFrFileChanRelease(stream, channel);
         XLAL_ERROR_NULL(XLAL_EBADLEN);
     }
 
     series = CFUNC(name, &epoch, 0.0, deltaX, &sampleUnits, length);
     if (!series) {
-        XLALFrameUFrChanFree(channel);
+        XLALFrFileChanRelease(stream, channel);
         XLAL_ERROR_NULL(XLAL_EFUNC);
     }
     memcpy(series->data->data, data, bytes);
 
-    XLALFrameUFrChanFree(channel);
+    XLALFrFileChanRelease(stream, channel);
     return series;
 }
 
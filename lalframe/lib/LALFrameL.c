@@ -1423,6 +1423,12 @@ LALFrameUFrDetector *XLALFrameUFrDetectorRead_FrameL_(LALFrameUFrFile * stream,
 {
     LALFrameUFrDetector *detector;
     FrTOCdet *d;
+
+    /* make sure the TOC is read */
+    if (stream->handle->toc == NULL)
+        if (FrTOCReadFull(stream->handle) == NULL || stream->handle->error != FR_OK)
+            XLAL_ERROR_NULL(XLAL_EIO, "FrTOCReadFull failed with error code %s.", XLALFrameLErrorMessage(stream->handle->error));
+
     for (d = stream->handle->toc->detector; d != NULL; d = d->next)
         if (strcmp(d->name, name) == 0) {
             char prefix[3];
@@ -24,6 +24,42 @@
 #include <lal/XLALError.h>
 #include <lal/LALFrameU.h>
 
+/*
+ * The frame libraries are not thread safe, so if code must be POSIX thread
+ * safe then all calls into them are serialized by a process-wide mutex.
+ * The mutex is recursive since the backends call back into this interface.
+ */
+
+#ifndef LAL_PTHREAD_LOCK        /* non-pthread-safe code */
+
+#define FRAME_LIBRARY_LOCK() ((void)0)
+#define FRAME_LIBRARY_UNLOCK() ((void)0)
+
+#else /* pthread safe code */
+
+#include <pthread.h>
+
+static pthread_mutex_t lalFrameLibraryMutex;
+static pthread_once_t lalFrameLibraryMutexOnce = PTHREAD_ONCE_INIT;
+
+/* routine to create the recursive mutex */
+static void XLALCreateFrameLibraryMutex(void)
+{
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&lalFrameLibraryMutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+    return;
+}
+
+#define FRAME_LIBRARY_LOCK() \
+    (pthread_once(&lalFrameLibraryMutexOnce, XLALCreateFrameLibraryMutex), \
+    pthread_mutex_lock(&lalFrameLibraryMutex))
+#define FRAME_LIBRARY_UNLOCK() pthread_mutex_unlock(&lalFrameLibraryMutex)
+
+#endif /* end of pthread-safe code */
+
 enum {
     LAL_FRAMEU_FRAME_LIBRARY_UNAVAILABLE,
     LAL_FRAMEU_FRAME_LIBRARY_FRAMEL,
@@ -33,23 +69,23 @@ enum {
 /* enable FrameL support if available */
 #if defined HAVE_FRAMEL_H && defined HAVE_LIBFRAMEL
 #   include "LALFrameUFrameL.h"
-#   define CASE_FRAMEL(errval, function, ...) case LAL_FRAMEU_FRAME_LIBRARY_FRAMEL: return function ## _FrameL_ (__VA_ARGS__)
+#   define CASE_FRAMEL(result, errval, function, ...) case LAL_FRAMEU_FRAME_LIBRARY_FRAMEL: result function ## _FrameL_ (__VA_ARGS__); break
 #   ifndef LAL_FRAMEU_FRAME_LIBRARY_DEFAULT
 #       define LAL_FRAMEU_FRAME_LIBRARY_DEFAULT LAL_FRAMEU_FRAME_LIBRARY_FRAMEL
 #   endif
 #else
-#   define CASE_FRAMEL(errval, function, ...) case LAL_FRAMEU_FRAME_LIBRARY_FRAMEL: XLAL_ERROR_VAL(errval, XLAL_EERR, "FrameL library unavailable")
+#   define CASE_FRAMEL(result, errval, function, ...) case LAL_FRAMEU_FRAME_LIBRARY_FRAMEL: FRAME_LIBRARY_UNLOCK(); XLAL_ERROR_VAL(errval, XLAL_EERR, "FrameL library unavailable")
 #endif
 
 /* enable FrameC support if available */
 #if defined HAVE_FRAMECPPC_FRAMEC_H && defined HAVE_LIBFRAMECPPC
 #   include "LALFrameUFrameC.h"
-#   define CASE_FRAMEC(errval, function, ...) case LAL_FRAMEU_FRAME_LIBRARY_FRAMEC: return function ## _FrameC_ (__VA_ARGS__)
+#   define CASE_FRAMEC(result, errval, function, ...) case LAL_FRAMEU_FRAME_LIBRARY_FRAMEC: result function ## _FrameC_ (__VA_ARGS__); break
 #   ifndef LAL_FRAMEU_FRAME_LIBRARY_DEFAULT
 #       define LAL_FRAMEU_FRAME_LIBRARY_DEFAULT LAL_FRAMEU_FRAME_LIBRARY_FRAMEC
 #   endif
 #else
-#   define CASE_FRAMEC(errval, function, ...) case LAL_FRAMEU_FRAME_LIBRARY_FRAMEC: XLAL_ERROR_VAL(errval, XLAL_EERR, "FrameC library unavailable")
+#   define CASE_FRAMEC(result, errval, function, ...) case LAL_FRAMEU_FRAME_LIBRARY_FRAMEC: FRAME_LIBRARY_UNLOCK(); XLAL_ERROR_VAL(errval, XLAL_EERR, "FrameC library unavailable")
 #endif
 
 /* fall-back: no frame library available */
@@ -59,27 +95,44 @@ enum {
 #error No frame library available
 #endif
 
-#define FRAME_LIBRARY_SELECT_VAL(errval, function, ...) \
+#define FRAME_LIBRARY_SELECT_VAL(type, errval, function, ...) \
     do { \
+        type result_; \
+        FRAME_LIBRARY_LOCK(); \
         switch (XLALFrameLibrary()) { \
-        CASE_FRAMEL(errval, function, __VA_ARGS__); \
-        CASE_FRAMEC(errval, function, __VA_ARGS__); \
+        CASE_FRAMEL(result_ =, errval, function, __VA_ARGS__); \
+        CASE_FRAMEC(result_ =, errval, function, __VA_ARGS__); \
         default: \
+            FRAME_LIBRARY_UNLOCK(); \
             XLAL_ERROR_VAL(errval, XLAL_EERR, "No frame library available"); \
         } \
+        FRAME_LIBRARY_UNLOCK(); \
+        return result_; \
+    } while (0)
+
+#define FRAME_LIBRARY_SELECT_VOID(function, ...) \
+    do { \
+        FRAME_LIBRARY_LOCK(); \
+        switch (XLALFrameLibrary()) { \
+        CASE_FRAMEL(/*void*/, /*void*/, function, __VA_ARGS__); \
+        CASE_FRAMEC(/*void*/, /*void*/, function, __VA_ARGS__); \
+        default: \
+            FRAME_LIBRARY_UNLOCK(); \
+            XLAL_ERROR_VOID(XLAL_EERR, "No frame library available"); \
+        } \
+        FRAME_LIBRARY_UNLOCK(); \
+        return; \
     } while (0)
 
-#define FRAME_LIBRARY_SELECT_VOID(function, ...) FRAME_LIBRARY_SELECT_VAL(/*void*/, function, __VA_ARGS__)
-#define FRAME_LIBRARY_SELECT_NULL(function, ...) FRAME_LIBRARY_SELECT_VAL(NULL, function, __VA_ARGS__)
-#define FRAME_LIBRARY_SELECT_REAL8(function, ...) FRAME_LIBRARY_SELECT_VAL(XLAL_REAL8_FAIL_NAN, function, __VA_ARGS__)
-#define FRAME_LIBRARY_SELECT(function, ...) FRAME_LIBRARY_SELECT_VAL(XLAL_FAILURE, function, __VA_ARGS__)
+#define FRAME_LIBRARY_SELECT_NULL(type, function, ...) FRAME_LIBRARY_SELECT_VAL(type, NULL, function, __VA_ARGS__)
+#define FRAME_LIBRARY_SELECT_REAL8(function, ...) FRAME_LIBRARY_SELECT_VAL(double, XLAL_REAL8_FAIL_NAN, function, __VA_ARGS__)
+#define FRAME_LIBRARY_SELECT(type, function, ...) FRAME_LIBRARY_SELECT_VAL(type, XLAL_FAILURE, function, __VA_ARGS__)
 
 /* 
  * Routine that returns selected frame library:
  * if LAL_FRAME_LIBRARY is set, use the value from that environment;
  * otherwise use the default value.
- * Note: this is NOT threadsafe, but I doubt the frame libraries are
- * threadsafe in any case....
+ * Note: this is only called with the frame library mutex held.
  */
 static int XLALFrameLibrary(void)
 {
@@ -129,12 +182,12 @@ void XLALFrameUFrFileClose(LALFrameUFrFile * stream)
 
 LALFrameUFrFile *XLALFrameUFrFileOpen(const char *filename, const char *mode)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrFileOpen, filename, mode);
+    FRAME_LIBRARY_SELECT_NULL(LALFrameUFrFile *, XLALFrameUFrFileOpen, filename, mode);
 }
 
 int XLALFrameUFileCksumValid(LALFrameUFrFile * stream)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFileCksumValid, stream);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFileCksumValid, stream);
 }
 
 void XLALFrameUFrTOCFree(LALFrameUFrTOC * toc)
@@ -144,12 +197,12 @@ void XLALFrameUFrTOCFree(LALFrameUFrTOC * toc)
 
 LALFrameUFrTOC *XLALFrameUFrTOCRead(LALFrameUFrFile * stream)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrTOCRead, stream);
+    FRAME_LIBRARY_SELECT_NULL(LALFrameUFrTOC *, XLALFrameUFrTOCRead, stream);
 }
 
 size_t XLALFrameUFrTOCQueryNFrame(const LALFrameUFrTOC * toc)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrTOCQueryNFrame, toc);
+    FRAME_LIBRARY_SELECT(size_t, XLALFrameUFrTOCQueryNFrame, toc);
 }
 
 double XLALFrameUFrTOCQueryGTimeModf(double *iptr, const LALFrameUFrTOC * toc, size_t pos)
@@ -164,42 +217,42 @@ double XLALFrameUFrTOCQueryDt(const LALFrameUFrTOC * toc, size_t pos)
 
 size_t XLALFrameUFrTOCQueryAdcN(const LALFrameUFrTOC * toc)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrTOCQueryAdcN, toc);
+    FRAME_LIBRARY_SELECT(size_t, XLALFrameUFrTOCQueryAdcN, toc);
 }
 
 const char *XLALFrameUFrTOCQueryAdcName(const LALFrameUFrTOC * toc, size_t adc)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrTOCQueryAdcName, toc, adc);
+    FRAME_LIBRARY_SELECT_NULL(const char *, XLALFrameUFrTOCQueryAdcName, toc, adc);
 }
 
 size_t XLALFrameUFrTOCQuerySimN(const LALFrameUFrTOC * toc)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrTOCQuerySimN, toc);
+    FRAME_LIBRARY_SELECT(size_t, XLALFrameUFrTOCQuerySimN, toc);
 }
 
 const char *XLALFrameUFrTOCQuerySimName(const LALFrameUFrTOC * toc, size_t sim)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrTOCQuerySimName, toc, sim);
+    FRAME_LIBRARY_SELECT_NULL(const char *, XLALFrameUFrTOCQuerySimName, toc, sim);
 }
 
 size_t XLALFrameUFrTOCQueryProcN(const LALFrameUFrTOC * toc)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrTOCQueryProcN, toc);
+    FRAME_LIBRARY_SELECT(size_t, XLALFrameUFrTOCQueryProcN, toc);
 }
 
 const char *XLALFrameUFrTOCQueryProcName(const LALFrameUFrTOC * toc, size_t proc)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrTOCQueryProcName, toc, proc);
+    FRAME_LIBRARY_SELECT_NULL(const char *, XLALFrameUFrTOCQueryProcName, toc, proc);
 }
 
 size_t XLALFrameUFrTOCQueryDetectorN(const LALFrameUFrTOC * toc)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrTOCQueryDetectorN, toc);
+    FRAME_LIBRARY_SELECT(size_t, XLALFrameUFrTOCQueryDetectorN, toc);
 }
 
 const char *XLALFrameUFrTOCQueryDetectorName(const LALFrameUFrTOC * toc, size_t det)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrTOCQueryDetectorName, toc, det);
+    FRAME_LIBRARY_SELECT_NULL(const char *, XLALFrameUFrTOCQueryDetectorName, toc, det);
 }
 
 void XLALFrameUFrameHFree(LALFrameUFrameH * frame)
@@ -209,52 +262,52 @@ void XLALFrameUFrameHFree(LALFrameUFrameH * frame)
 
 LALFrameUFrameH *XLALFrameUFrameHAlloc(const char *name, double start, double dt, int frnum)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrameHAlloc, name, start, dt, frnum);
+    FRAME_LIBRARY_SELECT_NULL(LALFrameUFrameH *, XLALFrameUFrameHAlloc, name, start, dt, frnum);
 }
 
 LALFrameUFrameH *XLALFrameUFrameHRead(LALFrameUFrFile * stream, int pos)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrameHRead, stream, pos);
+    FRAME_LIBRARY_SELECT_NULL(LALFrameUFrameH *, XLALFrameUFrameHRead, stream, pos);
 }
 
 int XLALFrameUFrameHWrite(LALFrameUFrFile * stream, LALFrameUFrameH * frame)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrameHWrite, stream, frame);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFrameHWrite, stream, frame);
 }
 
 int XLALFrameUFrameHFrChanAdd(LALFrameUFrameH * frame, LALFrameUFrChan * channel)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrameHFrChanAdd, frame, channel);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFrameHFrChanAdd, frame, channel);
 }
 
 int XLALFrameUFrameHFrDetectorAdd(LALFrameUFrameH * frame, LALFrameUFrDetector * detector)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrameHFrDetectorAdd, frame, detector);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFrameHFrDetectorAdd, frame, detector);
 }
 
 int XLALFrameUFrameHFrHistoryAdd(LALFrameUFrameH * frame, LALFrameUFrHistory * history)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrameHFrHistoryAdd, frame, history);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFrameHFrHistoryAdd, frame, history);
 }
 
 const char *XLALFrameUFrameHQueryName(const LALFrameUFrameH * frame)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrameHQueryName, frame);
+    FRAME_LIBRARY_SELECT_NULL(const char *, XLALFrameUFrameHQueryName, frame);
 }
 
 int XLALFrameUFrameHQueryRun(const LALFrameUFrameH * frame)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrameHQueryRun, frame);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFrameHQueryRun, frame);
 }
 
 int XLALFrameUFrameHQueryFrame(const LALFrameUFrameH * frame)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrameHQueryFrame, frame);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFrameHQueryFrame, frame);
 }
 
 int XLALFrameUFrameHQueryDataQuality(const LALFrameUFrameH * frame)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrameHQueryDataQuality, frame);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFrameHQueryDataQuality, frame);
 }
 
 double XLALFrameUFrameHQueryGTimeModf(double *iptr, const LALFrameUFrameH * frame)
@@ -264,7 +317,7 @@ double XLALFrameUFrameHQueryGTimeModf(double *iptr, const LALFrameUFrameH * fram
 
 int XLALFrameUFrameHQueryULeapS(const LALFrameUFrameH * frame)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrameHQueryULeapS, frame);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFrameHQueryULeapS, frame);
 }
 
 double XLALFrameUFrameHQueryDt(const LALFrameUFrameH * frame)
@@ -274,7 +327,7 @@ double XLALFrameUFrameHQueryDt(const LALFrameUFrameH * frame)
 
 int XLALFrameUFrameHSetRun(LALFrameUFrameH * frame, int run)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrameHSetRun, frame, run);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFrameHSetRun, frame, run);
 }
 
 void XLALFrameUFrChanFree(LALFrameUFrChan * channel)
@@ -284,27 +337,27 @@ void XLALFrameUFrChanFree(LALFrameUFrChan * channel)
 
 LALFrameUFrChan *XLALFrameUFrChanRead(LALFrameUFrFile * stream, const char *name, size_t pos)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrChanRead, stream, name, pos);
+    FRAME_LIBRARY_SELECT_NULL(LALFrameUFrChan *, XLALFrameUFrChanRead, stream, name, pos);
 }
 
 LALFrameUFrChan *XLALFrameUFrAdcChanAlloc(const char *name, int dtype, size_t ndata)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrAdcChanAlloc, name, dtype, ndata);
+    FRAME_LIBRARY_SELECT_NULL(LALFrameUFrChan *, XLALFrameUFrAdcChanAlloc, name, dtype, ndata);
 }
 
 LALFrameUFrChan *XLALFrameUFrSimChanAlloc(const char *name, int dtype, size_t ndata)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrSimChanAlloc, name, dtype, ndata);
+    FRAME_LIBRARY_SELECT_NULL(LALFrameUFrChan *, XLALFrameUFrSimChanAlloc, name, dtype, ndata);
 }
 
 LALFrameUFrChan *XLALFrameUFrProcChanAlloc(const char *name, int type, int subtype, int dtype, size_t ndata)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrProcChanAlloc, name, type, subtype, dtype, ndata);
+    FRAME_LIBRARY_SELECT_NULL(LALFrameUFrChan *, XLALFrameUFrProcChanAlloc, name, type, subtype, dtype, ndata);
 }
 
 const char *XLALFrameUFrChanQueryName(const LALFrameUFrChan * channel)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrChanQueryName, channel);
+    FRAME_LIBRARY_SELECT_NULL(const char *, XLALFrameUFrChanQueryName, channel);
 }
 
 double XLALFrameUFrChanQueryTimeOffset(const LALFrameUFrChan * channel)
@@ -314,67 +367,67 @@ double XLALFrameUFrChanQueryTimeOffset(const LALFrameUFrChan * channel)
 
 int XLALFrameUFrChanSetSampleRate(LALFrameUFrChan * channel, double sampleRate)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrChanSetSampleRate, channel, sampleRate);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFrChanSetSampleRate, channel, sampleRate);
 }
 
 int XLALFrameUFrChanSetTimeOffset(LALFrameUFrChan * channel, double timeOffset)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrChanSetTimeOffset, channel, timeOffset);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFrChanSetTimeOffset, channel, timeOffset);
 }
 
 int XLALFrameUFrChanVectorAlloc(LALFrameUFrChan * channel, int dtype, size_t ndata)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrChanVectorAlloc, channel, dtype, ndata);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFrChanVectorAlloc, channel, dtype, ndata);
 }
 
 int XLALFrameUFrChanVectorCompress(LALFrameUFrChan * channel, int compressLevel)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrChanVectorCompress, channel, compressLevel);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFrChanVectorCompress, channel, compressLevel);
 }
 
 int XLALFrameUFrChanVectorExpand(LALFrameUFrChan * channel)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrChanVectorExpand, channel);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFrChanVectorExpand, channel);
 }
 
 const char *XLALFrameUFrChanVectorQueryName(const LALFrameUFrChan * channel)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrChanVectorQueryName, channel);
+    FRAME_LIBRARY_SELECT_NULL(const char *, XLALFrameUFrChanVectorQueryName, channel);
 }
 
 int XLALFrameUFrChanVectorQueryCompress(const LALFrameUFrChan * channel)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrChanVectorQueryCompress, channel);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFrChanVectorQueryCompress, channel);
 }
 
 int XLALFrameUFrChanVectorQueryType(const LALFrameUFrChan * channel)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrChanVectorQueryType, channel);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFrChanVectorQueryType, channel);
 }
 
 void *XLALFrameUFrChanVectorQueryData(const LALFrameUFrChan * channel)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrChanVectorQueryData, channel);
+    FRAME_LIBRARY_SELECT_NULL(void *, XLALFrameUFrChanVectorQueryData, channel);
 }
 
 size_t XLALFrameUFrChanVectorQueryNBytes(const LALFrameUFrChan * channel)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrChanVectorQueryNBytes, channel);
+    FRAME_LIBRARY_SELECT(size_t, XLALFrameUFrChanVectorQueryNBytes, channel);
 }
 
 size_t XLALFrameUFrChanVectorQueryNData(const LALFrameUFrChan * channel)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrChanVectorQueryNData, channel);
+    FRAME_LIBRARY_SELECT(size_t, XLALFrameUFrChanVectorQueryNData, channel);
 }
 
 size_t XLALFrameUFrChanVectorQueryNDim(const LALFrameUFrChan * channel)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrChanVectorQueryNDim, channel);
+    FRAME_LIBRARY_SELECT(size_t, XLALFrameUFrChanVectorQueryNDim, channel);
 }
 
 size_t XLALFrameUFrChanVectorQueryNx(const LALFrameUFrChan * channel, size_t dim)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrChanVectorQueryNx, channel, dim);
+    FRAME_LIBRARY_SELECT(size_t, XLALFrameUFrChanVectorQueryNx, channel, dim);
 }
 
 double XLALFrameUFrChanVectorQueryDx(const LALFrameUFrChan * channel, size_t dim)
@@ -389,37 +442,37 @@ double XLALFrameUFrChanVectorQueryStartX(const LALFrameUFrChan * channel, size_t
 
 const char *XLALFrameUFrChanVectorQueryUnitX(const LALFrameUFrChan * channel, size_t dim)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrChanVectorQueryUnitX, channel, dim);
+    FRAME_LIBRARY_SELECT_NULL(const char *, XLALFrameUFrChanVectorQueryUnitX, channel, dim);
 }
 
 const char *XLALFrameUFrChanVectorQueryUnitY(const LALFrameUFrChan * channel)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrChanVectorQueryUnitY, channel);
+    FRAME_LIBRARY_SELECT_NULL(const char *, XLALFrameUFrChanVectorQueryUnitY, channel);
 }
 
 int XLALFrameUFrChanVectorSetName(LALFrameUFrChan * channel, const char *name)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrChanVectorSetName, channel, name);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFrChanVectorSetName, channel, name);
 }
 
 int XLALFrameUFrChanVectorSetDx(LALFrameUFrChan * channel, double dx)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrChanVectorSetDx, channel, dx);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFrChanVectorSetDx, channel, dx);
 }
 
 int XLALFrameUFrChanVectorSetStartX(LALFrameUFrChan * channel, double x0)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrChanVectorSetStartX, channel, x0);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFrChanVectorSetStartX, channel, x0);
 }
 
 int XLALFrameUFrChanVectorSetUnitX(LALFrameUFrChan * channel, const char *unit)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrChanVectorSetUnitX, channel, unit);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFrChanVectorSetUnitX, channel, unit);
 }
 
 int XLALFrameUFrChanVectorSetUnitY(LALFrameUFrChan * channel, const char *unit)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrChanVectorSetUnitY, channel, unit);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFrChanVectorSetUnitY, channel, unit);
 }
 
 void XLALFrameUFrDetectorFree(LALFrameUFrDetector * detector)
@@ -429,25 +482,25 @@ void XLALFrameUFrDetectorFree(LALFrameUFrDetector * detector)
 
 LALFrameUFrDetector *XLALFrameUFrDetectorRead(LALFrameUFrFile * stream, const char *name)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrDetectorRead, stream, name);
+    FRAME_LIBRARY_SELECT_NULL(LALFrameUFrDetector *, XLALFrameUFrDetectorRead, stream, name);
 }
 
 LALFrameUFrDetector *XLALFrameUFrDetectorAlloc(const char *name, const char *prefix, double latitude, double longitude,
     double elevation, double azimuthX, double azimuthY, double altitudeX, double altitudeY, double midpointX, double midpointY,
     int localTime)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrDetectorAlloc, name, prefix, latitude, longitude, elevation, azimuthX, azimuthY,
+    FRAME_LIBRARY_SELECT_NULL(LALFrameUFrDetector *, XLALFrameUFrDetectorAlloc, name, prefix, latitude, longitude, elevation, azimuthX, azimuthY,
         altitudeX, altitudeY, midpointX, midpointY, localTime);
 }
 
 const char *XLALFrameUFrDetectorQueryName(const LALFrameUFrDetector * detector)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrDetectorQueryName, detector);
+    FRAME_LIBRARY_SELECT_NULL(const char *, XLALFrameUFrDetectorQueryName, detector);
 }
 
 const char *XLALFrameUFrDetectorQueryPrefix(const LALFrameUFrDetector * detector)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrDetectorQueryPrefix, detector);
+    FRAME_LIBRARY_SELECT_NULL(const char *, XLALFrameUFrDetectorQueryPrefix, detector);
 }
 
 double XLALFrameUFrDetectorQueryLongitude(const LALFrameUFrDetector * detector)
@@ -497,7 +550,7 @@ double XLALFrameUFrDetectorQueryArmYMidpoint(const LALFrameUFrDetector * detecto
 
 int XLALFrameUFrDetectorQueryLocalTime(const LALFrameUFrDetector * detector)
 {
-    FRAME_LIBRARY_SELECT(XLALFrameUFrDetectorQueryLocalTime, detector);
+    FRAME_LIBRARY_SELECT(int, XLALFrameUFrDetectorQueryLocalTime, detector);
 }
 
 void XLALFrameUFrHistoryFree(LALFrameUFrHistory * history)
@@ -507,5 +560,5 @@ void XLALFrameUFrHistoryFree(LALFrameUFrHistory * history)
 
 LALFrameUFrHistory *XLALFrameUFrHistoryAlloc(const char *name, double gpssec, const char *comment)
 {
-    FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrHistoryAlloc, name, gpssec, comment);
+    FRAME_LIBRARY_SELECT_NULL(LALFrameUFrHistory *, XLALFrameUFrHistoryAlloc, name, gpssec, comment);
 }
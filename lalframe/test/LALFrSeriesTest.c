@@ -38,10 +38,16 @@
  *
  */
 
+#include <math.h>
 #include <stdio.h>
+#include <string.h>
 #include <lal/LALStdlib.h>
 #include <lal/AVFactories.h>
+#include <lal/Date.h>
+#include <lal/TimeSeries.h>
+#include <lal/Units.h>
 #include <lal/PrintFTSeries.h>
+#include <lal/StringVector.h>
 #include <lal/LALFrStream.h>
 
 #define TESTSTATUS( pstat ) \
@@ -75,7 +81,7 @@ int main( void )
   LALFrOpen( &status, &stream, TEST_DATA_DIR, "F-TEST-*.gwf" );
   TESTSTATUS( &status );
 
-  if ( XLALFrStreamSetMode( stream, LAL_FR_STREAM_VERBOSE_MODE | LAL_FR_STREAM_CHECKSUM_MODE ) )
+  if ( XLALFrStreamSetMode( stream, LAL_FR_STREAM_VERBOSE_MODE | LAL_FR_STREAM_CHECKSUM_MODE | LAL_FR_STREAM_READAHEAD_MODE ) )
     return 1;
 
   /* seek to some initial time */
@@ -122,6 +128,97 @@ int main( void )
 
   LALI4PrintTimeSeries( &chan, CHANNEL ".999" );
 
+  /* reading several channels in a single pass across a file boundary
+   * gives the same data as reading each channel on its own */
+  {
+    LALStringVector *chnames = XLALCreateStringVector( CHANNEL, CHANNEL, NULL );
+    REAL8TimeSeries *list[2];
+    REAL8TimeSeries *single;
+    LIGOTimeGPS start = { 600000055, 0 };
+    UINT4 c;
+    if ( XLALFrStreamInputREAL8TimeSeriesList( list, stream, chnames, &start, 10.0, 0 ) )
+      return 1;
+    single = XLALFrStreamInputREAL8TimeSeries( stream, CHANNEL, &start, 10.0, 0 );
+    for ( c = 0; c < chnames->length; ++c )
+    {
+      if ( XLALGPSCmp( &list[c]->epoch, &single->epoch ) || list[c]->data->length != single->data->length
+          || memcmp( list[c]->data->data, single->data->data, single->data->length * sizeof( *single->data->data ) ) )
+      {
+        fprintf( stderr, "Single-pass channel list differs from single channel read!\n" );
+        return 1;
+      }
+      XLALDestroyREAL8TimeSeries( list[c] );
+    }
+    XLALDestroyREAL8TimeSeries( single );
+    XLALDestroyStringVector( chnames );
+  }
+
+  /* frames written by the asynchronous frame writer read back the same
+   * as frames written synchronously by XLALFrameWrite() */
+  {
+    const char *name = "H1:FRAME_WRITER_TEST";
+    const UINT4 nframe = 4;
+    const UINT4 length = 1024;
+    LALFrameWriter *writer = XLALFrameWriterOpen( 2 );
+    UINT4 k, j;
+    if ( !writer )
+      return 1;
+    for ( k = 0; k < nframe; ++k )
+    {
+      LIGOTimeGPS start = { 600000200 + k, 0 };
+      REAL8TimeSeries *series = XLALCreateREAL8TimeSeries( name, &start, 0.0, 1.0 / length, &lalDimensionlessUnit, length );
+      LALFrameH *syncframe = XLALFrameNew( &start, 1.0, "LAL", 0, k, 0 );
+      LALFrameH *asyncframe = XLALFrameNew( &start, 1.0, "LAL", 0, k, 0 );
+      CHAR fname[256];
+      if ( !series || !syncframe || !asyncframe )
+        return 1;
+      for ( j = 0; j < length; ++j )
+        series->data->data[j] = sin( 0.01 * ( k * length + j ) ) + 1e-3 * j;
+      if ( XLALFrameAddREAL8TimeSeriesProcData( syncframe, series ) || XLALFrameAddREAL8TimeSeriesProcData( asyncframe, series ) )
+        return 1;
+      sprintf( fname, "FrameWriterTest-S-%u.gwf", k );
+      if ( XLALFrameWrite( syncframe, fname ) )
+        return 1;
+      XLALFrameFree( syncframe );
+      sprintf( fname, "FrameWriterTest-A-%u.gwf", k );
+      if ( XLALFrameWriterSubmit( writer, asyncframe, fname ) )
+        return 1;
+      XLALDestroyREAL8TimeSeries( series );
+    }
+    if ( XLALFrameWriterClose( writer ) )
+    {
+      fprintf( stderr, "Asynchronous frame writer failed to write frames!\n" );
+      return 1;
+    }
+    for ( k = 0; k < nframe; ++k )
+    {
+      CHAR fname[256];
+      LALFrFile *syncfile, *asyncfile;
+      REAL8TimeSeries *syncseries, *asyncseries;
+      sprintf( fname, "FrameWriterTest-S-%u.gwf", k );
+      syncfile = XLALFrFileOpenURL( fname );
+      sprintf( fname, "FrameWriterTest-A-%u.gwf", k );
+      asyncfile = XLALFrFileOpenURL( fname );
+      if ( !syncfile || !asyncfile )
+        return 1;
+      syncseries = XLALFrFileReadREAL8TimeSeries( syncfile, name, 0 );
+      asyncseries = XLALFrFileReadREAL8TimeSeries( asyncfile, name, 0 );
+      if ( !syncseries || !asyncseries )
+        return 1;
+      if ( XLALGPSCmp( &syncseries->epoch, &asyncseries->epoch ) || syncseries->deltaT != asyncseries->deltaT
+          || syncseries->data->length != length || asyncseries->data->length != length
+          || memcmp( syncseries->data->data, asyncseries->data->data, length * sizeof( *syncseries->data->data ) ) )
+      {
+        fprintf( stderr, "Frame written by the asynchronous frame writer differs from XLALFrameWrite()!\n" );
+        return 1;
+      }
+      XLALDestroyREAL8TimeSeries( syncseries );
+      XLALDestroyREAL8TimeSeries( asyncseries );
+      XLALFrFileClose( syncfile );
+      XLALFrFileClose( asyncfile );
+    }
+  }
+
   LALFrClose( &status, &stream );
   TESTSTATUS( &status );
 
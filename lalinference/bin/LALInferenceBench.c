@@ -20,7 +20,16 @@
  *  MA  02110-1301  USA
  */
 
+#include <config.h>
+#ifdef HAVE_SCHED_SETAFFINITY
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <sched.h>
+#endif
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <lal/LALInference.h>
 #include <lal/LALInferenceInit.h>
 #include <lal/LALInferenceReadData.h>
@@ -28,6 +37,10 @@
 #include <lal/LALInferenceLikelihood.h>
 #include <lal/LALInferenceTemplate.h>
 #include <sys/resource.h>
+#include <sys/time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #ifdef __GNUC__
 #define UNUSED __attribute__ ((unused))
@@ -38,14 +51,73 @@
 const char HELPSTR[]=\
 "lalinference_bench: Benchmark template and likelihood functions.\n\
  Options:\n\
-    --Niter            : Number of calls to time (delfault 1000) \n\
+    --Niter            : Number of calls to time in each repeat (delfault 1000) \n\
+    --Nwarmup          : Number of untimed calls before timing (default 10)\n\
+    --Nrepeat          : Number of timed repeats of Niter calls (default 5)\n\
     --bench-template   : Only benchmark template function\n\
     --bench-likelihood : Only benchmark likelihood function\n\
                          (defaults to benchmarking both)\n\
+    --pin-cpu CPU      : Pin the process to the given CPU before timing\n\
+    --json FILE        : Also write the results as JSON to FILE\n\
+    --bench-label NAME : Label identifying this configuration in the JSON output\n\
+ The likelihood and template are selected with the usual options, e.g.\n\
+ --margphi, --margtime, --roqtime_steps or --approx, so a suite of\n\
+ configurations is benchmarked by running once per configuration.\n\
  Example (for 1.0-1.0 binary with seglen 8, srate 4096): \n\
  $ ./lalinference_bench --psdlength 1000 --psdstart 1 --seglen 8 --srate 4096 --trigtime 0 --ifo H1 --H1-channel LALSimAdLIGO --H1-cache LALSimAdLIGO --dataseed 1324 --Niter 10000 --fix-chirpmass 1.218 --fix-q 1.0\n\n\n\
 ";
 
+/* Timings of one benchmark, per call, over the timed repeats */
+typedef struct tagBenchResult
+{
+  const char *name;
+  UINT4 Nrepeat;
+  REAL8 *wall; /* wall-clock time per call of each repeat */
+  REAL8 user; /* CPU times per call over all repeats */
+  REAL8 sys;
+} BenchResult;
+
+typedef void (*BenchFunction)(LALInferenceRunState *runState);
+
+static REAL8 wall_clock(void)
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + 1e-6 * tv.tv_usec;
+}
+
+static int compare_REAL8(const void *a, const void *b)
+{
+  REAL8 x = *(const REAL8 *)a, y = *(const REAL8 *)b;
+  return (x > y) - (x < y);
+}
+
+/* Median of n values, sorting them in place */
+static REAL8 median_REAL8(REAL8 *x, UINT4 n)
+{
+  qsort(x, n, sizeof(*x), compare_REAL8);
+  return n % 2 ? x[n/2] : 0.5 * (x[n/2-1] + x[n/2]);
+}
+
+/* Robust summary of the per-call wall-clock times of the repeats */
+static void bench_summary(const BenchResult *result, REAL8 *min, REAL8 *median, REAL8 *mad, REAL8 *mean)
+{
+  UINT4 i;
+  REAL8 *x = XLALMalloc(result->Nrepeat * sizeof(*x));
+  *mean = 0;
+  for(i=0;i<result->Nrepeat;i++)
+  {
+    x[i] = result->wall[i];
+    *mean += x[i] / result->Nrepeat;
+  }
+  *median = median_REAL8(x, result->Nrepeat);
+  *min = x[0];
+  for(i=0;i<result->Nrepeat;i++)
+    x[i] = fabs(x[i] - *median);
+  *mad = median_REAL8(x, result->Nrepeat);
+  XLALFree(x);
+}
+
 void fprintf_bench(FILE *fp, struct rusage start, struct rusage end, UINT4 Niter);
 void fprintf_bench(FILE *fp, struct rusage start, struct rusage end, UINT4 Niter)
 {
@@ -65,12 +137,48 @@ void LALInferenceTemplateNoop(UNUSED LALInferenceModel *model)
   return;
 }
 
-void bench_likelihood(LALInferenceRunState *runState,UINT4 Niter);
-void bench_likelihood(LALInferenceRunState *runState,UINT4 Niter)
+static void call_likelihood(LALInferenceRunState *runState)
+{
+  runState->likelihood(runState->threads[0].model->params,runState->data, runState->threads[0].model);
+}
+
+static void call_template(LALInferenceRunState *runState)
+{
+  runState->threads[0].model->templt(runState->threads[0].model);
+}
+
+/* Time Nrepeat blocks of Niter calls of func after Nwarmup untimed calls */
+static void bench_run(LALInferenceRunState *runState, BenchFunction func, UINT4 Niter, UINT4 Nwarmup, BenchResult *result)
 {
-  UINT4 i=0;
+  UINT4 i=0,j=0;
   struct rusage r_usage_start,r_usage_end;
-  
+  REAL8 start;
+
+  for(i=0;i<Nwarmup;i++)
+    func(runState);
+
+  getrusage(RUSAGE_SELF, &r_usage_start);
+  for(j=0;j<result->Nrepeat;j++)
+  {
+    start = wall_clock();
+    for(i=0;i<Niter;i++)
+      func(runState);
+    result->wall[j] = (wall_clock() - start) / Niter;
+  }
+  getrusage(RUSAGE_SELF, &r_usage_end);
+
+  fprintf_bench(stdout, r_usage_start, r_usage_end, Niter * result->Nrepeat);
+  result->user = ((r_usage_end.ru_utime.tv_sec - r_usage_start.ru_utime.tv_sec) + 1e-6 * (r_usage_end.ru_utime.tv_usec - r_usage_start.ru_utime.tv_usec)) / (Niter * result->Nrepeat);
+  result->sys = ((r_usage_end.ru_stime.tv_sec - r_usage_start.ru_stime.tv_sec) + 1e-6 * (r_usage_end.ru_stime.tv_usec - r_usage_start.ru_stime.tv_usec)) / (Niter * result->Nrepeat);
+
+  REAL8 min, median, mad, mean;
+  bench_summary(result, &min, &median, &mad, &mean);
+  fprintf(stdout,"WALL Per iteration: median %e s, MAD %e s, min %e s over %u repeats\n", median, mad, min, result->Nrepeat);
+}
+
+void bench_likelihood(LALInferenceRunState *runState,UINT4 Niter,UINT4 Nwarmup,BenchResult *result);
+void bench_likelihood(LALInferenceRunState *runState,UINT4 Niter,UINT4 Nwarmup,BenchResult *result)
+{
   /* Clear the template */
   LALInferenceTemplateNullFreqdomain(runState->threads[0].model);
   
@@ -78,36 +186,89 @@ void bench_likelihood(LALInferenceRunState *runState,UINT4 Niter)
   runState->threads[0].model->templt=LALInferenceTemplateNoop;
   
   fprintf(stdout,"Benchmarking likelihood:\n");
-  getrusage(RUSAGE_SELF, &r_usage_start);
-  for(i=0;i<Niter;i++)
-  {
-    runState->likelihood(runState->threads[0].model->params,runState->data, runState->threads[0].model);
-  }
-  getrusage(RUSAGE_SELF, &r_usage_end);
-  fprintf_bench(stdout, r_usage_start, r_usage_end, Niter);
+  bench_run(runState, call_likelihood, Niter, Nwarmup, result);
   runState->threads[0].model->templt=old_templt;
   
 }
 
-void bench_template(LALInferenceRunState *runState, UINT4 Niter);
-void bench_template(LALInferenceRunState *runState, UINT4 Niter)
+void bench_template(LALInferenceRunState *runState, UINT4 Niter, UINT4 Nwarmup, BenchResult *result);
+void bench_template(LALInferenceRunState *runState, UINT4 Niter, UINT4 Nwarmup, BenchResult *result)
 {
-  UINT4 i=0;
-  struct rusage r_usage_start,r_usage_end;
   fprintf(stdout,"Benchmarking template:\n");
-  getrusage(RUSAGE_SELF, &r_usage_start);
-  for(i=0;i<Niter;i++)
+  bench_run(runState, call_template, Niter, Nwarmup, result);
+}
+
+static void fprintf_json_string(FILE *fp, const char *str)
+{
+  fputc('"', fp);
+  for(; str && *str; str++)
   {
-    runState->threads[0].model->templt(runState->threads[0].model);
+    if(*str == '"' || *str == '\\') fprintf(fp, "\\%c", *str);
+    else if((unsigned char) *str < 0x20) fprintf(fp, "\\u%04x", (unsigned char) *str);
+    else fputc(*str, fp);
   }
-  getrusage(RUSAGE_SELF, &r_usage_end);
-  fprintf_bench(stdout, r_usage_start, r_usage_end, Niter);
+  fputc('"', fp);
+}
+
+/* Write the results in a machine-readable form for regression tracking */
+static int fprintf_bench_json(const char *filename, const char *label, ProcessParamsTable *procParams,
+                              INT4 cpu, UINT4 Niter, UINT4 Nwarmup, const BenchResult *results, UINT4 Nresults)
+{
+  FILE *fp = fopen(filename, "w");
+  ProcessParamsTable *ppt;
+  UINT4 i, j;
+  INT4 nthreads = 1;
+
+  if(!fp)
+  {
+    fprintf(stderr, "Unable to open %s for writing\n", filename);
+    return 1;
+  }
+#ifdef _OPENMP
+  nthreads = omp_get_max_threads();
+#endif
+
+  fprintf(fp, "{\n  \"program\": \"lalinference_bench\",\n  \"label\": ");
+  fprintf_json_string(fp, label);
+  fprintf(fp, ",\n  \"command_line\": [");
+  for(ppt=procParams; ppt; ppt=ppt->next)
+  {
+    fprintf(fp, "%s", ppt==procParams ? "" : ", ");
+    fprintf_json_string(fp, ppt->param);
+    if(ppt->value[0])
+    {
+      fprintf(fp, ", ");
+      fprintf_json_string(fp, ppt->value);
+    }
+  }
+  fprintf(fp, "],\n  \"threads\": %d,\n  \"pinned_cpu\": %d,\n", nthreads, cpu);
+  fprintf(fp, "  \"Niter\": %u,\n  \"Nwarmup\": %u,\n  \"benchmarks\": [", Niter, Nwarmup);
+  for(i=0;i<Nresults;i++)
+  {
+    REAL8 min, median, mad, mean;
+    bench_summary(&results[i], &min, &median, &mad, &mean);
+    fprintf(fp, "%s\n    {\"name\": \"%s\", \"unit\": \"s\",\n", i ? "," : "", results[i].name);
+    fprintf(fp, "     \"wall_per_call\": {\"median\": %.9e, \"mad\": %.9e, \"min\": %.9e, \"mean\": %.9e},\n", median, mad, min, mean);
+    fprintf(fp, "     \"user_per_call\": %.9e, \"sys_per_call\": %.9e,\n     \"repeats\": [", results[i].user, results[i].sys);
+    for(j=0;j<results[i].Nrepeat;j++)
+      fprintf(fp, "%s%.9e", j ? ", " : "", results[i].wall[j]);
+    fprintf(fp, "]}");
+  }
+  fprintf(fp, "\n  ]\n}\n");
+  fclose(fp);
+  return 0;
 }
 
 int main(int argc, char *argv[]){
   ProcessParamsTable *procParams = NULL,*ppt=NULL;
   LALInferenceRunState *runState=NULL;
   UINT4 Niter=1000;
+  UINT4 Nwarmup=10;
+  UINT4 Nrepeat=5;
+  INT4 cpu=-1;
+  const char *json=NULL, *label="";
+  BenchResult results[2];
+  UINT4 Nresults=0;
   UINT4 bench_L=1;
   UINT4 bench_T=1;
   int helpflag=0;
@@ -121,6 +282,36 @@ int main(int argc, char *argv[]){
   }
   if((ppt=LALInferenceGetProcParamVal(procParams,"--Niter")))
      Niter=atoi(ppt->value);
+  if((ppt=LALInferenceGetProcParamVal(procParams,"--Nwarmup")))
+     Nwarmup=atoi(ppt->value);
+  if((ppt=LALInferenceGetProcParamVal(procParams,"--Nrepeat")))
+     Nrepeat=atoi(ppt->value);
+  if(Niter<1 || Nrepeat<1)
+  {
+    fprintf(stderr,"--Niter and --Nrepeat must be positive\n");
+    exit(1);
+  }
+  if((ppt=LALInferenceGetProcParamVal(procParams,"--json")))
+     json=ppt->value;
+  if((ppt=LALInferenceGetProcParamVal(procParams,"--bench-label")))
+     label=ppt->value;
+  if((ppt=LALInferenceGetProcParamVal(procParams,"--pin-cpu")))
+  {
+     cpu=atoi(ppt->value);
+#ifdef HAVE_SCHED_SETAFFINITY
+     cpu_set_t mask;
+     CPU_ZERO(&mask);
+     CPU_SET(cpu, &mask);
+     if(sched_setaffinity(0, sizeof(mask), &mask))
+     {
+       fprintf(stderr,"Unable to pin to CPU %d\n",cpu);
+       exit(1);
+     }
+#else
+     fprintf(stderr,"Warning: CPU pinning is not supported on this platform\n");
+     cpu=-1;
+#endif
+  }
   if(LALInferenceGetProcParamVal(procParams,"--bench-template"))
   {
     bench_T=1; bench_L=0;
@@ -153,14 +344,25 @@ int main(int argc, char *argv[]){
     LALInferencePrintVariables(runState->threads[0].model->params);
     printf("\n");
 
-    bench_template(runState,Niter);
+    results[Nresults].name="template";
+    results[Nresults].Nrepeat=Nrepeat;
+    results[Nresults].wall=XLALCalloc(Nrepeat,sizeof(REAL8));
+    bench_template(runState,Niter,Nwarmup,&results[Nresults++]);
     printf("\n");
   }
   if(bench_L)
   {
-    bench_likelihood(runState,Niter);
+    results[Nresults].name="likelihood";
+    results[Nresults].Nrepeat=Nrepeat;
+    results[Nresults].wall=XLALCalloc(Nrepeat,sizeof(REAL8));
+    bench_likelihood(runState,Niter,Nwarmup,&results[Nresults++]);
     printf("\n");
   }
+
+  if(json && !helpflag && fprintf_bench_json(json,label,procParams,cpu,Niter,Nwarmup,results,Nresults))
+    return(1);
+  while(Nresults--)
+    XLALFree(results[Nresults].wall);
   
   return(0);
 }
@@ -101,17 +101,23 @@ int main(int argc, char *argv[]){
     state->proposalArgs = LALInferenceParseProposalArgs(state);
   }
 
+  /* One thread for each live point replaced in parallel */
+  INT4 nthreads=1;
+  if (state && LALInferenceGetProcParamVal(state->commandLine,"--Nthreads"))
+    nthreads=atoi(LALInferenceGetProcParamVal(state->commandLine,"--Nthreads")->value);
+  if (nthreads<1) nthreads=1;
+
   /* Check if recovery is LIB or CBC */
   if (!helpflag && (ppt=LALInferenceGetProcParamVal(state->commandLine,"--approx"))){
     if (XLALCheckBurstApproximantFromString(ppt->value)){
       /* Set up the threads */
-      LALInferenceInitBurstThreads(state,1);
+      LALInferenceInitBurstThreads(state,nthreads);
       /* Init the prior */
       LALInferenceInitLIBPrior(state);
     }
     else{
       /* Set up the threads */
-      LALInferenceInitCBCThreads(state,1);
+      LALInferenceInitCBCThreads(state,nthreads);
       /* Init the prior */
       LALInferenceInitCBCPrior(state);
     }
@@ -124,8 +124,12 @@ int main(int argc, char *argv[]){
 
      }
 
-  /* Set up the threads */
-  LALInferenceInitCBCThreads(state,1);
+  /* Set up the threads, one for each live point replaced in parallel */
+  INT4 nthreads=1;
+  if (state && LALInferenceGetProcParamVal(state->commandLine,"--Nthreads"))
+    nthreads=atoi(LALInferenceGetProcParamVal(state->commandLine,"--Nthreads")->value);
+  if (nthreads<1) nthreads=1;
+  LALInferenceInitCBCThreads(state,nthreads);
 
   /* Init the prior */
   LALInferenceInitCBCPrior(state);
@@ -25,6 +25,7 @@
 #include "LALInferenceKombineSampler.h"
 #include <lal/LALInferenceProposal.h>
 #include <lal/LALInferenceClusteredKDE.h>
+#include <lal/LALInferenceLikelihood.h>
 
 #include <lal/LALInferenceVCSInfo.h>
 
@@ -48,7 +49,7 @@ void ensemble_sampler(struct tagLALInferenceRunState *run_state) {
     INT4 *acceptance_buffer;
     REAL8 *acceptance_rates;
     REAL8 acceptance_rate, min_acceptance_rate, max_acceptance_rate;
-    REAL8 *prop_priors, *prop_likelihoods, *prop_densities;
+    REAL8 *prop_priors, *prop_likelihoods, *prop_densities, *prop_ratios;
     INT4 update = 0;
     FILE *output = NULL;
     LALInferenceThreadState *thread;
@@ -87,6 +88,7 @@ void ensemble_sampler(struct tagLALInferenceRunState *run_state) {
     prop_priors = XLALCalloc(nwalkers_per_thread, sizeof(REAL8));
     prop_likelihoods = XLALCalloc(nwalkers_per_thread, sizeof(REAL8));
     prop_densities = XLALCalloc(nwalkers_per_thread, sizeof(REAL8));
+    prop_ratios = XLALCalloc(nwalkers_per_thread, sizeof(REAL8));
 
     /* Open output and print header */
     output = init_ensemble_output(run_state, verbose, mpi_rank);
@@ -109,13 +111,27 @@ void ensemble_sampler(struct tagLALInferenceRunState *run_state) {
             max_acceptance_rate = 0.0;
         }
 
-        /* Update all walkers on this MPI-thread */
+        /* Propose jumps for all walkers on this MPI-thread */
+        #pragma omp parallel for private(thread)
+        for (walker=0; walker<nwalkers_per_thread; walker++) {
+            thread = &run_state->threads[walker];
+            prop_ratios[walker] = walker_propose(thread, &(prop_densities[walker]));
+        }
+
+        /* Evaluate the proposed positions as one block */
+        if (LALInferenceEnsembleLogLikelihood(run_state, run_state->threads, nwalkers_per_thread,
+                                              prop_priors, prop_likelihoods) != XLAL_SUCCESS) {
+            fprintf(stderr, "Failed to evaluate the proposed walker positions.\n");
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+
+        /* Accept or reject the jumps */
         #pragma omp parallel for private(thread)
         for (walker=0; walker<nwalkers_per_thread; walker++) {
             thread = &run_state->threads[walker];
 
-            walker_step(run_state, thread, &(prop_priors[walker]),
-                        &(prop_likelihoods[walker]), &(prop_densities[walker]));
+            walker_accept(thread, prop_priors[walker], prop_likelihoods[walker],
+                          prop_densities[walker], prop_ratios[walker]);
 
             /* Track acceptance rates */
             acceptance_buffer[walker + (*step % tracking_interval)] = thread->accepted;
@@ -159,30 +175,23 @@ void ensemble_sampler(struct tagLALInferenceRunState *run_state) {
     return;
 }
 
-void walker_step(LALInferenceRunState *run_state, LALInferenceThreadState *thread,
-                 REAL8 *proposed_prior, REAL8 *proposed_likelihood, REAL8 *proposed_prop_density) {
-    REAL8 proposal_ratio, acceptance_probability;
-
+REAL8 walker_propose(LALInferenceThreadState *thread, REAL8 *proposed_prop_density) {
     thread->accepted = 0;
 
-    *proposed_prior = -INFINITY;
-    *proposed_likelihood = -INFINITY;
-
     /* Get the probability of proposing the reverse jump */
     *proposed_prop_density = thread->currentPropDensity;
-    proposal_ratio = LALInferenceStoredClusteredKDEProposal(thread,
-                                                            thread->currentParams,
-                                                            thread->proposedParams,
-                                                            proposed_prop_density);
+    return LALInferenceStoredClusteredKDEProposal(thread,
+                                                  thread->currentParams,
+                                                  thread->proposedParams,
+                                                  proposed_prop_density);
+}
 
-    /* Only bother calculating likelihood if within prior boundaries */
-    *proposed_prior = run_state->prior(run_state, thread->proposedParams, thread->model);
-    if (isfinite(*proposed_prior))
-        *proposed_likelihood = run_state->likelihood(thread->proposedParams,
-                                                     run_state->data, thread->model);
+void walker_accept(LALInferenceThreadState *thread, REAL8 proposed_prior, REAL8 proposed_likelihood,
+                   REAL8 proposed_prop_density, REAL8 proposal_ratio) {
+    REAL8 acceptance_probability;
 
     /* Find jump acceptance probability */
-    acceptance_probability = (*proposed_prior + *proposed_likelihood)
+    acceptance_probability = (proposed_prior + proposed_likelihood)
                             - (thread->currentPrior + thread->currentLikelihood)
                             + proposal_ratio;
 
@@ -190,9 +199,9 @@ void walker_step(LALInferenceRunState *run_state, LALInferenceThreadState *threa
     if (acceptance_probability > 0
             || (log(gsl_rng_uniform(thread->GSLrandom)) < acceptance_probability)) {
         LALInferenceCopyVariables(thread->proposedParams, thread->currentParams);
-        thread->currentPrior = *proposed_prior;
-        thread->currentLikelihood = *proposed_likelihood;
-        thread->currentPropDensity = *proposed_prop_density;
+        thread->currentPrior = proposed_prior;
+        thread->currentLikelihood = proposed_likelihood;
+        thread->currentPropDensity = proposed_prop_density;
 
         thread->accepted = 1;
     }
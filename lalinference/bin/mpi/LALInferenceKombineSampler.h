@@ -37,9 +37,12 @@
 void ensemble_sampler(LALInferenceRunState *run_state);
 
 
-/** Evolve a walker a single step */
-void walker_step(LALInferenceRunState *run_state, LALInferenceThreadState *thread,
-                 REAL8 *proposed_prior, REAL8 *proposed_likelihood, REAL8 *proposed_prop_density);
+/** Propose a jump for a walker, returning the log of the proposal ratio */
+REAL8 walker_propose(LALInferenceThreadState *thread, REAL8 *proposed_prop_density);
+
+/** Accept or reject a walker's proposed jump, given its evaluated prior and likelihood */
+void walker_accept(LALInferenceThreadState *thread, REAL8 proposed_prior, REAL8 proposed_likelihood,
+                   REAL8 proposed_prop_density, REAL8 proposal_ratio);
 
 /** Update the ensemble proposal from the ensemble's current state */
 REAL8 get_acceptance_rate(LALInferenceRunState *run_state, REAL8 *local_acceptance_rates);
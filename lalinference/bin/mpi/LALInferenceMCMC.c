@@ -125,6 +125,10 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
     (--temp-verbose)    Output temperature swapping stats to file\n\
     (--prop-verbose)    Output proposal stats to file\n\
     (--prop-track)      Output proposal parameters\n\
+    (--shared-data)     Read the data on one MPI rank per node and share it with the\n\
+                            other ranks on the node (needs MPI-3, not used with ROQ)\n\
+    (--profile)         Time proposals, prior, likelihood and template generation,\n\
+                            storing the profiles in the output and checkpoint files\n\
     (--outfile file)    Write output files <file>.<chain_number> \n\
                             (PTMCMC.output.<random_seed>.<mpi_thread>)\n\
     ----------------------------------------------\n\
@@ -339,6 +343,9 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
 
         LALInferenceRandomizeProposalCycle(thread->cycle, thread->GSLrandom);
 
+        if (LALInferenceGetProcParamVal(command_line, "--profile"))
+            thread->model->profile = &thread->profile;
+
         LALInferenceAddINT4Variable(thread->proposalArgs, "acl",
                                     acl, LALINFERENCE_PARAM_OUTPUT);
     }
@@ -664,9 +671,264 @@ ProcessParamsTable *LALInferenceContinueMCMC(char *infileName) {
     return procParams;
 }
 
+/* Data read by one MPI rank per node and shared with the other ranks on the
+   node through an MPI-3 shared memory window.  The rank that reads the data
+   keeps its own copy; the others map the window read-only, so a node holds
+   two copies of the data rather than one per rank. */
+#if defined(MPI_VERSION) && MPI_VERSION >= 3
+#define MCMC_SHARED_DATA 1
+#endif
+
+#ifdef MCMC_SHARED_DATA
+/* alignment of each array in the shared window, in bytes */
+#define SHARED_DATA_ALIGN 64
+
+/* description of one series in the shared window */
+typedef struct tagSharedSeries {
+    INT4 present;
+    CHAR name[LALNameLength];
+    LIGOTimeGPS epoch;
+    REAL8 f0;
+    REAL8 delta;
+    LALUnit sampleUnits;
+    UINT4 length;
+    size_t offset;
+} SharedSeries;
+
+/* everything a rank needs to rebuild one LALInferenceIFOData */
+typedef struct tagSharedIFOHeader {
+    CHAR name[DETNAMELEN];
+    LALDetector detector;
+    LIGOTimeGPS epoch;
+    REAL8 fLow, fHigh, padding, STDOF, SNR;
+    SharedSeries timeData, whiteTimeData, windowedTimeData, varTimeData;
+    SharedSeries freqData, whiteFreqData;
+    SharedSeries psd, asd;
+    SharedSeries window;
+    REAL8 windowSumOfSquares, windowSum;
+    INT4 hasTimeToFreqPlan, hasFreqToTimePlan, hasMargPlan;
+} SharedIFOHeader;
+
+static MPI_Win shared_data_window = MPI_WIN_NULL;
+
+static void shared_series_describe(SharedSeries *series, const CHAR *name, const LIGOTimeGPS *epoch,
+                                   REAL8 f0, REAL8 delta, const LALUnit *units, UINT4 length, size_t elementSize,
+                                   size_t *size) {
+    series->present = 1;
+    XLALStringCopy(series->name, name, sizeof(series->name));
+    series->epoch = *epoch;
+    series->f0 = f0;
+    series->delta = delta;
+    series->sampleUnits = *units;
+    series->length = length;
+    series->offset = *size;
+    *size += ((length*elementSize + SHARED_DATA_ALIGN - 1)/SHARED_DATA_ALIGN)*SHARED_DATA_ALIGN;
+}
+
+#define DESCRIBE_SERIES(field, series, type) \
+    if (series) \
+        shared_series_describe(&h->field, (series)->name, &(series)->epoch, (series)->f0, (series)->delta##type, \
+                               &(series)->sampleUnits, (series)->data->length, sizeof(*(series)->data->data), &size)
+
+/* Lay out the data of the list in a shared window, filling in the headers,
+   and return the size of the window in bytes */
+static size_t shared_data_layout(LALInferenceIFOData *data, SharedIFOHeader *headers) {
+    size_t size = 0;
+    LALInferenceIFOData *ifo;
+    SharedIFOHeader *h;
+
+    for (ifo = data, h = headers; ifo; ifo = ifo->next, h++) {
+        memset(h, 0, sizeof(*h));
+        XLALStringCopy(h->name, ifo->name, sizeof(h->name));
+        if (ifo->detector)
+            h->detector = *ifo->detector;
+        h->epoch = ifo->epoch;
+        h->fLow = ifo->fLow;
+        h->fHigh = ifo->fHigh;
+        h->padding = ifo->padding;
+        h->STDOF = ifo->STDOF;
+        h->SNR = ifo->SNR;
+
+        DESCRIBE_SERIES(timeData, ifo->timeData, T);
+        DESCRIBE_SERIES(whiteTimeData, ifo->whiteTimeData, T);
+        DESCRIBE_SERIES(windowedTimeData, ifo->windowedTimeData, T);
+        DESCRIBE_SERIES(varTimeData, ifo->varTimeData, T);
+        DESCRIBE_SERIES(freqData, ifo->freqData, F);
+        DESCRIBE_SERIES(whiteFreqData, ifo->whiteFreqData, F);
+        DESCRIBE_SERIES(psd, ifo->oneSidedNoisePowerSpectrum, F);
+        DESCRIBE_SERIES(asd, ifo->noiseASD, F);
+
+        if (ifo->window) {
+            shared_series_describe(&h->window, "window", &ifo->epoch, 0.0, 0.0, &lalDimensionlessUnit,
+                                   ifo->window->data->length, sizeof(REAL8), &size);
+            h->windowSumOfSquares = ifo->window->sumofsquares;
+            h->windowSum = ifo->window->sum;
+        }
+
+        h->hasTimeToFreqPlan = ifo->timeToFreqFFTPlan != NULL;
+        h->hasFreqToTimePlan = ifo->freqToTimeFFTPlan != NULL;
+        h->hasMargPlan = ifo->margFFTPlan != NULL;
+    }
+
+    return size;
+}
+
+#undef DESCRIBE_SERIES
+
+#define COPY_SERIES(field, series) \
+    if (h->field.present) \
+        memcpy(base + h->field.offset, (series)->data->data, h->field.length*sizeof(*(series)->data->data))
+
+static void shared_data_copy(LALInferenceIFOData *data, const SharedIFOHeader *headers, char *base) {
+    LALInferenceIFOData *ifo;
+    const SharedIFOHeader *h;
+
+    for (ifo = data, h = headers; ifo; ifo = ifo->next, h++) {
+        COPY_SERIES(timeData, ifo->timeData);
+        COPY_SERIES(whiteTimeData, ifo->whiteTimeData);
+        COPY_SERIES(windowedTimeData, ifo->windowedTimeData);
+        COPY_SERIES(varTimeData, ifo->varTimeData);
+        COPY_SERIES(freqData, ifo->freqData);
+        COPY_SERIES(whiteFreqData, ifo->whiteFreqData);
+        COPY_SERIES(psd, ifo->oneSidedNoisePowerSpectrum);
+        COPY_SERIES(asd, ifo->noiseASD);
+        COPY_SERIES(window, ifo->window);
+    }
+}
+
+#undef COPY_SERIES
+
+/* Series whose samples live in the shared window.  They must never be
+   passed to the XLALDestroy functions. */
+#define MAP_SERIES(type, seqtype, series, field, deltaname) \
+    if (h->field.present) { \
+        series = XLALCalloc(1, sizeof(*series)); \
+        series->data = XLALCalloc(1, sizeof(seqtype)); \
+        XLALStringCopy(series->name, h->field.name, sizeof(series->name)); \
+        series->epoch = h->field.epoch; \
+        series->f0 = h->field.f0; \
+        series->deltaname = h->field.delta; \
+        series->sampleUnits = h->field.sampleUnits; \
+        series->data->length = h->field.length; \
+        series->data->data = (type *)(base + h->field.offset); \
+    }
+
+static LALInferenceIFOData *shared_data_map(const SharedIFOHeader *headers, INT4 nifo, char *base) {
+    INT4 i;
+    LALInferenceIFOData *data = XLALCalloc(nifo, sizeof(LALInferenceIFOData));
+    LALInferenceIFOData *ifo;
+    const SharedIFOHeader *h;
+
+    for (i = 0; i < nifo; i++) {
+        ifo = &data[i];
+        h = &headers[i];
+
+        XLALStringCopy(ifo->name, h->name, sizeof(ifo->name));
+        ifo->detector = XLALMalloc(sizeof(LALDetector));
+        *ifo->detector = h->detector;
+        ifo->epoch = h->epoch;
+        ifo->fLow = h->fLow;
+        ifo->fHigh = h->fHigh;
+        ifo->padding = h->padding;
+        ifo->STDOF = h->STDOF;
+        ifo->SNR = h->SNR;
+
+        MAP_SERIES(REAL8, REAL8Sequence, ifo->timeData, timeData, deltaT);
+        MAP_SERIES(REAL8, REAL8Sequence, ifo->whiteTimeData, whiteTimeData, deltaT);
+        MAP_SERIES(REAL8, REAL8Sequence, ifo->windowedTimeData, windowedTimeData, deltaT);
+        MAP_SERIES(REAL8, REAL8Sequence, ifo->varTimeData, varTimeData, deltaT);
+        MAP_SERIES(COMPLEX16, COMPLEX16Sequence, ifo->freqData, freqData, deltaF);
+        MAP_SERIES(COMPLEX16, COMPLEX16Sequence, ifo->whiteFreqData, whiteFreqData, deltaF);
+        MAP_SERIES(REAL8, REAL8Sequence, ifo->oneSidedNoisePowerSpectrum, psd, deltaF);
+        MAP_SERIES(REAL8, REAL8Sequence, ifo->noiseASD, asd, deltaF);
+
+        if (h->window.present) {
+            ifo->window = XLALCalloc(1, sizeof(REAL8Window));
+            ifo->window->data = XLALCalloc(1, sizeof(REAL8Sequence));
+            ifo->window->data->length = h->window.length;
+            ifo->window->data->data = (REAL8 *)(base + h->window.offset);
+            ifo->window->sumofsquares = h->windowSumOfSquares;
+            ifo->window->sum = h->windowSum;
+        }
+
+        /* FFT plans are per process, matching those made in LALInferenceReadData() */
+        if (h->hasTimeToFreqPlan)
+            ifo->timeToFreqFFTPlan = XLALCreateForwardREAL8FFTPlan(h->timeData.length, 1);
+        if (h->hasFreqToTimePlan)
+            ifo->freqToTimeFFTPlan = XLALCreateReverseREAL8FFTPlan(h->timeData.length, 1);
+        if (h->hasMargPlan)
+            ifo->margFFTPlan = XLALCreateReverseREAL8FFTPlan(h->timeData.length, 1);
+
+        ifo->next = i + 1 < nifo ? &data[i+1] : NULL;
+    }
+
+    return data;
+}
+
+#undef MAP_SERIES
+
+/* Initialise the run state with data read, injected into and perturbed by
+   the first rank on each node only.  The other ranks on the node map its
+   data from a shared window.  Returns NULL where LALInferenceInitRunState()
+   would. */
+static LALInferenceRunState *init_runstate_shared_data(ProcessParamsTable *procParams) {
+    MPI_Comm node;
+    MPI_Aint windowSize;
+    INT4 noderank, nifo = 0, dispUnit;
+    size_t size = 0;
+    char *base = NULL;
+    SharedIFOHeader *headers = NULL;
+    LALInferenceRunState *runState = NULL;
+    LALInferenceIFOData *ifo, *data = NULL;
+
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node);
+    MPI_Comm_rank(node, &noderank);
+
+    if (noderank == 0) {
+        runState = LALInferenceInitRunState(procParams);
+        if (runState) {
+            data = runState->data;
+            LALInferenceInjectInspiralSignal(data, runState->commandLine);
+            LALInferenceApplyCalibrationErrors(data, procParams);
+            for (ifo = data; ifo; ifo = ifo->next)
+                nifo++;
+        }
+    } else {
+        LALInferenceCheckOptionsConsistency(procParams);
+    }
+
+    MPI_Bcast(&nifo, 1, MPI_INT, 0, node);
+    if (nifo == 0) {
+        MPI_Comm_free(&node);
+        return runState;
+    }
+
+    headers = XLALCalloc(nifo, sizeof(SharedIFOHeader));
+    if (noderank == 0)
+        size = shared_data_layout(data, headers);
+    MPI_Bcast(headers, nifo*sizeof(SharedIFOHeader), MPI_BYTE, 0, node);
+
+    MPI_Win_allocate_shared(noderank == 0 ? (MPI_Aint)size : 0, 1, MPI_INFO_NULL, node, &base, &shared_data_window);
+    if (noderank == 0)
+        shared_data_copy(data, headers, base);
+    else
+        MPI_Win_shared_query(shared_data_window, 0, &windowSize, &dispUnit, &base);
+    MPI_Barrier(node);
+
+    if (noderank != 0)
+        runState = LALInferenceInitRunStateFromData(procParams, shared_data_map(headers, nifo, base));
+
+    XLALFree(headers);
+    MPI_Comm_free(&node);
+
+    return runState;
+}
+#endif
+
 
 int main(int argc, char *argv[]){
     INT4 mpirank;
+    INT4 sharedData = 0;
     ProcessParamsTable *procParams = NULL, *ppt = NULL;
     LALInferenceRunState *runState = NULL;
     LALInferenceIFOData *data = NULL;
@@ -683,10 +945,30 @@ int main(int argc, char *argv[]){
     if (ppt)
         procParams = LALInferenceContinueMCMC(ppt->value);
 
+    /* The ROQ weights are set up inside LALInferenceReadData() and are not
+       shared, so ROQ runs read the data on every rank */
+    if (LALInferenceGetProcParamVal(procParams, "--shared-data")) {
+#ifdef MCMC_SHARED_DATA
+        if (LALInferenceGetProcParamVal(procParams, "--roqtime_steps")) {
+            if (mpirank == 0)
+                fprintf(stderr, "WARNING: --shared-data is not supported with ROQ, reading the data on every rank.\n");
+        } else
+            sharedData = 1;
+#else
+        if (mpirank == 0)
+            fprintf(stderr, "WARNING: --shared-data needs MPI-3, reading the data on every rank.\n");
+#endif
+    }
+
     /* initialise runstate based on command line */
     /* This includes reading in the data */
     /* And performing any injections specified */
     /* And allocating memory */
+#ifdef MCMC_SHARED_DATA
+    if (sharedData)
+        runState = init_runstate_shared_data(procParams);
+    else
+#endif
     runState = LALInferenceInitRunState(procParams);
 
     if (runState == NULL) {
@@ -698,15 +980,19 @@ int main(int argc, char *argv[]){
         data = runState->data;
     }
 
-    /* Perform injections if data successful read or created */
-    if (runState){
-      LALInferenceInjectInspiralSignal(data, runState->commandLine);
-    }
+    /* Shared data has already had its injections and calibration errors
+       applied by the rank that read it */
+    if (!sharedData) {
+        /* Perform injections if data successful read or created */
+        if (runState){
+          LALInferenceInjectInspiralSignal(data, runState->commandLine);
+        }
 
-    /* Simulate calibration errors.
-     * NOTE: this must be called after both ReadData and (if relevant)
-     * injectInspiralTD/FD are called! */
-    LALInferenceApplyCalibrationErrors(data, procParams);
+        /* Simulate calibration errors.
+         * NOTE: this must be called after both ReadData and (if relevant)
+         * injectInspiralTD/FD are called! */
+        LALInferenceApplyCalibrationErrors(data, procParams);
+    }
 
     /* Handle PTMCMC setup */
     init_ptmcmc(runState);
@@ -733,6 +1019,10 @@ int main(int argc, char *argv[]){
     runState->algorithm(runState);
 
     if (mpirank == 0) printf(" ========== main(): finished. ==========\n");
+#ifdef MCMC_SHARED_DATA
+    if (shared_data_window != MPI_WIN_NULL)
+        MPI_Win_free(&shared_data_window);
+#endif
     MPI_Finalize();
 
     return XLAL_SUCCESS;
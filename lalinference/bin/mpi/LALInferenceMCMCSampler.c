@@ -92,6 +92,9 @@ thinDifferentialEvolutionPoints(LALInferenceThreadState *thread) {
     thread->differentialPointsSize = 2*newSize;
     thread->differentialPointsLength = newSize;
     thread->differentialPointsSkip *= 2;
+
+    /* The saved points no longer match the buffer */
+    thread->differentialPointsSaved = 0;
 }
 
 static void
@@ -129,6 +132,7 @@ resetDifferentialEvolutionBuffer(LALInferenceThreadState *thread) {
     thread->differentialPointsLength = 0;
     thread->differentialPointsSize = 1;
     thread->differentialPointsSkip = LALInferenceGetINT4Variable(thread->proposalArgs, "de_skip");
+    thread->differentialPointsSaved = 0;
 }
 
 /* This is checked by the main loop to determine when to checkpoint */
@@ -136,6 +140,74 @@ static volatile sig_atomic_t __master_saveStateFlag = 0;
 /* This indicates the main loop should terminate */
 static volatile sig_atomic_t __master_exitFlag = 0;
 
+/* Time this process has spent waiting for messages from other processes */
+static REAL8 mpi_idle_time = 0.0;
+
+/* Complete MPI requests, counting the time spent as idle */
+static void wait_for_requests(INT4 count, MPI_Request *requests);
+static void wait_for_requests(INT4 count, MPI_Request *requests)
+{
+    REAL8 start = MPI_Wtime();
+    MPI_Waitall(count, requests, MPI_STATUSES_IGNORE);
+    mpi_idle_time += MPI_Wtime() - start;
+}
+
+/* Flags sent by the root process with CONTROL_COM */
+enum { CONTROL_SAVE, CONTROL_EXIT, CONTROL_COMPLETE, CONTROL_NFLAGS };
+
+/**
+ * Pass the checkpoint, exit and completion decisions of the root process on
+ * to the other processes without a collective.  The flags are sent one
+ * iteration ahead, so by the time a process needs them they have normally
+ * arrived, and control holds the flags sent at the previous call on every
+ * process, so they take effect at the same iteration everywhere.
+ */
+static void exchange_control_flags(INT4 MPIrank, INT4 MPIsize, INT4 root_complete, INT4 *control,
+                                   INT4 *control_next, MPI_Request *requests, INT4 *pending);
+static void exchange_control_flags(INT4 MPIrank, INT4 MPIsize, INT4 root_complete, INT4 *control,
+                                   INT4 *control_next, MPI_Request *requests, INT4 *pending)
+{
+    INT4 i, r;
+
+    if (MPIrank == 0) {
+        if (*pending)
+            wait_for_requests(MPIsize-1, requests+1);
+        for (i = 0; i < CONTROL_NFLAGS; i++)
+            control[i] = control_next[i];
+
+        control_next[CONTROL_SAVE] = __master_saveStateFlag;
+        __master_saveStateFlag = 0;
+        control_next[CONTROL_EXIT] = __master_exitFlag;
+        control_next[CONTROL_COMPLETE] = root_complete;
+        for (r = 1; r < MPIsize; r++)
+            MPI_Isend(control_next, CONTROL_NFLAGS, MPI_INT, r, CONTROL_COM, MPI_COMM_WORLD, &requests[r]);
+    } else {
+        if (*pending) {
+            wait_for_requests(1, requests);
+            for (i = 0; i < CONTROL_NFLAGS; i++)
+                control[i] = control_next[i];
+        }
+        MPI_Irecv(control_next, CONTROL_NFLAGS, MPI_INT, 0, CONTROL_COM, MPI_COMM_WORLD, &requests[0]);
+    }
+    *pending = 1;
+}
+
+/* Write the profiles of the chains to the output file, see below */
+static void write_mcmc_profiles(LALInferenceRunState *runState, INT4 verbose);
+
+/* Complete the control messages still in transit at the end of the run */
+static void finish_control_flags(INT4 MPIrank, INT4 MPIsize, MPI_Request *requests, INT4 *pending);
+static void finish_control_flags(INT4 MPIrank, INT4 MPIsize, MPI_Request *requests, INT4 *pending)
+{
+    if (*pending) {
+        if (MPIrank == 0)
+            wait_for_requests(MPIsize-1, requests+1);
+        else
+            wait_for_requests(1, requests);
+    }
+    *pending = 0;
+}
+
 /* Signal handler for SIGALRM, for periodic checkpointing-with-exit */
 static void catch_alarm(UNUSED int sig, UNUSED siginfo_t *siginfo,UNUSED void *context);
 static void catch_alarm(UNUSED int sig, UNUSED siginfo_t *siginfo,UNUSED void *context)
@@ -209,13 +281,18 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
     INT4 step_last_acl_check;
     int CondorExitCode=0;
 	ProcessParamsTable *ppt=NULL;
-	int local_exitFlag=0;
-	int local_saveStateFlag=0;
+    INT4 root_runComplete = 0;
+    INT4 control[CONTROL_NFLAGS] = {0};
+    INT4 control_next[CONTROL_NFLAGS] = {0};
+    INT4 control_pending = 0;
+    MPI_Request *control_requests;
+    REAL8 run_start_time;
 
     memset(&status, 0, sizeof(status));
 
     MPI_Comm_size(MPI_COMM_WORLD, &MPIsize);
     MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
+    control_requests = XLALCalloc(MPIsize, sizeof(MPI_Request));
 
     algorithm_params = runState->algorithmParams;
 
@@ -370,6 +447,8 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
 
     fflush(stdout);
     MPI_Barrier(MPI_COMM_WORLD);
+    run_start_time = MPI_Wtime();
+    mpi_idle_time = 0.0;
 
     // iterate:
     step_last_acl_check = runState->threads[0].step;
@@ -455,20 +534,14 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
             }
         }
 
-		/* Synchronise interruptions */
-		if(MPIrank==0){
-                    local_saveStateFlag=__master_saveStateFlag;
-                    local_exitFlag=__master_exitFlag;
-		}
-		MPI_Bcast(&local_saveStateFlag, 1, MPI_INT, 0, MPI_COMM_WORLD);
-		MPI_Bcast(&local_exitFlag, 1, MPI_INT, 0, MPI_COMM_WORLD);
+		/* Interruptions requested by the root at the previous iteration */
         INT4 saveattempts=0;
         INT4 retrydelay=5; /* 5 seconds before initial retry */
         INT4 retcode=XLAL_SUCCESS;
         /* The following checkpoint code is wrapped in do {} while loops
          * to allow 10 retries, in case of filesystem congestion
          */
-		if(local_saveStateFlag!=0)
+		if(control[CONTROL_SAVE]!=0)
 		{
             do
             {
@@ -495,12 +568,9 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
                 }
             } while (retcode!=XLAL_SUCCESS && saveattempts<10);
             if(retcode!=XLAL_SUCCESS) {fprintf(stderr,"Process %i failed to checkpoint\n", MPIrank);}
-            /* Wait for all processes to save */
-			MPI_Barrier(MPI_COMM_WORLD);
-			__master_saveStateFlag=0;
-            local_saveStateFlag=0;
+            control[CONTROL_SAVE]=0;
 		}
-		if(local_exitFlag) {
+		if(control[CONTROL_EXIT]) {
 				/* Wait for all processes to be ready to exit */
 				MPI_Barrier(MPI_COMM_WORLD);
 				exit(CondorExitCode);
@@ -553,17 +623,29 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
 
                 if (MPIrank == 0 && t == 0 && thread->effective_sample_size > Neff) {
                     fprintf(stdout,"Thread %i has %i effective samples. Stopping...\n", MPIrank, thread->effective_sample_size);
-                    runComplete = 1;          // Sampling is done!
+                    root_runComplete = 1;          // Sampling is done!
                 }
             }
 
             step_last_acl_check = runState->threads[0].step;
         }
 
-        /* Broadcast the root's decision on run completion */
-        MPI_Bcast(&runComplete, 1, MPI_INT, 0, MPI_COMM_WORLD);
+        /* Pass the root's decisions on, to take effect at the next iteration */
+        exchange_control_flags(MPIrank, MPIsize, root_runComplete, control, control_next,
+                               control_requests, &control_pending);
+        if (control[CONTROL_COMPLETE])
+            runComplete = 1;
     }// while (!runComplete)
+    finish_control_flags(MPIrank, MPIsize, control_requests, &control_pending);
+    XLALFree(control_requests);
+
+    if (verbose)
+        fprintf(stdout, "Process %i spent %.1f s of %.1f s waiting for other processes.\n",
+                MPIrank, mpi_idle_time, MPI_Wtime() - run_start_time);
+
     LALInferenceWriteMCMCSamples(runState);
+    if (runState->threads[0].model->profile)
+        write_mcmc_profiles(runState, verbose);
     MPI_Barrier(MPI_COMM_WORLD);
 }
 
@@ -610,14 +692,20 @@ void mcmc_step(LALInferenceRunState *runState, LALInferenceThreadState *thread)
     logPriorCurrent = thread->currentPrior;
     logLikelihoodCurrent = thread->currentLikelihood;
 
+    LALInferenceProfile *profile = thread->model->profile;
+    REAL8 start = profile ? LALInferenceProfileClock() : 0;
+
     // generate proposal:
     logProposalRatio = thread->proposal(thread, thread->currentParams, thread->proposedParams);
+    if (profile) start = LALInferenceTimerAccumulate(&profile->proposal, start);
 
     // compute prior & likelihood:
     logPriorProposed = runState->prior(runState, thread->proposedParams, thread->model);
-    if (isfinite(logPriorProposed))
+    if (profile) start = LALInferenceTimerAccumulate(&profile->prior, start);
+    if (isfinite(logPriorProposed)) {
         logLikelihoodProposed = runState->likelihood(thread->proposedParams, runState->data, thread->model);
-    else
+        if (profile) LALInferenceTimerAccumulate(&profile->likelihood, start);
+    } else
         logLikelihoodProposed = -INFINITY;
 
     if (propTrack)
@@ -765,21 +853,63 @@ void LALInferenceAdaptLadder(LALInferenceRunState *runState) {
 //-----------------------------------------
 // Swap routines:
 //-----------------------------------------
+/* Pack the temperature, likelihood, prior and parameters of a chain for a swap */
+static REAL8 *pack_swap_state(LALInferenceThreadState *thread, INT4 *count);
+static REAL8 *pack_swap_state(LALInferenceThreadState *thread, INT4 *count) {
+    INT4 nPar = LALInferenceGetVariableDimensionNonFixed(thread->currentParams);
+    REAL8 *packet = XLALMalloc((3 + nPar) * sizeof(REAL8));
+
+    packet[0] = thread->temperature;
+    packet[1] = thread->currentLikelihood;
+    packet[2] = thread->currentPrior;
+    LALInferenceCopyVariablesToArray(thread->currentParams, &packet[3]);
+
+    *count = 3 + nPar;
+    return packet;
+}
+
+/* Receive the packed state of the adjacent chain on process source */
+static REAL8 *recv_swap_state(INT4 source);
+static REAL8 *recv_swap_state(INT4 source) {
+    MPI_Status MPIstatus;
+    INT4 count;
+    REAL8 *packet;
+    REAL8 start = MPI_Wtime();
+
+    MPI_Probe(source, PT_COM, MPI_COMM_WORLD, &MPIstatus);
+    MPI_Get_count(&MPIstatus, MPI_DOUBLE, &count);
+    packet = XLALMalloc(count * sizeof(REAL8));
+    MPI_Recv(packet, count, MPI_DOUBLE, source, PT_COM, MPI_COMM_WORLD, &MPIstatus);
+    mpi_idle_time += MPI_Wtime() - start;
+
+    return packet;
+}
+
+/* Take over the likelihood, prior and parameters of a packed state */
+static void unpack_swap_state(LALInferenceThreadState *thread, const REAL8 *packet);
+static void unpack_swap_state(LALInferenceThreadState *thread, const REAL8 *packet) {
+    thread->currentLikelihood = packet[1];
+    thread->currentPrior = packet[2];
+    LALInferenceCopyArrayToVariables((REAL8 *)&packet[3], thread->currentParams);
+}
+
 void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile) {
     INT4 MPIrank, MPIsize;
-    MPI_Status MPIstatus;
-    INT4 nPar, adjNPar, n_local_threads, ntemps;
-    INT4 low;
-    INT4 ind, cold_ind, hot_ind;
-    INT4 cold_rank, hot_rank;
-    INT4 swapAccepted;
-    INT4 *cold_inds;
-    REAL8 adjCurrentLikelihood, adjCurrentPrior;
-    REAL8 logThreadSwap, temp_prior, temp_like, cold_temp;
-    LALInferenceThreadState *cold_thread = &runState->threads[0];
+    INT4 n_local_threads, ntemps;
+    INT4 parity, low_ind, high_ind;
+    INT4 lower_swap, upper_swap;
+    INT4 cold_ind, hot_ind, count;
+    INT4 swapAccepted, lowerAccepted = 0;
+    INT4 n_requests = 0;
+    MPI_Request requests[3];
+    REAL8 *lower_packet = NULL, *upper_packet = NULL, *adj_packet;
+    REAL8 logThreadSwap, temp_prior, temp_like, cold_temp, adjCurrentLikelihood;
+    LALInferenceThreadState *cold_thread;
     LALInferenceThreadState *hot_thread;
     LALInferenceVariables *temp_params;
 
+    INT4 temp_skip = LALInferenceGetINT4Variable(runState->algorithmParams, "tskip");
+
     MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
     MPI_Comm_size(MPI_COMM_WORLD, &MPIsize);
 
@@ -790,173 +920,131 @@ void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile) {
     if (ntemps == 1)
         return;
 
-    cold_inds = XLALCalloc(ntemps-1, sizeof(INT4));
+    /* Alternate between swapping the pairs of temperatures starting on even
+     * and on odd rungs.  All processes are at the same step, so they agree on
+     * the pairing without communicating. */
+    parity = (runState->threads[0].step / temp_skip) % 2;
+
+    /* Global indices of the temperatures handled by this process */
+    low_ind = MPIrank*n_local_threads;
+    high_ind = low_ind + n_local_threads - 1;
+
+    /* Pairs shared with the processes below and above, where this process
+     * holds the hot and the cold chain respectively */
+    lower_swap = (MPIrank > 0 && (low_ind-1) % 2 == parity);
+    upper_swap = (MPIrank < MPIsize-1 && high_ind % 2 == parity);
+
+    /* Send the states needed by the neighbouring processes first, so that no
+     * process waits on another one that is itself waiting */
+    if (lower_swap) {
+        lower_packet = pack_swap_state(&runState->threads[0], &count);
+        MPI_Isend(lower_packet, count, MPI_DOUBLE, MPIrank-1, PT_COM, MPI_COMM_WORLD, &requests[n_requests++]);
+    }
+    if (upper_swap) {
+        upper_packet = pack_swap_state(&runState->threads[n_local_threads-1], &count);
+        MPI_Isend(upper_packet, count, MPI_DOUBLE, MPIrank+1, PT_COM, MPI_COMM_WORLD, &requests[n_requests++]);
+    }
 
-    /* Have the root process choose a random order of ladder swaps and share it */
-    if (MPIrank == 0) {
-        for (low = 0; low < ntemps-1; low++)
-            cold_inds[low] = low;
+    /* Swaps within this process */
+    for (cold_ind = low_ind + (low_ind % 2 != parity); cold_ind < high_ind; cold_ind += 2) {
+        hot_ind = cold_ind+1;
+        cold_thread = &runState->threads[cold_ind % n_local_threads];
+        hot_thread = &runState->threads[hot_ind % n_local_threads];
 
-        gsl_ran_shuffle(runState->GSLrandom, cold_inds, ntemps-1, sizeof(INT4));
-    }
+        /* Determine if swap is accepted */
+        logThreadSwap = 1.0/cold_thread->temperature - 1.0/hot_thread->temperature;
+        logThreadSwap *= hot_thread->currentLikelihood - cold_thread->currentLikelihood;
 
-    MPI_Bcast(cold_inds, ntemps-1, MPI_INT, 0, MPI_COMM_WORLD);
+        if ((logThreadSwap > 0) || (log(gsl_rng_uniform(runState->GSLrandom)) < logThreadSwap ))
+            swapAccepted = 1;
+        else
+            swapAccepted = 0;
+        cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter] = swapAccepted;
+        cold_thread->temp_swap_counter = (cold_thread->temp_swap_counter + 1) % cold_thread->temp_swap_window;
+
+        /* Print to file if verbose is chosen */
+        if (swapfile != NULL) {
+            REAL8 acc_frac = 0.0;
+            for (INT4 i=0; i<cold_thread->temp_swap_window; i++)
+                acc_frac += (REAL8)cold_thread->temp_swap_accepts[i] / cold_thread->temp_swap_window;
+            cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter % cold_thread->temp_swap_window] = swapAccepted;
+            fprintf(swapfile, "%d\t%d\t%f\t%d\t%f\t%f\t%f\t%f\t%i\t%f\n",
+                    cold_thread->step, cold_ind, cold_thread->temperature,
+                    hot_ind, hot_thread->temperature,
+                    logThreadSwap, cold_thread->currentLikelihood,
+                    hot_thread->currentLikelihood, swapAccepted, acc_frac);
+        }
 
-    for (ind=0; ind < ntemps-1; ind++) {
-        cold_ind = cold_inds[ind];
-        hot_ind = cold_ind+1;
+        if (swapAccepted) {
+            temp_params = hot_thread->currentParams;
+            temp_prior = hot_thread->currentPrior;
+            temp_like = hot_thread->currentLikelihood;
 
-        /* Check if cold chain is handled by this thread */
-        cold_rank = cold_ind/n_local_threads;
-        hot_rank = hot_ind/n_local_threads;
-
-        if (cold_rank == hot_rank) {
-            if (MPIrank == cold_rank) {
-                cold_thread = &runState->threads[cold_ind % n_local_threads];
-                hot_thread = &runState->threads[hot_ind % n_local_threads];
-
-                /* Determine if swap is accepted and tell the other chain */
-                logThreadSwap = 1.0/cold_thread->temperature - 1.0/hot_thread->temperature;
-                logThreadSwap *= hot_thread->currentLikelihood - cold_thread->currentLikelihood;
-
-                if ((logThreadSwap > 0) || (log(gsl_rng_uniform(runState->GSLrandom)) < logThreadSwap ))
-                    swapAccepted = 1;
-                else
-                    swapAccepted = 0;
-                cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter] = swapAccepted;
-                cold_thread->temp_swap_counter = (cold_thread->temp_swap_counter + 1) % cold_thread->temp_swap_window;
-
-                /* Print to file if verbose is chosen */
-                if (swapfile != NULL) {
-                    REAL8 acc_frac = 0.0;
-                    for (INT4 i=0; i<cold_thread->temp_swap_window; i++)
-                        acc_frac += (REAL8)cold_thread->temp_swap_accepts[i] / cold_thread->temp_swap_window;
-                    cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter % cold_thread->temp_swap_window] = swapAccepted;
-                    fprintf(swapfile, "%d\t%d\t%f\t%d\t%f\t%f\t%f\t%f\t%i\t%f\n",
-                            cold_thread->step, cold_ind, cold_thread->temperature,
-                            hot_ind, hot_thread->temperature,
-                            logThreadSwap, cold_thread->currentLikelihood,
-                            hot_thread->currentLikelihood, swapAccepted, acc_frac);
-                }
+            hot_thread->currentParams = cold_thread->currentParams;
+            hot_thread->currentPrior = cold_thread->currentPrior;
+            hot_thread->currentLikelihood = cold_thread->currentLikelihood;
 
-                if (swapAccepted) {
-                    temp_params = hot_thread->currentParams;
-                    temp_prior = hot_thread->currentPrior;
-                    temp_like = hot_thread->currentLikelihood;
+            cold_thread->currentParams = temp_params;
+            cold_thread->currentPrior = temp_prior;
+            cold_thread->currentLikelihood = temp_like;
+        }
+    }
 
-                    hot_thread->currentParams = cold_thread->currentParams;
-                    hot_thread->currentPrior = cold_thread->currentPrior;
-                    hot_thread->currentLikelihood = cold_thread->currentLikelihood;
+    /* Hot side of the swap with the process below: decide and tell the cold chain */
+    if (lower_swap) {
+        hot_thread = &runState->threads[0];
+        adj_packet = recv_swap_state(MPIrank-1);
+        cold_temp = adj_packet[0];
+        adjCurrentLikelihood = adj_packet[1];
+
+        logThreadSwap = 1.0/cold_temp - 1.0/hot_thread->temperature;
+        logThreadSwap *= hot_thread->currentLikelihood - adjCurrentLikelihood;
+        if ((logThreadSwap > 0) || (log(gsl_rng_uniform(runState->GSLrandom)) < logThreadSwap ))
+            lowerAccepted = 1;
+        else
+            lowerAccepted = 0;
 
-                    cold_thread->currentParams = temp_params;
-                    cold_thread->currentPrior = temp_prior;
-                    cold_thread->currentLikelihood = temp_like;
-                }
+        MPI_Isend(&lowerAccepted, 1, MPI_INT, MPIrank-1, PT_ACCEPT_COM, MPI_COMM_WORLD, &requests[n_requests++]);
 
-            }
-        } else {
-            if (MPIrank == cold_rank) {
-                cold_thread = &runState->threads[cold_ind % n_local_threads];
-
-                /* Send current likelihood for swap proposal */
-                MPI_Send(&(cold_thread->temperature), 1, MPI_DOUBLE, hot_rank, PT_COM, MPI_COMM_WORLD);
-                MPI_Send(&(cold_thread->currentLikelihood), 1, MPI_DOUBLE, hot_rank, PT_COM, MPI_COMM_WORLD);
-
-                /* Determine if swap was accepted */
-                MPI_Recv(&swapAccepted, 1, MPI_INT, hot_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-                cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter] = swapAccepted;
-                cold_thread->temp_swap_counter = (cold_thread->temp_swap_counter + 1) % cold_thread->temp_swap_window;
-
-                /* Perform Swap */
-                if (swapAccepted) {
-                    /* Set new likelihood */
-                    MPI_Recv(&adjCurrentLikelihood, 1, MPI_DOUBLE, hot_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-                    cold_thread->currentLikelihood = adjCurrentLikelihood;
-
-                    /* Exchange current prior values */
-                    MPI_Send(&(cold_thread->currentPrior), 1, MPI_DOUBLE, hot_rank, PT_COM, MPI_COMM_WORLD);
-                    MPI_Recv(&adjCurrentPrior, 1, MPI_DOUBLE, hot_rank, 0, MPI_COMM_WORLD, &MPIstatus);
-                    cold_thread->currentPrior = adjCurrentPrior;
-
-                    /* Package and send parameters */
-                    nPar = LALInferenceGetVariableDimensionNonFixed(cold_thread->currentParams);
-                    MPI_Send(&nPar, 1, MPI_INT, hot_rank, PT_COM, MPI_COMM_WORLD);
-                    MPI_Recv(&adjNPar, 1, MPI_INT, hot_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-
-                    REAL8 *parameters = XLALMalloc(nPar * sizeof(REAL8));
-                    LALInferenceCopyVariablesToArray(cold_thread->currentParams, parameters);
-                    MPI_Send(parameters, nPar, MPI_DOUBLE, hot_rank, PT_COM, MPI_COMM_WORLD);
-
-                    /* Recieve and unpack parameters */
-                    REAL8 *adjParameters = XLALMalloc(adjNPar * sizeof(REAL8));
-                    MPI_Recv(adjParameters, adjNPar, MPI_DOUBLE, hot_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-                    LALInferenceCopyArrayToVariables(adjParameters, cold_thread->currentParams);
-
-                    XLALFree(parameters);
-                    XLALFree(adjParameters);
-                }
-            } else if (MPIrank == hot_rank) {
-                hot_thread = &runState->threads[hot_ind % n_local_threads];
-
-                MPI_Recv(&cold_temp, 1, MPI_DOUBLE, cold_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-
-                /* Receive adjacent likelilhood */
-                MPI_Recv(&adjCurrentLikelihood, 1, MPI_DOUBLE, cold_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-
-                /* Determine if swap is accepted and tell the other chain */
-                logThreadSwap = 1.0/cold_temp - 1.0/hot_thread->temperature;
-                logThreadSwap *= hot_thread->currentLikelihood - adjCurrentLikelihood;
-                if ((logThreadSwap > 0) || (log(gsl_rng_uniform(runState->GSLrandom)) < logThreadSwap ))
-                    swapAccepted = 1;
-                else
-                    swapAccepted = 0;
-
-                MPI_Send(&swapAccepted, 1, MPI_INT, cold_rank, PT_COM, MPI_COMM_WORLD);
-
-                /* Print to file if verbose is chosen */
-                if (swapfile != NULL) {
-                    fprintf(swapfile, "%d%f\t%f\t\t%f\t%f\t%f\t%i\n",
-                            hot_thread->step, cold_temp, hot_thread->temperature,
-                            logThreadSwap, adjCurrentLikelihood,
-                            hot_thread->currentLikelihood, swapAccepted);
-                    fflush(swapfile);
-                }
+        /* Print to file if verbose is chosen */
+        if (swapfile != NULL) {
+            fprintf(swapfile, "%d%f\t%f\t\t%f\t%f\t%f\t%i\n",
+                    hot_thread->step, cold_temp, hot_thread->temperature,
+                    logThreadSwap, adjCurrentLikelihood,
+                    hot_thread->currentLikelihood, lowerAccepted);
+            fflush(swapfile);
+        }
 
-                /* Perform Swap */
-                if (swapAccepted) {
-                    /* Swap likelihoods */
-                    MPI_Send(&(hot_thread->currentLikelihood), 1, MPI_DOUBLE, cold_rank, PT_COM, MPI_COMM_WORLD);
-                    hot_thread->currentLikelihood = adjCurrentLikelihood;
+        /* Perform Swap */
+        if (lowerAccepted)
+            unpack_swap_state(hot_thread, adj_packet);
 
-                    /* Exchange current prior values */
-                    MPI_Recv(&adjCurrentPrior, 1, MPI_DOUBLE, cold_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-                    MPI_Send(&(hot_thread->currentPrior), 1, MPI_DOUBLE, cold_rank, PT_COM, MPI_COMM_WORLD);
-                    hot_thread->currentPrior = adjCurrentPrior;
+        XLALFree(adj_packet);
+    }
 
-                    /* Package parameters */
-                    nPar = LALInferenceGetVariableDimensionNonFixed(hot_thread->currentParams);
-                    MPI_Recv(&adjNPar, 1, MPI_INT, cold_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-                    MPI_Send(&nPar, 1, MPI_INT, cold_rank, PT_COM, MPI_COMM_WORLD);
+    /* Cold side of the swap with the process above */
+    if (upper_swap) {
+        MPI_Request accept_request;
 
-                    REAL8 *parameters = XLALMalloc(nPar * sizeof(REAL8));
-                    LALInferenceCopyVariablesToArray(hot_thread->currentParams, parameters);
+        cold_thread = &runState->threads[n_local_threads-1];
+        adj_packet = recv_swap_state(MPIrank+1);
 
-                    /* Swap parameters */
-                    REAL8 *adjParameters = XLALMalloc(adjNPar * sizeof(REAL8));
-                    MPI_Recv(adjParameters, adjNPar, MPI_DOUBLE, cold_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-                    MPI_Send(parameters, nPar, MPI_DOUBLE, cold_rank, PT_COM, MPI_COMM_WORLD);
+        MPI_Irecv(&swapAccepted, 1, MPI_INT, MPIrank+1, PT_ACCEPT_COM, MPI_COMM_WORLD, &accept_request);
+        wait_for_requests(1, &accept_request);
+        cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter] = swapAccepted;
+        cold_thread->temp_swap_counter = (cold_thread->temp_swap_counter + 1) % cold_thread->temp_swap_window;
 
-                    /* Unpack parameters */
-                    LALInferenceCopyArrayToVariables(adjParameters, hot_thread->currentParams);
+        /* Perform Swap */
+        if (swapAccepted)
+            unpack_swap_state(cold_thread, adj_packet);
 
-                    XLALFree(parameters);
-                    XLALFree(adjParameters);
-                }
-            }
-        }
+        XLALFree(adj_packet);
     }
 
-    XLALFree(cold_inds);
+    /* The outgoing states can only be released once they have been sent */
+    wait_for_requests(n_requests, requests);
+    XLALFree(lower_packet);
+    XLALFree(upper_packet);
 
     return;
 }
@@ -1302,6 +1390,116 @@ void LALInferenceResumeMCMC(LALInferenceRunState *runState) {
     return;
 }
 
+/* The differential evolution buffers are kept next to the resume file */
+static void differential_points_filename(LALInferenceRunState *runState, char *filename, size_t size);
+static void differential_points_filename(LALInferenceRunState *runState, char *filename, size_t size) {
+    snprintf(filename, size, "%s.de", runState->resumeOutFileName);
+}
+
+/* Open the /lalinference/runID group of a file, creating it for a new file */
+static LALH5File *open_run_group(LALH5File *file, const char *runID, INT4 append);
+static LALH5File *open_run_group(LALH5File *file, const char *runID, INT4 append) {
+    if (!append)
+        return LALInferenceH5CreateGroupStructure(file, "lalinference", runID);
+
+    LALH5File *li_group = XLALH5GroupOpen(file, "lalinference");
+    LALH5File *group = XLALH5GroupOpen(li_group, runID);
+    XLALH5FileClose(li_group);
+    return group;
+}
+
+/* Check that the differential evolution file holds the saved points of each chain, so that it can be appended to */
+static INT4 differential_points_appendable(LALH5File *group, LALInferenceRunState *runState);
+static INT4 differential_points_appendable(LALH5File *group, LALInferenceRunState *runState) {
+    INT4 t;
+    INT4 appendable = 1;
+
+    for (t = 0; t < runState->nthreads && appendable; t++) {
+        LALInferenceThreadState *thread = &runState->threads[t];
+        char chain_group_name[1024];
+        size_t nsaved = 0;
+
+        snprintf(chain_group_name, sizeof(chain_group_name), "%s-checkpoint", thread->name);
+        if (XLALH5FileCheckGroupExists(group, chain_group_name)) {
+            LALH5File *chain_group = XLALH5GroupOpen(group, chain_group_name);
+            if (XLALH5FileCheckDatasetExists(chain_group, "differential_points")) {
+                LALH5Dataset *dataset = XLALH5DatasetRead(chain_group, "differential_points");
+                nsaved = XLALH5TableQueryNRows(dataset);
+                XLALH5DatasetFree(dataset);
+            }
+            XLALH5FileClose(chain_group);
+        }
+
+        if (nsaved != thread->differentialPointsSaved)
+            appendable = 0;
+    }
+
+    return appendable;
+}
+
+/**
+ * Store the differential evolution buffers.  Only the points added since
+ * the last checkpoint are appended, unless a buffer has been thinned or
+ * reset, in which case the file is written again from scratch.
+ */
+static void checkpoint_differential_points(LALInferenceRunState *runState);
+static void checkpoint_differential_points(LALInferenceRunState *runState) {
+    char filename[FILENAME_MAX];
+    INT4 t, append = 0;
+    int retcode = XLAL_SUCCESS;
+    LALH5File *file = NULL, *group = NULL;
+    LALInferenceThreadState *thread;
+
+    differential_points_filename(runState, filename, sizeof(filename));
+
+    if (access(filename, R_OK) == 0) {
+        XLAL_TRY(file = XLALH5FileOpen(filename, "a"), retcode);
+        if (retcode == XLAL_SUCCESS && file) {
+            XLAL_TRY(group = open_run_group(file, runState->runID, 1), retcode);
+            if (retcode == XLAL_SUCCESS && group && differential_points_appendable(group, runState))
+                append = 1;
+            if (!append) {
+                XLALH5FileClose(group);
+                XLALH5FileClose(file);
+            }
+        }
+    }
+
+    if (!append) {
+        file = XLALH5FileOpen(filename, "w");
+        if (file == NULL) {
+            XLALErrorHandler = XLALExitErrorHandler;
+            XLALPrintError("Output file error. Please check that the specified path exists. (in %s, line %d)\n",__FILE__, __LINE__);
+            XLAL_ERROR_VOID(XLAL_EIO);
+        }
+        group = open_run_group(file, runState->runID, 0);
+        for (t = 0; t < runState->nthreads; t++)
+            runState->threads[t].differentialPointsSaved = 0;
+    }
+
+    for (t = 0; t < runState->nthreads; t++) {
+        thread = &runState->threads[t];
+
+        char chain_group_name[1024];
+        snprintf(chain_group_name, sizeof(chain_group_name), "%s-checkpoint", thread->name);
+        LALH5File *chain_group = XLALH5GroupOpen(group, chain_group_name);
+
+        if (thread->differentialPointsLength > thread->differentialPointsSaved) {
+            LALInferenceH5VariablesArrayAppendToDataset(chain_group,
+                    &thread->differentialPoints[thread->differentialPointsSaved],
+                    thread->differentialPointsLength - thread->differentialPointsSaved,
+                    "differential_points");
+            thread->differentialPointsSaved = thread->differentialPointsLength;
+        }
+
+        XLALH5FileClose(chain_group);
+    }
+
+    XLALH5FileClose(group);
+    XLALH5FileClose(file);
+    LALInferencePrintCheckpointFileInfo(filename);
+}
+
 /* Store the MCMC run state to HDF5 for use by --resume */
 void LALInferenceCheckpointMCMC(LALInferenceRunState *runState) {
     //ProcessParamsTable *ppt;
@@ -1312,6 +1510,9 @@ void LALInferenceCheckpointMCMC(LALInferenceRunState *runState) {
 
     MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
 
+    if (runState->threads[0].differentialPoints != NULL)
+        checkpoint_differential_points(runState);
+
     resume_file = XLALH5FileOpen(runState->resumeOutFileName, "w");
     if(resume_file == NULL){
         XLALErrorHandler = XLALExitErrorHandler;
@@ -1339,7 +1540,6 @@ void LALInferenceCheckpointMCMC(LALInferenceRunState *runState) {
         */
 
         /* Create run identifier group */
-        LALInferenceH5VariablesArrayToDataset(chain_group, thread->differentialPoints, thread->differentialPointsLength, "differential_points");
         LALInferenceH5VariablesArrayToDataset(chain_group, &(thread->proposalArgs), 1, "proposal_arguments");
         LALInferenceH5VariablesArrayToDataset(chain_group, &(thread->currentParams), 1, "current_parameters");
         XLALH5FileAddScalarAttribute(chain_group, "temperature", &(thread->temperature), LAL_D_TYPE_CODE);
@@ -1354,6 +1554,14 @@ void LALInferenceCheckpointMCMC(LALInferenceRunState *runState) {
         temp_acc_rate /= thread->temp_swap_window;
         XLALH5FileAddScalarAttribute(chain_group, "temperature_swap_acceptance_rate", &(temp_acc_rate), LAL_D_TYPE_CODE);
 
+        /* Hot-path profile of the chain so far */
+        if (thread->model->profile) {
+            LALInferenceVariables *profile = LALInferenceProfileToVariables(thread);
+            LALInferenceH5VariablesArrayToDataset(chain_group, &profile, 1, "profile");
+            LALInferenceClearVariables(profile);
+            XLALFree(profile);
+        }
+
         /* TODO: Write metadata */
         XLALH5FileClose(chain_group);
     }
@@ -1365,6 +1573,28 @@ void LALInferenceCheckpointMCMC(LALInferenceRunState *runState) {
     return;
 }
 
+/* Replace the differential evolution buffer of a chain by the points of a dataset */
+static void restore_differential_points(LALInferenceThreadState *thread, LALH5Dataset *dataset);
+static void restore_differential_points(LALInferenceThreadState *thread, LALH5Dataset *dataset) {
+    UINT4 N;
+    size_t i;
+
+    for (i = 0; i < thread->differentialPointsLength; i++) {
+        LALInferenceClearVariables(thread->differentialPoints[i]);
+        XLALFree(thread->differentialPoints[i]);
+    }
+    XLALFree(thread->differentialPoints);
+
+    LALInferenceH5DatasetToVariablesArray(dataset, &(thread->differentialPoints), &N);
+    if (N == 0) {
+        XLALFree(thread->differentialPoints);
+        thread->differentialPoints = XLALCalloc(1, sizeof(LALInferenceVariables *));
+    }
+    thread->differentialPointsLength = N;
+    thread->differentialPointsSize = N > 0 ? N : 1;
+    thread->differentialPointsSaved = 0;
+}
+
 /* Read in and restore the run state from an MCMC checkpoint */
 void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
     //ProcessParamsTable *ppt;
@@ -1422,13 +1652,14 @@ void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
         snprintf(chain_group_name, sizeof(chain_group_name), "%s-checkpoint", thread->name);
         LALH5File *chain_group = XLALH5GroupOpen(group, chain_group_name);
 
-        /* Restore differential evolution buffer */
+        /* Restore differential evolution buffer, from older checkpoints
+         * that stored it in the resume file */
         LALH5Dataset *de_group=NULL;
-        XLAL_TRY(de_group = XLALH5DatasetRead(chain_group, "differential_points"), retcode);
-        if (retcode==XLAL_SUCCESS)
+        if (XLALH5FileCheckDatasetExists(chain_group, "differential_points"))
         {
-            LALInferenceH5DatasetToVariablesArray(de_group, &(thread->differentialPoints), (UINT4 *)&(thread->differentialPointsLength));
-            thread->differentialPointsSize = thread->differentialPointsLength;
+            XLAL_TRY(de_group = XLALH5DatasetRead(chain_group, "differential_points"), retcode);
+            if (retcode==XLAL_SUCCESS)
+                restore_differential_points(thread, de_group);
         }
 
         /* Restore proposal arguments, most importantly adaptation settings */
@@ -1487,6 +1718,43 @@ void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
     XLALH5FileClose(li_group);
     XLALH5FileClose(resume_file);
 
+    /* Restore the differential evolution buffers */
+    char de_filename[FILENAME_MAX];
+    LALH5File *de_file = NULL;
+    differential_points_filename(runState, de_filename, sizeof(de_filename));
+    retcode = XLAL_SUCCESS;
+    if (LALInferenceCheckNonEmptyFile(de_filename))
+        XLAL_TRY(de_file = XLALH5FileOpen(de_filename, "r"), retcode);
+    if (de_file)
+    {
+        LALInferencePrintCheckpointFileInfo(de_filename);
+        li_group = XLALH5GroupOpen(de_file, "lalinference");
+        group = XLALH5GroupOpen(li_group, runState->runID);
+        for (t = 0; t < n_local_threads; t++) {
+            thread = &runState->threads[t];
+
+            char chain_group_name[1024];
+            snprintf(chain_group_name, sizeof(chain_group_name), "%s-checkpoint", thread->name);
+            if (!XLALH5FileCheckGroupExists(group, chain_group_name))
+                continue;
+
+            LALH5File *chain_group = XLALH5GroupOpen(group, chain_group_name);
+            if (XLALH5FileCheckDatasetExists(chain_group, "differential_points"))
+            {
+                LALH5Dataset *de_group = XLALH5DatasetRead(chain_group, "differential_points");
+                restore_differential_points(thread, de_group);
+                thread->differentialPointsSaved = thread->differentialPointsLength;
+                XLALH5DatasetFree(de_group);
+            }
+            XLALH5FileClose(chain_group);
+        }
+        XLALH5FileClose(group);
+        XLALH5FileClose(li_group);
+        XLALH5FileClose(de_file);
+    }
+    else if (retcode != XLAL_SUCCESS)
+        fprintf(stderr,"Unable to restore differential evolution buffers from %s, file is not valid HDF5\n",de_filename);
+
     /* Read in samples collected so far */
     
 
@@ -1498,6 +1766,7 @@ void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
         thread = &runState->threads[t];
 
         LALH5Dataset *chain_dataset=NULL;
+        UINT4 N_saved = 0;
         XLAL_TRY(chain_dataset = XLALH5DatasetRead(group, thread->name), retcode);
         if(retcode==XLAL_SUCCESS)
         {
@@ -1510,7 +1779,11 @@ void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
             }
             XLALFree(input_array);
             XLALH5DatasetFree(chain_dataset);
+            N_saved = N;
         }
+
+        /* These samples are already in the output file, which is appended to from now on */
+        LALInferenceAddUINT4Variable(thread->algorithmParams, "N_outputarray_saved", N_saved, LALINFERENCE_PARAM_FIXED);
     }
     XLALH5FileClose(group);
     XLALH5FileClose(li_group);
@@ -1520,26 +1793,60 @@ void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
 }
 
 
+/* Write the samples collected so far.  The output file is created at the
+ * first call, and later calls only append the samples collected since. */
+/* Store the hot-path profile of each chain next to its samples */
+static void write_mcmc_profiles(LALInferenceRunState *runState, INT4 verbose) {
+    INT4 t;
+    LALH5File *output = XLALH5FileOpen(runState->outFileName, "a");
+    if (output == NULL) {
+        XLALPrintError("Unable to open %s to write the chain profiles (in %s, line %d)\n", runState->outFileName, __FILE__, __LINE__);
+        return;
+    }
+
+    LALH5File *group = open_run_group(output, runState->runID, 1);
+    for (t = 0; t < runState->nthreads; t++) {
+        LALInferenceThreadState *thread = &runState->threads[t];
+        char name[1024];
+        LALInferenceVariables *profile = LALInferenceProfileToVariables(thread);
+
+        snprintf(name, sizeof(name), "%s-profile", thread->name);
+        LALInferenceH5VariablesArrayToDataset(group, &profile, 1, name);
+        LALInferenceClearVariables(profile);
+        XLALFree(profile);
+
+        if (verbose) {
+            fprintf(stdout, "Profile of chain %s:\n", thread->name);
+            LALInferencePrintProfile(stdout, thread);
+        }
+    }
+    XLALH5FileClose(group);
+    XLALH5FileClose(output);
+}
+
 void LALInferenceWriteMCMCSamples(LALInferenceRunState *runState) {
     //ProcessParamsTable *ppt;
     INT4 MPIrank;
     INT4 t, n_local_threads;
+    INT4 append;
     LALH5File *output = NULL;
     LALInferenceThreadState *thread;
 
     MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
 
-    output = XLALH5FileOpen(runState->outFileName, "w");
+    append = LALInferenceCheckVariable(runState->threads[0].algorithmParams, "N_outputarray_saved");
+
+    output = XLALH5FileOpen(runState->outFileName, append ? "a" : "w");
     if(output == NULL){
         XLALErrorHandler = XLALExitErrorHandler;
         XLALPrintError("Output file error. Please check that the specified path exists. (in %s, line %d)\n",__FILE__, __LINE__);
         XLAL_ERROR_VOID(XLAL_EIO);
     }
 
-    LALH5File *group = LALInferenceH5CreateGroupStructure(output, "lalinference", runState->runID);
+    LALH5File *group = open_run_group(output, runState->runID, append);
     /* Print injection parameters if there are any */
     LALInferenceVariables *injParams = NULL;
-    if ( (injParams=LALInferencePrintInjectionSample(runState)) )
+    if ( !append && (injParams=LALInferencePrintInjectionSample(runState)) )
     {
         LALInferenceH5VariablesArrayToDataset(group, &injParams, 1, "injection_params");
         LALInferenceClearVariables(injParams);
@@ -1552,18 +1859,28 @@ void LALInferenceWriteMCMCSamples(LALInferenceRunState *runState) {
 
         LALInferenceVariables **output_array=NULL;
         UINT4 N_output_array=0;
+        UINT4 N_saved=0;
+        if (append)
+            N_saved = LALInferenceGetUINT4Variable(thread->algorithmParams, "N_outputarray_saved");
         if(LALInferenceCheckVariable(thread->algorithmParams, "outputarray")
                 && LALInferenceCheckVariable(thread->algorithmParams, "N_outputarray") ) {
             output_array=*(LALInferenceVariables ***)LALInferenceGetVariable(thread->algorithmParams,"outputarray");
             N_output_array=*(UINT4 *)LALInferenceGetVariable(thread->algorithmParams,"N_outputarray");
 
-            /* Create run identifier group */
-            LALInferenceH5VariablesArrayToDataset(group, output_array, N_output_array, thread->name);
+            /* Append the new samples to the chain's table */
+            if (N_output_array > N_saved) {
+                LALInferenceH5VariablesArrayAppendToDataset(group, &output_array[N_saved], N_output_array - N_saved, thread->name);
+                N_saved = N_output_array;
+            }
         }
+        LALInferenceAddUINT4Variable(thread->algorithmParams, "N_outputarray_saved", N_saved, LALINFERENCE_PARAM_FIXED);
+    }
+    if (!append) {
+        char *cl=NULL;
+        cl=LALInferencePrintCommandLine(runState->commandLine);
+        XLALH5FileAddStringAttribute(group,"CommandLine",cl);
+        XLALFree(cl);
     }
-    char *cl=NULL;
-    cl=LALInferencePrintCommandLine(runState->commandLine);
-    XLALH5FileAddStringAttribute(group,"CommandLine",cl);
     XLALH5FileClose(group);
     XLALH5FileClose(output);
     LALInferencePrintCheckpointFileInfo(runState->outFileName);
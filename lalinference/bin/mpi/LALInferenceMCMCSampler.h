@@ -54,13 +54,18 @@ typedef enum {
     PT_COM,          /** Parallel tempering communications */
     LADDER_UPDATE_COM,    /** Update positions across the ladder */
     RUN_PHASE_COM,   /** runPhase passing */
-    RUN_COMPLETE       /** Run complete */
+    RUN_COMPLETE,       /** Run complete */
+    PT_ACCEPT_COM,   /** Parallel tempering swap decisions */
+    CONTROL_COM      /** Checkpoint, exit and completion flags from the root process */
 } LALInferenceMPIcomm;
 
 /* Temperature ladder adaptation */
 void LALInferenceAdaptLadder(LALInferenceRunState *runState);
 
-/* Standard parallel temperature swap proposal function */
+/* Standard parallel temperature swap proposal function.  Neighbouring
+ * temperatures are paired alternately on even and odd rungs, so that all swaps
+ * of a round are independent and exchanges between processes only involve
+ * non-blocking point-to-point messages with the neighbouring ranks. */
 void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile);
 
 /* Metropolis-coupled MCMC swap proposal, when the likelihood is not identical between chains */
@@ -47,6 +47,10 @@
 #define UNUSED
 #endif
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 #define COL_MAX 128
 #define STR_MAX 2048
 
@@ -130,6 +134,7 @@ LALInferenceThreadState *LALInferenceInitThread(LALInferenceThreadState *thread)
     thread->differentialPointsLength = 0;
     thread->differentialPointsSize = 1;
     thread->differentialPointsSkip = 1;
+    thread->differentialPointsSaved = 0;
 
     return thread;
 }
@@ -555,10 +560,53 @@ void LALInferenceClearVariables(LALInferenceVariables *vars)
   return;
 }
 
+/* Returns 1 if target holds the same variables as origin, in the same order
+ * and with the same types and sizes, so that the values can be copied over
+ * without rebuilding the list */
+static int LALInferenceSameVariableLayout(const LALInferenceVariables *origin, const LALInferenceVariables *target)
+{
+  const LALInferenceVariableItem *a, *b;
+  if(origin->dimension!=target->dimension) return 0;
+  for(a=origin->head,b=target->head; a&&b; a=a->next,b=b->next)
+  {
+    if(a->type!=b->type || strcmp(a->name,b->name)) return 0;
+    switch(a->type)
+    {
+      case LALINFERENCE_gslMatrix_t:
+      {
+        const gsl_matrix *ma=*(gsl_matrix **)a->value, *mb=*(gsl_matrix **)b->value;
+        if(!ma || !mb || ma->size1!=mb->size1 || ma->size2!=mb->size2) return 0;
+        break;
+      }
+#define SAME_LENGTH(vtype) do { \
+          const vtype *va=*(vtype **)a->value, *vb=*(vtype **)b->value; \
+          if(!va || !vb || va->length!=vb->length) return 0; \
+        } while(0)
+      case LALINFERENCE_INT4Vector_t:
+        SAME_LENGTH(INT4Vector);
+        break;
+      case LALINFERENCE_UINT4Vector_t:
+        SAME_LENGTH(UINT4Vector);
+        break;
+      case LALINFERENCE_REAL8Vector_t:
+        SAME_LENGTH(REAL8Vector);
+        break;
+      case LALINFERENCE_COMPLEX16Vector_t:
+        SAME_LENGTH(COMPLEX16Vector);
+        break;
+#undef SAME_LENGTH
+      default:
+        break;
+    }
+  }
+  return a==NULL && b==NULL;
+}
+
 void LALInferenceCopyVariables(LALInferenceVariables *origin, LALInferenceVariables *target)
 /*  copy contents of "origin" over to "target"  */
 {
   int dims = 0, i = 0;
+  LALInferenceVariableItem **items = NULL;
 
   /* Check that the source and origin differ */
   if(origin==target) return;
@@ -572,18 +620,75 @@ void LALInferenceCopyVariables(LALInferenceVariables *origin, LALInferenceVariab
   /* Make sure the structure is initialised */
   if(!target) XLAL_ERROR_VOID(XLAL_EFAULT, "Unable to copy to uninitialised LALInferenceVariables structure.");
 
+  /* If the target already has the same variables, which is usual when
+   * copying between the current and proposed parameters, overwrite the
+   * values in place.  This keeps the list nodes (and any pointers into
+   * them) valid and avoids reallocating every item */
+  if(LALInferenceSameVariableLayout(origin,target))
+  {
+    LALInferenceVariableItem *tptr;
+    for(ptr=origin->head,tptr=target->head; ptr; ptr=ptr->next,tptr=tptr->next)
+    {
+      if(!ptr->value) XLAL_ERROR_VOID(XLAL_EFAULT, "Badly formed LALInferenceVariableItem structure!");
+      tptr->vary=ptr->vary;
+      switch(ptr->type)
+      {
+        case LALINFERENCE_gslMatrix_t:
+          gsl_matrix_memcpy(*(gsl_matrix **)tptr->value,*(gsl_matrix **)ptr->value);
+          break;
+        case LALINFERENCE_INT4Vector_t:
+        {
+          INT4Vector *old=*(INT4Vector **)ptr->value;
+          memcpy((*(INT4Vector **)tptr->value)->data,old->data,old->length*sizeof(old->data[0]));
+          break;
+        }
+        case LALINFERENCE_UINT4Vector_t:
+        {
+          UINT4Vector *old=*(UINT4Vector **)ptr->value;
+          memcpy((*(UINT4Vector **)tptr->value)->data,old->data,old->length*sizeof(old->data[0]));
+          break;
+        }
+        case LALINFERENCE_REAL8Vector_t:
+        {
+          REAL8Vector *old=*(REAL8Vector **)ptr->value;
+          memcpy((*(REAL8Vector **)tptr->value)->data,old->data,old->length*sizeof(old->data[0]));
+          break;
+        }
+        case LALINFERENCE_COMPLEX16Vector_t:
+        {
+          COMPLEX16Vector *old=*(COMPLEX16Vector **)ptr->value;
+          memcpy((*(COMPLEX16Vector **)tptr->value)->data,old->data,old->length*sizeof(old->data[0]));
+          break;
+        }
+        default:
+          memcpy(tptr->value,ptr->value,LALInferenceTypeSize[ptr->type]);
+          break;
+      }
+    }
+    return;
+  }
+
   /* First clear the target */
   LALInferenceClearVariables(target);
 
   /* Now add the variables in reverse order, to preserve the
    * ordering */
   dims = LALInferenceGetVariableDimension( origin );
+  if(dims<=0) return;
+  items = XLALMalloc(dims*sizeof(*items));
+  if(!items) XLAL_ERROR_VOID(XLAL_ENOMEM);
+  for(i=0, ptr=origin->head; i<dims && ptr; i++, ptr=ptr->next) items[i]=ptr;
+  if(i!=dims || ptr)
+  {
+    XLALFree(items);
+    XLAL_ERROR_VOID(XLAL_EFAULT, "Bad LALInferenceVariable structure found while trying to copy.");
+  }
 
   /* then copy over elements of "origin" - due to how elements are added by
      LALInferenceAddVariable this has to be done in reverse order to preserve
      the ordering of "origin"  */
   for ( i = dims; i > 0; i-- ){
-    ptr = LALInferenceGetItemNr(origin, i);
+    ptr = items[i-1];
 
     if(!ptr)
     {
@@ -652,6 +757,7 @@ void LALInferenceCopyVariables(LALInferenceVariables *origin, LALInferenceVariab
     }
   }
 
+  XLALFree(items);
   return;
 }
 
@@ -1285,6 +1391,80 @@ void LALInferencePrintProposalStats(FILE *fp, LALInferenceProposalCycle *cycle){
     return;
 }
 
+REAL8 LALInferenceProfileClock(void) {
+#ifdef CLOCK_MONOTONIC
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + 1e-6 * tv.tv_usec;
+#endif
+}
+
+REAL8 LALInferenceTimerAccumulate(LALInferenceTimer *timer, REAL8 start) {
+    REAL8 now = LALInferenceProfileClock();
+    timer->time += now - start;
+    timer->calls++;
+    return now;
+}
+
+static void add_timer_variables(LALInferenceVariables *vars, const char *name, const LALInferenceTimer *timer) {
+    char varname[VARNAME_MAX];
+
+    /* Stored as REAL8, which the HDF5 output supports, exactly up to 2^53 calls */
+    snprintf(varname, sizeof(varname), "%s_calls", name);
+    LALInferenceAddREAL8Variable(vars, varname, (REAL8) timer->calls, LALINFERENCE_PARAM_OUTPUT);
+    snprintf(varname, sizeof(varname), "%s_time", name);
+    LALInferenceAddREAL8Variable(vars, varname, timer->time, LALINFERENCE_PARAM_OUTPUT);
+}
+
+LALInferenceVariables *LALInferenceProfileToVariables(LALInferenceThreadState *thread) {
+    LALInferenceVariables *vars;
+    INT4 i;
+
+    XLAL_CHECK_NULL(thread, XLAL_EFAULT);
+    vars = XLALCalloc(1, sizeof(LALInferenceVariables));
+    XLAL_CHECK_NULL(vars, XLAL_ENOMEM);
+
+    add_timer_variables(vars, "proposal", &thread->profile.proposal);
+    add_timer_variables(vars, "prior", &thread->profile.prior);
+    add_timer_variables(vars, "likelihood", &thread->profile.likelihood);
+    add_timer_variables(vars, "template", &thread->profile.templt);
+    if (thread->cycle)
+        for (i = 0; i < thread->cycle->nProposals; i++)
+            add_timer_variables(vars, thread->cycle->proposals[i]->name, &thread->cycle->proposals[i]->timer);
+
+    return vars;
+}
+
+void LALInferencePrintProfile(FILE *fp, LALInferenceThreadState *thread) {
+    const LALInferenceTimer *timers[4];
+    const char *names[4] = {"proposal", "prior", "likelihood", "template"};
+    INT4 i;
+
+    if (fp == NULL || thread == NULL)
+        return;
+
+    timers[0] = &thread->profile.proposal;
+    timers[1] = &thread->profile.prior;
+    timers[2] = &thread->profile.likelihood;
+    timers[3] = &thread->profile.templt;
+
+    fprintf(fp, "%-32s %12s %14s %14s\n", "section", "calls", "total (s)", "per call (s)");
+    for (i = 0; i < 4; i++)
+        fprintf(fp, "%-32s %12" LAL_UINT8_FORMAT " %14.6e %14.6e\n", names[i], timers[i]->calls,
+                timers[i]->time, timers[i]->calls ? timers[i]->time / timers[i]->calls : 0.0);
+    if (thread->cycle)
+        for (i = 0; i < thread->cycle->nProposals; i++) {
+            const LALInferenceTimer *timer = &thread->cycle->proposals[i]->timer;
+            fprintf(fp, "%-32s %12" LAL_UINT8_FORMAT " %14.6e %14.6e\n", thread->cycle->proposals[i]->name,
+                    timer->calls, timer->time, timer->calls ? timer->time / timer->calls : 0.0);
+        }
+    return;
+}
+
 const char *LALInferenceTranslateInternalToExternalParamName(const char *inName) {
   if (!strcmp(inName, "a_spin1")) {
     return "a1";
@@ -2330,34 +2510,133 @@ void LALInferenceLambdaTsEta2Lambdas(REAL8 lambdaT, REAL8 dLambdaT, REAL8 eta, R
   return;
 }
 
-/* Find lambda1,2(m1,2|eos) for 4-piece polytrope EOS model */
-void LALInferenceLogp1GammasMasses2Lambdas(REAL8 logp1,REAL8 gamma1,REAL8 gamma2,REAL8 gamma3, REAL8 mass1, REAL8 mass2, REAL8 *lambda1, REAL8 *lambda2){
-// Convert to SI
-REAL8 logp1_si=logp1-1.0;
-double mass1_kg=mass1*LAL_MSUN_SI;
-double mass2_kg=mass2*LAL_MSUN_SI;
+/*
+ * Neutron star families of the most recently used EOS parameter sets, most
+ * recent first.  The prior and the template are evaluated with the same EOS
+ * parameters, and a sampler often holds them fixed while the other parameters
+ * move, so keeping the families saves solving the TOV equations again for
+ * every call.  All access is serialised by the critical section
+ * LALInferenceEOSFamilyCache.
+ */
+#define EOS_FAMILY_CACHE_SIZE 8
+#define EOS_FAMILY_CACHE_MAXPARAM 4
+enum { EOS_FAMILY_POLYTROPE, EOS_FAMILY_SPECTRAL };
+typedef struct tagEOSFamilyCacheEntry {
+  int type;
+  int size;
+  double param[EOS_FAMILY_CACHE_MAXPARAM];
+  LALSimNeutronStarEOS *eos;
+  LALSimNeutronStarFamily *fam;
+  int checked; /* passed the check in LALInferenceEOSPhysicalCheck() */
+} EOSFamilyCacheEntry;
+static EOSFamilyCacheEntry eos_family_cache[EOS_FAMILY_CACHE_SIZE];
+static int eos_family_cache_len = 0;
+
+/* Move entry i of the cache to the front */
+static EOSFamilyCacheEntry *eos_family_cache_touch(int i)
+{
+  EOSFamilyCacheEntry entry = eos_family_cache[i];
+  for (; i > 0; i--)
+    eos_family_cache[i] = eos_family_cache[i - 1];
+  eos_family_cache[0] = entry;
+  return &eos_family_cache[0];
+}
 
-// Make eos
-LALSimNeutronStarEOS *eos = NULL;
-LALSimNeutronStarFamily *fam = NULL;
-eos = XLALSimNeutronStarEOS4ParameterPiecewisePolytrope(logp1_si, gamma1, gamma2, gamma3);
-fam = XLALCreateSimNeutronStarFamily(eos);
+/* Find the cached family for an EOS parameter set, or return NULL */
+static EOSFamilyCacheEntry *eos_family_cache_find(int type, const double param[], int size)
+{
+  for (int i = 0; i < eos_family_cache_len; i++) {
+    EOSFamilyCacheEntry *entry = &eos_family_cache[i];
+    int j;
+    if (entry->type != type || entry->size != size)
+      continue;
+    for (j = 0; j < size && entry->param[j] == param[j]; j++);
+    if (j == size)
+      return eos_family_cache_touch(i);
+  }
+  return NULL;
+}
+
+/* Build the family of an EOS and add it to the front of the cache, evicting
+ * the least recently used entry if the cache is full.  The cache takes
+ * ownership of eos, and destroys it on failure. */
+static EOSFamilyCacheEntry *eos_family_cache_insert(int type, const double param[], int size, LALSimNeutronStarEOS *eos)
+{
+  EOSFamilyCacheEntry *entry;
+  LALSimNeutronStarFamily *fam;
 
-// Calculate lambda1(m1|eos)
-double r = XLALSimNeutronStarRadius(mass1_kg, fam);
-double k = XLALSimNeutronStarLoveNumberK2(mass1_kg, fam);
-double c = mass1 * LAL_MRSUN_SI / r;
-*lambda1= (2.0/3.0) * k / pow(c , 5.0);
+  if (!eos)
+    return NULL;
+  fam = XLALCreateSimNeutronStarFamily(eos);
+  if (!fam) {
+    XLALDestroySimNeutronStarEOS(eos);
+    return NULL;
+  }
 
-// Calculate lambda2(m2|eos)
-r = XLALSimNeutronStarRadius(mass2_kg, fam);
-k = XLALSimNeutronStarLoveNumberK2(mass2_kg, fam);
-c = mass2 * LAL_MRSUN_SI / r;
-*lambda2= (2.0/3.0) * k / pow(c , 5.0);
+  if (eos_family_cache_len == EOS_FAMILY_CACHE_SIZE) {
+    entry = &eos_family_cache[EOS_FAMILY_CACHE_SIZE - 1];
+    XLALDestroySimNeutronStarFamily(entry->fam);
+    XLALDestroySimNeutronStarEOS(entry->eos);
+  } else
+    eos_family_cache_len++;
+  entry = eos_family_cache_touch(eos_family_cache_len - 1);
+  entry->type = type;
+  entry->size = size;
+  for (int j = 0; j < size; j++)
+    entry->param[j] = param[j];
+  entry->eos = eos;
+  entry->fam = fam;
+  entry->checked = 0;
+  return entry;
+}
+
+/* Return the cached family for an EOS parameter set, building it if needed */
+static EOSFamilyCacheEntry *eos_family_cache_get(int type, const double param[], int size)
+{
+  EOSFamilyCacheEntry *entry = eos_family_cache_find(type, param, size);
+  if (entry)
+    return entry;
+  if (type == EOS_FAMILY_POLYTROPE)
+    return eos_family_cache_insert(type, param, size, XLALSimNeutronStarEOS4ParameterPiecewisePolytrope(param[0], param[1], param[2], param[3]));
+  double gamma[EOS_FAMILY_CACHE_MAXPARAM];
+  for (int j = 0; j < size; j++)
+    gamma[j] = param[j];
+  return eos_family_cache_insert(type, param, size, XLALSimNeutronStarEOSSpectralDecomposition(gamma, size));
+}
+
+void LALInferenceClearEOSFamilyCache(void)
+{
+  #pragma omp critical (LALInferenceEOSFamilyCache)
+  {
+    for (int i = 0; i < eos_family_cache_len; i++) {
+      XLALDestroySimNeutronStarFamily(eos_family_cache[i].fam);
+      XLALDestroySimNeutronStarEOS(eos_family_cache[i].eos);
+    }
+    eos_family_cache_len = 0;
+  }
+}
 
-// Clean up
-XLALDestroySimNeutronStarFamily(fam);
-XLALDestroySimNeutronStarEOS(eos);
+/* Find lambda(m|eos) from a neutron star family */
+static double eos_family_lambda(double mass, LALSimNeutronStarFamily *fam)
+{
+  double r = XLALSimNeutronStarRadius(mass * LAL_MSUN_SI, fam);
+  double k = XLALSimNeutronStarLoveNumberK2(mass * LAL_MSUN_SI, fam);
+  double c = mass * LAL_MRSUN_SI / r;
+  return (2.0/3.0) * k / pow(c , 5.0);
+}
+
+/* Find lambda1,2(m1,2|eos) for 4-piece polytrope EOS model */
+void LALInferenceLogp1GammasMasses2Lambdas(REAL8 logp1,REAL8 gamma1,REAL8 gamma2,REAL8 gamma3, REAL8 mass1, REAL8 mass2, REAL8 *lambda1, REAL8 *lambda2){
+// Convert to SI
+const double param[] = {logp1-1.0, gamma1, gamma2, gamma3};
+
+#pragma omp critical (LALInferenceEOSFamilyCache)
+{
+  EOSFamilyCacheEntry *entry = eos_family_cache_get(EOS_FAMILY_POLYTROPE, param, 4);
+  // Calculate lambda1(m1|eos) and lambda2(m2|eos)
+  *lambda1 = entry ? eos_family_lambda(mass1, entry->fam) : XLAL_REAL8_FAIL_NAN;
+  *lambda2 = entry ? eos_family_lambda(mass2, entry->fam) : XLAL_REAL8_FAIL_NAN;
+}
 }
 
 /* Find lambda1,2(m1,2|eos) for spectral EOS model */
@@ -2369,28 +2648,25 @@ if(LALInferenceSDGammaCheck(gamma, 4) == XLAL_FAILURE){
   *lambda2= 0.;
 }
 // Else calculate lambdas
+else if(size <= EOS_FAMILY_CACHE_MAXPARAM){
+  #pragma omp critical (LALInferenceEOSFamilyCache)
+  {
+    EOSFamilyCacheEntry *entry = eos_family_cache_get(EOS_FAMILY_SPECTRAL, gamma, size);
+    // Calculate lambda1(m1|eos) and lambda2(m2|eos)
+    *lambda1 = entry ? eos_family_lambda(mass1, entry->fam) : XLAL_REAL8_FAIL_NAN;
+    *lambda2 = entry ? eos_family_lambda(mass2, entry->fam) : XLAL_REAL8_FAIL_NAN;
+  }
+}
 else{
-  // Convert to SI
-  double mass1_kg=mass1*LAL_MSUN_SI;
-  double mass2_kg=mass2*LAL_MSUN_SI;
-
   // Make eos
   LALSimNeutronStarEOS *eos = NULL;
   LALSimNeutronStarFamily *fam = NULL;
   eos = XLALSimNeutronStarEOSSpectralDecomposition(gamma,size);
   fam = XLALCreateSimNeutronStarFamily(eos);
 
-  // Calculate lambda1(m1|eos)
-  double r = XLALSimNeutronStarRadius(mass1_kg, fam);
-  double k = XLALSimNeutronStarLoveNumberK2(mass1_kg, fam);
-  double c = mass1 * LAL_MRSUN_SI / r;
-  *lambda1= (2.0/3.0) * k / pow(c , 5.0);
-
-  // Calculate lambda2(m1|eos)
-  r = XLALSimNeutronStarRadius(mass2_kg, fam);
-  k = XLALSimNeutronStarLoveNumberK2(mass2_kg, fam);
-  c = mass2 * LAL_MRSUN_SI / r;
-  *lambda2= (2.0/3.0) * k / pow(c , 5.0);
+  // Calculate lambda1(m1|eos) and lambda2(m2|eos)
+  *lambda1 = eos_family_lambda(mass1, fam);
+  *lambda2 = eos_family_lambda(mass2, fam);
 
   // Clean up
   XLALDestroySimNeutronStarFamily(fam);
@@ -2400,12 +2676,46 @@ else{
 }
 
 
-/* Checks if EOS allows for acausal speed of sound and unphysical maximum masses */
-int LALInferenceEOSPhysicalCheck(LALInferenceVariables *params, ProcessParamsTable *commandLine){
+/* FIXME: This is a little clunky,
+  Check to make sure family will contain
+  enough pts for interpolation */
+static int eos_family_too_few_points(LALSimNeutronStarEOS *eos)
+{
+double pdat;
+double mdat;
+double mdat_prev;
+double rdat;
+double kdat;
+
+/* Initialize previous value for mdat comparison, set to something that will always
+   make (mdat <= mdat_prev) == true. */
+mdat_prev = 0.0;
+
+// Ensure mass turnover does not happen too soon
+const double logpmin = 75.5;
+double logpmax = log(XLALSimNeutronStarEOSMaxPressure(eos));
+double dlogp = (logpmax - logpmin) / 100.;
+// Need at least 8 points
+for (int i = 0; i < 4; ++i) {
+   pdat = exp(logpmin + i * dlogp);
+   XLALSimNeutronStarTOVODEIntegrate(&rdat, &mdat, &kdat, pdat, eos);
+   /* determine if maximum mass has been found */
+   if (mdat <= mdat_prev)
+      return 1;
+   mdat_prev = mdat;
+}
+return 0;
+}
+
+/* Body of LALInferenceEOSPhysicalCheck(), which holds the EOS family cache */
+static int eos_physical_check(LALInferenceVariables *params, ProcessParamsTable *commandLine){
 int ret;
 
 LALSimNeutronStarEOS *eos=NULL;
 LALSimNeutronStarFamily *fam=NULL;
+EOSFamilyCacheEntry *entry=NULL;
+int type;
+double param[4];
 
 // If using 4-piece polytrope eos params...
 if(LALInferenceCheckVariable(params, "logp1") && LALInferenceCheckVariable(params, "gamma1") && LALInferenceCheckVariable(params, "gamma2") && LALInferenceCheckVariable(params, "gamma3"))
@@ -2419,8 +2729,16 @@ if(LALInferenceCheckVariable(params, "logp1") && LALInferenceCheckVariable(param
   // Convert to SI
   REAL8 logp1_si=logp1-1.0;
 
-  // Make 4-piece polytrope eos
-  eos = XLALSimNeutronStarEOS4ParameterPiecewisePolytrope(logp1_si,gamma1,gamma2,gamma3);
+  type = EOS_FAMILY_POLYTROPE;
+  param[0] = logp1_si;
+  param[1] = gamma1;
+  param[2] = gamma2;
+  param[3] = gamma3;
+
+  // Make 4-piece polytrope eos, unless its family is cached
+  entry = eos_family_cache_find(type, param, 4);
+  if(!entry)
+    eos = XLALSimNeutronStarEOS4ParameterPiecewisePolytrope(logp1_si,gamma1,gamma2,gamma3);
 
 // Else if using 4-coeff spectral eos params...
 }
@@ -2436,8 +2754,14 @@ else if( LALInferenceCheckVariable(params,"SDgamma0") && LALInferenceCheckVariab
   if(LALInferenceSDGammaCheck(gamma, 4) == XLAL_FAILURE)
     return XLAL_FAILURE;
 
-  // Make 4-piece polytrope eos
-  eos = XLALSimNeutronStarEOSSpectralDecomposition(gamma,4);
+  type = EOS_FAMILY_SPECTRAL;
+  for (int j = 0; j < 4; j++)
+    param[j] = gamma[j];
+
+  // Make spectral eos, unless its family is cached
+  entry = eos_family_cache_find(type, param, 4);
+  if(!entry)
+    eos = XLALSimNeutronStarEOSSpectralDecomposition(gamma,4);
 
 }
 // Else fail, since you need an eos
@@ -2446,50 +2770,37 @@ else {
   return XLAL_FAILURE;
 }
 
-/* FIXME: This is a little clunky,
-  Check to make sure family will contain
-  enough pts for interpolation */
-double pdat;
-double mdat;
-double mdat_prev;
-double rdat;
-double kdat;
-
-/* Initialize previous value for mdat comparison, set to something that will always
-   make (mdat <= mdat_prev) == true. */
-mdat_prev = 0.0;
+if(!entry && !eos)
+  return XLAL_FAILURE;
 
-// Ensure mass turnover does not happen too soon
-const double logpmin = 75.5;
-double logpmax = log(XLALSimNeutronStarEOSMaxPressure(eos));
-double dlogp = (logpmax - logpmin) / 100.;
-// Need at least 8 points
-for (int i = 0; i < 4; ++i) {
-   pdat = exp(logpmin + i * dlogp);
-   XLALSimNeutronStarTOVODEIntegrate(&rdat, &mdat, &kdat, pdat, eos);
-   /* determine if maximum mass has been found */
-   if (mdat <= mdat_prev){
-      fprintf(stdout,"EOS has too few points. Sample rejected.\n");
-      if( LALInferenceCheckVariable(params,"SDgamma0") && LALInferenceCheckVariable(params,"SDgamma1") && LALInferenceCheckVariable(params,"SDgamma2") && LALInferenceCheckVariable(params,"SDgamma3"))
-      {
-        // Retrieve EOS params from params linked list
-        double SDgamma0=*(double *)LALInferenceGetVariable(params,"SDgamma0");
-        double SDgamma1=*(double *)LALInferenceGetVariable(params,"SDgamma1");
-        double SDgamma2=*(double *)LALInferenceGetVariable(params,"SDgamma2");
-        double SDgamma3=*(double *)LALInferenceGetVariable(params,"SDgamma3");
-        fprintf(stdout,"spectral: %f %f %f %f\n",SDgamma0,SDgamma1,SDgamma2,SDgamma3);
-      }
-      // Clean up
-      XLALDestroySimNeutronStarFamily(fam);
-      XLALDestroySimNeutronStarEOS(eos);
-      return XLAL_FAILURE;
+if(!entry || !entry->checked)
+{
+  if(eos_family_too_few_points(entry ? entry->eos : eos))
+  {
+    fprintf(stdout,"EOS has too few points. Sample rejected.\n");
+    if( LALInferenceCheckVariable(params,"SDgamma0") && LALInferenceCheckVariable(params,"SDgamma1") && LALInferenceCheckVariable(params,"SDgamma2") && LALInferenceCheckVariable(params,"SDgamma3"))
+    {
+      // Retrieve EOS params from params linked list
+      double SDgamma0=*(double *)LALInferenceGetVariable(params,"SDgamma0");
+      double SDgamma1=*(double *)LALInferenceGetVariable(params,"SDgamma1");
+      double SDgamma2=*(double *)LALInferenceGetVariable(params,"SDgamma2");
+      double SDgamma3=*(double *)LALInferenceGetVariable(params,"SDgamma3");
+      fprintf(stdout,"spectral: %f %f %f %f\n",SDgamma0,SDgamma1,SDgamma2,SDgamma3);
     }
-    mdat_prev = mdat;
-}
-
+    // Clean up
+    XLALDestroySimNeutronStarEOS(eos);
+    return XLAL_FAILURE;
+  }
 
-// Make family
-fam = XLALCreateSimNeutronStarFamily(eos);
+  // Make family
+  if(!entry)
+    entry = eos_family_cache_insert(type, param, 4, eos);
+  if(!entry)
+    return XLAL_FAILURE;
+  entry->checked = 1;
+}
+eos = entry->eos;
+fam = entry->fam;
 
 // Determine which mass parameterization is used
 double mass1 = 0.;
@@ -2516,9 +2827,6 @@ else if(LALInferenceCheckVariable(params, "chirpmass") && LALInferenceCheckVaria
 else {
   // Else fail
   fprintf(stdout,"ERROR: NO MASS PARAMETERS FOUND\n");
-  // Clean up
-  XLALDestroySimNeutronStarFamily(fam);
-  XLALDestroySimNeutronStarEOS(eos);
   return XLAL_FAILURE;
 }
 
@@ -2553,9 +2861,14 @@ if(mass1_kg <= max_mass_kg && mass2_kg <= max_mass_kg && mass1_kg >= min_mass_kg
   ret=XLAL_FAILURE;
 }
 
-// Clean up
-XLALDestroySimNeutronStarFamily(fam);
-XLALDestroySimNeutronStarEOS(eos);
+return ret;
+}
+
+/* Checks if EOS allows for acausal speed of sound and unphysical maximum masses */
+int LALInferenceEOSPhysicalCheck(LALInferenceVariables *params, ProcessParamsTable *commandLine){
+int ret;
+#pragma omp critical (LALInferenceEOSFamilyCache)
+ret = eos_physical_check(params, commandLine);
 return ret;
 }
 
@@ -4033,14 +4346,25 @@ void LALInferenceAddREAL8Variable(LALInferenceVariables * vars, const char * nam
 REAL8 LALInferenceGetREAL8Variable(LALInferenceVariables * vars, const char * name)
 /* Typed version of LALInferenceGetVariable for REAL8 values.*/
 {
+  LALInferenceVariableItem *item=LALInferenceGetItem(vars,name);
 
-  if(LALInferenceGetVariableType(vars,name)!=LALINFERENCE_REAL8_t){
+  if(!item || item->type!=LALINFERENCE_REAL8_t){
     XLAL_ERROR_REAL8(XLAL_ETYPE, "Entry \"%s\" not found or of wrong type.", name);
   }
 
-  REAL8* rvalue=(REAL8*)LALInferenceGetVariable(vars,name);
+  return *(REAL8 *)item->value;
+}
 
-  return *rvalue;
+REAL8 *LALInferenceGetREAL8VariableHandle(LALInferenceVariables * vars, const char * name)
+/* Resolve the storage of a REAL8 variable once, for repeated access */
+{
+  LALInferenceVariableItem *item=LALInferenceGetItem(vars,name);
+
+  if(!item || item->type!=LALINFERENCE_REAL8_t){
+    XLAL_ERROR_NULL(XLAL_ETYPE, "Entry \"%s\" not found or of wrong type.", name);
+  }
+
+  return (REAL8 *)item->value;
 }
 
 void LALInferenceSetREAL8Variable(LALInferenceVariables* vars,const char* name,REAL8 value){
@@ -4422,6 +4746,166 @@ int LALInferenceSplineCalibrationFactorROQ(REAL8Vector *logfreqs,
   }
 }
 
+/* allocate spline calibration weights and factorise the tridiagonal system
+ * for the second derivatives of the natural spline through the nodes */
+static LALInferenceSplineCalibrationWeights *spline_calibration_weights_alloc(const REAL8Vector *logfreqs, UINT4 length)
+{
+  LALInferenceSplineCalibrationWeights *w = NULL;
+  UINT4 i, N;
+
+  XLAL_CHECK_NULL(logfreqs != NULL, XLAL_EFAULT);
+  N = logfreqs->length;
+  XLAL_CHECK_NULL(N >= 3, XLAL_EINVAL, "need at least 3 spline nodes, got %u", N);
+  for (i = 1; i < N; i++) {
+    XLAL_CHECK_NULL(logfreqs->data[i] > logfreqs->data[i-1], XLAL_EINVAL, "spline nodes must be increasing");
+  }
+
+  w = XLALCalloc(1, sizeof(*w));
+  XLAL_CHECK_NULL(w != NULL, XLAL_ENOMEM);
+  w->n_nodes = N;
+  w->length = length;
+  w->logfreqs = XLALMalloc(N*sizeof(REAL8));
+  w->h = XLALMalloc((N-1)*sizeof(REAL8));
+  w->mult = XLALCalloc(N, sizeof(REAL8));
+  w->invdiag = XLALCalloc(N, sizeof(REAL8));
+  w->work = XLALCalloc(2*N, sizeof(REAL8));
+  w->interval = XLALCalloc(length > 0 ? length : 1, sizeof(UINT4));
+  w->coeffs = XLALCalloc(length > 0 ? 4*length : 1, sizeof(REAL8));
+  if (!w->logfreqs || !w->h || !w->mult || !w->invdiag || !w->work || !w->interval || !w->coeffs) {
+    LALInferenceDestroySplineCalibrationWeights(w);
+    XLAL_ERROR_NULL(XLAL_ENOMEM);
+  }
+
+  for (i = 0; i < N; i++) w->logfreqs[i] = logfreqs->data[i];
+  for (i = 0; i < N-1; i++) w->h[i] = logfreqs->data[i+1] - logfreqs->data[i];
+
+  /* h[i-1] M[i-1] + 2 (h[i-1] + h[i]) M[i] + h[i] M[i+1] = r[i] for the
+   * interior nodes, with M = 0 at both ends */
+  w->invdiag[1] = 1.0/(2.0*(w->h[0] + w->h[1]));
+  for (i = 2; i < N-1; i++) {
+    w->mult[i] = w->h[i-1]*w->invdiag[i-1];
+    w->invdiag[i] = 1.0/(2.0*(w->h[i-1] + w->h[i]) - w->mult[i]*w->h[i-1]);
+  }
+
+  return w;
+}
+
+/* interval and coefficients of entry k at frequency f */
+static void spline_calibration_weights_set(LALInferenceSplineCalibrationWeights *w, UINT4 k, REAL8 f)
+{
+  const UINT4 N = w->n_nodes;
+  UINT4 lo = 0, hi = N-1;
+  REAL8 t, A, B, h2;
+
+  /* same support as LALInferenceSplineCalibrationFactor() */
+  if (f < exp(w->logfreqs[0]) || f > exp(w->logfreqs[N-1])) return;
+
+  REAL8 x = log(f);
+  while (hi - lo > 1) {
+    UINT4 mid = (lo + hi)/2;
+    if (x < w->logfreqs[mid]) hi = mid;
+    else lo = mid;
+  }
+  t = (x - w->logfreqs[lo])/w->h[lo];
+  A = 1.0 - t;
+  B = t;
+  h2 = w->h[lo]*w->h[lo]/6.0;
+  w->interval[k] = lo;
+  w->coeffs[4*k] = A;
+  w->coeffs[4*k+1] = B;
+  w->coeffs[4*k+2] = (A*A*A - A)*h2;
+  w->coeffs[4*k+3] = (B*B*B - B)*h2;
+}
+
+LALInferenceSplineCalibrationWeights *LALInferenceCreateSplineCalibrationWeights(const REAL8Vector *logfreqs,
+										REAL8 deltaF, UINT4 length)
+{
+  LALInferenceSplineCalibrationWeights *w = NULL;
+
+  XLAL_CHECK_NULL(deltaF > 0.0, XLAL_EINVAL, "deltaF must be positive");
+  w = spline_calibration_weights_alloc(logfreqs, length);
+  XLAL_CHECK_NULL(w != NULL, XLAL_EFUNC);
+  w->deltaF = deltaF;
+  for (UINT4 k = 0; k < length; k++) spline_calibration_weights_set(w, k, deltaF*k);
+
+  return w;
+}
+
+LALInferenceSplineCalibrationWeights *LALInferenceCreateSplineCalibrationWeightsNodes(const REAL8Vector *logfreqs,
+										     const REAL8Sequence *freqs)
+{
+  LALInferenceSplineCalibrationWeights *w = NULL;
+
+  XLAL_CHECK_NULL(freqs != NULL, XLAL_EFAULT);
+  w = spline_calibration_weights_alloc(logfreqs, freqs->length);
+  XLAL_CHECK_NULL(w != NULL, XLAL_EFUNC);
+  for (UINT4 k = 0; k < freqs->length; k++) spline_calibration_weights_set(w, k, freqs->data[k]);
+
+  return w;
+}
+
+void LALInferenceDestroySplineCalibrationWeights(LALInferenceSplineCalibrationWeights *weights)
+{
+  while (weights) {
+    LALInferenceSplineCalibrationWeights *next = weights->next;
+    XLALFree(weights->logfreqs);
+    XLALFree(weights->h);
+    XLALFree(weights->mult);
+    XLALFree(weights->invdiag);
+    XLALFree(weights->work);
+    XLALFree(weights->interval);
+    XLALFree(weights->coeffs);
+    XLALFree(weights);
+    weights = next;
+  }
+}
+
+/* second derivatives M of the natural spline through the values y */
+static void spline_calibration_second_derivatives(const LALInferenceSplineCalibrationWeights *w, const REAL8 *y, REAL8 *M)
+{
+  const UINT4 N = w->n_nodes;
+  const REAL8 *h = w->h;
+  UINT4 i;
+
+  M[0] = M[N-1] = 0.0;
+  for (i = 1; i < N-1; i++) {
+    M[i] = 6.0*((y[i+1] - y[i])/h[i] - (y[i] - y[i-1])/h[i-1]);
+    if (i > 1) M[i] -= w->mult[i]*M[i-1];
+  }
+  M[N-2] *= w->invdiag[N-2];
+  for (i = N-2; i-- > 1; ) {
+    M[i] = (M[i] - h[i]*M[i+1])*w->invdiag[i];
+  }
+}
+
+int LALInferenceApplySplineCalibrationWeights(LALInferenceSplineCalibrationWeights *weights,
+					      const REAL8Vector *deltaAmps,
+					      const REAL8Vector *deltaPhases,
+					      COMPLEX16 *calFactor)
+{
+  XLAL_CHECK(weights != NULL && deltaAmps != NULL && deltaPhases != NULL && calFactor != NULL, XLAL_EFAULT);
+  XLAL_CHECK(deltaAmps->length == weights->n_nodes && deltaPhases->length == weights->n_nodes, XLAL_EINVAL, "input lengths differ");
+
+  const REAL8 *a = deltaAmps->data, *p = deltaPhases->data;
+  REAL8 *Ma = weights->work, *Mp = weights->work + weights->n_nodes;
+  spline_calibration_second_derivatives(weights, a, Ma);
+  spline_calibration_second_derivatives(weights, p, Mp);
+
+  /* four non-zero weights per frequency, and (2 + i dPhi)/(2 - i dPhi) =
+   * (4 - dPhi^2 + 4 i dPhi)/(4 + dPhi^2) */
+  for (UINT4 k = 0; k < weights->length; k++) {
+    const UINT4 j = weights->interval[k];
+    const REAL8 *c = weights->coeffs + 4*k;
+    REAL8 dA = c[0]*a[j] + c[1]*a[j+1] + c[2]*Ma[j] + c[3]*Ma[j+1];
+    REAL8 dPhi = c[0]*p[j] + c[1]*p[j+1] + c[2]*Mp[j] + c[3]*Mp[j+1];
+    REAL8 dPhi2 = dPhi*dPhi;
+    REAL8 r = (1.0 + dA)/(4.0 + dPhi2);
+    calFactor[k] = crect(r*(4.0 - dPhi2), 4.0*r*dPhi);
+  }
+
+  return XLAL_SUCCESS;
+}
+
 void LALInferenceFprintSplineCalibrationHeader(FILE *output, LALInferenceThreadState *thread) {
     INT4 i, nifo;
     char **ifo_names = NULL;
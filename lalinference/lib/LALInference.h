@@ -100,6 +100,8 @@ struct tagLALInferenceRunState;
 struct tagLALInferenceThreadState;
 struct tagLALInferenceIFOData;
 struct tagLALInferenceModel;
+struct tagLALInferenceCompiledPrior;
+struct tagLALInferenceProfile;
 
 /*Data storage type definitions*/
 
@@ -314,7 +316,13 @@ int LALInferenceCheckVariableToPrint(LALInferenceVariables *vars, const char *na
  */
 void LALInferenceClearVariables(LALInferenceVariables *vars);
 
-/** Deep copy the variables from one to another LALInferenceVariables structure */
+/**
+ * Deep copy the variables from one to another LALInferenceVariables structure.
+ * If \c target already holds the same variables in the same order with the
+ * same types (and vector and matrix sizes) the values are overwritten in
+ * place, so that pointers obtained from \c target remain valid; otherwise
+ * \c target is cleared and rebuilt.
+ */
 void LALInferenceCopyVariables(LALInferenceVariables *origin, LALInferenceVariables *target);
 
 /*  Copy REAL8s from "origin" to "target" if they weren't set on the command line */
@@ -372,6 +380,53 @@ int LALInferenceSplineCalibrationFactorROQ(REAL8Vector *logfreqs,
 					REAL8Sequence *freqNodesQuad,
 					COMPLEX16Sequence **calFactorROQQuad);
 
+#ifndef SWIG   /* exclude from SWIG interface */
+/**
+ * Precomputed weights of the natural cubic spline calibration model on a
+ * fixed set of frequencies.  The spline is linear in the values at the
+ * nodes, so each frequency only needs the index of its spline interval and
+ * four coefficients, multiplying the values and second derivatives at the
+ * ends of the interval.  The second derivatives follow from the values
+ * through a tridiagonal system whose factorisation is also stored, so that
+ * LALInferenceApplySplineCalibrationWeights() needs no spline setup.
+ */
+typedef struct
+tagLALInferenceSplineCalibrationWeights
+{
+  UINT4 n_nodes; /** Number of spline nodes */
+  UINT4 length; /** Number of frequencies */
+  REAL8 deltaF; /** Frequency spacing of a uniform grid, 0 for a list of frequencies */
+  REAL8 *logfreqs; /** Logarithms of the node frequencies */
+  REAL8 *h; /** Widths of the spline intervals */
+  REAL8 *mult, *invdiag; /** Elimination multipliers and inverse pivots of the tridiagonal system */
+  REAL8 *work; /** Second derivatives of the amplitude and phase, 2*n_nodes */
+  UINT4 *interval; /** Spline interval of each frequency */
+  REAL8 *coeffs; /** Four coefficients for each frequency, zero outside the nodes */
+  UINT4 ifo, set; /** Detector index and frequency set, for lookups */
+  struct tagLALInferenceSplineCalibrationWeights *next; /** Next set of weights in a list */
+} LALInferenceSplineCalibrationWeights;
+
+/** Spline calibration weights on the frequencies deltaF*i, i = 0 ... length-1 */
+LALInferenceSplineCalibrationWeights *LALInferenceCreateSplineCalibrationWeights(const REAL8Vector *logfreqs,
+										REAL8 deltaF, UINT4 length);
+
+/** Spline calibration weights on an arbitrary list of frequencies, such as ROQ nodes */
+LALInferenceSplineCalibrationWeights *LALInferenceCreateSplineCalibrationWeightsNodes(const REAL8Vector *logfreqs,
+										     const REAL8Sequence *freqs);
+
+/** Free a list of spline calibration weights */
+void LALInferenceDestroySplineCalibrationWeights(LALInferenceSplineCalibrationWeights *weights);
+
+/**
+ * Fill calFactor, of length weights->length, with the calibration factor of
+ * LALInferenceSplineCalibrationFactor() for the given node values.
+ */
+int LALInferenceApplySplineCalibrationWeights(LALInferenceSplineCalibrationWeights *weights,
+					      const REAL8Vector *deltaAmps,
+					      const REAL8Vector *deltaPhases,
+					      COMPLEX16 *calFactor);
+#endif /* SWIG */
+
 
 //Wrapper for template computation
 //(relies on LAL libraries for implementation) <- could be a #DEFINE ?
@@ -471,7 +526,11 @@ typedef struct tagLALInferenceModel
   REAL8                        padding; /** The padding of the above window */
   struct tagLALInferenceROQModel *roq; /** ROQ data */
   int roq_flag;               /** Is ROQ enabled */
+  struct tagLALInferenceRelativeBinningModel *relbin; /** Relative binning buffers, NULL if not enabled */
+  struct tagLALInferenceMultibandCache *multiband; /** Multiband grids of the phase interpolated template, NULL until first used */
+  struct tagLALInferenceSplineCalibrationWeights *spcal; /** Spline calibration weights of each detector, NULL until first used */
   LALSimNeutronStarFamily     *eos_fam; /** Neutron Star equation of state family */
+  struct tagLALInferenceProfile *profile; /** Hot-path timers of the chain using this model, NULL unless profiling */
 
 } LALInferenceModel;
 
@@ -513,6 +572,30 @@ typedef void (*LALInferenceAlgorithm) (struct tagLALInferenceRunState *runState)
 typedef void (*LALInferenceLogFunction) (LALInferenceVariables *algorithmParams, LALInferenceVariables *vars);
 
 
+/**
+ * Number of calls and accumulated wall-clock time of one instrumented
+ * section of the sampler, see LALInferenceProfile.
+ */
+typedef struct
+tagLALInferenceTimer
+{
+    UINT8 calls; /** Number of timed calls */
+    REAL8 time;  /** Total wall-clock time of the calls, in seconds */
+} LALInferenceTimer;
+
+/**
+ * Hot-path profile of a chain.  The timers are only updated while the
+ * chain's model points at the profile through \c model->profile.
+ */
+typedef struct
+tagLALInferenceProfile
+{
+    LALInferenceTimer proposal;   /** Jump proposals */
+    LALInferenceTimer prior;      /** Prior evaluations */
+    LALInferenceTimer likelihood; /** Likelihood evaluations, including template generation */
+    LALInferenceTimer templt;     /** Template generation within the likelihood */
+} LALInferenceProfile;
+
 /**
  * Structure for holding a LALInference proposal, along with name and stats.
  */
@@ -525,6 +608,7 @@ tagLALInferenceProposal
     INT4   proposed;   // Number of times proposal has been called
     INT4   accepted;   // Number of times a proposal from this function has been accepted
     LALInferenceVariables *args; /** Local storage for arguments needed by the proposal (e.g. number of detectors) */
+    LALInferenceTimer timer; /** Calls and wall-clock time of the proposal function, when profiling */
 } LALInferenceProposal;
 
 /**
@@ -574,6 +658,9 @@ tagLALInferenceThreadState
                                         Can also be removed. */
     size_t differentialPointsSkip; /** When the DE buffer gets too long, start storing
                                        only every n-th output point; this counter stores n */
+    size_t differentialPointsSaved; /** Number of leading differential points already
+                                        written to the checkpoint, so that only newer
+                                        points need to be appended */
     REAL8 *currentIFOSNRs; /** Array storing single-IFO SNRs of current sample */
     REAL8 *currentIFOLikelihoods; /** Array storing single-IFO likelihoods of current sample */
     REAL8 currentSNR; /** Array storing network SNR of current sample */
@@ -588,6 +675,8 @@ tagLALInferenceThreadState
     INT4 *temp_swap_accepts;
     INT4 temp_swap_window;
     INT4 temp_swap_counter;
+    struct tagLALInferenceCompiledPrior *compiledPrior; /** Compiled prior bounds for this thread's priorArgs, built on demand */
+    LALInferenceProfile profile; /** Hot-path timers, filled in when model->profile points here */
 } LALInferenceThreadState;
 
 
@@ -619,6 +708,7 @@ tagLALInferenceRunState
   char *resumeOutFileName; /** Name for thread's resume file */
   char runID[VARNAME_MAX];
   LALInferenceThreadState          *threads; /** Array of chains for this run */
+  struct tagLALInferenceCompiledPrior *compiledPrior; /** Compiled form of priorArgs used by the prior function, built on demand */
 
 } LALInferenceRunState;
 
@@ -665,6 +755,7 @@ tagLALInferenceIFOData
   UINT4                     likeli_counter; /** counts how many time the likelihood has been calculated */
   UINT4                     templa_counter; /** counts how many time the template has been calculated */
   struct tagLALInferenceROQData *roq; /** ROQ data */
+  struct tagLALInferenceRelativeBinningData *relbin; /** Relative binning summary data */
 
   struct tagLALInferenceIFOData      *next;     /** A pointer to the next set of data for linked list */
 } LALInferenceIFOData;
@@ -682,6 +773,7 @@ tagLALInferenceROQData
 
 
   struct tagLALInferenceROQSplineWeightsLinear *weights_linear;
+  struct tagLALInferenceROQTimeWeights *time_weights; /** weights for <d|h> tabulated in time, see LALInferenceCreateROQTimeWeights() */
 
  
   /* Deprecated functions that should be removed at some point */ 
@@ -707,6 +799,21 @@ tagLALInferenceROQSplineWeightsLinear
   gsl_interp_accel *acc_imag_weight_linear;
 
 } LALInferenceROQSplineWeights;
+
+#ifndef SWIG   /* exclude from SWIG interface */
+/**
+ * Structure to contain the ROQ weights for <d|h> on a grid of times, laid
+ * out time-major for interpolation in time, see LALInferenceGenerateROQ.h
+ */
+typedef struct
+tagLALInferenceROQTimeWeights
+{
+  UINT4 n_times; /** Number of times */
+  UINT4 n_nodes; /** Number of frequency nodes */
+  REAL8 *times; /** Increasing times at which the weights are given */
+  REAL8 *table; /** For each time and node, the real and imaginary parts of the weight followed by those of its second time derivative */
+} LALInferenceROQTimeWeights;
+#endif /* SWIG */
 /**
  *  * Structure to contain model-related Reduced Order Quadrature quantities
  *   */
@@ -740,6 +847,34 @@ tagLALInferenceROQModel
 
 } LALInferenceROQModel;
 
+#ifndef SWIG   /* exclude from SWIG interface */
+/**
+ * Structure to contain data-related relative binning quantities, see
+ * LALInferenceRelativeBinning.h
+ */
+typedef struct
+tagLALInferenceRelativeBinningData
+{
+  REAL8Sequence *frequencies; /** Bin edge frequencies */
+  COMPLEX16 *h0plus, *h0cross; /** Fiducial polarisations at the bin edges */
+  COMPLEX16 *A0[2], *A1[2]; /** Summary data for <d|h> in each bin, for the plus and cross polarisations */
+  COMPLEX16 *B0[3], *B1[3], *B2[3]; /** Summary data for <h|h> in each bin, for plus-plus, cross-cross and plus-cross */
+  REAL8 dd; /** <d|d> */
+  REAL8 tau0; /** Time shift of the fiducial waveform into the detector */
+} LALInferenceRelativeBinningData;
+#endif /* SWIG */
+
+/**
+ * Structure to contain model-related relative binning quantities
+ */
+typedef struct
+tagLALInferenceRelativeBinningModel
+{
+  REAL8Sequence *frequencies; /** Frequencies at which the template is generated */
+  COMPLEX16FrequencySeries *hptilde, *hctilde; /** Template at the frequencies */
+  COMPLEX16Sequence *calFactor; /** Calibration factors at the frequencies */
+} LALInferenceRelativeBinningModel;
+
 /**
  * Structure to contain data-related Reduced Order Quadrature quantities
  */
@@ -837,6 +972,26 @@ int LALInferencePrintProposalStatsHeader(FILE *fp, LALInferenceProposalCycle *cy
 /** Output proposal statistics to file *fp */
 void LALInferencePrintProposalStats(FILE *fp, LALInferenceProposalCycle *cycle);
 
+/** Monotonic wall-clock time in seconds, for the profiling timers */
+REAL8 LALInferenceProfileClock(void);
+
+/**
+ * Add the time elapsed since \c start, as returned by
+ * LALInferenceProfileClock(), to \c timer and count a call.  Returns the
+ * current time, so that consecutive sections can be timed in a row.
+ */
+REAL8 LALInferenceTimerAccumulate(LALInferenceTimer *timer, REAL8 start);
+
+/**
+ * Collect the profile of a chain, and the calls and times of each
+ * proposal in its cycle, into a new set of variables, with entries named
+ * <section>_calls and <section>_time.
+ */
+LALInferenceVariables *LALInferenceProfileToVariables(LALInferenceThreadState *thread);
+
+/** Print the profile of a chain to file *fp */
+void LALInferencePrintProfile(FILE *fp, LALInferenceThreadState *thread);
+
 /**
  * Reads one line from the given file and stores the values there into
  * the variable structure, using the given header array to name the
@@ -895,6 +1050,10 @@ void LALInferenceSDGammasMasses2Lambdas(REAL8 gamma[], REAL8 mass1, REAL8 mass2,
 /** Check for causality violation and mass conflict given masses and eos */
 int LALInferenceEOSPhysicalCheck(LALInferenceVariables *params, ProcessParamsTable *commandLine);
 
+/** Free the neutron star families that the three functions above keep for
+ * the most recently used EOS parameter sets */
+void LALInferenceClearEOSFamilyCache(void);
+
 /** Specral decomposition of eos's adiabatic index */
 double AdiabaticIndex(double gamma[],double x, int size);
 
@@ -1127,6 +1286,17 @@ REAL8 LALInferenceGetREAL8Variable(LALInferenceVariables * vars, const char * na
 
 void LALInferenceSetREAL8Variable(LALInferenceVariables* vars,const char* name,REAL8 value);
 
+/**
+ * Return a pointer to the storage of the REAL8 variable \c name, or NULL
+ * if it is absent or of another type.  The pointer stays valid until the
+ * variable is removed or \c vars is cleared (including by a
+ * LALInferenceCopyVariables() that has to rebuild \c vars), so hot
+ * parameters can be resolved once instead of looked up by name each time.
+ */
+#ifndef SWIG   /* exclude from SWIG interface */
+REAL8 *LALInferenceGetREAL8VariableHandle(LALInferenceVariables * vars, const char * name);
+#endif /* SWIG */
+
 void LALInferenceAddCOMPLEX8Variable(LALInferenceVariables * vars, const char * name, COMPLEX8 value, LALInferenceParamVaryType vary);
 
 COMPLEX8 LALInferenceGetCOMPLEX8Variable(LALInferenceVariables * vars, const char * name);
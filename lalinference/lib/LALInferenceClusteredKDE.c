@@ -463,12 +463,18 @@ void LALInferenceKmeansRecursiveSplit(LALInferenceKmeans *kmeans,
  *
  * Starting with some random initialization, points are assigned to the closest
  *  centroids, then the centroids are calculated of the new cluster.  This is
- *  repeated until the assignments stop changing.
+ *  repeated until the assignments stop changing.  If \a kmeans->batch_size is
+ *  set and smaller than the data set, mini-batch steps are taken first.
  * @param kmeans The initialized kmeans to run.
  */
 void LALInferenceKmeansRun(LALInferenceKmeans *kmeans) {
     INT4 i;
 
+    /* Bring the centroids close to convergence on a large data set with
+     * cheap mini-batch steps, so that few full passes are needed */
+    if (kmeans->batch_size > 0 && kmeans->batch_size < kmeans->npts)
+        LALInferenceKmeansMiniBatch(kmeans);
+
     while (kmeans->has_changed) {
         kmeans->has_changed = 0;
 
@@ -502,20 +508,30 @@ LALInferenceKmeans *LALInferenceKmeansRunBestOf(INT4 k,
 
     LALInferenceKmeans *best_kmeans = NULL;
     REAL8 best_bic = -INFINITY;
+    INT4 best_trial = ntrials;
 
     /* Don't bother with multiple trials if k=1 */
     if (k == 1)
         ntrials = 1;
 
+    /* Give each trial its own generator, seeded in order from rng, so
+     * trials can run concurrently and the result doesn't depend on the
+     * number of threads */
+    gsl_rng **trial_rngs = XLALCalloc(ntrials, sizeof(gsl_rng *));
+    for (i = 0; i < ntrials; i++) {
+        trial_rngs[i] = gsl_rng_alloc(gsl_rng_mt19937);
+        gsl_rng_set(trial_rngs[i], gsl_rng_get(rng));
+    }
+
     #pragma omp parallel
     {
         LALInferenceKmeans *kmeans;
         REAL8 bic = 0;
         REAL8 error = -INFINITY;
 
-        #pragma omp for
+        #pragma omp for schedule(dynamic)
         for (i = 0; i < ntrials; i++) {
-            kmeans = LALInferenceCreateKmeans(k, samples, rng);
+            kmeans = LALInferenceCreateKmeans(k, samples, trial_rngs[i]);
             if (!kmeans)
                 continue;
 
@@ -529,12 +545,14 @@ LALInferenceKmeans *LALInferenceKmeansRunBestOf(INT4 k,
                 bic = LALInferenceKmeansBIC(kmeans);
             }
 
+            /* Ties go to the earliest trial */
             #pragma omp critical
             {
-                if (bic > best_bic) {
+                if (bic > best_bic || (bic == best_bic && i < best_trial)) {
                     if (best_kmeans)
                         LALInferenceKmeansDestroy(best_kmeans);
                     best_bic = bic;
+                    best_trial = i;
                     best_kmeans = kmeans;
                 } else {
                     LALInferenceKmeansDestroy(kmeans);
@@ -543,6 +561,14 @@ LALInferenceKmeans *LALInferenceKmeansRunBestOf(INT4 k,
         }
     }
 
+    /* Hand the caller's generator to the surviving clustering */
+    if (best_kmeans)
+        best_kmeans->rng = rng;
+
+    for (i = 0; i < ntrials; i++)
+        gsl_rng_free(trial_rngs[i]);
+    XLALFree(trial_rngs);
+
     return best_kmeans;
 }
 
@@ -570,6 +596,9 @@ LALInferenceKmeans *LALInferenceCreateKmeans(INT4 k,
     kmeans->dim = data->size2;
     kmeans->has_changed = 1;
     kmeans->rng = rng;
+    kmeans->batch_size = 0;
+    if (kmeans->npts > LALINFERENCE_KMEANS_MINIBATCH_NPTS)
+        kmeans->batch_size = LALINFERENCE_KMEANS_BATCH_SIZE;
 
     /* Allocate GSL matrices and vectors */
     kmeans->mean = gsl_vector_alloc(kmeans->dim);
@@ -662,6 +691,7 @@ void LALInferenceKmeansSeededInitialize(LALInferenceKmeans *kmeans) {
         u++;
     }
 
+    gsl_vector_free(dists);
     gsl_permutation_free(p);
 }
 
@@ -716,14 +746,16 @@ void LALInferenceKmeansRandomPartitionInitialize(LALInferenceKmeans *kmeans) {
  * @param kmeans The kmeans to perform the assignment step on.
  */
 void LALInferenceKmeansAssignment(LALInferenceKmeans *kmeans) {
-    INT4 i, j;
-
-    kmeans->error = 0.;
+    INT4 i;
+    INT4 n_changed = 0;
+    REAL8 error = 0.;
 
+    #pragma omp parallel for schedule(static) reduction(+:error,n_changed)
     for (i = 0; i < kmeans->npts; i++) {
         gsl_vector_view x = gsl_matrix_row(kmeans->data, i);
         gsl_vector_view c;
 
+        INT4 j;
         INT4 best_cluster = 0;
         REAL8 best_dist = INFINITY;
         REAL8 dist;
@@ -742,12 +774,16 @@ void LALInferenceKmeansAssignment(LALInferenceKmeans *kmeans) {
         /* Check if the point's assignment has changed */
         INT4 current_cluster = kmeans->assignments[i];
         if (best_cluster != current_cluster) {
-            kmeans->has_changed = 1;
+            n_changed++;
             kmeans->assignments[i] = best_cluster;
         }
-        kmeans->error += best_dist;
+        error += best_dist;
     }
 
+    kmeans->error = error;
+    if (n_changed)
+        kmeans->has_changed = 1;
+
     /* Recalculate cluster sizes */
     for (i = 0; i < kmeans->k; i++)
         kmeans->sizes[i] = 0;
@@ -776,6 +812,79 @@ void LALInferenceKmeansUpdate(LALInferenceKmeans *kmeans) {
 
 
 
+/**
+ * Mini-batch steps of the kmeans algorithm.
+ *
+ * Move the centroids towards random batches of \a kmeans->batch_size points,
+ *  each centroid with a learning rate inversely proportional to the number of
+ *  points it has been assigned so far (Sculley 2010).  Steps are taken until
+ *  the centroids move by less than ::LALINFERENCE_KMEANS_MINIBATCH_TOL per
+ *  step, or ::LALINFERENCE_KMEANS_MINIBATCH_STEPS steps have been taken.  The
+ *  assignments are left to the full kmeans steps that follow.
+ * @param kmeans The kmeans to perform the mini-batch steps on.
+ */
+void LALInferenceKmeansMiniBatch(LALInferenceKmeans *kmeans) {
+    INT4 b, i, j, step;
+    INT4 batch_size = kmeans->batch_size;
+
+    INT4 *batch = XLALCalloc(batch_size, sizeof(INT4));
+    INT4 *batch_assignments = XLALCalloc(batch_size, sizeof(INT4));
+    REAL8 *counts = XLALCalloc(kmeans->k, sizeof(REAL8));
+
+    for (step = 0; step < LALINFERENCE_KMEANS_MINIBATCH_STEPS; step++) {
+        REAL8 shift = 0.;
+
+        for (b = 0; b < batch_size; b++)
+            batch[b] = gsl_rng_uniform_int(kmeans->rng, kmeans->npts);
+
+        /* Assign the batch to the current centroids */
+        #pragma omp parallel for schedule(static)
+        for (b = 0; b < batch_size; b++) {
+            gsl_vector_view x = gsl_matrix_row(kmeans->data, batch[b]);
+            gsl_vector_view c;
+            INT4 cluster;
+            INT4 best_cluster = 0;
+            REAL8 best_dist = INFINITY;
+            REAL8 dist;
+
+            for (cluster = 0; cluster < kmeans->k; cluster++) {
+                c = gsl_matrix_row(kmeans->centroids, cluster);
+                dist = kmeans->dist(&x.vector, &c.vector);
+
+                if (dist < best_dist) {
+                    best_cluster = cluster;
+                    best_dist = dist;
+                }
+            }
+            batch_assignments[b] = best_cluster;
+        }
+
+        /* Take a gradient step for each point in the batch */
+        for (b = 0; b < batch_size; b++) {
+            REAL8 eta;
+
+            j = batch_assignments[b];
+            counts[j] += 1.;
+            eta = 1./counts[j];
+
+            for (i = 0; i < kmeans->dim; i++) {
+                REAL8 c = gsl_matrix_get(kmeans->centroids, j, i);
+                REAL8 delta = eta * (gsl_matrix_get(kmeans->data, batch[b], i) - c);
+                gsl_matrix_set(kmeans->centroids, j, i, c + delta);
+                shift += delta*delta;
+            }
+        }
+
+        if (shift < LALINFERENCE_KMEANS_MINIBATCH_TOL * kmeans->k)
+            break;
+    }
+
+    XLALFree(batch);
+    XLALFree(batch_assignments);
+    XLALFree(counts);
+}
+
+
 /**
  * Construct a mask to select only the data assigned to a single cluster.
  *
@@ -1305,7 +1414,12 @@ REAL8 LALInferenceKmeansBIC(LALInferenceKmeans *kmeans) {
     REAL8 N = (REAL8) kmeans->npts;
     REAL8 d = (REAL8) kmeans->dim;
 
+    /* Build the KDEs up front so the points can be evaluated concurrently */
+    if (kmeans->KDEs == NULL)
+        LALInferenceKmeansBuildKDE(kmeans);
+
     log_l = 0.;
+    #pragma omp parallel for schedule(static) reduction(+:log_l)
     for (i = 0; i < kmeans->npts; i++) {
         gsl_vector_view pt = gsl_matrix_row(kmeans->data, i);
         log_l += LALInferenceWhitenedKmeansPDF(kmeans, (&pt.vector)->data);
@@ -30,6 +30,18 @@
 
 struct tagkmeans;
 
+/** Data sets larger than this use mini-batch steps before full kmeans steps. */
+#define LALINFERENCE_KMEANS_MINIBATCH_NPTS 20000
+
+/** Default number of points in a kmeans mini-batch. */
+#define LALINFERENCE_KMEANS_BATCH_SIZE 2000
+
+/** Maximum number of kmeans mini-batch steps. */
+#define LALINFERENCE_KMEANS_MINIBATCH_STEPS 100
+
+/** Squared centroid shift per step, per centroid, that ends the mini-batch steps. */
+#define LALINFERENCE_KMEANS_MINIBATCH_TOL 1e-6
+
 /**
  * Structure for performing the kmeans clustering algorithm on a set of samples.
  */
@@ -57,6 +69,7 @@ tagkmeans
     gsl_rng *rng;                        /**< Random number generator */
 
     REAL8 error;                         /**< Error of current clustering */
+    INT4 batch_size;                     /**< Size of mini-batches used before full kmeans steps (0 to disable) */
 
     LALInferenceKDE **KDEs;              /**< Array of KDEs, one for each cluster */
 } LALInferenceKmeans;
@@ -100,6 +113,9 @@ void LALInferenceKmeansAssignment(LALInferenceKmeans *kmeans);
 /* The update step of the kmeans algorithm. */
 void LALInferenceKmeansUpdate(LALInferenceKmeans *kmeans);
 
+/* Mini-batch steps of the kmeans algorithm. */
+void LALInferenceKmeansMiniBatch(LALInferenceKmeans *kmeans);
+
 /* Construct a mask to select only the data assigned to a single cluster. */
 void LALInferenceKmeansConstructMask(LALInferenceKmeans *kmeans, INT4 *mask, INT4 cluster_id);
 
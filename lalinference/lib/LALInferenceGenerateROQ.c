@@ -88,6 +88,13 @@ COMPLEX16Array *complex_B_matrix(gsl_matrix_complex *V, gsl_matrix_complex *RB);
 /* find the index of the absolute maximum value for a complex vector */
 int complex_vector_maxabs_index( gsl_vector_complex *c );
 
+/* training set rows per block when projecting the training set onto a basis vector */
+#define ROQ_PROJECTION_BLOCK 256
+
+/* project all training set rows onto a basis vector */
+static int project_training_set(const gsl_vector *weight, const gsl_vector *basis, const gsl_matrix *TS, gsl_vector *coeffs);
+static int complex_project_training_set(const gsl_vector *weight, const gsl_vector_complex *basis, const gsl_matrix_complex *TS, gsl_vector_complex *coeffs);
+
 
 /** \brief Function to project the training set onto a given basis vector
  *
@@ -169,6 +176,95 @@ void complex_project_onto_basis(gsl_vector *weight,
 }
 
 
+/** \brief Function to project every training set row onto a basis vector
+ *
+ * This is an internal function to be used by \c LALInferenceGenerateREAL8OrthonormalBasis. The
+ * weighted basis vector is formed once, and the training set is multiplied by it in blocks of
+ * rows that are shared between threads.
+ *
+ * @param[in] weight The normalisation weight(s) for the training set waveforms
+ * @param[in] basis The basis vector
+ * @param[in] TS The training set of waveforms
+ * @param[out] coeffs The projection of each training set row onto the basis vector
+ *
+ * @return \c XLAL_SUCCESS, or \c XLAL_FAILURE if the weights have the wrong length
+ */
+static int project_training_set(const gsl_vector *weight, const gsl_vector *basis, const gsl_matrix *TS, gsl_vector *coeffs){
+  const size_t nblocks = (TS->size1 + ROQ_PROJECTION_BLOCK - 1) / ROQ_PROJECTION_BLOCK;
+  gsl_vector *weighted;
+  size_t b;
+
+  XLAL_CHECK( basis->size == TS->size2 && coeffs->size == TS->size1, XLAL_EFUNC, "Size of input vectors are not the same.");
+  XLAL_CHECK( weight->size == 1 || weight->size == basis->size, XLAL_EFUNC, "Vector of weights must either contain a single value, or be the same length as the other input vectors." );
+
+  XLAL_CALLGSL( weighted = gsl_vector_alloc(basis->size) );
+  XLAL_CALLGSL( gsl_vector_memcpy(weighted, basis) );
+  if ( weight->size == 1 ){ XLAL_CALLGSL( gsl_vector_scale(weighted, gsl_vector_get(weight, 0)) ); }
+  else{ XLAL_CALLGSL( gsl_vector_mul(weighted, weight) ); }
+
+  #pragma omp parallel for schedule(static)
+  for ( b = 0; b < nblocks; b++ ){
+    const size_t start = b*ROQ_PROJECTION_BLOCK;
+    const size_t n = TS->size1 - start < ROQ_PROJECTION_BLOCK ? TS->size1 - start : ROQ_PROJECTION_BLOCK;
+    gsl_matrix_const_view block = gsl_matrix_const_submatrix(TS, start, 0, n, TS->size2);
+    gsl_vector_view out = gsl_vector_subvector(coeffs, start, n);
+    gsl_blas_dgemv(CblasNoTrans, 1., &block.matrix, weighted, 0., &out.vector);
+  }
+
+  XLAL_CALLGSL( gsl_vector_free(weighted) );
+  return XLAL_SUCCESS;
+}
+
+
+/** \brief Function to project every complex training set row onto a basis vector
+ *
+ * This is an internal function to be used by \c LALInferenceGenerateCOMPLEX16OrthonormalBasis.
+ * As for \c complex_weighted_dot_product the complex conjugate of the basis vector is used.
+ *
+ * @param[in] weight The normalisation weight(s) for the training set waveforms
+ * @param[in] basis The basis vector
+ * @param[in] TS The training set of waveforms
+ * @param[out] coeffs The projection of each training set row onto the basis vector
+ *
+ * @return \c XLAL_SUCCESS, or \c XLAL_FAILURE if the weights have the wrong length
+ */
+static int complex_project_training_set(const gsl_vector *weight, const gsl_vector_complex *basis, const gsl_matrix_complex *TS, gsl_vector_complex *coeffs){
+  const size_t nblocks = (TS->size1 + ROQ_PROJECTION_BLOCK - 1) / ROQ_PROJECTION_BLOCK;
+  gsl_vector_complex *weighted;
+  gsl_vector_view rview, iview;
+  size_t b;
+
+  XLAL_CHECK( basis->size == TS->size2 && coeffs->size == TS->size1, XLAL_EFUNC, "Size of input vectors are not the same.");
+  XLAL_CHECK( weight->size == 1 || weight->size == basis->size, XLAL_EFUNC, "Vector of weights must either contain a single value, or be the same length as the other input vectors." );
+
+  XLAL_CALLGSL( weighted = gsl_vector_complex_alloc(basis->size) );
+  XLAL_CALLGSL( gsl_vector_complex_memcpy(weighted, basis) );
+  XLAL_CALLGSL( rview = gsl_vector_complex_real(weighted) );
+  XLAL_CALLGSL( iview = gsl_vector_complex_imag(weighted) );
+  if ( weight->size == 1 ){
+    XLAL_CALLGSL( gsl_vector_scale(&rview.vector, gsl_vector_get(weight, 0)) );
+    XLAL_CALLGSL( gsl_vector_scale(&iview.vector, -gsl_vector_get(weight, 0)) );
+  }
+  else{
+    XLAL_CALLGSL( gsl_vector_mul(&rview.vector, weight) );
+    XLAL_CALLGSL( gsl_vector_mul(&iview.vector, weight) );
+    XLAL_CALLGSL( gsl_vector_scale(&iview.vector, -1.) );
+  }
+
+  #pragma omp parallel for schedule(static)
+  for ( b = 0; b < nblocks; b++ ){
+    const size_t start = b*ROQ_PROJECTION_BLOCK;
+    const size_t n = TS->size1 - start < ROQ_PROJECTION_BLOCK ? TS->size1 - start : ROQ_PROJECTION_BLOCK;
+    gsl_matrix_complex_const_view block = gsl_matrix_complex_const_submatrix(TS, start, 0, n, TS->size2);
+    gsl_vector_complex_view out = gsl_vector_complex_subvector(coeffs, start, n);
+    gsl_blas_zgemv(CblasNoTrans, GSL_COMPLEX_ONE, &block.matrix, weighted, GSL_COMPLEX_ZERO, &out.vector);
+  }
+
+  XLAL_CALLGSL( gsl_vector_complex_free(weighted) );
+  return XLAL_SUCCESS;
+}
+
+
 /** \brief The dot product of two real vectors scaled by a given weight factor
  *
  * @param[in] weight A (set of) scaling factor(s) for the dot product
@@ -743,9 +839,15 @@ void iterated_modified_gm(gsl_vector *ru,
  * training set. However, if \c RBin already contains a previously produced basis, then this
  * basis will be enriched with bases if possible using the new training set.  <b>NOTE</b>: when
  * using  small tolerances enriching the basis in this way can lead to numerical precision issues,
- * so in general you should use \c LALInferenceEnrichREAL8Basis for enrichment.
+ * so in general you should use \c LALInferenceEnrichREAL8Basis for enrichment. Passing in a
+ * previously produced basis can also be used to resume a long basis generation from a saved basis
+ * (and the training set it was produced from). The returned greedy points for the bases that were
+ * passed in are set to the number of training set rows, as they do not correspond to rows of \c TS.
+ *
+ * At each iteration the whole training set is projected onto the newest basis, with blocks of
+ * training set rows shared between threads if OpenMP is available.
  *
- * @param[out] RBin A \c REAL8Array to return the reduced basis.
+ * @param[in,out] RBin A \c REAL8Array to return the reduced basis.
  * @param[in] delta The time/frequency step(s) in the training set used to normalise the models.
  * This can be a vector containing just one value.
  * @param[in] tolerance The tolerance used as a stopping criteria for the basis generation.
@@ -773,24 +875,29 @@ REAL8 LALInferenceGenerateREAL8OrthonormalBasis(REAL8Array **RBin,
   gsl_matrix_view TSview;
   XLAL_CALLGSL( TSview = gsl_matrix_view_array((double *)ts->data, rows, cols) );
 
-  size_t max_RB = rows;
+  REAL8Array *RB = *RBin;
+  UINT4 dim_RB = 0;
+
+  if ( RB != NULL ){
+    XLAL_CHECK_REAL8( RB->dimLength->length == 2, XLAL_EFUNC, "Reduced basis set array must have only two dimensions" );
+    XLAL_CHECK_REAL8( RB->dimLength->data[1] == cols, XLAL_EFUNC, "Reduced basis and training set must have the same number of columns" );
+    dim_RB = RB->dimLength->data[0];
+  }
+
+  size_t max_RB = dim_RB + rows;
 
-  //REAL8 greedy_err[max_RB];           /* approximate error */
   UINT4Vector *gpts = NULL;
   gpts = XLALCreateUINT4Vector(max_RB); /* selected greedy points (row selection) */
   *greedypoints = gpts;
 
   REAL8 worst_err;          /* errors in greedy sweep */
   UINT4 worst_app = 0;      /* worst error stored */
-  REAL8 tmpc;               /* worst error temp */
 
-  gsl_vector *ts_el, *last_rb, *ortho_basis, *ru;
-  gsl_matrix *R_matrix;
-  REAL8 A_row_norms2[rows];              // || A(i,:) ||^2
-  REAL8 projection_norms2[rows];
-  REAL8 errors[rows];                    // approximation errors at i^{th} sweep
+  gsl_vector *ts_el, *last_rb, *ortho_basis, *ru, *projection_coeffs;
+  REAL8 *A_row_norms2 = XLALMalloc(rows*sizeof(REAL8));      // || A(i,:) ||^2
+  REAL8 *projection_norms2 = XLALMalloc(rows*sizeof(REAL8));
+  REAL8 *errors = XLALMalloc(rows*sizeof(REAL8));            // approximation errors at i^{th} sweep
 
-  REAL8Array *RB = NULL;
   UINT4Vector *dims = NULL;
   gsl_matrix_view RBview;
 
@@ -799,10 +906,7 @@ REAL8 LALInferenceGenerateREAL8OrthonormalBasis(REAL8Array **RBin,
   last_rb       = gsl_vector_alloc(cols);
   ortho_basis   = gsl_vector_alloc(cols);
   ru            = gsl_vector_alloc(max_RB);
-
-  //project_coeff = gsl_matrix_alloc(max_RB,rows);
-  REAL8 projection_coeff;
-  R_matrix = gsl_matrix_alloc(max_RB, max_RB);
+  projection_coeffs = gsl_vector_alloc(rows);
 
   /* initialise projection norms with zeros */
   for(size_t i=0; i<rows; ++i){ projection_norms2[i] = 0; }
@@ -819,31 +923,43 @@ REAL8 LALInferenceGenerateREAL8OrthonormalBasis(REAL8Array **RBin,
     A_row_norms2[i] = normalisation(&deltaview.vector, ts_el);
   }
 
-  /* initialize algorithm with first training set value */
   dims = XLALCreateUINT4Vector( 2 );
-  dims->data[0] = 1; /* one row */
   dims->data[1] = cols;
-  RB = XLALCreateREAL8Array( dims );
-  *RBin = RB;
 
-  XLAL_CALLGSL( RBview = gsl_matrix_view_array((double*)RB->data, 1, cols) );
-  gsl_matrix_get_row(ts_el, &TSview.matrix, 0);
-  gsl_matrix_set_row(&RBview.matrix, 0, ts_el);
-  tmpc = 1.;
-  gsl_matrix_set(R_matrix, 0, 0, tmpc);  // assumes normalized solutions
+  if ( dim_RB == 0 ){
+    /* initialize algorithm with first training set value */
+    dims->data[0] = 1; /* one row */
+    RB = XLALCreateREAL8Array( dims );
+    *RBin = RB;
+
+    XLAL_CALLGSL( RBview = gsl_matrix_view_array((double*)RB->data, 1, cols) );
+    gsl_matrix_get_row(ts_el, &TSview.matrix, 0);
+    gsl_matrix_set_row(&RBview.matrix, 0, ts_el);
 
-  gpts->data[0] = 0;
-  UINT4 dim_RB          = 1;
-  //greedy_err[0]    = 1.0;
+    gpts->data[0] = 0;
+    dim_RB = 1;
+  }
+  else{
+    /* carry on from the existing basis, projecting the training set onto all but its last basis
+       (which is done at the start of the loop below) */
+    XLAL_CALLGSL( RBview = gsl_matrix_view_array((double*)RB->data, dim_RB, cols) );
+    for(size_t j = 0; j < dim_RB; j++){
+      gpts->data[j] = rows;
+      if ( j == dim_RB-1 ){ break; }
+      gsl_matrix_get_row(last_rb, &RBview.matrix, j);
+      project_training_set(&deltaview.vector, last_rb, &TSview.matrix, projection_coeffs);
+      for(size_t i = 0; i < rows; i++){ projection_norms2[i] += gsl_vector_get(projection_coeffs, i)*gsl_vector_get(projection_coeffs, i); }
+    }
+  }
 
   /* loop to find reduced basis */
   while( 1 ){
     gsl_matrix_get_row(last_rb, &RBview.matrix, dim_RB-1); /* previous basis */
 
     /* Compute overlaps of pieces of training set with rb_new */
+    project_training_set(&deltaview.vector, last_rb, &TSview.matrix, projection_coeffs);
     for(size_t i = 0; i < rows; i++){
-      gsl_matrix_get_row(ts_el, &TSview.matrix, i);
-      projection_coeff = weighted_dot_product(&deltaview.vector, last_rb, ts_el);
+      REAL8 projection_coeff = gsl_vector_get(projection_coeffs, i);
       projection_norms2[i] += (projection_coeff*projection_coeff);
       errors[i] = A_row_norms2[i] - projection_norms2[i];
     }
@@ -908,12 +1024,11 @@ REAL8 LALInferenceGenerateREAL8OrthonormalBasis(REAL8Array **RBin,
     XLAL_CALLGSL( RBview = gsl_matrix_view_array((double*)RB->data, dim_RB+1, cols) );
 
     gsl_matrix_set_row(&RBview.matrix, dim_RB, ortho_basis);
-    gsl_matrix_set_row(R_matrix, dim_RB, ru);
 
     ++dim_RB;
 
     /* decide if another greedy sweep is needed */
-    if( (dim_RB == max_RB) || (worst_err < tolerance) || (rows == dim_RB) ){ break; }
+    if( (dim_RB == max_RB) || (worst_err < tolerance) ){ break; }
   }
 
   gpts = XLALResizeUINT4Vector( gpts, dim_RB );
@@ -923,7 +1038,10 @@ REAL8 LALInferenceGenerateREAL8OrthonormalBasis(REAL8Array **RBin,
   gsl_vector_free(last_rb);
   gsl_vector_free(ortho_basis);
   gsl_vector_free(ru);
-  gsl_matrix_free(R_matrix);
+  gsl_vector_free(projection_coeffs);
+  XLALFree(A_row_norms2);
+  XLALFree(projection_norms2);
+  XLALFree(errors);
 
   return worst_err;
 }
@@ -944,14 +1062,20 @@ REAL8 LALInferenceGenerateREAL8OrthonormalBasis(REAL8Array **RBin,
  * training set. However, if \c RBin already contains a previously produced basis, then this
  * basis will be enriched with bases if possible using the new training set. <b>NOTE</b>: when
  * using  small tolerances enriching the basis in this way can lead to numerical precision issues,
- * so in general you should use \c LALInferenceEnrichCOMPLEX16Basis for enrichment.
+ * so in general you should use \c LALInferenceEnrichCOMPLEX16Basis for enrichment. Passing in a
+ * previously produced basis can also be used to resume a long basis generation from a saved basis
+ * (and the training set it was produced from). The returned greedy points for the bases that were
+ * passed in are set to the number of training set rows, as they do not correspond to rows of \c TS.
+ *
+ * At each iteration the whole training set is projected onto the newest basis, with blocks of
+ * training set rows shared between threads if OpenMP is available.
  *
  * Note that in this function we have to cast the \c COMPLEX16 array as a double to use
  * \c gsl_matrix_view_array, which assume that the data is passed as a double array with
  * memory laid out so that adjacent double memory blocks hold the corresponding real and
  * imaginary parts.
  *
- * @param[out] RBin A \c COMPLEX16Array to return the reduced basis.
+ * @param[in,out] RBin A \c COMPLEX16Array to return the reduced basis.
  * @param[in] delta The time/frequency step(s) in the training set used to normalise the models.
  * This can be a vector containing just one value.
  * @param[in] tolerance The tolerance used as a stopping criteria for the basis generation.
@@ -979,7 +1103,16 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
   gsl_matrix_complex_view TSview;
   XLAL_CALLGSL( TSview = gsl_matrix_complex_view_array((double *)ts->data, rows, cols) );
 
-  size_t max_RB = rows;
+  COMPLEX16Array *RB = *RBin;
+  UINT4 dim_RB = 0;
+
+  if ( RB != NULL ){
+    XLAL_CHECK_REAL8( RB->dimLength->length == 2, XLAL_EFUNC, "Reduced basis set array must have only two dimensions" );
+    XLAL_CHECK_REAL8( RB->dimLength->data[1] == cols, XLAL_EFUNC, "Reduced basis and training set must have the same number of columns" );
+    dim_RB = RB->dimLength->data[0];
+  }
+
+  size_t max_RB = dim_RB + rows;
 
   UINT4Vector *gpts = NULL;
   gpts = XLALCreateUINT4Vector(max_RB); /* selected greedy points (row selection) */
@@ -987,15 +1120,12 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
 
   REAL8 worst_err;          /* errors in greedy sweep */
   UINT4 worst_app = 0;      /* worst error stored */
-  gsl_complex tmpc;         /* worst error temp */
 
-  gsl_vector_complex *ts_el, *last_rb, *ortho_basis, *ru;
-  gsl_matrix_complex *R_matrix;
-  REAL8 A_row_norms2[rows];              // || A(i,:) ||^2
-  REAL8 projection_norms2[rows];
-  REAL8 errors[rows];                    // approximation errors at i^{th} sweep
+  gsl_vector_complex *ts_el, *last_rb, *ortho_basis, *ru, *projection_coeffs;
+  REAL8 *A_row_norms2 = XLALMalloc(rows*sizeof(REAL8));      // || A(i,:) ||^2
+  REAL8 *projection_norms2 = XLALMalloc(rows*sizeof(REAL8));
+  REAL8 *errors = XLALMalloc(rows*sizeof(REAL8));            // approximation errors at i^{th} sweep
 
-  COMPLEX16Array *RB = NULL;
   UINT4Vector *dims = NULL;
   gsl_matrix_complex_view RBview;
   
@@ -1004,10 +1134,7 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
   last_rb       = gsl_vector_complex_alloc(cols);
   ortho_basis   = gsl_vector_complex_alloc(cols);
   ru            = gsl_vector_complex_alloc(max_RB);
-
-  //project_coeff = gsl_matrix_complex_alloc(max_RB,rows);
-  gsl_complex projection_coeff;
-  R_matrix = gsl_matrix_complex_alloc(max_RB, max_RB);
+  projection_coeffs = gsl_vector_complex_alloc(rows);
 
   /* initialise projection norms with zeros */
   for(size_t i=0; i<rows; ++i){ projection_norms2[i] = 0; }
@@ -1024,30 +1151,43 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
     A_row_norms2[i] = complex_normalisation(&deltaview.vector, ts_el);
   }
 
-  /* initialize algorithm with first training set value */
   dims = XLALCreateUINT4Vector( 2 );
-  dims->data[0] = 1; /* one row */
   dims->data[1] = cols;
-  RB = XLALCreateCOMPLEX16Array( dims );
-  *RBin = RB;
 
-  XLAL_CALLGSL( RBview = gsl_matrix_complex_view_array((double*)RB->data, 1, cols) );
-  gsl_matrix_complex_get_row(ts_el, &TSview.matrix, 0);
-  gsl_matrix_complex_set_row(&RBview.matrix, 0, ts_el);
-  GSL_SET_COMPLEX(&tmpc, 1.0, 0.0);
-  gsl_matrix_complex_set(R_matrix, 0, 0, tmpc);  // assumes normalized solutions
+  if ( dim_RB == 0 ){
+    /* initialize algorithm with first training set value */
+    dims->data[0] = 1; /* one row */
+    RB = XLALCreateCOMPLEX16Array( dims );
+    *RBin = RB;
 
-  gpts->data[0] = 0;
-  UINT4 dim_RB          = 1;
+    XLAL_CALLGSL( RBview = gsl_matrix_complex_view_array((double*)RB->data, 1, cols) );
+    gsl_matrix_complex_get_row(ts_el, &TSview.matrix, 0);
+    gsl_matrix_complex_set_row(&RBview.matrix, 0, ts_el);
+
+    gpts->data[0] = 0;
+    dim_RB = 1;
+  }
+  else{
+    /* carry on from the existing basis, projecting the training set onto all but its last basis
+       (which is done at the start of the loop below) */
+    XLAL_CALLGSL( RBview = gsl_matrix_complex_view_array((double*)RB->data, dim_RB, cols) );
+    for(size_t j = 0; j < dim_RB; j++){
+      gpts->data[j] = rows;
+      if ( j == dim_RB-1 ){ break; }
+      gsl_matrix_complex_get_row(last_rb, &RBview.matrix, j);
+      complex_project_training_set(&deltaview.vector, last_rb, &TSview.matrix, projection_coeffs);
+      for(size_t i = 0; i < rows; i++){ projection_norms2[i] += gsl_complex_abs2(gsl_vector_complex_get(projection_coeffs, i)); }
+    }
+  }
 
   /* loop to find reduced basis */
   while( 1 ){
     gsl_matrix_complex_get_row(last_rb, &RBview.matrix, dim_RB-1); /* previous basis */
 
     /* Compute overlaps of pieces of training set with rb_new */
+    complex_project_training_set(&deltaview.vector, last_rb, &TSview.matrix, projection_coeffs);
     for(size_t i = 0; i < rows; i++){
-      gsl_matrix_complex_get_row(ts_el, &TSview.matrix, i);
-      projection_coeff = complex_weighted_dot_product(&deltaview.vector, last_rb, ts_el);
+      gsl_complex projection_coeff = gsl_vector_complex_get(projection_coeffs, i);
       projection_norms2[i] += (projection_coeff.dat[0]*projection_coeff.dat[0] + projection_coeff.dat[1]*projection_coeff.dat[1]);
       errors[i] = A_row_norms2[i] - projection_norms2[i];
     }
@@ -1112,12 +1252,11 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
     XLAL_CALLGSL( RBview = gsl_matrix_complex_view_array((double*)RB->data, dim_RB+1, cols) );
 
     gsl_matrix_complex_set_row(&RBview.matrix, dim_RB, ortho_basis);
-    gsl_matrix_complex_set_row(R_matrix, dim_RB, ru);
 
     ++dim_RB;
 
     /* decide if another greedy sweep is needed */
-    if( (dim_RB == max_RB) || (worst_err < tolerance) || (rows == dim_RB) ){ break; }
+    if( (dim_RB == max_RB) || (worst_err < tolerance) ){ break; }
   }
 
   gpts = XLALResizeUINT4Vector( gpts, dim_RB );
@@ -1127,7 +1266,10 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
   gsl_vector_complex_free(last_rb);
   gsl_vector_complex_free(ortho_basis);
   gsl_vector_complex_free(ru);
-  gsl_matrix_complex_free(R_matrix);
+  gsl_vector_complex_free(projection_coeffs);
+  XLALFree(A_row_norms2);
+  XLALFree(projection_norms2);
+  XLALFree(errors);
 
   return worst_err;
 }
@@ -2014,6 +2156,169 @@ COMPLEX16 LALInferenceROQCOMPLEX16DotProduct(COMPLEX16Vector *weights, COMPLEX16
 }
 
 
+/** \brief Tabulate time dependent linear ROQ weights for interpolation in time
+ *
+ * The linear weights for <d|h> depend on the time of the signal, and are computed on a grid of
+ * times. This function lays them out time-major, so that the weights for all nodes at one time
+ * are contiguous, and computes the second time derivatives of the natural cubic spline through
+ * each weight, so that \c LALInferenceROQTimeWeightsDotProduct can interpolate the weights as it
+ * computes the dot product.
+ *
+ * @param[in] weights The weights, with the \c ntimes values for the first node followed by those
+ * for the second node and so on (the layout of the weights files used by \c lalinference)
+ * @param[in] times The \c ntimes increasing times at which the weights are given
+ * @param[in] ntimes The number of times
+ * @param[in] nnodes The number of interpolation nodes
+ *
+ * @return A pointer to the tabulated weights
+ */
+LALInferenceROQTimeWeights *LALInferenceCreateROQTimeWeights(const COMPLEX16 *weights,
+                                                             const REAL8 *times,
+                                                             UINT4 ntimes,
+                                                             UINT4 nnodes){
+  XLAL_CHECK_NULL( weights != NULL && times != NULL, XLAL_EFAULT, "Weights or times are NULL" );
+  XLAL_CHECK_NULL( ntimes > 1 && nnodes > 0, XLAL_EINVAL, "Need at least two times and one node" );
+  for ( UINT4 j = 1; j < ntimes; j++ ){
+    XLAL_CHECK_NULL( times[j] > times[j-1], XLAL_EINVAL, "Times must be increasing" );
+  }
+
+  LALInferenceROQTimeWeights *tw = XLALCalloc(1, sizeof(LALInferenceROQTimeWeights));
+  XLAL_CHECK_NULL( tw != NULL, XLAL_ENOMEM );
+  tw->n_times = ntimes;
+  tw->n_nodes = nnodes;
+  tw->times = XLALMalloc(ntimes*sizeof(REAL8));
+  tw->table = XLALCalloc(4*(size_t)ntimes*nnodes, sizeof(REAL8));
+  REAL8 *cprime = XLALCalloc(ntimes, sizeof(REAL8));
+  if ( tw->times == NULL || tw->table == NULL || cprime == NULL ){
+    XLALFree(cprime);
+    LALInferenceDestroyROQTimeWeights(tw);
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  }
+  memcpy(tw->times, times, ntimes*sizeof(REAL8));
+
+  for ( UINT4 j = 0; j < ntimes; j++ ){
+    REAL8 *row = tw->table + 4*(size_t)j*nnodes;
+    for ( UINT4 i = 0; i < nnodes; i++ ){
+      row[4*i] = creal(weights[(size_t)i*ntimes + j]);
+      row[4*i+1] = cimag(weights[(size_t)i*ntimes + j]);
+    }
+  }
+
+  /* natural cubic spline: solve the tridiagonal system for the second derivatives at the interior
+     times (which is the same for every node) by forward elimination and back substitution, keeping
+     the eliminated right hand sides in the second derivative slots */
+  for ( UINT4 j = 1; j + 1 < ntimes; j++ ){
+    const REAL8 hlo = times[j] - times[j-1], hhi = times[j+1] - times[j];
+    const REAL8 m = 2.*(hlo + hhi) - hlo*cprime[j-1];
+    const REAL8 *prev = tw->table + 4*(size_t)(j-1)*nnodes, *next = tw->table + 4*(size_t)(j+1)*nnodes;
+    REAL8 *row = tw->table + 4*(size_t)j*nnodes;
+
+    cprime[j] = hhi/m;
+    for ( UINT4 i = 0; i < 4*nnodes; i += 4 ){
+      for ( UINT4 k = 0; k < 2; k++ ){
+        REAL8 r = 6.*((next[i+k] - row[i+k])/hhi - (row[i+k] - prev[i+k])/hlo);
+        row[i+2+k] = (r - hlo*prev[i+2+k])/m;
+      }
+    }
+  }
+  for ( UINT4 j = ntimes - 2; j > 0; j-- ){
+    const REAL8 *next = tw->table + 4*(size_t)(j+1)*nnodes;
+    REAL8 *row = tw->table + 4*(size_t)j*nnodes;
+    for ( UINT4 i = 0; i < 4*nnodes; i += 4 ){
+      row[i+2] -= cprime[j]*next[i+2];
+      row[i+3] -= cprime[j]*next[i+3];
+    }
+  }
+
+  XLALFree(cprime);
+  return tw;
+}
+
+
+/** \brief Free memory for a \c LALInferenceROQTimeWeights
+ *
+ * @param[in] tw A pointer to a \c LALInferenceROQTimeWeights
+ */
+void LALInferenceDestroyROQTimeWeights(LALInferenceROQTimeWeights *tw){
+  if ( tw == NULL ){ return; }
+
+  XLALFree(tw->times);
+  XLALFree(tw->table);
+  XLALFree(tw);
+}
+
+
+/** \brief Calculate the linear ROQ term <d|h> with weights interpolated in time
+ *
+ * The weights are interpolated to time \c t with the natural cubic spline (as with a GSL
+ * \c gsl_interp_cspline spline through the weights of each node), while the dot product of
+ * the weights with the complex conjugate of the template
+ * \f$h = (F_+ h_+ + F_\times h_\times) c\f$ at the nodes is computed, streaming through the
+ * weights at the two times either side of \c t.
+ *
+ * @param[in] tw The tabulated weights
+ * @param[in] t The time at which to interpolate the weights
+ * @param[in] hplus The plus polarisation at the nodes
+ * @param[in] hcross The cross polarisation at the nodes
+ * @param[in] cal The calibration factors at the nodes, or \c NULL
+ * @param[in] Fplus The plus antenna pattern
+ * @param[in] Fcross The cross antenna pattern
+ * @param[out] d_inner_h The dot product
+ *
+ * @return \c XLAL_SUCCESS, or \c XLAL_FAILURE if \c t is outside the tabulated times
+ */
+int LALInferenceROQTimeWeightsDotProduct(const LALInferenceROQTimeWeights *tw,
+                                         REAL8 t,
+                                         const COMPLEX16 *hplus,
+                                         const COMPLEX16 *hcross,
+                                         const COMPLEX16 *cal,
+                                         REAL8 Fplus,
+                                         REAL8 Fcross,
+                                         COMPLEX16 *d_inner_h){
+  XLAL_CHECK( tw != NULL && hplus != NULL && hcross != NULL && d_inner_h != NULL, XLAL_EFAULT );
+  XLAL_CHECK( t >= tw->times[0] && t <= tw->times[tw->n_times-1], XLAL_EDOM, "Time %f is outside the range [%f, %f] of the ROQ weights", t, tw->times[0], tw->times[tw->n_times-1] );
+
+  /* find the times either side of t */
+  UINT4 lo = 0, hi = tw->n_times - 1;
+  while ( hi - lo > 1 ){
+    UINT4 mid = (lo + hi)/2;
+    if ( tw->times[mid] > t ){ hi = mid; }
+    else{ lo = mid; }
+  }
+
+  const REAL8 h = tw->times[hi] - tw->times[lo];
+  const REAL8 A = (tw->times[hi] - t)/h, B = 1. - A;
+  const REAL8 C = (A*A*A - A)*h*h/6., D = (B*B*B - B)*h*h/6.;
+  const REAL8 *w0 = tw->table + 4*(size_t)lo*tw->n_nodes, *w1 = tw->table + 4*(size_t)hi*tw->n_nodes;
+  const REAL8 *hp = (const REAL8 *)hplus, *hc = (const REAL8 *)hcross, *c = (const REAL8 *)cal;
+  REAL8 re = 0., im = 0.;
+
+  /* the arithmetic is written out on real and imaginary parts so that the loops can be vectorised */
+  if ( cal ){
+    for ( UINT4 i = 0; i < tw->n_nodes; i++ ){
+      const REAL8 wr = A*w0[4*i] + B*w1[4*i] + C*w0[4*i+2] + D*w1[4*i+2];
+      const REAL8 wi = A*w0[4*i+1] + B*w1[4*i+1] + C*w0[4*i+3] + D*w1[4*i+3];
+      const REAL8 sr = Fplus*hp[2*i] + Fcross*hc[2*i], si = Fplus*hp[2*i+1] + Fcross*hc[2*i+1];
+      const REAL8 tr = sr*c[2*i] - si*c[2*i+1], ti = sr*c[2*i+1] + si*c[2*i];
+      re += wr*tr + wi*ti;
+      im += wi*tr - wr*ti;
+    }
+  }
+  else{
+    for ( UINT4 i = 0; i < tw->n_nodes; i++ ){
+      const REAL8 wr = A*w0[4*i] + B*w1[4*i] + C*w0[4*i+2] + D*w1[4*i+2];
+      const REAL8 wi = A*w0[4*i+1] + B*w1[4*i+1] + C*w0[4*i+3] + D*w1[4*i+3];
+      const REAL8 tr = Fplus*hp[2*i] + Fcross*hc[2*i], ti = Fplus*hp[2*i+1] + Fcross*hc[2*i+1];
+      re += wr*tr + wi*ti;
+      im += wi*tr - wr*ti;
+    }
+  }
+
+  *d_inner_h = re + I*im;
+  return XLAL_SUCCESS;
+}
+
+
 /** \brief Free memory for a \c LALInferenceREALROQInterpolant
  *
  * @param[in] a A pointer to a  \c LALInferenceREALROQInterpolant
@@ -119,6 +119,25 @@ COMPLEX16Vector *LALInferenceGenerateCOMPLEX16LinearWeights(COMPLEX16Array *B, C
 REAL8 LALInferenceROQREAL8DotProduct(REAL8Vector *weights, REAL8Vector *model);
 COMPLEX16 LALInferenceROQCOMPLEX16DotProduct(COMPLEX16Vector *weights, COMPLEX16Vector *model);
 
+#ifndef SWIG   /* exclude from SWIG interface */
+
+/* tabulate time dependent linear weights, and calculate <d|h> with the weights interpolated in time */
+LALInferenceROQTimeWeights *LALInferenceCreateROQTimeWeights(const COMPLEX16 *weights,
+                                                             const REAL8 *times,
+                                                             UINT4 ntimes,
+                                                             UINT4 nnodes);
+void LALInferenceDestroyROQTimeWeights(LALInferenceROQTimeWeights *tw);
+int LALInferenceROQTimeWeightsDotProduct(const LALInferenceROQTimeWeights *tw,
+                                         REAL8 t,
+                                         const COMPLEX16 *hplus,
+                                         const COMPLEX16 *hcross,
+                                         const COMPLEX16 *cal,
+                                         REAL8 Fplus,
+                                         REAL8 Fcross,
+                                         COMPLEX16 *d_inner_h);
+
+#endif /* SWIG */
+
 /* memory destruction */
 void LALInferenceRemoveREALROQInterpolant( LALInferenceREALROQInterpolant *a );
 void LALInferenceRemoveCOMPLEXROQInterpolant( LALInferenceCOMPLEXROQInterpolant *a );
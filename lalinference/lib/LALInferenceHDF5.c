@@ -48,7 +48,7 @@ int LALInferencePrintCheckpointFileInfo(char *filename)
     return(0);
 }
 
-int LALInferenceCheckNonEmptyFile(char *filename)
+int LALInferenceCheckNonEmptyFile(const char *filename)
 {
     struct stat st;
     if( !stat(filename, &st) )
@@ -323,6 +323,78 @@ int LALInferenceH5VariablesArrayToDataset(
 }
 
 
+int LALInferenceH5VariablesArrayAppendToDataset(
+    LALH5File *h5file, LALInferenceVariables *const *const varsArray, UINT4 N,
+    const char *TableName)
+{
+    /* Sanity check input */
+    if (!varsArray)
+        XLAL_ERROR(XLAL_EFAULT, "Received null varsArray pointer");
+    if (!h5file)
+        XLAL_ERROR(XLAL_EFAULT, "Received null h5file pointer");
+    if (N == 0)
+        return 0;
+
+    if (!XLALH5FileCheckDatasetExists(h5file, TableName))
+        return LALInferenceH5VariablesArrayToDataset(h5file, varsArray, N, TableName);
+
+    LALH5Dataset *dataset = XLALH5DatasetRead(h5file, TableName);
+    if (!dataset)
+        XLAL_ERROR(XLAL_EFUNC, "Could not open table %s", TableName);
+
+    size_t type_size = XLALH5TableQueryRowSize(dataset);
+    size_t Ncols = XLALH5TableQueryNColumns(dataset);
+    char *column_names[Ncols];
+    size_t column_offsets[Ncols];
+    size_t column_sizes[Ncols];
+
+    for (size_t i = 0; i < Ncols; i ++)
+    {
+        size_t column_name_len = XLALH5TableQueryColumnName(
+            NULL, 0, dataset, i);
+        column_names[i] = malloc(column_name_len + 1);
+        XLALH5TableQueryColumnName(
+            column_names[i], column_name_len + 1, dataset, i);
+        column_offsets[i] = XLALH5TableQueryColumnOffset(dataset, i);
+        column_sizes[i] = XLALH5TableQueryColumnSize(dataset, i);
+    }
+
+    /* Gather together the new rows in one array, in the column order of the table */
+    int ret = XLAL_SUCCESS;
+    char *data = XLALCalloc(N, type_size);
+    assert(data);
+    for (UINT4 i = 0; i < N && ret == XLAL_SUCCESS; i++)
+    {
+        for (UINT4 j = 0; j < Ncols; j++)
+        {
+            if (!LALInferenceCheckVariable(varsArray[i], column_names[j]))
+            {
+                XLALPrintError("%s: Sample %u has no parameter %s for table %s\n",
+                               __func__, i, column_names[j], TableName);
+                ret = XLAL_FAILURE;
+                break;
+            }
+            void *var = LALInferenceGetVariable(varsArray[i], column_names[j]);
+            memcpy(
+                data + type_size * i + column_offsets[j], var, column_sizes[j]);
+        }
+    }
+
+    if (ret == XLAL_SUCCESS && XLALH5TableAppend(
+            dataset, column_offsets, column_sizes, N, type_size, data) != 0)
+        ret = XLAL_FAILURE;
+
+    XLALFree(data);
+    for (size_t i = 0; i < Ncols; i++)
+        free(column_names[i]);
+    XLALH5DatasetFree(dataset);
+
+    if (ret != XLAL_SUCCESS)
+        XLAL_ERROR(XLAL_EFUNC, "Could not append to table %s", TableName);
+    return XLAL_SUCCESS;
+}
+
+
 static void LALInferenceH5VariableToAttribute(
     LALH5Generic gdataset, LALInferenceVariables *vars, char *name)
 {
@@ -26,7 +26,7 @@
 /**
  * Returns 1 if a non-empty file exists, 0 otherwise
  */
-int LALInferenceCheckNonEmptyFile(char *filename);
+int LALInferenceCheckNonEmptyFile(const char *filename);
 
 /**
  * Prints the size of the file
@@ -37,6 +37,16 @@ int LALInferenceH5VariablesArrayToDataset(
     LALH5File *h5file, LALInferenceVariables *const *const varsArray, UINT4 N,
     const char *TableName);
 
+/**
+ * Append the non-fixed variables of varsArray to the table TableName of
+ * h5file, which must be open for appending.  The table is created with
+ * LALInferenceH5VariablesArrayToDataset() if it does not exist yet, and the
+ * columns of an existing table are filled by name.
+ */
+int LALInferenceH5VariablesArrayAppendToDataset(
+    LALH5File *h5file, LALInferenceVariables *const *const varsArray, UINT4 N,
+    const char *TableName);
+
 int LALInferenceH5DatasetToVariablesArray(
     LALH5Dataset *dataset, LALInferenceVariables ***varsArray, UINT4 *N);
 
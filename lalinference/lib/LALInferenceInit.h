@@ -34,6 +34,8 @@
 
 /* Initialize a bare-bones run-state. */
 LALInferenceRunState *LALInferenceInitRunState(ProcessParamsTable *command_line);
+/* Initialize a bare-bones run-state around data that has already been read. */
+LALInferenceRunState *LALInferenceInitRunStateFromData(ProcessParamsTable *command_line, LALInferenceIFOData *data);
 
 /* Initialize threads in memory, using LALInferenceInitCBCModel() to init models. */
 void LALInferenceInitCBCThreads(LALInferenceRunState *run_state, INT4 nthreads);
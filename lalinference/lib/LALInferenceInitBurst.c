@@ -53,7 +53,7 @@ LALInferenceModel *LALInferenceInitModelReviewBurstEvidence_bimod(LALInferenceRu
 void LALInferenceInitBurstThreads(LALInferenceRunState *run_state, INT4 nthreads) {
   LALInferenceThreadState *thread;
   INT4 t, nifo;
-  LALInferenceIFOData *data = run_state->data;
+  LALInferenceIFOData *data = NULL;
   UINT4 randomseed;
   FILE *devrandom;
   struct timeval tv;
@@ -63,11 +63,15 @@ void LALInferenceInitBurstThreads(LALInferenceRunState *run_state, INT4 nthreads
   for (t = 0; t < nthreads; t++) {
     thread = &(run_state->threads[t]);
 
+    /* Link back to run-state */
+    thread->parent = run_state;
+
     /* Set up CBC model and parameter array */
     thread->model = LALInferenceInitBurstModel(run_state);
 
     /* Allocate IFO likelihood holders */
     nifo = 0;
+    data = run_state->data;
     while (data != NULL) {
         data = data->next;
         nifo++;
@@ -240,6 +244,9 @@ LALInferenceModel * LALInferenceInitBurstModel(LALInferenceRunState *state)
   LALInferenceModel *model = XLALMalloc(sizeof(LALInferenceModel));
   model->params = XLALCalloc(1, sizeof(LALInferenceVariables));
   memset(model->params, 0, sizeof(LALInferenceVariables));
+  model->relbin = NULL;
+  model->multiband = NULL;
+  model->spcal = NULL;
   LALInferenceVariables *currentParams=model->params;
 
   UINT4 signal_flag=1;
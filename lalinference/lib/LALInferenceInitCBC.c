@@ -36,6 +36,7 @@
 #include <lal/LALInferenceProposal.h>
 #include <lal/LALInferenceLikelihood.h>
 #include <lal/LALInferenceReadData.h>
+#include <lal/LALInferenceRelativeBinning.h>
 #include <lal/LALInferenceInit.h>
 #include <lal/LALInferenceCalibrationErrors.h>
 #include <lal/LALSimNeutronStar.h>
@@ -75,14 +76,30 @@ static void LALInferenceCheckApproximantNeeds(LALInferenceRunState *state,Approx
    sets up the random seed and rng, and initializes other variables accordingly.
 */
 LALInferenceRunState *LALInferenceInitRunState(ProcessParamsTable *command_line) {
+    LALInferenceIFOData *data;
+
+    /* Check that command line is consistent first */
+    LALInferenceCheckOptionsConsistency(command_line);
+
+    /* Read data from files or generate fake data */
+    data = LALInferenceReadData(command_line);
+    if (data == NULL)
+        return(NULL);
+
+    return LALInferenceInitRunStateFromData(command_line, data);
+}
+
+/* Initialize a bare-bones run-state as LALInferenceInitRunState() does,
+   but around data the caller has already read (or been given by another
+   process), without calling "ReadData()".
+*/
+LALInferenceRunState *LALInferenceInitRunStateFromData(ProcessParamsTable *command_line, LALInferenceIFOData *data) {
     ProcessParamsTable *ppt=NULL;
     INT4 randomseed;
     FILE *devrandom;
     struct timeval tv;
     LALInferenceRunState *run_state = XLALCalloc(1, sizeof(LALInferenceRunState));
 
-    /* Check that command line is consistent first */
-    LALInferenceCheckOptionsConsistency(command_line);
     run_state->commandLine = command_line;
 
     /* Initialize parameters structure */
@@ -90,10 +107,7 @@ LALInferenceRunState *LALInferenceInitRunState(ProcessParamsTable *command_line)
     run_state->priorArgs = XLALCalloc(1, sizeof(LALInferenceVariables));
     run_state->proposalArgs = XLALCalloc(1, sizeof(LALInferenceVariables));
 
-    /* Read data from files or generate fake data */
-    run_state->data = LALInferenceReadData(command_line);
-    if (run_state->data == NULL)
-        return(NULL);
+    run_state->data = data;
 
     /* Setup the random number generator */
     gsl_rng_env_setup();
@@ -245,6 +259,14 @@ void LALInferenceInitCBCThreads(LALInferenceRunState *run_state, INT4 nthreads)
       thread->model->roq_flag=0;
     }
 
+    /* Setup relative binning */
+    if (LALInferenceGetProcParamVal(commandLine, "--relative-binning")){
+      if (LALInferenceSetupRelativeBinning(run_state, thread->model) != XLAL_SUCCESS){
+        fprintf(stderr, "ERROR: unable to set up relative binning\n");
+        exit(1);
+      }
+    }
+
     LALInferenceCopyVariables(thread->model->params, thread->currentParams);
     LALInferenceCopyVariables(run_state->proposalArgs, thread->proposalArgs);
 
@@ -299,6 +321,10 @@ LALInferenceTemplateFunction LALInferenceInitCBCTemplate(LALInferenceRunState *r
                     --template LALGenerateInspiral (for time-domain templates)\n\
                     --template LAL (for frequency-domain templates)\n");
   }
+  else if(LALInferenceGetProcParamVal(commandLine,"--relative-binning")){
+    templt=&LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence;
+    fprintf(stdout,"Template function called is \"LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence\" at the relative binning frequencies\n");
+  }
   else if(LALInferenceGetProcParamVal(commandLine,"--roqtime_steps")){
   templt=&LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence;
         fprintf(stderr, "template is \"LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence\"\n");
@@ -930,6 +956,9 @@ LALInferenceModel *LALInferenceInitCBCModel(LALInferenceRunState *state) {
   model->params = XLALCalloc(1, sizeof(LALInferenceVariables));
   memset(model->params, 0, sizeof(LALInferenceVariables));
   model->eos_fam = NULL;
+  model->relbin = NULL;
+  model->multiband = NULL;
+  model->spcal = NULL;
 
   UINT4 signal_flag=1;
   ppt = LALInferenceGetProcParamVal(commandLine, "--noiseonly");
@@ -1639,8 +1668,10 @@ LALInferenceModel *LALInferenceInitCBCModel(LALInferenceRunState *state) {
   model->timeToFreqFFTPlan = state->data->timeToFreqFFTPlan;
   model->freqToTimeFFTPlan = state->data->freqToTimeFFTPlan;
 
-  /* Initialize waveform cache */
+  /* Initialize waveform cache;  keep the current and the proposed waveform,
+   * so that the one reused after a rejected jump is still cached */
   model->waveformCache = XLALCreateSimInspiralWaveformCache();
+  XLALSimInspiralWaveformCacheSetCapacity(model->waveformCache, 2);
 
   return(model);
 }
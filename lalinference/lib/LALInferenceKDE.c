@@ -42,6 +42,279 @@
 #endif
 
 
+/* Maximum number of points summed directly in a leaf of the k-d tree */
+#define KDE_LEAF_SIZE 32
+
+/**
+ * Node of the k-d tree used to evaluate a KDE.  The node contains rows
+ *  [start, end) of the whitened data, enclosed by the box [lower, upper].
+ */
+struct tagLALInferenceKDENode {
+    INT4 start;     /**< First row of the whitened data in the node. */
+    INT4 end;       /**< One past the last row in the node. */
+    INT4 left;      /**< Index of the lower child, or -1 for a leaf. */
+    INT4 right;     /**< Index of the upper child, or -1 for a leaf. */
+    REAL8 *lower;   /**< Lower corner of the bounding box. */
+    REAL8 *upper;   /**< Upper corner of the bounding box. */
+};
+
+/* State of a single kernel sum through the k-d tree */
+typedef struct {
+    const LALInferenceKDE *kde;
+    const REAL8 *y;     /* The whitened point being evaluated */
+    INT4 skip;          /* Leaf already summed before the traversal */
+    REAL8 log_budget;   /* Log of the error allowed per point, relative to the sum */
+    REAL8 log_max;      /* The sum is exp(log_max) * sum */
+    REAL8 sum;
+} KDETreeSum;
+
+/* Number of nodes in a tree over npts points */
+static INT4 kde_tree_count_nodes(INT4 npts) {
+    if (npts <= KDE_LEAF_SIZE)
+        return 1;
+    return 1 + kde_tree_count_nodes(npts/2) + kde_tree_count_nodes(npts - npts/2);
+}
+
+static void kde_tree_swap_rows(REAL8 *data, INT4 dim, INT4 a, INT4 b) {
+    INT4 k;
+    REAL8 tmp;
+    for (k = 0; k < dim; k++) {
+        tmp = data[a*dim + k];
+        data[a*dim + k] = data[b*dim + k];
+        data[b*dim + k] = tmp;
+    }
+}
+
+/* Partially sort rows [start, end) so that row kth splits them along axis */
+static void kde_tree_select(REAL8 *data, INT4 dim, INT4 start, INT4 end, INT4 kth, INT4 axis) {
+    INT4 lo = start, hi = end - 1;
+
+    while (lo < hi) {
+        REAL8 pivot = data[((lo + hi)/2)*dim + axis];
+        INT4 i = lo, j = hi;
+
+        while (i <= j) {
+            while (data[i*dim + axis] < pivot) i++;
+            while (data[j*dim + axis] > pivot) j--;
+            if (i <= j) {
+                kde_tree_swap_rows(data, dim, i, j);
+                i++;
+                j--;
+            }
+        }
+
+        if (kth <= j)
+            hi = j;
+        else if (kth >= i)
+            lo = i;
+        else
+            break;
+    }
+}
+
+/* Recursively build the node over rows [start, end), returning its index */
+static INT4 kde_tree_build(LALInferenceKDE *kde, INT4 start, INT4 end, INT4 *nnodes) {
+    INT4 dim = kde->dim;
+    INT4 id = (*nnodes)++;
+    INT4 j, k, mid, axis = 0;
+    REAL8 spread = 0.;
+    struct tagLALInferenceKDENode *node = &kde->tree[id];
+
+    node->start = start;
+    node->end = end;
+    node->left = node->right = -1;
+    node->lower = kde->tree_bounds + 2*id*dim;
+    node->upper = node->lower + dim;
+
+    for (k = 0; k < dim; k++)
+        node->lower[k] = node->upper[k] = kde->white_data[start*dim + k];
+    for (j = start + 1; j < end; j++) {
+        for (k = 0; k < dim; k++) {
+            REAL8 val = kde->white_data[j*dim + k];
+            if (val < node->lower[k]) node->lower[k] = val;
+            if (val > node->upper[k]) node->upper[k] = val;
+        }
+    }
+
+    if (end - start <= KDE_LEAF_SIZE)
+        return id;
+
+    /* Split the widest side at the median; identical points stay in a leaf */
+    for (k = 0; k < dim; k++) {
+        if (node->upper[k] - node->lower[k] > spread) {
+            spread = node->upper[k] - node->lower[k];
+            axis = k;
+        }
+    }
+    if (spread == 0.)
+        return id;
+
+    mid = start + (end - start)/2;
+    kde_tree_select(kde->white_data, dim, start, end, mid, axis);
+
+    node->left = kde_tree_build(kde, start, mid, nnodes);
+    node->right = kde_tree_build(kde, mid, end, nnodes);
+
+    return id;
+}
+
+static void kde_tree_free(LALInferenceKDE *kde) {
+    XLALFree(kde->white_data);
+    XLALFree(kde->tree);
+    XLALFree(kde->tree_bounds);
+    kde->white_data = NULL;
+    kde->tree = NULL;
+    kde->tree_bounds = NULL;
+}
+
+/* Whiten the data by the kernel covariance and build the k-d tree over it */
+static void kde_tree_init(LALInferenceKDE *kde) {
+    INT4 dim = kde->dim;
+    INT4 npts = kde->npts;
+    INT4 i, k, nnodes = 0;
+    INT4 max_nodes = kde_tree_count_nodes(npts);
+
+    kde_tree_free(kde);
+    kde->white_data = XLALMalloc(npts * dim * sizeof(REAL8));
+    kde->tree = XLALMalloc(max_nodes * sizeof(struct tagLALInferenceKDENode));
+    kde->tree_bounds = XLALMalloc(2 * max_nodes * dim * sizeof(REAL8));
+
+    for (i = 0; i < npts; i++) {
+        gsl_vector_view y = gsl_vector_view_array(kde->white_data + i*dim, dim);
+        for (k = 0; k < dim; k++)
+            kde->white_data[i*dim + k] = gsl_matrix_get(kde->data, i, k);
+        gsl_blas_dtrsv(CblasLower, CblasNoTrans, CblasNonUnit,
+                       kde->cholesky_decomp_cov_lower, &y.vector);
+    }
+
+    kde_tree_build(kde, 0, npts, &nnodes);
+}
+
+/* Add exp(log_val) to the running sum */
+static void kde_tree_accumulate(KDETreeSum *s, REAL8 log_val) {
+    if (log_val > s->log_max) {
+        s->sum = s->sum * exp(s->log_max - log_val) + 1.;
+        s->log_max = log_val;
+    } else {
+        s->sum += exp(log_val - s->log_max);
+    }
+}
+
+/* Sum the kernels of every point in a node directly */
+static void kde_tree_sum_leaf(KDETreeSum *s, const struct tagLALInferenceKDENode *node) {
+    INT4 dim = s->kde->dim;
+    const REAL8 *y = s->y;
+    REAL8 energies[KDE_LEAF_SIZE];
+    INT4 c, j, k, n;
+
+    for (c = node->start; c < node->end; c += KDE_LEAF_SIZE) {
+        REAL8 min_energy = INFINITY, sum = 0.;
+
+        n = node->end - c < KDE_LEAF_SIZE ? node->end - c : KDE_LEAF_SIZE;
+        for (j = 0; j < n; j++) {
+            const REAL8 *d = s->kde->white_data + (c + j)*dim;
+            REAL8 energy = 0.;
+            for (k = 0; k < dim; k++)
+                energy += (d[k] - y[k]) * (d[k] - y[k]);
+            energies[j] = energy;
+            if (energy < min_energy)
+                min_energy = energy;
+        }
+
+        for (j = 0; j < n; j++)
+            sum += exp(-(energies[j] - min_energy)/2.);
+
+        kde_tree_accumulate(s, log(sum) - min_energy/2.);
+    }
+}
+
+/* Squared distances from the point to the nearest and farthest corners of a node */
+static void kde_tree_distances(const KDETreeSum *s, const struct tagLALInferenceKDENode *node,
+                               REAL8 *min_dist2, REAL8 *max_dist2) {
+    INT4 k;
+    REAL8 lo, hi;
+
+    *min_dist2 = *max_dist2 = 0.;
+    for (k = 0; k < s->kde->dim; k++) {
+        lo = s->y[k] - node->lower[k];
+        hi = node->upper[k] - s->y[k];
+
+        if (lo < 0.)
+            *min_dist2 += lo*lo;
+        else if (hi < 0.)
+            *min_dist2 += hi*hi;
+
+        *max_dist2 += fabs(lo) > fabs(hi) ? lo*lo : hi*hi;
+    }
+}
+
+/*
+ * Add the kernels of a node to the sum.  If the kernel varies little enough
+ *  across the node's bounding box the whole node is counted at the average of
+ *  its extreme kernel values, otherwise its children are visited closest-first.
+ *  The error of counting a node wholesale is bounded by half the spread of its
+ *  kernel values, and is required to be less than the tolerance times the
+ *  node's share of the points times the sum so far, so the error of the whole
+ *  sum stays below the tolerance.
+ */
+static void kde_tree_sum_node(KDETreeSum *s, INT4 id) {
+    const struct tagLALInferenceKDENode *node = &s->kde->tree[id];
+    REAL8 min_dist2, max_dist2, delta;
+
+    if (id == s->skip)
+        return;
+
+    kde_tree_distances(s, node, &min_dist2, &max_dist2);
+    delta = (max_dist2 - min_dist2)/2.;
+
+    if (-min_dist2/2. + log1p(-exp(-delta)) <= s->log_budget + s->log_max + log(s->sum)) {
+        kde_tree_accumulate(s, log((REAL8)(node->end - node->start)) - min_dist2/2. +
+                               log((1. + exp(-delta))/2.));
+    } else if (node->left < 0) {
+        kde_tree_sum_leaf(s, node);
+    } else {
+        REAL8 left_min, right_min, dummy;
+        kde_tree_distances(s, &s->kde->tree[node->left], &left_min, &dummy);
+        kde_tree_distances(s, &s->kde->tree[node->right], &right_min, &dummy);
+
+        if (left_min <= right_min) {
+            kde_tree_sum_node(s, node->left);
+            kde_tree_sum_node(s, node->right);
+        } else {
+            kde_tree_sum_node(s, node->right);
+            kde_tree_sum_node(s, node->left);
+        }
+    }
+}
+
+/* Log of the sum of the (unnormalized) kernels at a whitened point */
+static REAL8 kde_tree_log_sum(const LALInferenceKDE *kde, const REAL8 *y) {
+    KDETreeSum s;
+    INT4 id = 0;
+    REAL8 left_min, right_min, dummy;
+
+    s.kde = kde;
+    s.y = y;
+    s.log_max = -INFINITY;
+    s.sum = 0.;
+    s.log_budget = log(kde->tolerance) - log((REAL8)kde->npts) + log(2.);
+
+    /* Seed the sum with the leaf nearest the point, so that distant nodes
+     * can be discounted against it */
+    while (kde->tree[id].left >= 0) {
+        kde_tree_distances(&s, &kde->tree[kde->tree[id].left], &left_min, &dummy);
+        kde_tree_distances(&s, &kde->tree[kde->tree[id].right], &right_min, &dummy);
+        id = left_min <= right_min ? kde->tree[id].left : kde->tree[id].right;
+    }
+    kde_tree_sum_leaf(&s, &kde->tree[id]);
+
+    s.skip = id;
+    kde_tree_sum_node(&s, 0);
+
+    return s.log_max + log(s.sum);
+}
+
+
 
 /**
  * Allocate, fill, and tune a Gaussian kernel density estimate from
@@ -157,6 +430,7 @@ LALInferenceKDE *LALInferenceInitKDE(INT4 npts, INT4 dim) {
     LALInferenceKDE *kde = XLALCalloc(1, sizeof(LALInferenceKDE));
     kde->dim = dim;
     kde->npts = npts;
+    kde->tolerance = LALINFERENCE_KDE_DEFAULT_TOLERANCE;
     kde->mean = gsl_vector_calloc(dim);
     kde->cholesky_decomp_cov = gsl_matrix_calloc(dim, dim);
     kde->cholesky_decomp_cov_lower = gsl_matrix_calloc(dim, dim);
@@ -194,6 +468,7 @@ void LALInferenceDestroyKDE(LALInferenceKDE *kde) {
         gsl_matrix_free(kde->cov);
 
         if (kde->npts > 0) gsl_matrix_free(kde->data);
+        kde_tree_free(kde);
 
         XLALFree(kde->lower_bound_types);
         XLALFree(kde->upper_bound_types);
@@ -284,6 +559,9 @@ void LALInferenceSetKDEBandwidth(LALInferenceKDE *kde) {
     kde->log_norm_factor =
         log(kde->npts * sqrt(pow(2*LAL_PI, kde->dim) * det_cov));
 
+    /* Build the tree used to evaluate the kernel sum */
+    kde_tree_init(kde);
+
     return;
 }
 
@@ -299,8 +577,7 @@ void LALInferenceSetKDEBandwidth(LALInferenceKDE *kde) {
  */
 REAL8 LALInferenceKDEEvaluatePoint(LALInferenceKDE *kde, REAL8 *point) {
     INT4 dim = kde->dim;
-    INT4 npts = kde->npts;
-    INT4 i, j, p;
+    INT4 i, p;
     INT4 n_evals = 1;  // Number of evaluations to be done
     REAL8 min, max, width, val;
 
@@ -368,50 +645,23 @@ REAL8 LALInferenceKDEEvaluatePoint(LALInferenceKDE *kde, REAL8 *point) {
         }
     }
 
-    /* Loop over list of reflected and cycled points */
-    REAL8* results = XLALMalloc(npts * sizeof(REAL8));
     REAL8* eval_results = XLALMalloc(n_evals * sizeof(REAL8));
 
-    /* Loop over reflected and cycled set of points */
+    /* Loop over reflected and cycled set of points, summing the kernels
+     * through the k-d tree in coordinates whitened by the kernel covariance */
     for (i = 0; i < n_evals; i++) {
         gsl_vector_view pt = gsl_matrix_row(points, i);
-
-        /* Loop over points in KDE dataset, using the Cholesky decomposition
-         * of the covariance to avoid ever inverting the covariance matrix */
-        #pragma omp parallel
-        {
-            /* Vectors that will hold the difference and transformed distance */
-            gsl_vector *diff = gsl_vector_alloc(dim);
-            gsl_vector *tdiff = gsl_vector_alloc(dim);
-
-            #pragma omp for schedule(static)
-            for (j = 0; j < npts; j++) {
-                gsl_vector_view d = gsl_matrix_row(kde->data, j);
-                gsl_vector_memcpy(diff, &d.vector);
-
-                gsl_vector_sub(diff, &pt.vector);
-                gsl_linalg_cholesky_solve(kde->cholesky_decomp_cov, diff, tdiff);
-                gsl_vector_mul(diff, tdiff);
-
-                REAL8 energy = 0.;
-                for (INT4 k=0; k<dim; k++)
-                    energy += gsl_vector_get(diff, k);
-                results[j] = -energy/2.;
-            }
-
-            gsl_vector_free(diff);
-            gsl_vector_free(tdiff);
-        }
+        gsl_blas_dtrsv(CblasLower, CblasNoTrans, CblasNonUnit,
+                       kde->cholesky_decomp_cov_lower, &pt.vector);
 
         /* Normalize the result */
-        eval_results[i] = log_add_exps(results, npts) - kde->log_norm_factor;
+        eval_results[i] = kde_tree_log_sum(kde, pt.vector.data) - kde->log_norm_factor;
     }
 
     /* Accumulate probability after accounting for all boundaries */
     REAL8 result = log_add_exps(eval_results, n_evals);
 
     gsl_matrix_free(points);
-    XLALFree(results);
     XLALFree(eval_results);
 
     return result;
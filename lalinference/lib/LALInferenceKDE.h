@@ -28,6 +28,7 @@
 #include <lal/LALInference.h>
 
 struct tagkmeans;
+struct tagLALInferenceKDENode;
 
 /**
  * Structure containing the Guassian kernel density of a set of samples.
@@ -51,8 +52,19 @@ tagKDE
     LALInferenceParamVaryType * upper_bound_types; /**< Array of param boundary types */
     REAL8 * lower_bounds;              /**< Lower param bounds */
     REAL8 * upper_bounds;              /**< Upper param bounds */
+
+    REAL8 tolerance;                        /**< Relative error tolerated in the kernel sum
+                                                  when evaluating the KDE; zero sums every
+                                                  kernel exactly. */
+    REAL8 * white_data;                     /**< \a data whitened by the kernel covariance,
+                                                  stored row-wise in k-d tree order. */
+    struct tagLALInferenceKDENode * tree;   /**< Nodes of the k-d tree over \a white_data. */
+    REAL8 * tree_bounds;                    /**< Bounding boxes of the k-d tree nodes. */
 } LALInferenceKDE;
 
+/** Default relative tolerance on the kernel sum of a KDE evaluation. */
+#define LALINFERENCE_KDE_DEFAULT_TOLERANCE 1e-6
+
 /* Allocate, fill, and tune a Gaussian kernel density estimate given an array of points. */
 LALInferenceKDE *LALInferenceNewKDE(REAL8 *pts, INT4 npts, INT4 dim, INT4 *mask);
 
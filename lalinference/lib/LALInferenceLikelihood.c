@@ -34,12 +34,15 @@
 #include <lal/FrequencySeries.h>
 #include <lal/TimeFreqFFT.h>
 #include <lal/LALInferenceDistanceMarg.h>
+#include <lal/LALProfile.h>
 
 #include <gsl/gsl_sf_bessel.h>
 #include <gsl/gsl_sf_dawson.h>
 #include <gsl/gsl_sf_erf.h>
 #include <gsl/gsl_complex_math.h>
 #include <lal/LALInferenceTemplate.h>
+#include <lal/LALInferenceRelativeBinning.h>
+#include <lal/LALInferenceGenerateROQ.h>
 
 #include "logaddexp.h"
 
@@ -73,6 +76,95 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 
 static double integrate_interpolated_log(double h, REAL8 *log_ys, size_t n, double *imean, size_t *imax);
 
+/* The frequency-domain kernel keeps FD_KERNEL_LANES independent running
+ * sums and phasors so that the bins can be processed in SIMD lanes, and
+ * re-evaluates the time-shift phasor exactly every FD_KERNEL_BLOCK bins;
+ * blocks are shared between threads. */
+#define FD_KERNEL_LANES 4
+#define FD_KERNEL_BLOCK 1024
+
+/* Sums over n frequency bins of the weighted |d-h|^2, |d|^2, |h|^2 and
+ * d h^*, where h = (Fplus hp + Fcross hc) exp(-2 pi i t f) (times cal if
+ * given) and the weight at each bin is scale / psd */
+static void LALInferenceFreqDomainKernel(const COMPLEX16 *dtilde, const COMPLEX16 *hptilde, const COMPLEX16 *hctilde,
+                                         const REAL8 *psd, const COMPLEX16 *cal, size_t n,
+                                         REAL8 Fplus, REAL8 Fcross, REAL8 phi0, REAL8 dphi, REAL8 scale,
+                                         REAL8 *chisq, REAL8 *dd, REAL8 *hh, COMPLEX16 *dh)
+{
+  const size_t nblocks = (n + FD_KERNEL_BLOCK - 1) / FD_KERNEL_BLOCK;
+  const REAL8 sre = cos(FD_KERNEL_LANES * dphi);
+  const REAL8 sim = -sin(FD_KERNEL_LANES * dphi);
+  REAL8 sum_chisq = 0.0, sum_dd = 0.0, sum_hh = 0.0, sum_dhre = 0.0, sum_dhim = 0.0;
+  size_t b;
+
+  #pragma omp parallel for schedule(static) if(nblocks > 1) reduction(+:sum_chisq,sum_dd,sum_hh,sum_dhre,sum_dhim)
+  for (b = 0; b < nblocks; b++)
+  {
+    const size_t start = b * FD_KERNEL_BLOCK;
+    const size_t len = n - start < FD_KERNEL_BLOCK ? n - start : FD_KERNEL_BLOCK;
+    REAL8 pre[FD_KERNEL_LANES], pim[FD_KERNEL_LANES];
+    REAL8 acc_chisq[FD_KERNEL_LANES], acc_dd[FD_KERNEL_LANES], acc_hh[FD_KERNEL_LANES];
+    REAL8 acc_dhre[FD_KERNEL_LANES], acc_dhim[FD_KERNEL_LANES];
+    size_t k, l;
+
+    for (l = 0; l < FD_KERNEL_LANES; l++)
+    {
+      pre[l] = cos(phi0 + (start + l) * dphi);
+      pim[l] = -sin(phi0 + (start + l) * dphi);
+      acc_chisq[l] = acc_dd[l] = acc_hh[l] = acc_dhre[l] = acc_dhim[l] = 0.0;
+    }
+
+    for (k = 0; k < len; k += FD_KERNEL_LANES)
+    {
+      const size_t nl = len - k < FD_KERNEL_LANES ? len - k : FD_KERNEL_LANES;
+      for (l = 0; l < nl; l++)
+      {
+        const size_t i = start + k + l;
+        const REAL8 w = scale / psd[i];
+        const REAL8 dre = creal(dtilde[i]), dim = cimag(dtilde[i]);
+        const REAL8 pre0 = Fplus * creal(hptilde[i]) + Fcross * creal(hctilde[i]);
+        const REAL8 pim0 = Fplus * cimag(hptilde[i]) + Fcross * cimag(hctilde[i]);
+        REAL8 hre = pre0 * pre[l] - pim0 * pim[l];
+        REAL8 him = pre0 * pim[l] + pim0 * pre[l];
+        if (cal)
+        {
+          const REAL8 cre = creal(cal[i]), cim = cimag(cal[i]);
+          const REAL8 tmp = hre * cre - him * cim;
+          him = hre * cim + him * cre;
+          hre = tmp;
+        }
+        const REAL8 rre = dre - hre, rim = dim - him;
+        acc_chisq[l] += w * (rre * rre + rim * rim);
+        acc_dd[l] += w * (dre * dre + dim * dim);
+        acc_hh[l] += w * (hre * hre + him * him);
+        acc_dhre[l] += w * (dre * hre + dim * him);
+        acc_dhim[l] += w * (dim * hre - dre * him);
+      }
+      /* advance each lane's phasor by FD_KERNEL_LANES bins */
+      for (l = 0; l < FD_KERNEL_LANES; l++)
+      {
+        const REAL8 tmp = pre[l] * sre - pim[l] * sim;
+        pim[l] = pre[l] * sim + pim[l] * sre;
+        pre[l] = tmp;
+      }
+    }
+
+    for (l = 0; l < FD_KERNEL_LANES; l++)
+    {
+      sum_chisq += acc_chisq[l];
+      sum_dd += acc_dd[l];
+      sum_hh += acc_hh[l];
+      sum_dhre += acc_dhre[l];
+      sum_dhim += acc_dhim[l];
+    }
+  }
+
+  *chisq = sum_chisq;
+  *dd = sum_dd;
+  *hh = sum_hh;
+  *dh = crect(sum_dhre, sum_dhim);
+}
+
 static int get_calib_spline(LALInferenceVariables *vars, const char *ifoname, REAL8Vector **logfreqs, REAL8Vector **amps, REAL8Vector **phases);
 static int get_calib_spline(LALInferenceVariables *vars, const char *ifoname, REAL8Vector **logfreqs, REAL8Vector **amps, REAL8Vector **phases)
 {
@@ -100,6 +192,47 @@ static int get_calib_spline(LALInferenceVariables *vars, const char *ifoname, RE
   return(XLAL_SUCCESS);
 }
 
+/* calibration factor on the frequencies freqs, or on the uniform grid with
+ * spacing deltaF if freqs is NULL, from spline weights cached in the model */
+static int calib_spline_factor(LALInferenceModel *model, UINT4 ifo, UINT4 set, const REAL8Vector *logfreqs,
+                               const REAL8Vector *amps, const REAL8Vector *phases, const REAL8Sequence *freqs,
+                               REAL8 deltaF, COMPLEX16Sequence *calFactor);
+static int calib_spline_factor(LALInferenceModel *model, UINT4 ifo, UINT4 set, const REAL8Vector *logfreqs,
+                               const REAL8Vector *amps, const REAL8Vector *phases, const REAL8Sequence *freqs,
+                               REAL8 deltaF, COMPLEX16Sequence *calFactor)
+{
+  LALInferenceSplineCalibrationWeights **w = &(model->spcal);
+
+  while (*w && ((*w)->ifo != ifo || (*w)->set != set)) w = &((*w)->next);
+
+  /* the nodes are fixed parameters, but recompute the weights if anything changed */
+  if (*w) {
+    int ok = ((*w)->n_nodes == logfreqs->length && (*w)->length == calFactor->length && (*w)->deltaF == (freqs ? 0.0 : deltaF));
+    for (UINT4 i = 0; ok && i < logfreqs->length; i++) ok = ((*w)->logfreqs[i] == logfreqs->data[i]);
+    if (!ok) {
+      LALInferenceSplineCalibrationWeights *next = (*w)->next;
+      (*w)->next = NULL;
+      LALInferenceDestroySplineCalibrationWeights(*w);
+      *w = next;
+    }
+  }
+
+  if (!*w || (*w)->ifo != ifo || (*w)->set != set) {
+    LALInferenceSplineCalibrationWeights *created = NULL;
+    XLAL_CHECK(freqs == NULL || freqs->length == calFactor->length, XLAL_EBADLEN);
+    created = freqs ? LALInferenceCreateSplineCalibrationWeightsNodes(logfreqs, freqs)
+      : LALInferenceCreateSplineCalibrationWeights(logfreqs, deltaF, calFactor->length);
+    XLAL_CHECK(created != NULL, XLAL_EFUNC);
+    created->ifo = ifo;
+    created->set = set;
+    created->next = *w;
+    *w = created;
+  }
+
+  XLAL_CHECK(LALInferenceApplySplineCalibrationWeights(*w, amps, phases, calFactor->data) == XLAL_SUCCESS, XLAL_EFUNC);
+  return XLAL_SUCCESS;
+}
+
 void LALInferenceInitLikelihood(LALInferenceRunState *runState)
 {
     char help[]="\
@@ -117,6 +250,9 @@ void LALInferenceInitLikelihood(LALInferenceRunState *runState)
     (--margtimephi)                  Using marginalised in time and phase likelihood\n\
     (--margdist)                     Using marginalisation in distance with d^2 prior (compatible with --margphi and --margtimephi)\n\
     (--margdist-comoving)            Using marginalisation in distance with uniform-in-comoving-volume prior (compatible with --margphi and --margtimephi)\n\
+    (--margdist-cache DIR)           Cache the distance marginalisation lookup tables in DIR, shared by all processes using it\n\
+    (--relative-binning)             Use the relative binning likelihood, with the starting parameters as fiducial waveform\n\
+    (--relative-binning-epsilon EPS) Phase error tolerated in each relative binning bin (default 0.1)\n\
     \n";
 
     /* Print command line arguments if help requested */
@@ -139,6 +275,10 @@ void LALInferenceInitLikelihood(LALInferenceRunState *runState)
 
     LALInferenceThreadState *thread = &(runState->threads[0]);
 
+    ProcessParamsTable *ppt = LALInferenceGetProcParamVal(commandLine, "--margdist-cache");
+    if (ppt)
+        LALInferenceSetMarginalDistanceCache(ppt->value);
+
     REAL8 nullLikelihood = 0.0; // Populated if such a thing exists
 
    if (LALInferenceGetProcParamVal(commandLine, "--zeroLogLike")) {
@@ -372,6 +512,8 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
   UINT4 constantcal_active=0;
   INT4 errnum=0;
 
+  XLAL_PROFILE_BEGIN(loglikelihood, "LALInferenceFusedFreqDomainLogLikelihood");
+
   /* ROQ likelihood stuff */
   REAL8 d_inner_h=0.0;
   double dist_min, dist_max;
@@ -418,6 +560,10 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
     margtime=1;
 
   if(model->roq_flag && margtime) XLAL_ERROR_REAL8(XLAL_EINVAL,"ROQ does not support time marginalisation");
+  if(model->relbin && !(marginalisationflags==GAUSSIAN || marginalisationflags==MARGPHI))
+    XLAL_ERROR_REAL8(XLAL_EINVAL,"Relative binning only supports the Gaussian and phase-marginalised likelihoods");
+  if(model->relbin && constantcal_active)
+    XLAL_ERROR_REAL8(XLAL_EINVAL,"Relative binning does not support constant calibration errors");
 
   
   LALStatus status;
@@ -641,7 +787,9 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
         if(LALInferenceCheckVariable(model->params,"time")) LALInferenceRemoveVariable(model->params,"time");
         LALInferenceAddVariable(model->params, "time", &timeTmp, LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_LINEAR);
 
+        REAL8 templt_start = model->profile ? LALInferenceProfileClock() : 0;
         XLAL_TRY(model->templt(model),errnum);
+        if (model->profile) LALInferenceTimerAccumulate(&model->profile->templt, templt_start);
         errnum&=~XLAL_EFUNC;
         if(errnum!=XLAL_SUCCESS)
         {
@@ -688,12 +836,14 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 	  /* get_calib_spline creates and fills the logfreqs, amps, phases arrays */
 	  get_calib_spline(currentParams, dataPtr->name, &logfreqs, &amps, &phases);
 	  if (model->roq_flag) {
-
-             LALInferenceSplineCalibrationFactorROQ(logfreqs, amps, phases,
-						model->roq->frequencyNodesLinear,
-						&(model->roq->calFactorLinear),
-						model->roq->frequencyNodesQuadratic,
-						&(model->roq->calFactorQuadratic));
+	    XLAL_CHECK_REAL8(calib_spline_factor(model, ifo, 0, logfreqs, amps, phases, model->roq->frequencyNodesLinear,
+						 0.0, model->roq->calFactorLinear) == XLAL_SUCCESS, XLAL_EFUNC);
+	    XLAL_CHECK_REAL8(calib_spline_factor(model, ifo, 1, logfreqs, amps, phases, model->roq->frequencyNodesQuadratic,
+						 0.0, model->roq->calFactorQuadratic) == XLAL_SUCCESS, XLAL_EFUNC);
+	  }
+	  else if (model->relbin) {
+	    XLAL_CHECK_REAL8(calib_spline_factor(model, ifo, 0, logfreqs, amps, phases, model->relbin->frequencies,
+						 0.0, model->relbin->calFactor) == XLAL_SUCCESS, XLAL_EFUNC);
 	  }
 
 	  else{
@@ -704,7 +854,8 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
                        &lalDimensionlessUnit,
                        dataPtr->freqData->data->length);
 	    }
-          LALInferenceSplineCalibrationFactor(logfreqs, amps, phases, calFactor);
+	    XLAL_CHECK_REAL8(calib_spline_factor(model, ifo, 0, logfreqs, amps, phases, NULL,
+						 calFactor->deltaF, calFactor->data) == XLAL_SUCCESS, XLAL_EFUNC);
 	}
 	if(logfreqs) XLALDestroyREAL8Vector(logfreqs);
 	if(amps) XLALDestroyREAL8Vector(amps);
@@ -799,35 +950,31 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 
     if (model->roq_flag) {
 
-	double complex weight_iii;
+	if ( dataPtr->roq->time_weights->n_nodes != model->roq->frequencyNodesLinear->length ){
+	  XLAL_ERROR_REAL8(XLAL_EBADLEN, "Number of ROQ linear weights does not match the number of linear frequency nodes");
+	}
 
 	if (spcal_active){
 
-	    for(unsigned int iii=0; iii < model->roq->frequencyNodesLinear->length; iii++){
-
-			complex double template_EI = model->roq->calFactorLinear->data[iii] * (dataPtr->fPlus*model->roq->hptildeLinear->data->data[iii] + dataPtr->fCross*model->roq->hctildeLinear->data->data[iii] );
-
-			weight_iii = gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_real_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_real_weight_linear) + I*gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_imag_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_imag_weight_linear);
-
-			this_ifo_d_inner_h += ( weight_iii * ( conj( template_EI ) ) );
+		if ( LALInferenceROQTimeWeightsDotProduct(dataPtr->roq->time_weights, timeshift,
+							 model->roq->hptildeLinear->data->data, model->roq->hctildeLinear->data->data,
+							 model->roq->calFactorLinear->data, Fplus, Fcross,
+							 &this_ifo_d_inner_h) != XLAL_SUCCESS ){
+		  XLAL_ERROR_REAL8(XLAL_EFUNC);
 		}
 
 		for(unsigned int jjj=0; jjj < model->roq->frequencyNodesQuadratic->length; jjj++){
 
-			this_ifo_s += dataPtr->roq->weightsQuadratic[jjj] * creal( conj( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*dataPtr->fPlus + model->roq->hctildeQuadratic->data->data[jjj]*dataPtr->fCross) ) * ( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*dataPtr->fPlus + model->roq->hctildeQuadratic->data->data[jjj]*dataPtr->fCross) ) );
+			this_ifo_s += dataPtr->roq->weightsQuadratic[jjj] * creal( conj( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*Fplus + model->roq->hctildeQuadratic->data->data[jjj]*Fcross) ) * ( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*Fplus + model->roq->hctildeQuadratic->data->data[jjj]*Fcross) ) );
 		}
 	}
 
 	else{
 
-		for(unsigned int iii=0; iii < model->roq->frequencyNodesLinear->length; iii++){
-
-			complex double template_EI = dataPtr->fPlus*model->roq->hptildeLinear->data->data[iii] + dataPtr->fCross*model->roq->hctildeLinear->data->data[iii];
-
-			weight_iii = gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_real_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_real_weight_linear) + I*gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_imag_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_imag_weight_linear);
-
-			this_ifo_d_inner_h += weight_iii*conj(template_EI) ;
-
+		if ( LALInferenceROQTimeWeightsDotProduct(dataPtr->roq->time_weights, timeshift,
+							 model->roq->hptildeLinear->data->data, model->roq->hctildeLinear->data->data,
+							 NULL, Fplus, Fcross, &this_ifo_d_inner_h) != XLAL_SUCCESS ){
+		  XLAL_ERROR_REAL8(XLAL_EFUNC);
 		}
 
 		for(unsigned int jjj=0; jjj < model->roq->frequencyNodesQuadratic->length; jjj++){
@@ -898,6 +1045,47 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
     REAL8 this_ifo_S=0.0;
     COMPLEX16 this_ifo_Rcplx=0.0;
 
+    if (model->relbin && (!signalFlag || psdFlag || glitchFlag))
+      XLAL_ERROR_REAL8(XLAL_EINVAL,"Relative binning does not support PSD fitting or glitch models");
+
+    /* The common case of a Gaussian or phase-marginalised likelihood of a
+       signal alone, without PSD fitting, glitches or constant calibration,
+       goes through the vectorised kernel, or the relative binning sums when
+       the template is only known at the bin edges. */
+    if (signalFlag && !psdFlag && !glitchFlag && !constantcal_active && upper>=lower
+        && (marginalisationflags==GAUSSIAN || marginalisationflags==MARGPHI))
+    {
+      REAL8 sum_chisq, sum_dd, sum_hh;
+      COMPLEX16 sum_dh;
+      if (model->relbin)
+      {
+        if (LALInferenceRelativeBinningInnerProducts(dataPtr->relbin,
+                                                     model->relbin->hptilde->data->data,
+                                                     model->relbin->hctilde->data->data,
+                                                     spcal_active ? model->relbin->calFactor->data : NULL,
+                                                     Fplus, Fcross, timeshift,
+                                                     &sum_dd, &sum_hh, &sum_dh) != XLAL_SUCCESS)
+          XLAL_ERROR_REAL8(XLAL_EFUNC);
+        sum_chisq = sum_dd + sum_hh - 2.0*creal(sum_dh);
+      }
+      else
+        LALInferenceFreqDomainKernel(dtilde, hptilde, hctilde, psd,
+                                     spcal_active ? &(calFactor->data->data[lower]) : NULL,
+                                     (size_t)(upper-lower+1), Fplus, Fcross,
+                                     twopit*deltaF*lower, twopit*deltaF,
+                                     TwoDeltaToverN/(deltaT*deltaT),
+                                     &sum_chisq, &sum_dd, &sum_hh, &sum_dh);
+      D+=sum_dd;
+      this_ifo_S+=sum_hh;
+      this_ifo_Rcplx+=sum_dh;
+      Rcplx+=sum_dh;
+      if (marginalisationflags==GAUSSIAN)
+      {
+        chisquared+=sum_chisq;
+        model->ifo_loglikelihoods[ifo]-=sum_chisq;
+      }
+    }
+    else
     for (i=lower,chisq=0.0,re = cos(twopit*deltaF*i),im = -sin(twopit*deltaF*i);
          i<=upper;
          i++, psd++, hptilde++, hctilde++, dtilde++,
@@ -1403,9 +1591,19 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
      }
   }
 
+  XLAL_PROFILE_END(loglikelihood);
   return(loglikelihood);
 }
 
+/* Directory holding the cached distance marginalisation tables, if any */
+static char *margdist_cache_dir = NULL;
+
+void LALInferenceSetMarginalDistanceCache(const char *dir)
+{
+    XLALFree(margdist_cache_dir);
+    margdist_cache_dir = dir ? XLALStringDuplicate(dir) : NULL;
+}
+
 double LALInferenceMarginalDistanceLogLikelihood(double dist_min, double dist_max, double OptimalSNR, double d_inner_h, int cosmology, int margphi)
 {
         static const size_t default_log_radial_integrator_size = 400;
@@ -1420,14 +1618,15 @@ double LALInferenceMarginalDistanceLogLikelihood(double dist_min, double dist_ma
             {
                 printf("Initialising distance integration lookup table\n");
                 /* Initialise the integrator for the first time */
-                integrator = log_radial_integrator_init(
+                integrator = log_radial_integrator_init_cached(
                                 dist_min,
                                 dist_max,
                                 2, /* Power of distance in prior */
                                 cosmology,
                                 pmax,
                                 default_log_radial_integrator_size * 5, /* CHECKME: fudge factor of 5 compared to bayestar */
-                                !margphi);
+                                !margphi,
+                                margdist_cache_dir);
                 /* distance prior normalisation */
                 log_norm = log_radial_integrator_eval(integrator, 0, 0, -INFINITY, -INFINITY);
             }
@@ -1771,7 +1970,9 @@ REAL8 LALInferenceFastSineGaussianLogLikelihood(LALInferenceVariables *currentPa
       LALInferenceAddVariable(model->params, "time", &timeTmp, LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_LINEAR);
 
       INT4 errnum=0;
+      REAL8 templt_start = model->profile ? LALInferenceProfileClock() : 0;
       XLAL_TRY(model->templt(model),errnum);
+      if (model->profile) LALInferenceTimerAccumulate(&model->profile->templt, templt_start);
       errnum&=~XLAL_EFUNC;
       if(errnum!=XLAL_SUCCESS)
       {
@@ -2003,7 +2204,9 @@ void LALInferenceNetworkSNR(LALInferenceVariables *currentParams,
         LALInferenceAddVariable(model->params, "phase", &pi2, LALINFERENCE_REAL8_t, LALINFERENCE_PARAM_LINEAR);
       }
       INT4 errnum=0;
+      REAL8 templt_start = model->profile ? LALInferenceProfileClock() : 0;
       XLAL_TRY(model->templt(model),errnum);
+      if (model->profile) LALInferenceTimerAccumulate(&model->profile->templt, templt_start);
       errnum&=~XLAL_EFUNC;
       if(errnum!=XLAL_SUCCESS)
       {
@@ -2066,3 +2269,40 @@ void LALInferenceNetworkSNR(LALInferenceVariables *currentParams,
 
   model->SNR = sqrt(model->SNR);
 }
+
+int LALInferenceEnsembleLogLikelihood(LALInferenceRunState *runState, LALInferenceThreadState *threads, INT4 nthreads, REAL8 *logPriors, REAL8 *logLikelihoods)
+{
+  INT4 i, n = 0;
+  INT4 *inside = NULL;
+
+  XLAL_CHECK(runState && runState->prior && runState->likelihood, XLAL_EFAULT, "Run state has no prior or likelihood function");
+  XLAL_CHECK(threads || nthreads == 0, XLAL_EFAULT);
+  XLAL_CHECK(logPriors && logLikelihoods, XLAL_EFAULT);
+  XLAL_CHECK(nthreads >= 0, XLAL_EINVAL);
+  if (nthreads == 0)
+    return XLAL_SUCCESS;
+
+  /* The priors are cheap; evaluate them all first */
+  #pragma omp parallel for schedule(static)
+  for (i = 0; i < nthreads; i++) {
+    logPriors[i] = runState->prior(runState, threads[i].proposedParams, threads[i].model);
+    logLikelihoods[i] = -INFINITY;
+  }
+
+  /* Only the walkers with a non-zero prior need a template; hand them out
+   * one at a time, as template costs vary across the parameter space */
+  inside = XLALMalloc(nthreads * sizeof(*inside));
+  XLAL_CHECK(inside, XLAL_ENOMEM);
+  for (i = 0; i < nthreads; i++)
+    if (isfinite(logPriors[i]))
+      inside[n++] = i;
+
+  #pragma omp parallel for schedule(dynamic, 1)
+  for (i = 0; i < n; i++) {
+    LALInferenceThreadState *thread = &threads[inside[i]];
+    logLikelihoods[inside[i]] = runState->likelihood(thread->proposedParams, runState->data, thread->model);
+  }
+
+  XLALFree(inside);
+  return XLAL_SUCCESS;
+}
@@ -184,6 +184,10 @@ REAL8 LALInferenceMarginalisedTimePhaseLogLikelihood(LALInferenceVariables *curr
     margphi: 0 = use gaussian likelihood, 1 = phase-marginalised bessel likelihood */
 double LALInferenceMarginalDistanceLogLikelihood(double dist_min, double dist_max, double OptimalSNR, double d_inner_h, int cosmology, int margphi);
 
+/** Cache the lookup tables of LALInferenceMarginalDistanceLogLikelihood() in the directory \a dir,
+  * memory-mapping them when a matching cache exists.  NULL disables the cache. */
+void LALInferenceSetMarginalDistanceCache(const char *dir);
+
 
 /**
  * Returns the log-likelihood marginalised over the time dimension
@@ -209,6 +213,20 @@ REAL8 LALInferenceFastSineGaussianLogLikelihood(LALInferenceVariables *currentPa
 
 /** Calculate the SNR across the network */
 void LALInferenceNetworkSNR(LALInferenceVariables *currentParams, LALInferenceIFOData *data, LALInferenceModel *model);
+
+#ifndef SWIG   /* exclude from SWIG interface */
+
+/**
+ * Evaluate the prior, and wherever it is non-zero the likelihood, of the
+ * proposed parameters of a block of \a nthreads chains, e.g. the walkers of
+ * an ensemble sampler.  Each chain is evaluated with its own \c model, so
+ * the templates of the block are generated concurrently over OpenMP
+ * threads, with the walkers inside the prior shared out dynamically.
+ * Walkers outside the prior get a log-likelihood of \c -INFINITY.
+ */
+int LALInferenceEnsembleLogLikelihood(LALInferenceRunState *runState, LALInferenceThreadState *threads, INT4 nthreads, REAL8 *logPriors, REAL8 *logLikelihoods);
+
+#endif /* SWIG */
 /** @} */
 
 #endif
@@ -19,10 +19,25 @@
 #include <lal/Sequence.h>
 #include <lal/LALInferenceMultibanding.h>
 
+/* width in log chirp mass and in mass ratio of the regions with their own adaptive grid */
+#define MULTIBAND_LOGMC_STEP 0.02
+#define MULTIBAND_Q_STEP 0.1
+#define MULTIBAND_Q_MIN 0.02
+
+/* safety factor applied to the time to merger estimated from the probe waveform */
+#define MULTIBAND_TAU_SAFETY 1.2
+
+/* with higher modes the amplitude and phase of the waveform beat between the modes, which needs a
+   finer grid than the time to merger alone to be interpolated accurately */
+#define MULTIBAND_HM_OVERSAMPLING 16.0
+
 
 /** F(t) and T(f) for newtonian waveform */
 static double LALInferenceTimeFrequencyRelation(double mc, double inPar, UINT4 flag_f);
 
+/** Phase step of a waveform between two frequencies df apart, allowing for the phase wrapping around */
+static double MultibandPhaseStep(COMPLEX16 start, COMPLEX16 end, double df);
+
 
 static double LALInferenceTimeFrequencyRelation(double mc, double inPar, UINT4 flag_f)
 {
@@ -137,3 +152,230 @@ REAL8Sequence *LALInferenceMultibandFrequencies(int NBands, double f_min, double
     return(Frequencies);
     
 }
+
+static double MultibandPhaseStep(COMPLEX16 start, COMPLEX16 end, double df)
+{
+    double dpsi = carg(end) - carg(start);
+    /* NOTE: If changing this check that waveforms are not corrupted
+     * at high frequencies when dpsi/df can go slightly -ve without
+     * the phase wrapping around (e.g. TF2 1.4-1.4 srate=4096)
+     */
+    if (dpsi/df < -LAL_PI) dpsi += LAL_TWOPI;
+    return dpsi;
+}
+
+REAL8Sequence *LALInferenceMultibandFrequenciesFromWaveform(const REAL8Sequence *frequencies, const COMPLEX16 *h,
+                                                            double f_min, double f_max, double deltaF0, UINT4 mmax)
+{
+    XLAL_CHECK_NULL(frequencies && h, XLAL_EFAULT);
+    XLAL_CHECK_NULL(frequencies->length > 1, XLAL_EINVAL, "Need a probe waveform at two or more frequencies");
+    XLAL_CHECK_NULL(mmax > 0, XLAL_EINVAL, "Largest azimuthal mode number must be positive");
+
+    UINT4 n = frequencies->length;
+    double *tau = XLALMalloc((n - 1)*sizeof(double));
+    XLAL_CHECK_NULL(tau, XLAL_ENOMEM);
+
+    /* time at which each interval of the probe grid is reached, from the phase derivative, and from
+       that the time to the latest (or earliest) time reached at higher frequencies, filled in so that
+       it does not increase with frequency */
+    double gmin = INFINITY, gmax = -INFINITY, taumax = 0.0;
+    for (UINT4 i = n - 1; i-- > 0; ) {
+        double df = frequencies->data[i+1] - frequencies->data[i];
+        if (h[i] != 0.0 && h[i+1] != 0.0 && df > 0.0) {
+            double g = -MultibandPhaseStep(h[i], h[i+1], df)/(LAL_TWOPI*df);
+            if (g < gmin) gmin = g;
+            if (g > gmax) gmax = g;
+            if (gmax - g > taumax) taumax = gmax - g;
+            if (g - gmin > taumax) taumax = g - gmin;
+        }
+        tau[i] = taumax;
+    }
+
+    f_min=deltaF0*ceil(f_min/deltaF0);
+    f_max=deltaF0*floor(f_max/deltaF0);
+    int n_max = floor(- log2(deltaF0*2.1));
+    if (n_max < 0) n_max = 0;
+
+    double tau_scale = MULTIBAND_TAU_SAFETY*(mmax > 2 ? MULTIBAND_HM_OVERSAMPLING : 1.0);
+
+    UINT4 NFreq = 0, size = 1024;
+    double *freqs = XLALMalloc(size*sizeof(double));
+    if (!freqs) {
+        XLALFree(tau);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+    double f = f_min;
+    freqs[NFreq++] = f;
+    while (f < f_max) {
+        /* the mode with the largest m reaches f when the dominant mode is at 2f/mmax */
+        double fq = 2.0*f/mmax;
+        UINT4 lo = 0, hi = n - 1;
+        while (hi - lo > 1) {
+            UINT4 mid = (lo + hi)/2;
+            if (frequencies->data[mid] > fq) hi = mid;
+            else lo = mid;
+        }
+        int n_i = floor(- log2(deltaF0*(tau_scale*tau[lo] + 2.1)));
+        if (n_i < 0) n_i = 0;
+        if (n_i > n_max) n_i = n_max;
+
+        f += pow(2.,n_i)*deltaF0;
+        if (f > f_max) f = f_max;
+        if (NFreq == size) {
+            size *= 2;
+            double *tmp = XLALRealloc(freqs, size*sizeof(double));
+            if (!tmp) {
+                XLALFree(freqs);
+                XLALFree(tau);
+                XLAL_ERROR_NULL(XLAL_ENOMEM);
+            }
+            freqs = tmp;
+        }
+        freqs[NFreq++] = f;
+    }
+
+    REAL8Sequence *Frequencies = XLALCreateREAL8Sequence(NFreq);
+    if (Frequencies) memcpy(Frequencies->data, freqs, NFreq*sizeof(double));
+    XLALFree(freqs);
+    XLALFree(tau);
+    XLAL_CHECK_NULL(Frequencies, XLAL_EFUNC);
+    return Frequencies;
+}
+
+LALInferenceMultibandCache *LALInferenceCreateMultibandCache(REAL8Sequence *probe_frequencies, UINT4 mmax)
+{
+    XLAL_CHECK_NULL(probe_frequencies, XLAL_EFAULT);
+
+    LALInferenceMultibandCache *cache = XLALCalloc(1, sizeof(LALInferenceMultibandCache));
+    XLAL_CHECK_NULL(cache, XLAL_ENOMEM);
+    cache->probe_frequencies = probe_frequencies;
+    cache->mmax = mmax;
+    return cache;
+}
+
+void LALInferenceDestroyMultibandCache(LALInferenceMultibandCache *cache)
+{
+    if (!cache) return;
+    for (UINT4 i = 0; i < cache->n_grids; i++) XLALDestroyREAL8Sequence(cache->grids[i]);
+    XLALFree(cache->grids);
+    XLALFree(cache->mc_bins);
+    XLALFree(cache->q_bins);
+    XLALDestroyREAL8Sequence(cache->probe_frequencies);
+    XLALFree(cache);
+}
+
+REAL8Sequence *LALInferenceMultibandCacheLookup(const LALInferenceMultibandCache *cache, double mc, double q,
+                                                double *mc_probe, double *q_probe)
+{
+    XLAL_CHECK_NULL(cache, XLAL_EFAULT);
+
+    INT4 mc_bin = floor(log(mc)/MULTIBAND_LOGMC_STEP);
+    INT4 q_bin = floor(q/MULTIBAND_Q_STEP);
+
+    /* the lowest chirp mass and most unequal masses in the region give the longest waveforms */
+    if (mc_probe) *mc_probe = exp(mc_bin*MULTIBAND_LOGMC_STEP);
+    if (q_probe) *q_probe = q_bin*MULTIBAND_Q_STEP > MULTIBAND_Q_MIN ? q_bin*MULTIBAND_Q_STEP : MULTIBAND_Q_MIN;
+
+    for (UINT4 i = 0; i < cache->n_grids; i++)
+        if (cache->mc_bins[i] == mc_bin && cache->q_bins[i] == q_bin) return cache->grids[i];
+    return NULL;
+}
+
+int LALInferenceMultibandCacheAdd(LALInferenceMultibandCache *cache, double mc, double q, REAL8Sequence *grid)
+{
+    XLAL_CHECK(cache && grid, XLAL_EFAULT);
+
+    UINT4 n = cache->n_grids + 1;
+    INT4 *mc_bins = XLALRealloc(cache->mc_bins, n*sizeof(INT4));
+    XLAL_CHECK(mc_bins, XLAL_ENOMEM);
+    cache->mc_bins = mc_bins;
+    INT4 *q_bins = XLALRealloc(cache->q_bins, n*sizeof(INT4));
+    XLAL_CHECK(q_bins, XLAL_ENOMEM);
+    cache->q_bins = q_bins;
+    REAL8Sequence **grids = XLALRealloc(cache->grids, n*sizeof(REAL8Sequence *));
+    XLAL_CHECK(grids, XLAL_ENOMEM);
+    cache->grids = grids;
+
+    cache->mc_bins[n-1] = floor(log(mc)/MULTIBAND_LOGMC_STEP);
+    cache->q_bins[n-1] = floor(q/MULTIBAND_Q_STEP);
+    cache->grids[n-1] = grid;
+    cache->n_grids = n;
+    return XLAL_SUCCESS;
+}
+
+int LALInferenceMultibandInterpolate(const REAL8Sequence *frequencies, const COMPLEX16FrequencySeries *src,
+                                     COMPLEX16FrequencySeries *dest)
+{
+    XLAL_CHECK(frequencies && src && dest, XLAL_EFAULT);
+    XLAL_CHECK(src->data->length >= frequencies->length, XLAL_EBADLEN, "Waveform is shorter than the multiband frequencies");
+
+    REAL8 deltaF = dest->deltaF;
+    UINT4 length = dest->data->length;
+    UINT4 n = frequencies->length;
+    const COMPLEX16 *h = src->data->data;
+    COMPLEX16 *d = dest->data->data;
+    UINT4 j = ceil(frequencies->data[0] / deltaF);
+    if (j > length) j = length;
+    memset(d, 0, sizeof(*(d))*j);
+
+    /* chord slopes of the phase between the multiband frequencies, for the curvature of the phase */
+    double *slope = XLALMalloc((n > 1 ? n - 1 : 1)*sizeof(double));
+    XLAL_CHECK(slope, XLAL_ENOMEM);
+    for (UINT4 i = 0; i + 1 < n; i++) {
+        double df = frequencies->data[i+1] - frequencies->data[i];
+        slope[i] = (h[i] != 0.0 && h[i+1] != 0.0) ? MultibandPhaseStep(h[i], h[i+1], df)/df : NAN;
+    }
+
+    /* Loop over reduced frequency set */
+    for (UINT4 i = 0; i + 1 < n && j < length; i++) {
+        double startpsi = carg(h[i]);
+        double startamp = cabs(h[i]);
+        double endamp = cabs(h[i+1]);
+        double startf = frequencies->data[i];
+        double endf = frequencies->data[i+1];
+        double D = endf - startf; /* Big freq step */
+
+        /* the phase is the chord between the two frequencies plus b (f - startf)(f - endf), with b the
+           second divided difference of the phase on either side, averaged when both are available.
+           Intervals next to where the waveform vanishes, or where the curvature is implausibly large,
+           fall back to linear interpolation of the phase */
+        double s = isnan(slope[i]) ? 0.0 : slope[i];
+        double b = 0.0;
+        int nb = 0;
+        if (!isnan(slope[i]) && i > 0 && !isnan(slope[i-1])) {
+            b += (slope[i] - slope[i-1])/(endf - frequencies->data[i-1]);
+            nb++;
+        }
+        if (!isnan(slope[i]) && i + 2 < n && !isnan(slope[i+1])) {
+            b += (slope[i+1] - slope[i])/(frequencies->data[i+2] - startf);
+            nb++;
+        }
+        if (nb) b /= nb;
+        if (fabs(b)*D*D > LAL_PI) b = 0.0;
+
+        double x = j*deltaF - startf;
+        double psi = startpsi + s*x + b*x*(x - D);
+        double dpsi = s*deltaF + b*(2.0*x*deltaF + deltaF*deltaF - D*deltaF);
+        double ddpsi = 2.0*b*deltaF*deltaF;
+
+        /* Loop variables: the phasor, its rotation per bin, and the change in rotation per bin */
+        double re = cos(psi), im = sin(psi);
+        double rre = cos(dpsi), rim = sin(dpsi);
+        const double qre = cos(ddpsi), qim = sin(ddpsi);
+        double a = startamp + (endamp - startamp)/D*x;
+        const double damp = (endamp - startamp)/D*deltaF;
+
+        for (double f = j*deltaF; f < endf && j < length; j++, f += deltaF) {
+            d[j] = a * (re + I*im);
+            double newRe = re*rre - im*rim, newIm = re*rim + im*rre;
+            re = newRe, im = newIm;
+            newRe = rre*qre - rim*qim, newIm = rre*qim + rim*qre;
+            rre = newRe, rim = newIm;
+            a += damp;
+        }
+    }
+    memset(&(d[j]), 0, sizeof(d[j])*(length - j));
+
+    XLALFree(slope);
+    return XLAL_SUCCESS;
+}
@@ -9,8 +9,53 @@
 #ifndef _LALInferenceFVectorMultiBanding_Flat_h
 #define _LALInferenceFVectorMultiBanding_Flat_h
 
+#include <lal/LALDatatypes.h>
+
 /** Create a list of frequencies to use in multiband template generation, between f_min and f_max
  mc is minimum allowable chirp mass (sets freq evolution assumption ) */
 REAL8Sequence *LALInferenceMultibandFrequencies(int NBands, double f_min, double f_max, double deltaF0, double mc);
 
+#ifndef SWIG   /* exclude from SWIG interface */
+
+/** Cache of multiband frequency grids adapted to the waveform, one for each region of chirp mass and
+ mass ratio visited */
+typedef struct tagLALInferenceMultibandCache
+{
+    REAL8Sequence *probe_frequencies; /** Conservative grid from LALInferenceMultibandFrequencies on which to generate probe waveforms */
+    UINT4 mmax; /** Largest azimuthal mode number in the waveform */
+    UINT4 n_grids; /** Number of cached grids */
+    INT4 *mc_bins; /** Chirp mass region of each grid */
+    INT4 *q_bins; /** Mass ratio region of each grid */
+    REAL8Sequence **grids; /** The cached grids */
+} LALInferenceMultibandCache;
+
+/** Create a list of frequencies to use in multiband template generation, between f_min and f_max,
+ from a probe waveform h given at the frequencies of a conservative grid (from LALInferenceMultibandFrequencies).
+ The time to merger at each frequency is taken from the phase derivative of h, and for waveforms with modes
+ up to azimuthal number mmax the time at which the frequency is first reached by any mode is used. */
+REAL8Sequence *LALInferenceMultibandFrequenciesFromWaveform(const REAL8Sequence *frequencies, const COMPLEX16 *h,
+                                                            double f_min, double f_max, double deltaF0, UINT4 mmax);
+
+/** Create a cache of multiband grids, taking ownership of the conservative grid probe_frequencies */
+LALInferenceMultibandCache *LALInferenceCreateMultibandCache(REAL8Sequence *probe_frequencies, UINT4 mmax);
+
+/** Free a cache of multiband grids */
+void LALInferenceDestroyMultibandCache(LALInferenceMultibandCache *cache);
+
+/** Find the cached grid for the region containing chirp mass mc and mass ratio q (m2/m1 <= 1), returning NULL
+ if there is none yet. The chirp mass and mass ratio at which to probe the waveform for the region, its most
+ slowly evolving corner, are returned in mc_probe and q_probe. */
+REAL8Sequence *LALInferenceMultibandCacheLookup(const LALInferenceMultibandCache *cache, double mc, double q,
+                                                double *mc_probe, double *q_probe);
+
+/** Add the grid for the region containing chirp mass mc and mass ratio q to the cache, which takes ownership of it */
+int LALInferenceMultibandCacheAdd(LALInferenceMultibandCache *cache, double mc, double q, REAL8Sequence *grid);
+
+/** Interpolate a waveform src given at the multiband frequencies onto the frequency grid of dest, linearly in
+ amplitude and quadratically in phase. Frequencies of dest outside the multiband frequencies are set to zero. */
+int LALInferenceMultibandInterpolate(const REAL8Sequence *frequencies, const COMPLEX16FrequencySeries *src,
+                                     COMPLEX16FrequencySeries *dest);
+
+#endif /* SWIG */
+
 #endif
@@ -27,6 +27,10 @@
 
 #include "logaddexp.h"
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 #define PROGRAM_NAME "LALInferenceNestedSampler.c"
 #define CVS_ID_STRING "$Id$"
 #define CVS_REVISION "$Revision$"
@@ -313,6 +317,50 @@ static double logsubexp(double a, double b)
 
 static void SetupEigenProposals(LALInferenceRunState *runState);
 
+/* Samplers acting on one thread, with its own algorithm parameters and random
+ * number generator, so that several live points can be replaced at once */
+static UINT4 SamplePriorThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState,
+                               LALInferenceVariables *algorithmParams, gsl_rng *rng);
+static INT4 SloppySampleThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState,
+                               LALInferenceVariables *algorithmParams, gsl_rng *rng);
+
+/* Algorithm parameters each thread keeps a copy of */
+static const char *threadAlgorithmParams[]={"logLmin","Nmcmc","sloppyfraction","accept_rate","sub_accept_rate","logZnoise"};
+#define N_THREAD_ALGORITHM_PARAMS (sizeof(threadAlgorithmParams)/sizeof(threadAlgorithmParams[0]))
+
+static void copyThreadAlgorithmParams(LALInferenceVariables *from, LALInferenceVariables *to);
+static void copyThreadAlgorithmParams(LALInferenceVariables *from, LALInferenceVariables *to)
+{
+  for(UINT4 i=0;i<N_THREAD_ALGORITHM_PARAMS;i++)
+    if(LALInferenceCheckVariable(from,threadAlgorithmParams[i]))
+      LALInferenceAddVariable(to,threadAlgorithmParams[i],LALInferenceGetVariable(from,threadAlgorithmParams[i]),
+                              LALInferenceGetVariableType(from,threadAlgorithmParams[i]),
+                              LALInferenceGetVariableVaryType(from,threadAlgorithmParams[i]));
+}
+
+/* Is j one of the n entries of list */
+static int indexInList(UINT4 j, const UINT4 *list, UINT4 n);
+static int indexInList(UINT4 j, const UINT4 *list, UINT4 n)
+{
+  for(UINT4 i=0;i<n;i++) if(list[i]==j) return 1;
+  return 0;
+}
+
+/* Indices of the N lowest of the Nlive likelihoods, in increasing order */
+static void findLowestLikelihoods(const REAL8 *logLikelihoods, UINT4 Nlive, UINT4 *idx, UINT4 N);
+static void findLowestLikelihoods(const REAL8 *logLikelihoods, UINT4 Nlive, UINT4 *idx, UINT4 N)
+{
+  UINT4 n=0;
+  for(UINT4 i=0;i<Nlive;i++)
+  {
+    UINT4 k;
+    if(n==N && !(logLikelihoods[i]<logLikelihoods[idx[N-1]])) continue;
+    k = n<N ? n++ : N-1;
+    for(;k>0 && logLikelihoods[i]<logLikelihoods[idx[k-1]];k--) idx[k]=idx[k-1];
+    idx[k]=i;
+  }
+}
+
 /**
  * Update the internal state of the integrator after receiving the lowest logL
  * value logL
@@ -435,9 +483,9 @@ static UINT4 UpdateNMCMC(LALInferenceRunState *runState){
         }
         LALInferenceSetVariable(runState->algorithmParams,"Nmcmc",&max);
     }
-    /* Single threaded here */
     if (LALInferenceGetProcParamVal(runState->commandLine,"--proposal-kde"))
-        LALInferenceSetupClusteredKDEProposalFromDEBuffer(&runState->threads[0]);
+        for(INT4 t=0;t<runState->nthreads;t++)
+            LALInferenceSetupClusteredKDEProposalFromDEBuffer(&runState->threads[t]);
     return(max);
 }
 
@@ -586,6 +634,8 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
     (--sloppyratio S)                Number of sub-samples of the prior for every sample from the\n\
                                      limited prior\n\
     (--Nruns R)                      Number of parallel samples from logt to use(1)\n\
+    (--Nthreads K)                   Replace the K lowest likelihood live points at once, on K OpenMP\n\
+                                     threads (1)\n\
     (--tolerance dZ)                 Tolerance of nested sampling algorithm (0.1)\n\
     (--randomseed seed)              Random seed of sampling distribution\n\
     (--prior )                       Set the prior to use (InspiralNormalised,SkyLoc,malmquist)\n\
@@ -640,15 +690,13 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
   INT4 tmpi=0;
   REAL8 tmp=0;
 
-  /* Single thread only */
-  LALInferenceThreadState *threadState = &runState->threads[0];
-
   /* Set up the appropriate functions for the nested sampling algorithm */
   runState->algorithm=&LALInferenceNestedSamplingAlgorithm;
   runState->evolve=&LALInferenceNestedSamplingOneStep;
 
   /* use the ptmcmc proposal to sample prior */
-  threadState->proposal=&LALInferenceCyclicProposal;
+  for(INT4 t=0;t<runState->nthreads;t++)
+    runState->threads[t].proposal=&LALInferenceCyclicProposal;
   REAL8 temp=1.0;
   LALInferenceAddVariable(runState->proposalArgs,"temperature",&temp,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_FIXED);
 
@@ -834,9 +882,11 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   SetupEigenProposals(runState);
 
   /* Use the live points as differential evolution points */
-  /* Single thread here */
-  syncLivePointsDifferentialPoints(runState,threadState);
-  threadState->differentialPointsSkip=1;
+  for(INT4 t=0;t<runState->nthreads;t++)
+  {
+    syncLivePointsDifferentialPoints(runState,&runState->threads[t]);
+    runState->threads[t].differentialPointsSkip=1;
+  }
 
   if(!LALInferenceCheckVariable(runState->algorithmParams,"Nmcmc")){
     INT4 tmp=MAX_MCMC;
@@ -943,43 +993,127 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   {
       install_resume_handler(CondorExitCode);
   }
+  /* Each thread keeps its own sampler state when replacing points in parallel */
+  UINT4 Nparallel = runState->nthreads>1 ? (UINT4) runState->nthreads : 1;
+  UINT4 *minposes=NULL,*starts=NULL;
+  if(Nparallel>1)
+  {
+    if(2*Nparallel>Nlive)
+    {
+      fprintf(stderr,"Error: cannot replace %u of %u live points in parallel\n",Nparallel,Nlive);
+      exit(1);
+    }
+    minposes=XLALCalloc(Nparallel,sizeof(UINT4));
+    starts=XLALCalloc(Nparallel,sizeof(UINT4));
+    for(INT4 t=0;t<runState->nthreads;t++)
+      copyThreadAlgorithmParams(runState->algorithmParams,runState->threads[t].algorithmParams);
+  }
   /* Iterate until termination condition is met */
   do {
-    /* Find minimum likelihood sample to replace */
-    minpos=0;
-    for(i=1;i<Nlive;i++){
-      if(logLikelihoods[i]<logLikelihoods[minpos])
-	minpos=i;
+    UINT4 itercounter=0,Nreplaced=1;
+    REAL8 logLnew;
+    if(Nparallel==1)
+    {
+      /* Find minimum likelihood sample to replace */
+      minpos=0;
+      for(i=1;i<Nlive;i++){
+        if(logLikelihoods[i]<logLikelihoods[minpos])
+          minpos=i;
+      }
+      logLmin=logLikelihoods[minpos];
+      if(samplePrior) logLmin=-INFINITY;
+
+      logZnew=incrementEvidenceSamples(runState->GSLrandom, Nlive, logLikelihoods[minpos], s);
+      //deltaZ=logZnew-logZ; - set but not used
+      H=mean(Harray,Nruns);
+      logZ=logZnew;
+      if(runState->logsample) runState->logsample(runState->algorithmParams,runState->livePoints[minpos]);
+
+      /* Generate a new live point */
+      do{ /* This loop is here in case it is necessary to find a different sample */
+        /* Clone an old live point and evolve it */
+        while((j=gsl_rng_uniform_int(runState->GSLrandom,Nlive))==minpos){};
+        LALInferenceCopyVariables(runState->livePoints[j],threadState->currentParams);
+        threadState->currentLikelihood = logLikelihoods[j];
+        LALInferenceSetVariable(runState->algorithmParams,"logLmin",(void *)&logLmin);
+        runState->evolve(runState);
+        itercounter++;
+      }while( threadState->currentLikelihood<=logLmin ||  *(REAL8*)LALInferenceGetVariable(runState->algorithmParams,"accept_rate")==0.0);
+
+      LALInferenceCopyVariables(threadState->currentParams,runState->livePoints[minpos]);
+      logLikelihoods[minpos]=threadState->currentLikelihood;
+
+      if (threadState->currentLikelihood>logLmax)
+        logLmax=threadState->currentLikelihood;
+
+      logw=mean(logwarray,Nruns);
+      LALInferenceAddVariable(runState->livePoints[minpos],"logw",&logw,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
+      logLnew=threadState->currentLikelihood;
+    }
+    else
+    {
+      /* Remove the Nparallel lowest points in turn, each with one fewer live
+       * point, and replace all of them above the highest of them */
+      REAL8 accept_rate=0,sub_accept_rate=0,sloppyfraction=0;
+      findLowestLikelihoods(logLikelihoods,Nlive,minposes,Nparallel);
+      for(i=0;i<Nparallel;i++)
+      {
+        logZnew=incrementEvidenceSamples(runState->GSLrandom, Nlive-i, logLikelihoods[minposes[i]], s);
+        if(runState->logsample) runState->logsample(runState->algorithmParams,runState->livePoints[minposes[i]]);
+      }
+      H=mean(Harray,Nruns);
+      logZ=logZnew;
+      logLmin=logLikelihoods[minposes[Nparallel-1]];
+      if(samplePrior) logLmin=-INFINITY;
+
+      /* Clone distinct surviving live points */
+      for(i=0;i<Nparallel;i++)
+      {
+        do j=gsl_rng_uniform_int(runState->GSLrandom,Nlive);
+        while(indexInList(j,minposes,Nparallel) || indexInList(j,starts,i));
+        starts[i]=j;
+        LALInferenceThreadState *thread=&runState->threads[i];
+        LALInferenceSetVariable(thread->algorithmParams,"logLmin",&logLmin);
+        LALInferenceSetVariable(thread->algorithmParams,"Nmcmc",LALInferenceGetVariable(runState->algorithmParams,"Nmcmc"));
+      }
+
+      /* and evolve them concurrently, the live points are only read here */
+      #pragma omp parallel for schedule(dynamic,1) num_threads(Nparallel)
+      for(INT4 t=0;t<(INT4)Nparallel;t++)
+      {
+        LALInferenceThreadState *thread=&runState->threads[t];
+        UINT4 start=starts[t];
+        do{
+          LALInferenceCopyVariables(runState->livePoints[start],thread->currentParams);
+          thread->currentLikelihood=logLikelihoods[start];
+          SloppySampleThread(runState,thread,thread->algorithmParams,thread->GSLrandom);
+          /* try a different point if this one got stuck */
+          do start=gsl_rng_uniform_int(thread->GSLrandom,Nlive);
+          while(indexInList(start,minposes,Nparallel));
+        }while( thread->currentLikelihood<=logLmin || *(REAL8*)LALInferenceGetVariable(thread->algorithmParams,"accept_rate")==0.0);
+      }
+
+      logLnew=INFINITY;
+      logw=mean(logwarray,Nruns);
+      for(i=0;i<Nparallel;i++)
+      {
+        LALInferenceThreadState *thread=&runState->threads[i];
+        LALInferenceCopyVariables(thread->currentParams,runState->livePoints[minposes[i]]);
+        logLikelihoods[minposes[i]]=thread->currentLikelihood;
+        LALInferenceAddVariable(runState->livePoints[minposes[i]],"logw",&logw,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
+        if(thread->currentLikelihood>logLmax) logLmax=thread->currentLikelihood;
+        if(thread->currentLikelihood<logLnew) logLnew=thread->currentLikelihood;
+        accept_rate+=LALInferenceGetREAL8Variable(thread->algorithmParams,"accept_rate")/Nparallel;
+        sub_accept_rate+=LALInferenceGetREAL8Variable(thread->algorithmParams,"sub_accept_rate")/Nparallel;
+        sloppyfraction+=LALInferenceGetREAL8Variable(thread->algorithmParams,"sloppyfraction")/Nparallel;
+      }
+      LALInferenceSetVariable(runState->algorithmParams,"logLmin",&logLmin);
+      LALInferenceSetVariable(runState->algorithmParams,"accept_rate",&accept_rate);
+      LALInferenceSetVariable(runState->algorithmParams,"sub_accept_rate",&sub_accept_rate);
+      LALInferenceSetVariable(runState->algorithmParams,"sloppyfraction",&sloppyfraction);
+      itercounter=1;
+      Nreplaced=Nparallel;
     }
-    logLmin=logLikelihoods[minpos];
-    if(samplePrior) logLmin=-INFINITY;
-
-    logZnew=incrementEvidenceSamples(runState->GSLrandom, Nlive, logLikelihoods[minpos], s);
-    //deltaZ=logZnew-logZ; - set but not used
-    H=mean(Harray,Nruns);
-    logZ=logZnew;
-    if(runState->logsample) runState->logsample(runState->algorithmParams,runState->livePoints[minpos]);
-    UINT4 itercounter=0;
-
-    /* Generate a new live point */
-    do{ /* This loop is here in case it is necessary to find a different sample */
-      /* Clone an old live point and evolve it */
-      while((j=gsl_rng_uniform_int(runState->GSLrandom,Nlive))==minpos){};
-      LALInferenceCopyVariables(runState->livePoints[j],threadState->currentParams);
-      threadState->currentLikelihood = logLikelihoods[j];
-      LALInferenceSetVariable(runState->algorithmParams,"logLmin",(void *)&logLmin);
-      runState->evolve(runState);
-      itercounter++;
-    }while( threadState->currentLikelihood<=logLmin ||  *(REAL8*)LALInferenceGetVariable(runState->algorithmParams,"accept_rate")==0.0);
-
-    LALInferenceCopyVariables(threadState->currentParams,runState->livePoints[minpos]);
-    logLikelihoods[minpos]=threadState->currentLikelihood;
-
-  if (threadState->currentLikelihood>logLmax)
-    logLmax=threadState->currentLikelihood;
-
-  logw=mean(logwarray,Nruns);
-  LALInferenceAddVariable(runState->livePoints[minpos],"logw",&logw,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
   dZ=logaddexp(logZ,logLmax-((double) iter)/((double)Nlive))-logZ;
   sloppyfrac=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction");
   if(displayprogress) fprintf(stderr,"%i: accpt: %1.3f Nmcmc: %i sub_accpt: %1.3f slpy: %2.1f%% H: %3.2lf nats logL:%.3lf ->%.3lf logZ: %.3lf deltalogLmax: %.2lf dZ: %.3lf Zratio: %.3lf \n",\
@@ -990,13 +1124,13 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     100.0*sloppyfrac,\
     H,\
     logLmin,\
-    threadState->currentLikelihood,\
+    logLnew,\
     logZ,\
     (logLmax - LALInferenceGetREAL8Variable(runState->algorithmParams,"logZnoise")), \
     dZ,\
     ( logZ - LALInferenceGetREAL8Variable(runState->algorithmParams,"logZnoise"))\
   );
-  iter++;
+  iter+=Nreplaced;
 
   /* Save progress */
   if(__ns_saveStateFlag!=0)
@@ -1012,7 +1146,7 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   }
 
   /* Update the proposal */
-  if(!(iter%(Nlive/10))) {
+  if(iter/(Nlive/10)!=(iter-Nreplaced)/(Nlive/10)) {
     /* Update the covariance matrix */
     if ( LALInferenceCheckVariable( threadState->proposalArgs,"covarianceMatrix" ) ){
       SetupEigenProposals(runState);
@@ -1022,7 +1156,8 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     UpdateNMCMC(runState);
 
     /* Sync the live points to differential points */
-    syncLivePointsDifferentialPoints(runState,threadState);
+    for(INT4 t=0;t<runState->nthreads;t++)
+      syncLivePointsDifferentialPoints(runState,&runState->threads[t]);
 
     /* Output some information */
     if(verbose){
@@ -1035,6 +1170,8 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
 
   }
   while(samplePrior?((Nlive+iter)<samplePrior):( iter <= Nlive ||  dZ> TOLERANCE)); /* End of NS loop! */
+  XLALFree(minposes);
+  XLALFree(starts);
 
   /* Sort the remaining points (not essential, just nice)*/
   for(i=0;i<Nlive-1;i++){
@@ -1338,7 +1475,12 @@ LALInferenceVariables *LALInferenceComputeAutoCorrelation(LALInferenceRunState *
 UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
 {
     /* Single threaded here */
-    LALInferenceThreadState * threadState=&runState->threads[0];
+    return SamplePriorThread(runState,&runState->threads[0],runState->algorithmParams,runState->GSLrandom);
+}
+
+static UINT4 SamplePriorThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState,
+                               LALInferenceVariables *algorithmParams, gsl_rng *rng)
+{
     UINT4 outOfBounds=0;
     UINT4 adaptProp=0;
     //LALInferenceVariables tempParams;
@@ -1346,7 +1488,7 @@ UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
     //LALInferenceVariables *oldParams=&tempParams;
     LALInferenceVariables proposedParams;
     memset(&proposedParams,0,sizeof(proposedParams));
-    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logLmin");
+    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(algorithmParams,"logLmin");
     REAL8 thislogL=-INFINITY;
     UINT4 accepted=0;
 
@@ -1360,7 +1502,7 @@ UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
 
     logProposalRatio = threadState->proposal(threadState,threadState->currentParams,&proposedParams);
     REAL8 logPriorNew=runState->prior(runState, &proposedParams, threadState->model);
-    if(isinf(logPriorNew) || isnan(logPriorNew) || log(gsl_rng_uniform(runState->GSLrandom)) > (logPriorNew-logPriorOld) + logProposalRatio)
+    if(isinf(logPriorNew) || isnan(logPriorNew) || log(gsl_rng_uniform(rng)) > (logPriorNew-logPriorOld) + logProposalRatio)
     {
 	/* Reject - don't need to copy new params back to currentParams */
         /*LALInferenceCopyVariables(oldParams,runState->currentParams); */
@@ -1484,9 +1626,14 @@ INT4 LALInferenceNestedSamplingCachedSampler(LALInferenceRunState *runState)
 
 INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
 {
-    LALInferenceVariables oldParams;
     /* Single thread here */
-    LALInferenceThreadState *threadState = &runState->threads[0];
+    return SloppySampleThread(runState,&runState->threads[0],runState->algorithmParams,runState->GSLrandom);
+}
+
+static INT4 SloppySampleThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState,
+                               LALInferenceVariables *algorithmParams, gsl_rng *rng)
+{
+    LALInferenceVariables oldParams;
     LALInferenceIFOData *data=runState->data;
     REAL8 tmp;
     REAL8 Target=0.3;
@@ -1494,14 +1641,14 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
     REAL8 logLold=*(REAL8 *)LALInferenceGetVariable(threadState->currentParams,"logL");
     memset(&oldParams,0,sizeof(oldParams));
     LALInferenceCopyVariables(threadState->currentParams,&oldParams);
-    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logLmin");
-    UINT4 Nmcmc=*(UINT4 *)LALInferenceGetVariable(runState->algorithmParams,"Nmcmc");
+    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(algorithmParams,"logLmin");
+    UINT4 Nmcmc=*(UINT4 *)LALInferenceGetVariable(algorithmParams,"Nmcmc");
     REAL8 maxsloppyfraction=((REAL8)Nmcmc-1)/(REAL8)Nmcmc ;
     REAL8 sloppyfraction=maxsloppyfraction/2.0;
     REAL8 minsloppyfraction=0.;
     if(Nmcmc==1) maxsloppyfraction=minsloppyfraction=0.0;
-    if (LALInferenceCheckVariable(runState->algorithmParams,"sloppyfraction"))
-      sloppyfraction=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction");
+    if (LALInferenceCheckVariable(algorithmParams,"sloppyfraction"))
+      sloppyfraction=*(REAL8 *)LALInferenceGetVariable(algorithmParams,"sloppyfraction");
     UINT4 mcmc_iter=0,Naccepted=0,sub_accepted=0;
     UINT4 sloppynumber=(UINT4) (sloppyfraction*(REAL8)Nmcmc);
     UINT4 testnumber=Nmcmc-sloppynumber;
@@ -1527,7 +1674,7 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
         /* Draw an independent sample from the prior */
         do{
 
-            sub_accepted+=LALInferenceMCMCSamplePrior(runState);
+            sub_accepted+=SamplePriorThread(runState,threadState,algorithmParams,rng);
             subchain_length++;
             counter+=(1.-sloppyfraction);
         }while(counter<1);
@@ -1549,8 +1696,8 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
             Naccepted++;
             /* Update information to pass back out */
             LALInferenceAddVariable(threadState->currentParams,"logL",(void *)&logLnew,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
-            if(LALInferenceCheckVariable(runState->algorithmParams,"logZnoise")){
-               tmp=logLnew-*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logZnoise");
+            if(LALInferenceCheckVariable(algorithmParams,"logZnoise")){
+               tmp=logLnew-*(REAL8 *)LALInferenceGetVariable(algorithmParams,"logZnoise");
                LALInferenceAddVariable(threadState->currentParams,"deltalogL",(void *)&tmp,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
             }
             ifo=0;
@@ -1580,8 +1727,8 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
             logLnew=runState->likelihood(threadState->currentParams,runState->data,threadState->model);
             threadState->currentLikelihood=logLnew;
             LALInferenceAddVariable(threadState->currentParams,"logL",(void *)&logLnew,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
-            if(LALInferenceCheckVariable(runState->algorithmParams,"logZnoise")){
-               tmp=logLnew-*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logZnoise");
+            if(LALInferenceCheckVariable(algorithmParams,"logZnoise")){
+               tmp=logLnew-*(REAL8 *)LALInferenceGetVariable(algorithmParams,"logZnoise");
                LALInferenceAddVariable(threadState->currentParams,"deltalogL",(void *)&tmp,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
             }
             ifo=0;
@@ -1599,8 +1746,8 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
     /* Compute some statistics for information */
     REAL8 sub_accept_rate=(REAL8)sub_accepted/(REAL8)sub_iter;
     REAL8 accept_rate=(REAL8)Naccepted/(REAL8)testnumber;
-    LALInferenceSetVariable(runState->algorithmParams,"accept_rate",&accept_rate);
-    LALInferenceSetVariable(runState->algorithmParams,"sub_accept_rate",&sub_accept_rate);
+    LALInferenceSetVariable(algorithmParams,"accept_rate",&accept_rate);
+    LALInferenceSetVariable(algorithmParams,"sub_accept_rate",&sub_accept_rate);
     /* Adapt the sloppy fraction toward target acceptance of outer chain */
     if(isfinite(logLmin)){
         if((REAL8)accept_rate>Target) { sloppyfraction+=5.0/(REAL8)Nmcmc;}
@@ -1608,7 +1755,7 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
         if(sloppyfraction>maxsloppyfraction) sloppyfraction=maxsloppyfraction;
 	if(sloppyfraction<minsloppyfraction) sloppyfraction=minsloppyfraction;
 
-	LALInferenceSetVariable(runState->algorithmParams,"sloppyfraction",&sloppyfraction);
+	LALInferenceSetVariable(algorithmParams,"sloppyfraction",&sloppyfraction);
     }
     /* Cleanup */
     LALInferenceClearVariables(&oldParams);
@@ -1676,10 +1823,16 @@ void LALInferenceSetupLivePointsArray(LALInferenceRunState *runState){
 }
 
 
+static void SetupEigenProposalsThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState);
+
 static void SetupEigenProposals(LALInferenceRunState *runState)
 {
-  /* Single thread here */
-  LALInferenceThreadState *threadState = &runState->threads[0];
+  for(INT4 t=0;t<runState->nthreads;t++)
+    SetupEigenProposalsThread(runState,&runState->threads[t]);
+}
+
+static void SetupEigenProposalsThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState)
+{
   gsl_matrix *eVectors=NULL;
   gsl_vector *eValues =NULL;
   REAL8Vector *eigenValues=NULL;
@@ -1742,6 +1895,12 @@ static int syncLivePointsDifferentialPoints(LALInferenceRunState *state, LALInfe
 {
     INT4 N = LALInferenceGetINT4Variable(state->algorithmParams,"Nlive");
     if(!thread->differentialPoints) thread->differentialPoints=XLALCalloc(N,sizeof(LALInferenceVariables *));
+    else if(thread->differentialPoints!=state->livePoints && thread->differentialPointsSize<(size_t)N)
+    {
+        thread->differentialPoints=XLALRealloc(thread->differentialPoints,N*sizeof(LALInferenceVariables *));
+        for(INT4 i=thread->differentialPointsSize;i<N;i++) thread->differentialPoints[i]=NULL;
+        thread->differentialPointsSize=N;
+    }
 
     for(INT4 i=0;i<N;i++)
     {
@@ -62,6 +62,12 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState);
 /**
  * NestedSamplingAlgorithm implements the nested sampling algorithm,
  * see e.g. Sivia "Data Analysis: A Bayesian Tutorial, 2nd edition
+ *
+ * With more than one thread in runState, the runState->nthreads lowest
+ * likelihood points are removed together, each counted with one fewer live
+ * point than the one before, and replaced concurrently by evolving distinct
+ * surviving points on their own threads, each with its own random number
+ * generator, proposal cycle and copy of the sampler parameters.
  */
 void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState);
 
@@ -32,6 +32,10 @@
 
 #include "logaddexp.h"
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 #ifdef __GNUC__
 #define UNUSED __attribute__ ((unused))
 #else
@@ -438,12 +442,460 @@ static REAL8 LALInferencePSDPrior(LALInferenceRunState *runState, LALInferenceVa
 }
 
 
-/* Return the log Prior of the variables specified, for the non-spinning/spinning inspiral signal case */
-REAL8 LALInferenceInspiralPrior(LALInferenceRunState *runState, LALInferenceVariables *params, LALInferenceModel *model)
+/*
+ * Compiled prior.
+ *
+ * Looking up a parameter's bounds in priorArgs costs a string formatting
+ * and two hash lookups, and LALInferenceInspiralPrior() does several of
+ * these for every sampled parameter on every call.  As the layout of the
+ * sampled parameters and of priorArgs rarely changes during a run, the
+ * lookups are resolved once into a flat table holding, for each entry of
+ * the parameter list in order, pointers to the values of its bounds and
+ * its role in the inspiral prior.  Each call then only checks that the
+ * layouts still match the table and walks the list once.
+ *
+ * Pointers into priorArgs are to the values of its items, so changing the
+ * prior ranges in place is picked up.  Adding or removing items changes
+ * the layout and a new table is compiled; the superseded tables are kept
+ * until LALInferenceDestroyCompiledPrior() as concurrent chains may still
+ * be reading them.  Anything the table cannot represent falls back to the
+ * generic code.
+ */
+
+/* Maximum number of layouts compiled for a single priorArgs cache */
+#define COMPILED_PRIOR_MAX_LAYOUTS 8
+
+typedef enum {
+  PRIOR_ROLE_NONE = 0,
+  PRIOR_ROLE_SIGNAL_FLAG,
+  PRIOR_ROLE_FLOW,
+  PRIOR_ROLE_LOGDISTANCE,
+  PRIOR_ROLE_DISTANCE,
+  PRIOR_ROLE_DECLINATION,
+  PRIOR_ROLE_LOGMC,
+  PRIOR_ROLE_CHIRPMASS,
+  PRIOR_ROLE_Q,
+  PRIOR_ROLE_ETA,
+  PRIOR_ROLE_TILT1,
+  PRIOR_ROLE_TILT2,
+  PRIOR_ROLE_A1,
+  PRIOR_ROLE_A2,
+  PRIOR_ROLE_LOGP1,
+  PRIOR_ROLE_GAMMA1,
+  PRIOR_ROLE_GAMMA2,
+  PRIOR_ROLE_GAMMA3,
+  PRIOR_ROLE_SDGAMMA0,
+  PRIOR_ROLE_SDGAMMA1,
+  PRIOR_ROLE_SDGAMMA2,
+  PRIOR_ROLE_SDGAMMA3,
+  PRIOR_NROLES
+} CompiledPriorRole;
+
+static const char *compiled_prior_role_names[PRIOR_NROLES] = {
+  NULL, "signalModelFlag", "flow", "logdistance", "distance", "declination",
+  "logmc", "chirpmass", "q", "eta", "tilt_spin1", "tilt_spin2", "a_spin1", "a_spin2",
+  "logp1", "gamma1", "gamma2", "gamma3", "SDgamma0", "SDgamma1", "SDgamma2", "SDgamma3"
+};
+
+typedef struct {
+  char name[VARNAME_MAX];
+  LALInferenceVariableType type;
+  LALInferenceParamVaryType vary;
+  CompiledPriorRole role;
+  const REAL8 *min, *max;     /* uniform prior range, or NULL */
+  const REAL8 *mean, *sigma;  /* Gaussian prior, or NULL */
+} CompiledPriorParam;
+
+struct tagLALInferenceCompiledPrior {
+  const LALInferenceVariables *priorArgs;
+  INT4 nprior;                          /* layout of priorArgs when compiled */
+  LALInferenceVariableItem **priorItems;
+  char priorHead[VARNAME_MAX];
+  INT4 nparams;                         /* layout of the parameters */
+  CompiledPriorParam *params;
+  INT4 inspiral;                        /* constants below could be resolved */
+  const INT4 *uniform_distance, *src_comove_volume_distance;
+  const REAL8 *mass1_min, *mass1_max, *mass2_min, *mass2_max;
+  const REAL8 *MTotMax, *MTotMin;
+  const UINT4 *malmquist;
+  INT4 volumetric_spins, projected_aligned_spin;
+  const REAL8 *a_spin_min[2], *a_spin_max[2];
+  struct tagLALInferenceCompiledPrior *next;
+};
+
+static const REAL8 *compiled_prior_value(LALInferenceVariables *priorArgs, const char *name, const char *suffix)
 {
-  if (runState == NULL || runState->priorArgs == NULL || params == NULL)
-    XLAL_ERROR_REAL8(XLAL_EFAULT, "Null arguments received.");
+  char varname[VARNAME_MAX+16];
+  LALInferenceVariableItem *item;
+  snprintf(varname, sizeof(varname), "%s%s", name, suffix);
+  item = LALInferenceGetItem(priorArgs, varname);
+  return item ? (const REAL8 *)item->value : NULL;
+}
+
+/* Check the type of an optional priorArgs entry used through a typed getter */
+static INT4 compiled_prior_typed(LALInferenceVariables *priorArgs, const char *name, LALInferenceVariableType type, const void **value)
+{
+  LALInferenceVariableItem *item = LALInferenceGetItem(priorArgs, name);
+  *value = item ? item->value : NULL;
+  return !item || item->type == type;
+}
+
+static LALInferenceCompiledPrior *compiled_prior_create(LALInferenceVariables *priorArgs, LALInferenceVariables *params)
+{
+  LALInferenceCompiledPrior *cp;
+  LALInferenceVariableItem *item;
+  CompiledPriorParam *p;
+  INT4 i, r, role_type[PRIOR_NROLES];
+  const void *value;
+
+  cp = XLALCalloc(1, sizeof(*cp));
+  if (!cp)
+    return NULL;
+  cp->priorArgs = priorArgs;
+  cp->nprior = priorArgs->dimension;
+  cp->nparams = params->dimension;
+  cp->priorItems = XLALCalloc(cp->nprior > 0 ? cp->nprior : 1, sizeof(*cp->priorItems));
+  cp->params = XLALCalloc(cp->nparams > 0 ? cp->nparams : 1, sizeof(*cp->params));
+  if (!cp->priorItems || !cp->params) {
+    LALInferenceDestroyCompiledPrior(cp);
+    return NULL;
+  }
+
+  for (i = 0, item = priorArgs->head; item && i < cp->nprior; item = item->next, i++)
+    cp->priorItems[i] = item;
+  if (item || i != cp->nprior) {
+    LALInferenceDestroyCompiledPrior(cp);
+    return NULL;
+  }
+  if (priorArgs->head)
+    strcpy(cp->priorHead, priorArgs->head->name);
+
+  for (r = 0; r < PRIOR_NROLES; r++)
+    role_type[r] = -1;
+  for (i = 0, item = params->head; item && i < cp->nparams; item = item->next, i++) {
+    p = &cp->params[i];
+    strcpy(p->name, item->name);
+    p->type = item->type;
+    p->vary = item->vary;
+    for (r = 1; r < PRIOR_NROLES; r++)
+      if (!strcmp(item->name, compiled_prior_role_names[r])) break;
+    p->role = r < PRIOR_NROLES ? (CompiledPriorRole)r : PRIOR_ROLE_NONE;
+    if (p->role)
+      role_type[p->role] = item->type;
+
+    p->min = compiled_prior_value(priorArgs, item->name, "_min");
+    p->max = compiled_prior_value(priorArgs, item->name, "_max");
+    if (!p->min || !p->max)
+      p->min = p->max = NULL;
+    p->mean = compiled_prior_value(priorArgs, item->name, "_gaussian_mean");
+    p->sigma = compiled_prior_value(priorArgs, item->name, "_gaussian_sigma");
+    if (!p->mean || !p->sigma)
+      p->mean = p->sigma = NULL;
+  }
+  if (item || i != cp->nparams) {
+    LALInferenceDestroyCompiledPrior(cp);
+    return NULL;
+  }
+
+  /* Constants of LALInferenceInspiralPrior.  Entries read through a typed
+   * getter must have that type, otherwise the generic code reports it */
+  cp->inspiral = 1;
+  cp->inspiral &= compiled_prior_typed(priorArgs, "uniform_distance", LALINFERENCE_INT4_t, &value);
+  cp->uniform_distance = value;
+  cp->inspiral &= compiled_prior_typed(priorArgs, "src_comove_volume_distance", LALINFERENCE_INT4_t, &value);
+  cp->src_comove_volume_distance = value;
+  cp->inspiral &= compiled_prior_typed(priorArgs, "mass1_min", LALINFERENCE_REAL8_t, &value);
+  cp->mass1_min = value;
+  cp->inspiral &= compiled_prior_typed(priorArgs, "mass1_max", LALINFERENCE_REAL8_t, &value);
+  cp->mass1_max = value;
+  cp->inspiral &= compiled_prior_typed(priorArgs, "mass2_min", LALINFERENCE_REAL8_t, &value);
+  cp->mass2_min = value;
+  cp->inspiral &= compiled_prior_typed(priorArgs, "mass2_max", LALINFERENCE_REAL8_t, &value);
+  cp->mass2_max = value;
+  cp->MTotMax = compiled_prior_value(priorArgs, "MTotMax", "");
+  cp->MTotMin = compiled_prior_value(priorArgs, "MTotMin", "");
+  cp->malmquist = (const UINT4 *)compiled_prior_value(priorArgs, "malmquist", "");
+  cp->volumetric_spins = LALInferenceCheckVariable(priorArgs, "volumetric_spin");
+  cp->projected_aligned_spin = LALInferenceCheckVariable(priorArgs, "projected_aligned_spin");
+
+  for (i = 0; i < 2; i++) {
+    const char *spin = i ? "a_spin2" : "a_spin1";
+    CompiledPriorRole tilt = i ? PRIOR_ROLE_TILT2 : PRIOR_ROLE_TILT1;
+    CompiledPriorRole a = i ? PRIOR_ROLE_A2 : PRIOR_ROLE_A1;
+    cp->a_spin_min[i] = compiled_prior_value(priorArgs, spin, "_min");
+    cp->a_spin_max[i] = compiled_prior_value(priorArgs, spin, "_max");
+    if (cp->volumetric_spins &&
+        (role_type[a] != LALINFERENCE_REAL8_t || !cp->a_spin_min[i] || !cp->a_spin_max[i]))
+      cp->inspiral = 0;
+    if (cp->projected_aligned_spin && role_type[a] >= 0 && role_type[tilt] < 0) {
+      LALInferenceVariableItem *min, *max;
+      char varname[VARNAME_MAX+4];
+      snprintf(varname, sizeof(varname), "%s_min", spin);
+      min = LALInferenceGetItem(priorArgs, varname);
+      snprintf(varname, sizeof(varname), "%s_max", spin);
+      max = LALInferenceGetItem(priorArgs, varname);
+      if (role_type[a] != LALINFERENCE_REAL8_t ||
+          !min || min->type != LALINFERENCE_REAL8_t || !max || max->type != LALINFERENCE_REAL8_t)
+        cp->inspiral = 0;
+    }
+  }
+
+  return cp;
+}
+
+void LALInferenceDestroyCompiledPrior(LALInferenceCompiledPrior *cp)
+{
+  while (cp) {
+    LALInferenceCompiledPrior *next = cp->next;
+    XLALFree(cp->priorItems);
+    XLALFree(cp->params);
+    XLALFree(cp);
+    cp = next;
+  }
+}
+
+static INT4 compiled_prior_matches(const LALInferenceCompiledPrior *cp, const LALInferenceVariables *priorArgs, const LALInferenceVariables *params)
+{
+  const LALInferenceVariableItem *item;
+  const CompiledPriorParam *p;
+  INT4 i;
+
+  if (cp->priorArgs != priorArgs || cp->nprior != priorArgs->dimension || cp->nparams != params->dimension)
+    return 0;
+  for (i = 0, item = priorArgs->head; item; item = item->next, i++)
+    if (i >= cp->nprior || cp->priorItems[i] != item)
+      return 0;
+  /* A removed and re-added head may reuse the same memory */
+  if (priorArgs->head && strcmp(priorArgs->head->name, cp->priorHead))
+    return 0;
+  for (p = cp->params, item = params->head; item; item = item->next, p++)
+    if (item->type != p->type || item->vary != p->vary || strcmp(item->name, p->name))
+      return 0;
+  return 1;
+}
+
+/* Find the table matching priorArgs and params in the cache, compiling a new one if needed */
+static const LALInferenceCompiledPrior *compiled_prior_lookup(LALInferenceCompiledPrior **cache, LALInferenceVariables *priorArgs, LALInferenceVariables *params)
+{
+  LALInferenceCompiledPrior *cp, *found = NULL;
+  INT4 n = 0;
+
+  if (!priorArgs || !params)
+    return NULL;
+
+  #pragma omp flush
+  for (cp = *cache; cp; cp = cp->next, n++)
+    if (compiled_prior_matches(cp, priorArgs, params))
+      return cp;
+  if (n >= COMPILED_PRIOR_MAX_LAYOUTS)
+    return NULL;
+
+  #pragma omp critical (LALInferenceCompiledPrior)
+  {
+    /* Another chain may have compiled the same layout meanwhile */
+    for (cp = *cache; cp; cp = cp->next)
+      if (compiled_prior_matches(cp, priorArgs, params)) {
+        found = cp;
+        break;
+      }
+    if (!found) {
+      found = compiled_prior_create(priorArgs, params);
+      if (found) {
+        found->next = *cache;
+        *cache = found;
+      }
+    }
+  }
+  return found;
+}
+
+static REAL8 compiled_inspiral_prior(const LALInferenceCompiledPrior *cp, LALInferenceRunState *runState, LALInferenceVariables *params, LALInferenceModel *model)
+{
+  LALInferenceVariableItem *role[PRIOR_NROLES] = {NULL};
+  LALInferenceVariableItem *item;
+  const CompiledPriorParam *p;
+  REAL8 logPrior=0.0;
+  REAL8 mc=0.0;
+  REAL8 m1=0.0,m2=0.0,q=0.0,eta=0.0;
+  REAL8 c0=1.012306, c1=1.136740, c2=0.262462, c3=0.016732, c4=0.000387; /* fitting coefficients for Will's cosmological distance prior, see https://git.ligo.org/RatesAndPopulations/lalinfsamplereweighting/blob/master/ApproxPrior.ipynb */
+  INT4 outside=0, i;
+
+  /* Check boundaries for signal model parameters, noting the parameters
+   * used below on the way */
+  for(item=params->head, p=cp->params; item; item=item->next, p++)
+  {
+    role[p->role]=item;
+    if(outside || p->vary==LALINFERENCE_PARAM_FIXED || p->vary==LALINFERENCE_PARAM_OUTPUT)
+      continue;
+    else if (p->min)
+    {
+      if(p->type==LALINFERENCE_REAL8_t)
+        if(*(REAL8 *) item->value < *p->min || *(REAL8 *)item->value > *p->max) outside=1;
+    }
+    else if (p->mean)
+    {
+      if(p->type==LALINFERENCE_REAL8_t){
+        REAL8 mean=*p->mean,stdev=*p->sigma,val=*(REAL8 *)item->value;
+        logPrior+= -0.5*(mean-val)*(mean-val)/stdev/stdev - 0.5*log(LAL_TWOPI) - log(stdev);
+      }
+    }
+  }
+
+  /* check if signal model is being used */
+  UINT4 signalFlag=1;
+  if(role[PRIOR_ROLE_SIGNAL_FLAG])
+    signalFlag = *((INT4 *)role[PRIOR_ROLE_SIGNAL_FLAG]->value);
+
+  if(!signalFlag) logPrior=0.0;
+  else {
+
+  if(outside) return -INFINITY;
+  if(role[PRIOR_ROLE_FLOW] &&
+          (role[PRIOR_ROLE_FLOW]->vary==LALINFERENCE_PARAM_CIRCULAR || role[PRIOR_ROLE_FLOW]->vary==LALINFERENCE_PARAM_LINEAR)) {
+    logPrior+=log(*(REAL8 *)role[PRIOR_ROLE_FLOW]->value);
+  }
+
+  INT4 uniform_distance = cp->uniform_distance && *cp->uniform_distance;
+  INT4 src_comove_volume_distance = cp->src_comove_volume_distance && *cp->src_comove_volume_distance;
+  if(role[PRIOR_ROLE_LOGDISTANCE])
+  {
+    REAL8 log_dist = *(REAL8 *)role[PRIOR_ROLE_LOGDISTANCE]->value;
+    if (uniform_distance) {
+      logPrior+=log_dist;
+    }
+    else if (src_comove_volume_distance) {
+      REAL8 dist_Gpc = exp(log_dist)/1000.0;
+      REAL8 dist_Gpc2= dist_Gpc*dist_Gpc;
+      REAL8 dist_Gpc3= dist_Gpc2*dist_Gpc;
+      REAL8 dist_Gpc4= dist_Gpc3*dist_Gpc;
+      REAL8 denominator = c0+c1*dist_Gpc+c2*dist_Gpc2+c3*dist_Gpc3+c4*dist_Gpc4;
+      logPrior+=3.0* log_dist-log(denominator);
+    }
+    else {
+      logPrior+=3.0* log_dist;
+    }
+  }
+  else if(role[PRIOR_ROLE_DISTANCE])
+  {
+    if (!uniform_distance) {
+      REAL8 dist = *(REAL8 *)role[PRIOR_ROLE_DISTANCE]->value;
+      if (src_comove_volume_distance) {
+        REAL8 dist_Gpc = dist/1000.0;
+        REAL8 dist_Gpc2= dist_Gpc*dist_Gpc;
+        REAL8 dist_Gpc3= dist_Gpc2*dist_Gpc;
+        REAL8 dist_Gpc4= dist_Gpc3*dist_Gpc;
+        REAL8 denominator = c0+c1*dist_Gpc+c2*dist_Gpc2+c3*dist_Gpc3+c4*dist_Gpc4;
+        logPrior+=2.0*log(dist)-log(denominator);
+      }
+      else {
+        logPrior+=2.0*log(dist);
+      }
+    }
+  }
+  if(role[PRIOR_ROLE_DECLINATION] && role[PRIOR_ROLE_DECLINATION]->vary==LALINFERENCE_PARAM_LINEAR)
+    logPrior+=log(fabs(cos(*(REAL8 *)role[PRIOR_ROLE_DECLINATION]->value)));
+
+  if(role[PRIOR_ROLE_LOGMC]) {
+    mc=exp(*(REAL8 *)role[PRIOR_ROLE_LOGMC]->value);
+  } else if(role[PRIOR_ROLE_CHIRPMASS]) {
+    mc=(*(REAL8 *)role[PRIOR_ROLE_CHIRPMASS]->value);
+  }
+
+  if(role[PRIOR_ROLE_Q]) {
+    q=*(REAL8 *)role[PRIOR_ROLE_Q]->value;
+    LALInferenceMcQ2Masses(mc,q,&m1,&m2);
+  } else if(role[PRIOR_ROLE_ETA]) {
+    eta=*(REAL8 *)role[PRIOR_ROLE_ETA]->value;
+    LALInferenceMcEta2Masses(mc,eta,&m1,&m2);
+  }
+
+  if(role[PRIOR_ROLE_LOGMC]) {
+    if(role[PRIOR_ROLE_Q])
+      logPrior+=log(m1*m1);
+    else
+      logPrior+=log(((m1+m2)*(m1+m2)*(m1+m2))/(m1-m2));
+  } else if(role[PRIOR_ROLE_CHIRPMASS]) {
+    if(role[PRIOR_ROLE_Q])
+      logPrior+=log(m1*m1/mc);
+    else
+      logPrior+=log(((m1+m2)*(m1+m2))/((m1-m2)*pow(eta,3.0/5.0)));
+  }
+
+  /* Check for individual and total mass priors */
+  if(cp->mass1_min && *cp->mass1_min > m1) return -INFINITY;
+  if(cp->mass1_max && *cp->mass1_max < m1) return -INFINITY;
+  if(cp->mass2_min && *cp->mass2_min > m2) return -INFINITY;
+  if(cp->mass2_max && *cp->mass2_max < m2) return -INFINITY;
+  if(cp->MTotMax && *cp->MTotMax < m1+m2) return -INFINITY;
+  if(cp->MTotMin && *cp->MTotMin > m1+m2) return -INFINITY;
+
+  if(model != NULL && cp->malmquist && *cp->malmquist &&
+        !within_malmquist(runState, params, model))
+      return -INFINITY;
+
+  /* Spin priors, as in LALInferenceInspiralPrior */
+  for(i=0;i<2;i++)
+  {
+    LALInferenceVariableItem *tilt=role[i ? PRIOR_ROLE_TILT2 : PRIOR_ROLE_TILT1];
+    LALInferenceVariableItem *a=role[i ? PRIOR_ROLE_A2 : PRIOR_ROLE_A1];
+    if(tilt)
+    {
+      if(tilt->vary!=LALINFERENCE_PARAM_FIXED && tilt->vary!=LALINFERENCE_PARAM_OUTPUT)
+      {
+        if(cp->volumetric_spins)
+        {
+          REAL8 aval = *(REAL8 *)a->value;
+          REAL8 a_max = *cp->a_spin_max[i], a_min = *cp->a_spin_min[i];
+          REAL8 V = (4./3.)*LAL_PI * (a_max*a_max*a_max - a_min*a_min*a_min);
+          logPrior+=log(fabs(aval*aval))-log(fabs(V));
+        }
+        logPrior+=log(fabs(sin(*(REAL8 *)tilt->value)));
+      }
+    }
+    else if(cp->volumetric_spins)
+    {
+      REAL8 aval = *(REAL8 *)a->value;
+      REAL8 a_max = *cp->a_spin_max[i];
+      REAL8 V = (4./3.)*LAL_PI * (a_max*a_max*a_max);
+      logPrior+=log(fabs((3./4.)*(a_max*a_max - aval*aval)))-log(fabs(V));
+    }
+  }
 
+  if(cp->projected_aligned_spin)
+  {
+    for(i=0;i<2;i++)
+    {
+      LALInferenceVariableItem *a=role[i ? PRIOR_ROLE_A2 : PRIOR_ROLE_A1];
+      if(a && !role[i ? PRIOR_ROLE_TILT2 : PRIOR_ROLE_TILT1])
+      {
+        REAL8 R = REAL8max(fabs(*cp->a_spin_max[i]),fabs(*cp->a_spin_min[i]));
+        REAL8 z=*(REAL8 *)a->value;
+        logPrior += -log(2.0) - log(R) + log(-log(fabs(z) / R));
+      }
+    }
+  }
+
+  if((role[PRIOR_ROLE_LOGP1]&&role[PRIOR_ROLE_GAMMA1]&&role[PRIOR_ROLE_GAMMA2]&&role[PRIOR_ROLE_GAMMA3]) ||
+     (role[PRIOR_ROLE_SDGAMMA0]&&role[PRIOR_ROLE_SDGAMMA1]&&role[PRIOR_ROLE_SDGAMMA2]&&role[PRIOR_ROLE_SDGAMMA3]))
+  {
+    /*If EOS params and masses are aphysical, return -INFINITY to ensure point is rejected*/
+    if(LALInferenceEOSPhysicalCheck(params,runState->commandLine)==XLAL_FAILURE){
+       return -INFINITY;
+    }
+  }
+
+  }/* end prior for signal model parameters */
+
+  logPrior += LALInferenceConstantCalibrationPrior(runState, params);
+  logPrior += LALInferencePSDPrior(runState, params);
+  logPrior += LALInferenceGlitchPrior(runState, params);
+
+  return(logPrior);
+}
+
+/* Generic form of LALInferenceInspiralPrior, looking up every parameter by name */
+static REAL8 inspiral_prior_uncompiled(LALInferenceRunState *runState, LALInferenceVariables *params, LALInferenceModel *model)
+{
   REAL8 logPrior=0.0;
 
   LALInferenceVariableItem *item=NULL;
@@ -703,6 +1155,18 @@ REAL8 LALInferenceInspiralPrior(LALInferenceRunState *runState, LALInferenceVari
   return(logPrior);
 }
 
+/* Return the log Prior of the variables specified, for the non-spinning/spinning inspiral signal case */
+REAL8 LALInferenceInspiralPrior(LALInferenceRunState *runState, LALInferenceVariables *params, LALInferenceModel *model)
+{
+  if (runState == NULL || runState->priorArgs == NULL || params == NULL)
+    XLAL_ERROR_REAL8(XLAL_EFAULT, "Null arguments received.");
+
+  const LALInferenceCompiledPrior *cp = compiled_prior_lookup(&runState->compiledPrior, runState->priorArgs, params);
+  if (cp && cp->inspiral)
+    return compiled_inspiral_prior(cp, runState, params, model);
+  return inspiral_prior_uncompiled(runState, params, model);
+}
+
 /* Convert the hypercube parameter to physical parameters, for the non-spinning inspiral signal case */
 UINT4 LALInferenceInspiralCubeToPrior(LALInferenceRunState *runState, LALInferenceVariables *params, LALInferenceModel *model, double *Cube, void *context)
 {
@@ -1115,10 +1579,87 @@ UINT4 LALInferenceInspiralCubeToPrior(LALInferenceRunState *runState, LALInferen
     return 1;
 }
 
+/* Bring a single parameter back within [min,max]; returns 1 if its value
+   is infinite, in which case the remaining parameters are left alone */
+static INT4 cyclic_reflective_bound_item(LALInferenceVariableItem *paraHead, REAL8 min, REAL8 max)
+{
+  REAL8 val, offset, delta;
+  UINT8 n;
+
+  /* Check that the minimum and maximum make sense. */
+  if (min >= max) {
+    XLAL_ERROR(XLAL_EINVAL, "Minimum %f for variable '%s' is not less than maximum %f.", min, paraHead->name, max);
+  }
+  delta = max - min;
+
+  val = *(REAL8 *)paraHead->value;
+
+  if (val == INFINITY)
+    return 1;
+
+  // Nothing to do if between bounds
+  if ((val >= min) && (val <= max))
+    return 0;
+
+  if(paraHead->vary==LALINFERENCE_PARAM_CIRCULAR) {
+    /* For cyclic boundaries, mod out by range. */
+    if (val > max) {
+      offset = val - min;
+      *(REAL8 *)paraHead->value = min + fmod(offset, delta);
+    } else {
+      offset = max - val;
+      *(REAL8 *)paraHead->value = max - fmod(offset, delta);
+    }
+  } else if (paraHead->vary==LALINFERENCE_PARAM_LINEAR && paraHead->type==LALINFERENCE_REAL8_t) {
+    /* For linear boundaries, reflect about endpoints of range until
+       within range. SKIP NOISE PARAMETERS (ONLY CHECK REAL8) */
+    /*
+      This reflection is accomplished by also modding out the 'excess' (that is,
+      the difference between the value and the upper or lower bound, as appropriate)
+      as done above for cyclic parameters.  However, unlike in the cyclic case, to actually
+      agree with what the reflection would give, we must also note whether the range divides
+      into the excess an even or an odd number of times, and therefore whether we add the
+      remainder to the lower bound or subtract it from the upper bound. Which we do also
+      depends on whether the value was below the minimum or above the maximum.
+     */
+    if (val > max) {
+      offset = val - max;
+      // How many times do we fold?
+      n = (UINT8) (offset/delta);
+      // Now make offset the remainder
+      offset = fmod(offset, delta);
+      if (n % 2){
+        // If we fold an odd number of times,
+        // then add offset to min
+        *(REAL8 *)paraHead->value = min + offset;
+      } else {
+        // Otherwise, subtract it from max
+        *(REAL8 *)paraHead->value = max - offset;
+      }
+    } else {
+      // We only get here if val <  min
+      offset = min - val;
+      // How many times do we fold?
+      n = (UINT8) (offset/delta);
+      // Now make offset the remainder
+      offset = fmod(offset, delta);
+      if (n % 2){
+        // If we fold an odd number of times,
+        // then subtract offset from max
+        *(REAL8 *)paraHead->value = max - offset;
+      } else {
+        // Otherwise, add it to min
+        *(REAL8 *)paraHead->value = min + offset;
+      }
+    }
+  }
+  return 0;
+}
+
 void LALInferenceCyclicReflectiveBound(LALInferenceVariables *parameter,
                                        LALInferenceVariables *priorArgs){
-  REAL8 val, offset, delta, min, max;
-  UINT8 n;
+  REAL8 min, max;
+  INT4 status;
 
   if (parameter == NULL || priorArgs == NULL)
     XLAL_ERROR_VOID(XLAL_EFAULT, "Null arguments received.");
@@ -1134,73 +1675,41 @@ void LALInferenceCyclicReflectiveBound(LALInferenceVariables *parameter,
 
     LALInferenceGetMinMaxPrior(priorArgs,paraHead->name, &min, &max);
 
-    /* Check that the minimum and maximum make sense. */
-    if (min >= max) {
-      XLAL_ERROR_VOID(XLAL_EINVAL, "Minimum %f for variable '%s' is not less than maximum %f.", min, paraHead->name, max);
-    }
-    delta = max - min;
+    status = cyclic_reflective_bound_item(paraHead, min, max);
+    if (status < 0)
+      XLAL_ERROR_VOID(XLAL_EFUNC);
+    if (status > 0)
+      return;
+  }
+  return;
+}
 
-    val = *(REAL8 *)paraHead->value;
+void LALInferenceThreadCyclicReflectiveBound(LALInferenceThreadState *thread,
+                                             LALInferenceVariables *parameter){
+  const LALInferenceCompiledPrior *cp;
+  const CompiledPriorParam *p;
+  LALInferenceVariableItem *paraHead;
+  INT4 status;
 
-    if (val == INFINITY) 
-      return;
+  if (thread == NULL || parameter == NULL || thread->priorArgs == NULL)
+    XLAL_ERROR_VOID(XLAL_EFAULT, "Null arguments received.");
 
-    // Nothing to do if between bounds
-    if ((val >= min) && (val <= max))
-      continue;
+  cp = compiled_prior_lookup(&thread->compiledPrior, thread->priorArgs, parameter);
+  if (!cp) {
+    LALInferenceCyclicReflectiveBound(parameter, thread->priorArgs);
+    return;
+  }
 
-    if(paraHead->vary==LALINFERENCE_PARAM_CIRCULAR) {
-      /* For cyclic boundaries, mod out by range. */
-      if (val > max) {
-	offset = val - min;
-	*(REAL8 *)paraHead->value = min + fmod(offset, delta);
-      } else {
-	offset = max - val;
-	*(REAL8 *)paraHead->value = max - fmod(offset, delta);
-      }
-    } else if (paraHead->vary==LALINFERENCE_PARAM_LINEAR && paraHead->type==LALINFERENCE_REAL8_t) {
-      /* For linear boundaries, reflect about endpoints of range until
-	 within range. SKIP NOISE PARAMETERS (ONLY CHECK REAL8) */
-      /*
-	This reflection is accomplished by also modding out the 'excess' (that is,
-	the difference between the value and the upper or lower bound, as appropriate)
-	as done above for cyclic parameters.  However, unlike in the cyclic case, to actually
-	agree with what the reflection would give, we must also note whether the range divides
-	into the excess an even or an odd number of times, and therefore whether we add the
-	remainder to the lower bound or subtract it from the upper bound. Which we do also
-	depends on whether the value was below the minimum or above the maximum.
-       */
-      if (val > max) {
-	offset = val - max;
-	// How many times do we fold?
-	n = (UINT8) (offset/delta);
-	// Now make offset the remainder
-	offset = fmod(offset, delta);
-	if (n % 2){
-	  // If we fold an odd number of times,
-	  // then add offset to min
-	  *(REAL8 *)paraHead->value = min + offset;
-	} else {
-	  // Otherwise, subtract it from max
-	  *(REAL8 *)paraHead->value = max - offset;
-	}
-      } else {
-	// We only get here if val <  min
-	offset = min - val;
-	// How many times do we fold?
-	n = (UINT8) (offset/delta);
-	// Now make offset the remainder
-	offset = fmod(offset, delta);
-	if (n % 2){
-	  // If we fold an odd number of times,
-	  // then subtract offset from max
-	  *(REAL8 *)paraHead->value = max - offset;
-	} else {
-	  // Otherwise, add it to min
-	  *(REAL8 *)paraHead->value = min + offset;
-	}
-      }
-    }
+  for (paraHead=parameter->head, p=cp->params; paraHead; paraHead=paraHead->next, p++) {
+    if( p->vary==LALINFERENCE_PARAM_FIXED ||
+        p->vary==LALINFERENCE_PARAM_OUTPUT ||
+        !p->min ) continue;
+
+    status = cyclic_reflective_bound_item(paraHead, *p->min, *p->max);
+    if (status < 0)
+      XLAL_ERROR_VOID(XLAL_EFUNC);
+    if (status > 0)
+      return;
   }
   return;
 }
@@ -85,6 +85,33 @@ UINT4 LALInferenceInspiralCubeToPrior(LALInferenceRunState *runState, LALInferen
  */
 void LALInferenceCyclicReflectiveBound(LALInferenceVariables *parameter, LALInferenceVariables *priorArgs);
 
+#ifndef SWIG   /* exclude from SWIG interface */
+
+/**
+ * Opaque compiled form of a \c priorArgs list for a given layout of the
+ * parameters, built on demand by LALInferenceInspiralPrior() and
+ * LALInferenceThreadCyclicReflectiveBound() so that they do not look up
+ * the prior ranges of every parameter by name on each call.
+ */
+typedef struct tagLALInferenceCompiledPrior LALInferenceCompiledPrior;
+
+/**
+ * As LALInferenceCyclicReflectiveBound(), using the prior ranges in \c
+ * thread->priorArgs through the thread's compiled prior.
+ *
+ * \param thread [in] Thread whose \c priorArgs hold the prior ranges
+ * \param parameter [in] Pointer to an array of parameters
+ */
+void LALInferenceThreadCyclicReflectiveBound(LALInferenceThreadState *thread, LALInferenceVariables *parameter);
+
+/**
+ * Free a compiled prior, e.g. \c runState->compiledPrior, together with
+ * any tables it superseded.
+ */
+void LALInferenceDestroyCompiledPrior(LALInferenceCompiledPrior *cp);
+
+#endif /* SWIG */
+
 /**
  * \brief Rotate initial phase if polarisation angle is cyclic around ranges
  *
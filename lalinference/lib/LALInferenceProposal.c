@@ -132,6 +132,21 @@ static INT4 numDetectorsUniquePositions(LALInferenceIFOData *data) {
     return nIFO - nCollision;
 }
 
+/* Detector geometry used by the sky proposals, computed once per run from
+ * the data and stored in the proposal arguments as "sky_geometry". */
+typedef struct tagSkyGeometry {
+    INT4 nDet;
+    LALDetector *detectors;  /* copies of the detectors, in data order */
+    REAL8 *axes;             /* unit vector from detector j to detector i in axes[3*(i*nDet + j)] */
+    INT4 planeDefined;       /* whether there are three distinct detector sites */
+    REAL8 planeNormal[3];    /* unit normal of the plane through the first three distinct sites */
+    REAL8 epoch;             /* GPS time of the data epoch */
+    REAL8 gmst;              /* Greenwich mean sidereal time at the epoch, in [0, 2pi) */
+} SkyGeometry;
+
+static SkyGeometry *sky_geometry_create(LALInferenceIFOData *data);
+static SkyGeometry *get_sky_geometry(LALInferenceThreadState *thread);
+
 LALInferenceProposal *LALInferenceInitProposal(LALInferenceProposalFunction func, const char *name)
 {
   LALInferenceProposal *proposal = XLALCalloc(1,sizeof(LALInferenceProposal));
@@ -225,10 +240,14 @@ REAL8 LALInferenceCyclicProposal(LALInferenceThreadState *thread,
         cycle->order is a list of elements to call from the proposals */
 
     REAL8 logPropRatio=-INFINITY;
+    INT4 profiling = thread->model && thread->model->profile;
+    REAL8 start = 0;
     do
     {
       i = cycle->order[cycle->counter];
+      if (profiling) start = LALInferenceProfileClock();
       logPropRatio = cycle->proposals[i]->func(thread, currentParams, proposedParams);
+      if (profiling) LALInferenceTimerAccumulate(&cycle->proposals[i]->timer, start);
       strcpy(cycle->last_proposal_name, cycle->proposals[i]->name);
       cycle->counter = (cycle->counter + 1) % cycle->length;
     }
@@ -331,6 +350,9 @@ LALInferenceVariables *LALInferenceParseProposalArgs(LALInferenceRunState *runSt
     INT4 nUniqueDet = numDetectorsUniquePositions(runState->data);
     LALInferenceAddINT4Variable(propArgs, "nUniqueDet", nUniqueDet, LALINFERENCE_PARAM_FIXED);
 
+    SkyGeometry *skyGeometry = sky_geometry_create(runState->data);
+    LALInferenceAddVariable(propArgs, "sky_geometry", &skyGeometry, LALINFERENCE_void_ptr_t, LALINFERENCE_PARAM_FIXED);
+
     INT4 marg_timephi = 0;
     if (LALInferenceGetProcParamVal(command_line, "--margtimephi"))
         marg_timephi = 1;
@@ -653,7 +675,7 @@ REAL8 LALInferenceSingleAdaptProposal(LALInferenceThreadState *thread,
         } else
             *((REAL8 *)param->value) += gsl_ran_ugaussian(rng) * sigma * sqrttemp;
 
-        LALInferenceCyclicReflectiveBound(proposedParams, thread->priorArgs);
+        LALInferenceThreadCyclicReflectiveBound(thread, proposedParams);
 
         /* Set the log of the proposal ratio to zero, since this is a
         symmetric proposal. */
@@ -745,7 +767,7 @@ REAL8 LALInferenceSingleProposal(LALInferenceThreadState *thread,
         }
     }
 
-    LALInferenceCyclicReflectiveBound(proposedParams, thread->priorArgs);
+    LALInferenceThreadCyclicReflectiveBound(thread, proposedParams);
 
     /* Symmetric Proposal. */
     REAL8 logPropRatio = 0.0;
@@ -1419,15 +1441,8 @@ static void vsub(REAL8 diff[3], const REAL8 w[3], const REAL8 v[3]) {
     diff[2] = w[2] - v[2];
 }
 
-static void reflect_plane(REAL8 pref[3], const REAL8 p[3],
-                          const REAL8 x[3], const REAL8 y[3], const REAL8 z[3]) {
-    REAL8 n[3], nhat[3], xy[3], xz[3], pn[3], pnperp[3];
-
-    vsub(xy, y, x);
-    vsub(xz, z, x);
-
-    cross_product(n, xy, xz);
-    unit_vector(nhat, n);
+static void reflect_plane(REAL8 pref[3], const REAL8 p[3], const REAL8 nhat[3]) {
+    REAL8 pn[3], pnperp[3];
 
     project_along(pn, p, nhat);
     vsub(pnperp, p, pn);
@@ -1435,18 +1450,6 @@ static void reflect_plane(REAL8 pref[3], const REAL8 p[3],
     vsub(pref, pnperp, pn);
 }
 
-static void get_detectors(LALInferenceIFOData *data, LALDetector **detectors) {
-    INT4 i;
-    INT4 nDet = 0;
-    LALInferenceIFOData *ifo;
-    for (i=0,ifo=data; ifo; i++,ifo=ifo->next)
-        nDet++;
-
-    *detectors = XLALCalloc(nDet, sizeof(LALDetector));
-    for (i=0,ifo=data; ifo; i++,ifo=ifo->next)
-        *detectors[i] = *(ifo->detector);
-}
-
 static void sph_to_cart(REAL8 cart[3], const REAL8 lat, const REAL8 longi) {
     cart[0] = cos(longi)*cos(lat);
     cart[1] = sin(longi)*cos(lat);
@@ -1458,72 +1461,111 @@ static void cart_to_sph(const REAL8 cart[3], REAL8 *lat, REAL8 *longi) {
     *lat = asin(cart[2] / sqrt(cart[0]*cart[0] + cart[1]*cart[1] + cart[2]*cart[2]));
 }
 
-static void reflected_position_and_time(LALInferenceThreadState *thread, const REAL8 ra, const REAL8 dec,
-                                        const REAL8 oldTime, REAL8 *newRA, REAL8 *newDec, REAL8 *newTime) {
-    LALStatus status;
-    memset(&status, 0, sizeof(status));
-    SkyPosition currentEqu, currentGeo, newEqu, newGeo;
-    LALDetector *detectors;
+static SkyGeometry *sky_geometry_create(LALInferenceIFOData *data) {
+    INT4 i, j, nSites = 0;
+    LALInferenceIFOData *ifo;
+    LALDetector *sites[3];
+    REAL8 xy[3], xz[3], n[3];
     LIGOTimeGPS epoch;
-    REAL8 x[3], y[3], z[3];
-    REAL8 currentLoc[3], newLoc[3];
-    REAL8 newGeoLat, newGeoLongi;
-    REAL8 oldDt, newDt;
-    LALDetector xD, yD, zD;
+    SkyGeometry *geometry = XLALCalloc(1, sizeof(SkyGeometry));
 
-    currentEqu.latitude = dec;
-    currentEqu.longitude = ra;
-    currentEqu.system = COORDINATESYSTEM_EQUATORIAL;
-    currentGeo.system = COORDINATESYSTEM_GEOGRAPHIC;
+    for (ifo=data; ifo; ifo=ifo->next)
+        geometry->nDet++;
 
-    epoch = thread->parent->data->epoch;
-    get_detectors(thread->parent->data, &detectors);
+    geometry->detectors = XLALCalloc(geometry->nDet, sizeof(LALDetector));
+    for (i=0,ifo=data; ifo; i++,ifo=ifo->next)
+        geometry->detectors[i] = *(ifo->detector);
+
+    /* Baseline directions for every ordered pair of detectors, left zero
+    for co-located pairs */
+    geometry->axes = XLALCalloc(3*geometry->nDet*geometry->nDet, sizeof(REAL8));
+    for (i=0; i<geometry->nDet; i++) {
+        for (j=0; j<geometry->nDet; j++) {
+            if (same_detector_location(&geometry->detectors[i], &geometry->detectors[j]))
+                continue;
+            vsub(n, geometry->detectors[i].location, geometry->detectors[j].location);
+            unit_vector(&geometry->axes[3*(i*geometry->nDet + j)], n);
+        }
+    }
 
-    LALEquatorialToGeographic(&status, &currentGeo, &currentEqu, &epoch);
+    /* The plane through the first three distinct detector sites */
+    for (i=0; i<geometry->nDet && nSites<3; i++) {
+        for (j=0; j<nSites; j++) {
+            if (same_detector_location(&geometry->detectors[i], sites[j]))
+                break;
+        }
+        if (j == nSites)
+            sites[nSites++] = &geometry->detectors[i];
+    }
+    if (nSites == 3) {
+        vsub(xy, sites[1]->location, sites[0]->location);
+        vsub(xz, sites[2]->location, sites[0]->location);
+        cross_product(n, xy, xz);
+        unit_vector(geometry->planeNormal, n);
+        geometry->planeDefined = 1;
+    }
 
-    /* This function should only be called when we know that we have
-     three detectors, or the following will crash. */
-    xD = detectors[0];
-    memcpy(x, xD.location, 3*sizeof(REAL8));
+    epoch = data->epoch;
+    geometry->epoch = XLALGPSGetREAL8(&epoch);
+    geometry->gmst = fmod(XLALGreenwichMeanSiderealTime(&epoch), LAL_TWOPI);
+    if (geometry->gmst < 0.0)
+        geometry->gmst += LAL_TWOPI;
 
-    INT4 det = 1;
-    yD = detectors[det];
-    while (same_detector_location(&yD, &xD)) {
-        det++;
-        yD = detectors[det];
-    }
-    memcpy(y, yD.location, 3*sizeof(REAL8));
-    det++;
+    return geometry;
+}
 
-    zD = detectors[det];
-    while (same_detector_location(&zD, &yD) || same_detector_location(&zD, &xD)) {
-        det++;
-        zD = detectors[det];
+static SkyGeometry *get_sky_geometry(LALInferenceThreadState *thread) {
+    SkyGeometry *geometry;
+
+    /* Proposal arguments not made by LALInferenceParseProposalArgs() get
+    their geometry on first use */
+    if (!LALInferenceCheckVariable(thread->proposalArgs, "sky_geometry")) {
+        geometry = sky_geometry_create(thread->parent->data);
+        LALInferenceAddVariable(thread->proposalArgs, "sky_geometry", &geometry, LALINFERENCE_void_ptr_t, LALINFERENCE_PARAM_FIXED);
     }
-    memcpy(z, zD.location, 3*sizeof(REAL8));
 
-    sph_to_cart(currentLoc, currentGeo.latitude, currentGeo.longitude);
+    return *(SkyGeometry **)LALInferenceGetVariable(thread->proposalArgs, "sky_geometry");
+}
 
-    reflect_plane(newLoc, currentLoc, x, y, z);
+/* Greenwich mean sidereal time at GPS time t, in [0, 2pi), advanced from the
+epoch at the sidereal rate. Over the length of an analysis segment this
+agrees with XLALGreenwichMeanSiderealTime() to far better than the
+precision of the sky proposals. */
+static REAL8 sky_geometry_gmst(const SkyGeometry *geometry, const REAL8 t) {
+    REAL8 gmst = fmod(geometry->gmst + LAL_TWOPI*(t - geometry->epoch)/LAL_DAYSID_SI, LAL_TWOPI);
 
-    cart_to_sph(newLoc, &newGeoLat, &newGeoLongi);
+    return gmst < 0. ? gmst + LAL_TWOPI : gmst;
+}
+
+static void reflected_position_and_time(LALInferenceThreadState *thread, const REAL8 ra, const REAL8 dec,
+                                        const REAL8 oldTime, REAL8 *newRA, REAL8 *newDec, REAL8 *newTime) {
+    SkyGeometry *geometry = get_sky_geometry(thread);
+    REAL8 currentLoc[3], newLoc[3], shift[3];
+    REAL8 newGeoLat, newGeoLongi;
+
+    /* This function should only be called when we know that we have
+     three detectors, or the following will crash. */
+    if (!geometry->planeDefined) {
+        XLALError("reflected_position_and_time", __FILE__, __LINE__, XLAL_EINVAL);
+        exit(1);
+    }
+
+    /* Earth-fixed direction to the source at the data epoch */
+    sph_to_cart(currentLoc, dec, ra - geometry->gmst);
 
-    newGeo.latitude = newGeoLat;
-    newGeo.longitude = newGeoLongi;
-    newGeo.system = COORDINATESYSTEM_GEOGRAPHIC;
-    newEqu.system = COORDINATESYSTEM_EQUATORIAL;
-    LALGeographicToEquatorial(&status, &newEqu, &newGeo, &epoch);
+    reflect_plane(newLoc, currentLoc, geometry->planeNormal);
 
-    oldDt = XLALTimeDelayFromEarthCenter(detectors[0].location, currentEqu.longitude,
-                                         currentEqu.latitude, &epoch);
-    newDt = XLALTimeDelayFromEarthCenter(detectors[0].location, newEqu.longitude,
-                                         newEqu.latitude, &epoch);
+    cart_to_sph(newLoc, &newGeoLat, &newGeoLongi);
 
-    *newRA = newEqu.longitude;
-    *newDec = newEqu.latitude;
-    *newTime = oldTime + oldDt - newDt;
+    *newRA = fmod(newGeoLongi + geometry->gmst, LAL_TWOPI);
+    if (*newRA < 0.0)
+        *newRA += LAL_TWOPI;
+    *newDec = newGeoLat;
 
-    XLALFree(detectors);
+    /* Keep the arrival time at the first detector fixed. The delay from
+    the geocentre of a source in direction k is -x.k/c. */
+    vsub(shift, newLoc, currentLoc);
+    *newTime = oldTime + dot(geometry->detectors[0].location, shift)/LAL_C_SI;
 }
 
 static REAL8 evaluate_morlet_proposal(LALInferenceThreadState *thread,
@@ -1599,31 +1641,26 @@ static REAL8 glitchAmplitudeDraw(REAL8 Q, REAL8 f, gsl_rng *r) {
 REAL8 LALInferenceSkyRingProposal(LALInferenceThreadState *thread,
                                   LALInferenceVariables *currentParams,
                                   LALInferenceVariables *proposedParams) {
-    INT4 i, j, l;
-    INT4 ifo, nifo, timeflag=0;
+    INT4 i, j;
+    INT4 nifo, timeflag=0;
     REAL8 logPropRatio = 0.0;
     REAL8 ra, dec;
     REAL8 baryTime, gmst;
     REAL8 newRA, newDec, newTime, newPsi;
-    REAL8 intpart, decpart;
     REAL8 omega, cosomega, sinomega, c1momega;
-    REAL8 IFO1[3], IFO2[3];
-    REAL8 IFOX[3], k[3];
-    REAL8 normalize;
+    const REAL8 *IFO1, *n;
+    REAL8 k[3];
     REAL8 pForward, pReverse;
-    REAL8 n[3];
     REAL8 kp[3];
-    LIGOTimeGPS GPSlal, epoch;
-    LALDetector *detectors;
-    gsl_matrix *IFO;
+    LIGOTimeGPS epoch;
+    SkyGeometry *geometry;
 
     LALInferenceCopyVariables(currentParams, proposedParams);
 
-    LALInferenceVariables *args = thread->proposalArgs;
     gsl_rng *rng = thread->GSLrandom;
 
     epoch = thread->parent->data->epoch;
-    get_detectors(thread->parent->data, &detectors);
+    geometry = get_sky_geometry(thread);
 
     ra = LALInferenceGetREAL8Variable(proposedParams, "rightascension");
     dec = LALInferenceGetREAL8Variable(proposedParams, "declination");
@@ -1635,15 +1672,7 @@ REAL8 LALInferenceSkyRingProposal(LALInferenceThreadState *thread,
         baryTime = XLALGPSGetREAL8(&epoch);
     }
 
-    XLALGPSSetREAL8(&GPSlal, baryTime);
-    gmst = XLALGreenwichMeanSiderealTime(&GPSlal);
-
-    //remap gmst back to [0:2pi]
-    gmst /= LAL_TWOPI;
-    intpart = (INT4)gmst;
-    decpart = gmst - (REAL8)intpart;
-    gmst = decpart*LAL_TWOPI;
-    gmst = gmst < 0. ? gmst + LAL_TWOPI : gmst;
+    gmst = sky_geometry_gmst(geometry, baryTime);
 
     /*
     line-of-sight vector
@@ -1652,18 +1681,7 @@ REAL8 LALInferenceSkyRingProposal(LALInferenceThreadState *thread,
     k[1] =-sin(gmst-ra) * cos(dec);
     k[2] = sin(dec);
 
-    /*
-    Store location for each detector
-    */
-    nifo = LALInferenceGetINT4Variable(args, "nDet");
-
-    IFO = gsl_matrix_alloc(nifo, 3);
-
-    for(ifo=0; ifo<nifo; ifo++) {
-        memcpy(IFOX, detectors[ifo].location, 3*sizeof(REAL8));
-        for (i=0; i<3; i++)
-            gsl_matrix_set(IFO, ifo, i, IFOX[i]);
-    }
+    nifo = geometry->nDet;
 
     /*
     Randomly select two detectors from the network
@@ -1675,22 +1693,11 @@ REAL8 LALInferenceSkyRingProposal(LALInferenceThreadState *thread,
         j=gsl_rng_uniform_int(rng, nifo);
     }
 
-    for(l=0; l<3; l++) {
-        IFO1[l] = gsl_matrix_get(IFO, i, l);
-        IFO2[l] = gsl_matrix_get(IFO, j, l);
-    }
-
     /*
     detector axis
     */
-    normalize=0.0;
-    for(i=0; i<3; i++) {
-        n[i] = IFO1[i] - IFO2[i];
-        normalize += n[i] * n[i];
-    }
-    normalize = 1./sqrt(normalize);
-    for(i=0; i<3; i++)
-        n[i] *= normalize;
+    IFO1 = geometry->detectors[i].location;
+    n = &geometry->axes[3*(i*nifo + j)];
 
     /*
     rotation angle
@@ -1735,8 +1742,6 @@ REAL8 LALInferenceSkyRingProposal(LALInferenceThreadState *thread,
     }
     newTime = tx + baryTime - ty;
 
-    XLALGPSSetREAL8(&GPSlal, newTime);
-
     /*
     draw new polarisation angle uniformally
     for now
@@ -1753,12 +1758,8 @@ REAL8 LALInferenceSkyRingProposal(LALInferenceThreadState *thread,
     pForward = cos(newDec);
     pReverse = cos(dec);
 
-    gsl_matrix_free(IFO);
-
     logPropRatio = log(pReverse/pForward);
 
-    XLALFree(detectors);
-
     return logPropRatio;
 }
 
@@ -1881,6 +1882,14 @@ REAL8 LALInferencePSDFitJump(LALInferenceThreadState *thread,
     return logPropRatio;
 }
 
+/* number of bins over which the wavelet recurrences run before restarting */
+#define WAVELET_RESYNC 128
+
+/* Add (flag=1), remove (flag=-1) or replace the model with (flag=0) the n'th
+wavelet of one IFO in the glitch model. Only the bins within 1/tau of f0,
+where the wavelet is non-negligible, are touched, and over them the Gaussian
+envelope and the phase are advanced by recurrences rather than evaluated
+bin by bin. */
 static void UpdateWaveletSum(LALInferenceThreadState *thread,
                              LALInferenceVariables *proposedParams,
                              gsl_matrix *glitchFD, INT4 ifo, INT4 n, INT4 flag) {
@@ -1888,12 +1897,14 @@ static void UpdateWaveletSum(LALInferenceThreadState *thread,
     INT4 lower, upper;
     INT4 glitchLower, glitchUpper;
     REAL8FrequencySeries **asds, *asd = NULL;
-    REAL8Vector *flows;
+    REAL8Vector *flows, *fhighs;
     REAL8 deltaT, Tobs, deltaF;
     REAL8 Q, Amp, t0, ph0, f0; //sine-Gaussian parameters
-    REAL8 amparg, phiarg, Ai;//helpers for computing sineGaussian
+    REAL8 amparg, ampstep, Ai;//helpers for computing sineGaussian
     REAL8 gRe, gIm;         //real and imaginary parts of current glitch model
-    REAL8 tau;
+    REAL8 tau, norm;
+    REAL8 envelope=0.0, ratio=0.0, ratioStep; //Gaussian envelope and its bin-to-bin ratio
+    COMPLEX16 phasor=0.0, phaseStep;
     gsl_matrix *glitch_f, *glitch_Q, *glitch_A;
     gsl_matrix *glitch_t, *glitch_p;
     REAL8TimeSeries **td_data;
@@ -1907,6 +1918,7 @@ static void UpdateWaveletSum(LALInferenceThreadState *thread,
     */
     asds = *(REAL8FrequencySeries ***)LALInferenceGetVariable(args, "asds");
     flows = LALInferenceGetREAL8VectorVariable(args, "flows");
+    fhighs = LALInferenceGetREAL8VectorVariable(args, "fhighs");
     td_data = *(REAL8TimeSeries ***)LALInferenceGetVariable(args, "td_data");
 
     /* get dataPtr pointing to correct IFO */
@@ -1917,7 +1929,7 @@ static void UpdateWaveletSum(LALInferenceThreadState *thread,
     deltaF = 1.0 / Tobs;
 
     lower = (INT4)ceil(flows->data[ifo] / deltaF);
-    upper = (INT4)floor(flows->data[ifo] / deltaF);
+    upper = (INT4)floor(fhighs->data[ifo] / deltaF);
 
     glitch_f = LALInferenceGetgslMatrixVariable(proposedParams, "morlet_f0");
     glitch_Q = LALInferenceGetgslMatrixVariable(proposedParams, "morlet_Q");
@@ -1944,40 +1956,59 @@ static void UpdateWaveletSum(LALInferenceThreadState *thread,
         }
     }
 
+    /* restrict the wavelet support to the analysed band */
+    if (glitchLower < lower)
+        glitchLower = lower;
+    if (glitchUpper > upper+1)
+        glitchUpper = upper+1;
+    if (glitchLower >= glitchUpper || (flag != -1 && flag != 0 && flag != 1))
+        return;
+
+    /* envelope exp(-amparg^2) with amparg linear in the bin index, and
+    phase ph0 + i*(pi - 2pi*deltaF*(t0 - Tobs/2)) */
+    norm = Amp*tau*0.5*sqrt(LAL_PI)/sqrt(Tobs);
+    ampstep = deltaF*LAL_PI*tau;
+    ratioStep = exp(-2.0*ampstep*ampstep);
+    phaseStep = cexp(I*(LAL_PI - LAL_TWOPI*deltaF*(t0-Tobs/2.)));
+
     for (i=glitchLower; i<glitchUpper; i++) {
-        if (i>=lower && i<=upper) {
-            gRe = gsl_matrix_get(glitchFD, ifo, 2*i);
-            gIm = gsl_matrix_get(glitchFD, ifo, 2*i+1);
+        /* start, and periodically restart, the recurrences from the exact values */
+        if ((i - glitchLower) % WAVELET_RESYNC == 0) {
             amparg = ((REAL8)i*deltaF - f0)*LAL_PI*tau;
-            phiarg = LAL_PI*(REAL8)i + ph0 - LAL_TWOPI*(REAL8)i*deltaF*(t0-Tobs/2.);//TODO: SIMPLIFY PHASE FOR SINEGAUSSIAN
-            Ai = Amp*tau*0.5*sqrt(LAL_PI)*exp(-amparg*amparg)*asd->data->data[i]/sqrt(Tobs);
-
-            switch(flag) {
-                // Remove wavelet from model
-                case -1:
-                    gRe -= Ai*cos(phiarg);
-                    gIm -= Ai*sin(phiarg);
-                    break;
-                // Add wavelet to model
-                case  1:
-                    gRe += Ai*cos(phiarg);
-                    gIm += Ai*sin(phiarg);
-                    break;
-                // Replace model with wavelet
-                case 0:
-                    gRe = Ai*cos(phiarg);
-                    gIm = Ai*sin(phiarg);
-                    break;
-                //Do nothing
-                default:
-                    break;
-            }//end switch
+            envelope = exp(-amparg*amparg);
+            ratio = exp(-ampstep*(2.0*amparg + ampstep));
+            phasor = cexp(I*(LAL_PI*(REAL8)i + ph0 - LAL_TWOPI*(REAL8)i*deltaF*(t0-Tobs/2.)));//TODO: SIMPLIFY PHASE FOR SINEGAUSSIAN
+        }
 
-            //update glitch model
-            gsl_matrix_set(glitchFD, ifo, 2*i, gRe);
-            gsl_matrix_set(glitchFD, ifo, 2*i+1, gIm);
+        gRe = gsl_matrix_get(glitchFD, ifo, 2*i);
+        gIm = gsl_matrix_get(glitchFD, ifo, 2*i+1);
+        Ai = norm*envelope*asd->data->data[i];
 
-        }//end upper/lower check
+        switch(flag) {
+            // Remove wavelet from model
+            case -1:
+                gRe -= Ai*creal(phasor);
+                gIm -= Ai*cimag(phasor);
+                break;
+            // Add wavelet to model
+            case  1:
+                gRe += Ai*creal(phasor);
+                gIm += Ai*cimag(phasor);
+                break;
+            // Replace model with wavelet
+            case 0:
+                gRe = Ai*creal(phasor);
+                gIm = Ai*cimag(phasor);
+                break;
+        }//end switch
+
+        //update glitch model
+        gsl_matrix_set(glitchFD, ifo, 2*i, gRe);
+        gsl_matrix_set(glitchFD, ifo, 2*i+1, gIm);
+
+        envelope *= ratio;
+        ratio *= ratioStep;
+        phasor *= phaseStep;
     }//end loop over glitch samples
 }
 
@@ -2387,7 +2418,7 @@ REAL8 LALInferenceCorrPolarizationPhaseJump(LALInferenceThreadState *thread,
     phi = (alpha - beta)*0.5;
 
     //map back in range
-    LALInferenceCyclicReflectiveBound(proposedParams, thread->priorArgs);
+    LALInferenceThreadCyclicReflectiveBound(thread, proposedParams);
 
     LALInferenceSetVariable(proposedParams, "polarisation", &psi);
     LALInferenceSetVariable(proposedParams, "phase", &phi);
@@ -2432,20 +2463,17 @@ static void reflected_extrinsic_parameters(LALInferenceThreadState *thread, cons
     REAL8 newFplus[4], newFplus2[4], newFcross[4], newFcross2[4];
     REAL8 a, a2, b, c12;
     REAL8 cosnewIota, cosnewIota2;
-    LIGOTimeGPS GPSlal;
     INT4 nUniqueDet, det;
-    LALDetector *detectors;
+    SkyGeometry *geometry = get_sky_geometry(thread);
+    const LALDetector *detectors = geometry->detectors;
 
-    get_detectors(thread->parent->data, &detectors);
     nUniqueDet = LALInferenceGetINT4Variable(thread->proposalArgs, "nUniqueDet");
 
-    XLALGPSSetREAL8(&GPSlal, baryTime);
-    gmst = XLALGreenwichMeanSiderealTime(&GPSlal);
+    gmst = sky_geometry_gmst(geometry, baryTime);
 
     reflected_position_and_time(thread, ra, dec, baryTime, newRA, newDec, newTime);
 
-    XLALGPSSetREAL8(&GPSlal, *newTime);
-    newGmst = XLALGreenwichMeanSiderealTime(&GPSlal);
+    newGmst = sky_geometry_gmst(geometry, *newTime);
 
     dist2 = dist*dist;
 
@@ -2542,8 +2570,6 @@ static void reflected_extrinsic_parameters(LALInferenceThreadState *thread, cons
     if (Fcross*cosIota*cosnewIota*newFcross[3]<0){
         (*newIota)=LAL_PI-(*newIota);
     }
-
-    XLALFree(detectors);
 }
 
 REAL8 LALInferenceDistanceLikelihoodProposal(LALInferenceThreadState *thread,
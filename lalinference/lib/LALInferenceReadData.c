@@ -74,8 +74,12 @@
 #include <lal/LALInferenceReadData.h>
 #include <lal/LALInferenceLikelihood.h>
 #include <lal/LALInferenceTemplate.h>
+#include <lal/LALInferenceRelativeBinning.h>
+#include <lal/LALInferenceGenerateROQ.h>
 #include <lal/LALInferenceInit.h>
 #include <lal/LALSimNoise.h>
+#include <lal/LALInferenceHDF5.h>
+#include <lal/H5FileIO.h>
 #include <LALInferenceRemoveLines.h>
 /* LIB deps */
 #include <lal/LALInferenceBurstRoutines.h>
@@ -178,6 +182,10 @@ static const LALUnit strainPerCount={0,{0,0,0,0,0,1,-1},{0,0,0,0,0,0,0}};
 
 static REAL8TimeSeries *readTseries(LALCache *cache, CHAR *channel, LIGOTimeGPS start, REAL8 length);
 static void makeWhiteData(LALInferenceIFOData *IFOdata);
+static char *preparedDataKey(ProcessParamsTable *commandLine, const char *ifo, const char *cache, const char *channel, const char *timeslide, const char *psd, const char *asd, REAL8 srate, REAL8 seglen, REAL8 padding, LIGOTimeGPS segStart, LIGOTimeGPS psdStart, REAL8 psdLength);
+static char *preparedDataFileName(const char *dir, const char *ifo, const char *key);
+static int readPreparedData(LALInferenceIFOData *IFOdata, const char *filename, const char *key);
+static void writePreparedData(LALInferenceIFOData *IFOdata, const char *filename, const char *key);
 static void PrintSNRsToFile(LALInferenceIFOData *IFOdata , char SNRpath[] );
 
 
@@ -518,6 +526,8 @@ static void LALInferencePrintDataWithInjection(LALInferenceIFOData *IFOdata, Pro
     (--glob-frame-data)         Will search for frame files containing data in the PWD.\n\
      				Filenames must begin with the IFO's 1-letter code, e.g. H-*.gwf\n\
     (--dont-dump-extras)        If given, won't save PSD and SNR files\n\
+    (--data-cache DIR)          Save the PSD and data read from frames to HDF5 files in DIR,\n\
+                                    and reuse them in later jobs with the same data options\n\
     (--trigtime GPStime)        GPS time of the trigger to analyse\n\
                                     (optional when using --margtime or --margtimephi)\n\
     (--segment-start)           GPS time of the start of the segment\n\
@@ -808,9 +818,25 @@ LALInferenceIFOData *LALInferenceReadData(ProcessParamsTable *commandLine)
     }
 
 
+    /* Prepared data from frames can be cached between jobs, except when
+     * the line tests are run, as they also need the PSD data */
+    const char *dataCacheDir=NULL;
+    if((ppt=LALInferenceGetProcParamVal(commandLine,"--data-cache"))
+            && !LALInferenceGetProcParamVal(commandLine,"--chisquaredlines")
+            && !LALInferenceGetProcParamVal(commandLine,"--KSlines")
+            && !LALInferenceGetProcParamVal(commandLine,"--powerlawlines")
+            && !LALInferenceGetProcParamVal(commandLine,"--xcorrbands"))
+        dataCacheDir=ppt->value;
+
     /* Read the PSD data */
     for(i=0;i<Nifo;i++) {
         memcpy(&(IFOdata[i].epoch),&segStart,sizeof(LIGOTimeGPS));
+        char *preparedKey=NULL,*preparedFile=NULL;
+        if(dataCacheDir) {
+            preparedKey=preparedDataKey(commandLine,IFOnames[i],caches?caches[i]:NULL,channels[i],Ntimeslides?timeslides[i]:NULL,psds?psds[i]:NULL,asds?asds[i]:NULL,SampleRate,SegmentLength,IFOdata[i].padding,segStart,GPSstart,PSDdatalength);
+            preparedFile=preparedDataFileName(dataCacheDir,IFOnames[i],preparedKey);
+            if(!preparedFile) XLAL_ERROR_NULL(XLAL_EFUNC);
+        }
         /* Check to see if an interpolation file is specified */
         interpFlag=0;
         interp=NULL;
@@ -887,6 +913,10 @@ LALInferenceIFOData *LALInferenceReadData(ProcessParamsTable *commandLine)
             if(*XLALGetErrnoPtr()) printf("XLErr: %s\n",XLALErrorString(*XLALGetErrnoPtr()));
             XLALDestroyRandomParams(datarandparam);
         }
+        else if(preparedFile && readPreparedData(&IFOdata[i],preparedFile,preparedKey))
+        {
+            fprintf(stderr,"Read prepared data for %s from %s\n",IFOnames[i],preparedFile);
+        }
         else{ /* Not using fake data, load the data from a cache file */
 
             LALCache *cache=NULL;
@@ -1177,7 +1207,11 @@ LALInferenceIFOData *LALInferenceReadData(ProcessParamsTable *commandLine)
             }
 
         XLALDestroyCache(cache); // Clean up cache
+
+        if(preparedFile) writePreparedData(&IFOdata[i],preparedFile,preparedKey);
         } /* End of data reading process */
+        XLALFree(preparedKey);
+        XLALFree(preparedFile);
 
         makeWhiteData(&(IFOdata[i]));
 
@@ -1311,6 +1345,112 @@ LALInferenceIFOData *LALInferenceReadData(ProcessParamsTable *commandLine)
     return headIFO;
 }
 
+/*
+ * Prepared-data cache: the PSD and the time and frequency domain data read
+ * from frames for one detector are saved to an HDF5 file, whose name is a
+ * hash of the options that select those data.  A later job with the same
+ * options then reads them back instead of reading frames, estimating the
+ * PSD and transforming the data again.  The whitened data depend on the
+ * frequency cutoffs of the job, so they are recomputed from these.
+ */
+static char *preparedDataKey(ProcessParamsTable *commandLine, const char *ifo, const char *cache, const char *channel, const char *timeslide, const char *psd, const char *asd, REAL8 srate, REAL8 seglen, REAL8 padding, LIGOTimeGPS segStart, LIGOTimeGPS psdStart, REAL8 psdLength)
+{
+  return XLALStringAppendFmt(NULL,
+      "ifo=%s cache=%s channel=%s srate=%.17g seglen=%.17g padding=%.17g"
+      " segstart=%" LAL_INT8_FORMAT " psdstart=%" LAL_INT8_FORMAT
+      " psdlength=%.17g timeslide=%s psd=%s asd=%s psdwelch=%d binfit=%d",
+      ifo, cache ? cache : "glob-frame-data", channel, srate, seglen, padding,
+      XLALGPSToINT8NS(&segStart), XLALGPSToINT8NS(&psdStart), psdLength,
+      timeslide ? timeslide : "0", psd ? psd : "", asd ? asd : "",
+      LALInferenceGetProcParamVal(commandLine, "--PSDwelch") != NULL,
+      LALInferenceGetProcParamVal(commandLine, "--binFit") != NULL);
+}
+
+static char *preparedDataFileName(const char *dir, const char *ifo, const char *key)
+{
+  UINT8 hash = 0xcbf29ce484222325ULL; /* FNV-1a */
+  const char *c;
+
+  if (!key)
+    XLAL_ERROR_NULL(XLAL_EFUNC);
+  for (c = key; *c; c++)
+    hash = (hash ^ (unsigned char)*c) * 0x100000001b3ULL;
+  return XLALStringAppendFmt(NULL, "%s/%s-data-%" LAL_UINT8_FORMAT ".hdf5", dir, ifo, hash);
+}
+
+/* read prepared data if the file exists and was written for the same
+ * options; returns 1 if the data were read, 0 otherwise */
+static int readPreparedData(LALInferenceIFOData *IFOdata, const char *filename, const char *key)
+{
+  LALH5File *file;
+  char *stored = NULL;
+  int len, match;
+
+  if (!LALInferenceCheckNonEmptyFile(filename))
+    return 0;
+  file = XLALH5FileOpen(filename, "r");
+  if (!file) {
+    XLALPrintWarning("Unable to open prepared data file %s; reading frames instead\n", filename);
+    XLALClearErrno();
+    return 0;
+  }
+
+  len = XLALH5FileQueryStringAttributeValue(NULL, 0, file, "key");
+  if (len >= 0)
+    stored = XLALMalloc(len + 1);
+  match = stored && XLALH5FileQueryStringAttributeValue(stored, len + 1, file, "key") == len && strcmp(stored, key) == 0;
+  XLALFree(stored);
+  if (match) {
+    IFOdata->oneSidedNoisePowerSpectrum = XLALH5FileReadREAL8FrequencySeries(file, "oneSidedNoisePowerSpectrum");
+    IFOdata->timeData = XLALH5FileReadREAL8TimeSeries(file, "timeData");
+    IFOdata->windowedTimeData = XLALH5FileReadREAL8TimeSeries(file, "windowedTimeData");
+    IFOdata->freqData = XLALH5FileReadCOMPLEX16FrequencySeries(file, "freqData");
+  }
+  XLALH5FileClose(file);
+
+  if (match && !(IFOdata->oneSidedNoisePowerSpectrum && IFOdata->timeData && IFOdata->windowedTimeData && IFOdata->freqData)) {
+    XLALDestroyREAL8FrequencySeries(IFOdata->oneSidedNoisePowerSpectrum);
+    XLALDestroyREAL8TimeSeries(IFOdata->timeData);
+    XLALDestroyREAL8TimeSeries(IFOdata->windowedTimeData);
+    XLALDestroyCOMPLEX16FrequencySeries(IFOdata->freqData);
+    IFOdata->oneSidedNoisePowerSpectrum = NULL;
+    IFOdata->timeData = IFOdata->windowedTimeData = NULL;
+    IFOdata->freqData = NULL;
+    match = 0;
+  }
+  if (!match) {
+    XLALPrintWarning("Prepared data file %s does not match the data options; reading frames instead\n", filename);
+    XLALClearErrno();
+  }
+  return match;
+}
+
+/* save prepared data; the file is written under a temporary name and then
+ * renamed, so that concurrent jobs never read a partial file */
+static void writePreparedData(LALInferenceIFOData *IFOdata, const char *filename, const char *key)
+{
+  char *tmpname = XLALStringAppendFmt(NULL, "%s.%d.tmp", filename, (int)getpid());
+  LALH5File *file = tmpname ? XLALH5FileOpen(tmpname, "w") : NULL;
+  int ok = file != NULL;
+
+  ok = ok && XLALH5FileAddStringAttribute(file, "key", key) == XLAL_SUCCESS;
+  ok = ok && XLALH5FileWriteREAL8FrequencySeries(file, "oneSidedNoisePowerSpectrum", IFOdata->oneSidedNoisePowerSpectrum) == XLAL_SUCCESS;
+  ok = ok && XLALH5FileWriteREAL8TimeSeries(file, "timeData", IFOdata->timeData) == XLAL_SUCCESS;
+  ok = ok && XLALH5FileWriteREAL8TimeSeries(file, "windowedTimeData", IFOdata->windowedTimeData) == XLAL_SUCCESS;
+  ok = ok && XLALH5FileWriteCOMPLEX16FrequencySeries(file, "freqData", IFOdata->freqData) == XLAL_SUCCESS;
+  if (file)
+    XLALH5FileClose(file);
+  ok = ok && rename(tmpname, filename) == 0;
+
+  if (!ok) {
+    XLALPrintWarning("Unable to save prepared data to %s\n", filename);
+    if (tmpname)
+      unlink(tmpname);
+    XLALClearErrno();
+  }
+  XLALFree(tmpname);
+}
+
 static void makeWhiteData(LALInferenceIFOData *IFOdata) {
   REAL8 deltaF = IFOdata->freqData->deltaF;
   REAL8 deltaT = IFOdata->timeData->deltaT;
@@ -2275,6 +2415,12 @@ LALInferenceVariables *LALInferencePrintInjectionSample(LALInferenceRunState *ru
     } else {
       model->roq_flag=0;
     }
+    if (LALInferenceGetProcParamVal(runState->commandLine, "--relative-binning")){
+      if (LALInferenceSetupRelativeBinning(runState, model) != XLAL_SUCCESS){
+        fprintf(stderr, "ERROR: unable to set up relative binning\n");
+        exit(1);
+      }
+    }
     LALInferenceVariables *injparams = XLALCalloc(1, sizeof(LALInferenceVariables));
     LALInferenceCopyVariables(model->params, injparams);
 
@@ -2592,7 +2738,7 @@ void LALInferenceSetupROQdata(LALInferenceIFOData *IFOdata, ProcessParamsTable *
     while (thisData) {
       thisData->roq = XLALMalloc(sizeof(LALInferenceROQData));
 
-      thisData->roq->weights_linear = XLALMalloc(n_basis_linear*sizeof(LALInferenceROQSplineWeights));
+      thisData->roq->weights_linear = NULL;
 
       sprintf(tmp, "--%s-roqweightsLinear", thisData->name);
       ppt = LALInferenceGetProcParamVal(commandLine,tmp);
@@ -2615,9 +2761,6 @@ void LALInferenceSetupROQdata(LALInferenceIFOData *IFOdata, ProcessParamsTable *
       fprintf(stderr, "basis_size = %d\n", n_basis_linear);
       fprintf(stderr, "time steps = %d\n", time_steps);
 
-      double *tmp_real_weight = malloc(time_steps*(sizeof(double)));
-      double *tmp_imag_weight = malloc(time_steps*(sizeof(double)));
-
       double *tmp_tcs = malloc(time_steps*(sizeof(double)));
 
       sprintf(tmp, "--roq-times");
@@ -2638,24 +2781,20 @@ void LALInferenceSetupROQdata(LALInferenceIFOData *IFOdata, ProcessParamsTable *
       for(unsigned int ii=0; ii<n_basis_linear;ii++){
 	for(unsigned int jj=0; jj<time_steps;jj++){
 	  fread(&(thisData->roq->weightsLinear[ii*time_steps + jj]), sizeof(double complex), 1, thisData->roq->weightsFileLinear);
-	  tmp_real_weight[jj] = creal(thisData->roq->weightsLinear[ii*time_steps + jj]);
-	  tmp_imag_weight[jj] = cimag(thisData->roq->weightsLinear[ii*time_steps + jj]);
 	}
-  //gsl_interp_accel is not thread-safe, and each OpenMP thread will need its
-  //own gsl_interp_accel object.
-	thisData->roq->weights_linear[ii].acc_real_weight_linear = NULL;
- 	thisData->roq->weights_linear[ii].acc_imag_weight_linear = NULL;
-
-	thisData->roq->weights_linear[ii].spline_real_weight_linear = gsl_spline_alloc (gsl_interp_cspline, time_steps);
-        gsl_spline_init(thisData->roq->weights_linear[ii].spline_real_weight_linear, tmp_tcs, tmp_real_weight, time_steps);
-
-        thisData->roq->weights_linear[ii].spline_imag_weight_linear = gsl_spline_alloc (gsl_interp_cspline, time_steps);
-        gsl_spline_init(thisData->roq->weights_linear[ii].spline_imag_weight_linear, tmp_tcs, tmp_imag_weight, time_steps);
       }
       fclose(thisData->roq->weightsFileLinear);
       thisData->roq->weightsFileLinear = NULL;
       fclose(tcFile);
 
+      /* lay the weights out time-major for interpolation in time in the likelihood */
+      thisData->roq->time_weights = LALInferenceCreateROQTimeWeights(thisData->roq->weightsLinear, tmp_tcs, time_steps, n_basis_linear);
+      if ( thisData->roq->time_weights == NULL ){
+	fprintf(stderr, "Error: could not tabulate the %s ROQ weights in time\n", thisData->name);
+	exit(1);
+      }
+      free(tmp_tcs);
+
       sprintf(tmp, "--%s-roqweightsQuadratic", thisData->name);
       ppt = LALInferenceGetProcParamVal(commandLine,tmp);
       thisData->roq->weightsQuadratic = (double*)malloc(n_basis_quadratic*sizeof(double));
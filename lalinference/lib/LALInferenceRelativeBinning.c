@@ -0,0 +1,411 @@
+/*
+ *  LALInferenceRelativeBinning.c: Relative binning (heterodyned) likelihood
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+#include <math.h>
+#include <string.h>
+#include <complex.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/Date.h>
+#include <lal/Sequence.h>
+#include <lal/FrequencySeries.h>
+#include <lal/TimeDelay.h>
+#include <lal/LALInference.h>
+#include <lal/LALInferenceTemplate.h>
+#include <lal/LALInferenceRelativeBinning.h>
+
+/* Phase difference that the post-Newtonian powers of f can accumulate
+ * between f_min and f, normalised to 2 pi at the ends of the band */
+static REAL8 RelativeBinningPhase(REAL8 f, REAL8 f_min, REAL8 f_max)
+{
+  static const REAL8 gammas[] = {-5.0/3.0, -2.0/3.0, 1.0, 5.0/3.0, 7.0/3.0};
+  REAL8 psi = 0.0;
+  UINT4 i;
+
+  for (i = 0; i < sizeof(gammas) / sizeof(gammas[0]); i++)
+  {
+    if (gammas[i] < 0)
+      psi -= LAL_TWOPI * pow(f / f_min, gammas[i]);
+    else
+      psi += LAL_TWOPI * pow(f / f_max, gammas[i]);
+  }
+  return psi;
+}
+
+REAL8Sequence *LALInferenceRelativeBinningFrequencies(REAL8 f_min, REAL8 f_max, REAL8 deltaF, REAL8 epsilon)
+{
+  REAL8Sequence *frequencies;
+  REAL8 psi_min, psi_max;
+  UINT4 kmin, kmax, klast, nbins, n, j;
+
+  XLAL_CHECK_NULL(f_min > 0 && f_max > f_min, XLAL_EINVAL, "Invalid frequency range [%g, %g]", f_min, f_max);
+  XLAL_CHECK_NULL(deltaF > 0 && epsilon > 0, XLAL_EINVAL, "deltaF and epsilon must be positive");
+
+  kmin = (UINT4) ceil(f_min / deltaF);
+  kmax = (UINT4) floor(f_max / deltaF);
+  XLAL_CHECK_NULL(kmax > kmin, XLAL_EINVAL, "No frequency bins between %g and %g", f_min, f_max);
+  f_min = kmin * deltaF;
+  f_max = kmax * deltaF;
+
+  psi_min = RelativeBinningPhase(f_min, f_min, f_max);
+  psi_max = RelativeBinningPhase(f_max, f_min, f_max);
+  nbins = (UINT4) ceil((psi_max - psi_min) / epsilon);
+  if (nbins > kmax - kmin)
+    nbins = kmax - kmin;
+
+  frequencies = XLALCreateREAL8Sequence(nbins + 1);
+  XLAL_CHECK_NULL(frequencies, XLAL_EFUNC);
+
+  /* the phase is monotonic, so find each edge by bisection */
+  frequencies->data[0] = f_min;
+  n = 1;
+  klast = kmin;
+  for (j = 1; j < nbins; j++)
+  {
+    const REAL8 target = psi_min + j * (psi_max - psi_min) / nbins;
+    REAL8 lo = f_min, hi = f_max;
+    UINT4 k, it;
+
+    for (it = 0; it < 64; it++)
+    {
+      const REAL8 mid = 0.5 * (lo + hi);
+      if (RelativeBinningPhase(mid, f_min, f_max) < target)
+        lo = mid;
+      else
+        hi = mid;
+    }
+    k = (UINT4) round(0.5 * (lo + hi) / deltaF);
+    if (k > klast && k < kmax)
+    {
+      frequencies->data[n++] = k * deltaF;
+      klast = k;
+    }
+  }
+  frequencies->data[n++] = f_max;
+
+  frequencies = XLALResizeREAL8Sequence(frequencies, 0, n);
+  XLAL_CHECK_NULL(frequencies, XLAL_EFUNC);
+  return frequencies;
+}
+
+LALInferenceRelativeBinningData *LALInferenceCreateRelativeBinningData(const LALInferenceIFOData *ifo,
+                                                                       const REAL8Sequence *frequencies,
+                                                                       const COMPLEX16 *h0plus,
+                                                                       const COMPLEX16 *h0cross,
+                                                                       REAL8 tau0, REAL8 scale)
+{
+  LALInferenceRelativeBinningData *rb;
+  REAL8 deltaF;
+  UINT4 nedges, nbins, kstart, kend, lower, upper, b, k;
+  int a;
+
+  XLAL_CHECK_NULL(ifo && ifo->freqData && ifo->oneSidedNoisePowerSpectrum, XLAL_EFAULT);
+  XLAL_CHECK_NULL(frequencies && frequencies->length >= 2 && h0plus && h0cross, XLAL_EFAULT);
+
+  deltaF = ifo->freqData->deltaF;
+  nedges = frequencies->length;
+  nbins = nedges - 1;
+  kstart = (UINT4) round(frequencies->data[0] / deltaF);
+  kend = (UINT4) round(frequencies->data[nedges - 1] / deltaF);
+  XLAL_CHECK_NULL(kend < ifo->freqData->data->length && kend < ifo->oneSidedNoisePowerSpectrum->data->length,
+                  XLAL_EINVAL, "Bin edges extend beyond the data of %s", ifo->name);
+  lower = (UINT4) ceil(ifo->fLow / deltaF);
+  upper = (UINT4) floor(ifo->fHigh / deltaF);
+
+  rb = XLALCalloc(1, sizeof(*rb));
+  XLAL_CHECK_NULL(rb, XLAL_ENOMEM);
+  rb->frequencies = XLALCreateREAL8Sequence(nedges);
+  rb->h0plus = XLALMalloc(nedges * sizeof(*rb->h0plus));
+  rb->h0cross = XLALMalloc(nedges * sizeof(*rb->h0cross));
+  for (a = 0; a < 2; a++)
+  {
+    rb->A0[a] = XLALCalloc(nbins, sizeof(COMPLEX16));
+    rb->A1[a] = XLALCalloc(nbins, sizeof(COMPLEX16));
+  }
+  for (a = 0; a < 3; a++)
+  {
+    rb->B0[a] = XLALCalloc(nbins, sizeof(COMPLEX16));
+    rb->B1[a] = XLALCalloc(nbins, sizeof(COMPLEX16));
+    rb->B2[a] = XLALCalloc(nbins, sizeof(COMPLEX16));
+  }
+  if (!rb->frequencies || !rb->h0plus || !rb->h0cross || !rb->A0[0] || !rb->A0[1] || !rb->A1[0] || !rb->A1[1]
+      || !rb->B0[0] || !rb->B0[1] || !rb->B0[2] || !rb->B1[0] || !rb->B1[1] || !rb->B1[2]
+      || !rb->B2[0] || !rb->B2[1] || !rb->B2[2])
+  {
+    LALInferenceDestroyRelativeBinningData(rb);
+    XLAL_ERROR_NULL(XLAL_ENOMEM);
+  }
+
+  memcpy(rb->frequencies->data, frequencies->data, nedges * sizeof(*frequencies->data));
+  for (b = 0; b < nedges; b++)
+  {
+    k = (UINT4) round(frequencies->data[b] / deltaF) - kstart;
+    rb->h0plus[b] = h0plus[k];
+    rb->h0cross[b] = h0cross[k];
+  }
+  rb->tau0 = tau0;
+  rb->dd = 0.0;
+
+  /* the last bin includes its upper edge */
+  for (b = 0; b < nbins; b++)
+  {
+    const UINT4 k0 = (UINT4) round(frequencies->data[b] / deltaF);
+    const UINT4 k1 = (UINT4) round(frequencies->data[b + 1] / deltaF) + (b + 1 == nbins ? 1 : 0);
+
+    for (k = k0; k < k1; k++)
+    {
+      if (k < lower || k > upper)
+        continue;
+      const REAL8 w = scale / ifo->oneSidedNoisePowerSpectrum->data->data[k];
+      const REAL8 x = (k - k0) * deltaF;
+      const COMPLEX16 shift = crect(cos(LAL_TWOPI * k * deltaF * tau0), -sin(LAL_TWOPI * k * deltaF * tau0));
+      const COMPLEX16 d = ifo->freqData->data->data[k];
+      const COMPLEX16 hp = h0plus[k - kstart] * shift;
+      const COMPLEX16 hc = h0cross[k - kstart] * shift;
+      const COMPLEX16 dhp = w * d * conj(hp), dhc = w * d * conj(hc);
+      const COMPLEX16 hh[3] = {w * hp * conj(hp), w * hc * conj(hc), w * hp * conj(hc)};
+
+      rb->A0[0][b] += dhp;
+      rb->A0[1][b] += dhc;
+      rb->A1[0][b] += dhp * x;
+      rb->A1[1][b] += dhc * x;
+      for (a = 0; a < 3; a++)
+      {
+        rb->B0[a][b] += hh[a];
+        rb->B1[a][b] += hh[a] * x;
+        rb->B2[a][b] += hh[a] * x * x;
+      }
+      rb->dd += w * (creal(d) * creal(d) + cimag(d) * cimag(d));
+    }
+  }
+
+  return rb;
+}
+
+void LALInferenceDestroyRelativeBinningData(LALInferenceRelativeBinningData *rb)
+{
+  int a;
+
+  if (!rb)
+    return;
+  XLALDestroyREAL8Sequence(rb->frequencies);
+  XLALFree(rb->h0plus);
+  XLALFree(rb->h0cross);
+  for (a = 0; a < 2; a++)
+  {
+    XLALFree(rb->A0[a]);
+    XLALFree(rb->A1[a]);
+  }
+  for (a = 0; a < 3; a++)
+  {
+    XLALFree(rb->B0[a]);
+    XLALFree(rb->B1[a]);
+    XLALFree(rb->B2[a]);
+  }
+  XLALFree(rb);
+}
+
+/* Ratio of the template to the fiducial waveform of one polarisation at a
+ * bin edge; zero where the fiducial waveform vanishes */
+static COMPLEX16 RelativeBinningRatio(COMPLEX16 h, COMPLEX16 h0, COMPLEX16 factor)
+{
+  return h0 != 0.0 ? h * factor / h0 : 0.0;
+}
+
+int LALInferenceRelativeBinningInnerProducts(const LALInferenceRelativeBinningData *rb,
+                                             const COMPLEX16 *hplus, const COMPLEX16 *hcross,
+                                             const COMPLEX16 *cal, REAL8 Fplus, REAL8 Fcross, REAL8 tau,
+                                             REAL8 *dd, REAL8 *hh, COMPLEX16 *dh)
+{
+  const REAL8 *f;
+  REAL8 sum_hh = 0.0;
+  COMPLEX16 sum_dh = 0.0, factor, rp, rc;
+  UINT4 nbins, b;
+
+  XLAL_CHECK(rb && hplus && hcross && dd && hh && dh, XLAL_EFAULT);
+
+  f = rb->frequencies->data;
+  nbins = rb->frequencies->length - 1;
+
+  /* the time shift relative to the fiducial waveform is part of the ratio */
+  factor = crect(cos(LAL_TWOPI * f[0] * (tau - rb->tau0)), -sin(LAL_TWOPI * f[0] * (tau - rb->tau0)));
+  if (cal)
+    factor *= cal[0];
+  rp = RelativeBinningRatio(hplus[0], rb->h0plus[0], factor);
+  rc = RelativeBinningRatio(hcross[0], rb->h0cross[0], factor);
+
+  for (b = 0; b < nbins; b++)
+  {
+    COMPLEX16 rp1, rc1, r1p, r1c, Tpc;
+    REAL8 Tpp, Tcc;
+
+    factor = crect(cos(LAL_TWOPI * f[b + 1] * (tau - rb->tau0)), -sin(LAL_TWOPI * f[b + 1] * (tau - rb->tau0)));
+    if (cal)
+      factor *= cal[b + 1];
+    rp1 = RelativeBinningRatio(hplus[b + 1], rb->h0plus[b + 1], factor);
+    rc1 = RelativeBinningRatio(hcross[b + 1], rb->h0cross[b + 1], factor);
+
+    /* linear interpolation of the ratios across the bin */
+    r1p = (rp1 - rp) / (f[b + 1] - f[b]);
+    r1c = (rc1 - rc) / (f[b + 1] - f[b]);
+
+    sum_dh += Fplus * (rb->A0[0][b] * conj(rp) + rb->A1[0][b] * conj(r1p))
+            + Fcross * (rb->A0[1][b] * conj(rc) + rb->A1[1][b] * conj(r1c));
+
+    Tpp = creal(rb->B0[0][b]) * creal(rp * conj(rp)) + 2.0 * creal(rb->B1[0][b]) * creal(rp * conj(r1p))
+        + creal(rb->B2[0][b]) * creal(r1p * conj(r1p));
+    Tcc = creal(rb->B0[1][b]) * creal(rc * conj(rc)) + 2.0 * creal(rb->B1[1][b]) * creal(rc * conj(r1c))
+        + creal(rb->B2[1][b]) * creal(r1c * conj(r1c));
+    Tpc = rb->B0[2][b] * rp * conj(rc) + rb->B1[2][b] * (rp * conj(r1c) + r1p * conj(rc))
+        + rb->B2[2][b] * r1p * conj(r1c);
+    sum_hh += Fplus * Fplus * Tpp + Fcross * Fcross * Tcc + 2.0 * Fplus * Fcross * creal(Tpc);
+
+    rp = rp1;
+    rc = rc1;
+  }
+
+  *dd = rb->dd;
+  *hh = sum_hh;
+  *dh = sum_dh;
+  return XLAL_SUCCESS;
+}
+
+/* Sky position and geocentre time of params, as used by the likelihood */
+static void RelativeBinningSkyPosition(LALInferenceVariables *params, LALInferenceIFOData *data,
+                                       REAL8 *ra, REAL8 *dec, REAL8 *time)
+{
+  INT4 SKY_FRAME = 0;
+
+  if (LALInferenceCheckVariable(params, "SKY_FRAME"))
+    SKY_FRAME = *(INT4 *) LALInferenceGetVariable(params, "SKY_FRAME");
+  if (SKY_FRAME == 0)
+  {
+    *ra = LALInferenceGetREAL8Variable(params, "rightascension");
+    *dec = LALInferenceGetREAL8Variable(params, "declination");
+    *time = LALInferenceGetREAL8Variable(params, "time");
+  }
+  else
+  {
+    REAL8 t0 = LALInferenceGetREAL8Variable(params, "t0");
+    REAL8 alph = acos(LALInferenceGetREAL8Variable(params, "cosalpha"));
+    REAL8 theta = LALInferenceGetREAL8Variable(params, "azimuth");
+    LALInferenceDetFrameToEquatorial(data->detector, data->next->detector, t0, alph, theta, time, ra, dec);
+  }
+}
+
+int LALInferenceSetupRelativeBinning(LALInferenceRunState *runState, LALInferenceModel *model)
+{
+  LALInferenceIFOData *data, *ifo;
+  ProcessParamsTable *ppt;
+  REAL8Sequence *edges;
+  REAL8 epsilon = 0.1, f_min = INFINITY, f_max = 0.0, deltaF;
+
+  XLAL_CHECK(runState && runState->data && model, XLAL_EFAULT);
+  XLAL_CHECK(model->domain == LAL_SIM_DOMAIN_FREQUENCY, XLAL_EINVAL, "Relative binning requires a frequency-domain approximant");
+  XLAL_CHECK(!model->roq_flag, XLAL_EINVAL, "Relative binning cannot be used together with ROQ");
+  XLAL_CHECK(!LALInferenceGetProcParamVal(runState->commandLine, "--studentTLikelihood"), XLAL_EINVAL,
+             "Relative binning does not support the Student-t likelihood");
+
+  data = runState->data;
+  deltaF = data->freqData->deltaF;
+  for (ifo = data; ifo; ifo = ifo->next)
+  {
+    XLAL_CHECK(ifo->freqData->deltaF == deltaF, XLAL_EINVAL, "Relative binning requires the same frequency resolution in all detectors");
+    f_min = fmin(f_min, ifo->fLow);
+    f_max = fmax(f_max, ifo->fHigh);
+  }
+
+  ppt = LALInferenceGetProcParamVal(runState->commandLine, "--relative-binning-epsilon");
+  if (ppt)
+    epsilon = atof(ppt->value);
+
+  edges = LALInferenceRelativeBinningFrequencies(f_min, f_max, deltaF, epsilon);
+  XLAL_CHECK(edges, XLAL_EFUNC);
+
+  model->relbin = XLALCalloc(1, sizeof(*model->relbin));
+  XLAL_CHECK(model->relbin, XLAL_ENOMEM);
+
+  /* The summary data are shared between models; the fiducial waveform is
+   * generated through the same Sequence template as the bin edges, on the
+   * full frequency grid, so that both follow the same conventions. */
+  if (!data->relbin)
+  {
+    const UINT4 kstart = (UINT4) round(edges->data[0] / deltaF);
+    const UINT4 nfull = (UINT4) round(edges->data[edges->length - 1] / deltaF) - kstart + 1;
+    REAL8 ra, dec, time, instant;
+    INT4 errnum = 0;
+    UINT4 k;
+
+    RelativeBinningSkyPosition(model->params, data, &ra, &dec, &time);
+
+    model->relbin->frequencies = XLALCreateREAL8Sequence(nfull);
+    XLAL_CHECK(model->relbin->frequencies, XLAL_EFUNC);
+    for (k = 0; k < nfull; k++)
+      model->relbin->frequencies->data[k] = (kstart + k) * deltaF;
+
+    XLAL_TRY(LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(model), errnum);
+    XLAL_CHECK(errnum == XLAL_SUCCESS && model->relbin->hptilde && model->relbin->hctilde, XLAL_EFUNC,
+               "Failed to generate the fiducial waveform for relative binning");
+
+    /* the template sets "time" to its reference epoch */
+    instant = LALInferenceGetREAL8Variable(model->params, "time");
+    LALInferenceSetVariable(model->params, "time", &time);
+
+    for (ifo = data; ifo; ifo = ifo->next)
+    {
+      LIGOTimeGPS GPSlal;
+      const UINT4 N = ifo->timeData->data->length;
+      REAL8 tau0;
+
+      XLALGPSSetREAL8(&GPSlal, time);
+      tau0 = time - instant + XLALTimeDelayFromEarthCenter(ifo->detector->location, ra, dec, &GPSlal);
+      ifo->relbin = LALInferenceCreateRelativeBinningData(ifo, edges, model->relbin->hptilde->data->data,
+                                                          model->relbin->hctilde->data->data, tau0,
+                                                          2.0 / (N * ifo->timeData->deltaT));
+      XLAL_CHECK(ifo->relbin, XLAL_EFUNC);
+    }
+
+    XLALDestroyREAL8Sequence(model->relbin->frequencies);
+    XLALDestroyCOMPLEX16FrequencySeries(model->relbin->hptilde);
+    XLALDestroyCOMPLEX16FrequencySeries(model->relbin->hctilde);
+    model->relbin->hptilde = model->relbin->hctilde = NULL;
+
+    XLALPrintInfo("%s: %u relative binning bins between %g and %g Hz\n", __func__,
+                  edges->length - 1, edges->data[0], edges->data[edges->length - 1]);
+  }
+
+  model->relbin->frequencies = edges;
+  model->relbin->calFactor = XLALCreateCOMPLEX16Sequence(edges->length);
+  XLAL_CHECK(model->relbin->calFactor, XLAL_EFUNC);
+
+  return XLAL_SUCCESS;
+}
+
+void LALInferenceDestroyRelativeBinningModel(LALInferenceModel *model)
+{
+  if (!model || !model->relbin)
+    return;
+  XLALDestroyREAL8Sequence(model->relbin->frequencies);
+  if (model->relbin->hptilde) XLALDestroyCOMPLEX16FrequencySeries(model->relbin->hptilde);
+  if (model->relbin->hctilde) XLALDestroyCOMPLEX16FrequencySeries(model->relbin->hctilde);
+  XLALDestroyCOMPLEX16Sequence(model->relbin->calFactor);
+  XLALFree(model->relbin);
+  model->relbin = NULL;
+}
@@ -0,0 +1,111 @@
+/*
+ *  LALInferenceRelativeBinning.h: Relative binning (heterodyned) likelihood
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+#ifndef LALINFERENCERELATIVEBINNING_H
+#define LALINFERENCERELATIVEBINNING_H
+
+#include <lal/LALDatatypes.h>
+#include <lal/LALInference.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup LALInferenceRelativeBinning_h Header LALInferenceRelativeBinning.h
+ * \ingroup lalinference_general
+ *
+ * \brief Relative binning likelihood.
+ *
+ * The ratio of the template to a fiducial waveform close to the
+ * maximum-likelihood point is smooth in frequency, so it can be replaced by
+ * a linear function in each of a few hundred frequency bins (Zackay, Dai &
+ * Venumadhav, arXiv:1806.08792).  The inner products with the data and the
+ * template then reduce to sums over the bins of summary data, which are
+ * computed once from the fiducial waveform, and templates only need to be
+ * generated at the bin edges with XLALSimInspiralChooseFDWaveformSequence().
+ *
+ * The summary data are kept separately for the two polarisations so that no
+ * fiducial antenna pattern is needed, and the bin edge frequencies are
+ * multiples of the frequency resolution of the data.
+ *
+ * ### Command line ###
+ *
+ * <tt>--relative-binning</tt> enables the relative binning likelihood, taking
+ * the fiducial waveform from the starting parameters of the sampler, and
+ * <tt>--relative-binning-epsilon</tt> sets the tolerated phase error in each
+ * bin (default 0.1 rad).
+ */
+/** @{ */
+
+/**
+ * Bin edges for relative binning between f_min and f_max.  Edges are placed
+ * wherever the maximum phase difference allowed by the post-Newtonian powers
+ * f^(-5/3), f^(-2/3), f, f^(5/3) and f^(7/3) grows by epsilon, rounded to
+ * multiples of deltaF.
+ */
+REAL8Sequence *LALInferenceRelativeBinningFrequencies(REAL8 f_min, REAL8 f_max, REAL8 deltaF, REAL8 epsilon);
+
+#ifndef SWIG   /* exclude from SWIG interface */
+
+/**
+ * Compute the summary data of one detector.  h0plus and h0cross are the
+ * fiducial polarisations on the frequency grid starting at
+ * frequencies->data[0] and ending at the last bin edge, tau0 the time shift
+ * of the fiducial waveform into the detector, and scale the factor that
+ * turns 1/psd into the inner product weight.  Frequencies outside
+ * [ifo->fLow, ifo->fHigh] do not contribute.
+ */
+LALInferenceRelativeBinningData *LALInferenceCreateRelativeBinningData(const LALInferenceIFOData *ifo,
+                                                                       const REAL8Sequence *frequencies,
+                                                                       const COMPLEX16 *h0plus,
+                                                                       const COMPLEX16 *h0cross,
+                                                                       REAL8 tau0, REAL8 scale);
+
+/** Free the summary data of one detector */
+void LALInferenceDestroyRelativeBinningData(LALInferenceRelativeBinningData *rb);
+
+/**
+ * Inner products <d|d>, <h|h> and <d|h> of one detector, where the template
+ * h = (Fplus hplus + Fcross hcross) exp(-2 pi i f tau) cal is given at the
+ * bin edges; cal may be NULL.
+ */
+int LALInferenceRelativeBinningInnerProducts(const LALInferenceRelativeBinningData *rb,
+                                             const COMPLEX16 *hplus, const COMPLEX16 *hcross,
+                                             const COMPLEX16 *cal, REAL8 Fplus, REAL8 Fcross, REAL8 tau,
+                                             REAL8 *dd, REAL8 *hh, COMPLEX16 *dh);
+
+#endif /* SWIG */
+
+/**
+ * Set up relative binning for model, computing the summary data for the
+ * detectors in runState->data from the parameters of the model if they do
+ * not already exist.
+ */
+int LALInferenceSetupRelativeBinning(LALInferenceRunState *runState, LALInferenceModel *model);
+
+/** Free the relative binning buffers of model */
+void LALInferenceDestroyRelativeBinningModel(LALInferenceModel *model);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LALINFERENCERELATIVEBINNING_H */
@@ -22,6 +22,12 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include <lal/LALConfig.h>
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
 
 #include <lal/LALStdio.h>
 #include <lal/LALStdlib.h>
@@ -81,10 +87,185 @@
 
 #define max(a,b) (((a)>(b))?(a):(b))
 
-static void median_cleanup_REAL8( REAL8FrequencySeries *work, UINT4 n );
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
+/*
+ * The line tests are run one after the other on the same PSD data, and
+ * each needs the periodograms of all its segments.  These are computed
+ * once, in parallel over the segments, and cached for the last data record
+ * seen; a later call with the same data, segmentation and window reuses
+ * them.  The checksum only selects a candidate: the data and window are
+ * kept and compared in full before the periodograms are reused.  They are
+ * stored bin by bin, so that the statistics of a frequency bin read
+ * contiguous memory.  The cache persists between calls, so it uses the
+ * standard allocator.
+ */
+struct RemoveLinesPeriodograms {
+  UINT8 checksum; /* of the data and the window */
+  REAL8 *data; /* copy of the data record */
+  REAL8 *window; /* copy of the window, or NULL if there was none */
+  UINT4 winlen; /* length of the window */
+  LIGOTimeGPS epoch;
+  REAL8 deltaT;
+  UINT4 reclen, seglen, stride;
+  UINT4 numseg, numbins;
+  REAL8 f0, deltaF;
+  LALUnit dataUnits, sampleUnits;
+  REAL8 *power; /* power[k * numseg + seg] for bin k of segment seg */
+};
+
+static struct RemoveLinesPeriodograms RemoveLinesCache;
+#ifdef LAL_PTHREAD_LOCK
+static pthread_mutex_t RemoveLinesCacheLock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static const struct RemoveLinesPeriodograms *RemoveLinesPeriodogramsAcquire(
+    const REAL8TimeSeries *tseries, UINT4 seglen, UINT4 stride,
+    const REAL8Window *window, const REAL8FFTPlan *plan );
+static void RemoveLinesPeriodogramsRelease( void );
 static double chisqr(int Dof, double Cv);
 static double igf(double S, double Z);
 
+/* FNV-1a hash of the bit patterns of an array of doubles */
+static UINT8 RemoveLinesChecksum( UINT8 sum, const REAL8 *data, size_t n )
+{
+  size_t i;
+  for ( i = 0; i < n; ++i )
+  {
+    UINT8 bits;
+    memcpy( &bits, data + i, sizeof( bits ) );
+    sum = ( sum ^ bits ) * 0x100000001b3ULL;
+  }
+  return sum;
+}
+
+/* return the periodograms of the segments of tseries, computing them if
+ * they are not cached already; the cache is locked until
+ * RemoveLinesPeriodogramsRelease() is called */
+static const struct RemoveLinesPeriodograms *RemoveLinesPeriodogramsAcquire(
+    const REAL8TimeSeries *tseries, UINT4 seglen, UINT4 stride,
+    const REAL8Window *window, const REAL8FFTPlan *plan )
+{
+  struct RemoveLinesPeriodograms *cache = &RemoveLinesCache;
+  const UINT4 reclen = tseries->data->length;
+  const UINT4 numseg = 1 + (reclen - seglen)/stride;
+  const UINT4 numbins = seglen/2 + 1;
+  UINT8 checksum = 0xcbf29ce484222325ULL;
+  REAL8 *power, *data, *windata;
+  LALUnit sampleUnits;
+  UINT4 seg;
+  int failed = 0;
+
+  checksum = RemoveLinesChecksum( checksum, tseries->data->data, reclen );
+  if ( window )
+    checksum = RemoveLinesChecksum( checksum, window->data->data, window->data->length );
+
+#ifdef LAL_PTHREAD_LOCK
+  (void) pthread_mutex_lock( &RemoveLinesCacheLock );
+#endif
+
+  if ( cache->power && cache->checksum == checksum
+      && XLALGPSCmp( &cache->epoch, &tseries->epoch ) == 0
+      && cache->deltaT == tseries->deltaT && cache->f0 == tseries->f0
+      && XLALUnitCompare( &cache->dataUnits, &tseries->sampleUnits ) == 0
+      && cache->reclen == reclen && cache->seglen == seglen && cache->stride == stride
+      && memcmp( cache->data, tseries->data->data, reclen * sizeof( *cache->data ) ) == 0
+      && ( window ? cache->window && cache->winlen == window->data->length
+           && memcmp( cache->window, window->data->data, cache->winlen * sizeof( *cache->window ) ) == 0 : ! cache->window ) )
+    return cache;
+
+  /* compute units of the periodograms */
+  if ( ! XLALUnitSquare( &sampleUnits, &tseries->sampleUnits )
+      || ! XLALUnitMultiply( &sampleUnits, &sampleUnits, &lalSecondUnit ) )
+  {
+    RemoveLinesPeriodogramsRelease();
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+
+  power = malloc( (size_t)numbins * numseg * sizeof( *power ) );
+  data = malloc( reclen * sizeof( *data ) );
+  windata = window ? malloc( window->data->length * sizeof( *windata ) ) : NULL;
+  if ( ! power || ! data || ( window && ! windata ) )
+  {
+    free( power );
+    free( data );
+    free( windata );
+    RemoveLinesPeriodogramsRelease();
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  }
+  memcpy( data, tseries->data->data, reclen * sizeof( *data ) );
+  if ( window )
+    memcpy( windata, window->data->data, window->data->length * sizeof( *windata ) );
+
+  /* the segments are independent, so they are transformed in parallel,
+   * each thread with its own periodogram and view of the data */
+#pragma omp parallel
+  {
+    REAL8FrequencySeries *periodogram = XLALCreateREAL8FrequencySeries( "periodogram", &tseries->epoch, 0.0, 0.0, &lalDimensionlessUnit, numbins );
+    REAL8TimeSeries segment = *tseries;
+    REAL8Vector segdata;
+    UINT4 k;
+
+    segdata.length = seglen;
+    segment.data = &segdata;
+
+#pragma omp for schedule(dynamic)
+    for ( seg = 0; seg < numseg; ++seg )
+    {
+      segdata.data = tseries->data->data + (size_t)seg * stride;
+      if ( ! periodogram || XLALREAL8ModifiedPeriodogram( periodogram, &segment, window, plan ) == XLAL_FAILURE )
+      {
+#pragma omp atomic write
+        failed = 1;
+        continue;
+      }
+      for ( k = 0; k < numbins; ++k )
+        power[(size_t)k * numseg + seg] = periodogram->data->data[k];
+    }
+
+    XLALDestroyREAL8FrequencySeries( periodogram );
+  }
+  if ( failed )
+  {
+    free( power );
+    free( data );
+    free( windata );
+    RemoveLinesPeriodogramsRelease();
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+
+  free( cache->power );
+  free( cache->data );
+  free( cache->window );
+  cache->checksum    = checksum;
+  cache->data        = data;
+  cache->window      = windata;
+  cache->winlen      = window ? window->data->length : 0;
+  cache->epoch       = tseries->epoch;
+  cache->deltaT      = tseries->deltaT;
+  cache->reclen      = reclen;
+  cache->seglen      = seglen;
+  cache->stride      = stride;
+  cache->numseg      = numseg;
+  cache->numbins     = numbins;
+  cache->f0          = tseries->f0;
+  cache->deltaF      = 1.0 / ( seglen * tseries->deltaT );
+  cache->dataUnits   = tseries->sampleUnits;
+  cache->sampleUnits = sampleUnits;
+  cache->power       = power;
+
+  return cache;
+}
+
+static void RemoveLinesPeriodogramsRelease( void )
+{
+#ifdef LAL_PTHREAD_LOCK
+  (void) pthread_mutex_unlock( &RemoveLinesCacheLock );
+#endif
+}
+
 int LALInferenceRemoveLinesChiSquared(
     REAL8FrequencySeries        *spectrum,
     const REAL8TimeSeries       *tseries,
@@ -95,11 +276,9 @@ int LALInferenceRemoveLinesChiSquared(
     REAL8                       *pvalues
     )
 {
-  REAL8FrequencySeries *work; /* array of frequency series */
-  REAL8 *bin; /* array of bin values */
+  const struct RemoveLinesPeriodograms *periodograms;
   UINT4 reclen; /* length of entire data record */
   UINT4 numseg;
-  UINT4 seg;
   UINT4 k,l;
 
   if ( ! spectrum || ! tseries || ! plan )
@@ -119,121 +298,55 @@ int LALInferenceRemoveLinesChiSquared(
   if ( spectrum->data->length != seglen/2 + 1 )
     XLAL_ERROR( XLAL_EBADLEN );
 
-  /* create frequency series data workspaces */
-  work = XLALCalloc( numseg, sizeof( *work ) );
-  if ( ! work )
-    XLAL_ERROR( XLAL_ENOMEM );
-  for ( seg = 0; seg < numseg; ++seg )
-  {
-    work[seg].data = XLALCreateREAL8Vector( spectrum->data->length );
-    if ( ! work[seg].data )
-    {
-      median_cleanup_REAL8( work, numseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-  }
-
-  for ( seg = 0; seg < numseg; ++seg )
-  {
-    REAL8Vector savevec; /* save the time series data vector */
-    int code;
-
-    /* save the time series data vector */
-    savevec = *tseries->data;
-
-    /* set the data vector to be appropriate for the even segment */
-    tseries->data->length  = seglen;
-    tseries->data->data   += seg * stride;
-
-    /* compute the modified periodogram for the even segment */
-    code = XLALREAL8ModifiedPeriodogram( work + seg, tseries, window, plan );
-
-    /* restore the time series data vector to its original state */
-    *tseries->data = savevec;
-
-    /* now check for failure of the XLAL routine */
-    if ( code == XLAL_FAILURE )
-    {
-      median_cleanup_REAL8( work, numseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-  }
-
-  /* create array to hold a particular frequency bin data */
-  bin = XLALMalloc( numseg * sizeof( *bin ) );
-  if ( ! bin )
-  {
-    median_cleanup_REAL8( work, numseg ); /* cleanup */
-    XLAL_ERROR( XLAL_ENOMEM );
-  }
-
-  double meanVal = 0, normVal = 0;
+  periodograms = RemoveLinesPeriodogramsAcquire( tseries, seglen, stride, window, plan );
+  if ( ! periodograms )
+    XLAL_ERROR( XLAL_EFUNC );
 
   UINT4 numBins = 100;
-  int binIndex;
-  float Observed[numBins];
   float Expected[numBins];
   int min = 0; int max = 100;
-  int count;
+  int count = numseg;
   float interval = (float)(max - min ) / numBins;
-  double CriticalValue = 0.0;
-  double XSqr, XSqrTerm;
-  double bin_val, expected_val;
 
-  for ( k = 0; k < spectrum->data->length; ++k ) {
-      pvalues[k] = 0.0;
-  }
-  
+  /* each frequency bin is normalised by its mean, so the expected
+   * histogram is the same for all of them */
+  for ( l = 0; l < numBins; ++l )
+    Expected[l] = count * chisqr(2,l*interval + min);
 
-  /* now loop over frequency bins and compute the median-mean */
+  /* now loop over frequency bins and compute the chi-squared statistic of
+   * the histogram of the normalised segment values; the bins are
+   * independent, and each reads its segment values contiguously */
+#pragma omp parallel for schedule(static) private(l)
   for ( k = 0; k < spectrum->data->length; ++k )
   {
-    /* assign array of even segment values to bin array for this freq bin */
-    for ( seg = 0; seg < numseg; ++seg ) {
-      bin[seg] = work[seg].data->data[k];
-      meanVal = meanVal + work[seg].data->data[k];
-    }
+    const REAL8 *bin = periodograms->power + (size_t)k * numseg;
+    float Observed[numBins];
+    double meanVal = 0.0, CriticalValue = 0.0;
+    UINT4 seg;
 
-    meanVal = meanVal / (double) numseg;
+    for ( seg = 0; seg < numseg; ++seg )
+      meanVal += bin[seg];
+    meanVal /= (double) numseg;
 
-    for ( l = 0; l < numBins; ++l ) {
-        Observed[l] = 0.0;
-        Expected[l] = 0.0;
-    }
+    for ( l = 0; l < numBins; ++l )
+      Observed[l] = 0.0;
 
-    count = 0.0;
     for ( seg = 0; seg < numseg; ++seg ) {
-      normVal = 2 * bin[seg] / meanVal;
-      binIndex = (int)((normVal- min)/interval);
-
-      Observed[binIndex] = Observed[binIndex] + 1;
-      count = count + 1;
-    }  
-
-    CriticalValue = 0.0;
+      double binIndex = (2 * bin[seg] / meanVal - min)/interval;
+      /* values beyond the histogram are in none of its bins */
+      if ( binIndex >= 0 && binIndex < numBins )
+        Observed[(int)binIndex] += 1;
+    }
 
     for ( l = 0; l < numBins; ++l ) {
-
-      bin_val = l*interval + min;
-      expected_val = count * chisqr(2,bin_val);
-
-      Expected[l] = expected_val;
-
-      XSqr = Observed[l] - Expected[l];
-
-      XSqrTerm = (float) ((XSqr * XSqr) / Expected[l]);
-
-      CriticalValue = CriticalValue + XSqrTerm;
-
+      double XSqr = Observed[l] - Expected[l];
+      CriticalValue += (float) ((XSqr * XSqr) / Expected[l]);
     }
 
     pvalues[k] = 1.0/CriticalValue;
-
   }
 
-  /* free the workspace data */
-  XLALFree( bin );
-  median_cleanup_REAL8( work, numseg );
+  RemoveLinesPeriodogramsRelease();
 
   return 0;
 }
@@ -287,18 +400,6 @@ static double igf(double S, double Z)
     return Sum * Sc;
 }
 
-static void median_cleanup_REAL8( REAL8FrequencySeries *work, UINT4 n )
-{
-  int saveErrno = xlalErrno;
-  UINT4 i;
-  for ( i = 0; i < n; ++i )
-    if ( work[i].data )
-      XLALDestroyREAL8Vector( work[i].data );
-  XLALFree( work );
-  xlalErrno = saveErrno;
-  return;
-}
-
 int LALInferenceRemoveLinesKS(
     REAL8FrequencySeries        *spectrum,
     const REAL8TimeSeries       *tseries,
@@ -309,11 +410,9 @@ int LALInferenceRemoveLinesKS(
     REAL8                       *pvalues
     )
 {
-  REAL8FrequencySeries *work; /* array of frequency series */
-  REAL8 *bin; /* array of bin values */
+  const struct RemoveLinesPeriodograms *periodograms;
   UINT4 reclen; /* length of entire data record */
   UINT4 numseg;
-  UINT4 seg;
   UINT4 k,l;
 
   if ( ! spectrum || ! tseries || ! plan )
@@ -332,156 +431,72 @@ int LALInferenceRemoveLinesKS(
     XLAL_ERROR( XLAL_EBADLEN );
   if ( spectrum->data->length != seglen/2 + 1 )
     XLAL_ERROR( XLAL_EBADLEN );
-  /* create frequency series data workspaces */
-  work = XLALCalloc( numseg, sizeof( *work ) );
-  if ( ! work )
-    XLAL_ERROR( XLAL_ENOMEM );
-  for ( seg = 0; seg < numseg; ++seg )
-  {
-    work[seg].data = XLALCreateREAL8Vector( spectrum->data->length );
-    if ( ! work[seg].data )
-    {
-      median_cleanup_REAL8( work, numseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-  }
-
-  for ( seg = 0; seg < numseg; ++seg )
-  {
-    REAL8Vector savevec; /* save the time series data vector */
-    int code;
-
-    /* save the time series data vector */
-    savevec = *tseries->data;
 
-    /* set the data vector to be appropriate for the even segment */
-    tseries->data->length  = seglen;
-    tseries->data->data   += seg * stride;
-
-    /* compute the modified periodogram for the even segment */
-    code = XLALREAL8ModifiedPeriodogram( work + seg, tseries, window, plan );
-
-    /* restore the time series data vector to its original state */
-    *tseries->data = savevec;
-
-    /* now check for failure of the XLAL routine */
-    if ( code == XLAL_FAILURE )
-    {
-      median_cleanup_REAL8( work, numseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-  }
-
-  /* create array to hold a particular frequency bin data */
-  bin = XLALMalloc( numseg * sizeof( *bin ) );
-  if ( ! bin )
-  {
-    median_cleanup_REAL8( work, numseg ); /* cleanup */
-    XLAL_ERROR( XLAL_ENOMEM );
-  }
-
-  double meanVal = 0, normVal = 0;
+  periodograms = RemoveLinesPeriodogramsAcquire( tseries, seglen, stride, window, plan );
+  if ( ! periodograms )
+    XLAL_ERROR( XLAL_EFUNC );
 
   UINT4 numBins = 100;
-  int binIndex;
-  float Observed[numBins];
-  float Expected[numBins];
-  float ObservedCDF[numBins];
   float ExpectedCDF[numBins];
   int min = 0; int max = 100;
-  int count;
+  int count = numseg;
   float interval = (float)(max - min ) / numBins;
-  float ObservedSum, ExpectedSum;
-  double KS, KSVal, nKSsquared;
-  double bin_val, expected_val;
-
-  for ( k = 0; k < spectrum->data->length; ++k ) {
-      pvalues[k] = 0.0;
+  float ExpectedSum;
+
+  /* each frequency bin is normalised by its mean, so the expected
+   * distribution is the same for all of them */
+  ExpectedSum = 0.0;
+  for ( l = 0; l < numBins; ++l ) {
+    ExpectedSum = ExpectedSum + count * chisqr(2,l*interval + min);
+    ExpectedCDF[l] = ExpectedSum;
   }
+  for ( l = 0; l < numBins; ++l )
+    ExpectedCDF[l] = ExpectedCDF[l]/ExpectedSum;
 
-  /* now loop over frequency bins and compute the median-mean */
+  /* now loop over frequency bins and compute the Kolmogorov-Smirnov
+   * statistic of the normalised segment values; the bins are independent,
+   * and each reads its segment values contiguously */
+#pragma omp parallel for schedule(static) private(l)
   for ( k = 0; k < spectrum->data->length; ++k )
   {
-    /* assign array of even segment values to bin array for this freq bin */
-    for ( seg = 0; seg < numseg; ++seg ) {
-      bin[seg] = work[seg].data->data[k];
-      meanVal = meanVal + work[seg].data->data[k];
-    }
+    const REAL8 *bin = periodograms->power + (size_t)k * numseg;
+    float ObservedCDF[numBins];
+    float ObservedSum;
+    double meanVal = 0.0, KS = 0.0, nKSsquared;
+    UINT4 seg;
 
-    meanVal = meanVal / (double) numseg;
+    for ( seg = 0; seg < numseg; ++seg )
+      meanVal += bin[seg];
+    meanVal /= (double) numseg;
 
-    for ( l = 0; l < numBins; ++l ) {
-        Observed[l] = 0.0;
-        Expected[l] = 0.0;
-        ObservedCDF[l] = 0.0;
-        ExpectedCDF[l] = 0.0;
-    }
+    for ( l = 0; l < numBins; ++l )
+      ObservedCDF[l] = 0.0;
 
-    count = 0.0;
     for ( seg = 0; seg < numseg; ++seg ) {
-      normVal = 2 * bin[seg] / meanVal;
-      binIndex = (int)((normVal- min)/interval);
-
-      Observed[binIndex] = Observed[binIndex] + 1;
-      count = count + 1;
-    }
-
-    for ( l = 0; l < numBins; ++l ) {
-
-      bin_val = l*interval + min;
-      expected_val = count * chisqr(2,bin_val);
-
-      Expected[l] = expected_val;
-
+      double binIndex = (2 * bin[seg] / meanVal - min)/interval;
+      /* values beyond the histogram are in none of its bins */
+      if ( binIndex >= 0 && binIndex < numBins )
+        ObservedCDF[(int)binIndex] += 1;
     }
 
     ObservedSum = 0.0;
-    ExpectedSum = 0.0;
-
     for ( l = 0; l < numBins; ++l ) {
-
-      if (l > 0) {
-          ObservedCDF[l] = ObservedCDF[l-1] + Observed[l];
-          ExpectedCDF[l] = ExpectedCDF[l-1] + Expected[l];
-
-      }
-      else {
-          ObservedCDF[l] = Observed[l];
-          ExpectedCDF[l] = Expected[l];
-      }
-
-      ObservedSum = ObservedSum + Observed[l];
-      ExpectedSum = ExpectedSum + Expected[l];
-
+      ObservedSum = ObservedSum + ObservedCDF[l];
+      ObservedCDF[l] = ObservedSum;
     }
 
-    KS = 0.0;
-
     for ( l = 0; l < numBins; ++l ) {
-
-        ObservedCDF[l] = ObservedCDF[l]/ObservedSum;
-        ExpectedCDF[l] = ExpectedCDF[l]/ExpectedSum;
-
-        KSVal = ObservedCDF[l] - ExpectedCDF[l];
-
-        if (KSVal < 0) {
-            KSVal = -KSVal;
-        }
-
-        if (KSVal > KS) {
-            KS = KSVal;
-        }
-
+      double KSVal = fabs(ObservedCDF[l]/ObservedSum - ExpectedCDF[l]);
+      if (KSVal > KS) {
+        KS = KSVal;
+      }
     }
 
     nKSsquared = count * KS * KS;
     pvalues[k] = 2*exp(-(2.000071+.331/sqrt(count)+1.409/count)*nKSsquared);
-
   }
 
-  /* free the workspace data */
-  XLALFree( bin );
-  median_cleanup_REAL8( work, numseg );
+  RemoveLinesPeriodogramsRelease();
 
   return 0;
 }
@@ -497,8 +512,7 @@ int LALInferenceAverageSpectrumBinFit(
     LIGOTimeGPS                 GPStime      
     )
 {
-  REAL8FrequencySeries *work; /* array of frequency series */
-  REAL8 *bin; /* array of bin values */
+  const struct RemoveLinesPeriodograms *periodograms;
   UINT4 reclen; /* length of entire data record */
   UINT4 numseg;
   UINT4 seg;
@@ -507,7 +521,7 @@ int LALInferenceAverageSpectrumBinFit(
   double trigtime = GPStime.gpsSeconds+1e-9*GPStime.gpsNanoSeconds;
   double PSDtime;
   double *PSDtimes;
-  int *PSDtimesIndex, segindex;
+  UINT4 *PSDtimesIndex;
 
   if ( ! spectrum || ! tseries || ! plan )
       XLAL_ERROR( XLAL_EFAULT );
@@ -526,34 +540,22 @@ int LALInferenceAverageSpectrumBinFit(
   if ( spectrum->data->length != seglen/2 + 1 )
     XLAL_ERROR( XLAL_EBADLEN );
 
-  /* create frequency series data workspaces */
-  work = XLALCalloc( numseg, sizeof( *work ) );
-  if ( ! work )
-    XLAL_ERROR( XLAL_ENOMEM );
-  for ( seg = 0; seg < numseg; ++seg )
+  /* times of the segments used in the fit, i.e., those away from the
+   * trigger time */
+  PSDtimes = XLALMalloc( numseg * sizeof( *PSDtimes ) );
+  PSDtimesIndex = XLALMalloc( numseg * sizeof( *PSDtimesIndex ) );
+  if ( ! PSDtimes || ! PSDtimesIndex )
   {
-    work[seg].data = XLALCreateREAL8Vector( spectrum->data->length );
-    if ( ! work[seg].data )
-    {
-      median_cleanup_REAL8( work, numseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
+    XLALFree( PSDtimes );
+    XLALFree( PSDtimesIndex );
+    XLAL_ERROR( XLAL_ENOMEM );
   }
 
-  /* create array to hold a particular frequency bin data */
-  PSDtimes = XLALMalloc( (numseg-1) * sizeof( *PSDtimes ) );
-  PSDtimesIndex = XLALMalloc( (numseg-1) * sizeof( *PSDtimesIndex ) );
-
   int count = 0;
+  double SUMx = 0, SUMxx = 0;
 
   for ( seg = 0; seg < numseg; ++seg )
   {
-    REAL8Vector savevec; /* save the time series data vector */
-    int code;
-
-    /* save the time series data vector */
-    savevec = *tseries->data;
-
     PSDtime = tseries->epoch.gpsSeconds + 1e-9*tseries->epoch.gpsNanoSeconds + seg*tseries->deltaT*seglen;
     if ((PSDtime > trigtime - 0.5) & (PSDtime < trigtime + 0.5))
     {
@@ -562,95 +564,75 @@ int LALInferenceAverageSpectrumBinFit(
     PSDtimes[count] = PSDtime;
     PSDtimesIndex[count] = seg;
 
-    count = count + 1;
-    }
-
-    /* set the data vector to be appropriate for the even segment */
-    tseries->data->length  = seglen;
-    tseries->data->data   += seg * stride;
+    /* the fit abscissae are the same for every frequency bin */
+    SUMx = SUMx + PSDtime;
+    SUMxx = SUMxx + PSDtime*PSDtime;
 
-    /* compute the modified periodogram for the even segment */
-    code = XLALREAL8ModifiedPeriodogram( work + seg, tseries, window, plan );
-
-    /* restore the time series data vector to its original state */
-    *tseries->data = savevec;
-
-    /* now check for failure of the XLAL routine */
-    if ( code == XLAL_FAILURE )
-    {
-      median_cleanup_REAL8( work, numseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
+    count = count + 1;
     }
   }
 
-  /* create array to hold a particular frequency bin data */
-  bin = XLALMalloc( (numseg) * sizeof( *bin ) );
-
-  if ( ! bin )
+  periodograms = RemoveLinesPeriodogramsAcquire( tseries, seglen, stride, window, plan );
+  if ( ! periodograms )
   {
-    median_cleanup_REAL8( work, numseg ); /* cleanup */
-    XLAL_ERROR( XLAL_ENOMEM );
+    XLALFree( PSDtimes );
+    XLALFree( PSDtimesIndex );
+    XLAL_ERROR( XLAL_EFUNC );
   }
 
-  double SUMx = 0, SUMy = 0, SUMxy = 0, SUMxx = 0;
-  double f, t, datavallog;
-  double slope, y_intercept, y_estimate, y_estimate_log;
-  double deltaF = work->deltaF;
+  double deltaF = periodograms->deltaF;
 
   FILE *out;
 
   out = fopen(filename, "w");
 
-  /* now loop over frequency bins and compute the median-mean */
   for ( k = 0; k < spectrum->data->length; ++k )
   {
-    f = ((double) k) * deltaF;
+    const REAL8 *bin = periodograms->power + (size_t)k * numseg;
 
-    fprintf(out,"%e",f);
-    /* assign array of even segment values to bin array for this freq bin */
+    fprintf(out,"%e",((double) k) * deltaF);
     for ( seg = 0; seg < numseg; ++seg ) {
-      bin[seg] = work[seg].data->data[k];
       fprintf(out," %e ",bin[seg]);
     }
     fprintf(out,"\n");
+  }
 
-    count = 0; SUMx = 0, SUMy = 0, SUMxy = 0, SUMxx = 0;
-    for ( seg = 0; seg < numseg-1; ++seg ) {
-      segindex = PSDtimesIndex[seg];
-
-      t = PSDtimes[segindex];
-      datavallog = log10(bin[segindex]);
+  fclose(out);
 
-      SUMx = SUMx + t;
-      SUMy = SUMy + datavallog;
-      SUMxy = SUMxy + t*datavallog;
-      SUMxx = SUMxx + t*t;
+  /* now loop over frequency bins and fit a line to the log of the
+   * segment values against time */
+#pragma omp parallel for schedule(static) private(seg)
+  for ( k = 0; k < spectrum->data->length; ++k )
+  {
+    const REAL8 *bin = periodograms->power + (size_t)k * numseg;
+    double SUMy = 0, SUMxy = 0;
+    double slope, y_intercept, y_estimate_log;
 
-      count = count + 1;
+    for ( seg = 0; seg < (UINT4)count; ++seg ) {
+      double datavallog = log10(bin[PSDtimesIndex[seg]]);
 
+      SUMy = SUMy + datavallog;
+      SUMxy = SUMxy + PSDtimes[seg]*datavallog;
     }
 
     slope = ( SUMx*SUMy - count*SUMxy ) / ( SUMx*SUMx - count*SUMxx );
     y_intercept = ( SUMy - slope*SUMx ) / count;
 
     y_estimate_log = slope*trigtime + y_intercept;
-    y_estimate = pow(10.0,y_estimate_log);
-
-    spectrum->data->data[k] = y_estimate;
-
+    spectrum->data->data[k] = pow(10.0,y_estimate_log);
   }
 
-  fclose(out);
-
   /* set metadata */
-  spectrum->epoch       = work->epoch;
-  spectrum->f0          = work->f0;
-  spectrum->deltaF      = work->deltaF;
-  spectrum->sampleUnits = work->sampleUnits;
+  spectrum->epoch       = periodograms->epoch;
+  spectrum->f0          = periodograms->f0;
+  spectrum->deltaF      = periodograms->deltaF;
+  spectrum->sampleUnits = periodograms->sampleUnits;
+
+  RemoveLinesPeriodogramsRelease();
 
   /* free the workspace data */
-  XLALFree( bin );
-  median_cleanup_REAL8( work, numseg );
+  XLALFree( PSDtimes );
+  XLALFree( PSDtimesIndex );
 
   return 0;
 
@@ -666,11 +648,8 @@ int LALInferenceRemoveLinesPowerLaw(
     REAL8                       *pvalues
     )
 {
-  REAL8FrequencySeries *work; /* array of frequency series */
-  REAL8 *bin; /* array of bin values */
   UINT4 reclen; /* length of entire data record */
   UINT4 numseg;
-  UINT4 seg;
   UINT4 k,l;
 
   if ( ! spectrum || ! tseries || ! plan )
@@ -690,64 +669,32 @@ int LALInferenceRemoveLinesPowerLaw(
   if ( spectrum->data->length != seglen/2 + 1 )
     XLAL_ERROR( XLAL_EBADLEN );
 
-  /* create frequency series data workspaces */
-  work = XLALCalloc( numseg, sizeof( *work ) );
-  if ( ! work )
-    XLAL_ERROR( XLAL_ENOMEM );
-  for ( seg = 0; seg < numseg; ++seg )
-  {
-    work[seg].data = XLALCreateREAL8Vector( spectrum->data->length );
-    if ( ! work[seg].data )
-    {
-      median_cleanup_REAL8( work, numseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-  }
-
-  for ( seg = 0; seg < numseg; ++seg )
-  {
-    REAL8Vector savevec; /* save the time series data vector */
-    int code;
-
-    /* save the time series data vector */
-    savevec = *tseries->data;
-
-    /* set the data vector to be appropriate for the even segment */
-    tseries->data->length  = seglen;
-    tseries->data->data   += seg * stride;
-
-    /* compute the modified periodogram for the even segment */
-    code = XLALREAL8ModifiedPeriodogram( work + seg, tseries, window, plan );
-
-    /* restore the time series data vector to its original state */
-    *tseries->data = savevec;
-
-    /* now check for failure of the XLAL routine */
-    if ( code == XLAL_FAILURE )
-    {
-      median_cleanup_REAL8( work, numseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-  }
-                                
-  /* create array to hold a particular frequency bin data */
-  bin = XLALMalloc( numseg * sizeof( *bin ) );
-  if ( ! bin )
-  {
-    median_cleanup_REAL8( work, numseg ); /* cleanup */
-    XLAL_ERROR( XLAL_ENOMEM );
-  }
+  /* the fit is to the average spectrum only, so the periodograms of the
+   * segments are not needed */
+  (void)window;
 
+  REAL8 *flog, *datavallog;
   int count;
   double SUMx = 0, SUMy = 0, SUMxy = 0, SUMxx = 0;
   double res, slope, y_intercept, y_estimate_log;
 
-  double f, dataval, flog, datavallog;
+  double f;
 
   double deltaF = spectrum->deltaF;
-  
+
+  /* logs of the frequencies and of the spectrum, used by every band */
+  flog = XLALMalloc( spectrum->data->length * sizeof( *flog ) );
+  datavallog = XLALMalloc( spectrum->data->length * sizeof( *datavallog ) );
+  if ( ! flog || ! datavallog )
+  {
+    XLALFree( flog );
+    XLALFree( datavallog );
+    XLAL_ERROR( XLAL_ENOMEM );
+  }
   for ( k = 0; k < spectrum->data->length; ++k ) {
       pvalues[k] = 0.0;
+      flog[k] = log10(((double) k) * deltaF);
+      datavallog[k] = log10(spectrum->data->data[k]);
   }
 
   UINT4 numBands = 4;
@@ -758,21 +705,18 @@ int LALInferenceRemoveLinesPowerLaw(
   {
 
     count = 0, SUMx = 0, SUMy = 0, SUMxy = 0, SUMxx = 0;
-    /* now loop over frequency bins and compute the median-mean */
+    /* now loop over frequency bins and fit a power law in each band */
     for ( k = 0; k < spectrum->data->length; ++k )
     {
 
       f = ((double) k) * deltaF;
-      dataval = spectrum->data->data[k];
-      flog = log10(f);
-      datavallog = log10(dataval);
  
       if ((f>=frequencyBands[l]) & (f<=frequencyBands[l+1])) {
 
-      SUMx = SUMx + flog;
-      SUMy = SUMy + datavallog;
-      SUMxy = SUMxy + flog*datavallog;
-      SUMxx = SUMxx + flog*flog;
+      SUMx = SUMx + flog[k];
+      SUMy = SUMy + datavallog[k];
+      SUMxy = SUMxy + flog[k]*datavallog[k];
+      SUMxx = SUMxx + flog[k]*flog[k];
 
       count = count + 1;
 
@@ -785,15 +729,12 @@ int LALInferenceRemoveLinesPowerLaw(
     for (k=0; k<spectrum->data->length; ++k) {
 
       f = ((double) k) * deltaF;
-      dataval = spectrum->data->data[k];
-      flog = log10(f);
-      datavallog = log10(dataval);
 
       if ((f>=frequencyBands[l]) & (f<=frequencyBands[l+1])) {
 
-      y_estimate_log = slope*flog + y_intercept;
+      y_estimate_log = slope*flog[k] + y_intercept;
 
-      res = fabs(datavallog - y_estimate_log);
+      res = fabs(datavallog[k] - y_estimate_log);
       pvalues[k] = 1.0/res;
       }
     }
@@ -801,8 +742,8 @@ int LALInferenceRemoveLinesPowerLaw(
 
 
   /* free the workspace data */
-  XLALFree( bin );
-  median_cleanup_REAL8( work, numseg );
+  XLALFree( flog );
+  XLALFree( datavallog );
 
   return 0;
 }
@@ -818,8 +759,10 @@ int LALInferenceXCorrBands(
     char*                       filename
     )
 {
-  REAL8FrequencySeries *work; /* array of frequency series */
-  REAL8 *bin; /* array of bin values */
+  const struct RemoveLinesPeriodograms *periodograms;
+  REAL8 *dev; /* deviations of the segment values from their bin mean */
+  REAL8 *norm; /* root sum of squares of the deviations in each bin */
+  REAL8 *row; /* correlation coefficients of a bin with all the others */
   UINT4 reclen; /* length of entire data record */
   UINT4 numseg;
   UINT4 seg;
@@ -842,55 +785,44 @@ int LALInferenceXCorrBands(
   if ( spectrum->data->length != seglen/2 + 1 )
     XLAL_ERROR( XLAL_EBADLEN );
 
-  /* create frequency series data workspaces */
-  work = XLALCalloc( numseg, sizeof( *work ) );
-  if ( ! work )
-    XLAL_ERROR( XLAL_ENOMEM );
-  for ( seg = 0; seg < numseg; ++seg )
+  dev = XLALMalloc( (size_t)spectrum->data->length * numseg * sizeof( *dev ) );
+  norm = XLALMalloc( spectrum->data->length * sizeof( *norm ) );
+  row = XLALMalloc( spectrum->data->length * sizeof( *row ) );
+  if ( ! dev || ! norm || ! row )
   {
-    work[seg].data = XLALCreateREAL8Vector( spectrum->data->length );
-    if ( ! work[seg].data )
-    {
-      median_cleanup_REAL8( work, numseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
+    XLALFree( dev );
+    XLALFree( norm );
+    XLALFree( row );
+    XLAL_ERROR( XLAL_ENOMEM );
   }
 
-  for ( seg = 0; seg < numseg; ++seg )
+  periodograms = RemoveLinesPeriodogramsAcquire( tseries, seglen, stride, window, plan );
+  if ( ! periodograms )
   {
-    REAL8Vector savevec; /* save the time series data vector */
-    int code;
-
-    /* save the time series data vector */
-    savevec = *tseries->data;
-
-    /* set the data vector to be appropriate for the even segment */
-    tseries->data->length  = seglen;
-    tseries->data->data   += seg * stride;
-
-    /* compute the modified periodogram for the even segment */
-    code = XLALREAL8ModifiedPeriodogram( work + seg, tseries, window, plan );
-
-    /* restore the time series data vector to its original state */
-    *tseries->data = savevec;
-
-    /* now check for failure of the XLAL routine */
-    if ( code == XLAL_FAILURE )
-    {
-      median_cleanup_REAL8( work, numseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
+    XLALFree( dev );
+    XLALFree( norm );
+    XLALFree( row );
+    XLAL_ERROR( XLAL_EFUNC );
   }
 
-  /* create array to hold a particular frequency bin data */
-  bin = XLALMalloc( numseg * sizeof( *bin ) );
-  if ( ! bin )
+  /* the mean and spread of each bin are the same for every pair it is in,
+   * so compute them once and correlate the deviations */
+#pragma omp parallel for schedule(static) private(seg)
+  for ( k = 0; k < spectrum->data->length; ++k )
   {
-    median_cleanup_REAL8( work, numseg ); /* cleanup */
-    XLAL_ERROR( XLAL_ENOMEM );
-  }
+    const REAL8 *bin = periodograms->power + (size_t)k * numseg;
+    REAL8 *d = dev + (size_t)k * numseg;
+    double mx = 0, sx = 0;
 
-  double mx,my,sx,sy,sxy,denom,r;
+    for ( seg = 0; seg < numseg; ++seg )
+      mx += bin[seg];
+    mx /= numseg;
+    for ( seg = 0; seg < numseg; ++seg ) {
+      d[seg] = bin[seg] - mx;
+      sx += d[seg] * d[seg];
+    }
+    norm[k] = sqrt(sx);
+  }
 
   for ( k = 0; k < spectrum->data->length; ++k ) {
       pvalues[k] = 0.0;
@@ -902,50 +834,38 @@ int LALInferenceXCorrBands(
 
   for ( k = 0; k < spectrum->data->length; ++k )
   {
-    fprintf(out,"%e",((double) k) * work->deltaF);
+    const REAL8 *dk = dev + (size_t)k * numseg;
+
+    fprintf(out,"%e",((double) k) * periodograms->deltaF);
 
-    /* now loop over frequency bins and compute the median-mean */
+    /* now loop over frequency bins and compute the correlation
+     * coefficients with bin k */
+#pragma omp parallel for schedule(static) private(seg)
     for ( l = 0; l < spectrum->data->length; ++l )
     {
+      const REAL8 *dl = dev + (size_t)l * numseg;
+      double sxy = 0;
 
-      /* Calculate the mean of the two series x[], y[] */
-      mx = 0;
-      my = 0;
-      for ( seg = 0; seg < numseg; ++seg ) {
-        mx += work[seg].data->data[k];
-        my += work[seg].data->data[l];
-      }
-      mx /= numseg;
-      my /= numseg;
-
-      /* Calculate the denominator */
-      sx = 0;
-      sy = 0;
-      for ( seg = 0; seg < numseg; ++seg ) {
-        sx += (work[seg].data->data[k] - mx) * (work[seg].data->data[k] - mx);
-        sy += (work[seg].data->data[l] - my) * (work[seg].data->data[l] - my);
-      }
-      denom = sqrt(sx*sy);
-
-      sxy = 0;
-      for ( seg = 0; seg < numseg; ++seg ) {
-         sxy += (work[seg].data->data[k] - mx) * (work[seg].data->data[l] - my);
-      }
-      r = fabs(sxy / denom);
-
-      fprintf(out," %e ",r);
-
+      for ( seg = 0; seg < numseg; ++seg )
+        sxy += dk[seg] * dl[seg];
+      row[l] = fabs(sxy / (norm[k] * norm[l]));
     }
 
+    for ( l = 0; l < spectrum->data->length; ++l )
+      fprintf(out," %e ",row[l]);
+
     fprintf(out,"\n");
 
   }
 
   fclose(out);
 
+  RemoveLinesPeriodogramsRelease();
+
   /* free the workspace data */
-  XLALFree( bin );
-  median_cleanup_REAL8( work, numseg );
+  XLALFree( dev );
+  XLALFree( norm );
+  XLALFree( row );
 
   return 0;
 }
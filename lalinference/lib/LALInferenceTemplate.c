@@ -92,64 +92,24 @@ static REAL8 dquadmon_from_lambda(REAL8 lambdav)
     return(exp(ln_quad_moment) - 1.0);
 }
 
-static int InterpolateWaveform(REAL8Vector *freqs, COMPLEX16FrequencySeries *src, COMPLEX16FrequencySeries *dest);
-static int InterpolateWaveform(REAL8Vector *freqs, COMPLEX16FrequencySeries *src, COMPLEX16FrequencySeries *dest)
+/* largest azimuthal mode number in the waveform, from the mode array if one is given */
+static UINT4 MultibandModeMax(LALDict *LALpars, Approximant approximant);
+static UINT4 MultibandModeMax(LALDict *LALpars, Approximant approximant)
 {
-  REAL8 deltaF = dest->deltaF;
-  UINT4 j=ceil(freqs->data[0] / deltaF);
-  COMPLEX16 *d=dest->data->data;
-  memset(d, 0, sizeof(*(d))*j);
-
-  /* Loop over reduced frequency set */
-  for(UINT4 i=0;i<freqs->length-1;i++)
-  {
-    double startpsi = carg(src->data->data[i]);
-    double startamp = cabs(src->data->data[i]);
-    double endpsi = carg(src->data->data[i+1]);
-    double endamp = cabs(src->data->data[i+1]);
-
-    double startf=freqs->data[i];
-    double endf=freqs->data[i+1];
-
-    double df = endf - startf; /* Big freq step */
-
-    /* linear interpolation setup */
-    double dpsi = (endpsi - startpsi);
-
-    /* Catch case where phase wraps around */
-    /* NOTE: If changing this check that waveforms are not corrupted
-     * at high frequencies when dpsi/df can go slightly -ve without
-     * the phase wrapping around (e.g. TF2 1.4-1.4 srate=4096)
-     */
-    if (dpsi/df<-LAL_PI ) {dpsi+=LAL_TWOPI;}
-
-    double dpsidf = dpsi/df;
-    double dampdf = (endamp - startamp)/df;
-
-    double damp = dampdf *deltaF;
-
-    const double dim = sin(dpsidf*deltaF);
-    const double dre = 2.0*sin(dpsidf*deltaF*0.5)*sin(dpsidf*deltaF*0.5);
-
-    /* Loop variables */
-    double newRe,newIm,f,re,im,a;
-    for(f=j*deltaF,
-	re = cos(startpsi), im = sin(startpsi),
-        a = startamp;
-
-        f<endf;
-
-        j++, f+=deltaF,
-        newRe = re - dre*re-dim*im,
-        newIm = im + re*dim-dre*im,
-        re=newRe, im = newIm,
-        a += damp )
-    {
-      d[j] = a * (re + I*im);
-    }
+  UINT4 mmax = 2;
+  LALValue *modes = XLALSimInspiralWaveformParamsLookupModeArray(LALpars);
+  if (modes) {
+    for (INT4 l=2; l<=LAL_SIM_L_MAX_MODE_ARRAY; l++)
+      for (INT4 m=-l; m<=l; m++)
+        if (XLALSimInspiralModeArrayIsModeActive(modes, l, m) == 1 && (UINT4) abs(m) > mmax) mmax = abs(m);
+    XLALDestroyValue(modes);
   }
-  memset(&(d[j]), 0, sizeof(d[j])*(dest->data->length - j));
-  return 0;
+  else {
+    /* approximants with higher modes include modes up to m=4 by default */
+    const char *name = XLALSimInspiralGetStringFromApproximant(approximant);
+    if (name && strstr(name, "HM")) mmax = 4;
+  }
+  return mmax;
 }
 
 
@@ -229,8 +189,20 @@ void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferen
   int ret=0;
   INT4 errnum=0;
 
-  model->roq->hptildeLinear=NULL, model->roq->hctildeLinear=NULL;
-  model->roq->hptildeQuadratic=NULL, model->roq->hctildeQuadratic=NULL;
+  if (model->relbin) {
+    /* The relative binning buffers are kept between calls */
+    if (model->relbin->hptilde) XLALDestroyCOMPLEX16FrequencySeries(model->relbin->hptilde);
+    if (model->relbin->hctilde) XLALDestroyCOMPLEX16FrequencySeries(model->relbin->hctilde);
+    model->relbin->hptilde=NULL, model->relbin->hctilde=NULL;
+  }
+  else if (model->roq) {
+    model->roq->hptildeLinear=NULL, model->roq->hctildeLinear=NULL;
+    model->roq->hptildeQuadratic=NULL, model->roq->hctildeQuadratic=NULL;
+  }
+  else {
+    XLALPrintError(" ERROR in %s: neither ROQ nor relative binning is set up.\n",__func__);
+    XLAL_ERROR_VOID(XLAL_EFAULT);
+  }
   REAL8 mc;
   REAL8 phi0, m1, m2, distance, inclination;
 
@@ -452,6 +424,20 @@ void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferen
   /* ==== Call the waveform generator ==== */
     /* Correct distance to account for renormalisation of data due to window RMS */
     double corrected_distance = distance * sqrt(model->window->sumofsquares/model->window->data->length);
+    if (model->relbin) {
+      XLAL_TRY(ret=XLALSimInspiralChooseFDWaveformSequence (&(model->relbin->hptilde), &(model->relbin->hctilde), phi0, m1*LAL_MSUN_SI, m2*LAL_MSUN_SI,
+                spin1x, spin1y, spin1z, spin2x, spin2y, spin2z, f_ref, corrected_distance, inclination, model->LALpars, approximant, model->relbin->frequencies), errnum);
+      if (ret != XLAL_SUCCESS) {
+        errnum&=~XLAL_EFUNC; /* Mask out the internal function failure bit */
+        if (errnum == XLAL_EDOM)
+          /* The waveform was called outside its domain */
+          XLAL_ERROR_VOID(XLAL_EUSR0);
+        XLAL_ERROR_VOID(errnum, "%s: Template generation failed in XLALSimInspiralChooseFDWaveformSequence\n", __func__);
+      }
+      REAL8 instant = model->freqhPlus->epoch.gpsSeconds + 1e-9*model->freqhPlus->epoch.gpsNanoSeconds;
+      LALInferenceSetVariable(model->params, "time", &instant);
+      return;
+    }
     XLAL_TRY(ret=XLALSimInspiralChooseFDWaveformSequence (&(model->roq->hptildeLinear), &(model->roq->hctildeLinear), phi0, m1*LAL_MSUN_SI, m2*LAL_MSUN_SI,
                 spin1x, spin1y, spin1z, spin2x, spin2y, spin2z, f_ref, corrected_distance, inclination, model->LALpars, approximant, (model->roq->frequencyNodesLinear)), errnum);
 
@@ -1516,13 +1502,46 @@ void LALInferenceTemplateXLALSimInspiralChooseWaveformPhaseInterpolated(LALInfer
     double mc_min=1.0/pow(2,0.2); /* For min 1.0-1.0 waveform */
 
     /* Vector of frequencies at which to compute FD template */
-    static REAL8Sequence *frequencies = NULL;
+    REAL8Sequence *frequencies = NULL;
 
     /* ==== Call the waveform generator ==== */
     if(model->domain == LAL_SIM_DOMAIN_FREQUENCY) {
-        if(!frequencies) frequencies = LALInferenceMultibandFrequencies(Nbands,f_start,0.5/deltaT, model->deltaF, mc_min);
         double corrected_distance = distance * sqrt(model->window->sumofsquares/model->window->data->length);
 
+        /* The multiband grid is adapted to a probe waveform for the region of chirp mass and mass ratio
+         * of this template, generated on the conservative grid for a 1.0-1.0 waveform, and cached */
+        if(!model->multiband) {
+            REAL8Sequence *probe_frequencies = LALInferenceMultibandFrequencies(Nbands,f_start,0.5/deltaT, model->deltaF, mc_min);
+            if(!probe_frequencies) XLAL_ERROR_VOID(XLAL_EFUNC);
+            model->multiband = LALInferenceCreateMultibandCache(probe_frequencies, MultibandModeMax(model->LALpars, approximant));
+            if(!model->multiband) XLAL_ERROR_VOID(XLAL_EFUNC);
+        }
+        double mc_this = pow(m1*m2, 0.6)/pow(m1+m2, 0.2), q_this = m1 > m2 ? m2/m1 : m1/m2;
+        double mc_probe = 0, q_probe = 0;
+        frequencies = LALInferenceMultibandCacheLookup(model->multiband, mc_this, q_this, &mc_probe, &q_probe);
+        if(!frequencies) {
+            COMPLEX16FrequencySeries *probe_hp = NULL, *probe_hc = NULL;
+            double probe_m1, probe_m2;
+            q2masses(mc_probe, q_probe, &probe_m1, &probe_m2);
+            XLAL_TRY(ret=XLALSimInspiralChooseFDWaveformSequence(&probe_hp, &probe_hc, phi0, probe_m1*LAL_MSUN_SI, probe_m2*LAL_MSUN_SI,
+                                                                spin1x, spin1y, spin1z, spin2x, spin2y, spin2z, f_ref, corrected_distance, inclination,
+                                                                model->LALpars, approximant, model->multiband->probe_frequencies), errnum);
+            if(ret==XLAL_SUCCESS && probe_hp && probe_hc) {
+                for(UINT4 i=0; i<probe_hp->data->length; i++) probe_hp->data->data[i] += probe_hc->data->data[i];
+                frequencies = LALInferenceMultibandFrequenciesFromWaveform(model->multiband->probe_frequencies, probe_hp->data->data,
+                                                                           f_start, 0.5/deltaT, model->deltaF, model->multiband->mmax);
+            }
+            else {
+                /* fall back to the conservative grid for this region */
+                XLALClearErrno();
+                frequencies = XLALCopyREAL8Sequence(model->multiband->probe_frequencies);
+            }
+            if ( probe_hp ) XLALDestroyCOMPLEX16FrequencySeries(probe_hp);
+            if ( probe_hc ) XLALDestroyCOMPLEX16FrequencySeries(probe_hc);
+            if(!frequencies || LALInferenceMultibandCacheAdd(model->multiband, mc_this, q_this, frequencies) != XLAL_SUCCESS)
+                XLAL_ERROR_VOID(XLAL_EFUNC);
+        }
+
 
         XLAL_TRY(ret=XLALSimInspiralChooseFDWaveformFromCache(&hptilde, &hctilde, phi0,
                                                               0.0, m1*LAL_MSUN_SI, m2*LAL_MSUN_SI, spin1x, spin1y, spin1z,
@@ -1565,8 +1584,9 @@ model->LALpars,%d,model->waveformCache)\n",__func__,
         }
 
 
-        InterpolateWaveform(frequencies, hptilde, model->freqhPlus);
-        InterpolateWaveform(frequencies, hctilde, model->freqhCross);
+        if(LALInferenceMultibandInterpolate(frequencies, hptilde, model->freqhPlus) != XLAL_SUCCESS ||
+           LALInferenceMultibandInterpolate(frequencies, hctilde, model->freqhCross) != XLAL_SUCCESS)
+            XLAL_ERROR_VOID(XLAL_EFUNC);
 
         REAL8 instant = model->freqhPlus->epoch.gpsSeconds + 1e-9*model->freqhPlus->epoch.gpsNanoSeconds;
         LALInferenceSetVariable(model->params, "time", &instant);
@@ -122,6 +122,11 @@ void LALInferenceTemplateNullTimedomain(LALInferenceModel *model);
  */
 void LALInferenceTemplateSineGaussian(LALInferenceModel *model);
 
+/**
+ * Generate a frequency-domain template with XLALSimInspiralChooseFDWaveformSequence()
+ * at the ROQ frequency nodes, or at the relative binning frequencies if
+ * model->relbin is set (see LALInferenceRelativeBinning.h).
+ */
 void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferenceModel *model);
 /**
  * Damped Sinusoid template.
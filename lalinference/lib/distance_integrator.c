@@ -16,7 +16,11 @@
  * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
  * MA  02110-1301  USA
  */
+#include <config.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
 #include "bayestar_cosmology.h"
 #include "omp_interruptible.h"
 
@@ -34,6 +38,21 @@
 
 #include <lal/distance_integrator.h>
 
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_UNISTD_H)
+#include <sys/mman.h>
+#define MMAP_ENABLED
+#endif
+#if defined(HAVE_SYS_FILE_H) && defined(HAVE_UNISTD_H)
+#include <sys/file.h>
+#define FLOCK_ENABLED
+#endif
+
 #ifndef _OPENMP
 #define omp ignore
 #endif
@@ -304,7 +323,9 @@ log_radial_integrator *log_radial_integrator_init(double r1, double r2, int k, i
     /* Temporarily turn off gsl_error handler which isn't thread safe. */
     gsl_error_handler_t *old_handler = gsl_set_error_handler_off();
 
-    #pragma omp parallel for
+    /* The cost of the integrals varies across the table, so hand out rows
+     * of it dynamically */
+    #pragma omp parallel for schedule(dynamic, size)
     for (size_t i = 0; i < size * size; i ++)
     {
 
@@ -359,13 +380,237 @@ done:
     integrator->r1 = r1;
     integrator->r2 = r2;
     integrator->k = k;
+    integrator->mapping = NULL;
+    integrator->mapping_size = 0;
+    return integrator;
+}
+
+
+/* Layout of a cached integrator: this header, followed by the bicubic
+ * interpolant and the two cubic interpolants exactly as they are laid out in
+ * memory, so that a cache file can be mapped and used in place */
+#define LOG_RADIAL_CACHE_MAGIC "LALRADI"
+#define LOG_RADIAL_CACHE_VERSION 1
+#define LOG_RADIAL_CACHE_BYTE_ORDER UINT64_C(0x0102030405060708)
+
+typedef struct {
+    char magic[8];
+    uint64_t version;
+    uint64_t byte_order;
+    char key[256];
+    double xmax, ymax, vmax, r1, r2;
+    int64_t k;
+    uint64_t size0, size1, size2;
+} log_radial_cache_header;
+
+static size_t cubic_interp_size(const cubic_interp *interp)
+{
+    return sizeof(*interp) + (size_t) interp->length * sizeof(*interp->a);
+}
+
+static size_t bicubic_interp_size(const bicubic_interp *interp)
+{
+    return sizeof(*interp) + (size_t) interp->slength * (size_t) interp->tlength * sizeof(*interp->a);
+}
+
+/* Map (or read) a cached integrator, returning NULL if there is no valid
+ * cache for the given key */
+static log_radial_integrator *log_radial_integrator_read_cache(const char *path, const char *key)
+{
+    log_radial_integrator *integrator = NULL;
+    const log_radial_cache_header *header;
+    struct stat st;
+    char *buf = NULL;
+    size_t len;
+    int mapped = 0;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(*header))
+    {
+        close(fd);
+        return NULL;
+    }
+    len = st.st_size;
+
+#ifdef MMAP_ENABLED
+    buf = mmap(NULL, len, PROT_READ, MAP_SHARED, fd, 0);
+    if (buf == MAP_FAILED)
+        buf = NULL;
+    else
+        mapped = 1;
+#endif
+    if (!buf)
+    {
+        buf = malloc(len);
+        if (!buf || read(fd, buf, len) != (ssize_t) len)
+        {
+            free(buf);
+            close(fd);
+            return NULL;
+        }
+    }
+    close(fd);
+
+    header = (const log_radial_cache_header *) buf;
+    if (memcmp(header->magic, LOG_RADIAL_CACHE_MAGIC, sizeof(header->magic)) != 0
+        || header->version != LOG_RADIAL_CACHE_VERSION
+        || header->byte_order != LOG_RADIAL_CACHE_BYTE_ORDER
+        || strncmp(header->key, key, sizeof(header->key)) != 0
+        || sizeof(*header) + header->size0 + header->size1 + header->size2 != len
+        || bicubic_interp_size((const bicubic_interp *) (buf + sizeof(*header))) != header->size0
+        || cubic_interp_size((const cubic_interp *) (buf + sizeof(*header) + header->size0)) != header->size1
+        || cubic_interp_size((const cubic_interp *) (buf + sizeof(*header) + header->size0 + header->size1)) != header->size2)
+        goto fail;
+
+    integrator = malloc(sizeof(*integrator));
+    if (!integrator)
+        goto fail;
+    integrator->region0 = (bicubic_interp *) (buf + sizeof(*header));
+    integrator->region1 = (cubic_interp *) (buf + sizeof(*header) + header->size0);
+    integrator->region2 = (cubic_interp *) (buf + sizeof(*header) + header->size0 + header->size1);
+    integrator->xmax = header->xmax;
+    integrator->ymax = header->ymax;
+    integrator->vmax = header->vmax;
+    integrator->r1 = header->r1;
+    integrator->r2 = header->r2;
+    integrator->k = header->k;
+    integrator->mapping = buf;
+    integrator->mapping_size = mapped ? len : 0;
+    return integrator;
+
+fail:
+#ifdef MMAP_ENABLED
+    if (mapped)
+        munmap(buf, len);
+    else
+#endif
+        free(buf);
+    return NULL;
+}
+
+/* Write an integrator to the cache, through a temporary file that is renamed
+ * into place so that readers never see a partial cache */
+static int log_radial_integrator_write_cache(const log_radial_integrator *integrator, const char *path, const char *key)
+{
+    log_radial_cache_header header;
+    char tmppath[FILENAME_MAX];
+    FILE *fp;
+    int ok;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, LOG_RADIAL_CACHE_MAGIC, sizeof(header.magic));
+    header.version = LOG_RADIAL_CACHE_VERSION;
+    header.byte_order = LOG_RADIAL_CACHE_BYTE_ORDER;
+    strncpy(header.key, key, sizeof(header.key) - 1);
+    header.xmax = integrator->xmax;
+    header.ymax = integrator->ymax;
+    header.vmax = integrator->vmax;
+    header.r1 = integrator->r1;
+    header.r2 = integrator->r2;
+    header.k = integrator->k;
+    header.size0 = bicubic_interp_size(integrator->region0);
+    header.size1 = cubic_interp_size(integrator->region1);
+    header.size2 = cubic_interp_size(integrator->region2);
+
+    snprintf(tmppath, sizeof(tmppath), "%s.%ld.tmp", path, (long) getpid());
+    fp = fopen(tmppath, "wb");
+    if (!fp)
+        return -1;
+    ok = fwrite(&header, sizeof(header), 1, fp) == 1
+        && fwrite(integrator->region0, header.size0, 1, fp) == 1
+        && fwrite(integrator->region1, header.size1, 1, fp) == 1
+        && fwrite(integrator->region2, header.size2, 1, fp) == 1;
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok || rename(tmppath, path) != 0)
+    {
+        remove(tmppath);
+        return -1;
+    }
+    return 0;
+}
+
+
+log_radial_integrator *log_radial_integrator_init_cached(double r1, double r2, int k, int cosmology,
+                                                         double pmax, size_t size, int gaussian,
+                                                         const char *cachedir)
+{
+    log_radial_integrator *integrator, *mapped;
+    char key[256], path[FILENAME_MAX];
+    uint64_t hash = UINT64_C(14695981039346656037);
+    int lockfd = -1;
+
+    if (!cachedir)
+        return log_radial_integrator_init(r1, r2, k, cosmology, pmax, size, gaussian);
+
+    /* The cache is keyed exactly by the prior settings and table size */
+    snprintf(key, sizeof(key), "r1=%a r2=%a k=%d cosmology=%d pmax=%a size=%zu gaussian=%d",
+             r1, r2, k, cosmology, pmax, size, gaussian);
+    for (const char *c = key; *c; c++)
+        hash = (hash ^ (unsigned char) *c) * UINT64_C(1099511628211);
+    snprintf(path, sizeof(path), "%s/log_radial_integrator_%016llx.bin", cachedir, (unsigned long long) hash);
+
+    if ((integrator = log_radial_integrator_read_cache(path, key)))
+        return integrator;
+
+    /* Let one process build the table while the others wait to map it */
+#ifdef FLOCK_ENABLED
+    {
+        char lockpath[FILENAME_MAX];
+        snprintf(lockpath, sizeof(lockpath), "%s.lock", path);
+        lockfd = open(lockpath, O_RDWR | O_CREAT, 0644);
+        if (lockfd >= 0 && flock(lockfd, LOCK_EX) != 0)
+        {
+            close(lockfd);
+            lockfd = -1;
+        }
+    }
+#endif
+
+    if (!(integrator = log_radial_integrator_read_cache(path, key)))
+    {
+        integrator = log_radial_integrator_init(r1, r2, k, cosmology, pmax, size, gaussian);
+        if (integrator)
+        {
+            if (log_radial_integrator_write_cache(integrator, path, key) != 0)
+                XLAL_PRINT_WARNING("Unable to write distance integrator cache %s", path);
+            else if ((mapped = log_radial_integrator_read_cache(path, key)))
+            {
+                /* Share the mapped copy rather than keep a private one */
+                log_radial_integrator_free(integrator);
+                integrator = mapped;
+            }
+        }
+    }
+
+    if (lockfd >= 0)
+    {
+#ifdef FLOCK_ENABLED
+        flock(lockfd, LOCK_UN);
+#endif
+        close(lockfd);
+    }
+
+    if (!integrator)
+        XLAL_ERROR_NULL(XLAL_EFUNC);
     return integrator;
 }
 
 
 void log_radial_integrator_free(log_radial_integrator *integrator)
 {
-    if (integrator)
+    if (integrator && integrator->mapping)
+    {
+        /* The interpolants live in a cache file */
+#ifdef MMAP_ENABLED
+        if (integrator->mapping_size)
+            munmap(integrator->mapping, integrator->mapping_size);
+        else
+#endif
+            free(integrator->mapping);
+    }
+    else if (integrator)
     {
         bicubic_interp_free(integrator->region0);
         integrator->region0 = NULL;
@@ -14,6 +14,8 @@ typedef struct taglog_radial_integrator {
 		cubic_interp *region2;
 		double xmax, ymax, vmax, r1, r2;
 		int k;
+		void *mapping; /* cache file holding the interpolants, if any */
+		size_t mapping_size; /* size of the mapping, or 0 if read into memory */
 } log_radial_integrator;
 
 typedef struct tagradial_integrand_params {
@@ -43,6 +45,17 @@ double log_radial_integral(double r1, double r2, double p, double b, int k,
  */
 log_radial_integrator *log_radial_integrator_init(double r1, double r2, int k, int cosmology, double pmax, size_t size, int gaussian);
 
+/**
+ * Distance integrator as for log_radial_integrator_init(), with the lookup
+ * tables cached in the directory \a cachedir.  The cache is keyed by all of
+ * the other arguments; if a matching cache file exists it is memory-mapped, so
+ * that processes sharing a cache also share the memory holding the tables.
+ * Otherwise one process builds the tables and writes the cache while any
+ * others wait for it.  A NULL \a cachedir builds the tables without caching.
+ * @param cachedir Directory holding the cache files, or NULL
+ */
+log_radial_integrator *log_radial_integrator_init_cached(double r1, double r2, int k, int cosmology, double pmax, size_t size, int gaussian, const char *cachedir);
+
 /**
  * Free an integrator
  */
@@ -0,0 +1,66 @@
+#include <lal/LALInference.h>
+#include <lal/LALInferenceKDE.h>
+
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_matrix.h>
+
+#include <math.h>
+#include <stdio.h>
+
+#define NPTS 3000
+#define DIM 4
+#define NTEST 50
+
+int main(void) {
+    INT4 i, k, failed = 0;
+    REAL8 max_error = 0.;
+    gsl_rng *rng = gsl_rng_alloc(gsl_rng_mt19937);
+    gsl_matrix *pts = gsl_matrix_alloc(NPTS, DIM);
+
+    /* Correlated, bimodal samples */
+    for (i = 0; i < NPTS; i++) {
+        REAL8 x0 = gsl_ran_ugaussian(rng) + (i % 3 ? 4. : 0.);
+        gsl_matrix_set(pts, i, 0, x0);
+        for (k = 1; k < DIM; k++)
+            gsl_matrix_set(pts, i, k, 0.5*x0 + (k + 1.)*gsl_ran_ugaussian(rng));
+    }
+
+    LALInferenceKDE *kde = LALInferenceNewKDEfromMat(pts, NULL);
+
+    /* Cycle the last parameter, so boundary copies are included */
+    kde->lower_bound_types[DIM-1] = LALINFERENCE_PARAM_CIRCULAR;
+    kde->upper_bound_types[DIM-1] = LALINFERENCE_PARAM_CIRCULAR;
+    kde->lower_bounds[DIM-1] = -10.;
+    kde->upper_bounds[DIM-1] = 10.;
+
+    for (i = 0; i < NTEST; i++) {
+        REAL8 point[DIM], approx, exact;
+
+        /* Points in the bulk and far in the tails */
+        for (k = 0; k < DIM; k++)
+            point[k] = gsl_matrix_get(pts, i, k) + (i % 5 ? 1. : 20.)*gsl_ran_ugaussian(rng);
+        point[DIM-1] = fmod(point[DIM-1] + 30., 20.) - 10.;
+
+        kde->tolerance = LALINFERENCE_KDE_DEFAULT_TOLERANCE;
+        approx = LALInferenceKDEEvaluatePoint(kde, point);
+        kde->tolerance = 0.;
+        exact = LALInferenceKDEEvaluatePoint(kde, point);
+
+        if (!isfinite(approx) || !isfinite(exact))
+            failed = 1;
+        if (fabs(approx - exact) > max_error)
+            max_error = fabs(approx - exact);
+    }
+
+    fprintf(stdout, "Maximum error in log KDE: %le\n", max_error);
+    if (max_error > 2.*LALINFERENCE_KDE_DEFAULT_TOLERANCE)
+        failed = 1;
+
+    LALInferenceDestroyKDE(kde);
+    gsl_matrix_free(pts);
+    gsl_rng_free(rng);
+
+    LALCheckMemoryLeaks();
+    return failed;
+}
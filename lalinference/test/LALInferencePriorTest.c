@@ -557,6 +557,51 @@ int LALInferenceInspiralPriorTest(void)
 		TEST_FAIL("Mass ratio %f and chirp mass %f define masses outside bounds [%f,%f], but prior is non-zero.", eta, Mc, min, max);
 	}
 
+	// The prior is evaluated through a compiled form of priorArgs; check that
+	// changes to priorArgs after the first evaluation are still honoured.
+	m1 = 10.0;
+	m2 = 8.0;
+	eta = m1 * m2 / pow(m1 + m2, 2);
+	LALInferenceSetVariable(params, "eta", &eta);
+	Mc = pow(m1 * m2, 3.0 / 5.0) / pow(m1 + m2, 1.0 / 5.0);
+	LALInferenceSetVariable(params, "chirpmass", &Mc);
+	logMc = log(Mc);
+	LALInferenceSetVariable(params, "logmc", &logMc);
+	REAL8 distance = 50.0;
+	LALInferenceSetVariable(params, "distance", &distance);
+	value = log(distance);
+	LALInferenceSetVariable(params, "logdistance", &value);
+	XLAL_TRY(result = LALInferenceInspiralPrior(runState, params, thread->model), errnum);
+	if (XLAL_IS_REAL8_FAIL_NAN(result) || errnum != XLAL_SUCCESS || isinf(result))
+	{
+		TEST_FAIL("Parameter configuration within specified min/max bounds for each parameter gave zero prior.");
+	}
+	LALInferenceGetMinMaxPrior(priorArgs, "distance", &min, &max);
+	max = distance - (distance - min) / 2;
+	LALInferenceAddMinMaxPrior(priorArgs, "distance", &min, &max, LALINFERENCE_REAL8_t);
+	XLAL_TRY(result = LALInferenceInspiralPrior(runState, params, thread->model), errnum);
+	if (XLAL_IS_REAL8_FAIL_NAN(result) || errnum != XLAL_SUCCESS || isfinite(result))
+	{
+		TEST_FAIL("Distance %f is outside updated bounds [%f,%f] but prior is non-zero.", distance, min, max);
+	}
+	max = 100.0;
+	LALInferenceAddMinMaxPrior(priorArgs, "distance", &min, &max, LALINFERENCE_REAL8_t);
+	max = 0.0;
+	LALInferenceAddVariable(priorArgs, "MTotMax", &max, LALINFERENCE_REAL8_t, LALINFERENCE_PARAM_FIXED);
+	XLAL_TRY(result = LALInferenceInspiralPrior(runState, params, thread->model), errnum);
+	if (XLAL_IS_REAL8_FAIL_NAN(result) || errnum != XLAL_SUCCESS || isfinite(result))
+	{
+		TEST_FAIL("Total mass is above MTotMax %f added after the first evaluation, but prior is non-zero.", max);
+	}
+	LALInferenceRemoveVariable(priorArgs, "MTotMax");
+	XLAL_TRY(result = LALInferenceInspiralPrior(runState, params, thread->model), errnum);
+	if (XLAL_IS_REAL8_FAIL_NAN(result) || errnum != XLAL_SUCCESS || isinf(result))
+	{
+		TEST_FAIL("Removing MTotMax from the prior did not restore a non-zero prior.");
+	}
+	LALInferenceDestroyCompiledPrior(runState->compiledPrior);
+	runState->compiledPrior = NULL;
+
 	TEST_FOOTER();
 }
 
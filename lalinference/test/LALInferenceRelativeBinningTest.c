@@ -0,0 +1,144 @@
+#include <lal/LALInference.h>
+#include <lal/LALInferenceRelativeBinning.h>
+#include <lal/LALConstants.h>
+#include <lal/FrequencySeries.h>
+#include <lal/Sequence.h>
+#include <lal/Units.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/* frequency resolution and band of the test data */
+#define DELTAF (1.0/64.0)
+#define FLOW 20.0
+#define FHIGH 1024.0
+
+/* tolerance on the log likelihood difference, relative to <h|h> */
+#define LTOL 1e-4
+
+/* simple inspiral phase model */
+double calc_phase(double frequency, double Mchirp);
+
+/* inspiral-like frequency domain polarisations with merger at time tc */
+COMPLEX16 model_plus(double frequency, double Mchirp, double phi0, double tc);
+COMPLEX16 model_cross(double frequency, double Mchirp, double phi0, double tc);
+
+/* smooth calibration error model */
+COMPLEX16 cal_model(double frequency);
+
+double calc_phase(double frequency, double Mchirp){
+  return (-0.25*LAL_PI + ( 3./( 128. * pow(Mchirp*LAL_MTSUN_SI*LAL_PI*frequency, 5./3.) ) ) );
+}
+
+COMPLEX16 model_plus(double frequency, double Mchirp, double phi0, double tc){
+  return pow(frequency, -7./6.) * cexp(I*(calc_phase(frequency, Mchirp) + phi0 - LAL_TWOPI*frequency*tc));
+}
+
+COMPLEX16 model_cross(double frequency, double Mchirp, double phi0, double tc){
+  return 0.8 * I * model_plus(frequency, Mchirp, phi0, tc);
+}
+
+COMPLEX16 cal_model(double frequency){
+  return (1. + 0.05*sin(frequency/100.)) * cexp(I*0.03*cos(frequency/50.));
+}
+
+int main(void) {
+  const UINT4 length = (UINT4) (2048./DELTAF) + 1;
+  const REAL8 Mchirp0 = 1.2, Mchirp = 1.2*(1. + 2e-5);
+  const REAL8 tau0 = 0.01, tau = 0.0102, Fplus = 0.4, Fcross = -0.7;
+  const REAL8 scale = 2.*DELTAF;
+  LIGOTimeGPS epoch = {0, 0};
+  LALInferenceIFOData ifo;
+  LALInferenceRelativeBinningData *rb = NULL;
+  REAL8Sequence *edges = NULL;
+  COMPLEX16 *h0plus = NULL, *h0cross = NULL, *hplus = NULL, *hcross = NULL, *cal = NULL;
+  UINT4 kstart, kend, k, j;
+  int c, failed = 0;
+
+  memset(&ifo, 0, sizeof(ifo));
+  ifo.freqData = XLALCreateCOMPLEX16FrequencySeries("data", &epoch, 0., DELTAF, &lalDimensionlessUnit, length);
+  ifo.oneSidedNoisePowerSpectrum = XLALCreateREAL8FrequencySeries("psd", &epoch, 0., DELTAF, &lalDimensionlessUnit, length);
+  ifo.fLow = FLOW;
+  ifo.fHigh = FHIGH;
+
+  /* a signal close to the fiducial waveform, plus a deterministic stand-in for noise */
+  for ( k = 1; k < length; k++ ){
+    REAL8 f = k*DELTAF;
+    ifo.oneSidedNoisePowerSpectrum->data->data[k] = 1. + pow(40./f, 4.) + f*f/1e5;
+    ifo.freqData->data->data[k] = Fplus*model_plus(f, Mchirp0*(1. + 1e-5), 0.3, tau0 + 1e-4)
+      + Fcross*model_cross(f, Mchirp0*(1. + 1e-5), 0.3, tau0 + 1e-4)
+      + 0.1*sqrt(ifo.oneSidedNoisePowerSpectrum->data->data[k])*cexp(I*k*k*0.61803398875);
+  }
+  ifo.oneSidedNoisePowerSpectrum->data->data[0] = 1.;
+  ifo.freqData->data->data[0] = 0.;
+
+  edges = LALInferenceRelativeBinningFrequencies(FLOW, FHIGH, DELTAF, 0.1);
+  if ( !edges ) { return 1; }
+  fprintf(stdout, "%u relative binning bins\n", edges->length - 1);
+  for ( j = 1; j < edges->length; j++ ){
+    if ( !(edges->data[j] > edges->data[j-1]) || fabs(edges->data[j]/DELTAF - round(edges->data[j]/DELTAF)) > 1e-9 ){
+      fprintf(stderr, "Bin edges are not increasing multiples of deltaF\n");
+      return 1;
+    }
+  }
+
+  /* fiducial waveform on the data grid covered by the bins */
+  kstart = (UINT4) round(edges->data[0]/DELTAF);
+  kend = (UINT4) round(edges->data[edges->length-1]/DELTAF);
+  h0plus = XLALMalloc((kend - kstart + 1)*sizeof(COMPLEX16));
+  h0cross = XLALMalloc((kend - kstart + 1)*sizeof(COMPLEX16));
+  for ( k = kstart; k <= kend; k++ ){
+    h0plus[k-kstart] = model_plus(k*DELTAF, Mchirp0, 0., 0.);
+    h0cross[k-kstart] = model_cross(k*DELTAF, Mchirp0, 0., 0.);
+  }
+  rb = LALInferenceCreateRelativeBinningData(&ifo, edges, h0plus, h0cross, tau0, scale);
+  if ( !rb ) { return 1; }
+
+  /* a template differing in chirp mass, phase, amplitude and time */
+  hplus = XLALMalloc(edges->length*sizeof(COMPLEX16));
+  hcross = XLALMalloc(edges->length*sizeof(COMPLEX16));
+  cal = XLALMalloc(edges->length*sizeof(COMPLEX16));
+  for ( j = 0; j < edges->length; j++ ){
+    hplus[j] = 1.1*model_plus(edges->data[j], Mchirp, 0.5, 0.);
+    hcross[j] = 1.1*0.7/0.8*model_cross(edges->data[j], Mchirp, 0.5, 0.);
+    cal[j] = cal_model(edges->data[j]);
+  }
+
+  for ( c = 0; c < 2; c++ ){
+    REAL8 dd, hh, exact_dd = 0., exact_hh = 0., Lfrac;
+    COMPLEX16 dh, exact_dh = 0.;
+
+    if ( LALInferenceRelativeBinningInnerProducts(rb, hplus, hcross, c ? cal : NULL, Fplus, Fcross, tau, &dd, &hh, &dh) != XLAL_SUCCESS ){
+      return 1;
+    }
+
+    for ( k = (UINT4) ceil(FLOW/DELTAF); k <= (UINT4) floor(FHIGH/DELTAF); k++ ){
+      REAL8 f = k*DELTAF, w = scale/ifo.oneSidedNoisePowerSpectrum->data->data[k];
+      COMPLEX16 d = ifo.freqData->data->data[k];
+      COMPLEX16 h = (Fplus*1.1*model_plus(f, Mchirp, 0.5, 0.) + Fcross*1.1*0.7/0.8*model_cross(f, Mchirp, 0.5, 0.))
+        * cexp(-I*LAL_TWOPI*f*tau) * (c ? cal_model(f) : 1.);
+      exact_dd += w*creal(d*conj(d));
+      exact_hh += w*creal(h*conj(h));
+      exact_dh += w*d*conj(h);
+    }
+
+    Lfrac = fabs((creal(dh) - 0.5*hh) - (creal(exact_dh) - 0.5*exact_hh))/exact_hh;
+    fprintf(stdout, "Calibration %d: fractional log likelihood difference %le\n", c, Lfrac);
+    if ( fabs(dd - exact_dd) > 1e-10*exact_dd ) { failed = 1; }
+    if ( Lfrac > LTOL ) { failed = 1; }
+  }
+
+  LALInferenceDestroyRelativeBinningData(rb);
+  XLALDestroyREAL8Sequence(edges);
+  XLALFree(h0plus);
+  XLALFree(h0cross);
+  XLALFree(hplus);
+  XLALFree(hcross);
+  XLALFree(cal);
+  XLALDestroyCOMPLEX16FrequencySeries(ifo.freqData);
+  XLALDestroyREAL8FrequencySeries(ifo.oneSidedNoisePowerSpectrum);
+
+  LALCheckMemoryLeaks();
+  return failed;
+}
@@ -0,0 +1,312 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/*
+ * Compare the line tests of LALInferenceRemoveLines.c against a direct
+ * implementation which computes the periodogram of each segment in turn,
+ * on white noise with a line which is only present in half the segments.
+ */
+
+#include <lal/LALStdlib.h>
+#include <lal/TimeSeries.h>
+#include <lal/FrequencySeries.h>
+#include <lal/TimeFreqFFT.h>
+#include <lal/Window.h>
+#include <lal/Units.h>
+#include <lal/LALConstants.h>
+#include <lal/LALInferenceRemoveLines.h>
+
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+
+#include <math.h>
+#include <stdio.h>
+
+#define SEGLEN 256
+#define NUMSEG 128
+#define NUMBINS (SEGLEN/2 + 1)
+#define LINEBIN 50
+
+/* periodograms of all the segments, power[seg][k] */
+static REAL8 power[NUMSEG][NUMBINS];
+
+static int close_enough(REAL8 a, REAL8 b, REAL8 tol)
+{
+    if (isnan(a) || isnan(b))
+        return isnan(a) && isnan(b);
+    if (isinf(a) || isinf(b))
+        return a == b;
+    return fabs(a - b) <= tol * fmax(fabs(a), fabs(b)) + 1e-300;
+}
+
+static int reference_periodograms(const REAL8TimeSeries *tseries, const REAL8Window *window, const REAL8FFTPlan *plan)
+{
+    REAL8FrequencySeries *periodogram = XLALCreateREAL8FrequencySeries("periodogram", &tseries->epoch, 0.0, 0.0, &lalDimensionlessUnit, NUMBINS);
+    if (!periodogram)
+        return 1;
+    for (UINT4 seg = 0; seg < NUMSEG; ++seg) {
+        REAL8TimeSeries *segment = XLALCutREAL8TimeSeries(tseries, seg * SEGLEN, SEGLEN);
+        if (!segment || XLALREAL8ModifiedPeriodogram(periodogram, segment, window, plan) != XLAL_SUCCESS)
+            return 1;
+        for (UINT4 k = 0; k < NUMBINS; ++k)
+            power[seg][k] = periodogram->data->data[k];
+        XLALDestroyREAL8TimeSeries(segment);
+    }
+    XLALDestroyREAL8FrequencySeries(periodogram);
+    return 0;
+}
+
+/* histogram of the segment values of bin k, normalised by their mean */
+static void reference_histogram(UINT4 k, float Observed[100])
+{
+    double meanVal = 0.0;
+    for (UINT4 seg = 0; seg < NUMSEG; ++seg)
+        meanVal += power[seg][k];
+    meanVal /= (double) NUMSEG;
+    for (UINT4 l = 0; l < 100; ++l)
+        Observed[l] = 0.0;
+    for (UINT4 seg = 0; seg < NUMSEG; ++seg) {
+        double normVal = 2 * power[seg][k] / meanVal;
+        if (normVal >= 0 && normVal < 100)
+            Observed[(int) normVal] += 1;
+    }
+}
+
+static REAL8 reference_chisquared(UINT4 k)
+{
+    float Observed[100];
+    double CriticalValue = 0.0;
+    reference_histogram(k, Observed);
+    for (UINT4 l = 0; l < 100; ++l) {
+        float Expected = NUMSEG * exp(-0.5 * l);
+        double XSqr = Observed[l] - Expected;
+        CriticalValue += (float) ((XSqr * XSqr) / Expected);
+    }
+    return 1.0 / CriticalValue;
+}
+
+static REAL8 reference_ks(UINT4 k)
+{
+    float Observed[100], ObservedCDF = 0.0, ExpectedCDF = 0.0, ObservedSum = 0.0, ExpectedSum = 0.0;
+    double KS = 0.0;
+    reference_histogram(k, Observed);
+    for (UINT4 l = 0; l < 100; ++l) {
+        ObservedSum += Observed[l];
+        ExpectedSum += (float) (NUMSEG * exp(-0.5 * l));
+    }
+    for (UINT4 l = 0; l < 100; ++l) {
+        ObservedCDF += Observed[l];
+        ExpectedCDF += (float) (NUMSEG * exp(-0.5 * l));
+        double KSVal = fabs(ObservedCDF / ObservedSum - ExpectedCDF / ExpectedSum);
+        if (KSVal > KS)
+            KS = KSVal;
+    }
+    return 2 * exp(-(2.000071 + .331 / sqrt(NUMSEG) + 1.409 / NUMSEG) * NUMSEG * KS * KS);
+}
+
+static REAL8 reference_binfit(const REAL8TimeSeries *tseries, UINT4 k, double trigtime)
+{
+    double SUMx = 0, SUMy = 0, SUMxy = 0, SUMxx = 0;
+    int count = 0;
+    for (UINT4 seg = 0; seg < NUMSEG; ++seg) {
+        double t = tseries->epoch.gpsSeconds + 1e-9 * tseries->epoch.gpsNanoSeconds + seg * tseries->deltaT * SEGLEN;
+        if (t > trigtime - 0.5 && t < trigtime + 0.5)
+            continue;
+        double datavallog = log10(power[seg][k]);
+        SUMx += t;
+        SUMy += datavallog;
+        SUMxy += t * datavallog;
+        SUMxx += t * t;
+        count++;
+    }
+    double slope = (SUMx * SUMy - count * SUMxy) / (SUMx * SUMx - count * SUMxx);
+    double y_intercept = (SUMy - slope * SUMx) / count;
+    return pow(10.0, slope * trigtime + y_intercept);
+}
+
+static REAL8 reference_xcorr(UINT4 k, UINT4 l)
+{
+    double mx = 0, my = 0, sx = 0, sy = 0, sxy = 0;
+    for (UINT4 seg = 0; seg < NUMSEG; ++seg) {
+        mx += power[seg][k];
+        my += power[seg][l];
+    }
+    mx /= NUMSEG;
+    my /= NUMSEG;
+    for (UINT4 seg = 0; seg < NUMSEG; ++seg) {
+        sx += (power[seg][k] - mx) * (power[seg][k] - mx);
+        sy += (power[seg][l] - my) * (power[seg][l] - my);
+        sxy += (power[seg][k] - mx) * (power[seg][l] - my);
+    }
+    return fabs(sxy / sqrt(sx * sy));
+}
+
+static void reference_powerlaw(const REAL8FrequencySeries *spectrum, REAL8 *pvalues)
+{
+    const float frequencyBands[4] = {0, 10, 100, 2048};
+    for (UINT4 k = 0; k < NUMBINS; ++k)
+        pvalues[k] = 0.0;
+    for (UINT4 b = 0; b < 3; ++b) {
+        double SUMx = 0, SUMy = 0, SUMxy = 0, SUMxx = 0;
+        int count = 0;
+        for (UINT4 k = 0; k < NUMBINS; ++k) {
+            double f = ((double) k) * spectrum->deltaF;
+            if (f >= frequencyBands[b] && f <= frequencyBands[b + 1]) {
+                double flog = log10(f), datavallog = log10(spectrum->data->data[k]);
+                SUMx += flog;
+                SUMy += datavallog;
+                SUMxy += flog * datavallog;
+                SUMxx += flog * flog;
+                count++;
+            }
+        }
+        double slope = (SUMx * SUMy - count * SUMxy) / (SUMx * SUMx - count * SUMxx);
+        double y_intercept = (SUMy - slope * SUMx) / count;
+        for (UINT4 k = 0; k < NUMBINS; ++k) {
+            double f = ((double) k) * spectrum->deltaF;
+            if (f >= frequencyBands[b] && f <= frequencyBands[b + 1])
+                pvalues[k] = 1.0 / fabs(log10(spectrum->data->data[k]) - (slope * log10(f) + y_intercept));
+        }
+    }
+}
+
+/* add white noise, and a line in bin 'linebin' of every other segment */
+static void make_data(REAL8TimeSeries *tseries, gsl_rng *rng, UINT4 linebin)
+{
+    const REAL8 f = linebin / (SEGLEN * tseries->deltaT);
+    for (UINT4 j = 0; j < tseries->data->length; ++j) {
+        tseries->data->data[j] = gsl_ran_ugaussian(rng);
+        if ((j / SEGLEN) % 2 == 0)
+            tseries->data->data[j] += 2.0 * sin(LAL_TWOPI * f * j * tseries->deltaT);
+    }
+}
+
+static int test_line_tests(const REAL8TimeSeries *tseries, REAL8FrequencySeries *spectrum, const REAL8Window *window, const REAL8FFTPlan *plan, UINT4 linebin)
+{
+    const REAL8 tol = 1e-5;
+    char binfitname[] = "LALInferenceRemoveLinesTest_binfit.out";
+    char xcorrname[] = "LALInferenceRemoveLinesTest_xcorr.out";
+    REAL8 pvalues[NUMBINS], pvalues_ref[NUMBINS];
+    int failed = 0;
+
+    if (reference_periodograms(tseries, window, plan))
+        return 1;
+
+    /* chi-squared test */
+    if (LALInferenceRemoveLinesChiSquared(spectrum, tseries, SEGLEN, SEGLEN, window, plan, pvalues) != 0)
+        return 1;
+    for (UINT4 k = 0; k < NUMBINS; ++k)
+        if (!close_enough(pvalues[k], reference_chisquared(k), tol)) {
+            fprintf(stderr, "chi-squared test: bin %u: %e != %e\n", k, pvalues[k], reference_chisquared(k));
+            failed = 1;
+        }
+
+    /* Kolmogorov-Smirnov test; the line must be the most significant bin */
+    if (LALInferenceRemoveLinesKS(spectrum, tseries, SEGLEN, SEGLEN, window, plan, pvalues) != 0)
+        return 1;
+    for (UINT4 k = 0; k < NUMBINS; ++k) {
+        if (!close_enough(pvalues[k], reference_ks(k), tol)) {
+            fprintf(stderr, "KS test: bin %u: %e != %e\n", k, pvalues[k], reference_ks(k));
+            failed = 1;
+        }
+        if (k != linebin && pvalues[k] <= pvalues[linebin]) {
+            fprintf(stderr, "KS test: bin %u is as significant as the line in bin %u\n", k, linebin);
+            failed = 1;
+        }
+    }
+
+    /* fit of each bin against time, with the trigger time inside and outside the data */
+    const double start = tseries->epoch.gpsSeconds + 1e-9 * tseries->epoch.gpsNanoSeconds;
+    const double trigtimes[2] = {start + 10.2, start - 100.0};
+    for (UINT4 i = 0; i < 2; ++i) {
+        LIGOTimeGPS GPStime;
+        XLALGPSSetREAL8(&GPStime, trigtimes[i]);
+        if (LALInferenceAverageSpectrumBinFit(spectrum, tseries, SEGLEN, SEGLEN, window, plan, binfitname, GPStime) != 0)
+            return 1;
+        for (UINT4 k = 0; k < NUMBINS; ++k)
+            if (!close_enough(spectrum->data->data[k], reference_binfit(tseries, k, trigtimes[i]), tol)) {
+                fprintf(stderr, "bin fit %u: bin %u: %e != %e\n", i, k, spectrum->data->data[k], reference_binfit(tseries, k, trigtimes[i]));
+                failed = 1;
+            }
+    }
+
+    /* cross-correlation of the bins */
+    if (LALInferenceXCorrBands(spectrum, tseries, SEGLEN, SEGLEN, window, plan, pvalues, xcorrname) != 0)
+        return 1;
+    FILE *fp = fopen(xcorrname, "r");
+    if (!fp)
+        return 1;
+    for (UINT4 k = 0; k < NUMBINS; ++k) {
+        double f, r;
+        if (fscanf(fp, "%le", &f) != 1 || !close_enough(f, k * spectrum->deltaF, tol))
+            failed = 1;
+        for (UINT4 l = 0; l < NUMBINS; ++l)
+            if (fscanf(fp, "%le", &r) != 1 || !close_enough(r, reference_xcorr(k, l), tol)) {
+                fprintf(stderr, "cross-correlation: bins %u, %u: %e != %e\n", k, l, r, reference_xcorr(k, l));
+                failed = 1;
+            }
+    }
+    fclose(fp);
+
+    /* power law fit to the average spectrum */
+    for (UINT4 k = 0; k < NUMBINS; ++k) {
+        spectrum->data->data[k] = 0.0;
+        for (UINT4 seg = 0; seg < NUMSEG; ++seg)
+            spectrum->data->data[k] += power[seg][k] / NUMSEG;
+    }
+    if (LALInferenceRemoveLinesPowerLaw(spectrum, tseries, SEGLEN, SEGLEN, window, plan, pvalues) != 0)
+        return 1;
+    reference_powerlaw(spectrum, pvalues_ref);
+    for (UINT4 k = 0; k < NUMBINS; ++k)
+        if (!close_enough(pvalues[k], pvalues_ref[k], tol)) {
+            fprintf(stderr, "power law: bin %u: %e != %e\n", k, pvalues[k], pvalues_ref[k]);
+            failed = 1;
+        }
+
+    return failed;
+}
+
+int main(void) {
+    int failed = 0;
+    const LIGOTimeGPS epoch = {100, 0};
+    const REAL8 deltaT = 1.0 / SEGLEN;
+    gsl_rng *rng = gsl_rng_alloc(gsl_rng_mt19937);
+    REAL8TimeSeries *tseries = XLALCreateREAL8TimeSeries("data", &epoch, 0.0, deltaT, &lalStrainUnit, NUMSEG * SEGLEN);
+    REAL8FrequencySeries *spectrum = XLALCreateREAL8FrequencySeries("spectrum", &epoch, 0.0, 1.0 / (SEGLEN * deltaT), &lalDimensionlessUnit, NUMBINS);
+    REAL8Window *window = XLALCreateHannREAL8Window(SEGLEN);
+    REAL8FFTPlan *plan = XLALCreateForwardREAL8FFTPlan(SEGLEN, 0);
+    if (!rng || !tseries || !spectrum || !window || !plan)
+        return 1;
+
+    make_data(tseries, rng, LINEBIN);
+    failed |= test_line_tests(tseries, spectrum, window, plan, LINEBIN);
+
+    /* change the data in place; the cached periodograms must not be reused */
+    make_data(tseries, rng, LINEBIN + 20);
+    failed |= test_line_tests(tseries, spectrum, window, plan, LINEBIN + 20);
+
+    fprintf(stdout, "LALInferenceRemoveLines tests %s\n", failed ? "FAILED" : "passed");
+
+    XLALDestroyREAL8FFTPlan(plan);
+    XLALDestroyREAL8Window(window);
+    XLALDestroyREAL8FrequencySeries(spectrum);
+    XLALDestroyREAL8TimeSeries(tseries);
+    gsl_rng_free(rng);
+
+    LALCheckMemoryLeaks();
+    return failed;
+}
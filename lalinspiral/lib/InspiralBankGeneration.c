@@ -25,6 +25,36 @@
 #include<lal/LALInspiralBank.h>
 #include<lal/LIGOMetadataTables.h>
 
+/* Moments of the PSD at the cutoff frequency of a template, taken from the
+ * table when it covers the template and integrated directly otherwise */
+static void
+InspiralBankGenerationMoments(
+     LALStatus *status,
+     InspiralMomentsEtc *moments,
+     InspiralCoarseBankIn *input,
+     const InspiralMomentsTable *table,
+     InspiralTemplate *params )
+{
+  INITSTATUS(status);
+  ATTATCHSTATUSPTR(status);
+
+  if ( table && params->fLower == input->fLower )
+  {
+    if ( XLALGetInspiralMomentsFromTable( moments, params->fCutoff, table ) != XLAL_SUCCESS )
+    {
+      ABORTXLAL( status );
+    }
+  }
+  else
+  {
+    LALGetInspiralMoments( status->statusPtr, moments, &(input->shf), params );
+    CHECKSTATUSPTR( status );
+  }
+
+  DETATCHSTATUSPTR(status);
+  RETURN(status);
+}
+
 void
 LALInspiralBankGeneration(
      LALStatus *status,
@@ -35,6 +65,7 @@ LALInspiralBankGeneration(
   InspiralTemplateList *coarseList = NULL;
   SnglInspiralTable *bank;
   InspiralMomentsEtc moments;
+  InspiralMomentsTable *momentsTable = NULL;
   INT4 cnt        = 0;
   REAL8 fFinal    = 0;
   REAL8 minfFinal = 0;
@@ -81,7 +112,19 @@ LALInspiralBankGeneration(
     /* Use LALInspiralCreateCoarseBank(). */
     TRY( LALInspiralCreateCoarseBank( status->statusPtr, &coarseList, ntiles,
          *input ), status );
-    /* */
+
+    /* The moments are recomputed at the final frequency of every
+     * template, so integrate the PSD once for all of them */
+    if ( input->computeMoments )
+    {
+      momentsTable = XLALCreateInspiralMomentsTable( input->fLower,
+          input->fUpper, &(input->shf) );
+      if ( ! momentsTable )
+      {
+        XLALClearErrno();
+      }
+    }
+
     /* Convert output data structure. */
     bank = (SnglInspiralTable *) LALCalloc(1, sizeof(SnglInspiralTable));
     if (bank == NULL){
@@ -219,8 +262,8 @@ LALInspiralBankGeneration(
 	  if ( input->computeMoments )
 	    {
 	      coarseList[cnt].params.fCutoff = coarseList[cnt].params.fFinal;
-	      LALGetInspiralMoments( status->statusPtr, &moments, &(input->shf),
-				     &(coarseList[cnt].params) );
+	      InspiralBankGenerationMoments( status->statusPtr, &moments, input,
+				     momentsTable, &(coarseList[cnt].params) );
 
 	      LALInspiralComputeMetric(status->statusPtr, &(coarseList[cnt].metric),
 				       &(coarseList[cnt].params), &moments);
@@ -276,8 +319,8 @@ LALInspiralBankGeneration(
       if ( input->computeMoments )
       {
         coarseList[cnt].params.fCutoff = coarseList[cnt].params.fFinal;
-        LALGetInspiralMoments( status->statusPtr, &moments, &(input->shf),
-            &(coarseList[cnt].params) );
+        InspiralBankGenerationMoments( status->statusPtr, &moments, input,
+            momentsTable, &(coarseList[cnt].params) );
 
         LALInspiralComputeMetric(status->statusPtr, &(coarseList[cnt].metric),
             &(coarseList[cnt].params), &moments);
@@ -299,6 +342,7 @@ LALInspiralBankGeneration(
     *first = bank;
     /* free the coarse list returned by create coarse bank */
     LALFree( coarseList );
+    XLALDestroyInspiralMomentsTable( momentsTable );
     break;
 
   case FindChirpPTF:
@@ -1572,6 +1572,34 @@ int XLALInspiralCalculateIIRSetInnerProduct(
 	double             *ip
 	);
 
+/**
+ * Streaming filter engine for a summed-parallel IIR template, as generated
+ * by XLALInspiralGenerateIIRSet().  It holds the filter coefficients, the
+ * filter states and a delay line of past input, so that consecutive calls
+ * to XLALInspiralIIRFilterBankApply() filter a continuous data stream.
+ */
+typedef struct tagInspiralIIRFilterBank InspiralIIRFilterBank;
+
+InspiralIIRFilterBank *XLALCreateInspiralIIRFilterBank(
+	const COMPLEX16Vector *a1,
+	const COMPLEX16Vector *b0,
+	const INT4Vector      *delay
+	);
+
+void XLALDestroyInspiralIIRFilterBank(
+	InspiralIIRFilterBank *bank
+	);
+
+int XLALInspiralIIRFilterBankReset(
+	InspiralIIRFilterBank *bank
+	);
+
+int XLALInspiralIIRFilterBankApply(
+	InspiralIIRFilterBank *bank,
+	COMPLEX16Vector       *output,
+	const REAL8Vector     *input
+	);
+
 int
 XLALNRInjectionFromSimInspiral(
     REAL8TimeSeries **hplus,
@@ -532,6 +532,12 @@ tagInspiralMomentsEtc
 }
 InspiralMomentsEtc;
 
+/**
+ * Moments of a PSD tabulated for a fixed lower frequency and all upper
+ * cutoffs up to a maximum, created by XLALCreateInspiralMomentsTable().
+ */
+typedef struct tagInspiralMomentsTable InspiralMomentsTable;
+
 /** UNDOCUMENTED */
 typedef struct
 tagInspiralMomentsEtcBCV
@@ -837,6 +843,25 @@ XLALGetInspiralMoments (
     REAL8FrequencySeries *psd
     );
 
+InspiralMomentsTable *
+XLALCreateInspiralMomentsTable (
+    REAL8 fLower,
+    REAL8 fUpper,
+    REAL8FrequencySeries *psd
+    );
+
+void
+XLALDestroyInspiralMomentsTable (
+    InspiralMomentsTable *table
+    );
+
+int
+XLALGetInspiralMomentsFromTable (
+    InspiralMomentsEtc *moments,
+    REAL8 fCutoff,
+    const InspiralMomentsTable *table
+    );
+
 void
 LALGetInspiralMomentsBCV (
     LALStatus               *status,
@@ -17,7 +17,37 @@
 */
 
 #include <lal/LALInspiral.h>
+#include <lal/VectorMath.h>
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp ignore
+#endif
+
+/* number of filters evaluated together as SIMD lanes, and byte alignment of their coefficients */
+#define IIR_LANES 8
+#define IIR_ALIGN 64
+
+/* minimum number of input samples added to the delay line at a time */
+#define IIR_BLOCK 4096
+
+/*
+ * A bank of first order filters y_k[t] = a1_k y_k[t-1] + b0_k x[t - delay_k]
+ * stored as structure-of-arrays.  Filters are sorted by delay so that each
+ * group of IIR_LANES filters reads a short stretch of the delay line.
+ */
+struct tagInspiralIIRFilterBank {
+	UINT4 nfilters;             /* number of filters including padding, a multiple of IIR_LANES */
+	UINT4 maxdelay;             /* largest delay in samples */
+	UINT4 block;                /* number of new samples held by the delay line */
+	REAL8VectorAligned *coeffs; /* a1 real, a1 imag, b0 real, b0 imag, y real, y imag, each nfilters long */
+	INT4 *delay;                /* delay of each filter in samples */
+	REAL8 *line;                /* delay line of maxdelay past samples followed by block new samples */
+};
 
 static REAL8 clogabs(COMPLEX16 z)
 {
@@ -211,3 +241,191 @@ int XLALInspiralCalculateIIRSetInnerProduct(COMPLEX16Vector *a1, COMPLEX16Vector
 
 	return 0;
 }
+
+typedef struct {
+	INT4 delay;
+	COMPLEX16 a1;
+	COMPLEX16 b0;
+} IIRSortEntry;
+
+static int compare_iir_delay(const void *a, const void *b)
+{
+	const IIRSortEntry *A = (const IIRSortEntry *) a;
+	const IIRSortEntry *B = (const IIRSortEntry *) b;
+	return (A->delay > B->delay) - (A->delay < B->delay);
+}
+
+InspiralIIRFilterBank *XLALCreateInspiralIIRFilterBank(const COMPLEX16Vector *a1, const COMPLEX16Vector *b0, const INT4Vector *delay)
+{
+	InspiralIIRFilterBank *bank;
+	IIRSortEntry *entries;
+	UINT4 k, n;
+
+	XLAL_CHECK_NULL(a1 && b0 && delay, XLAL_EFAULT);
+	XLAL_CHECK_NULL(a1->length > 0, XLAL_EINVAL, "Empty IIR filter set");
+	XLAL_CHECK_NULL(a1->length == b0->length && a1->length == delay->length, XLAL_EBADLEN);
+
+	entries = XLALMalloc(a1->length * sizeof(*entries));
+	XLAL_CHECK_NULL(entries, XLAL_ENOMEM);
+	for (k = 0; k < a1->length; k++) {
+		if (delay->data[k] < 0) {
+			XLALFree(entries);
+			XLAL_ERROR_NULL(XLAL_EDOM, "Negative delay %d for IIR filter %u", delay->data[k], k);
+		}
+		entries[k].delay = delay->data[k];
+		entries[k].a1 = a1->data[k];
+		entries[k].b0 = b0->data[k];
+	}
+	qsort(entries, a1->length, sizeof(*entries), compare_iir_delay);
+
+	bank = XLALCalloc(1, sizeof(*bank));
+	if (!bank) {
+		XLALFree(entries);
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	}
+	n = bank->nfilters = ((a1->length + IIR_LANES - 1) / IIR_LANES) * IIR_LANES;
+	bank->maxdelay = (UINT4) entries[a1->length - 1].delay;
+	bank->block = bank->maxdelay > IIR_BLOCK ? bank->maxdelay : IIR_BLOCK;
+	bank->coeffs = XLALCreateREAL8VectorAligned(6 * n, IIR_ALIGN);
+	bank->delay = XLALCalloc(n, sizeof(*bank->delay));
+	bank->line = XLALCalloc(bank->maxdelay + bank->block, sizeof(*bank->line));
+	if (!bank->coeffs || !bank->delay || !bank->line) {
+		XLALFree(entries);
+		XLALDestroyInspiralIIRFilterBank(bank);
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	}
+
+	/* padding filters have zero coefficients and contribute nothing */
+	memset(bank->coeffs->data, 0, 6 * n * sizeof(REAL8));
+	for (k = 0; k < a1->length; k++) {
+		bank->coeffs->data[k] = creal(entries[k].a1);
+		bank->coeffs->data[n + k] = cimag(entries[k].a1);
+		bank->coeffs->data[2 * n + k] = creal(entries[k].b0);
+		bank->coeffs->data[3 * n + k] = cimag(entries[k].b0);
+		bank->delay[k] = entries[k].delay;
+	}
+	XLALFree(entries);
+
+	return bank;
+}
+
+void XLALDestroyInspiralIIRFilterBank(InspiralIIRFilterBank *bank)
+{
+	if (!bank)
+		return;
+	XLALDestroyREAL8VectorAligned(bank->coeffs);
+	XLALFree(bank->delay);
+	XLALFree(bank->line);
+	XLALFree(bank);
+}
+
+int XLALInspiralIIRFilterBankReset(InspiralIIRFilterBank *bank)
+{
+	XLAL_CHECK(bank, XLAL_EFAULT);
+	memset(bank->coeffs->data + 4 * bank->nfilters, 0, 2 * bank->nfilters * sizeof(REAL8));
+	memset(bank->line, 0, (bank->maxdelay + bank->block) * sizeof(REAL8));
+	return XLAL_SUCCESS;
+}
+
+/*
+ * Run filters [start, start + IIR_LANES) over the nsamples new samples at
+ * x, adding their summed output to outre and outim.  The filter states
+ * stay in registers for the whole stretch, and at each sample the lanes
+ * read from within the span of their delays behind x.
+ */
+static void iir_filter_lanes(InspiralIIRFilterBank *bank, UINT4 start, const REAL8 *x, UINT4 nsamples, REAL8 *outre, REAL8 *outim)
+{
+	const UINT4 n = bank->nfilters;
+	const REAL8 *c = bank->coeffs->data;
+	REAL8 a1re[IIR_LANES], a1im[IIR_LANES], b0re[IIR_LANES], b0im[IIR_LANES], yre[IIR_LANES], yim[IIR_LANES];
+	INT4 d[IIR_LANES];
+	UINT4 l, t;
+
+	for (l = 0; l < IIR_LANES; l++) {
+		a1re[l] = c[start + l];
+		a1im[l] = c[n + start + l];
+		b0re[l] = c[2 * n + start + l];
+		b0im[l] = c[3 * n + start + l];
+		yre[l] = c[4 * n + start + l];
+		yim[l] = c[5 * n + start + l];
+		d[l] = bank->delay[start + l];
+	}
+
+	for (t = 0; t < nsamples; t++) {
+		REAL8 sumre = 0.0, sumim = 0.0;
+		#pragma omp simd reduction(+:sumre,sumim)
+		for (l = 0; l < IIR_LANES; l++) {
+			const REAL8 xd = x[(INT4) t - d[l]];
+			const REAL8 re = a1re[l] * yre[l] - a1im[l] * yim[l] + b0re[l] * xd;
+			const REAL8 im = a1re[l] * yim[l] + a1im[l] * yre[l] + b0im[l] * xd;
+			yre[l] = re;
+			yim[l] = im;
+			sumre += re;
+			sumim += im;
+		}
+		outre[t] += sumre;
+		outim[t] += sumim;
+	}
+
+	for (l = 0; l < IIR_LANES; l++) {
+		bank->coeffs->data[4 * n + start + l] = yre[l];
+		bank->coeffs->data[5 * n + start + l] = yim[l];
+	}
+}
+
+int XLALInspiralIIRFilterBankApply(InspiralIIRFilterBank *bank, COMPLEX16Vector *output, const REAL8Vector *input)
+{
+	REAL8 *parts;
+	UINT4 offset;
+	int nthreads = 1;
+
+	XLAL_CHECK(bank && output && input, XLAL_EFAULT);
+	XLAL_CHECK(output->length == input->length, XLAL_EBADLEN);
+
+#ifdef _OPENMP
+	nthreads = omp_get_max_threads();
+#endif
+
+	/* one real and one imaginary output accumulator per thread */
+	parts = XLALMalloc(2 * nthreads * bank->block * sizeof(*parts));
+	XLAL_CHECK(parts, XLAL_ENOMEM);
+
+	for (offset = 0; offset < input->length; ) {
+		const UINT4 nsamples = input->length - offset < bank->block ? input->length - offset : bank->block;
+		const REAL8 *x = bank->line + bank->maxdelay;
+		UINT4 t;
+		int i;
+
+		/* append the new samples after the maxdelay samples of history */
+		memcpy(bank->line + bank->maxdelay, input->data + offset, nsamples * sizeof(REAL8));
+		memset(parts, 0, 2 * nthreads * bank->block * sizeof(*parts));
+
+		#pragma omp parallel num_threads(nthreads)
+		{
+			int tid = 0;
+			INT4 start;
+#ifdef _OPENMP
+			tid = omp_get_thread_num();
+#endif
+			#pragma omp for schedule(static)
+			for (start = 0; start < (INT4) bank->nfilters; start += IIR_LANES)
+				iir_filter_lanes(bank, (UINT4) start, x, nsamples, parts + 2 * tid * bank->block, parts + (2 * tid + 1) * bank->block);
+		}
+
+		for (t = 0; t < nsamples; t++) {
+			REAL8 re = 0.0, im = 0.0;
+			for (i = 0; i < nthreads; i++) {
+				re += parts[2 * i * bank->block + t];
+				im += parts[(2 * i + 1) * bank->block + t];
+			}
+			output->data[offset + t] = crect(re, im);
+		}
+
+		/* keep the last maxdelay samples as the history of the next block */
+		memmove(bank->line, bank->line + nsamples, bank->maxdelay * sizeof(REAL8));
+		offset += nsamples;
+	}
+
+	XLALFree(parts);
+	return XLAL_SUCCESS;
+}
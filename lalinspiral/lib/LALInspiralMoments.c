@@ -52,12 +52,22 @@
  * \mathtt{moment} = \int_{\mathtt{xmin}}^{\mathtt{xmax}}
  * \frac{x^{-\mathtt{ndx}}}{S_h(x)}\, dx \, .
  * \f}
+ *
+ * XLALGetInspiralMoments() computes the integrals for all the exponents
+ * \f$q/3\f$ in a single pass over the power spectral density.  When the
+ * moments are needed for many upper cutoffs with the same PSD and lower
+ * frequency, as when the metric is recomputed at the final frequency of
+ * each template of a bank, XLALCreateInspiralMomentsTable() stores the
+ * cumulative integrals once so that XLALGetInspiralMomentsFromTable()
+ * returns the moments for each cutoff without integrating again.  Both
+ * give the same values as XLALGetInspiralMoments().
  */
 
 /** @{ */
 
 #include <lal/LALInspiralBank.h>
 #include <lal/Integrate.h>
+#include <string.h>
 
 /* Deprecation Warning */
 
@@ -82,6 +92,129 @@ LALGetInspiralMoments (
   RETURN( status );
 }
 
+/* number of normalised moments J(q/3), q = 1 ... 17, returned in InspiralMomentsEtc */
+#define NUM_MOMENTS 17
+
+/*
+ * Moments tabulated for all upper cutoffs at a fixed lower frequency.
+ * Entry sums[(k - kMin) * NUM_MOMENTS + q - 1] holds the trapezoidal sum
+ * used by XLALInspiralMoments() for exponent q/3, up to but excluding its
+ * closing point k.  The PSD values give the closing point.
+ */
+struct tagInspiralMomentsTable {
+  REAL8 fLower;   /* lower frequency of the integrals */
+  REAL8 x0;       /* PSD f0, in units of fLower */
+  REAL8 deltaX;   /* PSD deltaF, in units of fLower */
+  size_t kMin;    /* first bin of the integrals */
+  size_t kMax;    /* last closing point in the table */
+  size_t length;  /* length of the PSD */
+  REAL8 *psd;     /* PSD values from kMin to kMax, where they exist */
+  REAL8 *sums;    /* cumulative sums */
+};
+
+static void
+SetInspiralMomentsCoefficients (
+    InspiralMomentsEtc *moments
+    )
+{
+  /* Constants needed in computing the moments */
+  moments->a01 = 3.L/5.L;
+  moments->a21 = 11.L * LAL_PI/12.L;
+  moments->a22 = 743.L/2016.L * cbrt(25.L/(2.L*LAL_PI*LAL_PI));
+  moments->a31 = -3.L/2.L;
+  moments->a41 = 617.L * LAL_PI * LAL_PI / 384.L;
+  moments->a42 = 5429.L/5376.L * cbrt(25.L*LAL_PI/2.L);
+  moments->a43 = 1.5293365L/1.0838016L * cbrt(5.L/(4.L*LAL_PI*LAL_PI*LAL_PI*LAL_PI));
+}
+
+/*
+ * Accumulate the integrals of XLALInspiralMoments() for all exponents
+ * q/3 in one pass over the PSD, before adding the closing point kMax.
+ * The terms and the order of summation for each exponent are the same
+ * as in XLALInspiralMoments().  If cumulative is not NULL, the partial
+ * sums before each bin from kMin to kMax are stored in it.
+ */
+static void
+SumInspiralMoments (
+    REAL8 *sums,
+    REAL8 *cumulative,
+    const REAL8 *psd,
+    size_t kMin,
+    size_t kMax,
+    REAL8 x0,
+    REAL8 deltaX
+    )
+{
+  size_t k, q;
+
+  for ( q = 1; q <= NUM_MOMENTS; ++q )
+    sums[q-1] = 0;
+
+  /* do the first point of the integral */
+  if ( psd[kMin] ) {
+    const REAL8 x = x0 + kMin * deltaX;
+    for ( q = 1; q <= NUM_MOMENTS; ++q )
+      sums[q-1] += pow( x, -((REAL8) q / 3.L) ) / ( 2.0 * psd[kMin] );
+  }
+  if ( cumulative ) {
+    memcpy( cumulative, sums, NUM_MOMENTS * sizeof(*sums) );
+    if ( kMax > kMin )
+      memcpy( cumulative + NUM_MOMENTS, sums, NUM_MOMENTS * sizeof(*sums) );
+  }
+
+  /* do the bulk of the integral */
+  for ( k = kMin + 1; k < kMax; ++k ) {
+    const REAL8 psd_val = psd[k];
+    if ( psd_val ) {
+      const REAL8 x = x0 + k * deltaX;
+      for ( q = 1; q <= NUM_MOMENTS; ++q )
+        sums[q-1] += pow( x, -((REAL8) q / 3.L) ) / psd_val;
+    }
+    if ( cumulative )
+      memcpy( cumulative + (k + 1 - kMin) * NUM_MOMENTS, sums, NUM_MOMENTS * sizeof(*sums) );
+  }
+}
+
+/*
+ * Add the closing point of the integrals and normalise them by J(7/3)
+ * as XLALGetInspiralMoments() does.
+ */
+static int
+NormaliseInspiralMoments (
+    InspiralMomentsEtc *moments,
+    REAL8 *sums,
+    const REAL8 *psd_kMax,
+    REAL8 xMax,
+    REAL8 deltaX
+    )
+{
+  size_t q;
+  REAL8 norm;
+
+  /* Do the last point of the integral, but allow the integration domain
+     to be open on the right if necessary. */
+  if ( psd_kMax && *psd_kMax ) {
+    for ( q = 1; q <= NUM_MOMENTS; ++q )
+      sums[q-1] += pow( xMax, -((REAL8) q / 3.L) ) / ( 2.0 * (*psd_kMax) );
+  }
+
+  for ( q = 1; q <= NUM_MOMENTS; ++q )
+    sums[q-1] *= deltaX;
+
+  /* First compute the norm, then the normalised moments of the noise PSD
+     from 1/3 to 17/3. */
+  norm = sums[6];
+  if ( !(norm > 0) ){
+    XLALPrintError("Moment J(7/3) of the PSD is not positive\n");
+    XLAL_ERROR(XLAL_EDOM);
+  }
+  moments->j[7] = norm;
+  for ( q = 1; q <= NUM_MOMENTS; ++q )
+    moments->j[q] = sums[q-1] / norm;
+
+  return XLAL_SUCCESS;
+}
+
 int
 XLALGetInspiralMoments (
     InspiralMomentsEtc   *moments,
@@ -90,18 +223,16 @@ XLALGetInspiralMoments (
     REAL8FrequencySeries *psd
     )
 {
-  size_t k;
-  REAL8 xmin;
-  REAL8 xmax;
-  REAL8 ndx;
-  REAL8 norm;
+  REAL8 sums[NUM_MOMENTS];
+  REAL8 x0, deltaX, xmax;
+  size_t kMin, kMax;
 
   /* Check inputs */
   if (!moments){
     XLALPrintError("Moments is NULL\n");
     XLAL_ERROR(XLAL_EFAULT);
   }
-  if (!psd){
+  if (!psd || !(psd->data) || !(psd->data->data)){
     XLALPrintError("PSD is NULL\n");
     XLAL_ERROR(XLAL_EFAULT);
   }
@@ -111,41 +242,131 @@ XLALGetInspiralMoments (
     XLAL_ERROR(XLAL_EDOM);
   };
 
-  /* Constants needed in computing the moments */
-  moments->a01 = 3.L/5.L;
-  moments->a21 = 11.L * LAL_PI/12.L;
-  moments->a22 = 743.L/2016.L * cbrt(25.L/(2.L*LAL_PI*LAL_PI));
-  moments->a31 = -3.L/2.L;
-  moments->a41 = 617.L * LAL_PI * LAL_PI / 384.L;
-  moments->a42 = 5429.L/5376.L * cbrt(25.L*LAL_PI/2.L);
-  moments->a43 = 1.5293365L/1.0838016L * cbrt(5.L/(4.L*LAL_PI*LAL_PI*LAL_PI*LAL_PI));
+  SetInspiralMomentsCoefficients( moments );
 
   /* Divide all frequencies by fLower, a scaling that is used in solving */
   /* the moments integral                                                */
-  psd->f0 /= fLower;
-  psd->deltaF /= fLower;
-  xmin = fLower / fLower;
+  x0 = psd->f0 / fLower;
+  deltaX = psd->deltaF / fLower;
   xmax = fCutoff / fLower;
 
-  /* First compute the norm and print if requested */
-  norm = 1.L;
-  ndx = 7.L/3.L;
-  moments->j[7]=XLALInspiralMoments(xmin, xmax, ndx, norm, psd);
-  if (XLAL_IS_REAL8_FAIL_NAN(moments->j[7])){
+  /* set up and check domain of integration */
+  kMax = floor((xmax - x0) / deltaX);
+  if ( (1.0 < x0) || (kMax > psd->data->length) ) {
+    XLALPrintError("PSD does not cover domain of integration\n");
+    XLAL_ERROR(XLAL_EDOM);
+  }
+  kMin = floor((1.0 - x0) / deltaX);
+
+  SumInspiralMoments( sums, NULL, psd->data->data, kMin, kMax, x0, deltaX );
+  if ( NormaliseInspiralMoments( moments, sums,
+        kMax < psd->data->length ? psd->data->data + kMax : NULL,
+        x0 + kMax * deltaX, deltaX ) != XLAL_SUCCESS ){
     XLAL_ERROR(XLAL_EFUNC);
   }
-  norm = moments->j[7];
 
-  /* Then compute the normalised moments of the noise PSD from 1/3 to 17/3. */
-  for ( k = 1; k <= 17; ++k )
+  return XLAL_SUCCESS;
+}
+
+InspiralMomentsTable *
+XLALCreateInspiralMomentsTable (
+    REAL8 fLower,
+    REAL8 fUpper,
+    REAL8FrequencySeries *psd
+    )
+{
+  InspiralMomentsTable *table;
+  size_t k, kMax;
+
+  /* Check inputs */
+  if (!psd || !(psd->data) || !(psd->data->data)){
+    XLALPrintError("PSD is NULL\n");
+    XLAL_ERROR_NULL(XLAL_EFAULT);
+  }
+  if (fLower <= 0 || fUpper <= fLower){
+    XLALPrintError("fLower must be between 0 and fUpper\n");
+    XLAL_ERROR_NULL(XLAL_EDOM);
+  }
+
+  table = XLALCalloc( 1, sizeof(*table) );
+  if ( !table )
+    XLAL_ERROR_NULL(XLAL_ENOMEM);
+  table->fLower = fLower;
+  table->x0 = psd->f0 / fLower;
+  table->deltaX = psd->deltaF / fLower;
+  table->length = psd->data->length;
+
+  kMax = floor((fUpper / fLower - table->x0) / table->deltaX);
+  if ( (1.0 < table->x0) || (kMax > table->length) ) {
+    XLALDestroyInspiralMomentsTable( table );
+    XLALPrintError("PSD does not cover domain of integration\n");
+    XLAL_ERROR_NULL(XLAL_EDOM);
+  }
+  table->kMin = floor((1.0 - table->x0) / table->deltaX);
+  table->kMax = kMax;
+
+  table->psd = XLALMalloc( (kMax - table->kMin + 1) * sizeof(*table->psd) );
+  table->sums = XLALMalloc( (kMax - table->kMin + 1) * NUM_MOMENTS * sizeof(*table->sums) );
+  if ( !table->psd || !table->sums ) {
+    XLALDestroyInspiralMomentsTable( table );
+    XLAL_ERROR_NULL(XLAL_ENOMEM);
+  }
+  for ( k = table->kMin; k <= kMax && k < table->length; ++k )
+    table->psd[k - table->kMin] = psd->data->data[k];
+
   {
-    ndx = (REAL8) k / 3.L;
-    moments->j[k]=XLALInspiralMoments(xmin, xmax, ndx, norm, psd);
+    REAL8 sums[NUM_MOMENTS];
+    SumInspiralMoments( sums, table->sums, psd->data->data, table->kMin, kMax, table->x0, table->deltaX );
+  }
+
+  return table;
+}
+
+void
+XLALDestroyInspiralMomentsTable (
+    InspiralMomentsTable *table
+    )
+{
+  if ( !table )
+    return;
+  XLALFree( table->psd );
+  XLALFree( table->sums );
+  XLALFree( table );
+}
+
+int
+XLALGetInspiralMomentsFromTable (
+    InspiralMomentsEtc *moments,
+    REAL8 fCutoff,
+    const InspiralMomentsTable *table
+    )
+{
+  REAL8 sums[NUM_MOMENTS];
+  size_t kMax;
+
+  /* Check inputs */
+  if (!moments || !table){
+    XLALPrintError("Moments or table is NULL\n");
+    XLAL_ERROR(XLAL_EFAULT);
+  }
+  if (fCutoff <= table->fLower){
+    XLALPrintError("fCutoff must be greater than fLower\n");
+    XLAL_ERROR(XLAL_EDOM);
+  }
+
+  kMax = floor((fCutoff / table->fLower - table->x0) / table->deltaX);
+  if ( kMax > table->kMax ) {
+    XLALPrintError("Table does not cover domain of integration\n");
+    XLAL_ERROR(XLAL_EDOM);
   }
 
-  /* Moments are done: Rescale deltaF and f0 back to their original values */
-  psd->deltaF *= fLower;
-  psd->f0 *= fLower;
+  SetInspiralMomentsCoefficients( moments );
+  memcpy( sums, table->sums + (kMax - table->kMin) * NUM_MOMENTS, sizeof(sums) );
+  if ( NormaliseInspiralMoments( moments, sums,
+        kMax < table->length ? table->psd + (kMax - table->kMin) : NULL,
+        table->x0 + kMax * table->deltaX, table->deltaX ) != XLAL_SUCCESS ){
+    XLAL_ERROR(XLAL_EFUNC);
+  }
 
   return XLAL_SUCCESS;
 }
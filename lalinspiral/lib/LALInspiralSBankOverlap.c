@@ -21,12 +21,19 @@
 #include <math.h>
 #include <complex.h>
 #include <lal/AVFactories.h>
+#include <lal/LALMalloc.h>
 #include <lal/ComplexFFT.h>
 #include <lal/XLALError.h>
 #include <lal/FrequencySeries.h>
 #include <lal/LALInspiralSBankOverlap.h>
 #include <sys/types.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp ignore
+#endif
+
 #define MAX_NUM_WS 32  /* maximum number of workspaces */
 #define CHECK_OOM(ptr, msg) if (!(ptr)) { XLALPrintError((msg)); XLAL_ERROR_NULL(XLAL_ENOMEM); }
 
@@ -353,3 +360,343 @@ REAL8 XLALInspiralSBankComputeMatchMaxSkyLocNoPhase(const COMPLEX8FrequencySerie
     /* Return match */
     return 4. * proposal->deltaF * sqrt(max);
 }
+
+
+/*
+ * Block versions of the match functions, for comparing one proposal with
+ * many templates, as when testing a proposal against the neighbourhood of
+ * a bank. The templates are divided between up to ncaches OpenMP threads,
+ * thread t using workspace_caches[t] (so each thread needs its own cache);
+ * without OpenMP only the first cache is used.
+ *
+ * If min_match is positive, the block stops as soon as any template is
+ * found with a match of at least min_match. Templates skipped as a result
+ * have their match set to -1. With more than one thread, the templates
+ * already in progress when the match is found are still completed, so
+ * more than one match may exceed min_match.
+ */
+
+int XLALInspiralSBankComputeMatchBlock(REAL8 *matches, const COMPLEX8FrequencySeries *proposal, const COMPLEX8FrequencySeries *const *tmplts, const size_t ntmplts, const REAL8 min_match, WS **workspace_caches, const size_t ncaches) {
+    int failed = 0, found = 0;
+    ssize_t k;
+
+    XLAL_CHECK(matches && proposal && (tmplts || !ntmplts), XLAL_EFAULT);
+    XLAL_CHECK(workspace_caches && ncaches > 0, XLAL_EINVAL, "need at least one workspace cache");
+
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(ncaches)
+    for (k = 0; k < (ssize_t) ntmplts; k++) {
+        int stop;
+        #pragma omp atomic read
+        stop = found;
+        if (stop) {
+            matches[k] = -1.;
+            continue;
+        }
+
+        WS *cache = workspace_caches[0];
+#ifdef _OPENMP
+        cache = workspace_caches[omp_get_thread_num()];
+#endif
+        matches[k] = XLALInspiralSBankComputeMatch(tmplts[k], proposal, cache);
+        if (XLAL_IS_REAL8_FAIL_NAN(matches[k])) {
+            #pragma omp atomic write
+            failed = 1;
+            #pragma omp atomic write
+            found = 1;
+        } else if (min_match > 0. && matches[k] >= min_match) {
+            #pragma omp atomic write
+            found = 1;
+        }
+    }
+
+    if (failed)
+        XLAL_ERROR(XLAL_EFUNC);
+
+    return XLAL_SUCCESS;
+}
+
+int XLALInspiralSBankComputeMatchMaxSkyLocBlock(REAL8 *matches, const COMPLEX8FrequencySeries *proposal, const COMPLEX8FrequencySeries *const *hp, const COMPLEX8FrequencySeries *const *hc, const REAL8 *hphccorr, const size_t ntmplts, const REAL8 min_match, WS **workspace_caches1, WS **workspace_caches2, const size_t ncaches) {
+    int failed = 0, found = 0;
+    ssize_t k;
+
+    XLAL_CHECK(matches && proposal && ((hp && hc && hphccorr) || !ntmplts), XLAL_EFAULT);
+    XLAL_CHECK(workspace_caches1 && workspace_caches2 && ncaches > 0, XLAL_EINVAL, "need at least one pair of workspace caches");
+
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(ncaches)
+    for (k = 0; k < (ssize_t) ntmplts; k++) {
+        int stop;
+        #pragma omp atomic read
+        stop = found;
+        if (stop) {
+            matches[k] = -1.;
+            continue;
+        }
+
+        size_t t = 0;
+#ifdef _OPENMP
+        t = omp_get_thread_num();
+#endif
+        matches[k] = XLALInspiralSBankComputeMatchMaxSkyLoc(hp[k], hc[k], hphccorr[k], proposal, workspace_caches1[t], workspace_caches2[t]);
+        if (XLAL_IS_REAL8_FAIL_NAN(matches[k])) {
+            #pragma omp atomic write
+            failed = 1;
+            #pragma omp atomic write
+            found = 1;
+        } else if (min_match > 0. && matches[k] >= min_match) {
+            #pragma omp atomic write
+            found = 1;
+        }
+    }
+
+    if (failed)
+        XLAL_ERROR(XLAL_EFUNC);
+
+    return XLAL_SUCCESS;
+}
+
+
+/*
+ * Neighbour index over a bank.
+ *
+ * Templates are stored by their chirp times (tau0, tau3), in which the
+ * metric of non-spinning inspirals is close to constant. The constant
+ * metric g, for example from LALInspiralComputeMetric(), is factorised as
+ * g = L L^T so that in the coordinates x = L^T (tau0, tau3) the mismatch
+ * is the squared Euclidean distance. The x plane is divided into square
+ * cells of side cell_size held in a hash table, so a query visits only the
+ * cells within reach of the proposal.
+ *
+ * A query returns the ids of the templates whose metric mismatch with the
+ * proposal is at most safety^2 (1 - min_match), nearest first. Since the
+ * metric is only an approximation to the match, safety should be somewhat
+ * greater than one; the candidates returned are then checked with
+ * XLALInspiralSBankComputeMatch() and friends.
+ */
+
+typedef struct tagSBankNeighbourCell {
+    INT4 i, j;
+    size_t n, size;
+    UINT4 *ids;
+    REAL8 *x; /* 2 coordinates per template */
+    struct tagSBankNeighbourCell *next;
+} SBankNeighbourCell;
+
+struct tagSBankNeighbourIndex {
+    REAL8 l00, l01, l11; /* x0 = l00 tau0 + l01 tau3, x1 = l11 tau3 */
+    REAL8 cell_size;
+    size_t ncells, nbuckets;
+    SBankNeighbourCell **buckets;
+};
+
+static size_t cell_hash(const INT4 i, const INT4 j, const size_t nbuckets) {
+    const UINT8 h = ((UINT8) (UINT4) i) * 0x9E3779B97F4A7C15ULL ^ ((UINT8) (UINT4) j) * 0xC2B2AE3D27D4EB4FULL;
+    return (size_t) (h ^ (h >> 29)) & (nbuckets - 1);
+}
+
+static SBankNeighbourCell *find_cell(const SBankNeighbourIndex *index, const INT4 i, const INT4 j) {
+    SBankNeighbourCell *cell = index->buckets[cell_hash(i, j, index->nbuckets)];
+    while (cell && (cell->i != i || cell->j != j))
+        cell = cell->next;
+    return cell;
+}
+
+static void to_index_coords(const SBankNeighbourIndex *index, const REAL8 tau0, const REAL8 tau3, REAL8 x[2]) {
+    x[0] = index->l00 * tau0 + index->l01 * tau3;
+    x[1] = index->l11 * tau3;
+}
+
+SBankNeighbourIndex *XLALCreateSBankNeighbourIndex(const REAL8 g00, const REAL8 g01, const REAL8 g11, const REAL8 cell_size) {
+    XLAL_CHECK_NULL(g00 > 0 && g00 * g11 - g01 * g01 > 0, XLAL_EDOM, "metric is not positive definite");
+    XLAL_CHECK_NULL(cell_size > 0, XLAL_EDOM, "cell size must be positive");
+
+    SBankNeighbourIndex *index = XLALCalloc(1, sizeof(*index));
+    XLAL_CHECK_NULL(index, XLAL_ENOMEM);
+    index->l00 = sqrt(g00);
+    index->l01 = g01 / index->l00;
+    index->l11 = sqrt(g11 - g01 * g01 / g00);
+    index->cell_size = cell_size;
+    index->nbuckets = 64;
+    index->buckets = XLALCalloc(index->nbuckets, sizeof(*index->buckets));
+    if (!index->buckets) {
+        XLALFree(index);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+    return index;
+}
+
+void XLALDestroySBankNeighbourIndex(SBankNeighbourIndex *index) {
+    size_t k;
+    if (!index)
+        return;
+    for (k = 0; k < index->nbuckets; k++) {
+        SBankNeighbourCell *cell = index->buckets[k];
+        while (cell) {
+            SBankNeighbourCell *next = cell->next;
+            XLALFree(cell->ids);
+            XLALFree(cell->x);
+            XLALFree(cell);
+            cell = next;
+        }
+    }
+    XLALFree(index->buckets);
+    XLALFree(index);
+}
+
+/* double the number of buckets once there are two cells per bucket */
+static int grow_buckets(SBankNeighbourIndex *index) {
+    size_t k, nbuckets = 2 * index->nbuckets;
+    SBankNeighbourCell **buckets = XLALCalloc(nbuckets, sizeof(*buckets));
+    XLAL_CHECK(buckets, XLAL_ENOMEM);
+    for (k = 0; k < index->nbuckets; k++) {
+        SBankNeighbourCell *cell = index->buckets[k];
+        while (cell) {
+            SBankNeighbourCell *next = cell->next;
+            size_t h = cell_hash(cell->i, cell->j, nbuckets);
+            cell->next = buckets[h];
+            buckets[h] = cell;
+            cell = next;
+        }
+    }
+    XLALFree(index->buckets);
+    index->buckets = buckets;
+    index->nbuckets = nbuckets;
+    return XLAL_SUCCESS;
+}
+
+int XLALSBankNeighbourIndexInsert(SBankNeighbourIndex *index, const REAL8 tau0, const REAL8 tau3, const UINT4 id) {
+    REAL8 x[2];
+    INT4 i, j;
+    SBankNeighbourCell *cell;
+
+    XLAL_CHECK(index, XLAL_EFAULT);
+    XLAL_CHECK(isfinite(tau0) && isfinite(tau3), XLAL_EDOM);
+
+    to_index_coords(index, tau0, tau3, x);
+    i = (INT4) floor(x[0] / index->cell_size);
+    j = (INT4) floor(x[1] / index->cell_size);
+
+    cell = find_cell(index, i, j);
+    if (!cell) {
+        if (index->ncells >= 2 * index->nbuckets)
+            XLAL_CHECK(grow_buckets(index) == XLAL_SUCCESS, XLAL_EFUNC);
+        cell = XLALCalloc(1, sizeof(*cell));
+        XLAL_CHECK(cell, XLAL_ENOMEM);
+        cell->i = i;
+        cell->j = j;
+        size_t h = cell_hash(i, j, index->nbuckets);
+        cell->next = index->buckets[h];
+        index->buckets[h] = cell;
+        index->ncells++;
+    }
+
+    if (cell->n == cell->size) {
+        size_t size = cell->size ? 2 * cell->size : 4;
+        UINT4 *ids = XLALRealloc(cell->ids, size * sizeof(*ids));
+        XLAL_CHECK(ids, XLAL_ENOMEM);
+        cell->ids = ids;
+        REAL8 *xs = XLALRealloc(cell->x, 2 * size * sizeof(*xs));
+        XLAL_CHECK(xs, XLAL_ENOMEM);
+        cell->x = xs;
+        cell->size = size;
+    }
+    cell->ids[cell->n] = id;
+    cell->x[2 * cell->n] = x[0];
+    cell->x[2 * cell->n + 1] = x[1];
+    cell->n++;
+
+    return XLAL_SUCCESS;
+}
+
+typedef struct {
+    REAL8 d2;
+    UINT4 id;
+} SBankNeighbour;
+
+typedef struct {
+    size_t n, size;
+    SBankNeighbour *neighbours;
+} SBankNeighbourList;
+
+static int compare_neighbours(const void *a, const void *b) {
+    const REAL8 da = ((const SBankNeighbour *) a)->d2;
+    const REAL8 db = ((const SBankNeighbour *) b)->d2;
+    return (da > db) - (da < db);
+}
+
+/* append the templates of a cell lying within sqrt(r2) of x */
+static int collect_neighbours(SBankNeighbourList *list, const SBankNeighbourCell *cell, const REAL8 x[2], const REAL8 r2) {
+    size_t m;
+    for (m = 0; m < cell->n; m++) {
+        const REAL8 d0 = cell->x[2 * m] - x[0];
+        const REAL8 d1 = cell->x[2 * m + 1] - x[1];
+        const REAL8 d2 = d0 * d0 + d1 * d1;
+        if (d2 > r2)
+            continue;
+        if (list->n == list->size) {
+            size_t size = list->size ? 2 * list->size : 16;
+            SBankNeighbour *neighbours = XLALRealloc(list->neighbours, size * sizeof(*neighbours));
+            XLAL_CHECK(neighbours, XLAL_ENOMEM);
+            list->neighbours = neighbours;
+            list->size = size;
+        }
+        list->neighbours[list->n].d2 = d2;
+        list->neighbours[list->n].id = cell->ids[m];
+        list->n++;
+    }
+    return XLAL_SUCCESS;
+}
+
+UINT4Vector *XLALSBankNeighbourIndexQuery(const SBankNeighbourIndex *index, const REAL8 tau0, const REAL8 tau3, const REAL8 min_match, const REAL8 safety) {
+    REAL8 x[2], radius, r2, imin, imax, jmin, jmax;
+    size_t k;
+    int status = XLAL_SUCCESS;
+    SBankNeighbourList list = {0, 0, NULL};
+    UINT4Vector *ids;
+
+    XLAL_CHECK_NULL(index, XLAL_EFAULT);
+    XLAL_CHECK_NULL(min_match <= 1 && safety > 0, XLAL_EDOM);
+
+    radius = safety * sqrt(1. - min_match);
+    r2 = radius * radius;
+    to_index_coords(index, tau0, tau3, x);
+    imin = floor((x[0] - radius) / index->cell_size);
+    imax = floor((x[0] + radius) / index->cell_size);
+    jmin = floor((x[1] - radius) / index->cell_size);
+    jmax = floor((x[1] + radius) / index->cell_size);
+
+    if ((imax - imin + 1) * (jmax - jmin + 1) > (REAL8) index->ncells) {
+        /* the search box covers more cells than are occupied: visit
+           every occupied cell instead */
+        for (k = 0; k < index->nbuckets && status == XLAL_SUCCESS; k++) {
+            const SBankNeighbourCell *cell;
+            for (cell = index->buckets[k]; cell && status == XLAL_SUCCESS; cell = cell->next)
+                status = collect_neighbours(&list, cell, x, r2);
+        }
+    } else {
+        INT4 i, j;
+        for (i = (INT4) imin; i <= (INT4) imax && status == XLAL_SUCCESS; i++) {
+            for (j = (INT4) jmin; j <= (INT4) jmax && status == XLAL_SUCCESS; j++) {
+                const SBankNeighbourCell *cell = find_cell(index, i, j);
+                if (cell)
+                    status = collect_neighbours(&list, cell, x, r2);
+            }
+        }
+    }
+    if (status != XLAL_SUCCESS) {
+        XLALFree(list.neighbours);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+
+    qsort(list.neighbours, list.n, sizeof(*list.neighbours), compare_neighbours);
+
+    ids = XLALCreateUINT4Vector(list.n);
+    if (!ids) {
+        XLALFree(list.neighbours);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+    for (k = 0; k < list.n; k++)
+        ids->data[k] = list.neighbours[k].id;
+    XLALFree(list.neighbours);
+
+    return ids;
+}
@@ -20,3 +20,17 @@ REAL8 XLALInspiralSBankComputeRealMatch(const COMPLEX8FrequencySeries *inj, cons
 REAL8 XLALInspiralSBankComputeMatchMaxSkyLoc(const COMPLEX8FrequencySeries *hp, const COMPLEX8FrequencySeries *hc, const REAL8 hphccorr, const COMPLEX8FrequencySeries *proposal, WS *workspace_cache1, WS *workspace_cache2);
 
 REAL8 XLALInspiralSBankComputeMatchMaxSkyLocNoPhase(const COMPLEX8FrequencySeries *hp, const COMPLEX8FrequencySeries *hc, const REAL8 hphccorr, const COMPLEX8FrequencySeries *proposal, WS *workspace_cache1, WS *workspace_cache2);
+
+/* neighbour index over the templates of a bank in metric-flattened (tau0, tau3) coordinates */
+typedef struct tagSBankNeighbourIndex SBankNeighbourIndex;
+
+SBankNeighbourIndex *XLALCreateSBankNeighbourIndex(const REAL8 g00, const REAL8 g01, const REAL8 g11, const REAL8 cell_size);
+void XLALDestroySBankNeighbourIndex(SBankNeighbourIndex *index);
+int XLALSBankNeighbourIndexInsert(SBankNeighbourIndex *index, const REAL8 tau0, const REAL8 tau3, const UINT4 id);
+UINT4Vector *XLALSBankNeighbourIndexQuery(const SBankNeighbourIndex *index, const REAL8 tau0, const REAL8 tau3, const REAL8 min_match, const REAL8 safety);
+
+#ifndef SWIG /* exclude from SWIG interface */
+int XLALInspiralSBankComputeMatchBlock(REAL8 *matches, const COMPLEX8FrequencySeries *proposal, const COMPLEX8FrequencySeries *const *tmplts, const size_t ntmplts, const REAL8 min_match, WS **workspace_caches, const size_t ncaches);
+
+int XLALInspiralSBankComputeMatchMaxSkyLocBlock(REAL8 *matches, const COMPLEX8FrequencySeries *proposal, const COMPLEX8FrequencySeries *const *hp, const COMPLEX8FrequencySeries *const *hc, const REAL8 *hphccorr, const size_t ntmplts, const REAL8 min_match, WS **workspace_caches1, WS **workspace_caches2, const size_t ncaches);
+#endif /* SWIG */
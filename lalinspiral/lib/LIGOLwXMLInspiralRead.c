@@ -18,10 +18,12 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <metaio.h>
 
 #include <lal/LIGOMetadataTables.h>
 #include <lal/LIGOLwXMLInspiralRead.h>
+#include <lal/XLALError.h>
 
 
 /*
@@ -52,112 +54,182 @@ MetaTableDirectory;
 
 
 
+/* columns of the sngl_inspiral table, in the order of the switch in
+ * SnglInspiralTableParseRow() */
+static const CHAR *snglInspiralColumns[] =
+{
+  "ifo", "search", "channel", "end_time", "end_time_ns", "end_time_gmst",
+  "impulse_time", "impulse_time_ns", "template_duration", "event_duration",
+  "amplitude", "eff_distance", "coa_phase", "mass1", "mass2", "mchirp",
+  "mtotal", "eta", "tau0", "tau2", "tau3", "tau4", "tau5", "ttotal", "psi0",
+  "psi3", "alpha", "alpha1", "alpha2", "alpha3", "alpha4", "alpha5",
+  "alpha6", "beta", "f_final", "snr", "chisq", "chisq_dof", "bank_chisq",
+  "bank_chisq_dof", "cont_chisq", "cont_chisq_dof", "sigmasq",
+  "rsqveto_duration", "event_id", "Gamma0", "Gamma1", "Gamma2", "Gamma3",
+  "Gamma4", "Gamma5", "Gamma6", "Gamma7", "Gamma8", "Gamma9", "kappa",
+  "chi", "spin1x", "spin1y", "spin1z", "spin2x", "spin2y", "spin2z",
+  "process_id"
+};
+
+#define NUM_SNGL_INSPIRAL_COLUMNS \
+  ((int) (sizeof(snglInspiralColumns) / sizeof(*snglInspiralColumns)))
+
+/* finds the column positions of an open sngl_inspiral table; the
+ * bank_chisq_dof and Gamma columns may be missing */
+static int
+SnglInspiralTableFindColumns (
+    MetaioParseEnv  env,
+    int            *pos
+    )
+{
+  int i;
+  for ( i = 0; i < NUM_SNGL_INSPIRAL_COLUMNS; ++i )
+  {
+    if ( (pos[i] = MetaioFindColumn( env, snglInspiralColumns[i] )) < 0
+        && i != 39 )
+    {
+      fprintf( stderr, "unable to find column %s\n", snglInspiralColumns[i] );
+
+      if ( strstr(snglInspiralColumns[i], "Gamma") )
+      {
+        fprintf( stderr,
+            "The %s column is not populated, continuing anyway\n",
+            snglInspiralColumns[i] );
+      }
+      else
+      {
+        return -1;
+      }
+    }
+  }
+  return 0;
+}
+
+/* parses the current row of a sngl_inspiral table into thisEvent */
+static void
+SnglInspiralTableParseRow (
+    MetaioParseEnv      env,
+    const int          *pos,
+    SnglInspiralTable  *thisEvent
+    )
+{
+  int j;
+  for ( j = 0; j < NUM_SNGL_INSPIRAL_COLUMNS; ++j )
+  {
+    REAL4 r4colData;
+    REAL8 r8colData;
+    INT4  i4colData;
+    INT8  i8colData;
+    const CHAR *lscolData;
+
+    if ( pos[j] < 0 ) continue;
+
+    r4colData = env->ligo_lw.table.elt[pos[j]].data.real_4;
+    r8colData = env->ligo_lw.table.elt[pos[j]].data.real_8;
+    i4colData = env->ligo_lw.table.elt[pos[j]].data.int_4s;
+    i8colData = env->ligo_lw.table.elt[pos[j]].data.int_8s;
+    lscolData = env->ligo_lw.table.elt[pos[j]].data.lstring.data;
+
+    switch ( j )
+    {
+      case 0:
+        snprintf( thisEvent->ifo, LIGOMETA_IFO_MAX * sizeof(CHAR),
+            "%s", lscolData );
+        break;
+      case 1:
+        snprintf( thisEvent->search, LIGOMETA_SEARCH_MAX * sizeof(CHAR),
+            "%s", lscolData );
+        break;
+      case 2:
+        snprintf( thisEvent->channel, LIGOMETA_CHANNEL_MAX * sizeof(CHAR),
+            "%s", lscolData );
+        break;
+      case 3: thisEvent->end.gpsSeconds = i4colData; break;
+      case 4: thisEvent->end.gpsNanoSeconds = i4colData; break;
+      case 5: thisEvent->end_time_gmst = r8colData; break;
+      case 6: thisEvent->impulse_time.gpsSeconds = i4colData; break;
+      case 7: thisEvent->impulse_time.gpsNanoSeconds = i4colData; break;
+      case 8: thisEvent->template_duration = r8colData; break;
+      case 9: thisEvent->event_duration = r8colData; break;
+      case 10: thisEvent->amplitude = r4colData; break;
+      case 11: thisEvent->eff_distance = r4colData; break;
+      case 12: thisEvent->coa_phase = r4colData; break;
+      case 13: thisEvent->mass1 = r4colData; break;
+      case 14: thisEvent->mass2 = r4colData; break;
+      case 15: thisEvent->mchirp = r4colData; break;
+      case 16: thisEvent->mtotal = r4colData; break;
+      case 17: thisEvent->eta = r4colData; break;
+      case 18: thisEvent->tau0 = r4colData; break;
+      case 19: thisEvent->tau2 = r4colData; break;
+      case 20: thisEvent->tau3 = r4colData; break;
+      case 21: thisEvent->tau4 = r4colData; break;
+      case 22: thisEvent->tau5 = r4colData; break;
+      case 23: thisEvent->ttotal = r4colData; break;
+      case 24: thisEvent->psi0 = r4colData; break;
+      case 25: thisEvent->psi3 = r4colData; break;
+      case 26: thisEvent->alpha = r4colData; break;
+      case 27: thisEvent->alpha1 = r4colData; break;
+      case 28: thisEvent->alpha2 = r4colData; break;
+      case 29: thisEvent->alpha3 = r4colData; break;
+      case 30: thisEvent->alpha4 = r4colData; break;
+      case 31: thisEvent->alpha5 = r4colData; break;
+      case 32: thisEvent->alpha6 = r4colData; break;
+      case 33: thisEvent->beta = r4colData; break;
+      case 34: thisEvent->f_final = r4colData; break;
+      case 35: thisEvent->snr = r4colData; break;
+      case 36: thisEvent->chisq = r4colData; break;
+      case 37: thisEvent->chisq_dof = i4colData; break;
+      case 38: thisEvent->bank_chisq = r4colData; break;
+      case 39: thisEvent->bank_chisq_dof = i4colData; break;
+      case 40: thisEvent->cont_chisq = r4colData; break;
+      case 41: thisEvent->cont_chisq_dof = i4colData; break;
+      case 42: thisEvent->sigmasq = r8colData; break;
+      case 43: thisEvent->rsqveto_duration = r4colData; break;
+      case 44: thisEvent->event_id = i8colData; break;
+      case 45: case 46: case 47: case 48: case 49:
+      case 50: case 51: case 52: case 53: case 54:
+        thisEvent->Gamma[j - 45] = r4colData;
+        break;
+      case 55: thisEvent->kappa = r4colData; break;
+      case 56: thisEvent->chi = r4colData; break;
+      case 57: thisEvent->spin1x = r4colData; break;
+      case 58: thisEvent->spin1y = r4colData; break;
+      case 59: thisEvent->spin1z = r4colData; break;
+      case 60: thisEvent->spin2x = r4colData; break;
+      case 61: thisEvent->spin2y = r4colData; break;
+      case 62: thisEvent->spin2z = r4colData; break;
+      case 63: thisEvent->process_id = i8colData; break;
+    }
+  }
+}
+
+
 int
-LALSnglInspiralTableFromLIGOLw (
-    SnglInspiralTable **eventHead,
+XLALSnglInspiralTableFromLIGOLwForEach (
     const CHAR         *fileName,
-    INT4                startEvent,
-    INT4                stopEvent
+    int               (*func)(SnglInspiralTable *row, void *data),
+    void               *data
     )
-
 {
-  int                                   i, j, nrows;
   int                                   mioStatus;
-  SnglInspiralTable                    *thisEvent = NULL;
+  int                                   nrows = 0;
+  int                                   pos[NUM_SNGL_INSPIRAL_COLUMNS];
   struct MetaioParseEnvironment         parseEnv;
   const  MetaioParseEnv                 env = &parseEnv;
-  MetaTableDirectory tableDir[] =
-  {
-    {"ifo",                     -1, 0},
-    {"search",                  -1, 1},
-    {"channel",                 -1, 2},
-    {"end_time",                -1, 3},
-    {"end_time_ns",             -1, 4},
-    {"end_time_gmst",           -1, 5},
-    {"impulse_time",            -1, 6},
-    {"impulse_time_ns",         -1, 7},
-    {"template_duration",       -1, 8},
-    {"event_duration",          -1, 9},
-    {"amplitude",               -1, 10},
-    {"eff_distance",            -1, 11},
-    {"coa_phase",               -1, 12},
-    {"mass1",                   -1, 13},
-    {"mass2",                   -1, 14},
-    {"mchirp",                  -1, 15},
-    {"mtotal",                  -1, 16},
-    {"eta",                     -1, 17},
-    {"tau0",                    -1, 18},
-    {"tau2",                    -1, 19},
-    {"tau3",                    -1, 20},
-    {"tau4",                    -1, 21},
-    {"tau5",                    -1, 22},
-    {"ttotal",                  -1, 23},
-    {"psi0",                    -1, 24},
-    {"psi3",                    -1, 25},
-    {"alpha",                   -1, 26},
-    {"alpha1",                  -1, 27},
-    {"alpha2",                  -1, 28},
-    {"alpha3",                  -1, 29},
-    {"alpha4",                  -1, 30},
-    {"alpha5",                  -1, 31},
-    {"alpha6",                  -1, 32},
-    {"beta",                    -1, 33},
-    {"f_final",                 -1, 34},
-    {"snr",                     -1, 35},
-    {"chisq",                   -1, 36},
-    {"chisq_dof",               -1, 37},
-    {"bank_chisq",              -1, 38},
-    {"bank_chisq_dof",          -1, 39},
-    {"cont_chisq",              -1, 40},
-    {"cont_chisq_dof",          -1, 41},
-    {"sigmasq",                 -1, 42},
-    {"rsqveto_duration",        -1, 43},
-    {"event_id",                -1, 44},
-    {"Gamma0",                  -1, 45},
-    {"Gamma1",                  -1, 46},
-    {"Gamma2",                  -1, 47},
-    {"Gamma3",                  -1, 48},
-    {"Gamma4",                  -1, 49},
-    {"Gamma5",                  -1, 50},
-    {"Gamma6",                  -1, 51},
-    {"Gamma7",                  -1, 52},
-    {"Gamma8",                  -1, 53},
-    {"Gamma9",                  -1, 54},
-    {"kappa",                   -1, 55},
-    {"chi",                     -1, 56},
-    {"spin1x",                  -1, 57},
-    {"spin1y",                  -1, 58},
-    {"spin1z",                  -1, 59},
-    {"spin2x",                  -1, 60},
-    {"spin2y",                  -1, 61},
-    {"spin2z",                  -1, 62},
-    {"process_id",              -1, 63},
-    {NULL,                       0, 0}
-  };
 
-  /* check that the bank handle and pointer are vaid */
-  if ( ! eventHead )
-  {
-    fprintf( stderr, "null pointer passed as handle to event list" );
-    return -1;
-  }
-  if ( *eventHead )
-  {
-    fprintf( stderr, "non-null pointer passed as pointer to event list" );
-    return -1;
-  }
+  if ( ! fileName || ! func )
+    XLAL_ERROR( XLAL_EFAULT );
 
-  /* open the sngl_inspiral table template bank file */
+  /* open the sngl_inspiral table file */
   mioStatus = MetaioOpenFile( env, fileName );
   if ( mioStatus )
   {
     MetaioAbort(env);
     MetaioClose(env);
-    fprintf( stderr, "unable to open file %s\n", fileName );
-    return -1;
+    XLAL_ERROR( XLAL_EIO, "unable to open file %s", fileName );
   }
 
-  /* open the sngl_inspiral table template bank file */
+  /* open the sngl_inspiral table */
   mioStatus = MetaioOpenTableOnly( env, "sngl_inspiral" );
   if ( mioStatus )
   {
@@ -167,355 +239,133 @@ LALSnglInspiralTableFromLIGOLw (
     return 0;
   }
 
-  /* figure out the column positions of the template parameters */
-  for ( i = 0; tableDir[i].name; ++i )
+  /* figure out the column positions, once for the whole table */
+  if ( SnglInspiralTableFindColumns( env, pos ) < 0 )
   {
-    if ( (tableDir[i].pos = MetaioFindColumn( env, tableDir[i].name )) < 0
-        &&  tableDir[i].idx != 39 )
-    {
-      fprintf( stderr, "unable to find column %s\n", tableDir[i].name );
-
-      if ( strstr(tableDir[i].name, "Gamma") )
-      {
-        fprintf( stderr,
-            "The %s column is not populated, continuing anyway\n", tableDir[i].name);
-      }
-      else
-      {
-        MetaioClose(env);
-        return -1;
-      }
-    }
+    MetaioClose(env);
+    XLAL_ERROR( XLAL_EDATA, "missing columns in sngl_inspiral table" );
   }
 
-  /* loop over the rows in the file */
-  i = nrows = 0;
+  /* loop over the rows in the file, handing each to the caller */
   while ( (mioStatus = MetaioGetRow(env)) == 1 )
   {
-    /* count the rows in the file */
-    i++;
+    SnglInspiralTable thisEvent;
+    int status;
 
-    /* stop parsing if we have reach the last row requested */
-    if ( stopEvent > -1 && i > stopEvent )
+    memset( &thisEvent, 0, sizeof(thisEvent) );
+    SnglInspiralTableParseRow( env, pos, &thisEvent );
+    ++nrows;
+
+    status = func( &thisEvent, data );
+    if ( status < 0 )
     {
-      break;
+      MetaioAbort(env);
+      MetaioClose(env);
+      XLAL_ERROR( XLAL_EFUNC, "callback failed on row %d", nrows );
     }
-
-    /* if we have reached the first requested row, parse the row */
-    if ( i > startEvent )
+    if ( status > 0 )
     {
-      /* allocate memory for the template we are about to read in */
-      if ( ! *eventHead )
-      {
-        thisEvent = *eventHead = (SnglInspiralTable *)
-          LALCalloc( 1, sizeof(SnglInspiralTable) );
-      }
-      else
-      {
-        thisEvent = thisEvent->next = (SnglInspiralTable *)
-          LALCalloc( 1, sizeof(SnglInspiralTable) );
-      }
-      if ( ! thisEvent )
-      {
-        fprintf( stderr, "could not allocate inspiral template\n" );
-        CLOBBER_EVENTS;
-        MetaioClose( env );
-        return -1;
-      }
+      /* caller has had enough */
+      MetaioAbort(env);
+      MetaioClose(env);
+      return nrows;
+    }
+  }
 
-      /* parse the contents of the row into the InspiralTemplate structure */
-      for ( j = 0; tableDir[j].name; ++j )
-      {
-        REAL4 r4colData = env->ligo_lw.table.elt[tableDir[j].pos].data.real_4;
-        REAL8 r8colData = env->ligo_lw.table.elt[tableDir[j].pos].data.real_8;
-        INT4  i4colData = env->ligo_lw.table.elt[tableDir[j].pos].data.int_4s;
-        INT8  i8colData = env->ligo_lw.table.elt[tableDir[j].pos].data.int_8s;
+  if ( mioStatus == -1 )
+  {
+    MetaioClose(env);
+    XLAL_ERROR( XLAL_EIO, "error parsing after row %d", nrows );
+  }
 
-        if ( tableDir[j].pos < 0 ) continue;
+  MetaioClose(env);
+  return nrows;
+}
 
-        if ( tableDir[j].idx == 0 )
-        {
-          snprintf( thisEvent->ifo, LIGOMETA_IFO_MAX * sizeof(CHAR),
-              "%s", env->ligo_lw.table.elt[tableDir[j].pos].data.lstring.data );
-        }
-        else if ( tableDir[j].idx == 1 )
-        {
-          snprintf( thisEvent->search, LIGOMETA_SEARCH_MAX * sizeof(CHAR),
-              "%s", env->ligo_lw.table.elt[tableDir[j].pos].data.lstring.data );
-        }
-        else if ( tableDir[j].idx == 2 )
-        {
-          snprintf( thisEvent->channel, LIGOMETA_CHANNEL_MAX * sizeof(CHAR),
-              "%s", env->ligo_lw.table.elt[tableDir[j].pos].data.lstring.data );
-        }
-        else if ( tableDir[j].idx == 3 )
-        {
-          thisEvent->end.gpsSeconds = i4colData;
-        }
-        else if ( tableDir[j].idx == 4 )
-        {
-          thisEvent->end.gpsNanoSeconds = i4colData;
-        }
-        else if ( tableDir[j].idx == 5 )
-        {
-          thisEvent->end_time_gmst = r8colData;
-        }
-        else if ( tableDir[j].idx == 6 )
-        {
-          thisEvent->impulse_time.gpsSeconds = i4colData;
-        }
-        else if ( tableDir[j].idx == 7 )
-        {
-          thisEvent->impulse_time.gpsNanoSeconds = i4colData;
-        }
-        else if ( tableDir[j].idx == 8 )
-        {
-          thisEvent->template_duration = r8colData;
-        }
-        else if ( tableDir[j].idx == 9 )
-        {
-          thisEvent->event_duration = r8colData;
-        }
-        else if ( tableDir[j].idx == 10 )
-        {
-          thisEvent->amplitude = r4colData;
-        }
-        else if ( tableDir[j].idx == 11 )
-        {
-          thisEvent->eff_distance = r4colData;
-        }
-        else if ( tableDir[j].idx == 12 )
-        {
-          thisEvent->coa_phase = r4colData;
-        }
-        else if ( tableDir[j].idx == 13 )
-        {
-          thisEvent->mass1 = r4colData;
-        }
-        else if ( tableDir[j].idx == 14 )
-        {
-          thisEvent->mass2 = r4colData;
-        }
-        else if ( tableDir[j].idx == 15 )
-        {
-          thisEvent->mchirp = r4colData;
-        }
-        else if ( tableDir[j].idx == 16 )
-        {
-          thisEvent->mtotal = r4colData;
-        }
-        else if ( tableDir[j].idx == 17 )
-        {
-          thisEvent->eta = r4colData;
-        }
-        else if ( tableDir[j].idx == 18 )
-        {
-          thisEvent->tau0 = r4colData;
-        }
-        else if ( tableDir[j].idx == 19 )
-        {
-          thisEvent->tau2 = r4colData;
-        }
-        else if ( tableDir[j].idx == 20 )
-        {
-          thisEvent->tau3 = r4colData;
-        }
-        else if ( tableDir[j].idx == 21 )
-        {
-          thisEvent->tau4 = r4colData;
-        }
-        else if ( tableDir[j].idx == 22 )
-        {
-          thisEvent->tau5 = r4colData;
-        }
-        else if ( tableDir[j].idx == 23 )
-        {
-          thisEvent->ttotal = r4colData;
-        }
-        else if ( tableDir[j].idx == 24 )
-        {
-          thisEvent->psi0 = r4colData;
-        }
-        else if ( tableDir[j].idx == 25 )
-        {
-          thisEvent->psi3 = r4colData;
-        }
-        else if ( tableDir[j].idx == 26 )
-        {
-          thisEvent->alpha = r4colData;
-        }
-        else if ( tableDir[j].idx == 27 )
-        {
-          thisEvent->alpha1 = r4colData;
-        }
-        else if ( tableDir[j].idx == 28 )
-        {
-          thisEvent->alpha2 = r4colData;
-        }
-        else if ( tableDir[j].idx == 29 )
-        {
-          thisEvent->alpha3 = r4colData;
-        }
-        else if ( tableDir[j].idx == 30 )
-        {
-          thisEvent->alpha4 = r4colData;
-        }
-        else if ( tableDir[j].idx == 31 )
-        {
-          thisEvent->alpha5 = r4colData;
-        }
-        else if ( tableDir[j].idx == 32 )
-        {
-          thisEvent->alpha6 = r4colData;
-        }
-        else if ( tableDir[j].idx == 33 )
-        {
-          thisEvent->beta = r4colData;
-        }
-        else if ( tableDir[j].idx == 34 )
-        {
-          thisEvent->f_final = r4colData;
-        }
-        else if ( tableDir[j].idx == 35 )
-        {
-          thisEvent->snr = r4colData;
-        }
-        else if ( tableDir[j].idx == 36 )
-        {
-          thisEvent->chisq = r4colData;
-        }
-        else if ( tableDir[j].idx == 37 )
-        {
-          thisEvent->chisq_dof = i4colData;
-        }
-        else if ( tableDir[j].idx == 38 )
-        {
-          thisEvent->bank_chisq = r4colData;
-        }
-        else if ( tableDir[j].idx == 39 )
-        {
-          thisEvent->bank_chisq_dof = i4colData;
-        }
-        else if ( tableDir[j].idx == 40 )
-        {
-          thisEvent->cont_chisq = r4colData;
-        }
-        else if ( tableDir[j].idx == 41 )
-        {
-          thisEvent->cont_chisq_dof = i4colData;
-        }
-        else if ( tableDir[j].idx == 42 )
-        {
-          thisEvent->sigmasq = r8colData;
-        }
-        else if ( tableDir[j].idx == 43 )
-        {
-          thisEvent->rsqveto_duration = r4colData;
-        }
-        else if ( tableDir[j].idx == 44 )
-        {
-          thisEvent->event_id = i8colData;
-        }
-        else if ( tableDir[j].idx == 45 )
-        {
-          thisEvent->Gamma[0] = r4colData;
-        }
-        else if ( tableDir[j].idx == 46 )
-        {
-          thisEvent->Gamma[1] = r4colData;
-        }
-        else if ( tableDir[j].idx == 47 )
-        {
-          thisEvent->Gamma[2] = r4colData;
-        }
-        else if ( tableDir[j].idx == 48 )
-        {
-          thisEvent->Gamma[3] = r4colData;
-        }
-        else if ( tableDir[j].idx == 49 )
-        {
-          thisEvent->Gamma[4] = r4colData;
-        }
-        else if ( tableDir[j].idx == 50 )
-        {
-          thisEvent->Gamma[5] = r4colData;
-        }
-        else if ( tableDir[j].idx == 51 )
-        {
-          thisEvent->Gamma[6] = r4colData;
-        }
-        else if ( tableDir[j].idx == 52 )
-        {
-          thisEvent->Gamma[7] = r4colData;
-        }
-        else if ( tableDir[j].idx == 53 )
-        {
-          thisEvent->Gamma[8] = r4colData;
-        }
-        else if ( tableDir[j].idx == 54 )
-        {
-          thisEvent->Gamma[9] = r4colData;
-        }
-        else if ( tableDir[j].idx == 55 )
-        {
-          thisEvent->kappa = r4colData;
-        }
-        else if ( tableDir[j].idx == 56 )
-        {
-          thisEvent->chi = r4colData;
-        }
-        else if ( tableDir[j].idx == 57 )
-        {
-          thisEvent->spin1x = r4colData;
-        }
-        else if ( tableDir[j].idx == 58 )
-        {
-          thisEvent->spin1y = r4colData;
-        }
-        else if ( tableDir[j].idx == 59 )
-        {
-          thisEvent->spin1z = r4colData;
-        }
-        else if ( tableDir[j].idx == 60 )
-        {
-          thisEvent->spin2x = r4colData;
-        }
-        else if ( tableDir[j].idx == 61 )
-        {
-          thisEvent->spin2y = r4colData;
-        }
-        else if ( tableDir[j].idx == 62 )
-        {
-          thisEvent->spin2z = r4colData;
-        }
-        else if ( tableDir[j].idx == 63 )
-        {
-          thisEvent->process_id = i8colData;
-        }
-        else
-        {
-          CLOBBER_EVENTS;
-          fprintf( stderr, "unknown column while parsing sngl_inspiral\n" );
-          return -1;
-        }
-      }
 
-      /* count the number of template parsed */
-      nrows++;
+/* callback used by LALSnglInspiralTableFromLIGOLw() to build a list */
+struct SnglInspiralTableListData
+{
+  SnglInspiralTable **next;
+  INT4                startEvent;
+  INT4                stopEvent;
+  INT4                row;
+  INT4                nrows;
+};
+
+static int
+SnglInspiralTableAppendRow (
+    SnglInspiralTable  *row,
+    void               *data
+    )
+{
+  struct SnglInspiralTableListData *list = data;
+
+  /* count the rows in the file */
+  ++list->row;
+
+  /* stop parsing if we have reach the last row requested */
+  if ( list->stopEvent > -1 && list->row > list->stopEvent )
+    return 1;
+
+  /* if we have reached the first requested row, keep the row */
+  if ( list->row > list->startEvent )
+  {
+    SnglInspiralTable *thisEvent = LALCalloc( 1, sizeof(*thisEvent) );
+    if ( ! thisEvent )
+    {
+      fprintf( stderr, "could not allocate inspiral template\n" );
+      return -1;
     }
+    *thisEvent = *row;
+    *list->next = thisEvent;
+    list->next = &thisEvent->next;
+    ++list->nrows;
   }
+  return 0;
+}
 
-  if ( mioStatus == -1 )
+
+int
+LALSnglInspiralTableFromLIGOLw (
+    SnglInspiralTable **eventHead,
+    const CHAR         *fileName,
+    INT4                startEvent,
+    INT4                stopEvent
+    )
+
+{
+  SnglInspiralTable                    *thisEvent = NULL;
+  struct SnglInspiralTableListData      list;
+
+  /* check that the bank handle and pointer are vaid */
+  if ( ! eventHead )
   {
-    fprintf( stderr, "error parsing after row %d\n", i );
+    fprintf( stderr, "null pointer passed as handle to event list" );
+    return -1;
+  }
+  if ( *eventHead )
+  {
+    fprintf( stderr, "non-null pointer passed as pointer to event list" );
+    return -1;
+  }
+
+  list.next = eventHead;
+  list.startEvent = startEvent;
+  list.stopEvent = stopEvent;
+  list.row = 0;
+  list.nrows = 0;
+
+  if ( XLALSnglInspiralTableFromLIGOLwForEach( fileName,
+        SnglInspiralTableAppendRow, &list ) < 0 )
+  {
+    XLALClearErrno();
     CLOBBER_EVENTS;
-    MetaioClose( env );
     return -1;
   }
 
   /* we have sucesfully parsed temples */
-  MetaioClose( env );
-  return nrows;
+  return list.nrows;
 }
 
 #undef CLOBBER_EVENTS
@@ -40,6 +40,23 @@ LALSnglInspiralTableFromLIGOLw (
     INT4                stopEvent
     );
 
+/*
+ * Reads the sngl_inspiral table of fileName one row at a time, passing
+ * each row to func without building a list; column positions are looked
+ * up once for the table.  The row is only valid for the duration of the
+ * call.  func returns 0 to continue, > 0 to stop reading, and < 0 on
+ * failure.  Returns the number of rows passed to func, 0 if the file has
+ * no sngl_inspiral table, or < 0 on error.
+ */
+#ifndef SWIG /* exclude from SWIG interface */
+int
+XLALSnglInspiralTableFromLIGOLwForEach (
+    const CHAR         *fileName,
+    int               (*func)(SnglInspiralTable *row, void *data),
+    void               *data
+    );
+#endif /* SWIG */
+
 int
 InspiralTmpltBankFromLIGOLw (
     InspiralTemplate   **bankHead,
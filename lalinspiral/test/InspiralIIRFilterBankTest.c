@@ -0,0 +1,133 @@
+/**
+ * \file
+ * \ingroup LALInspiral_h
+ *
+ * \brief Tests the streaming IIR filter bank against a direct evaluation.
+ *
+ * A random set of first order filters is run over a pseudo-random data
+ * stream that is fed to XLALInspiralIIRFilterBankApply() in chunks of
+ * varying length.  The output must agree with evaluating each filter
+ * recursion separately over the whole stream, and the response to an
+ * impulse must agree with XLALInspiralIIRSetResponse().
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <lal/LALStdlib.h>
+#include <lal/AVFactories.h>
+#include <lal/LALInspiral.h>
+
+#define NFILTERS 203
+#define MAXDELAY 5000
+#define NSAMPLES 20000
+#define TOLERANCE 1e-10
+
+static REAL8 uniform(void) {
+    return rand() / (RAND_MAX + 1.);
+}
+
+/* feed input to the bank in chunks of up to maxchunk samples */
+static int apply_in_chunks(InspiralIIRFilterBank *bank, COMPLEX16Vector *output, const REAL8Vector *input, UINT4 maxchunk) {
+    UINT4 offset = 0;
+    while (offset < input->length) {
+        UINT4 n = 1 + (UINT4) (uniform() * maxchunk);
+        REAL8Vector in;
+        COMPLEX16Vector out;
+        if (n > input->length - offset)
+            n = input->length - offset;
+        in.length = out.length = n;
+        in.data = input->data + offset;
+        out.data = output->data + offset;
+        if (XLALInspiralIIRFilterBankApply(bank, &out, &in) != XLAL_SUCCESS)
+            return 1;
+        offset += n;
+    }
+    return 0;
+}
+
+int main(void) {
+    COMPLEX16Vector *a1, *b0, *output, *expected, *response;
+    INT4Vector *delay;
+    REAL8Vector *input;
+    InspiralIIRFilterBank *bank;
+    REAL8 maxerr = 0., norm = 0.;
+    UINT4 j, k;
+    int failed = 0;
+
+    srand(314159);
+    a1 = XLALCreateCOMPLEX16Vector(NFILTERS);
+    b0 = XLALCreateCOMPLEX16Vector(NFILTERS);
+    delay = XLALCreateINT4Vector(NFILTERS);
+    input = XLALCreateREAL8Vector(NSAMPLES);
+    output = XLALCreateCOMPLEX16Vector(NSAMPLES);
+    expected = XLALCreateCOMPLEX16Vector(NSAMPLES);
+    response = XLALCreateCOMPLEX16Vector(NSAMPLES);
+    if (!a1 || !b0 || !delay || !input || !output || !expected || !response)
+        return 1;
+
+    for (k = 0; k < NFILTERS; k++) {
+        a1->data[k] = cpolar(1. - 0.05 * uniform(), LAL_TWOPI * uniform());
+        b0->data[k] = cpolar(uniform(), LAL_TWOPI * uniform());
+        delay->data[k] = (INT4) (uniform() * MAXDELAY);
+    }
+    for (j = 0; j < NSAMPLES; j++)
+        input->data[j] = 2. * uniform() - 1.;
+
+    /* direct evaluation of y_k[t] = a1_k y_k[t-1] + b0_k x[t - delay_k] */
+    for (j = 0; j < NSAMPLES; j++)
+        expected->data[j] = 0.;
+    for (k = 0; k < NFILTERS; k++) {
+        COMPLEX16 y = 0.;
+        for (j = (UINT4) delay->data[k]; j < NSAMPLES; j++) {
+            y = a1->data[k] * y + b0->data[k] * input->data[j - delay->data[k]];
+            expected->data[j] += y;
+        }
+    }
+    for (j = 0; j < NSAMPLES; j++)
+        if (cabs(expected->data[j]) > norm)
+            norm = cabs(expected->data[j]);
+
+    bank = XLALCreateInspiralIIRFilterBank(a1, b0, delay);
+    if (!bank)
+        return 1;
+    if (apply_in_chunks(bank, output, input, 3 * MAXDELAY))
+        return 1;
+    for (j = 0; j < NSAMPLES; j++)
+        if (cabs(output->data[j] - expected->data[j]) > maxerr)
+            maxerr = cabs(output->data[j] - expected->data[j]);
+    fprintf(stdout, "Streaming output: maximum relative error %e\n", maxerr / norm);
+    if (maxerr > TOLERANCE * norm)
+        failed = 1;
+
+    /* impulse response after a reset, fed one short chunk at a time */
+    XLALInspiralIIRFilterBankReset(bank);
+    for (j = 0; j < NSAMPLES; j++)
+        input->data[j] = j == 0 ? 1. : 0.;
+    if (apply_in_chunks(bank, output, input, 64))
+        return 1;
+    XLALInspiralIIRSetResponse(a1, b0, delay, response);
+    norm = maxerr = 0.;
+    for (j = 0; j < NSAMPLES; j++) {
+        if (cabs(response->data[j]) > norm)
+            norm = cabs(response->data[j]);
+        if (cabs(output->data[j] - response->data[j]) > maxerr)
+            maxerr = cabs(output->data[j] - response->data[j]);
+    }
+    fprintf(stdout, "Impulse response: maximum relative error %e\n", maxerr / norm);
+    if (maxerr > TOLERANCE * norm)
+        failed = 1;
+
+    XLALDestroyInspiralIIRFilterBank(bank);
+    XLALDestroyCOMPLEX16Vector(a1);
+    XLALDestroyCOMPLEX16Vector(b0);
+    XLALDestroyINT4Vector(delay);
+    XLALDestroyREAL8Vector(input);
+    XLALDestroyCOMPLEX16Vector(output);
+    XLALDestroyCOMPLEX16Vector(expected);
+    XLALDestroyCOMPLEX16Vector(response);
+
+    LALCheckMemoryLeaks();
+    return failed;
+}
@@ -0,0 +1,242 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with with program; see the file COPYING. If not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301  USA
+ */
+
+/**
+ * \file
+ *
+ * \brief Tests the row-callback sngl_inspiral reader against the list reader.
+ *
+ * A small sngl_inspiral table is written with the lalmetaio writer. The rows
+ * passed to the callback of XLALSnglInspiralTableFromLIGOLwForEach() must be
+ * the rows of the list returned by LALSnglInspiralTableFromLIGOLw(), which
+ * must in turn be the rows written. The callback must also be able to stop
+ * the read early, and a failing callback must be reported as an error.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <lal/LALStdlib.h>
+#include <lal/LIGOMetadataTables.h>
+#include <lal/LIGOLwXML.h>
+#include <lal/LIGOLwXMLInspiralRead.h>
+
+#define FILENAME "LIGOLwXMLInspiralReadTest.xml"
+#define NROWS 7
+#define NSTOP 3
+
+/* state of the test callback */
+struct CollectRowsData {
+    SnglInspiralTable rows[NROWS];
+    int nrows;
+    int stopAfter;  /* stop after this many rows, if > 0 */
+    int failAfter;  /* fail after this many rows, if > 0 */
+};
+
+static int CollectRows(SnglInspiralTable *row, void *data) {
+    struct CollectRowsData *collect = data;
+    if (collect->nrows >= NROWS)
+        return -1;
+    collect->rows[collect->nrows++] = *row;
+    if (collect->failAfter > 0 && collect->nrows >= collect->failAfter)
+        return -1;
+    if (collect->stopAfter > 0 && collect->nrows >= collect->stopAfter)
+        return 1;
+    return 0;
+}
+
+/* returns 0 if every column of the sngl_inspiral table agrees */
+static int CompareRows(const SnglInspiralTable *a, const SnglInspiralTable *b) {
+    int k;
+#define CMP(field) if (a->field != b->field) { fprintf(stderr, "%s (event_id %ld): %s differs\n", __func__, a->event_id, #field); return 1; }
+#define CMPSTR(field) if (strcmp(a->field, b->field) != 0) { fprintf(stderr, "%s (event_id %ld): %s differs: '%s' vs '%s'\n", __func__, a->event_id, #field, a->field, b->field); return 1; }
+    CMP(process_id);
+    CMPSTR(ifo); CMPSTR(search); CMPSTR(channel);
+    CMP(end.gpsSeconds); CMP(end.gpsNanoSeconds); CMP(end_time_gmst);
+    CMP(impulse_time.gpsSeconds); CMP(impulse_time.gpsNanoSeconds);
+    CMP(template_duration); CMP(event_duration);
+    CMP(amplitude); CMP(eff_distance); CMP(coa_phase);
+    CMP(mass1); CMP(mass2); CMP(mchirp); CMP(mtotal); CMP(eta); CMP(kappa); CMP(chi);
+    CMP(tau0); CMP(tau2); CMP(tau3); CMP(tau4); CMP(tau5); CMP(ttotal);
+    CMP(psi0); CMP(psi3);
+    CMP(alpha); CMP(alpha1); CMP(alpha2); CMP(alpha3); CMP(alpha4); CMP(alpha5); CMP(alpha6);
+    CMP(beta); CMP(f_final); CMP(snr);
+    CMP(chisq); CMP(chisq_dof); CMP(bank_chisq); CMP(bank_chisq_dof); CMP(cont_chisq); CMP(cont_chisq_dof);
+    CMP(sigmasq); CMP(rsqveto_duration);
+    for (k = 0; k < 10; k++)
+        CMP(Gamma[k]);
+    CMP(spin1x); CMP(spin1y); CMP(spin1z); CMP(spin2x); CMP(spin2y); CMP(spin2z);
+    CMP(event_id);
+#undef CMP
+#undef CMPSTR
+    return 0;
+}
+
+static void DestroyEvents(SnglInspiralTable *head) {
+    while (head) {
+        SnglInspiralTable *next = head->next;
+        LALFree(head);
+        head = next;
+    }
+}
+
+int main(void) {
+    SnglInspiralTable written[NROWS];
+    SnglInspiralTable *head = NULL, *event;
+    struct CollectRowsData collect;
+    LIGOLwXMLStream *xml;
+    int i, k, n;
+
+    /* write a small table, with a different value in every column of every row */
+    memset(written, 0, sizeof(written));
+    for (i = 0; i < NROWS; i++) {
+        SnglInspiralTable *row = &written[i];
+        row->next = (i + 1 < NROWS) ? &written[i + 1] : NULL;
+        row->process_id = 0;
+        snprintf(row->ifo, sizeof(row->ifo), "%s", (i % 2) ? "L1" : "H1");
+        snprintf(row->search, sizeof(row->search), "search%d", i);
+        snprintf(row->channel, sizeof(row->channel), "CHANNEL_%d", i);
+        row->end.gpsSeconds = 1000000000 + i;
+        row->end.gpsNanoSeconds = 1000 * i + 1;
+        row->end_time_gmst = 1.25 + i;
+        row->impulse_time.gpsSeconds = 1000000100 + i;
+        row->impulse_time.gpsNanoSeconds = 2000 * i + 3;
+        row->template_duration = 10.5 + i;
+        row->event_duration = 0.125 * (i + 1);
+        row->amplitude = 1e-21 * (i + 1);
+        row->eff_distance = 100.5 + i;
+        row->coa_phase = 0.1 * i;
+        row->mass1 = 1.4 + i;
+        row->mass2 = 1.3 + 0.5 * i;
+        row->mchirp = 1.2 + 0.25 * i;
+        row->mtotal = row->mass1 + row->mass2;
+        row->eta = 0.25 - 0.01 * i;
+        row->kappa = -0.5 + 0.1 * i;
+        row->chi = 0.05 * i;
+        row->tau0 = 30. + i;
+        row->tau2 = 2. + i;
+        row->tau3 = 1. + 0.5 * i;
+        row->tau4 = 0.2 + 0.01 * i;
+        row->tau5 = 0.03 * i;
+        row->ttotal = 32. + i;
+        row->psi0 = 1e5 * (i + 1);
+        row->psi3 = -1e3 * (i + 1);
+        row->alpha = 0.7 + i;
+        row->alpha1 = 1.7 + i;
+        row->alpha2 = 2.7 + i;
+        row->alpha3 = 3.7 + i;
+        row->alpha4 = 4.7 + i;
+        row->alpha5 = 5.7 + i;
+        row->alpha6 = 6.7 + i;
+        row->beta = 7.7 + i;
+        row->f_final = 1500. + i;
+        row->snr = 5.5 + i;
+        row->chisq = 20.25 + i;
+        row->chisq_dof = 16 + i;
+        row->bank_chisq = 30.5 + i;
+        row->bank_chisq_dof = 10 + i;
+        row->cont_chisq = 40.75 + i;
+        row->cont_chisq_dof = 8 + i;
+        row->sigmasq = 1.5e3 * (i + 1);
+        row->rsqveto_duration = 0.5 * i;
+        for (k = 0; k < 10; k++)
+            row->Gamma[k] = 0.01 * (10 * i + k + 1);
+        row->spin1x = 0.1 * i;
+        row->spin1y = -0.1 * i;
+        row->spin1z = 0.01 * i;
+        row->spin2x = 0.2 * i;
+        row->spin2y = -0.2 * i;
+        row->spin2z = 0.02 * i;
+        row->event_id = 100 + i;
+    }
+    xml = XLALOpenLIGOLwXMLFile(FILENAME);
+    if (!xml)
+        return 1;
+    if (XLALWriteLIGOLwXMLSnglInspiralTable(xml, written) < 0)
+        return 1;
+    if (XLALCloseLIGOLwXMLFile(xml) < 0)
+        return 1;
+
+    /* read the whole table as a list, which must hold the rows written */
+    n = LALSnglInspiralTableFromLIGOLw(&head, FILENAME, 0, -1);
+    if (n != NROWS) {
+        fprintf(stderr, "LALSnglInspiralTableFromLIGOLw() returned %d rows, expected %d\n", n, NROWS);
+        return 1;
+    }
+    for (i = 0, event = head; i < NROWS; i++, event = event->next) {
+        if (!event) {
+            fprintf(stderr, "LALSnglInspiralTableFromLIGOLw() list is short\n");
+            return 1;
+        }
+        if (CompareRows(event, &written[i]))
+            return 1;
+    }
+    if (event) {
+        fprintf(stderr, "LALSnglInspiralTableFromLIGOLw() list is long\n");
+        return 1;
+    }
+
+    /* read the whole table through the callback, which must see the rows of the list */
+    memset(&collect, 0, sizeof(collect));
+    n = XLALSnglInspiralTableFromLIGOLwForEach(FILENAME, CollectRows, &collect);
+    if (n != NROWS || collect.nrows != NROWS) {
+        fprintf(stderr, "XLALSnglInspiralTableFromLIGOLwForEach() returned %d rows and passed %d to the callback, expected %d\n", n, collect.nrows, NROWS);
+        return 1;
+    }
+    for (i = 0, event = head; i < NROWS; i++, event = event->next)
+        if (CompareRows(&collect.rows[i], event))
+            return 1;
+    DestroyEvents(head);
+    head = NULL;
+
+    /* stop the read early from the callback */
+    memset(&collect, 0, sizeof(collect));
+    collect.stopAfter = NSTOP;
+    n = XLALSnglInspiralTableFromLIGOLwForEach(FILENAME, CollectRows, &collect);
+    if (n != NSTOP || collect.nrows != NSTOP) {
+        fprintf(stderr, "XLALSnglInspiralTableFromLIGOLwForEach() stopped after %d rows with %d passed to the callback, expected %d\n", n, collect.nrows, NSTOP);
+        return 1;
+    }
+    for (i = 0; i < NSTOP; i++)
+        if (CompareRows(&collect.rows[i], &written[i]))
+            return 1;
+
+    /* a range of rows of the list reader, which is built on the callback */
+    n = LALSnglInspiralTableFromLIGOLw(&head, FILENAME, 2, 5);
+    if (n != 3) {
+        fprintf(stderr, "LALSnglInspiralTableFromLIGOLw() returned %d rows in range (2, 5], expected 3\n", n);
+        return 1;
+    }
+    for (i = 2, event = head; event; i++, event = event->next)
+        if (CompareRows(event, &written[i]))
+            return 1;
+    DestroyEvents(head);
+    head = NULL;
+
+    /* a failing callback is an error */
+    memset(&collect, 0, sizeof(collect));
+    collect.failAfter = 2;
+    n = XLALSnglInspiralTableFromLIGOLwForEach(FILENAME, CollectRows, &collect);
+    if (n >= 0 || xlalErrno != XLAL_EFUNC) {
+        fprintf(stderr, "XLALSnglInspiralTableFromLIGOLwForEach() returned %d with a failing callback, expected an error\n", n);
+        return 1;
+    }
+    XLALClearErrno();
+
+    LALCheckMemoryLeaks();
+    return 0;
+}
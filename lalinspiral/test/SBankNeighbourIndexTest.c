@@ -0,0 +1,83 @@
+/**
+ * \file
+ * \ingroup LALInspiralBank_h
+ *
+ * \brief Tests the SBank neighbour index against a brute-force search.
+ *
+ * Templates are scattered over a patch of the (tau0, tau3) plane and
+ * inserted into an index built with a correlated constant metric. For a
+ * number of proposals, the templates returned by
+ * XLALSBankNeighbourIndexQuery() must be exactly those within the query
+ * radius, in order of increasing distance.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <lal/LALStdlib.h>
+#include <lal/AVFactories.h>
+#include <lal/LALInspiralSBankOverlap.h>
+
+#define NTMPLTS 5000
+#define NPROPOSALS 200
+
+static REAL8 mismatch(const REAL8 g00, const REAL8 g01, const REAL8 g11, const REAL8 dtau0, const REAL8 dtau3) {
+    return g00 * dtau0 * dtau0 + 2. * g01 * dtau0 * dtau3 + g11 * dtau3 * dtau3;
+}
+
+int main(void) {
+    const REAL8 g00 = 40., g01 = -90., g11 = 250.;
+    const REAL8 min_match = 0.97, safety = 1.2;
+    const REAL8 r2 = safety * safety * (1. - min_match);
+    REAL8 tau0[NTMPLTS], tau3[NTMPLTS];
+    SBankNeighbourIndex *index;
+    UINT4 k, p, m;
+    int failed = 0;
+
+    srand(271828);
+    index = XLALCreateSBankNeighbourIndex(g00, g01, g11, 0.1);
+    if (!index)
+        return 1;
+
+    for (k = 0; k < NTMPLTS; k++) {
+        tau0[k] = 10. + 5. * rand() / (REAL8) RAND_MAX;
+        tau3[k] = 1. + 2. * rand() / (REAL8) RAND_MAX;
+        if (XLALSBankNeighbourIndexInsert(index, tau0[k], tau3[k], k) != XLAL_SUCCESS)
+            return 1;
+    }
+
+    for (p = 0; p < NPROPOSALS; p++) {
+        const REAL8 ptau0 = 10. + 5. * rand() / (REAL8) RAND_MAX;
+        const REAL8 ptau3 = 1. + 2. * rand() / (REAL8) RAND_MAX;
+        UINT4 nexpected = 0;
+        UINT4Vector *ids = XLALSBankNeighbourIndexQuery(index, ptau0, ptau3, min_match, safety);
+        if (!ids)
+            return 1;
+
+        for (k = 0; k < NTMPLTS; k++)
+            if (mismatch(g00, g01, g11, tau0[k] - ptau0, tau3[k] - ptau3) <= r2)
+                nexpected++;
+        if (ids->length != nexpected) {
+            fprintf(stderr, "proposal %u: found %u neighbours, expected %u\n", p, ids->length, nexpected);
+            failed = 1;
+        }
+
+        for (m = 0; m < ids->length; m++) {
+            const REAL8 d2 = mismatch(g00, g01, g11, tau0[ids->data[m]] - ptau0, tau3[ids->data[m]] - ptau3);
+            if (d2 > r2 * (1. + 1e-12)) {
+                fprintf(stderr, "proposal %u: neighbour %u is outside the query radius\n", p, ids->data[m]);
+                failed = 1;
+            }
+            if (m > 0 && d2 < mismatch(g00, g01, g11, tau0[ids->data[m-1]] - ptau0, tau3[ids->data[m-1]] - ptau3) * (1. - 1e-12)) {
+                fprintf(stderr, "proposal %u: neighbours are not sorted by distance\n", p);
+                failed = 1;
+            }
+        }
+        XLALDestroyUINT4Vector(ids);
+    }
+
+    XLALDestroySBankNeighbourIndex(index);
+    LALCheckMemoryLeaks();
+
+    return failed;
+}
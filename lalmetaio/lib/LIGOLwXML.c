@@ -52,8 +52,16 @@
  */
 
 
+#include <stddef.h>
+#include <stdio.h>
+#include <lal/LALConfig.h>
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
+
 #include <lal/FileIO.h>
 #include <lal/LALMalloc.h>
+#include <lal/LALThreadPool.h>
 #include <lal/LALVCSInfo.h>
 #include <lal/LIGOLwXML.h>
 #include <lal/LIGOMetadataTables.h>
@@ -61,6 +69,222 @@
 #include <LIGOLwXMLHeaders.h>
 
 
+/*
+ * Writing table rows in blocks.  Rows are formatted into a large buffer a
+ * block at a time and each block is written with one call, rather than
+ * one XLALFilePrintf() per row.  With POSIX threads, blocks are formatted
+ * on worker threads while the calling thread writes (and compresses, for
+ * .gz files) the blocks that are ready, in order.  The number of worker
+ * threads follows XLALThreadPoolGetMaxThreads() (e.g. LAL_NUM_THREADS), and
+ * the output does not depend on it.
+ */
+
+
+/* formats one row into s, which has room for size bytes, as snprintf()
+ * does, prefixed by row_head */
+typedef int (*LIGOLwXMLRowFormatter)(char *s, size_t size, const char *row_head, const void *row);
+
+/* rows per block */
+#define LIGOLW_XML_BLOCK_ROWS 2048
+
+/* most worker threads, and blocks each may format ahead of the writer */
+#define LIGOLW_XML_MAX_THREADS 8
+#define LIGOLW_XML_LOOKAHEAD 4
+
+struct LIGOLwXMLBlock {
+	char *buf;
+	size_t len;
+	size_t size;
+	int done;
+	int failed;
+};
+
+struct LIGOLwXMLRows {
+	const void **row;
+	size_t nrows;
+	size_t nblocks;
+	LIGOLwXMLRowFormatter format;
+	struct LIGOLwXMLBlock *block;
+#ifdef LAL_PTHREAD_LOCK
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	size_t next;	/* next block to be formatted */
+	size_t written;	/* number of blocks written */
+	size_t lookahead;	/* most blocks formatted but not written */
+	int abort;
+#endif
+};
+
+
+/* formats rows [first, last) into a block, growing its buffer as needed */
+static int format_rows(struct LIGOLwXMLBlock *block, const struct LIGOLwXMLRows *rows, size_t first, size_t last)
+{
+	size_t i;
+
+	block->len = 0;
+	for(i = first; i < last; i++) {
+		const char *row_head = i ? ",\n\t\t\t" : "\n\t\t\t";
+		int n;
+		while((n = rows->format(block->buf + block->len, block->size - block->len, row_head, rows->row[i])) >= 0 && (size_t) n >= block->size - block->len) {
+			/* buffer too small:  grow it and format the row again */
+			size_t size = 2 * block->size > block->len + n + 1 ? 2 * block->size : block->len + n + 1;
+			char *buf = XLALRealloc(block->buf, size);
+			if(!buf)
+				return -1;
+			block->buf = buf;
+			block->size = size;
+		}
+		if(n < 0)
+			return -1;
+		block->len += n;
+	}
+	return 0;
+}
+
+
+#ifdef LAL_PTHREAD_LOCK
+
+static void *format_rows_thread(void *arg)
+{
+	struct LIGOLwXMLRows *rows = arg;
+
+	pthread_mutex_lock(&rows->mutex);
+	while(!rows->abort && rows->next < rows->nblocks) {
+		size_t b;
+		struct LIGOLwXMLBlock *block;
+		int failed;
+
+		/* don't run too far ahead of the writer */
+		if(rows->next >= rows->written + rows->lookahead) {
+			pthread_cond_wait(&rows->cond, &rows->mutex);
+			continue;
+		}
+		b = rows->next++;
+		block = &rows->block[b];
+		pthread_mutex_unlock(&rows->mutex);
+
+		block->size = 0;
+		block->buf = NULL;
+		failed = format_rows(block, rows, b * LIGOLW_XML_BLOCK_ROWS, b + 1 < rows->nblocks ? (b + 1) * LIGOLW_XML_BLOCK_ROWS : rows->nrows);
+
+		pthread_mutex_lock(&rows->mutex);
+		block->failed = failed;
+		block->done = 1;
+		pthread_cond_broadcast(&rows->cond);
+	}
+	pthread_mutex_unlock(&rows->mutex);
+	return NULL;
+}
+
+
+/* number of worker threads to use for nblocks blocks, from the LAL thread
+ * pool's concurrency budget;  a budget of one formats the blocks serially */
+static int format_rows_nthreads(size_t nblocks)
+{
+	int ncpu = XLALThreadPoolGetMaxThreads();
+	if(ncpu > LIGOLW_XML_MAX_THREADS)
+		ncpu = LIGOLW_XML_MAX_THREADS;
+	if((size_t) ncpu > nblocks)
+		ncpu = nblocks;
+	return ncpu > 1 ? ncpu : 0;
+}
+
+#endif /* LAL_PTHREAD_LOCK */
+
+
+/* write the rows of a linked list whose next pointers are at next_offset */
+static int XLALWriteLIGOLwXMLRows(LIGOLwXMLStream *xml, const void *head, size_t next_offset, LIGOLwXMLRowFormatter format)
+{
+	struct LIGOLwXMLRows rows;
+	const void *row;
+	int failed = 0;
+	size_t b, i;
+#ifdef LAL_PTHREAD_LOCK
+	pthread_t thread[LIGOLW_XML_MAX_THREADS];
+	int nthreads, t;
+#endif
+
+	/* gather the rows into an array */
+
+	rows.nrows = 0;
+	for(row = head; row; row = *(const void * const *) ((const char *) row + next_offset))
+		rows.nrows++;
+	if(!rows.nrows)
+		return 0;
+	rows.row = XLALMalloc(rows.nrows * sizeof(*rows.row));
+	rows.nblocks = (rows.nrows + LIGOLW_XML_BLOCK_ROWS - 1) / LIGOLW_XML_BLOCK_ROWS;
+	rows.block = XLALCalloc(rows.nblocks, sizeof(*rows.block));
+	if(!rows.row || !rows.block) {
+		XLALFree(rows.row);
+		XLALFree(rows.block);
+		XLAL_ERROR(XLAL_ENOMEM);
+	}
+	for(i = 0, row = head; row; row = *(const void * const *) ((const char *) row + next_offset))
+		rows.row[i++] = row;
+	rows.format = format;
+
+#ifdef LAL_PTHREAD_LOCK
+	nthreads = format_rows_nthreads(rows.nblocks);
+	if(nthreads) {
+		/* format blocks on worker threads, writing them here in order */
+		pthread_mutex_init(&rows.mutex, NULL);
+		pthread_cond_init(&rows.cond, NULL);
+		rows.next = rows.written = 0;
+		rows.lookahead = LIGOLW_XML_LOOKAHEAD * nthreads;
+		rows.abort = 0;
+		for(t = 0; t < nthreads; t++)
+			if(pthread_create(&thread[t], NULL, format_rows_thread, &rows))
+				break;
+		nthreads = t;
+		if(nthreads) {
+			for(b = 0; b < rows.nblocks && !failed; b++) {
+				struct LIGOLwXMLBlock *block = &rows.block[b];
+				pthread_mutex_lock(&rows.mutex);
+				while(!block->done)
+					pthread_cond_wait(&rows.cond, &rows.mutex);
+				pthread_mutex_unlock(&rows.mutex);
+				failed = block->failed || XLALFileWrite(block->buf, 1, block->len, xml->fp) != block->len;
+				XLALFree(block->buf);
+				block->buf = NULL;
+				pthread_mutex_lock(&rows.mutex);
+				rows.written++;
+				rows.abort = failed;
+				pthread_cond_broadcast(&rows.cond);
+				pthread_mutex_unlock(&rows.mutex);
+			}
+			for(t = 0; t < nthreads; t++)
+				pthread_join(thread[t], NULL);
+			for(b = 0; b < rows.nblocks; b++)
+				XLALFree(rows.block[b].buf);
+		}
+		pthread_cond_destroy(&rows.cond);
+		pthread_mutex_destroy(&rows.mutex);
+		if(nthreads) {
+			XLALFree(rows.block);
+			XLALFree(rows.row);
+			if(failed)
+				XLAL_ERROR(XLAL_EIO);
+			return 0;
+		}
+		/* no thread could be started:  carry on without them */
+	}
+#endif
+
+	/* format and write the blocks in turn, reusing one buffer */
+
+	for(b = 0; b < rows.nblocks && !failed; b++) {
+		struct LIGOLwXMLBlock *block = &rows.block[0];
+		failed = format_rows(block, &rows, b * LIGOLW_XML_BLOCK_ROWS, b + 1 < rows.nblocks ? (b + 1) * LIGOLW_XML_BLOCK_ROWS : rows.nrows) < 0 || XLALFileWrite(block->buf, 1, block->len, xml->fp) != block->len;
+	}
+	XLALFree(rows.block[0].buf);
+	XLALFree(rows.block);
+	XLALFree(rows.row);
+	if(failed)
+		XLAL_ERROR(XLAL_EIO);
+	return 0;
+}
+
+
 /**
  * Open an XML file for writing.  The return value is a pointer to a new
  * LIGOLwXMLStream file handle or NULL on failure.
@@ -343,6 +567,32 @@ int XLALWriteLIGOLwXMLSearchSummaryTable(
 }
 
 
+static int format_sngl_burst_row(char *s, size_t size, const char *row_head, const void *row)
+{
+	const SnglBurst *sngl_burst = row;
+	return snprintf(s, size, "%s%ld,\"%s\",\"%s\",\"%s\",%d,%d,%d,%d,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.16g,%.16g,%ld",
+		row_head,
+		sngl_burst->process_id,
+		sngl_burst->ifo,
+		sngl_burst->search,
+		sngl_burst->channel,
+		sngl_burst->start_time.gpsSeconds,
+		sngl_burst->start_time.gpsNanoSeconds,
+		sngl_burst->peak_time.gpsSeconds,
+		sngl_burst->peak_time.gpsNanoSeconds,
+		sngl_burst->duration,
+		sngl_burst->central_freq,
+		sngl_burst->bandwidth,
+		sngl_burst->amplitude,
+		sngl_burst->snr,
+		sngl_burst->confidence,
+		sngl_burst->chisq,
+		sngl_burst->chisq_dof,
+		sngl_burst->event_id
+	);
+}
+
+
 /**
  * Write a sngl_burst table to an XML file.
  */
@@ -353,8 +603,6 @@ int XLALWriteLIGOLwXMLSnglBurstTable(
 	const SnglBurst *sngl_burst
 )
 {
-	const char *row_head = "\n\t\t\t";
-
 	if(xml->table != no_table) {
 		XLALPrintError("a table is still open");
 		XLAL_ERROR(XLAL_EFAILED);
@@ -387,30 +635,8 @@ int XLALWriteLIGOLwXMLSnglBurstTable(
 
 	/* rows */
 
-	for(; sngl_burst; sngl_burst = sngl_burst->next) {
-		if(XLALFilePrintf(xml->fp, "%s%ld,\"%s\",\"%s\",\"%s\",%d,%d,%d,%d,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.16g,%.16g,%ld",
-			row_head,
-			sngl_burst->process_id,
-			sngl_burst->ifo,
-			sngl_burst->search,
-			sngl_burst->channel,
-			sngl_burst->start_time.gpsSeconds,
-			sngl_burst->start_time.gpsNanoSeconds,
-			sngl_burst->peak_time.gpsSeconds,
-			sngl_burst->peak_time.gpsNanoSeconds,
-			sngl_burst->duration,
-			sngl_burst->central_freq,
-			sngl_burst->bandwidth,
-			sngl_burst->amplitude,
-			sngl_burst->snr,
-			sngl_burst->confidence,
-			sngl_burst->chisq,
-			sngl_burst->chisq_dof,
-			sngl_burst->event_id
-		) < 0)
-			XLAL_ERROR(XLAL_EFUNC);
-		row_head = ",\n\t\t\t";
-	}
+	if(XLALWriteLIGOLwXMLRows(xml, sngl_burst, offsetof(SnglBurst, next), format_sngl_burst_row) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
 
 	/* table footer */
 
@@ -422,13 +648,84 @@ int XLALWriteLIGOLwXMLSnglBurstTable(
 	return 0;
 }
 
+static int format_sngl_inspiral_row(char *s, size_t size, const char *row_head, const void *row)
+{
+	const SnglInspiralTable *sngl_inspiral = row;
+	return snprintf(s, size, "%s%ld,\"%s\",\"%s\",\"%s\",%d,%d,%.16g,%d,%d,%.16g,%.16g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%u,%.8g,%u,%.8g,%u,%.16g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%ld",
+		row_head,
+		sngl_inspiral->process_id,
+		sngl_inspiral->ifo,
+		sngl_inspiral->search,
+		sngl_inspiral->channel,
+		sngl_inspiral->end.gpsSeconds,
+		sngl_inspiral->end.gpsNanoSeconds,
+		sngl_inspiral->end_time_gmst,
+		sngl_inspiral->impulse_time.gpsSeconds,
+		sngl_inspiral->impulse_time.gpsNanoSeconds,
+		sngl_inspiral->template_duration,
+		sngl_inspiral->event_duration,
+		sngl_inspiral->amplitude,
+		sngl_inspiral->eff_distance,
+		sngl_inspiral->coa_phase,
+		sngl_inspiral->mass1,
+		sngl_inspiral->mass2,
+		sngl_inspiral->mchirp,
+		sngl_inspiral->mtotal,
+		sngl_inspiral->eta,
+		sngl_inspiral->kappa,
+		sngl_inspiral->chi,
+		sngl_inspiral->tau0,
+		sngl_inspiral->tau2,
+		sngl_inspiral->tau3,
+		sngl_inspiral->tau4,
+		sngl_inspiral->tau5,
+		sngl_inspiral->ttotal,
+		sngl_inspiral->psi0,
+		sngl_inspiral->psi3,
+		sngl_inspiral->alpha,
+		sngl_inspiral->alpha1,
+		sngl_inspiral->alpha2,
+		sngl_inspiral->alpha3,
+		sngl_inspiral->alpha4,
+		sngl_inspiral->alpha5,
+		sngl_inspiral->alpha6,
+		sngl_inspiral->beta,
+		sngl_inspiral->f_final,
+		sngl_inspiral->snr,
+		sngl_inspiral->chisq,
+		sngl_inspiral->chisq_dof,
+		sngl_inspiral->bank_chisq,
+		sngl_inspiral->bank_chisq_dof,
+		sngl_inspiral->cont_chisq,
+		sngl_inspiral->cont_chisq_dof,
+		sngl_inspiral->sigmasq,
+		sngl_inspiral->rsqveto_duration,
+		sngl_inspiral->Gamma[0],
+		sngl_inspiral->Gamma[1],
+		sngl_inspiral->Gamma[2],
+		sngl_inspiral->Gamma[3],
+		sngl_inspiral->Gamma[4],
+		sngl_inspiral->Gamma[5],
+		sngl_inspiral->Gamma[6],
+		sngl_inspiral->Gamma[7],
+		sngl_inspiral->Gamma[8],
+		sngl_inspiral->Gamma[9],
+		sngl_inspiral->spin1x,
+		sngl_inspiral->spin1y,
+		sngl_inspiral->spin1z,
+		sngl_inspiral->spin2x,
+		sngl_inspiral->spin2y,
+		sngl_inspiral->spin2z,
+		sngl_inspiral->event_id
+	);
+}
+
+
 int XLALWriteLIGOLwXMLSnglInspiralTable(
 	LIGOLwXMLStream *xml,
 	const SnglInspiralTable *sngl_inspiral
 )
 {
-	const char *row_head = "\n\t\t\t";
-
 	if(xml->table != no_table) {
 		XLALPrintError("a table is still open");
 		XLAL_ERROR(XLAL_EFAILED);
@@ -508,76 +805,8 @@ int XLALWriteLIGOLwXMLSnglInspiralTable(
 
 	/* rows */
 
-	for(; sngl_inspiral; sngl_inspiral = sngl_inspiral->next) {
-		if( XLALFilePrintf(xml->fp,"%s%ld,\"%s\",\"%s\",\"%s\",%d,%d,%.16g,%d,%d,%.16g,%.16g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%u,%.8g,%u,%.8g,%u,%.16g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%ld",
-			   row_head,
-			   sngl_inspiral->process_id,
-			   sngl_inspiral->ifo,
-			   sngl_inspiral->search,
-			   sngl_inspiral->channel,
-			   sngl_inspiral->end.gpsSeconds,
-			   sngl_inspiral->end.gpsNanoSeconds,
-			   sngl_inspiral->end_time_gmst,
-			   sngl_inspiral->impulse_time.gpsSeconds,
-			   sngl_inspiral->impulse_time.gpsNanoSeconds,
-			   sngl_inspiral->template_duration,
-			   sngl_inspiral->event_duration,
-			   sngl_inspiral->amplitude,
-			   sngl_inspiral->eff_distance,
-			   sngl_inspiral->coa_phase,
-			   sngl_inspiral->mass1,
-			   sngl_inspiral->mass2,
-			   sngl_inspiral->mchirp,
-			   sngl_inspiral->mtotal,
-			   sngl_inspiral->eta,
-			   sngl_inspiral->kappa,
-			   sngl_inspiral->chi,
-			   sngl_inspiral->tau0,
-			   sngl_inspiral->tau2,
-			   sngl_inspiral->tau3,
-			   sngl_inspiral->tau4,
-			   sngl_inspiral->tau5,
-			   sngl_inspiral->ttotal,
-			   sngl_inspiral->psi0,
-			   sngl_inspiral->psi3,
-			   sngl_inspiral->alpha,
-			   sngl_inspiral->alpha1,
-			   sngl_inspiral->alpha2,
-			   sngl_inspiral->alpha3,
-			   sngl_inspiral->alpha4,
-			   sngl_inspiral->alpha5,
-			   sngl_inspiral->alpha6,
-			   sngl_inspiral->beta,
-			   sngl_inspiral->f_final,
-			   sngl_inspiral->snr,
-			   sngl_inspiral->chisq,
-			   sngl_inspiral->chisq_dof,
-			   sngl_inspiral->bank_chisq,
-			   sngl_inspiral->bank_chisq_dof,
-			   sngl_inspiral->cont_chisq,
-			   sngl_inspiral->cont_chisq_dof,
-			   sngl_inspiral->sigmasq,
-			   sngl_inspiral->rsqveto_duration,
-			   sngl_inspiral->Gamma[0],
-			   sngl_inspiral->Gamma[1],
-			   sngl_inspiral->Gamma[2],
-			   sngl_inspiral->Gamma[3],
-			   sngl_inspiral->Gamma[4],
-			   sngl_inspiral->Gamma[5],
-			   sngl_inspiral->Gamma[6],
-			   sngl_inspiral->Gamma[7],
-			   sngl_inspiral->Gamma[8],
-			   sngl_inspiral->Gamma[9],
-			   sngl_inspiral->spin1x,  
-			   sngl_inspiral->spin1y,
-			   sngl_inspiral->spin1z,
-			   sngl_inspiral->spin2x,
-			   sngl_inspiral->spin2y,
-			   sngl_inspiral->spin2z,
-			   sngl_inspiral->event_id ) < 0)
-			XLAL_ERROR(XLAL_EFUNC);
-		row_head = ",\n\t\t\t";
-	}
+	if(XLALWriteLIGOLwXMLRows(xml, sngl_inspiral, offsetof(SnglInspiralTable, next), format_sngl_inspiral_row) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
 
 	/* table footer */
 	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
@@ -590,6 +819,35 @@ int XLALWriteLIGOLwXMLSnglInspiralTable(
 
 
 
+static int format_sim_burst_row(char *s, size_t size, const char *row_head, const void *row)
+{
+	const SimBurst *sim_burst = row;
+	return snprintf(s, size, "%s%ld,\"%s\",%.16g,%.16g,%.16g,%d,%d,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%lu,%ld,%ld",
+		row_head,
+		sim_burst->process_id,
+		sim_burst->waveform,
+		sim_burst->ra,
+		sim_burst->dec,
+		sim_burst->psi,
+		sim_burst->time_geocent_gps.gpsSeconds,
+		sim_burst->time_geocent_gps.gpsNanoSeconds,
+		sim_burst->time_geocent_gmst,
+		sim_burst->duration,
+		sim_burst->frequency,
+		sim_burst->bandwidth,
+		sim_burst->q,
+		sim_burst->pol_ellipse_angle,
+		sim_burst->pol_ellipse_e,
+		sim_burst->amplitude,
+		sim_burst->hrss,
+		sim_burst->egw_over_rsquared,
+		sim_burst->waveform_number,
+		sim_burst->time_slide_id,
+		sim_burst->simulation_id
+	);
+}
+
+
 /**
  * Write a sim_burst table to an XML file.
  */
@@ -600,8 +858,6 @@ int XLALWriteLIGOLwXMLSimBurstTable(
 	const SimBurst *sim_burst
 )
 {
-	const char *row_head = "\n\t\t\t";
-
 	if(xml->table != no_table) {
 		XLALPrintError("a table is still open");
 		XLAL_ERROR(XLAL_EFAILED);
@@ -637,34 +893,172 @@ int XLALWriteLIGOLwXMLSimBurstTable(
 
 	/* rows */
 
-	for(; sim_burst; sim_burst = sim_burst->next) {
-		if(XLALFilePrintf(xml->fp, "%s%ld,\"%s\",%.16g,%.16g,%.16g,%d,%d,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%lu,%ld,%ld",
-			row_head,
-			sim_burst->process_id,
-			sim_burst->waveform,
-			sim_burst->ra,
-			sim_burst->dec,
-			sim_burst->psi,
-			sim_burst->time_geocent_gps.gpsSeconds,
-			sim_burst->time_geocent_gps.gpsNanoSeconds,
-			sim_burst->time_geocent_gmst,
-			sim_burst->duration,
-			sim_burst->frequency,
-			sim_burst->bandwidth,
-			sim_burst->q,
-			sim_burst->pol_ellipse_angle,
-			sim_burst->pol_ellipse_e,
-			sim_burst->amplitude,
-			sim_burst->hrss,
-			sim_burst->egw_over_rsquared,
-			sim_burst->waveform_number,
-			sim_burst->time_slide_id,
-			sim_burst->simulation_id
-		) < 0)
-			XLAL_ERROR(XLAL_EFUNC);
-		row_head = ",\n\t\t\t";
+	if(XLALWriteLIGOLwXMLRows(xml, sim_burst, offsetof(SimBurst, next), format_sim_burst_row) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	/* table footer */
+
+	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	/* done */
+
+	return 0;
+}
+
+
+static int format_sim_inspiral_row(char *s, size_t size, const char *row_head, const void *row)
+{
+	const SimInspiralTable *sim_inspiral = row;
+	return snprintf(s, size, "%s%ld,\"%s\",%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%.16g,\"%s\",%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%d,%d,\"%s\",%d,\"%s\",%d,%ld",
+		row_head,
+		sim_inspiral->process_id,
+		sim_inspiral->waveform,
+		sim_inspiral->geocent_end_time.gpsSeconds,
+		sim_inspiral->geocent_end_time.gpsNanoSeconds,
+		sim_inspiral->h_end_time.gpsSeconds,
+		sim_inspiral->h_end_time.gpsNanoSeconds,
+		sim_inspiral->l_end_time.gpsSeconds,
+		sim_inspiral->l_end_time.gpsNanoSeconds,
+		sim_inspiral->g_end_time.gpsSeconds,
+		sim_inspiral->g_end_time.gpsNanoSeconds,
+		sim_inspiral->t_end_time.gpsSeconds,
+		sim_inspiral->t_end_time.gpsNanoSeconds,
+		sim_inspiral->v_end_time.gpsSeconds,
+		sim_inspiral->v_end_time.gpsNanoSeconds,
+		sim_inspiral->end_time_gmst,
+		sim_inspiral->source,
+		sim_inspiral->mass1,
+		sim_inspiral->mass2,
+		sim_inspiral->mchirp,
+		sim_inspiral->eta,
+		sim_inspiral->distance,
+		sim_inspiral->longitude,
+		sim_inspiral->latitude,
+		sim_inspiral->inclination,
+		sim_inspiral->coa_phase,
+		sim_inspiral->polarization,
+		sim_inspiral->psi0,
+		sim_inspiral->psi3,
+		sim_inspiral->alpha,
+		sim_inspiral->alpha1,
+		sim_inspiral->alpha2,
+		sim_inspiral->alpha3,
+		sim_inspiral->alpha4,
+		sim_inspiral->alpha5,
+		sim_inspiral->alpha6,
+		sim_inspiral->beta,
+		sim_inspiral->spin1x,
+		sim_inspiral->spin1y,
+		sim_inspiral->spin1z,
+		sim_inspiral->spin2x,
+		sim_inspiral->spin2y,
+		sim_inspiral->spin2z,
+		sim_inspiral->theta0,
+		sim_inspiral->phi0,
+		sim_inspiral->f_lower,
+		sim_inspiral->f_final,
+		sim_inspiral->eff_dist_h,
+		sim_inspiral->eff_dist_l,
+		sim_inspiral->eff_dist_g,
+		sim_inspiral->eff_dist_t,
+		sim_inspiral->eff_dist_v,
+		sim_inspiral->numrel_mode_min,
+		sim_inspiral->numrel_mode_max,
+		sim_inspiral->numrel_data,
+		sim_inspiral->amp_order,
+		sim_inspiral->taper,
+		sim_inspiral->bandpass,
+		sim_inspiral->simulation_id
+	);
+}
+
+/**
+ * Write a sim_inspiral table to an XML file.
+ */
+
+
+int XLALWriteLIGOLwXMLSimInspiralTable(
+	LIGOLwXMLStream *xml,
+	const SimInspiralTable *sim_inspiral
+)
+{
+	if(xml->table != no_table) {
+		XLALPrintError("a table is still open");
+		XLAL_ERROR(XLAL_EFAILED);
 	}
 
+	/* table header */
+
+	XLALClearErrno();
+	XLALFilePuts("\t<Table Name=\"sim_inspiral:table\">\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"process:process_id\" Type=\"int_8s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:waveform\" Type=\"lstring\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:geocent_end_time\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:geocent_end_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:h_end_time\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:h_end_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:l_end_time\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:l_end_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:g_end_time\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:g_end_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:t_end_time\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:t_end_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:v_end_time\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:v_end_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:end_time_gmst\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:source\" Type=\"lstring\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:mass1\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:mass2\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:mchirp\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:eta\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:distance\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:longitude\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:latitude\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:inclination\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:coa_phase\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:polarization\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:psi0\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:psi3\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:alpha\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:alpha1\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:alpha2\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:alpha3\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:alpha4\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:alpha5\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:alpha6\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:beta\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:spin1x\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:spin1y\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:spin1z\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:spin2x\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:spin2y\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:spin2z\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:theta0\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:phi0\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:f_lower\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:f_final\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:eff_dist_h\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:eff_dist_l\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:eff_dist_g\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:eff_dist_t\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:eff_dist_v\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:numrel_mode_min\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:numrel_mode_max\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:numrel_data\" Type=\"lstring\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:amp_order\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:taper\" Type=\"lstring\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:bandpass\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_inspiral:simulation_id\" Type=\"int_8s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Stream Name=\"sim_inspiral:table\" Type=\"Local\" Delimiter=\",\">", xml->fp);
+	if(XLALGetBaseErrno())
+		XLAL_ERROR(XLAL_EFUNC);
+
+	/* rows */
+
+	if(XLALWriteLIGOLwXMLRows(xml, sim_inspiral, offsetof(SimInspiralTable, next), format_sim_inspiral_row) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
 	/* table footer */
 
 	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
@@ -113,6 +113,25 @@ void XLALDestroyTimeSlideTable(TimeSlide *);
 const TimeSlide *XLALTimeSlideConstGetByIDAndInstrument(const TimeSlide *, long, const char *);
 TimeSlide *XLALTimeSlideGetByIDAndInstrument(TimeSlide *, long, const char *);
 
+#ifndef SWIG   // exclude from SWIG interface
+/**
+ * Pairs of coincident triggers from two detectors, found in a set of time
+ * slides by XLALTimeSlideCoincPairs().  Element i of each array describes
+ * one coincidence:  the index of the time slide and the indexes of the
+ * triggers from detectors A and B.
+ */
+typedef struct tagTimeSlideCoincPairs {
+	size_t length;
+	UINT4 *slide;
+	UINT4 *a;
+	UINT4 *b;
+} TimeSlideCoincPairs;
+
+int XLALTimeSlideTablePairOffsets(const TimeSlide *time_slide, const char *instrument_a, const char *instrument_b, long **time_slide_id, INT8 **offset, size_t *n);
+TimeSlideCoincPairs *XLALTimeSlideCoincPairs(const INT8 *t_a, size_t n_a, const INT8 *t_b, size_t n_b, const INT8 *offset, size_t n_offsets, INT8 window);
+void XLALDestroyTimeSlideCoincPairs(TimeSlideCoincPairs *pairs);
+#endif   // SWIG
+
 SearchSummaryTable *XLALCreateSearchSummaryTableRow(const ProcessTable *);
 #ifndef SWIG   // exclude from SWIG interface
 void XLALDestroySearchSummaryTableRow(SearchSummaryTable *);
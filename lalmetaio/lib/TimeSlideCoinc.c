@@ -0,0 +1,453 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+
+
+/**
+ * \file
+ * \ingroup lalmetaio_general
+ * \brief Two-detector coincidence of time-sorted triggers across many time
+ * slides.
+ *
+ * The triggers of each detector are given as an array of times in
+ * nanoseconds (e.g., the peak_time column of a SnglBurstColumns table)
+ * sorted in increasing order.  For each time slide, the offset of
+ * detector B relative to detector A is given, also in nanoseconds.  A
+ * trigger a from detector A and a trigger b from detector B are coincident
+ * in a time slide with offset dt if
+ *
+ * \f[ |t_{a} - (t_{b} + dt)| \leq \mathrm{window}. \f]
+ *
+ * All the time slides are evaluated in a single pass over the triggers of
+ * detector A:  for each slide, a pointer into the triggers of detector B
+ * marks the start of the coincidence window, and these pointers only ever
+ * move forward.  The cost is proportional to the number of triggers from
+ * detector A times the number of slides, plus the number of triggers from
+ * detector B per slide, plus the number of coincidences found.  When POSIX
+ * threads are available the slides are divided among threads.
+ */
+
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <lal/LALConfig.h>
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#include <lal/Date.h>
+#include <lal/LALMalloc.h>
+#include <lal/LALStdlib.h>
+#include <lal/LIGOMetadataTables.h>
+#include <lal/LIGOMetadataUtils.h>
+#include <lal/XLALError.h>
+
+
+/* most threads used to evaluate slides */
+#define TIME_SLIDE_COINC_MAX_THREADS 8
+
+
+/*
+ * ============================================================================
+ *
+ *                      Time Slide Offsets of a Pair
+ *
+ * ============================================================================
+ */
+
+
+struct id_offset {
+	long time_slide_id;
+	REAL8 offset;
+};
+
+
+static int compare_id_offset(const void *a, const void *b)
+{
+	long id_a = ((const struct id_offset *) a)->time_slide_id;
+	long id_b = ((const struct id_offset *) b)->time_slide_id;
+	return id_a > id_b ? +1 : id_a < id_b ? -1 : 0;
+}
+
+
+/* collect the time_slide_ids and offsets of an instrument, sorted by ID */
+static struct id_offset *instrument_offsets(const TimeSlide *time_slide, const char *instrument, size_t *n)
+{
+	struct id_offset *list = NULL;
+	const TimeSlide *row;
+	size_t i;
+
+	*n = 0;
+	for(row = time_slide; row; row = row->next)
+		if(!strcmp(row->instrument, instrument))
+			++*n;
+	if(!*n)
+		return NULL;
+	list = XLALMalloc(*n * sizeof(*list));
+	if(!list)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	for(i = 0, row = time_slide; row; row = row->next)
+		if(!strcmp(row->instrument, instrument)) {
+			list[i].time_slide_id = row->time_slide_id;
+			list[i].offset = row->offset;
+			i++;
+		}
+	qsort(list, *n, sizeof(*list), compare_id_offset);
+	return list;
+}
+
+
+/**
+ * Extract from a time_slide table the offset of instrument_b relative to
+ * instrument_a in each time slide that has entries for both, as required
+ * by XLALTimeSlideCoincPairs().  On success, *time_slide_id and *offset
+ * are set to newly-allocated arrays of *n elements holding the IDs of the
+ * time slides, in increasing order, and the offsets in nanoseconds;  the
+ * calling code must free them with XLALFree().  Returns 0 on success, or
+ * < 0 on failure.
+ */
+
+
+int XLALTimeSlideTablePairOffsets(
+	const TimeSlide *time_slide,
+	const char *instrument_a,
+	const char *instrument_b,
+	long **time_slide_id,
+	INT8 **offset,
+	size_t *n
+)
+{
+	struct id_offset *list_a, *list_b;
+	size_t n_a, n_b, i, j;
+
+	XLAL_CHECK(instrument_a && instrument_b && time_slide_id && offset && n, XLAL_EFAULT);
+	*time_slide_id = NULL;
+	*offset = NULL;
+	*n = 0;
+
+	list_a = instrument_offsets(time_slide, instrument_a, &n_a);
+	if(!list_a && n_a)
+		XLAL_ERROR(XLAL_EFUNC);
+	list_b = instrument_offsets(time_slide, instrument_b, &n_b);
+	if(!list_b && n_b) {
+		XLALFree(list_a);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+	if(!n_a || !n_b) {
+		XLALFree(list_a);
+		XLALFree(list_b);
+		return 0;
+	}
+
+	*time_slide_id = XLALMalloc((n_a < n_b ? n_a : n_b) * sizeof(**time_slide_id));
+	*offset = XLALMalloc((n_a < n_b ? n_a : n_b) * sizeof(**offset));
+	if(!*time_slide_id || !*offset) {
+		XLALFree(*time_slide_id);
+		XLALFree(*offset);
+		*time_slide_id = NULL;
+		*offset = NULL;
+		XLALFree(list_a);
+		XLALFree(list_b);
+		XLAL_ERROR(XLAL_ENOMEM);
+	}
+
+	/* merge the two lists on ID */
+
+	for(i = j = 0; i < n_a && j < n_b;) {
+		if(list_a[i].time_slide_id < list_b[j].time_slide_id)
+			i++;
+		else if(list_a[i].time_slide_id > list_b[j].time_slide_id)
+			j++;
+		else {
+			(*time_slide_id)[*n] = list_a[i].time_slide_id;
+			(*offset)[*n] = (INT8) llround((list_b[j].offset - list_a[i].offset) * XLAL_BILLION_REAL8);
+			++*n;
+			i++;
+			j++;
+		}
+	}
+
+	XLALFree(list_a);
+	XLALFree(list_b);
+	return 0;
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                           Coincidence Engine
+ *
+ * ============================================================================
+ */
+
+
+struct coinc_pass {
+	/* input */
+	const INT8 *t_a;
+	size_t n_a;
+	const INT8 *t_b;
+	size_t n_b;
+	const INT8 *offset;
+	size_t first_slide;
+	size_t n_slides;
+	INT8 window;
+	/* output */
+	size_t length;
+	size_t size;
+	UINT4 *slide;
+	UINT4 *a;
+	UINT4 *b;
+	int failed;
+};
+
+
+static int coinc_pass_append(struct coinc_pass *pass, size_t slide, size_t a, size_t b)
+{
+	if(pass->length == pass->size) {
+		size_t size = pass->size ? 2 * pass->size : 1024;
+		UINT4 *new_slide = XLALRealloc(pass->slide, size * sizeof(*pass->slide));
+		UINT4 *new_a, *new_b;
+		if(!new_slide)
+			return -1;
+		pass->slide = new_slide;
+		new_a = XLALRealloc(pass->a, size * sizeof(*pass->a));
+		if(!new_a)
+			return -1;
+		pass->a = new_a;
+		new_b = XLALRealloc(pass->b, size * sizeof(*pass->b));
+		if(!new_b)
+			return -1;
+		pass->b = new_b;
+		pass->size = size;
+	}
+	pass->slide[pass->length] = slide;
+	pass->a[pass->length] = a;
+	pass->b[pass->length] = b;
+	pass->length++;
+	return 0;
+}
+
+
+/* one pass over the triggers of detector A, evaluating a range of slides */
+static void *coinc_pass(void *arg)
+{
+	struct coinc_pass *pass = arg;
+	size_t *lo = XLALCalloc(pass->n_slides ? pass->n_slides : 1, sizeof(*lo));
+	size_t i, k;
+
+	if(!lo) {
+		pass->failed = 1;
+		return NULL;
+	}
+
+	for(i = 0; i < pass->n_a; i++) {
+		INT8 t_lo = pass->t_a[i] - pass->window;
+		INT8 t_hi = pass->t_a[i] + pass->window;
+		for(k = 0; k < pass->n_slides; k++) {
+			INT8 dt = pass->offset[pass->first_slide + k];
+			size_t j;
+			/* advance to the first trigger from B that can be coincident
+			 * with this or any later trigger from A */
+			while(lo[k] < pass->n_b && pass->t_b[lo[k]] + dt < t_lo)
+				lo[k]++;
+			for(j = lo[k]; j < pass->n_b && pass->t_b[j] + dt <= t_hi; j++)
+				if(coinc_pass_append(pass, pass->first_slide + k, i, j) < 0) {
+					pass->failed = 1;
+					XLALFree(lo);
+					return NULL;
+				}
+		}
+	}
+
+	XLALFree(lo);
+	return NULL;
+}
+
+
+#ifdef LAL_PTHREAD_LOCK
+static size_t coinc_nthreads(size_t n_slides)
+{
+	long ncpu = 1;
+#ifdef _SC_NPROCESSORS_ONLN
+	ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	if(ncpu > TIME_SLIDE_COINC_MAX_THREADS)
+		ncpu = TIME_SLIDE_COINC_MAX_THREADS;
+	if(ncpu < 1)
+		ncpu = 1;
+	return (size_t) ncpu < n_slides ? (size_t) ncpu : n_slides ? n_slides : 1;
+}
+#endif
+
+
+static int is_sorted(const INT8 *t, size_t n)
+{
+	size_t i;
+	for(i = 1; i < n; i++)
+		if(t[i] < t[i - 1])
+			return 0;
+	return 1;
+}
+
+
+/**
+ * Find the pairs of coincident triggers from two detectors in each of a
+ * list of time slides.  t_a and t_b are the times of the triggers from
+ * detectors A and B, in nanoseconds, each sorted in increasing order.
+ * offset is an array of n_offsets offsets, in nanoseconds, of detector B
+ * relative to detector A (see XLALTimeSlideTablePairOffsets()).  Triggers
+ * are coincident in a slide if their times, after applying the offset,
+ * differ by no more than window nanoseconds.
+ *
+ * The return value is a newly-allocated TimeSlideCoincPairs structure
+ * listing the coincidences as indexes into offset, t_a and t_b, sorted by
+ * slide, then by trigger from A, then by trigger from B.  The order does
+ * not depend on the number of threads used.  Returns NULL on failure.
+ */
+
+
+TimeSlideCoincPairs *XLALTimeSlideCoincPairs(
+	const INT8 *t_a,
+	size_t n_a,
+	const INT8 *t_b,
+	size_t n_b,
+	const INT8 *offset,
+	size_t n_offsets,
+	INT8 window
+)
+{
+	TimeSlideCoincPairs *pairs;
+	struct coinc_pass *pass;
+	size_t *count;
+	size_t npasses = 1;
+	size_t length = 0;
+	size_t p, k, m;
+	int failed = 0;
+
+	XLAL_CHECK_NULL((t_a || !n_a) && (t_b || !n_b) && (offset || !n_offsets), XLAL_EFAULT);
+	XLAL_CHECK_NULL(window >= 0, XLAL_EDOM);
+	XLAL_CHECK_NULL(n_a <= 0xffffffff && n_b <= 0xffffffff && n_offsets <= 0xffffffff, XLAL_EBADLEN);
+	XLAL_CHECK_NULL(is_sorted(t_a, n_a) && is_sorted(t_b, n_b), XLAL_EINVAL, "trigger times are not sorted");
+
+#ifdef LAL_PTHREAD_LOCK
+	npasses = coinc_nthreads(n_offsets);
+#endif
+
+	/* divide the slides among the passes */
+
+	pass = XLALCalloc(npasses, sizeof(*pass));
+	count = XLALCalloc(n_offsets ? n_offsets : 1, sizeof(*count));
+	pairs = XLALCalloc(1, sizeof(*pairs));
+	if(!pass || !count || !pairs) {
+		XLALFree(pass);
+		XLALFree(count);
+		XLALFree(pairs);
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	}
+	for(p = 0; p < npasses; p++) {
+		pass[p].t_a = t_a;
+		pass[p].n_a = n_a;
+		pass[p].t_b = t_b;
+		pass[p].n_b = n_b;
+		pass[p].offset = offset;
+		pass[p].first_slide = p * n_offsets / npasses;
+		pass[p].n_slides = (p + 1) * n_offsets / npasses - pass[p].first_slide;
+		pass[p].window = window;
+	}
+
+	/* run them */
+
+#ifdef LAL_PTHREAD_LOCK
+	if(npasses > 1) {
+		pthread_t thread[TIME_SLIDE_COINC_MAX_THREADS];
+		int started[TIME_SLIDE_COINC_MAX_THREADS];
+		for(p = 0; p < npasses; p++)
+			started[p] = !pthread_create(&thread[p], NULL, coinc_pass, &pass[p]);
+		for(p = 0; p < npasses; p++) {
+			if(started[p])
+				pthread_join(thread[p], NULL);
+			else
+				/* could not start a thread:  do it here */
+				coinc_pass(&pass[p]);
+		}
+	} else
+#endif
+		coinc_pass(&pass[0]);
+
+	/* collect the coincidences in order of slide.  each pass found them
+	 * in order of A then slide then B, so a stable counting sort on slide
+	 * leaves them ordered by slide, then A, then B */
+
+	for(p = 0; p < npasses; p++) {
+		failed |= pass[p].failed;
+		for(m = 0; m < pass[p].length; m++)
+			count[pass[p].slide[m]]++;
+		length += pass[p].length;
+	}
+	if(!failed && length) {
+		pairs->slide = XLALMalloc(length * sizeof(*pairs->slide));
+		pairs->a = XLALMalloc(length * sizeof(*pairs->a));
+		pairs->b = XLALMalloc(length * sizeof(*pairs->b));
+		failed = !pairs->slide || !pairs->a || !pairs->b;
+	}
+	if(!failed) {
+		size_t next = 0;
+		for(k = 0; k < n_offsets; k++) {
+			size_t c = count[k];
+			count[k] = next;
+			next += c;
+		}
+		for(p = 0; p < npasses; p++)
+			for(m = 0; m < pass[p].length; m++) {
+				size_t dest = count[pass[p].slide[m]]++;
+				pairs->slide[dest] = pass[p].slide[m];
+				pairs->a[dest] = pass[p].a[m];
+				pairs->b[dest] = pass[p].b[m];
+			}
+		pairs->length = length;
+	}
+
+	for(p = 0; p < npasses; p++) {
+		XLALFree(pass[p].slide);
+		XLALFree(pass[p].a);
+		XLALFree(pass[p].b);
+	}
+	XLALFree(pass);
+	XLALFree(count);
+	if(failed) {
+		XLALDestroyTimeSlideCoincPairs(pairs);
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	}
+	return pairs;
+}
+
+
+/**
+ * Destroy a TimeSlideCoincPairs structure.
+ */
+
+
+void XLALDestroyTimeSlideCoincPairs(TimeSlideCoincPairs *pairs)
+{
+	if(pairs) {
+		XLALFree(pairs->slide);
+		XLALFree(pairs->a);
+		XLALFree(pairs->b);
+	}
+	XLALFree(pairs);
+}
@@ -0,0 +1,183 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with with program; see the file COPYING. If not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301  USA
+ */
+
+
+/*
+ * Tests that the LIGO Light Weight XML table writers, which format rows in
+ * blocks on worker threads, write the same document whatever the number of
+ * threads, for plain and gzip-compressed files.  The tables are long
+ * enough to span several blocks.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <lal/FileIO.h>
+#include <lal/LALMalloc.h>
+#include <lal/LALThreadPool.h>
+#include <lal/LIGOLwXML.h>
+#include <lal/LIGOMetadataTables.h>
+#include <lal/XLALError.h>
+
+
+#define NROWS 5000
+
+
+static SnglInspiralTable *sngl_inspiral;
+static SnglBurst *sngl_burst;
+static SimBurst *sim_burst;
+
+
+static void make_tables(void)
+{
+	int i, k;
+
+	sngl_inspiral = XLALCalloc(NROWS, sizeof(*sngl_inspiral));
+	sngl_burst = XLALCalloc(NROWS, sizeof(*sngl_burst));
+	sim_burst = XLALCalloc(NROWS, sizeof(*sim_burst));
+	if(!sngl_inspiral || !sngl_burst || !sim_burst)
+		exit(1);
+
+	for(i = 0; i < NROWS; i++) {
+		sngl_inspiral[i].next = i + 1 < NROWS ? &sngl_inspiral[i + 1] : NULL;
+		snprintf(sngl_inspiral[i].ifo, sizeof(sngl_inspiral[i].ifo), "%s", i % 2 ? "L1" : "H1");
+		snprintf(sngl_inspiral[i].search, sizeof(sngl_inspiral[i].search), "search%d", i % 7);
+		snprintf(sngl_inspiral[i].channel, sizeof(sngl_inspiral[i].channel), "CHANNEL_%d", i);
+		sngl_inspiral[i].end.gpsSeconds = 1000000000 + i;
+		sngl_inspiral[i].end.gpsNanoSeconds = (i * 7919) % 1000000000;
+		sngl_inspiral[i].end_time_gmst = 1.0 / (i + 1);
+		sngl_inspiral[i].mass1 = 1.0 + 1.0 / (i + 3);
+		sngl_inspiral[i].mass2 = 1.0 + 1.0 / (i + 7);
+		sngl_inspiral[i].snr = 5.0 + i / 3.0;
+		sngl_inspiral[i].chisq = i * 0.1;
+		sngl_inspiral[i].sigmasq = 1e3 / (i + 1);
+		for(k = 0; k < 10; k++)
+			sngl_inspiral[i].Gamma[k] = (k + 1.0) / (i + 11);
+		sngl_inspiral[i].spin1z = -0.5 + (double) i / NROWS;
+		sngl_inspiral[i].event_id = i;
+
+		sngl_burst[i].next = i + 1 < NROWS ? &sngl_burst[i + 1] : NULL;
+		snprintf(sngl_burst[i].ifo, sizeof(sngl_burst[i].ifo), "%s", i % 2 ? "L1" : "H1");
+		snprintf(sngl_burst[i].search, sizeof(sngl_burst[i].search), "excesspower");
+		snprintf(sngl_burst[i].channel, sizeof(sngl_burst[i].channel), "CHANNEL_%d", i);
+		sngl_burst[i].start_time.gpsSeconds = 1000000000 + i;
+		sngl_burst[i].peak_time.gpsNanoSeconds = (i * 104729) % 1000000000;
+		sngl_burst[i].duration = 1.0 / (i + 1);
+		sngl_burst[i].central_freq = 100.0 + i / 9.0;
+		sngl_burst[i].confidence = -i / 13.0;
+		sngl_burst[i].chisq = 1.0 / (i + 5);
+		sngl_burst[i].event_id = i;
+
+		sim_burst[i].next = i + 1 < NROWS ? &sim_burst[i + 1] : NULL;
+		snprintf(sim_burst[i].waveform, sizeof(sim_burst[i].waveform), "SineGaussian");
+		sim_burst[i].ra = 1.0 / (i + 2);
+		sim_burst[i].dec = -1.0 / (i + 3);
+		sim_burst[i].psi = i / 17.0;
+		sim_burst[i].time_geocent_gps.gpsSeconds = 1000000000 + 10 * i;
+		sim_burst[i].time_geocent_gps.gpsNanoSeconds = (i * 199999) % 1000000000;
+		sim_burst[i].frequency = 100.0 + i / 3.0;
+		sim_burst[i].q = 9.0;
+		sim_burst[i].hrss = 1e-21 / (i + 1);
+		sim_burst[i].time_slide_id = i % 3;
+		sim_burst[i].simulation_id = i;
+	}
+}
+
+
+static int write_document(const char *filename, int nthreads)
+{
+	LIGOLwXMLStream *xml;
+
+	if(XLALThreadPoolSetMaxThreads(nthreads) < 0)
+		return -1;
+	xml = XLALOpenLIGOLwXMLFile(filename);
+	if(!xml)
+		return -1;
+	if(XLALWriteLIGOLwXMLSnglInspiralTable(xml, sngl_inspiral) < 0 ||
+	   XLALWriteLIGOLwXMLSnglBurstTable(xml, sngl_burst) < 0 ||
+	   XLALWriteLIGOLwXMLSimBurstTable(xml, sim_burst) < 0) {
+		XLALCloseLIGOLwXMLFile(xml);
+		return -1;
+	}
+	return XLALCloseLIGOLwXMLFile(xml);
+}
+
+
+/* returns 0 if the two files, decompressed if needed, are identical */
+static int compare_documents(const char *filename1, const char *filename2)
+{
+	char buf1[4096], buf2[4096];
+	LALFILE *fp1 = XLALFileOpen(filename1, "r");
+	LALFILE *fp2 = XLALFileOpen(filename2, "r");
+	size_t n1, n2, len = 0;
+	int result = 0;
+
+	if(!fp1 || !fp2) {
+		fprintf(stderr, "unable to open %s or %s\n", filename1, filename2);
+		result = -1;
+	} else do {
+		n1 = XLALFileRead(buf1, 1, sizeof(buf1), fp1);
+		n2 = XLALFileRead(buf2, 1, sizeof(buf2), fp2);
+		if(n1 != n2 || memcmp(buf1, buf2, n1)) {
+			fprintf(stderr, "%s and %s differ within bytes %zu to %zu\n", filename1, filename2, len, len + (n1 > n2 ? n1 : n2));
+			result = -1;
+			break;
+		}
+		len += n1;
+	} while(n1 == sizeof(buf1));
+
+	if(fp1)
+		XLALFileClose(fp1);
+	if(fp2)
+		XLALFileClose(fp2);
+	if(!result && len < NROWS) {
+		fprintf(stderr, "%s is only %zu bytes long\n", filename1, len);
+		result = -1;
+	}
+	return result;
+}
+
+
+int main(void)
+{
+	const int nthreads[] = {2, 3, 8};
+	const char *suffix[] = {".xml", ".xml.gz"};
+	char serial[64], threaded[64];
+	size_t i, j;
+
+	make_tables();
+
+	for(i = 0; i < sizeof(suffix) / sizeof(*suffix); i++) {
+		snprintf(serial, sizeof(serial), "LIGOLwXMLTest_serial%s", suffix[i]);
+		if(write_document(serial, 1) < 0)
+			return 1;
+		for(j = 0; j < sizeof(nthreads) / sizeof(*nthreads); j++) {
+			snprintf(threaded, sizeof(threaded), "LIGOLwXMLTest_threads%d%s", nthreads[j], suffix[i]);
+			if(write_document(threaded, nthreads[j]) < 0)
+				return 1;
+			if(compare_documents(serial, threaded) < 0)
+				return 1;
+		}
+	}
+
+	XLALFree(sngl_inspiral);
+	XLALFree(sngl_burst);
+	XLALFree(sim_burst);
+	LALCheckMemoryLeaks();
+	return 0;
+}
@@ -911,46 +911,157 @@ this isn't defined for either of the two pulsars currently using this model */
 }
 
 
-void
-XLALBinaryPulsarDeltaTNew( BinaryPulsarOutput   *output,
-                           BinaryPulsarInput    *input,
-                           PulsarParameters     *params )
+/*
+ * Binary parameters used by XLALBinaryPulsarDeltaTNew(), read once from the
+ * PulsarParameters so that the delay can be evaluated cheaply for many
+ * timestamps; see BinaryPulsarReadNewParams().
+ */
+typedef struct tagBinaryPulsarNewParams {
+  BOOLEAN isBT, isBTX, isELL1, isDD;	/* which model branch to evaluate */
+  BOOLEAN isDDmodel, isMSS, isDDS;	/* flavours of the DD branch */
+  BOOLEAN kopeikin;			/* whether to compute Kopeikin terms */
+  INT4 nplanets;			/* number of orbiting bodies in BT1P/BT2P models */
+  REAL8 T0[3], w0[3], x[3], e[3], Pb[3]; /* Keplerian parameters of each orbiting body */
+  REAL8 wdot, pbdot, Tasc, edot;
+  REAL8 eps1, eps2, eps1dot, eps2dot;
+  REAL8 xdot, xpbdot;
+  REAL8 lal_gamma, s, r, dr, dth, shapmax, a0, b0;
+  const REAL8Vector *fb;		/* orbital frequency and derivatives, or NULL */
+} BinaryPulsarNewParams;
+
+/* previous solution of Kepler's equation, used to start the next one */
+typedef struct tagKeplerGuess {
+  BOOLEAN valid;
+  REAL8 phase;
+  REAL8 u;
+} KeplerGuess;
+
+/* below this eccentricity, start Kepler's equation from its series solution */
+#define KEPLER_SMALL_ECC 0.1
+
+/* give up on a starting guess after this many Newton-Raphson iterations */
+#define KEPLER_MAX_ITER 50
+
+/*
+ * Solve Kepler's equation by Newton-Raphson iteration from the starting value
+ * u, to the same accuracy as XLALComputeEccentricAnomaly(). Returns non-zero
+ * if the iteration did not converge.
+ */
+static int KeplerNewton( REAL8 phase, REAL8 ecc, REAL8 *u )
 {
-  REAL8 dt=0.; /* binary pulsar deltaT */
-  REAL8 x, xdot;	/* x = asini/c */
-  REAL8 w=0;  /* longitude of periastron */
-  REAL8 e, edot;  /* eccentricity */
-  REAL8 eps1, eps2;
-  REAL8 eps1dot, eps2dot;
-  REAL8 w0, wdot;
-  REAL8 Pb, pbdot;
-  REAL8 xpbdot;
-  REAL8 T0, Tasc, tb=0.; /* time parameters */
+  REAL8 du;
+  UINT4 iter = 0;
+  do {
+    du = (phase - (*u - ecc*sin(*u))) / (1.0 - ecc*cos(*u));
+    (*u) += du;
+    if ( ++iter > KEPLER_MAX_ITER ) {
+      return 1;
+    }
+  } while ( fabs(du) > 1.e-14 );
+  return 0;
+}
 
-  REAL8 s, r; /* Shapiro shape and range params */
-  REAL8 lal_gamma; /* time dilation and grav redshift */
-  REAL8 dr, dth;
-  REAL8 shapmax; /* Shapiro max parameter for DDS model */
-  REAL8 a0, b0;  /* abberation parameters */
-  REAL8 pmra, pmdec; /* proper motion parameters */
+/*
+ * Starting value for Kepler's equation at mean anomaly phase: the series
+ * solution to third order in small eccentricities, otherwise the starting
+ * value of XLALComputeEccentricAnomaly().
+ */
+static REAL8 KeplerStart( REAL8 phase, REAL8 ecc )
+{
+  if ( ecc < KEPLER_SMALL_ECC ) {
+    const REAL8 sp = sin(phase), cp = cos(phase);
+    /* u = M + e sin M + (e^2/2) sin 2M + (e^3/8) (3 sin 3M - sin M) */
+    return phase + ecc*sp*(1.0 + ecc*cp + ecc*ecc*(1.0 - 1.5*sp*sp));
+  }
+  return phase + ecc*sin(phase) / sqrt(1.0 - 2.*ecc*cos(phase) + ecc*ecc);
+}
 
-  REAL8 m2;
-  const REAL8 c3 = (REAL8)LAL_C_SI*(REAL8)LAL_C_SI*(REAL8)LAL_C_SI;
+/*
+ * Eccentric anomaly at mean anomaly phase. If guess is NULL, this is just
+ * XLALComputeEccentricAnomaly(); otherwise the iteration is started from the
+ * previous solution stored in guess, stepped to the new phase to first order,
+ * and the new solution is stored in guess.
+ */
+static REAL8 KeplerSolve( REAL8 phase, REAL8 ecc, KeplerGuess *guess )
+{
+  REAL8 u;
+  if ( guess == NULL ) {
+    XLALComputeEccentricAnomaly( phase, ecc, &u );
+    return u;
+  }
+  if ( ecc == 0.0 ) {
+    /* circular orbit */
+    u = phase;
+  } else {
+    if ( guess->valid ) {
+      /* phases lie in [0, 2pi), so account for wrapping between timestamps */
+      REAL8 dphase = phase - guess->phase;
+      const REAL8 nwrap = round( dphase / LAL_TWOPI );
+      dphase -= LAL_TWOPI*nwrap;
+      u = guess->u + LAL_TWOPI*nwrap + dphase / (1.0 - ecc*cos(guess->u));
+    } else {
+      u = KeplerStart( phase, ecc );
+    }
+    if ( KeplerNewton( phase, ecc, &u ) != 0 ) {
+      XLALComputeEccentricAnomaly( phase, ecc, &u );
+    }
+  }
+  guess->valid = 1;
+  guess->phase = phase;
+  guess->u = u;
+  return u;
+}
 
-  const CHAR *model = PulsarGetStringParam(params, "BINARY");
+/**
+ * Compute the eccentric anomalies \c u for a vector of mean anomalies
+ * \c phase, as returned by XLALComputeEccentricAnomaly().
+ *
+ * If \c useGuess is false, each solution is started from that of the previous
+ * element of \c phase, which for densely-sampled timestamps typically needs
+ * a single Newton-Raphson iteration. If \c useGuess is true, \c u must contain
+ * starting values on input, for example the solutions for a neighbouring
+ * orbital template at the same timestamps. Circular orbits are solved
+ * trivially, and small eccentricities start from the series solution.
+ * The solutions satisfy the same convergence criterion as
+ * XLALComputeEccentricAnomaly(), but need not agree with it to the last bit.
+ */
+int
+XLALComputeEccentricAnomalyVector( REAL8Vector *u,		/**< [in/out] eccentric anomalies (starting values on input if \c useGuess) */
+                                   const REAL8Vector *phase,	/**< [in] mean anomalies */
+                                   const REAL8 ecc,		/**< [in] eccentricity */
+                                   const BOOLEAN useGuess	/**< [in] whether \c u contains starting values */
+                                   )
+{
+  XLAL_CHECK( u != NULL && phase != NULL, XLAL_EFAULT );
+  XLAL_CHECK( u->length == phase->length, XLAL_EBADLEN, "Lengths of u (%u) and phase (%u) differ", u->length, phase->length );
+  XLAL_CHECK( ecc >= 0.0 && ecc < 1.0, XLAL_EDOM, "Invalid eccentricity %g", ecc );
 
-  /* Check input arguments */
-  if( input == (BinaryPulsarInput *)NULL ){
-    XLAL_ERROR_VOID( BINARYPULSARTIMINGH_ENULLINPUT );
+  if ( ecc == 0.0 ) {
+    memcpy( u->data, phase->data, phase->length * sizeof( u->data[0] ) );
+    return XLAL_SUCCESS;
   }
 
-  if( output == (BinaryPulsarOutput *)NULL ){
-    XLAL_ERROR_VOID( BINARYPULSARTIMINGH_ENULLOUTPUT );
+  if ( useGuess ) {
+    for ( UINT4 i = 0; i < phase->length; i++ ) {
+      if ( KeplerNewton( phase->data[i], ecc, &u->data[i] ) != 0 ) {
+        XLALComputeEccentricAnomaly( phase->data[i], ecc, &u->data[i] );
+      }
+    }
+  } else {
+    KeplerGuess guess = { 0, 0, 0 };
+    for ( UINT4 i = 0; i < phase->length; i++ ) {
+      u->data[i] = KeplerSolve( phase->data[i], ecc, &guess );
+    }
   }
 
-  if( params == (PulsarParameters *)NULL ){
-    XLAL_ERROR_VOID( BINARYPULSARTIMINGH_ENULLPARAMS );
-  }
+  return XLAL_SUCCESS;
+}
+
+
+/* read the binary parameters used by XLALBinaryPulsarDeltaTNew() */
+static int BinaryPulsarReadNewParams( BinaryPulsarNewParams *bp, PulsarParameters *params )
+{
+  const CHAR *model = PulsarGetStringParam(params, "BINARY");
 
   if((!strcmp(model, "BT")) &&
      (!strcmp(model, "BT1P")) &&
@@ -961,125 +1072,178 @@ XLALBinaryPulsarDeltaTNew( BinaryPulsarOutput   *output,
      (!strcmp(model, "DDS")) &&
      (!strcmp(model, "MSS")) &&
      (!strcmp(model, "T2"))){
-    XLAL_ERROR_VOID( BINARYPULSARTIMINGH_ENULLBINARYMODEL );
+    return BINARYPULSARTIMINGH_ENULLBINARYMODEL;
   }
 
+  memset( bp, 0, sizeof(*bp) );
+
   /* convert certain params to SI units */
-  w0 = PulsarGetREAL8ParamOrZero(params, "OM");
-  wdot = PulsarGetREAL8ParamOrZero(params, "OMDOT"); /* wdot in rads/s */
+  bp->w0[0] = PulsarGetREAL8ParamOrZero(params, "OM");
+  bp->wdot = PulsarGetREAL8ParamOrZero(params, "OMDOT"); /* wdot in rads/s */
 
-  Pb = PulsarGetREAL8ParamOrZero(params, "PB"); /* period in secs */
-  pbdot = PulsarGetREAL8ParamOrZero(params, "PBDOT");
+  bp->Pb[0] = PulsarGetREAL8ParamOrZero(params, "PB"); /* period in secs */
+  bp->pbdot = PulsarGetREAL8ParamOrZero(params, "PBDOT");
 
-  T0 = PulsarGetREAL8ParamOrZero(params, "T0"); /* these should be in TDB in seconds */
-  Tasc = PulsarGetREAL8ParamOrZero(params, "TASC");
+  bp->T0[0] = PulsarGetREAL8ParamOrZero(params, "T0"); /* these should be in TDB in seconds */
+  bp->Tasc = PulsarGetREAL8ParamOrZero(params, "TASC");
 
-  e = PulsarGetREAL8ParamOrZero(params, "ECC");
-  edot = PulsarGetREAL8ParamOrZero(params, "EDOT");
-  eps1 = PulsarGetREAL8ParamOrZero(params, "EPS1");
-  eps2 = PulsarGetREAL8ParamOrZero(params, "EPS2");
-  eps1dot = PulsarGetREAL8ParamOrZero(params, "EPS1DOT");
-  eps2dot = PulsarGetREAL8ParamOrZero(params, "EPS2DOT");
+  bp->e[0] = PulsarGetREAL8ParamOrZero(params, "ECC");
+  bp->edot = PulsarGetREAL8ParamOrZero(params, "EDOT");
+  bp->eps1 = PulsarGetREAL8ParamOrZero(params, "EPS1");
+  bp->eps2 = PulsarGetREAL8ParamOrZero(params, "EPS2");
+  bp->eps1dot = PulsarGetREAL8ParamOrZero(params, "EPS1DOT");
+  bp->eps2dot = PulsarGetREAL8ParamOrZero(params, "EPS2DOT");
 
-  x = PulsarGetREAL8ParamOrZero(params, "A1");
-  xdot = PulsarGetREAL8ParamOrZero(params, "XDOT");
-  xpbdot = PulsarGetREAL8ParamOrZero(params, "XPBDOT");
+  bp->x[0] = PulsarGetREAL8ParamOrZero(params, "A1");
+  bp->xdot = PulsarGetREAL8ParamOrZero(params, "XDOT");
+  bp->xpbdot = PulsarGetREAL8ParamOrZero(params, "XPBDOT");
 
-  lal_gamma = PulsarGetREAL8ParamOrZero(params, "GAMMA");
-  s = PulsarGetREAL8ParamOrZero(params, "SINI"); /* sin i */
-  dr = PulsarGetREAL8ParamOrZero(params, "DR");
-  dth = PulsarGetREAL8ParamOrZero(params, "DTHETA");
-  shapmax = PulsarGetREAL8ParamOrZero(params, "SHAPMAX");
+  bp->lal_gamma = PulsarGetREAL8ParamOrZero(params, "GAMMA");
+  bp->s = PulsarGetREAL8ParamOrZero(params, "SINI"); /* sin i */
+  bp->dr = PulsarGetREAL8ParamOrZero(params, "DR");
+  bp->dth = PulsarGetREAL8ParamOrZero(params, "DTHETA");
+  bp->shapmax = PulsarGetREAL8ParamOrZero(params, "SHAPMAX");
 
-  a0 = PulsarGetREAL8ParamOrZero(params, "A0");
-  b0 = PulsarGetREAL8ParamOrZero(params, "B0");
+  bp->a0 = PulsarGetREAL8ParamOrZero(params, "A0");
+  bp->b0 = PulsarGetREAL8ParamOrZero(params, "B0");
 
-  m2 = PulsarGetREAL8ParamOrZero(params, "M2");
+  /* Shapiro range parameter r defined as Gm2/c^3 (secs) */
+  const REAL8 c3 = (REAL8)LAL_C_SI*(REAL8)LAL_C_SI*(REAL8)LAL_C_SI;
+  bp->r = LAL_G_SI*PulsarGetREAL8ParamOrZero(params, "M2")/c3;
 
-  pmra = PulsarGetREAL8ParamOrZero(params, "PMRA");
-  pmdec = PulsarGetREAL8ParamOrZero(params, "PMDEC");
+  if ( PulsarCheckParam(params, "FB") ){
+    bp->fb = PulsarGetREAL8VectorParam(params, "FB");
+  }
 
-  /* Shapiro range parameter r defined as Gm2/c^3 (secs) */
-  r = LAL_G_SI*m2/c3;
+  /* compute Kopeikin terms if orbital inclination and proper motion are given */
+  bp->kopeikin = PulsarCheckParam(params, "KIN") && PulsarCheckParam(params, "KOM") &&
+    ( PulsarGetREAL8ParamOrZero(params, "PMRA") != 0. || PulsarGetREAL8ParamOrZero(params, "PMDEC") != 0. );
 
   /* if T0 is not defined, but Tasc is */
-  if(T0 == 0.0 && Tasc != 0.0 && eps1 == 0.0 && eps2 == 0.0){
+  if(bp->T0[0] == 0.0 && bp->Tasc != 0.0 && bp->eps1 == 0.0 && bp->eps2 == 0.0){
     REAL8 fe, uasc, Dt; /* see TEMPO tasc2t0.f */
 
-    fe = sqrt((1.0 - e)/(1.0 + e));
-    uasc = 2.0*atan(fe*tan(w0/2.0));
-    Dt = (Pb/LAL_TWOPI)*(uasc-e*sin(uasc));
+    fe = sqrt((1.0 - bp->e[0])/(1.0 + bp->e[0]));
+    uasc = 2.0*atan(fe*tan(bp->w0[0]/2.0));
+    Dt = (bp->Pb[0]/LAL_TWOPI)*(uasc-bp->e[0]*sin(uasc));
 
-    T0 = Tasc + Dt;
+    bp->T0[0] = bp->Tasc + Dt;
+  }
+
+  /* for BT, BT1P and BT2P models (and BTX model, but only for one orbit) */
+  bp->isBT = (strstr(model, "BT") != NULL);
+  bp->isBTX = !strcmp(model, "BTX");
+  bp->nplanets = 1;
+  if( !strcmp(model, "BT1P") ) bp->nplanets = 2;
+  if( !strcmp(model, "BT2P") ) bp->nplanets = 3;
+  if( bp->isBT && bp->nplanets > 1 ){
+    bp->T0[1] = PulsarGetREAL8ParamOrZero(params, "T0_2");
+    bp->w0[1] = PulsarGetREAL8ParamOrZero(params, "OM_2");
+    bp->x[1] = PulsarGetREAL8ParamOrZero(params, "A1_2");
+    bp->e[1] = PulsarGetREAL8ParamOrZero(params, "ECC_2");
+    bp->Pb[1] = PulsarGetREAL8ParamOrZero(params, "PB_2");
+  }
+  if( bp->isBT && bp->nplanets > 2 ){
+    bp->T0[2] = PulsarGetREAL8ParamOrZero(params, "T0_3");
+    bp->w0[2] = PulsarGetREAL8ParamOrZero(params, "OM_3");
+    bp->x[2] = PulsarGetREAL8ParamOrZero(params, "A1_3");
+    bp->e[2] = PulsarGetREAL8ParamOrZero(params, "ECC_3");
+    bp->Pb[2] = PulsarGetREAL8ParamOrZero(params, "PB_3");
+  }
+
+  /* for ELL1 model, or T2 model if eps values are set */
+  bp->isELL1 = ( !strcmp(model, "ELL1") || (!strcmp(model, "T2") && bp->eps1 != 0. ) );
+  if( bp->isELL1 ){
+    /* if Tasc is not defined convert T0 */
+    if(bp->Tasc == 0.0 && bp->T0[0] != 0.0){
+      REAL8 fe, uasc, Dt; /* see TEMPO tasc2t0.f */
+      REAL8 ecc = sqrt(bp->eps1*bp->eps1 + bp->eps2*bp->eps2);
+
+      fe = sqrt((1.0 - ecc)/(1.0 + ecc));
+      uasc = 2.0*atan(fe*tan(bp->w0[0]/2.0));
+      Dt = (bp->Pb[0]/LAL_TWOPI)*(uasc-ecc*sin(uasc));
+
+      /* rearrange from what's in tasc2t0.f */
+      bp->Tasc = bp->T0[0] - Dt;
+    }
+
+    /* set period from first orbital frequency value */
+    if( bp->fb != NULL ){
+      bp->Pb[0] = 1./bp->fb->data[0];
+    }
+  }
+
+  /* for DD, MSS, DDS models, or T2 model if eps values are not set */
+  bp->isDDmodel = !strcmp(model, "DD");
+  bp->isMSS = !strcmp(model, "MSS");
+  bp->isDDS = !strcmp(model, "DDS");
+  bp->isDD = ( bp->isDDmodel || bp->isMSS || bp->isDDS || (!strcmp(model, "T2") && bp->eps1 == 0.) );
+
+  /* following DDmodel.C from TEMPO2 just set dth, dr, a0 and b0 to 0 */
+  if ( bp->isDDmodel ){
+    bp->dr = 0.;
+    bp->dth = 0.;
+    bp->a0 = 0.;
+    bp->b0 = 0.;
   }
 
+  return XLAL_SUCCESS;
+}
+
+
+/*
+ * Compute the binary delay given the parameters read by
+ * BinaryPulsarReadNewParams(). deltaT is left unchanged if the model is not
+ * recognised. If guess is not NULL, it must have length 3, and holds starting
+ * values for Kepler's equation which are updated on return.
+ */
+static void BinaryPulsarDeltaTNewCore( REAL8 *deltaT,
+                                       const BinaryPulsarNewParams *bp,
+                                       BinaryPulsarInput *input,
+                                       PulsarParameters *params,
+                                       KeplerGuess *guess )
+{
   /* set time at which to calculate the binary time delay */
-  tb = input->tb;
+  const REAL8 tb = input->tb;
 
   /* for BT, BT1P and BT2P models (and BTX model, but only for one orbit) */
-  if(strstr(model, "BT") != NULL){
+  if( bp->isBT ){
+    REAL8 dt=0.;
     REAL8 tt0;
     REAL8 orbits=0.;
     INT4 norbits=0;
     REAL8 phase; /* same as mean anomaly */
     REAL8 u = 0.0; /* eccentric anomaly */
+    REAL8 x, e, w=0, Pb;
 
-    INT4 nplanets=1; /* number of orbiting bodies in system */
     INT4 i=1, j=1;
     REAL8 fac=1.; /* factor in front of fb coefficients */
 
     REAL8 su = 0., cu = 0.;
     REAL8 sw = 0., cw = 0.;
 
-    /* work out number of orbits i.e. have we got a BT1P or BT2P model */
-    if( !strcmp(model, "BT1P") ) nplanets = 2;
-    if( !strcmp(model, "BT2P") ) nplanets = 3;
-
-    for ( i=1 ; i < nplanets+1 ; i++){
-
-      /* set some vars for bnrybt.f (TEMPO) method */
-      /*REAL8 tt;
-      REAL8 som;
-      REAL8 com;
-      REAL8 alpha, beta;*/
-      /*REAL8 q, r, s;*/
-
-      /*fprintf(stderr, "You are using the Blandford-Teukolsky (BT) binary model.\n");*/
-
-      if(i==2){
-        T0 = PulsarGetREAL8ParamOrZero(params, "T0_2");
-        w0 = PulsarGetREAL8ParamOrZero(params, "OM_2");
-        x = PulsarGetREAL8ParamOrZero(params, "A1_2");
-        e = PulsarGetREAL8ParamOrZero(params, "ECC_2");
-        Pb = PulsarGetREAL8ParamOrZero(params, "PB_2");
-      }
-      else if(i==3){
-        T0 = PulsarGetREAL8ParamOrZero(params, "T0_3");
-        w0 = PulsarGetREAL8ParamOrZero(params, "OM_3");
-        x = PulsarGetREAL8ParamOrZero(params, "A1_3");
-        e = PulsarGetREAL8ParamOrZero(params, "ECC_3");
-        Pb = PulsarGetREAL8ParamOrZero(params, "PB_3");
-      }
+    for ( i=1 ; i < bp->nplanets+1 ; i++){
+      x = bp->x[i-1];
+      e = bp->e[i-1];
+      Pb = bp->Pb[i-1];
 
-      tt0 = tb - T0;
+      tt0 = tb - bp->T0[i-1];
 
       /* only do relativistic corrections for first orbit */
       if(i==1){
-        x = x + xdot*tt0;
-        e = e + edot*tt0;
-        w = w0 + wdot*tt0; /* calculate w */
-
-        if( !strcmp(model, "BTX") && PulsarCheckParam(params, "FB") ){
-          const REAL8Vector *fb = PulsarGetREAL8VectorParam(params, "FB");
+        x = x + bp->xdot*tt0;
+        e = e + bp->edot*tt0;
+        w = bp->w0[0] + bp->wdot*tt0; /* calculate w */
 
+        if( bp->isBTX && bp->fb != NULL ){
           fac = 1.;
-          for ( j=1 ; j < (INT4)fb->length + 1; j++){
+          for ( j=1 ; j < (INT4)bp->fb->length + 1; j++){
             fac /= (REAL8)j;
-            orbits += fac*fb->data[j-1]*pow(tt0,j);
+            orbits += fac*bp->fb->data[j-1]*pow(tt0,j);
           }
         }
         else{
-          orbits = tt0/Pb - 0.5*(pbdot+xpbdot)*(tt0/Pb)*(tt0/Pb);
+          orbits = tt0/Pb - 0.5*(bp->pbdot+bp->xpbdot)*(tt0/Pb)*(tt0/Pb);
         }
       }
       else{
@@ -1093,68 +1257,48 @@ XLALBinaryPulsarDeltaTNew( BinaryPulsarOutput   *output,
       phase = LAL_TWOPI*(orbits - (REAL8)norbits); /* called phase in TEMPO */
 
       /* compute eccentric anomaly */
-      XLALComputeEccentricAnomaly( phase, e, &u );
+      u = KeplerSolve( phase, e, guess == NULL ? NULL : &guess[i-1] );
 
       su = sin(u);
       cu = cos(u);
 
-      /*fprintf(stderr, "Eccentric anomaly = %f, phase = %f.\n", u, phase);*/
       sw = sin(w);
       cw = cos(w);
 
       /* see eq 5 of Taylor and Weisberg (1989) */
       /**********************************************************/
-      if( !strcmp(model, "BTX") ){
+      if( bp->isBTX ){
         REAL8 fb0 = 0.;
-        if ( PulsarCheckParam(params, "FB") ){
-          const REAL8Vector *fb = PulsarGetREAL8VectorParam(params, "FB");
-          fb0 = fb->data[0];
+        if ( bp->fb != NULL ){
+          fb0 = bp->fb->data[0];
         }
-        /* dt += (x*sin(w)*(cos(u)-e) + (x*cos(w)*sqrt(1.0-e*e) +
-          lal_gamma)*sin(u))*(1.0 - params->fb[0]*(x*cos(w)*sqrt(1.0 -
-          e*e)*cos(u) - x*sin(w)*sin(u))/(1.0 - e*cos(u))); */
         dt += (x*sw*(cu-e) + (x*cw*sqrt(1.0-e*e) +
-          lal_gamma)*su)*(1.0 - LAL_TWOPI*fb0*(x*cw*sqrt(1.0 -
+          bp->lal_gamma)*su)*(1.0 - LAL_TWOPI*fb0*(x*cw*sqrt(1.0 -
           e*e)*cu - x*sw*su)/(1.0 - e*cu));
       }
       else{
-          /* dt += (x*sin(w)*(cos(u)-e) + (x*cos(w)*sqrt(1.0-e*e) +
-            lal_gamma)*sin(u))*(1.0 - (LAL_TWOPI/Pb)*(x*cos(w)*sqrt(1.0 -
-            e*e)*cos(u) - x*sin(w)*sin(u))/(1.0 - e*cos(u))); */
           dt += (x*sw*(cu-e) + (x*cw*sqrt(1.0-e*e) +
-            lal_gamma)*su)*(1.0 - (LAL_TWOPI/Pb)*(x*cw*sqrt(1.0 -
+            bp->lal_gamma)*su)*(1.0 - (LAL_TWOPI/Pb)*(x*cw*sqrt(1.0 -
             e*e)*cu - x*sw*su)/(1.0 - e*cu));
       }
     /**********************************************************/
     }
 
-    /* use method from Taylor etal 1976 ApJ Lett and used in bnrybt.f */
-    /**********************************************************/
-    /*tt = 1.0-e*e;
-    som = sin(w);
-    com = cos(w);
-    alpha = x*som;
-    beta = x*com*sqrt(tt);
-    q = alpha*(cos(u)-e) + (beta+lal_gamma)*sin(u);
-    r = -alpha*sin(u) + beta*cos(u);
-    s = 1.0/(1.0-e*cos(u));
-    dt = -(-q+(LAL_TWOPI/Pb)*q*r*s);*/
-    /**********************************************************/
-    /* There appears to be NO difference between either method */
-
-    output->deltaT = -dt;
+    *deltaT = -dt;
   }
 
   /* for ELL1 model (low eccentricity orbits so use eps1 and eps2) */
   /* see Appendix A, Ch. Lange etal, MNRAS (2001) (also accept T2 model if
    eps values are set - this will include Kopeikin terms if necessary) */
-  if( !strcmp(model, "ELL1") || (!strcmp(model, "T2") && eps1 != 0. ) ){
+  if( bp->isELL1 ){
     REAL8 nb;
     REAL8 tt0;
     REAL8 w_int; /* omega internal to this model */
     REAL8 orbits, phase;
     INT4 norbits;
     REAL8 e1, e2, ecc;
+    REAL8 x;
+    const REAL8 Pb = bp->Pb[0];
     REAL8 DRE, DREp, DREpp; /* Roemer and Einstein delays (cf DD) */
     REAL8 dlogbr;
     REAL8 DS, DA; /* Shapiro delay and Abberation delay terms */
@@ -1167,43 +1311,23 @@ XLALBinaryPulsarDeltaTNew( BinaryPulsarOutput   *output,
 
     REAL8 sp = 0., cp = 0., s2p = 0., c2p = 0.;
 
-    /* fprintf(stderr, "You are using the ELL1 low eccentricity orbit model.\n");*/
-
     /*********************************************************/
     /* CORRECT CODE (as in TEMPO bnryell1.f) FROM HERE       */
 
-    ecc = sqrt(eps1*eps1 + eps2*eps2);
-
-    /* if Tasc is not defined convert T0 */
-    if(Tasc == 0.0 && T0 != 0.0){
-      REAL8 fe, uasc, Dt; /* see TEMPO tasc2t0.f */
-
-      fe = sqrt((1.0 - ecc)/(1.0 + ecc));
-      uasc = 2.0*atan(fe*tan(w0/2.0));
-      Dt = (Pb/LAL_TWOPI)*(uasc-ecc*sin(uasc));
-
-      /* rearrange from what's in tasc2t0.f */
-      Tasc = T0 - Dt;
-    }
-
-    tt0 = tb - Tasc;
+    tt0 = tb - bp->Tasc;
 
     /* handle higher orbital frequency derivatives if present */
-    if( PulsarCheckParam(params, "FB") ){
-      const REAL8Vector *fb = PulsarGetREAL8VectorParam(params, "FB");
-
-      /* set period from first orbital frequency value */
-      Pb = 1./fb->data[0];
+    if( bp->fb != NULL ){
       orbits = tt0/Pb;
 
       fac = 1.;
-      for ( UINT4 j=1 ; j < fb->length; j++){
+      for ( UINT4 j=1 ; j < bp->fb->length; j++){
         fac /= (REAL8)(j+1);
-        orbits += fac*fb->data[j]*pow(tt0,j+1);
+        orbits += fac*bp->fb->data[j]*pow(tt0,j+1);
       }
     }
     else{
-      orbits = tt0/Pb - 0.5*(pbdot+xpbdot)*(tt0/Pb)*(tt0/Pb);
+      orbits = tt0/Pb - 0.5*(bp->pbdot+bp->xpbdot)*(tt0/Pb)*(tt0/Pb);
     }
 
     nb = LAL_TWOPI/Pb;
@@ -1213,45 +1337,40 @@ XLALBinaryPulsarDeltaTNew( BinaryPulsarOutput   *output,
 
     phase=LAL_TWOPI*(orbits - (REAL8)norbits);
 
-    x = x + xdot*tt0;
+    x = bp->x[0] + bp->xdot*tt0;
 
     /* depending on whether we have eps derivs or w time derivs calculate e1 and e2 accordingly */
-    if( eps1dot != 0. || eps2dot != 0. ){
-      e1 = eps1 + eps1dot*tt0;
-      e2 = eps2 + eps2dot*tt0;
+    if( bp->eps1dot != 0. || bp->eps2dot != 0. ){
+      e1 = bp->eps1 + bp->eps1dot*tt0;
+      e2 = bp->eps2 + bp->eps2dot*tt0;
     }
     else{
-      ecc = sqrt(eps1*eps1 + eps2*eps2);
-      ecc += edot*tt0;
-      w_int = atan2(eps1, eps2);
-      w_int = w_int + wdot*tt0;
+      ecc = sqrt(bp->eps1*bp->eps1 + bp->eps2*bp->eps2);
+      ecc += bp->edot*tt0;
+      w_int = atan2(bp->eps1, bp->eps2);
+      w_int = w_int + bp->wdot*tt0;
 
       e1 = ecc*sin(w_int);
       e2 = ecc*cos(w_int);
     }
 
-    //sin_cos_LUT(&sp, &cp, phase);
-    //sin_cos_LUT(&s2p, &c2p, 2.*phase);
     sp = sin(phase);
     cp = cos(phase);
     s2p = sin(2.*phase);
     c2p = cos(2.*phase);
 
     /* this timing delay (Roemer + Einstein) should be most important in most cases */
-    /* DRE = x*(sin(phase)-0.5*(e1*cos(2.0*phase)-e2*sin(2.0*phase)));
-    DREp = x*cos(phase);
-    DREpp = -x*sin(phase); */
     DRE = x*(sp-0.5*(e1*c2p-e2*s2p));
     DREp = x*cp;
     DREpp = -x*sp;
 
     /* these params will normally be negligable */
-    dlogbr = log(1.0-s*sp);
-    DS = -2.0*r*dlogbr;
-    DA = a0*sp + b0*cp;
+    dlogbr = log(1.0-bp->s*sp);
+    DS = -2.0*bp->r*dlogbr;
+    DA = bp->a0*sp + bp->b0*cp;
 
     /* compute Kopeikin terms */
-    if( PulsarCheckParam(params, "KIN") && PulsarCheckParam(params, "KOM") && ( pmra != 0. || pmdec != 0. ) ){
+    if( bp->kopeikin ){
       XLALComputeKopeikinTermsNew( &kt, params, input );
 
       Ck = sp - 0.5*(e1*c2p - e2*s2p);
@@ -1268,7 +1387,7 @@ XLALBinaryPulsarDeltaTNew( BinaryPulsarOutput   *output,
     Dbb = DRE*(1.0-nb*DREp+(nb*DREp)*(nb*DREp) + 0.5*nb*nb*DRE*DREpp) + DS + DA
       + DAOP + DSR;
 
-    output->deltaT = -Dbb;
+    *deltaT = -Dbb;
     /********************************************************/
   }
 
@@ -1276,7 +1395,7 @@ XLALBinaryPulsarDeltaTNew( BinaryPulsarOutput   *output,
   /* also used for MSS model (Wex 1998) - main sequence star orbit - this only has two lines
 different than DD model - TEMPO bnrymss.f */
   /* also DDS model and (partial) T2 model (if EPS params not set) from TEMPO2 T2model.C */
-  if( !strcmp(model, "DD") || !strcmp(model, "MSS") || !strcmp(model, "DDS") || (!strcmp(model, "T2") && eps1 == 0.) ){
+  if( bp->isDD ){
     REAL8 u;        /* new eccentric anomaly */
     REAL8 Ae;       /* eccentricity parameter */
     REAL8 DRE;      /* Roemer delay + Einstein delay */
@@ -1294,6 +1413,8 @@ different than DD model - TEMPO bnrymss.f */
     REAL8 alpha, beta, bg;
     REAL8 anhat, sqr1me2, cume, brace, dlogbr;
     REAL8 Dbb;    /* Delta barbar in DD eq 52 */
+    REAL8 x, e, w;
+    const REAL8 Pb = bp->Pb[0];
 
     REAL8 xi; /* parameter for MSS model - the only other one needed */
     REAL8 sdds = 0.; /* parameter for DDS model */
@@ -1304,29 +1425,18 @@ different than DD model - TEMPO bnrymss.f */
     KopeikinTerms kt;
     REAL8 Ck, Sk;
 
-    /* fprintf(stderr, "You are using the Damour-Deruelle (DD) binary model.\n");*/
-
     /* part of code adapted from TEMPO bnrydd.f */
     an = LAL_TWOPI/Pb;
-    k = wdot/an;
-    xi = xdot/an; /* MSS parameter */
-
-    tt0 = tb - T0;
-    /* x = x + xdot*tt0; */
+    k = bp->wdot/an;
+    xi = bp->xdot/an; /* MSS parameter */
 
-    /* following DDmodel.C from TEMPO2 just set dth, dr, a0 and b0 to 0 */
-    if ( !strcmp(model, "DD") ){
-      dr = 0.;
-      dth = 0.;
-      a0 = 0.;
-      b0 = 0.;
-    }
+    tt0 = tb - bp->T0[0];
 
-    e = e + edot*tt0;
-    er = e*(1.0+dr);
-    eth = e*(1.0+dth);
+    e = bp->e[0] + bp->edot*tt0;
+    er = e*(1.0+bp->dr);
+    eth = e*(1.0+bp->dth);
 
-    orbits = (tt0/Pb) - 0.5*(pbdot+xpbdot)*(tt0/Pb)*(tt0/Pb);
+    orbits = (tt0/Pb) - 0.5*(bp->pbdot+bp->xpbdot)*(tt0/Pb)*(tt0/Pb);
     norbits = (INT4)orbits;
 
     if(orbits < 0.0) norbits--;
@@ -1334,7 +1444,7 @@ different than DD model - TEMPO bnrymss.f */
     phase = LAL_TWOPI*(orbits - (REAL8)norbits);
 
     /* compute eccentric anomaly */
-    XLALComputeEccentricAnomaly( phase, e, &u );
+    u = KeplerSolve( phase, e, guess );
 
     su = sin(u);
     cu = cos(u);
@@ -1351,15 +1461,15 @@ different than DD model - TEMPO bnrymss.f */
 
     Ae = LAL_TWOPI*orbits + Ae - phase;
 
-    w = w0 + k*Ae; /* add corrections to omega */ /* MSS also uses (om2dot, but not defined) */
+    w = bp->w0[0] + k*Ae; /* add corrections to omega */ /* MSS also uses (om2dot, but not defined) */
 
     /* small difference between MSS and DD */
-    if( !strcmp(model, "MSS") ){
-      x = x + xi*Ae; /* in bnrymss.f they also include a second time derivative of x (x2dot), but
+    if( bp->isMSS ){
+      x = bp->x[0] + xi*Ae; /* in bnrymss.f they also include a second time derivative of x (x2dot), but
 this isn't defined for either of the two pulsars currently using this model */
     }
     else
-      x = x + xdot*tt0;
+      x = bp->x[0] + bp->xdot*tt0;
 
     /* now compute time delays as in DD eqs 46 - 52 */
 
@@ -1368,7 +1478,7 @@ this isn't defined for either of the two pulsars currently using this model */
     cw = cos(w);
     alpha = x*sw;
     beta = x*sqrt(1.0-eth*eth)*cw;
-    bg = beta + lal_gamma;
+    bg = beta + bp->lal_gamma;
     DRE = alpha*(cu-er)+bg*su;
     DREp = -alpha*su + bg*cu;
     DREpp = -alpha*cu - bg*su;
@@ -1377,19 +1487,19 @@ this isn't defined for either of the two pulsars currently using this model */
     /* calculate Shapiro and abberation delays DD eqs 26, 27 */
     sqr1me2 = sqrt(1.0-e*e);
     cume = cu-e;
-    if( !strcmp(model, "DDS") ){
-      sdds = 1. - exp(-1.*shapmax);
+    if( bp->isDDS ){
+      sdds = 1. - exp(-1.*bp->shapmax);
       brace = onemecu-sdds*(sw*cume + sqr1me2*cw*su);
     }
-    else brace = onemecu-s*(sw*cume + sqr1me2*cw*su);
+    else brace = onemecu-bp->s*(sw*cume + sqr1me2*cw*su);
     dlogbr = log(brace);
-    DS = -2.0*r*dlogbr;
+    DS = -2.0*bp->r*dlogbr;
 
     /* this abberation delay is prob fairly small */
-    DA = a0*(sin(w+Ae)+e*sw) + b0*(cos(w+Ae)+e*cw);
+    DA = bp->a0*(sin(w+Ae)+e*sw) + bp->b0*(cos(w+Ae)+e*cw);
 
     /* compute Kopeikin terms */
-    if( PulsarCheckParam(params, "KIN") && PulsarCheckParam(params, "KOM") && ( pmra != 0. || pmdec != 0. ) ){
+    if( bp->kopeikin ){
       XLALComputeKopeikinTermsNew( &kt, params, input );
 
       Ck = cw*(cu-er) - sqrt(1.-eth*eth)*sw*su;
@@ -1407,12 +1517,40 @@ this isn't defined for either of the two pulsars currently using this model */
     Dbb = DRE*(1.0 - anhat*DREp+anhat*anhat*DREp*DREp + 0.5*anhat*anhat*DRE*DREpp -
           0.5*e*su*anhat*anhat*DRE*DREp/onemecu) + DS + DA + DAOP + DSR;
 
-    output->deltaT = -Dbb;
+    *deltaT = -Dbb;
   }
 
   /* for DDGR model */
 
   /* for Epstein-Haugan (EH) model - see Haugan, ApJ (1985) eqs 69 and 71 */
+}
+
+
+void
+XLALBinaryPulsarDeltaTNew( BinaryPulsarOutput   *output,
+                           BinaryPulsarInput    *input,
+                           PulsarParameters     *params )
+{
+  BinaryPulsarNewParams bp;
+
+  /* Check input arguments */
+  if( input == (BinaryPulsarInput *)NULL ){
+    XLAL_ERROR_VOID( BINARYPULSARTIMINGH_ENULLINPUT );
+  }
+
+  if( output == (BinaryPulsarOutput *)NULL ){
+    XLAL_ERROR_VOID( BINARYPULSARTIMINGH_ENULLOUTPUT );
+  }
+
+  if( params == (PulsarParameters *)NULL ){
+    XLAL_ERROR_VOID( BINARYPULSARTIMINGH_ENULLPARAMS );
+  }
+
+  if( BinaryPulsarReadNewParams( &bp, params ) != XLAL_SUCCESS ){
+    XLAL_ERROR_VOID( BINARYPULSARTIMINGH_ENULLBINARYMODEL );
+  }
+
+  BinaryPulsarDeltaTNewCore( &output->deltaT, &bp, input, params, NULL );
 
   /* check that the returned value is not a NaN */
   if( isnan(output->deltaT) ){
@@ -1421,3 +1559,47 @@ this isn't defined for either of the two pulsars currently using this model */
 
 }
 
+
+/**
+ * Compute the binary system delays of XLALBinaryPulsarDeltaTNew() for a vector
+ * of times of arrival at the SSB.
+ *
+ * The binary parameters are read from \c params only once, and each solution
+ * of Kepler's equation is started from that of the previous timestamp, as in
+ * XLALComputeEccentricAnomalyVector(); timestamps should therefore be ordered
+ * for best performance. The delays agree with those of
+ * XLALBinaryPulsarDeltaTNew() to within the accuracy of Kepler's equation.
+ *
+ * The Earth states \c earth are only used for the Kopeikin terms, and may be
+ * \c NULL if these are not required by \c params.
+ */
+int
+XLALBinaryPulsarDeltaTNewVector( REAL8Vector *deltaT,		/**< [out] binary delays, of same length as \c tb */
+                                 const REAL8Vector *tb,		/**< [in] times of arrival at the SSB */
+                                 const EarthState *earth,	/**< [in] Earth states at each time, or \c NULL */
+                                 PulsarParameters *params	/**< [in] pulsar parameters */
+                                 )
+{
+  XLAL_CHECK( deltaT != NULL && tb != NULL && params != NULL, XLAL_EFAULT );
+  XLAL_CHECK( deltaT->length == tb->length, XLAL_EBADLEN, "Lengths of deltaT (%u) and tb (%u) differ", deltaT->length, tb->length );
+
+  BinaryPulsarNewParams bp;
+  XLAL_CHECK( BinaryPulsarReadNewParams( &bp, params ) == XLAL_SUCCESS && ( bp.isBT || bp.isELL1 || bp.isDD ), XLAL_EINVAL, "Invalid binary model" );
+  XLAL_CHECK( earth != NULL || !bp.kopeikin, XLAL_EFAULT, "Earth states are required to compute Kopeikin terms" );
+
+  KeplerGuess guess[3];
+  memset( guess, 0, sizeof(guess) );
+
+  BinaryPulsarInput input;
+  memset( &input, 0, sizeof(input) );
+  for ( UINT4 i = 0; i < tb->length; i++ ) {
+    input.tb = tb->data[i];
+    if ( earth != NULL ) {
+      input.earth = earth[i];
+    }
+    BinaryPulsarDeltaTNewCore( &deltaT->data[i], &bp, &input, params, guess );
+    XLAL_CHECK( !isnan(deltaT->data[i]), XLAL_EFPINVAL, "Binary delay at tb=%.9f is NaN", tb->data[i] );
+  }
+
+  return XLAL_SUCCESS;
+}
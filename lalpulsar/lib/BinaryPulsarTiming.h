@@ -131,6 +131,9 @@ tagBinaryPulsarOutput
 void
 XLALComputeEccentricAnomaly( REAL8 phase, REAL8 ecc, REAL8 *u);
 
+int
+XLALComputeEccentricAnomalyVector( REAL8Vector *u, const REAL8Vector *phase, const REAL8 ecc, const BOOLEAN useGuess );
+
 /**
  * \brief This function will compute the effect of binary parameters on the
  * pulsar parallax
@@ -163,6 +166,15 @@ XLALBinaryPulsarDeltaTNew( BinaryPulsarOutput   *output,
                            BinaryPulsarInput    *input,
                            PulsarParameters     *params );
 
+/**
+ * function to calculate the binary system delay for a vector of times, using new parameter structure
+ */
+int
+XLALBinaryPulsarDeltaTNewVector( REAL8Vector *deltaT,
+                                 const REAL8Vector *tb,
+                                 const EarthState *earth,
+                                 PulsarParameters *params );
+
 void
 LALBinaryPulsarDeltaT( LALStatus            *status,
                        BinaryPulsarOutput   *output,
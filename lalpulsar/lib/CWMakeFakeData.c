@@ -45,8 +45,12 @@
 #include <lal/FFTWMutex.h>
 #include <lal/ExtrapolatePulsarSpins.h>
 #include <lal/ConfigFile.h>
+#include <lal/SSBtimes.h>
+#include <lal/LALComputeAM.h>
+#include <lal/SinCosLUT.h>
 
 // ---------- local defines
+#define FAST_INJECTION_DT 60.0	// spacing [s] of the coarse timing/antenna-pattern grid used for direct signal synthesis
 
 // ---------- local macro definitions
 #define SQ(x) ( (x) * (x) )
@@ -74,6 +78,7 @@ const char *const InjectionSourcesHelpString = "Source parameters to inject for
 
 // ---------- local prototypes
 static UINT4 gcd (UINT4 numer, UINT4 denom);
+static int XLALAddCWSignalsDirect ( REAL4TimeSeries *Tseries, const PulsarParamsVector *injectionSources, const UINT4 *injIndex, UINT4 numInj, const LALDetector *site, const EphemerisData *edat );
 int XLALcorrect_phase ( SFTtype *sft, LIGOTimeGPS tHeterodyne );
 int XLALCheckConfigFileWasFullyParsed ( const char *fname, const LALParsedDataFile *cfgdata );
 
@@ -280,6 +285,12 @@ XLALCWMakeFakeData ( SFTVector **SFTvect,
 
   // add CW signals, if any
   UINT4 numPulsars = injectionSources ? injectionSources->length : 0;
+  // isolated signals to be synthesised directly, batched by sky-position, if requested
+  UINT4 *directIndex = NULL;
+  UINT4 numDirect = 0;
+  if ( dataParams->fastInjection && ( numPulsars > 0 ) ) {
+    XLAL_CHECK ( (directIndex = XLALCalloc ( numPulsars, sizeof(directIndex[0]) )) != NULL, XLAL_ENOMEM );
+  }
   for ( UINT4 iInj = 0; iInj < numPulsars; iInj ++ )
     {
       // truncate any transient-CW timeseries to the actual support of the transient signal,
@@ -326,7 +337,11 @@ XLALCWMakeFakeData ( SFTVector **SFTvect,
 
       REAL8 signalDuration = XLALGPSDiff ( &signalEndGPS, &signalStartGPS );
       XLAL_CHECK ( signalDuration >= 0, XLAL_EFAILED, "Something went wrong, got negative signal duration = %g\n", signalDuration );
-      if ( signalDuration > 0 )	// only need to do sth if transient-window had finite overlap with output TS
+      if ( ( signalDuration > 0 ) && ( directIndex != NULL ) && ( pulsarParams->Doppler.asini == 0 ) )
+        {
+          directIndex[numDirect++] = iInj;	// defer to direct synthesis below
+        }
+      else if ( signalDuration > 0 )	// only need to do sth if transient-window had finite overlap with output TS
         {
           REAL4TimeSeries *Tseries_i = NULL;
           XLAL_CHECK ( (Tseries_i = XLALGenerateCWSignalTS ( pulsarParams, site, signalStartGPS, signalDuration, fSamp, fMin, edat, dataParams->sourceDeltaT )) != NULL, XLAL_EFUNC );
@@ -343,6 +358,32 @@ XLALCWMakeFakeData ( SFTVector **SFTvect,
         }
     } // for iInj < numSources
 
+  // directly synthesise all deferred isolated signals, one batch per distinct sky-position
+  if ( numDirect > 0 )
+    {
+      UINT4 *batchIndex;
+      XLAL_CHECK ( (batchIndex = XLALCalloc ( numDirect, sizeof(batchIndex[0]) )) != NULL, XLAL_ENOMEM );
+      UINT4 numLeft = numDirect;
+      while ( numLeft > 0 )
+        {
+          const PulsarDopplerParams *dop0 = &injectionSources->data[directIndex[0]].Doppler;
+          UINT4 numBatch = 0, numRest = 0;
+          for ( UINT4 l = 0; l < numLeft; l ++ )
+            {
+              const PulsarDopplerParams *dop = &injectionSources->data[directIndex[l]].Doppler;
+              if ( ( dop->Alpha == dop0->Alpha ) && ( dop->Delta == dop0->Delta ) ) {
+                batchIndex[numBatch++] = directIndex[l];
+              } else {
+                directIndex[numRest++] = directIndex[l];
+              }
+            } // for l < numLeft
+          XLAL_CHECK ( XLALAddCWSignalsDirect ( Tseries_sum, injectionSources, batchIndex, numBatch, site, edat ) == XLAL_SUCCESS, XLAL_EFUNC );
+          numLeft = numRest;
+        } // while numLeft > 0
+      XLALFree ( batchIndex );
+    } // if numDirect > 0
+  XLALFree ( directIndex );
+
   /* add Gaussian noise if requested */
   REAL8 sqrtSn = dataParams->multiNoiseFloor.sqrtSn[detectorIndex];
   if ( sqrtSn > 0)
@@ -496,6 +537,209 @@ XLALGenerateCWSignalTS ( const PulsarParams *pulsarParams,	///< input CW pulsar-
 } // XLALGenerateCWSignalTS()
 
 
+/**
+ * Add a batch of isolated CW signals sharing the same sky-position directly into the
+ * (heterodyned) timeseries \a Tseries, without going through XLALGeneratePulsarSignal().
+ *
+ * SSB timing and antenna-pattern coefficients are computed only once for the whole batch,
+ * on a coarse grid of spacing #FAST_INJECTION_DT, and are interpolated to the timeseries
+ * samples (cubic Hermite interpolation for the SSB delay, using its time-derivative, and
+ * linear interpolation for the antenna patterns). Each signal is then synthesised directly
+ * at the (low) timeseries sampling rate, with the heterodyne phase \f$2\pi f_{\mathrm{het}}(t - t_{\mathrm{epoch}})\f$
+ * removed analytically, and its transient window (if any) applied on the fly.
+ */
+static int
+XLALAddCWSignalsDirect ( REAL4TimeSeries *Tseries,			///< [in/out] heterodyned timeseries to add signals to
+                         const PulsarParamsVector *injectionSources,	///< [in] all injection sources
+                         const UINT4 *injIndex,				///< [in] indices of the isolated sources in this batch
+                         UINT4 numInj,					///< [in] number of sources in this batch
+                         const LALDetector *site,			///< [in] detector
+                         const EphemerisData *edat			///< [in] ephemeris data
+                         )
+{
+  XLAL_CHECK ( Tseries != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( injectionSources != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( injIndex != NULL && numInj > 0, XLAL_EINVAL );
+  XLAL_CHECK ( site != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( edat != NULL, XLAL_EINVAL );
+
+  const LIGOTimeGPS epoch = Tseries->epoch;
+  const REAL8 dt = Tseries->deltaT;
+  const REAL8 fHet = Tseries->f0;
+  const UINT4 numSamples = Tseries->data->length;
+  REAL4 *data = Tseries->data->data;
+
+  // ----- coarse grid of timing and antenna-pattern nodes, covering the full timeseries
+  const REAL8 dtc = FAST_INJECTION_DT;
+  const UINT4 numNodes = (UINT4) floor ( numSamples * dt / dtc ) + 2;
+  LIGOTimeGPSVector *nodes;
+  XLAL_CHECK ( (nodes = XLALCreateTimestampVector ( numNodes )) != NULL, XLAL_EFUNC );
+  nodes->deltaT = dtc;
+  for ( UINT4 k = 0; k < numNodes; k ++ )
+    {
+      nodes->data[k] = epoch;
+      XLALGPSAdd ( &nodes->data[k], k * dtc );
+    }
+  DetectorStateSeries *detStates;
+  XLAL_CHECK ( (detStates = XLALGetDetectorStates ( nodes, site, edat, 0 )) != NULL, XLAL_EFUNC );
+  XLALDestroyTimestampVector ( nodes );
+
+  SkyPosition XLAL_INIT_DECL(skypos);
+  skypos.system    = COORDINATESYSTEM_EQUATORIAL;
+  skypos.longitude = injectionSources->data[injIndex[0]].Doppler.Alpha;
+  skypos.latitude  = injectionSources->data[injIndex[0]].Doppler.Delta;
+
+  SSBtimes *tSSB;
+  XLAL_CHECK ( (tSSB = XLALGetSSBtimes ( detStates, skypos, epoch, SSBPREC_RELATIVISTICOPT )) != NULL, XLAL_EFUNC );
+  AMCoeffs *amcoe;
+  XLAL_CHECK ( (amcoe = XLALComputeAMCoeffs ( detStates, skypos )) != NULL, XLAL_EFUNC );
+  XLALDestroyDetectorStateSeries ( detStates );
+
+  // ----- per-signal parameters: spins and phase at the timeseries epoch, amplitudes, window support
+  typedef struct {
+    PulsarSpins fkdot;		// spins at SSB time 'epoch'
+    PulsarSpins spinCoef;	// Taylor coefficients fkdot[s] / (s+1)! of the phase
+    REAL8 phi0cycles;		// initial phase at 'epoch', in cycles
+    REAL8 Apa, Apb, Axa, Axb;	// amplitude factors multiplying a*cos, b*cos, a*sin, b*sin
+    UINT4 i0, i1;		// sample range [i0, i1) of the transient-window support
+    transientWindow_t window;
+    UINT4 t0, t1;
+  } DirectSignal;
+  DirectSignal *sig;
+  XLAL_CHECK ( (sig = XLALCalloc ( numInj, sizeof(sig[0]) )) != NULL, XLAL_ENOMEM );
+
+  const REAL8 epoch_REAL8 = XLALGPSGetREAL8 ( &epoch );
+  UINT4 maxSpin = 0;
+  for ( UINT4 j = 0; j < numInj; j ++ )
+    {
+      const PulsarParams *pp = &injectionSources->data[injIndex[j]];
+      XLAL_CHECK ( pp->Doppler.asini == 0, XLAL_EINVAL, "Direct signal synthesis only supports isolated sources\n" );
+      REAL8 dtau = XLALGPSDiff ( &epoch, &pp->Doppler.refTime );
+      XLAL_CHECK ( XLALExtrapolatePulsarSpins ( sig[j].fkdot, pp->Doppler.fkdot, dtau ) == XLAL_SUCCESS, XLAL_EFUNC );
+      REAL8 phi1;
+      XLAL_CHECK ( XLALExtrapolatePulsarPhase ( &phi1, sig[j].fkdot, pp->Amp.phi0, dtau ) == XLAL_SUCCESS, XLAL_EFUNC );
+      sig[j].phi0cycles = phi1 / LAL_TWOPI;
+      REAL8 kfact = 1;
+      for ( UINT4 s = 0; s < PULSAR_MAX_SPINS; s ++ )
+        {
+          kfact *= ( s + 1 );
+          sig[j].spinCoef[s] = sig[j].fkdot[s] / kfact;
+          if ( ( s > 0 ) && ( sig[j].fkdot[s] != 0 ) && ( s > maxSpin ) ) {
+            maxSpin = s;
+          }
+        }
+
+      // h = F+ aPlus cos(phi) + Fx aCross sin(phi), with F+ = a cos2psi + b sin2psi, Fx = b cos2psi - a sin2psi
+      REAL8 sin2psi = sin ( 2.0 * pp->Amp.psi );
+      REAL8 cos2psi = cos ( 2.0 * pp->Amp.psi );
+      sig[j].Apa =   pp->Amp.aPlus  * cos2psi;
+      sig[j].Apb =   pp->Amp.aPlus  * sin2psi;
+      sig[j].Axa = - pp->Amp.aCross * sin2psi;
+      sig[j].Axb =   pp->Amp.aCross * cos2psi;
+
+      // sample range covered by the transient window
+      sig[j].window = pp->Transient;
+      XLAL_CHECK ( XLALGetTransientWindowTimespan ( &sig[j].t0, &sig[j].t1, pp->Transient ) == XLAL_SUCCESS, XLAL_EFUNC );
+      sig[j].i0 = 0;
+      sig[j].i1 = numSamples;
+      if ( pp->Transient.type != TRANSIENT_NONE )
+        {
+          // (padded by a sample on either side, the window value itself takes care of the exact edges)
+          REAL8 i0 = floor ( ( sig[j].t0 - epoch_REAL8 ) / dt ) - 1;
+          REAL8 i1 = ceil ( ( sig[j].t1 - epoch_REAL8 ) / dt ) + 2;
+          sig[j].i0 = (UINT4) fmax ( 0, fmin ( i0, numSamples ) );
+          sig[j].i1 = (UINT4) fmax ( sig[j].i0, fmin ( i1, numSamples ) );
+        }
+    } // for j < numInj
+
+  // ----- interpolation buffers for one coarse interval
+  const UINT4 maxChunk = (UINT4) ceil ( dtc / dt ) + 1;
+  REAL8 *delay, *ai, *bi;
+  XLAL_CHECK ( (delay = XLALCalloc ( maxChunk, sizeof(delay[0]) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( (ai = XLALCalloc ( maxChunk, sizeof(ai[0]) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( (bi = XLALCalloc ( maxChunk, sizeof(bi[0]) )) != NULL, XLAL_ENOMEM );
+
+  // ----- main loop over coarse intervals [k dtc, (k+1) dtc)
+  UINT4 iStart = 0;
+  for ( UINT4 k = 0; ( k + 1 < numNodes ) && ( iStart < numSamples ); k ++ )
+    {
+      UINT4 iEnd = (UINT4) fmin ( ceil ( (k + 1) * dtc / dt ), numSamples );
+      if ( iEnd <= iStart ) {
+        continue;
+      }
+      XLAL_CHECK ( iEnd - iStart <= maxChunk, XLAL_EFAILED );
+
+      // SSB delay tau(t) - (t - epoch) and its derivative at the interval nodes
+      REAL8 d0 = tSSB->DeltaT->data[k]   - k * dtc;
+      REAL8 d1 = tSSB->DeltaT->data[k+1] - (k + 1) * dtc;
+      REAL8 m0 = ( tSSB->Tdot->data[k]   - 1.0 ) * dtc;
+      REAL8 m1 = ( tSSB->Tdot->data[k+1] - 1.0 ) * dtc;
+      REAL8 a0 = amcoe->a->data[k], a1 = amcoe->a->data[k+1];
+      REAL8 b0 = amcoe->b->data[k], b1 = amcoe->b->data[k+1];
+      for ( UINT4 i = iStart; i < iEnd; i ++ )
+        {
+          REAL8 x = ( i * dt - k * dtc ) / dtc;
+          REAL8 x2 = x * x, x3 = x2 * x;
+          delay[i - iStart] = ( 2*x3 - 3*x2 + 1 ) * d0 + ( x3 - 2*x2 + x ) * m0 + ( -2*x3 + 3*x2 ) * d1 + ( x3 - x2 ) * m1;
+          ai[i - iStart] = a0 + x * ( a1 - a0 );
+          bi[i - iStart] = b0 + x * ( b1 - b0 );
+        }
+
+      for ( UINT4 j = 0; j < numInj; j ++ )
+        {
+          const DirectSignal *sj = &sig[j];
+          UINT4 jStart = ( sj->i0 > iStart ) ? sj->i0 : iStart;
+          UINT4 jEnd   = ( sj->i1 < iEnd )   ? sj->i1 : iEnd;
+          REAL8 fOff = sj->fkdot[0] - fHet;
+          for ( UINT4 i = jStart; i < jEnd; i ++ )
+            {
+              REAL8 ti = i * dt;
+              REAL8 di = delay[i - iStart];
+              REAL8 tau = ti + di;
+
+              // phase in cycles, relative to the heterodyne phase fHet * (t - epoch)
+              REAL8 cycles = sj->phi0cycles + sj->fkdot[0] * di + fOff * ti;
+              if ( maxSpin > 0 )
+                {
+                  REAL8 spins = 0;
+                  for ( UINT4 s = maxSpin; s >= 1; s -- ) {
+                    spins = spins * tau + sj->spinCoef[s];
+                  }
+                  cycles += spins * tau * tau;
+                }
+              cycles -= floor ( cycles );
+
+              REAL4 sinphi, cosphi;
+              XLAL_CHECK ( XLALSinCos2PiLUT ( &sinphi, &cosphi, cycles ) == XLAL_SUCCESS, XLAL_EFUNC );
+              REAL8 hi = ( sj->Apa * ai[i - iStart] + sj->Apb * bi[i - iStart] ) * cosphi
+                + ( sj->Axa * ai[i - iStart] + sj->Axb * bi[i - iStart] ) * sinphi;
+
+              if ( sj->window.type != TRANSIENT_NONE )
+                {
+                  LIGOTimeGPS ti_GPS = epoch;
+                  XLALGPSAdd ( &ti_GPS, ti );
+                  UINT4 tGPS = lround ( XLALGPSGetREAL8 ( &ti_GPS ) );
+                  hi *= XLALGetTransientWindowValue ( tGPS, sj->t0, sj->t1, sj->window.tau, sj->window.type );
+                }
+              data[i] += (REAL4) hi;
+            } // for i in [jStart, jEnd)
+        } // for j < numInj
+
+      iStart = iEnd;
+    } // for k < numNodes - 1
+
+  // ----- free memory
+  XLALFree ( delay );
+  XLALFree ( ai );
+  XLALFree ( bi );
+  XLALFree ( sig );
+  XLALDestroyAMCoeffs ( amcoe );
+  XLALDestroySSBtimes ( tSSB );
+
+  return XLAL_SUCCESS;
+
+} // XLALAddCWSignalsDirect()
+
 ///
 /// Make SFTs from given REAL8TimeSeries at given timestamps, potentially applying a time-domain window on each timestretch first
 ///
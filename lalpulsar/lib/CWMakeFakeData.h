@@ -80,6 +80,7 @@ typedef struct tagCWMFDataParams
   UINT4 randSeed;				//!< seed value for random-number generator
   MultiREAL8TimeSeries *inputMultiTS;		//!< [optional] input time-series for signals+noise to be added to
   REAL8 sourceDeltaT;                           //!< [optional] source-frame sampling period. '0' means to use the previous internal defaults
+  BOOLEAN fastInjection;			//!< [optional] synthesise isolated signals directly in the heterodyned band, batching signals sharing the same sky-position
 } CWMFDataParams;
 
 // ---------- Global variables ----------
@@ -22,16 +22,30 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <errno.h>
 #include <math.h>
+#include <unistd.h>
+#include <sys/stat.h>
 #include <gsl/gsl_math.h>
 
 #include "ComputeFstat_internal.h"
 
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_MMAP)
+#include <sys/mman.h>
+#endif
+
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
+
 #include <lal/LALString.h>
+#include <lal/LALProfile.h>
 #include <lal/LALSIMD.h>
 #include <lal/NormalizeSFTRngMed.h>
 #include <lal/ExtrapolatePulsarSpins.h>
 #include <lal/VectorMath.h>
+#include <lal/TimeSeries.h>
 
 // ---------- Internal struct definitions ---------- //
 
@@ -46,14 +60,69 @@ struct tagFstatInput {
   int *workspace_refcount;				// Reference counter for the shared workspace 'common.workspace'
   FstatMethodFuncs method_funcs;			// Function pointers for F-statistic method
   void *method_data;					// F-statistic method data
+  void *snapshot;					// Memory holding the contents of a snapshot file, if created by XLALCreateFstatInputFromSnapshot()
+  size_t snapshotSize;					// Size of 'snapshot' in bytes
+  BOOLEAN snapshotMapped;				// True if 'snapshot' was mapped read-only into memory, false if it was read into a buffer
+  UINT4 numSnapshotViews;				// Number of vectors whose data point into 'snapshot'
+  COMPLEX8Vector **snapshotViews;			// Vectors whose data point into 'snapshot', to be detached before the method data is destroyed
+};
+
+// SFTs of one detector in a stream of SFTs for FstatInput structures, in time order
+typedef struct {
+  UINT4 length;						// Number of SFTs
+  UINT4 capacity;					// Number of SFTs which fit into the allocated arrays
+  SFTtype *sfts;					// Normalised SFTs, trimmed to the frequency band required by the F-statistic method
+  REAL8 *weights;					// Unnormalised noise weights of the SFTs
+  DetectorState *states;				// Detector states at the mid-times of the SFTs
+  CoordinateSystem system;				// Coordinate system of the detector states
+  SFTtoTSEngine *engine;				// Resamp: converts SFTs into a heterodyned timeseries, re-using samples of SFTs already transformed
+} FstatInputStreamDetector;
+
+// Internal definition of stream of SFTs for FstatInput structures
+struct tagFstatInputStream {
+  REAL8 Tsft;						// Length of SFTs in the stream
+  REAL8 minFreqFull;					// Minimum frequency which appended SFTs must cover
+  REAL8 maxFreqFull;					// Maximum frequency which appended SFTs must cover
+  REAL8 minFreqMethod;					// Minimum frequency required by the F-statistic method
+  REAL8 maxFreqMethod;					// Maximum frequency required by the F-statistic method
+  REAL8 dFreq;						// Requested spacing of F-statistic frequency bins; may be zero
+  const EphemerisData *ephemerides;			// Ephemerides for the time-span of the SFTs
+  FstatOptionalArgs optArgs;				// Optional arguments given to XLALCreateFstatInputStream()
+  MultiNoiseFloor assumeSqrtSX;				// Copy of 'optArgs.assumeSqrtSX', if given
+  MultiLALDetector detectors;				// List of detectors
+  FstatInputStreamDetector det[PULSAR_MAX_DETECTORS];	// SFTs of each detector
+#ifdef LAL_PTHREAD_LOCK
+  pthread_mutex_t lock;					// Guards 'det[]' against concurrent appends and copies
+  pthread_mutex_t engineLock;				// Serialises updates of the Resamp engines in 'det[]'
+#endif
+};
+
+// Cache of noise-weighted antenna-pattern coefficients, indexed by sky position
+struct tagFstatAMCoeffsCache {
+  UINT4 length;						// Number of cached sky positions
+  UINT4 capacity;					// Maximum number of cached sky positions
+  UINT4 next;						// Index of the entry to be replaced next, once the cache is full
+  SkyPosition *skypos;					// Cached sky positions
+  MultiAMCoeffs **multiAMcoef;				// Cached antenna-pattern coefficients for each sky position
 };
 
 // ---------- Internal prototypes ---------- //
 
 static int XLALSelectBestFstatMethod ( FstatMethodType *method );
+static FstatAMCoeffsCache *XLALCreateFstatAMCoeffsCache ( const UINT4 capacity );
+static void XLALDestroyFstatAMCoeffsCache ( FstatAMCoeffsCache *cache );
+static int XLALFstatAMCoeffsCacheReserve ( FstatAMCoeffsCache *cache, const UINT4 capacity );
+static int XLALFstatAMCoeffsCacheFind ( const FstatAMCoeffsCache *cache, const SkyPosition *skypos );
+static int XLALFstatAMCoeffsCacheInsert ( FstatAMCoeffsCache *cache, const SkyPosition *skypos, MultiAMCoeffs *multiAMcoef );
+
+typedef int (*FstatSetupFunc) ( void **, FstatCommon *, FstatMethodFuncs*, MultiSFTVector *, const FstatOptionalArgs * );
+static int XLALGetFstatMethodSetup ( int *extraBinsMethod, FstatSetupFunc *setupFuncMethod, const FstatOptionalArgs *optArgs );
+static int XLALSetupFstatInputWorkspace ( FstatInput *input, const FstatInput *prevInput );
 
 int XLALSetupFstatDemod  ( void **method_data, FstatCommon *common, FstatMethodFuncs* funcs, MultiSFTVector *multiSFTs, const FstatOptionalArgs *optArgs );
 int XLALSetupFstatResamp ( void **method_data, FstatCommon *common, FstatMethodFuncs* funcs, MultiSFTVector *multiSFTs, const FstatOptionalArgs *optArgs );
+int XLALSetupFstatResampFromTimeSeries ( void **method_data, FstatCommon *common, FstatMethodFuncs* funcs, MultiCOMPLEX8TimeSeries *multiTimeSeries_DET, const FstatOptionalArgs *optArgs );
+int XLALExtendSFTBandForResamp ( SFTVector *sfts, const UINT4 Dterms );
 
 // ---------- Constant variable definitions ---------- //
 
@@ -62,12 +131,28 @@ static const char *const FstatMethodNames[FMETHOD_END] = {
   [FMETHOD_DEMOD_OPTC]		= "DemodOptC",
   [FMETHOD_DEMOD_ALTIVEC]	= "DemodAltivec",
   [FMETHOD_DEMOD_SSE]		= "DemodSSE",
+  [FMETHOD_DEMOD_AVX2]		= "DemodAVX2",
+  [FMETHOD_DEMOD_AVX512]	= "DemodAVX512",
   [FMETHOD_DEMOD_BEST]		= "DemodBest",
 
   [FMETHOD_RESAMP_GENERIC]	= "ResampGeneric",
+  [FMETHOD_RESAMP_AVX512]	= "ResampAVX512",
+  [FMETHOD_RESAMP_CUDA]		= "ResampCUDA",
   [FMETHOD_RESAMP_BEST]		= "ResampBest",
 };
 
+///
+/// Choices for the NUMA placement of large F-statistic buffers (\c FstatOptionalArgs.resampMemPlacement):
+/// - 'default': leave placement to the operating system
+/// - 'interleave': interleave the buffers over all nodes, e.g. if threads are not bound to nodes
+/// - 'local': place per-thread buffers on the node of their thread, by first touching them from that thread
+///
+const UserChoices FstatMemPlacementChoices = {
+  { LAL_MEMORY_PLACEMENT_DEFAULT,	"default" },
+  { LAL_MEMORY_PLACEMENT_INTERLEAVE,	"interleave" },
+  { LAL_MEMORY_PLACEMENT_LOCAL,		"local" },
+};
+
 const FstatOptionalArgs FstatOptionalArgsDefaults = {
   .randSeed = 0,
   .SSBprec = SSBPREC_RELATIVISTICOPT,
@@ -79,7 +164,10 @@ const FstatOptionalArgs FstatOptionalArgsDefaults = {
   .assumeSqrtSX = NULL,
   .prevInput = NULL,
   .collectTiming = 0,
-  .resampFFTPowerOf2 = 1
+  .resampFFTPowerOf2 = 1,
+  .resampNumThreads = 0,
+  .resampMemPlacement = LAL_MEMORY_PLACEMENT_DEFAULT,
+  .AMCoeffsCacheSize = 1
 };
 
 static const char FstatTimingGenericHelp[] =
@@ -331,6 +419,102 @@ XLALDestroyMultiFstatAtomVector ( MultiFstatAtomVector *multiAtoms  ///< [in] \c
 
 } // XLALDestroyMultiFstatAtomVector()
 
+///
+/// Parse which F-statistic method to use, and set these variables:
+/// - extraBinsMethod:   any extra SFT frequency bins required by the method
+/// - setupFuncMethod:   method setup function, called at end of XLALCreateFstatInput()
+///
+static int
+XLALGetFstatMethodSetup ( int *extraBinsMethod, FstatSetupFunc *setupFuncMethod, const FstatOptionalArgs *optArgs )
+{
+  switch (optArgs->FstatMethod) {
+
+  case FMETHOD_DEMOD_GENERIC:		// Demod: generic C hotloop
+    XLAL_CHECK ( optArgs->Dterms > 0, XLAL_EINVAL );
+    *extraBinsMethod = optArgs->Dterms;
+    *setupFuncMethod = XLALSetupFstatDemod;
+    break;
+
+  case FMETHOD_DEMOD_OPTC:		// Demod: gptimized C hotloop using Akos' algorithm
+    XLAL_CHECK ( optArgs->Dterms <= 20, XLAL_EINVAL, "Selected Hotloop variant 'OptC' only works for Dterms <= 20, got %d\n", optArgs->Dterms );
+    *extraBinsMethod = optArgs->Dterms;
+    *setupFuncMethod = XLALSetupFstatDemod;
+    break;
+
+  case FMETHOD_DEMOD_ALTIVEC:		// Demod: Altivec hotloop variant
+    XLAL_CHECK ( optArgs->Dterms == 8, XLAL_EINVAL, "Selected Hotloop variant 'Altivec' only works for Dterms == 8, got %d\n", optArgs->Dterms );
+    *extraBinsMethod = optArgs->Dterms;
+    *setupFuncMethod = XLALSetupFstatDemod;
+    break;
+
+  case FMETHOD_DEMOD_SSE:		// Demod: SSE hotloop with precalc divisors
+    XLAL_CHECK ( optArgs->Dterms == 8, XLAL_EINVAL, "Selected Hotloop variant 'SSE' only works for Dterms == 8, got %d\n", optArgs->Dterms );
+    *extraBinsMethod = optArgs->Dterms;
+    *setupFuncMethod = XLALSetupFstatDemod;
+    break;
+
+  case FMETHOD_DEMOD_AVX2:		// Demod: AVX2 hotloop
+  case FMETHOD_DEMOD_AVX512:		// Demod: AVX-512 hotloop
+    XLAL_CHECK ( optArgs->Dterms > 0, XLAL_EINVAL );
+    *extraBinsMethod = optArgs->Dterms;
+    *setupFuncMethod = XLALSetupFstatDemod;
+    break;
+
+  case FMETHOD_RESAMP_GENERIC:		// Resamp: generic implementation
+  case FMETHOD_RESAMP_AVX512:		// Resamp: AVX-512 interpolation and heterodyne-correction kernels
+  case FMETHOD_RESAMP_CUDA:		// Resamp: spindown+FFT on a CUDA device
+    *extraBinsMethod = 8;   // use 8 extra bins to give better agreement with Demod(w Dterms=8) near the boundaries
+    *setupFuncMethod = XLALSetupFstatResamp;
+    break;
+
+  default:
+    XLAL_ERROR ( XLAL_EFAILED, "Missing switch case for optArgs->FstatMethod='%d'\n", optArgs->FstatMethod );
+  }
+  XLAL_CHECK ( *extraBinsMethod >= 0, XLAL_EFAILED );
+  XLAL_CHECK ( *setupFuncMethod != NULL, XLAL_EFAILED );
+
+  return XLAL_SUCCESS;
+
+} // XLALGetFstatMethodSetup()
+
+///
+/// Set up the workspace reference counter of a new \c FstatInput structure, re-using
+/// the workspace of 'prevInput' if given
+///
+static int
+XLALSetupFstatInputWorkspace ( FstatInput *input, const FstatInput *prevInput )
+{
+  if ( prevInput != NULL ) {
+
+    // Check that F-stat method being used agrees with 'prevInput'
+    XLAL_CHECK( prevInput->method == input->method, XLAL_EFAILED, "Cannot use workspace from 'prevInput' with different FstatMethod '%d'!='%d'", prevInput->method, input->method );
+
+    // Get pointers to workspace and workspace reference counter in 'prevInput'
+    input->common.workspace = prevInput->common.workspace;
+    input->workspace_refcount = prevInput->workspace_refcount;
+
+    // Increment reference count
+    ++(*input->workspace_refcount);
+    XLALPrintInfo( "%s: re-using workspace from 'optionalArgs.prevInput', reference count = %i\n", __func__, *input->workspace_refcount );
+
+  } else {
+
+    // Workspace must be allocated by method setup function
+    input->common.workspace = NULL;
+
+    // Allocate memory for reference counter; when reference count reaches 0, memory must be destroyed
+    XLAL_CHECK ( ( input->workspace_refcount = XLALCalloc ( 1, sizeof(*input->workspace_refcount) ) ) != NULL, XLAL_ENOMEM );
+
+    // Initialise reference counter to 1
+    (*input->workspace_refcount) = 1;
+    XLALPrintInfo( "%s: allocating new workspace, reference count = %i\n", __func__, *input->workspace_refcount );
+
+  }
+
+  return XLAL_SUCCESS;
+
+} // XLALSetupFstatInputWorkspace()
+
 ///
 /// Create a fully-setup \c FstatInput structure for computing the \f$\mathcal{F}\f$-statistic using XLALComputeFstat().
 ///
@@ -378,49 +562,10 @@ XLALCreateFstatInput ( const SFTCatalog *SFTcatalog,              ///< [in] Cata
   XLAL_CHECK_NULL ( FstatMethodNames[optArgs.FstatMethod] != NULL, XLAL_EFAULT );
   XLAL_CHECK_NULL ( XLALSelectBestFstatMethod( &optArgs.FstatMethod ) == XLAL_SUCCESS, XLAL_EFAULT );
 
-  //
-  // Parse which F-statistic method to use, and set these variables:
-  // - extraBinsMethod:   any extra SFT frequency bins required by the method
-  // - setupFuncMethod:   method setup function, called at end of XLALCreateFstatInput()
-  //
+  // Parse which F-statistic method to use
   int extraBinsMethod = 0;
-  int (*setupFuncMethod) ( void **, FstatCommon *, FstatMethodFuncs*, MultiSFTVector *, const FstatOptionalArgs * );
-  switch (optArgs.FstatMethod) {
-
-  case FMETHOD_DEMOD_GENERIC:		// Demod: generic C hotloop
-    XLAL_CHECK_NULL ( optArgs.Dterms > 0, XLAL_EINVAL );
-    extraBinsMethod = optArgs.Dterms;
-    setupFuncMethod = XLALSetupFstatDemod;
-    break;
-
-  case FMETHOD_DEMOD_OPTC:		// Demod: gptimized C hotloop using Akos' algorithm
-    XLAL_CHECK_NULL ( optArgs.Dterms <= 20, XLAL_EINVAL, "Selected Hotloop variant 'OptC' only works for Dterms <= 20, got %d\n", optArgs.Dterms );
-    extraBinsMethod = optArgs.Dterms;
-    setupFuncMethod = XLALSetupFstatDemod;
-    break;
-
-  case FMETHOD_DEMOD_ALTIVEC:		// Demod: Altivec hotloop variant
-    XLAL_CHECK_NULL ( optArgs.Dterms == 8, XLAL_EINVAL, "Selected Hotloop variant 'Altivec' only works for Dterms == 8, got %d\n", optArgs.Dterms );
-    extraBinsMethod = optArgs.Dterms;
-    setupFuncMethod = XLALSetupFstatDemod;
-    break;
-
-  case FMETHOD_DEMOD_SSE:		// Demod: SSE hotloop with precalc divisors
-    XLAL_CHECK_NULL ( optArgs.Dterms == 8, XLAL_EINVAL, "Selected Hotloop variant 'SSE' only works for Dterms == 8, got %d\n", optArgs.Dterms );
-    extraBinsMethod = optArgs.Dterms;
-    setupFuncMethod = XLALSetupFstatDemod;
-    break;
-
-  case FMETHOD_RESAMP_GENERIC:		// Resamp: generic implementation
-    extraBinsMethod = 8;   // use 8 extra bins to give better agreement with Demod(w Dterms=8) near the boundaries
-    setupFuncMethod = XLALSetupFstatResamp;
-    break;
-
-  default:
-    XLAL_ERROR_NULL ( XLAL_EFAILED, "Missing switch case for optArgs.FstatMethod='%d'\n", optArgs.FstatMethod );
-  }
-  XLAL_CHECK_NULL ( extraBinsMethod >= 0, XLAL_EFAILED );
-  XLAL_CHECK_NULL ( setupFuncMethod != NULL, XLAL_EFAILED );
+  FstatSetupFunc setupFuncMethod = NULL;
+  XLAL_CHECK_NULL ( XLALGetFstatMethodSetup ( &extraBinsMethod, &setupFuncMethod, &optArgs ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   // Determine whether to load and/or generate SFTs
   const BOOLEAN loadSFTs = (SFTcatalog->data[0].locator != NULL);
@@ -434,32 +579,7 @@ XLALCreateFstatInput ( const SFTCatalog *SFTcatalog,              ///< [in] Cata
   FstatCommon *common = &input->common;      // handy shortcut
 
   // Determine whether we can re-used workspace from a previous call to XLALCreateFstatInput()
-  if ( optArgs.prevInput != NULL ) {
-
-    // Check that F-stat method being used agrees with 'prevInput'
-    XLAL_CHECK_NULL( optArgs.prevInput->method == input->method, XLAL_EFAILED, "Cannot use workspace from 'prevInput' with different FstatMethod '%d'!='%d'", optArgs.prevInput->method, input->method );
-
-    // Get pointers to workspace and workspace reference counter in 'prevInput'
-    common->workspace = optArgs.prevInput->common.workspace;
-    input->workspace_refcount = optArgs.prevInput->workspace_refcount;
-
-    // Increment reference count
-    ++(*input->workspace_refcount);
-    XLALPrintInfo( "%s: re-using workspace from 'optionalArgs.prevInput', reference count = %i\n", __func__, *input->workspace_refcount );
-
-  } else {
-
-    // Workspace must be allocated by method setup function
-    common->workspace = NULL;
-
-    // Allocate memory for reference counter; when reference count reaches 0, memory must be destroyed
-    XLAL_CHECK_NULL ( ( input->workspace_refcount = XLALCalloc ( 1, sizeof(*input->workspace_refcount) ) ) != NULL, XLAL_ENOMEM );
-
-    // Initialise reference counter to 1
-    (*input->workspace_refcount) = 1;
-    XLALPrintInfo( "%s: allocating new workspace, reference count = %i\n", __func__, *input->workspace_refcount );
-
-  }
+  XLAL_CHECK_NULL ( XLALSetupFstatInputWorkspace ( input, optArgs.prevInput ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   // Determine the length of an SFT
   input->Tsft = 1.0 / SFTcatalog->data[0].header.deltaF;
@@ -591,26 +711,1088 @@ XLALCreateFstatInput ( const SFTCatalog *SFTcatalog,              ///< [in] Cata
   // Get detector states, with a timestamp shift of Tsft/2
   const REAL8 tOffset = 0.5 * input->Tsft;
   XLAL_CHECK_NULL ( (common->multiDetectorStates = XLALGetMultiDetectorStates ( common->multiTimestamps, &common->detectors, ephemerides, tOffset )) != NULL, XLAL_EFUNC );
+  // Precompute the sky-independent barycentering quantities, since the SSB times are computed for many sky positions
+  XLAL_CHECK_NULL ( XLALAddBarycenterCacheToMultiDetectorStates ( common->multiDetectorStates ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Save ephemerides and SSB precision
+  common->ephemerides = ephemerides;
+  common->SSBprec = optArgs.SSBprec;
+
+  // Call the appropriate method function to setup their input data structures
+  // - The method input data structures are expected to take ownership of the
+  //   SFTs, which is why 'input->common' does not retain a pointer to them
+  FstatMethodFuncs *funcs = &input->method_funcs;
+  // Create cache of antenna-pattern coefficients
+  XLAL_CHECK_NULL ( ( common->AMCoeffsCache = XLALCreateFstatAMCoeffsCache ( optArgs.AMCoeffsCacheSize ) ) != NULL, XLAL_EFUNC );
+
+  XLAL_CHECK_NULL( (setupFuncMethod) ( &input->method_data, common, funcs, multiSFTs, &optArgs ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // If setup function allocated a workspace, check that it also supplied a destructor function
+  XLAL_CHECK_NULL( common->workspace == NULL || funcs->workspace_destroy_func != NULL, XLAL_EFAILED );
+
+  // Cleanup
+  XLALDestroyMultiPSDVector ( runningMedian );
+
+  return input;
+
+} // XLALCreateFstatInput()
+
+// ---------- Snapshot files of FstatInput structures ---------- //
+
+// Header of an FstatInput snapshot file, written by XLALWriteFstatInputSnapshot()
+typedef struct {
+  CHAR magic[8];					// File identifier FSTAT_SNAPSHOT_MAGIC
+  UINT4 version;					// File format version FSTAT_SNAPSHOT_VERSION
+  UINT4 sizeofHeader;					// Size of this header, to detect snapshots written on a different architecture
+  UINT4 sizeofDetectorState;				// Size of a DetectorState, to detect snapshots written on a different architecture
+  UINT4 numDetectors;					// Number of detectors
+  INT4 method;						// F-statistic method used to create the snapshot
+  UINT4 Dterms;						// Number of Dirichlet kernel (Demod) or windowed-sinc interpolation (Resamp) terms
+  INT4 singleFreqBin;					// Whether only a single frequency bin can be computed
+  REAL8 Tsft;						// Length of input SFTs
+  REAL8 minFreqFull;					// Minimum frequency loaded from input SFTs
+  REAL8 maxFreqFull;					// Maximum frequency loaded from input SFTs
+  REAL8 dFreq;						// Spacing of F-statistic frequency bins
+  REAL8 allowedMismatchFromSFTLength;			// Optional override for XLALFstatCheckSFTLengthMismatch()
+  LIGOTimeGPS midTime;					// Mid-time of SFT data
+  MultiLALDetector detectors;				// List of detectors
+  REAL8 Sinv_Tsft;					// Normalisation factor of the (unnormalised) noise weights
+  UINT8 fileSize;					// Total size of the snapshot file, to detect truncated files
+} FstatSnapshotHeader;
+
+#define FSTAT_SNAPSHOT_MAGIC "LALFSNP1"
+#define FSTAT_SNAPSHOT_VERSION 1
+#define FSTAT_SNAPSHOT_ALIGN 64				// Alignment of bulk data (SFT bins, timeseries samples) within snapshot files
+
+// Write 'size' bytes of 'data' to a snapshot file, keeping track of the current file offset
+static int
+XLALFstatSnapshotWrite ( FILE *fp, size_t *offset, const void *data, const size_t size )
+{
+  if ( size > 0 ) {
+    XLAL_CHECK ( fwrite ( data, size, 1, fp ) == 1, XLAL_EIO, "Failed to write %zu bytes to snapshot file: %s", size, strerror(errno) );
+  }
+  *offset += size;
+  return XLAL_SUCCESS;
+}
+
+// Pad a snapshot file with zeros up to the next multiple of FSTAT_SNAPSHOT_ALIGN bytes
+static int
+XLALFstatSnapshotWritePadding ( FILE *fp, size_t *offset )
+{
+  static const CHAR zeros[FSTAT_SNAPSHOT_ALIGN];
+  const size_t pad = ( FSTAT_SNAPSHOT_ALIGN - ( *offset % FSTAT_SNAPSHOT_ALIGN ) ) % FSTAT_SNAPSHOT_ALIGN;
+  XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, offset, zeros, pad ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+// Return a pointer to the next 'size' bytes of a snapshot, checking that the snapshot is long enough
+static const void *
+XLALFstatSnapshotRead ( const CHAR *snapshot, const size_t snapshotSize, size_t *offset, const size_t size )
+{
+  XLAL_CHECK_NULL ( *offset <= snapshotSize && size <= snapshotSize - *offset, XLAL_EIO, "Snapshot file is truncated: need %zu bytes at offset %zu of %zu", size, *offset, snapshotSize );
+  const void *ptr = snapshot + *offset;
+  *offset += size;
+  return ptr;
+}
+
+// Skip over padding written by XLALFstatSnapshotWritePadding()
+static int
+XLALFstatSnapshotReadPadding ( const CHAR *snapshot, const size_t snapshotSize, size_t *offset )
+{
+  const size_t pad = ( FSTAT_SNAPSHOT_ALIGN - ( *offset % FSTAT_SNAPSHOT_ALIGN ) ) % FSTAT_SNAPSHOT_ALIGN;
+  XLAL_CHECK ( XLALFstatSnapshotRead ( snapshot, snapshotSize, offset, pad ) != NULL, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+// Copy the next 'size' bytes of a snapshot into 'data'
+#define SNAPSHOT_COPY(data, size) do { \
+    const void *_ptr = XLALFstatSnapshotRead ( snapshot, snapshotSize, &offset, (size) ); \
+    XLAL_CHECK_NULL ( _ptr != NULL, XLAL_EFUNC ); \
+    memcpy ( (data), _ptr, (size) ); \
+  } while (0)
+
+// Write the contents of an FstatInput snapshot file to an open file pointer
+static int
+XLALWriteFstatInputSnapshotToFile ( FILE *fp, const FstatInput *input )
+{
+  const FstatCommon *common = &input->common;
+  const UINT4 numDetectors = common->detectors.length;
+
+  // Get SFTs (Demod) or heterodyned timeseries (Resamp) from the method data
+  const BOOLEAN isDemod = XLALFstatMethodClassIsDemod ( input->method );
+  const MultiSFTVector *multiSFTs = NULL;
+  const MultiCOMPLEX8TimeSeries *multiTimeSeries_DET = NULL;
+  UINT4 Dterms = 0;
+  if ( isDemod ) {
+    XLAL_CHECK ( XLALGetFstatInputSFTs_Demod ( &multiSFTs, &Dterms, input->method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK ( multiSFTs->length == numDetectors, XLAL_EFAILED );
+  } else {
+    XLAL_CHECK ( XLALGetFstatInputTimeSeries_Resamp ( &multiTimeSeries_DET, &Dterms, input->method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK ( multiTimeSeries_DET->length == numDetectors, XLAL_EFAILED );
+  }
+
+  // Write header; 'fileSize' is filled in once the size of the file is known
+  FstatSnapshotHeader XLAL_INIT_DECL(header);
+  memcpy ( header.magic, FSTAT_SNAPSHOT_MAGIC, sizeof(header.magic) );
+  header.version = FSTAT_SNAPSHOT_VERSION;
+  header.sizeofHeader = sizeof(header);
+  header.sizeofDetectorState = sizeof(DetectorState);
+  header.numDetectors = numDetectors;
+  header.method = input->method;
+  header.Dterms = Dterms;
+  header.singleFreqBin = input->singleFreqBin;
+  header.Tsft = input->Tsft;
+  header.minFreqFull = input->minFreqFull;
+  header.maxFreqFull = input->maxFreqFull;
+  header.dFreq = common->dFreq;
+  header.allowedMismatchFromSFTLength = common->allowedMismatchFromSFTLength;
+  header.midTime = common->midTime;
+  header.detectors = common->detectors;
+  header.Sinv_Tsft = common->multiNoiseWeights->Sinv_Tsft;
+  size_t offset = 0;
+  XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, &header, sizeof(header) ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Write timestamps, noise weights and detector states of each detector
+  for ( UINT4 X = 0; X < numDetectors; ++X ) {
+    const LIGOTimeGPSVector *timestamps = common->multiTimestamps->data[X];
+    const REAL8Vector *weights = common->multiNoiseWeights->data[X];
+    const DetectorStateSeries *states = common->multiDetectorStates->data[X];
+    XLAL_CHECK ( weights->length == timestamps->length && states->length == timestamps->length, XLAL_EFAILED );
+    XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, &timestamps->length, sizeof(timestamps->length) ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, &timestamps->deltaT, sizeof(timestamps->deltaT) ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, timestamps->data, timestamps->length * sizeof(timestamps->data[0]) ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, weights->data, weights->length * sizeof(weights->data[0]) ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, &states->detector, sizeof(states->detector) ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, &states->system, sizeof(states->system) ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, &states->deltaT, sizeof(states->deltaT) ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, states->data, states->length * sizeof(states->data[0]) ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Write SFTs (Demod) or heterodyned timeseries (Resamp) of each detector; bulk data is aligned so that it can be used directly from a mapping
+  for ( UINT4 X = 0; X < numDetectors; ++X ) {
+    if ( isDemod ) {
+      const SFTVector *sfts = multiSFTs->data[X];
+      XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, &sfts->length, sizeof(sfts->length) ) == XLAL_SUCCESS, XLAL_EFUNC );
+      for ( UINT4 i = 0; i < sfts->length; ++i ) {
+        const SFTtype *sft = &sfts->data[i];
+        const UINT4 numBins = ( sft->data != NULL ) ? sft->data->length : 0;
+        XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, sft->name, sizeof(sft->name) ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, &sft->epoch, sizeof(sft->epoch) ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, &sft->f0, sizeof(sft->f0) ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, &sft->deltaF, sizeof(sft->deltaF) ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, &sft->sampleUnits, sizeof(sft->sampleUnits) ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, &numBins, sizeof(numBins) ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLAL_CHECK ( XLALFstatSnapshotWritePadding ( fp, &offset ) == XLAL_SUCCESS, XLAL_EFUNC );
+        if ( numBins > 0 ) {
+          XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, sft->data->data, numBins * sizeof(sft->data->data[0]) ) == XLAL_SUCCESS, XLAL_EFUNC );
+        }
+      }
+    } else {
+      const COMPLEX8TimeSeries *ts = multiTimeSeries_DET->data[X];
+      const UINT4 numSamples = ts->data->length;
+      XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, ts->name, sizeof(ts->name) ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, &ts->epoch, sizeof(ts->epoch) ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, &ts->deltaT, sizeof(ts->deltaT) ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, &ts->f0, sizeof(ts->f0) ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, &ts->sampleUnits, sizeof(ts->sampleUnits) ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, &numSamples, sizeof(numSamples) ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK ( XLALFstatSnapshotWritePadding ( fp, &offset ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK ( XLALFstatSnapshotWrite ( fp, &offset, ts->data->data, numSamples * sizeof(ts->data->data[0]) ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+  }
+
+  // Go back and fill in the size of the file
+  header.fileSize = offset;
+  XLAL_CHECK ( fseek ( fp, 0, SEEK_SET ) == 0, XLAL_EIO, "Failed to seek in snapshot file: %s", strerror(errno) );
+  XLAL_CHECK ( fwrite ( &header, sizeof(header), 1, fp ) == 1, XLAL_EIO, "Failed to write snapshot file header: %s", strerror(errno) );
+
+  return XLAL_SUCCESS;
+
+} // XLALWriteFstatInputSnapshotToFile()
+
+///
+/// Write a snapshot of a fully-setup \c FstatInput structure to a file, from which further
+/// \c FstatInput structures can be re-created using XLALCreateFstatInputFromSnapshot().
+///
+/// The snapshot contains the SFT band data (\a Demod) or the heterodyned detector-frame timeseries (\a Resamp),
+/// as well as the SFT timestamps, noise weights, and detector states. It is intended to be written once by a single
+/// job, and then shared read-only by many jobs on the same machine, which thereby avoid loading and normalising the
+/// SFTs and setting up the method data themselves.
+///
+/// The snapshot is written in the native binary format of the machine, and can only be read on machines
+/// of the same architecture. It is first written to a uniquely-named temporary file in the same directory, which is then renamed to \p fname,
+/// so that other jobs never see a partially-written snapshot.
+///
+int
+XLALWriteFstatInputSnapshot ( const CHAR *fname,               ///< [in] Name of snapshot file to write.
+                              const FstatInput *input          ///< [in] \c FstatInput structure.
+                              )
+{
+  // Check input
+  XLAL_CHECK ( fname != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( input != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( !input->common.isTimeslice, XLAL_EINVAL, "Cannot write a snapshot of a timeslice of an FstatInput structure" );
+
+  // Write snapshot to a uniquely-named temporary file in the same directory, so that jobs writing the same snapshot do not collide
+  char *tmpfname = XLALStringAppendFmt ( NULL, "%s.XXXXXX", fname );
+  XLAL_CHECK ( tmpfname != NULL, XLAL_EFUNC );
+  const int fd = mkstemp ( tmpfname );
+  if ( fd < 0 ) {
+    const int errnum = errno;
+    XLALFree ( tmpfname );
+    XLAL_ERROR ( XLAL_EIO, "Failed to create temporary snapshot file for '%s': %s", fname, strerror(errnum) );
+  }
+  fchmod ( fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH );	// mkstemp() creates files readable only by their owner
+  FILE *fp = fdopen ( fd, "wb" );
+  if ( fp == NULL ) {
+    const int errnum = errno;
+    close ( fd );
+    remove ( tmpfname );
+    XLALFree ( tmpfname );
+    XLAL_ERROR ( XLAL_EIO, "Failed to open snapshot file for '%s' for writing: %s", fname, strerror(errnum) );
+  }
+  const int retn = XLALWriteFstatInputSnapshotToFile ( fp, input );
+  const int closed = ( fclose ( fp ) == 0 );
+  if ( retn != XLAL_SUCCESS || !closed ) {
+    remove ( tmpfname );
+    XLALFree ( tmpfname );
+    XLAL_ERROR ( XLAL_EIO, "Failed to write snapshot file '%s'", fname );
+  }
+
+  // Move snapshot into place
+  if ( rename ( tmpfname, fname ) != 0 ) {
+    remove ( tmpfname );
+    XLALFree ( tmpfname );
+    XLAL_ERROR ( XLAL_EIO, "Failed to rename snapshot file to '%s': %s", fname, strerror(errno) );
+  }
+  XLALFree ( tmpfname );
+
+  return XLAL_SUCCESS;
+
+} // XLALWriteFstatInputSnapshot()
+
+// Map (if possible) or read the complete contents of a snapshot file into memory
+static int
+XLALLoadFstatInputSnapshot ( void **snapshot, size_t *snapshotSize, BOOLEAN *snapshotMapped, const CHAR *fname )
+{
+  FILE *fp = fopen ( fname, "rb" );
+  XLAL_CHECK ( fp != NULL, XLAL_EIO, "Failed to open snapshot file '%s': %s", fname, strerror(errno) );
+  long fileSize = -1;
+  if ( fseek ( fp, 0, SEEK_END ) == 0 ) {
+    fileSize = ftell ( fp );
+  }
+  if ( fileSize <= 0 ) {
+    fclose ( fp );
+    XLAL_ERROR ( XLAL_EIO, "Failed to determine size of snapshot file '%s'", fname );
+  }
+  *snapshotSize = (size_t) fileSize;
+
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_MMAP)
+  void *map = mmap ( NULL, *snapshotSize, PROT_READ, MAP_PRIVATE, fileno(fp), 0 );
+  if ( map != MAP_FAILED ) {
+    fclose ( fp );	// mapping remains valid after the file is closed
+    *snapshot = map;
+    *snapshotMapped = 1;
+    return XLAL_SUCCESS;
+  }
+  XLALPrintInfo ( "%s: failed to mmap() snapshot file '%s' (%s), reading it instead\n", __func__, fname, strerror(errno) );
+#endif
+
+  // Fall back to reading the file into a buffer
+  *snapshot = XLALMalloc ( *snapshotSize );
+  if ( *snapshot == NULL ) {
+    fclose ( fp );
+    XLAL_ERROR ( XLAL_ENOMEM );
+  }
+  *snapshotMapped = 0;
+  const int ok = ( fseek ( fp, 0, SEEK_SET ) == 0 ) && ( fread ( *snapshot, *snapshotSize, 1, fp ) == 1 );
+  fclose ( fp );
+  if ( !ok ) {
+    XLALFree ( *snapshot );
+    XLAL_ERROR ( XLAL_EIO, "Failed to read snapshot file '%s'", fname );
+  }
+
+  return XLAL_SUCCESS;
+
+} // XLALLoadFstatInputSnapshot()
+
+// Release memory loaded by XLALLoadFstatInputSnapshot()
+static void
+XLALReleaseFstatInputSnapshot ( void *snapshot, size_t snapshotSize, BOOLEAN snapshotMapped )
+{
+  if ( snapshot == NULL ) {
+    return;
+  }
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_MMAP)
+  if ( snapshotMapped ) {
+    munmap ( snapshot, snapshotSize );
+    return;
+  }
+#else
+  (void) snapshotSize; (void) snapshotMapped;
+#endif
+  XLALFree ( snapshot );
+}
+
+// Check that the header of a snapshot file is consistent with the snapshot, and with the requested F-statistic method
+static int
+XLALCheckFstatInputSnapshotHeader ( const FstatSnapshotHeader *header, const size_t snapshotSize, const CHAR *fname, const FstatOptionalArgs *optArgs )
+{
+  XLAL_CHECK ( memcmp ( header->magic, FSTAT_SNAPSHOT_MAGIC, sizeof(header->magic) ) == 0, XLAL_EIO, "'%s' is not an FstatInput snapshot file", fname );
+  XLAL_CHECK ( header->version == FSTAT_SNAPSHOT_VERSION, XLAL_EIO, "Snapshot file '%s' has unsupported version %u", fname, header->version );
+  XLAL_CHECK ( header->sizeofHeader == sizeof(*header) && header->sizeofDetectorState == sizeof(DetectorState), XLAL_EIO,
+               "Snapshot file '%s' was written on a machine of a different architecture", fname );
+  XLAL_CHECK ( header->fileSize == snapshotSize, XLAL_EIO, "Snapshot file '%s' has size %zu, expected %" LAL_UINT8_FORMAT, fname, snapshotSize, header->fileSize );
+  XLAL_CHECK ( ( FMETHOD_START < header->method ) && ( header->method < FMETHOD_END ), XLAL_EIO );
+  XLAL_CHECK ( 0 < header->numDetectors && header->numDetectors <= PULSAR_MAX_DETECTORS && header->numDetectors == header->detectors.length, XLAL_EIO );
+  XLAL_CHECK ( XLALFstatMethodClassIsDemod ( header->method ) == XLALFstatMethodClassIsDemod ( optArgs->FstatMethod ), XLAL_EINVAL, "Cannot use snapshot created with FstatMethod '%s' for FstatMethod '%s'",
+               FstatMethodNames[header->method], FstatMethodNames[optArgs->FstatMethod] );
+  XLAL_CHECK ( optArgs->Dterms == header->Dterms, XLAL_EINVAL, "Snapshot created with Dterms=%u, but Dterms=%u requested", header->Dterms, optArgs->Dterms );
+  return XLAL_SUCCESS;
+}
+
+// Record a vector whose data point into the snapshot of 'input'
+static int
+XLALAddFstatInputSnapshotView ( FstatInput *input, COMPLEX8Vector *view )
+{
+  COMPLEX8Vector **views = XLALRealloc ( input->snapshotViews, ( input->numSnapshotViews + 1 ) * sizeof(*views) );
+  XLAL_CHECK ( views != NULL, XLAL_ENOMEM );
+  views[input->numSnapshotViews++] = view;
+  input->snapshotViews = views;
+  return XLAL_SUCCESS;
+}
+
+///
+/// Create a fully-setup \c FstatInput structure from a snapshot file written by XLALWriteFstatInputSnapshot().
+///
+/// Where \c mmap() is available, the snapshot file is mapped read-only into memory, and the SFT band data (\a Demod)
+/// or heterodyned detector-frame timeseries (\a Resamp) are used directly from the mapping, so that their memory
+/// is shared between all jobs on the same machine using the same snapshot; only the small per-detector arrays
+/// are copied. Per-job buffers, such as the \a Resamp source-frame timeseries and FFT workspace, are still allocated
+/// by each job.
+///
+/// The F-statistic method requested in \p optionalArgs must be of the same family (\a Demod or \a Resamp) as
+/// the method used to create the snapshot, and use the same number of \c Dterms. Optional arguments which
+/// determine how the SFTs are loaded, generated, and normalised (e.g. \c injectSources, \c assumeSqrtSX,
+/// \c runningMedianWindow) are ignored, since they were applied when the snapshot was created.
+///
+FstatInput *
+XLALCreateFstatInputFromSnapshot ( const CHAR *fname,                        ///< [in] Name of snapshot file to read.
+                                   const EphemerisData *ephemerides,         ///< [in] Ephemerides for the time-span of the SFTs.
+                                   const FstatOptionalArgs *optionalArgs     ///< [in] Optional 'advanced-level' and method-specific extra arguments; NULL: use defaults from FstatOptionalArgsDefaults.
+                                   )
+{
+  // Check input
+  XLAL_CHECK_NULL ( fname != NULL, XLAL_EINVAL );
+  XLAL_CHECK_NULL ( ephemerides != NULL, XLAL_EINVAL );
+
+  // Create local copy of optional arguments, or use defaults if not given
+  FstatOptionalArgs optArgs;
+  if ( optionalArgs != NULL ) {
+    optArgs = *optionalArgs;
+  } else {
+    optArgs = FstatOptionalArgsDefaults;
+  }
+  XLAL_CHECK_NULL ( optArgs.SSBprec < SSBPREC_LAST, XLAL_EINVAL );
+  XLAL_CHECK_NULL ( ( FMETHOD_START < optArgs.FstatMethod ) && ( optArgs.FstatMethod < FMETHOD_END ), XLAL_EINVAL );
+  XLAL_CHECK_NULL ( FstatMethodNames[optArgs.FstatMethod] != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL ( XLALSelectBestFstatMethod( &optArgs.FstatMethod ) == XLAL_SUCCESS, XLAL_EFAULT );
+  int extraBinsMethod = 0;
+  FstatSetupFunc setupFuncMethod = NULL;
+  XLAL_CHECK_NULL ( XLALGetFstatMethodSetup ( &extraBinsMethod, &setupFuncMethod, &optArgs ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Load snapshot, and read and check header
+  void *snapshotMem = NULL;
+  size_t snapshotSize = 0;
+  BOOLEAN snapshotMapped = 0;
+  XLAL_CHECK_NULL ( XLALLoadFstatInputSnapshot ( &snapshotMem, &snapshotSize, &snapshotMapped, fname ) == XLAL_SUCCESS, XLAL_EFUNC );
+  const CHAR *snapshot = snapshotMem;
+  FstatSnapshotHeader header;
+  if ( snapshotSize < sizeof(header) ) {
+    XLALReleaseFstatInputSnapshot ( snapshotMem, snapshotSize, snapshotMapped );
+    XLAL_ERROR_NULL ( XLAL_EIO, "Snapshot file '%s' is truncated", fname );
+  }
+  memcpy ( &header, snapshot, sizeof(header) );
+  if ( XLALCheckFstatInputSnapshotHeader ( &header, snapshotSize, fname, &optArgs ) != XLAL_SUCCESS ) {
+    XLALReleaseFstatInputSnapshot ( snapshotMem, snapshotSize, snapshotMapped );
+    XLAL_ERROR_NULL ( XLAL_EFUNC );
+  }
+  size_t offset = sizeof(header);
+  const BOOLEAN isDemod = XLALFstatMethodClassIsDemod ( header.method );
+  const UINT4 numDetectors = header.numDetectors;
+
+  // Create top-level input data struct, which takes ownership of the snapshot
+  FstatInput* input;
+  XLAL_CHECK_NULL ( (input = XLALCalloc ( 1, sizeof(*input) )) != NULL, XLAL_ENOMEM );
+  input->method = optArgs.FstatMethod;
+  input->snapshot = snapshotMem;
+  input->snapshotSize = snapshotSize;
+  input->snapshotMapped = snapshotMapped;
+  FstatCommon *common = &input->common;      // handy shortcut
+
+  // Set up workspace, re-using 'prevInput' if given
+  XLAL_CHECK_NULL ( XLALSetupFstatInputWorkspace ( input, optArgs.prevInput ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Copy input parameters
+  input->Tsft = header.Tsft;
+  input->minFreqFull = header.minFreqFull;
+  input->maxFreqFull = header.maxFreqFull;
+  input->singleFreqBin = header.singleFreqBin;
+  common->midTime = header.midTime;
+  common->dFreq = header.dFreq;
+  common->detectors = header.detectors;
+  common->allowedMismatchFromSFTLength = header.allowedMismatchFromSFTLength;
+
+  // Create multi-detector containers for timestamps, noise weights, and detector states
+  XLAL_CHECK_NULL ( ( common->multiTimestamps = XLALCalloc ( 1, sizeof(*common->multiTimestamps) ) ) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_NULL ( ( common->multiTimestamps->data = XLALCalloc ( numDetectors, sizeof(*common->multiTimestamps->data) ) ) != NULL, XLAL_ENOMEM );
+  common->multiTimestamps->length = numDetectors;
+  XLAL_CHECK_NULL ( ( common->multiNoiseWeights = XLALCalloc ( 1, sizeof(*common->multiNoiseWeights) ) ) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_NULL ( ( common->multiNoiseWeights->data = XLALCalloc ( numDetectors, sizeof(*common->multiNoiseWeights->data) ) ) != NULL, XLAL_ENOMEM );
+  common->multiNoiseWeights->length = numDetectors;
+  common->multiNoiseWeights->Sinv_Tsft = header.Sinv_Tsft;
+  common->multiNoiseWeights->isNotNormalized = (1 == 1);
+  XLAL_CHECK_NULL ( ( common->multiDetectorStates = XLALCalloc ( 1, sizeof(*common->multiDetectorStates) ) ) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_NULL ( ( common->multiDetectorStates->data = XLALCalloc ( numDetectors, sizeof(*common->multiDetectorStates->data) ) ) != NULL, XLAL_ENOMEM );
+  common->multiDetectorStates->length = numDetectors;
+
+  // Read timestamps, noise weights and detector states of each detector
+  for ( UINT4 X = 0; X < numDetectors; ++X ) {
+    UINT4 numTimestamps = 0;
+    SNAPSHOT_COPY ( &numTimestamps, sizeof(numTimestamps) );
+    XLAL_CHECK_NULL ( numTimestamps > 1 && numTimestamps <= snapshotSize / sizeof(DetectorState), XLAL_EIO, "Invalid number of timestamps %u in snapshot file '%s'", numTimestamps, fname );
+
+    LIGOTimeGPSVector *timestamps = common->multiTimestamps->data[X] = XLALCreateTimestampVector ( numTimestamps );
+    XLAL_CHECK_NULL ( timestamps != NULL, XLAL_EFUNC );
+    SNAPSHOT_COPY ( &timestamps->deltaT, sizeof(timestamps->deltaT) );
+    SNAPSHOT_COPY ( timestamps->data, numTimestamps * sizeof(timestamps->data[0]) );
+
+    REAL8Vector *weights = common->multiNoiseWeights->data[X] = XLALCreateREAL8Vector ( numTimestamps );
+    XLAL_CHECK_NULL ( weights != NULL, XLAL_EFUNC );
+    SNAPSHOT_COPY ( weights->data, numTimestamps * sizeof(weights->data[0]) );
+
+    DetectorStateSeries *states = common->multiDetectorStates->data[X] = XLALCreateDetectorStateSeries ( numTimestamps );
+    XLAL_CHECK_NULL ( states != NULL, XLAL_EFUNC );
+    SNAPSHOT_COPY ( &states->detector, sizeof(states->detector) );
+    SNAPSHOT_COPY ( &states->system, sizeof(states->system) );
+    SNAPSHOT_COPY ( &states->deltaT, sizeof(states->deltaT) );
+    SNAPSHOT_COPY ( states->data, numTimestamps * sizeof(states->data[0]) );
+
+    // Re-create the sky-independent barycentering quantities, since the SSB times are computed for many sky positions
+    XLAL_CHECK_NULL ( XLALAddBarycenterCacheToDetectorStates ( states ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Save ephemerides and SSB precision
+  common->ephemerides = ephemerides;
+  common->SSBprec = optArgs.SSBprec;
+
+  // Create cache of antenna-pattern coefficients
+  XLAL_CHECK_NULL ( ( common->AMCoeffsCache = XLALCreateFstatAMCoeffsCache ( optArgs.AMCoeffsCacheSize ) ) != NULL, XLAL_EFUNC );
+
+  // Create SFTs (Demod) or heterodyned timeseries (Resamp) whose data point into the snapshot, and set up method data
+  FstatMethodFuncs *funcs = &input->method_funcs;
+  if ( isDemod ) {
+    MultiSFTVector *multiSFTs = NULL;
+    XLAL_CHECK_NULL ( ( multiSFTs = XLALCalloc ( 1, sizeof(*multiSFTs) ) ) != NULL, XLAL_ENOMEM );
+    XLAL_CHECK_NULL ( ( multiSFTs->data = XLALCalloc ( numDetectors, sizeof(*multiSFTs->data) ) ) != NULL, XLAL_ENOMEM );
+    multiSFTs->length = numDetectors;
+    for ( UINT4 X = 0; X < numDetectors; ++X ) {
+      UINT4 numSFTs = 0;
+      SNAPSHOT_COPY ( &numSFTs, sizeof(numSFTs) );
+      XLAL_CHECK_NULL ( numSFTs == common->multiTimestamps->data[X]->length, XLAL_EIO, "Inconsistent number of SFTs %u in snapshot file '%s'", numSFTs, fname );
+      XLAL_CHECK_NULL ( ( multiSFTs->data[X] = XLALCreateEmptySFTVector ( numSFTs ) ) != NULL, XLAL_EFUNC );
+      for ( UINT4 i = 0; i < numSFTs; ++i ) {
+        SFTtype *sft = &multiSFTs->data[X]->data[i];
+        UINT4 numBins = 0;
+        SNAPSHOT_COPY ( sft->name, sizeof(sft->name) );
+        SNAPSHOT_COPY ( &sft->epoch, sizeof(sft->epoch) );
+        SNAPSHOT_COPY ( &sft->f0, sizeof(sft->f0) );
+        SNAPSHOT_COPY ( &sft->deltaF, sizeof(sft->deltaF) );
+        SNAPSHOT_COPY ( &sft->sampleUnits, sizeof(sft->sampleUnits) );
+        SNAPSHOT_COPY ( &numBins, sizeof(numBins) );
+        XLAL_CHECK_NULL ( XLALFstatSnapshotReadPadding ( snapshot, snapshotSize, &offset ) == XLAL_SUCCESS, XLAL_EFUNC );
+        if ( numBins > 0 ) {
+          const size_t binsOffset = offset;
+          XLAL_CHECK_NULL ( XLALFstatSnapshotRead ( snapshot, snapshotSize, &offset, numBins * sizeof(COMPLEX8) ) != NULL, XLAL_EFUNC );
+          XLAL_CHECK_NULL ( ( sft->data = XLALCalloc ( 1, sizeof(*sft->data) ) ) != NULL, XLAL_ENOMEM );
+          sft->data->length = numBins;
+          sft->data->data = (COMPLEX8 *) ( (CHAR *) snapshotMem + binsOffset );
+          XLAL_CHECK_NULL ( XLALAddFstatInputSnapshotView ( input, sft->data ) == XLAL_SUCCESS, XLAL_EFUNC );
+        }
+      }
+    }
+    XLAL_CHECK_NULL ( XLALSetupFstatDemod ( &input->method_data, common, funcs, multiSFTs, &optArgs ) == XLAL_SUCCESS, XLAL_EFUNC );
+  } else {
+    MultiCOMPLEX8TimeSeries *multiTimeSeries_DET = NULL;
+    XLAL_CHECK_NULL ( ( multiTimeSeries_DET = XLALCalloc ( 1, sizeof(*multiTimeSeries_DET) ) ) != NULL, XLAL_ENOMEM );
+    XLAL_CHECK_NULL ( ( multiTimeSeries_DET->data = XLALCalloc ( numDetectors, sizeof(*multiTimeSeries_DET->data) ) ) != NULL, XLAL_ENOMEM );
+    multiTimeSeries_DET->length = numDetectors;
+    for ( UINT4 X = 0; X < numDetectors; ++X ) {
+      COMPLEX8TimeSeries *ts = NULL;
+      XLAL_CHECK_NULL ( ( ts = multiTimeSeries_DET->data[X] = XLALCalloc ( 1, sizeof(*ts) ) ) != NULL, XLAL_ENOMEM );
+      UINT4 numSamples = 0;
+      SNAPSHOT_COPY ( ts->name, sizeof(ts->name) );
+      SNAPSHOT_COPY ( &ts->epoch, sizeof(ts->epoch) );
+      SNAPSHOT_COPY ( &ts->deltaT, sizeof(ts->deltaT) );
+      SNAPSHOT_COPY ( &ts->f0, sizeof(ts->f0) );
+      SNAPSHOT_COPY ( &ts->sampleUnits, sizeof(ts->sampleUnits) );
+      SNAPSHOT_COPY ( &numSamples, sizeof(numSamples) );
+      XLAL_CHECK_NULL ( numSamples > 0, XLAL_EIO, "Invalid number of timeseries samples in snapshot file '%s'", fname );
+      XLAL_CHECK_NULL ( XLALFstatSnapshotReadPadding ( snapshot, snapshotSize, &offset ) == XLAL_SUCCESS, XLAL_EFUNC );
+      const size_t samplesOffset = offset;
+      XLAL_CHECK_NULL ( XLALFstatSnapshotRead ( snapshot, snapshotSize, &offset, numSamples * sizeof(COMPLEX8) ) != NULL, XLAL_EFUNC );
+      XLAL_CHECK_NULL ( ( ts->data = XLALCalloc ( 1, sizeof(*ts->data) ) ) != NULL, XLAL_ENOMEM );
+      ts->data->length = numSamples;
+      ts->data->data = (COMPLEX8 *) ( (CHAR *) snapshotMem + samplesOffset );
+      XLAL_CHECK_NULL ( XLALAddFstatInputSnapshotView ( input, ts->data ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+    XLAL_CHECK_NULL ( XLALSetupFstatResampFromTimeSeries ( &input->method_data, common, funcs, multiTimeSeries_DET, &optArgs ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  XLAL_CHECK_NULL ( offset == snapshotSize, XLAL_EIO, "Snapshot file '%s' contains %zu unexpected trailing bytes", fname, snapshotSize - offset );
+
+  // If setup function allocated a workspace, check that it also supplied a destructor function
+  XLAL_CHECK_NULL( common->workspace == NULL || funcs->workspace_destroy_func != NULL, XLAL_EFAILED );
+
+  return input;
+
+} // XLALCreateFstatInputFromSnapshot()
+
+// ---------- Streams of SFTs for FstatInput structures ---------- //
+
+#ifdef LAL_PTHREAD_LOCK
+#define FSTAT_STREAM_LOCK(m)     pthread_mutex_lock(m)
+#define FSTAT_STREAM_UNLOCK(m)   pthread_mutex_unlock(m)
+#else
+#define FSTAT_STREAM_LOCK(m)     do { } while (0)
+#define FSTAT_STREAM_UNLOCK(m)   do { } while (0)
+#endif
+
+// Compare SFTs by their epochs, for sorting SFTs appended to an FstatInputStream
+static int
+XLALCompareSFTEpochs ( const void *x, const void *y )
+{
+  const SFTtype *sft1 = (const SFTtype *) x;
+  const SFTtype *sft2 = (const SFTtype *) y;
+  return XLALGPSCmp ( &sft1->epoch, &sft2->epoch );
+}
+
+// Merge SFTs sorted in time order, with their noise weights and detector states, into the SFTs of one detector
+// of an FstatInputStream, and take ownership of the SFT data. Called with the stream locked; on error, the
+// stream is unchanged.
+static int
+XLALFstatInputStreamMergeSFTs ( FstatInputStreamDetector *det, SFTVector *sfts, const REAL8Vector *weights, const DetectorStateSeries *states )
+{
+  const UINT4 numNew = sfts->length;
+
+  // Check that SFTs have not already been appended
+  for ( UINT4 j = 0; j < numNew; ++j ) {
+    UINT4 lo = 0, hi = det->length;
+    while ( lo < hi ) {
+      const UINT4 mid = lo + ( hi - lo ) / 2;
+      if ( XLALGPSCmp ( &det->sfts[mid].epoch, &sfts->data[j].epoch ) < 0 ) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    XLAL_CHECK ( lo == det->length || XLALGPSCmp ( &det->sfts[lo].epoch, &sfts->data[j].epoch ) != 0, XLAL_EINVAL,
+                 "SFT with timestamp %" LAL_INT4_FORMAT ".%09" LAL_INT4_FORMAT " has already been appended", sfts->data[j].epoch.gpsSeconds, sfts->data[j].epoch.gpsNanoSeconds );
+  }
+
+  // Make room for the new SFTs
+  if ( det->length + numNew > det->capacity ) {
+    const UINT4 capacity = GSL_MAX ( 2 * det->capacity, det->length + numNew );
+    SFTtype *newSFTs = XLALRealloc ( det->sfts, capacity * sizeof(*newSFTs) );
+    XLAL_CHECK ( newSFTs != NULL, XLAL_ENOMEM );
+    det->sfts = newSFTs;
+    REAL8 *newWeights = XLALRealloc ( det->weights, capacity * sizeof(*newWeights) );
+    XLAL_CHECK ( newWeights != NULL, XLAL_ENOMEM );
+    det->weights = newWeights;
+    DetectorState *newStates = XLALRealloc ( det->states, capacity * sizeof(*newStates) );
+    XLAL_CHECK ( newStates != NULL, XLAL_ENOMEM );
+    det->states = newStates;
+    det->capacity = capacity;
+  }
+
+  // Merge the new SFTs from the back, so that SFTs appended in time order are not moved
+  UINT4 i = det->length, j = numNew, k = det->length + numNew;
+  while ( j > 0 ) {
+    --k;
+    if ( i > 0 && XLALGPSCmp ( &det->sfts[i-1].epoch, &sfts->data[j-1].epoch ) > 0 ) {
+      --i;
+      det->sfts[k] = det->sfts[i];
+      det->weights[k] = det->weights[i];
+      det->states[k] = det->states[i];
+    } else {
+      --j;
+      det->sfts[k] = sfts->data[j];
+      det->weights[k] = weights->data[j];
+      det->states[k] = states->data[j];
+      sfts->data[j].data = NULL;
+    }
+  }
+  det->length += numNew;
+  det->system = states->system;
+
+  return XLAL_SUCCESS;
+
+} // XLALFstatInputStreamMergeSFTs()
+
+// Free views of the SFTs of an FstatInputStream, without freeing the SFT data of the stream
+static void
+XLALDestroyFstatInputStreamViews ( MultiSFTVector *multiSFTs )
+{
+  if ( multiSFTs == NULL ) {
+    return;
+  }
+  for ( UINT4 X = 0; X < multiSFTs->length; ++X ) {
+    for ( UINT4 i = 0; multiSFTs->data[X] != NULL && i < multiSFTs->data[X]->length; ++i ) {
+      multiSFTs->data[X]->data[i].data = NULL;
+    }
+  }
+  XLALDestroyMultiSFTVector ( multiSFTs );
+}
+
+// Copy the timestamps, noise weights and detector states of all SFTs of an FstatInputStream into 'common', and
+// create views of the SFTs which point to the SFT data of the stream. Called with the stream locked.
+static int
+XLALFstatInputStreamCopySFTs ( MultiSFTVector **multiSFTs, FstatCommon *common, const FstatInputStream *stream )
+{
+  const UINT4 numDetectors = stream->detectors.length;
+
+  // Check that no single-SFT input vectors are given to avoid returning singular results
+  for ( UINT4 X = 0; X < numDetectors; ++X ) {
+    XLAL_CHECK ( stream->det[X].length > 1, XLAL_EINVAL, "Need more than 1 SFTs per Detector, got %u from detector '%s'!\n", stream->det[X].length, stream->detectors.sites[X].frDetector.prefix );
+  }
+
+  // Create multi-detector containers for SFT views, timestamps, noise weights, and detector states
+  XLAL_CHECK ( ( (*multiSFTs) = XLALCalloc ( 1, sizeof(**multiSFTs) ) ) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( ( (*multiSFTs)->data = XLALCalloc ( numDetectors, sizeof((*multiSFTs)->data[0]) ) ) != NULL, XLAL_ENOMEM );
+  (*multiSFTs)->length = numDetectors;
+  XLAL_CHECK ( ( common->multiTimestamps = XLALCalloc ( 1, sizeof(*common->multiTimestamps) ) ) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( ( common->multiTimestamps->data = XLALCalloc ( numDetectors, sizeof(*common->multiTimestamps->data) ) ) != NULL, XLAL_ENOMEM );
+  common->multiTimestamps->length = numDetectors;
+  XLAL_CHECK ( ( common->multiNoiseWeights = XLALCalloc ( 1, sizeof(*common->multiNoiseWeights) ) ) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( ( common->multiNoiseWeights->data = XLALCalloc ( numDetectors, sizeof(*common->multiNoiseWeights->data) ) ) != NULL, XLAL_ENOMEM );
+  common->multiNoiseWeights->length = numDetectors;
+  common->multiNoiseWeights->isNotNormalized = (1 == 1);
+  XLAL_CHECK ( ( common->multiDetectorStates = XLALCalloc ( 1, sizeof(*common->multiDetectorStates) ) ) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( ( common->multiDetectorStates->data = XLALCalloc ( numDetectors, sizeof(*common->multiDetectorStates->data) ) ) != NULL, XLAL_ENOMEM );
+  common->multiDetectorStates->length = numDetectors;
+
+  UINT4 numSFTsTot = 0;
+  REAL8 sumWeights = 0;
+  for ( UINT4 X = 0; X < numDetectors; ++X ) {
+    const FstatInputStreamDetector *det = &stream->det[X];
+    const UINT4 numSFTs = det->length;
+
+    SFTVector *sfts = (*multiSFTs)->data[X] = XLALCreateEmptySFTVector ( numSFTs );
+    XLAL_CHECK ( sfts != NULL, XLAL_EFUNC );
+    memcpy ( sfts->data, det->sfts, numSFTs * sizeof(sfts->data[0]) );
+
+    LIGOTimeGPSVector *timestamps = common->multiTimestamps->data[X] = XLALCreateTimestampVector ( numSFTs );
+    XLAL_CHECK ( timestamps != NULL, XLAL_EFUNC );
+    timestamps->deltaT = stream->Tsft;
+    for ( UINT4 i = 0; i < numSFTs; ++i ) {
+      timestamps->data[i] = det->sfts[i].epoch;
+    }
+
+    REAL8Vector *weights = common->multiNoiseWeights->data[X] = XLALCreateREAL8Vector ( numSFTs );
+    XLAL_CHECK ( weights != NULL, XLAL_EFUNC );
+    memcpy ( weights->data, det->weights, numSFTs * sizeof(weights->data[0]) );
+    for ( UINT4 i = 0; i < numSFTs; ++i ) {
+      sumWeights += weights->data[i];
+    }
+    numSFTsTot += numSFTs;
+
+    DetectorStateSeries *states = common->multiDetectorStates->data[X] = XLALCreateDetectorStateSeries ( numSFTs );
+    XLAL_CHECK ( states != NULL, XLAL_EFUNC );
+    states->detector = stream->detectors.sites[X];
+    states->system = det->system;
+    states->deltaT = stream->Tsft;
+    memcpy ( states->data, det->states, numSFTs * sizeof(states->data[0]) );
+  }
+
+  // Normalisation factor of the unnormalised noise weights, as computed by XLALComputeMultiNoiseWeights()
+  common->multiNoiseWeights->Sinv_Tsft = sumWeights / numSFTsTot;
+
+  return XLAL_SUCCESS;
+
+} // XLALFstatInputStreamCopySFTs()
+
+///
+/// Create a stream of SFTs from which \c FstatInput structures can be created, for computing the
+/// \f$\mathcal{F}\f$-statistic over a growing data set, e.g. in an online search which analyses SFTs
+/// as they are produced from frame data.
+///
+/// SFTs are added to the stream with XLALFstatInputStreamAppendSFTs(), which may be called from several
+/// threads, e.g. one producing SFTs for each detector. Each SFT is normalised, and its noise weight and
+/// detector state are computed, when it is appended, so XLALCreateFstatInputFromStream() can set up an
+/// \c FstatInput structure for all SFTs appended so far without re-loading or re-normalising any SFTs.
+/// Since each SFT is normalised by its own running median, the result is the same, up to rounding, as
+/// XLALCreateFstatInput() given a catalog of the same SFTs.
+///
+/// Optional arguments which generate SFTs (\c injectSources, \c injectSqrtSX) are not supported, and
+/// \c assumeSqrtSX, if given, is indexed by \p detectors. The \c prevInput optional argument is ignored;
+/// pass it to XLALCreateFstatInputFromStream() instead.
+///
+FstatInputStream *
+XLALCreateFstatInputStream ( const MultiLALDetector *detectors,           ///< [in] Detectors whose SFTs will be appended to the stream.
+                             const REAL8 Tsft,                            ///< [in] Length of the SFTs which will be appended to the stream.
+                             const REAL8 minCoverFreq,                    ///< [in] Minimum instantaneous frequency which will be covered over the SFT time span.
+                             const REAL8 maxCoverFreq,                    ///< [in] Maximum instantaneous frequency which will be covered over the SFT time span.
+                             const REAL8 dFreq,                           ///< [in] Requested spacing of \f$\mathcal{F}\f$-statistic frequency bins. May be zero \e only for single-frequency searches.
+                             const EphemerisData *ephemerides,            ///< [in] Ephemerides for the time-span of the SFTs.
+                             const FstatOptionalArgs *optionalArgs        ///< [in] Optional 'advanced-level' and method-specific extra arguments; NULL: use defaults from FstatOptionalArgsDefaults.
+                             )
+{
+  // Check required parameters
+  XLAL_CHECK_NULL ( detectors != NULL, XLAL_EINVAL );
+  XLAL_CHECK_NULL ( detectors->length > 0 && detectors->length <= PULSAR_MAX_DETECTORS, XLAL_EINVAL );
+  XLAL_CHECK_NULL ( isfinite(Tsft) && ( Tsft > 0 ), XLAL_EINVAL, "Check failed: Tsft=%f must be finite and positive!", Tsft );
+  XLAL_CHECK_NULL ( isfinite(minCoverFreq) && ( minCoverFreq > 0 ) && isfinite(maxCoverFreq) && ( maxCoverFreq > 0 ), XLAL_EINVAL, "Check failed: minCoverFreq=%f and maxCoverFreq=%f must be finite and positive!", minCoverFreq, maxCoverFreq );
+  XLAL_CHECK_NULL ( maxCoverFreq > minCoverFreq, XLAL_EINVAL, "Check failed: maxCoverFreq>minCoverFreq (%f<=%f)!", maxCoverFreq, minCoverFreq );
+  XLAL_CHECK_NULL ( ephemerides != NULL, XLAL_EINVAL );
+  XLAL_CHECK_NULL ( dFreq >= 0, XLAL_EINVAL);
+
+  // Create local copy of optional arguments, or use defaults if not given
+  FstatOptionalArgs optArgs;
+  if ( optionalArgs != NULL ) {
+    optArgs = *optionalArgs;
+  } else {
+    optArgs = FstatOptionalArgsDefaults;
+  }
+
+  // Check optional arguments sanity
+  XLAL_CHECK_NULL ( optArgs.injectSources == NULL && optArgs.injectSqrtSX == NULL, XLAL_EINVAL, "Cannot generate SFTs for a stream; SFTs must be appended with XLALFstatInputStreamAppendSFTs()" );
+  XLAL_CHECK_NULL ( (optArgs.assumeSqrtSX == NULL) || (optArgs.assumeSqrtSX->length == detectors->length), XLAL_EINVAL );
+  XLAL_CHECK_NULL ( optArgs.SSBprec < SSBPREC_LAST, XLAL_EINVAL );
+
+  // Check optional Fstat method type argument
+  XLAL_CHECK_NULL ( ( FMETHOD_START < optArgs.FstatMethod ) && ( optArgs.FstatMethod < FMETHOD_END ), XLAL_EINVAL );
+  XLAL_CHECK_NULL ( FstatMethodNames[optArgs.FstatMethod] != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL ( XLALSelectBestFstatMethod( &optArgs.FstatMethod ) == XLAL_SUCCESS, XLAL_EFAULT );
+
+  // Parse which F-statistic method to use
+  int extraBinsMethod = 0;
+  FstatSetupFunc setupFuncMethod = NULL;
+  XLAL_CHECK_NULL ( XLALGetFstatMethodSetup ( &extraBinsMethod, &setupFuncMethod, &optArgs ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Create stream
+  FstatInputStream *stream;
+  XLAL_CHECK_NULL ( (stream = XLALCalloc ( 1, sizeof(*stream) )) != NULL, XLAL_ENOMEM );
+#ifdef LAL_PTHREAD_LOCK
+  pthread_mutex_init ( &stream->lock, NULL );
+  pthread_mutex_init ( &stream->engineLock, NULL );
+#endif
+  stream->Tsft = Tsft;
+  stream->dFreq = dFreq;
+  stream->ephemerides = ephemerides;
+  stream->detectors = *detectors;
+
+  // Save optional arguments, keeping a copy of the assumed noise floors
+  if ( optArgs.assumeSqrtSX != NULL ) {
+    stream->assumeSqrtSX = *optArgs.assumeSqrtSX;
+    optArgs.assumeSqrtSX = &stream->assumeSqrtSX;
+  }
+  optArgs.prevInput = NULL;
+  stream->optArgs = optArgs;
+
+  // Determine the frequency bands required by the method, and for normalising SFTs, as in XLALCreateFstatInput()
+  {
+    int extraBinsFull = extraBinsMethod + optArgs.runningMedianWindow/2 + 1;
+
+    const REAL8 extraFreqMethod = extraBinsMethod / Tsft;
+    stream->minFreqMethod = minCoverFreq - extraFreqMethod;
+    stream->maxFreqMethod = maxCoverFreq + extraFreqMethod;
+
+    const REAL8 extraFreqFull = extraBinsFull / Tsft;
+    stream->minFreqFull = minCoverFreq - extraFreqFull;
+    stream->maxFreqFull = maxCoverFreq + extraFreqFull;
+  }
+
+  // Resamp: create engines to convert the SFTs of each detector into heterodyned timeseries
+  if ( XLALFstatMethodClassIsResamp ( optArgs.FstatMethod ) ) {
+    for ( UINT4 X = 0; X < detectors->length; ++X ) {
+      if ( ( stream->det[X].engine = XLALCreateSFTtoTSEngine ( 0 ) ) == NULL ) {
+        XLALDestroyFstatInputStream ( stream );
+        XLAL_ERROR_NULL ( XLAL_EFUNC );
+      }
+    }
+  }
+
+  return stream;
+
+} // XLALCreateFstatInputStream()
+
+///
+/// Free all memory associated with a stream of SFTs for \c FstatInput structures. \c FstatInput structures
+/// created from the stream by XLALCreateFstatInputFromStream() remain valid.
+///
+void
+XLALDestroyFstatInputStream ( FstatInputStream *stream  ///< [in] Stream of SFTs to be freed.
+                              )
+{
+  if ( stream == NULL ) {
+    return;
+  }
+  for ( UINT4 X = 0; X < stream->detectors.length; ++X ) {
+    FstatInputStreamDetector *det = &stream->det[X];
+    for ( UINT4 i = 0; i < det->length; ++i ) {
+      XLALDestroyCOMPLEX8Vector ( det->sfts[i].data );
+    }
+    if ( det->sfts != NULL ) {
+      XLALFree ( det->sfts );
+      XLALFree ( det->weights );
+      XLALFree ( det->states );
+    }
+    XLALDestroySFTtoTSEngine ( det->engine );
+  }
+#ifdef LAL_PTHREAD_LOCK
+  pthread_mutex_destroy ( &stream->lock );
+  pthread_mutex_destroy ( &stream->engineLock );
+#endif
+  XLALFree ( stream );
+} // XLALDestroyFstatInputStream()
+
+///
+/// Returns the frequency band which SFTs appended to a stream of SFTs must cover
+///
+int
+XLALGetFstatInputStreamSFTBand ( const FstatInputStream *stream,       ///< [in] Stream of SFTs.
+                                 REAL8 *minFreqFull,                   ///< [out] Minimum frequency which appended SFTs must cover
+                                 REAL8 *maxFreqFull                    ///< [out] Maximum frequency which appended SFTs must cover
+                                 )
+{
+  // Check input
+  XLAL_CHECK ( stream != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( minFreqFull != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( maxFreqFull != NULL, XLAL_EINVAL );
+
+  *minFreqFull = stream->minFreqFull;
+  *maxFreqFull = stream->maxFreqFull;
+
+  return XLAL_SUCCESS;
+
+} // XLALGetFstatInputStreamSFTBand()
+
+///
+/// Append SFTs from one detector to a stream of SFTs for \c FstatInput structures. The SFTs must cover the frequency
+/// band returned by XLALGetFstatInputStreamSFTBand(), and must not have the timestamps of SFTs already appended;
+/// otherwise they may be appended in any order. The SFTs are copied, and can be freed by the caller afterwards.
+///
+/// The SFTs are normalised, and their noise weights and detector states are computed, before the stream is locked
+/// to merge them into its SFTs. SFTs can therefore be appended from several threads, while another thread creates
+/// \c FstatInput structures with XLALCreateFstatInputFromStream().
+///
+int
+XLALFstatInputStreamAppendSFTs ( FstatInputStream *stream,     ///< [in/out] Stream of SFTs.
+                                 const SFTVector *sfts         ///< [in] SFTs to append, which must all be from one detector.
+                                 )
+{
+  // Check input
+  XLAL_CHECK ( stream != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( sfts != NULL && sfts->length > 0 && sfts->data != NULL, XLAL_EINVAL );
+
+  // Find the detector of the SFTs
+  UINT4 X = 0;
+  while ( X < stream->detectors.length && strncmp ( sfts->data[0].name, stream->detectors.sites[X].frDetector.prefix, 2 ) != 0 ) {
+    ++X;
+  }
+  XLAL_CHECK ( X < stream->detectors.length, XLAL_EINVAL, "SFTs from detector '%.2s' were not given to XLALCreateFstatInputStream()", sfts->data[0].name );
+
+  // Check that SFTs have the expected length, and cover the frequency band required for normalisation
+  for ( UINT4 i = 0; i < sfts->length; ++i ) {
+    const SFTtype *sft = &sfts->data[i];
+    XLAL_CHECK ( strncmp ( sft->name, sfts->data[0].name, 2 ) == 0, XLAL_EINVAL, "SFTs from detectors '%.2s' and '%.2s' cannot be appended together", sfts->data[0].name, sft->name );
+    XLAL_CHECK ( sft->data != NULL && sft->data->length > 0, XLAL_EINVAL );
+    XLAL_CHECK ( fabs ( stream->Tsft * sft->deltaF - 1.0 ) < 1e-9, XLAL_EINVAL, "SFT %u has length %g, but stream expects length %g", i, 1.0 / sft->deltaF, stream->Tsft );
+    XLAL_CHECK ( ( sft->f0 - 0.5 * sft->deltaF <= stream->minFreqFull ) && ( sft->f0 + ( sft->data->length - 0.5 ) * sft->deltaF >= stream->maxFreqFull ), XLAL_EINVAL,
+                 "SFT %u covers frequency band [%g, %g] Hz, but stream requires [%g, %g] Hz", i, sft->f0, sft->f0 + sft->data->length * sft->deltaF, stream->minFreqFull, stream->maxFreqFull );
+  }
+
+  // Copy SFTs in time order, restricted to the frequency band required for normalisation
+  SFTVector *newSFTs = NULL;
+  XLAL_CHECK ( ( newSFTs = XLALDuplicateSFTVector ( sfts ) ) != NULL, XLAL_EFUNC );
+  qsort ( newSFTs->data, newSFTs->length, sizeof(newSFTs->data[0]), XLALCompareSFTEpochs );
+  for ( UINT4 i = 1; i < newSFTs->length; ++i ) {
+    XLAL_CHECK ( XLALGPSCmp ( &newSFTs->data[i-1].epoch, &newSFTs->data[i].epoch ) != 0, XLAL_EINVAL, "SFTs to append contain duplicate timestamps" );
+  }
+  XLAL_CHECK ( XLALSFTVectorResizeBand ( newSFTs, stream->minFreqFull, stream->maxFreqFull - stream->minFreqFull ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Normalise SFTs using either running median or assumed PSD, and calculate SFT noise weights, as in XLALCreateFstatInput()
+  MultiSFTVector XLAL_INIT_DECL(multiSFTs);
+  multiSFTs.length = 1;
+  multiSFTs.data = &newSFTs;
+  MultiNoiseFloor XLAL_INIT_DECL(assumeSqrtSX);
+  if ( stream->optArgs.assumeSqrtSX != NULL ) {
+    assumeSqrtSX.length = 1;
+    assumeSqrtSX.sqrtSn[0] = stream->optArgs.assumeSqrtSX->sqrtSn[X];
+  }
+  MultiPSDVector *runningMedian;
+  XLAL_CHECK ( (runningMedian = XLALNormalizeMultiSFTVect ( &multiSFTs, stream->optArgs.runningMedianWindow, ( stream->optArgs.assumeSqrtSX != NULL ) ? &assumeSqrtSX : NULL )) != NULL, XLAL_EFUNC );
+  MultiNoiseWeights *multiNoiseWeights;
+  XLAL_CHECK ( (multiNoiseWeights = XLALComputeMultiNoiseWeights ( runningMedian, stream->optArgs.runningMedianWindow, 0 )) != NULL, XLAL_EFUNC );
+  XLALDestroyMultiPSDVector ( runningMedian );
+
+  // Remove the normalisation from the noise weights, so that weights of SFTs appended separately can be combined
+  REAL8Vector *weights = multiNoiseWeights->data[0];
+  XLAL_CHECK ( XLALVectorScaleREAL8 ( weights->data, multiNoiseWeights->Sinv_Tsft, weights->data, weights->length ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Trim SFTs back to the frequency band required by the F-statistic method; for Resamp, extend the
+  // band as done by the method setup, so that SFTs can be converted directly into heterodyned timeseries
+  XLAL_CHECK ( XLALSFTVectorResizeBand ( newSFTs, stream->minFreqMethod, stream->maxFreqMethod - stream->minFreqMethod ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( XLALFstatMethodClassIsResamp ( stream->optArgs.FstatMethod ) ) {
+    XLAL_CHECK ( XLALExtendSFTBandForResamp ( newSFTs, stream->optArgs.Dterms ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Get detector states, with a timestamp shift of Tsft/2
+  LIGOTimeGPSVector *timestamps;
+  XLAL_CHECK ( ( timestamps = XLALExtractTimestampsFromSFTs ( newSFTs ) ) != NULL, XLAL_EFUNC );
+  DetectorStateSeries *states;
+  XLAL_CHECK ( ( states = XLALGetDetectorStates ( timestamps, &stream->detectors.sites[X], stream->ephemerides, 0.5 * stream->Tsft ) ) != NULL, XLAL_EFUNC );
+
+  // Merge SFTs into the stream, which takes ownership of the SFT data
+  FSTAT_STREAM_LOCK ( &stream->lock );
+  const int retn = XLALFstatInputStreamMergeSFTs ( &stream->det[X], newSFTs, weights, states );
+  FSTAT_STREAM_UNLOCK ( &stream->lock );
+
+  // Cleanup
+  XLALDestroySFTVector ( newSFTs );
+  XLALDestroyMultiNoiseWeights ( multiNoiseWeights );
+  XLALDestroyTimestampVector ( timestamps );
+  XLALDestroyDetectorStateSeries ( states );
+
+  XLAL_CHECK ( retn == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+} // XLALFstatInputStreamAppendSFTs()
+
+///
+/// Create a fully-setup \c FstatInput structure for computing the \f$\mathcal{F}\f$-statistic using XLALComputeFstat(),
+/// from all SFTs appended so far to a stream of SFTs. There must be more than 1 SFT for each detector.
+///
+/// Since the SFTs were normalised as they were appended, this only copies the data of the stream, and sets up the
+/// F-statistic method. For \a Resamp, the SFTs of each detector are converted into a heterodyned timeseries by an
+/// engine kept by the stream, which only transforms the SFTs appended since the previous call; see XLALSFTtoTSEngineUpdate().
+/// The stream is locked only while its SFTs are copied, so that SFTs can be appended while the method is set up.
+///
+/// To refresh an analysis as new SFTs arrive, pass the \c FstatInput structure returned by the previous call as
+/// \p prevInput to re-use its workspace, then free it with XLALDestroyFstatInput().
+///
+FstatInput *
+XLALCreateFstatInputFromStream ( FstatInputStream *stream,       ///< [in/out] Stream of SFTs.
+                                 const FstatInput *prevInput      ///< [in] An \c FstatInput structure, e.g. from a previous call to this function, whose workspace can be re-used; may be NULL.
+                                 )
+{
+  // Check input
+  XLAL_CHECK_NULL ( stream != NULL, XLAL_EFAULT );
+  const FstatOptionalArgs *optArgs = &stream->optArgs;
+  const UINT4 numDetectors = stream->detectors.length;
+
+  // Create top-level input data struct
+  FstatInput* input;
+  XLAL_CHECK_NULL ( (input = XLALCalloc ( 1, sizeof(*input) )) != NULL, XLAL_ENOMEM );
+  input->method = optArgs->FstatMethod;
+  FstatCommon *common = &input->common;      // handy shortcut
+
+  // Set up workspace, re-using 'prevInput' if given
+  XLAL_CHECK_NULL ( XLALSetupFstatInputWorkspace ( input, prevInput ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Copy input parameters
+  input->Tsft = stream->Tsft;
+  input->minFreqFull = stream->minFreqFull;
+  input->maxFreqFull = stream->maxFreqFull;
+  common->detectors = stream->detectors;
+  common->allowedMismatchFromSFTLength = optArgs->allowedMismatchFromSFTLength;
+
+  // Copy timestamps, noise weights and detector states of the stream, and views of its SFTs;
+  // the SFT data of the stream does not change once appended, and so it can be read unlocked
+  MultiSFTVector *multiSFTs = NULL;
+  FSTAT_STREAM_LOCK ( &stream->lock );
+  const int retn = XLALFstatInputStreamCopySFTs ( &multiSFTs, common, stream );
+  FSTAT_STREAM_UNLOCK ( &stream->lock );
+  if ( retn != XLAL_SUCCESS ) {
+    XLALDestroyFstatInputStreamViews ( multiSFTs );
+    XLALDestroyFstatInput ( input );
+    XLAL_ERROR_NULL ( XLAL_EFUNC );
+  }
+
+  // Re-create the sky-independent barycentering quantities, since the SSB times are computed for many sky positions
+  XLAL_CHECK_NULL ( XLALAddBarycenterCacheToMultiDetectorStates ( common->multiDetectorStates ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Compute the mid-time and time-span of the SFTs
+  double Tspan = 0;
+  {
+    LIGOTimeGPS startTime = common->multiTimestamps->data[0]->data[0];
+    LIGOTimeGPS endTime = common->multiTimestamps->data[0]->data[common->multiTimestamps->data[0]->length - 1];
+    for ( UINT4 X = 1; X < numDetectors; ++X ) {
+      const LIGOTimeGPSVector *timestamps = common->multiTimestamps->data[X];
+      if ( XLALGPSCmp ( &timestamps->data[0], &startTime ) < 0 ) {
+        startTime = timestamps->data[0];
+      }
+      if ( XLALGPSCmp ( &timestamps->data[timestamps->length - 1], &endTime ) > 0 ) {
+        endTime = timestamps->data[timestamps->length - 1];
+      }
+    }
+    common->midTime = startTime;
+    Tspan = input->Tsft + XLALGPSDiff( &endTime, &startTime );
+    XLALGPSAdd ( &common->midTime, 0.5 * Tspan );
+  }
+
+  // Determine the frequency spacing: if dFreq==0, default to 1.0/Tspan and set singleFreqBin==true
+  input->singleFreqBin = (stream->dFreq == 0);
+  common->dFreq = input->singleFreqBin ? 1.0/Tspan : stream->dFreq;
+
+  // Save ephemerides and SSB precision
+  common->ephemerides = stream->ephemerides;
+  common->SSBprec = optArgs->SSBprec;
+
+  // Create cache of antenna-pattern coefficients
+  XLAL_CHECK_NULL ( ( common->AMCoeffsCache = XLALCreateFstatAMCoeffsCache ( optArgs->AMCoeffsCacheSize ) ) != NULL, XLAL_EFUNC );
+
+  // Set up method data, which takes ownership of either copies of the SFTs (Demod) or heterodyned timeseries (Resamp)
+  FstatMethodFuncs *funcs = &input->method_funcs;
+  if ( XLALFstatMethodClassIsDemod ( optArgs->FstatMethod ) ) {
+    for ( UINT4 X = 0; X < numDetectors; ++X ) {
+      for ( UINT4 i = 0; i < multiSFTs->data[X]->length; ++i ) {
+        SFTtype *sft = &multiSFTs->data[X]->data[i];
+        const COMPLEX8Vector *view = sft->data;
+        XLAL_CHECK_NULL ( ( sft->data = XLALCreateCOMPLEX8Vector ( view->length ) ) != NULL, XLAL_EFUNC );
+        memcpy ( sft->data->data, view->data, view->length * sizeof(sft->data->data[0]) );
+      }
+    }
+    XLAL_CHECK_NULL ( XLALSetupFstatDemod ( &input->method_data, common, funcs, multiSFTs, optArgs ) == XLAL_SUCCESS, XLAL_EFUNC );
+  } else {
+    MultiCOMPLEX8TimeSeries *multiTimeSeries_DET = NULL;
+    XLAL_CHECK_NULL ( ( multiTimeSeries_DET = XLALCalloc ( 1, sizeof(*multiTimeSeries_DET) ) ) != NULL, XLAL_ENOMEM );
+    XLAL_CHECK_NULL ( ( multiTimeSeries_DET->data = XLALCalloc ( numDetectors, sizeof(*multiTimeSeries_DET->data) ) ) != NULL, XLAL_ENOMEM );
+    multiTimeSeries_DET->length = numDetectors;
+
+    // Update the engines, which re-use the timeseries samples of SFTs transformed by previous calls
+    int errnum = 0;
+    FSTAT_STREAM_LOCK ( &stream->engineLock );
+    for ( UINT4 X = 0; X < numDetectors && errnum == 0; ++X ) {
+      const COMPLEX8TimeSeries *ts = XLALSFTtoTSEngineUpdate ( stream->det[X].engine, multiSFTs->data[X], NULL );
+      if ( ts == NULL || ( multiTimeSeries_DET->data[X] = XLALCutCOMPLEX8TimeSeries ( ts, 0, ts->data->length ) ) == NULL ) {
+        errnum = xlalErrno;
+      }
+    }
+    FSTAT_STREAM_UNLOCK ( &stream->engineLock );
+    XLAL_CHECK_NULL ( errnum == 0, XLAL_EFUNC, "Failed to convert SFTs into heterodyned timeseries" );
 
-  // Save ephemerides and SSB precision
-  common->ephemerides = ephemerides;
-  common->SSBprec = optArgs.SSBprec;
+    XLALDestroyFstatInputStreamViews ( multiSFTs );
 
-  // Call the appropriate method function to setup their input data structures
-  // - The method input data structures are expected to take ownership of the
-  //   SFTs, which is why 'input->common' does not retain a pointer to them
-  FstatMethodFuncs *funcs = &input->method_funcs;
-  XLAL_CHECK_NULL( (setupFuncMethod) ( &input->method_data, common, funcs, multiSFTs, &optArgs ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_NULL ( XLALSetupFstatResampFromTimeSeries ( &input->method_data, common, funcs, multiTimeSeries_DET, optArgs ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
 
   // If setup function allocated a workspace, check that it also supplied a destructor function
   XLAL_CHECK_NULL( common->workspace == NULL || funcs->workspace_destroy_func != NULL, XLAL_EFAILED );
 
-  // Cleanup
-  XLALDestroyMultiPSDVector ( runningMedian );
-
   return input;
 
-} // XLALCreateFstatInput()
+} // XLALCreateFstatInputFromStream()
 
 ///
 /// Returns the frequency band loaded from input SFTs
@@ -723,59 +1905,30 @@ XLALGetFstatInputDetectorStates ( const FstatInput* input       ///< [in] \c Fst
 } // XLALGetFstatInputDetectorStates()
 
 ///
-/// Compute the \f$\mathcal{F}\f$-statistic over a band of frequencies.
+/// Enlarge the arrays of a \c FstatResults structure, if needed, to hold the quantities in
+/// \p whatToCompute for \p numFreqBins frequency bins and \p numDetectors detectors.
 ///
-int
-XLALComputeFstat ( FstatResults **Fstats,               ///< [in/out] Address of a pointer to a \c FstatResults results structure; if \c NULL, allocate here.
-                   FstatInput *input,                   ///< [in] Input data structure created by one of the setup functions.
-                   const PulsarDopplerParams *doppler,  ///< [in] Doppler parameters, including starting frequency, at which to compute \f$2\mathcal{F}\f$
-                   const UINT4 numFreqBins,             ///< [in] Number of frequencies at which the \f$2\mathcal{F}\f$ are to be computed. Must be 1 if XLALCreateFstatInput() was passed zero \c dFreq.
-                   const FstatQuantities whatToCompute  ///< [in] Bit-field of which \f$\mathcal{F}\f$-statistic quantities to compute.
-                   )
+static int
+XLALEnlargeFstatResults ( FstatResults *Fstats, const UINT4 numDetectors, const UINT4 numFreqBins, const FstatQuantities whatToCompute )
 {
-  // Check input
-  XLAL_CHECK ( Fstats != NULL, XLAL_EINVAL);
-  XLAL_CHECK ( input != NULL, XLAL_EINVAL);
-  XLAL_CHECK ( doppler != NULL, XLAL_EINVAL);
-  XLAL_CHECK ( doppler->asini >= 0, XLAL_EINVAL);
-  XLAL_CHECK ( numFreqBins > 0, XLAL_EINVAL);
-  XLAL_CHECK ( !input->singleFreqBin || numFreqBins == 1, XLAL_EINVAL, "numFreqBins must be 1 if XLALCreateFstatInput() was passed zero dFreq" );
-  XLAL_CHECK ( whatToCompute < FSTATQ_LAST, XLAL_EINVAL);
-
-  // Check that SFT length is within allowed maximum
-  {
-    const REAL8 maxFreq = doppler->fkdot[0] + input->common.dFreq * numFreqBins;
-    XLAL_CHECK ( XLALFstatCheckSFTLengthMismatch ( input->Tsft, maxFreq, doppler->asini, doppler->period, input->common.allowedMismatchFromSFTLength ) == XLAL_SUCCESS, XLAL_EFUNC );
-  }
-
-  // Allocate results struct, if needed
-  if ( (*Fstats) == NULL ) {
-    XLAL_CHECK ( ((*Fstats) = XLALCalloc ( 1, sizeof(**Fstats) )) != NULL, XLAL_ENOMEM );
-  }
-
-  // Get constant pointer to common input data
-  const FstatCommon *common = &input->common;
-  const UINT4 numDetectors = common->detectors.length;
-
-  // Enlarge result arrays if they are too small
-  const BOOLEAN moreFreqBins = (numFreqBins > (*Fstats)->internalalloclen);
-  const BOOLEAN moreDetectors = (numDetectors > (*Fstats)->numDetectors);
+  const BOOLEAN moreFreqBins = (numFreqBins > Fstats->internalalloclen);
+  const BOOLEAN moreDetectors = (numDetectors > Fstats->numDetectors);
   if (moreFreqBins || moreDetectors)
     {
       // Enlarge multi-detector 2F array
       if ( (whatToCompute & FSTATQ_2F) && moreFreqBins )
         {
-          (*Fstats)->twoF = XLALRealloc ( (*Fstats)->twoF, numFreqBins*sizeof((*Fstats)->twoF[0]) );
-          XLAL_CHECK ( (*Fstats)->twoF != NULL, XLAL_EINVAL, "Failed to (re)allocate (*Fstats)->twoF to length %u", numFreqBins );
+          Fstats->twoF = XLALRealloc ( Fstats->twoF, numFreqBins*sizeof(Fstats->twoF[0]) );
+          XLAL_CHECK ( Fstats->twoF != NULL, XLAL_EINVAL, "Failed to (re)allocate Fstats->twoF to length %u", numFreqBins );
         }
 
       // Enlarge multi-detector Fa & Fb array
       if ( (whatToCompute & FSTATQ_FAFB) && moreFreqBins )
         {
-          (*Fstats)->Fa = XLALRealloc( (*Fstats)->Fa, numFreqBins * sizeof((*Fstats)->Fa[0]) );
-          XLAL_CHECK ( (*Fstats)->Fa != NULL, XLAL_EINVAL, "Failed to (re)allocate (*Fstats)->Fa to length %u", numFreqBins );
-          (*Fstats)->Fb = XLALRealloc( (*Fstats)->Fb, numFreqBins * sizeof((*Fstats)->Fb[0]) );
-          XLAL_CHECK ( (*Fstats)->Fb != NULL, XLAL_EINVAL, "Failed to (re)allocate (*Fstats)->Fb to length %u", numFreqBins );
+          Fstats->Fa = XLALRealloc( Fstats->Fa, numFreqBins * sizeof(Fstats->Fa[0]) );
+          XLAL_CHECK ( Fstats->Fa != NULL, XLAL_EINVAL, "Failed to (re)allocate Fstats->Fa to length %u", numFreqBins );
+          Fstats->Fb = XLALRealloc( Fstats->Fb, numFreqBins * sizeof(Fstats->Fb[0]) );
+          XLAL_CHECK ( Fstats->Fb != NULL, XLAL_EINVAL, "Failed to (re)allocate Fstats->Fb to length %u", numFreqBins );
         }
 
       // Enlarge 2F per detector arrays
@@ -783,8 +1936,8 @@ XLALComputeFstat ( FstatResults **Fstats,               ///< [in/out] Address of
         {
           for ( UINT4 X = 0; X < numDetectors; ++X )
             {
-              (*Fstats)->twoFPerDet[X] = XLALRealloc ( (*Fstats)->twoFPerDet[X], numFreqBins * sizeof((*Fstats)->twoFPerDet[X][0]) );
-              XLAL_CHECK ( (*Fstats)->twoFPerDet[X] != NULL, XLAL_EINVAL, "Failed to (re)allocate (*Fstats)->twoFPerDet[%u] to length %u", X, numFreqBins );
+              Fstats->twoFPerDet[X] = XLALRealloc ( Fstats->twoFPerDet[X], numFreqBins * sizeof(Fstats->twoFPerDet[X][0]) );
+              XLAL_CHECK ( Fstats->twoFPerDet[X] != NULL, XLAL_EINVAL, "Failed to (re)allocate Fstats->twoFPerDet[%u] to length %u", X, numFreqBins );
             }
         }
 
@@ -793,10 +1946,10 @@ XLALComputeFstat ( FstatResults **Fstats,               ///< [in/out] Address of
         {
           for ( UINT4 X = 0; X < numDetectors; ++X )
             {
-              (*Fstats)->FaPerDet[X] = XLALRealloc ( (*Fstats)->FaPerDet[X], numFreqBins*sizeof((*Fstats)->FaPerDet[X][0]) );
-              XLAL_CHECK( (*Fstats)->FaPerDet[X] != NULL, XLAL_EINVAL, "Failed to (re)allocate (*Fstats)->FaPerDet[%u] to length %u", X, numFreqBins );
-              (*Fstats)->FbPerDet[X] = XLALRealloc ( (*Fstats)->FbPerDet[X], numFreqBins*sizeof((*Fstats)->FbPerDet[X][0]) );
-              XLAL_CHECK( (*Fstats)->FbPerDet[X] != NULL, XLAL_EINVAL, "Failed to (re)allocate (*Fstats)->FbPerDet[%u] to length %u", X, numFreqBins );
+              Fstats->FaPerDet[X] = XLALRealloc ( Fstats->FaPerDet[X], numFreqBins*sizeof(Fstats->FaPerDet[X][0]) );
+              XLAL_CHECK( Fstats->FaPerDet[X] != NULL, XLAL_EINVAL, "Failed to (re)allocate Fstats->FaPerDet[%u] to length %u", X, numFreqBins );
+              Fstats->FbPerDet[X] = XLALRealloc ( Fstats->FbPerDet[X], numFreqBins*sizeof(Fstats->FbPerDet[X][0]) );
+              XLAL_CHECK( Fstats->FbPerDet[X] != NULL, XLAL_EINVAL, "Failed to (re)allocate Fstats->FbPerDet[%u] to length %u", X, numFreqBins );
             }
         }
 
@@ -804,24 +1957,66 @@ XLALComputeFstat ( FstatResults **Fstats,               ///< [in/out] Address of
       if ( (whatToCompute & FSTATQ_ATOMS_PER_DET) && moreFreqBins )
         {
           UINT4 kPrev = 0;
-          if ( (*Fstats)->multiFatoms != NULL ) {
-            kPrev = (*Fstats)->internalalloclen; // leave previously-used frequency-bins untouched
+          if ( Fstats->multiFatoms != NULL ) {
+            kPrev = Fstats->internalalloclen; // leave previously-used frequency-bins untouched
           }
 
-          (*Fstats)->multiFatoms = XLALRealloc ( (*Fstats)->multiFatoms, numFreqBins*sizeof((*Fstats)->multiFatoms[0]) );
-          XLAL_CHECK ( (*Fstats)->multiFatoms != NULL, XLAL_EINVAL, "Failed to (re)allocate (*Fstats)->multiFatoms to length %u", numFreqBins );
+          Fstats->multiFatoms = XLALRealloc ( Fstats->multiFatoms, numFreqBins*sizeof(Fstats->multiFatoms[0]) );
+          XLAL_CHECK ( Fstats->multiFatoms != NULL, XLAL_EINVAL, "Failed to (re)allocate Fstats->multiFatoms to length %u", numFreqBins );
 
           for ( UINT4 k = kPrev; k < numFreqBins; ++k ) {
-            (*Fstats)->multiFatoms[k] = NULL;
+            Fstats->multiFatoms[k] = NULL;
           }
 
         } // if Atoms_per_det to enlarge
 
       // Update allocated length of arrays
-      (*Fstats)->internalalloclen = numFreqBins;
+      Fstats->internalalloclen = numFreqBins;
 
     } // if (moreFreqBins || moreDetectors)
 
+  return XLAL_SUCCESS;
+
+} // XLALEnlargeFstatResults()
+
+///
+/// Compute the \f$\mathcal{F}\f$-statistic over a band of frequencies.
+///
+int
+XLALComputeFstat ( FstatResults **Fstats,               ///< [in/out] Address of a pointer to a \c FstatResults results structure; if \c NULL, allocate here.
+                   FstatInput *input,                   ///< [in] Input data structure created by one of the setup functions.
+                   const PulsarDopplerParams *doppler,  ///< [in] Doppler parameters, including starting frequency, at which to compute \f$2\mathcal{F}\f$
+                   const UINT4 numFreqBins,             ///< [in] Number of frequencies at which the \f$2\mathcal{F}\f$ are to be computed. Must be 1 if XLALCreateFstatInput() was passed zero \c dFreq.
+                   const FstatQuantities whatToCompute  ///< [in] Bit-field of which \f$\mathcal{F}\f$-statistic quantities to compute.
+                   )
+{
+  // Check input
+  XLAL_CHECK ( Fstats != NULL, XLAL_EINVAL);
+  XLAL_CHECK ( input != NULL, XLAL_EINVAL);
+  XLAL_CHECK ( doppler != NULL, XLAL_EINVAL);
+  XLAL_CHECK ( doppler->asini >= 0, XLAL_EINVAL);
+  XLAL_CHECK ( numFreqBins > 0, XLAL_EINVAL);
+  XLAL_CHECK ( !input->singleFreqBin || numFreqBins == 1, XLAL_EINVAL, "numFreqBins must be 1 if XLALCreateFstatInput() was passed zero dFreq" );
+  XLAL_CHECK ( whatToCompute < FSTATQ_LAST, XLAL_EINVAL);
+
+  // Check that SFT length is within allowed maximum
+  {
+    const REAL8 maxFreq = doppler->fkdot[0] + input->common.dFreq * numFreqBins;
+    XLAL_CHECK ( XLALFstatCheckSFTLengthMismatch ( input->Tsft, maxFreq, doppler->asini, doppler->period, input->common.allowedMismatchFromSFTLength ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Allocate results struct, if needed
+  if ( (*Fstats) == NULL ) {
+    XLAL_CHECK ( ((*Fstats) = XLALCalloc ( 1, sizeof(**Fstats) )) != NULL, XLAL_ENOMEM );
+  }
+
+  // Get constant pointer to common input data
+  const FstatCommon *common = &input->common;
+  const UINT4 numDetectors = common->detectors.length;
+
+  // Enlarge result arrays if they are too small
+  XLAL_CHECK ( XLALEnlargeFstatResults ( *Fstats, numDetectors, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+
   // Extrapolate parameters in 'doppler' to SFT mid-time
   PulsarDopplerParams midDoppler = (*doppler);
   {
@@ -842,7 +2037,10 @@ XLALComputeFstat ( FstatResults **Fstats,               ///< [in/out] Address of
   (*Fstats)->whatWasComputed = whatToCompute;
 
   // Call the appropriate method function to compute the F-statistic
+  XLAL_PROFILE_BEGIN ( fstat, "XLALComputeFstat" );
+  XLAL_PROFILE_COUNT ( "XLALComputeFstat:numFreqBins", numFreqBins );
   XLAL_CHECK ( (input->method_funcs.compute_func) ( *Fstats, common, input->method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_PROFILE_END ( fstat );
 
   (*Fstats)->doppler = (*doppler);
   // Record the internal reference time used, which is required to compute a correct global signal phase
@@ -852,6 +2050,209 @@ XLALComputeFstat ( FstatResults **Fstats,               ///< [in/out] Address of
 
 } // XLALComputeFstat()
 
+// Element of the list of templates processed by XLALComputeFstatBatch(), sorted by XLALCompareBatchTemplates()
+typedef struct {
+  const PulsarDopplerParams *doppler;	// template Doppler parameters
+  UINT4 index;				// index of template in input/output arrays
+  UINT4 offset;				// offset of template's first frequency bin within its frequency band group
+} BatchTemplate;
+
+// Order templates by sky position, then binary orbital parameters, then spindowns, then starting frequency, then input order
+static int
+XLALCompareBatchTemplates ( const void *x, const void *y )
+{
+  const BatchTemplate *bx = (const BatchTemplate *) x;
+  const BatchTemplate *by = (const BatchTemplate *) y;
+  const PulsarDopplerParams *dx = bx->doppler;
+  const PulsarDopplerParams *dy = by->doppler;
+#define COMPARE_BY(a, b) do { if ( (a) < (b) ) return -1; if ( (a) > (b) ) return +1; } while(0)
+  COMPARE_BY ( dx->Alpha, dy->Alpha );
+  COMPARE_BY ( dx->Delta, dy->Delta );
+  COMPARE_BY ( dx->asini, dy->asini );
+  COMPARE_BY ( dx->period, dy->period );
+  COMPARE_BY ( dx->ecc, dy->ecc );
+  COMPARE_BY ( dx->argp, dy->argp );
+  COMPARE_BY ( XLALGPSCmp ( &dx->tp, &dy->tp ), 0 );
+  COMPARE_BY ( XLALGPSCmp ( &dx->refTime, &dy->refTime ), 0 );
+  for ( UINT4 s = 1; s < PULSAR_MAX_SPINS; ++s ) {
+    COMPARE_BY ( dx->fkdot[s], dy->fkdot[s] );
+  }
+  COMPARE_BY ( dx->fkdot[0], dy->fkdot[0] );
+  COMPARE_BY ( bx->index, by->index );
+#undef COMPARE_BY
+  return 0;
+}
+
+// Return true if two templates differ only in their starting frequency
+static BOOLEAN
+XLALBatchTemplatesShareBand ( const PulsarDopplerParams *dx, const PulsarDopplerParams *dy )
+{
+  if ( dx->Alpha != dy->Alpha || dx->Delta != dy->Delta ) {
+    return 0;
+  }
+  if ( dx->asini != dy->asini || dx->period != dy->period || dx->ecc != dy->ecc || dx->argp != dy->argp || XLALGPSCmp ( &dx->tp, &dy->tp ) != 0 ) {
+    return 0;
+  }
+  if ( XLALGPSCmp ( &dx->refTime, &dy->refTime ) != 0 ) {
+    return 0;
+  }
+  for ( UINT4 s = 1; s < PULSAR_MAX_SPINS; ++s ) {
+    if ( dx->fkdot[s] != dy->fkdot[s] ) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// Copy frequency bins [offset, offset + numFreqBins) of the results for a frequency band group into the results for one of its templates
+static int
+XLALCopyBatchFstatResults ( FstatResults **Fstats, const FstatResults *groupFstats, const PulsarDopplerParams *doppler, const UINT4 offset, const UINT4 numFreqBins )
+{
+  if ( (*Fstats) == NULL ) {
+    XLAL_CHECK ( ((*Fstats) = XLALCalloc ( 1, sizeof(**Fstats) )) != NULL, XLAL_ENOMEM );
+  }
+  const FstatQuantities whatWasComputed = groupFstats->whatWasComputed;
+  const UINT4 numDetectors = groupFstats->numDetectors;
+  XLAL_CHECK ( XLALEnlargeFstatResults ( *Fstats, numDetectors, numFreqBins, whatWasComputed ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  (*Fstats)->doppler         = (*doppler);
+  (*Fstats)->refTimePhase    = groupFstats->refTimePhase;
+  (*Fstats)->dFreq           = groupFstats->dFreq;
+  (*Fstats)->numFreqBins     = numFreqBins;
+  (*Fstats)->numDetectors    = numDetectors;
+  memcpy ( (*Fstats)->detectorNames, groupFstats->detectorNames, sizeof ( (*Fstats)->detectorNames ) );
+  (*Fstats)->Mmunu           = groupFstats->Mmunu;
+  memcpy ( (*Fstats)->MmunuX, groupFstats->MmunuX, sizeof ( (*Fstats)->MmunuX ) );
+  (*Fstats)->whatWasComputed = whatWasComputed;
+
+  if ( whatWasComputed & FSTATQ_2F ) {
+    memcpy ( (*Fstats)->twoF, &groupFstats->twoF[offset], numFreqBins * sizeof ( (*Fstats)->twoF[0] ) );
+  }
+  if ( whatWasComputed & FSTATQ_FAFB ) {
+    memcpy ( (*Fstats)->Fa, &groupFstats->Fa[offset], numFreqBins * sizeof ( (*Fstats)->Fa[0] ) );
+    memcpy ( (*Fstats)->Fb, &groupFstats->Fb[offset], numFreqBins * sizeof ( (*Fstats)->Fb[0] ) );
+  }
+  for ( UINT4 X = 0; X < numDetectors; ++X )
+    {
+      if ( whatWasComputed & FSTATQ_2F_PER_DET ) {
+        memcpy ( (*Fstats)->twoFPerDet[X], &groupFstats->twoFPerDet[X][offset], numFreqBins * sizeof ( (*Fstats)->twoFPerDet[X][0] ) );
+      }
+      if ( whatWasComputed & FSTATQ_FAFB_PER_DET ) {
+        memcpy ( (*Fstats)->FaPerDet[X], &groupFstats->FaPerDet[X][offset], numFreqBins * sizeof ( (*Fstats)->FaPerDet[X][0] ) );
+        memcpy ( (*Fstats)->FbPerDet[X], &groupFstats->FbPerDet[X][offset], numFreqBins * sizeof ( (*Fstats)->FbPerDet[X][0] ) );
+      }
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALCopyBatchFstatResults()
+
+///
+/// Compute the \f$\mathcal{F}\f$-statistic over a band of frequencies for each of a batch of templates
+/// (Doppler points), using the same \c FstatInput.
+///
+/// The templates are processed grouped by sky position and binary orbital parameters, so that all
+/// sky-position-dependent quantities buffered by the \a Demod and \a Resamp methods (SSB timing,
+/// antenna-pattern coefficients, and for \a Resamp the barycentered timeseries) are computed only
+/// once per group rather than once per template.
+///
+/// In addition, templates which differ only in their starting frequency, by a whole number of
+/// frequency bins, and whose frequency bands overlap or adjoin, are computed together in a single
+/// frequency band: bins shared by several templates are computed only once, and for \a Resamp the
+/// spindown correction and FFT of the barycentered timeseries are done once for the whole band.
+/// Such templates are not combined if per-SFT \f$\mathcal{F}\f$-statistic atoms are requested.
+///
+/// Results agree with calling XLALComputeFstat() for each template in turn, up to the rounding of
+/// the frequency of each bin.
+///
+int
+XLALComputeFstatBatch ( FstatResults **batchFstats,              ///< [in/out] Array of \p numDopplers pointers to \c FstatResults results structures; any \c NULL are allocated here.
+                        FstatInput *input,                       ///< [in] Input data structure created by one of the setup functions.
+                        const PulsarDopplerParams *dopplers,     ///< [in] Array of \p numDopplers Doppler parameters, including starting frequency, at which to compute \f$2\mathcal{F}\f$
+                        const UINT4 numDopplers,                 ///< [in] Number of templates in \p dopplers.
+                        const UINT4 numFreqBins,                 ///< [in] Number of frequencies at which the \f$2\mathcal{F}\f$ are to be computed for each template.
+                        const FstatQuantities whatToCompute      ///< [in] Bit-field of which \f$\mathcal{F}\f$-statistic quantities to compute.
+                        )
+{
+  // Check input
+  XLAL_CHECK ( batchFstats != NULL, XLAL_EINVAL);
+  XLAL_CHECK ( input != NULL, XLAL_EINVAL);
+  XLAL_CHECK ( dopplers != NULL, XLAL_EINVAL);
+  XLAL_CHECK ( numDopplers > 0, XLAL_EINVAL);
+  XLAL_CHECK ( numFreqBins > 0, XLAL_EINVAL);
+
+  // Sort templates so that those sharing the same sky position and binary orbit are computed consecutively,
+  // and those which also share the same spindowns are ordered by starting frequency
+  BatchTemplate *templates = XLALCalloc ( numDopplers, sizeof(*templates) );
+  XLAL_CHECK ( templates != NULL, XLAL_ENOMEM );
+  for ( UINT4 i = 0; i < numDopplers; ++i ) {
+    templates[i].doppler = &dopplers[i];
+    templates[i].index = i;
+  }
+  qsort ( templates, numDopplers, sizeof(*templates), XLALCompareBatchTemplates );
+
+  // Bands of templates may only be combined if the F-statistic is computed on a frequency grid, without atoms
+  const REAL8 dFreq = input->common.dFreq;
+  const BOOLEAN canShareBand = !input->singleFreqBin && ( dFreq > 0 ) && !( whatToCompute & FSTATQ_ATOMS_PER_DET );
+
+  FstatResults *groupFstats = NULL;
+  int errnum = 0;
+  for ( UINT4 i = 0; i < numDopplers && errnum == 0; )
+    {
+
+      // Find the group of templates [i, iEnd) whose frequency bands overlap or adjoin on the same frequency grid
+      UINT4 iEnd = i + 1;
+      UINT4 groupNumFreqBins = numFreqBins;
+      templates[i].offset = 0;
+      while ( canShareBand && iEnd < numDopplers && XLALBatchTemplatesShareBand ( templates[i].doppler, templates[iEnd].doppler ) )
+        {
+          const REAL8 binOffset = ( templates[iEnd].doppler->fkdot[0] - templates[i].doppler->fkdot[0] ) / dFreq;
+          const REAL8 offset = round ( binOffset );
+          if ( fabs ( binOffset - offset ) > 1e-6 || offset > groupNumFreqBins ) {
+            break;
+          }
+          templates[iEnd].offset = (UINT4) offset;
+          groupNumFreqBins = GSL_MAX ( groupNumFreqBins, templates[iEnd].offset + numFreqBins );
+          ++iEnd;
+        }
+
+      if ( iEnd == i + 1 )
+        {
+          // Compute F-statistic for a single template; sky-position-dependent buffers are re-used between consecutive templates
+          const UINT4 j = templates[i].index;
+          if ( XLALComputeFstat ( &batchFstats[j], input, &dopplers[j], numFreqBins, whatToCompute ) != XLAL_SUCCESS ) {
+            errnum = xlalErrno;
+            XLALPrintError ( "%s: XLALComputeFstat() failed for template %u\n", __func__, j );
+          }
+        }
+      else
+        {
+          // Compute F-statistic once over the band of the group, and copy the band of each template
+          if ( XLALComputeFstat ( &groupFstats, input, templates[i].doppler, groupNumFreqBins, whatToCompute ) != XLAL_SUCCESS ) {
+            errnum = xlalErrno;
+            XLALPrintError ( "%s: XLALComputeFstat() failed for templates %u to %u, over %u frequency bins\n", __func__, i, iEnd - 1, groupNumFreqBins );
+          }
+          for ( UINT4 k = i; k < iEnd && errnum == 0; ++k )
+            {
+              const UINT4 j = templates[k].index;
+              if ( XLALCopyBatchFstatResults ( &batchFstats[j], groupFstats, &dopplers[j], templates[k].offset, numFreqBins ) != XLAL_SUCCESS ) {
+                errnum = xlalErrno;
+              }
+            }
+        }
+
+      i = iEnd;
+
+    } // for i < numDopplers
+
+  XLALDestroyFstatResults ( groupFstats );
+  XLALFree ( templates );
+  XLAL_CHECK ( errnum == 0, XLAL_EFUNC, "XLALComputeFstatBatch() failed with errno=%d", errnum );
+
+  return XLAL_SUCCESS;
+
+} // XLALComputeFstatBatch()
+
 ///
 /// Free all memory associated with a \c FstatInput structure.
 ///
@@ -864,7 +2265,7 @@ XLALDestroyFstatInput ( FstatInput* input       ///< [in] \c FstatInput structur
   }
   if ( input->common.isTimeslice )
     {
-      XLAL_CHECK_VOID ( input->method < FMETHOD_RESAMP_GENERIC, XLAL_EINVAL,
+      XLAL_CHECK_VOID ( XLALFstatMethodClassIsDemod ( input->method ), XLAL_EINVAL,
                         "Something is wrong: 'isTimeslice==TRUE' for non-LALDemod F-stat method '%s' is not supported!\n", XLALGetFstatInputMethodName(input));
       XLALDestroyFstatInputTimeslice_common ( &input->common );
       XLALDestroyFstatInputTimeslice_Demod ( input->method_data);
@@ -875,6 +2276,7 @@ XLALDestroyFstatInput ( FstatInput* input       ///< [in] \c FstatInput structur
   XLALDestroyMultiTimestamps ( input->common.multiTimestamps );
   XLALDestroyMultiNoiseWeights ( input->common.multiNoiseWeights );
   XLALDestroyMultiDetectorStateSeries ( input->common.multiDetectorStates );
+  XLALDestroyFstatAMCoeffsCache ( input->common.AMCoeffsCache );
 
   // Release a reference to 'common.workspace'; if there are no more outstanding references ...
   if ( --(*input->workspace_refcount) == 0 ) {
@@ -892,11 +2294,23 @@ XLALDestroyFstatInput ( FstatInput* input       ///< [in] \c FstatInput structur
     XLALPrintInfo( "%s: workspace reference count = %i\n", __func__, *input->workspace_refcount );
   }
 
+  // Detach vectors whose data point into the snapshot, so that they are not freed with the method data
+  for ( UINT4 i = 0; i < input->numSnapshotViews; ++i ) {
+    input->snapshotViews[i]->length = 0;
+    input->snapshotViews[i]->data = NULL;
+  }
+
   if ( input->method_data != NULL ) {
     // Free method-specific data using destructor function
     (input->method_funcs.method_data_destroy_func) ( input->method_data );
   }
 
+  // Release snapshot
+  if ( input->snapshotViews != NULL ) {
+    XLALFree ( input->snapshotViews );
+  }
+  XLALReleaseFstatInputSnapshot ( input->snapshot, input->snapshotSize, input->snapshotMapped );
+
   XLALFree ( input );
 
   return;
@@ -1068,15 +2482,22 @@ XLALSelectBestFstatMethod ( FstatMethodType *method )
   case FMETHOD_DEMOD_BEST:
   case FMETHOD_RESAMP_BEST:
     // If user asks for a 'best' method:
-    //   Decrement the current method, then check for the first available Fstat method. This assumes the FstatMethodType enum is ordered as follows:
-    //     FMETHOD_..._GENERIC,      (must **always** avaiable)
-    //     FMETHOD_..._OPTIMISED,    (always avaiable)
-    //     FMETHOD_..._SUPERFAST     (not always available; requires special hardware)
-    //     FMETHOD_..._BEST          (must **always** avaiable)
+    //   Select the first available method from an explicit list of candidates, ordered from fastest to slowest.
+    //   The list always ends with the 'generic' method, which must **always** be available.
+    //   'ResampBest' only selects the generic implementation; the AVX-512 and CUDA variants must be requested explicitly.
     XLALPrintInfo( "%s: trying to find best available Fstat method for '%s'\n", __func__, FstatMethodNames[*method] );
-    while ( !XLALFstatMethodIsAvailable( --( *method ) ) ) {
-      XLAL_CHECK ( FMETHOD_START < *method, XLAL_EFAILED );
-      XLALPrintInfo( "%s: Fstat method '%s' is unavailable\n",  __func__, FstatMethodNames[*method] );
+    {
+      static const FstatMethodType bestDemod[] = { FMETHOD_DEMOD_AVX512, FMETHOD_DEMOD_AVX2, FMETHOD_DEMOD_SSE, FMETHOD_DEMOD_ALTIVEC, FMETHOD_DEMOD_OPTC, FMETHOD_DEMOD_GENERIC };
+      static const FstatMethodType bestResamp[] = { FMETHOD_RESAMP_GENERIC };
+      const BOOLEAN isDemod = ( *method == FMETHOD_DEMOD_BEST );
+      const FstatMethodType *candidates = isDemod ? bestDemod : bestResamp;
+      const size_t numCandidates = isDemod ? XLAL_NUM_ELEM(bestDemod) : XLAL_NUM_ELEM(bestResamp);
+      size_t i = 0;
+      while ( !XLALFstatMethodIsAvailable( candidates[i] ) ) {
+        XLALPrintInfo( "%s: Fstat method '%s' is unavailable\n",  __func__, FstatMethodNames[candidates[i]] );
+        XLAL_CHECK ( ++i < numCandidates, XLAL_EFAILED );
+      }
+      *method = candidates[i];
     }
     XLALPrintInfo( "%s: Fstat method '%s' is available; selected as best method\n", __func__, FstatMethodNames[*method] );
     break;
@@ -1126,12 +2547,92 @@ XLALFstatMethodIsAvailable ( FstatMethodType method )
     return 0;
 #endif
 
+  case FMETHOD_DEMOD_AVX2:
+    // This method is available only if compiled with AVX2 support,
+    // and AVX2 is available on the current execution machine
+#ifdef HAVE_AVX2_COMPILER
+    return LAL_HAVE_AVX2_RUNTIME();
+#else
+    return 0;
+#endif
+
+  case FMETHOD_DEMOD_AVX512:
+    // This method is available only if compiled with AVX-512F support,
+    // and AVX-512F is available on the current execution machine
+#ifdef HAVE_AVX512F_COMPILER
+    return LAL_HAVE_AVX512F_RUNTIME();
+#else
+    return 0;
+#endif
+
+  case FMETHOD_RESAMP_AVX512:
+    // This method is available only if compiled with AVX-512F support,
+    // and AVX-512F is available on the current execution machine
+#ifdef HAVE_AVX512F_COMPILER
+    return LAL_HAVE_AVX512F_RUNTIME();
+#else
+    return 0;
+#endif
+
+  case FMETHOD_RESAMP_CUDA:
+    // This method is available only if compiled with CUDA support,
+    // and a CUDA device is available on the current execution machine
+#ifdef LALPULSAR_CUDA_ENABLED
+    return XLALResampCUDAIsAvailable_intern();
+#else
+    return 0;
+#endif
+
   default:
     return 0;
 
   }
 } // XLALFstatMethodIsAvailable()
 
+///
+/// Return true if given \c FstatMethodType is a \a Demod method, false otherwise.
+/// New methods are appended to the end of \c FstatMethodType, so method classes must not be inferred from enum ranges.
+///
+int
+XLALFstatMethodClassIsDemod ( FstatMethodType method )
+{
+  switch (method) {
+
+  case FMETHOD_DEMOD_GENERIC:
+  case FMETHOD_DEMOD_OPTC:
+  case FMETHOD_DEMOD_ALTIVEC:
+  case FMETHOD_DEMOD_SSE:
+  case FMETHOD_DEMOD_AVX2:
+  case FMETHOD_DEMOD_AVX512:
+  case FMETHOD_DEMOD_BEST:
+    return 1;
+
+  default:
+    return 0;
+
+  }
+} // XLALFstatMethodClassIsDemod()
+
+///
+/// Return true if given \c FstatMethodType is a \a Resamp method, false otherwise
+///
+int
+XLALFstatMethodClassIsResamp ( FstatMethodType method )
+{
+  switch (method) {
+
+  case FMETHOD_RESAMP_GENERIC:
+  case FMETHOD_RESAMP_AVX512:
+  case FMETHOD_RESAMP_CUDA:
+  case FMETHOD_RESAMP_BEST:
+    return 1;
+
+  default:
+    return 0;
+
+  }
+} // XLALFstatMethodClassIsResamp()
+
 ///
 /// Return pointer to a static string giving the name of the \c FstatMethodType \p method
 ///
@@ -1199,11 +2700,11 @@ XLALGetFstatTiming ( const FstatInput* input, FstatTimingGeneric *timingGeneric,
   XLAL_CHECK ( timingGeneric != NULL, XLAL_EINVAL );
   XLAL_CHECK ( timingModel != NULL, XLAL_EINVAL );
 
-  if ( input->method >= FMETHOD_DEMOD_GENERIC && input->method <= FMETHOD_DEMOD_BEST)
+  if ( XLALFstatMethodClassIsDemod ( input->method ) )
     {
       XLAL_CHECK ( XLALGetFstatTiming_Demod ( input->method_data, timingGeneric, timingModel ) == XLAL_SUCCESS, XLAL_EFUNC );
     }
-  else if ( input->method >= FMETHOD_RESAMP_GENERIC && input->method <= FMETHOD_RESAMP_BEST)
+  else if ( XLALFstatMethodClassIsResamp ( input->method ) )
     {
       XLAL_CHECK ( XLALGetFstatTiming_Resamp ( input->method_data, timingGeneric, timingModel ) == XLAL_SUCCESS, XLAL_EFUNC );
     }
@@ -1272,7 +2773,7 @@ XLALExtractResampledTimeseries ( MultiCOMPLEX8TimeSeries **multiTimeSeries_SRC_a
 {
   XLAL_CHECK ( input != NULL, XLAL_EINVAL );
   XLAL_CHECK ( ( multiTimeSeries_SRC_a != NULL ) && ( multiTimeSeries_SRC_b != NULL ) , XLAL_EINVAL );
-  XLAL_CHECK ( (input->method >= FMETHOD_RESAMP_GENERIC) && (input->method <= FMETHOD_RESAMP_BEST), XLAL_EINVAL,
+  XLAL_CHECK ( XLALFstatMethodClassIsResamp ( input->method ), XLAL_EINVAL,
                "%s() only works for resampling-Fstat methods, not with '%s'\n", __func__, XLALGetFstatInputMethodName ( input ) );
 
   XLAL_CHECK ( XLALExtractResampledTimeseries_intern ( multiTimeSeries_SRC_a, multiTimeSeries_SRC_b, input->method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -1306,7 +2807,7 @@ XLALFstatInputTimeslice ( FstatInput ** slice,                ///< [out] Address
               LAL_GPS_PRINT(*minStartGPS), LAL_GPS_PRINT(*maxStartGPS) );
 
   // only supported for 'LALDemod' Fstat methods
-  XLAL_CHECK ( input->method < FMETHOD_RESAMP_GENERIC, XLAL_EINVAL, "This function is not avavible for the chosen FstatMethod '%s'!", XLALGetFstatInputMethodName ( input ) );
+  XLAL_CHECK ( XLALFstatMethodClassIsDemod ( input->method ), XLAL_EINVAL, "This function is not avavible for the chosen FstatMethod '%s'!", XLALGetFstatInputMethodName ( input ) );
 
   const FstatCommon *common = &(input->common);
   UINT4 numIFOs = common->detectors.length;
@@ -1415,6 +2916,9 @@ XLALFstatInputTimeslice ( FstatInput ** slice,                ///< [out] Address
   (*slice)->common.multiDetectorStates = multiDetectorStates;
   (*slice)->common.multiNoiseWeights   = multiNoiseWeights;
 
+  // antenna-pattern coefficients depend on the timestamps, so the timeslice needs its own cache
+  XLAL_CHECK ( ( (*slice)->common.AMCoeffsCache = XLALCreateFstatAMCoeffsCache ( common->AMCoeffsCache->capacity ) ) != NULL, XLAL_EFUNC );
+
   (*slice)->method_data = XLALFstatInputTimeslice_Demod ( input->method_data, iStart, iEnd );
   XLAL_CHECK ( (*slice)->method_data != NULL, XLAL_EFUNC );
 
@@ -1443,7 +2947,146 @@ XLALDestroyFstatInputTimeslice_common ( FstatCommon *common )
   XLALFree ( common->multiTimestamps );
   XLALFree ( common->multiNoiseWeights );
   XLALFree ( common->multiDetectorStates );
+  XLALDestroyFstatAMCoeffsCache ( common->AMCoeffsCache );
 
   return;
 
 } // XLALDestroyFstatInputTimeslice_common()
+
+// Create an empty cache of antenna-pattern coefficients for up to 'capacity' sky positions (at least 1)
+static FstatAMCoeffsCache *
+XLALCreateFstatAMCoeffsCache ( const UINT4 capacity )
+{
+  FstatAMCoeffsCache *cache = XLALCalloc ( 1, sizeof(*cache) );
+  XLAL_CHECK_NULL ( cache != NULL, XLAL_ENOMEM );
+  if ( XLALFstatAMCoeffsCacheReserve ( cache, ( capacity > 0 ? capacity : 1 ) ) != XLAL_SUCCESS ) {
+    XLALDestroyFstatAMCoeffsCache ( cache );
+    XLAL_ERROR_NULL ( XLAL_EFUNC );
+  }
+  return cache;
+} // XLALCreateFstatAMCoeffsCache()
+
+// Free a cache of antenna-pattern coefficients, including all cached coefficients
+static void
+XLALDestroyFstatAMCoeffsCache ( FstatAMCoeffsCache *cache )
+{
+  if ( cache == NULL ) {
+    return;
+  }
+  for ( UINT4 i = 0; i < cache->length; ++i ) {
+    XLALDestroyMultiAMCoeffs ( cache->multiAMcoef[i] );
+  }
+  if ( cache->skypos != NULL ) {
+    XLALFree ( cache->skypos );
+  }
+  if ( cache->multiAMcoef != NULL ) {
+    XLALFree ( cache->multiAMcoef );
+  }
+  XLALFree ( cache );
+} // XLALDestroyFstatAMCoeffsCache()
+
+// Enlarge a cache of antenna-pattern coefficients to hold at least 'capacity' sky positions
+static int
+XLALFstatAMCoeffsCacheReserve ( FstatAMCoeffsCache *cache, const UINT4 capacity )
+{
+  if ( capacity <= cache->capacity ) {
+    return XLAL_SUCCESS;
+  }
+  XLAL_CHECK ( ( cache->skypos = XLALRealloc ( cache->skypos, capacity * sizeof(cache->skypos[0]) ) ) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( ( cache->multiAMcoef = XLALRealloc ( cache->multiAMcoef, capacity * sizeof(cache->multiAMcoef[0]) ) ) != NULL, XLAL_ENOMEM );
+  cache->capacity = capacity;
+  return XLAL_SUCCESS;
+} // XLALFstatAMCoeffsCacheReserve()
+
+// Return the index of the cache entry for the given sky position, or -1 if not cached
+static int
+XLALFstatAMCoeffsCacheFind ( const FstatAMCoeffsCache *cache, const SkyPosition *skypos )
+{
+  // search backwards from the most recently inserted entry, which is the most likely match
+  for ( UINT4 j = 0; j < cache->length; ++j ) {
+    const UINT4 i = ( cache->next + cache->length - 1 - j ) % cache->length;
+    if ( cache->skypos[i].longitude == skypos->longitude && cache->skypos[i].latitude == skypos->latitude ) {
+      return i;
+    }
+  }
+  return -1;
+} // XLALFstatAMCoeffsCacheFind()
+
+// Insert antenna-pattern coefficients for the given sky position into the cache, which takes ownership
+// of them; once the cache is full, entries are replaced in the order in which they were inserted
+static int
+XLALFstatAMCoeffsCacheInsert ( FstatAMCoeffsCache *cache, const SkyPosition *skypos, MultiAMCoeffs *multiAMcoef )
+{
+  UINT4 i = cache->next;
+  if ( cache->length < cache->capacity ) {
+    i = cache->length++;
+  } else {
+    XLALDestroyMultiAMCoeffs ( cache->multiAMcoef[i] );
+  }
+  cache->skypos[i] = *skypos;
+  cache->multiAMcoef[i] = multiAMcoef;
+  cache->next = ( i + 1 ) % cache->capacity;
+  return i;
+} // XLALFstatAMCoeffsCacheInsert()
+
+///
+/// Return the noise-weighted antenna-pattern coefficients of the F-statistic input data for the given
+/// sky position, computing them if they are not cached. The returned coefficients are owned by the cache,
+/// and remain valid until the next call to this function with the same \c FstatCommon.
+///
+const MultiAMCoeffs *
+XLALFstatGetMultiAMCoeffs ( const FstatCommon *common, const SkyPosition skypos )
+{
+  XLAL_CHECK_NULL ( common != NULL && common->AMCoeffsCache != NULL, XLAL_EINVAL );
+  FstatAMCoeffsCache *cache = common->AMCoeffsCache;
+  int i = XLALFstatAMCoeffsCacheFind ( cache, &skypos );
+  if ( i < 0 ) {
+    MultiAMCoeffs *multiAMcoef = XLALComputeMultiAMCoeffs ( common->multiDetectorStates, common->multiNoiseWeights, skypos );
+    XLAL_CHECK_NULL ( multiAMcoef != NULL, XLAL_EFUNC );
+    i = XLALFstatAMCoeffsCacheInsert ( cache, &skypos, multiAMcoef );
+  }
+  return cache->multiAMcoef[i];
+} // XLALFstatGetMultiAMCoeffs()
+
+///
+/// Pre-compute the antenna-pattern coefficients of the F-statistic input data for a list of sky positions,
+/// using XLALComputeMultiAMCoeffsBatch(), and store them in the cache of the \c FstatInput structure (which is
+/// enlarged to hold them all, if needed). Subsequent calls to XLALComputeFstat() at these sky positions then
+/// re-use the cached coefficients, as long as other sky positions do not replace them.
+///
+int
+XLALFstatInputPrecomputeAMCoeffs ( FstatInput *input,			///< [in] \c FstatInput structure.
+                                   const SkyPosition *skypos,		///< [in] Array of \p numSkypos sky positions [in equatorial coords!]
+                                   const UINT4 numSkypos		///< [in] Number of sky positions.
+                                   )
+{
+  XLAL_CHECK ( input != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( skypos != NULL || numSkypos == 0, XLAL_EINVAL );
+  FstatCommon *common = &input->common;
+  FstatAMCoeffsCache *cache = common->AMCoeffsCache;
+  XLAL_CHECK ( cache != NULL, XLAL_EINVAL );
+
+  // Select the sky positions which are not yet cached
+  SkyPosition *newSkypos = XLALCalloc ( ( numSkypos > 0 ? numSkypos : 1 ), sizeof(*newSkypos) );
+  MultiAMCoeffs **newMultiAMcoef = XLALCalloc ( ( numSkypos > 0 ? numSkypos : 1 ), sizeof(*newMultiAMcoef) );
+  XLAL_CHECK ( newSkypos != NULL && newMultiAMcoef != NULL, XLAL_ENOMEM );
+  UINT4 numNew = 0;
+  for ( UINT4 k = 0; k < numSkypos; ++k ) {
+    if ( XLALFstatAMCoeffsCacheFind ( cache, &skypos[k] ) < 0 ) {
+      newSkypos[numNew++] = skypos[k];
+    }
+  }
+
+  // Compute and cache antenna-pattern coefficients for the new sky positions
+  XLAL_CHECK ( XLALFstatAMCoeffsCacheReserve ( cache, cache->length + numNew ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK ( XLALComputeMultiAMCoeffsBatch ( newMultiAMcoef, common->multiDetectorStates, common->multiNoiseWeights, newSkypos, numNew ) == XLAL_SUCCESS, XLAL_EFUNC );
+  for ( UINT4 k = 0; k < numNew; ++k ) {
+    XLALFstatAMCoeffsCacheInsert ( cache, &newSkypos[k], newMultiAMcoef[k] );
+  }
+
+  XLALFree ( newSkypos );
+  XLALFree ( newMultiAMcoef );
+
+  return XLAL_SUCCESS;
+
+} // XLALFstatInputPrecomputeAMCoeffs()
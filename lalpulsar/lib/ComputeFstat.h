@@ -47,7 +47,17 @@ extern "C" {
 /// XLALCreateFstatInput() is provided for creating an \c FstatInput structure configured
 /// for the particular method.  The \c FstatInput structure is passed to the function
 /// XLALComputeFstat(), which computes the \f$\mathcal{F}\f$-statistic using the chosen method, and
-/// fills a \c FstatResults structure with the results.
+/// fills a \c FstatResults structure with the results. XLALComputeFstatBatch() does the same for an
+/// array of Doppler points, re-using sky-position-dependent quantities between them, and computing
+/// overlapping frequency bands of templates which differ only in frequency once. Antenna-pattern
+/// coefficients are cached in the \c FstatInput structure for the most recently visited sky positions
+/// (see \c FstatOptionalArgs::AMCoeffsCacheSize), and may be pre-computed for a list of sky positions
+/// with XLALFstatInputPrecomputeAMCoeffs().
+///
+/// For analysing a growing data set, e.g. in an online search, SFTs can instead be appended as they
+/// become available to a \c FstatInputStream, created with XLALCreateFstatInputStream(). SFTs are
+/// normalised as they are appended, possibly from several threads, and XLALCreateFstatInputFromStream()
+/// creates an \c FstatInput structure for all SFTs appended so far without re-loading any SFTs.
 ///
 /// \note The \f$\mathcal{F}\f$-statistic method codes are partly descended from earlier
 /// implementations found in:
@@ -75,6 +85,12 @@ extern "C" {
 ///
 typedef struct tagFstatInput FstatInput;
 
+///
+/// Stream of SFTs, appended as they become available, from which XLALComputeFstat() input data
+/// structures are created; see XLALCreateFstatInputStream().
+///
+typedef struct tagFstatInputStream FstatInputStream;
+
 ///
 /// A vector of XLALComputeFstat() input data structures, for e.g. computing the
 /// \f$\mathcal{F}\f$-statistic for multiple segments.
@@ -119,7 +135,14 @@ typedef enum tagFstatMethodType {
   FMETHOD_DEMOD_BEST,		///< \a Demod: best guess of the fastest available hotloop
 
   FMETHOD_RESAMP_GENERIC,	///< \a Resamp: generic implementation
-  FMETHOD_RESAMP_BEST,		///< \a Resamp: best guess of the fastest available implementation
+  FMETHOD_RESAMP_BEST,		///< \a Resamp: best guess of the fastest available implementation; always selects \c FMETHOD_RESAMP_GENERIC
+
+  // New methods are appended here, to keep the values of existing methods (e.g. in snapshot files) unchanged;
+  // use XLALFstatMethodClassIsDemod() and XLALFstatMethodClassIsResamp() instead of comparing enum values.
+  FMETHOD_RESAMP_AVX512,	///< \a Resamp: AVX-512 barycentric interpolation and heterodyne-correction kernels; must be requested explicitly
+  FMETHOD_RESAMP_CUDA,		///< \a Resamp: spindown+FFT on a CUDA device, keeping timeseries and {Fa,Fb} buffers on the device; must be requested explicitly
+  FMETHOD_DEMOD_AVX2,		///< \a Demod: AVX2 hotloop, works for any number of Dirichlet kernel terms \f$\text{Dterms}\f$
+  FMETHOD_DEMOD_AVX512,		///< \a Demod: AVX-512 hotloop, works for any number of Dirichlet kernel terms \f$\text{Dterms}\f$
 
   /// \cond DONT_DOXYGEN
   FMETHOD_END
@@ -143,7 +166,10 @@ typedef struct tagFstatOptionalArgs {
   FstatInput *prevInput;		///< An \c FstatInput structure from a previous call to XLALCreateFstatInput(); may contain common workspace data than can be re-used to save memory.
   BOOLEAN collectTiming;		///< a flag to turn on/off the collection of F-stat-method-specific timing-data
   BOOLEAN resampFFTPowerOf2;		///< \a Resamp: round up FFT lengths to next power of 2; see \c FstatMethodType.
+  UINT4 resampNumThreads;		///< \a Resamp: number of threads to spread the spindown+FFT loop over (requires OpenMP); 0 or 1 runs serially.
+  LALMemoryPlacement resampMemPlacement;	///< \a Resamp: NUMA placement of the per-thread and shared buffers of the threaded spindown+FFT loop; see \c FstatMemPlacementChoices.
   REAL8 allowedMismatchFromSFTLength;      ///<  Optional override for XLALFstatCheckSFTLengthMismatch().
+  UINT4 AMCoeffsCacheSize;		///< Number of sky positions whose antenna-pattern coefficients are cached; 0 or 1 keeps only the most recent.
 } FstatOptionalArgs;
 
 ///
@@ -328,8 +354,11 @@ REAL8 XLALFstatMaximumSFTLength ( const REAL8 maxFreq, const REAL8 binaryMaxAsin
 int XLALFstatCheckSFTLengthMismatch ( const REAL8 Tsft, const REAL8 maxFreq, const REAL8 binaryMaxAsini, const REAL8 binaryMinPeriod, const REAL8 allowedMismatch );
 
 int XLALFstatMethodIsAvailable ( FstatMethodType method );
+int XLALFstatMethodClassIsDemod ( FstatMethodType method );
+int XLALFstatMethodClassIsResamp ( FstatMethodType method );
 const CHAR *XLALFstatMethodName ( FstatMethodType method );
 const UserChoices *XLALFstatMethodChoices ( void );
+extern const UserChoices FstatMemPlacementChoices;
 
 FstatInputVector* XLALCreateFstatInputVector ( const UINT4 length );
 void XLALDestroyFstatInputVector ( FstatInputVector* input );
@@ -342,6 +371,17 @@ FstatInput *
 XLALCreateFstatInput ( const SFTCatalog *SFTcatalog, const REAL8 minCoverFreq, const REAL8 maxCoverFreq, const REAL8 dFreq,
                        const EphemerisData *ephemerides, const FstatOptionalArgs *optionalArgs );
 
+int XLALWriteFstatInputSnapshot ( const CHAR *fname, const FstatInput *input );
+FstatInput *XLALCreateFstatInputFromSnapshot ( const CHAR *fname, const EphemerisData *ephemerides, const FstatOptionalArgs *optionalArgs );
+
+FstatInputStream *
+XLALCreateFstatInputStream ( const MultiLALDetector *detectors, const REAL8 Tsft, const REAL8 minCoverFreq, const REAL8 maxCoverFreq, const REAL8 dFreq,
+                             const EphemerisData *ephemerides, const FstatOptionalArgs *optionalArgs );
+void XLALDestroyFstatInputStream ( FstatInputStream *stream );
+int XLALGetFstatInputStreamSFTBand ( const FstatInputStream *stream, REAL8 *minFreqFull, REAL8 *maxFreqFull );
+int XLALFstatInputStreamAppendSFTs ( FstatInputStream *stream, const SFTVector *sfts );
+FstatInput *XLALCreateFstatInputFromStream ( FstatInputStream *stream, const FstatInput *prevInput );
+
 int XLALGetFstatInputSFTBand ( const FstatInput *input, REAL8 *minFreqFull, REAL8 *maxFreqFull );
 const CHAR *XLALGetFstatInputMethodName ( const FstatInput* input );
 const MultiLALDetector* XLALGetFstatInputDetectors ( const FstatInput* input );
@@ -358,6 +398,11 @@ SWIGLAL(INOUT_STRUCTS(FstatResults**, Fstats));
 #endif
 int XLALComputeFstat ( FstatResults **Fstats, FstatInput *input, const PulsarDopplerParams *doppler,
                        const UINT4 numFreqBins, const FstatQuantities whatToCompute );
+#ifndef SWIG // exclude from SWIG interface
+int XLALComputeFstatBatch ( FstatResults **batchFstats, FstatInput *input, const PulsarDopplerParams *dopplers, const UINT4 numDopplers,
+                            const UINT4 numFreqBins, const FstatQuantities whatToCompute );
+int XLALFstatInputPrecomputeAMCoeffs ( FstatInput *input, const SkyPosition *skypos, const UINT4 numSkypos );
+#endif
 
 void XLALDestroyFstatInput ( FstatInput* input );
 void XLALDestroyFstatResults ( FstatResults* Fstats );
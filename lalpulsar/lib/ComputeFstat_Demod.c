@@ -75,7 +75,7 @@ typedef struct {
   REAL8 prevAlpha, prevDelta;			// buffering: previous skyposition computed
   LIGOTimeGPS prevRefTime;			// buffering: keep track of previous refTime for SSBtimes buffering
   MultiSSBtimes *prevMultiSSBtimes;		// buffering: previous multiSSB times, unique to skypos + SFTs
-  MultiAMCoeffs *prevMultiAMcoef;		// buffering: previous AM-coeffs, unique to skypos + SFTs
+  const MultiAMCoeffs *prevMultiAMcoef;		// buffering: previous AM-coeffs, unique to skypos + SFTs; owned by 'common->AMCoeffsCache'
 
   // ----- timing -----
   BOOLEAN collectTiming;			// flag whether or not to collect timing information
@@ -104,6 +104,16 @@ int XLALComputeFaFb_SSE     ( COMPLEX8 *Fa, COMPLEX8 *Fb, FstatAtomVector **Fsta
                               const PulsarSpins fkdot, const SSBtimes *tSSB, const AMCoeffs *amcoe, const UINT4 Dterms );
 #endif
 
+#ifdef HAVE_AVX2_COMPILER
+int XLALComputeFaFb_AVX2    ( COMPLEX8 *Fa, COMPLEX8 *Fb, FstatAtomVector **FstatAtoms, const SFTVector *sfts,
+                              const PulsarSpins fkdot, const SSBtimes *tSSB, const AMCoeffs *amcoe, const UINT4 Dterms );
+#endif
+
+#ifdef HAVE_AVX512F_COMPILER
+int XLALComputeFaFb_AVX512  ( COMPLEX8 *Fa, COMPLEX8 *Fb, FstatAtomVector **FstatAtoms, const SFTVector *sfts,
+                              const PulsarSpins fkdot, const SSBtimes *tSSB, const AMCoeffs *amcoe, const UINT4 Dterms );
+#endif
+
 // ----- local function definitions ----------
 static int
 XLALComputeFstatDemod ( FstatResults* Fstats,
@@ -144,7 +154,7 @@ XLALComputeFstatDemod ( FstatResults* Fstats,
   }
 
   MultiSSBtimes *multiSSB = NULL;
-  MultiAMCoeffs *multiAMcoef = NULL;
+  const MultiAMCoeffs *multiAMcoef = NULL;
   // ----- check if we have buffered SSB+AMcoef for current sky-position
   if ( (demod->prevAlpha == thisPoint.Alpha) && (demod->prevDelta == thisPoint.Delta ) &&
        (demod->prevMultiSSBtimes != NULL) && ( XLALGPSDiff(&demod->prevRefTime, &thisPoint.refTime) == 0 ) &&	// have SSB times for same reftime?
@@ -165,13 +175,12 @@ XLALComputeFstatDemod ( FstatResults* Fstats,
       skypos.longitude = thisPoint.Alpha;
       skypos.latitude  = thisPoint.Delta;
       XLAL_CHECK ( (multiSSB = XLALGetMultiSSBtimes ( multiDetStates, skypos, thisPoint.refTime, common->SSBprec )) != NULL, XLAL_EFUNC );
-      XLAL_CHECK ( (multiAMcoef = XLALComputeMultiAMCoeffs ( multiDetStates, multiWeights, skypos )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( (multiAMcoef = XLALFstatGetMultiAMCoeffs ( common, skypos )) != NULL, XLAL_EFUNC );
 
       // store these for possible later re-use in buffer
       XLALDestroyMultiSSBtimes ( demod->prevMultiSSBtimes );
       demod->prevMultiSSBtimes = multiSSB;
       demod->prevRefTime = thisPoint.refTime;
-      XLALDestroyMultiAMCoeffs ( demod->prevMultiAMcoef );
       demod->prevMultiAMcoef = multiAMcoef;
       demod->prevAlpha = thisPoint.Alpha;
       demod->prevDelta = thisPoint.Delta;
@@ -362,7 +371,6 @@ XLALDestroyDemodMethodData ( void* method_data )
 
   XLALDestroyMultiSFTVector ( demod->multiSFTs);
   XLALDestroyMultiSSBtimes  ( demod->prevMultiSSBtimes );
-  XLALDestroyMultiAMCoeffs  ( demod->prevMultiAMcoef );
   XLALFree ( demod );
 
 } // XLALDestroyDemodMethodData()
@@ -431,6 +439,16 @@ XLALSetupFstatDemod ( void **method_data,
   case FMETHOD_DEMOD_SSE:
     demod->computefafb_func = XLALComputeFaFb_SSE;
     break;
+#endif
+#ifdef HAVE_AVX2_COMPILER
+  case FMETHOD_DEMOD_AVX2:
+    demod->computefafb_func = XLALComputeFaFb_AVX2;
+    break;
+#endif
+#ifdef HAVE_AVX512F_COMPILER
+  case FMETHOD_DEMOD_AVX512:
+    demod->computefafb_func = XLALComputeFaFb_AVX512;
+    break;
 #endif
   default:
     XLAL_ERROR ( XLAL_EINVAL, "Invalid Demod hotloop optArgs->FstatMethod='%d'", optArgs->FstatMethod );
@@ -442,6 +460,20 @@ XLALSetupFstatDemod ( void **method_data,
 } // XLALSetupFstatDemod()
 
 
+int
+XLALGetFstatInputSFTs_Demod ( const MultiSFTVector **multiSFTs, UINT4 *Dterms, const void *method_data )
+{
+  XLAL_CHECK ( method_data != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( ( multiSFTs != NULL ) && ( Dterms != NULL ), XLAL_EINVAL );
+
+  const DemodMethodData *demod = (const DemodMethodData*) method_data;
+  *multiSFTs = demod->multiSFTs;
+  *Dterms = demod->Dterms;
+
+  return XLAL_SUCCESS;
+
+} // XLALGetFstatInputSFTs_Demod()
+
 int
 XLALGetFstatTiming_Demod ( const void *method_data, FstatTimingGeneric *timingGeneric, FstatTimingModel *timingModel )
 {
@@ -547,7 +579,6 @@ XLALDestroyFstatInputTimeslice_Demod ( void *method_data )
   DemodMethodData *demod = (DemodMethodData*) method_data;
 
   XLALDestroyMultiSSBtimes  ( demod->prevMultiSSBtimes );
-  XLALDestroyMultiAMCoeffs  ( demod->prevMultiAMcoef );
 
   for ( UINT4 X=0; X < demod->multiSFTs->length; X ++ ) {
     XLALFree ( demod->multiSFTs->data[X] );
@@ -0,0 +1,68 @@
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301  USA
+//
+
+/// [hotloop]
+/* AVX2 version: the sum U_alpha + i V_alpha = sum_l X_l / (kappa_max - l) over the 2*Dterms
+ * SFT bins is evaluated directly, 4 complex terms (i.e. 8 REAL4s) at a time, using full-precision
+ * divisions. Each denominator is duplicated into the real and imaginary lanes of its term.
+ */
+{
+  {
+    const REAL4 kappa_max = kappa_star + 1.0f * Dterms - 1.0f;
+    const REAL4 *Xa = (const REAL4 *) Xalpha_l;
+    const UINT4 numTerms = 2 * Dterms;
+    REAL4 U_alpha, V_alpha;
+
+    const __m256 kmax = _mm256_set1_ps ( kappa_max );
+    const __m256 step = _mm256_set1_ps ( 4.0f );
+    __m256 koff = _mm256_setr_ps ( 0.0f, 0.0f, 1.0f, 1.0f, 2.0f, 2.0f, 3.0f, 3.0f );	// exact integer offsets l
+    __m256 acc = _mm256_setzero_ps();
+    UINT4 l = 0;
+    for ( ; l + 4 <= numTerms; l += 4 )
+      {
+        const __m256 x = _mm256_loadu_ps ( &Xa[2*l] );
+        acc = _mm256_add_ps ( acc, _mm256_div_ps ( x, _mm256_sub_ps ( kmax, koff ) ) );
+        koff = _mm256_add_ps ( koff, step );
+      }
+
+    /* horizontal sum of the (re,im) pairs */
+    __m128 s = _mm_add_ps ( _mm256_castps256_ps128 ( acc ), _mm256_extractf128_ps ( acc, 1 ) );
+    s = _mm_add_ps ( s, _mm_movehl_ps ( s, s ) );
+    U_alpha = _mm_cvtss_f32 ( s );
+    V_alpha = _mm_cvtss_f32 ( _mm_shuffle_ps ( s, s, 0x1 ) );
+
+    /* remaining terms, if 2*Dterms is not a multiple of 4 */
+    for ( ; l < numTerms; l ++ )
+      {
+        const REAL4 pn = kappa_max - l;
+        U_alpha += crealf ( Xalpha_l[l] ) / pn;
+        V_alpha += cimagf ( Xalpha_l[l] ) / pn;
+      }
+
+    /* As kappa in [0, 1) we can skip the trimming step, see OptC hotloop */
+    REAL4 s_alpha, c_alpha;   /* sin(2pi kappa_alpha) and (cos(2pi kappa_alpha)-1) */
+    XLALSinCos2PiLUTtrimmed ( &s_alpha, &c_alpha, kappa_star );
+    c_alpha -= 1.0f;
+
+    realXP = s_alpha * U_alpha - c_alpha * V_alpha;
+    imagXP = c_alpha * U_alpha + s_alpha * V_alpha;
+  }
+
+  /* real- and imaginary part of e^{i 2 pi lambda_alpha } */
+  XLALSinCos2PiLUT ( &imagQ, &realQ, lambda_alpha );
+}
+/// [hotloop]
@@ -0,0 +1,59 @@
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301  USA
+//
+
+/// [hotloop]
+/* AVX-512 version: the sum U_alpha + i V_alpha = sum_l X_l / (kappa_max - l) over the 2*Dterms
+ * SFT bins is evaluated directly, 8 complex terms (i.e. 16 REAL4s) at a time, using full-precision
+ * divisions. Each denominator is duplicated into the real and imaginary lanes of its term; the
+ * last register is masked if 2*Dterms is not a multiple of 8.
+ */
+{
+  {
+    const REAL4 kappa_max = kappa_star + 1.0f * Dterms - 1.0f;
+    const REAL4 *Xa = (const REAL4 *) Xalpha_l;
+    const UINT4 numTerms = 2 * Dterms;
+
+    const __m512 kmax = _mm512_set1_ps ( kappa_max );
+    const __m512 step = _mm512_set1_ps ( 8.0f );
+    __m512 koff = _mm512_setr_ps ( 0.0f, 0.0f, 1.0f, 1.0f, 2.0f, 2.0f, 3.0f, 3.0f,
+                                   4.0f, 4.0f, 5.0f, 5.0f, 6.0f, 6.0f, 7.0f, 7.0f );	// exact integer offsets l
+    __m512 acc = _mm512_setzero_ps();
+    for ( UINT4 l = 0; l < numTerms; l += 8 )
+      {
+        const UINT4 n = ( numTerms - l < 8 ) ? numTerms - l : 8;
+        const __mmask16 mask = ( n == 8 ) ? 0xFFFF : (__mmask16) ( ( 1u << ( 2 * n ) ) - 1 );
+        const __m512 x = _mm512_maskz_loadu_ps ( mask, &Xa[2*l] );
+        acc = _mm512_add_ps ( acc, _mm512_maskz_div_ps ( mask, x, _mm512_sub_ps ( kmax, koff ) ) );
+        koff = _mm512_add_ps ( koff, step );
+      }
+
+    const REAL4 U_alpha = _mm512_mask_reduce_add_ps ( 0x5555, acc );
+    const REAL4 V_alpha = _mm512_mask_reduce_add_ps ( 0xAAAA, acc );
+
+    /* As kappa in [0, 1) we can skip the trimming step, see OptC hotloop */
+    REAL4 s_alpha, c_alpha;   /* sin(2pi kappa_alpha) and (cos(2pi kappa_alpha)-1) */
+    XLALSinCos2PiLUTtrimmed ( &s_alpha, &c_alpha, kappa_star );
+    c_alpha -= 1.0f;
+
+    realXP = s_alpha * U_alpha - c_alpha * V_alpha;
+    imagXP = c_alpha * U_alpha + s_alpha * V_alpha;
+  }
+
+  /* real- and imaginary part of e^{i 2 pi lambda_alpha } */
+  XLALSinCos2PiLUT ( &imagQ, &realQ, lambda_alpha );
+}
+/// [hotloop]
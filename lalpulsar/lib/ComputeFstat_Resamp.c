@@ -21,9 +21,13 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 #include <complex.h>
 #include <fftw3.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "ComputeFstat_internal.h"
 
@@ -34,6 +38,7 @@
 #include <lal/SinCosLUT.h>
 #include <lal/TimeSeries.h>
 #include <lal/Units.h>
+#include <lal/Window.h>
 
 ///
 /// \defgroup ComputeFstat_Resamp_c Module ComputeFstat_Resamp.c
@@ -67,6 +72,8 @@
 
 // ----- local types ----------
 
+typedef struct tagResampCUDAData ResampCUDAData;	// device-resident data of FMETHOD_RESAMP_CUDA, see ComputeFstat_Resamp_CUDA.cu
+
 // ---------- BEGIN: Resamp-specific timing model data ----------
 typedef struct tagTimings_t
 {
@@ -137,6 +144,20 @@ typedef struct tagResampWorkspace
   COMPLEX8 *Fb_k;		// properly normalized F_b(f_k) over output bins
   UINT4 numFreqBinsAlloc;	// internal: keep track of allocated length of frequency-arrays
 
+  // per-thread buffers, only allocated if the spindown+FFT loop is threaded (optArgs->resampNumThreads > 1)
+  UINT4 numThreadsAlloc;	// allocated number of per-thread buffers
+  UINT4 numSamplesFFTAlloc_th;	// allocated number of samples in each per-thread buffer
+  COMPLEX8 **TS_FFT_th;		// per-thread zero-padded, spindown-corr SRC-frame TS [allocated with XLALMallocPlaced()]
+  COMPLEX8 **FabX_Raw_th;	// per-thread raw full-band FFT result Fa,Fb [allocated with XLALMallocPlaced()]
+  COMPLEX8 *FabX_k_all;		// F_a^X(f_k), F_b^X(f_k) for all detectors X [if not returned via FstatResults]
+  UINT4 numFabXAlloc;		// internal: keep track of allocated length of FabX_k_all
+
+  // window and lookup tables of the AVX-512 barycentric interpolation kernel, only allocated for FMETHOD_RESAMP_AVX512
+  UINT4 sincTablesDterms;	// number of Dirichlet kernel terms the window and tables were created for
+  REAL8Window *sincWin;		// Hamming window of length 2*sincTablesDterms+1
+  REAL4 *sincWinSign2;		// window * alternating sign, see XLALCreateSincInterpolateTables_AVX512()
+  REAL4 *sincKOff2;		// kernel offsets, see XLALCreateSincInterpolateTables_AVX512()
+
 } ResampWorkspace;
 
 typedef struct
@@ -145,7 +166,7 @@ typedef struct
   MultiCOMPLEX8TimeSeries  *multiTimeSeries_DET;	// input SFTs converted into a heterodyned timeseries
   // ----- buffering -----
   PulsarDopplerParams prev_doppler;			// buffering: previous phase-evolution ("doppler") parameters
-  MultiAMCoeffs *multiAMcoef;				// buffered antenna-pattern functions
+  const MultiAMCoeffs *multiAMcoef;			// buffered antenna-pattern functions; owned by 'common->AMCoeffsCache'
   MultiSSBtimes *multiSSBtimes;				// buffered SSB times, including *only* sky-position corrections, not binary
   MultiSSBtimes *multiBinaryTimes;			// buffered SRC times, including both sky- and binary corrections [to avoid re-allocating this]
 
@@ -158,9 +179,17 @@ typedef struct
   UINT4 numSamplesFFT;					// length of zero-padded SRC-frame timeseries (related to dFreq)
   UINT4 decimateFFT;					// output every n-th frequency bin, with n>1 iff (dFreq > 1/Tspan), and was internally decreased by n
   fftwf_plan fftplan;					// FFT plan
+  UINT4 numThreads;					// number of threads used for the spindown+FFT loop over {X, a/b} (1 = serial)
+  LALMemoryPlacement memPlacement;			// NUMA placement of the per-thread buffers and SRC-frame timeseries of the threaded loop
+  ResampCUDAData *cuda;					// if not NULL: spindown+FFT loop is performed on a CUDA device using this data
+
+  // ----- kernels for the selected Resamp variant -----
+  BOOLEAN sinc_interp_avx512;				// use the AVX-512 barycentric interpolation kernel, see XLALSincInterpolate_Resamp()
+  int (*hetcorr_func) ( COMPLEX8 *, COMPLEX8 *, const COMPLEX8 *, const COMPLEX8 *, UINT4 );
 
   // ----- timing -----
   BOOLEAN collectTiming;				// flag whether or not to collect timing information
+  REAL8 (*gettime) ( void );				// clock of all timings: CPU time if serial, wall-clock time if the spindown+FFT loop is threaded
   FstatTimingGeneric timingGeneric;			// measured (generic) F-statistic timing values
   FstatTimingResamp  timingResamp;			// measured Resamp-specific timing model data
 
@@ -170,6 +199,8 @@ typedef struct
 // ----- local prototypes ----------
 
 int XLALSetupFstatResamp ( void **method_data, FstatCommon *common, FstatMethodFuncs* funcs, MultiSFTVector *multiSFTs, const FstatOptionalArgs *optArgs );
+int XLALSetupFstatResampFromTimeSeries ( void **method_data, FstatCommon *common, FstatMethodFuncs* funcs, MultiCOMPLEX8TimeSeries *multiTimeSeries_DET, const FstatOptionalArgs *optArgs );
+int XLALExtendSFTBandForResamp ( SFTVector *sfts, const UINT4 Dterms );
 
 static int
 XLALComputeFstatResamp ( FstatResults* Fstats,
@@ -200,6 +231,87 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,
                          const COMPLEX8TimeSeries *TimeSeries_SRC_b
                          );
 
+static int
+XLALComputeMultiFaFb_Resamp_Threaded ( ResampMethodData *resamp,
+                                       ResampWorkspace *ws,
+                                       const PulsarDopplerParams thisPoint,
+                                       REAL8 dFreq,
+                                       UINT4 numFreqBins,
+                                       COMPLEX8 *FaX_k[],
+                                       COMPLEX8 *FbX_k[]
+                                       );
+
+static int
+XLALGetFFTOutputBins_Resamp ( REAL8 *freqShift,
+                              UINT4 *offset_bins,
+                              const ResampMethodData *resamp,
+                              const PulsarDopplerParams *thisPoint,
+                              REAL8 dFreq,
+                              UINT4 numFreqBins,
+                              const COMPLEX8TimeSeries *TimeSeries_SRC
+                              );
+
+static int
+XLALComputeFabX_Resamp ( COMPLEX8 *FabX_k,
+                         COMPLEX8 *TS_FFT,
+                         COMPLEX8 *FabX_Raw,
+                         const ResampMethodData *resamp,
+                         const PulsarDopplerParams *thisPoint,
+                         REAL8 freqShift,
+                         UINT4 offset_bins,
+                         UINT4 numFreqBins,
+                         const COMPLEX8TimeSeries *TimeSeries_SRC,
+                         Timings_t *Tau,
+                         REAL8 (*gettime) ( void )
+                         );
+
+static void
+XLALNormalizeFaFb_Resamp ( COMPLEX8 *FaX_k,
+                           COMPLEX8 *FbX_k,
+                           const PulsarDopplerParams *thisPoint,
+                           REAL8 dFreq,
+                           UINT4 numFreqBins,
+                           const COMPLEX8TimeSeries *TimeSeries_SRC_a
+                           );
+
+static int
+XLALAllocResampThreadBuffers ( ResampWorkspace *ws,
+                               UINT4 numThreads,
+                               UINT4 numSamplesFFT,
+                               LALMemoryPlacement placement
+                               );
+
+static int
+XLALSincInterpolate_Resamp ( COMPLEX8Vector *y_out,
+                             const REAL8Vector *t_out,
+                             const COMPLEX8TimeSeries *ts_in,
+                             const ResampMethodData *resamp,
+                             ResampWorkspace *ws
+                             );
+
+static int
+XLALApplyAMAndHeterodyne_Generic ( COMPLEX8 *ts_a,
+                                   COMPLEX8 *ts_b,
+                                   const COMPLEX8 *fac_a,
+                                   const COMPLEX8 *fac_b,
+                                   UINT4 numSamples
+                                   );
+
+#ifdef LALPULSAR_CUDA_ENABLED
+int XLALCreateResampCUDAData ( ResampCUDAData **cuda, UINT4 numDetectors, UINT4 numSamplesSRCMax, UINT4 numSamplesFFT );
+void XLALDestroyResampCUDAData ( ResampCUDAData *cuda );
+int XLALCopyResampTimeSeriesToCUDA ( ResampCUDAData *cuda, const MultiCOMPLEX8TimeSeries *multiTimeSeries_SRC_a, const MultiCOMPLEX8TimeSeries *multiTimeSeries_SRC_b );
+int XLALComputeMultiFaFb_Resamp_CUDA ( ResampCUDAData *cuda, const PulsarDopplerParams *thisPoint, REAL8 dFreq, UINT4 numFreqBins, REAL8 freqShift, UINT4 offset_bins, UINT4 decimateFFT,
+                                       COMPLEX8 *Fa_k, COMPLEX8 *Fb_k, COMPLEX8 *FaX_k[], COMPLEX8 *FbX_k[] );
+#endif
+
+#ifdef HAVE_AVX512F_COMPILER
+int XLALCreateSincInterpolateTables_AVX512 ( REAL4 **winsign2, REAL4 **koff2, const REAL8Window *win );
+int XLALSincInterpolateCOMPLEX8TimeSeries_AVX512 ( COMPLEX8Vector *y_out, const REAL8Vector *t_out, const COMPLEX8TimeSeries *ts_in, UINT4 Dterms,
+                                                   const REAL8Window *win, const REAL4 *winsign2, const REAL4 *koff2 );
+int XLALApplyAMAndHeterodyne_AVX512 ( COMPLEX8 *ts_a, COMPLEX8 *ts_b, const COMPLEX8 *fac_a, const COMPLEX8 *fac_b, UINT4 numSamples );
+#endif
+
 static void
 XLALGetFFTPlanHints ( int * planMode,
                       double * planGenTimeoutSeconds
@@ -224,11 +336,79 @@ XLALDestroyResampWorkspace ( void *workspace )
   XLALFree ( ws->Fa_k );
   XLALFree ( ws->Fb_k );
 
+  for ( UINT4 i = 0; i < ws->numThreadsAlloc; i ++ )
+    {
+      XLALFreePlaced ( ws->TS_FFT_th[i] );
+      XLALFreePlaced ( ws->FabX_Raw_th[i] );
+    }
+  XLALFree ( ws->TS_FFT_th );
+  XLALFree ( ws->FabX_Raw_th );
+  XLALFree ( ws->FabX_k_all );
+
+  XLALDestroyREAL8Window ( ws->sincWin );
+  XLALFree ( ws->sincWinSign2 );
+  XLALFree ( ws->sincKOff2 );
+
   XLALFree ( ws );
   return;
 
 } // XLALDestroyResampWorkspace()
 
+///
+/// (Re)allocate the per-thread FFT buffers of the workspace, if more threads or longer FFTs are needed.
+/// With \c LAL_MEMORY_PLACEMENT_LOCAL, each buffer is first touched by the thread which later uses it,
+/// i.e. the thread with the same number in an OpenMP team of the same size, so that its pages are placed on
+/// the NUMA node of that thread; this assumes that threads stay on their nodes, e.g. by setting OMP_PROC_BIND.
+///
+static int
+XLALAllocResampThreadBuffers ( ResampWorkspace *ws, UINT4 numThreads, UINT4 numSamplesFFT, LALMemoryPlacement placement )
+{
+  XLAL_CHECK ( ws != NULL, XLAL_EINVAL );
+
+  if ( ( numThreads <= ws->numThreadsAlloc ) && ( numSamplesFFT <= ws->numSamplesFFTAlloc_th ) ) {
+    return XLAL_SUCCESS;
+  }
+
+  for ( UINT4 i = 0; i < ws->numThreadsAlloc; i ++ )
+    {
+      XLALFreePlaced ( ws->TS_FFT_th[i] );
+      XLALFreePlaced ( ws->FabX_Raw_th[i] );
+      ws->TS_FFT_th[i] = ws->FabX_Raw_th[i] = NULL;
+    }
+
+  const UINT4 numThreadsAlloc = MYMAX ( numThreads, ws->numThreadsAlloc );
+  const UINT4 numSamplesFFTAlloc = MYMAX ( numSamplesFFT, ws->numSamplesFFTAlloc_th );
+
+  XLAL_CHECK ( (ws->TS_FFT_th = XLALRealloc ( ws->TS_FFT_th, numThreadsAlloc * sizeof(ws->TS_FFT_th[0]) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( (ws->FabX_Raw_th = XLALRealloc ( ws->FabX_Raw_th, numThreadsAlloc * sizeof(ws->FabX_Raw_th[0]) )) != NULL, XLAL_ENOMEM );
+  ws->numThreadsAlloc = numThreadsAlloc;
+  for ( UINT4 i = 0; i < numThreadsAlloc; i ++ )
+    {
+      XLAL_CHECK ( (ws->TS_FFT_th[i]   = XLALMallocPlaced ( numSamplesFFTAlloc * sizeof(COMPLEX8), placement )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( (ws->FabX_Raw_th[i] = XLALMallocPlaced ( numSamplesFFTAlloc * sizeof(COMPLEX8), placement )) != NULL, XLAL_EFUNC );
+    }
+  ws->numSamplesFFTAlloc_th = numSamplesFFTAlloc;
+
+  // first-touch each buffer from the thread which uses it
+  if ( placement == LAL_MEMORY_PLACEMENT_LOCAL )
+    {
+#pragma omp parallel for schedule(static,1) num_threads(numThreadsAlloc)
+      for ( UINT4 i = 0; i < numThreadsAlloc; i ++ )
+        {
+#ifdef _OPENMP
+          const UINT4 thread = omp_get_thread_num();
+#else
+          const UINT4 thread = i;
+#endif
+          memset ( ws->TS_FFT_th[thread], 0, numSamplesFFTAlloc * sizeof(COMPLEX8) );
+          memset ( ws->FabX_Raw_th[thread], 0, numSamplesFFTAlloc * sizeof(COMPLEX8) );
+        }
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALAllocResampThreadBuffers()
+
 // ---------- internal functions ----------
 static void
 XLALDestroyResampMethodData ( void* method_data )
@@ -241,7 +421,6 @@ XLALDestroyResampMethodData ( void* method_data )
   // ----- free buffer
   XLALDestroyMultiCOMPLEX8TimeSeries ( resamp->multiTimeSeries_SRC_a );
   XLALDestroyMultiCOMPLEX8TimeSeries ( resamp->multiTimeSeries_SRC_b );
-  XLALDestroyMultiAMCoeffs ( resamp->multiAMcoef );
   XLALDestroyMultiSSBtimes ( resamp->multiSSBtimes );
   XLALDestroyMultiSSBtimes ( resamp->multiBinaryTimes );
 
@@ -249,10 +428,42 @@ XLALDestroyResampMethodData ( void* method_data )
   fftwf_destroy_plan ( resamp->fftplan );
   LAL_FFTW_WISDOM_UNLOCK;
 
+#ifdef LALPULSAR_CUDA_ENABLED
+  XLALDestroyResampCUDAData ( resamp->cuda );
+#endif
+
   XLALFree ( resamp );
 
 } // XLALDestroyResampMethodData()
 
+///
+/// Extend the frequency band of SFTs by the extra band needed for resampling, before they are
+/// converted into heterodyned complex timeseries [in detector frame]
+///
+int
+XLALExtendSFTBandForResamp ( SFTVector *sfts,
+                             const UINT4 Dterms
+                           )
+{
+  // Check input
+  XLAL_CHECK ( sfts != NULL && sfts->length > 0, XLAL_EINVAL );
+
+  // Extra band needed for resampling: Hamming-windowed sinc used for interpolation has a transition bandwith of
+  // TB=(4/L)*fSamp, where L=2*Dterms+1 is the window-length, and here fSamp=Band (i.e. the full SFT frequency band)
+  // However, we're only interested in the physical band and we'll be throwing away all bins outside of this.
+  // This implies that we're only affected by *half* the transition band TB/2 on either side, as the other half of TB is outside of the band of interest
+  // (and will actually get aliased, i.e. the region [-fNy - TB/2, -fNy] overlaps with [fNy-TB/2,fNy] and vice-versa: [fNy,fNy+TB/2] overlaps with [-fNy,-fNy+TB/2])
+  // ==> therefore we only need to add an extra TB/2 on each side to be able to safely avoid the transition-band effects
+  REAL8 f0 = sfts->data[0].f0;
+  REAL8 dFreq = sfts->data[0].deltaF;
+  REAL8 Band = sfts->data[0].data->length * dFreq;
+  REAL8 extraBand = 2.0  / ( 2 * Dterms + 1 ) * Band;
+  XLAL_CHECK ( XLALSFTVectorResizeBand ( sfts, f0 - extraBand, Band + 2 * extraBand ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+} // XLALExtendSFTBandForResamp()
+
 int
 XLALSetupFstatResamp ( void **method_data,
                        FstatCommon *common,
@@ -268,33 +479,93 @@ XLALSetupFstatResamp ( void **method_data,
   XLAL_CHECK ( multiSFTs != NULL, XLAL_EFAULT );
   XLAL_CHECK ( optArgs != NULL, XLAL_EFAULT );
 
+  // Extend SFT frequency band by the extra band needed for resampling
+  for ( UINT4 X = 0; X < multiSFTs->length; X ++ ) {
+    XLAL_CHECK ( XLALExtendSFTBandForResamp ( multiSFTs->data[X], optArgs->Dterms ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Convert SFTs into heterodyned complex timeseries [in detector frame]
+  MultiCOMPLEX8TimeSeries *multiTimeSeries_DET = NULL;
+  XLAL_CHECK ( (multiTimeSeries_DET = XLALMultiSFTVectorToCOMPLEX8TimeSeries ( multiSFTs )) != NULL, XLAL_EFUNC );
+
+  XLALDestroyMultiSFTVector ( multiSFTs );	// don't need them SFTs any more ...
+
+  XLAL_CHECK ( XLALSetupFstatResampFromTimeSeries ( method_data, common, funcs, multiTimeSeries_DET, optArgs ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+} // XLALSetupFstatResamp()
+
+///
+/// Set up the Resamp method data from SFTs which have already been converted into heterodyned complex timeseries
+/// [in detector frame], e.g. by XLALSetupFstatResamp(), or when loaded from a snapshot file.
+/// The method data takes ownership of 'multiTimeSeries_DET'.
+///
+int
+XLALSetupFstatResampFromTimeSeries ( void **method_data,
+                                     FstatCommon *common,
+                                     FstatMethodFuncs* funcs,
+                                     MultiCOMPLEX8TimeSeries *multiTimeSeries_DET,
+                                     const FstatOptionalArgs *optArgs
+                                   )
+{
+  // Check input
+  XLAL_CHECK ( method_data != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( common != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( funcs != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( multiTimeSeries_DET != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( optArgs != NULL, XLAL_EFAULT );
+
   // Allocate method data
   ResampMethodData *resamp = *method_data = XLALCalloc( 1, sizeof(*resamp) );
   XLAL_CHECK( resamp != NULL, XLAL_ENOMEM );
 
   resamp->Dterms = optArgs->Dterms;
+  resamp->multiTimeSeries_DET = multiTimeSeries_DET;
+
+  // Select barycentric interpolation and heterodyne-correction kernels for the user-requested Resamp variant
+  switch ( optArgs->FstatMethod ) {
+  case FMETHOD_RESAMP_GENERIC:
+    resamp->hetcorr_func = XLALApplyAMAndHeterodyne_Generic;
+    break;
+#ifdef HAVE_AVX512F_COMPILER
+  case FMETHOD_RESAMP_AVX512:
+    resamp->sinc_interp_avx512 = 1;
+    resamp->hetcorr_func = XLALApplyAMAndHeterodyne_AVX512;
+    break;
+#endif
+#ifdef LALPULSAR_CUDA_ENABLED
+  case FMETHOD_RESAMP_CUDA:	// barycentering is done on the host; device data is created below
+    resamp->hetcorr_func = XLALApplyAMAndHeterodyne_Generic;
+    break;
+#endif
+  default:
+    XLAL_ERROR ( XLAL_EINVAL, "Invalid Resamp variant optArgs->FstatMethod='%d'", optArgs->FstatMethod );
+    break;
+  }
+
+  // Number of threads to spread the spindown+FFT loop over
+  resamp->numThreads = MYMAX ( optArgs->resampNumThreads, 1 );
+  resamp->memPlacement = optArgs->resampMemPlacement;
+  XLAL_CHECK ( 0 <= (int) resamp->memPlacement && resamp->memPlacement < LAL_MEMORY_PLACEMENT_MAX, XLAL_EINVAL, "Invalid Resamp memory placement optArgs->resampMemPlacement='%d'", optArgs->resampMemPlacement );
+#ifndef _OPENMP
+  if ( resamp->numThreads > 1 ) {
+    XLALPrintWarning ("WARNING: Requested %" LAL_UINT4_FORMAT " Resamp threads, but LALPulsar was compiled without OpenMP; running serially\n", resamp->numThreads );
+    resamp->numThreads = 1;
+  }
+#endif
+  if ( optArgs->FstatMethod == FMETHOD_RESAMP_CUDA ) {
+    resamp->numThreads = 1;	// spindown+FFT loop runs on the CUDA device
+  }
+  if ( resamp->numThreads > 1 ) {
+    XLALSinCosLUTInit();	// make sure the sin/cos lookup table is initialised before it is used by multiple threads
+  }
 
   // Set method function pointers
   funcs->compute_func = XLALComputeFstatResamp;
   funcs->method_data_destroy_func = XLALDestroyResampMethodData;
   funcs->workspace_destroy_func = XLALDestroyResampWorkspace;
 
-  // Extra band needed for resampling: Hamming-windowed sinc used for interpolation has a transition bandwith of
-  // TB=(4/L)*fSamp, where L=2*Dterms+1 is the window-length, and here fSamp=Band (i.e. the full SFT frequency band)
-  // However, we're only interested in the physical band and we'll be throwing away all bins outside of this.
-  // This implies that we're only affected by *half* the transition band TB/2 on either side, as the other half of TB is outside of the band of interest
-  // (and will actually get aliased, i.e. the region [-fNy - TB/2, -fNy] overlaps with [fNy-TB/2,fNy] and vice-versa: [fNy,fNy+TB/2] overlaps with [-fNy,-fNy+TB/2])
-  // ==> therefore we only need to add an extra TB/2 on each side to be able to safely avoid the transition-band effects
-  REAL8 f0 = multiSFTs->data[0]->data[0].f0;
-  REAL8 dFreq = multiSFTs->data[0]->data[0].deltaF;
-  REAL8 Band = multiSFTs->data[0]->data[0].data->length * dFreq;
-  REAL8 extraBand = 2.0  / ( 2 * optArgs->Dterms + 1 ) * Band;
-  XLAL_CHECK ( XLALMultiSFTVectorResizeBand ( multiSFTs, f0 - extraBand, Band + 2 * extraBand ) == XLAL_SUCCESS, XLAL_EFUNC );
-  // Convert SFTs into heterodyned complex timeseries [in detector frame]
-  XLAL_CHECK ( (resamp->multiTimeSeries_DET = XLALMultiSFTVectorToCOMPLEX8TimeSeries ( multiSFTs )) != NULL, XLAL_EFUNC );
-
-  XLALDestroyMultiSFTVector ( multiSFTs );	// don't need them SFTs any more ...
-
   UINT4 numDetectors = resamp->multiTimeSeries_DET->length;
   REAL8 dt_DET       = resamp->multiTimeSeries_DET->data[0]->deltaT;
   REAL8 fHet         = resamp->multiTimeSeries_DET->data[0]->f0;
@@ -362,6 +633,12 @@ XLALSetupFstatResamp ( void **method_data,
       XLAL_CHECK ( (resamp->multiTimeSeries_SRC_a->data[X] = XLALCreateCOMPLEX8TimeSeries ( nameX, &epoch0, fHet, dt_SRC, &lalDimensionlessUnit, numSamples_SRCX )) != NULL, XLAL_EFUNC );
       XLAL_CHECK ( (resamp->multiTimeSeries_SRC_b->data[X] = XLALCreateCOMPLEX8TimeSeries ( nameX, &epoch0, fHet, dt_SRC, &lalDimensionlessUnit, numSamples_SRCX )) != NULL, XLAL_EFUNC );
 
+      // SRC-frame timeseries are read by all threads of the threaded spindown+FFT loop
+      if ( ( resamp->numThreads > 1 ) && ( resamp->memPlacement == LAL_MEMORY_PLACEMENT_INTERLEAVE ) ) {
+        XLAL_CHECK ( XLALSetMemoryPlacement ( resamp->multiTimeSeries_SRC_a->data[X]->data->data, numSamples_SRCX * sizeof(COMPLEX8), resamp->memPlacement ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLAL_CHECK ( XLALSetMemoryPlacement ( resamp->multiTimeSeries_SRC_b->data[X]->data->data, numSamples_SRCX * sizeof(COMPLEX8), resamp->memPlacement ) == XLAL_SUCCESS, XLAL_EFUNC );
+      }
+
       numSamplesMax_SRC = MYMAX ( numSamplesMax_SRC, numSamples_SRCX );
     } // for X < numDetectors
 
@@ -406,6 +683,18 @@ XLALSetupFstatResamp ( void **method_data,
       common->workspace = ws;
     } // end: if we create our own workspace
 
+  // ----- per-thread buffers for the threaded spindown+FFT loop
+  if ( resamp->numThreads > 1 ) {
+    XLAL_CHECK ( XLALAllocResampThreadBuffers ( ws, resamp->numThreads, numSamplesFFT, resamp->memPlacement ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+#ifdef LALPULSAR_CUDA_ENABLED
+  // ----- device-resident timeseries and FFT buffers
+  if ( optArgs->FstatMethod == FMETHOD_RESAMP_CUDA ) {
+    XLAL_CHECK ( XLALCreateResampCUDAData ( &resamp->cuda, numDetectors, numSamplesMax_SRC, numSamplesFFT ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+#endif
+
   // ----- compute and buffer FFT plan ----------
   int fft_plan_flags=FFTW_MEASURE;
   double fft_plan_timeout= FFTW_NO_TIMELIMIT ;
@@ -435,6 +724,8 @@ XLALSetupFstatResamp ( void **method_data,
 
   // turn on timing collection if requested
   resamp->collectTiming = optArgs->collectTiming;
+  // a threaded spindown+FFT loop is timed in wall-clock time, and so are all other timings, to use a single clock
+  resamp->gettime = ( resamp->numThreads > 1 ) ? XLALGetTimeOfDay : XLALGetCPUTime;
 
   // initialize struct for collecting timing data, store invariant 'meta' quantities about this setup
   if ( resamp->collectTiming )
@@ -485,11 +776,18 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
   REAL8 tic = 0, toc = 0;
   if ( collectTiming ) {
     XLAL_INIT_MEM ( (*Tau) );	// re-set all timings to 0 at beginning of each Fstat-call
-    ticStart = XLALGetCPUTime();
+    ticStart = resamp->gettime();
   }
   // Note: all buffering is done within that function
   XLAL_CHECK ( XLALBarycentricResampleMultiCOMPLEX8TimeSeries ( resamp, &thisPoint, common ) == XLAL_SUCCESS, XLAL_EFUNC );
 
+#ifdef LALPULSAR_CUDA_ENABLED
+  // upload SRC-frame timeseries to the device only if they were recomputed
+  if ( ( resamp->cuda != NULL ) && Tau->BufferRecomputed ) {
+    XLAL_CHECK ( XLALCopyResampTimeSeriesToCUDA ( resamp->cuda, resamp->multiTimeSeries_SRC_a, resamp->multiTimeSeries_SRC_b ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+#endif
+
   if ( whatToCompute == FSTATQ_NONE ) {
     return XLAL_SUCCESS;
   }
@@ -503,7 +801,7 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
   UINT4 numFreqBins = Fstats->numFreqBins;
 
   if ( collectTiming ) {
-    tic = XLALGetCPUTime();
+    tic = resamp->gettime();
   }
 
   // NOTE: we try to use as much existing memory as possible in FstatResults, so we only
@@ -544,49 +842,117 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
     ws->numFreqBinsAlloc = numFreqBins;	// keep track of allocated array length
   }
 
+  // threaded and CUDA spindown+FFT loops compute {Fa^X, Fb^X} for all detectors at once, so need storage for all of them;
+  // the CUDA loop also sums {Fa, Fb} on the device, and so only returns {Fa^X, Fb^X} if they are needed
+  const BOOLEAN allDetectorsAtOnce = ( resamp->numThreads > 1 ) || ( resamp->cuda != NULL );
+  const BOOLEAN needFabX = ( resamp->cuda == NULL ) || ( whatToCompute & (FSTATQ_2F_PER_DET | FSTATQ_FAFB_PER_DET) );
+  COMPLEX8 *FaX_k_th[PULSAR_MAX_DETECTORS], *FbX_k_th[PULSAR_MAX_DETECTORS];
+  if ( allDetectorsAtOnce && needFabX )
+    {
+      if ( !(whatToCompute & FSTATQ_FAFB_PER_DET) && ( 2 * numDetectors * numFreqBins > ws->numFabXAlloc ) )
+        {
+          XLAL_CHECK ( (ws->FabX_k_all = XLALRealloc ( ws->FabX_k_all, 2 * numDetectors * numFreqBins * sizeof(COMPLEX8))) != NULL, XLAL_ENOMEM );
+          ws->numFabXAlloc = 2 * numDetectors * numFreqBins;
+        }
+      for ( UINT4 X = 0; X < numDetectors; X ++ )
+        {
+          if ( whatToCompute & FSTATQ_FAFB_PER_DET )
+            {
+              FaX_k_th[X] = Fstats->FaPerDet[X];
+              FbX_k_th[X] = Fstats->FbPerDet[X];
+            }
+          else
+            {
+              FaX_k_th[X] = &ws->FabX_k_all[(2*X) * numFreqBins];
+              FbX_k_th[X] = &ws->FabX_k_all[(2*X+1) * numFreqBins];
+            }
+        }
+    }
+
   if ( collectTiming ) {
-    toc = XLALGetCPUTime();
+    toc = resamp->gettime();
     Tau->Mem = (toc-tic);	// this one doesn't scale with number of detector!
   }
   // ====================================================================================================
 
+  if ( resamp->cuda != NULL )
+    {
+#ifdef LALPULSAR_CUDA_ENABLED
+      // compute {Fa(f_k), Fb(f_k)} and, if needed, {Fa^X(f_k), Fb^X(f_k)} on the CUDA device
+      if ( collectTiming ) {
+        tic = resamp->gettime();
+      }
+      REAL8 freqShift;
+      UINT4 offset_bins;
+      XLAL_CHECK ( XLALGetFFTOutputBins_Resamp ( &freqShift, &offset_bins, resamp, &thisPoint, common->dFreq, numFreqBins, multiTimeSeries_SRC_a->data[0] ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK ( XLALComputeMultiFaFb_Resamp_CUDA ( resamp->cuda, &thisPoint, common->dFreq, numFreqBins, freqShift, offset_bins, resamp->decimateFFT,
+                                                      ws->Fa_k, ws->Fb_k, needFabX ? FaX_k_th : NULL, needFabX ? FbX_k_th : NULL ) == XLAL_SUCCESS, XLAL_EFUNC );
+      if ( collectTiming ) {
+        toc = resamp->gettime();
+        Tau->FFT += (toc-tic);	// device time is not broken down further
+      }
+#endif
+    }
+  else if ( resamp->numThreads > 1 )
+    {
+      // compute {Fa^X(f_k), Fb^X(f_k)} for all detectors X, spreading the spindown+FFT loop over threads
+      XLAL_CHECK ( XLALComputeMultiFaFb_Resamp_Threaded ( resamp, ws, thisPoint, common->dFreq, numFreqBins, FaX_k_th, FbX_k_th ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+
   // loop over detectors
   for ( UINT4 X=0; X < numDetectors; X++ )
     {
-      // if return-struct contains memory for holding FaFbPerDet: use that directly instead of local memory
-      if ( whatToCompute & FSTATQ_FAFB_PER_DET )
+      const COMPLEX8 *FaX_k = NULL, *FbX_k = NULL;
+      if ( allDetectorsAtOnce )
         {
-          ws->FaX_k = Fstats->FaPerDet[X];
-          ws->FbX_k = Fstats->FbPerDet[X];
+          if ( needFabX )
+            {
+              FaX_k = FaX_k_th[X];
+              FbX_k = FbX_k_th[X];
+            }
         }
-      const COMPLEX8TimeSeries *TimeSeriesX_SRC_a = multiTimeSeries_SRC_a->data[X];
-      const COMPLEX8TimeSeries *TimeSeriesX_SRC_b = multiTimeSeries_SRC_b->data[X];
+      else
+        {
+          // if return-struct contains memory for holding FaFbPerDet: use that directly instead of local memory
+          if ( whatToCompute & FSTATQ_FAFB_PER_DET )
+            {
+              ws->FaX_k = Fstats->FaPerDet[X];
+              ws->FbX_k = Fstats->FbPerDet[X];
+            }
+          const COMPLEX8TimeSeries *TimeSeriesX_SRC_a = multiTimeSeries_SRC_a->data[X];
+          const COMPLEX8TimeSeries *TimeSeriesX_SRC_b = multiTimeSeries_SRC_b->data[X];
 
-      // compute {Fa^X(f_k), Fb^X(f_k)}: results returned via workspace ws
-      XLAL_CHECK ( XLALComputeFaFb_Resamp ( resamp, ws, thisPoint, common->dFreq, numFreqBins, TimeSeriesX_SRC_a, TimeSeriesX_SRC_b ) == XLAL_SUCCESS, XLAL_EFUNC );
+          // compute {Fa^X(f_k), Fb^X(f_k)}: results returned via workspace ws
+          XLAL_CHECK ( XLALComputeFaFb_Resamp ( resamp, ws, thisPoint, common->dFreq, numFreqBins, TimeSeriesX_SRC_a, TimeSeriesX_SRC_b ) == XLAL_SUCCESS, XLAL_EFUNC );
+          FaX_k = ws->FaX_k;
+          FbX_k = ws->FbX_k;
+        }
 
       if ( collectTiming ) {
-        tic = XLALGetCPUTime();
+        tic = resamp->gettime();
       }
-      if ( X == 0 )
+      if ( resamp->cuda != NULL )
+        { // {Fa, Fb} were already summed on the device
+        }
+      else if ( X == 0 )
         { // avoid having to memset this array: for the first detector we *copy* results
           for ( UINT4 k = 0; k < numFreqBins; k++ )
             {
-              ws->Fa_k[k] = ws->FaX_k[k];
-              ws->Fb_k[k] = ws->FbX_k[k];
+              ws->Fa_k[k] = FaX_k[k];
+              ws->Fb_k[k] = FbX_k[k];
             }
         } // end: if X==0
       else
         { // for subsequent detectors we *add to* them
           for ( UINT4 k = 0; k < numFreqBins; k++ )
             {
-              ws->Fa_k[k] += ws->FaX_k[k];
-              ws->Fb_k[k] += ws->FbX_k[k];
+              ws->Fa_k[k] += FaX_k[k];
+              ws->Fb_k[k] += FbX_k[k];
             }
         } // end:if X>0
 
       if ( collectTiming ) {
-        toc = XLALGetCPUTime();
+        toc = resamp->gettime();
         Tau->SumFabX += (toc-tic);
         tic = toc;
       }
@@ -601,12 +967,12 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
           const REAL4 DdX_inv = 1.0f / resamp->MmunuX[X].Dd;
           for ( UINT4 k = 0; k < numFreqBins; k ++ )
             {
-              Fstats->twoFPerDet[X][k] = compute_fstat_from_fa_fb ( ws->FaX_k[k], ws->FbX_k[k], AdX, BdX, CdX, EdX, DdX_inv );
+              Fstats->twoFPerDet[X][k] = compute_fstat_from_fa_fb ( FaX_k[k], FbX_k[k], AdX, BdX, CdX, EdX, DdX_inv );
             }  // for k < numFreqBins
         } // end: if compute F_X
 
       if ( collectTiming ) {
-        toc = XLALGetCPUTime();
+        toc = resamp->gettime();
         Tau->Fab2F += ( toc - tic );
       }
 
@@ -615,7 +981,7 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
   if ( collectTiming ) {
     Tau->SumFabX /= numDetectors;
     Tau->Fab2F /= numDetectors;
-    tic = XLALGetCPUTime();
+    tic = resamp->gettime();
   }
 
   if ( whatToCompute & FSTATQ_2F )
@@ -632,7 +998,7 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
     } // if FSTATQ_2F
 
   if ( collectTiming ) {
-      toc = XLALGetCPUTime();
+      toc = resamp->gettime();
       Tau->Fab2F += ( toc - tic );
   }
 
@@ -667,7 +1033,7 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
 
   if ( collectTiming )
     {
-      tocEnd = XLALGetCPUTime();
+      tocEnd = resamp->gettime();
 
       FstatTimingGeneric *tiGen = &(resamp->timingGeneric);
       FstatTimingResamp  *tiRS  = &(resamp->timingResamp);
@@ -736,111 +1102,239 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
   XLAL_CHECK ( dFreq > 0, XLAL_EINVAL );
   XLAL_CHECK ( numFreqBins <= ws->numFreqBinsAlloc, XLAL_EINVAL );
 
-  REAL8 FreqOut0 = thisPoint.fkdot[0];
+  REAL8 freqShift;
+  UINT4 offset_bins;
+  XLAL_CHECK ( XLALGetFFTOutputBins_Resamp ( &freqShift, &offset_bins, resamp, &thisPoint, dFreq, numFreqBins, TimeSeries_SRC_a ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-  // compute frequency shift to align heterodyne frequency with output frequency bins
-  REAL8 fHet   = TimeSeries_SRC_a->f0;
-  REAL8 dt_SRC = TimeSeries_SRC_a->deltaT;
-
-  REAL8 dFreqFFT = dFreq / resamp->decimateFFT;	// internally may be using higher frequency resolution dFreqFFT than requested
-  REAL8 freqShift = remainder ( FreqOut0 - fHet, dFreq ); // frequency shift to closest bin
-  REAL8 fMinFFT = fHet + freqShift - dFreqFFT * (resamp->numSamplesFFT/2);	// we'll shift DC into the *middle bin* N/2  [N always even!]
-  XLAL_CHECK ( FreqOut0 >= fMinFFT, XLAL_EDOM, "Lowest output frequency outside the available frequency band: [FreqOut0 = %.16g] < [fMinFFT = %.16g]\n", FreqOut0, fMinFFT );
-  UINT4 offset_bins = (UINT4) lround ( ( FreqOut0 - fMinFFT ) / dFreqFFT );
-  UINT4 maxOutputBin = offset_bins + (numFreqBins - 1) * resamp->decimateFFT;
-  XLAL_CHECK ( maxOutputBin < resamp->numSamplesFFT, XLAL_EDOM, "Highest output frequency bin outside available band: [maxOutputBin = %d] >= [numSamplesFFT = %d]\n", maxOutputBin, resamp->numSamplesFFT );
-
-  FstatTimingResamp *tiRS = &(resamp->timingResamp);
-  BOOLEAN collectTiming = resamp->collectTiming;
+  Timings_t *Tau = &(resamp->timingResamp.Tau);
+  REAL8 (*gettime) ( void ) = resamp->collectTiming ? resamp->gettime : NULL;
   REAL8 tic = 0, toc = 0;
 
-  XLAL_CHECK ( resamp->numSamplesFFT >= TimeSeries_SRC_a->data->length, XLAL_EFAILED, "[numSamplesFFT = %d] < [len(TimeSeries_SRC_a) = %d]\n", resamp->numSamplesFFT, TimeSeries_SRC_a->data->length );
-  XLAL_CHECK ( resamp->numSamplesFFT >= TimeSeries_SRC_b->data->length, XLAL_EFAILED, "[numSamplesFFT = %d] < [len(TimeSeries_SRC_b) = %d]\n", resamp->numSamplesFFT, TimeSeries_SRC_b->data->length );
-
-  if ( collectTiming ) {
-    tic = XLALGetCPUTime();
-  }
-  memset ( ws->TS_FFT, 0, resamp->numSamplesFFT * sizeof(ws->TS_FFT[0]) );
   // ----- compute FaX_k
-  // apply spindown phase-factors, store result in zero-padded timeseries for 'FFT'ing
-  XLAL_CHECK ( XLALApplySpindownAndFreqShift ( ws->TS_FFT, TimeSeries_SRC_a, &thisPoint, freqShift ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK ( XLALComputeFabX_Resamp ( ws->FaX_k, ws->TS_FFT, ws->FabX_Raw, resamp, &thisPoint, freqShift, offset_bins, numFreqBins, TimeSeries_SRC_a, Tau, gettime ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-  if ( collectTiming ) {
-    toc = XLALGetCPUTime();
-    tiRS->Tau.Spin += ( toc - tic);
-    tic = toc;
+  // ----- compute FbX_k
+  XLAL_CHECK ( XLALComputeFabX_Resamp ( ws->FbX_k, ws->TS_FFT, ws->FabX_Raw, resamp, &thisPoint, freqShift, offset_bins, numFreqBins, TimeSeries_SRC_b, Tau, gettime ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // ----- normalization factors to be applied to Fa and Fb:
+  if ( gettime ) {
+    tic = gettime();
+  }
+  XLALNormalizeFaFb_Resamp ( ws->FaX_k, ws->FbX_k, &thisPoint, dFreq, numFreqBins, TimeSeries_SRC_a );
+  if ( gettime ) {
+    toc = gettime();
+    Tau->Norm += ( toc - tic);
   }
 
-  // Fourier transform the resampled Fa(t)
-  fftwf_execute_dft ( resamp->fftplan, ws->TS_FFT, ws->FabX_Raw );
+  return XLAL_SUCCESS;
 
-  if ( collectTiming ) {
-    toc = XLALGetCPUTime();
-    tiRS->Tau.FFT += ( toc - tic);
-    tic = toc;
-  }
+} // XLALComputeFaFb_Resamp()
 
-  for ( UINT4 k = 0; k < numFreqBins; k++ ) {
-    ws->FaX_k[k] = ws->FabX_Raw [ offset_bins + k * resamp->decimateFFT ];
-  }
+///
+/// Compute {Fa^X(f_k), Fb^X(f_k)} for all detectors X, spreading the 2 x numDetectors spindown+FFT computations over
+/// \c resamp->numThreads OpenMP threads, each using its own TS_FFT/FabX_Raw buffers from the workspace.
+///
+/// NOTE Timing: each stage is timed per job using the wall clock, and the job timings are summed, so that the reported
+/// per-stage costs remain comparable with (serial-equivalent) CPU time.
+///
+static int
+XLALComputeMultiFaFb_Resamp_Threaded ( ResampMethodData *resamp,		//!< [in,out] buffered resampling data and workspace
+                                       ResampWorkspace *ws,			//!< [in,out] resampling workspace, including per-thread buffers
+                                       const PulsarDopplerParams thisPoint,	//!< [in] Doppler point to compute {FaX,FbX} for
+                                       REAL8 dFreq,				//!< [in] output frequency resolution
+                                       UINT4 numFreqBins,			//!< [in] number of output frequency bins
+                                       COMPLEX8 *FaX_k[],			//!< [out] Fa^X(f_k) for each detector X
+                                       COMPLEX8 *FbX_k[]			//!< [out] Fb^X(f_k) for each detector X
+                                       )
+{
+  XLAL_CHECK ( (resamp != NULL) && (ws != NULL) && (FaX_k != NULL) && (FbX_k != NULL), XLAL_EINVAL );
+  XLAL_CHECK ( dFreq > 0, XLAL_EINVAL );
+  XLAL_CHECK ( resamp->numThreads <= ws->numThreadsAlloc, XLAL_EINVAL );
+  XLAL_CHECK ( resamp->numSamplesFFT <= ws->numSamplesFFTAlloc_th, XLAL_EINVAL );
 
-  if ( collectTiming ) {
-    toc = XLALGetCPUTime();
-    tiRS->Tau.Copy += ( toc - tic);
-    tic = toc;
+  const MultiCOMPLEX8TimeSeries *multiTimeSeries_SRC_a = resamp->multiTimeSeries_SRC_a;
+  const MultiCOMPLEX8TimeSeries *multiTimeSeries_SRC_b = resamp->multiTimeSeries_SRC_b;
+  const UINT4 numDetectors = multiTimeSeries_SRC_a->length;
+  const UINT4 numJobs = 2 * numDetectors;	// one job for each of {a,b} per detector
+
+  // all detectors share the same heterodyne frequency and SRC-frame sampling, and hence the same FFT output bins
+  REAL8 freqShift;
+  UINT4 offset_bins;
+  XLAL_CHECK ( XLALGetFFTOutputBins_Resamp ( &freqShift, &offset_bins, resamp, &thisPoint, dFreq, numFreqBins, multiTimeSeries_SRC_a->data[0] ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  REAL8 (*gettime) ( void ) = resamp->collectTiming ? resamp->gettime : NULL;
+  int retn[2 * PULSAR_MAX_DETECTORS];
+  Timings_t XLAL_INIT_DECL(Tau_job, [2 * PULSAR_MAX_DETECTORS]);
+
+#pragma omp parallel for schedule(static) num_threads(resamp->numThreads)
+  for ( UINT4 job = 0; job < numJobs; ++job )
+    {
+#ifdef _OPENMP
+      const int thread = omp_get_thread_num();
+#else
+      const int thread = 0;
+#endif
+      const UINT4 X = job / 2;
+      const COMPLEX8TimeSeries *TimeSeries_SRC = ( job % 2 == 0 ) ? multiTimeSeries_SRC_a->data[X] : multiTimeSeries_SRC_b->data[X];
+      COMPLEX8 *FabX_k = ( job % 2 == 0 ) ? FaX_k[X] : FbX_k[X];
+      retn[job] = XLALComputeFabX_Resamp ( FabX_k, ws->TS_FFT_th[thread], ws->FabX_Raw_th[thread], resamp, &thisPoint, freqShift, offset_bins, numFreqBins, TimeSeries_SRC, &Tau_job[job], gettime );
+    }
+
+  Timings_t *Tau = &(resamp->timingResamp.Tau);
+  for ( UINT4 job = 0; job < numJobs; ++job )
+    {
+      XLAL_CHECK ( retn[job] == XLAL_SUCCESS, XLAL_EFUNC, "XLALComputeFabX_Resamp() failed for detector X=%d\n", job / 2 );
+      Tau->Spin += Tau_job[job].Spin;
+      Tau->FFT  += Tau_job[job].FFT;
+      Tau->Copy += Tau_job[job].Copy;
+    }
+
+  // ----- normalization factors to be applied to Fa and Fb:
+  REAL8 tic = 0, toc = 0;
+  if ( resamp->collectTiming ) {
+    tic = resamp->gettime();
+  }
+  for ( UINT4 X = 0; X < numDetectors; X ++ )
+    {
+      XLALNormalizeFaFb_Resamp ( FaX_k[X], FbX_k[X], &thisPoint, dFreq, numFreqBins, multiTimeSeries_SRC_a->data[X] );
+    }
+  if ( resamp->collectTiming ) {
+    toc = resamp->gettime();
+    Tau->Norm += ( toc - tic);
   }
 
-  // ----- compute FbX_k
+  return XLAL_SUCCESS;
+
+} // XLALComputeMultiFaFb_Resamp_Threaded()
+
+///
+/// Compute the frequency shift that aligns the heterodyne frequency with the output frequency bins,
+/// and the offset of the first output frequency bin in the (DC-centered) FFT output
+///
+static int
+XLALGetFFTOutputBins_Resamp ( REAL8 *freqShift,				//!< [out] frequency shift to closest output bin
+                              UINT4 *offset_bins,				//!< [out] FFT bin of the first output frequency bin
+                              const ResampMethodData *resamp,		//!< [in] buffered resampling data
+                              const PulsarDopplerParams *thisPoint,	//!< [in] Doppler point to compute {FaX,FbX} for
+                              REAL8 dFreq,				//!< [in] output frequency resolution
+                              UINT4 numFreqBins,			//!< [in] number of output frequency bins
+                              const COMPLEX8TimeSeries *TimeSeries_SRC	//!< [in] SRC-frame single-IFO timeseries
+                              )
+{
+  REAL8 FreqOut0 = thisPoint->fkdot[0];
+
+  // compute frequency shift to align heterodyne frequency with output frequency bins
+  REAL8 fHet   = TimeSeries_SRC->f0;
+
+  REAL8 dFreqFFT = dFreq / resamp->decimateFFT;	// internally may be using higher frequency resolution dFreqFFT than requested
+  (*freqShift) = remainder ( FreqOut0 - fHet, dFreq ); // frequency shift to closest bin
+  REAL8 fMinFFT = fHet + (*freqShift) - dFreqFFT * (resamp->numSamplesFFT/2);	// we'll shift DC into the *middle bin* N/2  [N always even!]
+  XLAL_CHECK ( FreqOut0 >= fMinFFT, XLAL_EDOM, "Lowest output frequency outside the available frequency band: [FreqOut0 = %.16g] < [fMinFFT = %.16g]\n", FreqOut0, fMinFFT );
+  (*offset_bins) = (UINT4) lround ( ( FreqOut0 - fMinFFT ) / dFreqFFT );
+  UINT4 maxOutputBin = (*offset_bins) + (numFreqBins - 1) * resamp->decimateFFT;
+  XLAL_CHECK ( maxOutputBin < resamp->numSamplesFFT, XLAL_EDOM, "Highest output frequency bin outside available band: [maxOutputBin = %d] >= [numSamplesFFT = %d]\n", maxOutputBin, resamp->numSamplesFFT );
+
+  return XLAL_SUCCESS;
+
+} // XLALGetFFTOutputBins_Resamp()
+
+///
+/// Compute the raw (unnormalized) Fa^X(f_k) or Fb^X(f_k) of a single SRC-frame timeseries: apply spindown phase-factors,
+/// FFT, and copy out the requested output frequency bins. If \p gettime is not NULL, the time spent in each stage is
+/// added to \p Tau.
+///
+static int
+XLALComputeFabX_Resamp ( COMPLEX8 *FabX_k,				//!< [out] unnormalized Fa^X(f_k) or Fb^X(f_k) over output bins
+                         COMPLEX8 *TS_FFT,				//!< [in,out] buffer for zero-padded, spindown-corr SRC-frame TS
+                         COMPLEX8 *FabX_Raw,				//!< [in,out] buffer for raw full-band FFT result
+                         const ResampMethodData *resamp,		//!< [in] buffered resampling data
+                         const PulsarDopplerParams *thisPoint,		//!< [in] Doppler point to compute {FaX,FbX} for
+                         REAL8 freqShift,				//!< [in] frequency shift to closest output bin
+                         UINT4 offset_bins,				//!< [in] FFT bin of the first output frequency bin
+                         UINT4 numFreqBins,				//!< [in] number of output frequency bins
+                         const COMPLEX8TimeSeries *TimeSeries_SRC,	//!< [in] SRC-frame single-IFO timeseries * a(t) or b(t)
+                         Timings_t *Tau,				//!< [in,out] timings to add to
+                         REAL8 (*gettime) ( void )			//!< [in] timer function, or NULL to not collect timings
+                         )
+{
+  XLAL_CHECK ( (FabX_k != NULL) && (TS_FFT != NULL) && (FabX_Raw != NULL) && (TimeSeries_SRC != NULL) && (Tau != NULL), XLAL_EINVAL );
+  XLAL_CHECK ( resamp->numSamplesFFT >= TimeSeries_SRC->data->length, XLAL_EFAILED, "[numSamplesFFT = %d] < [len(TimeSeries_SRC) = %d]\n", resamp->numSamplesFFT, TimeSeries_SRC->data->length );
+
+  REAL8 tic = 0, toc = 0;
+
+  if ( gettime ) {
+    tic = gettime();
+  }
+  memset ( TS_FFT, 0, resamp->numSamplesFFT * sizeof(TS_FFT[0]) );
   // apply spindown phase-factors, store result in zero-padded timeseries for 'FFT'ing
-  XLAL_CHECK ( XLALApplySpindownAndFreqShift ( ws->TS_FFT, TimeSeries_SRC_b, &thisPoint, freqShift ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK ( XLALApplySpindownAndFreqShift ( TS_FFT, TimeSeries_SRC, thisPoint, freqShift ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-  if ( collectTiming ) {
-    toc = XLALGetCPUTime();
-    tiRS->Tau.Spin += ( toc - tic);
+  if ( gettime ) {
+    toc = gettime();
+    Tau->Spin += ( toc - tic);
     tic = toc;
   }
 
-  // Fourier transform the resampled Fa(t)
-  fftwf_execute_dft ( resamp->fftplan, ws->TS_FFT, ws->FabX_Raw );
+  // Fourier transform the resampled Fa(t) or Fb(t)
+  fftwf_execute_dft ( resamp->fftplan, TS_FFT, FabX_Raw );
 
-  if ( collectTiming ) {
-    toc = XLALGetCPUTime();
-    tiRS->Tau.FFT += ( toc - tic);
+  if ( gettime ) {
+    toc = gettime();
+    Tau->FFT += ( toc - tic);
     tic = toc;
   }
 
   for ( UINT4 k = 0; k < numFreqBins; k++ ) {
-    ws->FbX_k[k] = ws->FabX_Raw [ offset_bins + k * resamp->decimateFFT ];
+    FabX_k[k] = FabX_Raw [ offset_bins + k * resamp->decimateFFT ];
   }
 
-  if ( collectTiming ) {
-    toc = XLALGetCPUTime();
-    tiRS->Tau.Copy += ( toc - tic);
-    tic = toc;
+  if ( gettime ) {
+    toc = gettime();
+    Tau->Copy += ( toc - tic);
   }
 
-  // ----- normalization factors to be applied to Fa and Fb:
-  const REAL8 dtauX = GPSDIFF ( TimeSeries_SRC_a->epoch, thisPoint.refTime );
-  for ( UINT4 k = 0; k < numFreqBins; k++ )
-    {
-      REAL8 f_k = FreqOut0 + k * dFreq;
-      REAL8 cycles = - f_k * dtauX;
-      REAL4 sinphase, cosphase;
-      XLALSinCos2PiLUT ( &sinphase, &cosphase, cycles );
-      COMPLEX8 normX_k = dt_SRC * crectf ( cosphase, sinphase );
-      ws->FaX_k[k] *= normX_k;
-      ws->FbX_k[k] *= normX_k;
-    } // for k < numFreqBinsOut
+  return XLAL_SUCCESS;
 
-  if ( collectTiming ) {
-    toc = XLALGetCPUTime();
-    tiRS->Tau.Norm += ( toc - tic);
-    tic = toc;
-  }
+} // XLALComputeFabX_Resamp()
 
-  return XLAL_SUCCESS;
+///
+/// Apply the normalization factors to Fa^X(f_k) and Fb^X(f_k)
+///
+static void
+XLALNormalizeFaFb_Resamp ( COMPLEX8 *FaX_k,				//!< [in,out] Fa^X(f_k) over output bins
+                           COMPLEX8 *FbX_k,				//!< [in,out] Fb^X(f_k) over output bins
+                           const PulsarDopplerParams *thisPoint,	//!< [in] Doppler point to compute {FaX,FbX} for
+                           REAL8 dFreq,					//!< [in] output frequency resolution
+                           UINT4 numFreqBins,				//!< [in] number of output frequency bins
+                           const COMPLEX8TimeSeries *TimeSeries_SRC_a	//!< [in] SRC-frame single-IFO timeseries * a(t)
+                           )
+{
+  const REAL8 FreqOut0 = thisPoint->fkdot[0];
+  const REAL8 dt_SRC = TimeSeries_SRC_a->deltaT;
+  const REAL8 dtauX = GPSDIFF ( TimeSeries_SRC_a->epoch, thisPoint->refTime );
 
-} // XLALComputeFaFb_Resamp()
+  // compute phase factors in batches of frequency bins
+  enum { batchLen = 64 };
+  for ( UINT4 k0 = 0; k0 < numFreqBins; k0 += batchLen )
+    {
+      const UINT4 numBatch = ( numFreqBins - k0 < batchLen ) ? ( numFreqBins - k0 ) : batchLen;
+      REAL8 cycles[batchLen];
+      REAL4 sinphase[batchLen], cosphase[batchLen];
+      for ( UINT4 l = 0; l < numBatch; l++ )
+        {
+          REAL8 f_k = FreqOut0 + ( k0 + l ) * dFreq;
+          cycles[l] = - f_k * dtauX;
+        }
+      XLALSinCos2PiLUTVector ( sinphase, cosphase, cycles, numBatch );
+      for ( UINT4 l = 0; l < numBatch; l++ )
+        {
+          COMPLEX8 normX_k = dt_SRC * crectf ( cosphase[l], sinphase[l] );
+          FaX_k[k0 + l] *= normX_k;
+          FbX_k[k0 + l] *= normX_k;
+        }
+    } // for k0 < numFreqBinsOut
+
+} // XLALNormalizeFaFb_Resamp()
 
 static int
 XLALApplySpindownAndFreqShift ( COMPLEX8 *restrict xOut,      			///< [out] the spindown-corrected SRC-frame timeseries
@@ -944,7 +1438,7 @@ XLALBarycentricResampleMultiCOMPLEX8TimeSeries ( ResampMethodData *resamp,		// [
   Tau->BufferRecomputed = 1;
   resamp->timingGeneric.NBufferMisses ++;
   if ( collectTiming ) {
-    tic = XLALGetCPUTime();
+    tic = resamp->gettime();
   }
 
   MultiSSBtimes *multiSRCtimes = NULL;
@@ -957,8 +1451,7 @@ XLALBarycentricResampleMultiCOMPLEX8TimeSeries ( ResampMethodData *resamp,		// [
       skypos.longitude = thisPoint->Alpha;
       skypos.latitude  = thisPoint->Delta;
 
-      XLALDestroyMultiAMCoeffs ( resamp->multiAMcoef );
-      XLAL_CHECK ( (resamp->multiAMcoef = XLALComputeMultiAMCoeffs ( common->multiDetectorStates, common->multiNoiseWeights, skypos )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( (resamp->multiAMcoef = XLALFstatGetMultiAMCoeffs ( common, skypos )) != NULL, XLAL_EFUNC );
       resamp->Mmunu = resamp->multiAMcoef->Mmunu;
       for ( UINT4 X = 0; X < numDetectors; X ++ )
         {
@@ -1095,20 +1588,16 @@ XLALBarycentricResampleMultiCOMPLEX8TimeSeries ( ResampMethodData *resamp,		// [
       XLAL_CHECK ( ti_DET->length >= TimeSeries_SRCX_a->data->length, XLAL_EINVAL );
       UINT4 bak_length = ti_DET->length;
       ti_DET->length = TimeSeries_SRCX_a->data->length;
-      XLAL_CHECK ( XLALSincInterpolateCOMPLEX8TimeSeries ( TimeSeries_SRCX_a->data, ti_DET, TimeSeries_DETX, resamp->Dterms ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK ( XLALSincInterpolate_Resamp ( TimeSeries_SRCX_a->data, ti_DET, TimeSeries_DETX, resamp, ws ) == XLAL_SUCCESS, XLAL_EFUNC );
       ti_DET->length = bak_length;
 
       // apply heterodyne correction and AM-functions a(t) and b(t) to interpolated timeseries
-      for ( UINT4 j = 0; j < numSamples_SRCX; j ++ )
-        {
-          TimeSeries_SRCX_b->data->data[j] = TimeSeries_SRCX_a->data->data[j] * ws->TStmp2_SRC->data[j];
-          TimeSeries_SRCX_a->data->data[j] *= ws->TStmp1_SRC->data[j];
-        } // for j < numSamples_SRCX
+      XLAL_CHECK ( resamp->hetcorr_func ( TimeSeries_SRCX_a->data->data, TimeSeries_SRCX_b->data->data, ws->TStmp1_SRC->data, ws->TStmp2_SRC->data, numSamples_SRCX ) == XLAL_SUCCESS, XLAL_EFUNC );
 
     } // for X < numDetectors
 
   if ( collectTiming ) {
-    toc = XLALGetCPUTime();
+    toc = resamp->gettime();
     Tau->Bary = (toc-tic);
   }
 
@@ -1116,6 +1605,62 @@ XLALBarycentricResampleMultiCOMPLEX8TimeSeries ( ResampMethodData *resamp,		// [
 
 } // XLALBarycentricResampleMultiCOMPLEX8TimeSeries()
 
+///
+/// Barycentric interpolation of \p ts_in at the times \p t_out with the kernel of the selected Resamp variant;
+/// the window and lookup tables of the AVX-512 kernel are created once per workspace and reused across calls
+///
+static int
+XLALSincInterpolate_Resamp ( COMPLEX8Vector *y_out,		///< [out] interpolated timeseries
+                             const REAL8Vector *t_out,		///< [in] output times
+                             const COMPLEX8TimeSeries *ts_in,	///< [in] input timeseries
+                             const ResampMethodData *resamp,	///< [in] resampling method data
+                             ResampWorkspace *ws		///< [in,out] workspace holding the AVX-512 window and lookup tables
+                             )
+{
+  XLAL_CHECK ( ws != NULL, XLAL_EFAULT );
+  if ( ! resamp->sinc_interp_avx512 ) {
+    return XLALSincInterpolateCOMPLEX8TimeSeries ( y_out, t_out, ts_in, resamp->Dterms );
+  }
+#ifdef HAVE_AVX512F_COMPILER
+  if ( ( ws->sincWin == NULL ) || ( ws->sincTablesDterms != resamp->Dterms ) )
+    {
+      XLALDestroyREAL8Window ( ws->sincWin );
+      XLALFree ( ws->sincWinSign2 );
+      XLALFree ( ws->sincKOff2 );
+      ws->sincWinSign2 = ws->sincKOff2 = NULL;
+      XLAL_CHECK ( ( ws->sincWin = XLALCreateHammingREAL8Window ( 2 * resamp->Dterms + 1 ) ) != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( XLALCreateSincInterpolateTables_AVX512 ( &ws->sincWinSign2, &ws->sincKOff2, ws->sincWin ) == XLAL_SUCCESS, XLAL_EFUNC );
+      ws->sincTablesDterms = resamp->Dterms;
+    }
+  return XLALSincInterpolateCOMPLEX8TimeSeries_AVX512 ( y_out, t_out, ts_in, resamp->Dterms, ws->sincWin, ws->sincWinSign2, ws->sincKOff2 );
+#else
+  XLAL_ERROR ( XLAL_EFAILED, "LALPulsar was compiled without AVX-512 support\n" );
+#endif
+
+} // XLALSincInterpolate_Resamp()
+
+///
+/// Generic heterodyne-correction and AM-function kernel: given the interpolated SRC-frame timeseries \p ts_a,
+/// compute \f$b_j = a_j\,f^b_j\f$ and \f$a_j \to a_j\,f^a_j\f$
+///
+static int
+XLALApplyAMAndHeterodyne_Generic ( COMPLEX8 *ts_a,		///< [in,out] interpolated SRC-frame timeseries, multiplied by \p fac_a on output
+                                   COMPLEX8 *ts_b,		///< [out] interpolated SRC-frame timeseries multiplied by \p fac_b
+                                   const COMPLEX8 *fac_a,	///< [in] heterodyne-correction times a(t) factors
+                                   const COMPLEX8 *fac_b,	///< [in] heterodyne-correction times b(t) factors
+                                   UINT4 numSamples		///< [in] number of samples
+                                   )
+{
+  for ( UINT4 j = 0; j < numSamples; j ++ )
+    {
+      ts_b[j] = ts_a[j] * fac_b[j];
+      ts_a[j] *= fac_a[j];
+    } // for j < numSamples
+
+  return XLAL_SUCCESS;
+
+} // XLALApplyAMAndHeterodyne_Generic()
+
 static void
 XLALGetFFTPlanHints ( int * planMode,
                       double * planGenTimeoutSeconds
@@ -1166,6 +1711,20 @@ XLALExtractResampledTimeseries_intern ( MultiCOMPLEX8TimeSeries **multiTimeSerie
 
 } // XLALExtractResampledTimeseries_intern()
 
+int
+XLALGetFstatInputTimeSeries_Resamp ( const MultiCOMPLEX8TimeSeries **multiTimeSeries_DET, UINT4 *Dterms, const void *method_data )
+{
+  XLAL_CHECK ( method_data != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( ( multiTimeSeries_DET != NULL ) && ( Dterms != NULL ), XLAL_EINVAL );
+
+  const ResampMethodData *resamp = (const ResampMethodData *) method_data;
+  *multiTimeSeries_DET = resamp->multiTimeSeries_DET;
+  *Dterms = resamp->Dterms;
+
+  return XLAL_SUCCESS;
+
+} // XLALGetFstatInputTimeSeries_Resamp()
+
 int
 XLALGetFstatTiming_Resamp ( const void *method_data, FstatTimingGeneric *timingGeneric, FstatTimingModel *timingModel )
 {
@@ -0,0 +1,231 @@
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301  USA
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <complex.h>
+
+#include <immintrin.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/Date.h>
+#include <lal/SinCosLUT.h>
+#include <lal/Window.h>
+
+///
+/// \file ComputeFstat_Resamp_AVX512.c
+/// \ingroup ComputeFstat_Resamp_c
+/// \brief AVX-512 kernels for the \a Resamp barycentric interpolation and heterodyne correction
+///
+/// These kernels are used by \c FMETHOD_RESAMP_AVX512, and must give the same results (to REAL4
+/// precision) as the generic kernels XLALSincInterpolateCOMPLEX8TimeSeries() and
+/// XLALApplyAMAndHeterodyne_Generic().
+///
+
+#if !defined(__AVX512F__)
+#error "ComputeFstat_Resamp_AVX512.c must be compiled with AVX-512F support"
+#endif
+
+// ----- local macros ----------
+#define OOPI         (1.0 / LAL_PI)		// 1/pi
+#define LD_SMALL4    (2.0e-4)			// "small" number for REAL4: same as XLALSincInterpolateCOMPLEX8TimeSeries()
+
+// number of COMPLEX8 samples held by one AVX-512 register
+#define NCPLX 8
+
+int XLALCreateSincInterpolateTables_AVX512 ( REAL4 **winsign2, REAL4 **koff2, const REAL8Window *win );
+int XLALSincInterpolateCOMPLEX8TimeSeries_AVX512 ( COMPLEX8Vector *y_out, const REAL8Vector *t_out, const COMPLEX8TimeSeries *ts_in, UINT4 Dterms,
+                                                   const REAL8Window *win, const REAL4 *winsign2, const REAL4 *koff2 );
+int XLALApplyAMAndHeterodyne_AVX512 ( COMPLEX8 *ts_a, COMPLEX8 *ts_b, const COMPLEX8 *fac_a, const COMPLEX8 *fac_b, UINT4 numSamples );
+
+///
+/// Create the lookup tables used by XLALSincInterpolateCOMPLEX8TimeSeries_AVX512() for a Hamming window \p win
+/// of length \f$2\,\text{Dterms}+1\f$: (window * alternating sign) and kernel offsets k, each duplicated into
+/// (re,im) lanes. They only depend on Dterms, and so can be kept between calls; free them with XLALFree().
+///
+int
+XLALCreateSincInterpolateTables_AVX512 ( REAL4 **winsign2,		///< [out] window * alternating sign
+                                         REAL4 **koff2,			///< [out] kernel offsets
+                                         const REAL8Window *win		///< [in] Hamming window of length 2*Dterms+1
+                                         )
+{
+  XLAL_CHECK ( winsign2 != NULL && (*winsign2) == NULL, XLAL_EINVAL );
+  XLAL_CHECK ( koff2 != NULL && (*koff2) == NULL, XLAL_EINVAL );
+  XLAL_CHECK ( win != NULL, XLAL_EINVAL );
+
+  const UINT4 winLen = win->data->length;
+  const UINT4 numChunks = ( winLen + NCPLX - 1 ) / NCPLX;
+
+  // padding terms get zero weight and offset -1, so that their denominator can never vanish
+  XLAL_CHECK ( ((*winsign2) = XLALMalloc ( 2 * NCPLX * numChunks * sizeof(**winsign2) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( ((*koff2) = XLALMalloc ( 2 * NCPLX * numChunks * sizeof(**koff2) )) != NULL, XLAL_ENOMEM );
+  for ( UINT4 k = 0; k < NCPLX * numChunks; k ++ )
+    {
+      const REAL4 w = ( k < winLen ) ? ( ( k % 2 == 0 ) ? 1 : -1 ) * win->data->data[k] : 0;
+      const REAL4 o = ( k < winLen ) ? (REAL4) k : -1.0f;
+      (*winsign2)[2*k] = (*winsign2)[2*k+1] = w;
+      (*koff2)[2*k] = (*koff2)[2*k+1] = o;
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALCreateSincInterpolateTables_AVX512()
+
+///
+/// AVX-512 version of XLALSincInterpolateCOMPLEX8TimeSeries(): the sum over the \f$2\,\text{Dterms}+1\f$ kernel
+/// terms around each output sample is evaluated 8 complex terms at a time. Samples whose kernel would
+/// extend beyond either end of the input timeseries are handled by an identical scalar loop.
+/// The window and its lookup tables are created by the caller, see XLALCreateSincInterpolateTables_AVX512().
+///
+int
+XLALSincInterpolateCOMPLEX8TimeSeries_AVX512 ( COMPLEX8Vector *y_out,		///< [out] output series of interpolated y-values [must be same size as t_out]
+                                               const REAL8Vector *t_out,	///< [in] output time-steps to interpolate input to
+                                               const COMPLEX8TimeSeries *ts_in,	///< [in] regularly-spaced input timeseries
+                                               UINT4 Dterms,			///< [in] window sinc kernel sum to +-Dterms around max
+                                               const REAL8Window *win,		///< [in] Hamming window of length 2*Dterms+1
+                                               const REAL4 *winsign2,		///< [in] window * alternating sign lookup table
+                                               const REAL4 *koff2		///< [in] kernel offsets lookup table
+                                               )
+{
+  XLAL_CHECK ( y_out != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( t_out != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( ts_in != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( y_out->length == t_out->length, XLAL_EINVAL );
+  XLAL_CHECK ( win != NULL && win->data->length == 2 * Dterms + 1, XLAL_EINVAL );
+  XLAL_CHECK ( winsign2 != NULL && koff2 != NULL, XLAL_EINVAL );
+
+  const UINT4 numSamplesOut = t_out->length;
+  const INT8 numSamplesIn = ts_in->data->length;
+  const REAL8 dt = ts_in->deltaT;
+  const REAL8 tmin = XLALGPSGetREAL8 ( &(ts_in->epoch) );	// time of first bin in input timeseries
+  const COMPLEX8 *x_in = ts_in->data->data;
+
+  const UINT4 winLen = 2 * Dterms + 1;
+  const UINT4 numChunks = ( winLen + NCPLX - 1 ) / NCPLX;
+  const __mmask16 tailMask = ( winLen % NCPLX == 0 ) ? 0xFFFF : (__mmask16) ( ( 1u << ( 2 * ( winLen % NCPLX ) ) ) - 1 );
+
+  const REAL8 oodt = 1.0 / dt;
+
+  for ( UINT4 l = 0; l < numSamplesOut; l ++ )
+    {
+      REAL8 t = t_out->data[l] - tmin;		// measure time since start of input timeseries
+
+      // samples outside of input timeseries are returned as 0
+      if ( (t < 0) || (t > (numSamplesIn-1)*dt) )	// avoid any extrapolations!
+        {
+          y_out->data[l] = 0;
+          continue;
+        }
+
+      REAL8 t_by_dt = t  * oodt;
+      INT8 jstar = lround ( t_by_dt );		// bin closest to 't', guaranteed to be in [0, numSamples-1]
+
+      if ( fabs ( t_by_dt - jstar ) < LD_SMALL4 )	// avoid numerical problems near peak
+        {
+          y_out->data[l] = x_in[jstar];	// known analytic solution for exact bin
+          continue;
+        }
+
+      const INT8 jStart0 = jstar - Dterms;
+      const INT8 jEnd0 = jstar + Dterms;
+
+      if ( (jStart0 < 0) || (jEnd0 > numSamplesIn - 1) )
+        {
+          // kernel is truncated by the ends of the input timeseries: use scalar loop
+          const INT8 jStart = ( jStart0 < 0 ) ? 0 : jStart0;
+          const INT8 jEnd   = ( jEnd0 > numSamplesIn - 1 ) ? numSamplesIn - 1 : jEnd0;
+          REAL4 delta_jStart = (t_by_dt - jStart);
+          REAL4 sin0, cos0;
+          XLALSinCosLUT ( &sin0, &cos0, LAL_PI * delta_jStart );
+          REAL4 sin0oopi = sin0 * OOPI;
+          COMPLEX8 y_l = 0;
+          REAL8 delta_j = delta_jStart;
+          for ( INT8 j = jStart; j <= jEnd; j ++ )
+            {
+              COMPLEX8 Cj = win->data->data[j - jStart0] * sin0oopi / delta_j;
+              y_l += Cj * x_in[j];
+              sin0oopi = -sin0oopi;		// sin-term flips sign every step
+              delta_j --;
+            }
+          y_out->data[l] = y_l;
+          continue;
+        }
+
+      // full kernel: sign of the sin-term is absorbed into 'winsign2', relative to jStart0
+      const REAL4 delta0 = (t_by_dt - jStart0);
+      REAL4 sin0, cos0;
+      XLALSinCosLUT ( &sin0, &cos0, LAL_PI * delta0 );
+      const __m512 sin0oopi = _mm512_set1_ps ( sin0 * OOPI );
+      const __m512 vdelta0 = _mm512_set1_ps ( delta0 );
+      const REAL4 *x_j = (const REAL4 *) &x_in[jStart0];
+
+      __m512 acc = _mm512_setzero_ps();
+      for ( UINT4 c = 0; c < numChunks; c ++ )
+        {
+          const __mmask16 mask = ( c + 1 == numChunks ) ? tailMask : 0xFFFF;
+          const __m512 w = _mm512_loadu_ps ( &winsign2[2 * NCPLX * c] );
+          const __m512 k = _mm512_loadu_ps ( &koff2[2 * NCPLX * c] );
+          const __m512 Cj = _mm512_div_ps ( _mm512_mul_ps ( w, sin0oopi ), _mm512_sub_ps ( vdelta0, k ) );
+          const __m512 x = _mm512_maskz_loadu_ps ( mask, &x_j[2 * NCPLX * c] );
+          acc = _mm512_fmadd_ps ( Cj, x, acc );
+        }
+
+      y_out->data[l] = crectf ( _mm512_mask_reduce_add_ps ( 0x5555, acc ), _mm512_mask_reduce_add_ps ( 0xAAAA, acc ) );
+
+    } // for l < numSamplesOut
+
+  return XLAL_SUCCESS;
+
+} // XLALSincInterpolateCOMPLEX8TimeSeries_AVX512()
+
+///
+/// AVX-512 version of XLALApplyAMAndHeterodyne_Generic(): multiply the interpolated SRC-frame timeseries
+/// \p ts_a by the heterodyne-correction and AM factors, i.e. \f$b_j = a_j\,f^b_j\f$ and \f$a_j \to a_j\,f^a_j\f$.
+///
+int
+XLALApplyAMAndHeterodyne_AVX512 ( COMPLEX8 *ts_a,		///< [in,out] interpolated SRC-frame timeseries, multiplied by \p fac_a on output
+                                  COMPLEX8 *ts_b,		///< [out] interpolated SRC-frame timeseries multiplied by \p fac_b
+                                  const COMPLEX8 *fac_a,	///< [in] heterodyne-correction times a(t) factors
+                                  const COMPLEX8 *fac_b,	///< [in] heterodyne-correction times b(t) factors
+                                  UINT4 numSamples		///< [in] number of samples
+                                  )
+{
+  XLAL_CHECK ( (ts_a != NULL) && (ts_b != NULL) && (fac_a != NULL) && (fac_b != NULL), XLAL_EFAULT );
+
+  for ( UINT4 j = 0; j < numSamples; j += NCPLX )
+    {
+      const UINT4 n = ( numSamples - j < NCPLX ) ? numSamples - j : NCPLX;
+      const __mmask16 mask = ( n == NCPLX ) ? 0xFFFF : (__mmask16) ( ( 1u << ( 2 * n ) ) - 1 );
+
+      const __m512 x  = _mm512_maskz_loadu_ps ( mask, (const REAL4 *) &ts_a[j] );
+      const __m512 fa = _mm512_maskz_loadu_ps ( mask, (const REAL4 *) &fac_a[j] );
+      const __m512 fb = _mm512_maskz_loadu_ps ( mask, (const REAL4 *) &fac_b[j] );
+
+      // complex multiply: (xr + i xi)(yr + i yi) = (xr yr - xi yi) + i (xi yr + xr yi)
+      const __m512 xsw = _mm512_permute_ps ( x, 0xB1 );	// swap real and imaginary parts
+      const __m512 ya = _mm512_fmaddsub_ps ( x, _mm512_moveldup_ps ( fa ), _mm512_mul_ps ( xsw, _mm512_movehdup_ps ( fa ) ) );
+      const __m512 yb = _mm512_fmaddsub_ps ( x, _mm512_moveldup_ps ( fb ), _mm512_mul_ps ( xsw, _mm512_movehdup_ps ( fb ) ) );
+
+      _mm512_mask_storeu_ps ( (REAL4 *) &ts_b[j], mask, yb );
+      _mm512_mask_storeu_ps ( (REAL4 *) &ts_a[j], mask, ya );
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALApplyAMAndHeterodyne_AVX512()
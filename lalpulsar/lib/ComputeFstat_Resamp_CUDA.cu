@@ -0,0 +1,329 @@
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301  USA
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include <cuda.h>
+#include <cuda_runtime.h>
+#include <cufft.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/Factorial.h>
+#include <lal/ComputeFstat.h>
+
+///
+/// \file ComputeFstat_Resamp_CUDA.cu
+/// \ingroup ComputeFstat_Resamp_c
+/// \brief CUDA implementation of the spindown+FFT part of the \a Resamp method, used by \c FMETHOD_RESAMP_CUDA
+///
+/// The barycentered SRC-frame timeseries are computed on the host, and uploaded to the device only when
+/// they change (i.e. on a 'buffer miss', when the sky position or binary orbit changes). For each template,
+/// the spindown correction, FFT, and extraction, normalization and summation of \f$F_a^X(f_k), F_b^X(f_k)\f$
+/// are performed on the device; only the requested output frequency bins are copied back to the host.
+///
+
+// ----- local macros ----------
+#define CUDA_BLOCK_SIZE 256
+#define CUDA_NUM_BLOCKS(n) ( ( (n) + CUDA_BLOCK_SIZE - 1 ) / CUDA_BLOCK_SIZE )
+
+#define XLAL_CHECK_CUDA(expr, ...) do {                                 \
+    cudaError_t XLAL_CHECK_CUDA_err = (expr);                           \
+    XLAL_CHECK ( XLAL_CHECK_CUDA_err == cudaSuccess, __VA_ARGS__, "%s: %s", #expr, cudaGetErrorString ( XLAL_CHECK_CUDA_err ) ); \
+  } while(0)
+#define XLAL_CHECK_CUFFT(expr, ...) do {                                \
+    cufftResult XLAL_CHECK_CUFFT_res = (expr);                          \
+    XLAL_CHECK ( XLAL_CHECK_CUFFT_res == CUFFT_SUCCESS, __VA_ARGS__, "%s: cuFFT error %d", #expr, (int) XLAL_CHECK_CUFFT_res ); \
+  } while(0)
+
+// ----- local types ----------
+
+// spindown phase coefficients: cycles(tau) = -freqShift * tau' - sum_{k>=1} coef[k] * Dtau^{k+1}
+typedef struct {
+  double coef[PULSAR_MAX_SPINS];
+  unsigned int s_max;
+} SpindownCoeffs;
+
+// device-resident data of the CUDA Resamp method
+struct tagResampCUDAData {
+  UINT4 numDetectors;			// number of detectors
+  UINT4 numSamplesSRCMax;		// maximal number of samples in the SRC-frame timeseries of any detector
+  UINT4 numSamplesFFT;			// length of zero-padded SRC-frame timeseries
+  UINT4 numSamplesSRC[PULSAR_MAX_DETECTORS];	// number of samples in the SRC-frame timeseries of each detector
+  LIGOTimeGPS epoch[PULSAR_MAX_DETECTORS];	// start time of the SRC-frame timeseries of each detector
+  REAL8 dt_SRC;				// sampling interval of the SRC-frame timeseries
+  cufftComplex *d_TS_SRC_a;		// SRC-frame timeseries * a(t) of all detectors [numDetectors * numSamplesSRCMax]
+  cufftComplex *d_TS_SRC_b;		// SRC-frame timeseries * b(t) of all detectors [numDetectors * numSamplesSRCMax]
+  cufftComplex *d_TS_FFT;		// zero-padded, spindown-corr SRC-frame TS [numSamplesFFT]
+  cufftComplex *d_FabX_Raw;		// raw full-band FFT result [numSamplesFFT]
+  cufftComplex *d_FabX_k;		// normalized F_a^X(f_k), F_b^X(f_k) for all detectors [2 * numDetectors * numFreqBinsAlloc]
+  cufftComplex *d_Fab_k;		// normalized F_a(f_k), F_b(f_k) [2 * numFreqBinsAlloc]
+  UINT4 numFreqBinsAlloc;		// allocated number of output frequency bins
+  cufftHandle fftplan;			// cuFFT plan
+  BOOLEAN have_fftplan;			// whether 'fftplan' was created
+};
+
+extern "C" {
+  typedef struct tagResampCUDAData ResampCUDAData;
+  int XLALResampCUDAIsAvailable_intern ( void );
+  int XLALCreateResampCUDAData ( ResampCUDAData **cuda, UINT4 numDetectors, UINT4 numSamplesSRCMax, UINT4 numSamplesFFT );
+  void XLALDestroyResampCUDAData ( ResampCUDAData *cuda );
+  int XLALCopyResampTimeSeriesToCUDA ( ResampCUDAData *cuda, const MultiCOMPLEX8TimeSeries *multiTimeSeries_SRC_a, const MultiCOMPLEX8TimeSeries *multiTimeSeries_SRC_b );
+  int XLALComputeMultiFaFb_Resamp_CUDA ( ResampCUDAData *cuda, const PulsarDopplerParams *thisPoint, REAL8 dFreq, UINT4 numFreqBins, REAL8 freqShift, UINT4 offset_bins, UINT4 decimateFFT,
+                                         COMPLEX8 *Fa_k, COMPLEX8 *Fb_k, COMPLEX8 *FaX_k[], COMPLEX8 *FbX_k[] );
+}
+
+// ==================== device kernels ====================
+
+// Apply spindown phase-factors and frequency shift, store result in zero-padded timeseries for FFT'ing
+__global__ void
+CUDAApplySpindownAndFreqShift ( cufftComplex *xOut, const cufftComplex *xIn, unsigned int numSamplesIn, unsigned int numSamplesFFT,
+                                double dt, double Dtau0, double freqShift, SpindownCoeffs spin )
+{
+  const unsigned int j = blockIdx.x * blockDim.x + threadIdx.x;
+  if ( j >= numSamplesFFT ) {
+    return;
+  }
+  if ( j >= numSamplesIn ) {
+    xOut[j] = make_cuFloatComplex ( 0, 0 );
+    return;
+  }
+
+  const double taup_j = j * dt;
+  const double Dtau_alpha_j = Dtau0 + taup_j;
+  double cycles = - freqShift * taup_j;
+  double Dtau_pow_kp1 = Dtau_alpha_j;
+  for ( unsigned int k = 1; k <= spin.s_max; k++ )
+    {
+      Dtau_pow_kp1 *= Dtau_alpha_j;
+      cycles += - spin.coef[k] * Dtau_pow_kp1;
+    }
+
+  double sinphase, cosphase;
+  sincospi ( 2.0 * ( cycles - floor ( cycles ) ), &sinphase, &cosphase );
+  xOut[j] = cuCmulf ( make_cuFloatComplex ( (float) cosphase, (float) sinphase ), xIn[j] );
+}
+
+// Copy output frequency bins from raw FFT result, apply normalization, and add to multi-detector sum
+__global__ void
+CUDANormalizeAndSumFabX ( cufftComplex *FabX_k, cufftComplex *Fab_k, const cufftComplex *FabX_Raw, unsigned int numFreqBins,
+                          unsigned int offset_bins, unsigned int decimateFFT, double FreqOut0, double dFreq, double dtauX, double dt_SRC, int first )
+{
+  const unsigned int k = blockIdx.x * blockDim.x + threadIdx.x;
+  if ( k >= numFreqBins ) {
+    return;
+  }
+
+  const double cycles = - ( FreqOut0 + k * dFreq ) * dtauX;
+  double sinphase, cosphase;
+  sincospi ( 2.0 * ( cycles - floor ( cycles ) ), &sinphase, &cosphase );
+  const cufftComplex normX_k = make_cuFloatComplex ( (float) ( dt_SRC * cosphase ), (float) ( dt_SRC * sinphase ) );
+
+  const cufftComplex FabX = cuCmulf ( FabX_Raw [ offset_bins + k * decimateFFT ], normX_k );
+  FabX_k[k] = FabX;
+  Fab_k[k] = first ? FabX : cuCaddf ( Fab_k[k], FabX );
+}
+
+// ==================== host functions ====================
+
+///
+/// Return true if a CUDA device is available on the current execution machine
+///
+int
+XLALResampCUDAIsAvailable_intern ( void )
+{
+  int numDevices = 0;
+  if ( cudaGetDeviceCount ( &numDevices ) != cudaSuccess ) {
+    cudaGetLastError();	// reset CUDA error state
+    return 0;
+  }
+  return ( numDevices > 0 );
+}
+
+///
+/// Allocate device-resident data of the CUDA Resamp method
+///
+int
+XLALCreateResampCUDAData ( ResampCUDAData **cuda,	///< [out] device-resident data
+                           UINT4 numDetectors,		///< [in] number of detectors
+                           UINT4 numSamplesSRCMax,	///< [in] maximal number of samples in the SRC-frame timeseries of any detector
+                           UINT4 numSamplesFFT		///< [in] length of zero-padded SRC-frame timeseries
+                           )
+{
+  XLAL_CHECK ( cuda != NULL && *cuda == NULL, XLAL_EINVAL );
+  XLAL_CHECK ( 0 < numDetectors && numDetectors <= PULSAR_MAX_DETECTORS, XLAL_EINVAL );
+  XLAL_CHECK ( numSamplesSRCMax > 0 && numSamplesFFT >= numSamplesSRCMax, XLAL_EINVAL );
+
+  ResampCUDAData *c = ( ResampCUDAData * ) XLALCalloc ( 1, sizeof(*c) );
+  XLAL_CHECK ( c != NULL, XLAL_ENOMEM );
+  *cuda = c;
+
+  c->numDetectors = numDetectors;
+  c->numSamplesSRCMax = numSamplesSRCMax;
+  c->numSamplesFFT = numSamplesFFT;
+
+  XLAL_CHECK_CUDA ( cudaMalloc ( (void **) &c->d_TS_SRC_a, numDetectors * numSamplesSRCMax * sizeof(cufftComplex) ), XLAL_ENOMEM );
+  XLAL_CHECK_CUDA ( cudaMalloc ( (void **) &c->d_TS_SRC_b, numDetectors * numSamplesSRCMax * sizeof(cufftComplex) ), XLAL_ENOMEM );
+  XLAL_CHECK_CUDA ( cudaMalloc ( (void **) &c->d_TS_FFT, numSamplesFFT * sizeof(cufftComplex) ), XLAL_ENOMEM );
+  XLAL_CHECK_CUDA ( cudaMalloc ( (void **) &c->d_FabX_Raw, numSamplesFFT * sizeof(cufftComplex) ), XLAL_ENOMEM );
+
+  XLAL_CHECK_CUFFT ( cufftPlan1d ( &c->fftplan, numSamplesFFT, CUFFT_C2C, 1 ), XLAL_EFAILED );
+  c->have_fftplan = 1;
+
+  return XLAL_SUCCESS;
+
+} // XLALCreateResampCUDAData()
+
+///
+/// Free device-resident data of the CUDA Resamp method
+///
+void
+XLALDestroyResampCUDAData ( ResampCUDAData *cuda )
+{
+  if ( cuda == NULL ) {
+    return;
+  }
+  if ( cuda->have_fftplan ) {
+    cufftDestroy ( cuda->fftplan );
+  }
+  cudaFree ( cuda->d_TS_SRC_a );
+  cudaFree ( cuda->d_TS_SRC_b );
+  cudaFree ( cuda->d_TS_FFT );
+  cudaFree ( cuda->d_FabX_Raw );
+  cudaFree ( cuda->d_FabX_k );
+  cudaFree ( cuda->d_Fab_k );
+  XLALFree ( cuda );
+} // XLALDestroyResampCUDAData()
+
+///
+/// Upload the (re-computed) SRC-frame timeseries to the device
+///
+int
+XLALCopyResampTimeSeriesToCUDA ( ResampCUDAData *cuda,					///< [in,out] device-resident data
+                                 const MultiCOMPLEX8TimeSeries *multiTimeSeries_SRC_a,	///< [in] multi-detector SRC-frame timeseries * a(t)
+                                 const MultiCOMPLEX8TimeSeries *multiTimeSeries_SRC_b		///< [in] multi-detector SRC-frame timeseries * b(t)
+                                 )
+{
+  XLAL_CHECK ( cuda != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( multiTimeSeries_SRC_a != NULL && multiTimeSeries_SRC_a->length == cuda->numDetectors, XLAL_EINVAL );
+  XLAL_CHECK ( multiTimeSeries_SRC_b != NULL && multiTimeSeries_SRC_b->length == cuda->numDetectors, XLAL_EINVAL );
+
+  for ( UINT4 X = 0; X < cuda->numDetectors; ++X )
+    {
+      const COMPLEX8TimeSeries *TimeSeriesX_SRC_a = multiTimeSeries_SRC_a->data[X];
+      const COMPLEX8TimeSeries *TimeSeriesX_SRC_b = multiTimeSeries_SRC_b->data[X];
+      const UINT4 numSamples_SRCX = TimeSeriesX_SRC_a->data->length;
+      XLAL_CHECK ( numSamples_SRCX <= cuda->numSamplesSRCMax, XLAL_EINVAL );
+      XLAL_CHECK ( TimeSeriesX_SRC_b->data->length == numSamples_SRCX, XLAL_EINVAL );
+
+      XLAL_CHECK_CUDA ( cudaMemcpy ( &cuda->d_TS_SRC_a[X * cuda->numSamplesSRCMax], TimeSeriesX_SRC_a->data->data, numSamples_SRCX * sizeof(cufftComplex), cudaMemcpyHostToDevice ), XLAL_EFAILED );
+      XLAL_CHECK_CUDA ( cudaMemcpy ( &cuda->d_TS_SRC_b[X * cuda->numSamplesSRCMax], TimeSeriesX_SRC_b->data->data, numSamples_SRCX * sizeof(cufftComplex), cudaMemcpyHostToDevice ), XLAL_EFAILED );
+
+      cuda->numSamplesSRC[X] = numSamples_SRCX;
+      cuda->epoch[X] = TimeSeriesX_SRC_a->epoch;
+      cuda->dt_SRC = TimeSeriesX_SRC_a->deltaT;
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALCopyResampTimeSeriesToCUDA()
+
+///
+/// Compute normalized \f$F_a(f_k), F_b(f_k)\f$, and optionally \f$F_a^X(f_k), F_b^X(f_k)\f$, on the device from the
+/// device-resident SRC-frame timeseries, and copy the results to the host
+///
+int
+XLALComputeMultiFaFb_Resamp_CUDA ( ResampCUDAData *cuda,			///< [in,out] device-resident data
+                                   const PulsarDopplerParams *thisPoint,	///< [in] Doppler point to compute {FaX,FbX} for
+                                   REAL8 dFreq,					///< [in] output frequency resolution
+                                   UINT4 numFreqBins,				///< [in] number of output frequency bins
+                                   REAL8 freqShift,				///< [in] frequency shift to closest output bin
+                                   UINT4 offset_bins,				///< [in] FFT bin of the first output frequency bin
+                                   UINT4 decimateFFT,				///< [in] output every n-th FFT frequency bin
+                                   COMPLEX8 *Fa_k,				///< [out] Fa(f_k) over output bins
+                                   COMPLEX8 *Fb_k,				///< [out] Fb(f_k) over output bins
+                                   COMPLEX8 *FaX_k[],				///< [out] Fa^X(f_k) for each detector X, or NULL if not required
+                                   COMPLEX8 *FbX_k[]				///< [out] Fb^X(f_k) for each detector X, or NULL if not required
+                                   )
+{
+  XLAL_CHECK ( cuda != NULL && thisPoint != NULL && Fa_k != NULL && Fb_k != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( ( FaX_k == NULL ) == ( FbX_k == NULL ), XLAL_EINVAL );
+
+  const UINT4 numDetectors = cuda->numDetectors;
+
+  // ----- (re)allocate device output arrays, if necessary
+  if ( numFreqBins > cuda->numFreqBinsAlloc )
+    {
+      cudaFree ( cuda->d_FabX_k );
+      cudaFree ( cuda->d_Fab_k );
+      cuda->d_FabX_k = cuda->d_Fab_k = NULL;
+      XLAL_CHECK_CUDA ( cudaMalloc ( (void **) &cuda->d_FabX_k, 2 * numDetectors * numFreqBins * sizeof(cufftComplex) ), XLAL_ENOMEM );
+      XLAL_CHECK_CUDA ( cudaMalloc ( (void **) &cuda->d_Fab_k, 2 * numFreqBins * sizeof(cufftComplex) ), XLAL_ENOMEM );
+      cuda->numFreqBinsAlloc = numFreqBins;
+    }
+
+  // ----- spindown phase coefficients
+  SpindownCoeffs spin;
+  spin.s_max = PULSAR_MAX_SPINS - 1;
+  while ( (spin.s_max > 0) && (thisPoint->fkdot[spin.s_max] == 0) ) {
+    spin.s_max --;
+  }
+  for ( UINT4 k = 0; k < PULSAR_MAX_SPINS; k++ ) {
+    spin.coef[k] = LAL_FACT_INV[k+1] * thisPoint->fkdot[k];
+  }
+
+  const REAL8 FreqOut0 = thisPoint->fkdot[0];
+  cufftComplex *d_Fa_k = &cuda->d_Fab_k[0];
+  cufftComplex *d_Fb_k = &cuda->d_Fab_k[numFreqBins];
+
+  for ( UINT4 X = 0; X < numDetectors; ++X )
+    {
+      const REAL8 Dtau0 = XLALGPSDiff ( &cuda->epoch[X], &thisPoint->refTime );
+      for ( UINT4 ab = 0; ab < 2; ++ab )
+        {
+          const cufftComplex *d_TS_SRC = &( ab == 0 ? cuda->d_TS_SRC_a : cuda->d_TS_SRC_b )[X * cuda->numSamplesSRCMax];
+          cufftComplex *d_FabX_k = &cuda->d_FabX_k[(2*X + ab) * numFreqBins];
+          cufftComplex *d_Fab_k = ( ab == 0 ) ? d_Fa_k : d_Fb_k;
+
+          CUDAApplySpindownAndFreqShift<<< CUDA_NUM_BLOCKS(cuda->numSamplesFFT), CUDA_BLOCK_SIZE >>> ( cuda->d_TS_FFT, d_TS_SRC, cuda->numSamplesSRC[X], cuda->numSamplesFFT,
+                                                                                                     cuda->dt_SRC, Dtau0, freqShift, spin );
+          XLAL_CHECK_CUDA ( cudaGetLastError(), XLAL_EFAILED );
+
+          XLAL_CHECK_CUFFT ( cufftExecC2C ( cuda->fftplan, cuda->d_TS_FFT, cuda->d_FabX_Raw, CUFFT_FORWARD ), XLAL_EFAILED );
+
+          CUDANormalizeAndSumFabX<<< CUDA_NUM_BLOCKS(numFreqBins), CUDA_BLOCK_SIZE >>> ( d_FabX_k, d_Fab_k, cuda->d_FabX_Raw, numFreqBins, offset_bins, decimateFFT,
+                                                                                       FreqOut0, dFreq, Dtau0, cuda->dt_SRC, ( X == 0 ) );
+          XLAL_CHECK_CUDA ( cudaGetLastError(), XLAL_EFAILED );
+        }
+    }
+
+  // ----- copy only the requested output frequency bins back to the host
+  XLAL_CHECK_CUDA ( cudaMemcpy ( Fa_k, d_Fa_k, numFreqBins * sizeof(cufftComplex), cudaMemcpyDeviceToHost ), XLAL_EFAILED );
+  XLAL_CHECK_CUDA ( cudaMemcpy ( Fb_k, d_Fb_k, numFreqBins * sizeof(cufftComplex), cudaMemcpyDeviceToHost ), XLAL_EFAILED );
+  if ( FaX_k != NULL )
+    {
+      for ( UINT4 X = 0; X < numDetectors; ++X )
+        {
+          XLAL_CHECK_CUDA ( cudaMemcpy ( FaX_k[X], &cuda->d_FabX_k[(2*X) * numFreqBins], numFreqBins * sizeof(cufftComplex), cudaMemcpyDeviceToHost ), XLAL_EFAILED );
+          XLAL_CHECK_CUDA ( cudaMemcpy ( FbX_k[X], &cuda->d_FabX_k[(2*X + 1) * numFreqBins], numFreqBins * sizeof(cufftComplex), cudaMemcpyDeviceToHost ), XLAL_EFAILED );
+        }
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALComputeMultiFaFb_Resamp_CUDA()
@@ -46,6 +46,9 @@
 
 // ---------- Shared struct definitions ---------- //
 
+// Cache of noise-weighted antenna-pattern coefficients for recently-visited sky positions
+typedef struct tagFstatAMCoeffsCache FstatAMCoeffsCache;
+
 // Common input data for F-statistic methods
 typedef struct {
   LIGOTimeGPS midTime;                                  // Mid-time of SFT data
@@ -58,6 +61,7 @@ typedef struct {
   SSBprecision SSBprec;					// Barycentric transformation precision
   void *workspace;					// F-statistic method workspace
   BOOLEAN isTimeslice;                                  //Flag if this is a timeslice of another FstatInput struct
+  FstatAMCoeffsCache *AMCoeffsCache;			// Cache of antenna-pattern coefficients, owns all coefficients returned by XLALFstatGetMultiAMCoeffs()
   REAL8 allowedMismatchFromSFTLength; // optional override for XLALFstatCheckSFTLengthMismatch()
 } FstatCommon;
 
@@ -72,11 +76,17 @@ typedef struct {
 
 // ---------- Shared internal functions ---------- //
 int XLALExtractResampledTimeseries_intern ( MultiCOMPLEX8TimeSeries **multiTimeSeries_SRC_a, MultiCOMPLEX8TimeSeries **multiTimeSeries_SRC_b, const void* method_data );
+#ifdef LALPULSAR_CUDA_ENABLED
+int XLALResampCUDAIsAvailable_intern ( void );
+#endif
 int XLALGetFstatTiming_Demod  ( const void *method_data, FstatTimingGeneric *timingGeneric, FstatTimingModel *timingModel );
 int XLALGetFstatTiming_Resamp ( const void *method_data, FstatTimingGeneric *timingGeneric, FstatTimingModel *timingModel );
+int XLALGetFstatInputSFTs_Demod ( const MultiSFTVector **multiSFTs, UINT4 *Dterms, const void *method_data );
+int XLALGetFstatInputTimeSeries_Resamp ( const MultiCOMPLEX8TimeSeries **multiTimeSeries_DET, UINT4 *Dterms, const void *method_data );
 void *XLALFstatInputTimeslice_Demod ( const void *method_data, const UINT4 iStart[PULSAR_MAX_DETECTORS], const UINT4 iEnd[PULSAR_MAX_DETECTORS] );
 void XLALDestroyFstatInputTimeslice_common ( FstatCommon *common );
 void XLALDestroyFstatInputTimeslice_Demod ( void *method_data );
+const MultiAMCoeffs *XLALFstatGetMultiAMCoeffs ( const FstatCommon *common, const SkyPosition skypos );
 
 static inline REAL4
 compute_fstat_from_fa_fb ( COMPLEX8 Fa, COMPLEX8 Fb, REAL4 A, REAL4 B, REAL4 C, REAL4 E, REAL4 Dinv )
@@ -268,6 +268,56 @@ XLALContractSymmTensor3s ( const SymmTensor3 *T1, const SymmTensor3 *T2 )
 
 } /* XLALContractSymmTensor3s() */
 
+/**
+ * Precompute the sky-independent barycentering quantities of a DetectorStateSeries, which XLALGetSSBtimes()
+ * then uses instead of calling XLALBarycenterOpt() at each timestamp. This only pays off when the SSB times
+ * of the same detector states are computed for many sky positions, so XLALGetDetectorStates() does not do
+ * this itself. Does nothing if the series already has a cache, or for LISA (ecliptic coordinates).
+ */
+int
+XLALAddBarycenterCacheToDetectorStates ( DetectorStateSeries *detStates )
+{
+  XLAL_CHECK ( detStates != NULL, XLAL_EFAULT );
+
+  if ( detStates->baryCache != NULL || detStates->system != COORDINATESYSTEM_EQUATORIAL ) {
+    return XLAL_SUCCESS;
+  }
+
+  BarycenterCache *cache = XLALCreateBarycenterCache ( detStates->length );
+  XLAL_CHECK ( cache != NULL, XLAL_EFUNC );
+
+  LALDetector site = detStates->detector;
+  for ( UINT4 j = 0; j < 3; j++ ) {
+    site.location[j] /= LAL_C_SI;
+  }
+  for ( UINT4 i = 0; i < detStates->length; i++ ) {
+    if ( XLALSetBarycenterCache ( cache, i, &detStates->data[i].tGPS, &site, &detStates->data[i].earthState ) != XLAL_SUCCESS ) {
+      XLALDestroyBarycenterCache ( cache );
+      XLAL_ERROR ( XLAL_EFUNC );
+    }
+  }
+  detStates->baryCache = cache;
+
+  return XLAL_SUCCESS;
+
+} /* XLALAddBarycenterCacheToDetectorStates() */
+
+/**
+ * Multi-IFO version of XLALAddBarycenterCacheToDetectorStates()
+ */
+int
+XLALAddBarycenterCacheToMultiDetectorStates ( MultiDetectorStateSeries *multiDetStates )
+{
+  XLAL_CHECK ( multiDetStates != NULL, XLAL_EFAULT );
+
+  for ( UINT4 X = 0; X < multiDetStates->length; X++ ) {
+    XLAL_CHECK ( XLALAddBarycenterCacheToDetectorStates ( multiDetStates->data[X] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  return XLAL_SUCCESS;
+
+} /* XLALAddBarycenterCacheToMultiDetectorStates() */
+
 /** Get rid of a DetectorStateSeries */
 void
 XLALDestroyDetectorStateSeries ( DetectorStateSeries *detStates )
@@ -276,6 +326,7 @@ XLALDestroyDetectorStateSeries ( DetectorStateSeries *detStates )
     return;
 
   if ( detStates->data ) LALFree ( detStates->data );
+  XLALDestroyBarycenterCache ( detStates->baryCache );
   LALFree ( detStates );
 
   return;
@@ -143,12 +143,14 @@ typedef struct tagDetectorStateSeries
 {
 #ifdef SWIG /* SWIG interface directives */
   SWIGLAL(ARRAY_1D(DetectorStateSeries, DetectorState, data, UINT4, length));
+  SWIGLAL(IGNORE_MEMBERS(tagDetectorStateSeries, baryCache));
 #endif /* SWIG */
   UINT4 length;			/**< total number of entries */
   DetectorState *data;		/**< array of DetectorState entries */
   LALDetector detector;		/**< detector-info corresponding to this timeseries */
   CoordinateSystem system; 	/**< The coordinate system used for detector's position/velocity and detector-tensor */
   REAL8 deltaT;			/**< timespan centered on each timestamp (e.g. typically Tsft) */
+  BarycenterCache *baryCache;	/**< sky-independent barycentering quantities at each timestamp (may be NULL), see XLALAddBarycenterCacheToDetectorStates() */
 } DetectorStateSeries;
 
 /** Multi-IFO time-series of DetectorStates */
@@ -172,6 +174,9 @@ DetectorStateSeries* XLALGetDetectorStates ( const LIGOTimeGPSVector *timestamps
 MultiDetectorStateSeries* XLALGetMultiDetectorStates( const MultiLIGOTimeGPSVector *multiTS, const MultiLALDetector *multiIFO, const EphemerisData *edat, REAL8 tOffset );
 MultiDetectorStateSeries *XLALGetMultiDetectorStatesFromMultiSFTs( const MultiSFTVector *multiSFTs, const EphemerisData *edat, REAL8 tOffset );
 
+int XLALAddBarycenterCacheToDetectorStates ( DetectorStateSeries *detStates );
+int XLALAddBarycenterCacheToMultiDetectorStates ( MultiDetectorStateSeries *multiDetStates );
+
 int XLALParseMultiLALDetector ( MultiLALDetector *multiIFO, const LALStringVector *detNames );
 int XLALParseMultiNoiseFloor ( MultiNoiseFloor *multiNoiseFloor, const LALStringVector *sqrtSX, UINT4 numDetectors );
 int XLALParseMultiNoiseFloorMapped ( MultiNoiseFloor *multiNoiseFloor, const LALStringVector *multiNoiseFloorDetNames, const LALStringVector *sqrtSX, const LALStringVector *sqrtSXDetNames );
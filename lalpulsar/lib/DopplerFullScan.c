@@ -51,10 +51,15 @@
 #define UNUSED
 #endif
 
+/* number of spins stepped over in factored grids: f0dot, f1dot, f2dot, f3dot */
+#define NUM_FACTORED_SPINS 4
+
 /*---------- internal types ----------*/
 typedef struct {
   PulsarDopplerParams thisPoint; /**< current doppler-position of the scan */
   DopplerSkyScanState skyScan;  /**< keep track of sky-grid stepping */
+  UINT8 numSpinSteps[NUM_FACTORED_SPINS]; /**< number of grid-points in each stepped spin */
+  UINT8 thisIndex;              /**< index of current doppler-position: f0dot varies fastest, sky-point slowest */
 } factoredGridScan_t;
 
 /** doubly linked list of REAL8-vectors (physical vectors) */
@@ -90,6 +95,7 @@ struct tagDopplerFullScanState {
 /*---------- internal prototypes ----------*/
 int XLALInitFactoredGrid ( DopplerFullScanState *scan,  const DopplerFullScanInit *init );
 int nextPointInFactoredGrid (PulsarDopplerParams *pos, DopplerFullScanState *scan);
+static int XLALGetFactoredGridPointByIndex ( PulsarDopplerParams *pos, DopplerFullScanState *scan, UINT8 index );
 int XLALLoadFullGridFile ( DopplerFullScanState *scan, const DopplerFullScanInit *init );
 
 /*==================== FUNCTION DEFINITIONS ====================*/
@@ -308,6 +314,7 @@ XLALInitFactoredGrid ( DopplerFullScanState *scan,                      /**< [bo
   XLAL_CHECK ( init, XLAL_EINVAL );
 
   DopplerSkyScanInit XLAL_INIT_DECL(skyScanInit);
+  PulsarDopplerParams XLAL_INIT_DECL(skyPoint);
   SkyPosition skypos;
   factoredGridScan_t *fscan = NULL;
 
@@ -326,6 +333,7 @@ XLALInitFactoredGrid ( DopplerFullScanState *scan,                      /**< [bo
   skyScanInit.skyGridFile = init->gridFile;
   skyScanInit.skyRegionString = init->searchRegion.skyRegionString;
   skyScanInit.Freq = init->searchRegion.fkdot[0] + init->searchRegion.fkdotBand[0];
+  skyScanInit.lazySkyGrid = 1;                          /* sky-points are accessed by index */
 
   XLAL_CHECK ( (fscan = LALCalloc ( 1, sizeof( *fscan ))) != NULL, XLAL_ENOMEM );
   scan->factoredScan = fscan;
@@ -342,8 +350,9 @@ XLALInitFactoredGrid ( DopplerFullScanState *scan,                      /**< [bo
   fscan->thisPoint.refTime = init->searchRegion.refTime;        /* set proper reference time for spins */
 
   /* normalize skyposition: correctly map into [0,2pi]x[-pi/2,pi/2] */
-  skypos.longitude = fscan->skyScan.skyNode->Alpha;
-  skypos.latitude  = fscan->skyScan.skyNode->Delta;
+  XLAL_CHECK ( XLALNextDopplerSkyPos ( &skyPoint, &(fscan->skyScan) ) == 0, XLAL_EFUNC );
+  skypos.longitude = skyPoint.Alpha;
+  skypos.latitude  = skyPoint.Delta;
   skypos.system = COORDINATESYSTEM_EQUATORIAL;
   XLALNormalizeSkyPosition ( &skypos.longitude, &skypos.latitude );
   fscan->thisPoint.Alpha = skypos.longitude;
@@ -352,15 +361,28 @@ XLALInitFactoredGrid ( DopplerFullScanState *scan,                      /**< [bo
   for (UINT4 i=0; i < PULSAR_MAX_SPINS; i ++ )
     fscan->thisPoint.fkdot[i] = scan->spinRange.fkdot[i];
 
+  /* count grid-points in each stepped spin, accumulating steps exactly as nextPointInFactoredGrid() does */
+  for ( UINT4 i=0; i < NUM_FACTORED_SPINS; i ++ ) {
+    const REAL8 fkdotMax = scan->spinRange.fkdot[i] + scan->spinRange.fkdotBand[i];
+    REAL8 fkdot = scan->spinRange.fkdot[i];
+    fscan->numSpinSteps[i] = 1;
+    if ( fscan->skyScan.dfkdot[i] > 0 ) {
+      while ( (fkdot += fscan->skyScan.dfkdot[i]) <= fkdotMax ) {
+        fscan->numSpinSteps[i] ++;
+      }
+    }
+  }
+  fscan->thisIndex = 0;
+
   { /* count total number of templates */
     REAL8 nSky, nTot;
-    REAL8 nSpins[PULSAR_MAX_SPINS];
+    REAL8 nSpins[NUM_FACTORED_SPINS];
     nSky = fscan->skyScan.numSkyGridPoints;
-    for ( UINT4 i=0; i < PULSAR_MAX_SPINS; i ++ ) {
-      nSpins[i] = floor( scan->spinRange.fkdotBand[i] / fscan->skyScan.dfkdot[i] ) + 1.0;
+    for ( UINT4 i=0; i < NUM_FACTORED_SPINS; i ++ ) {
+      nSpins[i] = fscan->numSpinSteps[i];
     }
     nTot = nSky;
-    for ( UINT4 i=0; i < PULSAR_MAX_SPINS; i ++ ) {
+    for ( UINT4 i=0; i < NUM_FACTORED_SPINS; i ++ ) {
       nTot *= nSpins[i];
     }
     scan->numTemplates = nTot;
@@ -545,6 +567,7 @@ nextPointInFactoredGrid (PulsarDopplerParams *pos, DopplerFullScanState *scan)
   factoredGridScan_t *fscan;
   PulsarSpinRange *range;
   PulsarSpins fkdotMax;
+  PulsarDopplerParams XLAL_INIT_DECL(skyPoint);
   SkyPosition skypos;
 
   if ( pos == NULL || scan == NULL )
@@ -583,16 +606,17 @@ nextPointInFactoredGrid (PulsarDopplerParams *pos, DopplerFullScanState *scan)
                 {
                   nextPos.fkdot[3] = range->fkdot[3];   /* f3dot return to start */
                                                         /* skygrid one forward */
-                  if ( (fscan->skyScan.skyNode = fscan->skyScan.skyNode->next) == NULL ) /* no more sky-points ?*/
+                  if ( XLALNextDopplerSkyPos ( &skyPoint, &(fscan->skyScan) ) != 0 )
+                    return -1;
+                  if ( fscan->skyScan.state == STATE_FINISHED ) /* no more sky-points ?*/
                     {
-                      fscan->skyScan.state = STATE_FINISHED;    /* avoid warning when freeing */
                       scan->state = STATE_FINISHED;     /* we're done */
                     }
                   else
                     {
                       /* normalize next skyposition: correctly map into [0,2pi]x[-pi/2,pi/2] */
-                      skypos.longitude = fscan->skyScan.skyNode->Alpha;
-                      skypos.latitude  = fscan->skyScan.skyNode->Delta;
+                      skypos.longitude = skyPoint.Alpha;
+                      skypos.latitude  = skyPoint.Delta;
                       skypos.system = COORDINATESYSTEM_EQUATORIAL;
                       XLALNormalizeSkyPosition ( &skypos.longitude, &skypos.latitude );
                       nextPos.Alpha = skypos.longitude;
@@ -605,11 +629,140 @@ nextPointInFactoredGrid (PulsarDopplerParams *pos, DopplerFullScanState *scan)
 
   /* prepare next step */
   fscan->thisPoint = nextPos;
+  fscan->thisIndex ++;
 
   return 0;
 
 } /* nextPointInFactoredGrid() */
 
+/**
+ * compute template number 'index' of a 'factored' grid (sky x f0dot x f1dot ... ),
+ * reproducing the accumulated spin-steps of nextPointInFactoredGrid()
+ */
+static int
+XLALGetFactoredGridPointByIndex ( PulsarDopplerParams *pos, DopplerFullScanState *scan, UINT8 index )
+{
+  factoredGridScan_t *fscan = scan->factoredScan;
+  PulsarDopplerParams XLAL_INIT_DECL(skyPoint);
+  SkyPosition skypos;
+
+  PulsarDopplerParams XLAL_INIT_DECL(thisPos);
+  thisPos.refTime = fscan->thisPoint.refTime;
+  memcpy ( thisPos.fkdot, scan->spinRange.fkdot, sizeof(PulsarSpins) );
+
+  /* split index into spin-indices, f0dot varying fastest */
+  for ( UINT4 i=0; i < NUM_FACTORED_SPINS; i ++ ) {
+    UINT8 k = index % fscan->numSpinSteps[i];
+    index /= fscan->numSpinSteps[i];
+    while ( k -- ) {    /* test, then decrement! */
+      thisPos.fkdot[i] += fscan->skyScan.dfkdot[i];
+    }
+  }
+
+  /* remainder is the sky-index */
+  XLAL_CHECK ( index < fscan->skyScan.numSkyGridPoints, XLAL_EDOM );
+  XLAL_CHECK ( XLALGetDopplerSkyPosByIndex ( &skyPoint, &(fscan->skyScan), index ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* normalize skyposition: correctly map into [0,2pi]x[-pi/2,pi/2] */
+  skypos.longitude = skyPoint.Alpha;
+  skypos.latitude  = skyPoint.Delta;
+  skypos.system = COORDINATESYSTEM_EQUATORIAL;
+  XLALNormalizeSkyPosition ( &skypos.longitude, &skypos.latitude );
+  thisPos.Alpha = skypos.longitude;
+  thisPos.Delta = skypos.latitude;
+
+  (*pos) = thisPos;
+
+  return XLAL_SUCCESS;
+
+} /* XLALGetFactoredGridPointByIndex() */
+
+/**
+ * Return the index of the template which the next call to XLALNextDopplerPos() will return,
+ * e.g. to checkpoint a scan; a finished scan returns the total number of templates.
+ *
+ * Templates of 'factored' grids (sky x f0dot x f1dot ... ) are numbered in the order they are
+ * returned by XLALNextDopplerPos(); other grid types are not supported.
+ */
+int
+XLALGetDopplerFullScanIndex ( UINT8 *index, const DopplerFullScanState *scan )
+{
+  XLAL_CHECK ( index != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( scan != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( scan->state != STATE_IDLE, XLAL_EINVAL, "Called on un-initialized DopplerFullScanState\n" );
+  XLAL_CHECK ( scan->factoredScan != NULL, XLAL_EINVAL, "Template indices not supported for gridType=%d\n", scan->gridType );
+
+  (*index) = scan->factoredScan->thisIndex;
+
+  return XLAL_SUCCESS;
+
+} /* XLALGetDopplerFullScanIndex() */
+
+/**
+ * Position the scan such that the next call to XLALNextDopplerPos() returns template 'index',
+ * e.g. to resume a scan from a checkpoint, or to start a partition of the template bank.
+ * Seeking to the total number of templates finishes the scan.
+ *
+ * This does not step through the preceding templates: its cost is that of XLALGetDopplerPosByIndex().
+ */
+int
+XLALSetDopplerFullScanIndex ( DopplerFullScanState *scan, UINT8 index )
+{
+  XLAL_CHECK ( scan != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( scan->state != STATE_IDLE, XLAL_EINVAL, "Called on un-initialized DopplerFullScanState\n" );
+  XLAL_CHECK ( scan->factoredScan != NULL, XLAL_EINVAL, "Template indices not supported for gridType=%d\n", scan->gridType );
+
+  factoredGridScan_t *fscan = scan->factoredScan;
+
+  UINT8 numSpinTemplates = 1;
+  for ( UINT4 i=0; i < NUM_FACTORED_SPINS; i ++ ) {
+    numSpinTemplates *= fscan->numSpinSteps[i];
+  }
+  const UINT8 numTemplates = numSpinTemplates * fscan->skyScan.numSkyGridPoints;
+  XLAL_CHECK ( index <= numTemplates, XLAL_EDOM, "Template index %" LAL_UINT8_FORMAT " out of range [0, %" LAL_UINT8_FORMAT "]\n", index, numTemplates );
+
+  if ( index == numTemplates )
+    {
+      fscan->skyScan.skyIndex = fscan->skyScan.numSkyGridPoints;
+      fscan->skyScan.state = STATE_FINISHED;
+      scan->state = STATE_FINISHED;
+    }
+  else
+    {
+      XLAL_CHECK ( XLALGetFactoredGridPointByIndex ( &(fscan->thisPoint), scan, index ) == XLAL_SUCCESS, XLAL_EFUNC );
+      fscan->skyScan.skyIndex = index / numSpinTemplates + 1;   /* sky-point following the current one */
+      fscan->skyScan.state = STATE_READY;
+      scan->state = STATE_READY;
+    }
+  fscan->thisIndex = index;
+
+  return XLAL_SUCCESS;
+
+} /* XLALSetDopplerFullScanIndex() */
+
+/**
+ * Return template number 'index' of the scan without changing the position of XLALNextDopplerPos(),
+ * e.g. to distribute templates between jobs.
+ *
+ * Only 'factored' grids (sky x f0dot x f1dot ... ) are supported. Sky-points are accessed as
+ * described for XLALGetDopplerSkyPosByIndex(), and spins are stepped up to their indices in
+ * exactly the same way as XLALNextDopplerPos(), so that identical templates are returned.
+ */
+int
+XLALGetDopplerPosByIndex ( PulsarDopplerParams *pos, DopplerFullScanState *scan, UINT8 index )
+{
+  XLAL_CHECK ( pos != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( scan != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( scan->state != STATE_IDLE, XLAL_EINVAL, "Called on un-initialized DopplerFullScanState\n" );
+  XLAL_CHECK ( scan->factoredScan != NULL, XLAL_EINVAL, "Template indices not supported for gridType=%d\n", scan->gridType );
+
+  XLAL_CHECK ( XLALGetFactoredGridPointByIndex ( pos, scan, index ) == XLAL_SUCCESS, XLAL_EFUNC );
+  pos->refTime = scan->spinRange.refTime;
+
+  return XLAL_SUCCESS;
+
+} /* XLALGetDopplerPosByIndex() */
+
 static void
 XLALREAL8VectorListDestroy (REAL8VectorList *head)
 {
@@ -88,6 +88,9 @@ DopplerFullScanState *XLALInitDopplerFullScan ( const DopplerFullScanInit *init
 int  XLALNextDopplerPos(PulsarDopplerParams *pos, DopplerFullScanState *scan);
 REAL8 XLALNumDopplerTemplates ( DopplerFullScanState *scan);
 int XLALGetDopplerSpinRange ( PulsarSpinRange *spinRange, const DopplerFullScanState *scan );
+int XLALGetDopplerFullScanIndex ( UINT8 *index, const DopplerFullScanState *scan );
+int XLALSetDopplerFullScanIndex ( DopplerFullScanState *scan, UINT8 index );
+int XLALGetDopplerPosByIndex ( PulsarDopplerParams *pos, DopplerFullScanState *scan, UINT8 index );
 void XLALDestroyDopplerFullScan ( DopplerFullScanState *scan );
 
 /* ----- variout utility functions ----- */
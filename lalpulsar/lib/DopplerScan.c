@@ -93,6 +93,35 @@ typedef REAL4	meshREAL;
 typedef TwoDMeshNode meshNODE;
 typedef TwoDMeshParamStruc meshPARAMS;
 
+/** one non-empty row of a GRID_FLAT or GRID_ISOTROPIC sky-grid generated on demand */
+typedef struct tagLazySkyGridRow {
+  REAL8 outer;			/**< fixed coordinate of this row: longitude (GRID_FLAT) or latitude (GRID_ISOTROPIC) */
+  REAL8 step;			/**< step-size along this row */
+  UINT4 firstIndex;		/**< index of first sky-point in this row */
+  UINT4 numPoints;		/**< number of sky-points in this row */
+} LazySkyGridRow;
+
+/**
+ * Sky-grid for indexed access: either a table of rows, whose points are generated on demand
+ * in the same order as buildFlatSkyGrid() and buildIsotropicSkyGrid(), or arrays of stored points.
+ */
+struct tagDopplerLazySkyGrid {
+  UINT4 numPoints;		/**< total number of sky-points, before partitioning */
+  UINT4 firstIndex;		/**< index of first sky-point of the requested partition */
+  REAL8 *Alpha;			/**< stored longitudes, if not generated from rows */
+  REAL8 *Delta;			/**< stored latitudes, if not generated from rows */
+  BOOLEAN isotropic;		/**< rows are at fixed latitude (GRID_ISOTROPIC), otherwise at fixed longitude (GRID_FLAT) */
+  BOOLEAN singlePoint;		/**< sky-region has no area, so no points are clipped */
+  SkyRegion region;		/**< sky-region clipping the rows */
+  REAL8 innerStart;		/**< first coordinate along each row */
+  REAL8 innerEnd;		/**< last allowed coordinate along each row */
+  UINT4 numRows;		/**< number of non-empty rows */
+  LazySkyGridRow *rows;		/**< table of non-empty rows */
+  UINT4 cursorRow;		/**< row containing the next sky-point to be generated */
+  UINT4 cursorIndex;		/**< index of the next accepted sky-point in this row */
+  REAL8 cursorInner;		/**< coordinate of the next candidate sky-point along this row */
+};
+
 /*---------- internal prototypes ----------*/
 void getRange( LALStatus *, meshREAL y[2], meshREAL x, void *params );
 void getMetric( LALStatus *, meshREAL g[3], meshREAL skypos[2], void *params );
@@ -117,6 +146,13 @@ void printFrequencyShifts(LALStatus *, const DopplerSkyScanState *skyScan, const
 
 const char *va(const char *format, ...);	/* little var-arg string helper function */
 
+static void equiPartitionRange ( UINT4 *iMin, UINT4 *numPoints, UINT4 Nsky, UINT4 partitionIndex, UINT4 numPartitions );
+static BOOLEAN lazySkyGridCandidate ( SkyPosition *point, const DopplerLazySkyGrid *grid, REAL8 outer, REAL8 inner );
+static DopplerLazySkyGrid *XLALCreateLazyRowSkyGrid ( const SkyRegion *skyRegion, BOOLEAN isotropic, REAL8 dAlpha, REAL8 dDelta );
+static DopplerLazySkyGrid *XLALCreateLazySkyGridFromList ( const DopplerSkyGrid *skyGrid );
+static void XLALDestroyLazySkyGrid ( DopplerLazySkyGrid *grid );
+static int XLALGetLazySkyGridPoint ( REAL8 *Alpha, REAL8 *Delta, DopplerLazySkyGrid *grid, UINT4 index );
+
 /*==================== FUNCTION DEFINITIONS ====================*/
 
 /**
@@ -143,7 +179,18 @@ XLALNextDopplerSkyPos( PulsarDopplerParams *pos, DopplerSkyScanState *skyScan)
       break;
 
     case STATE_READY:
-      if (skyScan->skyNode == NULL) 	/* we're done */
+      if ( skyScan->lazyGrid != NULL )
+	{
+	  if ( skyScan->skyIndex >= skyScan->numSkyGridPoints )	/* we're done */
+	    skyScan->state = STATE_FINISHED;
+	  else
+	    {
+	      if ( XLALGetLazySkyGridPoint ( &(pos->Alpha), &(pos->Delta), skyScan->lazyGrid, skyScan->skyIndex ) != XLAL_SUCCESS )
+		return -1;
+	      skyScan->skyIndex ++;	/* step forward */
+	    }
+	}
+      else if (skyScan->skyNode == NULL) 	/* we're done */
 	skyScan->state = STATE_FINISHED;
       else
 	{
@@ -166,6 +213,38 @@ XLALNextDopplerSkyPos( PulsarDopplerParams *pos, DopplerSkyScanState *skyScan)
 } /* XLALNextDopplerSkyPos() */
 
 
+/**
+ * Return sky-point number 'index' of the sky-grid (within the requested partition),
+ * without changing the position of XLALNextDopplerSkyPos().
+ *
+ * With DopplerSkyScanInit::lazySkyGrid this takes at most a pass over one row of GRID_FLAT
+ * or GRID_ISOTROPIC sky-grids (and is O(1) for sequential indices), or is O(1) for other grids;
+ * otherwise the 'skyGrid' list is walked up to 'index'.
+ */
+int
+XLALGetDopplerSkyPosByIndex ( PulsarDopplerParams *pos, DopplerSkyScanState *skyScan, UINT4 index )
+{
+  XLAL_CHECK ( pos != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( skyScan != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( skyScan->state != STATE_IDLE, XLAL_EINVAL, "Sky-scan has not been initialized\n" );
+  XLAL_CHECK ( index < skyScan->numSkyGridPoints, XLAL_EDOM, "Sky-point index %u out of range [0, %u)\n", index, skyScan->numSkyGridPoints );
+
+  if ( skyScan->lazyGrid != NULL ) {
+    XLAL_CHECK ( XLALGetLazySkyGridPoint ( &(pos->Alpha), &(pos->Delta), skyScan->lazyGrid, index ) == XLAL_SUCCESS, XLAL_EFUNC );
+  } else {
+    const DopplerSkyGrid *node = skyScan->skyGrid;
+    while ( index -- ) {	/* test, then decrement! */
+      node = node->next;
+    }
+    pos->Alpha = node->Alpha;
+    pos->Delta = node->Delta;
+  }
+
+  return XLAL_SUCCESS;
+
+} /* XLALGetDopplerSkyPosByIndex() */
+
+
 /**
  * Initialize the Doppler sky-scanner
  */
@@ -189,6 +268,7 @@ XLALInitDopplerSkyScan ( DopplerSkyScanState *skyScan, 		/**< [out] the initiali
   /* general initializations */
   skyScan->skyGrid = NULL;
   skyScan->skyNode = NULL;
+  skyScan->lazyGrid = NULL;
 
   XLAL_CHECK ( XLALParseSkyRegionString ( &(skyScan->skyRegion), init->skyRegionString) == XLAL_SUCCESS, XLAL_EFUNC );
 
@@ -197,11 +277,19 @@ XLALInitDopplerSkyScan ( DopplerSkyScanState *skyScan, 		/**< [out] the initiali
   switch (init->gridType)
     {
     case GRID_FLAT:		/* flat-grid: constant dAlpha, dDelta */
-      XLAL_CHECK ( (skyScan->skyGrid = buildFlatSkyGrid( &(skyScan->skyRegion), init->dAlpha, init->dDelta)) != NULL, XLAL_EFUNC );
+      if ( init->lazySkyGrid ) {	/* only tabulate the rows of the grid, points are generated on demand */
+        XLAL_CHECK ( (skyScan->lazyGrid = XLALCreateLazyRowSkyGrid ( &(skyScan->skyRegion), 0, init->dAlpha, init->dDelta )) != NULL, XLAL_EFUNC );
+      } else {
+        XLAL_CHECK ( (skyScan->skyGrid = buildFlatSkyGrid( &(skyScan->skyRegion), init->dAlpha, init->dDelta)) != NULL, XLAL_EFUNC );
+      }
       break;
 
     case GRID_ISOTROPIC: 	/* variant of manual stepping: try to produce an isotropic mesh */
-      XLAL_CHECK ( (skyScan->skyGrid = buildIsotropicSkyGrid( &(skyScan->skyRegion), init->dAlpha, init->dDelta )) != NULL, XLAL_EFUNC );
+      if ( init->lazySkyGrid ) {
+        XLAL_CHECK ( (skyScan->lazyGrid = XLALCreateLazyRowSkyGrid ( &(skyScan->skyRegion), 1, init->dAlpha, init->dDelta )) != NULL, XLAL_EFUNC );
+      } else {
+        XLAL_CHECK ( (skyScan->skyGrid = buildIsotropicSkyGrid( &(skyScan->skyRegion), init->dAlpha, init->dDelta )) != NULL, XLAL_EFUNC );
+      }
       break;
 
     case GRID_METRIC:
@@ -220,7 +308,12 @@ XLALInitDopplerSkyScan ( DopplerSkyScanState *skyScan, 		/**< [out] the initiali
     } /* switch (metric) */
 
   /* extract sky-grid partition 'partitionIndex' if requested */
-  if ( init->numSkyPartitions > 0 )
+  if ( (init->numSkyPartitions > 0) && (skyScan->lazyGrid != NULL) )
+    {
+      XLAL_CHECK ( (init->partitionIndex < init->numSkyPartitions) && (skyScan->lazyGrid->numPoints >= init->numSkyPartitions), XLAL_EINVAL );
+      equiPartitionRange ( &(skyScan->lazyGrid->firstIndex), &(skyScan->numSkyGridPoints), skyScan->lazyGrid->numPoints, init->partitionIndex, init->numSkyPartitions );
+    }
+  else if ( init->numSkyPartitions > 0 )
     {
       DopplerSkyGrid *tmp;
 
@@ -228,18 +321,34 @@ XLALInitDopplerSkyScan ( DopplerSkyScanState *skyScan, 		/**< [out] the initiali
       freeSkyGrid (skyScan->skyGrid);
       skyScan->skyGrid = tmp;
     } /* if numPartitions > 0 */
+  else if ( skyScan->lazyGrid != NULL )
+    {
+      skyScan->numSkyGridPoints = skyScan->lazyGrid->numPoints;
+    }
 
-  /* initialize skygrid-pointer to first node in list */
-  skyScan->skyNode = skyScan->skyGrid;
+  if ( skyScan->lazyGrid == NULL )
+    {
+      /* initialize skygrid-pointer to first node in list */
+      skyScan->skyNode = skyScan->skyGrid;
 
-  /* count number of nodes in our sky-grid */
-  skyScan->numSkyGridPoints = 0;
-  node = skyScan->skyGrid;
-  while (node)
+      /* count number of nodes in our sky-grid */
+      skyScan->numSkyGridPoints = 0;
+      node = skyScan->skyGrid;
+      while (node)
+        {
+          skyScan->numSkyGridPoints ++;
+          node = node->next;
+        }
+    }
+
+  /* store other sky-grids compactly for indexed access if requested */
+  if ( init->lazySkyGrid && (skyScan->lazyGrid == NULL) )
     {
-      skyScan->numSkyGridPoints ++;
-      node = node->next;
+      XLAL_CHECK ( (skyScan->lazyGrid = XLALCreateLazySkyGridFromList ( skyScan->skyGrid )) != NULL, XLAL_EFUNC );
+      freeSkyGrid ( skyScan->skyGrid );
+      skyScan->skyGrid = skyScan->skyNode = NULL;
     }
+  skyScan->skyIndex = 0;
 
   /* ----------
    * determine spacings in frequency and spindowns
@@ -250,8 +359,12 @@ XLALInitDopplerSkyScan ( DopplerSkyScanState *skyScan, 		/**< [out] the initiali
     PulsarDopplerParams XLAL_INIT_DECL(gridpoint);
     PulsarDopplerParams XLAL_INIT_DECL(gridSpacings);
 
-    gridpoint.Alpha = skyScan->skyGrid->Alpha;
-    gridpoint.Delta = skyScan->skyGrid->Delta;
+    if ( skyScan->lazyGrid != NULL ) {
+      XLAL_CHECK ( XLALGetLazySkyGridPoint ( &(gridpoint.Alpha), &(gridpoint.Delta), skyScan->lazyGrid, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    } else {
+      gridpoint.Alpha = skyScan->skyGrid->Alpha;
+      gridpoint.Delta = skyScan->skyGrid->Delta;
+    }
 
     XLAL_INIT_MEM ( gridpoint.fkdot );
     gridpoint.fkdot[0] = init->Freq;
@@ -311,6 +424,9 @@ XLALDestroyDopplerSkyScan ( DopplerSkyScanState *skyScan )
 
   skyScan->skyGrid = skyScan->skyNode = NULL;
 
+  XLALDestroyLazySkyGrid ( skyScan->lazyGrid );
+  skyScan->lazyGrid = NULL;
+
   if (skyScan->skyRegion.vertices) {
     XLALFree (skyScan->skyRegion.vertices);
   }
@@ -920,6 +1036,268 @@ buildIsotropicSkyGrid ( const SkyRegion *skyRegion, REAL8 dAlpha, REAL8 dDelta )
 
 } /* buildIsotropicSkyGrid() */
 
+
+/*----------------------------------------------------------------------
+ *
+ * test whether the candidate at coordinates (outer, inner) of a row is
+ * inside the sky-region, as in buildFlatSkyGrid() and buildIsotropicSkyGrid()
+ *
+ *----------------------------------------------------------------------*/
+static BOOLEAN
+lazySkyGridCandidate ( SkyPosition *point, const DopplerLazySkyGrid *grid, REAL8 outer, REAL8 inner )
+{
+  point->system = grid->region.lowerLeft.system;
+  point->longitude = grid->isotropic ? inner : outer;
+  point->latitude  = grid->isotropic ? outer : inner;
+
+  return grid->singlePoint || pointInPolygon ( point, &(grid->region) );
+
+} /* lazySkyGridCandidate() */
+
+
+/*----------------------------------------------------------------------
+ *
+ * tabulate the non-empty rows of a GRID_FLAT (columns of fixed longitude) or
+ * GRID_ISOTROPIC (rows of fixed latitude) sky-grid, without storing its points.
+ *
+ * The coordinates are accumulated exactly as in buildFlatSkyGrid() and
+ * buildIsotropicSkyGrid(), so XLALGetLazySkyGridPoint() returns identical points.
+ *
+ *----------------------------------------------------------------------*/
+static DopplerLazySkyGrid *
+XLALCreateLazyRowSkyGrid ( const SkyRegion *skyRegion, BOOLEAN isotropic, REAL8 dAlpha, REAL8 dDelta )
+{
+  XLAL_CHECK_NULL ( skyRegion != NULL, XLAL_EINVAL );
+  XLAL_CHECK_NULL ( (dAlpha > 0) && (dDelta > 0), XLAL_EINVAL );
+
+  DopplerLazySkyGrid *grid;
+  XLAL_CHECK_NULL ( (grid = XLALCalloc ( 1, sizeof(*grid) )) != NULL, XLAL_ENOMEM );
+
+  /* keep our own copy of the sky-region */
+  grid->region = (*skyRegion);
+  grid->region.vertices = NULL;
+  if ( skyRegion->numVertices > 0 )
+    {
+      if ( (grid->region.vertices = XLALMalloc ( skyRegion->numVertices * sizeof(grid->region.vertices[0]) )) == NULL ) {
+        XLALDestroyLazySkyGrid ( grid );
+        XLAL_ERROR_NULL ( XLAL_ENOMEM );
+      }
+      memcpy ( grid->region.vertices, skyRegion->vertices, skyRegion->numVertices * sizeof(grid->region.vertices[0]) );
+    }
+
+  grid->isotropic = isotropic;
+  grid->singlePoint = ( skyRegion->numVertices < 3 );	/* got no area to cover */
+  grid->innerStart = isotropic ? skyRegion->lowerLeft.longitude  : skyRegion->lowerLeft.latitude;
+  grid->innerEnd   = isotropic ? skyRegion->upperRight.longitude : skyRegion->upperRight.latitude;
+
+  REAL8 outer = isotropic ? skyRegion->lowerLeft.latitude : skyRegion->lowerLeft.longitude;
+  UINT4 maxRows = 0;
+  SkyPosition point;
+
+  while (1)
+    {
+      /* Alpha stepsize of isotropic grid depends on Delta */
+      REAL8 step = isotropic ? dAlpha / fabs ( cos ( outer ) ) : dDelta;
+
+      /* count sky-points in this row */
+      UINT8 count = 0;
+      REAL8 inner = grid->innerStart;
+      while (1)
+        {
+          if ( lazySkyGridCandidate ( &point, grid, outer, inner ) ) {
+            count ++;
+          }
+          inner += step;
+          if ( inner > grid->innerEnd ) {
+            break;
+          }
+        }
+
+      if ( count > 0 )
+        {
+          if ( (UINT8)grid->numPoints + count > LAL_UINT4_MAX ) {
+            XLALDestroyLazySkyGrid ( grid );
+            XLAL_ERROR_NULL ( XLAL_EDOM, "Number of sky-grid points exceeds range of UINT4\n" );
+          }
+          if ( grid->numRows == maxRows )
+            {
+              maxRows = (maxRows > 0) ? 2 * maxRows : 64;
+              LazySkyGridRow *rows = XLALRealloc ( grid->rows, maxRows * sizeof(grid->rows[0]) );
+              if ( rows == NULL ) {
+                XLALDestroyLazySkyGrid ( grid );
+                XLAL_ERROR_NULL ( XLAL_ENOMEM );
+              }
+              grid->rows = rows;
+            }
+          LazySkyGridRow *row = &(grid->rows[grid->numRows ++]);
+          row->outer = outer;
+          row->step = step;
+          row->firstIndex = grid->numPoints;
+          row->numPoints = count;
+          grid->numPoints += count;
+        }
+
+      /* this it the break-condition: are we done yet? */
+      if ( isotropic )
+        {
+          outer += dDelta;
+          if ( outer > skyRegion->upperRight.latitude ) {
+            break;
+          }
+        }
+      else
+        {
+          outer += dAlpha;
+          if ( outer >= skyRegion->upperRight.longitude + dAlpha ) {
+            break;
+          }
+        }
+
+    } /* while(1) */
+
+  if ( grid->numPoints == 0 ) {
+    XLALDestroyLazySkyGrid ( grid );
+    XLAL_ERROR_NULL ( XLAL_EDOM, "Sky-region contains no sky-grid points\n" );
+  }
+
+  /* position cursor at the first sky-point */
+  grid->cursorRow = 0;
+  grid->cursorIndex = 0;
+  grid->cursorInner = grid->innerStart;
+
+  return grid;
+
+} /* XLALCreateLazyRowSkyGrid() */
+
+
+/*----------------------------------------------------------------------
+ *
+ * store the points of a sky-grid list as arrays
+ *
+ *----------------------------------------------------------------------*/
+static DopplerLazySkyGrid *
+XLALCreateLazySkyGridFromList ( const DopplerSkyGrid *skyGrid )
+{
+  XLAL_CHECK_NULL ( skyGrid != NULL, XLAL_EINVAL );
+
+  DopplerLazySkyGrid *grid;
+  XLAL_CHECK_NULL ( (grid = XLALCalloc ( 1, sizeof(*grid) )) != NULL, XLAL_ENOMEM );
+
+  for ( const DopplerSkyGrid *node = skyGrid; node != NULL; node = node->next ) {
+    grid->numPoints ++;
+  }
+
+  grid->Alpha = XLALMalloc ( grid->numPoints * sizeof(grid->Alpha[0]) );
+  grid->Delta = XLALMalloc ( grid->numPoints * sizeof(grid->Delta[0]) );
+  if ( (grid->Alpha == NULL) || (grid->Delta == NULL) ) {
+    XLALDestroyLazySkyGrid ( grid );
+    XLAL_ERROR_NULL ( XLAL_ENOMEM );
+  }
+
+  UINT4 i = 0;
+  for ( const DopplerSkyGrid *node = skyGrid; node != NULL; node = node->next, i ++ )
+    {
+      grid->Alpha[i] = node->Alpha;
+      grid->Delta[i] = node->Delta;
+    }
+
+  return grid;
+
+} /* XLALCreateLazySkyGridFromList() */
+
+
+/*----------------------------------------------------------------------
+ *
+ * free a sky-grid for indexed access
+ *
+ *----------------------------------------------------------------------*/
+static void
+XLALDestroyLazySkyGrid ( DopplerLazySkyGrid *grid )
+{
+  if ( grid == NULL ) {
+    return;
+  }
+  if ( grid->Alpha ) {
+    XLALFree ( grid->Alpha );
+  }
+  if ( grid->Delta ) {
+    XLALFree ( grid->Delta );
+  }
+  if ( grid->rows ) {
+    XLALFree ( grid->rows );
+  }
+  if ( grid->region.vertices ) {
+    XLALFree ( grid->region.vertices );
+  }
+  XLALFree ( grid );
+
+  return;
+
+} /* XLALDestroyLazySkyGrid() */
+
+
+/*----------------------------------------------------------------------
+ *
+ * return sky-point 'index' (within the requested partition) of a sky-grid for indexed access.
+ *
+ * For a table of rows, the row is found by bisection and its points are regenerated
+ * from its start; a cursor is kept in the row so that sequential indices cost O(1).
+ *
+ *----------------------------------------------------------------------*/
+static int
+XLALGetLazySkyGridPoint ( REAL8 *Alpha, REAL8 *Delta, DopplerLazySkyGrid *grid, UINT4 index )
+{
+  XLAL_CHECK ( Alpha != NULL && Delta != NULL && grid != NULL, XLAL_EINVAL );
+
+  index += grid->firstIndex;
+  XLAL_CHECK ( index < grid->numPoints, XLAL_EDOM );
+
+  /* stored points */
+  if ( grid->rows == NULL )
+    {
+      (*Alpha) = grid->Alpha[index];
+      (*Delta) = grid->Delta[index];
+      return XLAL_SUCCESS;
+    }
+
+  /* restart from the beginning of the row containing 'index', unless it is ahead of the cursor in the current row */
+  const LazySkyGridRow *row = &(grid->rows[grid->cursorRow]);
+  if ( (index < grid->cursorIndex) || (index >= row->firstIndex + row->numPoints) )
+    {
+      UINT4 lo = 0, hi = grid->numRows;
+      while ( hi - lo > 1 )
+        {
+          UINT4 mid = lo + (hi - lo) / 2;
+          if ( grid->rows[mid].firstIndex <= index ) {
+            lo = mid;
+          } else {
+            hi = mid;
+          }
+        }
+      grid->cursorRow = lo;
+      grid->cursorIndex = grid->rows[lo].firstIndex;
+      grid->cursorInner = grid->innerStart;
+      row = &(grid->rows[lo]);
+    }
+
+  /* step along the row up to sky-point 'index' */
+  SkyPosition point;
+  while (1)
+    {
+      BOOLEAN inside = lazySkyGridCandidate ( &point, grid, row->outer, grid->cursorInner );
+      grid->cursorInner += row->step;
+      if ( inside && ( (grid->cursorIndex ++) == index ) ) {
+        break;
+      }
+    }
+
+  (*Alpha) = point.longitude;
+  (*Delta) = point.latitude;
+
+  return XLAL_SUCCESS;
+
+} /* XLALGetLazySkyGridPoint() */
+
 /**
  * Build the skygrid using a specified metric.
  *
@@ -1544,6 +1922,26 @@ fprintfDopplerParams ( FILE *fp, const PulsarDopplerParams *params )
   return 0;
 } /* printfDopplerParams() */
 
+/*----------------------------------------------------------------------
+ *
+ * first point and number of points of partition 'partitionIndex' of a
+ * sky-grid of Nsky points split into numPartitions (+/- 1) equal parts
+ *
+ *----------------------------------------------------------------------*/
+static void
+equiPartitionRange ( UINT4 *iMin, UINT4 *numPoints, UINT4 Nsky, UINT4 partitionIndex, UINT4 numPartitions )
+{
+  UINT4 Nt = Nsky / numPartitions;		/* integer division! */
+  UINT4 dp = Nsky - numPartitions * Nt;	/* dp = Nsky mod P : 0 <= dp < P */
+
+  /* first point in partion partitionIndex */
+  (*iMin) = fmin ( partitionIndex, dp ) * ( Nt + 1 )  + fmax ( 0, ((INT4)partitionIndex - (INT4)dp) ) * Nt;
+  (*numPoints) = (partitionIndex < dp) ? (Nt + 1) : Nt ;	/* number of points in partition partitionIndex */
+
+  return;
+
+} /* equiPartitionRange() */
+
 /**
  * Equi-partition (approximately) a given skygrid into numPartitions, and return
  * partition 0<= partitionIndex < numPartitions
@@ -1551,7 +1949,7 @@ fprintfDopplerParams ( FILE *fp, const PulsarDopplerParams *params )
 DopplerSkyGrid *
 XLALEquiPartitionSkygrid ( const DopplerSkyGrid *skygrid, UINT4 partitionIndex, UINT4 numPartitions )
 {
-  UINT4 Nsky, Nt, dp;
+  UINT4 Nsky;
   UINT4 iMin, numPoints;
   UINT4 counter;
   const DopplerSkyGrid *node;
@@ -1572,12 +1970,7 @@ XLALEquiPartitionSkygrid ( const DopplerSkyGrid *skygrid, UINT4 partitionIndex,
     XLAL_ERROR_NULL( XLAL_EINVAL );
 
   /* ----- determine integer equi-patitions (+/- 1) */
-  Nt = Nsky / numPartitions;		/* integer division! */
-  dp = Nsky - numPartitions * Nt;	/* dp = Nsky mod P : 0 <= dp < P */
-
-  /* first point in partion partitionIndex */
-  iMin = fmin ( partitionIndex, dp ) * ( Nt + 1 )  + fmax ( 0, ((INT4)partitionIndex - (INT4)dp) ) * Nt;
-  numPoints = (partitionIndex < dp) ? (Nt + 1) : Nt ;	/* number of points in partition partitionIndex */
+  equiPartitionRange ( &iMin, &numPoints, Nsky, partitionIndex, numPartitions );
 
   /* ----- generate skygrid patch partitionIndex */
 
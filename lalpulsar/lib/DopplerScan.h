@@ -146,9 +146,16 @@ typedef struct tagDopplerSkyScanInit {
   const CHAR *skyGridFile;		/**< file containing a sky-grid (list of points) if GRID_FILE */
   UINT4 numSkyPartitions;	/**< number of (roughly) equal partitions to split sky-grid into */
   UINT4 partitionIndex;		/**< index of requested sky-grid partition: in [0, numPartitions - 1] */
+  BOOLEAN lazySkyGrid;		/**< don't build the 'skyGrid' list: generate GRID_FLAT and GRID_ISOTROPIC points on demand, store other grids as arrays */
 } DopplerSkyScanInit;
 
+/** opaque type holding a sky-grid for indexed access, see DopplerSkyScanInit::lazySkyGrid */
+typedef struct tagDopplerLazySkyGrid DopplerLazySkyGrid;
+
 /** this structure reflects the current state of a DopplerSkyScan */
+#ifdef SWIG /* SWIG interface directives */
+SWIGLAL(IGNORE_MEMBERS(tagDopplerSkyScanState, lazyGrid));
+#endif /* SWIG */
 typedef struct tagDopplerSkyScanState {
   scan_state_t state;  			/**< idle, ready or finished */
   SkyRegion skyRegion; 		/**< polygon (and bounding square) defining sky-region  */
@@ -156,6 +163,8 @@ typedef struct tagDopplerSkyScanState {
   PulsarSpins dfkdot;		/**< fixed-size steps in spins */
   DopplerSkyGrid *skyGrid; 	/**< head of linked list of skygrid nodes */
   DopplerSkyGrid *skyNode;	/**< pointer to current grid-node in skygrid */
+  DopplerLazySkyGrid *lazyGrid;	/**< sky-grid for indexed access, used instead of 'skyGrid' if lazySkyGrid */
+  UINT4 skyIndex;		/**< index of next sky-point if lazySkyGrid */
 } DopplerSkyScanState;
 
 /** a "sky-ellipse", described by the two major axes and it's angle wrt x-axis */
@@ -172,6 +181,7 @@ void XLALDestroyDopplerSkyScan ( DopplerSkyScanState *skyScan );
 int XLALInitDopplerSkyScan ( DopplerSkyScanState *skyScan, const DopplerSkyScanInit *init);
 
 int  XLALNextDopplerSkyPos( PulsarDopplerParams *pos, DopplerSkyScanState *skyScan);
+int  XLALGetDopplerSkyPosByIndex ( PulsarDopplerParams *pos, DopplerSkyScanState *skyScan, UINT4 index );
 
 void writeSkyGridFile(LALStatus *, const DopplerSkyGrid *grid, const CHAR *fname );
 
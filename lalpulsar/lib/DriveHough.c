@@ -19,6 +19,10 @@
 
 #include <lal/LALHough.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /** \cond DONT_DOXYGEN */
 
 #ifdef __GNUC__
@@ -36,6 +40,15 @@
 #define SQ(x) (x) * (x)
 
 static void LALComputeAM (LALStatus *, AMCoeffs *coe, LIGOTimeGPS *ts, AMCoeffsParams *params);
+static INT4 HOUGHConstructOneHMT (HOUGHMapTotal *ht, HOUGHMapDeriv *hd, UINT8FrequencyIndexVector *freqInd, PHMDVectorSequence *phmdVS, BOOLEAN weighted);
+
+/* parameters of a look up table, with the index of its time stamp */
+typedef struct tagHOUGHParamPLUTIndex {
+  const HOUGHParamPLUT *par;
+  UINT4 index;
+} HOUGHParamPLUTIndex;
+static int HOUGHCompareParamPLUT (const void *a, const void *b);
+static void HOUGHCopyPLUT (HOUGHptfLUT *out, const HOUGHptfLUT *in, UINT2 ySide);
 
 /** \addtogroup LALHough_h */
 /** @{ */
@@ -580,6 +593,357 @@ void LALHOUGHConstructHMT_W (LALStatus                  *status,	/**< pointer to
 
 
 
+/**
+ * Given PHMDVectorSequence *phmdVS, the space of \c phmd, and an array of
+ * \c numMaps time-frequency trajectories UINT8FrequencyIndexVector freqInd[],
+ * e.g. for different spin-down values at the same search frequency, the
+ * function LALHOUGHConstructMultiHMT() produces the \c numMaps total Hough
+ * maps ht[]. The result is the same as calling LALHOUGHConstructHMT_W(), or
+ * LALHOUGHConstructHMT() if \c weighted is false, for each trajectory in turn.
+ *
+ * The maps are independent and, if compiled with OpenMP, are constructed in
+ * parallel by up to \c numThreads threads, each of which accumulates the
+ * \c phmd into its own Hough map derivative.
+ */
+void LALHOUGHConstructMultiHMT  (LALStatus                  *status,	/**< pointer to LALStatus structure */
+				 HOUGHMapTotal              *ht, 	/**< The output hough maps [numMaps] */
+				 UINT8FrequencyIndexVector  *freqInd,	/**< time-frequency trajectories [numMaps] */
+				 UINT4                      numMaps,	/**< number of maps to construct */
+				 PHMDVectorSequence         *phmdVS,	/**< set of partial hough map derivatives */
+				 BOOLEAN                    weighted,	/**< whether to use the weights of the \c phmd */
+				 UINT4                      numThreads	/**< maximum number of threads */)
+{
+
+  UINT4    m;
+  UINT4    length;    /* number of elements for each frequency */
+  UINT2    xSide,ySide;
+  INT4     errcode;
+
+  HOUGHMapDeriv *hdV = NULL; /* the Hough map derivatives, one per thread */
+  INT4          *errV = NULL; /* status codes, one per map */
+
+  /* --------------------------------------------- */
+  INITSTATUS(status);
+  ATTATCHSTATUSPTR (status);
+
+  /*   Make sure the arguments are not NULL: */
+  ASSERT (phmdVS,  status, LALHOUGHH_ENULL, LALHOUGHH_MSGENULL);
+  ASSERT (ht,      status, LALHOUGHH_ENULL, LALHOUGHH_MSGENULL);
+  ASSERT (freqInd, status, LALHOUGHH_ENULL, LALHOUGHH_MSGENULL);
+  ASSERT (phmdVS->phmd,  status, LALHOUGHH_ENULL, LALHOUGHH_MSGENULL);
+  /* -------------------------------------------   */
+
+  /* Make sure there are elements  */
+  ASSERT (numMaps, status, LALHOUGHH_ESIZE, LALHOUGHH_MSGESIZE);
+  ASSERT (numThreads, status, LALHOUGHH_ESIZE, LALHOUGHH_MSGESIZE);
+  ASSERT (phmdVS->length, status, LALHOUGHH_ESIZE, LALHOUGHH_MSGESIZE);
+  ASSERT (phmdVS->nfSize, status, LALHOUGHH_ESIZE, LALHOUGHH_MSGESIZE);
+  /* -------------------------------------------   */
+
+  /* Make sure initial breakLine is in [0,nfSize)  */
+  ASSERT ( phmdVS->breakLine < phmdVS->nfSize, status, LALHOUGHH_EVAL, LALHOUGHH_MSGEVAL);
+
+  length = phmdVS->length;
+
+  /* number of physical pixels; all maps must have the same size */
+  xSide = ht[0].xSide;
+  ySide = ht[0].ySide;
+  ASSERT (xSide, status, LALHOUGHH_ESIZE, LALHOUGHH_MSGESIZE);
+  ASSERT (ySide, status, LALHOUGHH_ESIZE, LALHOUGHH_MSGESIZE);
+
+  for ( m=0; m<numMaps; ++m ){
+    ASSERT (ht[m].map,       status, LALHOUGHH_ENULL, LALHOUGHH_MSGENULL);
+    ASSERT (freqInd[m].data, status, LALHOUGHH_ENULL, LALHOUGHH_MSGENULL);
+    ASSERT (ht[m].xSide == xSide, status, LALHOUGHH_ESZMM, LALHOUGHH_MSGESZMM);
+    ASSERT (ht[m].ySide == ySide, status, LALHOUGHH_ESZMM, LALHOUGHH_MSGESZMM);
+    ASSERT (freqInd[m].length == length, status,
+	    LALHOUGHH_ESZMM, LALHOUGHH_MSGESZMM);
+    ASSERT (freqInd[m].deltaF == phmdVS->deltaF, status,
+	    LALHOUGHH_ESZMM, LALHOUGHH_MSGESZMM);
+  }
+
+  /* no more threads than maps */
+  if ( numThreads > numMaps ) {
+    numThreads = numMaps;
+  }
+  /* -------------------------------------------   */
+
+  /* Initializing  hd maps and memory allocation */
+  hdV = (HOUGHMapDeriv *)LALCalloc(numThreads, sizeof(HOUGHMapDeriv));
+  errV = (INT4 *)LALCalloc(numMaps, sizeof(INT4));
+  if ( hdV == NULL || errV == NULL ) {
+    LALFree(hdV);
+    LALFree(errV);
+    ABORT( status, LALHOUGHH_EMEM, LALHOUGHH_MSGEMEM);
+  }
+  errcode = 0;
+  for ( m=0; m<numThreads; ++m ){
+    hdV[m].xSide = xSide;
+    hdV[m].ySide = ySide;
+    hdV[m].map = (HoughDT *)LALMalloc(ySide*(xSide+1)*sizeof(HoughDT));
+    if (hdV[m].map == NULL) {
+      errcode = LALHOUGHH_EMEM;
+    }
+  }
+  /* -------------------------------------------   */
+
+  if ( errcode == 0 ) {
+#pragma omp parallel for schedule(dynamic,1) num_threads(numThreads) if(numThreads > 1)
+    for ( m=0; m<numMaps; ++m ){
+#ifdef _OPENMP
+      HOUGHMapDeriv *hd = &hdV[omp_get_thread_num()];
+#else
+      HOUGHMapDeriv *hd = &hdV[0];
+#endif
+      errV[m] = HOUGHConstructOneHMT( &ht[m], hd, &freqInd[m], phmdVS, weighted );
+    }
+
+    /* report the first error */
+    for ( m=0; m<numMaps; ++m ){
+      if ( errV[m] != 0 ) {
+	errcode = errV[m];
+	break;
+      }
+    }
+  }
+
+  /* Free memory and exit */
+  for ( m=0; m<numThreads; ++m ){
+    LALFree(hdV[m].map);
+  }
+  LALFree(hdV);
+  LALFree(errV);
+
+  switch ( errcode ) {
+  case 0:
+    break;
+  case LALHOUGHH_EVAL:
+    ABORT( status, LALHOUGHH_EVAL, LALHOUGHH_MSGEVAL);
+  case LALHOUGHH_EMEM:
+    ABORT( status, LALHOUGHH_EMEM, LALHOUGHH_MSGEMEM);
+  default:
+    ABORT( status, LALHOUGHH_ESIZE, LALHOUGHH_MSGESIZE);
+  }
+
+  DETATCHSTATUSPTR (status);
+  /* normal exit */
+  RETURN (status);
+}
+
+/** \cond DONT_DOXYGEN */
+/*
+ * Construct a single total Hough map, using the given Hough map derivative
+ * as workspace; returns a nonzero code on failure. Used by
+ * LALHOUGHConstructMultiHMT(), and safe to call from several threads with
+ * different \c ht and \c hd.
+ */
+static INT4 HOUGHConstructOneHMT (HOUGHMapTotal              *ht,
+				  HOUGHMapDeriv              *hd,
+				  UINT8FrequencyIndexVector  *freqInd,
+				  PHMDVectorSequence         *phmdVS,
+				  BOOLEAN                    weighted)
+{
+
+  UINT4    k,j;
+  UINT4    length = phmdVS->length;
+  UINT4    nfSize = phmdVS->nfSize;
+  UINT4    breakLine = phmdVS->breakLine;
+  INT8     fBin;      /* present frequency bin */
+
+  LALStatus XLAL_INIT_DECL(status);
+
+  LALHOUGHInitializeHD(&status, hd);
+  if (status.statusCode) {
+    return status.statusCode;
+  }
+
+  for ( k=0; k<length; ++k ){
+    /* read the frequency index and make sure is in the proper interval*/
+    fBin = freqInd->data[k] - phmdVS->fBinMin;
+    if ( fBin < 0 || fBin >= (INT8)nfSize ) {
+      return LALHOUGHH_EVAL;
+    }
+
+    /* find index */
+    j = (fBin + breakLine) % nfSize;
+
+    /* Add the corresponding PHMD to HD */
+    if ( weighted ) {
+      LALHOUGHAddPHMD2HD_W(&status, hd, &(phmdVS->phmd[j*length+k]) );
+    } else {
+      LALHOUGHAddPHMD2HD(&status, hd, &(phmdVS->phmd[j*length+k]) );
+    }
+    if (status.statusCode) {
+      return status.statusCode;
+    }
+  }
+
+  LALHOUGHIntegrHD2HT(&status, ht, hd);
+
+  return status.statusCode;
+}
+/** \endcond */
+
+/**
+ * Given the parameters parV[] of the partial look up tables for the
+ * different time stamps, e.g. as calculated by LALHOUGHCalcParamPLUT() or
+ * LALNDHOUGHParamPLUT(), the function LALHOUGHConstructMultiPLUT() builds all
+ * the \c lut of the vector \c lutV for the same patch. The result is the same
+ * as calling LALHOUGHConstructPLUT() for each time stamp in turn.
+ *
+ * A look up table depends only on the patch and its parameters, i.e. on the
+ * velocity geometry of the time stamp as seen from the patch. Time stamps
+ * with identical parameters, e.g. from detectors at the same site, share
+ * one construction, which is then copied. The remaining tables are
+ * independent and, if compiled with OpenMP, are constructed in parallel by
+ * up to \c numThreads threads.
+ */
+void LALHOUGHConstructMultiPLUT (LALStatus             *status,	/**< pointer to LALStatus structure */
+				 HOUGHptfLUTVector     *lutV,	/**< The output look up tables */
+				 HOUGHPatchGrid        *patch,	/**< patch grid information */
+				 HOUGHParamPLUT        *parV,	/**< parameters of the look up tables [lutV->length] */
+				 UINT4                 numThreads	/**< maximum number of threads */)
+{
+
+  UINT4    j, length;
+  INT4     errcode;
+
+  HOUGHParamPLUTIndex *sorted = NULL; /* the parameters, in sorted order */
+  UINT4               *source = NULL; /* look up table to copy, per time stamp */
+  INT4                *errV = NULL;   /* status codes, one per time stamp */
+
+  /* --------------------------------------------- */
+  INITSTATUS(status);
+
+  /*   Make sure the arguments are not NULL: */
+  ASSERT (lutV,  status, LUTH_ENULL, LUTH_MSGENULL);
+  ASSERT (patch, status, LUTH_ENULL, LUTH_MSGENULL);
+  ASSERT (parV,  status, LUTH_ENULL, LUTH_MSGENULL);
+  ASSERT (lutV->lut, status, LUTH_ENULL, LUTH_MSGENULL);
+  /* -------------------------------------------   */
+
+  /* Make sure there are elements  */
+  length = lutV->length;
+  ASSERT (length, status, LUTH_ESIZE, LUTH_MSGESIZE);
+  ASSERT (numThreads, status, LUTH_ESIZE, LUTH_MSGESIZE);
+  /* -------------------------------------------   */
+
+  sorted = (HOUGHParamPLUTIndex *)LALMalloc(length*sizeof(HOUGHParamPLUTIndex));
+  source = (UINT4 *)LALMalloc(length*sizeof(UINT4));
+  errV = (INT4 *)LALCalloc(length, sizeof(INT4));
+  if ( sorted == NULL || source == NULL || errV == NULL ) {
+    LALFree(sorted);
+    LALFree(source);
+    LALFree(errV);
+    ABORT( status, LUTH_ESIZE, LUTH_MSGESIZE);
+  }
+
+  /* find the time stamps with identical parameters: after sorting, each
+     one is copied from the first of its run of equal parameters, provided
+     the memory of the two tables has the same layout */
+  for ( j=0; j<length; ++j ){
+    sorted[j].par = &parV[j];
+    sorted[j].index = j;
+    source[j] = j;
+  }
+  qsort(sorted, length, sizeof(HOUGHParamPLUTIndex), HOUGHCompareParamPLUT);
+  for ( j=1; j<length; ++j ){
+    const UINT4 first = source[sorted[j-1].index];
+    const UINT4 k = sorted[j].index;
+    if ( HOUGHCompareParamPLUT( &sorted[j-1], &sorted[j] ) == 0
+	 && lutV->lut[k].maxNBins == lutV->lut[first].maxNBins
+	 && lutV->lut[k].maxNBorders == lutV->lut[first].maxNBorders ) {
+      source[k] = first;
+    }
+  }
+  /* -------------------------------------------   */
+
+#pragma omp parallel for schedule(dynamic,1) num_threads(numThreads) if(numThreads > 1)
+  for ( j=0; j<length; ++j ){
+    if ( source[j] == j ) {
+      LALStatus XLAL_INIT_DECL(lutStatus);
+      LALHOUGHConstructPLUT( &lutStatus, &(lutV->lut[j]), patch, &parV[j] );
+      errV[j] = lutStatus.statusCode;
+    }
+  }
+
+  /* copy the shared tables, once they are all built */
+  errcode = 0;
+  for ( j=0; j<length; ++j ){
+    if ( errV[source[j]] != 0 ) {
+      errcode = errV[source[j]];
+      break;
+    }
+    if ( source[j] != j ) {
+      HOUGHCopyPLUT( &(lutV->lut[j]), &(lutV->lut[source[j]]), patch->ySide );
+    }
+  }
+
+  LALFree(sorted);
+  LALFree(source);
+  LALFree(errV);
+
+  switch ( errcode ) {
+  case 0:
+    break;
+  case LUTH_ENULL:
+    ABORT( status, LUTH_ENULL, LUTH_MSGENULL);
+  case LUTH_EVAL:
+    ABORT( status, LUTH_EVAL, LUTH_MSGEVAL);
+  default:
+    ABORT( status, LUTH_ESIZE, LUTH_MSGESIZE);
+  }
+
+  /* normal exit */
+  RETURN (status);
+}
+
+/** \cond DONT_DOXYGEN */
+/* order the parameters of two look up tables; zero if they are identical */
+static int HOUGHCompareParamPLUT (const void *a, const void *b)
+{
+  const HOUGHParamPLUT *pa = ((const HOUGHParamPLUTIndex *)a)->par;
+  const HOUGHParamPLUT *pb = ((const HOUGHParamPLUTIndex *)b)->par;
+  const REAL8 ra[] = { pa->deltaF, pa->xi.alpha, pa->xi.delta, pa->cosDelta, pa->cosPhiMax0, pa->cosPhiMin0, pa->epsilon };
+  const REAL8 rb[] = { pb->deltaF, pb->xi.alpha, pb->xi.delta, pb->cosDelta, pb->cosPhiMax0, pb->cosPhiMin0, pb->epsilon };
+  UINT4 i;
+
+  if ( pa->f0Bin != pb->f0Bin )
+    return ( pa->f0Bin < pb->f0Bin ) ? -1 : 1;
+  if ( pa->offset != pb->offset )
+    return ( pa->offset < pb->offset ) ? -1 : 1;
+  if ( pa->nFreqValid != pb->nFreqValid )
+    return ( pa->nFreqValid < pb->nFreqValid ) ? -1 : 1;
+  for ( i=0; i<sizeof(ra)/sizeof(ra[0]); ++i ){
+    if ( ra[i] != rb[i] )
+      return ( ra[i] < rb[i] ) ? -1 : 1;
+  }
+  return 0;
+}
+
+/* copy a look up table, as built by LALHOUGHConstructPLUT(), into another
+   one of the same layout; the borders use ySide rows of the patch */
+static void HOUGHCopyPLUT (HOUGHptfLUT *out, const HOUGHptfLUT *in, UINT2 ySide)
+{
+  UINT4 i;
+
+  out->f0Bin = in->f0Bin;
+  out->deltaF = in->deltaF;
+  out->nFreqValid = in->nFreqValid;
+  out->iniBin = in->iniBin;
+  out->nBin = in->nBin;
+  out->offset = in->offset;
+
+  memcpy(out->bin, in->bin, in->maxNBins*sizeof(HOUGHBin2Border));
+  for ( i=0; i<in->maxNBorders; ++i ){
+    out->border[i].yUpper = in->border[i].yUpper;
+    out->border[i].yLower = in->border[i].yLower;
+    out->border[i].yCenter = in->border[i].yCenter;
+    memcpy(out->border[i].xPixel, in->border[i].xPixel, ySide*sizeof(COORType));
+  }
+}
+/** \endcond */
+
 /**
  * Adds weight factors for set of partial hough map derivatives -- the
  * weights must be calculated outside this function.
@@ -50,6 +50,8 @@ int fffree( void *, int * );
 
 #endif // defined(HAVE_LIBCFITSIO)
 
+#include <gsl/gsl_math.h>
+
 #include <lal/FITSFileIO.h>
 #include <lal/LALString.h>
 #include <lal/StringVector.h>
@@ -2534,18 +2536,54 @@ int XLALFITSTableColumnAddGPSTime( FITSFile UNUSED *file, const CHAR UNUSED *col
 #endif // !defined(HAVE_LIBCFITSIO)
 }
 
+///
+/// Work out pointer to the field of table column \p i in a table row record
+///
+static void UNUSED *FITSTableRecordField( const FITSFile UNUSED *file, const int UNUSED i, const void UNUSED *record )
+{
+#if !defined(HAVE_LIBCFITSIO)
+  return NULL;
+#else // defined(HAVE_LIBCFITSIO)
+  union { const void *cv; void *v; } bad_cast = { .cv = record };
+  void *value = bad_cast.v;
+  for ( size_t n = 0; n < file->table.noffsets[i]; ++n ) {
+    if ( n > 0 ) {
+      value = *( ( void ** ) value );
+    }
+    value = ( void * )( ( ( intptr_t ) value ) + file->table.offsets[i][n] );
+  }
+  return value;
+#endif // !defined(HAVE_LIBCFITSIO)
+}
+
 int XLALFITSTableWriteRow( FITSFile UNUSED *file, const void UNUSED *record )
+{
+  XLAL_CHECK( XLALFITSTableWriteRows( file, &record, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+int XLALFITSTableReadRow( FITSFile UNUSED *file, void UNUSED *record, UINT8 UNUSED *rem_nrows )
+{
+  XLAL_CHECK( XLALFITSTableReadRows( file, &record, 1, NULL, rem_nrows ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+int XLALFITSTableWriteRows( FITSFile UNUSED *file, const void UNUSED *const records[], const size_t UNUSED nrecords )
 {
 #if !defined(HAVE_LIBCFITSIO)
   XLAL_ERROR( XLAL_EFAILED, "CFITSIO is not available" );
 #else // defined(HAVE_LIBCFITSIO)
 
   int UNUSED status = 0;
+  CHAR **strs = NULL;
 
   // Check input
   XLAL_CHECK_FAIL( file != NULL, XLAL_EFAULT );
   XLAL_CHECK_FAIL( file->write, XLAL_EINVAL, "FITS file is not open for writing" );
-  XLAL_CHECK_FAIL( record != NULL, XLAL_EFAULT );
+  XLAL_CHECK_FAIL( nrecords == 0 || records != NULL, XLAL_EFAULT );
+  for ( size_t r = 0; r < nrecords; ++r ) {
+    XLAL_CHECK_FAIL( records[r] != NULL, XLAL_EFAULT );
+  }
 
   // Check that we are at a table
   XLAL_CHECK_FAIL( file->hdutype == BINARY_TBL, XLAL_EIO, "Current FITS file HDU is not a table" );
@@ -2561,35 +2599,68 @@ int XLALFITSTableWriteRow( FITSFile UNUSED *file, const void UNUSED *record )
     CALL_FITS( fits_create_tbl, file->ff, file->hdutype, 0, file->table.tfields, ttype_ptr, tform_ptr, tunit_ptr, NULL );
     CALL_FITS( fits_write_key_str, file->ff, "HDUNAME", file->hduname, file->hducomment );
   }
+  if ( nrecords == 0 ) {
+    return XLAL_SUCCESS;
+  }
 
-  // Advance to next row
-  ++file->table.irow;
+  // Write rows in chunks of the optimal number of rows for CFITSIO I/O
+  long chunk_nrows = 0;
+  CALL_FITS( fits_get_rowsize, file->ff, &chunk_nrows );
+  if ( chunk_nrows < 1 ) {
+    chunk_nrows = 1;
+  }
+  const size_t max_nrows = GSL_MIN( ( size_t ) chunk_nrows, nrecords );
+  strs = XLALCalloc( max_nrows, sizeof( *strs ) );
+  XLAL_CHECK_FAIL( strs != NULL, XLAL_ENOMEM );
+  for ( size_t r0 = 0; r0 < nrecords; r0 += max_nrows ) {
+    const size_t nrows = GSL_MIN( max_nrows, nrecords - r0 );
 
-  // Write next table row
-  for ( int i = 0; i < file->table.tfields; ++i ) {
+    // Write a block of each table column
+    for ( int i = 0; i < file->table.tfields; ++i ) {
+      void *pvalue = NULL;
+      if ( file->table.datatype[i] == TSTRING ) {
+
+        // Point to strings in records
+        for ( size_t r = 0; r < nrows; ++r ) {
+          strs[r] = FITSTableRecordField( file, i, records[r0 + r] );
+        }
+        pvalue = strs;
+
+      } else {
+
+        // Resize temporary buffer, if required
+        const size_t req_buf_size = nrows * file->table.field_size[i];
+        if ( file->buf_size < req_buf_size ) {
+          file->buf = XLALRealloc( file->buf, req_buf_size );
+          XLAL_CHECK_FAIL( file->buf != NULL, XLAL_ENOMEM );
+          file->buf_size = req_buf_size;
+        }
+
+        // Gather data in records into contiguous block of temporary buffer
+        for ( size_t r = 0; r < nrows; ++r ) {
+          memcpy( file->buf + r * file->table.field_size[i], FITSTableRecordField( file, i, records[r0 + r] ), file->table.field_size[i] );
+        }
+        pvalue = file->buf;
 
-    // Work out pointer to correct place in record
-    union { const void *cv; void *v; } bad_cast = { .cv = record };
-    void *value = bad_cast.v;
-    for ( size_t n = 0; n < file->table.noffsets[i]; ++n ) {
-      if ( n > 0 ) {
-        value = *( ( void ** ) value );
       }
-      value = ( void * )( ( ( intptr_t ) value ) + file->table.offsets[i][n] );
+      CALL_FITS( fits_write_col, file->ff, file->table.datatype[i], file->table.colnum[i], file->table.irow + 1, 1, nrows * file->table.nelements[i], pvalue );
     }
 
-    // Write data in record to table column
-    {
-      void *pvalue = ( file->table.datatype[i] == TSTRING ) ? ( void * ) &value : value;
-      CALL_FITS( fits_write_col, file->ff, file->table.datatype[i], file->table.colnum[i], file->table.irow, 1, file->table.nelements[i], pvalue );
-    }
+    // Advance past written rows
+    file->table.irow += nrows;
 
   }
 
+  // Cleanup
+  XLALFree( strs );
+
   return XLAL_SUCCESS;
 
 XLAL_FAIL:
 
+  // Cleanup
+  XLALFree( strs );
+
   // Delete FITS file on error
   if ( file != NULL && file->ff != NULL ) {
     fits_delete_file( file->ff, &status );
@@ -2601,69 +2672,100 @@ XLAL_FAIL:
 #endif // !defined(HAVE_LIBCFITSIO)
 }
 
-int XLALFITSTableReadRow( FITSFile UNUSED *file, void UNUSED *record, UINT8 UNUSED *rem_nrows )
+int XLALFITSTableReadRows( FITSFile UNUSED *file, void UNUSED *const records[], const size_t UNUSED nrecords, size_t UNUSED *nread, UINT8 UNUSED *rem_nrows )
 {
 #if !defined(HAVE_LIBCFITSIO)
   XLAL_ERROR( XLAL_EFAILED, "CFITSIO is not available" );
 #else // defined(HAVE_LIBCFITSIO)
 
   int UNUSED status = 0;
+  CHAR **strs = NULL;
 
   // Check input
   XLAL_CHECK_FAIL( file != NULL, XLAL_EFAULT );
   XLAL_CHECK_FAIL( !file->write, XLAL_EINVAL, "FITS file is not open for reading" );
-  XLAL_CHECK_FAIL( record != NULL, XLAL_EFAULT );
+  XLAL_CHECK_FAIL( nrecords == 0 || records != NULL, XLAL_EFAULT );
 
   // Check that we are at a table
   XLAL_CHECK_FAIL( file->hdutype == BINARY_TBL, XLAL_EIO, "Current FITS file HDU is not a table" );
 
+  // Read no more than the number of remaining rows
+  const size_t nrecords_read = GSL_MIN( nrecords, ( size_t )( file->table.nrows - file->table.irow ) );
+  for ( size_t r = 0; r < nrecords_read; ++r ) {
+    XLAL_CHECK_FAIL( records[r] != NULL, XLAL_EFAULT );
+  }
+  if ( nread != NULL ) {
+    *nread = nrecords_read;
+  }
+
   // Return if there are no more rows
-  if ( file->table.irow == file->table.nrows ) {
+  if ( nrecords_read == 0 ) {
     return XLAL_SUCCESS;
   }
 
-  // Advance to next row, and return number of remaining rows
-  ++file->table.irow;
-  if ( rem_nrows != NULL ) {
-    *rem_nrows = file->table.nrows - file->table.irow;
+  // Read rows in chunks of the optimal number of rows for CFITSIO I/O
+  long chunk_nrows = 0;
+  CALL_FITS( fits_get_rowsize, file->ff, &chunk_nrows );
+  if ( chunk_nrows < 1 ) {
+    chunk_nrows = 1;
   }
+  const size_t max_nrows = GSL_MIN( ( size_t ) chunk_nrows, nrecords_read );
+  strs = XLALCalloc( max_nrows, sizeof( *strs ) );
+  XLAL_CHECK_FAIL( strs != NULL, XLAL_ENOMEM );
+  for ( size_t r0 = 0; r0 < nrecords_read; r0 += max_nrows ) {
+    const size_t nrows = GSL_MIN( max_nrows, nrecords_read - r0 );
 
-  // Read next table row
-  for ( int i = 0; i < file->table.tfields; ++i ) {
-
-    // Resize temporary buffer, if required
-    // - Require double the field size to allow for buffer overruns in CFITSIO
-    const size_t req_buf_size = 2 * file->table.field_size[i];
-    if ( file->buf_size < req_buf_size ) {
-      file->buf = XLALRealloc( file->buf, req_buf_size );
-      XLAL_CHECK( file->buf != NULL, XLAL_ENOMEM );
-      file->buf_size = req_buf_size;
-    }
-    memset( file->buf, 0, req_buf_size );
+    // Read a block of each table column
+    for ( int i = 0; i < file->table.tfields; ++i ) {
 
-    // Read data from table column into temporary buffer
-    {
-      void *pbuf = ( file->table.datatype[i] == TSTRING ) ? ( void * ) &file->buf : file->buf;
-      CALL_FITS( fits_read_col, file->ff, file->table.datatype[i], file->table.colnum[i], file->table.irow, 1, file->table.nelements[i], NULL, pbuf, NULL );
-    }
+      // Resize temporary buffer, if required
+      // - Strings require double the field size to allow for buffer overruns in CFITSIO
+      const size_t row_buf_size = ( file->table.datatype[i] == TSTRING ) ? 2 * file->table.field_size[i] : file->table.field_size[i];
+      const size_t req_buf_size = nrows * row_buf_size;
+      if ( file->buf_size < req_buf_size ) {
+        file->buf = XLALRealloc( file->buf, req_buf_size );
+        XLAL_CHECK_FAIL( file->buf != NULL, XLAL_ENOMEM );
+        file->buf_size = req_buf_size;
+      }
+      memset( file->buf, 0, req_buf_size );
+
+      // Read block of table column into temporary buffer
+      void *pbuf = file->buf;
+      if ( file->table.datatype[i] == TSTRING ) {
+        for ( size_t r = 0; r < nrows; ++r ) {
+          strs[r] = file->buf + r * row_buf_size;
+        }
+        pbuf = strs;
+      }
+      CALL_FITS( fits_read_col, file->ff, file->table.datatype[i], file->table.colnum[i], file->table.irow + 1, 1, nrows * file->table.nelements[i], NULL, pbuf, NULL );
 
-    // Work out pointer to correct place in record
-    void *value = record;
-    for ( size_t n = 0; n < file->table.noffsets[i]; ++n ) {
-      if ( n > 0 ) {
-        value = *( ( void ** ) value );
+      // Copy the required length of each row in the temporary buffer into the records
+      for ( size_t r = 0; r < nrows; ++r ) {
+        memcpy( FITSTableRecordField( file, i, records[r0 + r] ), file->buf + r * row_buf_size, file->table.field_size[i] );
       }
-      value = ( void * )( ( ( intptr_t ) value ) + file->table.offsets[i][n] );
+
     }
 
-    // Copy the required length of the temporary buffer into the record
-    memcpy( value, file->buf, file->table.field_size[i] );
+    // Advance past read rows
+    file->table.irow += nrows;
+
+  }
 
+  // Return number of remaining rows
+  if ( rem_nrows != NULL ) {
+    *rem_nrows = file->table.nrows - file->table.irow;
   }
 
+  // Cleanup
+  XLALFree( strs );
+
   return XLAL_SUCCESS;
 
 XLAL_FAIL:
+
+  // Cleanup
+  XLALFree( strs );
+
   return XLAL_FAILURE;
 
 #endif // !defined(HAVE_LIBCFITSIO)
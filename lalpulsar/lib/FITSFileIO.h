@@ -214,6 +214,9 @@ int XLALFITSArrayReadGSLMatrix( FITSFile *file, const size_t idx[], gsl_matrix *
 ///
 /// Finally, XLALFITSTableWriteRow() or XLALFITSTableReadRow() are called to write/read table rows;
 /// the latter returns the number of rows remaining in the table \p rem_nrows, if needed.
+/// XLALFITSTableWriteRows() and XLALFITSTableReadRows() write/read an array of \p nrecords pointers
+/// to table row records at once, moving a block of rows of each table column per CFITSIO call;
+/// the latter also returns the number of rows actually read \p nread, if needed.
 ///
 /// @{
 int XLALFITSTableOpenWrite( FITSFile *file, const CHAR *name, const CHAR *comment );
@@ -286,6 +289,8 @@ int XLALFITSTableColumnAddGPSTime( FITSFile *file, const CHAR *col_name, const s
 
 int XLALFITSTableWriteRow( FITSFile *file, const void *record );
 int XLALFITSTableReadRow( FITSFile *file, void *record, UINT8 *rem_nrows );
+int XLALFITSTableWriteRows( FITSFile *file, const void *const records[], const size_t nrecords );
+int XLALFITSTableReadRows( FITSFile *file, void *const records[], const size_t nrecords, size_t *nread, UINT8 *rem_nrows );
 /// @}
 
 /// @}
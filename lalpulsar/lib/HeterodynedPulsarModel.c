@@ -465,35 +465,40 @@ REAL8Vector *XLALHeterodynedPulsarGetBSBDelay( PulsarParameters *pars,
   REAL8 cgw = PulsarGetREAL8ParamOrZero(pars, "CGW");
 
   REAL8Vector *bdts = NULL;
-  BinaryPulsarInput binput;
-  BinaryPulsarOutput boutput;
-  EarthState earth;
+  REAL8Vector *tbs = NULL;
+  EarthState *earth = NULL;
 
   INT4 i = 0, length = datatimes->length;
 
   bdts = XLALCreateREAL8Vector( length );
+  XLAL_CHECK_NULL( bdts != NULL, XLAL_EFUNC );
   memset(bdts->data, 0, bdts->length*sizeof(REAL8));  // set to zeros
 
   /* check whether there's a binary model */
   if ( PulsarCheckParam( pars, "BINARY" ) ){
+    XLAL_CHECK_NULL( ( tbs = XLALCreateREAL8Vector( length ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_NULL( ( earth = XLALCalloc( length > 0 ? length : 1, sizeof(*earth) ) ) != NULL, XLAL_ENOMEM );
+
     for ( i = 0; i < length; i++ ){
-      binput.tb = XLALGPSGetREAL8( &datatimes->data[i] ) + dts->data[i];
+      tbs->data[i] = XLALGPSGetREAL8( &datatimes->data[i] ) + dts->data[i];
 
-      XLALGetEarthPosVel( &earth, edat, &datatimes->data[i] );
+      XLALGetEarthPosVel( &earth[i], edat, &datatimes->data[i] ); /* current Earth state */
+    }
 
-      binput.earth = earth; /* current Earth state */
-      XLALBinaryPulsarDeltaTNew( &boutput, &binput, pars );
-      
-      if ( cgw > 0. ){
-        /* account for the speed of GWs not being the same as the speed of light
-         * NOTE: here we have to assume that the Roemer delay, which is effected
-         * by the speed difference is dominating the delay term. */
-        bdts->data[i] = boutput.deltaT / cgw;
-      }
-      else{
-        bdts->data[i] = boutput.deltaT;
+    /* compute the delays for all times at once, so that Kepler's equation can be solved incrementally */
+    XLAL_CHECK_NULL( XLALBinaryPulsarDeltaTNewVector( bdts, tbs, earth, pars ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    if ( cgw > 0. ){
+      /* account for the speed of GWs not being the same as the speed of light
+       * NOTE: here we have to assume that the Roemer delay, which is effected
+       * by the speed difference is dominating the delay term. */
+      for ( i = 0; i < length; i++ ){
+        bdts->data[i] /= cgw;
       }
     }
+
+    XLALDestroyREAL8Vector( tbs );
+    XLALFree( earth );
   }
   return bdts;
 }
@@ -19,6 +19,20 @@
 
 #include <lal/HoughMap.h>
 
+/* print the first out-of-bounds map index of a border, found at line 'line' of the caller */
+static void HOUGHReportBadIndex(int line, INT2 yLower, INT2 yUpper, const COORType *xPixel, UINT2 xSide, UINT2 ySide)
+{
+  INT4 j, sidx;
+  for(j=yLower; j<=yUpper;++j){
+    sidx = j*(xSide+1) + xPixel[j];
+    if ((sidx < 0) || (sidx >= ySide*(xSide+1))) {
+      fprintf(stderr,"\nERROR: %s %d: map index out of bounds: %d [0..%d] j:%d xp[j]:%d\n",
+	      __FILE__,line,sidx,ySide*(xSide+1),j,xPixel[j] );
+      return;
+    }
+  }
+}
+
 /*
  * The functions that make up the guts of this module
  */
@@ -130,6 +144,7 @@ void LALHOUGHAddPHMD2HD (LALStatus      *status, 	/**< the status pointer */
   UINT2    lengthLeft,lengthRight, xSide,ySide;
   COORType     *xPixel;
   HOUGHBorder  *borderP;
+  HoughDT    * restrict map;
 
    /* --------------------------------------------- */
   INITSTATUS(status);
@@ -145,10 +160,11 @@ void LALHOUGHAddPHMD2HD (LALStatus      *status, 	/**< the status pointer */
 
   xSide = hd->xSide;
   ySide = hd->ySide;
+  map = hd->map;
 
   /* first column correction */
   for ( k=0; k< ySide; ++k ){
-    hd->map[k*(xSide+1) + 0] += phmd->firstColumn[k];
+    map[k*(xSide+1) + 0] += phmd->firstColumn[k];
   }
 
   lengthLeft = phmd->lengthLeft;
@@ -180,7 +196,7 @@ void LALHOUGHAddPHMD2HD (LALStatus      *status, 	/**< the status pointer */
     }
 
     for(j=yLower; j<=yUpper;++j){
-      hd->map[j *(xSide+1) + xPixel[j] ] += 1;
+      map[j *(xSide+1) + xPixel[j] ] += 1;
     }
   }
 
@@ -210,7 +226,7 @@ void LALHOUGHAddPHMD2HD (LALStatus      *status, 	/**< the status pointer */
     }
 
     for(j=yLower; j<=yUpper;++j){
-      hd->map[j*(xSide+1) + xPixel[j] ] -= 1;
+      map[j*(xSide+1) + xPixel[j] ] -= 1;
     }
   }
 
@@ -240,6 +256,8 @@ void LALHOUGHAddPHMD2HD_W (LALStatus      *status, 	/**< the status pointer */
   HOUGHBorder  *borderP;
   HoughDT    weight;
   INT4       sidx; /* pre-calcuted array index for sanity check */
+  INT4       badidx;
+  HoughDT    * restrict map;
 
    /* --------------------------------------------- */
   INITSTATUS(status);
@@ -257,10 +275,11 @@ void LALHOUGHAddPHMD2HD_W (LALStatus      *status, 	/**< the status pointer */
 
   xSide = hd->xSide;
   ySide = hd->ySide;
+  map = hd->map;
 
   /* first column correction */
   for ( k=0; k< ySide; ++k ){
-    hd->map[k*(xSide+1) + 0] += phmd->firstColumn[k] * weight;
+    map[k*(xSide+1) + 0] += phmd->firstColumn[k] * weight;
   }
 
   lengthLeft = phmd->lengthLeft;
@@ -290,14 +309,19 @@ void LALHOUGHAddPHMD2HD_W (LALStatus      *status, 	/**< the status pointer */
       yUpper = ySide - 1;
     }
 
+    /* sanity check all map indices of this border before updating them,
+       so that the update loop across rows below is free of branches */
+    badidx = 0;
     for(j=yLower; j<=yUpper;++j){
       sidx = j *(xSide+1) + xPixel[j];
-      if ((sidx < 0) || (sidx >= ySide*(xSide+1))) {
-	fprintf(stderr,"\nERROR: %s %d: map index out of bounds: %d [0..%d] j:%d xp[j]:%d\n",
-		__FILE__,__LINE__,sidx,ySide*(xSide+1),j,xPixel[j] );
-	ABORT(status, HOUGHMAPH_ESIZE, HOUGHMAPH_MSGESIZE);
-      }
-      hd->map[sidx] += weight;
+      badidx |= ((sidx < 0) || (sidx >= ySide*(xSide+1)));
+    }
+    if (badidx) {
+      HOUGHReportBadIndex(__LINE__, yLower, yUpper, xPixel, xSide, ySide);
+      ABORT(status, HOUGHMAPH_ESIZE, HOUGHMAPH_MSGESIZE);
+    }
+    for(j=yLower; j<=yUpper;++j){
+      map[j*(xSide+1) + xPixel[j]] += weight;
     }
   }
 
@@ -325,14 +349,19 @@ void LALHOUGHAddPHMD2HD_W (LALStatus      *status, 	/**< the status pointer */
       yUpper = ySide - 1;
     }
 
+    /* sanity check all map indices of this border before updating them,
+       so that the update loop across rows below is free of branches */
+    badidx = 0;
+    for(j=yLower; j<=yUpper;++j){
+      sidx = j *(xSide+1) + xPixel[j];
+      badidx |= ((sidx < 0) || (sidx >= ySide*(xSide+1)));
+    }
+    if (badidx) {
+      HOUGHReportBadIndex(__LINE__, yLower, yUpper, xPixel, xSide, ySide);
+      ABORT(status, HOUGHMAPH_ESIZE, HOUGHMAPH_MSGESIZE);
+    }
     for(j=yLower; j<=yUpper;++j){
-      sidx = j*(xSide+1) + xPixel[j];
-      if ((sidx < 0) || (sidx >= ySide*(xSide+1))) {
-	fprintf(stderr,"\nERROR: %s %d: map index out of bounds: %d [0..%d] j:%d xp[j]:%d\n",
-		__FILE__,__LINE__,sidx,ySide*(xSide+1),j,xPixel[j] );
-	ABORT(status, HOUGHMAPH_ESIZE, HOUGHMAPH_MSGESIZE);
-      }
-      hd->map[sidx] -= weight;
+      map[j*(xSide+1) + xPixel[j]] -= weight;
     }
   }
 
@@ -56,6 +56,26 @@ struct tagBarycenterBuffer
   BOOLEAN active;		/// switch set on TRUE of buffer has been filled
 }; // struct tagBarycenterBuffer
 
+/// ---------- internal entry type of the precomputed barycentering cache ----------
+typedef struct tagBarycenterCacheEntry
+{
+  LIGOTimeGPS tgps;		/// arrival time (GPS) at detector
+  REAL8 dt_n[3];		/// coefficients of sky-vector n in deltaT: Roemer + Earth rotation (incl. precession and nutation)
+  REAL8 tdot_n[3];		/// coefficients of sky-vector n in tDot: droemer + derot
+  REAL8 dt0;			/// sky-independent part of deltaT: einstein + observatory term
+  REAL8 tdot0;			/// sky-independent part of tDot: 1 + deinstein
+  REAL8 se[3];			/// Sun-to-Earth vector (for Shapiro delay), in sec
+  REAL8 dse[3];			/// d(se)/d(tgps)
+  REAL8 rse;			/// length of se
+  REAL8 drse;			/// d(rse)/d(tgps)
+} BarycenterCacheEntry;
+
+struct tagBarycenterCache
+{
+  UINT4 length;			/// number of timestamps
+  BarycenterCacheEntry *data;	/// per-timestamp sky-independent barycentering quantities
+}; // struct tagBarycenterCache
+
 /* Internal functions */
 static void precessionMatrix( REAL8 prn[3][3], REAL8 mjd, REAL8 dpsi, REAL8 deps );
 static void observatoryEarth( REAL8 obsearth[3], const LALDetector det, const LIGOTimeGPS *tgps, REAL8 gmst, REAL8 dpsi, REAL8 deps );
@@ -519,7 +539,7 @@ XLALBarycenterEarthNew ( EarthState *earth,                /**< [out] the earth'
     REAL8 tdiffS;
     REAL8 tdiff2S;
 
-    static REAL8 scorr; /* SI second/metre correction factor */
+    REAL8 scorr; /* SI second/metre correction factor */
 
     INT4 j; /*dummy index */
 
@@ -1461,6 +1481,212 @@ XLALBarycenterOpt ( EmissionTime *emit, 		/**< [out] emission-time information *
 
 } /* XLALBarycenterOpt() */
 
+/**
+ * Create a cache of sky-independent barycentering quantities for \\a length timestamps,
+ * to be filled by XLALSetBarycenterCache() and evaluated by XLALEvaluateBarycenterCache().
+ */
+BarycenterCache *
+XLALCreateBarycenterCache ( UINT4 length		/**< [in] number of timestamps */
+                            )
+{
+  BarycenterCache *cache = XLALCalloc ( 1, sizeof(*cache) );
+  XLAL_CHECK_NULL ( cache != NULL, XLAL_ENOMEM );
+  cache->length = length;
+  if ( length > 0 )
+    {
+      cache->data = XLALCalloc ( length, sizeof(cache->data[0]) );
+      if ( cache->data == NULL )
+        {
+          XLALFree ( cache );
+          XLAL_ERROR_NULL ( XLAL_ENOMEM );
+        }
+    }
+  return cache;
+
+} /* XLALCreateBarycenterCache() */
+
+/**
+ * Destroy a barycentering cache created by XLALCreateBarycenterCache().
+ */
+void
+XLALDestroyBarycenterCache ( BarycenterCache *cache )
+{
+  if ( cache == NULL )
+    return;
+  XLALFree ( cache->data );
+  XLALFree ( cache );
+} /* XLALDestroyBarycenterCache() */
+
+/**
+ * Fill entry \\a i of a barycentering cache from the earth-state at the arrival time \\a tgps.
+ *
+ * Apart from the Shapiro delay, every sky-dependent term computed by XLALBarycenterOpt() (Roemer delay,
+ * Earth rotation including lunisolar precession and nutation, and their derivatives) is linear in the
+ * unit vector \\f$\\vec{n}\\f$ pointing to the source. Their coefficients are computed here once per
+ * timestamp, so that XLALEvaluateBarycenterCache() only needs a few multiply-adds and a logarithm per
+ * timestamp for each sky position.
+ */
+int
+XLALSetBarycenterCache ( BarycenterCache *cache,	/**< [in/out] barycentering cache */
+                         UINT4 i,			/**< [in] index of entry to fill */
+                         const LIGOTimeGPS *tgps,	/**< [in] arrival time (GPS) at detector */
+                         const LALDetector *site,	/**< [in] detector site; location in units of seconds, as for BarycenterInput */
+                         const EarthState *earth	/**< [in] earth-state at \\a tgps (from XLALBarycenterEarth()) */
+                         )
+{
+  XLAL_CHECK ( cache != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( i < cache->length, XLAL_EINVAL, "Invalid cache index %u >= length %u", i, cache->length );
+  XLAL_CHECK ( tgps != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( site != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( earth != NULL, XLAL_EFAULT );
+
+  // same constants as XLALBarycenterOpt()
+  const REAL8 OMEGA = 7.29211510e-5;
+  const REAL8 sinEps0 = 0.397777155931914;
+  const REAL8 cosEps0 = 0.917482062069182;
+
+  BarycenterCacheEntry *entry = &cache->data[i];
+  entry->tgps = (*tgps);
+
+  // ---------- detector site
+  const REAL8 rd = sqrt ( site->location[0]*site->location[0] + site->location[1]*site->location[1] + site->location[2]*site->location[2] );
+  const REAL8 longitude = atan2 ( site->location[1], site->location[0] );
+  const REAL8 latitude = ( rd == 0.0 ) ? LAL_PI_2 : LAL_PI_2 - acos ( site->location[2] / rd );
+  const REAL8 rd_sinLat = rd * sin ( latitude );
+  const REAL8 rd_cosLat = rd * cos ( latitude );
+
+  // ---------- Earth rotation, including lunisolar precession and nutation, as coefficients of n[]
+  const REAL8 sinZA = sin ( earth->tzeA ), cosZA = cos ( earth->tzeA );
+  const REAL8 cosThetaA = cos ( earth->thetaA ), sinThetaA = sin ( earth->thetaA );
+  const REAL8 cosGastZA = cos ( earth->gastRad + longitude - earth->zA );
+  const REAL8 sinGastZA = sin ( earth->gastRad + longitude - earth->zA );
+  const REAL8 cosGastLong = cos ( earth->gastRad + longitude );
+  const REAL8 sinGastLong = sin ( earth->gastRad + longitude );
+  for ( UINT4 j = 0; j < 3; j++ )
+    {
+      // evaluate the (linear) XLALBarycenterOpt() expressions for n = j-th basis vector
+      const REAL8 n[3] = { (j == 0), (j == 1), (j == 2) };
+
+      const REAL8 cosDeltaSinAlphaMinusZA = n[1] * cosZA + n[0] * sinZA;
+      const REAL8 cosDeltaCosAlphaZA = n[0] * cosZA - n[1] * sinZA;
+      const REAL8 cosDeltaCosAlphaMinusZA = cosDeltaCosAlphaZA * cosThetaA - sinThetaA * n[2];
+      const REAL8 sinDeltaCurt = cosDeltaCosAlphaZA * sinThetaA + cosThetaA * n[2];
+
+      REAL8 erot = rd_sinLat * sinDeltaCurt + rd_cosLat * ( cosGastZA * cosDeltaCosAlphaMinusZA + sinGastZA * cosDeltaSinAlphaMinusZA );
+      REAL8 derot = OMEGA * rd_cosLat * ( - sinGastZA * cosDeltaCosAlphaMinusZA + cosGastZA * cosDeltaSinAlphaMinusZA );
+
+      const REAL8 delXNut = - earth->delpsi * ( n[1] * cosEps0 + n[2] * sinEps0 );
+      const REAL8 delYNut = n[0] * cosEps0 * earth->delpsi - n[2] * earth->deleps;
+      const REAL8 delZNut = n[0] * sinEps0 * earth->delpsi + n[1] * earth->deleps;
+
+      erot += rd_sinLat * delZNut + rd_cosLat * cosGastLong * delXNut + rd_cosLat * sinGastLong * delYNut;
+      derot += OMEGA * ( - rd_cosLat * sinGastLong * delXNut + rd_cosLat * cosGastLong * delYNut );
+
+      // add Roemer delay and its derivative
+      entry->dt_n[j] = earth->posNow[j] + erot;
+      entry->tdot_n[j] = earth->velNow[j] + derot;
+    }
+
+  // ---------- sky-independent terms
+  REAL8 obsTerm = 0;
+  if ( earth->ttype != TIMECORRECTION_ORIGINAL )
+    {
+      REAL8 obsEarth[3];
+      observatoryEarth( obsEarth, (*site), tgps, earth->gmstRad, earth->delpsi, earth->deleps );
+      for ( UINT4 j = 0; j < 3; j++ )
+        obsTerm += obsEarth[j] * earth->velNow[j];
+      obsTerm /= (1.0-IFTE_LC)*(REAL8)IFTE_K;
+    }
+  entry->dt0 = earth->einstein + obsTerm;
+  entry->tdot0 = 1.0 + earth->deinstein;
+
+  // ---------- quantities needed for Shapiro delay
+  for ( UINT4 j = 0; j < 3; j++ )
+    {
+      entry->se[j] = earth->se[j];
+      entry->dse[j] = earth->dse[j];
+    }
+  entry->rse = earth->rse;
+  entry->drse = earth->drse;
+
+  return XLAL_SUCCESS;
+
+} /* XLALSetBarycenterCache() */
+
+/**
+ * Compute SSB time differences \\f$\\Delta T_i = T(t_i) - T_0\\f$ and derivatives \\f$\\dot{T}_i\\f$ for a
+ * sky position from a filled barycentering cache. Equivalent (to within floating-point rounding) to calling
+ * XLALBarycenterOpt() at each cached timestamp with <tt>dInv = 0</tt> and subtracting \\a refTime from the
+ * emission time.
+ */
+int
+XLALEvaluateBarycenterCache ( REAL8Vector *DeltaT,		/**< [out] SSB time differences \\f$T(t_i) - T_0\\f$ */
+                              REAL8Vector *Tdot,		/**< [out] derivatives \\f$dT/dt(t_i)\\f$ */
+                              const BarycenterCache *cache,	/**< [in] filled barycentering cache */
+                              REAL8 alpha,			/**< [in] source right ascension in ICRS J2000 coords (radians) */
+                              REAL8 delta,			/**< [in] source declination in ICRS J2000 coords (radians) */
+                              const LIGOTimeGPS *refTime	/**< [in] SSB reference time \\f$T_0\\f$ */
+                              )
+{
+  XLAL_CHECK ( cache != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( DeltaT != NULL && DeltaT->length == cache->length, XLAL_EINVAL );
+  XLAL_CHECK ( Tdot != NULL && Tdot->length == cache->length, XLAL_EINVAL );
+  XLAL_CHECK ( refTime != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( fabs(alpha) <= LAL_TWOPI, XLAL_EDOM, "alpha = %f outside of allowed range [-2pi,2pi]\\n", alpha );
+  XLAL_CHECK ( fabs(delta) <= LAL_PI_2,  XLAL_EDOM, "delta = %f outside of allowed range [-pi/2,pi/2]\\n", delta );
+
+  // same sky-vector as XLALBarycenterOpt()
+  const REAL8 sinDelta = cos ( LAL_PI/2.0 - delta );
+  const REAL8 cosDelta = sin ( LAL_PI/2.0 - delta );
+  const REAL8 n[3] = { cosDelta * cos ( alpha ), cosDelta * sin ( alpha ), sinDelta };
+
+  const REAL8 rsun = 2.322; /*radius of sun in sec */
+
+  for ( UINT4 i = 0; i < cache->length; i++ )
+    {
+      const BarycenterCacheEntry *entry = &cache->data[i];
+
+      const REAL8 seDotN  = entry->se[0]  * n[0] + entry->se[1]  * n[1] + entry->se[2]  * n[2];
+      const REAL8 dseDotN = entry->dse[0] * n[0] + entry->dse[1] * n[1] + entry->dse[2] * n[2];
+
+      REAL8 shapiro, dshapiro;
+      const REAL8 b = sqrt ( entry->rse * entry->rse - seDotN * seDotN );
+      if ( ( b < rsun ) && ( seDotN < 0 ) )	/* if gw travels thru interior of Sun*/
+        {
+          const REAL8 db = ( entry->rse * entry->drse - seDotN * dseDotN ) / b;
+          shapiro  = 9.852e-6 * log ( (LAL_AU_SI/LAL_C_SI) / ( seDotN + sqrt ( rsun*rsun + seDotN*seDotN ) ) ) + 19.704e-6 * ( 1.0 - b / rsun );
+          dshapiro = - 19.704e-6 * db / rsun;
+        }
+      else
+        {
+          shapiro  =  9.852e-6 * log( (LAL_AU_SI/LAL_C_SI) / ( entry->rse + seDotN ) );
+          dshapiro = -9.852e-6 * ( entry->drse + dseDotN ) / ( entry->rse + seDotN );
+        }
+
+      const REAL8 deltaT = entry->dt0 + entry->dt_n[0] * n[0] + entry->dt_n[1] * n[1] + entry->dt_n[2] * n[2] - shapiro;
+      Tdot->data[i] = entry->tdot0 + entry->tdot_n[0] * n[0] + entry->tdot_n[1] * n[1] + entry->tdot_n[2] * n[2] - dshapiro;
+
+      // round emission time to nanoseconds exactly as XLALBarycenterOpt()
+      LIGOTimeGPS te;
+      const REAL8 tgpsNS = entry->tgps.gpsNanoSeconds;
+      const INT4 deltaTint = floor ( deltaT );
+      if ( ( 1e-9 * tgpsNS + deltaT - deltaTint ) >= 1.e0 )
+        {
+          te.gpsSeconds     = entry->tgps.gpsSeconds + deltaTint + 1;
+          te.gpsNanoSeconds = floor ( 1e9 * ( tgpsNS * 1e-9 + deltaT - deltaTint - 1.0 ) );
+        }
+      else
+        {
+          te.gpsSeconds     = entry->tgps.gpsSeconds + deltaTint;
+          te.gpsNanoSeconds = floor ( 1e9 * ( tgpsNS * 1e-9 + deltaT - deltaTint ) );
+        }
+      DeltaT->data[i] = XLALGPSDiff ( &te, refTime );
+    }
+
+  return XLAL_SUCCESS;
+
+} /* XLALEvaluateBarycenterCache() */
+
 /**
  * Function to calculate the precession matrix give Earth nutation values
  * depsilon and dpsi for a given MJD time.
@@ -1542,9 +1768,9 @@ void observatoryEarth( REAL8 obsEarth[3],     /**< [out] The x, y, z coordinates
                        REAL8 dpsi,            /**< [in] dpsi for Earth nutation */
                        REAL8 deps             /**< [in] deps for Earth nutation */
                       ){
-  static REAL8 erad; /* observatory distance from Earth centre */
-  static REAL8 hlt;  /* observatory latitude */
-  static REAL8 alng; /* observatory longitude */
+  REAL8 erad; /* observatory distance from Earth centre */
+  REAL8 hlt;  /* observatory latitude */
+  REAL8 alng; /* observatory longitude */
   REAL8 tmjd = 44244. + ( XLALGPSGetREAL8( tgps ) + 51.184 )/86400.;
 
   INT4 j = 0;
@@ -1558,7 +1784,7 @@ void observatoryEarth( REAL8 obsEarth[3],     /**< [out] The x, y, z coordinates
 
   alng = atan2(-det.location[1], det.location[0]);
 
-  static REAL8 siteCoord[3];
+  REAL8 siteCoord[3];
   REAL8 eeq[3], prn[3][3];
 
   siteCoord[0] = erad * cos(hlt);
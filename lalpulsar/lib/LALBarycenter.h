@@ -265,11 +265,19 @@ EmissionTime;
 /// internal (opaque) buffer type for optimized Barycentering function
 typedef struct tagBarycenterBuffer BarycenterBuffer;
 
+/// internal (opaque) cache of sky-independent barycentering quantities at a series of timestamps
+typedef struct tagBarycenterCache BarycenterCache;
+
 /* Function prototypes. */
 int XLALBarycenterEarth ( EarthState *earth, const LIGOTimeGPS *tGPS, const EphemerisData *edat);
 int XLALBarycenter ( EmissionTime *emit, const BarycenterInput *baryinput, const EarthState *earth);
 int XLALBarycenterOpt ( EmissionTime *emit, const BarycenterInput *baryinput, const EarthState *earth, BarycenterBuffer **buffer);
 
+BarycenterCache *XLALCreateBarycenterCache ( UINT4 length );
+void XLALDestroyBarycenterCache ( BarycenterCache *cache );
+int XLALSetBarycenterCache ( BarycenterCache *cache, UINT4 i, const LIGOTimeGPS *tgps, const LALDetector *site, const EarthState *earth );
+int XLALEvaluateBarycenterCache ( REAL8Vector *DeltaT, REAL8Vector *Tdot, const BarycenterCache *cache, REAL8 alpha, REAL8 delta, const LIGOTimeGPS *refTime );
+
 /* Function that uses time delay look-up tables to calculate time delays */
 int XLALBarycenterEarthNew ( EarthState *earth,
                              const LIGOTimeGPS *tGPS,
@@ -433,6 +433,190 @@ XLALComputeMultiAMCoeffs ( const MultiDetectorStateSeries *multiDetStates, 	/**<
 
 } /* XLALComputeMultiAMCoeffs() */
 
+/**
+ * Batch version of XLALComputeAMCoeffs(): compute the antenna-pattern functions a(t), b(t)
+ * for \p numSkypos sky positions at once, using the same algorithm (results agree to REAL4 precision).
+ *
+ * The sky vectors are computed for all sky positions up-front; the loop over timestamps then
+ * loads each detector tensor only once, and evaluates a(t), b(t) for a block of sky positions
+ * in an inner loop over contiguous arrays, which the compiler may vectorise.
+ *
+ * The output array \p coeffs must have length \p numSkypos, and its elements are allocated here.
+ */
+int
+XLALComputeAMCoeffsBatch ( AMCoeffs **coeffs,					/**< [out] antenna-pattern functions for each sky position */
+                           const DetectorStateSeries *DetectorStates,		/**< [in] timeseries of detector states */
+                           const SkyPosition *skypos,				/**< [in] {alpha,delta} of the sources */
+                           const UINT4 numSkypos				/**< [in] number of sky positions */
+                           )
+{
+  XLAL_CHECK ( coeffs != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( DetectorStates != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( skypos != NULL || numSkypos == 0, XLAL_EINVAL );
+  for ( UINT4 k = 0; k < numSkypos; k ++ ) {
+    XLAL_CHECK ( coeffs[k] == NULL, XLAL_EINVAL, "Output coeffs[%u] must be NULL", k );
+    /* currently requires sky-pos to be in equatorial coordinates (FIXME) */
+    XLAL_CHECK ( skypos[k].system == COORDINATESYSTEM_EQUATORIAL, XLAL_EINVAL, "only equatorial coordinates currently supported in 'skypos[%u]'", k );
+  }
+  if ( numSkypos == 0 ) {
+    return XLAL_SUCCESS;
+  }
+
+  /* number of sky positions whose a(t), b(t) are computed together in the inner loop */
+  enum { BLOCK = 16 };
+
+  /* ---------- compute xi and eta vectors for each sky position, as in XLALComputeAMCoeffs() */
+  REAL8 *x = XLALMalloc ( 2 * numSkypos * sizeof(*x) );
+  REAL4 *sinx = XLALMalloc ( 2 * numSkypos * sizeof(*sinx) );
+  REAL4 *cosx = XLALMalloc ( 2 * numSkypos * sizeof(*cosx) );
+  REAL4 *xieta = XLALMalloc ( 5 * numSkypos * sizeof(*xieta) );
+  XLAL_CHECK ( x != NULL && sinx != NULL && cosx != NULL && xieta != NULL, XLAL_ENOMEM );
+  for ( UINT4 k = 0; k < numSkypos; k ++ ) {
+    REAL4 alpha = skypos[k].longitude;
+    REAL4 delta = skypos[k].latitude;
+    x[k] = delta * ( 1.0 / LAL_TWOPI );
+    x[numSkypos + k] = alpha * ( 1.0 / LAL_TWOPI );
+  }
+  XLAL_CHECK ( XLALSinCos2PiLUTVector ( sinx, cosx, x, 2 * numSkypos ) == XLAL_SUCCESS, XLAL_EFUNC );
+  REAL4 *xi1 = xieta, *xi2 = xi1 + numSkypos, *eta1 = xi2 + numSkypos, *eta2 = eta1 + numSkypos, *eta3 = eta2 + numSkypos;
+  for ( UINT4 k = 0; k < numSkypos; k ++ ) {
+    const REAL4 sin1delta = sinx[k], cos1delta = cosx[k];
+    const REAL4 sin1alpha = sinx[numSkypos + k], cos1alpha = cosx[numSkypos + k];
+    xi1[k] = - sin1alpha;
+    xi2[k] =  cos1alpha;
+    eta1[k] = sin1delta * cos1alpha;
+    eta2[k] = sin1delta * sin1alpha;
+    eta3[k] = - cos1delta;
+  }
+  XLALFree ( x );
+  XLALFree ( sinx );
+  XLALFree ( cosx );
+
+  /* prepare output vectors */
+  const UINT4 numSteps = DetectorStates->length;
+  for ( UINT4 k = 0; k < numSkypos; k ++ ) {
+    if ( ( coeffs[k] = XLALCreateAMCoeffs ( numSteps ) ) == NULL ) {
+      XLALFree ( xieta );
+      XLAL_ERROR ( XLAL_EFUNC, "XLALCreateAMCoeffs(%d) failed", numSteps );
+    }
+  }
+
+  /*---------- Compute the a(t_i) and b(t_i) ---------- */
+  for ( UINT4 k0 = 0; k0 < numSkypos; k0 += BLOCK )
+    {
+      const UINT4 nk = ( numSkypos - k0 < BLOCK ) ? ( numSkypos - k0 ) : BLOCK;
+      const REAL4 *bxi1 = xi1 + k0, *bxi2 = xi2 + k0, *beta1 = eta1 + k0, *beta2 = eta2 + k0, *beta3 = eta3 + k0;
+      for ( UINT4 i = 0; i < numSteps; i++ )
+        {
+          const SymmTensor3 d = DetectorStates->data[i].detT;
+          REAL4 ai[BLOCK], bi[BLOCK];
+
+          for ( UINT4 k = 0; k < nk; k ++ )
+            {
+              ai[k] =    d.d11 * ( bxi1[k] * bxi1[k] - beta1[k] * beta1[k] )
+                + 2 * d.d12 * ( bxi1[k]*bxi2[k] - beta1[k]*beta2[k] )
+                - 2 * d.d13 *             beta1[k] * beta3[k]
+                +     d.d22 * ( bxi2[k]*bxi2[k] - beta2[k]*beta2[k] )
+                - 2 * d.d23 *             beta2[k] * beta3[k]
+                -     d.d33 *             beta3[k]*beta3[k];
+
+              bi[k] =    d.d11 * 2 * bxi1[k] * beta1[k]
+                + 2 * d.d12 *   ( bxi1[k] * beta2[k] + bxi2[k] * beta1[k] )
+                + 2 * d.d13 *     bxi1[k] * beta3[k]
+                +     d.d22 * 2 * bxi2[k] * beta2[k]
+                + 2 * d.d23 *     bxi2[k] * beta3[k];
+            }
+
+          for ( UINT4 k = 0; k < nk; k ++ )
+            {
+              coeffs[k0 + k]->a->data[i] = ai[k];
+              coeffs[k0 + k]->b->data[i] = bi[k];
+            }
+
+        } /* for i < numSteps */
+    } /* for k0 < numSkypos */
+
+  XLALFree ( xieta );
+
+  return XLAL_SUCCESS;
+
+} /* XLALComputeAMCoeffsBatch() */
+
+/**
+ * Batch version of XLALComputeMultiAMCoeffs(): compute the noise-weighted multi-IFO antenna-pattern
+ * functions and matrices for \p numSkypos sky positions at once, using XLALComputeAMCoeffsBatch().
+ *
+ * The output array \p multiAMcoef must have length \p numSkypos, and its elements are allocated here.
+ *
+ * \note *) an input of multiWeights = NULL corresponds to unit-weights
+ */
+int
+XLALComputeMultiAMCoeffsBatch ( MultiAMCoeffs **multiAMcoef,			/**< [out] antenna-pattern coefficients for each sky position */
+                                const MultiDetectorStateSeries *multiDetStates,	/**< [in] detector-states at timestamps t_i */
+                                const MultiNoiseWeights *multiWeights,		/**< [in] noise-weigths at timestamps t_i (can be NULL) */
+                                const SkyPosition *skypos,			/**< [in] source sky-positions [in equatorial coords!] */
+                                const UINT4 numSkypos				/**< [in] number of sky positions */
+                                )
+{
+  XLAL_CHECK ( multiAMcoef != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( multiDetStates != NULL, XLAL_EINVAL );
+  for ( UINT4 k = 0; k < numSkypos; k ++ ) {
+    XLAL_CHECK ( multiAMcoef[k] == NULL, XLAL_EINVAL, "Output multiAMcoef[%u] must be NULL", k );
+  }
+
+  const UINT4 numDetectors = multiDetStates->length;
+  AMCoeffs **coeffs = NULL;
+
+  /* prepare output vectors */
+  for ( UINT4 k = 0; k < numSkypos; k ++ ) {
+    if ( ( multiAMcoef[k] = XLALCalloc ( 1, sizeof( *multiAMcoef[k] ) ) ) == NULL ||
+         ( multiAMcoef[k]->data = XLALCalloc ( numDetectors, sizeof ( *multiAMcoef[k]->data ) ) ) == NULL ) {
+      goto XLAL_FAIL;
+    }
+    multiAMcoef[k]->length = numDetectors;
+  }
+
+  /* loop over detectors and generate AMCoeffs for each one, for all sky positions */
+  if ( ( coeffs = XLALCalloc ( numSkypos > 0 ? numSkypos : 1, sizeof ( *coeffs ) ) ) == NULL ) {
+    goto XLAL_FAIL;
+  }
+  for ( UINT4 X = 0; X < numDetectors; X ++ )
+    {
+      if ( XLALComputeAMCoeffsBatch ( coeffs, multiDetStates->data[X], skypos, numSkypos ) != XLAL_SUCCESS ) {
+        goto XLAL_FAIL;
+      }
+      for ( UINT4 k = 0; k < numSkypos; k ++ ) {
+        multiAMcoef[k]->data[X] = coeffs[k];
+        coeffs[k] = NULL;
+      }
+    } /* for X < numDetectors */
+  XLALFree ( coeffs );
+  coeffs = NULL;
+
+  /* apply noise-weights and compute antenna-pattern matrix {A,B,C} */
+  for ( UINT4 k = 0; k < numSkypos; k ++ ) {
+    if ( XLALWeightMultiAMCoeffs ( multiAMcoef[k], multiWeights ) != XLAL_SUCCESS ) {
+      goto XLAL_FAIL;
+    }
+  }
+
+  return XLAL_SUCCESS;
+
+XLAL_FAIL:
+  for ( UINT4 k = 0; k < numSkypos; k ++ ) {
+    if ( coeffs != NULL ) {
+      XLALDestroyAMCoeffs ( coeffs[k] );
+    }
+    XLALDestroyMultiAMCoeffs ( multiAMcoef[k] );
+    multiAMcoef[k] = NULL;
+  }
+  if ( coeffs != NULL ) {
+    XLALFree ( coeffs );
+  }
+  XLAL_ERROR ( XLAL_EFUNC );
+
+} /* XLALComputeMultiAMCoeffsBatch() */
+
 
 /* ---------- creators/destructors for AM-coeffs -------------------- */
 /**
@@ -246,6 +246,22 @@ void LALHOUGHConstructHMT_W  (LALStatus                  *status,
 			      PHMDVectorSequence         *phmdVS
 			      );
 
+void LALHOUGHConstructMultiHMT  (LALStatus                  *status,
+				 HOUGHMapTotal              *ht,
+				 UINT8FrequencyIndexVector  *freqInd,
+				 UINT4                      numMaps,
+				 PHMDVectorSequence         *phmdVS,
+				 BOOLEAN                    weighted,
+				 UINT4                      numThreads
+				 );
+
+void LALHOUGHConstructMultiPLUT (LALStatus             *status,
+				 HOUGHptfLUTVector     *lutV,
+				 HOUGHPatchGrid        *patch,
+				 HOUGHParamPLUT        *parV,
+				 UINT4                 numThreads
+				 );
+
 void LALHOUGHWeighSpacePHMD  (LALStatus            *status,
 			      PHMDVectorSequence   *phmdVS,
 			      REAL8Vector *weightV
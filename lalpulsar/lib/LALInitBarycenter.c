@@ -32,6 +32,13 @@
 #define NORM3D(x) ( SQ( (x)[0]) + SQ( (x)[1] ) + SQ ( (x)[2] ) )
 #define LENGTH3D(x) ( sqrt( NORM3D ( (x) ) ) )
 
+/* identifies binary ephemeris files, and the version of their format */
+#define EPHEM_BINARY_MAGIC "LALEPH01"
+/* written in native byte order, to detect files written on machines of differing endianness */
+#define EPHEM_BINARY_BYTE_ORDER 0x01020304
+/* suffix of the binary sidecar of a text ephemeris file */
+#define EPHEM_BINARY_SUFFIX ".bin"
+
 /** \endcond */
 
 /* ----- local type definitions ---------- */
@@ -49,11 +56,25 @@ typedef struct
 }
 EphemerisVector;
 
+/**
+ * Header of a binary ephemeris file, which is followed by \c length PosVelAcc entries
+ * in native byte order. The entries are 8-byte aligned, so the file can be memory-mapped.
+ */
+typedef struct
+{
+  CHAR magic[8];        /**< EPHEM_BINARY_MAGIC, not NUL-terminated */
+  UINT4 byteOrder;      /**< EPHEM_BINARY_BYTE_ORDER */
+  UINT4 length;         /**< number of ephemeris-data entries */
+  REAL8 dt;             /**< spacing in seconds between consecutive instants in ephemeris table */
+}
+EphemerisBinaryHeader;
+
 /* ----- internal prototypes ---------- */
 EphemerisVector *XLALCreateEphemerisVector ( UINT4 length );
 void XLALDestroyEphemerisVector ( EphemerisVector *ephemV );
 
 EphemerisVector * XLALReadEphemerisFile ( const CHAR *fname);
+EphemerisVector * XLALReadBinaryEphemerisFile ( const CHAR *fname );
 int XLALCheckEphemerisRanges ( const EphemerisVector *ephemEarth, REAL8 avg[3], REAL8 range[3] );
 
 /* ----- function definitions ---------- */
@@ -400,6 +421,56 @@ int XLALRestrictEphemerisData ( EphemerisData *edat, const LIGOTimeGPS *startGPS
 } /* XLALRestrictEphemerisData() */
 
 
+/**
+ * Convert a text ephemeris file (as read by XLALInitBarycenter()) into the binary ephemeris format.
+ *
+ * The binary format stores the ephemeris table exactly as it is held in memory, and so can be loaded
+ * without decompressing or parsing any text. XLALInitBarycenter() accepts binary ephemeris files
+ * directly, and also uses a binary file "<fname>.bin" in place of a text file "<fname>[.gz]" whenever
+ * it is found on the search path; e.g. 'earth00-40-DE430.dat.bin' is used in place of
+ * 'earth00-40-DE430.dat.gz'. The binary format is only portable between machines of the same
+ * endianness; foreign binary sidecars are ignored by XLALInitBarycenter().
+ *
+ * \ingroup LALBarycenter_h
+ */
+int
+XLALWriteBinaryEphemerisFile ( const CHAR *binFile,	/**< [in] binary ephemeris file to write */
+                               const CHAR *fname	/**< [in] text ephemeris file to convert */
+                               )
+{
+  XLAL_CHECK ( binFile != NULL && fname != NULL, XLAL_EINVAL );
+
+  EphemerisVector *ephemV;
+  XLAL_CHECK ( ( ephemV = XLALReadEphemerisFile ( fname ) ) != NULL, XLAL_EFUNC );
+
+  EphemerisBinaryHeader header;
+  memset ( &header, 0, sizeof(header) );
+  memcpy ( header.magic, EPHEM_BINARY_MAGIC, sizeof(header.magic) );
+  header.byteOrder = EPHEM_BINARY_BYTE_ORDER;
+  header.length = ephemV->length;
+  header.dt = ephemV->dt;
+
+  LALFILE *fp;
+  if ( ( fp = XLALFileOpenWrite ( binFile, 0 ) ) == NULL )
+    {
+      XLALDestroyEphemerisVector ( ephemV );
+      XLAL_ERROR ( XLAL_EIO, "Failed to open '%s' for writing\n", binFile );
+    }
+  if ( XLALFileWrite ( &header, sizeof(header), 1, fp ) != 1 ||
+       XLALFileWrite ( ephemV->data, sizeof(*ephemV->data), ephemV->length, fp ) != ephemV->length )
+    {
+      XLALFileClose ( fp );
+      XLALDestroyEphemerisVector ( ephemV );
+      XLAL_ERROR ( XLAL_EIO, "Failed to write binary ephemeris file '%s'\n", binFile );
+    }
+  XLALDestroyEphemerisVector ( ephemV );
+  XLAL_CHECK ( XLALFileClose ( fp ) == XLAL_SUCCESS, XLAL_EIO, "Failed to close '%s'\n", binFile );
+
+  return XLAL_SUCCESS;
+
+} /* XLALWriteBinaryEphemerisFile() */
+
+
 /* ========== internal function definitions ========== */
 
 /** simple creator function for EphemerisVector type */
@@ -469,6 +540,33 @@ XLALReadEphemerisFile ( const CHAR *fname )
 
   char *fname_path = NULL;
 
+  // prefer a binary sidecar "<fname>.bin" (with any ".gz" extension of "<fname>" removed), if one exists
+  {
+    size_t len = strlen ( fname );
+    if ( len > 3 && strcmp ( fname + len - 3, ".gz" ) == 0 )
+      len -= 3;
+    char *fname_bin;
+    XLAL_CHECK_NULL ( (fname_bin = XLALMalloc ( len + strlen(EPHEM_BINARY_SUFFIX) + 1 )) != NULL, XLAL_ENOMEM );
+    memcpy ( fname_bin, fname, len );
+    strcpy ( fname_bin + len, EPHEM_BINARY_SUFFIX );
+    int errnum;
+    XLAL_TRY_SILENT ( fname_path = XLALPulsarFileResolvePath ( fname_bin ), errnum );
+    XLALFree ( fname_bin );
+    if ( errnum == 0 && fname_path != NULL )
+      {
+        EphemerisVector *ephemV;
+        XLAL_TRY ( ephemV = XLALReadBinaryEphemerisFile ( fname_path ), errnum );
+        if ( ephemV != NULL )
+          {
+            XLALFree ( fname_path );
+            return ephemV;
+          }
+        XLAL_PRINT_WARNING ( "Ignoring unreadable binary ephemeris file '%s', reading '%s' instead", fname_path, fname );
+      }
+    XLALFree ( fname_path );
+    fname_path = NULL;
+  }
+
   // first check if "<fname>" can be resolved ...
   if ( (fname_path = XLALPulsarFileResolvePath ( fname )) == NULL )
     {
@@ -486,6 +584,25 @@ XLALReadEphemerisFile ( const CHAR *fname )
 
   // if we're here, it means we found it
 
+  // a binary ephemeris file may also be given directly
+  {
+    CHAR magic[sizeof(EPHEM_BINARY_MAGIC) - 1];
+    int isBinary = 0;
+    FILE *fp = LALFopen ( fname_path, "rb" );
+    if ( fp != NULL )
+      {
+        isBinary = ( fread ( magic, sizeof(magic), 1, fp ) == 1 && memcmp ( magic, EPHEM_BINARY_MAGIC, sizeof(magic) ) == 0 );
+        fclose ( fp );
+      }
+    if ( isBinary )
+      {
+        EphemerisVector *ephemV = XLALReadBinaryEphemerisFile ( fname_path );
+        XLALFree ( fname_path );
+        XLAL_CHECK_NULL ( ephemV != NULL, XLAL_EFUNC );
+        return ephemV;
+      }
+  }
+
   // read in whole file (compressed or not) with XLALParseDataFile(), which ignores comment header lines
   LALParsedDataFile *flines = NULL;
   XLAL_CHECK_NULL ( XLALParseDataFile ( &flines, fname_path ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -603,6 +720,64 @@ XLALReadEphemerisFile ( const CHAR *fname )
 } /* XLALReadEphemerisFile() */
 
 
+/**
+ * XLAL function to read ephemeris-data from a binary ephemeris file written by
+ * XLALWriteBinaryEphemerisFile(), returning a EphemerisVector.
+ * This is a helper-function to XLALReadEphemerisFile(); 'fname' must be a resolved path.
+ */
+EphemerisVector *
+XLALReadBinaryEphemerisFile ( const CHAR *fname )
+{
+  /* check input consistency */
+  XLAL_CHECK_NULL ( fname != NULL, XLAL_EINVAL );
+
+  size_t fileLen;
+  XLAL_CHECK_NULL ( XLALFileIsRegularAndGetSize ( fname, &fileLen ) == 1, XLAL_EINVAL, "Path '%s' does not point to a regular file!\n", fname );
+
+  LALFILE *fp;
+  XLAL_CHECK_NULL ( ( fp = XLALFileOpenRead ( fname ) ) != NULL, XLAL_EFUNC );
+
+  EphemerisBinaryHeader header;
+  if ( XLALFileRead ( &header, sizeof(header), 1, fp ) != 1 || memcmp ( header.magic, EPHEM_BINARY_MAGIC, sizeof(header.magic) ) != 0 )
+    {
+      XLALFileClose ( fp );
+      XLAL_ERROR_NULL ( XLAL_EIO, "'%s' is not a binary ephemeris file\n", fname );
+    }
+  if ( header.byteOrder != EPHEM_BINARY_BYTE_ORDER )
+    {
+      XLALFileClose ( fp );
+      XLAL_ERROR_NULL ( XLAL_EIO, "Binary ephemeris file '%s' was written on a machine of different endianness\n", fname );
+    }
+  if ( fileLen != sizeof(header) + header.length * sizeof(PosVelAcc) )
+    {
+      XLALFileClose ( fp );
+      XLAL_ERROR_NULL ( XLAL_EIO, "Binary ephemeris file '%s' has size %zu instead of %zu\n", fname, fileLen, sizeof(header) + header.length * sizeof(PosVelAcc) );
+    }
+
+  /* prepare output ephemeris vector */
+  EphemerisVector *ephemV;
+  if ( (ephemV = XLALCreateEphemerisVector ( header.length )) == NULL )
+    {
+      XLALFileClose ( fp );
+      XLAL_ERROR_NULL ( XLAL_EFUNC, "Failed to XLALCreateEphemerisVector(%d)\n", header.length );
+    }
+  ephemV->dt = header.dt;
+
+  /* the table is stored as it is held in memory, so read it in one go */
+  if ( XLALFileRead ( ephemV->data, sizeof(*ephemV->data), ephemV->length, fp ) != ephemV->length )
+    {
+      XLALDestroyEphemerisVector ( ephemV );
+      XLALFileClose ( fp );
+      XLAL_ERROR_NULL ( XLAL_EIO, "Failed to read ephemeris table from '%s'\n", fname );
+    }
+  XLALFileClose ( fp );
+
+  /* return result */
+  return ephemV;
+
+} /* XLALReadBinaryEphemerisFile() */
+
+
 /**
  * Function to check rough consistency of ephemeris-data with being an actual
  * 'Earth' ephemeris: ie check position, velocity and acceleration are within
@@ -22,6 +22,7 @@
 
 /* System includes */
 #include <stdio.h>
+#include <fftw3.h>
 
 /* LAL-includes */
 #include <lal/LFTandTSutils.h>
@@ -45,10 +46,42 @@
 #define OOTWOPI         (1.0 / LAL_TWOPI)      // 1/2pi
 #define OOPI         (1.0 / LAL_PI)      // 1/pi
 #define LD_SMALL4       (2.0e-4)                // "small" number for REAL4: taken from Demod()
+#define SFTTOTS_BATCH_LENGTH 64                 // default number of SFTs transformed at once by SFTtoTSEngine
+
+/*---------- internal types ----------*/
+
+/** Placement of one SFT within the long time-series */
+typedef struct tagSFTtoTSSlot
+{
+  LIGOTimeGPS epoch;		///< (un-nudged) epoch of the SFT
+  UINT4 bin0;			///< first sample of the SFT within the long time-series
+  UINT4 copyLen;		///< number of samples of the SFT within the long time-series
+  REAL8 nudge;			///< time-shift nudging the SFT into an integer sample
+  COMPLEX8 hetCorrection;	///< heterodyning phase-correction and 'df' normalization
+} SFTtoTSSlot;
+
+/** Engine for turning SFTs into one long time-series, see XLALSFTtoTSEngineUpdate() */
+struct tagSFTtoTSEngine
+{
+  UINT4 batchLength;		///< number of SFTs transformed at once
+  UINT4 numFreqBinsSFT;		///< number of SFT frequency bins the plan and buffers are set up for
+  REAL8 f0SFT;			///< start frequency of the SFTs the plan and buffers are set up for
+  REAL8 dfSFT;			///< frequency spacing of the SFTs the plan and buffers are set up for
+  UINT4 stride;			///< padded length of each SFT within the batch buffers, keeping each aligned
+  COMPLEX8FFTPlan *SFTplan;	///< cached plan for the inverse FFT of one SFT
+  COMPLEX8 *batchIn;		///< aligned batch buffer of SFTs in FFTW order
+  COMPLEX8 *batchOut;		///< aligned batch buffer of inverse FFTs of SFTs
+  COMPLEX8TimeSeries *lTS;	///< long time-series from the last update
+  UINT4 numSlots;		///< number of SFTs making up lTS
+  SFTtoTSSlot *slots;		///< placement of the SFTs making up lTS
+  BOOLEAN overlapping;		///< whether the SFTs making up lTS overlap in time
+};
 /*---------- Global variables ----------*/
 static LALUnit emptyLALUnit;
 
 /* ---------- local prototypes ---------- */
+static int SFTtoTSComputeSlot ( SFTtoTSSlot *slot, const SFTtype *sft, const LIGOTimeGPS *start, const REAL8 deltaT, const REAL8 Tsft, const REAL8 fHet, const UINT4 numSamples );
+static int SFTtoTSTransformSFT ( COMPLEX8 *out, COMPLEX8 *in, const SFTtype *sft, const SFTtoTSSlot *slot, const COMPLEX8FFTPlan *plan );
 
 /*---------- empty initializers ---------- */
 
@@ -138,30 +171,174 @@ XLALSFTVectorToLFT ( SFTVector *sfts,		/**< input SFT vector (gets modified!) */
 
 
 /**
- * Turn the given SFTvector into one long time-series, properly dealing with gaps.
+ * Create an engine for turning SFT vectors into one long time-series, see XLALSFTtoTSEngineUpdate().
+ * The inverse FFTs of the SFTs are computed in batches of \a batchLength SFTs, spread over OpenMP threads
+ * if available; a \a batchLength of zero selects a default.
  */
-COMPLEX8TimeSeries *
-XLALSFTVectorToCOMPLEX8TimeSeries ( const SFTVector *sftsIn         /**< [in] SFT vector */
-                                    )
+SFTtoTSEngine *
+XLALCreateSFTtoTSEngine ( const UINT4 batchLength	/**< [in] number of SFTs to transform at once, or zero for a default */
+                          )
 {
-  // check input sanity
-  XLAL_CHECK_NULL ( (sftsIn !=NULL) && (sftsIn->length > 0), XLAL_EINVAL );
+  SFTtoTSEngine *engine;
+  XLAL_CHECK_NULL ( (engine = XLALCalloc ( 1, sizeof(*engine) )) != NULL, XLAL_ENOMEM );
+  engine->batchLength = ( batchLength > 0 ) ? batchLength : SFTTOTS_BATCH_LENGTH;
+  return engine;
+} // XLALCreateSFTtoTSEngine()
+
+/**
+ * Free all memory associated with an engine created by XLALCreateSFTtoTSEngine(),
+ * including the time-series returned by its last update.
+ */
+void
+XLALDestroySFTtoTSEngine ( SFTtoTSEngine *engine )
+{
+  if ( engine == NULL ) {
+    return;
+  }
+  XLALDestroyCOMPLEX8FFTPlan ( engine->SFTplan );
+  fftw_free ( engine->batchIn );
+  fftw_free ( engine->batchOut );
+  XLALDestroyCOMPLEX8TimeSeries ( engine->lTS );
+  if ( engine->slots != NULL ) {
+    XLALFree ( engine->slots );
+  }
+  XLALFree ( engine );
+} // XLALDestroySFTtoTSEngine()
+
+/**
+ * Work out where the given SFT goes within the long time-series starting at 'start',
+ * and its nudge into an integer time-step and heterodyning phase-correction
+ */
+static int
+SFTtoTSComputeSlot ( SFTtoTSSlot *slot, const SFTtype *sft, const LIGOTimeGPS *start, const REAL8 deltaT, const REAL8 Tsft, const REAL8 fHet, const UINT4 numSamples )
+{
+  slot->epoch = sft->epoch;
+
+  /* find bin in long timeseries corresponding to starttime of *this* SFT */
+  REAL8 offset_n = XLALGPSDiff ( &(sft->epoch), start );
+  UINT4 bin0_n = lround ( offset_n / deltaT );	/* round to closest bin */
+
+  REAL8 nudge_n = bin0_n * deltaT - offset_n;		/* rounding error */
+  nudge_n = 1e-9 * round ( nudge_n * 1e9 );	/* round to closest nanosecond */
+
+  /* determine heterodyning phase-correction for this SFT */
+  LIGOTimeGPS epoch = sft->epoch;
+  XLALGPSAdd ( &epoch, nudge_n );
+  REAL8 offset = XLALGPSDiff ( &epoch, start );	// updated value after time-shift
+  // fHet * Tsft is an integer by construction, because fHet was chosen as a frequency-bin of the input SFTs
+  // therefore we only need the remainder (offset % Tsft)
+  REAL8 offsetEff = fmod ( offset, Tsft );
+  REAL8 hetCycles = fmod ( fHet * offsetEff, 1); // heterodyning phase-correction for this SFT
+
+  if ( nudge_n != 0 ){
+    XLALPrintInfo("offset_n = %g, nudge_n = %g, offset = %g, offsetEff = %g, hetCycles = %g\n",
+                  offset_n, nudge_n, offset, offsetEff, hetCycles );
+  }
+
+  REAL4 hetCorrection_re, hetCorrection_im;
+  XLAL_CHECK ( XLALSinCos2PiLUT ( &hetCorrection_im, &hetCorrection_re, -hetCycles ) == XLAL_SUCCESS, XLAL_EFUNC );
+  COMPLEX8 hetCorrection = crectf( hetCorrection_re, hetCorrection_im );
+
+  /* Note: we also bundle the overall normalization of 'df' into the het-correction.
+   * This ensures that the resulting timeseries will have the correct normalization, according to
+   * x_l = invFT[sft]_l = df * sum_{k=0}^{N-1} xt_k * e^(i 2pi k l / N )
+   * where x_l is the l-th timestamp, and xt_k is the k-th frequency bin of the SFT.
+   * See the LAL-conventions on FFTs:  http://www.ligo.caltech.edu/docs/T/T010095-00.pdf
+   * (the FFTw convention does not contain the factor of 'df', which is why we need to
+   * apply it ourselves)
+   *
+   */
+  hetCorrection *= sft->deltaF;
+
+  slot->bin0 = bin0_n;
+  slot->copyLen = MYMIN ( sft->data->length, numSamples - bin0_n );	/* make sure not to write past the end of the long TS */
+  slot->nudge = nudge_n;
+  slot->hetCorrection = hetCorrection;
+
+  return XLAL_SUCCESS;
+
+} // SFTtoTSComputeSlot()
+
+/**
+ * Inverse-FFT one SFT into a short heterodyned time-series 'out', using 'in' as workspace:
+ * equivalent to XLALTimeShiftSFT() by the nudge, XLALReorderSFTtoFFTW() and XLALCOMPLEX8VectorFFT(),
+ * but without modifying or copying the SFT itself
+ */
+static int
+SFTtoTSTransformSFT ( COMPLEX8 *out, COMPLEX8 *in, const SFTtype *sft, const SFTtoTSSlot *slot, const COMPLEX8FFTPlan *plan )
+{
+  const UINT4 N = sft->data->length;
+  const UINT4 Npos_and_DC = NhalfPosDC ( N );
+  const UINT4 Nneg = NhalfNeg ( N );
+
+  /* nudge SFT into integer timestep bin if necessary, while reordering into FFTW convention */
+  for ( UINT4 k = 0; k < N; k++ )
+    {
+      COMPLEX8 bin = sft->data->data[k];
+      if ( slot->nudge != 0 )
+        {
+          REAL8 fk = sft->f0 + k * sft->deltaF;	/* frequency of k-th bin */
+          REAL8 shiftCyles = slot->nudge * fk;
+          REAL4 fact_re, fact_im;			/* complex phase-shift factor e^(-2pi f tau) */
+          XLAL_CHECK ( XLALSinCos2PiLUT ( &fact_im, &fact_re, shiftCyles ) == XLAL_SUCCESS, XLAL_EFUNC );
+          COMPLEX8 fact = crectf(fact_re, fact_im);
+          bin *= fact;
+        }
+      in[ ( k < Nneg ) ? ( k + Npos_and_DC ) : ( k - Nneg ) ] = bin;
+    } /* for k < N */
+
+  COMPLEX8Vector inVect = { .length = N, .data = in };
+  COMPLEX8Vector outVect = { .length = N, .data = out };
+  XLAL_CHECK ( XLALCOMPLEX8VectorFFT( &outVect, &inVect, plan ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  for ( UINT4 j = 0; j < N; j++ ) {
+    out[j] *= slot->hetCorrection;
+  }
+
+  return XLAL_SUCCESS;
 
-  // create a local copy of the input SFTs, as they will be locally modified!
-  SFTVector *sfts;
-  XLAL_CHECK_NULL ( (sfts = XLALDuplicateSFTVector ( sftsIn )) != NULL, XLAL_EFUNC );
+} // SFTtoTSTransformSFT()
+
+/**
+ * Turn the given SFTvector into one long time-series, properly dealing with gaps, in the same way
+ * as XLALSFTVectorToCOMPLEX8TimeSeries(). The returned time-series is owned by the engine,
+ * and is valid until the next update or until the engine is destroyed.
+ *
+ * The inverse-FFT plan and aligned buffers of the engine are reused between updates. In addition,
+ * if the engine already holds a time-series from a previous update, only SFTs which were not part of that
+ * update (as identified by their epochs), or whose indices in \a sfts are listed in \a changedSFTs, are
+ * inverse-FFTed; the samples of all other SFTs are copied over from the previous time-series.
+ * This makes moving an analysis window over a list of SFTs cost only the SFTs entering the window.
+ *
+ * \note The previous time-series is only reused if the SFTs do not overlap in time, their frequency band
+ * is unchanged, and the start of the time-series moves by an integer number of samples; otherwise all SFTs
+ * are transformed. When the start moves, reused samples are multiplied by the change in heterodyning phase,
+ * so they agree with a full re-computation only to within single-precision rounding.
+ */
+const COMPLEX8TimeSeries *
+XLALSFTtoTSEngineUpdate ( SFTtoTSEngine *engine,		/**< [in/out] engine */
+                          const SFTVector *sfts,		/**< [in] SFT vector */
+                          const UINT4Vector *changedSFTs	/**< [in] indices of SFTs whose data changed since the last update (optional) */
+                          )
+{
+  // check input sanity
+  XLAL_CHECK_NULL ( engine != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL ( (sfts != NULL) && (sfts->length > 0), XLAL_EINVAL );
 
   /* define some useful shorthands */
   UINT4 numSFTs = sfts->length;
-  SFTtype *firstSFT = &(sfts->data[0]);
-  SFTtype *lastSFT = &(sfts->data[numSFTs-1]);
+  const SFTtype *firstSFT = &(sfts->data[0]);
+  const SFTtype *lastSFT = &(sfts->data[numSFTs-1]);
   UINT4 numFreqBinsSFT = firstSFT->data->length;
   REAL8 dfSFT = firstSFT->deltaF;
   REAL8 Tsft = 1.0 / dfSFT;
   REAL8 deltaT = Tsft / numFreqBinsSFT;	// complex FFT: numSamplesSFT = numFreqBinsSFT
   REAL8 f0SFT = firstSFT->f0;
+  for ( UINT4 n = 0; n < numSFTs; n ++ ) {
+    XLAL_CHECK_NULL ( sfts->data[n].data != NULL && sfts->data[n].data->length == numFreqBinsSFT, XLAL_EINVAL, "SFT %u has a different number of frequency bins", n );
+  }
 
-  /* if the start and end input pointers are NOT NULL then determine start and time-span of the final long time-series */
+  /* determine start and time-span of the final long time-series */
   LIGOTimeGPS start = firstSFT->epoch;
   LIGOTimeGPS end = lastSFT->epoch;
   XLALGPSAdd ( &end, Tsft );
@@ -177,79 +354,170 @@ XLALSFTVectorToCOMPLEX8TimeSeries ( const SFTVector *sftsIn         /**< [in] SF
   UINT4 NnegSFT = NhalfNeg ( numFreqBinsSFT );
   REAL8 fHet = f0SFT + 1.0 * NnegSFT * dfSFT;
 
-  /* ----- Prepare invFFT of SFTs: compute plan for FFTW */
-  COMPLEX8FFTPlan *SFTplan;
-  XLAL_CHECK_NULL ( (SFTplan = XLALCreateReverseCOMPLEX8FFTPlan( numFreqBinsSFT, 0 )) != NULL, XLAL_EFUNC );
+  /* ----- (re-)create invFFT plan and batch buffers if the SFT band changed; nothing can then be reused */
+  if ( engine->SFTplan == NULL || engine->numFreqBinsSFT != numFreqBinsSFT || engine->f0SFT != f0SFT || engine->dfSFT != dfSFT )
+    {
+      XLALDestroyCOMPLEX8FFTPlan ( engine->SFTplan );
+      fftw_free ( engine->batchIn );
+      fftw_free ( engine->batchOut );
+      XLALDestroyCOMPLEX8TimeSeries ( engine->lTS );
+      engine->SFTplan = NULL;
+      engine->batchIn = engine->batchOut = NULL;
+      engine->lTS = NULL;
+      engine->numSlots = 0;
+      engine->numFreqBinsSFT = numFreqBinsSFT;
+      engine->f0SFT = f0SFT;
+      engine->dfSFT = dfSFT;
+      engine->stride = ( ( numFreqBinsSFT + 7 ) / 8 ) * 8;	/* 64-byte multiples of COMPLEX8 */
+      XLAL_CHECK_NULL ( (engine->SFTplan = XLALCreateReverseCOMPLEX8FFTPlan( numFreqBinsSFT, 0 )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK_NULL ( (engine->batchIn = fftw_malloc ( engine->batchLength * engine->stride * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK_NULL ( (engine->batchOut = fftw_malloc ( engine->batchLength * engine->stride * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+    }
 
-  /* ----- Prepare short time-series holding ONE invFFT of a single SFT */
-  LIGOTimeGPS XLAL_INIT_DECL(epoch);
-  COMPLEX8TimeSeries *sTS;
-  XLAL_CHECK_NULL ( (sTS = XLALCreateCOMPLEX8TimeSeries ( "short timeseries", &epoch, 0, deltaT, &emptyLALUnit, numFreqBinsSFT )) != NULL, XLAL_EFUNC );
+  /* ----- work out where each SFT goes within the long time-series */
+  SFTtoTSSlot *slots;
+  BOOLEAN *transform;
+  UINT4 *todo;
+  XLAL_CHECK_NULL ( (slots = XLALCalloc ( numSFTs, sizeof(slots[0]) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_NULL ( (transform = XLALCalloc ( numSFTs, sizeof(transform[0]) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_NULL ( (todo = XLALCalloc ( numSFTs, sizeof(todo[0]) )) != NULL, XLAL_ENOMEM );
+  BOOLEAN overlapping = 0;
+  for ( UINT4 n = 0; n < numSFTs; n ++ )
+    {
+      XLAL_CHECK_NULL ( SFTtoTSComputeSlot ( &slots[n], &(sfts->data[n]), &start, deltaT, Tsft, fHet, numSamples ) == XLAL_SUCCESS, XLAL_EFUNC );
+      if ( n > 0 && XLALGPSDiff ( &(sfts->data[n].epoch), &(sfts->data[n-1].epoch) ) < Tsft - 1e-9 ) {
+        overlapping = 1;	/* also true for SFTs out of time order */
+      }
+      transform[n] = 1;
+    }
 
   /* ----- prepare long TimeSeries container ---------- */
   COMPLEX8TimeSeries *lTS;
   XLAL_CHECK_NULL ( (lTS = XLALCreateCOMPLEX8TimeSeries ( firstSFT->name, &start, fHet, deltaT, &emptyLALUnit, numSamples )) != NULL, XLAL_EFUNC );
   memset ( lTS->data->data, 0, numSamples * sizeof(*lTS->data->data)); 	/* set all time-samples to zero (in case there are gaps) */
 
-  /* ---------- loop over all SFTs and inverse-FFT them ---------- */
-  for ( UINT4 n = 0; n < numSFTs; n ++ )
+  /* ----- copy over samples of unchanged SFTs from the previous time-series, if possible */
+  if ( engine->lTS != NULL && !overlapping && !engine->overlapping )
     {
-      SFTtype *thisSFT = &(sfts->data[n]);
-
-      /* find bin in long timeseries corresponding to starttime of *this* SFT */
-      REAL8 offset_n = XLALGPSDiff ( &(thisSFT->epoch), &start );
-      UINT4 bin0_n = lround ( offset_n / deltaT );	/* round to closest bin */
-
-      REAL8 nudge_n = bin0_n * deltaT - offset_n;		/* rounding error */
-      nudge_n = 1e-9 * round ( nudge_n * 1e9 );	/* round to closest nanosecond */
-      /* nudge SFT into integer timestep bin if necessary */
-      XLAL_CHECK_NULL ( XLALTimeShiftSFT ( thisSFT, nudge_n ) == XLAL_SUCCESS, XLAL_EFUNC  );
-
-      /* determine heterodyning phase-correction for this SFT */
-      REAL8 offset = XLALGPSDiff ( &thisSFT->epoch, &start );	// updated value after time-shift
-      // fHet * Tsft is an integer by construction, because fHet was chosen as a frequency-bin of the input SFTs
-      // therefore we only need the remainder (offset % Tsft)
-      REAL8 offsetEff = fmod ( offset, Tsft );
-      REAL8 hetCycles = fmod ( fHet * offsetEff, 1); // heterodyning phase-correction for this SFT
-
-      if ( nudge_n != 0 ){
-        XLALPrintInfo("n = %d, offset_n = %g, nudge_n = %g, offset = %g, offsetEff = %g, hetCycles = %g\n",
-                      n, offset_n, nudge_n, offset, offsetEff, hetCycles );
-      }
+      /* start of time-series must move by an integer number of samples, so that the nudges are unchanged */
+      const REAL8 shift = XLALGPSDiff ( &start, &(engine->lTS->epoch) );
+      const REAL8 shiftSamples = round ( shift / deltaT );
+      if ( fabs ( shift - shiftSamples * deltaT ) < 1e-9 )
+        {
+          /* change in heterodyning phase-correction: fHet * Tsft is an integer, as above */
+          REAL8 shiftCycles = fmod ( fHet * fmod ( shift, Tsft ), 1 );
+          REAL4 shiftPhase_re = 1, shiftPhase_im = 0;
+          if ( shiftCycles != 0 ) {
+            XLAL_CHECK_NULL ( XLALSinCos2PiLUT ( &shiftPhase_im, &shiftPhase_re, shiftCycles ) == XLAL_SUCCESS, XLAL_EFUNC );
+          }
+          COMPLEX8 shiftPhase = crectf ( shiftPhase_re, shiftPhase_im );
+
+          if ( changedSFTs != NULL ) {
+            for ( UINT4 i = 0; i < changedSFTs->length; i ++ ) {
+              XLAL_CHECK_NULL ( changedSFTs->data[i] < numSFTs, XLAL_EDOM, "changedSFTs[%u] = %u is not an SFT index", i, changedSFTs->data[i] );
+              transform[changedSFTs->data[i]] = 2;
+            }
+          }
+
+          /* match SFTs to those of the previous update by epoch; both lists are in time order */
+          UINT4 m = 0;
+          for ( UINT4 n = 0; n < numSFTs; n ++ )
+            {
+              while ( m < engine->numSlots && XLALGPSCmp ( &(engine->slots[m].epoch), &(slots[n].epoch) ) < 0 ) {
+                m ++;
+              }
+              if ( m == engine->numSlots || transform[n] == 2 || XLALGPSCmp ( &(engine->slots[m].epoch), &(slots[n].epoch) ) != 0 || engine->slots[m].copyLen < slots[n].copyLen ) {
+                continue;
+              }
+              const COMPLEX8 *from = engine->lTS->data->data + engine->slots[m].bin0;
+              COMPLEX8 *to = lTS->data->data + slots[n].bin0;
+              if ( shiftCycles != 0 ) {
+                for ( UINT4 j = 0; j < slots[n].copyLen; j ++ ) {
+                  to[j] = from[j] * shiftPhase;
+                }
+              } else {
+                memcpy ( to, from, slots[n].copyLen * sizeof(to[0]) );
+              }
+              transform[n] = 0;
+            } /* for n < numSFTs */
+        }
+    }
 
-      REAL4 hetCorrection_re, hetCorrection_im;
-      XLAL_CHECK_NULL ( XLALSinCos2PiLUT ( &hetCorrection_im, &hetCorrection_re, -hetCycles ) == XLAL_SUCCESS, XLAL_EFUNC );
-      COMPLEX8 hetCorrection = crectf( hetCorrection_re, hetCorrection_im );
+  /* ---------- inverse-FFT all remaining SFTs in batches ---------- */
+  UINT4 numTodo = 0;
+  for ( UINT4 n = 0; n < numSFTs; n ++ ) {
+    if ( transform[n] ) {
+      todo[numTodo++] = n;
+    }
+  }
+  XLALSinCosLUTInit();	/* initialise lookup table outside of parallel region */
+  int errnum = 0;
+  for ( UINT4 b = 0; b < numTodo && errnum == 0; b += engine->batchLength )
+    {
+      const UINT4 numBatch = MYMIN ( engine->batchLength, numTodo - b );
+#pragma omp parallel for schedule(static)
+      for ( UINT4 i = 0; i < numBatch; i ++ )
+        {
+          const UINT4 n = todo[b + i];
+          if ( SFTtoTSTransformSFT ( engine->batchOut + i * engine->stride, engine->batchIn + i * engine->stride, &(sfts->data[n]), &slots[n], engine->SFTplan ) != XLAL_SUCCESS )
+            {
+#pragma omp critical (XLALSFTtoTSEngineUpdate)
+              errnum = xlalErrno;
+            }
+        } /* for i < numBatch */
+
+      // copy the short (shifted) heterodyned timeseries into correct location within long timeseries,
+      // in SFT order so that later SFTs take precedence where SFTs overlap
+      for ( UINT4 i = 0; i < numBatch && errnum == 0; i ++ )
+        {
+          const UINT4 n = todo[b + i];
+          memcpy ( &lTS->data->data[slots[n].bin0], engine->batchOut + i * engine->stride, slots[n].copyLen * sizeof(lTS->data->data[0]) );
+        }
+    } /* for b < numTodo */
+  XLALFree ( todo );
+  XLALFree ( transform );
+  if ( errnum != 0 ) {
+    XLALFree ( slots );
+    XLALDestroyCOMPLEX8TimeSeries ( lTS );
+    XLAL_ERROR_NULL ( errnum, "Failed to inverse-FFT SFTs" );
+  }
 
-      /* Note: we also bundle the overall normalization of 'df' into the het-correction.
-       * This ensures that the resulting timeseries will have the correct normalization, according to
-       * x_l = invFT[sft]_l = df * sum_{k=0}^{N-1} xt_k * e^(i 2pi k l / N )
-       * where x_l is the l-th timestamp, and xt_k is the k-th frequency bin of the SFT.
-       * See the LAL-conventions on FFTs:  http://www.ligo.caltech.edu/docs/T/T010095-00.pdf
-       * (the FFTw convention does not contain the factor of 'df', which is why we need to
-       * apply it ourselves)
-       *
-       */
-      hetCorrection *= dfSFT;
+  /* ----- keep this time-series for the next update */
+  XLALDestroyCOMPLEX8TimeSeries ( engine->lTS );
+  if ( engine->slots != NULL ) {
+    XLALFree ( engine->slots );
+  }
+  engine->lTS = lTS;
+  engine->slots = slots;
+  engine->numSlots = numSFTs;
+  engine->overlapping = overlapping;
 
-      XLAL_CHECK_NULL ( XLALReorderSFTtoFFTW (thisSFT->data) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK_NULL ( XLALCOMPLEX8VectorFFT( sTS->data, thisSFT->data, SFTplan ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return lTS;
 
-      for ( UINT4 j=0; j < sTS->data->length; j++) {
-        sTS->data->data[j] *= hetCorrection;
-      } // for j < numFreqBinsSFT
+} // XLALSFTtoTSEngineUpdate()
 
-      // copy the short (shifted) heterodyned timeseries into correct location within long timeseries
-      UINT4 binsLeft = numSamples - bin0_n;
-      UINT4 copyLen = MYMIN ( numFreqBinsSFT, binsLeft );		/* make sure not to write past the end of the long TS */
-      memcpy ( &lTS->data->data[bin0_n], sTS->data->data, copyLen * sizeof(lTS->data->data[0]) );
 
-    } /* for n < numSFTs */
+/**
+ * Turn the given SFTvector into one long time-series, properly dealing with gaps.
+ */
+COMPLEX8TimeSeries *
+XLALSFTVectorToCOMPLEX8TimeSeries ( const SFTVector *sftsIn         /**< [in] SFT vector */
+                                    )
+{
+  // check input sanity
+  XLAL_CHECK_NULL ( (sftsIn !=NULL) && (sftsIn->length > 0), XLAL_EINVAL );
 
-  // cleanup memory
-  XLALDestroySFTVector ( sfts );
-  XLALDestroyCOMPLEX8TimeSeries ( sTS );
-  XLALDestroyCOMPLEX8FFTPlan ( SFTplan );
+  SFTtoTSEngine *engine;
+  XLAL_CHECK_NULL ( (engine = XLALCreateSFTtoTSEngine ( 0 )) != NULL, XLAL_EFUNC );
+  if ( XLALSFTtoTSEngineUpdate ( engine, sftsIn, NULL ) == NULL ) {
+    XLALDestroySFTtoTSEngine ( engine );
+    XLAL_ERROR_NULL ( XLAL_EFUNC );
+  }
+
+  /* take ownership of the time-series from the engine */
+  COMPLEX8TimeSeries *lTS = engine->lTS;
+  engine->lTS = NULL;
+  XLALDestroySFTtoTSEngine ( engine );
 
   return lTS;
 
@@ -275,10 +543,16 @@ XLALMultiSFTVectorToCOMPLEX8TimeSeries ( const MultiSFTVector *multisfts  /**< [
   XLAL_CHECK_NULL ( (out->data = XLALMalloc ( numDetectors * sizeof(COMPLEX8TimeSeries*) )) != NULL, XLAL_ENOMEM );
   out->length = numDetectors;
 
-  /* loop over detectors */
+  /* loop over detectors, sharing one engine (and so its FFT plan) between them */
+  SFTtoTSEngine *engine;
+  XLAL_CHECK_NULL ( (engine = XLALCreateSFTtoTSEngine ( 0 )) != NULL, XLAL_EFUNC );
   for ( UINT4 X=0; X < numDetectors; X++ ) {
-    XLAL_CHECK_NULL ( (out->data[X] = XLALSFTVectorToCOMPLEX8TimeSeries ( multisfts->data[X] )) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_NULL ( multisfts->data[X] != NULL && multisfts->data[X]->length > 0, XLAL_EINVAL );
+    XLAL_CHECK_NULL ( XLALSFTtoTSEngineUpdate ( engine, multisfts->data[X], NULL ) != NULL, XLAL_EFUNC );
+    out->data[X] = engine->lTS;	/* take ownership of the time-series from the engine */
+    engine->lTS = NULL;
   }
+  XLALDestroySFTtoTSEngine ( engine );
 
   return out;
 
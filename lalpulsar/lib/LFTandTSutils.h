@@ -55,6 +55,10 @@ typedef struct tagMultiCOMPLEX8TimeSeries
   COMPLEX8TimeSeries **data;        	/**< array of COMPLEX8TimeSeries (pointers) */
 } MultiCOMPLEX8TimeSeries;
 
+/** Engine for turning SFT vectors into one long time-series, reusing its FFT plan, buffers and
+ * previous time-series between updates; see XLALSFTtoTSEngineUpdate() */
+typedef struct tagSFTtoTSEngine SFTtoTSEngine;
+
 
 /** Struct holding the results of comparing two floating-point vectors (real-valued or complex),
  * using various different comparison metrics
@@ -76,6 +80,10 @@ COMPLEX8TimeSeries *XLALSFTVectorToCOMPLEX8TimeSeries ( const SFTVector *sfts );
 MultiCOMPLEX8TimeSeries *XLALMultiSFTVectorToCOMPLEX8TimeSeries ( const MultiSFTVector *multisfts );
 SFTtype *XLALSFTVectorToLFT ( SFTVector *sfts, REAL8 upsampling );
 
+SFTtoTSEngine *XLALCreateSFTtoTSEngine ( const UINT4 batchLength );
+void XLALDestroySFTtoTSEngine ( SFTtoTSEngine *engine );
+const COMPLEX8TimeSeries *XLALSFTtoTSEngineUpdate ( SFTtoTSEngine *engine, const SFTVector *sfts, const UINT4Vector *changedSFTs );
+
 int XLALReorderFFTWtoSFT (COMPLEX8Vector *X);
 int XLALReorderSFTtoFFTW (COMPLEX8Vector *X);
 int XLALTimeShiftSFT ( SFTtype *sft, REAL8 shift );
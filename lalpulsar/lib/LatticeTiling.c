@@ -29,6 +29,7 @@
 #include <lal/LogPrintf.h>
 #include <lal/LALHashFunc.h>
 #include <lal/MetricUtils.h>
+#include <lal/Sort.h>
 #include <lal/GSLHelpers.h>
 
 #ifdef __GNUC__
@@ -81,15 +82,16 @@ typedef struct tagLT_FITSRecord {
 } LT_FITSRecord;
 
 ///
-/// Lattice tiling index trie for one dimension.
+/// Lattice tiling index trie for one dimension. The index tries for all dimensions are stored in
+/// one contiguous array, ordered by dimension and then by lattice tiling index, so that the index
+/// tries for neighbouring points are close together in memory.
 ///
-typedef struct tagLT_IndexTrie LT_IndexTrie;
-struct tagLT_IndexTrie {
+typedef struct tagLT_IndexTrie {
   INT4 int_lower;                       ///< Lower integer point bound in this dimension
   INT4 int_upper;                       ///< Upper integer point bound in this dimension
   UINT8 index;                          ///< Sequential lattice tiling index up to this dimension
-  LT_IndexTrie *next;                   ///< Pointer to array of index tries for the next-highest dimension
-};
+  UINT8 next;                           ///< Offset of array of index tries for the next-highest dimension
+} LT_IndexTrie;
 
 struct tagLatticeTiling {
   size_t ndim;                          ///< Number of parameter-space dimensions
@@ -124,6 +126,8 @@ struct tagLatticeTilingIterator {
   INT4 *int_upper;                      ///< Current upper parameter-space bound in generating integers
   INT4 *direction;                      ///< Direction of iteration in each tiled parameter-space dimension
   UINT8 index;                          ///< Index of current lattice tiling point
+  UINT8 index_begin;                    ///< Index of first lattice tiling point in iterator partition
+  UINT8 index_end;                      ///< Index one past last lattice tiling point in iterator partition
 };
 
 struct tagLatticeTilingLocator {
@@ -131,6 +135,7 @@ struct tagLatticeTilingLocator {
   size_t ndim;                          ///< Number of parameter-space dimensions
   size_t tiled_ndim;                    ///< Number of tiled parameter-space dimensions
   LT_IndexTrie *index_trie;             ///< Trie for locating unique index of nearest point
+  size_t index_trie_len;                ///< Number of index tries in 'index_trie'
 };
 
 const UserChoices TilingLatticeChoices = {
@@ -366,19 +371,147 @@ static int LT_InitFITSRecordTable( FITSFile *file )
 }
 
 ///
-/// Free memory pointed to by an index trie. The trie itself should be freed by the caller.
+/// Initialise FITS table for saving and restoring a lattice tiling locator
+///
+static int LT_InitFITSIndexTrieTable( FITSFile *file )
+{
+  XLAL_FITS_TABLE_COLUMN_BEGIN( LT_IndexTrie );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, INT4, int_lower ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, INT4, int_upper ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, UINT8, index ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, UINT8, next ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+///
+/// Compute a checksum of the data which determine the index trie of a lattice tiling locator,
+/// i.e. the parameter-space bounds, lattice origin, and transform to generating integers. The
+/// bounds are identified by their names, and their values are checksummed by sampling the bound
+/// functions around the lattice origin, in the same way as lattice tiling iterators find the bound
+/// extrema; the arbitrary bound data itself is never checksummed, since it may contain e.g. struct
+/// padding or pointers which differ between otherwise identical tilings.
 ///
-static void LT_FreeIndexTrie(
-  LT_IndexTrie *trie                    ///< [in] Pointer to array of index tries
+static int LT_LocatorChecksum( const LatticeTiling *tiling, INT4 *checksum )
+{
+
+  const size_t n = tiling->ndim;
+
+  // Allocate memory for sampling parameter-space bounds
+  gsl_vector *GAVEC( phys_sampl, n );
+  gsl_matrix *GAMAT( phys_sampl_cache, n, LT_CACHE_MAX_SIZE );
+  gsl_matrix_set_all( phys_sampl_cache, GSL_NAN );
+  gsl_vector_memcpy( phys_sampl, tiling->phys_origin );
+
+  *checksum = 0;
+  for ( size_t i = 0; i < n; ++i ) {
+    const LT_Bound *bound = &tiling->bounds[i];
+    XLAL_CHECK( XLALPearsonHash( checksum, sizeof( *checksum ), bound->name, strlen( bound->name ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+    const UINT4 is_tiled = bound->is_tiled ? 1 : 0;
+    XLAL_CHECK( XLALPearsonHash( checksum, sizeof( *checksum ), &is_tiled, sizeof( is_tiled ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+    const UINT4 padf = bound->padf;
+    XLAL_CHECK( XLALPearsonHash( checksum, sizeof( *checksum ), &padf, sizeof( padf ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    // Checksum the parameter-space bounds at, and the extrema of the bounds around, the lattice origin
+    double phys_bounds[4];
+    LT_CallBoundFunc( tiling, i, phys_sampl_cache, phys_sampl, &phys_bounds[0], &phys_bounds[1] );
+    phys_bounds[2] = GSL_POSINF;
+    phys_bounds[3] = GSL_NEGINF;
+    LT_FindBoundExtrema( tiling, 0, i, phys_sampl_cache, phys_sampl, &phys_bounds[2], &phys_bounds[3] );
+    XLAL_CHECK( XLALPearsonHash( checksum, sizeof( *checksum ), phys_bounds, sizeof( phys_bounds ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+    LT_SetPhysPoint( tiling, phys_sampl_cache, phys_sampl, i, gsl_vector_get( tiling->phys_origin, i ) );
+
+    const double phys_origin = gsl_vector_get( tiling->phys_origin, i );
+    XLAL_CHECK( XLALPearsonHash( checksum, sizeof( *checksum ), &phys_origin, sizeof( phys_origin ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+    for ( size_t j = 0; j <= i; ++j ) {
+      const double int_from_phys = gsl_matrix_get( tiling->int_from_phys, i, j );
+      XLAL_CHECK( XLALPearsonHash( checksum, sizeof( *checksum ), &int_from_phys, sizeof( int_from_phys ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+  }
+
+  // Cleanup
+  GFVEC( phys_sampl );
+  GFMAT( phys_sampl_cache );
+
+  return XLAL_SUCCESS;
+
+}
+
+///
+/// Check that an index trie restored from a FITS file is consistent
+///
+static int LT_CheckIndexTrie(
+  const LT_IndexTrie *index_trie,       ///< [in] Array of all index tries
+  const size_t index_trie_len,          ///< [in] Number of index tries in array
+  const LT_IndexTrie *trie,             ///< [in] Pointer to array of index tries
+  const size_t ti,                      ///< [in] Current depth of the trie
+  const size_t tn                       ///< [in] Total depth of the trie
+  )
+{
+  XLAL_CHECK( trie->int_lower <= trie->int_upper, XLAL_EIO );
+  if ( ti + 1 < tn ) {
+    const size_t next_length = trie->int_upper - trie->int_lower + 1;
+    XLAL_CHECK( trie->next > ( UINT8 )( trie - index_trie ), XLAL_EIO );
+    XLAL_CHECK( trie->next + next_length <= index_trie_len, XLAL_EIO );
+    for ( size_t k = 0; k < next_length; ++k ) {
+      XLAL_CHECK( LT_CheckIndexTrie( index_trie, index_trie_len, &index_trie[trie->next + k], ti + 1, tn ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+  }
+  return XLAL_SUCCESS;
+}
+
+///
+/// Append 'count' zeroed index tries to a growable array of index tries, and return the offset of
+/// the first appended index trie in 'offset'.
+///
+static int LT_AppendIndexTries(
+  LT_IndexTrie **tries,                 ///< [in,out] Array of index tries
+  size_t *len,                          ///< [in,out] Number of index tries in array
+  size_t *max_len,                      ///< [in,out] Number of index tries allocated in array
+  const size_t count,                   ///< [in] Number of index tries to append
+  size_t *offset                        ///< [out] Offset of first appended index trie
   )
 {
-  LT_IndexTrie *next = trie->next;
-  if ( next != NULL ) {
-    for ( INT4 i = trie->int_lower; i <= trie->int_upper; ++i ) {
-      LT_FreeIndexTrie( next++ );
+  if ( *len + count > *max_len ) {
+    size_t new_max_len = GSL_MAX( 2 * ( *max_len ), *len + count );
+    LT_IndexTrie *new_tries = XLALRealloc( *tries, new_max_len * sizeof( **tries ) );
+    XLAL_CHECK( new_tries != NULL, XLAL_ENOMEM );
+    *tries = new_tries;
+    *max_len = new_max_len;
+  }
+  memset( &( *tries )[*len], 0, count * sizeof( **tries ) );
+  *offset = *len;
+  *len += count;
+  return XLAL_SUCCESS;
+}
+
+///
+/// Compare two points by their generating integers, rounded to the nearest integer, in the tiled
+/// dimensions in order of increasing dimension. Used to sort points before looking them up in the
+/// index trie, so that consecutive lookups visit neighbouring index tries.
+///
+static int LT_CompareIntPoints(
+  void *param,                          ///< [in] Pointer to matrix of points in generating integers
+  const void *x,                        ///< [in] Pointer to column index of first point
+  const void *y                         ///< [in] Pointer to column index of second point
+  )
+{
+  const void *const *params = ( const void *const * ) param;
+  const LatticeTiling *tiling = ( const LatticeTiling * ) params[0];
+  const gsl_matrix *points = ( const gsl_matrix * ) params[1];
+  const UINT4 jx = *( ( const UINT4 * ) x );
+  const UINT4 jy = *( ( const UINT4 * ) y );
+  for ( size_t ti = 0; ti < tiling->tiled_ndim; ++ti ) {
+    const size_t i = tiling->tiled_idx[ti];
+    const double int_x = floor( gsl_matrix_get( points, i, jx ) + 0.5 );
+    const double int_y = floor( gsl_matrix_get( points, i, jy ) + 0.5 );
+    if ( int_x < int_y ) {
+      return -1;
+    }
+    if ( int_x > int_y ) {
+      return +1;
     }
-    XLALFree( trie->next );
   }
+  return ( jx > jy ) - ( jx < jy );
 }
 
 ///
@@ -387,6 +520,7 @@ static void LT_FreeIndexTrie(
 ///
 static void LT_PollIndexTrie(
   const LatticeTiling *tiling,          ///< [in] Lattice tiling
+  const LT_IndexTrie *index_trie,       ///< [in] Array of all lattice tiling index tries
   const LT_IndexTrie *trie,             ///< [in] Lattice tiling index trie
   const size_t ti,                      ///< [in] Current depth of the trie
   const gsl_vector *point_int,          ///< [in] Original point in generating integers
@@ -413,8 +547,8 @@ static void LT_PollIndexTrie(
 
     // Continue polling in higher dimensions
     if ( ti + 1 < tn ) {
-      const LT_IndexTrie *next = &trie->next[poll_nearest[i] - trie->int_lower];
-      LT_PollIndexTrie( tiling, next, ti + 1, point_int, poll_nearest, poll_min_distance, nearest );
+      const LT_IndexTrie *next = &index_trie[trie->next + poll_nearest[i] - trie->int_lower];
+      LT_PollIndexTrie( tiling, index_trie, next, ti + 1, point_int, poll_nearest, poll_min_distance, nearest );
       continue;
     }
 
@@ -446,6 +580,7 @@ static void LT_PollIndexTrie(
 ///
 static void LT_PrintIndexTrie(
   const LatticeTiling *tiling,          ///< [in] Lattice tiling
+  const LT_IndexTrie *index_trie,       ///< [in] Array of all lattice tiling index tries
   const LT_IndexTrie *trie,             ///< [in] Lattice tiling index trie
   const size_t ti,                      ///< [in] Current depth of the trie
   FILE *file,                           ///< [in] File pointer to print trie to
@@ -486,15 +621,15 @@ static void LT_PrintIndexTrie(
            ti + 1, tn, trie->int_lower, trie->int_upper, phys_lower, phys_upper, trie->index );
 
   // If this is not the highest dimension, loop over this dimension
-  LT_IndexTrie *next = trie->next;
-  if ( next != NULL ) {
+  if ( ti + 1 < tn ) {
+    const LT_IndexTrie *next = &index_trie[trie->next];
     for ( int32_t point = trie->int_lower; point <= trie->int_upper; ++point, ++next ) {
 
       // Set 'i'th integer lower bound to this point
       int_lower[ti] = point;
 
       // Print higher dimensions
-      LT_PrintIndexTrie( tiling, next, ti + 1, file, int_lower );
+      LT_PrintIndexTrie( tiling, index_trie, next, ti + 1, file, int_lower );
 
     }
   }
@@ -502,269 +637,312 @@ static void LT_PrintIndexTrie(
 }
 
 ///
-/// Locate the nearest points in a lattice tiling to a given set of points. Return the nearest
-/// points in 'nearest_points', and optionally: unique sequential indexes to the nearest points in
-/// 'nearest_indexes', and indexes of the left/right-most points in the blocks of the nearest points
-/// relative to the nearest points in 'nearest_left' and 'nearest_right' respectively.
+/// Locate the nearest point in a lattice tiling to the point 'nearest_points[:,j]', the tiled
+/// dimensions of which are generating integers; called by LT_FindNearestPoints().
 ///
-static int LT_FindNearestPoints(
+static int LT_FindNearestPoint(
   const LatticeTilingLocator *loc,      ///< [in] Lattice tiling locator
-  const gsl_matrix *points,             ///< [in] Columns are set of points for which to find nearest points
-  gsl_matrix *nearest_points,           ///< [out] Columns are the corresponding nearest points
+  gsl_matrix *nearest_points,           ///< [in,out] Columns are points in generating integers/nearest points
+  const size_t j,                       ///< [in] Index of point to locate
   UINT8VectorSequence *nearest_indexes, ///< [out] Vectors are unique sequential indexes of the nearest points
   INT4VectorSequence *nearest_lefts,    ///< [out] Vectors are indexes of left-most points of blocks relative to nearest points
   INT4VectorSequence *nearest_rights    ///< [out] Vectors are indexes of right-most points of blocks relative to nearest points
   )
 {
 
-  // Check input
-  XLAL_CHECK( loc != NULL, XLAL_EFAULT );
-  XLAL_CHECK( points != NULL, XLAL_EFAULT );
-  XLAL_CHECK( points->size1 == loc->ndim, XLAL_EINVAL );
-  XLAL_CHECK( nearest_points != NULL, XLAL_EFAULT );
-  XLAL_CHECK( nearest_points->size1 == loc->ndim, XLAL_EINVAL );
-  XLAL_CHECK( nearest_points->size2 == points->size2, XLAL_EINVAL );
-
   const size_t n = loc->ndim;
   const size_t tn = loc->tiled_ndim;
-  const size_t num_points = points->size2;
 
-  // Copy 'points' to 'nearest_points'
-  gsl_matrix_memcpy( nearest_points, points );
+  // If there are tiled dimensions:
+  INT4 nearest[n];
+  if ( tn > 0 ) {
 
-  // Transform 'nearest_points' from physical coordinates to generating integers
-  for ( size_t i = 0; i < n; ++i ) {
-    const double phys_origin = gsl_vector_get( loc->tiling->phys_origin, i );
-    gsl_vector_view nearest_points_row = gsl_matrix_row( nearest_points, i );
-    gsl_vector_add_constant( &nearest_points_row.vector, -phys_origin );
-  }
-  gsl_blas_dtrmm( CblasLeft, CblasLower, CblasNoTrans, CblasNonUnit, 1.0, loc->tiling->int_from_phys, nearest_points );
+    // Find the nearest point to 'nearest_points[:,j]', the tiled dimensions of which are generating integers
+    switch ( loc->tiling->lattice ) {
 
-  // Find the nearest points in the lattice tiling to the points in 'nearest_points'
-  for ( size_t j = 0; j < num_points; ++j ) {
+    case TILING_LATTICE_CUBIC:    // Cubic (\f$Z_n\f$) lattice
+
+    {
+
+      // Round each dimension of 'nearest_points[:,j]' to nearest integer to find the nearest point in Zn
+      feclearexcept( FE_ALL_EXCEPT );
+      for ( size_t ti = 0; ti < tn; ++ti ) {
+        const size_t i = loc->tiling->tiled_idx[ti];
+        nearest[i] = lround( gsl_matrix_get( nearest_points, i, j ) );
+      }
+      if ( fetestexcept( FE_INVALID ) != 0 ) {
+        XLALPrintError( "Rounding failed while finding nearest point #%zu:", j );
+        for ( size_t ti = 0; ti < tn; ++ti ) {
+          const size_t i = loc->tiling->tiled_idx[ti];
+          XLALPrintError( " %0.2e", gsl_matrix_get( nearest_points, i, j ) );
+        }
+        XLALPrintError( "\n" );
+        XLAL_ERROR( XLAL_EFAILED );
+      }
 
-    // If there are tiled dimensions:
-    INT4 nearest[n];
-    if ( tn > 0 ) {
+    }
+    break;
 
-      // Find the nearest point to 'nearest_points[:,j]', the tiled dimensions of which are generating integers
-      switch ( loc->tiling->lattice ) {
+    case TILING_LATTICE_ANSTAR:   // An-star (\f$A_n^*\f$) lattice
 
-      case TILING_LATTICE_CUBIC:    // Cubic (\f$Z_n\f$) lattice
+    {
 
+      // The nearest point algorithm used below embeds the An* lattice in tn+1 dimensions,
+      // however 'nearest_points[:,j]' has only 'tn' tiled dimensional. The algorithm is only
+      // sensitive to the differences between the 'ti'th and 'ti+1'th dimension, so we can
+      // freely set one of the dimensions to a constant value. We choose to set the 0th
+      // dimension to zero, i.e. the (tn+1)-dimensional lattice point is
+      //   y = (0, tiled dimensions of 'nearest_points[:,j]').
+      double y[tn+1];
+      y[0] = 0;
+      for ( size_t ti = 0; ti < tn; ++ti ) {
+        const size_t i = loc->tiling->tiled_idx[ti];
+        y[ti+1] = gsl_matrix_get( nearest_points, i, j );
+      }
+
+      // Find the nearest point in An* to the point 'y', using the O(tn) Algorithm 2 given in:
+      //   McKilliam et.al., "A linear-time nearest point algorithm for the lattice An*"
+      //   in "International Symposium on Information Theory and Its Applications", ISITA2008,
+      //   Auckland, New Zealand, 7-10 Dec. 2008. DOI: 10.1109/ISITA.2008.4895596
+      // Notes:
+      //   * Since Algorithm 2 uses 1-based arrays, we have to translate, e.g.:
+      //       z_t in paper <---> z[tn-1] in C code
+      //   * Line 6 in Algorithm 2 as written in the paper is in error, see correction below.
+      //   * We are only interested in 'k', the generating integers of the nearest point
+      //     'x = Q * k', therefore line 26 in Algorithm 2 is not included.
+      INT4 k[tn+1];
       {
 
-        // Round each dimension of 'nearest_points[:,j]' to nearest integer to find the nearest point in Zn
+        // Lines 1--4, 20
+        double z[tn+1], alpha = 0, beta = 0;
+        size_t bucket[tn+1], link[tn+1];
         feclearexcept( FE_ALL_EXCEPT );
-        for ( size_t ti = 0; ti < tn; ++ti ) {
-          const size_t i = loc->tiling->tiled_idx[ti];
-          nearest[i] = lround( gsl_matrix_get( nearest_points, i, j ) );
+        for ( size_t ti = 1; ti <= tn + 1; ++ti ) {
+          k[ti-1] = lround( y[ti-1] ); // Line 20, moved here to avoid duplicate round
+          z[ti-1] = y[ti-1] - k[ti-1];
+          alpha += z[ti-1];
+          beta += z[ti-1]*z[ti-1];
+          bucket[ti-1] = 0;
         }
         if ( fetestexcept( FE_INVALID ) != 0 ) {
           XLALPrintError( "Rounding failed while finding nearest point #%zu:", j );
-          for ( size_t ti = 0; ti < tn; ++ti ) {
-            const size_t i = loc->tiling->tiled_idx[ti];
-            XLALPrintError( " %0.2e", gsl_matrix_get( nearest_points, i, j ) );
+          for ( size_t ti = 1; ti <= tn + 1; ++ti ) {
+            XLALPrintError( " %0.2e", y[ti-1] );
           }
           XLALPrintError( "\n" );
           XLAL_ERROR( XLAL_EFAILED );
         }
 
-      }
-      break;
-
-      case TILING_LATTICE_ANSTAR:   // An-star (\f$A_n^*\f$) lattice
-
-      {
-
-        // The nearest point algorithm used below embeds the An* lattice in tn+1 dimensions,
-        // however 'nearest_points[:,j]' has only 'tn' tiled dimensional. The algorithm is only
-        // sensitive to the differences between the 'ti'th and 'ti+1'th dimension, so we can
-        // freely set one of the dimensions to a constant value. We choose to set the 0th
-        // dimension to zero, i.e. the (tn+1)-dimensional lattice point is
-        //   y = (0, tiled dimensions of 'nearest_points[:,j]').
-        double y[tn+1];
-        y[0] = 0;
-        for ( size_t ti = 0; ti < tn; ++ti ) {
-          const size_t i = loc->tiling->tiled_idx[ti];
-          y[ti+1] = gsl_matrix_get( nearest_points, i, j );
+        // Lines 5--8
+        // Notes:
+        //   * Correction to line 6, as as written in McKilliam et.al.:
+        //       ti = tn + 1 - (tn + 1)*floor(z_t + 0.5)
+        //     should instead read
+        //       ti = tn + 1 - floor((tn + 1)*(z_t + 0.5))
+        //   * We also convert the floor() operation into an lround():
+        //       ti = tn + 1 - lround((tn + 1)*(z_t + 0.5) - 0.5)
+        //     to avoid a casting operation. Rewriting the line as:
+        //       ti = lround((tn + 1)*(0.5 - z_t) + 0.5)
+        //     appears to improve numerical robustness in some cases.
+        //   * No floating-point exception checking needed for lround()
+        //     here since its argument will be of order 'tn'.
+        for ( size_t tt = 1; tt <= tn + 1; ++tt ) {
+          const INT4 ti = lround( ( tn + 1 )*( 0.5 - z[tt-1] ) + 0.5 );
+          link[tt-1] = bucket[ti-1];
+          bucket[ti-1] = tt;
         }
 
-        // Find the nearest point in An* to the point 'y', using the O(tn) Algorithm 2 given in:
-        //   McKilliam et.al., "A linear-time nearest point algorithm for the lattice An*"
-        //   in "International Symposium on Information Theory and Its Applications", ISITA2008,
-        //   Auckland, New Zealand, 7-10 Dec. 2008. DOI: 10.1109/ISITA.2008.4895596
-        // Notes:
-        //   * Since Algorithm 2 uses 1-based arrays, we have to translate, e.g.:
-        //       z_t in paper <---> z[tn-1] in C code
-        //   * Line 6 in Algorithm 2 as written in the paper is in error, see correction below.
-        //   * We are only interested in 'k', the generating integers of the nearest point
-        //     'x = Q * k', therefore line 26 in Algorithm 2 is not included.
-        INT4 k[tn+1];
-        {
-
-          // Lines 1--4, 20
-          double z[tn+1], alpha = 0, beta = 0;
-          size_t bucket[tn+1], link[tn+1];
-          feclearexcept( FE_ALL_EXCEPT );
-          for ( size_t ti = 1; ti <= tn + 1; ++ti ) {
-            k[ti-1] = lround( y[ti-1] ); // Line 20, moved here to avoid duplicate round
-            z[ti-1] = y[ti-1] - k[ti-1];
-            alpha += z[ti-1];
-            beta += z[ti-1]*z[ti-1];
-            bucket[ti-1] = 0;
+        // Lines 9--10
+        double D = beta - alpha*alpha / ( tn + 1 );
+        size_t tm = 0;
+
+        // Lines 11--19
+        for ( size_t ti = 1; ti <= tn + 1; ++ti ) {
+          size_t tt = bucket[ti-1];
+          while ( tt != 0 ) {
+            alpha = alpha - 1;
+            beta = beta - 2*z[tt-1] + 1;
+            tt = link[tt-1];
           }
-          if ( fetestexcept( FE_INVALID ) != 0 ) {
-            XLALPrintError( "Rounding failed while finding nearest point #%zu:", j );
-            for ( size_t ti = 1; ti <= tn + 1; ++ti ) {
-              XLALPrintError( " %0.2e", y[ti-1] );
-            }
-            XLALPrintError( "\n" );
-            XLAL_ERROR( XLAL_EFAILED );
+          double d = beta - alpha*alpha / ( tn + 1 );
+          if ( d < D ) {
+            D = d;
+            tm = ti;
           }
+        }
 
-          // Lines 5--8
-          // Notes:
-          //   * Correction to line 6, as as written in McKilliam et.al.:
-          //       ti = tn + 1 - (tn + 1)*floor(z_t + 0.5)
-          //     should instead read
-          //       ti = tn + 1 - floor((tn + 1)*(z_t + 0.5))
-          //   * We also convert the floor() operation into an lround():
-          //       ti = tn + 1 - lround((tn + 1)*(z_t + 0.5) - 0.5)
-          //     to avoid a casting operation. Rewriting the line as:
-          //       ti = lround((tn + 1)*(0.5 - z_t) + 0.5)
-          //     appears to improve numerical robustness in some cases.
-          //   * No floating-point exception checking needed for lround()
-          //     here since its argument will be of order 'tn'.
-          for ( size_t tt = 1; tt <= tn + 1; ++tt ) {
-            const INT4 ti = lround( ( tn + 1 )*( 0.5 - z[tt-1] ) + 0.5 );
-            link[tt-1] = bucket[ti-1];
-            bucket[ti-1] = tt;
+        // Lines 21--25
+        for ( size_t ti = 1; ti <= tm; ++ti ) {
+          size_t tt = bucket[ti-1];
+          while ( tt != 0 ) {
+            k[tt-1] = k[tt-1] + 1;
+            tt = link[tt-1];
           }
+        }
 
-          // Lines 9--10
-          double D = beta - alpha*alpha / ( tn + 1 );
-          size_t tm = 0;
+      }
 
-          // Lines 11--19
-          for ( size_t ti = 1; ti <= tn + 1; ++ti ) {
-            size_t tt = bucket[ti-1];
-            while ( tt != 0 ) {
-              alpha = alpha - 1;
-              beta = beta - 2*z[tt-1] + 1;
-              tt = link[tt-1];
-            }
-            double d = beta - alpha*alpha / ( tn + 1 );
-            if ( d < D ) {
-              D = d;
-              tm = ti;
-            }
-          }
+      // The nearest point in An* is the tn differences between k[1]...k[tn] and k[0]
+      for ( size_t ti = 0; ti < tn; ++ti ) {
+        const size_t i = loc->tiling->tiled_idx[ti];
+        nearest[i] = k[ti+1] - k[0];
+      }
 
-          // Lines 21--25
-          for ( size_t ti = 1; ti <= tm; ++ti ) {
-            size_t tt = bucket[ti-1];
-            while ( tt != 0 ) {
-              k[tt-1] = k[tt-1] + 1;
-              tt = link[tt-1];
-            }
-          }
+    }
+    break;
 
-        }
+    default:
+      XLAL_ERROR( XLAL_EFAILED, "Invalid lattice" );
+    }
 
-        // The nearest point in An* is the tn differences between k[1]...k[tn] and k[0]
-        for ( size_t ti = 0; ti < tn; ++ti ) {
-          const size_t i = loc->tiling->tiled_idx[ti];
-          nearest[i] = k[ti+1] - k[0];
-        }
+    // Bound generating integers
+    {
+      const LT_IndexTrie *trie = loc->index_trie;
+      size_t ti = 0;
+      while ( ti < tn ) {
+        const size_t i = loc->tiling->tiled_idx[ti];
+
+        // If 'nearest[i]' is outside parameter-space bounds:
+        if ( nearest[i] < trie->int_lower || nearest[i] > trie->int_upper ) {
+          XLALPrintInfo( "%s: failed %" LAL_INT4_FORMAT " <= %" LAL_INT4_FORMAT " <= %" LAL_INT4_FORMAT " in dimension #%zu\n",
+                         __func__, trie->int_lower, nearest[i], trie->int_upper, i );
+
+          // Find the nearest point within the parameter-space bounds of the lattice tiling
+          gsl_vector_view point_int_view = gsl_matrix_column( nearest_points, j );
+          INT4 poll_nearest[n];
+          double poll_min_distance = GSL_POSINF;
+          feclearexcept( FE_ALL_EXCEPT );
+          LT_PollIndexTrie( loc->tiling, loc->index_trie, loc->index_trie, 0, &point_int_view.vector, poll_nearest, &poll_min_distance, nearest );
+          XLAL_CHECK( fetestexcept( FE_INVALID ) == 0, XLAL_EFAILED, "Rounding failed while calling LT_PollIndexTrie() for nearest point #%zu", j );
 
-      }
-      break;
+          // Reset 'trie', given that 'nearest' may have changed in any dimension
+          trie = loc->index_trie;
+          ti = 0;
+          continue;
 
-      default:
-        XLAL_ERROR( XLAL_EFAILED, "Invalid lattice" );
-      }
+        }
 
-      // Bound generating integers
-      {
-        const LT_IndexTrie *trie = loc->index_trie;
-        size_t ti = 0;
-        while ( ti < tn ) {
-          const size_t i = loc->tiling->tiled_idx[ti];
+        // If we are below the highest dimension, jump to the next dimension based on 'nearest[i]'
+        if ( ti + 1 < tn ) {
+          trie = &loc->index_trie[trie->next + nearest[i] - trie->int_lower];
+        }
 
-          // If 'nearest[i]' is outside parameter-space bounds:
-          if ( nearest[i] < trie->int_lower || nearest[i] > trie->int_upper ) {
-            XLALPrintInfo( "%s: failed %" LAL_INT4_FORMAT " <= %" LAL_INT4_FORMAT " <= %" LAL_INT4_FORMAT " in dimension #%zu\n",
-                           __func__, trie->int_lower, nearest[i], trie->int_upper, i );
+        ++ti;
 
-            // Find the nearest point within the parameter-space bounds of the lattice tiling
-            gsl_vector_view point_int_view = gsl_matrix_column( nearest_points, j );
-            INT4 poll_nearest[n];
-            double poll_min_distance = GSL_POSINF;
-            feclearexcept( FE_ALL_EXCEPT );
-            LT_PollIndexTrie( loc->tiling, loc->index_trie, 0, &point_int_view.vector, poll_nearest, &poll_min_distance, nearest );
-            XLAL_CHECK( fetestexcept( FE_INVALID ) == 0, XLAL_EFAILED, "Rounding failed while calling LT_PollIndexTrie() for nearest point #%zu", j );
+      }
+    }
 
-            // Reset 'trie', given that 'nearest' may have changed in any dimension
-            trie = loc->index_trie;
-            ti = 0;
-            continue;
+  }
 
-          }
+  // Return various outputs
+  {
+    const LT_IndexTrie *trie = loc->index_trie;
+    UINT8 nearest_index = 0;
+    for ( size_t ti = 0, i = 0; i < n; ++i ) {
+      const bool is_tiled = loc->tiling->bounds[i].is_tiled;
+
+      // Return nearest point
+      if ( is_tiled ) {
+        gsl_matrix_set( nearest_points, i, j, nearest[i] );
+      }
 
-          // If we are below the highest dimension, jump to the next dimension based on 'nearest[i]'
-          if ( ti + 1 < tn ) {
-            trie = &trie->next[nearest[i] - trie->int_lower];
-          }
+      // Return sequential indexes of nearest point
+      // - Non-tiled dimensions inherit value of next-lowest dimension
+      if ( is_tiled ) {
+        nearest_index = trie->index + nearest[i] - trie->int_lower;
+      }
+      if ( nearest_indexes != NULL ) {
+        nearest_indexes->data[n * j + i] = nearest_index;
+      }
 
-          ++ti;
+      // Return indexes of left/right-most points in block relative to nearest point
+      if ( nearest_lefts != NULL ) {
+        nearest_lefts->data[n * j + i] = is_tiled ? trie->int_lower - nearest[i] : 0;
+      }
+      if ( nearest_rights != NULL ) {
+        nearest_rights->data[n * j + i] = is_tiled ? trie->int_upper - nearest[i] : 0;
+      }
 
+      // If we are below the highest dimension, jump to the next dimension based on 'nearest[i]'
+      if ( is_tiled ) {
+        if ( ti + 1 < tn ) {
+          trie = &loc->index_trie[trie->next + nearest[i] - trie->int_lower];
         }
+        ++ti;
       }
 
     }
+  }
 
-    // Return various outputs
-    {
-      const LT_IndexTrie *trie = loc->index_trie;
-      UINT8 nearest_index = 0;
-      for ( size_t ti = 0, i = 0; i < n; ++i ) {
-        const bool is_tiled = loc->tiling->bounds[i].is_tiled;
+  return XLAL_SUCCESS;
 
-        // Return nearest point
-        if ( is_tiled ) {
-          gsl_matrix_set( nearest_points, i, j, nearest[i] );
-        }
+}
 
-        // Return sequential indexes of nearest point
-        // - Non-tiled dimensions inherit value of next-lowest dimension
-        if ( is_tiled ) {
-          nearest_index = trie->index + nearest[i] - trie->int_lower;
-        }
-        if ( nearest_indexes != NULL ) {
-          nearest_indexes->data[n * j + i] = nearest_index;
-        }
+///
+/// Locate the nearest points in a lattice tiling to a given set of points. Return the nearest
+/// points in 'nearest_points', and optionally: unique sequential indexes to the nearest points in
+/// 'nearest_indexes', and indexes of the left/right-most points in the blocks of the nearest points
+/// relative to the nearest points in 'nearest_left' and 'nearest_right' respectively.
+///
+static int LT_FindNearestPoints(
+  const LatticeTilingLocator *loc,      ///< [in] Lattice tiling locator
+  const gsl_matrix *points,             ///< [in] Columns are set of points for which to find nearest points
+  gsl_matrix *nearest_points,           ///< [out] Columns are the corresponding nearest points
+  UINT8VectorSequence *nearest_indexes, ///< [out] Vectors are unique sequential indexes of the nearest points
+  INT4VectorSequence *nearest_lefts,    ///< [out] Vectors are indexes of left-most points of blocks relative to nearest points
+  INT4VectorSequence *nearest_rights    ///< [out] Vectors are indexes of right-most points of blocks relative to nearest points
+  )
+{
 
-        // Return indexes of left/right-most points in block relative to nearest point
-        if ( nearest_lefts != NULL ) {
-          nearest_lefts->data[n * j + i] = is_tiled ? trie->int_lower - nearest[i] : 0;
-        }
-        if ( nearest_rights != NULL ) {
-          nearest_rights->data[n * j + i] = is_tiled ? trie->int_upper - nearest[i] : 0;
-        }
+  // Check input
+  XLAL_CHECK( loc != NULL, XLAL_EFAULT );
+  XLAL_CHECK( points != NULL, XLAL_EFAULT );
+  XLAL_CHECK( points->size1 == loc->ndim, XLAL_EINVAL );
+  XLAL_CHECK( nearest_points != NULL, XLAL_EFAULT );
+  XLAL_CHECK( nearest_points->size1 == loc->ndim, XLAL_EINVAL );
+  XLAL_CHECK( nearest_points->size2 == points->size2, XLAL_EINVAL );
 
-        // If we are below the highest dimension, jump to the next dimension based on 'nearest[i]'
-        if ( is_tiled ) {
-          if ( ti + 1 < tn ) {
-            trie = &trie->next[nearest[i] - trie->int_lower];
-          }
-          ++ti;
-        }
+  const size_t n = loc->ndim;
+  const size_t tn = loc->tiled_ndim;
+  const size_t num_points = points->size2;
 
-      }
+  // Copy 'points' to 'nearest_points'
+  gsl_matrix_memcpy( nearest_points, points );
+
+  // Transform 'nearest_points' from physical coordinates to generating integers
+  for ( size_t i = 0; i < n; ++i ) {
+    const double phys_origin = gsl_vector_get( loc->tiling->phys_origin, i );
+    gsl_vector_view nearest_points_row = gsl_matrix_row( nearest_points, i );
+    gsl_vector_add_constant( &nearest_points_row.vector, -phys_origin );
+  }
+  gsl_blas_dtrmm( CblasLeft, CblasLower, CblasNoTrans, CblasNonUnit, 1.0, loc->tiling->int_from_phys, nearest_points );
+
+  // If there are many points, look them up in order of their generating integers, so that
+  // consecutive lookups visit neighbouring index tries
+  UINT4 *order = NULL;
+  if ( tn > 1 && num_points > 1 ) {
+    XLAL_CHECK( num_points <= UINT32_MAX, XLAL_ESIZE );
+    order = XLALMalloc( num_points * sizeof( *order ) );
+    XLAL_CHECK( order != NULL, XLAL_ENOMEM );
+    for ( size_t j = 0; j < num_points; ++j ) {
+      order[j] = j;
+    }
+    const void *params[2] = { loc->tiling, nearest_points };
+    if ( XLALHeapSort( order, num_points, sizeof( *order ), params, LT_CompareIntPoints ) != XLAL_SUCCESS ) {
+      XLALFree( order );
+      XLAL_ERROR( XLAL_EFUNC );
     }
+  }
 
+  // Find the nearest points in the lattice tiling to the points in 'nearest_points'
+  for ( size_t jj = 0; jj < num_points; ++jj ) {
+    const size_t j = ( order != NULL ) ? order[jj] : jj;
+    if ( LT_FindNearestPoint( loc, nearest_points, j, nearest_indexes, nearest_lefts, nearest_rights ) != XLAL_SUCCESS ) {
+      XLALFree( order );
+      XLAL_ERROR( XLAL_EFUNC );
+    }
   }
+  XLALFree( order );
 
   // Transform 'nearest_points' from generating integers to physical coordinates
   gsl_blas_dtrmm( CblasLeft, CblasLower, CblasNoTrans, CblasNonUnit, 1.0, loc->tiling->phys_from_int, nearest_points );
@@ -1685,6 +1863,8 @@ LatticeTilingIterator *XLALCreateLatticeTilingIterator(
   itr->alternating = false;
   itr->state = 0;
   itr->index = 0;
+  itr->index_begin = 0;
+  itr->index_end = LAL_UINT8_MAX;
 
   // Determine the maximum tiled dimension to iterate over
   itr->tiled_itr_ndim = 0;
@@ -1754,6 +1934,33 @@ int XLALSetLatticeTilingAlternatingIterator(
 
 }
 
+int XLALSetLatticeTilingIteratorPartition(
+  LatticeTilingIterator *itr,
+  const UINT4 num_parts,
+  const UINT4 part
+  )
+{
+
+  // Check input
+  XLAL_CHECK( itr != NULL, XLAL_EFAULT );
+  XLAL_CHECK( itr->state == 0, XLAL_EINVAL );
+  XLAL_CHECK( itr->itr_ndim > 0, XLAL_EINVAL );
+  XLAL_CHECK( num_parts > 0, XLAL_EINVAL );
+  XLAL_CHECK( part < num_parts, XLAL_EINVAL );
+
+  // Get total number of points from lattice tiling statistics
+  const UINT8 total = XLALTotalLatticeTilingPoints( itr );
+  XLAL_CHECK( total > 0, XLAL_EFUNC );
+
+  // Divide points as evenly as possible between partitions
+  const UINT8 quot = total / num_parts, rem = total % num_parts;
+  itr->index_begin = part * quot + GSL_MIN( part, rem );
+  itr->index_end = ( part + 1 ) * quot + GSL_MIN( part + 1, rem );
+
+  return XLAL_SUCCESS;
+
+}
+
 int XLALResetLatticeTilingIterator(
   LatticeTilingIterator *itr
   )
@@ -1769,16 +1976,14 @@ int XLALResetLatticeTilingIterator(
 
 }
 
-int XLALNextLatticeTilingPoint(
-  LatticeTilingIterator *itr,
-  gsl_vector *point
+///
+/// Move the lattice tiling iterator to the next lattice point; called by XLALNextLatticeTilingPoint()
+///
+static int LT_IterateLatticeTilingPoint(
+  LatticeTilingIterator *itr
   )
 {
 
-  // Check input
-  XLAL_CHECK( itr != NULL, XLAL_EFAULT );
-  XLAL_CHECK( point == NULL || point->size == itr->tiling->ndim, XLAL_EINVAL );
-
   const size_t n = itr->tiling->ndim;
   const size_t tn = itr->tiling->tiled_ndim;
 
@@ -2015,13 +2220,88 @@ int XLALNextLatticeTilingPoint(
   // Iterator is in progress
   itr->state = 1;
 
+  // Return index of changed dimensions (offset from 1, since 0 is used to indicate no more points)
+  return 1 + changed_ti;
+
+}
+
+///
+/// Advance an in-progress lattice tiling iterator to the point with index \c index_begin. Whole blocks
+/// of points in the highest iterated tiled dimension are skipped by moving the integer point directly to
+/// the end of the block; XLALNextLatticeTilingPoint() then recomputes the physical point from the
+/// integer point, so that the advanced iterator is in the same state as if it had visited every point.
+///
+static int LT_AdvanceLatticeTilingIterator(
+  LatticeTilingIterator *itr,
+  const UINT8 index_begin
+  )
+{
+
+  // If there are no iterated tiled dimensions, there is only one point
+  if ( itr->tiled_itr_ndim == 0 ) {
+    itr->state = 2;
+    return XLAL_SUCCESS;
+  }
+
+  const size_t ti = itr->tiled_itr_ndim - 1;
+
+  while ( itr->state == 1 && itr->index < index_begin ) {
+
+    // Number of points remaining in the current block, after the current point
+    const INT4 direction = itr->direction[ti];
+    const INT4 remain_ti = ( direction > 0 ) ? itr->int_upper[ti] - itr->int_point[ti] : itr->int_point[ti] - itr->int_lower[ti];
+    const UINT8 remain = GSL_MAX( remain_ti, 0 );
+
+    // Skip to the point before the next point to visit: either within this block, or the last point of this block
+    const UINT8 skip = GSL_MIN( remain, index_begin - itr->index - 1 );
+    itr->int_point[ti] += direction * ( INT4 ) skip;
+    itr->index += skip;
+
+    // Move to next point
+    XLAL_CHECK( LT_IterateLatticeTilingPoint( itr ) >= 0, XLAL_EFUNC );
+
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+int XLALNextLatticeTilingPoint(
+  LatticeTilingIterator *itr,
+  gsl_vector *point
+  )
+{
+
+  // Check input
+  XLAL_CHECK( itr != NULL, XLAL_EFAULT );
+  XLAL_CHECK( point == NULL || point->size == itr->tiling->ndim, XLAL_EINVAL );
+
+  // If iterator has reached the end of its partition, we're done
+  if ( itr->state == 1 && itr->index + 1 >= itr->index_end ) {
+    itr->state = 2;
+    return 0;
+  }
+
+  // Move to next point
+  const bool first_point = ( itr->state == 0 );
+  int retn = LT_IterateLatticeTilingPoint( itr );
+  XLAL_CHECK( retn >= 0, XLAL_EFUNC );
+
+  // If iterator is partitioned, advance to first point in partition
+  if ( first_point && retn > 0 && itr->index_begin > 0 ) {
+    XLAL_CHECK( LT_AdvanceLatticeTilingIterator( itr, itr->index_begin ) == XLAL_SUCCESS, XLAL_EFUNC );
+    retn = ( itr->state == 1 && itr->index < itr->index_end ) ? 1 : 0;
+    if ( retn == 0 ) {
+      itr->state = 2;
+    }
+  }
+
   // Optionally, copy current physical point
-  if ( point != NULL ) {
+  if ( retn > 0 && point != NULL ) {
     gsl_vector_memcpy( point, itr->phys_point );
   }
 
-  // Return index of changed dimensions (offset from 1, since 0 is used to indicate no more points)
-  return 1 + changed_ti;
+  return retn;
 
 }
 
@@ -2198,6 +2478,11 @@ int XLALSaveLatticeTilingIterator(
     XLAL_CHECK( XLALFITSHeaderWriteUINT8( file, "count", count, "total number of lattice tiling points" ) == XLAL_SUCCESS, XLAL_EFUNC );
     UINT8 indx = itr->index;
     XLAL_CHECK( XLALFITSHeaderWriteUINT8( file, "index", indx, "index of current lattice tiling point" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  } {
+    UINT8 index_begin = itr->index_begin;
+    XLAL_CHECK( XLALFITSHeaderWriteUINT8( file, "index_begin", index_begin, "index of first lattice tiling point in partition" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    UINT8 index_end = GSL_MIN( itr->index_end, XLALTotalLatticeTilingPoints( itr ) );
+    XLAL_CHECK( XLALFITSHeaderWriteUINT8( file, "index_end", index_end, "index one past last lattice tiling point in partition" ) == XLAL_SUCCESS, XLAL_EFUNC );
   }
 
   return XLAL_SUCCESS;
@@ -2267,6 +2552,22 @@ int XLALRestoreLatticeTilingIterator(
     XLAL_CHECK( XLALFITSHeaderReadUINT8( file, "index", &indx ) == XLAL_SUCCESS, XLAL_EFUNC );
     XLAL_CHECK( indx < count_ref, XLAL_EIO, "Could not restore iterator; invalid HDU '%s'", name );
     itr->index = indx;
+  } {
+    // Iterators saved before partitioning was supported have no partition keys, and always cover
+    // every point; such iterators may only be restored into an unpartitioned iterator
+    UINT8 index_begin = 0, index_end = XLALTotalLatticeTilingPoints( itr );
+    BOOLEAN exists = 0;
+    XLAL_CHECK( XLALFITSHeaderQueryKeyExists( file, "index_begin", &exists ) == XLAL_SUCCESS, XLAL_EFUNC );
+    if ( exists ) {
+      XLAL_CHECK( XLALFITSHeaderReadUINT8( file, "index_begin", &index_begin ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+    XLAL_CHECK( index_begin == itr->index_begin, XLAL_EIO, "Could not restore iterator; invalid HDU '%s'", name );
+    XLAL_CHECK( XLALFITSHeaderQueryKeyExists( file, "index_end", &exists ) == XLAL_SUCCESS, XLAL_EFUNC );
+    if ( exists ) {
+      XLAL_CHECK( XLALFITSHeaderReadUINT8( file, "index_end", &index_end ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+    XLAL_CHECK( index_end == GSL_MIN( itr->index_end, XLALTotalLatticeTilingPoints( itr ) ), XLAL_EIO, "Could not restore iterator; invalid HDU '%s'", name );
+    XLAL_CHECK( index_begin <= itr->index && itr->index < index_end, XLAL_EIO, "Could not restore iterator; invalid HDU '%s'", name );
   }
 
   // Read FITS records from table
@@ -2331,9 +2632,19 @@ LatticeTilingLocator *XLALCreateLatticeTilingLocator(
 
     const size_t tn = itr->tiling->tiled_ndim;
 
-    // Allocate array of pointers to the next index trie in each dimension
-    LT_IndexTrie *next[tn];
+    // Allocate growable arrays of index tries in each dimension; the index tries are appended
+    // in the order of iteration, so that neighbouring index tries are adjacent in memory
+    LT_IndexTrie *tries[tn];
+    size_t tries_len[tn], tries_max_len[tn];
+    memset( tries, 0, sizeof( tries ) );
+    memset( tries_len, 0, sizeof( tries_len ) );
+    memset( tries_max_len, 0, sizeof( tries_max_len ) );
+
+    // Allocate array of offsets to the next index trie in each dimension, and whether they are set
+    size_t next[tn];
+    bool next_set[tn];
     memset( next, 0, sizeof( next ) );
+    memset( next_set, 0, sizeof( next_set ) );
 
     // Allocate array containing sequential indices for every dimension
     UINT8 indx[tn];
@@ -2342,26 +2653,28 @@ LatticeTilingLocator *XLALCreateLatticeTilingLocator(
     // Iterate over all points; XLALNextLatticeTilingPoint() returns the index
     // (offset from 1) of the lowest dimension where the current point has changed
     xlalErrno = 0;
+    int errnum = 0;
     int changed_ti_p1;
-    while ( ( changed_ti_p1 = XLALNextLatticeTilingPoint( itr, NULL ) ) > 0 ) {
+    while ( errnum == 0 && ( changed_ti_p1 = XLALNextLatticeTilingPoint( itr, NULL ) ) > 0 ) {
       const size_t changed_ti = changed_ti_p1 - 1;
 
       // Iterate over all dimensions where the current point has changed
-      for ( size_t tj = changed_ti; tj < tn; ++tj ) {
+      for ( size_t tj = changed_ti; tj < tn && errnum == 0; ++tj ) {
 
-        // If next index trie pointer is NULL, it needs to be initialised
-        if ( next[tj] == NULL ) {
+        // If next index trie offset is not set, it needs to be initialised
+        if ( !next_set[tj] ) {
 
-          // Get a pointer to the index trie which needs to be built:
-          // - if 'tj' is non-zero, we should use the struct pointed to by 'next' in the lower dimension
+          // Get the index trie which needs to be built:
+          // - if 'tj' is non-zero, we should use the index trie at offset 'next' in the lower dimension
           // - otherwise, this is the first point of the tiling, so initialise the base index trie
-          LT_IndexTrie *trie = NULL;
+          size_t trie_offset = 0;
           if ( tj > 0 ) {
-            trie = next[tj - 1];
-          } else {
-            trie = loc->index_trie = XLALCalloc( 1, sizeof( *trie ) );
-            XLAL_CHECK_NULL( loc->index_trie != NULL, XLAL_ENOMEM );
+            trie_offset = next[tj - 1];
+          } else if ( tries_len[0] == 0 && LT_AppendIndexTries( &tries[0], &tries_len[0], &tries_max_len[0], 1, &trie_offset ) != XLAL_SUCCESS ) {
+            errnum = XLAL_EFUNC;
+            break;
           }
+          LT_IndexTrie *trie = &tries[tj][trie_offset];
 
           // Save the lower and upper integer point bounds
           trie->int_lower = itr->int_lower[tj];
@@ -2372,14 +2685,19 @@ LatticeTilingLocator *XLALCreateLatticeTilingLocator(
 
           if ( tj + 1 < tn ) {
 
-            // If we are below the highest dimension, allocate a new
+            // If we are below the highest dimension, append a new
             // array of index tries for the next highest dimension
             const size_t next_length = trie->int_upper - trie->int_lower + 1;
-            trie->next = XLALCalloc( next_length, sizeof( *trie->next ) );
-            XLAL_CHECK_NULL( trie->next != NULL, XLAL_ENOMEM );
+            size_t next_offset = 0;
+            if ( LT_AppendIndexTries( &tries[tj + 1], &tries_len[tj + 1], &tries_max_len[tj + 1], next_length, &next_offset ) != XLAL_SUCCESS ) {
+              errnum = XLAL_EFUNC;
+              break;
+            }
+            trie->next = next_offset;
 
             // Point 'next[tj]' to this array, for higher dimensions to use
-            next[tj] = trie->next;
+            next[tj] = next_offset;
+            next_set[tj] = true;
 
           }
 
@@ -2390,10 +2708,10 @@ LatticeTilingLocator *XLALCreateLatticeTilingLocator(
 
         }
 
-        // If we are below the highest dimension, set 'next' in the next highest
-        // dimension to NULL, so that on the next loop a new array will be created
+        // If we are below the highest dimension, unset 'next' in the next highest
+        // dimension, so that on the next loop a new array will be created
         if ( tj + 1 < tn ) {
-          next[tj + 1] = NULL;
+          next_set[tj + 1] = false;
         }
 
       }
@@ -2405,6 +2723,35 @@ LatticeTilingLocator *XLALCreateLatticeTilingLocator(
       indx[tn - 1] += itr->int_upper[tn - 1] - itr->int_lower[tn - 1];
 
     }
+
+    // Concatenate index tries in each dimension into a single contiguous array, and
+    // convert offsets of index tries in the next highest dimension to offsets in this array
+    if ( errnum == 0 && xlalErrno == 0 ) {
+      size_t tries_offset[tn];
+      loc->index_trie_len = 0;
+      for ( size_t tj = 0; tj < tn; ++tj ) {
+        tries_offset[tj] = loc->index_trie_len;
+        loc->index_trie_len += tries_len[tj];
+      }
+      loc->index_trie = XLALMalloc( loc->index_trie_len * sizeof( *loc->index_trie ) );
+      if ( loc->index_trie == NULL ) {
+        errnum = XLAL_ENOMEM;
+      } else {
+        for ( size_t tj = 0; tj < tn; ++tj ) {
+          LT_IndexTrie *trie = &loc->index_trie[tries_offset[tj]];
+          memcpy( trie, tries[tj], tries_len[tj] * sizeof( *trie ) );
+          if ( tj + 1 < tn ) {
+            for ( size_t k = 0; k < tries_len[tj]; ++k ) {
+              trie[k].next += tries_offset[tj + 1];
+            }
+          }
+        }
+      }
+    }
+    for ( size_t tj = 0; tj < tn; ++tj ) {
+      XLALFree( tries[tj] );
+    }
+    XLAL_CHECK_NULL( errnum == 0, errnum );
     XLAL_CHECK_NULL( xlalErrno == 0, XLAL_EFUNC );
 
     // Cleanup
@@ -2416,15 +2763,118 @@ LatticeTilingLocator *XLALCreateLatticeTilingLocator(
 
 }
 
+int XLALSaveLatticeTilingLocator(
+  const LatticeTilingLocator *loc,
+  FITSFile *file,
+  const char *name
+  )
+{
+
+  // Check input
+  XLAL_CHECK( loc != NULL, XLAL_EFAULT );
+  XLAL_CHECK( file != NULL, XLAL_EFAULT );
+  XLAL_CHECK( name != NULL, XLAL_EFAULT );
+
+  // Open FITS table for writing
+  XLAL_CHECK( XLALFITSTableOpenWrite( file, name, "serialised lattice tiling locator" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( LT_InitFITSIndexTrieTable( file ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Write index tries to table
+  for ( size_t k = 0; k < loc->index_trie_len; ++k ) {
+    XLAL_CHECK( XLALFITSTableWriteRow( file, &loc->index_trie[k] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Write tiling properties
+  {
+    UINT4 ndim = loc->ndim;
+    XLAL_CHECK( XLALFITSHeaderWriteUINT4( file, "ndim", ndim, "number of parameter-space dimensions" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  } {
+    UINT4 tiled_ndim = loc->tiled_ndim;
+    XLAL_CHECK( XLALFITSHeaderWriteUINT4( file, "tiled_ndim", tiled_ndim, "number of tiled parameter-space dimensions" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  } {
+    UINT4 lattice = loc->tiling->lattice;
+    XLAL_CHECK( XLALFITSHeaderWriteUINT4( file, "lattice", lattice, "type of lattice to generate tiling with" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  } {
+    INT4 checksum = 0;
+    XLAL_CHECK( LT_LocatorChecksum( loc->tiling, &checksum ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALFITSHeaderWriteINT4( file, "checksum", checksum, "checksum of parameter-space bounds and lattice" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+LatticeTilingLocator *XLALRestoreLatticeTilingLocator(
+  const LatticeTiling *tiling,
+  FITSFile *file,
+  const char *name
+  )
+{
+
+  // Check input
+  XLAL_CHECK_NULL( tiling != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL( tiling->lattice < TILING_LATTICE_MAX, XLAL_EINVAL );
+  XLAL_CHECK_NULL( file != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL( name != NULL, XLAL_EFAULT );
+
+  // Open FITS table for reading
+  UINT8 nrows = 0;
+  XLAL_CHECK_NULL( XLALFITSTableOpenRead( file, name, &nrows ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_NULL( LT_InitFITSIndexTrieTable( file ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Read and check tiling properties
+  {
+    UINT4 ndim;
+    XLAL_CHECK_NULL( XLALFITSHeaderReadUINT4( file, "ndim", &ndim ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_NULL( ndim == tiling->ndim, XLAL_EIO, "Could not restore locator; invalid HDU '%s'", name );
+  } {
+    UINT4 tiled_ndim;
+    XLAL_CHECK_NULL( XLALFITSHeaderReadUINT4( file, "tiled_ndim", &tiled_ndim ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_NULL( tiled_ndim == tiling->tiled_ndim, XLAL_EIO, "Could not restore locator; invalid HDU '%s'", name );
+    XLAL_CHECK_NULL( ( nrows > 0 ) == ( tiled_ndim > 0 ), XLAL_EIO, "Could not restore locator; invalid HDU '%s'", name );
+  } {
+    UINT4 lattice;
+    XLAL_CHECK_NULL( XLALFITSHeaderReadUINT4( file, "lattice", &lattice ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_NULL( lattice == tiling->lattice, XLAL_EIO, "Could not restore locator; invalid HDU '%s'", name );
+  } {
+    INT4 checksum, checksum_ref = 0;
+    XLAL_CHECK_NULL( XLALFITSHeaderReadINT4( file, "checksum", &checksum ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_NULL( LT_LocatorChecksum( tiling, &checksum_ref ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_NULL( checksum == checksum_ref, XLAL_EIO, "Could not restore locator; invalid HDU '%s'", name );
+  }
+
+  // Allocate memory
+  LatticeTilingLocator *loc = XLALCalloc( 1, sizeof( *loc ) );
+  XLAL_CHECK_NULL( loc != NULL, XLAL_ENOMEM );
+
+  // Store reference to lattice tiling
+  loc->tiling = tiling;
+
+  // Set fields
+  loc->ndim = tiling->ndim;
+  loc->tiled_ndim = tiling->tiled_ndim;
+
+  // Read index tries from table
+  if ( nrows > 0 ) {
+    loc->index_trie_len = nrows;
+    loc->index_trie = XLALMalloc( loc->index_trie_len * sizeof( *loc->index_trie ) );
+    XLAL_CHECK_NULL( loc->index_trie != NULL, XLAL_ENOMEM );
+    for ( size_t k = 0; k < loc->index_trie_len; ++k ) {
+      XLAL_CHECK_NULL( XLALFITSTableReadRow( file, &loc->index_trie[k], &nrows ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+    XLAL_CHECK_NULL( LT_CheckIndexTrie( loc->index_trie, loc->index_trie_len, loc->index_trie, 0, loc->tiled_ndim ) == XLAL_SUCCESS, XLAL_EIO, "Could not restore locator; invalid HDU '%s'", name );
+  }
+
+  return loc;
+
+}
+
 void XLALDestroyLatticeTilingLocator(
   LatticeTilingLocator *loc
   )
 {
   if ( loc ) {
-    if ( loc->index_trie != NULL ) {
-      LT_FreeIndexTrie( loc->index_trie );
-      XLALFree( loc->index_trie );
-    }
+    XLALFree( loc->index_trie );
     XLALFree( loc );
   }
 }
@@ -2611,7 +3061,7 @@ int XLALPrintLatticeTilingIndexTrie(
 
   // Print index trie
   INT4 int_lower[tn];
-  LT_PrintIndexTrie( loc->tiling, loc->index_trie, 0, file, int_lower );
+  LT_PrintIndexTrie( loc->tiling, loc->index_trie, loc->index_trie, 0, file, int_lower );
 
   return XLAL_SUCCESS;
 
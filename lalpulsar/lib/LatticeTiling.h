@@ -382,6 +382,19 @@ int XLALSetLatticeTilingAlternatingIterator(
   const bool alternating                ///< [in] If true, set alternating iterator
   );
 
+///
+/// Restrict the lattice tiling iterator to part \c part of \c num_parts consecutive partitions of the
+/// lattice tiling, each containing (to within one point) the same number of points. The iterator then
+/// returns only the points with indexes in its partition, in the same order as an unpartitioned iterator,
+/// so that (for example) each of \c num_parts threads or MPI ranks can iterate over a separate partition
+/// without enumerating the full lattice tiling.
+///
+int XLALSetLatticeTilingIteratorPartition(
+  LatticeTilingIterator *itr,           ///< [in] Lattice tiling iterator
+  const UINT4 num_parts,                ///< [in] Number of partitions of the lattice tiling
+  const UINT4 part                      ///< [in] Index of partition to iterate over
+  );
+
 ///
 /// Reset an iterator to the beginning of a lattice tiling.
 ///
@@ -465,6 +478,29 @@ LatticeTilingLocator *XLALCreateLatticeTilingLocator(
   const LatticeTiling *tiling           ///< [in] Lattice tiling
   );
 
+///
+/// Save the internal index trie of a lattice tiling locator to a FITS file.
+///
+int XLALSaveLatticeTilingLocator(
+  const LatticeTilingLocator *loc,      ///< [in] Lattice tiling locator
+  FITSFile *file,                       ///< [in] FITS file to save locator to
+  const char *name                      ///< [in] FITS HDU to save locator to
+  );
+
+///
+/// Restore a lattice tiling locator from a FITS file, instead of rebuilding its index trie with
+/// XLALCreateLatticeTilingLocator(). The lattice tiling must have been set up with the same
+/// parameter-space bounds, lattice and metric as the tiling used to create the saved locator.
+///
+#ifdef SWIG // SWIG interface directives
+SWIGLAL( RETURN_OWNED_BY_1ST_ARG( int, XLALRestoreLatticeTilingLocator ) );
+#endif
+LatticeTilingLocator *XLALRestoreLatticeTilingLocator(
+  const LatticeTiling *tiling,          ///< [in] Lattice tiling
+  FITSFile *file,                       ///< [in] FITS file to restore locator from
+  const char *name                      ///< [in] FITS HDU to restore locator from
+  );
+
 ///
 /// Destroy a lattice tiling locator.
 ///
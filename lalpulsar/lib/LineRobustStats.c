@@ -21,11 +21,13 @@
 
 //---------- INCLUDES ----------
 #include <lal/UserInputParse.h>
+#include <lal/VectorMath.h>
 
 #include <lal/LineRobustStats.h>
 
 
 //---------- local DEFINES ----------
+#define BSGL_BLOCK_LENGTH 256	// number of bins processed at a time by the vector functions
 
 //----- Macros -----
 
@@ -179,37 +181,64 @@ XLALVectorComputeBSGL ( REAL4 *outBSGL,					//!< [out] pre-allocated output vect
 {
   XLAL_CHECK ( (outBSGL != NULL) && (twoF != NULL) && (twoFPerDet != NULL) && (setup != NULL) && (len >= 1), XLAL_EINVAL );
 
-  for ( UINT4 i = 0; i < len; i ++ )
+  // work through the input vectors in blocks, looping over detectors on the outside
+  // so that the inner loops over bins can be vectorised
+  REAL4 FpMax[BSGL_BLOCK_LENGTH];	// log of maximal denominator sum-term
+  REAL4 expTerm[BSGL_BLOCK_LENGTH];
+  REAL4 extraSum[BSGL_BLOCK_LENGTH];
+  for ( UINT4 i0 = 0; i0 < len; i0 += BSGL_BLOCK_LENGTH )
     {
-      // --------------------------------------------------
-      REAL4 FpMax = setup->C; // used to keep track of log of maximal denominator sum-term
+      const UINT4 n = ( len - i0 < BSGL_BLOCK_LENGTH ) ? ( len - i0 ) : BSGL_BLOCK_LENGTH;
 
-      // per-detector contributions, including line weights
-      REAL4 Xterm[PULSAR_MAX_DETECTORS];
-      for ( UINT4 X=0; X < setup->numDetectors; X ++ )
+      // FpMax = max [ C, { FX + ln(pLtL_X) } ] = max [ C, { FX + ln(pL_X) } ] as ptL=0
+      for ( UINT4 j = 0; j < n; j ++ )
         {
-          Xterm[X] = 0.5f * twoFPerDet[X][i] + setup->ln_pLtL_X[X]; 	// FX + ln(pLtL_X) = FX + ln(pL_X) as ptL=0
-          FpMax = fmaxf ( FpMax, Xterm[X] );
+          FpMax[j] = setup->C;
+        }
+      for ( UINT4 X = 0; X < setup->numDetectors; X ++ )
+        {
+          const REAL4 *twoFX = twoFPerDet[X] + i0;
+          const REAL4 ln_pLX = setup->ln_pLtL_X[X];
+          for ( UINT4 j = 0; j < n; j ++ )
+            {
+              FpMax[j] = fmaxf ( FpMax[j], 0.5f * twoFX[j] + ln_pLX );
+            }
         }
 
-      outBSGL[i] = 0.5f * twoF[i] - FpMax; // approximate result without log-correction term
+      REAL4 *out = outBSGL + i0;
+      for ( UINT4 j = 0; j < n; j ++ )
+        {
+          out[j] = 0.5f * twoF[i0 + j] - FpMax[j]; // approximate result without log-correction term
+        }
 
-      if ( setup->useLogCorrection ) 	// FIXME: indicate to gcc that this is the unlikely branch
+      if ( setup->useLogCorrection )
         {
-          // if useLogCorrection: extraSum = e^(Fstar0sc +ln(1-pL) - FpMax) + sum_X e^( Xterm[X] - FpMax )
-          REAL4 extraSum = expf ( setup->C  - FpMax );
+          // if useLogCorrection: extraSum = e^(Fstar0sc +ln(1-pL) - FpMax) + sum_X e^( FX + ln(pL_X) - FpMax )
+          for ( UINT4 j = 0; j < n; j ++ )
+            {
+              expTerm[j] = setup->C - FpMax[j];
+            }
+          XLAL_CHECK ( XLALVectorExpREAL4 ( extraSum, expTerm, n ) == XLAL_SUCCESS, XLAL_EFUNC );
 
           // ... and add all FX-contributions
-          for ( UINT4 X = 0; X < setup->numDetectors; X++ )
+          for ( UINT4 X = 0; X < setup->numDetectors; X ++ )
             {
-              extraSum += expf ( Xterm[X] - FpMax );
+              const REAL4 *twoFX = twoFPerDet[X] + i0;
+              const REAL4 ln_pLX = setup->ln_pLtL_X[X];
+              for ( UINT4 j = 0; j < n; j ++ )
+                {
+                  expTerm[j] = 0.5f * twoFX[j] + ln_pLX - FpMax[j];
+                }
+              XLAL_CHECK ( XLALVectorExpREAL4 ( expTerm, expTerm, n ) == XLAL_SUCCESS, XLAL_EFUNC );
+              XLAL_CHECK ( XLALVectorAddREAL4 ( extraSum, extraSum, expTerm, n ) == XLAL_SUCCESS, XLAL_EFUNC );
             }
-          outBSGL[i] -= logf ( extraSum ); // F - FpMax - ln( ... )
+          XLAL_CHECK ( XLALVectorLogREAL4 ( extraSum, extraSum, n ) == XLAL_SUCCESS, XLAL_EFUNC );
+          XLAL_CHECK ( XLALVectorSubREAL4 ( out, out, extraSum, n ) == XLAL_SUCCESS, XLAL_EFUNC ); // F - FpMax - ln( ... )
         } // if useLogCorrection
 
-      outBSGL[i] *= LAL_LOG10E; // return log10(B_SGL)
+      XLAL_CHECK ( XLALVectorScaleREAL4 ( out, LAL_LOG10E, out, n ) == XLAL_SUCCESS, XLAL_EFUNC ); // return log10(B_SGL)
 
-    } // for i < len
+    } // for i0 < len
 
   return XLAL_SUCCESS;
 
@@ -248,22 +277,23 @@ XLALVectorComputeGLtLDenominator ( REAL4 *outDenom,					//!< [out] pre-allocated
 
   for ( UINT4 i = 0; i < len; i ++ )
     {
-      REAL4 FpMax = setup->C; // used to keep track of log of maximal denominator sum-term
+      outDenom[i] = setup->C; // used to keep track of log of maximal denominator sum-term
+    }
 
-      // per-detector contributions, including line weights
-      REAL4 Xterm[PULSAR_MAX_DETECTORS];
-      REAL4 Xlterm[PULSAR_MAX_DETECTORS];
-      for ( UINT4 X=0; X < setup->numDetectors; X ++ )
+  // per-detector contributions, including line weights; loop over detectors on the outside
+  // so that the inner loops over bins can be vectorised
+  for ( UINT4 X = 0; X < setup->numDetectors; X ++ )
+    {
+      const REAL4 ln_pLX = setup->ln_pLtL_X[X] - (REAL4)LAL_LN2; //  ln(pLX) = ln(pLtLX/2), as we assume pLX=ptLX, so pLtLX = 2*pLX
+      const REAL4 ln_ptLXl = setup->perSegTerm + ln_pLX;	// assuming equal odds between segments: ptL_X = pL_X/Nseg
+      const REAL4 *twoFX = twoFPerDet[X];
+      const REAL4 *maxTwoFXl = maxTwoFSegPerDet[X];
+      for ( UINT4 i = 0; i < len; i ++ )
         {
-          REAL4 ln_pLX = setup->ln_pLtL_X[X] - (REAL4)LAL_LN2; //  ln(pLX) = ln(pLtLX/2), as we assume pLX=ptLX, so pLtLX = 2*pLX
-          Xterm[X] = 0.5f * twoFPerDet[X][i] + ln_pLX; 	// FX + ln(pLX)
-          FpMax = fmaxf ( FpMax, Xterm[X] );
-          Xlterm[X] = 0.5f * maxTwoFSegPerDet[X][i] + setup->perSegTerm + ln_pLX; // assuming equal odds between segments: ptL_X = pL_X/Nseg
-          FpMax = fmaxf ( FpMax, Xlterm[X] );
-        } // for X < numDetectors
-
-      outDenom[i] = FpMax;
-    } // for i < len
+          outDenom[i] = fmaxf ( outDenom[i], 0.5f * twoFX[i] + ln_pLX );		// FX + ln(pLX)
+          outDenom[i] = fmaxf ( outDenom[i], 0.5f * maxTwoFXl[i] + ln_ptLXl );	// max_l FXl + ln(ptLXl)
+        }
+    } // for X < numDetectors
 
   return XLAL_SUCCESS;
 
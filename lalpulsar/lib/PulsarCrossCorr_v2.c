@@ -1163,6 +1163,243 @@ int XLALCalculatePulsarCrossCorrStatistic
   return XLAL_SUCCESS;
 }
 
+/* comparison function used to sort SFT pairs by ( sftNum1, sftNum2 ) */
+static int
+compareSFTPairTableEntries ( const void *a, const void *b )
+{
+  const SFTPairTableEntry *pa = (const SFTPairTableEntry *) a;
+  const SFTPairTableEntry *pb = (const SFTPairTableEntry *) b;
+  if ( pa->sftNum1 != pb->sftNum1 )
+    return ( pa->sftNum1 < pb->sftNum1 ) ? -1 : 1;
+  if ( pa->sftNum2 != pb->sftNum2 )
+    return ( pa->sftNum2 < pb->sftNum2 ) ? -1 : 1;
+  return 0;
+}
+
+/**
+ * Construct a structure-of-arrays table of SFT pairs, sorted by the
+ * ordinal numbers of the first and then the second SFT in each pair,
+ * together with the curly-G amplitude of each pair.  The table does not
+ * depend on the signal template and can be reused for every frequency
+ * and orbital template in a search.
+ */
+int XLALCreateSFTPairTable
+(
+ SFTPairTable         **pairTable, /**< [out] sorted table of SFT pairs */
+ const SFTPairIndexList *sftPairs, /**< [in] flat list of SFT pairs */
+ const SFTIndexList   *sftIndices, /**< [in] flat list of SFTs */
+ const REAL8Vector     *curlyGAmp  /**< [in] amplitude of curly G for each pair */
+ )
+{
+  XLAL_CHECK ( pairTable != NULL && *pairTable == NULL, XLAL_EINVAL );
+  XLAL_CHECK ( sftPairs != NULL && sftIndices != NULL && curlyGAmp != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( curlyGAmp->length == sftPairs->length, XLAL_EBADLEN, "Lengths of pair-indexed lists don't match!" );
+
+  const UINT4 numPairs = sftPairs->length;
+  const UINT4 numSFTs = sftIndices->length;
+
+  SFTPairTable *ret = XLALCalloc ( 1, sizeof ( *ret ) );
+  XLAL_CHECK ( ret != NULL, XLAL_ENOMEM );
+  ret->length = numPairs;
+  if ( numPairs == 0 ) {
+    *pairTable = ret;
+    return XLAL_SUCCESS;
+  }
+
+  SFTPairTableEntry *entries = XLALMalloc ( numPairs * sizeof ( *entries ) );
+  ret->sftNum1 = XLALMalloc ( numPairs * sizeof ( ret->sftNum1[0] ) );
+  ret->sftNum2 = XLALMalloc ( numPairs * sizeof ( ret->sftNum2[0] ) );
+  ret->curlyGAmp = XLALMalloc ( numPairs * sizeof ( ret->curlyGAmp[0] ) );
+  if ( entries == NULL || ret->sftNum1 == NULL || ret->sftNum2 == NULL || ret->curlyGAmp == NULL ) {
+    XLALFree ( entries );
+    XLALDestroySFTPairTable ( ret );
+    XLAL_ERROR ( XLAL_ENOMEM );
+  }
+
+  BOOLEAN sorted = TRUE;
+  for ( UINT4 alpha = 0; alpha < numPairs; alpha++ ) {
+    entries[alpha].sftNum1 = sftPairs->data[alpha].sftNum[0];
+    entries[alpha].sftNum2 = sftPairs->data[alpha].sftNum[1];
+    entries[alpha].curlyGAmp = curlyGAmp->data[alpha];
+    if ( entries[alpha].sftNum1 >= numSFTs || entries[alpha].sftNum2 >= numSFTs ) {
+      XLALFree ( entries );
+      XLALDestroySFTPairTable ( ret );
+      XLAL_ERROR ( XLAL_EINVAL, "SFT pair asked for SFT index off end of list:\n alpha=%"LAL_UINT4_FORMAT", sftNum1=%"LAL_UINT4_FORMAT", sftNum2=%"LAL_UINT4_FORMAT", numSFTs=%"LAL_UINT4_FORMAT"\n",
+                   alpha, sftPairs->data[alpha].sftNum[0], sftPairs->data[alpha].sftNum[1], numSFTs );
+    }
+    if ( alpha > 0 && compareSFTPairTableEntries ( &entries[alpha-1], &entries[alpha] ) > 0 ) {
+      sorted = FALSE;
+    }
+  }
+
+  /* pair lists from XLALCreateSFTPairIndexList() are already sorted */
+  if ( !sorted ) {
+    qsort ( entries, numPairs, sizeof ( *entries ), compareSFTPairTableEntries );
+  }
+
+  for ( UINT4 alpha = 0; alpha < numPairs; alpha++ ) {
+    ret->sftNum1[alpha] = entries[alpha].sftNum1;
+    ret->sftNum2[alpha] = entries[alpha].sftNum2;
+    ret->curlyGAmp[alpha] = entries[alpha].curlyGAmp;
+  }
+  XLALFree ( entries );
+
+  *pairTable = ret;
+  return XLAL_SUCCESS;
+
+} /* XLALCreateSFTPairTable() */
+
+/**
+ * Calculate the multi-bin cross-correlation statistic for a batch of
+ * templates in one pass over the SFT pairs.
+ *
+ * The double sum over bins in XLALCalculatePulsarCrossCorrStatistic()
+ * factorises into a product of per-SFT sums, since the alternating sign
+ * (-1)^(k1-k2) and the sinc factors separate.  These are computed once
+ * per SFT and template, so that each pair costs O(1) per template rather
+ * than O(numBins^2), and the innermost loop runs over contiguous
+ * template-indexed arrays.  Results agree with
+ * XLALCalculatePulsarCrossCorrStatistic() up to rounding.
+ */
+/* This assumes rectangular or nearly-rectangular windowing */
+int XLALCalculatePulsarCrossCorrStatisticBatch
+(
+ REAL8                                 *ccStat, /**< [out] cross-correlation statistic rho for each template */
+ REAL8                              *evSquared, /**< [out] (E[rho]/h0^2)^2 for each template */
+ UINT4                            numTemplates, /**< [in] number of templates in batch */
+ COMPLEX8Vector        *const *expSignalPhases, /**< [in] phase of signal for each SFT, for each template */
+ UINT4Vector                *const *lowestBins, /**< [in] bin index to start with for each SFT, for each template */
+ REAL8VectorSequence          *const *sincList, /**< [in] sinc factors for each SFT, for each template */
+ const SFTPairTable                 *pairTable, /**< [in] sorted table of SFT pairs */
+ const SFTIndexList                *sftIndices, /**< [in] flat list of SFTs */
+ const MultiSFTVector               *inputSFTs, /**< [in] SFT data */
+ const MultiNoiseWeights         *multiWeights, /**< [in] normalization factor S^-1 & weights for each SFT */
+ UINT4                                 numBins  /**< [in] number of frequency bins to be taken into calc */
+ )
+{
+  XLAL_CHECK ( ccStat != NULL && evSquared != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( expSignalPhases != NULL && lowestBins != NULL && sincList != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( pairTable != NULL && sftIndices != NULL && inputSFTs != NULL && multiWeights != NULL, XLAL_EFAULT );
+
+  const UINT4 numSFTs = sftIndices->length;
+  const UINT4 numPairs = pairTable->length;
+  for ( UINT4 t = 0; t < numTemplates; t++ ) {
+    XLAL_CHECK ( expSignalPhases[t]->length == numSFTs
+                 && lowestBins[t]->length == numSFTs
+                 && sincList[t]->length == numSFTs,
+                 XLAL_EBADLEN, "Lengths of SFT-indexed lists don't match for template %"LAL_UINT4_FORMAT"!", t );
+    ccStat[t] = 0.0;
+    evSquared[t] = 0.0;
+  }
+  if ( numTemplates == 0 || numPairs == 0 ) {
+    return XLAL_SUCCESS;
+  }
+
+  /* per-SFT, per-template factors: W = conj(phase) * sum_j (-1)^(k+j) sinc_j data_{k+j}, B = sum_j sinc_j^2 */
+  const size_t numFactors = ( (size_t) numSFTs ) * numTemplates;
+  REAL8 *Wre = XLALCalloc ( numFactors, sizeof ( *Wre ) );
+  REAL8 *Wim = XLALCalloc ( numFactors, sizeof ( *Wim ) );
+  REAL8 *B = XLALCalloc ( numFactors, sizeof ( *B ) );
+  REAL8 *nume = XLALCalloc ( numTemplates, sizeof ( *nume ) );
+  REAL8 *curlyGSqr = XLALCalloc ( numTemplates, sizeof ( *curlyGSqr ) );
+  CHAR *sftUsed = XLALCalloc ( numSFTs, sizeof ( *sftUsed ) );
+  int errnum = XLAL_SUCCESS;
+  if ( Wre == NULL || Wim == NULL || B == NULL || nume == NULL || curlyGSqr == NULL || sftUsed == NULL ) {
+    errnum = XLAL_ENOMEM;
+    goto cleanup;
+  }
+
+  /* only SFTs which appear in a pair contribute */
+  for ( UINT4 alpha = 0; alpha < numPairs; alpha++ ) {
+    if ( pairTable->sftNum1[alpha] >= numSFTs || pairTable->sftNum2[alpha] >= numSFTs ) {
+      XLALPrintError ( "%s: SFT pair asked for SFT index off end of list:\n alpha=%"LAL_UINT4_FORMAT", sftNum1=%"LAL_UINT4_FORMAT", sftNum2=%"LAL_UINT4_FORMAT", numSFTs=%"LAL_UINT4_FORMAT"\n",
+                       __func__, alpha, pairTable->sftNum1[alpha], pairTable->sftNum2[alpha], numSFTs );
+      errnum = XLAL_EINVAL;
+      goto cleanup;
+    }
+    sftUsed[pairTable->sftNum1[alpha]] = 1;
+    sftUsed[pairTable->sftNum2[alpha]] = 1;
+  }
+
+  for ( UINT4 sftNum = 0; sftNum < numSFTs; sftNum++ ) {
+    if ( !sftUsed[sftNum] ) {
+      continue;
+    }
+    const UINT4 detInd = sftIndices->data[sftNum].detInd;
+    const UINT4 sftInd = sftIndices->data[sftNum].sftInd;
+    if ( detInd >= inputSFTs->length || sftInd >= inputSFTs->data[detInd]->length ) {
+      XLALPrintError ( "%s: SFT asked for detector or SFT index off end of list:\n sftNum=%"LAL_UINT4_FORMAT", detInd=%"LAL_UINT4_FORMAT", sftInd=%"LAL_UINT4_FORMAT"\n",
+                       __func__, sftNum, detInd, sftInd );
+      errnum = XLAL_EINVAL;
+      goto cleanup;
+    }
+    const COMPLEX8 *dataArray = inputSFTs->data[detInd]->data[sftInd].data->data;
+    const UINT4 lenDataArray = inputSFTs->data[detInd]->data[sftInd].data->length;
+    for ( UINT4 t = 0; t < numTemplates; t++ ) {
+      const UINT4 lowestBin = lowestBins[t]->data[sftNum];
+      if ( lowestBin + numBins - 1 >= lenDataArray ) {
+        XLALPrintError ( "%s: Loop would run off end of array:\n lowestBin=%d, numBins=%d, len(dataArray)=%d\n",
+                         __func__, lowestBin, numBins, lenDataArray );
+        errnum = XLAL_EINVAL;
+        goto cleanup;
+      }
+      const REAL8 *sinc = sincList[t]->data + ( (size_t) sftNum ) * numBins;
+      REAL8 sign = ( lowestBin % 2 == 0 ) ? 1.0 : -1.0;
+      COMPLEX16 A = 0;
+      REAL8 BB = 0;
+      for ( UINT4 j = 0; j < numBins; j++ ) {
+        A += sign * sinc[j] * dataArray[lowestBin + j];
+        BB += SQUARE ( sinc[j] );
+        sign = -sign;
+      }
+      const COMPLEX16 W = conj ( expSignalPhases[t]->data[sftNum] ) * A;
+      const size_t idx = ( (size_t) sftNum ) * numTemplates + t;
+      Wre[idx] = creal ( W );
+      Wim[idx] = cimag ( W );
+      B[idx] = BB;
+    }
+  }
+
+  /* stream through the sorted pair table; inner loop is over contiguous templates */
+  for ( UINT4 alpha = 0; alpha < numPairs; alpha++ ) {
+    const REAL8 amp = pairTable->curlyGAmp[alpha];
+    const REAL8 ampSqr = SQUARE ( amp );
+    const size_t off1 = ( (size_t) pairTable->sftNum1[alpha] ) * numTemplates;
+    const size_t off2 = ( (size_t) pairTable->sftNum2[alpha] ) * numTemplates;
+    const REAL8 *restrict Wre1 = Wre + off1;
+    const REAL8 *restrict Wim1 = Wim + off1;
+    const REAL8 *restrict B1 = B + off1;
+    const REAL8 *restrict Wre2 = Wre + off2;
+    const REAL8 *restrict Wim2 = Wim + off2;
+    const REAL8 *restrict B2 = B + off2;
+    REAL8 *restrict n = nume;
+    REAL8 *restrict g = curlyGSqr;
+    for ( UINT4 t = 0; t < numTemplates; t++ ) {
+      n[t] += amp * ( Wre1[t] * Wre2[t] + Wim1[t] * Wim2[t] );
+      g[t] += ampSqr * B1[t] * B2[t];
+    }
+  }
+
+  for ( UINT4 t = 0; t < numTemplates; t++ ) {
+    if ( curlyGSqr[t] != 0.0 ) {
+      evSquared[t] = 8 * SQUARE(multiWeights->Sinv_Tsft) * curlyGSqr[t];
+      ccStat[t] = 4 * multiWeights->Sinv_Tsft * nume[t] / sqrt(evSquared[t]);
+    }
+  }
+
+cleanup:
+  XLALFree ( Wre );
+  XLALFree ( Wim );
+  XLALFree ( B );
+  XLALFree ( nume );
+  XLALFree ( curlyGSqr );
+  XLALFree ( sftUsed );
+  XLAL_CHECK ( errnum == XLAL_SUCCESS, errnum );
+
+  return XLAL_SUCCESS;
+
+} /* XLALCalculatePulsarCrossCorrStatisticBatch() */
+
 /** Calculate multi-bin cross-correlation statistic using resampling */
 /* This assumes rectangular or nearly-rectangular windowing */
 int XLALCalculatePulsarCrossCorrStatisticResamp
@@ -3151,6 +3388,28 @@ XLALDestroySFTPairIndexList ( SFTPairIndexList *sftPairs )
 
 } /* XLALDestroySFTPairIndexList() */
 
+/**
+ * Destroy an SFTPairTable structure.
+ * Note, this is "NULL-robust" in the sense that it will not crash
+ * on NULL-entries anywhere in this struct, so it can be used
+ * for failure-cleanup even on incomplete structs
+ */
+void
+XLALDestroySFTPairTable ( SFTPairTable *pairTable )
+{
+  if ( ! pairTable )
+    return;
+
+  XLALFree ( pairTable->sftNum1 );
+  XLALFree ( pairTable->sftNum2 );
+  XLALFree ( pairTable->curlyGAmp );
+
+  XLALFree ( pairTable );
+
+  return;
+
+} /* XLALDestroySFTPairTable() */
+
 void XLALDestroyResampSFTIndexList( ResampSFTIndexList *sftResampList )
 {
   if ( !sftResampList )
@@ -109,6 +109,26 @@ extern "C" {
   } SFTPairIndexList;
 
 
+/** Entry of an SFT pair table, used while sorting */
+  typedef struct tagSFTPairTableEntry {
+    UINT4 sftNum1; /**< ordinal number of first SFT */
+    UINT4 sftNum2; /**< ordinal number of second SFT */
+    REAL8 curlyGAmp; /**< amplitude of curly G for this pair */
+  } SFTPairTableEntry;
+
+/** Structure-of-arrays table of SFT pairs, sorted by (sftNum1, sftNum2) for streaming access */
+  typedef struct tagSFTPairTable {
+#ifdef SWIG /* SWIG interface directives */
+    SWIGLAL(ARRAY_1D(SFTPairTable, UINT4, sftNum1, UINT4, length));
+    SWIGLAL(ARRAY_1D(SFTPairTable, UINT4, sftNum2, UINT4, length));
+    SWIGLAL(ARRAY_1D(SFTPairTable, REAL8, curlyGAmp, UINT4, length));
+#endif /* SWIG */
+    UINT4 length; /**< number of SFT pairs */
+    UINT4 *sftNum1; /**< ordinal number of first SFT in each pair */
+    UINT4 *sftNum2; /**< ordinal number of second SFT in each pair */
+    REAL8 *curlyGAmp; /**< amplitude of curly G for each pair */
+  } SFTPairTable;
+
 /** Resampling Counter of matching SFTs for a given detector Y_K_X matching SFT K_X */
   typedef struct tagSFTCount {
     UINT4 detInd; /**< original vector index of detector Y */
@@ -367,6 +387,31 @@ int XLALCalculatePulsarCrossCorrStatistic
    )
   ;
 
+int XLALCreateSFTPairTable
+  (
+   SFTPairTable         **pairTable,
+   const SFTPairIndexList *sftPairs,
+   const SFTIndexList   *sftIndices,
+   const REAL8Vector     *curlyGAmp
+   )
+  ;
+
+int XLALCalculatePulsarCrossCorrStatisticBatch
+  (
+   REAL8                                 *ccStat,
+   REAL8                              *evSquared,
+   UINT4                            numTemplates,
+   COMPLEX8Vector        *const *expSignalPhases,
+   UINT4Vector                *const *lowestBins,
+   REAL8VectorSequence          *const *sincList,
+   const SFTPairTable                 *pairTable,
+   const SFTIndexList                *sftIndices,
+   const MultiSFTVector               *inputSFTs,
+   const MultiNoiseWeights         *multiWeights,
+   UINT4                                 numBins
+   )
+  ;
+
 int XLALCalculatePulsarCrossCorrStatisticResamp
   (
    REAL8Vector                             *_LAL_RESTRICT_ ccStatVector,
@@ -643,6 +688,8 @@ void XLALDestroySFTIndexList ( SFTIndexList *sftIndices );
 
 void XLALDestroySFTPairIndexList ( SFTPairIndexList *sftPairs );
 
+void XLALDestroySFTPairTable ( SFTPairTable *pairTable );
+
 void XLALDestroyResampSFTIndexList( ResampSFTIndexList *sftResampList );
 
 void XLALDestroyResampSFTMultiIndexList( ResampSFTMultiIndexList *sftResampMultiList );
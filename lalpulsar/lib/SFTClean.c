@@ -506,6 +506,147 @@ void LALCheckLines ( LALStatus           *status, /**< pointer to LALStatus stru
 }
 
 
+/*
+ * Number of normal deviates required by CleanCOMPLEX8SFTWithDeviates() to clean an SFT
+ */
+static INT4 CleanCOMPLEX8SFTNumDeviates( const SFTtype *sft, INT4 width, const LineNoiseInfo *lineInfo )
+{
+  const REAL8 tBase = 1.0/sft->deltaF;
+  INT4 sumBins = 0;
+  for (INT4 count = 0; count < lineInfo->nLines; count++)
+    {
+      INT4 tempSumBins;
+      tempSumBins = floor(tBase*lineInfo->leftWing[count]) + floor(tBase*lineInfo->rightWing[count]);
+      sumBins += tempSumBins < 2*width ? tempSumBins : 2*width;
+    }
+  return 2*(sumBins + lineInfo->nLines);
+}
+
+/*
+ * Clean an SFT given pre-generated normal deviates and a workspace of 2*window elements
+ * for noise floor estimation; does not allocate memory, and so may be called in parallel
+ * for different SFTs with the same list of lines
+ */
+static void CleanCOMPLEX8SFTWithDeviates( SFTtype *sft, INT4 width, INT4 window, const LineNoiseInfo *lineInfo,
+                                          REAL8 bias, const REAL4 *ranData, REAL8 *tempDataPow )
+{
+  INT4     nLines, count, leftCount, rightCount, lineBin, minBin, maxBin, k, tempk;
+  INT4     leftWingBins, rightWingBins, length;
+  REAL8    deltaF, f0, tBase;
+  REAL8    stdPow, medianPow;
+  const REAL8 *lineFreq=NULL;
+  const REAL8 *leftWing=NULL;
+  const REAL8 *rightWing=NULL;
+  COMPLEX8 *inData;
+  const REAL4 *randVal;
+
+  /* copy pointers from input */
+  nLines = lineInfo->nLines;
+  lineFreq = lineInfo->lineFreq;
+  leftWing = lineInfo->leftWing;
+  rightWing = lineInfo->rightWing;
+
+  length = sft->data->length;
+  deltaF = sft->deltaF;
+  tBase = 1.0/deltaF;
+  f0 = sft->f0;
+  minBin = lround(f0/deltaF);
+  maxBin = minBin + length - 1;
+
+  tempk = 0;
+  /* loop over the lines */
+  for (count = 0; count < nLines; count++){
+
+    /* find frequency bins for line frequency and wings */
+    lineBin = lround(tBase * lineFreq[count]);
+    leftWingBins = floor(tBase * leftWing[count]);
+    rightWingBins = floor(tBase * rightWing[count]);
+
+    /* check that central frequency of the line is within band of sft */
+    if ((lineBin >= minBin) && (lineBin <= maxBin)) {
+
+      /* cut wings if wider than width parameter */
+      if ( ( leftWingBins > width ) || ( rightWingBins > width) ) {
+        LogPrintf ( LOG_NORMAL, "%s: Cutting wings of line %d/%d from [-%d,+%d] to width=%d.\n", __func__, count, nLines, leftWingBins, rightWingBins, width );
+      }
+      leftWingBins = leftWingBins < width ? leftWingBins : width;
+      rightWingBins = rightWingBins < width ? rightWingBins : width;
+
+      /* estimate the sft power in "window" # of bins each side */
+      if ( 2*window > (maxBin - minBin) ) {
+        LogPrintf ( LOG_NORMAL, "%s: Window of +-%d bins around lineBin=%d does not fit within SFT range [%d,%d], noise floor estimation will be compromised.\n", __func__, window, lineBin, minBin, maxBin );
+      }
+      if ( ( window < leftWingBins) || ( window <= rightWingBins) ) {
+        LogPrintf ( LOG_NORMAL, "%s: Window of +-%d bins around lineBin=%d does not extend further than line wings [-%d,+%d], noise floor estimation will be compromised by the very same line that is supposed to be cleaned.\n", __func__, window, lineBin, leftWingBins, rightWingBins );
+      }
+      for (k = 0; k < window ; k++){
+	if (maxBin - lineBin - rightWingBins - k > 0)
+	  inData = sft->data->data + lineBin - minBin + rightWingBins + k + 1;
+	else
+	  inData = sft->data->data + length - 1;
+
+	tempDataPow[k] = (crealf(*inData))*(crealf(*inData)) + (cimagf(*inData))*(cimagf(*inData));
+
+	if (lineBin - minBin -leftWingBins - k > 0)
+	  inData = sft->data->data + lineBin - minBin - leftWingBins - k - 1;
+	else
+	  inData = sft->data->data;
+
+	tempDataPow[k+window] = (crealf(*inData))*(crealf(*inData)) + (cimagf(*inData))*(cimagf(*inData));
+      }
+
+      gsl_sort( tempDataPow, 1, 2*window);
+      medianPow = gsl_stats_median_from_sorted_data(tempDataPow, 1, 2*window);
+      stdPow = sqrt(medianPow/(2 * bias));
+
+      /* set sft value at central frequency to noise */
+      inData = sft->data->data + lineBin - minBin;
+
+      randVal = ranData + tempk;
+      *(inData) = crectf( stdPow * (*randVal), cimagf(*(inData)) );
+      tempk++;
+
+      randVal = ranData + tempk;
+      *(inData) = crectf( crealf(*(inData)), stdPow * (*randVal) );
+      tempk++;
+
+      /* now go left and set the left wing to noise */
+      /* make sure that we are always within the sft band */
+      /* and set bins to zero only if Wing width is smaller than "width" */
+	for (leftCount = 0; leftCount < leftWingBins; leftCount++){
+	  if ( (lineBin - minBin - leftCount > 0)){
+	    inData = sft->data->data + lineBin - minBin - leftCount - 1;
+
+	    randVal = ranData + tempk;
+	    *(inData) = crectf( stdPow * (*randVal), cimagf(*(inData)) );
+	    tempk++;
+
+	    randVal = ranData + tempk;
+	    *(inData) = crectf( crealf(*(inData)), stdPow * (*randVal) );
+	    tempk++;
+	  }
+	}
+
+      /* now go right making sure again to stay within the sft band */
+	for (rightCount = 0; rightCount < rightWingBins; rightCount++){
+	  if ( (maxBin - lineBin - rightCount > 0)){
+	    inData = sft->data->data + lineBin - minBin + rightCount + 1;
+
+	    randVal = ranData + tempk;
+	    *(inData) = crectf( stdPow * (*randVal), cimagf(*(inData)) );
+            tempk++;
+
+	    randVal = ranData + tempk;
+	    *(inData) = crectf( crealf(*(inData)), stdPow * (*randVal) );
+	    tempk++;
+	  }
+	}
+
+    }
+  } /* end loop over lines */
+}
+
+
 /**
  * Function for cleaning a SFT given a set of known spectral disturbances.
  * The algorithm is the following.  For each
@@ -593,28 +734,17 @@ void LALCleanCOMPLEX8SFT (LALStatus          *status,/**< pointer to LALStatus s
 {
   /* function to clean the SFT based on the line information read earlier */
 
-  INT4     nLines, count, leftCount, rightCount, lineBin, minBin, maxBin, k, tempk;
-  INT4     leftWingBins, rightWingBins, length, sumBins;
-  REAL8    deltaF, f0, tBase, bias;
-  REAL8    stdPow, medianPow;
+  INT4     length;
+  REAL8    bias;
   REAL8    *tempDataPow=NULL;
-  REAL8    *lineFreq=NULL;
-  REAL8    *leftWing=NULL;
-  REAL8    *rightWing=NULL;
-  COMPLEX8 *inData;
-  /* FILE *fp=NULL;
-  INT4 seed, ranCount;
-  RandomParams *randPar=NULL; */ /* 09/09/05 gam; randPar now a function argument */
-  static REAL4Vector *ranVector=NULL;
-  REAL4 *randVal;
+  REAL4Vector *ranVector=NULL;
   /* --------------------------------------------- */
   INITSTATUS(status);
   ATTATCHSTATUSPTR (status);
 
   /*   Make sure the arguments are not NULL: */
   ASSERT (sft,   status, SFTCLEANH_ENULL, SFTCLEANH_MSGENULL);
-  inData = sft->data->data;
-  ASSERT (inData, status, SFTCLEANH_ENULL, SFTCLEANH_MSGENULL);
+  ASSERT (sft->data->data, status, SFTCLEANH_ENULL, SFTCLEANH_MSGENULL);
   ASSERT (lineInfo, status, SFTCLEANH_ENULL, SFTCLEANH_MSGENULL);
   ASSERT (lineInfo->nLines, status, SFTCLEANH_EVAL, SFTCLEANH_MSGEVAL);
   ASSERT (lineInfo->lineFreq, status, SFTCLEANH_ENULL, SFTCLEANH_MSGENULL);
@@ -628,137 +758,15 @@ void LALCleanCOMPLEX8SFT (LALStatus          *status,/**< pointer to LALStatus s
   /* get the value of RngMedBias from the window size */
   TRY( LALRngMedBias( status->statusPtr, &bias, 2*window ), status );
 
-  /* copy pointers from input */
-  nLines = lineInfo->nLines;
-  lineFreq = lineInfo->lineFreq;
-  leftWing = lineInfo->leftWing;
-  rightWing = lineInfo->rightWing;
-
-  deltaF = sft->deltaF;
-  tBase = 1.0/deltaF;
-  f0 = sft->f0;
-  minBin = lround(f0/deltaF);
-  maxBin = minBin + length - 1;
-
   /* allocate memory for storing sft power */
   tempDataPow = LALMalloc(2*window*sizeof(REAL8));
 
-  /* 09/09/05 gam; randPar now a function argument */
-  /* fp=fopen("/dev/urandom", "r");
-  ASSERT(fp, status, SFTCLEANH_EFILE, SFTCLEANH_MSGEFILE);
-
-  ranCount = fread(&seed, sizeof(seed), 1, fp);
-  ASSERT(ranCount==1, status, SFTCLEANH_EREAD, SFTCLEANH_MSGEREAD);
-
-  fclose(fp); */
-
-  /* calculate total number of bins to see how many random numbers must be generated */
-  sumBins = 0;
-  for (count = 0; count < nLines; count++)
-    {
-      {
-	INT4 tempSumBins;
-	tempSumBins = floor(tBase*leftWing[count]) + floor(tBase*rightWing[count]);
-	sumBins += tempSumBins < 2*width ? tempSumBins : 2*width;
-      }
-    }
-
-  /* TRY ( LALCreateRandomParams (status->statusPtr, &randPar, seed), status); */ /* 09/09/05 gam; randPar now a function argument */
-  TRY ( LALCreateVector (status->statusPtr, &ranVector, 2*(sumBins + nLines)), status);
+  /* generate as many random numbers as needed for the bins to be cleaned */
+  TRY ( LALCreateVector (status->statusPtr, &ranVector, CleanCOMPLEX8SFTNumDeviates(sft, width, lineInfo)), status);
   TRY ( LALNormalDeviates (status->statusPtr, ranVector, randPar), status);
-  /* TRY ( LALDestroyRandomParams (status->statusPtr, &randPar), status);  */ /* 09/09/05 gam; randPar now a function argument */
-
-  tempk = 0;
-  /* loop over the lines */
-  for (count = 0; count < nLines; count++){
-
-    /* find frequency bins for line frequency and wings */
-    lineBin = lround(tBase * lineFreq[count]);
-    leftWingBins = floor(tBase * leftWing[count]);
-    rightWingBins = floor(tBase * rightWing[count]);
-
-    /* check that central frequency of the line is within band of sft */
-    if ((lineBin >= minBin) && (lineBin <= maxBin)) {
-
-      /* cut wings if wider than width parameter */
-      if ( ( leftWingBins > width ) || ( rightWingBins > width) ) {
-        LogPrintf ( LOG_NORMAL, "%s: Cutting wings of line %d/%d from [-%d,+%d] to width=%d.\n", __func__, count, nLines, leftWingBins, rightWingBins, width );
-      }
-      leftWingBins = leftWingBins < width ? leftWingBins : width;
-      rightWingBins = rightWingBins < width ? rightWingBins : width;
-
-      /* estimate the sft power in "window" # of bins each side */
-      if ( 2*window > (maxBin - minBin) ) {
-        LogPrintf ( LOG_NORMAL, "%s: Window of +-%d bins around lineBin=%d does not fit within SFT range [%d,%d], noise floor estimation will be compromised.\n", __func__, window, lineBin, minBin, maxBin );
-      }
-      if ( ( window < leftWingBins) || ( window <= rightWingBins) ) {
-        LogPrintf ( LOG_NORMAL, "%s: Window of +-%d bins around lineBin=%d does not extend further than line wings [-%d,+%d], noise floor estimation will be compromised by the very same line that is supposed to be cleaned.\n", __func__, window, lineBin, leftWingBins, rightWingBins );
-      }
-      for (k = 0; k < window ; k++){
-	if (maxBin - lineBin - rightWingBins - k > 0)
-	  inData = sft->data->data + lineBin - minBin + rightWingBins + k + 1;
-	else
-	  inData = sft->data->data + length - 1;
-
-	tempDataPow[k] = (crealf(*inData))*(crealf(*inData)) + (cimagf(*inData))*(cimagf(*inData));
-
-	if (lineBin - minBin -leftWingBins - k > 0)
-	  inData = sft->data->data + lineBin - minBin - leftWingBins - k - 1;
-	else
-	  inData = sft->data->data;
-
-	tempDataPow[k+window] = (crealf(*inData))*(crealf(*inData)) + (cimagf(*inData))*(cimagf(*inData));
-      }
-
-      gsl_sort( tempDataPow, 1, 2*window);
-      medianPow = gsl_stats_median_from_sorted_data(tempDataPow, 1, 2*window);
-      stdPow = sqrt(medianPow/(2 * bias));
-
-      /* set sft value at central frequency to noise */
-      inData = sft->data->data + lineBin - minBin;
-
-      randVal = ranVector->data + tempk;
-      *(inData) = crectf( stdPow * (*randVal), cimagf(*(inData)) );
-      tempk++;
-
-      randVal = ranVector->data + tempk;
-      *(inData) = crectf( crealf(*(inData)), stdPow * (*randVal) );
-      tempk++;
-
-      /* now go left and set the left wing to noise */
-      /* make sure that we are always within the sft band */
-      /* and set bins to zero only if Wing width is smaller than "width" */
-	for (leftCount = 0; leftCount < leftWingBins; leftCount++){
-	  if ( (lineBin - minBin - leftCount > 0)){
-	    inData = sft->data->data + lineBin - minBin - leftCount - 1;
-
-	    randVal = ranVector->data + tempk;
-	    *(inData) = crectf( stdPow * (*randVal), cimagf(*(inData)) );
-	    tempk++;
-
-	    randVal = ranVector->data + tempk;
-	    *(inData) = crectf( crealf(*(inData)), stdPow * (*randVal) );
-	    tempk++;
-	  }
-	}
-
-      /* now go right making sure again to stay within the sft band */
-	for (rightCount = 0; rightCount < rightWingBins; rightCount++){
-	  if ( (maxBin - lineBin - rightCount > 0)){
-	    inData = sft->data->data + lineBin - minBin + rightCount + 1;
 
-	    randVal = ranVector->data + tempk;
-	    *(inData) = crectf( stdPow * (*randVal), cimagf(*(inData)) );
-            tempk++;
-
-	    randVal = ranVector->data + tempk;
-	    *(inData) = crectf( crealf(*(inData)), stdPow * (*randVal) );
-	    tempk++;
-	  }
-	}
-
-    }
-  } /* end loop over lines */
+  /* clean the sft */
+  CleanCOMPLEX8SFTWithDeviates(sft, width, window, lineInfo, bias, ranVector->data, tempDataPow);
 
   /* free memory */
   LALFree(tempDataPow);
@@ -773,8 +781,13 @@ void LALCleanCOMPLEX8SFT (LALStatus          *status,/**< pointer to LALStatus s
 
 
 /**
- * Function to clean a sft vector -- calls LALCleanCOMPLEX8SFT repeatedly for each
- * sft in vector
+ * Function to clean a sft vector -- gives the same results as calling LALCleanCOMPLEX8SFT
+ * repeatedly for each sft in vector.
+ *
+ * The random numbers for all SFTs are first generated in sequence from \a randPar,
+ * so that results do not depend on the number of threads. The SFTs are then cleaned
+ * in parallel (if compiled with OpenMP support), sharing the list of lines and a
+ * single workspace for noise floor estimation.
  */
 void LALCleanSFTVector (LALStatus       *status,   /**< pointer to LALStatus structure */
 			SFTVector       *sftVect,  /**< SFTVector to be cleaned */
@@ -785,6 +798,10 @@ void LALCleanSFTVector (LALStatus       *status,   /**< pointer to LALStatus str
 {
 
   UINT4 k;
+  REAL8 bias;
+  UINT4 *ranOffset=NULL;
+  REAL4 *ranData=NULL;
+  REAL8 *tempDataPow=NULL;
 
   INITSTATUS(status);
   ATTATCHSTATUSPTR (status);
@@ -800,11 +817,50 @@ void LALCleanSFTVector (LALStatus       *status,   /**< pointer to LALStatus str
   ASSERT (lineInfo->rightWing, status, SFTCLEANH_ENULL, SFTCLEANH_MSGENULL);
   ASSERT (window > 0, status, SFTCLEANH_EVAL, SFTCLEANH_MSGEVAL);
   ASSERT (width >= 0, status, SFTCLEANH_EVAL, SFTCLEANH_MSGEVAL);
+  for ( k = 0; k < sftVect->length; k++) {
+    ASSERT (sftVect->data[k].data, status, SFTCLEANH_ENULL, SFTCLEANH_MSGENULL);
+    ASSERT (sftVect->data[k].data->data, status, SFTCLEANH_ENULL, SFTCLEANH_MSGENULL);
+    ASSERT (sftVect->data[k].data->length > 0, status, SFTCLEANH_EHEADER, SFTCLEANH_MSGEVAL);
+  }
+
+  /* get the value of RngMedBias from the window size */
+  TRY( LALRngMedBias( status->statusPtr, &bias, 2*window ), status );
 
+  /* work out where the random numbers for each sft start */
+  ranOffset = LALMalloc((sftVect->length + 1)*sizeof(*ranOffset));
+  ASSERT (ranOffset, status, SFTCLEANH_ENULL, SFTCLEANH_MSGENULL);
+  ranOffset[0] = 0;
   for ( k = 0; k < sftVect->length; k++) {
-    TRY (LALCleanCOMPLEX8SFT (status->statusPtr, sftVect->data + k, width, window, lineInfo, randPar), status);
+    ranOffset[k+1] = ranOffset[k] + CleanCOMPLEX8SFTNumDeviates(sftVect->data + k, width, lineInfo);
+  }
+
+  /* allocate memory for random numbers, and for storing sft power of each sft */
+  ranData = LALMalloc(ranOffset[sftVect->length]*sizeof(*ranData));
+  tempDataPow = LALMalloc(sftVect->length*2*window*sizeof(*tempDataPow));
+  if ( (ranData == NULL) || (tempDataPow == NULL) ) {
+    LALFree(ranOffset);
+    if (ranData) LALFree(ranData);
+    if (tempDataPow) LALFree(tempDataPow);
+    ABORT (status, SFTCLEANH_ENULL, SFTCLEANH_MSGENULL);
   }
 
+  /* generate random numbers for each sft in sequence */
+  for ( k = 0; k < sftVect->length; k++) {
+    REAL4Vector ranVector = { .length = ranOffset[k+1] - ranOffset[k], .data = ranData + ranOffset[k] };
+    TRY ( LALNormalDeviates (status->statusPtr, &ranVector, randPar), status);
+  }
+
+  /* clean the sfts in parallel */
+#pragma omp parallel for schedule(dynamic,1)
+  for ( UINT4 j = 0; j < sftVect->length; j++) {
+    CleanCOMPLEX8SFTWithDeviates(sftVect->data + j, width, window, lineInfo, bias, ranData + ranOffset[j], tempDataPow + j*2*window);
+  }
+
+  /* free memory */
+  LALFree(ranOffset);
+  LALFree(ranData);
+  LALFree(tempDataPow);
+
   DETATCHSTATUSPTR (status);
   /* normal exit */
   RETURN (status);
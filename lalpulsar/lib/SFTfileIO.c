@@ -36,6 +36,7 @@
  */
 
 /*---------- INCLUDES ----------*/
+#include <config.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <errno.h>
@@ -49,6 +50,11 @@
 #include <io.h>
 #endif
 
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_MMAP)
+#include <sys/mman.h>
+#define SFTFILEIO_USE_MMAP 1	/* XLALLoadSFTs() slices SFT bins directly from memory-mapped files */
+#endif
+
 #include <lal/LALStdio.h>
 #include <lal/LALString.h>
 #include <lal/FileIO.h>
@@ -92,6 +98,8 @@ struct tagSFTLocator
 {
   CHAR *fname;		/* name of file containing this SFT */
   long offset;		/* SFT-offset with respect to a merged-SFT */
+  long dataOffset;	/* offset of first frequency-bin of this SFT with respect to start of file */
+  BOOLEAN swapEndian;	/* whether SFT data needs to be endian-swapped on reading */
   UINT4 isft;           /* index of SFT this locator belongs to, used only in XLALLoadSFTs() */
 };
 
@@ -180,6 +188,11 @@ static BOOLEAN timestamp_in_list( LIGOTimeGPS timestamp, LIGOTimeGPSVector *list
 static long get_file_len ( FILE *fp );
 
 static FILE * fopen_SFTLocator ( const struct tagSFTLocator *locator );
+static int find_sfts_in_file ( SFTCatalog **fileCatalog, const CHAR *fname, const SFTConstraints *constraints );
+#ifdef SFTFILEIO_USE_MMAP
+static void * mmap_sft_file ( const CHAR *fname, size_t *mapLen );
+static UINT4 slice_sft_bins_from_map ( SFTtype *ret, const COMPLEX8 **bins, UINT4 *firstBinRead, UINT4 firstBin2read, UINT4 lastBin2read, const SFTDescriptor *desc, const void *map, size_t mapLen );
+#endif
 
 static UINT4 read_sft_bins_from_fp ( SFTtype *ret, UINT4 *firstBinRead, UINT4 firstBin2read, UINT4 lastBin2read , FILE *fp );
 static int read_sft_header_from_fp (FILE *fp, SFTtype  *header, UINT4 *version, UINT8 *crc64, BOOLEAN *swapEndian, CHAR **SFTcomment, UINT4 *numBins );
@@ -271,6 +284,9 @@ UINT4 XLALRoundFrequencyUpToSFTBin( const REAL8 freq, const REAL8 df )
  *
  * The returned SFTs in the catalogue are sorted by increasing GPS-epochs !
  *
+ * If compiled with OpenMP, the matching files are parsed in parallel; the returned
+ * catalogue is identical to that of a serial scan.
+ *
  */
 SFTCatalog *
 XLALSFTdataFind ( const CHAR *file_pattern,		/**< which SFT-files */
@@ -297,198 +313,74 @@ XLALSFTdataFind ( const CHAR *file_pattern,		/**< which SFT-files */
   XLAL_CHECK_NULL ( (fnames = XLALFindFiles (file_pattern)) != NULL, XLAL_EFUNC, "Failed to find filelist matching pattern '%s'.\n\n", file_pattern );
   UINT4 numFiles = fnames->length;
 
-  UINT4 numSFTs = 0;
-  /* ----- main loop: parse all matching files */
+  /* ----- main loop: parse all matching files, spreading files over threads;
+   * dynamic scheduling keeps at most one header-read per thread in flight */
+  SFTCatalog **fileCatalogs;
+  INT4 *fileErrno;
+  XLAL_CHECK_NULL ( (fileCatalogs = XLALCalloc ( numFiles > 0 ? numFiles : 1, sizeof(fileCatalogs[0]) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_NULL ( (fileErrno = XLALCalloc ( numFiles > 0 ? numFiles : 1, sizeof(fileErrno[0]) )) != NULL, XLAL_ENOMEM );
+#pragma omp parallel for schedule(dynamic,1)
   for ( UINT4 i = 0; i < numFiles; i ++ )
     {
-      const CHAR *fname = fnames->data[i];
-
-      /* merged SFTs need to satisfy stronger consistency-constraints (-> see spec) */
-      BOOLEAN mfirst_block = TRUE;
-      UINT4   mprev_version = 0;
-      SFTtype XLAL_INIT_DECL( mprev_header );
-      REAL8   mprev_nsamples = 0;
-
-      FILE *fp;
-      if ( ( fp = fopen( fname, "rb" ) ) == NULL )
-	{
-          XLALPrintError ("ERROR: Failed to open matched file '%s'\n\n", fname );
-	  XLALDestroyStringVector ( fnames );
-	  XLALDestroySFTCatalog ( ret );
-	  XLAL_ERROR_NULL ( XLAL_EIO );
-	}
-
-      long file_len;
-      if ( (file_len = get_file_len(fp)) == 0 )
-	{
-          XLALPrintError ("ERROR: got file-len == 0 for '%s'\n\n", fname );
-	  XLALDestroyStringVector ( fnames );
-	  XLALDestroySFTCatalog ( ret );
-	  fclose(fp);
-	  XLAL_ERROR_NULL ( XLAL_EIO );
-	}
-
-      /* go through SFT-blocks in fp */
-      while ( ftell(fp) < file_len )
-	{
-	  SFTtype this_header;
-	  UINT4 this_version;
-	  UINT4 this_nsamples;
-	  UINT8 this_crc;
-	  CHAR *this_comment = NULL;
-	  BOOLEAN endian;
-	  BOOLEAN want_this_block = FALSE;
-
-	  long this_filepos;
-	  if ( (this_filepos = ftell(fp)) == -1 )
-	    {
-              XLALPrintError ("ERROR: ftell() failed for '%s'\n\n", fname );
-	      XLALDestroyStringVector ( fnames );
-	      XLALDestroySFTCatalog ( ret );
-	      fclose (fp);
-	      XLAL_ERROR_NULL ( XLAL_EIO );
-	    }
-
-	  if ( read_sft_header_from_fp (fp, &this_header, &this_version, &this_crc, &endian, &this_comment, &this_nsamples ) != 0 )
-	    {
-              XLALPrintError ("ERROR: File-block '%s:%ld' is not a valid SFT!\n\n", fname, ftell(fp));
-	      XLALDestroyStringVector ( fnames );
-	      XLALFree ( this_comment );
-	      XLALDestroySFTCatalog ( ret );
-	      fclose(fp);
-	      XLAL_ERROR_NULL ( XLAL_EDATA );
-	    }
-
-	  /* if merged-SFT: check consistency constraints */
-	  if ( !mfirst_block )
-	    {
-	      if ( ! consistent_mSFT_header ( mprev_header, mprev_version, mprev_nsamples, this_header, this_version, this_nsamples ) )
-		{
-                  XLALPrintError ( "ERROR: merged SFT-file '%s' contains inconsistent SFT-blocks!\n\n", fname);
-		  XLALFree ( this_comment );
-		  XLALDestroyStringVector ( fnames );
-		  XLALDestroySFTCatalog ( ret );
-		  fclose(fp);
-		  XLAL_ERROR_NULL ( XLAL_EDATA );
-		}
-	    } /* if !mfirst_block */
-
-	  mprev_header = this_header;
-	  mprev_version = this_version;
-	  mprev_nsamples = this_nsamples;
-
-	  want_this_block = TRUE;	/* default */
-	  /* but does this SFT-block satisfy the user-constraints ? */
-	  if ( constraints )
-	    {
-	      if ( constraints->detector )
-		{
-                  if ( strncmp( constraints->detector, this_header.name, 2) ) {
-		    want_this_block = FALSE;
-                  }
-		}
-
-	      if ( XLALCWGPSinRange(this_header.epoch, constraints->minStartTime, constraints->maxStartTime) != 0 ) {
-		want_this_block = FALSE;
-              }
-
-	      if ( constraints->timestamps && !timestamp_in_list(this_header.epoch, constraints->timestamps) ) {
-		want_this_block = FALSE;
-              }
-
-	    } /* if constraints */
-
-	  if ( want_this_block )
-	    {
-	      numSFTs ++;
-
-	      /* do we need to alloc more memory for the SFTs? */
-	      if (  numSFTs > ret->length )
-		{
-		  /* we realloc SFT-memory blockwise in order to
-		   * improve speed in debug-mode (using LALMalloc/LALFree)
-		   */
-                  int len = (ret->length + SFTFILEIO_REALLOC_BLOCKSIZE) * sizeof( *(ret->data) );
-                  if ( (ret->data = LALRealloc ( ret->data, len )) == NULL )
-		    {
-                      XLALPrintError ("ERROR: SFT memory reallocation failed: nSFT:%d, len = %d\n", numSFTs, len );
-		      XLALDestroyStringVector ( fnames );
-		      XLALDestroySFTCatalog ( ret );
-		      XLALFree ( this_comment );
-		      fclose(fp);
-		      XLAL_ERROR_NULL ( XLAL_ENOMEM );
-		    }
-
-		  /* properly initialize data-fields pointers to NULL to avoid SegV when Freeing */
-		  for ( UINT4 j=0; j < SFTFILEIO_REALLOC_BLOCKSIZE; j ++ ) {
-		    memset ( &(ret->data[ret->length + j]), 0, sizeof( ret->data[0] ) );
-                  }
-
-		  ret->length += SFTFILEIO_REALLOC_BLOCKSIZE;
-		} // if numSFTs > ret->length
-
-	      SFTDescriptor *desc = &(ret->data[numSFTs - 1]);
-
-	      desc->locator = XLALCalloc ( 1, sizeof ( *(desc->locator) ) );
-	      if ( desc->locator ) {
-		desc->locator->fname = XLALCalloc( 1, strlen(fname) + 1 );
-              }
-	      if ( (desc->locator == NULL) || (desc->locator->fname == NULL ) )
-		{
-                  XLALPrintError ("ERROR: XLALCalloc() failed\n" );
-		  XLALDestroyStringVector ( fnames );
-		  XLALDestroySFTCatalog ( ret );
-		  fclose(fp);
-		  XLAL_ERROR_NULL ( XLAL_ENOMEM );
-		}
-	      strcpy ( desc->locator->fname, fname );
-	      desc->locator->offset = this_filepos;
-
-	      desc->header  = this_header;
-	      desc->comment = this_comment;
-	      desc->numBins = this_nsamples;
-	      desc->version = this_version;
-	      desc->crc64   = this_crc;
-
-	    } /* if want_this_block */
-	  else
-	    {
-	      XLALFree ( this_comment );
-	    }
-
-	  mfirst_block = FALSE;
-
-	  /* skip seeking if we know we would reach the end */
-	  if ( ftell ( fp ) + (long)this_nsamples * 8 >= file_len )
-	    break;
-
-	  /* seek to end of SFT data-entries in file  */
-	  if ( fseek ( fp, this_nsamples * 8 , SEEK_CUR ) == -1 )
-	    {
-              XLALPrintError ("ERROR: Failed to skip DATA field for SFT '%s': %s\n", fname, strerror(errno) );
-	      XLALFree ( this_comment );
-	      XLALDestroyStringVector ( fnames );
-	      XLALDestroySFTCatalog ( ret );
-	      fclose(fp);
-	      XLAL_ERROR_NULL ( XLAL_EIO );
-	    }
+      if ( find_sfts_in_file ( &fileCatalogs[i], fnames->data[i], constraints ) != XLAL_SUCCESS )
+        {
+          fileErrno[i] = xlalErrno;
+          XLALClearErrno();
+        }
+    } /* for i < numFiles */
 
-	} /* while !feof */
+  /* collect per-file results in order of matched filenames: same as a serial scan */
+  UINT4 numSFTs = 0;
+  for ( UINT4 i = 0; i < numFiles; i ++ )
+    {
+      if ( fileErrno[i] != 0 )
+        {
+          INT4 errnum = fileErrno[i];
+          for ( UINT4 j = 0; j < numFiles; j ++ ) {
+            XLALDestroySFTCatalog ( fileCatalogs[j] );
+          }
+          XLALFree ( fileCatalogs );
+          XLALFree ( fileErrno );
+          XLALPrintError ( "ERROR: Failed to parse SFTs in matched file '%s'\n\n", fnames->data[i] );
+          XLALDestroyStringVector ( fnames );
+          XLALDestroySFTCatalog ( ret );
+          XLAL_ERROR_NULL ( errnum );
+        }
+      numSFTs += fileCatalogs[i]->length;
+    }
 
-      fclose(fp);
+  if ( numSFTs > 0 )
+    {
+      if ( (ret->data = XLALMalloc ( numSFTs * sizeof( *(ret->data) ) )) == NULL )
+        {
+          for ( UINT4 j = 0; j < numFiles; j ++ ) {
+            XLALDestroySFTCatalog ( fileCatalogs[j] );
+          }
+          XLALFree ( fileCatalogs );
+          XLALFree ( fileErrno );
+          XLALDestroyStringVector ( fnames );
+          XLALDestroySFTCatalog ( ret );
+          XLAL_ERROR_NULL ( XLAL_ENOMEM, "XLALMalloc ( %zu ) failed.\n", numSFTs * sizeof( *(ret->data) ) );
+        }
+    }
 
-    } /* for i < numFiles */
+  /* move descriptors (and ownership of their locators and comments) into the return catalog */
+  for ( UINT4 i = 0, n = 0; i < numFiles; i ++ )
+    {
+      if ( fileCatalogs[i]->length > 0 )
+        {
+          memcpy ( &(ret->data[n]), fileCatalogs[i]->data, fileCatalogs[i]->length * sizeof( *(ret->data) ) );
+          n += fileCatalogs[i]->length;
+        }
+      XLALFree ( fileCatalogs[i]->data );
+      XLALFree ( fileCatalogs[i] );
+    }
+  XLALFree ( fileCatalogs );
+  XLALFree ( fileErrno );
 
   /* free matched filenames */
   XLALDestroyStringVector ( fnames );
 
-  /* now realloc SFT-vector (alloc'ed blockwise) to its *actual size* */
-  int len;
-  if ( (ret->data = XLALRealloc ( ret->data, len = numSFTs * sizeof( *(ret->data) ))) == NULL )
-    {
-      XLALDestroySFTCatalog ( ret );
-      XLAL_ERROR_NULL ( XLAL_ENOMEM, "XLALRecalloc ( %d ) failed.\n", len );
-    }
   ret->length = numSFTs;
 
   /* ----- final consistency-checks: ----- */
@@ -548,6 +440,181 @@ XLALSFTdataFind ( const CHAR *file_pattern,		/**< which SFT-files */
 } /* XLALSFTdataFind() */
 
 
+/*
+ * Parse all SFT-blocks in the file 'fname', and return a catalog (in order of SFT-blocks
+ * in the file) of those satisfying the (optional) 'constraints'. This is the per-file part
+ * of XLALSFTdataFind(), and is called from multiple threads: it must only touch its own outputs.
+ */
+static int
+find_sfts_in_file ( SFTCatalog **fileCatalog,		/**< [out] catalog of matching SFTs in this file */
+                    const CHAR *fname,			/**< [in] name of SFT file */
+                    const SFTConstraints *constraints	/**< [in] additional constraints for SFT-selection */
+                    )
+{
+  SFTCatalog *ret;
+  XLAL_CHECK ( (ret = (*fileCatalog) = XLALCalloc ( 1, sizeof (*ret) )) != NULL, XLAL_ENOMEM );
+
+  /* merged SFTs need to satisfy stronger consistency-constraints (-> see spec) */
+  BOOLEAN mfirst_block = TRUE;
+  UINT4   mprev_version = 0;
+  SFTtype XLAL_INIT_DECL( mprev_header );
+  REAL8   mprev_nsamples = 0;
+
+  FILE *fp;
+  XLAL_CHECK ( ( fp = fopen( fname, "rb" ) ) != NULL, XLAL_EIO, "ERROR: Failed to open matched file '%s'\n\n", fname );
+
+  long file_len;
+  if ( (file_len = get_file_len(fp)) == 0 )
+    {
+      fclose(fp);
+      XLAL_ERROR ( XLAL_EIO, "ERROR: got file-len == 0 for '%s'\n\n", fname );
+    }
+
+  UINT4 numSFTs = 0;
+
+  /* go through SFT-blocks in fp */
+  while ( ftell(fp) < file_len )
+    {
+      SFTtype this_header;
+      UINT4 this_version;
+      UINT4 this_nsamples;
+      UINT8 this_crc;
+      CHAR *this_comment = NULL;
+      BOOLEAN endian;
+      BOOLEAN want_this_block = FALSE;
+
+      long this_filepos;
+      if ( (this_filepos = ftell(fp)) == -1 )
+        {
+          fclose (fp);
+          XLAL_ERROR ( XLAL_EIO, "ERROR: ftell() failed for '%s'\n\n", fname );
+        }
+
+      if ( read_sft_header_from_fp (fp, &this_header, &this_version, &this_crc, &endian, &this_comment, &this_nsamples ) != 0 )
+        {
+          XLALFree ( this_comment );
+          XLALPrintError ("ERROR: File-block '%s:%ld' is not a valid SFT!\n\n", fname, ftell(fp));
+          fclose(fp);
+          XLAL_ERROR ( XLAL_EDATA );
+        }
+
+      /* if merged-SFT: check consistency constraints */
+      if ( !mfirst_block )
+        {
+          if ( ! consistent_mSFT_header ( mprev_header, mprev_version, mprev_nsamples, this_header, this_version, this_nsamples ) )
+            {
+              XLALFree ( this_comment );
+              fclose(fp);
+              XLAL_ERROR ( XLAL_EDATA, "ERROR: merged SFT-file '%s' contains inconsistent SFT-blocks!\n\n", fname );
+            }
+        } /* if !mfirst_block */
+
+      mprev_header = this_header;
+      mprev_version = this_version;
+      mprev_nsamples = this_nsamples;
+
+      want_this_block = TRUE;	/* default */
+      /* but does this SFT-block satisfy the user-constraints ? */
+      if ( constraints )
+        {
+          if ( constraints->detector )
+            {
+              if ( strncmp( constraints->detector, this_header.name, 2) ) {
+                want_this_block = FALSE;
+              }
+            }
+
+          if ( XLALCWGPSinRange(this_header.epoch, constraints->minStartTime, constraints->maxStartTime) != 0 ) {
+            want_this_block = FALSE;
+          }
+
+          if ( constraints->timestamps && !timestamp_in_list(this_header.epoch, constraints->timestamps) ) {
+            want_this_block = FALSE;
+          }
+
+        } /* if constraints */
+
+      if ( want_this_block )
+        {
+          numSFTs ++;
+
+          /* do we need to alloc more memory for the SFTs? */
+          if (  numSFTs > ret->length )
+            {
+              /* we realloc SFT-memory blockwise in order to
+               * improve speed in debug-mode (using LALMalloc/LALFree)
+               */
+              int len = (ret->length + SFTFILEIO_REALLOC_BLOCKSIZE) * sizeof( *(ret->data) );
+              if ( (ret->data = LALRealloc ( ret->data, len )) == NULL )
+                {
+                  XLALFree ( this_comment );
+                  fclose(fp);
+                  ret->length = 0;
+                  XLAL_ERROR ( XLAL_ENOMEM, "ERROR: SFT memory reallocation failed: nSFT:%d, len = %d\n", numSFTs, len );
+                }
+
+              /* properly initialize data-fields pointers to NULL to avoid SegV when Freeing */
+              for ( UINT4 j=0; j < SFTFILEIO_REALLOC_BLOCKSIZE; j ++ ) {
+                memset ( &(ret->data[ret->length + j]), 0, sizeof( ret->data[0] ) );
+              }
+
+              ret->length += SFTFILEIO_REALLOC_BLOCKSIZE;
+            } // if numSFTs > ret->length
+
+          SFTDescriptor *desc = &(ret->data[numSFTs - 1]);
+
+          desc->locator = XLALCalloc ( 1, sizeof ( *(desc->locator) ) );
+          if ( desc->locator ) {
+            desc->locator->fname = XLALCalloc( 1, strlen(fname) + 1 );
+          }
+          if ( (desc->locator == NULL) || (desc->locator->fname == NULL ) )
+            {
+              XLALFree ( this_comment );
+              fclose(fp);
+              XLAL_ERROR ( XLAL_ENOMEM, "ERROR: XLALCalloc() failed\n" );
+            }
+          strcpy ( desc->locator->fname, fname );
+          desc->locator->offset = this_filepos;
+          desc->locator->dataOffset = ftell ( fp );	/* read_sft_header_from_fp() leaves fp at the first frequency-bin */
+          desc->locator->swapEndian = endian;
+
+          desc->header  = this_header;
+          desc->comment = this_comment;
+          desc->numBins = this_nsamples;
+          desc->version = this_version;
+          desc->crc64   = this_crc;
+
+        } /* if want_this_block */
+      else
+        {
+          XLALFree ( this_comment );
+        }
+
+      mfirst_block = FALSE;
+
+      /* skip seeking if we know we would reach the end */
+      if ( ftell ( fp ) + (long)this_nsamples * 8 >= file_len )
+        break;
+
+      /* seek to end of SFT data-entries in file  */
+      if ( fseek ( fp, this_nsamples * 8 , SEEK_CUR ) == -1 )
+        {
+          fclose(fp);
+          XLAL_ERROR ( XLAL_EIO, "ERROR: Failed to skip DATA field for SFT '%s': %s\n", fname, strerror(errno) );
+        }
+
+    } /* while !feof */
+
+  fclose(fp);
+
+  /* remove blockwise-allocated unused entries */
+  ret->length = numSFTs;
+
+  return XLAL_SUCCESS;
+
+} /* find_sfts_in_file() */
+
+
 /*
    This function reads an SFT (segment) from an open file pointer into a buffer.
    firstBin2read specifies the first bin to read from the SFT, lastBin2read is the last bin.
@@ -705,6 +772,10 @@ read_sft_bins_from_fp ( SFTtype *ret, UINT4 *firstBinRead, UINT4 firstBin2read,
  * Note 4: The 'fudge region' allowing for numerical noise is fudge= 10*LAL_REAL8_EPS ~2e-15
  * relative deviation: ie if the SFT contains a bin at 'fi', then we consider for example
  * "fMin == fi" if  fabs(fi - fMin)/fi < fudge.
+ *
+ * Note 5: Where mmap() is available, each SFT file is memory-mapped once and the requested bins
+ * are sliced directly from the mapping, using the header and data offset recorded in the catalog
+ * by XLALSFTdataFind(); no SFT headers are re-parsed, and no intermediate read buffer is used.
  */
 SFTVector*
 XLALLoadSFTs (const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load */
@@ -724,11 +795,23 @@ XLALLoadSFTs (const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load
   char* fname = &empty;            /**< name of currently open file, initially "" */
   FILE* fp = NULL;                 /**< open file */
   SFTtype* thisSFT = NULL;         /**< SFT to read from file */
+  SFTtype* readSFT = NULL;         /**< SFT segment actually read: thisSFT, or a slice of a memory-mapped file */
+  const COMPLEX8* readBins = NULL; /**< bins of the SFT segment actually read */
+#ifdef SFTFILEIO_USE_MMAP
+  void* map = NULL;                /**< memory-mapped contents of currently open file */
+  size_t mapLen = 0;               /**< length of memory-mapped file */
+  SFTtype mapSFT;                  /**< header of SFT segment sliced from memory-mapped file */
+  const COMPLEX8* mapBins = NULL;  /**< bins of SFT segment sliced from memory-mapped file (read-only, not owned) */
+#define SFTFILEIO_MUNMAP  if(map) munmap(map, mapLen);
+#else
+#define SFTFILEIO_MUNMAP
+#endif
 
   /* error handler: free memory and return with error */
 #define XLALLOADSFTSERROR(eno)	{		\
     if(fp)					\
       fclose(fp);				\
+    SFTFILEIO_MUNMAP				\
     if(segments) 				\
       XLALFree(segments);			\
     if(locatalog.data)				\
@@ -831,6 +914,9 @@ XLALLoadSFTs (const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load
     UINT4 isft = locator->isft;;
     UINT4 firstBinRead;
     UINT4 lastBinRead;
+    BOOLEAN swapEndian = FALSE;
+
+    readSFT = thisSFT;
 
     if (locatalog.data[catPos].header.data) {
       /* the SFT data has already been read into the catalog,
@@ -881,6 +967,26 @@ XLALLoadSFTs (const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load
     } else {
       /* SFT data had not yet been read - read it */
 
+#ifdef SFTFILEIO_USE_MMAP
+      /* map and unmap a file only when necessary, i.e. reading a different file */
+      if(strcmp(fname, locator->fname)) {
+	SFTFILEIO_MUNMAP
+	fname = locator->fname;
+	map = mmap_sft_file(fname, &mapLen);
+	XLALPrintInfo("%s: Mapping file '%s'\n", __func__, fname);
+	if(!map) {
+	  XLALPrintError("ERROR: Couldn't map file '%s'\n", fname);
+	  XLALLOADSFTSERROR(XLAL_EIO);
+	}
+      }
+
+      /* slice SFT data from the mapped file, using the header and data offset found by XLALSFTdataFind() */
+      lastBinRead = slice_sft_bins_from_map ( &mapSFT, &mapBins, &firstBinRead, firstbin, lastbin, &locatalog.data[catPos], map, mapLen );
+      readSFT = &mapSFT;
+      readBins = mapBins;
+      swapEndian = locator->swapEndian;
+      XLALPrintInfo ("%s: Sliced data from %s:%lu: %u - %u\n", __func__, locator->fname, locator->offset, firstBinRead, lastBinRead);
+#else
       /* open and close a file only when necessary, i.e. reading a different file */
       if(strcmp(fname, locator->fname)) {
 	if(fp) {
@@ -907,8 +1013,11 @@ XLALLoadSFTs (const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load
       /* read SFT data */
       lastBinRead = read_sft_bins_from_fp ( thisSFT, &firstBinRead, firstbin, lastbin, fp );
       XLALPrintInfo ("%s: Read data from %s:%lu: %u - %u\n", __func__, locator->fname, locator->offset, firstBinRead, lastBinRead);
+#endif
     }
     /* SFT data has been read from file or taken from catalog */
+    if(readSFT == thisSFT)
+      readBins = thisSFT->data->data;
 
     if(lastBinRead) {
 	/* data was actually read */
@@ -919,32 +1028,32 @@ XLALLoadSFTs (const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load
 	  if(firstBinRead != firstbin) {
 	    XLALPrintError("ERROR: data gap or overlap at first bin of SFT#%u (GPS %lf)"
 			   " expected bin %u, bin %u read from file '%s'\n",
-			   isft, GPS2REAL8(thisSFT->epoch),
+			   isft, GPS2REAL8(readSFT->epoch),
 			   firstbin, firstBinRead, fname);
 	    XLALLOADSFTSERROR(XLAL_EIO);
 	  }
 	  segments[isft].first = firstBinRead;
-	  segments[isft].epoch = thisSFT->epoch;
+	  segments[isft].epoch = readSFT->epoch;
 
 	/* if not first segment, segment must fit at the end of previous data */
 	} else if(firstBinRead != segments[isft].last + 1) {
 	  XLALPrintError("ERROR: data gap or overlap in SFT#%u (GPS %lf)"
 			 " between bin %u read from file '%s' and bin %u read from file '%s'\n",
-			 isft, GPS2REAL8(thisSFT->epoch),
+			 isft, GPS2REAL8(readSFT->epoch),
 			 segments[isft].last, segments[isft].lastfrom->fname,
 			 firstBinRead, fname);
 	  XLALLOADSFTSERROR(XLAL_EIO);
 	}
 
 	/* consistency checks */
-	if(deltaF != thisSFT->deltaF) {
+	if(deltaF != readSFT->deltaF) {
 	  XLALPrintError("ERROR: deltaF mismatch (%f/%f) in SFT read from file '%s'\n",
-			 thisSFT->deltaF, deltaF, fname);
+			 readSFT->deltaF, deltaF, fname);
 	  XLALLOADSFTSERROR(XLAL_EIO);
 	}
-	if(!GPSEQUAL(segments[isft].epoch, thisSFT->epoch)) {
+	if(!GPSEQUAL(segments[isft].epoch, readSFT->epoch)) {
 	  XLALPrintError("ERROR: GPS epoch mismatch (%f/%f) in SFT read from file '%s'\n",
-			 GPS2REAL8(segments[isft].epoch), GPS2REAL8(thisSFT->epoch), fname);
+			 GPS2REAL8(segments[isft].epoch), GPS2REAL8(readSFT->epoch), fname);
 	  XLALLOADSFTSERROR(XLAL_EIO);
 	}
 
@@ -954,19 +1063,23 @@ XLALLoadSFTs (const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load
         memcpy( sftVector->data[isft].name, locatalog.data[catPos].header.name, sizeof(sftVector->data[isft].name));
 	sftVector->data[isft].sampleUnits = locatalog.data[catPos].header.sampleUnits;
 	memcpy(sftVector->data[isft].data->data + (firstBinRead - firstbin),
-	       thisSFT->data->data,
+	       readBins,
 	       (lastBinRead - firstBinRead + 1) * sizeof(COMPLEX8));
 
+	/* data sliced from a mapped file still needs to be endian-swapped */
+	if ( swapEndian )
+	  endian_swap ( (CHAR*)(sftVector->data[isft].data->data + (firstBinRead - firstbin)), sizeof(REAL4), 2 * (lastBinRead - firstBinRead + 1) );
+
       } else if(!firstBinRead) {
 	/* no needed data had been in this segment */
         XLALPrintInfo ( "%s: No data read from %s:%lu\n", __func__, locator->fname, locator->offset);
 
 	/* set epoch if not yet set, if already set, check it */
 	if(GPSZERO(segments[isft].epoch))
-	  segments[isft].epoch = thisSFT->epoch;
-	else if (!GPSEQUAL(segments[isft].epoch, thisSFT->epoch)) {
+	  segments[isft].epoch = readSFT->epoch;
+	else if (!GPSEQUAL(segments[isft].epoch, readSFT->epoch)) {
 	  XLALPrintError("ERROR: GPS epoch mismatch (%f/%f) in SFT read from file '%s'\n",
-			 GPS2REAL8(segments[isft].epoch), GPS2REAL8(thisSFT->epoch), fname);
+			 GPS2REAL8(segments[isft].epoch), GPS2REAL8(readSFT->epoch), fname);
 	  XLALLOADSFTSERROR(XLAL_EIO);
 	}
 
@@ -983,6 +1096,7 @@ XLALLoadSFTs (const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load
     fclose(fp);
     fp = NULL;
   }
+  SFTFILEIO_MUNMAP
 
   /* check that all SFTs are complete */
   for(UINT4 isft = 0; isft < nSFTs; isft++) {
@@ -1011,6 +1125,7 @@ XLALLoadSFTs (const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load
 
   return(sftVector);
 
+#undef SFTFILEIO_MUNMAP
 } /* XLALLoadSFTs() */
 
 
@@ -1183,7 +1298,7 @@ XLALReadTimestampsFileConstrained ( const CHAR *fname, const LIGOTimeGPS *minGPS
  * and XLAL_FAILURE otherwise.
  *
  * \note: because this function has to read the complete SFT data into memory it is
- * potentially slow and memory-intensive.
+ * potentially slow and memory-intensive. If compiled with OpenMP, SFTs are checked in parallel.
  */
 int
 XLALCheckCRCSFTCatalog(
@@ -1198,7 +1313,13 @@ XLALCheckCRCSFTCatalog(
   /* CRC checks are assumed to pass until one fails */
   *crc_check = 1;
 
-  /* step through SFTs and check CRC64 */
+  /* status of each SFT check, evaluated after the (threaded) loop in catalog order */
+  enum { CRC_OK = 0, CRC_OPEN_FAILED, CRC_CHECK_FAILED, CRC_ILLEGAL_VERSION };
+  UCHAR *status;
+  XLAL_CHECK ( (status = XLALCalloc ( catalog->length > 0 ? catalog->length : 1, sizeof(status[0]) )) != NULL, XLAL_ENOMEM );
+
+  /* step through SFTs and check CRC64, one SFT per thread at a time */
+#pragma omp parallel for schedule(dynamic,1)
   for ( UINT4 i=0; i < catalog->length; i ++ )
     {
       FILE *fp;
@@ -1206,34 +1327,56 @@ XLALCheckCRCSFTCatalog(
       switch ( catalog->data[i].version  )
 	{
 	case 1:	/* version 1 had no CRC  */
-	  continue;
+	  break;
 	case 2:
 	  if ( (fp = fopen_SFTLocator ( catalog->data[i].locator )) == NULL )
 	    {
-	      XLALPrintError ( "Failed to open locator '%s'\n",
-			      XLALshowSFTLocator ( catalog->data[i].locator ) );
-              return XLAL_FAILURE;
+	      status[i] = CRC_OPEN_FAILED;
+	      break;
 	    }
 	  if ( !(has_valid_v2_crc64 ( fp ) != 0) )
 	    {
-	      XLALPrintError ( "CRC64 checksum failure for SFT '%s'\n",
-			      XLALshowSFTLocator ( catalog->data[i].locator ) );
-              *crc_check = 0;
-	      fclose(fp);
-              return XLAL_SUCCESS;
+	      status[i] = CRC_CHECK_FAILED;
 	    }
 	  fclose(fp);
 	  break;
 
 	default:
-	  XLALPrintError ( "Illegal SFT-version encountered : %d\n", catalog->data[i].version );
-          return XLAL_FAILURE;
+	  status[i] = CRC_ILLEGAL_VERSION;
 	  break;
 	} /* switch (version ) */
 
     } /* for i < numSFTs */
 
-  return XLAL_SUCCESS;
+  /* report the first failure in catalog order, same as a serial check */
+  int retn = XLAL_SUCCESS;
+  for ( UINT4 i=0; i < catalog->length; i ++ )
+    {
+      if ( status[i] == CRC_OPEN_FAILED )
+	{
+	  XLALPrintError ( "Failed to open locator '%s'\n",
+			  XLALshowSFTLocator ( catalog->data[i].locator ) );
+	  retn = XLAL_FAILURE;
+	  break;
+	}
+      else if ( status[i] == CRC_CHECK_FAILED )
+	{
+	  XLALPrintError ( "CRC64 checksum failure for SFT '%s'\n",
+			  XLALshowSFTLocator ( catalog->data[i].locator ) );
+	  *crc_check = 0;
+	  break;
+	}
+      else if ( status[i] == CRC_ILLEGAL_VERSION )
+	{
+	  XLALPrintError ( "Illegal SFT-version encountered : %d\n", catalog->data[i].version );
+	  retn = XLAL_FAILURE;
+	  break;
+	}
+    } /* for i < numSFTs */
+
+  XLALFree ( status );
+
+  return retn;
 
 } /* XLALCheckCRCSFTCatalog() */
 
@@ -2352,6 +2495,113 @@ fopen_SFTLocator ( const struct tagSFTLocator *locator )
 } /* fopen_SFTLocator() */
 
 
+#ifdef SFTFILEIO_USE_MMAP
+/*
+ * Map the complete contents of an SFT file into memory (read-only), return a pointer to it
+ * and its length in 'mapLen'. Returns NULL on failure; the mapping must be released with munmap().
+ */
+static void *
+mmap_sft_file ( const CHAR *fname, size_t *mapLen )
+{
+  FILE *fp;
+  if ( (fp = fopen( fname, "rb" )) == NULL )
+    {
+      XLALPrintError ("\nFailed to open SFT-file '%s': %s\n\n", fname, strerror(errno) );
+      return NULL;
+    }
+
+  long file_len = get_file_len ( fp );
+  if ( file_len <= 0 )
+    {
+      XLALPrintError ("\nGot file-len == 0 for '%s'\n\n", fname );
+      fclose ( fp );
+      return NULL;
+    }
+
+  void *map = mmap ( NULL, (size_t) file_len, PROT_READ, MAP_PRIVATE, fileno(fp), 0 );
+  fclose ( fp );	/* mapping remains valid after the file is closed */
+  if ( map == MAP_FAILED )
+    {
+      XLALPrintError ("\nFailed to mmap() SFT-file '%s': %s\n\n", fname, strerror(errno) );
+      return NULL;
+    }
+
+  (*mapLen) = (size_t) file_len;
+  return map;
+
+} /* mmap_sft_file() */
+
+
+/*
+ * Memory-mapped equivalent of read_sft_bins_from_fp(): slice the requested bins of the SFT
+ * described by 'desc' from the mapped file contents 'map', without reading or copying any data.
+ * On return, 'ret' contains the SFT header from the catalog (with ret->data = NULL), and 'bins'
+ * points to the read-only bins in 'map' (NOT endian-swapped). Return values are the same as for
+ * read_sft_bins_from_fp().
+ */
+static UINT4
+slice_sft_bins_from_map ( SFTtype *ret, const COMPLEX8 **bins, UINT4 *firstBinRead, UINT4 firstBin2read, UINT4 lastBin2read, const SFTDescriptor *desc, const void *map, size_t mapLen )
+{
+  *firstBinRead = 0;
+
+  if ( (ret == NULL) || (bins == NULL) || (desc == NULL) || (map == NULL) )
+    {
+      XLALPrintError ( "slice_sft_bins_from_map(): got passed NULL input\n" );
+      *firstBinRead = 1;
+      return(0);
+    }
+
+  if ( firstBin2read > lastBin2read )
+    {
+      XLALPrintError ("slice_sft_bins_from_map(): Empty frequency-interval requested [%d, %d] bins\n",
+		      firstBin2read, lastBin2read );
+      *firstBinRead = 1;
+      return(0);
+    }
+
+  /* header is known from the catalog */
+  (*ret) = desc->header;
+  ret->data = NULL;
+
+  volatile REAL8 tmp = ret->f0 / ret->deltaF;
+  UINT4 firstSFTbin = lround ( tmp );
+  UINT4 lastSFTbin = firstSFTbin + desc->numBins - 1;
+
+  if ( (desc->locator->dataOffset <= 0) || ((size_t)desc->locator->dataOffset + desc->numBins * sizeof(COMPLEX8) > mapLen) )
+    {
+      XLALPrintError ("slice_sft_bins_from_map(): SFT data [%ld, %ld) exceeds mapped file length %zu\n",
+		      desc->locator->dataOffset, desc->locator->dataOffset + (long)(desc->numBins * sizeof(COMPLEX8)), mapLen );
+      *firstBinRead = 3;
+      return(0);
+    }
+
+  /* limit the interval to be read to what's actually in the SFT */
+  if ( firstBin2read < firstSFTbin )
+    firstBin2read = firstSFTbin;
+  if ( lastBin2read > lastSFTbin )
+    lastBin2read = lastSFTbin;
+
+  /* return 0 (no bins read) if requested interval is not found in SFT */
+  if ( firstBin2read > lastBin2read ) {
+    *firstBinRead = 0;
+    return(0);
+  }
+
+  *firstBinRead = firstBin2read;
+
+  /* point to the desired bins (SFT data is 8-byte aligned in the file, as the comment is padded) */
+  (*bins) = (const COMPLEX8 *) ( (const CHAR *) map + desc->locator->dataOffset + (firstBin2read - firstSFTbin) * sizeof(COMPLEX8) );
+
+  /* update the start-frequency entry in the SFT-header to the new value */
+  ret->f0 = 1.0 * firstBin2read * ret->deltaF;
+
+  /* return last bin read */
+  return(lastBin2read);
+
+} /* slice_sft_bins_from_map() */
+#endif
+
+
 /***********************************************************************
  * internal helper functions
  ***********************************************************************/
@@ -23,7 +23,6 @@
 #include <stdarg.h>
 
 #include <gsl/gsl_math.h>
-#include <gsl/gsl_sort_double.h>
 
 #include <lal/AVFactories.h>
 #include <lal/SeqFactories.h>
@@ -91,6 +90,8 @@ const UserChoices MathOpTypeChoices = {
 /*---------- internal prototypes ----------*/
 REAL8 TSFTfromDFreq ( REAL8 dFreq );
 int compareSFTdesc(const void *ptr1, const void *ptr2);     // defined in SFTfileIO.c
+static REAL8 SelectKthSmallest ( REAL8 *data, const size_t length, const size_t k );
+static REAL8 MathOpOverScratchArray ( REAL8 *data, const size_t length, const MathOpType optype );
 
 /*==================== FUNCTION DEFINITIONS ====================*/
 
@@ -2365,19 +2366,12 @@ XLALComputePSDandNormSFTPower ( REAL8Vector **finalPSD, /* [out] final PSD avera
   /* allocate main output struct, using cropped length */
   XLAL_CHECK ( (*finalPSD = XLALCreateREAL8Vector ( numBins )) != NULL, XLAL_ENOMEM, "Failed to create REAL8Vector for finalPSD.");
 
-  /* number of IFOs */
-  REAL8Vector *overIFOs = NULL; /* one frequency bin over IFOs */
-  XLAL_CHECK ( (overIFOs = XLALCreateREAL8Vector ( numIFOs )) != NULL, XLAL_ENOMEM, "Failed to create REAL8Vector for overIFOs array.");
-
   /* maximum number of SFTs */
   UINT4 maxNumSFTs = 0;
   for (UINT4 X = 0; X < numIFOs; ++X) {
     maxNumSFTs = GSL_MAX(maxNumSFTs, (*multiPSDVector)->data[X]->length);
   }
 
-  REAL8Vector *overSFTs = NULL; /* one frequency bin over SFTs */
-  XLAL_CHECK ( (overSFTs = XLALCreateREAL8Vector ( maxNumSFTs )) != NULL, XLAL_ENOMEM, "Failed to create REAL8Vector for overSFTs array.");
-
   /* normalize rngmd(power) to get proper *single-sided* PSD: Sn = (2/Tsft) rngmed[|data|^2]] */
   REAL8 normPSD = 2.0 * dFreq;
 
@@ -2396,75 +2390,114 @@ XLALComputePSDandNormSFTPower ( REAL8Vector **finalPSD, /* [out] final PSD avera
     totalNumSFTsNormalizingFactor = XLALGetMathOpNormalizationFactorFromTotalNumberOfSFTs ( totalNumSFTs, PSDmthopSFTs );
   }
 
-  XLAL_PRINT_INFO("Computing spectrogram and PSD ...");
-  /* loop over frequency bins in final PSD */
-  for (UINT4 k = 0; k < numBins; ++k) {
-
-    /* loop over IFOs */
-    for (UINT4 X = 0; X < numIFOs; ++X) {
-
-      /* number of SFTs for this IFO */
-      UINT4 numSFTs = (*multiPSDVector)->data[X]->length;
-
-      /* copy PSD frequency bins and normalise multiPSDVector for later use */
-      for (UINT4 alpha = 0; alpha < numSFTs; ++alpha) {
-        (*multiPSDVector)->data[X]->data[alpha].data->data[k] *= normPSD;
-        overSFTs->data[alpha] = (*multiPSDVector)->data[X]->data[alpha].data->data[k];
-      }
-
-      /* compute math. operation over SFTs for this IFO */
-      overIFOs->data[X] = XLALMathOpOverArray(overSFTs->data, numSFTs, PSDmthopSFTs);
-      XLAL_CHECK ( !XLAL_IS_REAL8_FAIL_NAN(overIFOs->data[X]), XLAL_EFUNC, "XLALMathOpOverArray() returned NAN for overIFOs->data[X=%d]", X );
-
-    } /* for IFOs X */
-
-    /* compute math. operation over IFOs for this frequency */
-    (*finalPSD)->data[k] = XLALMathOpOverArray(overIFOs->data, numIFOs, PSDmthopIFOs);
-    XLAL_CHECK ( !XLAL_IS_REAL8_FAIL_NAN((*finalPSD)->data[k]), XLAL_EFUNC, "XLALMathOpOverArray() returned NAN for finalPSD->data[k=%d]", k );
-
-    if ( normalizeByTotalNumSFTs ) {
-       (*finalPSD)->data[k] *= totalNumSFTsNormalizingFactor;
-    }
-
-  } /* for freq bins k */
-  XLAL_PRINT_INFO("done.");
-
-  /* compute normalised SFT power */
   if ( returnNormSFT ) {
-    XLAL_PRINT_INFO("Computing normalised SFT power ...");
     XLAL_CHECK ( (*normSFT = XLALCreateREAL8Vector ( numBins )) != NULL, XLAL_ENOMEM, "Failed to create REAL8Vector for normSFT.");
+  }
+
+  /* frequency bins are independent, so spread them over threads; each thread
+   * copies one bin over SFTs (overSFTs) and over IFOs (overIFOs) into its own
+   * scratch arrays, which the math. operations may then reorder in place */
+  XLAL_PRINT_INFO("Computing spectrogram and PSD ...");
+  int errnum = 0;
+#pragma omp parallel
+  {
+    REAL8 *overIFOs = XLALMalloc ( numIFOs * sizeof(REAL8) );
+    REAL8 *overSFTs = XLALMalloc ( maxNumSFTs * sizeof(REAL8) );
+    const BOOLEAN haveScratch = ( overIFOs != NULL && overSFTs != NULL );
+    if ( !haveScratch ) {
+#pragma omp critical (XLALComputePSDandNormSFTPower)
+      errnum = XLAL_ENOMEM;
+    }
 
-    /* loop over frequency bins in SFTs */
+    /* loop over frequency bins in final PSD */
+#pragma omp for schedule(static)
     for (UINT4 k = 0; k < numBins; ++k) {
+      if ( !haveScratch ) {
+        continue;
+      }
 
       /* loop over IFOs */
       for (UINT4 X = 0; X < numIFOs; ++X) {
 
         /* number of SFTs for this IFO */
-        UINT4 numSFTs = SFTs->data[X]->length;
+        UINT4 numSFTs = (*multiPSDVector)->data[X]->length;
 
-        /* compute SFT power */
+        /* copy PSD frequency bins and normalise multiPSDVector for later use */
         for (UINT4 alpha = 0; alpha < numSFTs; ++alpha) {
-          COMPLEX8 bin = SFTs->data[X]->data[alpha].data->data[k];
-          overSFTs->data[alpha] = crealf(bin)*crealf(bin) + cimagf(bin)*cimagf(bin);
+          (*multiPSDVector)->data[X]->data[alpha].data->data[k] *= normPSD;
+          overSFTs[alpha] = (*multiPSDVector)->data[X]->data[alpha].data->data[k];
         }
 
         /* compute math. operation over SFTs for this IFO */
-        overIFOs->data[X] = XLALMathOpOverArray(overSFTs->data, numSFTs, nSFTmthopSFTs);
-        XLAL_CHECK ( !XLAL_IS_REAL8_FAIL_NAN(overIFOs->data[X]), XLAL_EFUNC, "XLALMathOpOverArray() returned NAN for overIFOs->data[X=%d]", X );
+        overIFOs[X] = MathOpOverScratchArray(overSFTs, numSFTs, PSDmthopSFTs);
+        if ( XLAL_IS_REAL8_FAIL_NAN(overIFOs[X]) ) {
+          XLALPrintError ("%s: XLALMathOpOverArray() returned NAN for overIFOs->data[X=%d]\n", __func__, X );
+#pragma omp critical (XLALComputePSDandNormSFTPower)
+          errnum = XLAL_EFUNC;
+        }
 
-      } /* over IFOs */
+      } /* for IFOs X */
 
       /* compute math. operation over IFOs for this frequency */
-      (*normSFT)->data[k] = XLALMathOpOverArray(overIFOs->data, numIFOs, nSFTmthopIFOs);
-      XLAL_CHECK ( !XLAL_IS_REAL8_FAIL_NAN((*normSFT)->data[k]), XLAL_EFUNC, "XLALMathOpOverArray() returned NAN for normSFT->data[k=%d]", k );
+      (*finalPSD)->data[k] = MathOpOverScratchArray(overIFOs, numIFOs, PSDmthopIFOs);
+      if ( XLAL_IS_REAL8_FAIL_NAN((*finalPSD)->data[k]) ) {
+        XLALPrintError ("%s: XLALMathOpOverArray() returned NAN for finalPSD->data[k=%d]\n", __func__, k );
+#pragma omp critical (XLALComputePSDandNormSFTPower)
+        errnum = XLAL_EFUNC;
+        continue;
+      }
+
+      if ( normalizeByTotalNumSFTs ) {
+         (*finalPSD)->data[k] *= totalNumSFTsNormalizingFactor;
+      }
+
+      /* compute normalised SFT power */
+      if ( returnNormSFT ) {
+
+        /* loop over IFOs */
+        for (UINT4 X = 0; X < numIFOs; ++X) {
+
+          /* number of SFTs for this IFO */
+          UINT4 numSFTs = SFTs->data[X]->length;
+
+          /* compute SFT power */
+          for (UINT4 alpha = 0; alpha < numSFTs; ++alpha) {
+            COMPLEX8 bin = SFTs->data[X]->data[alpha].data->data[k];
+            overSFTs[alpha] = crealf(bin)*crealf(bin) + cimagf(bin)*cimagf(bin);
+          }
+
+          /* compute math. operation over SFTs for this IFO */
+          overIFOs[X] = MathOpOverScratchArray(overSFTs, numSFTs, nSFTmthopSFTs);
+          if ( XLAL_IS_REAL8_FAIL_NAN(overIFOs[X]) ) {
+            XLALPrintError ("%s: XLALMathOpOverArray() returned NAN for overIFOs->data[X=%d]\n", __func__, X );
+#pragma omp critical (XLALComputePSDandNormSFTPower)
+            errnum = XLAL_EFUNC;
+          }
+
+        } /* over IFOs */
+
+        /* compute math. operation over IFOs for this frequency */
+        (*normSFT)->data[k] = MathOpOverScratchArray(overIFOs, numIFOs, nSFTmthopIFOs);
+        if ( XLAL_IS_REAL8_FAIL_NAN((*normSFT)->data[k]) ) {
+          XLALPrintError ("%s: XLALMathOpOverArray() returned NAN for normSFT->data[k=%d]\n", __func__, k );
+#pragma omp critical (XLALComputePSDandNormSFTPower)
+          errnum = XLAL_EFUNC;
+        }
+
+      } /* if returnNormSFT */
 
-    } /* over freq bins */
-    XLAL_PRINT_INFO("done.");
-  } /* if returnNormSFT */
+    } /* for freq bins k */
+
+    if ( overIFOs != NULL ) {
+      XLALFree ( overIFOs );
+    }
+    if ( overSFTs != NULL ) {
+      XLALFree ( overSFTs );
+    }
+  } /* omp parallel */
+  XLAL_CHECK ( errnum == 0, errnum, "Failed to compute PSD and normalised SFT power" );
+  XLAL_PRINT_INFO("done.");
 
-  XLALDestroyREAL8Vector ( overSFTs );
-  XLALDestroyREAL8Vector ( overIFOs );
 
   if ( !returnMultiPSDVector ) {
     XLALDestroyMultiPSDVector ( *multiPSDVector );
@@ -2911,51 +2944,33 @@ REAL8 XLALMathOpOverArray ( const REAL8* data,      /**< input data array */
 
     break;
 
-   /* these cases require sorted data;
-    * we use gsl_sort_index() to avoid in-place modification of the input data
-    * by gsl_sort()
+   /* the median is found by selection on a copy of the input data,
+    * to avoid in-place modification of the input data
     */
    case MATH_OP_ARITHMETIC_MEDIAN:
-   case MATH_OP_MINIMUM:
-   case MATH_OP_MAXIMUM:
     ; /* empty statement because declaration cannot be first line in a switch case */
-    size_t * sortidx;
-    if ( ( sortidx = XLALMalloc ( length * sizeof(size_t) )) == NULL ) {
+    REAL8 *scratch;
+    if ( ( scratch = XLALMalloc ( length * sizeof(REAL8) )) == NULL ) {
         XLALPrintError ("XLALMalloc(%ld) failed.\n", length );
-        XLAL_ERROR ( XLAL_ENOMEM);
+        XLAL_ERROR_REAL8 ( XLAL_ENOMEM);
     }
-    gsl_sort_index(sortidx, data, 1, length);
-
-    switch (optype) {
-
-    case MATH_OP_ARITHMETIC_MEDIAN: /* middle element of sorted data */
-
-      if (length/2 == (length+1)/2) /* length is even */ {
-        res = (data[sortidx[length/2-1]] + data[sortidx[length/2]])/2;
-      }
-      else /* length is odd */ {
-        res = data[sortidx[length/2]];
-      }
-
-      break;
-
-    case MATH_OP_MINIMUM: /* first element of sorted data */
-
-      res = data[sortidx[0]];
-      break;
+    memcpy ( scratch, data, length * sizeof(REAL8) );
+    res = MathOpOverScratchArray ( scratch, length, optype );
+    XLALFree ( scratch );
+    break;
 
-    case MATH_OP_MAXIMUM: /* last element of sorted data */
+   case MATH_OP_MINIMUM: /* smallest element of data */
 
-      res = data[sortidx[length-1]];
-      break;
+    res = data[0];
+    for (i = 1; i < length; ++i) res = MIN(res, data[i]);
 
-    default:
+    break;
 
-      XLAL_ERROR_REAL8(XLAL_EINVAL, "For optype=%i this block should not have been reached.", optype);
+   case MATH_OP_MAXIMUM: /* largest element of data */
 
-    }
+    res = data[0];
+    for (i = 1; i < length; ++i) res = MAX(res, data[i]);
 
-    XLALFree ( sortidx );
     break;
 
   default:
@@ -2971,6 +2986,76 @@ REAL8 XLALMathOpOverArray ( const REAL8* data,      /**< input data array */
 
 
 
+/**
+ * Return the k-th smallest (counting from zero) of the entries of data[0..length-1],
+ * using Hoare's selection algorithm with a median-of-three pivot. The entries
+ * are reordered in place, such that on return all entries before index k are
+ * no larger than data[k], and all entries after index k are no smaller.
+ */
+static REAL8
+SelectKthSmallest ( REAL8 *data, const size_t length, const size_t k )
+{
+  INT8 lo = 0, hi = length - 1;
+  const INT8 kk = k;
+  while ( lo < hi ) {
+    const INT8 mid = lo + ( hi - lo ) / 2;
+    REAL8 tmp;
+#define SELECT_SWAP(a, b) do { tmp = data[a]; data[a] = data[b]; data[b] = tmp; } while (0)
+    if ( data[mid] < data[lo] ) SELECT_SWAP(mid, lo);
+    if ( data[hi] < data[lo] ) SELECT_SWAP(hi, lo);
+    if ( data[hi] < data[mid] ) SELECT_SWAP(hi, mid);
+    const REAL8 pivot = data[mid];
+    INT8 i = lo, j = hi;
+    while ( i <= j ) {
+      while ( data[i] < pivot ) ++i;
+      while ( pivot < data[j] ) --j;
+      if ( i <= j ) {
+        SELECT_SWAP(i, j);
+        ++i;
+        --j;
+      }
+    }
+#undef SELECT_SWAP
+    if ( kk <= j ) {
+      hi = j;
+    } else if ( kk >= i ) {
+      lo = i;
+    } else {
+      break;    /* data[j+1..i-1] all equal the pivot */
+    }
+  }
+  return data[k];
+} /* SelectKthSmallest() */
+
+
+/**
+ * Same as XLALMathOpOverArray(), but the entries of data[] may be reordered in place;
+ * this avoids allocating and sorting a copy of the data for order statistics,
+ * which are instead found by selection in O(length) time.
+ */
+static REAL8
+MathOpOverScratchArray ( REAL8 *data, const size_t length, const MathOpType optype )
+{
+  switch (optype) {
+
+  case MATH_OP_ARITHMETIC_MEDIAN: /* middle element of sorted data */
+    ; /* empty statement because declaration cannot be first line in a switch case */
+    const REAL8 upper = SelectKthSmallest ( data, length, length/2 );
+    if (length/2 == (length+1)/2) /* length is even: average with the largest entry below the upper median */ {
+      REAL8 lower = data[0];
+      for (size_t i = 1; i < length/2; ++i) lower = MAX(lower, data[i]);
+      return (lower + upper)/2;
+    }
+    return upper;
+
+  default:
+    return XLALMathOpOverArray ( data, length, optype );
+
+  } /* switch (optype) */
+
+} /* MathOpOverScratchArray() */
+
+
 /**
  * Compute an additional normalization factor from the total number of SFTs to be applied after a loop of mathops over SFTs and IFOs.
  *
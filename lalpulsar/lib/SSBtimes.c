@@ -24,6 +24,8 @@
 
 #include <lal/SSBtimes.h>
 #include <lal/AVFactories.h>
+#include <lal/SeqFactories.h>
+#include <lal/VectorMath.h>
 
 /* GSL includes */
 #include <lal/LALGSL.h>
@@ -611,6 +613,13 @@ XLALGetSSBtimes ( const DetectorStateSeries *DetectorStates,	/**< [in] detector-
 
     case SSBPREC_RELATIVISTICOPT:	/* use optimized version XLALBarycenterOpt() */
 
+      /* use precomputed barycentering quantities, if available, see XLALAddBarycenterCacheToDetectorStates() */
+      if ( DetectorStates->baryCache != NULL )
+        {
+          XLAL_CHECK_NULL ( XLALEvaluateBarycenterCache ( ret->DeltaT, ret->Tdot, DetectorStates->baryCache, alpha, delta, &refTime ) == XLAL_SUCCESS, XLAL_EFUNC );
+          break;
+        }
+
       baryinput.site = DetectorStates->detector;
       baryinput.site.location[0] /= LAL_C_SI;
       baryinput.site.location[1] /= LAL_C_SI;
@@ -699,6 +708,215 @@ XLALGetMultiSSBtimes ( const MultiDetectorStateSeries *multiDetStates, /**< [in]
 
 } /* XLALGetMultiSSBtimes() */
 
+/** Batched version of XLALGetSSBtimes(): compute the SSB-timings for \a numPos sky positions
+ *  at once, sharing the per-timestamp detector-state work across the whole batch.
+ *
+ *  For \c SSBPREC_NEWTONIAN the detector positions and velocities are gathered once into
+ *  contiguous arrays, and the Roemer dot-products \f$\vec{n}\cdot\vec{r}_\alpha\f$ are evaluated with
+ *  the VectorMath functions. For \c SSBPREC_RELATIVISTICOPT the barycentering cache of the
+ *  DetectorStateSeries (if present) is evaluated for each sky position. Other precisions fall
+ *  back to calling XLALGetSSBtimes() for each sky position.
+ *
+ *  \note The return struct is allocated here, use XLALDestroySSBtimesBatch() to free it.
+ */
+SSBtimesBatch *
+XLALGetSSBtimesBatch ( const DetectorStateSeries *DetectorStates,	/**< [in] detector-states at timestamps t_i */
+                       const SkyPosition *pos,				/**< [in] array of source sky-locations [in equatorial coords!] */
+                       UINT4 numPos,					/**< [in] number of sky-locations */
+                       LIGOTimeGPS refTime,				/**< [in] SSB reference-time T_0 of pulsar-parameters */
+                       SSBprecision precision				/**< [in] relativistic or Newtonian SSB transformation? */
+                       )
+{
+  XLAL_CHECK_NULL ( DetectorStates != NULL, XLAL_EINVAL, "Invalid NULL input 'DetectorStates'\n" );
+  XLAL_CHECK_NULL ( pos != NULL, XLAL_EINVAL, "Invalid NULL input 'pos'\n" );
+  XLAL_CHECK_NULL ( numPos > 0, XLAL_EINVAL, "Invalid zero-length 'pos'\n" );
+  XLAL_CHECK_NULL ( precision < SSBPREC_LAST, XLAL_EDOM, "Invalid value precision=%d, allowed are [0, %d]\n", precision, SSBPREC_LAST -1 );
+  for ( UINT4 k = 0; k < numPos; k++ )
+    {
+      XLAL_CHECK_NULL ( pos[k].system == COORDINATESYSTEM_EQUATORIAL, XLAL_EDOM, "Only equatorial coordinate system (=%d) allowed, got %d\n", COORDINATESYSTEM_EQUATORIAL, pos[k].system );
+    }
+
+  const UINT4 numSteps = DetectorStates->length;
+
+  // prepare output SSBtimesBatch struct
+  SSBtimesBatch *ret = XLALCalloc ( 1, sizeof(*ret) );
+  XLAL_CHECK_NULL ( ret != NULL, XLAL_ENOMEM );
+  ret->refTime = refTime;
+  ret->DeltaT = XLALCreateREAL8VectorSequence ( numPos, numSteps );
+  ret->Tdot = XLALCreateREAL8VectorSequence ( numPos, numSteps );
+  if ( ret->DeltaT == NULL || ret->Tdot == NULL )
+    {
+      XLALDestroySSBtimesBatch ( ret );
+      XLAL_ERROR_NULL ( XLAL_EFUNC, "XLALCreateREAL8VectorSequence(%u,%u) failed\n", numPos, numSteps );
+    }
+
+  switch ( precision )
+    {
+    case SSBPREC_NEWTONIAN:	/* use simple vr.vn to calculate time-delay */
+      {
+        // gather detector positions and velocities once for the whole batch
+        REAL8 *buf = XLALMalloc ( 8 * numSteps * sizeof(*buf) );
+        if ( buf == NULL )
+          {
+            XLALDestroySSBtimesBatch ( ret );
+            XLAL_ERROR_NULL ( XLAL_ENOMEM );
+          }
+        REAL8 *tMinusRef = buf, *r[3], *v[3], *tmp = buf + 7 * numSteps;
+        for ( UINT4 j = 0; j < 3; j++ )
+          {
+            r[j] = buf + ( 1 + j ) * numSteps;
+            v[j] = buf + ( 4 + j ) * numSteps;
+          }
+        for ( UINT4 i = 0; i < numSteps; i++ )
+          {
+            const DetectorState *state = &(DetectorStates->data[i]);
+            tMinusRef[i] = XLALGPSDiff ( &state->tGPS, &refTime );
+            for ( UINT4 j = 0; j < 3; j++ )
+              {
+                r[j][i] = state->rDetector[j];
+                v[j][i] = state->vDetector[j];
+              }
+          }
+
+        int errnum = 0;
+        for ( UINT4 k = 0; k < numPos && errnum == 0; k++ )
+          {
+            REAL8 vn[3];
+            vn[0] = cos(pos[k].longitude) * cos(pos[k].latitude);
+            vn[1] = sin(pos[k].longitude) * cos(pos[k].latitude);
+            vn[2] = sin(pos[k].latitude);
+
+            REAL8 *DeltaT = ret->DeltaT->data + k * numSteps;
+            REAL8 *Tdot = ret->Tdot->data + k * numSteps;
+
+            /* DeltaT_alpha = t_alpha - T_0 + vn.r_alpha */
+            errnum |= XLALVectorScaleREAL8 ( DeltaT, vn[0], r[0], numSteps );
+            for ( UINT4 j = 1; j < 3; j++ )
+              {
+                errnum |= XLALVectorScaleREAL8 ( tmp, vn[j], r[j], numSteps );
+                errnum |= XLALVectorAddREAL8 ( DeltaT, DeltaT, tmp, numSteps );
+              }
+            errnum |= XLALVectorAddREAL8 ( DeltaT, DeltaT, tMinusRef, numSteps );
+
+            /* Tdot_alpha = 1 + vn.v_alpha */
+            errnum |= XLALVectorScaleREAL8 ( Tdot, vn[0], v[0], numSteps );
+            for ( UINT4 j = 1; j < 3; j++ )
+              {
+                errnum |= XLALVectorScaleREAL8 ( tmp, vn[j], v[j], numSteps );
+                errnum |= XLALVectorAddREAL8 ( Tdot, Tdot, tmp, numSteps );
+              }
+            errnum |= XLALVectorShiftREAL8 ( Tdot, 1.0, Tdot, numSteps );
+          }
+        XLALFree ( buf );
+        if ( errnum != 0 )
+          {
+            XLALDestroySSBtimesBatch ( ret );
+            XLAL_ERROR_NULL ( XLAL_EFUNC, "VectorMath function failed\n" );
+          }
+      }
+      break;
+
+    case SSBPREC_RELATIVISTICOPT:	/* use precomputed sky-independent barycentering quantities */
+      {
+        /* build them here for several sky positions, if the detector states do not have them already */
+        DetectorStateSeries cached = (*DetectorStates);
+        if ( cached.baryCache == NULL && numPos > 1 )
+          {
+            if ( XLALAddBarycenterCacheToDetectorStates ( &cached ) != XLAL_SUCCESS )
+              {
+                XLALDestroySSBtimesBatch ( ret );
+                XLAL_ERROR_NULL ( XLAL_EFUNC, "XLALAddBarycenterCacheToDetectorStates() failed with xlalErrno = %d\n", xlalErrno );
+              }
+          }
+        if ( cached.baryCache != NULL )
+          {
+            int errnum = 0;
+            for ( UINT4 k = 0; k < numPos && errnum == 0; k++ )
+              {
+                REAL8Vector DeltaT = { .length = numSteps, .data = ret->DeltaT->data + k * numSteps };
+                REAL8Vector Tdot = { .length = numSteps, .data = ret->Tdot->data + k * numSteps };
+                errnum = XLALEvaluateBarycenterCache ( &DeltaT, &Tdot, cached.baryCache, pos[k].longitude, pos[k].latitude, &refTime );
+              }
+            if ( cached.baryCache != DetectorStates->baryCache )
+              {
+                XLALDestroyBarycenterCache ( cached.baryCache );
+              }
+            if ( errnum != XLAL_SUCCESS )
+              {
+                XLALDestroySSBtimesBatch ( ret );
+                XLAL_ERROR_NULL ( XLAL_EFUNC, "XLALEvaluateBarycenterCache() failed with xlalErrno = %d\n", xlalErrno );
+              }
+            break;
+          }
+      }
+      /* fall through */
+
+    default:	/* compute each sky position separately */
+      for ( UINT4 k = 0; k < numPos; k++ )
+        {
+          SSBtimes *tSSB = XLALGetSSBtimes ( DetectorStates, pos[k], refTime, precision );
+          if ( tSSB == NULL )
+            {
+              XLALDestroySSBtimesBatch ( ret );
+              XLAL_ERROR_NULL ( XLAL_EFUNC, "XLALGetSSBtimes() failed with xlalErrno = %d\n", xlalErrno );
+            }
+          memcpy ( ret->DeltaT->data + k * numSteps, tSSB->DeltaT->data, numSteps * sizeof(REAL8) );
+          memcpy ( ret->Tdot->data + k * numSteps, tSSB->Tdot->data, numSteps * sizeof(REAL8) );
+          XLALDestroySSBtimes ( tSSB );
+        }
+      break;
+
+    } /* switch precision */
+
+  return ret;
+
+} /* XLALGetSSBtimesBatch() */
+
+/** Multi-IFO version of XLALGetSSBtimesBatch().
+ *
+ * NOTE: this functions *allocates* the output-vector,
+ * use XLALDestroyMultiSSBtimesBatch() to free this.
+ */
+MultiSSBtimesBatch *
+XLALGetMultiSSBtimesBatch ( const MultiDetectorStateSeries *multiDetStates, /**< [in] detector-states at timestamps t_i */
+                            const SkyPosition *pos,		/**< [in] array of source sky-positions [in equatorial coords!] */
+                            UINT4 numPos,			/**< [in] number of sky-positions */
+                            LIGOTimeGPS refTime,		/**< [in] SSB reference-time T_0 for SSB-timing */
+                            SSBprecision precision		/**< [in] use relativistic or Newtonian SSB timing?  */
+                            )
+{
+  /* check input */
+  XLAL_CHECK_NULL ( multiDetStates != NULL, XLAL_EINVAL, "Invalid NULL input 'multiDetStates'\n");
+  XLAL_CHECK_NULL ( multiDetStates->length > 0, XLAL_EINVAL, "Invalid zero-length 'multiDetStates'\n");
+
+  UINT4 numDetectors = multiDetStates->length;
+
+  // prepare return struct
+  MultiSSBtimesBatch *ret = XLALCalloc ( 1, sizeof( *ret ) );
+  XLAL_CHECK_NULL ( ret != NULL, XLAL_ENOMEM );
+  ret->length = numDetectors;
+  ret->data = XLALCalloc ( numDetectors, sizeof ( *ret->data ) );
+  if ( ret->data == NULL )
+    {
+      XLALFree ( ret );
+      XLAL_ERROR_NULL ( XLAL_ENOMEM );
+    }
+
+  // loop over detectors
+  for ( UINT4 X = 0; X < numDetectors; X ++ )
+    {
+      ret->data[X] = XLALGetSSBtimesBatch ( multiDetStates->data[X], pos, numPos, refTime, precision );
+      if ( ret->data[X] == NULL )
+        {
+          XLALDestroyMultiSSBtimesBatch ( ret );
+          XLAL_ERROR_NULL ( XLAL_EFUNC, "ret->data[%d] = XLALGetSSBtimesBatch() failed with xlalErrno = %d\n", X, xlalErrno );
+        }
+    } /* for X < numDet */
+
+  return ret;
+
+} /* XLALGetMultiSSBtimesBatch() */
+
 /** Find the earliest timestamp in a multi-SSB data structure
  *
 */
@@ -877,3 +1095,43 @@ XLALDestroyMultiSSBtimes ( MultiSSBtimes *multiSSB )
   return;
 
 } /* XLALDestroyMultiSSBtimes() */
+
+/** Destroy a SSBtimesBatch structure.
+ * Note, this is "NULL-robust" in the sense that it will not crash
+ * on NULL-entries anywhere in this struct, so it can be used
+ * for failure-cleanup even on incomplete structs
+ */
+void
+XLALDestroySSBtimesBatch ( SSBtimesBatch *tSSB )
+{
+  if ( ! tSSB )
+    return;
+
+  XLALDestroyREAL8VectorSequence ( tSSB->DeltaT );
+  XLALDestroyREAL8VectorSequence ( tSSB->Tdot );
+  XLALFree ( tSSB );
+
+} /* XLALDestroySSBtimesBatch() */
+
+/** Destroy a MultiSSBtimesBatch structure.
+ * Note, this is "NULL-robust" in the sense that it will not crash
+ * on NULL-entries anywhere in this struct, so it can be used
+ * for failure-cleanup even on incomplete structs
+ */
+void
+XLALDestroyMultiSSBtimesBatch ( MultiSSBtimesBatch *multiSSB )
+{
+  if ( ! multiSSB )
+    return;
+
+  if ( multiSSB->data )
+    {
+      for ( UINT4 X = 0; X < multiSSB->length; X ++ )
+        {
+          XLALDestroySSBtimesBatch ( multiSSB->data[X] );
+        }
+      XLALFree ( multiSSB->data );
+    }
+  XLALFree ( multiSSB );
+
+} /* XLALDestroyMultiSSBtimesBatch() */
@@ -69,6 +69,21 @@ typedef struct tagMultiSSBtimes {
   SSBtimes **data;	/**< array of SSBtimes (pointers) */
 } MultiSSBtimes;
 
+/** Container for the SSB-timings DeltaT_alpha and Tdot_alpha of a batch of sky positions,
+ * stored as one row per sky position with one entry per SFT-timestamp.
+ */
+typedef struct tagSSBtimesBatch {
+  LIGOTimeGPS refTime;		/**< reference-time 'tau0' */
+  REAL8VectorSequence *DeltaT;	/**< Time-difference of SFT-alpha - tau0 in SSB-frame; row k is for sky position k */
+  REAL8VectorSequence *Tdot;	/**< dT/dt : time-derivative of SSB-time wrt local time for SFT-alpha; row k is for sky position k */
+} SSBtimesBatch;
+
+/** Multi-IFO container for SSB timings of a batch of sky positions */
+typedef struct tagMultiSSBtimesBatch {
+  UINT4 length;			/**< number of IFOs */
+  SSBtimesBatch **data;		/**< array of SSBtimesBatch (pointers) */
+} MultiSSBtimesBatch;
+
 /*---------- exported Global variables ----------*/
 
 /*---------- exported prototypes [API] ----------*/
@@ -79,6 +94,8 @@ MultiSSBtimes *XLALDuplicateMultiSSBtimes ( const MultiSSBtimes *multiSSB );
 
 SSBtimes *XLALGetSSBtimes ( const DetectorStateSeries *DetectorStates, SkyPosition pos, LIGOTimeGPS refTime, SSBprecision precision );
 MultiSSBtimes *XLALGetMultiSSBtimes ( const MultiDetectorStateSeries *multiDetStates, SkyPosition skypos, LIGOTimeGPS refTime, SSBprecision precision);
+SSBtimesBatch *XLALGetSSBtimesBatch ( const DetectorStateSeries *DetectorStates, const SkyPosition *pos, UINT4 numPos, LIGOTimeGPS refTime, SSBprecision precision );
+MultiSSBtimesBatch *XLALGetMultiSSBtimesBatch ( const MultiDetectorStateSeries *multiDetStates, const SkyPosition *pos, UINT4 numPos, LIGOTimeGPS refTime, SSBprecision precision );
 
 int XLALEarliestMultiSSBtime ( LIGOTimeGPS *out, const MultiSSBtimes *multiSSB, const REAL8 Tsft );
 int XLALLatestMultiSSBtime ( LIGOTimeGPS *out, const MultiSSBtimes *multiSSB,  const REAL8 Tsft );
@@ -86,6 +103,8 @@ int XLALLatestMultiSSBtime ( LIGOTimeGPS *out, const MultiSSBtimes *multiSSB,  c
 /* destructors */
 void XLALDestroySSBtimes ( SSBtimes *multiSSB );
 void XLALDestroyMultiSSBtimes ( MultiSSBtimes *multiSSB );
+void XLALDestroySSBtimesBatch ( SSBtimesBatch *tSSB );
+void XLALDestroyMultiSSBtimesBatch ( MultiSSBtimesBatch *multiSSB );
 
 /** @} */
 
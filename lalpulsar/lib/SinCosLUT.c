@@ -21,6 +21,10 @@
 
 #include <math.h>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 #include <lal/SinCosLUT.h>
 
 #define OOTWOPI         (1.0 / LAL_TWOPI)      // 1/2pi
@@ -135,3 +139,77 @@ int XLALSinCos2PiLUTtrimmed ( REAL4 *s, REAL4 *c, REAL8 x )
   return XLAL_SUCCESS;
 
 } /* XLALSinCos2PiLUTtrimmed() */
+
+///
+/// Calculate sin(2*pi*x[i]) and cos(2*pi*x[i]) for \p len arguments, using the same lookup-table
+/// and Taylor-expansion as XLALSinCos2PiLUT(), and giving the same results. If compiled with AVX2
+/// support, 4 arguments are processed at a time; otherwise, the loop uses only local variables so
+/// that it may be vectorised by the compiler.
+///
+/// \note This function will fail for arguments larger than |x| > INT4_MAX = 2147483647 ~ 2e9 !!!
+///
+/// Returns XLAL_SUCCESS or XLAL_FAILURE.
+///
+int
+XLALSinCos2PiLUTVector ( REAL4 *sin2pix, REAL4 *cos2pix, const REAL8 *x, UINT4 len )
+{
+  if ( len == 0 ) {
+    return XLAL_SUCCESS;
+  }
+  XLAL_CHECK ( sin2pix != NULL && cos2pix != NULL && x != NULL, XLAL_EFAULT );
+
+  /* the first time we get called, we set up the lookup-table */
+  if ( ! haveLUT ) {
+    XLALSinCosLUTInit();
+  }
+
+  UINT4 i = 0;
+
+#if defined(__AVX2__)
+  {
+    const __m256d one = _mm256_set1_pd ( 1.0 );
+    const __m256d adds = _mm256_set1_pd ( SINCOS_ADDS );
+    const __m256i lo32 = _mm256_setr_epi32 ( 0, 2, 4, 6, 1, 3, 5, 7 );
+    const __m128i mask1 = _mm_set1_epi32 ( SINCOS_MASK1 );
+    const __m128i mask2 = _mm_set1_epi32 ( SINCOS_MASK2 );
+    for ( ; i + 4 <= len; i += 4 )
+      {
+        /* trim the values x to interval [0..2), as SINCOS_TRIM_X() */
+        const __m256d xi = _mm256_loadu_pd ( &x[i] );
+        const __m256d xt = _mm256_add_pd ( _mm256_sub_pd ( xi, _mm256_round_pd ( xi, _MM_FROUND_CUR_DIRECTION ) ), one );
+
+        /* extract the lower 32 bits of (xt + SINCOS_ADDS), as SINCOS_STEP1..4 */
+        const __m256i ux = _mm256_castpd_si256 ( _mm256_add_pd ( xt, adds ) );
+        const __m128i ix = _mm256_castsi256_si128 ( _mm256_permutevar8x32_epi32 ( ux, lo32 ) );
+        const __m128i si = _mm_srai_epi32 ( _mm_and_si128 ( ix, mask1 ), SINCOS_SHIFT );
+        const __m128 sn = _mm_cvtepi32_ps ( _mm_and_si128 ( ix, mask2 ) );
+
+        /* look up tables, as SINCOS_STEP5..6 */
+        const __m128 sbase = _mm_i32gather_ps ( sincosLUTbase, si, 4 );
+        const __m128 sdiff = _mm_i32gather_ps ( sincosLUTdiff, si, 4 );
+        const __m128 cbase = _mm_i32gather_ps ( cosLUTbase, si, 4 );
+        const __m128 cdiff = _mm_i32gather_ps ( cosLUTdiff, si, 4 );
+        _mm_storeu_ps ( &sin2pix[i], _mm_add_ps ( sbase, _mm_mul_ps ( sn, sdiff ) ) );
+        _mm_storeu_ps ( &cos2pix[i], _mm_add_ps ( cbase, _mm_mul_ps ( sn, cdiff ) ) );
+      }
+  }
+#endif
+
+  for ( ; i < len; i ++ )
+    {
+      /* trim the value x to interval [0..2) */
+      REAL8 xt;
+      SINCOS_TRIM_X(xt,x[i]);
+
+      /* same as SINCOS_STEP1..6, but using local variables */
+      union { REAL8 asreal; UINT8 asint; } ux = { .asreal = xt + SINCOS_ADDS };
+      const INT4 ix = (INT4) ( ux.asint & 0xFFFFFFFF );
+      const INT4 si = ( ix & SINCOS_MASK1 ) >> SINCOS_SHIFT;
+      const INT4 sn = ix & SINCOS_MASK2;
+      sin2pix[i] = sincosLUTbase[si] + sn * sincosLUTdiff[si];
+      cos2pix[i] = cosLUTbase[si]    + sn * cosLUTdiff[si];
+    }
+
+  return XLAL_SUCCESS;
+
+} /* XLALSinCos2PiLUTVector() */
@@ -40,6 +40,7 @@ void XLALSinCosLUTInit (void);
 int XLALSinCosLUT ( REAL4 *sinx, REAL4 *cosx, REAL8 x );
 int XLALSinCos2PiLUT ( REAL4 *sin2pix, REAL4 *cos2pix, REAL8 x );
 int XLALSinCos2PiLUTtrimmed ( REAL4 *s, REAL4 *c, REAL8 x );
+int XLALSinCos2PiLUTVector ( REAL4 *sin2pix, REAL4 *cos2pix, const REAL8 *x, UINT4 len );
 // @}
 
 #ifdef  __cplusplus
@@ -656,30 +656,79 @@ SuperskyMetrics *XLALComputeSuperskyMetrics(
   gsl_matrix *GAMAT_NULL( ussky_metric_avg, 4 + spindowns, 4 + spindowns );
   gsl_matrix *GAMAT_NULL( orbital_metric_avg, 3 + spindowns, 3 + spindowns );
 
-  // Compute the coherent supersky metrics for each segment
+  // Allocate memory for the unrestricted supersky and orbital metrics of each segment
+  gsl_matrix **ussky_metric_seg = XLALCalloc( metrics->num_segments, sizeof( *ussky_metric_seg ) );
+  XLAL_CHECK_NULL( ussky_metric_seg != NULL, XLAL_ENOMEM );
+  gsl_matrix **orbital_metric_seg = XLALCalloc( metrics->num_segments, sizeof( *orbital_metric_seg ) );
+  XLAL_CHECK_NULL( orbital_metric_seg != NULL, XLAL_ENOMEM );
+
+  // Turn off GSL error handling while the segments are computed in parallel; XLALComputeDopplerPhaseMetric()
+  // otherwise saves and restores the (global) GSL error handler from each thread, which is not thread-safe
+  gsl_error_handler_t *saveGSLErrorHandler = gsl_set_error_handler_off();
+
+  // Compute the coherent supersky metrics for each segment; segments are independent, and share only
+  // read-only input (detectors, weights, ephemerides), so are computed in parallel when OpenMP is available
+  int errnum = XLAL_SUCCESS;
+#pragma omp parallel for schedule(dynamic)
   for ( size_t n = 0; n < metrics->num_segments; ++n ) {
+    int segerrnum = XLAL_SUCCESS;
+#pragma omp flush(errnum)
+    if ( errnum != XLAL_SUCCESS ) {
+      continue;
+    }
     const LIGOTimeGPS *start_time_seg = &segments->segs[n].start;
     const LIGOTimeGPS *end_time_seg = &segments->segs[n].end;
 
     // Compute the unrestricted supersky metric
-    gsl_matrix *ussky_metric_seg = SM_ComputePhaseMetric( &ucoords, ref_time, start_time_seg, end_time_seg, detectors, detector_weights, detector_motion, ephemerides );
-    XLAL_CHECK_NULL( ussky_metric_seg != NULL, XLAL_EFUNC );
-    gsl_matrix_add( ussky_metric_avg, ussky_metric_seg );
+    ussky_metric_seg[n] = SM_ComputePhaseMetric( &ucoords, ref_time, start_time_seg, end_time_seg, detectors, detector_weights, detector_motion, ephemerides );
+    if ( ussky_metric_seg[n] == NULL ) {
+      segerrnum = XLAL_EFUNC;
+    }
 
     // Compute the orbital metric in ecliptic coordinates
-    gsl_matrix *orbital_metric_seg = SM_ComputePhaseMetric( &ocoords, ref_time, start_time_seg, end_time_seg, detectors, detector_weights, detector_motion, ephemerides );
-    XLAL_CHECK_NULL( orbital_metric_seg != NULL, XLAL_EFUNC );
-    gsl_matrix_add( orbital_metric_avg, orbital_metric_seg );
+    if ( segerrnum == XLAL_SUCCESS ) {
+      orbital_metric_seg[n] = SM_ComputePhaseMetric( &ocoords, ref_time, start_time_seg, end_time_seg, detectors, detector_weights, detector_motion, ephemerides );
+      if ( orbital_metric_seg[n] == NULL ) {
+        segerrnum = XLAL_EFUNC;
+      }
+    }
 
     // Compute the coherent reduced supersky metric
-    XLAL_CHECK_NULL( SM_ComputeReducedSuperskyMetric( &metrics->coh_rssky_metric[n], &metrics->coh_rssky_transf[n], spindowns, ussky_metric_seg, &ucoords, orbital_metric_seg, &ocoords, ref_time, start_time_seg, end_time_seg ) == XLAL_SUCCESS, XLAL_EFUNC );
-    LogPrintf( LOG_DEBUG, "Computed coherent reduced supersky metric for segment %zu/%zu\n", n, metrics->num_segments );
+    if ( segerrnum == XLAL_SUCCESS ) {
+      if ( SM_ComputeReducedSuperskyMetric( &metrics->coh_rssky_metric[n], &metrics->coh_rssky_transf[n], spindowns, ussky_metric_seg[n], &ucoords, orbital_metric_seg[n], &ocoords, ref_time, start_time_seg, end_time_seg ) != XLAL_SUCCESS ) {
+        segerrnum = XLAL_EFUNC;
+      } else {
+        LogPrintf( LOG_DEBUG, "Computed coherent reduced supersky metric for segment %zu/%zu\n", n, metrics->num_segments );
+      }
+    }
 
-    // Cleanup
-    GFMAT( ussky_metric_seg, orbital_metric_seg );
+    if ( segerrnum != XLAL_SUCCESS ) {
+#pragma omp critical(XLALComputeSuperskyMetrics_errnum)
+      errnum = segerrnum;
+    }
 
   }
 
+  // Restore GSL error handling
+  gsl_set_error_handler( saveGSLErrorHandler );
+
+  // Sum the unrestricted supersky and orbital metrics over segments, in segment order so that the result does
+  // not depend on the number of threads
+  if ( errnum == XLAL_SUCCESS ) {
+    for ( size_t n = 0; n < metrics->num_segments; ++n ) {
+      gsl_matrix_add( ussky_metric_avg, ussky_metric_seg[n] );
+      gsl_matrix_add( orbital_metric_avg, orbital_metric_seg[n] );
+    }
+  }
+
+  // Cleanup
+  for ( size_t n = 0; n < metrics->num_segments; ++n ) {
+    GFMAT( ussky_metric_seg[n], orbital_metric_seg[n] );
+  }
+  XLALFree( ussky_metric_seg );
+  XLALFree( orbital_metric_seg );
+  XLAL_CHECK_NULL( errnum == XLAL_SUCCESS, errnum, "Computing coherent reduced supersky metrics failed" );
+
   // Normalise averaged metrics by number of segments
   gsl_matrix_scale( ussky_metric_avg, 1.0 / metrics->num_segments );
   gsl_matrix_scale( orbital_metric_avg, 1.0 / metrics->num_segments );
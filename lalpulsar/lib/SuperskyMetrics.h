@@ -78,6 +78,7 @@ typedef struct tagSuperskyMetrics {
 
 ///
 /// Compute the supersky metrics, which are returned in a \c SuperskyMetrics struct.
+/// If compiled with OpenMP, the coherent metrics of each segment are computed in parallel.
 ///
 SuperskyMetrics *XLALComputeSuperskyMetrics(
   const SuperskyMetricType type,                ///< [in] Type of supersky metric to compute
@@ -23,6 +23,7 @@
 /* GSL includes */
 #include <gsl/gsl_blas.h>
 #include <gsl/gsl_linalg.h>
+#include <gsl/gsl_randist.h>
 
 #include <lal/SynthesizeCWDraws.h>
 
@@ -30,10 +31,34 @@
 
 /*---------- DEFINES ----------*/
 #define SQ(x) ((x)*(x))
+#define SYNTH_DRAWS_BLOCK_LENGTH 256	/* number of draws processed at a time by XLALSynthesizeCWDraws() */
 
 /*----- SWITCHES -----*/
 /*---------- internal types ----------*/
 
+/* pre-computed per-detector quantities for one sky position */
+typedef struct tagSynthCWDrawsDet_t {
+  REAL4 A, B, C;		/* per-detector antenna-pattern matrix coefficients {A^X,B^X,C^X} */
+  REAL4 Dinv;			/* inverse determinant 1/D^X, or 0 if ill-conditioned */
+  REAL8 L11, L21, L22;		/* Cholesky factor of M^X/2, the covariance of {Re,Im}{Fa^X,Fb^X} in Gaussian noise */
+} SynthCWDrawsDet_t;
+
+/* pre-computed multi-detector quantities for one sky position */
+typedef struct tagSynthCWDrawsMulti_t {
+  REAL4 A, B, C;		/* multi-detector antenna-pattern matrix coefficients {A,B,C} */
+  REAL4 Dinv;			/* inverse determinant 1/D, or 0 if ill-conditioned */
+  REAL8 detM1o8;		/* (detM)^(1/8) = sqrt(Tsft/Sn) * (A*B-C^2)^(1/4), see XLALSynthesizeTransientAtoms() */
+} SynthCWDrawsMulti_t;
+
+/* opaque table of pre-tabulated antenna-pattern matrices */
+struct tagSynthCWDrawsTable_t {
+  UINT4 numDetectors;			/* number of detectors */
+  UINT4 numSkypos;			/* number of tabulated sky positions */
+  REAL8 TAtom[PULSAR_MAX_DETECTORS];	/* per-detector atoms time baseline */
+  SynthCWDrawsDet_t *det;		/* per-detector quantities, indexed by [k * numDetectors + X] for sky position k */
+  SynthCWDrawsMulti_t *multi;		/* multi-detector quantities, indexed by sky position */
+};
+
 /*---------- Global variables ----------*/
 
 /*---------- internal prototypes ----------*/
@@ -801,3 +826,263 @@ write_InjParams_to_fp ( FILE * fp,			/**< [in] file-pointer to output file */
 
 } /* write_InjParams_to_fp() */
 
+
+/**
+ * Pre-tabulate the antenna-pattern matrices required by XLALSynthesizeCWDraws() for a set of sky positions.
+ *
+ * The antenna-pattern coefficients for all sky positions are computed at once using XLALComputeMultiAMCoeffsBatch(),
+ * and reduced to the per-detector and multi-detector matrices \f$\mathcal{M}^X_{\mu\nu}\f$, \f$\mathcal{M}_{\mu\nu}\f$
+ * and the Cholesky factors used to synthesize correlated noise. The per-SFT antenna-pattern functions are not kept.
+ */
+SynthCWDrawsTable_t *
+XLALCreateSynthCWDrawsTable ( const MultiDetectorStateSeries *multiDetStates,	/**< [in] multi-detector state series covering observation time */
+                              const MultiNoiseWeights *multiNoiseWeights,	/**< [in] per-detector noise weights SX^-1/S^-1, no per-SFT variation (can be NULL for unit weights) */
+                              const SkyPosition *skypos,			/**< [in] sky positions to tabulate */
+                              const UINT4 numSkypos				/**< [in] number of sky positions */
+                              )
+{
+  XLAL_CHECK_NULL ( multiDetStates != NULL && multiDetStates->data != NULL, XLAL_EINVAL, "Invalid NULL input 'multiDetStates'\n" );
+  XLAL_CHECK_NULL ( multiDetStates->length > 0 && multiDetStates->length <= PULSAR_MAX_DETECTORS, XLAL_EINVAL, "Invalid number of detectors %u\n", multiDetStates->length );
+  XLAL_CHECK_NULL ( !multiNoiseWeights || multiNoiseWeights->data, XLAL_EINVAL, "Invalid NULL input for multiNoiseWeights->data!\n" );
+  XLAL_CHECK_NULL ( skypos != NULL && numSkypos > 0, XLAL_EINVAL, "Need at least one sky position\n" );
+
+  const UINT4 numDet = multiDetStates->length;
+
+  /* allocate table */
+  SynthCWDrawsTable_t *table = XLALCalloc ( 1, sizeof ( *table ) );
+  XLAL_CHECK_NULL ( table != NULL, XLAL_ENOMEM );
+  table->numDetectors = numDet;
+  table->numSkypos = numSkypos;
+  for ( UINT4 X = 0; X < numDet; X ++ ) {
+    table->TAtom[X] = multiDetStates->data[X]->deltaT;
+  }
+  table->det = XLALCalloc ( numSkypos * numDet, sizeof ( table->det[0] ) );
+  table->multi = XLALCalloc ( numSkypos, sizeof ( table->multi[0] ) );
+  if ( table->det == NULL || table->multi == NULL ) {
+    XLALDestroySynthCWDrawsTable ( table );
+    XLAL_ERROR_NULL ( XLAL_ENOMEM );
+  }
+
+  /* compute antenna-pattern coefficients for all sky positions */
+  MultiAMCoeffs **multiAM = XLALCalloc ( numSkypos, sizeof ( multiAM[0] ) );
+  if ( multiAM == NULL ) {
+    XLALDestroySynthCWDrawsTable ( table );
+    XLAL_ERROR_NULL ( XLAL_ENOMEM );
+  }
+  if ( XLALComputeMultiAMCoeffsBatch ( multiAM, multiDetStates, multiNoiseWeights, skypos, numSkypos ) != XLAL_SUCCESS ) {
+    XLALFree ( multiAM );
+    XLALDestroySynthCWDrawsTable ( table );
+    XLAL_ERROR_NULL ( XLAL_EFUNC );
+  }
+
+  /* reduce to the quantities needed to synthesize draws */
+  for ( UINT4 k = 0; k < numSkypos; k ++ )
+    {
+      REAL8 Ad = 0, Bd = 0, Cd = 0, Sinv_Tsft = 0;
+      for ( UINT4 X = 0; X < numDet; X ++ )
+        {
+          SynthCWDrawsDet_t *det = &table->det[k * numDet + X];
+          const AMCoeffs *amX = multiAM[k]->data[X];
+          det->A = amX->A;
+          det->B = amX->B;
+          det->C = amX->C;
+          REAL4 DX = XLALComputeAntennaPatternSqrtDeterminant ( det->A, det->B, det->C, 0 );
+          det->Dinv = ( DX > 0 ) ? 1.0f / DX : 0;
+
+          /* covariance of {Fa^X,Fb^X} in Gaussian noise, separately for real and imaginary parts: M^X/2 = [ A, C ; C, B ] / 2 */
+          det->L11 = sqrt ( 0.5 * det->A );
+          det->L21 = ( det->L11 > 0 ) ? 0.5 * det->C / det->L11 : 0;
+          det->L22 = sqrt ( fmax ( 0, 0.5 * det->B - SQ ( det->L21 ) ) );
+
+          Ad += det->A;
+          Bd += det->B;
+          Cd += det->C;
+          Sinv_Tsft += table->TAtom[X];	/* everything here in units of Sn, so effectively Sn=1 */
+        }
+      SynthCWDrawsMulti_t *multi = &table->multi[k];
+      multi->A = Ad;
+      multi->B = Bd;
+      multi->C = Cd;
+      REAL4 D = XLALComputeAntennaPatternSqrtDeterminant ( multi->A, multi->B, multi->C, 0 );
+      multi->Dinv = ( D > 0 ) ? 1.0f / D : 0;
+      multi->detM1o8 = sqrt ( Sinv_Tsft ) * pow ( Ad * Bd - SQ ( Cd ), 0.25 );
+
+      XLALDestroyMultiAMCoeffs ( multiAM[k] );
+    } /* for k < numSkypos */
+
+  XLALFree ( multiAM );
+
+  return table;
+
+} /* XLALCreateSynthCWDrawsTable() */
+
+/**
+ * Free a table created by XLALCreateSynthCWDrawsTable()
+ */
+void
+XLALDestroySynthCWDrawsTable ( SynthCWDrawsTable_t *table )
+{
+  if ( table == NULL ) {
+    return;
+  }
+  XLALFree ( table->det );
+  XLALFree ( table->multi );
+  XLALFree ( table );
+  return;
+} /* XLALDestroySynthCWDrawsTable() */
+
+/**
+ * Synthesize many draws of the multi- and per-detector F-statistics \f$2\mathcal{F}\f$, \f$\{2\mathcal{F}^X\}\f$
+ * for persistent CW signals in Gaussian noise, using the antenna-pattern matrices pre-tabulated by XLALCreateSynthCWDrawsTable().
+ *
+ * This draws the same distribution as XLALSynthesizeTransientAtoms() with a rectangular transient-window (TRANSIENT_NONE)
+ * followed by XLALComputeFstatFromAtoms(), but avoids synthesizing the atoms: summed over atoms, the noise in
+ * \f$\{F_a^X,F_b^X\}\f$ is Gaussian with covariance \f$\mathcal{M}^X_{\mu\nu}/2\f$ for each of the real and imaginary parts,
+ * and the signal is \f$\sqrt{T/2}\,\mathcal{M}^X_{\mu\nu}\mathcal{A}^\nu\f$. Each draw therefore needs only four normal
+ * variates per detector, drawn with gsl_ran_gaussian_ziggurat(), and draws are processed in blocks to allow vectorisation.
+ *
+ * If more than one sky position was tabulated, each draw uses a sky position chosen uniformly at random from the table,
+ * e.g. an isotropic sky grid for all-sky studies. Amplitude parameters, fixed-SNR, and fixed-rhohMax rescaling follow
+ * XLALSynthesizeTransientAtoms(), but since random numbers are consumed in a different order, individual draws are not
+ * reproduced.
+ */
+int
+XLALSynthesizeCWDraws ( REAL4 *twoF,					/**< [out] multi-detector F-stats \f$2\mathcal{F}\f$ of all draws (can be NULL) */
+                        REAL4 *twoFPerDet[PULSAR_MAX_DETECTORS],		/**< [out] per-detector F-stats \f$2\mathcal{F}^X\f$ of all draws (can be NULL, as can each twoFPerDet[X]) */
+                        REAL4 *SNR,					/**< [out] optimal SNR of the injected signal for all draws (can be NULL) */
+                        const UINT4 numDraws,				/**< [in] number of draws */
+                        const SynthCWDrawsTable_t *table,		/**< [in] pre-tabulated antenna-pattern matrices from XLALCreateSynthCWDrawsTable() */
+                        AmplitudePrior_t AmpPrior,			/**< [in] amplitude-parameter priors to draw signals from */
+                        const BOOLEAN SignalOnly,			/**< [in] switch to generate signal draws without noise */
+                        const INT4 lineX,				/**< [in] if >= 0: generate signal only for detector 'lineX': must be within 0,...(Ndet-1) */
+                        gsl_rng *rng					/**< [in/out] gsl random-number generator */
+                        )
+{
+  XLAL_CHECK ( table != NULL && rng != NULL, XLAL_EINVAL, "Invalid NULL input!\n" );
+  const UINT4 numDet = table->numDetectors;
+  XLAL_CHECK ( (lineX < 0) || ((UINT4)lineX < numDet), XLAL_EINVAL, "Inconsistent input of lineX = %d, not within 0 ... Ndet-1 (= %d)\n", lineX, numDet );
+  XLAL_CHECK ( (AmpPrior.fixedSNR <= 0) || !AmpPrior.fixRhohMax, XLAL_EDOM, "Both [fixedSNR = %f > 0] and [fixedRhohMax==true] are not allowed!\n", AmpPrior.fixedSNR );
+  const BOOLEAN drawAmp = ( AmpPrior.fixedSNR != 0 );		/* same as setting h0 = 0 otherwise */
+  XLAL_CHECK ( !drawAmp || ( AmpPrior.pdf_cosi && AmpPrior.pdf_psi && AmpPrior.pdf_phi0 ), XLAL_EINVAL, "Invalid NULL amplitude-prior pdf\n" );
+  XLAL_CHECK ( !drawAmp || ( AmpPrior.fixedSNR > 0 ) || AmpPrior.pdf_h0Nat, XLAL_EINVAL, "Invalid NULL amplitude-prior pdf_h0Nat\n" );
+
+  UINT4 sky[SYNTH_DRAWS_BLOCK_LENGTH];
+  PulsarAmplitudeVect A_Mu[SYNTH_DRAWS_BLOCK_LENGTH];
+  REAL8 FaRe[SYNTH_DRAWS_BLOCK_LENGTH], FaIm[SYNTH_DRAWS_BLOCK_LENGTH], FbRe[SYNTH_DRAWS_BLOCK_LENGTH], FbIm[SYNTH_DRAWS_BLOCK_LENGTH];
+  REAL8 g[4][SYNTH_DRAWS_BLOCK_LENGTH];
+
+  for ( UINT4 i0 = 0; i0 < numDraws; i0 += SYNTH_DRAWS_BLOCK_LENGTH )
+    {
+      const UINT4 n = ( numDraws - i0 < SYNTH_DRAWS_BLOCK_LENGTH ) ? ( numDraws - i0 ) : SYNTH_DRAWS_BLOCK_LENGTH;
+
+      /* ----- draw sky positions and amplitude parameters, and rescale signals to fixed SNR or rhohMax if requested */
+      for ( UINT4 j = 0; j < n; j ++ )
+        {
+          sky[j] = ( table->numSkypos > 1 ) ? gsl_rng_uniform_int ( rng, table->numSkypos ) : 0;
+          const SynthCWDrawsDet_t *det = &table->det[sky[j] * numDet];
+
+          if ( !drawAmp ) {
+            A_Mu[j][0] = A_Mu[j][1] = A_Mu[j][2] = A_Mu[j][3] = 0;
+            if ( SNR ) {
+              SNR[i0 + j] = 0;
+            }
+            continue;
+          }
+
+          REAL8 h0 = ( AmpPrior.fixedSNR > 0 ) ? 1.0 : XLALDrawFromPDF1D ( AmpPrior.pdf_h0Nat, rng );	/* fixed-SNR: use h0=1, later rescale signal */
+          REAL8 cosi = XLALDrawFromPDF1D ( AmpPrior.pdf_cosi, rng );
+          PulsarAmplitudeParams Amp;
+          Amp.aPlus = 0.5 * h0 * (1.0 + SQ(cosi));
+          Amp.aCross = h0 * cosi;
+          Amp.psi  = XLALDrawFromPDF1D ( AmpPrior.pdf_psi,  rng );
+          Amp.phi0 = XLALDrawFromPDF1D ( AmpPrior.pdf_phi0, rng );
+          XLAL_CHECK ( xlalErrno == 0, XLAL_EFUNC, "XLALDrawFromPDF1D() failed with xlalErrno = %d\n", xlalErrno );
+          XLAL_CHECK ( XLALAmplitudeParams2Vect ( A_Mu[j], Amp ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+          /* optimal SNR^2 = sum_X T_X ( A_X [A1^2+A3^2] + 2C_X [A1A2 +A3A4] + B_X [A2^2+A4^2] ), only over the line detector if lineX >= 0 */
+          const REAL8 A1 = A_Mu[j][0], A2 = A_Mu[j][1], A3 = A_Mu[j][2], A4 = A_Mu[j][3];
+          REAL8 rho2 = 0;
+          for ( UINT4 X = 0; X < numDet; X ++ ) {
+            if ( (lineX >= 0) && ((UINT4)lineX != X) ) {
+              continue;
+            }
+            rho2 += table->TAtom[X] * ( det[X].A * ( SQ(A1) + SQ(A3) ) + 2.0 * det[X].C * ( A1*A2 + A3*A4 ) + det[X].B * ( SQ(A2) + SQ(A4) ) );
+          }
+
+          REAL8 rescale = 1.0;
+          if ( AmpPrior.fixedSNR > 0 ) {
+            rescale = AmpPrior.fixedSNR / sqrt(rho2);	/* rescale signal by this factor, such that SNR = fixedSNR */
+          }
+          if ( AmpPrior.fixRhohMax ) {
+            rescale = 1.0 / table->multi[sky[j]].detM1o8;	/* we drew h0 in [0, rhohMax], so we now need to rescale as h0Max = rhohMax/(detM)^(1/8) */
+          }
+          for ( UINT4 mu = 0; mu < 4; mu ++ ) {
+            A_Mu[j][mu] *= rescale;
+          }
+          if ( SNR ) {
+            SNR[i0 + j] = sqrt ( rho2 ) * fabs ( rescale );
+          }
+        } /* for j < n */
+
+      /* ----- synthesize per-detector {Fa^X,Fb^X}, and sum them up into multi-detector {Fa,Fb} */
+      for ( UINT4 j = 0; j < n; j ++ ) {
+        FaRe[j] = FaIm[j] = FbRe[j] = FbIm[j] = 0;
+      }
+      for ( UINT4 X = 0; X < numDet; X ++ )
+        {
+          const BOOLEAN haveSignal = drawAmp && ( (lineX < 0) || ((UINT4)lineX == X) );
+          const REAL8 norm_s = sqrt ( table->TAtom[X] / 2.0 );
+          if ( !SignalOnly ) {
+            for ( UINT4 mu = 0; mu < 4; mu ++ ) {
+              for ( UINT4 j = 0; j < n; j ++ ) {
+                g[mu][j] = gsl_ran_gaussian_ziggurat ( rng, 1.0 );
+              }
+            }
+          }
+          REAL4 *twoFX = ( twoFPerDet != NULL ) ? twoFPerDet[X] : NULL;
+          for ( UINT4 j = 0; j < n; j ++ )
+            {
+              const SynthCWDrawsDet_t *det = &table->det[sky[j] * numDet + X];
+              REAL8 FaReX = 0, FaImX = 0, FbReX = 0, FbImX = 0;
+
+              /* signal: sh_mu = sqrt(T/2) * M^X_mu_nu A^nu, with Fa = sh_1 - i sh_3 and Fb = sh_2 - i sh_4: see Eq.(72) in CFSv2-LIGO-T0900149-v2.pdf */
+              if ( haveSignal ) {
+                FaReX =   norm_s * ( det->A * A_Mu[j][0] + det->C * A_Mu[j][1] );
+                FbReX =   norm_s * ( det->C * A_Mu[j][0] + det->B * A_Mu[j][1] );
+                FaImX = - norm_s * ( det->A * A_Mu[j][2] + det->C * A_Mu[j][3] );
+                FbImX = - norm_s * ( det->C * A_Mu[j][2] + det->B * A_Mu[j][3] );
+              }
+
+              /* noise: correlated as M^X/2, separately for real and imaginary parts */
+              if ( !SignalOnly ) {
+                FaReX += det->L11 * g[0][j];
+                FbReX += det->L21 * g[0][j] + det->L22 * g[1][j];
+                FaImX += det->L11 * g[2][j];
+                FbImX += det->L21 * g[2][j] + det->L22 * g[3][j];
+              }
+
+              if ( twoFX ) {
+                twoFX[i0 + j] = XLALComputeFstatFromFaFb ( crectf ( FaReX, FaImX ), crectf ( FbReX, FbImX ), det->A, det->B, det->C, 0, det->Dinv );
+              }
+
+              FaRe[j] += FaReX;
+              FaIm[j] += FaImX;
+              FbRe[j] += FbReX;
+              FbIm[j] += FbImX;
+            } /* for j < n */
+        } /* for X < numDet */
+
+      /* ----- compute multi-detector F-stats */
+      if ( twoF ) {
+        for ( UINT4 j = 0; j < n; j ++ )
+          {
+            const SynthCWDrawsMulti_t *multi = &table->multi[sky[j]];
+            twoF[i0 + j] = XLALComputeFstatFromFaFb ( crectf ( FaRe[j], FaIm[j] ), crectf ( FbRe[j], FbIm[j] ), multi->A, multi->B, multi->C, 0, multi->Dinv );
+          }
+      }
+
+    } /* for i0 < numDraws */
+
+  return XLAL_SUCCESS;
+
+} /* XLALSynthesizeCWDraws() */
@@ -101,6 +101,12 @@ typedef struct tagInjParams_t
 } InjParams_t;
 
 
+/**
+ * Opaque table of antenna-pattern matrices pre-tabulated over a set of sky positions, used by XLALSynthesizeCWDraws()
+ */
+typedef struct tagSynthCWDrawsTable_t SynthCWDrawsTable_t;
+
+
 /*---------- Global variables ----------*/
 
 /*---------- exported prototypes [API] ----------*/
@@ -132,6 +138,14 @@ XLALSynthesizeTransientAtoms ( InjParams_t *injParamsOut,
                                const MultiNoiseWeights *multiNoiseWeights
                                );
 
+// ----- API to synthesize large numbers of (non-transient) F-stat draws in batches
+SynthCWDrawsTable_t *XLALCreateSynthCWDrawsTable ( const MultiDetectorStateSeries *multiDetStates, const MultiNoiseWeights *multiNoiseWeights, const SkyPosition *skypos, const UINT4 numSkypos );
+void XLALDestroySynthCWDrawsTable ( SynthCWDrawsTable_t *table );
+
+#ifndef SWIG /* exclude from SWIG interface */
+int XLALSynthesizeCWDraws ( REAL4 *twoF, REAL4 *twoFPerDet[PULSAR_MAX_DETECTORS], REAL4 *SNR, const UINT4 numDraws, const SynthCWDrawsTable_t *table, AmplitudePrior_t AmpPrior, const BOOLEAN SignalOnly, const INT4 lineX, gsl_rng *rng );
+#endif /* SWIG */
+
 /** @} */
 
 #ifdef  __cplusplus
@@ -32,6 +32,9 @@
 
 /* System includes */
 #include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /* LAL-includes */
 #include <lal/XLALError.h>
@@ -46,6 +49,14 @@
 
 /* ----- MACRO definitions ---------- */
 
+/* ----- CUDA implementation of the transient F-stat map, see TransientCW_utils_CUDA.cu ----- */
+#ifdef LALPULSAR_CUDA_ENABLED
+#define TRANSIENT_CUDA_NUM_SUMS 7	// number of windowed sums per atom/window: A, B, C, Re/Im Fa, Re/Im Fb
+int XLALTransientCUDAIsAvailable_intern ( void );
+int XLALComputeTransientWindowSums_CUDA ( REAL8 *sums, const REAL4 *atomsData, UINT4 numAtoms, UINT4 t0_data, UINT4 TAtom,
+                                          transientWindowRange_t windowRange, UINT4 N_t0Range, UINT4 N_tauRange );
+#endif
+
 /* ----- module-local fast lookup-table handling of negative exponentials ----- */
 /**
  * Lookup-table for negative exponentials e^(-x)
@@ -619,21 +630,93 @@ XLALComputeTransientPosterior_tau ( transientWindowRange_t windowRange,		/**< [i
 
 
 /**
- * Function to compute transient-window "F-statistic map" over start-time and timescale {t0, tau}.
- * Returns a 2D matrix F_mn, with m = index over start-times t0, and n = index over timescales tau,
- * in steps of dt0 in [t0, t0+t0Band], and dtau in [tau, tau+tauBand] as defined in transientWindowRange
- *
- * Note: if window->type == none, we compute a single rectangular window covering all the data.
- *
- * Note2: if the experimental switch useFReg is true, returns FReg=F - log(D) instead of F. This option is of
- * little practical interest, except for demonstrating that marginalizing (1/D)e^F is *less* sensitive
- * than marginalizing e^F (see transient methods-paper [in prepartion])
- *
+ * Compute the Fstat-atoms index range [i_t0, i_t1] and the timespan [t0, t1] of the transient window {m,n}
+ * of the given window range, for binned atoms starting at t0_data on a regular grid of step TAtom.
+ * The timespan is the same as returned by XLALGetTransientWindowTimespan() for rectangular and exponential windows.
  */
-transientFstatMap_t *
-XLALComputeTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, 	/**< [in] multi-IFO F-statistic atoms */
-                               transientWindowRange_t windowRange,		/**< [in] type and parameters specifying transient window range to search */
-                               BOOLEAN useFReg					/**< [in] experimental switch: compute FReg = F - log(D) instead of F */
+static inline void
+XLALGetTransientWindowAtomsRange ( UINT4 *i_t0,					/**< [out] index of first atom in window */
+                                   UINT4 *i_t1,					/**< [out] index of last atom in window */
+                                   UINT4 *t0,					/**< [out] window start-time */
+                                   UINT4 *t1,					/**< [out] window end-time */
+                                   const transientWindowRange_t *windowRange,	/**< [in] transient window range */
+                                   UINT4 m,					/**< [in] start-time index */
+                                   UINT4 n,					/**< [in] timescale index */
+                                   UINT4 t0_data,				/**< [in] timestamp of first atom */
+                                   UINT4 TAtom,					/**< [in] atoms time baseline */
+                                   UINT4 numAtoms				/**< [in] number of atoms */
+                                   )
+{
+  UINT4 TAtomHalf = TAtom/2;	/* integer division */
+
+  UINT4 win_t0 = windowRange->t0 + m * windowRange->dt0;
+  UINT4 win_tau = windowRange->tau + n * windowRange->dtau;
+
+  /* compute Fstat-atom index i_t0 in [0, numAtoms) */
+  INT4 i_tmp = ( win_t0 - t0_data + TAtomHalf ) / TAtom;	// integer round: floor(x+0.5)
+  if ( i_tmp < 0 ) i_tmp = 0;
+  (*i_t0) = (UINT4)i_tmp;
+  if ( (*i_t0) >= numAtoms ) (*i_t0) = numAtoms - 1;
+
+  /* get end-time t1 of this transient-window search */
+  (*t0) = win_t0;
+  if ( windowRange->type == TRANSIENT_EXPONENTIAL ) {
+    (*t1) = lround( win_t0 + TRANSIENT_EXP_EFOLDING * win_tau);
+  } else {
+    (*t1) = win_t0 + win_tau;
+  }
+
+  /* compute window end-time Fstat-atom index i_t1 in [0, numAtoms) */
+  i_tmp = ( (*t1) - t0_data + TAtomHalf ) / TAtom  - 1;	// integer round: floor(x+0.5)
+  if ( i_tmp < 0 ) i_tmp = 0;
+  (*i_t1) = (UINT4)i_tmp;
+  if ( (*i_t1) >= numAtoms ) (*i_t1) = numAtoms - 1;
+
+} /* XLALGetTransientWindowAtomsRange() */
+
+/**
+ * Compute F (and the 'regularized' FReg = F - log(D)) from the windowed sums of Fstat-atoms
+ */
+static inline REAL4
+XLALComputeTransientFstatFromSums ( REAL4 *FReg, REAL8 Ad, REAL8 Bd, REAL8 Cd, COMPLEX16 Fa, COMPLEX16 Fb )
+{
+  /* generic F-stat calculation from A,B,C, Fa, Fb */
+  REAL4 Dd = XLALComputeAntennaPatternSqrtDeterminant ( Ad, Bd, Cd, 0 );
+  REAL4 DdInv = 1.0f / Dd;
+  REAL4 twoF = compute_fstat_from_fa_fb ( Fa, Fb, Ad, Bd, Cd, 0, DdInv );
+  REAL4 F = 0.5 * twoF;
+
+  /* 'regularized' F-stat: log ( 1/D * e^F ) = F + log(1/D) */
+  (*FReg) = F + log( DdInv );
+
+  return F;
+
+} /* XLALComputeTransientFstatFromSums() */
+
+/**
+ * Keep track of the loudest F-stat value encountered over the m x n matrix. Ties are resolved in favour
+ * of the smallest {m,n} in row-major order, so that the result does not depend on how the matrix was traversed.
+ */
+static inline void
+XLALUpdateTransientFstatMax ( REAL8 *maxF, UINT4 *m_max, UINT4 *n_max, REAL8 F, UINT4 m, UINT4 n )
+{
+  if ( F > (*maxF) || ( F == (*maxF) && ( m < (*m_max) || ( m == (*m_max) && n < (*n_max) ) ) ) )
+    {
+      (*maxF) = F;
+      (*m_max) = m;
+      (*n_max) = n;
+    }
+} /* XLALUpdateTransientFstatMax() */
+
+/**
+ * Prepare the computation of a transient-window F-statistic map: merge the multi-IFO atoms into a single
+ * binned atoms-vector, resolve window-type 'none', allocate the return container, and check that no window
+ * of the range is degenerate.
+ */
+static transientFstatMap_t *
+XLALPrepareTransientFstatMap ( FstatAtomVector **atoms,				/**< [out] merged and binned atoms */
+                               transientWindowRange_t *windowRange,		/**< [in/out] transient window range */
+                               const MultiFstatAtomVector *multiFstatAtoms	/**< [in] multi-IFO F-statistic atoms */
                                )
 {
   /* check input consistency */
@@ -641,8 +724,8 @@ XLALComputeTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, 	/**
     XLALPrintError ("%s: invalid NULL input.\n", __func__ );
     XLAL_ERROR_NULL ( XLAL_EINVAL );
   }
-  if ( windowRange.type >= TRANSIENT_LAST ) {
-    XLALPrintError ("%s: unknown window-type (%d) passes as input. Allowed are [0,%d].\n", __func__, windowRange.type, TRANSIENT_LAST-1);
+  if ( windowRange->type >= TRANSIENT_LAST ) {
+    XLALPrintError ("%s: unknown window-type (%d) passes as input. Allowed are [0,%d].\n", __func__, windowRange->type, TRANSIENT_LAST-1);
     XLAL_ERROR_NULL ( XLAL_EINVAL );
   }
 
@@ -654,29 +737,27 @@ XLALComputeTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, 	/**
   }
 
   /* ----- first combine all multi-atoms into a single atoms-vector with *unique* timestamps */
-  FstatAtomVector *atoms;
   UINT4 TAtom = multiFstatAtoms->data[0]->TAtom;
-  UINT4 TAtomHalf = TAtom/2;	/* integer division */
 
-  if ( (atoms = XLALmergeMultiFstatAtomsBinned ( multiFstatAtoms, TAtom )) == NULL ) {
+  if ( ((*atoms) = XLALmergeMultiFstatAtomsBinned ( multiFstatAtoms, TAtom )) == NULL ) {
     XLALPrintError ("%s: XLALmergeMultiFstatAtomsBinned() failed with code %d\n", __func__, xlalErrno );
     XLAL_ERROR_NULL ( XLAL_EFUNC );
   }
-  UINT4 numAtoms = atoms->length;
+  UINT4 numAtoms = (*atoms)->length;
   /* actual data spans [t0_data, t0_data + numAtoms * TAtom] in steps of TAtom */
-  UINT4 t0_data = atoms->data[0].timestamp;
-  UINT4 t1_data = atoms->data[numAtoms-1].timestamp + TAtom;
+  UINT4 t0_data = (*atoms)->data[0].timestamp;
+  UINT4 t1_data = (*atoms)->data[numAtoms-1].timestamp + TAtom;
 
   /* ----- special treatment of window_type = none ==> replace by rectangular window spanning all the data */
-  if ( windowRange.type == TRANSIENT_NONE )
+  if ( windowRange->type == TRANSIENT_NONE )
     {
-      windowRange.type = TRANSIENT_RECTANGULAR;
-      windowRange.t0 = t0_data;
-      windowRange.t0Band = 0;
-      windowRange.dt0 = TAtom;	/* irrelevant */
-      windowRange.tau = numAtoms * TAtom;
-      windowRange.tauBand = 0;
-      windowRange.dtau = TAtom;	/* irrelevant */
+      windowRange->type = TRANSIENT_RECTANGULAR;
+      windowRange->t0 = t0_data;
+      windowRange->t0Band = 0;
+      windowRange->dt0 = TAtom;	/* irrelevant */
+      windowRange->tau = numAtoms * TAtom;
+      windowRange->tauBand = 0;
+      windowRange->dtau = TAtom;	/* irrelevant */
     }
 
   /* NOTE: indices {i,j} enumerate *actual* atoms and their timestamps t_i, while the
@@ -699,151 +780,318 @@ XLALComputeTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, 	/**
   /* We allocate a matrix  {m x n} = t0Range * TcohRange elements
    * covering the full timerange the transient window-range [t0,t0+t0Band]x[tau,tau+tauBand]
    */
-  UINT4 N_t0Range  = (UINT4) floor ( windowRange.t0Band / windowRange.dt0 ) + 1;
-  UINT4 N_tauRange = (UINT4) floor ( windowRange.tauBand / windowRange.dtau ) + 1;
+  UINT4 N_t0Range  = (UINT4) floor ( windowRange->t0Band / windowRange->dt0 ) + 1;
+  UINT4 N_tauRange = (UINT4) floor ( windowRange->tauBand / windowRange->dtau ) + 1;
 
   if ( ( ret->F_mn = gsl_matrix_calloc ( N_t0Range, N_tauRange )) == NULL ) {
     XLALPrintError ("%s: failed ret->F_mn = gsl_matrix_calloc ( %d, %d )\n", __func__, N_tauRange, N_t0Range );
     XLAL_ERROR_NULL ( XLAL_ENOMEM );
   }
 
-  transientWindow_t win_mn;
-  win_mn.type = windowRange.type;
-  ret->maxF = -1.0;	// keep track of loudest F-stat point. Initializing to a negative value ensures that we always update at least once and hence return sane t0_d_ML, tau_d_ML even if there is only a single bin where F=0 happens.
-  UINT4 m, n;
-  /* ----- OUTER loop over start-times [t0,t0+t0Band] ---------- */
-  for ( m = 0; m < N_t0Range; m ++ ) /* m enumerates 'binned' t0 start-time indices  */
+  /* protection against degenerate 1-atom case: (this implies D=0 and therefore F->inf);
+   * this is checked for all windows up front, so that the map itself can be computed in any order
+   */
+  for ( UINT4 m = 0; m < N_t0Range; m ++ )
     {
-      /* compute Fstat-atom index i_t0 in [0, numAtoms) */
-      win_mn.t0 = windowRange.t0 + m * windowRange.dt0;
-      INT4 i_tmp = ( win_mn.t0 - t0_data + TAtomHalf ) / TAtom;	// integer round: floor(x+0.5)
-      if ( i_tmp < 0 ) i_tmp = 0;
-      UINT4 i_t0 = (UINT4)i_tmp;
-      if ( i_t0 >= numAtoms ) i_t0 = numAtoms - 1;
-
-      /* ----- INNER loop over timescale-parameter tau ---------- */
-      REAL4 Ad=0, Bd=0, Cd=0;
-      COMPLEX8 Fa=0, Fb=0;
-      UINT4 i_t1_last = i_t0;
-
-      for ( n = 0; n < N_tauRange; n ++ )
+      for ( UINT4 n = 0; n < N_tauRange; n ++ )
         {
-          /* translate n into an atoms end-index for this search interval [t0, t0+Tcoh],
-           * giving the index range of atoms to sum over
-           */
-          win_mn.tau = windowRange.tau + n * windowRange.dtau;
-
-          /* get end-time t1 of this transient-window search */
-          UINT4 t0, t1;
-          if ( XLALGetTransientWindowTimespan ( &t0, &t1, win_mn ) != XLAL_SUCCESS ) {
-            XLALPrintError ("%s: XLALGetTransientWindowTimespan() failed.\n", __func__ );
-            XLAL_ERROR_NULL ( XLAL_EFUNC );
-          }
-
-          /* compute window end-time Fstat-atom index i_t1 in [0, numAtoms) */
-          i_tmp = ( t1 - t0_data + TAtomHalf ) / TAtom  - 1;	// integer round: floor(x+0.5)
-          if ( i_tmp < 0 ) i_tmp = 0;
-          UINT4 i_t1 = (UINT4)i_tmp;
-          if ( i_t1 >= numAtoms ) i_t1 = numAtoms - 1;
-
-          /* protection against degenerate 1-atom case: (this implies D=0 and therefore F->inf) */
+          UINT4 i_t0, i_t1, t0, t1;
+          XLALGetTransientWindowAtomsRange ( &i_t0, &i_t1, &t0, &t1, windowRange, m, n, t0_data, TAtom, numAtoms );
           if ( i_t1 == i_t0 ) {
+            UINT4 win_t0 = windowRange->t0 + m * windowRange->dt0;
             XLALPrintError ("%s: encountered a single-atom Fstat-calculation. This is degenerate and cannot be computed!\n", __func__ );
             XLALPrintError ("Window-values m=%d (t0=%d=t0_data + %d), n=%d (tau=%d) ==> t1_data - t0 = %d\n",
-                            m, win_mn.t0, i_t0 * TAtom, n, win_mn.tau, t1_data - win_mn.t0 );
+                            m, win_t0, i_t0 * TAtom, n, windowRange->tau + n * windowRange->dtau, t1_data - win_t0 );
             XLALPrintError ("The most likely cause is that your t0-range covered all of your data: t0 must stay away *at least* 2*TAtom from the end of the data!\n");
             XLAL_ERROR_NULL ( XLAL_EDOM );
           }
+        } /* for n < N_tauRange */
+    } /* for m < N_t0Range */
 
-          /* now we have two valid atoms-indices [i_t0, i_t1] spanning our Fstat-window to sum over,
-           * using weights according to the window-type
-           */
-          switch ( windowRange.type )
-            {
-            case TRANSIENT_RECTANGULAR:
-#if 0
-              /* 'vanilla' unoptimized method, for sanity checks with 'optimized' method */
-              Ad=0; Bd=0; Cd=0; Fa=0; Fb=0;
-              for ( UINT4 i = i_t0; i <= i_t1; i ++ )
-#else
-              /* special optimiziation in the rectangular-window case: just add on to previous tau values
-               * ie re-use the sum over [i_t0, i_t1_last] from the pevious tau-loop iteration
-               */
-              for ( UINT4 i = i_t1_last; i <= i_t1; i ++ )
-#endif
-                {
-                  FstatAtom *thisAtom_i = &atoms->data[i];
+  ret->maxF = -1.0;	// keep track of loudest F-stat point. Initializing to a negative value ensures that we always update at least once and hence return sane t0_d_ML, tau_d_ML even if there is only a single bin where F=0 happens.
 
-                  /* now add on top of previous values, summed from [i_t0, i_t1_last] */
-                  Ad += thisAtom_i->a2_alpha;
-                  Bd += thisAtom_i->b2_alpha;
-                  Cd += thisAtom_i->ab_alpha;
+  return ret;
 
-                  Fa += thisAtom_i->Fa_alpha;
-                  Fb += thisAtom_i->Fb_alpha;
+} /* XLALPrepareTransientFstatMap() */
 
-                } /* for i = i_t1_last : i_t1 */
+/**
+ * Rectangular-window F-statistic map: using cumulative sums over the atoms, the sum over
+ * any window [i_t0, i_t1] is a single difference, so every {m,n} element costs O(1).
+ * Start-times are shared out between threads.
+ */
+static int
+XLALComputeTransientFstatMap_Rect ( transientFstatMap_t *ret,			/**< [in/out] F-stat map */
+                                    UINT4 *m_max,				/**< [out] start-time index of loudest F-stat */
+                                    UINT4 *n_max,				/**< [out] timescale index of loudest F-stat */
+                                    const FstatAtomVector *atoms, 		/**< [in] merged and binned atoms */
+                                    const transientWindowRange_t *windowRange,	/**< [in] transient window range */
+                                    BOOLEAN useFReg,				/**< [in] experimental switch: compute FReg = F - log(D) instead of F */
+                                    UINT4 numThreads				/**< [in] number of threads */
+                                    )
+{
+  const UINT4 numAtoms = atoms->length;
+  const UINT4 TAtom = atoms->TAtom;
+  const UINT4 t0_data = atoms->data[0].timestamp;
+  const UINT4 N_t0Range = ret->F_mn->size1;
+  const UINT4 N_tauRange = ret->F_mn->size2;
+
+  /* cumulative sums over atoms [0, i) */
+  REAL8 *cumA, *cumB, *cumC;
+  COMPLEX16 *cumFa, *cumFb;
+  XLAL_CHECK ( (cumA = XLALCalloc ( numAtoms + 1, sizeof(*cumA) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( (cumB = XLALCalloc ( numAtoms + 1, sizeof(*cumB) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( (cumC = XLALCalloc ( numAtoms + 1, sizeof(*cumC) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( (cumFa = XLALCalloc ( numAtoms + 1, sizeof(*cumFa) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( (cumFb = XLALCalloc ( numAtoms + 1, sizeof(*cumFb) )) != NULL, XLAL_ENOMEM );
+  for ( UINT4 i = 0; i < numAtoms; i ++ )
+    {
+      const FstatAtom *thisAtom_i = &atoms->data[i];
+      cumA[i+1] = cumA[i] + thisAtom_i->a2_alpha;
+      cumB[i+1] = cumB[i] + thisAtom_i->b2_alpha;
+      cumC[i+1] = cumC[i] + thisAtom_i->ab_alpha;
+      cumFa[i+1] = cumFa[i] + thisAtom_i->Fa_alpha;
+      cumFb[i+1] = cumFb[i] + thisAtom_i->Fb_alpha;
+    }
 
-              i_t1_last = i_t1 + 1;		/* keep track of up to where we summed for the next iteration */
+  REAL8 maxF = ret->maxF;
+  (*m_max) = (*n_max) = 0;
 
-              break;
+  /* ----- OUTER loop over start-times [t0,t0+t0Band] ---------- */
+#pragma omp parallel num_threads(numThreads) if(numThreads > 1)
+  {
+    REAL8 thread_maxF = maxF;
+    UINT4 thread_m_max = 0, thread_n_max = 0;
+
+#pragma omp for schedule(static)
+    for ( INT4 m = 0; m < (INT4)N_t0Range; m ++ ) /* m enumerates 'binned' t0 start-time indices  */
+      {
+        /* ----- INNER loop over timescale-parameter tau ---------- */
+        for ( UINT4 n = 0; n < N_tauRange; n ++ )
+          {
+            /* window ranges have already been checked in XLALPrepareTransientFstatMap() */
+            UINT4 i_t0, i_t1, t0, t1;
+            XLALGetTransientWindowAtomsRange ( &i_t0, &i_t1, &t0, &t1, windowRange, m, n, t0_data, TAtom, numAtoms );
+
+            REAL4 FReg;
+            REAL4 F = XLALComputeTransientFstatFromSums ( &FReg, cumA[i_t1+1] - cumA[i_t0], cumB[i_t1+1] - cumB[i_t0], cumC[i_t1+1] - cumC[i_t0],
+                                                          cumFa[i_t1+1] - cumFa[i_t0], cumFb[i_t1+1] - cumFb[i_t0] );
+            XLALUpdateTransientFstatMax ( &thread_maxF, &thread_m_max, &thread_n_max, F, m, n );
+
+            /* and store this in Fstat-matrix as element {m,n} */
+            gsl_matrix_set ( ret->F_mn, m, n, useFReg ? FReg : F );
+
+          } /* for n in n[tau] : n[tau+tauBand] */
+      } /* for m in m[t0] : m[t0+t0Band] */
+
+#pragma omp critical(XLALComputeTransientFstatMap_Rect)
+    XLALUpdateTransientFstatMax ( &maxF, m_max, n_max, thread_maxF, thread_m_max, thread_n_max );
+  }
+  ret->maxF = maxF;
 
-            case TRANSIENT_EXPONENTIAL:
-              /* reset all values */
-              Ad=0; Bd=0; Cd=0; Fa=0; Fb=0;
+  XLALFree ( cumA );
+  XLALFree ( cumB );
+  XLALFree ( cumC );
+  XLALFree ( cumFa );
+  XLALFree ( cumFb );
 
-              for ( UINT4 i = i_t0; i <= i_t1; i ++ )
-                {
-                  FstatAtom *thisAtom_i = &atoms->data[i];
-                  UINT4 t_i = thisAtom_i->timestamp;
+  return XLAL_SUCCESS;
+
+} /* XLALComputeTransientFstatMap_Rect() */
+
+/**
+ * Exponential-window F-statistic map: for each timescale tau, the atoms are summed backwards with a
+ * decay r = e^(-TAtom/tau) per atom, E_i = x_i + r * E_{i+1}. The exponentially-weighted sum over any window
+ * [i_lo, i_end) is then (E_{i_lo} - r^(i_end-i_lo) E_{i_end}) times the window value at i_lo, so each
+ * timescale costs O(numAtoms + N_t0) instead of O(numAtoms x N_t0). Timescales are shared out between threads.
+ */
+static int
+XLALComputeTransientFstatMap_Exp ( transientFstatMap_t *ret,			/**< [in/out] F-stat map */
+                                   UINT4 *m_max,				/**< [out] start-time index of loudest F-stat */
+                                   UINT4 *n_max,				/**< [out] timescale index of loudest F-stat */
+                                   const FstatAtomVector *atoms, 		/**< [in] merged and binned atoms */
+                                   const transientWindowRange_t *windowRange,	/**< [in] transient window range */
+                                   BOOLEAN useFReg,				/**< [in] experimental switch: compute FReg = F - log(D) instead of F */
+                                   UINT4 numThreads				/**< [in] number of threads */
+                                   )
+{
+  const UINT4 numAtoms = atoms->length;
+  const UINT4 TAtom = atoms->TAtom;
+  const UINT4 t0_data = atoms->data[0].timestamp;
+  const UINT4 N_t0Range = ret->F_mn->size1;
+  const UINT4 N_tauRange = ret->F_mn->size2;
+
+  REAL8 maxF = ret->maxF;
+  (*m_max) = (*n_max) = 0;
+  int errnum = XLAL_SUCCESS;
+
+#pragma omp parallel num_threads(numThreads) if(numThreads > 1)
+  {
+    REAL8 thread_maxF = maxF;
+    UINT4 thread_m_max = 0, thread_n_max = 0;
+
+    /* backward exponentially-decaying sums over atoms [i, numAtoms) */
+    REAL8 *expA = XLALCalloc ( numAtoms + 1, sizeof(*expA) );
+    REAL8 *expB = XLALCalloc ( numAtoms + 1, sizeof(*expB) );
+    REAL8 *expC = XLALCalloc ( numAtoms + 1, sizeof(*expC) );
+    COMPLEX16 *expFa = XLALCalloc ( numAtoms + 1, sizeof(*expFa) );
+    COMPLEX16 *expFb = XLALCalloc ( numAtoms + 1, sizeof(*expFb) );
+    int thread_errnum = ( expA && expB && expC && expFa && expFb ) ? XLAL_SUCCESS : XLAL_ENOMEM;
+
+#pragma omp for schedule(dynamic,1)
+    for ( INT4 n = 0; n < (INT4)N_tauRange; n ++ )
+      {
+        if ( thread_errnum != XLAL_SUCCESS ) {
+          continue;
+        }
 
-                  REAL8 win_i;
-                  win_i = XLALGetExponentialTransientWindowValue ( t_i, t0, t1, win_mn.tau );
+        const REAL8 tau = windowRange->tau + n * windowRange->dtau;
+        const REAL8 r = exp ( - 1.0 * TAtom / tau );
+        const REAL8 r2 = r * r;
+
+        /* amplitude coefficients are weighted with the window squared, Fa and Fb with the window */
+        for ( INT4 i = numAtoms - 1; i >= 0; i -- )
+          {
+            const FstatAtom *thisAtom_i = &atoms->data[i];
+            expA[i] = thisAtom_i->a2_alpha + r2 * expA[i+1];
+            expB[i] = thisAtom_i->b2_alpha + r2 * expB[i+1];
+            expC[i] = thisAtom_i->ab_alpha + r2 * expC[i+1];
+            expFa[i] = thisAtom_i->Fa_alpha + r * expFa[i+1];
+            expFb[i] = thisAtom_i->Fb_alpha + r * expFb[i+1];
+          }
 
-                  REAL8 win2_i = win_i * win_i;
+        for ( UINT4 m = 0; m < N_t0Range; m ++ )
+          {
+            /* window ranges have already been checked in XLALPrepareTransientFstatMap() */
+            UINT4 i_t0, i_t1, t0, t1;
+            XLALGetTransientWindowAtomsRange ( &i_t0, &i_t1, &t0, &t1, windowRange, m, n, t0_data, TAtom, numAtoms );
 
-                  Ad += thisAtom_i->a2_alpha * win2_i;
-                  Bd += thisAtom_i->b2_alpha * win2_i;
-                  Cd += thisAtom_i->ab_alpha * win2_i;
+            /* atoms in [i_t0, i_t1] outside the window timespan [t0, t1] have zero weight */
+            UINT4 i_lo = i_t0, i_end = i_t1 + 1;
+            while ( i_lo < i_end && t0_data + i_lo * TAtom < t0 ) {
+              i_lo ++;
+            }
+            while ( i_end > i_lo && t0_data + ( i_end - 1 ) * TAtom > t1 ) {
+              i_end --;
+            }
 
-                  Fa += thisAtom_i->Fa_alpha * win_i;
-                  Fb += thisAtom_i->Fb_alpha * win_i;
+            REAL8 Ad = 0, Bd = 0, Cd = 0;
+            COMPLEX16 Fa = 0, Fb = 0;
+            if ( i_lo < i_end )
+              {
+                const REAL8 win_lo = exp ( - 1.0 * ( t0_data + i_lo * TAtom - t0 ) / tau );
+                const REAL8 win2_lo = win_lo * win_lo;
+                const REAL8 r_len = exp ( - 1.0 * ( i_end - i_lo ) * TAtom / tau );
+                const REAL8 r2_len = r_len * r_len;
+                Ad = win2_lo * ( expA[i_lo] - r2_len * expA[i_end] );
+                Bd = win2_lo * ( expB[i_lo] - r2_len * expB[i_end] );
+                Cd = win2_lo * ( expC[i_lo] - r2_len * expC[i_end] );
+                Fa = win_lo * ( expFa[i_lo] - r_len * expFa[i_end] );
+                Fb = win_lo * ( expFb[i_lo] - r_len * expFb[i_end] );
+              }
+
+            REAL4 FReg;
+            REAL4 F = XLALComputeTransientFstatFromSums ( &FReg, Ad, Bd, Cd, Fa, Fb );
+            XLALUpdateTransientFstatMax ( &thread_maxF, &thread_m_max, &thread_n_max, F, m, n );
+
+            /* and store this in Fstat-matrix as element {m,n} */
+            gsl_matrix_set ( ret->F_mn, m, n, useFReg ? FReg : F );
+
+          } /* for m in m[t0] : m[t0+t0Band] */
+      } /* for n in n[tau] : n[tau+tauBand] */
+
+    XLALFree ( expA );
+    XLALFree ( expB );
+    XLALFree ( expC );
+    XLALFree ( expFa );
+    XLALFree ( expFb );
+
+#pragma omp critical(XLALComputeTransientFstatMap_Exp)
+    {
+      XLALUpdateTransientFstatMax ( &maxF, m_max, n_max, thread_maxF, thread_m_max, thread_n_max );
+      if ( thread_errnum != XLAL_SUCCESS ) {
+        errnum = thread_errnum;
+      }
+    }
+  }
+  XLAL_CHECK ( errnum == XLAL_SUCCESS, errnum );
+  ret->maxF = maxF;
 
-                } /* for i in [i_t0, i_t1] */
-              break;
+  return XLAL_SUCCESS;
 
-            default:
-              XLALPrintError ("%s: invalid transient window type %d not in [%d, %d].\n",
-                              __func__, windowRange.type, TRANSIENT_NONE, TRANSIENT_LAST -1 );
-              XLAL_ERROR_NULL ( XLAL_EINVAL );
-              break;
+} /* XLALComputeTransientFstatMap_Exp() */
 
-            } /* switch window.type */
+/**
+ * Function to compute transient-window "F-statistic map" over start-time and timescale {t0, tau}.
+ * Returns a 2D matrix F_mn, with m = index over start-times t0, and n = index over timescales tau,
+ * in steps of dt0 in [t0, t0+t0Band], and dtau in [tau, tau+tauBand] as defined in transientWindowRange
+ *
+ * Note: if window->type == none, we compute a single rectangular window covering all the data.
+ *
+ * Note2: if the experimental switch useFReg is true, returns FReg=F - log(D) instead of F. This option is of
+ * little practical interest, except for demonstrating that marginalizing (1/D)e^F is *less* sensitive
+ * than marginalizing e^F (see transient methods-paper [in prepartion])
+ *
+ * This is equivalent to XLALComputeTransientFstatMapThreaded() with a single thread.
+ */
+transientFstatMap_t *
+XLALComputeTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, 	/**< [in] multi-IFO F-statistic atoms */
+                               transientWindowRange_t windowRange,		/**< [in] type and parameters specifying transient window range to search */
+                               BOOLEAN useFReg					/**< [in] experimental switch: compute FReg = F - log(D) instead of F */
+                               )
+{
+  return XLALComputeTransientFstatMapThreaded ( multiFstatAtoms, windowRange, useFReg, 1 );
+} /* XLALComputeTransientFstatMap() */
 
+/**
+ * Compute the transient-window "F-statistic map" over {t0, tau} as XLALComputeTransientFstatMap(),
+ * spreading the computation over \a numThreads threads (requires OpenMP; otherwise runs serially).
+ *
+ * The rectangular window uses cumulative sums over the atoms, and the exponential window uses
+ * exponentially-decaying backward sums for each timescale, so that each element of the map
+ * costs O(1) rather than a sum over all atoms in its window.
+ */
+transientFstatMap_t *
+XLALComputeTransientFstatMapThreaded ( const MultiFstatAtomVector *multiFstatAtoms, 	/**< [in] multi-IFO F-statistic atoms */
+                                       transientWindowRange_t windowRange,		/**< [in] type and parameters specifying transient window range to search */
+                                       BOOLEAN useFReg,					/**< [in] experimental switch: compute FReg = F - log(D) instead of F */
+                                       UINT4 numThreads					/**< [in] number of threads to use; 0 or 1 runs serially */
+                                       )
+{
+  FstatAtomVector *atoms = NULL;
+  transientFstatMap_t *ret = XLALPrepareTransientFstatMap ( &atoms, &windowRange, multiFstatAtoms );
+  XLAL_CHECK_NULL ( ret != NULL, XLAL_EFUNC );
 
-          /* generic F-stat calculation from A,B,C, Fa, Fb */
-          REAL4 Dd = XLALComputeAntennaPatternSqrtDeterminant ( Ad, Bd, Cd, 0 );
-          REAL4 DdInv = 1.0f / Dd;
-          REAL4 twoF = compute_fstat_from_fa_fb ( Fa, Fb, Ad, Bd, Cd, 0, DdInv );
-          REAL4 F = 0.5 * twoF;
-          /* keep track of loudest F-stat value encountered over the m x n matrix */
-          if ( F > ret->maxF )
-            {
-              ret->maxF = F;
-              ret->t0_ML  = win_mn.t0;	/* start-time t0 corresponding to Fmax */
-              ret->tau_ML = win_mn.tau;	/* timescale tau corresponding to Fmax */
-            }
+  if ( numThreads < 1 ) {
+    numThreads = 1;
+  }
+#ifndef _OPENMP
+  if ( numThreads > 1 ) {
+    XLALPrintWarning ("WARNING: Requested %" LAL_UINT4_FORMAT " threads, but LALPulsar was compiled without OpenMP; running serially\n", numThreads );
+    numThreads = 1;
+  }
+#endif
+
+  UINT4 m_max = 0, n_max = 0;
+  switch ( windowRange.type )
+    {
+    case TRANSIENT_RECTANGULAR:
+      XLAL_CHECK_NULL ( XLALComputeTransientFstatMap_Rect ( ret, &m_max, &n_max, atoms, &windowRange, useFReg, numThreads ) == XLAL_SUCCESS, XLAL_EFUNC );
+      break;
 
-          /* if requested: use 'regularized' F-stat: log ( 1/D * e^F ) = F + log(1/D) */
-          if ( useFReg )
-            F += log( DdInv );
+    case TRANSIENT_EXPONENTIAL:
+      XLAL_CHECK_NULL ( XLALComputeTransientFstatMap_Exp ( ret, &m_max, &n_max, atoms, &windowRange, useFReg, numThreads ) == XLAL_SUCCESS, XLAL_EFUNC );
+      break;
 
-          /* and store this in Fstat-matrix as element {m,n} */
-          gsl_matrix_set ( ret->F_mn, m, n, F );
+    default:
+      XLALPrintError ("%s: invalid transient window type %d not in [%d, %d].\n",
+                      __func__, windowRange.type, TRANSIENT_NONE, TRANSIENT_LAST -1 );
+      XLAL_ERROR_NULL ( XLAL_EINVAL );
+      break;
 
-        } /* for n in n[tau] : n[tau+tauBand] */
+    } /* switch window.type */
 
-    } /* for m in m[t0] : m[t0+t0Band] */
+  ret->t0_ML  = windowRange.t0 + m_max * windowRange.dt0;	/* start-time t0 corresponding to Fmax */
+  ret->tau_ML = windowRange.tau + n_max * windowRange.dtau;	/* timescale tau corresponding to Fmax */
 
   /* free internal mem */
   XLALDestroyFstatAtomVector ( atoms );
@@ -851,7 +1099,88 @@ XLALComputeTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, 	/**
   /* return end product: F-stat map */
   return ret;
 
-} /* XLALComputeTransientFstatMap() */
+} /* XLALComputeTransientFstatMapThreaded() */
+
+/**
+ * Return true if XLALComputeTransientFstatMapCUDA() is available, i.e. if LALPulsar was compiled
+ * with CUDA support and a CUDA device is available on the current execution machine
+ */
+int
+XLALTransientFstatMapCUDAIsAvailable ( void )
+{
+#ifdef LALPULSAR_CUDA_ENABLED
+  return XLALTransientCUDAIsAvailable_intern();
+#else
+  return 0;
+#endif
+} /* XLALTransientFstatMapCUDAIsAvailable() */
+
+/**
+ * Compute the transient-window "F-statistic map" over {t0, tau} as XLALComputeTransientFstatMap(),
+ * with the windowed sums over the atoms computed on a CUDA device, one device thread per {t0, tau} window.
+ * Fails with XLAL_EFAILED if LALPulsar was compiled without CUDA support.
+ */
+transientFstatMap_t *
+XLALComputeTransientFstatMapCUDA ( const MultiFstatAtomVector *multiFstatAtoms, 	/**< [in] multi-IFO F-statistic atoms */
+                                   transientWindowRange_t windowRange,		/**< [in] type and parameters specifying transient window range to search */
+                                   BOOLEAN useFReg				/**< [in] experimental switch: compute FReg = F - log(D) instead of F */
+                                   )
+{
+#ifdef LALPULSAR_CUDA_ENABLED
+  FstatAtomVector *atoms = NULL;
+  transientFstatMap_t *ret = XLALPrepareTransientFstatMap ( &atoms, &windowRange, multiFstatAtoms );
+  XLAL_CHECK_NULL ( ret != NULL, XLAL_EFUNC );
+
+  const UINT4 numAtoms = atoms->length;
+  const UINT4 N_t0Range = ret->F_mn->size1;
+  const UINT4 N_tauRange = ret->F_mn->size2;
+
+  /* pack atoms into plain arrays for the device */
+  REAL4 *atomsData = XLALMalloc ( TRANSIENT_CUDA_NUM_SUMS * numAtoms * sizeof(*atomsData) );
+  REAL8 *sums = XLALMalloc ( TRANSIENT_CUDA_NUM_SUMS * N_t0Range * N_tauRange * sizeof(*sums) );
+  XLAL_CHECK_NULL ( atomsData != NULL && sums != NULL, XLAL_ENOMEM );
+  for ( UINT4 i = 0; i < numAtoms; i ++ )
+    {
+      const FstatAtom *thisAtom_i = &atoms->data[i];
+      REAL4 *data_i = &atomsData[TRANSIENT_CUDA_NUM_SUMS * i];
+      data_i[0] = thisAtom_i->a2_alpha;
+      data_i[1] = thisAtom_i->b2_alpha;
+      data_i[2] = thisAtom_i->ab_alpha;
+      data_i[3] = crealf ( thisAtom_i->Fa_alpha );
+      data_i[4] = cimagf ( thisAtom_i->Fa_alpha );
+      data_i[5] = crealf ( thisAtom_i->Fb_alpha );
+      data_i[6] = cimagf ( thisAtom_i->Fb_alpha );
+    }
+
+  XLAL_CHECK_NULL ( XLALComputeTransientWindowSums_CUDA ( sums, atomsData, numAtoms, atoms->data[0].timestamp, atoms->TAtom, windowRange, N_t0Range, N_tauRange ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  UINT4 m_max = 0, n_max = 0;
+  for ( UINT4 m = 0; m < N_t0Range; m ++ )
+    {
+      for ( UINT4 n = 0; n < N_tauRange; n ++ )
+        {
+          const REAL8 *sums_mn = &sums[TRANSIENT_CUDA_NUM_SUMS * ( m * N_tauRange + n )];
+          REAL4 FReg;
+          REAL4 F = XLALComputeTransientFstatFromSums ( &FReg, sums_mn[0], sums_mn[1], sums_mn[2], crect ( sums_mn[3], sums_mn[4] ), crect ( sums_mn[5], sums_mn[6] ) );
+          XLALUpdateTransientFstatMax ( &ret->maxF, &m_max, &n_max, F, m, n );
+          gsl_matrix_set ( ret->F_mn, m, n, useFReg ? FReg : F );
+        }
+    }
+
+  ret->t0_ML  = windowRange.t0 + m_max * windowRange.dt0;	/* start-time t0 corresponding to Fmax */
+  ret->tau_ML = windowRange.tau + n_max * windowRange.dtau;	/* timescale tau corresponding to Fmax */
+
+  /* free internal mem */
+  XLALFree ( atomsData );
+  XLALFree ( sums );
+  XLALDestroyFstatAtomVector ( atoms );
+
+  return ret;
+#else
+  (void) multiFstatAtoms; (void) windowRange; (void) useFReg;
+  XLAL_ERROR_NULL ( XLAL_EFAILED, "LALPulsar was compiled without CUDA support" );
+#endif
+} /* XLALComputeTransientFstatMapCUDA() */
 
 
 
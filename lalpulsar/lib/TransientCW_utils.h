@@ -128,6 +128,14 @@ int write_transientCandidateAll_to_fp ( LALFILE *fp, const transientCandidate_t
 transientFstatMap_t *XLALComputeTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms,
                                                     transientWindowRange_t windowRange,
                                                     BOOLEAN useFReg );
+transientFstatMap_t *XLALComputeTransientFstatMapThreaded ( const MultiFstatAtomVector *multiFstatAtoms,
+                                                            transientWindowRange_t windowRange,
+                                                            BOOLEAN useFReg,
+                                                            UINT4 numThreads );
+transientFstatMap_t *XLALComputeTransientFstatMapCUDA ( const MultiFstatAtomVector *multiFstatAtoms,
+                                                        transientWindowRange_t windowRange,
+                                                        BOOLEAN useFReg );
+int XLALTransientFstatMapCUDAIsAvailable ( void );
 
 REAL8 XLALComputeTransientBstat ( transientWindowRange_t windowRange, const transientFstatMap_t *FstatMap );
 pdf1D_t *XLALComputeTransientPosterior_t0  ( transientWindowRange_t windowRange, const transientFstatMap_t *FstatMap );
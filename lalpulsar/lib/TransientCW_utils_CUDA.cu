@@ -0,0 +1,161 @@
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301  USA
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include <cuda.h>
+#include <cuda_runtime.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/TransientCW_utils.h>
+
+///
+/// \file TransientCW_utils_CUDA.cu
+/// \brief CUDA implementation of the windowed sums over F-statistic atoms used by XLALComputeTransientFstatMapCUDA()
+///
+/// The binned atoms are uploaded to the device once per F-statistic map; one device thread then sums the
+/// (window-weighted) atoms of one {t0, tau} window. Only the windowed sums are copied back to the host,
+/// where the F-statistic is computed from them exactly as in XLALComputeTransientFstatMap().
+///
+
+// ----- local macros ----------
+#define CUDA_BLOCK_SIZE 256
+#define CUDA_NUM_BLOCKS(n) ( ( (n) + CUDA_BLOCK_SIZE - 1 ) / CUDA_BLOCK_SIZE )
+
+#define NUM_SUMS 7	// number of values per atom/window: A, B, C, Re/Im Fa, Re/Im Fb
+
+#define XLAL_CHECK_CUDA(expr, ...) do {                                 \
+    cudaError_t XLAL_CHECK_CUDA_err = (expr);                           \
+    XLAL_CHECK ( XLAL_CHECK_CUDA_err == cudaSuccess, __VA_ARGS__, "%s: %s", #expr, cudaGetErrorString ( XLAL_CHECK_CUDA_err ) ); \
+  } while(0)
+
+extern "C" {
+  int XLALTransientCUDAIsAvailable_intern ( void );
+  int XLALComputeTransientWindowSums_CUDA ( REAL8 *sums, const REAL4 *atomsData, UINT4 numAtoms, UINT4 t0_data, UINT4 TAtom,
+                                            transientWindowRange_t windowRange, UINT4 N_t0Range, UINT4 N_tauRange );
+}
+
+// ==================== device kernels ====================
+
+// Sum the window-weighted atoms of each {t0_m, tau_n} window; must agree with XLALGetTransientWindowAtomsRange()
+__global__ void
+CUDATransientWindowSums ( double *sums, const float *atomsData, unsigned int numAtoms, unsigned int t0_data, unsigned int TAtom,
+                          transientWindowRange_t windowRange, unsigned int N_t0Range, unsigned int N_tauRange )
+{
+  const unsigned int mn = blockIdx.x * blockDim.x + threadIdx.x;
+  if ( mn >= N_t0Range * N_tauRange ) {
+    return;
+  }
+  const unsigned int m = mn / N_tauRange;
+  const unsigned int n = mn % N_tauRange;
+
+  const unsigned int TAtomHalf = TAtom / 2;
+  const unsigned int t0 = windowRange.t0 + m * windowRange.dt0;
+  const unsigned int tau = windowRange.tau + n * windowRange.dtau;
+  const int isExp = ( windowRange.type == TRANSIENT_EXPONENTIAL );
+  const unsigned int t1 = isExp ? (unsigned int) lround ( t0 + TRANSIENT_EXP_EFOLDING * tau ) : t0 + tau;
+
+  int i_tmp = ( t0 - t0_data + TAtomHalf ) / TAtom;
+  if ( i_tmp < 0 ) i_tmp = 0;
+  unsigned int i_t0 = (unsigned int) i_tmp;
+  if ( i_t0 >= numAtoms ) i_t0 = numAtoms - 1;
+
+  i_tmp = ( t1 - t0_data + TAtomHalf ) / TAtom - 1;
+  if ( i_tmp < 0 ) i_tmp = 0;
+  unsigned int i_t1 = (unsigned int) i_tmp;
+  if ( i_t1 >= numAtoms ) i_t1 = numAtoms - 1;
+
+  double sum[NUM_SUMS] = { 0 };
+  for ( unsigned int i = i_t0; i <= i_t1; i ++ )
+    {
+      double win = 1.0;
+      if ( isExp )
+        {
+          const unsigned int t_i = t0_data + i * TAtom;
+          if ( t_i < t0 || t_i > t1 ) {
+            continue;
+          }
+          win = exp ( - 1.0 * ( t_i - t0 ) / tau );
+        }
+      const double win2 = win * win;
+      const float *data_i = &atomsData[NUM_SUMS * i];
+      for ( unsigned int k = 0; k < 3; k ++ ) {
+        sum[k] += win2 * data_i[k];
+      }
+      for ( unsigned int k = 3; k < NUM_SUMS; k ++ ) {
+        sum[k] += win * data_i[k];
+      }
+    }
+
+  for ( unsigned int k = 0; k < NUM_SUMS; k ++ ) {
+    sums[NUM_SUMS * mn + k] = sum[k];
+  }
+}
+
+// ==================== host functions ====================
+
+///
+/// Return true if a CUDA device is available on the current execution machine
+///
+int
+XLALTransientCUDAIsAvailable_intern ( void )
+{
+  int numDevices = 0;
+  if ( cudaGetDeviceCount ( &numDevices ) != cudaSuccess ) {
+    cudaGetLastError();	// reset CUDA error state
+    return 0;
+  }
+  return ( numDevices > 0 );
+}
+
+///
+/// Compute the windowed sums over atoms of all {t0, tau} windows of a transient window range on a CUDA device
+///
+int
+XLALComputeTransientWindowSums_CUDA ( REAL8 *sums,				///< [out] windowed sums [NUM_SUMS * N_t0Range * N_tauRange]
+                                      const REAL4 *atomsData,			///< [in] binned atoms [NUM_SUMS * numAtoms]
+                                      UINT4 numAtoms,				///< [in] number of binned atoms
+                                      UINT4 t0_data,				///< [in] timestamp of first atom
+                                      UINT4 TAtom,				///< [in] atoms time baseline
+                                      transientWindowRange_t windowRange,	///< [in] transient window range
+                                      UINT4 N_t0Range,				///< [in] number of start-times
+                                      UINT4 N_tauRange				///< [in] number of timescales
+                                      )
+{
+  XLAL_CHECK ( sums != NULL && atomsData != NULL && numAtoms > 0 && TAtom > 0, XLAL_EINVAL );
+  XLAL_CHECK ( windowRange.type == TRANSIENT_RECTANGULAR || windowRange.type == TRANSIENT_EXPONENTIAL, XLAL_EINVAL );
+
+  const UINT4 numWindows = N_t0Range * N_tauRange;
+  float *d_atomsData = NULL;
+  double *d_sums = NULL;
+  XLAL_CHECK_CUDA ( cudaMalloc ( (void **) &d_atomsData, NUM_SUMS * numAtoms * sizeof(float) ), XLAL_ENOMEM );
+  XLAL_CHECK_CUDA ( cudaMalloc ( (void **) &d_sums, NUM_SUMS * numWindows * sizeof(double) ), XLAL_ENOMEM );
+  XLAL_CHECK_CUDA ( cudaMemcpy ( d_atomsData, atomsData, NUM_SUMS * numAtoms * sizeof(float), cudaMemcpyHostToDevice ), XLAL_EFAILED );
+
+  CUDATransientWindowSums<<< CUDA_NUM_BLOCKS(numWindows), CUDA_BLOCK_SIZE >>> ( d_sums, d_atomsData, numAtoms, t0_data, TAtom, windowRange, N_t0Range, N_tauRange );
+  XLAL_CHECK_CUDA ( cudaGetLastError(), XLAL_EFAILED );
+
+  XLAL_CHECK_CUDA ( cudaMemcpy ( sums, d_sums, NUM_SUMS * numWindows * sizeof(double), cudaMemcpyDeviceToHost ), XLAL_EFAILED );
+
+  cudaFree ( d_atomsData );
+  cudaFree ( d_sums );
+
+  return XLAL_SUCCESS;
+
+} // XLALComputeTransientWindowSums_CUDA()
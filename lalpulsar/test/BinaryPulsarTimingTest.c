@@ -0,0 +1,161 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/AVFactories.h>
+#include <lal/ReadPulsarParFile.h>
+#include <lal/BinaryPulsarTiming.h>
+
+/**
+ * \file
+ * \ingroup lalpulsar_general
+ * \brief Tests for XLALComputeEccentricAnomalyVector() and XLALBinaryPulsarDeltaTNewVector()
+ *
+ * The vector functions are compared against XLALComputeEccentricAnomaly() and
+ * XLALBinaryPulsarDeltaTNew() evaluated one timestamp at a time.
+ */
+
+#define NUM_TIMES 2000
+#define T_START 800000000.0
+#define T_STEP 61.0
+
+/* tolerance on eccentric anomalies, in radians */
+#define U_TOL 1e-12
+
+/* tolerance on binary delays, in seconds */
+#define DT_TOL 1e-11
+
+static int test_eccentric_anomaly( REAL8 ecc )
+{
+  REAL8Vector *phase = XLALCreateREAL8Vector( NUM_TIMES );
+  REAL8Vector *u = XLALCreateREAL8Vector( NUM_TIMES );
+  XLAL_CHECK( phase != NULL && u != NULL, XLAL_EFUNC );
+
+  /* mean anomalies for an orbital period of ~40 timestamps, wrapped to [0, 2pi) */
+  for ( UINT4 i = 0; i < NUM_TIMES; i++ ) {
+    phase->data[i] = fmod( 0.157 * i + 0.3, LAL_TWOPI );
+  }
+
+  /* solutions started from the previous timestamp */
+  XLAL_CHECK( XLALComputeEccentricAnomalyVector( u, phase, ecc, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  for ( UINT4 i = 0; i < NUM_TIMES; i++ ) {
+    REAL8 u0 = 0;
+    XLALComputeEccentricAnomaly( phase->data[i], ecc, &u0 );
+    XLAL_CHECK( fabs( u->data[i] - u0 ) < U_TOL, XLAL_ETOL, "ecc=%g: u[%u] = %.16g differs from %.16g", ecc, i, u->data[i], u0 );
+  }
+
+  /* solutions started from those for a slightly different eccentricity */
+  XLAL_CHECK( XLALComputeEccentricAnomalyVector( u, phase, ecc * 0.99, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALComputeEccentricAnomalyVector( u, phase, ecc, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  for ( UINT4 i = 0; i < NUM_TIMES; i++ ) {
+    REAL8 u0 = 0;
+    XLALComputeEccentricAnomaly( phase->data[i], ecc, &u0 );
+    XLAL_CHECK( fabs( u->data[i] - u0 ) < U_TOL, XLAL_ETOL, "ecc=%g, with guess: u[%u] = %.16g differs from %.16g", ecc, i, u->data[i], u0 );
+  }
+
+  XLALDestroyREAL8Vector( phase );
+  XLALDestroyREAL8Vector( u );
+
+  return XLAL_SUCCESS;
+}
+
+static int test_binary_delay( const CHAR *model, REAL8 ecc )
+{
+  PulsarParameters *params = XLALCalloc( 1, sizeof( *params ) );
+  XLAL_CHECK( params != NULL, XLAL_ENOMEM );
+
+  PulsarAddStringParam( params, "BINARY", model );
+  PulsarAddREAL8Param( params, "PB", 0.8 * 86400.0 );
+  PulsarAddREAL8Param( params, "A1", 1.44 );
+  PulsarAddREAL8Param( params, "OM", 1.1 );
+  PulsarAddREAL8Param( params, "OMDOT", 1e-9 );
+  PulsarAddREAL8Param( params, "GAMMA", 4e-3 );
+  PulsarAddREAL8Param( params, "SINI", 0.7 );
+  PulsarAddREAL8Param( params, "M2", 1.4 * LAL_MSUN_SI );
+  if ( !strcmp( model, "ELL1" ) ) {
+    PulsarAddREAL8Param( params, "TASC", T_START - 1234.5 );
+    PulsarAddREAL8Param( params, "EPS1", ecc * sin( 1.1 ) );
+    PulsarAddREAL8Param( params, "EPS2", ecc * cos( 1.1 ) );
+  } else {
+    PulsarAddREAL8Param( params, "T0", T_START - 1234.5 );
+    PulsarAddREAL8Param( params, "ECC", ecc );
+  }
+  if ( !strcmp( model, "BT1P" ) ) {
+    PulsarAddREAL8Param( params, "PB_2", 11.3 * 86400.0 );
+    PulsarAddREAL8Param( params, "A1_2", 0.2 );
+    PulsarAddREAL8Param( params, "OM_2", 0.4 );
+    PulsarAddREAL8Param( params, "T0_2", T_START + 4321.0 );
+    PulsarAddREAL8Param( params, "ECC_2", 0.5 * ecc );
+  }
+
+  REAL8Vector *tb = XLALCreateREAL8Vector( NUM_TIMES );
+  REAL8Vector *deltaT = XLALCreateREAL8Vector( NUM_TIMES );
+  XLAL_CHECK( tb != NULL && deltaT != NULL, XLAL_EFUNC );
+  for ( UINT4 i = 0; i < NUM_TIMES; i++ ) {
+    tb->data[i] = T_START + T_STEP * i;
+  }
+
+  XLAL_CHECK( XLALBinaryPulsarDeltaTNewVector( deltaT, tb, NULL, params ) == XLAL_SUCCESS, XLAL_EFUNC );
+  for ( UINT4 i = 0; i < NUM_TIMES; i++ ) {
+    BinaryPulsarInput input;
+    BinaryPulsarOutput output;
+    memset( &input, 0, sizeof( input ) );
+    input.tb = tb->data[i];
+    XLALBinaryPulsarDeltaTNew( &output, &input, params );
+    XLAL_CHECK( xlalErrno == 0, XLAL_EFUNC );
+    XLAL_CHECK( fabs( deltaT->data[i] - output.deltaT ) < DT_TOL, XLAL_ETOL,
+                "%s, ecc=%g: deltaT[%u] = %.16g differs from %.16g", model, ecc, i, deltaT->data[i], output.deltaT );
+  }
+
+  /* Earth states are required for Kopeikin terms */
+  PulsarAddREAL8Param( params, "KIN", 0.3 );
+  PulsarAddREAL8Param( params, "KOM", 0.2 );
+  PulsarAddREAL8Param( params, "PMRA", 1e-16 );
+  int errnum = 0;
+  XLAL_TRY_SILENT( XLALBinaryPulsarDeltaTNewVector( deltaT, tb, NULL, params ), errnum );
+  XLAL_CHECK( errnum == XLAL_EFAULT, XLAL_EFAILED, "%s: missing Earth states returned errnum=%i", model, errnum );
+
+  XLALDestroyREAL8Vector( tb );
+  XLALDestroyREAL8Vector( deltaT );
+  PulsarFreeParams( params );
+
+  return XLAL_SUCCESS;
+}
+
+int main( void )
+{
+  const REAL8 eccs[] = { 0.0, 1e-5, 0.03, 0.3, 0.7, 0.95 };
+  for ( UINT4 i = 0; i < XLAL_NUM_ELEM( eccs ); i++ ) {
+    XLAL_CHECK_MAIN( test_eccentric_anomaly( eccs[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( test_binary_delay( "BT", eccs[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( test_binary_delay( "BT1P", eccs[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( test_binary_delay( "DD", eccs[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( test_binary_delay( "MSS", eccs[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    if ( eccs[i] < 0.1 ) {
+      XLAL_CHECK_MAIN( test_binary_delay( "ELL1", eccs[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+  }
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+}
@@ -195,7 +195,42 @@ main ( int argc, char *argv[] )
   XLAL_CHECK ( err_DeltaT < tolerance, XLAL_ETOL, "error(DeltaT) = %g exceeds tolerance of %g\n", err_DeltaT, tolerance );
   XLAL_CHECK ( err_Tdot   < tolerance, XLAL_ETOL, "error(Tdot) = %g exceeds tolerance of %g\n", err_Tdot, tolerance );
 
-  // ---- step 4: clean-up memory
+  // ----- step 4: compare batched SSB times against XLALGetMultiSSBtimes() for several sky positions
+  {
+    SkyPosition batchPos[5];
+    const UINT4 numPos = XLAL_NUM_ELEM(batchPos);
+    for ( UINT4 k = 0; k < numPos; k ++ )
+      {
+        batchPos[k].system = COORDINATESYSTEM_EQUATORIAL;
+        batchPos[k].longitude = LAL_TWOPI * k / numPos;
+        batchPos[k].latitude = LAL_PI * ( k + 0.5 ) / numPos - LAL_PI_2;
+      }
+    const SSBprecision batchPrec[] = { SSBPREC_NEWTONIAN, SSBPREC_RELATIVISTIC, SSBPREC_RELATIVISTICOPT };
+    for ( UINT4 p = 0; p < XLAL_NUM_ELEM(batchPrec); p ++ )
+      {
+        MultiSSBtimesBatch *multiBatch = XLALGetMultiSSBtimesBatch ( multiDetStates, batchPos, numPos, refTime, batchPrec[p] );
+        XLAL_CHECK ( multiBatch != NULL, XLAL_EFUNC, "XLALGetMultiSSBtimesBatch() failed.\n");
+        for ( UINT4 k = 0; k < numPos; k ++ )
+          {
+            MultiSSBtimes *multiSSB = XLALGetMultiSSBtimes ( multiDetStates, batchPos[k], refTime, batchPrec[p] );
+            XLAL_CHECK ( multiSSB != NULL, XLAL_EFUNC, "XLALGetMultiSSBtimes() failed.\n");
+            for ( UINT4 X = 0; X < multiSSB->length; X ++ )
+              {
+                const UINT4 numSteps = multiSSB->data[X]->DeltaT->length;
+                REAL8Vector batchDeltaT = { .length = numSteps, .data = multiBatch->data[X]->DeltaT->data + k * numSteps };
+                REAL8Vector batchTdot = { .length = numSteps, .data = multiBatch->data[X]->Tdot->data + k * numSteps };
+                SSBtimes batchSSB = { .refTime = multiBatch->data[X]->refTime, .DeltaT = &batchDeltaT, .Tdot = &batchTdot };
+                XLAL_CHECK ( XLALCompareSSBtimes ( &err_DeltaT, &err_Tdot, multiSSB->data[X], &batchSSB ) == XLAL_SUCCESS, XLAL_EFUNC );
+                XLAL_CHECK ( err_DeltaT < tolerance, XLAL_ETOL, "batch error(DeltaT) = %g exceeds tolerance of %g\n", err_DeltaT, tolerance );
+                XLAL_CHECK ( err_Tdot   < tolerance, XLAL_ETOL, "batch error(Tdot) = %g exceeds tolerance of %g\n", err_Tdot, tolerance );
+              }
+            XLALDestroyMultiSSBtimes ( multiSSB );
+          }
+        XLALDestroyMultiSSBtimesBatch ( multiBatch );
+      }
+  }
+
+  // ---- step 5: clean-up memory
   XLALDestroyUserVars();
   XLALDestroyEphemerisData ( edat );
   XLALDestroyMultiSSBtimes ( multiBinary_test );
@@ -0,0 +1,129 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+#include <config.h>
+#include <math.h>
+#include <stdio.h>
+
+#include <lal/CWMakeFakeData.h>
+#include <lal/LALInitBarycenter.h>
+#include <lal/SFTutils.h>
+#include <lal/StringVector.h>
+
+// Test the direct signal synthesis of XLALCWMakeFakeMultiData() ('fastInjection') against the exact injection path
+
+#define NUM_INJ 5
+#define TOLERANCE 1e-2
+
+int main( void )
+{
+
+  // ----- load ephemeris
+  EphemerisData *edat;
+  XLAL_CHECK_MAIN( ( edat = XLALInitBarycenter( TEST_PKG_DATA_DIR "earth00-19-DE405.dat.gz", TEST_PKG_DATA_DIR "sun00-19-DE405.dat.gz" ) ) != NULL, XLAL_EFUNC );
+
+  // ----- set up detectors and SFT timestamps, without noise
+  LALStringVector *detNames;
+  XLAL_CHECK_MAIN( ( detNames = XLALCreateStringVector( "H1", "L1", NULL ) ) != NULL, XLAL_EFUNC );
+  CWMFDataParams XLAL_INIT_DECL( dataParams );
+  XLAL_CHECK_MAIN( XLALParseMultiLALDetector( &dataParams.multiIFO, detNames ) == XLAL_SUCCESS, XLAL_EFUNC );
+  const UINT4 numDet = dataParams.multiIFO.length;
+  const REAL8 Tsft = 1800;
+  const REAL8 Tspan = 4 * Tsft;
+  LIGOTimeGPS startTime = { 1100000000, 0 };
+  MultiLIGOTimeGPSVector *multiTS;
+  XLAL_CHECK_MAIN( ( multiTS = XLALMakeMultiTimestamps( startTime, Tspan, Tsft, 0, numDet ) ) != NULL, XLAL_EFUNC );
+  dataParams.multiTimestamps = *multiTS;
+  dataParams.multiNoiseFloor.length = numDet;
+  dataParams.fMin = 99.5;
+  dataParams.Band = 1.0;
+  dataParams.SFTWindowType = "rectangular";
+
+  // ----- isolated sources, two of which share a sky position, with spindowns and transient windows;
+  // ----- plus one binary source, which always goes through the exact injection path
+  PulsarParamsVector *injectionSources;
+  XLAL_CHECK_MAIN( ( injectionSources = XLALCreatePulsarParamsVector( NUM_INJ ) ) != NULL, XLAL_EFUNC );
+  for ( UINT4 j = 0; j < NUM_INJ; ++j ) {
+    PulsarParams *pp = &injectionSources->data[j];
+    const REAL8 h0 = 1.0, cosi = 0.3 + 0.1 * j;
+    pp->Amp.aPlus = 0.5 * h0 * ( 1.0 + cosi * cosi );
+    pp->Amp.aCross = h0 * cosi;
+    pp->Amp.psi = 0.2 * j;
+    pp->Amp.phi0 = 0.7 * j;
+    pp->Doppler.Alpha = ( j < 2 ) ? 1.2 : 0.4 + 0.5 * j;
+    pp->Doppler.Delta = ( j < 2 ) ? -0.3 : 0.9 - 0.4 * j;
+    pp->Doppler.fkdot[0] = 99.8 + 0.1 * j;
+    pp->Doppler.fkdot[1] = -1e-9 * j;
+    pp->Doppler.refTime = startTime;
+    XLALGPSAdd( &pp->Doppler.refTime, -0.5 * Tspan );
+  }
+  injectionSources->data[1].Transient.type = TRANSIENT_RECTANGULAR;
+  injectionSources->data[1].Transient.t0 = startTime.gpsSeconds + 2000;
+  injectionSources->data[1].Transient.tau = 3000;
+  injectionSources->data[2].Transient.type = TRANSIENT_EXPONENTIAL;
+  injectionSources->data[2].Transient.t0 = startTime.gpsSeconds + 1000;
+  injectionSources->data[2].Transient.tau = 1500;
+  injectionSources->data[4].Doppler.asini = 1.0;
+  injectionSources->data[4].Doppler.period = 10 * 3600;
+  injectionSources->data[4].Doppler.ecc = 0;
+  injectionSources->data[4].Doppler.argp = 0.5;
+  injectionSources->data[4].Doppler.tp = startTime;
+
+  // ----- generate SFTs with the exact and the direct injection paths
+  MultiSFTVector *multiSFTsExact = NULL, *multiSFTsDirect = NULL;
+  dataParams.fastInjection = 0;
+  XLAL_CHECK_MAIN( XLALCWMakeFakeMultiData( &multiSFTsExact, NULL, injectionSources, &dataParams, edat ) == XLAL_SUCCESS, XLAL_EFUNC );
+  dataParams.fastInjection = 1;
+  XLAL_CHECK_MAIN( XLALCWMakeFakeMultiData( &multiSFTsDirect, NULL, injectionSources, &dataParams, edat ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // ----- compare SFTs: relative root-mean-square difference over all bins of each detector
+  XLAL_CHECK_MAIN( multiSFTsExact->length == multiSFTsDirect->length, XLAL_EFAILED );
+  for ( UINT4 X = 0; X < multiSFTsExact->length; ++X ) {
+    const SFTVector *sftsExact = multiSFTsExact->data[X];
+    const SFTVector *sftsDirect = multiSFTsDirect->data[X];
+    XLAL_CHECK_MAIN( sftsExact->length == sftsDirect->length, XLAL_EFAILED );
+    REAL8 sumDiff2 = 0, sumExact2 = 0;
+    for ( UINT4 n = 0; n < sftsExact->length; ++n ) {
+      const COMPLEX8Vector *dataExact = sftsExact->data[n].data;
+      const COMPLEX8Vector *dataDirect = sftsDirect->data[n].data;
+      XLAL_CHECK_MAIN( dataExact->length == dataDirect->length, XLAL_EFAILED );
+      XLAL_CHECK_MAIN( XLALGPSCmp( &sftsExact->data[n].epoch, &sftsDirect->data[n].epoch ) == 0, XLAL_EFAILED );
+      XLAL_CHECK_MAIN( sftsExact->data[n].f0 == sftsDirect->data[n].f0, XLAL_EFAILED );
+      for ( UINT4 k = 0; k < dataExact->length; ++k ) {
+        const COMPLEX8 diff = dataDirect->data[k] - dataExact->data[k];
+        sumDiff2 += crealf( diff ) * crealf( diff ) + cimagf( diff ) * cimagf( diff );
+        sumExact2 += crealf( dataExact->data[k] ) * crealf( dataExact->data[k] ) + cimagf( dataExact->data[k] ) * cimagf( dataExact->data[k] );
+      }
+    }
+    XLAL_CHECK_MAIN( sumExact2 > 0, XLAL_EFAILED );
+    const REAL8 relErr = sqrt( sumDiff2 / sumExact2 );
+    printf( "detector %s: relative RMS difference between direct and exact injections = %.3e\n", sftsExact->data[0].name, relErr );
+    XLAL_CHECK_MAIN( relErr <= TOLERANCE, XLAL_ETOL, "Relative RMS difference %g exceeds tolerance %g for detector %s", relErr, TOLERANCE, sftsExact->data[0].name );
+  }
+
+  // ----- cleanup
+  XLALDestroyMultiSFTVector( multiSFTsExact );
+  XLALDestroyMultiSFTVector( multiSFTsDirect );
+  XLALDestroyPulsarParamsVector( injectionSources );
+  XLALDestroyMultiTimestamps( multiTS );
+  XLALDestroyStringVector( detNames );
+  XLALDestroyEphemerisData( edat );
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
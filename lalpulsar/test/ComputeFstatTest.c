@@ -164,10 +164,15 @@ main ( int argc, char *argv[] )
       optionalArgs.FstatMethod = iMethod;
       optionalArgs.prevInput = NULL;
       optionalArgs.resampFFTPowerOf2 = (1 == 1);
+      optionalArgs.resampNumThreads = 0;
       XLAL_CHECK ( (input_seg1[iMethod] = XLALCreateFstatInput ( catalog, minCoverFreq, maxCoverFreq, dFreq, ephem, &optionalArgs )) != NULL, XLAL_EFUNC );
       optionalArgs.prevInput = input_seg1[iMethod];
       optionalArgs.resampFFTPowerOf2 = (1 == 0);
+      optionalArgs.resampNumThreads = 2;	// also test threaded Resamp spindown+FFT loop [ignored by Demod]
+      optionalArgs.resampMemPlacement = ( iMethod % 2 == 0 ) ? LAL_MEMORY_PLACEMENT_LOCAL : LAL_MEMORY_PLACEMENT_INTERLEAVE;
       XLAL_CHECK ( (input_seg2[iMethod] = XLALCreateFstatInput ( catalog, minCoverFreq - 0.01, maxCoverFreq + 0.01, dFreq, ephem, &optionalArgs )) != NULL, XLAL_EFUNC );
+      optionalArgs.resampNumThreads = 0;
+      optionalArgs.resampMemPlacement = LAL_MEMORY_PLACEMENT_DEFAULT;
     }
 
 
@@ -232,6 +237,44 @@ main ( int argc, char *argv[] )
 
     } // for iSky < numSkyPoints
 
+  // ----- test XLALComputeFstatBatch(): results for a batch of (interleaved) sky positions must match XLALComputeFstat();
+  // ----- the last templates share the frequency band of earlier ones, with overlapping, adjoining, and off-grid bands
+  for ( UINT4 iMethod = FMETHOD_START; iMethod < FMETHOD_END; iMethod ++ )
+    {
+      if ( !XLALFstatMethodIsAvailable(iMethod) || (iMethod == FMETHOD_DEMOD_BEST) || (iMethod == FMETHOD_RESAMP_BEST) ) {
+        continue;
+      }
+      enum { numBatch = 7 };
+      PulsarDopplerParams XLAL_INIT_DECL(batchDopplers, [numBatch]);
+      FstatResults *batchResults[numBatch] = { NULL };
+      FstatResults *singleResults = NULL;
+      for ( UINT4 i = 0; i < 4; i ++ )
+        {
+          batchDopplers[i] = Doppler;
+          batchDopplers[i].Alpha += ( i % 2 ) * dSky;
+          batchDopplers[i].fkdot[1] += ( i / 2 ) * df1dot;
+        }
+      batchDopplers[4] = batchDopplers[0];
+      batchDopplers[4].fkdot[0] += 40 * dFreq;
+      batchDopplers[5] = batchDopplers[3];
+      batchDopplers[5].fkdot[0] += numFreqBins * dFreq;
+      batchDopplers[6] = batchDopplers[1];
+      batchDopplers[6].fkdot[0] += 0.5 * dFreq;
+      XLAL_CHECK ( XLALComputeFstatBatch ( batchResults, input_seg1[iMethod], batchDopplers, numBatch, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+      for ( UINT4 i = 0; i < numBatch; i ++ )
+        {
+          XLAL_CHECK ( XLALComputeFstat ( &singleResults, input_seg1[iMethod], &batchDopplers[i], numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+          XLALPrintInfo ("Comparing batch and single-template results for method '%s', template %d\n", XLALGetFstatInputMethodName(input_seg1[iMethod]), i );
+          if ( compareFstatResults ( singleResults, batchResults[i] ) != XLAL_SUCCESS )
+            {
+              XLALPrintError ("Comparison between batch and single-template results failed for method '%s', template %d\n", XLALGetFstatInputMethodName(input_seg1[iMethod]), i );
+              XLAL_ERROR ( XLAL_EFUNC );
+            }
+          XLALDestroyFstatResults ( batchResults[i] );
+        }
+      XLALDestroyFstatResults ( singleResults );
+    } // for iMethod < FMETHOD_END
+
   // ----- test XLALFstatInputTimeslice()
   // setup optional Fstat arguments
   optionalArgs.FstatMethod = FMETHOD_DEMOD_BEST; // only use demod best
@@ -279,6 +322,118 @@ main ( int argc, char *argv[] )
       XLAL_ERROR ( XLAL_EFUNC );
     }
 
+  // ----- test XLALWriteFstatInputSnapshot() and XLALCreateFstatInputFromSnapshot(): results must match the original input
+  for ( UINT4 iMethod = FMETHOD_START; iMethod < FMETHOD_END; iMethod ++ )
+    {
+      if ( !XLALFstatMethodIsAvailable(iMethod) || (iMethod == FMETHOD_DEMOD_BEST) || (iMethod == FMETHOD_RESAMP_BEST) ) {
+        continue;
+      }
+      const char *snapshotFile = "ComputeFstatTest.snapshot";
+      XLAL_CHECK ( XLALWriteFstatInputSnapshot ( snapshotFile, input_seg1[iMethod] ) == XLAL_SUCCESS, XLAL_EFUNC );
+      optionalArgs.FstatMethod = iMethod;
+      optionalArgs.prevInput = NULL;
+      FstatInput *input_snapshot = NULL;
+      XLAL_CHECK ( ( input_snapshot = XLALCreateFstatInputFromSnapshot ( snapshotFile, ephem, &optionalArgs ) ) != NULL, XLAL_EFUNC );
+      FstatResults *results_snapshot = NULL, *results_orig = NULL;
+      XLAL_CHECK ( XLALComputeFstat ( &results_orig, input_seg1[iMethod], &Doppler, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK ( XLALComputeFstat ( &results_snapshot, input_snapshot, &Doppler, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLALPrintInfo ("Comparing original and snapshot results for method '%s'\n", XLALGetFstatInputMethodName(input_seg1[iMethod]) );
+      if ( compareFstatResults ( results_orig, results_snapshot ) != XLAL_SUCCESS )
+        {
+          XLALPrintError ("Comparison between original and snapshot results failed for method '%s'\n", XLALGetFstatInputMethodName(input_seg1[iMethod]) );
+          XLAL_ERROR ( XLAL_EFUNC );
+        }
+      XLALDestroyFstatResults ( results_orig );
+      XLALDestroyFstatResults ( results_snapshot );
+      XLALDestroyFstatInput ( input_snapshot );
+      remove ( snapshotFile );
+    } // for iMethod < FMETHOD_END
+
+  // ----- test XLALCreateFstatInputStream() and XLALCreateFstatInputFromStream(): results for SFTs appended out of order,
+  // ----- and refreshed while SFTs are appended, must match an input created from the same SFTs all at once
+  for ( UINT4 iMethod = FMETHOD_START; iMethod < FMETHOD_END; iMethod ++ )
+    {
+      if ( !XLALFstatMethodIsAvailable(iMethod) || (iMethod == FMETHOD_DEMOD_BEST) || (iMethod == FMETHOD_RESAMP_BEST) ) {
+        continue;
+      }
+      FstatOptionalArgs streamArgs = optionalArgs;
+      streamArgs.FstatMethod = iMethod;
+      streamArgs.injectSources = NULL;
+      streamArgs.injectSqrtSX = NULL;
+      streamArgs.prevInput = NULL;
+      streamArgs.resampFFTPowerOf2 = (1 == 1);
+      const MultiLALDetector *detectors = XLALGetFstatInputDetectors ( input_seg1[iMethod] );
+      XLAL_CHECK ( detectors != NULL, XLAL_EFUNC );
+      FstatInputStream *stream = NULL;
+      XLAL_CHECK ( ( stream = XLALCreateFstatInputStream ( detectors, Tsft, minCoverFreq, maxCoverFreq, dFreq, ephem, &streamArgs ) ) != NULL, XLAL_EFUNC );
+
+      // generate the same SFTs as were injected into 'input_seg1'
+      CWMFDataParams XLAL_INIT_DECL(MFDparams);
+      REAL8 minFreqFull, maxFreqFull, minFreqFullSeg1, maxFreqFullSeg1;
+      XLAL_CHECK ( XLALGetFstatInputStreamSFTBand ( stream, &minFreqFull, &maxFreqFull ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK ( XLALGetFstatInputSFTBand ( input_seg1[iMethod], &minFreqFullSeg1, &maxFreqFullSeg1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK ( minFreqFull == minFreqFullSeg1 && maxFreqFull == maxFreqFullSeg1, XLAL_EFAILED );
+      MFDparams.fMin = minFreqFull;
+      MFDparams.Band = maxFreqFull - minFreqFull;
+      MFDparams.multiIFO = *detectors;
+      MFDparams.multiTimestamps = *multiTimestamps;
+      MFDparams.multiNoiseFloor = injectSqrtSX;
+      MFDparams.randSeed = optionalArgs.randSeed;
+      MultiSFTVector *multiSFTs = NULL;
+      XLAL_CHECK ( XLALCWMakeFakeMultiData ( &multiSFTs, NULL, injectSources, &MFDparams, ephem ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // an input cannot be created before there are more than 1 SFTs per detector
+      FstatInput *input_stream = NULL;
+      int errnum = 0;
+      XLAL_TRY_SILENT ( input_stream = XLALCreateFstatInputFromStream ( stream, NULL ), errnum );
+      XLAL_CHECK ( input_stream == NULL && errnum != 0, XLAL_EFAILED, "Creating an input from an empty stream did not fail" );
+
+      // append the later half of the SFTs of each detector, and create an input from them
+      for ( UINT4 X = 0; X < numDetectors; X ++ )
+        {
+          SFTVector XLAL_INIT_DECL(laterSFTs);
+          laterSFTs.length = multiSFTs->data[X]->length - multiSFTs->data[X]->length / 2;
+          laterSFTs.data = &multiSFTs->data[X]->data[multiSFTs->data[X]->length / 2];
+          XLAL_CHECK ( XLALFstatInputStreamAppendSFTs ( stream, &laterSFTs ) == XLAL_SUCCESS, XLAL_EFUNC );
+        }
+      XLAL_CHECK ( ( input_stream = XLALCreateFstatInputFromStream ( stream, NULL ) ) != NULL, XLAL_EFUNC );
+      FstatResults *results_stream = NULL, *results_orig = NULL;
+      XLAL_CHECK ( XLALComputeFstat ( &results_stream, input_stream, &Doppler, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // append the earlier half of the SFTs one at a time, in reverse order; SFTs cannot be appended twice
+      for ( UINT4 X = 0; X < numDetectors; X ++ )
+        {
+          for ( UINT4 i = multiSFTs->data[X]->length / 2; i -- > 0; )
+            {
+              SFTVector XLAL_INIT_DECL(oneSFT);
+              oneSFT.length = 1;
+              oneSFT.data = &multiSFTs->data[X]->data[i];
+              XLAL_CHECK ( XLALFstatInputStreamAppendSFTs ( stream, &oneSFT ) == XLAL_SUCCESS, XLAL_EFUNC );
+              XLAL_TRY_SILENT ( XLALFstatInputStreamAppendSFTs ( stream, &oneSFT ), errnum );
+              XLAL_CHECK ( errnum != 0, XLAL_EFAILED, "Appending the same SFT twice did not fail" );
+            }
+        }
+
+      // refresh the input, re-using the workspace of the previous input
+      FstatInput *prev_input_stream = input_stream;
+      XLAL_CHECK ( ( input_stream = XLALCreateFstatInputFromStream ( stream, prev_input_stream ) ) != NULL, XLAL_EFUNC );
+      XLALDestroyFstatInput ( prev_input_stream );
+      XLAL_CHECK ( XLALComputeFstat ( &results_orig, input_seg1[iMethod], &Doppler, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK ( XLALComputeFstat ( &results_stream, input_stream, &Doppler, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLALPrintInfo ("Comparing original and stream results for method '%s'\n", XLALGetFstatInputMethodName(input_seg1[iMethod]) );
+      if ( compareFstatResults ( results_orig, results_stream ) != XLAL_SUCCESS )
+        {
+          XLALPrintError ("Comparison between original and stream results failed for method '%s'\n", XLALGetFstatInputMethodName(input_seg1[iMethod]) );
+          XLAL_ERROR ( XLAL_EFUNC );
+        }
+
+      XLALDestroyFstatResults ( results_orig );
+      XLALDestroyFstatResults ( results_stream );
+      XLALDestroyFstatInput ( input_stream );
+      XLALDestroyMultiSFTVector ( multiSFTs );
+      XLALDestroyFstatInputStream ( stream );
+    } // for iMethod < FMETHOD_END
+
   // free remaining memory
   for ( UINT4 iMethod=FMETHOD_START; iMethod < FMETHOD_END; iMethod ++ )
     {
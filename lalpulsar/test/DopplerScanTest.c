@@ -18,8 +18,10 @@
  */
 
 #include <math.h>
+#include <string.h>
 
 #include <lal/LALMalloc.h>
+#include <lal/LALString.h>
 #include <lal/DopplerScan.h>
 #include <lal/DopplerFullScan.h>
 
@@ -37,6 +39,8 @@
 
 // ---------- local prototypes
 static int test_XLALParseSkyRegionString ( void );
+static int test_LazySkyGrid ( DopplerGridType gridType, const CHAR *skyRegionString, UINT4 numSkyPartitions, UINT4 partitionIndex );
+static int test_DopplerFullScanIndex ( DopplerGridType gridType );
 static int compareSkyPosition ( SkyPosition *pos1, SkyPosition *pos2, REAL8 tol );
 // ---------- function definitions --------------------
 
@@ -48,6 +52,22 @@ int main( void )
 
   XLAL_CHECK ( test_XLALParseSkyRegionString() == XLAL_SUCCESS, XLAL_EFUNC );
 
+  const char *skyRegionStrings[] = {
+    "(0.1, -0.8), (5.9, -0.3), (2.2, 1.5)",
+    "(0, -1.570796), (6.283185, -1.570796), (6.283185, 1.570796), (0, 1.570796)",
+    "(1.2, 0.3)",
+  };
+  for ( UINT4 i = 0; i < XLAL_NUM_ELEM ( skyRegionStrings ); i ++ )
+    {
+      XLAL_CHECK ( test_LazySkyGrid ( GRID_FLAT, skyRegionStrings[i], 0, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK ( test_LazySkyGrid ( GRID_ISOTROPIC, skyRegionStrings[i], 0, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+  XLAL_CHECK ( test_LazySkyGrid ( GRID_FLAT, skyRegionStrings[0], 7, 3 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK ( test_LazySkyGrid ( GRID_ISOTROPIC, skyRegionStrings[1], 5, 4 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  XLAL_CHECK ( test_DopplerFullScanIndex ( GRID_FLAT ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK ( test_DopplerFullScanIndex ( GRID_ISOTROPIC ) == XLAL_SUCCESS, XLAL_EFUNC );
+
   /* check for memory leaks */
   LALCheckMemoryLeaks();
 
@@ -90,6 +110,139 @@ test_XLALParseSkyRegionString ( void )
 
 } // test_XLALParseSkyRegionString()
 
+/**
+ * Unit test for DopplerSkyScanInit::lazySkyGrid and XLALGetDopplerSkyPosByIndex():
+ * sky-points generated on demand must be identical to the sky-grid list
+ */
+static int
+test_LazySkyGrid ( DopplerGridType gridType, const CHAR *skyRegionString, UINT4 numSkyPartitions, UINT4 partitionIndex )
+{
+  DopplerSkyScanInit XLAL_INIT_DECL(init);
+  init.gridType = gridType;
+  XLAL_CHECK ( (init.skyRegionString = XLALStringDuplicate ( skyRegionString )) != NULL, XLAL_EFUNC );
+  init.dAlpha = 0.013;
+  init.dDelta = 0.021;
+  init.Freq = 100;
+  init.obsDuration = 86400;
+  init.numSkyPartitions = numSkyPartitions;
+  init.partitionIndex = partitionIndex;
+
+  DopplerSkyScanState XLAL_INIT_DECL(listScan);
+  DopplerSkyScanState XLAL_INIT_DECL(lazyScan);
+  XLAL_CHECK ( XLALInitDopplerSkyScan ( &listScan, &init ) == XLAL_SUCCESS, XLAL_EFUNC );
+  init.lazySkyGrid = 1;
+  XLAL_CHECK ( XLALInitDopplerSkyScan ( &lazyScan, &init ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK ( lazyScan.skyGrid == NULL, XLAL_EFAILED, "Lazy sky-scan built a sky-grid list\n" );
+
+  const UINT4 numPoints = listScan.numSkyGridPoints;
+  XLAL_CHECK ( lazyScan.numSkyGridPoints == numPoints, XLAL_EFAILED, "Lazy sky-scan has %u points instead of %u\n", lazyScan.numSkyGridPoints, numPoints );
+
+  /* sequential access */
+  for ( UINT4 i = 0; i <= numPoints; i ++ )
+    {
+      PulsarDopplerParams XLAL_INIT_DECL(listPos);
+      PulsarDopplerParams XLAL_INIT_DECL(lazyPos);
+      XLAL_CHECK ( XLALNextDopplerSkyPos ( &listPos, &listScan ) == 0, XLAL_EFUNC );
+      XLAL_CHECK ( XLALNextDopplerSkyPos ( &lazyPos, &lazyScan ) == 0, XLAL_EFUNC );
+      XLAL_CHECK ( lazyScan.state == listScan.state, XLAL_EFAILED, "Sky-scans finished at different points\n" );
+      if ( i < numPoints ) {
+        XLAL_CHECK ( (lazyPos.Alpha == listPos.Alpha) && (lazyPos.Delta == listPos.Delta), XLAL_EFAILED,
+                     "Sky-point %u: lazy (%.16g, %.16g) differs from (%.16g, %.16g)\n", i, lazyPos.Alpha, lazyPos.Delta, listPos.Alpha, listPos.Delta );
+      }
+    }
+  XLAL_CHECK ( lazyScan.state == STATE_FINISHED, XLAL_EFAILED );
+
+  /* random access, in an order which jumps between rows */
+  for ( UINT4 j = 0; j < numPoints; j ++ )
+    {
+      const UINT4 i = ( (UINT8)j * 7919 ) % numPoints;
+      PulsarDopplerParams XLAL_INIT_DECL(listPos);
+      PulsarDopplerParams XLAL_INIT_DECL(lazyPos);
+      XLAL_CHECK ( XLALGetDopplerSkyPosByIndex ( &listPos, &listScan, i ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK ( XLALGetDopplerSkyPosByIndex ( &lazyPos, &lazyScan, i ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK ( (lazyPos.Alpha == listPos.Alpha) && (lazyPos.Delta == listPos.Delta), XLAL_EFAILED,
+                   "Sky-point %u: lazy (%.16g, %.16g) differs from (%.16g, %.16g)\n", i, lazyPos.Alpha, lazyPos.Delta, listPos.Alpha, listPos.Delta );
+    }
+
+  XLALDestroyDopplerSkyScan ( &listScan );
+  XLALDestroyDopplerSkyScan ( &lazyScan );
+  XLALFree ( init.skyRegionString );
+
+  return XLAL_SUCCESS;
+
+} // test_LazySkyGrid()
+
+/**
+ * Unit test for XLALGetDopplerPosByIndex(), XLALGetDopplerFullScanIndex() and XLALSetDopplerFullScanIndex():
+ * indexed access to a factored grid must reproduce the templates of XLALNextDopplerPos()
+ */
+static int
+test_DopplerFullScanIndex ( DopplerGridType gridType )
+{
+  CHAR skyRegionString[] = "(0.3, -0.4), (0.5, -0.4), (0.5, -0.1), (0.3, -0.1)";
+  DopplerFullScanInit XLAL_INIT_DECL(init);
+  init.gridType = gridType;
+  init.searchRegion.skyRegionString = skyRegionString;
+  init.searchRegion.fkdot[0] = 100;
+  init.searchRegion.fkdotBand[0] = 0.01;
+  init.searchRegion.fkdot[1] = -1e-9;
+  init.searchRegion.fkdotBand[1] = 1e-9;
+  init.stepSizes.Alpha = 0.04;
+  init.stepSizes.Delta = 0.05;
+  init.stepSizes.fkdot[0] = 1e-3;
+  init.stepSizes.fkdot[1] = 3e-10;
+  init.Tspan = 86400;
+
+  DopplerFullScanState *scan;
+  XLAL_CHECK ( (scan = XLALInitDopplerFullScan ( &init )) != NULL, XLAL_EFUNC );
+  const UINT8 numTemplates = XLALNumDopplerTemplates ( scan );
+  XLAL_CHECK ( numTemplates > 0, XLAL_EFUNC );
+
+  /* step through the whole grid */
+  PulsarDopplerParams *templates;
+  XLAL_CHECK ( (templates = XLALCalloc ( numTemplates, sizeof(templates[0]) )) != NULL, XLAL_ENOMEM );
+  UINT8 n = 0, index = 0;
+  PulsarDopplerParams XLAL_INIT_DECL(pos);
+  while ( XLALNextDopplerPos ( &pos, scan ) == 0 )
+    {
+      XLAL_CHECK ( n < numTemplates, XLAL_EFAILED, "Scan returned more than %" LAL_UINT8_FORMAT " templates\n", numTemplates );
+      templates[n ++] = pos;
+      XLAL_CHECK ( XLALGetDopplerFullScanIndex ( &index, scan ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK ( index == n, XLAL_EFAILED, "Scan index %" LAL_UINT8_FORMAT " should be %" LAL_UINT8_FORMAT "\n", index, n );
+    }
+  XLAL_CHECK ( n == numTemplates, XLAL_EFAILED, "Scan returned %" LAL_UINT8_FORMAT " instead of %" LAL_UINT8_FORMAT " templates\n", n, numTemplates );
+
+  /* random access */
+  for ( UINT8 i = numTemplates; i -- > 0; )
+    {
+      XLAL_CHECK ( XLALGetDopplerPosByIndex ( &pos, scan, i ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK ( memcmp ( &pos, &templates[i], sizeof(pos) ) == 0, XLAL_EFAILED, "Template %" LAL_UINT8_FORMAT " differs from sequential scan\n", i );
+    }
+
+  /* resume from a checkpointed index, and then from the start */
+  const UINT8 seeks[] = { numTemplates / 3, 0 };
+  for ( UINT4 j = 0; j < XLAL_NUM_ELEM ( seeks ); j ++ )
+    {
+      XLAL_CHECK ( XLALSetDopplerFullScanIndex ( scan, seeks[j] ) == XLAL_SUCCESS, XLAL_EFUNC );
+      for ( UINT8 i = seeks[j]; i < numTemplates; i ++ )
+        {
+          XLAL_CHECK ( XLALNextDopplerPos ( &pos, scan ) == 0, XLAL_EFUNC );
+          XLAL_CHECK ( memcmp ( &pos, &templates[i], sizeof(pos) ) == 0, XLAL_EFAILED, "Template %" LAL_UINT8_FORMAT " after seeking to %" LAL_UINT8_FORMAT " differs from sequential scan\n", i, seeks[j] );
+        }
+      XLAL_CHECK ( XLALNextDopplerPos ( &pos, scan ) == 1, XLAL_EFAILED, "Scan did not finish after seeking to %" LAL_UINT8_FORMAT "\n", seeks[j] );
+    }
+
+  /* seeking to the end finishes the scan */
+  XLAL_CHECK ( XLALSetDopplerFullScanIndex ( scan, numTemplates ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK ( XLALNextDopplerPos ( &pos, scan ) == 1, XLAL_EFAILED );
+
+  XLALFree ( templates );
+  XLALDestroyDopplerFullScan ( scan );
+
+  return XLAL_SUCCESS;
+
+} // test_DopplerFullScanIndex()
+
 static int
 compareSkyPosition ( SkyPosition *pos1, SkyPosition *pos2, REAL8 tol )
 {
@@ -62,7 +62,9 @@
  * Then the program builds the set
  * of \c phmd, updates the cylinder and computes a Hough map at a given
  * frequency using only one horizontal line set of \c phmd, and outputs the
- * result into a file.
+ * result into a file. It then checks that several Hough maps constructed in
+ * parallel agree with the same maps constructed one at a time, and likewise
+ * for the \c luts, one of which is given the parameters of another.
  *
  * By default, running this program with no arguments simply tests the subroutines,
  * producing an output file called <tt>OutHough.asc</tt>.  All default parameters are set from
@@ -84,6 +86,8 @@
  * LALHOUGHupdateSpacePHMDup()
  * LALHOUGHInitializeHT()
  * LALHOUGHConstructHMT()
+ * LALHOUGHConstructMultiHMT()
+ * LALHOUGHConstructMultiPLUT()
  * LALPrintError()
  * LALMalloc()
  * LALFree()
@@ -176,9 +180,13 @@ int main(int argc, char *argv[]){
   static HOUGHPatchGrid  patch;   /* Patch description */
 
   static HOUGHParamPLUT  parLut;  /* parameters needed to build lut  */
+  static HOUGHParamPLUT  parLutV[MOBSCOH];  /* parameters of all the luts */
+  static HOUGHptfLUTVector   multiLutV; /* the luts constructed in parallel */
   static HOUGHDemodPar   parDem;  /* demodulation parameters */
   static HOUGHSizePar    parSize;
   static HOUGHMapTotal   ht;   /* the total Hough map */
+  static HOUGHMapTotal   multiHt[NFSIZE];   /* total Hough maps constructed in parallel */
+  static UINT8FrequencyIndexVector multiFreqInd[NFSIZE];
   /* ------------------------------------------------------- */
 
   UINT2  maxNBins, maxNBorders;
@@ -192,7 +200,7 @@ int main(int argc, char *argv[]){
   FILE *fp=NULL;                    /* Output file */
 
   INT4 arg;                         /* Argument counter */
-  UINT4 i,j;                       /* Index counter, etc */
+  UINT4 i,j,m;                     /* Index counter, etc */
   INT4 k;
   REAL8 f0, alpha, delta, veloMod;
   REAL8 patchSizeX, patchSizeY;
@@ -206,6 +214,7 @@ int main(int argc, char *argv[]){
   pgV.length     = MOBSCOH;
   phmdVS.length  = MOBSCOH;
   freqInd.length = MOBSCOH;
+  multiLutV.length = MOBSCOH;
   phmdVS.nfSize  = NFSIZE;
 
   freqInd.deltaF = DF;
@@ -412,6 +421,7 @@ int main(int argc, char *argv[]){
     /* build the LUT */
     SUB( LALHOUGHConstructPLUT( &status, &(lutV.lut[j]), &patch, &parLut ),
 	 &status );
+    parLutV[j] = parLut;
   }
 
 
@@ -490,6 +500,95 @@ int main(int argc, char *argv[]){
   fclose( fp );
 
 
+  /******************************************************************/
+  /* construction of several total Hough maps in parallel, which    */
+  /* must agree with the maps constructed one at a time             */
+  /******************************************************************/
+
+  for (m=0; m<NFSIZE; ++m){
+    multiFreqInd[m].length = MOBSCOH;
+    multiFreqInd[m].deltaF = DF;
+    multiFreqInd[m].data = (UINT8 *)LALMalloc(MOBSCOH*sizeof(UINT8));
+    for (j=0;j< MOBSCOH;++j){
+      multiFreqInd[m].data[j] = fBin + 1 + (j + m) % NFSIZE;
+    }
+    multiHt[m].xSide = xSide;
+    multiHt[m].ySide = ySide;
+    multiHt[m].map = (HoughTT *)LALMalloc(xSide*ySide*sizeof(HoughTT));
+  }
+
+  SUB( LALHOUGHConstructMultiHMT( &status, multiHt, multiFreqInd, NFSIZE, &phmdVS, 0, 2 ), &status );
+
+  for (m=0; m<NFSIZE; ++m){
+    SUB( LALHOUGHConstructHMT( &status, &ht, &(multiFreqInd[m]), &phmdVS ), &status );
+    for (k=0; k<xSide*ySide; ++k){
+      if ( multiHt[m].map[k] != ht.map[k] ){
+        ERROR( TESTDRIVEHOUGHC_EBAD, TESTDRIVEHOUGHC_MSGEBAD, "LALHOUGHConstructMultiHMT() and LALHOUGHConstructHMT() differ" );
+        return TESTDRIVEHOUGHC_EBAD;
+      }
+    }
+  }
+
+
+  /******************************************************************/
+  /* construction of all the luts in parallel, the last one with the  */
+  /* parameters of the first, which must agree with the luts          */
+  /* constructed one at a time                                        */
+  /******************************************************************/
+
+  parLutV[MOBSCOH-1] = parLutV[0];
+  multiLutV.lut = (HOUGHptfLUT *)LALMalloc(MOBSCOH*sizeof(HOUGHptfLUT));
+  for (j=0; j<multiLutV.length; ++j){
+    multiLutV.lut[j].maxNBins = maxNBins;
+    multiLutV.lut[j].maxNBorders = maxNBorders;
+    multiLutV.lut[j].border =
+         (HOUGHBorder *)LALMalloc(maxNBorders*sizeof(HOUGHBorder));
+    multiLutV.lut[j].bin =
+         (HOUGHBin2Border *)LALMalloc(maxNBins*sizeof(HOUGHBin2Border));
+    for (i=0; i<maxNBorders; ++i){
+      multiLutV.lut[j].border[i].ySide = ySide;
+      multiLutV.lut[j].border[i].xPixel =
+                            (COORType *)LALMalloc(ySide*sizeof(COORType));
+    }
+  }
+
+  SUB( LALHOUGHConstructMultiPLUT( &status, &multiLutV, &patch, parLutV, 2 ), &status );
+
+  for (j=0; j<multiLutV.length; ++j){
+    const HOUGHptfLUT *lut = &(lutV.lut[(j == MOBSCOH-1) ? 0 : j]);
+    const HOUGHptfLUT *multiLut = &(multiLutV.lut[j]);
+    BOOLEAN differ = ( multiLut->nBin != lut->nBin || multiLut->iniBin != lut->iniBin
+                       || multiLut->offset != lut->offset );
+    for (k=0; !differ && k<lut->nBin; ++k){
+      const HOUGHBin2Border *b = &(lut->bin[k]), *mb = &(multiLut->bin[k]);
+      differ = ( mb->leftB1 != b->leftB1 || mb->rightB1 != b->rightB1
+                 || mb->leftB2 != b->leftB2 || mb->rightB2 != b->rightB2
+                 || mb->piece1max != b->piece1max || mb->piece1min != b->piece1min
+                 || mb->piece2max != b->piece2max || mb->piece2min != b->piece2min );
+    }
+    for (i=0; !differ && i<maxNBorders; ++i){
+      const HOUGHBorder *b = &(lut->border[i]), *mb = &(multiLut->border[i]);
+      differ = ( mb->yUpper != b->yUpper || mb->yLower != b->yLower );
+      for (k=b->yLower; !differ && k<=b->yUpper; ++k){
+        differ = ( mb->xPixel[k] != b->xPixel[k] );
+      }
+    }
+    if ( differ ){
+      ERROR( TESTDRIVEHOUGHC_EBAD, TESTDRIVEHOUGHC_MSGEBAD, "LALHOUGHConstructMultiPLUT() and LALHOUGHConstructPLUT() differ" );
+      return TESTDRIVEHOUGHC_EBAD;
+    }
+  }
+
+  for (j=0; j<multiLutV.length ; ++j){
+    for (i=0; i<maxNBorders; ++i){
+      LALFree( multiLutV.lut[j].border[i].xPixel);
+    }
+    LALFree( multiLutV.lut[j].border);
+    LALFree( multiLutV.lut[j].bin);
+  }
+  LALFree(multiLutV.lut);
+
+
   /******************************************************************/
   /* Free memory and exit */
   /******************************************************************/
@@ -519,6 +618,11 @@ int main(int argc, char *argv[]){
 
   LALFree(ht.map);
 
+  for (m=0; m<NFSIZE; ++m){
+    LALFree(multiFreqInd[m].data);
+    LALFree(multiHt[m].map);
+  }
+
   LALFree(patch.xCoor);
   LALFree(patch.yCoor);
 
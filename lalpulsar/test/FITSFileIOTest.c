@@ -254,8 +254,13 @@ int main( int argc, char *argv[] )
         XLAL_CHECK_MAIN( XLAL_FITS_TABLE_COLUMN_ADD_PTR_STRUCT_NAMED( file, 1, UINT8, idx, "idx2" ) == XLAL_SUCCESS, XLAL_EFUNC );
       }
     }
-    for ( size_t i = 0; i < XLAL_NUM_ELEM( testtable ); ++i ) {
-      XLAL_CHECK_MAIN( XLALFITSTableWriteRow( file, &testtable[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALFITSTableWriteRow( file, &testtable[0] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    {
+      const void *records[XLAL_NUM_ELEM( testtable ) - 1];
+      for ( size_t i = 1; i < XLAL_NUM_ELEM( testtable ); ++i ) {
+        records[i - 1] = &testtable[i];
+      }
+      XLAL_CHECK_MAIN( XLALFITSTableWriteRows( file, records, XLAL_NUM_ELEM( records ) ) == XLAL_SUCCESS, XLAL_EFUNC );
     }
     fprintf( stderr, "PASSED: wrote a table\n" );
 
@@ -327,15 +332,26 @@ int main( int argc, char *argv[] )
           }
         }
       }
-      TestRecord XLAL_INIT_DECL( record );
-      REAL4 XLAL_INIT_DECL( record_array, [XLAL_NUM_ELEM( testarray[0] )] );
-      record.array = record_array;
-      TestSubRecord XLAL_INIT_DECL( record_sub, [2] );
-      record.sub = record_sub;
+      TestRecord XLAL_INIT_DECL( records, [XLAL_NUM_ELEM( testtable )] );
+      REAL4 XLAL_INIT_DECL( records_array, [XLAL_NUM_ELEM( testtable )][XLAL_NUM_ELEM( testarray[0] )] );
+      TestSubRecord XLAL_INIT_DECL( records_sub, [XLAL_NUM_ELEM( testtable )][2] );
+      void *precords[XLAL_NUM_ELEM( testtable )];
+      for ( size_t i = 0; i < XLAL_NUM_ELEM( testtable ); ++i ) {
+        records[i].array = records_array[i];
+        records[i].sub = records_sub[i];
+        precords[i] = &records[i];
+      }
+      XLAL_CHECK_MAIN( XLALFITSTableReadRow( file, precords[0], &nrows ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( nrows == XLAL_NUM_ELEM( testtable ) - 1, XLAL_EFAILED );
+      {
+        size_t nread = 0;
+        XLAL_CHECK_MAIN( XLALFITSTableReadRows( file, &precords[1], XLAL_NUM_ELEM( testtable ), &nread, &nrows ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLAL_CHECK_MAIN( nread == XLAL_NUM_ELEM( testtable ) - 1, XLAL_EFAILED );
+        XLAL_CHECK_MAIN( nrows == 0, XLAL_EFAILED );
+      }
       size_t i = 0;
-      while ( nrows > 0 ) {
-        XLAL_CHECK_MAIN( XLALFITSTableReadRow( file, &record, &nrows ) == XLAL_SUCCESS, XLAL_EFUNC );
-        XLAL_CHECK_MAIN( nrows == XLAL_NUM_ELEM( testtable ) - i - 1, XLAL_EFAILED );
+      while ( i < XLAL_NUM_ELEM( testtable ) ) {
+        const TestRecord record = records[i];
         XLAL_CHECK_MAIN( record.index == testtable[i].index, XLAL_EFAILED );
         XLAL_CHECK_MAIN( record.flag == testtable[i].flag, XLAL_EFAILED );
         XLAL_CHECK_MAIN( strcmp( record.name, testtable[i].name ) == 0, XLAL_EFAILED );
@@ -362,9 +378,9 @@ int main( int argc, char *argv[] )
         ++i;
       }
       XLAL_CHECK_MAIN( i == XLAL_NUM_ELEM( testtable ), XLAL_EFAILED );
-      XLAL_CHECK_MAIN( XLALFITSTableReadRow( file, &record, &nrows ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( XLALFITSTableReadRow( file, precords[0], &nrows ) == XLAL_SUCCESS, XLAL_EFUNC );
       XLAL_CHECK_MAIN( nrows == 0, XLAL_EFAILED );
-      XLAL_CHECK_MAIN( XLALFITSTableReadRow( file, &record, NULL ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( XLALFITSTableReadRow( file, precords[0], NULL ) == XLAL_SUCCESS, XLAL_EFUNC );
     }
     fprintf( stderr, "PASSED: read and verified a table\n" );
 
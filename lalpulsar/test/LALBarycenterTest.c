@@ -49,6 +49,7 @@
 #include <lal/LALInitBarycenter.h>
 #include <lal/DetectorSite.h>
 #include <lal/Date.h>
+#include <lal/AVFactories.h>
 #include <lal/LogPrintf.h>
 
 /** \cond DONT_DOXYGEN */
@@ -96,6 +97,19 @@ main( void )
    */
   XLAL_CHECK_MAIN( ( edat = XLALInitBarycenter( eEphFile, sEphFile ) ) != NULL, XLAL_EFUNC );
 
+  /* binary ephemeris files, given directly or found as sidecars of text files, give identical data */
+  {
+    XLAL_CHECK_MAIN( XLALWriteBinaryEphemerisFile( "LALBarycenterTest_earth.dat.bin", eEphFile ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALWriteBinaryEphemerisFile( "LALBarycenterTest_sun.dat.bin", sEphFile ) == XLAL_SUCCESS, XLAL_EFUNC );
+    EphemerisData *edatBin;
+    XLAL_CHECK_MAIN( ( edatBin = XLALInitBarycenter( "LALBarycenterTest_earth.dat.bin", "LALBarycenterTest_sun.dat.bin" ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( compare_ephemeris( edat, edatBin ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyEphemerisData( edatBin );
+    XLAL_CHECK_MAIN( ( edatBin = XLALInitBarycenter( "LALBarycenterTest_earth.dat.gz", "LALBarycenterTest_sun.dat" ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( compare_ephemeris( edat, edatBin ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyEphemerisData( edatBin );
+  }
+
   /* ========================================================================== */
 
 
@@ -205,6 +219,53 @@ main( void )
            maxDiffOpt.vDetector[0], maxDiffOpt.vDetector[1], maxDiffOpt.vDetector[2]
            );
 
+  /* ----- check precomputed barycentering cache against XLALBarycenterOpt() ---------- */
+  {
+    const UINT4 numCache = 100;
+    BarycenterCache *cache = XLALCreateBarycenterCache ( numCache );
+    XLAL_CHECK ( cache != NULL, XLAL_EFUNC );
+    EarthState *earths = XLALCalloc ( numCache, sizeof(earths[0]) );
+    LIGOTimeGPS *tGPSs = XLALCalloc ( numCache, sizeof(tGPSs[0]) );
+    XLAL_CHECK ( earths != NULL && tGPSs != NULL, XLAL_ENOMEM );
+    for ( UINT4 i = 0; i < numCache; i++ )
+      {
+        XLALGPSSetREAL8( &tGPSs[i], t1998 + ( 1.0 * rand() / RAND_MAX ) * LAL_YRSID_SI );
+        XLAL_CHECK ( XLALBarycenterEarth ( &earths[i], &tGPSs[i], edat ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLAL_CHECK ( XLALSetBarycenterCache ( cache, i, &tGPSs[i], &baryinput.site, &earths[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+      }
+    REAL8Vector *DeltaT = XLALCreateREAL8Vector ( numCache );
+    REAL8Vector *Tdot = XLALCreateREAL8Vector ( numCache );
+    XLAL_CHECK ( DeltaT != NULL && Tdot != NULL, XLAL_EFUNC );
+    const LIGOTimeGPS refTime = { 700000000, 0 };
+    REAL8 maxDiffCache = 0;
+    for ( UINT4 k = 0; k < 30; k++ )
+      {
+        baryinput.alpha = ( 1.0 * rand() / RAND_MAX ) * LAL_TWOPI;
+        baryinput.delta = ( 1.0 * rand() / RAND_MAX ) * LAL_PI - LAL_PI_2;
+        baryinput.dInv = 0.e0;
+        XLAL_CHECK ( XLALEvaluateBarycenterCache ( DeltaT, Tdot, cache, baryinput.alpha, baryinput.delta, &refTime ) == XLAL_SUCCESS, XLAL_EFUNC );
+        for ( UINT4 i = 0; i < numCache; i++ )
+          {
+            baryinput.tgps = tGPSs[i];
+            XLAL_CHECK ( XLALBarycenterOpt ( &emit_opt, &baryinput, &earths[i], &buffer ) == XLAL_SUCCESS, XLAL_EFUNC );
+            const REAL8 dDeltaT = fabs ( XLALGPSDiff ( &emit_opt.te, &refTime ) - DeltaT->data[i] );
+            const REAL8 dTdot = fabs ( emit_opt.tDot - Tdot->data[i] );
+            maxDiffCache = fmax ( maxDiffCache, fmax ( dDeltaT, dTdot ) );
+          }
+      }
+    XLALPrintInfo ( "Max error between XLALBarycenterOpt() and XLALEvaluateBarycenterCache() = %g (tolerance = %g s)\n", maxDiffCache, tolerance );
+    XLAL_CHECK ( maxDiffCache < tolerance, XLAL_EFAILED,
+                 "Max error between XLALBarycenterOpt() and XLALEvaluateBarycenterCache() = %g, exceeding tolerance of %g s\n",
+                 maxDiffCache, tolerance );
+    XLALFree ( buffer );
+    buffer = NULL;
+    XLALDestroyREAL8Vector ( DeltaT );
+    XLALDestroyREAL8Vector ( Tdot );
+    XLALFree ( earths );
+    XLALFree ( tGPSs );
+    XLALDestroyBarycenterCache ( cache );
+  }
+
   /* ----- output runtimes ---------- */
   XLALPrintError ("Runtimes per function-call, averaged over %g calls\n", 1.0 * NRepeat * counter );
   XLALPrintError ("XLALBarycenter() 	%g s\n", tau / counter );
@@ -69,6 +69,7 @@ int main(void);
 
 
 int test_XLALSFTVectorToLFT(void);
+int test_XLALSFTtoTSEngine(void);
 int test_XLALSincInterpolateCOMPLEX8TimeSeries(void);
 int test_XLALSincInterpolateSFT ( void );
 
@@ -88,6 +89,8 @@ int main(void)
 
   XLAL_CHECK ( test_XLALSFTVectorToLFT() == XLAL_SUCCESS, XLAL_EFUNC );
 
+  XLAL_CHECK ( test_XLALSFTtoTSEngine() == XLAL_SUCCESS, XLAL_EFUNC );
+
   XLAL_CHECK ( test_XLALSincInterpolateCOMPLEX8TimeSeries() == XLAL_SUCCESS, XLAL_EFUNC );
 
   XLAL_CHECK ( test_XLALSincInterpolateSFT() == XLAL_SUCCESS, XLAL_EFUNC );
@@ -196,6 +199,78 @@ test_XLALSFTVectorToLFT ( void )
 } // test_XLALSFTVectorToLFT()
 
 
+/**
+ * Unit-Test for the SFTtoTSEngine functions.
+ * Moves an analysis window over a list of SFTs, drops an SFT from the window, and changes the data of an SFT,
+ * and checks that each incremental update of the engine agrees exactly with XLALSFTVectorToCOMPLEX8TimeSeries()
+ * computed from scratch.
+ */
+int
+test_XLALSFTtoTSEngine ( void )
+{
+  REAL4TimeSeries *tsR4 = NULL;
+  SFTVector *sfts0 = NULL;
+  XLAL_CHECK ( XLALgenerateRandomData ( &tsR4, &sfts0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLALDestroyREAL4TimeSeries ( tsR4 );
+  SFTVector *sfts;
+  XLAL_CHECK ( (sfts = XLALExtractBandFromSFTVector ( sfts0, 3, 1 )) != NULL, XLAL_EFUNC );
+  XLALDestroySFTVector ( sfts0 );
+  const UINT4 numSFTs = sfts->length;
+
+  // windows of SFTs sharing data with 'sfts'; the third window has a gap
+  const UINT4 winLen = 12;
+  SFTVector win[3];
+  for ( UINT4 w = 0; w < 3; w ++ ) {
+    win[w].length = winLen;
+    XLAL_CHECK ( (win[w].data = XLALCalloc ( winLen, sizeof(win[w].data[0]) )) != NULL, XLAL_ENOMEM );
+  }
+  for ( UINT4 n = 0; n < winLen; n ++ ) {
+    win[0].data[n] = sfts->data[n];
+    win[1].data[n] = sfts->data[numSFTs - winLen + n];
+    win[2].data[n] = sfts->data[numSFTs - winLen - 1 + n + ( n >= winLen / 2 ? 1 : 0 )];
+  }
+
+  SFTtoTSEngine *engine;
+  XLAL_CHECK ( (engine = XLALCreateSFTtoTSEngine ( 5 )) != NULL, XLAL_EFUNC );
+  VectorComparison XLAL_INIT_DECL(tol0);
+  VectorComparison XLAL_INIT_DECL(cmp);
+  for ( UINT4 step = 0; step < 4; step ++ )
+    {
+      const SFTVector *thisWin = &win[MYMIN(step, 2)];
+      UINT4Vector *changed = NULL;
+      if ( step == 3 ) {
+        // change the data of one SFT within the window
+        XLAL_CHECK ( (changed = XLALCreateUINT4Vector ( 1 )) != NULL, XLAL_EFUNC );
+        changed->data[0] = 2;
+        COMPLEX8Vector *data = thisWin->data[changed->data[0]].data;
+        for ( UINT4 k = 0; k < data->length; k ++ ) {
+          data->data[k] *= 2;
+        }
+      }
+      const COMPLEX8TimeSeries *tsEngine;
+      XLAL_CHECK ( (tsEngine = XLALSFTtoTSEngineUpdate ( engine, thisWin, changed )) != NULL, XLAL_EFUNC );
+      COMPLEX8TimeSeries *tsDirect;
+      XLAL_CHECK ( (tsDirect = XLALSFTVectorToCOMPLEX8TimeSeries ( thisWin )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( XLALGPSCmp ( &tsEngine->epoch, &tsDirect->epoch ) == 0, XLAL_EFAILED, "step %u: time-series epochs differ", step );
+      XLAL_CHECK ( tsEngine->data->length == tsDirect->data->length, XLAL_EFAILED, "step %u: time-series lengths differ", step );
+      XLALPrintInfo ("Comparing time-series from SFTtoTSEngine update %u to XLALSFTVectorToCOMPLEX8TimeSeries():\n", step );
+      XLAL_CHECK ( XLALCompareCOMPLEX8Vectors ( &cmp, tsEngine->data, tsDirect->data, &tol0 ) == XLAL_SUCCESS, XLAL_EFUNC, "step %u: time-series differ", step );
+      XLALDestroyCOMPLEX8TimeSeries ( tsDirect );
+      XLALDestroyUINT4Vector ( changed );
+    } /* for step < 4 */
+
+  // ---------- free memory ----------
+  XLALDestroySFTtoTSEngine ( engine );
+  for ( UINT4 w = 0; w < 3; w ++ ) {
+    XLALFree ( win[w].data );
+  }
+  XLALDestroySFTVector ( sfts );
+
+  return XLAL_SUCCESS;
+
+} // test_XLALSFTtoTSEngine()
+
+
 int
 test_XLALSincInterpolateCOMPLEX8TimeSeries ( void )
 {
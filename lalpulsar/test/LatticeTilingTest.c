@@ -21,6 +21,7 @@
 
 #include <config.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <lal/LatticeTiling.h>
 #include <lal/LALStdlib.h>
@@ -158,10 +159,51 @@ static int SerialisationTest(
   }
   XLAL_CHECK( XLALNextLatticeTilingPoint( itr, NULL ) == 0, XLAL_EFUNC );
 
+  // Create lattice tiling locator, save it to a FITS file, and restore it
+  LatticeTilingLocator *loc = XLALCreateLatticeTilingLocator( tiling );
+  XLAL_CHECK( loc != NULL, XLAL_EFUNC );
+  {
+    FITSFile *file = XLALFITSFileOpenWrite( "LatticeTilingTest.fits" );
+    XLAL_CHECK( file != NULL, XLAL_EFUNC );
+    XLAL_CHECK( XLALSaveLatticeTilingLocator( loc, file, "loc" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALFITSFileClose( file );
+  }
+  LatticeTilingLocator *loc_ckpt = NULL;
+  {
+    FITSFile *file = XLALFITSFileOpenRead( "LatticeTilingTest.fits" );
+    XLAL_CHECK( file != NULL, XLAL_EFUNC );
+    loc_ckpt = XLALRestoreLatticeTilingLocator( tiling, file, "loc" );
+    XLAL_CHECK( loc_ckpt != NULL, XLAL_EFUNC );
+    XLALFITSFileClose( file );
+  }
+
+  // Check that restored locator finds the same nearest points
+  {
+    gsl_matrix *nearest = NULL, *nearest_ckpt = NULL;
+    UINT8VectorSequence *nearest_idxs = NULL, *nearest_idxs_ckpt = NULL;
+    XLAL_CHECK( XLALNearestLatticeTilingPoints( loc, points, &nearest, &nearest_idxs ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALNearestLatticeTilingPoints( loc_ckpt, points, &nearest_ckpt, &nearest_idxs_ckpt ) == XLAL_SUCCESS, XLAL_EFUNC );
+    for ( UINT8 k = 0; k < total; ++k ) {
+      for ( size_t i = 0; i < n; ++i ) {
+        XLAL_CHECK( nearest_idxs->data[k*n + i] == nearest_idxs_ckpt->data[k*n + i], XLAL_EFAILED );
+      }
+    }
+    gsl_matrix_sub( nearest, nearest_ckpt );
+    double err_min = 0, err_max = 0;
+    gsl_matrix_minmax( nearest, &err_min, &err_max );
+    XLAL_CHECK( fabs( err_min ) < 1e-6 && fabs( err_max ) < 1e-6, XLAL_EFAILED, "err = [%e, %e] not within 1e-6", err_min, err_max );
+    GFMAT( nearest, nearest_ckpt );
+    XLALDestroyUINT8VectorSequence( nearest_idxs );
+    XLALDestroyUINT8VectorSequence( nearest_idxs_ckpt );
+  }
+  printf( " locator ..." );
+
   printf( " done\n" );
 
   // Cleanup
   XLALDestroyLatticeTilingIterator( itr );
+  XLALDestroyLatticeTilingLocator( loc );
+  XLALDestroyLatticeTilingLocator( loc_ckpt );
   GFVEC( point );
   GFMAT( points );
 
@@ -349,6 +391,42 @@ static int BasicTest(
     // Cleanup
     XLALDestroyLatticeTilingIterator( itr_alt );
 
+    // Check that partitioned lattice tiling iterators over 'i+1' dimensions together visit the same points
+    printf( "  Testing XLALSetLatticeTilingIteratorPartition() ..." );
+    for ( int alternating = 0; alternating <= 1; ++alternating ) {
+      LatticeTilingIterator *itr_ref = XLALCreateLatticeTilingIterator( tiling, i+1 );
+      XLAL_CHECK( itr_ref != NULL, XLAL_EFUNC );
+      XLAL_CHECK( XLALSetLatticeTilingAlternatingIterator( itr_ref, alternating ) == XLAL_SUCCESS, XLAL_EFUNC );
+      const UINT8 total_part_ref = XLALTotalLatticeTilingPoints( itr_ref );
+      XLAL_CHECK( total_part_ref > 0, XLAL_EFUNC );
+      gsl_matrix *GAMAT( points_ref, n, total_part_ref );
+      XLAL_CHECK( XLALNextLatticeTilingPoints( itr_ref, &points_ref ) == ( int ) total_part_ref, XLAL_EFUNC );
+      const UINT4 num_parts = 3;
+      gsl_vector *GAVEC( point_part, n );
+      UINT8 k = 0;
+      for ( UINT4 part = 0; part < num_parts; ++part ) {
+        LatticeTilingIterator *itr_part = XLALCreateLatticeTilingIterator( tiling, i+1 );
+        XLAL_CHECK( itr_part != NULL, XLAL_EFUNC );
+        XLAL_CHECK( XLALSetLatticeTilingAlternatingIterator( itr_part, alternating ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLAL_CHECK( XLALSetLatticeTilingIteratorPartition( itr_part, num_parts, part ) == XLAL_SUCCESS, XLAL_EFUNC );
+        while ( XLALNextLatticeTilingPoint( itr_part, point_part ) > 0 ) {
+          XLAL_CHECK( k < total_part_ref, XLAL_EFAILED, "partitioned iterators return more than %" LAL_UINT8_FORMAT " points", total_part_ref );
+          XLAL_CHECK( XLALCurrentLatticeTilingIndex( itr_part ) == k, XLAL_EFAILED );
+          gsl_vector_const_view points_ref_k = gsl_matrix_const_column( points_ref, k );
+          gsl_vector_sub( point_part, &points_ref_k.vector );
+          const double err = gsl_blas_dasum( point_part ) / n;
+          XLAL_CHECK( err < 1e-6, XLAL_EFAILED, "err = %e < 1e-6", err );
+          ++k;
+        }
+        XLALDestroyLatticeTilingIterator( itr_part );
+      }
+      XLAL_CHECK( k == total_part_ref, XLAL_EFAILED, "partitioned iterators return %" LAL_UINT8_FORMAT " != %" LAL_UINT8_FORMAT " points", k, total_part_ref );
+      XLALDestroyLatticeTilingIterator( itr_ref );
+      GFMAT( points_ref );
+      GFVEC( point_part );
+    }
+    printf( " done\n" );
+
   }
 
   // Perform serialisation test
@@ -843,6 +921,128 @@ static int StrictBoundaryTest(
 
 }
 
+typedef struct {
+  char sign;
+  double c;
+  double m;
+} LocatorBoundData;
+
+static double LocatorLinearBound(
+  const void *data,
+  const size_t dim,
+  const gsl_matrix *cache UNUSED,
+  const gsl_vector *point
+  )
+{
+  const LocatorBoundData *d = ( const LocatorBoundData * ) data;
+  const double x = gsl_vector_get( point, dim - 1 );
+  return d->sign * d->m * x + d->c;
+}
+
+static double LocatorQuadraticBound(
+  const void *data,
+  const size_t dim,
+  const gsl_matrix *cache UNUSED,
+  const gsl_vector *point
+  )
+{
+  const LocatorBoundData *d = ( const LocatorBoundData * ) data;
+  const double x = gsl_vector_get( point, dim - 1 );
+  return d->sign * d->m * x * x + d->c;
+}
+
+static LatticeTiling *LocatorTestTiling(
+  const LatticeTilingBound func,
+  const int padding
+  )
+{
+
+  // Create lattice tiling
+  LatticeTiling *tiling = XLALCreateLatticeTiling( 2 );
+  XLAL_CHECK_NULL( tiling != NULL, XLAL_EFUNC );
+
+  // Add bounds; fill the bounds data with 'padding' first, so that any struct padding differs
+  XLAL_CHECK_NULL( XLALSetLatticeTilingConstantBound( tiling, 0, 1.0, 2.0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  {
+    LocatorBoundData data_lower, data_upper;
+    memset( &data_lower, padding, sizeof( data_lower ) );
+    memset( &data_upper, padding, sizeof( data_upper ) );
+    data_lower.sign = data_upper.sign = 1;
+    data_lower.m = data_upper.m = 0.5;
+    data_lower.c = -1.0;
+    data_upper.c = 1.0;
+    XLAL_CHECK_NULL( XLALSetLatticeTilingBound( tiling, 1, func, sizeof( data_lower ), &data_lower, &data_upper ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Set metric to the identity matrix
+  gsl_matrix *GAMAT_NULL( metric, 2, 2 );
+  gsl_matrix_set_identity( metric );
+  XLAL_CHECK_NULL( XLALSetTilingLatticeAndMetric( tiling, TILING_LATTICE_ANSTAR, metric, 0.1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  GFMAT( metric );
+
+  return tiling;
+
+}
+
+static int LocatorChecksumTest( void )
+{
+
+#if !defined(HAVE_LIBCFITSIO)
+  printf( "Skipping locator checksum test (CFITSIO library is not available)\n" );
+#else // defined(HAVE_LIBCFITSIO)
+  printf( "Performing locator checksum test ..." );
+
+  // Save a locator of a lattice tiling to a FITS file
+  {
+    LatticeTiling *tiling = LocatorTestTiling( LocatorLinearBound, 0x00 );
+    XLAL_CHECK( tiling != NULL, XLAL_EFUNC );
+    LatticeTilingLocator *loc = XLALCreateLatticeTilingLocator( tiling );
+    XLAL_CHECK( loc != NULL, XLAL_EFUNC );
+    FITSFile *file = XLALFITSFileOpenWrite( "LatticeTilingTest.fits" );
+    XLAL_CHECK( file != NULL, XLAL_EFUNC );
+    XLAL_CHECK( XLALSaveLatticeTilingLocator( loc, file, "loc" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALFITSFileClose( file );
+    XLALDestroyLatticeTilingLocator( loc );
+    XLALDestroyLatticeTiling( tiling );
+  }
+
+  // Check that the locator can be restored for an identical tiling whose bounds data differs only in its padding
+  {
+    LatticeTiling *tiling = LocatorTestTiling( LocatorLinearBound, 0xff );
+    XLAL_CHECK( tiling != NULL, XLAL_EFUNC );
+    FITSFile *file = XLALFITSFileOpenRead( "LatticeTilingTest.fits" );
+    XLAL_CHECK( file != NULL, XLAL_EFUNC );
+    LatticeTilingLocator *loc = XLALRestoreLatticeTilingLocator( tiling, file, "loc" );
+    XLAL_CHECK( loc != NULL, XLAL_EFUNC );
+    XLALFITSFileClose( file );
+    XLALDestroyLatticeTilingLocator( loc );
+    XLALDestroyLatticeTiling( tiling );
+  }
+  printf( " padding ..." );
+
+  // Check that the locator cannot be restored for a tiling with identical bounds data but a different bound function
+  {
+    LatticeTiling *tiling = LocatorTestTiling( LocatorQuadraticBound, 0x00 );
+    XLAL_CHECK( tiling != NULL, XLAL_EFUNC );
+    FITSFile *file = XLALFITSFileOpenRead( "LatticeTilingTest.fits" );
+    XLAL_CHECK( file != NULL, XLAL_EFUNC );
+    LatticeTilingLocator *loc = NULL;
+    int errnum = 0;
+    XLAL_TRY_SILENT( loc = XLALRestoreLatticeTilingLocator( tiling, file, "loc" ), errnum );
+    XLAL_CHECK( loc == NULL && errnum == XLAL_EIO, XLAL_EFAILED, "Restored locator for a tiling with a different bound function" );
+    XLALFITSFileClose( file );
+    XLALDestroyLatticeTiling( tiling );
+  }
+  printf( " bound function ..." );
+
+  printf( " done\n" );
+
+#endif // !defined(HAVE_LIBCFITSIO)
+
+  return XLAL_SUCCESS;
+
+}
+
 int main( void )
 {
 
@@ -901,6 +1101,9 @@ int main( void )
   }
   printf("\n");
 
+  // Perform test of the lattice tiling locator checksum
+  XLAL_CHECK_MAIN( LocatorChecksumTest() == XLAL_SUCCESS, XLAL_EFUNC );
+
   return EXIT_SUCCESS;
 
 }
@@ -535,6 +535,33 @@ XLALCheckBSGLVectorFunctions ( void )
   XLAL_CHECK ( errBSGLtL <= tolerance, XLAL_ETOL, "Error in vector BSGLtL exceeds tolerance, %g > %g\n", errBSGLtL, tolerance );
   XLAL_CHECK ( errBtSGLtL <= tolerance, XLAL_ETOL, "Error in vector BtSGLtL exceeds tolerance, %g > %g\n", errBtSGLtL, tolerance );
 
+  // check a vector spanning several internal processing blocks against the short-vector results
+#define LONG_VEC_LEN 1000
+  REAL4 *twoFLong = XLALCalloc ( LONG_VEC_LEN, sizeof ( *twoFLong ) );
+  REAL4 *twoFPerDetLong0 = XLALCalloc ( numDet * LONG_VEC_LEN, sizeof ( *twoFPerDetLong0 ) );
+  REAL4 *outBSGLLong = XLALCalloc ( LONG_VEC_LEN, sizeof ( *outBSGLLong ) );
+  XLAL_CHECK ( (twoFLong != NULL) && (twoFPerDetLong0 != NULL) && (outBSGLLong != NULL), XLAL_ENOMEM );
+  const REAL4 *twoFPerDetLong[PULSAR_MAX_DETECTORS];
+  for ( UINT4 X = 0; X < numDet; X ++ ) {
+    twoFPerDetLong[X] = twoFPerDetLong0 + X * LONG_VEC_LEN;
+  }
+  for ( UINT4 i = 0; i < LONG_VEC_LEN; i ++ ) {
+    twoFLong[i] = twoF[i % VEC_LEN];
+    for ( UINT4 X = 0; X < numDet; X ++ ) {
+      twoFPerDetLong0[X * LONG_VEC_LEN + i] = twoFPerDet[X][i % VEC_LEN];
+    }
+  }
+  XLAL_CHECK ( XLALVectorComputeBSGL ( outBSGLLong, twoFLong, twoFPerDetLong, LONG_VEC_LEN, setup_withLogCorr ) == XLAL_SUCCESS, XLAL_EFUNC );
+  REAL4 errBSGL_long = 0;
+  for ( UINT4 i = 0; i < LONG_VEC_LEN; i ++ ) {
+    errBSGL_long = fmaxf ( errBSGL_long, fabsf ( outBSGLLong[i] - outBSGL_log[i % VEC_LEN] ) / fmaxf ( 1, fabsf ( outBSGL_log[i % VEC_LEN] ) ) );
+  }
+  printf ("long vector: err = %g\n", errBSGL_long );
+  XLAL_CHECK ( errBSGL_long <= tolerance, XLAL_ETOL, "Error in long-vector BSGL with log-correction exceeds tolerance, %g > %g\n", errBSGL_long, tolerance );
+  XLALFree ( twoFLong );
+  XLALFree ( twoFPerDetLong0 );
+  XLALFree ( outBSGLLong );
+
   printf ("%s: success!\n", __func__ );
 
   XLALDestroyBSGLSetup ( setup_noLogCorr );
@@ -0,0 +1,149 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+#include <config.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <lal/PulsarCrossCorr_v2.h>
+
+// Test XLALCalculatePulsarCrossCorrStatisticBatch() against XLALCalculatePulsarCrossCorrStatistic()
+
+#define NUM_DET 2
+#define NUM_SFT_PER_DET 6
+#define NUM_SFT_BINS 40
+#define NUM_BINS 4
+#define NUM_TEMPLATES 5
+
+static REAL8 RandUniform( void )
+{
+  return ( ( REAL8 ) rand() ) / RAND_MAX;
+}
+
+int main( void )
+{
+
+  srand( 1 );
+
+  // ----- create SFTs filled with random data
+  UINT4Vector *numSFTs;
+  XLAL_CHECK_MAIN( ( numSFTs = XLALCreateUINT4Vector( NUM_DET ) ) != NULL, XLAL_EFUNC );
+  for ( UINT4 X = 0; X < NUM_DET; ++X ) {
+    numSFTs->data[X] = NUM_SFT_PER_DET;
+  }
+  MultiSFTVector *inputSFTs;
+  XLAL_CHECK_MAIN( ( inputSFTs = XLALCreateMultiSFTVector( NUM_SFT_BINS, numSFTs ) ) != NULL, XLAL_EFUNC );
+  for ( UINT4 X = 0; X < NUM_DET; ++X ) {
+    for ( UINT4 n = 0; n < NUM_SFT_PER_DET; ++n ) {
+      COMPLEX8Vector *data = inputSFTs->data[X]->data[n].data;
+      for ( UINT4 k = 0; k < data->length; ++k ) {
+        data->data[k] = crectf( RandUniform() - 0.5, RandUniform() - 0.5 );
+      }
+    }
+  }
+
+  // ----- create flat list of SFTs
+  const UINT4 numSFTsTotal = NUM_DET * NUM_SFT_PER_DET;
+  SFTIndexList *sftIndices;
+  XLAL_CHECK_MAIN( ( sftIndices = XLALCalloc( 1, sizeof( *sftIndices ) ) ) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_MAIN( ( sftIndices->data = XLALCalloc( numSFTsTotal, sizeof( sftIndices->data[0] ) ) ) != NULL, XLAL_ENOMEM );
+  sftIndices->length = numSFTsTotal;
+  for ( UINT4 i = 0; i < numSFTsTotal; ++i ) {
+    sftIndices->data[i].detInd = i / NUM_SFT_PER_DET;
+    sftIndices->data[i].sftInd = i % NUM_SFT_PER_DET;
+  }
+
+  // ----- create list of SFT pairs, in reverse order so that XLALCreateSFTPairTable() must sort them;
+  // ----- the last SFT is left out of every pair
+  SFTPairIndexList *sftPairs;
+  XLAL_CHECK_MAIN( ( sftPairs = XLALCalloc( 1, sizeof( *sftPairs ) ) ) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_MAIN( ( sftPairs->data = XLALCalloc( numSFTsTotal * numSFTsTotal, sizeof( sftPairs->data[0] ) ) ) != NULL, XLAL_ENOMEM );
+  for ( UINT4 i = numSFTsTotal - 1; i-- > 0; ) {
+    for ( UINT4 j = numSFTsTotal - 1; j-- > i + 1; ) {
+      sftPairs->data[sftPairs->length].sftNum[0] = i;
+      sftPairs->data[sftPairs->length].sftNum[1] = j;
+      ++sftPairs->length;
+    }
+  }
+  REAL8Vector *curlyGAmp;
+  XLAL_CHECK_MAIN( ( curlyGAmp = XLALCreateREAL8Vector( sftPairs->length ) ) != NULL, XLAL_EFUNC );
+  for ( UINT4 alpha = 0; alpha < curlyGAmp->length; ++alpha ) {
+    curlyGAmp->data[alpha] = RandUniform() - 0.5;
+  }
+  SFTPairTable *pairTable = NULL;
+  XLAL_CHECK_MAIN( XLALCreateSFTPairTable( &pairTable, sftPairs, sftIndices, curlyGAmp ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( pairTable->length == sftPairs->length, XLAL_EFAILED );
+  for ( UINT4 alpha = 1; alpha < pairTable->length; ++alpha ) {
+    XLAL_CHECK_MAIN( pairTable->sftNum1[alpha - 1] < pairTable->sftNum1[alpha] || ( pairTable->sftNum1[alpha - 1] == pairTable->sftNum1[alpha] && pairTable->sftNum2[alpha - 1] < pairTable->sftNum2[alpha] ),
+                     XLAL_EFAILED, "SFT pair table is not sorted at alpha=%u", alpha );
+  }
+
+  MultiNoiseWeights XLAL_INIT_DECL( multiWeights );
+  multiWeights.Sinv_Tsft = 0.7;
+
+  // ----- create random per-template signal phases, lowest bins, and sinc factors
+  COMPLEX8Vector *expSignalPhases[NUM_TEMPLATES];
+  UINT4Vector *lowestBins[NUM_TEMPLATES];
+  REAL8VectorSequence *sincList[NUM_TEMPLATES];
+  for ( UINT4 t = 0; t < NUM_TEMPLATES; ++t ) {
+    XLAL_CHECK_MAIN( ( expSignalPhases[t] = XLALCreateCOMPLEX8Vector( numSFTsTotal ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( ( lowestBins[t] = XLALCreateUINT4Vector( numSFTsTotal ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( ( sincList[t] = XLALCreateREAL8VectorSequence( numSFTsTotal, NUM_BINS ) ) != NULL, XLAL_EFUNC );
+    for ( UINT4 i = 0; i < numSFTsTotal; ++i ) {
+      const REAL8 phase = LAL_TWOPI * RandUniform();
+      expSignalPhases[t]->data[i] = crectf( cos( phase ), sin( phase ) );
+      lowestBins[t]->data[i] = rand() % ( NUM_SFT_BINS - NUM_BINS + 1 );
+      for ( UINT4 j = 0; j < NUM_BINS; ++j ) {
+        sincList[t]->data[i * NUM_BINS + j] = 2.0 * RandUniform() - 1.0;
+      }
+    }
+  }
+
+  // ----- compute statistic for all templates in one batch
+  REAL8 batchCCStat[NUM_TEMPLATES], batchEvSquared[NUM_TEMPLATES];
+  XLAL_CHECK_MAIN( XLALCalculatePulsarCrossCorrStatisticBatch( batchCCStat, batchEvSquared, NUM_TEMPLATES, expSignalPhases, lowestBins, sincList, pairTable, sftIndices, inputSFTs, &multiWeights, NUM_BINS ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // ----- compare against statistic computed for each template and SFT pair in turn
+  for ( UINT4 t = 0; t < NUM_TEMPLATES; ++t ) {
+    REAL8 ccStat = 0, evSquared = 0;
+    XLAL_CHECK_MAIN( XLALCalculatePulsarCrossCorrStatistic( &ccStat, &evSquared, curlyGAmp, expSignalPhases[t], lowestBins[t], sincList[t], sftPairs, sftIndices, inputSFTs, &multiWeights, NUM_BINS ) == XLAL_SUCCESS, XLAL_EFUNC );
+    printf( "template %u: ccStat = %.9g (batch %.9g), evSquared = %.9g (batch %.9g)\n", t, ccStat, batchCCStat[t], evSquared, batchEvSquared[t] );
+    XLAL_CHECK_MAIN( evSquared > 0, XLAL_EFAILED );
+    XLAL_CHECK_MAIN( fabs( batchEvSquared[t] - evSquared ) <= 1e-10 * evSquared, XLAL_ETOL,
+                     "template %u: evSquared = %.15g differs from batch evSquared = %.15g", t, evSquared, batchEvSquared[t] );
+    XLAL_CHECK_MAIN( fabs( batchCCStat[t] - ccStat ) <= 1e-5 * ( 1.0 + fabs( ccStat ) ), XLAL_ETOL,
+                     "template %u: ccStat = %.15g differs from batch ccStat = %.15g", t, ccStat, batchCCStat[t] );
+  }
+
+  // ----- cleanup
+  for ( UINT4 t = 0; t < NUM_TEMPLATES; ++t ) {
+    XLALDestroyCOMPLEX8Vector( expSignalPhases[t] );
+    XLALDestroyUINT4Vector( lowestBins[t] );
+    XLALDestroyREAL8VectorSequence( sincList[t] );
+  }
+  XLALDestroySFTPairTable( pairTable );
+  XLALDestroyREAL8Vector( curlyGAmp );
+  XLALDestroySFTPairIndexList( sftPairs );
+  XLALDestroySFTIndexList( sftIndices );
+  XLALDestroyMultiSFTVector( inputSFTs );
+  XLALDestroyUINT4Vector( numSFTs );
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,86 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+#include <config.h>
+#include <math.h>
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <lal/LALConstants.h>
+#include <lal/SinCosLUT.h>
+
+// Test XLALSinCos2PiLUTVector() against XLALSinCos2PiLUT(), and both against sin() and cos()
+
+#define NUM_RAND 1003
+#define NUM_EDGE 16
+#define LEN ( NUM_EDGE + NUM_RAND )
+
+int main( void )
+{
+
+  // ----- arguments: edge cases at multiples of 1/4, the table resolution (1/1024), and large values, followed by
+  // ----- random values; the total length is not a multiple of 4, so any vectorised loop has a remainder
+  const REAL8 edge[NUM_EDGE] = {
+    0, 0.25, 0.5, 0.75, 1, -0.25, -0.5, -1, 2.5, -7.75,
+    1.0 / 1024, -1.0 / 1024, 0.5 - 1e-12, 0.5 + 1e-12, 1.234567e8, -9.87654e8
+  };
+  static REAL8 x[LEN];
+  for ( UINT4 i = 0; i < NUM_EDGE; ++i ) {
+    x[i] = edge[i];
+  }
+  srand( 1 );
+  for ( UINT4 i = NUM_EDGE; i < LEN; ++i ) {
+    x[i] = 2000.0 * ( ( ( REAL8 ) rand() ) / RAND_MAX - 0.5 );
+  }
+
+  // ----- evaluate all arguments in one call
+  static REAL4 sinv[LEN], cosv[LEN];
+  XLAL_CHECK_MAIN( XLALSinCos2PiLUTVector( sinv, cosv, x, LEN ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // ----- compare against the scalar function, which may differ only by float rounding (e.g. from FMA
+  // ----- contraction between the two code paths), and against the libm functions to the LUT precision
+  REAL8 maxErrScalar = 0, maxErrLibm = 0;
+  for ( UINT4 i = 0; i < LEN; ++i ) {
+    REAL4 sins, coss;
+    XLAL_CHECK_MAIN( XLALSinCos2PiLUT( &sins, &coss, x[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    const REAL8 errScalar = fmax( fabs( sinv[i] - sins ), fabs( cosv[i] - coss ) );
+    XLAL_CHECK_MAIN( errScalar <= 2 * FLT_EPSILON, XLAL_ETOL,
+                     "x[%u] = %.15g: vector (sin, cos) = (%.9g, %.9g) differs from scalar (%.9g, %.9g)", i, x[i], sinv[i], cosv[i], sins, coss );
+    const REAL8 errLibm = fmax( fabs( sinv[i] - sin( LAL_TWOPI * x[i] ) ), fabs( cosv[i] - cos( LAL_TWOPI * x[i] ) ) );
+    XLAL_CHECK_MAIN( errLibm <= 1e-5, XLAL_ETOL,
+                     "x[%u] = %.15g: vector (sin, cos) = (%.9g, %.9g) differs from libm", i, x[i], sinv[i], cosv[i] );
+    maxErrScalar = fmax( maxErrScalar, errScalar );
+    maxErrLibm = fmax( maxErrLibm, errLibm );
+  }
+  printf( "maximum error of XLALSinCos2PiLUTVector(): %.3e against XLALSinCos2PiLUT(), %.3e against libm\n", maxErrScalar, maxErrLibm );
+
+  // ----- evaluate a short, unaligned sub-array, which must give the same results as the full array
+  static REAL4 sinp[3], cosp[3];
+  XLAL_CHECK_MAIN( XLALSinCos2PiLUTVector( sinp, cosp, &x[5], 3 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  for ( UINT4 i = 0; i < 3; ++i ) {
+    XLAL_CHECK_MAIN( sinp[i] == sinv[5 + i] && cosp[i] == cosv[5 + i], XLAL_EFAILED, "x[%u] = %.15g: sub-array result differs", 5 + i, x[5 + i] );
+  }
+
+  // ----- a zero-length call is a no-op
+  XLAL_CHECK_MAIN( XLALSinCos2PiLUTVector( NULL, NULL, NULL, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
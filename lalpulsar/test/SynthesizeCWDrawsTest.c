@@ -0,0 +1,162 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+#include <config.h>
+#include <math.h>
+
+#include <lal/SynthesizeCWDraws.h>
+#include <lal/LALInitBarycenter.h>
+#include <lal/SFTutils.h>
+#include <lal/StringVector.h>
+
+// Test XLALSynthesizeCWDraws() against XLALSynthesizeTransientAtoms() and the expected F-statistic distributions
+
+#define NUM_SKY 5
+#define NUM_DRAWS 100000
+#define SQ(x) ((x)*(x))
+
+int main( void )
+{
+
+  // ----- set up detector states
+  EphemerisData *edat;
+  XLAL_CHECK_MAIN( ( edat = XLALInitBarycenter( TEST_PKG_DATA_DIR "earth00-19-DE405.dat.gz", TEST_PKG_DATA_DIR "sun00-19-DE405.dat.gz" ) ) != NULL, XLAL_EFUNC );
+  LALStringVector *detNames;
+  XLAL_CHECK_MAIN( ( detNames = XLALCreateStringVector( "H1", "L1", NULL ) ) != NULL, XLAL_EFUNC );
+  MultiLALDetector multiDet;
+  XLAL_CHECK_MAIN( XLALParseMultiLALDetector( &multiDet, detNames ) == XLAL_SUCCESS, XLAL_EFUNC );
+  const UINT4 numDet = multiDet.length;
+  const REAL8 Tsft = 1800;
+  LIGOTimeGPS startTime = { 714180733, 0 };
+  MultiLIGOTimeGPSVector *multiTS;
+  XLAL_CHECK_MAIN( ( multiTS = XLALMakeMultiTimestamps( startTime, 2 * LAL_DAYSID_SI, Tsft, 0, numDet ) ) != NULL, XLAL_EFUNC );
+  MultiDetectorStateSeries *multiDetStates;
+  XLAL_CHECK_MAIN( ( multiDetStates = XLALGetMultiDetectorStates( multiTS, &multiDet, edat, 0.5 * Tsft ) ) != NULL, XLAL_EFUNC );
+
+  // ----- tabulate antenna patterns over some sky positions
+  SkyPosition skypos[NUM_SKY];
+  for ( UINT4 k = 0; k < NUM_SKY; ++k ) {
+    skypos[k].longitude = LAL_TWOPI * k / NUM_SKY;
+    skypos[k].latitude = asin( -0.9 + 1.8 * k / ( NUM_SKY - 1 ) );
+    skypos[k].system = COORDINATESYSTEM_EQUATORIAL;
+  }
+  SynthCWDrawsTable_t *table;
+  XLAL_CHECK_MAIN( ( table = XLALCreateSynthCWDrawsTable( multiDetStates, NULL, skypos, NUM_SKY ) ) != NULL, XLAL_EFUNC );
+  SynthCWDrawsTable_t *table0;
+  XLAL_CHECK_MAIN( ( table0 = XLALCreateSynthCWDrawsTable( multiDetStates, NULL, skypos, 1 ) ) != NULL, XLAL_EFUNC );
+
+  gsl_rng *rng = gsl_rng_alloc( gsl_rng_mt19937 );
+  XLAL_CHECK_MAIN( rng != NULL, XLAL_ENOMEM );
+
+  REAL4 *twoF = XLALCalloc( NUM_DRAWS, sizeof( *twoF ) );
+  REAL4 *SNR = XLALCalloc( NUM_DRAWS, sizeof( *SNR ) );
+  XLAL_CHECK_MAIN( twoF != NULL && SNR != NULL, XLAL_ENOMEM );
+  REAL4 *twoFPerDet[PULSAR_MAX_DETECTORS];
+  for ( UINT4 X = 0; X < numDet; ++X ) {
+    XLAL_CHECK_MAIN( ( twoFPerDet[X] = XLALCalloc( NUM_DRAWS, sizeof( *twoFPerDet[X] ) ) ) != NULL, XLAL_ENOMEM );
+  }
+
+  // ----- in Gaussian noise, 2F and 2F^X are chi^2 distributed with 4 degrees of freedom: mean 4 and variance 8
+  AmplitudePrior_t XLAL_INIT_DECL( AmpPrior );
+  AmpPrior.fixedSNR = 0;
+  XLAL_CHECK_MAIN( XLALSynthesizeCWDraws( twoF, twoFPerDet, SNR, NUM_DRAWS, table, AmpPrior, 0, -1, rng ) == XLAL_SUCCESS, XLAL_EFUNC );
+  {
+    const REAL8 tolerance = 5 * sqrt( 8.0 / NUM_DRAWS );
+    REAL8 mean = 0;
+    for ( UINT4 i = 0; i < NUM_DRAWS; ++i ) {
+      mean += twoF[i];
+    }
+    mean /= NUM_DRAWS;
+    printf( "noise: mean 2F = %g\n", mean );
+    XLAL_CHECK_MAIN( fabs( mean - 4 ) < tolerance, XLAL_ETOL, "Mean 2F = %g in noise differs from 4 by more than %g", mean, tolerance );
+    for ( UINT4 X = 0; X < numDet; ++X ) {
+      REAL8 meanX = 0;
+      for ( UINT4 i = 0; i < NUM_DRAWS; ++i ) {
+        meanX += twoFPerDet[X][i];
+      }
+      meanX /= NUM_DRAWS;
+      printf( "noise: mean 2F^%u = %g\n", X, meanX );
+      XLAL_CHECK_MAIN( fabs( meanX - 4 ) < tolerance, XLAL_ETOL, "Mean 2F^%u = %g in noise differs from 4 by more than %g", X, meanX, tolerance );
+    }
+  }
+
+  // ----- without noise, 2F equals the optimal SNR^2
+  AmpPrior.fixedSNR = -1;
+  XLAL_CHECK_MAIN( ( AmpPrior.pdf_h0Nat = XLALCreateUniformPDF1D( 0, 0.1 ) ) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( ( AmpPrior.pdf_cosi = XLALCreateUniformPDF1D( -1, 1 ) ) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( ( AmpPrior.pdf_psi = XLALCreateUniformPDF1D( -LAL_PI_4, LAL_PI_4 ) ) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( ( AmpPrior.pdf_phi0 = XLALCreateUniformPDF1D( 0, LAL_TWOPI ) ) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALSynthesizeCWDraws( twoF, NULL, SNR, NUM_DRAWS, table, AmpPrior, 1, -1, rng ) == XLAL_SUCCESS, XLAL_EFUNC );
+  for ( UINT4 i = 0; i < NUM_DRAWS; ++i ) {
+    const REAL4 rho2 = SQ( SNR[i] );
+    XLAL_CHECK_MAIN( fabsf( twoF[i] - rho2 ) <= 1e-5 * fmaxf( 1, rho2 ), XLAL_ETOL, "Signal-only draw %u: 2F = %g differs from SNR^2 = %g", i, twoF[i], rho2 );
+  }
+  XLALDestroyPDF1D( AmpPrior.pdf_h0Nat );
+  XLALDestroyPDF1D( AmpPrior.pdf_cosi );
+  XLALDestroyPDF1D( AmpPrior.pdf_psi );
+  XLALDestroyPDF1D( AmpPrior.pdf_phi0 );
+
+  // ----- for fixed amplitude parameters and without noise, draws agree with F-stats computed from synthesized atoms
+  XLAL_CHECK_MAIN( ( AmpPrior.pdf_h0Nat = XLALCreateSingularPDF1D( 0.07 ) ) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( ( AmpPrior.pdf_cosi = XLALCreateSingularPDF1D( 0.3 ) ) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( ( AmpPrior.pdf_psi = XLALCreateSingularPDF1D( 0.2 ) ) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( ( AmpPrior.pdf_phi0 = XLALCreateSingularPDF1D( 1.1 ) ) != NULL, XLAL_EFUNC );
+  for ( INT4 lineX = -1; lineX < ( INT4 ) numDet; ++lineX ) {
+    XLAL_CHECK_MAIN( XLALSynthesizeCWDraws( twoF, twoFPerDet, SNR, 1, table0, AmpPrior, 1, lineX, rng ) == XLAL_SUCCESS, XLAL_EFUNC );
+    transientWindowRange_t XLAL_INIT_DECL( transientInjectRange );
+    transientInjectRange.type = TRANSIENT_NONE;
+    multiAMBuffer_t XLAL_INIT_DECL( multiAMBuffer );
+    InjParams_t XLAL_INIT_DECL( injParams );
+    MultiFstatAtomVector *multiAtoms;
+    XLAL_CHECK_MAIN( ( multiAtoms = XLALSynthesizeTransientAtoms( &injParams, skypos[0], AmpPrior, transientInjectRange, multiDetStates, 1, &multiAMBuffer, rng, lineX, NULL ) ) != NULL, XLAL_EFUNC );
+    const REAL4 twoF_atoms = XLALComputeFstatFromAtoms( multiAtoms, -1 );
+    XLAL_CHECK_MAIN( xlalErrno == 0, XLAL_EFUNC );
+    printf( "lineX = %i: 2F = %g from draws, %g from atoms; SNR = %g from draws, %g from atoms\n", lineX, twoF[0], twoF_atoms, SNR[0], injParams.SNR );
+    XLAL_CHECK_MAIN( fabsf( twoF[0] - twoF_atoms ) <= 1e-4 * twoF_atoms, XLAL_ETOL, "lineX = %i: 2F = %g from draws differs from 2F = %g from atoms", lineX, twoF[0], twoF_atoms );
+    XLAL_CHECK_MAIN( fabs( SNR[0] - injParams.SNR ) <= 1e-4 * injParams.SNR, XLAL_ETOL, "lineX = %i: SNR = %g from draws differs from SNR = %g from atoms", lineX, SNR[0], injParams.SNR );
+    for ( UINT4 X = 0; X < numDet; ++X ) {
+      const REAL4 twoFX_atoms = XLALComputeFstatFromAtoms( multiAtoms, X );
+      XLAL_CHECK_MAIN( xlalErrno == 0, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( fabsf( twoFPerDet[X][0] - twoFX_atoms ) <= 1e-4 * fmaxf( 1, twoFX_atoms ), XLAL_ETOL, "lineX = %i: 2F^%u = %g from draws differs from 2F^%u = %g from atoms", lineX, X, twoFPerDet[X][0], X, twoFX_atoms );
+    }
+    XLALDestroyMultiFstatAtomVector( multiAtoms );
+    XLALDestroyMultiAMCoeffs( multiAMBuffer.multiAM );
+  }
+  XLALDestroyPDF1D( AmpPrior.pdf_h0Nat );
+  XLALDestroyPDF1D( AmpPrior.pdf_cosi );
+  XLALDestroyPDF1D( AmpPrior.pdf_psi );
+  XLALDestroyPDF1D( AmpPrior.pdf_phi0 );
+
+  // ----- cleanup
+  for ( UINT4 X = 0; X < numDet; ++X ) {
+    XLALFree( twoFPerDet[X] );
+  }
+  XLALFree( twoF );
+  XLALFree( SNR );
+  gsl_rng_free( rng );
+  XLALDestroySynthCWDrawsTable( table );
+  XLALDestroySynthCWDrawsTable( table0 );
+  XLALDestroyMultiDetectorStateSeries( multiDetStates );
+  XLALDestroyMultiTimestamps( multiTS );
+  XLALDestroyStringVector( detNames );
+  XLALDestroyEphemerisData( edat );
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
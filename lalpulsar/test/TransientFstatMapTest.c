@@ -0,0 +1,139 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+#include <config.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <lal/TransientCW_utils.h>
+
+// Test XLALComputeTransientFstatMapThreaded() and, if available, XLALComputeTransientFstatMapCUDA()
+// against the serial XLALComputeTransientFstatMap()
+
+#define NUM_DET 2
+#define NUM_ATOMS 60
+#define TATOM 1800
+#define T0_DATA 1000000000
+#define CUDA_TOLERANCE 1e-4
+
+static REAL4 RandUniform( REAL4 a, REAL4 b )
+{
+  return a + ( b - a ) * ( ( REAL4 ) rand() ) / RAND_MAX;
+}
+
+static int CompareMaps( const transientFstatMap_t *map, const transientFstatMap_t *refMap, const REAL8 tolerance, const char *name )
+{
+  XLAL_CHECK( map->F_mn->size1 == refMap->F_mn->size1 && map->F_mn->size2 == refMap->F_mn->size2, XLAL_EFAILED, "%s: map size differs from serial map", name );
+  REAL8 maxErr = 0;
+  for ( size_t m = 0; m < refMap->F_mn->size1; ++m ) {
+    for ( size_t n = 0; n < refMap->F_mn->size2; ++n ) {
+      const REAL8 F = gsl_matrix_get( map->F_mn, m, n );
+      const REAL8 refF = gsl_matrix_get( refMap->F_mn, m, n );
+      const REAL8 err = fabs( F - refF ) / ( 1.0 + fabs( refF ) );
+      XLAL_CHECK( err <= tolerance, XLAL_ETOL, "%s: F[%zu,%zu] = %.9g differs from serial F = %.9g", name, m, n, F, refF );
+      maxErr = fmax( maxErr, err );
+    }
+  }
+  XLAL_CHECK( fabs( map->maxF - refMap->maxF ) <= tolerance * ( 1.0 + fabs( refMap->maxF ) ), XLAL_ETOL, "%s: maxF = %.9g differs from serial maxF = %.9g", name, map->maxF, refMap->maxF );
+  if ( tolerance == 0 ) {
+    XLAL_CHECK( map->t0_ML == refMap->t0_ML && map->tau_ML == refMap->tau_ML, XLAL_EFAILED,
+                "%s: ML estimates {t0, tau} = {%u, %u} differ from serial {%u, %u}", name, map->t0_ML, map->tau_ML, refMap->t0_ML, refMap->tau_ML );
+  }
+  printf( "%s: maximum relative error against serial map = %.3e\n", name, maxErr );
+  return XLAL_SUCCESS;
+}
+
+int main( void )
+{
+
+  srand( 1 );
+
+  // ----- create random atoms; detector 1 has a gap, and both detectors miss the same single atom
+  MultiFstatAtomVector *multiAtoms;
+  XLAL_CHECK_MAIN( ( multiAtoms = XLALCreateMultiFstatAtomVector( NUM_DET ) ) != NULL, XLAL_EFUNC );
+  for ( UINT4 X = 0; X < NUM_DET; ++X ) {
+    XLAL_CHECK_MAIN( ( multiAtoms->data[X] = XLALCreateFstatAtomVector( NUM_ATOMS ) ) != NULL, XLAL_EFUNC );
+    FstatAtomVector *atoms = multiAtoms->data[X];
+    atoms->TAtom = TATOM;
+    UINT4 numAtoms = 0;
+    for ( UINT4 i = 0; i < NUM_ATOMS; ++i ) {
+      if ( i == 30 || ( X == 1 && 20 <= i && i < 26 ) ) {
+        continue;
+      }
+      FstatAtom *atom = &atoms->data[numAtoms++];
+      atom->timestamp = T0_DATA + i * TATOM;
+      atom->a2_alpha = RandUniform( 0.1, 1.0 );
+      atom->b2_alpha = RandUniform( 0.1, 1.0 );
+      atom->ab_alpha = RandUniform( -0.1, 0.1 );
+      atom->Fa_alpha = crectf( RandUniform( -10, 10 ), RandUniform( -10, 10 ) );
+      atom->Fb_alpha = crectf( RandUniform( -10, 10 ), RandUniform( -10, 10 ) );
+    }
+    atoms->length = numAtoms;
+  }
+
+  // ----- test all window types; windows always cover at least 2 atoms
+  const transientWindowType_t windowTypes[] = { TRANSIENT_NONE, TRANSIENT_RECTANGULAR, TRANSIENT_EXPONENTIAL };
+  const UINT4 numThreads[] = { 2, 3, 7 };
+  for ( UINT4 w = 0; w < XLAL_NUM_ELEM( windowTypes ); ++w ) {
+    transientWindowRange_t XLAL_INIT_DECL( windowRange );
+    windowRange.type = windowTypes[w];
+    windowRange.t0 = T0_DATA;
+    windowRange.t0Band = 40 * TATOM;
+    windowRange.dt0 = TATOM;
+    windowRange.tau = 2 * TATOM;
+    windowRange.tauBand = 10 * TATOM;
+    windowRange.dtau = TATOM / 2;
+    for ( int useFReg = 0; useFReg <= 1; ++useFReg ) {
+      char name[64];
+
+      // ----- compute serial map
+      transientFstatMap_t *refMap;
+      XLAL_CHECK_MAIN( ( refMap = XLALComputeTransientFstatMap( multiAtoms, windowRange, useFReg ) ) != NULL, XLAL_EFUNC );
+
+      // ----- threaded maps must be identical to the serial map, including the ML estimates
+      for ( UINT4 t = 0; t < XLAL_NUM_ELEM( numThreads ); ++t ) {
+        transientFstatMap_t *map;
+        XLAL_CHECK_MAIN( ( map = XLALComputeTransientFstatMapThreaded( multiAtoms, windowRange, useFReg, numThreads[t] ) ) != NULL, XLAL_EFUNC );
+        snprintf( name, sizeof( name ), "window=%d useFReg=%d threads=%u", windowTypes[w], useFReg, numThreads[t] );
+        XLAL_CHECK_MAIN( CompareMaps( map, refMap, 0, name ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLALDestroyTransientFstatMap( map );
+      }
+
+      // ----- CUDA map sums atoms in a different order, so must agree to within a tolerance
+      if ( XLALTransientFstatMapCUDAIsAvailable() ) {
+        transientFstatMap_t *map;
+        XLAL_CHECK_MAIN( ( map = XLALComputeTransientFstatMapCUDA( multiAtoms, windowRange, useFReg ) ) != NULL, XLAL_EFUNC );
+        snprintf( name, sizeof( name ), "window=%d useFReg=%d CUDA", windowTypes[w], useFReg );
+        XLAL_CHECK_MAIN( CompareMaps( map, refMap, CUDA_TOLERANCE, name ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLALDestroyTransientFstatMap( map );
+      }
+
+      XLALDestroyTransientFstatMap( refMap );
+    }
+  }
+  if ( !XLALTransientFstatMapCUDAIsAvailable() ) {
+    printf( "CUDA is not available; skipped tests of XLALComputeTransientFstatMapCUDA()\n" );
+  }
+
+  // ----- cleanup
+  XLALDestroyMultiFstatAtomVector( multiAtoms );
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
@@ -42,7 +42,8 @@
  *
  * Note, we run a comparison only for the 2-IFO multiAM functions XLALComputeMultiAMCoeffs()
  * comparing it to old_LALGetMultiAMCoeffs() [combined with XLALWeightMultiAMCoeffs()],
- * as this excercises the 1-IFO functions as well.
+ * as this excercises the 1-IFO functions as well. The batched XLALComputeMultiAMCoeffsBatch()
+ * is then compared against XLALComputeMultiAMCoeffs() for a list of random sky-locations.
  *
  * Sky-location is picked at random each time, which allows a minimal
  * Monte-Carlo validation by simply running this script repeatedly.
@@ -205,6 +206,38 @@ int main(int argc, char *argv[])
 
     } /* for numChecks */
 
+  /* ========== compare batched multiAM function against single-skyposition XLAL function ========== */
+  {
+#define NUM_BATCH 37	/* not a multiple of the internal block length */
+    SkyPosition skyposBatch[NUM_BATCH];
+    MultiAMCoeffs *multiAM_batch[NUM_BATCH];
+    for ( UINT4 k = 0; k < NUM_BATCH; k ++ )
+      {
+        skyposBatch[k].longitude = LAL_TWOPI * (1.0 * rand() / ( RAND_MAX + 1.0 ) );
+        skyposBatch[k].latitude = LAL_PI_2 - acos ( 1 - 2.0 * rand()/RAND_MAX );
+        skyposBatch[k].system = COORDINATESYSTEM_EQUATORIAL;
+        multiAM_batch[k] = NULL;
+      }
+    if ( XLALComputeMultiAMCoeffsBatch ( multiAM_batch, multiDetStates, NULL, skyposBatch, NUM_BATCH ) != XLAL_SUCCESS ) {
+      XLALPrintError ("%s: XLALComputeMultiAMCoeffsBatch() failed with xlalErrno = %d\n", __func__, xlalErrno );
+      return XLAL_EFAILED;
+    }
+    for ( UINT4 k = 0; k < NUM_BATCH; k ++ )
+      {
+        MultiAMCoeffs *multiAM_XLAL;
+        if ( ( multiAM_XLAL = XLALComputeMultiAMCoeffs ( multiDetStates, NULL, skyposBatch[k] )) == NULL ) {
+          XLALPrintError ("%s: XLALComputeMultiAMCoeffs() failed with xlalErrno = %d\n", __func__, xlalErrno );
+          return XLAL_EFAILED;
+        }
+        if ( XLALCompareMultiAMCoeffs ( multiAM_batch[k], multiAM_XLAL, 5 * tolerance ) != XLAL_SUCCESS ) {	/* allow for REAL4 rounding differences */
+          XLALPrintError ("%s: comparison between multiAM_batch[%u] and multiAM_XLAL failed.\n", __func__, k );
+          return XLAL_EFAILED;
+        }
+        XLALDestroyMultiAMCoeffs ( multiAM_XLAL );
+        XLALDestroyMultiAMCoeffs ( multiAM_batch[k] );
+      }
+  }
+
   /* we're done: free memory */
   XLALDestroyMultiDetectorStateSeries ( multiDetStates );
 
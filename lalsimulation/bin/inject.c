@@ -51,6 +51,12 @@
  * `LAL_DEBUG_LEVEL=3` which prints both error messages and warning messages,
  * and `LAL_DEBUG_LEVEL=7` which additionally prints informational messages.
  *
+ * When built with OpenMP, the injections are re-interpolated onto the
+ * target's sample grid in parallel; `OMP_NUM_THREADS` sets the number of
+ * threads.  The re-interpolated injections are then added to the target in
+ * the order they are given, so the output does not depend on the number of
+ * threads.
+ *
  * ### Exit Status
  *
  * The `lalsim-inject` utility exits 0 on success, and >0 if an error occurs.
@@ -84,15 +90,22 @@
 #include <lal/TimeSeries.h>
 #include <lal/LALSimulation.h>
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 char *program;
 int usage(void);
 int isoption(char *arg, const char *opt);
 REAL8TimeSeries *readdata(FILE * fp);
+REAL8TimeSeries *shiftinjection(const REAL8TimeSeries * target, REAL8TimeSeries * h, int *status);
 
 int main(int argc, char *argv[])
 {
     char tstr[32];      // string to hold GPS time -- 31 characters is enough
     REAL8TimeSeries **h;
+    REAL8TimeSeries **shifted;
+    int *status;
     int verbose = 0;
     int first_stdin = -1;
     int n;
@@ -158,26 +171,47 @@ int main(int argc, char *argv[])
             fprintf(stderr, "%s: %d points of strain data read\n", program, (int)h[n]->data->length);
     }
 
-    /* add injections to target */
+    /* sample rates deduced from file might have roundoff errors: if an
+     * injection series' deltaT is close enough the target series'
+     * deltaT, make it equal */
     for (c = 1; c < n; ++c) {
-        /* sample rates deduced from file might have roundoff
-         * errors: if an injection series' deltaT is close enough 
-         * the target series' deltaT, make it equal */
         if (fabs(1.0 / h[c]->deltaT - 1.0 / h[0]->deltaT) < 0.1)
             h[c]->deltaT = h[0]->deltaT;
         else {
             fprintf(stderr, "%s: incorrect sample rate for injection %d -- must match target\n", program, c);
             return 1;
         }
+    }
 
-        /* now add */
+    /* re-interpolate the injections onto the target's sample grid; the
+     * injections are independent so this is done in parallel */
+    shifted = calloc(n, sizeof(*shifted));
+    status = calloc(n, sizeof(*status));
+    #pragma omp parallel for schedule(dynamic)
+    for (c = 1; c < n; ++c) {
+        if (verbose)
+            fprintf(stderr, "%s: re-interpolating injection %d\n", program, c);
+        shifted[c] = shiftinjection(h[0], h[c], &status[c]);
+    }
+
+    /* add injections to target, in order */
+    for (c = 1; c < n; ++c) {
+        if (status[c] < 0) {
+            fprintf(stderr, "%s: failed to add injection %d to target\n", program, c);
+            return 1;
+        }
+        if (!shifted[c])        /* does not overlap target */
+            continue;
         if (verbose)
             fprintf(stderr, "%s: adding injection %d to target\n", program, c);
-        if (XLALSimAddInjectionREAL8TimeSeries(h[0], h[c], NULL) < 0) {
+        if (!XLALAddREAL8TimeSeries(h[0], shifted[c])) {
             fprintf(stderr, "%s: failed to add injection %d to target\n", program, c);
             return 1;
         }
+        XLALDestroyREAL8TimeSeries(shifted[c]);
     }
+    free(status);
+    free(shifted);
 
     /* output results */
     fprintf(stdout, "# time (s)\tSTRAIN (strain)\n");
@@ -242,6 +276,45 @@ REAL8TimeSeries *readdata(FILE * fp)
     return h;
 }
 
+/* re-interpolate an injection onto the target's sample grid.  the result
+ * is the injection added to zeros over the part of the target that the
+ * injection, including the padding XLALSimAddInjectionREAL8TimeSeries()
+ * keeps around it, overlaps.  returns NULL if there is no overlap or on
+ * error, in which case status is set < 0 */
+REAL8TimeSeries *shiftinjection(const REAL8TimeSeries * target, REAL8TimeSeries * h, int *status)
+{
+    /* half of the aperiodicity suppression buffer of
+     * XLALSimAddInjectionREAL8TimeSeries(), plus a sample of rounding */
+    const double pad = 16384 + 1;
+    double offset = XLALGPSDiff(&h->epoch, &target->epoch) / target->deltaT;
+    double start = floor(offset) - pad;
+    double end = ceil(offset) + h->data->length + pad;
+    LIGOTimeGPS epoch = target->epoch;
+    REAL8TimeSeries *s;
+
+    *status = 0;
+    if (start < 0)
+        start = 0;
+    if (end > target->data->length)
+        end = target->data->length;
+    if (end <= start)
+        return NULL;
+
+    XLALGPSAdd(&epoch, start * target->deltaT);
+    s = XLALCreateREAL8TimeSeries(target->name, &epoch, target->f0, target->deltaT, &target->sampleUnits, end - start);
+    if (!s) {
+        *status = -1;
+        return NULL;
+    }
+    memset(s->data->data, 0, s->data->length * sizeof(*s->data->data));
+    if (XLALSimAddInjectionREAL8TimeSeries(s, h, NULL) < 0) {
+        XLALDestroyREAL8TimeSeries(s);
+        *status = -1;
+        return NULL;
+    }
+    return s;
+}
+
 int usage(void)
 {
     /* *INDENT-OFF* */
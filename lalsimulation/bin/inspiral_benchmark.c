@@ -0,0 +1,533 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+/**
+ * @defgroup lalsim_inspiral_benchmark lalsim-inspiral-benchmark
+ * @ingroup lalsimulation_programs
+ *
+ * @brief Times the generation of binary inspiral waveforms
+ *
+ * ### Synopsis
+ *
+ *     lalsim-inspiral-benchmark [options]
+ *
+ * ### Description
+ *
+ * The `lalsim-inspiral-benchmark` utility times the generation of
+ * gravitational waveforms from binary inspirals, for each of a list of
+ * approximants, over a grid of total masses, mass ratios, spin magnitudes
+ * and starting frequencies (i.e. signal lengths).  Waveforms are generated
+ * with XLALSimInspiralChooseFDWaveform() for approximants implemented in
+ * the frequency domain, and with XLALSimInspiralChooseTDWaveform()
+ * otherwise, unless the `-D` option is given.  For each grid point, one
+ * untimed call is made first, so that any data files are loaded, followed
+ * by a number of timed calls.
+ *
+ * Aligned-spin approximants are given spins of the given magnitude along
+ * the orbital angular momentum; precessing-spin approximants are given
+ * spins of the given magnitude tilted by 45 degrees; spinless approximants
+ * are only run for zero spin.  Approximants which fail at a grid point, e.g.
+ * because it lies outside their region of validity or because their data
+ * files are not installed, are reported and skipped.
+ *
+ * The output is written to standard output as a multicolumn ascii format,
+ * with one row per approximant and grid point, giving the minimum, median,
+ * 90th percentile and maximum wall-clock generation times, the peak memory
+ * allocated and the number of memory allocations per call, and the peak
+ * resident memory of the process so far.  The peak memory allocated and
+ * the number of allocations are only available if memory debugging is
+ * enabled, e.g. with `LAL_DEBUG_LEVEL=memdbg`, in which case the generation
+ * times include the overhead of memory debugging; times should therefore be
+ * compared with the same `LAL_DEBUG_LEVEL`.
+ *
+ * ### Options
+ * [default values in brackets]
+ *
+ * <DL>
+ * <DT>`-h`, `--help`
+ * <DD>print a help message and exit</DD>
+ * <DT>`-v`, `--verbose`
+ * <DD>verbose output</DD>
+ * <DT>`-a` APPROX1`,`APPROX2,..., `--approximants=`APPROX1`,`APPROX2,...
+ * <DD>approximants [TaylorF2,IMRPhenomD,IMRPhenomXAS,IMRPhenomXHM,IMRPhenomXPHM,SEOBNRv4_ROM,NRSur7dq4,TEOBResumS]</DD>
+ * <DT>`-D` domain, `--domain=`DOMAIN
+ * <DD>domain for waveform generation when both are available {"time", "freq"}
+ * [use frequency domain]</DD>
+ * <DT>`-M` M1`,`M2,..., `--total-masses=`M1`,`M2,...
+ * <DD>total masses in solar masses [10,30,100]</DD>
+ * <DT>`-q` Q1`,`Q2,..., `--mass-ratios=`Q1`,`Q2,...
+ * <DD>mass ratios m1/m2 >= 1 [1,4]</DD>
+ * <DT>`-s` S1`,`S2,..., `--spins=`S1`,`S2,...
+ * <DD>dimensionless spin magnitudes of both bodies [0,0.5]</DD>
+ * <DT>`-f` F1`,`F2,..., `--f-mins=`F1`,`F2,...
+ * <DD>frequencies to start waveforms in Hertz [20]</DD>
+ * <DT>`-R` SRATE, `--sample-rate=`SRATE
+ * <DD>sample rate in Hertz [4096]</DD>
+ * <DT>`-n` NCALLS, `--num-calls=`NCALLS
+ * <DD>number of timed calls per grid point [10]</DD>
+ * </DL>
+ *
+ * ### Environment
+ *
+ * The `LAL_DEBUG_LEVEL` can used to control the error and warning reporting of
+ * `lalsim-inspiral-benchmark`, and to enable memory debugging as described
+ * above.
+ *
+ * ### Exit Status
+ *
+ * The `lalsim-inspiral-benchmark` utility exits 0 on success, and >0 if an
+ * error occurs.
+ *
+ * ### Example
+ *
+ * The command:
+ *
+ *     LAL_DEBUG_LEVEL=memdbg lalsim-inspiral-benchmark --approximants=IMRPhenomD,IMRPhenomXAS --f-mins=10,20
+ *
+ * times the IMRPhenomD and IMRPhenomXAS approximants over the default mass
+ * and spin grid and for starting frequencies of 10 Hz and 20 Hz, and reports
+ * the memory allocated by each call.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#include <lal/LALgetopt.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/LALDatatypes.h>
+#include <lal/LALString.h>
+#include <lal/TimeSeries.h>
+#include <lal/FrequencySeries.h>
+#include <lal/LALSimInspiral.h>
+
+/* default values of parameters */
+#define DEFAULT_APPROXIMANTS "TaylorF2,IMRPhenomD,IMRPhenomXAS,IMRPhenomXHM,IMRPhenomXPHM,SEOBNRv4_ROM,NRSur7dq4,TEOBResumS"
+#define DEFAULT_DOMAIN -1
+#define DEFAULT_TOTAL_MASSES "10,30,100"
+#define DEFAULT_MASS_RATIOS "1,4"
+#define DEFAULT_SPINS "0,0.5"
+#define DEFAULT_F_MINS "20"
+#define DEFAULT_SRATE 4096.0
+#define DEFAULT_NCALLS 10
+#define DEFAULT_DISTANCE 100.0
+
+/* parameters given in command line arguments */
+struct params {
+    int verbose;
+    int domain;
+    size_t napprox;
+    Approximant *approx;
+    size_t nmass;
+    double *mass;
+    size_t nratio;
+    double *ratio;
+    size_t nspin;
+    double *spin;
+    size_t nfmin;
+    double *f_min;
+    double srate;
+    int ncalls;
+};
+
+/* the parameters of one waveform at a grid point */
+struct point {
+    Approximant approx;
+    int domain;
+    double m1;
+    double m2;
+    double s1x;
+    double s1z;
+    double s2x;
+    double s2z;
+    double f_min;
+    double deltaF;
+};
+
+int usage(const char *program);
+struct params parseargs(int argc, char **argv);
+size_t parse_list(double **values, const char *string, const char *option);
+double wall_time(void);
+int compare_doubles(const void *a, const void *b);
+double imr_time_bound(double f_min, double m1, double m2, double s1z, double s2z);
+int generate(size_t *length, struct point w, struct params p);
+int benchmark(struct point w, double M, double q, double chi, struct params p);
+
+int main(int argc, char *argv[])
+{
+    struct params p;
+    size_t a, i, j, k, l;
+
+    XLALSetErrorHandler(XLALBacktraceErrorHandler);
+
+    p = parseargs(argc, argv);
+
+    fprintf(stdout, "# approximant\tdomain\tM (Msun)\tq\tchi\tf_min (Hz)\tlength\tcalls\tt_min (s)\tt_50 (s)\tt_90 (s)\tt_max (s)\tpeak_alloc (MB)\tallocs/call\tmax_rss (MB)\n");
+
+    for (a = 0; a < p.napprox; ++a) {
+        int istd = XLALSimInspiralImplementedTDApproximants(p.approx[a]);
+        int isfd = XLALSimInspiralImplementedFDApproximants(p.approx[a]);
+        int spins = XLALSimInspiralGetSpinSupportFromApproximant(p.approx[a]);
+        struct point w = {.approx = p.approx[a] };
+
+        /* choose the domain; frequency domain unless otherwise requested */
+        switch (p.domain) {
+        case LAL_SIM_DOMAIN_TIME:
+            w.domain = istd ? LAL_SIM_DOMAIN_TIME : LAL_SIM_DOMAIN_FREQUENCY;
+            break;
+        case LAL_SIM_DOMAIN_FREQUENCY:
+        default:
+            w.domain = isfd ? LAL_SIM_DOMAIN_FREQUENCY : LAL_SIM_DOMAIN_TIME;
+            break;
+        }
+
+        for (i = 0; i < p.nmass; ++i)
+            for (j = 0; j < p.nratio; ++j)
+                for (k = 0; k < p.nspin; ++k)
+                    for (l = 0; l < p.nfmin; ++l) {
+                        double M = p.mass[i];
+                        double q = p.ratio[j];
+                        double chi = p.spin[k];
+                        double chirplen;
+                        int chirplen_exp;
+
+                        if (spins == LAL_SIM_INSPIRAL_SPINLESS && chi != 0.0)
+                            continue;
+
+                        w.m1 = M * q / (1.0 + q) * LAL_MSUN_SI;
+                        w.m2 = M / (1.0 + q) * LAL_MSUN_SI;
+                        w.s1x = w.s2x = 0.0;
+                        w.s1z = w.s2z = chi;
+                        if (spins == LAL_SIM_INSPIRAL_PRECESSINGSPIN) {
+                            w.s1x = w.s2x = chi * LAL_SQRT1_2;
+                            w.s1z = w.s2z = chi * LAL_SQRT1_2;
+                        } else if (spins == LAL_SIM_INSPIRAL_SINGLESPIN) {
+                            w.s2z = 0.0;
+                        }
+                        w.f_min = p.f_min[l];
+
+                        /* frequency resolution from the length of the chirp, rounded up to a power of two */
+                        chirplen = imr_time_bound(w.f_min, w.m1, w.m2, w.s1z, w.s2z) * p.srate;
+                        frexp(chirplen, &chirplen_exp);
+                        w.deltaF = p.srate / ldexp(1.0, chirplen_exp);
+
+                        benchmark(w, M, q, chi, p);
+                    }
+    }
+
+    /* cleanup */
+    LALFree(p.f_min);
+    LALFree(p.spin);
+    LALFree(p.ratio);
+    LALFree(p.mass);
+    LALFree(p.approx);
+    LALCheckMemoryLeaks();
+    return 0;
+}
+
+/* times the generation of one waveform and writes a row of the output */
+int benchmark(struct point w, double M, double q, double chi, struct params p)
+{
+    const char *name = XLALSimInspiralGetStringFromApproximant(w.approx);
+    const int memdbg = lalDebugLevel & LALMEMPADBIT;
+    double *times;
+    size_t length = 0;
+    size_t base, count;
+    struct rusage usage;
+    int errnum;
+    int n;
+
+    if (p.verbose)
+        fprintf(stderr, "generating %s waveform for M = %g Msun, q = %g, chi = %g, f_min = %g Hz...\n", name, M, q, chi, w.f_min);
+
+    /* untimed call, which loads any data files */
+    XLAL_TRY(generate(&length, w, p), errnum);
+    if (errnum) {
+        fprintf(stderr, "warning: %s failed for M = %g Msun, q = %g, chi = %g, f_min = %g Hz: %s\n", name, M, q, chi, w.f_min, XLALErrorString(errnum));
+        return 0;
+    }
+
+    /* timed calls; peak allocated memory is measured relative to memory allocated before the calls */
+    times = LALMalloc(p.ncalls * sizeof(*times));
+    base = lalMallocTotal;
+    lalMallocTotalPeak = base;
+    count = lalMallocCount;
+    for (n = 0; n < p.ncalls; ++n) {
+        double start = wall_time();
+        generate(&length, w, p);
+        times[n] = wall_time() - start;
+    }
+    count = lalMallocCount - count;
+    qsort(times, p.ncalls, sizeof(*times), compare_doubles);
+    getrusage(RUSAGE_SELF, &usage);
+
+    fprintf(stdout, "%s\t%s\t%g\t%g\t%g\t%g\t%zu\t%d\t%.6e\t%.6e\t%.6e\t%.6e\t", name, w.domain == LAL_SIM_DOMAIN_TIME ? "time" : "freq", M, q, chi, w.f_min, length, p.ncalls,
+            times[0], times[(p.ncalls - 1) / 2], times[(9 * (p.ncalls - 1)) / 10], times[p.ncalls - 1]);
+    if (memdbg)
+        fprintf(stdout, "%.3f\t%.1f\t", (lalMallocTotalPeak - base) / (1024.0 * 1024.0), (double)count / p.ncalls);
+    else
+        fprintf(stdout, "-\t-\t");
+    /* ru_maxrss is in kilobytes on Linux */
+    fprintf(stdout, "%.1f\n", usage.ru_maxrss / 1024.0);
+    fflush(stdout);
+
+    LALFree(times);
+    return 0;
+}
+
+/* generates and destroys one waveform, returning its length */
+int generate(size_t *length, struct point w, struct params p)
+{
+    if (w.domain == LAL_SIM_DOMAIN_TIME) {
+        REAL8TimeSeries *h_plus = NULL;
+        REAL8TimeSeries *h_cross = NULL;
+        if (XLALSimInspiralChooseTDWaveform(&h_plus, &h_cross, w.m1, w.m2, w.s1x, 0.0, w.s1z, w.s2x, 0.0, w.s2z, DEFAULT_DISTANCE * 1e6 * LAL_PC_SI, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0 / p.srate, w.f_min, 0.0, NULL, w.approx) < 0)
+            XLAL_ERROR(XLAL_EFUNC);
+        *length = h_plus->data->length;
+        XLALDestroyREAL8TimeSeries(h_cross);
+        XLALDestroyREAL8TimeSeries(h_plus);
+    } else {
+        COMPLEX16FrequencySeries *htilde_plus = NULL;
+        COMPLEX16FrequencySeries *htilde_cross = NULL;
+        if (XLALSimInspiralChooseFDWaveform(&htilde_plus, &htilde_cross, w.m1, w.m2, w.s1x, 0.0, w.s1z, w.s2x, 0.0, w.s2z, DEFAULT_DISTANCE * 1e6 * LAL_PC_SI, 0.0, 0.0, 0.0, 0.0, 0.0, w.deltaF, w.f_min, 0.5 * p.srate, 0.0, NULL, w.approx) < 0)
+            XLAL_ERROR(XLAL_EFUNC);
+        *length = htilde_plus->data->length;
+        XLALDestroyCOMPLEX16FrequencySeries(htilde_cross);
+        XLALDestroyCOMPLEX16FrequencySeries(htilde_plus);
+    }
+    return 0;
+}
+
+/* returns the wall-clock time in seconds */
+double wall_time(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + 1e-6 * tv.tv_usec;
+}
+
+/* comparison function for sorting times */
+int compare_doubles(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* routine to crudely overestimate the duration of the inspiral, merger, and ringdown */
+double imr_time_bound(double f_min, double m1, double m2, double s1z, double s2z)
+{
+    double tchirp, tmerge;
+    double s;
+
+    /* lower bound on the chirp time starting at f_min */
+    tchirp = XLALSimInspiralChirpTimeBound(f_min, m1, m2, s1z, s2z);
+
+    /* upper bound on the final black hole spin */
+    s = XLALSimInspiralFinalBlackHoleSpinBound(s1z, s2z);
+
+    /* lower bound on the final plunge, merger, and ringdown time */
+    tmerge = XLALSimInspiralMergeTimeBound(m1, m2) + XLALSimInspiralRingdownTimeBound(m1 + m2, s);
+
+    return tchirp + tmerge;
+}
+
+/* prints the usage message */
+int usage(const char *program)
+{
+    fprintf(stderr, "usage: %s [options]\n", program);
+    fprintf(stderr, "options [default values in brackets]:\n");
+    fprintf(stderr, "\t-h, --help               \tprint this message and exit\n");
+    fprintf(stderr, "\t-v, --verbose            \tverbose output\n");
+    fprintf(stderr, "\t-a APPROX1,APPROX2,..., --approximants=APPROX1,APPROX2,...\n\t\tapproximants [%s]\n", DEFAULT_APPROXIMANTS);
+    fprintf(stderr, "\t-D domain, --domain=DOMAIN      \n\t\tdomain for waveform generation when both are available\n\t\t{\"time\", \"freq\"} [use frequency domain]\n");
+    fprintf(stderr, "\t-M M1,M2,..., --total-masses=M1,M2,...\n\t\ttotal masses in solar masses [%s]\n", DEFAULT_TOTAL_MASSES);
+    fprintf(stderr, "\t-q Q1,Q2,..., --mass-ratios=Q1,Q2,...\n\t\tmass ratios m1/m2 >= 1 [%s]\n", DEFAULT_MASS_RATIOS);
+    fprintf(stderr, "\t-s S1,S2,..., --spins=S1,S2,...\n\t\tdimensionless spin magnitudes of both bodies [%s]\n", DEFAULT_SPINS);
+    fprintf(stderr, "\t-f F1,F2,..., --f-mins=F1,F2,...\n\t\tfrequencies to start waveforms in Hertz [%s]\n", DEFAULT_F_MINS);
+    fprintf(stderr, "\t-R SRATE, --sample-rate=SRATE   \n\t\tsample rate in Hertz [%g]\n", DEFAULT_SRATE);
+    fprintf(stderr, "\t-n NCALLS, --num-calls=NCALLS   \n\t\tnumber of timed calls per grid point [%d]\n", DEFAULT_NCALLS);
+    return 0;
+}
+
+/* parses a comma-separated list of numbers */
+size_t parse_list(double **values, const char *string, const char *option)
+{
+    char *copy = XLALStringDuplicate(string);
+    char *s = copy;
+    char *tok;
+    size_t n = 0;
+    if (*values) {
+        LALFree(*values);
+        *values = NULL;
+    }
+    while ((tok = XLALStringToken(&s, ",", 0))) {
+        char *end;
+        *values = LALRealloc(*values, (n + 1) * sizeof(**values));
+        (*values)[n++] = strtod(tok, &end);
+        if (*end != '\0') {
+            fprintf(stderr, "error: invalid value %s for %s\n", tok, option);
+            exit(1);
+        }
+    }
+    LALFree(copy);
+    if (n == 0) {
+        fprintf(stderr, "error: no values given for %s\n", option);
+        exit(1);
+    }
+    return n;
+}
+
+/* sets params to default values and parses the command line arguments */
+struct params parseargs(int argc, char **argv)
+{
+    const char *approx_string = DEFAULT_APPROXIMANTS;
+    char *copy, *s, *tok;
+    size_t i;
+    struct params p = {
+        .verbose = 0,
+        .domain = DEFAULT_DOMAIN,
+        .srate = DEFAULT_SRATE,
+        .ncalls = DEFAULT_NCALLS,
+    };
+    struct LALoption long_options[] = {
+        {"help", no_argument, 0, 'h'},
+        {"verbose", no_argument, 0, 'v'},
+        {"approximants", required_argument, 0, 'a'},
+        {"domain", required_argument, 0, 'D'},
+        {"total-masses", required_argument, 0, 'M'},
+        {"mass-ratios", required_argument, 0, 'q'},
+        {"spins", required_argument, 0, 's'},
+        {"f-mins", required_argument, 0, 'f'},
+        {"sample-rate", required_argument, 0, 'R'},
+        {"num-calls", required_argument, 0, 'n'},
+        {0, 0, 0, 0}
+    };
+    char args[] = "hva:D:M:q:s:f:R:n:";
+
+    p.nmass = parse_list(&p.mass, DEFAULT_TOTAL_MASSES, "total-masses");
+    p.nratio = parse_list(&p.ratio, DEFAULT_MASS_RATIOS, "mass-ratios");
+    p.nspin = parse_list(&p.spin, DEFAULT_SPINS, "spins");
+    p.nfmin = parse_list(&p.f_min, DEFAULT_F_MINS, "f-mins");
+
+    while (1) {
+        int option_index = 0;
+        int c;
+
+        c = LALgetopt_long_only(argc, argv, args, long_options, &option_index);
+        if (c == -1)    /* end of options */
+            break;
+
+        switch (c) {
+        case 0:        /* if option set a flag, nothing else to do */
+            if (long_options[option_index].flag)
+                break;
+            else {
+                fprintf(stderr, "error parsing option %s with argument %s\n", long_options[option_index].name, LALoptarg);
+                exit(1);
+            }
+        case 'h':      /* help */
+            usage(argv[0]);
+            exit(0);
+        case 'v':      /* verbose */
+            p.verbose = 1;
+            break;
+        case 'a':      /* approximants */
+            approx_string = LALoptarg;
+            break;
+        case 'D':      /* domain */
+            switch (*LALoptarg) {
+            case 'T':
+            case 't':
+                p.domain = LAL_SIM_DOMAIN_TIME;
+                break;
+            case 'F':
+            case 'f':
+                p.domain = LAL_SIM_DOMAIN_FREQUENCY;
+                break;
+            default:
+                fprintf(stderr, "error: invalid value %s for %s\n", LALoptarg, long_options[option_index].name);
+                exit(1);
+            }
+            break;
+        case 'M':      /* total-masses */
+            p.nmass = parse_list(&p.mass, LALoptarg, long_options[option_index].name);
+            break;
+        case 'q':      /* mass-ratios */
+            p.nratio = parse_list(&p.ratio, LALoptarg, long_options[option_index].name);
+            break;
+        case 's':      /* spins */
+            p.nspin = parse_list(&p.spin, LALoptarg, long_options[option_index].name);
+            break;
+        case 'f':      /* f-mins */
+            p.nfmin = parse_list(&p.f_min, LALoptarg, long_options[option_index].name);
+            break;
+        case 'R':      /* sample-rate */
+            p.srate = atof(LALoptarg);
+            break;
+        case 'n':      /* num-calls */
+            p.ncalls = atoi(LALoptarg);
+            break;
+        case '?':
+        default:
+            fprintf(stderr, "unknown error while parsing options\n");
+            exit(1);
+        }
+    }
+    if (LALoptind < argc) {
+        fprintf(stderr, "extraneous command line arguments:\n");
+        while (LALoptind < argc)
+            fprintf(stderr, "%s\n", argv[LALoptind++]);
+        exit(1);
+    }
+
+    /* check values */
+    if (p.srate <= 0 || p.ncalls < 1) {
+        fprintf(stderr, "error: sample rate and number of calls must be positive\n");
+        exit(1);
+    }
+    for (i = 0; i < p.nratio; ++i)
+        if (p.ratio[i] < 1) {
+            fprintf(stderr, "error: mass ratios must be >= 1\n");
+            exit(1);
+        }
+
+    /* parse the approximants */
+    copy = XLALStringDuplicate(approx_string);
+    s = copy;
+    p.napprox = 0;
+    p.approx = NULL;
+    while ((tok = XLALStringToken(&s, ",", 0))) {
+        int approx = XLALSimInspiralGetApproximantFromString(tok);
+        if (approx == XLAL_FAILURE) {
+            fprintf(stderr, "error: invalid approximant %s\n", tok);
+            exit(1);
+        }
+        if (!XLALSimInspiralImplementedTDApproximants(approx) && !XLALSimInspiralImplementedFDApproximants(approx)) {
+            fprintf(stderr, "error: approximant %s not supported\n", tok);
+            exit(1);
+        }
+        p.approx = LALRealloc(p.approx, (p.napprox + 1) * sizeof(*p.approx));
+        p.approx[p.napprox++] = approx;
+    }
+    LALFree(copy);
+
+    return p;
+}
@@ -41,8 +41,13 @@
 #include <lal/RealFFT.h>
 #include <lal/Units.h>
 #include <lal/Date.h>
+#include <lal/VectorMath.h>
 #include "check_series_macros.h"
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 
 /*
  * ============================================================================
@@ -1275,6 +1280,253 @@ int XLALSimBurstGaussian(
 }
 
 
+/*
+ * Add one Gaussian lobe, coef * exp(-a (f - centre)^2), to the frequency
+ * series h.  Only the bins where the lobe exceeds LAL_REAL8_EPS relative to
+ * its peak are evaluated.
+ */
+
+
+static int add_gaussian_lobe(
+	COMPLEX16FrequencySeries *h,
+	double centre,
+	double a,
+	COMPLEX16 coef
+)
+{
+	/* half-width of the lobe's support */
+	const double width = sqrt(-log(LAL_REAL8_EPS) / a);
+	double kmin = ceil((centre - width - h->f0) / h->deltaF);
+	double kmax = floor((centre + width - h->f0) / h->deltaF);
+	size_t first, n, k;
+	REAL8 *g;
+
+	if(coef == 0.0 || kmax < 0 || kmin >= h->data->length || kmin > kmax)
+		return 0;
+	first = kmin < 0 ? 0 : kmin;
+	n = (kmax >= h->data->length ? h->data->length - 1 : kmax) - first + 1;
+
+	g = XLALMalloc(n * sizeof(*g));
+	if(!g)
+		XLAL_ERROR(XLAL_ENOMEM);
+	for(k = 0; k < n; k++) {
+		const double x = h->f0 + (first + k) * h->deltaF - centre;
+		g[k] = -a * x * x;
+	}
+	if(XLALVectorExpREAL8(g, g, n) < 0) {
+		XLALFree(g);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+	for(k = 0; k < n; k++)
+		h->data->data[first + k] += coef * g[k];
+	XLALFree(g);
+
+	return 0;
+}
+
+
+/**
+ * @brief Generate frequency-domain sine- and cosine-Gaussian waveforms
+ * into existing frequency series.
+ *
+ * @details
+ * Computes the Fourier transforms of the \f$h_{+}\f$ and \f$h_{\times}\f$
+ * of XLALSimBurstSineGaussian() analytically, without the Tukey window, for
+ * a waveform whose Gaussian envelope peaks at the epoch of the series.
+ * With \f$\sigma_{t} = Q / (2 \pi f_{0})\f$ and
+ * \f$G(f) = \sqrt{2 \pi} \sigma_{t} \exp(-2 \pi^{2} \sigma_{t}^{2} f^{2})\f$,
+ * \f{align}{
+ * \tilde{h}_{+}(f)
+ *    &= \frac{{h_{0}}_{+}}{2} \left[ e^{-i \phi} G(f - f_{0}) + e^{i \phi} G(f + f_{0}) \right], \\
+ * \tilde{h}_{\times}(f)
+ *    &= \frac{{h_{0}}_{\times}}{2 i} \left[ e^{-i \phi} G(f - f_{0}) - e^{i \phi} G(f + f_{0}) \right].
+ * \f}
+ * The frequency samples, \f$f_{k} = f_{\mathrm{start}} + k \Delta f\f$, are
+ * those of hplus and hcross, which must agree.  The series are overwritten:
+ * bins where the Gaussians are below the REAL8 precision of their peak are
+ * set to 0, and only the others are evaluated, so the cost is set by the
+ * bandwidth of the waveform rather than the length of the series.  No
+ * memory is allocated for the output, so a caller generating many
+ * templates on one frequency grid can reuse the series.
+ *
+ * @param[in,out] hplus Frequency series to be filled with
+ * \f$\tilde{h}_{+}\f$.
+ *
+ * @param[in,out] hcross Frequency series to be filled with
+ * \f$\tilde{h}_{\times}\f$.
+ *
+ * @param[in] Q The "Q" of the waveform;  see XLALSimBurstSineGaussian().
+ *
+ * @param[in] centre_frequency The frequency of the sinusoidal oscillations
+ * that get multiplied by the Gaussian envelope.
+ *
+ * @param[in] hrss The \f$h_{\mathrm{rss}}\f$ of the waveform;  see
+ * XLALSimBurstSineGaussian().
+ *
+ * @param[in] eccentricity The eccentricity of the polarization ellipse;
+ * see XLALSimBurstSineGaussian().
+ *
+ * @param[in] phase The phase of the sinusoidal oscillations;  see
+ * XLALSimBurstSineGaussian().
+ *
+ * @retval 0 Success
+ * @retval <0 Failure
+ */
+
+
+int XLALSimBurstSineGaussianFD(
+	COMPLEX16FrequencySeries *hplus,
+	COMPLEX16FrequencySeries *hcross,
+	REAL8 Q,
+	REAL8 centre_frequency,
+	REAL8 hrss,
+	REAL8 eccentricity,
+	REAL8 phase
+)
+{
+	/* same normalization as XLALSimBurstSineGaussian() */
+	const double cgsq = Q / (4.0 * centre_frequency * sqrt(LAL_PI)) * (1.0 + exp(-Q * Q));
+	const double sgsq = Q / (4.0 * centre_frequency * sqrt(LAL_PI)) * (1.0 - exp(-Q * Q));
+	double a, b;
+	double cosphase = cos(phase);
+	double sinphase = sin(phase);
+	double h0plus, h0cross;
+	/* width of the envelope, and the exponent of its transform */
+	const double sigma_t = Q / (LAL_TWOPI * centre_frequency);
+	const double expfac = 2.0 * LAL_PI * LAL_PI * sigma_t * sigma_t;
+	COMPLEX16 eminus, eplus;
+
+	/* check input. */
+
+	LAL_CHECK_VALID_SERIES(hplus, XLAL_FAILURE);
+	LAL_CHECK_VALID_SERIES(hcross, XLAL_FAILURE);
+	if(hplus->data->length != hcross->data->length || hplus->f0 != hcross->f0 || hplus->deltaF != hcross->deltaF)
+		XLAL_ERROR(XLAL_EINVAL, "hplus and hcross must have the same frequency samples");
+	if(Q <= 0 || centre_frequency <= 0 || hrss < 0 || eccentricity < 0 || eccentricity > 1 || hplus->deltaF <= 0)
+		XLAL_ERROR(XLAL_EINVAL, "invalid input parameters");
+
+	semi_major_minor_from_e(eccentricity, &a, &b);
+	h0plus  = hrss * a / sqrt(cgsq * cosphase * cosphase + sgsq * sinphase * sinphase);
+	h0cross = hrss * b / sqrt(cgsq * sinphase * sinphase + sgsq * cosphase * cosphase);
+	eminus = crect(cosphase, -sinphase) * sqrt(LAL_TWOPI) * sigma_t / 2.0;
+	eplus = conj(eminus);
+
+	memset(hplus->data->data, 0, hplus->data->length * sizeof(*hplus->data->data));
+	memset(hcross->data->data, 0, hcross->data->length * sizeof(*hcross->data->data));
+
+	/* the lobe at -f0 only matters for low Q */
+	if(add_gaussian_lobe(hplus, centre_frequency, expfac, h0plus * eminus) < 0 ||
+	   add_gaussian_lobe(hplus, -centre_frequency, expfac, h0plus * eplus) < 0 ||
+	   add_gaussian_lobe(hcross, centre_frequency, expfac, -I * h0cross * eminus) < 0 ||
+	   add_gaussian_lobe(hcross, -centre_frequency, expfac, I * h0cross * eplus) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	return 0;
+}
+
+
+/**
+ * @brief Generate frequency-domain sine-Gaussian waveforms for many sets of
+ * parameters at once.
+ *
+ * @details
+ * Equivalent to calling XLALSimBurstSineGaussianFD() for each of the n
+ * parameter sets (Q[j], centre_frequency[j], hrss[j], eccentricity[j],
+ * phase[j]) with output series hplus[j] and hcross[j].  The waveforms are
+ * generated in parallel when OpenMP is available.
+ *
+ * @retval 0 Success
+ * @retval <0 Failure
+ */
+
+
+int XLALSimBurstSineGaussianFDBatch(
+	COMPLEX16FrequencySeries **hplus,
+	COMPLEX16FrequencySeries **hcross,
+	const REAL8 *Q,
+	const REAL8 *centre_frequency,
+	const REAL8 *hrss,
+	const REAL8 *eccentricity,
+	const REAL8 *phase,
+	size_t n
+)
+{
+	int failed = 0;
+	long j;
+
+	if(!hplus || !hcross || !Q || !centre_frequency || !hrss || !eccentricity || !phase)
+		XLAL_ERROR(XLAL_EFAULT);
+
+	#pragma omp parallel for reduction(|:failed)
+	for(j = 0; j < (long) n; j++)
+		failed |= XLALSimBurstSineGaussianFD(hplus[j], hcross[j], Q[j], centre_frequency[j], hrss[j], eccentricity[j], phase[j]) < 0;
+
+	if(failed)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
+
+/**
+ * @brief Generate frequency-domain Gaussian waveforms into existing
+ * frequency series.
+ *
+ * @details
+ * Computes the Fourier transform of the \f$h_{+}\f$ of
+ * XLALSimBurstGaussian() analytically, without the Tukey window, for a
+ * waveform peaking at the epoch of the series,
+ * \f{equation}{
+ * \tilde{h}_{+}(f)
+ *    = \frac{h_{\mathrm{rss}}}{\sqrt{\sqrt{\pi} \Delta t}} \sqrt{2 \pi} \Delta t \exp(-2 \pi^{2} \Delta t^{2} f^{2}).
+ * \f}
+ * \f$\tilde{h}_{\times}\f$ is set to 0.  As in
+ * XLALSimBurstSineGaussianFD(), the frequency samples are those of hplus
+ * and hcross, and only the bins where the Gaussian is not negligible are
+ * evaluated.
+ *
+ * @param[in,out] hplus Frequency series to be filled with
+ * \f$\tilde{h}_{+}\f$.
+ *
+ * @param[in,out] hcross Frequency series to be filled with
+ * \f$\tilde{h}_{\times}\f$.
+ *
+ * @param[in] duration The width of the Gaussian, \f$\Delta t\f$.
+ *
+ * @param[in] hrss The \f$h_{\mathrm{rss}}\f$ of the waveform.
+ *
+ * @retval 0 Success
+ * @retval <0 Failure
+ */
+
+
+int XLALSimBurstGaussianFD(
+	COMPLEX16FrequencySeries *hplus,
+	COMPLEX16FrequencySeries *hcross,
+	REAL8 duration,
+	REAL8 hrss
+)
+{
+	const double h0plus  = hrss / sqrt(sqrt(LAL_PI) * duration);
+
+	/* check input. */
+
+	LAL_CHECK_VALID_SERIES(hplus, XLAL_FAILURE);
+	LAL_CHECK_VALID_SERIES(hcross, XLAL_FAILURE);
+	if(hplus->data->length != hcross->data->length || hplus->f0 != hcross->f0 || hplus->deltaF != hcross->deltaF)
+		XLAL_ERROR(XLAL_EINVAL, "hplus and hcross must have the same frequency samples");
+	if(duration <= 0 || hrss < 0 || !isfinite(h0plus) || hplus->deltaF <= 0)
+		XLAL_ERROR(XLAL_EINVAL, "invalid input parameters");
+
+	memset(hplus->data->data, 0, hplus->data->length * sizeof(*hplus->data->data));
+	memset(hcross->data->data, 0, hcross->data->length * sizeof(*hcross->data->data));
+
+	if(add_gaussian_lobe(hplus, 0.0, 2.0 * LAL_PI * LAL_PI * duration * duration, h0plus * sqrt(LAL_TWOPI) * duration) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	return 0;
+}
+
+
 /*
  * ============================================================================
  *
@@ -159,6 +159,39 @@ int XLALSimBurstGaussian(
 	REAL8 delta_t
 );
 
+
+int XLALSimBurstSineGaussianFD(
+	COMPLEX16FrequencySeries *hplus,
+	COMPLEX16FrequencySeries *hcross,
+	REAL8 Q,
+	REAL8 centre_frequency,
+	REAL8 hrss,
+	REAL8 eccentricity,
+	REAL8 phase
+);
+
+
+#ifndef SWIG	/* exclude from SWIG interface */
+int XLALSimBurstSineGaussianFDBatch(
+	COMPLEX16FrequencySeries **hplus,
+	COMPLEX16FrequencySeries **hcross,
+	const REAL8 *Q,
+	const REAL8 *centre_frequency,
+	const REAL8 *hrss,
+	const REAL8 *eccentricity,
+	const REAL8 *phase,
+	size_t n
+);
+#endif /* SWIG */
+
+
+int XLALSimBurstGaussianFD(
+	COMPLEX16FrequencySeries *hplus,
+	COMPLEX16FrequencySeries *hcross,
+	REAL8 duration,
+	REAL8 hrss
+);
+
 int XLALSimBurstImg(
 	REAL8TimeSeries **hplus,
 	REAL8TimeSeries **hcross, 
@@ -309,6 +309,7 @@ SphHarmTimeSeries *XLALSimIMRSpinPrecEOBModes(
 /* in module LALSimIMREOBNRv2HMROM.c */
 
 int XLALSimIMREOBNRv2HMROM(struct tagCOMPLEX16FrequencySeries **hptilde, struct tagCOMPLEX16FrequencySeries **hctilde, REAL8 phiRef, REAL8 deltaF, REAL8 fLow, REAL8 fHigh, REAL8 fRef, REAL8 distance, REAL8 inclination, REAL8 m1SI,  REAL8 m2SI, const int higherModesFlag);
+int XLALSimIMREOBNRv2HMROMModes(SphHarmFrequencySeries **hlm, REAL8 phiRef, REAL8 deltaF, REAL8 fLow, REAL8 fHigh, REAL8 fRef, REAL8 distance, REAL8 m1SI, REAL8 m2SI);
 
 /* in module LALSimIMRSEOBNRv1ROMEffectiveSpin.c */
 
@@ -133,6 +133,16 @@ static INT4 EOBNRv2HMROM_Init_LALDATA(void);
 static INT4 EOBNRv2HMROM_Init(const char dir[]);
 
 /* Core functions for waveform reconstruction */
+static INT4 EOBNRv2HMROMCoreModes(
+  SphHarmFrequencySeries **hlms,
+  REAL8 phiRef,
+  REAL8 deltaF,
+  REAL8 fLow,
+  REAL8 fHigh,
+  REAL8 fRef,
+  REAL8 distance,
+  REAL8 Mtot_sec,
+  REAL8 q);
 static INT4 EOBNRv2HMROMCore(
   COMPLEX16FrequencySeries **hptilde,
   COMPLEX16FrequencySeries **hctilde,
@@ -285,21 +295,20 @@ static INT4 Evaluate_Spline_Data(const REAL8 q, const EOBNRHMROMdata_interp* dat
 }
 
 /*
- * Core function for computing the ROM waveform.
+ * Core function for computing the ROM modes.
  * Evaluates projection coefficients and shifts in time and phase at desired q.
  * Construct 1D splines for amplitude and phase.
- * Compute strain waveform from amplitude and phase.
+ * Compute the modes h_lm, m > 0, from amplitude and phase, in the Fourier
+ * convention of the ROM internals.
 */
-static INT4 EOBNRv2HMROMCore(
-  COMPLEX16FrequencySeries **hptilde,
-  COMPLEX16FrequencySeries **hctilde,
+static INT4 EOBNRv2HMROMCoreModes(
+  SphHarmFrequencySeries **hlms,
   REAL8 phiRef,
   REAL8 deltaF,
   REAL8 fLow,
   REAL8 fHigh,
   REAL8 fRef,
   REAL8 distance,
-  REAL8 inclination,
   REAL8 Mtot_sec,
   REAL8 q)
 {
@@ -307,11 +316,11 @@ static INT4 EOBNRv2HMROMCore(
   INT4 i;
   INT4 j;
   double tpeak22estimate = 0.;
-  /* Check output arrays */
-  if(!hptilde || !hctilde) XLAL_ERROR(XLAL_EFAULT);
-  if(*hptilde || *hctilde)
+  /* Check output array */
+  if(!hlms) XLAL_ERROR(XLAL_EFAULT);
+  if(*hlms)
   {
-    XLALPrintError("(*hptilde) and (*hctilde) are supposed to be NULL, but got %p and %p\n",(*hptilde),(*hctilde));
+    XLALPrintError("(*hlms) is supposed to be NULL, but got %p\n",(*hlms));
     XLAL_ERROR(XLAL_EFAULT);
   }
 
@@ -361,10 +370,6 @@ static INT4 EOBNRv2HMROMCore(
   /* Initialized only once, and reused for the different modes */
   EOBNRHMROMdata_coeff *data_coeff = NULL;
   EOBNRHMROMdata_coeff_Init(&data_coeff);
-  /* Create spherical harmonic frequency series that will contain the hlm's */
-  SphHarmFrequencySeries** hlmsphharmfreqseries = XLALMalloc(sizeof(SphHarmFrequencySeries));
-  *hlmsphharmfreqseries = NULL;
-
   /* GPS time definition - common to all modes */
   LIGOTimeGPS tC;
   XLALGPSAdd(&tC, -1. / deltaF);  /* coalesce at t=0 */
@@ -446,8 +451,6 @@ static INT4 EOBNRv2HMROMCore(
     COMPLEX16FrequencySeries* mode = XLALCreateCOMPLEX16FrequencySeries("mode hlm", &tC, 0.0, deltaF, &lalStrainUnit, nbpt);
     memset(mode->data->data, 0, nbpt * sizeof(COMPLEX16));
     /* Setup 1d cubic spline for the phase and amplitude of the mode */
-    gsl_interp_accel* accel_phi = gsl_interp_accel_alloc();
-    gsl_interp_accel* accel_amp = gsl_interp_accel_alloc();
     gsl_spline* spline_phi = gsl_spline_alloc(gsl_interp_cspline, nbfreq);
     gsl_spline* spline_amp = gsl_spline_alloc(gsl_interp_cspline, nbfreq);
     gsl_spline_init(spline_phi, gsl_vector_const_ptr(freq_ds,0), gsl_vector_const_ptr(phi_f,0), nbfreq);
@@ -461,35 +464,27 @@ static INT4 EOBNRv2HMROMCore(
     COMPLEX16 *modedata = mode->data->data;
     /* Mode-dependent complete amplitude prefactor */
     REAL8 amp_pre = amp0 * ModeAmpFactor( l, m, q);
-    /* Loop on the frequency samples chosen to evaluate the waveform */
+    /* Frequency samples chosen to evaluate the waveform */
     /* We set apart the first and last step to avoid falling outside of the range of the splines by numerical errors */
-    REAL8 f, A, phase;
-
-    f = fmax(fLow_geom_mode, jStart*deltaF_geom);
-    A = gsl_spline_eval(spline_amp, f, accel_amp);
-    phase = -gsl_spline_eval(spline_phi, f, accel_phi) + totaltwopishifttime * f + constphaseshift; /* Minus sign put here, in the internals of the ROM model \Psi = -phase */
-    modedata[jStart] = amp_pre * A * cexp(I*phase);
-
-    for (j=jStart+1; j<jStop-1; j++) {
-      f = j*deltaF_geom;
-      A = gsl_spline_eval(spline_amp, f, accel_amp);
-      phase = -gsl_spline_eval(spline_phi, f, accel_phi) + totaltwopishifttime * f + constphaseshift; /* Minus sign put here, in the internals of the ROM model \Psi = -phase */
-      modedata[j] = amp_pre * A * cexp(I*phase);
+    if (jStop > jStart) {
+      REAL8Sequence* freq_mode = XLALCreateREAL8Sequence(jStop - jStart);
+      if (!freq_mode) XLAL_ERROR(XLAL_EFUNC);
+      for (j=jStart; j<jStop; j++)
+        freq_mode->data[j-jStart] = j*deltaF_geom;
+      freq_mode->data[0] = fmax(fLow_geom_mode, jStart*deltaF_geom);
+      freq_mode->data[jStop-jStart-1] = fmin(fHigh_geom_mode, (jStop-1)*deltaF_geom);
+      /* Minus sign on the spline phase, in the internals of the ROM model \Psi = -phase */
+      ret |= ROM_EvaluateModeFromAmpPhaseSplines(modedata + jStart, freq_mode->data, freq_mode->length,
+        spline_amp, spline_phi, amp_pre, totaltwopishifttime, constphaseshift);
+      XLALDestroyREAL8Sequence(freq_mode);
     }
 
-    f = fmin(fHigh_geom_mode, (jStop-1)*deltaF_geom);
-    A = gsl_spline_eval(spline_amp, f, accel_amp);
-    phase = -gsl_spline_eval(spline_phi, f, accel_phi) + totaltwopishifttime * f + constphaseshift; /* Minus sign put here, in the internals of the ROM model \Psi = -phase */
-    modedata[jStop-1] = amp_pre * A * cexp(I*phase);
-
     /* Add the computed mode to the SphHarmFrequencySeries structure */
-    *hlmsphharmfreqseries = XLALSphHarmFrequencySeriesAddMode(*hlmsphharmfreqseries, mode, l, m);
+    *hlms = XLALSphHarmFrequencySeriesAddMode(*hlms, mode, l, m);
 
     /* Cleanup for the mode */
     gsl_spline_free(spline_amp);
     gsl_spline_free(spline_phi);
-    gsl_interp_accel_free(accel_amp);
-    gsl_interp_accel_free(accel_phi);
     gsl_vector_free(amp_f);
     gsl_vector_free(phi_f);
     gsl_vector_free(freq_ds);
@@ -499,6 +494,49 @@ static INT4 EOBNRv2HMROMCore(
   /* Cleanup of the coefficients data structure */
   EOBNRHMROMdata_coeff_Cleanup(data_coeff);
 
+  if(ret) XLAL_ERROR(XLAL_EFUNC);
+  return(XLAL_SUCCESS);
+}
+
+/*
+ * Core function for computing the ROM waveform.
+ * Combines the modes from EOBNRv2HMROMCoreModes() into hplus, hcross.
+*/
+static INT4 EOBNRv2HMROMCore(
+  COMPLEX16FrequencySeries **hptilde,
+  COMPLEX16FrequencySeries **hctilde,
+  REAL8 phiRef,
+  REAL8 deltaF,
+  REAL8 fLow,
+  REAL8 fHigh,
+  REAL8 fRef,
+  REAL8 distance,
+  REAL8 inclination,
+  REAL8 Mtot_sec,
+  REAL8 q)
+{
+  INT4 i;
+  INT4 j;
+  /* Check output arrays */
+  if(!hptilde || !hctilde) XLAL_ERROR(XLAL_EFAULT);
+  if(*hptilde || *hctilde)
+  {
+    XLALPrintError("(*hptilde) and (*hctilde) are supposed to be NULL, but got %p and %p\n",(*hptilde),(*hctilde));
+    XLAL_ERROR(XLAL_EFAULT);
+  }
+
+  /* Create spherical harmonic frequency series that will contain the hlm's */
+  SphHarmFrequencySeries** hlmsphharmfreqseries = XLALMalloc(sizeof(SphHarmFrequencySeries));
+  *hlmsphharmfreqseries = NULL;
+  if(EOBNRv2HMROMCoreModes(hlmsphharmfreqseries, phiRef, deltaF, fLow, fHigh, fRef, distance, Mtot_sec, q) != XLAL_SUCCESS) {
+    XLALDestroySphHarmFrequencySeries(*hlmsphharmfreqseries);
+    XLALFree(hlmsphharmfreqseries);
+    XLAL_ERROR(XLAL_EFUNC);
+  }
+  /* Metadata common to all modes */
+  size_t nbpt = (*hlmsphharmfreqseries)->mode->data->length;
+  LIGOTimeGPS tC = (*hlmsphharmfreqseries)->mode->epoch;
+
   /* Combining the modes for a hplus, hcross output */
   /* Initialize the complex series hplus, hcross */
   *hptilde = XLALCreateCOMPLEX16FrequencySeries("hptilde: FD waveform", &tC, 0.0, deltaF, &lalStrainUnit, nbpt);
@@ -512,16 +550,30 @@ static INT4 EOBNRv2HMROMCore(
   XLALUnitDivide(&(*hctilde)->sampleUnits, &(*hctilde)->sampleUnits, &lalSecondUnit);
 
   /* Adding the modes to form hplus, hcross
-   * - use of a function that copies XLALSimAddMode but for Fourier domain structures */
-  INT4 sym; /* sym will decide whether to add the -m mode (when equatorial symmetry is present) */
+   * - with the factors of FDAddMode, which copies XLALSimAddMode but for Fourier domain structures,
+   * but adding all the modes in a single pass over the frequencies */
+  COMPLEX16* modes[EOBNRV2_ROM_NUM_MODES_MAX];
+  COMPLEX16 factorp[EOBNRV2_ROM_NUM_MODES_MAX];
+  COMPLEX16 factorc[EOBNRV2_ROM_NUM_MODES_MAX];
   for( i=0; i<nbmode; i++){
     INT4 l = listmode[i][0];
     INT4 m = listmode[i][1];
     COMPLEX16FrequencySeries* mode = XLALSphHarmFrequencySeriesGetMode(*hlmsphharmfreqseries, l, m);
-    if ( m==0 ) sym = 0; /* We test for hypothetical m=0 modes */
-    else sym = 1;
-    FDAddMode( *hptilde, *hctilde, mode, inclination, 0., l, m, sym); /* The phase \Phi is set to 0 - assumes phiRef is defined as half the phase of the 22 mode h22 (or the first mode in the list), not for h = hplus-I hcross */
+    /* The phase \Phi is set to 0 - assumes phiRef is defined as half the phase of the 22 mode h22 (or the first mode in the list), not for h = hplus-I hcross */
+    COMPLEX16 Y = XLALSpinWeightedSphericalHarmonic(inclination, 0., -2, l, m);
+    modes[i] = mode->data->data;
+    if ( m==0 ) { /* We test for hypothetical m=0 modes: do not add in the -m mode */
+      factorp[i] = 1./2*Y;
+      factorc[i] = I/2*Y;
+    }
+    else { /* equatorial symmetry: add in -m mode */
+      COMPLEX16 Ymstar = conj(XLALSpinWeightedSphericalHarmonic(inclination, 0., -2, l, -m));
+      INT4 minus1l = l%2 ? -1 : 1;
+      factorp[i] = 1./2*(Y + minus1l*Ymstar);
+      factorc[i] = I/2*(Y - minus1l*Ymstar);
+    }
   }
+  ROM_CombineModesFD((*hptilde)->data->data, (*hctilde)->data->data, modes, factorp, factorc, nbmode, nbpt);
 
   /* Destroying the list of frequency series for the modes, including the COMPLEX16FrequencySeries that it contains */
   XLALDestroySphHarmFrequencySeries(*hlmsphharmfreqseries);
@@ -659,3 +711,65 @@ INT4 XLALSimIMREOBNRv2HMROM(
 
   return(retcode);
 }
+
+/* Compute the modes h_l-m, m > 0, in LAL format: in the LAL Fourier
+ * convention, for positive frequencies, with the phase set by phiRef as in
+ * the polarizations, which are recovered with the azimuthal angle 0.  The
+ * m > 0 modes follow from equatorial symmetry, h_lm(-f) = (-1)^l h*_l-m(f). */
+INT4 XLALSimIMREOBNRv2HMROMModes(
+  SphHarmFrequencySeries **hlm,                 /* Output: Frequency-domain modes */
+  REAL8 phiRef,                                 /* Half-phase of the 22 mode (~orbital phase) at reference frequency */
+  REAL8 deltaF,                                 /* Sampling frequency (Hz) */
+  REAL8 fLow,                                   /* Start frequency (Hz) - 0 defaults to the lowest Mf of the lowest m>=2 mode */
+  REAL8 fHigh,                                  /* End frequency (Hz) - 0 defaults to the highest Mf of the highest m mode */
+  REAL8 fRef,                                   /* Reference frequency (Hz); 0 defaults to fLow */
+  REAL8 distance,                               /* Distance of source (m) */
+  REAL8 m1SI,                                   /* Mass of companion 1 (kg) */
+  REAL8 m2SI)                                   /* Mass of companion 2 (kg) */
+{
+  if(!hlm) XLAL_ERROR(XLAL_EFAULT);
+  if(*hlm)
+  {
+    XLALPrintError("(*hlm) is supposed to be NULL, but got %p\n",(*hlm));
+    XLAL_ERROR(XLAL_EFAULT);
+  }
+
+  nbmode = EOBNRV2_ROM_NUM_MODES_MAX;
+
+  /* Get masses in terms of solar mass */
+  REAL8 mass1 = m1SI / LAL_MSUN_SI;
+  REAL8 mass2 = m2SI / LAL_MSUN_SI;
+  REAL8 Mtot = mass1 + mass2;
+  REAL8 q = fmax(mass1/mass2, mass2/mass1);    /* Mass-ratio >1 by convention*/
+  REAL8 Mtot_sec = Mtot * LAL_MTSUN_SI; /* Total mass in seconds */
+
+  if ( q > q_max ) {
+    XLALPrintError( "XLAL Error - %s: q out of range!\nEOBNRv2HMROM is only available for a mass ratio in the range q <= %g.\n", __func__, q_max);
+    XLAL_ERROR( XLAL_EDOM );
+  }
+
+  /* Set up (load and build interpolation) ROM data if not setup already */
+  EOBNRv2HMROM_Init_LALDATA();
+
+  SphHarmFrequencySeries *hlms_rom = NULL;
+  if(EOBNRv2HMROMCoreModes(&hlms_rom, phiRef, deltaF, fLow, fHigh, fRef, distance, Mtot_sec, q) != XLAL_SUCCESS) {
+    XLALDestroySphHarmFrequencySeries(hlms_rom);
+    XLAL_ERROR(XLAL_EFUNC);
+  }
+
+  /* Undo the ROM Fourier convention, as is done for the polarizations, and
+   * store the modes as their negative-m counterparts */
+  for( INT4 i=0; i<nbmode; i++){
+    INT4 l = listmode[i][0];
+    INT4 m = listmode[i][1];
+    COMPLEX16FrequencySeries *mode = XLALSphHarmFrequencySeriesGetMode(hlms_rom, l, m);
+    REAL8 minus1l = l % 2 ? -1. : 1.;
+    for ( UINT4 j = 0; j < mode->data->length; ++j )
+      mode->data->data[j] = minus1l * conj(mode->data->data[j]);
+    XLALUnitDivide(&mode->sampleUnits, &mode->sampleUnits, &lalSecondUnit);
+    *hlm = XLALSphHarmFrequencySeriesAddMode(*hlm, mode, l, -m);
+  }
+  XLALDestroySphHarmFrequencySeries(hlms_rom);
+
+  return(XLAL_SUCCESS);
+}
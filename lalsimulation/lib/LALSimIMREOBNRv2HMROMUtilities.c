@@ -124,7 +124,7 @@ static void EOBNRHMROMdata_interp_Cleanup(EOBNRHMROMdata_interp *data_interp);
 static void EOBNRHMROMdata_coeff_Cleanup(EOBNRHMROMdata_coeff *data_coeff);
 
 /* Function to add modes for frequency-domain structures */
-static INT4 FDAddMode(COMPLEX16FrequencySeries *hptilde, COMPLEX16FrequencySeries *hctilde, COMPLEX16FrequencySeries *hlmtilde, REAL8 theta, REAL8 phi, INT4 l, INT4 m, INT4 sym);
+UNUSED static INT4 FDAddMode(COMPLEX16FrequencySeries *hptilde, COMPLEX16FrequencySeries *hctilde, COMPLEX16FrequencySeries *hlmtilde, REAL8 theta, REAL8 phi, INT4 l, INT4 m, INT4 sym);
 
 /* Functions associated to list manipulations */
 static SplineList* SplineList_AddElementNoCopy(
@@ -52,12 +52,224 @@
 #include <lal/LALSimIMR.h>
 #include <lal/LALConfig.h>
 #include <lal/SphericalHarmonics.h>
+#include <lal/VectorMath.h>
 #include <lal/LALSimInspiralPrecess.h>
 
 #include <lal/H5FileIO.h>
 
 #include "LALSimIMRSEOBNRROMUtilities.c"
 
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
+
+/* Contribution to the polarisations, relative to that of the loudest mode,
+ * below which XLALSimInspiralNRWaveformGetHplusHcross() does not load a mode */
+#define NR_NEGLIGIBLE_MODE_FRACTION 1e-8
+
+#ifdef LAL_HDF5_ENABLED
+/* Compressed data of the groups read from the last NR file, so that
+ * consecutive injections of the same simulation do not read it again.
+ * The cache persists between calls, so it uses the standard allocator. */
+struct NRGroupData {
+  char name[32];
+  gsl_vector *knots;
+  gsl_vector *data;
+};
+
+static char *NRDataCacheFile = NULL;
+static struct NRGroupData *NRDataCache = NULL;
+static size_t NRDataCacheLength = 0;
+#ifdef LAL_PTHREAD_LOCK
+static pthread_mutex_t NRDataCacheLock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static void NRDataCacheClear(void)
+{
+  for (size_t i = 0; i < NRDataCacheLength; i++)
+  {
+    gsl_vector_free(NRDataCache[i].knots);
+    gsl_vector_free(NRDataCache[i].data);
+  }
+  free(NRDataCache);
+  free(NRDataCacheFile);
+  NRDataCache = NULL;
+  NRDataCacheFile = NULL;
+  NRDataCacheLength = 0;
+}
+
+static gsl_vector *NRVectorCopy(const gsl_vector *v)
+{
+  gsl_vector *copy = gsl_vector_alloc(v->size);
+  if (copy)
+    gsl_vector_memcpy(copy, v);
+  return copy;
+}
+
+/* Return copies of the knots and values of a compressed group of an NR
+ * file, reading the group only if it is not already cached */
+static int NRWaveformReadGroup(
+  gsl_vector **knots,                     /**< Returned knots of the group */
+  gsl_vector **data,                      /**< Returned values at the knots */
+  LALH5File* file,                        /**< Pointer to HDF5 file */
+  const char *fileName,                   /**< Name of the HDF5 file */
+  const char *groupName                   /**< Name of group in HDF file */
+  )
+{
+  int errnum = 0;
+  size_t i;
+
+  *knots = *data = NULL;
+  XLAL_CHECK(strlen(groupName) < sizeof(NRDataCache->name), XLAL_EINVAL, "Group name %s is too long", groupName);
+
+#ifdef LAL_PTHREAD_LOCK
+  (void) pthread_mutex_lock(&NRDataCacheLock);
+#endif
+
+  /* only the last simulation is kept */
+  if (!NRDataCacheFile || strcmp(NRDataCacheFile, fileName) != 0)
+  {
+    NRDataCacheClear();
+    NRDataCacheFile = malloc(strlen(fileName) + 1);
+    if (!NRDataCacheFile)
+    {
+      errnum = XLAL_ENOMEM;
+      goto unlock;
+    }
+    strcpy(NRDataCacheFile, fileName);
+  }
+
+  for (i = 0; i < NRDataCacheLength; i++)
+    if (strcmp(NRDataCache[i].name, groupName) == 0)
+      break;
+
+  if (i == NRDataCacheLength)
+  {
+    struct NRGroupData *cache;
+    gsl_vector *groupKnots = NULL, *groupData = NULL;
+    LALH5File *group = XLALH5GroupOpen(file, groupName);
+    if (!group)
+    {
+      errnum = XLAL_EIO;
+      goto unlock;
+    }
+    ReadHDF5RealVectorDataset(group, "X", &groupKnots);
+    ReadHDF5RealVectorDataset(group, "Y", &groupData);
+    XLALH5FileClose(group);
+    cache = realloc(NRDataCache, (NRDataCacheLength + 1) * sizeof(*NRDataCache));
+    if (!groupKnots || !groupData || !cache)
+    {
+      gsl_vector_free(groupKnots);
+      gsl_vector_free(groupData);
+      if (cache)
+        NRDataCache = cache;
+      errnum = cache ? XLAL_EIO : XLAL_ENOMEM;
+      goto unlock;
+    }
+    NRDataCache = cache;
+    strcpy(NRDataCache[i].name, groupName);
+    NRDataCache[i].knots = groupKnots;
+    NRDataCache[i].data = groupData;
+    NRDataCacheLength++;
+  }
+
+  *knots = NRVectorCopy(NRDataCache[i].knots);
+  *data = NRVectorCopy(NRDataCache[i].data);
+  if (!*knots || !*data)
+  {
+    gsl_vector_free(*knots);
+    gsl_vector_free(*data);
+    *knots = *data = NULL;
+    errnum = XLAL_ENOMEM;
+  }
+
+unlock:
+#ifdef LAL_PTHREAD_LOCK
+  (void) pthread_mutex_unlock(&NRDataCacheLock);
+#endif
+  if (errnum)
+    XLAL_ERROR(errnum, "Failed to read group %s of NR file %s", groupName, fileName);
+  return XLAL_SUCCESS;
+}
+
+/* Peak amplitude of a mode, from the knots of its compressed amplitude */
+static REAL8 NRWaveformGetModePeakAmplitude(
+  LALH5File* file,                        /**< Pointer to HDF5 file */
+  const char *fileName,                   /**< Name of the HDF5 file */
+  const char *ampKey                      /**< Name of the amplitude group */
+  )
+{
+  gsl_vector *knots, *data;
+  REAL8 peak;
+  XLAL_CHECK_REAL8(NRWaveformReadGroup(&knots, &data, file, fileName, ampKey) == XLAL_SUCCESS, XLAL_EFUNC);
+  peak = fmax(fabs(gsl_vector_max(data)), fabs(gsl_vector_min(data)));
+  gsl_vector_free(knots);
+  gsl_vector_free(data);
+  return peak;
+}
+
+/* Select the modes, among those of ModeArray (all modes if NULL), whose
+ * contribution to the polarisations in the direction (theta, psi) is not
+ * negligible */
+static int NRWaveformSelectModes(
+  LALValue **activeModes,                 /**< Returned selected modes */
+  LALH5File* file,                        /**< Pointer to HDF5 file */
+  const char *fileName,                   /**< Name of the HDF5 file */
+  REAL8 theta,                            /**< Inclination in the NR frame */
+  REAL8 psi,                              /**< Azimuth in the NR frame */
+  LALValue *ModeArray                     /**< Modes to choose from, or NULL */
+  )
+{
+  char amp_key[30];
+  char phase_key[30];
+  INT4 NRLmax, model, modem;
+  REAL8 *weight, maxWeight = 0;
+
+  XLALH5FileQueryScalarAttributeValue(&NRLmax, file, "Lmax");
+  weight = XLALCalloc((NRLmax + 1) * (NRLmax + 1), sizeof(*weight));
+  XLAL_CHECK(weight != NULL, XLAL_ENOMEM);
+
+  for (model=2; model < (NRLmax + 1) ; model++)
+  {
+    for (modem=-model; modem < (model+1); modem++)
+    {
+      REAL8 peak;
+      if (ModeArray && XLALSimInspiralModeArrayIsModeActive(ModeArray, model, modem) != 1)
+        continue;
+      snprintf(amp_key, sizeof(amp_key), "amp_l%d_m%d", model, modem);
+      snprintf(phase_key, sizeof(phase_key), "phase_l%d_m%d", model, modem);
+      if (XLALH5FileCheckGroupExists(file, amp_key) == 0 || XLALH5FileCheckGroupExists(file, phase_key) == 0)
+        continue;
+      peak = NRWaveformGetModePeakAmplitude(file, fileName, amp_key);
+      if (XLAL_IS_REAL8_FAIL_NAN(peak))
+      {
+        XLALFree(weight);
+        XLAL_ERROR(XLAL_EFUNC);
+      }
+      weight[model * model + model + modem] = peak * cabs(XLALSpinWeightedSphericalHarmonic(theta, psi, -2, model, modem));
+      maxWeight = fmax(maxWeight, weight[model * model + model + modem]);
+    }
+  }
+
+  *activeModes = XLALSimInspiralCreateModeArray();
+  for (model=2; model < (NRLmax + 1) ; model++)
+  {
+    for (modem=-model; modem < (model+1); modem++)
+    {
+      if (ModeArray && XLALSimInspiralModeArrayIsModeActive(ModeArray, model, modem) != 1)
+        continue;
+      if (weight[model * model + model + modem] >= NR_NEGLIGIBLE_MODE_FRACTION * maxWeight)
+        XLALSimInspiralModeArrayActivateMode(*activeModes, model, modem);
+      else
+        XLAL_PRINT_INFO("mode model = %i modem = %i is negligible at this inclination\n", model, modem);
+    }
+  }
+
+  XLALFree(weight);
+  return XLAL_SUCCESS;
+}
+#endif
+
 UNUSED static REAL8 XLALSimInspiralNRWaveformCheckFRef(
   UNUSED LALH5File* file,
   UNUSED REAL8 fRef
@@ -291,6 +503,7 @@ UNUSED static UINT4 XLALSimInspiralNRWaveformGetSpinsFromHDF5FilePointer(
 UNUSED static UINT4 XLALSimInspiralNRWaveformGetDataFromHDF5File(
   UNUSED REAL8Vector** output,            /**< Returned vector uncompressed */
   UNUSED LALH5File* pointer,              /**< Pointer to HDF5 file */
+  UNUSED const char *fileName,            /**< Name of the HDF5 file */
   UNUSED REAL8 totalMass,                 /**< Total mass of system for scaling */
   UNUSED REAL8 startTime,                 /**< Start time of veturn vector */
   UNUSED size_t length,                   /**< Length of returned vector */
@@ -307,12 +520,8 @@ UNUSED static UINT4 XLALSimInspiralNRWaveformGetDataFromHDF5File(
   gsl_interp_accel *acc;
   gsl_spline *spline;
   gsl_vector *knotsVector, *dataVector;
-  LALH5File *group = XLALH5GroupOpen(pointer, keyName);
-  knotsVector=dataVector=NULL;
 
-  ReadHDF5RealVectorDataset(group, "X", &knotsVector);
-  ReadHDF5RealVectorDataset(group, "Y", &dataVector);
-  XLALH5FileClose(group);
+  XLAL_CHECK(NRWaveformReadGroup(&knotsVector, &dataVector, pointer, fileName, keyName) == XLAL_SUCCESS, XLAL_EFUNC);
 
   *output = XLALCreateREAL8Vector(length);
 
@@ -656,6 +865,7 @@ UNUSED static INT4 XLALSimIMRNRWaveformGetModes(
         UNUSED REAL8 s2y,                      /**< initial value of S2y */
         UNUSED REAL8 s2z,                      /**< initial value of S2z */
         UNUSED LALH5File* file,                /**< pointer to location of NR HDF file */
+        UNUSED const char *NRDataFile,         /**< Location of NR HDF file */
         UNUSED LALValue* ModeArray             /**< Container for the ell and m modes to generate. To generate all available modes pass NULL */
         )
 {
@@ -678,10 +888,10 @@ UNUSED static INT4 XLALSimIMRNRWaveformGetModes(
    * characters */
   char amp_key[30];
   char phase_key[30];
-  gsl_vector *tmpVector=NULL;
-  LALH5File *group;
+  gsl_vector *tmpVector=NULL, *tmpData=NULL;
   LIGOTimeGPS tmpEpoch = LIGOTIMEGPSZERO;
   REAL8Vector *curr_amp, *curr_phase;
+  REAL8 *sin_phase, *cos_phase;
 
   /* Sanity checks on physical parameters passed to waveform
    * generator to guarantee consistency with NR data file.
@@ -738,12 +948,11 @@ UNUSED static INT4 XLALSimIMRNRWaveformGetModes(
 
   XLALH5FileQueryScalarAttributeValue(&Mflower, file, "f_lower_at_1MSUN");
   /* Figure out start time of data */
-  group = XLALH5GroupOpen(file, "amp_l2_m2");
-  ReadHDF5RealVectorDataset(group, "X", &tmpVector);
-  XLALH5FileClose(group);
+  XLAL_CHECK(NRWaveformReadGroup(&tmpVector, &tmpData, file, NRDataFile, "amp_l2_m2") == XLAL_SUCCESS, XLAL_EFUNC);
   time_start_M = (REAL8)(gsl_vector_get(tmpVector, 0));
   time_end_M = (REAL8)(gsl_vector_get(tmpVector, tmpVector->size - 1));
   gsl_vector_free(tmpVector);
+  gsl_vector_free(tmpData);
   time_start_s = time_start_M * (m1 + m2) * LAL_MTSUN_SI;
   time_end_s = time_end_M * (m1 + m2) * LAL_MTSUN_SI;
 
@@ -828,6 +1037,9 @@ UNUSED static INT4 XLALSimIMRNRWaveformGetModes(
   /* else Use the ModeArray given */
   hlm=XLALCreateCOMPLEX16TimeSeries("hlm",&tmpEpoch,0.0,deltaT,&lalStrainUnit,array_length);
   memset(hlm->data->data, 0, array_length * sizeof(COMPLEX16));
+  sin_phase = XLALMalloc(array_length * sizeof(*sin_phase));
+  cos_phase = XLALMalloc(array_length * sizeof(*cos_phase));
+  XLAL_CHECK(hlm && sin_phase && cos_phase, XLAL_ENOMEM);
 
   for (model=2; model < (NRLmax + 1) ; model++)
   {
@@ -857,14 +1069,15 @@ UNUSED static INT4 XLALSimIMRNRWaveformGetModes(
       }
 
       /* Get amplitude and phase from file */
-      XLALSimInspiralNRWaveformGetDataFromHDF5File(&curr_amp, file, (m1 + m2),
-                                  time_start_s, array_length, deltaT, amp_key);
-      XLALSimInspiralNRWaveformGetDataFromHDF5File(&curr_phase, file, (m1 + m2),
-                                time_start_s, array_length, deltaT, phase_key);
+      XLAL_CHECK(XLALSimInspiralNRWaveformGetDataFromHDF5File(&curr_amp, file, NRDataFile, (m1 + m2),
+                                  time_start_s, array_length, deltaT, amp_key) == XLAL_SUCCESS, XLAL_EFUNC);
+      XLAL_CHECK(XLALSimInspiralNRWaveformGetDataFromHDF5File(&curr_phase, file, NRDataFile, (m1 + m2),
+                                time_start_s, array_length, deltaT, phase_key) == XLAL_SUCCESS, XLAL_EFUNC);
 
+      XLAL_CHECK(XLALVectorSinCosREAL8(sin_phase, cos_phase, curr_phase->data, array_length) == XLAL_SUCCESS, XLAL_EFUNC);
       for (curr_idx = 0; curr_idx < array_length; curr_idx++)
       {
-	hlm->data->data[curr_idx]= (curr_amp->data[curr_idx]*cos(curr_phase->data[curr_idx]) + I*curr_amp->data[curr_idx]*sin(curr_phase->data[curr_idx]) ) * distance_scale_fac;
+	hlm->data->data[curr_idx]= (curr_amp->data[curr_idx]*cos_phase[curr_idx] + I*curr_amp->data[curr_idx]*sin_phase[curr_idx] ) * distance_scale_fac;
       }
       /* Note that the hlm built here do not respect the LAL convention
        * the function XLALSimIMRNRWaveformGetHlm will perform the pi/2 rotation
@@ -877,6 +1090,8 @@ UNUSED static INT4 XLALSimIMRNRWaveformGetModes(
     }
   }
   XLALDestroyCOMPLEX16TimeSeries(hlm);
+  XLALFree(sin_phase);
+  XLALFree(cos_phase);
   if (modearray_needs_destroying)
     XLALDestroyValue(ModeArray);
 
@@ -946,19 +1161,29 @@ INT4 XLALSimInspiralNRWaveformGetHplusHcross(
     XLALPrintInfo("This NR file is format %d. Only formats 2 and above support the use of reference frequency. For formats < 2 the reference frequency always corresponds to the start of the waveform.", nr_file_format);
     fRef_pass = -1;
   }
-  INT4 err_code = XLALSimIMRNRWaveformGetModes(&tmp_Hlms,&tmpEpoch,&array_length, \
-                                               deltaT, m1, m2, r, fStart, fRef_pass, \
-                                               s1x,s1y,s1z,s2x,s2y,s2z, \
-                                               file, ModeArray);
-  if (err_code!=XLAL_SUCCESS)
-    XLAL_ERROR(XLAL_FAILURE);
-
   /* Compute correct angles for hplus and hcross following LAL convention. */
 
   theta = psi = calpha = salpha = 0.;
   XLALSimInspiralNRWaveformGetRotationAnglesFromH5File(&theta, &psi, &calpha,
                        &salpha, file, inclination, phiRef, fRef_pass*(m1+m2));
+
+  /* Only generate the modes which contribute to the polarisations in this
+   * direction: for a face-on source, for instance, only the m = 2 modes. */
+  LALValue *activeModes = NULL;
+  if (NRWaveformSelectModes(&activeModes, file, NRDataFile, theta, psi, ModeArray) != XLAL_SUCCESS)
+  {
+    XLALH5FileClose(file);
+    XLAL_ERROR(XLAL_EFUNC);
+  }
+
+  INT4 err_code = XLALSimIMRNRWaveformGetModes(&tmp_Hlms,&tmpEpoch,&array_length, \
+                                               deltaT, m1, m2, r, fStart, fRef_pass, \
+                                               s1x,s1y,s1z,s2x,s2y,s2z, \
+                                               file, NRDataFile, activeModes);
+  XLALDestroyValue(activeModes);
   XLALH5FileClose(file);
+  if (err_code!=XLAL_SUCCESS)
+    XLAL_ERROR(XLAL_FAILURE);
 
   *hplus  = XLALCreateREAL8TimeSeries("H_PLUS", &tmpEpoch, 0.0, deltaT,
                                       &lalStrainUnit, array_length );
@@ -1073,7 +1298,7 @@ INT4 XLALSimInspiralNRWaveformGetHlms(UNUSED SphHarmTimeSeries **Hlms, /**< OUTP
   INT4 err_code = XLALSimIMRNRWaveformGetModes(&tmp_Hlms,&tmpEpoch,&array_length, \
                                                deltaT, m1, m2, r, fStart, fRef_pass, \
                                                s1x,s1y,s1z,s2x,s2y,s2z, \
-                                               file, ModeArray);
+                                               file, NRDataFile, ModeArray);
   if (err_code!=XLAL_SUCCESS)
     XLAL_ERROR(XLAL_FAILURE);
 
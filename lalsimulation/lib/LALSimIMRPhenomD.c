@@ -28,10 +28,35 @@
 
 UsefulPowers powers_of_pi;	// declared in LALSimIMRPhenomD_internals.c
 
+#include <lal/LALConfig.h>
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+static pthread_once_t powers_of_pi_is_initialized = PTHREAD_ONCE_INIT;
+#endif
+
 #ifndef _OPENMP
 #define omp ignore
 #endif
 
+static void init_powers_of_pi_once(void)
+{
+  init_useful_powers(&powers_of_pi, LAL_PI);
+}
+
+/**
+ * Sets up powers_of_pi.  It is set up only once, so that waveforms using it
+ * can be generated concurrently from several threads.
+ */
+int IMRPhenomD_init_powers_of_pi(void)
+{
+#ifdef LAL_PTHREAD_LOCK
+  (void) pthread_once(&powers_of_pi_is_initialized, init_powers_of_pi_once);
+#else
+  init_powers_of_pi_once();
+#endif
+  return XLAL_SUCCESS;
+}
+
 /*
  * private function prototypes; all internal functions use solar masses.
  *
@@ -308,7 +333,7 @@ static int IMRPhenomDGenerateFD(
      }
   }
 
-  int status = init_useful_powers(&powers_of_pi, LAL_PI);
+  int status = IMRPhenomD_init_powers_of_pi();
   XLAL_CHECK(XLAL_SUCCESS == status, status, "Failed to initiate useful powers of pi.");
 
   /* Find frequency bounds */
@@ -630,7 +655,7 @@ double XLALSimIMRPhenomDChirpTime(
         XLAL_PRINT_WARNING("Starting frequency = %f Hz is higher IMRPhenomD peak frequency %f Hz. Results may be unreliable.", fHzSt, fHzPeak);
     }
 
-    int status = init_useful_powers(&powers_of_pi, LAL_PI);
+    int status = IMRPhenomD_init_powers_of_pi();
     XLAL_CHECK(XLAL_SUCCESS == status, status, "Failed to initiate useful powers of pi.");
 
     const REAL8 M = m1 + m2;
@@ -839,7 +864,7 @@ int IMRPhenomDAmpFrequencySequence(
      * powers_of_pi.
      */
   retcode = 0;
-  retcode = init_useful_powers(&powers_of_pi, LAL_PI);
+  retcode = IMRPhenomD_init_powers_of_pi();
   XLAL_CHECK(XLAL_SUCCESS == retcode, retcode, "Failed to initiate useful powers of pi.");
 
   PhenomInternal_PrecessingSpinEnforcePrimaryIsm1(&m1, &m2, &chi1x, &chi1y, &chi1z, &chi2x, &chi2y, &chi2z);
@@ -964,7 +989,7 @@ int IMRPhenomDSetupAmpAndPhaseCoefficients(
      * powers_of_pi.
      */
   int retcode = 0;
-  retcode = init_useful_powers(&powers_of_pi, LAL_PI);
+  retcode = IMRPhenomD_init_powers_of_pi();
   XLAL_CHECK(XLAL_SUCCESS == retcode, retcode, "Failed to initiate useful powers of pi.");
 
   PhenomInternal_PrecessingSpinEnforcePrimaryIsm1(&m1, &m2, &chi1x, &chi1y, &chi1z, &chi2x, &chi2y, &chi2z);
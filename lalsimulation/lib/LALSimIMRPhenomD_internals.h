@@ -266,12 +266,18 @@ static int init_useful_powers(UsefulPowers * p, REAL8 number);
 
 /**
  * useful powers of LAL_PI, calculated once and kept constant - to be initied with a call to
- * init_useful_powers(&powers_of_pi, LAL_PI);
+ * IMRPhenomD_init_powers_of_pi();
  *
  * only declared here, defined in LALSIMIMRPhenomD.c (because this c file is "included" like an h file)
  */
 extern UsefulPowers powers_of_pi;
 
+/**
+ * sets up powers_of_pi once, safely when called concurrently;
+ * defined in LALSimIMRPhenomD.c
+ */
+int IMRPhenomD_init_powers_of_pi(void);
+
 /**
  * used to cache the recurring (frequency-independent) prefactors of AmpInsAnsatz. Must be inited with a call to
  * init_amp_ins_prefactors(&prefactors, p);
@@ -1049,8 +1049,8 @@ int IMRPhenomHMCore(
 
     /* compute the frequency bounds */
     const REAL8 Mtot = (m1_SI + m2_SI) / LAL_MSUN_SI;
-    PhenomHMFrequencyBoundsStorage *pHMFS;
-    pHMFS = XLALMalloc(sizeof(PhenomHMFrequencyBoundsStorage));
+    PhenomHMFrequencyBoundsStorage pHMFSStorage;
+    PhenomHMFrequencyBoundsStorage *pHMFS = &pHMFSStorage;
     retcode = 0;
     retcode = init_IMRPhenomHMGet_FrequencyBounds_storage(
         pHMFS,
@@ -1149,7 +1149,6 @@ tried to apply shift of -1.0/deltaF with deltaF=%g.",
 
     /* cleanup */
     XLALDestroyValue(ModeArray);
-    LALFree(pHMFS);
 
     XLALDestroyDict(extraParams_aux);
 
@@ -1220,8 +1219,9 @@ positive.\n");
 
     /* setup PhenomHM model storage struct / structs */
     /* Compute quantities/parameters related to PhenomD only once and store them */
-    PhenomHMStorage *pHM;
-    pHM = XLALMalloc(sizeof(PhenomHMStorage));
+    /* The storage is local to this call, so that concurrent calls do not share it */
+    PhenomHMStorage pHMStorage;
+    PhenomHMStorage *pHM = &pHMStorage;
     retcode = 0;
     retcode = init_PhenomHM_Storage(
         pHM,
@@ -1378,8 +1378,6 @@ tried to apply shift of -1.0/deltaF with deltaF=%g.",
         XLAL_ERROR(XLAL_EDOM, "freq_is_uniform = %i and should be either 0 or 1.", pHM->freq_is_uniform);
     }
 
-    LALFree(pHM);
-
     XLALDestroyDict(extraParams_aux);
 
     return XLAL_SUCCESS;
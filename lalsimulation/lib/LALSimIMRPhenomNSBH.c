@@ -168,7 +168,7 @@ int IMRPhenomNSBH_Core(
     XLALUnitMultiply(&((*htilde)->sampleUnits), &((*htilde)->sampleUnits), &lalSecondUnit);
 
     // compute phenomD phase
-    int errcode = init_useful_powers(&powers_of_pi, LAL_PI);
+    int errcode = IMRPhenomD_init_powers_of_pi();
     XLAL_CHECK(XLAL_SUCCESS == errcode, errcode, "init_useful_powers() failed.");
 
     // IMRPhenomD assumes that m1 >= m2.
@@ -679,7 +679,7 @@ static int PhenomPCore(
     quadparam2 = quadparam1_in;
   }
 
-  errcode = init_useful_powers(&powers_of_pi, LAL_PI);
+  errcode = IMRPhenomD_init_powers_of_pi();
   XLAL_CHECK(XLAL_SUCCESS == errcode, errcode, "init_useful_powers() failed.");
 
   /* Find frequency bounds */
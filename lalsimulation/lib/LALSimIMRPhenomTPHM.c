@@ -389,12 +389,7 @@ int XLALSimIMRPhenomTPHM_L0Modes(
   gammaJtoI = (gammaTS)->data->data[length1];
 
   // Perform global rotation from J frame to L0 frame
-  PhenomT_precomputed_sqrt *SQRT;
-  SQRT  = XLALMalloc(sizeof(PhenomT_precomputed_sqrt));
-  IMRPhenomTPHM_SetPrecomputedSqrt(SQRT);
-
-  size_t length = (*hlmI)->mode->data->length;
-  status = PhenomTPHM_RotateModes_Global(*hlmI, -alphaJtoI, cosbetaJtoI, -gammaJtoI, length, SQRT);
+  status = PhenomTPHM_RotateModes_Global(*hlmI, -alphaJtoI, cosbetaJtoI, -gammaJtoI);
   XLAL_CHECK(XLAL_SUCCESS == status, XLAL_EFUNC, "Error: Internal function PhenomTPHM_RotateModes_Global has failed.");
 
   // Destroy time series
@@ -405,7 +400,6 @@ int XLALSimIMRPhenomTPHM_L0Modes(
   // Free structs
   LALFree(pWF);
   LALFree(pPhase);
-  LALFree(SQRT);
 
   return status;
 }
@@ -449,16 +443,9 @@ int XLALSimIMRPhenomTPHM_JModes(
   XLAL_CHECK(XLAL_SUCCESS == status, XLAL_EFUNC, "Error: function XLALSimIMRPhenomTPHM_JModes has failed.");
 
   /* Rotate coprecessing modes to J frame */
-
-  PhenomT_precomputed_sqrt *SQRT;
-  SQRT  = XLALMalloc(sizeof(PhenomT_precomputed_sqrt));
-  IMRPhenomTPHM_SetPrecomputedSqrt(SQRT);
-  
-  status = PhenomTPHM_RotateModes(*hlmJ, *gammaTS, *cosbetaTS, *alphaTS, SQRT);
+  status = PhenomTPHM_RotateModes(*hlmJ, *gammaTS, *cosbetaTS, *alphaTS);
   XLAL_CHECK(XLAL_SUCCESS == status, XLAL_EFUNC, "Error: Internal function PhenomTPHM_RotateModes has failed.");
   
-  LALFree(SQRT);
-  
   return status;
 }
 
@@ -33,6 +33,7 @@
 #include <lal/TimeFreqFFT.h>
 #include <lal/SphericalHarmonics.h>
 #include <lal/FrequencySeries.h>
+#include <lal/VectorMath.h>
 
 /* LALSimulation */
 #include <lal/LALSimIMR.h>
@@ -594,65 +595,85 @@ int IMRPhenomXASGenerateFD(
 
   REAL8 Amp0      = pWF->amp0 * pWF->ampNorm;
 
-  /* initial_status used to track  */
-  UINT4 initial_status = XLAL_SUCCESS;
+  /*
+      Now loop over main driver to generate waveform:  h(f) = A(f) * Exp[I phi(f)]
 
-  /* Now loop over main driver to generate waveform:  h(f) = A(f) * Exp[I phi(f)] */
+      The frequencies are taken in blocks: the powers of Mf and the complex exponentials
+      are evaluated a block at a time with the SIMD VectorMath functions, while the
+      amplitude and phase ansatze are evaluated per frequency.
+  */
   #pragma omp parallel for
-  for (UINT4 idx = 0; idx < freqs->length; idx++)
+  for (UINT4 start = 0; start < freqs->length; start += IMRPHENOMX_POWERS_BLOCK)
   {
-    double Mf    = Msec * freqs->data[idx];   // Mf is declared locally inside the loop
-    UINT4 jdx    = idx  + offset;             // jdx is declared locally inside the loop
-
-    /* Initialize a struct containing useful powers of Mf */
-    IMRPhenomX_UsefulPowers powers_of_Mf;
-    initial_status     = IMRPhenomX_Initialize_Powers(&powers_of_Mf,Mf);
-    if(initial_status != XLAL_SUCCESS)
+    const UINT4 nblock = freqs->length - start < IMRPHENOMX_POWERS_BLOCK ? freqs->length - start : IMRPHENOMX_POWERS_BLOCK;
+    IMRPhenomX_UsefulPowers powers_of_Mf[IMRPHENOMX_POWERS_BLOCK];
+    REAL8 Mf[IMRPHENOMX_POWERS_BLOCK];
+    REAL8 amp[IMRPHENOMX_POWERS_BLOCK];
+    REAL8 phi[IMRPHENOMX_POWERS_BLOCK];
+    REAL8 sinphi[IMRPHENOMX_POWERS_BLOCK];
+    REAL8 cosphi[IMRPHENOMX_POWERS_BLOCK];
+
+    for (UINT4 k = 0; k < nblock; k++)
     {
-      status = initial_status;
-      XLALPrintError("IMRPhenomX_Initialize_Powers failed for Mf, initial_status=%d",initial_status);
+      Mf[k] = Msec * freqs->data[start + k];
     }
-    else
+
+    /* Initialize structs containing useful powers of Mf */
+    INT4 block_status = IMRPhenomX_Initialize_Powers_Block(powers_of_Mf, Mf, nblock);
+    if(block_status != XLAL_SUCCESS)
     {
-      /* Generate amplitude and phase at MfRef */
-      REAL8 amp = 0.0;
-      REAL8 phi = 0.0;
+      status = block_status;
+      XLALPrintError("IMRPhenomX_Initialize_Powers_Block failed for Mf, initial_status=%d",block_status);
+      continue;
+    }
 
+    for (UINT4 k = 0; k < nblock; k++)
+    {
       /* The functions in this routine are inlined to help performance. */
       /* Construct phase */
-      if(Mf < fPhaseIN)
+      if(Mf[k] < fPhaseIN)
       {
-        phi = IMRPhenomX_Inspiral_Phase_22_AnsatzInt(Mf, &powers_of_Mf, pPhase22);
+        phi[k] = IMRPhenomX_Inspiral_Phase_22_AnsatzInt(Mf[k], &powers_of_Mf[k], pPhase22);
       }
-      else if(Mf > fPhaseIM)
+      else if(Mf[k] > fPhaseIM)
       {
-        phi = IMRPhenomX_Ringdown_Phase_22_AnsatzInt(Mf, &powers_of_Mf, pWF, pPhase22) + C1RD + (C2RD * Mf);
+        phi[k] = IMRPhenomX_Ringdown_Phase_22_AnsatzInt(Mf[k], &powers_of_Mf[k], pWF, pPhase22) + C1RD + (C2RD * Mf[k]);
       }
       else
       {
-        phi = IMRPhenomX_Intermediate_Phase_22_AnsatzInt(Mf, &powers_of_Mf, pWF, pPhase22) + C1IM + (C2IM * Mf);
+        phi[k] = IMRPhenomX_Intermediate_Phase_22_AnsatzInt(Mf[k], &powers_of_Mf[k], pWF, pPhase22) + C1IM + (C2IM * Mf[k]);
       }
 
-	  /* Scale phase by 1/eta */
-	  phi  *= inveta;
-      phi  += linb*Mf + lina + pWF->phifRef;
+      /* Scale phase by 1/eta */
+      phi[k]  *= inveta;
+      phi[k]  += linb*Mf[k] + lina + pWF->phifRef;
 
-	  /* Construct amplitude */
-	  if(Mf < fAmpIN)
-	  {
-		  amp = IMRPhenomX_Inspiral_Amp_22_Ansatz(Mf, &powers_of_Mf, pWF, pAmp22);
-	  }
-	  else if(Mf > fAmpIM)
-	  {
-		  amp = IMRPhenomX_Ringdown_Amp_22_Ansatz(Mf, pWF, pAmp22);
-	  }
-	  else
-	  {
-        amp = IMRPhenomX_Intermediate_Amp_22_Ansatz(Mf, &powers_of_Mf, pWF, pAmp22);
+      /* Construct amplitude */
+      if(Mf[k] < fAmpIN)
+      {
+        amp[k] = IMRPhenomX_Inspiral_Amp_22_Ansatz(Mf[k], &powers_of_Mf[k], pWF, pAmp22);
       }
+      else if(Mf[k] > fAmpIM)
+      {
+        amp[k] = IMRPhenomX_Ringdown_Amp_22_Ansatz(Mf[k], pWF, pAmp22);
+      }
+      else
+      {
+        amp[k] = IMRPhenomX_Intermediate_Amp_22_Ansatz(Mf[k], &powers_of_Mf[k], pWF, pAmp22);
+      }
+      amp[k] *= Amp0 * powers_of_Mf[k].m_seven_sixths;
+    }
 
-	  /* Reconstruct waveform: h(f) = A(f) * Exp[I phi(f)] */
-      ((*htilde22)->data->data)[jdx] = Amp0 * powers_of_Mf.m_seven_sixths * amp * cexp(I * phi);
+    /* Reconstruct waveform: h(f) = A(f) * Exp[I phi(f)] */
+    if(XLALVectorSinCosREAL8(sinphi, cosphi, phi, nblock) != XLAL_SUCCESS)
+    {
+      status = XLAL_EFUNC;
+      XLALPrintError("XLALVectorSinCosREAL8 failed for the phase");
+      continue;
+    }
+    for (UINT4 k = 0; k < nblock; k++)
+    {
+      ((*htilde22)->data->data)[start + k + offset] = amp[k] * (cosphi[k] + I * sinphi[k]);
     }
   }
 
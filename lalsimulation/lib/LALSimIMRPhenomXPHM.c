@@ -78,6 +78,21 @@ static int IMRPhenomXPHMTwistUpOneMode(
 );
 
 
+/* Exponentials of the Euler angles of one mode, multibanded and interpolated to the fine frequency grid */
+static int IMRPhenomXPHM_MultibandAngles(
+  COMPLEX16 **cexp_i_alpha_out,
+  COMPLEX16 **cexp_i_epsilon_out,
+  COMPLEX16 **cexp_i_betah_out,
+  UINT4 *length,
+  UINT4 ell,
+  UINT4 emmprime,
+  UINT4 offset,
+  IMRPhenomXWaveformStruct *pWF,
+  IMRPhenomXPrecessionStruct *pPrec,
+  LALDict *lalParams
+);
+
+
 //This is a wrapper function for adding higher modes to the ModeArray
 LALDict *IMRPhenomXPHM_setup_mode_array(LALDict *lalParams);
 
@@ -951,166 +966,11 @@ int XLALSimIMRPhenomXPHMFromModes(
          printf("\n****************************************************************\n");
          #endif
 
-
-
-         /* Compute non-uniform coarse frequency grid as 1D array */
-         REAL8Sequence *coarseFreqs;
-         XLALSimIMRPhenomXPHMMultibandingGrid(&coarseFreqs, ell, emmprime, pWF, lalParams);
-
-         UINT4 lenCoarseArray = coarseFreqs->length;
-
-         /* Euler angles */
-         REAL8 alpha        = 0.0;
-         REAL8 epsilon      = 0.0;
-
-         REAL8 cBetah       = 0.0;
-         REAL8 sBetah       = 0.0;
-
-         /* Variables to store the Euler angles in the coarse frequency grid. */
-         REAL8 *valpha      = (REAL8*)XLALMalloc(lenCoarseArray * sizeof(REAL8));
-         REAL8 *vepsilon    = (REAL8*)XLALMalloc(lenCoarseArray * sizeof(REAL8));
-         REAL8 *vbetah      = (REAL8*)XLALMalloc(lenCoarseArray * sizeof(REAL8));
-
-         switch(pPrec->IMRPhenomXPrecVersion)
-         {
-           case 101:
-           case 102:
-           case 103:
-           case 104:
-           {
-             /* Use NNLO PN Euler angles */
-             /* Evaluate angles in coarse freq grid */
-             for(UINT4 j=0; j<lenCoarseArray; j++)
-             {
-               REAL8 Mf = coarseFreqs->data[j];
-
-               /* This function already add the offsets to the angles. */
-               Get_alpha_beta_epsilon(&alpha, &cBetah, &sBetah, &epsilon, emmprime, Mf, pPrec, pWF);
-
-               valpha[j]   = alpha;
-               vepsilon[j] = epsilon;
-               vbetah[j]   = acos(cBetah);
-             }
-             break;
-           }
-           case 220:
-           case 221:
-           case 222:
-           case 223:
-           case 224:
-           {
-             /* Use MSA Euler angles. */
-             /* Evaluate angles in coarse freq grid */
-             for(UINT4 j=0; j<lenCoarseArray; j++)
-             {
-               /* Get Euler angles. */
-               REAL8 Mf = coarseFreqs->data[j];
-               const REAL8 v        = cbrt (LAL_PI * Mf * (2.0 / emmprime) );
-               const vector vangles = IMRPhenomX_Return_phi_zeta_costhetaL_MSA(v,pWF,pPrec);
-               REAL8 cos_beta  = 0.0;
-
-               /* Get the offset for the Euler angles alpha and epsilon. */
-               REAL8 alpha_offset_mprime = 0, epsilon_offset_mprime = 0;
-               Get_alpha_epsilon_offset(&alpha_offset_mprime, &epsilon_offset_mprime, emmprime, pPrec);
-
-               valpha[j]   = vangles.x - alpha_offset_mprime;
-               vepsilon[j] = vangles.y - epsilon_offset_mprime;
-               cos_beta    = vangles.z;
-
-               status = IMRPhenomXWignerdCoefficients_cosbeta(&cBetah, &sBetah, cos_beta);
-               XLAL_CHECK(status == XLAL_SUCCESS, XLAL_EFUNC, "Call to IMRPhenomXWignerdCoefficients_cosbeta failed.");
-
-               vbetah[j]   = acos(cBetah);
-             }
-             break;
-           }
-           default:
-           {
-             XLAL_ERROR(XLAL_EINVAL,"Error: IMRPhenomXPrecVersion not recognized. Recommended default is 223.\n");
-             break;
-           }
-         }
-
-         /*
-            We have the three Euler angles evaluated in the coarse frequency grid.
-            Now we have to carry out the iterative linear interpolation for the complex exponential of each Euler angle. This follows the procedure of eq. 2.32 in arXiv:2001.10897..
-            The result will be three arrays of complex exponential evaluated in the finefreqs.
-         */
-         UINT4 fine_count = 0, ratio;
-         REAL8 Omega_alpha, Omega_epsilon, Omega_betah, Qalpha, Qepsilon, Qbetah;
-         REAL8 Mfhere, Mfnext, evaldMf;
-         Mfnext = coarseFreqs->data[0];
-         evaldMf = XLALSimIMRPhenomXUtilsHztoMf(pWF->deltaF, pWF->Mtot);
-
-         /*
-            Number of points where the waveform will be computed.
-            It is the same for all the modes and could be computed outside the loop, it is here for clarity since it is not used anywhere else.
-         */
-         size_t iStop  = (size_t) (pWF->f_max_prime / pWF->deltaF) + 1 - offset;
-
-         UINT4 length_fine_grid = iStop + 3; // This is just to reserve memory, add 3 points of buffer.
-
-         COMPLEX16 *cexp_i_alpha   = (COMPLEX16*)XLALMalloc(length_fine_grid * sizeof(COMPLEX16));
-         COMPLEX16 *cexp_i_epsilon = (COMPLEX16*)XLALMalloc(length_fine_grid * sizeof(COMPLEX16));
-         COMPLEX16 *cexp_i_betah   = (COMPLEX16*)XLALMalloc(length_fine_grid * sizeof(COMPLEX16));
-
-         #if DEBUG == 1
-         printf("\n\nLENGTHS fine grid estimate, coarseFreqs->length = %i %i\n", length_fine_grid, lenCoarseArray);
-         printf("fine_count, htildelm->length, offset = %i %i %i\n", fine_count, htildelm->data->length, offset);
-         #endif
-
-         /* Loop over the coarse freq points */
-         for(UINT4 j = 0; j<lenCoarseArray-1 && fine_count < iStop; j++)
-         {
-           Mfhere = Mfnext;
-           Mfnext = coarseFreqs->data[j+1];
-
-           Omega_alpha   = (valpha[j + 1]   - valpha[j])  /(Mfnext - Mfhere);
-           Omega_epsilon = (vepsilon[j + 1] - vepsilon[j])/(Mfnext - Mfhere);
-           Omega_betah   = (vbetah[j + 1]   - vbetah[j])  /(Mfnext - Mfhere);
-
-           cexp_i_alpha[fine_count]   = cexp(I*valpha[j]);
-           cexp_i_epsilon[fine_count] = cexp(I*vepsilon[j]);
-           cexp_i_betah[fine_count]   = cexp(I*vbetah[j]);
-
-           Qalpha   = cexp(I*evaldMf*Omega_alpha);
-           Qepsilon = cexp(I*evaldMf*Omega_epsilon);
-           Qbetah   = cexp(I*evaldMf*Omega_betah);
-
-           fine_count++;
-
-           REAL8 dratio = (Mfnext-Mfhere)/evaldMf;
-           UINT4 ceil_ratio  = ceil(dratio);
-           UINT4 floor_ratio = floor(dratio);
-
-           /* Make sure the rounding is done correctly. */
-           if(fabs(dratio-ceil_ratio) < fabs(dratio-floor_ratio))
-           {
-             ratio = ceil_ratio;
-           }
-           else
-           {
-             ratio = floor_ratio;
-           }
-
-          /* Compute complex exponential in fine points between two coarse points */
-          /* This loop carry out the eq. 2.32 in arXiv:2001.10897 */
-           for(UINT4 kk = 1; kk < ratio && fine_count < iStop; kk++){
-             cexp_i_alpha[fine_count]   = Qalpha*cexp_i_alpha[fine_count-1];
-             cexp_i_epsilon[fine_count] = Qepsilon*cexp_i_epsilon[fine_count-1];
-             cexp_i_betah[fine_count]   = Qbetah*cexp_i_betah[fine_count-1];
-             fine_count++;
-           }
-         }// Loop over coarse grid
-
-         /*
-          Now we have the complex exponentials of the three Euler angles alpha, beta, epsilon evaluated in the fine frequency grid.
-          Next step is do the twisting up with these.
-         */
-
-        #if DEBUG == 1
-        printf("fine_count, htildelm->length, offset = %i %i %i\n", fine_count, htildelm->data->length, offset);
-        #endif
+         /* Exponentials of the Euler angles interpolated to the fine grid */
+         COMPLEX16 *cexp_i_alpha = NULL, *cexp_i_epsilon = NULL, *cexp_i_betah = NULL;
+         UINT4 fine_count = 0;
+         status = IMRPhenomXPHM_MultibandAngles(&cexp_i_alpha, &cexp_i_epsilon, &cexp_i_betah, &fine_count, ell, emmprime, offset, pWF, pPrec, lalParams);
+         XLAL_CHECK(status == XLAL_SUCCESS, XLAL_EFUNC, "IMRPhenomXPHM_MultibandAngles failed.");
 
          /************** TWISTING UP in the fine grid *****************/
          for (UINT4 idx = 0; idx < fine_count; idx++)
@@ -1132,10 +992,6 @@ int XLALSimIMRPhenomXPHMFromModes(
            (*hctilde)->data->data[idx + offset] += hcross;
          }
 
-         XLALDestroyREAL8Sequence(coarseFreqs);
-         LALFree(valpha);
-         LALFree(vepsilon);
-         LALFree(vbetah);
          LALFree(cexp_i_alpha);
          LALFree(cexp_i_epsilon);
          LALFree(cexp_i_betah);
@@ -1185,6 +1041,189 @@ int XLALSimIMRPhenomXPHMFromModes(
 
 
 
+/*
+  Euler angles for the twisting up of the (ell, emmprime) mode by multibanding.
+
+  The angles are evaluated on the coarse frequency grid of the non-precessing mode and the
+  complex exponentials of alpha, epsilon and beta/2 are interpolated to the fine, equally
+  spaced, frequency grid starting at offset (see section D of Precessing paper). On success,
+  *length is the number of fine frequencies filled, and the three arrays must be freed with
+  LALFree().
+*/
+static int IMRPhenomXPHM_MultibandAngles(
+  COMPLEX16 **cexp_i_alpha_out,        /**< [out] exp(i alpha) on the fine grid */
+  COMPLEX16 **cexp_i_epsilon_out,      /**< [out] exp(i epsilon) on the fine grid */
+  COMPLEX16 **cexp_i_betah_out,        /**< [out] exp(i beta/2) on the fine grid */
+  UINT4 *length,                       /**< [out] number of fine frequencies */
+  UINT4 ell,                           /**< l index of the non-precessing mode */
+  UINT4 emmprime,                      /**< m index of the non-precessing mode */
+  UINT4 offset,                        /**< index of the first fine frequency */
+  IMRPhenomXWaveformStruct *pWF,       /**< IMRPhenomX Waveform Struct  */
+  IMRPhenomXPrecessionStruct *pPrec,   /**< IMRPhenomXP Precession Struct  */
+  LALDict *lalParams                   /**< LAL Dictionary Structure    */
+)
+{
+  /* Compute non-uniform coarse frequency grid as 1D array */
+  REAL8Sequence *coarseFreqs;
+  XLALSimIMRPhenomXPHMMultibandingGrid(&coarseFreqs, ell, emmprime, pWF, lalParams);
+  XLAL_CHECK(coarseFreqs != NULL, XLAL_EFUNC, "Failed to build the coarse frequency grid for the Euler angles.");
+
+  UINT4 lenCoarseArray = coarseFreqs->length;
+
+  /* Euler angles */
+  REAL8 alpha        = 0.0;
+  REAL8 epsilon      = 0.0;
+
+  REAL8 cBetah       = 0.0;
+  REAL8 sBetah       = 0.0;
+
+  /* Variables to store the Euler angles in the coarse frequency grid. */
+  REAL8 *valpha      = (REAL8*)XLALMalloc(lenCoarseArray * sizeof(REAL8));
+  REAL8 *vepsilon    = (REAL8*)XLALMalloc(lenCoarseArray * sizeof(REAL8));
+  REAL8 *vbetah      = (REAL8*)XLALMalloc(lenCoarseArray * sizeof(REAL8));
+
+  switch(pPrec->IMRPhenomXPrecVersion)
+  {
+    case 101:
+    case 102:
+    case 103:
+    case 104:
+    {
+      /* Use NNLO PN Euler angles */
+      /* Evaluate angles in coarse freq grid */
+      for(UINT4 j=0; j<lenCoarseArray; j++)
+      {
+        REAL8 Mf = coarseFreqs->data[j];
+
+        /* This function already add the offsets to the angles. */
+        Get_alpha_beta_epsilon(&alpha, &cBetah, &sBetah, &epsilon, emmprime, Mf, pPrec, pWF);
+
+        valpha[j]   = alpha;
+        vepsilon[j] = epsilon;
+        vbetah[j]   = acos(cBetah);
+      }
+      break;
+    }
+    case 220:
+    case 221:
+    case 222:
+    case 223:
+    case 224:
+    {
+      /* Use MSA Euler angles. */
+      /* Evaluate angles in coarse freq grid */
+      for(UINT4 j=0; j<lenCoarseArray; j++)
+      {
+        /* Get Euler angles. */
+        REAL8 Mf = coarseFreqs->data[j];
+        const REAL8 v        = cbrt (LAL_PI * Mf * (2.0 / emmprime) );
+        const vector vangles = IMRPhenomX_Return_phi_zeta_costhetaL_MSA(v,pWF,pPrec);
+        REAL8 cos_beta  = 0.0;
+
+        /* Get the offset for the Euler angles alpha and epsilon. */
+        REAL8 alpha_offset_mprime = 0, epsilon_offset_mprime = 0;
+        Get_alpha_epsilon_offset(&alpha_offset_mprime, &epsilon_offset_mprime, emmprime, pPrec);
+
+        valpha[j]   = vangles.x - alpha_offset_mprime;
+        vepsilon[j] = vangles.y - epsilon_offset_mprime;
+        cos_beta    = vangles.z;
+
+        INT4 status = IMRPhenomXWignerdCoefficients_cosbeta(&cBetah, &sBetah, cos_beta);
+        XLAL_CHECK(status == XLAL_SUCCESS, XLAL_EFUNC, "Call to IMRPhenomXWignerdCoefficients_cosbeta failed.");
+
+        vbetah[j]   = acos(cBetah);
+      }
+      break;
+    }
+    default:
+    {
+      XLAL_ERROR(XLAL_EINVAL,"Error: IMRPhenomXPrecVersion not recognized. Recommended default is 223.\n");
+      break;
+    }
+  }
+
+  /*
+     We have the three Euler angles evaluated in the coarse frequency grid.
+     Now we have to carry out the iterative linear interpolation for the complex exponential of each Euler angle. This follows the procedure of eq. 2.32 in arXiv:2001.10897..
+     The result will be three arrays of complex exponential evaluated in the finefreqs.
+  */
+  UINT4 fine_count = 0, ratio;
+  REAL8 Omega_alpha, Omega_epsilon, Omega_betah, Qalpha, Qepsilon, Qbetah;
+  REAL8 Mfhere, Mfnext, evaldMf;
+  Mfnext = coarseFreqs->data[0];
+  evaldMf = XLALSimIMRPhenomXUtilsHztoMf(pWF->deltaF, pWF->Mtot);
+
+  /*
+     Number of points where the waveform will be computed.
+     It is the same for all the modes and could be computed outside the loop, it is here for clarity since it is not used anywhere else.
+  */
+  size_t iStop  = (size_t) (pWF->f_max_prime / pWF->deltaF) + 1 - offset;
+
+  UINT4 length_fine_grid = iStop + 3; // This is just to reserve memory, add 3 points of buffer.
+
+  COMPLEX16 *cexp_i_alpha   = *cexp_i_alpha_out   = (COMPLEX16*)XLALMalloc(length_fine_grid * sizeof(COMPLEX16));
+  COMPLEX16 *cexp_i_epsilon = *cexp_i_epsilon_out = (COMPLEX16*)XLALMalloc(length_fine_grid * sizeof(COMPLEX16));
+  COMPLEX16 *cexp_i_betah   = *cexp_i_betah_out   = (COMPLEX16*)XLALMalloc(length_fine_grid * sizeof(COMPLEX16));
+
+  #if DEBUG == 1
+  printf("\n\nLENGTHS fine grid estimate, coarseFreqs->length = %i %i\n", length_fine_grid, lenCoarseArray);
+  #endif
+
+  /* Loop over the coarse freq points */
+  for(UINT4 j = 0; j<lenCoarseArray-1 && fine_count < iStop; j++)
+  {
+    Mfhere = Mfnext;
+    Mfnext = coarseFreqs->data[j+1];
+
+    Omega_alpha   = (valpha[j + 1]   - valpha[j])  /(Mfnext - Mfhere);
+    Omega_epsilon = (vepsilon[j + 1] - vepsilon[j])/(Mfnext - Mfhere);
+    Omega_betah   = (vbetah[j + 1]   - vbetah[j])  /(Mfnext - Mfhere);
+
+    cexp_i_alpha[fine_count]   = cexp(I*valpha[j]);
+    cexp_i_epsilon[fine_count] = cexp(I*vepsilon[j]);
+    cexp_i_betah[fine_count]   = cexp(I*vbetah[j]);
+
+    Qalpha   = cexp(I*evaldMf*Omega_alpha);
+    Qepsilon = cexp(I*evaldMf*Omega_epsilon);
+    Qbetah   = cexp(I*evaldMf*Omega_betah);
+
+    fine_count++;
+
+    REAL8 dratio = (Mfnext-Mfhere)/evaldMf;
+    UINT4 ceil_ratio  = ceil(dratio);
+    UINT4 floor_ratio = floor(dratio);
+
+    /* Make sure the rounding is done correctly. */
+    if(fabs(dratio-ceil_ratio) < fabs(dratio-floor_ratio))
+    {
+      ratio = ceil_ratio;
+    }
+    else
+    {
+      ratio = floor_ratio;
+    }
+
+   /* Compute complex exponential in fine points between two coarse points */
+   /* This loop carry out the eq. 2.32 in arXiv:2001.10897 */
+    for(UINT4 kk = 1; kk < ratio && fine_count < iStop; kk++){
+      cexp_i_alpha[fine_count]   = Qalpha*cexp_i_alpha[fine_count-1];
+      cexp_i_epsilon[fine_count] = Qepsilon*cexp_i_epsilon[fine_count-1];
+      cexp_i_betah[fine_count]   = Qbetah*cexp_i_betah[fine_count-1];
+      fine_count++;
+    }
+  }// Loop over coarse grid
+
+  *length = fine_count;
+
+  XLALDestroyREAL8Sequence(coarseFreqs);
+  LALFree(valpha);
+  LALFree(vepsilon);
+  LALFree(vbetah);
+
+  return XLAL_SUCCESS;
+}
+
+
 /*
   Core function of XLALSimIMRPhenomXPHMFromModes and XLALSimIMRPhenomXPHMFrequencySequence.
   Returns hptilde, hctilde for positive frequencies.
@@ -2337,18 +2376,51 @@ static int IMRPhenomXPHM_OneMode(
        }
      }
      else{
-       /* Loop over frequencies. Only where waveform is non zero. */
-       for (UINT4 idx = 0; idx < freqs->length; idx++)
+       /* Twisted-up mode in one frequency point: positive and negative frequencies. */
+       COMPLEX16Sequence *hlm = XLALCreateCOMPLEX16Sequence(2);
+       XLAL_CHECK(hlm, XLAL_ENOMEM, "Failed to allocate COMPLEX16Sequence of length 2.");
+
+       if(pPrec->MBandPrecVersion == 0)
        {
-          REAL8 Mf = pWF->M_sec*freqs->data[idx];
-          hlmcoprec  = htildelm->data->data[idx + offset];  /* Co-precessing waveform */
-          COMPLEX16Sequence *hlm;
-          hlm = XLALCreateCOMPLEX16Sequence(2);
-          IMRPhenomXPHMTwistUpOneMode(Mf, hlmcoprec, pWF, pPrec, ell, emmprime, m, hlm);
-          (*hlmpos)->data->data[idx + offset] += hlm->data[0];     // Positive frequencies. Freqs do 0, df, 2df, ...., fmax
-          (*hlmneg)->data->data[idx + offset] += hlm->data[1];     // Negative frequencies. Freqs do 0, -df, -2df, ...., -fmax
-          XLALDestroyCOMPLEX16Sequence(hlm);
-        }
+         /* Loop over frequencies. Only where waveform is non zero. */
+         for (UINT4 idx = 0; idx < freqs->length; idx++)
+         {
+            REAL8 Mf = pWF->M_sec*freqs->data[idx];
+            hlmcoprec  = htildelm->data->data[idx + offset];  /* Co-precessing waveform */
+            IMRPhenomXPHMTwistUpOneMode(Mf, hlmcoprec, pWF, pPrec, ell, emmprime, m, hlm);
+            (*hlmpos)->data->data[idx + offset] += hlm->data[0];     // Positive frequencies. Freqs do 0, df, 2df, ...., fmax
+            (*hlmneg)->data->data[idx + offset] += hlm->data[1];     // Negative frequencies. Freqs do 0, -df, -2df, ...., -fmax
+          }
+       }
+       else
+       {
+         /* Multibanding for the angles, as in IMRPhenomXPHM_hplushcross. */
+         COMPLEX16 *cexp_i_alpha = NULL, *cexp_i_epsilon = NULL, *cexp_i_betah = NULL;
+         UINT4 fine_count = 0;
+         status = IMRPhenomXPHM_MultibandAngles(&cexp_i_alpha, &cexp_i_epsilon, &cexp_i_betah, &fine_count, ell, emmprime, offset, pWF, pPrec, lalParams);
+         XLAL_CHECK(status == XLAL_SUCCESS, XLAL_EFUNC, "IMRPhenomXPHM_MultibandAngles failed.");
+
+         /* TWISTING UP in the fine grid */
+         for (UINT4 idx = 0; idx < fine_count; idx++)
+         {
+            REAL8 Mf   = pWF->M_sec * (idx + offset)*pWF->deltaF;
+            hlmcoprec  = htildelm->data->data[idx + offset];  /* Co-precessing waveform */
+
+            pPrec->cexp_i_alpha   = cexp_i_alpha[idx];
+            pPrec->cexp_i_epsilon = cexp_i_epsilon[idx];
+            pPrec->cexp_i_betah   = cexp_i_betah[idx];
+
+            IMRPhenomXPHMTwistUpOneMode(Mf, hlmcoprec, pWF, pPrec, ell, emmprime, m, hlm);
+            (*hlmpos)->data->data[idx + offset] += hlm->data[0];     // Positive frequencies. Freqs do 0, df, 2df, ...., fmax
+            (*hlmneg)->data->data[idx + offset] += hlm->data[1];     // Negative frequencies. Freqs do 0, -df, -2df, ...., -fmax
+          }
+
+         LALFree(cexp_i_alpha);
+         LALFree(cexp_i_epsilon);
+         LALFree(cexp_i_betah);
+       }// End of Multibanding-specific.
+
+       XLALDestroyCOMPLEX16Sequence(hlm);
      }
 
      XLALDestroyCOMPLEX16FrequencySeries(htildelm);
@@ -2402,49 +2474,65 @@ static int IMRPhenomXPHMTwistUpOneMode(
   double cBetah      = 0.0;
   double sBetah      = 0.0;
 
+  /* e^{-i m alpha} and e^{i mprime epsilon} */
+  COMPLEX16 cexp_im_alpha = 1, exp_imprime_epsilon = 1;
 
-  switch(pPrec->IMRPhenomXPrecVersion)
+  if(pPrec->MBandPrecVersion == 0) /* No multibanding for angles */
   {
-    case 101:        /* Post-Newtonian Euler angles. Single spin approximantion. See sections IV-B and IV-C in Precessing paper. */
-    case 102:        /* The different number 10i means different PN order. */
-    case 103:
-    case 104:
-    {
-      /* NNLO PN Euler Angles */
-      Get_alpha_beta_epsilon(&alpha, &cBetah, &sBetah, &epsilon, mprime, Mf, pPrec, pWF);
-      break;
-    }
-    case 220:
-    case 221:
-    case 222:
-    case 223:
-    case 224:
+    switch(pPrec->IMRPhenomXPrecVersion)
     {
-      /* ~~~~~ Euler Angles from Chatziioannou et al, PRD 95, 104004, (2017)  ~~~~~ */
-      const double v            = cbrt(LAL_PI * Mf * (2.0/mprime) );
-      const vector vangles      = IMRPhenomX_Return_phi_zeta_costhetaL_MSA(v,pWF,pPrec);
-      double cos_beta           = 0.0;
+      case 101:        /* Post-Newtonian Euler angles. Single spin approximantion. See sections IV-B and IV-C in Precessing paper. */
+      case 102:        /* The different number 10i means different PN order. */
+      case 103:
+      case 104:
+      {
+        /* NNLO PN Euler Angles */
+        Get_alpha_beta_epsilon(&alpha, &cBetah, &sBetah, &epsilon, mprime, Mf, pPrec, pWF);
+        break;
+      }
+      case 220:
+      case 221:
+      case 222:
+      case 223:
+      case 224:
+      {
+        /* ~~~~~ Euler Angles from Chatziioannou et al, PRD 95, 104004, (2017)  ~~~~~ */
+        const double v            = cbrt(LAL_PI * Mf * (2.0/mprime) );
+        const vector vangles      = IMRPhenomX_Return_phi_zeta_costhetaL_MSA(v,pWF,pPrec);
+        double cos_beta           = 0.0;
 
-      REAL8 alpha_offset_mprime = 0, epsilon_offset_mprime = 0;
-      Get_alpha_epsilon_offset(&alpha_offset_mprime, &epsilon_offset_mprime, mprime, pPrec);
+        REAL8 alpha_offset_mprime = 0, epsilon_offset_mprime = 0;
+        Get_alpha_epsilon_offset(&alpha_offset_mprime, &epsilon_offset_mprime, mprime, pPrec);
 
-      alpha    = vangles.x - alpha_offset_mprime;
-      epsilon  = vangles.y - epsilon_offset_mprime;
-      cos_beta = vangles.z;
+        alpha    = vangles.x - alpha_offset_mprime;
+        epsilon  = vangles.y - epsilon_offset_mprime;
+        cos_beta = vangles.z;
 
-      INT4 status = 0;
-      status = IMRPhenomXWignerdCoefficients_cosbeta(&cBetah, &sBetah, cos_beta);
-      XLAL_CHECK(status == XLAL_SUCCESS, XLAL_EFUNC, "Call to IMRPhenomXWignerdCoefficients_cosbeta failed.");
+        INT4 status = 0;
+        status = IMRPhenomXWignerdCoefficients_cosbeta(&cBetah, &sBetah, cos_beta);
+        XLAL_CHECK(status == XLAL_SUCCESS, XLAL_EFUNC, "Call to IMRPhenomXWignerdCoefficients_cosbeta failed.");
 
-      break;
-    }
-    default:
-    {
-      XLAL_ERROR(XLAL_EINVAL,"Error. IMRPhenomXPrecVersion not recognized. Recommended default is 223.\n");
-      break;
+        break;
+      }
+      default:
+      {
+        XLAL_ERROR(XLAL_EINVAL,"Error. IMRPhenomXPrecVersion not recognized. Recommended default is 223.\n");
+        break;
+      }
     }
-  }
 
+    cexp_im_alpha       = cexp(-1.*I*m*alpha);
+    exp_imprime_epsilon = cexp(mprime*I*epsilon);
+  } // End of no multibanding
+  else{ /*  For Multibanding: exponentials interpolated in IMRPhenomXPHM_MultibandAngles */
+    cBetah = (pPrec->cexp_i_betah + 1./pPrec->cexp_i_betah)*0.5;
+    sBetah = (pPrec->cexp_i_betah - 1./pPrec->cexp_i_betah)*0.5/I;
+
+    /* Integer powers of the exponentials, |m| <= l <= 4 */
+    COMPLEX16 cexp_mi_alpha = (m > 0) ? 1./pPrec->cexp_i_alpha : pPrec->cexp_i_alpha;
+    for(INT4 k = 0; k < abs(m); k++)   cexp_im_alpha       *= cexp_mi_alpha;
+    for(UINT4 k = 0; k < mprime; k++)  exp_imprime_epsilon *= pPrec->cexp_i_epsilon;
+  } // End of Multibanding-specific
 
   /* Useful powers of the Wigner coefficients */
   REAL8 cBetah2 = cBetah * cBetah;
@@ -2479,7 +2567,6 @@ static int IMRPhenomXPHMTwistUpOneMode(
     COMPLEX16 d2m2[5]  = {d22[4],    -d22[3],      d22[2],     -d22[1],     d22[0]}; /* Exploit symmetry d^2_{-m,-2} = (-1)^m d^2_{-m,2}. See eq. A2 of Precessing paper */
 
     /* See eqs. E3-E4 in Precessing paper. */
-    COMPLEX16 cexp_im_alpha = cexp(-1.*I*m*alpha);
     hlm += cexp_im_alpha * d2m2[m+2];
     hlmneg += cexp_im_alpha * d22[m+2];
   }
@@ -2492,7 +2579,6 @@ static int IMRPhenomXPHMTwistUpOneMode(
     COMPLEX16 d2m1[5]  = {-d21[4],   d21[3],     -d21[2],    d21[1],     -d21[0]}; /* Exploit symmetry d^2_{-m,-1} = -(-1)^m d^2_{m,1}.  See eq. A2 of Precessing paper.  */
 
     /* See eqs. E3-E4 in Precessing paper. */
-    COMPLEX16 cexp_im_alpha = cexp(-1.*I*m*alpha);
     hlm += cexp_im_alpha * d2m1[m+2];
     hlmneg += cexp_im_alpha * d21[m+2];
   }
@@ -2506,7 +2592,6 @@ static int IMRPhenomXPHMTwistUpOneMode(
     COMPLEX16 d3m3[7]  = {d33[6],    -d33[5],     d33[4],      -d33[3],    d33[2],     -d33[1],    d33[0]}; /* Exploit symmetry d^3_{-m,-3} = -(-1)^m d^3_{m,3}. See eq. A2 of Precessing paper. */
 
     /* See eqs. E3-E4 in Precessing paper. */
-    COMPLEX16 cexp_im_alpha = cexp(-1.*I*m*alpha);
     hlm += cexp_im_alpha * d3m3[m+3];
     hlmneg += cexp_im_alpha * d33[m+3];
   }
@@ -2520,7 +2605,6 @@ static int IMRPhenomXPHMTwistUpOneMode(
     COMPLEX16 d3m2[7]  = {-d32[6],   d32[5],     -d32[4],      d32[3],     -d32[2],    d32[1],    -d32[0]}; /* Exploit symmetry d^3_{-m,-2} = (-1)^m d^3_{m,2}. See eq. A2 of Precessing paper.  */
 
     /* See eqs. E3-E4 in Precessing paper. */
-    COMPLEX16 cexp_im_alpha = cexp(-1.*I*m*alpha);
     hlm += cexp_im_alpha * d3m2[m+3];
     hlmneg += cexp_im_alpha * d32[m+3];
   }
@@ -2533,13 +2617,11 @@ static int IMRPhenomXPHMTwistUpOneMode(
     COMPLEX16 d4m4[9]  = {d44[8],   -d44[7],      d44[6],     -d44[5],     d44[4],    -d44[3],     d44[2],    -d44[1],     d44[0]}; /* Exploit symmetry d^4_{-m,-4} = (-1)^m d^4_{m,4}. See eq. A2 of Precessing paper.  */
 
     /* See eqs. E3-E4 in Precessing paper. */
-    COMPLEX16 cexp_im_alpha = cexp(-1.*I*m*alpha);
     hlm += cexp_im_alpha * d4m4[m+4];
     hlmneg += cexp_im_alpha * d44[m+4];
   }
 
   /* See eqs. E3-E4 in Precessing paper. */
-  COMPLEX16 exp_imprime_epsilon = cexp(mprime*I*epsilon);
   COMPLEX16 eps_phase_hP_lmprime = 1./exp_imprime_epsilon * hlmprime;
   COMPLEX16 eps_phase_hP_lmprime_neg = exp_imprime_epsilon * minus1l * conj(hlmprime);
 
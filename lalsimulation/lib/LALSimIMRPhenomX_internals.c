@@ -44,17 +44,27 @@
 #include <lal/Date.h>
 #include <lal/FrequencySeries.h>
 #include <lal/Units.h>
+#include <lal/VectorMath.h>
 
 /* GSL Header Files */
 #include <gsl/gsl_linalg.h>
 
+static void IMRPhenomX_Fill_Powers(IMRPhenomX_UsefulPowers *p, REAL8 number, REAL8 sixth, REAL8 lognumber);
+
 /* This struct is used to pre-cache useful powers of frequency, avoiding numerous expensive operations */
 int IMRPhenomX_Initialize_Powers(IMRPhenomX_UsefulPowers *p, REAL8 number)
 {
 	XLAL_CHECK(0 != p, XLAL_EFAULT, "p is NULL");
 	XLAL_CHECK(number >= 0, XLAL_EDOM, "number must be non-negative");
 
-	double sixth      = pow(number, 1.0 / 6.0);
+	IMRPhenomX_Fill_Powers(p, number, pow(number, 1.0 / 6.0), log(number));
+
+	return XLAL_SUCCESS;
+}
+
+/* Fill in the powers of number from its sixth root and logarithm, by incremental multiplications */
+static void IMRPhenomX_Fill_Powers(IMRPhenomX_UsefulPowers *p, REAL8 number, REAL8 sixth, REAL8 lognumber)
+{
 	double m_sixth    = 1.0 / sixth;
 
 	p->one_sixth      = sixth;
@@ -93,8 +103,35 @@ int IMRPhenomX_Initialize_Powers(IMRPhenomX_UsefulPowers *p, REAL8 number)
 	p->seven_sixths   = p->one_sixth   * p->itself;
 	p->m_seven_sixths = p->m_one_sixth * p->m_one;
 
-	p->log            = log(number);
+	p->log            = lognumber;
 	p->sqrt           = p->one_sixth*p->one_sixth*p->one_sixth;
+}
+
+/*
+	Initialize the powers of a block of n <= IMRPHENOMX_POWERS_BLOCK numbers.  The logarithms
+	and sixth roots are evaluated with the SIMD VectorMath functions, a block at a time, so
+	results can differ from IMRPhenomX_Initialize_Powers() in the last few bits.
+*/
+int IMRPhenomX_Initialize_Powers_Block(IMRPhenomX_UsefulPowers *p, const REAL8 *number, UINT4 n)
+{
+	REAL8 lognumber[IMRPHENOMX_POWERS_BLOCK];
+	REAL8 sixth[IMRPHENOMX_POWERS_BLOCK];
+
+	XLAL_CHECK(0 != p && 0 != number, XLAL_EFAULT, "p or number is NULL");
+	XLAL_CHECK(n <= IMRPHENOMX_POWERS_BLOCK, XLAL_EINVAL, "block of %u numbers is too long", n);
+	for(UINT4 k = 0; k < n; k++)
+	{
+		XLAL_CHECK(number[k] >= 0, XLAL_EDOM, "number must be non-negative");
+	}
+
+	XLAL_CHECK(XLALVectorLogREAL8(lognumber, number, n) == XLAL_SUCCESS, XLAL_EFUNC);
+	XLAL_CHECK(XLALVectorScaleREAL8(sixth, 1.0 / 6.0, lognumber, n) == XLAL_SUCCESS, XLAL_EFUNC);
+	XLAL_CHECK(XLALVectorExpREAL8(sixth, sixth, n) == XLAL_SUCCESS, XLAL_EFUNC);
+
+	for(UINT4 k = 0; k < n; k++)
+	{
+		IMRPhenomX_Fill_Powers(&p[k], number[k], sixth[k], lognumber[k]);
+	}
 
 	return XLAL_SUCCESS;
 }
@@ -343,6 +343,10 @@ typedef struct tagIMRPhenomXAmpCoefficients
 int IMRPhenomX_Initialize_Powers(IMRPhenomX_UsefulPowers *p, REAL8 number);
 int IMRPhenomX_Initialize_Powers_Light(IMRPhenomX_UsefulPowers *p, REAL8 number);
 
+/* Largest block of numbers handled by IMRPhenomX_Initialize_Powers_Block() */
+#define IMRPHENOMX_POWERS_BLOCK 32
+int IMRPhenomX_Initialize_Powers_Block(IMRPhenomX_UsefulPowers *p, const REAL8 *number, UINT4 n);
+
 int IMRPhenomXSetWaveformVariables(
 IMRPhenomXWaveformStruct *pWF,
 	const REAL8 m1_SI,
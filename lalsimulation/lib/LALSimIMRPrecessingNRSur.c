@@ -979,22 +979,26 @@ static void PrecessingNRSur_assemble_dydt(
 }
 
 /**
- * Cubic interpolation of 4 data points
- * This gives a much closer result to scipy.interpolate.InterpolatedUnivariateSpline than using gsl_interp_cspline
+ * Weights of cubic interpolation through 4 data points.
+ * The interpolant at xout is sum_j w[j] y[j], so the weights depend only on the
+ * x values and can be shared between all components interpolated on the same
+ * points.  This is the Lagrange form of the interpolating polynomial, which is
+ * what gsl_interp_polynomial gives for 4 points, and gives a much closer result
+ * to scipy.interpolate.InterpolatedUnivariateSpline than using gsl_interp_cspline
  * (see comment in spline_array_interp)
  */
-static REAL8 cubic_interp(
+static void cubic_interp_weights(
+    REAL8 *w,      /**< Output: the 4 interpolation weights */
     REAL8 xout,    /**< The target x value */
-    REAL8 *x,      /**< The x values of the points to interpolate. Length 4, must be increasing. */
-    REAL8 *y       /**< The y values of the points to interpolate. Length 4. */
+    REAL8 *x       /**< The x values of the points to interpolate. Length 4, must be increasing. */
 ) {
-    gsl_interp_accel *acc = gsl_interp_accel_alloc();
-    gsl_spline *interpolant = gsl_spline_alloc(gsl_interp_polynomial, 4);
-    gsl_spline_init(interpolant, x, y, 4);
-    REAL8 res = gsl_spline_eval(interpolant, xout, acc);
-    gsl_spline_free(interpolant);
-    gsl_interp_accel_free(acc);
-    return res;
+    int i, j;
+    for (i=0; i<4; i++) {
+        w[i] = 1.0;
+        for (j=0; j<4; j++) {
+            if (j != i) w[i] *= (xout - x[j]) / (x[i] - x[j]);
+        }
+    }
 }
 
 /**
@@ -1171,20 +1175,18 @@ static void PrecessingNRSur_get_time_deriv(
     int i0 = i1-1;
     if (i0 < 0) i0 = 0;
     if (i0 > imax-3) i0 = imax-3;
-    REAL8 times[4], derivs[4], dydt0[11], dydt1[11], dydt2[11], dydt3[11];
+    REAL8 times[4], weights[4], dydt0[11], dydt1[11], dydt2[11], dydt3[11];
     int j;
     for (j=0; j<4; j++) times[j] = gsl_vector_get(t_ds, i0+j);
+    cubic_interp_weights(weights, t, times);
     PrecessingNRSur_get_time_deriv_from_index(dydt0, i0, q, y, __sur_data);
     PrecessingNRSur_get_time_deriv_from_index(dydt1, i0+1, q, y, __sur_data);
     PrecessingNRSur_get_time_deriv_from_index(dydt2, i0+2, q, y, __sur_data);
     PrecessingNRSur_get_time_deriv_from_index(dydt3, i0+3, q, y, __sur_data);
 
     for (j=0; j<11; j++) {
-        derivs[0] = dydt0[j];
-        derivs[1] = dydt1[j];
-        derivs[2] = dydt2[j];
-        derivs[3] = dydt3[j];
-        dydt[j] = cubic_interp(t, times, derivs);
+        dydt[j] = weights[0]*dydt0[j] + weights[1]*dydt1[j]
+            + weights[2]*dydt2[j] + weights[3]*dydt3[j];
     }
 
 }
@@ -1605,6 +1607,7 @@ static void PrecessingNRSur_integrate_AB4(
  */
 static void PrecessingNRSur_eval_data_piece(
     gsl_vector *result, /**< Output: Should have already been assigned space */
+    gsl_vector *worker, /**< Work space for the node values, of length at least data->n_nodes */
     REAL8 q,           /**< Mass ratio */
     gsl_vector **chiA,  /**< 3 gsl_vector *s, one for each (coorbital) component */
     gsl_vector **chiB,  /**< similar to chiA */
@@ -1612,7 +1615,7 @@ static void PrecessingNRSur_eval_data_piece(
     PrecessingNRSurData *__sur_data    /**< Loaded surrogate data */
 ) {
 
-    gsl_vector *nodes = gsl_vector_alloc(data->n_nodes);
+    gsl_vector_view nodes = gsl_vector_subvector(worker, 0, data->n_nodes);
     REAL8 x[7];
     int i, j, node_index;
 
@@ -1624,13 +1627,11 @@ static void PrecessingNRSur_eval_data_piece(
             x[1+j] = gsl_vector_get(chiA[j], node_index);
             x[4+j] = gsl_vector_get(chiB[j], node_index);
         }
-        gsl_vector_set(nodes, i, PrecessingNRSur_eval_fit(data->fit_data[i], x, __sur_data));
+        gsl_vector_set(&nodes.vector, i, PrecessingNRSur_eval_fit(data->fit_data[i], x, __sur_data));
     }
 
     // Evaluate the empirical interpolant
-    gsl_blas_dgemv(CblasTrans, 1.0, data->empirical_interpolant_basis, nodes, 0.0, result);
-
-    gsl_vector_free(nodes);
+    gsl_blas_dgemv(CblasTrans, 1.0, data->empirical_interpolant_basis, &nodes.vector, 0.0, result);
 }
 
 /************************ Main Waveform Generation Routines ***********/
@@ -1910,6 +1911,9 @@ static PrecessingNRSurData* PrecessingNRSur_core(
     MultiModalWaveform *h_coorb = NULL;
     MultiModalWaveform_Init(&h_coorb, NRSUR_LMAX, n_coorb);
     gsl_vector *data_piece_eval = gsl_vector_alloc(n_coorb);
+    // The empirical nodes are distinct coorbital times, so n_coorb bounds
+    // the number of nodes of every data piece
+    gsl_vector *nodes_worker = gsl_vector_alloc(n_coorb);
     WaveformDataPiece *data_piece_data;
     int i0; // for indexing the (ell, m=0) mode, such that the (ell, m) mode is index (i0 + m).
     WaveformFixedEllModeData *ell_data;
@@ -1922,11 +1926,11 @@ static PrecessingNRSurData* PrecessingNRSur_core(
         }
         else {
             data_piece_data = ell_data->m0_real_data;
-            PrecessingNRSur_eval_data_piece(data_piece_eval, q, chiA_coorb, chiB_coorb, data_piece_data, __sur_data);
+            PrecessingNRSur_eval_data_piece(data_piece_eval, nodes_worker, q, chiA_coorb, chiB_coorb, data_piece_data, __sur_data);
             gsl_vector_add(h_coorb->modes_real_part[i0], data_piece_eval);
 
             data_piece_data = ell_data->m0_imag_data;
-            PrecessingNRSur_eval_data_piece(data_piece_eval, q, chiA_coorb, chiB_coorb, data_piece_data, __sur_data);
+            PrecessingNRSur_eval_data_piece(data_piece_eval, nodes_worker, q, chiA_coorb, chiB_coorb, data_piece_data, __sur_data);
             gsl_vector_add(h_coorb->modes_imag_part[i0], data_piece_eval);
         }
 
@@ -1942,25 +1946,25 @@ static PrecessingNRSurData* PrecessingNRSur_core(
 
             // Re[X_plus] gets added to both Re[h^{ell, m}] and Re[h^{ell, -m}]
             data_piece_data = ell_data->X_real_plus_data[m-1];
-            PrecessingNRSur_eval_data_piece(data_piece_eval, q, chiA_coorb, chiB_coorb, data_piece_data, __sur_data);
+            PrecessingNRSur_eval_data_piece(data_piece_eval, nodes_worker, q, chiA_coorb, chiB_coorb, data_piece_data, __sur_data);
             gsl_vector_add(h_coorb->modes_real_part[i0+m], data_piece_eval);
             gsl_vector_add(h_coorb->modes_real_part[i0-m], data_piece_eval);
 
             // Re[X_minus] gets added to Re[h^{ell, m}] and subtracted from Re[h^{ell, -m}]
             data_piece_data = ell_data->X_real_minus_data[m-1];
-            PrecessingNRSur_eval_data_piece(data_piece_eval, q, chiA_coorb, chiB_coorb, data_piece_data, __sur_data);
+            PrecessingNRSur_eval_data_piece(data_piece_eval, nodes_worker, q, chiA_coorb, chiB_coorb, data_piece_data, __sur_data);
             gsl_vector_add(h_coorb->modes_real_part[i0+m], data_piece_eval);
             gsl_vector_sub(h_coorb->modes_real_part[i0-m], data_piece_eval);
 
             // Im[X_plus] gets added to Re[h^{ell, m}] and subtracted from Re[h^{ell, -m}]
             data_piece_data = ell_data->X_imag_plus_data[m-1];
-            PrecessingNRSur_eval_data_piece(data_piece_eval, q, chiA_coorb, chiB_coorb, data_piece_data, __sur_data);
+            PrecessingNRSur_eval_data_piece(data_piece_eval, nodes_worker, q, chiA_coorb, chiB_coorb, data_piece_data, __sur_data);
             gsl_vector_add(h_coorb->modes_imag_part[i0+m], data_piece_eval);
             gsl_vector_sub(h_coorb->modes_imag_part[i0-m], data_piece_eval);
 
             // Im[X_minus] gets added to both Re[h^{ell, m}] and Re[h^{ell, -m}]
             data_piece_data = ell_data->X_imag_minus_data[m-1];
-            PrecessingNRSur_eval_data_piece(data_piece_eval, q, chiA_coorb, chiB_coorb, data_piece_data, __sur_data);
+            PrecessingNRSur_eval_data_piece(data_piece_eval, nodes_worker, q, chiA_coorb, chiB_coorb, data_piece_data, __sur_data);
             gsl_vector_add(h_coorb->modes_imag_part[i0+m], data_piece_eval);
             gsl_vector_add(h_coorb->modes_imag_part[i0-m], data_piece_eval);
         }
@@ -1980,6 +1984,7 @@ static PrecessingNRSurData* PrecessingNRSur_core(
     gsl_vector_free(quat_coorb[3]);
     gsl_vector_free(phi_coorb);
     gsl_vector_free(data_piece_eval);
+    gsl_vector_free(nodes_worker);
 
     return __sur_data;
 }
@@ -232,7 +232,7 @@ static void PrecessingNRSur_assemble_dydt(
 );
 
 
-static double cubic_interp(double xout, double *x, double *y);
+static void cubic_interp_weights(double *w, double xout, double *x);
 static gsl_vector *spline_array_interp(gsl_vector *xout, gsl_vector *x, gsl_vector *y);
 
 static double PrecessingNRSur_get_omega(size_t node_index, double q, double *y0, PrecessingNRSurData *__sur_data);
@@ -331,6 +331,7 @@ static int PrecessingNRSur_IntegrateDynamics(
 
 static void PrecessingNRSur_eval_data_piece(
     gsl_vector *result,
+    gsl_vector *worker,
     double q,
     gsl_vector **chiA,
     gsl_vector **chiB,
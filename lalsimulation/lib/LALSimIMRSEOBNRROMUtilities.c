@@ -41,7 +41,9 @@
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_multifit.h>
 #include <gsl/gsl_interp.h>
+#include <gsl/gsl_spline.h>
 #include <gsl/gsl_fit.h>
+#include <lal/VectorMath.h>
 #include <LALSimBlackHoleRingdown.h>
 
 #ifdef LAL_HDF5_ENABLED
@@ -94,8 +96,55 @@ UNUSED static REAL8 Interpolate_Coefficent_Matrix(
   gsl_bspline_workspace *bwy
 );
 
+UNUSED static int Interpolate_Coefficent_Tensors(
+  gsl_vector *c,
+  const gsl_vector *cvec,
+  int nk,
+  REAL8 eta,
+  REAL8 chi1,
+  REAL8 chi2,
+  int ncx,
+  int ncy,
+  int ncz,
+  gsl_bspline_workspace *bwx,
+  gsl_bspline_workspace *bwy,
+  gsl_bspline_workspace *bwz
+);
+
+UNUSED static int Interpolate_Coefficent_Matrices(
+  gsl_vector *c,
+  const gsl_vector *cvec,
+  int nk,
+  REAL8 eta,
+  REAL8 chi,
+  int ncx,
+  int ncy,
+  gsl_bspline_workspace *bwx,
+  gsl_bspline_workspace *bwy
+);
+
 UNUSED static gsl_vector *Fit_cubic(const gsl_vector *xi, const gsl_vector *yi);
 
+UNUSED static int ROM_EvaluateModeFromAmpPhaseSplines(
+  COMPLEX16 *h,
+  const REAL8 *f,
+  size_t n,
+  gsl_spline *spline_amp,
+  gsl_spline *spline_phi,
+  REAL8 pre,
+  REAL8 twopit,
+  REAL8 phi0
+);
+UNUSED static int ROM_CombineModesFD(
+  COMPLEX16 *hp,
+  COMPLEX16 *hc,
+  COMPLEX16 * const *modes,
+  const COMPLEX16 *factorp,
+  const COMPLEX16 *factorc,
+  UINT4 nmodes,
+  size_t n
+);
+
 UNUSED static bool approximately_equal(REAL8 x, REAL8 y, REAL8 epsilon);
 UNUSED static void nudge(REAL8 *x, REAL8 X, REAL8 epsilon);
 
@@ -500,6 +549,112 @@ static REAL8 Interpolate_Coefficent_Matrix(
   return sum;
 }
 
+// Helper function to perform tensor product spline interpolation with gsl for all SVD modes at once.
+// The contiguous gsl_vector cvec contains nk consecutive ncx x ncy x ncz dimensional coefficient tensors
+// in vector form;  the k-th is interpolated and evaluated at position (eta,chi1,chi2) and stored in c[k].
+// The B-spline basis is evaluated once for all modes, and each mode is then a dot product of
+// the 64 nonzero basis function products with rows of 4 contiguous coefficients.
+static int Interpolate_Coefficent_Tensors(
+  gsl_vector *c,
+  const gsl_vector *cvec,
+  int nk,
+  REAL8 eta,
+  REAL8 chi1,
+  REAL8 chi2,
+  int ncx,
+  int ncy,
+  int ncz,
+  gsl_bspline_workspace *bwx,
+  gsl_bspline_workspace *bwy,
+  gsl_bspline_workspace *bwz
+) {
+  const size_t N = (size_t) ncx*ncy*ncz;  // Size of the data matrix for one SVD-mode
+  if (cvec->stride != 1 || cvec->size < (size_t) nk*N || c->size < (size_t) nk)
+    XLAL_ERROR(XLAL_EINVAL, "Coefficient vector does not hold %d contiguous SVD modes", nk);
+
+  // Nonzero cubic (order k=4) B-spline basis functions in the eta and chi directions.
+  double bx[4], by[4], bz[4];
+  gsl_vector_view Bx4 = gsl_vector_view_array(bx, 4);
+  gsl_vector_view By4 = gsl_vector_view_array(by, 4);
+  gsl_vector_view Bz4 = gsl_vector_view_array(bz, 4);
+  size_t isx, isy, isz; // first non-zero spline
+  size_t iex, iey, iez; // last non-zero spline
+  gsl_bspline_eval_nonzero(eta,  &Bx4.vector, &isx, &iex, bwx);
+  gsl_bspline_eval_nonzero(chi1, &By4.vector, &isy, &iey, bwy);
+  gsl_bspline_eval_nonzero(chi2, &Bz4.vector, &isz, &iez, bwz);
+
+  // Offsets of the 16 rows of 4 coefficients along chi2 and their weights, common to all SVD modes
+  size_t off[16];
+  double w[16][4];
+  for (int i=0; i<4; i++)
+    for (int j=0; j<4; j++) {
+      off[4*i + j] = ((isx + i)*ncy + isy + j)*ncz + isz;
+      for (int k=0; k<4; k++)
+        w[4*i + j][k] = bx[i] * by[j] * bz[k];
+    }
+
+  for (int n=0; n<nk; n++) {
+    const double *cn = cvec->data + n*N;
+    double sum = 0;
+    for (int r=0; r<16; r++) {
+      const double *row = cn + off[r];
+      sum += row[0]*w[r][0] + row[1]*w[r][1] + row[2]*w[r][2] + row[3]*w[r][3];
+    }
+    gsl_vector_set(c, n, sum);
+  }
+
+  return XLAL_SUCCESS;
+}
+
+// Helper function to perform tensor product spline interpolation with gsl for all SVD modes at once.
+// The contiguous gsl_vector cvec contains nk consecutive ncx x ncy dimensional coefficient matrices
+// in vector form;  the k-th is interpolated and evaluated at position (eta,chi) and stored in c[k].
+static int Interpolate_Coefficent_Matrices(
+  gsl_vector *c,
+  const gsl_vector *cvec,
+  int nk,
+  REAL8 eta,
+  REAL8 chi,
+  int ncx,
+  int ncy,
+  gsl_bspline_workspace *bwx,
+  gsl_bspline_workspace *bwy
+) {
+  const size_t N = (size_t) ncx*ncy;  // Size of the data matrix for one SVD-mode
+  if (cvec->stride != 1 || cvec->size < (size_t) nk*N || c->size < (size_t) nk)
+    XLAL_ERROR(XLAL_EINVAL, "Coefficient vector does not hold %d contiguous SVD modes", nk);
+
+  // Nonzero cubic (order k=4) B-spline basis functions in the eta and chi directions.
+  double bx[4], by[4];
+  gsl_vector_view Bx4 = gsl_vector_view_array(bx, 4);
+  gsl_vector_view By4 = gsl_vector_view_array(by, 4);
+  size_t isx, isy; // first non-zero spline
+  size_t iex, iey; // last non-zero spline
+  gsl_bspline_eval_nonzero(eta, &Bx4.vector, &isx, &iex, bwx);
+  gsl_bspline_eval_nonzero(chi, &By4.vector, &isy, &iey, bwy);
+
+  // Offsets of the 4 rows of 4 coefficients along chi and their weights, common to all SVD modes
+  size_t off[4];
+  double w[4][4];
+  for (int i=0; i<4; i++) {
+    off[i] = (isx + i)*ncy + isy;
+    for (int j=0; j<4; j++)
+      w[i][j] = bx[i] * by[j];
+  }
+
+  for (int n=0; n<nk; n++) {
+    const double *cn = cvec->data + n*N;
+    double sum = 0;
+    for (int r=0; r<4; r++) {
+      const double *row = cn + off[r];
+      sum += row[0]*w[r][0] + row[1]*w[r][1] + row[2]*w[r][2] + row[3]*w[r][3];
+    }
+    gsl_vector_set(c, n, sum);
+  }
+
+  return XLAL_SUCCESS;
+}
+
 // Returns fitting coefficients for cubic y = c[0] + c[1]*x + c[2]*x**2 + c[3]*x**3
 static gsl_vector *Fit_cubic(const gsl_vector *xi, const gsl_vector *yi) {
   const int n = xi->size; // how many data points are we fitting
@@ -537,6 +692,75 @@ static gsl_vector *Fit_cubic(const gsl_vector *xi, const gsl_vector *yi) {
 }
 
 // This function determines whether x and y are approximately equal to a relative accuracy epsilon.
+// Evaluate a mode from amplitude and phase splines built on the same knots, at the frequencies f[0..n-1]:
+// h[i] = pre * A(f[i]) * exp(I * (twopit * f[i] + phi0 - phi(f[i]))).
+// The two splines share one accelerator, so the knot interval is only searched for once per frequency,
+// and the phase factors are computed for all frequencies at once with XLALVectorSinCosREAL8().
+static int ROM_EvaluateModeFromAmpPhaseSplines(
+  COMPLEX16 *h,           // Output: mode values
+  const REAL8 *f,         // Input: frequencies, preferably increasing
+  size_t n,               // Input: number of frequencies
+  gsl_spline *spline_amp, // Input: amplitude spline
+  gsl_spline *spline_phi, // Input: phase spline, with the same knots as spline_amp
+  REAL8 pre,              // Input: amplitude prefactor
+  REAL8 twopit,           // Input: slope of the linear phase term
+  REAL8 phi0              // Input: constant phase term
+) {
+  if (n == 0)
+    return XLAL_SUCCESS;
+  REAL8 *work = XLALMalloc(4 * n * sizeof(*work));
+  gsl_interp_accel *acc = gsl_interp_accel_alloc();
+  if (!work || !acc) {
+    XLALFree(work);
+    if (acc) gsl_interp_accel_free(acc);
+    XLAL_ERROR(XLAL_ENOMEM);
+  }
+  REAL8 *A = work, *psi = work + n, *sinpsi = work + 2*n, *cospsi = work + 3*n;
+
+  for (size_t i=0; i<n; i++) {
+    A[i] = pre * gsl_spline_eval(spline_amp, f[i], acc);
+    psi[i] = twopit * f[i] + phi0 - gsl_spline_eval(spline_phi, f[i], acc);
+  }
+  gsl_interp_accel_free(acc);
+
+  if (XLALVectorSinCosREAL8(sinpsi, cospsi, psi, n) != XLAL_SUCCESS) {
+    XLALFree(work);
+    XLAL_ERROR(XLAL_EFUNC);
+  }
+  for (size_t i=0; i<n; i++)
+    h[i] = crect(A[i] * cospsi[i], A[i] * sinpsi[i]);
+
+  XLALFree(work);
+  return XLAL_SUCCESS;
+}
+
+// Add nmodes frequency-domain modes of length n to hplus and hcross, with the
+// spherical harmonic factors factorp[k], factorc[k] of mode k, in a single pass
+// over the frequencies rather than one pass per mode.
+static int ROM_CombineModesFD(
+  COMPLEX16 *hp,                 // Output: hplus, added to
+  COMPLEX16 *hc,                 // Output: hcross, added to
+  COMPLEX16 * const *modes,      // Input: mode data
+  const COMPLEX16 *factorp,      // Input: factors of the modes for hplus
+  const COMPLEX16 *factorc,      // Input: factors of the modes for hcross
+  UINT4 nmodes,                  // Input: number of modes
+  size_t n                       // Input: number of frequencies
+) {
+  for (size_t j=0; j<n; j++) {
+    REAL8 pr = 0, pi = 0, cr = 0, ci = 0;
+    for (UINT4 k=0; k<nmodes; k++) {
+      const REAL8 hr = creal(modes[k][j]), hi = cimag(modes[k][j]);
+      pr += creal(factorp[k]) * hr - cimag(factorp[k]) * hi;
+      pi += creal(factorp[k]) * hi + cimag(factorp[k]) * hr;
+      cr += creal(factorc[k]) * hr - cimag(factorc[k]) * hi;
+      ci += creal(factorc[k]) * hi + cimag(factorc[k]) * hr;
+    }
+    hp[j] += crect(pr, pi);
+    hc[j] += crect(cr, ci);
+  }
+  return XLAL_SUCCESS;
+}
+
 // Note that x and y are compared to relative accuracy, so this function is not suitable for testing whether a value is approximately zero.
 static bool approximately_equal(REAL8 x, REAL8 y, REAL8 epsilon) {
   return !gsl_fcmp(x, y, epsilon);
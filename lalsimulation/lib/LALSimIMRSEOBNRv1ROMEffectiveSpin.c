@@ -334,20 +334,17 @@ static int TP_Spline_interpolation_2d(
 
   int ncx = splinedata->ncx; // points in q
   int ncy = splinedata->ncy; // points in chi
-  int N = ncx*ncy;  // size of the data matrix for one SVD-mode
 
   // Evaluate the TP spline for all SVD modes - amplitude
-  for (int k=0; k<nk_amp; k++) { // For each SVD mode
-    gsl_vector v = gsl_vector_subvector(cvec_amp, k*N, N).vector; // Pick out the coefficient matrix corresponding to the k-th SVD mode.
-    REAL8 csum = Interpolate_Coefficent_Matrix(&v, q, chi, ncx, ncy, bwx, bwy);
-    gsl_vector_set(c_amp, k, csum);
+  if (Interpolate_Coefficent_Matrices(c_amp, cvec_amp, nk_amp, q, chi, ncx, ncy, bwx, bwy) != XLAL_SUCCESS) {
+    SplineData_Destroy(splinedata);
+    XLAL_ERROR(XLAL_EFUNC);
   }
 
   // Evaluate the TP spline for all SVD modes - phase
-  for (int k=0; k<nk_phi; k++) {  // For each SVD mode
-    gsl_vector v = gsl_vector_subvector(cvec_phi, k*N, N).vector; // Pick out the coefficient matrix corresponding to the k-th SVD mode.
-    REAL8 csum = Interpolate_Coefficent_Matrix(&v, q, chi, ncx, ncy, bwx, bwy);
-    gsl_vector_set(c_phi, k, csum);
+  if (Interpolate_Coefficent_Matrices(c_phi, cvec_phi, nk_phi, q, chi, ncx, ncy, bwx, bwy) != XLAL_SUCCESS) {
+    SplineData_Destroy(splinedata);
+    XLAL_ERROR(XLAL_EFUNC);
   }
 
   // Evaluate the TP spline for the amplitude prefactor
@@ -583,20 +583,17 @@ static int TP_Spline_interpolation_3d(
   gsl_bspline_workspace *bwy=splinedata->bwy;
   gsl_bspline_workspace *bwz=splinedata->bwz;
 
-  int N = ncx*ncy*ncz;  // Size of the data matrix for one SVD-mode
 
   // Evaluate the TP spline for all SVD modes - amplitude
-  for (int k=0; k<nk_amp; k++) { // For each SVD mode
-    gsl_vector v = gsl_vector_subvector(cvec_amp, k*N, N).vector; // Pick out the coefficient matrix corresponding to the k-th SVD mode.
-    REAL8 csum = Interpolate_Coefficent_Tensor(&v, eta, chi1, chi2, ncy, ncz, bwx, bwy, bwz);
-    gsl_vector_set(c_amp, k, csum);
+  if (Interpolate_Coefficent_Tensors(c_amp, cvec_amp, nk_amp, eta, chi1, chi2, ncx, ncy, ncz, bwx, bwy, bwz) != XLAL_SUCCESS) {
+    SplineData_Destroy(splinedata);
+    XLAL_ERROR(XLAL_EFUNC);
   }
 
   // Evaluate the TP spline for all SVD modes - phase
-  for (int k=0; k<nk_phi; k++) {  // For each SVD mode
-    gsl_vector v = gsl_vector_subvector(cvec_phi, k*N, N).vector; // Pick out the coefficient matrix corresponding to the k-th SVD mode.
-    REAL8 csum = Interpolate_Coefficent_Tensor(&v, eta, chi1, chi2, ncy, ncz, bwx, bwy, bwz);
-    gsl_vector_set(c_phi, k, csum);
+  if (Interpolate_Coefficent_Tensors(c_phi, cvec_phi, nk_phi, eta, chi1, chi2, ncx, ncy, ncz, bwx, bwy, bwz) != XLAL_SUCCESS) {
+    SplineData_Destroy(splinedata);
+    XLAL_ERROR(XLAL_EFUNC);
   }
 
   // Evaluate the TP spline for the amplitude prefactor
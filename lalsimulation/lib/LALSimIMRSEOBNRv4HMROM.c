@@ -392,6 +392,21 @@ UNUSED static int SEOBNRv4HMROMCoreModeAmpPhaseSplines(
   UNUSED UINT4 nModes /**<  Number of modes to generate */
 );
 
+static int SEOBNRv4HMROM_AssembleMode(
+  COMPLEX16 *hlmdata,
+  const REAL8Sequence *freqs,
+  UINT4 offset,
+  REAL8 Mf_min,
+  REAL8 Mf_max,
+  gsl_spline *spline_amp,
+  gsl_spline *spline_phase,
+  REAL8 amp0,
+  REAL8 t_corr,
+  UINT4 modeL,
+  UINT4 modeM,
+  REAL8 sign_odd_modes
+);
+
 UNUSED static int SEOBNRv4HMROMCoreModesHybridized(
   UNUSED SphHarmFrequencySeries **hlm_list, /**<< Output: Spherical modes frequency series for the waveform */
   UNUSED REAL8 phiRef,                      /**<< orbital reference phase */
@@ -601,12 +616,10 @@ static int TP_Spline_interpolation_3d(
   gsl_bspline_workspace *bwy=splinedata->bwy;
   gsl_bspline_workspace *bwz=splinedata->bwz;
 
-  int N = ncx*ncy*ncz;  // Size of the data matrix for one SVD-mode
   // Evaluate the TP spline for all SVD modes - amplitude
-  for (int k=0; k<nk; k++) { // For each SVD mode
-    gsl_vector v = gsl_vector_subvector(cvec, k*N, N).vector; // Pick out the coefficient matrix corresponding to the k-th SVD mode.
-    REAL8 csum = Interpolate_Coefficent_Tensor(&v, q, chi1, chi2, ncy, ncz, bwx, bwy, bwz);
-    gsl_vector_set(c_out, k, csum);
+  if (Interpolate_Coefficent_Tensors(c_out, cvec, nk, q, chi1, chi2, ncx, ncy, ncz, bwx, bwy, bwz) != XLAL_SUCCESS) {
+    SplineData_Destroy(splinedata);
+    XLAL_ERROR(XLAL_EFUNC);
   }
   SplineData_Destroy(splinedata);
 
@@ -1591,6 +1604,62 @@ UNUSED static int SEOBNRv4HMROMCoreModeAmpPhaseSplines(
 }
 
 
+/**
+ * Assemble the (l,-m) mode, which in the LAL convention has support for f > 0,
+ * from the amplitude and phase splines of the ROM (l,m) mode.
+ * The mode is evaluated at the frequencies of freqs in (Mf_min, Mf_max] and
+ * stored at index i + offset for the frequency freqs->data[i]; other
+ * elements of hlmdata are left unchanged.  Since freqs may not be ordered,
+ * the frequencies in range are gathered first and evaluated together.
+ */
+static int SEOBNRv4HMROM_AssembleMode(
+  COMPLEX16 *hlmdata, /**< Output: mode data */
+  const REAL8Sequence *freqs, /**< Geometric frequencies */
+  UINT4 offset, /**< Index shift between freqs and hlmdata */
+  REAL8 Mf_min, /**< Geometric frequency above which the mode is evaluated */
+  REAL8 Mf_max, /**< Highest geometric frequency at which the mode is evaluated */
+  gsl_spline *spline_amp, /**< Amplitude spline of the mode */
+  gsl_spline *spline_phase, /**< Phase spline of the mode, on the same knots */
+  REAL8 amp0, /**< Amplitude prefactor */
+  REAL8 t_corr, /**< Time shift undoing the alignment of the ROM */
+  UINT4 modeL, /**< Mode number l */
+  UINT4 modeM, /**< Mode number m */
+  REAL8 sign_odd_modes /**< Sign of the odd-m modes, used when swapping the two bodies */
+)
+{
+  UINT4 n = 0;
+  UINT4 *idx = XLALMalloc(freqs->length * sizeof(*idx));
+  REAL8 *f = XLALMalloc(freqs->length * sizeof(*f));
+  COMPLEX16 *h = XLALMalloc(freqs->length * sizeof(*h));
+  if (!idx || !f || !h) {
+    XLALFree(idx);
+    XLALFree(f);
+    XLALFree(h);
+    XLAL_ERROR(XLAL_ENOMEM);
+  }
+  for (UINT4 i=0; i<freqs->length; i++) {
+    if (freqs->data[i] > Mf_max || freqs->data[i] <= Mf_min) continue;
+    idx[n] = i;
+    f[n++] = freqs->data[i];
+  }
+
+  // We use the equation h(l,-m)(f) = (-1)^l h(l,m)*(-f) with f > 0, where
+  // h(l,m)(f) = A(f) exp(I*phase(f)) exp(-2 pi I f t_corr); sign_odd_modes
+  // changes the sign of the odd-m modes in the case m1 < m2
+  REAL8 sign = (modeL % 2 ? -1. : 1.) * (modeM % 2 ? sign_odd_modes : 1.);
+  int ret = ROM_EvaluateModeFromAmpPhaseSplines(h, f, n, spline_amp,
+    spline_phase, sign*amp0, 2.*LAL_PI*t_corr, 0.);
+  if (ret == XLAL_SUCCESS)
+    for (UINT4 k=0; k<n; k++)
+      hlmdata[idx[k] + offset] = h[k];
+
+  XLALFree(idx);
+  XLALFree(f);
+  XLALFree(h);
+  if (ret != XLAL_SUCCESS) XLAL_ERROR(XLAL_EFUNC);
+  return XLAL_SUCCESS;
+}
+
 /**
 * Core function for computing the ROM modes.
 * It rebuilds the modes starting from "orbital phase" and co-orbital modes.
@@ -1717,33 +1786,20 @@ UNUSED static int SEOBNRv4HMROMCoreModes(
     // Shorthands for amplitude and phase splines for this mode
     gsl_spline *spline_amp = ampPhaseSplineData[nMode]->spline_amp;
     gsl_spline *spline_phase = ampPhaseSplineData[nMode]->spline_phi;
-    gsl_interp_accel *acc_amp = ampPhaseSplineData[nMode]->acc_amp;
-    gsl_interp_accel *acc_phase = ampPhaseSplineData[nMode]->acc_phi;
     // gsl_vector *freq_cmode_hyb = ampPhaseSplineData[nMode]->f;
 
     // Maximum frequency at which we have data for the ROM
     REAL8 Mf_max_mode = const_fmax_lm[nMode] * Get_omegaQNM_SEOBNRv4(q, chi1, chi2, modeL, modeM) / (2.*LAL_PI);
 
     // Assemble modes from amplitude and phase
-    for (UINT4 i=0; i<freqs->length; i++) { // loop over frequency points in sequence
-      REAL8 f = freqs->data[i];
-      if (f > Mf_max_mode) continue; // We're beyond the highest allowed frequency; since freqs may not be ordered, we'll just skip the current frequency and leave zero in the buffer
-      if (f <= Mf_low_22 * modeM/2.) continue; // We're above the lowest allowed frequency; since freqs may not be ordered, we'll just skip the current frequency and leave zero in the buffer
-      int j = i + offset; // shift index for frequency series if needed
-      REAL8 A = gsl_spline_eval(spline_amp, f, acc_amp);
-      REAL8 phase = gsl_spline_eval(spline_phase, f, acc_phase);
-      hlmdata[j] = amp0*A * (cos(phase) + I*sin(phase));//cexp(I*phase);
-      REAL8 phase_factor = -2.*LAL_PI*f*t_corr;
-      COMPLEX16 t_factor = cos(phase_factor) + I*sin(phase_factor);
-      hlmdata[j] *= t_factor;
-      // We now return the (l,-m) mode that in the LAL convention has support for f > 0
-      // We use the equation h(l,-m)(f) = (-1)^l h(l,m)*(-f) with f > 0
-      hlmdata[j] = pow(-1.,modeL)*conj(hlmdata[j]);
-      if(modeM%2 != 0){
-        // This is changing the sign of the odd-m modes in the case m1 < m2,
-        // if m1>m2 sign_odd_modes = 1 and nothing changes.
-        hlmdata[j] = hlmdata[j]*sign_odd_modes;
-      }
+    retcode = SEOBNRv4HMROM_AssembleMode(hlmdata, freqs, offset,
+      Mf_low_22 * modeM/2., Mf_max_mode, spline_amp, spline_phase,
+      amp0, t_corr, modeL, modeM, sign_odd_modes);
+    if(retcode != XLAL_SUCCESS) {
+      XLALDestroyREAL8Sequence(freqs);
+      XLALDestroyCOMPLEX16FrequencySeries(hlmtilde);
+      AmpPhaseSplineData_Destroy(ampPhaseSplineData, nModes);
+      XLAL_ERROR(retcode);
     }
     /* Save the mode (l,-m) in the SphHarmFrequencySeries structure */
     *hlm_list = XLALSphHarmFrequencySeriesAddMode(*hlm_list, hlmtilde, modeL, -modeM);
@@ -1858,18 +1914,34 @@ static int SEOBROMComputehplushcrossFromhlm(
     REAL8 inc,  /**<< Input: inclination */
     UNUSED REAL8 phi   /**<< Input: phase */
 ) {
-  /* Loop over modes */
+  /* Collect the modes in the ModeArray structure, with their factors as in
+   * XLALSimAddModeFD() with equatorial symmetry, and add them all in a
+   * single pass over the frequencies */
+  UINT4 nmodes = 0;
+  COMPLEX16 *modes[NMODES];
+  COMPLEX16 factorp[NMODES], factorc[NMODES];
+  size_t npts = hplusFS->data->length;
   SphHarmFrequencySeries *hlms_temp = hlm;
   while ( hlms_temp ) {
     if (XLALSimInspiralModeArrayIsModeActive(ModeArray, hlms_temp->l, hlms_temp->m) == 1) {
         /* Here we check if the mode generated is in the ModeArray structure */
-        XLALSimAddModeFD(hplusFS, hcrossFS, hlms_temp->mode, inc, LAL_PI/2. - phi,
-          hlms_temp->l, hlms_temp->m, 1);
+        INT4 l = hlms_temp->l, m = hlms_temp->m;
+        XLAL_CHECK(nmodes < NMODES, XLAL_EMAXITER, "Too many modes in list");
+        XLAL_CHECK(hlms_temp->mode->data->length == npts, XLAL_EBADLEN,
+          "Length of mode (%d,%d) differs from the length of hplus", l, m);
+        COMPLEX16 Y = XLALSpinWeightedSphericalHarmonic(inc, LAL_PI/2. - phi, -2, l, m);
+        COMPLEX16 Ymstar = conj(XLALSpinWeightedSphericalHarmonic(inc, LAL_PI/2. - phi, -2, l, -m));
+        REAL8 minus1l = l % 2 ? -1. : 1.;
+        modes[nmodes] = hlms_temp->mode->data->data;
+        factorp[nmodes] = 0.5 * (Y + minus1l * Ymstar);
+        factorc[nmodes] = I * 0.5 * (Y - minus1l * Ymstar);
+        nmodes++;
       }
       hlms_temp = hlms_temp->next;
   }
 
-  return XLAL_SUCCESS;
+  return ROM_CombineModesFD(hplusFS->data->data, hcrossFS->data->data,
+    modes, factorp, factorc, nmodes, npts);
 }
 
 /*
@@ -2379,10 +2451,6 @@ UNUSED static int SEOBNRv4HMROMCoreModesHybridized(
       f_hyb_win_lo, f_hyb_win_hi
     );
 
-    // Set up accelerators for spline evaluation in the loop below
-    gsl_interp_accel *acc_amp = gsl_interp_accel_alloc();
-    gsl_interp_accel *acc_phase = gsl_interp_accel_alloc();
-
     // Set up data structure for current mode for Nyquist or user specified frequency grids
     size_t npts = 0;
     LIGOTimeGPS tC = {0, 0};
@@ -2443,35 +2511,16 @@ UNUSED static int SEOBNRv4HMROMCoreModesHybridized(
     double Mf_max_mode = const_fmax_lm[k] * Get_omegaQNM_SEOBNRv4(
       q, chi1, chi2, modeL, modeM) / (2.0*LAL_PI);
 
-    // Loop over frequency points in sequence
-    for (UINT4 i=0; i < freqs->length; i++) {
-      double f = freqs->data[i];
-      if (f > Mf_max_mode) continue; // We're beyond the highest allowed frequency; since freqs may not be ordered, we'll just skip the current frequency and leave zero in the buffer
-      int j = i + offset; // shift index for frequency series if needed
-
-      // Assemble mode from amplitude and phase
-      REAL8 A = gsl_spline_eval(hybrid_spline_amp[k], f, acc_amp);
-      REAL8 phase = gsl_spline_eval(hybrid_spline_phi[k], f, acc_phase);
-      hlmdata[j] = amp0*A * (cos(phase) + I*sin(phase));
-      REAL8 phase_factor = -2.0*LAL_PI * f * t_corr;
-      COMPLEX16 t_factor = cos(phase_factor) + I*sin(phase_factor);
-      hlmdata[j] *= t_factor;
-      // We now return the (l,-m) mode that in the LAL convention has support for f > 0
-      // We use the equation h(l,-m)(f) = (-1)^l h(l,m)*(-f) with f > 0
-      hlmdata[j] = pow(-1.0, modeL) * conj(hlmdata[j]);
-      if(modeM%2 != 0){
-        // This is changing the sign of the odd-m modes in the case m1 < m2.
-        // If m1>m2 sign_odd_modes = 1 and nothing changes
-        hlmdata[j] = hlmdata[j] * sign_odd_modes;
-      }
-    }
+    // Assemble mode from amplitude and phase at the frequency points in sequence
+    retcode = SEOBNRv4HMROM_AssembleMode(hlmdata, freqs, offset,
+      -INFINITY, Mf_max_mode, hybrid_spline_amp[k], hybrid_spline_phi[k],
+      amp0, t_corr, modeL, modeM, sign_odd_modes);
+    if(retcode != XLAL_SUCCESS) XLAL_ERROR(retcode);
     /* Save the mode (l,-m) in the SphHarmFrequencySeries structure */
     *hlm_list = XLALSphHarmFrequencySeriesAddMode(*hlm_list, hlmtilde, modeL, -modeM);
 
     // Cleanup
     XLALDestroyCOMPLEX16FrequencySeries(hlmtilde);
-    gsl_interp_accel_free(acc_amp);
-    gsl_interp_accel_free(acc_phase);
     gsl_vector_free(PNamp);
     gsl_vector_free(PNphase);
     XLALDestroyREAL8Sequence(freqs);
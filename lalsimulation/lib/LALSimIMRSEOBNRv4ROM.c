@@ -74,6 +74,7 @@ static const INT4 ROMDataHDF5_VERSION_MICRO = 0;
 
 #ifdef LAL_PTHREAD_LOCK
 static pthread_once_t SEOBNRv4ROM_is_initialized = PTHREAD_ONCE_INIT;
+static pthread_mutex_t SEOBNRv4ROM_submodel_lock = PTHREAD_MUTEX_INITIALIZER;
 #endif
 
 /*************** type definitions ******************/
@@ -101,6 +102,9 @@ struct tagSEOBNRROMdataDS_submodel
   double eta_bounds[2];      // [eta_min, eta_max]
   double chi1_bounds[2];     // [chi1_min, chi1_max]
   double chi2_bounds[2];     // [chi2_min, chi2_max]
+  char *path;                // ROM data file, for loading the coefficients and bases
+  const char *grp_name;      // Group of the submodel in the ROM data file
+  int loaded;                // Whether the coefficients and bases have been loaded
 };
 typedef struct tagSEOBNRROMdataDS_submodel SEOBNRROMdataDS_submodel;
 
@@ -161,6 +165,7 @@ UNUSED static int SEOBNRROMdataDS_Init_submodel(
 );
 
 UNUSED static void SEOBNRROMdataDS_Cleanup_submodel(SEOBNRROMdataDS_submodel *submodel);
+UNUSED static int SEOBNRROMdataDS_Load_submodel(SEOBNRROMdataDS_submodel *submodel);
 
 /**
  * Core function for computing the ROM waveform.
@@ -377,19 +382,16 @@ static int TP_Spline_interpolation_3d(
   gsl_bspline_workspace *bwy=splinedata->bwy;
   gsl_bspline_workspace *bwz=splinedata->bwz;
 
-  int N = ncx*ncy*ncz;  // Size of the data matrix for one SVD-mode
   // Evaluate the TP spline for all SVD modes - amplitude
-  for (int k=0; k<nk_amp; k++) { // For each SVD mode
-    gsl_vector v = gsl_vector_subvector(cvec_amp, k*N, N).vector; // Pick out the coefficient matrix corresponding to the k-th SVD mode.
-    REAL8 csum = Interpolate_Coefficent_Tensor(&v, eta, chi1, chi2, ncy, ncz, bwx, bwy, bwz);
-    gsl_vector_set(c_amp, k, csum);
+  if (Interpolate_Coefficent_Tensors(c_amp, cvec_amp, nk_amp, eta, chi1, chi2, ncx, ncy, ncz, bwx, bwy, bwz) != XLAL_SUCCESS) {
+    SplineData_Destroy(splinedata);
+    XLAL_ERROR(XLAL_EFUNC);
   }
 
   // Evaluate the TP spline for all SVD modes - phase
-  for (int k=0; k<nk_phi; k++) {  // For each SVD mode
-    gsl_vector v = gsl_vector_subvector(cvec_phi, k*N, N).vector; // Pick out the coefficient matrix corresponding to the k-th SVD mode.
-    REAL8 csum = Interpolate_Coefficent_Tensor(&v, eta, chi1, chi2, ncy, ncz, bwx, bwy, bwz);
-    gsl_vector_set(c_phi, k, csum);
+  if (Interpolate_Coefficent_Tensors(c_phi, cvec_phi, nk_phi, eta, chi1, chi2, ncx, ncy, ncz, bwx, bwy, bwz) != XLAL_SUCCESS) {
+    SplineData_Destroy(splinedata);
+    XLAL_ERROR(XLAL_EFUNC);
   }
 
   SplineData_Destroy(splinedata);
@@ -397,7 +399,11 @@ static int TP_Spline_interpolation_3d(
   return(0);
 }
 
-/* Set up a new ROM submodel, using data contained in dir */
+/* Set up a new ROM submodel, using data contained in dir.  Only the
+ * frequency and parameter space grids are read here;  the much larger
+ * coefficients and bases are read by SEOBNRROMdataDS_Load_submodel() when
+ * the submodel is first used, so that a process only loads the submodels
+ * covering the part of the parameter space it visits. */
 UNUSED static int SEOBNRROMdataDS_Init_submodel(
   SEOBNRROMdataDS_submodel **submodel,
   UNUSED const char dir[],
@@ -420,14 +426,6 @@ UNUSED static int SEOBNRROMdataDS_Init_submodel(
   LALH5File *file = XLALH5FileOpen(path, "r");
   LALH5File *sub = XLALH5GroupOpen(file, grp_name);
 
-  // Read ROM coefficients
-  ReadHDF5RealVectorDataset(sub, "Amp_ciall", & (*submodel)->cvec_amp);
-  ReadHDF5RealVectorDataset(sub, "Phase_ciall", & (*submodel)->cvec_phi);
-
-  // Read ROM basis functions
-  ReadHDF5RealMatrixDataset(sub, "Bamp", & (*submodel)->Bamp);
-  ReadHDF5RealMatrixDataset(sub, "Bphase", & (*submodel)->Bphi);
-
   // Read sparse frequency points
   ReadHDF5RealVectorDataset(sub, "Mf_grid_Amp", & (*submodel)->gA);
   ReadHDF5RealVectorDataset(sub, "Mf_grid_Phi", & (*submodel)->gPhi);
@@ -452,7 +450,11 @@ UNUSED static int SEOBNRROMdataDS_Init_submodel(
   (*submodel)->chi2_bounds[0] = gsl_vector_get((*submodel)->chi2vec, 0);
   (*submodel)->chi2_bounds[1] = gsl_vector_get((*submodel)->chi2vec, (*submodel)->chi2vec->size - 1);
 
-  XLALFree(path);
+  // Keep the location of the coefficients and bases
+  (*submodel)->path = path;
+  (*submodel)->grp_name = grp_name;
+  (*submodel)->loaded = 0;
+
   XLALH5FileClose(file);
   ret = XLAL_SUCCESS;
 #else
@@ -462,6 +464,53 @@ UNUSED static int SEOBNRROMdataDS_Init_submodel(
   return ret;
 }
 
+/* Read the coefficients and bases of a ROM submodel, if not read already */
+static int SEOBNRROMdataDS_Load_submodel(SEOBNRROMdataDS_submodel *submodel) {
+  int ret = XLAL_SUCCESS;
+
+#ifdef LAL_PTHREAD_LOCK
+  (void) pthread_mutex_lock(&SEOBNRv4ROM_submodel_lock);
+#endif
+
+  if (!submodel->loaded) {
+#ifdef LAL_HDF5_ENABLED
+    LALH5File *file = XLALH5FileOpen(submodel->path, "r");
+    LALH5File *sub = file ? XLALH5GroupOpen(file, submodel->grp_name) : NULL;
+
+    if (!sub)
+      ret = XLAL_EIO;
+    else {
+      // Read ROM coefficients
+      ReadHDF5RealVectorDataset(sub, "Amp_ciall", &submodel->cvec_amp);
+      ReadHDF5RealVectorDataset(sub, "Phase_ciall", &submodel->cvec_phi);
+
+      // Read ROM basis functions
+      ReadHDF5RealMatrixDataset(sub, "Bamp", &submodel->Bamp);
+      ReadHDF5RealMatrixDataset(sub, "Bphase", &submodel->Bphi);
+
+      if (submodel->cvec_amp && submodel->cvec_phi && submodel->Bamp && submodel->Bphi) {
+        submodel->loaded = 1;
+        XLALPrintInfo("%s : submodel %s loaded successfully.\n", __func__, submodel->grp_name);
+      }
+      else
+        ret = XLAL_EIO;
+    }
+    XLALH5FileClose(sub);
+    XLALH5FileClose(file);
+#else
+    ret = XLAL_EFAILED;
+#endif
+  }
+
+#ifdef LAL_PTHREAD_LOCK
+  (void) pthread_mutex_unlock(&SEOBNRv4ROM_submodel_lock);
+#endif
+
+  if (ret != XLAL_SUCCESS)
+    XLAL_ERROR(ret, "Unable to read SEOBNRv4ROM submodel %s from %s", submodel->grp_name, submodel->path);
+  return ret;
+}
+
 /* Deallocate contents of the given SEOBNRROMdataDS_submodel structure */
 static void SEOBNRROMdataDS_Cleanup_submodel(SEOBNRROMdataDS_submodel *submodel) {
   if(submodel->cvec_amp) gsl_vector_free(submodel->cvec_amp);
@@ -473,6 +522,8 @@ static void SEOBNRROMdataDS_Cleanup_submodel(SEOBNRROMdataDS_submodel *submodel)
   if(submodel->etavec)  gsl_vector_free(submodel->etavec);
   if(submodel->chi1vec) gsl_vector_free(submodel->chi1vec);
   if(submodel->chi2vec) gsl_vector_free(submodel->chi2vec);
+  XLALFree(submodel->path);
+  memset(submodel, 0, sizeof(*submodel));
 }
 
 /* Set up a new ROM model, using data contained in dir */
@@ -506,13 +557,13 @@ int SEOBNRROMdataDS_Init(
   XLALH5FileClose(file);
 
   ret |= SEOBNRROMdataDS_Init_submodel(&(romdata)->sub1, dir, "sub1");
-  if (ret==XLAL_SUCCESS) XLALPrintInfo("%s : submodel 1 loaded successfully.\n", __func__);
+  if (ret==XLAL_SUCCESS) XLALPrintInfo("%s : submodel 1 set up successfully.\n", __func__);
 
   ret |= SEOBNRROMdataDS_Init_submodel(&(romdata)->sub2, dir, "sub2");
-  if (ret==XLAL_SUCCESS) XLALPrintInfo("%s : submodel 2 loaded successfully.\n", __func__);
+  if (ret==XLAL_SUCCESS) XLALPrintInfo("%s : submodel 2 set up successfully.\n", __func__);
 
   ret |= SEOBNRROMdataDS_Init_submodel(&(romdata)->sub3, dir, "sub3");
-  if (ret==XLAL_SUCCESS) XLALPrintInfo("%s : submodel 3 loaded successfully.\n", __func__);
+  if (ret==XLAL_SUCCESS) XLALPrintInfo("%s : submodel 3 set up successfully.\n", __func__);
 
   if(XLAL_SUCCESS==ret)
     romdata->setup=1;
@@ -809,6 +860,10 @@ static int SEOBNRv4ROMCore(
   else
     submodel_hi = romdata->sub3;
 
+  /* Read the coefficients and bases of the submodels on first use */
+  if (SEOBNRROMdataDS_Load_submodel(submodel_lo) != XLAL_SUCCESS || SEOBNRROMdataDS_Load_submodel(submodel_hi) != XLAL_SUCCESS)
+    XLAL_ERROR(XLAL_EFUNC);
+
 
   /* Find frequency bounds */
   if (!freqs_in) XLAL_ERROR(XLAL_EFAULT);
@@ -1342,6 +1397,10 @@ static int SEOBNRv4ROMTimeFrequencySetup(
   else
     submodel_hi = romdata->sub3;
 
+  /* Read the coefficients and bases of the submodels on first use */
+  if (SEOBNRROMdataDS_Load_submodel(submodel_lo) != XLAL_SUCCESS || SEOBNRROMdataDS_Load_submodel(submodel_hi) != XLAL_SUCCESS)
+    XLAL_ERROR(XLAL_EFUNC);
+
   /* Internal storage for waveform coefficiencts */
   SEOBNRROMdataDS_coeff *romdata_coeff_lo=NULL;
   SEOBNRROMdataDS_coeff *romdata_coeff_hi=NULL;
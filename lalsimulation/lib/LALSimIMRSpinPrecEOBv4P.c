@@ -4312,10 +4312,7 @@ static int SEOBRotatehIlmFromhJlm(
     REAL8 deltaT              /**<< Input: time step, necessary to initialize new timeseries */
 ) {
 
-  UINT4 i;
-  INT4 l, m, mp;
-  REAL8 amp_wigner = 0., phase_wigner = 0.;
-  COMPLEX16 D_wigner = 0.;
+  INT4 l, m;
   UINT4 retLen = hJlm->tdata->length;
   REAL8 *tJdata = hJlm->tdata->data;
 
@@ -4323,7 +4320,8 @@ static int SEOBRotatehIlmFromhJlm(
   REAL8Vector *tI = XLALCreateREAL8Vector(retLen);
   memcpy(tI->data, tJdata, retLen * sizeof(REAL8));
 
-  /* Create output list of timeseries, with all (l,m) up to modes_lmax */
+  /* Create output list of timeseries, with all (l,m) up to modes_lmax,
+   * initialized with the hJlm modes */
   *hIlm = NULL;
   LIGOTimeGPS tGPS = LIGOTIMEGPSZERO;
   char mode_string[32];
@@ -4332,7 +4330,9 @@ static int SEOBRotatehIlmFromhJlm(
       sprintf(mode_string, "H_%d%d", l, m);
       COMPLEX16TimeSeries *hIlm_TS = XLALCreateCOMPLEX16TimeSeries(
           mode_string, &tGPS, 0., deltaT, &lalStrainUnit, retLen);
-      memset(hIlm_TS->data->data, 0, retLen * sizeof(COMPLEX16));
+      COMPLEX16TimeSeries *hJlm_TS = XLALSphHarmTimeSeriesGetMode(hJlm, l, m);
+      memcpy(hIlm_TS->data->data, hJlm_TS->data->data,
+             retLen * sizeof(COMPLEX16));
 
       /* Note: with the AddMode function, data is copied over */
       *hIlm = XLALSphHarmTimeSeriesAddMode(*hIlm, hIlm_TS, l, m);
@@ -4346,42 +4346,13 @@ static int SEOBRotatehIlmFromhJlm(
   XLALSphHarmTimeSeriesSetTData(*hIlm, tI);
 
   /* Main computation */
-  /* hIlm = \sum_mp Dlmpm hJlmp */
-
-  COMPLEX16TimeSeries *hIlmmode = NULL;
-  COMPLEX16TimeSeries *hJlmpmode = NULL;
-  COMPLEX16 *hIlmmode_data = NULL;
-  COMPLEX16 *hJlmpmode_data = NULL;
-
-  /* Loop on l */
-  for (l = 2; l <= modes_lmax; l++) {
-
-    /* Loop on m */
-    for (m = -l; m <= l; m++) {
-
-      /* Get hJlm mode */
-      hIlmmode = XLALSphHarmTimeSeriesGetMode(*hIlm, l, m);
-      hIlmmode_data = hIlmmode->data->data;
-
-      /* Loop on mp - exclude value 0, since hPl0=0 in our approximation */
-      for (mp = -l; mp <= l; mp++) {
-
-        /* Get hJlm mode */
-        hJlmpmode = XLALSphHarmTimeSeriesGetMode(hJlm, l, mp);
-        hJlmpmode_data = hJlmpmode->data->data;
-
-        /* Compute constant Wigner coefficient */
-        amp_wigner = SEOBWignerDAmp(l, m, mp, betaI2J);
-        phase_wigner = SEOBWignerDPhase(m, mp, alphaI2J, gammaI2J);
-        D_wigner = amp_wigner *
-                   cexp(-I * phase_wigner); /* mind the conjugation Dlmmpstar */
-
-        /* Evaluate mode contribution */
-        for (i = 0; i < retLen; i++) {
-          hIlmmode_data[i] += D_wigner * hJlmpmode_data[i];
-        }
-      }
-    }
+  /* hIlm = \sum_mp Dlmpm hJlmp, with Dlmpm = d^l_{m,mp}(beta) e^{-i (m alpha
+   * + mp gamma)}: this is the Wigner-D rotation of LALSimInspiralPrecess.c
+   * with Euler angles (gamma, -beta, alpha) */
+  if (XLALSimInspiralPrecessionRotateModesFixed(*hIlm, gammaI2J, -betaI2J,
+                                                alphaI2J) != XLAL_SUCCESS) {
+    XLAL_ERROR(XLAL_EFUNC,
+               "Error: XLALSimInspiralPrecessionRotateModesFixed failed.");
   }
 
   return XLAL_SUCCESS;
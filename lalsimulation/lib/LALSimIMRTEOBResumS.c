@@ -31,9 +31,9 @@
 #define UNUSED
 #endif
 
-//#ifndef _OPENMP
-//#define omp ignore
-//#endif
+#ifndef _OPENMP
+#define omp ignore
+#endif
 
 #include <complex.h>
 #include <math.h>
@@ -946,44 +946,39 @@ END_ODE_EVOLUTION:;
      */
     if (interp_uniform_grid == INTERP_UNIFORM_GRID_HLM)
     {
-      //#pragma omp parallel
-      //{
-      /* Interpolate ampl and phase */
-        //#pragma omp single private(this_hlm)
-        //{
-          this_hlm = hlm;
-          while (this_hlm)
+      /* Interpolate ampl and phase; the modes are independent, so they are
+       * interpolated in parallel */
+      SphHarmPolarTimeSeries *modes[KMAX];
+      INT4 nmodes = 0;
+      INT4 failed = 0;
+      for (this_hlm = hlm; this_hlm && nmodes < KMAX; this_hlm = this_hlm->next)
+          modes[nmodes++] = this_hlm;
+      XLAL_CHECK(this_hlm == NULL, XLAL_EFAULT, "More modes present than expected.\n");
+
+      #pragma omp parallel for schedule(dynamic) reduction(|:failed)
+      for (INT4 k = 0; k < nmodes; k++)
+      {
+          /* Interpolate mode amplitude and phase and replace */
+          REAL8TimeSeries *A_ut = XLALCreateREAL8TimeSeries(modes[k]->ampl->name, &epoch, 0, deltaT, &(lalStrainUnit), (size_t) size_out);
+          REAL8TimeSeries *phi_ut = XLALCreateREAL8TimeSeries(modes[k]->phase->name, &epoch, 0, deltaT, &(lalDimensionlessUnit), (size_t) size_out);
+          if (!A_ut || !phi_ut)
           {
-            //#pragma omp task
-            //{
-              //fprintf(stderr, "In thread%d/%d\n", omp_get_thread_num(), omp_get_num_threads());
-                REAL8TimeSeries *A_ut=NULL;
-                REAL8TimeSeries *phi_ut=NULL;
-                /* Interpolate mode amplitude and replace */
-                A_ut = XLALCreateREAL8TimeSeries(this_hlm->ampl->name, &epoch, 0, deltaT, &(lalStrainUnit), (size_t) size_out);
-                // XLAL_CHECK (A_ut, XLAL_ENOMEM, "Could not allocate memory for hlm amplitude data.\n");
-                interp_spline(tdata->data, this_hlm->ampl->data->data, size, utime->data,
-                              size_out, A_ut->data->data);
-                XLALDestroyREAL8TimeSeries(this_hlm->ampl);
-                this_hlm->ampl = A_ut;
-
-                /* Interpolate mode phase and replace */
-                phi_ut = XLALCreateREAL8TimeSeries(this_hlm->phase->name, &epoch, 0, deltaT, &(lalDimensionlessUnit), (size_t) size_out);
-                // XLAL_CHECK (phi_ut, XLAL_ENOMEM, "Could not allocate memory for hlm phase data.\n");
-                interp_spline(tdata->data, this_hlm->phase->data->data, size, utime->data,
-                              size_out, phi_ut->data->data);
-                XLALDestroyREAL8TimeSeries(this_hlm->phase);
-                this_hlm->phase = phi_ut;
-
-                A_ut = NULL;
-                phi_ut = NULL;
-                XLALDestroyREAL8TimeSeries(A_ut);
-                XLALDestroyREAL8TimeSeries(phi_ut);
-              //}
-              this_hlm = this_hlm->next;
-              }
-          //}
-        //}
+              XLALDestroyREAL8TimeSeries(A_ut);
+              XLALDestroyREAL8TimeSeries(phi_ut);
+              failed = 1;
+              continue;
+          }
+          interp_spline(tdata->data, modes[k]->ampl->data->data, size, utime->data,
+                        size_out, A_ut->data->data);
+          XLALDestroyREAL8TimeSeries(modes[k]->ampl);
+          modes[k]->ampl = A_ut;
+
+          interp_spline(tdata->data, modes[k]->phase->data->data, size, utime->data,
+                        size_out, phi_ut->data->data);
+          XLALDestroyREAL8TimeSeries(modes[k]->phase);
+          modes[k]->phase = phi_ut;
+      }
+      XLAL_CHECK(!failed, XLAL_ENOMEM, "Could not allocate memory for hlm data.\n");
 
         /* Replace time sequence */
         size = size_out;
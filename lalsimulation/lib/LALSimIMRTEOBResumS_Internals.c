@@ -3331,32 +3331,32 @@ void eob_wav_hlmNQC_find_a1a2a3(LALTEOBResumSDynamics *dyn, SphHarmPolarTimeSeri
     }
 
     REAL8 *omg[KMAX], *domg[KMAX];
-    REAL8 *n1,*n2,*n3,*n4,*n5,*n6, *d_n4,*d_n5, *d2_n4,*d2_n5;
-    REAL8 *m11[KMAX], *m12[KMAX], *m13[KMAX], *m21[KMAX], *m22[KMAX];
+    REAL8 *n1,*n2,*n4,*n5, *d_n4,*d_n5, *d2_n4,*d2_n5;
+    REAL8 *m11[KMAX], *m12[KMAX], *m21[KMAX], *m22[KMAX];
     REAL8 *p1tmp[KMAX], *p2tmp[KMAX]; /* RWZ amplitude and derivative */
 
+    /* all the work arrays share one allocation */
+    REAL8 *work = XLALCalloc ((8*KMAX + 8) * (size_t) size, sizeof(REAL8));
+    XLAL_CHECK_VOID(work, XLAL_ENOMEM, "Could not allocate NQC work arrays.");
     for (int k=0; k<KMAX; k++) {
-        omg[k]  = (REAL8*) calloc (size,sizeof(REAL8));
-        domg[k] = (REAL8*) calloc (size,sizeof(REAL8));
-        m11[k] = (REAL8*) calloc (size,sizeof(REAL8));
-        m12[k] = (REAL8*) calloc (size,sizeof(REAL8));
-        m13[k] = (REAL8*) calloc (size,sizeof(REAL8));
-        m21[k] = (REAL8*) calloc (size,sizeof(REAL8));
-        m22[k] = (REAL8*) calloc (size,sizeof(REAL8));
-        p1tmp[k] = (REAL8*) calloc (size,sizeof(REAL8));
-        p2tmp[k] = (REAL8*) calloc (size,sizeof(REAL8));
+        omg[k]   = work + (8*k + 0) * (size_t) size;
+        domg[k]  = work + (8*k + 1) * (size_t) size;
+        m11[k]   = work + (8*k + 2) * (size_t) size;
+        m12[k]   = work + (8*k + 3) * (size_t) size;
+        m21[k]   = work + (8*k + 4) * (size_t) size;
+        m22[k]   = work + (8*k + 5) * (size_t) size;
+        p1tmp[k] = work + (8*k + 6) * (size_t) size;
+        p2tmp[k] = work + (8*k + 7) * (size_t) size;
     }
 
-    n1 = (REAL8*) calloc (size,sizeof(REAL8));
-    n2 = (REAL8*) calloc (size,sizeof(REAL8));
-    n3 = (REAL8*) calloc (size,sizeof(REAL8));
-    n4 = (REAL8*) calloc (size,sizeof(REAL8));
-    n5 = (REAL8*) calloc (size,sizeof(REAL8));
-    n6 = (REAL8*) calloc (size,sizeof(REAL8));
-    d_n4 = (REAL8*) calloc (size,sizeof(REAL8));
-    d_n5 = (REAL8*) calloc (size,sizeof(REAL8));
-    d2_n4 = (REAL8*) calloc (size,sizeof(REAL8));
-    d2_n5 = (REAL8*) calloc (size,sizeof(REAL8));
+    n1    = work + (8*KMAX + 0) * (size_t) size;
+    n2    = work + (8*KMAX + 1) * (size_t) size;
+    n4    = work + (8*KMAX + 2) * (size_t) size;
+    n5    = work + (8*KMAX + 3) * (size_t) size;
+    d_n4  = work + (8*KMAX + 4) * (size_t) size;
+    d_n5  = work + (8*KMAX + 5) * (size_t) size;
+    d2_n4 = work + (8*KMAX + 6) * (size_t) size;
+    d2_n5 = work + (8*KMAX + 7) * (size_t) size;
 
     /* omega derivatives */
     const REAL8 dt = t[1]-t[0];
@@ -3705,27 +3705,7 @@ void eob_wav_hlmNQC_find_a1a2a3(LALTEOBResumSDynamics *dyn, SphHarmPolarTimeSeri
     }
 
     /* Free mem */
-    for (int k=0; k<KMAX; k++) {
-        XLALFree(omg[k]);
-        XLALFree(domg[k]);
-        XLALFree(m11[k]);
-        XLALFree(m12[k]);
-        XLALFree(m13[k]);
-        XLALFree(m21[k]);
-        XLALFree(m22[k]);
-        XLALFree(p1tmp[k]);
-        XLALFree(p2tmp[k]);
-    }
-    XLALFree(n1);
-    XLALFree(n2);
-    XLALFree(n3);
-    XLALFree(n4);
-    XLALFree(n5);
-    XLALFree(n6);
-    XLALFree(d_n4);
-    XLALFree(d_n5);
-    XLALFree(d2_n4);
-    XLALFree(d2_n5);
+    XLALFree(work);
 
 }
 
@@ -3779,33 +3759,32 @@ void eob_wav_hlmNQC_find_a1a2a3_mrg(LALTEOBResumSDynamics *dyn_mrg, SphHarmPolar
     const int size = (int) hlm_mrg->tdata->length;
 
     REAL8 *omg[KMAX], *domg[KMAX];
-    REAL8 *n1,*n2,*n3,*n4,*n5,*n6, *d_n4,*d_n5, *d2_n4,*d2_n5;
-    REAL8 *m11[KMAX], *m12[KMAX], *m13[KMAX], *m21[KMAX], *m22[KMAX];
+    REAL8 *n1,*n2,*n4,*n5, *d_n4,*d_n5, *d2_n4,*d2_n5;
+    REAL8 *m11[KMAX], *m12[KMAX], *m21[KMAX], *m22[KMAX];
     REAL8 *p1tmp[KMAX], *p2tmp[KMAX]; /* RWZ amplitude and derivative */
 
-    for (int k=0; k<KMAX; k++)
-    {
-        omg[k]  = (REAL8*) calloc (size,sizeof(REAL8));
-        domg[k] = (REAL8*) calloc (size,sizeof(REAL8));
-        m11[k]  = (REAL8*) calloc (size,sizeof(REAL8));
-        m12[k]  = (REAL8*) calloc (size,sizeof(REAL8));
-        m13[k]  = (REAL8*) calloc (size,sizeof(REAL8));
-        m21[k]  = (REAL8*) calloc (size,sizeof(REAL8));
-        m22[k]  = (REAL8*) calloc (size,sizeof(REAL8));
-        p1tmp[k] = (REAL8*) calloc (size,sizeof(REAL8));
-        p2tmp[k] = (REAL8*) calloc (size,sizeof(REAL8));
+    /* all the work arrays share one allocation */
+    REAL8 *work = XLALCalloc ((8*KMAX + 8) * (size_t) size, sizeof(REAL8));
+    XLAL_CHECK_VOID(work, XLAL_ENOMEM, "Could not allocate NQC work arrays.");
+    for (int k=0; k<KMAX; k++) {
+        omg[k]   = work + (8*k + 0) * (size_t) size;
+        domg[k]  = work + (8*k + 1) * (size_t) size;
+        m11[k]   = work + (8*k + 2) * (size_t) size;
+        m12[k]   = work + (8*k + 3) * (size_t) size;
+        m21[k]   = work + (8*k + 4) * (size_t) size;
+        m22[k]   = work + (8*k + 5) * (size_t) size;
+        p1tmp[k] = work + (8*k + 6) * (size_t) size;
+        p2tmp[k] = work + (8*k + 7) * (size_t) size;
     }
 
-    n1 = (REAL8*) calloc (size,sizeof(REAL8));
-    n2 = (REAL8*) calloc (size,sizeof(REAL8));
-    n3 = (REAL8*) calloc (size,sizeof(REAL8));
-    n4 = (REAL8*) calloc (size,sizeof(REAL8));
-    n5 = (REAL8*) calloc (size,sizeof(REAL8));
-    n6 = (REAL8*) calloc (size,sizeof(REAL8));
-    d_n4  = (REAL8*) calloc (size,sizeof(REAL8));
-    d_n5  = (REAL8*) calloc (size,sizeof(REAL8));
-    d2_n4 = (REAL8*) calloc (size,sizeof(REAL8));
-    d2_n5 = (REAL8*) calloc (size,sizeof(REAL8));
+    n1    = work + (8*KMAX + 0) * (size_t) size;
+    n2    = work + (8*KMAX + 1) * (size_t) size;
+    n4    = work + (8*KMAX + 2) * (size_t) size;
+    n5    = work + (8*KMAX + 3) * (size_t) size;
+    d_n4  = work + (8*KMAX + 4) * (size_t) size;
+    d_n5  = work + (8*KMAX + 5) * (size_t) size;
+    d2_n4 = work + (8*KMAX + 6) * (size_t) size;
+    d2_n5 = work + (8*KMAX + 7) * (size_t) size;
 
     /* omega derivatives */
     const REAL8 dt = t[1]-t[0];
@@ -4187,17 +4166,17 @@ void eob_wav_hlmNQC_find_a1a2a3_mrg(LALTEOBResumSDynamics *dyn_mrg, SphHarmPolar
     Omg_orb = dyn->data[TEOB_OMGORB]; /* Omega orbital */
     ddotr   = dyn->data[TEOB_DDOTR];
 
-    free(n1);
-    free(n2);
-    free(n4);
-    free(n5);
-
     const INT4 fullsize = hlm->tdata->length;
 
-    n1 = (REAL8*) calloc (fullsize,sizeof(REAL8));
-    n2 = (REAL8*) calloc (fullsize,sizeof(REAL8));
-    n4 = (REAL8*) calloc (fullsize,sizeof(REAL8));
-    n5 = (REAL8*) calloc (fullsize,sizeof(REAL8));
+    REAL8 *fullwork = XLALMalloc (4 * (size_t) fullsize * sizeof(REAL8));
+    if (!fullwork) {
+        XLALFree(work);
+        XLAL_ERROR_VOID(XLAL_ENOMEM, "Could not allocate NQC work arrays.");
+    }
+    n1 = fullwork;
+    n2 = fullwork + fullsize;
+    n4 = fullwork + 2 * (size_t) fullsize;
+    n5 = fullwork + 3 * (size_t) fullsize;
 
     for (int j=0; j<fullsize; j++) {
         pr_star2 = SQ(pr_star[j]);
@@ -4219,28 +4198,8 @@ void eob_wav_hlmNQC_find_a1a2a3_mrg(LALTEOBResumSDynamics *dyn_mrg, SphHarmPolar
     }
 
     /* Free mem */
-    for (int k=0; k<KMAX; k++)
-    {
-        free(omg[k]);
-        free(domg[k]);
-        free(m11[k]);
-        free(m12[k]);
-        free(m13[k]);
-        free(m21[k]);
-        free(m22[k]);
-        free(p1tmp[k]);
-        free(p2tmp[k]);
-    }
-    free(n1);
-    free(n2);
-    free(n3);
-    free(n4);
-    free(n5);
-    free(n6);
-    free(d_n4);
-    free(d_n5);
-    free(d2_n4);
-    free(d2_n5);
+    XLALFree(fullwork);
+    XLALFree(work);
 }
 
 
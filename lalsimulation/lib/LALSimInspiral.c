@@ -32,6 +32,7 @@
 #include <lal/LALSimSphHarmMode.h>
 #include <lal/LALConstants.h>
 #include <lal/LALStdlib.h>
+#include <lal/LALProfile.h>
 #include <lal/LALString.h>
 #include <lal/Sequence.h>
 #include <lal/TimeSeries.h>
@@ -449,6 +450,7 @@ int XLALSimInspiralChooseTDWaveform(
      * otherwise do nothing */
     f_ref = fixReferenceFrequency(f_ref, f_min, approximant);
 
+    XLAL_PROFILE_BEGIN(waveform, "XLALSimInspiralChooseTDWaveform");
     switch (approximant)
     {
         /* non-spinning inspiral-only models */
@@ -1229,6 +1231,7 @@ int XLALSimInspiralChooseTDWaveform(
       }
     }
 
+    XLAL_PROFILE_END(waveform);
     if (ret == XLAL_FAILURE) XLAL_ERROR(XLAL_EFUNC);
 
     return ret;
@@ -1334,6 +1337,7 @@ int XLALSimInspiralChooseFDWaveform(
     cfac = cos(inclination);
     pfac = 0.5 * (1. + cfac*cfac);
 
+    XLAL_PROFILE_BEGIN(waveform, "XLALSimInspiralChooseFDWaveform");
     switch (approximant)
     {
         /* inspiral-only models */
@@ -2354,6 +2358,7 @@ int XLALSimInspiralChooseFDWaveform(
       }
     }
 
+    XLAL_PROFILE_END(waveform);
     if (ret == XLAL_FAILURE) XLAL_ERROR(XLAL_EFUNC);
     if (XLALSimInspiralWaveformParamsLookupEnableLIV(LALparams))
       ret = XLALSimLorentzInvarianceViolationTerm(hptilde, hctilde, m1/LAL_MSUN_SI, m2/LAL_MSUN_SI, distance, LALparams);
@@ -2787,6 +2792,62 @@ int XLALSimInspiralTD(
     return 0;
 }
 
+/**
+ * @brief Cached state for repeated calls to XLALSimInspiralFDConditioned().
+ *
+ * Time-domain approximants are Fourier transformed onto a segment whose
+ * length is a power of two.  The forward FFT plan for the most recently
+ * used length is kept here so that successive calls with similar
+ * parameters do not re-plan the transform.
+ */
+struct tagLALSimInspiralFDConditioning {
+    size_t length;          /**< length of the cached plan (samples) */
+    REAL8FFTPlan *plan;     /**< forward FFT plan of size length */
+};
+
+/**
+ * @brief Creates a context for XLALSimInspiralFDConditioned().
+ *
+ * The context holds no plan until it is first used.  A context may be
+ * reused across any number of calls but must not be shared between threads
+ * without external locking.
+ */
+LALSimInspiralFDConditioning *XLALSimInspiralCreateFDConditioning(void)
+{
+    LALSimInspiralFDConditioning *cond = XLALCalloc(1, sizeof(*cond));
+    if (!cond)
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    return cond;
+}
+
+/**
+ * @brief Destroys a context created by XLALSimInspiralCreateFDConditioning().
+ */
+void XLALSimInspiralDestroyFDConditioning(LALSimInspiralFDConditioning *cond)
+{
+    if (cond) {
+        XLALDestroyREAL8FFTPlan(cond->plan);
+        XLALFree(cond);
+    }
+}
+
+/* return a forward plan of the given length, from the context if there is
+ * one; the plan is owned by the context, otherwise by the caller */
+static REAL8FFTPlan *FDConditioningPlan(LALSimInspiralFDConditioning *cond, size_t length)
+{
+    if (!cond)
+        return XLALCreateForwardREAL8FFTPlan(length, 0);
+    if (!cond->plan || cond->length != length) {
+        XLALDestroyREAL8FFTPlan(cond->plan);
+        cond->length = 0;
+        cond->plan = XLALCreateForwardREAL8FFTPlan(length, 0);
+        if (!cond->plan)
+            return NULL;
+        cond->length = length;
+    }
+    return cond->plan;
+}
+
 /**
  * @brief Generates a frequency domain inspiral waveform using the specified approximant; the
  * resulting waveform is appropriately conditioned and suitable for injection into data.
@@ -2820,10 +2881,13 @@ int XLALSimInspiralTD(
  * applied cosmological "corrections" to m1 and m2 and regards r as a luminosity distance
  * then the redshift factor should again be set to zero.
  *
+ * If cond is not NULL, the Fourier transform of a time-domain approximant
+ * uses the plan cached in cond, creating or replacing it only when the
+ * segment length changes.  If cond is NULL a plan is created for this call.
  *
  * @note The parameters passed must be in SI units.
  */
-int XLALSimInspiralFD(
+int XLALSimInspiralFDConditioned(
     COMPLEX16FrequencySeries **hptilde,     /**< FD plus polarization */
     COMPLEX16FrequencySeries **hctilde,     /**< FD cross polarization */
     REAL8 m1,                               /**< mass of companion 1 (kg) */
@@ -2845,7 +2909,8 @@ int XLALSimInspiralFD(
     REAL8 f_max,                            /**< ending GW frequency (Hz) */
     REAL8 f_ref,                            /**< Reference frequency (Hz) */
     LALDict *LALparams,                     /**< LAL dictionary containing accessory parameters */
-    Approximant approximant                 /**< post-Newtonian approximant to use for waveform production */
+    Approximant approximant,                /**< post-Newtonian approximant to use for waveform production */
+    LALSimInspiralFDConditioning *cond      /**< cached FFT state, or NULL */
     )
 {
 	  XLAL_CHECK(f_max > 0, XLAL_EDOM, "Maximum frequency must be > 0\n");
@@ -3026,14 +3091,23 @@ int XLALSimInspiralFD(
         /* (the units will correct themselves) */
         *hptilde = XLALCreateCOMPLEX16FrequencySeries("FD H_PLUS", &hplus->epoch, 0.0, deltaF, &lalDimensionlessUnit, (size_t) chirplen / 2 + 1);
         *hctilde = XLALCreateCOMPLEX16FrequencySeries("FD H_CROSS", &hcross->epoch, 0.0, deltaF, &lalDimensionlessUnit, (size_t) chirplen / 2 + 1);
-        plan = XLALCreateForwardREAL8FFTPlan((size_t) chirplen, 0);
-        XLALREAL8TimeFreqFFT(*hctilde, hcross, plan);
-        XLALREAL8TimeFreqFFT(*hptilde, hplus, plan);
+        plan = FDConditioningPlan(cond, (size_t) chirplen);
+        if (!*hptilde || !*hctilde || !plan
+            || XLALREAL8TimeFreqFFT(*hctilde, hcross, plan) < 0
+            || XLALREAL8TimeFreqFFT(*hptilde, hplus, plan) < 0)
+            retval = XLAL_FAILURE;
 
         /* clean up */
-        XLALDestroyREAL8FFTPlan(plan);
+        if (!cond)
+            XLALDestroyREAL8FFTPlan(plan);
         XLALDestroyREAL8TimeSeries(hcross);
         XLALDestroyREAL8TimeSeries(hplus);
+        if (retval < 0) {
+            XLALDestroyCOMPLEX16FrequencySeries(*hctilde);
+            XLALDestroyCOMPLEX16FrequencySeries(*hptilde);
+            *hctilde = *hptilde = NULL;
+            XLAL_ERROR(XLAL_EFUNC);
+        }
 
     } else /* error: neither a FD nor a TD approximant */
         XLAL_ERROR(XLAL_EINVAL, "Invalid approximant");
@@ -3041,6 +3115,43 @@ int XLALSimInspiralFD(
     return 0;
 }
 
+/**
+ * @brief Generates a conditioned frequency domain inspiral waveform.
+ *
+ * Equivalent to XLALSimInspiralFDConditioned() without a cached context.
+ *
+ * @note The parameters passed must be in SI units.
+ */
+int XLALSimInspiralFD(
+    COMPLEX16FrequencySeries **hptilde,     /**< FD plus polarization */
+    COMPLEX16FrequencySeries **hctilde,     /**< FD cross polarization */
+    REAL8 m1,                               /**< mass of companion 1 (kg) */
+    REAL8 m2,                               /**< mass of companion 2 (kg) */
+    REAL8 S1x,                              /**< x-component of the dimensionless spin of object 1 */
+    REAL8 S1y,                              /**< y-component of the dimensionless spin of object 1 */
+    REAL8 S1z,                              /**< z-component of the dimensionless spin of object 1 */
+    REAL8 S2x,                              /**< x-component of the dimensionless spin of object 2 */
+    REAL8 S2y,                              /**< y-component of the dimensionless spin of object 2 */
+    REAL8 S2z,                              /**< z-component of the dimensionless spin of object 2 */
+    REAL8 distance,                         /**< distance of source (m) */
+    REAL8 inclination,                      /**< inclination of source (rad) */
+    REAL8 phiRef,                           /**< reference orbital phase (rad) */
+    REAL8 longAscNodes,                     /**< longitude of ascending nodes, degenerate with the polarization angle, Omega in documentation */
+    REAL8 eccentricity,                     /**< eccentricity at reference epoch */
+    REAL8 meanPerAno,                       /**< mean anomaly of periastron */
+    REAL8 deltaF,                           /**< sampling interval (Hz) */
+    REAL8 f_min,                            /**< starting GW frequency (Hz) */
+    REAL8 f_max,                            /**< ending GW frequency (Hz) */
+    REAL8 f_ref,                            /**< Reference frequency (Hz) */
+    LALDict *LALparams,                     /**< LAL dictionary containing accessory parameters */
+    Approximant approximant                 /**< post-Newtonian approximant to use for waveform production */
+    )
+{
+    if (XLALSimInspiralFDConditioned(hptilde, hctilde, m1, m2, S1x, S1y, S1z, S2x, S2y, S2z, distance, inclination, phiRef, longAscNodes, eccentricity, meanPerAno, deltaF, f_min, f_max, f_ref, LALparams, approximant, NULL) < 0)
+        XLAL_ERROR(XLAL_EFUNC);
+    return 0;
+}
+
 /**
  * @deprecated Use XLALSimInspiralChooseTDWaveform() instead
  *
@@ -3462,6 +3573,8 @@ SphHarmTimeSeries *XLALSimInspiralChooseTDModes(
  * To take this into account we provide also the function XLALSimInspiralPolarizationsFromChooseFDModes which build the polarizations in the proper way for each
  * model returning a result close to machine precision with ChooseFDWaveform.
  *
+ * EOBNRv2HM_ROM, like the polarizations of that model, sets the phase of the h_lms from phiRef, so they must be combined with vphi = 0.
+ *
  * For the precessing model IMRPhenomXPHM, since the h_lms are returned in the J-frame one must build the polarizations using theta = theta_JN and vphi = 0. 
  * The parameter theta_JN is computed internally when using XLALSimInspiralPolarizationsFromChooseFDModes and again here the result is close to machine precision to ChooseFDWaveform. 
  * However, one would have to compute theta_JN personally when using XLALSimInspiralPolarizationsFromSphHarmFrequencySeries. 
@@ -3587,10 +3700,13 @@ SphHarmFrequencySeries *XLALSimInspiralChooseFDModes(
 		  XLALSimIMRPhenomXPHMModes(&hlms, m1, m2, S1x, S1y, S1z,	S2x, S2y, S2z, deltaF, f_min, f_max, f_ref, phiRef, distance, inclination, LALparams);
 			break;
 
+		case EOBNRv2HM_ROM:
 		case SEOBNRv4HM_ROM:
 			/* Waveform-specific sanity checks */
 			if( !XLALSimInspiralWaveformParamsFlagsAreDefault(LALparams) )
 					XLAL_ERROR_NULL(XLAL_EINVAL, "Non-default flags given, but this approximant does not support this case.");
+			if( approximant == EOBNRv2HM_ROM && !checkSpinsZero(S1x, S1y, S1z, S2x, S2y, S2z) )
+					XLAL_ERROR_NULL(XLAL_EINVAL, "Non-zero spins were given, but this is a non-spinning approximant.");
 			if( !checkTransverseSpinsZero(S1x, S1y, S2x, S2y) )
 					XLAL_ERROR_NULL(XLAL_EINVAL, "Non-zero transverse spins were given, but this is a non-precessing approximant.");
 			if( !checkTidesZero(lambda1, lambda2) )
@@ -3656,7 +3772,7 @@ SphHarmFrequencySeries *XLALSimInspiralChooseFDModes(
                         XLALDestroyValue(DefaultModeArray);
                         XLALDestroyINT2Sequence(modeseq);
                         XLALFree(hlms_tmp);
-                        XLAL_ERROR_NULL(XLAL_EINVAL, "Mode (%i,%i) is not available in SEOBNRv4HM_ROM.\n", l, m);
+                        XLAL_ERROR_NULL(XLAL_EINVAL, "Mode (%i,%i) is not available in %s.\n", l, m, XLALSimInspiralGetStringFromApproximant(approximant));
                     }
                 }
                 XLALDestroyValue(DefaultModeArray);
@@ -3669,8 +3785,11 @@ SphHarmFrequencySeries *XLALSimInspiralChooseFDModes(
 				eobmodes = 1; // This will  internally call SEOBNRv4_ROM instead of all the modes, therefore saving time.
 			}
 
-			/* Compute individual modes of SEOBNRv4HM_ROM */
-			retcode = XLALSimIMRSEOBNRv4HMROM_Modes(hlms_tmp, phiRef, deltaF, f_min, f_max, f_ref, distance, m1, m2, S1z, S2z, -1, eobmodes, true);
+			/* Compute individual modes of SEOBNRv4HM_ROM or EOBNRv2HM_ROM */
+			if( approximant == EOBNRv2HM_ROM )
+				retcode = XLALSimIMREOBNRv2HMROMModes(hlms_tmp, phiRef, deltaF, f_min, f_max, f_ref, distance, m1, m2);
+			else
+				retcode = XLALSimIMRSEOBNRv4HMROM_Modes(hlms_tmp, phiRef, deltaF, f_min, f_max, f_ref, distance, m1, m2, S1z, S2z, -1, eobmodes, true);
 			if( retcode != XLAL_SUCCESS){
 				XLALFree(hlms_tmp);
 				XLAL_ERROR_NULL(XLAL_EFUNC);
@@ -4668,6 +4787,10 @@ int XLALSimInspiralPolarizationsFromChooseFDModes(
         break;
         case SEOBNRv4HM_ROM:
 
+        break;
+        case EOBNRv2HM_ROM:
+        phiRef_modes = phiRef;
+        azimuthal = 0.;
         break;
         case IMRPhenomHM:
         phiRef_modes = phiRef;
@@ -4684,45 +4807,14 @@ int XLALSimInspiralPolarizationsFromChooseFDModes(
         XLAL_ERROR(XLAL_EFUNC, "Error: XLALSimInspiralChooseFDModes failed\n");
     }
 
-	UINT4 len = (*hlms)->mode->data->length;
-	UINT4 offset = 0;
-
-	/* This is to account that ChooseFDModes return the modes for both negative and positve frequencies,
-	   but here we return the polarizations just for positive frequencies. */
-	len = (UINT4) ceil(len/2.);
-	offset = len-1;
-
-	/* Create polarizations objects */
-	*hptilde = XLALCreateCOMPLEX16FrequencySeries("FD hplus",
-					&((*hlms)->mode->epoch), (*hlms)->mode->f0, (*hlms)->mode->deltaF,
-					&((*hlms)->mode->sampleUnits), len);
-	*hctilde = XLALCreateCOMPLEX16FrequencySeries("FD hcross",
-					&((*hptilde)->epoch), (*hptilde)->f0, (*hptilde)->deltaF,
-					&((*hptilde)->sampleUnits), (*hptilde)->data->length);
-	memset((*hptilde)->data->data, 0, (len) * sizeof(COMPLEX16));
-	memset((*hctilde)->data->data, 0, (len) * sizeof(COMPLEX16));
-
-
-	SphHarmFrequencySeries *hlms_tmp = *hlms;
-
-	/* Build the polarizations by summing the modes*/
-	while ( hlms_tmp ){
-		COMPLEX16 Ylm = XLALSpinWeightedSphericalHarmonic(theta, azimuthal, -2, hlms_tmp->l, hlms_tmp->m);
-		COMPLEX16 Ylmstar = conj(Ylm);
-
-		for(UINT4 idx = 0; idx<len; idx++){
-			COMPLEX16 hlm = hlms_tmp->mode->data->data[idx + offset];
-			COMPLEX16 hlm2 = conj(hlms_tmp->mode->data->data[len - 1 - idx]);
-			(*hptilde)->data->data[idx] += 0.5 * (hlm * Ylm + hlm2 * Ylmstar);
-			(*hctilde)->data->data[idx] += 0.5 * I * (hlm * Ylm - hlm2 * Ylmstar);
-		}
-		hlms_tmp = hlms_tmp->next;
-	}
+	/* Build the polarizations by summing the modes */
+	*hptilde = *hctilde = NULL;
+	ret = XLALSimInspiralPolarizationsFromSphHarmFrequencySeries(hptilde, hctilde, *hlms, theta, azimuthal);
 
 	/* Free memory */
 	XLALDestroySphHarmFrequencySeries(*hlms);
 	XLALFree(hlms);
-	XLALDestroySphHarmFrequencySeries(hlms_tmp);
+	XLAL_CHECK(XLAL_SUCCESS == ret, XLAL_EFUNC, "Error: XLALSimInspiralPolarizationsFromSphHarmFrequencySeries failed.\n");
 
 
 	/* Add the correct polarization angle for IMRPhenomXPHM */
@@ -19,6 +19,215 @@
 
 #include <lal/LALSimInspiralPrecess.h>
 #include <lal/LALAtomicDatatypes.h>
+#include <lal/VectorMath.h>
+
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
+/* number of samples rotated together by RotateModes() */
+#define ROTATE_MODES_BLOCK 64
+
+/* Rotation shared by the functions below and by the precessing models, which
+ * rotate their co-precessing modes with it.  For each l, the 2l+1 modes are
+ * rotated by
+ *
+ *   out_{l m} = exp(-i m gam) sum_{m'} d^l_{m' m}(beta) exp(-i m' alpha) in_{l m'},
+ *
+ * the Wigner D matrix of XLALWignerDMatrix().  Samples are rotated a block at
+ * a time, with the Wigner d matrix elements of the block evaluated together
+ * and the real and imaginary parts of the sums held in separate arrays, so
+ * that the sums over m' vectorise across the samples of the block.  Blocks
+ * are distributed over OpenMP threads.
+ *
+ * Modes are indexed by l * (2 lmax + 1) + m + lmax.  An absent input mode is
+ * zero, and an absent output mode is not computed; the input and output arrays
+ * may be the same.  If constant is non-zero, alpha, beta and gam each point to
+ * a single angle used for all samples. */
+typedef struct {
+	COMPLEX16 **out;
+	COMPLEX16 * const *in;
+	int lmin, lmax;
+	size_t length;
+	const REAL8 *alpha, *beta, *gam;
+	int constant;
+	const LALWignerdTable *dtable;
+	const REAL8 *d;	/* d matrix elements of a constant rotation */
+} RotateModesPlan;
+
+static size_t RotateModesWorkLength(int lmax)
+{
+	const size_t K = 2 * lmax + 1;
+	return (XLALWignerdTableIndex(lmax + 1, -(lmax + 1), -(lmax + 1)) + 4 + 4 * (lmax + 1) + 2 * K + 2) * ROTATE_MODES_BLOCK;
+}
+
+static int RotateModesBlock(const RotateModesPlan *plan, size_t i0, size_t nb, REAL8 *work)
+{
+	const int lmax = plan->lmax, K = 2 * lmax + 1;
+	const size_t B = ROTATE_MODES_BLOCK;
+	const REAL8 *d = plan->d;
+	REAL8 *dblock = work;
+	REAL8 *sa = dblock + XLALWignerdTableIndex(lmax + 1, -(lmax + 1), -(lmax + 1)) * B;
+	REAL8 *ca = sa + B, *sg = ca + B, *cg = sg + B;
+	/* exp(-i k alpha) and exp(-i k gam) for k = 0, ..., lmax */
+	REAL8 *ear = cg + B, *eai = ear + (lmax + 1) * B;
+	REAL8 *egr = eai + (lmax + 1) * B, *egi = egr + (lmax + 1) * B;
+	/* exp(-i m' alpha) in_{l m'} */
+	REAL8 *yr = egi + (lmax + 1) * B, *yi = yr + K * B;
+	REAL8 *sr = yi + K * B, *si = sr + B;
+	size_t dstride = 0, i;
+	int l, m, mp, k;
+
+	if (plan->constant) {
+		for (i = 0; i < nb; i++) {
+			sa[i] = sin(plan->alpha[0]);
+			ca[i] = cos(plan->alpha[0]);
+			sg[i] = sin(plan->gam[0]);
+			cg[i] = cos(plan->gam[0]);
+		}
+	} else {
+		XLAL_CHECK(XLALWignerdTableEvaluate(dblock, plan->dtable, plan->beta + i0, nb) == XLAL_SUCCESS, XLAL_EFUNC);
+		XLAL_CHECK(XLALVectorSinCosREAL8(sa, ca, plan->alpha + i0, nb) == XLAL_SUCCESS, XLAL_EFUNC);
+		XLAL_CHECK(XLALVectorSinCosREAL8(sg, cg, plan->gam + i0, nb) == XLAL_SUCCESS, XLAL_EFUNC);
+		d = dblock;
+		dstride = nb;
+	}
+	for (i = 0; i < nb; i++) {
+		ear[i] = egr[i] = 1;
+		eai[i] = egi[i] = 0;
+	}
+	for (k = 1; k <= lmax; k++)
+		for (i = 0; i < nb; i++) {
+			const REAL8 *pr = ear + (k - 1) * B, *pi = eai + (k - 1) * B;
+			const REAL8 *qr = egr + (k - 1) * B, *qi = egi + (k - 1) * B;
+			ear[k * B + i] = pr[i] * ca[i] + pi[i] * sa[i];
+			eai[k * B + i] = pi[i] * ca[i] - pr[i] * sa[i];
+			egr[k * B + i] = qr[i] * cg[i] + qi[i] * sg[i];
+			egi[k * B + i] = qi[i] * cg[i] - qr[i] * sg[i];
+		}
+
+	for (l = plan->lmin; l <= lmax; l++) {
+		COMPLEX16 * const *in = plan->in + l * K + lmax;
+		COMPLEX16 **out = plan->out + l * K + lmax;
+
+		for (mp = -l; mp <= l; mp++) {
+			const REAL8 *er = ear + abs(mp) * B, *ei = eai + abs(mp) * B;
+			const REAL8 sign = mp < 0 ? -1 : 1;
+			REAL8 *zr = yr + (mp + lmax) * B, *zi = yi + (mp + lmax) * B;
+			if (!in[mp])
+				continue;
+			for (i = 0; i < nb; i++) {
+				const REAL8 xr = creal(in[mp][i0 + i]), xi = cimag(in[mp][i0 + i]);
+				zr[i] = xr * er[i] - sign * xi * ei[i];
+				zi[i] = xi * er[i] + sign * xr * ei[i];
+			}
+		}
+
+		for (m = -l; m <= l; m++) {
+			const REAL8 *gr = egr + abs(m) * B, *gi = egi + abs(m) * B;
+			const REAL8 sign = m < 0 ? -1 : 1;
+			if (!out[m])
+				continue;
+			for (i = 0; i < nb; i++)
+				sr[i] = si[i] = 0;
+			for (mp = -l; mp <= l; mp++) {
+				const REAL8 *dl = d + XLALWignerdTableIndex(l, mp, m) * (dstride ? dstride : 1);
+				const REAL8 *zr = yr + (mp + lmax) * B, *zi = yi + (mp + lmax) * B;
+				if (!in[mp])
+					continue;
+				if (dstride) {
+					for (i = 0; i < nb; i++) {
+						sr[i] += dl[i] * zr[i];
+						si[i] += dl[i] * zi[i];
+					}
+				} else {
+					const REAL8 dc = dl[0];
+					for (i = 0; i < nb; i++) {
+						sr[i] += dc * zr[i];
+						si[i] += dc * zi[i];
+					}
+				}
+			}
+			for (i = 0; i < nb; i++)
+				out[m][i0 + i] = crect(sr[i] * gr[i] - sign * si[i] * gi[i], si[i] * gr[i] + sign * sr[i] * gi[i]);
+		}
+	}
+
+	return XLAL_SUCCESS;
+}
+
+static int RotateModes(COMPLEX16 **out, COMPLEX16 * const *in, int lmin, int lmax, size_t length, const REAL8 *alpha, const REAL8 *beta, const REAL8 *gam, int constant)
+{
+	const size_t nblocks = (length + ROTATE_MODES_BLOCK - 1) / ROTATE_MODES_BLOCK;
+	RotateModesPlan plan;
+	LALWignerdTable *dtable;
+	REAL8 *d = NULL;
+	int failed = 0;
+
+	plan.out = out;
+	plan.in = in;
+	plan.lmin = lmin;
+	plan.lmax = lmax;
+	plan.length = length;
+	plan.alpha = alpha;
+	plan.beta = beta;
+	plan.gam = gam;
+	plan.constant = constant;
+	dtable = XLALCreateWignerdTable(lmax);
+	XLAL_CHECK(dtable, XLAL_EFUNC);
+	plan.dtable = dtable;
+	if (constant) {
+		d = XLALMalloc(XLALWignerdTableIndex(lmax + 1, -(lmax + 1), -(lmax + 1)) * sizeof(*d));
+		if (!d || XLALWignerdTableEvaluate(d, plan.dtable, beta, 1) != XLAL_SUCCESS) {
+			XLALFree(d);
+			XLALDestroyWignerdTable(dtable);
+			XLAL_ERROR(XLAL_EFUNC);
+		}
+	}
+	plan.d = d;
+
+	#pragma omp parallel reduction(|:failed)
+	{
+		REAL8 *work = XLALMalloc(RotateModesWorkLength(lmax) * sizeof(*work));
+		long b;
+		failed |= !work;
+		#pragma omp for schedule(static)
+		for (b = 0; b < (long) nblocks; b++) {
+			const size_t i0 = b * ROTATE_MODES_BLOCK;
+			const size_t nb = length - i0 < ROTATE_MODES_BLOCK ? length - i0 : ROTATE_MODES_BLOCK;
+			if (work && RotateModesBlock(&plan, i0, nb, work) != XLAL_SUCCESS)
+				failed = 1;
+		}
+		XLALFree(work);
+	}
+
+	XLALFree(d);
+	XLALDestroyWignerdTable(dtable);
+	XLAL_CHECK(!failed, XLAL_EFUNC, "Failed to rotate modes");
+	return XLAL_SUCCESS;
+}
+
+/* Pointers to the data of the modes l = lmin, ..., lmax of a list, indexed as
+ * in RotateModes(), or NULL when a mode is absent; also checks that the modes
+ * have at least length samples. */
+static COMPLEX16 **RotateModesData(SphHarmTimeSeries *h_lm, int lmin, int lmax, size_t length)
+{
+	COMPLEX16 **data = XLALCalloc((lmax + 1) * (2 * lmax + 1), sizeof(*data));
+	int l, m;
+	XLAL_CHECK_NULL(data, XLAL_ENOMEM);
+	for (l = lmin; l <= lmax; l++)
+		for (m = -l; m <= l; m++) {
+			COMPLEX16TimeSeries *mode = XLALSphHarmTimeSeriesGetMode(h_lm, l, m);
+			if (!mode)
+				continue;
+			if (mode->data->length < length) {
+				XLALFree(data);
+				XLAL_ERROR_NULL(XLAL_EBADLEN, "Mode (%d, %d) has %u samples, fewer than the %zu Euler angles", l, m, mode->data->length, length);
+			}
+			data[l * (2 * lmax + 1) + m + lmax] = mode->data->data;
+		}
+	return data;
+}
 
 /**
  * @addtogroup LALSimInspiralPrecess_h
@@ -40,39 +249,52 @@ int XLALSimInspiralPrecessionRotateModes(
                 REAL8TimeSeries* gam /**< gamma Euler angle time series */
 ){
 
-	unsigned int i;
-	int l, lmax, m, mp;
-	lmax = XLALSphHarmTimeSeriesGetMaxL( h_lm );
-	// Temporary holding variables
-	complex double *x_lm = XLALCalloc( 2*lmax+1, sizeof(complex double) );
-	COMPLEX16TimeSeries **h_xx = XLALCalloc( 2*lmax+1, sizeof(COMPLEX16TimeSeries) );
-
-	for(i=0; i<alpha->data->length; i++){
-		for(l=2; l<=lmax; l++){
-			for(m=0; m<2*l+1; m++){
-				h_xx[m] = XLALSphHarmTimeSeriesGetMode(h_lm, l, m-l);
-				if( !h_xx[m] ){
-					x_lm[m] = 0;
-				} else {
-					x_lm[m] = h_xx[m]->data->data[i];
-					h_xx[m]->data->data[i] = 0;
-				}
-			}
+	int lmax = XLALSphHarmTimeSeriesGetMaxL( h_lm );
+	size_t length = alpha->data->length;
+	COMPLEX16 **data;
+	int ret;
 
-			for(m=0; m<2*l+1; m++){
-				for(mp=0; mp<2*l+1; mp++){
-					if( !h_xx[m] ) continue;
-					if(!(creal(h_xx[m]->data->data[i])==0 && creal(x_lm[mp])==0)) {
-					  h_xx[m]->data->data[i] +=
-					    x_lm[mp] * XLALWignerDMatrix( l, mp-l, m-l, alpha->data->data[i], beta->data->data[i], gam->data->data[i] );
-					  }
-				}
-			}
-		}
-	}
+	XLAL_CHECK( beta->data->length == length && gam->data->length == length, XLAL_EBADLEN );
+	if( lmax < 2 )
+		return XLAL_SUCCESS;
+	data = RotateModesData( h_lm, 2, lmax, length );
+	XLAL_CHECK( data, XLAL_EFUNC );
+	ret = RotateModes( data, data, 2, lmax, length, alpha->data->data, beta->data->data, gam->data->data, 0 );
+	XLALFree( data );
+	XLAL_CHECK( ret == XLAL_SUCCESS, XLAL_EFUNC );
+	return XLAL_SUCCESS;
+}
 
-	XLALFree( x_lm );
-	XLALFree( h_xx );
+/**
+ * Takes in the h_lm spherical harmonic decomposed modes and rotates the modes
+ * by constant Euler angles alpha, beta, and gamma using the Wigner D matrices,
+ * as XLALSimInspiralPrecessionRotateModes() does with time series of angles
+ * which are all equal.  The Wigner D matrices are computed only once.  All
+ * the modes of h_lm must have the same length.
+ */
+int XLALSimInspiralPrecessionRotateModesFixed(
+                SphHarmTimeSeries* h_lm, /**< spherical harmonic decomposed modes, modified in place */
+                REAL8 alpha, /**< alpha Euler angle */
+                REAL8 beta, /**< beta Euler angle */
+                REAL8 gam /**< gamma Euler angle */
+){
+
+	int lmax = XLALSphHarmTimeSeriesGetMaxL( h_lm );
+	int lmin = XLALSphHarmTimeSeriesGetMinL( h_lm );
+	size_t length;
+	COMPLEX16 **data;
+	int ret;
+
+	if( !h_lm )
+		return XLAL_SUCCESS;
+	length = h_lm->mode->data->length;
+	for( SphHarmTimeSeries *node = h_lm; node; node = node->next )
+		XLAL_CHECK( node->mode->data->length == length, XLAL_EBADLEN, "Modes have different lengths" );
+	data = RotateModesData( h_lm, lmin, lmax, length );
+	XLAL_CHECK( data, XLAL_EFUNC );
+	ret = RotateModes( data, data, lmin, lmax, length, &alpha, &beta, &gam, 1 );
+	XLALFree( data );
+	XLAL_CHECK( ret == XLAL_SUCCESS, XLAL_EFUNC );
 	return XLAL_SUCCESS;
 }
 
@@ -361,26 +583,51 @@ int XLALSimInspiralPrecessionRotateModesOut(SphHarmTimeSeries **hlm_out,   /**<
     XLAL_ERROR(XLAL_EFAILED);
 
   unsigned int i;
-  int l, m, mp;
+  int l, m, ret;
   int lmax = XLALSphHarmTimeSeriesGetMaxL( hlm_in );
   int lmin = XLALSphHarmTimeSeriesGetMinL( hlm_in );
+  UINT4 length = alpha->data->length;
+  XLAL_CHECK( beta->data->length == length && gam->data->length == length, XLAL_EBADLEN );
+  COMPLEX16 **in = RotateModesData( hlm_in, lmin, lmax, length );
+  COMPLEX16 **out = XLALCalloc( (lmax+1)*(2*lmax+1), sizeof(*out) );
+  COMPLEX16TimeSeries **outmode = XLALCalloc( (lmax+1)*(2*lmax+1), sizeof(*outmode) );
+  REAL8 *mbeta = XLALMalloc( length * sizeof(*mbeta) );
+  if( !in || !out || !outmode || !mbeta ) {
+    XLALFree( in );
+    XLALFree( out );
+    XLALFree( outmode );
+    XLALFree( mbeta );
+    XLAL_ERROR(XLAL_EFUNC);
+  }
+
   for( l=lmin; l <= lmax; l++ ) {
-    COMPLEX16TimeSeries **inmode= XLALCalloc( 2*lmax+1, sizeof(COMPLEX16TimeSeries) );
     for( m=-l; m<=l; m++){
-      inmode[m+l] = XLALSphHarmTimeSeriesGetMode(hlm_in, l, m );
-    }
-    for( m=-l; m<=l; m++){
-      COMPLEX16TimeSeries *outmode = XLALCreateCOMPLEX16TimeSeries(inmode[m+l]->name,&inmode[m+l]->epoch,0.,inmode[m+l]->deltaT,&inmode[m+l]->sampleUnits,inmode[m+l]->data->length);
-      for(i=0; i<inmode[m+l]->data->length; i++)
-	outmode->data->data[i]=0.;
-      for(mp=-l; mp<=l; mp++){
-	for(i=0; i<inmode[m+l]->data->length; i++) {
-	  outmode->data->data[i] += inmode[mp+l]->data->data[i] * XLALWignerDMatrix( l, mp, m, alpha->data->data[i], -beta->data->data[i], gam->data->data[i] );
-	}
-      }
-      *hlm_out=XLALSphHarmTimeSeriesAddMode(*hlm_out,outmode,l,m);
+      COMPLEX16TimeSeries *in_lm = XLALSphHarmTimeSeriesGetMode(hlm_in, l, m );
+      if( !in_lm )
+        in_lm = hlm_in->mode;
+      outmode[l*(2*lmax+1)+m+lmax] = XLALCreateCOMPLEX16TimeSeries(in_lm->name,&in_lm->epoch,0.,in_lm->deltaT,&in_lm->sampleUnits,in_lm->data->length);
+      XLAL_CHECK( outmode[l*(2*lmax+1)+m+lmax], XLAL_EFUNC );
+      out[l*(2*lmax+1)+m+lmax] = outmode[l*(2*lmax+1)+m+lmax]->data->data;
+      for(i=0; i<outmode[l*(2*lmax+1)+m+lmax]->data->length; i++)
+	outmode[l*(2*lmax+1)+m+lmax]->data->data[i]=0.;
     }
   }
+
+  for(i=0; i<length; i++)
+    mbeta[i] = -beta->data->data[i];
+  ret = RotateModes( out, in, lmin, lmax, length, alpha->data->data, mbeta, gam->data->data, 0 );
+
+  for( l=lmin; l <= lmax; l++ )
+    for( m=-l; m<=l; m++) {
+      *hlm_out=XLALSphHarmTimeSeriesAddMode(*hlm_out,outmode[l*(2*lmax+1)+m+lmax],l,m);
+      XLALDestroyCOMPLEX16TimeSeries(outmode[l*(2*lmax+1)+m+lmax]);
+    }
+
+  XLALFree( in );
+  XLALFree( out );
+  XLALFree( outmode );
+  XLALFree( mbeta );
+  XLAL_CHECK( ret == XLAL_SUCCESS, XLAL_EFUNC );
   return XLAL_SUCCESS;
 }
 
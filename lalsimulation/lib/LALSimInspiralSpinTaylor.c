@@ -72,12 +72,10 @@
 	vz = tmp2
 
 
-static int XLALSimInspiralVectorCrossProduct(REAL8 **vout, REAL8 v1x, REAL8 v1y, REAL8 v1z, REAL8 v2x, REAL8 v2y, REAL8 v2z){
-    (*vout) = (double *) LALMalloc(sizeof(double) * 3);
-    (*vout)[0]=v1y*v2z-v1z*v2y;
-    (*vout)[1]=v1z*v2x-v1x*v2z;
-    (*vout)[2]=v1x*v2y-v1y*v2x;
-    return XLAL_SUCCESS;
+static void XLALSimInspiralVectorCrossProduct(REAL8 vout[3], REAL8 v1x, REAL8 v1y, REAL8 v1z, REAL8 v2x, REAL8 v2y, REAL8 v2z){
+    vout[0]=v1y*v2z-v1z*v2y;
+    vout[1]=v1z*v2x-v1x*v2z;
+    vout[2]=v1x*v2y-v1y*v2x;
 }
 
 /* Declarations of static functions - defined below */
@@ -528,8 +526,8 @@ INT4 XLALSimInspiralSpinDerivatives(REAL8 *dLNhx,
     const REAL8 omega=v2*v;
     const REAL8 v5=omega*v2;
 
-    REAL8 *LNcS1=NULL;
-    XLALSimInspiralVectorCrossProduct(&LNcS1,LNhx,LNhy,LNhz,S1x,S1y,S1z);
+    REAL8 LNcS1[3];
+    XLALSimInspiralVectorCrossProduct(LNcS1,LNhx,LNhy,LNhz,S1x,S1y,S1z);
     const REAL8 dS1xL = params->S1dot3 * v5 * LNcS1[0];
     const REAL8 dS1yL = params->S1dot3 * v5 * LNcS1[1];
     const REAL8 dS1zL = params->S1dot3 * v5 * LNcS1[2];
@@ -537,8 +535,8 @@ INT4 XLALSimInspiralSpinDerivatives(REAL8 *dLNhx,
     *dS1y =dS1yL;
     *dS1z =dS1zL;
 
-    REAL8 *LNcS2=NULL;
-    XLALSimInspiralVectorCrossProduct(&LNcS2,LNhx,LNhy,LNhz,S2x,S2y,S2z);
+    REAL8 LNcS2[3];
+    XLALSimInspiralVectorCrossProduct(LNcS2,LNhx,LNhy,LNhz,S2x,S2y,S2z);
 
     REAL8 dS2xL = params->S2dot3 * v5 * LNcS2[0];
     REAL8 dS2yL = params->S2dot3 * v5 * LNcS2[1];
@@ -554,11 +552,11 @@ INT4 XLALSimInspiralSpinDerivatives(REAL8 *dLNhx,
 
     if ( (params->spinO>=4) || (params->spinO<0.) ) {
       REAL8 omega2=omega*omega;
-      REAL8 *S1cS2=NULL;
+      REAL8 S1cS2[3];
       /* dS1,2 NLO term (v x leading), Spin^2 terms */
 
       /* S1S2 contribution, see. eq. 2.23 of arXiv:0812.4413 */
-      XLALSimInspiralVectorCrossProduct(&S1cS2,S1x,S1y,S1z,S2x,S2y,S2z);
+      XLALSimInspiralVectorCrossProduct(S1cS2,S1x,S1y,S1z,S2x,S2y,S2z);
       REAL8 dS1xNL = omega2 * (-params->Sdot4S2Avg*S1cS2[0] + params->Sdot4S2OAvg * LNhdotS2 * LNcS1[0]);
       REAL8 dS1yNL = omega2 * (-params->Sdot4S2Avg*S1cS2[1] + params->Sdot4S2OAvg * LNhdotS2 * LNcS1[1]);
       REAL8 dS1zNL = omega2 * (-params->Sdot4S2Avg*S1cS2[2] + params->Sdot4S2OAvg * LNhdotS2 * LNcS1[2]);
@@ -714,11 +712,8 @@ INT4 XLALSimInspiralSpinDerivatives(REAL8 *dLNhx,
 	  }
 	}
       }
-      XLALFree(S1cS2);S1cS2=NULL;
     }
 
-    XLALFree(LNcS1);LNcS1=NULL;
-    XLALFree(LNcS2);LNcS2=NULL;
   }
 
   /* We have computed the derivative of the spin-independent part of the
@@ -726,11 +721,11 @@ INT4 XLALSimInspiralSpinDerivatives(REAL8 *dLNhx,
    */
 
   /* We now copute the precession vector Om */
-  REAL8 *Om=NULL;
+  REAL8 Om[3];
   const REAL8 dLNhx_tmp=dLNx/LNmag;
   const REAL8 dLNhy_tmp=dLNy/LNmag;
   const REAL8 dLNhz_tmp=dLNz/LNmag;
-  XLALSimInspiralVectorCrossProduct(&Om,LNhx,LNhy,LNhz,dLNhx_tmp,dLNhy_tmp,dLNhz_tmp);
+  XLALSimInspiralVectorCrossProduct(Om,LNhx,LNhy,LNhz,dLNhx_tmp,dLNhy_tmp,dLNhz_tmp);
 
   /*
    * dE1
@@ -743,7 +738,6 @@ INT4 XLALSimInspiralSpinDerivatives(REAL8 *dLNhx,
   *dE1x = -Om[2]*E1y + Om[1]*E1z;
   *dE1y = -Om[0]*E1z + Om[2]*E1x;
   *dE1z = -Om[1]*E1x + Om[0]*E1y;
-  XLALFree(Om);Om=NULL;
 
   /* Make dLNh orthogonal to LNh before returning it*/
   REAL8 dLNhdotLNh=dLNhx_tmp*LNhx+dLNhy_tmp*LNhy+dLNhz_tmp*LNhz;
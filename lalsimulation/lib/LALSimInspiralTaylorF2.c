@@ -24,6 +24,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include <lal/Date.h>
 #include <lal/FrequencySeries.h>
@@ -41,6 +42,29 @@
 #define omp ignore
 #endif
 
+/* TaylorF2 phasing and SPA amplitude coefficients, truncated at the
+ * requested PN orders.  Coefficients beyond the requested orders are zero. */
+typedef struct tagTaylorF2Coeffs {
+    REAL8 pfa[16];  /* coefficients of v^k in the phasing, before dividing by v^5 */
+    REAL8 pfl5;     /* coefficient of v^5 log(v) in the phasing */
+    REAL8 pfl6;     /* coefficient of v^6 log(v) in the phasing */
+    REAL8 FTaN;     /* Newtonian flux coefficient */
+    REAL8 FTa[8];   /* coefficients of v^k in the flux relative to Newtonian */
+    REAL8 FTl6;     /* coefficient of v^6 log(v) in the flux relative to Newtonian */
+    REAL8 dETaN;    /* Newtonian coefficient of dE/dv */
+    REAL8 dETa[4];  /* coefficients of v^(2k) in dE/dv relative to Newtonian */
+} TaylorF2Coeffs;
+
+/* SPA phasing at v, evaluated with Horner's rule in v */
+static REAL8 TaylorF2Phasing(const TaylorF2Coeffs *c, const REAL8 v, const REAL8 logv)
+{
+    REAL8 phasing = c->pfa[15];
+    for (int k = 14; k >= 0; k--)
+        phasing = phasing * v + c->pfa[k];
+    phasing /= v * v * v * v * v;
+    return phasing + (c->pfl5 + c->pfl6 * v) * logv;
+}
+
 /**
  * @addtogroup LALSimInspiralTaylorXX_c
  * @{
@@ -186,96 +210,64 @@ int XLALSimInspiralTaylorF2Core(
     }
 
     PNPhasingSeries pfa = *pfaP;
-
-    REAL8 pfaN = 0.; REAL8 pfa1 = 0.;
-    REAL8 pfa2 = 0.; REAL8 pfa3 = 0.; REAL8 pfa4 = 0.;
-    REAL8 pfa5 = 0.; REAL8 pfl5 = 0.;
-    REAL8 pfa6 = 0.; REAL8 pfl6 = 0.;
-    REAL8 pfa7 = 0.;
+    TaylorF2Coeffs c;
+    memset(&c, 0, sizeof(c));
 
     INT4 phaseO=XLALSimInspiralWaveformParamsLookupPNPhaseOrder(p);
     switch (phaseO)
     {
         case -1:
         case 7:
-            pfa7 = pfa.v[7];
+            c.pfa[7] = pfa.v[7];
 #if __GNUC__ >= 7 && !defined __INTEL_COMPILER
             __attribute__ ((fallthrough));
 #endif
         case 6:
-            pfa6 = pfa.v[6];
-            pfl6 = pfa.vlogv[6];
+            c.pfa[6] = pfa.v[6];
+            c.pfl6 = pfa.vlogv[6];
 #if __GNUC__ >= 7 && !defined __INTEL_COMPILER
             __attribute__ ((fallthrough));
 #endif
         case 5:
-            pfa5 = pfa.v[5];
-            pfl5 = pfa.vlogv[5];
+            c.pfa[5] = pfa.v[5];
+            c.pfl5 = pfa.vlogv[5];
 #if __GNUC__ >= 7 && !defined __INTEL_COMPILER
             __attribute__ ((fallthrough));
 #endif
         case 4:
-            pfa4 = pfa.v[4];
+            c.pfa[4] = pfa.v[4];
 #if __GNUC__ >= 7 && !defined __INTEL_COMPILER
             __attribute__ ((fallthrough));
 #endif
         case 3:
-            pfa3 = pfa.v[3];
+            c.pfa[3] = pfa.v[3];
 #if __GNUC__ >= 7 && !defined __INTEL_COMPILER
             __attribute__ ((fallthrough));
 #endif
         case 2:
-            pfa2 = pfa.v[2];
+            c.pfa[2] = pfa.v[2];
 #if __GNUC__ >= 7 && !defined __INTEL_COMPILER
             __attribute__ ((fallthrough));
 #endif
         case 1:
-            pfa1 = pfa.v[1];
+            c.pfa[1] = pfa.v[1];
 #if __GNUC__ >= 7 && !defined __INTEL_COMPILER
             __attribute__ ((fallthrough));
 #endif
         case 0:
-            pfaN = pfa.v[0];
+            c.pfa[0] = pfa.v[0];
             break;
         default:
             XLAL_ERROR(XLAL_ETYPE, "Invalid phase PN order %d", phaseO);
     }
 
-    /* Validate expansion order arguments.
-     * This must be done here instead of in the OpenMP parallel loop
-     * because when OpenMP parallelization is turned on, early exits
-     * from loops (via return or break statements) are not permitted.
-     */
-
-    /* Validate amplitude PN order. */
-    INT4 amplitudeO=XLALSimInspiralWaveformParamsLookupPNAmplitudeOrder(p);
-    switch (amplitudeO)
-    {
-        case -1:
-        case 7:
-        case 6:
-        case 5:
-        case 4:
-        case 3:
-        case 2:
-        case 0:
-            break;
-        default:
-            XLAL_ERROR(XLAL_ETYPE, "Invalid amplitude PN order %d", amplitudeO);
-    }
-
     /* Generate tidal terms separately.
      * Enums specifying tidal order are in LALSimInspiralWaveformFlags.h
      */
-    REAL8 pft10 = 0.;
-    REAL8 pft12 = 0.;
-    REAL8 pft13 = 0.;
-    REAL8 pft14 = 0.;
-    REAL8 pft15 = 0.;
     switch( XLALSimInspiralWaveformParamsLookupPNTidalOrder(p) )
     {
         case LAL_SIM_INSPIRAL_TIDAL_ORDER_75PN:
-            pft15 = pfa.v[15];
+            c.pfa[15] = pfa.v[15];
 #if __GNUC__ >= 7 && !defined __INTEL_COMPILER
             __attribute__ ((fallthrough));
 #endif
@@ -284,22 +276,22 @@ int XLALSimInspiralTaylorF2Core(
             __attribute__ ((fallthrough));
 #endif
         case LAL_SIM_INSPIRAL_TIDAL_ORDER_7PN:
-            pft14 = pfa.v[14];
+            c.pfa[14] = pfa.v[14];
 #if __GNUC__ >= 7 && !defined __INTEL_COMPILER
             __attribute__ ((fallthrough));
 #endif
         case LAL_SIM_INSPIRAL_TIDAL_ORDER_65PN:
-            pft13 = pfa.v[13];
+            c.pfa[13] = pfa.v[13];
 #if __GNUC__ >= 7 && !defined __INTEL_COMPILER
             __attribute__ ((fallthrough));
 #endif
         case LAL_SIM_INSPIRAL_TIDAL_ORDER_6PN:
-	    pft12 = pfa.v[12];
+	    c.pfa[12] = pfa.v[12];
 #if __GNUC__ >= 7 && !defined __INTEL_COMPILER
             __attribute__ ((fallthrough));
 #endif
         case LAL_SIM_INSPIRAL_TIDAL_ORDER_5PN:
-            pft10 = pfa.v[10];
+            c.pfa[10] = pfa.v[10];
 #if __GNUC__ >= 7 && !defined __INTEL_COMPILER
             __attribute__ ((fallthrough));
 #endif
@@ -309,23 +301,66 @@ int XLALSimInspiralTaylorF2Core(
 	    XLAL_ERROR(XLAL_EINVAL, "Invalid tidal PN order %d", XLALSimInspiralWaveformParamsLookupPNTidalOrder(p) );
     }
 
-    /* The flux and energy coefficients below are used to compute SPA amplitude corrections */
-
-    /* flux coefficients */
-    const REAL8 FTaN = XLALSimInspiralPNFlux_0PNCoeff(eta);
-    const REAL8 FTa2 = XLALSimInspiralPNFlux_2PNCoeff(eta);
-    const REAL8 FTa3 = XLALSimInspiralPNFlux_3PNCoeff(eta);
-    const REAL8 FTa4 = XLALSimInspiralPNFlux_4PNCoeff(eta);
-    const REAL8 FTa5 = XLALSimInspiralPNFlux_5PNCoeff(eta);
-    const REAL8 FTl6 = XLALSimInspiralPNFlux_6PNLogCoeff(eta);
-    const REAL8 FTa6 = XLALSimInspiralPNFlux_6PNCoeff(eta);
-    const REAL8 FTa7 = XLALSimInspiralPNFlux_7PNCoeff(eta);
-
-    /* energy coefficients */
-    const REAL8 dETaN = 2. * XLALSimInspiralPNEnergy_0PNCoeff(eta);
-    const REAL8 dETa1 = 2. * XLALSimInspiralPNEnergy_2PNCoeff(eta);
-    const REAL8 dETa2 = 3. * XLALSimInspiralPNEnergy_4PNCoeff(eta);
-    const REAL8 dETa3 = 4. * XLALSimInspiralPNEnergy_6PNCoeff(eta);
+    /* The flux and energy coefficients below are used to compute SPA amplitude corrections.
+     * The amplitude PN order is applied here, not in the OpenMP parallel loop,
+     * so that the loop body is the same for every frequency; this also
+     * validates the order, since early exits from the loop are not permitted.
+     *
+     * WARNING! Amplitude orders beyond 0 have NOT been reviewed!
+     * Use at your own risk. The default is to turn them off.
+     * These do not currently include spin corrections.
+     * Note that these are not higher PN corrections to the amplitude.
+     * They are the corrections to the leading-order amplitude arising
+     * from the stationary phase approximation. See for instance
+     * Eq 6.9 of arXiv:0810.5336
+     */
+    c.FTaN = XLALSimInspiralPNFlux_0PNCoeff(eta);
+    c.dETaN = 2. * XLALSimInspiralPNEnergy_0PNCoeff(eta);
+    c.FTa[0] = 1.;
+    c.dETa[0] = 1.;
+    INT4 amplitudeO=XLALSimInspiralWaveformParamsLookupPNAmplitudeOrder(p);
+    switch (amplitudeO)
+    {
+        case 7:
+            c.FTa[7] = XLALSimInspiralPNFlux_7PNCoeff(eta);
+#if __GNUC__ >= 7 && !defined __INTEL_COMPILER
+            __attribute__ ((fallthrough));
+#endif
+        case 6:
+            c.FTa[6] = XLALSimInspiralPNFlux_6PNCoeff(eta);
+            c.FTl6 = XLALSimInspiralPNFlux_6PNLogCoeff(eta);
+            c.dETa[3] = 4. * XLALSimInspiralPNEnergy_6PNCoeff(eta);
+#if __GNUC__ >= 7 && !defined __INTEL_COMPILER
+            __attribute__ ((fallthrough));
+#endif
+        case 5:
+            c.FTa[5] = XLALSimInspiralPNFlux_5PNCoeff(eta);
+#if __GNUC__ >= 7 && !defined __INTEL_COMPILER
+            __attribute__ ((fallthrough));
+#endif
+        case 4:
+            c.FTa[4] = XLALSimInspiralPNFlux_4PNCoeff(eta);
+            c.dETa[2] = 3. * XLALSimInspiralPNEnergy_4PNCoeff(eta);
+#if __GNUC__ >= 7 && !defined __INTEL_COMPILER
+            __attribute__ ((fallthrough));
+#endif
+        case 3:
+            c.FTa[3] = XLALSimInspiralPNFlux_3PNCoeff(eta);
+#if __GNUC__ >= 7 && !defined __INTEL_COMPILER
+            __attribute__ ((fallthrough));
+#endif
+        case 2:
+            c.FTa[2] = XLALSimInspiralPNFlux_2PNCoeff(eta);
+            c.dETa[1] = 2. * XLALSimInspiralPNEnergy_2PNCoeff(eta);
+#if __GNUC__ >= 7 && !defined __INTEL_COMPILER
+            __attribute__ ((fallthrough));
+#endif
+        case -1: /* Default to no SPA amplitude corrections */
+        case 0:
+            break;
+        default:
+            XLAL_ERROR(XLAL_ETYPE, "Invalid amplitude PN order %d", amplitudeO);
+    }
 
 
     /* Perform some initial checks */
@@ -349,37 +384,7 @@ int XLALSimInspiralTaylorF2Core(
     REAL8 ref_phasing = 0.;
     if( f_ref != 0. ) {
         const REAL8 vref = cbrt(piM*f_ref);
-        const REAL8 logvref = log(vref);
-        const REAL8 v2ref = vref * vref;
-        const REAL8 v3ref = vref * v2ref;
-        const REAL8 v4ref = vref * v3ref;
-        const REAL8 v5ref = vref * v4ref;
-        const REAL8 v6ref = vref * v5ref;
-        const REAL8 v7ref = vref * v6ref;
-        const REAL8 v8ref = vref * v7ref;
-        const REAL8 v9ref = vref * v8ref;
-        const REAL8 v10ref = vref * v9ref;
-        const REAL8 v12ref = v2ref * v10ref;
-        const REAL8 v13ref = vref * v12ref;
-        const REAL8 v14ref = vref * v13ref;
-        const REAL8 v15ref = vref * v14ref;
-        ref_phasing += pfa7 * v7ref;
-        ref_phasing += (pfa6 + pfl6 * logvref) * v6ref;
-        ref_phasing += (pfa5 + pfl5 * logvref) * v5ref;
-        ref_phasing += pfa4 * v4ref;
-        ref_phasing += pfa3 * v3ref;
-        ref_phasing += pfa2 * v2ref;
-        ref_phasing += pfa1 * vref;
-        ref_phasing += pfaN;
-
-        /* Tidal terms in reference phasing */
-        ref_phasing += pft15 * v15ref;
-        ref_phasing += pft14 * v14ref;
-        ref_phasing += pft13 * v13ref;
-        ref_phasing += pft12 * v12ref;
-        ref_phasing += pft10 * v10ref;
-
-        ref_phasing /= v5ref;
+        ref_phasing = TaylorF2Phasing(&c, vref, log(vref));
     } /* End of if(f_ref != 0) block */
 
     #pragma omp parallel for
@@ -388,91 +393,13 @@ int XLALSimInspiralTaylorF2Core(
         const REAL8 v = cbrt(piM*f);
         const REAL8 logv = log(v);
         const REAL8 v2 = v * v;
-        const REAL8 v3 = v * v2;
-        const REAL8 v4 = v * v3;
-        const REAL8 v5 = v * v4;
-        const REAL8 v6 = v * v5;
-        const REAL8 v7 = v * v6;
-        const REAL8 v8 = v * v7;
-        const REAL8 v9 = v * v8;
-        const REAL8 v10 = v * v9;
-        const REAL8 v12 = v2 * v10;
-        const REAL8 v13 = v * v12;
-        const REAL8 v14 = v * v13;
-        const REAL8 v15 = v * v14;
-        REAL8 phasing = 0.;
-        REAL8 dEnergy = 0.;
-        REAL8 flux = 0.;
-        REAL8 amp;
-
-        phasing += pfa7 * v7;
-        phasing += (pfa6 + pfl6 * logv) * v6;
-        phasing += (pfa5 + pfl5 * logv) * v5;
-        phasing += pfa4 * v4;
-        phasing += pfa3 * v3;
-        phasing += pfa2 * v2;
-        phasing += pfa1 * v;
-        phasing += pfaN;
-
-        /* Tidal terms in phasing */
-        phasing += pft15 * v15;
-        phasing += pft14 * v14;
-        phasing += pft13 * v13;
-        phasing += pft12 * v12;
-        phasing += pft10 * v10;
-
-    /* WARNING! Amplitude orders beyond 0 have NOT been reviewed!
-     * Use at your own risk. The default is to turn them off.
-     * These do not currently include spin corrections.
-     * Note that these are not higher PN corrections to the amplitude.
-     * They are the corrections to the leading-order amplitude arising
-     * from the stationary phase approximation. See for instance
-     * Eq 6.9 of arXiv:0810.5336
-     */
-	switch (amplitudeO)
-        {
-            case 7:
-                flux += FTa7 * v7;
-#if __GNUC__ >= 7 && !defined __INTEL_COMPILER
-                __attribute__ ((fallthrough));
-#endif
-            case 6:
-                flux += (FTa6 + FTl6*logv) * v6;
-                dEnergy += dETa3 * v6;
-#if __GNUC__ >= 7 && !defined __INTEL_COMPILER
-                __attribute__ ((fallthrough));
-#endif
-            case 5:
-                flux += FTa5 * v5;
-#if __GNUC__ >= 7 && !defined __INTEL_COMPILER
-                __attribute__ ((fallthrough));
-#endif
-            case 4:
-                flux += FTa4 * v4;
-                dEnergy += dETa2 * v4;
-#if __GNUC__ >= 7 && !defined __INTEL_COMPILER
-                __attribute__ ((fallthrough));
-#endif
-            case 3:
-                flux += FTa3 * v3;
-#if __GNUC__ >= 7 && !defined __INTEL_COMPILER
-                __attribute__ ((fallthrough));
-#endif
-            case 2:
-                flux += FTa2 * v2;
-                dEnergy += dETa1 * v2;
-#if __GNUC__ >= 7 && !defined __INTEL_COMPILER
-                __attribute__ ((fallthrough));
-#endif
-            case -1: /* Default to no SPA amplitude corrections */
-            case 0:
-                flux += 1.;
-                dEnergy += 1.;
-        }
+        REAL8 phasing, dEnergy, flux, amp;
+
+        phasing = TaylorF2Phasing(&c, v, logv);
+        flux = ((((((c.FTa[7] * v + c.FTa[6] + c.FTl6 * logv) * v + c.FTa[5]) * v
+            + c.FTa[4]) * v + c.FTa[3]) * v + c.FTa[2]) * v2 + c.FTa[0]) * c.FTaN * v2 * v2 * v2 * v2 * v2;
+        dEnergy = (((c.dETa[3] * v2 + c.dETa[2]) * v2 + c.dETa[1]) * v2 + c.dETa[0]) * c.dETaN * v;
 
-        phasing /= v5;
-        flux *= FTaN * v10;
-        dEnergy *= dETaN * v;
         // Note the factor of 2 b/c phi_ref is orbital phase
         phasing += shft * f - 2.*phi_ref - ref_phasing;
         amp = amp0 * sqrt(-dEnergy/flux) * v;
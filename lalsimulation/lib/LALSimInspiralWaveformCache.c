@@ -18,9 +18,11 @@
  */
 
 #include <math.h>
+#include <string.h>
 #include <LALSimInspiralWaveformCache.h>
 #include <lal/LALSimInspiral.h>
 #include <lal/LALSimIMR.h>
+#include <lal/AVFactories.h>
 #include <lal/FrequencySeries.h>
 #include <lal/Sequence.h>
 #include <lal/LALConstants.h>
@@ -78,6 +80,7 @@ static int StoreTDHCache(LALSimInspiralWaveformCache *cache,
 static int StoreFDHCache(LALSimInspiralWaveformCache *cache,
         COMPLEX16FrequencySeries *hptilde,
         COMPLEX16FrequencySeries *hctilde,
+        SphHarmFrequencySeries *hlms,
         REAL8 phiRef,
         REAL8 deltaT,
         REAL8 m1, REAL8 m2,
@@ -90,6 +93,34 @@ static int StoreFDHCache(LALSimInspiralWaveformCache *cache,
         Approximant approximant,
         REAL8Sequence *frequencies);
 
+static int ModeArraysAreDifferent(
+        LALDict *LALpars1,
+        LALDict *LALpars2);
+
+static int CachedModesPhiRefDependence(Approximant approximant);
+
+static int CachedPolarizationsAreTransformable(Approximant approximant);
+
+static int FDPolarizationsFromCachedModes(
+        COMPLEX16FrequencySeries **hptilde,
+        COMPLEX16FrequencySeries **hctilde,
+        LALSimInspiralWaveformCache *cache,
+        REAL8 phiRef,
+        REAL8 r,
+        REAL8 i);
+
+static void ClearCacheEntry(LALSimInspiralWaveformCache *entry);
+
+static void SwapCacheEntries(
+        LALSimInspiralWaveformCache *a,
+        LALSimInspiralWaveformCache *b);
+
+static void PromoteCacheEntry(
+        LALSimInspiralWaveformCache *cache,
+        LALSimInspiralWaveformCache *entry);
+
+static int MakeRoomInCache(LALSimInspiralWaveformCache *cache);
+
 
 /**
  * @addtogroup LALSimInspiralWaveformCache_h
@@ -450,7 +481,9 @@ int XLALSimInspiralChooseFDWaveformFromCache(
     size_t j;
     REAL8 dist_ratio, incl_ratio_plus, incl_ratio_cross, phase_diff;
     COMPLEX16 exp_dphi;
-    CacheVariableDiffersBitmask changedParams;
+    CacheVariableDiffersBitmask changedParams = INTRINSIC;
+    LALSimInspiralWaveformCache *entry;
+    int cacheModes;
 
 
     // If nonGRparams are not NULL, don't even try to cache.
@@ -468,29 +501,43 @@ int XLALSimInspiralChooseFDWaveformFromCache(
 				approximant);
     }
 
-    // Check which parameters have changed
-    changedParams = CacheArgsDifferenceBitmask(cache, phiRef, deltaF,
-            m1, m2, S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, f_max, r, i,
-	    LALpars, approximant, frequencies);
+    // Polarizations of approximants with a modes interface are summed from
+    // cached modes, so inclination, distance and possibly phiRef are free
+    cacheModes = (frequencies == NULL && !XLALSimInspiralWaveformParamsLookupEnableLIV(LALpars))
+        ? CachedModesPhiRefDependence(approximant) : -1;
+
+    // Look for a cached waveform that can be reused for these parameters,
+    // from the most to the least recently used
+    for (entry = cache; entry; entry = entry->next) {
+        if (entry->hptilde == NULL && entry->hlms == NULL) continue;
+        changedParams = CacheArgsDifferenceBitmask(entry, phiRef, deltaF,
+                m1, m2, S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, f_max, r, i,
+                LALpars, approximant, frequencies);
+        if ((changedParams & INTRINSIC) != 0) continue;
+        if (changedParams == NO_DIFFERENCE) break;
+        if (entry->hlms != NULL) {
+            if (cacheModes == 0 || (cacheModes == 1 && !(changedParams & PHI_REF))) break;
+        } else if (CachedPolarizationsAreTransformable(approximant)) break;
+    }
 
-    // No parameters have changed! Copy the cached polarizations
-    if( changedParams == NO_DIFFERENCE ) {
-        *hptilde = XLALCutCOMPLEX16FrequencySeries(cache->hptilde, 0,
-                cache->hptilde->data->length);
-        if (*hptilde == NULL) return XLAL_ENOMEM;
-        *hctilde = XLALCutCOMPLEX16FrequencySeries(cache->hctilde, 0,
-                cache->hctilde->data->length);
-        if (*hctilde == NULL) {
-            XLALDestroyCOMPLEX16FrequencySeries(*hptilde);
-            *hptilde = NULL;
-            return XLAL_ENOMEM;
+    // Nothing to reuse: generate a new waveform and cache it
+    if (entry == NULL) {
+        cache->misses++;
+
+        status = MakeRoomInCache(cache);
+        if (status != XLAL_SUCCESS) return status;
+
+        if (cacheModes >= 0) {
+            SphHarmFrequencySeries *hlms = XLALSimInspiralChooseFDModes(m1, m2,
+                    S1x, S1y, S1z, S2x, S2y, S2z, deltaF, f_min, f_max, f_ref,
+                    cacheModes ? phiRef : 0., r, i, LALpars, approximant);
+            if (hlms == NULL) XLAL_ERROR(XLAL_EFUNC);
+            status = StoreFDHCache(cache, NULL, NULL, hlms, phiRef, deltaF, m1, m2,
+                    S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, f_max, r, i, LALpars, approximant, frequencies);
+            if (status != XLAL_SUCCESS) return status;
+            return FDPolarizationsFromCachedModes(hptilde, hctilde, cache, phiRef, r, i);
         }
 
-        return XLAL_SUCCESS;
-    }
-
-    // Intrinsic parameters have changed. We must generate a new waveform
-    if( (changedParams & INTRINSIC) != 0 ) {
         if ( frequencies != NULL ){
             status =  XLALSimInspiralChooseFDWaveformSequence(hptilde, hctilde, phiRef,
                 m1, m2, S1x, S1y, S1z, S2x, S2y, S2z, f_ref,
@@ -505,68 +552,23 @@ int XLALSimInspiralChooseFDWaveformFromCache(
         }
         if (status == XLAL_FAILURE) return status;
 
-        return StoreFDHCache(cache, *hptilde, *hctilde, phiRef, deltaF, m1, m2,
+        return StoreFDHCache(cache, *hptilde, *hctilde, NULL, phiRef, deltaF, m1, m2,
 			     S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, f_max, r, i, LALpars, approximant, frequencies);
     }
 
-    // case 1: Non-precessing, 2nd harmonic only
-    if( approximant == TaylorF2 || approximant == TaylorF2RedSpin
-                || approximant == TaylorF2RedSpinTidal
-                || approximant == IMRPhenomA || approximant == IMRPhenomB
-                || approximant == IMRPhenomC ) {
-        // If polarizations are not cached we must generate a fresh waveform
-        // FIXME: Will need to check hlms and/or dynamical variables as well
-        if( cache->hptilde == NULL || cache->hctilde == NULL) {
-            if ( frequencies != NULL ){
-                status =  XLALSimInspiralChooseFDWaveformSequence(hptilde, hctilde, phiRef,
-                    m1, m2, S1x, S1y, S1z, S2x, S2y, S2z, f_ref,
-		    r, i, LALpars, approximant,frequencies);
-            }
-            else {
-	      status = XLALSimInspiralChooseFDWaveform(hptilde, hctilde, m1, m2,
-						       S1x, S1y, S1z, S2x, S2y, S2z, r, i, phiRef,
-						       0., 0., 0., deltaF, f_min, f_max, f_ref,
-						       LALpars, approximant);
-            }
-            if (status == XLAL_FAILURE) return status;
-
-            return StoreFDHCache(cache, *hptilde, *hctilde, phiRef, deltaF,
-                    m1, m2, S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, f_max, r, i,
-                    LALpars, approximant, frequencies);
-        }
+    // Reuse the cached waveform, which becomes the most recently used
+    cache->hits++;
+    PromoteCacheEntry(cache, entry);
 
-        // Set transformation coefficients for identity transformation.
-        // We'll adjust them depending on which extrinsic parameters changed.
-        dist_ratio = incl_ratio_plus = incl_ratio_cross = 1.;
-        phase_diff = 0.;
-        exp_dphi = 1.;
+    if (cache->hlms != NULL)
+        return FDPolarizationsFromCachedModes(hptilde, hctilde, cache, phiRef, r, i);
 
-        if( changedParams & PHI_REF ) {
-            // Only 2nd harmonic present, so {h+,hx} \propto e^(2 i phiRef)
-            phase_diff = 2.*(phiRef - cache->phiRef);
-            exp_dphi = cpolar(1., phase_diff);
-        }
-        if( changedParams & INCLINATION) {
-            // Rescale h+, hx by ratio of new/old inclination dependence
-            incl_ratio_plus = (1.0 + cos(i)*cos(i))
-                    / (1.0 + cos(cache->i)*cos(cache->i));
-            incl_ratio_cross = cos(i) / cos(cache->i);
-        }
-        if( changedParams & DISTANCE ) {
-            // Rescale h+, hx by ratio of (1/new_dist)/(1/old_dist) = old/new
-            dist_ratio = cache->r / r;
-        }
-
-        // Create the output polarizations
-        *hptilde = XLALCreateCOMPLEX16FrequencySeries(cache->hptilde->name,
-                &(cache->hptilde->epoch), cache->hptilde->f0,
-                cache->hptilde->deltaF, &(cache->hptilde->sampleUnits),
+    // No parameters have changed! Copy the cached polarizations
+    if( changedParams == NO_DIFFERENCE ) {
+        *hptilde = XLALCutCOMPLEX16FrequencySeries(cache->hptilde, 0,
                 cache->hptilde->data->length);
         if (*hptilde == NULL) return XLAL_ENOMEM;
-
-        *hctilde = XLALCreateCOMPLEX16FrequencySeries(cache->hctilde->name,
-                &(cache->hctilde->epoch), cache->hctilde->f0,
-                cache->hctilde->deltaF, &(cache->hctilde->sampleUnits),
+        *hctilde = XLALCutCOMPLEX16FrequencySeries(cache->hctilde, 0,
                 cache->hctilde->data->length);
         if (*hctilde == NULL) {
             XLALDestroyCOMPLEX16FrequencySeries(*hptilde);
@@ -574,53 +576,75 @@ int XLALSimInspiralChooseFDWaveformFromCache(
             return XLAL_ENOMEM;
         }
 
-        // Get new polarizations by transforming the old
-        incl_ratio_plus *= dist_ratio;
-        incl_ratio_cross *= dist_ratio;
-        for (j = 0; j < cache->hptilde->data->length; j++) {
-            (*hptilde)->data->data[j] = exp_dphi * incl_ratio_plus
-                    * cache->hptilde->data->data[j];
-            (*hctilde)->data->data[j] = exp_dphi * incl_ratio_cross
-                    * cache->hctilde->data->data[j];
-        }
-
         return XLAL_SUCCESS;
     }
 
-    // case 2: Precessing
-    /*else if( approximant == SpinTaylorF2 ) {
+    // Non-precessing, 2nd harmonic only: transform the cached polarizations.
+    // Set transformation coefficients for identity transformation.
+    // We'll adjust them depending on which extrinsic parameters changed.
+    dist_ratio = incl_ratio_plus = incl_ratio_cross = 1.;
+    phase_diff = 0.;
+    exp_dphi = 1.;
+
+    if( changedParams & PHI_REF ) {
+        // Only 2nd harmonic present, so {h+,hx} \propto e^(2 i phiRef)
+        phase_diff = 2.*(phiRef - cache->phiRef);
+        exp_dphi = cpolar(1., phase_diff);
+    }
+    if( changedParams & INCLINATION) {
+        // Rescale h+, hx by ratio of new/old inclination dependence
+        incl_ratio_plus = (1.0 + cos(i)*cos(i))
+                / (1.0 + cos(cache->i)*cos(cache->i));
+        incl_ratio_cross = cos(i) / cos(cache->i);
+    }
+    if( changedParams & DISTANCE ) {
+        // Rescale h+, hx by ratio of (1/new_dist)/(1/old_dist) = old/new
+        dist_ratio = cache->r / r;
+    }
 
-    }*/
+    // Create the output polarizations
+    *hptilde = XLALCreateCOMPLEX16FrequencySeries(cache->hptilde->name,
+            &(cache->hptilde->epoch), cache->hptilde->f0,
+            cache->hptilde->deltaF, &(cache->hptilde->sampleUnits),
+            cache->hptilde->data->length);
+    if (*hptilde == NULL) return XLAL_ENOMEM;
+
+    *hctilde = XLALCreateCOMPLEX16FrequencySeries(cache->hctilde->name,
+            &(cache->hctilde->epoch), cache->hctilde->f0,
+            cache->hctilde->deltaF, &(cache->hctilde->sampleUnits),
+            cache->hctilde->data->length);
+    if (*hctilde == NULL) {
+        XLALDestroyCOMPLEX16FrequencySeries(*hptilde);
+        *hptilde = NULL;
+        return XLAL_ENOMEM;
+    }
 
-    // Catch-all. Unsure what to do, don't try to cache.
-    // Basically, you requested a waveform type which is not setup for caching
-    // b/c of lack of interest or it's unclear what/how to cache for that model
-    else {
-        if ( frequencies != NULL ){
-            return XLALSimInspiralChooseFDWaveformSequence(hptilde, hctilde, phiRef,
-                    m1, m2, S1x, S1y, S1z, S2x, S2y, S2z, f_ref,
-                    r, i, LALpars, approximant,frequencies);
-        }
-        else {
-	  return XLALSimInspiralChooseFDWaveform(hptilde, hctilde, m1, m2,
-						 S1x, S1y, S1z, S2x, S2y, S2z,
-						 r, i, phiRef, 0., 0., 0.,
-						 deltaF, f_min, f_max, f_ref,
-						 LALpars, approximant);
-        }
+    // Get new polarizations by transforming the old
+    incl_ratio_plus *= dist_ratio;
+    incl_ratio_cross *= dist_ratio;
+    for (j = 0; j < cache->hptilde->data->length; j++) {
+        (*hptilde)->data->data[j] = exp_dphi * incl_ratio_plus
+                * cache->hptilde->data->data[j];
+        (*hctilde)->data->data[j] = exp_dphi * incl_ratio_cross
+                * cache->hctilde->data->data[j];
     }
 
+    return XLAL_SUCCESS;
 }
 
 /**
  * Construct and initialize a waveform cache.  Caches are used to
  * avoid re-computation of waveforms that differ only by simple
- * scaling relations in extrinsic parameters.
+ * scaling relations in extrinsic parameters.  The cache holds a single
+ * frequency-domain waveform;  use XLALSimInspiralWaveformCacheSetCapacity()
+ * to keep more.
  */
 LALSimInspiralWaveformCache *XLALCreateSimInspiralWaveformCache()
 {
     LALSimInspiralWaveformCache *cache = XLALCalloc(1,
             sizeof(LALSimInspiralWaveformCache));
+    if (cache)
+        cache->capacity = 1;
 
     return cache;
 }
@@ -630,18 +654,193 @@ LALSimInspiralWaveformCache *XLALCreateSimInspiralWaveformCache()
  */
 void XLALDestroySimInspiralWaveformCache(LALSimInspiralWaveformCache *cache)
 {
-    if (cache != NULL) {
-        XLALDestroyREAL8TimeSeries(cache->hplus);
-        XLALDestroyREAL8TimeSeries(cache->hcross);
-        XLALDestroyCOMPLEX16FrequencySeries(cache->hptilde);
-        XLALDestroyCOMPLEX16FrequencySeries(cache->hctilde);
-        if(cache->LALpars) XLALDestroyDict(cache->LALpars);
+    while (cache != NULL) {
+        LALSimInspiralWaveformCache *next = cache->next;
+        ClearCacheEntry(cache);
         XLALFree(cache);
+        cache = next;
     }
 }
 
+/**
+ * Set the number of frequency-domain waveforms kept in a cache.  When the
+ * cache is full, the least recently used waveform is dropped to make room
+ * for a new one.  Keeping a few waveforms lets a sampler that returns to
+ * earlier intrinsic parameters, e.g. after a rejected jump, reuse them.
+ */
+int XLALSimInspiralWaveformCacheSetCapacity(LALSimInspiralWaveformCache *cache, UINT4 capacity)
+{
+    LALSimInspiralWaveformCache *entry;
+    UINT4 n;
+
+    XLAL_CHECK(cache != NULL, XLAL_EFAULT);
+    XLAL_CHECK(capacity > 0, XLAL_EINVAL, "Cache capacity must be positive");
+
+    /* drop the least recently used waveforms that no longer fit */
+    for (entry = cache, n = 1; entry->next && n < capacity; entry = entry->next, n++);
+    XLALDestroySimInspiralWaveformCache(entry->next);
+    entry->next = NULL;
+
+    cache->capacity = capacity;
+    return XLAL_SUCCESS;
+}
+
+/**
+ * Fraction of the frequency-domain waveform requests to a cache that were
+ * served without generating a waveform, or 0 if there were none.  The counts
+ * are in the hits and misses fields of the cache.
+ */
+REAL8 XLALSimInspiralWaveformCacheHitRate(const LALSimInspiralWaveformCache *cache)
+{
+    if (cache == NULL || cache->hits + cache->misses == 0)
+        return 0.;
+    return (REAL8) cache->hits / (cache->hits + cache->misses);
+}
+
 /** @} */
 
+/**
+ * Whether cached modes of an approximant depend on phiRef: 0 if the modes
+ * are generated independently of phiRef and the polarizations are summed
+ * with the azimuthal angle pi/2 - phiRef, 1 if phiRef is used to generate
+ * the modes, and -1 if the approximant's modes are not cached.  Follows
+ * XLALSimInspiralPolarizationsFromChooseFDModes().  The modes of precessing
+ * approximants depend on the inclination and are not cached.
+ */
+static int CachedModesPhiRefDependence(Approximant approximant)
+{
+    switch (approximant) {
+        case SEOBNRv4HM_ROM:
+            return 0;
+        case EOBNRv2HM_ROM:
+        case IMRPhenomXHM:
+        case IMRPhenomHM:
+            return 1;
+        default:
+            return -1;
+    }
+}
+
+/**
+ * Whether cached polarizations of an approximant can be transformed to new
+ * extrinsic parameters:  only for non-precessing waveforms with the 2nd
+ * harmonic only.
+ */
+static int CachedPolarizationsAreTransformable(Approximant approximant)
+{
+    return approximant == TaylorF2 || approximant == TaylorF2RedSpin
+                || approximant == TaylorF2RedSpinTidal
+                || approximant == IMRPhenomA || approximant == IMRPhenomB
+                || approximant == IMRPhenomC;
+}
+
+/**
+ * Sum the cached modes into polarizations for new extrinsic parameters.
+ * The phiRef of the cached modes equals phiRef whenever the approximant
+ * uses it to generate them.
+ */
+static int FDPolarizationsFromCachedModes(
+        COMPLEX16FrequencySeries **hptilde,
+        COMPLEX16FrequencySeries **hctilde,
+        LALSimInspiralWaveformCache *cache,
+        REAL8 phiRef,
+        REAL8 r,
+        REAL8 i
+        )
+{
+    REAL8 azimuthal = LAL_PI_2 - phiRef;
+    size_t j;
+
+    if (cache->approximant == IMRPhenomXHM)
+        azimuthal = LAL_PI_2;
+    else if (cache->approximant == EOBNRv2HM_ROM)
+        azimuthal = 0.;
+
+    *hptilde = *hctilde = NULL;
+    if (XLALSimInspiralPolarizationsFromSphHarmFrequencySeries(hptilde, hctilde, cache->hlms, i, azimuthal) != XLAL_SUCCESS)
+        XLAL_ERROR(XLAL_EFUNC);
+
+    if (r != cache->r) {
+        REAL8 dist_ratio = cache->r / r;
+        for (j = 0; j < (*hptilde)->data->length; j++) {
+            (*hptilde)->data->data[j] *= dist_ratio;
+            (*hctilde)->data->data[j] *= dist_ratio;
+        }
+    }
+
+    return XLAL_SUCCESS;
+}
+
+/** Free the waveforms and parameters held by a cache entry */
+static void ClearCacheEntry(LALSimInspiralWaveformCache *entry)
+{
+    XLALDestroyREAL8TimeSeries(entry->hplus);
+    XLALDestroyREAL8TimeSeries(entry->hcross);
+    XLALDestroyCOMPLEX16FrequencySeries(entry->hptilde);
+    XLALDestroyCOMPLEX16FrequencySeries(entry->hctilde);
+    XLALDestroySphHarmFrequencySeries(entry->hlms);
+    XLALDestroyREAL8Sequence(entry->frequencies);
+    if(entry->LALpars) XLALDestroyDict(entry->LALpars);
+    entry->hplus = entry->hcross = NULL;
+    entry->hptilde = entry->hctilde = NULL;
+    entry->hlms = NULL;
+    entry->frequencies = NULL;
+    entry->LALpars = NULL;
+}
+
+/** Exchange the waveforms and parameters of two cache entries, leaving
+ * the list and its statistics in place */
+static void SwapCacheEntries(LALSimInspiralWaveformCache *a, LALSimInspiralWaveformCache *b)
+{
+    LALSimInspiralWaveformCache tmp = *a;
+    *a = *b;
+    *b = tmp;
+    b->next = a->next;
+    a->next = tmp.next;
+    b->capacity = a->capacity;
+    b->hits = a->hits;
+    b->misses = a->misses;
+    a->capacity = tmp.capacity;
+    a->hits = tmp.hits;
+    a->misses = tmp.misses;
+}
+
+/** Move a cache entry to the head of the cache, keeping the order of the others */
+static void PromoteCacheEntry(LALSimInspiralWaveformCache *cache, LALSimInspiralWaveformCache *entry)
+{
+    for (; cache != entry; cache = cache->next)
+        SwapCacheEntries(cache, entry);
+}
+
+/**
+ * Free the head of the cache for a new FD waveform, moving the waveform
+ * there down the list and dropping the least recently used one if the cache
+ * is full.  A head without FD data is simply overwritten.
+ */
+static int MakeRoomInCache(LALSimInspiralWaveformCache *cache)
+{
+    LALSimInspiralWaveformCache *entry, *prev = NULL;
+    UINT4 n = 1;
+
+    if ((cache->hptilde == NULL && cache->hlms == NULL) || cache->capacity <= 1)
+        return XLAL_SUCCESS;
+
+    for (entry = cache; entry->next; prev = entry, entry = entry->next, n++);
+    if (n < cache->capacity) {
+        /* room for one more */
+        entry = XLALCalloc(1, sizeof(*entry));
+        if (entry == NULL) XLAL_ERROR(XLAL_ENOMEM);
+    } else {
+        /* drop the least recently used */
+        ClearCacheEntry(entry);
+        prev->next = NULL;
+    }
+    entry->next = cache->next;
+    cache->next = entry;
+    SwapCacheEntries(cache, entry);
+    return XLAL_SUCCESS;
+}
+
 /**
  * Function to compare the requested arguments to those stored in the cache,
  * returns a bitmask which determines if a cached waveform can be recycled.
@@ -685,12 +884,13 @@ static CacheVariableDiffersBitmask CacheArgsDifferenceBitmask(
     if ( XLALSimInspiralWaveformParamsLookupTidalOctupolarLambda1(LALpars) != XLALSimInspiralWaveformParamsLookupTidalOctupolarLambda1(cache->LALpars)) return INTRINSIC;
     if ( XLALSimInspiralWaveformParamsLookupTidalOctupolarLambda2(LALpars) != XLALSimInspiralWaveformParamsLookupTidalOctupolarLambda2(cache->LALpars)) return INTRINSIC;
     if ( XLALSimInspiralWaveformParamsLookupTidalHexadecapolarLambda1(LALpars) != XLALSimInspiralWaveformParamsLookupTidalHexadecapolarLambda1(cache->LALpars)) return INTRINSIC;
-    if ( XLALSimInspiralWaveformParamsLookupTidalHexadecapolarLambda2(LALpars) != XLALSimInspiralWaveformParamsLookupTidalHexadecapolarLambda1(cache->LALpars)) return INTRINSIC;
+    if ( XLALSimInspiralWaveformParamsLookupTidalHexadecapolarLambda2(LALpars) != XLALSimInspiralWaveformParamsLookupTidalHexadecapolarLambda2(cache->LALpars)) return INTRINSIC;
     if ( XLALSimInspiralWaveformParamsLookupdQuadMon1(LALpars) != XLALSimInspiralWaveformParamsLookupdQuadMon1(cache->LALpars)) return INTRINSIC;
     if ( XLALSimInspiralWaveformParamsLookupdQuadMon2(LALpars) != XLALSimInspiralWaveformParamsLookupdQuadMon2(cache->LALpars)) return INTRINSIC;
     
     if ( XLALSimInspiralWaveformParamsLookupPNAmplitudeOrder(LALpars) != XLALSimInspiralWaveformParamsLookupPNAmplitudeOrder(cache->LALpars)) return INTRINSIC;
-    if ( XLALSimInspiralWaveformParamsLookupPNAmplitudeOrder(LALpars) != XLALSimInspiralWaveformParamsLookupPNAmplitudeOrder(cache->LALpars)) return INTRINSIC;
+    if ( XLALSimInspiralWaveformParamsLookupPNPhaseOrder(LALpars) != XLALSimInspiralWaveformParamsLookupPNPhaseOrder(cache->LALpars)) return INTRINSIC;
+    if ( ModeArraysAreDifferent(LALpars, cache->LALpars) ) return INTRINSIC;
 
     if ( approximant != cache->approximant) return INTRINSIC;
 
@@ -723,6 +923,24 @@ static int FrequenciesAreDifferent(
     return 0;
 }
 
+/**
+ * Function to compare the mode arrays of two LALDicts.
+ * Returns 1 if different, 0 if the same (including if neither has one)
+ */
+static int ModeArraysAreDifferent(
+        LALDict *LALpars1,
+        LALDict *LALpars2
+        )
+{
+    LALValue *modes1 = XLALSimInspiralWaveformParamsLookupModeArray(LALpars1);
+    LALValue *modes2 = XLALSimInspiralWaveformParamsLookupModeArray(LALpars2);
+    int different = !(modes1 == NULL && modes2 == NULL)
+        && (modes1 == NULL || modes2 == NULL || !XLALValueEqual(modes1, modes2));
+    XLALDestroyValue(modes1);
+    XLALDestroyValue(modes2);
+    return different;
+}
+
 /** Store the output TD hplus and hcross in the cache. */
 static int StoreTDHCache(LALSimInspiralWaveformCache *cache,
         REAL8TimeSeries *hplus,
@@ -750,6 +968,9 @@ static int StoreTDHCache(LALSimInspiralWaveformCache *cache,
         cache->hctilde = NULL;
     }
 
+    XLALDestroySphHarmFrequencySeries(cache->hlms);
+    cache->hlms = NULL;
+
     /* Store params in cache */
     cache->phiRef = phiRef;
     cache->deltaTF = deltaT;
@@ -792,10 +1013,12 @@ static int StoreTDHCache(LALSimInspiralWaveformCache *cache,
     return XLAL_SUCCESS;
 }
 
-/** Store the output FD hptilde and hctilde in cache. */
+/** Store the output FD hptilde and hctilde, or the modes hlms, in cache.
+ * The modes are owned by the cache afterwards. */
 static int StoreFDHCache(LALSimInspiralWaveformCache *cache,
         COMPLEX16FrequencySeries *hptilde,
         COMPLEX16FrequencySeries *hctilde,
+        SphHarmFrequencySeries *hlms,
         REAL8 phiRef,
         REAL8 deltaT,
         REAL8 m1, REAL8 m2,
@@ -850,6 +1073,10 @@ static int StoreFDHCache(LALSimInspiralWaveformCache *cache,
     // NB: XLALCut... creates a new Series object and copies data and metadata
     XLALDestroyCOMPLEX16FrequencySeries(cache->hptilde);
     XLALDestroyCOMPLEX16FrequencySeries(cache->hctilde);
+    XLALDestroySphHarmFrequencySeries(cache->hlms);
+    cache->hptilde = cache->hctilde = NULL;
+    cache->hlms = hlms;
+    if (hlms != NULL) return XLAL_SUCCESS;
     cache->hptilde = XLALCutCOMPLEX16FrequencySeries(hptilde, 0,
             hptilde->data->length);
     if (cache->hptilde == NULL) return XLAL_ENOMEM;
@@ -1505,3 +1732,118 @@ int XLALSimInspiralChooseFDWaveformSequence(
 
     return ret;
 }
+
+/* element i of an optional parameter vector, or 0 if it is not given */
+static REAL8 BatchParam(const REAL8Vector *v, UINT4 i)
+{
+    return v ? v->data[i] : 0.;
+}
+
+/**
+ * Batched version of XLALSimInspiralChooseFDWaveformSequence() for
+ * generating many waveforms on a common frequency grid, e.g. when building
+ * template banks or reduced-order bases.  The intrinsic parameters of
+ * template k are element k of the vectors m1, m2, S1x, ..., S2z, which must
+ * all have the same length;  any of the spin vectors may be NULL, meaning
+ * zero for every template.  The other arguments are shared by all the
+ * templates.
+ *
+ * On success *hptilde and *hctilde are set to newly-allocated arrays of
+ * dimension (number of templates, frequencies->length), so that the
+ * waveform of template k at frequency j is at offset
+ * k * frequencies->length + j.
+ *
+ * The shared arguments are checked once for the batch.  When compiled with
+ * OpenMP the templates are generated in parallel, each thread working from
+ * its own copy of LALpars since the waveform drivers may add entries to it.
+ */
+int XLALSimInspiralChooseFDWaveformSequenceBatch(
+    COMPLEX16Array **hptilde,               /**< FD plus polarizations, one row per template */
+    COMPLEX16Array **hctilde,               /**< FD cross polarizations, one row per template */
+    REAL8 phiRef,                           /**< reference orbital phase (rad) */
+    const REAL8Vector *m1,                  /**< masses of companion 1 (kg) */
+    const REAL8Vector *m2,                  /**< masses of companion 2 (kg) */
+    const REAL8Vector *S1x,                 /**< x-components of the dimensionless spin of object 1, or NULL */
+    const REAL8Vector *S1y,                 /**< y-components of the dimensionless spin of object 1, or NULL */
+    const REAL8Vector *S1z,                 /**< z-components of the dimensionless spin of object 1, or NULL */
+    const REAL8Vector *S2x,                 /**< x-components of the dimensionless spin of object 2, or NULL */
+    const REAL8Vector *S2y,                 /**< y-components of the dimensionless spin of object 2, or NULL */
+    const REAL8Vector *S2z,                 /**< z-components of the dimensionless spin of object 2, or NULL */
+    REAL8 f_ref,                            /**< Reference frequency (Hz) */
+    REAL8 distance,                         /**< distance of source (m) */
+    REAL8 inclination,                      /**< inclination of source (rad) */
+    LALDict *LALpars,                       /**< LALDictionary containing non-mandatory variables/flags */
+    Approximant approximant,                /**< post-Newtonian approximant to use for waveform production */
+    REAL8Sequence *frequencies              /**< sequence of frequencies for which the waveforms will be computed */
+)
+{
+    const REAL8Vector *spins[6] = {S1x, S1y, S1z, S2x, S2y, S2z};
+    UINT4 ntemplates, nfreqs, k;
+    int failed = 0;
+
+    XLAL_CHECK(hptilde && hctilde, XLAL_EFAULT);
+    XLAL_CHECK(*hptilde == NULL && *hctilde == NULL, XLAL_EFAULT);
+    XLAL_CHECK(m1 && m2 && frequencies, XLAL_EFAULT);
+    XLAL_CHECK(m1->length == m2->length, XLAL_EBADLEN);
+    for (k = 0; k < 6; k++)
+        XLAL_CHECK(!spins[k] || spins[k]->length == m1->length, XLAL_EBADLEN);
+    XLAL_CHECK(frequencies->length > 0, XLAL_EBADLEN);
+
+    ntemplates = m1->length;
+    nfreqs = frequencies->length;
+    if (ntemplates == 0)
+        XLAL_ERROR(XLAL_EBADLEN, "no templates requested");
+    *hptilde = XLALCreateCOMPLEX16ArrayL(2, ntemplates, nfreqs);
+    *hctilde = XLALCreateCOMPLEX16ArrayL(2, ntemplates, nfreqs);
+    if (!*hptilde || !*hctilde) {
+        XLALDestroyCOMPLEX16Array(*hptilde);
+        XLALDestroyCOMPLEX16Array(*hctilde);
+        *hptilde = *hctilde = NULL;
+        XLAL_ERROR(XLAL_EFUNC);
+    }
+
+    #pragma omp parallel
+    {
+        LALDict *pars = LALpars ? XLALDictDuplicate(LALpars) : NULL;
+        if (LALpars && !pars) {
+            #pragma omp atomic write
+            failed = 1;
+        }
+
+        #pragma omp for schedule(dynamic)
+        for (k = 0; k < ntemplates; k++) {
+            COMPLEX16FrequencySeries *hp = NULL, *hc = NULL;
+            int stop;
+            #pragma omp atomic read
+            stop = failed;
+            if (stop)
+                continue;
+            if (XLALSimInspiralChooseFDWaveformSequence(&hp, &hc, phiRef,
+                    m1->data[k], m2->data[k],
+                    BatchParam(S1x, k), BatchParam(S1y, k), BatchParam(S1z, k),
+                    BatchParam(S2x, k), BatchParam(S2y, k), BatchParam(S2z, k),
+                    f_ref, distance, inclination, pars, approximant, frequencies) == XLAL_SUCCESS
+                    && hp->data->length == nfreqs && hc->data->length == nfreqs) {
+                memcpy(&(*hptilde)->data[(size_t) k * nfreqs], hp->data->data, nfreqs * sizeof(*hp->data->data));
+                memcpy(&(*hctilde)->data[(size_t) k * nfreqs], hc->data->data, nfreqs * sizeof(*hc->data->data));
+            } else {
+                XLALPrintError("XLAL Error - %s: failed to generate template %u\n", __func__, k);
+                #pragma omp atomic write
+                failed = 1;
+            }
+            XLALDestroyCOMPLEX16FrequencySeries(hp);
+            XLALDestroyCOMPLEX16FrequencySeries(hc);
+        }
+
+        XLALDestroyDict(pars);
+    }
+
+    if (failed) {
+        XLALDestroyCOMPLEX16Array(*hptilde);
+        XLALDestroyCOMPLEX16Array(*hctilde);
+        *hptilde = *hctilde = NULL;
+        XLAL_ERROR(XLAL_EFUNC);
+    }
+
+    return XLAL_SUCCESS;
+}
@@ -97,6 +97,11 @@ tagLALSimInspiralWaveformCache {
     LALDict *LALpars;
     Approximant approximant;
     REAL8Sequence *frequencies;
+    SphHarmFrequencySeries *hlms;   /* FD modes, for approximants whose polarizations are summed from their modes */
+    UINT4 capacity;                 /* maximum number of FD waveforms kept;  the least recently used is dropped first */
+    INT8 hits;                      /* number of FD requests served from the cache */
+    INT8 misses;                    /* number of FD requests that generated a waveform */
+    struct tagLALSimInspiralWaveformCache *next;  /* less recently used FD waveforms */
 } LALSimInspiralWaveformCache;
 
 /** @} */
@@ -105,12 +110,18 @@ LALSimInspiralWaveformCache *XLALCreateSimInspiralWaveformCache(void);
 
 void XLALDestroySimInspiralWaveformCache(LALSimInspiralWaveformCache *cache);
 
+int XLALSimInspiralWaveformCacheSetCapacity(LALSimInspiralWaveformCache *cache, UINT4 capacity);
+
+REAL8 XLALSimInspiralWaveformCacheHitRate(const LALSimInspiralWaveformCache *cache);
+
 int XLALSimInspiralChooseTDWaveformFromCache(REAL8TimeSeries **hplus, REAL8TimeSeries **hcross, REAL8 phiRef, REAL8 deltaT, REAL8 m1, REAL8 m2, REAL8 s1x, REAL8 s1y, REAL8 s1z, REAL8 s2x, REAL8 s2y, REAL8 s2z, REAL8 f_min, REAL8 f_ref, REAL8 r, REAL8 i, LALDict *LALpars, Approximant approximant, LALSimInspiralWaveformCache *cache);
 
 int XLALSimInspiralChooseFDWaveformFromCache(COMPLEX16FrequencySeries **hptilde, COMPLEX16FrequencySeries **hctilde, REAL8 phiRef, REAL8 deltaF, REAL8 m1, REAL8 m2, REAL8 S1x, REAL8 S1y, REAL8 S1z, REAL8 S2x, REAL8 S2y, REAL8 S2z, REAL8 f_min, REAL8 f_max, REAL8 f_ref, REAL8 r, REAL8 i, LALDict *LALpars, Approximant approximant, LALSimInspiralWaveformCache *cache, REAL8Sequence *frequencies);
 
 int XLALSimInspiralChooseFDWaveformSequence(COMPLEX16FrequencySeries **hptilde, COMPLEX16FrequencySeries **hctilde, REAL8 phiRef, REAL8 m1, REAL8 m2, REAL8 S1x, REAL8 S1y, REAL8 S1z, REAL8 S2x, REAL8 S2y, REAL8 S2z, REAL8 f_ref, REAL8 r, REAL8 i, LALDict *LALpars, Approximant approximant, REAL8Sequence *frequencies);
 
+int XLALSimInspiralChooseFDWaveformSequenceBatch(COMPLEX16Array **hptilde, COMPLEX16Array **hctilde, REAL8 phiRef, const REAL8Vector *m1, const REAL8Vector *m2, const REAL8Vector *S1x, const REAL8Vector *S1y, const REAL8Vector *S1z, const REAL8Vector *S2x, const REAL8Vector *S2y, const REAL8Vector *S2z, REAL8 f_ref, REAL8 r, REAL8 i, LALDict *LALpars, Approximant approximant, REAL8Sequence *frequencies);
+
 #if 0
 { /* so that editors will match succeeding brace */
 #elif defined(__cplusplus)
@@ -14,9 +14,11 @@
 #define DEFINE_LOOKUP_FUNC(NAME, TYPE, KEY, DEFAULT) \
 	TYPE XLALSimInspiralWaveformParamsLookup ## NAME(LALDict *params) \
 	{ \
+		static LALDictKey key = LAL_DICT_KEY_INIT(KEY); \
 		TYPE value = DEFAULT; \
-		if (params && XLALDictContains(params, KEY)) \
-			value = XLALDictLookup ## TYPE ## Value(params, KEY); \
+		const LALValue *entry = params ? XLALDictLookupKeyValue(params, &key) : NULL; \
+		if (entry) \
+			value = XLALValueGet ## TYPE(entry); \
 		return value; \
 	}
 
@@ -211,24 +213,22 @@ DEFINE_LOOKUP_FUNC(NumRelData, String, "numreldata", NULL)
 LALValue* XLALSimInspiralWaveformParamsLookupModeArray(LALDict *params)
 {
 	/* Initialise and set Default to NULL */
+	static LALDictKey key = LAL_DICT_KEY_INIT("ModeArray");
 	LALValue * value = NULL;
-	if (params && XLALDictContains(params, "ModeArray"))
-	{
-		LALDictEntry * entry = XLALDictLookup(params, "ModeArray");
-		value = XLALValueDuplicate(XLALDictEntryGetValue(entry));
-	}
+	const LALValue * entry = params ? XLALDictLookupKeyValue(params, &key) : NULL;
+	if (entry)
+		value = XLALValueDuplicate(entry);
 	return value;
 }
 
 LALValue* XLALSimInspiralWaveformParamsLookupModeArrayJframe(LALDict *params)
 {
 	/* Initialise and set Default to NULL */
+	static LALDictKey key = LAL_DICT_KEY_INIT("ModeArrayJframe");
 	LALValue * value = NULL;
-	if (params && XLALDictContains(params, "ModeArrayJframe"))
-	{
-		LALDictEntry * entry = XLALDictLookup(params, "ModeArrayJframe");
-		value = XLALValueDuplicate(XLALDictEntryGetValue(entry));
-	}
+	const LALValue * entry = params ? XLALDictLookupKeyValue(params, &key) : NULL;
+	if (entry)
+		value = XLALValueDuplicate(entry);
 	return value;
 }
 
@@ -554,23 +554,16 @@ static REAL8 gp_predict(
     gsl_vector *dummy_worker    /**< Dummy worker array for computations. */
     )
 {
-    // Evaluate vector K_*
+    // Evaluate y_* = K_* . alpha, accumulating the kernel values as they
+    // are computed rather than storing K_*
     const UINT4 n = x_train->size1;
-    gsl_vector *Kst = gsl_vector_alloc(n);
-    if (Kst == NULL){
-        XLAL_ERROR(XLAL_ENOMEM, "gsl_vector_alloc failed.");
-    }
+    REAL8 res = 0;
     for (UINT4 i=0; i < n; i++) {
         const gsl_vector x = gsl_matrix_const_row(x_train, i).vector;
         const REAL8 ker = kernel(xst, &x, hyperparams, dummy_worker);
-        gsl_vector_set(Kst, i, ker);
+        res += ker * gsl_vector_get(hyperparams->alpha, i);
     }
 
-    // Evaluate y_*
-    REAL8 res = 0;
-    gsl_blas_ddot(Kst, hyperparams->alpha, &res);
-    gsl_vector_free(Kst);
-
     return res + hyperparams->y_train_mean;
 }
 
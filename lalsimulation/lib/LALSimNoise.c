@@ -26,6 +26,8 @@
 #include <lal/Date.h>
 #include <lal/LALConstants.h>
 #include <lal/LALStdlib.h>
+#include <lal/AVFactories.h>
+#include <lal/Random.h>
 #include <lal/FrequencySeries.h>
 #include <lal/Sequence.h>
 #include <lal/TimeSeries.h>
@@ -38,12 +40,15 @@
  * This routine generates a single segment of data.  Note that this segment is
  * generated in the frequency domain and is inverse Fourier transformed into
  * the time domain; consequently the data is periodic in the time domain.
+ * The normal deviates are drawn from rng or, if rng is NULL, from the Philox
+ * stream (seed, stream).
  */
-static int XLALSimNoiseSegment(REAL8TimeSeries *s, REAL8FrequencySeries *psd, gsl_rng *rng)
+static int XLALSimNoiseSegment(REAL8TimeSeries *s, REAL8FrequencySeries *psd, gsl_rng *rng, UINT8 seed, UINT8 stream)
 {
 	size_t k;
 	REAL8FFTPlan *plan;
 	COMPLEX16FrequencySeries *stilde;
+	REAL8Vector *deviates = NULL;
 
 	plan = XLALCreateReverseREAL8FFTPlan(s->data->length, 0);
 	if (! plan)
@@ -55,6 +60,16 @@ static int XLALSimNoiseSegment(REAL8TimeSeries *s, REAL8FrequencySeries *psd, gs
 		XLAL_ERROR(XLAL_EFUNC);
 	}
 
+	if (! rng) {
+		deviates = XLALCreateREAL8Vector(2 * stilde->data->length);
+		if (! deviates || XLALPhiloxNormalDeviates(deviates, seed, stream) < 0) {
+			XLALDestroyREAL8Vector(deviates);
+			XLALDestroyCOMPLEX16FrequencySeries(stilde);
+			XLALDestroyREAL8FFTPlan(plan);
+			XLAL_ERROR(XLAL_EFUNC);
+		}
+	}
+
 	/* correct units: [stilde] = sqrt([psd] * seconds) */
 	XLALUnitMultiply(&stilde->sampleUnits, &psd->sampleUnits, &lalSecondUnit);
 	XLALUnitSqrt(&stilde->sampleUnits, &stilde->sampleUnits);
@@ -62,17 +77,75 @@ static int XLALSimNoiseSegment(REAL8TimeSeries *s, REAL8FrequencySeries *psd, gs
 	stilde->data->data[0] = 0.0;
 	for (k = 0; k < s->data->length/2 + 1; ++k) {
 		double sigma = 0.5 * sqrt(psd->data->data[k] / psd->deltaF);
-		stilde->data->data[k] = gsl_ran_gaussian_ziggurat(rng, sigma);
-		stilde->data->data[k] += I * gsl_ran_gaussian_ziggurat(rng, sigma);
+		if (deviates)
+			stilde->data->data[k] = sigma * (deviates->data[2*k] + I * deviates->data[2*k + 1]);
+		else {
+			stilde->data->data[k] = gsl_ran_gaussian_ziggurat(rng, sigma);
+			stilde->data->data[k] += I * gsl_ran_gaussian_ziggurat(rng, sigma);
+		}
 	}
 
 	XLALREAL8FreqTimeFFT(s, stilde, plan);
 
+	XLALDestroyREAL8Vector(deviates);
 	XLALDestroyCOMPLEX16FrequencySeries(stilde);
 	XLALDestroyREAL8FFTPlan(plan);
 	return 0;
 }
 
+/*
+ * Common part of XLALSimNoise() and XLALSimNoiseFromSeed().  With rng NULL
+ * the new segment is the Philox stream (seed, segment), and for stride equal
+ * to the data length the segment that is feathered in from is the stream
+ * (seed, segment - 1).
+ */
+static int XLALSimNoiseStride(REAL8TimeSeries *s, size_t stride, REAL8FrequencySeries *psd, gsl_rng *rng, UINT8 seed, UINT8 segment)
+{
+	REAL8Vector *overlap;
+	size_t j;
+
+	/* make sure that the resolution of the frequency series is
+	 * commensurate with the requested time series */
+	if (s->data->length/2 + 1 != psd->data->length
+			|| (size_t)floor(0.5 + 1.0/(s->deltaT * psd->deltaF)) != s->data->length)
+		XLAL_ERROR(XLAL_EINVAL);
+
+	/* stride cannot be longer than data length */
+	if (stride > s->data->length)
+		XLAL_ERROR(XLAL_EINVAL);
+
+	if (stride == 0) { /* generate segment with no feathering */
+		XLALSimNoiseSegment(s, psd, rng, seed, segment);
+		return 0;
+	} else if (stride == s->data->length) {
+		/* will generate two independent noise realizations
+		 * and feather them together with full overlap */
+		XLALSimNoiseSegment(s, psd, rng, seed, segment - 1);
+		stride = 0;
+	}
+
+	overlap = XLALCreateREAL8Sequence(s->data->length - stride);
+
+	/* copy overlap region between the old and the new data to temporary storage */
+	memcpy(overlap->data, s->data->data + stride, overlap->length*sizeof(*overlap->data));
+	
+	/* generate the new data */
+	XLALSimNoiseSegment(s, psd, rng, seed, segment);
+
+	/* feather old data in overlap region with new data */
+	for (j = 0; j < overlap->length; ++j) {
+		double x = cos(LAL_PI*j/(2.0 * overlap->length));
+		double y = sin(LAL_PI*j/(2.0 * overlap->length));
+		s->data->data[j] = x*overlap->data[j] + y*s->data->data[j];
+	}
+
+	XLALDestroyREAL8Sequence(overlap);
+
+	/* advance time */
+	XLALGPSAdd(&s->epoch, stride * s->deltaT);
+	return 0;
+}
+
 /**
  * @addtogroup LALSimNoise_c
  * @brief Routines to produce a continuous stream of simulated
@@ -148,52 +221,45 @@ int XLALSimNoise(
 	gsl_rng *rng			/**< [in] GSL random number generator */
 )
 {
-	REAL8Vector *overlap;
-	size_t j;
-
 	/* Use a default RNG if a NULL pointer was passed in */
 	if (!rng)
 		rng = gsl_rng_alloc(gsl_rng_default);
 
-	/* make sure that the resolution of the frequency series is
-	 * commensurate with the requested time series */
-	if (s->data->length/2 + 1 != psd->data->length
-			|| (size_t)floor(0.5 + 1.0/(s->deltaT * psd->deltaF)) != s->data->length)
-		XLAL_ERROR(XLAL_EINVAL);
-
-	/* stride cannot be longer than data length */
-	if (stride > s->data->length)
-		XLAL_ERROR(XLAL_EINVAL);
-
-	if (stride == 0) { /* generate segment with no feathering */
-		XLALSimNoiseSegment(s, psd, rng);
-		return 0;
-	} else if (stride == s->data->length) {
-		/* will generate two independent noise realizations
-		 * and feather them together with full overlap */
-		XLALSimNoiseSegment(s, psd, rng);
-		stride = 0;
-	}
-
-	overlap = XLALCreateREAL8Sequence(s->data->length - stride);
-
-	/* copy overlap region between the old and the new data to temporary storage */
-	memcpy(overlap->data, s->data->data + stride, overlap->length*sizeof(*overlap->data));
-	
-	/* generate the new data */
-	XLALSimNoiseSegment(s, psd, rng);
-
-	/* feather old data in overlap region with new data */
-	for (j = 0; j < overlap->length; ++j) {
-		double x = cos(LAL_PI*j/(2.0 * overlap->length));
-		double y = sin(LAL_PI*j/(2.0 * overlap->length));
-		s->data->data[j] = x*overlap->data[j] + y*s->data->data[j];
-	}
-
-	XLALDestroyREAL8Sequence(overlap);
+	if (XLALSimNoiseStride(s, stride, psd, rng, 0, 0) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
 
-	/* advance time */
-	XLALGPSAdd(&s->epoch, stride * s->deltaT);
+/**
+ * @brief Routine like XLALSimNoise() whose noise does not depend on the order
+ * in which segments are generated.
+ *
+ * The new data generated by each call is determined only by @p seed and by
+ * the index @p segment: it is drawn from a Philox counter-based random number
+ * stream (see XLALPhiloxNormalDeviates()) rather than from a sequential
+ * generator.  Calling this with segment = 0, 1, 2, ... and the same strides
+ * as XLALSimNoise() gives a continuous stream of noise, and any run of
+ * segments can be regenerated on its own:  if the stride is at least half of
+ * the data length, a call with stride = 0 and segment = k - 1 (with the epoch
+ * of segment k - 1) gives exactly the state that the sequential calls have
+ * before segment k.  Independent blocks of segments can therefore be
+ * generated concurrently, for example to produce long stretches of noise for
+ * several detectors, and produce the same data as a serial run.
+ *
+ * If stride = h->data->length, the new data is feathered in from segment - 1.
+ *
+ * @warning Only the first stride points are valid.
+ */
+int XLALSimNoiseFromSeed(
+	REAL8TimeSeries *s,		/**< [in/out] noise time series */
+	size_t stride,			/**< [in] stride (samples) */
+	REAL8FrequencySeries *psd,	/**< [in] power spectrum frequency series */
+	UINT8 seed,			/**< [in] random number seed */
+	UINT8 segment			/**< [in] index of the segment being generated */
+)
+{
+	if (XLALSimNoiseStride(s, stride, psd, NULL, seed, segment) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
 	return 0;
 }
 
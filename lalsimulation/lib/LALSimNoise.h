@@ -69,6 +69,7 @@ SWIGLAL(FUNCTION_POINTER(aLIGOQuantumHighFrequency, XLALSimNoisePSDAdvVirgo,
 
 
 int XLALSimNoise(REAL8TimeSeries *s, size_t stride, REAL8FrequencySeries *psd, gsl_rng *rng);
+int XLALSimNoiseFromSeed(REAL8TimeSeries *s, size_t stride, REAL8FrequencySeries *psd, UINT8 seed, UINT8 segment);
 
 
 /*
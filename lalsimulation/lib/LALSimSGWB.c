@@ -20,6 +20,8 @@
 #include <complex.h>
 #include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <gsl/gsl_linalg.h>
 #include <gsl/gsl_rng.h>
 #include <gsl/gsl_randist.h>
@@ -33,35 +35,219 @@
 #include <lal/Units.h>
 #include <lal/LALSimSGWB.h>
 
+#include <lal/LALConfig.h>
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
+
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
+/*
+ * Lower-triangular Cholesky factors of the correlation matrix of the
+ * detector network at each frequency of a grid (excluding DC and Nyquist).
+ * The factors depend only on the network and the grid, so the most recently
+ * used set is kept and shared by successive segments; since it outlives any
+ * one call it is allocated outside the LAL memory tracking.
+ */
+struct SGWBFactors {
+	size_t refcount;
+	size_t numDetectors;
+	size_t length;
+	double deltaF;
+	LALDetector *detectors;
+	double *L; /* packed lower triangle, (numDetectors*(numDetectors+1)/2) per frequency */
+};
+
+static struct SGWBFactors *SGWBFactorsCache = NULL;
+#ifdef LAL_PTHREAD_LOCK
+static pthread_mutex_t SGWBFactorsLock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static void SGWBFactorsRelease(struct SGWBFactors *factors)
+{
+	int destroy;
+	if (!factors)
+		return;
+#ifdef LAL_PTHREAD_LOCK
+	(void) pthread_mutex_lock(&SGWBFactorsLock);
+#endif
+	destroy = (--factors->refcount == 0);
+#ifdef LAL_PTHREAD_LOCK
+	(void) pthread_mutex_unlock(&SGWBFactorsLock);
+#endif
+	if (destroy) {
+		free(factors->detectors);
+		free(factors->L);
+		free(factors);
+	}
+}
+
+static int SGWBFactorsMatch(const struct SGWBFactors *factors, const LALDetector *detectors, size_t numDetectors, size_t length, double deltaF)
+{
+	size_t i;
+	if (factors->numDetectors != numDetectors || factors->length != length || factors->deltaF != deltaF)
+		return 0;
+	for (i = 0; i < numDetectors; ++i)
+		if (memcmp(factors->detectors[i].location, detectors[i].location, sizeof(detectors[i].location))
+				|| memcmp(factors->detectors[i].response, detectors[i].response, sizeof(detectors[i].response)))
+			return 0;
+	return 1;
+}
+
+/* compute the correlation factors for a network; the frequencies are
+ * independent so the work is split between threads */
+static struct SGWBFactors *SGWBFactorsCompute(const LALDetector *detectors, size_t numDetectors, size_t length, double deltaF)
+{
+	const size_t npacked = numDetectors * (numDetectors + 1) / 2;
+	struct SGWBFactors *factors;
+	int failed = 0;
+	size_t k;
+
+	factors = calloc(1, sizeof(*factors));
+	if (!factors)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	factors->refcount = 1;
+	factors->numDetectors = numDetectors;
+	factors->length = length;
+	factors->deltaF = deltaF;
+	factors->detectors = malloc(numDetectors * sizeof(*factors->detectors));
+	factors->L = malloc((length/2 + 1) * npacked * sizeof(*factors->L));
+	if (!factors->detectors || !factors->L) {
+		SGWBFactorsRelease(factors);
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	}
+	memcpy(factors->detectors, detectors, numDetectors * sizeof(*detectors));
+
+	#pragma omp parallel reduction(|:failed)
+	{
+		gsl_matrix *R = gsl_matrix_alloc(numDetectors, numDetectors);
+		if (!R)
+			failed = 1;
+
+		#pragma omp for schedule(static)
+		for (k = 1; k < length/2; ++k) {
+			double f = k * deltaF;
+			double *L = factors->L + k * npacked;
+			size_t i, j;
+
+			if (!R)
+				continue;
+
+			/* construct correlation matrix at this frequency */
+			/* diagonal elements of correlation matrix are unity */
+			gsl_matrix_set_identity(R);
+			/* now do the off-diagonal elements */
+			for (i = 0; i < numDetectors; ++i)
+				for (j = i + 1; j < numDetectors; ++j) {
+					double Rij = XLALSimSGWBOverlapReductionFunction(f, &detectors[i], &detectors[j]);
+					/* if the two sites are the same, the overlap reduciton
+					 * function will be unity, but this will cause problems
+					 * for the cholesky decomposition; a hack is to make it
+					 * unity only to single precision */
+					if (fabs(Rij - 1.0) < LAL_REAL4_EPS)
+						Rij = 1.0 - LAL_REAL4_EPS;
+
+					gsl_matrix_set(R, i, j, Rij);
+					gsl_matrix_set(R, j, i, Rij); /* it is symmetric */
+				}
+
+			/* perform Cholesky decomposition */
+			gsl_linalg_cholesky_decomp(R);
+
+			/* keep the lower-diagonal part */
+			for (i = 0; i < numDetectors; ++i)
+				for (j = 0; j <= i; ++j)
+					L[i * (i + 1) / 2 + j] = gsl_matrix_get(R, i, j);
+		}
+
+		gsl_matrix_free(R);
+	}
+
+	if (failed) {
+		SGWBFactorsRelease(factors);
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	}
+	return factors;
+}
+
+/* return a reference to the factors for this network and frequency grid,
+ * computing them only if they differ from the ones last used */
+static struct SGWBFactors *SGWBFactorsGet(const LALDetector *detectors, size_t numDetectors, size_t length, double deltaF)
+{
+	struct SGWBFactors *factors = NULL;
+	struct SGWBFactors *old = NULL;
+
+#ifdef LAL_PTHREAD_LOCK
+	(void) pthread_mutex_lock(&SGWBFactorsLock);
+#endif
+	if (SGWBFactorsCache && SGWBFactorsMatch(SGWBFactorsCache, detectors, numDetectors, length, deltaF)) {
+		factors = SGWBFactorsCache;
+		++factors->refcount;
+	}
+#ifdef LAL_PTHREAD_LOCK
+	(void) pthread_mutex_unlock(&SGWBFactorsLock);
+#endif
+	if (factors)
+		return factors;
+
+	factors = SGWBFactorsCompute(detectors, numDetectors, length, deltaF);
+	if (!factors)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+
+	/* replace the cached factors; one reference for the cache and one
+	 * for the caller */
+#ifdef LAL_PTHREAD_LOCK
+	(void) pthread_mutex_lock(&SGWBFactorsLock);
+#endif
+	old = SGWBFactorsCache;
+	SGWBFactorsCache = factors;
+	++factors->refcount;
+#ifdef LAL_PTHREAD_LOCK
+	(void) pthread_mutex_unlock(&SGWBFactorsLock);
+#endif
+	SGWBFactorsRelease(old);
+
+	return factors;
+}
+
 /* 
  * This routine generates a single segment of data.  Note that this segment is
  * generated in the frequency domain and is inverse Fourier transformed into
  * the time domain; consequently the data is periodic in the time domain.
+ *
+ * The random numbers are drawn serially, in the same order as they always
+ * have been, so that a given generator state gives the same data; the
+ * correlation and the inverse Fourier transforms are then done in parallel.
  */
 static int XLALSimSGWBSegment(REAL8TimeSeries **h, const LALDetector *detectors, size_t numDetectors, const REAL8FrequencySeries *OmegaGW, double H0, gsl_rng *rng)
 {
 #	define CLEANUP_AND_RETURN(errnum) do { \
 		if (htilde) for (i = 0; i < numDetectors; ++i) XLALDestroyCOMPLEX16FrequencySeries(htilde[i]); \
-		XLALFree(htilde); XLALDestroyREAL8FFTPlan(plan); gsl_matrix_free(R); \
+		XLALFree(htilde); XLALFree(z); XLALDestroyREAL8FFTPlan(plan); SGWBFactorsRelease(factors); \
 		if (errnum) XLAL_ERROR(errnum); else return 0; \
 		} while (0)
+	const size_t npacked = numDetectors * (numDetectors + 1) / 2;
 	REAL8FFTPlan *plan = NULL;
 	COMPLEX16FrequencySeries **htilde = NULL;
-	gsl_matrix *R = NULL;
+	struct SGWBFactors *factors = NULL;
+	COMPLEX16 *z = NULL;
 	LIGOTimeGPS epoch;
 	double psdfac;
 	double deltaF;
 	size_t length;
 	size_t i, j, k;
+	int failed = 0;
 
 	epoch = h[0]->epoch;
 	length = h[0]->data->length;
 	deltaF = 1.0 / (length * h[0]->deltaT);
 	psdfac = 0.3 * pow(H0 / LAL_PI, 2.0);
 
-	R = gsl_matrix_alloc(numDetectors, numDetectors);
-	if (! R)
-		CLEANUP_AND_RETURN(XLAL_ENOMEM);
+	factors = SGWBFactorsGet(detectors, numDetectors, length, deltaF);
+	if (! factors)
+		CLEANUP_AND_RETURN(XLAL_EFUNC);
 
 	plan = XLALCreateReverseREAL8FFTPlan(length, 0);
 	if (! plan)
@@ -83,47 +269,41 @@ static int XLALSimSGWBSegment(REAL8TimeSeries **h, const LALDetector *detectors,
 		memset(htilde[i]->data->data, 0, htilde[i]->data->length * sizeof(*htilde[i]->data->data));
 	}
 
-	/* compute frequencies (excluding DC and Nyquist) */
+	/* generate numDetector random numbers (both re and im parts) at
+	 * each frequency (excluding DC and Nyquist) */
+	z = LALMalloc((length/2 + 1) * numDetectors * sizeof(*z));
+	if (! z)
+		CLEANUP_AND_RETURN(XLAL_ENOMEM);
 	for (k = 1; k < length/2; ++k) {
 		double f = k * deltaF;
 		double sigma = 0.5 * sqrt(psdfac * OmegaGW->data->data[k] * pow(f, -3.0) / deltaF);
-
-		/* construct correlation matrix at this frequency */
-		/* diagonal elements of correlation matrix are unity */
-		gsl_matrix_set_identity(R);
-		/* now do the off-diagonal elements */
-		for (i = 0; i < numDetectors; ++i)
-			for (j = i + 1; j < numDetectors; ++j) {
-				double Rij = XLALSimSGWBOverlapReductionFunction(f, &detectors[i], &detectors[j]);
-				/* if the two sites are the same, the overlap reduciton
-				 * function will be unity, but this will cause problems
-				 * for the cholesky decomposition; a hack is to make it
-				 * unity only to single precision */
-				if (fabs(Rij - 1.0) < LAL_REAL4_EPS)
-					Rij = 1.0 - LAL_REAL4_EPS;
-
-				gsl_matrix_set(R, i, j, Rij);
-				gsl_matrix_set(R, j, i, Rij); /* it is symmetric */
-			}
-
-		/* perform Cholesky decomposition */
-		gsl_linalg_cholesky_decomp(R);
-
-		/* generate numDetector random numbers (both re and im parts) and use
- 		 * lower-diagonal part of Cholesky decomposition to create correlations */
 		for (j = 0; j < numDetectors; ++j) {
 			double re = gsl_ran_gaussian_ziggurat(rng, sigma);
 			double im = gsl_ran_gaussian_ziggurat(rng, sigma);
-			for (i = j; i < numDetectors; ++i) {
-				htilde[i]->data->data[k] += gsl_matrix_get(R, i, j) * re;
-				htilde[i]->data->data[k] += I * gsl_matrix_get(R, i, j) * im;
-			}
+			z[k * numDetectors + j] = crect(re, im);
+		}
+	}
+
+	/* use lower-diagonal part of Cholesky decomposition to create
+	 * correlations */
+	#pragma omp parallel for schedule(static) private(i, j)
+	for (k = 1; k < length/2; ++k) {
+		const double *L = factors->L + k * npacked;
+		for (i = 0; i < numDetectors; ++i) {
+			COMPLEX16 sum = 0.0;
+			for (j = 0; j <= i; ++j)
+				sum += L[i * (i + 1) / 2 + j] * z[k * numDetectors + j];
+			htilde[i]->data->data[k] = sum;
 		}
 	}
 
 	/* now go back to the time domain */
+	#pragma omp parallel for schedule(dynamic) reduction(|:failed)
 	for (i = 0; i < numDetectors; ++i)
-		XLALREAL8FreqTimeFFT(h[i], htilde[i], plan);
+		if (XLALREAL8FreqTimeFFT(h[i], htilde[i], plan) < 0)
+			failed = 1;
+	if (failed)
+		CLEANUP_AND_RETURN(XLAL_EFUNC);
 
 	/* normal exit */
 	CLEANUP_AND_RETURN(0);
@@ -69,6 +69,27 @@ static unsigned long round_up_to_power_of_two(unsigned long x)
 }
 
 
+/*
+ * Phase factor exp(-2 pi i f dt) for the k-th bin of a frequency series,
+ * f = f0 + k deltaF.  Consecutive bins differ by the constant factor step
+ * = exp(-2 pi i deltaF dt), so the factor is carried from bin to bin in
+ * *phasor and only recomputed directly every SHIFT_PHASOR_INTERVAL bins to
+ * bound the accumulated round-off.  This avoids a cexp() per bin when
+ * time-shifting long injections.
+ */
+
+
+#define SHIFT_PHASOR_INTERVAL 1024
+
+
+static COMPLEX16 next_shift_phasor(COMPLEX16 *phasor, COMPLEX16 step, double f, double dt, unsigned k)
+{
+	COMPLEX16 fac = k % SHIFT_PHASOR_INTERVAL ? *phasor : cexp(-I * LAL_TWOPI * f * dt);
+	*phasor = fac * step;
+	return fac;
+}
+
+
 /**
  * @brief Turn a detector prefix string into a LALDetector structure.
  * @details
@@ -282,6 +303,7 @@ REAL8TimeSeries *XLALSimDetectorStrainREAL8TimeSeries(
 	double dt;	/* an offset */
 	char *name;
 	REAL8TimeSeries *h = NULL;
+	REAL8 *ybuffer = NULL;
 	unsigned i;
 
 	/* check input */
@@ -363,14 +385,14 @@ REAL8TimeSeries *XLALSimDetectorStrainREAL8TimeSeries(
 	xsignal = XLALCreateREAL8TimeSeries("xsignal", &hplus->epoch, hplus->f0, hplus->deltaT, &hplus->sampleUnits, (int) hplus->data->length);
 	ysignal = XLALCreateREAL8TimeSeries("ysignal", &hplus->epoch, hplus->f0, hplus->deltaT, &hplus->sampleUnits, (int) hplus->data->length);
 	for(i = 0; i < hplus->data->length; i++) {
-		t = hplus->epoch;
-		if(!XLALGPSAdd(&t, i * hplus->deltaT))
-			goto error;
 		/* Compute detector's response. Here the geometric delay
 		 * from geocenter is neglected since it is small compared
 		 * to the rotational period of the Earth */
 		if(!(i % det_resp_interval)) {
 			double armlen = XLAL_REAL8_FAIL_NAN;
+			t = hplus->epoch;
+			if(!XLALGPSAdd(&t, i * hplus->deltaT))
+				goto error;
 			double xcos = XLAL_REAL8_FAIL_NAN;
 			double ycos = XLAL_REAL8_FAIL_NAN;
 			XLALComputeDetAMResponseParts(&armlen, &xcos, &ycos, &fxplus, &fyplus, &fxcross, &fycross, detector, right_ascension, declination, psi, XLALGreenwichMeanSiderealTime(&t));
@@ -391,43 +413,52 @@ REAL8TimeSeries *XLALSimDetectorStrainREAL8TimeSeries(
 	if(!xinterp || !yinterp)
 		goto error;
 
-	/* compute output sample by sample */
+	/* compute output in blocks of det_resp_interval samples, within
+	 * which the geometric delay is constant */
 	/* FIXME: Now xdata and ydata are not renewed until geometric delay
 	 * changes significantly. This can cause systematic errors. For
 	 * example, if the detector is on the North pole, xdata and ydata
 	 * are never renewed although armcos can be changing. */
 
-	for(i = 0; i < h->data->length; i++) {
-		/* time of sample in detector */
+	ybuffer = XLALMalloc(det_resp_interval * sizeof(*ybuffer));
+	if(!ybuffer)
+		goto error;
+	for(i = 0; i < h->data->length; i += det_resp_interval) {
+		const unsigned n = h->data->length - i < det_resp_interval ? h->data->length - i : det_resp_interval;
+		unsigned j;
+
+		/* time of first sample of block in detector */
 		t = h->epoch;
 		if(!XLALGPSAdd(&t, i * h->deltaT))
 			goto error;
 
 		/* geometric delay from geocentre and highfreq_kernel_data */
-		if(!(i % det_resp_interval)) {
-			geometric_delay = -XLALTimeDelayFromEarthCenter(detector->location, right_ascension, declination, &t);
-			/* Compute highfreq_kernel_data */
-			double armlen = XLAL_REAL8_FAIL_NAN;
-			XLALComputeDetAMResponseParts(&armlen, &xdata.armcos, &ydata.armcos, &fxplus, &fyplus, &fxcross, &fycross, detector, right_ascension, declination, psi, XLALGreenwichMeanSiderealTime(&t));
-			armlen /= LAL_C_SI * h->deltaT;
-			xdata.T = armlen;
-			ydata.T = armlen;
-		}
+		geometric_delay = -XLALTimeDelayFromEarthCenter(detector->location, right_ascension, declination, &t);
+		/* Compute highfreq_kernel_data */
+		double armlen = XLAL_REAL8_FAIL_NAN;
+		XLALComputeDetAMResponseParts(&armlen, &xdata.armcos, &ydata.armcos, &fxplus, &fyplus, &fxcross, &fycross, detector, right_ascension, declination, psi, XLALGreenwichMeanSiderealTime(&t));
+		armlen /= LAL_C_SI * h->deltaT;
+		xdata.T = armlen;
+		ydata.T = armlen;
 		if(XLAL_IS_REAL8_FAIL_NAN(geometric_delay))
 			goto error;
 		if(XLAL_IS_REAL8_FAIL_NAN(xdata.T) || XLAL_IS_REAL8_FAIL_NAN(ydata.T) || XLAL_IS_REAL8_FAIL_NAN(xdata.armcos) || XLAL_IS_REAL8_FAIL_NAN(ydata.armcos))
 			goto error;
 
-		/* time of sample at geocentre */
+		/* time of first sample of block at geocentre */
 		if(!XLALGPSAdd(&t, geometric_delay))
 			goto error;
 
 		/* evaluate linear combination of interpolators */
-		h->data->data[i] = XLALREAL8TimeSeriesInterpEval(xinterp, &t, 0) + XLALREAL8TimeSeriesInterpEval(yinterp, &t, 0);
-
-		if(XLAL_IS_REAL8_FAIL_NAN(h->data->data[i]))
+		if(XLALREAL8TimeSeriesInterpEvalVector(xinterp, h->data->data + i, &t, h->deltaT, NULL, n, 0) < 0 || XLALREAL8TimeSeriesInterpEvalVector(yinterp, ybuffer, &t, h->deltaT, NULL, n, 0) < 0)
 			goto error;
+		for(j = 0; j < n; j++) {
+			h->data->data[i + j] += ybuffer[j];
+			if(XLAL_IS_REAL8_FAIL_NAN(h->data->data[i + j]))
+				goto error;
+		}
 	}
+	XLALFree(ybuffer);
 
 	/* done */
 	XLALREAL8TimeSeriesInterpDestroy(xinterp);
@@ -437,6 +468,7 @@ REAL8TimeSeries *XLALSimDetectorStrainREAL8TimeSeries(
 	return h;
 
 error:
+	XLALFree(ybuffer);
 	XLALREAL8TimeSeriesInterpDestroy(xinterp);
 	XLALREAL8TimeSeriesInterpDestroy(yinterp);
 	XLALDestroyREAL8TimeSeries(xsignal);
@@ -528,6 +560,7 @@ int XLALSimAddInjectionREAL8TimeSeries(
 		COMPLEX16FrequencySeries *tilde_h;
 		REAL8FFTPlan *plan;
 		REAL8Window *window;
+		COMPLEX16 phasor = 1.0, step;
 		unsigned i;
 
 		/* extend the source time series by adding the
@@ -567,13 +600,14 @@ int XLALSimAddInjectionREAL8TimeSeries(
 		/* apply sub-sample time correction and optional response
 		 * function */
 
+		step = cexp(-I * LAL_TWOPI * tilde_h->deltaF * start_sample_frac * target->deltaT);
 		for(i = 0; i < tilde_h->data->length; i++) {
 			const double f = tilde_h->f0 + i * tilde_h->deltaF;
 			COMPLEX16 fac;
 
 			/* phase for sub-sample time correction */
 
-			fac = cexp(-I * LAL_TWOPI * f * start_sample_frac * target->deltaT);
+			fac = next_shift_phasor(&phasor, step, f, start_sample_frac * target->deltaT, i);
 
 			/* divide the source by the response function.  if
 			 * a frequency is required that lies outside the
@@ -778,6 +812,7 @@ int XLALSimAddInjectionREAL4TimeSeries(
 		COMPLEX8FrequencySeries *tilde_h;
 		REAL4FFTPlan *plan;
 		REAL4Window *window;
+		COMPLEX16 phasor = 1.0, step;
 		unsigned i;
 
 		/* extend the source time series by adding the "aperiodicity
@@ -816,13 +851,14 @@ int XLALSimAddInjectionREAL4TimeSeries(
 		/* apply sub-sample time correction and optional response function
 		 * */
 
+		step = cexp(-I * LAL_TWOPI * tilde_h->deltaF * start_sample_frac * target->deltaT);
 		for(i = 0; i < tilde_h->data->length; i++) {
 			const double f = tilde_h->f0 + i * tilde_h->deltaF;
 			COMPLEX8 fac;
 
 			/* phase for sub-sample time correction */
 
-			fac = cexp(-I * LAL_TWOPI * f * start_sample_frac * target->deltaT);
+			fac = next_shift_phasor(&phasor, step, f, start_sample_frac * target->deltaT, i);
 
 			/* divide the source by the response function.  if a
 			 * frequency is required that lies outside the domain of
@@ -976,6 +1012,7 @@ static int XLALSimComputeStrainSegmentREAL8TimeSeries(
 	double offrac;
 	int offset;
 	int j;
+	COMPLEX16 phasor = 1.0, step;
 	size_t k;
 
 	/* this routine assumes the segment has a length of N points where N is
@@ -1045,6 +1082,7 @@ static int XLALSimComputeStrainSegmentREAL8TimeSeries(
 
 	/* apply sub-sample time shift in frequency domain */
 
+	step = cexp(-I * LAL_TWOPI * work1->deltaF * deltaT);
 	for (k = 0; k < work1->data->length; ++k) {
 		double f = work1->f0 + k * work1->deltaF;
 		double beta = f * armlen / LAL_C_SI;
@@ -1053,7 +1091,7 @@ static int XLALSimComputeStrainSegmentREAL8TimeSeries(
 		COMPLEX16 fac;
 		
 		/* phase for sub-sample time correction */
-		fac = cexp(-I * LAL_TWOPI * f * deltaT);
+		fac = next_shift_phasor(&phasor, step, f, deltaT, k);
 		if (response)
 			fac /= response->data->data[k];
 
@@ -1120,6 +1158,7 @@ static int XLALSimComputeStrainSegmentREAL4TimeSeries(
 	double offrac;
 	int offset;
 	int j;
+	COMPLEX16 phasor = 1.0, step;
 	size_t k;
 
 	/* this routine assumes the segment has a length of N points where N is
@@ -1189,6 +1228,7 @@ static int XLALSimComputeStrainSegmentREAL4TimeSeries(
 
 	/* apply sub-sample time shift in frequency domain */
 
+	step = cexp(-I * LAL_TWOPI * work1->deltaF * deltaT);
 	for (k = 0; k < work1->data->length; ++k) {
 		double f = work1->f0 + k * work1->deltaF;
 		double beta = f * armlen / LAL_C_SI;
@@ -1197,7 +1237,7 @@ static int XLALSimComputeStrainSegmentREAL4TimeSeries(
 		COMPLEX16 fac;
 		
 		/* phase for sub-sample time correction */
-		fac = cexp(-I * LAL_TWOPI * f * deltaT);
+		fac = next_shift_phasor(&phasor, step, f, deltaT, k);
 		if (response)
 			fac /= response->data->data[k];
 
@@ -1711,6 +1751,7 @@ static int XLALSimComputeLWLStrainSegmentREAL8TimeSeries(
 	double offrac;
 	int offset;
 	int j;
+	COMPLEX16 phasor = 1.0, step;
 	size_t k;
 
 	/* this routine assumes the segment has a length of N points where N is
@@ -1775,12 +1816,13 @@ static int XLALSimComputeLWLStrainSegmentREAL8TimeSeries(
 
 	/* apply sub-sample time shift in frequency domain */
 
+	step = cexp(-I * LAL_TWOPI * work->deltaF * deltaT);
 	for (k = 0; k < work->data->length; ++k) {
 		double f = work->f0 + k * work->deltaF;
 		COMPLEX16 fac;
 		
 		/* phase for sub-sample time correction */
-		fac = cexp(-I * LAL_TWOPI * f * deltaT);
+		fac = next_shift_phasor(&phasor, step, f, deltaT, k);
 		if (response)
 			fac /= response->data->data[k];
 
@@ -1835,6 +1877,7 @@ static int XLALSimComputeLWLStrainSegmentREAL4TimeSeries(
 	double offrac;
 	int offset;
 	int j;
+	COMPLEX16 phasor = 1.0, step;
 	size_t k;
 
 	/* this routine assumes the segment has a length of N points where N is
@@ -1899,12 +1942,13 @@ static int XLALSimComputeLWLStrainSegmentREAL4TimeSeries(
 
 	/* apply sub-sample time shift in frequency domain */
 
+	step = cexp(-I * LAL_TWOPI * work->deltaF * deltaT);
 	for (k = 0; k < work->data->length; ++k) {
 		double f = work->f0 + k * work->deltaF;
 		COMPLEX8 fac;
 		
 		/* phase for sub-sample time correction */
-		fac = cexp(-I * LAL_TWOPI * f * deltaT);
+		fac = next_shift_phasor(&phasor, step, f, deltaT, k);
 		if (response)
 			fac /= response->data->data[k];
 
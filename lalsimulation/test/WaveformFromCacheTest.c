@@ -221,7 +221,6 @@ int main(void) {
     ret = XLALSimInspiralChooseFDWaveformFromCache(&hptildeC, &hctildeC,
             phiref2, df, m1, m2, s1x, s1y, s1z, s2x, s2y, s2z, f_min, f_max,
             f_ref, dist2, inc2, LALpars, approxFD, cache, NULL);
-    XLALDestroyDict(LALpars);
     e2 = clock();
     diff2 = (double) (e2 - s2) / CLOCKS_PER_SEC;
     if( ret == XLAL_FAILURE )
@@ -249,6 +248,35 @@ int main(void) {
     XLALDestroyCOMPLEX16FrequencySeries(hctildeC);
     hptilde = hctilde = hptildeC = hctildeC = NULL;
 
+    //
+    // Test that a cache holding two FD waveforms keeps both
+    //
+
+    ret = XLALSimInspiralWaveformCacheSetCapacity(cache, 2);
+    if( ret == XLAL_FAILURE )
+        XLAL_ERROR(XLAL_EFUNC);
+    cache->hits = cache->misses = 0;
+
+    // Alternate between two sets of intrinsic parameters:  only the first
+    // request of each must generate a waveform
+    for(i=0; i < 4; i++)
+    {
+        REAL8 m = i % 2 ? 1.1 * m1 : 1.2 * m1;
+        ret = XLALSimInspiralChooseFDWaveformFromCache(&hptildeC, &hctildeC,
+                phiref1, df, m, m2, s1x, s1y, s1z, s2x, s2y, s2z, f_min, f_max,
+                f_ref, dist1, inc1, LALpars, approxFD, cache, NULL);
+        if( ret == XLAL_FAILURE )
+            XLAL_ERROR(XLAL_EFUNC);
+        XLALDestroyCOMPLEX16FrequencySeries(hptildeC);
+        XLALDestroyCOMPLEX16FrequencySeries(hctildeC);
+        hptildeC = hctildeC = NULL;
+    }
+    printf("Alternating between two waveforms in a cache of capacity 2...\n");
+    printf("Cache hit rate is: %g\n\n", XLALSimInspiralWaveformCacheHitRate(cache));
+    if( cache->hits != 2 || cache->misses != 2 )
+        XLAL_ERROR(XLAL_EFAILED, "Expected 2 cache hits and 2 misses, got %lld and %lld", (long long) cache->hits, (long long) cache->misses);
+
+    XLALDestroyDict(LALpars);
     XLALDestroySimInspiralWaveformCache(cache);
     LALCheckMemoryLeaks();
 
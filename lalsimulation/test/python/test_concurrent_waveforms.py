@@ -0,0 +1,88 @@
+# -*- coding: utf-8 -*-
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http: //www.gnu.org/licenses/>.
+
+"""Test that waveforms generated from concurrent Python threads
+agree with waveforms generated serially
+"""
+
+import sys
+import threading
+import pytest
+import numpy as np
+import lal
+import lalsimulation
+
+# -- utility functions ------------------
+
+def generate_td(approximant, m1, m2, chi1z, chi2z):
+    hp, hc = lalsimulation.SimInspiralChooseTDWaveform(
+        m1 * lal.MSUN_SI, m2 * lal.MSUN_SI,
+        0., 0., chi1z, 0., 0., chi2z,
+        1e6 * lal.PC_SI, 0.3, 0., 0., 0., 0.,
+        1. / 4096, 30., 30., None, approximant)
+    return hp.data.data.copy(), hc.data.data.copy()
+
+def generate_fd(approximant, m1, m2, chi1z, chi2z):
+    hp, hc = lalsimulation.SimInspiralChooseFDWaveform(
+        m1 * lal.MSUN_SI, m2 * lal.MSUN_SI,
+        0., 0., chi1z, 0., 0., chi2z,
+        1e6 * lal.PC_SI, 0.3, 0., 0., 0., 0.,
+        0.25, 30., 1024., 30., None, approximant)
+    return hp.data.data.copy(), hc.data.data.copy()
+
+# -- test functions ---------------------
+
+concurrent_test_data = [
+    (generate_td, lalsimulation.TaylorT4),
+    (generate_td, lalsimulation.IMRPhenomD),
+    (generate_fd, lalsimulation.IMRPhenomD),
+    (generate_fd, lalsimulation.IMRPhenomXAS),
+]
+
+@pytest.mark.parametrize("generate, approximant", concurrent_test_data)
+def test_concurrent_waveforms(generate, approximant):
+    """
+    generate: function which generates h+, hx for given parameters
+    approximant: waveform approximant
+    """
+    params = [(10. + 2. * i, 8. + i, 0.1 * (i % 3), -0.1 * (i % 2)) for i in range(8)]
+
+    # generate the waveforms serially
+    expected = [generate(approximant, *p) for p in params]
+
+    # generate the waveforms again, several times each, from concurrent threads
+    results = [None] * len(params)
+    def waveform_thread(i):
+        try:
+            for _ in range(4):
+                hp, hc = generate(approximant, *params[i])
+            results[i] = np.array_equal(hp, expected[i][0]) and np.array_equal(hc, expected[i][1])
+        except RuntimeError:
+            results[i] = "error"
+    threads = [threading.Thread(target=waveform_thread, args=(i,)) for i in range(len(params))]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+
+    assert results == [True] * len(params), (
+        "waveforms generated from concurrent threads differ from serial waveforms"
+    )
+
+# -- run the tests ------------------------------
+
+if __name__ == '__main__':
+    args = sys.argv[1:] or ["-v", "-rs", "--junit-xml=junit-concurrent_waveforms.xml"]
+    sys.exit(pytest.main(args=[__file__] + args))
@@ -56,6 +56,10 @@ FUNC_RETN_1STARG_REGEX = re.compile(r'^f\(((?:p\.)+[^,]+?)(?:,[^,]+)*\)\.\1$')
 DESTRUCTOR_REGEX = re.compile(r'(Destroy|Free|Close)([A-Z0-9_]|$)')
 DESTRUCTOR_DECL_REGEX = re.compile(r'^f\(p\.(.*)\)\.$')
 
+# functions marked by SWIGLAL(RELEASE_GIL(...)) are called without holding
+# the scripting language's global interpreter lock
+RELEASE_GIL_REGEX = re.compile(r'^RELEASE_GIL\((.*)\)$')
+
 # old LAL error messages and codes are ignored from the bindings entirely
 OLD_LAL_EMSG_REGEX = re.compile(r'([A-Z0-9_]+H_)MSG(E[A-Z0-9]+)$')
 
@@ -69,6 +73,7 @@ class SwigSymbols(object):
     def __init__(self):
         # parsing
         self.clear_macros = {}
+        self.release_gil = set()
         self.constants = {}
         self.functions = {}
         self.structs = {}
@@ -207,6 +212,13 @@ class SwigSymbols(object):
                     "duplicate definition of SWIGLAL({})".format(macro),
                 )
             clear_macros.add(macro)
+
+            # record functions marked by SWIGLAL(RELEASE_GIL(...))
+            release_gil = RELEASE_GIL_REGEX.match(macro)
+            if release_gil:
+                self.release_gil.update(
+                    name for name in release_gil.group(1).split(',') if name
+                )
         else:
             if macro not in clear_macros:
                 raise ValueError(
@@ -489,6 +501,15 @@ def write_interface_file(file, package, symbols, dependencies, headers):
                 fprint('%rename("{}") {};'.format(rename, name))
         fprint('#endif // SWIGLAL_MODULE_RENAME_{}S'.format(kind.upper()))
 
+    # check that functions marked by SWIGLAL(RELEASE_GIL(...)) exist
+    for function_name in sorted(symbols.release_gil):
+        if function_name not in symbols.functions:
+            raise ValueError(
+                "unknown function '{}' in SWIGLAL(RELEASE_GIL(...))".format(
+                    function_name,
+                ),
+            )
+
     # perform operations on functions
     for function_name in sorted(symbols.functions):
         # skip ignored functions
@@ -514,6 +535,16 @@ def write_interface_file(file, package, symbols, dependencies, headers):
                 ),
             )
 
+        # indicate if a function has been marked by SWIGLAL(RELEASE_GIL(...))
+        # as safe to call without holding the scripting language's global
+        # interpreter lock
+        if function_name in symbols.release_gil:
+            fprint(
+                '%header %{{#define swiglal_release_gil_{}%}}'.format(
+                    function_name,
+                ),
+            )
+
         # indicate if the return type of a function is a pointer type, and
         # matches the type of its first argument; many LAL functions return
         # their first argument after performing some operation on it, but we